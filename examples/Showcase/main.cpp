@@ -10,17 +10,162 @@
 #include <NazaraUtils/CallOnExit.hpp>
 #include <NZSL/Math/FieldOffsets.hpp>
 #include <entt/entt.hpp>
+#include <algorithm>
 #include <array>
 #include <bitset>
+#include <cmath>
+#include <fstream>
 #include <iostream>
 #include <limits>
+#include <vector>
 
 NAZARA_REQUEST_DEDICATED_GPU()
 
+namespace
+{
+	// Benchmark mode (--benchmark): plays a scripted camera path with a fixed timestep and writes frame timings to a JSON report
+	struct BenchmarkSample
+	{
+		Nz::RenderFrameStatistics statistics;
+		double frameTime; //< milliseconds
+	};
+
+	double ComputePercentile(const std::vector<double>& sortedValues, double percentile)
+	{
+		if (sortedValues.empty())
+			return 0.0;
+
+		// Nearest-rank method
+		std::size_t rank = static_cast<std::size_t>(std::ceil(percentile / 100.0 * sortedValues.size()));
+		return sortedValues[std::clamp<std::size_t>(rank, 1, sortedValues.size()) - 1];
+	}
+
+	std::string EscapeJson(std::string_view str)
+	{
+		std::string escaped;
+		escaped.reserve(str.size());
+		for (char c : str)
+		{
+			if (c == '"' || c == '\\')
+				escaped += '\\';
+
+			escaped += c;
+		}
+
+		return escaped;
+	}
+
+	bool WriteBenchmarkReport(const std::filesystem::path& reportPath, const Nz::RenderDevice& device, std::size_t warmupFrameCount, Nz::Time timestep, const std::vector<BenchmarkSample>& samples)
+	{
+		std::ofstream report(reportPath, std::ios::trunc);
+		if (!report)
+			return false;
+
+		std::vector<double> frameTimes;
+		frameTimes.reserve(samples.size());
+
+		double frameTimeSum = 0.0;
+		Nz::RenderFrameStatistics statisticsSum;
+		for (const BenchmarkSample& sample : samples)
+		{
+			frameTimes.push_back(sample.frameTime);
+			frameTimeSum += sample.frameTime;
+
+			statisticsSum.commands.drawCallCount += sample.statistics.commands.drawCallCount;
+			statisticsSum.commands.drawnVertexCount += sample.statistics.commands.drawnVertexCount;
+			statisticsSum.commands.pipelineBindCount += sample.statistics.commands.pipelineBindCount;
+			statisticsSum.commands.renderPassCount += sample.statistics.commands.renderPassCount;
+			statisticsSum.commands.shaderBindingBindCount += sample.statistics.commands.shaderBindingBindCount;
+			statisticsSum.submittedCommandBufferCount += sample.statistics.submittedCommandBufferCount;
+			statisticsSum.uploadedBytes += sample.statistics.uploadedBytes;
+		}
+
+		std::sort(frameTimes.begin(), frameTimes.end());
+
+		double sampleCount = std::max<double>(samples.size(), 1.0);
+		auto Mean = [&](Nz::UInt64 sum) { return sum / sampleCount; };
+
+		report << "{\n";
+		report << "\t\"device\": \"" << EscapeJson(device.GetDeviceInfo().name) << "\",\n";
+		report << "\t\"warmupFrames\": " << warmupFrameCount << ",\n";
+		report << "\t\"frames\": " << samples.size() << ",\n";
+		report << "\t\"timestep\": " << timestep.AsMicroseconds() / 1000.0 << ",\n";
+		report << "\t\"frameTime\": {\n";
+		report << "\t\t\"min\": " << (frameTimes.empty() ? 0.0 : frameTimes.front()) << ",\n";
+		report << "\t\t\"mean\": " << frameTimeSum / sampleCount << ",\n";
+		report << "\t\t\"p50\": " << ComputePercentile(frameTimes, 50.0) << ",\n";
+		report << "\t\t\"p95\": " << ComputePercentile(frameTimes, 95.0) << ",\n";
+		report << "\t\t\"p99\": " << ComputePercentile(frameTimes, 99.0) << ",\n";
+		report << "\t\t\"max\": " << (frameTimes.empty() ? 0.0 : frameTimes.back()) << "\n";
+		report << "\t},\n";
+		report << "\t\"renderer\": {\n";
+		report << "\t\t\"drawCalls\": " << Mean(statisticsSum.commands.drawCallCount) << ",\n";
+		report << "\t\t\"drawnVertices\": " << Mean(statisticsSum.commands.drawnVertexCount) << ",\n";
+		report << "\t\t\"pipelineBinds\": " << Mean(statisticsSum.commands.pipelineBindCount) << ",\n";
+		report << "\t\t\"renderPasses\": " << Mean(statisticsSum.commands.renderPassCount) << ",\n";
+		report << "\t\t\"shaderBindingBinds\": " << Mean(statisticsSum.commands.shaderBindingBindCount) << ",\n";
+		report << "\t\t\"submittedCommandBuffers\": " << Mean(statisticsSum.submittedCommandBufferCount) << ",\n";
+		report << "\t\t\"uploadedBytes\": " << Mean(statisticsSum.uploadedBytes) << "\n";
+		report << "\t},\n";
+
+		// Per-frame values, in frame order, so runs can be compared frame for frame
+		report << "\t\"samples\": [\n";
+		for (std::size_t i = 0; i < samples.size(); ++i)
+		{
+			const BenchmarkSample& sample = samples[i];
+			report << "\t\t{ \"frameTime\": " << sample.frameTime << ", \"drawCalls\": " << sample.statistics.commands.drawCallCount << ", \"drawnVertices\": " << sample.statistics.commands.drawnVertexCount << " }";
+			report << ((i + 1 < samples.size()) ? ",\n" : "\n");
+		}
+		report << "\t]\n";
+		report << "}\n";
+
+		return report.good();
+	}
+}
+
 int main(int argc, char* argv[])
 {
 	Nz::Application<Nz::Graphics, Nz::JoltPhysics3D> app(argc, argv);
 
+	// --benchmark [--benchmark-frames=N] [--benchmark-warmup=N] [--benchmark-output=path]
+	const Nz::CommandLineParameters& cmdParams = app.GetCommandLineParameters();
+	bool benchmark = cmdParams.HasFlag("benchmark");
+	std::size_t benchmarkFrameCount = 1000;
+	std::size_t benchmarkWarmupFrameCount = 120;
+	std::filesystem::path benchmarkReportPath = "showcase_benchmark.json";
+	constexpr Nz::Time benchmarkTimestep = Nz::Time::TickDuration(60);
+	{
+		std::string_view value;
+		if (cmdParams.GetParameter("benchmark-frames", &value))
+		{
+			bool ok;
+			long long frameCount = Nz::StringToNumber(value, 10, &ok);
+			if (!ok || frameCount <= 0)
+			{
+				std::cerr << "invalid benchmark frame count " << value << std::endl;
+				return EXIT_FAILURE;
+			}
+
+			benchmarkFrameCount = static_cast<std::size_t>(frameCount);
+		}
+
+		if (cmdParams.GetParameter("benchmark-warmup", &value))
+		{
+			bool ok;
+			long long frameCount = Nz::StringToNumber(value, 10, &ok);
+			if (!ok || frameCount < 0)
+			{
+				std::cerr << "invalid benchmark warmup frame count " << value << std::endl;
+				return EXIT_FAILURE;
+			}
+
+			benchmarkWarmupFrameCount = static_cast<std::size_t>(frameCount);
+		}
+
+		if (cmdParams.GetParameter("benchmark-output", &value))
+			benchmarkReportPath = std::filesystem::path(value);
+	}
+
 	Nz::PluginLoader loader;
 	Nz::Plugin<Nz::AssimpPlugin> assimp = loader.Load<Nz::AssimpPlugin>();
 
@@ -41,6 +186,10 @@ int main(int argc, char* argv[])
 	Nz::Window& mainWindow = windowing.CreateWindow(Nz::VideoMode(1280, 720), windowTitle);
 	auto& windowSwapchain = renderSystem.CreateSwapchain(mainWindow);
 
+	// Don't let vertical sync cap frame times while benchmarking
+	if (benchmark && windowSwapchain.GetSwapchain().GetSupportedPresentModes().Test(Nz::PresentMode::Immediate))
+		windowSwapchain.GetSwapchain().SetPresentMode(Nz::PresentMode::Immediate);
+
 	auto& fs = app.AddComponent<Nz::AppFilesystemComponent>();
 	{
 		std::filesystem::path resourceDir = "assets/examples";
@@ -395,16 +544,20 @@ int main(int argc, char* argv[])
 	Nz::EulerAnglesf camAngles = Nz::EulerAnglesf(-30.f, 0.f, 0.f);
 	Nz::UInt64 fps = 0;
 	bool paused = false;
+	Nz::Time benchmarkTime = Nz::Time::Zero();
 
 	Nz::WindowEventHandler& eventHandler = mainWindow.GetEventHandler();
 	eventHandler.OnKeyPressed.Connect([&](const Nz::WindowEventHandler*, const Nz::WindowEvent::KeyEvent& event)
 	{
-		if (event.virtualKey == Nz::Keyboard::VKey::P)
+		if (!benchmark && event.virtualKey == Nz::Keyboard::VKey::P)
 			paused = !paused;
 	});
 
 	eventHandler.OnMouseMoved.Connect([&](const Nz::WindowEventHandler*, const Nz::WindowEvent::MouseMoveEvent& event)
 	{
+		if (benchmark)
+			return;
+
 		// Gestion de la caméra free-fly (Rotation)
 		float sensitivity = 0.3f; // Sensibilité de la souris
 
@@ -423,9 +576,12 @@ int main(int argc, char* argv[])
 
 	app.AddUpdaterFunc([&]
 	{
-		if (std::optional<Nz::Time> deltaTime = updateClock.RestartIfOver(Nz::Time::TickDuration(60)))
+		// Benchmark frames all advance the simulation by the same timestep, so runs are comparable frame for frame
+		std::optional<Nz::Time> deltaTime = (benchmark) ? std::optional<Nz::Time>(benchmarkTimestep) : updateClock.RestartIfOver(Nz::Time::TickDuration(60));
+		if (deltaTime)
 		{
 			float updateTime = deltaTime->AsSeconds();
+			benchmarkTime += *deltaTime;
 
 			//auto& playerBody = playerEntity.get<Nz::JoltRigidBody3DComponent>();
 			//playerBody.SetAngularDamping(std::numeric_limits<float>::max());
@@ -434,43 +590,57 @@ int main(int argc, char* argv[])
 			velocity.x = 0.f;
 			velocity.z = 0.f;
 
-			if (Nz::Keyboard::IsKeyPressed(Nz::Keyboard::VKey::RShift))
+			auto& cameraNode = playerCamera.get<Nz::NodeComponent>();
+			if (benchmark)
 			{
-				if (character->IsOnGround())
-					velocity += Nz::Vector3f::Up() * 2.f;
+				// Scripted camera path (keyboard is ignored): orbit around the scene while slowly moving up and down
+				float pathTime = benchmarkTime.AsSeconds();
+				Nz::Quaternionf pathRotation = Nz::EulerAnglesf(-20.f + 10.f * std::sin(pathTime * 0.5f), pathTime * 30.f, 0.f).ToQuaternion();
+
+				cameraNode.SetPosition(pathRotation * Nz::Vector3f::Backward() * 4.f + Nz::Vector3f::Up() * 1.5f);
+				cameraNode.SetRotation(pathRotation);
+
+				character->SetLinearVelocity(velocity);
 			}
+			else
+			{
+				if (Nz::Keyboard::IsKeyPressed(Nz::Keyboard::VKey::RShift))
+				{
+					if (character->IsOnGround())
+						velocity += Nz::Vector3f::Up() * 2.f;
+				}
 
-			if (Nz::Keyboard::IsKeyPressed(Nz::Keyboard::VKey::Up))
-				velocity += Nz::Vector3f::Forward();
+				if (Nz::Keyboard::IsKeyPressed(Nz::Keyboard::VKey::Up))
+					velocity += Nz::Vector3f::Forward();
 
-			if (Nz::Keyboard::IsKeyPressed(Nz::Keyboard::VKey::Down))
-				velocity += Nz::Vector3f::Backward();
+				if (Nz::Keyboard::IsKeyPressed(Nz::Keyboard::VKey::Down))
+					velocity += Nz::Vector3f::Backward();
 
-			if (Nz::Keyboard::IsKeyPressed(Nz::Keyboard::VKey::Left))
-				velocity += Nz::Vector3f::Left();
+				if (Nz::Keyboard::IsKeyPressed(Nz::Keyboard::VKey::Left))
+					velocity += Nz::Vector3f::Left();
 
-			if (Nz::Keyboard::IsKeyPressed(Nz::Keyboard::VKey::Right))
-				velocity += Nz::Vector3f::Right();
+				if (Nz::Keyboard::IsKeyPressed(Nz::Keyboard::VKey::Right))
+					velocity += Nz::Vector3f::Right();
 
-			character->SetLinearVelocity(velocity);
+				character->SetLinearVelocity(velocity);
 
-			float cameraSpeed = 2.f;
+				float cameraSpeed = 2.f;
 
-			auto& cameraNode = playerCamera.get<Nz::NodeComponent>();
-			if (Nz::Keyboard::IsKeyPressed(Nz::Keyboard::VKey::Space))
-				cameraNode.Move(Nz::Vector3f::Up() * cameraSpeed * updateTime, Nz::CoordSys::Global);
+				if (Nz::Keyboard::IsKeyPressed(Nz::Keyboard::VKey::Space))
+					cameraNode.Move(Nz::Vector3f::Up() * cameraSpeed * updateTime, Nz::CoordSys::Global);
 
-			if (Nz::Keyboard::IsKeyPressed(Nz::Keyboard::VKey::Z))
-				cameraNode.Move(Nz::Vector3f::Forward() * cameraSpeed * updateTime, Nz::CoordSys::Local);
+				if (Nz::Keyboard::IsKeyPressed(Nz::Keyboard::VKey::Z))
+					cameraNode.Move(Nz::Vector3f::Forward() * cameraSpeed * updateTime, Nz::CoordSys::Local);
 
-			if (Nz::Keyboard::IsKeyPressed(Nz::Keyboard::VKey::S))
-				cameraNode.Move(Nz::Vector3f::Backward() * cameraSpeed * updateTime, Nz::CoordSys::Local);
+				if (Nz::Keyboard::IsKeyPressed(Nz::Keyboard::VKey::S))
+					cameraNode.Move(Nz::Vector3f::Backward() * cameraSpeed * updateTime, Nz::CoordSys::Local);
 
-			if (Nz::Keyboard::IsKeyPressed(Nz::Keyboard::VKey::Q))
-				cameraNode.Move(Nz::Vector3f::Left() * cameraSpeed * updateTime, Nz::CoordSys::Local);
+				if (Nz::Keyboard::IsKeyPressed(Nz::Keyboard::VKey::Q))
+					cameraNode.Move(Nz::Vector3f::Left() * cameraSpeed * updateTime, Nz::CoordSys::Local);
 
-			if (Nz::Keyboard::IsKeyPressed(Nz::Keyboard::VKey::D))
-				cameraNode.Move(Nz::Vector3f::Right() * cameraSpeed * updateTime, Nz::CoordSys::Local);
+				if (Nz::Keyboard::IsKeyPressed(Nz::Keyboard::VKey::D))
+					cameraNode.Move(Nz::Vector3f::Right() * cameraSpeed * updateTime, Nz::CoordSys::Local);
+			}
 
 			if (!paused)
 			{
@@ -485,7 +655,8 @@ int main(int argc, char* argv[])
 						nextFrame = 0;
 				}
 
-				std::cout << currentFrame << std::endl;
+				if (!benchmark)
+					std::cout << currentFrame << std::endl;
 
 				bobAnim->AnimateSkeleton(skeleton.get(), currentFrame, nextFrame, incr);
 			}
@@ -560,5 +731,35 @@ int main(int argc, char* argv[])
 		}
 	});
 
+	if (benchmark)
+	{
+		std::vector<BenchmarkSample> samples;
+		samples.reserve(benchmarkFrameCount);
+
+		Nz::HighPrecisionClock frameClock;
+		for (std::size_t frameIndex = 0; frameIndex < benchmarkWarmupFrameCount + benchmarkFrameCount; ++frameIndex)
+		{
+			if (!app.Update(benchmarkTimestep))
+				break; //< window was closed
+
+			Nz::Time frameTime = frameClock.Restart();
+			if (frameIndex < benchmarkWarmupFrameCount)
+				continue;
+
+			BenchmarkSample& sample = samples.emplace_back();
+			sample.frameTime = frameTime.AsMicroseconds() / 1000.0;
+			sample.statistics = device->GetFrameStatistics();
+		}
+
+		if (!WriteBenchmarkReport(benchmarkReportPath, *device, benchmarkWarmupFrameCount, benchmarkTimestep, samples))
+		{
+			std::cerr << "failed to write benchmark report to " << benchmarkReportPath.generic_u8string() << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		std::cout << "benchmark report written to " << benchmarkReportPath.generic_u8string() << " (" << samples.size() << " frames)" << std::endl;
+		return EXIT_SUCCESS;
+	}
+
 	return app.Run();
 }
@@ -35,6 +35,7 @@ int main(int argc, char* argv[])
 	auto& windowSwapchain = renderSystem.CreateSwapchain(mainWindow);
 
 	Nz::Canvas canvas2D(world, mainWindow.GetEventHandler(), mainWindow.GetCursorController().CreateHandle(), 0xFFFFFFFF);
+	canvas2D.EnableDeferredLayout();
 	canvas2D.Resize(Nz::Vector2f(mainWindow.GetSize()));
 
 	Nz::LabelWidget* labelWidget = canvas2D.Add<Nz::LabelWidget>();
@@ -109,5 +110,10 @@ int main(int argc, char* argv[])
 		cameraComponent.UpdateClearColor(Nz::Color(0.46f, 0.48f, 0.84f, 1.f));
 	}
 
+	app.AddUpdaterFunc([&]
+	{
+		canvas2D.UpdateLayouts();
+	});
+
 	return app.Run();
 }
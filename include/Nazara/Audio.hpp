@@ -33,7 +33,10 @@
 #include <Nazara/Audio/Audio.hpp>
 #include <Nazara/Audio/AudioBuffer.hpp>
 #include <Nazara/Audio/AudioDevice.hpp>
+#include <Nazara/Audio/AudioResampler.hpp>
 #include <Nazara/Audio/AudioSource.hpp>
+#include <Nazara/Audio/AudioStreamer.hpp>
+#include <Nazara/Audio/AudioVoiceManager.hpp>
 #include <Nazara/Audio/Config.hpp>
 #include <Nazara/Audio/DummyAudioBuffer.hpp>
 #include <Nazara/Audio/DummyAudioDevice.hpp>
@@ -48,6 +51,16 @@
 #include <Nazara/Audio/Sound.hpp>
 #include <Nazara/Audio/SoundBuffer.hpp>
 #include <Nazara/Audio/SoundEmitter.hpp>
+#include <Nazara/Audio/SoundPool.hpp>
 #include <Nazara/Audio/SoundStream.hpp>
+#include <Nazara/Audio/SoundStreamPlayer.hpp>
+#include <Nazara/Audio/VirtualAudioSource.hpp>
+
+#ifdef NAZARA_ENTT
+
+#include <Nazara/Audio/Components.hpp>
+#include <Nazara/Audio/Systems.hpp>
+
+#endif
 
 #endif // NAZARA_GLOBAL_AUDIO_HPP
@@ -8,14 +8,19 @@
 #define NAZARA_AUDIO_ALGORITHM_HPP
 
 #include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Audio/Config.hpp>
 #include <Nazara/Audio/Enums.hpp>
 #include <optional>
 
 namespace Nz
 {
+	NAZARA_AUDIO_API void ConvertSamples(const float* input, Int16* output, UInt64 sampleCount);
+	NAZARA_AUDIO_API void ConvertSamples(const Int16* input, float* output, UInt64 sampleCount);
+	NAZARA_AUDIO_API void ConvertSamples(const Int32* const* channels, UInt32 channelCount, UInt32 bitsPerSample, Int16* output, UInt64 frameCount);
 	inline UInt32 GetChannelCount(AudioFormat format);
 	inline std::optional<AudioFormat> GuessAudioFormat(UInt32 channelCount);
-	template<typename T> void MixToMono(T* input, T* output, UInt32 channelCount, UInt64 frameCount);
+	template<typename T> void MixToMono(const T* input, T* output, UInt32 channelCount, UInt64 frameCount);
+	NAZARA_AUDIO_API void MixToMono(const Int16* input, Int16* output, UInt32 channelCount, UInt64 frameCount);
 }
 
 #include <Nazara/Audio/Algorithm.inl>
@@ -95,9 +95,10 @@ namespace Nz
 	* \param frameCount Number of frames
 	*
 	* \remark The input buffer may be the same as the output one
+	* \remark Int16 samples use a vectorized overload
 	*/
 	template<typename T>
-	void MixToMono(T* input, T* output, UInt32 channelCount, UInt64 frameCount)
+	void MixToMono(const T* input, T* output, UInt32 channelCount, UInt64 frameCount)
 	{
 		// To avoid overflow, we use, as an accumulator, a type which is large enough: (u)int 64 bits for integers, double for floatings
 		using BiggestInt = typename std::conditional<std::is_unsigned<T>::value, UInt64, Int64>::type;
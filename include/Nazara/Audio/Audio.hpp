@@ -13,6 +13,7 @@
 #include <Nazara/Audio/SoundBuffer.hpp>
 #include <Nazara/Audio/SoundStream.hpp>
 #include <Nazara/Core/Core.hpp>
+#include <future>
 
 namespace Nz
 {
@@ -56,7 +57,7 @@ namespace Nz
 			};
 
 		private:
-			std::shared_ptr<AudioDevice> m_defaultDevice;
+			std::shared_future<std::shared_ptr<AudioDevice>> m_defaultDevice;
 			SoundBufferLoader m_soundBufferLoader;
 			SoundStreamLoader m_soundStreamLoader;
 			bool m_hasDummyDevice;
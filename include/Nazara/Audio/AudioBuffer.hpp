@@ -24,6 +24,7 @@ namespace Nz
 			AudioBuffer(AudioBuffer&&) = default;
 			virtual ~AudioBuffer();
 
+			virtual AudioFormat GetAudioFormat() const = 0;
 			inline const std::shared_ptr<AudioDevice>& GetAudioDevice() const;
 			virtual UInt64 GetSampleCount() const = 0;
 			virtual UInt64 GetSize() const = 0;
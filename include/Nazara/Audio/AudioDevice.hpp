@@ -15,16 +15,19 @@
 #include <Nazara/Math/Vector3.hpp>
 #include <NazaraUtils/Signal.hpp>
 #include <memory>
+#include <mutex>
 
 namespace Nz
 {
 	class AudioBuffer;
 	class AudioSource;
+	class AudioStreamer;
+	class AudioVoiceManager;
 
 	class NAZARA_AUDIO_API AudioDevice : public std::enable_shared_from_this<AudioDevice>
 	{
 		public:
-			AudioDevice() = default;
+			AudioDevice();
 			AudioDevice(const AudioDevice&) = delete;
 			AudioDevice(AudioDevice&&) = delete;
 			virtual ~AudioDevice();
@@ -32,6 +35,8 @@ namespace Nz
 			virtual std::shared_ptr<AudioBuffer> CreateBuffer() = 0;
 			virtual std::shared_ptr<AudioSource> CreateSource() = 0;
 
+			virtual void DeferUpdates() = 0;
+
 			virtual float GetDopplerFactor() const = 0;
 			virtual float GetGlobalVolume() const = 0;
 			virtual Vector3f GetListenerDirection(Vector3f* up = nullptr) const = 0;
@@ -39,10 +44,14 @@ namespace Nz
 			virtual Quaternionf GetListenerRotation() const = 0;
 			virtual Vector3f GetListenerVelocity() const = 0;
 			virtual float GetSpeedOfSound() const = 0;
+			AudioStreamer& GetStreamer();
 			virtual const void* GetSubSystemIdentifier() const = 0;
+			AudioVoiceManager& GetVoiceManager();
 
 			virtual bool IsFormatSupported(AudioFormat format) const = 0;
 
+			virtual void ProcessUpdates() = 0;
+
 			virtual void SetDopplerFactor(float dopplerFactor) = 0;
 			virtual void SetGlobalVolume(float volume) = 0;
 			virtual void SetListenerDirection(const Vector3f& direction, const Vector3f& up = Vector3f::Up()) = 0;
@@ -55,6 +64,12 @@ namespace Nz
 			AudioDevice& operator=(AudioDevice&&) = delete;
 
 			NazaraSignal(OnAudioDeviceRelease, AudioDevice* /*audioDevice*/);
+
+		private:
+			std::once_flag m_streamerFlag;
+			std::once_flag m_voiceManagerFlag;
+			std::unique_ptr<AudioStreamer> m_streamer;
+			std::unique_ptr<AudioVoiceManager> m_voiceManager; //< declared after the streamer as it unregisters from it
 	};
 }
 
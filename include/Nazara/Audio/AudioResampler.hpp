@@ -0,0 +1,67 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_AUDIO_AUDIORESAMPLER_HPP
+#define NAZARA_AUDIO_AUDIORESAMPLER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Audio/Config.hpp>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_AUDIO_API AudioResampler
+	{
+		public:
+			AudioResampler(UInt32 channelCount, UInt32 inputRate, UInt32 outputRate, UInt32 quality = DefaultQuality);
+			AudioResampler(const AudioResampler&) = default;
+			AudioResampler(AudioResampler&&) noexcept = default;
+			~AudioResampler() = default;
+
+			UInt64 Flush(Int16* output, UInt64 maxFrameCount);
+
+			inline UInt32 GetChannelCount() const;
+			inline UInt32 GetInputRate() const;
+			UInt64 GetOutputFrameCount(UInt64 inputFrameCount) const;
+			inline UInt32 GetOutputRate() const;
+
+			UInt64 Process(const Int16* input, UInt64 frameCount, Int16* output, UInt64 maxFrameCount);
+
+			void Reset();
+
+			AudioResampler& operator=(const AudioResampler&) = default;
+			AudioResampler& operator=(AudioResampler&&) noexcept = default;
+
+			static std::vector<Int16> Resample(const Int16* input, UInt64 frameCount, UInt32 channelCount, UInt32 inputRate, UInt32 outputRate, UInt32 quality = DefaultQuality);
+
+			static constexpr UInt32 DefaultQuality = 16; //< filter zero crossings on each side of a sample
+			static constexpr UInt32 MaxPhaseCount = 512;
+
+		private:
+			UInt64 Produce(UInt64 maxFrameCount);
+
+			std::vector<std::vector<float>> m_channelSamples;
+			std::vector<float> m_filterBank;
+			std::vector<float> m_outputSamples;
+			std::size_t m_position;
+			UInt64 m_inputFrameCount;
+			UInt64 m_outputFrameCount;
+			UInt32 m_channelCount;
+			UInt32 m_halfTapCount;
+			UInt32 m_inputRate;
+			UInt32 m_outputRate;
+			UInt32 m_phase;
+			UInt32 m_phaseCount;
+			UInt32 m_phaseDenominator;
+			UInt32 m_phaseStep;
+			UInt32 m_tapCount;
+			bool m_isFlushing;
+	};
+}
+
+#include <Nazara/Audio/AudioResampler.inl>
+
+#endif // NAZARA_AUDIO_AUDIORESAMPLER_HPP
@@ -0,0 +1,25 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Audio/Debug.hpp>
+
+namespace Nz
+{
+	inline UInt32 AudioResampler::GetChannelCount() const
+	{
+		return m_channelCount;
+	}
+
+	inline UInt32 AudioResampler::GetInputRate() const
+	{
+		return m_inputRate;
+	}
+
+	inline UInt32 AudioResampler::GetOutputRate() const
+	{
+		return m_outputRate;
+	}
+}
+
+#include <Nazara/Audio/DebugOff.hpp>
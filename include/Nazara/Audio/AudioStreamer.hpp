@@ -0,0 +1,82 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_AUDIO_AUDIOSTREAMER_HPP
+#define NAZARA_AUDIO_AUDIOSTREAMER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Audio/Config.hpp>
+#include <Nazara/Core/Time.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_AUDIO_API AudioStreamer
+	{
+		public:
+			using UpdateCallback = std::function<std::optional<Time>()>;
+
+			AudioStreamer(std::size_t threadCount = 1);
+			AudioStreamer(const AudioStreamer&) = delete;
+			AudioStreamer(AudioStreamer&&) = delete;
+			~AudioStreamer();
+
+			std::size_t RegisterStream(UpdateCallback callback, Time prefetchDuration);
+			void RequestUpdate(std::size_t streamId);
+
+			void UnregisterStream(std::size_t streamId);
+
+			AudioStreamer& operator=(const AudioStreamer&) = delete;
+			AudioStreamer& operator=(AudioStreamer&&) = delete;
+
+			static constexpr Time MinUpdateInterval = Time::Milliseconds(5);
+
+		private:
+			using Clock = std::chrono::steady_clock;
+
+			struct QueueEntry
+			{
+				Clock::time_point deadline;
+				Clock::time_point wakeTime;
+				std::size_t streamId;
+				UInt64 generation;
+			};
+
+			struct StreamData
+			{
+				UpdateCallback callback;
+				std::thread::id updatingThread;
+				Time prefetchDuration;
+				UInt64 generation = 0; //< only the queue entry matching it is valid
+				bool isRemoved = false;
+				bool isUpdateRequested = false;
+				bool isUpdating = false;
+			};
+
+			void PushQueueEntry(std::vector<QueueEntry>& queue, const QueueEntry& entry, bool byDeadline);
+			QueueEntry PopQueueEntry(std::vector<QueueEntry>& queue, bool byDeadline);
+			void ThreadMain();
+
+			std::condition_variable m_queueCondition;
+			std::condition_variable m_updateCondition;
+			std::mutex m_mutex;
+			std::size_t m_nextStreamId;
+			std::unordered_map<std::size_t, StreamData> m_streams;
+			std::vector<QueueEntry> m_readyQueue;   //< streams to update, by underrun deadline
+			std::vector<QueueEntry> m_waitingQueue; //< streams waiting for their wake time
+			std::vector<std::thread> m_threads;
+			bool m_isRunning;
+	};
+}
+
+#endif // NAZARA_AUDIO_AUDIOSTREAMER_HPP
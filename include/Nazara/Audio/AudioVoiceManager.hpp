@@ -0,0 +1,67 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_AUDIO_AUDIOVOICEMANAGER_HPP
+#define NAZARA_AUDIO_AUDIOVOICEMANAGER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Audio/Config.hpp>
+#include <Nazara/Core/Time.hpp>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Nz
+{
+	class AudioDevice;
+	class VirtualAudioSource;
+
+	class NAZARA_AUDIO_API AudioVoiceManager
+	{
+		friend VirtualAudioSource;
+
+		public:
+			AudioVoiceManager(AudioDevice& device, std::size_t maxVoiceCount = DefaultMaxVoiceCount);
+			AudioVoiceManager(const AudioVoiceManager&) = delete;
+			AudioVoiceManager(AudioVoiceManager&&) = delete;
+			~AudioVoiceManager();
+
+			std::shared_ptr<VirtualAudioSource> CreateSource();
+
+			float GetAudibilityThreshold() const;
+			std::size_t GetMaxVoiceCount() const;
+			std::size_t GetVoiceCount() const;
+
+			void SetAudibilityThreshold(float threshold);
+			void SetMaxVoiceCount(std::size_t maxVoiceCount);
+
+			void Update();
+
+			AudioVoiceManager& operator=(const AudioVoiceManager&) = delete;
+			AudioVoiceManager& operator=(AudioVoiceManager&&) = delete;
+
+			static constexpr float DefaultAudibilityThreshold = 0.001f;
+			static constexpr std::size_t DefaultMaxVoiceCount = 32;
+			static constexpr Time UpdateInterval = Time::Milliseconds(100);
+
+		private:
+			void ReleaseVoice();
+			void RequestUpdate();
+			bool TryReserveVoice();
+			void UnregisterSource(VirtualAudioSource* source);
+
+			mutable std::mutex m_mutex; //< protects voice counters, never held while locking a source
+			std::mutex m_sourceMutex; //< protects the source list and serializes updates
+			std::size_t m_maxVoiceCount;
+			std::size_t m_streamId;
+			std::size_t m_voiceCount;
+			std::vector<VirtualAudioSource*> m_sources;
+			AudioDevice& m_device;
+			float m_audibilityThreshold;
+	};
+}
+
+#endif // NAZARA_AUDIO_AUDIOVOICEMANAGER_HPP
@@ -0,0 +1,47 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_AUDIO_COMPONENTS_SOUNDEMITTERCOMPONENT_HPP
+#define NAZARA_AUDIO_COMPONENTS_SOUNDEMITTERCOMPONENT_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Audio/Config.hpp>
+#include <Nazara/Audio/SoundEmitter.hpp>
+#include <NazaraUtils/Signal.hpp>
+#include <memory>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_AUDIO_API SoundEmitterComponent
+	{
+		public:
+			SoundEmitterComponent() = default;
+			SoundEmitterComponent(const SoundEmitterComponent&) = delete;
+			SoundEmitterComponent(SoundEmitterComponent&&) = default;
+			~SoundEmitterComponent() = default;
+
+			inline void AttachEmitter(std::shared_ptr<SoundEmitter> emitter);
+
+			inline void Clear();
+
+			inline void DetachEmitter(const SoundEmitter& emitter);
+
+			inline const std::vector<std::shared_ptr<SoundEmitter>>& GetEmitters() const;
+
+			SoundEmitterComponent& operator=(const SoundEmitterComponent&) = delete;
+			SoundEmitterComponent& operator=(SoundEmitterComponent&&) = default;
+
+			NazaraSignal(OnEmitterAttached, SoundEmitterComponent* /*emitterComponent*/, const std::shared_ptr<SoundEmitter>& /*emitter*/);
+
+		private:
+			std::vector<std::shared_ptr<SoundEmitter>> m_emitters;
+	};
+}
+
+#include <Nazara/Audio/Components/SoundEmitterComponent.inl>
+
+#endif // NAZARA_AUDIO_COMPONENTS_SOUNDEMITTERCOMPONENT_HPP
@@ -0,0 +1,37 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Error.hpp>
+#include <algorithm>
+#include <Nazara/Audio/Debug.hpp>
+
+namespace Nz
+{
+	inline void SoundEmitterComponent::AttachEmitter(std::shared_ptr<SoundEmitter> emitter)
+	{
+		NazaraAssert(emitter, "invalid emitter");
+
+		const auto& attachedEmitter = m_emitters.emplace_back(std::move(emitter));
+		OnEmitterAttached(this, attachedEmitter);
+	}
+
+	inline void SoundEmitterComponent::Clear()
+	{
+		m_emitters.clear();
+	}
+
+	inline void SoundEmitterComponent::DetachEmitter(const SoundEmitter& emitter)
+	{
+		auto it = std::find_if(m_emitters.begin(), m_emitters.end(), [&](const auto& emitterPtr) { return emitterPtr.get() == &emitter; });
+		if (it != m_emitters.end())
+			m_emitters.erase(it);
+	}
+
+	inline auto SoundEmitterComponent::GetEmitters() const -> const std::vector<std::shared_ptr<SoundEmitter>>&
+	{
+		return m_emitters;
+	}
+}
+
+#include <Nazara/Audio/DebugOff.hpp>
@@ -23,7 +23,7 @@ namespace Nz
 			DummyAudioBuffer(DummyAudioBuffer&&) = delete;
 			~DummyAudioBuffer() = default;
 
-			AudioFormat GetAudioFormat() const;
+			AudioFormat GetAudioFormat() const override;
 			Time GetDuration() const;
 			UInt64 GetSampleCount() const override;
 			UInt64 GetSize() const override;
@@ -27,6 +27,8 @@ namespace Nz
 			std::shared_ptr<AudioBuffer> CreateBuffer() override;
 			std::shared_ptr<AudioSource> CreateSource() override;
 
+			void DeferUpdates() override;
+
 			float GetDopplerFactor() const override;
 			float GetGlobalVolume() const override;
 			Vector3f GetListenerDirection(Vector3f* up = nullptr) const override;
@@ -38,6 +40,8 @@ namespace Nz
 
 			bool IsFormatSupported(AudioFormat format) const override;
 
+			void ProcessUpdates() override;
+
 			void SetDopplerFactor(float dopplerFactor) override;
 			void SetGlobalVolume(float volume) override;
 			void SetListenerDirection(const Vector3f& direction, const Vector3f& up = Vector3f::Up()) override;
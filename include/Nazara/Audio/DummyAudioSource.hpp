@@ -11,6 +11,8 @@
 #include <Nazara/Audio/AudioSource.hpp>
 #include <Nazara/Audio/Config.hpp>
 #include <Nazara/Core/Clock.hpp>
+#include <mutex>
+#include <vector>
 
 namespace Nz
 {
@@ -73,6 +75,7 @@ namespace Nz
 			mutable std::vector<std::shared_ptr<DummyAudioBuffer>> m_processedBuffers;
 			mutable MillisecondClock m_playClock;
 			mutable SoundStatus m_status;
+			mutable std::recursive_mutex m_mutex; //< getters update the playing state, and streamed sources are accessed from the AudioStreamer
 			Vector3f m_position;
 			Vector3f m_velocity;
 			bool m_isLooping;
@@ -27,6 +27,17 @@ namespace Nz
 
 	constexpr std::size_t AudioFormatCount = static_cast<std::size_t>(AudioFormat::Max) + 1;
 
+	enum class SoundBufferStorage
+	{
+		Automatic,  //< Compressed for large files which compress well, Decoded otherwise
+		Compressed, //< Keeps the encoded file in memory, decoded on the fly by every sound playing it
+		Decoded,    //< Decodes the whole file to samples when loading
+
+		Max = Decoded
+	};
+
+	constexpr std::size_t SoundBufferStorageCount = static_cast<std::size_t>(SoundBufferStorage::Max) + 1;
+
 	enum class SoundStatus
 	{
 		Playing,
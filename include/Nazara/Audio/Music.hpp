@@ -11,17 +11,11 @@
 #include <Nazara/Audio/Enums.hpp>
 #include <Nazara/Audio/SoundEmitter.hpp>
 #include <Nazara/Audio/SoundStream.hpp>
-#include <atomic>
-#include <condition_variable>
+#include <Nazara/Audio/SoundStreamPlayer.hpp>
 #include <memory>
-#include <mutex>
-#include <thread>
-#include <vector>
 
 namespace Nz
 {
-	class AudioBuffer;
-
 	class NAZARA_AUDIO_API Music final : public Resource, public SoundEmitter
 	{
 		public:
@@ -61,22 +55,8 @@ namespace Nz
 			Music& operator=(Music&&) = delete;
 
 		private:
-			AudioFormat m_audioFormat;
-			std::atomic_bool m_streaming;
-			std::atomic<UInt64> m_processedSamples;
-			mutable std::recursive_mutex m_sourceLock;
-			std::size_t m_bufferCount;
-			std::shared_ptr<SoundStream> m_stream;
-			std::thread m_thread;
-			std::vector<Int16> m_chunkSamples;
-			UInt32 m_sampleRate;
-			UInt64 m_streamOffset;
+			std::unique_ptr<SoundStreamPlayer> m_player;
 			bool m_looping;
-
-			bool FillAndQueueBuffer(std::shared_ptr<AudioBuffer> buffer);
-			void MusicThread(std::condition_variable& cv, std::mutex& m, std::exception_ptr& err, bool startPaused);
-			void StartThread(bool startPaused);
-			void StopThread();
 	};
 }
 
@@ -27,6 +27,7 @@ namespace Nz
 			OpenALBuffer(OpenALBuffer&&) = delete;
 			~OpenALBuffer();
 
+			AudioFormat GetAudioFormat() const override;
 			inline ALuint GetBufferId() const;
 			UInt64 GetSampleCount() const override;
 			UInt64 GetSize() const override;
@@ -44,6 +45,7 @@ namespace Nz
 			const OpenALDevice& GetDevice() const;
 
 			ALuint m_bufferId;
+			AudioFormat m_format;
 			OpenALLibrary& m_library;
 	};
 }
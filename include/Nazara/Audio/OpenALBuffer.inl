@@ -9,6 +9,7 @@ namespace Nz
 	inline OpenALBuffer::OpenALBuffer(std::shared_ptr<AudioDevice> device, OpenALLibrary& library, ALuint bufferId) :
 	AudioBuffer(std::move(device)),
 	m_bufferId(bufferId),
+	m_format(AudioFormat::Unknown),
 	m_library(library)
 	{
 	}
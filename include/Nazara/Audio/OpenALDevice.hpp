@@ -26,6 +26,7 @@ namespace Nz
 
 	enum class OpenALExtension
 	{
+		DeferredUpdates,
 		SourceLatency,
 
 		Max = SourceLatency
@@ -44,6 +45,8 @@ namespace Nz
 			std::shared_ptr<AudioBuffer> CreateBuffer() override;
 			std::shared_ptr<AudioSource> CreateSource() override;
 
+			void DeferUpdates() override;
+
 			float GetDopplerFactor() const override;
 			float GetGlobalVolume() const override;
 			Vector3f GetListenerDirection(Vector3f* up = nullptr) const override;
@@ -58,6 +61,8 @@ namespace Nz
 
 			void MakeContextCurrent() const;
 
+			void ProcessUpdates() override;
+
 			void SetDopplerFactor(float dopplerFactor) override;
 			void SetGlobalVolume(float volume) override;
 			void SetListenerDirection(const Vector3f& direction, const Vector3f& up = Vector3f::Up()) override;
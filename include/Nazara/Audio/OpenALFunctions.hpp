@@ -103,6 +103,11 @@ NAZARA_AUDIO_AL_FUNCTION(alSourceUnqueueBuffers)
 NAZARA_AUDIO_AL_FUNCTION(alSpeedOfSound)
 
 #ifndef NAZARA_PLATFORM_WEB
+NAZARA_AUDIO_AL_EXT_BEGIN(AL_SOFT_deferred_updates)
+NAZARA_AUDIO_AL_EXT_FUNCTION(alDeferUpdatesSOFT)
+NAZARA_AUDIO_AL_EXT_FUNCTION(alProcessUpdatesSOFT)
+NAZARA_AUDIO_AL_EXT_END()
+
 NAZARA_AUDIO_AL_EXT_BEGIN(AL_SOFT_source_latency)
 NAZARA_AUDIO_AL_EXT_FUNCTION(alGetSource3dSOFT)
 NAZARA_AUDIO_AL_EXT_FUNCTION(alGetSource3i64SOFT)
@@ -11,6 +11,8 @@
 #include <Nazara/Audio/Enums.hpp>
 #include <Nazara/Audio/SoundBuffer.hpp>
 #include <Nazara/Audio/SoundEmitter.hpp>
+#include <Nazara/Audio/SoundStreamPlayer.hpp>
+#include <memory>
 
 namespace Nz
 {
@@ -53,6 +55,10 @@ namespace Nz
 			Sound& operator=(Sound&&) = default;
 
 		private:
+			static constexpr std::size_t StreamBufferCount = 3;
+			static constexpr Time StreamChunkDuration = Time::Milliseconds(250);
+
+			std::unique_ptr<SoundStreamPlayer> m_player; //< streams compressed buffers, declared first to be released before its buffer when move-assigned
 			std::shared_ptr<SoundBuffer> m_buffer;
 	};
 }
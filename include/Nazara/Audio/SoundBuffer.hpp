@@ -11,20 +11,26 @@
 #include <Nazara/Audio/AudioDevice.hpp>
 #include <Nazara/Audio/Config.hpp>
 #include <Nazara/Audio/Enums.hpp>
+#include <Nazara/Audio/SoundStream.hpp>
 #include <Nazara/Core/ObjectLibrary.hpp>
 #include <Nazara/Core/Resource.hpp>
 #include <Nazara/Core/ResourceLoader.hpp>
 #include <Nazara/Core/ResourceManager.hpp>
 #include <Nazara/Core/ResourceParameters.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Core/Time.hpp>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace Nz
 {
 	struct SoundBufferParams : ResourceParameters
 	{
+		SoundBufferStorage storage = SoundBufferStorage::Automatic;
+		UInt64 compressedStorageThreshold = 1024 * 1024; //< decoded size (in bytes) from which automatic storage keeps files compressed
 		bool forceMono = false;
+		UInt32 sampleRate = 0; //< if not zero, decoded samples are resampled to this rate (compressed storage keeps the source rate)
 
 		bool IsValid() const;
 	};
@@ -45,30 +51,41 @@ namespace Nz
 		friend Sound;
 
 		public:
+			class LoadHandle;
 			using Params = SoundBufferParams;
 
 			SoundBuffer() = default;
 			SoundBuffer(AudioFormat format, UInt64 sampleCount, UInt32 sampleRate, const Int16* samples);
+			SoundBuffer(AudioFormat format, UInt64 sampleCount, UInt32 sampleRate, std::vector<UInt8> compressedData, const SoundStreamParams& streamParams);
 			SoundBuffer(const SoundBuffer&) = delete;
 			SoundBuffer(SoundBuffer&&) = delete;
 			~SoundBuffer() = default;
 
 			const std::shared_ptr<AudioBuffer>& GetAudioBuffer(AudioDevice* device);
 
+			inline const std::vector<UInt8>& GetCompressedData() const;
 			inline Time GetDuration() const;
 			inline AudioFormat GetFormat() const;
+			std::size_t GetMemoryUsage() const override;
 			inline const Int16* GetSamples() const;
 			inline UInt64 GetSampleCount() const;
 			inline UInt32 GetSampleRate() const;
 
+			inline bool IsCompressed() const;
+
+			std::shared_ptr<SoundStream> OpenStream() const;
+
 			SoundBuffer& operator=(const SoundBuffer&) = delete;
 			SoundBuffer& operator=(SoundBuffer&&) = delete;
 
 			static std::shared_ptr<SoundBuffer> LoadFromFile(const std::filesystem::path& filePath, const SoundBufferParams& params = SoundBufferParams());
+			static LoadHandle LoadFromFileAsync(std::filesystem::path filePath, SoundBufferParams params = SoundBufferParams(), std::shared_ptr<AudioDevice> uploadDevice = nullptr);
 			static std::shared_ptr<SoundBuffer> LoadFromMemory(const void* data, std::size_t size, const SoundBufferParams& params = SoundBufferParams());
 			static std::shared_ptr<SoundBuffer> LoadFromStream(Stream& stream, const SoundBufferParams& params = SoundBufferParams());
 
 		private:
+			static std::shared_ptr<SoundBuffer> ApplyParams(std::shared_ptr<SoundBuffer> soundBuffer, const SoundBufferParams& params);
+
 			struct AudioDeviceEntry
 			{
 				std::shared_ptr<AudioBuffer> audioBuffer;
@@ -78,11 +95,38 @@ namespace Nz
 
 			std::unordered_map<AudioDevice*, AudioDeviceEntry> m_audioBufferByDevice;
 			std::unique_ptr<Int16[]> m_samples;
+			std::vector<UInt8> m_compressedData;
 			AudioFormat m_format;
+			SoundStreamParams m_streamParams;
 			Time m_duration;
 			UInt32 m_sampleRate;
 			UInt64 m_sampleCount;
 	};
+
+	class NAZARA_AUDIO_API SoundBuffer::LoadHandle
+	{
+		friend SoundBuffer;
+
+		public:
+			LoadHandle() = default;
+			LoadHandle(const LoadHandle&) = default;
+			LoadHandle(LoadHandle&&) noexcept = default;
+			~LoadHandle() = default;
+
+			std::shared_ptr<SoundBuffer> GetSoundBuffer() const;
+
+			bool IsFinished() const;
+			inline bool IsValid() const;
+
+			std::shared_ptr<SoundBuffer> Wait() const;
+
+			LoadHandle& operator=(const LoadHandle&) = default;
+			LoadHandle& operator=(LoadHandle&&) noexcept = default;
+
+		private:
+			TaskScheduler::TaskHandle m_task;
+			std::shared_ptr<std::shared_ptr<SoundBuffer>> m_soundBuffer; //< written by the loading task
+	};
 }
 
 #include <Nazara/Audio/SoundBuffer.inl>
@@ -6,6 +6,15 @@
 
 namespace Nz
 {
+	/*!
+	* \brief Gets the encoded file data of a compressed sound buffer
+	* \return Encoded data (empty if the sound buffer is not compressed)
+	*/
+	inline const std::vector<UInt8>& SoundBuffer::GetCompressedData() const
+	{
+		return m_compressedData;
+	}
+
 	/*!
 	* \brief Gets the duration of the sound buffer
 	* \return Duration of the sound buffer in milliseconds
@@ -28,7 +37,7 @@ namespace Nz
 
 	/*!
 	* \brief Gets the internal raw samples
-	* \return Pointer to raw data
+	* \return Pointer to raw data (or nullptr if the sound buffer is compressed)
 	*
 	* \remark Produces a NazaraError if there is no sound buffer with NAZARA_AUDIO_SAFE defined
 	*/
@@ -58,6 +67,26 @@ namespace Nz
 	{
 		return m_sampleRate;
 	}
+
+	/*!
+	* \brief Checks whether the sound buffer keeps its samples compressed
+	* \return true if the samples are decoded on the fly while playing
+	*
+	* \see OpenStream
+	*/
+	inline bool SoundBuffer::IsCompressed() const
+	{
+		return !m_compressedData.empty();
+	}
+
+	/*!
+	* \brief Checks whether the handle refers to a loading
+	* \return true if it was returned by an asynchronous load
+	*/
+	inline bool SoundBuffer::LoadHandle::IsValid() const
+	{
+		return m_task.IsValid();
+	}
 }
 
 #include <Nazara/Audio/DebugOff.hpp>
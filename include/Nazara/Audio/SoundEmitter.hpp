@@ -13,11 +13,12 @@
 #include <Nazara/Core/Time.hpp>
 #include <Nazara/Math/Vector3.hpp>
 #include <limits>
+#include <memory>
 
 namespace Nz
 {
 	class AudioDevice;
-	class AudioSource;
+	class VirtualAudioSource;
 
 	class NAZARA_AUDIO_API SoundEmitter
 	{
@@ -31,11 +32,13 @@ namespace Nz
 			void EnableSpatialization(bool spatialization);
 
 			float GetAttenuation() const;
+			const std::shared_ptr<AudioDevice>& GetAudioDevice() const;
 			virtual Time GetDuration() const = 0;
 			float GetMinDistance() const;
 			float GetPitch() const;
 			virtual Time GetPlayingOffset() const = 0;
 			Vector3f GetPosition() const;
+			float GetPriority() const;
 			virtual UInt64 GetSampleOffset() const = 0;
 			virtual UInt32 GetSampleRate() const = 0;
 			Vector3f GetVelocity() const;
@@ -45,6 +48,7 @@ namespace Nz
 			virtual bool IsLooping() const = 0;
 			inline bool IsPlaying() const;
 			bool IsSpatializationEnabled() const;
+			bool IsVirtual() const;
 
 			virtual void Pause() = 0;
 			virtual void Play() = 0;
@@ -56,6 +60,7 @@ namespace Nz
 			void SetMinDistance(float minDistance);
 			void SetPitch(float pitch);
 			void SetPosition(const Vector3f& position);
+			void SetPriority(float priority);
 			void SetVelocity(const Vector3f& velocity);
 			void SetVolume(float volume);
 
@@ -65,7 +70,7 @@ namespace Nz
 			SoundEmitter& operator=(SoundEmitter&&) noexcept = default;
 
 		protected:
-			std::shared_ptr<AudioSource> m_source;
+			std::shared_ptr<VirtualAudioSource> m_source;
 	};
 }
 
@@ -0,0 +1,86 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_AUDIO_SOUNDPOOL_HPP
+#define NAZARA_AUDIO_SOUNDPOOL_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Audio/Config.hpp>
+#include <Nazara/Core/Time.hpp>
+#include <Nazara/Math/Vector3.hpp>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Nz
+{
+	class AudioDevice;
+	class AudioSource;
+	class SoundBuffer;
+
+	class NAZARA_AUDIO_API SoundPool
+	{
+		public:
+			struct OneShotParams;
+
+			SoundPool(std::shared_ptr<AudioDevice> device, std::size_t voiceCount = DefaultVoiceCount, std::size_t maxInstancesPerBuffer = DefaultMaxInstancesPerBuffer);
+			SoundPool(const SoundPool&) = delete;
+			SoundPool(SoundPool&&) = delete;
+			~SoundPool();
+
+			std::size_t GetActiveVoiceCount() const;
+			const std::shared_ptr<AudioDevice>& GetAudioDevice() const;
+			std::size_t GetMaxInstancesPerBuffer() const;
+			std::size_t GetVoiceCount() const;
+
+			bool PlayOneShot(std::shared_ptr<SoundBuffer> soundBuffer, const Vector3f& position);
+			bool PlayOneShot(std::shared_ptr<SoundBuffer> soundBuffer, const Vector3f& position, const OneShotParams& params);
+
+			void SetMaxInstancesPerBuffer(std::size_t maxInstances);
+
+			void StopAll();
+
+			void Update();
+
+			SoundPool& operator=(const SoundPool&) = delete;
+			SoundPool& operator=(SoundPool&&) = delete;
+
+			static constexpr std::size_t DefaultMaxInstancesPerBuffer = 4;
+			static constexpr std::size_t DefaultVoiceCount = 16;
+			static constexpr Time UpdateInterval = Time::Milliseconds(50);
+
+			struct OneShotParams
+			{
+				std::size_t maxInstances = 0; //< maximum number of instances of this buffer playing at once, overrides the pool limit if not zero
+				float attenuation = 1.f;
+				float minDistance = 1.f;
+				float pitch = 1.f;
+				float priority = 1.f; //< voices playing lower priority sounds are stolen when the pool is full
+				float volume = 1.f;
+				bool spatialized = true;
+			};
+
+		private:
+			struct Voice
+			{
+				std::shared_ptr<AudioSource> source;
+				std::shared_ptr<SoundBuffer> soundBuffer; //< null when the voice is free
+				UInt64 playIndex; //< order in which voices were played, used to steal the oldest ones first
+				float priority;
+			};
+
+			void ReleaseVoice(Voice& voice);
+
+			mutable std::mutex m_mutex; //< voices are recycled from the device streamer
+			std::shared_ptr<AudioDevice> m_device;
+			std::size_t m_maxInstancesPerBuffer;
+			std::size_t m_streamId;
+			std::vector<Voice> m_voices;
+			UInt64 m_nextPlayIndex;
+	};
+}
+
+#endif // NAZARA_AUDIO_SOUNDPOOL_HPP
@@ -0,0 +1,89 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_AUDIO_SOUNDSTREAMPLAYER_HPP
+#define NAZARA_AUDIO_SOUNDSTREAMPLAYER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Audio/Config.hpp>
+#include <Nazara/Audio/Enums.hpp>
+#include <Nazara/Core/SpscRingBuffer.hpp>
+#include <Nazara/Core/Time.hpp>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace Nz
+{
+	class AudioBuffer;
+	class AudioSource;
+	class SoundStream;
+
+	class NAZARA_AUDIO_API SoundStreamPlayer
+	{
+		public:
+			SoundStreamPlayer(std::shared_ptr<AudioSource> source, std::shared_ptr<SoundStream> stream, Time chunkDuration = Time::Second(), std::size_t bufferCount = 2);
+			SoundStreamPlayer(const SoundStreamPlayer&) = delete;
+			SoundStreamPlayer(SoundStreamPlayer&&) = delete;
+			~SoundStreamPlayer();
+
+			void EnableLooping(bool loop);
+
+			Time GetPlayingOffset() const;
+			UInt64 GetSampleOffset() const;
+			SoundStatus GetStatus() const;
+			inline const std::shared_ptr<SoundStream>& GetStream() const;
+
+			bool IsLooping() const;
+
+			void Pause();
+			void Play();
+
+			void SeekToSampleOffset(UInt64 offset);
+
+			void Stop();
+
+			SoundStreamPlayer& operator=(const SoundStreamPlayer&) = delete;
+			SoundStreamPlayer& operator=(SoundStreamPlayer&&) = delete;
+
+		private:
+			static constexpr UInt64 NoSeek = std::numeric_limits<UInt64>::max();
+
+			AudioFormat m_audioFormat;
+			SpscRingBuffer<Int16> m_decodedSamples;
+			std::atomic_bool m_looping;
+			std::atomic_bool m_paused;
+			std::atomic_bool m_streaming;
+			std::atomic<UInt32> m_positionVersion; //< odd while the streamer updates the processed samples and the source queue
+			std::atomic<UInt64> m_processedSamples;
+			std::atomic<UInt64> m_seekOffset; //< pending seek (or start), applied by the streamer
+			std::optional<std::size_t> m_streamId;
+			std::size_t m_bufferCount;
+			std::shared_ptr<AudioSource> m_source;
+			std::shared_ptr<SoundStream> m_stream;
+			std::vector<std::shared_ptr<AudioBuffer>> m_freeBuffers;
+			std::vector<Int16> m_chunkSamples;
+			Time m_prefetchDuration;
+			UInt32 m_sampleRate;
+			UInt64 m_queuedSamples;
+			UInt64 m_streamOffset;
+
+			void DecodeSamples();
+			bool QueueDecodedSamples();
+			template<typename T> T ReadSourceOffset(T(AudioSource::*offsetGetter)() const, UInt64& processedSamples) const;
+			void ReleaseQueuedBuffers();
+			void RestartSource();
+			void StartStreaming();
+			void StopStreaming();
+			std::optional<Time> UpdateStream();
+	};
+}
+
+#include <Nazara/Audio/SoundStreamPlayer.inl>
+
+#endif // NAZARA_AUDIO_SOUNDSTREAMPLAYER_HPP
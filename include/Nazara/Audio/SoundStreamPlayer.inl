@@ -0,0 +1,19 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Audio/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Gets the sound stream played
+	* \return Sound stream
+	*/
+	inline const std::shared_ptr<SoundStream>& SoundStreamPlayer::GetStream() const
+	{
+		return m_stream;
+	}
+}
+
+#include <Nazara/Audio/DebugOff.hpp>
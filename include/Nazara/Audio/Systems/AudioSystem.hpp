@@ -0,0 +1,70 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_AUDIO_SYSTEMS_AUDIOSYSTEM_HPP
+#define NAZARA_AUDIO_SYSTEMS_AUDIOSYSTEM_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Audio/Config.hpp>
+#include <Nazara/Audio/Components/SoundEmitterComponent.hpp>
+#include <Nazara/Core/Time.hpp>
+#include <Nazara/Utility/Node.hpp>
+#include <NazaraUtils/Bitset.hpp>
+#include <NazaraUtils/TypeList.hpp>
+#include <entt/entt.hpp>
+#include <vector>
+
+namespace Nz
+{
+	class AudioDevice;
+
+	class NAZARA_AUDIO_API AudioSystem
+	{
+		public:
+			static constexpr Int64 ExecutionOrder = 1000; //< after transforms are resolved
+			using Components = TypeList<SoundEmitterComponent>;
+			using ReadOnlyComponents = TypeList<class NodeComponent, class VelocityComponent>;
+
+			AudioSystem(entt::registry& registry);
+			AudioSystem(const AudioSystem&) = delete;
+			AudioSystem(AudioSystem&&) = delete;
+			~AudioSystem();
+
+			void Update(Time elapsedTime);
+
+			AudioSystem& operator=(const AudioSystem&) = delete;
+			AudioSystem& operator=(AudioSystem&&) = delete;
+
+		private:
+			void DeferDeviceUpdates(AudioDevice& device);
+			void OnEmitterDestroy(entt::registry& registry, entt::entity entity);
+			void OnNodeDestroy(entt::registry& registry, entt::entity entity);
+			void ReleaseEntry(entt::entity entity);
+			void UpdateObservers();
+
+			struct EmitterEntry
+			{
+				entt::entity entity = entt::null;
+
+				NazaraSlot(Node, OnNodeInvalidation, onNodeInvalidation);
+				NazaraSlot(SoundEmitterComponent, OnEmitterAttached, onEmitterAttached);
+			};
+
+			entt::registry& m_registry;
+			entt::observer m_emitterConstructObserver;
+			entt::scoped_connection m_emitterDestroyConnection;
+			entt::scoped_connection m_nodeDestroyConnection;
+			std::vector<AudioDevice*> m_deferredDevices;
+			std::vector<EmitterEntry> m_emitterEntries; //< indexed by entity index
+			std::vector<std::size_t> m_stoppedEmitters;
+			Bitset<UInt64> m_invalidatedEmitters; //< indexed by entity index
+			Bitset<UInt64> m_movingEmitters; //< emitters which were given a non-zero velocity, indexed by entity index
+	};
+}
+
+#include <Nazara/Audio/Systems/AudioSystem.inl>
+
+#endif // NAZARA_AUDIO_SYSTEMS_AUDIOSYSTEM_HPP
@@ -0,0 +1,124 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_AUDIO_VIRTUALAUDIOSOURCE_HPP
+#define NAZARA_AUDIO_VIRTUALAUDIOSOURCE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Audio/AudioSource.hpp>
+#include <Nazara/Audio/Config.hpp>
+#include <Nazara/Core/Clock.hpp>
+#include <mutex>
+#include <vector>
+
+namespace Nz
+{
+	class AudioVoiceManager;
+
+	class NAZARA_AUDIO_API VirtualAudioSource final : public AudioSource
+	{
+		friend AudioVoiceManager;
+
+		public:
+			VirtualAudioSource(std::shared_ptr<AudioDevice> device, AudioVoiceManager& voiceManager);
+			VirtualAudioSource(const VirtualAudioSource&) = delete;
+			VirtualAudioSource(VirtualAudioSource&&) = delete;
+			~VirtualAudioSource();
+
+			void EnableLooping(bool loop) override;
+			void EnableSpatialization(bool spatialization) override;
+
+			float GetAttenuation() const override;
+			float GetMinDistance() const override;
+			float GetPitch() const override;
+			Time GetPlayingOffset() const override;
+			Vector3f GetPosition() const override;
+			float GetPriority() const;
+			UInt32 GetSampleOffset() const override;
+			OffsetWithLatency GetSampleOffsetAndLatency() const override;
+			Vector3f GetVelocity() const override;
+			SoundStatus GetStatus() const override;
+			float GetVolume() const override;
+
+			bool IsLooping() const override;
+			bool IsSpatializationEnabled() const override;
+			bool IsVirtual() const;
+
+			void QueueBuffer(std::shared_ptr<AudioBuffer> audioBuffer) override;
+
+			void Pause() override;
+			void Play() override;
+
+			void SetAttenuation(float attenuation) override;
+			void SetBuffer(std::shared_ptr<AudioBuffer> audioBuffer) override;
+			void SetMinDistance(float minDistance) override;
+			void SetPitch(float pitch) override;
+			void SetPlayingOffset(Time offset) override;
+			void SetPosition(const Vector3f& position) override;
+			void SetPriority(float priority);
+			void SetSampleOffset(UInt32 offset) override;
+			void SetVelocity(const Vector3f& velocity) override;
+			void SetVolume(float volume) override;
+
+			void Stop() override;
+
+			std::shared_ptr<AudioBuffer> TryUnqueueProcessedBuffer() override;
+
+			void UnqueueAllBuffers() override;
+
+			VirtualAudioSource& operator=(const VirtualAudioSource&) = delete;
+			VirtualAudioSource& operator=(VirtualAudioSource&&) = delete;
+
+		private:
+			struct QueuedBuffer
+			{
+				std::shared_ptr<AudioBuffer> buffer;
+				Time duration;
+				UInt64 frameCount;
+			};
+
+			struct VoiceState
+			{
+				SoundStatus status;
+				float audibility;
+				float score; //< audibility multiplied by priority
+				bool isVirtual;
+			};
+
+			mutable std::vector<QueuedBuffer> m_queuedBuffers;
+			mutable MillisecondClock m_playClock;
+			mutable SoundStatus m_virtualStatus;
+			mutable Time m_virtualOffset; //< offset from the first queued buffer when the play clock was restarted
+			mutable std::recursive_mutex m_mutex; //< getters update the virtual playing state, and sources are accessed from the AudioStreamer
+			mutable std::size_t m_processedBufferCount;
+			std::shared_ptr<AudioSource> m_voice;
+			std::size_t m_detachedBufferCount; //< leading buffers processed while virtual, which were not queued on the voice
+			AudioVoiceManager& m_voiceManager;
+			Vector3f m_position;
+			Vector3f m_velocity;
+			bool m_isLooping;
+			bool m_isSpatialized;
+			bool m_isStaticBuffer;
+			float m_attenuation;
+			float m_minDistance;
+			float m_pitch;
+			float m_priority;
+			float m_volume;
+
+			float ComputeAudibility(const Vector3f& listenerPosition) const;
+			std::size_t CountProcessedBuffers(Time offset) const;
+			bool Devirtualize();
+			Time GetDetachedDuration() const;
+			UInt64 GetDetachedFrameCount() const;
+			Time GetVirtualOffset() const;
+			VoiceState QueryVoiceState(const Vector3f& listenerPosition) const;
+			void RestartVirtualClock(Time offset) const;
+			void UpdateVirtualState() const;
+			void Virtualize();
+	};
+}
+
+#endif // NAZARA_AUDIO_VIRTUALAUDIOSOURCE_HPP
@@ -29,8 +29,10 @@ namespace Nz
 
 		public:
 			struct RaycastHit;
+			struct Settings;
 
 			BulletPhysWorld3D();
+			explicit BulletPhysWorld3D(const Settings& settings);
 			BulletPhysWorld3D(const BulletPhysWorld3D&) = delete;
 			BulletPhysWorld3D(BulletPhysWorld3D&& ph) = delete;
 			~BulletPhysWorld3D();
@@ -40,6 +42,8 @@ namespace Nz
 			std::size_t GetMaxStepCount() const;
 			Time GetStepSize() const;
 
+			bool IsMultithreaded() const;
+
 			bool RaycastQuery(const Vector3f& from, const Vector3f& to, const FunctionRef<std::optional<float>(const RaycastHit& hitInfo)>& callback);
 			bool RaycastQueryFirst(const Vector3f& from, const Vector3f& to, RaycastHit* hitInfo = nullptr);
 
@@ -60,6 +64,12 @@ namespace Nz
 				Vector3f hitNormal;
 			};
 
+			struct Settings
+			{
+				// Uses btDiscreteDynamicsWorldMt, running collision dispatch, island solving and integration on the Core task scheduler
+				bool multithreaded = false;
+			};
+
 		private:
 			btRigidBody* AddRigidBody(std::size_t& rigidBodyIndex, FunctionRef<void(btRigidBody* body)> constructor);
 			void RemoveRigidBody(btRigidBody* rigidBody, std::size_t rigidBodyIndex);
@@ -21,12 +21,14 @@ namespace Nz
 	class NAZARA_BULLETPHYSICS3D_API BulletPhysics3DSystem
 	{
 		public:
+			static constexpr bool FixedUpdate = true;
 			static constexpr Int64 ExecutionOrder = 0;
 			using Components = TypeList<BulletRigidBody3DComponent, class NodeComponent>;
 
 			struct RaycastHit;
 
 			BulletPhysics3DSystem(entt::registry& registry);
+			BulletPhysics3DSystem(entt::registry& registry, const BulletPhysWorld3D::Settings& settings);
 			BulletPhysics3DSystem(const BulletPhysics3DSystem&) = delete;
 			BulletPhysics3DSystem(BulletPhysics3DSystem&&) = delete;
 			~BulletPhysics3DSystem();
@@ -17,12 +17,17 @@
 #include <NazaraUtils/Bitset.hpp>
 #include <NazaraUtils/FunctionRef.hpp>
 #include <NazaraUtils/Signal.hpp>
+#include <array>
+#include <cstddef>
 #include <functional>
+#include <limits>
 #include <memory>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
 struct cpCollisionHandler;
+struct cpShape;
 struct cpSpace;
 
 namespace Nz
@@ -50,8 +55,11 @@ namespace Nz
 			struct DebugDrawOptions;
 			struct NearestQueryResult;
 			struct RaycastHit;
+			struct Settings;
+			struct StateSnapshot;
 
 			ChipmunkPhysWorld2D();
+			explicit ChipmunkPhysWorld2D(const Settings& settings);
 			ChipmunkPhysWorld2D(const ChipmunkPhysWorld2D&) = delete;
 			ChipmunkPhysWorld2D(ChipmunkPhysWorld2D&&) = delete;
 			~ChipmunkPhysWorld2D();
@@ -63,8 +71,11 @@ namespace Nz
 			cpSpace* GetHandle() const;
 			std::size_t GetIterationCount() const;
 			std::size_t GetMaxStepCount() const;
+			std::size_t GetSolverThreadCount() const;
 			Time GetStepSize() const;
 
+			inline bool IsSolverMultithreaded() const;
+
 			bool NearestBodyQuery(const Vector2f& from, float maxDistance, UInt32 collisionGroup, UInt32 categoryMask, UInt32 collisionMask, ChipmunkRigidBody2D** nearestBody = nullptr);
 			bool NearestBodyQuery(const Vector2f& from, float maxDistance, UInt32 collisionGroup, UInt32 categoryMask, UInt32 collisionMask, NearestQueryResult* result);
 
@@ -78,15 +89,21 @@ namespace Nz
 			void RegisterCallbacks(unsigned int collisionId, ContactCallbacks callbacks);
 			void RegisterCallbacks(unsigned int collisionIdA, unsigned int collisionIdB, ContactCallbacks callbacks);
 
+			bool RestoreState(const StateSnapshot& snapshot);
+
+			void SaveState(StateSnapshot& snapshot, bool activeBodiesOnly = false) const;
+
 			void SetDamping(float dampingValue);
 			void SetGravity(const Vector2f& gravity);
 			void SetIterationCount(std::size_t iterationCount);
 			void SetMaxStepCount(std::size_t maxStepCount);
 			void SetSleepTime(Time sleepTime);
+			void SetSolverThreadCount(std::size_t threadCount);
 			void SetStepSize(Time stepSize);
 
 			void Step(Time timestep);
 
+			float UseAutoTunedSpatialHash();
 			void UseSpatialHash(float cellSize, std::size_t entityCount);
 
 			ChipmunkPhysWorld2D& operator=(const ChipmunkPhysWorld2D&) = delete;
@@ -133,28 +150,85 @@ namespace Nz
 				float fraction;
 			};
 
+			struct Settings
+			{
+				// More than one thread (or zero to use one thread per CPU core) creates a space with a multithreaded solver (cpHastySpace)
+				std::size_t solverThreadCount = 1;
+			};
+
+			struct StateSnapshot
+			{
+				struct ArbiterState
+				{
+					struct Contact
+					{
+						UInt64 hash;
+						double normalImpulse;
+						double tangentImpulse;
+					};
+
+					std::array<Contact, 2> contacts;
+					const cpShape* shapeA;
+					const cpShape* shapeB;
+					UInt32 contactCount;
+				};
+
+				struct BodyState
+				{
+					Vector2d force;
+					Vector2d linearVelocity;
+					Vector2d position;
+					double angle;
+					double angularVelocity;
+					double torque;
+					UInt32 bodyIndex;
+					bool isSleeping;
+				};
+
+				std::vector<ArbiterState> arbiters; //< accumulated contact impulses, used to warm start the solver
+				std::vector<BodyState> bodies;
+				Time timestepAccumulator = Time::Zero();
+				bool isDelta = false; //< only awake bodies were captured
+			};
+
 			NazaraSignal(OnPhysWorld2DPreStep, const ChipmunkPhysWorld2D* /*physWorld*/, float /*invStepCount*/);
 			NazaraSignal(OnPhysWorld2DPostStep, const ChipmunkPhysWorld2D* /*physWorld*/, float /*invStepCount*/);
 
 		private:
-			using PostStep = std::function<void(ChipmunkRigidBody2D* body)>;
+			// Actions deferred while the space is locked, their callable lives in the post-step arena
+			struct PostStepCommand
+			{
+				void (*execute)(void* callable, ChipmunkRigidBody2D* body);
+				void (*destroy)(void* callable); //< null for trivially destructible callables
+				void* callable;
+				UInt32 bodyIndex;
+			};
 
 			static constexpr std::size_t FreeBodyIdGrowRate = 256;
+			static constexpr std::size_t PostStepArenaBlockSize = 4096;
+			static constexpr UInt32 InvalidBodyIndex = std::numeric_limits<UInt32>::max();
 
-			void DeferBodyAction(ChipmunkRigidBody2D& rigidBody, PostStep&& func);
+			void* AllocatePostStepStorage(std::size_t size, std::size_t alignment);
+			template<typename F> void DeferBodyAction(ChipmunkRigidBody2D& rigidBody, F&& func);
+			void ExecutePostSteps();
 			void InitCallbacks(cpCollisionHandler* handler, ContactCallbacks callbacks);
+			bool IsSpaceLocked() const;
 			inline UInt32 RegisterBody(ChipmunkRigidBody2D& rigidBody);
 			inline void UnregisterBody(UInt32 bodyIndex);
 			inline void UpdateBodyPointer(ChipmunkRigidBody2D& rigidBody);
 
 			std::size_t m_maxStepCount;
 			std::unordered_map<cpCollisionHandler*, std::unique_ptr<ContactCallbacks>> m_callbacks;
-			std::unordered_map<UInt32, std::vector<PostStep>> m_rigidBodyPostSteps;
+			std::size_t m_postStepArenaBlock;
+			std::size_t m_postStepArenaOffset;
 			std::vector<ChipmunkRigidBody2D*> m_bodies;
+			std::vector<PostStepCommand> m_postStepCommands;
+			std::vector<std::unique_ptr<UInt8[]>> m_postStepArena;
 			cpSpace* m_handle;
 			Bitset<UInt64> m_freeBodyIndices;
 			Time m_stepSize;
 			Time m_timestepAccumulator;
+			bool m_isSolverMultithreaded;
 	};
 }
 
@@ -3,10 +3,50 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <cassert>
+#include <new>
 #include <Nazara/ChipmunkPhysics2D/Debug.hpp>
 
 namespace Nz
 {
+	template<typename F>
+	void ChipmunkPhysWorld2D::DeferBodyAction(ChipmunkRigidBody2D& rigidBody, F&& func)
+	{
+		// If space isn't locked, no need to wait
+		if (!IsSpaceLocked())
+		{
+			func(&rigidBody);
+			return;
+		}
+
+		using Callable = std::decay_t<F>;
+
+		PostStepCommand command;
+		command.bodyIndex = rigidBody.GetBodyIndex();
+		command.execute = [](void* callable, ChipmunkRigidBody2D* body) { (*static_cast<Callable*>(callable))(body); };
+
+		if constexpr (sizeof(Callable) <= PostStepArenaBlockSize && alignof(Callable) <= alignof(std::max_align_t))
+		{
+			command.callable = new (AllocatePostStepStorage(sizeof(Callable), alignof(Callable))) Callable(std::forward<F>(func));
+
+			if constexpr (std::is_trivially_destructible_v<Callable>)
+				command.destroy = nullptr;
+			else
+				command.destroy = [](void* callable) { static_cast<Callable*>(callable)->~Callable(); };
+		}
+		else
+		{
+			command.callable = new Callable(std::forward<F>(func));
+			command.destroy = [](void* callable) { delete static_cast<Callable*>(callable); };
+		}
+
+		m_postStepCommands.push_back(command);
+	}
+
+	inline bool ChipmunkPhysWorld2D::IsSolverMultithreaded() const
+	{
+		return m_isSolverMultithreaded;
+	}
+
 	inline UInt32 ChipmunkPhysWorld2D::RegisterBody(ChipmunkRigidBody2D& rigidBody)
 	{
 		std::size_t bodyIndex = m_freeBodyIndices.FindFirst();
@@ -33,7 +73,12 @@ namespace Nz
 		assert(m_bodies[bodyIndex]);
 		m_bodies[bodyIndex] = nullptr;
 
-		m_rigidBodyPostSteps.erase(bodyIndex);
+		// Cancel pending actions of this body
+		for (PostStepCommand& command : m_postStepCommands)
+		{
+			if (command.bodyIndex == bodyIndex)
+				command.bodyIndex = InvalidBodyIndex;
+		}
 	}
 
 	inline void ChipmunkPhysWorld2D::UpdateBodyPointer(ChipmunkRigidBody2D& rigidBody)
@@ -24,6 +24,7 @@ namespace Nz
 		using ContactStartCallback = std::function<bool(ChipmunkPhysWorld2D& world, ChipmunkArbiter2D& arbiter, entt::handle entityA, entt::handle entityB, void* userdata)>;
 
 		public:
+			static constexpr bool FixedUpdate = true;
 			static constexpr Int64 ExecutionOrder = 0;
 			using Components = TypeList<ChipmunkRigidBody2DComponent, class NodeComponent>;
 
@@ -32,6 +33,7 @@ namespace Nz
 			struct RaycastHit;
 
 			ChipmunkPhysics2DSystem(entt::registry& registry);
+			ChipmunkPhysics2DSystem(entt::registry& registry, const ChipmunkPhysWorld2D::Settings& settings);
 			ChipmunkPhysics2DSystem(const ChipmunkPhysics2DSystem&) = delete;
 			ChipmunkPhysics2DSystem(ChipmunkPhysics2DSystem&&) = delete;
 			~ChipmunkPhysics2DSystem();
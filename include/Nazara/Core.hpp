@@ -38,6 +38,9 @@
 #include <Nazara/Core/ApplicationComponent.hpp>
 #include <Nazara/Core/ApplicationComponentRegistry.hpp>
 #include <Nazara/Core/ApplicationUpdater.hpp>
+#include <Nazara/Core/AsyncFileReader.hpp>
+#include <Nazara/Core/AsyncLogger.hpp>
+#include <Nazara/Core/BitSerialization.hpp>
 #include <Nazara/Core/ByteArray.hpp>
 #include <Nazara/Core/ByteArrayPool.hpp>
 #include <Nazara/Core/ByteStream.hpp>
@@ -60,15 +63,21 @@
 #include <Nazara/Core/HandledObject.hpp>
 #include <Nazara/Core/HardwareInfo.hpp>
 #include <Nazara/Core/Initializer.hpp>
+#include <Nazara/Core/LinearAllocator.hpp>
 #include <Nazara/Core/Log.hpp>
+#include <Nazara/Core/MappedFile.hpp>
+#include <Nazara/Core/MaxRectsBinPack.hpp>
 #include <Nazara/Core/MemoryStream.hpp>
+#include <Nazara/Core/MemoryTracker.hpp>
 #include <Nazara/Core/MemoryView.hpp>
 #include <Nazara/Core/ModuleBase.hpp>
 #include <Nazara/Core/Modules.hpp>
+#include <Nazara/Core/MpscQueue.hpp>
 #include <Nazara/Core/ObjectHandle.hpp>
 #include <Nazara/Core/ObjectLibrary.hpp>
 #include <Nazara/Core/ObjectRef.hpp>
 #include <Nazara/Core/OwnedMemoryStream.hpp>
+#include <Nazara/Core/PackedArchive.hpp>
 #include <Nazara/Core/ParameterList.hpp>
 #include <Nazara/Core/Plugin.hpp>
 #include <Nazara/Core/PluginInterface.hpp>
@@ -76,6 +85,7 @@
 #include <Nazara/Core/PoolByteStream.hpp>
 #include <Nazara/Core/Primitive.hpp>
 #include <Nazara/Core/PrimitiveList.hpp>
+#include <Nazara/Core/Profiler.hpp>
 #include <Nazara/Core/RefCounted.hpp>
 #include <Nazara/Core/Resource.hpp>
 #include <Nazara/Core/ResourceLoader.hpp>
@@ -84,6 +94,8 @@
 #include <Nazara/Core/ResourceSaver.hpp>
 #include <Nazara/Core/SerializationContext.hpp>
 #include <Nazara/Core/SignalHandlerAppComponent.hpp>
+#include <Nazara/Core/SkylineBinPack.hpp>
+#include <Nazara/Core/SpscRingBuffer.hpp>
 #include <Nazara/Core/State.hpp>
 #include <Nazara/Core/StateMachine.hpp>
 #include <Nazara/Core/StdLogger.hpp>
@@ -92,16 +104,19 @@
 #include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Core/ThreadExt.hpp>
 #include <Nazara/Core/Time.hpp>
+#include <Nazara/Core/TimerWheel.hpp>
 #include <Nazara/Core/Unicode.hpp>
 #include <Nazara/Core/Updatable.hpp>
 #include <Nazara/Core/Uuid.hpp>
 #include <Nazara/Core/VirtualDirectory.hpp>
+#include <Nazara/Core/VirtualDirectoryArchiveResolver.hpp>
 #include <Nazara/Core/VirtualDirectoryFilesystemResolver.hpp>
 
 #ifdef NAZARA_ENTT
 
 #include <Nazara/Core/AppEntitySystemComponent.hpp>
 #include <Nazara/Core/Components.hpp>
+#include <Nazara/Core/EnttSnapshot.hpp>
 #include <Nazara/Core/EnttSystemGraph.hpp>
 #include <Nazara/Core/EnttWorld.hpp>
 #include <Nazara/Core/Systems.hpp>
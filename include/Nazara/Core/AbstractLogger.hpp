@@ -22,6 +22,8 @@ namespace Nz
 			AbstractLogger(AbstractLogger&&) noexcept = default;
 			virtual ~AbstractLogger();
 
+			virtual bool DispatchesLogSignals() const;
+
 			virtual void EnableStdReplication(bool enable) = 0;
 
 			virtual bool IsStdReplicationEnabled() const = 0;
@@ -11,19 +11,26 @@
 #include <Nazara/Core/ApplicationComponent.hpp>
 #include <Nazara/Core/Config.hpp>
 #include <Nazara/Core/EntityWorld.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <memory>
+#include <vector>
 
 namespace Nz
 {
 	class NAZARA_CORE_API AppEntitySystemComponent : public ApplicationComponent
 	{
 		public:
-			using ApplicationComponent::ApplicationComponent;
+			inline AppEntitySystemComponent(ApplicationBase& app);
 			AppEntitySystemComponent(const AppEntitySystemComponent&) = delete;
 			AppEntitySystemComponent(AppEntitySystemComponent&&) = delete;
 			~AppEntitySystemComponent() = default;
 
 			template<typename T, typename... Args> T& AddWorld(Args&&... args);
 
+			inline void EnableParallelUpdate(bool enable);
+
+			inline bool IsParallelUpdateEnabled() const;
+
 			void Update(Time elapsedTime) override;
 
 			AppEntitySystemComponent& operator=(const AppEntitySystemComponent&) = delete;
@@ -31,6 +38,8 @@ namespace Nz
 
 		private:
 			std::vector<std::unique_ptr<EntityWorld>> m_worlds;
+			std::vector<TaskScheduler::TaskHandle> m_worldTasks;
+			bool m_parallelUpdateEnabled;
 	};
 }
 
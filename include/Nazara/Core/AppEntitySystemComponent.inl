@@ -6,11 +6,36 @@
 
 namespace Nz
 {
+	inline AppEntitySystemComponent::AppEntitySystemComponent(ApplicationBase& app) :
+	ApplicationComponent(app),
+	m_parallelUpdateEnabled(false)
+	{
+	}
+
 	template<typename T, typename... Args>
 	T& AppEntitySystemComponent::AddWorld(Args&&... args)
 	{
 		return static_cast<T&>(*m_worlds.emplace_back(std::make_unique<T>(std::forward<Args>(args)...)));
 	}
+
+	/*!
+	* \brief Enables or disables updating worlds in parallel on the engine task scheduler
+	*
+	* Worlds must be independent from each other (no shared state between their systems) for this to be safe.
+	* Each world always prefers the same worker (based on the order they were added in) to keep its data in cache,
+	* worlds flagged as main thread only (see EntityWorld::IsMainThreadOnly) are updated on the calling thread.
+	*
+	* Parallel update is disabled by default.
+	*/
+	inline void AppEntitySystemComponent::EnableParallelUpdate(bool enable)
+	{
+		m_parallelUpdateEnabled = enable;
+	}
+
+	inline bool AppEntitySystemComponent::IsParallelUpdateEnabled() const
+	{
+		return m_parallelUpdateEnabled;
+	}
 }
 
 #include <Nazara/Core/DebugOff.hpp>
@@ -12,8 +12,11 @@
 #include <Nazara/Core/ApplicationUpdater.hpp>
 #include <Nazara/Core/Clock.hpp>
 #include <Nazara/Core/CommandLineParameters.hpp>
+#include <Nazara/Core/TimingStats.hpp>
+#include <NazaraUtils/Signal.hpp>
 #include <atomic>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace Nz
@@ -31,21 +34,39 @@ namespace Nz
 			ApplicationBase(ApplicationBase&&) = delete;
 			~ApplicationBase();
 
-			inline void AddUpdater(std::unique_ptr<ApplicationUpdater>&& functor);
-			template<typename F> void AddUpdaterFunc(F&& functor);
-			template<typename F> void AddUpdaterFunc(FixedInterval fixedInterval, F&& functor);
-			template<typename F> void AddUpdaterFunc(Interval interval, F&& functor);
+			inline std::size_t AddUpdater(std::unique_ptr<ApplicationUpdater>&& functor);
+			template<typename F> std::size_t AddUpdaterFunc(F&& functor);
+			template<typename F> std::size_t AddUpdaterFunc(FixedInterval fixedInterval, F&& functor);
+			template<typename F> std::size_t AddUpdaterFunc(Interval interval, F&& functor);
 
 			inline void ClearComponents();
 
+			inline void EnableTimingStats(bool enable);
+
+			template<typename F> void ForEachTimingStats(F&& callback) const;
+
 			inline const CommandLineParameters& GetCommandLineParameters() const;
 			template<typename T> T& GetComponent();
 			template<typename T> const T& GetComponent() const;
+			template<typename T> TimingStats& GetComponentTimingStats();
+			template<typename T> const TimingStats& GetComponentTimingStats() const;
+			inline TimingStats& GetUpdaterTimingStats(std::size_t updaterIndex);
+			inline const TimingStats& GetUpdaterTimingStats(std::size_t updaterIndex) const;
+			inline unsigned int GetUpdateRateLimit() const;
+
+			inline bool IsTimingStatsEnabled() const;
+
+			void LogTimingStats() const;
 
 			inline void Quit();
 
+			void ResetTimingStats();
+
 			int Run();
 
+			inline void SetUpdaterName(std::size_t updaterIndex, std::string name);
+			inline void SetUpdateRateLimit(unsigned int updatePerSecond);
+
 			bool Update(Time elapsedTime);
 
 			ApplicationBase& operator=(const ApplicationBase&) = delete;
@@ -53,25 +74,40 @@ namespace Nz
 
 			static inline ApplicationBase* Instance();
 
+			NazaraSignal(OnTimingBudgetExceeded, ApplicationBase* /*app*/, std::string_view /*name*/, const TimingStats& /*stats*/);
+
 		protected:
 			template<typename T, typename... Args> T& AddComponent(Args&&... args);
 
 		private:
-			template<typename F, bool Fixed> void AddUpdaterFunc(Time interval, F&& functor);
+			template<typename F, bool Fixed> std::size_t AddUpdaterFunc(Time interval, F&& functor);
+			void AddTimingSample(std::string_view name, TimingStats& stats, Time duration);
+			void WaitForNextUpdate();
+
+			struct ComponentTiming
+			{
+				std::string_view name;
+				TimingStats stats;
+			};
 
 			struct Updater
 			{
+				std::string name;
 				std::unique_ptr<ApplicationUpdater> updater;
+				TimingStats timingStats;
 				Time lastUpdate;
 				Time nextUpdate;
 			};
 
 			std::atomic_bool m_running;
 			std::vector<std::unique_ptr<ApplicationComponent>> m_components;
+			std::vector<ComponentTiming> m_componentTimings; //< indexed like m_components
 			std::vector<Updater> m_updaters;
 			CommandLineParameters m_commandLineParams;
 			HighPrecisionClock m_clock;
 			Time m_currentTime;
+			unsigned int m_updateRateLimit;
+			bool m_timingStatsEnabled;
 
 			static ApplicationBase* s_instance;
 	};
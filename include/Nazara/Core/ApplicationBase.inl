@@ -3,6 +3,9 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Core/ApplicationComponentRegistry.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/Format.hpp>
+#include <NazaraUtils/TypeName.hpp>
 #include <stdexcept>
 #include <Nazara/Core/Debug.hpp>
 
@@ -18,29 +21,38 @@ namespace Nz
 	{
 	}
 
-	inline void ApplicationBase::AddUpdater(std::unique_ptr<ApplicationUpdater>&& functor)
+	/*!
+	* \brief Adds an updater, run on each update of the application
+	* \return Index of the updater, to access its timing statistics
+	*/
+	inline std::size_t ApplicationBase::AddUpdater(std::unique_ptr<ApplicationUpdater>&& functor)
 	{
+		std::size_t updaterIndex = m_updaters.size();
+
 		auto& updaterEntry = m_updaters.emplace_back();
 		updaterEntry.lastUpdate = -Time::Nanosecond();
+		updaterEntry.name = Format("Updater #{0}", updaterIndex);
 		updaterEntry.nextUpdate = Time::Zero();
 		updaterEntry.updater = std::move(functor);
+
+		return updaterIndex;
 	}
 
 	template<typename F>
-	void ApplicationBase::AddUpdaterFunc(F&& functor)
+	std::size_t ApplicationBase::AddUpdaterFunc(F&& functor)
 	{
 		static_assert(std::is_invocable_v<F> || std::is_invocable_v<F, Time>, "functor must be callable with either a Time parameter or no parameter");
 		return AddUpdater(std::make_unique<ApplicationUpdaterFunctor<std::decay_t<F>>>(std::forward<F>(functor)));
 	}
 
 	template<typename F>
-	void ApplicationBase::AddUpdaterFunc(FixedInterval fixedInterval, F&& functor)
+	std::size_t ApplicationBase::AddUpdaterFunc(FixedInterval fixedInterval, F&& functor)
 	{
 		return AddUpdaterFunc<F, true>(fixedInterval.interval, std::forward<F>(functor));
 	}
 
 	template<typename F>
-	void ApplicationBase::AddUpdaterFunc(Interval interval, F&& functor)
+	std::size_t ApplicationBase::AddUpdaterFunc(Interval interval, F&& functor)
 	{
 		return AddUpdaterFunc<F, false>(interval.interval, std::forward<F>(functor));
 	}
@@ -48,6 +60,35 @@ namespace Nz
 	inline void ApplicationBase::ClearComponents()
 	{
 		m_components.clear();
+		m_componentTimings.clear();
+	}
+
+	/*!
+	* \brief Enables or disables measuring the duration of updaters and components
+	*
+	* Timing statistics are enabled by default, they only cost two clock reads per updater and component update.
+	*/
+	inline void ApplicationBase::EnableTimingStats(bool enable)
+	{
+		m_timingStatsEnabled = enable;
+	}
+
+	/*!
+	* \brief Calls a callback with the timing statistics of every updater and component
+	*
+	* \param callback Callback taking the name of the updater or component (as a std::string_view) and its statistics (as a const TimingStats&)
+	*/
+	template<typename F>
+	void ApplicationBase::ForEachTimingStats(F&& callback) const
+	{
+		for (const Updater& updaterEntry : m_updaters)
+			callback(std::string_view(updaterEntry.name), updaterEntry.timingStats);
+
+		for (std::size_t componentIndex = 0; componentIndex < m_components.size(); ++componentIndex)
+		{
+			if (m_components[componentIndex])
+				callback(m_componentTimings[componentIndex].name, m_componentTimings[componentIndex].stats);
+		}
 	}
 
 	inline const CommandLineParameters& ApplicationBase::GetCommandLineParameters() const
@@ -75,11 +116,87 @@ namespace Nz
 		return static_cast<const T&>(*m_components[componentIndex]);
 	}
 
+	/*!
+	* \brief Returns the timing statistics of a component update
+	*
+	* The non-const overload allows to set a budget (see TimingStats::SetBudget), triggering OnTimingBudgetExceeded when an update exceeds it.
+	*/
+	template<typename T>
+	TimingStats& ApplicationBase::GetComponentTimingStats()
+	{
+		std::size_t componentIndex = ApplicationComponentRegistry<T>::GetComponentId();
+		if (componentIndex >= m_components.size() || !m_components[componentIndex])
+			throw std::runtime_error("component not found");
+
+		return m_componentTimings[componentIndex].stats;
+	}
+
+	template<typename T>
+	const TimingStats& ApplicationBase::GetComponentTimingStats() const
+	{
+		std::size_t componentIndex = ApplicationComponentRegistry<T>::GetComponentId();
+		if (componentIndex >= m_components.size() || !m_components[componentIndex])
+			throw std::runtime_error("component not found");
+
+		return m_componentTimings[componentIndex].stats;
+	}
+
+	/*!
+	* \brief Returns the timing statistics of an updater
+	*
+	* \param updaterIndex Index of the updater, as returned by AddUpdater
+	*/
+	inline TimingStats& ApplicationBase::GetUpdaterTimingStats(std::size_t updaterIndex)
+	{
+		NazaraAssert(updaterIndex < m_updaters.size(), "updater index out of range");
+		return m_updaters[updaterIndex].timingStats;
+	}
+
+	inline const TimingStats& ApplicationBase::GetUpdaterTimingStats(std::size_t updaterIndex) const
+	{
+		NazaraAssert(updaterIndex < m_updaters.size(), "updater index out of range");
+		return m_updaters[updaterIndex].timingStats;
+	}
+
+	inline unsigned int ApplicationBase::GetUpdateRateLimit() const
+	{
+		return m_updateRateLimit;
+	}
+
+	inline bool ApplicationBase::IsTimingStatsEnabled() const
+	{
+		return m_timingStatsEnabled;
+	}
+
 	inline void ApplicationBase::Quit()
 	{
 		m_running = false;
 	}
 
+	/*!
+	* \brief Names an updater in timing statistics (updaters are named "Updater #index" by default)
+	*
+	* \param updaterIndex Index of the updater, as returned by AddUpdater
+	* \param name Name of the updater
+	*/
+	inline void ApplicationBase::SetUpdaterName(std::size_t updaterIndex, std::string name)
+	{
+		NazaraAssert(updaterIndex < m_updaters.size(), "updater index out of range");
+		m_updaters[updaterIndex].name = std::move(name);
+	}
+
+	/*!
+	* \brief Limits how many times per second Run updates the application
+	*
+	* Run sleeps between updates to respect the limit, which caps the frame rate of applications rendering in their components.
+	*
+	* \param updatePerSecond Maximum update count per second, zero (the default) to disable the limit
+	*/
+	inline void ApplicationBase::SetUpdateRateLimit(unsigned int updatePerSecond)
+	{
+		m_updateRateLimit = updatePerSecond;
+	}
+
 	inline ApplicationBase* ApplicationBase::Instance()
 	{
 		return s_instance;
@@ -94,17 +211,24 @@ namespace Nz
 		T& componentRef = *component;
 
 		if (componentIndex >= m_components.size())
+		{
 			m_components.resize(componentIndex + 1);
+			m_componentTimings.resize(componentIndex + 1);
+		}
 		else if (m_components[componentIndex] != nullptr)
 			throw std::runtime_error("component was added multiple times");
 
 		m_components[componentIndex] = std::move(component);
 
+		ComponentTiming& componentTiming = m_componentTimings[componentIndex];
+		componentTiming.name = TypeName<T>();
+		componentTiming.stats.Reset();
+
 		return componentRef;
 	}
 
 	template<typename F, bool Fixed>
-	void ApplicationBase::AddUpdaterFunc(Time interval, F&& functor)
+	std::size_t ApplicationBase::AddUpdaterFunc(Time interval, F&& functor)
 	{
 		if constexpr (std::is_invocable_r_v<void, F> || std::is_invocable_r_v<void, F, Time>)
 			return AddUpdater(std::make_unique<ApplicationUpdaterFunctorWithInterval<std::decay_t<F>, Fixed>>(std::forward<F>(functor), interval));
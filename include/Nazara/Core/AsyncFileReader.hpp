@@ -0,0 +1,86 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_CORE_ASYNCFILEREADER_HPP
+#define NAZARA_CORE_ASYNCFILEREADER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/Config.hpp>
+#include <Nazara/Core/Enums.hpp>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace Nz
+{
+	class File;
+
+	class NAZARA_CORE_API AsyncFileReader
+	{
+		struct ReadRequest;
+		struct SharedState;
+
+		public:
+			class ReadHandle;
+
+			AsyncFileReader(unsigned int threadCount = 1, std::size_t maxBatchSize = 16);
+			AsyncFileReader(const AsyncFileReader&) = delete;
+			AsyncFileReader(AsyncFileReader&&) = delete;
+			~AsyncFileReader();
+
+			inline std::size_t GetMaxBatchSize() const;
+			std::size_t GetPendingReadCount() const;
+			inline unsigned int GetThreadCount() const;
+
+			ReadHandle Read(std::shared_ptr<File> file, UInt64 offset, std::size_t size, void* buffer, FileReadPriority priority = FileReadPriority::Normal);
+
+			void WaitForReads();
+
+			AsyncFileReader& operator=(const AsyncFileReader&) = delete;
+			AsyncFileReader& operator=(AsyncFileReader&&) = delete;
+
+		private:
+			void ReaderThread();
+
+			std::shared_ptr<SharedState> m_sharedState;
+			std::size_t m_maxBatchSize;
+			std::vector<std::thread> m_threads;
+	};
+
+	class NAZARA_CORE_API AsyncFileReader::ReadHandle
+	{
+		friend AsyncFileReader;
+
+		public:
+			ReadHandle() = default;
+			ReadHandle(const ReadHandle&) = default;
+			ReadHandle(ReadHandle&&) noexcept = default;
+			~ReadHandle() = default;
+
+			bool Cancel();
+
+			std::size_t GetReadSize() const;
+
+			bool IsCancelled() const;
+			bool IsFinished() const;
+			inline bool IsValid() const;
+
+			std::size_t Wait() const;
+
+			ReadHandle& operator=(const ReadHandle&) = default;
+			ReadHandle& operator=(ReadHandle&&) noexcept = default;
+
+		private:
+			inline ReadHandle(std::shared_ptr<SharedState> sharedState, std::shared_ptr<ReadRequest> request);
+
+			std::shared_ptr<SharedState> m_sharedState;
+			std::shared_ptr<ReadRequest> m_request;
+	};
+}
+
+#include <Nazara/Core/AsyncFileReader.inl>
+
+#endif // NAZARA_CORE_ASYNCFILEREADER_HPP
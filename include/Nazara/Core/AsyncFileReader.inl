@@ -0,0 +1,31 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	inline std::size_t AsyncFileReader::GetMaxBatchSize() const
+	{
+		return m_maxBatchSize;
+	}
+
+	inline unsigned int AsyncFileReader::GetThreadCount() const
+	{
+		return static_cast<unsigned int>(m_threads.size());
+	}
+
+	inline AsyncFileReader::ReadHandle::ReadHandle(std::shared_ptr<SharedState> sharedState, std::shared_ptr<ReadRequest> request) :
+	m_sharedState(std::move(sharedState)),
+	m_request(std::move(request))
+	{
+	}
+
+	inline bool AsyncFileReader::ReadHandle::IsValid() const
+	{
+		return m_request != nullptr;
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
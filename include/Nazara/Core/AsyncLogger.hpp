@@ -0,0 +1,87 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_CORE_ASYNCLOGGER_HPP
+#define NAZARA_CORE_ASYNCLOGGER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/AbstractLogger.hpp>
+#include <Nazara/Core/MpscQueue.hpp>
+#include <Nazara/Core/Time.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_CORE_API AsyncLogger : public AbstractLogger
+	{
+		public:
+			AsyncLogger(std::unique_ptr<AbstractLogger> logger, std::size_t maxPendingRecords = 4096, Time flushInterval = Time::Milliseconds(10));
+			AsyncLogger(const AsyncLogger&) = delete;
+			AsyncLogger(AsyncLogger&&) = delete;
+			~AsyncLogger();
+
+			bool DispatchesLogSignals() const override;
+
+			void EnableStdReplication(bool enable) override;
+
+			void Flush();
+
+			inline UInt64 GetDroppedRecordCount() const;
+			inline AbstractLogger& GetLogger();
+			inline const AbstractLogger& GetLogger() const;
+
+			bool IsStdReplicationEnabled() const override;
+
+			void Write(std::string_view string) override;
+			void WriteError(ErrorType type, std::string_view error, unsigned int line = 0, const char* file = nullptr, const char* function = nullptr) override;
+
+			AsyncLogger& operator=(const AsyncLogger&) = delete;
+			AsyncLogger& operator=(AsyncLogger&&) = delete;
+
+		private:
+			struct Record
+			{
+				std::string message;
+				std::string file;
+				std::string function;
+				ErrorType errorType;
+				UInt64 flushTicket = 0; //< non-zero for flush markers, which are not written
+				unsigned int line;
+				bool isError;
+			};
+
+			void PushRecord(Record&& record);
+			void WriterThread();
+			void WriteRecords(std::vector<UInt64>& flushTickets);
+
+			alignas(64) std::atomic<std::size_t> m_pendingRecordCount;
+			alignas(64) std::atomic<UInt64> m_nextFlushTicket;
+			std::atomic<UInt64> m_droppedRecordCount;
+			std::condition_variable m_flushCondition;
+			std::condition_variable m_wakeCondition;
+			mutable std::mutex m_loggerMutex; //< protects the wrapped logger, used by the logging thread
+			std::mutex m_mutex;
+			std::size_t m_maxPendingRecords;
+			std::thread m_writerThread;
+			std::unique_ptr<AbstractLogger> m_logger;
+			MpscQueue<Record> m_records;
+			Time m_flushInterval;
+			std::vector<UInt64> m_completedFlushTickets;
+			UInt64 m_reportedDroppedRecordCount; //< only used by the logging thread
+			bool m_isFlushRequested;
+			bool m_isStopping;
+	};
+}
+
+#include <Nazara/Core/AsyncLogger.inl>
+
+#endif // NAZARA_CORE_ASYNCLOGGER_HPP
@@ -0,0 +1,35 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Gets the number of records dropped because too many were pending
+	* \return Dropped record count since the logger creation
+	*/
+	inline UInt64 AsyncLogger::GetDroppedRecordCount() const
+	{
+		return m_droppedRecordCount.load(std::memory_order_relaxed);
+	}
+
+	/*!
+	* \brief Gets the wrapped logger
+	* \return Logger writing records on the logging thread
+	*
+	* \remark The wrapped logger is used from the logging thread, it must not be used directly while records are being written
+	*/
+	inline AbstractLogger& AsyncLogger::GetLogger()
+	{
+		return *m_logger;
+	}
+
+	inline const AbstractLogger& AsyncLogger::GetLogger() const
+	{
+		return *m_logger;
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
@@ -0,0 +1,92 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_CORE_BITSERIALIZATION_HPP
+#define NAZARA_CORE_BITSERIALIZATION_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/SerializationContext.hpp>
+#include <Nazara/Math/Quaternion.hpp>
+#include <NazaraUtils/TypeTag.hpp>
+#include <type_traits>
+
+namespace Nz
+{
+	// Wrappers selecting a bit-level encoding when used with Serialize/Unserialize (and ByteStream operators)
+
+	template<typename T>
+	struct BitField
+	{
+		static_assert(std::is_integral_v<std::remove_const_t<T>>, "BitField only supports integral types");
+
+		BitField(T& Value, UInt8 BitCount);
+
+		T& value;
+		UInt8 bitCount;
+	};
+
+	template<typename T>
+	struct BoundedInteger
+	{
+		static_assert(std::is_integral_v<std::remove_const_t<T>>, "BoundedInteger only supports integral types");
+
+		BoundedInteger(T& Value, std::remove_const_t<T> Min, std::remove_const_t<T> Max);
+
+		constexpr UInt8 GetBitCount() const;
+
+		T& value;
+		std::remove_const_t<T> min;
+		std::remove_const_t<T> max;
+	};
+
+	template<typename T>
+	struct CompressedQuaternion
+	{
+		CompressedQuaternion(Quaternion<T>& Value, UInt8 BitCount = 10);
+
+		Quaternion<T>& value;
+		UInt8 bitCount; //< per component, three components are written along with a two bits index
+	};
+
+	template<typename T>
+	struct QuantizedFloat
+	{
+		static_assert(std::is_floating_point_v<std::remove_const_t<T>>, "QuantizedFloat only supports floating-point types");
+
+		QuantizedFloat(T& Value, std::remove_const_t<T> Min, std::remove_const_t<T> Max, UInt8 BitCount);
+
+		T& value;
+		std::remove_const_t<T> min;
+		std::remove_const_t<T> max;
+		UInt8 bitCount;
+	};
+
+	template<typename T>
+	struct VarInteger
+	{
+		static_assert(std::is_integral_v<std::remove_const_t<T>>, "VarInteger only supports integral types");
+
+		VarInteger(T& Value);
+
+		T& value;
+	};
+
+	template<typename T> bool Serialize(SerializationContext& context, const BitField<T>& field, TypeTag<BitField<T>>);
+	template<typename T> bool Serialize(SerializationContext& context, const BoundedInteger<T>& field, TypeTag<BoundedInteger<T>>);
+	template<typename T> bool Serialize(SerializationContext& context, const CompressedQuaternion<T>& field, TypeTag<CompressedQuaternion<T>>);
+	template<typename T> bool Serialize(SerializationContext& context, const QuantizedFloat<T>& field, TypeTag<QuantizedFloat<T>>);
+	template<typename T> bool Serialize(SerializationContext& context, const VarInteger<T>& field, TypeTag<VarInteger<T>>);
+
+	template<typename T> bool Unserialize(SerializationContext& context, BitField<T>* field, TypeTag<BitField<T>>);
+	template<typename T> bool Unserialize(SerializationContext& context, BoundedInteger<T>* field, TypeTag<BoundedInteger<T>>);
+	template<typename T> bool Unserialize(SerializationContext& context, CompressedQuaternion<T>* field, TypeTag<CompressedQuaternion<T>>);
+	template<typename T> bool Unserialize(SerializationContext& context, QuantizedFloat<T>* field, TypeTag<QuantizedFloat<T>>);
+	template<typename T> bool Unserialize(SerializationContext& context, VarInteger<T>* field, TypeTag<VarInteger<T>>);
+}
+
+#include <Nazara/Core/BitSerialization.inl>
+
+#endif // NAZARA_CORE_BITSERIALIZATION_HPP
@@ -0,0 +1,398 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Error.hpp>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace Detail
+	{
+		constexpr UInt64 BitMask(UInt8 bitCount)
+		{
+			return (bitCount >= 64) ? ~UInt64(0) : (UInt64(1) << bitCount) - 1;
+		}
+	}
+
+	/*!
+	* \ingroup core
+	* \class Nz::BitField
+	* \brief Core class serializing an integer using a fixed number of bits
+	*
+	* Signed integers are stored in two's complement and sign-extended when unserialized.
+	*
+	* \remark Bit-level wrappers share the bit cursor used by booleans, a byte-aligned value written afterwards flushes it
+	*/
+	template<typename T>
+	BitField<T>::BitField(T& Value, UInt8 BitCount) :
+	value(Value),
+	bitCount(BitCount)
+	{
+		NazaraAssert(bitCount >= 1 && bitCount <= sizeof(T) * CHAR_BIT, "bit count out of range");
+	}
+
+	/*!
+	* \ingroup core
+	* \class Nz::BoundedInteger
+	* \brief Core class serializing an integer in a known range, using only the bits required by this range
+	*/
+	template<typename T>
+	BoundedInteger<T>::BoundedInteger(T& Value, std::remove_const_t<T> Min, std::remove_const_t<T> Max) :
+	value(Value),
+	min(Min),
+	max(Max)
+	{
+		NazaraAssert(min <= max, "invalid range");
+	}
+
+	template<typename T>
+	constexpr UInt8 BoundedInteger<T>::GetBitCount() const
+	{
+		using Unsigned = std::make_unsigned_t<std::remove_const_t<T>>;
+
+		UInt64 range = static_cast<Unsigned>(static_cast<Unsigned>(max) - static_cast<Unsigned>(min));
+
+		UInt8 bitCount = 0;
+		while (range != 0)
+		{
+			range >>= 1;
+			bitCount++;
+		}
+
+		return bitCount;
+	}
+
+	/*!
+	* \ingroup core
+	* \class Nz::CompressedQuaternion
+	* \brief Core class serializing a normalized quaternion using the smallest three method
+	*
+	* The largest component is dropped (and recomputed on unserialization), its index is written on two bits followed by
+	* the three other components, quantized in the [-1/sqrt(2), 1/sqrt(2)] range.
+	*/
+	template<typename T>
+	CompressedQuaternion<T>::CompressedQuaternion(Quaternion<T>& Value, UInt8 BitCount) :
+	value(Value),
+	bitCount(BitCount)
+	{
+		NazaraAssert(bitCount >= 2 && bitCount <= 32, "bit count out of range");
+	}
+
+	/*!
+	* \ingroup core
+	* \class Nz::QuantizedFloat
+	* \brief Core class serializing a floating-point value in a known range, using a fixed number of bits
+	*
+	* Values out of the range are clamped.
+	*/
+	template<typename T>
+	QuantizedFloat<T>::QuantizedFloat(T& Value, std::remove_const_t<T> Min, std::remove_const_t<T> Max, UInt8 BitCount) :
+	value(Value),
+	min(Min),
+	max(Max),
+	bitCount(BitCount)
+	{
+		NazaraAssert(min < max, "invalid range");
+		NazaraAssert(bitCount >= 1 && bitCount <= 32, "bit count out of range");
+	}
+
+	/*!
+	* \ingroup core
+	* \class Nz::VarInteger
+	* \brief Core class serializing an integer using as few bits as its value requires
+	*
+	* The value is written seven bits at a time, each group followed by a continuation bit.
+	* Signed integers are zigzag encoded first, so small negative values stay small.
+	*/
+	template<typename T>
+	VarInteger<T>::VarInteger(T& Value) :
+	value(Value)
+	{
+	}
+
+	/*!
+	* \ingroup core
+	* \brief Serializes an integer using a fixed number of bits
+	* \return true if successfully serialized
+	*
+	* \param context Serialization context
+	* \param field Input field
+	*/
+	template<typename T>
+	bool Serialize(SerializationContext& context, const BitField<T>& field, TypeTag<BitField<T>>)
+	{
+		using Unsigned = std::make_unsigned_t<std::remove_const_t<T>>;
+
+		return context.WriteBits(static_cast<Unsigned>(field.value), field.bitCount);
+	}
+
+	/*!
+	* \ingroup core
+	* \brief Serializes an integer in a known range
+	* \return true if successfully serialized
+	*
+	* \param context Serialization context
+	* \param field Input field
+	*/
+	template<typename T>
+	bool Serialize(SerializationContext& context, const BoundedInteger<T>& field, TypeTag<BoundedInteger<T>>)
+	{
+		using Unsigned = std::make_unsigned_t<std::remove_const_t<T>>;
+
+		NazaraAssert(field.value >= field.min && field.value <= field.max, "value out of range");
+
+		Unsigned offset = static_cast<Unsigned>(static_cast<Unsigned>(field.value) - static_cast<Unsigned>(field.min));
+		return context.WriteBits(offset, field.GetBitCount());
+	}
+
+	/*!
+	* \ingroup core
+	* \brief Serializes a normalized quaternion using the smallest three method
+	* \return true if successfully serialized
+	*
+	* \param context Serialization context
+	* \param field Input field
+	*/
+	template<typename T>
+	bool Serialize(SerializationContext& context, const CompressedQuaternion<T>& field, TypeTag<CompressedQuaternion<T>>)
+	{
+		const Quaternion<T>& quat = field.value;
+		T components[4] = { quat.x, quat.y, quat.z, quat.w };
+
+		UInt8 largestIndex = 0;
+		for (UInt8 i = 1; i < 4; ++i)
+		{
+			if (std::abs(components[i]) > std::abs(components[largestIndex]))
+				largestIndex = i;
+		}
+
+		// q and -q are the same rotation, make the dropped component positive
+		T sign = (components[largestIndex] < T(0)) ? T(-1) : T(1);
+
+		if (!context.WriteBits(largestIndex, 2))
+			return false;
+
+		constexpr T range = T(0.70710678118654752440); // 1/sqrt(2)
+
+		UInt64 maxValue = Detail::BitMask(field.bitCount);
+		for (UInt8 i = 0; i < 4; ++i)
+		{
+			if (i == largestIndex)
+				continue;
+
+			double normalized = std::clamp((double(components[i] * sign) + range) / (2.0 * range), 0.0, 1.0);
+			if (!context.WriteBits(static_cast<UInt64>(std::llround(normalized * maxValue)), field.bitCount))
+				return false;
+		}
+
+		return true;
+	}
+
+	/*!
+	* \ingroup core
+	* \brief Serializes a floating-point value in a known range
+	* \return true if successfully serialized
+	*
+	* \param context Serialization context
+	* \param field Input field
+	*/
+	template<typename T>
+	bool Serialize(SerializationContext& context, const QuantizedFloat<T>& field, TypeTag<QuantizedFloat<T>>)
+	{
+		// computed in double precision so 32 bits values don't round over their maximum
+		UInt64 maxValue = Detail::BitMask(field.bitCount);
+		double normalized = std::clamp((double(field.value) - field.min) / (double(field.max) - field.min), 0.0, 1.0);
+
+		return context.WriteBits(static_cast<UInt64>(std::llround(normalized * maxValue)), field.bitCount);
+	}
+
+	/*!
+	* \ingroup core
+	* \brief Serializes an integer using a variable number of bits
+	* \return true if successfully serialized
+	*
+	* \param context Serialization context
+	* \param field Input field
+	*/
+	template<typename T>
+	bool Serialize(SerializationContext& context, const VarInteger<T>& field, TypeTag<VarInteger<T>>)
+	{
+		using Integer = std::remove_const_t<T>;
+		using Unsigned = std::make_unsigned_t<Integer>;
+
+		UInt64 value;
+		if constexpr (std::is_signed_v<Integer>)
+			value = static_cast<Unsigned>((static_cast<Unsigned>(field.value) << 1) ^ static_cast<Unsigned>(field.value >> (sizeof(Integer) * CHAR_BIT - 1)));
+		else
+			value = field.value;
+
+		do
+		{
+			UInt64 group = value & 0x7F;
+			value >>= 7;
+
+			if (!context.WriteBits(group | ((value != 0) ? 0x80 : 0), 8))
+				return false;
+		}
+		while (value != 0);
+
+		return true;
+	}
+
+	/*!
+	* \ingroup core
+	* \brief Unserializes an integer using a fixed number of bits
+	* \return true if successfully unserialized
+	*
+	* \param context Serialization context
+	* \param field Output field
+	*/
+	template<typename T>
+	bool Unserialize(SerializationContext& context, BitField<T>* field, TypeTag<BitField<T>>)
+	{
+		using Unsigned = std::make_unsigned_t<T>;
+
+		UInt64 value;
+		if (!context.ReadBits(&value, field->bitCount))
+			return false;
+
+		if constexpr (std::is_signed_v<T>)
+		{
+			// sign extension
+			if (field->bitCount < 64 && (value & (UInt64(1) << (field->bitCount - 1))))
+				value |= ~Detail::BitMask(field->bitCount);
+		}
+
+		field->value = static_cast<T>(static_cast<Unsigned>(value));
+		return true;
+	}
+
+	/*!
+	* \ingroup core
+	* \brief Unserializes an integer in a known range
+	* \return true if successfully unserialized
+	*
+	* \param context Serialization context
+	* \param field Output field
+	*/
+	template<typename T>
+	bool Unserialize(SerializationContext& context, BoundedInteger<T>* field, TypeTag<BoundedInteger<T>>)
+	{
+		using Unsigned = std::make_unsigned_t<T>;
+
+		UInt64 offset;
+		if (!context.ReadBits(&offset, field->GetBitCount()))
+			return false;
+
+		field->value = static_cast<T>(static_cast<Unsigned>(static_cast<Unsigned>(field->min) + static_cast<Unsigned>(offset)));
+		return true;
+	}
+
+	/*!
+	* \ingroup core
+	* \brief Unserializes a quaternion compressed using the smallest three method
+	* \return true if successfully unserialized
+	*
+	* \param context Serialization context
+	* \param field Output field
+	*/
+	template<typename T>
+	bool Unserialize(SerializationContext& context, CompressedQuaternion<T>* field, TypeTag<CompressedQuaternion<T>>)
+	{
+		UInt64 largestIndex;
+		if (!context.ReadBits(&largestIndex, 2))
+			return false;
+
+		constexpr T range = T(0.70710678118654752440); // 1/sqrt(2)
+
+		T components[4];
+		T squaredSum = T(0);
+
+		UInt64 maxValue = Detail::BitMask(field->bitCount);
+		for (UInt8 i = 0; i < 4; ++i)
+		{
+			if (i == largestIndex)
+				continue;
+
+			UInt64 value;
+			if (!context.ReadBits(&value, field->bitCount))
+				return false;
+
+			components[i] = static_cast<T>(double(value) / double(maxValue) * (2.0 * range) - range);
+			squaredSum += components[i] * components[i];
+		}
+
+		components[largestIndex] = std::sqrt(std::max(T(1) - squaredSum, T(0)));
+
+		Quaternion<T>& quat = field->value;
+		quat.x = components[0];
+		quat.y = components[1];
+		quat.z = components[2];
+		quat.w = components[3];
+
+		return true;
+	}
+
+	/*!
+	* \ingroup core
+	* \brief Unserializes a floating-point value in a known range
+	* \return true if successfully unserialized
+	*
+	* \param context Serialization context
+	* \param field Output field
+	*/
+	template<typename T>
+	bool Unserialize(SerializationContext& context, QuantizedFloat<T>* field, TypeTag<QuantizedFloat<T>>)
+	{
+		UInt64 value;
+		if (!context.ReadBits(&value, field->bitCount))
+			return false;
+
+		UInt64 maxValue = Detail::BitMask(field->bitCount);
+		field->value = field->min + (field->max - field->min) * static_cast<T>(double(value) / double(maxValue));
+		return true;
+	}
+
+	/*!
+	* \ingroup core
+	* \brief Unserializes an integer using a variable number of bits
+	* \return true if successfully unserialized
+	*
+	* \param context Serialization context
+	* \param field Output field
+	*/
+	template<typename T>
+	bool Unserialize(SerializationContext& context, VarInteger<T>* field, TypeTag<VarInteger<T>>)
+	{
+		using Unsigned = std::make_unsigned_t<T>;
+
+		UInt64 value = 0;
+		for (unsigned int shift = 0;; shift += 7)
+		{
+			if (shift >= sizeof(T) * CHAR_BIT)
+				return false; //< too many groups for this type, data is corrupted
+
+			UInt64 group;
+			if (!context.ReadBits(&group, 8))
+				return false;
+
+			value |= (group & 0x7F) << shift;
+			if ((group & 0x80) == 0)
+				break;
+		}
+
+		Unsigned unsignedValue = static_cast<Unsigned>(value);
+		if constexpr (std::is_signed_v<T>)
+			field->value = static_cast<T>((unsignedValue >> 1) ^ -static_cast<Unsigned>(unsignedValue & 1));
+		else
+			field->value = static_cast<T>(unsignedValue);
+
+		return true;
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
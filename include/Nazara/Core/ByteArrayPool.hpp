@@ -9,31 +9,56 @@
 
 #include <NazaraUtils/Prerequisites.hpp>
 #include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/Enums.hpp>
+#include <array>
+#include <mutex>
 #include <vector>
 
 namespace Nz
 {
-	class AbstractHash;
-
 	class NAZARA_CORE_API ByteArrayPool
 	{
 		public:
-			ByteArrayPool() = default;
+			ByteArrayPool(std::size_t maxRetainedBytesPerClass = DefaultMaxRetainedBytesPerClass, MemoryTag memoryTag = MemoryTag::Core);
 			ByteArrayPool(const ByteArrayPool&) = delete;
-			ByteArrayPool(ByteArrayPool&&) = default;
-			~ByteArrayPool() = default;
+			ByteArrayPool(ByteArrayPool&&) = delete;
+			~ByteArrayPool();
+
+			void Clear();
 
-			inline void Clear();
+			ByteArray GetByteArray(std::size_t capacity = 0);
+			inline std::size_t GetMaxRetainedBytesPerClass() const;
+			inline MemoryTag GetMemoryTag() const;
+			std::size_t GetRetainedBytes() const;
 
-			inline ByteArray GetByteArray(std::size_t capacity = 0);
+			void ReturnByteArray(ByteArray byteArray);
 
-			inline void ReturnByteArray(ByteArray byteArray);
+			void SetMaxRetainedBytesPerClass(std::size_t maxRetainedBytes);
 
 			ByteArrayPool& operator=(const ByteArrayPool&) = delete;
-			ByteArrayPool& operator=(ByteArrayPool&&) = default;
+			ByteArrayPool& operator=(ByteArrayPool&&) = delete;
+
+			static constexpr std::size_t DefaultMaxRetainedBytesPerClass = 4 * 1024 * 1024;
+			static constexpr std::size_t MaxSizeClassShift = 20; //< 1MiB, bigger arrays are not retained
+			static constexpr std::size_t MinSizeClassShift = 6; //< 64B
+			static constexpr std::size_t SizeClassCount = MaxSizeClassShift - MinSizeClassShift + 1;
+
+			static inline std::size_t GetSizeClassCapacity(std::size_t sizeClass);
 
 		private:
-			std::vector<ByteArray> m_byteArrays;
+			static std::size_t GetAcquireSizeClass(std::size_t capacity);
+			static std::size_t GetReturnSizeClass(std::size_t capacity);
+
+			struct SizeClass
+			{
+				std::mutex mutex;
+				std::size_t retainedBytes = 0;
+				std::vector<ByteArray> byteArrays;
+			};
+
+			std::size_t m_maxRetainedBytesPerClass;
+			MemoryTag m_memoryTag;
+			mutable std::array<SizeClass, SizeClassCount> m_sizeClasses;
 	};
 }
 
@@ -2,41 +2,36 @@
 // This file is part of the "Nazara Engine - Core module"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
+#include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
 {
-	namespace Detail
+	/*!
+	* \brief Gets the maximum number of bytes retained by each size class
+	*/
+	inline std::size_t ByteArrayPool::GetMaxRetainedBytesPerClass() const
 	{
-		inline bool SortByteArrayByCapacity(const ByteArray& byteArray, std::size_t refCapacity)
-		{
-			return refCapacity > byteArray.GetCapacity();
-		}
+		return m_maxRetainedBytesPerClass;
 	}
 
-	inline void ByteArrayPool::Clear()
+	/*!
+	* \brief Gets the tag under which retained bytes are accounted by the MemoryTracker
+	*/
+	inline MemoryTag ByteArrayPool::GetMemoryTag() const
 	{
-		m_byteArrays.clear();
+		return m_memoryTag;
 	}
 
-	inline ByteArray ByteArrayPool::GetByteArray(std::size_t capacity)
+	/*!
+	* \brief Gets the capacity of the byte arrays allocated for a size class
+	*
+	* \param sizeClass Index of the size class, must be lower than SizeClassCount
+	*/
+	inline std::size_t ByteArrayPool::GetSizeClassCapacity(std::size_t sizeClass)
 	{
-		ByteArray ret;
-
-		auto it = std::lower_bound(m_byteArrays.begin(), m_byteArrays.end(), capacity, Detail::SortByteArrayByCapacity);
-		if (it != m_byteArrays.end())
-		{
-			ret = std::move(*it);
-			m_byteArrays.erase(it);
-		}
-
-		return ret;
-	}
-
-	inline void ByteArrayPool::ReturnByteArray(ByteArray byteArray)
-	{
-		auto it = std::lower_bound(m_byteArrays.begin(), m_byteArrays.end(), byteArray.GetCapacity(), Detail::SortByteArrayByCapacity);
-		m_byteArrays.emplace(it, std::move(byteArray));
+		NazaraAssert(sizeClass < SizeClassCount, "size class out of range");
+		return std::size_t(1) << (sizeClass + MinSizeClassShift);
 	}
 }
 
@@ -48,7 +48,7 @@ namespace Nz
 			inline std::size_t Write(const void* data, std::size_t size);
 
 			template<typename T>
-			ByteStream& operator>>(T& value);
+			ByteStream& operator>>(T&& value);
 
 			template<typename T>
 			ByteStream& operator<<(const T& value);
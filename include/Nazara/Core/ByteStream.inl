@@ -159,13 +159,13 @@ namespace Nz
 	* \brief Outputs a data from the stream
 	* \return A reference to this
 	*
-	* \param value Value to unserialize
+	* \param value Value to unserialize, may be a temporary wrapper such as QuantizedFloat
 	*
 	* \remark Produces a NazaraError if unserialization failed
 	*/
 
 	template<typename T>
-	ByteStream& ByteStream::operator>>(T& value)
+	ByteStream& ByteStream::operator>>(T&& value)
 	{
 		if (!m_context.stream)
 			OnEmptyStream();
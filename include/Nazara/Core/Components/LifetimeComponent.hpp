@@ -13,11 +13,17 @@
 
 namespace Nz
 {
+	class LifetimeSystem;
+
+	// While a LifetimeSystem schedules the component, its expiration time is stored relative to the system clock (patch the component for an earlier expiration to be taken into account)
+	// Copies only carry the remaining lifetime, they are scheduled again by the LifetimeSystem of the registry they're added to (moves keep the clock, as entt relocates components within a storage)
 	class LifetimeComponent
 	{
+		friend LifetimeSystem;
+
 		public:
 			inline LifetimeComponent(Time lifetime);
-			LifetimeComponent(const LifetimeComponent&) = default;
+			inline LifetimeComponent(const LifetimeComponent& lifetime);
 			LifetimeComponent(LifetimeComponent&&) = default;
 			~LifetimeComponent() = default;
 
@@ -27,11 +33,12 @@ namespace Nz
 
 			inline bool IsAlive() const;
 
-			LifetimeComponent& operator=(const LifetimeComponent&) = default;
+			inline LifetimeComponent& operator=(const LifetimeComponent& lifetime);
 			LifetimeComponent& operator=(LifetimeComponent&&) = default;
 
 		private:
-			Time m_remainingLifetime;
+			const Time* m_systemTime; //< clock of the LifetimeSystem scheduling this component, if any
+			Time m_lifetime; //< expiration time if scheduled by a LifetimeSystem, remaining lifetime otherwise
 	};
 }
 
@@ -7,23 +7,42 @@
 namespace Nz
 {
 	inline LifetimeComponent::LifetimeComponent(Time lifetime) :
-	m_remainingLifetime(lifetime)
+	m_systemTime(nullptr),
+	m_lifetime(lifetime)
+	{
+	}
+
+	inline LifetimeComponent::LifetimeComponent(const LifetimeComponent& lifetime) :
+	m_systemTime(nullptr),
+	m_lifetime(lifetime.GetRemainingLifeTime())
 	{
 	}
 
 	inline void LifetimeComponent::DecreaseLifetime(Time elapsedTime)
 	{
-		m_remainingLifetime -= elapsedTime;
+		m_lifetime -= elapsedTime;
 	}
 
 	inline Time LifetimeComponent::GetRemainingLifeTime() const
 	{
-		return m_remainingLifetime;
+		if (m_systemTime)
+			return m_lifetime - *m_systemTime;
+
+		return m_lifetime;
 	}
 
 	inline bool LifetimeComponent::IsAlive() const
 	{
-		return m_remainingLifetime >= Time::Zero();
+		return GetRemainingLifeTime() >= Time::Zero();
+	}
+
+	inline LifetimeComponent& LifetimeComponent::operator=(const LifetimeComponent& lifetime)
+	{
+		// Don't keep a reference to the clock of another system
+		m_lifetime = lifetime.GetRemainingLifeTime();
+		m_systemTime = nullptr;
+
+		return *this;
 	}
 }
 
@@ -43,6 +43,16 @@
 // Checks the assertions
 #define NAZARA_CORE_ENABLE_ASSERTS 0
 
+// Compiles the memory accounting of engine allocations (NazaraTrackAllocation/TrackedAllocator), reported by the MemoryTracker
+#ifndef NAZARA_CORE_ENABLE_MEMORY_TRACKING
+	#define NAZARA_CORE_ENABLE_MEMORY_TRACKING 0
+#endif
+
+// Compiles the profiler zones of the engine (NazaraProfileScope), which are recorded when the Profiler is enabled
+#ifndef NAZARA_CORE_ENABLE_PROFILING
+	#define NAZARA_CORE_ENABLE_PROFILING 0
+#endif
+
 // Call exit when an assertion is invalid
 #define NAZARA_CORE_EXIT_ON_ASSERT_FAILURE 1
 
@@ -11,7 +11,9 @@
 #include <Nazara/Core/HardwareInfo.hpp>
 #include <Nazara/Core/ModuleBase.hpp>
 #include <Nazara/Core/Modules.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
 #include <NazaraUtils/TypeList.hpp>
+#include <mutex>
 #include <optional>
 
 namespace Nz
@@ -29,9 +31,12 @@ namespace Nz
 			~Core();
 
 			inline const HardwareInfo& GetHardwareInfo() const;
+			TaskScheduler& GetTaskScheduler();
 
 		private:
 			std::optional<HardwareInfo> m_hardwareInfo;
+			std::optional<TaskScheduler> m_taskScheduler;
+			std::once_flag m_taskSchedulerInitFlag;
 
 			static Core* s_instance;
 	};
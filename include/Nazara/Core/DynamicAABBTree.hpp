@@ -0,0 +1,82 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_CORE_DYNAMICAABBTREE_HPP
+#define NAZARA_CORE_DYNAMICAABBTREE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/Config.hpp>
+#include <Nazara/Math/Box.hpp>
+#include <Nazara/Math/Enums.hpp>
+#include <Nazara/Math/Frustum.hpp>
+#include <Nazara/Math/Vector3.hpp>
+#include <limits>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_CORE_API DynamicAABBTree
+	{
+		public:
+			DynamicAABBTree(float margin = 0.1f);
+			DynamicAABBTree(const DynamicAABBTree&) = default;
+			DynamicAABBTree(DynamicAABBTree&&) noexcept = default;
+			~DynamicAABBTree() = default;
+
+			std::size_t AddProxy(const Boxf& aabb, std::size_t userData);
+
+			void Clear();
+
+			inline Boxf GetFatAABB(std::size_t proxyId) const;
+			inline float GetMargin() const;
+			inline std::size_t GetProxyCount() const;
+			inline std::size_t GetUserData(std::size_t proxyId) const;
+
+			bool MoveProxy(std::size_t proxyId, const Boxf& aabb);
+
+			template<typename F> void Query(const Boxf& aabb, F&& callback) const;
+			template<typename F> void Query(const Frustumf& frustum, F&& callback) const;
+
+			void RemoveProxy(std::size_t proxyId);
+
+			DynamicAABBTree& operator=(const DynamicAABBTree&) = default;
+			DynamicAABBTree& operator=(DynamicAABBTree&&) noexcept = default;
+
+			static constexpr std::size_t InvalidProxy = std::numeric_limits<std::size_t>::max();
+
+		private:
+			std::size_t AllocateNode();
+			std::size_t Balance(std::size_t nodeIndex);
+			void FreeNode(std::size_t nodeIndex);
+			void InsertLeaf(std::size_t leafIndex);
+			void RefitAncestors(std::size_t nodeIndex);
+			void RemoveLeaf(std::size_t leafIndex);
+			template<typename F> void ReportSubtree(std::size_t nodeIndex, F& callback) const;
+
+			struct Node
+			{
+				Vector3f min;
+				Vector3f max;
+				std::size_t child1;
+				std::size_t child2;
+				std::size_t parent; //< next free node when the node is unused
+				std::size_t userData;
+				int height; //< 0 for leaves, -1 for unused nodes
+
+				inline bool IsLeaf() const;
+			};
+
+			std::size_t m_freeList;
+			std::size_t m_proxyCount;
+			std::size_t m_root;
+			std::vector<Node> m_nodes;
+			float m_margin;
+	};
+}
+
+#include <Nazara/Core/DynamicAABBTree.inl>
+
+#endif // NAZARA_CORE_DYNAMICAABBTREE_HPP
@@ -0,0 +1,158 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Error.hpp>
+#include <NazaraUtils/StackVector.hpp>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Returns the enlarged AABB stored in the tree for a proxy
+	* \return Fat AABB containing the AABB the proxy was last inserted or moved with
+	*
+	* \param proxyId Proxy identifier returned by AddProxy
+	*/
+	inline Boxf DynamicAABBTree::GetFatAABB(std::size_t proxyId) const
+	{
+		NazaraAssert(proxyId < m_nodes.size() && m_nodes[proxyId].height == 0, "invalid proxy");
+
+		const Node& node = m_nodes[proxyId];
+		return Boxf::FromExtents(node.min, node.max);
+	}
+
+	inline float DynamicAABBTree::GetMargin() const
+	{
+		return m_margin;
+	}
+
+	inline std::size_t DynamicAABBTree::GetProxyCount() const
+	{
+		return m_proxyCount;
+	}
+
+	inline std::size_t DynamicAABBTree::GetUserData(std::size_t proxyId) const
+	{
+		NazaraAssert(proxyId < m_nodes.size() && m_nodes[proxyId].height == 0, "invalid proxy");
+
+		return m_nodes[proxyId].userData;
+	}
+
+	/*!
+	* \brief Calls the callback for every proxy whose fat AABB intersects the box
+	*
+	* \param aabb Box to test
+	* \param callback Function called as callback(userData) for every overlapping proxy
+	*/
+	template<typename F>
+	void DynamicAABBTree::Query(const Boxf& aabb, F&& callback) const
+	{
+		if (m_root == InvalidProxy)
+			return;
+
+		Vector3f aabbMin = aabb.GetMinimum();
+		Vector3f aabbMax = aabb.GetMaximum();
+
+		// Each iteration pops one node and pushes at most two, the stack never grows over the tree height + 1
+		StackVector<std::size_t> stack = NazaraStackVector(std::size_t, m_nodes[m_root].height + 1);
+		stack.push_back(m_root);
+
+		while (!stack.empty())
+		{
+			std::size_t nodeIndex = stack.back();
+			stack.pop_back();
+
+			const Node& node = m_nodes[nodeIndex];
+			if (node.max.x < aabbMin.x || node.min.x > aabbMax.x ||
+			    node.max.y < aabbMin.y || node.min.y > aabbMax.y ||
+			    node.max.z < aabbMin.z || node.min.z > aabbMax.z)
+				continue;
+
+			if (node.IsLeaf())
+				callback(node.userData);
+			else
+			{
+				stack.push_back(node.child1);
+				stack.push_back(node.child2);
+			}
+		}
+	}
+
+	/*!
+	* \brief Calls the callback for every proxy whose fat AABB is not outside of the frustum
+	*
+	* \param frustum Frustum to test
+	* \param callback Function called as callback(userData, side) for every proxy
+	*
+	* \remark side is IntersectionSide::Inside when the fat AABB is fully inside the frustum (and thus the proxy AABB too), IntersectionSide::Intersecting otherwise,
+	* in the latter case the proxy AABB itself may be outside of the frustum
+	* \remark Subtrees fully inside the frustum are reported without further testing
+	*/
+	template<typename F>
+	void DynamicAABBTree::Query(const Frustumf& frustum, F&& callback) const
+	{
+		if (m_root == InvalidProxy)
+			return;
+
+		// Children are enclosed in their parent, they only have to be tested against the planes their parent straddles
+		struct PendingNode
+		{
+			std::size_t nodeIndex;
+			FrustumPlaneFlags planeMask;
+		};
+
+		StackVector<PendingNode> stack = NazaraStackVector(PendingNode, m_nodes[m_root].height + 1);
+		stack.push_back({ m_root, FrustumPlane_All });
+
+		while (!stack.empty())
+		{
+			PendingNode pendingNode = stack.back();
+			stack.pop_back();
+
+			const Node& node = m_nodes[pendingNode.nodeIndex];
+
+			IntersectionSide side = frustum.Intersect(Boxf::FromExtents(node.min, node.max), &pendingNode.planeMask);
+			if (side == IntersectionSide::Outside)
+				continue;
+
+			if (side == IntersectionSide::Inside)
+				ReportSubtree(pendingNode.nodeIndex, callback);
+			else if (node.IsLeaf())
+				callback(node.userData, IntersectionSide::Intersecting);
+			else
+			{
+				stack.push_back({ node.child1, pendingNode.planeMask });
+				stack.push_back({ node.child2, pendingNode.planeMask });
+			}
+		}
+	}
+
+	template<typename F>
+	void DynamicAABBTree::ReportSubtree(std::size_t nodeIndex, F& callback) const
+	{
+		StackVector<std::size_t> stack = NazaraStackVector(std::size_t, m_nodes[nodeIndex].height + 1);
+		stack.push_back(nodeIndex);
+
+		while (!stack.empty())
+		{
+			const Node& node = m_nodes[stack.back()];
+			stack.pop_back();
+
+			if (node.IsLeaf())
+				callback(node.userData, IntersectionSide::Inside);
+			else
+			{
+				stack.push_back(node.child1);
+				stack.push_back(node.child2);
+			}
+		}
+	}
+
+	inline bool DynamicAABBTree::Node::IsLeaf() const
+	{
+		return child1 == InvalidProxy;
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
@@ -16,15 +16,22 @@ namespace Nz
 	class NAZARA_CORE_API EntityWorld
 	{
 		public:
-			EntityWorld() = default;
+			inline EntityWorld();
 			EntityWorld(const EntityWorld&) = default;
 			EntityWorld(EntityWorld&&) = default;
 			virtual ~EntityWorld();
 
+			inline void EnableMainThreadOnly(bool enable);
+
+			virtual bool IsMainThreadOnly() const;
+
 			virtual void Update(Time elapsedTime) = 0;
 
 			EntityWorld& operator=(const EntityWorld&) = default;
 			EntityWorld& operator=(EntityWorld&&) = default;
+
+		private:
+			bool m_isMainThreadOnly;
 	};
 }
 
@@ -6,6 +6,20 @@
 
 namespace Nz
 {
+	inline EntityWorld::EntityWorld() :
+	m_isMainThreadOnly(false)
+	{
+	}
+
+	/*!
+	* \brief Forces the world to be updated on the thread updating the application, even when worlds are updated in parallel
+	*
+	* \see AppEntitySystemComponent::EnableParallelUpdate
+	*/
+	inline void EntityWorld::EnableMainThreadOnly(bool enable)
+	{
+		m_isMainThreadOnly = enable;
+	}
 }
 
 #include <Nazara/Core/DebugOff.hpp>
@@ -0,0 +1,108 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_CORE_ENTTSNAPSHOT_HPP
+#define NAZARA_CORE_ENTTSNAPSHOT_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/Algorithm.hpp>
+#include <Nazara/Core/Config.hpp>
+#include <Nazara/Core/SerializationContext.hpp>
+#include <entt/entt.hpp>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace Nz
+{
+	// Specialize this to customize how a component is stored in snapshots
+	template<typename T>
+	struct EnttSnapshotComponent
+	{
+		// Bulk copied components are stored as a single raw memory block (in native endianness), they must not reference entities or memory
+		static constexpr bool BulkCopy = std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>;
+
+		static bool Serialize(SerializationContext& context, const T& component);
+		static bool Unserialize(SerializationContext& context, T* component);
+	};
+
+	class NAZARA_CORE_API EnttSnapshot
+	{
+		public:
+			EnttSnapshot(entt::registry& registry);
+			EnttSnapshot(const EnttSnapshot&) = delete;
+			EnttSnapshot(EnttSnapshot&&) = delete;
+			~EnttSnapshot();
+
+			void ClearChanges();
+
+			inline entt::entity GetLoadedEntity(entt::entity snapshotEntity) const;
+
+			bool Load(SerializationContext& context);
+
+			template<typename T> void MarkUpdated(entt::entity entity);
+
+			template<typename T> void RegisterComponent(UInt32 componentId);
+
+			bool Save(SerializationContext& context);
+			bool SaveChanges(SerializationContext& context);
+
+			EnttSnapshot& operator=(const EnttSnapshot&) = delete;
+			EnttSnapshot& operator=(EnttSnapshot&&) = delete;
+
+			static constexpr UInt32 Magic = 0x4E455353; //< NESS
+			static constexpr UInt16 Version = 1;
+
+		private:
+			struct NAZARA_CORE_API ComponentBase
+			{
+				virtual ~ComponentBase();
+
+				virtual bool Load(EnttSnapshot& snapshot, SerializationContext& context, bool isBulkCopied, bool isSwapped) = 0;
+				virtual void RegisterDestroyedEntities(std::vector<entt::entity>& destroyedEntities) = 0;
+				virtual bool Save(EnttSnapshot& snapshot, SerializationContext& context, bool changesOnly) = 0;
+
+				std::vector<entt::entity> removedEntities;
+				std::vector<entt::entity> updatedEntities;
+				UInt32 componentId;
+			};
+
+			template<typename T>
+			struct Component : ComponentBase
+			{
+				Component(EnttSnapshot& snapshot);
+
+				bool Load(EnttSnapshot& snapshot, SerializationContext& context, bool isBulkCopied, bool isSwapped) override;
+				void OnRemoved(entt::registry& registry, entt::entity entity);
+				void OnUpdated(entt::registry& registry, entt::entity entity);
+				void RegisterDestroyedEntities(std::vector<entt::entity>& destroyedEntities) override;
+				bool Save(EnttSnapshot& snapshot, SerializationContext& context, bool changesOnly) override;
+
+				EnttSnapshot& owner;
+				entt::scoped_connection constructConnection;
+				entt::scoped_connection destroyConnection;
+				entt::scoped_connection updateConnection;
+			};
+
+			bool ReadEntities(SerializationContext& context, std::vector<entt::entity>& entities, bool isSwapped);
+			entt::entity RemapEntity(entt::entity snapshotEntity);
+			bool SaveInternal(SerializationContext& context, bool changesOnly);
+			bool WriteEntities(SerializationContext& context, const std::vector<entt::entity>& entities);
+
+			std::unordered_map<entt::entity, entt::entity> m_entityRemapping;
+			std::unordered_map<entt::id_type, std::size_t> m_componentIndices; //< by component type
+			std::vector<std::unique_ptr<ComponentBase>> m_components;
+			std::vector<entt::entity> m_entityBuffer;
+			std::vector<UInt8> m_dataBuffer;
+			entt::registry& m_registry;
+			bool m_isLoading;
+	};
+}
+
+#include <Nazara/Core/EnttSnapshot.inl>
+
+#endif // NAZARA_CORE_ENTTSNAPSHOT_HPP
@@ -0,0 +1,265 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/Stream.hpp>
+#include <algorithm>
+#include <cstring>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	template<typename T>
+	bool EnttSnapshotComponent<T>::Serialize(SerializationContext& context, const T& component)
+	{
+		return Nz::Serialize(context, component);
+	}
+
+	template<typename T>
+	bool EnttSnapshotComponent<T>::Unserialize(SerializationContext& context, T* component)
+	{
+		return Nz::Unserialize(context, component);
+	}
+
+	template<typename T>
+	EnttSnapshot::Component<T>::Component(EnttSnapshot& snapshot) :
+	owner(snapshot)
+	{
+		entt::registry& registry = snapshot.m_registry;
+		constructConnection = registry.on_construct<T>().template connect<&Component::OnUpdated>(*this);
+		destroyConnection = registry.on_destroy<T>().template connect<&Component::OnRemoved>(*this);
+		updateConnection = registry.on_update<T>().template connect<&Component::OnUpdated>(*this);
+	}
+
+	template<typename T>
+	bool EnttSnapshot::Component<T>::Load(EnttSnapshot& snapshot, SerializationContext& context, bool isBulkCopied, bool isSwapped)
+	{
+		entt::registry& registry = snapshot.m_registry;
+		std::vector<entt::entity>& entities = snapshot.m_entityBuffer;
+
+		if (!snapshot.ReadEntities(context, entities, isSwapped))
+			return false;
+
+		if constexpr (std::is_empty_v<T>)
+		{
+			for (entt::entity entity : entities)
+			{
+				entt::entity localEntity = snapshot.RemapEntity(entity);
+				if (!registry.all_of<T>(localEntity))
+					registry.emplace<T>(localEntity);
+			}
+		}
+		else if constexpr (EnttSnapshotComponent<T>::BulkCopy)
+		{
+			if (!isBulkCopied)
+			{
+				NazaraError("component {0} was not bulk copied in the snapshot", componentId);
+				return false;
+			}
+
+			UInt32 componentSize;
+			if (!Unserialize(context, &componentSize))
+				return false;
+
+			if (componentSize != sizeof(T))
+			{
+				NazaraError("component {0} size changed ({1} in the snapshot, {2} expected)", componentId, componentSize, sizeof(T));
+				return false;
+			}
+
+			if (isSwapped && !entities.empty())
+			{
+				NazaraError("component {0} was saved with another endianness and cannot be bulk copied", componentId);
+				return false;
+			}
+
+			// Components are stored contiguously, read them all at once
+			std::vector<T> components(entities.size());
+			std::size_t byteSize = components.size() * sizeof(T);
+
+			context.ResetReadBitPosition();
+			if (context.stream->Read(components.data(), byteSize) != byteSize)
+				return false;
+
+			for (std::size_t i = 0; i < entities.size(); ++i)
+				registry.emplace_or_replace<T>(snapshot.RemapEntity(entities[i]), components[i]);
+		}
+		else
+		{
+			if (isBulkCopied)
+			{
+				NazaraError("component {0} was bulk copied in the snapshot", componentId);
+				return false;
+			}
+
+			for (entt::entity entity : entities)
+			{
+				T component;
+				if (!EnttSnapshotComponent<T>::Unserialize(context, &component))
+					return false;
+
+				registry.emplace_or_replace<T>(snapshot.RemapEntity(entity), std::move(component));
+			}
+		}
+
+		if (!snapshot.ReadEntities(context, entities, isSwapped))
+			return false;
+
+		for (entt::entity entity : entities)
+		{
+			entt::entity localEntity = snapshot.GetLoadedEntity(entity);
+			if (localEntity != entt::null && registry.valid(localEntity))
+				registry.remove<T>(localEntity);
+		}
+
+		return true;
+	}
+
+	template<typename T>
+	void EnttSnapshot::Component<T>::OnRemoved(entt::registry& /*registry*/, entt::entity entity)
+	{
+		if (!owner.m_isLoading)
+			removedEntities.push_back(entity);
+	}
+
+	template<typename T>
+	void EnttSnapshot::Component<T>::OnUpdated(entt::registry& /*registry*/, entt::entity entity)
+	{
+		if (!owner.m_isLoading)
+			updatedEntities.push_back(entity);
+	}
+
+	template<typename T>
+	void EnttSnapshot::Component<T>::RegisterDestroyedEntities(std::vector<entt::entity>& destroyedEntities)
+	{
+		entt::registry& registry = owner.m_registry;
+		for (entt::entity entity : removedEntities)
+		{
+			if (!registry.valid(entity))
+				destroyedEntities.push_back(entity);
+		}
+	}
+
+	template<typename T>
+	bool EnttSnapshot::Component<T>::Save(EnttSnapshot& snapshot, SerializationContext& context, bool changesOnly)
+	{
+		const auto& storage = snapshot.m_registry.storage<T>();
+		const entt::sparse_set& entitySet = storage;
+
+		std::vector<entt::entity>& entities = snapshot.m_entityBuffer;
+		if (changesOnly)
+		{
+			// Entities are registered on each change, and some may have lost the component since
+			entities = updatedEntities;
+			std::sort(entities.begin(), entities.end());
+			entities.erase(std::unique(entities.begin(), entities.end()), entities.end());
+			entities.erase(std::remove_if(entities.begin(), entities.end(), [&](entt::entity entity) { return !entitySet.contains(entity); }), entities.end());
+		}
+		else
+			entities.assign(entitySet.begin(), entitySet.end());
+
+		constexpr bool isBulkCopied = !std::is_empty_v<T> && EnttSnapshotComponent<T>::BulkCopy;
+
+		if (!Serialize(context, componentId))
+			return false;
+
+		if (!Serialize(context, isBulkCopied))
+			return false;
+
+		if (!snapshot.WriteEntities(context, entities))
+			return false;
+
+		if constexpr (isBulkCopied)
+		{
+			if (!Serialize(context, UInt32(sizeof(T))))
+				return false;
+
+			std::vector<UInt8>& data = snapshot.m_dataBuffer;
+			data.resize(entities.size() * sizeof(T));
+			for (std::size_t i = 0; i < entities.size(); ++i)
+				std::memcpy(&data[i * sizeof(T)], &storage.get(entities[i]), sizeof(T));
+
+			context.FlushBits();
+			if (context.stream->Write(data.data(), data.size()) != data.size())
+				return false;
+		}
+		else if constexpr (!std::is_empty_v<T>)
+		{
+			for (entt::entity entity : entities)
+			{
+				if (!EnttSnapshotComponent<T>::Serialize(context, storage.get(entity)))
+					return false;
+			}
+		}
+
+		entities.clear();
+		if (changesOnly)
+		{
+			// Destroyed entities are handled globally
+			entt::registry& registry = snapshot.m_registry;
+
+			entities = removedEntities;
+			std::sort(entities.begin(), entities.end());
+			entities.erase(std::unique(entities.begin(), entities.end()), entities.end());
+			entities.erase(std::remove_if(entities.begin(), entities.end(), [&](entt::entity entity) { return entitySet.contains(entity) || !registry.valid(entity); }), entities.end());
+		}
+
+		return snapshot.WriteEntities(context, entities);
+	}
+
+	/*!
+	* \brief Returns the entity which was created (or reused) for an entity of the snapshots loaded since last full snapshot
+	* \return Local entity or entt::null if the snapshot entity is unknown
+	*
+	* This can be used to fix entity references stored in components.
+	*
+	* \param snapshotEntity Entity as stored in the snapshot
+	*/
+	inline entt::entity EnttSnapshot::GetLoadedEntity(entt::entity snapshotEntity) const
+	{
+		auto it = m_entityRemapping.find(snapshotEntity);
+		if (it == m_entityRemapping.end())
+			return entt::null;
+
+		return it->second;
+	}
+
+	/*!
+	* \brief Marks a component as updated for the next incremental snapshot
+	*
+	* Components are tracked through registry signals (emplace, patch, replace), this has to be called for components modified in place.
+	*
+	* \param entity Entity owning the component
+	*/
+	template<typename T>
+	void EnttSnapshot::MarkUpdated(entt::entity entity)
+	{
+		auto it = m_componentIndices.find(entt::type_hash<T>::value());
+		NazaraAssert(it != m_componentIndices.end(), "component is not registered");
+
+		m_components[it->second]->updatedEntities.push_back(entity);
+	}
+
+	/*!
+	* \brief Registers a component to be stored in snapshots
+	*
+	* Components are stored using EnttSnapshotComponent, which relies on Serialize/Unserialize unless they can be bulk copied.
+	*
+	* \param componentId Identifier of the component in snapshots, must be the same when saving and loading
+	*/
+	template<typename T>
+	void EnttSnapshot::RegisterComponent(UInt32 componentId)
+	{
+		NazaraAssert(m_componentIndices.find(entt::type_hash<T>::value()) == m_componentIndices.end(), "component is already registered");
+		NazaraAssert(std::none_of(m_components.begin(), m_components.end(), [&](const std::unique_ptr<ComponentBase>& component) { return component->componentId == componentId; }), "component id is already used");
+
+		auto component = std::make_unique<Component<T>>(*this);
+		component->componentId = componentId;
+
+		m_componentIndices.emplace(entt::type_hash<T>::value(), m_components.size());
+		m_components.push_back(std::move(component));
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
@@ -10,9 +10,15 @@
 #include <NazaraUtils/Prerequisites.hpp>
 #include <Nazara/Core/Clock.hpp>
 #include <Nazara/Core/Config.hpp>
+#include <Nazara/Core/Profiler.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Core/TimingStats.hpp>
 #include <NazaraUtils/MovablePtr.hpp>
+#include <NazaraUtils/Signal.hpp>
+#include <NazaraUtils/TypeList.hpp>
 #include <entt/entt.hpp>
 #include <functional>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -21,6 +27,8 @@ namespace Nz
 	class NAZARA_CORE_API EnttSystemGraph
 	{
 		public:
+			struct FixedStepInfo;
+
 			inline EnttSystemGraph(entt::registry& registry);
 			EnttSystemGraph(const EnttSystemGraph&) = delete;
 			EnttSystemGraph(EnttSystemGraph&&) = delete;
@@ -28,24 +36,66 @@ namespace Nz
 
 			template<typename T, typename... Args> T& AddSystem(Args&&... args);
 
+			template<typename F> void ForEachSystemTimingStats(F&& callback) const;
+
+			inline const FixedStepInfo& GetFixedStepInfo() const;
+			inline Time GetFixedTimestep() const;
+			inline std::size_t GetMaxFixedStepCount() const;
 			template<typename T> T& GetSystem() const;
+			template<typename T> TimingStats& GetSystemTimingStats();
+			template<typename T> const TimingStats& GetSystemTimingStats() const;
+
+			bool HasMainThreadSystems() const;
+
+			inline bool IsConcurrentUpdateEnabled() const;
+			inline bool IsTimingStatsEnabled() const;
+
+			void LogTimingStats() const;
 
 			template<typename T> void RemoveSystem();
 
+			void ResetTimingStats();
+
+			inline void EnableConcurrentUpdate(bool enable);
+			inline void EnableTimingStats(bool enable);
+
+			inline void SetFixedTimestep(Time timestep);
+			inline void SetMaxFixedStepCount(std::size_t maxStepCount);
+
 			void Update();
 			void Update(Time elapsedTime);
 
 			EnttSystemGraph& operator=(const EnttSystemGraph&) = delete;
 			EnttSystemGraph& operator=(EnttSystemGraph&&) = delete;
 
+			NazaraSignal(OnTimingBudgetExceeded, EnttSystemGraph* /*systemGraph*/, std::string_view /*systemName*/, const TimingStats& /*stats*/);
+
+			struct FixedStepInfo
+			{
+				Time timestep = Time::Zero(); //< zero if fixed steps are disabled
+				UInt64 stepIndex = 0; //< number of fixed steps run so far
+				float alpha = 1.f; //< progress toward the next fixed step, in [0, 1), to interpolate between the two last states
+			};
+
 		private:
 			struct NAZARA_CORE_API NodeBase
 			{
 				virtual ~NodeBase();
 
-				virtual void Update(Time elapsedTime) = 0;
+				bool ConflictsWith(const NodeBase& node) const;
+
+				virtual void Update(Time elapsedTime, const FixedStepInfo& fixedStepInfo) = 0;
 
+				std::vector<entt::id_type> readComponents;
+				std::vector<entt::id_type> writeComponents;
+				std::vector<std::size_t> dependencies; //< indices of the ordered nodes which must run before this one
+				std::string_view name;
+				TimingStats timingStats;
 				Int64 executionOrder;
+				bool accessAllComponents;
+				bool allowConcurrent;
+				bool fixedUpdate;
+				bool runOnMainThread;
 			};
 
 			template<typename T>
@@ -53,17 +103,37 @@ namespace Nz
 			{
 				template<typename... Args> Node(Args&&... args);
 
-				void Update(Time elapsedTime) override;
+				void Update(Time elapsedTime, const FixedStepInfo& fixedStepInfo) override;
 
 				T system;
 			};
 
+			struct Schedule
+			{
+				std::vector<NodeBase*> orderedNodes;
+				bool hasConcurrentNodes = false;
+			};
+
+			void BuildSchedule(Schedule& schedule);
+			void RunSchedule(const Schedule& schedule, Time elapsedTime);
+			void UpdateConcurrently(const Schedule& schedule, Time elapsedTime);
+			void UpdateNode(NodeBase& node, Time elapsedTime);
+
 			std::unordered_map<entt::id_type, std::size_t /*nodeIndex*/> m_systemToNodes;
-			std::vector<NodeBase*> m_orderedNodes;
 			std::vector<std::unique_ptr<NodeBase>> m_nodes;
+			std::vector<TaskScheduler::TaskHandle> m_dependencyHandles;
+			std::vector<TaskScheduler::TaskHandle> m_nodeTasks;
 			entt::registry& m_registry;
+			FixedStepInfo m_fixedStepInfo;
 			Nz::HighPrecisionClock m_clock;
+			Schedule m_fixedSchedule;
+			Schedule m_variableSchedule;
+			std::size_t m_maxFixedStepCount;
+			Time m_fixedStepAccumulator;
+			Time m_fixedTimestep;
+			bool m_concurrentUpdateEnabled;
 			bool m_systemOrderUpdated;
+			bool m_timingStatsEnabled;
 	};
 }
 
@@ -21,6 +21,62 @@ namespace Nz
 
 		template<typename T>
 		struct EnttSystemGraphExecutionOrder<T, std::void_t<decltype(T::ExecutionOrder)>> : std::integral_constant<Int64, T::ExecutionOrder> {};
+
+		template<typename, typename = void>
+		struct EnttSystemGraphFixedUpdate : std::bool_constant<false> {};
+
+		template<typename T>
+		struct EnttSystemGraphFixedUpdate<T, std::void_t<decltype(T::FixedUpdate)>> : std::bool_constant<T::FixedUpdate> {};
+
+		template<typename, typename = void>
+		struct EnttSystemGraphRunOnMainThread : std::bool_constant<false> {};
+
+		template<typename T>
+		struct EnttSystemGraphRunOnMainThread<T, std::void_t<decltype(T::RunOnMainThread)>> : std::bool_constant<T::RunOnMainThread> {};
+
+		template<typename T, typename = void>
+		struct EnttSystemGraphTakesFixedStepInfo : std::false_type {};
+
+		template<typename T>
+		struct EnttSystemGraphTakesFixedStepInfo<T, std::void_t<decltype(std::declval<T&>().Update(std::declval<Time>(), std::declval<const EnttSystemGraph::FixedStepInfo&>()))>> : std::true_type {};
+
+		template<typename, typename = void>
+		struct EnttSystemGraphComponents
+		{
+			static constexpr bool IsDeclared = false;
+			using Type = TypeList<>;
+		};
+
+		template<typename T>
+		struct EnttSystemGraphComponents<T, std::void_t<typename T::Components>>
+		{
+			static constexpr bool IsDeclared = true;
+			using Type = typename T::Components;
+		};
+
+		template<typename, typename = void>
+		struct EnttSystemGraphReadOnlyComponents
+		{
+			using Type = TypeList<>;
+		};
+
+		template<typename T>
+		struct EnttSystemGraphReadOnlyComponents<T, std::void_t<typename T::ReadOnlyComponents>>
+		{
+			using Type = typename T::ReadOnlyComponents;
+		};
+
+		template<typename>
+		struct EnttSystemGraphComponentIds;
+
+		template<typename... Components>
+		struct EnttSystemGraphComponentIds<TypeList<Components...>>
+		{
+			static std::vector<entt::id_type> Get()
+			{
+				return { entt::type_hash<Components>::value()... };
+			}
+		};
 	}
 
 	template<typename T>
@@ -31,14 +87,27 @@ namespace Nz
 	}
 
 	template<typename T>
-	void EnttSystemGraph::Node<T>::Update(Time elapsedTime)
+	void EnttSystemGraph::Node<T>::Update(Time elapsedTime, [[maybe_unused]] const FixedStepInfo& fixedStepInfo)
 	{
-		system.Update(elapsedTime);
+#if NAZARA_CORE_ENABLE_PROFILING
+		static const char* zoneName = Profiler::InternName(entt::type_name<T>::value());
+		NazaraProfileScope(zoneName);
+#endif
+
+		if constexpr (Detail::EnttSystemGraphTakesFixedStepInfo<T>::value)
+			system.Update(elapsedTime, fixedStepInfo);
+		else
+			system.Update(elapsedTime);
 	}
 
 	inline EnttSystemGraph::EnttSystemGraph(entt::registry& registry) :
 	m_registry(registry),
-	m_systemOrderUpdated(true)
+	m_maxFixedStepCount(5),
+	m_fixedStepAccumulator(Time::Zero()),
+	m_fixedTimestep(Time::Zero()),
+	m_concurrentUpdateEnabled(true),
+	m_systemOrderUpdated(true),
+	m_timingStatsEnabled(true)
 	{
 	}
 
@@ -49,6 +118,15 @@ namespace Nz
 
 		auto nodePtr = std::make_unique<Node<T>>(m_registry, std::forward<Args>(args)...);
 		nodePtr->executionOrder = Detail::EnttSystemGraphExecutionOrder<T>();
+		nodePtr->name = entt::type_name<T>::value();
+		nodePtr->allowConcurrent = Detail::EnttSystemGraphAllowConcurrent<T>();
+		nodePtr->fixedUpdate = Detail::EnttSystemGraphFixedUpdate<T>();
+		nodePtr->runOnMainThread = Detail::EnttSystemGraphRunOnMainThread<T>();
+
+		// Systems which don't declare the components they use are considered to access every component
+		nodePtr->accessAllComponents = !Detail::EnttSystemGraphComponents<T>::IsDeclared;
+		nodePtr->readComponents = Detail::EnttSystemGraphComponentIds<typename Detail::EnttSystemGraphReadOnlyComponents<T>::Type>::Get();
+		nodePtr->writeComponents = Detail::EnttSystemGraphComponentIds<typename Detail::EnttSystemGraphComponents<T>::Type>::Get();
 
 		T& system = nodePtr->system;
 
@@ -61,6 +139,38 @@ namespace Nz
 		return system;
 	}
 
+	/*!
+	* \brief Calls a callback with the timing statistics of every system
+	*
+	* \param callback Callback taking the name of the system (as a std::string_view) and its statistics (as a const TimingStats&)
+	*/
+	template<typename F>
+	void EnttSystemGraph::ForEachSystemTimingStats(F&& callback) const
+	{
+		for (const auto& nodePtr : m_nodes)
+			callback(nodePtr->name, nodePtr->timingStats);
+	}
+
+	/*!
+	* \brief Returns informations about the fixed steps of the last update
+	*
+	* Systems can also receive them by taking them as a second Update parameter.
+	*/
+	inline auto EnttSystemGraph::GetFixedStepInfo() const -> const FixedStepInfo&
+	{
+		return m_fixedStepInfo;
+	}
+
+	inline Time EnttSystemGraph::GetFixedTimestep() const
+	{
+		return m_fixedTimestep;
+	}
+
+	inline std::size_t EnttSystemGraph::GetMaxFixedStepCount() const
+	{
+		return m_maxFixedStepCount;
+	}
+
 	template<typename T>
 	T& EnttSystemGraph::GetSystem() const
 	{
@@ -72,6 +182,42 @@ namespace Nz
 		return node.system;
 	}
 
+	/*!
+	* \brief Returns the timing statistics of a system update
+	*
+	* Fixed systems add a sample for each fixed step.
+	* The non-const overload allows to set a budget (see TimingStats::SetBudget), triggering OnTimingBudgetExceeded when an update exceeds it.
+	*/
+	template<typename T>
+	TimingStats& EnttSystemGraph::GetSystemTimingStats()
+	{
+		auto it = m_systemToNodes.find(entt::type_hash<T>());
+		if (it == m_systemToNodes.end())
+			throw std::runtime_error("this system is not part of the graph");
+
+		return m_nodes[it->second]->timingStats;
+	}
+
+	template<typename T>
+	const TimingStats& EnttSystemGraph::GetSystemTimingStats() const
+	{
+		auto it = m_systemToNodes.find(entt::type_hash<T>());
+		if (it == m_systemToNodes.end())
+			throw std::runtime_error("this system is not part of the graph");
+
+		return m_nodes[it->second]->timingStats;
+	}
+
+	inline bool EnttSystemGraph::IsConcurrentUpdateEnabled() const
+	{
+		return m_concurrentUpdateEnabled;
+	}
+
+	inline bool EnttSystemGraph::IsTimingStatsEnabled() const
+	{
+		return m_timingStatsEnabled;
+	}
+
 	template<typename T>
 	void EnttSystemGraph::RemoveSystem()
 	{
@@ -79,10 +225,65 @@ namespace Nz
 		if (it == m_systemToNodes.end())
 			return;
 
-		m_nodes.erase(m_nodes.begin() + it->second);
+		std::size_t nodeIndex = it->second;
+		m_nodes.erase(m_nodes.begin() + nodeIndex);
 		m_systemToNodes.erase(it);
+
+		for (auto&& [systemId, index] : m_systemToNodes)
+		{
+			if (index > nodeIndex)
+				index--;
+		}
+
 		m_systemOrderUpdated = false;
 	}
+
+	/*!
+	* \brief Enables or disables running independent systems concurrently on the engine task scheduler
+	*
+	* Concurrent update is enabled by default, disabling it runs every system in order on the calling thread.
+	*/
+	inline void EnttSystemGraph::EnableConcurrentUpdate(bool enable)
+	{
+		m_concurrentUpdateEnabled = enable;
+	}
+
+	/*!
+	* \brief Enables or disables measuring the duration of each system update
+	*
+	* Timing statistics are enabled by default, they only cost two clock reads per system update.
+	*/
+	inline void EnttSystemGraph::EnableTimingStats(bool enable)
+	{
+		m_timingStatsEnabled = enable;
+	}
+
+	/*!
+	* \brief Runs systems declaring FixedUpdate at a fixed rate
+	*
+	* Time is accumulated over updates, and fixed systems are run as many times as the timestep fits in it (before other systems), always with the timestep as elapsed time.
+	* The remaining time is exposed as an interpolation factor (see FixedStepInfo).
+	*
+	* \param timestep Fixed timestep, zero (the default) to run fixed systems once per update with the elapsed time like other systems
+	*/
+	inline void EnttSystemGraph::SetFixedTimestep(Time timestep)
+	{
+		NazaraAssert(timestep >= Time::Zero(), "timestep must be positive");
+
+		m_fixedTimestep = timestep;
+		m_fixedStepAccumulator = Time::Zero();
+	}
+
+	/*!
+	* \brief Sets the maximum number of fixed steps run by a single update
+	*
+	* If the fixed systems can't keep up, the time that couldn't be simulated is dropped instead of accumulating.
+	*/
+	inline void EnttSystemGraph::SetMaxFixedStepCount(std::size_t maxStepCount)
+	{
+		NazaraAssert(maxStepCount > 0, "max step count must be non-zero");
+		m_maxFixedStepCount = maxStepCount;
+	}
 }
 
 #include <Nazara/Core/DebugOff.hpp>
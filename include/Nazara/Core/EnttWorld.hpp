@@ -31,6 +31,8 @@ namespace Nz
 			const entt::registry& GetRegistry() const;
 			template<typename T> T& GetSystem() const;
 
+			bool IsMainThreadOnly() const override;
+
 			template<typename T> void RemoveSystem();
 
 			void Update(Time elapsedTime) override;
@@ -11,6 +11,25 @@
 
 namespace Nz
 {
+	// Values are stored in packed archives, don't reorder them
+	enum class ArchiveCompression
+	{
+		None = 0,
+		LZ4  = 1,
+		Zstd = 2,
+
+		Max = Zstd
+	};
+
+	enum class BinPackAlgorithm
+	{
+		Guillotine, //< general purpose, supports freeing rectangles well
+		MaxRects,   //< best fill rate but slowest insertions, suited to offline packing
+		Skyline,    //< fastest insertions with a good fill rate for rectangles of similar heights (e.g. glyphs)
+
+		Max = Skyline
+	};
+
 	enum class CoordSys
 	{
 		Global,
@@ -58,6 +77,24 @@ namespace Nz
 
 	constexpr std::size_t ErrorTypeCount = static_cast<std::size_t>(ErrorType::Max) + 1;
 
+	enum class FileAccessPattern
+	{
+		Normal,     //< No particular access pattern, default system read-ahead
+		Random,     //< Data is accessed in a random order, read-ahead is reduced
+		Sequential, //< Data is read once from start to end, read-ahead is increased and pages can be freed after being read
+
+		Max = Sequential
+	};
+
+	enum class FileReadPriority
+	{
+		High,   // reads blocking the application (e.g. a resource waited on)
+		Normal,
+		Low,    // speculative reads (e.g. prefetching or streaming finer levels)
+
+		Max = Low
+	};
+
 	enum class ImageType
 	{
 		E1D,
@@ -84,12 +121,30 @@ namespace Nz
 		SHA384,
 		SHA512,
 		Whirlpool,
+		XXH64,
 
-		Max = Whirlpool
+		Max = XXH64
 	};
 
 	constexpr std::size_t HashTypeCount = static_cast<std::size_t>(HashType::Max) + 1;
 
+	enum class MemoryTag
+	{
+		Audio,
+		Core,
+		Fonts,
+		Graphics,
+		Network,
+		Physics,
+		Renderer,
+		Utility,
+		Widgets,
+
+		Max = Widgets
+	};
+
+	constexpr std::size_t MemoryTagCount = static_cast<std::size_t>(MemoryTag::Max) + 1;
+
 	enum class OpenMode
 	{
 		NotOpen,    //< File is not open
@@ -151,8 +206,10 @@ namespace Nz
 		FMA3,
 		FMA4,
 		MMX,
+		PCLMULQDQ,
 		Popcnt,
 		RDRAND,
+		SHA,
 		XOP,
 		SSE,
 		SSE2,
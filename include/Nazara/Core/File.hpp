@@ -48,6 +48,8 @@ namespace Nz
 			bool Open(OpenModeFlags openMode = OpenMode::NotOpen);
 			bool Open(const std::filesystem::path& filePath, OpenModeFlags openMode = OpenMode::NotOpen);
 
+			std::size_t ReadAt(UInt64 offset, void* buffer, std::size_t size) const;
+
 			bool SetFile(const std::filesystem::path& filePath);
 			bool SetSize(UInt64 size);
 
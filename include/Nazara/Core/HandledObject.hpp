@@ -11,6 +11,7 @@
 #include <Nazara/Core/Error.hpp>
 #include <NazaraUtils/Bitset.hpp>
 #include <NazaraUtils/Signal.hpp>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -18,11 +19,28 @@ namespace Nz
 {
 	namespace Detail
 	{
-		struct NAZARA_CORE_API HandleData
+		struct HandleSlot
 		{
 			void* object;
+			UInt32 generation;
+		};
+
+		class NAZARA_CORE_API HandleSlotTable
+		{
+			public:
+				HandleSlotTable() = delete;
+
+				static UInt32 Allocate(void* object);
+				static void Free(UInt32 slotIndex);
 
-			static std::shared_ptr<HandleData> GetEmptyObject();
+				static inline HandleSlot& GetSlot(UInt32 slotIndex);
+
+				static constexpr UInt32 ChunkSize = 4096;
+				static constexpr UInt32 MaxChunkCount = 4096;
+				static constexpr UInt32 InvalidSlot = std::numeric_limits<UInt32>::max();
+
+			private:
+				static HandleSlot* s_chunks[MaxChunkCount];
 		};
 	}
 
@@ -42,7 +60,7 @@ namespace Nz
 			template<typename U = T>
 			ObjectHandle<U> CreateHandle();
 
-			std::shared_ptr<const Detail::HandleData> GetHandleData();
+			UInt32 GetHandleSlot();
 
 			HandledObject& operator=(const HandledObject& object);
 			HandledObject& operator=(HandledObject&& object) noexcept;
@@ -53,9 +71,7 @@ namespace Nz
 			void UnregisterAllHandles() noexcept;
 
 		private:
-			void InitHandleData();
-
-			std::shared_ptr<Detail::HandleData> m_handleData;
+			UInt32 m_handleSlot = Detail::HandleSlotTable::InvalidSlot;
 	};
 }
 
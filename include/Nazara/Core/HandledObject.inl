@@ -11,6 +11,23 @@
 
 namespace Nz
 {
+	namespace Detail
+	{
+		/*!
+		* \brief Gets a slot of the handle slot table
+		* \return Slot, which may have been freed (and reused) since the handle was created
+		*
+		* \param slotIndex Index of the slot, as returned by Allocate
+		*/
+		inline HandleSlot& HandleSlotTable::GetSlot(UInt32 slotIndex)
+		{
+			assert(slotIndex != InvalidSlot);
+			assert(s_chunks[slotIndex / ChunkSize]);
+
+			return s_chunks[slotIndex / ChunkSize][slotIndex % ChunkSize];
+		}
+	}
+
 	/*!
 	* \ingroup core
 	* \class Nz::HandledObject<T>
@@ -36,10 +53,10 @@ namespace Nz
 	*/
 	template<typename T>
 	HandledObject<T>::HandledObject(HandledObject&& object) noexcept :
-	m_handleData(std::move(object.m_handleData))
+	m_handleSlot(std::exchange(object.m_handleSlot, Detail::HandleSlotTable::InvalidSlot))
 	{
-		if (m_handleData)
-			m_handleData->object = static_cast<T*>(this);
+		if (m_handleSlot != Detail::HandleSlotTable::InvalidSlot)
+			Detail::HandleSlotTable::GetSlot(m_handleSlot).object = static_cast<T*>(this);
 	}
 
 	/*!
@@ -65,13 +82,17 @@ namespace Nz
 		return ObjectHandle<U>(static_cast<U*>(this));
 	}
 
+	/*!
+	* \brief Gets the index of the handle slot of this object, allocating it on first call
+	* \return Slot index, or HandleSlotTable::InvalidSlot if the slot table is full
+	*/
 	template<typename T>
-	std::shared_ptr<const Detail::HandleData> HandledObject<T>::GetHandleData()
+	UInt32 HandledObject<T>::GetHandleSlot()
 	{
-		if (!m_handleData)
-			InitHandleData();
+		if (m_handleSlot == Detail::HandleSlotTable::InvalidSlot)
+			m_handleSlot = Detail::HandleSlotTable::Allocate(static_cast<T*>(this));
 
-		return std::shared_ptr<const Detail::HandleData>(m_handleData);
+		return m_handleSlot;
 	}
 
 	/*!
@@ -100,10 +121,10 @@ namespace Nz
 	{
 		UnregisterAllHandles();
 
-		m_handleData = std::move(object.m_handleData);
+		m_handleSlot = std::exchange(object.m_handleSlot, Detail::HandleSlotTable::InvalidSlot);
 
-		if (m_handleData)
-			m_handleData->object = static_cast<T*>(this);
+		if (m_handleSlot != Detail::HandleSlotTable::InvalidSlot)
+			Detail::HandleSlotTable::GetSlot(m_handleSlot).object = static_cast<T*>(this);
 
 		return *this;
 	}
@@ -114,23 +135,15 @@ namespace Nz
 	template<typename T>
 	void HandledObject<T>::UnregisterAllHandles() noexcept
 	{
-		if (m_handleData)
+		if (m_handleSlot != Detail::HandleSlotTable::InvalidSlot)
 		{
 			OnHandledObjectDestruction(this);
 
-			m_handleData->object = nullptr;
-			m_handleData.reset();
+			// Freeing the slot bumps its generation, invalidating every handle to it
+			Detail::HandleSlotTable::Free(m_handleSlot);
+			m_handleSlot = Detail::HandleSlotTable::InvalidSlot;
 		}
 	}
-
-	template<typename T>
-	void HandledObject<T>::InitHandleData()
-	{
-		assert(!m_handleData);
-
-		m_handleData = std::make_shared<Detail::HandleData>();
-		m_handleData->object = static_cast<T*>(this);
-	}
 }
 
 #include <Nazara/Core/DebugOff.hpp>
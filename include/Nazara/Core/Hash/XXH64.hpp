@@ -0,0 +1,39 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_CORE_HASH_XXH64_HPP
+#define NAZARA_CORE_HASH_XXH64_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/AbstractHash.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <array>
+
+namespace Nz
+{
+	class NAZARA_CORE_API XXH64Hasher final : public AbstractHash
+	{
+		public:
+			XXH64Hasher(UInt64 seed = 0);
+			~XXH64Hasher() = default;
+
+			void Append(const UInt8* data, std::size_t len) override;
+			void Begin() override;
+			ByteArray End() override;
+
+			std::size_t GetDigestLength() const override;
+			const char* GetHashName() const override;
+
+		private:
+			std::array<UInt64, 4> m_accumulators;
+			std::array<UInt8, 32> m_buffer;
+			std::size_t m_bufferSize;
+			UInt64 m_seed;
+			UInt64 m_totalLength;
+	};
+}
+
+#endif // NAZARA_CORE_HASH_XXH64_HPP
@@ -0,0 +1,87 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_CORE_LINEARALLOCATOR_HPP
+#define NAZARA_CORE_LINEARALLOCATOR_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/Config.hpp>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_CORE_API LinearAllocator
+	{
+		public:
+			explicit LinearAllocator(std::size_t blockSize = DefaultBlockSize);
+			LinearAllocator(const LinearAllocator&) = delete;
+			LinearAllocator(LinearAllocator&&) noexcept = default;
+			~LinearAllocator() = default;
+
+			inline void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+			template<typename T> T* AllocateArray(std::size_t count);
+
+			inline std::size_t GetAllocatedSize() const;
+			inline std::size_t GetBlockSize() const;
+			std::size_t GetCapacity() const;
+
+			void Reset();
+
+			LinearAllocator& operator=(const LinearAllocator&) = delete;
+			LinearAllocator& operator=(LinearAllocator&&) noexcept = default;
+
+			static constexpr std::size_t DefaultBlockSize = 64 * 1024;
+
+		private:
+			void* AllocateFromNextBlock(std::size_t size, std::size_t alignment);
+			inline void* AllocateFromCurrentBlock(std::size_t size, std::size_t alignment);
+
+			struct Block
+			{
+				std::unique_ptr<UInt8[]> memory;
+				std::size_t size;
+			};
+
+			std::vector<Block> m_blocks;
+			std::size_t m_allocatedSize;
+			std::size_t m_blockSize;
+			std::size_t m_currentBlock;
+			std::size_t m_currentOffset;
+	};
+
+	template<typename T>
+	class LinearStlAllocator
+	{
+		template<typename U> friend class LinearStlAllocator;
+
+		public:
+			using value_type = T;
+
+			inline LinearStlAllocator(LinearAllocator& allocator) noexcept;
+			template<typename U> LinearStlAllocator(const LinearStlAllocator<U>& allocator) noexcept;
+			LinearStlAllocator(const LinearStlAllocator&) noexcept = default;
+			~LinearStlAllocator() = default;
+
+			T* allocate(std::size_t count);
+			void deallocate(T* ptr, std::size_t count) noexcept;
+
+			inline LinearAllocator& GetAllocator() const;
+
+			LinearStlAllocator& operator=(const LinearStlAllocator&) noexcept = default;
+
+			template<typename U> bool operator==(const LinearStlAllocator<U>& allocator) const noexcept;
+			template<typename U> bool operator!=(const LinearStlAllocator<U>& allocator) const noexcept;
+
+		private:
+			LinearAllocator* m_allocator;
+	};
+}
+
+#include <Nazara/Core/LinearAllocator.inl>
+
+#endif // NAZARA_CORE_LINEARALLOCATOR_HPP
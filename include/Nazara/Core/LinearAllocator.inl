@@ -0,0 +1,136 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <NazaraUtils/Algorithm.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Allocates memory from the arena
+	* \return Pointer to size bytes aligned to alignment, valid until the next Reset
+	*
+	* \param size Size of the allocation
+	* \param alignment Alignment of the allocation, must be a power of two
+	*
+	* \remark This never returns a null pointer, a new block is allocated if the current one is full
+	*/
+	inline void* LinearAllocator::Allocate(std::size_t size, std::size_t alignment)
+	{
+		NazaraAssert(alignment > 0 && (alignment & (alignment - 1)) == 0, "alignment must be a power of two");
+
+		if (void* ptr = AllocateFromCurrentBlock(size, alignment))
+			return ptr;
+
+		return AllocateFromNextBlock(size, alignment);
+	}
+
+	/*!
+	* \brief Allocates uninitialized memory for count objects of type T
+	* \return Pointer to the first object, valid until the next Reset
+	*
+	* \param count Number of objects
+	*
+	* \remark Objects are neither constructed nor destroyed, it's up to the caller to do so (destructors won't be called by Reset)
+	*/
+	template<typename T>
+	T* LinearAllocator::AllocateArray(std::size_t count)
+	{
+		NazaraAssert(count <= std::numeric_limits<std::size_t>::max() / sizeof(T), "allocation size overflow");
+
+		return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+	}
+
+	/*!
+	* \brief Returns the number of bytes allocated since the last reset (not counting alignment padding)
+	*/
+	inline std::size_t LinearAllocator::GetAllocatedSize() const
+	{
+		return m_allocatedSize;
+	}
+
+	inline std::size_t LinearAllocator::GetBlockSize() const
+	{
+		return m_blockSize;
+	}
+
+	inline void* LinearAllocator::AllocateFromCurrentBlock(std::size_t size, std::size_t alignment)
+	{
+		if (m_currentBlock >= m_blocks.size())
+			return nullptr;
+
+		Block& block = m_blocks[m_currentBlock];
+
+		// Align the address itself, the block memory may be less aligned than requested
+		std::uintptr_t blockAddress = reinterpret_cast<std::uintptr_t>(block.memory.get());
+		std::size_t offset = static_cast<std::size_t>(Align(blockAddress + m_currentOffset, static_cast<std::uintptr_t>(alignment)) - blockAddress);
+		if (offset > block.size || block.size - offset < size)
+			return nullptr;
+
+		m_currentOffset = offset + size;
+		m_allocatedSize += size;
+
+		return block.memory.get() + offset;
+	}
+
+
+	/*!
+	* \ingroup core
+	* \class Nz::LinearStlAllocator
+	* \brief Core class allowing standard containers to allocate from a LinearAllocator
+	*
+	* Deallocation does nothing, memory is reclaimed when the LinearAllocator is reset and containers using it must not outlive that.
+	*/
+
+	template<typename T>
+	LinearStlAllocator<T>::LinearStlAllocator(LinearAllocator& allocator) noexcept :
+	m_allocator(&allocator)
+	{
+	}
+
+	template<typename T>
+	template<typename U>
+	LinearStlAllocator<T>::LinearStlAllocator(const LinearStlAllocator<U>& allocator) noexcept :
+	m_allocator(allocator.m_allocator)
+	{
+	}
+
+	template<typename T>
+	T* LinearStlAllocator<T>::allocate(std::size_t count)
+	{
+		return m_allocator->AllocateArray<T>(count);
+	}
+
+	template<typename T>
+	void LinearStlAllocator<T>::deallocate(T* /*ptr*/, std::size_t /*count*/) noexcept
+	{
+		/* nothing to do, memory is reclaimed on reset */
+	}
+
+	template<typename T>
+	LinearAllocator& LinearStlAllocator<T>::GetAllocator() const
+	{
+		return *m_allocator;
+	}
+
+	template<typename T>
+	template<typename U>
+	bool LinearStlAllocator<T>::operator==(const LinearStlAllocator<U>& allocator) const noexcept
+	{
+		return m_allocator == allocator.m_allocator;
+	}
+
+	template<typename T>
+	template<typename U>
+	bool LinearStlAllocator<T>::operator!=(const LinearStlAllocator<U>& allocator) const noexcept
+	{
+		return !operator==(allocator);
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
@@ -0,0 +1,61 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_CORE_MAPPEDFILE_HPP
+#define NAZARA_CORE_MAPPEDFILE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/Stream.hpp>
+#include <filesystem>
+#include <memory>
+
+namespace Nz
+{
+	class MappedFileImpl;
+
+	class NAZARA_CORE_API MappedFile : public Stream
+	{
+		public:
+			MappedFile();
+			MappedFile(const std::filesystem::path& filePath, FileAccessPattern accessPattern = FileAccessPattern::Sequential);
+			MappedFile(const MappedFile&) = delete;
+			MappedFile(MappedFile&& file) noexcept;
+			~MappedFile();
+
+			void Close();
+
+			const void* GetData() const;
+			std::filesystem::path GetDirectory() const override;
+			std::filesystem::path GetPath() const override;
+			UInt64 GetSize() const override;
+
+			bool IsOpen() const;
+
+			bool Open(const std::filesystem::path& filePath, FileAccessPattern accessPattern = FileAccessPattern::Sequential);
+
+			void Prefetch(UInt64 offset, UInt64 size);
+
+			void SetAccessPattern(FileAccessPattern accessPattern);
+
+			MappedFile& operator=(const MappedFile&) = delete;
+			MappedFile& operator=(MappedFile&& file) noexcept;
+
+		private:
+			void FlushStream() override;
+			void* GetMemoryMappedPointer() const override;
+			std::size_t ReadBlock(void* buffer, std::size_t size) override;
+			bool SeekStreamCursor(UInt64 offset) override;
+			UInt64 TellStreamCursor() const override;
+			bool TestStreamEnd() const override;
+			std::size_t WriteBlock(const void* buffer, std::size_t size) override;
+
+			std::filesystem::path m_filePath;
+			std::unique_ptr<MappedFileImpl> m_impl;
+			UInt64 m_pos;
+	};
+}
+
+#endif // NAZARA_CORE_MAPPEDFILE_HPP
@@ -0,0 +1,76 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+// Based on the public domain work of Jukka Jylänki
+// http://clb.demon.fi/projects/even-more-rectangle-bin-packing
+
+#pragma once
+
+#ifndef NAZARA_CORE_MAXRECTSBINPACK_HPP
+#define NAZARA_CORE_MAXRECTSBINPACK_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/Config.hpp>
+#include <Nazara/Math/Rect.hpp>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_CORE_API MaxRectsBinPack
+	{
+		public:
+			enum class Heuristic
+			{
+				BestAreaFit,
+				BestLongSideFit,
+				BestShortSideFit,
+				BottomLeft
+			};
+
+			MaxRectsBinPack();
+			MaxRectsBinPack(unsigned int width, unsigned int height);
+			MaxRectsBinPack(const Vector2ui& size);
+			MaxRectsBinPack(const MaxRectsBinPack&) = default;
+			MaxRectsBinPack(MaxRectsBinPack&&) noexcept = default;
+			~MaxRectsBinPack() = default;
+
+			void Clear();
+
+			void Expand(unsigned int newWidth, unsigned newHeight);
+			void Expand(const Vector2ui& newSize);
+
+			void FreeRectangle(const Rectui& rect);
+
+			inline std::size_t GetFreeRectangleCount() const;
+			unsigned int GetHeight() const;
+			float GetOccupancy() const;
+			Vector2ui GetSize() const;
+			unsigned int GetWidth() const;
+
+			bool Insert(Rectui* rects, unsigned int count, Heuristic heuristic = Heuristic::BestShortSideFit);
+			bool Insert(Rectui* rects, bool* flipped, unsigned int count, Heuristic heuristic = Heuristic::BestShortSideFit);
+			bool Insert(Rectui* rects, bool* flipped, bool* inserted, unsigned int count, Heuristic heuristic = Heuristic::BestShortSideFit);
+
+			void Reset();
+			void Reset(unsigned int width, unsigned int height);
+			void Reset(const Vector2ui& size);
+
+			MaxRectsBinPack& operator=(const MaxRectsBinPack&) = default;
+			MaxRectsBinPack& operator=(MaxRectsBinPack&&) noexcept = default;
+
+		private:
+			void PlaceRectangle(const Rectui& rect);
+			void PruneFreeRectangles(std::size_t firstNewRect);
+			bool ScoreRectangle(unsigned int width, unsigned int height, Heuristic heuristic, std::size_t* freeRectIndex, Int64* primaryScore, Int64* secondaryScore) const;
+
+			std::vector<Rectui> m_freeRectangles;
+			UInt64 m_usedArea;
+			unsigned int m_height;
+			unsigned int m_width;
+	};
+}
+
+#include <Nazara/Core/MaxRectsBinPack.inl>
+
+#endif // NAZARA_CORE_MAXRECTSBINPACK_HPP
@@ -0,0 +1,18 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Gets the number of maximal free rectangles, which drives the insertion cost
+	*/
+	inline std::size_t MaxRectsBinPack::GetFreeRectangleCount() const
+	{
+		return m_freeRectangles.size();
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
@@ -0,0 +1,100 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_CORE_MEMORYTRACKER_HPP
+#define NAZARA_CORE_MEMORYTRACKER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/Config.hpp>
+#include <Nazara/Core/Enums.hpp>
+#include <NazaraUtils/EnumArray.hpp>
+#include <atomic>
+#include <memory>
+
+#if NAZARA_CORE_ENABLE_MEMORY_TRACKING
+	#define NazaraTrackAllocation(tag, size) Nz::MemoryTracker::RecordAllocation(tag, size)
+	#define NazaraTrackDeallocation(tag, size) Nz::MemoryTracker::RecordDeallocation(tag, size)
+#else
+	#define NazaraTrackAllocation(tag, size)
+	#define NazaraTrackDeallocation(tag, size)
+#endif
+
+namespace Nz
+{
+	class NAZARA_CORE_API MemoryTracker
+	{
+		public:
+			struct Stats;
+
+			MemoryTracker() = delete;
+			~MemoryTracker() = delete;
+
+			static inline UInt64 GetBudget(MemoryTag tag);
+			static Stats GetStats(MemoryTag tag);
+			static const char* GetTagName(MemoryTag tag);
+
+			static inline bool IsOverBudget(MemoryTag tag);
+
+			static inline void RecordAllocation(MemoryTag tag, std::size_t size);
+			static inline void RecordDeallocation(MemoryTag tag, std::size_t size);
+
+			static void ResetPeaks();
+
+			static void SetBudget(MemoryTag tag, UInt64 budget);
+
+			struct Stats
+			{
+				UInt64 allocatedBytes;    //< total of every allocation, for rates
+				UInt64 allocationCount;
+				UInt64 budget;            //< zero when unbounded
+				UInt64 deallocationCount;
+				UInt64 liveBytes;
+				UInt64 peakBytes;
+			};
+
+		private:
+			static void OnBudgetExceeded(MemoryTag tag, UInt64 liveBytes, UInt64 budget);
+
+			// Each tag has its own cache line so that subsystems allocating from different threads don't contend
+			struct alignas(64) TagCounters
+			{
+				std::atomic<UInt64> allocatedBytes = 0;
+				std::atomic<UInt64> allocationCount = 0;
+				std::atomic<UInt64> budget = 0;
+				std::atomic<UInt64> deallocationCount = 0;
+				std::atomic<UInt64> liveBytes = 0;
+				std::atomic<UInt64> peakBytes = 0;
+			};
+
+			static EnumArray<MemoryTag, TagCounters> s_counters;
+	};
+
+	template<typename T, MemoryTag Tag>
+	class TrackedAllocator
+	{
+		public:
+			using value_type = T;
+
+			template<typename U>
+			struct rebind
+			{
+				using other = TrackedAllocator<U, Tag>;
+			};
+
+			TrackedAllocator() = default;
+			template<typename U> constexpr TrackedAllocator(const TrackedAllocator<U, Tag>&) noexcept;
+
+			T* allocate(std::size_t n);
+			void deallocate(T* ptr, std::size_t n) noexcept;
+	};
+
+	template<typename T, typename U, MemoryTag Tag> constexpr bool operator==(const TrackedAllocator<T, Tag>& lhs, const TrackedAllocator<U, Tag>& rhs);
+	template<typename T, typename U, MemoryTag Tag> constexpr bool operator!=(const TrackedAllocator<T, Tag>& lhs, const TrackedAllocator<U, Tag>& rhs);
+}
+
+#include <Nazara/Core/MemoryTracker.inl>
+
+#endif // NAZARA_CORE_MEMORYTRACKER_HPP
@@ -0,0 +1,114 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Gets the memory budget of a tag
+	* \return Budget in bytes, zero if the tag has none
+	*/
+	inline UInt64 MemoryTracker::GetBudget(MemoryTag tag)
+	{
+		return s_counters[tag].budget.load(std::memory_order_relaxed);
+	}
+
+	/*!
+	* \brief Checks whether the live bytes of a tag exceed its budget
+	* \return True if the tag has a budget and exceeds it
+	*/
+	inline bool MemoryTracker::IsOverBudget(MemoryTag tag)
+	{
+		const TagCounters& counters = s_counters[tag];
+
+		UInt64 budget = counters.budget.load(std::memory_order_relaxed);
+		return budget != 0 && counters.liveBytes.load(std::memory_order_relaxed) > budget;
+	}
+
+	/*!
+	* \brief Accounts an allocation to a tag
+	*
+	* \param tag Subsystem owning the memory
+	* \param size Size of the allocation in bytes
+	*
+	* \remark Prefer the NazaraTrackAllocation macro, which is compiled out when NAZARA_CORE_ENABLE_MEMORY_TRACKING is disabled
+	*/
+	inline void MemoryTracker::RecordAllocation(MemoryTag tag, std::size_t size)
+	{
+		TagCounters& counters = s_counters[tag];
+		counters.allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+		counters.allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+		UInt64 liveBytes = counters.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+
+		UInt64 peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+		while (liveBytes > peakBytes && !counters.peakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed));
+
+		// Only report the allocation crossing the budget, not every allocation past it
+		UInt64 budget = counters.budget.load(std::memory_order_relaxed);
+		if (budget != 0 && liveBytes > budget && liveBytes - size <= budget)
+			OnBudgetExceeded(tag, liveBytes, budget);
+	}
+
+	/*!
+	* \brief Accounts a deallocation to a tag
+	*
+	* \param tag Subsystem which owned the memory, must be the tag of the matching allocation
+	* \param size Size of the allocation in bytes
+	*
+	* \remark Prefer the NazaraTrackDeallocation macro, which is compiled out when NAZARA_CORE_ENABLE_MEMORY_TRACKING is disabled
+	*/
+	inline void MemoryTracker::RecordDeallocation(MemoryTag tag, std::size_t size)
+	{
+		TagCounters& counters = s_counters[tag];
+		counters.deallocationCount.fetch_add(1, std::memory_order_relaxed);
+		counters.liveBytes.fetch_sub(size, std::memory_order_relaxed);
+	}
+
+	/*!
+	* \ingroup core
+	* \class Nz::TrackedAllocator
+	* \brief Core class of standard allocators accounting their memory to a MemoryTag
+	*
+	* Allows engine containers to report their memory (e.g. std::vector<T, TrackedAllocator<T, MemoryTag::Graphics>>).
+	* When NAZARA_CORE_ENABLE_MEMORY_TRACKING is disabled, it behaves exactly like std::allocator.
+	*/
+
+	template<typename T, MemoryTag Tag>
+	template<typename U>
+	constexpr TrackedAllocator<T, Tag>::TrackedAllocator(const TrackedAllocator<U, Tag>&) noexcept
+	{
+	}
+
+	template<typename T, MemoryTag Tag>
+	T* TrackedAllocator<T, Tag>::allocate(std::size_t n)
+	{
+		T* ptr = std::allocator<T>{}.allocate(n);
+		NazaraTrackAllocation(Tag, n * sizeof(T));
+
+		return ptr;
+	}
+
+	template<typename T, MemoryTag Tag>
+	void TrackedAllocator<T, Tag>::deallocate(T* ptr, std::size_t n) noexcept
+	{
+		NazaraTrackDeallocation(Tag, n * sizeof(T));
+		std::allocator<T>{}.deallocate(ptr, n);
+	}
+
+	template<typename T, typename U, MemoryTag Tag>
+	constexpr bool operator==(const TrackedAllocator<T, Tag>& /*lhs*/, const TrackedAllocator<U, Tag>& /*rhs*/)
+	{
+		return true;
+	}
+
+	template<typename T, typename U, MemoryTag Tag>
+	constexpr bool operator!=(const TrackedAllocator<T, Tag>& /*lhs*/, const TrackedAllocator<U, Tag>& /*rhs*/)
+	{
+		return false;
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
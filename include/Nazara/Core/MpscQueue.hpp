@@ -0,0 +1,46 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_CORE_MPSCQUEUE_HPP
+#define NAZARA_CORE_MPSCQUEUE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <atomic>
+#include <optional>
+
+namespace Nz
+{
+	template<typename T>
+	class MpscQueue
+	{
+		public:
+			MpscQueue();
+			MpscQueue(const MpscQueue&) = delete;
+			MpscQueue(MpscQueue&&) = delete;
+			~MpscQueue();
+
+			bool Pop(T& value);
+
+			template<typename... Args> void Push(Args&&... args);
+
+			MpscQueue& operator=(const MpscQueue&) = delete;
+			MpscQueue& operator=(MpscQueue&&) = delete;
+
+		private:
+			struct Node
+			{
+				std::atomic<Node*> next = nullptr;
+				std::optional<T> value;
+			};
+
+			alignas(64) std::atomic<Node*> m_head; //< last pushed node, shared between producers
+			alignas(64) Node* m_tail; //< consumer-owned, its successor is the next value to pop
+	};
+}
+
+#include <Nazara/Core/MpscQueue.inl>
+
+#endif // NAZARA_CORE_MPSCQUEUE_HPP
@@ -0,0 +1,81 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <utility>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::MpscQueue
+	* \brief Core class that represents an unbounded lock-free queue with multiple producers and a single consumer
+	*
+	* Pushing takes a single atomic exchange (plus a node allocation) and never waits for other producers or for the consumer.
+	* A value becomes visible to the consumer once its producer has linked it, so Pop can report an empty queue
+	* while a concurrent Push is still in progress, values are always popped in the order they were linked.
+	*/
+
+	template<typename T>
+	MpscQueue<T>::MpscQueue()
+	{
+		Node* stub = new Node;
+		m_head = stub;
+		m_tail = stub;
+	}
+
+	template<typename T>
+	MpscQueue<T>::~MpscQueue()
+	{
+		Node* node = m_tail;
+		while (node)
+		{
+			Node* next = node->next.load(std::memory_order_relaxed);
+			delete node;
+			node = next;
+		}
+	}
+
+	/*!
+	* \brief Pops the oldest value of the queue, must only be called by the consumer thread
+	* \return True if a value was popped
+	*
+	* \param value Value to move the popped value in
+	*/
+	template<typename T>
+	bool MpscQueue<T>::Pop(T& value)
+	{
+		Node* tail = m_tail;
+		Node* next = tail->next.load(std::memory_order_acquire);
+		if (!next)
+			return false;
+
+		// next becomes the new stub node
+		value = std::move(*next->value);
+		next->value.reset();
+
+		m_tail = next;
+		delete tail;
+
+		return true;
+	}
+
+	/*!
+	* \brief Pushes a value constructed from arguments to the queue, this can be called from any thread
+	*
+	* \param args Arguments used to construct the value
+	*/
+	template<typename T>
+	template<typename... Args>
+	void MpscQueue<T>::Push(Args&&... args)
+	{
+		Node* node = new Node;
+		node->value.emplace(std::forward<Args>(args)...);
+
+		Node* previous = m_head.exchange(node, std::memory_order_acq_rel);
+		previous->next.store(node, std::memory_order_release);
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
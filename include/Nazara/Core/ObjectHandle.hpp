@@ -15,10 +15,17 @@
 
 namespace Nz
 {
+	/*!
+	* \brief Weak reference to a HandledObject
+	*
+	* A handle is an index into a global slot table along with the generation of the slot, which is increased when the object is destroyed.
+	* Copying a handle doesn't touch the object and checking its validity doesn't require any allocation or reference counting.
+	*/
 	template<typename T>
 	class ObjectHandle
 	{
 		friend HandledObject<T>;
+		template<typename U> friend class ObjectHandle;
 
 		public:
 			ObjectHandle();
@@ -27,7 +34,7 @@ namespace Nz
 			template<typename U> ObjectHandle(ObjectHandle<U>&& ref);
 			ObjectHandle(const ObjectHandle& handle) = default;
 			ObjectHandle(ObjectHandle&& handle) noexcept;
-			~ObjectHandle();
+			~ObjectHandle() = default;
 
 			T* GetObject() const;
 
@@ -52,7 +59,8 @@ namespace Nz
 			static const ObjectHandle InvalidHandle;
 
 		protected:
-			std::shared_ptr<const Detail::HandleData> m_handleData;
+			UInt32 m_generation;
+			UInt32 m_slotIndex;
 	};
 
 	template<typename T> std::ostream& operator<<(std::ostream& out, const ObjectHandle<T>& handle);
@@ -5,6 +5,7 @@
 #include <functional>
 #include <limits>
 #include <sstream>
+#include <utility>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -22,14 +23,16 @@ namespace Nz
 	*/
 	template<typename T>
 	ObjectHandle<T>::ObjectHandle() :
-	m_handleData(Detail::HandleData::GetEmptyObject())
+	m_generation(0),
+	m_slotIndex(Detail::HandleSlotTable::InvalidSlot)
 	{
 	}
 
 	template<typename T>
 	template<typename U>
 	ObjectHandle<T>::ObjectHandle(const ObjectHandle<U>& ref) :
-	m_handleData(ref.m_handleData)
+	m_generation(ref.m_generation),
+	m_slotIndex(ref.m_slotIndex)
 	{
 		static_assert(std::is_base_of<T, U>::value, "Can only implicitly convert from a derived to a base");
 	}
@@ -37,9 +40,9 @@ namespace Nz
 	template<typename T>
 	template<typename U>
 	ObjectHandle<T>::ObjectHandle(ObjectHandle<U>&& ref) :
-	m_handleData(std::move(ref.m_handleData))
+	m_generation(ref.m_generation),
+	m_slotIndex(std::exchange(ref.m_slotIndex, Detail::HandleSlotTable::InvalidSlot))
 	{
-		ref.m_handleData = Detail::HandleData::GetEmptyObject();
 
 		static_assert(std::is_base_of<T, U>::value, "Can only implicitly convert from a derived to a base");
 	}
@@ -51,9 +54,9 @@ namespace Nz
 	*/
 	template<typename T>
 	ObjectHandle<T>::ObjectHandle(ObjectHandle&& handle) noexcept :
-	m_handleData(std::move(handle.m_handleData))
+	m_generation(handle.m_generation),
+	m_slotIndex(std::exchange(handle.m_slotIndex, Detail::HandleSlotTable::InvalidSlot))
 	{
-		handle.m_handleData = Detail::HandleData::GetEmptyObject();
 	}
 
 	/*!
@@ -67,17 +70,6 @@ namespace Nz
 		Reset(object);
 	}
 
-	/*!
-	* \brief Destructs the object and calls reset with nullptr
-	*
-	* \see Reset
-	*/
-	template<typename T>
-	ObjectHandle<T>::~ObjectHandle()
-	{
-		Reset(nullptr);
-	}
-
 	/*!
 	* \brief Gets the underlying object
 	* \return Underlying object
@@ -85,7 +77,15 @@ namespace Nz
 	template<typename T>
 	T* ObjectHandle<T>::GetObject() const
 	{
-		return static_cast<T*>(m_handleData->object);
+		if (m_slotIndex == Detail::HandleSlotTable::InvalidSlot)
+			return nullptr;
+
+		// A different generation means the object was destroyed (and the slot possibly reused)
+		const Detail::HandleSlot& slot = Detail::HandleSlotTable::GetSlot(m_slotIndex);
+		if (slot.generation != m_generation)
+			return nullptr;
+
+		return static_cast<T*>(slot.object);
 	}
 
 	/*!
@@ -95,7 +95,7 @@ namespace Nz
 	template<typename T>
 	bool ObjectHandle<T>::IsValid() const
 	{
-		return m_handleData->object != nullptr;
+		return GetObject() != nullptr;
 	}
 
 	/*!
@@ -106,10 +106,8 @@ namespace Nz
 	template<typename T>
 	void ObjectHandle<T>::Reset(T* object)
 	{
-		if (object)
-			m_handleData = object->GetHandleData();
-		else
-			m_handleData = Detail::HandleData::GetEmptyObject();
+		m_slotIndex = (object) ? object->GetHandleSlot() : Detail::HandleSlotTable::InvalidSlot;
+		m_generation = (m_slotIndex != Detail::HandleSlotTable::InvalidSlot) ? Detail::HandleSlotTable::GetSlot(m_slotIndex).generation : 0;
 	}
 
 	/*!
@@ -120,7 +118,8 @@ namespace Nz
 	template<typename T>
 	void ObjectHandle<T>::Reset(const ObjectHandle& handle)
 	{
-		m_handleData = handle.m_handleData;
+		m_generation = handle.m_generation;
+		m_slotIndex = handle.m_slotIndex;
 	}
 
 	/*!
@@ -131,8 +130,8 @@ namespace Nz
 	template<typename T>
 	void ObjectHandle<T>::Reset(ObjectHandle&& handle) noexcept
 	{
-		m_handleData = std::move(handle.m_handleData);
-		handle.m_handleData = Detail::HandleData::GetEmptyObject();
+		m_generation = handle.m_generation;
+		m_slotIndex = std::exchange(handle.m_slotIndex, Detail::HandleSlotTable::InvalidSlot);
 	}
 
 	/*!
@@ -145,7 +144,8 @@ namespace Nz
 	ObjectHandle<T>& ObjectHandle<T>::Swap(ObjectHandle& handle)
 	{
 		// We do the swap
-		std::swap(m_handleData, handle.m_handleData);
+		std::swap(m_generation, handle.m_generation);
+		std::swap(m_slotIndex, handle.m_slotIndex);
 		return *this;
 	}
 
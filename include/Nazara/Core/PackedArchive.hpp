@@ -0,0 +1,82 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_CORE_PACKEDARCHIVE_HPP
+#define NAZARA_CORE_PACKEDARCHIVE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/Config.hpp>
+#include <Nazara/Core/Enums.hpp>
+#include <Nazara/Core/MappedFile.hpp>
+#include <NazaraUtils/FunctionRef.hpp>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Nz
+{
+	class Stream;
+
+	class NAZARA_CORE_API PackedArchive : public std::enable_shared_from_this<PackedArchive>
+	{
+		public:
+			struct BuildParams;
+			struct Entry;
+
+			PackedArchive() = default;
+			PackedArchive(const PackedArchive&) = delete;
+			PackedArchive(PackedArchive&&) = delete;
+			~PackedArchive() = default;
+
+			const Entry* FindEntry(std::string_view path) const;
+			void ForEachDirectoryEntry(std::string_view directoryPath, FunctionRef<bool(std::string_view name, const Entry* fileEntry)> callback) const;
+
+			inline const std::vector<Entry>& GetEntries() const;
+			inline const std::filesystem::path& GetFilePath() const;
+
+			bool HasDirectory(std::string_view directoryPath) const;
+
+			bool Open(const std::filesystem::path& filePath);
+			std::shared_ptr<Stream> OpenEntry(const Entry& entry) const;
+
+			PackedArchive& operator=(const PackedArchive&) = delete;
+			PackedArchive& operator=(PackedArchive&&) = delete;
+
+			static bool Build(const std::filesystem::path& archivePath, const std::filesystem::path& sourceDirectory, const BuildParams& params);
+
+			static constexpr UInt32 FormatVersion = 1;
+
+			struct BuildParams
+			{
+				ArchiveCompression compression = ArchiveCompression::LZ4;
+				UInt64 alignment = 16; //< alignment of entry data in the archive, use the page size to map entries individually
+				float maxCompressionRatio = 0.9f; //< files which don't compress below this ratio are stored uncompressed, for zero-copy reads
+				int compressionLevel = 0; //< zero for the compressor default
+			};
+
+			struct Entry
+			{
+				std::string path; //< relative to the archive root, using '/' as separator
+				ArchiveCompression compression;
+				UInt64 offset;
+				UInt64 size;
+				UInt64 storedSize;
+			};
+
+		private:
+			std::vector<Entry>::const_iterator FindDirectoryBegin(std::string_view directoryPath) const;
+
+			std::filesystem::path m_filePath;
+			std::vector<Entry> m_entries; //< sorted by path
+			MappedFile m_file;
+	};
+}
+
+#include <Nazara/Core/PackedArchive.inl>
+
+#endif // NAZARA_CORE_PACKEDARCHIVE_HPP
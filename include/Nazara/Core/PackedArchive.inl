@@ -0,0 +1,20 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	inline auto PackedArchive::GetEntries() const -> const std::vector<Entry>&
+	{
+		return m_entries;
+	}
+
+	inline const std::filesystem::path& PackedArchive::GetFilePath() const
+	{
+		return m_filePath;
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
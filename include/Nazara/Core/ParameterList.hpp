@@ -12,8 +12,10 @@
 #include <NazaraUtils/MovablePtr.hpp>
 #include <NazaraUtils/Result.hpp>
 #include <atomic>
+#include <functional>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <vector>
 
 namespace Nz
 {
@@ -25,42 +27,42 @@ namespace Nz
 
 			ParameterList() = default;
 			ParameterList(const ParameterList& list);
-			ParameterList(ParameterList&&) = default;
+			ParameterList(ParameterList&&) noexcept = default;
 			~ParameterList();
 
 			void Clear();
 
-			inline void ForEach(const std::function<bool(const ParameterList& list, const std::string& name)>& callback);
-			inline void ForEach(const std::function<void(const ParameterList& list, const std::string& name)>& callback) const;
-
-			Result<bool, Error> GetBooleanParameter(const std::string& name, bool strict = true) const;
-			Result<Color, Error> GetColorParameter(const std::string& name, bool strict = true) const;
-			Result<double, Error> GetDoubleParameter(const std::string& name, bool strict = true) const;
-			Result<long long, Error> GetIntegerParameter(const std::string& name, bool strict = true) const;
-			Result<ParameterType, Error> GetParameterType(const std::string& name) const;
-			Result<void*, Error> GetPointerParameter(const std::string& name, bool strict = true) const;
-			Result<std::string, Error> GetStringParameter(const std::string& name, bool strict = true) const;
-			Result<std::string_view, Error> GetStringViewParameter(const std::string& name, bool strict = true) const;
-			Result<void*, Error> GetUserdataParameter(const std::string& name, bool strict = true) const;
-
-			bool HasParameter(const std::string& name) const;
-
-			void RemoveParameter(const std::string& name);
-
-			void SetParameter(const std::string& name);
-			void SetParameter(const std::string& name, const Color& value);
-			void SetParameter(const std::string& name, const std::string& value);
-			void SetParameter(const std::string& name, const char* value);
-			void SetParameter(const std::string& name, bool value);
-			void SetParameter(const std::string& name, double value);
-			void SetParameter(const std::string& name, long long value);
-			void SetParameter(const std::string& name, void* value);
-			void SetParameter(const std::string& name, void* value, Destructor destructor);
+			void ForEach(const std::function<bool(const ParameterList& list, const std::string& name)>& callback);
+			void ForEach(const std::function<void(const ParameterList& list, const std::string& name)>& callback) const;
+
+			Result<bool, Error> GetBooleanParameter(std::string_view name, bool strict = true) const;
+			Result<Color, Error> GetColorParameter(std::string_view name, bool strict = true) const;
+			Result<double, Error> GetDoubleParameter(std::string_view name, bool strict = true) const;
+			Result<long long, Error> GetIntegerParameter(std::string_view name, bool strict = true) const;
+			Result<ParameterType, Error> GetParameterType(std::string_view name) const;
+			Result<void*, Error> GetPointerParameter(std::string_view name, bool strict = true) const;
+			Result<std::string, Error> GetStringParameter(std::string_view name, bool strict = true) const;
+			Result<std::string_view, Error> GetStringViewParameter(std::string_view name, bool strict = true) const;
+			Result<void*, Error> GetUserdataParameter(std::string_view name, bool strict = true) const;
+
+			bool HasParameter(std::string_view name) const;
+
+			void RemoveParameter(std::string_view name);
+
+			void SetParameter(std::string_view name);
+			void SetParameter(std::string_view name, const Color& value);
+			void SetParameter(std::string_view name, const std::string& value);
+			void SetParameter(std::string_view name, const char* value);
+			void SetParameter(std::string_view name, bool value);
+			void SetParameter(std::string_view name, double value);
+			void SetParameter(std::string_view name, long long value);
+			void SetParameter(std::string_view name, void* value);
+			void SetParameter(std::string_view name, void* value, Destructor destructor);
 
 			std::string ToString() const;
 
 			ParameterList& operator=(const ParameterList& list);
-			ParameterList& operator=(ParameterList&&) = default;
+			ParameterList& operator=(ParameterList&&) noexcept = default;
 
 			enum class Error
 			{
@@ -87,6 +89,18 @@ namespace Nz
 					MovablePtr<void> ptr;
 				};
 
+				Parameter(const std::string* internedName, UInt64 hash);
+				Parameter(const Parameter& parameter);
+				Parameter(Parameter&& parameter) noexcept;
+				~Parameter();
+
+				void DestroyValue();
+
+				Parameter& operator=(const Parameter& parameter);
+				Parameter& operator=(Parameter&& parameter) noexcept;
+
+				const std::string* name; //< interned, see InternName
+				UInt64 nameHash;
 				ParameterType type;
 				union Value
 				{
@@ -108,11 +122,12 @@ namespace Nz
 				Value value;
 			};
 
-			Parameter& CreateValue(const std::string& name);
-			void DestroyValue(Parameter& parameter);
+			Parameter& CreateValue(std::string_view name);
+			inline const Parameter* FindParameter(std::string_view name) const;
+
+			static const std::string* InternName(std::string_view name);
 
-			using ParameterMap = std::unordered_map<std::string, Parameter>;
-			ParameterMap m_parameters;
+			std::vector<Parameter> m_parameters;
 	};
 
 	std::ostream& operator<<(std::ostream& out, const ParameterList& parameterList);
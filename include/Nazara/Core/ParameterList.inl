@@ -2,39 +2,22 @@
 // This file is part of the "Nazara Engine - Core module"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
+#include <NazaraUtils/Hash.hpp>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
 {
-	/*!
-	* \brief Iterates over every value of the parameter list
-	*
-	* \param callback Callback function called with every parameter contained in the list, which can return true to remove the key (or false to keep it)
-	*
-	* \remark Changing the ParameterList while iterating on it may cause bugs, but querying data is safe.
-	*/
-	inline void ParameterList::ForEach(const std::function<bool(const ParameterList& list, const std::string& name)>& callback)
+	inline auto ParameterList::FindParameter(std::string_view name) const -> const Parameter*
 	{
-		for (auto it = m_parameters.begin(); it != m_parameters.end();)
+		// Lists are small, a linear search on hashes beats a node-based map (and doesn't require allocating a key)
+		UInt64 nameHash = FNV1a64(name);
+		for (const Parameter& parameter : m_parameters)
 		{
-			if (callback(*this, it->first))
-				it = m_parameters.erase(it);
-			else
-				++it;
+			if (parameter.nameHash == nameHash && *parameter.name == name)
+				return &parameter;
 		}
-	}
 
-	/*!
-	* \brief Iterates over every value of the parameter list
-	*
-	* \param callback Callback function called with every parameter contained in the list
-	*
-	* \remark Changing the ParameterList while iterating on it may cause bugs, but querying data is safe.
-	*/
-	inline void ParameterList::ForEach(const std::function<void(const ParameterList& list, const std::string& name)>& callback) const
-	{
-		for (auto& pair : m_parameters)
-			callback(*this, pair.first);
+		return nullptr;
 	}
 }
 
@@ -0,0 +1,87 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_CORE_PROFILER_HPP
+#define NAZARA_CORE_PROFILER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/Config.hpp>
+#include <Nazara/Core/Time.hpp>
+#include <atomic>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+#if NAZARA_CORE_ENABLE_PROFILING
+	#define NazaraProfileScopeVariableName(line) nazaraProfileScope##line
+	#define NazaraProfileScopeVariable(line) NazaraProfileScopeVariableName(line)
+
+	#define NazaraProfileScope(name) Nz::ProfileScope NazaraProfileScopeVariable(__LINE__)(name)
+#else
+	#define NazaraProfileScope(name)
+#endif
+
+namespace Nz
+{
+	class Stream;
+
+	class NAZARA_CORE_API Profiler
+	{
+		public:
+			struct Zone;
+
+			Profiler() = delete;
+			~Profiler() = delete;
+
+			static std::vector<Zone> CollectZones();
+
+			static void Enable(bool enable);
+
+			static bool ExportChromeTrace(const std::filesystem::path& filePath, const std::vector<Zone>& zones);
+			static bool ExportChromeTrace(Stream& stream, const std::vector<Zone>& zones);
+
+			static UInt64 GetDroppedZoneCount();
+			static std::size_t GetThreadBufferSize();
+
+			static const char* InternName(std::string_view name);
+			static inline bool IsEnabled();
+
+			static void RecordZone(const char* name, Time beginTime, Time endTime);
+
+			static void SetThreadBufferSize(std::size_t zoneCount);
+
+			struct Zone
+			{
+				const char* name;
+				Time beginTime;
+				Time endTime;
+				UInt32 threadIndex;
+			};
+
+		private:
+			static std::atomic_bool s_isEnabled;
+	};
+
+	class ProfileScope
+	{
+		public:
+			inline ProfileScope(const char* name);
+			ProfileScope(const ProfileScope&) = delete;
+			ProfileScope(ProfileScope&&) = delete;
+			inline ~ProfileScope();
+
+			ProfileScope& operator=(const ProfileScope&) = delete;
+			ProfileScope& operator=(ProfileScope&&) = delete;
+
+		private:
+			const char* m_name;
+			Time m_beginTime;
+	};
+}
+
+#include <Nazara/Core/Profiler.inl>
+
+#endif // NAZARA_CORE_PROFILER_HPP
@@ -0,0 +1,51 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Checks whether zones are being recorded
+	* \return True if the profiler is enabled
+	*/
+	inline bool Profiler::IsEnabled()
+	{
+		return s_isEnabled.load(std::memory_order_relaxed);
+	}
+
+	/*!
+	* \ingroup core
+	* \class Nz::ProfileScope
+	* \brief Core class that records a profiler zone for the duration of a scope
+	*
+	* \remark Prefer the NazaraProfileScope macro, which is compiled out when NAZARA_CORE_ENABLE_PROFILING is disabled
+	*/
+
+	/*!
+	* \brief Starts a zone, if the profiler is enabled
+	*
+	* \param name Name of the zone, must stay valid as long as the profiler is used (a string literal or a name returned by Profiler::InternName)
+	*/
+	inline ProfileScope::ProfileScope(const char* name) :
+	m_name(nullptr)
+	{
+		if (Profiler::IsEnabled())
+		{
+			m_name = name;
+			m_beginTime = GetElapsedNanoseconds();
+		}
+	}
+
+	/*!
+	* \brief Ends the zone and records it
+	*/
+	inline ProfileScope::~ProfileScope()
+	{
+		if (m_name)
+			Profiler::RecordZone(m_name, m_beginTime, GetElapsedNanoseconds());
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
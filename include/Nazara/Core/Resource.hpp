@@ -22,6 +22,7 @@ namespace Nz
 			virtual ~Resource();
 
 			const std::filesystem::path& GetFilePath() const;
+			virtual std::size_t GetMemoryUsage() const;
 
 			void SetFilePath(std::filesystem::path filePath);
 
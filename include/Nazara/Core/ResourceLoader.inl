@@ -4,7 +4,9 @@
 
 #include <Nazara/Core/Config.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/ErrorFlags.hpp>
 #include <Nazara/Core/File.hpp>
+#include <Nazara/Core/MappedFile.hpp>
 #include <Nazara/Core/MemoryView.hpp>
 #include <Nazara/Core/Stream.hpp>
 #include <Nazara/Core/StringExt.hpp>
@@ -70,7 +72,10 @@ namespace Nz
 			return nullptr;
 		}
 
-		File file(filePath); // Open only if needed
+		// Files are memory-mapped (so stream loaders can parse them in place) and opened only if needed
+		MappedFile mappedFile;
+		File file;
+		Stream* stream = nullptr;
 
 		bool found = false;
 		for (auto& loaderPtr : m_loaders)
@@ -89,18 +94,28 @@ namespace Nz
 				result = loader.fileLoader(filePath, parameters);
 			else if (loader.streamLoader)
 			{
-				if (!file.IsOpen())
+				if (!stream)
 				{
-					if (!file.Open(OpenMode::ReadOnly))
+					bool mapped;
+					{
+						ErrorFlags errFlags(ErrorMode::Silent, ~ErrorMode::ThrowException);
+						mapped = mappedFile.Open(filePath);
+					}
+
+					if (mapped)
+						stream = &mappedFile;
+					else if (file.Open(filePath, OpenMode::ReadOnly)) //< fallback for files which can't be mapped (such as pipes)
+						stream = &file;
+					else
 					{
 						NazaraError("failed to load resource: unable to open \"{0}\"", filePath);
 						return nullptr;
 					}
 				}
 				else
-					file.SetCursorPos(0);
+					stream->SetCursorPos(0);
 
-				result = loader.streamLoader(file, parameters);
+				result = loader.streamLoader(*stream, parameters);
 			}
 
 			if (!result)
@@ -8,35 +8,67 @@
 #define NAZARA_CORE_RESOURCEMANAGER_HPP
 
 #include <Nazara/Core/ResourceLoader.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <atomic>
 #include <filesystem>
+#include <functional>
+#include <limits>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace Nz
 {
 	template<typename Type, typename Parameters>
 	class ResourceManager
 	{
+		struct PendingLoad;
+
 		public:
+			class LoadHandle;
+			using CompletionCallback = std::function<void(const std::shared_ptr<Type>& resource)>;
 			using Loader = ResourceLoader<Type, Parameters>;
+			struct Statistics;
 
 			ResourceManager(Loader& loader);
-			explicit ResourceManager(const ResourceManager&) = default;
-			ResourceManager(ResourceManager&&) noexcept = default;
-			~ResourceManager() = default;
+			explicit ResourceManager(const ResourceManager& manager);
+			ResourceManager(ResourceManager&& manager) noexcept;
+			~ResourceManager();
 
 			void Clear();
 
+			std::size_t EvictUnused(std::size_t targetMemoryUsage = 0);
+
 			std::shared_ptr<Type> Get(const std::filesystem::path& filePath);
+			LoadHandle GetAsync(const std::filesystem::path& filePath, CompletionCallback callback = {});
 			const Parameters& GetDefaultParameters();
+			std::size_t GetMemoryBudget() const;
+			Statistics GetStatistics() const;
 
 			void Register(const std::filesystem::path& filePath, std::shared_ptr<Type> resource);
+			void ResetStatistics();
 			void SetDefaultParameters(Parameters params);
+			void SetMemoryBudget(std::size_t memoryBudget);
 			void Unregister(const std::filesystem::path& filePath);
 
+			void Update();
+
 			ResourceManager& operator=(const ResourceManager&) = delete;
 			ResourceManager& operator=(ResourceManager&&) = delete;
 
+			static constexpr std::size_t NoMemoryBudget = std::numeric_limits<std::size_t>::max();
+
+			struct Statistics
+			{
+				std::size_t memoryUsage = 0;
+				std::size_t resourceCount = 0;
+				UInt64 evictionCount = 0;
+				UInt64 hitCount = 0;
+				UInt64 missCount = 0;
+			};
+
 		private:
 			// https://stackoverflow.com/questions/51065244/is-there-no-standard-hash-for-stdfilesystempath
 			struct PathHash
@@ -47,9 +79,64 @@ namespace Nz
 				}
 			};
 
-			std::unordered_map<std::filesystem::path, std::shared_ptr<Type>, PathHash> m_resources;
+			struct CacheEntry
+			{
+				std::shared_ptr<Type> resource;
+				std::list<std::filesystem::path>::iterator lruIt;
+				std::size_t memoryUsage;
+			};
+
+			struct PendingLoad
+			{
+				std::atomic_bool isFinished{ false };
+				std::filesystem::path filePath;
+				std::shared_ptr<Type> resource;
+				std::vector<CompletionCallback> callbacks;
+				TaskScheduler::TaskHandle task;
+			};
+
+			std::size_t EvictResources(std::size_t targetMemoryUsage);
+			void FinishLoad(const std::shared_ptr<PendingLoad>& pendingLoad, std::shared_ptr<Type> resource);
+			std::shared_ptr<Type> InsertResource(const std::filesystem::path& filePath, std::shared_ptr<Type> resource, bool replace);
+			void TouchResource(CacheEntry& entry);
+			void WaitForPendingLoads();
+
+			mutable std::mutex m_mutex; //< protects resources and pending loads, which are modified by loading tasks
+			std::list<std::filesystem::path> m_lruResources; //< most recently used first
+			std::unordered_map<std::filesystem::path, CacheEntry, PathHash> m_resources;
+			std::unordered_map<std::filesystem::path, std::shared_ptr<PendingLoad>, PathHash> m_pendingLoads;
+			std::vector<std::shared_ptr<PendingLoad>> m_finishedLoads; //< waiting for their callbacks to be called by Update
 			Loader& m_loader;
 			Parameters m_defaultParameters;
+			Statistics m_statistics;
+			std::size_t m_memoryBudget;
+	};
+
+	template<typename Type, typename Parameters>
+	class ResourceManager<Type, Parameters>::LoadHandle
+	{
+		friend ResourceManager;
+
+		public:
+			LoadHandle() = default;
+			LoadHandle(const LoadHandle&) = default;
+			LoadHandle(LoadHandle&&) noexcept = default;
+			~LoadHandle() = default;
+
+			std::shared_ptr<Type> GetResource() const;
+
+			bool IsFinished() const;
+			bool IsValid() const;
+
+			std::shared_ptr<Type> Wait() const;
+
+			LoadHandle& operator=(const LoadHandle&) = default;
+			LoadHandle& operator=(LoadHandle&&) noexcept = default;
+
+		private:
+			LoadHandle(std::shared_ptr<PendingLoad> pendingLoad);
+
+			std::shared_ptr<PendingLoad> m_pendingLoad;
 	};
 }
 
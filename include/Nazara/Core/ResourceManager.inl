@@ -2,6 +2,7 @@
 // This file is part of the "Nazara Engine - Core module"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
+#include <Nazara/Core/Core.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/File.hpp>
 #include <Nazara/Core/Log.hpp>
@@ -13,16 +14,84 @@ namespace Nz
 	* \ingroup core
 	* \class Nz::ResourceManager
 	* \brief Core class that represents a resource manager
+	*
+	* Resources are kept in the manager until they are unregistered or evicted. When a memory budget is set,
+	* least recently used resources which are only referenced by the manager are evicted to stay within it.
+	*
+	* \remark Resources can be retrieved from any thread, asynchronous loads are run on the core task scheduler
 	*/
 
-
 	/*!
-	* \brief Clears the content of the manager
+	* \brief Constructs a ResourceManager object using a loader
+	*
+	* \param loader Loader used to load resources which are not already in the manager
 	*/
 	template<typename Type, typename Parameters>
 	ResourceManager<Type, Parameters>::ResourceManager(Loader& loader) :
-	m_loader(loader)
+	m_loader(loader),
+	m_memoryBudget(NoMemoryBudget)
+	{
+	}
+
+	/*!
+	* \brief Constructs a ResourceManager object by copying the resources of another one
+	*
+	* \param manager Manager to copy
+	*
+	* \remark Pending asynchronous loads of the other manager are not copied
+	*/
+	template<typename Type, typename Parameters>
+	ResourceManager<Type, Parameters>::ResourceManager(const ResourceManager& manager) :
+	m_loader(manager.m_loader),
+	m_memoryBudget(NoMemoryBudget)
+	{
+		std::unique_lock lock(manager.m_mutex);
+
+		// Entries refer to the LRU list of their manager, rebuild them from the least recently used one
+		for (auto it = manager.m_lruResources.rbegin(); it != manager.m_lruResources.rend(); ++it)
+			InsertResource(*it, manager.m_resources.find(*it)->second.resource, false);
+
+		m_defaultParameters = manager.m_defaultParameters;
+		m_memoryBudget = manager.m_memoryBudget;
+		m_statistics.hitCount = manager.m_statistics.hitCount;
+		m_statistics.missCount = manager.m_statistics.missCount;
+		m_statistics.evictionCount = manager.m_statistics.evictionCount;
+	}
+
+	/*!
+	* \brief Constructs a ResourceManager object by moving another one
+	*
+	* \param manager Manager to move
+	*
+	* \remark Waits for the pending asynchronous loads of the other manager to finish, their callbacks are still called by Update
+	*/
+	template<typename Type, typename Parameters>
+	ResourceManager<Type, Parameters>::ResourceManager(ResourceManager&& manager) noexcept :
+	m_loader(manager.m_loader),
+	m_memoryBudget(NoMemoryBudget)
+	{
+		manager.WaitForPendingLoads();
+
+		std::unique_lock lock(manager.m_mutex);
+		m_lruResources = std::move(manager.m_lruResources); //< moving a list keeps its iterators valid
+		m_resources = std::move(manager.m_resources);
+		m_finishedLoads = std::move(manager.m_finishedLoads);
+		m_defaultParameters = std::move(manager.m_defaultParameters);
+		m_statistics = manager.m_statistics;
+		m_memoryBudget = manager.m_memoryBudget;
+
+		manager.m_statistics.memoryUsage = 0;
+	}
+
+	/*!
+	* \brief Destructs the manager, waiting for pending asynchronous loads to finish
+	*
+	* \remark Callbacks of loads which were not dispatched by Update are not called
+	*/
+	template<typename Type, typename Parameters>
+	ResourceManager<Type, Parameters>::~ResourceManager()
 	{
+		WaitForPendingLoads();
 	}
 
 	/*!
@@ -31,7 +100,23 @@ namespace Nz
 	template<typename Type, typename Parameters>
 	void ResourceManager<Type, Parameters>::Clear()
 	{
+		std::unique_lock lock(m_mutex);
+		m_lruResources.clear();
 		m_resources.clear();
+		m_statistics.memoryUsage = 0;
+	}
+
+	/*!
+	* \brief Evicts least recently used resources which are only referenced by the manager
+	* \return Number of evicted resources
+	*
+	* \param targetMemoryUsage Memory usage (in bytes) under which eviction stops, zero evicts every unused resource
+	*/
+	template<typename Type, typename Parameters>
+	std::size_t ResourceManager<Type, Parameters>::EvictUnused(std::size_t targetMemoryUsage)
+	{
+		std::unique_lock lock(m_mutex);
+		return EvictResources(targetMemoryUsage);
 	}
 
 	/*!
@@ -39,27 +124,122 @@ namespace Nz
 	* \return Reference to the object
 	*
 	* \param filePath Path to the asset that will be loaded
+	*
+	* \remark If the asset is being loaded asynchronously, this waits for the load to finish
 	*/
 	template<typename Type, typename Parameters>
 	std::shared_ptr<Type> ResourceManager<Type, Parameters>::Get(const std::filesystem::path& filePath)
 	{
 		std::filesystem::path absolutePath = std::filesystem::canonical(filePath);
-		auto it = m_resources.find(absolutePath);
-		if (it == m_resources.end())
+
+		std::unique_lock lock(m_mutex);
+		if (auto it = m_resources.find(absolutePath); it != m_resources.end())
+		{
+			m_statistics.hitCount++;
+			TouchResource(it->second);
+
+			return it->second.resource;
+		}
+
+		if (auto it = m_pendingLoads.find(absolutePath); it != m_pendingLoads.end())
+		{
+			m_statistics.hitCount++;
+
+			LoadHandle loadHandle(it->second);
+			lock.unlock();
+
+			return loadHandle.Wait();
+		}
+
+		m_statistics.missCount++;
+
+		Parameters parameters = m_defaultParameters;
+		lock.unlock();
+
+		// Don't hold the lock while loading, as it can take a while
+		std::shared_ptr<Type> resource = m_loader.LoadFromFile(absolutePath, parameters);
+		if (!resource)
 		{
-			std::shared_ptr<Type> resource = m_loader.LoadFromFile(absolutePath, GetDefaultParameters());
-			if (!resource)
-			{
-				NazaraError("failed to load resource from file: {0}", absolutePath);
-				return std::shared_ptr<Type>();
-			}
+			NazaraError("failed to load resource from file: {0}", absolutePath);
+			return std::shared_ptr<Type>();
+		}
+
+		NazaraDebug("loaded resource from file {0}", absolutePath);
 
-			NazaraDebug("loaded resource from file {0}", absolutePath);
+		lock.lock();
+
+		// Another thread may have registered the same resource in the meantime, keep the first one
+		return InsertResource(absolutePath, std::move(resource), false);
+	}
+
+	/*!
+	* \brief Starts loading an object from file on the task scheduler
+	* \return Handle to the load, which can be used to wait for it or retrieve the resource
+	*
+	* \param filePath Path to the asset that will be loaded
+	* \param callback Optional callback called with the resource (or null if the load failed) once loaded
+	*
+	* Loads of a path which is already being loaded are merged with the pending one, so the file is only loaded once.
+	* Callbacks of asynchronous loads are called by Update, on the thread calling it (typically the main or render thread),
+	* which allows them to finalize the resource (e.g. to upload it to the GPU) without any synchronization.
+	*
+	* \remark If the resource is already loaded, the callback is called immediately
+	*/
+	template<typename Type, typename Parameters>
+	auto ResourceManager<Type, Parameters>::GetAsync(const std::filesystem::path& filePath, CompletionCallback callback) -> LoadHandle
+	{
+		std::filesystem::path absolutePath = std::filesystem::canonical(filePath);
 
-			it = m_resources.insert(std::make_pair(absolutePath, resource)).first;
+		std::unique_lock lock(m_mutex);
+		if (auto it = m_resources.find(absolutePath); it != m_resources.end())
+		{
+			m_statistics.hitCount++;
+			TouchResource(it->second);
+
+			auto pendingLoad = std::make_shared<PendingLoad>();
+			pendingLoad->filePath = std::move(absolutePath);
+			pendingLoad->resource = it->second.resource;
+			pendingLoad->isFinished = true;
+			lock.unlock();
+
+			if (callback)
+				callback(pendingLoad->resource);
+
+			return LoadHandle(std::move(pendingLoad));
 		}
 
-		return it->second;
+		if (auto it = m_pendingLoads.find(absolutePath); it != m_pendingLoads.end())
+		{
+			m_statistics.hitCount++;
+
+			if (callback)
+				it->second->callbacks.push_back(std::move(callback));
+
+			return LoadHandle(it->second);
+		}
+
+		m_statistics.missCount++;
+
+		auto pendingLoad = std::make_shared<PendingLoad>();
+		pendingLoad->filePath = absolutePath;
+		if (callback)
+			pendingLoad->callbacks.push_back(std::move(callback));
+
+		// The task can't finish the load before we release the lock
+		pendingLoad->task = Core::Instance()->GetTaskScheduler().AddTask([this, pendingLoad, parameters = m_defaultParameters]
+		{
+			std::shared_ptr<Type> resource = m_loader.LoadFromFile(pendingLoad->filePath, parameters);
+			if (resource)
+				NazaraDebug("loaded resource from file {0}", pendingLoad->filePath);
+			else
+				NazaraError("failed to load resource from file: {0}", pendingLoad->filePath);
+
+			FinishLoad(pendingLoad, std::move(resource));
+		});
+
+		m_pendingLoads.emplace(std::move(absolutePath), pendingLoad);
+
+		return LoadHandle(std::move(pendingLoad));
 	}
 
 	/*!
@@ -72,6 +252,34 @@ namespace Nz
 		return m_defaultParameters;
 	}
 
+	/*!
+	* \brief Gets the memory budget of the manager
+	* \return Memory budget (in bytes), NoMemoryBudget if unlimited
+	*/
+	template<typename Type, typename Parameters>
+	std::size_t ResourceManager<Type, Parameters>::GetMemoryBudget() const
+	{
+		std::unique_lock lock(m_mutex);
+		return m_memoryBudget;
+	}
+
+	/*!
+	* \brief Gets the cache statistics of the manager
+	* \return Memory usage, resource count and hit/miss/eviction counters
+	*
+	* \remark Memory usage of a resource is measured when it enters the manager
+	*/
+	template<typename Type, typename Parameters>
+	auto ResourceManager<Type, Parameters>::GetStatistics() const -> Statistics
+	{
+		std::unique_lock lock(m_mutex);
+
+		Statistics statistics = m_statistics;
+		statistics.resourceCount = m_resources.size();
+
+		return statistics;
+	}
+
 	/*!
 	* \brief Registers the resource under the filePath
 	*
@@ -83,7 +291,20 @@ namespace Nz
 	{
 		std::filesystem::path absolutePath = std::filesystem::canonical(filePath);
 
-		m_resources[absolutePath] = resource;
+		std::unique_lock lock(m_mutex);
+		InsertResource(absolutePath, std::move(resource), true);
+	}
+
+	/*!
+	* \brief Resets the hit, miss and eviction counters
+	*/
+	template<typename Type, typename Parameters>
+	void ResourceManager<Type, Parameters>::ResetStatistics()
+	{
+		std::unique_lock lock(m_mutex);
+		m_statistics.evictionCount = 0;
+		m_statistics.hitCount = 0;
+		m_statistics.missCount = 0;
 	}
 
 	/*!
@@ -97,6 +318,23 @@ namespace Nz
 		m_defaultParameters = std::move(params);
 	}
 
+	/*!
+	* \brief Sets the memory budget of the manager
+	*
+	* \param memoryBudget Memory (in bytes) above which unused resources are evicted, NoMemoryBudget for an unlimited budget
+	*
+	* \remark Resources still referenced outside of the manager are never evicted, memory usage may exceed the budget because of them
+	*/
+	template<typename Type, typename Parameters>
+	void ResourceManager<Type, Parameters>::SetMemoryBudget(std::size_t memoryBudget)
+	{
+		std::unique_lock lock(m_mutex);
+		m_memoryBudget = memoryBudget;
+
+		if (m_memoryBudget != NoMemoryBudget)
+			EvictResources(m_memoryBudget);
+	}
+
 	/*!
 	* \brief Unregisters the resource under the filePath
 	*
@@ -107,7 +345,213 @@ namespace Nz
 	{
 		std::filesystem::path absolutePath = std::filesystem::canonical(filePath);
 
-		m_resources.erase(absolutePath);
+		std::unique_lock lock(m_mutex);
+		auto it = m_resources.find(absolutePath);
+		if (it == m_resources.end())
+			return;
+
+		m_statistics.memoryUsage -= it->second.memoryUsage;
+		m_lruResources.erase(it->second.lruIt);
+		m_resources.erase(it);
+	}
+
+	/*!
+	* \brief Calls the callbacks of asynchronous loads which finished since the last call and enforces the memory budget
+	*
+	* This is meant to be called regularly (e.g. once per frame) by the thread which has to finalize loaded resources.
+	* As resources may be released at any time, this is also where resources which are no longer used are evicted.
+	*/
+	template<typename Type, typename Parameters>
+	void ResourceManager<Type, Parameters>::Update()
+	{
+		std::vector<std::shared_ptr<PendingLoad>> finishedLoads;
+		{
+			std::unique_lock lock(m_mutex);
+			finishedLoads.swap(m_finishedLoads);
+
+			if (m_memoryBudget != NoMemoryBudget && m_statistics.memoryUsage > m_memoryBudget)
+				EvictResources(m_memoryBudget);
+		}
+
+		// Callbacks are called without holding the lock, as they may use the manager
+		for (const std::shared_ptr<PendingLoad>& pendingLoad : finishedLoads)
+		{
+			for (CompletionCallback& callback : pendingLoad->callbacks)
+				callback(pendingLoad->resource);
+
+			pendingLoad->callbacks.clear();
+		}
+	}
+
+	template<typename Type, typename Parameters>
+	std::size_t ResourceManager<Type, Parameters>::EvictResources(std::size_t targetMemoryUsage)
+	{
+		std::size_t evictedCount = 0;
+
+		// Resources may not report their memory usage, so a zero target evicts everything unused
+		auto it = m_lruResources.end();
+		while (it != m_lruResources.begin() && (targetMemoryUsage == 0 || m_statistics.memoryUsage > targetMemoryUsage))
+		{
+			--it;
+
+			auto entryIt = m_resources.find(*it);
+			NazaraAssert(entryIt != m_resources.end(), "LRU list is out of sync");
+
+			// Only evict resources which aren't used outside of the manager
+			if (entryIt->second.resource.use_count() > 1)
+				continue;
+
+			m_statistics.memoryUsage -= entryIt->second.memoryUsage;
+			m_resources.erase(entryIt);
+			it = m_lruResources.erase(it);
+
+			evictedCount++;
+		}
+
+		if (evictedCount > 0)
+		{
+			m_statistics.evictionCount += evictedCount;
+			NazaraDebug("evicted {0} resources", evictedCount);
+		}
+
+		return evictedCount;
+	}
+
+	template<typename Type, typename Parameters>
+	void ResourceManager<Type, Parameters>::FinishLoad(const std::shared_ptr<PendingLoad>& pendingLoad, std::shared_ptr<Type> resource)
+	{
+		std::unique_lock lock(m_mutex);
+		if (resource)
+		{
+			// Keep the resource if it was registered during the load
+			pendingLoad->resource = InsertResource(pendingLoad->filePath, std::move(resource), false);
+		}
+
+		m_pendingLoads.erase(pendingLoad->filePath);
+		m_finishedLoads.push_back(pendingLoad);
+
+		pendingLoad->isFinished = true;
+	}
+
+	template<typename Type, typename Parameters>
+	std::shared_ptr<Type> ResourceManager<Type, Parameters>::InsertResource(const std::filesystem::path& filePath, std::shared_ptr<Type> resource, bool replace)
+	{
+		auto it = m_resources.find(filePath);
+		if (it != m_resources.end())
+		{
+			CacheEntry& entry = it->second;
+			TouchResource(entry);
+
+			if (!replace)
+				return entry.resource;
+
+			m_statistics.memoryUsage -= entry.memoryUsage;
+		}
+		else
+		{
+			m_lruResources.push_front(filePath);
+
+			it = m_resources.emplace(filePath, CacheEntry{}).first;
+			it->second.lruIt = m_lruResources.begin();
+		}
+
+		CacheEntry& entry = it->second;
+		entry.memoryUsage = (resource) ? resource->GetMemoryUsage() : 0;
+		entry.resource = std::move(resource);
+
+		m_statistics.memoryUsage += entry.memoryUsage;
+
+		// Keep a reference to prevent the new resource from being evicted
+		std::shared_ptr<Type> insertedResource = entry.resource;
+		if (m_memoryBudget != NoMemoryBudget && m_statistics.memoryUsage > m_memoryBudget)
+			EvictResources(m_memoryBudget);
+
+		return insertedResource;
+	}
+
+	template<typename Type, typename Parameters>
+	void ResourceManager<Type, Parameters>::TouchResource(CacheEntry& entry)
+	{
+		m_lruResources.splice(m_lruResources.begin(), m_lruResources, entry.lruIt);
+	}
+
+	template<typename Type, typename Parameters>
+	void ResourceManager<Type, Parameters>::WaitForPendingLoads()
+	{
+		std::vector<TaskScheduler::TaskHandle> tasks;
+		{
+			std::unique_lock lock(m_mutex);
+			for (auto&& [filePath, pendingLoad] : m_pendingLoads)
+				tasks.push_back(pendingLoad->task);
+		}
+
+		// Loads finish by locking the mutex, so we can't wait for them while holding it
+		TaskScheduler& taskScheduler = Core::Instance()->GetTaskScheduler();
+		for (const TaskScheduler::TaskHandle& task : tasks)
+			taskScheduler.WaitFor(task);
+	}
+
+	/*!
+	* \ingroup core
+	* \class Nz::ResourceManager::LoadHandle
+	* \brief Core class that represents an asynchronous load of a ResourceManager
+	*/
+
+	template<typename Type, typename Parameters>
+	ResourceManager<Type, Parameters>::LoadHandle::LoadHandle(std::shared_ptr<PendingLoad> pendingLoad) :
+	m_pendingLoad(std::move(pendingLoad))
+	{
+	}
+
+	/*!
+	* \brief Gets the loaded resource
+	* \return Loaded resource, or null if the load is not finished or failed
+	*/
+	template<typename Type, typename Parameters>
+	std::shared_ptr<Type> ResourceManager<Type, Parameters>::LoadHandle::GetResource() const
+	{
+		if (!IsFinished() || !m_pendingLoad)
+			return std::shared_ptr<Type>();
+
+		return m_pendingLoad->resource;
+	}
+
+	/*!
+	* \brief Checks whether the load is finished
+	* \return True if the load is finished (or if the handle is invalid)
+	*
+	* \remark Callbacks of the load may not have been called yet, as this is done by ResourceManager::Update
+	*/
+	template<typename Type, typename Parameters>
+	bool ResourceManager<Type, Parameters>::LoadHandle::IsFinished() const
+	{
+		return !m_pendingLoad || m_pendingLoad->isFinished;
+	}
+
+	/*!
+	* \brief Checks whether the handle refers to a load
+	* \return True if the handle is valid
+	*/
+	template<typename Type, typename Parameters>
+	bool ResourceManager<Type, Parameters>::LoadHandle::IsValid() const
+	{
+		return m_pendingLoad != nullptr;
+	}
+
+	/*!
+	* \brief Waits for the load to finish, running other tasks in the meantime
+	* \return Loaded resource, or null if the load failed
+	*
+	* \remark This must not be called from a resource loader, as this could deadlock
+	*/
+	template<typename Type, typename Parameters>
+	std::shared_ptr<Type> ResourceManager<Type, Parameters>::LoadHandle::Wait() const
+	{
+		if (!m_pendingLoad)
+			return std::shared_ptr<Type>();
+
+		Core::Instance()->GetTaskScheduler().WaitFor(m_pendingLoad->task);
+		return m_pendingLoad->resource;
 	}
 }
 
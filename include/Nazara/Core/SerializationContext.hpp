@@ -27,8 +27,13 @@ namespace Nz
 		UInt8 writeByte; //< Undefined value, will be initialized at the first bit write
 
 		void FlushBits();
+
+		bool ReadBits(UInt64* value, UInt8 bitCount);
+
 		inline void ResetReadBitPosition();
 		inline void ResetWriteBitPosition();
+
+		bool WriteBits(UInt64 value, UInt8 bitCount);
 	};
 }
 
@@ -0,0 +1,81 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+// Based on the public domain work of Jukka Jylänki
+// http://clb.demon.fi/projects/even-more-rectangle-bin-packing
+
+#pragma once
+
+#ifndef NAZARA_CORE_SKYLINEBINPACK_HPP
+#define NAZARA_CORE_SKYLINEBINPACK_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/Config.hpp>
+#include <Nazara/Math/Rect.hpp>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_CORE_API SkylineBinPack
+	{
+		public:
+			enum class Heuristic
+			{
+				BottomLeft, //< lowest top side, fastest
+				MinWaste    //< least area wasted below the rectangle
+			};
+
+			SkylineBinPack();
+			SkylineBinPack(unsigned int width, unsigned int height);
+			SkylineBinPack(const Vector2ui& size);
+			SkylineBinPack(const SkylineBinPack&) = default;
+			SkylineBinPack(SkylineBinPack&&) noexcept = default;
+			~SkylineBinPack() = default;
+
+			void Clear();
+
+			void Expand(unsigned int newWidth, unsigned newHeight);
+			void Expand(const Vector2ui& newSize);
+
+			void FreeRectangle(const Rectui& rect);
+
+			unsigned int GetHeight() const;
+			float GetOccupancy() const;
+			Vector2ui GetSize() const;
+			unsigned int GetWidth() const;
+
+			bool Insert(Rectui* rects, unsigned int count, Heuristic heuristic = Heuristic::BottomLeft);
+			bool Insert(Rectui* rects, bool* flipped, unsigned int count, Heuristic heuristic = Heuristic::BottomLeft);
+			bool Insert(Rectui* rects, bool* flipped, bool* inserted, unsigned int count, Heuristic heuristic = Heuristic::BottomLeft);
+
+			void Reset();
+			void Reset(unsigned int width, unsigned int height);
+			void Reset(const Vector2ui& size);
+
+			SkylineBinPack& operator=(const SkylineBinPack&) = default;
+			SkylineBinPack& operator=(SkylineBinPack&&) noexcept = default;
+
+		private:
+			struct SkylineNode
+			{
+				unsigned int x;
+				unsigned int y;
+				unsigned int width;
+			};
+
+			void AddSkylineLevel(std::size_t nodeIndex, const Rectui& rect);
+			void AddWastedAreas(std::size_t nodeIndex, const Rectui& rect);
+			bool FindSkylinePosition(unsigned int width, unsigned int height, Heuristic heuristic, std::size_t* nodeIndex, unsigned int* y, UInt64* primaryScore, UInt64* secondaryScore) const;
+			bool InsertIntoWasteMap(Rectui& rect, bool allowFlip, bool* flipped);
+			bool RectangleFits(std::size_t nodeIndex, unsigned int width, unsigned int height, unsigned int* y, UInt64* wastedArea) const;
+
+			std::vector<Rectui> m_wasteRectangles;
+			std::vector<SkylineNode> m_skyline;
+			UInt64 m_usedArea;
+			unsigned int m_height;
+			unsigned int m_width;
+	};
+}
+
+#endif // NAZARA_CORE_SKYLINEBINPACK_HPP
@@ -0,0 +1,48 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_CORE_SPSCRINGBUFFER_HPP
+#define NAZARA_CORE_SPSCRINGBUFFER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <atomic>
+#include <vector>
+
+namespace Nz
+{
+	template<typename T>
+	class SpscRingBuffer
+	{
+		public:
+			SpscRingBuffer(std::size_t capacity = 0);
+			SpscRingBuffer(const SpscRingBuffer&) = delete;
+			SpscRingBuffer(SpscRingBuffer&&) = delete;
+			~SpscRingBuffer() = default;
+
+			void Clear();
+
+			std::size_t GetCapacity() const;
+			std::size_t GetReadableCount() const;
+			std::size_t GetWritableCount() const;
+
+			std::size_t Read(T* values, std::size_t count);
+			void Resize(std::size_t capacity);
+
+			std::size_t Write(const T* values, std::size_t count);
+
+			SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+			SpscRingBuffer& operator=(SpscRingBuffer&&) = delete;
+
+		private:
+			std::vector<T> m_values;
+			alignas(64) std::atomic<std::size_t> m_readIndex;  //< owned by the consumer, total count of read values
+			alignas(64) std::atomic<std::size_t> m_writeIndex; //< owned by the producer, total count of written values
+	};
+}
+
+#include <Nazara/Core/SpscRingBuffer.inl>
+
+#endif // NAZARA_CORE_SPSCRINGBUFFER_HPP
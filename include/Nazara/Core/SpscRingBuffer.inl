@@ -0,0 +1,149 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <algorithm>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::SpscRingBuffer
+	* \brief Core class that represents a fixed-capacity lock-free ring buffer with a single producer and a single consumer
+	*
+	* Values are copied in and out in blocks, the producer and the consumer each only publish their own index (with release semantics),
+	* so neither side ever waits for the other: writing to a full buffer or reading from an empty one just transfers fewer values.
+	*/
+
+	/*!
+	* \brief Constructs a ring buffer able to hold capacity values
+	*
+	* \param capacity Maximum number of values the buffer can hold
+	*/
+	template<typename T>
+	SpscRingBuffer<T>::SpscRingBuffer(std::size_t capacity) :
+	m_values(capacity),
+	m_readIndex(0),
+	m_writeIndex(0)
+	{
+	}
+
+	/*!
+	* \brief Discards every value of the buffer
+	*
+	* \remark Neither the producer nor the consumer must be using the buffer at the same time
+	*/
+	template<typename T>
+	void SpscRingBuffer<T>::Clear()
+	{
+		m_readIndex.store(0, std::memory_order_relaxed);
+		m_writeIndex.store(0, std::memory_order_relaxed);
+	}
+
+	/*!
+	* \brief Gets the maximum number of values the buffer can hold
+	* \return Capacity of the buffer
+	*/
+	template<typename T>
+	std::size_t SpscRingBuffer<T>::GetCapacity() const
+	{
+		return m_values.size();
+	}
+
+	/*!
+	* \brief Gets the number of values available to the consumer
+	* \return Readable value count (may grow concurrently if called from the consumer)
+	*/
+	template<typename T>
+	std::size_t SpscRingBuffer<T>::GetReadableCount() const
+	{
+		return m_writeIndex.load(std::memory_order_acquire) - m_readIndex.load(std::memory_order_acquire);
+	}
+
+	/*!
+	* \brief Gets the number of values the producer can write
+	* \return Writable value count (may grow concurrently if called from the producer)
+	*/
+	template<typename T>
+	std::size_t SpscRingBuffer<T>::GetWritableCount() const
+	{
+		return m_values.size() - GetReadableCount();
+	}
+
+	/*!
+	* \brief Reads values from the buffer, must only be called by the consumer
+	* \return Number of values read, less than count if not enough values were available
+	*
+	* \param values Pointer to an array of at least count values
+	* \param count Maximum number of values to read
+	*/
+	template<typename T>
+	std::size_t SpscRingBuffer<T>::Read(T* values, std::size_t count)
+	{
+		std::size_t readIndex = m_readIndex.load(std::memory_order_relaxed);
+		std::size_t writeIndex = m_writeIndex.load(std::memory_order_acquire);
+
+		count = std::min(count, writeIndex - readIndex);
+		if (count == 0)
+			return 0;
+
+		std::size_t capacity = m_values.size();
+		std::size_t firstIndex = readIndex % capacity;
+		std::size_t firstCount = std::min(count, capacity - firstIndex);
+
+		std::copy_n(&m_values[firstIndex], firstCount, values);
+		std::copy_n(&m_values[0], count - firstCount, values + firstCount);
+
+		m_readIndex.store(readIndex + count, std::memory_order_release);
+
+		return count;
+	}
+
+	/*!
+	* \brief Changes the capacity of the buffer, discarding its values
+	*
+	* \param capacity New capacity
+	*
+	* \remark Neither the producer nor the consumer must be using the buffer at the same time
+	*/
+	template<typename T>
+	void SpscRingBuffer<T>::Resize(std::size_t capacity)
+	{
+		m_values.clear();
+		m_values.resize(capacity);
+
+		Clear();
+	}
+
+	/*!
+	* \brief Writes values to the buffer, must only be called by the producer
+	* \return Number of values written, less than count if the buffer got full
+	*
+	* \param values Pointer to an array of at least count values
+	* \param count Number of values to write
+	*/
+	template<typename T>
+	std::size_t SpscRingBuffer<T>::Write(const T* values, std::size_t count)
+	{
+		std::size_t writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+		std::size_t readIndex = m_readIndex.load(std::memory_order_acquire);
+
+		std::size_t capacity = m_values.size();
+		count = std::min(count, capacity - (writeIndex - readIndex));
+		if (count == 0)
+			return 0;
+
+		std::size_t firstIndex = writeIndex % capacity;
+		std::size_t firstCount = std::min(count, capacity - firstIndex);
+
+		std::copy_n(values, firstCount, &m_values[firstIndex]);
+		std::copy_n(values + firstCount, count - firstCount, &m_values[0]);
+
+		m_writeIndex.store(writeIndex + count, std::memory_order_release);
+
+		return count;
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
@@ -35,6 +35,7 @@ namespace Nz
 	NAZARA_CORE_API std::string_view GetWord(std::string_view str, std::size_t wordIndex, UnicodeAware);
 
 	inline bool IsNumber(std::string_view str);
+	NAZARA_CORE_API bool IsValidUtf8(std::string_view str);
 
 	NAZARA_CORE_API void IterateOnCodepoints(std::string_view str, FunctionRef<bool(const char32_t* characters, std::size_t characterCount)> callback);
 
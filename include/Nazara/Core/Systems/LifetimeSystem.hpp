@@ -10,22 +10,27 @@
 #include <NazaraUtils/Prerequisites.hpp>
 #include <Nazara/Core/Config.hpp>
 #include <Nazara/Core/Time.hpp>
+#include <Nazara/Core/TimerWheel.hpp>
 #include <NazaraUtils/TypeList.hpp>
 #include <entt/entt.hpp>
+#include <vector>
 
 namespace Nz
 {
+	class LifetimeComponent;
+
+	// Destroys entities once their lifetime is over, expirations are scheduled in a timer wheel so only expiring entities are processed
 	class NAZARA_CORE_API LifetimeSystem
 	{
 		public:
 			static constexpr bool AllowConcurrent = false;
 			static constexpr Int64 ExecutionOrder = 1'000'000;
-			using Components = TypeList<class LifetimeComponent>;
+			using Components = TypeList<LifetimeComponent, class DisabledComponent>;
 
-			inline LifetimeSystem(entt::registry& registry);
+			LifetimeSystem(entt::registry& registry);
 			LifetimeSystem(const LifetimeSystem&) = delete;
 			LifetimeSystem(LifetimeSystem&&) = delete;
-			~LifetimeSystem() = default;
+			~LifetimeSystem();
 
 			void Update(Time elapsedTime);
 
@@ -33,7 +38,24 @@ namespace Nz
 			LifetimeSystem& operator=(LifetimeSystem&&) = delete;
 
 		private:
+			void OnDisabledConstruct(entt::registry& registry, entt::entity entity);
+			void OnDisabledDestroy(entt::registry& registry, entt::entity entity);
+			void OnLifetimeDestroy(entt::registry& registry, entt::entity entity);
+			void OnLifetimeUpdate(entt::registry& registry, entt::entity entity);
+			void Schedule(entt::entity entity, LifetimeComponent& lifetimeComponent);
+
+			static inline UInt32 ToWheelTime(Time time, bool roundUp);
+
+			std::vector<entt::entity> m_expiredEntities;
+			std::vector<entt::entity> m_timerEntities; //< by entity index
 			entt::registry& m_registry;
+			entt::scoped_connection m_disabledConstructConnection;
+			entt::scoped_connection m_disabledDestroyConnection;
+			entt::scoped_connection m_lifetimeConstructConnection;
+			entt::scoped_connection m_lifetimeDestroyConnection;
+			entt::scoped_connection m_lifetimeUpdateConnection;
+			Time m_currentTime;
+			TimerWheel m_timerWheel;
 	};
 }
 
@@ -6,9 +6,14 @@
 
 namespace Nz
 {
-	inline LifetimeSystem::LifetimeSystem(entt::registry& registry) :
-	m_registry(registry)
+	inline UInt32 LifetimeSystem::ToWheelTime(Time time, bool roundUp)
 	{
+		// Wheel time is in milliseconds and wraps around
+		Int64 milliseconds = time.AsMilliseconds();
+		if (roundUp && Time::Milliseconds(milliseconds) < time)
+			milliseconds++;
+
+		return static_cast<UInt32>(milliseconds);
 	}
 }
 
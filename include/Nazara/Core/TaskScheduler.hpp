@@ -8,28 +8,92 @@
 #define NAZARA_CORE_TASKSCHEDULER_HPP
 
 #include <NazaraUtils/Prerequisites.hpp>
-#include <Nazara/Core/Functor.hpp>
+#include <Nazara/Core/Config.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace Nz
 {
 	class NAZARA_CORE_API TaskScheduler
 	{
+		struct TaskData;
+
 		public:
-			TaskScheduler() = delete;
-			~TaskScheduler() = delete;
-
-			template<typename F> static void AddTask(F function);
-			template<typename F, typename... Args> static void AddTask(F function, Args&&... args);
-			template<typename C> static void AddTask(void (C::*function)(), C* object);
-			static unsigned int GetWorkerCount();
-			static bool Initialize();
-			static void Run();
-			static void SetWorkerCount(unsigned int workerCount);
-			static void Uninitialize();
-			static void WaitForTasks();
+			class TaskHandle;
+			using Task = std::function<void()>;
+
+			TaskScheduler(unsigned int workerCount = 0);
+			TaskScheduler(const TaskScheduler&) = delete;
+			TaskScheduler(TaskScheduler&&) = delete;
+			~TaskScheduler();
+
+			TaskHandle AddTask(Task&& task);
+			TaskHandle AddTask(Task&& task, std::initializer_list<TaskHandle> dependencies);
+			TaskHandle AddTask(Task&& task, const TaskHandle* dependencies, std::size_t dependencyCount);
+			TaskHandle AddTaskOnWorker(Task&& task, unsigned int workerIndex);
+
+			template<typename F> void ForEachChunk(std::size_t count, std::size_t chunkSize, F&& func);
+
+			inline unsigned int GetWorkerCount() const;
+
+			void WaitFor(const TaskHandle& handle);
+			void WaitForTasks();
+
+			TaskScheduler& operator=(const TaskScheduler&) = delete;
+			TaskScheduler& operator=(TaskScheduler&&) = delete;
+
+			static unsigned int GetCurrentWorkerIndex();
+
+			static constexpr unsigned int InvalidWorkerIndex = std::numeric_limits<unsigned int>::max();
 
 		private:
-			static void AddTaskFunctor(Functor* taskFunctor);
+			struct Worker;
+
+			void RunTask(std::shared_ptr<TaskData> task);
+			void Schedule(std::shared_ptr<TaskData> task);
+			bool TryRunTask(unsigned int workerIndex);
+			void WorkerProc(unsigned int workerIndex);
+
+			std::atomic_bool m_running;
+			std::atomic_size_t m_pendingTaskCount;
+			std::atomic_size_t m_queuedTaskCount;
+			std::atomic_uint m_nextWorkerIndex;
+			std::atomic_uint m_sleepingWorkerCount;
+			std::condition_variable m_idleCondition;
+			std::condition_variable m_sleepCondition;
+			std::mutex m_idleMutex;
+			std::mutex m_sleepMutex;
+			std::vector<std::unique_ptr<Worker>> m_workers;
+	};
+
+	class TaskScheduler::TaskHandle
+	{
+		friend TaskScheduler;
+
+		public:
+			TaskHandle() = default;
+			TaskHandle(const TaskHandle&) = default;
+			TaskHandle(TaskHandle&&) noexcept = default;
+			~TaskHandle() = default;
+
+			bool IsFinished() const;
+			inline bool IsValid() const;
+
+			TaskHandle& operator=(const TaskHandle&) = default;
+			TaskHandle& operator=(TaskHandle&&) noexcept = default;
+
+		private:
+			inline TaskHandle(std::shared_ptr<TaskData> data);
+
+			std::shared_ptr<TaskData> m_data;
 	};
 }
 
@@ -2,52 +2,88 @@
 // This file is part of the "Nazara Engine - Core module"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
+#include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
 {
 	/*!
-	* \ingroup core
-	* \class Nz::TaskScheduler
-	* \brief Core class that represents a thread pool
-	*/
-
-	/*!
-	* \brief Adds a task to the pending list
+	* \brief Splits a range in chunks and process them in parallel, the calling thread helps running them
 	*
-	* \param function Task that the pool will execute
+	* \param count Number of elements to process
+	* \param chunkSize Number of elements per chunk (must be non-zero), chunk index can be retrieved as first / chunkSize
+	* \param func Function called as func(first, last) for each chunk, with last being exclusive
+	*
+	* \remark This function returns once every chunk has been processed, the first exception thrown by a chunk is then rethrown
 	*/
-
 	template<typename F>
-	void TaskScheduler::AddTask(F function)
+	void TaskScheduler::ForEachChunk(std::size_t count, std::size_t chunkSize, F&& func)
 	{
-		AddTaskFunctor(new FunctorWithoutArgs<F>(function));
-	}
+		NazaraAssert(chunkSize > 0, "chunk size must be non-zero");
 
-	/*!
-	* \brief Adds a task to the pending list
-	*
-	* \param function Task that the pool will execute
-	* \param args Arguments of the function
-	*/
+		if (count == 0)
+			return;
+
+		std::size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+		if (chunkCount == 1 || m_workers.empty())
+		{
+			for (std::size_t first = 0; first < count; first += chunkSize)
+				func(first, std::min(first + chunkSize, count));
+
+			return;
+		}
 
-	template<typename F, typename... Args>
-	void TaskScheduler::AddTask(F function, Args&&... args)
+		std::vector<TaskHandle> chunkTasks;
+		chunkTasks.reserve(chunkCount - 1);
+		for (std::size_t chunkIndex = 1; chunkIndex < chunkCount; ++chunkIndex)
+		{
+			std::size_t first = chunkIndex * chunkSize;
+			std::size_t last = std::min(first + chunkSize, count);
+			chunkTasks.push_back(AddTask([&func, first, last] { func(first, last); }));
+		}
+
+		// Process the first chunk on the calling thread while workers pick up the others
+		std::exception_ptr exception;
+		try
+		{
+			func(0, std::min(chunkSize, count));
+		}
+		catch (...)
+		{
+			exception = std::current_exception();
+		}
+
+		// Chunk tasks reference func, wait for all of them even if one threw
+		for (const TaskHandle& handle : chunkTasks)
+		{
+			try
+			{
+				WaitFor(handle);
+			}
+			catch (...)
+			{
+				if (!exception)
+					exception = std::current_exception();
+			}
+		}
+
+		if (exception)
+			std::rethrow_exception(exception);
+	}
+
+	inline unsigned int TaskScheduler::GetWorkerCount() const
 	{
-		AddTaskFunctor(new FunctorWithArgs<F, Args...>(function, std::forward<Args>(args)...));
+		return static_cast<unsigned int>(m_workers.size());
 	}
 
-	/*!
-	* \brief Adds a task to the pending list
-	*
-	* \param function Task that the pool will execute
-	* \param object Object on which the method will be called
-	*/
+	inline TaskScheduler::TaskHandle::TaskHandle(std::shared_ptr<TaskData> data) :
+	m_data(std::move(data))
+	{
+	}
 
-	template<typename C>
-	void TaskScheduler::AddTask(void (C::*function)(), C* object)
+	inline bool TaskScheduler::TaskHandle::IsValid() const
 	{
-		AddTaskFunctor(new MemberWithoutArgs<C>(function, object));
+		return m_data != nullptr;
 	}
 }
 
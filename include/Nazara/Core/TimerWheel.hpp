@@ -0,0 +1,80 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_CORE_TIMERWHEEL_HPP
+#define NAZARA_CORE_TIMERWHEEL_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/Config.hpp>
+#include <NazaraUtils/FunctionRef.hpp>
+#include <array>
+#include <limits>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_CORE_API TimerWheel
+	{
+		public:
+			explicit TimerWheel(std::size_t timerCount = 0, UInt32 currentTime = 0);
+			TimerWheel(const TimerWheel&) = default;
+			TimerWheel(TimerWheel&&) noexcept = default;
+			~TimerWheel() = default;
+
+			void Advance(UInt32 currentTime, const FunctionRef<void(std::size_t timerId)>& callback);
+
+			void Cancel(std::size_t timerId);
+
+			inline UInt32 GetCurrentTime() const;
+			inline UInt32 GetDeadline(std::size_t timerId) const;
+			inline std::size_t GetScheduledTimerCount() const;
+			inline std::size_t GetTimerCount() const;
+
+			inline bool IsScheduled(std::size_t timerId) const;
+
+			void Reset(std::size_t timerCount, UInt32 currentTime);
+			void Resize(std::size_t timerCount);
+
+			void Schedule(std::size_t timerId, UInt32 deadline);
+
+			TimerWheel& operator=(const TimerWheel&) = default;
+			TimerWheel& operator=(TimerWheel&&) noexcept = default;
+
+			static constexpr UInt32 MaxDelay = (1u << 26) - 1; //< longer delays are clamped (timers fire early)
+
+		private:
+			void Fire(std::size_t slotIndex, const FunctionRef<void(std::size_t timerId)>& callback);
+			void Insert(std::size_t timerId);
+			void Link(std::size_t timerId, std::size_t slotIndex);
+			void MoveSlot(std::size_t fromSlot, std::size_t toSlot);
+			void Unlink(std::size_t timerId);
+
+			static constexpr std::size_t InvalidIndex = std::numeric_limits<std::size_t>::max();
+			static constexpr std::size_t LevelCount = 4;
+			static constexpr std::size_t FirstLevelBits = 8;
+			static constexpr std::size_t LevelBits = 6;
+			static constexpr std::size_t SlotCount = (1 << FirstLevelBits) + (LevelCount - 1) * (1 << LevelBits);
+			static constexpr std::size_t DueSlot = SlotCount; //< timers whose deadline already passed
+			static constexpr std::size_t FiringSlot = SlotCount + 1; //< timers being fired
+
+			struct Timer
+			{
+				std::size_t next = InvalidIndex;
+				std::size_t previous = InvalidIndex;
+				std::size_t slot = InvalidIndex;
+				UInt32 deadline = 0;
+			};
+
+			std::array<std::size_t, SlotCount + 2> m_slots;
+			std::vector<Timer> m_timers;
+			std::size_t m_scheduledTimerCount = 0;
+			UInt32 m_currentTime = 0;
+	};
+}
+
+#include <Nazara/Core/TimerWheel.inl>
+
+#endif // NAZARA_CORE_TIMERWHEEL_HPP
@@ -0,0 +1,38 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <cassert>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	inline UInt32 TimerWheel::GetCurrentTime() const
+	{
+		return m_currentTime;
+	}
+
+	inline UInt32 TimerWheel::GetDeadline(std::size_t timerId) const
+	{
+		assert(timerId < m_timers.size());
+		return m_timers[timerId].deadline;
+	}
+
+	inline std::size_t TimerWheel::GetScheduledTimerCount() const
+	{
+		return m_scheduledTimerCount;
+	}
+
+	inline std::size_t TimerWheel::GetTimerCount() const
+	{
+		return m_timers.size();
+	}
+
+	inline bool TimerWheel::IsScheduled(std::size_t timerId) const
+	{
+		assert(timerId < m_timers.size());
+		return m_timers[timerId].slot != InvalidIndex;
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
@@ -0,0 +1,70 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_CORE_TIMINGSTATS_HPP
+#define NAZARA_CORE_TIMINGSTATS_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/Config.hpp>
+#include <Nazara/Core/Time.hpp>
+#include <array>
+#include <string>
+
+namespace Nz
+{
+	class NAZARA_CORE_API TimingStats
+	{
+		public:
+			static constexpr std::size_t HistogramBucketCount = 16;
+			static constexpr std::size_t WindowSize = 64;
+
+			inline TimingStats();
+			TimingStats(const TimingStats&) = default;
+			TimingStats(TimingStats&&) = default;
+			~TimingStats() = default;
+
+			inline void AddSample(Time duration);
+
+			Time GetAverageDuration() const;
+			inline Time GetBudget() const;
+			inline const std::array<UInt64, HistogramBucketCount>& GetHistogram() const;
+			inline Time GetLastDuration() const;
+			Time GetMaxDuration() const;
+			inline UInt64 GetOverBudgetCount() const;
+			inline Time GetPeakDuration() const;
+			inline UInt64 GetSampleCount() const;
+
+			inline bool IsOverBudget() const;
+
+			void Reset();
+
+			inline void SetBudget(Time budget);
+
+			std::string ToString() const;
+
+			TimingStats& operator=(const TimingStats&) = default;
+			TimingStats& operator=(TimingStats&&) = default;
+
+			static inline std::size_t GetHistogramBucket(Time duration);
+			static inline Time GetHistogramBucketLimit(std::size_t bucketIndex);
+
+			static constexpr Time HistogramBaseDuration = Time::Microseconds(8);
+
+		private:
+			std::array<Int64, WindowSize> m_window; //< last durations in nanoseconds, as a ring buffer
+			std::array<UInt64, HistogramBucketCount> m_histogram;
+			Int64 m_windowSum;
+			Time m_budget;
+			Time m_lastDuration;
+			Time m_peakDuration;
+			UInt64 m_overBudgetCount;
+			UInt64 m_sampleCount;
+	};
+}
+
+#include <Nazara/Core/TimingStats.inl>
+
+#endif // NAZARA_CORE_TIMINGSTATS_HPP
@@ -0,0 +1,148 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Error.hpp>
+#include <algorithm>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::TimingStats
+	* \brief Core class aggregating the durations of a repeated operation (such as an updater or a system update)
+	*
+	* Adding a sample is constant time and never allocates, which makes it cheap enough to stay enabled in production.
+	* Average and max durations are computed over the last WindowSize samples, while the peak duration, the histogram and the over budget count cover every sample since the last reset.
+	*
+	* \remark Samples are not synchronized, statistics should be read from the thread adding them or between updates
+	*/
+
+	inline TimingStats::TimingStats()
+	{
+		Reset();
+	}
+
+	/*!
+	* \brief Adds the duration of a run
+	*
+	* \param duration Duration of the run
+	*/
+	inline void TimingStats::AddSample(Time duration)
+	{
+		Int64 nanoseconds = duration.AsNanoseconds();
+
+		Int64& windowEntry = m_window[m_sampleCount % WindowSize];
+		m_windowSum += nanoseconds - windowEntry;
+		windowEntry = nanoseconds;
+
+		m_histogram[GetHistogramBucket(duration)]++;
+
+		m_lastDuration = duration;
+		if (duration > m_peakDuration)
+			m_peakDuration = duration;
+
+		if (m_budget > Time::Zero() && duration > m_budget)
+			m_overBudgetCount++;
+
+		m_sampleCount++;
+	}
+
+	/*!
+	* \brief Returns the budget of a run
+	* \return Budget duration, zero if no budget is set
+	*/
+	inline Time TimingStats::GetBudget() const
+	{
+		return m_budget;
+	}
+
+	/*!
+	* \brief Returns the number of samples of each histogram bucket
+	*
+	* Bucket i holds durations below GetHistogramBucketLimit(i) (and above the limit of the previous bucket), the last bucket holds every longer duration.
+	*/
+	inline auto TimingStats::GetHistogram() const -> const std::array<UInt64, HistogramBucketCount>&
+	{
+		return m_histogram;
+	}
+
+	inline Time TimingStats::GetLastDuration() const
+	{
+		return m_lastDuration;
+	}
+
+	/*!
+	* \brief Returns the number of samples which exceeded the budget since the last reset
+	*/
+	inline UInt64 TimingStats::GetOverBudgetCount() const
+	{
+		return m_overBudgetCount;
+	}
+
+	/*!
+	* \brief Returns the longest duration since the last reset
+	*/
+	inline Time TimingStats::GetPeakDuration() const
+	{
+		return m_peakDuration;
+	}
+
+	inline UInt64 TimingStats::GetSampleCount() const
+	{
+		return m_sampleCount;
+	}
+
+	/*!
+	* \brief Checks if the last sample exceeded the budget
+	* \return True if a budget is set and the last duration is over it
+	*/
+	inline bool TimingStats::IsOverBudget() const
+	{
+		return m_budget > Time::Zero() && m_lastDuration > m_budget;
+	}
+
+	/*!
+	* \brief Sets the maximum duration of a run, samples above it are counted as over budget
+	*
+	* \param budget Budget duration, zero to disable it
+	*/
+	inline void TimingStats::SetBudget(Time budget)
+	{
+		NazaraAssert(budget >= Time::Zero(), "budget must be positive");
+		m_budget = budget;
+	}
+
+	/*!
+	* \brief Returns the histogram bucket of a duration
+	*
+	* Buckets grow exponentially, from HistogramBaseDuration for the first one.
+	*/
+	inline std::size_t TimingStats::GetHistogramBucket(Time duration)
+	{
+		UInt64 value = static_cast<UInt64>(std::max(duration.AsNanoseconds(), Int64(0)) / HistogramBaseDuration.AsNanoseconds());
+
+		std::size_t bucketIndex = 0;
+		while (value > 0 && bucketIndex < HistogramBucketCount - 1)
+		{
+			value >>= 1;
+			bucketIndex++;
+		}
+
+		return bucketIndex;
+	}
+
+	/*!
+	* \brief Returns the (exclusive) upper limit of a histogram bucket
+	*
+	* \param bucketIndex Bucket index, the last bucket has no limit
+	*/
+	inline Time TimingStats::GetHistogramBucketLimit(std::size_t bucketIndex)
+	{
+		NazaraAssert(bucketIndex < HistogramBucketCount, "bucket index out of range");
+		return Time::Nanoseconds(HistogramBaseDuration.AsNanoseconds() << bucketIndex);
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
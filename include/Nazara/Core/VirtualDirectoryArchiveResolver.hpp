@@ -0,0 +1,45 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_CORE_VIRTUALDIRECTORYARCHIVERESOLVER_HPP
+#define NAZARA_CORE_VIRTUALDIRECTORYARCHIVERESOLVER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/Config.hpp>
+#include <Nazara/Core/VirtualDirectory.hpp>
+#include <memory>
+#include <string>
+
+namespace Nz
+{
+	class PackedArchive;
+
+	class NAZARA_CORE_API VirtualDirectoryArchiveResolver : public VirtualDirectoryResolver
+	{
+		public:
+			inline VirtualDirectoryArchiveResolver(std::shared_ptr<const PackedArchive> archive, std::string directoryPath = {});
+			VirtualDirectoryArchiveResolver(const VirtualDirectoryArchiveResolver&) = delete;
+			VirtualDirectoryArchiveResolver(VirtualDirectoryArchiveResolver&&) = delete;
+			~VirtualDirectoryArchiveResolver() = default;
+
+			void ForEach(std::weak_ptr<VirtualDirectory> parent, FunctionRef<bool(std::string_view name, VirtualDirectory::Entry&& entry)> callback) const override;
+
+			std::optional<VirtualDirectory::Entry> Resolve(std::weak_ptr<VirtualDirectory> parent, const std::string_view* parts, std::size_t partCount) const override;
+
+			VirtualDirectoryArchiveResolver& operator=(const VirtualDirectoryArchiveResolver&) = delete;
+			VirtualDirectoryArchiveResolver& operator=(VirtualDirectoryArchiveResolver&&) = delete;
+
+		private:
+			VirtualDirectoryPtr MakeDirectory(std::weak_ptr<VirtualDirectory> parent, std::string directoryPath) const;
+
+			std::shared_ptr<const PackedArchive> m_archive;
+			std::string m_directoryPath; //< relative to the archive root, empty for root
+	};
+}
+
+#include <Nazara/Core/VirtualDirectoryArchiveResolver.inl>
+
+#endif // NAZARA_CORE_VIRTUALDIRECTORYARCHIVERESOLVER_HPP
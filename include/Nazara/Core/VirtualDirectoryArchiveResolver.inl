@@ -0,0 +1,16 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	inline VirtualDirectoryArchiveResolver::VirtualDirectoryArchiveResolver(std::shared_ptr<const PackedArchive> archive, std::string directoryPath) :
+	m_archive(std::move(archive)),
+	m_directoryPath(std::move(directoryPath))
+	{
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
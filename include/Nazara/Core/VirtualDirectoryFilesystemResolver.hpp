@@ -11,6 +11,9 @@
 #include <Nazara/Core/Config.hpp>
 #include <Nazara/Core/VirtualDirectory.hpp>
 #include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
 
 namespace Nz
 {
@@ -22,6 +25,8 @@ namespace Nz
 			VirtualDirectoryFilesystemResolver(VirtualDirectoryFilesystemResolver&&) = delete;
 			~VirtualDirectoryFilesystemResolver() = default;
 
+			inline void ClearCache();
+
 			void ForEach(std::weak_ptr<VirtualDirectory> parent, FunctionRef<bool(std::string_view name, VirtualDirectory::Entry&& entry)> callback) const override;
 
 			std::optional<VirtualDirectory::Entry> Resolve(std::weak_ptr<VirtualDirectory> parent, const std::string_view* parts, std::size_t partCount) const override;
@@ -30,6 +35,16 @@ namespace Nz
 			VirtualDirectoryFilesystemResolver& operator=(VirtualDirectoryFilesystemResolver&&) = delete;
 
 		private:
+			struct CachedEntry
+			{
+				std::filesystem::path physicalPath;
+				std::shared_ptr<VirtualDirectoryFilesystemResolver> directoryResolver; //< null for files
+			};
+
+			const CachedEntry& CacheEntry(std::string relativePath, std::filesystem::path physicalPath, bool isDirectory) const;
+			VirtualDirectory::Entry MakeEntry(const CachedEntry& cachedEntry, std::weak_ptr<VirtualDirectory> parent) const;
+
+			mutable std::unordered_map<std::string, CachedEntry> m_cachedEntries; //< indexed by relative path
 			std::filesystem::path m_physicalPath;
 			OpenModeFlags m_fileOpenMode;
 	};
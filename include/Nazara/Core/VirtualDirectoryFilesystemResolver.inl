@@ -11,6 +11,16 @@ namespace Nz
 	m_fileOpenMode(fileOpenMode)
 	{
 	}
+
+	/*!
+	* \brief Forgets about previously resolved files and directories, so they are checked again on the filesystem
+	*
+	* \remark Subdirectories resolved from this one keep their own cache
+	*/
+	inline void VirtualDirectoryFilesystemResolver::ClearCache()
+	{
+		m_cachedEntries.clear();
+	}
 }
 
 #include <Nazara/Core/DebugOff.hpp>
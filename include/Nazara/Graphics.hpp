@@ -30,11 +30,16 @@
 #define NAZARA_GLOBAL_GRAPHICS_HPP
 
 #include <Nazara/Graphics/AbstractViewer.hpp>
+#include <Nazara/Graphics/AnimationTexture.hpp>
 #include <Nazara/Graphics/Algorithm.hpp>
 #include <Nazara/Graphics/BakedFrameGraph.hpp>
+#include <Nazara/Graphics/BindlessTextureTable.hpp>
 #include <Nazara/Graphics/Camera.hpp>
+#include <Nazara/Graphics/ClipmapTerrain.hpp>
 #include <Nazara/Graphics/Config.hpp>
 #include <Nazara/Graphics/DebugDrawPipelinePass.hpp>
+#include <Nazara/Graphics/DeferredFramePipeline.hpp>
+#include <Nazara/Graphics/DeferredLightingPipelinePass.hpp>
 #include <Nazara/Graphics/DepthPipelinePass.hpp>
 #include <Nazara/Graphics/DirectionalLight.hpp>
 #include <Nazara/Graphics/ElementRenderer.hpp>
@@ -51,6 +56,9 @@
 #include <Nazara/Graphics/GraphicalMesh.hpp>
 #include <Nazara/Graphics/Graphics.hpp>
 #include <Nazara/Graphics/GuillotineTextureAtlas.hpp>
+#include <Nazara/Graphics/ImageStreamTexture.hpp>
+#include <Nazara/Graphics/ImpostorAtlas.hpp>
+#include <Nazara/Graphics/ImpostorRenderer.hpp>
 #include <Nazara/Graphics/InstancedRenderable.hpp>
 #include <Nazara/Graphics/Light.hpp>
 #include <Nazara/Graphics/LightShadowData.hpp>
@@ -61,7 +69,10 @@
 #include <Nazara/Graphics/MaterialPassRegistry.hpp>
 #include <Nazara/Graphics/MaterialPipeline.hpp>
 #include <Nazara/Graphics/MaterialSettings.hpp>
+#include <Nazara/Graphics/MeshArena.hpp>
 #include <Nazara/Graphics/Model.hpp>
+#include <Nazara/Graphics/ParticleEmitter.hpp>
+#include <Nazara/Graphics/ParticleRenderer.hpp>
 #include <Nazara/Graphics/PointLight.hpp>
 #include <Nazara/Graphics/PointLightShadowData.hpp>
 #include <Nazara/Graphics/PredefinedMaterials.hpp>
@@ -70,11 +81,16 @@
 #include <Nazara/Graphics/RenderElement.hpp>
 #include <Nazara/Graphics/RenderElementOwner.hpp>
 #include <Nazara/Graphics/RenderElementPool.hpp>
+#include <Nazara/Graphics/RenderImpostor.hpp>
+#include <Nazara/Graphics/RenderParticles.hpp>
 #include <Nazara/Graphics/RenderQueue.hpp>
 #include <Nazara/Graphics/RenderQueueRegistry.hpp>
 #include <Nazara/Graphics/RenderSpriteChain.hpp>
 #include <Nazara/Graphics/RenderSubmesh.hpp>
+#include <Nazara/Graphics/RenderTerrain.hpp>
+#include <Nazara/Graphics/ShaderBindingCache.hpp>
 #include <Nazara/Graphics/ShaderReflection.hpp>
+#include <Nazara/Graphics/ShaderVariantArchive.hpp>
 #include <Nazara/Graphics/ShadowViewer.hpp>
 #include <Nazara/Graphics/SkeletonInstance.hpp>
 #include <Nazara/Graphics/SlicedSprite.hpp>
@@ -82,12 +98,16 @@
 #include <Nazara/Graphics/SpotLightShadowData.hpp>
 #include <Nazara/Graphics/Sprite.hpp>
 #include <Nazara/Graphics/SpriteChainRenderer.hpp>
+#include <Nazara/Graphics/StaticBatcher.hpp>
 #include <Nazara/Graphics/SubmeshRenderer.hpp>
+#include <Nazara/Graphics/TerrainRenderer.hpp>
 #include <Nazara/Graphics/TextSprite.hpp>
 #include <Nazara/Graphics/TextureSamplerCache.hpp>
+#include <Nazara/Graphics/TextureStreamer.hpp>
 #include <Nazara/Graphics/Tilemap.hpp>
 #include <Nazara/Graphics/TransferInterface.hpp>
 #include <Nazara/Graphics/UberShader.hpp>
+#include <Nazara/Graphics/UpscalePipelinePass.hpp>
 #include <Nazara/Graphics/ViewerInstance.hpp>
 #include <Nazara/Graphics/WorldInstance.hpp>
 
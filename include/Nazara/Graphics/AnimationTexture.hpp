@@ -0,0 +1,66 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_GRAPHICS_ANIMATIONTEXTURE_HPP
+#define NAZARA_GRAPHICS_ANIMATIONTEXTURE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Graphics/Config.hpp>
+#include <Nazara/Math/Vector2.hpp>
+#include <Nazara/Utility/Sequence.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Nz
+{
+	class Animation;
+	class Skeleton;
+	class Texture;
+
+	class NAZARA_GRAPHICS_API AnimationTexture
+	{
+		public:
+			struct FrameSample;
+
+			AnimationTexture(const Animation& animation, const Skeleton& skeleton);
+			AnimationTexture(const AnimationTexture&) = delete;
+			AnimationTexture(AnimationTexture&&) noexcept = default;
+			~AnimationTexture() = default;
+
+			inline const Sequence& GetClip(std::size_t clipIndex) const;
+			inline std::size_t GetClipCount() const;
+			std::size_t GetClipIndex(const std::string& clipName) const;
+			inline std::size_t GetFrameCount() const;
+			inline std::size_t GetJointCount() const;
+			inline float GetTexelWidth() const;
+			inline const std::shared_ptr<Texture>& GetTexture() const;
+
+			FrameSample Sample(std::size_t clipIndex, float time) const;
+
+			AnimationTexture& operator=(const AnimationTexture&) = delete;
+			AnimationTexture& operator=(AnimationTexture&&) noexcept = default;
+
+			static constexpr std::size_t TexelPerJoint = 4;
+
+			struct FrameSample
+			{
+				Vector2f frameCoords; //< texture V coordinates of both frames
+				float interpolation;
+			};
+
+		private:
+			std::shared_ptr<Texture> m_texture;
+			std::vector<Sequence> m_clips;
+			std::size_t m_frameCount;
+			std::size_t m_jointCount;
+			bool m_loopPointInterpolation;
+	};
+}
+
+#include <Nazara/Graphics/AnimationTexture.inl>
+
+#endif // NAZARA_GRAPHICS_ANIMATIONTEXTURE_HPP
@@ -0,0 +1,42 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	inline const Sequence& AnimationTexture::GetClip(std::size_t clipIndex) const
+	{
+		NazaraAssert(clipIndex < m_clips.size(), "clip index out of range");
+		return m_clips[clipIndex];
+	}
+
+	inline std::size_t AnimationTexture::GetClipCount() const
+	{
+		return m_clips.size();
+	}
+
+	inline std::size_t AnimationTexture::GetFrameCount() const
+	{
+		return m_frameCount;
+	}
+
+	inline std::size_t AnimationTexture::GetJointCount() const
+	{
+		return m_jointCount;
+	}
+
+	inline float AnimationTexture::GetTexelWidth() const
+	{
+		return 1.f / float(m_jointCount * TexelPerJoint);
+	}
+
+	inline const std::shared_ptr<Texture>& AnimationTexture::GetTexture() const
+	{
+		return m_texture;
+	}
+}
+
+#include <Nazara/Graphics/DebugOff.hpp>
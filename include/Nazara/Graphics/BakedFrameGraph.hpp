@@ -38,7 +38,7 @@ namespace Nz
 			const std::shared_ptr<Texture>& GetAttachmentTexture(std::size_t attachmentIndex) const;
 			const std::shared_ptr<RenderPass>& GetRenderPass(std::size_t passIndex) const;
 
-			bool Resize(RenderFrame& renderFrame);
+			bool Resize(RenderFrame& renderFrame, const BakedFrameGraph* textureSource = nullptr);
 
 			BakedFrameGraph& operator=(const BakedFrameGraph&) = delete;
 			BakedFrameGraph& operator=(BakedFrameGraph&&) noexcept = default;
@@ -51,6 +51,8 @@ namespace Nz
 
 			BakedFrameGraph(std::vector<PassData> passes, std::vector<TextureData> textures, AttachmentIdToTextureId attachmentIdToTextureMapping, PassIdToPhysicalPassIndex passIdToPhysicalPassMapping);
 
+			void RecordPass(PassData& passData, RenderFrame& renderFrame);
+
 			struct TextureBarrier
 			{
 				std::size_t textureId;
@@ -58,6 +60,8 @@ namespace Nz
 				MemoryAccessFlags srcAccessMask;
 				PipelineStageFlags dstStageMask;
 				PipelineStageFlags srcStageMask;
+				QueueType dstQueue = QueueType::Graphics;
+				QueueType srcQueue = QueueType::Graphics; //< barriers between queues are split in a release and an acquire barrier
 				TextureLayout newLayout;
 				TextureLayout oldLayout;
 			};
@@ -65,10 +69,14 @@ namespace Nz
 			struct SubpassData
 			{
 				FramePass::CommandCallback commandCallback;
+				FramePass::ExecutionCallback executionCallback;
+				std::size_t passIndex;
+				bool isSkipped = false;
 			};
 
 			struct PassData
 			{
+				std::shared_ptr<CommandPool> commandPool;
 				CommandBufferPtr commandBuffer;
 				std::shared_ptr<Framebuffer> framebuffer;
 				std::shared_ptr<RenderPass> renderPass;
@@ -77,8 +85,11 @@ namespace Nz
 				std::vector<CommandBufferBuilder::ClearValues> outputClearValues;
 				std::vector<SubpassData> subpasses;
 				std::vector<TextureBarrier> invalidationBarriers;
-				FramePass::ExecutionCallback executionCallback;
+				std::vector<TextureBarrier> releaseBarriers; //< queue ownership transfers to passes on other queues
+				QueueType queueType = QueueType::Graphics;
+				QueueTypeFlags waitedQueues;
 				Recti renderRect;
+				const char* zoneName = nullptr; //< interned pass name, for the profiler
 				bool forceCommandBufferRegeneration = true;
 			};
 
@@ -87,13 +98,14 @@ namespace Nz
 				std::shared_ptr<Texture> texture;
 			};
 
-			std::shared_ptr<CommandPool> m_commandPool;
+			std::vector<PassData*> m_passesToRecord;
 			std::vector<PassData> m_passes;
 			std::vector<TextureData> m_textures;
 			AttachmentIdToTextureId m_attachmentToTextureMapping;
 			PassIdToPhysicalPassIndex m_passIdToPhysicalPassMapping;
 			unsigned int m_height;
 			unsigned int m_width;
+			bool m_parallelRecording;
 	};
 }
 
@@ -0,0 +1,97 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_GRAPHICS_BINDLESSTEXTURETABLE_HPP
+#define NAZARA_GRAPHICS_BINDLESSTEXTURETABLE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Graphics/Config.hpp>
+#include <Nazara/Renderer/RenderPipelineLayout.hpp>
+#include <Nazara/Renderer/ShaderBinding.hpp>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Nz
+{
+	class RenderDevice;
+	class RenderFrame;
+	class Texture;
+	class TextureSampler;
+
+	/*!
+	* \brief Device-wide array of sampled 2D textures, indexed by shaders
+	*
+	* Materials declaring the table (see Material) store the slots of their textures in a storage buffer instead of binding the textures themselves,
+	* which keeps their shader bindings unchanged when textures are replaced.
+	* The table is bound to its own descriptor set (SetIndex), slots released while frames may still use them are only reused once these frames are over.
+	*/
+	class NAZARA_GRAPHICS_API BindlessTextureTable
+	{
+		public:
+			BindlessTextureTable(std::shared_ptr<RenderDevice> renderDevice);
+			BindlessTextureTable(const BindlessTextureTable&) = delete;
+			BindlessTextureTable(BindlessTextureTable&&) = delete;
+			~BindlessTextureTable() = default;
+
+			inline const std::shared_ptr<RenderPipelineLayout>& GetPipelineLayout() const;
+			inline const ShaderBinding& GetShaderBinding() const;
+			inline UInt32 GetUsedSlotCount() const;
+
+			UInt32 Register(std::shared_ptr<Texture> texture, std::shared_ptr<TextureSampler> sampler);
+			void Unregister(UInt32 slot);
+
+			void Update(RenderFrame& renderFrame);
+
+			BindlessTextureTable& operator=(const BindlessTextureTable&) = delete;
+			BindlessTextureTable& operator=(BindlessTextureTable&&) = delete;
+
+			static RenderPipelineLayoutInfo::Binding GetBindingInfo();
+
+			static constexpr UInt32 BindingIndex = 0;
+			static constexpr UInt32 InvalidSlot = std::numeric_limits<UInt32>::max();
+			static constexpr UInt32 MaxTextureCount = 4096; //< must match the MaxBindlessTextureCount shader option set by Material
+			static constexpr UInt32 SetIndex = 1;
+
+		private:
+			using SlotKey = std::pair<const Texture*, const TextureSampler*>;
+
+			struct SlotKeyHasher
+			{
+				inline std::size_t operator()(const SlotKey& key) const;
+			};
+
+			struct Slot
+			{
+				std::shared_ptr<Texture> texture;
+				std::shared_ptr<TextureSampler> sampler;
+				std::size_t refCount = 0;
+			};
+
+			struct FreeSlotList
+			{
+				std::mutex mutex;
+				std::vector<UInt32> slots;
+			};
+
+			std::shared_ptr<FreeSlotList> m_freeSlots; //< shared with release callbacks, which may run after the table is destroyed
+			std::shared_ptr<RenderPipelineLayout> m_pipelineLayout;
+			std::unordered_map<SlotKey, UInt32, SlotKeyHasher> m_slotByKey;
+			std::vector<Slot> m_releasedSlots; //< keeps textures alive until the frames which may sample them are over
+			std::vector<Slot> m_slots;
+			std::vector<UInt32> m_releasedSlotIndices;
+			ShaderBindingPtr m_shaderBinding;
+			mutable std::mutex m_mutex;
+			UInt32 m_usedSlotCount;
+	};
+}
+
+#include <Nazara/Graphics/BindlessTextureTable.inl>
+
+#endif // NAZARA_GRAPHICS_BINDLESSTEXTURETABLE_HPP
@@ -0,0 +1,36 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <NazaraUtils/Hash.hpp>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	inline const std::shared_ptr<RenderPipelineLayout>& BindlessTextureTable::GetPipelineLayout() const
+	{
+		return m_pipelineLayout;
+	}
+
+	inline const ShaderBinding& BindlessTextureTable::GetShaderBinding() const
+	{
+		return *m_shaderBinding;
+	}
+
+	inline UInt32 BindlessTextureTable::GetUsedSlotCount() const
+	{
+		std::lock_guard lock(m_mutex);
+		return m_usedSlotCount;
+	}
+
+	inline std::size_t BindlessTextureTable::SlotKeyHasher::operator()(const SlotKey& key) const
+	{
+		std::size_t seed = 0;
+		HashCombine(seed, key.first);
+		HashCombine(seed, key.second);
+
+		return seed;
+	}
+}
+
+#include <Nazara/Graphics/DebugOff.hpp>
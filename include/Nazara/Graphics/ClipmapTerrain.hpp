@@ -0,0 +1,98 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_GRAPHICS_CLIPMAPTERRAIN_HPP
+#define NAZARA_GRAPHICS_CLIPMAPTERRAIN_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Graphics/InstancedRenderable.hpp>
+#include <Nazara/Graphics/TextureStreamer.hpp>
+#include <Nazara/Math/Vector2.hpp>
+#include <NazaraUtils/Bitset.hpp>
+#include <NazaraUtils/Signal.hpp>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Nz
+{
+	class RenderBuffer;
+	class Texture;
+
+	// Requires Graphics::Config::useTerrain, Update has to be called every frame with the position of the viewer
+	class NAZARA_GRAPHICS_API ClipmapTerrain : public InstancedRenderable
+	{
+		public:
+			struct Params;
+
+			ClipmapTerrain(TextureStreamer& textureStreamer, Params params);
+			ClipmapTerrain(const ClipmapTerrain&) = delete;
+			ClipmapTerrain(ClipmapTerrain&&) = delete;
+			~ClipmapTerrain() = default;
+
+			void BuildElement(ElementRendererRegistry& registry, const ElementData& elementData, std::size_t passIndex, std::vector<RenderElementOwner>& elements) const override;
+
+			inline const std::shared_ptr<Texture>& GetColorClipmap() const;
+			inline const std::shared_ptr<Texture>& GetHeightClipmap() const;
+			inline const std::shared_ptr<RenderBuffer>& GetIndexBuffer() const;
+			inline UInt32 GetIndexCount() const;
+			inline UInt32 GetLevelCount() const;
+			const std::shared_ptr<MaterialInstance>& GetMaterial(std::size_t i) const override;
+			std::size_t GetMaterialCount() const override;
+			inline const Params& GetParams() const;
+			inline const std::shared_ptr<RenderBuffer>& GetTerrainBuffer() const;
+
+			void Update(RenderFrame& renderFrame, const Vector3f& viewerPosition);
+
+			ClipmapTerrain& operator=(const ClipmapTerrain&) = delete;
+			ClipmapTerrain& operator=(ClipmapTerrain&&) = delete;
+
+			static constexpr UInt32 MaxLevelCount = 16;
+
+			struct Params
+			{
+				std::vector<std::size_t> colorChunks; //< streamed textures giving the terrain color (optional), same layout as heightChunks
+				std::vector<std::size_t> heightChunks; //< streamed textures holding normalized heights in their red channel, row by row
+				Vector2ui chunkCount = Vector2ui(1, 1);
+				UInt32 chunkSize = 512; //< texels on each side of a chunk finest level, must be a power of two
+				UInt32 gridSize = 64; //< cells on each side of a clipmap level, must be a multiple of four
+				UInt32 levelCount = 6; //< every level covers twice the size of the previous one
+				float heightScale = 100.f; //< height of a texel of value one
+				float texelSize = 1.f; //< distance between two texels of the finest level
+			};
+
+		private:
+			struct LevelData;
+
+			bool ComputeChunkRange(const LevelData& level, UInt32 levelIndex, Vector2ui& firstChunk, Vector2ui& lastChunk) const;
+			void RefreshChunk(CommandBufferBuilder& builder, RenderFrame& renderFrame, Texture& chunkTexture, UInt8 residentLevel, const Vector2ui& chunk, UInt32 levelIndex, const Texture& clipmap);
+
+			struct LevelData
+			{
+				Vector2i origin = Vector2i(0, 0); //< position of the first vertex, in finest texels
+				bool isDirty = true;
+			};
+
+			NazaraSlot(TextureStreamer, OnTextureResidencyChanged, m_onTextureResidencyChanged);
+
+			std::shared_ptr<RenderBuffer> m_indexBuffer;
+			std::shared_ptr<RenderBuffer> m_terrainBuffer;
+			std::shared_ptr<Texture> m_colorClipmap;
+			std::shared_ptr<Texture> m_heightClipmap;
+			std::unordered_map<std::size_t, std::size_t> m_chunkByTexture;
+			std::vector<LevelData> m_levels;
+			std::vector<UInt32> m_chunkLevels; //< finest level covering every chunk, computed by Update
+			Bitset<UInt64> m_dirtyChunks;
+			Params m_params;
+			TextureStreamer& m_textureStreamer;
+			bool m_areClipmapsInitialized;
+			bool m_isTerrainBufferDirty;
+	};
+}
+
+#include <Nazara/Graphics/ClipmapTerrain.inl>
+
+#endif // NAZARA_GRAPHICS_CLIPMAPTERRAIN_HPP
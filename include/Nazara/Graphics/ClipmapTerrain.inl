@@ -0,0 +1,57 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Returns the texture holding the color of every level side by side, or a white texture if the terrain has no color chunk
+	*/
+	inline const std::shared_ptr<Texture>& ClipmapTerrain::GetColorClipmap() const
+	{
+		return m_colorClipmap;
+	}
+
+	/*!
+	* \brief Returns the texture holding the heights of every level side by side, read by the TerrainRender shader
+	*/
+	inline const std::shared_ptr<Texture>& ClipmapTerrain::GetHeightClipmap() const
+	{
+		return m_heightClipmap;
+	}
+
+	/*!
+	* \brief Returns the index buffer of the grid shared by every level
+	*/
+	inline const std::shared_ptr<RenderBuffer>& ClipmapTerrain::GetIndexBuffer() const
+	{
+		return m_indexBuffer;
+	}
+
+	inline UInt32 ClipmapTerrain::GetIndexCount() const
+	{
+		return m_params.gridSize * m_params.gridSize * 6;
+	}
+
+	inline UInt32 ClipmapTerrain::GetLevelCount() const
+	{
+		return m_params.levelCount;
+	}
+
+	inline auto ClipmapTerrain::GetParams() const -> const Params&
+	{
+		return m_params;
+	}
+
+	/*!
+	* \brief Returns the uniform buffer holding the level positions read by the TerrainRender shader
+	*/
+	inline const std::shared_ptr<RenderBuffer>& ClipmapTerrain::GetTerrainBuffer() const
+	{
+		return m_terrainBuffer;
+	}
+}
+
+#include <Nazara/Graphics/DebugOff.hpp>
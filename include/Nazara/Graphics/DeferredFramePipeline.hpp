@@ -0,0 +1,39 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_GRAPHICS_DEFERREDFRAMEPIPELINE_HPP
+#define NAZARA_GRAPHICS_DEFERREDFRAMEPIPELINE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Graphics/Config.hpp>
+#include <Nazara/Graphics/ForwardFramePipeline.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Frame pipeline shading opaque materials in screen space
+	*
+	* Materials having a "GBufferPass" pass (opaque Phong materials by default) are rendered to a G-buffer, which is then lit by every visible light in a single pass (see DeferredLightingPipelinePass).
+	* Other materials (transparent, unlit or PBR) are rendered by the forward pass on top of the lit G-buffer, as with ForwardFramePipeline.
+	*
+	* Requires Graphics::Config::useDeferredShading, otherwise behaves as a ForwardFramePipeline.
+	*/
+	class NAZARA_GRAPHICS_API DeferredFramePipeline : public ForwardFramePipeline
+	{
+		public:
+			DeferredFramePipeline(ElementRendererRegistry& elementRegistry);
+			DeferredFramePipeline(const DeferredFramePipeline&) = delete;
+			DeferredFramePipeline(DeferredFramePipeline&&) = delete;
+			~DeferredFramePipeline() = default;
+
+			DeferredFramePipeline& operator=(const DeferredFramePipeline&) = delete;
+			DeferredFramePipeline& operator=(DeferredFramePipeline&&) = delete;
+	};
+}
+
+#include <Nazara/Graphics/DeferredFramePipeline.inl>
+
+#endif // NAZARA_GRAPHICS_DEFERREDFRAMEPIPELINE_HPP
@@ -0,0 +1,95 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_GRAPHICS_DEFERREDLIGHTINGPIPELINEPASS_HPP
+#define NAZARA_GRAPHICS_DEFERREDLIGHTINGPIPELINEPASS_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Graphics/Config.hpp>
+#include <Nazara/Graphics/FramePipelinePass.hpp>
+#include <Nazara/Math/Rect.hpp>
+#include <Nazara/Renderer/ShaderBinding.hpp>
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace Nz
+{
+	class AbstractViewer;
+	class BakedFrameGraph;
+	class FrameGraph;
+	class FramePass;
+	class FramePipeline;
+	class Light;
+	class RenderBuffer;
+	class Texture;
+
+	/*!
+	* \brief Shades the G-buffer of a viewer with all its visible lights in a single fullscreen pass
+	*
+	* Lights are binned in screen tiles of TileSize pixels on the CPU (from their projected bounds) and every pixel only evaluates the lights of its tile.
+	* The first MaxShadowedLightCount shadow casting lights are evaluated with their shadow maps for every pixel, others lights are unshadowed.
+	*
+	* G-buffer layout: albedo and ambient intensity (RGBA8), world normal and shininess (RGBA16F, a null normal marks unlit pixels) and specular color (RGBA8).
+	*/
+	class NAZARA_GRAPHICS_API DeferredLightingPipelinePass : public FramePipelinePass
+	{
+		public:
+			static constexpr std::size_t GBufferCount = 3;
+			static constexpr std::size_t MaxShadowedLightCount = 4;
+			static constexpr unsigned int TileSize = 16;
+
+			DeferredLightingPipelinePass(FramePipeline& owner, AbstractViewer* viewer);
+			DeferredLightingPipelinePass(const DeferredLightingPipelinePass&) = delete;
+			DeferredLightingPipelinePass(DeferredLightingPipelinePass&&) = delete;
+			~DeferredLightingPipelinePass();
+
+			void Prepare(RenderFrame& renderFrame, const BakedFrameGraph& bakedGraph, const std::vector<std::size_t>& visibleLights);
+
+			FramePass& RegisterToFrameGraph(FrameGraph& frameGraph, const std::array<std::size_t, GBufferCount>& gbufferIndices, std::size_t depthBufferIndex, std::size_t outputColorBufferIndex);
+
+			DeferredLightingPipelinePass& operator=(const DeferredLightingPipelinePass&) = delete;
+			DeferredLightingPipelinePass& operator=(DeferredLightingPipelinePass&&) = delete;
+
+		private:
+			void BinLights(void* tileDataPtr);
+			std::size_t ComputeTileDataSize(const Recti& viewport);
+			void UpdateShaderBinding(RenderFrame& renderFrame);
+
+			struct LightTileRange
+			{
+				unsigned int firstX;
+				unsigned int firstY;
+				unsigned int lastX;
+				unsigned int lastY;
+			};
+
+			std::array<std::size_t, GBufferCount> m_gbufferAttachments;
+			std::array<const Texture*, GBufferCount + 1> m_boundTextures; //< G-buffer and depth textures
+			std::array<const Texture*, MaxShadowedLightCount> m_shadowMaps;
+			std::shared_ptr<RenderBuffer> m_lightBuffer;
+			std::shared_ptr<RenderBuffer> m_lightingDataBuffer;
+			std::shared_ptr<RenderBuffer> m_tileBuffer;
+			std::size_t m_depthAttachment;
+			std::size_t m_shadowedLightCount;
+			std::vector<const Light*> m_lights; //< shadowed lights first
+			std::vector<std::size_t> m_lightIndices;
+			std::vector<LightTileRange> m_lightTileRanges;
+			std::vector<UInt32> m_tileLightCounts;
+			std::vector<UInt32> m_tileOffsets;
+			AbstractViewer* m_viewer;
+			FramePipeline& m_pipeline;
+			Recti m_lastViewport;
+			ShaderBindingPtr m_shaderBinding;
+			unsigned int m_tileCountX;
+			unsigned int m_tileCountY;
+			bool m_rebuildCommandBuffer;
+	};
+}
+
+#include <Nazara/Graphics/DeferredLightingPipelinePass.inl>
+
+#endif // NAZARA_GRAPHICS_DEFERREDLIGHTINGPIPELINEPASS_HPP
@@ -18,6 +18,7 @@
 #include <Nazara/Graphics/RenderQueue.hpp>
 #include <Nazara/Graphics/RenderQueueRegistry.hpp>
 #include <Nazara/Math/Frustum.hpp>
+#include <initializer_list>
 
 namespace Nz
 {
@@ -42,6 +43,7 @@ namespace Nz
 
 			void RegisterMaterialInstance(const MaterialInstance& materialInstance);
 			FramePass& RegisterToFrameGraph(FrameGraph& frameGraph, std::size_t outputAttachment);
+			FramePass& RegisterToFrameGraph(FrameGraph& frameGraph, std::initializer_list<std::size_t> colorOutputAttachments, std::size_t depthOutputAttachment);
 
 			void UnregisterMaterialInstance(const MaterialInstance& materialInstance);
 
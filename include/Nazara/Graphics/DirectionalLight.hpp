@@ -24,7 +24,7 @@ namespace Nz
 			DirectionalLight(DirectionalLight&&) noexcept = default;
 			~DirectionalLight() = default;
 
-			float ComputeContributionScore(const BoundingVolumef& boundingVolume) const override;
+			float ComputeContributionScore(const Boxf& worldAABB) const override;
 
 			void FillLightData(void* data) const override;
 
@@ -35,12 +35,14 @@ namespace Nz
 			inline Color GetColor() const;
 			inline const Vector3f& GetDirection() const;
 			inline const Quaternionf& GetRotation() const;
+			inline float GetShadowMaxDistance() const;
 
 			inline void UpdateAmbientFactor(float factor);
 			inline void UpdateColor(Color color);
 			inline void UpdateDiffuseFactor(float factor);
 			inline void UpdateDirection(const Vector3f& direction);
 			inline void UpdateRotation(const Quaternionf& rotation);
+			inline void UpdateShadowMaxDistance(float maxDistance);
 
 			void UpdateTransform(const Vector3f& position, const Quaternionf& rotation, const Vector3f& scale) override;
 
@@ -55,6 +57,7 @@ namespace Nz
 			Vector3f m_direction;
 			float m_ambientFactor;
 			float m_diffuseFactor;
+			float m_shadowMaxDistance;
 	};
 }
 
@@ -12,7 +12,8 @@ namespace Nz
 	Light(SafeCast<UInt8>(BasicLightType::Directional)),
 	m_color(Color::White()),
 	m_ambientFactor(0.2f),
-	m_diffuseFactor(1.f)
+	m_diffuseFactor(1.f),
+	m_shadowMaxDistance(100.f)
 	{
 		UpdateRotation(Quaternionf::Identity());
 	}
@@ -42,6 +43,16 @@ namespace Nz
 		return m_diffuseFactor;
 	}
 
+	/*!
+	* \brief Returns the distance from the viewer up to which shadows are rendered
+	*
+	* Cascades of the shadow map are split over this distance (or the viewer far plane if closer).
+	*/
+	inline float DirectionalLight::GetShadowMaxDistance() const
+	{
+		return m_shadowMaxDistance;
+	}
+
 	inline void DirectionalLight::UpdateAmbientFactor(float factor)
 	{
 		m_ambientFactor = factor;
@@ -76,6 +87,14 @@ namespace Nz
 		UpdateBoundingVolume();
 	}
 
+	inline void DirectionalLight::UpdateShadowMaxDistance(float maxDistance)
+	{
+		assert(maxDistance > 0.f);
+		m_shadowMaxDistance = maxDistance;
+
+		OnLightDataInvalided(this);
+	}
+
 	inline void DirectionalLight::UpdateBoundingVolume()
 	{
 		Light::UpdateBoundingVolume(BoundingVolumef::Infinite()); //< will trigger OnLightDataInvalided
@@ -0,0 +1,103 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_GRAPHICS_DIRECTIONALLIGHTSHADOWDATA_HPP
+#define NAZARA_GRAPHICS_DIRECTIONALLIGHTSHADOWDATA_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Graphics/Config.hpp>
+#include <Nazara/Graphics/DepthPipelinePass.hpp>
+#include <Nazara/Graphics/Light.hpp>
+#include <Nazara/Graphics/LightShadowData.hpp>
+#include <Nazara/Graphics/PredefinedShaderStructs.hpp>
+#include <Nazara/Graphics/ShadowViewer.hpp>
+#include <Nazara/Math/Frustum.hpp>
+#include <Nazara/Math/Matrix4.hpp>
+#include <Nazara/Math/Vector3.hpp>
+#include <array>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+namespace Nz
+{
+	class DirectionalLight;
+	class FramePipeline;
+	class ViewerInstance;
+
+	class NAZARA_GRAPHICS_API DirectionalLightShadowData : public LightShadowData
+	{
+		public:
+			DirectionalLightShadowData(FramePipeline& pipeline, ElementRendererRegistry& elementRegistry, const DirectionalLight& light);
+			DirectionalLightShadowData(const DirectionalLightShadowData&) = delete;
+			DirectionalLightShadowData(DirectionalLightShadowData&&) = delete;
+			~DirectionalLightShadowData() = default;
+
+			void FillShadowData(void* data, const AbstractViewer* viewer) const override;
+
+			void PrepareRendering(RenderFrame& renderFrame, const AbstractViewer* viewer) override;
+
+			void RegisterMaterialInstance(const MaterialInstance& matInstance) override;
+			void RegisterPassInputs(FramePass& pass, const AbstractViewer* viewer) override;
+			void RegisterToFrameGraph(FrameGraph& frameGraph, const AbstractViewer* viewer) override;
+			void RegisterViewer(const AbstractViewer* viewer) override;
+
+			const Texture* RetrieveLightShadowmap(const BakedFrameGraph& bakedGraph, const AbstractViewer* viewer) const override;
+
+			void UnregisterMaterialInstance(const MaterialInstance& matInstance) override;
+			void UnregisterViewer(RenderFrame& renderFrame, const AbstractViewer* viewer) override;
+
+			DirectionalLightShadowData& operator=(const DirectionalLightShadowData&) = delete;
+			DirectionalLightShadowData& operator=(DirectionalLightShadowData&&) = delete;
+
+			static constexpr std::size_t CascadeCount = PredefinedLightData::MaxLightCascadeCount;
+
+		private:
+			struct CascadeBounds
+			{
+				Vector3f center;
+				float radius;
+			};
+
+			struct CascadeData
+			{
+				std::optional<DepthPipelinePass> depthPass;
+				std::size_t attachmentIndex;
+				Frustumf frustum;
+				Matrix4f shadowMatrix; //< from world space to shadow map coordinates (with bias)
+				ShadowViewer viewer;
+				Vector3f lightSpaceCenter; //< snapped center of the cascade, in light space
+				float radius = 0.f;
+				bool isFitted = false;
+			};
+
+			struct ViewerData
+			{
+				std::array<CascadeData, CascadeCount> cascades;
+				std::array<float, CascadeCount> splitDistances;
+				std::size_t frameIndex = 0;
+				std::size_t textureArrayAttachmentIndex = std::numeric_limits<std::size_t>::max(); //< only registered for viewers seeing the light
+				bool hasCascades = false;
+			};
+
+			void ComputeCascadeBounds(const ViewerInstance& viewerInstance, ViewerData& viewerData, std::array<CascadeBounds, CascadeCount>& cascadeBounds) const;
+			bool FitCascade(CascadeData& cascade, const CascadeBounds& bounds, float radiusMargin);
+
+			NazaraSlot(Light, OnLightDataInvalided, m_onLightDataInvalidated);
+			NazaraSlot(Light, OnLightShadowMapSettingChange, m_onLightShadowMapSettingChange);
+
+			std::size_t m_shadowPassIndex;
+			std::unordered_map<const AbstractViewer*, std::unique_ptr<ViewerData>> m_viewerData;
+			ElementRendererRegistry& m_elementRegistry;
+			FramePipeline& m_pipeline;
+			const DirectionalLight& m_light;
+	};
+}
+
+#include <Nazara/Graphics/DirectionalLightShadowData.inl>
+
+#endif // NAZARA_GRAPHICS_DIRECTIONALLIGHTSHADOWDATA_HPP
@@ -35,6 +35,8 @@ namespace Nz
 			ElementRenderer() = default;
 			virtual ~ElementRenderer();
 
+			virtual void EndFrame(RenderFrame& currentFrame);
+
 			virtual RenderElementPoolBase& GetPool() = 0;
 
 			virtual std::unique_ptr<ElementRendererData> InstanciateData() = 0;
@@ -42,6 +44,7 @@ namespace Nz
 			virtual void PrepareEnd(RenderFrame& currentFrame, ElementRendererData& rendererData);
 			virtual void Render(const ViewerInstance& viewerInstance, ElementRendererData& rendererData, CommandBufferBuilder& commandBuffer, std::size_t elementCount, const Pointer<const RenderElement>* elements) = 0;
 			virtual void Reset(ElementRendererData& rendererData, RenderFrame& currentFrame);
+			virtual void Update(RenderFrame& currentFrame, ElementRendererData& rendererData);
 
 			struct RenderStates
 			{
@@ -49,10 +52,14 @@ namespace Nz
 				{
 					shadowMaps2D.fill(nullptr);
 					shadowMapsCube.fill(nullptr);
+					shadowMapsDirectional.fill(nullptr);
 				}
 
-				std::array<const Texture*, PredefinedLightData::MaxLightCount> shadowMaps2D;
-				std::array<const Texture*, PredefinedLightData::MaxLightCount> shadowMapsCube;
+				std::array<const Texture*, PredefinedLightData::MaxShadowedLightCount> shadowMaps2D;
+				std::array<const Texture*, PredefinedLightData::MaxShadowedLightCount> shadowMapsCube;
+				std::array<const Texture*, PredefinedLightData::MaxShadowedLightCount> shadowMapsDirectional;
+				RenderBufferView lightArray;
+				RenderBufferView lightClusters;
 				RenderBufferView lightData;
 			};
 	};
@@ -27,8 +27,11 @@ namespace Nz
 	{
 		SpriteChain = 0,
 		Submesh = 1,
+		Particles = 2,
+		Impostor = 3,
+		Terrain = 4,
 
-		Max = Submesh
+		Max = Terrain
 	};
 
 	constexpr std::size_t BasicRenderElementCount = UnderlyingCast(BasicRenderElement::Max) + 1;
@@ -95,19 +98,46 @@ namespace Nz
 
 	using MaterialPassFlags = Flags<MaterialPassFlag>;
 
+	enum class ParticleBlendMode
+	{
+		Additive,
+		AlphaBlend, //< particles are sorted back to front
+
+		Max = AlphaBlend
+	};
+
+	constexpr std::size_t ParticleBlendModeCount = UnderlyingCast(ParticleBlendMode::Max) + 1;
+
 	enum class ProjectionType
 	{
 		Orthographic,
 		Perspective
 	};
 
+	enum class UpscalingMode
+	{
+		Spatial,  //< edge-preserving bicubic filtering of the current frame
+		Temporal, //< accumulation of jittered frames in a history, sharper but may ghost on moving objects
+
+		Max = Temporal
+	};
+
+	constexpr std::size_t UpscalingModeCount = UnderlyingCast(UpscalingMode::Max) + 1;
+
 	enum class EngineShaderBinding
 	{
+		AnimationTexture,
+		InstanceAnimationDataArrayUbo,
+		InstanceDataArraySsbo,
+		InstanceDataArrayUbo,
 		InstanceDataUbo,
+		LightArraySsbo,
+		LightClusterSsbo,
 		LightDataUbo,
 		OverlayTexture,
 		Shadowmap2D,
 		ShadowmapCube,
+		ShadowmapDirectional,
 		SkeletalDataUbo,
 		ViewerDataUbo,
 
@@ -8,10 +8,13 @@
 #define NAZARA_GRAPHICS_FORWARDFRAMEPIPELINE_HPP
 
 #include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/DynamicAABBTree.hpp>
 #include <Nazara/Graphics/BakedFrameGraph.hpp>
 #include <Nazara/Graphics/Camera.hpp>
 #include <Nazara/Graphics/Config.hpp>
 #include <Nazara/Graphics/DebugDrawPipelinePass.hpp>
+#include <Nazara/Graphics/DeferredLightingPipelinePass.hpp>
 #include <Nazara/Graphics/DepthPipelinePass.hpp>
 #include <Nazara/Graphics/ElementRenderer.hpp>
 #include <Nazara/Graphics/ForwardPipelinePass.hpp>
@@ -20,12 +23,15 @@
 #include <Nazara/Graphics/Light.hpp>
 #include <Nazara/Graphics/LightShadowData.hpp>
 #include <Nazara/Graphics/MaterialPass.hpp>
+#include <Nazara/Graphics/OcclusionCuller.hpp>
 #include <Nazara/Graphics/RenderElement.hpp>
 #include <Nazara/Graphics/RenderQueue.hpp>
 #include <Nazara/Graphics/RenderQueueRegistry.hpp>
 #include <Nazara/Graphics/TransferInterface.hpp>
+#include <Nazara/Graphics/UpscalePipelinePass.hpp>
 #include <Nazara/Renderer/ShaderBinding.hpp>
 #include <NazaraUtils/MemoryPool.hpp>
+#include <array>
 #include <memory>
 #include <optional>
 #include <unordered_map>
@@ -34,17 +40,27 @@
 
 namespace Nz
 {
+	class FrameGraph;
 	class RenderFrame;
 	class RenderTarget;
+	class TextureStreamer;
 
 	class NAZARA_GRAPHICS_API ForwardFramePipeline : public FramePipeline
 	{
 		public:
+			struct DynamicResolutionParams;
+
 			ForwardFramePipeline(ElementRendererRegistry& elementRegistry);
 			ForwardFramePipeline(const ForwardFramePipeline&) = delete;
 			ForwardFramePipeline(ForwardFramePipeline&&) = delete;
 			~ForwardFramePipeline();
 
+			void DisableDynamicResolution(std::size_t viewerIndex);
+			void DisableStereoCulling(std::size_t viewerIndex);
+
+			void EnableDynamicResolution(std::size_t viewerIndex, const DynamicResolutionParams& params);
+			void EnableStereoCulling(std::size_t firstViewerIndex, std::size_t secondViewerIndex);
+
 			const std::vector<FramePipelinePass::VisibleRenderable>& FrustumCull(const Frustumf& frustum, UInt32 mask, std::size_t& visibilityHash) const override;
 
 			void ForEachRegisteredMaterialInstance(FunctionRef<void(const MaterialInstance& materialInstance)> callback) override;
@@ -57,11 +73,18 @@ namespace Nz
 			std::size_t RegisterViewer(AbstractViewer* viewerInstance, Int32 renderOrder) override;
 			std::size_t RegisterWorldInstance(WorldInstancePtr worldInstance) override;
 
+			inline TextureStreamer* GetTextureStreamer() const;
+
+			bool IsCullingInvalidated(const Frustumf& frustum) const override;
+
 			const Light* RetrieveLight(std::size_t lightIndex) const override;
-			const Texture* RetrieveLightShadowmap(std::size_t lightIndex) const override;
+			const LightShadowData* RetrieveLightShadowData(std::size_t lightIndex) const override;
+			const Texture* RetrieveLightShadowmap(std::size_t lightIndex, const AbstractViewer* viewer) const override;
 
 			void Render(RenderFrame& renderFrame) override;
 
+			inline void SetTextureStreamer(TextureStreamer* textureStreamer);
+
 			void UnregisterLight(std::size_t lightIndex) override;
 			void UnregisterRenderable(std::size_t renderableIndex) override;
 			void UnregisterSkeleton(std::size_t skeletonIndex) override;
@@ -77,11 +100,51 @@ namespace Nz
 			ForwardFramePipeline& operator=(const ForwardFramePipeline&) = delete;
 			ForwardFramePipeline& operator=(ForwardFramePipeline&&) = delete;
 
+			struct DynamicResolutionParams
+			{
+				Time targetFrameTime = Time::Milliseconds(16); //< frame time the render scale is adjusted for
+				UpscalingMode upscalingMode = UpscalingMode::Temporal;
+				float minScale = 0.5f;
+				float maxScale = 1.f;
+			};
+
+		protected:
+			ForwardFramePipeline(ElementRendererRegistry& elementRegistry, bool useDeferredShading);
+
 		private:
-			BakedFrameGraph BuildFrameGraph();
+			struct CullingScratch;
+			struct CachedFrameGraph;
+
+			FrameGraph BuildFrameGraph();
+			void ComputeViewerVisibility(ViewerData& viewerData);
+			void CullViewerOcclusion(ViewerData& viewerData, const Frustumf& frustum, CullingScratch& scratch, std::size_t& visibilityHash);
+			const std::vector<FramePipelinePass::VisibleRenderable>& FrustumCull(const Frustumf& frustum, UInt32 mask, std::size_t& visibilityHash, CullingScratch& scratch) const;
 
+			void InvalidateRenderableCulling(std::size_t renderableIndex);
 			void RegisterMaterialInstance(MaterialInstance* materialPass);
+			void ReportTextureUsage(const AbstractViewer& viewer, const std::vector<FramePipelinePass::VisibleRenderable>& visibleRenderables);
+			void SelectLODs(ViewerData& viewerData, std::size_t& visibilityHash);
 			void UnregisterMaterialInstance(MaterialInstance* material);
+			void UpdateLightBounds(std::size_t lightIndex);
+			void UpdateRenderScale(ViewerData& viewerData);
+			void UpdateRenderableBounds();
+			void UpdateRenderableElements();
+
+			struct DynamicResolutionData
+			{
+				DynamicResolutionParams params;
+				std::size_t framesSinceChange = 0;
+				std::size_t probeInterval;
+				bool isProbing = false;
+			};
+
+			static constexpr std::size_t NoStereoViewer = std::numeric_limits<std::size_t>::max();
+
+			struct CullingChunk
+			{
+				std::vector<FramePipelinePass::VisibleRenderable> visibleRenderables;
+				std::size_t visibilityHash;
+			};
 
 			struct ViewerData;
 
@@ -89,6 +152,7 @@ namespace Nz
 			{
 				std::unique_ptr<LightShadowData> shadowData;
 				const Light* light;
+				std::size_t cullingProxy = DynamicAABBTree::InvalidProxy;
 				UInt32 renderMask;
 
 				NazaraSlot(Light, OnLightDataInvalided, onLightInvalidated);
@@ -104,6 +168,7 @@ namespace Nz
 
 			struct RenderableData
 			{
+				std::size_t cullingProxy = DynamicAABBTree::InvalidProxy;
 				std::size_t skeletonInstanceIndex;
 				std::size_t worldInstanceIndex;
 				const InstancedRenderable* renderable;
@@ -111,10 +176,39 @@ namespace Nz
 				UInt32 renderMask = 0;
 				UInt8 generation;
 
+				NazaraSlot(InstancedRenderable, OnAABBUpdate, onAABBUpdate);
 				NazaraSlot(InstancedRenderable, OnElementInvalidated, onElementInvalidated);
 				NazaraSlot(InstancedRenderable, OnMaterialInvalidated, onMaterialInvalidated);
 			};
 
+			// World-space AABB of every renderable (indexed by renderable index) stored as SoA for batched culling
+			struct RenderableBounds
+			{
+				std::vector<float> minX;
+				std::vector<float> minY;
+				std::vector<float> minZ;
+				std::vector<float> maxX;
+				std::vector<float> maxY;
+				std::vector<float> maxZ;
+				std::vector<UInt32> renderMask; //< zero for unused slots
+			};
+
+			// Temporary storage of FrustumCull, viewers have their own so they can be culled in parallel
+			struct CullingScratch
+			{
+				std::vector<CullingChunk> chunks;
+				std::vector<FramePipelinePass::VisibleRenderable> visibleRenderables;
+				std::vector<std::size_t> candidates;
+				std::vector<std::size_t> visibleRenderableIndices; //< same order as visibleRenderables
+				RenderableBounds candidateBounds;
+			};
+
+			struct CachedFrameGraph
+			{
+				BakedFrameGraph bakedFrameGraph;
+				std::size_t structureHash;
+			};
+
 			struct RenderTargetData
 			{
 				std::size_t finalAttachment;
@@ -131,23 +225,43 @@ namespace Nz
 
 			struct ViewerData
 			{
+				std::array<std::size_t, DeferredLightingPipelinePass::GBufferCount> gbufferAttachments;
 				std::size_t forwardColorAttachment;
 				std::size_t debugColorAttachment;
 				std::size_t depthStencilAttachment;
-				std::unique_ptr<DepthPipelinePass> depthPrepass;
+				std::size_t lightingColorAttachment;
+				std::size_t upscaledColorAttachment;
+				std::optional<DynamicResolutionData> dynamicResolution;
+				std::unique_ptr<DeferredLightingPipelinePass> lightingPass;
+				std::unique_ptr<DepthPipelinePass> depthPrepass; //< G-buffer pass with deferred shading
 				std::unique_ptr<ForwardPipelinePass> forwardPass;
 				std::unique_ptr<DebugDrawPipelinePass> debugDrawPass;
+				std::unique_ptr<OcclusionCuller> occlusionCuller;
+				std::unique_ptr<UpscalePipelinePass> upscalePass;
 				AbstractViewer* viewer;
 				Int32 renderOrder = 0;
 				RenderQueueRegistry forwardRegistry;
 				RenderQueue<RenderElement*> forwardRenderQueue;
 				ShaderBindingPtr blitShaderBinding;
+				std::vector<UInt8> renderableLODs; //< level of detail used for each renderable (by renderable index) by the last frame
+				std::size_t stereoViewerIndex = NoStereoViewer; //< other eye of a stereo pair
+				bool isStereoSecondary = false; //< visibility is computed along with the other eye
+
+				// Visibility of the current frame, computed by ComputeViewerVisibility
+				CullingScratch cullingScratch;
+				Frustumf frustum;
+				const std::vector<FramePipelinePass::VisibleRenderable>* visibleRenderables;
+				std::size_t depthVisibilityHash;
+				std::size_t visibilityHash;
+				std::vector<FramePipelinePass::VisibleRenderable> unoccludedRenderables;
+				std::vector<std::size_t> visibleLights;
 
 				NazaraSlot(TransferInterface, OnTransferRequired, onTransferRequired);
 			};
 
 			struct WorldInstanceData
 			{
+				std::vector<std::size_t> renderables;
 				WorldInstancePtr worldInstance;
 
 				NazaraSlot(TransferInterface, OnTransferRequired, onTransferRequired);
@@ -156,23 +270,38 @@ namespace Nz
 			std::unordered_map<const RenderTarget*, RenderTargetData> m_renderTargets;
 			std::unordered_map<MaterialInstance*, MaterialInstanceData> m_materialInstances;
 			std::vector<ElementRenderer::RenderStates> m_renderStates;
-			mutable std::vector<FramePipelinePass::VisibleRenderable> m_visibleRenderables;
-			std::vector<std::size_t> m_visibleLights;
+			std::vector<CachedFrameGraph> m_frameGraphCache; //< most recently used first
+			std::vector<ViewerData*> m_preparedViewers;
+			std::vector<Boxf> m_invalidatedCullingBoxes;
+			std::vector<SkeletonInstance*> m_skinnedSkeletonInstances;
 			robin_hood::unordered_set<TransferInterface*> m_transferSet;
 			BakedFrameGraph m_bakedFrameGraph;
+			HighPrecisionClock m_frameClock;
+			Bitset<UInt64> m_invalidatedRenderableBounds;
+			Bitset<UInt64> m_invalidatedRenderableElements;
 			Bitset<UInt64> m_shadowCastingLights;
+			Bitset<UInt64> m_unboundedLights;
 			Bitset<UInt64> m_removedSkeletonInstances;
 			Bitset<UInt64> m_removedViewerInstances;
 			Bitset<UInt64> m_removedWorldInstances;
+			Bitset<UInt64> m_simulatedRenderables;
 			ElementRendererRegistry& m_elementRegistry;
 			mutable MemoryPool<RenderableData> m_renderablePool; //< FIXME: has to be mutable because MemoryPool has no const_iterator
 			MemoryPool<LightData> m_lightPool;
 			MemoryPool<SkeletonInstanceData> m_skeletonInstances;
 			MemoryPool<ViewerData> m_viewerPool;
 			MemoryPool<WorldInstanceData> m_worldInstances;
+			DynamicAABBTree m_lightTree;
+			DynamicAABBTree m_renderableTree;
+			RenderableBounds m_renderableBounds;
+			mutable CullingScratch m_cullingScratch; //< used by shadow views
 			RenderFrame* m_currentRenderFrame;
+			std::size_t m_bakedFrameGraphHash;
+			TextureStreamer* m_textureStreamer;
+			float m_averageFrameTime; //< in seconds
 			UInt8 m_generationCounter;
 			bool m_rebuildFrameGraph;
+			bool m_useDeferredShading;
 	};
 }
 
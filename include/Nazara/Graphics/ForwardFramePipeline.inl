@@ -6,6 +6,20 @@
 
 namespace Nz
 {
+	inline TextureStreamer* ForwardFramePipeline::GetTextureStreamer() const
+	{
+		return m_textureStreamer;
+	}
+
+	/*!
+	* \brief Sets the texture streamer receiving usage feedback of visible renderables, and updates it each frame
+	*
+	* \param textureStreamer Texture streamer, which must outlive the pipeline (or be reset), can be null
+	*/
+	inline void ForwardFramePipeline::SetTextureStreamer(TextureStreamer* textureStreamer)
+	{
+		m_textureStreamer = textureStreamer;
+	}
 }
 
 #include <Nazara/Graphics/DebugOff.hpp>
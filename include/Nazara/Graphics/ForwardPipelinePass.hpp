@@ -14,12 +14,17 @@
 #include <Nazara/Graphics/Light.hpp>
 #include <Nazara/Graphics/MaterialInstance.hpp>
 #include <Nazara/Graphics/MaterialPass.hpp>
+#include <Nazara/Graphics/MaterialPassRegistry.hpp>
 #include <Nazara/Graphics/RenderElement.hpp>
 #include <Nazara/Graphics/RenderElementOwner.hpp>
 #include <Nazara/Graphics/RenderQueue.hpp>
 #include <Nazara/Graphics/RenderQueueRegistry.hpp>
+#include <Nazara/Graphics/PredefinedShaderStructs.hpp>
 #include <Nazara/Math/Frustum.hpp>
-#include <Nazara/Renderer/UploadPool.hpp>
+#include <Nazara/Renderer/ShaderBinding.hpp>
+#include <array>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace Nz
 {
@@ -33,27 +38,37 @@ namespace Nz
 	class NAZARA_GRAPHICS_API ForwardPipelinePass : public FramePipelinePass
 	{
 		public:
-			ForwardPipelinePass(FramePipeline& owner, ElementRendererRegistry& elementRegistry, AbstractViewer* viewer);
+			ForwardPipelinePass(FramePipeline& owner, ElementRendererRegistry& elementRegistry, AbstractViewer* viewer, std::size_t excludedPassIndex = MaterialPassRegistry::InvalidIndex);
 			ForwardPipelinePass(const ForwardPipelinePass&) = delete;
 			ForwardPipelinePass(ForwardPipelinePass&&) = delete;
 			~ForwardPipelinePass() = default;
 
 			inline void InvalidateCommandBuffers();
 			inline void InvalidateElements();
+			inline void InvalidateElements(const InstancedRenderable* instancedRenderable);
 
 			void Prepare(RenderFrame& renderFrame, const Frustumf& frustum, const std::vector<FramePipelinePass::VisibleRenderable>& visibleRenderables, const std::vector<std::size_t>& visibleLights, std::size_t visibilityHash);
 
 			void RegisterMaterialInstance(const MaterialInstance& material);
 			FramePass& RegisterToFrameGraph(FrameGraph& frameGraph, std::size_t colorBufferIndex, std::size_t depthBufferIndex, bool hasDepthPrepass);
+			FramePass& RegisterToFrameGraph(FrameGraph& frameGraph, std::size_t inputColorBufferIndex, std::size_t outputColorBufferIndex, std::size_t depthBufferIndex);
 
 			void UnregisterMaterialInstance(const MaterialInstance& material);
 
 			ForwardPipelinePass& operator=(const ForwardPipelinePass&) = delete;
 			ForwardPipelinePass& operator=(ForwardPipelinePass&&) = delete;
 
-			static constexpr std::size_t MaxLightCountPerDraw = 3;
+			// Lights are binned in a view-space froxel grid (depth slices distributed logarithmically), fragments only evaluate the lights of their cluster
+			static constexpr UInt32 ClusterCountX = 16;
+			static constexpr UInt32 ClusterCountY = 9;
+			static constexpr UInt32 ClusterCountZ = 24;
+			static constexpr UInt32 MaxLightsPerCluster = 32;
 
 		private:
+			bool PrepareLights(RenderFrame& renderFrame, const std::vector<std::size_t>& visibleLights);
+			void SetupFramePass(FramePass& forwardPass);
+			void UpdateClusteringBinding(RenderFrame& renderFrame);
+
 			struct MaterialPassEntry
 			{
 				std::size_t usedCount = 1;
@@ -62,55 +77,51 @@ namespace Nz
 				NazaraSlot(MaterialInstance, OnMaterialInstanceShaderBindingInvalidated, onMaterialInstanceShaderBindingInvalidated);
 			};
 
-			using LightKey = std::array<const Light*, MaxLightCountPerDraw>;
-
-			struct LightKeyHasher
+			struct RenderableElementKey
 			{
-				inline std::size_t operator()(const LightKey& lightKey) const;
-			};
+				const InstancedRenderable* instancedRenderable;
+				const SkeletonInstance* skeletonInstance;
+				const WorldInstance* worldInstance;
+				std::size_t lodIndex;
 
-			struct LightDataUbo
-			{
-				std::shared_ptr<RenderBuffer> renderBuffer;
-				std::size_t offset = 0;
-				UploadPool::Allocation* allocation = nullptr;
-			};
-
-			struct LightPerElementData
-			{
-				RenderBufferView lightUniformBuffer;
-				std::array<const Texture*, MaxLightCountPerDraw> shadowMaps;
-				std::size_t lightCount;
+				inline bool operator==(const RenderableElementKey& key) const;
 			};
 
-			struct LightUboPool
+			struct RenderableElementKeyHasher
 			{
-				std::vector<std::shared_ptr<RenderBuffer>> lightUboBuffers;
+				inline std::size_t operator()(const RenderableElementKey& key) const;
 			};
 
-			struct RenderableLight
+			struct RenderableElements
 			{
-				const Light* light;
-				std::size_t lightIndex;
-				float contributionScore;
+				std::vector<RenderElementOwner> elements;
+				std::size_t generation = 0;
 			};
 
+			std::size_t m_elementGeneration;
+			std::size_t m_excludedPassIndex;
 			std::size_t m_forwardPassIndex;
+			std::size_t m_globalLightCount;
 			std::size_t m_lastVisibilityHash;
-			std::shared_ptr<LightUboPool> m_lightUboPool;
+			std::size_t m_shadowedLightCount;
+			std::array<const Texture*, PredefinedLightData::MaxShadowedLightCount> m_shadowMaps;
+			std::shared_ptr<RenderBuffer> m_lightBuffer;
+			std::shared_ptr<RenderBuffer> m_lightClusterBuffer;
+			std::shared_ptr<RenderBuffer> m_lightDataBuffer;
+			std::vector<const Light*> m_lights;
+			std::vector<std::size_t> m_lightIndices;
 			std::vector<std::unique_ptr<ElementRendererData>> m_elementRendererData;
 			std::vector<ElementRenderer::RenderStates> m_renderStates;
-			std::vector<RenderElementOwner> m_renderElements;
 			std::unordered_map<const MaterialInstance*, MaterialPassEntry> m_materialInstances;
-			std::unordered_map<const RenderElement*, LightPerElementData> m_lightPerRenderElement;
-			std::unordered_map<LightKey, RenderBufferView, LightKeyHasher> m_lightBufferPerLights;
-			std::vector<LightDataUbo> m_lightDataBuffers;
-			std::vector<RenderableLight> m_renderableLights;
+			std::unordered_map<RenderableElementKey, RenderableElements, RenderableElementKeyHasher> m_renderableElements;
+			std::unordered_set<const InstancedRenderable*> m_invalidatedRenderables;
+			std::unordered_set<const RenderElement*> m_visibleElements;
 			RenderQueue<const RenderElement*> m_renderQueue;
 			RenderQueueRegistry m_renderQueueRegistry;
 			AbstractViewer* m_viewer;
 			ElementRendererRegistry& m_elementRegistry;
 			FramePipeline& m_pipeline;
+			ShaderBindingPtr m_lightClusteringBinding;
 			bool m_rebuildCommandBuffer;
 			bool m_rebuildElements;
 	};
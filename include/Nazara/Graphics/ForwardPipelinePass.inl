@@ -16,19 +16,30 @@ namespace Nz
 		m_rebuildElements = true;
 	}
 
-	inline std::size_t ForwardPipelinePass::LightKeyHasher::operator()(const LightKey& lightKey) const
+	inline void ForwardPipelinePass::InvalidateElements(const InstancedRenderable* instancedRenderable)
 	{
-		std::size_t lightHash = 5;
+		m_invalidatedRenderables.insert(instancedRenderable);
+	}
+
+	inline bool ForwardPipelinePass::RenderableElementKey::operator==(const RenderableElementKey& key) const
+	{
+		return instancedRenderable == key.instancedRenderable && skeletonInstance == key.skeletonInstance && worldInstance == key.worldInstance && lodIndex == key.lodIndex;
+	}
+
+	inline std::size_t ForwardPipelinePass::RenderableElementKeyHasher::operator()(const RenderableElementKey& key) const
+	{
+		std::size_t keyHash = 5;
 		auto CombineHash = [](std::size_t currentHash, std::size_t newHash)
 		{
 			return currentHash * 23 + newHash;
 		};
 
-		std::hash<const Light*> lightPtrHasher;
-		for (std::size_t i = 0; i < lightKey.size(); ++i)
-			lightHash = CombineHash(lightHash, lightPtrHasher(lightKey[i]));
+		keyHash = CombineHash(keyHash, std::hash<const InstancedRenderable*>()(key.instancedRenderable));
+		keyHash = CombineHash(keyHash, std::hash<const SkeletonInstance*>()(key.skeletonInstance));
+		keyHash = CombineHash(keyHash, std::hash<const WorldInstance*>()(key.worldInstance));
+		keyHash = CombineHash(keyHash, key.lodIndex);
 
-		return lightHash;
+		return keyHash;
 	}
 }
 
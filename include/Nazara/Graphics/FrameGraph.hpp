@@ -43,6 +43,10 @@ namespace Nz
 
 			BakedFrameGraph Bake();
 
+			std::size_t ComputeStructureHash() const;
+
+			void UpdateBakedCallbacks(BakedFrameGraph& bakedFrameGraph) const;
+
 			FrameGraph& operator=(const FrameGraph&) = delete;
 			FrameGraph& operator=(FrameGraph&&) noexcept = default;
 
@@ -100,8 +104,11 @@ namespace Nz
 				};
 
 				std::string name;
+				std::vector<TextureBarrier> releaseBarriers;
 				std::vector<TextureBarrier> textureBarrier;
 				std::vector<Subpass> passes;
+				QueueType queueType;
+				QueueTypeFlags waitedQueues;
 			};
 
 			struct WorkData
@@ -129,6 +136,7 @@ namespace Nz
 			void BuildPhysicalPasses();
 			void BuildReadWriteList();
 			bool HasAttachment(const std::vector<FramePass::Input>& inputs, std::size_t attachmentIndex) const;
+			bool IsBackbufferOutput(std::size_t attachmentIndex) const;
 			void RemoveDuplicatePasses();
 			std::size_t ResolveAttachmentIndex(std::size_t attachmentIndex) const;
 			void RegisterPassInput(std::size_t passIndex, std::size_t attachmentIndex);
@@ -33,6 +33,7 @@ namespace Nz
 		unsigned int width;
 		unsigned int height;
 		unsigned int layerCount;
+		bool transient = false; //< every attachment using this texture is transient
 	};
 }
 
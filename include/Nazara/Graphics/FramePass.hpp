@@ -67,6 +67,7 @@ namespace Nz
 			inline const std::string& GetName() const;
 			inline const std::vector<Output>& GetOutputs() const;
 			inline std::size_t GetPassId() const;
+			inline QueueType GetQueueType() const;
 
 			inline void SetCommandCallback(CommandCallback callback);
 			inline void SetClearColor(std::size_t outputIndex, const std::optional<Color>& color);
@@ -74,7 +75,9 @@ namespace Nz
 			inline void SetDepthStencilInput(std::size_t attachmentId);
 			inline void SetDepthStencilOutput(std::size_t attachmentId);
 			inline void SetExecutionCallback(ExecutionCallback callback);
+			inline void SetInputAttachment(std::size_t inputIndex, bool isInputAttachment);
 			inline void SetInputLayout(std::size_t inputIndex, TextureLayout layout);
+			inline void SetQueueType(QueueType queueType);
 			inline void SetReadInput(std::size_t inputIndex, bool doesRead);
 
 			FramePass& operator=(const FramePass&) = delete;
@@ -93,6 +96,7 @@ namespace Nz
 				std::size_t attachmentId;
 				std::optional<TextureLayout> assumedLayout;
 				bool doesRead = true;
+				bool isInputAttachment = false;
 			};
 
 			struct Output
@@ -111,6 +115,7 @@ namespace Nz
 			std::vector<Output> m_outputs;
 			CommandCallback m_commandCallback;
 			ExecutionCallback m_executionCallback;
+			QueueType m_queueType;
 	};
 }
 
@@ -11,7 +11,8 @@ namespace Nz
 	m_depthStencilInput(InvalidAttachmentId),
 	m_depthStencilOutput(InvalidAttachmentId),
 	m_passId(passId),
-	m_name(std::move(name))
+	m_name(std::move(name)),
+	m_queueType(QueueType::Graphics)
 	{
 	}
 
@@ -104,6 +105,11 @@ namespace Nz
 		return m_passId;
 	}
 
+	inline QueueType FramePass::GetQueueType() const
+	{
+		return m_queueType;
+	}
+
 	inline void FramePass::SetCommandCallback(CommandCallback callback)
 	{
 		m_commandCallback = std::move(callback);
@@ -127,12 +133,35 @@ namespace Nz
 		m_executionCallback = std::move(callback);
 	}
 
+	/*!
+	* \brief Marks an input as read through an input attachment (only at the current fragment location)
+	*
+	* This allows the pass to be merged as a subpass with the pass writing the input, keeping its content in tile memory.
+	* The pass shaders must read it as a subpass input, which requires both passes to be merged (Bake throws otherwise).
+	*/
+	inline void FramePass::SetInputAttachment(std::size_t inputIndex, bool isInputAttachment)
+	{
+		assert(inputIndex < m_inputs.size());
+		m_inputs[inputIndex].isInputAttachment = isInputAttachment;
+	}
+
 	inline void FramePass::SetInputLayout(std::size_t inputIndex, TextureLayout layout)
 	{
 		assert(inputIndex < m_inputs.size());
 		m_inputs[inputIndex].assumedLayout = layout;
 	}
 
+	/*!
+	* \brief Sets the queue the pass is executed on
+	*
+	* Compute passes run outside of any render pass (possibly on an async compute queue), their outputs are written as storage textures and they can't use a depth-stencil attachment
+	*/
+	inline void FramePass::SetQueueType(QueueType queueType)
+	{
+		assert(queueType == QueueType::Compute || queueType == QueueType::Graphics);
+		m_queueType = queueType;
+	}
+
 	inline void FramePass::SetReadInput(std::size_t inputIndex, bool doesRead)
 	{
 		assert(inputIndex < m_inputs.size());
@@ -27,6 +27,7 @@ namespace Nz
 		FramePassAttachmentSize size = FramePassAttachmentSize::SwapchainFactor;
 		unsigned int width = 100'000;
 		unsigned int height = 100'000;
+		bool transient = false; //< hint that the content is never needed outside of the passes writing it (allows lazily-allocated memory)
 	};
 }
 
@@ -23,6 +23,7 @@ namespace Nz
 	class AbstractViewer;
 	class InstancedRenderable;
 	class Light;
+	class LightShadowData;
 	class MaterialInstance;
 	class RenderFrame;
 
@@ -41,6 +42,9 @@ namespace Nz
 
 			inline DebugDrawer& GetDebugDrawer();
 
+			// Returns true if renderables may have entered, left or moved inside the frustum since the last frame
+			virtual bool IsCullingInvalidated(const Frustumf& frustum) const = 0;
+
 			virtual void QueueTransfer(TransferInterface* transfer) = 0;
 
 			virtual std::size_t RegisterLight(const Light* light, UInt32 renderMask) = 0;
@@ -50,7 +54,8 @@ namespace Nz
 			virtual std::size_t RegisterWorldInstance(WorldInstancePtr worldInstance) = 0;
 
 			virtual const Light* RetrieveLight(std::size_t lightIndex) const = 0;
-			virtual const Texture* RetrieveLightShadowmap(std::size_t lightIndex) const = 0;
+			virtual const LightShadowData* RetrieveLightShadowData(std::size_t lightIndex) const = 0;
+			virtual const Texture* RetrieveLightShadowmap(std::size_t lightIndex, const AbstractViewer* viewer) const = 0;
 
 			virtual void Render(RenderFrame& renderFrame) = 0;
 
@@ -9,6 +9,7 @@
 
 #include <NazaraUtils/Prerequisites.hpp>
 #include <Nazara/Graphics/Config.hpp>
+#include <Nazara/Math/Box.hpp>
 #include <Nazara/Math/Rect.hpp>
 
 namespace Nz
@@ -33,7 +34,9 @@ namespace Nz
 				const InstancedRenderable* instancedRenderable;
 				const SkeletonInstance* skeletonInstance;
 				const WorldInstance* worldInstance;
+				Boxf worldAABB;
 				Recti scissorBox;
+				std::size_t lodIndex;
 			};
 	};
 }
@@ -9,11 +9,13 @@
 
 #include <NazaraUtils/Prerequisites.hpp>
 #include <Nazara/Graphics/Config.hpp>
+#include <Nazara/Graphics/MeshArena.hpp>
 #include <Nazara/Renderer/RenderBuffer.hpp>
 #include <Nazara/Utility/Mesh.hpp>
 #include <Nazara/Utility/VertexDeclaration.hpp>
 #include <NazaraUtils/Signal.hpp>
 #include <memory>
+#include <vector>
 
 namespace Nz
 {
@@ -25,17 +27,24 @@ namespace Nz
 			GraphicalMesh() = default;
 			GraphicalMesh(const GraphicalMesh&) = delete;
 			GraphicalMesh(GraphicalMesh&&) noexcept = default;
-			~GraphicalMesh() = default;
+			~GraphicalMesh();
 
 			inline std::size_t AddSubMesh(SubMesh subMesh);
 
 			inline void Clear();
 
 			inline const Boxf& GetAABB() const;
-			inline const std::shared_ptr<RenderBuffer>& GetIndexBuffer(std::size_t subMesh) const;
-			inline UInt32 GetIndexCount(std::size_t subMesh) const;
+			inline const std::shared_ptr<MeshArena>& GetArena() const;
+			inline UInt32 GetFirstIndex(std::size_t subMesh, std::size_t lodIndex = 0) const;
+			inline const std::shared_ptr<RenderBuffer>& GetIndexBuffer(std::size_t subMesh, std::size_t lodIndex = 0) const;
+			inline UInt32 GetIndexCount(std::size_t subMesh, std::size_t lodIndex = 0) const;
 			inline IndexType GetIndexType(std::size_t subMesh) const;
+			inline std::size_t GetLODCount() const;
+			inline float GetLODError(std::size_t lodIndex) const;
+			inline const std::shared_ptr<RenderBuffer>& GetSkinningBuffer(std::size_t subMesh) const;
 			inline const std::shared_ptr<RenderBuffer>& GetVertexBuffer(std::size_t subMesh) const;
+			inline UInt64 GetVertexBufferOffset(std::size_t subMesh) const;
+			inline UInt32 GetVertexCount(std::size_t subMesh) const;
 			inline const std::shared_ptr<const VertexDeclaration>& GetVertexDeclaration(std::size_t subMesh) const;
 			inline std::size_t GetSubMeshCount() const;
 
@@ -45,23 +54,43 @@ namespace Nz
 			GraphicalMesh& operator=(const GraphicalMesh&) = delete;
 			GraphicalMesh& operator=(GraphicalMesh&&) = delete;
 
+			struct LevelOfDetail
+			{
+				std::shared_ptr<RenderBuffer> indexBuffer;
+				UInt32 firstIndex = 0; //< first index to draw from the index buffer (non-zero when it is shared)
+				UInt32 indexCount;
+				float error; //< relative to the mesh size
+			};
+
 			struct SubMesh
 			{
 				std::shared_ptr<RenderBuffer> indexBuffer;
+				std::shared_ptr<RenderBuffer> skinningBuffer; //< source vertices for compute skinning (see PredefinedSkinningData), only for skinned submeshes when compute skinning is enabled
 				std::shared_ptr<RenderBuffer> vertexBuffer;
 				std::shared_ptr<const VertexDeclaration> vertexDeclaration;
 				IndexType indexType;
+				UInt32 firstIndex = 0; //< first index to draw from the index buffer (non-zero when it is shared)
 				UInt32 indexCount;
+				UInt32 vertexCount = 0;
+				UInt64 vertexOffset = 0; //< offset of the first vertex in the vertex buffer, in bytes (non-zero when it is shared)
+				std::vector<LevelOfDetail> levelsOfDetail; //< simplified versions of the submesh (sharing its vertices), from the most detailed to the least detailed
 			};
 
 			static inline std::shared_ptr<GraphicalMesh> Build(const Primitive& primitive, const MeshParams& params = MeshParams());
 			static inline std::shared_ptr<GraphicalMesh> Build(const PrimitiveList& primitiveList, const MeshParams& params = MeshParams());
 			static std::shared_ptr<GraphicalMesh> BuildFromMesh(const Mesh& mesh);
+			static std::shared_ptr<GraphicalMesh> BuildFromMesh(const Mesh& mesh, std::shared_ptr<MeshArena> arena);
 
 			NazaraSignal(OnInvalidated, GraphicalMesh* /*gfxMesh*/);
 
 		private:
+			void ReleaseArenaAllocations();
+			void UpdateLODErrors();
+
+			std::shared_ptr<MeshArena> m_arena;
+			std::vector<MeshArena::Allocation> m_arenaAllocations;
 			std::vector<SubMesh> m_subMeshes;
+			std::vector<float> m_lodErrors;
 			Boxf m_aabb;
 	};
 }
@@ -12,6 +12,8 @@ namespace Nz
 		std::size_t subMeshIndex = m_subMeshes.size();
 		m_subMeshes.emplace_back(std::move(subMesh));
 
+		UpdateLODErrors();
+
 		OnInvalidated(this);
 
 		return subMeshIndex;
@@ -19,7 +21,10 @@ namespace Nz
 
 	inline void GraphicalMesh::Clear()
 	{
+		ReleaseArenaAllocations();
+
 		m_subMeshes.clear();
+		m_lodErrors.clear();
 
 		OnInvalidated(this);
 	}
@@ -29,16 +34,44 @@ namespace Nz
 		return m_aabb;
 	}
 
-	inline const std::shared_ptr<RenderBuffer>& GraphicalMesh::GetIndexBuffer(std::size_t subMesh) const
+	/*!
+	* \brief Gets the arena from which the submeshes buffers were allocated
+	* \return Mesh arena, or a null pointer if every submesh has its own buffers
+	*/
+	inline const std::shared_ptr<MeshArena>& GraphicalMesh::GetArena() const
+	{
+		return m_arena;
+	}
+
+	/*!
+	* \brief Gets the first index of a submesh in its index buffer
+	* \return Index to start drawing from, non-zero if the index buffer is shared with other submeshes
+	*
+	* \param subMesh Submesh index
+	* \param lodIndex Level of detail index
+	*/
+	inline UInt32 GraphicalMesh::GetFirstIndex(std::size_t subMesh, std::size_t lodIndex) const
 	{
 		assert(subMesh < m_subMeshes.size());
-		return m_subMeshes[subMesh].indexBuffer;
+		assert(lodIndex < GetLODCount());
+		const SubMesh& subMeshData = m_subMeshes[subMesh];
+		return (lodIndex > 0) ? subMeshData.levelsOfDetail[lodIndex - 1].firstIndex : subMeshData.firstIndex;
 	}
 
-	inline UInt32 GraphicalMesh::GetIndexCount(std::size_t subMesh) const
+	inline const std::shared_ptr<RenderBuffer>& GraphicalMesh::GetIndexBuffer(std::size_t subMesh, std::size_t lodIndex) const
 	{
 		assert(subMesh < m_subMeshes.size());
-		return m_subMeshes[subMesh].indexCount;
+		assert(lodIndex < GetLODCount());
+		const SubMesh& subMeshData = m_subMeshes[subMesh];
+		return (lodIndex > 0) ? subMeshData.levelsOfDetail[lodIndex - 1].indexBuffer : subMeshData.indexBuffer;
+	}
+
+	inline UInt32 GraphicalMesh::GetIndexCount(std::size_t subMesh, std::size_t lodIndex) const
+	{
+		assert(subMesh < m_subMeshes.size());
+		assert(lodIndex < GetLODCount());
+		const SubMesh& subMeshData = m_subMeshes[subMesh];
+		return (lodIndex > 0) ? subMeshData.levelsOfDetail[lodIndex - 1].indexCount : subMeshData.indexCount;
 	}
 
 	inline IndexType GraphicalMesh::GetIndexType(std::size_t subMesh) const
@@ -47,12 +80,57 @@ namespace Nz
 		return m_subMeshes[subMesh].indexType;
 	}
 
+	/*!
+	* \brief Gets the number of levels of detail available for every submesh
+	* \return Level of detail count, including the full detail level (zero)
+	*/
+	inline std::size_t GraphicalMesh::GetLODCount() const
+	{
+		return m_lodErrors.size() + 1;
+	}
+
+	/*!
+	* \brief Gets the simplification error of a level of detail
+	* \return Highest error of the submeshes for this level, relative to the mesh size (length of its AABB diagonal)
+	*
+	* \param lodIndex Level of detail index
+	*/
+	inline float GraphicalMesh::GetLODError(std::size_t lodIndex) const
+	{
+		assert(lodIndex < GetLODCount());
+		return (lodIndex > 0) ? m_lodErrors[lodIndex - 1] : 0.f;
+	}
+
+	inline const std::shared_ptr<RenderBuffer>& GraphicalMesh::GetSkinningBuffer(std::size_t subMesh) const
+	{
+		assert(subMesh < m_subMeshes.size());
+		return m_subMeshes[subMesh].skinningBuffer;
+	}
+
 	inline const std::shared_ptr<RenderBuffer>& GraphicalMesh::GetVertexBuffer(std::size_t subMesh) const
 	{
 		assert(subMesh < m_subMeshes.size());
 		return m_subMeshes[subMesh].vertexBuffer;
 	}
 
+	/*!
+	* \brief Gets the offset at which the vertex buffer of a submesh must be bound
+	* \return Offset in bytes, non-zero if the vertex buffer is shared with other submeshes
+	*
+	* \param subMesh Submesh index
+	*/
+	inline UInt64 GraphicalMesh::GetVertexBufferOffset(std::size_t subMesh) const
+	{
+		assert(subMesh < m_subMeshes.size());
+		return m_subMeshes[subMesh].vertexOffset;
+	}
+
+	inline UInt32 GraphicalMesh::GetVertexCount(std::size_t subMesh) const
+	{
+		assert(subMesh < m_subMeshes.size());
+		return m_subMeshes[subMesh].vertexCount;
+	}
+
 	inline const std::shared_ptr<const VertexDeclaration>& GraphicalMesh::GetVertexDeclaration(std::size_t subMesh) const
 	{
 		assert(subMesh < m_subMeshes.size());
@@ -85,6 +163,9 @@ namespace Nz
 		mesh.CreateStatic();
 		mesh.BuildSubMesh(primitive, params);
 
+		if (params.lodCount > 0)
+			mesh.GenerateLODs(params);
+
 		return BuildFromMesh(mesh);
 	}
 
@@ -94,6 +175,9 @@ namespace Nz
 		mesh.CreateStatic();
 		mesh.BuildSubMeshes(primitiveList, params);
 
+		if (params.lodCount > 0)
+			mesh.GenerateLODs(params);
+
 		return BuildFromMesh(mesh);
 	}
 
@@ -8,23 +8,31 @@
 #define NAZARA_GRAPHICS_HPP
 
 #include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Graphics/BindlessTextureTable.hpp>
 #include <Nazara/Graphics/Config.hpp>
 #include <Nazara/Graphics/Material.hpp>
 #include <Nazara/Graphics/MaterialInstance.hpp>
 #include <Nazara/Graphics/MaterialPassRegistry.hpp>
+#include <Nazara/Graphics/MeshArena.hpp>
+#include <Nazara/Graphics/RenderBufferPool.hpp>
+#include <Nazara/Graphics/ShaderVariantArchive.hpp>
 #include <Nazara/Graphics/TextureSamplerCache.hpp>
 #include <Nazara/Renderer/RenderDevice.hpp>
 #include <Nazara/Renderer/RenderPassCache.hpp>
 #include <Nazara/Renderer/RenderPipelineLayout.hpp>
 #include <Nazara/Renderer/Renderer.hpp>
 #include <NZSL/FilesystemModuleResolver.hpp>
+#include <filesystem>
+#include <mutex>
 #include <optional>
+#include <vector>
 
 namespace Nz
 {
 	class AppFilesystemComponent;
 	class CommandLineParameters;
 	class RenderBuffer;
+	class VertexDeclaration;
 
 	class NAZARA_GRAPHICS_API Graphics : public ModuleBase<Graphics>
 	{
@@ -40,16 +48,42 @@ namespace Nz
 			Graphics(Config config);
 			~Graphics();
 
+			inline const std::shared_ptr<BindlessTextureTable>& GetBindlessTextureTable() const;
 			inline const std::shared_ptr<RenderPipeline>& GetBlitPipeline(bool transparent) const;
 			inline const std::shared_ptr<RenderPipelineLayout>& GetBlitPipelineLayout() const;
 			inline const DefaultMaterials& GetDefaultMaterials() const;
 			inline const DefaultTextures& GetDefaultTextures() const;
+			inline const std::shared_ptr<RenderPipeline>& GetDeferredLightingPipeline() const;
+			inline const std::shared_ptr<RenderPipelineLayout>& GetDeferredLightingPipelineLayout() const;
+			inline const std::shared_ptr<RenderPipeline>& GetHiZDepthCopyPipeline() const;
+			inline const std::shared_ptr<RenderPipelineLayout>& GetHiZDepthCopyPipelineLayout() const;
+			inline const std::shared_ptr<ComputePipeline>& GetHiZDownsamplePipeline() const;
+			inline const std::shared_ptr<RenderPipelineLayout>& GetHiZDownsamplePipelineLayout() const;
+			inline const std::shared_ptr<RenderPipelineLayout>& GetImpostorBakePipelineLayout() const;
+			inline const std::shared_ptr<RenderPipeline>& GetImpostorRenderPipeline() const;
+			inline const std::shared_ptr<RenderPipelineLayout>& GetImpostorRenderPipelineLayout() const;
+			inline const std::shared_ptr<ComputePipeline>& GetInstanceCullingPipeline() const;
+			inline const std::shared_ptr<RenderPipelineLayout>& GetInstanceCullingPipelineLayout() const;
+			inline RenderBufferPool& GetInstanceDataBufferPool();
+			inline const std::shared_ptr<ComputePipeline>& GetLightClusteringPipeline() const;
+			inline const std::shared_ptr<RenderPipelineLayout>& GetLightClusteringPipelineLayout() const;
 			inline MaterialPassRegistry& GetMaterialPassRegistry();
 			inline const MaterialPassRegistry& GetMaterialPassRegistry() const;
 			inline MaterialInstanceLoader& GetMaterialInstanceLoader();
 			inline const MaterialInstanceLoader& GetMaterialInstanceLoader() const;
 			inline MaterialLoader& GetMaterialLoader();
 			inline const MaterialLoader& GetMaterialLoader() const;
+			inline const std::shared_ptr<MeshArena>& GetMeshArena() const;
+			inline const std::shared_ptr<ComputePipeline>& GetOcclusionTestPipeline() const;
+			inline const std::shared_ptr<RenderPipelineLayout>& GetOcclusionTestPipelineLayout() const;
+			inline const std::shared_ptr<RenderPipeline>& GetParticleRenderPipeline(ParticleBlendMode blendMode) const;
+			inline const std::shared_ptr<RenderPipelineLayout>& GetParticleRenderPipelineLayout() const;
+			inline const std::shared_ptr<ComputePipeline>& GetParticleSimulationPipeline(bool depthCollision) const;
+			inline const std::shared_ptr<RenderPipelineLayout>& GetParticleSimulationPipelineLayout() const;
+			inline const std::shared_ptr<ComputePipeline>& GetParticleSortKeysPipeline() const;
+			inline const std::shared_ptr<RenderPipelineLayout>& GetParticleSortKeysPipelineLayout() const;
+			inline const std::shared_ptr<ComputePipeline>& GetParticleSortPipeline() const;
+			inline const std::shared_ptr<RenderPipelineLayout>& GetParticleSortPipelineLayout() const;
 			inline PixelFormat GetPreferredDepthFormat() const;
 			inline PixelFormat GetPreferredDepthStencilFormat() const;
 			inline const std::shared_ptr<RenderDevice>& GetRenderDevice() const;
@@ -57,6 +91,26 @@ namespace Nz
 			inline TextureSamplerCache& GetSamplerCache();
 			inline std::shared_ptr<nzsl::FilesystemModuleResolver>& GetShaderModuleResolver();
 			inline const std::shared_ptr<nzsl::FilesystemModuleResolver>& GetShaderModuleResolver() const;
+			inline ShaderVariantArchive& GetShaderVariantArchive();
+			inline const ShaderVariantArchive& GetShaderVariantArchive() const;
+			inline const std::shared_ptr<const VertexDeclaration>& GetSkinnedVertexDeclaration() const;
+			inline const std::shared_ptr<ComputePipeline>& GetSkinningPipeline() const;
+			inline const std::shared_ptr<RenderPipelineLayout>& GetSkinningPipelineLayout() const;
+			inline const std::shared_ptr<RenderPipeline>& GetTerrainRenderPipeline() const;
+			inline const std::shared_ptr<RenderPipelineLayout>& GetTerrainRenderPipelineLayout() const;
+			inline const std::shared_ptr<RenderPipeline>& GetUpscalePipeline(UpscalingMode upscalingMode) const;
+			inline const std::shared_ptr<RenderPipelineLayout>& GetUpscalePipelineLayout(UpscalingMode upscalingMode) const;
+
+			inline bool IsBindlessTexturingEnabled() const;
+			inline bool IsClusteredLightingEnabled() const;
+			inline bool IsComputeSkinningEnabled() const;
+			inline bool IsDeferredShadingEnabled() const;
+			inline bool IsDynamicResolutionEnabled() const;
+			inline bool IsGpuDrivenRenderingEnabled() const;
+			inline bool IsImpostorEnabled() const;
+			inline bool IsOcclusionCullingEnabled() const;
+			inline bool IsParticleSystemEnabled() const;
+			inline bool IsTerrainEnabled() const;
 
 			void RegisterComponent(AppFilesystemComponent& component);
 
@@ -65,7 +119,21 @@ namespace Nz
 				void Override(const CommandLineParameters& parameters);
 
 				RenderDeviceFeatures forceDisableFeatures;
+				std::vector<TextureSamplerInfo> preallocatedSamplers; //< created with the render device in addition to the engine samplers, for resources loaded from other threads
+				std::filesystem::path shaderVariantArchivePath; //< precompiled shader variants, loaded if the file exists
+				bool preloadDefaultMaterials = false; //< build default materials with the module instead of on first use (by default, applications not using them don't pay for them)
+				bool recordShaderVariants = false; //< compile missing variants to the archive and save it on exit (requires shaderVariantArchivePath)
+				bool useBindlessTextures = false; //< materials declaring the bindless texture table sample their textures from it instead of binding them (requires bindless textures and storage buffers)
+				bool useComputeSkinning = false; //< skin meshes once per frame in a compute shader instead of in the vertex shader of every pass (requires compute shaders and storage buffers)
 				bool useDedicatedRenderDevice = true;
+				bool useDeferredShading = false; //< build the lighting pipeline required by DeferredFramePipeline (requires storage buffers), RenderSystem uses it when enabled
+				bool useDynamicResolution = false; //< build the upscaling pipelines required by ForwardFramePipeline dynamic resolution
+				bool useGpuDrivenRendering = false; //< cull instanced submeshes in a compute shader and draw them using indirect draw calls (requires compute shaders and storage buffers)
+				bool useImpostors = false; //< build the pipelines required to bake and draw model impostors (see ImpostorAtlas)
+				bool useMeshArena = false; //< sub-allocate meshes built by GraphicalMesh::BuildFromMesh from a few shared vertex and index buffers
+				bool useOcclusionCulling = false; //< skip renderables hidden behind the depth pre-pass of previous frames (requires compute shaders, storage buffers and texture read-write)
+				bool useParticleSystem = false; //< simulate and sort ParticleEmitter particles in compute shaders (requires compute shaders and storage buffers)
+				bool useTerrain = false; //< build the pipeline drawing ClipmapTerrain (requires texture read-write)
 			};
 
 			struct DefaultMaterials
@@ -87,27 +155,74 @@ namespace Nz
 
 		private:
 			void BuildBlitPipeline();
-			void BuildDefaultMaterials();
+			void BuildDefaultMaterials() const;
 			void BuildDefaultTextures();
+			void BuildDeferredLightingPipeline();
+			void BuildImpostorPipelines();
+			void BuildInstanceCullingPipeline();
+			void BuildLightClusteringPipeline();
+			void BuildOcclusionCullingPipelines();
+			void BuildParticlePipelines();
+			void BuildSkinningPipeline();
+			void BuildTerrainPipeline();
+			void BuildUpscalePipelines();
+			void PreallocateSamplers(const std::vector<TextureSamplerInfo>& userSamplers);
 			void RegisterMaterialPasses();
 			void RegisterShaderModules();
 			template<std::size_t N> void RegisterEmbedShaderModule(const UInt8(&content)[N]);
 			void SelectDepthStencilFormats();
 
+			std::optional<RenderBufferPool> m_instanceDataBufferPool;
 			std::optional<RenderPassCache> m_renderPassCache;
 			std::optional<TextureSamplerCache> m_samplerCache;
+			std::filesystem::path m_shaderVariantArchivePath;
 			std::shared_ptr<nzsl::FilesystemModuleResolver> m_shaderModuleResolver;
+			std::shared_ptr<BindlessTextureTable> m_bindlessTextureTable;
+			std::shared_ptr<MeshArena> m_meshArena;
+			std::shared_ptr<ComputePipeline> m_hiZDownsamplePipeline;
+			std::shared_ptr<ComputePipeline> m_instanceCullingPipeline;
+			std::shared_ptr<ComputePipeline> m_lightClusteringPipeline;
+			std::shared_ptr<ComputePipeline> m_occlusionTestPipeline;
+			std::shared_ptr<ComputePipeline> m_particleSimulationPipeline;
+			std::shared_ptr<ComputePipeline> m_particleSimulationCollisionPipeline;
+			std::shared_ptr<ComputePipeline> m_particleSortKeysPipeline;
+			std::shared_ptr<ComputePipeline> m_particleSortPipeline;
+			std::shared_ptr<const VertexDeclaration> m_skinnedVertexDeclaration;
+			std::shared_ptr<ComputePipeline> m_skinningPipeline;
+			std::shared_ptr<RenderPipelineLayout> m_skinningPipelineLayout;
 			std::shared_ptr<RenderDevice> m_renderDevice;
 			std::shared_ptr<RenderPipeline> m_blitPipeline;
 			std::shared_ptr<RenderPipeline> m_blitPipelineTransparent;
+			std::shared_ptr<RenderPipeline> m_deferredLightingPipeline;
+			std::shared_ptr<RenderPipeline> m_hiZDepthCopyPipeline;
+			std::shared_ptr<RenderPipeline> m_impostorRenderPipeline;
+			std::shared_ptr<RenderPipeline> m_terrainRenderPipeline;
 			std::shared_ptr<RenderPipelineLayout> m_blitPipelineLayout;
-			DefaultMaterials m_defaultMaterials;
+			std::shared_ptr<RenderPipelineLayout> m_deferredLightingPipelineLayout;
+			std::shared_ptr<RenderPipelineLayout> m_hiZDepthCopyPipelineLayout;
+			std::shared_ptr<RenderPipelineLayout> m_hiZDownsamplePipelineLayout;
+			std::shared_ptr<RenderPipelineLayout> m_impostorBakePipelineLayout;
+			std::shared_ptr<RenderPipelineLayout> m_impostorRenderPipelineLayout;
+			std::shared_ptr<RenderPipelineLayout> m_instanceCullingPipelineLayout;
+			std::shared_ptr<RenderPipelineLayout> m_lightClusteringPipelineLayout;
+			std::shared_ptr<RenderPipelineLayout> m_occlusionTestPipelineLayout;
+			std::shared_ptr<RenderPipelineLayout> m_particleRenderPipelineLayout;
+			std::shared_ptr<RenderPipelineLayout> m_particleSimulationPipelineLayout;
+			std::shared_ptr<RenderPipelineLayout> m_particleSortKeysPipelineLayout;
+			std::shared_ptr<RenderPipelineLayout> m_particleSortPipelineLayout;
+			std::shared_ptr<RenderPipelineLayout> m_terrainRenderPipelineLayout;
+			EnumArray<ParticleBlendMode, std::shared_ptr<RenderPipeline>> m_particleRenderPipelines;
+			EnumArray<UpscalingMode, std::shared_ptr<RenderPipeline>> m_upscalePipelines;
+			EnumArray<UpscalingMode, std::shared_ptr<RenderPipelineLayout>> m_upscalePipelineLayouts;
+			mutable DefaultMaterials m_defaultMaterials;
 			DefaultTextures m_defaultTextures;
 			MaterialInstanceLoader m_materialInstanceLoader;
 			MaterialLoader m_materialLoader;
 			MaterialPassRegistry m_materialPassRegistry;
+			ShaderVariantArchive m_shaderVariantArchive;
 			PixelFormat m_preferredDepthFormat;
 			PixelFormat m_preferredDepthStencilFormat;
+			mutable std::once_flag m_defaultMaterialsFlag;
 
 			static Graphics* s_instance;
 	};
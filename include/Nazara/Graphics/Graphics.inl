@@ -6,6 +6,11 @@
 
 namespace Nz
 {
+	inline const std::shared_ptr<BindlessTextureTable>& Graphics::GetBindlessTextureTable() const
+	{
+		return m_bindlessTextureTable;
+	}
+
 	inline const std::shared_ptr<RenderPipeline>& Graphics::GetBlitPipeline(bool transparent) const
 	{
 		return (transparent) ? m_blitPipelineTransparent : m_blitPipeline;
@@ -16,8 +21,12 @@ namespace Nz
 		return m_blitPipelineLayout;
 	}
 
+	/*!
+	* \brief Gets the default materials and their presets, building them on first call
+	*/
 	inline auto Graphics::GetDefaultMaterials() const -> const DefaultMaterials&
 	{
+		std::call_once(m_defaultMaterialsFlag, [this] { BuildDefaultMaterials(); });
 		return m_defaultMaterials;
 	}
 
@@ -26,6 +35,80 @@ namespace Nz
 		return m_defaultTextures;
 	}
 
+	inline const std::shared_ptr<RenderPipeline>& Graphics::GetDeferredLightingPipeline() const
+	{
+		return m_deferredLightingPipeline;
+	}
+
+	inline const std::shared_ptr<RenderPipelineLayout>& Graphics::GetDeferredLightingPipelineLayout() const
+	{
+		return m_deferredLightingPipelineLayout;
+	}
+
+	inline const std::shared_ptr<RenderPipeline>& Graphics::GetHiZDepthCopyPipeline() const
+	{
+		return m_hiZDepthCopyPipeline;
+	}
+
+	inline const std::shared_ptr<RenderPipelineLayout>& Graphics::GetHiZDepthCopyPipelineLayout() const
+	{
+		return m_hiZDepthCopyPipelineLayout;
+	}
+
+	inline const std::shared_ptr<ComputePipeline>& Graphics::GetHiZDownsamplePipeline() const
+	{
+		return m_hiZDownsamplePipeline;
+	}
+
+	inline const std::shared_ptr<RenderPipelineLayout>& Graphics::GetHiZDownsamplePipelineLayout() const
+	{
+		return m_hiZDownsamplePipelineLayout;
+	}
+
+	inline const std::shared_ptr<RenderPipelineLayout>& Graphics::GetImpostorBakePipelineLayout() const
+	{
+		return m_impostorBakePipelineLayout;
+	}
+
+	inline const std::shared_ptr<RenderPipeline>& Graphics::GetImpostorRenderPipeline() const
+	{
+		return m_impostorRenderPipeline;
+	}
+
+	inline const std::shared_ptr<RenderPipelineLayout>& Graphics::GetImpostorRenderPipelineLayout() const
+	{
+		return m_impostorRenderPipelineLayout;
+	}
+
+	inline const std::shared_ptr<ComputePipeline>& Graphics::GetInstanceCullingPipeline() const
+	{
+		return m_instanceCullingPipeline;
+	}
+
+	inline const std::shared_ptr<RenderPipelineLayout>& Graphics::GetInstanceCullingPipelineLayout() const
+	{
+		return m_instanceCullingPipelineLayout;
+	}
+
+	/*!
+	* \brief Returns the pool from which world instances get their instance data uniform buffer
+	*/
+	inline RenderBufferPool& Graphics::GetInstanceDataBufferPool()
+	{
+		assert(m_instanceDataBufferPool);
+		return *m_instanceDataBufferPool;
+	}
+
+	inline const std::shared_ptr<ComputePipeline>& Graphics::GetLightClusteringPipeline() const
+	{
+		return m_lightClusteringPipeline;
+	}
+
+	inline const std::shared_ptr<RenderPipelineLayout>& Graphics::GetLightClusteringPipelineLayout() const
+	{
+		return m_lightClusteringPipelineLayout;
+	}
+
 	inline MaterialPassRegistry& Graphics::GetMaterialPassRegistry()
 	{
 		return m_materialPassRegistry;
@@ -56,6 +139,65 @@ namespace Nz
 		return m_materialLoader;
 	}
 
+	/*!
+	* \brief Returns the arena from which GraphicalMesh::BuildFromMesh allocates mesh buffers
+	* \return Mesh arena, or a null pointer if it's not enabled (see Config::useMeshArena)
+	*/
+	inline const std::shared_ptr<MeshArena>& Graphics::GetMeshArena() const
+	{
+		return m_meshArena;
+	}
+
+	inline const std::shared_ptr<ComputePipeline>& Graphics::GetOcclusionTestPipeline() const
+	{
+		return m_occlusionTestPipeline;
+	}
+
+	inline const std::shared_ptr<RenderPipelineLayout>& Graphics::GetOcclusionTestPipelineLayout() const
+	{
+		return m_occlusionTestPipelineLayout;
+	}
+
+	inline const std::shared_ptr<RenderPipeline>& Graphics::GetParticleRenderPipeline(ParticleBlendMode blendMode) const
+	{
+		return m_particleRenderPipelines[blendMode];
+	}
+
+	inline const std::shared_ptr<RenderPipelineLayout>& Graphics::GetParticleRenderPipelineLayout() const
+	{
+		return m_particleRenderPipelineLayout;
+	}
+
+	inline const std::shared_ptr<ComputePipeline>& Graphics::GetParticleSimulationPipeline(bool depthCollision) const
+	{
+		return (depthCollision) ? m_particleSimulationCollisionPipeline : m_particleSimulationPipeline;
+	}
+
+	inline const std::shared_ptr<RenderPipelineLayout>& Graphics::GetParticleSimulationPipelineLayout() const
+	{
+		return m_particleSimulationPipelineLayout;
+	}
+
+	inline const std::shared_ptr<ComputePipeline>& Graphics::GetParticleSortKeysPipeline() const
+	{
+		return m_particleSortKeysPipeline;
+	}
+
+	inline const std::shared_ptr<RenderPipelineLayout>& Graphics::GetParticleSortKeysPipelineLayout() const
+	{
+		return m_particleSortKeysPipelineLayout;
+	}
+
+	inline const std::shared_ptr<ComputePipeline>& Graphics::GetParticleSortPipeline() const
+	{
+		return m_particleSortPipeline;
+	}
+
+	inline const std::shared_ptr<RenderPipelineLayout>& Graphics::GetParticleSortPipelineLayout() const
+	{
+		return m_particleSortPipelineLayout;
+	}
+
 	inline PixelFormat Graphics::GetPreferredDepthFormat() const
 	{
 		return m_preferredDepthFormat;
@@ -91,6 +233,101 @@ namespace Nz
 	{
 		return m_shaderModuleResolver;
 	}
+
+	inline ShaderVariantArchive& Graphics::GetShaderVariantArchive()
+	{
+		return m_shaderVariantArchive;
+	}
+
+	inline const ShaderVariantArchive& Graphics::GetShaderVariantArchive() const
+	{
+		return m_shaderVariantArchive;
+	}
+
+	inline const std::shared_ptr<const VertexDeclaration>& Graphics::GetSkinnedVertexDeclaration() const
+	{
+		return m_skinnedVertexDeclaration;
+	}
+
+	inline const std::shared_ptr<ComputePipeline>& Graphics::GetSkinningPipeline() const
+	{
+		return m_skinningPipeline;
+	}
+
+	inline const std::shared_ptr<RenderPipelineLayout>& Graphics::GetSkinningPipelineLayout() const
+	{
+		return m_skinningPipelineLayout;
+	}
+
+	inline const std::shared_ptr<RenderPipeline>& Graphics::GetTerrainRenderPipeline() const
+	{
+		return m_terrainRenderPipeline;
+	}
+
+	inline const std::shared_ptr<RenderPipelineLayout>& Graphics::GetTerrainRenderPipelineLayout() const
+	{
+		return m_terrainRenderPipelineLayout;
+	}
+
+	inline const std::shared_ptr<RenderPipeline>& Graphics::GetUpscalePipeline(UpscalingMode upscalingMode) const
+	{
+		return m_upscalePipelines[upscalingMode];
+	}
+
+	inline const std::shared_ptr<RenderPipelineLayout>& Graphics::GetUpscalePipelineLayout(UpscalingMode upscalingMode) const
+	{
+		return m_upscalePipelineLayouts[upscalingMode];
+	}
+
+	inline bool Graphics::IsBindlessTexturingEnabled() const
+	{
+		return m_bindlessTextureTable != nullptr;
+	}
+
+	inline bool Graphics::IsClusteredLightingEnabled() const
+	{
+		return m_lightClusteringPipeline != nullptr;
+	}
+
+	inline bool Graphics::IsComputeSkinningEnabled() const
+	{
+		return m_skinningPipeline != nullptr;
+	}
+
+	inline bool Graphics::IsDeferredShadingEnabled() const
+	{
+		return m_deferredLightingPipeline != nullptr;
+	}
+
+	inline bool Graphics::IsDynamicResolutionEnabled() const
+	{
+		return m_upscalePipelines[UpscalingMode::Spatial] != nullptr;
+	}
+
+	inline bool Graphics::IsGpuDrivenRenderingEnabled() const
+	{
+		return m_instanceCullingPipeline != nullptr;
+	}
+
+	inline bool Graphics::IsImpostorEnabled() const
+	{
+		return m_impostorRenderPipeline != nullptr;
+	}
+
+	inline bool Graphics::IsOcclusionCullingEnabled() const
+	{
+		return m_occlusionTestPipeline != nullptr;
+	}
+
+	inline bool Graphics::IsParticleSystemEnabled() const
+	{
+		return m_particleSimulationPipeline != nullptr;
+	}
+
+	inline bool Graphics::IsTerrainEnabled() const
+	{
+		return m_terrainRenderPipeline != nullptr;
+	}
 }
 
 #include <Nazara/Graphics/DebugOff.hpp>
@@ -18,7 +18,7 @@ namespace Nz
 	class NAZARA_GRAPHICS_API GuillotineTextureAtlas : public GuillotineImageAtlas
 	{
 		public:
-			inline GuillotineTextureAtlas(RenderDevice& renderDevice);
+			inline GuillotineTextureAtlas(RenderDevice& renderDevice, BinPackAlgorithm packingAlgorithm = BinPackAlgorithm::Guillotine);
 			~GuillotineTextureAtlas() = default;
 
 			DataStoreFlags GetStorage() const override;
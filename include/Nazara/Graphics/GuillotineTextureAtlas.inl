@@ -6,7 +6,8 @@
 
 namespace Nz
 {
-	inline GuillotineTextureAtlas::GuillotineTextureAtlas(RenderDevice& renderDevice) :
+	inline GuillotineTextureAtlas::GuillotineTextureAtlas(RenderDevice& renderDevice, BinPackAlgorithm packingAlgorithm) :
+	GuillotineImageAtlas(packingAlgorithm),
 	m_renderDevice(renderDevice)
 	{
 	}
@@ -0,0 +1,101 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_GRAPHICS_IMAGESTREAMTEXTURE_HPP
+#define NAZARA_GRAPHICS_IMAGESTREAMTEXTURE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Core/Time.hpp>
+#include <Nazara/Graphics/Config.hpp>
+#include <NazaraUtils/Signal.hpp>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace Nz
+{
+	class ImageStream;
+	class MaterialInstance;
+	class RenderDevice;
+	class Texture;
+
+	class NAZARA_GRAPHICS_API ImageStreamTexture
+	{
+		public:
+			ImageStreamTexture(std::shared_ptr<ImageStream> imageStream, std::size_t bufferCount = 3);
+			ImageStreamTexture(std::shared_ptr<RenderDevice> renderDevice, std::shared_ptr<ImageStream> imageStream, std::size_t bufferCount = 3);
+			ImageStreamTexture(const ImageStreamTexture&) = delete;
+			ImageStreamTexture(ImageStreamTexture&&) = delete;
+			~ImageStreamTexture();
+
+			void BindMaterialTexture(std::shared_ptr<MaterialInstance> materialInstance, std::size_t texturePropertyIndex);
+
+			inline void EnableLooping(bool loop = true);
+
+			inline const std::shared_ptr<ImageStream>& GetImageStream() const;
+			inline Time GetPlaybackTime() const;
+			const std::shared_ptr<Texture>& GetTexture() const;
+
+			inline bool IsLooping() const;
+			inline bool IsPaused() const;
+			inline bool IsPlaybackOver() const;
+
+			inline void Pause();
+			void Restart();
+			inline void Resume();
+
+			void UnbindMaterial(const MaterialInstance* materialInstance);
+
+			void Update(Time elapsedTime);
+
+			ImageStreamTexture& operator=(const ImageStreamTexture&) = delete;
+			ImageStreamTexture& operator=(ImageStreamTexture&&) = delete;
+
+			NazaraSignal(OnTextureFlip, ImageStreamTexture* /*streamTexture*/, const std::shared_ptr<Texture>& /*newTexture*/);
+
+		private:
+			void PresentFrame(std::size_t frameIndex);
+			void RetrieveDecodedFrame();
+			void StartDecoding();
+
+			static constexpr std::size_t InvalidIndex = std::numeric_limits<std::size_t>::max();
+
+			struct MaterialBinding
+			{
+				std::shared_ptr<MaterialInstance> materialInstance;
+				std::size_t texturePropertyIndex;
+			};
+
+			struct StagingFrame
+			{
+				std::vector<UInt8> pixels;
+				Time frameTime;
+				bool decoded;
+			};
+
+			std::deque<std::size_t> m_readyFrames;
+			std::shared_ptr<ImageStream> m_imageStream;
+			std::shared_ptr<RenderDevice> m_renderDevice;
+			std::size_t m_currentTexture;
+			std::size_t m_decodingFrame;
+			std::vector<std::shared_ptr<Texture>> m_textures;
+			std::vector<std::size_t> m_freeFrames;
+			std::vector<MaterialBinding> m_materialBindings;
+			std::vector<StagingFrame> m_stagingFrames;
+			TaskScheduler::TaskHandle m_decodingTask;
+			Time m_loopOffset;
+			Time m_playbackTime;
+			bool m_isLooping;
+			bool m_isPaused;
+			bool m_streamEnded;
+	};
+}
+
+#include <Nazara/Graphics/ImageStreamTexture.inl>
+
+#endif // NAZARA_GRAPHICS_IMAGESTREAMTEXTURE_HPP
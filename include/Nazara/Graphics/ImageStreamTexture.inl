@@ -0,0 +1,58 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Enables looping, the stream restarts from its first frame once its end has been reached
+	*
+	* \param loop Should the stream loop
+	*/
+	inline void ImageStreamTexture::EnableLooping(bool loop)
+	{
+		m_isLooping = loop;
+	}
+
+	inline const std::shared_ptr<ImageStream>& ImageStreamTexture::GetImageStream() const
+	{
+		return m_imageStream;
+	}
+
+	inline Time ImageStreamTexture::GetPlaybackTime() const
+	{
+		return m_playbackTime;
+	}
+
+	inline bool ImageStreamTexture::IsLooping() const
+	{
+		return m_isLooping;
+	}
+
+	inline bool ImageStreamTexture::IsPaused() const
+	{
+		return m_isPaused;
+	}
+
+	/*!
+	* \brief Checks if the last frame of a non-looping stream has been presented
+	*/
+	inline bool ImageStreamTexture::IsPlaybackOver() const
+	{
+		return m_streamEnded && !m_decodingTask.IsValid() && m_readyFrames.empty();
+	}
+
+	inline void ImageStreamTexture::Pause()
+	{
+		m_isPaused = true;
+	}
+
+	inline void ImageStreamTexture::Resume()
+	{
+		m_isPaused = false;
+	}
+}
+
+#include <Nazara/Graphics/DebugOff.hpp>
@@ -0,0 +1,69 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_GRAPHICS_IMPOSTORATLAS_HPP
+#define NAZARA_GRAPHICS_IMPOSTORATLAS_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Graphics/Config.hpp>
+#include <Nazara/Math/Vector3.hpp>
+#include <memory>
+
+namespace Nz
+{
+	class Model;
+	class RenderBuffer;
+	class RenderFrame;
+	class Texture;
+
+	/*!
+	* \brief Views of a model rendered from directions spread over the sphere (octahedral mapping), used to draw distant instances of the model as quads
+	*
+	* Frames are stored in a grid of frameCount x frameCount frames, frame (x, y) is rendered from the direction decoded by DecodeOctahedral from the frame center (in [-1, 1]).
+	* Every frame is an orthographic view of the model bounding sphere, in model space.
+	*/
+	class NAZARA_GRAPHICS_API ImpostorAtlas
+	{
+		public:
+			struct BakeParams;
+
+			ImpostorAtlas(std::shared_ptr<Texture> atlasTexture, UInt32 frameCount, const Vector3f& center, float radius, float screenSize);
+			ImpostorAtlas(const ImpostorAtlas&) = delete;
+			ImpostorAtlas(ImpostorAtlas&&) = delete;
+			~ImpostorAtlas() = default;
+
+			inline const std::shared_ptr<Texture>& GetAtlasTexture() const;
+			inline const Vector3f& GetCenter() const;
+			inline UInt32 GetFrameCount() const;
+			inline const std::shared_ptr<RenderBuffer>& GetImpostorBuffer() const;
+			inline float GetRadius() const;
+			inline float GetScreenSize() const;
+
+			ImpostorAtlas& operator=(const ImpostorAtlas&) = delete;
+			ImpostorAtlas& operator=(ImpostorAtlas&&) = delete;
+
+			static std::shared_ptr<ImpostorAtlas> Bake(RenderFrame& renderFrame, const Model& model, const BakeParams& params = BakeParams{});
+
+			struct BakeParams
+			{
+				float alphaThreshold = 0.5f; //< texels of the base color map with a lower alpha are transparent
+				UInt32 frameCount = 8; //< number of frames on each side of the atlas
+				UInt32 frameSize = 128; //< size of a frame in pixels
+			};
+
+		private:
+			std::shared_ptr<RenderBuffer> m_impostorBuffer;
+			std::shared_ptr<Texture> m_atlasTexture;
+			Vector3f m_center;
+			UInt32 m_frameCount;
+			float m_radius;
+			float m_screenSize;
+	};
+}
+
+#include <Nazara/Graphics/ImpostorAtlas.inl>
+
+#endif // NAZARA_GRAPHICS_IMPOSTORATLAS_HPP
@@ -0,0 +1,49 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	inline const std::shared_ptr<Texture>& ImpostorAtlas::GetAtlasTexture() const
+	{
+		return m_atlasTexture;
+	}
+
+	/*!
+	* \brief Returns the center of the bounding sphere of the baked model, in model space
+	*/
+	inline const Vector3f& ImpostorAtlas::GetCenter() const
+	{
+		return m_center;
+	}
+
+	inline UInt32 ImpostorAtlas::GetFrameCount() const
+	{
+		return m_frameCount;
+	}
+
+	/*!
+	* \brief Returns the uniform buffer holding the impostor parameters read by the ImpostorRender shader
+	*/
+	inline const std::shared_ptr<RenderBuffer>& ImpostorAtlas::GetImpostorBuffer() const
+	{
+		return m_impostorBuffer;
+	}
+
+	inline float ImpostorAtlas::GetRadius() const
+	{
+		return m_radius;
+	}
+
+	/*!
+	* \brief Returns the projected size (in pixels) of the model below which the impostor replaces it
+	*/
+	inline float ImpostorAtlas::GetScreenSize() const
+	{
+		return m_screenSize;
+	}
+}
+
+#include <Nazara/Graphics/DebugOff.hpp>
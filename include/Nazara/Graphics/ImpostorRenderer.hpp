@@ -0,0 +1,61 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_GRAPHICS_IMPOSTORRENDERER_HPP
+#define NAZARA_GRAPHICS_IMPOSTORRENDERER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Graphics/ElementRenderer.hpp>
+#include <Nazara/Graphics/RenderImpostor.hpp>
+#include <Nazara/Renderer/ShaderBinding.hpp>
+#include <map>
+#include <memory>
+#include <utility>
+
+namespace Nz
+{
+	class ImpostorAtlas;
+	class RenderBuffer;
+	class RenderDevice;
+
+	struct NAZARA_GRAPHICS_API ImpostorRendererData : public ElementRendererData
+	{
+		struct InstanceData
+		{
+			std::shared_ptr<RenderBuffer> impostorBuffer; //< keeps the impostor buffer from being reused by another impostor allocated at the same address
+			const RenderBuffer* instanceBuffer = nullptr;
+			UInt64 instanceBufferOffset = 0;
+			ShaderBindingPtr shaderBinding;
+			bool isUsed = true;
+		};
+
+		std::map<std::pair<const WorldInstance*, const ImpostorAtlas*>, InstanceData> instances;
+	};
+
+	class NAZARA_GRAPHICS_API ImpostorRenderer final : public ElementRenderer
+	{
+		public:
+			ImpostorRenderer(RenderDevice& device);
+			~ImpostorRenderer() = default;
+
+			RenderElementPool<RenderImpostor>& GetPool() override;
+
+			std::unique_ptr<ElementRendererData> InstanciateData() override;
+			void Prepare(const ViewerInstance& viewerInstance, ElementRendererData& rendererData, RenderFrame& currentFrame, std::size_t elementCount, const Pointer<const RenderElement>* elements, const RenderStates* renderStates) override;
+			void PrepareEnd(RenderFrame& currentFrame, ElementRendererData& rendererData) override;
+			void Render(const ViewerInstance& viewerInstance, ElementRendererData& rendererData, CommandBufferBuilder& commandBuffer, std::size_t elementCount, const Pointer<const RenderElement>* elements) override;
+			void Reset(ElementRendererData& rendererData, RenderFrame& currentFrame) override;
+
+		private:
+			std::shared_ptr<RenderBuffer> m_indexBuffer;
+			RenderElementPool<RenderImpostor> m_impostorPool;
+			RenderDevice& m_device;
+	};
+}
+
+#include <Nazara/Graphics/ImpostorRenderer.inl>
+
+#endif // NAZARA_GRAPHICS_IMPOSTORRENDERER_HPP
@@ -8,9 +8,14 @@
 #define NAZARA_GRAPHICS_INSTANCEDRENDERABLE_HPP
 
 #include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/Time.hpp>
 #include <Nazara/Graphics/Config.hpp>
+#include <Nazara/Graphics/MaterialPassRegistry.hpp>
 #include <Nazara/Graphics/RenderElementOwner.hpp>
 #include <Nazara/Math/Box.hpp>
+#include <Nazara/Math/Matrix4.hpp>
+#include <Nazara/Math/Rect.hpp>
+#include <Nazara/Math/Vector3.hpp>
 #include <NazaraUtils/Signal.hpp>
 #include <memory>
 
@@ -20,13 +25,16 @@ namespace Nz
 	class ElementRendererRegistry;
 	class MaterialInstance;
 	class RenderElement;
+	class RenderFrame;
 	class SkeletonInstance;
+	class Texture;
 	class WorldInstance;
 
 	class NAZARA_GRAPHICS_API InstancedRenderable
 	{
 		public:
 			struct ElementData;
+			struct SimulationData;
 
 			inline InstancedRenderable();
 			InstancedRenderable(const InstancedRenderable&) = delete;
@@ -36,10 +44,18 @@ namespace Nz
 			virtual void BuildElement(ElementRendererRegistry& registry, const ElementData& elementData, std::size_t passIndex, std::vector<RenderElementOwner>& elements) const = 0;
 
 			inline const Boxf& GetAABB() const;
+			virtual std::size_t GetLODCount() const;
+			virtual float GetLODError(std::size_t lodIndex) const;
 			virtual const std::shared_ptr<MaterialInstance>& GetMaterial(std::size_t i) const = 0;
 			virtual std::size_t GetMaterialCount() const = 0;
 			inline int GetRenderLayer() const;
 
+			virtual bool IsSimulated() const;
+
+			virtual void RegisterComputeSkinning(SkeletonInstance& skeletonInstance) const;
+
+			virtual void Simulate(RenderFrame& renderFrame, CommandBufferBuilder& builder, const WorldInstance& worldInstance, const SimulationData& simulationData) const;
+
 			inline void UpdateRenderLayer(int renderLayer);
 
 			InstancedRenderable& operator=(const InstancedRenderable&) = delete;
@@ -54,6 +70,17 @@ namespace Nz
 				const Recti* scissorBox;
 				const SkeletonInstance* skeletonInstance;
 				const WorldInstance* worldInstance;
+				std::size_t lodIndex = 0;
+				std::size_t excludedPassIndex = MaterialPassRegistry::InvalidIndex; //< materials having this pass are skipped (as they're rendered by it)
+			};
+
+			struct SimulationData
+			{
+				const Texture* depthTexture = nullptr; //< depth of a viewer in a previous frame (see OcclusionCuller::GetDepthPyramid), null if no depth is available
+				Matrix4f depthViewProjMatrix;
+				Recti depthViewport;
+				Time elapsedTime;
+				Vector3f depthEyePosition;
 			};
 
 		protected:
@@ -34,7 +34,7 @@ namespace Nz
 			Light(Light&&) noexcept = default;
 			virtual ~Light();
 
-			virtual float ComputeContributionScore(const BoundingVolumef& boundingVolume) const = 0;
+			virtual float ComputeContributionScore(const Boxf& worldAABB) const = 0;
 
 			inline void EnableShadowCasting(bool castShadows);
 
@@ -6,6 +6,25 @@
 
 namespace Nz
 {
+	inline LightShadowData::LightShadowData() :
+	m_isPerViewer(false)
+	{
+	}
+
+	/*!
+	* \brief Returns true if shadows are rendered for each viewer (and not once per light)
+	*
+	* Per-viewer shadow data expect a valid viewer when preparing rendering, registering passes and retrieving shadow maps.
+	*/
+	inline bool LightShadowData::IsPerViewer() const
+	{
+		return m_isPerViewer;
+	}
+
+	inline void LightShadowData::UpdatePerViewerStatus(bool isPerViewer)
+	{
+		m_isPerViewer = isPerViewer;
+	}
 }
 
 #include <Nazara/Graphics/DebugOff.hpp>
@@ -42,6 +42,7 @@ namespace Nz
 	{
 		public:
 			struct TextureData;
+			struct TextureIndexBufferData;
 			struct UniformBlockData;
 			using Params = MaterialParams;
 
@@ -59,9 +60,12 @@ namespace Nz
 			inline const MaterialSettings& GetSettings() const;
 			inline const TextureData& GetTextureData(std::size_t textureIndex) const;
 			inline std::size_t GetTextureCount() const;
+			inline const TextureIndexBufferData& GetTextureIndexBufferData() const;
 			inline const UniformBlockData& GetUniformBlockData(std::size_t uniformBlockIndex) const;
 			inline std::size_t GetUniformBlockCount() const;
 
+			inline bool HasBindlessTextures() const;
+
 			std::shared_ptr<MaterialInstance> Instantiate() const;
 
 			static std::shared_ptr<Material> Build(const ParameterList& materialData);
@@ -80,6 +84,14 @@ namespace Nz
 				UInt32 bindingSet;
 				UInt32 bindingIndex;
 				ImageType imageType;
+				std::size_t bindlessIndexOffset; //< offset of the texture slot in the texture index buffer, InvalidIndex if the texture is bound directly
+			};
+
+			struct TextureIndexBufferData
+			{
+				UInt32 bindingSet;
+				UInt32 bindingIndex;
+				std::unique_ptr<RenderBufferPool> bufferPool; //< null if the material doesn't use bindless textures
 			};
 
 			struct UniformBlockData
@@ -96,6 +108,7 @@ namespace Nz
 			std::unordered_map<std::string /*tag*/, std::size_t> m_textureByTag;
 			std::unordered_map<std::string /*tag*/, std::size_t> m_uniformBlockByTag;
 			std::vector<TextureData> m_textures;
+			TextureIndexBufferData m_textureIndexBuffer;
 			std::vector<UniformBlockData> m_uniformBlocks;
 			mutable std::weak_ptr<MaterialInstance> m_defaultInstance;
 			EnumArray<EngineShaderBinding, UInt32> m_engineShaderBindings;
@@ -50,6 +50,11 @@ namespace Nz
 		return m_textures.size();
 	}
 
+	inline auto Material::GetTextureIndexBufferData() const -> const TextureIndexBufferData&
+	{
+		return m_textureIndexBuffer;
+	}
+
 	inline auto Material::GetUniformBlockData(std::size_t uniformBlockIndex) const -> const UniformBlockData&
 	{
 		assert(uniformBlockIndex < m_uniformBlocks.size());
@@ -61,6 +66,11 @@ namespace Nz
 		return m_uniformBlocks.size();
 	}
 
+	inline bool Material::HasBindlessTextures() const
+	{
+		return m_textureIndexBuffer.bufferPool != nullptr;
+	}
+
 	inline ImageType Material::ToImageType(nzsl::ImageType imageType)
 	{
 		switch (imageType)
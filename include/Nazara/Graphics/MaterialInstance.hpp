@@ -29,6 +29,7 @@ namespace Nz
 		bool IsValid() const;
 	};
 
+	class BindlessTextureTable;
 	class Material;
 	class MaterialInstance;
 	class MaterialPipeline;
@@ -127,6 +128,7 @@ namespace Nz
 		private:
 			inline void InvalidatePassPipeline(std::size_t passIndex);
 			inline void InvalidateShaderBinding();
+			void UpdateBindlessTextureSlot(std::size_t textureIndex);
 
 			struct PassShader
 			{
@@ -158,12 +160,11 @@ namespace Nz
 
 			struct UniformBuffer
 			{
-				std::size_t bufferIndex;
-				std::vector<UInt8> values;
+				std::size_t bufferIndex; //< content is stored by the material buffer pool
 				RenderBufferView bufferView;
-				bool dataInvalidated = true;
 			};
 
+			std::shared_ptr<BindlessTextureTable> m_bindlessTextureTable;
 			std::shared_ptr<const Material> m_parent;
 			std::unordered_map<UInt32, nzsl::Ast::ConstantSingleValue> m_optionValuesOverride;
 			std::vector<MaterialSettings::Value> m_valueOverride;
@@ -171,6 +172,8 @@ namespace Nz
 			std::vector<TextureBinding> m_textureBinding;
 			std::vector<TextureProperty> m_textureOverride;
 			std::vector<UniformBuffer> m_uniformBuffers;
+			std::vector<UInt32> m_bindlessTextureSlots; //< slot of every texture in the bindless texture table, InvalidSlot for textures bound directly
+			UniformBuffer m_textureIndexBuffer; //< storage buffer allocated from the material texture index pool (if it uses bindless textures)
 			const MaterialSettings& m_materialSettings;
 	};
 }
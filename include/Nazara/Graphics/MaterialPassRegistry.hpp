@@ -9,6 +9,7 @@
 
 #include <NazaraUtils/Prerequisites.hpp>
 #include <NazaraUtils/Algorithm.hpp>
+#include <limits>
 #include <list>
 #include <string>
 #include <unordered_map>
@@ -30,6 +31,8 @@ namespace Nz
 			MaterialPassRegistry& operator=(const MaterialPassRegistry&) = default;
 			MaterialPassRegistry& operator=(MaterialPassRegistry&&) = default;
 
+			static constexpr std::size_t InvalidIndex = std::numeric_limits<std::size_t>::max();
+
 		private:
 			std::list<std::string> m_passNames; //< in order to allow std::string_view as a key in C++17 (keep std::string stable as well because of SSO)
 			std::unordered_map<std::string_view, std::size_t> m_passIndex;
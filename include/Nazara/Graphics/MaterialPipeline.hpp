@@ -8,14 +8,17 @@
 #define NAZARA_GRAPHICS_MATERIALPIPELINE_HPP
 
 #include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Graphics/Config.hpp>
 #include <Nazara/Graphics/Enums.hpp>
 #include <Nazara/Graphics/UberShader.hpp>
 #include <Nazara/Renderer/RenderPipeline.hpp>
 #include <NazaraUtils/FixedVector.hpp>
+#include <NazaraUtils/Signal.hpp>
 #include <NZSL/Ast/ConstantValue.hpp>
 #include <array>
 #include <memory>
+#include <vector>
 
 namespace Nz
 {
@@ -39,6 +42,13 @@ namespace Nz
 		FixedVector<Shader, 8> shaders;
 	};
 
+	struct MaterialPipelinePrewarmInfo
+	{
+		MaterialPipelineInfo pipelineInfo;
+		std::vector<RenderPipelineInfo::VertexBufferData> vertexBuffers;
+		bool instancing = false;
+	};
+
 	inline bool operator==(const MaterialPipelineInfo& lhs, const MaterialPipelineInfo& rhs);
 	inline bool operator!=(const MaterialPipelineInfo& lhs, const MaterialPipelineInfo& rhs);
 
@@ -59,25 +69,60 @@ namespace Nz
 			MaterialPipeline& operator=(MaterialPipeline&&) = delete;
 
 			inline const MaterialPipelineInfo& GetInfo() const;
+			const std::shared_ptr<RenderPipeline>& GetInstancedRenderPipeline(const RenderPipelineInfo::VertexBufferData* vertexBuffers, std::size_t vertexBufferCount) const;
 			const std::shared_ptr<RenderPipeline>& GetRenderPipeline(const RenderPipelineInfo::VertexBufferData* vertexBuffers, std::size_t vertexBufferCount) const;
 
+			bool IsPrewarming(const RenderPipelineInfo::VertexBufferData* vertexBuffers, std::size_t vertexBufferCount, bool instancing = false) const;
+
+			TaskScheduler::TaskHandle Prewarm(const RenderPipelineInfo::VertexBufferData* vertexBuffers, std::size_t vertexBufferCount, bool instancing = false) const;
+
+			bool SupportsInstancing() const;
+
 			static const std::shared_ptr<MaterialPipeline>& Get(const MaterialPipelineInfo& pipelineInfo);
+			static std::vector<TaskScheduler::TaskHandle> Prewarm(const std::vector<MaterialPipelinePrewarmInfo>& prewarmInfos);
+			static void ProcessPrewarmedPipelines();
+
+			NazaraSignal(OnRenderPipelineReady, const MaterialPipeline* /*materialPipeline*/);
 
 		private:
+			struct PrewarmedPipeline;
+
 			static bool Initialize();
 			static void Uninitialize();
 
+			RenderPipelineInfo BuildPipelineInfo(const RenderPipelineInfo::VertexBufferData* vertexBuffers, std::size_t vertexBufferCount) const;
+			std::shared_ptr<RenderPipeline> BuildRenderPipeline(const RenderPipelineInfo::VertexBufferData* vertexBuffers, std::size_t vertexBufferCount, bool instancing) const;
+			void BuildShaderModules(RenderPipelineInfo& renderPipelineInfo, bool instancing) const;
+			const std::shared_ptr<PrewarmedPipeline>* FindPrewarmedPipeline(const RenderPipelineInfo::VertexBufferData* vertexBuffers, std::size_t vertexBufferCount, bool instancing) const;
+			const std::shared_ptr<RenderPipeline>& FinalizePrewarmedPipeline(std::shared_ptr<PrewarmedPipeline> prewarmedPipeline) const;
+			bool ProcessPrewarmedPipeline() const;
+			void WaitForPrewarmedPipelines() const;
+
+			static const std::shared_ptr<RenderPipeline>* FindRenderPipeline(const std::vector<std::shared_ptr<RenderPipeline>>& renderPipelines, const RenderPipelineInfo::VertexBufferData* vertexBuffers, std::size_t vertexBufferCount);
+			static bool IsEqual(const std::vector<RenderPipelineInfo::VertexBufferData>& lhs, const RenderPipelineInfo::VertexBufferData* vertexBuffers, std::size_t vertexBufferCount);
+
+			struct PrewarmedPipeline
+			{
+				RenderPipelineInfo pipelineInfo;
+				TaskScheduler::TaskHandle task;
+				bool failed;
+				bool instancing;
+			};
+
 			struct UberShaderEntry
 			{
 				NazaraSlot(UberShader, OnShaderUpdated, onShaderUpdated);
 			};
 
+			mutable std::vector<std::shared_ptr<RenderPipeline>> m_instancedRenderPipelines;
+			mutable std::vector<std::shared_ptr<PrewarmedPipeline>> m_prewarmedPipelines;
 			mutable std::vector<std::shared_ptr<RenderPipeline>> m_renderPipelines;
 			std::vector<UberShaderEntry> m_uberShaderEntries;
 			MaterialPipelineInfo m_pipelineInfo;
 
 			using PipelineCache = std::unordered_map<MaterialPipelineInfo, std::shared_ptr<MaterialPipeline>>;
 			static PipelineCache s_pipelineCache;
+			static std::vector<const MaterialPipeline*> s_prewarmingPipelines;
 	};
 }
 
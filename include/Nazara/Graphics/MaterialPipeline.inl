@@ -17,7 +17,10 @@ namespace Nz
 		{
 			m_uberShaderEntries[i].onShaderUpdated.Connect(m_pipelineInfo.shaders[i].uberShader->OnShaderUpdated, [this](UberShader*)
 			{
-				// Clear cache
+				// Clear cache (pending prewarm tasks were compiling outdated shaders)
+				WaitForPrewarmedPipelines();
+				m_prewarmedPipelines.clear();
+				m_instancedRenderPipelines.clear();
 				m_renderPipelines.clear();
 			});
 		}
@@ -0,0 +1,96 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_GRAPHICS_MESHARENA_HPP
+#define NAZARA_GRAPHICS_MESHARENA_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Graphics/Config.hpp>
+#include <Nazara/Renderer/RenderBuffer.hpp>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Nz
+{
+	class RenderDevice;
+	class VertexDeclaration;
+
+	/*!
+	* \brief Sub-allocates mesh vertices and indices from a few big GPU buffers
+	*
+	* Vertices are grouped by vertex declaration (every vertex buffer of the arena holds a single vertex layout), indices of every type share the same buffers.
+	* Submeshes allocated from the arena share their buffers and are drawn using offsets, which saves buffer objects and rebinds between draws.
+	*/
+	class NAZARA_GRAPHICS_API MeshArena
+	{
+		public:
+			struct Allocation;
+
+			MeshArena(std::shared_ptr<RenderDevice> renderDevice, UInt64 blockSize = DefaultBlockSize);
+			MeshArena(const MeshArena&) = delete;
+			MeshArena(MeshArena&&) = delete;
+			~MeshArena() = default;
+
+			Allocation AllocateIndices(UInt64 size);
+			Allocation AllocateVertices(const std::shared_ptr<const VertexDeclaration>& vertexDeclaration, UInt64 size);
+
+			void Free(const Allocation& allocation);
+
+			inline UInt64 GetBlockSize() const;
+			std::size_t GetBufferCount() const;
+
+			MeshArena& operator=(const MeshArena&) = delete;
+			MeshArena& operator=(MeshArena&&) = delete;
+
+			struct Allocation
+			{
+				std::shared_ptr<RenderBuffer> buffer;
+				std::size_t blockIndex;
+				UInt64 offset; //< multiple of the vertex stride for vertices, of four for indices
+				UInt64 size;
+			};
+
+			static constexpr UInt64 DefaultBlockSize = 4 * 1024 * 1024;
+			static constexpr UInt64 IndexAlignment = 4; //< covers every index type
+
+		private:
+			struct Block;
+			struct Pool;
+
+			Allocation Allocate(Pool& pool, BufferType bufferType, UInt64 size, UInt64 alignment);
+
+			struct FreeRange
+			{
+				UInt64 offset;
+				UInt64 size;
+			};
+
+			struct Block
+			{
+				std::shared_ptr<RenderBuffer> buffer;
+				std::vector<FreeRange> freeRanges; //< sorted by offset, adjacent ranges are always merged
+			};
+
+			struct Pool
+			{
+				std::shared_ptr<const VertexDeclaration> vertexDeclaration;
+				std::vector<std::size_t> blockIndices;
+			};
+
+			std::shared_ptr<RenderDevice> m_renderDevice;
+			std::unordered_map<const VertexDeclaration*, Pool> m_vertexPools;
+			std::vector<Block> m_blocks;
+			mutable std::mutex m_mutex;
+			Pool m_indexPool;
+			UInt64 m_blockSize;
+	};
+}
+
+#include <Nazara/Graphics/MeshArena.inl>
+
+#endif // NAZARA_GRAPHICS_MESHARENA_HPP
@@ -0,0 +1,15 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	inline UInt64 MeshArena::GetBlockSize() const
+	{
+		return m_blockSize;
+	}
+}
+
+#include <Nazara/Graphics/DebugOff.hpp>
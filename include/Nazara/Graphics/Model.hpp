@@ -11,6 +11,7 @@
 #include <Nazara/Graphics/Config.hpp>
 #include <Nazara/Graphics/GraphicalMesh.hpp>
 #include <Nazara/Graphics/InstancedRenderable.hpp>
+#include <Nazara/Graphics/MaterialPipeline.hpp>
 #include <Nazara/Renderer/RenderPipeline.hpp>
 #include <Nazara/Utility/Mesh.hpp>
 #include <Nazara/Utility/VertexDeclaration.hpp>
@@ -18,6 +19,8 @@
 
 namespace Nz
 {
+	class AnimationTexture;
+	class ImpostorAtlas;
 	class Material;
 
 	class NAZARA_GRAPHICS_API Model : public InstancedRenderable
@@ -30,14 +33,23 @@ namespace Nz
 
 			void BuildElement(ElementRendererRegistry& registry, const ElementData& elementData, std::size_t passIndex, std::vector<RenderElementOwner>& elements) const override;
 
+			inline const std::shared_ptr<AnimationTexture>& GetAnimationTexture() const;
+			inline const std::shared_ptr<GraphicalMesh>& GetGraphicalMesh() const;
+			inline const std::shared_ptr<ImpostorAtlas>& GetImpostor() const;
 			const std::shared_ptr<RenderBuffer>& GetIndexBuffer(std::size_t subMeshIndex) const;
 			std::size_t GetIndexCount(std::size_t subMeshIndex) const;
+			std::size_t GetLODCount() const override;
+			float GetLODError(std::size_t lodIndex) const override;
 			const std::shared_ptr<MaterialInstance>& GetMaterial(std::size_t subMeshIndex) const override;
 			std::size_t GetMaterialCount() const override;
 			inline std::size_t GetSubMeshCount() const;
 			const std::vector<RenderPipelineInfo::VertexBufferData>& GetVertexBufferData(std::size_t subMeshIndex) const;
 			const std::shared_ptr<RenderBuffer>& GetVertexBuffer(std::size_t subMeshIndex) const;
 
+			void RegisterComputeSkinning(SkeletonInstance& skeletonInstance) const override;
+
+			void SetAnimationTexture(std::shared_ptr<AnimationTexture> animationTexture);
+			void SetImpostor(std::shared_ptr<ImpostorAtlas> impostor);
 			inline void SetMaterial(std::size_t subMeshIndex, std::shared_ptr<MaterialInstance> material);
 
 			Model& operator=(const Model&) = delete;
@@ -47,12 +59,18 @@ namespace Nz
 			struct SubMeshData
 			{
 				std::shared_ptr<MaterialInstance> material;
+				std::vector<RenderPipelineInfo::VertexBufferData> skinnedVertexBufferData;
 				std::vector<RenderPipelineInfo::VertexBufferData> vertexBufferData;
+				bool hasJoints;
+
+				mutable NazaraSlot(MaterialPipeline, OnRenderPipelineReady, onRenderPipelineReady);
 			};
 
 			NazaraSlot(GraphicalMesh, OnInvalidated, m_onInvalidated);
 
+			std::shared_ptr<AnimationTexture> m_animationTexture;
 			std::shared_ptr<GraphicalMesh> m_graphicalMesh;
+			std::shared_ptr<ImpostorAtlas> m_impostor;
 			std::vector<SubMeshData> m_submeshes;
 	};
 }
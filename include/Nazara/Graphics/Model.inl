@@ -7,6 +7,21 @@
 
 namespace Nz
 {
+	inline const std::shared_ptr<AnimationTexture>& Model::GetAnimationTexture() const
+	{
+		return m_animationTexture;
+	}
+
+	inline const std::shared_ptr<GraphicalMesh>& Model::GetGraphicalMesh() const
+	{
+		return m_graphicalMesh;
+	}
+
+	inline const std::shared_ptr<ImpostorAtlas>& Model::GetImpostor() const
+	{
+		return m_impostor;
+	}
+
 	inline std::size_t Model::GetSubMeshCount() const
 	{
 		return m_submeshes.size();
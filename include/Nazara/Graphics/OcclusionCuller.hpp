@@ -0,0 +1,141 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_GRAPHICS_OCCLUSIONCULLER_HPP
+#define NAZARA_GRAPHICS_OCCLUSIONCULLER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Graphics/Config.hpp>
+#include <Nazara/Math/Box.hpp>
+#include <Nazara/Math/Matrix4.hpp>
+#include <Nazara/Math/Rect.hpp>
+#include <Nazara/Math/Vector2.hpp>
+#include <Nazara/Math/Vector3.hpp>
+#include <Nazara/Renderer/ShaderBinding.hpp>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace Nz
+{
+	class AbstractViewer;
+	class BakedFrameGraph;
+	class CommandBufferBuilder;
+	class FrameGraph;
+	class RenderBuffer;
+	class RenderFrame;
+	class Texture;
+
+	/*!
+	* \brief Hierarchical-Z occlusion culling of a viewer renderables
+	*
+	* The depth of the viewer depth pre-pass is copied and reduced to a max-depth pyramid in compute, which is used to test
+	* the bounding boxes of the renderables inside the viewer frustum. Results are read back once the GPU is done with the frame
+	* and used to skip occluded renderables in the next frames, as long as they are still valid (see IsOccluded).
+	*/
+	class NAZARA_GRAPHICS_API OcclusionCuller
+	{
+		public:
+			OcclusionCuller(AbstractViewer* viewer);
+			OcclusionCuller(const OcclusionCuller&) = delete;
+			OcclusionCuller(OcclusionCuller&&) = delete;
+			~OcclusionCuller() = default;
+
+			void AddCandidate(std::size_t renderableIndex, const Boxf& aabb, UInt8 generation);
+
+			void Dispatch(RenderFrame& renderFrame, CommandBufferBuilder& builder, const BakedFrameGraph& bakedGraph);
+
+			inline const Texture* GetDepthPyramid() const;
+			inline const Vector3f& GetDepthPyramidEyePosition() const;
+			inline const Matrix4f& GetDepthPyramidViewProjMatrix() const;
+			inline const Recti& GetDepthPyramidViewport() const;
+
+			inline void Invalidate();
+			inline bool IsOccluded(std::size_t renderableIndex, const Boxf& aabb, UInt8 generation) const;
+
+			void Prepare();
+
+			void RegisterToFrameGraph(FrameGraph& frameGraph, std::size_t depthBufferIndex);
+
+			void UpdateBindings(RenderFrame& renderFrame, const BakedFrameGraph& bakedGraph);
+
+			OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+			OcclusionCuller& operator=(OcclusionCuller&&) = delete;
+
+			static constexpr std::size_t MaxLevelCount = 16;
+
+		private:
+			struct Candidate
+			{
+				Boxf aabb;
+				std::size_t renderableIndex;
+				UInt8 generation;
+			};
+
+			struct RenderableResult
+			{
+				Boxf aabb;
+				UInt64 readbackIndex = 0;
+				UInt8 generation;
+				bool occluded = false;
+			};
+
+			// Viewer state the results are valid for
+			struct ViewState
+			{
+				Matrix4f projectionMatrix;
+				Recti viewport;
+				Vector3f eyePosition;
+				UInt64 epoch;
+			};
+
+			struct ReadbackSlot
+			{
+				std::shared_ptr<RenderBuffer> candidateBuffer;
+				std::shared_ptr<RenderBuffer> cullingDataBuffer;
+				std::shared_ptr<RenderBuffer> resultBuffer;
+				std::vector<Candidate> candidates;
+				ShaderBindingPtr shaderBinding;
+				const Texture* pyramidTexture = nullptr;
+				std::size_t capacity = 0;
+				ViewState viewState;
+			};
+
+			struct ReadbackState
+			{
+				std::vector<ReadbackSlot> freeSlots;
+				std::vector<RenderableResult> results; //< indexed by renderable index
+				ViewState viewState;
+				UInt64 lastReadbackIndex = 0;
+			};
+
+			void BuildPyramid(RenderFrame& renderFrame, const Vector2ui& baseSize);
+			static void ReadResults(ReadbackState& state, ReadbackSlot& slot, UInt64 readbackIndex);
+
+			std::shared_ptr<ReadbackState> m_readbackState;
+			std::shared_ptr<RenderBuffer> m_levelDataBuffer;
+			std::shared_ptr<Texture> m_pyramidTexture;
+			std::size_t m_depthBufferIndex;
+			std::size_t m_depthCopyAttachment;
+			std::size_t m_levelCount;
+			std::vector<Candidate> m_candidates;
+			std::vector<Recti> m_levels;
+			std::vector<ShaderBindingPtr> m_levelShaderBindings;
+			AbstractViewer* m_viewer;
+			ShaderBindingPtr m_depthCopyShaderBinding;
+			UInt64 m_epoch;
+			UInt64 m_nextReadbackIndex;
+			Matrix4f m_pyramidViewProjMatrix;
+			ViewState m_pyramidViewState;
+			ViewState m_viewState;
+			Vector2ui m_pyramidBaseSize;
+			bool m_areResultsUsable;
+	};
+}
+
+#include <Nazara/Graphics/OcclusionCuller.inl>
+
+#endif // NAZARA_GRAPHICS_OCCLUSIONCULLER_HPP
@@ -0,0 +1,64 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Returns the depth pyramid built by the last dispatch
+	* \return Depth pyramid texture (R32F storage texture in general layout, the base level at the origin is a copy of the viewer depth) or a null pointer if none has been built yet
+	*
+	* The pyramid is kept until the next dispatch rebuilds it, the viewer state it was built with is returned by the GetDepthPyramid* methods.
+	*/
+	inline const Texture* OcclusionCuller::GetDepthPyramid() const
+	{
+		return m_pyramidTexture.get();
+	}
+
+	inline const Vector3f& OcclusionCuller::GetDepthPyramidEyePosition() const
+	{
+		return m_pyramidViewState.eyePosition;
+	}
+
+	inline const Matrix4f& OcclusionCuller::GetDepthPyramidViewProjMatrix() const
+	{
+		return m_pyramidViewProjMatrix;
+	}
+
+	inline const Recti& OcclusionCuller::GetDepthPyramidViewport() const
+	{
+		return m_pyramidViewState.viewport;
+	}
+
+	/*!
+	* \brief Discards current results
+	*
+	* Must be called when renderables inside the viewer frustum moved or changed, as they may not occlude the same renderables anymore
+	*/
+	inline void OcclusionCuller::Invalidate()
+	{
+		m_epoch++;
+	}
+
+	/*!
+	* \brief Checks if a renderable was hidden by the depth of a previous frame
+	*
+	* Renderables which were not tested by the last readback, or which changed since, are considered visible
+	*/
+	inline bool OcclusionCuller::IsOccluded(std::size_t renderableIndex, const Boxf& aabb, UInt8 generation) const
+	{
+		if (!m_areResultsUsable)
+			return false;
+
+		const auto& results = m_readbackState->results;
+		if (renderableIndex >= results.size())
+			return false;
+
+		const RenderableResult& result = results[renderableIndex];
+		return result.occluded && result.readbackIndex == m_readbackState->lastReadbackIndex && result.generation == generation && result.aabb == aabb;
+	}
+}
+
+#include <Nazara/Graphics/DebugOff.hpp>
@@ -0,0 +1,113 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_GRAPHICS_PARTICLEEMITTER_HPP
+#define NAZARA_GRAPHICS_PARTICLEEMITTER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/Color.hpp>
+#include <Nazara/Graphics/Config.hpp>
+#include <Nazara/Graphics/Enums.hpp>
+#include <Nazara/Graphics/InstancedRenderable.hpp>
+#include <Nazara/Renderer/ShaderBinding.hpp>
+#include <deque>
+#include <memory>
+
+namespace Nz
+{
+	class RenderBuffer;
+
+	// Particles are simulated on the GPU (requires Graphics::Config::useParticleSystem), an emitter should only be attached to one entity
+	class NAZARA_GRAPHICS_API ParticleEmitter : public InstancedRenderable
+	{
+		public:
+			ParticleEmitter(std::shared_ptr<Texture> texture, ParticleBlendMode blendMode = ParticleBlendMode::Additive, std::size_t maxParticleCount = 4096);
+			ParticleEmitter(const ParticleEmitter&) = delete;
+			ParticleEmitter(ParticleEmitter&&) noexcept = default;
+			~ParticleEmitter() = default;
+
+			inline bool AreCollisionsEnabled() const;
+
+			void BuildElement(ElementRendererRegistry& registry, const ElementData& elementData, std::size_t passIndex, std::vector<RenderElementOwner>& elements) const override;
+
+			inline void EnableCollisions(bool enable = true);
+
+			inline void Emit(std::size_t particleCount);
+
+			inline ParticleBlendMode GetBlendMode() const;
+			inline const std::shared_ptr<RenderBuffer>& GetDrawBuffer() const;
+			inline float GetEmissionRate() const;
+			inline const std::shared_ptr<RenderBuffer>& GetEmitterBuffer() const;
+			const std::shared_ptr<MaterialInstance>& GetMaterial(std::size_t i) const override;
+			std::size_t GetMaterialCount() const override;
+			inline std::size_t GetMaxParticleCount() const;
+			inline const std::shared_ptr<RenderBuffer>& GetParticleBuffer() const;
+			inline const std::shared_ptr<Texture>& GetTexture() const;
+
+			bool IsSimulated() const override;
+
+			inline void SetCollisionRestitution(float restitution);
+			inline void SetCollisionThickness(float thickness);
+			inline void SetColors(const Color& startColor, const Color& endColor);
+			inline void SetDrag(float drag);
+			inline void SetEmissionRate(float particlePerSecond);
+			inline void SetGravity(const Vector3f& gravity);
+			inline void SetLifetime(float minLifetime, float maxLifetime);
+			inline void SetSizes(float startSize, float endSize);
+			inline void SetSpawnExtent(const Vector3f& spawnExtent);
+			inline void SetTexture(std::shared_ptr<Texture> texture);
+			inline void SetVelocity(const Vector3f& minVelocity, const Vector3f& maxVelocity);
+
+			void Simulate(RenderFrame& renderFrame, CommandBufferBuilder& builder, const WorldInstance& worldInstance, const SimulationData& simulationData) const override;
+
+			ParticleEmitter& operator=(const ParticleEmitter&) = delete;
+			ParticleEmitter& operator=(ParticleEmitter&&) noexcept = default;
+
+		private:
+			void UpdateBounds();
+
+			struct SpawnBatch
+			{
+				float spawnTime;
+				std::size_t particleCount;
+			};
+
+			std::shared_ptr<RenderBuffer> m_drawBuffer;
+			std::shared_ptr<RenderBuffer> m_emitterBuffer;
+			std::shared_ptr<RenderBuffer> m_particleBuffer;
+			std::shared_ptr<Texture> m_texture;
+			std::size_t m_maxParticleCount;
+			mutable std::deque<SpawnBatch> m_spawnHistory; //< particles spawned during the last lifetime, to know which ones may still be alive
+			mutable std::size_t m_pendingParticleCount;
+			mutable std::size_t m_ringCursor;
+			mutable std::size_t m_spawnHistoryCount;
+			mutable const Texture* m_simulationDepthTexture;
+			mutable ShaderBindingPtr m_simulationShaderBinding;
+			mutable UInt32 m_simulationFrame;
+			mutable float m_simulationTime;
+			mutable float m_spawnAccumulator;
+			Color m_endColor;
+			Color m_startColor;
+			ParticleBlendMode m_blendMode;
+			Vector3f m_gravity;
+			Vector3f m_maxVelocity;
+			Vector3f m_minVelocity;
+			Vector3f m_spawnExtent;
+			bool m_collisionsEnabled;
+			float m_collisionRestitution;
+			float m_collisionThickness;
+			float m_drag;
+			float m_emissionRate;
+			float m_endSize;
+			float m_maxLifetime;
+			float m_minLifetime;
+			float m_startSize;
+	};
+}
+
+#include <Nazara/Graphics/ParticleEmitter.inl>
+
+#endif // NAZARA_GRAPHICS_PARTICLEEMITTER_HPP
@@ -0,0 +1,150 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <cassert>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	inline bool ParticleEmitter::AreCollisionsEnabled() const
+	{
+		return m_collisionsEnabled;
+	}
+
+	inline void ParticleEmitter::EnableCollisions(bool enable)
+	{
+		m_collisionsEnabled = enable;
+	}
+
+	/*!
+	* \brief Spawns particles during the next simulation, in addition to the emission rate
+	*/
+	inline void ParticleEmitter::Emit(std::size_t particleCount)
+	{
+		m_pendingParticleCount += particleCount;
+	}
+
+	inline ParticleBlendMode ParticleEmitter::GetBlendMode() const
+	{
+		return m_blendMode;
+	}
+
+	inline const std::shared_ptr<RenderBuffer>& ParticleEmitter::GetDrawBuffer() const
+	{
+		return m_drawBuffer;
+	}
+
+	inline float ParticleEmitter::GetEmissionRate() const
+	{
+		return m_emissionRate;
+	}
+
+	inline const std::shared_ptr<RenderBuffer>& ParticleEmitter::GetEmitterBuffer() const
+	{
+		return m_emitterBuffer;
+	}
+
+	inline std::size_t ParticleEmitter::GetMaxParticleCount() const
+	{
+		return m_maxParticleCount;
+	}
+
+	inline const std::shared_ptr<RenderBuffer>& ParticleEmitter::GetParticleBuffer() const
+	{
+		return m_particleBuffer;
+	}
+
+	inline const std::shared_ptr<Texture>& ParticleEmitter::GetTexture() const
+	{
+		return m_texture;
+	}
+
+	/*!
+	* \brief Sets the velocity factor kept by particles bouncing on the depth buffer
+	*/
+	inline void ParticleEmitter::SetCollisionRestitution(float restitution)
+	{
+		m_collisionRestitution = restitution;
+	}
+
+	/*!
+	* \brief Sets the thickness given to the depth buffer surfaces, particles farther behind them are considered hidden instead of colliding
+	*/
+	inline void ParticleEmitter::SetCollisionThickness(float thickness)
+	{
+		m_collisionThickness = thickness;
+	}
+
+	inline void ParticleEmitter::SetColors(const Color& startColor, const Color& endColor)
+	{
+		m_startColor = startColor;
+		m_endColor = endColor;
+	}
+
+	inline void ParticleEmitter::SetDrag(float drag)
+	{
+		m_drag = drag;
+	}
+
+	inline void ParticleEmitter::SetEmissionRate(float particlePerSecond)
+	{
+		assert(particlePerSecond >= 0.f);
+		m_emissionRate = particlePerSecond;
+	}
+
+	inline void ParticleEmitter::SetGravity(const Vector3f& gravity)
+	{
+		m_gravity = gravity;
+
+		UpdateBounds();
+	}
+
+	inline void ParticleEmitter::SetLifetime(float minLifetime, float maxLifetime)
+	{
+		assert(minLifetime >= 0.f && minLifetime <= maxLifetime);
+		m_minLifetime = minLifetime;
+		m_maxLifetime = maxLifetime;
+
+		UpdateBounds();
+	}
+
+	inline void ParticleEmitter::SetSizes(float startSize, float endSize)
+	{
+		m_startSize = startSize;
+		m_endSize = endSize;
+
+		UpdateBounds();
+	}
+
+	/*!
+	* \brief Sets the half-extent of the box (in local space) in which particles are spawned
+	*/
+	inline void ParticleEmitter::SetSpawnExtent(const Vector3f& spawnExtent)
+	{
+		m_spawnExtent = spawnExtent;
+
+		UpdateBounds();
+	}
+
+	inline void ParticleEmitter::SetTexture(std::shared_ptr<Texture> texture)
+	{
+		assert(texture);
+		m_texture = std::move(texture);
+
+		OnElementInvalidated(this);
+	}
+
+	/*!
+	* \brief Sets the range of the initial velocity (in local space) of particles, each component is picked randomly in this range
+	*/
+	inline void ParticleEmitter::SetVelocity(const Vector3f& minVelocity, const Vector3f& maxVelocity)
+	{
+		m_minVelocity = minVelocity;
+		m_maxVelocity = maxVelocity;
+
+		UpdateBounds();
+	}
+}
+
+#include <Nazara/Graphics/DebugOff.hpp>
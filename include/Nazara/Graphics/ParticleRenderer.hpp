@@ -0,0 +1,72 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_GRAPHICS_PARTICLERENDERER_HPP
+#define NAZARA_GRAPHICS_PARTICLERENDERER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Graphics/ElementRenderer.hpp>
+#include <Nazara/Graphics/RenderParticles.hpp>
+#include <Nazara/Renderer/ShaderBinding.hpp>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Nz
+{
+	class ParticleEmitter;
+	class RenderBuffer;
+	class RenderDevice;
+
+	struct NAZARA_GRAPHICS_API ParticleRendererData : public ElementRendererData
+	{
+		struct EmitterData
+		{
+			std::shared_ptr<RenderBuffer> particleBuffer; //< keeps the emitter buffers from being reused by another emitter allocated at the same address
+			std::shared_ptr<RenderBuffer> sortBuffer;
+			std::size_t sortEntryCount = 0;
+			std::vector<ShaderBindingPtr> sortStepShaderBindings;
+			const Texture* texture = nullptr;
+			ShaderBindingPtr drawShaderBinding;
+			ShaderBindingPtr sortKeysShaderBinding;
+			bool isUsed = true;
+		};
+
+		std::unordered_map<const ParticleEmitter*, EmitterData> emitters;
+		std::vector<const ParticleEmitter*> sortedEmitters; //< alpha-blended emitters of the last Prepare
+	};
+
+	class NAZARA_GRAPHICS_API ParticleRenderer final : public ElementRenderer
+	{
+		public:
+			ParticleRenderer(RenderDevice& device);
+			~ParticleRenderer() = default;
+
+			RenderElementPool<RenderParticles>& GetPool() override;
+
+			std::unique_ptr<ElementRendererData> InstanciateData() override;
+			void Prepare(const ViewerInstance& viewerInstance, ElementRendererData& rendererData, RenderFrame& currentFrame, std::size_t elementCount, const Pointer<const RenderElement>* elements, const RenderStates* renderStates) override;
+			void PrepareEnd(RenderFrame& currentFrame, ElementRendererData& rendererData) override;
+			void Render(const ViewerInstance& viewerInstance, ElementRendererData& rendererData, CommandBufferBuilder& commandBuffer, std::size_t elementCount, const Pointer<const RenderElement>* elements) override;
+			void Reset(ElementRendererData& rendererData, RenderFrame& currentFrame) override;
+			void Update(RenderFrame& currentFrame, ElementRendererData& rendererData) override;
+
+			static constexpr std::size_t MaxSortEntryCountLog2 = 24;
+
+		private:
+			void PrepareSorting(const ViewerInstance& viewerInstance, const ParticleEmitter& emitter, ParticleRendererData::EmitterData& emitterData);
+
+			std::shared_ptr<RenderBuffer> m_indexBuffer;
+			std::shared_ptr<RenderBuffer> m_sortStepBuffer;
+			std::size_t m_sortStepAlignedSize;
+			RenderElementPool<RenderParticles> m_particlesPool;
+			RenderDevice& m_device;
+	};
+}
+
+#include <Nazara/Graphics/ParticleRenderer.inl>
+
+#endif // NAZARA_GRAPHICS_PARTICLERENDERER_HPP
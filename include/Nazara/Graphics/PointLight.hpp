@@ -23,7 +23,7 @@ namespace Nz
 			PointLight(PointLight&&) noexcept = default;
 			~PointLight() = default;
 
-			float ComputeContributionScore(const BoundingVolumef& boundingVolume) const override;
+			float ComputeContributionScore(const Boxf& worldAABB) const override;
 
 			void FillLightData(void* data) const override;
 
@@ -13,7 +13,9 @@
 #include <Nazara/Graphics/Light.hpp>
 #include <Nazara/Graphics/LightShadowData.hpp>
 #include <Nazara/Graphics/ShadowViewer.hpp>
+#include <Nazara/Math/Matrix4.hpp>
 #include <array>
+#include <vector>
 
 namespace Nz
 {
@@ -28,13 +30,13 @@ namespace Nz
 			PointLightShadowData(PointLightShadowData&&) = delete;
 			~PointLightShadowData() = default;
 
-			void PrepareRendering(RenderFrame& renderFrame) override;
+			void PrepareRendering(RenderFrame& renderFrame, const AbstractViewer* viewer) override;
 
 			void RegisterMaterialInstance(const MaterialInstance& matInstance) override;
-			void RegisterPassInputs(FramePass& pass) override;
-			void RegisterToFrameGraph(FrameGraph& frameGraph) override;
+			void RegisterPassInputs(FramePass& pass, const AbstractViewer* viewer) override;
+			void RegisterToFrameGraph(FrameGraph& frameGraph, const AbstractViewer* viewer) override;
 
-			const Texture* RetrieveLightShadowmap(const BakedFrameGraph& bakedGraph) const override;
+			const Texture* RetrieveLightShadowmap(const BakedFrameGraph& bakedGraph, const AbstractViewer* viewer) const override;
 
 			void UnregisterMaterialInstance(const MaterialInstance& matInstance) override;
 
@@ -49,13 +51,19 @@ namespace Nz
 			{
 				std::optional<DepthPipelinePass> depthPass;
 				std::size_t attachmentIndex;
+				std::size_t visibilityHash;
+				std::vector<FramePipelinePass::VisibleRenderable> visibleRenderables;
+				Matrix4f cullingViewProjMatrix;
 				ShadowViewer viewer;
 			};
 
 			std::array<DirectionData, 6> m_directions;
 			std::size_t m_cubeAttachmentIndex;
+			std::vector<FramePipelinePass::VisibleRenderable> m_visibleRenderables;
+			std::vector<UInt8> m_visibleFaceMasks;
 			FramePipeline& m_pipeline;
 			const PointLight& m_light;
+			bool m_isCullingValid;
 	};
 }
 
@@ -25,15 +25,27 @@ namespace Nz
 			std::size_t parameter3;
 			std::size_t shadowMapSize;
 			std::size_t viewProjMatrix;
+			std::size_t cascadeCount;
+			std::size_t cascadeDistances;
+			std::size_t cascadeViewProjMatrices;
 		};
 
-		std::size_t lightsOffset;
+		std::size_t clusterCountXOffset;
+		std::size_t clusterCountYOffset;
+		std::size_t clusterCountZOffset;
+		std::size_t clusterStrideOffset;
+		std::size_t depthSliceScaleOffset;
+		std::size_t globalLightCountOffset;
 		std::size_t lightCountOffset;
-		std::size_t lightSize;
+		std::size_t lightSize; //< stride of lights in the light storage buffer
+		std::size_t shadowedLightCountOffset;
 		std::size_t totalSize;
+		std::size_t zFarOffset;
+		std::size_t zNearOffset;
 		Light lightMemberOffsets;
 
-		static constexpr std::size_t MaxLightCount = 3;
+		static constexpr std::size_t MaxLightCascadeCount = 4;
+		static constexpr std::size_t MaxShadowedLightCount = 3;
 
 		static PredefinedLightData GetOffsets();
 	};
@@ -47,6 +59,35 @@ namespace Nz
 		static PredefinedInstanceData GetOffsets();
 	};
 
+	struct NAZARA_GRAPHICS_API PredefinedInstanceAnimationArrayData
+	{
+		struct InstanceAnimation
+		{
+			std::size_t frameCoords;
+			std::size_t interpolation;
+			std::size_t texelWidth;
+		};
+
+		std::size_t instancesOffset;
+		std::size_t instanceStride;
+		std::size_t totalSize;
+		InstanceAnimation instanceMemberOffsets;
+
+		static PredefinedInstanceAnimationArrayData GetOffsets();
+	};
+
+	struct NAZARA_GRAPHICS_API PredefinedInstanceArrayData
+	{
+		std::size_t instancesOffset;
+		std::size_t instanceStride;
+		std::size_t totalSize;
+		PredefinedInstanceData instanceMemberOffsets;
+
+		static constexpr std::size_t MaxInstanceCount = 128;
+
+		static PredefinedInstanceArrayData GetOffsets();
+	};
+
 	struct NAZARA_GRAPHICS_API PredefinedSkeletalData
 	{
 		std::size_t totalSize;
@@ -57,6 +98,26 @@ namespace Nz
 		static PredefinedSkeletalData GetOffsets();
 	};
 
+	struct NAZARA_GRAPHICS_API PredefinedSkinningData
+	{
+		struct Vertex
+		{
+			std::size_t jointIndices;
+			std::size_t jointWeights;
+			std::size_t normal;
+			std::size_t position;
+			std::size_t tangent;
+			std::size_t uv;
+		};
+
+		std::size_t vertexCountOffset;
+		std::size_t verticesOffset;
+		std::size_t vertexSize;
+		Vertex vertexMemberOffsets;
+
+		static PredefinedSkinningData GetOffsets();
+	};
+
 	struct NAZARA_GRAPHICS_API PredefinedViewerData
 	{
 		std::size_t eyePositionOffset;
@@ -9,6 +9,7 @@
 
 #include <NazaraUtils/Prerequisites.hpp>
 #include <Nazara/Graphics/Config.hpp>
+#include <Nazara/Graphics/TransferInterface.hpp>
 #include <Nazara/Renderer/RenderBufferView.hpp>
 #include <NazaraUtils/Bitset.hpp>
 #include <vector>
@@ -18,7 +19,12 @@ namespace Nz
 	class RenderBuffer;
 	class RenderDevice;
 
-	class NAZARA_GRAPHICS_API RenderBufferPool
+	/*!
+	* \brief Allocates fixed-size buffers from big blocks of GPU memory
+	*
+	* Content of every allocated buffer is shadowed on the CPU: updates only mark buffers as dirty and are uploaded with a few copies per block on OnTransfer.
+	*/
+	class NAZARA_GRAPHICS_API RenderBufferPool : public TransferInterface
 	{
 		public:
 			RenderBufferPool(std::shared_ptr<RenderDevice> renderDevice, BufferType bufferType, std::size_t bufferSize, std::size_t bufferPerBlock = 2048);
@@ -34,18 +40,33 @@ namespace Nz
 			inline UInt64 GetBufferPerBlock() const;
 			inline UInt64 GetBufferSize() const;
 			inline BufferType GetBufferType() const;
+			inline const void* GetEntryData(std::size_t index) const;
+
+			void OnTransfer(RenderFrame& renderFrame, CommandBufferBuilder& builder) override;
+
+			void Update(std::size_t index, UInt64 offset, UInt64 size, const void* data);
 
 			RenderBufferPool& operator=(const RenderBufferPool&) = delete;
 			RenderBufferPool& operator=(RenderBufferPool&&) = delete;
 
+			static constexpr std::size_t MaxMergedCleanEntries = 8; //< clean entries which can be uploaded along dirty entries to save a copy
+
 		private:
+			struct BufferBlock
+			{
+				std::shared_ptr<RenderBuffer> buffer;
+				std::vector<UInt8> data;
+			};
+
 			UInt64 m_bufferAlignedSize;
 			UInt64 m_bufferPerBlock;
 			UInt64 m_bufferSize;
 			std::shared_ptr<RenderDevice> m_renderDevice;
-			std::vector<std::shared_ptr<RenderBuffer>> m_bufferBlocks;
+			std::vector<BufferBlock> m_bufferBlocks;
 			Bitset<UInt64> m_availableEntries;
+			Bitset<UInt64> m_dirtyEntries;
 			BufferType m_bufferType;
+			bool m_isTransferQueued;
 	};
 }
 
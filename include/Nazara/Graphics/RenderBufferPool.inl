@@ -2,6 +2,7 @@
 // This file is part of the "Nazara Engine - Graphics module"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
+#include <Nazara/Core/Error.hpp>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
@@ -25,6 +26,16 @@ namespace Nz
 	{
 		return m_bufferType;
 	}
+
+	inline const void* RenderBufferPool::GetEntryData(std::size_t index) const
+	{
+		NazaraAssert(!m_availableEntries.Test(index), "index is not a currently active buffer");
+
+		std::size_t blockIndex = index / m_bufferPerBlock;
+		std::size_t localIndex = index - (blockIndex * m_bufferPerBlock); //< faster than index % m_bufferPerBlock
+
+		return &m_bufferBlocks[blockIndex].data[localIndex * m_bufferAlignedSize];
+	}
 }
 
 #include <Nazara/Graphics/DebugOff.hpp>
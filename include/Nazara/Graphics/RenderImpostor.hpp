@@ -0,0 +1,43 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_GRAPHICS_RENDERIMPOSTOR_HPP
+#define NAZARA_GRAPHICS_RENDERIMPOSTOR_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Graphics/RenderElement.hpp>
+#include <Nazara/Graphics/RenderQueueRegistry.hpp>
+#include <Nazara/Graphics/WorldInstance.hpp>
+
+namespace Nz
+{
+	class ImpostorAtlas;
+
+	class RenderImpostor : public RenderElement
+	{
+		public:
+			inline RenderImpostor(int renderLayer, const ImpostorAtlas& impostor, const WorldInstance& worldInstance);
+			~RenderImpostor() = default;
+
+			inline UInt64 ComputeSortingScore(const Frustumf& frustum, const RenderQueueRegistry& registry) const override;
+
+			inline const ImpostorAtlas& GetImpostor() const;
+			inline const WorldInstance& GetWorldInstance() const;
+
+			inline void Register(RenderQueueRegistry& registry) const override;
+
+			static constexpr BasicRenderElement ElementType = BasicRenderElement::Impostor;
+
+		private:
+			const ImpostorAtlas& m_impostor;
+			const WorldInstance& m_worldInstance;
+			int m_renderLayer;
+	};
+}
+
+#include <Nazara/Graphics/RenderImpostor.inl>
+
+#endif // NAZARA_GRAPHICS_RENDERIMPOSTOR_HPP
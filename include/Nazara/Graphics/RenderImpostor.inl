@@ -0,0 +1,58 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/Algorithm.hpp>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	inline RenderImpostor::RenderImpostor(int renderLayer, const ImpostorAtlas& impostor, const WorldInstance& worldInstance) :
+	RenderElement(BasicRenderElement::Impostor),
+	m_impostor(impostor),
+	m_worldInstance(worldInstance),
+	m_renderLayer(renderLayer)
+	{
+	}
+
+	inline UInt64 RenderImpostor::ComputeSortingScore(const Frustumf& frustum, const RenderQueueRegistry& registry) const
+	{
+		UInt64 layerIndex = registry.FetchLayerIndex(m_renderLayer);
+		UInt64 elementType = GetElementType();
+
+		// Impostors are alpha-tested (not blended), they're drawn front to back with opaque elements
+		UInt64 matFlags = 0;
+
+		float distanceNear = frustum.GetPlane(FrustumPlane::Near).SignedDistance(m_worldInstance.GetWorldMatrix().GetTranslation());
+		UInt64 distance = UInt32(~DistanceAsSortKey(distanceNear)); //< front to back, to reject hidden impostor fragments early
+
+		// Opaque RQ index:
+		// - Layer (8bits)
+		// - Sorted by distance flag (1bit)
+		// - Element type (4bits)
+		// - Distance to near plane (32bits)
+		// - ?? (19bits)
+
+		return (layerIndex & 0xFF) << 56 |
+		       (matFlags)          << 55 |
+		       (elementType & 0xF) << 51 |
+		       (distance)          << 19;
+	}
+
+	inline const ImpostorAtlas& RenderImpostor::GetImpostor() const
+	{
+		return m_impostor;
+	}
+
+	inline const WorldInstance& RenderImpostor::GetWorldInstance() const
+	{
+		return m_worldInstance;
+	}
+
+	inline void RenderImpostor::Register(RenderQueueRegistry& registry) const
+	{
+		registry.RegisterLayer(m_renderLayer);
+	}
+}
+
+#include <Nazara/Graphics/DebugOff.hpp>
@@ -0,0 +1,43 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_GRAPHICS_RENDERPARTICLES_HPP
+#define NAZARA_GRAPHICS_RENDERPARTICLES_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Graphics/RenderElement.hpp>
+#include <Nazara/Graphics/RenderQueueRegistry.hpp>
+#include <Nazara/Graphics/WorldInstance.hpp>
+
+namespace Nz
+{
+	class ParticleEmitter;
+
+	class RenderParticles : public RenderElement
+	{
+		public:
+			inline RenderParticles(int renderLayer, const ParticleEmitter& emitter, const WorldInstance& worldInstance);
+			~RenderParticles() = default;
+
+			inline UInt64 ComputeSortingScore(const Frustumf& frustum, const RenderQueueRegistry& registry) const override;
+
+			inline const ParticleEmitter& GetEmitter() const;
+			inline const WorldInstance& GetWorldInstance() const;
+
+			inline void Register(RenderQueueRegistry& registry) const override;
+
+			static constexpr BasicRenderElement ElementType = BasicRenderElement::Particles;
+
+		private:
+			const ParticleEmitter& m_emitter;
+			const WorldInstance& m_worldInstance;
+			int m_renderLayer;
+	};
+}
+
+#include <Nazara/Graphics/RenderParticles.inl>
+
+#endif // NAZARA_GRAPHICS_RENDERPARTICLES_HPP
@@ -0,0 +1,55 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/Algorithm.hpp>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	inline RenderParticles::RenderParticles(int renderLayer, const ParticleEmitter& emitter, const WorldInstance& worldInstance) :
+	RenderElement(BasicRenderElement::Particles),
+	m_emitter(emitter),
+	m_worldInstance(worldInstance),
+	m_renderLayer(renderLayer)
+	{
+	}
+
+	inline UInt64 RenderParticles::ComputeSortingScore(const Frustumf& frustum, const RenderQueueRegistry& registry) const
+	{
+		UInt64 layerIndex = registry.FetchLayerIndex(m_renderLayer);
+
+		// Particles are blended with what's behind them, they are always drawn with transparent elements
+		UInt64 matFlags = 1;
+
+		float distanceNear = frustum.GetPlane(FrustumPlane::Near).SignedDistance(m_worldInstance.GetWorldMatrix().GetTranslation());
+		UInt64 distance = DistanceAsSortKey(distanceNear);
+
+		// Transparent RQ index:
+		// - Layer (8bits)
+		// - Sorted by distance flag (1bit)
+		// - Distance to near plane (32bits)
+		// - ?? (23bits)
+
+		return (layerIndex & 0xFF) << 56 |
+		       (matFlags)          << 55 |
+		       (distance)          << 23;
+	}
+
+	inline const ParticleEmitter& RenderParticles::GetEmitter() const
+	{
+		return m_emitter;
+	}
+
+	inline const WorldInstance& RenderParticles::GetWorldInstance() const
+	{
+		return m_worldInstance;
+	}
+
+	inline void RenderParticles::Register(RenderQueueRegistry& registry) const
+	{
+		registry.RegisterLayer(m_renderLayer);
+	}
+}
+
+#include <Nazara/Graphics/DebugOff.hpp>
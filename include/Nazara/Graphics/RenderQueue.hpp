@@ -28,6 +28,8 @@ namespace Nz
 
 			void Insert(RenderData&& data);
 
+			template<typename F> void RemoveIf(F&& predicate);
+
 			template<typename IndexFunc> void Sort(IndexFunc&& func);
 
 			// STL API
@@ -40,7 +42,22 @@ namespace Nz
 			RenderQueue& operator=(RenderQueue&&) noexcept = default;
 
 		private:
+			bool InsertionSort(std::size_t maxMoveCount);
+			void RadixSort();
+
+			struct SortEntry
+			{
+				UInt64 key;
+				std::size_t index;
+			};
+
+			static constexpr std::size_t NearlySortedMoveFactor = 4;
+			static constexpr std::size_t NearlySortedThreshold = 16;
+
 			std::vector<RenderData> m_data;
+			std::vector<RenderData> m_sortedData;
+			std::vector<SortEntry> m_sortEntries;
+			std::vector<SortEntry> m_sortScratch;
 	};
 }
 
@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <algorithm>
+#include <array>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
@@ -19,14 +20,119 @@ namespace Nz
 		m_data.emplace_back(std::move(data));
 	}
 
+	template<typename RenderData>
+	template<typename F>
+	void RenderQueue<RenderData>::RemoveIf(F&& predicate)
+	{
+		// Keep the relative order of remaining elements
+		m_data.erase(std::remove_if(m_data.begin(), m_data.end(), predicate), m_data.end());
+	}
+
+	/*!
+	* \brief Sorts the queue by ascending keys
+	*
+	* \param func Function returning the 64-bits sort key of an element, called once per element
+	*
+	* \remark Sort is stable, elements with the same key keep their relative order
+	* \remark Queues which are (nearly) sorted already, as it's often the case from one frame to another, are handled in linear time
+	*/
 	template<typename RenderData>
 	template<typename IndexFunc>
 	void RenderQueue<RenderData>::Sort(IndexFunc&& func)
 	{
-		std::sort(m_data.begin(), m_data.end(), [&](const RenderData& lhs, const RenderData& rhs)
+		std::size_t count = m_data.size();
+		if (count < 2)
+			return;
+
+		m_sortEntries.resize(count);
+		for (std::size_t i = 0; i < count; ++i)
+			m_sortEntries[i] = { static_cast<UInt64>(func(m_data[i])), i };
+
+		std::size_t descentCount = 0;
+		for (std::size_t i = 1; i < count; ++i)
 		{
-			return func(lhs) < func(rhs);
-		});
+			if (m_sortEntries[i].key < m_sortEntries[i - 1].key)
+				descentCount++;
+		}
+
+		if (descentCount == 0)
+			return;
+
+		if (descentCount > NearlySortedThreshold || !InsertionSort(count * NearlySortedMoveFactor))
+			RadixSort();
+
+		m_sortedData.clear();
+		m_sortedData.reserve(count);
+		for (const SortEntry& entry : m_sortEntries)
+			m_sortedData.push_back(std::move(m_data[entry.index]));
+
+		std::swap(m_data, m_sortedData);
+	}
+
+	template<typename RenderData>
+	bool RenderQueue<RenderData>::InsertionSort(std::size_t maxMoveCount)
+	{
+		// Few descents don't mean few elements out of place (an appended sorted batch or interleaved runs are a single descent apart),
+		// give up once insertion sort moved more elements than a radix sort would
+		std::size_t count = m_sortEntries.size();
+		std::size_t moveCount = 0;
+		for (std::size_t i = 1; i < count; ++i)
+		{
+			SortEntry entry = m_sortEntries[i];
+
+			std::size_t j = i;
+			for (; j > 0 && m_sortEntries[j - 1].key > entry.key; --j)
+				m_sortEntries[j] = m_sortEntries[j - 1];
+
+			m_sortEntries[j] = entry;
+
+			moveCount += i - j;
+			if (moveCount > maxMoveCount)
+				return false; //< entries are still a permutation and equal keys kept their order, radix sort can take over
+		}
+
+		return true;
+	}
+
+	template<typename RenderData>
+	void RenderQueue<RenderData>::RadixSort()
+	{
+		// LSD radix sort on 8 bits digits, histograms of every digit are built in a single pass
+		constexpr std::size_t DigitCount = sizeof(UInt64);
+		constexpr std::size_t BucketCount = 256;
+
+		std::size_t count = m_sortEntries.size();
+
+		std::array<std::array<std::size_t, BucketCount>, DigitCount> histograms = {};
+		for (const SortEntry& entry : m_sortEntries)
+		{
+			for (std::size_t digit = 0; digit < DigitCount; ++digit)
+				histograms[digit][(entry.key >> (digit * 8)) & 0xFF]++;
+		}
+
+		m_sortScratch.resize(count);
+
+		for (std::size_t digit = 0; digit < DigitCount; ++digit)
+		{
+			auto& histogram = histograms[digit];
+
+			// Skip digits which are the same for every key (common for layer and flags bits)
+			if (histogram[(m_sortEntries[0].key >> (digit * 8)) & 0xFF] == count)
+				continue;
+
+			std::size_t offset = 0;
+			for (std::size_t& bucket : histogram)
+			{
+				std::size_t bucketSize = bucket;
+				bucket = offset;
+				offset += bucketSize;
+			}
+
+			for (const SortEntry& entry : m_sortEntries)
+				m_sortScratch[histogram[(entry.key >> (digit * 8)) & 0xFF]++] = entry;
+
+			std::swap(m_sortEntries, m_sortScratch);
+		}
 	}
 
 	template<typename RenderData>
@@ -12,12 +12,14 @@
 #include <Nazara/Graphics/RenderQueueRegistry.hpp>
 #include <Nazara/Graphics/SkeletonInstance.hpp>
 #include <Nazara/Graphics/WorldInstance.hpp>
+#include <Nazara/Math/Box.hpp>
 #include <Nazara/Utility/Enums.hpp>
 #include <memory>
 #include <vector>
 
 namespace Nz
 {
+	class AnimationTexture;
 	class MaterialInstance;
 	class RenderPipeline;
 	class ShaderBinding;
@@ -25,19 +27,24 @@ namespace Nz
 	class RenderSubmesh : public RenderElement
 	{
 		public:
-			inline RenderSubmesh(int renderLayer, std::shared_ptr<MaterialInstance> materialInstance, MaterialPassFlags materialFlags, std::shared_ptr<RenderPipeline> renderPipeline, const WorldInstance& worldInstance, const SkeletonInstance* skeletonInstance, std::size_t indexCount, IndexType indexType, std::shared_ptr<RenderBuffer> indexBuffer, std::shared_ptr<RenderBuffer> vertexBuffer, const Recti& scissorBox);
+			inline RenderSubmesh(int renderLayer, std::shared_ptr<MaterialInstance> materialInstance, MaterialPassFlags materialFlags, std::shared_ptr<RenderPipeline> renderPipeline, std::shared_ptr<RenderPipeline> instancedRenderPipeline, const WorldInstance& worldInstance, const Boxf& aabb, const SkeletonInstance* skeletonInstance, const AnimationTexture* animationTexture, std::size_t firstIndex, std::size_t indexCount, IndexType indexType, std::shared_ptr<RenderBuffer> indexBuffer, std::shared_ptr<RenderBuffer> vertexBuffer, UInt64 vertexBufferOffset, const Recti& scissorBox);
 			~RenderSubmesh() = default;
 
 			inline UInt64 ComputeSortingScore(const Frustumf& frustum, const RenderQueueRegistry& registry) const override;
 
+			inline const Boxf& GetAABB() const;
+			inline const AnimationTexture* GetAnimationTexture() const;
+			inline std::size_t GetFirstIndex() const;
 			inline const RenderBuffer* GetIndexBuffer() const;
 			inline std::size_t GetIndexCount() const;
 			inline IndexType GetIndexType() const;
+			inline const RenderPipeline* GetInstancedRenderPipeline() const;
 			inline const MaterialInstance& GetMaterialInstance() const;
 			inline const RenderPipeline* GetRenderPipeline() const;
 			inline const Recti& GetScissorBox() const;
 			inline const SkeletonInstance* GetSkeletonInstance() const;
 			inline const RenderBuffer* GetVertexBuffer() const;
+			inline UInt64 GetVertexBufferOffset() const;
 			inline const WorldInstance& GetWorldInstance() const;
 
 			inline void Register(RenderQueueRegistry& registry) const override;
@@ -48,12 +55,17 @@ namespace Nz
 			std::shared_ptr<RenderBuffer> m_indexBuffer;
 			std::shared_ptr<RenderBuffer> m_vertexBuffer;
 			std::shared_ptr<MaterialInstance> m_materialInstance;
+			std::shared_ptr<RenderPipeline> m_instancedRenderPipeline;
 			std::shared_ptr<RenderPipeline> m_renderPipeline;
+			std::size_t m_firstIndex;
 			std::size_t m_indexCount;
+			const AnimationTexture* m_animationTexture;
 			const SkeletonInstance* m_skeletonInstance;
 			const WorldInstance& m_worldInstance;
 			IndexType m_indexType;
+			Boxf m_aabb;
 			MaterialPassFlags m_materialFlags;
+			UInt64 m_vertexBufferOffset;
 			Recti m_scissorBox;
 			int m_renderLayer;
 	};
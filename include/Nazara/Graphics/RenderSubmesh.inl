@@ -8,17 +8,22 @@
 
 namespace Nz
 {
-	inline RenderSubmesh::RenderSubmesh(int renderLayer, std::shared_ptr<MaterialInstance> materialInstance, MaterialPassFlags materialFlags, std::shared_ptr<RenderPipeline> renderPipeline, const WorldInstance& worldInstance, const SkeletonInstance* skeletonInstance, std::size_t indexCount, IndexType indexType, std::shared_ptr<RenderBuffer> indexBuffer, std::shared_ptr<RenderBuffer> vertexBuffer, const Recti& scissorBox) :
+	inline RenderSubmesh::RenderSubmesh(int renderLayer, std::shared_ptr<MaterialInstance> materialInstance, MaterialPassFlags materialFlags, std::shared_ptr<RenderPipeline> renderPipeline, std::shared_ptr<RenderPipeline> instancedRenderPipeline, const WorldInstance& worldInstance, const Boxf& aabb, const SkeletonInstance* skeletonInstance, const AnimationTexture* animationTexture, std::size_t firstIndex, std::size_t indexCount, IndexType indexType, std::shared_ptr<RenderBuffer> indexBuffer, std::shared_ptr<RenderBuffer> vertexBuffer, UInt64 vertexBufferOffset, const Recti& scissorBox) :
 	RenderElement(BasicRenderElement::Submesh),
 	m_indexBuffer(std::move(indexBuffer)),
 	m_vertexBuffer(std::move(vertexBuffer)),
 	m_materialInstance(std::move(materialInstance)),
+	m_instancedRenderPipeline(std::move(instancedRenderPipeline)),
 	m_renderPipeline(std::move(renderPipeline)),
+	m_firstIndex(firstIndex),
 	m_indexCount(indexCount),
+	m_animationTexture(animationTexture),
 	m_skeletonInstance(skeletonInstance),
 	m_worldInstance(worldInstance),
 	m_indexType(indexType),
+	m_aabb(aabb),
 	m_materialFlags(materialFlags),
+	m_vertexBufferOffset(vertexBufferOffset),
 	m_scissorBox(scissorBox),
 	m_renderLayer(renderLayer)
 	{
@@ -78,6 +83,27 @@ namespace Nz
 		}
 	}
 
+	/*!
+	* \brief Returns the local-space bounding box of the submesh (used by GPU culling)
+	*/
+	inline const Boxf& RenderSubmesh::GetAABB() const
+	{
+		return m_aabb;
+	}
+
+	inline const AnimationTexture* RenderSubmesh::GetAnimationTexture() const
+	{
+		return m_animationTexture;
+	}
+
+	/*!
+	* \brief Returns the first index to draw from the index buffer (or the first vertex for non-indexed submeshes)
+	*/
+	inline std::size_t RenderSubmesh::GetFirstIndex() const
+	{
+		return m_firstIndex;
+	}
+
 	inline const RenderBuffer* RenderSubmesh::GetIndexBuffer() const
 	{
 		return m_indexBuffer.get();
@@ -93,6 +119,15 @@ namespace Nz
 		return m_indexType;
 	}
 
+	/*!
+	* \brief Returns the pipeline to use when this submesh is drawn along other identical submeshes in a single instanced draw call
+	* \return Instanced render pipeline, or a null pointer if this submesh can't be instanced
+	*/
+	inline const RenderPipeline* RenderSubmesh::GetInstancedRenderPipeline() const
+	{
+		return m_instancedRenderPipeline.get();
+	}
+
 	inline const MaterialInstance& RenderSubmesh::GetMaterialInstance() const
 	{
 		return *m_materialInstance;
@@ -118,6 +153,14 @@ namespace Nz
 		return m_vertexBuffer.get();
 	}
 
+	/*!
+	* \brief Returns the offset at which the vertex buffer must be bound, non-zero when the vertex buffer is shared (see MeshArena)
+	*/
+	inline UInt64 RenderSubmesh::GetVertexBufferOffset() const
+	{
+		return m_vertexBufferOffset;
+	}
+
 	inline const WorldInstance& RenderSubmesh::GetWorldInstance() const
 	{
 		return m_worldInstance;
@@ -0,0 +1,43 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_GRAPHICS_RENDERTERRAIN_HPP
+#define NAZARA_GRAPHICS_RENDERTERRAIN_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Graphics/RenderElement.hpp>
+#include <Nazara/Graphics/RenderQueueRegistry.hpp>
+#include <Nazara/Graphics/WorldInstance.hpp>
+
+namespace Nz
+{
+	class ClipmapTerrain;
+
+	class RenderTerrain : public RenderElement
+	{
+		public:
+			inline RenderTerrain(int renderLayer, const ClipmapTerrain& terrain, const WorldInstance& worldInstance);
+			~RenderTerrain() = default;
+
+			inline UInt64 ComputeSortingScore(const Frustumf& frustum, const RenderQueueRegistry& registry) const override;
+
+			inline const ClipmapTerrain& GetTerrain() const;
+			inline const WorldInstance& GetWorldInstance() const;
+
+			inline void Register(RenderQueueRegistry& registry) const override;
+
+			static constexpr BasicRenderElement ElementType = BasicRenderElement::Terrain;
+
+		private:
+			const ClipmapTerrain& m_terrain;
+			const WorldInstance& m_worldInstance;
+			int m_renderLayer;
+	};
+}
+
+#include <Nazara/Graphics/RenderTerrain.inl>
+
+#endif // NAZARA_GRAPHICS_RENDERTERRAIN_HPP
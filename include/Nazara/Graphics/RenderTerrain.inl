@@ -0,0 +1,55 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	inline RenderTerrain::RenderTerrain(int renderLayer, const ClipmapTerrain& terrain, const WorldInstance& worldInstance) :
+	RenderElement(BasicRenderElement::Terrain),
+	m_terrain(terrain),
+	m_worldInstance(worldInstance),
+	m_renderLayer(renderLayer)
+	{
+	}
+
+	inline UInt64 RenderTerrain::ComputeSortingScore(const Frustumf& /*frustum*/, const RenderQueueRegistry& registry) const
+	{
+		UInt64 layerIndex = registry.FetchLayerIndex(m_renderLayer);
+		UInt64 elementType = GetElementType();
+
+		// Terrains surround the viewer, they're drawn after other opaque elements to have most of their fragments rejected by the depth test
+		UInt64 matFlags = 0;
+		UInt64 distance = 0xFFFFFFFF;
+
+		// Opaque RQ index:
+		// - Layer (8bits)
+		// - Sorted by distance flag (1bit)
+		// - Element type (4bits)
+		// - Distance to near plane (32bits)
+		// - ?? (19bits)
+
+		return (layerIndex & 0xFF) << 56 |
+		       (matFlags)          << 55 |
+		       (elementType & 0xF) << 51 |
+		       (distance)          << 19;
+	}
+
+	inline const ClipmapTerrain& RenderTerrain::GetTerrain() const
+	{
+		return m_terrain;
+	}
+
+	inline const WorldInstance& RenderTerrain::GetWorldInstance() const
+	{
+		return m_worldInstance;
+	}
+
+	inline void RenderTerrain::Register(RenderQueueRegistry& registry) const
+	{
+		registry.RegisterLayer(m_renderLayer);
+	}
+}
+
+#include <Nazara/Graphics/DebugOff.hpp>
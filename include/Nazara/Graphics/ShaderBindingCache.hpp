@@ -0,0 +1,84 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_GRAPHICS_SHADERBINDINGCACHE_HPP
+#define NAZARA_GRAPHICS_SHADERBINDINGCACHE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Graphics/Config.hpp>
+#include <Nazara/Renderer/ShaderBinding.hpp>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Nz
+{
+	class RenderFrame;
+	class RenderPipelineLayout;
+
+	/*!
+	* \brief Shares shader bindings with identical contents
+	*
+	* Bindings are identified by their layout, set index and the resources they reference (by resource id, as addresses may be reused).
+	* Bindings no longer referenced are kept for a few frames to be reused by the next element rebuilds, before being released.
+	*/
+	class NAZARA_GRAPHICS_API ShaderBindingCache
+	{
+		public:
+			inline ShaderBindingCache(UInt64 expirationFrameCount = 3);
+			ShaderBindingCache(const ShaderBindingCache&) = delete;
+			ShaderBindingCache(ShaderBindingCache&&) = delete;
+			~ShaderBindingCache() = default;
+
+			const ShaderBinding* Acquire(const std::shared_ptr<RenderPipelineLayout>& pipelineLayout, UInt32 setIndex, const ShaderBinding::Binding* bindings, std::size_t bindingCount);
+
+			inline std::size_t GetEntryCount() const;
+
+			void Release(const ShaderBinding* shaderBinding);
+
+			void Update(RenderFrame& renderFrame);
+
+			ShaderBindingCache& operator=(const ShaderBindingCache&) = delete;
+			ShaderBindingCache& operator=(ShaderBindingCache&&) = delete;
+
+		private:
+			struct Key
+			{
+				const RenderPipelineLayout* pipelineLayout;
+				UInt32 setIndex;
+				std::vector<UInt64> signature;
+
+				inline bool operator==(const Key& rhs) const;
+			};
+
+			struct KeyHasher
+			{
+				inline std::size_t operator()(const Key& key) const;
+			};
+
+			struct Entry
+			{
+				std::shared_ptr<RenderPipelineLayout> pipelineLayout; //< must outlive the shader binding
+				ShaderBindingPtr shaderBinding;
+				std::size_t referenceCount = 0;
+				UInt64 lastReleaseFrame = 0;
+			};
+
+			using EntryMap = std::unordered_map<Key, Entry, KeyHasher>;
+
+			void BuildSignature(const ShaderBinding::Binding* bindings, std::size_t bindingCount);
+
+			std::unordered_map<const ShaderBinding*, EntryMap::value_type*> m_entryByBinding;
+			EntryMap m_entries;
+			Key m_lookupKey;
+			UInt64 m_expirationFrameCount;
+			UInt64 m_frameIndex;
+	};
+}
+
+#include <Nazara/Graphics/ShaderBindingCache.inl>
+
+#endif // NAZARA_GRAPHICS_SHADERBINDINGCACHE_HPP
@@ -0,0 +1,43 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <NazaraUtils/Hash.hpp>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Constructs the cache
+	*
+	* \param expirationFrameCount Number of frames a binding is kept once it's no longer referenced
+	*/
+	inline ShaderBindingCache::ShaderBindingCache(UInt64 expirationFrameCount) :
+	m_expirationFrameCount(expirationFrameCount),
+	m_frameIndex(0)
+	{
+	}
+
+	inline std::size_t ShaderBindingCache::GetEntryCount() const
+	{
+		return m_entries.size();
+	}
+
+	inline bool ShaderBindingCache::Key::operator==(const Key& rhs) const
+	{
+		return pipelineLayout == rhs.pipelineLayout && setIndex == rhs.setIndex && signature == rhs.signature;
+	}
+
+	inline std::size_t ShaderBindingCache::KeyHasher::operator()(const Key& key) const
+	{
+		std::size_t seed = 0;
+		HashCombine(seed, key.pipelineLayout);
+		HashCombine(seed, key.setIndex);
+		for (UInt64 value : key.signature)
+			HashCombine(seed, value);
+
+		return seed;
+	}
+}
+
+#include <Nazara/Graphics/DebugOff.hpp>
@@ -0,0 +1,72 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_GRAPHICS_SHADERVARIANTARCHIVE_HPP
+#define NAZARA_GRAPHICS_SHADERVARIANTARCHIVE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Graphics/Config.hpp>
+#include <Nazara/Graphics/UberShader.hpp>
+#include <Nazara/Renderer/Enums.hpp>
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_GRAPHICS_API ShaderVariantArchive
+	{
+		public:
+			struct Variant;
+
+			inline ShaderVariantArchive();
+			ShaderVariantArchive(const ShaderVariantArchive&) = delete;
+			ShaderVariantArchive(ShaderVariantArchive&&) = delete;
+			~ShaderVariantArchive() = default;
+
+			void AddVariant(UInt64 variantHash, std::shared_ptr<const Variant> variant);
+
+			void Clear();
+
+			inline void EnableRecording(bool enable = true);
+
+			std::shared_ptr<const Variant> FindVariant(UInt64 variantHash, UInt64 moduleHash, ShaderLanguage language) const;
+
+			std::size_t GetVariantCount() const;
+
+			inline bool IsRecording() const;
+
+			bool LoadFromFile(const std::filesystem::path& filePath);
+
+			bool SaveToFile(const std::filesystem::path& filePath) const;
+
+			ShaderVariantArchive& operator=(const ShaderVariantArchive&) = delete;
+			ShaderVariantArchive& operator=(ShaderVariantArchive&&) = delete;
+
+			static UInt64 ComputeModuleHash(const nzsl::Ast::Module& module);
+			static UInt64 ComputeVariantHash(std::string_view moduleName, UInt64 moduleHash, const UberShader::Config& config);
+
+			struct Variant
+			{
+				ShaderLanguage language;
+				UInt64 moduleHash;
+				std::vector<UInt8> data;
+			};
+
+		private:
+			mutable std::mutex m_mutex;
+			std::unordered_map<UInt64, std::shared_ptr<const Variant>> m_variants;
+			std::atomic_bool m_isRecording;
+	};
+}
+
+#include <Nazara/Graphics/ShaderVariantArchive.inl>
+
+#endif // NAZARA_GRAPHICS_SHADERVARIANTARCHIVE_HPP
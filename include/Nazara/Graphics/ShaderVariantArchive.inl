@@ -0,0 +1,32 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	inline ShaderVariantArchive::ShaderVariantArchive() :
+	m_isRecording(false)
+	{
+	}
+
+	/*!
+	* \brief Enables or disables recording of shader variants
+	*
+	* When recording, UberShader compiles missing variants to the archive so they can be saved with SaveToFile and loaded on the next run
+	*
+	* \param enable Should variants be recorded
+	*/
+	inline void ShaderVariantArchive::EnableRecording(bool enable)
+	{
+		m_isRecording = enable;
+	}
+
+	inline bool ShaderVariantArchive::IsRecording() const
+	{
+		return m_isRecording;
+	}
+}
+
+#include <Nazara/Graphics/DebugOff.hpp>
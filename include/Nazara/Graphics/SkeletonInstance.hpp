@@ -14,10 +14,12 @@
 #include <Nazara/Renderer/ShaderBinding.hpp>
 #include <Nazara/Utility/Skeleton.hpp>
 #include <memory>
+#include <vector>
 
 namespace Nz
 {
 	class CommandBufferBuilder;
+	class GraphicalMesh;
 	class RenderBuffer;
 	class SkeletonInstance;
 	class UploadPool;
@@ -32,21 +34,50 @@ namespace Nz
 			SkeletonInstance(SkeletonInstance&& skeletonInstance) noexcept;
 			~SkeletonInstance() = default;
 
+			void DispatchSkinning(CommandBufferBuilder& builder);
+
+			void EnableComputeSkinning(std::shared_ptr<GraphicalMesh> graphicalMesh);
+
 			inline std::shared_ptr<RenderBuffer>& GetSkeletalBuffer();
 			inline const std::shared_ptr<RenderBuffer>& GetSkeletalBuffer() const;
 			inline const std::shared_ptr<const Skeleton>& GetSkeleton() const;
+			const std::shared_ptr<RenderBuffer>& GetSkinnedVertexBuffer(const GraphicalMesh& graphicalMesh, std::size_t subMeshIndex) const;
+
+			inline bool HasPendingSkinning() const;
 
 			void OnTransfer(RenderFrame& renderFrame, CommandBufferBuilder& builder) override;
 
+			void UpdateSkinningMatrices(const Matrix4f* skinningMatrices, std::size_t matrixCount);
+
 			SkeletonInstance& operator=(const SkeletonInstance&) = delete;
 			SkeletonInstance& operator=(SkeletonInstance&& skeletonInstance) noexcept;
 
 		private:
+			inline void InvalidateData(std::size_t firstJoint, std::size_t jointCount);
+
 			NazaraSlot(Skeleton, OnSkeletonJointsInvalidated, m_onSkeletonJointsInvalidated);
 
+			struct SkinnedSubMesh
+			{
+				std::shared_ptr<RenderBuffer> vertexBuffer;
+				ShaderBindingPtr shaderBinding;
+				UInt32 vertexCount;
+			};
+
+			struct SkinnedMesh
+			{
+				std::shared_ptr<GraphicalMesh> graphicalMesh;
+				std::vector<SkinnedSubMesh> subMeshes;
+			};
+
 			std::shared_ptr<RenderBuffer> m_skeletalDataBuffer;
 			std::shared_ptr<const Skeleton> m_skeleton;
+			std::vector<Matrix4f> m_skinningMatrices;
+			std::vector<SkinnedMesh> m_skinnedMeshes;
+			std::size_t m_invalidatedJointBegin;
+			std::size_t m_invalidatedJointEnd;
 			bool m_dataInvalided;
+			bool m_skinningPending;
 	};
 }
 
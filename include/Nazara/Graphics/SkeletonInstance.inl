@@ -2,6 +2,7 @@
 // This file is part of the "Nazara Engine - Graphics module"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
+#include <algorithm>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
@@ -20,6 +21,24 @@ namespace Nz
 	{
 		return m_skeleton;
 	}
+
+	inline bool SkeletonInstance::HasPendingSkinning() const
+	{
+		return m_skinningPending;
+	}
+
+	inline void SkeletonInstance::InvalidateData(std::size_t firstJoint, std::size_t jointCount)
+	{
+		m_invalidatedJointBegin = std::min(m_invalidatedJointBegin, firstJoint);
+		m_invalidatedJointEnd = std::max(m_invalidatedJointEnd, firstJoint + jointCount);
+
+		// Listeners were already notified since the last transfer
+		if (m_dataInvalided)
+			return;
+
+		m_dataInvalided = true;
+		OnTransferRequired(this);
+	}
 }
 
 #include <Nazara/Graphics/DebugOff.hpp>
@@ -24,7 +24,7 @@ namespace Nz
 			SpotLight(SpotLight&&) noexcept = default;
 			~SpotLight() = default;
 
-			float ComputeContributionScore(const BoundingVolumef& boundingVolume) const override;
+			float ComputeContributionScore(const Boxf& worldAABB) const override;
 
 			void FillLightData(void* data) const override;
 
@@ -12,6 +12,8 @@
 #include <Nazara/Graphics/Light.hpp>
 #include <Nazara/Graphics/LightShadowData.hpp>
 #include <Nazara/Graphics/ShadowViewer.hpp>
+#include <Nazara/Math/Matrix4.hpp>
+#include <vector>
 
 namespace Nz
 {
@@ -26,13 +28,13 @@ namespace Nz
 			SpotLightShadowData(SpotLightShadowData&&) = delete;
 			~SpotLightShadowData() = default;
 
-			void PrepareRendering(RenderFrame& renderFrame) override;
+			void PrepareRendering(RenderFrame& renderFrame, const AbstractViewer* viewer) override;
 
 			void RegisterMaterialInstance(const MaterialInstance& matInstance) override;
-			void RegisterPassInputs(FramePass& pass) override;
-			void RegisterToFrameGraph(FrameGraph& frameGraph) override;
+			void RegisterPassInputs(FramePass& pass, const AbstractViewer* viewer) override;
+			void RegisterToFrameGraph(FrameGraph& frameGraph, const AbstractViewer* viewer) override;
 
-			const Texture* RetrieveLightShadowmap(const BakedFrameGraph& bakedGraph) const override;
+			const Texture* RetrieveLightShadowmap(const BakedFrameGraph& bakedGraph, const AbstractViewer* viewer) const override;
 
 			void UnregisterMaterialInstance(const MaterialInstance& matInstance) override;
 
@@ -45,9 +47,13 @@ namespace Nz
 
 			std::optional<DepthPipelinePass> m_depthPass;
 			std::size_t m_attachmentIndex;
+			std::size_t m_visibilityHash;
+			std::vector<FramePipelinePass::VisibleRenderable> m_visibleRenderables;
 			FramePipeline& m_pipeline;
+			Matrix4f m_cullingViewProjMatrix;
 			const SpotLight& m_light;
 			ShadowViewer m_viewer;
+			bool m_isCullingValid;
 	};
 }
 
@@ -13,6 +13,7 @@
 #include <Nazara/Math/Rect.hpp>
 #include <Nazara/Renderer/ShaderBinding.hpp>
 #include <Nazara/Renderer/UploadPool.hpp>
+#include <Nazara/Utility/Enums.hpp>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -21,13 +22,17 @@ namespace Nz
 {
 	class RenderDevice;
 	class RenderPipeline;
+	class RenderPipelineLayout;
 	class ShaderBinding;
+	class ShaderBindingCache;
 	class Texture;
 	class VertexDeclaration;
 	class WorldInstance;
 	
-	struct SpriteChainRendererData : public ElementRendererData
+	struct NAZARA_GRAPHICS_API SpriteChainRendererData : public ElementRendererData
 	{
+		~SpriteChainRendererData();
+
 		struct DrawCall
 		{
 			const RenderBuffer* vertexBuffer;
@@ -36,6 +41,7 @@ namespace Nz
 			std::size_t firstIndex;
 			std::size_t quadCount;
 			Recti scissorBox;
+			bool bindlessTextures; //< material samples its textures from the bindless texture table
 		};
 
 		struct DrawCallIndices
@@ -44,18 +50,30 @@ namespace Nz
 			std::size_t count;
 		};
 
+		// Vertex buffers are kept between rebuilds, only bytes differing from what the GPU already has are uploaded
+		struct VertexBuffer
+		{
+			std::shared_ptr<RenderBuffer> buffer;
+			std::size_t uploadedSize = 0; //< bytes of content matching the buffer memory
+			std::vector<UInt8> content;
+		};
+
+		std::size_t usedVertexBufferCount = 0;
 		std::unordered_map<const RenderSpriteChain*, DrawCallIndices> drawCallPerElement;
 		std::vector<DrawCall> drawCalls;
-		std::vector<std::shared_ptr<RenderBuffer>> vertexBuffers;
-		std::vector<ShaderBindingPtr> shaderBindings;
+		std::vector<VertexBuffer> vertexBuffers;
+		std::vector<const ShaderBinding*> shaderBindings; //< acquired from shaderBindingCache
+		std::shared_ptr<ShaderBindingCache> shaderBindingCache;
 	};
 
 	class NAZARA_GRAPHICS_API SpriteChainRenderer final : public ElementRenderer
 	{
 		public:
-			SpriteChainRenderer(RenderDevice& device, std::size_t maxVertexBufferSize = 32 * 1024);
+			SpriteChainRenderer(RenderDevice& device, std::size_t maxVertexBufferSize = 256 * 1024);
 			~SpriteChainRenderer() = default;
 
+			void EndFrame(RenderFrame& currentFrame) override;
+
 			RenderElementPool<RenderSpriteChain>& GetPool() override;
 
 			std::unique_ptr<ElementRendererData> InstanciateData() override;
@@ -68,43 +86,47 @@ namespace Nz
 			void Flush();
 			void FlushDrawCall();
 			void FlushDrawData();
+			void InvalidateShaderBinding();
 
 			struct BufferCopy
 			{
 				RenderBuffer* targetBuffer;
-				UploadPool::Allocation* allocation;
+				const UInt8* data;
+				std::size_t offset;
 				std::size_t size;
 			};
 
 			struct PendingData
 			{
 				std::size_t firstQuadIndex = 0;
+				std::size_t currentVertexBufferOffset = 0;
+				std::size_t invalidatedBegin = 0;
+				std::size_t invalidatedEnd = 0;
 				SpriteChainRendererData::DrawCall* currentDrawCall = nullptr;
-				UploadPool::Allocation* currentAllocation = nullptr;
-				UInt8* currentAllocationMemPtr = nullptr;
+				SpriteChainRendererData::VertexBuffer* currentVertexBuffer = nullptr;
 				const VertexDeclaration* currentVertexDeclaration = nullptr;
-				RenderBuffer* currentVertexBuffer = nullptr;
 				const MaterialInstance* currentMaterialInstance = nullptr;
 				const RenderPipeline* currentPipeline = nullptr;
 				const ShaderBinding* currentShaderBinding = nullptr;
+				const ShaderBinding* lastShaderBinding = nullptr;
+				const RenderPipelineLayout* lastPipelineLayout = nullptr;
 				const Texture* currentTextureOverlay = nullptr;
 				const WorldInstance* currentWorldInstance = nullptr;
+				RenderBufferView currentLightArray;
+				RenderBufferView currentLightClusters;
 				RenderBufferView currentLightData;
 				Recti currentScissorBox = Recti(-1, -1, -1, -1);
 			};
 
-			struct VertexBufferPool
-			{
-				std::vector<std::shared_ptr<RenderBuffer>> vertexBuffers;
-			};
-
 			std::shared_ptr<RenderBuffer> m_indexBuffer;
-			std::shared_ptr<VertexBufferPool> m_vertexBufferPool;
+			std::shared_ptr<ShaderBindingCache> m_shaderBindingCache;
 			std::size_t m_maxVertexBufferSize;
 			std::size_t m_maxVertexCount;
 			std::vector<BufferCopy> m_pendingCopies;
 			std::vector<ShaderBinding::Binding> m_bindingCache;
+			std::vector<ShaderBinding::Binding> m_lastBindingCache;
 			RenderElementPool<RenderSpriteChain> m_spriteChainPool;
+			IndexType m_indexType;
 			PendingData m_pendingData;
 			RenderDevice& m_device;
 	};
@@ -0,0 +1,78 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_GRAPHICS_STATICBATCHER_HPP
+#define NAZARA_GRAPHICS_STATICBATCHER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Graphics/Config.hpp>
+#include <Nazara/Math/Box.hpp>
+#include <Nazara/Math/Matrix4.hpp>
+#include <Nazara/Math/Vector3.hpp>
+#include <Nazara/Utility/Enums.hpp>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Nz
+{
+	class MaterialInstance;
+	class Mesh;
+	class Model;
+	class VertexDeclaration;
+
+	/*!
+	* \brief Merges static meshes sharing the same materials into a few spatially clustered models
+	*
+	* Meshes are pre-transformed and assigned to the cell of a regular grid containing their center, each cell becoming a single model
+	* having one submesh per material. Built models are expressed in world space and are meant to be rendered with an identity world instance,
+	* their AABB being the bounds of their cluster (which keeps them cullable).
+	*/
+	class NAZARA_GRAPHICS_API StaticBatcher
+	{
+		public:
+			inline StaticBatcher(float clusterSize = 64.f);
+			StaticBatcher(const StaticBatcher&) = delete;
+			StaticBatcher(StaticBatcher&&) noexcept = default;
+			~StaticBatcher() = default;
+
+			bool AddMesh(const Mesh& mesh, const Matrix4f& transformMatrix, const std::vector<std::shared_ptr<MaterialInstance>>& materials);
+
+			std::vector<std::shared_ptr<Model>> Build() const;
+
+			inline void Clear();
+
+			inline std::size_t GetClusterCount() const;
+			inline float GetClusterSize() const;
+
+			StaticBatcher& operator=(const StaticBatcher&) = delete;
+			StaticBatcher& operator=(StaticBatcher&&) noexcept = default;
+
+		private:
+			struct Batch
+			{
+				std::shared_ptr<MaterialInstance> material;
+				std::shared_ptr<const VertexDeclaration> vertexDeclaration;
+				std::vector<UInt8> vertices;
+				std::vector<UInt32> indices;
+				Boxf aabb;
+				PrimitiveMode primitiveMode;
+				UInt32 vertexCount = 0;
+			};
+
+			struct Cluster
+			{
+				std::vector<Batch> batches;
+			};
+
+			std::unordered_map<Vector3i32, Cluster> m_clusters;
+			float m_clusterSize;
+	};
+}
+
+#include <Nazara/Graphics/StaticBatcher.inl>
+
+#endif // NAZARA_GRAPHICS_STATICBATCHER_HPP
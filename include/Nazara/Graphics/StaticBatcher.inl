@@ -0,0 +1,37 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <cassert>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Constructs a static batcher
+	*
+	* \param clusterSize Size of the grid cells meshes are clustered in, bigger clusters mean less draws but coarser culling
+	*/
+	inline StaticBatcher::StaticBatcher(float clusterSize) :
+	m_clusterSize(clusterSize)
+	{
+		assert(m_clusterSize > 0.f);
+	}
+
+	inline void StaticBatcher::Clear()
+	{
+		m_clusters.clear();
+	}
+
+	inline std::size_t StaticBatcher::GetClusterCount() const
+	{
+		return m_clusters.size();
+	}
+
+	inline float StaticBatcher::GetClusterSize() const
+	{
+		return m_clusterSize;
+	}
+}
+
+#include <Nazara/Graphics/DebugOff.hpp>
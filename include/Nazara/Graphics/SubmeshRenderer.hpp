@@ -9,46 +9,92 @@
 
 #include <NazaraUtils/Prerequisites.hpp>
 #include <Nazara/Graphics/ElementRenderer.hpp>
+#include <Nazara/Graphics/PredefinedShaderStructs.hpp>
 #include <Nazara/Graphics/RenderSubmesh.hpp>
+#include <Nazara/Math/Box.hpp>
 #include <Nazara/Math/Rect.hpp>
 #include <Nazara/Renderer/ShaderBinding.hpp>
+#include <limits>
 
 namespace Nz
 {
+	class AnimationTexture;
+	class RenderDevice;
 	class RenderPipeline;
 	class ShaderBinding;
+	class ShaderBindingCache;
+	class WorldInstance;
 
 	class NAZARA_GRAPHICS_API SubmeshRenderer final : public ElementRenderer
 	{
 		public:
-			SubmeshRenderer() = default;
+			SubmeshRenderer(RenderDevice& device, std::size_t minInstanceCount = 2);
 			~SubmeshRenderer() = default;
 
+			void EndFrame(RenderFrame& currentFrame) override;
+
 			RenderElementPool<RenderSubmesh>& GetPool() override;
 
 			std::unique_ptr<ElementRendererData> InstanciateData() override;
 			void Prepare(const ViewerInstance& viewerInstance, ElementRendererData& rendererData, RenderFrame& currentFrame, std::size_t elementCount, const Pointer<const RenderElement>* elements, const RenderStates* renderStates) override;
+			void PrepareEnd(RenderFrame& currentFrame, ElementRendererData& rendererData) override;
 			void Render(const ViewerInstance& viewerInstance, ElementRendererData& rendererData, CommandBufferBuilder& commandBuffer, std::size_t elementCount, const Pointer<const RenderElement>* elements) override;
 			void Reset(ElementRendererData& rendererData, RenderFrame& currentFrame) override;
+			void Update(RenderFrame& currentFrame, ElementRendererData& rendererData) override;
 
 		private:
+			static bool CanBeInstanced(const RenderSubmesh& first, const RenderStates& firstStates, const RenderSubmesh& submesh, const RenderStates& renderStates);
+
+			struct InstanceBufferPool
+			{
+				std::vector<std::shared_ptr<RenderBuffer>> instanceAnimationBuffers;
+				std::vector<std::shared_ptr<RenderBuffer>> instanceBuffers;
+			};
+
+			std::shared_ptr<InstanceBufferPool> m_instanceBufferPool;
+			std::shared_ptr<ShaderBindingCache> m_shaderBindingCache;
+			std::size_t m_minInstanceCount;
 			std::vector<ShaderBinding::Binding> m_bindingCache;
 			std::vector<ShaderBinding::SampledTextureBinding> m_textureBindingCache;
+			PredefinedInstanceAnimationArrayData m_instanceAnimationArrayOffsets;
+			PredefinedInstanceArrayData m_instanceArrayOffsets;
 			RenderElementPool<RenderSubmesh> m_submeshPool;
+			RenderDevice& m_device;
 	};
 
-	struct SubmeshRendererData : public ElementRendererData
+	struct NAZARA_GRAPHICS_API SubmeshRendererData : public ElementRendererData
 	{
+		~SubmeshRendererData();
+
+		static constexpr std::size_t InvalidBatchIndex = std::numeric_limits<std::size_t>::max();
+
 		struct DrawCall
 		{
 			const RenderBuffer* indexBuffer;
 			const RenderBuffer* vertexBuffer;
 			const RenderPipeline* renderPipeline;
 			const ShaderBinding* shaderBinding;
+			std::size_t cullingBatchIndex; //< batch whose draw command is written by the culling pass (InvalidBatchIndex for direct draws)
 			std::size_t firstIndex;
 			std::size_t indexCount;
+			std::size_t instanceCount;
 			IndexType indexType;
 			Recti scissorBox;
+			UInt64 vertexBufferOffset;
+			bool bindlessTextures; //< material samples its textures from the bindless texture table
+		};
+
+		struct CullingBatch
+		{
+			Boxf aabb;
+			ShaderBindingPtr shaderBinding; //< instance storage buffer binding is completed by PrepareEnd, once every batch is known
+			UInt32 instanceBindingIndex;
+			UInt64 outputOffset; //< in bytes, in instanceOutputBuffer
+			std::size_t firstIndex;
+			std::size_t firstWorldInstance;
+			std::size_t indexCount;
+			std::size_t instanceCount;
+			bool cullingEnabled;
 		};
 
 		struct DrawCallIndices
@@ -57,9 +103,32 @@ namespace Nz
 			std::size_t count;
 		};
 
+		struct InstanceBatch
+		{
+			const AnimationTexture* animationTexture;
+			RenderBuffer* instanceAnimationBuffer; //< only for batches animated from an animation texture
+			RenderBuffer* instanceBuffer; //< null for culled batches (whose instances are written by the culling pass)
+			std::size_t firstWorldInstance;
+			std::size_t instanceCount;
+		};
+
 		std::unordered_map<const RenderSubmesh*, DrawCallIndices> drawCallPerElement;
+		std::vector<const WorldInstance*> batchedWorldInstances;
+		std::vector<CullingBatch> cullingBatches;
 		std::vector<DrawCall> drawCalls;
-		std::vector<ShaderBindingPtr> shaderBindings;
+		std::vector<InstanceBatch> instanceBatches;
+		std::vector<std::shared_ptr<RenderBuffer>> instanceAnimationBuffers;
+		std::vector<std::shared_ptr<RenderBuffer>> instanceBuffers;
+		std::vector<const ShaderBinding*> shaderBindings; //< acquired from shaderBindingCache
+		std::shared_ptr<RenderBuffer> cullingBatchBuffer;
+		std::shared_ptr<RenderBuffer> cullingDataBuffer;
+		std::shared_ptr<RenderBuffer> cullingInstanceBuffer;
+		std::shared_ptr<RenderBuffer> drawCommandBuffer;
+		std::shared_ptr<RenderBuffer> instanceOutputBuffer;
+		std::shared_ptr<ShaderBindingCache> shaderBindingCache;
+		const ViewerInstance* viewerInstance = nullptr;
+		ShaderBindingPtr cullingShaderBinding;
+		UInt64 instanceOutputSize = 0;
 	};
 }
 
@@ -8,20 +8,25 @@
 #define NAZARA_GRAPHICS_SYSTEMS_RENDERSYSTEM_HPP
 
 #include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/EnttSystemGraph.hpp>
 #include <Nazara/Core/Time.hpp>
 #include <Nazara/Graphics/ElementRendererRegistry.hpp>
 #include <Nazara/Graphics/Graphics.hpp>
 #include <Nazara/Graphics/Components/GraphicsComponent.hpp>
 #include <Nazara/Graphics/Components/LightComponent.hpp>
+#include <Nazara/Math/Matrix4.hpp>
+#include <Nazara/Math/Quaternion.hpp>
+#include <Nazara/Math/Vector3.hpp>
 #include <Nazara/Renderer/WindowSwapchain.hpp>
 #include <Nazara/Utility/Node.hpp>
 #include <Nazara/Utility/Skeleton.hpp>
+#include <NazaraUtils/Bitset.hpp>
 #include <NazaraUtils/MemoryPool.hpp>
 #include <entt/entt.hpp>
 #include <array>
 #include <memory>
-#include <set>
 #include <unordered_map>
+#include <vector>
 
 namespace Nz
 {
@@ -29,6 +34,7 @@ namespace Nz
 	class FramePipeline;
 	class RenderFrame;
 	class UploadPool;
+	class WorldInstance;
 
 	class NAZARA_GRAPHICS_API RenderSystem
 	{
@@ -43,10 +49,15 @@ namespace Nz
 
 			WindowSwapchain& CreateSwapchain(Window& window, const SwapchainParameters& parameters = SwapchainParameters{});
 
+			inline void EnableTransformInterpolation(bool enable = true);
+
 			inline FramePipeline& GetFramePipeline();
 			inline const FramePipeline& GetFramePipeline() const;
 
+			inline bool IsTransformInterpolationEnabled() const;
+
 			void Update(Time elapsedTime);
+			void Update(Time elapsedTime, const EnttSystemGraph::FixedStepInfo& fixedStepInfo);
 
 			RenderSystem& operator=(const RenderSystem&) = delete;
 			RenderSystem& operator=(RenderSystem&&) = delete;
@@ -64,11 +75,18 @@ namespace Nz
 			void OnSkeletonDestroy(entt::registry& registry, entt::entity entity);
 			void UpdateGraphicsVisibility(GraphicsEntity* gfxData, GraphicsComponent& gfxComponent, bool isVisible);
 			void UpdateLightVisibility(LightEntity* gfxData, LightComponent& lightComponent, bool isVisible);
-			void UpdateInstances();
+			void UpdateInstances(const EnttSystemGraph::FixedStepInfo& fixedStepInfo);
 			void UpdateObservers();
 
 			static constexpr std::size_t NoInstance = std::numeric_limits<std::size_t>::max();
 
+			struct TransformState
+			{
+				Quaternionf rotation;
+				Vector3f position;
+				Vector3f scale;
+			};
+
 			struct CameraEntity
 			{
 				entt::entity entity;
@@ -85,6 +103,9 @@ namespace Nz
 				std::size_t poolIndex;
 				std::size_t skeletonInstanceIndex;
 				std::size_t worldInstanceIndex;
+				TransformState currentTransform;
+				TransformState previousTransform; //< transform before the last fixed step, used for interpolation
+				bool hasTransformState;
 
 				NazaraSlot(GraphicsComponent, OnRenderableAttached, onRenderableAttached);
 				NazaraSlot(GraphicsComponent, OnRenderableDetach, onRenderableDetach);
@@ -106,6 +127,14 @@ namespace Nz
 				NazaraSlot(Node, OnNodeInvalidation, onNodeInvalidation);
 			};
 
+			struct InvalidatedWorldInstance
+			{
+				Matrix4f invWorldMatrix;
+				Matrix4f worldMatrix;
+				WorldInstance* worldInstance;
+				bool isInvertible;
+			};
+
 			struct SharedSkeleton
 			{
 				std::size_t skeletonInstanceIndex;
@@ -128,19 +157,24 @@ namespace Nz
 			entt::scoped_connection m_nodeDestroyConnection;
 			entt::scoped_connection m_sharedSkeletonDestroyConnection;
 			entt::scoped_connection m_skeletonDestroyConnection;
-			std::set<CameraEntity*> m_invalidatedCameraNode;
-			std::set<GraphicsEntity*> m_invalidatedGfxWorldNode;
-			std::set<LightEntity*> m_invalidatedLightWorldNode;
+			std::size_t m_cameraCount;
 			std::unique_ptr<FramePipeline> m_pipeline;
-			std::unordered_map<entt::entity, CameraEntity*> m_cameraEntities;
-			std::unordered_map<entt::entity, GraphicsEntity*> m_graphicsEntities;
-			std::unordered_map<entt::entity, LightEntity*> m_lightEntities;
 			std::unordered_map<Skeleton*, SharedSkeleton> m_sharedSkeletonInstances;
+			std::vector<CameraEntity*> m_cameraEntities; //< indexed by entity index
+			std::vector<GraphicsEntity*> m_graphicsEntities; //< indexed by entity index
+			std::vector<InvalidatedWorldInstance> m_invalidatedWorldInstances;
+			std::vector<LightEntity*> m_lightEntities; //< indexed by entity index
 			std::vector<std::unique_ptr<WindowSwapchain>> m_windowSwapchains;
+			Bitset<UInt64> m_invalidatedCameraNode; //< indexed by pool index
+			Bitset<UInt64> m_invalidatedGfxWorldNode; //< indexed by pool index
+			Bitset<UInt64> m_invalidatedLightWorldNode; //< indexed by pool index
+			Bitset<UInt64> m_interpolatedGfxEntities; //< indexed by pool index
 			ElementRendererRegistry m_elementRegistry;
 			MemoryPool<CameraEntity> m_cameraEntityPool;
 			MemoryPool<GraphicsEntity> m_graphicsEntityPool;
 			MemoryPool<LightEntity> m_lightEntityPool;
+			UInt64 m_lastFixedStepIndex;
+			bool m_transformInterpolation;
 	};
 }
 
@@ -7,6 +7,20 @@
 
 namespace Nz
 {
+	/*!
+	* \brief Enables or disables interpolation of graphics entities transforms between fixed steps
+	*
+	* When enabled, graphics entities moved during fixed steps (see EnttSystemGraph::SetFixedTimestep) are rendered between their two last
+	* fixed step transforms, using the interpolation factor of the system graph, which hides the stutter of fixed rate simulations.
+	* Entities moved outside of fixed steps snap to their new transform.
+	*
+	* \remark This only has an effect when the render system is updated by a system graph with a fixed timestep
+	*/
+	inline void RenderSystem::EnableTransformInterpolation(bool enable)
+	{
+		m_transformInterpolation = enable;
+	}
+
 	inline FramePipeline& RenderSystem::GetFramePipeline()
 	{
 		return *m_pipeline;
@@ -16,6 +30,11 @@ namespace Nz
 	{
 		return *m_pipeline;
 	}
+
+	inline bool RenderSystem::IsTransformInterpolationEnabled() const
+	{
+		return m_transformInterpolation;
+	}
 }
 
 #include <Nazara/Graphics/DebugOff.hpp>
@@ -0,0 +1,59 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_GRAPHICS_TERRAINRENDERER_HPP
+#define NAZARA_GRAPHICS_TERRAINRENDERER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Graphics/ElementRenderer.hpp>
+#include <Nazara/Graphics/RenderTerrain.hpp>
+#include <Nazara/Renderer/ShaderBinding.hpp>
+#include <map>
+#include <memory>
+#include <utility>
+
+namespace Nz
+{
+	class ClipmapTerrain;
+	class RenderBuffer;
+	class RenderDevice;
+
+	struct NAZARA_GRAPHICS_API TerrainRendererData : public ElementRendererData
+	{
+		struct InstanceData
+		{
+			std::shared_ptr<RenderBuffer> terrainBuffer; //< keeps the terrain buffer from being reused by another terrain allocated at the same address
+			const RenderBuffer* instanceBuffer = nullptr;
+			UInt64 instanceBufferOffset = 0;
+			ShaderBindingPtr shaderBinding;
+			bool isUsed = true;
+		};
+
+		std::map<std::pair<const WorldInstance*, const ClipmapTerrain*>, InstanceData> instances;
+	};
+
+	class NAZARA_GRAPHICS_API TerrainRenderer final : public ElementRenderer
+	{
+		public:
+			TerrainRenderer() = default;
+			~TerrainRenderer() = default;
+
+			RenderElementPool<RenderTerrain>& GetPool() override;
+
+			std::unique_ptr<ElementRendererData> InstanciateData() override;
+			void Prepare(const ViewerInstance& viewerInstance, ElementRendererData& rendererData, RenderFrame& currentFrame, std::size_t elementCount, const Pointer<const RenderElement>* elements, const RenderStates* renderStates) override;
+			void PrepareEnd(RenderFrame& currentFrame, ElementRendererData& rendererData) override;
+			void Render(const ViewerInstance& viewerInstance, ElementRendererData& rendererData, CommandBufferBuilder& commandBuffer, std::size_t elementCount, const Pointer<const RenderElement>* elements) override;
+			void Reset(ElementRendererData& rendererData, RenderFrame& currentFrame) override;
+
+		private:
+			RenderElementPool<RenderTerrain> m_terrainPool;
+	};
+}
+
+#include <Nazara/Graphics/TerrainRenderer.inl>
+
+#endif // NAZARA_GRAPHICS_TERRAINRENDERER_HPP
@@ -39,6 +39,7 @@ namespace Nz
 			inline void SetMaterial(std::shared_ptr<MaterialInstance> material);
 
 			void Update(const AbstractTextDrawer& drawer, float scale = 1.f);
+			void Update(const AbstractTextDrawer& drawer, std::size_t firstGlyph, std::size_t glyphCount, float scale = 1.f);
 
 			TextSprite& operator=(const TextSprite&) = delete;
 			TextSprite& operator=(TextSprite&&) noexcept = default;
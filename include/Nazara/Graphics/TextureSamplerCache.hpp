@@ -10,12 +10,20 @@
 #include <NazaraUtils/Prerequisites.hpp>
 #include <Nazara/Graphics/Config.hpp>
 #include <Nazara/Renderer/TextureSampler.hpp>
+#include <initializer_list>
+#include <shared_mutex>
 #include <unordered_map>
 
 namespace Nz
 {
 	class RenderDevice;
 
+	/*!
+	* \brief Creates texture samplers on demand and shares them between users
+	*
+	* Lookups can be done from any thread, the cache is read-mostly: they only take a shared lock unless a new sampler has to be created.
+	* Samplers are never removed from the cache, which allows Get to return a reference.
+	*/
 	class NAZARA_GRAPHICS_API TextureSamplerCache
 	{
 		public:
@@ -26,10 +34,14 @@ namespace Nz
 
 			const std::shared_ptr<TextureSampler>& Get(const TextureSamplerInfo& info);
 
+			void Preallocate(std::initializer_list<TextureSamplerInfo> infos);
+			void Preallocate(const TextureSamplerInfo* infos, std::size_t infoCount);
+
 			TextureSamplerCache& operator=(const TextureSamplerCache&) = delete;
 			TextureSamplerCache& operator=(TextureSamplerCache&&) = delete;
 
 		private:
+			mutable std::shared_mutex m_mutex;
 			std::shared_ptr<RenderDevice> m_device;
 			std::unordered_map<TextureSamplerInfo, std::shared_ptr<TextureSampler>> m_samplers;
 	};
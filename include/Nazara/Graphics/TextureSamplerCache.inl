@@ -11,6 +11,11 @@ namespace Nz
 	m_device(std::move(device))
 	{
 	}
+
+	inline void TextureSamplerCache::Preallocate(std::initializer_list<TextureSamplerInfo> infos)
+	{
+		return Preallocate(infos.begin(), infos.size());
+	}
 }
 
 #include <Nazara/Graphics/DebugOff.hpp>
@@ -0,0 +1,127 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_GRAPHICS_TEXTURESTREAMER_HPP
+#define NAZARA_GRAPHICS_TEXTURESTREAMER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Graphics/Config.hpp>
+#include <Nazara/Renderer/Texture.hpp>
+#include <NazaraUtils/Bitset.hpp>
+#include <NazaraUtils/MemoryPool.hpp>
+#include <NazaraUtils/Signal.hpp>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Nz
+{
+	class MaterialInstance;
+	class RenderDevice;
+	class RenderFrame;
+
+	class NAZARA_GRAPHICS_API TextureStreamer
+	{
+		public:
+			struct Config;
+
+			TextureStreamer(std::shared_ptr<RenderDevice> renderDevice, Config config);
+			TextureStreamer(const TextureStreamer&) = delete;
+			TextureStreamer(TextureStreamer&&) = delete;
+			~TextureStreamer();
+
+			void BindMaterialTexture(std::size_t textureIndex, std::shared_ptr<MaterialInstance> materialInstance, std::size_t texturePropertyIndex);
+
+			inline const Config& GetConfig() const;
+			inline UInt64 GetMemoryBudget() const;
+			inline UInt64 GetResidentMemory() const;
+			UInt8 GetResidentLevel(std::size_t textureIndex) const;
+			const std::shared_ptr<Texture>& GetTexture(std::size_t textureIndex) const;
+
+			std::size_t RegisterTexture(std::shared_ptr<Image> image);
+			std::size_t RegisterTexture(std::filesystem::path filePath, ImageParams params = {});
+
+			void ReportMaterialUsage(const MaterialInstance* materialInstance, float screenSize);
+			void ReportTextureUsage(std::size_t textureIndex, float screenSize);
+
+			inline void SetMemoryBudget(UInt64 memoryBudget);
+
+			void UnbindMaterial(const MaterialInstance* materialInstance);
+			void UnregisterTexture(std::size_t textureIndex);
+
+			void Update(RenderFrame& renderFrame);
+
+			TextureStreamer& operator=(const TextureStreamer&) = delete;
+			TextureStreamer& operator=(TextureStreamer&&) = delete;
+
+			struct Config
+			{
+				UInt64 defragmentationBudget = 8ull * 1024 * 1024; //< bytes moved per defragmentation step
+				UInt64 deviceMemoryMargin = 64ull * 1024 * 1024; //< device memory kept free when the driver budget is tighter than the memory budget
+				UInt64 memoryBudget = 512ull * 1024 * 1024; //< VRAM allowed for streamed textures, only the coarsest levels may exceed it
+				UInt64 uploadBudget = 16ull * 1024 * 1024; //< bytes uploaded per frame when raising residency
+				UInt32 defragmentationInterval = 30; //< frames between two defragmentation steps of streamed texture memory, 0 to disable
+				UInt32 evictionDelay = 120; //< frames without any usage report before a texture falls back to its coarsest levels
+				float lodBias = 0.f; //< added to the computed level, positive values lower the requested quality
+				unsigned int minResidentSize = 64; //< largest dimension of the levels always kept resident
+			};
+
+			NazaraSignal(OnTextureResidencyChanged, TextureStreamer* /*textureStreamer*/, std::size_t /*textureIndex*/, const std::shared_ptr<Texture>& /*newTexture*/);
+
+		private:
+			struct TextureData;
+
+			UInt8 ComputeBaseLevel(const Image& image) const;
+			UInt64 ComputeMemoryBudget() const;
+			UInt64 ComputeMemoryUsage(const TextureData& textureData, UInt8 residentLevel) const;
+			void RefreshBindings(std::size_t textureIndex, TextureData& textureData);
+			bool Reside(std::size_t textureIndex, TextureData& textureData, UInt8 residentLevel, RenderFrame& renderFrame);
+
+			struct MaterialBinding
+			{
+				std::shared_ptr<MaterialInstance> materialInstance;
+				std::size_t texturePropertyIndex;
+			};
+
+			struct PendingImage
+			{
+				std::shared_ptr<Image> image;
+			};
+
+			struct TextureData
+			{
+				std::shared_ptr<Image> image;
+				std::shared_ptr<PendingImage> pendingImage;
+				std::shared_ptr<Texture> texture;
+				std::vector<MaterialBinding> materialBindings;
+				TaskScheduler::TaskHandle loadingTask;
+				UInt64 lastUsedFrame = 0;
+				UInt64 memoryUsage = 0;
+				float requestedLevel = std::numeric_limits<float>::infinity(); //< finest level requested since the last update
+				float screenCoverage = 0.f;
+				UInt8 baseLevel = 0; //< coarsest resident level, always uploaded
+				UInt8 residentLevel = 0; //< finest level currently resident on the GPU
+				UInt8 targetLevel = 0;
+			};
+
+			std::shared_ptr<RenderDevice> m_renderDevice;
+			std::unordered_map<const MaterialInstance*, std::vector<std::size_t>> m_materialTextures;
+			std::vector<std::size_t> m_sortedTextures;
+			Bitset<UInt64> m_registeredTextures;
+			Config m_config;
+			MemoryPool<TextureData> m_textures;
+			UInt64 m_frameIndex;
+			UInt64 m_memoryBudget;
+			UInt64 m_residentMemory;
+	};
+}
+
+#include <Nazara/Graphics/TextureStreamer.inl>
+
+#endif // NAZARA_GRAPHICS_TEXTURESTREAMER_HPP
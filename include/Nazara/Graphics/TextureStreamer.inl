@@ -0,0 +1,30 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	inline auto TextureStreamer::GetConfig() const -> const Config&
+	{
+		return m_config;
+	}
+
+	inline UInt64 TextureStreamer::GetMemoryBudget() const
+	{
+		return m_memoryBudget;
+	}
+
+	inline UInt64 TextureStreamer::GetResidentMemory() const
+	{
+		return m_residentMemory;
+	}
+
+	inline void TextureStreamer::SetMemoryBudget(UInt64 memoryBudget)
+	{
+		m_config.memoryBudget = memoryBudget;
+	}
+}
+
+#include <Nazara/Graphics/DebugOff.hpp>
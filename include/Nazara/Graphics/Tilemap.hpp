@@ -68,12 +68,22 @@ namespace Nz
 			Tilemap& operator=(const Tilemap&) = delete;
 			Tilemap& operator=(Tilemap&&) noexcept = default;
 
+			static constexpr unsigned int ChunkSize = 32; //< tiles per chunk side, vertices are rebuilt per chunk
+
 		private:
 			Vector3ui GetTextureSize(std::size_t matIndex) const;
+			inline void InvalidateTile(std::size_t tileIndex);
 			inline void InvalidateVertices();
 			inline void UpdateAABB();
+			void UpdateChunk(std::size_t chunkIndex) const;
 			void UpdateVertices() const;
 
+			struct Chunk
+			{
+				std::vector<std::size_t> layerFirstSprite; //< first sprite of each layer (and total sprite count as the last entry)
+				std::vector<VertexStruct_XYZ_Color_UV> vertices;
+			};
+
 			struct Layer
 			{
 				std::shared_ptr<MaterialInstance> material;
@@ -81,14 +91,15 @@ namespace Nz
 				std::size_t enabledTileCount = 0; //< cached bitset popcount
 			};
 
-			mutable std::vector<VertexStruct_XYZ_Color_UV> m_vertices;
+			mutable std::vector<Chunk> m_chunks;
 			std::vector<Layer> m_layers;
 			std::vector<Tile> m_tiles;
+			mutable Bitset<UInt64> m_invalidatedChunks;
 			Vector2f m_origin;
 			Vector2f m_tileSize;
+			Vector2ui m_chunkCount;
 			Vector2ui m_mapSize;
 			bool m_isometricModeEnabled;
-			mutable bool m_shouldRebuildVertices;
 	};
 }
 
@@ -26,9 +26,10 @@ namespace Nz
 			Layer& layer = m_layers[tile.layerIndex];
 			layer.enabledTiles.Reset(tileIndex);
 			layer.enabledTileCount = layer.enabledTiles.Count();
-		}
 
-		InvalidateVertices();
+			InvalidateTile(tileIndex);
+			OnElementInvalidated(this);
+		}
 	}
 
 	/*!
@@ -77,6 +78,8 @@ namespace Nz
 
 				Layer& layer = m_layers[tile.layerIndex];
 				layer.enabledTiles.Reset(tileIndex);
+
+				InvalidateTile(tileIndex);
 			}
 
 			tilesPos++;
@@ -86,7 +89,7 @@ namespace Nz
 			layer.enabledTileCount = layer.enabledTiles.Count();
 
 		if (tileCount > 0)
-			InvalidateVertices();
+			OnElementInvalidated(this);
 	}
 
 	/*!
@@ -148,7 +151,8 @@ namespace Nz
 		tile.textureCoords = coords;
 		tile.layerIndex = materialIndex;
 
-		InvalidateVertices();
+		InvalidateTile(tileIndex);
+		OnElementInvalidated(this);
 	}
 
 	/*!
@@ -289,13 +293,15 @@ namespace Nz
 			tile.textureCoords = coords;
 			tile.layerIndex = materialIndex;
 			tilesPos++;
+
+			InvalidateTile(tileIndex);
 		}
 
 		for (Layer& layer : m_layers)
 			layer.enabledTileCount = layer.enabledTiles.Count();
 
 		if (tileCount > 0)
-			InvalidateVertices();
+			OnElementInvalidated(this);
 	}
 
 	/*!
@@ -404,9 +410,17 @@ namespace Nz
 		UpdateAABB();
 	}
 
+	inline void Tilemap::InvalidateTile(std::size_t tileIndex)
+	{
+		std::size_t x = tileIndex % m_mapSize.x;
+		std::size_t y = tileIndex / m_mapSize.x;
+
+		m_invalidatedChunks.Set((y / ChunkSize) * m_chunkCount.x + x / ChunkSize);
+	}
+
 	inline void Tilemap::InvalidateVertices()
 	{
-		m_shouldRebuildVertices = true;
+		m_invalidatedChunks.Set();
 		OnElementInvalidated(this);
 	}
 
@@ -13,12 +13,17 @@
 #include <Nazara/Renderer/RenderPipeline.hpp>
 #include <NazaraUtils/Signal.hpp>
 #include <NZSL/ModuleResolver.hpp>
+#include <NZSL/ShaderWriter.hpp>
 #include <NZSL/Ast/Module.hpp>
+#include <mutex>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 
 namespace Nz
 {
 	class ShaderModule;
+	class ShaderVariantArchive;
 
 	class NAZARA_GRAPHICS_API UberShader
 	{
@@ -64,13 +69,17 @@ namespace Nz
 			NazaraSignal(OnShaderUpdated, UberShader* /*uberShader*/);
 
 		private:
+			std::shared_ptr<ShaderModule> InstantiateFromArchive(ShaderVariantArchive& archive, std::string_view moduleName, UInt64 moduleHash, const Config& config, const nzsl::Ast::Module& shaderModule, const nzsl::ShaderWriter::States& states) const;
 			nzsl::Ast::ModulePtr Validate(const nzsl::Ast::Module& module, std::unordered_map<std::string, Option>* options);
 
 			NazaraSlot(nzsl::ModuleResolver, OnModuleUpdated, m_onShaderModuleUpdated);
 
 			std::unordered_map<Config, std::shared_ptr<ShaderModule>, ConfigHasher, ConfigEqual> m_combinations;
 			std::unordered_map<std::string, Option> m_optionIndexByName;
+			std::mutex m_combinationMutex;
 			nzsl::Ast::ModulePtr m_shaderModule;
+			std::string m_moduleName;
+			UInt64 m_moduleHash;
 			ConfigCallback m_configCallback;
 			nzsl::ShaderStageTypeFlags m_shaderStages;
 	};
@@ -0,0 +1,79 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_GRAPHICS_UPSCALEPIPELINEPASS_HPP
+#define NAZARA_GRAPHICS_UPSCALEPIPELINEPASS_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Graphics/Config.hpp>
+#include <Nazara/Graphics/Enums.hpp>
+#include <Nazara/Graphics/FramePipelinePass.hpp>
+#include <Nazara/Graphics/TransferInterface.hpp>
+#include <Nazara/Math/Matrix4.hpp>
+#include <Nazara/Math/Vector2.hpp>
+#include <Nazara/Renderer/ShaderBinding.hpp>
+#include <memory>
+
+namespace Nz
+{
+	class AbstractViewer;
+	class BakedFrameGraph;
+	class FrameGraph;
+	class FramePass;
+	class RenderBuffer;
+	class Texture;
+
+	/*!
+	* \brief Upscales the region of the viewer attachments rendered at a lower resolution (see AbstractViewer::GetRenderViewport) to the viewer viewport
+	*
+	* In temporal mode, the viewer projection is jittered every frame and the upscaled frames are accumulated in a history texture,
+	* which is reprojected using the depth buffer (only the camera motion is taken into account).
+	*/
+	class NAZARA_GRAPHICS_API UpscalePipelinePass : public FramePipelinePass, public TransferInterface
+	{
+		public:
+			UpscalePipelinePass(AbstractViewer* viewer, UpscalingMode upscalingMode);
+			UpscalePipelinePass(const UpscalePipelinePass&) = delete;
+			UpscalePipelinePass(UpscalePipelinePass&&) = delete;
+			~UpscalePipelinePass();
+
+			inline UpscalingMode GetUpscalingMode() const;
+
+			inline void InvalidateHistory();
+
+			void OnTransfer(RenderFrame& renderFrame, CommandBufferBuilder& builder) override;
+
+			void Prepare();
+
+			FramePass& RegisterToFrameGraph(FrameGraph& frameGraph, std::size_t inputColorBufferIndex, std::size_t inputDepthBufferIndex, std::size_t outputColorBufferIndex);
+
+			void UpdateBindings(RenderFrame& renderFrame, const BakedFrameGraph& bakedGraph);
+			void UpdateHistory(CommandBufferBuilder& builder, const BakedFrameGraph& bakedGraph);
+
+			UpscalePipelinePass& operator=(const UpscalePipelinePass&) = delete;
+			UpscalePipelinePass& operator=(UpscalePipelinePass&&) = delete;
+
+			static constexpr std::size_t JitterSampleCount = 8;
+
+		private:
+			std::shared_ptr<RenderBuffer> m_upscaleDataBuffer;
+			std::shared_ptr<Texture> m_historyTexture;
+			std::size_t m_frameIndex;
+			std::size_t m_historyAttachment;
+			std::size_t m_inputColorBufferIndex;
+			std::size_t m_inputDepthBufferIndex;
+			AbstractViewer* m_viewer;
+			ShaderBindingPtr m_shaderBinding;
+			Matrix4f m_previousViewProjMatrix;
+			UpscalingMode m_upscalingMode;
+			Vector2f m_jitter;
+			bool m_isHistoryValid;
+	};
+}
+
+#include <Nazara/Graphics/UpscalePipelinePass.inl>
+
+#endif // NAZARA_GRAPHICS_UPSCALEPIPELINEPASS_HPP
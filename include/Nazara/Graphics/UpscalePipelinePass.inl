@@ -0,0 +1,23 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	inline UpscalingMode UpscalePipelinePass::GetUpscalingMode() const
+	{
+		return m_upscalingMode;
+	}
+
+	/*!
+	* \brief Discards the accumulated frames (for example on camera cuts), the next frame will only use its own samples
+	*/
+	inline void UpscalePipelinePass::InvalidateHistory()
+	{
+		m_isHistoryValid = false;
+	}
+}
+
+#include <Nazara/Graphics/DebugOff.hpp>
@@ -33,7 +33,9 @@ namespace Nz
 			inline const Matrix4f& GetInvProjectionMatrix() const;
 			inline const Matrix4f& GetInvViewMatrix() const;
 			inline const Matrix4f& GetInvViewProjMatrix() const;
+			inline const Vector2f& GetJitter() const;
 			inline const Matrix4f& GetProjectionMatrix() const;
+			inline float GetRenderScale() const;
 			inline const Vector2f& GetTargetSize() const;
 			inline const Matrix4f& GetViewMatrix() const;
 			inline const Matrix4f& GetViewProjMatrix() const;
@@ -43,11 +45,13 @@ namespace Nz
 			void OnTransfer(RenderFrame& renderFrame, CommandBufferBuilder& builder) override;
 
 			inline void UpdateEyePosition(const Vector3f& eyePosition);
+			inline void UpdateJitter(const Vector2f& jitter);
 			inline void UpdateProjectionMatrix(const Matrix4f& projectionMatrix);
 			inline void UpdateProjectionMatrix(const Matrix4f& projectionMatrix, const Matrix4f& invProjectionMatrix);
 			inline void UpdateProjViewMatrices(const Matrix4f& projectionMatrix, const Matrix4f& viewMatrix);
 			inline void UpdateProjViewMatrices(const Matrix4f& projectionMatrix, const Matrix4f& invProjectionMatrix, const Matrix4f& viewMatrix, const Matrix4f& invViewMatrix);
 			inline void UpdateProjViewMatrices(const Matrix4f& projectionMatrix, const Matrix4f& invProjectionMatrix, const Matrix4f& viewMatrix, const Matrix4f& invViewMatrix, const Matrix4f& viewProjMatrix, const Matrix4f& invViewProjMatrix);
+			inline void UpdateRenderScale(float renderScale);
 			inline void UpdateTargetSize(const Vector2f& targetSize);
 			inline void UpdateViewMatrix(const Matrix4f& viewMatrix);
 			inline void UpdateViewMatrix(const Matrix4f& viewMatrix, const Matrix4f& invViewMatrix);
@@ -65,9 +69,11 @@ namespace Nz
 			Matrix4f m_projectionMatrix;
 			Matrix4f m_viewProjMatrix;
 			Matrix4f m_viewMatrix;
+			Vector2f m_jitter;
 			Vector2f m_targetSize;
 			Vector3f m_eyePosition;
 			bool m_dataInvalidated;
+			float m_renderScale;
 	};
 }
 
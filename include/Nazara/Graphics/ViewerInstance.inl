@@ -27,11 +27,29 @@ namespace Nz
 		return m_invViewProjMatrix;
 	}
 
+	/*!
+	* \brief Returns the sub-pixel offset applied to the projection sent to the GPU
+	*
+	* \see UpdateJitter
+	*/
+	inline const Vector2f& ViewerInstance::GetJitter() const
+	{
+		return m_jitter;
+	}
+
 	inline const Matrix4f& ViewerInstance::GetProjectionMatrix() const
 	{
 		return m_projectionMatrix;
 	}
 
+	/*!
+	* \brief Returns the factor applied to the viewport size when rendering this viewer (see AbstractViewer::GetRenderViewport)
+	*/
+	inline float ViewerInstance::GetRenderScale() const
+	{
+		return m_renderScale;
+	}
+
 	inline const Vector2f& ViewerInstance::GetTargetSize() const
 	{
 		return m_targetSize;
@@ -64,6 +82,23 @@ namespace Nz
 		InvalidateData();
 	}
 
+	/*!
+	* \brief Offsets the projection sent to the GPU by a fraction of a pixel, for temporal accumulation
+	*
+	* \param jitter Offset in normalized device coordinates
+	*
+	* \remark The matrices returned by this class (used for culling) are never jittered
+	*/
+	inline void ViewerInstance::UpdateJitter(const Vector2f& jitter)
+	{
+		if (m_jitter == jitter)
+			return;
+
+		m_jitter = jitter;
+
+		InvalidateData();
+	}
+
 	inline void ViewerInstance::UpdateProjectionMatrix(const Matrix4f& projectionMatrix)
 	{
 		m_projectionMatrix = projectionMatrix;
@@ -129,6 +164,24 @@ namespace Nz
 		InvalidateData();
 	}
 
+	/*!
+	* \brief Sets the factor applied to the viewport size when rendering this viewer
+	*
+	* \param renderScale Scale factor, in the (0, 1] range
+	*
+	* \remark The target size sent to the GPU is scaled as well
+	*/
+	inline void ViewerInstance::UpdateRenderScale(float renderScale)
+	{
+		NazaraAssert(renderScale > 0.f && renderScale <= 1.f, "render scale must be in the (0, 1] range");
+		if (m_renderScale == renderScale)
+			return;
+
+		m_renderScale = renderScale;
+
+		InvalidateData();
+	}
+
 	inline void ViewerInstance::UpdateTargetSize(const Vector2f& targetSize)
 	{
 		m_targetSize = targetSize;
@@ -161,6 +214,10 @@ namespace Nz
 
 	inline void ViewerInstance::InvalidateData()
 	{
+		// Listeners were already notified since the last transfer
+		if (m_dataInvalidated)
+			return;
+
 		m_dataInvalidated = true;
 		OnTransferRequired(this);
 	}
@@ -11,14 +11,13 @@
 #include <Nazara/Graphics/Config.hpp>
 #include <Nazara/Graphics/TransferInterface.hpp>
 #include <Nazara/Math/Matrix4.hpp>
+#include <Nazara/Renderer/RenderBufferView.hpp>
 #include <Nazara/Renderer/ShaderBinding.hpp>
 #include <memory>
 
 namespace Nz
 {
 	class CommandBufferBuilder;
-	class RenderBuffer;
-	class UploadPool;
 	class WorldInstance;
 
 	using WorldInstancePtr = std::shared_ptr<WorldInstance>;
@@ -28,28 +27,34 @@ namespace Nz
 		public:
 			WorldInstance();
 			WorldInstance(const WorldInstance&) = delete;
-			WorldInstance(WorldInstance&&) noexcept = default;
-			~WorldInstance() = default;
+			WorldInstance(WorldInstance&& instance) noexcept;
+			~WorldInstance();
 
-			inline std::shared_ptr<RenderBuffer>& GetInstanceBuffer();
-			inline const std::shared_ptr<RenderBuffer>& GetInstanceBuffer() const;
+			inline std::size_t GetAnimationClip() const;
+			inline float GetAnimationTime() const;
+			inline const RenderBufferView& GetInstanceBuffer() const;
 			inline const Matrix4f& GetInvWorldMatrix() const;
 			inline const Matrix4f& GetWorldMatrix() const;
 
 			void OnTransfer(RenderFrame& renderFrame, CommandBufferBuilder& builder) override;
 
+			inline void UpdateAnimation(std::size_t clipIndex, float time);
 			inline void UpdateWorldMatrix(const Matrix4f& worldMatrix);
 			inline void UpdateWorldMatrix(const Matrix4f& worldMatrix, const Matrix4f& invWorldMatrix);
 
 			WorldInstance& operator=(const WorldInstance&) = delete;
-			WorldInstance& operator=(WorldInstance&&) noexcept = default;
+			WorldInstance& operator=(WorldInstance&& instance) noexcept;
 
 		private:
-			inline void InvalidateData();
+			void InvalidateData();
+			void UpdateInstanceData();
 
-			std::shared_ptr<RenderBuffer> m_instanceDataBuffer;
+			RenderBufferView m_instanceDataBuffer;
+			std::size_t m_instanceDataIndex;
 			Matrix4f m_invWorldMatrix;
 			Matrix4f m_worldMatrix;
+			std::size_t m_animationClip;
+			float m_animationTime;
 			bool m_dataInvalided;
 	};
 }
@@ -7,12 +7,20 @@
 
 namespace Nz
 {
-	inline std::shared_ptr<RenderBuffer>& WorldInstance::GetInstanceBuffer()
+	inline std::size_t WorldInstance::GetAnimationClip() const
 	{
-		return m_instanceDataBuffer;
+		return m_animationClip;
 	}
 
-	inline const std::shared_ptr<RenderBuffer>& WorldInstance::GetInstanceBuffer() const
+	inline float WorldInstance::GetAnimationTime() const
+	{
+		return m_animationTime;
+	}
+
+	/*!
+	* \brief Returns the instance data uniform buffer range of this instance, sub-allocated from a buffer shared by many instances
+	*/
+	inline const RenderBufferView& WorldInstance::GetInstanceBuffer() const
 	{
 		return m_instanceDataBuffer;
 	}
@@ -27,6 +35,20 @@ namespace Nz
 		return m_worldMatrix;
 	}
 
+	/*!
+	* \brief Sets the baked animation clip played by this instance
+	*
+	* This is only used by renderables animated from an AnimationTexture, and doesn't require any transfer (the clip is sampled every frame by the renderer).
+	*
+	* \param clipIndex Index of the clip in the animation texture
+	* \param time Playback time of the clip, in seconds
+	*/
+	inline void WorldInstance::UpdateAnimation(std::size_t clipIndex, float time)
+	{
+		m_animationClip = clipIndex;
+		m_animationTime = time;
+	}
+
 	inline void WorldInstance::UpdateWorldMatrix(const Matrix4f& worldMatrix)
 	{
 		m_worldMatrix = worldMatrix;
@@ -43,12 +65,6 @@ namespace Nz
 
 		InvalidateData();
 	}
-
-	void WorldInstance::InvalidateData()
-	{
-		m_dataInvalided = true;
-		OnTransferRequired(this);
-	}
 }
 
 #include <Nazara/Graphics/DebugOff.hpp>
@@ -38,6 +38,7 @@
 #include <Nazara/JoltPhysics3D/JoltPhysicsStepListener.hpp>
 #include <Nazara/JoltPhysics3D/JoltPhysWorld3D.hpp>
 #include <Nazara/JoltPhysics3D/JoltRigidBody3D.hpp>
+#include <Nazara/JoltPhysics3D/JoltVirtualCharacter.hpp>
 
 #ifdef NAZARA_ENTT
 
@@ -31,5 +31,6 @@
 
 #include <Nazara/JoltPhysics3D/Components/JoltCharacterComponent.hpp>
 #include <Nazara/JoltPhysics3D/Components/JoltRigidBody3DComponent.hpp>
+#include <Nazara/JoltPhysics3D/Components/JoltVirtualCharacterComponent.hpp>
 
 #endif // NAZARA_JOLTPHYSICS3D_COMPONENTS_HPP
@@ -0,0 +1,37 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - JoltPhysics3D module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_JOLTPHYSICS3D_COMPONENTS_JOLTVIRTUALCHARACTERCOMPONENT_HPP
+#define NAZARA_JOLTPHYSICS3D_COMPONENTS_JOLTVIRTUALCHARACTERCOMPONENT_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/JoltPhysics3D/JoltVirtualCharacter.hpp>
+
+namespace Nz
+{
+	class NAZARA_JOLTPHYSICS3D_API JoltVirtualCharacterComponent : public JoltVirtualCharacter
+	{
+		friend class JoltPhysics3DSystem;
+
+		public:
+			inline JoltVirtualCharacterComponent(const JoltVirtualCharacter::Settings& settings);
+			JoltVirtualCharacterComponent(const JoltVirtualCharacterComponent&) = default;
+			JoltVirtualCharacterComponent(JoltVirtualCharacterComponent&&) noexcept = default;
+			~JoltVirtualCharacterComponent() = default;
+
+			JoltVirtualCharacterComponent& operator=(const JoltVirtualCharacterComponent&) = default;
+			JoltVirtualCharacterComponent& operator=(JoltVirtualCharacterComponent&&) noexcept = default;
+
+		private:
+			inline void Construct(JoltPhysWorld3D& world);
+
+			std::unique_ptr<JoltVirtualCharacter::Settings> m_settings;
+	};
+}
+
+#include <Nazara/JoltPhysics3D/Components/JoltVirtualCharacterComponent.inl>
+
+#endif // NAZARA_JOLTPHYSICS3D_COMPONENTS_JOLTVIRTUALCHARACTERCOMPONENT_HPP
@@ -0,0 +1,22 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - JoltPhysics3D module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/JoltPhysics3D/Debug.hpp>
+
+namespace Nz
+{
+	inline JoltVirtualCharacterComponent::JoltVirtualCharacterComponent(const JoltVirtualCharacter::Settings& settings)
+	{
+		m_settings = std::make_unique<JoltVirtualCharacter::Settings>(settings);
+	}
+
+	inline void JoltVirtualCharacterComponent::Construct(JoltPhysWorld3D& world)
+	{
+		assert(m_settings);
+		Create(world, *m_settings);
+		m_settings.reset();
+	}
+}
+
+#include <Nazara/JoltPhysics3D/DebugOff.hpp>
@@ -10,7 +10,9 @@
 #include <NazaraUtils/Prerequisites.hpp>
 #include <Nazara/Core/Time.hpp>
 #include <Nazara/JoltPhysics3D/Config.hpp>
+#include <Nazara/JoltPhysics3D/JoltRigidBody3D.hpp>
 #include <Nazara/Math/Box.hpp>
+#include <Nazara/Math/Quaternion.hpp>
 #include <Nazara/Math/Vector3.hpp>
 #include <NazaraUtils/FunctionRef.hpp>
 #include <NazaraUtils/MovablePtr.hpp>
@@ -29,41 +31,67 @@ namespace Nz
 {
 	class JoltCharacter;
 	class JoltCharacterImpl;
+	class JoltCollider3D;
 	class JoltPhysicsStepListener;
-	class JoltRigidBody3D;
+	class JoltVirtualCharacter;
 
 	class NAZARA_JOLTPHYSICS3D_API JoltPhysWorld3D
 	{
 		friend JoltCharacter;
 		friend JoltRigidBody3D;
+		friend JoltVirtualCharacter;
 
 		public:
+			struct ActiveBodyTransform;
 			struct RaycastHit;
+			struct RaySegment;
+			struct ShapeCast;
+			struct ShapeTransform;
+			struct StateSnapshot;
+			struct StepStats;
 
 			JoltPhysWorld3D();
 			JoltPhysWorld3D(const JoltPhysWorld3D&) = delete;
 			JoltPhysWorld3D(JoltPhysWorld3D&& ph) = delete;
 			~JoltPhysWorld3D();
 
+			std::vector<JoltRigidBody3D> CreateRigidBodies(const JoltRigidBody3D::DynamicSettings* settings, std::size_t bodyCount);
+			std::vector<JoltRigidBody3D> CreateRigidBodies(const JoltRigidBody3D::StaticSettings* settings, std::size_t bodyCount);
+
+			void DestroyRigidBodies(JoltRigidBody3D* const* bodies, std::size_t bodyCount);
+
 			UInt32 GetActiveBodyCount() const;
+			void GetActiveBodyTransforms(std::vector<ActiveBodyTransform>& transforms) const;
 			Vector3f GetGravity() const;
+			inline const StepStats& GetLastStepStats() const;
 			std::size_t GetMaxStepCount() const;
 			JPH::PhysicsSystem* GetPhysicsSystem();
 			Time GetStepSize() const;
+			std::size_t GetTempAllocatorSize() const;
 
 			inline bool IsBodyActive(UInt32 bodyIndex) const;
 			inline bool IsBodyRegistered(UInt32 bodyIndex) const;
 
+			void OverlapQueryBatch(const JoltCollider3D& collider, const ShapeTransform* transforms, std::size_t queryCount, std::vector<JoltRigidBody3D*>* results);
+
 			bool RaycastQuery(const Vector3f& from, const Vector3f& to, const FunctionRef<std::optional<float>(const RaycastHit& hitInfo)>& callback);
 			bool RaycastQueryFirst(const Vector3f& from, const Vector3f& to, const FunctionRef<void(const RaycastHit& hitInfo)>& callback);
+			void RaycastQueryFirstBatch(const RaySegment* rays, std::size_t rayCount, std::optional<RaycastHit>* results);
 
 			void RefreshBodies();
 
 			inline void RegisterStepListener(JoltPhysicsStepListener* character);
 
+			bool RestoreState(const StateSnapshot& snapshot);
+
+			void SaveState(StateSnapshot& snapshot, bool activeBodiesOnly = false);
+
 			void SetGravity(const Vector3f& gravity);
 			void SetMaxStepCount(std::size_t maxStepCount);
 			void SetStepSize(Time stepSize);
+			void SetTempAllocatorSize(std::size_t size);
+
+			void ShapeCastQueryFirstBatch(const JoltCollider3D& collider, const ShapeCast* casts, std::size_t castCount, std::optional<RaycastHit>* results);
 
 			void Step(Time timestep);
 
@@ -72,6 +100,13 @@ namespace Nz
 			JoltPhysWorld3D& operator=(const JoltPhysWorld3D&) = delete;
 			JoltPhysWorld3D& operator=(JoltPhysWorld3D&&) = delete;
 
+			struct ActiveBodyTransform
+			{
+				Quaternionf rotation;
+				Vector3f position;
+				UInt32 bodyIndex;
+			};
+
 			struct RaycastHit
 			{
 				float fraction;
@@ -80,6 +115,55 @@ namespace Nz
 				Vector3f hitPosition;
 			};
 
+			struct RaySegment
+			{
+				Vector3f from;
+				Vector3f to;
+			};
+
+			struct ShapeCast
+			{
+				Quaternionf rotation = Quaternionf::Identity();
+				Vector3f from;
+				Vector3f to;
+			};
+
+			struct ShapeTransform
+			{
+				Quaternionf rotation = Quaternionf::Identity();
+				Vector3f position;
+			};
+
+			struct StateSnapshot
+			{
+				struct BodyState
+				{
+					Quaternionf rotation;
+					Vector3f angularVelocity;
+					Vector3f linearVelocity;
+					Vector3f position;
+					UInt32 bodyID; //< index and sequence number
+				};
+
+				std::vector<BodyState> activeBodies; //< delta snapshots only
+				std::vector<UInt8> data; //< full snapshots only, serialized physics system state
+				Time timestepAccumulator = Time::Zero();
+				bool isDelta = false; //< only active bodies were captured
+			};
+
+			struct StepStats
+			{
+				std::size_t maxStepCount = 0;
+				std::size_t stepCount = 0; //< number of fixed steps taken
+				std::size_t tempAllocatorOverflowCount = 0; //< temporary allocations which didn't fit in the temp allocator buffer and went to the heap
+				std::size_t tempAllocatorPeakUsage = 0; //< highest temporary memory usage (in bytes), including heap fallbacks
+				Time duration = Time::Zero(); //< real time spent in Step
+				Time remainingTime = Time::Zero(); //< simulation time left for the next calls
+				Time stepSize = Time::Zero();
+				UInt32 activeBodyCount = 0;
+				bool isLagging = false; //< true if the step count limit was reached before catching up with elapsed time
+			};
+
 		private:
 			class BodyActivationListener;
 			friend BodyActivationListener;
@@ -87,6 +171,8 @@ namespace Nz
 			class StepListener;
 			friend StepListener;
 
+			class TempAllocator;
+
 			struct JoltWorld;
 
 			std::shared_ptr<JoltCharacterImpl> GetDefaultCharacterImpl();
@@ -95,8 +181,12 @@ namespace Nz
 			void OnPreStep(float deltatime);
 
 			void RegisterBody(const JPH::BodyID& bodyID, bool activate, bool removeFromDeactivationList);
+			inline void RegisterVirtualCharacter(JoltVirtualCharacter* character);
 
 			void UnregisterBody(const JPH::BodyID& bodyID, bool destroy, bool removeFromRegisterList);
+			inline void UnregisterVirtualCharacter(JoltVirtualCharacter* character);
+
+			void UpdateVirtualCharacters(float elapsedTime);
 
 			std::size_t m_maxStepCount;
 			std::shared_ptr<JoltCharacterImpl> m_defaultCharacterImpl;
@@ -104,6 +194,8 @@ namespace Nz
 			std::unique_ptr<std::uint64_t[]> m_registeredBodies;
 			std::unique_ptr<JoltWorld> m_world;
 			std::vector<JoltPhysicsStepListener*> m_stepListeners;
+			std::vector<JoltVirtualCharacter*> m_virtualCharacters;
+			StepStats m_lastStepStats;
 			Vector3f m_gravity;
 			Time m_stepSize;
 			Time m_timestepAccumulator;
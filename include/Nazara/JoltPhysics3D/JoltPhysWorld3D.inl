@@ -6,6 +6,11 @@
 
 namespace Nz
 {
+	inline auto JoltPhysWorld3D::GetLastStepStats() const -> const StepStats&
+	{
+		return m_lastStepStats;
+	}
+
 	inline bool JoltPhysWorld3D::IsBodyActive(UInt32 bodyIndex) const
 	{
 		UInt32 blockIndex = bodyIndex / 64;
@@ -28,12 +33,25 @@ namespace Nz
 		m_stepListeners.insert(it, stepListener);
 	}
 
+	inline void JoltPhysWorld3D::RegisterVirtualCharacter(JoltVirtualCharacter* character)
+	{
+		auto it = std::lower_bound(m_virtualCharacters.begin(), m_virtualCharacters.end(), character);
+		m_virtualCharacters.insert(it, character);
+	}
+
 	inline void JoltPhysWorld3D::UnregisterStepListener(JoltPhysicsStepListener* stepListener)
 	{
 		auto it = std::lower_bound(m_stepListeners.begin(), m_stepListeners.end(), stepListener);
 		assert(*it == stepListener);
 		m_stepListeners.erase(it);
 	}
+
+	inline void JoltPhysWorld3D::UnregisterVirtualCharacter(JoltVirtualCharacter* character)
+	{
+		auto it = std::lower_bound(m_virtualCharacters.begin(), m_virtualCharacters.end(), character);
+		assert(*it == character);
+		m_virtualCharacters.erase(it);
+	}
 }
 
 #include <Nazara/JoltPhysics3D/DebugOff.hpp>
@@ -10,16 +10,18 @@
 #include <NazaraUtils/Prerequisites.hpp>
 #include <Nazara/Core/Core.hpp>
 #include <Nazara/JoltPhysics3D/Config.hpp>
+#include <filesystem>
 #include <memory>
 
 namespace JPH
 {
 	class JobSystem;
-	class JobSystemThreadPool;
 }
 
 namespace Nz
 {
+	class JoltShapeCache;
+
 	class NAZARA_JOLTPHYSICS3D_API JoltPhysics3D : public ModuleBase<JoltPhysics3D>
 	{
 		friend ModuleBase;
@@ -27,18 +29,27 @@ namespace Nz
 		public:
 			using Dependencies = TypeList<Core>;
 
-			struct Config {};
+			struct Config
+			{
+				std::filesystem::path cookedShapeDirectory; //< if set, cooked mesh and convex hull shapes are stored there and reused by later runs
+			};
 
-			JoltPhysics3D(Config /*config*/);
+			JoltPhysics3D(Config config);
 			~JoltPhysics3D();
 
+			inline JoltShapeCache& GetShapeCache();
 			JPH::JobSystem& GetThreadPool();
 
+			std::size_t PurgeShapeCache();
+
 		private:
-			std::unique_ptr<JPH::JobSystemThreadPool> m_threadPool;
+			std::unique_ptr<JPH::JobSystem> m_jobSystem;
+			std::unique_ptr<JoltShapeCache> m_shapeCache;
 
 			static JoltPhysics3D* s_instance;
 	};
 }
 
+#include <Nazara/JoltPhysics3D/JoltPhysics3D.inl>
+
 #endif // NAZARA_JOLTPHYSICS3D_HPP
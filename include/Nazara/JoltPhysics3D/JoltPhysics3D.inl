@@ -0,0 +1,15 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - JoltPhysics3D module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/JoltPhysics3D/Debug.hpp>
+
+namespace Nz
+{
+	inline JoltShapeCache& JoltPhysics3D::GetShapeCache()
+	{
+		return *m_shapeCache;
+	}
+}
+
+#include <Nazara/JoltPhysics3D/DebugOff.hpp>
@@ -28,6 +28,8 @@ namespace Nz
 
 	class NAZARA_JOLTPHYSICS3D_API JoltRigidBody3D
 	{
+		friend JoltPhysWorld3D;
+
 		public:
 			struct DynamicSettings;
 			struct StaticSettings;
@@ -0,0 +1,92 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - JoltPhysics3D module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_JOLTPHYSICS3D_JOLTVIRTUALCHARACTER_HPP
+#define NAZARA_JOLTPHYSICS3D_JOLTVIRTUALCHARACTER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/JoltPhysics3D/Config.hpp>
+#include <Nazara/Math/Angle.hpp>
+#include <Nazara/Math/Quaternion.hpp>
+#include <Nazara/Math/Vector3.hpp>
+#include <NazaraUtils/MovablePtr.hpp>
+#include <memory>
+
+namespace JPH
+{
+	class CharacterVirtual;
+	class TempAllocator;
+}
+
+namespace Nz
+{
+	class JoltCollider3D;
+	class JoltPhysWorld3D;
+
+	// Character which isn't a physics body, all virtual characters of a world are updated in parallel before each physics step
+	class NAZARA_JOLTPHYSICS3D_API JoltVirtualCharacter
+	{
+		friend JoltPhysWorld3D;
+
+		public:
+			struct Settings;
+
+			JoltVirtualCharacter(JoltPhysWorld3D& physWorld, const Settings& settings);
+			JoltVirtualCharacter(const JoltVirtualCharacter&) = delete;
+			JoltVirtualCharacter(JoltVirtualCharacter&& character) noexcept;
+			~JoltVirtualCharacter();
+
+			inline void DisableGhost();
+			void EnableGhost(bool enable);
+
+			Vector3f GetLinearVelocity() const;
+			Vector3f GetPosition() const;
+			std::pair<Vector3f, Quaternionf> GetPositionAndRotation() const;
+			Quaternionf GetRotation() const;
+			Vector3f GetUp() const;
+
+			inline bool IsGhost() const;
+			bool IsOnGround() const;
+
+			void SetLinearVelocity(const Vector3f& linearVel);
+			void SetRotation(const Quaternionf& rotation);
+			void SetUp(const Vector3f& up);
+
+			void TeleportTo(const Vector3f& position, const Quaternionf& rotation);
+
+			JoltVirtualCharacter& operator=(const JoltVirtualCharacter&) = delete;
+			JoltVirtualCharacter& operator=(JoltVirtualCharacter&& character) noexcept;
+
+			struct Settings
+			{
+				std::shared_ptr<JoltCollider3D> collider;
+				DegreeAnglef maxSlopeAngle = DegreeAnglef(50.f);
+				Quaternionf rotation = Quaternionf::Identity();
+				Vector3f position = Vector3f::Zero();
+				float mass = 70.f;
+				float maxStrength = 100.f; //< maximum force applied to dynamic bodies the character collides with
+				bool isGhost = false; //< ghosts only move by their velocity and don't query the world (for distant characters)
+			};
+
+		protected:
+			JoltVirtualCharacter();
+
+			void Create(JoltPhysWorld3D& physWorld, const Settings& settings);
+			void Destroy();
+
+		private:
+			void Update(float elapsedTime, JPH::TempAllocator& tempAllocator);
+
+			std::shared_ptr<JoltCollider3D> m_collider;
+			std::unique_ptr<JPH::CharacterVirtual> m_character;
+			MovablePtr<JoltPhysWorld3D> m_world;
+			bool m_isGhost;
+	};
+}
+
+#include <Nazara/JoltPhysics3D/JoltVirtualCharacter.inl>
+
+#endif // NAZARA_JOLTPHYSICS3D_JOLTVIRTUALCHARACTER_HPP
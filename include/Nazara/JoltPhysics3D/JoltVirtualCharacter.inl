@@ -0,0 +1,20 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - JoltPhysics3D module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/JoltPhysics3D/Debug.hpp>
+
+namespace Nz
+{
+	inline void JoltVirtualCharacter::DisableGhost()
+	{
+		return EnableGhost(false);
+	}
+
+	inline bool JoltVirtualCharacter::IsGhost() const
+	{
+		return m_isGhost;
+	}
+}
+
+#include <Nazara/JoltPhysics3D/DebugOff.hpp>
@@ -13,6 +13,7 @@
 #include <Nazara/JoltPhysics3D/JoltPhysWorld3D.hpp>
 #include <Nazara/JoltPhysics3D/Components/JoltCharacterComponent.hpp>
 #include <Nazara/JoltPhysics3D/Components/JoltRigidBody3DComponent.hpp>
+#include <Nazara/JoltPhysics3D/Components/JoltVirtualCharacterComponent.hpp>
 #include <NazaraUtils/TypeList.hpp>
 #include <entt/entt.hpp>
 #include <vector>
@@ -22,8 +23,9 @@ namespace Nz
 	class NAZARA_JOLTPHYSICS3D_API JoltPhysics3DSystem
 	{
 		public:
+			static constexpr bool FixedUpdate = true;
 			static constexpr Int64 ExecutionOrder = 0;
-			using Components = TypeList<JoltCharacterComponent, JoltRigidBody3DComponent, class NodeComponent>;
+			using Components = TypeList<JoltCharacterComponent, JoltRigidBody3DComponent, JoltVirtualCharacterComponent, class NodeComponent>;
 
 			struct RaycastHit;
 
@@ -52,15 +54,20 @@ namespace Nz
 		private:
 			void OnBodyConstruct(entt::registry& registry, entt::entity entity);
 			void OnCharacterConstruct(entt::registry& registry, entt::entity entity);
+			void OnVirtualCharacterConstruct(entt::registry& registry, entt::entity entity);
 			void OnBodyDestruct(entt::registry& registry, entt::entity entity);
 
 			std::size_t m_stepCount;
 			std::vector<entt::entity> m_bodyIndicesToEntity;
+			std::vector<JoltPhysWorld3D::ActiveBodyTransform> m_activeBodyTransforms;
+			std::vector<NodeComponent*> m_activeBodyNodes;
 			entt::registry& m_registry;
 			entt::observer m_characterConstructObserver;
 			entt::observer m_rigidBodyConstructObserver;
+			entt::observer m_virtualCharacterConstructObserver;
 			entt::scoped_connection m_bodyConstructConnection;
 			entt::scoped_connection m_characterConstructConnection;
+			entt::scoped_connection m_virtualCharacterConstructConnection;
 			entt::scoped_connection m_bodyDestructConnection;
 			JoltPhysWorld3D m_physWorld;
 	};
@@ -44,6 +44,7 @@
 #include <Nazara/Math/Quaternion.hpp>
 #include <Nazara/Math/Ray.hpp>
 #include <Nazara/Math/Rect.hpp>
+#include <Nazara/Math/Simd.hpp>
 #include <Nazara/Math/Sphere.hpp>
 #include <Nazara/Math/Vector2.hpp>
 #include <Nazara/Math/Vector3.hpp>
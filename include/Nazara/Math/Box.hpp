@@ -87,6 +87,7 @@ namespace Nz
 			static constexpr Box FromExtents(const Vector3<T>& vec1, const Vector3<T>& vec2);
 			static constexpr Box Lerp(const Box& from, const Box& to, T interpolation);
 			static constexpr Box Invalid();
+			static void Transform(const Matrix4<T>& matrix, const Box* boxes, Box* results, std::size_t count, bool applyTranslation = true);
 			static constexpr Box Zero();
 
 			T x, y, z, width, height, depth;
@@ -4,9 +4,11 @@
 
 #include <Nazara/Core/Algorithm.hpp>
 #include <Nazara/Core/StringExt.hpp>
+#include <Nazara/Math/Simd.hpp>
 #include <algorithm>
 #include <cstring>
 #include <sstream>
+#include <type_traits>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -606,11 +608,11 @@ namespace Nz
 		Vector3<T> center = matrix.Transform(GetCenter(), (applyTranslation) ? T(1.0) : T(0.0)); // Value multiplying the translation
 		Vector3<T> halfSize = GetLengths() / T(2.0);
 
-		halfSize = Vector3f(std::abs(matrix(0,0)) * halfSize.x + std::abs(matrix(1,0)) * halfSize.y + std::abs(matrix(2,0)) * halfSize.z,
-		                    std::abs(matrix(0,1)) * halfSize.x + std::abs(matrix(1,1)) * halfSize.y + std::abs(matrix(2,1)) * halfSize.z,
-		                    std::abs(matrix(0,2)) * halfSize.x + std::abs(matrix(1,2)) * halfSize.y + std::abs(matrix(2,2)) * halfSize.z);
+		halfSize = Vector3<T>(std::abs(matrix.m11) * halfSize.x + std::abs(matrix.m21) * halfSize.y + std::abs(matrix.m31) * halfSize.z,
+		                      std::abs(matrix.m12) * halfSize.x + std::abs(matrix.m22) * halfSize.y + std::abs(matrix.m32) * halfSize.z,
+		                      std::abs(matrix.m13) * halfSize.x + std::abs(matrix.m23) * halfSize.y + std::abs(matrix.m33) * halfSize.z);
 
-		return operator=(Boxf::FromExtents(center - halfSize, center + halfSize));
+		return operator=(Box::FromExtents(center - halfSize, center + halfSize));
 	}
 
 	/*!
@@ -729,6 +731,71 @@ namespace Nz
 		return box;
 	}
 
+	/*!
+	* \brief Transforms count boxes according to the matrix
+	*
+	* \param matrix Matrix4 representing the transformation
+	* \param boxes Boxes to transform
+	* \param results Output boxes, results[i] is the box enclosing boxes[i] once transformed, may alias boxes
+	* \param count Number of boxes
+	* \param applyTranslation Should transform the position or the direction
+	*
+	* \remark Boxf uses SIMD instructions where available
+	*
+	* \see Transform
+	*/
+	template<typename T>
+	void Box<T>::Transform(const Matrix4<T>& matrix, const Box* boxes, Box* results, std::size_t count, bool applyTranslation)
+	{
+		NazaraAssert(count == 0 || (boxes && results), "invalid boxes");
+
+#ifdef NAZARA_MATH_SIMD
+		if constexpr (std::is_same_v<T, float>)
+		{
+			Simd::Float4 row1 = Simd::Load(&matrix.m11);
+			Simd::Float4 row2 = Simd::Load(&matrix.m21);
+			Simd::Float4 row3 = Simd::Load(&matrix.m31);
+			Simd::Float4 translation = (applyTranslation) ? Simd::Load(&matrix.m41) : Simd::Splat(0.f);
+
+			Simd::Float4 absRow1 = Simd::Abs(row1);
+			Simd::Float4 absRow2 = Simd::Abs(row2);
+			Simd::Float4 absRow3 = Simd::Abs(row3);
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const Box& box = boxes[i];
+
+				float halfWidth = box.width * 0.5f;
+				float halfHeight = box.height * 0.5f;
+				float halfDepth = box.depth * 0.5f;
+
+				Simd::Float4 center = Simd::MulAdd(Simd::Splat(box.x + halfWidth), row1, translation);
+				center = Simd::MulAdd(Simd::Splat(box.y + halfHeight), row2, center);
+				center = Simd::MulAdd(Simd::Splat(box.z + halfDepth), row3, center);
+
+				Simd::Float4 halfSize = Simd::Mul(Simd::Splat(halfWidth), absRow1);
+				halfSize = Simd::MulAdd(Simd::Splat(halfHeight), absRow2, halfSize);
+				halfSize = Simd::MulAdd(Simd::Splat(halfDepth), absRow3, halfSize);
+
+				alignas(16) float minimum[4];
+				alignas(16) float size[4];
+				Simd::Store(minimum, Simd::Sub(center, halfSize));
+				Simd::Store(size, Simd::Add(halfSize, halfSize));
+
+				results[i] = Box(minimum[0], minimum[1], minimum[2], size[0], size[1], size[2]);
+			}
+		}
+		else
+#endif
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				results[i] = boxes[i];
+				results[i].Transform(matrix, applyTranslation);
+			}
+		}
+	}
+
 	/*!
 	* \brief Shorthand for the box (0, 0, 0, 0, 0, 0)
 	* \return A box with position (0, 0, 0) and lengths (0, 0, 0)
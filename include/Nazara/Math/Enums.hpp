@@ -8,6 +8,7 @@
 #define NAZARA_MATH_ENUMS_HPP
 
 #include <Nazara/Core/Algorithm.hpp>
+#include <NazaraUtils/Flags.hpp>
 
 namespace Nz
 {
@@ -55,6 +56,16 @@ namespace Nz
 		Max = Top
 	};
 
+	template<>
+	struct EnumAsFlags<FrustumPlane>
+	{
+		static constexpr FrustumPlane max = FrustumPlane::Max;
+	};
+
+	using FrustumPlaneFlags = Flags<FrustumPlane>;
+
+	constexpr FrustumPlaneFlags FrustumPlane_All = FrustumPlane::Bottom | FrustumPlane::Far | FrustumPlane::Left | FrustumPlane::Near | FrustumPlane::Right | FrustumPlane::Top;
+
 	constexpr std::size_t FrustumPlaneCount = UnderlyingCast(FrustumPlane::Max) + 1;
 
 	enum class IntersectionSide
@@ -52,6 +52,8 @@ namespace Nz
 
 			constexpr IntersectionSide Intersect(const BoundingVolume<T>& volume) const;
 			constexpr IntersectionSide Intersect(const Box<T>& box) const;
+			constexpr IntersectionSide Intersect(const Box<T>& box, FrustumPlaneFlags* planeMask) const;
+			void Intersect(const Box<T>* boxes, std::size_t boxCount, IntersectionSide* results) const;
 			constexpr IntersectionSide Intersect(const OrientedBox<T>& orientedBox) const;
 			constexpr IntersectionSide Intersect(const Sphere<T>& sphere) const;
 			constexpr IntersectionSide Intersect(const Vector3<T>* points, std::size_t pointCount) const;
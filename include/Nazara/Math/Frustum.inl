@@ -7,9 +7,12 @@
 // http://www.lighthouse3d.com/tutorials/view-frustum-culling/
 
 #include <Nazara/Core/Algorithm.hpp>
+#include <Nazara/Math/Simd.hpp>
 #include <NazaraUtils/EnumArray.hpp>
 #include <cstring>
+#include <limits>
 #include <sstream>
+#include <type_traits>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -164,10 +167,10 @@ namespace Nz
 		for (const auto& plane : m_planes)
 		{
 			Vector3<T> projectedExtents = extents * plane.normal.GetAbs();
-			float radius = projectedExtents.x + projectedExtents.y + projectedExtents.z;
+			T radius = projectedExtents.x + projectedExtents.y + projectedExtents.z;
 
-			float distance = plane.SignedDistance(center);
-			if (distance < T(radius))
+			T distance = plane.SignedDistance(center);
+			if (distance < radius)
 				return false;
 		}
 
@@ -346,19 +349,157 @@ namespace Nz
 		for (const auto& plane : m_planes)
 		{
 			Vector3<T> projectedExtents = extents * plane.normal.GetAbs();
-			float radius = projectedExtents.x + projectedExtents.y + projectedExtents.z;
+			T radius = projectedExtents.x + projectedExtents.y + projectedExtents.z;
 
-			float distance = plane.SignedDistance(center);
+			T distance = plane.SignedDistance(center);
 
-			if (distance < T(-radius))
+			if (distance < -radius)
 				return IntersectionSide::Outside;
-			else if (distance < T(radius))
+			else if (distance < radius)
 				side = IntersectionSide::Intersecting;
 		}
 
 		return side;
 	}
 
+	/*!
+	* \brief Checks whether or not a box intersects with the frustum, skipping planes it is already known to be inside of
+	* \return IntersectionSide How the box is intersecting with the frustum
+	*
+	* \param box Box to check
+	* \param planeMask Planes to test, on return only the planes the box straddles are left
+	*
+	* \remark This is meant for hierarchical culling: a box enclosed in a parent box is inside of every plane its parent is inside of,
+	* so the mask returned for the parent can be used for its children (starting with FrustumPlane_All for the root)
+	* \remark If the box is outside of the frustum, planeMask is left in an undefined state
+	*/
+	template<typename T>
+	constexpr IntersectionSide Frustum<T>::Intersect(const Box<T>& box, FrustumPlaneFlags* planeMask) const
+	{
+		NazaraAssert(planeMask, "invalid plane mask");
+
+		FrustumPlaneFlags remainingPlanes = *planeMask;
+		if (!remainingPlanes)
+			return IntersectionSide::Inside;
+
+		Vector3<T> center = box.GetCenter();
+		Vector3<T> extents = box.GetLengths() * T(0.5);
+
+		for (std::size_t i = 0; i < FrustumPlaneCount; ++i)
+		{
+			FrustumPlane planeIndex = static_cast<FrustumPlane>(i);
+			if (!(remainingPlanes & planeIndex))
+				continue;
+
+			const Plane<T>& plane = m_planes[planeIndex];
+
+			Vector3<T> projectedExtents = extents * plane.normal.GetAbs();
+			T radius = projectedExtents.x + projectedExtents.y + projectedExtents.z;
+
+			T distance = plane.SignedDistance(center);
+			if (distance < -radius)
+				return IntersectionSide::Outside;
+			else if (distance >= radius)
+				remainingPlanes &= ~FrustumPlaneFlags(planeIndex); //< box is inside of this plane, its children too
+		}
+
+		*planeMask = remainingPlanes;
+		return (remainingPlanes) ? IntersectionSide::Intersecting : IntersectionSide::Inside;
+	}
+
+	/*!
+	* \brief Checks how multiple boxes intersect with the frustum
+	*
+	* \param boxes Boxes to check
+	* \param boxCount Number of boxes
+	* \param results Output intersection sides, results[i] is set to the side of boxes[i]
+	*
+	* \remark Frustumf tests every plane at once using SIMD instructions where available
+	*/
+	template<typename T>
+	void Frustum<T>::Intersect(const Box<T>* boxes, std::size_t boxCount, IntersectionSide* results) const
+	{
+		NazaraAssert(boxCount == 0 || (boxes && results), "invalid boxes");
+
+#ifdef NAZARA_MATH_SIMD
+		if constexpr (std::is_same_v<T, float>)
+		{
+			// Planes are stored as structure of arrays and padded to eight with planes every box is inside of
+			alignas(16) float normalX[8], normalY[8], normalZ[8], distances[8];
+			for (std::size_t i = 0; i < 8; ++i)
+			{
+				if (i < FrustumPlaneCount)
+				{
+					const Plane<T>& plane = m_planes[static_cast<FrustumPlane>(i)];
+					normalX[i] = plane.normal.x;
+					normalY[i] = plane.normal.y;
+					normalZ[i] = plane.normal.z;
+					distances[i] = plane.distance;
+				}
+				else
+				{
+					normalX[i] = 0.f;
+					normalY[i] = 0.f;
+					normalZ[i] = 0.f;
+					distances[i] = std::numeric_limits<float>::max();
+				}
+			}
+
+			Simd::Float4 nx[2] = { Simd::Load(&normalX[0]), Simd::Load(&normalX[4]) };
+			Simd::Float4 ny[2] = { Simd::Load(&normalY[0]), Simd::Load(&normalY[4]) };
+			Simd::Float4 nz[2] = { Simd::Load(&normalZ[0]), Simd::Load(&normalZ[4]) };
+			Simd::Float4 d[2] = { Simd::Load(&distances[0]), Simd::Load(&distances[4]) };
+			Simd::Float4 absNx[2] = { Simd::Abs(nx[0]), Simd::Abs(nx[1]) };
+			Simd::Float4 absNy[2] = { Simd::Abs(ny[0]), Simd::Abs(ny[1]) };
+			Simd::Float4 absNz[2] = { Simd::Abs(nz[0]), Simd::Abs(nz[1]) };
+
+			for (std::size_t i = 0; i < boxCount; ++i)
+			{
+				const Box<T>& box = boxes[i];
+
+				float extentX = box.width * 0.5f;
+				float extentY = box.height * 0.5f;
+				float extentZ = box.depth * 0.5f;
+
+				Simd::Float4 cx = Simd::Splat(box.x + extentX);
+				Simd::Float4 cy = Simd::Splat(box.y + extentY);
+				Simd::Float4 cz = Simd::Splat(box.z + extentZ);
+				Simd::Float4 ex = Simd::Splat(extentX);
+				Simd::Float4 ey = Simd::Splat(extentY);
+				Simd::Float4 ez = Simd::Splat(extentZ);
+
+				Simd::Mask4 outside[2];
+				Simd::Mask4 intersecting[2];
+				for (std::size_t j = 0; j < 2; ++j)
+				{
+					Simd::Float4 distance = Simd::MulAdd(cx, nx[j], d[j]);
+					distance = Simd::MulAdd(cy, ny[j], distance);
+					distance = Simd::MulAdd(cz, nz[j], distance);
+
+					Simd::Float4 radius = Simd::Mul(ex, absNx[j]);
+					radius = Simd::MulAdd(ey, absNy[j], radius);
+					radius = Simd::MulAdd(ez, absNz[j], radius);
+
+					outside[j] = Simd::Less(distance, Simd::Negate(radius));
+					intersecting[j] = Simd::Less(distance, radius);
+				}
+
+				if (Simd::Any(Simd::Or(outside[0], outside[1])))
+					results[i] = IntersectionSide::Outside;
+				else if (Simd::Any(Simd::Or(intersecting[0], intersecting[1])))
+					results[i] = IntersectionSide::Intersecting;
+				else
+					results[i] = IntersectionSide::Inside;
+			}
+		}
+		else
+#endif
+		{
+			for (std::size_t i = 0; i < boxCount; ++i)
+				results[i] = Intersect(boxes[i]);
+		}
+	}
+
 	/*!
 	* \brief Checks whether or not an oriented box intersects with the frustum
 	* \return IntersectionSide How the oriented box is intersecting with the frustum
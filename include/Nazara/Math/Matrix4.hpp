@@ -79,6 +79,8 @@ namespace Nz
 			constexpr Vector2<T> Transform(const Vector2<T>& vector, T z = 0.0, T w = 1.0) const;
 			constexpr Vector3<T> Transform(const Vector3<T>& vector, T w = 1.0) const;
 			constexpr Vector4<T> Transform(const Vector4<T>& vector) const;
+			void Transform(const Vector3<T>* vectors, Vector3<T>* results, std::size_t count, T w = 1.0) const;
+			void Transform(const Vector4<T>* vectors, Vector4<T>* results, std::size_t count) const;
 
 			constexpr Matrix4& Transpose();
 
@@ -105,7 +107,9 @@ namespace Nz
 
 			static constexpr bool ApproxEqual(const Matrix4& lhs, const Matrix4& rhs, T maxDifference = std::numeric_limits<T>::epsilon());
 			static constexpr Matrix4 Concatenate(const Matrix4& left, const Matrix4& right);
+			static void Concatenate(const Matrix4* left, const Matrix4* right, Matrix4* results, std::size_t count);
 			static constexpr Matrix4 ConcatenateTransform(const Matrix4& left, const Matrix4& right);
+			static void ConcatenateTransform(const Matrix4* left, const Matrix4* right, Matrix4* results, std::size_t count);
 			static constexpr Matrix4 Identity();
 			static constexpr Matrix4 LookAt(const Vector3<T>& eye, const Vector3<T>& target, const Vector3<T>& up = Vector3<T>::Up());
 			static constexpr Matrix4 Ortho(T left, T right, T top, T bottom, T zNear = -1.0, T zFar = 1.0);
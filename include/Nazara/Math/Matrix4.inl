@@ -8,6 +8,7 @@
 #include <Nazara/Math/Config.hpp>
 #include <Nazara/Math/EulerAngles.hpp>
 #include <Nazara/Math/Quaternion.hpp>
+#include <Nazara/Math/Simd.hpp>
 #include <Nazara/Math/Vector2.hpp>
 #include <Nazara/Math/Vector3.hpp>
 #include <Nazara/Math/Vector4.hpp>
@@ -15,6 +16,7 @@
 #include <limits>
 #include <sstream>
 #include <stdexcept>
+#include <type_traits>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -931,6 +933,94 @@ namespace Nz
 		                  m14 * vector.x + m24 * vector.y + m34 * vector.z + m44 * vector.w);
 	}
 
+	/*!
+	* \brief Transforms count Vector3 by the matrix
+	*
+	* \param vectors Vectors to transform
+	* \param results Output vectors, may alias vectors
+	* \param count Number of vectors
+	* \param w The value of the fourth component of every vector, 1.0 to transform points and 0.0 to transform directions
+	*
+	* \remark Matrix4f uses SIMD instructions where available
+	*/
+	template<typename T>
+	void Matrix4<T>::Transform(const Vector3<T>* vectors, Vector3<T>* results, std::size_t count, T w) const
+	{
+		NazaraAssert(count == 0 || (vectors && results), "invalid vectors");
+
+#ifdef NAZARA_MATH_SIMD
+		if constexpr (std::is_same_v<T, float>)
+		{
+			Simd::Float4 row1 = Simd::Load(&m11);
+			Simd::Float4 row2 = Simd::Load(&m21);
+			Simd::Float4 row3 = Simd::Load(&m31);
+			Simd::Float4 translation = Simd::Mul(Simd::Load(&m41), Simd::Splat(w));
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const Vector3<T>& vector = vectors[i];
+
+				Simd::Float4 result = Simd::MulAdd(Simd::Splat(vector.x), row1, translation);
+				result = Simd::MulAdd(Simd::Splat(vector.y), row2, result);
+				result = Simd::MulAdd(Simd::Splat(vector.z), row3, result);
+
+				// Vector3 is only three floats wide
+				alignas(16) float output[4];
+				Simd::Store(output, result);
+
+				results[i] = Vector3<T>(output[0], output[1], output[2]);
+			}
+		}
+		else
+#endif
+		{
+			for (std::size_t i = 0; i < count; ++i)
+				results[i] = Transform(vectors[i], w);
+		}
+	}
+
+	/*!
+	* \brief Transforms count Vector4 by the matrix
+	*
+	* \param vectors Vectors to transform
+	* \param results Output vectors, may alias vectors
+	* \param count Number of vectors
+	*
+	* \remark Matrix4f uses SIMD instructions where available
+	*/
+	template<typename T>
+	void Matrix4<T>::Transform(const Vector4<T>* vectors, Vector4<T>* results, std::size_t count) const
+	{
+		NazaraAssert(count == 0 || (vectors && results), "invalid vectors");
+
+#ifdef NAZARA_MATH_SIMD
+		if constexpr (std::is_same_v<T, float>)
+		{
+			Simd::Float4 row1 = Simd::Load(&m11);
+			Simd::Float4 row2 = Simd::Load(&m21);
+			Simd::Float4 row3 = Simd::Load(&m31);
+			Simd::Float4 row4 = Simd::Load(&m41);
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const Vector4<T>& vector = vectors[i];
+
+				Simd::Float4 result = Simd::Mul(Simd::Splat(vector.x), row1);
+				result = Simd::MulAdd(Simd::Splat(vector.y), row2, result);
+				result = Simd::MulAdd(Simd::Splat(vector.z), row3, result);
+				result = Simd::MulAdd(Simd::Splat(vector.w), row4, result);
+
+				Simd::Store(&results[i].x, result);
+			}
+		}
+		else
+#endif
+		{
+			for (std::size_t i = 0; i < count; ++i)
+				results[i] = Transform(vectors[i]);
+		}
+	}
+
 	/*!
 	* \brief Transposes the matrix
 	* \return A reference to this matrix transposed
@@ -1172,6 +1262,117 @@ namespace Nz
 		return matrix;
 	}
 
+	/*!
+	* \brief Concatenates count pairs of matrices
+	*
+	* \param left Left-hand side matrices
+	* \param right Right-hand side matrices
+	* \param results Output matrices, results[i] is set to the product of left[i] and right[i]
+	* \param count Number of matrix pairs
+	*
+	* \remark results may alias left or right
+	* \remark Matrix4f uses SIMD instructions where available
+	*
+	* \see ConcatenateTransform
+	*/
+	template<typename T>
+	void Matrix4<T>::Concatenate(const Matrix4* left, const Matrix4* right, Matrix4* results, std::size_t count)
+	{
+		NazaraAssert(count == 0 || (left && right && results), "invalid matrices");
+
+#ifdef NAZARA_MATH_SIMD
+		if constexpr (std::is_same_v<T, float>)
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const float* lhs = &left[i].m11;
+				const float* rhs = &right[i].m11;
+
+				// Every row of the product is a linear combination of the rows of the right-hand side matrix
+				Simd::Float4 rhsRows[4] = { Simd::Load(&rhs[0]), Simd::Load(&rhs[4]), Simd::Load(&rhs[8]), Simd::Load(&rhs[12]) };
+
+				Simd::Float4 rows[4];
+				for (std::size_t row = 0; row < 4; ++row)
+				{
+					const float* lhsRow = &lhs[row * 4];
+
+					Simd::Float4 result = Simd::Mul(Simd::Splat(lhsRow[0]), rhsRows[0]);
+					result = Simd::MulAdd(Simd::Splat(lhsRow[1]), rhsRows[1], result);
+					result = Simd::MulAdd(Simd::Splat(lhsRow[2]), rhsRows[2], result);
+					rows[row] = Simd::MulAdd(Simd::Splat(lhsRow[3]), rhsRows[3], result);
+				}
+
+				float* output = &results[i].m11;
+				for (std::size_t row = 0; row < 4; ++row)
+					Simd::Store(&output[row * 4], rows[row]);
+			}
+		}
+		else
+#endif
+		{
+			for (std::size_t i = 0; i < count; ++i)
+				results[i] = Concatenate(left[i], right[i]);
+		}
+	}
+
+	/*!
+	* \brief Concatenates count pairs of affine matrices
+	*
+	* \param left Left-hand side matrices
+	* \param right Right-hand side matrices
+	* \param results Output matrices, results[i] is set to the product of left[i] and right[i]
+	* \param count Number of matrix pairs
+	*
+	* \remark results may alias left or right
+	* \remark Matrix4f uses SIMD instructions where available
+	*
+	* \see Concatenate
+	*/
+	template<typename T>
+	void Matrix4<T>::ConcatenateTransform(const Matrix4* left, const Matrix4* right, Matrix4* results, std::size_t count)
+	{
+		NazaraAssert(count == 0 || (left && right && results), "invalid matrices");
+
+#ifdef NAZARA_MATH_SIMD
+		if constexpr (std::is_same_v<T, float>)
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const float* lhs = &left[i].m11;
+				const float* rhs = &right[i].m11;
+
+				Simd::Float4 rhsRows[4] = { Simd::Load(&rhs[0]), Simd::Load(&rhs[4]), Simd::Load(&rhs[8]), Simd::Load(&rhs[12]) };
+
+				Simd::Float4 rows[4];
+				for (std::size_t row = 0; row < 4; ++row)
+				{
+					const float* lhsRow = &lhs[row * 4];
+
+					Simd::Float4 result = Simd::Mul(Simd::Splat(lhsRow[0]), rhsRows[0]);
+					result = Simd::MulAdd(Simd::Splat(lhsRow[1]), rhsRows[1], result);
+					rows[row] = Simd::MulAdd(Simd::Splat(lhsRow[2]), rhsRows[2], result);
+				}
+				rows[3] = Simd::Add(rows[3], rhsRows[3]); //< translation
+
+				Matrix4& output = results[i];
+				for (std::size_t row = 0; row < 4; ++row)
+					Simd::Store(&output.m11 + row * 4, rows[row]);
+
+				// Last column is (0, 0, 0, 1) by definition
+				output.m14 = 0.f;
+				output.m24 = 0.f;
+				output.m34 = 0.f;
+				output.m44 = 1.f;
+			}
+		}
+		else
+#endif
+		{
+			for (std::size_t i = 0; i < count; ++i)
+				results[i] = ConcatenateTransform(left[i], right[i]);
+		}
+	}
+
 	/*!
 	* \brief Shorthand for the identity matrix
 	* \return A Matrix4 which is the identity matrix
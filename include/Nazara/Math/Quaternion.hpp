@@ -83,6 +83,7 @@ namespace Nz
 			static Quaternion RotationBetween(const Vector3<T>& from, const Vector3<T>& to);
 			static Quaternion Mirror(Quaternion quat, const Vector3<T>& axis);
 			static Quaternion Slerp(const Quaternion& from, const Quaternion& to, T interpolation);
+			static void Slerp(const Quaternion* from, const Quaternion* to, T interpolation, Quaternion* results, std::size_t count);
 			static constexpr Quaternion Zero();
 
 			T w, x, y, z;
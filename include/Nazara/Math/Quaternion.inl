@@ -5,10 +5,12 @@
 #include <Nazara/Core/Algorithm.hpp>
 #include <Nazara/Math/Config.hpp>
 #include <Nazara/Math/EulerAngles.hpp>
+#include <Nazara/Math/Simd.hpp>
 #include <Nazara/Math/Vector3.hpp>
 #include <cstring>
 #include <limits>
 #include <sstream>
+#include <type_traits>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -749,6 +751,70 @@ namespace Nz
 		return result += q * k1;
 	}
 
+	/*!
+	* \brief Interpolates spherically count pairs of quaternions with the same factor of interpolation
+	*
+	* \param from Initial quaternions
+	* \param to Target quaternions
+	* \param interpolation Factor of interpolation
+	* \param results Output quaternions, results[i] is the interpolation between from[i] and to[i], may alias from or to
+	* \param count Number of quaternion pairs
+	*
+	* \remark Quaternionf uses SIMD instructions where available
+	*
+	* \see Slerp
+	*/
+	template<typename T>
+	void Quaternion<T>::Slerp(const Quaternion* from, const Quaternion* to, T interpolation, Quaternion* results, std::size_t count)
+	{
+		NazaraAssert(count == 0 || (from && to && results), "invalid quaternions");
+
+#ifdef NAZARA_MATH_SIMD
+		if constexpr (std::is_same_v<T, float>)
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				Simd::Float4 fromQuat = Simd::Load(&from[i].w);
+				Simd::Float4 toQuat = Simd::Load(&to[i].w);
+
+				float cosOmega = Simd::HorizontalSum(Simd::Mul(fromQuat, toQuat));
+				float sign = 1.f;
+				if (cosOmega < 0.f)
+				{
+					// Take the shortest path
+					cosOmega = -cosOmega;
+					sign = -1.f;
+				}
+
+				float k0, k1;
+				if (cosOmega > 0.9999f)
+				{
+					// Linear interpolation to avoid division by zero
+					k0 = 1.f - interpolation;
+					k1 = interpolation;
+				}
+				else
+				{
+					float sinOmega = std::sqrt(1.f - cosOmega * cosOmega);
+					float omega = std::atan2(sinOmega, cosOmega);
+					float invSinOmega = 1.f / sinOmega;
+
+					k0 = std::sin((1.f - interpolation) * omega) * invSinOmega;
+					k1 = std::sin(interpolation * omega) * invSinOmega;
+				}
+
+				Simd::Float4 result = Simd::MulAdd(toQuat, Simd::Splat(sign * k1), Simd::Mul(fromQuat, Simd::Splat(k0)));
+				Simd::Store(&results[i].w, result);
+			}
+		}
+		else
+#endif
+		{
+			for (std::size_t i = 0; i < count; ++i)
+				results[i] = Slerp(from[i], to[i], interpolation);
+		}
+	}
+
 	/*!
 	* \brief Shorthand for the quaternion (0, 0, 0, 0)
 	* \return A quaternion with components (0, 0, 0, 0)
@@ -0,0 +1,54 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Math module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_MATH_SIMD_HPP
+#define NAZARA_MATH_SIMD_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+
+#if defined(NAZARA_ARCH_x86_64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NAZARA_MATH_SIMD
+#define NAZARA_MATH_SIMD_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define NAZARA_MATH_SIMD
+#define NAZARA_MATH_SIMD_NEON
+#endif
+
+#ifdef NAZARA_MATH_SIMD
+
+// Thin wrappers over four-float registers, used by the batch functions of the math classes (float specializations)
+namespace Nz::Simd
+{
+#if defined(NAZARA_MATH_SIMD_SSE2)
+	using Float4 = __m128;
+	using Mask4 = __m128;
+#else
+	using Float4 = float32x4_t;
+	using Mask4 = uint32x4_t;
+#endif
+
+	inline Float4 Abs(Float4 value);
+	inline Float4 Add(Float4 lhs, Float4 rhs);
+	inline bool Any(Mask4 mask);
+	inline float HorizontalSum(Float4 value);
+	inline Mask4 Less(Float4 lhs, Float4 rhs);
+	inline Float4 Load(const float* values);
+	inline Float4 Mul(Float4 lhs, Float4 rhs);
+	inline Float4 MulAdd(Float4 lhs, Float4 rhs, Float4 addend);
+	inline Float4 Negate(Float4 value);
+	inline Mask4 Or(Mask4 lhs, Mask4 rhs);
+	inline Float4 Splat(float value);
+	inline void Store(float* values, Float4 value);
+	inline Float4 Sub(Float4 lhs, Float4 rhs);
+}
+
+#include <Nazara/Math/Simd.inl>
+
+#endif
+
+#endif // NAZARA_MATH_SIMD_HPP
@@ -0,0 +1,156 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Math module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz::Simd
+{
+	/*!
+	* \brief Computes the absolute value of every lane
+	*/
+	inline Float4 Abs(Float4 value)
+	{
+#if defined(NAZARA_MATH_SIMD_SSE2)
+		return _mm_andnot_ps(_mm_set1_ps(-0.f), value);
+#else
+		return vabsq_f32(value);
+#endif
+	}
+
+	inline Float4 Add(Float4 lhs, Float4 rhs)
+	{
+#if defined(NAZARA_MATH_SIMD_SSE2)
+		return _mm_add_ps(lhs, rhs);
+#else
+		return vaddq_f32(lhs, rhs);
+#endif
+	}
+
+	/*!
+	* \brief Checks if at least one lane of the mask is set
+	*/
+	inline bool Any(Mask4 mask)
+	{
+#if defined(NAZARA_MATH_SIMD_SSE2)
+		return _mm_movemask_ps(mask) != 0;
+#else
+		uint32x2_t lanes = vorr_u32(vget_low_u32(mask), vget_high_u32(mask));
+		return (vget_lane_u32(lanes, 0) | vget_lane_u32(lanes, 1)) != 0;
+#endif
+	}
+
+	/*!
+	* \brief Sums the four lanes of a register
+	*/
+	inline float HorizontalSum(Float4 value)
+	{
+#if defined(NAZARA_MATH_SIMD_SSE2)
+		__m128 shuffled = _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1)); //< (y, x, w, z)
+		__m128 sums = _mm_add_ps(value, shuffled);                                //< (x+y, x+y, z+w, z+w)
+		shuffled = _mm_movehl_ps(shuffled, sums);                                 //< (z+w, z+w, ...)
+		return _mm_cvtss_f32(_mm_add_ss(sums, shuffled));
+#else
+		float32x2_t sums = vadd_f32(vget_low_f32(value), vget_high_f32(value));
+		return vget_lane_f32(vpadd_f32(sums, sums), 0);
+#endif
+	}
+
+	/*!
+	* \brief Returns a mask with every lane where lhs < rhs set
+	*/
+	inline Mask4 Less(Float4 lhs, Float4 rhs)
+	{
+#if defined(NAZARA_MATH_SIMD_SSE2)
+		return _mm_cmplt_ps(lhs, rhs);
+#else
+		return vcltq_f32(lhs, rhs);
+#endif
+	}
+
+	/*!
+	* \brief Loads four floats, which don't have to be aligned
+	*/
+	inline Float4 Load(const float* values)
+	{
+#if defined(NAZARA_MATH_SIMD_SSE2)
+		return _mm_loadu_ps(values);
+#else
+		return vld1q_f32(values);
+#endif
+	}
+
+	inline Float4 Mul(Float4 lhs, Float4 rhs)
+	{
+#if defined(NAZARA_MATH_SIMD_SSE2)
+		return _mm_mul_ps(lhs, rhs);
+#else
+		return vmulq_f32(lhs, rhs);
+#endif
+	}
+
+	/*!
+	* \brief Computes lhs * rhs + addend
+	*/
+	inline Float4 MulAdd(Float4 lhs, Float4 rhs, Float4 addend)
+	{
+#if defined(NAZARA_MATH_SIMD_SSE2)
+		return _mm_add_ps(_mm_mul_ps(lhs, rhs), addend);
+#else
+		return vmlaq_f32(addend, lhs, rhs);
+#endif
+	}
+
+	inline Float4 Negate(Float4 value)
+	{
+#if defined(NAZARA_MATH_SIMD_SSE2)
+		return _mm_xor_ps(value, _mm_set1_ps(-0.f));
+#else
+		return vnegq_f32(value);
+#endif
+	}
+
+	inline Mask4 Or(Mask4 lhs, Mask4 rhs)
+	{
+#if defined(NAZARA_MATH_SIMD_SSE2)
+		return _mm_or_ps(lhs, rhs);
+#else
+		return vorrq_u32(lhs, rhs);
+#endif
+	}
+
+	/*!
+	* \brief Returns a register with value in every lane
+	*/
+	inline Float4 Splat(float value)
+	{
+#if defined(NAZARA_MATH_SIMD_SSE2)
+		return _mm_set1_ps(value);
+#else
+		return vdupq_n_f32(value);
+#endif
+	}
+
+	/*!
+	* \brief Stores four floats, which don't have to be aligned
+	*/
+	inline void Store(float* values, Float4 value)
+	{
+#if defined(NAZARA_MATH_SIMD_SSE2)
+		_mm_storeu_ps(values, value);
+#else
+		vst1q_f32(values, value);
+#endif
+	}
+
+	inline Float4 Sub(Float4 lhs, Float4 rhs)
+	{
+#if defined(NAZARA_MATH_SIMD_SSE2)
+		return _mm_sub_ps(lhs, rhs);
+#else
+		return vsubq_f32(lhs, rhs);
+#endif
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
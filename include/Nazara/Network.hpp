@@ -34,19 +34,28 @@
 #include <Nazara/Network/Config.hpp>
 #include <Nazara/Network/ENetCompressor.hpp>
 #include <Nazara/Network/ENetHost.hpp>
+#include <Nazara/Network/ENetLz4Compressor.hpp>
 #include <Nazara/Network/ENetPacket.hpp>
 #include <Nazara/Network/ENetPeer.hpp>
 #include <Nazara/Network/ENetProtocol.hpp>
+#include <Nazara/Network/ENetShardedHost.hpp>
+#include <Nazara/Network/ENetZstdCompressor.hpp>
 #include <Nazara/Network/Enums.hpp>
 #include <Nazara/Network/IpAddress.hpp>
 #include <Nazara/Network/NetBuffer.hpp>
+#include <Nazara/Network/NetDatagram.hpp>
 #include <Nazara/Network/NetPacket.hpp>
 #include <Nazara/Network/Network.hpp>
+#include <Nazara/Network/SnapshotReceiver.hpp>
+#include <Nazara/Network/SnapshotReplicator.hpp>
+#include <Nazara/Network/SnapshotSchema.hpp>
+#include <Nazara/Network/SocketCompletionQueue.hpp>
 #include <Nazara/Network/SocketHandle.hpp>
 #include <Nazara/Network/SocketPoller.hpp>
 #include <Nazara/Network/TcpClient.hpp>
 #include <Nazara/Network/TcpServer.hpp>
 #include <Nazara/Network/UdpSocket.hpp>
+#include <Nazara/Network/WebCache.hpp>
 #include <Nazara/Network/WebRequest.hpp>
 #include <Nazara/Network/WebRequestResult.hpp>
 #include <Nazara/Network/WebService.hpp>
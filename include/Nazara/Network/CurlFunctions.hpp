@@ -15,6 +15,7 @@
 NAZARA_CURL_FUNCTION(easy_cleanup)
 NAZARA_CURL_FUNCTION(easy_getinfo)
 NAZARA_CURL_FUNCTION(easy_init)
+NAZARA_CURL_FUNCTION(easy_pause)
 NAZARA_CURL_FUNCTION(easy_setopt)
 NAZARA_CURL_FUNCTION(easy_strerror)
 NAZARA_CURL_FUNCTION(global_cleanup)
@@ -25,6 +26,7 @@ NAZARA_CURL_FUNCTION(multi_info_read)
 NAZARA_CURL_FUNCTION(multi_init)
 NAZARA_CURL_FUNCTION(multi_perform)
 NAZARA_CURL_FUNCTION(multi_remove_handle)
+NAZARA_CURL_FUNCTION(multi_setopt)
 NAZARA_CURL_FUNCTION(multi_strerror)
 NAZARA_CURL_FUNCTION(slist_append)
 NAZARA_CURL_FUNCTION(slist_free_all)
@@ -19,11 +19,14 @@
 
 #include <NazaraUtils/Prerequisites.hpp>
 #include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/MemoryTracker.hpp>
+#include <Nazara/Core/TimerWheel.hpp>
 #include <Nazara/Network/ENetCompressor.hpp>
 #include <Nazara/Network/ENetPeer.hpp>
 #include <Nazara/Network/ENetProtocol.hpp>
 #include <Nazara/Network/IpAddress.hpp>
 #include <Nazara/Network/NetBuffer.hpp>
+#include <Nazara/Network/NetDatagram.hpp>
 #include <Nazara/Network/NetPacket.hpp>
 #include <Nazara/Network/SocketPoller.hpp>
 #include <Nazara/Network/UdpSocket.hpp>
@@ -46,10 +49,12 @@ namespace Nz
 
 			ENetPacketRef AllocatePacket(ENetPacketFlags flags);
 			inline ENetPacketRef AllocatePacket(ENetPacketFlags flags, NetPacket&& data);
+			inline ENetPacketRef AllocatePacket(ENetPacketFlags flags, UInt16 netCode, std::size_t minCapacity = 0);
 
 			inline void AllowsIncomingConnections(bool allow = true);
 
-			void Broadcast(UInt8 channelId, ENetPacketFlags flags, NetPacket&& packet);
+			void Broadcast(UInt8 channelId, const ENetPacketRef& packetRef);
+			inline void Broadcast(UInt8 channelId, ENetPacketFlags flags, NetPacket&& packet);
 
 			bool CheckEvents(ENetEvent* event);
 
@@ -63,9 +68,13 @@ namespace Nz
 
 			inline bool DoesAllowIncomingConnections() const;
 
+			inline void EnablePortReuse(bool reusePort = true);
+
 			void Flush();
 
 			inline IpAddress GetBoundAddress() const;
+			inline std::size_t GetDatagramBatchSize() const;
+			inline ENetPeer* GetPeer(UInt16 peerId);
 			inline UInt32 GetServiceTime() const;
 			inline UInt32 GetTotalReceivedPackets() const;
 			inline UInt64 GetTotalReceivedData() const;
@@ -75,6 +84,7 @@ namespace Nz
 			int Service(ENetEvent* event, UInt32 timeout);
 
 			inline void SetCompressor(std::unique_ptr<ENetCompressor>&& compressor);
+			inline void SetDatagramBatchSize(std::size_t batchSize);
 
 			void SimulateNetwork(double packetLossProbability, UInt16 minDelay, UInt16 maxDelay);
 
@@ -84,22 +94,31 @@ namespace Nz
 		private:
 			bool InitSocket(const IpAddress& address);
 
+			NetDatagram& AllocateOutgoingDatagram(ENetPeer* peer);
+
+			void AddToActivePeers(ENetPeer* peer);
 			void AddToDispatchQueue(ENetPeer* peer);
+			void RemoveFromActivePeers(ENetPeer* peer);
 			void RemoveFromDispatchQueue(ENetPeer* peer);
 
 			bool DispatchIncomingCommands(ENetEvent* event);
 
+			inline bool FitsInDatagram(const ENetPeer& peer, std::size_t size) const;
+
 			ENetPeer* HandleConnect(ENetProtocolHeader* header, ENetProtocol* command);
 			bool HandleIncomingCommands(ENetEvent* event);
 
 			int ReceiveIncomingCommands(ENetEvent* event);
+			bool ReceiveIncomingDatagrams();
 
 			void NotifyConnect(ENetPeer* peer, ENetEvent* event, bool incoming);
 			void NotifyDisconnect(ENetPeer*, ENetEvent* event, bool timeout);
 
 			void SendAcknowledgements(ENetPeer* peer);
+			void SendMtuProbe(ENetPeer* peer, UInt32 probeSize);
 			bool SendReliableOutgoingCommands(ENetPeer* peer);
 			int SendOutgoingCommands(ENetEvent* event, bool checkForTimeouts);
+			int SendOutgoingDatagrams(ENetEvent* event);
 			void SendUnreliableOutgoingCommands(ENetPeer* peer);
 
 			void ThrottleBandwidth();
@@ -132,23 +151,34 @@ namespace Nz
 			std::size_t m_bufferCount;
 			std::size_t m_channelLimit;
 			std::size_t m_commandCount;
+			std::size_t m_datagramBatchSize;
 			std::size_t m_duplicatePeers;
+			std::size_t m_incomingDatagramCount;
+			std::size_t m_incomingDatagramIndex;
 			std::size_t m_maximumPacketSize;
 			std::size_t m_maximumWaitingData;
+			std::size_t m_outgoingDatagramCount;
 			std::size_t m_packetSize;
 			std::size_t m_peerCount;
 			std::size_t m_receivedDataLength;
 			std::uniform_int_distribution<UInt16> m_packetDelayDistribution;
 			std::unique_ptr<ENetCompressor> m_compressor;
-			std::vector<ENetPeer> m_peers;
+			std::vector<ENetPeer, TrackedAllocator<ENetPeer, MemoryTag::Network>> m_peers;
+			std::vector<ENetPeer*> m_outgoingDatagramPeers;
+			std::vector<NetDatagram> m_incomingDatagrams;
+			std::vector<NetDatagram> m_outgoingDatagrams;
+			std::vector<UInt8> m_incomingDatagramData;
+			std::vector<UInt8> m_outgoingDatagramData;
 			std::vector<PendingIncomingPacket> m_pendingIncomingPackets;
 			std::vector<PendingOutgoingPacket> m_pendingOutgoingPackets;
 			MovablePtr<UInt8> m_receivedData;
+			Bitset<UInt64> m_activePeers; //< peers with pending outgoing commands or an expired timer
 			Bitset<UInt64> m_dispatchQueue;
 			MemoryPool<ENetPacket> m_packetPool;
 			IpAddress m_address;
 			IpAddress m_receivedAddress;
 			SocketPoller m_poller;
+			TimerWheel m_peerTimers; //< next retransmission timeout or ping of every peer
 			UdpSocket m_socket;
 			UInt16 m_headerFlags;
 			UInt32 m_bandwidthThrottleEpoch;
@@ -164,6 +194,7 @@ namespace Nz
 			UInt64 m_totalReceivedData;
 			bool m_allowsIncomingConnections;
 			bool m_continueSending;
+			bool m_isReusingPort;
 			bool m_isUsingDualStack;
 			bool m_isSimulationEnabled;
 			bool m_recalculateBandwidthLimits;
@@ -8,7 +8,12 @@
 namespace Nz
 {
 	inline ENetHost::ENetHost() :
+	m_datagramBatchSize(ENetConstants::ENetHost_DefaultDatagramBatchSize),
+	m_incomingDatagramCount(0),
+	m_incomingDatagramIndex(0),
+	m_outgoingDatagramCount(0),
 	m_packetPool(sizeof(ENetPacket)),
+	m_isReusingPort(false),
 	m_isUsingDualStack(false),
 	m_isSimulationEnabled(false)
 	{
@@ -27,6 +32,25 @@ namespace Nz
 		return ref;
 	}
 
+	/*!
+	* \brief Allocates a packet from the host pool, ready to be serialized into
+	* \return Reference to the allocated packet
+	*
+	* Serializing directly into the pooled packet (through its data member) and sending the reference to
+	* one or multiple peers avoids any copy of the payload, the buffer returns to the pool once every peer is done with it.
+	*
+	* \param flags Packet flags
+	* \param netCode Packet number
+	* \param minCapacity Capacity to reserve for the payload
+	*/
+	inline ENetPacketRef ENetHost::AllocatePacket(ENetPacketFlags flags, UInt16 netCode, std::size_t minCapacity)
+	{
+		ENetPacketRef ref = AllocatePacket(flags);
+		ref->data.Reset(netCode, minCapacity);
+
+		return ref;
+	}
+
 	inline void ENetHost::AllowsIncomingConnections(bool allow)
 	{
 		NazaraAssert(m_address.IsValid() && !m_address.IsLoopback(), "Only server hosts can allow incoming connections");
@@ -34,6 +58,11 @@ namespace Nz
 		m_allowsIncomingConnections = allow;
 	}
 
+	inline void ENetHost::Broadcast(UInt8 channelId, ENetPacketFlags flags, NetPacket&& packet)
+	{
+		Broadcast(channelId, AllocatePacket(flags, std::move(packet)));
+	}
+
 	inline bool ENetHost::Create(NetProtocol protocol, UInt16 port, std::size_t peerCount, std::size_t channelCount)
 	{
 		NazaraAssert(protocol != NetProtocol::Unknown, "Invalid protocol");
@@ -73,11 +102,34 @@ namespace Nz
 		return m_allowsIncomingConnections;
 	}
 
+	/*!
+	* \brief Allows other hosts to bind the same port, incoming datagrams being balanced between them by the system
+	*
+	* \param reusePort Should the port be reusable
+	*
+	* \remark This must be called before Create
+	* \remark A host is created successfully only if the platform supports it (see UdpSocket::EnablePortReuse)
+	*/
+	inline void ENetHost::EnablePortReuse(bool reusePort)
+	{
+		m_isReusingPort = reusePort;
+	}
+
 	inline IpAddress ENetHost::GetBoundAddress() const
 	{
 		return m_address;
 	}
 
+	inline std::size_t ENetHost::GetDatagramBatchSize() const
+	{
+		return m_datagramBatchSize;
+	}
+
+	inline ENetPeer* ENetHost::GetPeer(UInt16 peerId)
+	{
+		return (peerId < m_peers.size()) ? &m_peers[peerId] : nullptr;
+	}
+
 	inline UInt32 ENetHost::GetServiceTime() const
 	{
 		return m_serviceTime;
@@ -108,6 +160,28 @@ namespace Nz
 		m_compressor = std::move(compressor);
 	}
 
+	/*!
+	* \brief Sets the maximum number of datagrams received or sent per socket call
+	*
+	* \param batchSize Number of datagrams per batch, one means datagrams are received and sent one by one
+	*
+	* \remark Each datagram of a batch uses a buffer of ENetProtocol_MaximumMTU bytes, for both receiving and sending
+	* \remark The new size is applied once every datagram of the current receive batch has been processed
+	*/
+	inline void ENetHost::SetDatagramBatchSize(std::size_t batchSize)
+	{
+		NazaraAssert(batchSize > 0, "batch size must be positive");
+
+		m_datagramBatchSize = batchSize;
+	}
+
+	inline bool ENetHost::FitsInDatagram(const ENetPeer& peer, std::size_t size) const
+	{
+		// Commands fragmented before a path MTU decrease may only fit in a datagram of their own
+		std::size_t mtu = (m_commandCount == 0) ? peer.m_mtu : peer.m_pathMtu;
+		return m_packetSize + size <= mtu;
+	}
+
 	inline void ENetHost::UpdateServiceTime()
 	{
 		// Use high precision clock for extra precision
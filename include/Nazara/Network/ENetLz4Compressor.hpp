@@ -0,0 +1,42 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NETWORK_ENETLZ4COMPRESSOR_HPP
+#define NAZARA_NETWORK_ENETLZ4COMPRESSOR_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Network/ENetCompressor.hpp>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_NETWORK_API ENetLz4Compressor final : public ENetCompressor
+	{
+		public:
+			explicit ENetLz4Compressor(int acceleration = 1);
+			ENetLz4Compressor(const ENetLz4Compressor&) = delete;
+			ENetLz4Compressor(ENetLz4Compressor&&) = delete;
+			~ENetLz4Compressor() = default;
+
+			std::size_t Compress(const ENetPeer* peer, const NetBuffer* buffers, std::size_t bufferCount, std::size_t totalInputSize, UInt8* output, std::size_t maxOutputSize) override;
+			std::size_t Decompress(const ENetPeer* peer, const UInt8* input, std::size_t inputSize, UInt8* output, std::size_t maxOutputSize) override;
+
+			inline int GetAcceleration() const;
+
+			inline void SetAcceleration(int acceleration);
+
+			ENetLz4Compressor& operator=(const ENetLz4Compressor&) = delete;
+			ENetLz4Compressor& operator=(ENetLz4Compressor&&) = delete;
+
+		private:
+			std::vector<UInt8> m_inputBuffer;
+			int m_acceleration;
+	};
+}
+
+#include <Nazara/Network/ENetLz4Compressor.inl>
+
+#endif // NAZARA_NETWORK_ENETLZ4COMPRESSOR_HPP
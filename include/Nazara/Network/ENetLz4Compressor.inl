@@ -0,0 +1,27 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Network/Debug.hpp>
+
+namespace Nz
+{
+	inline int ENetLz4Compressor::GetAcceleration() const
+	{
+		return m_acceleration;
+	}
+
+	/*!
+	* \brief Sets the LZ4 acceleration factor
+	*
+	* Higher values compress faster but less, one is the default LZ4 trade-off.
+	*
+	* \param acceleration Acceleration factor, values lower than one are treated as one
+	*/
+	inline void ENetLz4Compressor::SetAcceleration(int acceleration)
+	{
+		m_acceleration = acceleration;
+	}
+}
+
+#include <Nazara/Network/DebugOff.hpp>
@@ -18,6 +18,7 @@
 #define NAZARA_NETWORK_ENETPEER_HPP
 
 #include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/Time.hpp>
 #include <Nazara/Network/ENetPacket.hpp>
 #include <Nazara/Network/ENetProtocol.hpp>
 #include <Nazara/Network/IpAddress.hpp>
@@ -38,6 +39,9 @@ namespace Nz
 		friend struct PacketRef;
 
 		public:
+			struct CompressionStats;
+			struct PathMtuStats;
+
 			inline ENetPeer(ENetHost* host, UInt16 peerId);
 			ENetPeer(const ENetPeer&) = delete;
 			ENetPeer(ENetPeer&&) = default;
@@ -48,11 +52,16 @@ namespace Nz
 			void DisconnectNow(UInt32 data);
 
 			inline const IpAddress& GetAddress() const;
+			inline const CompressionStats& GetCompressionStats() const;
+			inline UInt32 GetIncomingBandwidth() const;
 			inline UInt32 GetLastReceiveTime() const;
 			inline UInt32 GetMtu() const;
+			inline UInt32 GetPacketThrottle() const;
 			inline UInt32 GetPacketThrottleAcceleration() const;
 			inline UInt32 GetPacketThrottleDeceleration() const;
 			inline UInt32 GetPacketThrottleInterval() const;
+			inline UInt32 GetPathMtu() const;
+			inline const PathMtuStats& GetPathMtuStats() const;
 			inline UInt16 GetPeerId() const;
 			inline UInt32 GetRoundTripTime() const;
 			inline ENetPeerState GetState() const;
@@ -82,6 +91,29 @@ namespace Nz
 			ENetPeer& operator=(const ENetPeer&) = delete;
 			ENetPeer& operator=(ENetPeer&&) = default;
 
+			struct CompressionStats
+			{
+				inline float GetCompressionRatio() const;
+
+				Time compressionTime = Time::Zero();
+				Time decompressionTime = Time::Zero();
+				UInt64 compressedInputSize = 0; //< total size of successfully compressed packets before compression
+				UInt64 compressedOutputSize = 0; //< total size of successfully compressed packets after compression
+				UInt32 compressedPacketCount = 0;
+				UInt32 decompressedPacketCount = 0;
+				UInt32 incompressiblePacketCount = 0; //< packets the compressor couldn't shrink, which were sent uncompressed
+				UInt32 skippedPacketCount = 0; //< packets sent uncompressed without trying, after incompressible ones
+			};
+
+			struct PathMtuStats
+			{
+				UInt64 fragmentCount = 0; //< fragments sent for packets larger than the path MTU
+				UInt32 blackHoleCount = 0; //< times the path MTU fell back to its base because large commands kept being lost
+				UInt32 fragmentedPacketCount = 0;
+				UInt32 lostProbeCount = 0;
+				UInt32 probeCount = 0; //< probes sent, including retransmissions
+			};
+
 		private:
 			void InitIncoming(std::size_t channelCount, const IpAddress& address, ENetProtocolConnect& incomingCommand);
 			void InitOutgoing(std::size_t channelCount, const IpAddress& address, UInt32 connectId, UInt32 windowSize);
@@ -113,6 +145,9 @@ namespace Nz
 
 			void OnConnect();
 			void OnDisconnect();
+			void OnMtuBlackHole();
+
+			UInt32 PrepareMtuProbe();
 
 			ENetProtocolCommand RemoveSentReliableCommand(UInt16 reliableSequenceNumber, UInt8 channelId);
 			void RemoveSentUnreliableCommands();
@@ -200,9 +235,14 @@ namespace Nz
 			UInt8                                 m_outgoingSessionID;
 			UInt16                                m_incomingPeerID;
 			UInt16                                m_incomingUnsequencedGroup;
+			UInt16                                m_mtuProbeSequenceNumber;
 			UInt16                                m_outgoingPeerID;
 			UInt16                                m_outgoingReliableSequenceNumber;
 			UInt16                                m_outgoingUnsequencedGroup;
+			CompressionStats                      m_compressionStats;
+			PathMtuStats                          m_pathMtuStats;
+			UInt32                                m_compressionBackoff; //< number of packets to skip after the next incompressible one
+			UInt32                                m_compressionSkipCount; //< number of packets left to send without trying to compress them
 			UInt32                                m_connectID;
 			UInt32                                m_earliestTimeout;
 			UInt32                                m_eventData;
@@ -215,7 +255,12 @@ namespace Nz
 			UInt32                                m_lastRoundTripTimeVariance;
 			UInt32                                m_lastSendTime;
 			UInt32                                m_lowestRoundTripTime;
-			UInt32                                m_mtu;
+			UInt32                                m_mtu; //< negotiated MTU, upper bound of the path MTU
+			UInt32                                m_mtuProbeAttempts;
+			UInt32                                m_mtuProbeSentTime;
+			UInt32                                m_mtuProbeSize; //< size of the probe waiting for an acknowledgement, zero if none
+			UInt32                                m_mtuProbeUpperBound; //< smallest size considered too big for the path
+			UInt32                                m_nextMtuProbeTime;
 			UInt32                                m_nextTimeout;
 			UInt32                                m_outgoingBandwidth;  /**< Upstream bandwidth of the client in bytes/second */
 			UInt32                                m_outgoingBandwidthThrottleEpoch;
@@ -230,6 +275,7 @@ namespace Nz
 			UInt32                                m_packetThrottleEpoch;
 			UInt32                                m_packetThrottleInterval;
 			UInt32                                m_packetThrottleLimit;
+			UInt32                                m_pathMtu; //< largest datagram size known to reach the peer, used to fragment packets
 			UInt32                                m_packetsLost;
 			UInt32                                m_packetsSent;
 			UInt32                                m_pingInterval;
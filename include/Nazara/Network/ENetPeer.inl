@@ -22,6 +22,16 @@ namespace Nz
 		return m_address;
 	}
 
+	inline auto ENetPeer::GetCompressionStats() const -> const CompressionStats&
+	{
+		return m_compressionStats;
+	}
+
+	inline UInt32 ENetPeer::GetIncomingBandwidth() const
+	{
+		return m_incomingBandwidth;
+	}
+
 	inline UInt32 ENetPeer::GetLastReceiveTime() const
 	{
 		return m_lastReceiveTime;
@@ -32,6 +42,11 @@ namespace Nz
 		return m_mtu;
 	}
 
+	inline UInt32 ENetPeer::GetPacketThrottle() const
+	{
+		return m_packetThrottle;
+	}
+
 	inline UInt32 ENetPeer::GetPacketThrottleAcceleration() const
 	{
 		return m_packetThrottleAcceleration;
@@ -47,6 +62,21 @@ namespace Nz
 		return m_packetThrottleInterval;
 	}
 
+	/*!
+	* \brief Returns the current path MTU estimation, which is the size packets are fragmented to
+	*
+	* The path MTU starts at a conservative size (or the negotiated MTU if lower) and is then raised by probing the path with padded datagrams, up to the negotiated MTU (see GetMtu).
+	*/
+	inline UInt32 ENetPeer::GetPathMtu() const
+	{
+		return m_pathMtu;
+	}
+
+	inline auto ENetPeer::GetPathMtuStats() const -> const PathMtuStats&
+	{
+		return m_pathMtuStats;
+	}
+
 	inline UInt16 ENetPeer::GetPeerId() const
 	{
 		return m_incomingPeerID;
@@ -116,6 +146,18 @@ namespace Nz
 	{
 		QueueOutgoingCommand(command, ENetPacketRef(), 0, 0);
 	}
+
+	/*!
+	* \brief Returns the average size of compressed packets relative to their original size
+	* \return Compressed size divided by original size, one if no packet was compressed
+	*/
+	inline float ENetPeer::CompressionStats::GetCompressionRatio() const
+	{
+		if (compressedInputSize == 0)
+			return 1.f;
+
+		return static_cast<float>(static_cast<double>(compressedOutputSize) / static_cast<double>(compressedInputSize));
+	}
 }
 
 #include <Nazara/Network/DebugOff.hpp>
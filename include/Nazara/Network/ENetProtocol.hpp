@@ -27,6 +27,7 @@ namespace Nz
 	enum ENetConstants
 	{
 		ENetHost_BandwidthThrottleInterval = 1000,
+		ENetHost_DefaultDatagramBatchSize  = 32,
 		ENetHost_DefaultMaximumPacketSize  = 32 * 1024 * 1024,
 		ENetHost_DefaultMaximumWaitingData = 32 * 1024 * 1024,
 		ENetHost_DefaultMTU                = 1400,
@@ -37,6 +38,12 @@ namespace Nz
 		ENetPeer_DefaultRoundTripTime       = 500,
 		ENetPeer_FreeReliableWindows        = 8,
 		ENetPeer_FreeUnsequencedWindows     = 32,
+		ENetPeer_MaximumCompressionBackoff  = 32,
+		ENetPeer_MtuBlackHoleAttempts       = 3,
+		ENetPeer_MtuProbeBase               = 1200,
+		ENetPeer_MtuProbeGranularity        = 32,
+		ENetPeer_MtuProbeMaxAttempts        = 3,
+		ENetPeer_MtuRaiseInterval           = 10 * 60 * 1000,
 		ENetPeer_PacketLossInterval         = 10000,
 		ENetPeer_PacketLossScale            = (1 << 16),
 		ENetPeer_PacketThrottleAcceleration = 2,
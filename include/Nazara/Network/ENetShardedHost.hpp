@@ -0,0 +1,89 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NETWORK_ENETSHARDEDHOST_HPP
+#define NAZARA_NETWORK_ENETSHARDEDHOST_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/MpscQueue.hpp>
+#include <Nazara/Network/Config.hpp>
+#include <Nazara/Network/ENetPacket.hpp>
+#include <Nazara/Network/ENetProtocol.hpp>
+#include <Nazara/Network/IpAddress.hpp>
+#include <Nazara/Network/NetPacket.hpp>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_NETWORK_API ENetShardedHost
+	{
+		public:
+			struct Event;
+			struct PeerHandle;
+
+			ENetShardedHost();
+			ENetShardedHost(const ENetShardedHost&) = delete;
+			ENetShardedHost(ENetShardedHost&&) = delete;
+			~ENetShardedHost();
+
+			void Broadcast(UInt8 channelId, ENetPacketFlags flags, NetPacket&& packet);
+
+			bool Create(const IpAddress& listenAddress, std::size_t peerCountPerShard, std::size_t channelCount = 0, std::size_t shardCount = 0);
+			void Destroy();
+
+			void Disconnect(const PeerHandle& peer, UInt32 data = 0);
+
+			inline UInt32 GetServiceTimeout() const;
+			inline std::size_t GetShardCount() const;
+
+			bool PollEvent(Event* event);
+
+			void Send(const PeerHandle& peer, UInt8 channelId, ENetPacketFlags flags, NetPacket&& packet);
+
+			inline void SetServiceTimeout(UInt32 timeout);
+
+			ENetShardedHost& operator=(const ENetShardedHost&) = delete;
+			ENetShardedHost& operator=(ENetShardedHost&&) = delete;
+
+			struct PeerHandle
+			{
+				UInt32 generation = 0; //< incremented every time the peer slot is freed, so that handles to previous peers are ignored
+				UInt32 shardIndex = 0;
+				UInt16 peerId = 0;
+
+				inline bool operator==(const PeerHandle& other) const;
+				inline bool operator!=(const PeerHandle& other) const;
+			};
+
+			struct Event
+			{
+				ENetEventType type = ENetEventType::None;
+				IpAddress address; //< peer address
+				NetPacket packet; //< received packet (Receive events only)
+				PeerHandle peer;
+				UInt32 data = 0;
+				UInt8 channelId = 0;
+			};
+
+		private:
+			struct Command;
+			struct Shard;
+
+			void HandleCommand(Shard& shard, Command& command);
+			void ShardProc(Shard& shard);
+
+			std::atomic_bool m_running;
+			std::vector<std::unique_ptr<Shard>> m_shards;
+			MpscQueue<Event> m_events;
+			UInt32 m_serviceTimeout;
+	};
+}
+
+#include <Nazara/Network/ENetShardedHost.inl>
+
+#endif // NAZARA_NETWORK_ENETSHARDEDHOST_HPP
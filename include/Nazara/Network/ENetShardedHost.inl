@@ -0,0 +1,45 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Network/Debug.hpp>
+
+namespace Nz
+{
+	inline UInt32 ENetShardedHost::GetServiceTimeout() const
+	{
+		return m_serviceTimeout;
+	}
+
+	inline std::size_t ENetShardedHost::GetShardCount() const
+	{
+		return m_shards.size();
+	}
+
+	/*!
+	* \brief Sets the maximum time (in milliseconds) a shard waits for incoming datagrams before processing pending commands
+	*
+	* \param timeout Service timeout, lower values reduce Send latency at the expense of more wake-ups
+	*
+	* \remark This must be called before Create
+	*/
+	inline void ENetShardedHost::SetServiceTimeout(UInt32 timeout)
+	{
+		NazaraAssert(m_shards.empty(), "service timeout must be set before creating the host");
+
+		m_serviceTimeout = timeout;
+	}
+
+	inline bool ENetShardedHost::PeerHandle::operator==(const PeerHandle& other) const
+	{
+		return generation == other.generation && shardIndex == other.shardIndex && peerId == other.peerId;
+	}
+
+	inline bool ENetShardedHost::PeerHandle::operator!=(const PeerHandle& other) const
+	{
+		return !operator==(other);
+	}
+}
+
+#include <Nazara/Network/DebugOff.hpp>
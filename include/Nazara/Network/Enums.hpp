@@ -95,6 +95,16 @@ namespace Nz
 
 	using SocketPollEventFlags = Flags<SocketPollEvent>;
 
+	enum class SocketPollMode
+	{
+		EdgeTriggered,  //< Readiness is reported once each time the socket state changes, until it is drained (falls back to level-triggered if unsupported by the system)
+		LevelTriggered, //< Readiness is reported on every wait as long as the socket stays ready
+
+		Max = LevelTriggered
+	};
+
+	constexpr std::size_t SocketPollModeCount = static_cast<std::size_t>(SocketPollMode::Max) + 1;
+
 	enum class SocketState
 	{
 		Bound,        //< The socket is currently bound
@@ -119,6 +129,17 @@ namespace Nz
 	};
 
 	constexpr std::size_t SocketTypeCount = static_cast<std::size_t>(SocketType::Max) + 1;
+
+	enum class WebRequestDataStatus
+	{
+		Abort,    //< The request must be aborted
+		Continue, //< Data was consumed, the transfer goes on
+		Pause,    //< Data could not be consumed yet, the transfer is paused and the same data will be submitted again on next WebService::Poll
+
+		Max = Pause
+	};
+
+	constexpr std::size_t WebRequestDataStatusCount = static_cast<std::size_t>(WebRequestDataStatus::Max) + 1;
 }
 
 #endif // NAZARA_NETWORK_ENUMS_HPP
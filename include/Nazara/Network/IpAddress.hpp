@@ -8,9 +8,11 @@
 #define NAZARA_NETWORK_IPADDRESS_HPP
 
 #include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/Time.hpp>
 #include <Nazara/Network/Config.hpp>
 #include <Nazara/Network/Enums.hpp>
 #include <array>
+#include <functional>
 #include <iosfwd>
 #include <string>
 #include <vector>
@@ -24,6 +26,8 @@ namespace Nz
 		public:
 			using IPv4 = std::array<UInt8, 4>;  //< four 8bits blocks
 			using IPv6 = std::array<UInt16, 8>; //< eight 16bits blocks
+			using ResolveAddressCallback = std::function<void(std::string hostname, std::string service, ResolveError error)>;
+			using ResolveHostnameCallback = std::function<void(std::vector<HostnameInfo> results, ResolveError error)>;
 
 			inline IpAddress();
 			inline IpAddress(const IPv4& ip, UInt16 port = 0);
@@ -57,8 +61,13 @@ namespace Nz
 			IpAddress& operator=(const IpAddress&) = default;
 			IpAddress& operator=(IpAddress&&) noexcept = default;
 
+			static void ClearResolveCache();
+			static Time GetResolveCacheDuration();
 			static std::string ResolveAddress(const IpAddress& address, std::string* service = nullptr, ResolveError* error = nullptr);
+			static void ResolveAddressAsync(const IpAddress& address, ResolveAddressCallback callback);
 			static std::vector<HostnameInfo> ResolveHostname(NetProtocol procol, const std::string& hostname, const std::string& protocol = "http", ResolveError* error = nullptr);
+			static void ResolveHostnameAsync(NetProtocol procol, std::string hostname, std::string protocol, ResolveHostnameCallback callback);
+			static void SetResolveCacheDuration(Time duration);
 
 			inline friend std::ostream& operator<<(std::ostream& out, const IpAddress& address);
 
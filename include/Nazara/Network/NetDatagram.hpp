@@ -0,0 +1,24 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NETWORK_NETDATAGRAM_HPP
+#define NAZARA_NETWORK_NETDATAGRAM_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Network/IpAddress.hpp>
+#include <Nazara/Network/NetBuffer.hpp>
+
+namespace Nz
+{
+	struct NetDatagram
+	{
+		IpAddress address; //< sender of a received datagram, destination of a datagram to send
+		NetBuffer buffer; //< datagram data, when receiving dataLength is the maximum size that can be received
+		std::size_t receivedLength = 0; //< size of the received datagram (zero if it was truncated)
+	};
+}
+
+#endif // NAZARA_NETWORK_NETDATAGRAM_HPP
@@ -50,6 +50,7 @@ namespace Nz
 			static bool EncodeHeader(void* data, UInt32 packetSize, UInt16 netCode);
 
 			static constexpr std::size_t HeaderSize = sizeof(UInt32) + sizeof(UInt16); //< PacketSize + NetCode
+			static constexpr std::size_t MaxPooledBufferCount = 1024;
 
 		private:
 			void OnEmptyStream() override;
@@ -65,7 +66,7 @@ namespace Nz
 			UInt16 m_netCode;
 
 			static std::recursive_mutex s_availableBuffersMutex;
-			static std::vector<std::pair<std::size_t, std::unique_ptr<ByteArray>>> s_availableBuffers;
+			static std::vector<std::unique_ptr<ByteArray>> s_availableBuffers; //< sorted by capacity
 	};
 }
 
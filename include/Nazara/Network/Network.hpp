@@ -11,6 +11,8 @@
 #include <Nazara/Core/Core.hpp>
 #include <Nazara/Network/Config.hpp>
 #include <memory>
+#include <mutex>
+#include <optional>
 
 namespace Nz
 {
@@ -28,15 +30,24 @@ namespace Nz
 			Network(Config config);
 			~Network();
 
+			TaskScheduler& GetResolverScheduler();
+
 			std::unique_ptr<WebService> InstantiateWebService();
 
 			struct Config
 			{
+				// Number of threads used by asynchronous hostname resolution (see IpAddress::ResolveHostnameAsync), they're only started on first use
+				unsigned int resolverThreadCount = 2;
+
 				// Initialize web services and fails module initialization if it failed to initialize them
 				bool webServices = false;
 			};
 
 		private:
+			std::once_flag m_resolverSchedulerFlag;
+			std::optional<TaskScheduler> m_resolverScheduler;
+			unsigned int m_resolverThreadCount;
+
 #ifndef NAZARA_PLATFORM_WEB
 			std::unique_ptr<class CurlLibrary> m_curlLibrary;
 #endif
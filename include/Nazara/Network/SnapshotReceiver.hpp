@@ -0,0 +1,59 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NETWORK_SNAPSHOTRECEIVER_HPP
+#define NAZARA_NETWORK_SNAPSHOTRECEIVER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Network/Config.hpp>
+#include <Nazara/Network/SnapshotSchema.hpp>
+#include <entt/entt.hpp>
+#include <array>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace Nz
+{
+	class ByteStream;
+
+	class NAZARA_NETWORK_API SnapshotReceiver
+	{
+		public:
+			SnapshotReceiver(entt::registry& registry, const SnapshotSchema& schema);
+			SnapshotReceiver(const SnapshotReceiver&) = delete;
+			SnapshotReceiver(SnapshotReceiver&&) = delete;
+			~SnapshotReceiver();
+
+			void Clear();
+
+			inline entt::entity GetEntity(UInt32 networkId) const;
+			inline UInt32 GetLastSequence() const;
+
+			std::optional<UInt32> ProcessSnapshot(ByteStream& stream);
+
+			SnapshotReceiver& operator=(const SnapshotReceiver&) = delete;
+			SnapshotReceiver& operator=(SnapshotReceiver&&) = delete;
+
+		private:
+			struct Snapshot
+			{
+				std::unordered_map<UInt32, SnapshotEntityState> entities;
+				UInt32 sequence = 0;
+			};
+
+			std::array<Snapshot, SnapshotSchema::BaselineCount> m_snapshots;
+			std::unordered_map<UInt32, entt::entity> m_entities;
+			std::vector<UInt8> m_buffer;
+			entt::registry& m_registry;
+			const SnapshotSchema& m_schema;
+			UInt32 m_lastSequence;
+	};
+}
+
+#include <Nazara/Network/SnapshotReceiver.inl>
+
+#endif // NAZARA_NETWORK_SNAPSHOTRECEIVER_HPP
@@ -0,0 +1,32 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Network/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Gets the local entity matching a network id
+	* \return Local entity or entt::null if no such entity has been replicated
+	*/
+	inline entt::entity SnapshotReceiver::GetEntity(UInt32 networkId) const
+	{
+		auto it = m_entities.find(networkId);
+		if (it == m_entities.end())
+			return entt::null;
+
+		return it->second;
+	}
+
+	/*!
+	* \brief Gets the sequence of the last applied snapshot
+	* \return Sequence of the last snapshot, or zero if none were applied
+	*/
+	inline UInt32 SnapshotReceiver::GetLastSequence() const
+	{
+		return m_lastSequence;
+	}
+}
+
+#include <Nazara/Network/DebugOff.hpp>
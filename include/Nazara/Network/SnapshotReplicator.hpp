@@ -0,0 +1,117 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NETWORK_SNAPSHOTREPLICATOR_HPP
+#define NAZARA_NETWORK_SNAPSHOTREPLICATOR_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/DynamicAABBTree.hpp>
+#include <Nazara/Core/Time.hpp>
+#include <Nazara/Math/Vector3.hpp>
+#include <Nazara/Network/Config.hpp>
+#include <Nazara/Network/SnapshotSchema.hpp>
+#include <entt/entt.hpp>
+#include <array>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Nz
+{
+	class ByteStream;
+	class ENetPeer;
+
+	class NAZARA_NETWORK_API SnapshotReplicator
+	{
+		public:
+			using PositionCallback = std::function<Vector3f(const entt::registry& registry, entt::entity entity)>;
+
+			SnapshotReplicator(entt::registry& registry, const SnapshotSchema& schema);
+			SnapshotReplicator(const SnapshotReplicator&) = delete;
+			SnapshotReplicator(SnapshotReplicator&&) = delete;
+			~SnapshotReplicator();
+
+			std::size_t AddClient(ENetPeer* peer = nullptr);
+
+			std::size_t BuildSnapshot(std::size_t clientIndex, ByteStream& stream, Time elapsedTime);
+
+			inline UInt32 GetNetworkId(entt::entity entity) const;
+
+			void HandleAcknowledgement(std::size_t clientIndex, UInt32 sequence);
+
+			void RemoveClient(std::size_t clientIndex);
+
+			UInt32 Replicate(entt::entity entity);
+
+			void SetClientBandwidth(std::size_t clientIndex, UInt32 bytesPerSecond);
+			void SetClientView(std::size_t clientIndex, const Vector3f& position, float radius);
+			void SetPositionCallback(PositionCallback positionCallback);
+
+			void StopReplicating(entt::entity entity);
+
+			void Update();
+
+			SnapshotReplicator& operator=(const SnapshotReplicator&) = delete;
+			SnapshotReplicator& operator=(SnapshotReplicator&&) = delete;
+
+			static constexpr UInt32 InvalidNetworkId = 0;
+
+		private:
+			struct Candidate
+			{
+				const SnapshotEntityState* baseline;
+				const SnapshotEntityState* state;
+				float priority;
+				UInt32 networkId;
+			};
+
+			struct EntityData
+			{
+				SnapshotEntityState state;
+				Vector3f position;
+				entt::entity entity;
+				std::size_t proxyId = DynamicAABBTree::InvalidProxy;
+			};
+
+			struct Snapshot
+			{
+				std::unordered_map<UInt32, SnapshotEntityState> entities;
+				UInt32 sequence = 0;
+			};
+
+			struct ClientData
+			{
+				std::array<Snapshot, SnapshotSchema::BaselineCount> snapshots;
+				std::unordered_map<UInt32, float> priorities; //< accumulated by entities which changed but couldn't be sent
+				ENetPeer* peer;
+				Vector3f viewPosition = Vector3f::Zero();
+				double bandwidthCredit = 0.0;
+				float viewRadius = std::numeric_limits<float>::infinity();
+				UInt32 bandwidth = 0; //< bytes per second, zero means unlimited
+				UInt32 lastAckedSequence = 0;
+				UInt32 lastSequence = 0;
+			};
+
+			bool ComputeBudget(ClientData& client, Time elapsedTime, std::size_t& budget);
+
+			std::unordered_map<entt::entity, UInt32> m_networkIds;
+			std::unordered_map<UInt32, EntityData> m_entities;
+			std::vector<Candidate> m_candidates;
+			std::vector<std::unique_ptr<ClientData>> m_clients;
+			std::vector<UInt32> m_despawnedEntities;
+			entt::registry& m_registry;
+			DynamicAABBTree m_spatialTree;
+			PositionCallback m_positionCallback;
+			const SnapshotSchema& m_schema;
+			UInt32 m_nextNetworkId;
+	};
+}
+
+#include <Nazara/Network/SnapshotReplicator.inl>
+
+#endif // NAZARA_NETWORK_SNAPSHOTREPLICATOR_HPP
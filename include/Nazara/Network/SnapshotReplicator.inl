@@ -0,0 +1,23 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Network/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Gets the network id of a replicated entity
+	* \return Network id of the entity or InvalidNetworkId if it isn't replicated
+	*/
+	inline UInt32 SnapshotReplicator::GetNetworkId(entt::entity entity) const
+	{
+		auto it = m_networkIds.find(entity);
+		if (it == m_networkIds.end())
+			return InvalidNetworkId;
+
+		return it->second;
+	}
+}
+
+#include <Nazara/Network/DebugOff.hpp>
@@ -0,0 +1,74 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NETWORK_SNAPSHOTSCHEMA_HPP
+#define NAZARA_NETWORK_SNAPSHOTSCHEMA_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Network/Config.hpp>
+#include <entt/entt.hpp>
+#include <functional>
+#include <vector>
+
+namespace Nz
+{
+	struct SnapshotEntityState
+	{
+		UInt64 componentMask = 0;
+		std::vector<UInt32> fields; //< one value per field of the schema, zero when the component is absent
+
+		inline bool operator==(const SnapshotEntityState& state) const;
+		inline bool operator!=(const SnapshotEntityState& state) const;
+	};
+
+	class SnapshotSchema
+	{
+		public:
+			struct Component;
+
+			SnapshotSchema() = default;
+			SnapshotSchema(const SnapshotSchema&) = default;
+			SnapshotSchema(SnapshotSchema&&) noexcept = default;
+			~SnapshotSchema() = default;
+
+			inline void ApplyState(entt::registry& registry, entt::entity entity, const SnapshotEntityState& previousState, const SnapshotEntityState& state) const;
+
+			inline bool ExtractState(const entt::registry& registry, entt::entity entity, SnapshotEntityState& state) const;
+
+			inline const Component& GetComponent(std::size_t componentIndex) const;
+			inline std::size_t GetComponentCount() const;
+			inline std::size_t GetFieldCount() const;
+
+			inline std::size_t RegisterComponent(Component component);
+			template<typename T, typename Encoder, typename Decoder> std::size_t RegisterComponent(std::vector<UInt8> fieldBits, Encoder&& encoder, Decoder&& decoder);
+
+			SnapshotSchema& operator=(const SnapshotSchema&) = default;
+			SnapshotSchema& operator=(SnapshotSchema&&) noexcept = default;
+
+			static inline float DequantizeFloat(UInt32 value, float min, float max, UInt8 bitCount);
+			static inline UInt32 QuantizeFloat(float value, float min, float max, UInt8 bitCount);
+
+			static constexpr std::size_t BaselineCount = 32; //< how many snapshots are kept by both sides to serve as delta baselines
+			static constexpr std::size_t MaxComponentCount = 64;
+
+			struct Component
+			{
+				std::function<void(entt::registry& registry, entt::entity entity, const UInt32* fields)> apply;  //< creates or updates the component from its fields
+				std::function<bool(const entt::registry& registry, entt::entity entity, UInt32* fields)> extract; //< returns false if the entity doesn't have the component
+				std::function<void(entt::registry& registry, entt::entity entity)> remove;
+				std::vector<UInt8> fieldBits; //< bit count of each field (1-32)
+				std::size_t fieldOffset = 0;  //< set by RegisterComponent
+			};
+
+		private:
+			std::size_t m_fieldCount = 0;
+			std::vector<Component> m_components;
+	};
+}
+
+#include <Nazara/Network/SnapshotSchema.inl>
+
+#endif // NAZARA_NETWORK_SNAPSHOTSCHEMA_HPP
@@ -0,0 +1,159 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Error.hpp>
+#include <algorithm>
+#include <cmath>
+#include <Nazara/Network/Debug.hpp>
+
+namespace Nz
+{
+	inline bool SnapshotEntityState::operator==(const SnapshotEntityState& state) const
+	{
+		return componentMask == state.componentMask && fields == state.fields;
+	}
+
+	inline bool SnapshotEntityState::operator!=(const SnapshotEntityState& state) const
+	{
+		return !operator==(state);
+	}
+
+	/*!
+	* \brief Updates an entity so it goes from a previous state to a new one
+	*
+	* Only the components whose fields changed are applied, components missing from the new state are removed
+	*/
+	inline void SnapshotSchema::ApplyState(entt::registry& registry, entt::entity entity, const SnapshotEntityState& previousState, const SnapshotEntityState& state) const
+	{
+		NazaraAssert(state.fields.size() == m_fieldCount, "state doesn't match schema");
+
+		for (std::size_t componentIndex = 0; componentIndex < m_components.size(); ++componentIndex)
+		{
+			const Component& component = m_components[componentIndex];
+			UInt64 componentBit = UInt64(1) << componentIndex;
+
+			bool wasPresent = (previousState.componentMask & componentBit) != 0;
+			if (state.componentMask & componentBit)
+			{
+				const UInt32* fields = &state.fields[component.fieldOffset];
+				if (!wasPresent || !std::equal(fields, fields + component.fieldBits.size(), &previousState.fields[component.fieldOffset]))
+					component.apply(registry, entity, fields);
+			}
+			else if (wasPresent)
+				component.remove(registry, entity);
+		}
+	}
+
+	/*!
+	* \brief Fills a state from the replicated components of an entity
+	* \return True if the entity has at least one replicated component
+	*/
+	inline bool SnapshotSchema::ExtractState(const entt::registry& registry, entt::entity entity, SnapshotEntityState& state) const
+	{
+		state.componentMask = 0;
+		state.fields.assign(m_fieldCount, 0);
+
+		for (std::size_t componentIndex = 0; componentIndex < m_components.size(); ++componentIndex)
+		{
+			const Component& component = m_components[componentIndex];
+			if (component.extract(registry, entity, &state.fields[component.fieldOffset]))
+				state.componentMask |= UInt64(1) << componentIndex;
+		}
+
+		return state.componentMask != 0;
+	}
+
+	inline auto SnapshotSchema::GetComponent(std::size_t componentIndex) const -> const Component&
+	{
+		NazaraAssert(componentIndex < m_components.size(), "component index out of range");
+		return m_components[componentIndex];
+	}
+
+	inline std::size_t SnapshotSchema::GetComponentCount() const
+	{
+		return m_components.size();
+	}
+
+	inline std::size_t SnapshotSchema::GetFieldCount() const
+	{
+		return m_fieldCount;
+	}
+
+	/*!
+	* \brief Registers a replicated component
+	* \return Index of the component, which must be the same on both sides of the connection
+	*
+	* \param component Component description, the field offset is computed by the schema
+	*/
+	inline std::size_t SnapshotSchema::RegisterComponent(Component component)
+	{
+		NazaraAssert(m_components.size() < MaxComponentCount, "too many components");
+		NazaraAssert(component.apply && component.extract && component.remove, "invalid component callbacks");
+		NazaraAssert(std::all_of(component.fieldBits.begin(), component.fieldBits.end(), [](UInt8 bitCount) { return bitCount >= 1 && bitCount <= 32; }), "field bit count must be between 1 and 32");
+
+		component.fieldOffset = m_fieldCount;
+		m_fieldCount += component.fieldBits.size();
+
+		std::size_t componentIndex = m_components.size();
+		m_components.push_back(std::move(component));
+
+		return componentIndex;
+	}
+
+	/*!
+	* \brief Registers a replicated EnTT component type
+	* \return Index of the component, which must be the same on both sides of the connection
+	*
+	* \param fieldBits Bit count of each field the component is encoded to
+	* \param encoder Callable of signature void(const T& component, UInt32* fields)
+	* \param decoder Callable of signature void(T& component, const UInt32* fields), called on a default-constructed component when it gets created
+	*/
+	template<typename T, typename Encoder, typename Decoder>
+	std::size_t SnapshotSchema::RegisterComponent(std::vector<UInt8> fieldBits, Encoder&& encoder, Decoder&& decoder)
+	{
+		Component component;
+		component.fieldBits = std::move(fieldBits);
+		component.apply = [decoder = std::forward<Decoder>(decoder)](entt::registry& registry, entt::entity entity, const UInt32* fields)
+		{
+			decoder(registry.get_or_emplace<T>(entity), fields);
+		};
+
+		component.extract = [encoder = std::forward<Encoder>(encoder)](const entt::registry& registry, entt::entity entity, UInt32* fields)
+		{
+			const T* componentPtr = registry.try_get<T>(entity);
+			if (!componentPtr)
+				return false;
+
+			encoder(*componentPtr, fields);
+			return true;
+		};
+
+		component.remove = [](entt::registry& registry, entt::entity entity)
+		{
+			registry.remove<T>(entity);
+		};
+
+		return RegisterComponent(std::move(component));
+	}
+
+	inline float SnapshotSchema::DequantizeFloat(UInt32 value, float min, float max, UInt8 bitCount)
+	{
+		NazaraAssert(bitCount >= 1 && bitCount <= 32, "bit count must be between 1 and 32");
+
+		UInt64 maxValue = (UInt64(1) << bitCount) - 1;
+		return min + (max - min) * static_cast<float>(double(value) / double(maxValue));
+	}
+
+	inline UInt32 SnapshotSchema::QuantizeFloat(float value, float min, float max, UInt8 bitCount)
+	{
+		NazaraAssert(bitCount >= 1 && bitCount <= 32, "bit count must be between 1 and 32");
+		NazaraAssert(max > min, "invalid range");
+
+		UInt64 maxValue = (UInt64(1) << bitCount) - 1;
+		double normalized = std::clamp((double(value) - min) / (double(max) - min), 0.0, 1.0);
+		return static_cast<UInt32>(std::llround(normalized * double(maxValue)));
+	}
+}
+
+#include <Nazara/Network/DebugOff.hpp>
@@ -0,0 +1,57 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NETWORK_SOCKETCOMPLETIONQUEUE_HPP
+#define NAZARA_NETWORK_SOCKETCOMPLETIONQUEUE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Network/Config.hpp>
+#include <Nazara/Network/Enums.hpp>
+#include <NazaraUtils/MovablePtr.hpp>
+#include <functional>
+
+namespace Nz
+{
+	class AbstractSocket;
+	class SocketCompletionQueueImpl;
+	class TcpClient;
+	class TcpServer;
+
+	class NAZARA_NETWORK_API SocketCompletionQueue
+	{
+		public:
+			using AcceptCallback = std::function<void(TcpClient&& client)>;
+			using ReceiveCallback = std::function<void(const void* data, std::size_t size, SocketError error)>;
+			using SendCallback = std::function<void(std::size_t sent, SocketError error)>;
+
+			SocketCompletionQueue();
+			SocketCompletionQueue(const SocketCompletionQueue&) = delete;
+			SocketCompletionQueue(SocketCompletionQueue&&) noexcept = default;
+			~SocketCompletionQueue();
+
+			bool Create(std::size_t receiveBufferSize = DefaultReceiveBufferSize, std::size_t receiveBufferCount = DefaultReceiveBufferCount);
+			void Destroy();
+
+			unsigned int Process(int msTimeout, SocketError* error = nullptr);
+
+			bool Send(TcpClient& client, const void* data, std::size_t size, SendCallback callback = nullptr);
+
+			bool StartAccepting(TcpServer& server, AcceptCallback callback);
+			bool StartReceiving(TcpClient& client, ReceiveCallback callback);
+			void Stop(AbstractSocket& socket);
+
+			SocketCompletionQueue& operator=(const SocketCompletionQueue&) = delete;
+			SocketCompletionQueue& operator=(SocketCompletionQueue&&) noexcept = default;
+
+			static constexpr std::size_t DefaultReceiveBufferCount = 1024;
+			static constexpr std::size_t DefaultReceiveBufferSize = 16 * 1024;
+
+		private:
+			MovablePtr<SocketCompletionQueueImpl> m_impl;
+	};
+}
+
+#endif // NAZARA_NETWORK_SOCKETCOMPLETIONQUEUE_HPP
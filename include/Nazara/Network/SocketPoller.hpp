@@ -9,12 +9,20 @@
 
 #include <NazaraUtils/Prerequisites.hpp>
 #include <Nazara/Network/AbstractSocket.hpp>
+#include <Nazara/Network/SocketHandle.hpp>
 #include <NazaraUtils/MovablePtr.hpp>
 
 namespace Nz
 {
 	class SocketPollerImpl;
 
+	struct SocketPollerEvent
+	{
+		SocketHandle socket;
+		SocketPollEventFlags events;
+		void* userdata;
+	};
+
 	class NAZARA_NETWORK_API SocketPoller
 	{
 		public:
@@ -29,10 +37,11 @@ namespace Nz
 			bool IsReadyToWrite(const AbstractSocket& socket) const;
 			bool IsRegistered(const AbstractSocket& socket) const;
 
-			bool RegisterSocket(AbstractSocket& socket, SocketPollEventFlags eventFlags);
+			bool RegisterSocket(AbstractSocket& socket, SocketPollEventFlags eventFlags, void* userdata = nullptr, SocketPollMode pollMode = SocketPollMode::LevelTriggered);
 			void UnregisterSocket(AbstractSocket& socket);
 
 			unsigned int Wait(int msTimeout, SocketError* error = nullptr);
+			unsigned int Wait(int msTimeout, SocketPollerEvent* events, std::size_t maxEventCount, SocketError* error = nullptr);
 
 			SocketPoller& operator=(const SocketPoller&) = delete;
 			SocketPoller& operator=(SocketPoller&&) noexcept = default;
@@ -12,7 +12,9 @@
 #include <Nazara/Core/Stream.hpp>
 #include <Nazara/Network/AbstractSocket.hpp>
 #include <Nazara/Network/IpAddress.hpp>
+#include <NazaraUtils/Signal.hpp>
 #include <string>
+#include <vector>
 
 namespace Nz
 {
@@ -21,6 +23,7 @@ namespace Nz
 
 	class NAZARA_NETWORK_API TcpClient : public AbstractSocket, public Stream
 	{
+		friend class SocketCompletionQueue;
 		friend class TcpServer;
 
 		public:
@@ -32,19 +35,27 @@ namespace Nz
 			SocketState Connect(const std::string& hostName, NetProtocol protocol = NetProtocol::Any, const std::string& service = "http", ResolveError* error = nullptr);
 			inline void Disconnect();
 
+			void EnableCorking(bool corking);
 			void EnableLowDelay(bool lowDelay);
 			void EnableKeepAlive(bool keepAlive, UInt64 msTime = 10000, UInt64 msInterval = 1000);
 
+			bool FlushSendQueue();
+
 			inline UInt64 GetKeepAliveInterval() const;
 			inline UInt64 GetKeepAliveTime() const;
 			inline IpAddress GetRemoteAddress() const;
+			inline std::size_t GetSendQueueSize() const;
 			UInt64 GetSize() const override;
 
+			inline bool IsCorkingEnabled() const;
 			inline bool IsLowDelayEnabled() const;
 			inline bool IsKeepAliveEnabled() const;
 
 			SocketState PollForConnected(UInt64 waitDuration = 0);
 
+			void QueueSend(const void* buffer, std::size_t size);
+			bool QueueSendPacket(const NetPacket& packet);
+
 			bool Receive(void* buffer, std::size_t size, std::size_t* received);
 			bool ReceivePacket(NetPacket* packet);
 
@@ -52,10 +63,16 @@ namespace Nz
 			bool SendMultiple(const NetBuffer* buffers, std::size_t bufferCount, std::size_t* sent);
 			bool SendPacket(const NetPacket& packet);
 
+			inline void SetSendQueueWatermarks(std::size_t lowWatermark, std::size_t highWatermark);
+
 			SocketState WaitForConnected(UInt64 msTimeout = 3000);
 
 			inline TcpClient& operator=(TcpClient&& tcpClient) = default;
 
+			// Signals:
+			NazaraSignal(OnSendQueueHighWatermark, TcpClient* /*client*/, std::size_t /*queuedSize*/);
+			NazaraSignal(OnSendQueueLowWatermark, TcpClient* /*client*/, std::size_t /*queuedSize*/);
+
 		private:
 			void FlushStream() override;
 
@@ -79,10 +96,17 @@ namespace Nz
 
 			IpAddress m_peerAddress;
 			PendingPacket m_pendingPacket;
+			std::size_t m_sendHighWatermark;
+			std::size_t m_sendLowWatermark;
+			std::size_t m_sendRingBegin;
+			std::size_t m_sendRingSize;
+			std::vector<UInt8> m_sendRing;
 			UInt64 m_keepAliveInterval;
 			UInt64 m_keepAliveTime;
+			bool m_isCorkingEnabled;
 			bool m_isKeepAliveEnabled;
 			bool m_isLowDelayEnabled;
+			bool m_isSendQueueAboveHighWatermark;
 	};
 }
 
@@ -2,6 +2,8 @@
 // This file is part of the "Nazara Engine - Network module"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
+#include <Nazara/Core/Error.hpp>
+#include <limits>
 #include <Nazara/Network/Debug.hpp>
 
 namespace Nz
@@ -13,10 +15,16 @@ namespace Nz
 	inline TcpClient::TcpClient() :
 	AbstractSocket(SocketType::TCP),
 	Stream(StreamOption::Sequential),
+	m_sendHighWatermark(std::numeric_limits<std::size_t>::max()),
+	m_sendLowWatermark(0),
+	m_sendRingBegin(0),
+	m_sendRingSize(0),
 	m_keepAliveInterval(1000),   //TODO: Query OS default value
 	m_keepAliveTime(7'200'000),  //TODO: Query OS default value
+	m_isCorkingEnabled(false),
 	m_isKeepAliveEnabled(false), //TODO: Query OS default value
-	m_isLowDelayEnabled(false)   //TODO: Query OS default value
+	m_isLowDelayEnabled(false),  //TODO: Query OS default value
+	m_isSendQueueAboveHighWatermark(false)
 	{
 	}
 
@@ -61,6 +69,26 @@ namespace Nz
 		return m_peerAddress;
 	}
 
+	/*!
+	* \brief Gets the number of bytes queued for sending
+	* \return Bytes queued by QueueSend and QueueSendPacket which weren't sent yet
+	*/
+
+	inline std::size_t TcpClient::GetSendQueueSize() const
+	{
+		return m_sendRingSize;
+	}
+
+	/*!
+	* \brief Checks whether corking is enabled
+	* \return true If it is the case
+	*/
+
+	inline bool TcpClient::IsCorkingEnabled() const
+	{
+		return m_isCorkingEnabled;
+	}
+
 	/*!
 	* \brief Checks whether low delay is enabled
 	* \return true If it is the case
@@ -80,6 +108,26 @@ namespace Nz
 	{
 		return m_isKeepAliveEnabled;
 	}
+
+	/*!
+	* \brief Sets the send queue sizes triggering backpressure signals
+	*
+	* OnSendQueueHighWatermark is triggered when the send queue grows over the high watermark,
+	* OnSendQueueLowWatermark is then triggered once it has been flushed down to the low watermark.
+	*
+	* \param lowWatermark Queue size (in bytes) under which the queue is considered drained
+	* \param highWatermark Queue size (in bytes) over which senders should stop queuing data
+	*
+	* \remark Produces a NazaraAssert if the low watermark is greater than the high watermark
+	*/
+
+	inline void TcpClient::SetSendQueueWatermarks(std::size_t lowWatermark, std::size_t highWatermark)
+	{
+		NazaraAssert(lowWatermark <= highWatermark, "low watermark must be less or equal to high watermark");
+
+		m_sendHighWatermark = highWatermark;
+		m_sendLowWatermark = lowWatermark;
+	}
 }
 
 #include <Nazara/Network/DebugOff.hpp>
@@ -0,0 +1,63 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NETWORK_WEBCACHE_HPP
+#define NAZARA_NETWORK_WEBCACHE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Network/Config.hpp>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Nz
+{
+	class NAZARA_NETWORK_API WebCache
+	{
+		public:
+			struct Entry;
+
+			WebCache(std::filesystem::path directory);
+			WebCache(const WebCache&) = delete;
+			WebCache(WebCache&&) noexcept = default;
+			~WebCache() = default;
+
+			void Clear();
+
+			inline const std::filesystem::path& GetDirectory() const;
+
+			std::optional<Entry> Load(std::string_view url) const;
+
+			void Remove(std::string_view url);
+
+			bool Store(std::string_view url, const Entry& entry);
+
+			WebCache& operator=(const WebCache&) = delete;
+			WebCache& operator=(WebCache&&) noexcept = default;
+
+			static Int64 GetCurrentTimestamp();
+
+			struct Entry
+			{
+				inline bool IsFresh() const;
+
+				std::string body;
+				std::string etag;
+				std::string lastModified;
+				Int64 expirationTime = 0; //< unix timestamp (in seconds) until which the entry can be used without revalidation
+			};
+
+		private:
+			std::filesystem::path GetEntryPath(std::string_view url) const;
+
+			std::filesystem::path m_directory;
+	};
+}
+
+#include <Nazara/Network/WebCache.inl>
+
+#endif // NAZARA_NETWORK_WEBCACHE_HPP
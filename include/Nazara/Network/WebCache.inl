@@ -0,0 +1,20 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Network/Debug.hpp>
+
+namespace Nz
+{
+	inline const std::filesystem::path& WebCache::GetDirectory() const
+	{
+		return m_directory;
+	}
+
+	inline bool WebCache::Entry::IsFresh() const
+	{
+		return expirationTime > GetCurrentTimestamp();
+	}
+}
+
+#include <Nazara/Network/DebugOff.hpp>
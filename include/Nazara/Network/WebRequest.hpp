@@ -11,10 +11,13 @@
 #include <Nazara/Core/Clock.hpp>
 #include <Nazara/Network/Config.hpp>
 #include <Nazara/Network/Enums.hpp>
+#include <Nazara/Network/WebCache.hpp>
 #include <Nazara/Network/WebRequestResult.hpp>
 #include <NazaraUtils/MovablePtr.hpp>
 #include <functional>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 #ifndef NAZARA_PLATFORM_WEB
@@ -25,6 +28,7 @@ struct emscripten_fetch_attr_t;
 
 namespace Nz
 {
+	class Stream;
 	class WebService;
 
 	class NAZARA_NETWORK_API WebRequest
@@ -33,21 +37,28 @@ namespace Nz
 
 		public:
 			using DataCallback = std::function<bool(const void* data, std::size_t length)>;
+			using ProgressCallback = std::function<void(UInt64 downloadedSize, UInt64 totalSize)>;
 			using ResultCallback = std::function<void(WebRequestResult&& result)>;
+			using StreamingDataCallback = std::function<WebRequestDataStatus(const void* data, std::size_t length)>;
 
 			WebRequest(WebService& owner);
 			WebRequest(const WebRequest&) = delete;
 			WebRequest(WebRequest&&) = default;
 			~WebRequest();
 
+			inline void EnableCache(bool enable = true);
+
 			void ForceProtocol(NetProtocol protocol);
 
 			inline void SetDataCallback(DataCallback callback);
 			inline void SetHeader(std::string header, std::string value);
 			void SetJSonContent(std::string encodedJSon);
 			void SetMaximumFileSize(UInt64 maxFileSize);
+			inline void SetOutputStream(Stream& stream);
+			inline void SetProgressCallback(ProgressCallback callback);
 			inline void SetResultCallback(ResultCallback callback);
 			void SetServiceName(std::string serviceName);
+			inline void SetStreamingDataCallback(StreamingDataCallback callback);
 			void SetURL(const std::string& url);
 
 			void SetupGet();
@@ -57,9 +68,13 @@ namespace Nz
 			WebRequest& operator=(WebRequest&&) = default;
 
 		private:
-			inline bool OnBodyResponse(const char* data, std::size_t length);
+			inline bool IsCacheable() const;
+			inline WebRequestDataStatus OnBodyResponse(const char* data, std::size_t length);
 #ifndef NAZARA_PLATFORM_WEB
+			void OnHeaderResponse(std::string_view header);
 			CURL* Prepare();
+			void PrepareCacheRevalidation(WebCache::Entry&& cachedEntry);
+			void UpdateCache(WebCache& cache);
 #else
 			inline emscripten_fetch_t* GetFetchHandle() const;
 			inline Nz::Time GetRequestTime() const;
@@ -71,14 +86,16 @@ namespace Nz
 
 #ifdef NAZARA_PLATFORM_WEB
 			std::string m_httpMethod;
-			std::string m_url;
 			std::vector<const char*> m_requestHeaders;
 #endif
+			std::optional<WebCache::Entry> m_cachedEntry; //< entry being revalidated by this request
 			std::string m_content;
 			std::string m_responseBody;
+			std::string m_url;
 			std::unordered_map<std::string, std::string> m_headers;
 			WebService& m_webService;
-			DataCallback m_dataCallback;
+			ProgressCallback m_progressCallback;
+			StreamingDataCallback m_dataCallback;
 #ifndef NAZARA_PLATFORM_WEB
 			MovablePtr<CURL> m_curlHandle;
 			MovablePtr<curl_slist> m_headerList;
@@ -87,6 +104,11 @@ namespace Nz
 			MovablePtr<emscripten_fetch_t> m_fetchHandle;
 #endif
 			ResultCallback m_resultCallback;
+			WebCache::Entry m_responseCacheEntry; //< validators and expiration time of the response, without its body
+			bool m_isCacheEnabled;
+			bool m_isGetRequest;
+			bool m_isResponseFromCache;
+			bool m_isResponseStorable;
 			bool m_isUserAgentSet;
 	};
 }
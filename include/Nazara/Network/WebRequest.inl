@@ -2,13 +2,45 @@
 // This file is part of the "Nazara Engine - Network module"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
+#include <Nazara/Core/Stream.hpp>
 #include <Nazara/Network/Debug.hpp>
 
 namespace Nz
 {
+	/*!
+	* \brief Enables or disables the use of the WebService cache (if any) for this request
+	*
+	* Only GET requests whose body is not forwarded to a data callback or an output stream are cached, the cache is used by default.
+	*/
+	inline void WebRequest::EnableCache(bool enable)
+	{
+		m_isCacheEnabled = enable;
+	}
+
 	inline void WebRequest::SetDataCallback(DataCallback callback)
 	{
-		m_dataCallback = std::move(callback);
+		if (callback)
+		{
+			m_dataCallback = [callback = std::move(callback)](const void* data, std::size_t length)
+			{
+				return (callback(data, length)) ? WebRequestDataStatus::Continue : WebRequestDataStatus::Abort;
+			};
+		}
+		else
+			m_dataCallback = nullptr;
+	}
+
+	inline void WebRequest::SetOutputStream(Stream& stream)
+	{
+		m_dataCallback = [&stream](const void* data, std::size_t length)
+		{
+			return (stream.Write(data, length) == length) ? WebRequestDataStatus::Continue : WebRequestDataStatus::Abort;
+		};
+	}
+
+	inline void WebRequest::SetProgressCallback(ProgressCallback callback)
+	{
+		m_progressCallback = std::move(callback);
 	}
 
 	inline void WebRequest::SetResultCallback(ResultCallback callback)
@@ -20,13 +52,23 @@ namespace Nz
 	{
 		m_headers.insert_or_assign(std::move(header), std::move(value));
 	}
-	
-	inline bool WebRequest::OnBodyResponse(const char* data, std::size_t length)
+
+	inline void WebRequest::SetStreamingDataCallback(StreamingDataCallback callback)
+	{
+		m_dataCallback = std::move(callback);
+	}
+
+	inline bool WebRequest::IsCacheable() const
+	{
+		return m_isCacheEnabled && m_isGetRequest && !m_dataCallback;
+	}
+
+	inline WebRequestDataStatus WebRequest::OnBodyResponse(const char* data, std::size_t length)
 	{
 		if (!m_dataCallback)
 		{
 			m_responseBody.append(data, length);
-			return true;
+			return WebRequestDataStatus::Continue;
 		}
 
 		return m_dataCallback(data, length);
@@ -52,7 +94,7 @@ namespace Nz
 	inline void WebRequest::TriggerErrorCallback(std::string errorMessage)
 	{
 #ifndef NAZARA_PLATFORM_WEB
-		m_resultCallback(WebRequestResult(m_webService, Nz::Err(std::move(errorMessage)), m_curlHandle.Get()));
+		m_resultCallback(WebRequestResult(m_webService, Nz::Err(std::move(errorMessage)), m_curlHandle.Get(), false));
 #else
 		m_resultCallback(WebRequestResult(m_webService, Nz::Err(std::move(errorMessage)), m_fetchHandle.Get(), m_clock.GetElapsedTime()));
 #endif
@@ -61,7 +103,7 @@ namespace Nz
 	inline void WebRequest::TriggerSuccessCallback()
 	{
 #ifndef NAZARA_PLATFORM_WEB
-		m_resultCallback(WebRequestResult(m_webService, Nz::Ok(std::move(m_responseBody)), m_curlHandle.Get()));
+		m_resultCallback(WebRequestResult(m_webService, Nz::Ok(std::move(m_responseBody)), m_curlHandle.Get(), m_isResponseFromCache));
 #else
 		m_resultCallback(WebRequestResult(m_webService, Nz::Ok(std::move(m_responseBody)), m_fetchHandle.Get(), m_clock.GetElapsedTime()));
 #endif
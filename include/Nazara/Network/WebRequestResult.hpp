@@ -43,6 +43,8 @@ namespace Nz
 
 			inline bool HasSucceeded() const;
 
+			inline bool IsFromCache() const;
+
 			inline explicit operator bool() const;
 
 			WebRequestResult& operator=(const WebRequestResult&) = delete;
@@ -50,7 +52,7 @@ namespace Nz
 
 		private:
 #ifndef NAZARA_PLATFORM_WEB
-			inline WebRequestResult(WebService& webService, Result<std::string, std::string>&& bodyResult, CURL* curl);
+			inline WebRequestResult(WebService& webService, Result<std::string, std::string>&& bodyResult, CURL* curl, bool isFromCache);
 #else
 			inline WebRequestResult(WebService& webService, Result<std::string, std::string>&& bodyResult, emscripten_fetch_t* fetchHandle, Time downloadTime);
 #endif
@@ -65,6 +67,7 @@ namespace Nz
 #ifdef NAZARA_PLATFORM_WEB
 			Time m_downloadTime;
 #endif
+			bool m_isFromCache;
 
 	};
 }
@@ -8,10 +8,11 @@
 namespace Nz
 {
 #ifndef NAZARA_PLATFORM_WEB
-	inline WebRequestResult::WebRequestResult(WebService& webService, Result<std::string, std::string>&& bodyResult, CURL* curl) :
+	inline WebRequestResult::WebRequestResult(WebService& webService, Result<std::string, std::string>&& bodyResult, CURL* curl, bool isFromCache) :
 	m_curlHandle(curl),
 	m_webService(webService),
-	m_bodyResult(std::move(bodyResult))
+	m_bodyResult(std::move(bodyResult)),
+	m_isFromCache(isFromCache)
 	{
 	}
 #else
@@ -19,7 +20,8 @@ namespace Nz
 	m_fetchHandle(fetchHandle),
 	m_webService(webService),
 	m_bodyResult(std::move(bodyResult)),
-	m_downloadTime(downloadTime)
+	m_downloadTime(downloadTime),
+	m_isFromCache(false)
 	{
 	}
 #endif
@@ -47,6 +49,16 @@ namespace Nz
 		return m_bodyResult.IsOk();
 	}
 
+	/*!
+	* \brief Returns true if the body comes from the WebService cache, either without any transfer or after the server answered it was not modified
+	*
+	* Status code of such results is always 200.
+	*/
+	inline bool WebRequestResult::IsFromCache() const
+	{
+		return m_isFromCache;
+	}
+
 	inline WebRequestResult::operator bool() const
 	{
 		return HasSucceeded();
@@ -10,6 +10,8 @@
 #include <Nazara/Network/Config.hpp>
 #include <Nazara/Network/WebRequest.hpp>
 #include <NazaraUtils/MovablePtr.hpp>
+#include <filesystem>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -42,12 +44,23 @@ namespace Nz
 			inline std::unique_ptr<WebRequest> CreateGetRequest(const std::string& url, WebRequest::ResultCallback callback);
 			inline std::unique_ptr<WebRequest> CreatePostRequest(const std::string& url, WebRequest::ResultCallback callback);
 
+			void DisableCache();
+
+			void EnableCache(std::filesystem::path cacheDirectory);
+			void EnableMultiplexing(bool enable = true);
+
+			inline WebCache* GetCache();
+			inline const WebCache* GetCache() const;
 			inline const std::string& GetUserAgent() const;
 
 			bool Poll();
 
 			void QueueRequest(std::unique_ptr<WebRequest>&& request);
 
+			void SetConnectionCacheSize(std::size_t connectionCount);
+			void SetMaxHostConnections(std::size_t connectionCount);
+			void SetMaxTotalConnections(std::size_t connectionCount);
+
 			WebService& operator=(const WebService&) = delete;
 			WebService& operator=(WebService&&) = delete;
 
@@ -57,8 +70,11 @@ namespace Nz
 #endif
 
 			std::string m_userAgent;
+			std::unique_ptr<WebCache> m_cache;
 #ifndef NAZARA_PLATFORM_WEB
 			std::unordered_map<CURL*, std::unique_ptr<WebRequest>> m_activeRequests;
+			std::vector<std::unique_ptr<WebRequest>> m_cachedRequests;
+			std::vector<CURL*> m_pausedRequests;
 			const CurlLibrary& m_curl;
 			MovablePtr<CURLM> m_curlMulti;
 #else
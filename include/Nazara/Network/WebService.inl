@@ -31,6 +31,16 @@ namespace Nz
 		return request;
 	}
 
+	inline WebCache* WebService::GetCache()
+	{
+		return m_cache.get();
+	}
+
+	inline const WebCache* WebService::GetCache() const
+	{
+		return m_cache.get();
+	}
+
 	inline const std::string& WebService::GetUserAgent() const
 	{
 		return m_userAgent;
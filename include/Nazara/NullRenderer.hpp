@@ -0,0 +1,52 @@
+// this file was automatically generated and should not be edited
+
+/*
+	Nazara Engine - Null renderer
+
+	Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to
+	use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+	of the Software, and to permit persons to whom the Software is furnished to do
+	so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#pragma once
+
+#ifndef NAZARA_GLOBAL_NULLRENDERER_HPP
+#define NAZARA_GLOBAL_NULLRENDERER_HPP
+
+#include <Nazara/NullRenderer/Config.hpp>
+#include <Nazara/NullRenderer/NullBuffer.hpp>
+#include <Nazara/NullRenderer/NullCommandBuffer.hpp>
+#include <Nazara/NullRenderer/NullCommandBufferBuilder.hpp>
+#include <Nazara/NullRenderer/NullCommandPool.hpp>
+#include <Nazara/NullRenderer/NullComputePipeline.hpp>
+#include <Nazara/NullRenderer/NullDevice.hpp>
+#include <Nazara/NullRenderer/NullFramebuffer.hpp>
+#include <Nazara/NullRenderer/NullRenderer.hpp>
+#include <Nazara/NullRenderer/NullRenderImage.hpp>
+#include <Nazara/NullRenderer/NullRenderPass.hpp>
+#include <Nazara/NullRenderer/NullRenderPipeline.hpp>
+#include <Nazara/NullRenderer/NullRenderPipelineLayout.hpp>
+#include <Nazara/NullRenderer/NullShaderBinding.hpp>
+#include <Nazara/NullRenderer/NullShaderModule.hpp>
+#include <Nazara/NullRenderer/NullSwapchain.hpp>
+#include <Nazara/NullRenderer/NullTexture.hpp>
+#include <Nazara/NullRenderer/NullTextureSampler.hpp>
+#include <Nazara/NullRenderer/NullUploadPool.hpp>
+
+#endif // NAZARA_GLOBAL_NULLRENDERER_HPP
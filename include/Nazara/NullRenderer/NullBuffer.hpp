@@ -0,0 +1,44 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NULLRENDERER_NULLBUFFER_HPP
+#define NAZARA_NULLRENDERER_NULLBUFFER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/NullRenderer/Config.hpp>
+#include <Nazara/Renderer/RenderBuffer.hpp>
+#include <memory>
+
+namespace Nz
+{
+	class NullDevice;
+
+	class NAZARA_NULLRENDERER_API NullBuffer : public RenderBuffer
+	{
+		public:
+			NullBuffer(NullDevice& device, BufferType type, UInt64 size, BufferUsageFlags usage, const void* initialData = nullptr);
+			NullBuffer(const NullBuffer&) = delete;
+			NullBuffer(NullBuffer&&) = delete;
+			~NullBuffer() = default;
+
+			bool Fill(const void* data, UInt64 offset, UInt64 size) override;
+
+			void* Map(UInt64 offset, UInt64 size) override;
+			bool Unmap() override;
+
+			void UpdateDebugName(std::string_view name) override;
+
+			NullBuffer& operator=(const NullBuffer&) = delete;
+			NullBuffer& operator=(NullBuffer&&) = delete;
+
+		private:
+			std::unique_ptr<UInt8[]> m_buffer;
+	};
+}
+
+#include <Nazara/NullRenderer/NullBuffer.inl>
+
+#endif // NAZARA_NULLRENDERER_NULLBUFFER_HPP
@@ -0,0 +1,36 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NULLRENDERER_NULLCOMMANDBUFFER_HPP
+#define NAZARA_NULLRENDERER_NULLCOMMANDBUFFER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/NullRenderer/Config.hpp>
+#include <Nazara/Renderer/CommandBuffer.hpp>
+
+namespace Nz
+{
+	class NAZARA_NULLRENDERER_API NullCommandBuffer final : public CommandBuffer
+	{
+		public:
+			NullCommandBuffer() = default;
+			NullCommandBuffer(const NullCommandBuffer&) = delete;
+			NullCommandBuffer(NullCommandBuffer&&) = delete;
+			~NullCommandBuffer() = default;
+
+			void UpdateDebugName(std::string_view name) override;
+
+			NullCommandBuffer& operator=(const NullCommandBuffer&) = delete;
+			NullCommandBuffer& operator=(NullCommandBuffer&&) = delete;
+
+		private:
+			void Release() override;
+	};
+}
+
+#include <Nazara/NullRenderer/NullCommandBuffer.inl>
+
+#endif // NAZARA_NULLRENDERER_NULLCOMMANDBUFFER_HPP
@@ -0,0 +1,79 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NULLRENDERER_NULLCOMMANDBUFFERBUILDER_HPP
+#define NAZARA_NULLRENDERER_NULLCOMMANDBUFFERBUILDER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/NullRenderer/Config.hpp>
+#include <Nazara/Renderer/CommandBufferBuilder.hpp>
+
+namespace Nz
+{
+	class NAZARA_NULLRENDERER_API NullCommandBufferBuilder final : public CommandBufferBuilder
+	{
+		public:
+			NullCommandBufferBuilder() = default;
+			NullCommandBufferBuilder(const NullCommandBufferBuilder&) = delete;
+			NullCommandBufferBuilder(NullCommandBufferBuilder&&) noexcept = default;
+			~NullCommandBufferBuilder() = default;
+
+			void BeginDebugRegion(std::string_view regionName, const Color& color) override;
+			void BeginRenderPass(const Framebuffer& framebuffer, const RenderPass& renderPass, const Recti& renderRect, const ClearValues* clearValues, std::size_t clearValueCount) override;
+
+			void BindComputePipeline(const ComputePipeline& pipeline) override;
+			void BindComputeShaderBinding(UInt32 set, const ShaderBinding& binding) override;
+			void BindComputeShaderBinding(const RenderPipelineLayout& pipelineLayout, UInt32 set, const ShaderBinding& binding) override;
+			void BindIndexBuffer(const RenderBuffer& indexBuffer, IndexType indexType, UInt64 offset = 0) override;
+			void BindRenderPipeline(const RenderPipeline& pipeline) override;
+			void BindRenderShaderBinding(UInt32 set, const ShaderBinding& binding) override;
+			void BindRenderShaderBinding(const RenderPipelineLayout& pipelineLayout, UInt32 set, const ShaderBinding& binding) override;
+			void BindVertexBuffer(UInt32 binding, const RenderBuffer& vertexBuffer, UInt64 offset = 0) override;
+
+			void BlitTexture(const Texture& fromTexture, const Boxui& fromBox, TextureLayout fromLayout, const Texture& toTexture, const Boxui& toBox, TextureLayout toLayout, SamplerFilter filter) override;
+
+			void BuildMipmaps(Texture& texture, UInt8 baseLevel, UInt8 levelCount, PipelineStageFlags srcStageMask, PipelineStageFlags dstStageMask, MemoryAccessFlags srcAccessMask, MemoryAccessFlags dstAccessMask, TextureLayout oldLayout, TextureLayout newLayout) override;
+
+			void CopyBuffer(const RenderBufferView& source, const RenderBufferView& target, UInt64 size, UInt64 sourceOffset = 0, UInt64 targetOffset = 0) override;
+			void CopyBuffer(const UploadPool::Allocation& allocation, const RenderBufferView& target, UInt64 size, UInt64 sourceOffset = 0, UInt64 targetOffset = 0) override;
+			void CopyTexture(const Texture& fromTexture, const Boxui& fromBox, TextureLayout fromLayout, const Texture& toTexture, const Vector3ui& toPos, TextureLayout toLayout) override;
+
+			void Dispatch(UInt32 workgroupX, UInt32 workgroupY, UInt32 workgroupZ) override;
+
+			void Draw(UInt32 vertexCount, UInt32 instanceCount = 1, UInt32 firstVertex = 0, UInt32 firstInstance = 0) override;
+			void DrawIndexed(UInt32 indexCount, UInt32 instanceCount = 1, UInt32 firstIndex = 0, UInt32 firstInstance = 0) override;
+			void DrawIndexedIndirect(const RenderBufferView& indirectBuffer, UInt32 drawCount, UInt32 stride = sizeof(DrawIndexedIndirectCommand)) override;
+			void DrawIndexedIndirectCount(const RenderBufferView& indirectBuffer, const RenderBufferView& countBuffer, UInt32 maxDrawCount, UInt32 stride = sizeof(DrawIndexedIndirectCommand)) override;
+
+			void EndDebugRegion() override;
+			void EndRenderPass() override;
+
+			void InsertDebugLabel(std::string_view label, const Color& color) override;
+
+			void MemoryBarrier(PipelineStageFlags srcStageMask, PipelineStageFlags dstStageMask, MemoryAccessFlags srcAccessMask, MemoryAccessFlags dstAccessMask) override;
+
+			void NextSubpass() override;
+
+			void PreTransferBarrier() override;
+			void PostTransferBarrier() override;
+
+			void PushConstants(const RenderPipelineLayout& pipelineLayout, UInt32 offset, UInt32 size, const void* data) override;
+
+			void SetScissor(const Recti& scissorRegion) override;
+			void SetViewport(const Recti& viewportRegion) override;
+
+			void TextureAcquireBarrier(PipelineStageFlags srcStageMask, PipelineStageFlags dstStageMask, MemoryAccessFlags srcAccessMask, MemoryAccessFlags dstAccessMask, TextureLayout oldLayout, TextureLayout newLayout, QueueType srcQueue, QueueType dstQueue, const Texture& texture) override;
+			void TextureBarrier(PipelineStageFlags srcStageMask, PipelineStageFlags dstStageMask, MemoryAccessFlags srcAccessMask, MemoryAccessFlags dstAccessMask, TextureLayout oldLayout, TextureLayout newLayout, const Texture& texture) override;
+			void TextureReleaseBarrier(PipelineStageFlags srcStageMask, PipelineStageFlags dstStageMask, MemoryAccessFlags srcAccessMask, MemoryAccessFlags dstAccessMask, TextureLayout oldLayout, TextureLayout newLayout, QueueType srcQueue, QueueType dstQueue, const Texture& texture) override;
+
+			NullCommandBufferBuilder& operator=(const NullCommandBufferBuilder&) = delete;
+			NullCommandBufferBuilder& operator=(NullCommandBufferBuilder&&) = delete;
+	};
+}
+
+#include <Nazara/NullRenderer/NullCommandBufferBuilder.inl>
+
+#endif // NAZARA_NULLRENDERER_NULLCOMMANDBUFFERBUILDER_HPP
@@ -0,0 +1,35 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NULLRENDERER_NULLCOMMANDPOOL_HPP
+#define NAZARA_NULLRENDERER_NULLCOMMANDPOOL_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/NullRenderer/Config.hpp>
+#include <Nazara/Renderer/CommandPool.hpp>
+
+namespace Nz
+{
+	class NAZARA_NULLRENDERER_API NullCommandPool final : public CommandPool
+	{
+		public:
+			NullCommandPool() = default;
+			NullCommandPool(const NullCommandPool&) = delete;
+			NullCommandPool(NullCommandPool&&) noexcept = default;
+			~NullCommandPool() = default;
+
+			CommandBufferPtr BuildCommandBuffer(const std::function<void(CommandBufferBuilder& builder)>& callback) override;
+
+			void UpdateDebugName(std::string_view name) override;
+
+			NullCommandPool& operator=(const NullCommandPool&) = delete;
+			NullCommandPool& operator=(NullCommandPool&&) = delete;
+	};
+}
+
+#include <Nazara/NullRenderer/NullCommandPool.inl>
+
+#endif // NAZARA_NULLRENDERER_NULLCOMMANDPOOL_HPP
@@ -0,0 +1,38 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NULLRENDERER_NULLCOMPUTEPIPELINE_HPP
+#define NAZARA_NULLRENDERER_NULLCOMPUTEPIPELINE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/NullRenderer/Config.hpp>
+#include <Nazara/Renderer/ComputePipeline.hpp>
+
+namespace Nz
+{
+	class NAZARA_NULLRENDERER_API NullComputePipeline : public ComputePipeline
+	{
+		public:
+			inline NullComputePipeline(ComputePipelineInfo pipelineInfo);
+			NullComputePipeline(const NullComputePipeline&) = delete;
+			NullComputePipeline(NullComputePipeline&&) = delete;
+			~NullComputePipeline() = default;
+
+			const ComputePipelineInfo& GetPipelineInfo() const override;
+
+			void UpdateDebugName(std::string_view name) override;
+
+			NullComputePipeline& operator=(const NullComputePipeline&) = delete;
+			NullComputePipeline& operator=(NullComputePipeline&&) = delete;
+
+		private:
+			ComputePipelineInfo m_pipelineInfo;
+	};
+}
+
+#include <Nazara/NullRenderer/NullComputePipeline.inl>
+
+#endif // NAZARA_NULLRENDERER_NULLCOMPUTEPIPELINE_HPP
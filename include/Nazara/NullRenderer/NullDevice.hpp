@@ -0,0 +1,60 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NULLRENDERER_NULLDEVICE_HPP
+#define NAZARA_NULLRENDERER_NULLDEVICE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/NullRenderer/Config.hpp>
+#include <Nazara/Renderer/RenderDevice.hpp>
+#include <Nazara/Renderer/RenderDeviceInfo.hpp>
+
+namespace Nz
+{
+	class NAZARA_NULLRENDERER_API NullDevice : public RenderDevice
+	{
+		public:
+			NullDevice(const RenderDeviceInfo& deviceInfo, const RenderDeviceFeatures& enabledFeatures);
+			NullDevice(const NullDevice&) = delete;
+			NullDevice(NullDevice&&) = delete;
+			~NullDevice() = default;
+
+			const RenderDeviceInfo& GetDeviceInfo() const override;
+			const RenderDeviceFeatures& GetEnabledFeatures() const override;
+
+			std::shared_ptr<RenderBuffer> InstantiateBuffer(BufferType type, UInt64 size, BufferUsageFlags usageFlags, const void* initialData = nullptr) override;
+			std::shared_ptr<CommandPool> InstantiateCommandPool(QueueType queueType) override;
+			std::shared_ptr<ComputePipeline> InstantiateComputePipeline(ComputePipelineInfo pipelineInfo) override;
+			std::shared_ptr<Framebuffer> InstantiateFramebuffer(unsigned int width, unsigned int height, const std::shared_ptr<RenderPass>& renderPass, const std::vector<std::shared_ptr<Texture>>& attachments) override;
+			std::shared_ptr<RenderPass> InstantiateRenderPass(std::vector<RenderPass::Attachment> attachments, std::vector<RenderPass::SubpassDescription> subpassDescriptions, std::vector<RenderPass::SubpassDependency> subpassDependencies) override;
+			std::shared_ptr<RenderPipeline> InstantiateRenderPipeline(RenderPipelineInfo pipelineInfo) override;
+			std::shared_ptr<RenderPipelineLayout> InstantiateRenderPipelineLayout(RenderPipelineLayoutInfo pipelineLayoutInfo) override;
+			std::shared_ptr<ShaderModule> InstantiateShaderModule(nzsl::ShaderStageTypeFlags shaderStages, const nzsl::Ast::Module& shaderModule, const nzsl::ShaderWriter::States& states) override;
+			std::shared_ptr<ShaderModule> InstantiateShaderModule(nzsl::ShaderStageTypeFlags shaderStages, ShaderLanguage lang, const void* source, std::size_t sourceSize, const nzsl::ShaderWriter::States& states) override;
+			std::shared_ptr<Swapchain> InstantiateSwapchain(WindowHandle windowHandle, const Vector2ui& windowSize, const SwapchainParameters& parameters) override;
+			std::shared_ptr<Texture> InstantiateTexture(const TextureInfo& params) override;
+			std::shared_ptr<Texture> InstantiateTexture(const TextureInfo& params, const void* initialData, bool buildMipmaps, unsigned int srcWidth = 0, unsigned int srcHeight = 0) override;
+			std::shared_ptr<TextureSampler> InstantiateTextureSampler(const TextureSamplerInfo& params) override;
+
+			bool IsParallelCommandRecordingSupported() const override;
+			bool IsTextureFormatSupported(PixelFormat format, TextureUsage usage) const override;
+
+			void WaitForIdle() override;
+
+			NullDevice& operator=(const NullDevice&) = delete;
+			NullDevice& operator=(NullDevice&&) = delete;
+
+			static RenderDeviceInfo BuildDeviceInfo();
+
+		private:
+			RenderDeviceFeatures m_enabledFeatures;
+			RenderDeviceInfo m_deviceInfo;
+	};
+}
+
+#include <Nazara/NullRenderer/NullDevice.inl>
+
+#endif // NAZARA_NULLRENDERER_NULLDEVICE_HPP
@@ -0,0 +1,33 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NULLRENDERER_NULLFRAMEBUFFER_HPP
+#define NAZARA_NULLRENDERER_NULLFRAMEBUFFER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/NullRenderer/Config.hpp>
+#include <Nazara/Renderer/Framebuffer.hpp>
+
+namespace Nz
+{
+	class NAZARA_NULLRENDERER_API NullFramebuffer : public Framebuffer
+	{
+		public:
+			inline NullFramebuffer(FramebufferType type);
+			NullFramebuffer(const NullFramebuffer&) = delete;
+			NullFramebuffer(NullFramebuffer&&) noexcept = default;
+			~NullFramebuffer() = default;
+
+			void UpdateDebugName(std::string_view name) override;
+
+			NullFramebuffer& operator=(const NullFramebuffer&) = delete;
+			NullFramebuffer& operator=(NullFramebuffer&&) noexcept = default;
+	};
+}
+
+#include <Nazara/NullRenderer/NullFramebuffer.inl>
+
+#endif // NAZARA_NULLRENDERER_NULLFRAMEBUFFER_HPP
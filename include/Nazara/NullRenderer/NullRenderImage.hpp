@@ -0,0 +1,41 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NULLRENDERER_NULLRENDERIMAGE_HPP
+#define NAZARA_NULLRENDERER_NULLRENDERIMAGE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/NullRenderer/Config.hpp>
+#include <Nazara/NullRenderer/NullUploadPool.hpp>
+#include <Nazara/Renderer/RenderImage.hpp>
+
+namespace Nz
+{
+	class NullSwapchain;
+
+	class NAZARA_NULLRENDERER_API NullRenderImage : public RenderImage
+	{
+		public:
+			NullRenderImage(NullSwapchain& owner);
+
+			void Execute(const FunctionRef<void(CommandBufferBuilder& builder)>& callback, QueueTypeFlags queueTypeFlags) override;
+
+			NullUploadPool& GetUploadPool() override;
+
+			void Present() override;
+
+			void SubmitCommandBuffer(CommandBuffer* commandBuffer, QueueTypeFlags queueTypeFlags) override;
+			void SynchronizeQueues(QueueType waitingQueue, QueueType signalingQueue) override;
+
+		private:
+			NullSwapchain& m_owner;
+			NullUploadPool m_uploadPool;
+	};
+}
+
+#include <Nazara/NullRenderer/NullRenderImage.inl>
+
+#endif // NAZARA_NULLRENDERER_NULLRENDERIMAGE_HPP
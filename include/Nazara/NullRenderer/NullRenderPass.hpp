@@ -0,0 +1,33 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NULLRENDERER_NULLRENDERPASS_HPP
+#define NAZARA_NULLRENDERER_NULLRENDERPASS_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/NullRenderer/Config.hpp>
+#include <Nazara/Renderer/RenderPass.hpp>
+
+namespace Nz
+{
+	class NAZARA_NULLRENDERER_API NullRenderPass final : public RenderPass
+	{
+		public:
+			using RenderPass::RenderPass;
+			NullRenderPass(const NullRenderPass&) = delete;
+			NullRenderPass(NullRenderPass&&) noexcept = default;
+			~NullRenderPass() = default;
+
+			void UpdateDebugName(std::string_view name) override;
+
+			NullRenderPass& operator=(const NullRenderPass&) = delete;
+			NullRenderPass& operator=(NullRenderPass&&) noexcept = default;
+	};
+}
+
+#include <Nazara/NullRenderer/NullRenderPass.inl>
+
+#endif // NAZARA_NULLRENDERER_NULLRENDERPASS_HPP
@@ -0,0 +1,38 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NULLRENDERER_NULLRENDERPIPELINE_HPP
+#define NAZARA_NULLRENDERER_NULLRENDERPIPELINE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/NullRenderer/Config.hpp>
+#include <Nazara/Renderer/RenderPipeline.hpp>
+
+namespace Nz
+{
+	class NAZARA_NULLRENDERER_API NullRenderPipeline : public RenderPipeline
+	{
+		public:
+			inline NullRenderPipeline(RenderPipelineInfo pipelineInfo);
+			NullRenderPipeline(const NullRenderPipeline&) = delete;
+			NullRenderPipeline(NullRenderPipeline&&) = delete;
+			~NullRenderPipeline() = default;
+
+			const RenderPipelineInfo& GetPipelineInfo() const override;
+
+			void UpdateDebugName(std::string_view name) override;
+
+			NullRenderPipeline& operator=(const NullRenderPipeline&) = delete;
+			NullRenderPipeline& operator=(NullRenderPipeline&&) = delete;
+
+		private:
+			RenderPipelineInfo m_pipelineInfo;
+	};
+}
+
+#include <Nazara/NullRenderer/NullRenderPipeline.inl>
+
+#endif // NAZARA_NULLRENDERER_NULLRENDERPIPELINE_HPP
@@ -0,0 +1,15 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/NullRenderer/Debug.hpp>
+
+namespace Nz
+{
+	inline NullRenderPipeline::NullRenderPipeline(RenderPipelineInfo pipelineInfo) :
+	m_pipelineInfo(std::move(pipelineInfo))
+	{
+	}
+}
+
+#include <Nazara/NullRenderer/DebugOff.hpp>
@@ -0,0 +1,45 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NULLRENDERER_NULLRENDERPIPELINELAYOUT_HPP
+#define NAZARA_NULLRENDERER_NULLRENDERPIPELINELAYOUT_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/NullRenderer/Config.hpp>
+#include <Nazara/NullRenderer/NullShaderBinding.hpp>
+#include <Nazara/Renderer/RenderPipelineLayout.hpp>
+
+namespace Nz
+{
+	class NAZARA_NULLRENDERER_API NullRenderPipelineLayout : public RenderPipelineLayout
+	{
+		friend NullShaderBinding;
+
+		public:
+			inline NullRenderPipelineLayout(RenderPipelineLayoutInfo layoutInfo);
+			NullRenderPipelineLayout(const NullRenderPipelineLayout&) = delete;
+			NullRenderPipelineLayout(NullRenderPipelineLayout&&) = delete;
+			~NullRenderPipelineLayout() = default;
+
+			ShaderBindingPtr AllocateShaderBinding(UInt32 setIndex) override;
+
+			inline const RenderPipelineLayoutInfo& GetLayoutInfo() const;
+
+			void UpdateDebugName(std::string_view name) override;
+
+			NullRenderPipelineLayout& operator=(const NullRenderPipelineLayout&) = delete;
+			NullRenderPipelineLayout& operator=(NullRenderPipelineLayout&&) = delete;
+
+		private:
+			void Release(ShaderBinding& binding);
+
+			RenderPipelineLayoutInfo m_layoutInfo;
+	};
+}
+
+#include <Nazara/NullRenderer/NullRenderPipelineLayout.inl>
+
+#endif // NAZARA_NULLRENDERER_NULLRENDERPIPELINELAYOUT_HPP
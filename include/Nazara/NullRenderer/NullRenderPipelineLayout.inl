@@ -0,0 +1,20 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/NullRenderer/Debug.hpp>
+
+namespace Nz
+{
+	inline NullRenderPipelineLayout::NullRenderPipelineLayout(RenderPipelineLayoutInfo layoutInfo) :
+	m_layoutInfo(std::move(layoutInfo))
+	{
+	}
+
+	inline const RenderPipelineLayoutInfo& NullRenderPipelineLayout::GetLayoutInfo() const
+	{
+		return m_layoutInfo;
+	}
+}
+
+#include <Nazara/NullRenderer/DebugOff.hpp>
@@ -0,0 +1,40 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NULLRENDERER_NULLRENDERER_HPP
+#define NAZARA_NULLRENDERER_NULLRENDERER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/NullRenderer/Config.hpp>
+#include <Nazara/NullRenderer/NullDevice.hpp>
+#include <Nazara/Renderer/RendererImpl.hpp>
+#include <memory>
+
+namespace Nz
+{
+	class NAZARA_NULLRENDERER_API NullRenderer : public RendererImpl
+	{
+		public:
+			NullRenderer() = default;
+			~NullRenderer() = default;
+
+			std::shared_ptr<RenderDevice> InstanciateRenderDevice(std::size_t deviceIndex, const RenderDeviceFeatures& enabledFeatures) override;
+
+			RenderAPI QueryAPI() const override;
+			std::string QueryAPIString() const override;
+			UInt32 QueryAPIVersion() const override;
+			const std::vector<RenderDeviceInfo>& QueryRenderDevices() const override;
+
+			bool Prepare(const Renderer::Config& config) override;
+
+		private:
+			std::vector<RenderDeviceInfo> m_deviceInfos;
+	};
+}
+
+#include <Nazara/NullRenderer/NullRenderer.inl>
+
+#endif // NAZARA_NULLRENDERER_NULLRENDERER_HPP
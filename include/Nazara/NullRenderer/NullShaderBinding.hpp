@@ -0,0 +1,46 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NULLRENDERER_NULLSHADERBINDING_HPP
+#define NAZARA_NULLRENDERER_NULLSHADERBINDING_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/NullRenderer/Config.hpp>
+#include <Nazara/Renderer/ShaderBinding.hpp>
+
+namespace Nz
+{
+	class NullRenderPipelineLayout;
+
+	class NAZARA_NULLRENDERER_API NullShaderBinding : public ShaderBinding
+	{
+		public:
+			inline NullShaderBinding(NullRenderPipelineLayout& owner);
+			NullShaderBinding(const NullShaderBinding&) = delete;
+			NullShaderBinding(NullShaderBinding&&) = delete;
+			~NullShaderBinding() = default;
+
+			inline NullRenderPipelineLayout& GetOwner();
+			inline const NullRenderPipelineLayout& GetOwner() const;
+
+			using ShaderBinding::Update;
+			void Update(const Binding* bindings, std::size_t bindingCount) override;
+
+			void UpdateDebugName(std::string_view name) override;
+
+			NullShaderBinding& operator=(const NullShaderBinding&) = delete;
+			NullShaderBinding& operator=(NullShaderBinding&&) = delete;
+
+		private:
+			void Release() override;
+
+			NullRenderPipelineLayout& m_owner;
+	};
+}
+
+#include <Nazara/NullRenderer/NullShaderBinding.inl>
+
+#endif // NAZARA_NULLRENDERER_NULLSHADERBINDING_HPP
@@ -0,0 +1,25 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/NullRenderer/Debug.hpp>
+
+namespace Nz
+{
+	inline NullShaderBinding::NullShaderBinding(NullRenderPipelineLayout& owner) :
+	m_owner(owner)
+	{
+	}
+
+	inline NullRenderPipelineLayout& NullShaderBinding::GetOwner()
+	{
+		return m_owner;
+	}
+
+	inline const NullRenderPipelineLayout& NullShaderBinding::GetOwner() const
+	{
+		return m_owner;
+	}
+}
+
+#include <Nazara/NullRenderer/DebugOff.hpp>
@@ -0,0 +1,39 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NULLRENDERER_NULLSHADERMODULE_HPP
+#define NAZARA_NULLRENDERER_NULLSHADERMODULE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/NullRenderer/Config.hpp>
+#include <Nazara/Renderer/ShaderModule.hpp>
+#include <NZSL/Enums.hpp>
+
+namespace Nz
+{
+	class NAZARA_NULLRENDERER_API NullShaderModule : public ShaderModule
+	{
+		public:
+			inline NullShaderModule(nzsl::ShaderStageTypeFlags shaderStages);
+			NullShaderModule(const NullShaderModule&) = delete;
+			NullShaderModule(NullShaderModule&&) noexcept = default;
+			~NullShaderModule() = default;
+
+			inline nzsl::ShaderStageTypeFlags GetShaderStages() const;
+
+			void UpdateDebugName(std::string_view name) override;
+
+			NullShaderModule& operator=(const NullShaderModule&) = delete;
+			NullShaderModule& operator=(NullShaderModule&&) noexcept = default;
+
+		private:
+			nzsl::ShaderStageTypeFlags m_shaderStages;
+	};
+}
+
+#include <Nazara/NullRenderer/NullShaderModule.inl>
+
+#endif // NAZARA_NULLRENDERER_NULLSHADERMODULE_HPP
@@ -0,0 +1,20 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/NullRenderer/Debug.hpp>
+
+namespace Nz
+{
+	inline NullShaderModule::NullShaderModule(nzsl::ShaderStageTypeFlags shaderStages) :
+	m_shaderStages(shaderStages)
+	{
+	}
+
+	inline nzsl::ShaderStageTypeFlags NullShaderModule::GetShaderStages() const
+	{
+		return m_shaderStages;
+	}
+}
+
+#include <Nazara/NullRenderer/DebugOff.hpp>
@@ -0,0 +1,65 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NULLRENDERER_NULLSWAPCHAIN_HPP
+#define NAZARA_NULLRENDERER_NULLSWAPCHAIN_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/NullRenderer/Config.hpp>
+#include <Nazara/NullRenderer/NullFramebuffer.hpp>
+#include <Nazara/NullRenderer/NullRenderImage.hpp>
+#include <Nazara/NullRenderer/NullRenderPass.hpp>
+#include <Nazara/Renderer/Swapchain.hpp>
+#include <Nazara/Renderer/SwapchainParameters.hpp>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace Nz
+{
+	class NullDevice;
+
+	class NAZARA_NULLRENDERER_API NullSwapchain final : public Swapchain
+	{
+		public:
+			NullSwapchain(NullDevice& device, const Vector2ui& size, const SwapchainParameters& parameters);
+			~NullSwapchain() = default;
+
+			RenderFrame AcquireFrame() override;
+
+			std::shared_ptr<CommandPool> CreateCommandPool(QueueType queueType) override;
+
+			inline NullDevice& GetDevice();
+			const NullFramebuffer& GetFramebuffer(std::size_t i) const override;
+			std::size_t GetFramebufferCount() const override;
+			PresentMode GetPresentMode() const override;
+			const NullRenderPass& GetRenderPass() const override;
+			const Vector2ui& GetSize() const override;
+			PresentModeFlags GetSupportedPresentModes() const override;
+
+			void NotifyResize(const Vector2ui& newSize) override;
+
+			void Present();
+
+			void SetPresentMode(PresentMode presentMode) override;
+
+			TransientResources& Transient() override;
+
+		private:
+			std::optional<NullRenderPass> m_renderPass;
+			std::size_t m_currentFrame;
+			std::vector<std::unique_ptr<NullRenderImage>> m_renderImage;
+			NullDevice& m_device;
+			NullFramebuffer m_framebuffer;
+			PresentMode m_presentMode;
+			Vector2ui m_size;
+			bool m_sizeInvalidated;
+	};
+}
+
+#include <Nazara/NullRenderer/NullSwapchain.inl>
+
+#endif // NAZARA_NULLRENDERER_NULLSWAPCHAIN_HPP
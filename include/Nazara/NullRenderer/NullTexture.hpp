@@ -0,0 +1,53 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NULLRENDERER_NULLTEXTURE_HPP
+#define NAZARA_NULLRENDERER_NULLTEXTURE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/NullRenderer/Config.hpp>
+#include <Nazara/Renderer/Texture.hpp>
+#include <memory>
+#include <optional>
+
+namespace Nz
+{
+	class NAZARA_NULLRENDERER_API NullTexture final : public Texture
+	{
+		public:
+			NullTexture(const TextureInfo& textureInfo);
+			NullTexture(std::shared_ptr<NullTexture> parentTexture, const TextureViewInfo& viewInfo);
+			NullTexture(const NullTexture&) = delete;
+			NullTexture(NullTexture&&) = delete;
+			~NullTexture() = default;
+
+			bool Copy(const Texture& source, const Boxui& srcBox, const Vector3ui& dstPos) override;
+			std::shared_ptr<Texture> CreateView(const TextureViewInfo& viewInfo) override;
+
+			inline PixelFormat GetFormat() const override;
+			inline UInt8 GetLevelCount() const override;
+			inline NullTexture* GetParentTexture() const override;
+			inline Vector3ui GetSize(UInt8 level = 0) const override;
+			inline const TextureInfo& GetTextureInfo() const override;
+			inline ImageType GetType() const override;
+
+			using Texture::Update;
+			bool Update(const void* ptr, const Boxui& box, unsigned int srcWidth = 0, unsigned int srcHeight = 0, UInt8 level = 0) override;
+
+			void UpdateDebugName(std::string_view name) override;
+
+			NullTexture& operator=(const NullTexture&) = delete;
+			NullTexture& operator=(NullTexture&&) = delete;
+
+		private:
+			std::shared_ptr<NullTexture> m_parentTexture;
+			TextureInfo m_textureInfo;
+	};
+}
+
+#include <Nazara/NullRenderer/NullTexture.inl>
+
+#endif // NAZARA_NULLRENDERER_NULLTEXTURE_HPP
@@ -0,0 +1,40 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/NullRenderer/Debug.hpp>
+
+namespace Nz
+{
+	inline PixelFormat NullTexture::GetFormat() const
+	{
+		return m_textureInfo.pixelFormat;
+	}
+
+	inline UInt8 NullTexture::GetLevelCount() const
+	{
+		return m_textureInfo.levelCount;
+	}
+
+	inline NullTexture* NullTexture::GetParentTexture() const
+	{
+		return m_parentTexture.get();
+	}
+
+	inline Vector3ui NullTexture::GetSize(UInt8 level) const
+	{
+		return Vector3ui(GetLevelSize(m_textureInfo.width, level), GetLevelSize(m_textureInfo.height, level), GetLevelSize(m_textureInfo.depth, level));
+	}
+
+	inline const TextureInfo& NullTexture::GetTextureInfo() const
+	{
+		return m_textureInfo;
+	}
+
+	inline ImageType NullTexture::GetType() const
+	{
+		return m_textureInfo.type;
+	}
+}
+
+#include <Nazara/NullRenderer/DebugOff.hpp>
@@ -0,0 +1,33 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NULLRENDERER_NULLTEXTURESAMPLER_HPP
+#define NAZARA_NULLRENDERER_NULLTEXTURESAMPLER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/NullRenderer/Config.hpp>
+#include <Nazara/Renderer/TextureSampler.hpp>
+
+namespace Nz
+{
+	class NAZARA_NULLRENDERER_API NullTextureSampler : public TextureSampler
+	{
+		public:
+			NullTextureSampler() = default;
+			NullTextureSampler(const NullTextureSampler&) = delete;
+			NullTextureSampler(NullTextureSampler&&) = delete;
+			~NullTextureSampler() = default;
+
+			void UpdateDebugName(std::string_view name) override;
+
+			NullTextureSampler& operator=(const NullTextureSampler&) = delete;
+			NullTextureSampler& operator=(NullTextureSampler&&) = delete;
+	};
+}
+
+#include <Nazara/NullRenderer/NullTextureSampler.inl>
+
+#endif // NAZARA_NULLRENDERER_NULLTEXTURESAMPLER_HPP
@@ -0,0 +1,58 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NULLRENDERER_NULLUPLOADPOOL_HPP
+#define NAZARA_NULLRENDERER_NULLUPLOADPOOL_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/NullRenderer/Config.hpp>
+#include <Nazara/Renderer/UploadPool.hpp>
+#include <NazaraUtils/MovablePtr.hpp>
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_NULLRENDERER_API NullUploadPool : public UploadPool
+	{
+		public:
+			inline NullUploadPool(UInt64 blockSize);
+			NullUploadPool(const NullUploadPool&) = delete;
+			NullUploadPool(NullUploadPool&&) noexcept = default;
+			~NullUploadPool() = default;
+
+			Allocation& Allocate(UInt64 size) override;
+			Allocation& Allocate(UInt64 size, UInt64 alignment) override;
+
+			void Reset() override;
+
+			NullUploadPool& operator=(const NullUploadPool&) = delete;
+			NullUploadPool& operator=(NullUploadPool&&) = delete;
+
+		private:
+			static constexpr std::size_t AllocationPerBlock = 2048;
+
+			using AllocationBlock = std::array<Allocation, AllocationPerBlock>;
+
+			struct Block
+			{
+				std::vector<UInt8> memory;
+				std::size_t unusedResetCount = 0;
+				UInt64 freeOffset = 0;
+				UInt64 size;
+			};
+
+			std::size_t m_nextAllocationIndex;
+			std::vector<std::unique_ptr<AllocationBlock>> m_allocationBlocks;
+			std::vector<Block> m_blocks;
+			UInt64 m_blockSize;
+	};
+}
+
+#include <Nazara/NullRenderer/NullUploadPool.inl>
+
+#endif // NAZARA_NULLRENDERER_NULLUPLOADPOOL_HPP
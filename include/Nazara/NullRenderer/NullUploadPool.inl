@@ -0,0 +1,16 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/NullRenderer/Debug.hpp>
+
+namespace Nz
+{
+	inline NullUploadPool::NullUploadPool(UInt64 blockSize) :
+	m_nextAllocationIndex(0),
+	m_blockSize(blockSize)
+	{
+	}
+}
+
+#include <Nazara/NullRenderer/DebugOff.hpp>
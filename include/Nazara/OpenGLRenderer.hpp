@@ -45,6 +45,7 @@
 #include <Nazara/OpenGLRenderer/OpenGLRenderPipelineLayout.hpp>
 #include <Nazara/OpenGLRenderer/OpenGLShaderBinding.hpp>
 #include <Nazara/OpenGLRenderer/OpenGLShaderModule.hpp>
+#include <Nazara/OpenGLRenderer/OpenGLSubmissionThread.hpp>
 #include <Nazara/OpenGLRenderer/OpenGLSwapchain.hpp>
 #include <Nazara/OpenGLRenderer/OpenGLTexture.hpp>
 #include <Nazara/OpenGLRenderer/OpenGLTextureSampler.hpp>
@@ -29,6 +29,8 @@ namespace Nz
 
 			inline const GL::Buffer& GetBuffer() const;
 
+			inline bool IsPersistentlyMapped() const;
+
 			void* Map(UInt64 offset, UInt64 size) override;
 			bool Unmap() override;
 
@@ -39,6 +41,7 @@ namespace Nz
 
 		private:
 			GL::Buffer m_buffer;
+			UInt8* m_persistentMapping;
 	};
 }
 
@@ -10,6 +10,11 @@ namespace Nz
 	{
 		return m_buffer;
 	}
+
+	inline bool OpenGLBuffer::IsPersistentlyMapped() const
+	{
+		return m_persistentMapping != nullptr;
+	}
 }
 
 #include <Nazara/OpenGLRenderer/DebugOff.hpp>
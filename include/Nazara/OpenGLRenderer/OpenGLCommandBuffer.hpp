@@ -59,6 +59,7 @@ namespace Nz
 
 			inline void Draw(UInt32 vertexCount, UInt32 instanceCount = 1, UInt32 firstVertex = 0, UInt32 firstInstance = 0);
 			inline void DrawIndexed(UInt32 indexCount, UInt32 instanceCount = 1, UInt32 firstIndex = 0, UInt32 firstInstance = 0);
+			inline void DrawIndexedIndirect(GLuint indirectBuffer, UInt64 indirectOffset, UInt32 drawCount, UInt32 stride, GLuint countBuffer = 0, UInt64 countOffset = 0);
 
 			inline void EndDebugRegion();
 
@@ -72,6 +73,8 @@ namespace Nz
 
 			inline void InsertMemoryBarrier(GLbitfield barriers);
 
+			void PushConstants(const OpenGLRenderPipelineLayout& pipelineLayout, UInt32 offset, UInt32 size, const void* data);
+
 			inline void SetFramebuffer(const OpenGLFramebuffer& framebuffer, const OpenGLRenderPass& renderPass, const CommandBufferBuilder::ClearValues* clearValues, std::size_t clearValueCount);
 			inline void SetScissor(const Recti& scissorRegion);
 			inline void SetViewport(const Recti& viewportRegion);
@@ -82,6 +85,7 @@ namespace Nz
 			OpenGLCommandBuffer& operator=(OpenGLCommandBuffer&&) = delete;
 
 		private:
+			struct DrawElementsIndirectCommand;
 			struct DrawStates;
 			struct ShaderBindings;
 
@@ -95,9 +99,11 @@ namespace Nz
 	cb(DispatchCommand) \
 	cb(DrawCommand) \
 	cb(DrawIndexedCommand) \
+	cb(DrawIndexedIndirectCommand) \
 	cb(EndDebugRegionCommand) \
 	cb(InsertDebugLabelCommand) \
 	cb(MemoryBarrier) \
+	cb(MultiDrawIndexedCommand) \
 	lastCb(SetFrameBufferCommand) \
 
 #define NAZARA_OPENGL_COMMAND_CALLBACK(Command) struct Command;
@@ -117,6 +123,10 @@ namespace Nz
 			void ApplyBindings(const GL::Context& context, const ShaderBindings& bindings);
 			void ApplyStates(const GL::Context& context, const DrawStates& states);
 
+			inline DrawElementsIndirectCommand BuildIndirectDraw(const DrawStates& states, UInt32 indexCount, UInt32 instanceCount, UInt32 firstIndex) const;
+
+			inline bool CanMergeDraw(const DrawStates& states, const ShaderBindings& bindings) const;
+
 			inline void Execute(const GL::Context* context, const BeginDebugRegionCommand& command);
 			inline void Execute(const GL::Context* context, const BlitTextureCommand& command);
 			inline void Execute(const GL::Context* context, const BuildTextureMipmapsCommand& command);
@@ -126,9 +136,11 @@ namespace Nz
 			inline void Execute(const GL::Context* context, const DispatchCommand& command);
 			inline void Execute(const GL::Context* context, const DrawCommand& command);
 			inline void Execute(const GL::Context* context, const DrawIndexedCommand& command);
+			inline void Execute(const GL::Context* context, const DrawIndexedIndirectCommand& command);
 			inline void Execute(const GL::Context* context, const EndDebugRegionCommand& command);
 			inline void Execute(const GL::Context* context, const InsertDebugLabelCommand& command);
 			inline void Execute(const GL::Context* context, const MemoryBarrier& command);
+			inline void Execute(const GL::Context* context, const MultiDrawIndexedCommand& command);
 			inline void Execute(const GL::Context*& context, const SetFrameBufferCommand& command);
 
 			void Release() override;
@@ -188,6 +200,8 @@ namespace Nz
 			struct ShaderBindings
 			{
 				std::vector<std::pair<const OpenGLRenderPipelineLayout*, const OpenGLShaderBinding*>> shaderBindings;
+				const OpenGLRenderPipelineLayout* pushConstantLayout = nullptr;
+				std::size_t pushConstantOffset = 0; //< offset of the push constants snapshot in m_pushConstantData
 			};
 
 			struct DispatchCommand
@@ -237,6 +251,28 @@ namespace Nz
 				UInt32 instanceCount;
 			};
 
+			struct DrawIndexedIndirectCommand
+			{
+				DrawStates states;
+				ShaderBindings bindings;
+				GLuint countBuffer; //< 0 if the draw count is not read from a buffer
+				GLuint indirectBuffer;
+				UInt64 countOffset;
+				UInt64 indirectOffset;
+				UInt32 drawCount; //< max draw count if countBuffer is set
+				UInt32 stride;
+			};
+
+			// Matches the layout expected by glMultiDrawElementsIndirect
+			struct DrawElementsIndirectCommand
+			{
+				GLuint count;
+				GLuint instanceCount;
+				GLuint firstIndex;
+				GLint baseVertex;
+				GLuint baseInstance;
+			};
+
 			struct EndDebugRegionCommand
 			{
 			};
@@ -252,6 +288,15 @@ namespace Nz
 				GLbitfield barriers;
 			};
 
+			// Consecutive indexed draws sharing the same states and bindings, merged into a single multi-draw
+			struct MultiDrawIndexedCommand
+			{
+				DrawStates states;
+				ShaderBindings bindings;
+				mutable GL::Buffer indirectBuffer; //< created on first execution, if multi-draw indirect is supported
+				std::vector<DrawElementsIndirectCommand> draws; //< firstIndex already includes the index buffer offset
+			};
+
 			struct SetFrameBufferCommand
 			{
 				std::array<CommandBufferBuilder::ClearValues, 16> clearValues; //< TODO: Remove hard limit?
@@ -270,6 +315,9 @@ namespace Nz
 			std::size_t m_maxColorBufferCount;
 			std::size_t m_poolIndex;
 			std::vector<CommandData> m_commands;
+			std::vector<UInt8> m_currentPushConstants;
+			std::vector<UInt8> m_pushConstantData;
+			GL::Buffer m_pushConstantBuffer; //< created on first execution, if push constants were used
 			OpenGLCommandPool* m_owner;
 	};
 }
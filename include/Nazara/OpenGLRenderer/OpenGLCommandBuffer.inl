@@ -172,6 +172,34 @@ namespace Nz
 		if (!m_currentDrawStates.pipeline)
 			throw std::runtime_error("no pipeline bound");
 
+		// Merge consecutive draws using the same states, so they can be issued with a single multi-draw call
+		if (!m_commands.empty())
+		{
+			CommandData& lastCommand = m_commands.back();
+			if (MultiDrawIndexedCommand* lastMultiDraw = std::get_if<MultiDrawIndexedCommand>(&lastCommand))
+			{
+				if (CanMergeDraw(lastMultiDraw->states, lastMultiDraw->bindings))
+				{
+					lastMultiDraw->draws.push_back(BuildIndirectDraw(lastMultiDraw->states, indexCount, instanceCount, firstIndex));
+					return;
+				}
+			}
+			else if (DrawIndexedCommand* lastDraw = std::get_if<DrawIndexedCommand>(&lastCommand))
+			{
+				if (CanMergeDraw(lastDraw->states, lastDraw->bindings))
+				{
+					MultiDrawIndexedCommand multiDraw;
+					multiDraw.draws.push_back(BuildIndirectDraw(lastDraw->states, lastDraw->indexCount, lastDraw->instanceCount, lastDraw->firstIndex));
+					multiDraw.draws.push_back(BuildIndirectDraw(lastDraw->states, indexCount, instanceCount, firstIndex));
+					multiDraw.bindings = std::move(lastDraw->bindings);
+					multiDraw.states = std::move(lastDraw->states);
+
+					lastCommand = std::move(multiDraw);
+					return;
+				}
+			}
+		}
+
 		DrawIndexedCommand draw;
 		draw.bindings = m_currentGraphicsShaderBindings;
 		draw.states = m_currentDrawStates;
@@ -183,6 +211,82 @@ namespace Nz
 		m_commands.emplace_back(std::move(draw));
 	}
 
+	inline void OpenGLCommandBuffer::DrawIndexedIndirect(GLuint indirectBuffer, UInt64 indirectOffset, UInt32 drawCount, UInt32 stride, GLuint countBuffer, UInt64 countOffset)
+	{
+		if (!m_currentDrawStates.pipeline)
+			throw std::runtime_error("no pipeline bound");
+
+		// Indirect commands index the element buffer from its start, there's no way to apply the bind offset
+		if (m_currentDrawStates.indexBufferOffset != 0)
+			throw std::runtime_error("indirect draws don't support index buffer offsets");
+
+		DrawIndexedIndirectCommand draw;
+		draw.bindings = m_currentGraphicsShaderBindings;
+		draw.states = m_currentDrawStates;
+		draw.countBuffer = countBuffer;
+		draw.countOffset = countOffset;
+		draw.drawCount = drawCount;
+		draw.indirectBuffer = indirectBuffer;
+		draw.indirectOffset = indirectOffset;
+		draw.stride = stride;
+
+		m_commands.emplace_back(std::move(draw));
+	}
+
+	inline auto OpenGLCommandBuffer::BuildIndirectDraw(const DrawStates& states, UInt32 indexCount, UInt32 instanceCount, UInt32 firstIndex) const -> DrawElementsIndirectCommand
+	{
+		UInt64 indexOffset = 0;
+		switch (states.indexBufferType)
+		{
+			case IndexType::U8:  indexOffset = states.indexBufferOffset / sizeof(UInt8); break;
+			case IndexType::U16: indexOffset = states.indexBufferOffset / sizeof(UInt16); break;
+			case IndexType::U32: indexOffset = states.indexBufferOffset / sizeof(UInt32); break;
+		}
+
+		DrawElementsIndirectCommand draw;
+		draw.baseInstance = 0; //< single draws use glDrawElementsInstanced which has no base instance either
+		draw.baseVertex = 0;
+		draw.count = indexCount;
+		draw.firstIndex = GLuint(firstIndex + indexOffset);
+		draw.instanceCount = instanceCount;
+
+		return draw;
+	}
+
+	inline bool OpenGLCommandBuffer::CanMergeDraw(const DrawStates& states, const ShaderBindings& bindings) const
+	{
+		const DrawStates& currentStates = m_currentDrawStates;
+		if (states.pipeline != currentStates.pipeline ||
+		    states.indexBuffer != currentStates.indexBuffer ||
+		    states.indexBufferOffset != currentStates.indexBufferOffset ||
+		    states.indexBufferType != currentStates.indexBufferType ||
+		    states.scissorRegion != currentStates.scissorRegion ||
+		    states.viewportRegion != currentStates.viewportRegion ||
+		    states.shouldFlipY != currentStates.shouldFlipY ||
+		    states.vertexBuffers.size() != currentStates.vertexBuffers.size())
+			return false;
+
+		// Indirect draws express the index buffer offset in indices
+		switch (states.indexBufferType)
+		{
+			case IndexType::U8:  break;
+			case IndexType::U16: if (states.indexBufferOffset % sizeof(UInt16) != 0) return false; break;
+			case IndexType::U32: if (states.indexBufferOffset % sizeof(UInt32) != 0) return false; break;
+		}
+
+		for (std::size_t i = 0; i < states.vertexBuffers.size(); ++i)
+		{
+			const auto& vertexBuffer = states.vertexBuffers[i];
+			const auto& currentVertexBuffer = currentStates.vertexBuffers[i];
+			if (vertexBuffer.vertexBuffer != currentVertexBuffer.vertexBuffer || vertexBuffer.offset != currentVertexBuffer.offset)
+				return false;
+		}
+
+		return bindings.shaderBindings == m_currentGraphicsShaderBindings.shaderBindings &&
+		       bindings.pushConstantLayout == m_currentGraphicsShaderBindings.pushConstantLayout &&
+		       bindings.pushConstantOffset == m_currentGraphicsShaderBindings.pushConstantOffset;
+	}
+
 	inline void OpenGLCommandBuffer::EndDebugRegion()
 	{
 		m_commands.emplace_back(EndDebugRegionCommand{});
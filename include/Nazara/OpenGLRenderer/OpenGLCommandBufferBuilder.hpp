@@ -48,21 +48,29 @@ namespace Nz
 
 			void Draw(UInt32 vertexCount, UInt32 instanceCount = 1, UInt32 firstVertex = 0, UInt32 firstInstance = 0) override;
 			void DrawIndexed(UInt32 indexCount, UInt32 instanceCount = 1, UInt32 firstIndex = 0, UInt32 firstInstance = 0) override;
+			void DrawIndexedIndirect(const RenderBufferView& indirectBuffer, UInt32 drawCount, UInt32 stride = sizeof(DrawIndexedIndirectCommand)) override;
+			void DrawIndexedIndirectCount(const RenderBufferView& indirectBuffer, const RenderBufferView& countBuffer, UInt32 maxDrawCount, UInt32 stride = sizeof(DrawIndexedIndirectCommand)) override;
 
 			void EndDebugRegion() override;
 			void EndRenderPass() override;
 
 			void InsertDebugLabel(std::string_view label, const Color& color) override;
 
+			void MemoryBarrier(PipelineStageFlags srcStageMask, PipelineStageFlags dstStageMask, MemoryAccessFlags srcAccessMask, MemoryAccessFlags dstAccessMask) override;
+
 			void NextSubpass() override;
 
 			void PreTransferBarrier() override;
 			void PostTransferBarrier() override;
 
+			void PushConstants(const RenderPipelineLayout& pipelineLayout, UInt32 offset, UInt32 size, const void* data) override;
+
 			void SetScissor(const Recti& scissorRegion) override;
 			void SetViewport(const Recti& viewportRegion) override;
 
+			void TextureAcquireBarrier(PipelineStageFlags srcStageMask, PipelineStageFlags dstStageMask, MemoryAccessFlags srcAccessMask, MemoryAccessFlags dstAccessMask, TextureLayout oldLayout, TextureLayout newLayout, QueueType srcQueue, QueueType dstQueue, const Texture& texture) override;
 			void TextureBarrier(PipelineStageFlags srcStageMask, PipelineStageFlags dstStageMask, MemoryAccessFlags srcAccessMask, MemoryAccessFlags dstAccessMask, TextureLayout oldLayout, TextureLayout newLayout, const Texture& texture) override;
+			void TextureReleaseBarrier(PipelineStageFlags srcStageMask, PipelineStageFlags dstStageMask, MemoryAccessFlags srcAccessMask, MemoryAccessFlags dstAccessMask, TextureLayout oldLayout, TextureLayout newLayout, QueueType srcQueue, QueueType dstQueue, const Texture& texture) override;
 
 			OpenGLCommandBufferBuilder& operator=(const OpenGLCommandBufferBuilder&) = delete;
 			OpenGLCommandBufferBuilder& operator=(OpenGLCommandBufferBuilder&&) = delete;
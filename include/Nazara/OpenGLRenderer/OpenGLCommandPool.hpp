@@ -20,13 +20,15 @@ namespace Nz
 		friend OpenGLCommandBuffer;
 
 		public:
-			OpenGLCommandPool() = default;
+			inline OpenGLCommandPool(OpenGLDevice& device);
 			OpenGLCommandPool(const OpenGLCommandPool&) = delete;
 			OpenGLCommandPool(OpenGLCommandPool&&) noexcept = default;
 			~OpenGLCommandPool() = default;
 
 			CommandBufferPtr BuildCommandBuffer(const std::function<void(CommandBufferBuilder& builder)>& callback) override;
 
+			inline OpenGLDevice& GetDevice() const;
+
 			void UpdateDebugName(std::string_view name) override;
 
 			OpenGLCommandPool& operator=(const OpenGLCommandPool&) = delete;
@@ -49,6 +51,7 @@ namespace Nz
 			};
 
 			std::vector<CommandPool> m_commandPools;
+			OpenGLDevice* m_device;
 	};
 }
 
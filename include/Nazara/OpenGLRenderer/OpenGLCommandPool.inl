@@ -7,6 +7,16 @@
 
 namespace Nz
 {
+	inline OpenGLCommandPool::OpenGLCommandPool(OpenGLDevice& device) :
+	m_device(&device)
+	{
+	}
+
+	inline OpenGLDevice& OpenGLCommandPool::GetDevice() const
+	{
+		return *m_device;
+	}
+
 	inline void OpenGLCommandPool::TryToShrink()
 	{
 		std::size_t poolCount = m_commandPools.size();
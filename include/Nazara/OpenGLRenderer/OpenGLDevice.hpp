@@ -9,16 +9,27 @@
 
 #include <NazaraUtils/Prerequisites.hpp>
 #include <Nazara/OpenGLRenderer/Config.hpp>
+#include <Nazara/OpenGLRenderer/OpenGLSubmissionThread.hpp>
 #include <Nazara/OpenGLRenderer/Wrapper/Context.hpp>
 #include <Nazara/Platform/WindowHandle.hpp>
 #include <Nazara/Renderer/RenderDevice.hpp>
 #include <Nazara/Renderer/RenderDeviceInfo.hpp>
 #include <Nazara/Renderer/Renderer.hpp>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 namespace Nz
 {
+	namespace GL
+	{
+		class Program;
+	}
+
 	class NAZARA_OPENGLRENDERER_API OpenGLDevice : public RenderDevice
 	{
 		friend GL::Context;
@@ -35,6 +46,9 @@ namespace Nz
 			const RenderDeviceInfo& GetDeviceInfo() const override;
 			const RenderDeviceFeatures& GetEnabledFeatures() const override;
 			inline const GL::Context& GetReferenceContext() const;
+			inline OpenGLSubmissionThread* GetSubmissionThread() const;
+
+			bool InitializeProgramCache(std::filesystem::path cacheFilePath);
 
 			std::shared_ptr<RenderBuffer> InstantiateBuffer(BufferType type, UInt64 size, BufferUsageFlags usageFlags, const void* initialData = nullptr) override;
 			std::shared_ptr<CommandPool> InstantiateCommandPool(QueueType queueType) override;
@@ -50,25 +64,78 @@ namespace Nz
 			std::shared_ptr<Texture> InstantiateTexture(const TextureInfo& params, const void* initialData, bool buildMipmaps, unsigned int srcWidth = 0, unsigned int srcHeight = 0) override;
 			std::shared_ptr<TextureSampler> InstantiateTextureSampler(const TextureSamplerInfo& params) override;
 
+			inline bool IsProgramCacheEnabled() const;
 			bool IsTextureFormatSupported(PixelFormat format, TextureUsage usage) const override;
 
+			bool LoadProgramBinary(GL::Program& program, UInt64 programHash);
+
 			inline void NotifyBufferDestruction(GLuint buffer) const;
 			inline void NotifyProgramDestruction(GLuint program) const;
 			inline void NotifySamplerDestruction(GLuint sampler) const;
 			inline void NotifyTextureDestruction(GLuint texture) const;
 
+			bool SaveProgramCache() const;
+			void SignalTimeline();
+			void StoreProgramBinary(const GL::Program& program, UInt64 programHash);
+
 			void WaitForIdle() override;
 
 			OpenGLDevice& operator=(const OpenGLDevice&) = delete;
 			OpenGLDevice& operator=(OpenGLDevice&&) = delete; ///TODO?
 
+		protected:
+			QueueTimelineValues GetSubmittedTimelineValues() const override;
+			QueueTimelineValues QueryCompletedTimelineValues() override;
+
 		private:
+			template<typename F> void NotifyContexts(F&& notification) const;
 			inline void NotifyContextDestruction(const GL::Context& context) const;
 
+			struct PendingSync
+			{
+				GLsync fence;
+				UInt64 submissionJob;
+				UInt64 timelineValue;
+			};
+
+			struct ProgramBinary
+			{
+				std::vector<UInt8> data;
+				GLenum format;
+			};
+
+			struct ProgramCacheHeader
+			{
+				UInt32 magic;
+				UInt32 version;
+				UInt64 driverHash;
+				UInt64 programCount;
+			};
+
+			struct ProgramCacheEntryHeader
+			{
+				UInt64 programHash;
+				UInt32 binaryFormat;
+				UInt32 binarySize;
+			};
+
+			static constexpr UInt32 ProgramCacheMagic = 0x5047'5A4E; //< "NZGP"
+			static constexpr UInt32 ProgramCacheVersion = 1;
+
+			std::deque<PendingSync> m_pendingSyncs;
+			std::filesystem::path m_programCacheFilePath;
 			std::shared_ptr<GL::Context> m_referenceContext;
+			std::unique_ptr<OpenGLSubmissionThread> m_submissionThread;
+			std::unordered_map<UInt64, ProgramBinary> m_programBinaries;
 			mutable std::unordered_set<const GL::Context*> m_contexts;
+			mutable std::mutex m_timelineMutex;
 			RenderDeviceInfo m_deviceInfo;
 			GL::Loader& m_loader;
+			UInt64 m_completedTimelineValue;
+			UInt64 m_driverHash;
+			UInt64 m_signaledTimelineValue;
+			bool m_isProgramBinarySupported;
+			bool m_isProgramCacheUpdated;
 	};
 }
 
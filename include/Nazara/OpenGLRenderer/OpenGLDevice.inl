@@ -11,28 +11,50 @@ namespace Nz
 		return *m_referenceContext;
 	}
 
+	/*!
+	* \brief Returns the thread executing GL work for swapchains, or nullptr if it runs on the rendering thread
+	*/
+	inline OpenGLSubmissionThread* OpenGLDevice::GetSubmissionThread() const
+	{
+		return m_submissionThread.get();
+	}
+
+	inline bool OpenGLDevice::IsProgramCacheEnabled() const
+	{
+		return m_isProgramBinarySupported && !m_programCacheFilePath.empty();
+	}
+
 	inline void OpenGLDevice::NotifyBufferDestruction(GLuint buffer) const
 	{
-		for (const GL::Context* context : m_contexts)
-			context->NotifyBufferDestruction(buffer);
+		NotifyContexts([buffer](const GL::Context& context) { context.NotifyBufferDestruction(buffer); });
 	}
 
 	inline void OpenGLDevice::NotifyProgramDestruction(GLuint program) const
 	{
-		for (const GL::Context* context : m_contexts)
-			context->NotifyProgramDestruction(program);
+		NotifyContexts([program](const GL::Context& context) { context.NotifyProgramDestruction(program); });
 	}
 
 	inline void OpenGLDevice::NotifySamplerDestruction(GLuint sampler) const
 	{
-		for (const GL::Context* context : m_contexts)
-			context->NotifySamplerDestruction(sampler);
+		NotifyContexts([sampler](const GL::Context& context) { context.NotifySamplerDestruction(sampler); });
 	}
 
 	inline void OpenGLDevice::NotifyTextureDestruction(GLuint texture) const
+	{
+		NotifyContexts([texture](const GL::Context& context) { context.NotifyTextureDestruction(texture); });
+	}
+
+	template<typename F>
+	void OpenGLDevice::NotifyContexts(F&& notification) const
 	{
 		for (const GL::Context* context : m_contexts)
-			context->NotifyTextureDestruction(texture);
+		{
+			// Contexts other than the reference one are used by the submission thread, their state must only be accessed from there
+			if (m_submissionThread && context != m_referenceContext.get())
+				m_submissionThread->Submit(nullptr, [context, notification] { notification(*context); });
+			else
+				notification(*context);
+		}
 	}
 
 	inline void OpenGLDevice::NotifyContextDestruction(const GL::Context& context) const
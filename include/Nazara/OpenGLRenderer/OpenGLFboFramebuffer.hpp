@@ -27,7 +27,7 @@ namespace Nz
 			OpenGLFboFramebuffer(OpenGLDevice& device, std::vector<std::shared_ptr<Texture>> attachments);
 			OpenGLFboFramebuffer(const OpenGLFboFramebuffer&) = delete;
 			OpenGLFboFramebuffer(OpenGLFboFramebuffer&&) = delete;
-			~OpenGLFboFramebuffer() = default;
+			~OpenGLFboFramebuffer();
 
 			void Activate() const override;
 
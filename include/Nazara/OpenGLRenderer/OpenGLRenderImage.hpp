@@ -29,10 +29,14 @@ namespace Nz
 			void Present() override;
 
 			void SubmitCommandBuffer(CommandBuffer* commandBuffer, QueueTypeFlags queueTypeFlags) override;
+			void SynchronizeQueues(QueueType waitingQueue, QueueType signalingQueue) override;
+
+			void WaitForSubmissions();
 
 		private:
 			OpenGLSwapchain& m_owner;
 			OpenGLUploadPool m_uploadPool;
+			UInt64 m_pendingSubmission;
 	};
 }
 
@@ -35,12 +35,16 @@ namespace Nz
 
 			inline const nzsl::GlslWriter::BindingMapping& GetBindingMapping() const;
 			inline const RenderPipelineLayoutInfo& GetLayoutInfo() const;
+			inline UInt32 GetPushConstantBinding() const;
+			inline UInt32 GetPushConstantSize() const;
 
 			void UpdateDebugName(std::string_view name) override;
 
 			OpenGLRenderPipelineLayout& operator=(const OpenGLRenderPipelineLayout&) = delete;
 			OpenGLRenderPipelineLayout& operator=(OpenGLRenderPipelineLayout&&) = delete;
 
+			static constexpr UInt32 MaxPushConstantsSize = 128;
+
 		private:
 			struct DescriptorPool;
 			struct SampledTextureDescriptor;
@@ -104,6 +108,8 @@ namespace Nz
 			std::vector<DescriptorPool> m_descriptorPools;
 			nzsl::GlslWriter::BindingMapping m_bindingMapping;
 			RenderPipelineLayoutInfo m_layoutInfo;
+			UInt32 m_pushConstantBinding;
+			UInt32 m_pushConstantSize;
 	};
 }
 
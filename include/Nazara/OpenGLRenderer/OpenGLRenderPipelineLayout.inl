@@ -16,6 +16,19 @@ namespace Nz
 		return m_layoutInfo;
 	}
 
+	/*!
+	* \brief Returns the uniform buffer binding used to emulate push constants (following every other binding of the layout)
+	*/
+	inline UInt32 OpenGLRenderPipelineLayout::GetPushConstantBinding() const
+	{
+		return m_pushConstantBinding;
+	}
+
+	inline UInt32 OpenGLRenderPipelineLayout::GetPushConstantSize() const
+	{
+		return m_pushConstantSize;
+	}
+
 	template<typename F>
 	void OpenGLRenderPipelineLayout::ForEachDescriptor(std::size_t poolIndex, std::size_t bindingIndex, F&& functor)
 	{
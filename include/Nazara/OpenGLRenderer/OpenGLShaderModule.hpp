@@ -24,16 +24,19 @@ namespace Nz
 	{
 		public:
 			struct ExplicitBinding;
+			struct Source;
 
 			OpenGLShaderModule(OpenGLDevice& device, nzsl::ShaderStageTypeFlags shaderStages, const nzsl::Ast::Module& shaderModule, const nzsl::ShaderWriter::States& states = {});
 			OpenGLShaderModule(OpenGLDevice& device, nzsl::ShaderStageTypeFlags shaderStages, ShaderLanguage lang, const void* source, std::size_t sourceSize, const nzsl::ShaderWriter::States& states = {});
 
-			nzsl::ShaderStageTypeFlags Attach(GL::Program& program, const nzsl::GlslWriter::BindingMapping& bindingMapping, std::vector<ExplicitBinding>* explicitBindings) const;
+			nzsl::ShaderStageTypeFlags GenerateSources(const nzsl::GlslWriter::BindingMapping& bindingMapping, std::vector<Source>& sources, std::vector<ExplicitBinding>* explicitBindings) const;
 
 			inline const std::vector<ExplicitBinding>& GetExplicitBindings() const;
 
 			void UpdateDebugName(std::string_view name) override;
 
+			static void LinkProgram(OpenGLDevice& device, GL::Program& program, const std::vector<Source>& sources);
+
 			struct ExplicitBinding
 			{
 				std::string name;
@@ -41,6 +44,13 @@ namespace Nz
 				bool isBlock;
 			};
 
+			struct Source
+			{
+				nzsl::ShaderStageType stage;
+				std::string code;
+				std::string debugName;
+			};
+
 		private:
 			void Create(OpenGLDevice& device, nzsl::ShaderStageTypeFlags shaderStages, const nzsl::Ast::Module& shaderModule, const nzsl::ShaderWriter::States& states);
 
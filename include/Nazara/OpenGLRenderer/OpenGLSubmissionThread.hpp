@@ -0,0 +1,75 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - OpenGL renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_OPENGLRENDERER_OPENGLSUBMISSIONTHREAD_HPP
+#define NAZARA_OPENGLRENDERER_OPENGLSUBMISSIONTHREAD_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/MpscQueue.hpp>
+#include <Nazara/OpenGLRenderer/Config.hpp>
+#include <Nazara/OpenGLRenderer/Wrapper/CoreFunctions.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Nz
+{
+	namespace GL
+	{
+		class Context;
+	}
+
+	class NAZARA_OPENGLRENDERER_API OpenGLSubmissionThread
+	{
+		public:
+			using Job = std::function<void()>;
+
+			OpenGLSubmissionThread();
+			OpenGLSubmissionThread(const OpenGLSubmissionThread&) = delete;
+			OpenGLSubmissionThread(OpenGLSubmissionThread&&) = delete;
+			~OpenGLSubmissionThread();
+
+			inline UInt64 GetCompletedJobCount() const;
+			inline UInt64 GetSubmittedJobCount() const;
+
+			inline bool IsSubmissionThread() const;
+
+			void ReleaseContext(const GL::Context& context);
+
+			UInt64 Submit(const GL::Context* context, Job job);
+
+			void WaitForCompletion(UInt64 jobIndex);
+			inline void WaitForIdle();
+
+			OpenGLSubmissionThread& operator=(const OpenGLSubmissionThread&) = delete;
+			OpenGLSubmissionThread& operator=(OpenGLSubmissionThread&&) = delete;
+
+		private:
+			struct PendingJob
+			{
+				Job callback;
+				const GL::Context* context;
+				GLsync fence;
+			};
+
+			void ThreadFunc();
+
+			alignas(64) std::atomic<UInt64> m_submittedJobCount;
+			alignas(64) std::atomic<UInt64> m_completedJobCount;
+			std::condition_variable m_completionCondition;
+			std::condition_variable m_wakeCondition;
+			std::mutex m_mutex;
+			std::thread m_thread;
+			MpscQueue<PendingJob> m_jobs;
+			bool m_isStopping;
+	};
+}
+
+#include <Nazara/OpenGLRenderer/OpenGLSubmissionThread.inl>
+
+#endif // NAZARA_OPENGLRENDERER_OPENGLSUBMISSIONTHREAD_HPP
@@ -0,0 +1,33 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - OpenGL renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/OpenGLRenderer/Debug.hpp>
+
+namespace Nz
+{
+	inline UInt64 OpenGLSubmissionThread::GetCompletedJobCount() const
+	{
+		return m_completedJobCount.load(std::memory_order_acquire);
+	}
+
+	inline UInt64 OpenGLSubmissionThread::GetSubmittedJobCount() const
+	{
+		return m_submittedJobCount.load(std::memory_order_acquire);
+	}
+
+	inline bool OpenGLSubmissionThread::IsSubmissionThread() const
+	{
+		return std::this_thread::get_id() == m_thread.get_id();
+	}
+
+	/*!
+	* \brief Waits until every job submitted before this call has been executed
+	*/
+	inline void OpenGLSubmissionThread::WaitForIdle()
+	{
+		WaitForCompletion(GetSubmittedJobCount());
+	}
+}
+
+#include <Nazara/OpenGLRenderer/DebugOff.hpp>
@@ -25,13 +25,14 @@ namespace Nz
 	{
 		public:
 			OpenGLSwapchain(OpenGLDevice& device, WindowHandle windowHandle, const Vector2ui& windowSize, const SwapchainParameters& parameters);
-			~OpenGLSwapchain() = default;
+			~OpenGLSwapchain();
 
 			RenderFrame AcquireFrame() override;
 
 			std::shared_ptr<CommandPool> CreateCommandPool(QueueType queueType) override;
 
 			inline GL::Context& GetContext();
+			inline OpenGLDevice& GetDevice();
 			const OpenGLFramebuffer& GetFramebuffer(std::size_t i) const override;
 			std::size_t GetFramebufferCount() const override;
 			PresentMode GetPresentMode() const override;
@@ -52,6 +53,7 @@ namespace Nz
 			std::size_t m_currentFrame;
 			std::vector<std::unique_ptr<OpenGLRenderImage>> m_renderImage;
 			std::shared_ptr<GL::Context> m_context;
+			OpenGLDevice& m_device;
 			OpenGLWindowFramebuffer m_framebuffer;
 			PresentMode m_presentMode;
 			PresentModeFlags m_supportedPresentModes;
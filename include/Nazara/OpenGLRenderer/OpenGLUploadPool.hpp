@@ -41,6 +41,7 @@ namespace Nz
 			struct Block
 			{
 				std::vector<UInt8> memory;
+				std::size_t unusedResetCount = 0;
 				UInt64 freeOffset = 0;
 				UInt64 size;
 			};
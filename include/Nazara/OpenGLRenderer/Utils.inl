@@ -20,6 +20,15 @@ namespace Nz
 		switch (pixelFormat)
 		{
 			case PixelFormat::A8:               return GLTextureFormat{ GL_R8,                 GL_RED,             GL_UNSIGNED_BYTE,                  GL_ONE,   GL_ONE,   GL_ONE,  GL_RED };
+			case PixelFormat::ASTC4x4:          return GLTextureFormat{ GL_COMPRESSED_RGBA_ASTC_4x4_KHR,          GL_NONE,            GL_NONE,                           GL_RED,   GL_GREEN, GL_BLUE, GL_ALPHA };
+			case PixelFormat::ASTC4x4_SRGB:     return GLTextureFormat{ GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR,  GL_NONE,            GL_NONE,                           GL_RED,   GL_GREEN, GL_BLUE, GL_ALPHA };
+			case PixelFormat::ASTC8x8:          return GLTextureFormat{ GL_COMPRESSED_RGBA_ASTC_8x8_KHR,          GL_NONE,            GL_NONE,                           GL_RED,   GL_GREEN, GL_BLUE, GL_ALPHA };
+			case PixelFormat::ASTC8x8_SRGB:     return GLTextureFormat{ GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x8_KHR,  GL_NONE,            GL_NONE,                           GL_RED,   GL_GREEN, GL_BLUE, GL_ALPHA };
+			case PixelFormat::BC4:              return GLTextureFormat{ GL_COMPRESSED_RED_RGTC1_EXT,              GL_NONE,            GL_NONE,                           GL_RED,   GL_GREEN, GL_BLUE, GL_ALPHA };
+			case PixelFormat::BC5:              return GLTextureFormat{ GL_COMPRESSED_RED_GREEN_RGTC2_EXT,        GL_NONE,            GL_NONE,                           GL_RED,   GL_GREEN, GL_BLUE, GL_ALPHA };
+			case PixelFormat::BC6H:             return GLTextureFormat{ GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT_EXT, GL_NONE,            GL_NONE,                           GL_RED,   GL_GREEN, GL_BLUE, GL_ALPHA };
+			case PixelFormat::BC7:              return GLTextureFormat{ GL_COMPRESSED_RGBA_BPTC_UNORM_EXT,        GL_NONE,            GL_NONE,                           GL_RED,   GL_GREEN, GL_BLUE, GL_ALPHA };
+			case PixelFormat::BC7_SRGB:         return GLTextureFormat{ GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM_EXT,  GL_NONE,            GL_NONE,                           GL_RED,   GL_GREEN, GL_BLUE, GL_ALPHA };
 			case PixelFormat::BGR8:             return GLTextureFormat{ GL_RGB8,               GL_RGB,             GL_UNSIGNED_BYTE,                  GL_BLUE,  GL_GREEN, GL_RED,  GL_ALPHA };
 			case PixelFormat::BGR8_SRGB:        return GLTextureFormat{ GL_SRGB8,              GL_RGB,             GL_UNSIGNED_BYTE,                  GL_BLUE,  GL_GREEN, GL_RED,  GL_ALPHA };
 			case PixelFormat::BGRA8:            return GLTextureFormat{ GL_SRGB8_ALPHA8,       GL_RGBA,            GL_UNSIGNED_BYTE,                  GL_BLUE,  GL_GREEN, GL_RED,  GL_ALPHA };
@@ -29,6 +38,13 @@ namespace Nz
 			case PixelFormat::Depth24Stencil8:  return GLTextureFormat{ GL_DEPTH24_STENCIL8,   GL_DEPTH_STENCIL,   GL_UNSIGNED_INT_24_8,              GL_RED,   GL_GREEN, GL_ZERO, GL_ZERO };
 			case PixelFormat::Depth32F:         return GLTextureFormat{ GL_DEPTH_COMPONENT32F, GL_DEPTH_COMPONENT, GL_FLOAT,                          GL_RED,   GL_ZERO,  GL_ZERO, GL_ZERO };
 			case PixelFormat::Depth32FStencil8: return GLTextureFormat{ GL_DEPTH32F_STENCIL8,  GL_DEPTH_STENCIL,   GL_FLOAT_32_UNSIGNED_INT_24_8_REV, GL_RED,   GL_GREEN, GL_ZERO, GL_ZERO };
+			case PixelFormat::DXT1:             return GLTextureFormat{ GL_COMPRESSED_RGBA_S3TC_DXT1_EXT,         GL_NONE,            GL_NONE,                           GL_RED,   GL_GREEN, GL_BLUE, GL_ALPHA };
+			case PixelFormat::DXT3:             return GLTextureFormat{ GL_COMPRESSED_RGBA_S3TC_DXT3_EXT,         GL_NONE,            GL_NONE,                           GL_RED,   GL_GREEN, GL_BLUE, GL_ALPHA };
+			case PixelFormat::DXT5:             return GLTextureFormat{ GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,         GL_NONE,            GL_NONE,                           GL_RED,   GL_GREEN, GL_BLUE, GL_ALPHA };
+			case PixelFormat::ETC2_RGB8:        return GLTextureFormat{ GL_COMPRESSED_RGB8_ETC2,                  GL_NONE,            GL_NONE,                           GL_RED,   GL_GREEN, GL_BLUE, GL_ALPHA };
+			case PixelFormat::ETC2_RGB8_SRGB:   return GLTextureFormat{ GL_COMPRESSED_SRGB8_ETC2,                 GL_NONE,            GL_NONE,                           GL_RED,   GL_GREEN, GL_BLUE, GL_ALPHA };
+			case PixelFormat::ETC2_RGBA8:       return GLTextureFormat{ GL_COMPRESSED_RGBA8_ETC2_EAC,             GL_NONE,            GL_NONE,                           GL_RED,   GL_GREEN, GL_BLUE, GL_ALPHA };
+			case PixelFormat::ETC2_RGBA8_SRGB:  return GLTextureFormat{ GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC,      GL_NONE,            GL_NONE,                           GL_RED,   GL_GREEN, GL_BLUE, GL_ALPHA };
 			case PixelFormat::L8:               return GLTextureFormat{ GL_R8,                 GL_RED,             GL_UNSIGNED_BYTE,                  GL_RED,   GL_RED,   GL_RED,  GL_ONE };
 			case PixelFormat::LA8:              return GLTextureFormat{ GL_RG8,                GL_RG,              GL_UNSIGNED_BYTE,                  GL_RED,   GL_RED,   GL_RED,  GL_GREEN };
 			case PixelFormat::R8:               return GLTextureFormat{ GL_R8,                 GL_RED,             GL_UNSIGNED_BYTE,                  GL_RED,   GL_GREEN, GL_BLUE, GL_ALPHA };
@@ -282,7 +298,9 @@ namespace Nz
 			case GL::BufferTarget::Array:             return GL_ARRAY_BUFFER;
 			case GL::BufferTarget::CopyRead:          return GL_COPY_READ_BUFFER;
 			case GL::BufferTarget::CopyWrite:         return GL_COPY_WRITE_BUFFER;
+			case GL::BufferTarget::DrawIndirect:      return GL_DRAW_INDIRECT_BUFFER;
 			case GL::BufferTarget::ElementArray:      return GL_ELEMENT_ARRAY_BUFFER;
+			case GL::BufferTarget::Parameter:         return GL_PARAMETER_BUFFER;
 			case GL::BufferTarget::PixelPack:         return GL_PIXEL_PACK_BUFFER;
 			case GL::BufferTarget::PixelUnpack:       return GL_PIXEL_UNPACK_BUFFER;
 			case GL::BufferTarget::Storage:           return GL_SHADER_STORAGE_BUFFER;
@@ -28,6 +28,7 @@ namespace Nz::GL
 
 			inline void Reset(BufferTarget target, GLsizeiptr size, const void* initialData, GLenum usage);
 
+			inline void Storage(BufferTarget target, GLsizeiptr size, const void* initialData, GLbitfield flags);
 			inline void SubData(GLintptr offset, GLsizeiptr size, const void* data);
 
 			inline bool Unmap();
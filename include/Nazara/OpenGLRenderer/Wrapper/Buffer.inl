@@ -24,6 +24,18 @@ namespace Nz::GL
 		context.glBufferData(ToOpenGL(m_target), size, initialData, usage);
 	}
 
+	inline void Buffer::Storage(BufferTarget target, GLsizeiptr size, const void* initialData, GLbitfield flags)
+	{
+		m_target = target;
+
+		const Context& context = EnsureDeviceContext();
+		assert(context.glBufferStorage);
+
+		context.BindBuffer(m_target, m_objectId);
+
+		context.glBufferStorage(ToOpenGL(m_target), size, initialData, flags);
+	}
+
 	inline void Buffer::SubData(GLintptr offset, GLsizeiptr size, const void* data)
 	{
 		const Context& context = EnsureDeviceContext();
@@ -9,6 +9,7 @@
 
 #include <NazaraUtils/Prerequisites.hpp>
 #include <Nazara/Core/Algorithm.hpp>
+#include <Nazara/Core/Color.hpp>
 #include <Nazara/Core/DynLib.hpp>
 #include <Nazara/OpenGLRenderer/Config.hpp>
 #include <Nazara/OpenGLRenderer/OpenGLVaoCache.hpp>
@@ -36,7 +37,9 @@ namespace Nz::GL
 		Array,
 		CopyRead,
 		CopyWrite,
+		DrawIndirect,
 		ElementArray,
+		Parameter,
 		PixelPack,
 		PixelUnpack,
 		Storage,
@@ -54,6 +57,7 @@ namespace Nz::GL
 
 	enum class Extension
 	{
+		BufferStorage,
 		ClipControl,
 		ComputeShader,
 		DebugOutput,
@@ -63,6 +67,10 @@ namespace Nz::GL
 		ShaderImageLoadStore,
 		SpirV,
 		StorageBuffers,
+		TextureCompressionASTC,
+		TextureCompressionBPTC,
+		TextureCompressionETC2,
+		TextureCompressionRGTC,
 		TextureCompressionS3tc,
 		TextureFilterAnisotropic,
 		TextureView,
@@ -123,6 +131,8 @@ namespace Nz::GL
 		friend SymbolLoader;
 
 		public:
+			struct StateStats;
+
 			Context(const OpenGLDevice* device);
 			Context(const Context&) = delete;
 			Context(Context&&) = delete;
@@ -157,6 +167,7 @@ namespace Nz::GL
 			template<typename T> T GetInteger(GLenum name) const;
 			template<typename T> T GetInteger(GLenum name, GLuint index) const;
 			inline const ContextParams& GetParams() const;
+			inline const StateStats& GetStateStats() const;
 			virtual PresentModeFlags GetSupportedPresentModes() const = 0;
 			inline const OpenGLVaoCache& GetVaoCache() const;
 
@@ -179,8 +190,13 @@ namespace Nz::GL
 
 			inline void ResetColorWriteMasks() const;
 			inline void ResetDepthWriteMasks() const;
+			inline void ResetStateStats() const;
 			inline void ResetStencilWriteMasks() const;
 
+			void SetClearColor(const Color& color) const;
+			void SetClearDepth(float depth) const;
+			void SetClearStencil(GLint stencil) const;
+
 			void SetCurrentTextureUnit(UInt32 textureUnit) const;
 			virtual void SetPresentMode(PresentMode presentMode) = 0;
 			void SetScissorBox(GLint x, GLint y, GLsizei width, GLsizei height) const;
@@ -197,6 +213,12 @@ namespace Nz::GL
 			Context& operator=(const Context&) = delete;
 			Context& operator=(Context&&) = delete;
 
+			struct StateStats
+			{
+				UInt64 eliminatedCalls = 0; //< state changes skipped because the state was already set
+				UInt64 issuedCalls = 0; //< state changes which reached the driver
+			};
+
 			static const Context* GetCurrentContext();
 			static bool SetCurrentContext(const Context* context);
 
@@ -217,6 +239,7 @@ namespace Nz::GL
 		private:
 			void HandleDebugMessage(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message) const;
 			bool InitializeBlitFramebuffers() const;
+			inline bool TrackStateChange(bool hasChanged) const;
 
 			enum class FunctionIndex
 			{
@@ -267,6 +290,9 @@ namespace Nz::GL
 				std::vector<TextureUnit> textureUnits;
 				Box scissorBox;
 				Box viewport;
+				Color clearColor = Color(0.f, 0.f, 0.f, 0.f);
+				GLint clearStencil = 0;
+				GLfloat clearDepth = 1.f;
 				GLuint boundProgram = 0;
 				GLuint boundDrawFBO = 0;
 				GLuint boundReadFBO = 0;
@@ -282,6 +308,7 @@ namespace Nz::GL
 			OpenGLVaoCache m_vaoCache;
 			const OpenGLDevice* m_device;
 			mutable State m_state;
+			mutable StateStats m_stateStats;
 			mutable bool m_didCollectErrors;
 			mutable bool m_hadAnyError;
 			bool m_hasZeroToOneDepth;
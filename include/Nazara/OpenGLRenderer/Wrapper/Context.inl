@@ -97,6 +97,11 @@ namespace Nz::GL
 		return m_params;
 	}
 
+	inline auto Context::GetStateStats() const -> const StateStats&
+	{
+		return m_stateStats;
+	}
+
 	inline const OpenGLVaoCache& Context::GetVaoCache() const
 	{
 		return m_vaoCache;
@@ -172,7 +177,7 @@ namespace Nz::GL
 
 	inline void Context::ResetColorWriteMasks() const
 	{
-		if (m_state.renderStates.colorWriteMask != ColorComponentAll)
+		if (TrackStateChange(m_state.renderStates.colorWriteMask != ColorComponentAll))
 		{
 			glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
 			m_state.renderStates.colorWriteMask = ColorComponentAll;
@@ -181,16 +186,21 @@ namespace Nz::GL
 
 	inline void Context::ResetDepthWriteMasks() const
 	{
-		if (!m_state.renderStates.depthWrite)
+		if (TrackStateChange(!m_state.renderStates.depthWrite))
 		{
 			glDepthMask(GL_TRUE);
 			m_state.renderStates.depthWrite = true;
 		}
 	}
 
+	inline void Context::ResetStateStats() const
+	{
+		m_stateStats = StateStats{};
+	}
+
 	inline void Context::ResetStencilWriteMasks() const
 	{
-		if (m_state.renderStates.stencilBack.writeMask != 0xFFFFFFFF || m_state.renderStates.stencilFront.writeMask != 0xFFFFFFFF)
+		if (TrackStateChange(m_state.renderStates.stencilBack.writeMask != 0xFFFFFFFF || m_state.renderStates.stencilFront.writeMask != 0xFFFFFFFF))
 		{
 			glStencilMaskSeparate(GL_FRONT_AND_BACK, 0xFFFFFFFF);
 			m_state.renderStates.stencilBack.writeMask = 0xFFFFFFFF;
@@ -198,6 +208,15 @@ namespace Nz::GL
 		}
 	}
 
+	inline bool Context::TrackStateChange(bool hasChanged) const
+	{
+		if (hasChanged)
+			m_stateStats.issuedCalls++;
+		else
+			m_stateStats.eliminatedCalls++;
+
+		return hasChanged;
+	}
 }
 
 #include <Nazara/OpenGLRenderer/DebugOff.hpp>
@@ -26,6 +26,15 @@ typedef void (GL_APIENTRYP PFNGLPOLYGONMODEPROC) (GLenum face, GLenum mode);
 // Depth clamp (OpenGL 3.2)
 #define GL_DEPTH_CLAMP                     0x864F
 
+// Multi draw indirect (OpenGL 4.3)
+typedef void (GL_APIENTRYP PFNGLMULTIDRAWELEMENTSINDIRECTPROC) (GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride);
+
+// Buffer storage (OpenGL 4.4)
+#define GL_MAP_PERSISTENT_BIT              0x0040
+#define GL_MAP_COHERENT_BIT                0x0080
+#define GL_DYNAMIC_STORAGE_BIT             0x0100
+typedef void (GL_APIENTRYP PFNGLBUFFERSTORAGEPROC) (GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+
 // Texture views (OpenGL 4.3)
 typedef void (GL_APIENTRYP PFNGLTEXTUREVIEWPROC) (GLuint texture, GLenum target, GLuint origtexture, GLenum internalformat, GLuint minlevel, GLuint numlevels, GLuint minlayer, GLuint numlayers);
 
@@ -38,6 +47,10 @@ typedef void (GL_APIENTRYP PFNGLTEXTUREVIEWPROC) (GLuint texture, GLenum target,
 #define GL_CLIP_DEPTH_MODE                 0x935D
 typedef void (GL_APIENTRYP PFNGLCLIPCONTROLPROC) (GLenum origin, GLenum depth);
 
+// Indirect parameters (OpenGL 4.6)
+#define GL_PARAMETER_BUFFER                0x80EE
+typedef void (GL_APIENTRYP PFNGLMULTIDRAWELEMENTSINDIRECTCOUNTPROC) (GLenum mode, GLenum type, const void* indirect, GLintptr drawcount, GLsizei maxdrawcount, GLsizei stride);
+
 // SPIR-V shaders (OpenGL 4.6)
 typedef void (GL_APIENTRYP PFNGLSPECIALIZESHADERPROC) (GLuint shader, const GLchar* pEntryPoint, GLuint numSpecializationConstants, const GLuint* pConstantIndex, const GLuint* pConstantValue);
 
@@ -69,6 +82,7 @@ typedef void (GL_APIENTRYP PFNGLSPECIALIZESHADERPROC) (GLuint shader, const GLch
 	cb(glClearColor, PFNGLCLEARCOLORPROC) \
 	cb(glClearDepthf, PFNGLCLEARDEPTHFPROC) \
 	cb(glClearStencil, PFNGLCLEARSTENCILPROC) \
+	cb(glClientWaitSync, PFNGLCLIENTWAITSYNCPROC) \
 	cb(glColorMask, PFNGLCOLORMASKPROC) \
 	cb(glCompileShader, PFNGLCOMPILESHADERPROC) \
 	cb(glCompressedTexSubImage2D, PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC) \
@@ -86,6 +100,7 @@ typedef void (GL_APIENTRYP PFNGLSPECIALIZESHADERPROC) (GLuint shader, const GLch
 	cb(glDeleteRenderbuffers, PFNGLDELETERENDERBUFFERSPROC) \
 	cb(glDeleteSamplers, PFNGLDELETESAMPLERSPROC) \
 	cb(glDeleteShader, PFNGLDELETESHADERPROC) \
+	cb(glDeleteSync, PFNGLDELETESYNCPROC) \
 	cb(glDeleteTextures, PFNGLDELETETEXTURESPROC) \
 	cb(glDeleteVertexArrays, PFNGLDELETEVERTEXARRAYSPROC) \
 	cb(glDepthFunc, PFNGLDEPTHFUNCPROC) \
@@ -100,6 +115,7 @@ typedef void (GL_APIENTRYP PFNGLSPECIALIZESHADERPROC) (GLuint shader, const GLch
 	cb(glEnable, PFNGLENABLEPROC) \
 	cb(glEnableVertexAttribArray, PFNGLENABLEVERTEXATTRIBARRAYPROC) \
 	cb(glEndQuery, PFNGLENDQUERYPROC) \
+	cb(glFenceSync, PFNGLFENCESYNCPROC) \
 	cb(glFinish, PFNGLFINISHPROC) \
 	cb(glFlush, PFNGLFLUSHPROC) \
 	cb(glFramebufferRenderbuffer, PFNGLFRAMEBUFFERRENDERBUFFERPROC) \
@@ -195,10 +211,13 @@ typedef void (GL_APIENTRYP PFNGLSPECIALIZESHADERPROC) (GLuint shader, const GLch
 	cb(glVertexAttribIPointer, PFNGLVERTEXATTRIBIPOINTERPROC) \
 	cb(glVertexAttribPointer, PFNGLVERTEXATTRIBPOINTERPROC) \
 	cb(glViewport, PFNGLVIEWPORTPROC) \
+	cb(glWaitSync, PFNGLWAITSYNCPROC) \
 	/* Core OpenGL (extension in OpenGL ES) */ \
 	extCb(glDebugMessageControl, PFNGLDEBUGMESSAGECONTROLPROC) \
 	extCb(glDrawBuffer, PFNGLDRAWBUFFERPROC) \
 	extCb(glPolygonMode, PFNGLPOLYGONMODEPROC) \
+	/* OpenGL 4.0 - OpenGL ES 3.1 */\
+	extCb(glDrawElementsIndirect, PFNGLDRAWELEMENTSINDIRECTPROC) \
 	/* OpenGL 4.2 - OpenGL ES 3.1 */\
 	extCb(glBindImageTexture, PFNGLBINDIMAGETEXTUREPROC) \
 	extCb(glGetBooleani_v, PFNGLGETBOOLEANI_VPROC) \
@@ -212,10 +231,16 @@ typedef void (GL_APIENTRYP PFNGLSPECIALIZESHADERPROC) (GLuint shader, const GLch
 	extCb(glObjectLabel, PFNGLOBJECTLABELPROC) \
 	extCb(glPopDebugGroup, PFNGLPOPDEBUGGROUPPROC) \
 	extCb(glPushDebugGroup, PFNGLPUSHDEBUGGROUPPROC) \
+	/* OpenGL 4.3 - GL_EXT_multi_draw_indirect */ \
+	extCb(glMultiDrawElementsIndirect, PFNGLMULTIDRAWELEMENTSINDIRECTPROC) \
 	/* OpenGL 4.3 - GL_ARB_texture_view */ \
 	extCb(glTextureView, PFNGLTEXTUREVIEWPROC) \
+	/* OpenGL 4.4 - GL_EXT_buffer_storage */ \
+	extCb(glBufferStorage, PFNGLBUFFERSTORAGEPROC) \
 	/* OpenGL 4.5 - GL_ARB_clip_control/GL_EXT_clip_control */ \
 	extCb(glClipControl, PFNGLCLIPCONTROLPROC) \
+	/* OpenGL 4.6 - GL_ARB_indirect_parameters */\
+	extCb(glMultiDrawElementsIndirectCount, PFNGLMULTIDRAWELEMENTSINDIRECTCOUNTPROC) \
 	/* OpenGL 4.6 - GL_ARB_spirv_extensions */\
 	extCb(glSpecializeShader, PFNGLSPECIALIZESHADERPROC) \
 
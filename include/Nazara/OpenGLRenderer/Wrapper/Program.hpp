@@ -11,6 +11,7 @@
 #include <Nazara/OpenGLRenderer/OpenGLDevice.hpp>
 #include <Nazara/OpenGLRenderer/Wrapper/DeviceObject.hpp>
 #include <NazaraUtils/MovableValue.hpp>
+#include <vector>
 
 namespace Nz::GL
 {
@@ -35,6 +36,7 @@ namespace Nz::GL
 			inline std::string GetActiveUniformName(GLuint index) const;
 			inline std::vector<GLint> GetActiveUniforms(GLsizei uniformCount, const GLuint* uniformIndices, GLenum pname) const;
 			inline void GetActiveUniforms(GLsizei uniformCount, const GLuint* uniformIndices, GLenum pname, GLint* params) const;
+			inline bool GetBinary(GLenum* binaryFormat, std::vector<UInt8>* binary) const;
 			inline bool GetLinkStatus(std::string* error = nullptr) const;
 			inline GLuint GetUniformBlockIndex(const char* uniformBlockName) const;
 			inline GLuint GetUniformBlockIndex(const std::string& uniformBlockName) const;
@@ -43,6 +45,9 @@ namespace Nz::GL
 
 			inline void Link();
 
+			inline void SetBinary(GLenum binaryFormat, const void* binary, GLsizei length);
+			inline void SetParameter(GLenum pname, GLint value);
+
 			inline void Uniform(GLint uniformLocation, float value) const;
 			inline void Uniform(GLint uniformLocation, int value) const;
 			inline void UniformBlockBinding(GLuint uniformBlockIndex, GLuint uniformBlockBinding) const;
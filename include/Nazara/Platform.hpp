@@ -36,6 +36,7 @@
 #include <Nazara/Platform/CursorController.hpp>
 #include <Nazara/Platform/Enums.hpp>
 #include <Nazara/Platform/Icon.hpp>
+#include <Nazara/Platform/InputSnapshot.hpp>
 #include <Nazara/Platform/Keyboard.hpp>
 #include <Nazara/Platform/Mouse.hpp>
 #include <Nazara/Platform/Platform.hpp>
@@ -0,0 +1,35 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Platform module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_PLATFORM_INPUTSNAPSHOT_HPP
+#define NAZARA_PLATFORM_INPUTSNAPSHOT_HPP
+
+#include <Nazara/Core/Time.hpp>
+#include <Nazara/Math/Vector2.hpp>
+#include <Nazara/Platform/Keyboard.hpp>
+#include <Nazara/Platform/Mouse.hpp>
+#include <array>
+
+namespace Nz
+{
+	// Input state of a window, built from its queued events (see Window::EnableEventQueue)
+	struct InputSnapshot
+	{
+		std::array<bool, Keyboard::ScancodeCount> keyStates = {};       //< keys held down
+		std::array<bool, Keyboard::ScancodeCount> pressedKeys = {};      //< keys pressed since the previous snapshot (even if released since)
+		std::array<bool, Keyboard::ScancodeCount> releasedKeys = {};     //< keys released since the previous snapshot
+		std::array<bool, Mouse::ButtonCount> buttonStates = {};          //< mouse buttons held down
+		std::array<bool, Mouse::ButtonCount> pressedButtons = {};        //< mouse buttons pressed since the previous snapshot
+		std::array<bool, Mouse::ButtonCount> releasedButtons = {};       //< mouse buttons released since the previous snapshot
+		Time timestamp = Time::Zero();                                   //< pump time of the most recent event
+		Vector2i mouseDelta = Vector2i::Zero();                          //< mouse motion accumulated since the previous snapshot
+		Vector2i mousePosition = Vector2i::Zero();
+		float wheelDelta = 0.f;                                          //< wheel motion accumulated since the previous snapshot
+		std::size_t eventCount = 0;                                      //< events processed for this snapshot, after mouse motion coalescing
+	};
+}
+
+#endif // NAZARA_PLATFORM_INPUTSNAPSHOT_HPP
@@ -327,6 +327,8 @@ namespace Nz
 			static void StopTextInput();
 			static Scancode ToScanCode(VKey key);
 			static VKey ToVirtualKey(Scancode key);
+
+			static constexpr std::size_t ScancodeCount = static_cast<std::size_t>(Scancode::Max) + 1;
 	};
 }
 
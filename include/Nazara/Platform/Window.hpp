@@ -16,11 +16,13 @@
 #include <Nazara/Platform/CursorController.hpp>
 #include <Nazara/Platform/Enums.hpp>
 #include <Nazara/Platform/Icon.hpp>
+#include <Nazara/Platform/InputSnapshot.hpp>
 #include <Nazara/Platform/VideoMode.hpp>
 #include <Nazara/Platform/WindowEventHandler.hpp>
 #include <Nazara/Platform/WindowHandle.hpp>
 #include <NazaraUtils/MovablePtr.hpp>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <queue>
 
@@ -51,11 +53,13 @@ namespace Nz
 			void Destroy();
 
 			inline void EnableCloseOnQuit(bool closeOnQuit);
+			void EnableEventQueue(bool enable = true, std::size_t capacity = 1024);
 
 			inline const std::shared_ptr<Cursor>& GetCursor() const;
 			inline CursorController& GetCursorController();
 			inline WindowEventHandler& GetEventHandler();
 			WindowHandle GetHandle() const;
+			inline const InputSnapshot& GetInputSnapshot() const;
 			const Vector2i& GetPosition() const;
 			const Vector2ui& GetSize() const;
 			WindowStyleFlags GetStyle() const;
@@ -65,12 +69,15 @@ namespace Nz
 
 			bool HasFocus() const;
 
+			inline bool IsEventQueueEnabled() const;
 			bool IsMinimized() const;
 			inline bool IsOpen(bool checkClosed = true);
 			inline bool IsOpen() const;
 			inline bool IsValid() const;
 			bool IsVisible() const;
 
+			std::size_t ProcessQueuedEvents();
+
 			void SetCursor(std::shared_ptr<Cursor> cursor);
 			inline void SetCursor(SystemCursor systemCursor);
 			void SetFocus();
@@ -93,6 +100,8 @@ namespace Nz
 			static void ProcessEvents();
 
 		private:
+			struct EventQueue;
+
 			void ConnectSlots();
 			void DisconnectSlots();
 
@@ -101,6 +110,8 @@ namespace Nz
 
 			void IgnoreNextMouseEvent(int mouseX, int mouseY) const;
 
+			void UpdateInputSnapshot(const WindowEvent& event);
+
 			static bool Initialize();
 			static void Uninitialize();
 
@@ -108,8 +119,10 @@ namespace Nz
 
 			std::shared_ptr<Cursor> m_cursor;
 			std::shared_ptr<Icon> m_icon;
+			std::unique_ptr<EventQueue> m_eventQueue;
 			std::unique_ptr<WindowImpl> m_impl;
 			CursorController m_cursorController;
+			InputSnapshot m_inputSnapshot;
 			Vector2i m_position;
 			Vector2ui m_size;
 			WindowEventHandler m_eventHandler;
@@ -50,6 +50,11 @@ namespace Nz
 		return m_eventHandler;
 	}
 
+	inline const InputSnapshot& Window::GetInputSnapshot() const
+	{
+		return m_inputSnapshot;
+	}
+
 	inline const Vector2i& Window::GetPosition() const
 	{
 		NazaraAssert(m_impl, "Window not created");
@@ -62,6 +67,11 @@ namespace Nz
 		return m_size;
 	}
 
+	inline bool Window::IsEventQueueEnabled() const
+	{
+		return m_eventQueue != nullptr;
+	}
+
 	inline bool Window::IsOpen(bool checkClosed)
 	{
 		if (!m_impl)
@@ -0,0 +1,32 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Renderer module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_RENDERER_ASYNCUPLOAD_HPP
+#define NAZARA_RENDERER_ASYNCUPLOAD_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Renderer/Config.hpp>
+
+namespace Nz
+{
+	class NAZARA_RENDERER_API AsyncUpload
+	{
+		public:
+			AsyncUpload() = default;
+			AsyncUpload(const AsyncUpload&) = delete;
+			AsyncUpload(AsyncUpload&&) = delete;
+			virtual ~AsyncUpload();
+
+			virtual bool IsFinished() const = 0;
+
+			virtual void Wait() = 0;
+
+			AsyncUpload& operator=(const AsyncUpload&) = delete;
+			AsyncUpload& operator=(AsyncUpload&&) = delete;
+	};
+}
+
+#endif // NAZARA_RENDERER_ASYNCUPLOAD_HPP
@@ -9,6 +9,7 @@
 
 #include <NazaraUtils/Prerequisites.hpp>
 #include <Nazara/Renderer/Config.hpp>
+#include <Nazara/Renderer/RenderDeviceStatistics.hpp>
 #include <memory>
 #include <string_view>
 
@@ -29,13 +30,19 @@ namespace Nz
 			CommandBuffer(CommandBuffer&&) = delete;
 			virtual ~CommandBuffer();
 
+			inline const CommandBufferStatistics& GetStatistics() const;
+
 			virtual void UpdateDebugName(std::string_view name) = 0;
+			inline void UpdateStatistics(const CommandBufferStatistics& statistics);
 
 			CommandBuffer& operator=(const CommandBuffer&) = delete;
 			CommandBuffer& operator=(CommandBuffer&&) = delete;
 
 		protected:
 			virtual void Release() = 0;
+
+		private:
+			CommandBufferStatistics m_statistics;
 	};
 
 	class CommandBufferDeleter
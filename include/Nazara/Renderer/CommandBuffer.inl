@@ -6,6 +6,25 @@
 
 namespace Nz
 {
+	/*!
+	* \brief Returns the statistics of the commands recorded in this command buffer
+	* \return Command statistics, accounted each time the command buffer is submitted
+	*/
+	inline const CommandBufferStatistics& CommandBuffer::GetStatistics() const
+	{
+		return m_statistics;
+	}
+
+	/*!
+	* \brief Sets the statistics of the commands recorded in this command buffer (called by the command pool once it's built)
+	*
+	* \param statistics Statistics gathered by the command buffer builder
+	*/
+	inline void CommandBuffer::UpdateStatistics(const CommandBufferStatistics& statistics)
+	{
+		m_statistics = statistics;
+	}
+
 	inline void CommandBufferDeleter::operator()(CommandBuffer* commandBuffer)
 	{
 		commandBuffer->Release();
@@ -14,6 +14,7 @@
 #include <Nazara/Renderer/Config.hpp>
 #include <Nazara/Renderer/Enums.hpp>
 #include <Nazara/Renderer/RenderBufferView.hpp>
+#include <Nazara/Renderer/RenderDeviceStatistics.hpp>
 #include <Nazara/Renderer/UploadPool.hpp>
 #include <Nazara/Utility/Enums.hpp>
 #include <string_view>
@@ -32,6 +33,7 @@ namespace Nz
 	{
 		public:
 			struct ClearValues;
+			struct DrawIndexedIndirectCommand;
 
 			CommandBufferBuilder() = default;
 			CommandBufferBuilder(const CommandBufferBuilder&) = delete;
@@ -64,23 +66,33 @@ namespace Nz
 
 			virtual void Draw(UInt32 vertexCount, UInt32 instanceCount = 1, UInt32 firstVertex = 0, UInt32 firstInstance = 0) = 0;
 			virtual void DrawIndexed(UInt32 indexCount, UInt32 instanceCount = 1, UInt32 firstIndex = 0, UInt32 firstInstance = 0) = 0;
+			virtual void DrawIndexedIndirect(const RenderBufferView& indirectBuffer, UInt32 drawCount, UInt32 stride = sizeof(DrawIndexedIndirectCommand)) = 0;
+			virtual void DrawIndexedIndirectCount(const RenderBufferView& indirectBuffer, const RenderBufferView& countBuffer, UInt32 maxDrawCount, UInt32 stride = sizeof(DrawIndexedIndirectCommand)) = 0;
 
 			virtual void Dispatch(UInt32 workgroupX, UInt32 workgroupY, UInt32 workgroupZ) = 0;
 
 			virtual void EndDebugRegion() = 0;
 			virtual void EndRenderPass() = 0;
 
+			inline const CommandBufferStatistics& GetStatistics() const;
+
 			virtual void InsertDebugLabel(std::string_view label, const Color& color) = 0;
 
+			virtual void MemoryBarrier(PipelineStageFlags srcStageMask, PipelineStageFlags dstStageMask, MemoryAccessFlags srcAccessMask, MemoryAccessFlags dstAccessMask) = 0;
+
 			virtual void NextSubpass() = 0;
 
 			virtual void PreTransferBarrier() = 0;
 			virtual void PostTransferBarrier() = 0;
 
+			virtual void PushConstants(const RenderPipelineLayout& pipelineLayout, UInt32 offset, UInt32 size, const void* data) = 0;
+
 			virtual void SetScissor(const Recti& scissorRegion) = 0;
 			virtual void SetViewport(const Recti& viewportRegion) = 0;
 
+			virtual void TextureAcquireBarrier(PipelineStageFlags srcStageMask, PipelineStageFlags dstStageMask, MemoryAccessFlags srcAccessMask, MemoryAccessFlags dstAccessMask, TextureLayout oldLayout, TextureLayout newLayout, QueueType srcQueue, QueueType dstQueue, const Texture& texture) = 0;
 			virtual void TextureBarrier(PipelineStageFlags srcStageMask, PipelineStageFlags dstStageMask, MemoryAccessFlags srcAccessMask, MemoryAccessFlags dstAccessMask, TextureLayout oldLayout, TextureLayout newLayout, const Texture& texture) = 0;
+			virtual void TextureReleaseBarrier(PipelineStageFlags srcStageMask, PipelineStageFlags dstStageMask, MemoryAccessFlags srcAccessMask, MemoryAccessFlags dstAccessMask, TextureLayout oldLayout, TextureLayout newLayout, QueueType srcQueue, QueueType dstQueue, const Texture& texture) = 0;
 
 			CommandBufferBuilder& operator=(const CommandBufferBuilder&) = delete;
 			CommandBufferBuilder& operator=(CommandBufferBuilder&&) = default;
@@ -91,6 +103,19 @@ namespace Nz
 				float depth = 1.f;
 				UInt32 stencil = 0;
 			};
+
+			// Layout of the commands read by DrawIndexedIndirect (matches VkDrawIndexedIndirectCommand and OpenGL DrawElementsIndirectCommand)
+			struct DrawIndexedIndirectCommand
+			{
+				UInt32 indexCount;
+				UInt32 instanceCount;
+				UInt32 firstIndex;
+				Int32 vertexOffset;
+				UInt32 firstInstance;
+			};
+
+		protected:
+			CommandBufferStatistics m_statistics;
 	};
 }
 
@@ -25,6 +25,11 @@ namespace Nz
 	{
 		return CopyBuffer(allocation, target, allocation.size);
 	}
+
+	inline const CommandBufferStatistics& CommandBufferBuilder::GetStatistics() const
+	{
+		return m_statistics;
+	}
 }
 
 #include <Nazara/Renderer/DebugOff.hpp>
@@ -14,8 +14,8 @@
 #include <Nazara/Math/Matrix4.hpp>
 #include <Nazara/Math/Vector3.hpp>
 #include <Nazara/Renderer/Config.hpp>
-#include <Nazara/Renderer/UploadPool.hpp>
 #include <Nazara/Utility/VertexStruct.hpp>
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -30,6 +30,12 @@ namespace Nz
 	class ShaderBinding;
 	class Skeleton;
 
+	/*!
+	* \brief Immediate mode drawing of debug shapes
+	*
+	* Lines are uploaded to a persistent vertex buffer every frame, while boxes, spheres and frustums are drawn as instances of unit meshes
+	* (MaxInstancePerDraw per draw call), keeping the cost low even with many shapes.
+	*/
 	class NAZARA_RENDERER_API DebugDrawer
 	{
 		public:
@@ -40,12 +46,19 @@ namespace Nz
 
 			void Draw(CommandBufferBuilder& builder);
 
-			inline void DrawBox(const Boxf& box, const Color& color);
+			void DrawBox(const Boxf& box, const Color& color);
+			void DrawBox(const Matrix4f& transformMatrix, const Color& color);
 			inline void DrawFrustum(const Frustumf& frustum, const Color& color);
+			void DrawFrustum(const Matrix4f& viewProjMatrix, const Color& color);
 			inline void DrawLine(const Vector3f& start, const Vector3f& end, const Color& color);
 			inline void DrawLine(const Vector3f& start, const Vector3f& end, const Color& startColor, const Color& endColor);
 			inline void DrawPoint(const Vector3f& point, const Color& color, float boxSize = 0.01f);
 			void DrawSkeleton(const Skeleton& skeleton, const Color& color);
+			void DrawSphere(const Vector3f& center, float radius, const Color& color);
+
+			inline void EnableDepthTest(bool enable);
+
+			inline bool IsDepthTestEnabled() const;
 
 			void Prepare(RenderFrame& renderFrame);
 
@@ -57,42 +70,79 @@ namespace Nz
 			DebugDrawer& operator=(DebugDrawer&&) = delete;
 
 			static constexpr std::size_t DefaultVertexBlockSize = 4096;
+			static constexpr std::size_t MaxInstancePerDraw = 128; //< must match DebugDraw shader
+			static constexpr std::size_t SphereSegmentCount = 32;
 
 		private:
-			struct ViewerData
+			enum class Primitive
+			{
+				Box,
+				Sphere,
+
+				Max = Sphere
+			};
+
+			static constexpr std::size_t PrimitiveCount = static_cast<std::size_t>(Primitive::Max) + 1;
+
+			void AddInstance(Primitive primitive, const Matrix4f& transformMatrix, const Color& color);
+			void BuildUnitMeshes();
+
+			struct InstanceBlock
 			{
 				std::shared_ptr<RenderBuffer> buffer;
 				std::shared_ptr<ShaderBinding> binding;
 			};
 
-			struct DataPool
+			struct InstanceData
 			{
-				std::vector<std::shared_ptr<RenderBuffer>> vertexBuffers;
-				std::vector<ViewerData> viewerData;
+				Matrix4f transformMatrix;
+				Color color;
 			};
 
-			struct DrawCall
+			// Draw commands are split between depth-tested (index 1) and always visible (index 0) shapes
+			struct DrawList
 			{
-				std::shared_ptr<RenderBuffer> vertexBuffer;
+				std::array<std::vector<InstanceData>, PrimitiveCount> instances;
+				std::vector<VertexStruct_XYZ_Color> lineVertices;
+			};
+
+			struct InstanceDrawCall
+			{
+				Primitive primitive;
+				std::size_t blockIndex;
+				std::size_t instanceCount;
+				bool depthTest;
+			};
+
+			struct LineDrawCall
+			{
+				std::size_t firstVertex;
 				std::size_t vertexCount;
+				bool depthTest;
 			};
 
-			struct PendingUpload
+			struct UnitMesh
 			{
-				UploadPool::Allocation* allocation;
-				RenderBuffer* vertexBuffer;
+				std::size_t firstVertex;
+				std::size_t vertexCount;
 			};
 
-			std::shared_ptr<DataPool> m_dataPool;
-			std::shared_ptr<RenderPipeline> m_renderPipeline;
+			std::array<DrawList, 2> m_drawLists;
+			std::array<std::shared_ptr<RenderPipeline>, 2> m_instancePipelines;
+			std::array<std::shared_ptr<RenderPipeline>, 2> m_linePipelines;
+			std::array<UnitMesh, PrimitiveCount> m_unitMeshes;
+			std::shared_ptr<RenderBuffer> m_lineVertexBuffer;
+			std::shared_ptr<RenderBuffer> m_unitMeshBuffer;
+			std::shared_ptr<RenderBuffer> m_viewerDataBuffer;
 			std::shared_ptr<RenderPipelineLayout> m_renderPipelineLayout;
 			std::size_t m_vertexPerBlock;
-			std::vector<DrawCall> m_drawCalls;
-			std::vector<PendingUpload> m_pendingUploads;
+			std::vector<InstanceBlock> m_instanceBlocks;
+			std::vector<InstanceDrawCall> m_instanceDrawCalls;
+			std::vector<LineDrawCall> m_lineDrawCalls;
 			std::vector<UInt8> m_viewerData;
-			std::vector<VertexStruct_XYZ_Color> m_lineVertices;
 			RenderDevice& m_renderDevice;
-			ViewerData m_currentViewerData;
+			bool m_depthTest;
+			bool m_drawDataPrepared;
 			bool m_viewerDataUpdated;
 	};
 }
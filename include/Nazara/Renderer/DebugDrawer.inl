@@ -7,25 +7,6 @@
 
 namespace Nz
 {
-	inline void DebugDrawer::DrawBox(const Boxf& box, const Color& color)
-	{
-		Vector3f max = box.GetMaximum();
-		Vector3f min = box.GetMinimum();
-
-		DrawLine({ min.x, min.y, min.z }, { max.x, min.y, min.z }, color);
-		DrawLine({ min.x, min.y, min.z }, { min.x, max.y, min.z }, color);
-		DrawLine({ min.x, min.y, min.z }, { min.x, min.y, max.z }, color);
-		DrawLine({ max.x, max.y, max.z }, { min.x, max.y, max.z }, color);
-		DrawLine({ max.x, max.y, max.z }, { max.x, min.y, max.z }, color);
-		DrawLine({ max.x, max.y, max.z }, { max.x, max.y, min.z }, color);
-		DrawLine({ min.x, min.y, max.z }, { max.x, min.y, max.z }, color);
-		DrawLine({ min.x, min.y, max.z }, { min.x, max.y, max.z }, color);
-		DrawLine({ min.x, max.y, min.z }, { max.x, max.y, min.z }, color);
-		DrawLine({ min.x, max.y, min.z }, { min.x, max.y, max.z }, color);
-		DrawLine({ max.x, min.y, min.z }, { max.x, max.y, min.z }, color);
-		DrawLine({ max.x, min.y, min.z }, { max.x, min.y, max.z }, color);
-	}
-
 	inline void DebugDrawer::DrawFrustum(const Frustumf& frustum, const Color& color)
 	{
 		EnumArray<BoxCorner, Vector3f> corners = frustum.ComputeCorners();
@@ -51,11 +32,13 @@ namespace Nz
 
 	inline void DebugDrawer::DrawLine(const Vector3f& start, const Vector3f& end, const Color& startColor, const Color& endColor)
 	{
-		auto& startVertex = m_lineVertices.emplace_back();
+		auto& lineVertices = m_drawLists[m_depthTest].lineVertices;
+
+		auto& startVertex = lineVertices.emplace_back();
 		startVertex.color = startColor;
 		startVertex.position = start;
 
-		auto& endVertex = m_lineVertices.emplace_back();
+		auto& endVertex = lineVertices.emplace_back();
 		endVertex.color = endColor;
 		endVertex.position = end;
 	}
@@ -64,6 +47,21 @@ namespace Nz
 	{
 		return DrawBox(Boxf(point - Vector3f(boxSize * 0.5f), Vector3f(boxSize)), color);
 	}
+
+	/*!
+	* \brief Enables or disables depth testing for the following draws
+	*
+	* Shapes drawn without depth testing are visible through geometry, depth testing is enabled by default.
+	*/
+	inline void DebugDrawer::EnableDepthTest(bool enable)
+	{
+		m_depthTest = enable;
+	}
+
+	inline bool DebugDrawer::IsDepthTestEnabled() const
+	{
+		return m_depthTest;
+	}
 }
 
 #include <Nazara/Renderer/DebugOff.hpp>
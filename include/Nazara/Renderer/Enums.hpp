@@ -48,6 +48,12 @@ namespace Nz
 		Window
 	};
 
+	enum class FramePacing
+	{
+		LowLatency, //< waits for the frame slot as late as possible (see Swapchain::WaitForFrame) and limits queued presentations
+		Throughput  //< lets the CPU run ahead of the GPU by up to the number of frames in flight
+	};
+
 	enum class MemoryAccess
 	{
 		ColorRead,
@@ -56,6 +62,7 @@ namespace Nz
 		DepthStencilWrite,
 		IndexBufferRead,
 		IndirectCommandRead,
+		InputAttachmentRead,
 		HostRead,
 		HostWrite,
 		MemoryRead,
@@ -89,6 +96,7 @@ namespace Nz
 		FragmentTestsEarly,
 		FragmentTestsLate,
 		GeometryShader,
+		Host,
 		TessellationControlShader,
 		TessellationEvaluationShader,
 		Transfer,
@@ -149,9 +157,11 @@ namespace Nz
 		Direct3D,  //< Microsoft Render API, only works on MS platforms
 		Mantle,    //< AMD Render API, Vulkan predecessor, only works on AMD GPUs
 		Metal,     //< Apple Render API, only works on OS X platforms
+		Null,      //< Dummy Render API, records commands without executing them (for testing and benchmarking)
 		OpenGL,    //< Khronos Render API, works on Desktop and some consoles
 		OpenGL_ES, //< Khronos Render API, works on Web, Mobile and some consoles
 		Vulkan,    //< New Khronos Render API, made to replace OpenGL, works on desktop (Windows/Linux) and mobile (Android), and Apple platform using MoltenVK
+		WebGPU,    //< W3C Render API, only works on Web
 
 		Unknown,   //< RenderAPI not corresponding to an entry of the enum, or result of a failed query
 
@@ -182,6 +192,23 @@ namespace Nz
 		Max = Unknown
 	};
 
+	enum class ShaderBindingFlag
+	{
+		PartiallyBound,           //< Not every array element has to be valid, as long as the shader doesn't access invalid ones
+		UpdateAfterBind,          //< Descriptors can be updated after the binding has been bound (but not while it's in use by a submitted command)
+		UpdateUnusedWhilePending, //< Descriptors not accessed by submitted commands can be updated while they're executing
+
+		Max = UpdateUnusedWhilePending
+	};
+
+	template<>
+	struct EnumAsFlags<ShaderBindingFlag>
+	{
+		static constexpr ShaderBindingFlag max = ShaderBindingFlag::Max;
+	};
+
+	using ShaderBindingFlags = Flags<ShaderBindingFlag>;
+
 	enum class ShaderBindingType
 	{
 		Sampler,
@@ -199,7 +226,8 @@ namespace Nz
 		MSL,
 		NazaraBinary,
 		NazaraShader,
-		SpirV
+		SpirV,
+		WGSL
 	};
 
 	enum class TextureAccess
@@ -231,8 +259,10 @@ namespace Nz
 		ShaderSampling,
 		TransferSource,
 		TransferDestination,
+		TransientAttachment, //< content only lives during a render pass, may be backed by lazily-allocated memory
+		Streamed,            //< frequently reallocated sampled texture kept within the memory budget, may be relocated by RenderDevice::DefragmentStreamedTextures
 
-		Max = TransferDestination
+		Max = Streamed
 	};
 
 	template<>
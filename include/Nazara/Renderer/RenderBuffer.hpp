@@ -10,6 +10,7 @@
 #include <NazaraUtils/Prerequisites.hpp>
 #include <Nazara/Renderer/Config.hpp>
 #include <Nazara/Utility/Buffer.hpp>
+#include <atomic>
 #include <memory>
 #include <string_view>
 
@@ -27,6 +28,7 @@ namespace Nz
 
 			inline RenderDevice& GetRenderDevice();
 			inline const RenderDevice& GetRenderDevice() const;
+			inline UInt64 GetResourceId() const;
 
 			virtual void UpdateDebugName(std::string_view name) = 0;
 
@@ -35,6 +37,9 @@ namespace Nz
 
 		private:
 			RenderDevice& m_renderDevice;
+			UInt64 m_resourceId;
+
+			static std::atomic<UInt64> s_nextResourceId;
 	};
 
 	NAZARA_RENDERER_API BufferFactory GetRenderBufferFactory(std::shared_ptr<RenderDevice> device);
@@ -8,7 +8,8 @@ namespace Nz
 {
 	inline RenderBuffer::RenderBuffer(RenderDevice& renderDevice, BufferType type, UInt64 size, BufferUsageFlags usage) :
 	Buffer(DataStorage::Hardware, type, size, usage),
-	m_renderDevice(renderDevice)
+	m_renderDevice(renderDevice),
+	m_resourceId(s_nextResourceId++)
 	{
 	}
 
@@ -21,6 +22,14 @@ namespace Nz
 	{
 		return m_renderDevice;
 	}
+
+	/*!
+	* \brief Returns an identifier unique to this buffer, which is never reused by another buffer (unlike its address)
+	*/
+	inline UInt64 RenderBuffer::GetResourceId() const
+	{
+		return m_resourceId;
+	}
 }
 
 #include <Nazara/Renderer/DebugOff.hpp>
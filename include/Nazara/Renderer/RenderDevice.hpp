@@ -8,12 +8,14 @@
 #define NAZARA_RENDERER_RENDERDEVICE_HPP
 
 #include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Renderer/AsyncUpload.hpp>
 #include <Nazara/Renderer/ComputePipeline.hpp>
 #include <Nazara/Renderer/Config.hpp>
 #include <Nazara/Renderer/Enums.hpp>
 #include <Nazara/Renderer/Framebuffer.hpp>
 #include <Nazara/Renderer/RenderBuffer.hpp>
 #include <Nazara/Renderer/RenderDeviceInfo.hpp>
+#include <Nazara/Renderer/RenderDeviceStatistics.hpp>
 #include <Nazara/Renderer/RenderPass.hpp>
 #include <Nazara/Renderer/RenderPipeline.hpp>
 #include <Nazara/Renderer/RenderPipelineLayout.hpp>
@@ -21,18 +23,25 @@
 #include <Nazara/Renderer/SwapchainParameters.hpp>
 #include <Nazara/Renderer/Texture.hpp>
 #include <Nazara/Renderer/TextureSampler.hpp>
+#include <Nazara/Renderer/TransientResources.hpp>
 #include <Nazara/Utility/PixelFormat.hpp>
+#include <NazaraUtils/EnumArray.hpp>
 #include <NazaraUtils/FunctionRef.hpp>
 #include <NZSL/ShaderWriter.hpp>
 #include <NZSL/Ast/Module.hpp>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace Nz
 {
 	class CommandBufferBuilder;
 	class CommandPool;
+	class RenderFrame;
 	class ShaderModule;
+	class UploadPool;
 
 	class NAZARA_RENDERER_API RenderDevice
 	{
@@ -40,8 +49,12 @@ namespace Nz
 			RenderDevice() = default;
 			virtual ~RenderDevice();
 
+			virtual void DefragmentStreamedTextures(RenderFrame& renderFrame, UInt64 maxBytes, const FunctionRef<void(Texture& texture)>& relocationCallback);
+
 			virtual const RenderDeviceInfo& GetDeviceInfo() const = 0;
 			virtual const RenderDeviceFeatures& GetEnabledFeatures() const = 0;
+			RenderFrameStatistics GetFrameStatistics() const;
+			virtual std::vector<RenderMemoryHeapStatistics> GetMemoryHeapStatistics() const;
 
 			virtual std::shared_ptr<RenderBuffer> InstantiateBuffer(BufferType type, UInt64 size, BufferUsageFlags usageFlags, const void* initialData = nullptr) = 0;
 			virtual std::shared_ptr<CommandPool> InstantiateCommandPool(QueueType queueType) = 0;
@@ -58,11 +71,46 @@ namespace Nz
 			virtual std::shared_ptr<Texture> InstantiateTexture(const TextureInfo& params, const void* initialData, bool buildMipmaps, unsigned int srcWidth = 0, unsigned int srcHeight = 0) = 0;
 			virtual std::shared_ptr<TextureSampler> InstantiateTextureSampler(const TextureSamplerInfo& params) = 0;
 
+			virtual bool IsParallelCommandRecordingSupported() const;
 			virtual bool IsTextureFormatSupported(PixelFormat format, TextureUsage usage) const = 0;
 
+			template<typename T> void PushForRelease(const T& value) = delete;
+			template<typename T> void PushForRelease(T&& value);
+			template<typename F> void PushReleaseCallback(F&& callback);
+
+			void RegisterCommandBufferSubmission(const CommandBufferStatistics& statistics);
+			void RegisterFramePresentation(const UploadPool& uploadPool);
+
+			void ReleaseCompletedResources();
+
+			virtual std::shared_ptr<AsyncUpload> UploadAsync(RenderBuffer& buffer, const void* data, UInt64 offset, UInt64 size);
+			virtual std::shared_ptr<AsyncUpload> UploadAsync(Texture& texture, const void* data, const Boxui& box, unsigned int srcWidth = 0, unsigned int srcHeight = 0, UInt8 level = 0);
+
 			virtual void WaitForIdle() = 0;
 
 			static void ValidateFeatures(const RenderDeviceFeatures& supportedFeatures, RenderDeviceFeatures& enabledFeatures);
+
+		protected:
+			using QueueTimelineValues = EnumArray<QueueType, UInt64>;
+
+			virtual QueueTimelineValues GetSubmittedTimelineValues() const;
+			virtual QueueTimelineValues QueryCompletedTimelineValues();
+			void ReleaseAllResources();
+
+		private:
+			void PushReleasable(std::unique_ptr<TransientResources::Releasable> releasable);
+
+			struct PendingRelease
+			{
+				std::unique_ptr<TransientResources::Releasable> releasable;
+				QueueTimelineValues timelineValues;
+			};
+
+			std::deque<PendingRelease> m_releaseQueue;
+			std::mutex m_releaseQueueMutex;
+			mutable std::mutex m_frameStatisticsMutex;
+			RenderFrameStatistics m_currentFrameStatistics;
+			RenderFrameStatistics m_lastFrameStatistics;
 	};
 }
 
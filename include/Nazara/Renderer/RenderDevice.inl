@@ -6,6 +6,39 @@
 
 namespace Nz
 {
+	/*!
+	* \brief Keeps an object alive until the GPU is done with the work submitted so far
+	*
+	* \param value Object to destroy once the work submitted before this call has been executed
+	*
+	* \see PushReleaseCallback
+	*/
+	template<typename T>
+	void RenderDevice::PushForRelease(T&& value)
+	{
+		static_assert(std::is_rvalue_reference_v<decltype(value)>);
+
+		return PushReleaseCallback([v = std::move(value)] {});
+	}
+
+	/*!
+	* \brief Calls a function once the GPU is done with the work submitted so far
+	*
+	* Unlike TransientResources::PushReleaseCallback, this doesn't depend on a frame being recycled and works without a swapchain (for example
+	* for resources used by async uploads or headless compute).
+	* Callbacks are called by ReleaseCompletedResources in the order they were pushed.
+	*
+	* \param callback Function to call once the work submitted before this call has been executed
+	*
+	* \remark This function is thread-safe
+	*/
+	template<typename F>
+	void RenderDevice::PushReleaseCallback(F&& callback)
+	{
+		using Functor = TransientResources::ReleasableLambda<std::remove_cv_t<std::remove_reference_t<F>>>;
+
+		return PushReleasable(std::make_unique<Functor>(std::forward<F>(callback)));
+	}
 }
 
 #include <Nazara/Renderer/DebugOff.hpp>
@@ -17,8 +17,12 @@ namespace Nz
 	struct RenderDeviceFeatures
 	{
 		bool anisotropicFiltering = false;
+		bool bindlessTextures = false;
 		bool computeShaders = false;
 		bool depthClamping = false;
+		bool drawIndirectCount = false;
+		bool multiDrawIndirect = false;
+		bool multipleSubpasses = false;
 		bool nonSolidFaceFilling = false;
 		bool storageBuffers = false;
 		bool textureReadWithoutFormat = false;
@@ -33,6 +37,7 @@ namespace Nz
 		UInt32 maxComputeWorkGroupInvocations;
 		Vector3ui32 maxComputeWorkGroupCount;
 		Vector3ui32 maxComputeWorkGroupSize;
+		UInt32 maxPushConstantsSize;
 		UInt64 maxStorageBufferSize;
 		UInt64 maxUniformBufferSize;
 		UInt64 minStorageBufferOffsetAlignment;
@@ -0,0 +1,44 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Renderer module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_RENDERER_RENDERDEVICESTATISTICS_HPP
+#define NAZARA_RENDERER_RENDERDEVICESTATISTICS_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+
+namespace Nz
+{
+	struct CommandBufferStatistics
+	{
+		UInt64 computeDispatchCount = 0;
+		UInt64 drawCallCount = 0;
+		UInt64 drawnVertexCount = 0; //< vertices (or indices) of direct draw calls, including instances
+		UInt64 pipelineBindCount = 0;
+		UInt64 renderPassCount = 0;
+		UInt64 shaderBindingBindCount = 0;
+		UInt64 transferredBytes = 0; //< bytes copied to buffers (including from upload pools)
+	};
+
+	struct RenderFrameStatistics
+	{
+		CommandBufferStatistics commands; //< sum of the statistics of every submitted command buffer
+		UInt64 submittedCommandBufferCount = 0;
+		UInt64 uploadAllocationCount = 0;
+		UInt64 uploadedBytes = 0; //< bytes allocated from upload pools
+	};
+
+	struct RenderMemoryHeapStatistics
+	{
+		UInt64 allocatedBytes = 0;    //< memory allocated by the device from this heap
+		UInt64 budgetBytes = 0;       //< memory the process can use from this heap, as estimated by the driver
+		UInt64 processUsageBytes = 0; //< memory used by the process from this heap, as estimated by the driver
+		UInt64 resourceBytes = 0;     //< part of the allocated memory used by resources
+		UInt64 size = 0;
+		bool isDeviceLocal = false;
+	};
+}
+
+#endif // NAZARA_RENDERER_RENDERDEVICESTATISTICS_HPP
@@ -32,6 +32,7 @@ namespace Nz
 
 			void Execute(const FunctionRef<void(CommandBufferBuilder& builder)>& callback, QueueTypeFlags queueTypeFlags);
 
+			inline LinearAllocator& GetAllocator();
 			inline std::size_t GetFramebufferIndex() const;
 			const Vector2ui& GetSize() const;
 			UploadPool& GetUploadPool();
@@ -44,6 +45,7 @@ namespace Nz
 			void Present();
 
 			void SubmitCommandBuffer(CommandBuffer* commandBuffer, QueueTypeFlags queueTypeFlags) ;
+			void SynchronizeQueues(QueueType waitingQueue, QueueType signalingQueue);
 
 			inline explicit operator bool();
 
@@ -37,6 +37,14 @@ namespace Nz
 		return m_size;
 	}
 
+	inline LinearAllocator& RenderFrame::GetAllocator()
+	{
+		if NAZARA_UNLIKELY(!m_image)
+			throw std::runtime_error("frame is either invalid or has already been presented");
+
+		return m_image->GetAllocator();
+	}
+
 	inline UploadPool& RenderFrame::GetUploadPool()
 	{
 		if NAZARA_UNLIKELY(!m_image)
@@ -85,6 +93,17 @@ namespace Nz
 		m_image->SubmitCommandBuffer(commandBuffer, queueTypeFlags);
 	}
 
+	/*!
+	* \brief Makes the next command buffers submitted to waitingQueue wait for the ones previously submitted to signalingQueue
+	*/
+	inline void RenderFrame::SynchronizeQueues(QueueType waitingQueue, QueueType signalingQueue)
+	{
+		if NAZARA_UNLIKELY(!m_image)
+			throw std::runtime_error("frame is either invalid or has already been presented");
+
+		m_image->SynchronizeQueues(waitingQueue, signalingQueue);
+	}
+
 
 	inline RenderFrame::operator bool()
 	{
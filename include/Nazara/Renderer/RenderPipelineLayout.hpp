@@ -26,9 +26,18 @@ namespace Nz
 			UInt32 arraySize = 1;
 			ShaderBindingType type;
 			nzsl::ShaderStageTypeFlags shaderStageFlags;
+			ShaderBindingFlags flags; //< requires bindlessTextures feature if not empty
+		};
+
+		struct PushConstantRange
+		{
+			UInt32 offset = 0;
+			UInt32 size;
+			nzsl::ShaderStageTypeFlags shaderStageFlags;
 		};
 
 		std::vector<Binding> bindings;
+		std::vector<PushConstantRange> pushConstantRanges; //< ranges must end before RenderDeviceLimits::maxPushConstantsSize
 	};
 
 	class NAZARA_RENDERER_API RenderPipelineLayout
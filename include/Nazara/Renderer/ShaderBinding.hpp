@@ -48,12 +48,19 @@ namespace Nz
 			{
 				const Texture* texture;
 				const TextureSampler* sampler;
+
+				inline bool operator==(const SampledTextureBinding& rhs) const;
+				inline bool operator!=(const SampledTextureBinding& rhs) const;
 			};
 
 			struct SampledTextureBindings
 			{
 				UInt32 arraySize;
 				const SampledTextureBinding* textureBindings;
+				UInt32 firstArrayElement = 0;
+
+				inline bool operator==(const SampledTextureBindings& rhs) const;
+				inline bool operator!=(const SampledTextureBindings& rhs) const;
 			};
 
 			struct StorageBufferBinding
@@ -61,12 +68,18 @@ namespace Nz
 				RenderBuffer* buffer;
 				UInt64 offset;
 				UInt64 range;
+
+				inline bool operator==(const StorageBufferBinding& rhs) const;
+				inline bool operator!=(const StorageBufferBinding& rhs) const;
 			};
 
 			struct TextureBinding
 			{
 				const Texture* texture;
 				TextureAccess access;
+
+				inline bool operator==(const TextureBinding& rhs) const;
+				inline bool operator!=(const TextureBinding& rhs) const;
 			};
 
 			struct UniformBufferBinding
@@ -74,12 +87,18 @@ namespace Nz
 				RenderBuffer* buffer;
 				UInt64 offset;
 				UInt64 range;
+
+				inline bool operator==(const UniformBufferBinding& rhs) const;
+				inline bool operator!=(const UniformBufferBinding& rhs) const;
 			};
 
 			struct Binding
 			{
 				UInt32 bindingIndex;
 				std::variant<SampledTextureBinding, SampledTextureBindings, StorageBufferBinding, TextureBinding, UniformBufferBinding> content;
+
+				inline bool operator==(const Binding& rhs) const;
+				inline bool operator!=(const Binding& rhs) const;
 			};
 
 		protected:
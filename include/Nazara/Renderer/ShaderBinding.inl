@@ -2,6 +2,7 @@
 // This file is part of the "Nazara Engine - Renderer module"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
+#include <algorithm>
 #include <Nazara/Renderer/Debug.hpp>
 
 namespace Nz
@@ -15,6 +16,69 @@ namespace Nz
 	{
 		binding->Release();
 	}
+
+	inline bool ShaderBinding::SampledTextureBinding::operator==(const SampledTextureBinding& rhs) const
+	{
+		return texture == rhs.texture && sampler == rhs.sampler;
+	}
+
+	inline bool ShaderBinding::SampledTextureBinding::operator!=(const SampledTextureBinding& rhs) const
+	{
+		return !operator==(rhs);
+	}
+
+	inline bool ShaderBinding::SampledTextureBindings::operator==(const SampledTextureBindings& rhs) const
+	{
+		if (arraySize != rhs.arraySize || firstArrayElement != rhs.firstArrayElement)
+			return false;
+
+		return std::equal(textureBindings, textureBindings + arraySize, rhs.textureBindings);
+	}
+
+	inline bool ShaderBinding::SampledTextureBindings::operator!=(const SampledTextureBindings& rhs) const
+	{
+		return !operator==(rhs);
+	}
+
+	inline bool ShaderBinding::StorageBufferBinding::operator==(const StorageBufferBinding& rhs) const
+	{
+		return buffer == rhs.buffer && offset == rhs.offset && range == rhs.range;
+	}
+
+	inline bool ShaderBinding::StorageBufferBinding::operator!=(const StorageBufferBinding& rhs) const
+	{
+		return !operator==(rhs);
+	}
+
+	inline bool ShaderBinding::TextureBinding::operator==(const TextureBinding& rhs) const
+	{
+		return texture == rhs.texture && access == rhs.access;
+	}
+
+	inline bool ShaderBinding::TextureBinding::operator!=(const TextureBinding& rhs) const
+	{
+		return !operator==(rhs);
+	}
+
+	inline bool ShaderBinding::UniformBufferBinding::operator==(const UniformBufferBinding& rhs) const
+	{
+		return buffer == rhs.buffer && offset == rhs.offset && range == rhs.range;
+	}
+
+	inline bool ShaderBinding::UniformBufferBinding::operator!=(const UniformBufferBinding& rhs) const
+	{
+		return !operator==(rhs);
+	}
+
+	inline bool ShaderBinding::Binding::operator==(const Binding& rhs) const
+	{
+		return bindingIndex == rhs.bindingIndex && content == rhs.content;
+	}
+
+	inline bool ShaderBinding::Binding::operator!=(const Binding& rhs) const
+	{
+		return !operator==(rhs);
+	}
 }
 
 #include <Nazara/Renderer/DebugOff.hpp>
@@ -8,12 +8,14 @@
 #define NAZARA_RENDERER_SWAPCHAIN_HPP
 
 #include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/Time.hpp>
 #include <Nazara/Math/Vector2.hpp>
 #include <Nazara/Platform/WindowHandle.hpp>
 #include <Nazara/Renderer/Config.hpp>
 #include <Nazara/Renderer/RenderFrame.hpp>
 #include <Nazara/Renderer/RenderPass.hpp>
 #include <Nazara/Renderer/RenderTarget.hpp>
+#include <optional>
 #include <vector>
 
 namespace Nz
@@ -32,6 +34,8 @@ namespace Nz
 
 			virtual std::shared_ptr<CommandPool> CreateCommandPool(QueueType queueType) = 0;
 
+			virtual FramePacing GetFramePacing() const;
+			virtual std::optional<Time> GetLastPresentLatency() const;
 			virtual PresentMode GetPresentMode() const = 0;
 			virtual PresentModeFlags GetSupportedPresentModes() const = 0;
 
@@ -41,6 +45,8 @@ namespace Nz
 
 			virtual TransientResources& Transient() = 0;
 
+			virtual void WaitForFrame();
+
 		protected:
 			static void BuildRenderPass(PixelFormat colorFormat, PixelFormat depthFormat, std::vector<RenderPass::Attachment>& attachments, std::vector<RenderPass::SubpassDescription>& subpassDescriptions, std::vector<RenderPass::SubpassDependency>& subpassDependencies);
 	};
@@ -17,6 +17,8 @@ namespace Nz
 	struct SwapchainParameters
 	{
 		std::vector<PixelFormat> depthFormats = { Nz::PixelFormat::Depth24Stencil8, Nz::PixelFormat::Depth32FStencil8, Nz::PixelFormat::Depth16Stencil8, Nz::PixelFormat::Depth32F, Nz::PixelFormat::Depth24 }; //< By order of preference
+		FramePacing framePacing = FramePacing::Throughput;
+		UInt32 framesInFlight = 0; //< Maximum number of frames the CPU can prepare while the GPU is still rendering, 0 to use the swapchain image count
 		std::vector<PresentMode> presentMode = { PresentMode::Mailbox, PresentMode::Immediate, PresentMode::RelaxedVerticalSync, PresentMode::VerticalSync }; //< By order of preference
 	};
 }
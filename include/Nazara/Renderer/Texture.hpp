@@ -16,6 +16,7 @@
 #include <Nazara/Renderer/Config.hpp>
 #include <Nazara/Renderer/Enums.hpp>
 #include <Nazara/Utility/Image.hpp>
+#include <atomic>
 
 namespace Nz
 {
@@ -64,7 +65,7 @@ namespace Nz
 		public:
 			using Params = TextureParams;
 
-			Texture() = default;
+			Texture();
 			Texture(const Texture&) = delete;
 			Texture(Texture&&) = delete;
 			virtual ~Texture();
@@ -72,7 +73,9 @@ namespace Nz
 			virtual bool Copy(const Texture& source, const Boxui& srcBox, const Vector3ui& dstPos = Vector3ui::Zero()) = 0;
 			virtual std::shared_ptr<Texture> CreateView(const TextureViewInfo& viewInfo) = 0;
 
+			std::size_t GetMemoryUsage() const override;
 			virtual Texture* GetParentTexture() const = 0;
+			inline UInt64 GetResourceId() const;
 			virtual const TextureInfo& GetTextureInfo() const = 0;
 
 			virtual void UpdateDebugName(std::string_view name) = 0;
@@ -99,6 +102,11 @@ namespace Nz
 			static std::shared_ptr<Texture> LoadFromFile(const std::filesystem::path& filePath, const TextureParams& textureParams, const CubemapParams& cubemapParams);
 			static std::shared_ptr<Texture> LoadFromMemory(const void* data, std::size_t size, const TextureParams& textureParams, const CubemapParams& cubemapParams);
 			static std::shared_ptr<Texture> LoadFromStream(Stream& stream, const TextureParams& textureParams, const CubemapParams& cubemapParams);
+
+		private:
+			UInt64 m_resourceId;
+
+			static std::atomic<UInt64> s_nextResourceId;
 	};
 }
 
@@ -6,6 +6,16 @@
 
 namespace Nz
 {
+	/*!
+	* \brief Returns an identifier unique to this texture
+	*
+	* Unlike the texture address, it's never reused by another texture, allowing to identify resources after they may have been destroyed
+	*/
+	inline UInt64 Texture::GetResourceId() const
+	{
+		return m_resourceId;
+	}
+
 	inline TextureInfo Texture::ApplyView(TextureInfo textureInfo, const TextureViewInfo& viewInfo)
 	{
 		textureInfo.type        = viewInfo.viewType;
@@ -10,6 +10,7 @@
 #include <NazaraUtils/Prerequisites.hpp>
 #include <Nazara/Renderer/Config.hpp>
 #include <Nazara/Utility/Enums.hpp>
+#include <atomic>
 #include <functional>
 #include <string_view>
 
@@ -36,11 +37,13 @@ namespace Nz
 	class NAZARA_RENDERER_API TextureSampler
 	{
 		public:
-			TextureSampler() = default;
+			TextureSampler();
 			TextureSampler(const TextureSampler&) = delete;
 			TextureSampler(TextureSampler&&) = delete;
 			virtual ~TextureSampler();
 
+			inline UInt64 GetResourceId() const;
+
 			virtual void UpdateDebugName(std::string_view name) = 0;
 
 			TextureSampler& operator=(const TextureSampler&) = delete;
@@ -48,6 +51,11 @@ namespace Nz
 
 		protected:
 			static void ValidateSamplerInfo(const RenderDevice& device, TextureSamplerInfo& samplerInfo);
+
+		private:
+			UInt64 m_resourceId;
+
+			static std::atomic<UInt64> s_nextResourceId;
 	};
 }
 
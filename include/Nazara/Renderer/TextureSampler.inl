@@ -43,6 +43,14 @@ namespace Nz
 	{
 		return !operator==(samplerInfo);
 	}
+
+	/*!
+	* \brief Returns an identifier unique to this sampler, which is never reused by another sampler
+	*/
+	inline UInt64 TextureSampler::GetResourceId() const
+	{
+		return m_resourceId;
+	}
 }
 
 template<>
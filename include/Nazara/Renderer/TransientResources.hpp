@@ -8,6 +8,7 @@
 #define NAZARA_RENDERER_TRANSIENTRESOURCES_HPP
 
 #include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/LinearAllocator.hpp>
 #include <Nazara/Renderer/Config.hpp>
 #include <Nazara/Renderer/Enums.hpp>
 #include <NazaraUtils/FunctionRef.hpp>
@@ -33,6 +34,7 @@ namespace Nz
 
 			inline void FlushReleaseQueue();
 
+			inline LinearAllocator& GetAllocator();
 			virtual UploadPool& GetUploadPool() = 0;
 
 			template<typename T> void PushForRelease(const T& value) = delete;
@@ -40,19 +42,18 @@ namespace Nz
 			template<typename F> void PushReleaseCallback(F&& callback);
 
 			virtual void SubmitCommandBuffer(CommandBuffer* commandBuffer, QueueTypeFlags queueTypeFlags) = 0;
+			virtual void SynchronizeQueues(QueueType waitingQueue, QueueType signalingQueue) = 0;
 
 		protected:
-			TransientResources() = default;
+			inline TransientResources();
 			TransientResources(const TransientResources&) = delete;
 			TransientResources(TransientResources&&) = delete;
 
 		private:
 			static constexpr std::size_t BlockSize = 4 * 1024 * 1024;
 
-			using Block = std::vector<UInt8>;
-
 			std::vector<Releasable*> m_releaseQueue;
-			std::vector<Block> m_releaseMemoryPool;
+			LinearAllocator m_allocator;
 	};
 
 	class NAZARA_RENDERER_API TransientResources::Releasable
@@ -2,12 +2,19 @@
 // This file is part of the "Nazara Engine - Renderer module"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
-#include <NazaraUtils/Algorithm.hpp>
 #include <NazaraUtils/MemoryHelper.hpp>
 #include <Nazara/Renderer/Debug.hpp>
 
 namespace Nz
 {
+	inline TransientResources::TransientResources() :
+	m_allocator(BlockSize)
+	{
+	}
+
+	/*!
+	* \brief Runs release callbacks and reclaims the memory allocated for this frame
+	*/
 	inline void TransientResources::FlushReleaseQueue()
 	{
 		for (Releasable* releasable : m_releaseQueue)
@@ -17,8 +24,20 @@ namespace Nz
 		}
 		m_releaseQueue.clear();
 
-		for (auto& memoryblock : m_releaseMemoryPool)
-			memoryblock.clear();
+		m_allocator.Reset();
+	}
+
+	/*!
+	* \brief Returns an allocator for temporaries living as long as this frame
+	*
+	* Allocations stay valid until the frame resources are recycled (once the GPU is done with them), and their destructors are not called.
+	* Use PushReleaseCallback for what needs to be destroyed.
+	*
+	* \remark The allocator is not thread-safe
+	*/
+	inline LinearAllocator& TransientResources::GetAllocator()
+	{
+		return m_allocator;
 	}
 
 	template<typename T>
@@ -34,50 +53,7 @@ namespace Nz
 	{
 		using Functor = ReleasableLambda<std::remove_cv_t<std::remove_reference_t<F>>>;
 
-		constexpr std::size_t functorSize = sizeof(Functor);
-		constexpr std::size_t functorAlignment = alignof(Functor);
-
-		// Try to minimize lost space
-		struct
-		{
-			Block* block = nullptr;
-			UInt64 alignedOffset = 0;
-			UInt64 lostSpace = 0;
-		} bestBlock;
-
-		for (Block& block : m_releaseMemoryPool)
-		{
-			std::size_t freeOffset = block.size();
-
-			UInt64 alignedOffset = Align(freeOffset, functorAlignment);
-			if (alignedOffset + functorSize > block.capacity())
-				continue; //< Not enough space
-
-			UInt64 lostSpace = alignedOffset - freeOffset;
-
-			if (!bestBlock.block || lostSpace < bestBlock.lostSpace)
-			{
-				bestBlock.block = &block;
-				bestBlock.alignedOffset = alignedOffset;
-				bestBlock.lostSpace = lostSpace;
-			}
-		}
-
-		// No block found, allocate a new one
-		if (!bestBlock.block)
-		{
-			Block newBlock;
-			newBlock.reserve(BlockSize);
-
-			bestBlock.block = &m_releaseMemoryPool.emplace_back(std::move(newBlock));
-			bestBlock.alignedOffset = 0;
-			bestBlock.lostSpace = 0;
-		}
-
-		Block& targetBlock = *bestBlock.block;
-		targetBlock.resize(bestBlock.alignedOffset + functorSize);
-
-		Functor* releasable = reinterpret_cast<Functor*>(&targetBlock[bestBlock.alignedOffset]);
+		Functor* releasable = static_cast<Functor*>(m_allocator.Allocate(sizeof(Functor), alignof(Functor)));
 		PlacementNew(releasable, std::forward<F>(callback));
 
 		m_releaseQueue.push_back(releasable);
@@ -16,6 +16,7 @@ namespace Nz
 	{
 		public:
 			struct Allocation;
+			struct Stats;
 
 			UploadPool() = default;
 			UploadPool(const UploadPool&) = delete;
@@ -25,6 +26,8 @@ namespace Nz
 			virtual Allocation& Allocate(UInt64 size) = 0;
 			virtual Allocation& Allocate(UInt64 size, UInt64 alignment) = 0;
 
+			inline const Stats& GetStats() const;
+
 			virtual void Reset() = 0;
 
 			UploadPool& operator=(const UploadPool&) = delete;
@@ -43,6 +46,29 @@ namespace Nz
 				void* mappedPtr;
 				UInt64 size;
 			};
+
+			struct Stats
+			{
+				UInt64 allocatedBytes = 0; //< bytes allocated since the last reset
+				UInt64 lastFrameAllocatedBytes = 0; //< bytes allocated between the two last resets
+				UInt64 peakAllocatedBytes = 0; //< highest number of bytes allocated between two resets
+				UInt64 reservedBytes = 0; //< memory currently held by the pool
+				std::size_t allocationCount = 0; //< allocations since the last reset
+				std::size_t lastFrameAllocationCount = 0; //< allocations between the two last resets
+				std::size_t blockCount = 0;
+			};
+
+		protected:
+			inline void RegisterAllocation(UInt64 size);
+			inline void RegisterBlock(UInt64 size);
+			inline void RegisterReset();
+			inline void UnregisterBlock(UInt64 size);
+
+			// Blocks which stayed unused for this many resets are released, which trims the pool back to its high-water mark after usage spikes
+			static constexpr std::size_t UnusedBlockReleaseDelay = 120;
+
+		private:
+			Stats m_stats;
 	};
 }
 
@@ -2,10 +2,48 @@
 // This file is part of the "Nazara Engine - Renderer module"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
+#include <algorithm>
+#include <cassert>
 #include <Nazara/Renderer/Debug.hpp>
 
 namespace Nz
 {
+	/*!
+	* \brief Returns allocation statistics of the pool
+	* \return Pool statistics
+	*/
+	inline auto UploadPool::GetStats() const -> const Stats&
+	{
+		return m_stats;
+	}
+
+	inline void UploadPool::RegisterAllocation(UInt64 size)
+	{
+		m_stats.allocatedBytes += size;
+		m_stats.allocationCount++;
+		m_stats.peakAllocatedBytes = std::max(m_stats.peakAllocatedBytes, m_stats.allocatedBytes);
+	}
+
+	inline void UploadPool::RegisterBlock(UInt64 size)
+	{
+		m_stats.reservedBytes += size;
+		m_stats.blockCount++;
+	}
+
+	inline void UploadPool::RegisterReset()
+	{
+		m_stats.lastFrameAllocatedBytes = m_stats.allocatedBytes;
+		m_stats.lastFrameAllocationCount = m_stats.allocationCount;
+		m_stats.allocatedBytes = 0;
+		m_stats.allocationCount = 0;
+	}
+
+	inline void UploadPool::UnregisterBlock(UInt64 size)
+	{
+		assert(m_stats.blockCount > 0 && m_stats.reservedBytes >= size);
+		m_stats.reservedBytes -= size;
+		m_stats.blockCount--;
+	}
 }
 
 #include <Nazara/Renderer/DebugOff.hpp>
@@ -42,6 +42,8 @@ namespace Nz
 
 			inline TransientResources& Transient();
 
+			inline void WaitForFrame();
+
 			WindowSwapchain& operator=(const WindowSwapchain&) = delete;
 			WindowSwapchain& operator=(WindowSwapchain&& windowSwapchain) = delete;
 
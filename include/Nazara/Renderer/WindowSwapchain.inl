@@ -45,6 +45,14 @@ namespace Nz
 		return m_swapchain->Transient();
 	}
 
+	inline void WindowSwapchain::WaitForFrame()
+	{
+		if (m_isMinimized || (!m_hasFocus && m_renderOnlyIfFocused))
+			return;
+
+		m_swapchain->WaitForFrame();
+	}
+
 	void WindowSwapchain::DisconnectSignals()
 	{
 		m_onGainedFocus.Disconnect();
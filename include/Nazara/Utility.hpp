@@ -34,6 +34,7 @@
 #include <Nazara/Utility/AbstractTextDrawer.hpp>
 #include <Nazara/Utility/Algorithm.hpp>
 #include <Nazara/Utility/Animation.hpp>
+#include <Nazara/Utility/AnimationBlendTree.hpp>
 #include <Nazara/Utility/Buffer.hpp>
 #include <Nazara/Utility/BufferMapper.hpp>
 #include <Nazara/Utility/Config.hpp>
@@ -59,10 +60,12 @@
 #include <Nazara/Utility/Sequence.hpp>
 #include <Nazara/Utility/SimpleTextDrawer.hpp>
 #include <Nazara/Utility/SkeletalMesh.hpp>
+#include <Nazara/Utility/SkeletalPose.hpp>
 #include <Nazara/Utility/Skeleton.hpp>
 #include <Nazara/Utility/SoftwareBuffer.hpp>
 #include <Nazara/Utility/StaticMesh.hpp>
 #include <Nazara/Utility/SubMesh.hpp>
+#include <Nazara/Utility/TransformHierarchy.hpp>
 #include <Nazara/Utility/TriangleIterator.hpp>
 #include <Nazara/Utility/UniformBuffer.hpp>
 #include <Nazara/Utility/Utility.hpp>
@@ -21,6 +21,8 @@ namespace Nz
 	class NAZARA_UTILITY_API AbstractImage
 	{
 		public:
+			struct UpdateRegion;
+
 			AbstractImage() = default;
 			AbstractImage(const AbstractImage&) = default;
 			AbstractImage(AbstractImage&&) noexcept = default;
@@ -38,9 +40,17 @@ namespace Nz
 			inline bool Update(const void* pixels, unsigned int srcWidth = 0, unsigned int srcHeight = 0, UInt8 level = 0);
 			virtual bool Update(const void* pixels, const Boxui& box, unsigned int srcWidth = 0, unsigned int srcHeight = 0, UInt8 level = 0) = 0;
 			inline bool Update(const void* pixels, const Rectui& rect, unsigned int z = 0, unsigned int srcWidth = 0, unsigned int srcHeight = 0, UInt8 level = 0);
+			virtual bool UpdateRegions(const void* pixels, const UpdateRegion* regions, std::size_t regionCount);
 
 			AbstractImage& operator=(const AbstractImage&) = default;
 			AbstractImage& operator=(AbstractImage&&) noexcept = default;
+
+			struct UpdateRegion
+			{
+				Boxui box;
+				std::size_t offset; //< offset of the region pixels (tightly packed) in the source buffer
+				UInt8 level = 0;
+			};
 	};
 }
 
@@ -15,18 +15,24 @@
 #include <Nazara/Math/Vector2.hpp>
 #include <Nazara/Math/Vector3.hpp>
 #include <Nazara/Math/Vector4.hpp>
+#include <Nazara/Utility/Enums.hpp>
 #include <Nazara/Utility/IndexIterator.hpp>
 #include <NazaraUtils/SparsePtr.hpp>
+#include <limits>
 
 namespace Nz
 {
 	class Joint;
+	class TaskScheduler;
+	class VertexDeclaration;
 	struct VertexStruct_XYZ_Normal_UV_Tangent;
 	struct VertexStruct_XYZ_Normal_UV_Tangent_Skinning;
 
 	using MeshVertex = VertexStruct_XYZ_Normal_UV_Tangent;
 	using SkeletalMeshVertex = VertexStruct_XYZ_Normal_UV_Tangent_Skinning;
 
+	constexpr UInt32 InvalidVertexIndex = std::numeric_limits<UInt32>::max();
+
 	struct SkinningData
 	{
 		const Joint* joints;
@@ -59,6 +65,15 @@ namespace Nz
 	NAZARA_UTILITY_API void ComputePlaneIndexVertexCount(const Vector2ui& subdivision, UInt32* indexCount, UInt32* vertexCount);
 	NAZARA_UTILITY_API void ComputeUvSphereIndexVertexCount(unsigned int sliceCount, unsigned int stackCount, UInt32* indexCount, UInt32* vertexCount);
 
+	NAZARA_UTILITY_API void ConvertVertices(const void* vertices, const VertexDeclaration& declaration, void* outputVertices, const VertexDeclaration& outputDeclaration, UInt32 vertexCount);
+
+	inline Vector3f DecodeOctahedral(const Vector2f& encoded);
+	NAZARA_UTILITY_API Vector4f DecodeVertexComponent(const void* data, ComponentType type, VertexComponent component);
+	inline Vector2f EncodeOctahedral(const Vector3f& direction);
+	NAZARA_UTILITY_API void EncodeVertexComponent(const Vector4f& value, ComponentType type, VertexComponent component, void* data);
+
+	NAZARA_UTILITY_API UInt16 FloatToHalf(float value);
+
 	NAZARA_UTILITY_API void GenerateBox(const Vector3f& lengths, const Vector3ui& subdivision, const Matrix4f& matrix, const Rectf& textureCoords, VertexPointers vertexPointers, IndexIterator indices, Boxf* aabb = nullptr, UInt32 indexOffset = 0);
 	NAZARA_UTILITY_API void GenerateCone(float length, float radius, unsigned int subdivision, const Matrix4f& matrix, const Rectf& textureCoords, VertexPointers vertexPointers, IndexIterator indices, Boxf* aabb = nullptr, UInt32 indexOffset = 0);
 	NAZARA_UTILITY_API void GenerateCubicSphere(float size, unsigned int subdivision, const Matrix4f& matrix, const Rectf& textureCoords, VertexPointers vertexPointers, IndexIterator indices, Boxf* aabb = nullptr, UInt32 indexOffset = 0);
@@ -66,9 +81,18 @@ namespace Nz
 	NAZARA_UTILITY_API void GeneratePlane(const Vector2ui& subdivision, const Vector2f& size, const Matrix4f& matrix, const Rectf& textureCoords, VertexPointers vertexPointers, IndexIterator indices, Boxf* aabb = nullptr, UInt32 indexOffset = 0);
 	NAZARA_UTILITY_API void GenerateUvSphere(float size, unsigned int sliceCount, unsigned int stackCount, const Matrix4f& matrix, const Rectf& textureCoords, VertexPointers vertexPointers, IndexIterator indices, Boxf* aabb = nullptr, UInt32 indexOffset = 0);
 
+	NAZARA_UTILITY_API float HalfToFloat(UInt16 value);
+
 	NAZARA_UTILITY_API void OptimizeIndices(IndexIterator indices, UInt32 indexCount);
+	NAZARA_UTILITY_API void OptimizeOverdraw(IndexIterator indices, UInt32 indexCount, SparsePtr<const Vector3f> positions);
+	NAZARA_UTILITY_API UInt32 OptimizeVertexFetch(IndexIterator indices, UInt32 indexCount, UInt32 vertexCount, UInt32* vertexRemap);
+
+	NAZARA_UTILITY_API UInt32 SimplifyMesh(IndexIterator indices, UInt32 indexCount, SparsePtr<const Vector3f> positions, UInt32 vertexCount, UInt32 targetIndexCount, float maxError, UInt32* outputIndices, float* resultError = nullptr);
 
 	NAZARA_UTILITY_API void SkinLinearBlend(const SkinningData& data, UInt32 startVertex, UInt32 vertexCount);
+	NAZARA_UTILITY_API void SkinLinearBlend(const SkinningData& data, UInt32 startVertex, UInt32 vertexCount, TaskScheduler& taskScheduler, UInt32 chunkSize = 1024);
+
+	NAZARA_UTILITY_API UInt32 WeldVertices(const void* vertices, UInt32 vertexCount, std::size_t stride, UInt32* vertexRemap);
 
 	inline Vector3f TransformPositionTRS(const Vector3f& transformTranslation, const Quaternionf& transformRotation, const Vector3f& transformScale, const Vector3f& position);
 	inline Vector3f TransformNormalTRS(const Quaternionf& transformRotation, const Vector3f& transformScale, const Vector3f& normal);
@@ -3,10 +3,55 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Core/Algorithm.hpp>
+#include <algorithm>
+#include <cmath>
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
 {
+	/*!
+	* \brief Decodes a direction encoded with EncodeOctahedral
+	* \return Normalized direction
+	*
+	* \param encoded Octahedral coordinates in [-1, 1]
+	*/
+	inline Vector3f DecodeOctahedral(const Vector2f& encoded)
+	{
+		Vector3f direction(encoded.x, encoded.y, 1.f - std::abs(encoded.x) - std::abs(encoded.y));
+
+		// Unfold the lower hemisphere
+		float t = std::max(-direction.z, 0.f);
+		direction.x += (direction.x >= 0.f) ? -t : t;
+		direction.y += (direction.y >= 0.f) ? -t : t;
+
+		return direction.GetNormal();
+	}
+
+	/*!
+	* \brief Encodes a direction as two coordinates using an octahedral mapping
+	* \return Octahedral coordinates in [-1, 1], suitable for snorm components
+	*
+	* The unit sphere is projected on an octahedron which is unfolded on a square, giving a nearly uniform precision over all directions.
+	*
+	* \param direction Direction to encode (doesn't need to be normalized)
+	*/
+	inline Vector2f EncodeOctahedral(const Vector3f& direction)
+	{
+		float length = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+		if (length <= 0.f)
+			return Vector2f(0.f, 0.f);
+
+		Vector2f encoded(direction.x / length, direction.y / length);
+		if (direction.z < 0.f)
+		{
+			// Fold the lower hemisphere on the square corners
+			encoded = Vector2f((1.f - std::abs(encoded.y)) * ((encoded.x >= 0.f) ? 1.f : -1.f),
+			                   (1.f - std::abs(encoded.x)) * ((encoded.y >= 0.f) ? 1.f : -1.f));
+		}
+
+		return encoded;
+	}
+
 	inline Vector3f TransformPositionTRS(const Vector3f& transformTranslation, const Quaternionf& transformRotation, const Vector3f& transformScale, const Vector3f& position)
 	{
 		return transformRotation * (transformScale * position) + transformTranslation;
@@ -15,6 +15,8 @@
 #include <Nazara/Core/ResourceParameters.hpp>
 #include <Nazara/Math/Quaternion.hpp>
 #include <Nazara/Math/Vector3.hpp>
+#include <Nazara/Core/ResourceSaver.hpp>
+#include <Nazara/Utility/CompressedAnimationTracks.hpp>
 #include <Nazara/Utility/Config.hpp>
 #include <Nazara/Utility/Enums.hpp>
 #include <NazaraUtils/MovablePtr.hpp>
@@ -23,6 +25,7 @@
 
 namespace Nz
 {
+	class SkeletalPose;
 	class Skeleton;
 
 	struct NAZARA_UTILITY_API AnimationParams : ResourceParameters
@@ -41,6 +44,10 @@ namespace Nz
 
 		Vector3f jointScale = Vector3f::Unit();
 
+		// Compress the animation once loaded (see Animation::Compress), compression tolerances are also used when saving uncompressed animations
+		bool compress = false;
+		AnimationCompressionParams compression;
+
 		bool IsValid() const;
 	};
 
@@ -51,6 +58,7 @@ namespace Nz
 	using AnimationLibrary = ObjectLibrary<Animation>;
 	using AnimationLoader = ResourceLoader<Animation, AnimationParams>;
 	using AnimationManager = ResourceManager<Animation, AnimationParams>;
+	using AnimationSaver = ResourceSaver<Animation, AnimationParams>;
 
 	struct AnimationImpl;
 
@@ -67,11 +75,15 @@ namespace Nz
 			bool AddSequence(const Sequence& sequence);
 			void AnimateSkeleton(Skeleton* targetSkeleton, std::size_t frameA, std::size_t frameB, float interpolation) const;
 
+			bool Compress(const AnimationCompressionParams& params = AnimationCompressionParams());
+
 			bool CreateSkeletal(std::size_t frameCount, std::size_t jointCount);
+			bool CreateSkeletal(CompressedAnimationTracks compressedTracks);
 			void Destroy();
 
 			void EnableLoopPointInterpolation(bool loopPointInterpolation);
 
+			const CompressedAnimationTracks* GetCompressedTracks() const;
 			std::size_t GetFrameCount() const;
 			std::size_t GetJointCount() const;
 			Sequence* GetSequence(const std::string& sequenceName);
@@ -87,12 +99,18 @@ namespace Nz
 			bool HasSequence(const std::string& sequenceName) const;
 			bool HasSequence(std::size_t index = 0) const;
 
+			bool IsCompressed() const;
 			bool IsLoopPointInterpolationEnabled() const;
 			bool IsValid() const;
 
 			void RemoveSequence(const std::string& sequenceName);
 			void RemoveSequence(std::size_t index);
 
+			void SamplePose(SkeletalPose& pose, std::size_t frameA, std::size_t frameB, float interpolation) const;
+
+			bool SaveToFile(const std::filesystem::path& filePath, const AnimationParams& params = AnimationParams()) const;
+			bool SaveToStream(Stream& stream, const std::string& format, const AnimationParams& params = AnimationParams()) const;
+
 			Animation& operator=(const Animation&) = delete;
 			Animation& operator=(Animation&&) noexcept;
 
@@ -0,0 +1,96 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_UTILITY_ANIMATIONBLENDTREE_HPP
+#define NAZARA_UTILITY_ANIMATIONBLENDTREE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/Time.hpp>
+#include <Nazara/Math/Matrix4.hpp>
+#include <Nazara/Utility/Config.hpp>
+#include <Nazara/Utility/SkeletalPose.hpp>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace Nz
+{
+	class Animation;
+	class Skeleton;
+
+	class NAZARA_UTILITY_API AnimationBlendTree
+	{
+		public:
+			using NodeIndex = std::size_t;
+
+			AnimationBlendTree(const Skeleton& skeleton);
+			AnimationBlendTree(const AnimationBlendTree&) = default;
+			AnimationBlendTree(AnimationBlendTree&&) noexcept = default;
+			~AnimationBlendTree() = default;
+
+			NodeIndex AddBlend(NodeIndex first, NodeIndex second, float weight = 0.5f);
+			NodeIndex AddClip(std::shared_ptr<const Animation> animation, std::size_t sequenceIndex = 0, bool loop = true);
+			NodeIndex AddLayer(NodeIndex base, NodeIndex layer, std::vector<float> jointWeights, float weight = 1.f);
+
+			inline std::size_t GetJointCount() const;
+			inline const SkeletalPose& GetModelPose() const;
+			inline const SkeletalPose& GetPose() const;
+			inline NodeIndex GetRootNode() const;
+			inline const Matrix4f* GetSkinningMatrices() const;
+
+			void SetClipTime(NodeIndex clipIndex, Time time);
+			void SetRootNode(NodeIndex nodeIndex);
+			void SetWeight(NodeIndex nodeIndex, float weight);
+
+			void Update(Time elapsedTime);
+
+			AnimationBlendTree& operator=(const AnimationBlendTree&) = default;
+			AnimationBlendTree& operator=(AnimationBlendTree&&) noexcept = default;
+
+			static void Update(AnimationBlendTree* const* blendTrees, std::size_t blendTreeCount, Time elapsedTime);
+
+			static constexpr NodeIndex InvalidNodeIndex = std::numeric_limits<NodeIndex>::max();
+
+		private:
+			enum class TreeNodeType
+			{
+				Blend,
+				Clip,
+				Layer
+			};
+
+			struct TreeNode
+			{
+				TreeNodeType type;
+				std::shared_ptr<const Animation> animation;
+				std::vector<float> jointWeights;
+				std::size_t sequenceIndex = 0;
+				NodeIndex first = InvalidNodeIndex;
+				NodeIndex second = InvalidNodeIndex;
+				float time = 0.f;
+				float weight = 1.f;
+				bool loop = true;
+			};
+
+			std::size_t ComputeDepth(NodeIndex nodeIndex) const;
+			void Evaluate(NodeIndex nodeIndex, SkeletalPose& pose, std::size_t depth);
+			void SampleClip(const TreeNode& clipNode, SkeletalPose& pose) const;
+
+			std::vector<Matrix4f> m_inverseBindMatrices;
+			std::vector<Matrix4f> m_skinningMatrices;
+			std::vector<SkeletalPose> m_scratchPoses;
+			std::vector<TreeNode> m_nodes;
+			std::vector<std::size_t> m_parentIndices;
+			NodeIndex m_rootNode;
+			SkeletalPose m_bindPose;
+			SkeletalPose m_modelPose;
+			SkeletalPose m_pose;
+	};
+}
+
+#include <Nazara/Utility/AnimationBlendTree.inl>
+
+#endif // NAZARA_UTILITY_ANIMATIONBLENDTREE_HPP
@@ -0,0 +1,35 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	inline std::size_t AnimationBlendTree::GetJointCount() const
+	{
+		return m_parentIndices.size();
+	}
+
+	inline const SkeletalPose& AnimationBlendTree::GetModelPose() const
+	{
+		return m_modelPose;
+	}
+
+	inline const SkeletalPose& AnimationBlendTree::GetPose() const
+	{
+		return m_pose;
+	}
+
+	inline auto AnimationBlendTree::GetRootNode() const -> NodeIndex
+	{
+		return m_rootNode;
+	}
+
+	inline const Matrix4f* AnimationBlendTree::GetSkinningMatrices() const
+	{
+		return m_skinningMatrices.data();
+	}
+}
+
+#include <Nazara/Utility/DebugOff.hpp>
@@ -29,7 +29,7 @@ namespace Nz
 		private:
 			const Skeleton& GetAttachedSkeleton() const override;
 			inline bool IsAttachedSkeletonOutdated() const;
-			void OnReferenceJointsInvalidated(const Skeleton* skeleton);
+			void OnReferenceJointsInvalidated(const Skeleton* skeleton, std::size_t firstJoint, std::size_t jointCount);
 			void SetSkeletonParent(Node* parent);
 			void SetupSkeleton();
 			void UpdateAttachedSkeletonJoints();
@@ -37,7 +37,8 @@ namespace Nz
 			NazaraSlot(Skeleton, OnSkeletonJointsInvalidated, m_onSkeletonJointsInvalidated);
 
 			Skeleton m_attachedSkeleton;
-			bool m_skeletonJointInvalidated;
+			std::size_t m_invalidatedJointBegin;
+			std::size_t m_invalidatedJointEnd;
 	};
 }
 
@@ -8,7 +8,7 @@ namespace Nz
 {
 	inline bool SharedSkeletonComponent::IsAttachedSkeletonOutdated() const
 	{
-		return m_skeletonJointInvalidated;
+		return m_invalidatedJointBegin < m_invalidatedJointEnd;
 	}
 }
 
@@ -0,0 +1,92 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_UTILITY_COMPRESSEDANIMATIONTRACKS_HPP
+#define NAZARA_UTILITY_COMPRESSEDANIMATIONTRACKS_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Math/Quaternion.hpp>
+#include <Nazara/Math/Vector3.hpp>
+#include <Nazara/Utility/Config.hpp>
+#include <array>
+#include <vector>
+
+namespace Nz
+{
+	struct SequenceJoint;
+
+	struct AnimationCompressionParams
+	{
+		float positionTolerance = 0.001f; //< maximum distance between sampled and original joint positions
+		float rotationTolerance = 0.001f; //< maximum angle (in radians) between sampled and original joint rotations
+		float scaleTolerance = 0.001f;    //< maximum difference between sampled and original joint scales (per axis)
+	};
+
+	class NAZARA_UTILITY_API CompressedAnimationTracks
+	{
+		public:
+			enum class Channel
+			{
+				Position,
+				Rotation,
+				Scale,
+
+				Max = Scale
+			};
+
+			struct Track;
+
+			CompressedAnimationTracks() = default;
+			CompressedAnimationTracks(UInt32 frameCount, UInt32 jointCount, std::vector<Track> tracks, std::vector<UInt16> keyFrames, std::vector<UInt16> keyValues);
+			CompressedAnimationTracks(const CompressedAnimationTracks&) = default;
+			CompressedAnimationTracks(CompressedAnimationTracks&&) noexcept = default;
+			~CompressedAnimationTracks() = default;
+
+			inline UInt32 GetFrameCount() const;
+			inline UInt32 GetJointCount() const;
+			inline const std::vector<UInt16>& GetKeyFrames() const;
+			inline const std::vector<UInt16>& GetKeyValues() const;
+			std::size_t GetMemoryUsage() const;
+			inline const Track& GetTrack(std::size_t jointIndex, Channel channel) const;
+			inline const std::vector<Track>& GetTracks() const;
+
+			void Sample(std::size_t frameA, std::size_t frameB, float interpolation, Vector3f* positions, Quaternionf* rotations, Vector3f* scales) const;
+			void SampleJoint(std::size_t jointIndex, std::size_t frameA, std::size_t frameB, float interpolation, Vector3f* position, Quaternionf* rotation, Vector3f* scale) const;
+
+			bool Validate() const;
+
+			CompressedAnimationTracks& operator=(const CompressedAnimationTracks&) = default;
+			CompressedAnimationTracks& operator=(CompressedAnimationTracks&&) noexcept = default;
+
+			static CompressedAnimationTracks Compress(const SequenceJoint* sequenceJoints, UInt32 frameCount, UInt32 jointCount, const AnimationCompressionParams& params = AnimationCompressionParams());
+			static constexpr std::size_t GetComponentCount(Channel channel);
+
+			static constexpr std::size_t ChannelCount = static_cast<std::size_t>(Channel::Max) + 1;
+			static constexpr UInt32 MaxFrameCount = 0x10000;
+
+			struct Track
+			{
+				std::array<float, 4> rangeMin;    //< dequantized value of a zero component
+				std::array<float, 4> rangeExtent; //< dequantized value of a 0xFFFF component minus rangeMin
+				UInt32 firstKey;                  //< index of the first key in key frames
+				UInt32 keyCount;
+				UInt32 firstValue;                //< index of the first key components in key values
+			};
+
+		private:
+			template<std::size_t N> void Evaluate(const Track& track, float frame, float* values) const;
+
+			std::vector<Track> m_tracks; //< ChannelCount tracks per joint
+			std::vector<UInt16> m_keyFrames;
+			std::vector<UInt16> m_keyValues; //< 16 bits quantized key components
+			UInt32 m_frameCount = 0;
+			UInt32 m_jointCount = 0;
+	};
+}
+
+#include <Nazara/Utility/CompressedAnimationTracks.inl>
+
+#endif // NAZARA_UTILITY_COMPRESSEDANIMATIONTRACKS_HPP
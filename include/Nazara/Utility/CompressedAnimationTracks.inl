@@ -0,0 +1,47 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <cassert>
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	inline UInt32 CompressedAnimationTracks::GetFrameCount() const
+	{
+		return m_frameCount;
+	}
+
+	inline UInt32 CompressedAnimationTracks::GetJointCount() const
+	{
+		return m_jointCount;
+	}
+
+	inline const std::vector<UInt16>& CompressedAnimationTracks::GetKeyFrames() const
+	{
+		return m_keyFrames;
+	}
+
+	inline const std::vector<UInt16>& CompressedAnimationTracks::GetKeyValues() const
+	{
+		return m_keyValues;
+	}
+
+	inline auto CompressedAnimationTracks::GetTrack(std::size_t jointIndex, Channel channel) const -> const Track&
+	{
+		assert(jointIndex < m_jointCount);
+		return m_tracks[jointIndex * ChannelCount + static_cast<std::size_t>(channel)];
+	}
+
+	inline auto CompressedAnimationTracks::GetTracks() const -> const std::vector<Track>&
+	{
+		return m_tracks;
+	}
+
+	constexpr std::size_t CompressedAnimationTracks::GetComponentCount(Channel channel)
+	{
+		return (channel == Channel::Rotation) ? 4 : 3;
+	}
+}
+
+#include <Nazara/Utility/DebugOff.hpp>
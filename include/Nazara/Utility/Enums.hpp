@@ -103,7 +103,17 @@ namespace Nz
 		Int3,
 		Int4,
 
-		Max = Int4
+		// Compressed types (appended to keep the values of the types above stable), normalized types are read as floats by shaders
+		Half2,
+		Half4,
+		SNorm8x4,
+		SNorm16x2,
+		SNorm16x4,
+		UNorm8x4,
+		UNorm16x2,
+		UNorm16x4,
+
+		Max = UNorm16x4
 	};
 
 	constexpr std::size_t ComponentTypeCount = static_cast<std::size_t>(ComponentType::Max) + 1;
@@ -167,6 +177,24 @@ namespace Nz
 		Max = CounterClockwise
 	};
 
+	enum class ImageMipmapFilter
+	{
+		Box,    // Averages every texel covered by the destination texel, fast and blur-free for power-of-two sizes
+		Kaiser, // Kaiser-windowed sinc, sharper result at the cost of a wider footprint
+
+		Max = Kaiser
+	};
+
+	enum class ImageResizeFilter
+	{
+		Bilinear, // Tent filter, cheap and smooth
+		Box,      // Averages every texel covered by the destination texel, best suited to integer downscaling ratios
+		Lanczos,  // Lanczos-windowed sinc (3 lobes), sharpest result but may ring around hard edges
+		Mitchell, // Mitchell-Netravali cubic, good compromise between sharpness and ringing
+
+		Max = Mitchell
+	};
+
 	enum class IndexType
 	{
 		U8,
@@ -202,13 +230,26 @@ namespace Nz
 		Undefined = -1,
 
 		A8,              // 1*uint8
+		ASTC4x4,         // 16 bytes per 4x4 block
+		ASTC4x4_SRGB,    // 16 bytes per 4x4 block
+		ASTC8x8,         // 16 bytes per 8x8 block
+		ASTC8x8_SRGB,    // 16 bytes per 8x8 block
+		BC4,             // 8 bytes per 4x4 block (R)
+		BC5,             // 16 bytes per 4x4 block (RG)
+		BC6H,            // 16 bytes per 4x4 block (unsigned half RGB)
+		BC7,             // 16 bytes per 4x4 block
+		BC7_SRGB,        // 16 bytes per 4x4 block
 		BGR8,            // 3*uint8
 		BGR8_SRGB,       // 3*uint8
 		BGRA8,           // 4*uint8
 		BGRA8_SRGB,      // 4*uint8
-		DXT1,
-		DXT3,
-		DXT5,
+		DXT1,            // 8 bytes per 4x4 block (BC1)
+		DXT3,            // 16 bytes per 4x4 block (BC2)
+		DXT5,            // 16 bytes per 4x4 block (BC3)
+		ETC2_RGB8,       // 8 bytes per 4x4 block
+		ETC2_RGB8_SRGB,  // 8 bytes per 4x4 block
+		ETC2_RGBA8,      // 16 bytes per 4x4 block
+		ETC2_RGBA8_SRGB, // 16 bytes per 4x4 block
 		L8,              // 1*uint8
 		LA8,             // 2*uint8
 		R8,              // 1*uint8
@@ -418,6 +459,10 @@ namespace Nz
 		XYZ_Normal_UV_Tangent_Skinning,
 		XYZ_UV,
 
+		// Predefined compressed declarations for rendering (half-float positions and UV, octahedral normals and tangents)
+		XYZ_Normal_UV_Tangent_Packed,
+		XYZ_Normal_UV_Tangent_Skinning_Packed,
+
 		// Predefined declarations for instancing
 		Matrix4,
 
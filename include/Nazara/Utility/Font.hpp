@@ -16,6 +16,7 @@
 #include <Nazara/Core/ResourceParameters.hpp>
 #include <Nazara/Utility/AbstractAtlas.hpp>
 #include <Nazara/Utility/Enums.hpp>
+#include <array>
 #include <memory>
 #include <unordered_map>
 
@@ -57,6 +58,8 @@ namespace Nz
 			bool Create(std::unique_ptr<FontData> data);
 			void Destroy();
 
+			void EnableSignedDistanceField(bool enable);
+
 			bool ExtractGlyph(unsigned int characterSize, char32_t character, TextStyleFlags style, float outlineThickness, FontGlyph* glyph) const;
 
 			const std::shared_ptr<AbstractAtlas>& GetAtlas() const;
@@ -67,9 +70,12 @@ namespace Nz
 			const Glyph& GetGlyph(unsigned int characterSize, TextStyleFlags style, float outlineThickness, char32_t character) const;
 			unsigned int GetGlyphBorder() const;
 			unsigned int GetMinimumStepSize() const;
+			unsigned int GetSignedDistanceFieldReferenceSize() const;
+			unsigned int GetSignedDistanceFieldSpread() const;
 			const SizeInfo& GetSizeInfo(unsigned int characterSize) const;
 			std::string GetStyleName() const;
 
+			bool IsSignedDistanceFieldEnabled() const;
 			bool IsValid() const;
 
 			bool Precache(unsigned int characterSize, TextStyleFlags style, float outlineThickness, char32_t character) const;
@@ -78,6 +84,8 @@ namespace Nz
 			void SetAtlas(std::shared_ptr<AbstractAtlas> atlas);
 			void SetGlyphBorder(unsigned int borderSize);
 			void SetMinimumStepSize(unsigned int minimumStepSize);
+			void SetSignedDistanceFieldReferenceSize(unsigned int referenceSize);
+			void SetSignedDistanceFieldSpread(unsigned int spread);
 
 			Font& operator=(const Font&) = delete;
 			Font& operator=(Font&&) = delete;
@@ -95,6 +103,9 @@ namespace Nz
 			static void SetDefaultGlyphBorder(unsigned int borderSize);
 			static void SetDefaultMinimumStepSize(unsigned int minimumStepSize);
 
+			static constexpr unsigned int DefaultSignedDistanceFieldReferenceSize = 64;
+			static constexpr unsigned int DefaultSignedDistanceFieldSpread = 8;
+
 			struct Glyph
 			{
 				Recti aabb;
@@ -102,6 +113,7 @@ namespace Nz
 				bool requireFauxBold;
 				bool requireFauxItalic;
 				bool flipped;
+				bool sharesAtlasRect; //< atlas rect belongs to another glyph (simulated style or scaled distance field)
 				bool valid;
 				float fauxOutlineThickness;
 				int advance;
@@ -128,10 +140,20 @@ namespace Nz
 		private:
 			using GlyphMap = std::unordered_map<char32_t, Glyph>;
 
+			struct RecentGlyphMap
+			{
+				UInt64 key;
+				GlyphMap* glyphMap = nullptr;
+			};
+
 			UInt64 ComputeKey(unsigned int characterSize, TextStyleFlags style, float outlineThickness) const;
+			GlyphMap& GetGlyphMap(UInt64 key) const;
 			void OnAtlasCleared(const AbstractAtlas* atlas);
 			void OnAtlasLayerChange(const AbstractAtlas* atlas, AbstractImage* oldLayer, AbstractImage* newLayer);
+			TextStyleFlags GetSupportedStyle(TextStyleFlags style) const;
 			const Glyph& PrecacheGlyph(GlyphMap& glyphMap, unsigned int characterSize, TextStyleFlags style, float outlineThickness, char32_t character) const;
+			void PrecacheSignedDistanceFields(TextStyleFlags style, std::string_view characterSet) const;
+			void StoreGlyph(Glyph& glyph, const FontGlyph& fontGlyph) const;
 
 			static bool Initialize();
 			static void Uninitialize();
@@ -143,9 +165,13 @@ namespace Nz
 			std::unique_ptr<FontData> m_data;
 			mutable std::unordered_map<UInt64, std::unordered_map<UInt64, int>> m_kerningCache;
 			mutable std::unordered_map<UInt64, GlyphMap> m_glyphes;
+			mutable std::array<RecentGlyphMap, 2> m_recentGlyphMaps; //< text drawers alternate between regular and outline glyphs
 			mutable std::unordered_map<UInt64, SizeInfo> m_sizeInfoCache;
 			unsigned int m_glyphBorder;
 			unsigned int m_minimumStepSize;
+			unsigned int m_sdfReferenceSize;
+			unsigned int m_sdfSpread;
+			bool m_sdfEnabled;
 
 			static std::shared_ptr<AbstractAtlas> s_defaultAtlas;
 			static std::shared_ptr<Font> s_defaultFont;
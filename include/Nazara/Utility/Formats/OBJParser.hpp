@@ -11,6 +11,8 @@
 #include <Nazara/Math/Vector3.hpp>
 #include <Nazara/Math/Vector4.hpp>
 #include <Nazara/Utility/Config.hpp>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace Nz
@@ -92,7 +94,8 @@ namespace Nz
 			std::vector<Vector4f> m_positions;
 			std::vector<Vector3f> m_texCoords;
 			mutable Stream* m_currentStream;
-			std::string m_currentLine;
+			std::string m_lineBuffer;
+			std::string_view m_currentLine; //< points either to m_lineBuffer or to the parsed content
 			std::filesystem::path m_mtlLib;
 			mutable std::ostringstream m_outputStream;
 			bool m_keepLastLine;
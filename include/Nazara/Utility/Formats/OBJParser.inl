@@ -169,7 +169,7 @@ namespace Nz
 
 	inline bool OBJParser::UnrecognizedLine(bool error)
 	{
-		std::string message = "Unrecognized \"" + m_currentLine + '"';
+		std::string message = "Unrecognized \"" + std::string(m_currentLine) + '"';
 
 		if (error)
 			Error(message);
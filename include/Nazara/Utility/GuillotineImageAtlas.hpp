@@ -8,11 +8,15 @@
 #define NAZARA_UTILITY_GUILLOTINEIMAGEATLAS_HPP
 
 #include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/Enums.hpp>
 #include <Nazara/Core/GuillotineBinPack.hpp>
+#include <Nazara/Core/MaxRectsBinPack.hpp>
+#include <Nazara/Core/SkylineBinPack.hpp>
 #include <Nazara/Utility/AbstractAtlas.hpp>
 #include <Nazara/Utility/AbstractImage.hpp>
 #include <Nazara/Utility/Image.hpp>
 #include <memory>
+#include <variant>
 #include <vector>
 
 namespace Nz
@@ -20,7 +24,7 @@ namespace Nz
 	class NAZARA_UTILITY_API GuillotineImageAtlas : public AbstractAtlas
 	{
 		public:
-			GuillotineImageAtlas();
+			GuillotineImageAtlas(BinPackAlgorithm packingAlgorithm = BinPackAlgorithm::Guillotine);
 			GuillotineImageAtlas(const GuillotineImageAtlas&) = delete;
 			GuillotineImageAtlas(GuillotineImageAtlas&&) noexcept = default;
 			~GuillotineImageAtlas() = default;
@@ -30,6 +34,7 @@ namespace Nz
 			void Free(SparsePtr<const Rectui> rects, SparsePtr<unsigned int> layers, unsigned int count) override;
 
 			unsigned int GetMaxLayerSize() const;
+			BinPackAlgorithm GetPackingAlgorithm() const;
 			GuillotineBinPack::FreeRectChoiceHeuristic GetRectChoiceHeuristic() const;
 			GuillotineBinPack::GuillotineSplitHeuristic GetRectSplitHeuristic() const;
 			AbstractImage* GetLayer(unsigned int layerIndex) const override;
@@ -39,6 +44,7 @@ namespace Nz
 			bool Insert(const Image& image, Rectui* rect, bool* flipped, unsigned int* layerIndex) override;
 
 			void SetMaxLayerSize(unsigned int maxLayerSize);
+			void SetPackingAlgorithm(BinPackAlgorithm packingAlgorithm);
 			void SetRectChoiceHeuristic(GuillotineBinPack::FreeRectChoiceHeuristic heuristic);
 			void SetRectSplitHeuristic(GuillotineBinPack::GuillotineSplitHeuristic heuristic);
 
@@ -62,17 +68,20 @@ namespace Nz
 			{
 				std::vector<QueuedGlyph> queuedGlyphs;
 				std::shared_ptr<AbstractImage> image;
-				GuillotineBinPack binPack;
+				std::variant<GuillotineBinPack, MaxRectsBinPack, SkylineBinPack> binPack;
 				unsigned int freedRectangles = 0;
 			};
 
 		private:
+			Layer CreateLayer() const;
+			bool InsertIntoLayer(Layer& layer, Rectui* rect, bool* flipped) const;
 			void ProcessGlyphQueue(Layer& layer) const;
 
 			mutable std::vector<Layer> m_layers;
 			GuillotineBinPack::FreeRectChoiceHeuristic m_rectChoiceHeuristic;
 			GuillotineBinPack::GuillotineSplitHeuristic m_rectSplitHeuristic;
 			unsigned int m_maxLayerSize;
+			BinPackAlgorithm m_packingAlgorithm;
 	};
 }
 
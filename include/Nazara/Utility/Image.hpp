@@ -71,13 +71,15 @@ namespace Nz
 			bool FlipHorizontally();
 			bool FlipVertically();
 
+			bool GenerateMipmaps(ImageMipmapFilter filter = ImageMipmapFilter::Box);
+
 			const UInt8* GetConstPixels(unsigned int x = 0, unsigned int y = 0, unsigned int z = 0, UInt8 level = 0) const;
 			unsigned int GetDepth(UInt8 level = 0) const;
 			PixelFormat GetFormat() const override;
 			unsigned int GetHeight(UInt8 level = 0) const;
 			UInt8 GetLevelCount() const override;
 			UInt8 GetMaxLevel() const;
-			std::size_t GetMemoryUsage() const;
+			std::size_t GetMemoryUsage() const override;
 			std::size_t GetMemoryUsage(UInt8 level) const;
 			Color GetPixelColor(unsigned int x, unsigned int y = 0, unsigned int z = 0) const;
 			UInt8* GetPixels(unsigned int x = 0, unsigned int y = 0, unsigned int z = 0, UInt8 level = 0);
@@ -95,6 +97,8 @@ namespace Nz
 			bool LoadFaceFromMemory(CubemapFace face, const void* data, std::size_t size, const ImageParams& params = ImageParams());
 			bool LoadFaceFromStream(CubemapFace face, Stream& stream, const ImageParams& params = ImageParams());
 
+			bool Resize(const Vector3ui& newSize, ImageResizeFilter filter = ImageResizeFilter::Bilinear);
+
 			// Save
 			bool SaveToFile(const std::filesystem::path& filePath, const ImageParams& params = ImageParams());
 			bool SaveToStream(Stream& stream, const std::string& format, const ImageParams& params = ImageParams());
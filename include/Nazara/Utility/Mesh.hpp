@@ -64,6 +64,26 @@ namespace Nz
 		bool optimizeIndexBuffers = false;
 		#endif
 
+		// Run the full mesh optimization after loading (see Mesh::Optimize): welds duplicate vertices and reorders triangles and vertices for the vertex cache, overdraw and vertex fetch.
+		// Improves rendering speed on all backends but noticeably increases loading time, mostly useful when producing cached meshes.
+		bool optimizeMesh = false;
+
+		// When optimizing meshes, use 16-bit indices for submeshes which have less than 65536 vertices left
+		bool narrowIndices = true;
+
+		// Number of simplified levels of detail to generate after loading (see Mesh::GenerateLODs)
+		UInt32 lodCount = 0;
+
+		// Maximum simplification error of generated levels of detail, relative to the mesh size (length of its AABB diagonal)
+		float lodMaxError = 0.05f;
+
+		// Triangle count ratio between two successive levels of detail
+		float lodReduction = 0.5f;
+
+		// Compress vertices after loading (see Mesh::CompressVertices): half-float positions and texture coordinates, octahedral normals and tangents, normalized colors and weights.
+		// Roughly halves the vertex memory and bandwidth, but vertices can no longer be accessed as Vector3f afterwards.
+		bool compressVertices = false;
+
 		/* The declaration must have a Vector3f position component enabled
 		 * If the declaration has a Vector2f UV component enabled, UV are generated
 		 * If the declaration has a Vector3f Normals component enabled, Normals are generated.
@@ -106,10 +126,13 @@ namespace Nz
 			std::shared_ptr<SubMesh> BuildSubMesh(const Primitive& primitive, const MeshParams& params = MeshParams());
 			void BuildSubMeshes(const PrimitiveList& primitiveList, const MeshParams& params = MeshParams());
 
+			void CompressVertices(const MeshParams& params = MeshParams());
+
 			bool CreateSkeletal(std::size_t jointCount);
 			bool CreateStatic();
 			void Destroy();
 
+			void GenerateLODs(const MeshParams& params = MeshParams());
 			void GenerateNormals();
 			void GenerateNormalsAndTangents();
 			void GenerateTangents();
@@ -135,6 +158,8 @@ namespace Nz
 
 			void InvalidateAABB() const;
 
+			void Optimize(const MeshParams& params = MeshParams());
+
 			bool IsAnimable() const;
 			bool IsValid() const;
 
@@ -167,6 +192,8 @@ namespace Nz
 			NazaraSignal(OnMeshInvalidateAABB, const Mesh* /*mesh*/);
 
 		private:
+			std::shared_ptr<SubMesh> OptimizeSubMesh(SubMesh& subMesh, const MeshParams& params);
+
 			struct SubMeshData
 			{
 				std::shared_ptr<SubMesh> subMesh;
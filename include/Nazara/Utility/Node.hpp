@@ -21,6 +21,8 @@ namespace Nz
 {
 	class NAZARA_UTILITY_API Node
 	{
+		friend class TransformHierarchy;
+
 		public:
 			enum class Invalidation;
 
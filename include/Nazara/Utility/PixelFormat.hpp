@@ -58,7 +58,7 @@ namespace Nz
 		friend class Utility;
 
 		public:
-			using ConvertFunction = std::function<UInt8*(const UInt8* start, const UInt8* end, UInt8* dst)>;
+			using ConvertFunction = UInt8*(*)(const UInt8* start, const UInt8* end, UInt8* dst);
 			using FlipFunction = std::function<void(unsigned int width, unsigned int height, unsigned int depth, const UInt8* src, UInt8* dst)>;
 
 			static inline std::size_t ComputeSize(PixelFormat format, unsigned int width, unsigned int height, unsigned int depth);
@@ -150,10 +150,27 @@ namespace Nz
 		{
 			switch (format)
 			{
+				case PixelFormat::BC4:
 				case PixelFormat::DXT1:
+				case PixelFormat::ETC2_RGB8:
+				case PixelFormat::ETC2_RGB8_SRGB:
+					return (((width + 3) / 4) * ((height + 3) / 4) * 8) * depth;
+
+				case PixelFormat::ASTC4x4:
+				case PixelFormat::ASTC4x4_SRGB:
+				case PixelFormat::BC5:
+				case PixelFormat::BC6H:
+				case PixelFormat::BC7:
+				case PixelFormat::BC7_SRGB:
 				case PixelFormat::DXT3:
 				case PixelFormat::DXT5:
-					return (((width + 3) / 4) * ((height + 3) / 4) * ((format == PixelFormat::DXT1) ? 8 : 16)) * depth;
+				case PixelFormat::ETC2_RGBA8:
+				case PixelFormat::ETC2_RGBA8_SRGB:
+					return (((width + 3) / 4) * ((height + 3) / 4) * 16) * depth;
+
+				case PixelFormat::ASTC8x8:
+				case PixelFormat::ASTC8x8_SRGB:
+					return (((width + 7) / 8) * ((height + 7) / 8) * 16) * depth;
 
 				default:
 					NazaraError("Unsupported format");
@@ -0,0 +1,46 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_UTILITY_PLUGINS_IMAGEDECODERSPLUGIN_HPP
+#define NAZARA_UTILITY_PLUGINS_IMAGEDECODERSPLUGIN_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/PluginInterface.hpp>
+#include <Nazara/Utility/Config.hpp>
+
+namespace Nz
+{
+	// Don't export class due to MinGW bug, export every method instead
+	class ImageDecodersPlugin : public PluginInterface
+	{
+		public:
+#ifdef NAZARA_DEBUG
+			static constexpr inline std::string_view Filename = NazaraPluginPrefix "PluginImageDecoders-d";
+#else
+			static constexpr inline std::string_view Filename = NazaraPluginPrefix "PluginImageDecoders";
+#endif
+
+			ImageDecodersPlugin() = default;
+			ImageDecodersPlugin(const ImageDecodersPlugin&) = delete;
+			ImageDecodersPlugin(ImageDecodersPlugin&&) = delete;
+			~ImageDecodersPlugin() = default;
+
+			ImageDecodersPlugin& operator=(const ImageDecodersPlugin&) = delete;
+			ImageDecodersPlugin& operator=(ImageDecodersPlugin&&) = delete;
+	};
+
+#ifdef NAZARA_PLUGINS_STATIC
+	template<>
+	struct PluginProvider<ImageDecodersPlugin>
+	{
+		static std::unique_ptr<ImageDecodersPlugin> Instantiate();
+	};
+#endif
+}
+
+#include <Nazara/Utility/Plugins/ImageDecodersPlugin.inl>
+
+#endif // NAZARA_UTILITY_PLUGINS_IMAGEDECODERSPLUGIN_HPP
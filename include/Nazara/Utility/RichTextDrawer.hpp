@@ -11,6 +11,7 @@
 #include <Nazara/Utility/AbstractTextDrawer.hpp>
 #include <Nazara/Utility/Enums.hpp>
 #include <Nazara/Utility/Font.hpp>
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -97,6 +98,7 @@ namespace Nz
 			
 		private:
 			struct Block;
+			struct BlockLayout;
 
 			inline void AppendNewLine(const Font& font, unsigned int characterSize, float lineSpacingOffset) const;
 			void AppendNewLine(const Font& font, unsigned int characterSize, float lineSpacingOffset, std::size_t glyphIndex, float glyphPosition) const;
@@ -108,6 +110,7 @@ namespace Nz
 			inline float GetLineHeight(const Block& block) const;
 			inline float GetLineHeight(float lineSpacingOffset, const Font::SizeInfo& sizeInfo) const;
 			inline std::size_t HandleFontAddition(const std::shared_ptr<Font>& font);
+			inline void InvalidateBlocks(std::size_t firstBlockIndex);
 			inline void InvalidateGlyphs();
 			inline void ReleaseFont(std::size_t fontIndex);
 			inline bool ShouldLineWrap(float size) const;
@@ -116,6 +119,8 @@ namespace Nz
 			void OnFontInvalidated(const Font* font);
 			void OnFontRelease(const Font* object);
 
+			void RestoreLayout(const BlockLayout& layout) const;
+			void SaveLayout(BlockLayout& layout) const;
 			void UpdateGlyphs() const;
 
 			static constexpr std::size_t InvalidGlyph = std::numeric_limits<std::size_t>::max();
@@ -134,6 +139,19 @@ namespace Nz
 				unsigned int characterSize;
 			};
 
+			// Layout state before generating a block glyphs, allowing to resume layout from it
+			struct BlockLayout
+			{
+				std::size_t glyphCount;
+				std::size_t lastSeparatorGlyph;
+				std::size_t lineCount;
+				std::vector<Glyph> lineGlyphs; //< glyphs of the current line, which next blocks can move (line wrap or height change)
+				Line line;
+				Rectf bounds;
+				Vector2f drawPos;
+				float lastSeparatorPosition;
+			};
+
 			struct FontData
 			{
 				std::shared_ptr<Font> font;
@@ -149,9 +167,11 @@ namespace Nz
 			Color m_currentOutlineColor;
 			TextStyleFlags m_currentStyle;
 			std::shared_ptr<Font> m_currentFont;
+			mutable std::size_t m_firstInvalidatedBlock;
 			mutable std::size_t m_lastSeparatorGlyph;
 			std::unordered_map<std::shared_ptr<Font>, std::size_t> m_fontIndexes;
 			std::vector<Block> m_blocks;
+			mutable std::vector<BlockLayout> m_blockLayouts;
 			std::vector<FontData> m_fonts;
 			mutable std::vector<Glyph> m_glyphs;
 			mutable std::vector<Line> m_lines;
@@ -265,7 +265,7 @@ namespace Nz
 		NazaraAssert(index < m_blocks.size(), "Invalid block index");
 		m_blocks[index].characterSize = characterSize;
 
-		InvalidateGlyphs();
+		InvalidateBlocks(index);
 	}
 
 	inline void RichTextDrawer::SetBlockCharacterSpacingOffset(std::size_t index, float offset)
@@ -273,7 +273,7 @@ namespace Nz
 		NazaraAssert(index < m_blocks.size(), "Invalid block index");
 		m_blocks[index].characterSpacingOffset = offset;
 
-		InvalidateGlyphs();
+		InvalidateBlocks(index);
 	}
 
 	inline void RichTextDrawer::SetBlockColor(std::size_t index, const Color& color)
@@ -281,7 +281,7 @@ namespace Nz
 		NazaraAssert(index < m_blocks.size(), "Invalid block index");
 		m_blocks[index].color = color;
 
-		InvalidateGlyphs();
+		InvalidateBlocks(index);
 	}
 
 	inline void RichTextDrawer::SetBlockFont(std::size_t index, std::shared_ptr<Font> font)
@@ -298,7 +298,7 @@ namespace Nz
 			m_blocks[index].fontIndex = fontIndex;
 		}
 
-		InvalidateGlyphs();
+		InvalidateBlocks(index);
 	}
 
 	inline void RichTextDrawer::SetBlockLineSpacingOffset(std::size_t index, float offset)
@@ -306,7 +306,7 @@ namespace Nz
 		NazaraAssert(index < m_blocks.size(), "Invalid block index");
 		m_blocks[index].lineSpacingOffset = offset;
 
-		InvalidateGlyphs();
+		InvalidateBlocks(index);
 	}
 
 	inline void RichTextDrawer::SetBlockOutlineColor(std::size_t index, const Color& color)
@@ -314,7 +314,7 @@ namespace Nz
 		NazaraAssert(index < m_blocks.size(), "Invalid block index");
 		m_blocks[index].outlineColor = color;
 
-		InvalidateGlyphs();
+		InvalidateBlocks(index);
 	}
 
 	inline void RichTextDrawer::SetBlockOutlineThickness(std::size_t index, float thickness)
@@ -322,7 +322,7 @@ namespace Nz
 		NazaraAssert(index < m_blocks.size(), "Invalid block index");
 		m_blocks[index].outlineThickness = thickness;
 
-		InvalidateGlyphs();
+		InvalidateBlocks(index);
 	}
 
 	inline void RichTextDrawer::SetBlockStyle(std::size_t index, TextStyleFlags style)
@@ -330,7 +330,7 @@ namespace Nz
 		NazaraAssert(index < m_blocks.size(), "Invalid block index");
 		m_blocks[index].style = style;
 
-		InvalidateGlyphs();
+		InvalidateBlocks(index);
 	}
 
 	inline void RichTextDrawer::SetBlockText(std::size_t index, std::string str)
@@ -349,7 +349,7 @@ namespace Nz
 				m_blocks[i].glyphIndex += delta;
 		}
 
-		InvalidateGlyphs();
+		InvalidateBlocks(index);
 	}
 
 	inline void RichTextDrawer::SetCharacterSize(unsigned int characterSize)
@@ -392,11 +392,17 @@ namespace Nz
 		m_currentStyle = style;
 	}
 
-	inline void RichTextDrawer::InvalidateGlyphs()
+	inline void RichTextDrawer::InvalidateBlocks(std::size_t firstBlockIndex)
 	{
+		m_firstInvalidatedBlock = std::min(m_firstInvalidatedBlock, firstBlockIndex);
 		m_glyphUpdated = false;
 	}
 
+	inline void RichTextDrawer::InvalidateGlyphs()
+	{
+		InvalidateBlocks(0);
+	}
+
 	/*!
 	* \class Nz::RichTextDrawer::BlockRef
 	* \brief Helper class representing a block inside a RichTextDrawer, allowing easier access.
@@ -11,6 +11,9 @@
 #include <Nazara/Utility/AbstractTextDrawer.hpp>
 #include <Nazara/Utility/Enums.hpp>
 #include <Nazara/Utility/Font.hpp>
+#include <algorithm>
+#include <optional>
+#include <string_view>
 #include <vector>
 
 namespace Nz
@@ -27,6 +30,8 @@ namespace Nz
 
 			void Clear() override;
 
+			inline void EraseText(std::size_t textOffset, std::size_t length);
+
 			const Rectf& GetBounds() const override;
 			inline float GetCharacterSpacingOffset() const;
 			inline unsigned int GetCharacterSize() const;
@@ -47,6 +52,8 @@ namespace Nz
 			inline float GetTextOutlineThickness() const;
 			inline TextStyleFlags GetTextStyle() const;
 
+			inline void InsertText(std::size_t textOffset, std::string_view str);
+
 			inline void SetCharacterSpacingOffset(float offset);
 			inline void SetCharacterSize(unsigned int characterSize);
 			inline void SetLineSpacingOffset(float offset);
@@ -67,6 +74,9 @@ namespace Nz
 			static inline SimpleTextDrawer Draw(const std::shared_ptr<Font>& font, std::string str, unsigned int characterSize, TextStyleFlags style, const Color& color, float outlineThickness, const Color& outlineColor);
 
 		private:
+			struct LineLayout;
+			struct TextEdit;
+
 			inline void AppendNewLine() const;
 			void AppendNewLine(std::size_t glyphIndex, float glyphPosition) const;
 
@@ -76,12 +86,14 @@ namespace Nz
 			inline void DisconnectFontSlots();
 
 			bool GenerateGlyph(Glyph& glyph, char32_t character, float outlineThickness, bool lineWrap, Color color, int renderOrder, int* advance) const;
-			void GenerateGlyphs(std::string_view text) const;
+			void GenerateGlyphs(std::size_t textOffset, std::size_t textLength = std::string_view::npos) const;
 
 			inline float GetLineHeight(const Font::SizeInfo& sizeInfo) const;
 
 			inline void InvalidateColor();
 			inline void InvalidateGlyphs();
+			inline void InvalidateEditedText(std::size_t textOffset, std::size_t removedLength, std::size_t insertedLength);
+			inline void InvalidateText(std::size_t textOffset);
 
 			void OnFontAtlasLayerChanged(const Font* font, AbstractImage* oldLayer, AbstractImage* newLayer);
 			void OnFontInvalidated(const Font* font);
@@ -90,18 +102,43 @@ namespace Nz
 			inline bool ShouldLineWrap(float size) const;
 
 			inline void UpdateGlyphColor() const;
-			inline void UpdateGlyphs() const;
+			void UpdateGlyphs() const;
+			bool UpdateGlyphsAfterEdit(const TextEdit& edit) const;
 
 			static constexpr std::size_t InvalidGlyph = std::numeric_limits<std::size_t>::max();
 
+			// Layout state after a line break, allowing to resume layout from it when the following text changes
+			struct LineLayout
+			{
+				std::size_t glyphCount;
+				std::size_t lastSeparatorGlyph;
+				std::size_t lineCount;
+				std::size_t textOffset; //< offset of the first character after the line break
+				Line line;
+				Rectf bounds;
+				Vector2f drawPos;
+				float lastSeparatorPosition;
+			};
+
+			// Single text edit made since last layout, allowing to reuse the layout of the lines following it
+			struct TextEdit
+			{
+				std::size_t insertedLength;
+				std::size_t removedLength;
+				std::size_t textOffset;
+			};
+
 			NazaraSlot(Font, OnFontAtlasChanged, m_atlasChangedSlot);
 			NazaraSlot(Font, OnFontAtlasLayerChanged, m_atlasLayerChangedSlot);
 			NazaraSlot(Font, OnFontGlyphCacheCleared, m_glyphCacheClearedSlot);
 			NazaraSlot(Font, OnFontRelease, m_fontReleaseSlot);
 
+			mutable std::size_t m_firstInvalidatedTextOffset;
 			mutable std::size_t m_lastSeparatorGlyph;
 			mutable std::vector<Glyph> m_glyphs;
 			mutable std::vector<Line> m_lines;
+			mutable std::vector<LineLayout> m_lineLayouts;
+			mutable std::optional<TextEdit> m_pendingEdit;
 			std::string m_text;
 			Color m_color;
 			Color m_outlineColor;
@@ -7,6 +7,7 @@
 namespace Nz
 {
 	inline SimpleTextDrawer::SimpleTextDrawer() :
+	m_firstInvalidatedTextOffset(0),
 	m_color(Color::White()),
 	m_outlineColor(Color::Black()),
 	m_style(TextStyle_Regular),
@@ -22,6 +23,7 @@ namespace Nz
 	}
 
 	inline SimpleTextDrawer::SimpleTextDrawer(const SimpleTextDrawer& drawer) :
+	m_firstInvalidatedTextOffset(0),
 	m_text(drawer.m_text),
 	m_color(drawer.m_color),
 	m_outlineColor(drawer.m_outlineColor),
@@ -44,9 +46,32 @@ namespace Nz
 
 	inline void SimpleTextDrawer::AppendText(std::string_view str)
 	{
+		std::size_t textOffset = m_text.size();
+
 		m_text.append(str);
 		if (m_glyphUpdated)
-			GenerateGlyphs(str);
+			GenerateGlyphs(textOffset);
+		else
+			InvalidateText(textOffset);
+	}
+
+	/*!
+	* \brief Erases a part of the text
+	*
+	* Unlike SetText, this doesn't compare the whole text and allows to reuse the layout of the lines following the erased text.
+	*
+	* \param textOffset Offset of the first byte to erase
+	* \param length Number of bytes to erase
+	*/
+	inline void SimpleTextDrawer::EraseText(std::size_t textOffset, std::size_t length)
+	{
+		NazaraAssert(textOffset <= m_text.size(), "text offset out of range");
+		length = std::min(length, m_text.size() - textOffset);
+		if (length == 0)
+			return;
+
+		m_text.erase(textOffset, length);
+		InvalidateEditedText(textOffset, length, 0);
 	}
 
 	inline float SimpleTextDrawer::GetCharacterSpacingOffset() const
@@ -100,6 +125,30 @@ namespace Nz
 		return m_style;
 	}
 
+	/*!
+	* \brief Inserts text at a byte offset
+	*
+	* Unlike SetText, this doesn't compare the whole text and allows to reuse the layout of the lines following the inserted text.
+	*
+	* \param textOffset Offset of the insertion, which must not be inside of an UTF-8 sequence
+	* \param str Text to insert
+	*/
+	inline void SimpleTextDrawer::InsertText(std::size_t textOffset, std::string_view str)
+	{
+		NazaraAssert(textOffset <= m_text.size(), "text offset out of range");
+		if (str.empty())
+			return;
+
+		if (textOffset == m_text.size())
+		{
+			AppendText(str);
+			return;
+		}
+
+		m_text.insert(textOffset, str);
+		InvalidateEditedText(textOffset, 0, str.size());
+	}
+
 	inline void SimpleTextDrawer::SetCharacterSpacingOffset(float offset)
 	{
 		if (m_characterSpacingOffset != offset)
@@ -146,9 +195,11 @@ namespace Nz
 	{
 		if (m_text != str)
 		{
+			// Layout before the first modified character doesn't change
+			std::size_t firstDifference = std::distance(m_text.begin(), std::mismatch(m_text.begin(), m_text.end(), str.begin(), str.end()).first);
 			m_text = std::move(str);
 
-			InvalidateGlyphs();
+			InvalidateText(firstDifference);
 		}
 	}
 
@@ -236,9 +287,17 @@ namespace Nz
 		m_characterSize = std::move(drawer.m_characterSize);
 		m_characterSpacingOffset = drawer.m_characterSpacingOffset;
 		m_color = std::move(drawer.m_color);
+		m_drawPos = drawer.m_drawPos;
+		m_firstInvalidatedTextOffset = drawer.m_firstInvalidatedTextOffset;
 		m_glyphs = std::move(drawer.m_glyphs);
 		m_glyphUpdated = std::move(drawer.m_glyphUpdated);
 		m_font = std::move(drawer.m_font);
+		m_lastSeparatorGlyph = drawer.m_lastSeparatorGlyph;
+		m_lastSeparatorPosition = drawer.m_lastSeparatorPosition;
+		m_lineLayouts = std::move(drawer.m_lineLayouts);
+		m_lines = std::move(drawer.m_lines);
+		m_pendingEdit = drawer.m_pendingEdit;
+		m_previousCharacter = drawer.m_previousCharacter;
 		m_lineSpacingOffset = drawer.m_lineSpacingOffset;
 		m_maxLineWidth = drawer.m_maxLineWidth;
 		m_outlineColor = std::move(drawer.m_outlineColor);
@@ -339,7 +398,25 @@ namespace Nz
 
 	inline void SimpleTextDrawer::InvalidateGlyphs()
 	{
+		InvalidateText(0);
+	}
+
+	inline void SimpleTextDrawer::InvalidateEditedText(std::size_t textOffset, std::size_t removedLength, std::size_t insertedLength)
+	{
+		// The layout following the edit can only be reused if it's up to date
+		bool isLayoutUpToDate = m_glyphUpdated;
+
+		InvalidateText(textOffset);
+
+		if (isLayoutUpToDate)
+			m_pendingEdit = TextEdit{ insertedLength, removedLength, textOffset };
+	}
+
+	inline void SimpleTextDrawer::InvalidateText(std::size_t textOffset)
+	{
+		m_firstInvalidatedTextOffset = std::min(m_firstInvalidatedTextOffset, textOffset);
 		m_glyphUpdated = false;
+		m_pendingEdit.reset();
 	}
 
 	inline bool SimpleTextDrawer::ShouldLineWrap(float size) const
@@ -354,14 +431,9 @@ namespace Nz
 	{
 		if (m_outlineThickness > 0.f)
 		{
-			for (std::size_t glyphIndex = 0; glyphIndex < m_glyphs.size(); ++glyphIndex)
-			{
-				Glyph& glyph = m_glyphs[glyphIndex];
-				if (glyphIndex % 2 == 0)
-					glyph.color = m_outlineColor;
-				else
-					glyph.color = m_color;
-			}
+			// Outline glyphs are rendered behind their glyph (whitespaces have no outline glyph)
+			for (Glyph& glyph : m_glyphs)
+				glyph.color = (glyph.renderOrder < 1) ? m_outlineColor : m_color;
 		}
 		else
 		{
@@ -371,14 +443,6 @@ namespace Nz
 
 		m_colorUpdated = true;
 	}
-
-	inline void SimpleTextDrawer::UpdateGlyphs() const
-	{
-		NazaraAssert(m_font && m_font->IsValid(), "Invalid font");
-
-		ClearGlyphs();
-		GenerateGlyphs(m_text);
-	}
 }
 
 #include <Nazara/Utility/DebugOff.hpp>
@@ -0,0 +1,64 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_UTILITY_SKELETALPOSE_HPP
+#define NAZARA_UTILITY_SKELETALPOSE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Math/Matrix4.hpp>
+#include <Nazara/Math/Quaternion.hpp>
+#include <Nazara/Math/Vector3.hpp>
+#include <Nazara/Utility/Config.hpp>
+#include <limits>
+#include <vector>
+
+namespace Nz
+{
+	class Skeleton;
+
+	class NAZARA_UTILITY_API SkeletalPose
+	{
+		public:
+			SkeletalPose() = default;
+			explicit SkeletalPose(std::size_t jointCount);
+			explicit SkeletalPose(const Skeleton& skeleton);
+			SkeletalPose(const SkeletalPose&) = default;
+			SkeletalPose(SkeletalPose&&) noexcept = default;
+			~SkeletalPose() = default;
+
+			void Blend(const SkeletalPose& pose, float weight);
+			void Blend(const SkeletalPose& pose, float weight, const float* jointWeights);
+
+			void ComputeModelPose(const std::size_t* parentIndices, SkeletalPose& modelPose) const;
+			void ComputeSkinningMatrices(const Matrix4f* inverseBindMatrices, Matrix4f* skinningMatrices) const;
+
+			inline std::size_t GetJointCount() const;
+			inline Vector3f* GetPositions();
+			inline const Vector3f* GetPositions() const;
+			inline Quaternionf* GetRotations();
+			inline const Quaternionf* GetRotations() const;
+			inline Vector3f* GetScales();
+			inline const Vector3f* GetScales() const;
+
+			void Reset(std::size_t jointCount);
+
+			SkeletalPose& operator=(const SkeletalPose&) = default;
+			SkeletalPose& operator=(SkeletalPose&&) noexcept = default;
+
+			static void Interpolate(const SkeletalPose& poseA, const SkeletalPose& poseB, float interpolation, SkeletalPose& result);
+
+			static constexpr std::size_t NoParent = std::numeric_limits<std::size_t>::max();
+
+		private:
+			std::vector<Quaternionf> m_rotations;
+			std::vector<Vector3f> m_positions;
+			std::vector<Vector3f> m_scales;
+	};
+}
+
+#include <Nazara/Utility/SkeletalPose.inl>
+
+#endif // NAZARA_UTILITY_SKELETALPOSE_HPP
@@ -0,0 +1,45 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	inline std::size_t SkeletalPose::GetJointCount() const
+	{
+		return m_positions.size();
+	}
+
+	inline Vector3f* SkeletalPose::GetPositions()
+	{
+		return m_positions.data();
+	}
+
+	inline const Vector3f* SkeletalPose::GetPositions() const
+	{
+		return m_positions.data();
+	}
+
+	inline Quaternionf* SkeletalPose::GetRotations()
+	{
+		return m_rotations.data();
+	}
+
+	inline const Quaternionf* SkeletalPose::GetRotations() const
+	{
+		return m_rotations.data();
+	}
+
+	inline Vector3f* SkeletalPose::GetScales()
+	{
+		return m_scales.data();
+	}
+
+	inline const Vector3f* SkeletalPose::GetScales() const
+	{
+		return m_scales.data();
+	}
+}
+
+#include <Nazara/Utility/DebugOff.hpp>
@@ -17,6 +17,7 @@
 namespace Nz
 {
 	class Joint;
+	class SkeletalPose;
 	class Skeleton;
 
 	using SkeletonLibrary = ObjectLibrary<Skeleton>;
@@ -53,16 +54,21 @@ namespace Nz
 
 			bool IsValid() const;
 
+			void SetPose(const SkeletalPose& pose);
+
 			Skeleton& operator=(const Skeleton& skeleton);
 			Skeleton& operator=(Skeleton&&) noexcept;
 
 			// Signals:
-			NazaraSignal(OnSkeletonJointsInvalidated, const Skeleton* /*skeleton*/);
+			NazaraSignal(OnSkeletonJointsInvalidated, const Skeleton* /*skeleton*/, std::size_t /*firstJoint*/, std::size_t /*jointCount*/);
 
 			static constexpr std::size_t InvalidJointIndex = std::numeric_limits<std::size_t>::max();
 
 		private:
+			void ExtendJointHierarchyRange(std::size_t jointIndex, std::size_t& firstJoint, std::size_t& lastJoint) const;
+			void InvalidateJointHierarchy(std::size_t jointIndex);
 			void InvalidateJoints();
+			void InvalidateJoints(std::size_t firstJoint, std::size_t jointCount);
 			void InvalidateJointMap();
 			void UpdateJointMap() const;
 
@@ -17,7 +17,7 @@ namespace Nz
 	{
 		public:
 			SoftwareBuffer(BufferType type, UInt64 size, BufferUsageFlags usage, const void* initialData);
-			~SoftwareBuffer() = default;
+			~SoftwareBuffer();
 
 			bool Fill(const void* data, UInt64 offset, UInt64 size) override;
 
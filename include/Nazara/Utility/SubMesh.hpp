@@ -14,6 +14,7 @@
 #include <Nazara/Utility/IndexBuffer.hpp>
 #include <Nazara/Utility/VertexBuffer.hpp>
 #include <NazaraUtils/Signal.hpp>
+#include <vector>
 
 namespace Nz
 {
@@ -29,6 +30,10 @@ namespace Nz
 			SubMesh(SubMesh&&) = delete;
 			virtual ~SubMesh();
 
+			void AddLOD(std::shared_ptr<IndexBuffer> indexBuffer, float error);
+
+			void ClearLODs();
+
 			void GenerateNormals();
 			void GenerateNormalsAndTangents();
 			void GenerateTangents();
@@ -36,6 +41,9 @@ namespace Nz
 			virtual const Boxf& GetAABB() const = 0;
 			virtual AnimationType GetAnimationType() const = 0;
 			virtual const std::shared_ptr<IndexBuffer>& GetIndexBuffer() const = 0;
+			std::size_t GetLODCount() const;
+			float GetLODError(std::size_t lodIndex) const;
+			const std::shared_ptr<IndexBuffer>& GetLODIndexBuffer(std::size_t lodIndex) const;
 			std::size_t GetMaterialIndex() const;
 			PrimitiveMode GetPrimitiveMode() const;
 			UInt32 GetTriangleCount() const;
@@ -53,6 +61,13 @@ namespace Nz
 			NazaraSignal(OnSubMeshInvalidateAABB, const SubMesh* /*subMesh*/);
 
 		protected:
+			struct LevelOfDetail
+			{
+				std::shared_ptr<IndexBuffer> indexBuffer;
+				float error;
+			};
+
+			std::vector<LevelOfDetail> m_levelsOfDetail;
 			PrimitiveMode m_primitiveMode;
 			std::size_t m_matIndex;
 	};
@@ -10,7 +10,10 @@
 #include <NazaraUtils/Prerequisites.hpp>
 #include <Nazara/Core/Time.hpp>
 #include <Nazara/Utility/Config.hpp>
+#include <Nazara/Utility/Skeleton.hpp>
 #include <entt/entt.hpp>
+#include <unordered_map>
+#include <vector>
 
 namespace Nz
 {
@@ -31,9 +34,29 @@ namespace Nz
 			SkeletonSystem& operator=(SkeletonSystem&&) = delete;
 
 		private:
+			void InvalidateSharedSkeleton(const Skeleton* skeleton);
+			void OnDisabledDestroy(entt::registry& registry, entt::entity entity);
+			void OnNodeDestroy(entt::registry& registry, entt::entity entity);
+			void OnSharedSkeletonDestroy(entt::registry& registry, entt::entity entity);
+			void RegisterSharedSkeleton(entt::entity entity, const Skeleton* skeleton);
+			void UnregisterSharedSkeleton(entt::entity entity, const Skeleton* skeleton);
+
+			struct SharedSkeleton
+			{
+				std::vector<entt::entity> entities;
+				bool isInvalidated = false;
+
+				NazaraSlot(Skeleton, OnSkeletonJointsInvalidated, onJointsInvalidated);
+			};
+
 			entt::registry& m_registry;
 			entt::observer m_sharedSkeletonConstructObserver;
 			entt::observer m_skeletonConstructObserver;
+			entt::scoped_connection m_disabledDestroyConnection;
+			entt::scoped_connection m_nodeDestroyConnection;
+			entt::scoped_connection m_sharedSkeletonDestroyConnection;
+			std::unordered_map<const Skeleton*, SharedSkeleton> m_sharedSkeletons;
+			std::vector<const Skeleton*> m_invalidatedSkeletons;
 	};
 }
 
@@ -0,0 +1,59 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_UTILITY_SYSTEMS_TRANSFORMSYSTEM_HPP
+#define NAZARA_UTILITY_SYSTEMS_TRANSFORMSYSTEM_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/Time.hpp>
+#include <Nazara/Utility/Config.hpp>
+#include <Nazara/Utility/Node.hpp>
+#include <Nazara/Utility/TransformHierarchy.hpp>
+#include <NazaraUtils/Bitset.hpp>
+#include <entt/entt.hpp>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_UTILITY_API TransformSystem
+	{
+		public:
+			static constexpr bool AllowConcurrent = false;
+			static constexpr Int64 ExecutionOrder = 900; //< after physics, before rendering
+
+			TransformSystem(entt::registry& registry);
+			TransformSystem(const TransformSystem&) = delete;
+			TransformSystem(TransformSystem&&) = delete;
+			~TransformSystem();
+
+			void Update(Time elapsedTime);
+
+			TransformSystem& operator=(const TransformSystem&) = delete;
+			TransformSystem& operator=(TransformSystem&&) = delete;
+
+		private:
+			void OnNodeConstruct(entt::registry& registry, entt::entity entity);
+			void OnNodeDestroy(entt::registry& registry, entt::entity entity);
+
+			struct NodeEntry
+			{
+				entt::entity entity = entt::null;
+
+				NazaraSlot(Node, OnNodeInvalidation, onNodeInvalidation);
+			};
+
+			entt::registry& m_registry;
+			entt::scoped_connection m_nodeConstructConnection;
+			entt::scoped_connection m_nodeDestroyConnection;
+			std::vector<NodeEntry> m_nodeEntries; //< indexed by entity index
+			Bitset<UInt64> m_invalidatedNodes; //< indexed by entity index
+			TransformHierarchy m_transformHierarchy;
+	};
+}
+
+#include <Nazara/Utility/Systems/TransformSystem.inl>
+
+#endif // NAZARA_UTILITY_SYSTEMS_TRANSFORMSYSTEM_HPP
@@ -9,16 +9,21 @@
 
 #include <NazaraUtils/Prerequisites.hpp>
 #include <Nazara/Core/Time.hpp>
+#include <Nazara/Math/Vector3.hpp>
 #include <Nazara/Utility/Config.hpp>
 #include <NazaraUtils/TypeList.hpp>
 #include <entt/entt.hpp>
+#include <vector>
 
 namespace Nz
 {
+	class Node;
+
 	class NAZARA_UTILITY_API VelocitySystem
 	{
 		public:
-			using Components = TypeList<class NodeComponent, class VelocityComponent>;
+			using Components = TypeList<class NodeComponent>;
+			using ReadOnlyComponents = TypeList<class VelocityComponent>;
 
 			inline VelocitySystem(entt::registry& registry);
 			VelocitySystem(const VelocitySystem&) = delete;
@@ -31,7 +36,16 @@ namespace Nz
 			VelocitySystem& operator=(VelocitySystem&&) = delete;
 
 		private:
+			struct MovingEntity
+			{
+				Node* node;
+				Vector3f movement;
+			};
+
+			static void IntegrateChunk(MovingEntity* entities, std::size_t entityCount);
+
 			entt::registry& m_registry;
+			std::vector<MovingEntity> m_movingEntities;
 	};
 }
 
@@ -0,0 +1,76 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_UTILITY_TRANSFORMHIERARCHY_HPP
+#define NAZARA_UTILITY_TRANSFORMHIERARCHY_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Math/Quaternion.hpp>
+#include <Nazara/Math/Vector3.hpp>
+#include <Nazara/Utility/Config.hpp>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace Nz
+{
+	class Node;
+
+	class NAZARA_UTILITY_API TransformHierarchy
+	{
+		public:
+			TransformHierarchy() = default;
+			TransformHierarchy(const TransformHierarchy&) = delete;
+			TransformHierarchy(TransformHierarchy&&) noexcept = default;
+			~TransformHierarchy() = default;
+
+			inline void Clear();
+
+			void Insert(const Node* node);
+
+			void Update();
+
+			TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+			TransformHierarchy& operator=(TransformHierarchy&&) noexcept = default;
+
+			static constexpr UInt32 NoParent = std::numeric_limits<UInt32>::max();
+
+		private:
+			void SortNodes();
+			void UpdateLevel(std::size_t first, std::size_t last);
+			void WriteBack(std::size_t first, std::size_t last);
+
+			enum InheritFlags : UInt8
+			{
+				InheritPosition = 1 << 0,
+				InheritRotation = 1 << 1,
+				InheritScale    = 1 << 2
+			};
+
+			struct PendingNode
+			{
+				const Node* node;
+				std::size_t depth;
+			};
+
+			std::unordered_map<const Node*, UInt32> m_nodeIndices;
+			std::vector<const Node*> m_nodes;
+			std::vector<PendingNode> m_pendingNodes;
+			std::vector<Quaternionf> m_globalRotations;
+			std::vector<Quaternionf> m_localRotations;
+			std::vector<UInt32> m_parentIndices;
+			std::vector<UInt8> m_inheritFlags;
+			std::vector<Vector3f> m_globalPositions;
+			std::vector<Vector3f> m_globalScales;
+			std::vector<Vector3f> m_localPositions;
+			std::vector<Vector3f> m_localScales;
+			std::vector<std::size_t> m_levelOffsets;
+	};
+}
+
+#include <Nazara/Utility/TransformHierarchy.inl>
+
+#endif // NAZARA_UTILITY_TRANSFORMHIERARCHY_HPP
@@ -0,0 +1,18 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Removes every node waiting for an update
+	*/
+	inline void TransformHierarchy::Clear()
+	{
+		m_pendingNodes.clear();
+	}
+}
+
+#include <Nazara/Utility/DebugOff.hpp>
@@ -34,6 +34,8 @@ namespace Nz
 
 			AnimationLoader& GetAnimationLoader();
 			const AnimationLoader& GetAnimationLoader() const;
+			AnimationSaver& GetAnimationSaver();
+			const AnimationSaver& GetAnimationSaver() const;
 			FontLoader& GetFontLoader();
 			const FontLoader& GetFontLoader() const;
 			ImageLoader& GetImageLoader();
@@ -52,6 +54,7 @@ namespace Nz
 
 		private:
 			AnimationLoader m_animationLoader;
+			AnimationSaver m_animationSaver;
 			FontLoader m_fontLoader;
 			ImageLoader m_imageLoader;
 			ImageSaver m_imageSaver;
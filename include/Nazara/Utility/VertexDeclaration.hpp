@@ -32,6 +32,7 @@ namespace Nz
 			struct ComponentEntry;
 
 			VertexDeclaration(VertexInputRate inputRate, std::initializer_list<ComponentEntry> components);
+			VertexDeclaration(VertexInputRate inputRate, const std::vector<ComponentEntry>& components);
 			VertexDeclaration(const VertexDeclaration&) = delete;
 			VertexDeclaration(VertexDeclaration&&) = delete;
 			~VertexDeclaration() = default;
@@ -53,6 +54,7 @@ namespace Nz
 			VertexDeclaration& operator=(VertexDeclaration&&) = delete;
 
 			static inline const std::shared_ptr<VertexDeclaration>& Get(VertexLayout layout);
+			static std::size_t GetComponentTypeSize(ComponentType type);
 			static bool IsTypeSupported(ComponentType type);
 
 			struct Component
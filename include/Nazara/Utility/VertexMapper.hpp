@@ -8,6 +8,7 @@
 #define NAZARA_UTILITY_VERTEXMAPPER_HPP
 
 #include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Math/Vector4.hpp>
 #include <Nazara/Utility/BufferMapper.hpp>
 #include <Nazara/Utility/Enums.hpp>
 #include <Nazara/Utility/VertexBuffer.hpp>
@@ -25,11 +26,14 @@ namespace Nz
 			~VertexMapper();
 
 			template<typename T> SparsePtr<T> GetComponentPtr(VertexComponent component, std::size_t componentIndex = 0);
+			Vector4f GetComponentValue(VertexComponent component, UInt32 vertexIndex, std::size_t componentIndex = 0);
 			inline const VertexBuffer* GetVertexBuffer() const;
 			inline UInt32 GetVertexCount() const;
 			
 			template<typename T> bool HasComponentOfType(VertexComponent component) const;
 
+			void SetComponentValue(VertexComponent component, UInt32 vertexIndex, const Vector4f& value, std::size_t componentIndex = 0);
+
 			void Unmap();
 
 		private:
@@ -11,6 +11,7 @@
 #include <Nazara/Math/Vector2.hpp>
 #include <Nazara/Math/Vector3.hpp>
 #include <Nazara/Math/Vector4.hpp>
+#include <array>
 
 namespace Nz
 {
@@ -80,6 +81,23 @@ namespace Nz
 		Vector4f weights;
 		Vector4i32 jointIndexes;
 	};
+
+	/************************* Structures 3D (compressed) ************************/
+
+	// Positions and UV are half-floats (position w is unused), normals and tangents are octahedral-encoded snorm16 (see EncodeOctahedral)
+	struct VertexStruct_XYZ_Normal_UV_Tangent_Packed
+	{
+		std::array<UInt16, 4> position;
+		std::array<Int16, 2> normal;
+		std::array<UInt16, 2> uv;
+		std::array<Int16, 2> tangent;
+	};
+
+	struct VertexStruct_XYZ_Normal_UV_Tangent_Skinning_Packed : VertexStruct_XYZ_Normal_UV_Tangent_Packed
+	{
+		std::array<UInt16, 4> weights; //< unorm16
+		Vector4i32 jointIndexes;
+	};
 }
 
 #endif // NAZARA_UTILITY_VERTEXSTRUCT_HPP
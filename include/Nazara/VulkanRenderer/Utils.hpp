@@ -40,6 +40,8 @@ namespace Nz
 	inline VkFilter ToVulkan(SamplerFilter samplerFilter);
 	inline VkSamplerMipmapMode ToVulkan(SamplerMipmapMode samplerMipmap);
 	inline VkSamplerAddressMode ToVulkan(SamplerWrap samplerWrap);
+	inline VkDescriptorBindingFlags ToVulkan(ShaderBindingFlag bindingFlag);
+	inline VkDescriptorBindingFlags ToVulkan(ShaderBindingFlags bindingFlags);
 	inline VkDescriptorType ToVulkan(ShaderBindingType bindingType);
 	inline VkShaderStageFlagBits ToVulkan(nzsl::ShaderStageType stageType);
 	inline VkShaderStageFlags ToVulkan(nzsl::ShaderStageTypeFlags stageType);
@@ -115,8 +115,8 @@ namespace Nz
 		switch (bufferType)
 		{
 			case BufferType::Index:   return VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
-			case BufferType::Storage: return VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
-			case BufferType::Vertex:  return VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+			case BufferType::Storage: return VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT; //< storage buffers can be filled by compute shaders with draw commands
+			case BufferType::Vertex:  return VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT; //< vertex buffers can be written by compute shaders (skinning)
 			case BufferType::Uniform: return VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
 			case BufferType::Upload:  return VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
 		}
@@ -142,6 +142,14 @@ namespace Nz
 			case ComponentType::Int2:       return VK_FORMAT_R32G32_SINT;
 			case ComponentType::Int3:       return VK_FORMAT_R32G32B32_SINT;
 			case ComponentType::Int4:       return VK_FORMAT_R32G32B32A32_SINT;
+			case ComponentType::Half2:      return VK_FORMAT_R16G16_SFLOAT;
+			case ComponentType::Half4:      return VK_FORMAT_R16G16B16A16_SFLOAT;
+			case ComponentType::SNorm8x4:   return VK_FORMAT_R8G8B8A8_SNORM;
+			case ComponentType::SNorm16x2:  return VK_FORMAT_R16G16_SNORM;
+			case ComponentType::SNorm16x4:  return VK_FORMAT_R16G16B16A16_SNORM;
+			case ComponentType::UNorm8x4:   return VK_FORMAT_R8G8B8A8_UNORM;
+			case ComponentType::UNorm16x2:  return VK_FORMAT_R16G16_UNORM;
+			case ComponentType::UNorm16x4:  return VK_FORMAT_R16G16B16A16_UNORM;
 		}
 
 		NazaraError("unhandled ComponentType {0:#x})", UnderlyingCast(componentType));
@@ -210,6 +218,7 @@ namespace Nz
 			case MemoryAccess::DepthStencilWrite:   return VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
 			case MemoryAccess::IndexBufferRead:     return VK_ACCESS_INDEX_READ_BIT;
 			case MemoryAccess::IndirectCommandRead: return VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+			case MemoryAccess::InputAttachmentRead: return VK_ACCESS_INPUT_ATTACHMENT_READ_BIT;
 			case MemoryAccess::HostRead:            return VK_ACCESS_HOST_READ_BIT;
 			case MemoryAccess::HostWrite:           return VK_ACCESS_HOST_WRITE_BIT;
 			case MemoryAccess::MemoryRead:          return VK_ACCESS_MEMORY_READ_BIT;
@@ -247,6 +256,7 @@ namespace Nz
 			case PipelineStage::FragmentTestsEarly:           return VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
 			case PipelineStage::FragmentTestsLate:            return VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
 			case PipelineStage::GeometryShader:               return VK_PIPELINE_STAGE_GEOMETRY_SHADER_BIT;
+			case PipelineStage::Host:                         return VK_PIPELINE_STAGE_HOST_BIT;
 			case PipelineStage::TessellationControlShader:    return VK_PIPELINE_STAGE_TESSELLATION_CONTROL_SHADER_BIT;
 			case PipelineStage::TessellationEvaluationShader: return VK_PIPELINE_STAGE_TESSELLATION_EVALUATION_SHADER_BIT;
 			case PipelineStage::Transfer:                     return VK_PIPELINE_STAGE_TRANSFER_BIT;
@@ -274,6 +284,15 @@ namespace Nz
 		switch (pixelFormat)
 		{
 			// TODO: Fill this switch
+			case PixelFormat::ASTC4x4:          return VK_FORMAT_ASTC_4x4_UNORM_BLOCK;
+			case PixelFormat::ASTC4x4_SRGB:     return VK_FORMAT_ASTC_4x4_SRGB_BLOCK;
+			case PixelFormat::ASTC8x8:          return VK_FORMAT_ASTC_8x8_UNORM_BLOCK;
+			case PixelFormat::ASTC8x8_SRGB:     return VK_FORMAT_ASTC_8x8_SRGB_BLOCK;
+			case PixelFormat::BC4:              return VK_FORMAT_BC4_UNORM_BLOCK;
+			case PixelFormat::BC5:              return VK_FORMAT_BC5_UNORM_BLOCK;
+			case PixelFormat::BC6H:             return VK_FORMAT_BC6H_UFLOAT_BLOCK;
+			case PixelFormat::BC7:              return VK_FORMAT_BC7_UNORM_BLOCK;
+			case PixelFormat::BC7_SRGB:         return VK_FORMAT_BC7_SRGB_BLOCK;
 			case PixelFormat::BGR8:             return VK_FORMAT_B8G8R8_UNORM;
 			case PixelFormat::BGR8_SRGB:        return VK_FORMAT_B8G8R8_SRGB;
 			case PixelFormat::BGRA8:            return VK_FORMAT_B8G8R8A8_UNORM;
@@ -284,6 +303,13 @@ namespace Nz
 			case PixelFormat::Depth24Stencil8:  return VK_FORMAT_D24_UNORM_S8_UINT;
 			case PixelFormat::Depth32F:         return VK_FORMAT_D32_SFLOAT;
 			case PixelFormat::Depth32FStencil8: return VK_FORMAT_D32_SFLOAT_S8_UINT;
+			case PixelFormat::DXT1:             return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+			case PixelFormat::DXT3:             return VK_FORMAT_BC2_UNORM_BLOCK;
+			case PixelFormat::DXT5:             return VK_FORMAT_BC3_UNORM_BLOCK;
+			case PixelFormat::ETC2_RGB8:        return VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK;
+			case PixelFormat::ETC2_RGB8_SRGB:   return VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK;
+			case PixelFormat::ETC2_RGBA8:       return VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK;
+			case PixelFormat::ETC2_RGBA8_SRGB:  return VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK;
 			case PixelFormat::R8:               return VK_FORMAT_R8_UNORM;
 			case PixelFormat::RG8:              return VK_FORMAT_R8G8_UNORM;
 			case PixelFormat::RGB8:             return VK_FORMAT_R8G8B8_UNORM;
@@ -405,6 +431,28 @@ namespace Nz
 		return VK_SAMPLER_ADDRESS_MODE_REPEAT;
 	}
 
+	inline VkDescriptorBindingFlags ToVulkan(ShaderBindingFlag bindingFlag)
+	{
+		switch (bindingFlag)
+		{
+			case ShaderBindingFlag::PartiallyBound:           return VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
+			case ShaderBindingFlag::UpdateAfterBind:          return VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT;
+			case ShaderBindingFlag::UpdateUnusedWhilePending: return VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+		}
+
+		NazaraError("unhandled ShaderBindingFlag {0:#x})", UnderlyingCast(bindingFlag));
+		return 0;
+	}
+
+	inline VkDescriptorBindingFlags ToVulkan(ShaderBindingFlags bindingFlags)
+	{
+		VkDescriptorBindingFlags descriptorBindingFlags = 0;
+		for (ShaderBindingFlag bindingFlag : bindingFlags)
+			descriptorBindingFlags |= ToVulkan(bindingFlag);
+
+		return descriptorBindingFlags;
+	}
+
 	inline VkDescriptorType ToVulkan(ShaderBindingType bindingType)
 	{
 		switch (bindingType)
@@ -489,6 +537,8 @@ namespace Nz
 			case TextureUsage::ShaderSampling:         return VK_IMAGE_USAGE_SAMPLED_BIT;
 			case TextureUsage::TransferSource:         return VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
 			case TextureUsage::TransferDestination:    return VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+			case TextureUsage::TransientAttachment:    return VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+			case TextureUsage::Streamed:               return VkImageUsageFlagBits(0); //< memory hint only
 		}
 
 		NazaraError("unhandled TextureUsage {0:#x})", UnderlyingCast(textureLayout));
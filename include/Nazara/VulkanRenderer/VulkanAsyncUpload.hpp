@@ -0,0 +1,64 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Vulkan renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_VULKANRENDERER_VULKANASYNCUPLOAD_HPP
+#define NAZARA_VULKANRENDERER_VULKANASYNCUPLOAD_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Renderer/AsyncUpload.hpp>
+#include <Nazara/VulkanRenderer/Config.hpp>
+#include <Nazara/VulkanRenderer/Wrapper/CommandBuffer.hpp>
+#include <Nazara/VulkanRenderer/Wrapper/Fence.hpp>
+#include <Nazara/VulkanRenderer/Wrapper/Semaphore.hpp>
+#include <memory>
+#include <optional>
+
+namespace Nz
+{
+	class VulkanBuffer;
+	class VulkanDevice;
+
+	class NAZARA_VULKANRENDERER_API VulkanAsyncUpload final : public AsyncUpload
+	{
+		public:
+			VulkanAsyncUpload(VulkanDevice& device);
+			VulkanAsyncUpload(const VulkanAsyncUpload&) = delete;
+			VulkanAsyncUpload(VulkanAsyncUpload&&) = delete;
+			~VulkanAsyncUpload();
+
+			void FinishBufferUpload(VkBuffer buffer, UInt64 offset, UInt64 size);
+			void FinishImageUpload(VkImage image, const VkImageSubresourceRange& subresourceRange);
+
+			inline Vk::CommandBuffer& GetTransferCommandBuffer();
+
+			bool IsFinished() const override;
+			inline bool IsSubmitted() const;
+
+			inline bool RequiresOwnershipTransfer() const;
+
+			void Submit(std::unique_ptr<VulkanBuffer> stagingBuffer);
+
+			void Wait() override;
+
+			VulkanAsyncUpload& operator=(const VulkanAsyncUpload&) = delete;
+			VulkanAsyncUpload& operator=(VulkanAsyncUpload&&) = delete;
+
+		private:
+			std::optional<Vk::AutoCommandBuffer> m_acquireCommandBuffer; //< recorded for the graphics queue if the transfer queue is from another family
+			std::unique_ptr<VulkanBuffer> m_stagingBuffer;
+			Vk::AutoCommandBuffer m_transferCommandBuffer;
+			mutable Vk::Fence m_fence;
+			Vk::Semaphore m_ownershipSemaphore;
+			VulkanDevice& m_device;
+			UInt32 m_graphicsFamilyIndex;
+			UInt32 m_transferFamilyIndex;
+			bool m_isSubmitted;
+	};
+}
+
+#include <Nazara/VulkanRenderer/VulkanAsyncUpload.inl>
+
+#endif // NAZARA_VULKANRENDERER_VULKANASYNCUPLOAD_HPP
@@ -0,0 +1,25 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Vulkan renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/VulkanRenderer/Debug.hpp>
+
+namespace Nz
+{
+	inline Vk::CommandBuffer& VulkanAsyncUpload::GetTransferCommandBuffer()
+	{
+		return m_transferCommandBuffer;
+	}
+
+	inline bool VulkanAsyncUpload::IsSubmitted() const
+	{
+		return m_isSubmitted;
+	}
+
+	inline bool VulkanAsyncUpload::RequiresOwnershipTransfer() const
+	{
+		return m_transferFamilyIndex != m_graphicsFamilyIndex;
+	}
+}
+
+#include <Nazara/VulkanRenderer/DebugOff.hpp>
@@ -14,6 +14,7 @@
 
 namespace Nz
 {
+	class VulkanFramebuffer;
 	class VulkanRenderPass;
 
 	class NAZARA_VULKANRENDERER_API VulkanCommandBufferBuilder final : public CommandBufferBuilder
@@ -48,6 +49,8 @@ namespace Nz
 
 			void Draw(UInt32 vertexCount, UInt32 instanceCount = 1, UInt32 firstVertex = 0, UInt32 firstInstance = 0) override;
 			void DrawIndexed(UInt32 indexCount, UInt32 instanceCount = 1, UInt32 firstIndex = 0, UInt32 firstInstance = 0) override;
+			void DrawIndexedIndirect(const RenderBufferView& indirectBuffer, UInt32 drawCount, UInt32 stride = sizeof(DrawIndexedIndirectCommand)) override;
+			void DrawIndexedIndirectCount(const RenderBufferView& indirectBuffer, const RenderBufferView& countBuffer, UInt32 maxDrawCount, UInt32 stride = sizeof(DrawIndexedIndirectCommand)) override;
 
 			void EndDebugRegion() override;
 			void EndRenderPass() override;
@@ -55,22 +58,32 @@ namespace Nz
 			void InsertDebugLabel(std::string_view label, const Color& color) override;
 
 			inline Vk::CommandBuffer& GetCommandBuffer();
+
+			void MemoryBarrier(PipelineStageFlags srcStageMask, PipelineStageFlags dstStageMask, MemoryAccessFlags srcAccessMask, MemoryAccessFlags dstAccessMask) override;
 			
 			void NextSubpass() override;
 
 			void PreTransferBarrier() override;
 			void PostTransferBarrier() override;
 
+			void PushConstants(const RenderPipelineLayout& pipelineLayout, UInt32 offset, UInt32 size, const void* data) override;
+
 			void SetScissor(const Recti& scissorRegion) override;
 			void SetViewport(const Recti& viewportRegion) override;
 
+			void TextureAcquireBarrier(PipelineStageFlags srcStageMask, PipelineStageFlags dstStageMask, MemoryAccessFlags srcAccessMask, MemoryAccessFlags dstAccessMask, TextureLayout oldLayout, TextureLayout newLayout, QueueType srcQueue, QueueType dstQueue, const Texture& texture) override;
 			void TextureBarrier(PipelineStageFlags srcStageMask, PipelineStageFlags dstStageMask, MemoryAccessFlags srcAccessMask, MemoryAccessFlags dstAccessMask, TextureLayout oldLayout, TextureLayout newLayout, const Texture& texture) override;
+			void TextureReleaseBarrier(PipelineStageFlags srcStageMask, PipelineStageFlags dstStageMask, MemoryAccessFlags srcAccessMask, MemoryAccessFlags dstAccessMask, TextureLayout oldLayout, TextureLayout newLayout, QueueType srcQueue, QueueType dstQueue, const Texture& texture) override;
 
 			VulkanCommandBufferBuilder& operator=(const VulkanCommandBufferBuilder&) = delete;
 			VulkanCommandBufferBuilder& operator=(VulkanCommandBufferBuilder&&) = delete;
 
 		private:
+			void BeginRendering(const VulkanFramebuffer& framebuffer, const VulkanRenderPass& renderPass, const Recti& renderRect, const VkClearValue* clearValues);
+			void EndRendering();
+
 			Vk::CommandBuffer& m_commandBuffer;
+			const VulkanFramebuffer* m_currentFramebuffer;
 			const VulkanRenderPass* m_currentRenderPass;
 			std::size_t m_currentSubpassIndex;
 	};
@@ -7,7 +7,9 @@
 namespace Nz
 {
 	inline VulkanCommandBufferBuilder::VulkanCommandBufferBuilder(Vk::CommandBuffer& commandBuffer) :
-	m_commandBuffer(commandBuffer)
+	m_commandBuffer(commandBuffer),
+	m_currentFramebuffer(nullptr),
+	m_currentRenderPass(nullptr)
 	{
 	}
 
@@ -21,6 +21,7 @@ namespace Nz
 	struct VulkanDescriptorSetLayoutInfo
 	{
 		VkDescriptorSetLayoutCreateFlags createFlags = 0;
+		std::vector<VkDescriptorBindingFlags> bindingFlags; //< empty if no binding has flags, one entry per binding otherwise
 		std::vector<VkDescriptorSetLayoutBinding> bindings;
 	};
 
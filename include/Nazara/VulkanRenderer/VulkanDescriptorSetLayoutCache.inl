@@ -4,6 +4,7 @@
 
 #include <Nazara/VulkanRenderer/Utils.hpp>
 #include <NazaraUtils/Hash.hpp>
+#include <cassert>
 #include <stdexcept>
 #include <Nazara/VulkanRenderer/Debug.hpp>
 
@@ -13,6 +14,9 @@ namespace Nz
 	{
 		std::size_t hash = 0;
 		HashCombine(hash, layoutInfo.createFlags);
+		for (VkDescriptorBindingFlags bindingFlags : layoutInfo.bindingFlags)
+			HashCombine(hash, bindingFlags);
+
 		for (const auto& binding : layoutInfo.bindings)
 		{
 			HashCombine(hash, binding.binding);
@@ -30,6 +34,9 @@ namespace Nz
 		if (lhs.createFlags != rhs.createFlags)
 			return false;
 
+		if (lhs.bindingFlags != rhs.bindingFlags)
+			return false;
+
 		if (lhs.bindings.size() != rhs.bindings.size())
 			return false;
 
@@ -73,8 +80,25 @@ namespace Nz
 		if (it != m_cache.end())
 			return it->second;
 
+		assert(layoutInfo.bindingFlags.empty() || layoutInfo.bindingFlags.size() == layoutInfo.bindings.size());
+
+		VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo = {
+			VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+			nullptr,
+			UInt32(layoutInfo.bindingFlags.size()),
+			layoutInfo.bindingFlags.data()
+		};
+
+		VkDescriptorSetLayoutCreateInfo createInfo = {
+			VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+			(!layoutInfo.bindingFlags.empty()) ? &bindingFlagsInfo : nullptr,
+			layoutInfo.createFlags,
+			UInt32(layoutInfo.bindings.size()),
+			layoutInfo.bindings.data()
+		};
+
 		Vk::DescriptorSetLayout setLayout;
-		if (!setLayout.Create(m_device, UInt32(layoutInfo.bindings.size()), layoutInfo.bindings.data(), layoutInfo.createFlags))
+		if (!setLayout.Create(m_device, createInfo))
 			throw std::runtime_error("failed to create descriptor set layout: " + TranslateVulkanError(setLayout.GetLastErrorCode()));
 
 		return m_cache.emplace(layoutInfo, std::move(setLayout)).first->second;
@@ -11,10 +11,21 @@
 #include <Nazara/Renderer/RenderDevice.hpp>
 #include <Nazara/VulkanRenderer/VulkanBuffer.hpp>
 #include <Nazara/VulkanRenderer/Wrapper/Device.hpp>
+#include <Nazara/VulkanRenderer/Wrapper/Fence.hpp>
+#include <Nazara/VulkanRenderer/Wrapper/PipelineCache.hpp>
+#include <Nazara/VulkanRenderer/Wrapper/Semaphore.hpp>
+#include <deque>
+#include <filesystem>
+#include <mutex>
 #include <vector>
 
+VK_DEFINE_HANDLE(VmaDefragmentationContext)
+struct VmaDefragmentationMove;
+
 namespace Nz
 {
+	class VulkanAsyncUpload;
+
 	class NAZARA_VULKANRENDERER_API VulkanDevice : public RenderDevice, public Vk::Device
 	{
 		public:
@@ -23,8 +34,16 @@ namespace Nz
 			VulkanDevice(VulkanDevice&&) = delete; ///TODO?
 			~VulkanDevice();
 
+			bool AbandonRelocation(VmaAllocation allocation);
+
+			void DefragmentStreamedTextures(RenderFrame& renderFrame, UInt64 maxBytes, const FunctionRef<void(Texture& texture)>& relocationCallback) override;
+
 			const RenderDeviceInfo& GetDeviceInfo() const override;
 			const RenderDeviceFeatures& GetEnabledFeatures() const override;
+			std::vector<RenderMemoryHeapStatistics> GetMemoryHeapStatistics() const override;
+			inline const Vk::PipelineCache& GetPipelineCache() const;
+
+			bool InitializePipelineCache(std::filesystem::path cacheFilePath = {});
 
 			std::shared_ptr<RenderBuffer> InstantiateBuffer(BufferType type, UInt64 size, BufferUsageFlags usageFlags, const void* initialData = nullptr) override;
 			std::shared_ptr<CommandPool> InstantiateCommandPool(QueueType queueType) override;
@@ -40,16 +59,74 @@ namespace Nz
 			std::shared_ptr<Texture> InstantiateTexture(const TextureInfo& params, const void* initialData, bool buildMipmaps, unsigned int srcWidth = 0, unsigned int srcHeight = 0) override;
 			std::shared_ptr<TextureSampler> InstantiateTextureSampler(const TextureSamplerInfo& params) override;
 
+			bool IsParallelCommandRecordingSupported() const override;
 			bool IsTextureFormatSupported(PixelFormat format, TextureUsage usage) const override;
 
+			bool SavePipelineCache() const;
+
+			void SignalQueueTimeline(QueueType queueType, Vk::QueueHandle& queue);
+
+			std::shared_ptr<AsyncUpload> UploadAsync(RenderBuffer& buffer, const void* data, UInt64 offset, UInt64 size) override;
+			std::shared_ptr<AsyncUpload> UploadAsync(Texture& texture, const void* data, const Boxui& box, unsigned int srcWidth = 0, unsigned int srcHeight = 0, UInt8 level = 0) override;
+
 			void WaitForIdle() override;
 
 			VulkanDevice& operator=(const VulkanDevice&) = delete;
 			VulkanDevice& operator=(VulkanDevice&&) = delete; ///TODO?
 
+		protected:
+			QueueTimelineValues GetSubmittedTimelineValues() const override;
+			QueueTimelineValues QueryCompletedTimelineValues() override;
+
 		private:
+			void EndDefragmentationPass();
+			void ReleaseFinishedUploads();
+
+			struct Defragmentation
+			{
+				VmaDefragmentationContext context = VK_NULL_HANDLE;
+				VmaDefragmentationMove* moves = nullptr;
+				UInt32 memoryTypeIndex = 0;
+				UInt32 moveCount = 0;
+				bool isPassPending = false;
+			};
+
+			struct PendingFence
+			{
+				Vk::Fence fence;
+				UInt64 timelineValue;
+			};
+
+			struct QueueTimeline
+			{
+				std::deque<PendingFence> pendingFences; //< only used if timeline semaphores are not supported
+				Vk::Semaphore semaphore;
+				UInt64 completedValue = 0;
+				UInt64 signaledValue = 0;
+			};
+
+			struct PipelineCacheHeader
+			{
+				UInt32 magic;
+				UInt32 version;
+				UInt32 vendorID;
+				UInt32 deviceID;
+				UInt32 driverVersion;
+				UInt8 pipelineCacheUUID[VK_UUID_SIZE];
+				UInt64 dataSize;
+			};
+
+			static constexpr UInt32 PipelineCacheMagic = 0x4350'5A4E; //< "NZPC"
+			static constexpr UInt32 PipelineCacheVersion = 1;
+
+			std::filesystem::path m_pipelineCacheFilePath;
+			std::vector<std::shared_ptr<VulkanAsyncUpload>> m_pendingUploads;
+			Defragmentation m_defragmentation;
+			EnumArray<QueueType, QueueTimeline> m_queueTimelines;
+			mutable std::mutex m_queueTimelineMutex;
 			RenderDeviceFeatures m_enabledFeatures;
 			RenderDeviceInfo m_renderDeviceInfo;
+			Vk::PipelineCache m_pipelineCache;
 	};
 }
 
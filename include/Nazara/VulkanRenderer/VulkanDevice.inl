@@ -12,6 +12,11 @@ namespace Nz
 	m_renderDeviceInfo(std::move(renderDeviceInfo))
 	{
 	}
+
+	inline const Vk::PipelineCache& VulkanDevice::GetPipelineCache() const
+	{
+		return m_pipelineCache;
+	}
 }
 
 #include <Nazara/VulkanRenderer/DebugOff.hpp>
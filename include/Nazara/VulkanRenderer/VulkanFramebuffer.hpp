@@ -11,18 +11,32 @@
 #include <Nazara/Renderer/Framebuffer.hpp>
 #include <Nazara/VulkanRenderer/Config.hpp>
 #include <Nazara/VulkanRenderer/Wrapper/Framebuffer.hpp>
+#include <vector>
 
 namespace Nz
 {
 	class NAZARA_VULKANRENDERER_API VulkanFramebuffer : public Framebuffer
 	{
 		public:
+			struct Attachment;
+
 			using Framebuffer::Framebuffer;
 
-			virtual Vk::Framebuffer& GetFramebuffer() = 0;
+			inline const std::vector<Attachment>& GetAttachments() const;
+			virtual Vk::Framebuffer& GetFramebuffer() = 0; //< invalid if the framebuffer render pass uses dynamic rendering
 			virtual const Vk::Framebuffer& GetFramebuffer() const = 0;
 
 			void UpdateDebugName(std::string_view name) override;
+
+			struct Attachment
+			{
+				VkImage image;
+				VkImageView imageView;
+				VkImageSubresourceRange subresourceRange;
+			};
+
+		protected:
+			std::vector<Attachment> m_attachments;
 	};
 }
 
@@ -6,6 +6,13 @@
 
 namespace Nz
 {
+	/*!
+	* \brief Returns the attachment images, used to begin dynamic rendering passes (which don't rely on framebuffer objects)
+	*/
+	inline auto VulkanFramebuffer::GetAttachments() const -> const std::vector<Attachment>&
+	{
+		return m_attachments;
+	}
 }
 
 #include <Nazara/VulkanRenderer/DebugOff.hpp>
@@ -14,6 +14,8 @@
 #include <Nazara/VulkanRenderer/Wrapper/CommandPool.hpp>
 #include <Nazara/VulkanRenderer/Wrapper/Fence.hpp>
 #include <Nazara/VulkanRenderer/Wrapper/Semaphore.hpp>
+#include <NazaraUtils/EnumArray.hpp>
+#include <vector>
 
 namespace Nz
 {
@@ -41,14 +43,36 @@ namespace Nz
 
 			void SubmitCommandBuffer(CommandBuffer* commandBuffer, QueueTypeFlags queueTypeFlags) override;
 			void SubmitCommandBuffer(VkCommandBuffer commandBuffer, QueueTypeFlags queueTypeFlags);
+			void SynchronizeQueues(QueueType waitingQueue, QueueType signalingQueue) override;
 
 			VulkanRenderImage& operator=(const VulkanRenderImage&) = delete;
 			VulkanRenderImage& operator=(VulkanRenderImage&&) = delete;
 
 		private:
+			struct QueueSubmission;
+
+			VkSemaphore AllocateSemaphore();
+			QueueSubmission* FindLastSubmission(QueueType queueType);
+			std::size_t GetSubmission(QueueType queueType);
+			VkSemaphore SignalQueue(QueueType queueType);
+
+			// Command buffers submitted to a queue between two synchronization points
+			struct QueueSubmission
+			{
+				std::vector<VkCommandBuffer> commandBuffers;
+				std::vector<VkPipelineStageFlags> waitStages;
+				std::vector<VkSemaphore> signalSemaphores;
+				std::vector<VkSemaphore> waitSemaphores;
+				QueueType queueType;
+				bool isClosed = false;
+			};
+
 			std::size_t m_freeCommandBufferIndex;
+			std::size_t m_freeSemaphoreIndex;
 			std::vector<VkCommandBuffer> m_allocatedCommandBuffers;;
-			std::vector<VkCommandBuffer> m_graphicalCommandBuffers;
+			std::vector<QueueSubmission> m_submissions;
+			std::vector<Vk::Semaphore> m_queueSemaphores;
+			EnumArray<QueueType, QueueTypeFlags> m_pendingQueueWaits;
 			VulkanSwapchain& m_owner;
 			Vk::CommandPool m_commandPool;
 			Vk::Fence m_inFlightFence;
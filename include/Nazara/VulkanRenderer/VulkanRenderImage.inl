@@ -30,8 +30,10 @@ namespace Nz
 	{
 		FlushReleaseQueue();
 
-		m_graphicalCommandBuffers.clear();
+		m_submissions.clear();
+		m_pendingQueueWaits.fill(QueueTypeFlags{});
 		m_freeCommandBufferIndex = 0;
+		m_freeSemaphoreIndex = 0;
 		m_imageIndex = imageIndex;
 		m_commandPool.Reset();
 		m_uploadPool.Reset();
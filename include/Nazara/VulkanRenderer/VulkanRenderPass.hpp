@@ -19,13 +19,22 @@ namespace Nz
 	class NAZARA_VULKANRENDERER_API VulkanRenderPass final : public RenderPass
 	{
 		public:
+			struct DynamicRenderingBarrier;
+			struct RenderingFormats;
+
 			VulkanRenderPass(Vk::Device& device, std::vector<Attachment> attachments, std::vector<SubpassDescription> subpassDescriptions, std::vector<SubpassDependency> subpassDependencies);
 			VulkanRenderPass(const VulkanRenderPass&) = delete;
 			VulkanRenderPass(VulkanRenderPass&&) noexcept = default;
 			~VulkanRenderPass();
 
+			inline VkImageLayout GetAttachmentLayout(std::size_t attachmentIndex) const;
+			inline const DynamicRenderingBarrier& GetBeginBarrier() const;
+			inline const DynamicRenderingBarrier& GetEndBarrier() const;
 			inline Vk::RenderPass& GetRenderPass();
 			inline const Vk::RenderPass& GetRenderPass() const;
+			inline const RenderingFormats& GetRenderingFormats() const;
+
+			inline bool UsesDynamicRendering() const;
 
 			void UpdateDebugName(std::string_view name) override;
 
@@ -34,8 +43,36 @@ namespace Nz
 
 			NazaraSignal(OnRenderPassRelease, const VulkanRenderPass* /*renderPass*/);
 
+			// Synchronization and layout transitions performed by render passes, which have to be done explicitly with dynamic rendering
+			struct DynamicRenderingBarrier
+			{
+				VkAccessFlags srcAccessMask;
+				VkAccessFlags dstAccessMask;
+				VkPipelineStageFlags srcStageMask;
+				VkPipelineStageFlags dstStageMask;
+			};
+
+			// Attachment formats, which is all pipelines need to know about dynamic rendering passes
+			struct RenderingFormats
+			{
+				std::vector<VkFormat> colorFormats;
+				VkFormat depthFormat = VK_FORMAT_UNDEFINED;
+				VkFormat stencilFormat = VK_FORMAT_UNDEFINED;
+				std::size_t hash = 0; //< computed once, render passes are used as keys on each pipeline bind
+
+				inline bool operator==(const RenderingFormats& formats) const;
+			};
+
 		private:
+			void BuildDynamicRenderingInfo();
+			void CreateRenderPass(Vk::Device& device);
+
+			std::vector<VkImageLayout> m_attachmentLayouts;
+			DynamicRenderingBarrier m_beginBarrier;
+			DynamicRenderingBarrier m_endBarrier;
+			RenderingFormats m_renderingFormats;
 			Vk::RenderPass m_renderPass;
+			bool m_usesDynamicRendering;
 	};
 }
 
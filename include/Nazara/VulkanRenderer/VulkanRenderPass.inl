@@ -2,10 +2,30 @@
 // This file is part of the "Nazara Engine - Vulkan renderer"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
+#include <cassert>
 #include <Nazara/VulkanRenderer/Debug.hpp>
 
 namespace Nz
 {
+	/*!
+	* \brief Returns the layout an attachment is in during the (only) subpass of a dynamic rendering pass
+	*/
+	inline VkImageLayout VulkanRenderPass::GetAttachmentLayout(std::size_t attachmentIndex) const
+	{
+		assert(attachmentIndex < m_attachmentLayouts.size());
+		return m_attachmentLayouts[attachmentIndex];
+	}
+
+	inline auto VulkanRenderPass::GetBeginBarrier() const -> const DynamicRenderingBarrier&
+	{
+		return m_beginBarrier;
+	}
+
+	inline auto VulkanRenderPass::GetEndBarrier() const -> const DynamicRenderingBarrier&
+	{
+		return m_endBarrier;
+	}
+
 	inline Vk::RenderPass& VulkanRenderPass::GetRenderPass()
 	{
 		return m_renderPass;
@@ -15,6 +35,24 @@ namespace Nz
 	{
 		return m_renderPass;
 	}
+
+	inline auto VulkanRenderPass::GetRenderingFormats() const -> const RenderingFormats&
+	{
+		return m_renderingFormats;
+	}
+
+	/*!
+	* \brief Returns true if this render pass is recorded using dynamic rendering, in which case no render pass nor framebuffer object exist
+	*/
+	inline bool VulkanRenderPass::UsesDynamicRendering() const
+	{
+		return m_usesDynamicRendering;
+	}
+
+	inline bool VulkanRenderPass::RenderingFormats::operator==(const RenderingFormats& formats) const
+	{
+		return hash == formats.hash && depthFormat == formats.depthFormat && stencilFormat == formats.stencilFormat && colorFormats == formats.colorFormats;
+	}
 }
 
 #include <Nazara/VulkanRenderer/DebugOff.hpp>
@@ -15,6 +15,7 @@
 #include <Nazara/VulkanRenderer/Wrapper/Device.hpp>
 #include <Nazara/VulkanRenderer/Wrapper/Pipeline.hpp>
 #include <NazaraUtils/MovablePtr.hpp>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -82,6 +83,7 @@ namespace Nz
 			};
 
 		private:
+			VkPipeline GetDynamicRenderingPipeline(const VulkanRenderPass::RenderingFormats& renderingFormats) const;
 			void UpdateCreateInfo(std::size_t colorBufferCount) const;
 
 			struct PipelineHasher
@@ -89,6 +91,11 @@ namespace Nz
 				inline std::size_t operator()(const std::pair<VkRenderPass, std::size_t>& renderPass) const;
 			};
 
+			struct RenderingFormatsHasher
+			{
+				inline std::size_t operator()(const VulkanRenderPass::RenderingFormats& renderingFormats) const;
+			};
+
 			struct PipelineData
 			{
 				NazaraSlot(VulkanRenderPass, OnRenderPassRelease, onRenderPassRelease);
@@ -98,8 +105,10 @@ namespace Nz
 
 			std::string m_debugName;
 			mutable std::unordered_map<std::pair<VkRenderPass, std::size_t>, PipelineData, PipelineHasher> m_pipelines;
-			MovablePtr<Vk::Device> m_device;
+			mutable std::unordered_map<VulkanRenderPass::RenderingFormats, Vk::Pipeline, RenderingFormatsHasher> m_dynamicRenderingPipelines; //< shared by every render pass with the same attachment formats
+			MovablePtr<VulkanDevice> m_device;
 			mutable CreateInfo m_pipelineCreateInfo;
+			mutable std::mutex m_pipelineMutex; //< command buffers can be recorded from multiple threads
 			RenderPipelineInfo m_pipelineInfo;
 	};
 }
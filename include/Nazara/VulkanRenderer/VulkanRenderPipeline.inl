@@ -15,6 +15,11 @@ namespace Nz
 		return seed;
 	}
 
+	inline std::size_t VulkanRenderPipeline::RenderingFormatsHasher::operator()(const VulkanRenderPass::RenderingFormats& renderingFormats) const
+	{
+		return renderingFormats.hash;
+	}
+
 	inline const RenderPipelineInfo& VulkanRenderPipeline::GetPipelineInfo() const
 	{
 		return m_pipelineInfo;
@@ -28,6 +28,8 @@ namespace Nz
 		friend VulkanShaderBinding;
 
 		public:
+			struct Stats;
+
 			VulkanRenderPipelineLayout() = default;
 			~VulkanRenderPipelineLayout();
 
@@ -38,24 +40,44 @@ namespace Nz
 			inline Vk::Device* GetDevice() const;
 
 			inline const Vk::PipelineLayout& GetPipelineLayout() const;
+			VkShaderStageFlags GetPushConstantStageFlags(UInt32 offset, UInt32 size) const;
+			inline const Stats& GetStats() const;
 
 			void UpdateDebugName(std::string_view name) override;
 
+			struct Stats
+			{
+				std::size_t allocatedBindingCount = 0;
+				std::size_t descriptorPoolCount = 0;
+				std::size_t recycledSetCount = 0; //< descriptor sets kept allocated for reuse
+				UInt64 releasedPoolCount = 0; //< total number of descriptor pools released by compaction
+				UInt64 reusedSetCount = 0; //< total number of bindings allocated using a recycled descriptor set
+			};
+
 		private:
 			struct DescriptorPool;
 
-			DescriptorPool& AllocatePool();
+			std::size_t AllocatePool();
 			ShaderBindingPtr AllocateFromPool(std::size_t poolIndex, UInt32 setIndex);
 			void Release(ShaderBinding& binding);
+			void ReleasePool(std::size_t poolIndex);
 			inline void TryToShrink();
 
+			struct RecycledDescriptorSet
+			{
+				Vk::DescriptorSet descriptorSet;
+				UInt32 setIndex;
+			};
+
 			struct DescriptorPool
 			{
 				using BindingStorage = std::aligned_storage_t<sizeof(VulkanShaderBinding), alignof(VulkanShaderBinding)>;
 
 				Bitset<UInt64> freeBindings;
-				std::unique_ptr<Vk::DescriptorPool> descriptorPool;
+				std::size_t usedBindingCount = 0;
+				std::unique_ptr<Vk::DescriptorPool> descriptorPool; //< null if the pool was released
 				std::unique_ptr<BindingStorage[]> storage;
+				std::vector<RecycledDescriptorSet> recycledSets;
 			};
 
 			MovablePtr<Vk::Device> m_device;
@@ -63,6 +85,7 @@ namespace Nz
 			std::vector<const Vk::DescriptorSetLayout*> m_descriptorSetLayouts;
 			Vk::PipelineLayout m_pipelineLayout;
 			RenderPipelineLayoutInfo m_layoutInfo;
+			Stats m_stats;
 	};
 }
 
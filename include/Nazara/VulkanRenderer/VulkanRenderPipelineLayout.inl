@@ -16,21 +16,19 @@ namespace Nz
 		return m_pipelineLayout;
 	}
 
+	inline auto VulkanRenderPipelineLayout::GetStats() const -> const Stats&
+	{
+		return m_stats;
+	}
+
 	inline void VulkanRenderPipelineLayout::TryToShrink()
 	{
+		// Released pools are kept as holes to preserve pool indices of live bindings, trailing ones can be removed
 		std::size_t poolCount = m_descriptorPools.size();
-		if (poolCount >= 2 && m_descriptorPools.back().freeBindings.TestAll())
-		{
-			for (std::size_t i = poolCount - 1; i > 0; --i)
-			{
-				if (!m_descriptorPools[i].freeBindings.TestAll())
-					break;
-
-				poolCount--;
-			}
+		while (poolCount > 0 && !m_descriptorPools[poolCount - 1].descriptorPool)
+			poolCount--;
 
-			m_descriptorPools.resize(poolCount);
-		}
+		m_descriptorPools.resize(poolCount);
 	}
 }
 
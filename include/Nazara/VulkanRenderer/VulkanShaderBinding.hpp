@@ -17,8 +17,10 @@ namespace Nz
 
 	class NAZARA_VULKANRENDERER_API VulkanShaderBinding : public ShaderBinding
 	{
+		friend VulkanRenderPipelineLayout;
+
 		public:
-			inline VulkanShaderBinding(VulkanRenderPipelineLayout& owner, std::size_t poolIndex, std::size_t bindingIndex, Vk::DescriptorSet descriptorSet);
+			inline VulkanShaderBinding(VulkanRenderPipelineLayout& owner, std::size_t poolIndex, std::size_t bindingIndex, UInt32 setIndex, Vk::DescriptorSet descriptorSet);
 			VulkanShaderBinding(const VulkanShaderBinding&) = delete;
 			VulkanShaderBinding(VulkanShaderBinding&&) = delete;
 			~VulkanShaderBinding() = default;
@@ -27,6 +29,7 @@ namespace Nz
 			inline const Vk::DescriptorSet& GetDescriptorSet() const;
 			inline std::size_t GetPoolIndex() const;
 			inline const VulkanRenderPipelineLayout& GetOwner() const;
+			inline UInt32 GetSetIndex() const;
 
 			void Update(const Binding* bindings, std::size_t bindingCount) override;
 
@@ -42,6 +45,7 @@ namespace Nz
 			VulkanRenderPipelineLayout& m_owner;
 			std::size_t m_bindingIndex;
 			std::size_t m_poolIndex;
+			UInt32 m_setIndex;
 	};
 }
 
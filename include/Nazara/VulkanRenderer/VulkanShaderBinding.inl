@@ -6,11 +6,12 @@
 
 namespace Nz
 {
-	inline VulkanShaderBinding::VulkanShaderBinding(VulkanRenderPipelineLayout& owner, std::size_t poolIndex, std::size_t bindingIndex, Vk::DescriptorSet descriptorSet) :
+	inline VulkanShaderBinding::VulkanShaderBinding(VulkanRenderPipelineLayout& owner, std::size_t poolIndex, std::size_t bindingIndex, UInt32 setIndex, Vk::DescriptorSet descriptorSet) :
 	m_descriptorSet(std::move(descriptorSet)),
 	m_owner(owner),
 	m_bindingIndex(bindingIndex),
-	m_poolIndex(poolIndex)
+	m_poolIndex(poolIndex),
+	m_setIndex(setIndex)
 	{
 	}
 
@@ -33,6 +34,11 @@ namespace Nz
 	{
 		return m_owner;
 	}
+
+	inline UInt32 VulkanShaderBinding::GetSetIndex() const
+	{
+		return m_setIndex;
+	}
 }
 
 #include <Nazara/VulkanRenderer/DebugOff.hpp>
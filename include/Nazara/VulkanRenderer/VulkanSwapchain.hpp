@@ -46,11 +46,14 @@ namespace Nz
 
 			std::shared_ptr<CommandPool> CreateCommandPool(QueueType queueType) override;
 
+			inline Vk::QueueHandle& GetComputeQueue();
 			const VulkanWindowFramebuffer& GetFramebuffer(std::size_t i) const override;
 			std::size_t GetFramebufferCount() const override;
 			inline VulkanDevice& GetDevice();
+			FramePacing GetFramePacing() const override;
 			inline const VulkanDevice& GetDevice() const;
 			inline Vk::QueueHandle& GetGraphicsQueue();
+			std::optional<Time> GetLastPresentLatency() const override;
 			const VulkanRenderPass& GetRenderPass() const override;
 			const Vector2ui& GetSize() const override;
 			PresentMode GetPresentMode() const override;
@@ -65,6 +68,8 @@ namespace Nz
 
 			TransientResources& Transient() override;
 
+			void WaitForFrame() override;
+
 			VulkanSwapchain& operator=(const VulkanSwapchain&) = delete;
 			VulkanSwapchain& operator=(VulkanSwapchain&&) = delete;
 
@@ -75,26 +80,38 @@ namespace Nz
 			bool SetupRenderPass();
 			bool SetupSurface(WindowHandle windowHandle);
 			bool SetupSwapchain(const Vk::PhysicalDevice& deviceInfo);
+			void WaitForPresent(UInt64 presentId);
+
+			static constexpr UInt64 PresentWaitTimeout = 100'000'000; //< 100ms, to never stall the application if the presentation engine doesn't report a presentation
 
 			std::optional<VulkanRenderPass> m_renderPass;
 			std::size_t m_currentFrame;
 			std::vector<VulkanWindowFramebuffer> m_framebuffers;
 			std::vector<Vk::Fence*> m_inflightFences;
 			std::vector<std::unique_ptr<VulkanRenderImage>> m_concurrentImageData;
+			std::vector<Time> m_frameSampleTimes; //< time at which each frame started (indexed by present id modulo size)
+			std::optional<Time> m_lastPresentLatency;
 			Vk::DeviceMemory m_depthBufferMemory;
 			Vk::Image m_depthBuffer;
 			Vk::ImageView m_depthBufferView;
+			Vk::QueueHandle m_computeQueue;
 			Vk::QueueHandle m_graphicsQueue;
 			Vk::QueueHandle m_presentQueue;
 			Vk::QueueHandle m_transferQueue;
 			Vk::Surface m_surface;
 			Vk::Swapchain m_swapchain;
+			FramePacing m_framePacing;
 			PresentMode m_presentMode;
 			PresentModeFlags m_supportedPresentModes;
+			UInt32 m_requestedFramesInFlight;
+			UInt64 m_firstPresentId; //< last present id of the previous swapchain (ids from the current one are greater)
+			UInt64 m_lastPresentId;
 			Vector2ui m_swapchainSize;
 			VkFormat m_depthStencilFormat;
 			VkSurfaceFormatKHR m_surfaceFormat;
 			VulkanDevice& m_device;
+			bool m_hasWaitedForFrame;
+			bool m_isPresentWaitSupported;
 			bool m_shouldRecreateSwapchain;
 	};
 }
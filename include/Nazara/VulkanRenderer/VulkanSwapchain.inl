@@ -6,6 +6,11 @@
 
 namespace Nz
 {
+	inline Vk::QueueHandle& VulkanSwapchain::GetComputeQueue()
+	{
+		return m_computeQueue;
+	}
+
 	inline VulkanDevice& VulkanSwapchain::GetDevice()
 	{
 		return m_device;
@@ -52,9 +52,12 @@ namespace Nz
 			inline const TextureInfo& GetTextureInfo() const override;
 			inline ImageType GetType() const override;
 
+			bool Relocate(Vk::CommandBuffer& commandBuffer, VmaAllocation allocation, VkImage& previousImage, Vk::ImageView& previousImageView);
+
 			using Texture::Update;
 			bool Update(const void* ptr, const Boxui& box, unsigned int srcWidth, unsigned int srcHeight, UInt8 level) override;
 			bool Update(Vk::CommandBuffer& commandBuffer, std::unique_ptr<VulkanBuffer>& uploadBuffer, const void* ptr, const Boxui& box, unsigned int srcWidth, unsigned int srcHeight, UInt8 level);
+			bool UpdateRegions(const void* pixels, const UpdateRegion* regions, std::size_t regionCount) override;
 
 			void UpdateDebugName(std::string_view name) override;
 
@@ -69,10 +72,13 @@ namespace Nz
 			VulkanDevice& m_device;
 			VkImage m_image;
 			VkImageSubresourceRange m_subresourceRange;
+			VkImageCreateInfo m_imageCreateInfo;
+			VkImageViewCreateInfo m_imageViewCreateInfo;
 			VmaAllocation m_allocation;
 			Vk::ImageView m_imageView;
 			TextureInfo m_textureInfo;
 			TextureInfo m_textureViewInfo;
+			bool m_isRelocatable;
 	};
 }
 
@@ -48,6 +48,7 @@ namespace Nz
 			{
 				Vk::DeviceMemory blockMemory;
 				Vk::Buffer buffer;
+				std::size_t unusedResetCount = 0;
 				UInt64 freeOffset = 0;
 				UInt64 size;
 			};
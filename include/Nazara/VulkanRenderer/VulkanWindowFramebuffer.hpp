@@ -15,7 +15,7 @@ namespace Nz
 	class NAZARA_VULKANRENDERER_API VulkanWindowFramebuffer final : public VulkanFramebuffer
 	{
 		public:
-			inline VulkanWindowFramebuffer(Vk::Framebuffer framebuffer);
+			inline VulkanWindowFramebuffer(Vk::Framebuffer framebuffer, std::vector<Attachment> attachments);
 			VulkanWindowFramebuffer(const VulkanWindowFramebuffer&) = delete;
 			VulkanWindowFramebuffer(VulkanWindowFramebuffer&&) noexcept = default;
 			~VulkanWindowFramebuffer() = default;
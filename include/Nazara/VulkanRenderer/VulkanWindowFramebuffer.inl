@@ -6,10 +6,11 @@
 
 namespace Nz
 {
-	inline VulkanWindowFramebuffer::VulkanWindowFramebuffer(Vk::Framebuffer framebuffer) :
+	inline VulkanWindowFramebuffer::VulkanWindowFramebuffer(Vk::Framebuffer framebuffer, std::vector<Attachment> attachments) :
 	VulkanFramebuffer(FramebufferType::Window),
 	m_framebuffer(std::move(framebuffer))
 	{
+		m_attachments = std::move(attachments);
 	}
 
 	inline Vk::Framebuffer& VulkanWindowFramebuffer::GetFramebuffer()
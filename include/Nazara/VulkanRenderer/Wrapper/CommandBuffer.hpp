@@ -36,6 +36,7 @@ namespace Nz::Vk
 			inline void BeginDebugRegion(const char* label);
 			inline void BeginDebugRegion(const char* label, Color color);
 			inline void BeginRenderPass(const VkRenderPassBeginInfo& beginInfo, VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE);
+			inline void BeginRendering(const VkRenderingInfo& renderingInfo);
 
 			inline void BindDescriptorSet(VkPipelineBindPoint pipelineBindPoint, VkPipelineLayout layout, UInt32 firstSet, const VkDescriptorSet& descriptorSets);
 			inline void BindDescriptorSets(VkPipelineBindPoint pipelineBindPoint, VkPipelineLayout layout, UInt32 firstSet, UInt32 descriptorSetCount, const VkDescriptorSet* descriptorSets);
@@ -70,11 +71,14 @@ namespace Nz::Vk
 
 			inline void Draw(UInt32 vertexCount, UInt32 instanceCount = 1, UInt32 firstVertex = 0, UInt32 firstInstance = 0);
 			inline void DrawIndexed(UInt32 indexCount, UInt32 instanceCount = 1, UInt32 firstVertex = 0, Int32 vertexOffset = 0, UInt32 firstInstance = 0);
+			inline void DrawIndexedIndirect(VkBuffer buffer, VkDeviceSize offset, UInt32 drawCount, UInt32 stride);
+			inline void DrawIndexedIndirectCount(VkBuffer buffer, VkDeviceSize offset, VkBuffer countBuffer, VkDeviceSize countBufferOffset, UInt32 maxDrawCount, UInt32 stride);
 
 			inline bool End();
 
 			inline void EndDebugRegion();
 			inline void EndRenderPass();
+			inline void EndRendering();
 
 			inline void Free();
 
@@ -82,6 +86,7 @@ namespace Nz::Vk
 			inline CommandPool& GetPool();
 
 			inline void ImageBarrier(VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, VkDependencyFlags dependencyFlags, VkAccessFlags srcAccessMask, VkAccessFlags dstAccessMask, VkImageLayout oldLayout, VkImageLayout newLayout, VkImage image, const VkImageSubresourceRange& subresourceRange);
+			inline void ImageBarrier(VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, VkDependencyFlags dependencyFlags, VkAccessFlags srcAccessMask, VkAccessFlags dstAccessMask, VkImageLayout oldLayout, VkImageLayout newLayout, UInt32 srcQueueFamilyIndex, UInt32 dstQueueFamilyIndex, VkImage image, const VkImageSubresourceRange& subresourceRange);
 
 			inline void InsertDebugLabel(const char* label);
 			inline void InsertDebugLabel(const char* label, Color color);
@@ -94,6 +99,8 @@ namespace Nz::Vk
 			inline void PipelineBarrier(VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, VkDependencyFlags dependencyFlags, const VkMemoryBarrier& memoryBarrier);
 			inline void PipelineBarrier(VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, VkDependencyFlags dependencyFlags, UInt32 memoryBarrierCount, const VkMemoryBarrier* memoryBarriers, UInt32 bufferMemoryBarrierCount, const VkBufferMemoryBarrier* bufferMemoryBarriers, UInt32 imageMemoryBarrierCount, const VkImageMemoryBarrier* imageMemoryBarriers);
 
+			inline void PushConstants(VkPipelineLayout layout, VkShaderStageFlags stageFlags, UInt32 offset, UInt32 size, const void* values);
+
 			inline void SetScissor(const Recti& scissorRegion);
 			inline void SetScissor(const VkRect2D& scissorRegion);
 			inline void SetScissor(UInt32 firstScissor, UInt32 scissorCount, const VkRect2D* scissors);
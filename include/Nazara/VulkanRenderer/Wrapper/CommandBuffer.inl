@@ -148,6 +148,11 @@ namespace Nz
 			return m_pool->GetDevice()->vkCmdBeginRenderPass(m_handle, &beginInfo, contents);
 		}
 
+		inline void CommandBuffer::BeginRendering(const VkRenderingInfo& renderingInfo)
+		{
+			return m_pool->GetDevice()->vkCmdBeginRendering(m_handle, &renderingInfo);
+		}
+
 		inline void CommandBuffer::BindDescriptorSet(VkPipelineBindPoint pipelineBindPoint, VkPipelineLayout layout, UInt32 firstSet, const VkDescriptorSet& descriptorSets)
 		{
 			return BindDescriptorSets(pipelineBindPoint, layout, firstSet, 1U, &descriptorSets);
@@ -316,6 +321,16 @@ namespace Nz
 			return m_pool->GetDevice()->vkCmdDrawIndexed(m_handle, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
 		}
 
+		inline void CommandBuffer::DrawIndexedIndirect(VkBuffer buffer, VkDeviceSize offset, UInt32 drawCount, UInt32 stride)
+		{
+			return m_pool->GetDevice()->vkCmdDrawIndexedIndirect(m_handle, buffer, offset, drawCount, stride);
+		}
+
+		inline void CommandBuffer::DrawIndexedIndirectCount(VkBuffer buffer, VkDeviceSize offset, VkBuffer countBuffer, VkDeviceSize countBufferOffset, UInt32 maxDrawCount, UInt32 stride)
+		{
+			return m_pool->GetDevice()->vkCmdDrawIndexedIndirectCount(m_handle, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+		}
+
 		inline bool CommandBuffer::End()
 		{
 			m_lastErrorCode = m_pool->GetDevice()->vkEndCommandBuffer(m_handle);
@@ -340,6 +355,11 @@ namespace Nz
 			return m_pool->GetDevice()->vkCmdEndRenderPass(m_handle);
 		}
 
+		inline void CommandBuffer::EndRendering()
+		{
+			return m_pool->GetDevice()->vkCmdEndRendering(m_handle);
+		}
+
 		inline void CommandBuffer::Free()
 		{
 			if (m_handle)
@@ -360,6 +380,11 @@ namespace Nz
 		}
 
 		inline void CommandBuffer::ImageBarrier(VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, VkDependencyFlags dependencyFlags, VkAccessFlags srcAccessMask, VkAccessFlags dstAccessMask, VkImageLayout oldLayout, VkImageLayout newLayout, VkImage image, const VkImageSubresourceRange& subresourceRange)
+		{
+			return ImageBarrier(srcStageMask, dstStageMask, dependencyFlags, srcAccessMask, dstAccessMask, oldLayout, newLayout, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, image, subresourceRange);
+		}
+
+		inline void CommandBuffer::ImageBarrier(VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, VkDependencyFlags dependencyFlags, VkAccessFlags srcAccessMask, VkAccessFlags dstAccessMask, VkImageLayout oldLayout, VkImageLayout newLayout, UInt32 srcQueueFamilyIndex, UInt32 dstQueueFamilyIndex, VkImage image, const VkImageSubresourceRange& subresourceRange)
 		{
 			VkImageMemoryBarrier imageBarrier = {
 				VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
@@ -368,8 +393,8 @@ namespace Nz
 				dstAccessMask,
 				oldLayout,
 				newLayout,
-				VK_QUEUE_FAMILY_IGNORED,
-				VK_QUEUE_FAMILY_IGNORED,
+				srcQueueFamilyIndex,
+				dstQueueFamilyIndex,
 				image,
 				subresourceRange
 			};
@@ -435,6 +460,11 @@ namespace Nz
 			return m_pool->GetDevice()->vkCmdPipelineBarrier(m_handle, srcStageMask, dstStageMask, dependencyFlags, memoryBarrierCount, memoryBarriers, bufferMemoryBarrierCount, bufferMemoryBarriers, imageMemoryBarrierCount, imageMemoryBarriers);
 		}
 
+		inline void CommandBuffer::PushConstants(VkPipelineLayout layout, VkShaderStageFlags stageFlags, UInt32 offset, UInt32 size, const void* values)
+		{
+			return m_pool->GetDevice()->vkCmdPushConstants(m_handle, layout, stageFlags, offset, size, values);
+		}
+
 		inline void CommandBuffer::SetScissor(const Recti& scissorRegion)
 		{
 			VkRect2D rect = {
@@ -21,6 +21,7 @@
 
 VK_DEFINE_HANDLE(VmaAllocator)
 VK_DEFINE_HANDLE(VmaAllocation)
+VK_DEFINE_HANDLE(VmaPool)
 
 namespace Nz 
 {
@@ -35,6 +36,7 @@ namespace Nz
 		class NAZARA_VULKANRENDERER_API Device : public std::enable_shared_from_this<Device>
 		{
 			public:
+				enum class MemoryPool;
 				struct QueueFamilyInfo;
 				struct QueueInfo;
 				using QueueList = std::vector<QueueInfo>;
@@ -57,13 +59,18 @@ namespace Nz
 				inline const Instance& GetInstance() const;
 				inline VkResult GetLastErrorCode() const;
 				inline VmaAllocator GetMemoryAllocator() const;
+				VmaPool GetMemoryPool(MemoryPool memoryPool, UInt32 memoryTypeIndex);
 				inline VkPhysicalDevice GetPhysicalDevice() const;
 				inline const Vk::PhysicalDevice& GetPhysicalDeviceInfo() const;
 				inline PFN_vkVoidFunction GetProcAddr(const char* name, bool allowInstanceFallback);
 				QueueHandle GetQueue(UInt32 queueFamilyIndex, UInt32 queueIndex);
 
+				VmaPool FindMemoryPool(MemoryPool memoryPool, UInt32 memoryTypeIndex) const;
+
+				inline bool IsDynamicRenderingEnabled() const;
 				inline bool IsExtensionLoaded(const std::string& extensionName);
 				inline bool IsLayerLoaded(const std::string& layerName);
+				inline bool IsTimelineSemaphoreEnabled() const;
 
 				inline void SetDebugName(VkObjectType objectType, UInt64 objectHandle, const char* name);
 				inline void SetDebugName(VkObjectType objectType, UInt64 objectHandle, std::string_view name);
@@ -82,6 +89,16 @@ namespace Nz
 
 #include <Nazara/VulkanRenderer/Wrapper/DeviceFunctions.hpp>
 
+				// Usage classes getting their own VMA pools, to keep their allocations (and fragmentation) apart from other resources
+				enum class MemoryPool
+				{
+					StreamedTextures,
+					TransientAttachments,
+					UniformBuffers,
+
+					Max = UniformBuffers
+				};
+
 				struct QueueFamilyInfo
 				{
 					QueueList queues;
@@ -118,6 +135,8 @@ namespace Nz
 				VkDevice m_device;
 				VkResult m_lastErrorCode;
 				VmaAllocator m_memAllocator;
+				bool m_isDynamicRenderingEnabled;
+				bool m_isTimelineSemaphoreEnabled;
 		};
 	}
 }
@@ -77,6 +77,14 @@ namespace Nz::Vk
 		return func;
 	}
 
+	/*!
+	* \brief Returns true if the dynamic rendering feature was enabled at device creation (render passes can then be replaced by vkCmdBeginRendering)
+	*/
+	inline bool Device::IsDynamicRenderingEnabled() const
+	{
+		return m_isDynamicRenderingEnabled;
+	}
+
 	inline bool Device::IsExtensionLoaded(const std::string& extensionName)
 	{
 		return m_loadedExtensions.count(extensionName) > 0;
@@ -87,6 +95,14 @@ namespace Nz::Vk
 		return m_loadedLayers.count(layerName) > 0;
 	}
 
+	/*!
+	* \brief Returns true if the timeline semaphore feature was enabled at device creation (from Vulkan 1.2 or VK_KHR_timeline_semaphore)
+	*/
+	inline bool Device::IsTimelineSemaphoreEnabled() const
+	{
+		return m_isTimelineSemaphoreEnabled;
+	}
+
 	inline void Device::SetDebugName(VkObjectType objectType, UInt64 objectHandle, const char* name)
 	{
 		if (vkSetDebugUtilsObjectNameEXT)
@@ -131,6 +131,7 @@ NAZARA_VULKANRENDERER_DEVICE_FUNCTION(vkGetFenceStatus)
 NAZARA_VULKANRENDERER_DEVICE_FUNCTION(vkGetImageMemoryRequirements)
 NAZARA_VULKANRENDERER_DEVICE_FUNCTION(vkGetImageSparseMemoryRequirements)
 NAZARA_VULKANRENDERER_DEVICE_FUNCTION(vkGetImageSubresourceLayout)
+NAZARA_VULKANRENDERER_DEVICE_FUNCTION(vkGetPipelineCacheData)
 NAZARA_VULKANRENDERER_DEVICE_FUNCTION(vkGetRenderAreaGranularity)
 NAZARA_VULKANRENDERER_DEVICE_FUNCTION(vkInvalidateMappedMemoryRanges)
 NAZARA_VULKANRENDERER_DEVICE_FUNCTION(vkMapMemory)
@@ -153,6 +154,14 @@ NAZARA_VULKANRENDERER_DEVICE_CORE_EXT_FUNCTION(vkBindImageMemory2, VK_API_VERSIO
 NAZARA_VULKANRENDERER_DEVICE_CORE_EXT_FUNCTION(vkGetBufferMemoryRequirements2, VK_API_VERSION_1_1, KHR, get_memory_requirements2)
 NAZARA_VULKANRENDERER_DEVICE_CORE_EXT_FUNCTION(vkGetImageMemoryRequirements2, VK_API_VERSION_1_1, KHR, get_memory_requirements2)
 
+NAZARA_VULKANRENDERER_DEVICE_CORE_EXT_FUNCTION(vkCmdDrawIndexedIndirectCount, VK_API_VERSION_1_2, KHR, draw_indirect_count)
+NAZARA_VULKANRENDERER_DEVICE_CORE_EXT_FUNCTION(vkCmdDrawIndirectCount, VK_API_VERSION_1_2, KHR, draw_indirect_count)
+
+NAZARA_VULKANRENDERER_DEVICE_CORE_EXT_FUNCTION(vkGetSemaphoreCounterValue, VK_API_VERSION_1_2, KHR, timeline_semaphore)
+
+NAZARA_VULKANRENDERER_DEVICE_CORE_EXT_FUNCTION(vkCmdBeginRendering, VK_API_VERSION_1_3, KHR, dynamic_rendering)
+NAZARA_VULKANRENDERER_DEVICE_CORE_EXT_FUNCTION(vkCmdEndRendering, VK_API_VERSION_1_3, KHR, dynamic_rendering)
+
 NAZARA_VULKANRENDERER_DEVICE_CORE_EXT_FUNCTION(vkGetDeviceBufferMemoryRequirements, VK_API_VERSION_1_3, KHR, maintenance4)
 NAZARA_VULKANRENDERER_DEVICE_CORE_EXT_FUNCTION(vkGetDeviceImageMemoryRequirements, VK_API_VERSION_1_3, KHR, maintenance4)
 
@@ -160,6 +169,10 @@ NAZARA_VULKANRENDERER_DEVICE_EXT_BEGIN(VK_KHR_display_swapchain)
 	NAZARA_VULKANRENDERER_DEVICE_FUNCTION(vkCreateSharedSwapchainsKHR)
 NAZARA_VULKANRENDERER_DEVICE_EXT_END()
 
+NAZARA_VULKANRENDERER_DEVICE_EXT_BEGIN(VK_KHR_present_wait)
+	NAZARA_VULKANRENDERER_DEVICE_FUNCTION(vkWaitForPresentKHR)
+NAZARA_VULKANRENDERER_DEVICE_EXT_END()
+
 NAZARA_VULKANRENDERER_DEVICE_EXT_BEGIN(VK_KHR_surface)
 	NAZARA_VULKANRENDERER_DEVICE_FUNCTION(vkDestroySurfaceKHR)
 	NAZARA_VULKANRENDERER_DEVICE_FUNCTION(vkGetPhysicalDeviceSurfaceCapabilitiesKHR)
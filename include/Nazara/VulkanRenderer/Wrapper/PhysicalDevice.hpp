@@ -17,9 +17,13 @@ namespace Nz::Vk
 	struct PhysicalDevice
 	{
 		VkPhysicalDevice physDevice;
+		VkPhysicalDeviceDynamicRenderingFeatures dynamicRenderingFeatures; //< only queried on Vulkan 1.3 devices or if VK_KHR_dynamic_rendering is supported, zero-initialized otherwise
 		VkPhysicalDeviceFeatures features;
 		VkPhysicalDeviceMemoryProperties memoryProperties;
+		VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures; //< only queried if VK_KHR_present_id is supported, zero-initialized otherwise
+		VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures; //< only queried if VK_KHR_present_wait is supported, zero-initialized otherwise
 		VkPhysicalDeviceProperties properties;
+		VkPhysicalDeviceVulkan12Features vulkan12Features; //< only queried on Vulkan 1.2 devices, zero-initialized otherwise
 		std::unordered_set<std::string> extensions;
 		std::vector<VkQueueFamilyProperties> queueFamilies;
 	};
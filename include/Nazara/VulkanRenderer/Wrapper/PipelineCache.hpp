@@ -9,6 +9,7 @@
 
 #include <NazaraUtils/Prerequisites.hpp>
 #include <Nazara/VulkanRenderer/Wrapper/DeviceObject.hpp>
+#include <vector>
 
 namespace Nz 
 {
@@ -24,6 +25,8 @@ namespace Nz
 				PipelineCache(PipelineCache&&) = default;
 				~PipelineCache() = default;
 
+				inline bool GetData(std::vector<UInt8>* data) const;
+
 				PipelineCache& operator=(const PipelineCache&) = delete;
 				PipelineCache& operator=(PipelineCache&&) = delete;
 
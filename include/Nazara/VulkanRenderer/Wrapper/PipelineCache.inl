@@ -2,12 +2,39 @@
 // This file is part of the "Nazara Engine - Vulkan renderer"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/VulkanRenderer/Utils.hpp>
+#include <Nazara/VulkanRenderer/Wrapper/Device.hpp>
 #include <Nazara/VulkanRenderer/Debug.hpp>
 
 namespace Nz
 {
 	namespace Vk
 	{
+		inline bool PipelineCache::GetData(std::vector<UInt8>* data) const
+		{
+			assert(data);
+
+			std::size_t dataSize = 0;
+			m_lastErrorCode = m_device->vkGetPipelineCacheData(*m_device, m_handle, &dataSize, nullptr);
+			if (m_lastErrorCode != VkResult::VK_SUCCESS)
+			{
+				NazaraError("failed to query pipeline cache data size: {0}", TranslateVulkanError(m_lastErrorCode));
+				return false;
+			}
+
+			data->resize(dataSize);
+			m_lastErrorCode = m_device->vkGetPipelineCacheData(*m_device, m_handle, &dataSize, data->data());
+			if (m_lastErrorCode != VkResult::VK_SUCCESS && m_lastErrorCode != VkResult::VK_INCOMPLETE)
+			{
+				NazaraError("failed to query pipeline cache data: {0}", TranslateVulkanError(m_lastErrorCode));
+				return false;
+			}
+
+			data->resize(dataSize);
+			return true;
+		}
+
 		inline VkResult PipelineCache::CreateHelper(Device& device, const VkPipelineCacheCreateInfo* createInfo, const VkAllocationCallbacks* allocator, VkPipelineCache* handle)
 		{
 			return device.vkCreatePipelineCache(device, createInfo, allocator, handle);
@@ -27,6 +27,7 @@ namespace Nz
 				using DeviceObject::Create;
 				bool Create(Device& device, VkDescriptorSetLayout layout, VkPipelineLayoutCreateFlags flags = 0);
 				bool Create(Device& device, UInt32 layoutCount, const VkDescriptorSetLayout* layouts, VkPipelineLayoutCreateFlags flags = 0);
+				bool Create(Device& device, UInt32 layoutCount, const VkDescriptorSetLayout* layouts, UInt32 pushConstantRangeCount, const VkPushConstantRange* pushConstantRanges, VkPipelineLayoutCreateFlags flags = 0);
 
 				PipelineLayout& operator=(const PipelineLayout&) = delete;
 				PipelineLayout& operator=(PipelineLayout&&) = delete;
@@ -14,6 +14,11 @@ namespace Nz
 		}
 
 		inline bool PipelineLayout::Create(Device& device, UInt32 layoutCount, const VkDescriptorSetLayout* layouts, VkPipelineLayoutCreateFlags flags)
+		{
+			return Create(device, layoutCount, layouts, 0U, nullptr, flags);
+		}
+
+		inline bool PipelineLayout::Create(Device& device, UInt32 layoutCount, const VkDescriptorSetLayout* layouts, UInt32 pushConstantRangeCount, const VkPushConstantRange* pushConstantRanges, VkPipelineLayoutCreateFlags flags)
 		{
 			VkPipelineLayoutCreateInfo createInfo = {
 				VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
@@ -21,8 +26,8 @@ namespace Nz
 				flags,
 				layoutCount,
 				layouts,
-				0U,
-				nullptr
+				pushConstantRangeCount,
+				pushConstantRanges
 			};
 
 			return Create(device, createInfo);
@@ -26,6 +26,9 @@ namespace Nz
 
 				using DeviceObject::Create;
 				inline bool Create(Device& device, VkSemaphoreCreateFlags flags = 0, const VkAllocationCallbacks* allocator = nullptr);
+				inline bool CreateTimeline(Device& device, UInt64 initialValue = 0, const VkAllocationCallbacks* allocator = nullptr);
+
+				inline bool GetCounterValue(UInt64* value) const;
 
 				Semaphore& operator=(const Semaphore&) = delete;
 				Semaphore& operator=(Semaphore&&) = delete;
@@ -20,6 +20,38 @@ namespace Nz
 			return Create(device, createInfo, allocator);
 		}
 
+		inline bool Semaphore::CreateTimeline(Device& device, UInt64 initialValue, const VkAllocationCallbacks* allocator)
+		{
+			VkSemaphoreTypeCreateInfo typeCreateInfo =
+			{
+				VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+				nullptr,
+				VK_SEMAPHORE_TYPE_TIMELINE,
+				initialValue
+			};
+
+			VkSemaphoreCreateInfo createInfo =
+			{
+				VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+				&typeCreateInfo,
+				0
+			};
+
+			return Create(device, createInfo, allocator);
+		}
+
+		inline bool Semaphore::GetCounterValue(UInt64* value) const
+		{
+			m_lastErrorCode = m_device->vkGetSemaphoreCounterValue(*m_device, m_handle, value);
+			if (m_lastErrorCode != VK_SUCCESS)
+			{
+				NazaraError("failed to query semaphore counter value: {0}", TranslateVulkanError(m_lastErrorCode));
+				return false;
+			}
+
+			return true;
+		}
+
 		inline VkResult Semaphore::CreateHelper(Device& device, const VkSemaphoreCreateInfo* createInfo, const VkAllocationCallbacks* allocator, VkSemaphore* handle)
 		{
 			return device.vkCreateSemaphore(device, createInfo, allocator, handle);
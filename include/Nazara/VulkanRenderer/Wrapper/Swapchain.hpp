@@ -37,6 +37,8 @@ namespace Nz
 
 				inline bool IsSupported() const;
 
+				inline bool WaitForPresent(UInt64 presentId, UInt64 timeout) const;
+
 				Swapchain& operator=(const Swapchain&) = delete;
 				Swapchain& operator=(Swapchain&&) = default;
 
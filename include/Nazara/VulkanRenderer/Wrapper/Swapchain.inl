@@ -109,6 +109,24 @@ namespace Nz
 			return true;
 		}
 
+		inline bool Swapchain::WaitForPresent(UInt64 presentId, UInt64 timeout) const
+		{
+			m_lastErrorCode = m_device->vkWaitForPresentKHR(*m_device, m_handle, presentId, timeout);
+			switch (m_lastErrorCode)
+			{
+				case VkResult::VK_SUBOPTIMAL_KHR:
+				case VkResult::VK_SUCCESS:
+				case VkResult::VK_TIMEOUT:
+					return true;
+
+				default:
+				{
+					NazaraError("failed to wait for swapchain presentation: {0}", TranslateVulkanError(m_lastErrorCode));
+					return false;
+				}
+			}
+		}
+
 		inline VkResult Swapchain::CreateHelper(Device& device, const VkSwapchainCreateInfoKHR* createInfo, const VkAllocationCallbacks* allocator, VkSwapchainKHR* handle)
 		{
 			return device.vkCreateSwapchainKHR(device, createInfo, allocator, handle);
@@ -0,0 +1,53 @@
+// this file was automatically generated and should not be edited
+
+/*
+	Nazara Engine - WebGPU renderer
+
+	Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to
+	use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+	of the Software, and to permit persons to whom the Software is furnished to do
+	so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+#pragma once
+
+#ifndef NAZARA_GLOBAL_WEBGPURENDERER_HPP
+#define NAZARA_GLOBAL_WEBGPURENDERER_HPP
+
+#include <Nazara/WebGPURenderer/Config.hpp>
+#include <Nazara/WebGPURenderer/Utils.hpp>
+#include <Nazara/WebGPURenderer/WebGPUBuffer.hpp>
+#include <Nazara/WebGPURenderer/WebGPUCommandBuffer.hpp>
+#include <Nazara/WebGPURenderer/WebGPUCommandBufferBuilder.hpp>
+#include <Nazara/WebGPURenderer/WebGPUCommandPool.hpp>
+#include <Nazara/WebGPURenderer/WebGPUComputePipeline.hpp>
+#include <Nazara/WebGPURenderer/WebGPUDevice.hpp>
+#include <Nazara/WebGPURenderer/WebGPUFramebuffer.hpp>
+#include <Nazara/WebGPURenderer/WebGPURenderer.hpp>
+#include <Nazara/WebGPURenderer/WebGPURenderImage.hpp>
+#include <Nazara/WebGPURenderer/WebGPURenderPass.hpp>
+#include <Nazara/WebGPURenderer/WebGPURenderPipeline.hpp>
+#include <Nazara/WebGPURenderer/WebGPURenderPipelineLayout.hpp>
+#include <Nazara/WebGPURenderer/WebGPUShaderBinding.hpp>
+#include <Nazara/WebGPURenderer/WebGPUShaderModule.hpp>
+#include <Nazara/WebGPURenderer/WebGPUSwapchain.hpp>
+#include <Nazara/WebGPURenderer/WebGPUTexture.hpp>
+#include <Nazara/WebGPURenderer/WebGPUTextureSampler.hpp>
+#include <Nazara/WebGPURenderer/WebGPUUploadPool.hpp>
+
+#endif // NAZARA_GLOBAL_WEBGPURENDERER_HPP
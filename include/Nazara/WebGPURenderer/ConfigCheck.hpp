@@ -0,0 +1,12 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_WEBGPURENDERER_CONFIGCHECK_HPP
+#define NAZARA_WEBGPURENDERER_CONFIGCHECK_HPP
+
+/// This file is used to check the constant values defined in Config.hpp
+
+#endif // NAZARA_WEBGPURENDERER_CONFIGCHECK_HPP
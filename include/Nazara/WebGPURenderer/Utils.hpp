@@ -0,0 +1,52 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_WEBGPURENDERER_UTILS_HPP
+#define NAZARA_WEBGPURENDERER_UTILS_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Renderer/Enums.hpp>
+#include <Nazara/Utility/Enums.hpp>
+#include <NZSL/Enums.hpp>
+#include <webgpu/webgpu.h>
+#include <optional>
+
+namespace Nz
+{
+	inline std::optional<PixelFormat> FromWebGPU(WGPUTextureFormat format);
+
+	inline WGPULoadOp ToWebGPU(AttachmentLoadOp loadOp);
+	inline WGPUStoreOp ToWebGPU(AttachmentStoreOp storeOp);
+	inline WGPUBlendOperation ToWebGPU(BlendEquation blendEquation);
+	inline WGPUBlendFactor ToWebGPU(BlendFunc blendFunc);
+	inline WGPUBufferUsageFlags ToWebGPU(BufferType bufferType);
+	inline WGPUVertexFormat ToWebGPU(ComponentType componentType);
+	inline WGPUCullMode ToWebGPU(FaceCulling faceSide);
+	inline WGPUFrontFace ToWebGPU(FrontFace frontFace);
+	inline WGPUTextureDimension ToWebGPU(ImageType imageType);
+	inline WGPUIndexFormat ToWebGPU(IndexType indexType);
+	inline WGPUTextureFormat ToWebGPU(PixelFormat pixelFormat);
+	inline WGPUTextureAspect ToWebGPU(PixelFormatContent pixelFormatContent);
+	inline WGPUPresentMode ToWebGPU(PresentMode presentMode);
+	inline WGPUPrimitiveTopology ToWebGPU(PrimitiveMode primitiveMode);
+	inline WGPUCompareFunction ToWebGPU(RendererComparison comparison);
+	inline WGPUFilterMode ToWebGPU(SamplerFilter samplerFilter);
+	inline WGPUMipmapFilterMode ToWebGPU(SamplerMipmapMode samplerMipmap);
+	inline WGPUAddressMode ToWebGPU(SamplerWrap samplerWrap);
+	inline WGPUShaderStage ToWebGPU(nzsl::ShaderStageType stageType);
+	inline WGPUShaderStageFlags ToWebGPU(nzsl::ShaderStageTypeFlags stageType);
+	inline WGPUStencilOperation ToWebGPU(StencilOperation stencilOp);
+	inline WGPUStorageTextureAccess ToWebGPU(TextureAccess textureAccess);
+	inline WGPUTextureUsage ToWebGPU(TextureUsage textureUsage);
+	inline WGPUTextureUsageFlags ToWebGPU(TextureUsageFlags textureUsages);
+	inline WGPUVertexStepMode ToWebGPU(VertexInputRate inputRate);
+
+	inline WGPUTextureViewDimension ToWebGPUViewDimension(ImageType imageType);
+}
+
+#include <Nazara/WebGPURenderer/Utils.inl>
+
+#endif // NAZARA_WEBGPURENDERER_UTILS_HPP
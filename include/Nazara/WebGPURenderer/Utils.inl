@@ -0,0 +1,474 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Algorithm.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	inline std::optional<PixelFormat> FromWebGPU(WGPUTextureFormat format)
+	{
+		switch (format)
+		{
+			case WGPUTextureFormat_BGRA8Unorm:     return PixelFormat::BGRA8;
+			case WGPUTextureFormat_BGRA8UnormSrgb: return PixelFormat::BGRA8_SRGB;
+			case WGPUTextureFormat_RGBA8Unorm:     return PixelFormat::RGBA8;
+			case WGPUTextureFormat_RGBA8UnormSrgb: return PixelFormat::RGBA8_SRGB;
+			case WGPUTextureFormat_RGBA16Float:    return PixelFormat::RGBA16F;
+			default: break;
+		}
+
+		return std::nullopt;
+	}
+
+	inline WGPULoadOp ToWebGPU(AttachmentLoadOp loadOp)
+	{
+		switch (loadOp)
+		{
+			case AttachmentLoadOp::Clear:   return WGPULoadOp_Clear;
+			case AttachmentLoadOp::Discard: return WGPULoadOp_Clear; //< WebGPU has no "don't care" load operation, clearing is the cheapest option
+			case AttachmentLoadOp::Load:    return WGPULoadOp_Load;
+		}
+
+		NazaraError("unhandled AttachmentLoadOp {0:#x})", UnderlyingCast(loadOp));
+		return {};
+	}
+
+	inline WGPUStoreOp ToWebGPU(AttachmentStoreOp storeOp)
+	{
+		switch (storeOp)
+		{
+			case AttachmentStoreOp::Discard: return WGPUStoreOp_Discard;
+			case AttachmentStoreOp::Store:   return WGPUStoreOp_Store;
+		}
+
+		NazaraError("unhandled AttachmentStoreOp {0:#x})", UnderlyingCast(storeOp));
+		return {};
+	}
+
+	inline WGPUBlendOperation ToWebGPU(BlendEquation blendEquation)
+	{
+		switch (blendEquation)
+		{
+			case BlendEquation::Add:             return WGPUBlendOperation_Add;
+			case BlendEquation::Max:             return WGPUBlendOperation_Max;
+			case BlendEquation::Min:             return WGPUBlendOperation_Min;
+			case BlendEquation::ReverseSubtract: return WGPUBlendOperation_ReverseSubtract;
+			case BlendEquation::Subtract:        return WGPUBlendOperation_Subtract;
+		}
+
+		NazaraError("unhandled BlendEquation {0:#x})", UnderlyingCast(blendEquation));
+		return {};
+	}
+
+	inline WGPUBlendFactor ToWebGPU(BlendFunc blendFunc)
+	{
+		switch (blendFunc)
+		{
+			// WebGPU has a single blend constant (RGBA), alpha variants use it as well
+			case BlendFunc::ConstantAlpha:    return WGPUBlendFactor_Constant;
+			case BlendFunc::ConstantColor:    return WGPUBlendFactor_Constant;
+			case BlendFunc::DstAlpha:         return WGPUBlendFactor_DstAlpha;
+			case BlendFunc::DstColor:         return WGPUBlendFactor_Dst;
+			case BlendFunc::SrcAlpha:         return WGPUBlendFactor_SrcAlpha;
+			case BlendFunc::SrcColor:         return WGPUBlendFactor_Src;
+			case BlendFunc::InvConstantAlpha: return WGPUBlendFactor_OneMinusConstant;
+			case BlendFunc::InvConstantColor: return WGPUBlendFactor_OneMinusConstant;
+			case BlendFunc::InvDstAlpha:      return WGPUBlendFactor_OneMinusDstAlpha;
+			case BlendFunc::InvDstColor:      return WGPUBlendFactor_OneMinusDst;
+			case BlendFunc::InvSrcAlpha:      return WGPUBlendFactor_OneMinusSrcAlpha;
+			case BlendFunc::InvSrcColor:      return WGPUBlendFactor_OneMinusSrc;
+			case BlendFunc::One:              return WGPUBlendFactor_One;
+			case BlendFunc::Zero:             return WGPUBlendFactor_Zero;
+		}
+
+		NazaraError("unhandled BlendFunc {0:#x})", UnderlyingCast(blendFunc));
+		return {};
+	}
+
+	inline WGPUBufferUsageFlags ToWebGPU(BufferType bufferType)
+	{
+		// Every buffer can be the destination of a queue write (used to implement Fill and mapping)
+		switch (bufferType)
+		{
+			case BufferType::Index:   return WGPUBufferUsage_Index | WGPUBufferUsage_CopyDst | WGPUBufferUsage_CopySrc;
+			case BufferType::Storage: return WGPUBufferUsage_Storage | WGPUBufferUsage_Indirect | WGPUBufferUsage_CopyDst | WGPUBufferUsage_CopySrc; //< storage buffers can be filled by compute shaders with draw commands
+			case BufferType::Vertex:  return WGPUBufferUsage_Vertex | WGPUBufferUsage_Storage | WGPUBufferUsage_CopyDst | WGPUBufferUsage_CopySrc; //< vertex buffers can be written by compute shaders (skinning)
+			case BufferType::Uniform: return WGPUBufferUsage_Uniform | WGPUBufferUsage_CopyDst | WGPUBufferUsage_CopySrc;
+			case BufferType::Upload:  return WGPUBufferUsage_CopySrc | WGPUBufferUsage_CopyDst;
+		}
+
+		NazaraError("unhandled BufferType {0:#x})", UnderlyingCast(bufferType));
+		return 0;
+	}
+
+	inline WGPUVertexFormat ToWebGPU(ComponentType componentType)
+	{
+		switch (componentType)
+		{
+			case ComponentType::Color:     return WGPUVertexFormat_Float32x4;
+			case ComponentType::Float1:    return WGPUVertexFormat_Float32;
+			case ComponentType::Float2:    return WGPUVertexFormat_Float32x2;
+			case ComponentType::Float3:    return WGPUVertexFormat_Float32x3;
+			case ComponentType::Float4:    return WGPUVertexFormat_Float32x4;
+			case ComponentType::Int1:      return WGPUVertexFormat_Sint32;
+			case ComponentType::Int2:      return WGPUVertexFormat_Sint32x2;
+			case ComponentType::Int3:      return WGPUVertexFormat_Sint32x3;
+			case ComponentType::Int4:      return WGPUVertexFormat_Sint32x4;
+			case ComponentType::Half2:     return WGPUVertexFormat_Float16x2;
+			case ComponentType::Half4:     return WGPUVertexFormat_Float16x4;
+			case ComponentType::SNorm8x4:  return WGPUVertexFormat_Snorm8x4;
+			case ComponentType::SNorm16x2: return WGPUVertexFormat_Snorm16x2;
+			case ComponentType::SNorm16x4: return WGPUVertexFormat_Snorm16x4;
+			case ComponentType::UNorm8x4:  return WGPUVertexFormat_Unorm8x4;
+			case ComponentType::UNorm16x2: return WGPUVertexFormat_Unorm16x2;
+			case ComponentType::UNorm16x4: return WGPUVertexFormat_Unorm16x4;
+
+			// WebGPU has no 64-bit vertex format
+			case ComponentType::Double1:
+			case ComponentType::Double2:
+			case ComponentType::Double3:
+			case ComponentType::Double4:
+				break;
+		}
+
+		NazaraError("unhandled ComponentType {0:#x})", UnderlyingCast(componentType));
+		return WGPUVertexFormat_Undefined;
+	}
+
+	inline WGPUCullMode ToWebGPU(FaceCulling faceSide)
+	{
+		switch (faceSide)
+		{
+			case FaceCulling::None:  return WGPUCullMode_None;
+			case FaceCulling::Back:  return WGPUCullMode_Back;
+			case FaceCulling::Front: return WGPUCullMode_Front;
+
+			case FaceCulling::FrontAndBack:
+				break;
+		}
+
+		NazaraError("unhandled FaceCulling {0:#x})", UnderlyingCast(faceSide));
+		return {};
+	}
+
+	inline WGPUFrontFace ToWebGPU(FrontFace frontFace)
+	{
+		switch (frontFace)
+		{
+			case FrontFace::Clockwise:        return WGPUFrontFace_CW;
+			case FrontFace::CounterClockwise: return WGPUFrontFace_CCW;
+		}
+
+		NazaraError("unhandled FrontFace {0:#x})", UnderlyingCast(frontFace));
+		return {};
+	}
+
+	inline WGPUTextureDimension ToWebGPU(ImageType imageType)
+	{
+		switch (imageType)
+		{
+			case ImageType::E1D:       return WGPUTextureDimension_1D;
+			case ImageType::E1D_Array: return WGPUTextureDimension_2D; //< WebGPU has no 1D array, they're stored as 2D arrays of height 1
+			case ImageType::E2D:       return WGPUTextureDimension_2D;
+			case ImageType::E2D_Array: return WGPUTextureDimension_2D;
+			case ImageType::E3D:       return WGPUTextureDimension_3D;
+			case ImageType::Cubemap:   return WGPUTextureDimension_2D;
+		}
+
+		NazaraError("unhandled ImageType {0:#x})", UnderlyingCast(imageType));
+		return {};
+	}
+
+	inline WGPUIndexFormat ToWebGPU(IndexType indexType)
+	{
+		switch (indexType)
+		{
+			case IndexType::U16: return WGPUIndexFormat_Uint16;
+			case IndexType::U32: return WGPUIndexFormat_Uint32;
+
+			case IndexType::U8:
+				break;
+		}
+
+		NazaraError("unhandled IndexType {0:#x})", UnderlyingCast(indexType));
+		return WGPUIndexFormat_Undefined;
+	}
+
+	inline WGPUTextureFormat ToWebGPU(PixelFormat pixelFormat)
+	{
+		switch (pixelFormat)
+		{
+			case PixelFormat::ASTC4x4:          return WGPUTextureFormat_ASTC4x4Unorm;
+			case PixelFormat::ASTC4x4_SRGB:     return WGPUTextureFormat_ASTC4x4UnormSrgb;
+			case PixelFormat::ASTC8x8:          return WGPUTextureFormat_ASTC8x8Unorm;
+			case PixelFormat::ASTC8x8_SRGB:     return WGPUTextureFormat_ASTC8x8UnormSrgb;
+			case PixelFormat::BC4:              return WGPUTextureFormat_BC4RUnorm;
+			case PixelFormat::BC5:              return WGPUTextureFormat_BC5RGUnorm;
+			case PixelFormat::BC6H:             return WGPUTextureFormat_BC6HRGBUfloat;
+			case PixelFormat::BC7:              return WGPUTextureFormat_BC7RGBAUnorm;
+			case PixelFormat::BC7_SRGB:         return WGPUTextureFormat_BC7RGBAUnormSrgb;
+			case PixelFormat::BGRA8:            return WGPUTextureFormat_BGRA8Unorm;
+			case PixelFormat::BGRA8_SRGB:       return WGPUTextureFormat_BGRA8UnormSrgb;
+			case PixelFormat::Depth16:          return WGPUTextureFormat_Depth16Unorm;
+			case PixelFormat::Depth24:          return WGPUTextureFormat_Depth24Plus;
+			case PixelFormat::Depth24Stencil8:  return WGPUTextureFormat_Depth24PlusStencil8;
+			case PixelFormat::Depth32F:         return WGPUTextureFormat_Depth32Float;
+			case PixelFormat::Depth32FStencil8: return WGPUTextureFormat_Depth32FloatStencil8;
+			case PixelFormat::DXT1:             return WGPUTextureFormat_BC1RGBAUnorm;
+			case PixelFormat::DXT3:             return WGPUTextureFormat_BC2RGBAUnorm;
+			case PixelFormat::DXT5:             return WGPUTextureFormat_BC3RGBAUnorm;
+			case PixelFormat::ETC2_RGB8:        return WGPUTextureFormat_ETC2RGB8Unorm;
+			case PixelFormat::ETC2_RGB8_SRGB:   return WGPUTextureFormat_ETC2RGB8UnormSrgb;
+			case PixelFormat::ETC2_RGBA8:       return WGPUTextureFormat_ETC2RGBA8Unorm;
+			case PixelFormat::ETC2_RGBA8_SRGB:  return WGPUTextureFormat_ETC2RGBA8UnormSrgb;
+			case PixelFormat::R8:               return WGPUTextureFormat_R8Unorm;
+			case PixelFormat::R8I:              return WGPUTextureFormat_R8Sint;
+			case PixelFormat::R8UI:             return WGPUTextureFormat_R8Uint;
+			case PixelFormat::R16F:             return WGPUTextureFormat_R16Float;
+			case PixelFormat::R16I:             return WGPUTextureFormat_R16Sint;
+			case PixelFormat::R16UI:            return WGPUTextureFormat_R16Uint;
+			case PixelFormat::R32F:             return WGPUTextureFormat_R32Float;
+			case PixelFormat::R32I:             return WGPUTextureFormat_R32Sint;
+			case PixelFormat::R32UI:            return WGPUTextureFormat_R32Uint;
+			case PixelFormat::RG8:              return WGPUTextureFormat_RG8Unorm;
+			case PixelFormat::RG8I:             return WGPUTextureFormat_RG8Sint;
+			case PixelFormat::RG8UI:            return WGPUTextureFormat_RG8Uint;
+			case PixelFormat::RG16F:            return WGPUTextureFormat_RG16Float;
+			case PixelFormat::RG16I:            return WGPUTextureFormat_RG16Sint;
+			case PixelFormat::RG16UI:           return WGPUTextureFormat_RG16Uint;
+			case PixelFormat::RG32F:            return WGPUTextureFormat_RG32Float;
+			case PixelFormat::RG32I:            return WGPUTextureFormat_RG32Sint;
+			case PixelFormat::RG32UI:           return WGPUTextureFormat_RG32Uint;
+			case PixelFormat::RGBA8:            return WGPUTextureFormat_RGBA8Unorm;
+			case PixelFormat::RGBA8_SRGB:       return WGPUTextureFormat_RGBA8UnormSrgb;
+			case PixelFormat::RGBA16F:          return WGPUTextureFormat_RGBA16Float;
+			case PixelFormat::RGBA16I:          return WGPUTextureFormat_RGBA16Sint;
+			case PixelFormat::RGBA16UI:         return WGPUTextureFormat_RGBA16Uint;
+			case PixelFormat::RGBA32F:          return WGPUTextureFormat_RGBA32Float;
+			case PixelFormat::RGBA32I:          return WGPUTextureFormat_RGBA32Sint;
+			case PixelFormat::RGBA32UI:         return WGPUTextureFormat_RGBA32Uint;
+			case PixelFormat::Stencil8:         return WGPUTextureFormat_Stencil8;
+			default: break; //< three-component, 16-bit normalized and luminance formats have no WebGPU equivalent
+		}
+
+		return WGPUTextureFormat_Undefined;
+	}
+
+	inline WGPUTextureAspect ToWebGPU(PixelFormatContent pixelFormatContent)
+	{
+		switch (pixelFormatContent)
+		{
+			case PixelFormatContent::ColorRGBA:    return WGPUTextureAspect_All;
+			case PixelFormatContent::Depth:        return WGPUTextureAspect_DepthOnly;
+			case PixelFormatContent::DepthStencil: return WGPUTextureAspect_All;
+			case PixelFormatContent::Stencil:      return WGPUTextureAspect_StencilOnly;
+
+			case PixelFormatContent::Undefined:
+				break;
+		}
+
+		NazaraError("unhandled PixelFormatContent {0:#x})", UnderlyingCast(pixelFormatContent));
+		return {};
+	}
+
+	inline WGPUPresentMode ToWebGPU(PresentMode presentMode)
+	{
+		switch (presentMode)
+		{
+			case PresentMode::Immediate:           return WGPUPresentMode_Immediate;
+			case PresentMode::Mailbox:             return WGPUPresentMode_Mailbox;
+			case PresentMode::RelaxedVerticalSync: return WGPUPresentMode_Fifo;
+			case PresentMode::VerticalSync:        return WGPUPresentMode_Fifo;
+		}
+
+		NazaraError("unhandled PresentMode {0:#x})", UnderlyingCast(presentMode));
+		return {};
+	}
+
+	inline WGPUPrimitiveTopology ToWebGPU(PrimitiveMode primitiveMode)
+	{
+		switch (primitiveMode)
+		{
+			case PrimitiveMode::LineList:      return WGPUPrimitiveTopology_LineList;
+			case PrimitiveMode::LineStrip:     return WGPUPrimitiveTopology_LineStrip;
+			case PrimitiveMode::PointList:     return WGPUPrimitiveTopology_PointList;
+			case PrimitiveMode::TriangleList:  return WGPUPrimitiveTopology_TriangleList;
+			case PrimitiveMode::TriangleStrip: return WGPUPrimitiveTopology_TriangleStrip;
+
+			case PrimitiveMode::TriangleFan:
+				break;
+		}
+
+		NazaraError("unhandled PrimitiveMode {0:#x})", UnderlyingCast(primitiveMode));
+		return {};
+	}
+
+	inline WGPUCompareFunction ToWebGPU(RendererComparison comparison)
+	{
+		switch (comparison)
+		{
+			case RendererComparison::Never:          return WGPUCompareFunction_Never;
+			case RendererComparison::Less:           return WGPUCompareFunction_Less;
+			case RendererComparison::Equal:          return WGPUCompareFunction_Equal;
+			case RendererComparison::LessOrEqual:    return WGPUCompareFunction_LessEqual;
+			case RendererComparison::Greater:        return WGPUCompareFunction_Greater;
+			case RendererComparison::NotEqual:       return WGPUCompareFunction_NotEqual;
+			case RendererComparison::GreaterOrEqual: return WGPUCompareFunction_GreaterEqual;
+			case RendererComparison::Always:         return WGPUCompareFunction_Always;
+		}
+
+		NazaraError("unhandled RendererComparison {0:#x})", UnderlyingCast(comparison));
+		return {};
+	}
+
+	inline WGPUFilterMode ToWebGPU(SamplerFilter samplerFilter)
+	{
+		switch (samplerFilter)
+		{
+			case SamplerFilter::Linear:  return WGPUFilterMode_Linear;
+			case SamplerFilter::Nearest: return WGPUFilterMode_Nearest;
+		}
+
+		NazaraError("unhandled SamplerFilter {0:#x})", UnderlyingCast(samplerFilter));
+		return {};
+	}
+
+	inline WGPUMipmapFilterMode ToWebGPU(SamplerMipmapMode samplerMipmap)
+	{
+		switch (samplerMipmap)
+		{
+			case SamplerMipmapMode::Linear:  return WGPUMipmapFilterMode_Linear;
+			case SamplerMipmapMode::Nearest: return WGPUMipmapFilterMode_Nearest;
+		}
+
+		NazaraError("unhandled SamplerMipmapMode {0:#x})", UnderlyingCast(samplerMipmap));
+		return {};
+	}
+
+	inline WGPUAddressMode ToWebGPU(SamplerWrap samplerWrap)
+	{
+		switch (samplerWrap)
+		{
+			case SamplerWrap::Clamp:          return WGPUAddressMode_ClampToEdge;
+			case SamplerWrap::MirroredRepeat: return WGPUAddressMode_MirrorRepeat;
+			case SamplerWrap::Repeat:         return WGPUAddressMode_Repeat;
+		}
+
+		NazaraError("unhandled SamplerWrap {0:#x})", UnderlyingCast(samplerWrap));
+		return {};
+	}
+
+	inline WGPUShaderStage ToWebGPU(nzsl::ShaderStageType stageType)
+	{
+		switch (stageType)
+		{
+			case nzsl::ShaderStageType::Compute:  return WGPUShaderStage_Compute;
+			case nzsl::ShaderStageType::Fragment: return WGPUShaderStage_Fragment;
+			case nzsl::ShaderStageType::Vertex:   return WGPUShaderStage_Vertex;
+		}
+
+		NazaraError("unhandled nzsl::ShaderStageType {0:#x})", UnderlyingCast(stageType));
+		return {};
+	}
+
+	inline WGPUShaderStageFlags ToWebGPU(nzsl::ShaderStageTypeFlags stageType)
+	{
+		WGPUShaderStageFlags shaderStageBits = WGPUShaderStage_None;
+		for (nzsl::ShaderStageType shaderStage : stageType)
+			shaderStageBits |= ToWebGPU(shaderStage);
+
+		return shaderStageBits;
+	}
+
+	inline WGPUStencilOperation ToWebGPU(StencilOperation stencilOp)
+	{
+		switch (stencilOp)
+		{
+			case StencilOperation::Decrement:        return WGPUStencilOperation_DecrementClamp;
+			case StencilOperation::DecrementNoClamp: return WGPUStencilOperation_DecrementWrap;
+			case StencilOperation::Increment:        return WGPUStencilOperation_IncrementClamp;
+			case StencilOperation::IncrementNoClamp: return WGPUStencilOperation_IncrementWrap;
+			case StencilOperation::Invert:           return WGPUStencilOperation_Invert;
+			case StencilOperation::Keep:             return WGPUStencilOperation_Keep;
+			case StencilOperation::Replace:          return WGPUStencilOperation_Replace;
+			case StencilOperation::Zero:             return WGPUStencilOperation_Zero;
+		}
+
+		NazaraError("unhandled StencilOperation {0:#x})", UnderlyingCast(stencilOp));
+		return {};
+	}
+
+	inline WGPUStorageTextureAccess ToWebGPU(TextureAccess textureAccess)
+	{
+		switch (textureAccess)
+		{
+			case TextureAccess::ReadOnly:  return WGPUStorageTextureAccess_ReadOnly;
+			case TextureAccess::ReadWrite: return WGPUStorageTextureAccess_ReadWrite;
+			case TextureAccess::WriteOnly: return WGPUStorageTextureAccess_WriteOnly;
+		}
+
+		NazaraError("unhandled TextureAccess {0:#x})", UnderlyingCast(textureAccess));
+		return {};
+	}
+
+	inline WGPUTextureUsage ToWebGPU(TextureUsage textureUsage)
+	{
+		switch (textureUsage)
+		{
+			case TextureUsage::ColorAttachment:        return WGPUTextureUsage_RenderAttachment;
+			case TextureUsage::DepthStencilAttachment: return WGPUTextureUsage_RenderAttachment;
+			case TextureUsage::InputAttachment:        return WGPUTextureUsage_TextureBinding; //< input attachments are read as regular textures
+			case TextureUsage::ShaderReadWrite:        return WGPUTextureUsage_StorageBinding;
+			case TextureUsage::ShaderSampling:         return WGPUTextureUsage_TextureBinding;
+			case TextureUsage::TransferSource:         return WGPUTextureUsage_CopySrc;
+			case TextureUsage::TransferDestination:    return WGPUTextureUsage_CopyDst;
+			case TextureUsage::TransientAttachment:    return WGPUTextureUsage_None;
+			case TextureUsage::Streamed:               return WGPUTextureUsage_None;
+		}
+
+		NazaraError("unhandled TextureUsage {0:#x})", UnderlyingCast(textureUsage));
+		return {};
+	}
+
+	inline WGPUTextureUsageFlags ToWebGPU(TextureUsageFlags textureUsages)
+	{
+		WGPUTextureUsageFlags textureUsageBits = WGPUTextureUsage_None;
+		for (TextureUsage textureUsage : textureUsages)
+			textureUsageBits |= ToWebGPU(textureUsage);
+
+		return textureUsageBits;
+	}
+
+	inline WGPUVertexStepMode ToWebGPU(VertexInputRate inputRate)
+	{
+		switch (inputRate)
+		{
+			case VertexInputRate::Instance: return WGPUVertexStepMode_Instance;
+			case VertexInputRate::Vertex:   return WGPUVertexStepMode_Vertex;
+		}
+
+		NazaraError("unhandled VertexInputRate {0:#x})", UnderlyingCast(inputRate));
+		return {};
+	}
+
+	inline WGPUTextureViewDimension ToWebGPUViewDimension(ImageType imageType)
+	{
+		switch (imageType)
+		{
+			case ImageType::E1D:       return WGPUTextureViewDimension_1D;
+			case ImageType::E1D_Array: return WGPUTextureViewDimension_2DArray;
+			case ImageType::E2D:       return WGPUTextureViewDimension_2D;
+			case ImageType::E2D_Array: return WGPUTextureViewDimension_2DArray;
+			case ImageType::E3D:       return WGPUTextureViewDimension_3D;
+			case ImageType::Cubemap:   return WGPUTextureViewDimension_Cube;
+		}
+
+		NazaraError("unhandled ImageType {0:#x})", UnderlyingCast(imageType));
+		return {};
+	}
+}
+
+#include <Nazara/WebGPURenderer/DebugOff.hpp>
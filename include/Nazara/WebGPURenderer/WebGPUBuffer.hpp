@@ -0,0 +1,54 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_WEBGPURENDERER_WEBGPUBUFFER_HPP
+#define NAZARA_WEBGPURENDERER_WEBGPUBUFFER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Renderer/RenderBuffer.hpp>
+#include <Nazara/WebGPURenderer/Config.hpp>
+#include <webgpu/webgpu.h>
+#include <vector>
+
+namespace Nz
+{
+	class WebGPUDevice;
+
+	class NAZARA_WEBGPURENDERER_API WebGPUBuffer : public RenderBuffer
+	{
+		public:
+			WebGPUBuffer(WebGPUDevice& device, BufferType type, UInt64 size, BufferUsageFlags usage, const void* initialData = nullptr);
+			WebGPUBuffer(const WebGPUBuffer&) = delete;
+			WebGPUBuffer(WebGPUBuffer&&) = delete;
+			~WebGPUBuffer();
+
+			bool Fill(const void* data, UInt64 offset, UInt64 size) override;
+
+			inline WGPUBuffer GetHandle() const;
+
+			void* Map(UInt64 offset, UInt64 size) override;
+			bool Unmap() override;
+
+			void UpdateDebugName(std::string_view name) override;
+
+			WebGPUBuffer& operator=(const WebGPUBuffer&) = delete;
+			WebGPUBuffer& operator=(WebGPUBuffer&&) = delete;
+
+		private:
+			bool Upload(const void* data, UInt64 offset, UInt64 size);
+
+			std::vector<UInt8> m_shadowBuffer;
+			std::vector<UInt8> m_stagingBuffer;
+			UInt64 m_mappedOffset;
+			UInt64 m_mappedSize;
+			WebGPUDevice& m_device;
+			WGPUBuffer m_buffer;
+	};
+}
+
+#include <Nazara/WebGPURenderer/WebGPUBuffer.inl>
+
+#endif // NAZARA_WEBGPURENDERER_WEBGPUBUFFER_HPP
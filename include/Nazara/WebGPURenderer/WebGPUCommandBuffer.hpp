@@ -0,0 +1,263 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_WEBGPURENDERER_WEBGPUCOMMANDBUFFER_HPP
+#define NAZARA_WEBGPURENDERER_WEBGPUCOMMANDBUFFER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/Color.hpp>
+#include <Nazara/Math/Box.hpp>
+#include <Nazara/Math/Rect.hpp>
+#include <Nazara/Renderer/CommandBuffer.hpp>
+#include <Nazara/Renderer/CommandBufferBuilder.hpp>
+#include <Nazara/WebGPURenderer/Config.hpp>
+#include <webgpu/webgpu.h>
+#include <array>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace Nz
+{
+	class WebGPUComputePipeline;
+	class WebGPUDevice;
+	class WebGPUFramebuffer;
+	class WebGPURenderPass;
+	class WebGPURenderPipeline;
+	class WebGPUShaderBinding;
+	class WebGPUTexture;
+
+	// WebGPU command buffers can only be submitted once, commands are recorded and encoded again on each submission
+	class NAZARA_WEBGPURENDERER_API WebGPUCommandBuffer final : public CommandBuffer
+	{
+		public:
+			WebGPUCommandBuffer() = default;
+			WebGPUCommandBuffer(const WebGPUCommandBuffer&) = delete;
+			WebGPUCommandBuffer(WebGPUCommandBuffer&&) = delete;
+			~WebGPUCommandBuffer() = default;
+
+			inline void BeginDebugRegion(std::string_view regionName);
+			inline void BeginRenderPass(const WebGPUFramebuffer& framebuffer, const WebGPURenderPass& renderPass, const Recti& renderRect, const CommandBufferBuilder::ClearValues* clearValues, std::size_t clearValueCount);
+
+			inline void BindComputePipeline(const WebGPUComputePipeline* pipeline);
+			inline void BindComputeShaderBinding(UInt32 set, const WebGPUShaderBinding* binding);
+			inline void BindIndexBuffer(WGPUBuffer indexBuffer, WGPUIndexFormat indexFormat, UInt64 offset, UInt64 size);
+			inline void BindRenderPipeline(const WebGPURenderPipeline* pipeline);
+			inline void BindRenderShaderBinding(UInt32 set, const WebGPUShaderBinding* binding);
+			inline void BindVertexBuffer(UInt32 binding, WGPUBuffer vertexBuffer, UInt64 offset, UInt64 size);
+
+			inline void CopyBuffer(WGPUBuffer source, WGPUBuffer target, UInt64 size, UInt64 sourceOffset, UInt64 targetOffset);
+			inline void CopyBuffer(const void* memory, WGPUBuffer target, UInt64 size, UInt64 targetOffset);
+			inline void CopyTexture(const WebGPUTexture& source, const Boxui& sourceBox, const WebGPUTexture& target, const Vector3ui& targetPoint);
+
+			inline void Dispatch(UInt32 workgroupX, UInt32 workgroupY, UInt32 workgroupZ);
+
+			inline void Draw(UInt32 vertexCount, UInt32 instanceCount, UInt32 firstVertex, UInt32 firstInstance);
+			inline void DrawIndexed(UInt32 indexCount, UInt32 instanceCount, UInt32 firstIndex, UInt32 firstInstance);
+			inline void DrawIndexedIndirect(WGPUBuffer indirectBuffer, UInt64 indirectOffset, UInt32 drawCount, UInt32 stride);
+
+			inline void EndDebugRegion();
+			inline void EndRenderPass();
+
+			WGPUCommandBuffer Encode(WebGPUDevice& device) const;
+
+			inline void InsertDebugLabel(std::string_view label);
+
+			inline void SetScissor(const Recti& scissorRegion);
+			inline void SetViewport(const Recti& viewportRegion);
+
+			void UpdateDebugName(std::string_view name) override;
+
+			WebGPUCommandBuffer& operator=(const WebGPUCommandBuffer&) = delete;
+			WebGPUCommandBuffer& operator=(WebGPUCommandBuffer&&) = delete;
+
+		private:
+			struct EncodingState;
+
+			void Release() override;
+
+			struct BeginDebugRegionCommand
+			{
+				std::string regionName;
+			};
+
+			struct BeginRenderPassCommand
+			{
+				std::array<CommandBufferBuilder::ClearValues, 16> clearValues; //< TODO: Remove hard limit?
+				const WebGPUFramebuffer* framebuffer;
+				const WebGPURenderPass* renderPass;
+				Recti renderRect;
+			};
+
+			struct BindComputePipelineCommand
+			{
+				const WebGPUComputePipeline* pipeline;
+			};
+
+			struct BindComputeShaderBindingCommand
+			{
+				const WebGPUShaderBinding* binding;
+				UInt32 set;
+			};
+
+			struct BindIndexBufferCommand
+			{
+				WGPUBuffer buffer;
+				WGPUIndexFormat format;
+				UInt64 offset;
+				UInt64 size;
+			};
+
+			struct BindRenderPipelineCommand
+			{
+				const WebGPURenderPipeline* pipeline;
+			};
+
+			struct BindRenderShaderBindingCommand
+			{
+				const WebGPUShaderBinding* binding;
+				UInt32 set;
+			};
+
+			struct BindVertexBufferCommand
+			{
+				WGPUBuffer buffer;
+				UInt32 binding;
+				UInt64 offset;
+				UInt64 size;
+			};
+
+			struct CopyBufferCommand
+			{
+				WGPUBuffer source;
+				WGPUBuffer target;
+				UInt64 size;
+				UInt64 sourceOffset;
+				UInt64 targetOffset;
+			};
+
+			struct CopyBufferFromMemoryCommand
+			{
+				const void* memory;
+				WGPUBuffer target;
+				UInt64 size;
+				UInt64 targetOffset;
+			};
+
+			struct CopyTextureCommand
+			{
+				const WebGPUTexture* source;
+				const WebGPUTexture* target;
+				Boxui sourceBox;
+				Vector3ui targetPoint;
+			};
+
+			struct DispatchCommand
+			{
+				UInt32 workgroupX;
+				UInt32 workgroupY;
+				UInt32 workgroupZ;
+			};
+
+			struct DrawCommand
+			{
+				UInt32 firstInstance;
+				UInt32 firstVertex;
+				UInt32 instanceCount;
+				UInt32 vertexCount;
+			};
+
+			struct DrawIndexedCommand
+			{
+				UInt32 firstIndex;
+				UInt32 firstInstance;
+				UInt32 indexCount;
+				UInt32 instanceCount;
+			};
+
+			struct DrawIndexedIndirectCommand
+			{
+				WGPUBuffer indirectBuffer;
+				UInt64 indirectOffset;
+				UInt32 drawCount;
+				UInt32 stride;
+			};
+
+			struct EndDebugRegionCommand
+			{
+			};
+
+			struct EndRenderPassCommand
+			{
+			};
+
+			struct InsertDebugLabelCommand
+			{
+				std::string label;
+			};
+
+			struct SetScissorCommand
+			{
+				Recti scissorRegion;
+			};
+
+			struct SetViewportCommand
+			{
+				Recti viewportRegion;
+			};
+
+			using CommandData = std::variant<
+				BeginDebugRegionCommand,
+				BeginRenderPassCommand,
+				BindComputePipelineCommand,
+				BindComputeShaderBindingCommand,
+				BindIndexBufferCommand,
+				BindRenderPipelineCommand,
+				BindRenderShaderBindingCommand,
+				BindVertexBufferCommand,
+				CopyBufferCommand,
+				CopyBufferFromMemoryCommand,
+				CopyTextureCommand,
+				DispatchCommand,
+				DrawCommand,
+				DrawIndexedCommand,
+				DrawIndexedIndirectCommand,
+				EndDebugRegionCommand,
+				EndRenderPassCommand,
+				InsertDebugLabelCommand,
+				SetScissorCommand,
+				SetViewportCommand
+			>;
+
+			void Execute(EncodingState& state, const BeginDebugRegionCommand& command) const;
+			void Execute(EncodingState& state, const BeginRenderPassCommand& command) const;
+			void Execute(EncodingState& state, const BindComputePipelineCommand& command) const;
+			void Execute(EncodingState& state, const BindComputeShaderBindingCommand& command) const;
+			void Execute(EncodingState& state, const BindIndexBufferCommand& command) const;
+			void Execute(EncodingState& state, const BindRenderPipelineCommand& command) const;
+			void Execute(EncodingState& state, const BindRenderShaderBindingCommand& command) const;
+			void Execute(EncodingState& state, const BindVertexBufferCommand& command) const;
+			void Execute(EncodingState& state, const CopyBufferCommand& command) const;
+			void Execute(EncodingState& state, const CopyBufferFromMemoryCommand& command) const;
+			void Execute(EncodingState& state, const CopyTextureCommand& command) const;
+			void Execute(EncodingState& state, const DispatchCommand& command) const;
+			void Execute(EncodingState& state, const DrawCommand& command) const;
+			void Execute(EncodingState& state, const DrawIndexedCommand& command) const;
+			void Execute(EncodingState& state, const DrawIndexedIndirectCommand& command) const;
+			void Execute(EncodingState& state, const EndDebugRegionCommand& command) const;
+			void Execute(EncodingState& state, const EndRenderPassCommand& command) const;
+			void Execute(EncodingState& state, const InsertDebugLabelCommand& command) const;
+			void Execute(EncodingState& state, const SetScissorCommand& command) const;
+			void Execute(EncodingState& state, const SetViewportCommand& command) const;
+
+			std::string m_debugName;
+			std::vector<CommandData> m_commands;
+	};
+}
+
+#include <Nazara/WebGPURenderer/WebGPUCommandBuffer.inl>
+
+#endif // NAZARA_WEBGPURENDERER_WEBGPUCOMMANDBUFFER_HPP
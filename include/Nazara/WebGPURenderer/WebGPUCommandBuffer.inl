@@ -0,0 +1,126 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Error.hpp>
+#include <algorithm>
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	inline void WebGPUCommandBuffer::BeginDebugRegion(std::string_view regionName)
+	{
+		BeginDebugRegionCommand beginDebugRegion;
+		beginDebugRegion.regionName = regionName;
+
+		m_commands.emplace_back(std::move(beginDebugRegion));
+	}
+
+	inline void WebGPUCommandBuffer::BeginRenderPass(const WebGPUFramebuffer& framebuffer, const WebGPURenderPass& renderPass, const Recti& renderRect, const CommandBufferBuilder::ClearValues* clearValues, std::size_t clearValueCount)
+	{
+		BeginRenderPassCommand beginRenderPass;
+		beginRenderPass.framebuffer = &framebuffer;
+		beginRenderPass.renderPass = &renderPass;
+		beginRenderPass.renderRect = renderRect;
+
+		NazaraAssert(clearValueCount <= beginRenderPass.clearValues.size(), "too many clear values");
+		std::copy_n(clearValues, std::min(clearValueCount, beginRenderPass.clearValues.size()), beginRenderPass.clearValues.begin());
+
+		m_commands.emplace_back(std::move(beginRenderPass));
+	}
+
+	inline void WebGPUCommandBuffer::BindComputePipeline(const WebGPUComputePipeline* pipeline)
+	{
+		m_commands.emplace_back(BindComputePipelineCommand{ pipeline });
+	}
+
+	inline void WebGPUCommandBuffer::BindComputeShaderBinding(UInt32 set, const WebGPUShaderBinding* binding)
+	{
+		m_commands.emplace_back(BindComputeShaderBindingCommand{ binding, set });
+	}
+
+	inline void WebGPUCommandBuffer::BindIndexBuffer(WGPUBuffer indexBuffer, WGPUIndexFormat indexFormat, UInt64 offset, UInt64 size)
+	{
+		m_commands.emplace_back(BindIndexBufferCommand{ indexBuffer, indexFormat, offset, size });
+	}
+
+	inline void WebGPUCommandBuffer::BindRenderPipeline(const WebGPURenderPipeline* pipeline)
+	{
+		m_commands.emplace_back(BindRenderPipelineCommand{ pipeline });
+	}
+
+	inline void WebGPUCommandBuffer::BindRenderShaderBinding(UInt32 set, const WebGPUShaderBinding* binding)
+	{
+		m_commands.emplace_back(BindRenderShaderBindingCommand{ binding, set });
+	}
+
+	inline void WebGPUCommandBuffer::BindVertexBuffer(UInt32 binding, WGPUBuffer vertexBuffer, UInt64 offset, UInt64 size)
+	{
+		m_commands.emplace_back(BindVertexBufferCommand{ vertexBuffer, binding, offset, size });
+	}
+
+	inline void WebGPUCommandBuffer::CopyBuffer(WGPUBuffer source, WGPUBuffer target, UInt64 size, UInt64 sourceOffset, UInt64 targetOffset)
+	{
+		m_commands.emplace_back(CopyBufferCommand{ source, target, size, sourceOffset, targetOffset });
+	}
+
+	inline void WebGPUCommandBuffer::CopyBuffer(const void* memory, WGPUBuffer target, UInt64 size, UInt64 targetOffset)
+	{
+		m_commands.emplace_back(CopyBufferFromMemoryCommand{ memory, target, size, targetOffset });
+	}
+
+	inline void WebGPUCommandBuffer::CopyTexture(const WebGPUTexture& source, const Boxui& sourceBox, const WebGPUTexture& target, const Vector3ui& targetPoint)
+	{
+		m_commands.emplace_back(CopyTextureCommand{ &source, &target, sourceBox, targetPoint });
+	}
+
+	inline void WebGPUCommandBuffer::Dispatch(UInt32 workgroupX, UInt32 workgroupY, UInt32 workgroupZ)
+	{
+		m_commands.emplace_back(DispatchCommand{ workgroupX, workgroupY, workgroupZ });
+	}
+
+	inline void WebGPUCommandBuffer::Draw(UInt32 vertexCount, UInt32 instanceCount, UInt32 firstVertex, UInt32 firstInstance)
+	{
+		m_commands.emplace_back(DrawCommand{ firstInstance, firstVertex, instanceCount, vertexCount });
+	}
+
+	inline void WebGPUCommandBuffer::DrawIndexed(UInt32 indexCount, UInt32 instanceCount, UInt32 firstIndex, UInt32 firstInstance)
+	{
+		m_commands.emplace_back(DrawIndexedCommand{ firstIndex, firstInstance, indexCount, instanceCount });
+	}
+
+	inline void WebGPUCommandBuffer::DrawIndexedIndirect(WGPUBuffer indirectBuffer, UInt64 indirectOffset, UInt32 drawCount, UInt32 stride)
+	{
+		m_commands.emplace_back(DrawIndexedIndirectCommand{ indirectBuffer, indirectOffset, drawCount, stride });
+	}
+
+	inline void WebGPUCommandBuffer::EndDebugRegion()
+	{
+		m_commands.emplace_back(EndDebugRegionCommand{});
+	}
+
+	inline void WebGPUCommandBuffer::EndRenderPass()
+	{
+		m_commands.emplace_back(EndRenderPassCommand{});
+	}
+
+	inline void WebGPUCommandBuffer::InsertDebugLabel(std::string_view label)
+	{
+		InsertDebugLabelCommand insertDebugLabel;
+		insertDebugLabel.label = label;
+
+		m_commands.emplace_back(std::move(insertDebugLabel));
+	}
+
+	inline void WebGPUCommandBuffer::SetScissor(const Recti& scissorRegion)
+	{
+		m_commands.emplace_back(SetScissorCommand{ scissorRegion });
+	}
+
+	inline void WebGPUCommandBuffer::SetViewport(const Recti& viewportRegion)
+	{
+		m_commands.emplace_back(SetViewportCommand{ viewportRegion });
+	}
+}
+
+#include <Nazara/WebGPURenderer/DebugOff.hpp>
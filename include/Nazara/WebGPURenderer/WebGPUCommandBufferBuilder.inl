@@ -0,0 +1,20 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	inline WebGPUCommandBufferBuilder::WebGPUCommandBufferBuilder(WebGPUCommandBuffer& commandBuffer) :
+	m_commandBuffer(commandBuffer)
+	{
+	}
+
+	inline WebGPUCommandBuffer& WebGPUCommandBufferBuilder::GetCommandBuffer()
+	{
+		return m_commandBuffer;
+	}
+}
+
+#include <Nazara/WebGPURenderer/DebugOff.hpp>
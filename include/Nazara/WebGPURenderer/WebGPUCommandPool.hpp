@@ -0,0 +1,35 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_WEBGPURENDERER_WEBGPUCOMMANDPOOL_HPP
+#define NAZARA_WEBGPURENDERER_WEBGPUCOMMANDPOOL_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/WebGPURenderer/Config.hpp>
+#include <Nazara/Renderer/CommandPool.hpp>
+
+namespace Nz
+{
+	class NAZARA_WEBGPURENDERER_API WebGPUCommandPool final : public CommandPool
+	{
+		public:
+			WebGPUCommandPool() = default;
+			WebGPUCommandPool(const WebGPUCommandPool&) = delete;
+			WebGPUCommandPool(WebGPUCommandPool&&) noexcept = default;
+			~WebGPUCommandPool() = default;
+
+			CommandBufferPtr BuildCommandBuffer(const std::function<void(CommandBufferBuilder& builder)>& callback) override;
+
+			void UpdateDebugName(std::string_view name) override;
+
+			WebGPUCommandPool& operator=(const WebGPUCommandPool&) = delete;
+			WebGPUCommandPool& operator=(WebGPUCommandPool&&) = delete;
+	};
+}
+
+#include <Nazara/WebGPURenderer/WebGPUCommandPool.inl>
+
+#endif // NAZARA_WEBGPURENDERER_WEBGPUCOMMANDPOOL_HPP
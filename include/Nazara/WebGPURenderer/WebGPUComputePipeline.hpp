@@ -0,0 +1,43 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_WEBGPURENDERER_WEBGPUCOMPUTEPIPELINE_HPP
+#define NAZARA_WEBGPURENDERER_WEBGPUCOMPUTEPIPELINE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Renderer/ComputePipeline.hpp>
+#include <Nazara/WebGPURenderer/Config.hpp>
+#include <webgpu/webgpu.h>
+
+namespace Nz
+{
+	class WebGPUDevice;
+
+	class NAZARA_WEBGPURENDERER_API WebGPUComputePipeline : public ComputePipeline
+	{
+		public:
+			WebGPUComputePipeline(WebGPUDevice& device, ComputePipelineInfo pipelineInfo);
+			WebGPUComputePipeline(const WebGPUComputePipeline&) = delete;
+			WebGPUComputePipeline(WebGPUComputePipeline&&) = delete;
+			~WebGPUComputePipeline();
+
+			inline WGPUComputePipeline GetHandle() const;
+			const ComputePipelineInfo& GetPipelineInfo() const override;
+
+			void UpdateDebugName(std::string_view name) override;
+
+			WebGPUComputePipeline& operator=(const WebGPUComputePipeline&) = delete;
+			WebGPUComputePipeline& operator=(WebGPUComputePipeline&&) = delete;
+
+		private:
+			ComputePipelineInfo m_pipelineInfo;
+			WGPUComputePipeline m_pipeline;
+	};
+}
+
+#include <Nazara/WebGPURenderer/WebGPUComputePipeline.inl>
+
+#endif // NAZARA_WEBGPURENDERER_WEBGPUCOMPUTEPIPELINE_HPP
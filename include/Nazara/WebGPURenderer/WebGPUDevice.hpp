@@ -0,0 +1,67 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_WEBGPURENDERER_WEBGPUDEVICE_HPP
+#define NAZARA_WEBGPURENDERER_WEBGPUDEVICE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Renderer/RenderDevice.hpp>
+#include <Nazara/Renderer/RenderDeviceInfo.hpp>
+#include <Nazara/WebGPURenderer/Config.hpp>
+#include <webgpu/webgpu.h>
+
+namespace Nz
+{
+	class NAZARA_WEBGPURENDERER_API WebGPUDevice : public RenderDevice
+	{
+		public:
+			WebGPUDevice(WGPUDevice device, const RenderDeviceInfo& deviceInfo, const RenderDeviceFeatures& enabledFeatures);
+			WebGPUDevice(const WebGPUDevice&) = delete;
+			WebGPUDevice(WebGPUDevice&&) = delete;
+			~WebGPUDevice();
+
+			const RenderDeviceInfo& GetDeviceInfo() const override;
+			const RenderDeviceFeatures& GetEnabledFeatures() const override;
+			inline WGPUDevice GetHandle() const;
+			inline WGPUQueue GetQueue() const;
+
+			std::shared_ptr<RenderBuffer> InstantiateBuffer(BufferType type, UInt64 size, BufferUsageFlags usageFlags, const void* initialData = nullptr) override;
+			std::shared_ptr<CommandPool> InstantiateCommandPool(QueueType queueType) override;
+			std::shared_ptr<ComputePipeline> InstantiateComputePipeline(ComputePipelineInfo pipelineInfo) override;
+			std::shared_ptr<Framebuffer> InstantiateFramebuffer(unsigned int width, unsigned int height, const std::shared_ptr<RenderPass>& renderPass, const std::vector<std::shared_ptr<Texture>>& attachments) override;
+			std::shared_ptr<RenderPass> InstantiateRenderPass(std::vector<RenderPass::Attachment> attachments, std::vector<RenderPass::SubpassDescription> subpassDescriptions, std::vector<RenderPass::SubpassDependency> subpassDependencies) override;
+			std::shared_ptr<RenderPipeline> InstantiateRenderPipeline(RenderPipelineInfo pipelineInfo) override;
+			std::shared_ptr<RenderPipelineLayout> InstantiateRenderPipelineLayout(RenderPipelineLayoutInfo pipelineLayoutInfo) override;
+			std::shared_ptr<ShaderModule> InstantiateShaderModule(nzsl::ShaderStageTypeFlags shaderStages, const nzsl::Ast::Module& shaderModule, const nzsl::ShaderWriter::States& states) override;
+			std::shared_ptr<ShaderModule> InstantiateShaderModule(nzsl::ShaderStageTypeFlags shaderStages, ShaderLanguage lang, const void* source, std::size_t sourceSize, const nzsl::ShaderWriter::States& states) override;
+			std::shared_ptr<Swapchain> InstantiateSwapchain(WindowHandle windowHandle, const Vector2ui& windowSize, const SwapchainParameters& parameters) override;
+			std::shared_ptr<Texture> InstantiateTexture(const TextureInfo& params) override;
+			std::shared_ptr<Texture> InstantiateTexture(const TextureInfo& params, const void* initialData, bool buildMipmaps, unsigned int srcWidth = 0, unsigned int srcHeight = 0) override;
+			std::shared_ptr<TextureSampler> InstantiateTextureSampler(const TextureSamplerInfo& params) override;
+
+			bool IsParallelCommandRecordingSupported() const override;
+			bool IsTextureFormatSupported(PixelFormat format, TextureUsage usage) const override;
+
+			void SubmitCommandBuffer(WGPUCommandBuffer commandBuffer);
+
+			void WaitForIdle() override;
+
+			WebGPUDevice& operator=(const WebGPUDevice&) = delete;
+			WebGPUDevice& operator=(WebGPUDevice&&) = delete;
+
+			static RenderDeviceInfo BuildDeviceInfo(WGPUDevice device);
+
+		private:
+			RenderDeviceFeatures m_enabledFeatures;
+			RenderDeviceInfo m_deviceInfo;
+			WGPUDevice m_device;
+			WGPUQueue m_queue;
+	};
+}
+
+#include <Nazara/WebGPURenderer/WebGPUDevice.inl>
+
+#endif // NAZARA_WEBGPURENDERER_WEBGPUDEVICE_HPP
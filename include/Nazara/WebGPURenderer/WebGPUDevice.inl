@@ -0,0 +1,20 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	inline WGPUDevice WebGPUDevice::GetHandle() const
+	{
+		return m_device;
+	}
+
+	inline WGPUQueue WebGPUDevice::GetQueue() const
+	{
+		return m_queue;
+	}
+}
+
+#include <Nazara/WebGPURenderer/DebugOff.hpp>
@@ -0,0 +1,42 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_WEBGPURENDERER_WEBGPUFRAMEBUFFER_HPP
+#define NAZARA_WEBGPURENDERER_WEBGPUFRAMEBUFFER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Renderer/Framebuffer.hpp>
+#include <Nazara/WebGPURenderer/Config.hpp>
+#include <webgpu/webgpu.h>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_WEBGPURENDERER_API WebGPUFramebuffer : public Framebuffer
+	{
+		public:
+			WebGPUFramebuffer(FramebufferType type, std::vector<WGPUTextureView> attachments);
+			WebGPUFramebuffer(const WebGPUFramebuffer&) = delete;
+			WebGPUFramebuffer(WebGPUFramebuffer&&) = delete;
+			~WebGPUFramebuffer();
+
+			inline WGPUTextureView GetAttachment(std::size_t attachmentIndex) const;
+			inline std::size_t GetAttachmentCount() const;
+
+			void UpdateAttachment(std::size_t attachmentIndex, WGPUTextureView attachment);
+			void UpdateDebugName(std::string_view name) override;
+
+			WebGPUFramebuffer& operator=(const WebGPUFramebuffer&) = delete;
+			WebGPUFramebuffer& operator=(WebGPUFramebuffer&&) = delete;
+
+		private:
+			std::vector<WGPUTextureView> m_attachments;
+	};
+}
+
+#include <Nazara/WebGPURenderer/WebGPUFramebuffer.inl>
+
+#endif // NAZARA_WEBGPURENDERER_WEBGPUFRAMEBUFFER_HPP
@@ -0,0 +1,22 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <cassert>
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	inline WGPUTextureView WebGPUFramebuffer::GetAttachment(std::size_t attachmentIndex) const
+	{
+		assert(attachmentIndex < m_attachments.size());
+		return m_attachments[attachmentIndex];
+	}
+
+	inline std::size_t WebGPUFramebuffer::GetAttachmentCount() const
+	{
+		return m_attachments.size();
+	}
+}
+
+#include <Nazara/WebGPURenderer/DebugOff.hpp>
@@ -0,0 +1,41 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_WEBGPURENDERER_WEBGPURENDERIMAGE_HPP
+#define NAZARA_WEBGPURENDERER_WEBGPURENDERIMAGE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/WebGPURenderer/Config.hpp>
+#include <Nazara/WebGPURenderer/WebGPUUploadPool.hpp>
+#include <Nazara/Renderer/RenderImage.hpp>
+
+namespace Nz
+{
+	class WebGPUSwapchain;
+
+	class NAZARA_WEBGPURENDERER_API WebGPURenderImage : public RenderImage
+	{
+		public:
+			WebGPURenderImage(WebGPUSwapchain& owner);
+
+			void Execute(const FunctionRef<void(CommandBufferBuilder& builder)>& callback, QueueTypeFlags queueTypeFlags) override;
+
+			WebGPUUploadPool& GetUploadPool() override;
+
+			void Present() override;
+
+			void SubmitCommandBuffer(CommandBuffer* commandBuffer, QueueTypeFlags queueTypeFlags) override;
+			void SynchronizeQueues(QueueType waitingQueue, QueueType signalingQueue) override;
+
+		private:
+			WebGPUSwapchain& m_owner;
+			WebGPUUploadPool m_uploadPool;
+	};
+}
+
+#include <Nazara/WebGPURenderer/WebGPURenderImage.inl>
+
+#endif // NAZARA_WEBGPURENDERER_WEBGPURENDERIMAGE_HPP
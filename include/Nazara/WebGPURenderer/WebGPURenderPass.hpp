@@ -0,0 +1,49 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_WEBGPURENDERER_WEBGPURENDERPASS_HPP
+#define NAZARA_WEBGPURENDERER_WEBGPURENDERPASS_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Renderer/RenderPass.hpp>
+#include <Nazara/WebGPURenderer/Config.hpp>
+#include <webgpu/webgpu.h>
+#include <limits>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_WEBGPURENDERER_API WebGPURenderPass final : public RenderPass
+	{
+		public:
+			WebGPURenderPass(std::vector<Attachment> attachments, std::vector<SubpassDescription> subpassDescriptions, std::vector<SubpassDependency> subpassDependencies);
+			WebGPURenderPass(const WebGPURenderPass&) = delete;
+			WebGPURenderPass(WebGPURenderPass&&) noexcept = default;
+			~WebGPURenderPass() = default;
+
+			inline const std::vector<std::size_t>& GetColorAttachmentIndices() const;
+			inline const std::vector<WGPUTextureFormat>& GetColorFormats() const;
+			inline std::size_t GetDepthStencilAttachmentIndex() const;
+			inline WGPUTextureFormat GetDepthStencilFormat() const;
+
+			void UpdateDebugName(std::string_view name) override;
+
+			WebGPURenderPass& operator=(const WebGPURenderPass&) = delete;
+			WebGPURenderPass& operator=(WebGPURenderPass&&) noexcept = default;
+
+			static constexpr std::size_t InvalidAttachmentIndex = std::numeric_limits<std::size_t>::max();
+
+		private:
+			std::size_t m_depthStencilAttachmentIndex;
+			std::vector<std::size_t> m_colorAttachmentIndices;
+			std::vector<WGPUTextureFormat> m_colorFormats;
+			WGPUTextureFormat m_depthStencilFormat;
+	};
+}
+
+#include <Nazara/WebGPURenderer/WebGPURenderPass.inl>
+
+#endif // NAZARA_WEBGPURENDERER_WEBGPURENDERPASS_HPP
@@ -0,0 +1,30 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	inline const std::vector<std::size_t>& WebGPURenderPass::GetColorAttachmentIndices() const
+	{
+		return m_colorAttachmentIndices;
+	}
+
+	inline const std::vector<WGPUTextureFormat>& WebGPURenderPass::GetColorFormats() const
+	{
+		return m_colorFormats;
+	}
+
+	inline std::size_t WebGPURenderPass::GetDepthStencilAttachmentIndex() const
+	{
+		return m_depthStencilAttachmentIndex;
+	}
+
+	inline WGPUTextureFormat WebGPURenderPass::GetDepthStencilFormat() const
+	{
+		return m_depthStencilFormat;
+	}
+}
+
+#include <Nazara/WebGPURenderer/DebugOff.hpp>
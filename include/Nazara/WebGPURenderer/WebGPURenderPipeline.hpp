@@ -0,0 +1,58 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_WEBGPURENDERER_WEBGPURENDERPIPELINE_HPP
+#define NAZARA_WEBGPURENDERER_WEBGPURENDERPIPELINE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Renderer/RenderPipeline.hpp>
+#include <Nazara/WebGPURenderer/Config.hpp>
+#include <webgpu/webgpu.h>
+#include <string>
+#include <vector>
+
+namespace Nz
+{
+	class WebGPUDevice;
+	class WebGPURenderPass;
+
+	class NAZARA_WEBGPURENDERER_API WebGPURenderPipeline : public RenderPipeline
+	{
+		public:
+			WebGPURenderPipeline(WebGPUDevice& device, RenderPipelineInfo pipelineInfo);
+			WebGPURenderPipeline(const WebGPURenderPipeline&) = delete;
+			WebGPURenderPipeline(WebGPURenderPipeline&&) = delete;
+			~WebGPURenderPipeline();
+
+			WGPURenderPipeline Get(const WebGPURenderPass& renderPass) const;
+			const RenderPipelineInfo& GetPipelineInfo() const override;
+
+			void UpdateDebugName(std::string_view name) override;
+
+			WebGPURenderPipeline& operator=(const WebGPURenderPipeline&) = delete;
+			WebGPURenderPipeline& operator=(WebGPURenderPipeline&&) = delete;
+
+		private:
+			// WebGPU pipelines are created for a set of attachment formats, they're created on demand for each render pass layout
+			struct PipelineData
+			{
+				std::vector<WGPUTextureFormat> colorFormats;
+				WGPUTextureFormat depthStencilFormat;
+				WGPURenderPipeline pipeline;
+			};
+
+			WGPURenderPipeline CreatePipeline(const std::vector<WGPUTextureFormat>& colorFormats, WGPUTextureFormat depthStencilFormat) const;
+
+			mutable std::vector<PipelineData> m_pipelines;
+			std::string m_debugName;
+			RenderPipelineInfo m_pipelineInfo;
+			WebGPUDevice& m_device;
+	};
+}
+
+#include <Nazara/WebGPURenderer/WebGPURenderPipeline.inl>
+
+#endif // NAZARA_WEBGPURENDERER_WEBGPURENDERPIPELINE_HPP
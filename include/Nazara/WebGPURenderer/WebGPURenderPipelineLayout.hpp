@@ -0,0 +1,65 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_WEBGPURENDERER_WEBGPURENDERPIPELINELAYOUT_HPP
+#define NAZARA_WEBGPURENDERER_WEBGPURENDERPIPELINELAYOUT_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Renderer/RenderPipelineLayout.hpp>
+#include <Nazara/WebGPURenderer/Config.hpp>
+#include <Nazara/WebGPURenderer/WebGPUShaderBinding.hpp>
+#include <webgpu/webgpu.h>
+#include <vector>
+
+namespace Nz
+{
+	class WebGPUDevice;
+
+	class NAZARA_WEBGPURENDERER_API WebGPURenderPipelineLayout : public RenderPipelineLayout
+	{
+		friend WebGPUShaderBinding;
+
+		public:
+			WebGPURenderPipelineLayout(WebGPUDevice& device, RenderPipelineLayoutInfo layoutInfo);
+			WebGPURenderPipelineLayout(const WebGPURenderPipelineLayout&) = delete;
+			WebGPURenderPipelineLayout(WebGPURenderPipelineLayout&&) = delete;
+			~WebGPURenderPipelineLayout();
+
+			ShaderBindingPtr AllocateShaderBinding(UInt32 setIndex) override;
+
+			inline WGPUBindGroupLayout GetBindGroupLayout(UInt32 setIndex) const;
+			inline std::size_t GetBindGroupEntryCount(UInt32 setIndex) const;
+			inline WebGPUDevice& GetDevice() const;
+			inline WGPUPipelineLayout GetHandle() const;
+			inline const RenderPipelineLayoutInfo& GetLayoutInfo() const;
+
+			void UpdateDebugName(std::string_view name) override;
+
+			WebGPURenderPipelineLayout& operator=(const WebGPURenderPipelineLayout&) = delete;
+			WebGPURenderPipelineLayout& operator=(WebGPURenderPipelineLayout&&) = delete;
+
+			// WebGPU has no combined image samplers, the sampler of a sampled texture is bound next to it at this binding offset
+			static constexpr UInt32 SamplerBindingOffset = 1000;
+
+		private:
+			struct BindGroupLayout
+			{
+				WGPUBindGroupLayout layout = nullptr;
+				std::size_t entryCount = 0;
+			};
+
+			void Release(ShaderBinding& binding);
+
+			std::vector<BindGroupLayout> m_bindGroupLayouts;
+			RenderPipelineLayoutInfo m_layoutInfo;
+			WebGPUDevice& m_device;
+			WGPUPipelineLayout m_pipelineLayout;
+	};
+}
+
+#include <Nazara/WebGPURenderer/WebGPURenderPipelineLayout.inl>
+
+#endif // NAZARA_WEBGPURENDERER_WEBGPURENDERPIPELINELAYOUT_HPP
@@ -0,0 +1,38 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <cassert>
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	inline WGPUBindGroupLayout WebGPURenderPipelineLayout::GetBindGroupLayout(UInt32 setIndex) const
+	{
+		assert(setIndex < m_bindGroupLayouts.size());
+		return m_bindGroupLayouts[setIndex].layout;
+	}
+
+	inline std::size_t WebGPURenderPipelineLayout::GetBindGroupEntryCount(UInt32 setIndex) const
+	{
+		assert(setIndex < m_bindGroupLayouts.size());
+		return m_bindGroupLayouts[setIndex].entryCount;
+	}
+
+	inline WebGPUDevice& WebGPURenderPipelineLayout::GetDevice() const
+	{
+		return m_device;
+	}
+
+	inline WGPUPipelineLayout WebGPURenderPipelineLayout::GetHandle() const
+	{
+		return m_pipelineLayout;
+	}
+
+	inline const RenderPipelineLayoutInfo& WebGPURenderPipelineLayout::GetLayoutInfo() const
+	{
+		return m_layoutInfo;
+	}
+}
+
+#include <Nazara/WebGPURenderer/DebugOff.hpp>
@@ -0,0 +1,42 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_WEBGPURENDERER_WEBGPURENDERER_HPP
+#define NAZARA_WEBGPURENDERER_WEBGPURENDERER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Renderer/RendererImpl.hpp>
+#include <Nazara/WebGPURenderer/Config.hpp>
+#include <Nazara/WebGPURenderer/WebGPUDevice.hpp>
+#include <webgpu/webgpu.h>
+#include <memory>
+
+namespace Nz
+{
+	class NAZARA_WEBGPURENDERER_API WebGPURenderer : public RendererImpl
+	{
+		public:
+			WebGPURenderer() = default;
+			~WebGPURenderer();
+
+			std::shared_ptr<RenderDevice> InstanciateRenderDevice(std::size_t deviceIndex, const RenderDeviceFeatures& enabledFeatures) override;
+
+			RenderAPI QueryAPI() const override;
+			std::string QueryAPIString() const override;
+			UInt32 QueryAPIVersion() const override;
+			const std::vector<RenderDeviceInfo>& QueryRenderDevices() const override;
+
+			bool Prepare(const Renderer::Config& config) override;
+
+		private:
+			std::vector<RenderDeviceInfo> m_deviceInfos;
+			WGPUDevice m_device = nullptr;
+	};
+}
+
+#include <Nazara/WebGPURenderer/WebGPURenderer.inl>
+
+#endif // NAZARA_WEBGPURENDERER_WEBGPURENDERER_HPP
@@ -0,0 +1,55 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_WEBGPURENDERER_WEBGPUSHADERBINDING_HPP
+#define NAZARA_WEBGPURENDERER_WEBGPUSHADERBINDING_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Renderer/ShaderBinding.hpp>
+#include <Nazara/WebGPURenderer/Config.hpp>
+#include <webgpu/webgpu.h>
+#include <string>
+#include <vector>
+
+namespace Nz
+{
+	class WebGPURenderPipelineLayout;
+
+	class NAZARA_WEBGPURENDERER_API WebGPUShaderBinding : public ShaderBinding
+	{
+		public:
+			inline WebGPUShaderBinding(WebGPURenderPipelineLayout& owner, UInt32 setIndex);
+			WebGPUShaderBinding(const WebGPUShaderBinding&) = delete;
+			WebGPUShaderBinding(WebGPUShaderBinding&&) = delete;
+			~WebGPUShaderBinding();
+
+			inline WGPUBindGroup GetHandle() const;
+			inline WebGPURenderPipelineLayout& GetOwner();
+			inline const WebGPURenderPipelineLayout& GetOwner() const;
+
+			using ShaderBinding::Update;
+			void Update(const Binding* bindings, std::size_t bindingCount) override;
+
+			void UpdateDebugName(std::string_view name) override;
+
+			WebGPUShaderBinding& operator=(const WebGPUShaderBinding&) = delete;
+			WebGPUShaderBinding& operator=(WebGPUShaderBinding&&) = delete;
+
+		private:
+			void Release() override;
+			void SetEntry(const WGPUBindGroupEntry& entry);
+
+			std::string m_debugName;
+			std::vector<WGPUBindGroupEntry> m_entries;
+			WebGPURenderPipelineLayout& m_owner;
+			WGPUBindGroup m_bindGroup;
+			UInt32 m_setIndex;
+	};
+}
+
+#include <Nazara/WebGPURenderer/WebGPUShaderBinding.inl>
+
+#endif // NAZARA_WEBGPURENDERER_WEBGPUSHADERBINDING_HPP
@@ -0,0 +1,32 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	inline WebGPUShaderBinding::WebGPUShaderBinding(WebGPURenderPipelineLayout& owner, UInt32 setIndex) :
+	m_owner(owner),
+	m_bindGroup(nullptr),
+	m_setIndex(setIndex)
+	{
+	}
+
+	inline WGPUBindGroup WebGPUShaderBinding::GetHandle() const
+	{
+		return m_bindGroup;
+	}
+
+	inline WebGPURenderPipelineLayout& WebGPUShaderBinding::GetOwner()
+	{
+		return m_owner;
+	}
+
+	inline const WebGPURenderPipelineLayout& WebGPUShaderBinding::GetOwner() const
+	{
+		return m_owner;
+	}
+}
+
+#include <Nazara/WebGPURenderer/DebugOff.hpp>
@@ -0,0 +1,47 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_WEBGPURENDERER_WEBGPUSHADERMODULE_HPP
+#define NAZARA_WEBGPURENDERER_WEBGPUSHADERMODULE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Renderer/Enums.hpp>
+#include <Nazara/Renderer/ShaderModule.hpp>
+#include <Nazara/WebGPURenderer/Config.hpp>
+#include <NZSL/Enums.hpp>
+#include <webgpu/webgpu.h>
+
+namespace Nz
+{
+	class WebGPUDevice;
+
+	class NAZARA_WEBGPURENDERER_API WebGPUShaderModule : public ShaderModule
+	{
+		public:
+			WebGPUShaderModule(WebGPUDevice& device, nzsl::ShaderStageTypeFlags shaderStages, ShaderLanguage lang, const void* source, std::size_t sourceSize);
+			WebGPUShaderModule(const WebGPUShaderModule&) = delete;
+			WebGPUShaderModule(WebGPUShaderModule&&) = delete;
+			~WebGPUShaderModule();
+
+			inline WGPUShaderModule GetHandle() const;
+			inline nzsl::ShaderStageTypeFlags GetShaderStages() const;
+
+			void UpdateDebugName(std::string_view name) override;
+
+			WebGPUShaderModule& operator=(const WebGPUShaderModule&) = delete;
+			WebGPUShaderModule& operator=(WebGPUShaderModule&&) = delete;
+
+			static const char* GetEntryPointName(nzsl::ShaderStageType shaderStage);
+
+		private:
+			nzsl::ShaderStageTypeFlags m_shaderStages;
+			WGPUShaderModule m_shaderModule;
+	};
+}
+
+#include <Nazara/WebGPURenderer/WebGPUShaderModule.inl>
+
+#endif // NAZARA_WEBGPURENDERER_WEBGPUSHADERMODULE_HPP
@@ -0,0 +1,20 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	inline WGPUShaderModule WebGPUShaderModule::GetHandle() const
+	{
+		return m_shaderModule;
+	}
+
+	inline nzsl::ShaderStageTypeFlags WebGPUShaderModule::GetShaderStages() const
+	{
+		return m_shaderStages;
+	}
+}
+
+#include <Nazara/WebGPURenderer/DebugOff.hpp>
@@ -0,0 +1,79 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_WEBGPURENDERER_WEBGPUSWAPCHAIN_HPP
+#define NAZARA_WEBGPURENDERER_WEBGPUSWAPCHAIN_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Renderer/Swapchain.hpp>
+#include <Nazara/Renderer/SwapchainParameters.hpp>
+#include <Nazara/WebGPURenderer/Config.hpp>
+#include <Nazara/WebGPURenderer/WebGPUFramebuffer.hpp>
+#include <Nazara/WebGPURenderer/WebGPURenderImage.hpp>
+#include <Nazara/WebGPURenderer/WebGPURenderPass.hpp>
+#include <Nazara/WebGPURenderer/WebGPUTexture.hpp>
+#include <webgpu/webgpu.h>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace Nz
+{
+	class WebGPUDevice;
+
+	class NAZARA_WEBGPURENDERER_API WebGPUSwapchain final : public Swapchain
+	{
+		public:
+			WebGPUSwapchain(WebGPUDevice& device, WindowHandle windowHandle, const Vector2ui& windowSize, const SwapchainParameters& parameters);
+			WebGPUSwapchain(const WebGPUSwapchain&) = delete;
+			WebGPUSwapchain(WebGPUSwapchain&&) = delete;
+			~WebGPUSwapchain();
+
+			RenderFrame AcquireFrame() override;
+
+			std::shared_ptr<CommandPool> CreateCommandPool(QueueType queueType) override;
+
+			inline WebGPUDevice& GetDevice();
+			const WebGPUFramebuffer& GetFramebuffer(std::size_t i) const override;
+			std::size_t GetFramebufferCount() const override;
+			PresentMode GetPresentMode() const override;
+			const WebGPURenderPass& GetRenderPass() const override;
+			const Vector2ui& GetSize() const override;
+			PresentModeFlags GetSupportedPresentModes() const override;
+
+			void NotifyResize(const Vector2ui& newSize) override;
+
+			void Present();
+
+			void SetPresentMode(PresentMode presentMode) override;
+
+			TransientResources& Transient() override;
+
+			WebGPUSwapchain& operator=(const WebGPUSwapchain&) = delete;
+			WebGPUSwapchain& operator=(WebGPUSwapchain&&) = delete;
+
+		private:
+			void CreateSwapchain();
+			void ReleaseSwapchain();
+
+			std::optional<WebGPURenderPass> m_renderPass;
+			std::optional<WebGPUFramebuffer> m_framebuffer;
+			std::shared_ptr<WebGPUTexture> m_depthBuffer;
+			std::size_t m_currentFrame;
+			std::vector<std::unique_ptr<WebGPURenderImage>> m_renderImage;
+			WebGPUDevice& m_device;
+			PresentMode m_presentMode;
+			Vector2ui m_size;
+			WGPUSurface m_surface;
+			WGPUSwapChain m_swapchain;
+			WGPUTextureFormat m_colorFormat;
+			bool m_sizeInvalidated;
+	};
+}
+
+#include <Nazara/WebGPURenderer/WebGPUSwapchain.inl>
+
+#endif // NAZARA_WEBGPURENDERER_WEBGPUSWAPCHAIN_HPP
@@ -0,0 +1,15 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	inline WebGPUDevice& WebGPUSwapchain::GetDevice()
+	{
+		return m_device;
+	}
+}
+
+#include <Nazara/WebGPURenderer/DebugOff.hpp>
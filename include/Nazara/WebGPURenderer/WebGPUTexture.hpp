@@ -0,0 +1,64 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_WEBGPURENDERER_WEBGPUTEXTURE_HPP
+#define NAZARA_WEBGPURENDERER_WEBGPUTEXTURE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Renderer/Texture.hpp>
+#include <Nazara/WebGPURenderer/Config.hpp>
+#include <webgpu/webgpu.h>
+
+namespace Nz
+{
+	class WebGPUDevice;
+
+	class NAZARA_WEBGPURENDERER_API WebGPUTexture final : public Texture
+	{
+		public:
+			WebGPUTexture(WebGPUDevice& device, const TextureInfo& textureInfo);
+			WebGPUTexture(std::shared_ptr<WebGPUTexture> parentTexture, const TextureViewInfo& viewInfo);
+			WebGPUTexture(const WebGPUTexture&) = delete;
+			WebGPUTexture(WebGPUTexture&&) = delete;
+			~WebGPUTexture();
+
+			bool Copy(const Texture& source, const Boxui& srcBox, const Vector3ui& dstPos) override;
+			std::shared_ptr<Texture> CreateView(const TextureViewInfo& viewInfo) override;
+
+			void EncodeCopy(WGPUCommandEncoder encoder, const WebGPUTexture& source, const Boxui& srcBox, const Vector3ui& dstPos) const;
+
+			inline PixelFormat GetFormat() const override;
+			inline WGPUTexture GetHandle() const;
+			inline UInt8 GetLevelCount() const override;
+			inline WebGPUTexture* GetParentTexture() const override;
+			inline Vector3ui GetSize(UInt8 level = 0) const override;
+			inline const TextureInfo& GetTextureInfo() const override;
+			inline ImageType GetType() const override;
+			inline WGPUTextureView GetViewHandle() const;
+
+			using Texture::Update;
+			bool Update(const void* ptr, const Boxui& box, unsigned int srcWidth = 0, unsigned int srcHeight = 0, UInt8 level = 0) override;
+
+			void UpdateDebugName(std::string_view name) override;
+
+			WebGPUTexture& operator=(const WebGPUTexture&) = delete;
+			WebGPUTexture& operator=(WebGPUTexture&&) = delete;
+
+		private:
+			WGPUImageCopyTexture BuildCopyTexture(const Boxui& box, UInt8 level, WGPUExtent3D* extent) const;
+
+			std::shared_ptr<WebGPUTexture> m_parentTexture;
+			TextureInfo m_textureInfo;
+			TextureViewInfo m_viewInfo;
+			WebGPUDevice& m_device;
+			WGPUTexture m_texture;
+			WGPUTextureView m_textureView;
+	};
+}
+
+#include <Nazara/WebGPURenderer/WebGPUTexture.inl>
+
+#endif // NAZARA_WEBGPURENDERER_WEBGPUTEXTURE_HPP
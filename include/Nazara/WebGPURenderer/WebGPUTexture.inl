@@ -0,0 +1,50 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	inline PixelFormat WebGPUTexture::GetFormat() const
+	{
+		return m_textureInfo.pixelFormat;
+	}
+
+	inline WGPUTexture WebGPUTexture::GetHandle() const
+	{
+		return m_texture;
+	}
+
+	inline UInt8 WebGPUTexture::GetLevelCount() const
+	{
+		return m_textureInfo.levelCount;
+	}
+
+	inline WebGPUTexture* WebGPUTexture::GetParentTexture() const
+	{
+		return m_parentTexture.get();
+	}
+
+	inline Vector3ui WebGPUTexture::GetSize(UInt8 level) const
+	{
+		return Vector3ui(GetLevelSize(m_textureInfo.width, level), GetLevelSize(m_textureInfo.height, level), GetLevelSize(m_textureInfo.depth, level));
+	}
+
+	inline const TextureInfo& WebGPUTexture::GetTextureInfo() const
+	{
+		return m_textureInfo;
+	}
+
+	inline ImageType WebGPUTexture::GetType() const
+	{
+		return m_textureInfo.type;
+	}
+
+	inline WGPUTextureView WebGPUTexture::GetViewHandle() const
+	{
+		return m_textureView;
+	}
+}
+
+#include <Nazara/WebGPURenderer/DebugOff.hpp>
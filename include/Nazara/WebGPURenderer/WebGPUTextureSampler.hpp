@@ -0,0 +1,41 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_WEBGPURENDERER_WEBGPUTEXTURESAMPLER_HPP
+#define NAZARA_WEBGPURENDERER_WEBGPUTEXTURESAMPLER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Renderer/TextureSampler.hpp>
+#include <Nazara/WebGPURenderer/Config.hpp>
+#include <webgpu/webgpu.h>
+
+namespace Nz
+{
+	class WebGPUDevice;
+
+	class NAZARA_WEBGPURENDERER_API WebGPUTextureSampler : public TextureSampler
+	{
+		public:
+			WebGPUTextureSampler(WebGPUDevice& device, const TextureSamplerInfo& samplerInfo);
+			WebGPUTextureSampler(const WebGPUTextureSampler&) = delete;
+			WebGPUTextureSampler(WebGPUTextureSampler&&) = delete;
+			~WebGPUTextureSampler();
+
+			inline WGPUSampler GetHandle() const;
+
+			void UpdateDebugName(std::string_view name) override;
+
+			WebGPUTextureSampler& operator=(const WebGPUTextureSampler&) = delete;
+			WebGPUTextureSampler& operator=(WebGPUTextureSampler&&) = delete;
+
+		private:
+			WGPUSampler m_sampler;
+	};
+}
+
+#include <Nazara/WebGPURenderer/WebGPUTextureSampler.inl>
+
+#endif // NAZARA_WEBGPURENDERER_WEBGPUTEXTURESAMPLER_HPP
@@ -0,0 +1,16 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	inline WebGPUUploadPool::WebGPUUploadPool(UInt64 blockSize) :
+	m_nextAllocationIndex(0),
+	m_blockSize(blockSize)
+	{
+	}
+}
+
+#include <Nazara/WebGPURenderer/DebugOff.hpp>
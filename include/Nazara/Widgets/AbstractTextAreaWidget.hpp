@@ -12,6 +12,7 @@
 #include <Nazara/Widgets/BaseWidget.hpp>
 #include <Nazara/Widgets/Enums.hpp>
 #include <functional>
+#include <utility>
 #include <vector>
 
 namespace Nz
@@ -62,6 +63,7 @@ namespace Nz
 			inline void SetCursorPosition(Vector2ui cursorPosition);
 			inline void SetEchoMode(EchoMode echoMode);
 			inline void SetReadOnly(bool readOnly = true);
+			void SetRenderingRect(const Rectf& renderingRect) override;
 			inline void SetSelection(Vector2ui fromPosition, Vector2ui toPosition);
 
 			inline void Write(std::string_view text);
@@ -86,6 +88,8 @@ namespace Nz
 			NazaraSignal(OnTextAreaSelection, const AbstractTextAreaWidget* /*textArea*/, Vector2ui* /*start*/, Vector2ui* /*end*/);
 
 		protected:
+			std::pair<std::size_t, std::size_t> ComputeVisibleGlyphRange() const;
+
 			Color GetCursorColor() const;
 
 			virtual void CopySelectionToClipboard(const Vector2ui& selectionBegin, const Vector2ui& selectionEnd) = 0;
@@ -132,6 +136,7 @@ namespace Nz
 
 			std::shared_ptr<TextSprite> m_textSprite;
 			std::vector<Cursor> m_cursors;
+			std::pair<std::size_t, std::size_t> m_visibleGlyphs;
 			CharacterFilter m_characterFilter;
 			EchoMode m_echoMode;
 			entt::entity m_textEntity;
@@ -114,6 +114,7 @@ namespace Nz
 			NazaraSignal(OnWidgetResized, const BaseWidget* /*widget*/, const Vector2f& /*size*/);
 
 		protected:
+			void InvalidateLayout();
 			virtual void Layout();
 
 			entt::entity CreateEntity();
@@ -199,6 +200,7 @@ namespace Nz
 			Vector2f m_size;
 			BaseWidget* m_parentWidget;
 			bool m_disableVisibilitySignal;
+			bool m_isLayoutInvalidated;
 			bool m_visible;
 			int m_baseRenderLayer;
 			int m_renderLayerCount;
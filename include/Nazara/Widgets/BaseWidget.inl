@@ -22,6 +22,7 @@ namespace Nz
 	m_size(50.f, 50.f),
 	m_parentWidget(nullptr),
 	m_disableVisibilitySignal(false),
+	m_isLayoutInvalidated(false),
 	m_visible(true),
 	m_baseRenderLayer(0),
 	m_renderLayerCount(1)
@@ -12,6 +12,8 @@
 #include <Nazara/Widgets/BaseWidget.hpp>
 #include <entt/entity/registry.hpp>
 #include <bitset>
+#include <unordered_map>
+#include <vector>
 
 namespace Nz
 {
@@ -25,10 +27,16 @@ namespace Nz
 			Canvas(Canvas&&) = delete;
 			inline ~Canvas();
 
+			void EnableDeferredLayout(bool enable = true);
+
 			inline entt::registry& GetRegistry();
 			inline const entt::registry& GetRegistry() const;
 			inline UInt32 GetRenderMask() const;
 
+			inline bool IsDeferredLayoutEnabled() const;
+
+			void UpdateLayouts();
+
 			Canvas& operator=(const Canvas&) = delete;
 			Canvas& operator=(Canvas&&) = delete;
 
@@ -44,6 +52,8 @@ namespace Nz
 
 			inline std::size_t GetMouseEventTarget() const;
 
+			inline void InvalidateWidgetLayout(std::size_t index);
+
 			inline void NotifyWidgetBoxUpdate(std::size_t index);
 			inline void NotifyWidgetCursorUpdate(std::size_t index);
 
@@ -56,7 +66,9 @@ namespace Nz
 
 		private:
 			template<typename F> void DispatchEvent(std::size_t widgetIndex, F&& functor);
-			
+
+			void InsertIntoHitGrid(std::size_t index);
+
 			void OnEventMouseButtonPressed(const WindowEventHandler* eventHandler, const WindowEvent::MouseButtonEvent& event);
 			void OnEventMouseButtonRelease(const WindowEventHandler* eventHandler, const WindowEvent::MouseButtonEvent& event);
 			void OnEventMouseEntered(const WindowEventHandler* eventHandler);
@@ -69,15 +81,34 @@ namespace Nz
 			void OnEventTextEntered(const WindowEventHandler* eventHandler, const WindowEvent::TextEvent& event);
 			void OnEventTextEdited(const WindowEventHandler* eventHandler, const WindowEvent::EditEvent& event);
 
+			void RemoveFromHitGrid(std::size_t index);
+
+			void UpdateHitGrid(std::size_t index);
 			void UpdateHoveredWidget(int x, int y);
 
+			static bool ComputeHitGridCells(const Boxf& box, Vector2i& firstCell, Vector2i& lastCell);
+			static inline UInt64 GetHitGridCellKey(int x, int y);
+
+			struct PendingLayout
+			{
+				BaseWidget* widget;
+				std::size_t depth;
+			};
+
 			struct WidgetEntry
 			{
 				BaseWidget* widget;
 				Boxf box;
 				SystemCursor cursor;
+				Vector2i firstHitCell;
+				Vector2i lastHitCell;
+				bool isInHitGrid;
+				bool isOversized; //< widgets covering too many cells are tested on every hit test instead
 			};
 
+			static constexpr float HitGridCellSize = 128.f;
+			static constexpr std::size_t MaxHitGridCellsPerWidget = 256;
+
 			NazaraSlot(WindowEventHandler, OnKeyPressed, m_keyPressedSlot);
 			NazaraSlot(WindowEventHandler, OnKeyReleased, m_keyReleasedSlot);
 			NazaraSlot(WindowEventHandler, OnMouseButtonPressed, m_mouseButtonPressedSlot);
@@ -95,8 +126,14 @@ namespace Nz
 			std::size_t m_keyboardOwner;
 			std::size_t m_hoveredWidget;
 			std::size_t m_mouseOwner;
+			std::unordered_map<UInt64, std::vector<std::size_t>> m_hitGridCells;
+			std::vector<BaseWidget*> m_invalidatedLayouts;
+			std::vector<std::size_t> m_hitCandidates;
+			std::vector<std::size_t> m_oversizedHitEntries;
+			std::vector<PendingLayout> m_pendingLayouts;
 			std::vector<WidgetEntry> m_widgetEntries;
 			entt::registry& m_registry;
+			bool m_deferredLayout;
 	};
 }
 
@@ -31,6 +31,11 @@ namespace Nz
 		return m_renderMask;
 	}
 
+	inline bool Canvas::IsDeferredLayoutEnabled() const
+	{
+		return m_deferredLayout;
+	}
+
 	inline void Canvas::ClearKeyboardOwner(std::size_t canvasIndex)
 	{
 		if (m_keyboardOwner == canvasIndex)
@@ -61,6 +66,11 @@ namespace Nz
 			return m_hoveredWidget;
 	}
 
+	inline void Canvas::InvalidateWidgetLayout(std::size_t index)
+	{
+		m_invalidatedLayouts.push_back(m_widgetEntries[index].widget);
+	}
+
 	inline void Canvas::NotifyWidgetBoxUpdate(std::size_t index)
 	{
 		WidgetEntry& entry = m_widgetEntries[index];
@@ -69,6 +79,8 @@ namespace Nz
 		Nz::Vector2f size = entry.widget->GetSize();
 
 		entry.box = Boxf(pos.x, pos.y, pos.z, size.x, size.y, 1.f);
+
+		UpdateHitGrid(index);
 	}
 
 	inline void Canvas::NotifyWidgetCursorUpdate(std::size_t index)
@@ -100,6 +112,11 @@ namespace Nz
 	{
 		m_mouseOwner = canvasIndex;
 	}
+
+	inline UInt64 Canvas::GetHitGridCellKey(int x, int y)
+	{
+		return (UInt64(UInt32(x)) << 32) | UInt64(UInt32(y));
+	}
 }
 
 #include <Nazara/Widgets/DebugOff.hpp>
@@ -0,0 +1,79 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Widgets module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_WIDGETS_LISTVIEWWIDGET_HPP
+#define NAZARA_WIDGETS_LISTVIEWWIDGET_HPP
+
+#include <Nazara/Widgets/BaseWidget.hpp>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace Nz
+{
+	/*!
+	* \brief Virtualized list (or grid) of items having the same size
+	*
+	* Widgets are only instantiated for the items intersecting the rendering rect, and are recycled when scrolling.
+	* This widget is meant to be the content of a ScrollAreaWidget, which updates its rendering rect when scrolling,
+	* keeping the number of item widgets constant regardless of the item count.
+	*/
+	class NAZARA_WIDGETS_API ListViewWidget : public BaseWidget
+	{
+		public:
+			using ItemBinder = std::function<void(BaseWidget* itemWidget, std::size_t itemIndex)>;
+			using ItemFactory = std::function<BaseWidget*(ListViewWidget* listView)>;
+
+			ListViewWidget(BaseWidget* parent, float itemHeight, std::size_t columnCount = 1);
+			ListViewWidget(const ListViewWidget&) = delete;
+			ListViewWidget(ListViewWidget&&) = delete;
+			~ListViewWidget() = default;
+
+			inline std::size_t GetColumnCount() const;
+			inline std::size_t GetItemCount() const;
+			inline float GetItemHeight() const;
+			BaseWidget* GetItemWidget(std::size_t itemIndex) const;
+			inline std::size_t GetRowCount() const;
+
+			void InvalidateItem(std::size_t itemIndex);
+			void InvalidateItems();
+
+			void SetColumnCount(std::size_t columnCount);
+			void SetItemCallbacks(ItemFactory factory, ItemBinder binder);
+			void SetItemCount(std::size_t itemCount);
+			void SetItemHeight(float itemHeight);
+
+			void SetRenderingRect(const Rectf& renderingRect) override;
+
+			ListViewWidget& operator=(const ListViewWidget&) = delete;
+			ListViewWidget& operator=(ListViewWidget&&) = delete;
+
+			static constexpr std::size_t InvalidItem = std::numeric_limits<std::size_t>::max();
+
+		private:
+			struct ItemWidget
+			{
+				BaseWidget* widget;
+				std::size_t itemIndex;
+			};
+
+			void Layout() override;
+			void ShowChildren(bool show) override;
+			void UpdatePreferredSize();
+			void UpdateVisibleItems(bool rebind);
+
+			std::vector<ItemWidget> m_itemWidgets;
+			ItemBinder m_itemBinder;
+			ItemFactory m_itemFactory;
+			std::size_t m_columnCount;
+			std::size_t m_itemCount;
+			float m_itemHeight;
+	};
+}
+
+#include <Nazara/Widgets/ListViewWidget.inl>
+
+#endif // NAZARA_WIDGETS_LISTVIEWWIDGET_HPP
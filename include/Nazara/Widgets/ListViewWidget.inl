@@ -0,0 +1,30 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Widgets module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Widgets/Debug.hpp>
+
+namespace Nz
+{
+	inline std::size_t ListViewWidget::GetColumnCount() const
+	{
+		return m_columnCount;
+	}
+
+	inline std::size_t ListViewWidget::GetItemCount() const
+	{
+		return m_itemCount;
+	}
+
+	inline float ListViewWidget::GetItemHeight() const
+	{
+		return m_itemHeight;
+	}
+
+	inline std::size_t ListViewWidget::GetRowCount() const
+	{
+		return (m_itemCount + m_columnCount - 1) / m_columnCount;
+	}
+}
+
+#include <Nazara/Widgets/DebugOff.hpp>
@@ -41,8 +41,11 @@ namespace Nz
 		private:
 			void Layout() override;
 
+			void OnChildPreferredSizeUpdated(const BaseWidget* child) override;
 			bool OnMouseWheelMoved(int x, int y, float delta) override;
 
+			void UpdateContentPosition(float contentHeight, float ratio);
+
 			std::unique_ptr<ScrollAreaWidgetStyle> m_style;
 			BaseWidget* m_content;
 			ScrollbarWidget* m_horizontalScrollbar;
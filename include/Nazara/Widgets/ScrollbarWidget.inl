@@ -37,7 +37,7 @@ namespace Nz
 		m_value = Clamp(newValue, m_minimumValue, m_maximumValue);
 		OnScrollbarValueUpdate(this, m_value);
 
-		Layout();
+		InvalidateLayout();
 	}
 }
 
@@ -25,7 +25,11 @@ SOFTWARE.
 #include <CustomStream.hpp>
 #include <NazaraUtils/Bitset.hpp>
 #include <NazaraUtils/CallOnExit.hpp>
+#include <Nazara/Core/AbstractHash.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/Core.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Utility/Animation.hpp>
 #include <Nazara/Utility/Mesh.hpp>
 #include <Nazara/Utility/Image.hpp>
@@ -37,6 +41,7 @@ SOFTWARE.
 #include <Nazara/Utility/Sequence.hpp>
 #include <Nazara/Utility/SkeletalMesh.hpp>
 #include <Nazara/Utility/Skeleton.hpp>
+#include <Nazara/Utility/SoftwareBuffer.hpp>
 #include <Nazara/Utility/StaticMesh.hpp>
 #include <Nazara/Utility/VertexMapper.hpp>
 #include <Nazara/Utility/Utility.hpp>
@@ -48,6 +53,7 @@ SOFTWARE.
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 #include <limits>
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -382,6 +388,12 @@ Nz::Result<std::shared_ptr<Nz::Animation>, Nz::ResourceLoadingError> LoadAnimati
 		}
 	}
 
+	if (parameters.compress && !anim->Compress(parameters.compression))
+	{
+		NazaraError("failed to compress animation");
+		return Nz::Err(Nz::ResourceLoadingError::Internal);
+	}
+
 	return anim;
 }
 
@@ -389,10 +401,13 @@ Nz::Result<std::shared_ptr<Nz::Animation>, Nz::ResourceLoadingError> LoadAnimati
 /*                             Mesh loading                             */
 /************************************************************************/
 
-using EmbeddedTextures = std::unordered_map<const aiTexture*, std::filesystem::path>;
-using MaterialData = std::unordered_map<unsigned int, std::pair<Nz::UInt32, Nz::ParameterList>>;
+struct EmbeddedTextures
+{
+	std::mutex mutex;
+	std::unordered_map<const aiTexture*, std::filesystem::path> paths;
+};
 
-std::shared_ptr<Nz::SubMesh> ProcessSubMesh(const std::filesystem::path& originPath, const Nz::MeshParams& parameters, const aiScene* scene, const aiMesh* meshData, bool isSkeletalMesh, MaterialData& materialData, const std::unordered_map<const aiBone*, unsigned int>& boneToJointIndex, EmbeddedTextures& embeddedTextures)
+std::shared_ptr<Nz::SubMesh> ProcessSubMesh(const Nz::MeshParams& parameters, const aiMesh* meshData, bool isSkeletalMesh, const std::unordered_map<const aiBone*, unsigned int>& boneToJointIndex)
 {
 	unsigned int indexCount = meshData->mNumFaces * 3;
 	unsigned int vertexCount = meshData->mNumVertices;
@@ -590,180 +605,262 @@ std::shared_ptr<Nz::SubMesh> ProcessSubMesh(const std::filesystem::path& originP
 
 	subMesh->SetMaterialIndex(meshData->mMaterialIndex);
 
-	auto matIt = materialData.find(meshData->mMaterialIndex);
-	if (matIt == materialData.end())
+	return subMesh;
+}
+
+Nz::ParameterList ProcessMaterial(const std::filesystem::path& originPath, const aiScene* scene, const aiMaterial* aiMat, EmbeddedTextures& embeddedTextures)
+{
+	Nz::ParameterList matData;
+
+	auto ConvertColor = [&] (const char* aiKey, unsigned int aiType, unsigned int aiIndex, const char* colorKey)
+	{
+		aiColor4D color;
+		if (aiGetMaterialColor(aiMat, aiKey, aiType, aiIndex, &color) == aiReturn_SUCCESS)
+		{
+			matData.SetParameter(colorKey, Nz::Color(color.r, color.g, color.b, color.a));
+			return true;
+		}
+
+		return false;
+	};
+
+	auto SaveEmbeddedTextureToFile = [](const aiTexture* embeddedTexture, const std::filesystem::path& basePath, const char* filename) -> std::filesystem::path
 	{
-		Nz::ParameterList matData;
-		const aiMaterial* aiMat = scene->mMaterials[meshData->mMaterialIndex];
+		if (basePath.empty())
+		{
+			NazaraError("can't create embedded resource folder (empty base path)");
+			return {};
+		}
+
+		std::filesystem::path targetPath = basePath / "embedded";
 
-		auto ConvertColor = [&] (const char* aiKey, unsigned int aiType, unsigned int aiIndex, const char* colorKey)
+		if (!std::filesystem::is_directory(targetPath))
 		{
-			aiColor4D color;
-			if (aiGetMaterialColor(aiMat, aiKey, aiType, aiIndex, &color) == aiReturn_SUCCESS)
+			if (!std::filesystem::create_directory(targetPath))
 			{
-				matData.SetParameter(colorKey, Nz::Color(color.r, color.g, color.b, color.a));
-				return true;
+				NazaraError("can't create embedded resource folder (folder creation failed)");
+				return {};
 			}
+		}
 
-			return false;
-		};
+		targetPath /= std::filesystem::u8path(filename);
 
-		auto SaveEmbeddedTextureToFile = [](const aiTexture* embeddedTexture, const std::filesystem::path& basePath, const char* filename) -> std::filesystem::path
+		if (embeddedTexture->mHeight == 0)
 		{
-			if (basePath.empty())
+			// Compressed data (PNG, JPG, etc.)
+			if (!embeddedTexture->achFormatHint[0])
 			{
-				NazaraError("can't create embedded resource folder (empty base path)");
+				NazaraError("can't create embedded texture file (no format hint)");
 				return {};
 			}
 
-			std::filesystem::path targetPath = basePath / "embedded";
+			targetPath.replace_extension(std::filesystem::u8path(embeddedTexture->achFormatHint));
+
+			if (!Nz::File::WriteWhole(targetPath, embeddedTexture->pcData, embeddedTexture->mWidth))
+				return {};
 
-			if (!std::filesystem::is_directory(targetPath))
+			return targetPath;
+		}
+		else
+		{
+			// Uncompressed data (always ARGB8 it seems)
+			Nz::Image uncompressedData(Nz::ImageType::E2D, Nz::PixelFormat::RGBA8_SRGB, embeddedTexture->mWidth, embeddedTexture->mHeight);
+			const aiTexel* sourceData = embeddedTexture->pcData;
+			Nz::UInt8* imageData = uncompressedData.GetPixels();
+			for (unsigned int y = 0; y < embeddedTexture->mHeight; ++y)
 			{
-				if (!std::filesystem::create_directory(targetPath))
+				for (unsigned int x = 0; x < embeddedTexture->mWidth; ++x)
 				{
-					NazaraError("can't create embedded resource folder (folder creation failed)");
-					return {};
+					*imageData++ = sourceData->r;
+					*imageData++ = sourceData->g;
+					*imageData++ = sourceData->b;
+					*imageData++ = sourceData->a;
+
+					++sourceData;
 				}
 			}
 
-			targetPath /= std::filesystem::u8path(filename);
+			// Compress to PNG
+			targetPath.replace_extension(".png");
+
+			if (!uncompressedData.SaveToFile(targetPath))
+				return {};
+
+			return targetPath;
+		}
+	};
 
-			if (embeddedTexture->mHeight == 0)
+	auto ConvertTexture = [&] (aiTextureType aiType, const char* textureKey, const char* wrapKey = nullptr)
+	{
+		aiString path;
+		aiTextureMapMode mapMode[3];
+		if (aiGetMaterialTexture(aiMat, aiType, 0, &path, nullptr, nullptr, nullptr, nullptr, &mapMode[0], nullptr) == aiReturn_SUCCESS)
+		{
+			if (const aiTexture* embeddedTexture = scene->GetEmbeddedTexture(path.C_Str()))
 			{
-				// Compressed data (PNG, JPG, etc.)
-				if (!embeddedTexture->achFormatHint[0])
-				{
-					NazaraError("can't create embedded texture file (no format hint)");
-					return {};
-				}
+				// Materials are converted concurrently and may share embedded textures
+				std::unique_lock lock(embeddedTextures.mutex);
 
-				targetPath.replace_extension(std::filesystem::u8path(embeddedTexture->achFormatHint));
+				std::filesystem::path embeddedTexturePath;
+				if (auto it = embeddedTextures.paths.find(embeddedTexture); it == embeddedTextures.paths.end())
+				{
+					embeddedTexturePath = SaveEmbeddedTextureToFile(embeddedTexture, originPath, aiScene::GetShortFilename(path.C_Str()));
+					if (embeddedTexturePath.empty())
+						NazaraError("failed to save embedded texture to file");
 
-				if (!Nz::File::WriteWhole(targetPath, embeddedTexture->pcData, embeddedTexture->mWidth))
-					return {};
+					embeddedTextures.paths.emplace(embeddedTexture, embeddedTexturePath);
+				}
+				else
+					embeddedTexturePath = it->second;
 
-				return targetPath;
+				matData.SetParameter(textureKey, Nz::PathToString(embeddedTexturePath));
 			}
 			else
+				matData.SetParameter(textureKey, Nz::PathToString((originPath / std::filesystem::u8path(path.data, path.data + path.length))));
+
+			if (wrapKey)
 			{
-				// Uncompressed data (always ARGB8 it seems)
-				Nz::Image uncompressedData(Nz::ImageType::E2D, Nz::PixelFormat::RGBA8_SRGB, embeddedTexture->mWidth, embeddedTexture->mHeight);
-				const aiTexel* sourceData = embeddedTexture->pcData;
-				Nz::UInt8* imageData = uncompressedData.GetPixels();
-				for (unsigned int y = 0; y < embeddedTexture->mHeight; ++y)
+				Nz::SamplerWrap wrap = Nz::SamplerWrap::Clamp;
+				switch (mapMode[0])
 				{
-					for (unsigned int x = 0; x < embeddedTexture->mWidth; ++x)
-					{
-						*imageData++ = sourceData->r;
-						*imageData++ = sourceData->g;
-						*imageData++ = sourceData->b;
-						*imageData++ = sourceData->a;
-
-						++sourceData;
-					}
+					case aiTextureMapMode_Clamp:
+					case aiTextureMapMode_Decal:
+						wrap = Nz::SamplerWrap::Clamp;
+						break;
+
+					case aiTextureMapMode_Mirror:
+						wrap = Nz::SamplerWrap::MirroredRepeat;
+						break;
+
+					case aiTextureMapMode_Wrap:
+						wrap = Nz::SamplerWrap::Repeat;
+						break;
+
+					default:
+						NazaraWarning("Assimp texture map mode 0x" + Nz::NumberToString(mapMode[0], 16) + " not handled");
+						break;
 				}
 
-				// Compress to PNG
-				targetPath.replace_extension(".png");
+				matData.SetParameter(wrapKey, static_cast<long long>(wrap));
+			}
 
-				if (!uncompressedData.SaveToFile(targetPath))
-					return {};
+			return true;
+		}
 
-				return targetPath;
-			}
-		};
+		return false;
+	};
 
-		auto ConvertTexture = [&] (aiTextureType aiType, const char* textureKey, const char* wrapKey = nullptr)
-		{
-			aiString path;
-			aiTextureMapMode mapMode[3];
-			if (aiGetMaterialTexture(aiMat, aiType, 0, &path, nullptr, nullptr, nullptr, nullptr, &mapMode[0], nullptr) == aiReturn_SUCCESS)
-			{
-				if (const aiTexture* embeddedTexture = scene->GetEmbeddedTexture(path.C_Str()))
-				{
-					std::filesystem::path embeddedTexturePath;
-					if (auto it = embeddedTextures.find(embeddedTexture); it == embeddedTextures.end())
-					{
-						embeddedTexturePath = SaveEmbeddedTextureToFile(embeddedTexture, originPath, aiScene::GetShortFilename(path.C_Str()));
-						if (embeddedTexturePath.empty())
-							NazaraError("failed to save embedded texture to file");
+	ConvertColor(AI_MATKEY_COLOR_AMBIENT,  Nz::MaterialData::AmbientColor);
 
-						embeddedTextures.emplace(embeddedTexture, embeddedTexturePath);
-					}
-					else
-						embeddedTexturePath = it->second;
+	if (!ConvertColor(AI_MATKEY_BASE_COLOR, Nz::MaterialData::BaseColor))
+		ConvertColor(AI_MATKEY_COLOR_DIFFUSE, Nz::MaterialData::BaseColor);
 
-					matData.SetParameter(textureKey, Nz::PathToString(embeddedTexturePath));
-				}
-				else
-					matData.SetParameter(textureKey, Nz::PathToString((originPath / std::filesystem::u8path(path.data, path.data + path.length))));
+	ConvertColor(AI_MATKEY_COLOR_SPECULAR, Nz::MaterialData::SpecularColor);
 
-				if (wrapKey)
-				{
-					Nz::SamplerWrap wrap = Nz::SamplerWrap::Clamp;
-					switch (mapMode[0])
-					{
-						case aiTextureMapMode_Clamp:
-						case aiTextureMapMode_Decal:
-							wrap = Nz::SamplerWrap::Clamp;
-							break;
+	if (!ConvertTexture(aiTextureType_BASE_COLOR, Nz::MaterialData::BaseColorTexturePath, Nz::MaterialData::BaseColorWrap))
+		ConvertTexture(aiTextureType_DIFFUSE, Nz::MaterialData::BaseColorTexturePath, Nz::MaterialData::BaseColorWrap);
 
-						case aiTextureMapMode_Mirror:
-							wrap = Nz::SamplerWrap::MirroredRepeat;
-							break;
+	ConvertTexture(aiTextureType_DIFFUSE_ROUGHNESS, Nz::MaterialData::RoughnessTexturePath, Nz::MaterialData::RoughnessWrap);
+	ConvertTexture(aiTextureType_EMISSIVE,          Nz::MaterialData::EmissiveTexturePath,  Nz::MaterialData::EmissiveWrap);
+	ConvertTexture(aiTextureType_HEIGHT,            Nz::MaterialData::HeightTexturePath,    Nz::MaterialData::HeightWrap);
+	ConvertTexture(aiTextureType_METALNESS,         Nz::MaterialData::MetallicTexturePath,  Nz::MaterialData::MetallicWrap);
+	ConvertTexture(aiTextureType_NORMALS,           Nz::MaterialData::NormalTexturePath,    Nz::MaterialData::NormalWrap);
+	ConvertTexture(aiTextureType_OPACITY,           Nz::MaterialData::AlphaTexturePath,     Nz::MaterialData::AlphaWrap);
+	ConvertTexture(aiTextureType_SPECULAR,          Nz::MaterialData::SpecularTexturePath,  Nz::MaterialData::SpecularWrap);
 
-						case aiTextureMapMode_Wrap:
-							wrap = Nz::SamplerWrap::Repeat;
-							break;
+	aiString name;
+	if (aiGetMaterialString(aiMat, AI_MATKEY_NAME, &name) == aiReturn_SUCCESS)
+		matData.SetParameter(Nz::MaterialData::Name, std::string(name.data, name.length));
 
-						default:
-							NazaraWarning("Assimp texture map mode 0x" + Nz::NumberToString(mapMode[0], 16) + " not handled");
-							break;
-					}
+	int iValue;
+	if (aiGetMaterialInteger(aiMat, AI_MATKEY_TWOSIDED, &iValue) == aiReturn_SUCCESS)
+		matData.SetParameter(Nz::MaterialData::FaceCulling, !iValue);
 
-					matData.SetParameter(wrapKey, static_cast<long long>(wrap));
-				}
+	return matData;
+}
 
-				return true;
-			}
+struct ImportSettings
+{
+	double smoothingAngle;
+	long long triangleLimit;
+	long long vertexLimit;
+	int excludedComponents;
+	unsigned int postProcess;
+};
 
-			return false;
-		};
+ImportSettings GetImportSettings(const Nz::MeshParams& parameters)
+{
+	ImportSettings settings;
+	settings.postProcess = AssimpFlags;
 
-		ConvertColor(AI_MATKEY_COLOR_AMBIENT,  Nz::MaterialData::AmbientColor);
+	if (parameters.optimizeIndexBuffers)
+		settings.postProcess |= aiProcess_ImproveCacheLocality;
 
-		if (!ConvertColor(AI_MATKEY_BASE_COLOR, Nz::MaterialData::BaseColor))
-			ConvertColor(AI_MATKEY_COLOR_DIFFUSE, Nz::MaterialData::BaseColor);
+	settings.smoothingAngle = parameters.custom.GetDoubleParameter("AssimpLoader_SmoothingAngle").GetValueOr(80.0);
+	settings.triangleLimit = parameters.custom.GetIntegerParameter("AssimpLoader_TriangleLimit").GetValueOr(1'000'000);
+	settings.vertexLimit = parameters.custom.GetIntegerParameter("AssimpLoader_VertexLimit").GetValueOr(1'000'000);
 
-		ConvertColor(AI_MATKEY_COLOR_SPECULAR, Nz::MaterialData::SpecularColor);
+	settings.excludedComponents = 0;
 
-		if (!ConvertTexture(aiTextureType_BASE_COLOR, Nz::MaterialData::BaseColorTexturePath, Nz::MaterialData::BaseColorWrap))
-			ConvertTexture(aiTextureType_DIFFUSE, Nz::MaterialData::BaseColorTexturePath, Nz::MaterialData::BaseColorWrap);
+	if (!parameters.vertexDeclaration->HasComponent(Nz::VertexComponent::Color))
+		settings.excludedComponents |= aiComponent_COLORS;
 
-		ConvertTexture(aiTextureType_DIFFUSE_ROUGHNESS, Nz::MaterialData::RoughnessTexturePath, Nz::MaterialData::RoughnessWrap);
-		ConvertTexture(aiTextureType_EMISSIVE,          Nz::MaterialData::EmissiveTexturePath,  Nz::MaterialData::EmissiveWrap);
-		ConvertTexture(aiTextureType_HEIGHT,            Nz::MaterialData::HeightTexturePath,    Nz::MaterialData::HeightWrap);
-		ConvertTexture(aiTextureType_METALNESS,         Nz::MaterialData::MetallicTexturePath,  Nz::MaterialData::MetallicWrap);
-		ConvertTexture(aiTextureType_NORMALS,           Nz::MaterialData::NormalTexturePath,    Nz::MaterialData::NormalWrap);
-		ConvertTexture(aiTextureType_OPACITY,           Nz::MaterialData::AlphaTexturePath,     Nz::MaterialData::AlphaWrap);
-		ConvertTexture(aiTextureType_SPECULAR,          Nz::MaterialData::SpecularTexturePath,  Nz::MaterialData::SpecularWrap);
+	if (!parameters.vertexDeclaration->HasComponent(Nz::VertexComponent::Normal))
+		settings.excludedComponents |= aiComponent_NORMALS;
 
-		aiString name;
-		if (aiGetMaterialString(aiMat, AI_MATKEY_NAME, &name) == aiReturn_SUCCESS)
-			matData.SetParameter(Nz::MaterialData::Name, std::string(name.data, name.length));
+	if (!parameters.vertexDeclaration->HasComponent(Nz::VertexComponent::Tangent))
+		settings.excludedComponents |= aiComponent_TANGENTS_AND_BITANGENTS;
 
-		int iValue;
-		if (aiGetMaterialInteger(aiMat, AI_MATKEY_TWOSIDED, &iValue) == aiReturn_SUCCESS)
-			matData.SetParameter(Nz::MaterialData::FaceCulling, !iValue);
+	if (!parameters.vertexDeclaration->HasComponent(Nz::VertexComponent::TexCoord))
+		settings.excludedComponents |= aiComponent_TEXCOORDS;
+
+	return settings;
+}
+
+std::string ComputeCacheKey(Nz::Stream& stream, const Nz::MeshParams& parameters, const ImportSettings& settings)
+{
+	std::unique_ptr<Nz::AbstractHash> hash = Nz::AbstractHash::Get(Nz::HashType::SHA1);
+	hash->Begin();
+
+	auto AppendValue = [&](const auto& value)
+	{
+		hash->Append(reinterpret_cast<const Nz::UInt8*>(&value), sizeof(value));
+	};
+
+	Nz::HashAppend(*hash, stream);
 
-		matIt = materialData.insert(std::make_pair(meshData->mMaterialIndex, std::make_pair(Nz::UInt32(materialData.size()), std::move(matData)))).first;
+	// Everything affecting the post-processed scene or its conversion
+	AppendValue(settings.postProcess);
+	AppendValue(settings.smoothingAngle);
+	AppendValue(settings.triangleLimit);
+	AppendValue(settings.vertexLimit);
+	AppendValue(settings.excludedComponents);
+
+	for (const auto& component : parameters.vertexDeclaration->GetComponents())
+	{
+		AppendValue(component.component);
+		AppendValue(component.type);
+		AppendValue(component.componentIndex);
 	}
 
-	return subMesh;
+	AppendValue(parameters.vertexOffset);
+	AppendValue(parameters.vertexRotation);
+	AppendValue(parameters.vertexScale);
+	AppendValue(parameters.texCoordOffset);
+	AppendValue(parameters.texCoordScale);
+	AppendValue(parameters.animated);
+	AppendValue(parameters.center);
+	AppendValue(parameters.optimizeMesh);
+	AppendValue(parameters.narrowIndices);
+	AppendValue(parameters.lodCount);
+	AppendValue(parameters.lodMaxError);
+	AppendValue(parameters.lodReduction);
+	AppendValue(parameters.compressVertices);
+
+	return hash->End().ToHex();
 }
 
-Nz::Result<std::shared_ptr<Nz::Mesh>, Nz::ResourceLoadingError> LoadMesh(Nz::Stream& stream, const Nz::MeshParams& parameters)
+Nz::Result<std::shared_ptr<Nz::Mesh>, Nz::ResourceLoadingError> ImportMesh(Nz::Stream& stream, const Nz::MeshParams& parameters, const ImportSettings& settings)
 {
 	std::string streamPath = Nz::PathToString(stream.GetPath());
 
@@ -776,39 +873,16 @@ Nz::Result<std::shared_ptr<Nz::Mesh>, Nz::ResourceLoadingError> LoadMesh(Nz::Str
 	fileIO.OpenProc = StreamOpener;
 	fileIO.UserData = reinterpret_cast<char*>(&userdata);
 
-	unsigned int postProcess = AssimpFlags;
-
-	if (parameters.optimizeIndexBuffers)
-		postProcess |= aiProcess_ImproveCacheLocality;
-
-	double smoothingAngle = parameters.custom.GetDoubleParameter("AssimpLoader_SmoothingAngle").GetValueOr(80.0);
-	long long triangleLimit = parameters.custom.GetIntegerParameter("AssimpLoader_TriangleLimit").GetValueOr(1'000'000);
-	long long vertexLimit = parameters.custom.GetIntegerParameter("AssimpLoader_VertexLimit").GetValueOr(1'000'000);
-
-	int excludedComponents = 0;
-
-	if (!parameters.vertexDeclaration->HasComponent(Nz::VertexComponent::Color))
-		excludedComponents |= aiComponent_COLORS;
-
-	if (!parameters.vertexDeclaration->HasComponent(Nz::VertexComponent::Normal))
-		excludedComponents |= aiComponent_NORMALS;
-
-	if (!parameters.vertexDeclaration->HasComponent(Nz::VertexComponent::Tangent))
-		excludedComponents |= aiComponent_TANGENTS_AND_BITANGENTS;
-
-	if (!parameters.vertexDeclaration->HasComponent(Nz::VertexComponent::TexCoord))
-		excludedComponents |= aiComponent_TEXCOORDS;
-
 	aiPropertyStore* properties = aiCreatePropertyStore();
 	Nz::CallOnExit releaseProperties([&] { aiReleasePropertyStore(properties); });
 
-	aiSetImportPropertyFloat(properties,   AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE, float(smoothingAngle));
-	aiSetImportPropertyInteger(properties, AI_CONFIG_PP_SLM_TRIANGLE_LIMIT,      int(triangleLimit));
-	aiSetImportPropertyInteger(properties, AI_CONFIG_PP_SLM_VERTEX_LIMIT,        int(vertexLimit));
-	aiSetImportPropertyInteger(properties, AI_CONFIG_PP_RVC_FLAGS,               excludedComponents);
+	aiSetImportPropertyFloat(properties,   AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE, float(settings.smoothingAngle));
+	aiSetImportPropertyInteger(properties, AI_CONFIG_PP_SLM_TRIANGLE_LIMIT,      int(settings.triangleLimit));
+	aiSetImportPropertyInteger(properties, AI_CONFIG_PP_SLM_VERTEX_LIMIT,        int(settings.vertexLimit));
+	aiSetImportPropertyInteger(properties, AI_CONFIG_PP_RVC_FLAGS,               settings.excludedComponents);
 	aiSetImportPropertyInteger(properties, AI_CONFIG_IMPORT_FBX_PRESERVE_PIVOTS, 0);
 
-	const aiScene* scene = aiImportFileExWithProperties(userdata.originalFilePath, postProcess, &fileIO, properties);
+	const aiScene* scene = aiImportFileExWithProperties(userdata.originalFilePath, settings.postProcess, &fileIO, properties);
 	Nz::CallOnExit releaseScene([&] { aiReleaseImport(scene); });
 
 	releaseProperties.CallAndReset();
@@ -828,9 +902,7 @@ Nz::Result<std::shared_ptr<Nz::Mesh>, Nz::ResourceLoadingError> LoadMesh(Nz::Str
 
 	std::shared_ptr<Nz::Mesh> mesh = std::make_shared<Nz::Mesh>();
 
-	EmbeddedTextures embeddedTextures;
-	MaterialData materialData;
-
+	std::vector<const aiMesh*> meshes;
 	if (handleSkeletalMeshes)
 	{
 		auto& skeletalRoot = sceneInfo.nodes[sceneInfo.skeletonRootIndex];
@@ -846,25 +918,112 @@ Nz::Result<std::shared_ptr<Nz::Mesh>, Nz::ResourceLoadingError> LoadMesh(Nz::Str
 			ProcessJoints(parameters, transformMatrix, invTransformMatrix, skeletalMesh, mesh->GetSkeleton(), sceneInfo.nodes[sceneInfo.skeletonRootIndex].node, jointIndex, sceneInfo.assimpBoneToJointIndex, seenNodes);
 
 		for (auto& skeletalMesh : sceneInfo.skeletalMeshes)
-			mesh->AddSubMesh(ProcessSubMesh(stream.GetDirectory(), parameters, scene, skeletalMesh.mesh, true, materialData, sceneInfo.assimpBoneToJointIndex, embeddedTextures));
+			meshes.push_back(skeletalMesh.mesh);
 	}
 	else
 	{
 		mesh->CreateStatic();
 		for (unsigned int meshIndex = 0; meshIndex < scene->mNumMeshes; ++meshIndex)
-			mesh->AddSubMesh(ProcessSubMesh(stream.GetDirectory(), parameters, scene, scene->mMeshes[meshIndex], false, materialData, {}, embeddedTextures));
+			meshes.push_back(scene->mMeshes[meshIndex]);
+	}
 
-		if (parameters.center)
-			mesh->Recenter();
+	// Materials are numbered in order of first use
+	std::vector<unsigned int> usedMaterials;
+	std::unordered_set<unsigned int> seenMaterials;
+	for (const aiMesh* meshData : meshes)
+	{
+		if (seenMaterials.insert(meshData->mMaterialIndex).second)
+			usedMaterials.push_back(meshData->mMaterialIndex);
 	}
 
-	mesh->SetMaterialCount(std::max(Nz::UInt32(materialData.size()), Nz::UInt32(1)));
-	for (const auto& pair : materialData)
-		mesh->SetMaterialData(pair.second.first, pair.second.second);
+	std::filesystem::path originPath = stream.GetDirectory();
+
+	EmbeddedTextures embeddedTextures;
+	std::vector<std::shared_ptr<Nz::SubMesh>> subMeshes(meshes.size());
+	std::vector<Nz::ParameterList> materials(usedMaterials.size());
+
+	auto ConvertElements = [&](std::size_t first, std::size_t last)
+	{
+		for (std::size_t i = first; i < last; ++i)
+		{
+			if (i < meshes.size())
+				subMeshes[i] = ProcessSubMesh(parameters, meshes[i], handleSkeletalMeshes, sceneInfo.assimpBoneToJointIndex);
+			else
+			{
+				std::size_t materialIndex = i - meshes.size();
+				materials[materialIndex] = ProcessMaterial(originPath, scene, scene->mMaterials[usedMaterials[materialIndex]], embeddedTextures);
+			}
+		}
+	};
+
+	// Submeshes and materials are independent and can be converted in parallel, as long as buffers are allocated in RAM (renderer buffer factories aren't required to be thread-safe)
+	const auto* bufferFactory = parameters.bufferFactory.target<decltype(&Nz::SoftwareBufferFactory)>();
+	bool parallelConversion = bufferFactory && *bufferFactory == &Nz::SoftwareBufferFactory && parameters.custom.GetBooleanParameter("AssimpLoader_ParallelConversion").GetValueOr(true);
+
+	std::size_t elementCount = meshes.size() + usedMaterials.size();
+	if (parallelConversion && elementCount > 1)
+		Nz::Core::Instance()->GetTaskScheduler().ForEachChunk(elementCount, 1, ConvertElements);
+	else
+		ConvertElements(0, elementCount);
+
+	for (std::shared_ptr<Nz::SubMesh>& subMesh : subMeshes)
+		mesh->AddSubMesh(std::move(subMesh));
+
+	if (!handleSkeletalMeshes && parameters.center)
+		mesh->Recenter();
+
+	mesh->SetMaterialCount(std::max(Nz::SafeCast<Nz::UInt32>(materials.size()), Nz::UInt32(1)));
+	for (std::size_t i = 0; i < materials.size(); ++i)
+		mesh->SetMaterialData(i, std::move(materials[i]));
+
+	if (parameters.optimizeMesh)
+		mesh->Optimize(parameters);
+
+	if (parameters.lodCount > 0)
+		mesh->GenerateLODs(parameters);
+
+	if (parameters.compressVertices)
+		mesh->CompressVertices(parameters);
 
 	return mesh;
 }
 
+Nz::Result<std::shared_ptr<Nz::Mesh>, Nz::ResourceLoadingError> LoadMesh(Nz::Stream& stream, const Nz::MeshParams& parameters)
+{
+	ImportSettings settings = GetImportSettings(parameters);
+
+	// Post-processing is expensive, converted meshes can be cached in the binary mesh format
+	std::filesystem::path cachePath;
+	if (std::string cacheDirectory = parameters.custom.GetStringParameter("AssimpLoader_CacheDirectory").GetValueOr(std::string{}); !cacheDirectory.empty())
+	{
+		cachePath = std::filesystem::u8path(cacheDirectory) / std::filesystem::u8path(ComputeCacheKey(stream, parameters, settings) + ".nzmesh");
+
+		std::error_code ec;
+		if (std::filesystem::is_regular_file(cachePath, ec))
+		{
+			if (std::shared_ptr<Nz::Mesh> cachedMesh = Nz::Mesh::LoadFromFile(cachePath, parameters))
+				return cachedMesh;
+
+			NazaraWarning("failed to load cached mesh {0}, importing it again", Nz::PathToString(cachePath));
+		}
+	}
+
+	auto result = ImportMesh(stream, parameters, settings);
+	if (result && !cachePath.empty())
+	{
+		std::error_code ec;
+		std::filesystem::create_directories(cachePath.parent_path(), ec);
+
+		if (!result.GetValue()->SaveToFile(cachePath, parameters))
+		{
+			NazaraWarning("failed to save mesh to cache {0}", Nz::PathToString(cachePath));
+			std::filesystem::remove(cachePath, ec);
+		}
+	}
+
+	return result;
+}
+
 namespace
 {
 	class AssimpPluginImpl final : public Nz::AssimpPlugin
@@ -12,6 +12,8 @@ You should have received a copy of the GNU General Public License along with thi
 
 #include <Nazara/Core/Algorithm.hpp>
 #include <Nazara/Core/ByteStream.hpp>
+#include <Nazara/Core/Log.hpp>
+#include <Nazara/Core/ThreadExt.hpp>
 #include <Nazara/Utility/ImageStream.hpp>
 #include <Nazara/Utility/Utility.hpp>
 #include <Nazara/Utility/Plugins/FFmpegPlugin.hpp>
@@ -20,47 +22,63 @@ extern "C"
 {
 	#include <libavcodec/avcodec.h>
 	#include <libavformat/avformat.h>
+	#include <libavutil/hwcontext.h>
 	#include <libavutil/imgutils.h>
 	#include <libswscale/swscale.h>
 }
 
+#include <algorithm>
 #include <array>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace
 {
 	class FFmpegStream : public Nz::ImageStream
 	{
 		public:
+			static constexpr std::size_t DefaultFrameQueueSize = 4;
+
 			FFmpegStream() :
 			m_codec(nullptr),
 			m_codecContext(nullptr),
 			m_formatContext(nullptr),
+			m_hwDeviceContext(nullptr),
 			m_rawFrame(nullptr),
-			m_rgbaFrame(nullptr),
+			m_transferFrame(nullptr),
 			m_ioContext(nullptr),
 			m_conversionContext(nullptr),
+			m_hwPixelFormat(AV_PIX_FMT_NONE),
+			m_frameQueueSize(DefaultFrameQueueSize),
 			m_ioBuffer(nullptr),
-			m_videoStream(-1)
+			m_videoStream(-1),
+			m_hardwareDecoding(true),
+			m_stopDecoding(false)
 			{
 			}
 
 			~FFmpegStream()
 			{
+				StopDecodeThread();
+
 				if (m_conversionContext)
 					sws_freeContext(m_conversionContext);
 
 				if (m_rawFrame)
 					av_frame_free(&m_rawFrame);
 
-				if (m_rgbaFrame)
-					av_frame_free(&m_rgbaFrame);
+				if (m_transferFrame)
+					av_frame_free(&m_transferFrame);
 
 				if (m_codecContext)
 					avcodec_free_context(&m_codecContext);
 
-				if (m_rawFrame)
-					av_frame_free(&m_rawFrame);
+				if (m_hwDeviceContext)
+					av_buffer_unref(&m_hwDeviceContext);
 
 				if (m_formatContext)
 					avformat_close_input(&m_formatContext);
@@ -133,70 +151,29 @@ namespace
 
 			bool DecodeNextFrame(void* frameBuffer, Nz::Time* frameTime) override
 			{
-				AVPacket packet;
-
-				for (;;)
-				{
-					if (int errCode = av_read_frame(m_formatContext, &packet); errCode < 0)
-					{
-						if (errCode == AVERROR_EOF)
-						{
-							if (frameTime)
-							{
-								AVRational timebase = m_formatContext->streams[m_videoStream]->time_base;
-								*frameTime = Nz::Time::Milliseconds(1000 * m_formatContext->streams[m_videoStream]->duration * timebase.num / timebase.den);
-							}
-
-							return false;
-						}
-
-						NazaraError("failed to read frame: {0}", ErrorToString(errCode));
-						return false;
-					}
-
-					if (packet.stream_index != m_videoStream)
-						continue;
+				if (m_frameQueueSize == 0)
+					return DecodeFrame(frameBuffer, frameTime);
 
-					if (int errCode = avcodec_send_packet(m_codecContext, &packet); errCode < 0)
-					{
-						NazaraError("failed to send packet: {0}", ErrorToString(errCode));
-						return false;
-					}
+				if (!m_decodeThread.joinable())
+					StartDecodeThread();
 
-					if (int errCode = avcodec_receive_frame(m_codecContext, m_rawFrame); errCode < 0)
-					{
-						if (errCode == AVERROR(EAGAIN))
-							continue;
+				std::unique_lock lock(m_queueMutex);
+				m_queueCondition.wait(lock, [&] { return !m_decodedFrames.empty(); });
 
-						NazaraError("failed to receive frame: {0}", ErrorToString(errCode));
-						return false;
-					}
-
-					break;
-				}
+				DecodedFrame& decodedFrame = m_decodedFrames.front();
+				if (frameTime)
+					*frameTime = decodedFrame.frameTime;
 
-				sws_scale(m_conversionContext, m_rawFrame->data, m_rawFrame->linesize, 0, m_codecContext->height, m_rgbaFrame->data, m_rgbaFrame->linesize);
+				// The decoding thread stops after the last frame (or an error), keep it in the queue so the next calls fail as well
+				if (!decodedFrame.isValid)
+					return false;
 
-				Nz::UInt8* dst = static_cast<Nz::UInt8*>(frameBuffer);
-				Nz::UInt8* src = m_rgbaFrame->data[0];
-				std::size_t lineSize = m_rgbaFrame->width * 4;
-				if (lineSize != m_rgbaFrame->linesize[0])
-				{
-					for (int i = 0; i < m_rgbaFrame->height; ++i)
-					{
-						std::memcpy(dst, src, lineSize);
-						dst += lineSize;
-						src += m_rgbaFrame->linesize[0];
-					}
-				}
-				else
-					std::memcpy(dst, src, lineSize * m_rgbaFrame->height);
+				if (frameBuffer)
+					std::memcpy(frameBuffer, decodedFrame.pixels.data(), decodedFrame.pixels.size());
 
-				if (frameTime)
-				{
-					AVRational timebase = m_formatContext->streams[m_videoStream]->time_base;
-					*frameTime = Nz::Time::Milliseconds(1000 * m_rawFrame->pts * timebase.num / timebase.den);
-				}
+				m_freeFrames.push_back(std::move(decodedFrame));
+				m_decodedFrames.pop_front();
+				m_queueCondition.notify_all();
 
 				return true;
 			}
@@ -219,8 +196,14 @@ namespace
 				return { width, height };
 			}
 
-			Nz::Result<void, Nz::ResourceLoadingError> Open()
+			Nz::Result<void, Nz::ResourceLoadingError> Open(const Nz::ImageStreamParams& parameters)
 			{
+				if (auto result = parameters.custom.GetBooleanParameter("FFMpegHardwareDecoding"); result.IsOk())
+					m_hardwareDecoding = result.GetValue();
+
+				if (auto result = parameters.custom.GetIntegerParameter("FFMpegFrameQueueSize"); result.IsOk())
+					m_frameQueueSize = Nz::SafeCast<std::size_t>(std::max(result.GetValue(), 0LL));
+
 				auto checkResult = Check();
 				if (!checkResult)
 					return checkResult;
@@ -240,6 +223,10 @@ namespace
 					return Nz::Err(Nz::ResourceLoadingError::Internal);
 				}
 
+				// Hardware decoding is best-effort, software decoding is used if no device is available
+				if (m_hardwareDecoding && !SetupHardwareDecoding())
+					NazaraDebug("no hardware decoder available for {0}, falling back to software decoding", m_codec->name);
+
 				if (int errCode = avcodec_open2(m_codecContext, m_codec, nullptr); errCode < 0)
 				{
 					NazaraError("could not open codec: {0}", ErrorToString(errCode));
@@ -247,38 +234,25 @@ namespace
 				}
 
 				m_rawFrame = av_frame_alloc();
-				m_rgbaFrame = av_frame_alloc();
-				if (!m_rawFrame || !m_rgbaFrame)
+				m_transferFrame = av_frame_alloc();
+				if (!m_rawFrame || !m_transferFrame)
 				{
 					NazaraError("failed to allocate frames");
 					return Nz::Err(Nz::ResourceLoadingError::Internal);
 				}
 
-				m_rgbaFrame->format = AVPixelFormat::AV_PIX_FMT_RGBA;
-				m_rgbaFrame->width = codecParameters->width;
-				m_rgbaFrame->height = codecParameters->height;
-
-				if (int errCode = av_frame_get_buffer(m_rgbaFrame, 0); errCode < 0)
-				{
-					NazaraError("failed to open input: {0}", ErrorToString(errCode));
-					return Nz::Err(Nz::ResourceLoadingError::Internal);
-				}
-
-				m_conversionContext = sws_getContext(m_codecContext->width, m_codecContext->height, m_codecContext->pix_fmt, m_codecContext->width, m_codecContext->height, AVPixelFormat::AV_PIX_FMT_RGBA, SWS_FAST_BILINEAR, nullptr, nullptr, nullptr);
-				if (!m_conversionContext)
-				{
-					NazaraError("failed to allocate conversion context");
-					return Nz::Err(Nz::ResourceLoadingError::Internal);
-				}
-
+				// The conversion context is created on the first frame as hardware decoders output frames in their own format (usually NV12)
 				return Nz::Ok();
 			}
 
 			void Seek(Nz::UInt64 frameIndex) override
 			{
+				StopDecodeThread();
+
 				// TODO
 				avio_seek(m_ioContext, 0, SEEK_SET);
 				avformat_seek_file(m_formatContext, m_videoStream, std::numeric_limits<Nz::Int64>::min(), 0, std::numeric_limits<Nz::Int64>::max(), 0);
+				avcodec_flush_buffers(m_codecContext);
 			}
 
 			bool SetFile(const std::filesystem::path& filePath)
@@ -313,6 +287,187 @@ namespace
 
 
 		private:
+			struct DecodedFrame
+			{
+				std::vector<Nz::UInt8> pixels;
+				Nz::Time frameTime;
+				bool isValid;
+			};
+
+			bool DecodeFrame(void* frameBuffer, Nz::Time* frameTime)
+			{
+				AVPacket packet;
+
+				for (;;)
+				{
+					if (int errCode = av_read_frame(m_formatContext, &packet); errCode < 0)
+					{
+						if (errCode == AVERROR_EOF)
+						{
+							if (frameTime)
+							{
+								AVRational timebase = m_formatContext->streams[m_videoStream]->time_base;
+								*frameTime = Nz::Time::Milliseconds(1000 * m_formatContext->streams[m_videoStream]->duration * timebase.num / timebase.den);
+							}
+
+							return false;
+						}
+
+						NazaraError("failed to read frame: {0}", ErrorToString(errCode));
+						return false;
+					}
+
+					if (packet.stream_index != m_videoStream)
+					{
+						av_packet_unref(&packet);
+						continue;
+					}
+
+					int sendErrCode = avcodec_send_packet(m_codecContext, &packet);
+					av_packet_unref(&packet);
+
+					if (sendErrCode < 0)
+					{
+						NazaraError("failed to send packet: {0}", ErrorToString(sendErrCode));
+						return false;
+					}
+
+					if (int errCode = avcodec_receive_frame(m_codecContext, m_rawFrame); errCode < 0)
+					{
+						if (errCode == AVERROR(EAGAIN))
+							continue;
+
+						NazaraError("failed to receive frame: {0}", ErrorToString(errCode));
+						return false;
+					}
+
+					break;
+				}
+
+				if (frameTime)
+				{
+					AVRational timebase = m_formatContext->streams[m_videoStream]->time_base;
+					*frameTime = Nz::Time::Milliseconds(1000 * m_rawFrame->pts * timebase.num / timebase.den);
+				}
+
+				if (!frameBuffer)
+					return true;
+
+				// Frames decoded by the hardware live in video memory, retrieve them in their native format (NV12/P010) before conversion
+				AVFrame* frame = m_rawFrame;
+				if (m_rawFrame->format == m_hwPixelFormat)
+				{
+					av_frame_unref(m_transferFrame);
+					if (int errCode = av_hwframe_transfer_data(m_transferFrame, m_rawFrame, 0); errCode < 0)
+					{
+						NazaraError("failed to transfer frame from hardware: {0}", ErrorToString(errCode));
+						return false;
+					}
+
+					frame = m_transferFrame;
+				}
+
+				int width = m_codecContext->width;
+				int height = m_codecContext->height;
+
+				// Source and destination have the same size, only the chroma upsampling uses the filter
+				m_conversionContext = sws_getCachedContext(m_conversionContext, width, height, static_cast<AVPixelFormat>(frame->format), width, height, AVPixelFormat::AV_PIX_FMT_RGBA, SWS_FAST_BILINEAR, nullptr, nullptr, nullptr);
+				if (!m_conversionContext)
+				{
+					NazaraError("failed to allocate conversion context");
+					return false;
+				}
+
+				// Convert directly in the output buffer instead of going through an intermediate frame
+				std::array<Nz::UInt8*, 4> dstData = { static_cast<Nz::UInt8*>(frameBuffer), nullptr, nullptr, nullptr };
+				std::array<int, 4> dstLineSize = { width * 4, 0, 0, 0 };
+				sws_scale(m_conversionContext, frame->data, frame->linesize, 0, height, dstData.data(), dstLineSize.data());
+
+				return true;
+			}
+
+			void DecodeThread()
+			{
+				std::size_t frameSize = 4 * Nz::SafeCast<std::size_t>(m_codecContext->width) * Nz::SafeCast<std::size_t>(m_codecContext->height);
+
+				std::unique_lock lock(m_queueMutex);
+				for (;;)
+				{
+					m_queueCondition.wait(lock, [&] { return m_stopDecoding || m_decodedFrames.size() < m_frameQueueSize; });
+					if (m_stopDecoding)
+						return;
+
+					DecodedFrame decodedFrame;
+					if (!m_freeFrames.empty())
+					{
+						decodedFrame = std::move(m_freeFrames.back());
+						m_freeFrames.pop_back();
+					}
+					lock.unlock();
+
+					decodedFrame.pixels.resize(frameSize);
+					decodedFrame.isValid = DecodeFrame(decodedFrame.pixels.data(), &decodedFrame.frameTime);
+					bool isValid = decodedFrame.isValid;
+
+					lock.lock();
+					m_decodedFrames.push_back(std::move(decodedFrame));
+					m_queueCondition.notify_all();
+
+					if (!isValid)
+						return;
+				}
+			}
+
+			bool SetupHardwareDecoding()
+			{
+				for (int i = 0;; ++i)
+				{
+					const AVCodecHWConfig* hwConfig = avcodec_get_hw_config(m_codec, i);
+					if (!hwConfig)
+						return false;
+
+					if ((hwConfig->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX) == 0)
+						continue;
+
+					// Configurations are listed by the codec, which only exposes the ones supported on this platform (VAAPI, D3D11VA, VideoToolbox, ...)
+					if (av_hwdevice_ctx_create(&m_hwDeviceContext, hwConfig->device_type, nullptr, nullptr, 0) < 0)
+						continue;
+
+					m_hwPixelFormat = hwConfig->pix_fmt;
+					m_codecContext->hw_device_ctx = av_buffer_ref(m_hwDeviceContext);
+					m_codecContext->opaque = this;
+					m_codecContext->get_format = &FFmpegStream::SelectPixelFormat;
+
+					return true;
+				}
+			}
+
+			void StartDecodeThread()
+			{
+				m_stopDecoding = false;
+				m_decodeThread = std::thread(&FFmpegStream::DecodeThread, this);
+				Nz::SetThreadName(m_decodeThread, "NzFFmpegDecoder");
+			}
+
+			void StopDecodeThread()
+			{
+				if (!m_decodeThread.joinable())
+					return;
+
+				{
+					std::unique_lock lock(m_queueMutex);
+					m_stopDecoding = true;
+				}
+				m_queueCondition.notify_all();
+
+				m_decodeThread.join();
+
+				for (DecodedFrame& decodedFrame : m_decodedFrames)
+					m_freeFrames.push_back(std::move(decodedFrame));
+
+				m_decodedFrames.clear();
+			}
+
 			static std::string ErrorToString(int errCode)
 			{
 				// extract error tag
@@ -332,6 +487,19 @@ namespace
 				return errMessage;
 			}
 
+			static AVPixelFormat SelectPixelFormat(AVCodecContext* codecContext, const AVPixelFormat* pixelFormats)
+			{
+				const FFmpegStream& stream = *static_cast<const FFmpegStream*>(codecContext->opaque);
+				for (const AVPixelFormat* pixelFormat = pixelFormats; *pixelFormat != AV_PIX_FMT_NONE; ++pixelFormat)
+				{
+					if (*pixelFormat == stream.m_hwPixelFormat)
+						return *pixelFormat;
+				}
+
+				// The hardware doesn't support this stream (profile, resolution), decode it in software
+				return avcodec_default_get_format(codecContext, pixelFormats);
+			}
+
 			static int Read(void* opaque, Nz::UInt8* buf, int buf_size)
 			{
 				Nz::ByteStream& stream = *static_cast<Nz::ByteStream*>(opaque);
@@ -383,14 +551,24 @@ namespace
 			const AVCodec* m_codec;
 			AVCodecContext* m_codecContext;
 			AVFormatContext* m_formatContext;
+			AVBufferRef* m_hwDeviceContext;
 			AVFrame* m_rawFrame;
-			AVFrame* m_rgbaFrame;
+			AVFrame* m_transferFrame;
 			AVIOContext* m_ioContext;
 			SwsContext* m_conversionContext;
+			AVPixelFormat m_hwPixelFormat;
+			std::condition_variable m_queueCondition;
+			std::deque<DecodedFrame> m_decodedFrames;
+			std::mutex m_queueMutex;
+			std::size_t m_frameQueueSize;
+			std::thread m_decodeThread;
+			std::vector<DecodedFrame> m_freeFrames;
 			void* m_ioBuffer;
 			std::unique_ptr<Nz::Stream> m_ownedStream;
 			Nz::ByteStream m_byteStream;
 			int m_videoStream;
+			bool m_hardwareDecoding;
+			bool m_stopDecoding;
 	};
 
 	bool CheckVideoExtension(std::string_view extension)
@@ -402,30 +580,30 @@ namespace
 		return format->video_codec != AV_CODEC_ID_NONE;
 	}
 
-	Nz::Result<std::shared_ptr<Nz::ImageStream>, Nz::ResourceLoadingError> LoadFile(const std::filesystem::path& filePath, const Nz::ImageStreamParams& /*parameters*/)
+	Nz::Result<std::shared_ptr<Nz::ImageStream>, Nz::ResourceLoadingError> LoadFile(const std::filesystem::path& filePath, const Nz::ImageStreamParams& parameters)
 	{
 		std::shared_ptr<FFmpegStream> ffmpegStream = std::make_shared<FFmpegStream>();
 		ffmpegStream->SetFile(filePath);
 
-		Nz::Result<void, Nz::ResourceLoadingError> status = ffmpegStream->Open();
+		Nz::Result<void, Nz::ResourceLoadingError> status = ffmpegStream->Open(parameters);
 		return status.Map([&] { return std::move(ffmpegStream); });
 	}
 
-	Nz::Result<std::shared_ptr<Nz::ImageStream>, Nz::ResourceLoadingError> LoadMemory(const void* ptr, std::size_t size, const Nz::ImageStreamParams& /*parameters*/)
+	Nz::Result<std::shared_ptr<Nz::ImageStream>, Nz::ResourceLoadingError> LoadMemory(const void* ptr, std::size_t size, const Nz::ImageStreamParams& parameters)
 	{
 		std::shared_ptr<FFmpegStream> ffmpegStream = std::make_shared<FFmpegStream>();
 		ffmpegStream->SetMemory(ptr, size);
 
-		Nz::Result<void, Nz::ResourceLoadingError> status = ffmpegStream->Open();
+		Nz::Result<void, Nz::ResourceLoadingError> status = ffmpegStream->Open(parameters);
 		return status.Map([&] { return std::move(ffmpegStream); });
 	}
 
-	Nz::Result<std::shared_ptr<Nz::ImageStream>, Nz::ResourceLoadingError> LoadStream(Nz::Stream& stream, const Nz::ImageStreamParams& /*parameters*/)
+	Nz::Result<std::shared_ptr<Nz::ImageStream>, Nz::ResourceLoadingError> LoadStream(Nz::Stream& stream, const Nz::ImageStreamParams& parameters)
 	{
 		std::shared_ptr<FFmpegStream> ffmpegStream = std::make_shared<FFmpegStream>();
 		ffmpegStream->SetStream(stream);
 
-		Nz::Result<void, Nz::ResourceLoadingError> status = ffmpegStream->Open();
+		Nz::Result<void, Nz::ResourceLoadingError> status = ffmpegStream->Open(parameters);
 		return status.Map([&] { return std::move(ffmpegStream); });
 	}
 
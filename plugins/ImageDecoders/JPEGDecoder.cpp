@@ -0,0 +1,389 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Image decoders Plugin"
+// For conditions of distribution and use, see copyright notice in Plugin.cpp
+
+#include <JPEGDecoder.hpp>
+#include <StreamData.hpp>
+#include <NazaraUtils/CallOnExit.hpp>
+#include <Nazara/Core/Core.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Utility/PixelFormat.hpp>
+#include <turbojpeg.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+namespace
+{
+	// Below this size, splitting the image costs more than it saves
+	constexpr std::size_t ParallelDecodingMinPixelCount = 1024 * 1024;
+
+	struct OutputFormat
+	{
+		Nz::PixelFormat pixelFormat;
+		int tjFormat;
+	};
+
+	// Baseline single-scan JPEG using restart markers, which can be split in independent strips
+	struct ScanLayout
+	{
+		struct Segment
+		{
+			std::size_t begin;
+			std::size_t end;
+		};
+
+		std::size_t headerSize;        //< everything up to the entropy-coded data, SOS segment included
+		std::size_t heightOffset;      //< offset of the image height in the SOF segment
+		std::vector<Segment> segments; //< entropy-coded data between two restart markers
+		unsigned int mcuHeight;
+		unsigned int mcuRowCount;
+		unsigned int mcusPerRow;
+		unsigned int restartInterval;
+		bool verticalSubsampling;
+	};
+
+	OutputFormat GetOutputFormat(Nz::PixelFormat loadFormat)
+	{
+		switch (loadFormat)
+		{
+			case Nz::PixelFormat::BGR8:  return { Nz::PixelFormat::BGR8, TJPF_BGR };
+			case Nz::PixelFormat::BGRA8: return { Nz::PixelFormat::BGRA8, TJPF_BGRA };
+			case Nz::PixelFormat::L8:    return { Nz::PixelFormat::L8, TJPF_GRAY };
+			case Nz::PixelFormat::RGB8:  return { Nz::PixelFormat::RGB8, TJPF_RGB };
+
+			// Other formats are converted from RGBA8 afterwards
+			default:                     return { Nz::PixelFormat::RGBA8, TJPF_RGBA };
+		}
+	}
+
+	unsigned int ReadUInt16(const Nz::UInt8* ptr)
+	{
+		return (static_cast<unsigned int>(ptr[0]) << 8) | ptr[1];
+	}
+
+	std::optional<ScanLayout> ParseScanLayout(const Nz::UInt8* data, std::size_t size)
+	{
+		ScanLayout layout;
+
+		unsigned int componentCount = 0;
+		unsigned int height = 0;
+		unsigned int width = 0;
+		unsigned int maxHorizontalSampling = 1;
+		unsigned int maxVerticalSampling = 1;
+		unsigned int minVerticalSampling = 4;
+		unsigned int restartInterval = 0;
+		bool frameFound = false;
+
+		std::size_t offset = 2; //< skip SOI
+		for (;;)
+		{
+			if (offset + 4 > size || data[offset] != 0xFF)
+				return std::nullopt;
+
+			Nz::UInt8 marker = data[offset + 1];
+			if (marker == 0xFF)
+			{
+				// Fill byte
+				offset++;
+				continue;
+			}
+
+			if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8))
+			{
+				// Standalone markers (TEM, RSTn, SOI)
+				offset += 2;
+				continue;
+			}
+
+			if (marker == 0xD9)
+				return std::nullopt; //< EOI before any scan
+
+			std::size_t length = ReadUInt16(&data[offset + 2]);
+			if (length < 2 || offset + 2 + length > size)
+				return std::nullopt;
+
+			const Nz::UInt8* segment = &data[offset + 4];
+			std::size_t segmentSize = length - 2;
+
+			if (marker == 0xC0 || marker == 0xC1)
+			{
+				// Baseline and extended sequential Huffman frames
+				if (segmentSize < 6)
+					return std::nullopt;
+
+				height = ReadUInt16(&segment[1]);
+				width = ReadUInt16(&segment[3]);
+				componentCount = segment[5];
+				if (width == 0 || height == 0 || componentCount == 0 || segmentSize < 6 + componentCount * 3)
+					return std::nullopt;
+
+				for (unsigned int i = 0; i < componentCount; ++i)
+				{
+					Nz::UInt8 sampling = segment[6 + i * 3 + 1];
+					maxHorizontalSampling = std::max<unsigned int>(maxHorizontalSampling, sampling >> 4);
+					maxVerticalSampling = std::max<unsigned int>(maxVerticalSampling, sampling & 0x0F);
+					minVerticalSampling = std::min<unsigned int>(minVerticalSampling, sampling & 0x0F);
+				}
+
+				layout.heightOffset = offset + 5;
+				frameFound = true;
+			}
+			else if ((marker >= 0xC2 && marker <= 0xCF) && marker != 0xC4 && marker != 0xC8 && marker != 0xCC)
+			{
+				// Progressive, lossless, hierarchical and arithmetic-coded frames are decoded serially
+				return std::nullopt;
+			}
+			else if (marker == 0xDD)
+			{
+				if (segmentSize < 2)
+					return std::nullopt;
+
+				restartInterval = ReadUInt16(segment);
+			}
+			else if (marker == 0xDA)
+			{
+				// A scan covering only some of the components means there are several scans
+				if (!frameFound || restartInterval == 0 || segmentSize < 1 || segment[0] != componentCount)
+					return std::nullopt;
+
+				layout.headerSize = offset + 2 + length;
+				break;
+			}
+
+			offset += 2 + length;
+		}
+
+		// Single-component scans are never interleaved and use 8x8 MCUs
+		unsigned int mcuWidth = (componentCount == 1) ? 8 : 8 * maxHorizontalSampling;
+		layout.mcuHeight = (componentCount == 1) ? 8 : 8 * maxVerticalSampling;
+		layout.mcusPerRow = (width + mcuWidth - 1) / mcuWidth;
+		layout.mcuRowCount = (height + layout.mcuHeight - 1) / layout.mcuHeight;
+		layout.restartInterval = restartInterval;
+		layout.verticalSubsampling = (componentCount > 1 && minVerticalSampling != maxVerticalSampling);
+
+		// Split entropy-coded data on restart markers
+		std::size_t segmentBegin = layout.headerSize;
+		offset = segmentBegin;
+		for (;;)
+		{
+			const void* markerPtr = (offset < size) ? std::memchr(&data[offset], 0xFF, size - offset) : nullptr;
+			if (!markerPtr)
+				return std::nullopt; //< truncated file
+
+			offset = static_cast<std::size_t>(static_cast<const Nz::UInt8*>(markerPtr) - data);
+			if (offset + 1 >= size)
+				return std::nullopt;
+
+			Nz::UInt8 marker = data[offset + 1];
+			if (marker == 0x00 || marker == 0xFF)
+			{
+				// Stuffed byte or fill byte
+				offset += (marker == 0x00) ? 2 : 1;
+				continue;
+			}
+
+			if (marker >= 0xD0 && marker <= 0xD7)
+			{
+				layout.segments.push_back({ segmentBegin, offset });
+				offset += 2;
+				segmentBegin = offset;
+				continue;
+			}
+
+			if (marker != 0xD9)
+				return std::nullopt; //< DNL or another scan
+
+			layout.segments.push_back({ segmentBegin, offset });
+			break;
+		}
+
+		Nz::UInt64 mcuCount = Nz::UInt64(layout.mcusPerRow) * layout.mcuRowCount;
+		if (layout.segments.size() != (mcuCount + restartInterval - 1) / restartInterval)
+			return std::nullopt;
+
+		return layout;
+	}
+
+	void BuildStrip(const Nz::UInt8* data, const ScanLayout& layout, std::size_t firstSegment, std::size_t lastSegment, unsigned int stripHeight, std::vector<Nz::UInt8>& stripData)
+	{
+		stripData.assign(data, data + layout.headerSize);
+		stripData[layout.heightOffset + 0] = static_cast<Nz::UInt8>(stripHeight >> 8);
+		stripData[layout.heightOffset + 1] = static_cast<Nz::UInt8>(stripHeight & 0xFF);
+
+		for (std::size_t segmentIndex = firstSegment; segmentIndex < lastSegment; ++segmentIndex)
+		{
+			// Restart markers are numbered modulo 8 from the start of the scan
+			if (segmentIndex != firstSegment)
+			{
+				stripData.push_back(0xFF);
+				stripData.push_back(static_cast<Nz::UInt8>(0xD0 + (segmentIndex - firstSegment - 1) % 8));
+			}
+
+			const ScanLayout::Segment& segment = layout.segments[segmentIndex];
+			stripData.insert(stripData.end(), data + segment.begin, data + segment.end);
+		}
+
+		stripData.push_back(0xFF);
+		stripData.push_back(0xD9);
+	}
+
+	bool DecodeStrips(const Nz::UInt8* data, const ScanLayout& layout, unsigned int width, unsigned int height, Nz::UInt8* pixels, std::size_t pitch, int tjFormat)
+	{
+		Nz::TaskScheduler& taskScheduler = Nz::Core::Instance()->GetTaskScheduler();
+		unsigned int workerCount = taskScheduler.GetWorkerCount();
+		if (workerCount == 0)
+			return false;
+
+		// Strips have to start both on a restart marker and on a MCU row
+		Nz::UInt64 unitMcuCount = std::lcm(Nz::UInt64(layout.restartInterval), Nz::UInt64(layout.mcusPerRow));
+		Nz::UInt64 unitMcuRowCount = unitMcuCount / layout.mcusPerRow;
+		Nz::UInt64 unitSegmentCount = unitMcuCount / layout.restartInterval;
+		Nz::UInt64 unitCount = (layout.mcuRowCount + unitMcuRowCount - 1) / unitMcuRowCount;
+		if (unitCount < 2)
+			return false;
+
+		std::size_t stripCount = static_cast<std::size_t>(std::min<Nz::UInt64>(unitCount, workerCount + 1));
+		Nz::UInt64 unitsPerStrip = (unitCount + stripCount - 1) / stripCount;
+		stripCount = static_cast<std::size_t>((unitCount + unitsPerStrip - 1) / unitsPerStrip);
+
+		// Smooth chroma upsampling reads chroma rows across strip boundaries, use replication so seams are invisible
+		int flags = (layout.verticalSubsampling) ? TJFLAG_FASTUPSAMPLE : 0;
+
+		std::atomic_bool failed = false;
+		taskScheduler.ForEachChunk(stripCount, 1, [&](std::size_t firstStrip, std::size_t lastStrip)
+		{
+			tjhandle decompressor = tjInitDecompress();
+			if (!decompressor)
+			{
+				failed = true;
+				return;
+			}
+
+			Nz::CallOnExit destroyDecompressor([&]
+			{
+				tjDestroy(decompressor);
+			});
+
+			std::vector<Nz::UInt8> stripData;
+			for (std::size_t stripIndex = firstStrip; stripIndex < lastStrip; ++stripIndex)
+			{
+				if (failed)
+					return;
+
+				Nz::UInt64 firstUnit = stripIndex * unitsPerStrip;
+				Nz::UInt64 lastUnit = std::min(firstUnit + unitsPerStrip, unitCount);
+
+				std::size_t firstSegment = static_cast<std::size_t>(firstUnit * unitSegmentCount);
+				std::size_t lastSegment = static_cast<std::size_t>(std::min<Nz::UInt64>(lastUnit * unitSegmentCount, layout.segments.size()));
+
+				unsigned int firstRow = static_cast<unsigned int>(firstUnit * unitMcuRowCount * layout.mcuHeight);
+				unsigned int lastRow = static_cast<unsigned int>(std::min<Nz::UInt64>(lastUnit * unitMcuRowCount * layout.mcuHeight, height));
+				unsigned int stripHeight = lastRow - firstRow;
+
+				BuildStrip(data, layout, firstSegment, lastSegment, stripHeight, stripData);
+
+				// Warnings are treated as errors here, the whole image is decoded again serially
+				if (tjDecompress2(decompressor, stripData.data(), static_cast<unsigned long>(stripData.size()), pixels + std::size_t(firstRow) * pitch, int(width), int(pitch), int(stripHeight), tjFormat, flags) != 0)
+				{
+					failed = true;
+					return;
+				}
+			}
+		});
+
+		return !failed;
+	}
+}
+
+bool IsJPEGSupported(std::string_view extension)
+{
+	return extension == ".jpg" || extension == ".jpeg" || extension == ".jpe" || extension == ".jfif";
+}
+
+Nz::Result<std::shared_ptr<Nz::Image>, Nz::ResourceLoadingError> LoadJPEG(Nz::Stream& stream, const Nz::ImageParams& parameters)
+{
+	Nz::UInt8 signature[3];
+	if (!PeekStreamHeader(stream, signature, sizeof(signature)) || signature[0] != 0xFF || signature[1] != 0xD8 || signature[2] != 0xFF)
+		return Nz::Err(Nz::ResourceLoadingError::Unrecognized);
+
+	StreamData streamData;
+	if (!streamData.Load(stream))
+	{
+		NazaraError("failed to read JPEG data");
+		return Nz::Err(Nz::ResourceLoadingError::DecodingError);
+	}
+
+	const Nz::UInt8* data = streamData.GetData();
+	unsigned long dataSize = static_cast<unsigned long>(streamData.GetSize());
+
+	tjhandle decompressor = tjInitDecompress();
+	if (!decompressor)
+	{
+		NazaraError("failed to create JPEG decompressor: {0}", tjGetErrorStr2(nullptr));
+		return Nz::Err(Nz::ResourceLoadingError::Internal);
+	}
+
+	Nz::CallOnExit destroyDecompressor([&]
+	{
+		tjDestroy(decompressor);
+	});
+
+	int width, height, subsampling, colorspace;
+	if (tjDecompressHeader3(decompressor, data, dataSize, &width, &height, &subsampling, &colorspace) != 0)
+		return Nz::Err(Nz::ResourceLoadingError::Unrecognized);
+
+	// TurboJPEG cannot convert CMYK images to RGB
+	if (colorspace == TJCS_CMYK || colorspace == TJCS_YCCK)
+		return Nz::Err(Nz::ResourceLoadingError::Unsupported);
+
+	OutputFormat outputFormat = GetOutputFormat(parameters.loadFormat);
+
+	std::shared_ptr<Nz::Image> image = std::make_shared<Nz::Image>();
+	if (!image->Create(Nz::ImageType::E2D, outputFormat.pixelFormat, width, height, 1, (parameters.levelCount > 0) ? parameters.levelCount : 1))
+	{
+		NazaraError("failed to create image");
+		return Nz::Err(Nz::ResourceLoadingError::Internal);
+	}
+
+	// Decode straight into the image storage
+	Nz::UInt8* pixels = image->GetPixels();
+	std::size_t pitch = std::size_t(width) * Nz::PixelFormatInfo::GetBytesPerPixel(outputFormat.pixelFormat);
+
+	bool decoded = false;
+	if (std::size_t(width) * height >= ParallelDecodingMinPixelCount && parameters.custom.GetBooleanParameter("JPEGParallelDecoding").GetValueOr(true))
+	{
+		if (std::optional<ScanLayout> layout = ParseScanLayout(data, streamData.GetSize()))
+			decoded = DecodeStrips(data, *layout, unsigned(width), unsigned(height), pixels, pitch, outputFormat.tjFormat);
+	}
+
+	if (!decoded)
+	{
+		if (tjDecompress2(decompressor, data, dataSize, pixels, width, int(pitch), height, outputFormat.tjFormat, 0) != 0)
+		{
+			// Warnings (such as a truncated file) still produce an image
+			if (tjGetErrorCode(decompressor) != TJERR_WARNING)
+			{
+				NazaraError("failed to decode JPEG image: {0}", tjGetErrorStr2(decompressor));
+				return Nz::Err(Nz::ResourceLoadingError::DecodingError);
+			}
+
+			NazaraWarning("JPEG image decoded with warnings: {0}", tjGetErrorStr2(decompressor));
+		}
+	}
+
+	if (parameters.loadFormat != Nz::PixelFormat::Undefined && parameters.loadFormat != outputFormat.pixelFormat)
+	{
+		if (!image->Convert(parameters.loadFormat))
+		{
+			NazaraError("failed to convert image to required format");
+			return Nz::Err(Nz::ResourceLoadingError::Internal);
+		}
+	}
+
+	return image;
+}
@@ -0,0 +1,21 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Image decoders Plugin"
+// For conditions of distribution and use, see copyright notice in Plugin.cpp
+
+#pragma once
+
+#ifndef NAZARA_IMAGEDECODERS_JPEGDECODER_HPP
+#define NAZARA_IMAGEDECODERS_JPEGDECODER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <NazaraUtils/Result.hpp>
+#include <Nazara/Core/Enums.hpp>
+#include <Nazara/Core/Stream.hpp>
+#include <Nazara/Utility/Image.hpp>
+#include <memory>
+#include <string_view>
+
+bool IsJPEGSupported(std::string_view extension);
+Nz::Result<std::shared_ptr<Nz::Image>, Nz::ResourceLoadingError> LoadJPEG(Nz::Stream& stream, const Nz::ImageParams& parameters);
+
+#endif // NAZARA_IMAGEDECODERS_JPEGDECODER_HPP
@@ -0,0 +1,124 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Image decoders Plugin"
+// For conditions of distribution and use, see copyright notice in Plugin.cpp
+
+#include <PNGDecoder.hpp>
+#include <StreamData.hpp>
+#include <NazaraUtils/CallOnExit.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <spng.h>
+#include <cstring>
+
+namespace
+{
+	constexpr Nz::UInt8 PNGSignature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+	struct OutputFormat
+	{
+		Nz::PixelFormat pixelFormat;
+		int spngFormat;
+	};
+
+	OutputFormat GetOutputFormat(Nz::PixelFormat loadFormat, const spng_ihdr& header)
+	{
+		switch (loadFormat)
+		{
+			case Nz::PixelFormat::RGB8:
+				return { Nz::PixelFormat::RGB8, SPNG_FMT_RGB8 };
+
+			case Nz::PixelFormat::L8:
+			{
+				// libspng only outputs grayscale from grayscale images of 8 bits or less
+				if (header.color_type == SPNG_COLOR_TYPE_GRAYSCALE && header.bit_depth <= 8)
+					return { Nz::PixelFormat::L8, SPNG_FMT_G8 };
+
+				break;
+			}
+
+			default:
+				break;
+		}
+
+		// Other formats are converted from RGBA8 afterwards
+		return { Nz::PixelFormat::RGBA8, SPNG_FMT_RGBA8 };
+	}
+}
+
+bool IsPNGSupported(std::string_view extension)
+{
+	return extension == ".png";
+}
+
+Nz::Result<std::shared_ptr<Nz::Image>, Nz::ResourceLoadingError> LoadPNG(Nz::Stream& stream, const Nz::ImageParams& parameters)
+{
+	Nz::UInt8 signature[sizeof(PNGSignature)];
+	if (!PeekStreamHeader(stream, signature, sizeof(signature)) || std::memcmp(signature, PNGSignature, sizeof(PNGSignature)) != 0)
+		return Nz::Err(Nz::ResourceLoadingError::Unrecognized);
+
+	StreamData streamData;
+	if (!streamData.Load(stream))
+	{
+		NazaraError("failed to read PNG data");
+		return Nz::Err(Nz::ResourceLoadingError::DecodingError);
+	}
+
+	// Chunk CRCs already catch corrupted data, skipping the zlib Adler-32 check saves a pass over the pixels
+	spng_ctx* context = spng_ctx_new(SPNG_CTX_IGNORE_ADLER32);
+	if (!context)
+	{
+		NazaraError("failed to create PNG decoding context");
+		return Nz::Err(Nz::ResourceLoadingError::Internal);
+	}
+
+	Nz::CallOnExit freeContext([&]
+	{
+		spng_ctx_free(context);
+	});
+
+	if (int err = spng_set_png_buffer(context, streamData.GetData(), streamData.GetSize()); err != 0)
+	{
+		NazaraError("failed to set PNG buffer: {0}", spng_strerror(err));
+		return Nz::Err(Nz::ResourceLoadingError::Internal);
+	}
+
+	spng_ihdr header;
+	if (int err = spng_get_ihdr(context, &header); err != 0)
+	{
+		NazaraError("failed to read PNG header: {0}", spng_strerror(err));
+		return Nz::Err(Nz::ResourceLoadingError::DecodingError);
+	}
+
+	OutputFormat outputFormat = GetOutputFormat(parameters.loadFormat, header);
+
+	std::size_t decodedSize;
+	if (int err = spng_decoded_image_size(context, outputFormat.spngFormat, &decodedSize); err != 0)
+	{
+		NazaraError("failed to compute PNG decoded size: {0}", spng_strerror(err));
+		return Nz::Err(Nz::ResourceLoadingError::Unsupported);
+	}
+
+	std::shared_ptr<Nz::Image> image = std::make_shared<Nz::Image>();
+	if (!image->Create(Nz::ImageType::E2D, outputFormat.pixelFormat, header.width, header.height, 1, (parameters.levelCount > 0) ? parameters.levelCount : 1))
+	{
+		NazaraError("failed to create image");
+		return Nz::Err(Nz::ResourceLoadingError::Internal);
+	}
+
+	// Decode straight into the image storage, expanding palettes and tRNS chunks to an alpha channel
+	if (int err = spng_decode_image(context, image->GetPixels(), decodedSize, outputFormat.spngFormat, SPNG_DECODE_TRNS); err != 0)
+	{
+		NazaraError("failed to decode PNG image: {0}", spng_strerror(err));
+		return Nz::Err(Nz::ResourceLoadingError::DecodingError);
+	}
+
+	if (parameters.loadFormat != Nz::PixelFormat::Undefined && parameters.loadFormat != outputFormat.pixelFormat)
+	{
+		if (!image->Convert(parameters.loadFormat))
+		{
+			NazaraError("failed to convert image to required format");
+			return Nz::Err(Nz::ResourceLoadingError::Internal);
+		}
+	}
+
+	return image;
+}
@@ -0,0 +1,126 @@
+/*
+Nazara Engine - Image decoders Plugin
+
+Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <JPEGDecoder.hpp>
+#include <PNGDecoder.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Utility/Image.hpp>
+#include <Nazara/Utility/Utility.hpp>
+#include <Nazara/Utility/Plugins/ImageDecodersPlugin.hpp>
+#include <memory>
+
+namespace
+{
+	bool FilterParameters(const Nz::ImageParams& parameters)
+	{
+		if (auto result = parameters.custom.GetBooleanParameter("SkipImageDecodersLoader"); result.GetValueOr(false))
+			return false;
+
+		return true;
+	}
+
+	class ImageDecodersPluginImpl final : public Nz::ImageDecodersPlugin
+	{
+		public:
+			bool Activate() override
+			{
+				Nz::Utility* utility = Nz::Utility::Instance();
+				NazaraAssert(utility, "utility module is not instancied");
+
+				// Loaders registered last are tried first, taking precedence over the builtin STB loader
+				Nz::ImageLoader& imageLoader = utility->GetImageLoader();
+
+				Nz::ImageLoader::Entry jpegLoaderEntry;
+				jpegLoaderEntry.extensionSupport = IsJPEGSupported;
+				jpegLoaderEntry.streamLoader = LoadJPEG;
+				jpegLoaderEntry.parameterFilter = FilterParameters;
+
+				m_jpegLoaderEntry = imageLoader.RegisterLoader(std::move(jpegLoaderEntry));
+
+				Nz::ImageLoader::Entry pngLoaderEntry;
+				pngLoaderEntry.extensionSupport = IsPNGSupported;
+				pngLoaderEntry.streamLoader = LoadPNG;
+				pngLoaderEntry.parameterFilter = FilterParameters;
+
+				m_pngLoaderEntry = imageLoader.RegisterLoader(std::move(pngLoaderEntry));
+
+				return true;
+			}
+
+			void Deactivate() override
+			{
+				Nz::Utility* utility = Nz::Utility::Instance();
+				NazaraAssert(utility, "utility module is not instanced");
+
+				Nz::ImageLoader& imageLoader = utility->GetImageLoader();
+				imageLoader.UnregisterLoader(m_jpegLoaderEntry);
+				imageLoader.UnregisterLoader(m_pngLoaderEntry);
+			}
+
+			std::string_view GetDescription() const override
+			{
+				return "Adds faster JPEG and PNG decoding using libjpeg-turbo and libspng";
+			}
+
+			std::string_view GetName() const override
+			{
+				return "Image decoders";
+			}
+
+			Nz::UInt32 GetVersion() const override
+			{
+				return 100;
+			}
+
+		private:
+			const Nz::ImageLoader::Entry* m_jpegLoaderEntry = nullptr;
+			const Nz::ImageLoader::Entry* m_pngLoaderEntry = nullptr;
+	};
+}
+
+#ifdef NAZARA_PLUGINS_STATIC
+namespace Nz
+{
+	std::unique_ptr<ImageDecodersPlugin> PluginProvider<ImageDecodersPlugin>::Instantiate()
+	{
+		return std::make_unique<ImageDecodersPluginImpl>();
+	}
+}
+#else
+extern "C"
+{
+	NAZARA_EXPORT Nz::PluginInterface* PluginLoad()
+	{
+		Nz::Utility* utility = Nz::Utility::Instance();
+		if (!utility)
+		{
+			NazaraError("Utility module must be initialized");
+			return nullptr;
+		}
+
+		std::unique_ptr<ImageDecodersPluginImpl> plugin = std::make_unique<ImageDecodersPluginImpl>();
+		return plugin.release();
+	}
+}
+#endif
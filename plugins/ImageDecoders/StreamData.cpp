@@ -0,0 +1,37 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Image decoders Plugin"
+// For conditions of distribution and use, see copyright notice in Plugin.cpp
+
+#include <StreamData.hpp>
+#include <limits>
+
+bool StreamData::Load(Nz::Stream& stream)
+{
+	Nz::UInt64 streamPos = stream.GetCursorPos();
+	Nz::UInt64 streamSize = stream.GetSize();
+	if (streamPos > streamSize || streamSize - streamPos > std::numeric_limits<std::size_t>::max())
+		return false;
+
+	std::size_t remainingSize = static_cast<std::size_t>(streamSize - streamPos);
+	if (stream.IsMemoryMapped())
+	{
+		m_data = static_cast<const Nz::UInt8*>(stream.GetMappedPointer()) + streamPos;
+		m_size = remainingSize;
+		return true;
+	}
+
+	m_storage.resize(remainingSize);
+	m_size = stream.Read(m_storage.data(), remainingSize);
+	m_data = m_storage.data();
+
+	return m_size == remainingSize;
+}
+
+bool PeekStreamHeader(Nz::Stream& stream, void* buffer, std::size_t size)
+{
+	Nz::UInt64 streamPos = stream.GetCursorPos();
+	std::size_t readSize = stream.Read(buffer, size);
+	stream.SetCursorPos(streamPos);
+
+	return readSize == size;
+}
@@ -0,0 +1,49 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Image decoders Plugin"
+// For conditions of distribution and use, see copyright notice in Plugin.cpp
+
+#pragma once
+
+#ifndef NAZARA_IMAGEDECODERS_STREAMDATA_HPP
+#define NAZARA_IMAGEDECODERS_STREAMDATA_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/Stream.hpp>
+#include <vector>
+
+// Both decoders work on the whole encoded file, memory-mapped streams are used in place and others are read once
+class StreamData
+{
+	public:
+		StreamData() = default;
+		StreamData(const StreamData&) = delete;
+		StreamData(StreamData&&) = delete;
+		~StreamData() = default;
+
+		inline const Nz::UInt8* GetData() const;
+		inline std::size_t GetSize() const;
+
+		bool Load(Nz::Stream& stream);
+
+		StreamData& operator=(const StreamData&) = delete;
+		StreamData& operator=(StreamData&&) = delete;
+
+	private:
+		std::vector<Nz::UInt8> m_storage;
+		const Nz::UInt8* m_data = nullptr;
+		std::size_t m_size = 0;
+};
+
+bool PeekStreamHeader(Nz::Stream& stream, void* buffer, std::size_t size);
+
+inline const Nz::UInt8* StreamData::GetData() const
+{
+	return m_data;
+}
+
+inline std::size_t StreamData::GetSize() const
+{
+	return m_size;
+}
+
+#endif // NAZARA_IMAGEDECODERS_STREAMDATA_HPP
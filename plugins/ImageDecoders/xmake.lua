@@ -0,0 +1,16 @@
+option("imagedecoders", { description = "Build image decoders plugin (libjpeg-turbo and libspng)", default = true, category = "Plugins" })
+
+if has_config("imagedecoders") then
+	add_requires("libjpeg-turbo", "libspng")
+
+	target("PluginImageDecoders")
+		set_group("Plugins")
+		add_rpathdirs("$ORIGIN")
+
+		add_deps("NazaraUtility")
+		add_packages("libjpeg-turbo", "libspng")
+
+		add_headerfiles("**.hpp", "**.inl", { prefixdir = "private", install = false })
+		add_includedirs(".")
+		add_files("**.cpp")
+end
@@ -0,0 +1,115 @@
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/CommandLineParameters.hpp>
+#include <Nazara/Core/PackedArchive.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <charconv>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <string>
+
+namespace
+{
+	template<typename T>
+	std::optional<T> ParseNumber(std::string_view str)
+	{
+		T value;
+		auto [ptr, err] = std::from_chars(str.data(), str.data() + str.size(), value);
+		if (err != std::errc{} || ptr != str.data() + str.size())
+			return std::nullopt;
+
+		return value;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	Nz::CommandLineParameters cmdParams = Nz::CommandLineParameters::Parse(argc, argv);
+
+	std::string_view input;
+	std::string_view output;
+	if (cmdParams.HasFlag("help") || !cmdParams.GetParameter("input", &input) || !cmdParams.GetParameter("output", &output))
+	{
+		std::cout << "Packs the content of a directory into an archive which can be mounted using VirtualDirectoryArchiveResolver\n\n";
+		std::cout << "Usage: NazaraArchivePacker --input=<directory> --output=<archive> [options]\n";
+		std::cout << "Options:\n";
+		std::cout << "  --alignment=<bytes>     alignment of files in the archive (default: 16, use the page size to map files individually)\n";
+		std::cout << "  --compression=<method>  none, lz4 or zstd (default: lz4)\n";
+		std::cout << "  --level=<level>         compression level, lz4 switches to high compression when set (default: 0, compressor default)\n";
+		std::cout << "  --max-ratio=<ratio>     files which don't compress below this ratio are stored uncompressed (default: 0.9)\n";
+		return (cmdParams.HasFlag("help")) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	Nz::PackedArchive::BuildParams buildParams;
+
+	std::string_view value;
+	if (cmdParams.GetParameter("alignment", &value))
+	{
+		std::optional<Nz::UInt64> alignment = ParseNumber<Nz::UInt64>(value);
+		if (!alignment || *alignment == 0)
+		{
+			std::cerr << "invalid alignment " << value << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		buildParams.alignment = *alignment;
+	}
+
+	if (cmdParams.GetParameter("compression", &value))
+	{
+		if (value == "none")
+			buildParams.compression = Nz::ArchiveCompression::None;
+		else if (value == "lz4")
+			buildParams.compression = Nz::ArchiveCompression::LZ4;
+		else if (value == "zstd")
+			buildParams.compression = Nz::ArchiveCompression::Zstd;
+		else
+		{
+			std::cerr << "unknown compression " << value << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (cmdParams.GetParameter("level", &value))
+	{
+		std::optional<int> level = ParseNumber<int>(value);
+		if (!level)
+		{
+			std::cerr << "invalid compression level " << value << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		buildParams.compressionLevel = *level;
+	}
+
+	if (cmdParams.GetParameter("max-ratio", &value))
+	{
+		// std::from_chars for floating points isn't available everywhere
+		try
+		{
+			buildParams.maxCompressionRatio = std::stof(std::string(value));
+		}
+		catch (const std::exception&)
+		{
+			std::cerr << "invalid compression ratio " << value << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	std::filesystem::path inputPath = Nz::Utf8Path(input);
+	if (!std::filesystem::is_directory(inputPath))
+	{
+		std::cerr << input << " is not a directory" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	Nz::MillisecondClock clock;
+	if (!Nz::PackedArchive::Build(Nz::Utf8Path(output), inputPath, buildParams))
+	{
+		std::cerr << "failed to build archive" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << "built " << output << " in " << clock.GetElapsedTime() << std::endl;
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,194 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Audio/Algorithm.hpp>
+#include <Nazara/Math/Simd.hpp>
+#include <algorithm>
+#include <cmath>
+#include <Nazara/Audio/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup audio
+	* \brief Converts floating-point samples (in the [-1; 1] range) to 16 bits integer samples
+	*
+	* \param input Input samples
+	* \param output Output samples
+	* \param sampleCount Number of samples (frames times channels)
+	*
+	* \remark Samples out of range are clamped, values are rounded to the nearest integer
+	*/
+	void ConvertSamples(const float* input, Int16* output, UInt64 sampleCount)
+	{
+		UInt64 i = 0;
+#if defined(NAZARA_MATH_SIMD_SSE2)
+		const __m128 scale = _mm_set1_ps(32768.f);
+		const __m128 minValue = _mm_set1_ps(-32768.f);
+		const __m128 maxValue = _mm_set1_ps(32767.f);
+		for (; i + 8 <= sampleCount; i += 8)
+		{
+			__m128 first = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(&input[i]), scale), minValue), maxValue);
+			__m128 second = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(&input[i + 4]), scale), minValue), maxValue);
+
+			__m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(first), _mm_cvtps_epi32(second));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&output[i]), packed);
+		}
+#endif
+
+		for (; i < sampleCount; ++i)
+			output[i] = static_cast<Int16>(std::lrint(std::clamp(input[i] * 32768.f, -32768.f, 32767.f)));
+	}
+
+	/*!
+	* \ingroup audio
+	* \brief Converts 16 bits integer samples to floating-point samples in the [-1; 1] range
+	*
+	* \param input Input samples
+	* \param output Output samples
+	* \param sampleCount Number of samples (frames times channels)
+	*/
+	void ConvertSamples(const Int16* input, float* output, UInt64 sampleCount)
+	{
+		constexpr float InvScale = 1.f / 32768.f;
+
+		UInt64 i = 0;
+#if defined(NAZARA_MATH_SIMD_SSE2)
+		const __m128 invScale = _mm_set1_ps(InvScale);
+		for (; i + 8 <= sampleCount; i += 8)
+		{
+			__m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[i]));
+
+			// Sign-extend by placing each sample in the high half of a 32 bits lane before shifting it back
+			__m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+			__m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+
+			_mm_storeu_ps(&output[i], _mm_mul_ps(_mm_cvtepi32_ps(low), invScale));
+			_mm_storeu_ps(&output[i + 4], _mm_mul_ps(_mm_cvtepi32_ps(high), invScale));
+		}
+#endif
+
+		for (; i < sampleCount; ++i)
+			output[i] = input[i] * InvScale;
+	}
+
+	/*!
+	* \ingroup audio
+	* \brief Converts planar integer samples of any bit depth to interleaved 16 bits integer samples
+	*
+	* This is the layout produced by most lossless decoders (one buffer of 32 bits integers per channel, each holding bitsPerSample significant bits).
+	*
+	* \param channels Array of channelCount pointers to the channel samples
+	* \param channelCount Number of channels
+	* \param bitsPerSample Number of significant bits of input samples (from 1 to 32)
+	* \param output Output buffer, receiving frameCount * channelCount interleaved samples
+	* \param frameCount Number of frames
+	*/
+	void ConvertSamples(const Int32* const* channels, UInt32 channelCount, UInt32 bitsPerSample, Int16* output, UInt64 frameCount)
+	{
+		NazaraAssert(bitsPerSample >= 1 && bitsPerSample <= 32, "invalid bits per sample");
+
+		int rightShift = (bitsPerSample > 16) ? int(bitsPerSample - 16) : 0;
+		int leftShift = (bitsPerSample < 16) ? int(16 - bitsPerSample) : 0;
+
+		UInt64 i = 0;
+#if defined(NAZARA_MATH_SIMD_SSE2)
+		if (channelCount <= 2)
+		{
+			const __m128i rightShiftCount = _mm_cvtsi32_si128(rightShift);
+			const __m128i leftShiftCount = _mm_cvtsi32_si128(leftShift);
+
+			auto LoadConverted = [&](const Int32* samples)
+			{
+				__m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples));
+				__m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + 4));
+
+				first = _mm_sll_epi32(_mm_sra_epi32(first, rightShiftCount), leftShiftCount);
+				second = _mm_sll_epi32(_mm_sra_epi32(second, rightShiftCount), leftShiftCount);
+
+				return _mm_packs_epi32(first, second);
+			};
+
+			if (channelCount == 1)
+			{
+				for (; i + 8 <= frameCount; i += 8)
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(&output[i]), LoadConverted(&channels[0][i]));
+			}
+			else
+			{
+				for (; i + 8 <= frameCount; i += 8)
+				{
+					__m128i left = LoadConverted(&channels[0][i]);
+					__m128i right = LoadConverted(&channels[1][i]);
+
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(&output[i * 2]), _mm_unpacklo_epi16(left, right));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(&output[i * 2 + 8]), _mm_unpackhi_epi16(left, right));
+				}
+			}
+		}
+#endif
+
+		for (; i < frameCount; ++i)
+		{
+			for (UInt32 channelIndex = 0; channelIndex < channelCount; ++channelIndex)
+			{
+				Int32 sample = channels[channelIndex][i];
+				sample >>= rightShift;
+				sample = static_cast<Int32>(static_cast<UInt32>(sample) << leftShift);
+
+				output[i * channelCount + channelIndex] = static_cast<Int16>(sample);
+			}
+		}
+	}
+
+	/*!
+	* \ingroup audio
+	* \brief Mixes 16 bits integer channels in mono
+	*
+	* Produces the same result as the generic version (truncated mean of the channels), stereo being vectorized.
+	*
+	* \param input Input buffer with multiples channels
+	* \param output Output buffer for mono
+	* \param channelCount Number of channels
+	* \param frameCount Number of frames
+	*
+	* \remark The input buffer may be the same as the output one
+	*/
+	void MixToMono(const Int16* input, Int16* output, UInt32 channelCount, UInt64 frameCount)
+	{
+		UInt64 i = 0;
+#if defined(NAZARA_MATH_SIMD_SSE2)
+		if (channelCount == 2)
+		{
+			const __m128i ones = _mm_set1_epi16(1);
+			for (; i + 8 <= frameCount; i += 8)
+			{
+				// Every load happens before the store, and output index never exceeds input index, which keeps in-place mixing valid
+				__m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[i * 2]));
+				__m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[i * 2 + 8]));
+
+				// Sums adjacent (left, right) pairs into 32 bits integers
+				__m128i firstSums = _mm_madd_epi16(first, ones);
+				__m128i secondSums = _mm_madd_epi16(second, ones);
+
+				// Divide by two, rounding towards zero as integer division does
+				firstSums = _mm_srai_epi32(_mm_add_epi32(firstSums, _mm_srli_epi32(firstSums, 31)), 1);
+				secondSums = _mm_srai_epi32(_mm_add_epi32(secondSums, _mm_srli_epi32(secondSums, 31)), 1);
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(&output[i]), _mm_packs_epi32(firstSums, secondSums));
+			}
+		}
+#endif
+
+		// Int16 sums of up to 65536 channels fit in 32 bits
+		for (; i < frameCount; ++i)
+		{
+			Int32 acc = 0;
+			for (UInt32 j = 0; j < channelCount; ++j)
+				acc += input[i * channelCount + j];
+
+			output[i] = static_cast<Int16>(acc / Int32(channelCount));
+		}
+	}
+}
@@ -10,6 +10,7 @@
 #include <Nazara/Audio/Enums.hpp>
 #include <Nazara/Audio/OpenALDevice.hpp>
 #include <Nazara/Audio/OpenALLibrary.hpp>
+#include <Nazara/Audio/Formats/CompressedSoundBufferLoader.hpp>
 #include <Nazara/Audio/Formats/drwavLoader.hpp>
 #include <Nazara/Audio/Formats/libflacLoader.hpp>
 #include <Nazara/Audio/Formats/libvorbisLoader.hpp>
@@ -61,34 +62,63 @@ namespace Nz
 		m_soundBufferLoader.RegisterLoader(Loaders::GetSoundBufferLoader_minimp3());
 		m_soundStreamLoader.RegisterLoader(Loaders::GetSoundStreamLoader_minimp3());
 
+		// Registered last so it's tried first, falling back to decoding loaders for sounds it doesn't keep compressed
+		m_soundBufferLoader.RegisterLoader(Loaders::GetSoundBufferLoader_Compressed());
+
 		if (s_openalLibrary.IsLoaded())
 		{
-			try
-			{
-				m_defaultDevice = s_openalLibrary.OpenDevice();
-			}
-			catch (const std::exception& e)
+			// Opening the device initializes the audio driver which can take a while, open it in the background while other modules initialize
+			m_defaultDevice = std::async(std::launch::async, [allowDummyDevice = config.allowDummyDevice]() -> std::shared_ptr<AudioDevice>
 			{
-				if (!config.allowDummyDevice)
-					throw;
-
-				NazaraError("failed to open default OpenAL device: {0}", e.what());
-			}
+				std::shared_ptr<AudioDevice> device;
+				try
+				{
+					device = s_openalLibrary.OpenDevice();
+				}
+				catch (const std::exception& e)
+				{
+					if (!allowDummyDevice)
+						throw;
+
+					NazaraError("failed to open default OpenAL device: {0}", e.what());
+				}
+
+				if (!device)
+					device = std::make_shared<DummyAudioDevice>();
+
+				return device;
+			}).share();
+
+			// Without a fallback, failing to open the device must make the module fail to initialize
+			if (!config.allowDummyDevice)
+				m_defaultDevice.get();
 		}
+		else
+		{
+			std::promise<std::shared_ptr<AudioDevice>> dummyDevice;
+			dummyDevice.set_value(std::make_shared<DummyAudioDevice>());
 
-		if (!m_defaultDevice)
-			m_defaultDevice = std::make_shared<DummyAudioDevice>();
+			m_defaultDevice = dummyDevice.get_future().share();
+		}
 	}
 
 	Audio::~Audio()
 	{
-		m_defaultDevice.reset();
+		// Wait for the device to be opened before releasing it
+		m_defaultDevice.wait();
+		m_defaultDevice = {};
+
 		s_openalLibrary.Unload();
 	}
 
+	/*!
+	* \brief Gets the default output device
+	*
+	* \remark The device is opened in the background when the module is initialized, this waits for it on first call
+	*/
 	const std::shared_ptr<AudioDevice>& Audio::GetDefaultDevice() const
 	{
-		return m_defaultDevice;
+		return m_defaultDevice.get();
 	}
 
 	/*!
@@ -3,9 +3,34 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Audio/AudioDevice.hpp>
+#include <Nazara/Audio/AudioStreamer.hpp>
+#include <Nazara/Audio/AudioVoiceManager.hpp>
 #include <Nazara/Audio/Debug.hpp>
 
 namespace Nz
 {
+	AudioDevice::AudioDevice() = default;
 	AudioDevice::~AudioDevice() = default;
+
+	/*!
+	* \brief Gets the streamer shared by every streamed source (such as Music) of this device
+	* \return Streamer of the device, started on first use
+	*/
+	AudioStreamer& AudioDevice::GetStreamer()
+	{
+		std::call_once(m_streamerFlag, [this] { m_streamer = std::make_unique<AudioStreamer>(); });
+
+		return *m_streamer;
+	}
+
+	/*!
+	* \brief Gets the voice manager of this device, which gives device sources to the most audible sound emitters
+	* \return Voice manager of the device, created on first use
+	*/
+	AudioVoiceManager& AudioDevice::GetVoiceManager()
+	{
+		std::call_once(m_voiceManagerFlag, [this] { m_voiceManager = std::make_unique<AudioVoiceManager>(*this); });
+
+		return *m_voiceManager;
+	}
 }
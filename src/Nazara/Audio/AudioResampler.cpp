@@ -0,0 +1,307 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Audio/AudioResampler.hpp>
+#include <Nazara/Audio/Algorithm.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Math/Simd.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <Nazara/Audio/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		constexpr double Pi = 3.14159265358979323846;
+		constexpr double KaiserBeta = 8.0; //< around -80dB stopband attenuation
+		constexpr UInt32 MaxHalfTapCount = 1024;
+		constexpr UInt64 ResampleChunkSize = 4096;
+
+		// Zeroth order modified Bessel function of the first kind, used by the Kaiser window
+		double BesselI0(double x)
+		{
+			double sum = 1.0;
+			double term = 1.0;
+			double halfX = x * 0.5;
+			for (unsigned int k = 1; k < 64; ++k)
+			{
+				term *= (halfX / k) * (halfX / k);
+				sum += term;
+				if (term < sum * 1e-12)
+					break;
+			}
+
+			return sum;
+		}
+
+		float DotProduct(const float* samples, const float* coefficients, UInt32 count)
+		{
+			// count is always a multiple of four
+#ifdef NAZARA_MATH_SIMD
+			Simd::Float4 acc = Simd::Splat(0.f);
+			for (UInt32 i = 0; i < count; i += 4)
+				acc = Simd::MulAdd(Simd::Load(&samples[i]), Simd::Load(&coefficients[i]), acc);
+
+			return Simd::HorizontalSum(acc);
+#else
+			float acc = 0.f;
+			for (UInt32 i = 0; i < count; ++i)
+				acc += samples[i] * coefficients[i];
+
+			return acc;
+#endif
+		}
+	}
+
+	/*!
+	* \ingroup audio
+	* \class Nz::AudioResampler
+	* \brief Audio class converting interleaved 16 bits samples from a sample rate to another
+	*
+	* Uses a polyphase windowed-sinc filter (Kaiser window), which band-limits the signal when downsampling.
+	* The filter runs on floating-point samples using the math SIMD helpers.
+	*
+	* Data can be fed by chunks (streaming), the resampler keeps the history it needs between calls.
+	*/
+
+	/*!
+	* \brief Constructs a resampler
+	*
+	* \param channelCount Number of interleaved channels
+	* \param inputRate Sample rate of the input
+	* \param outputRate Sample rate of the output
+	* \param quality Number of zero crossings of the filter on each side of a sample, higher values give a sharper filter at a higher cost
+	*/
+	AudioResampler::AudioResampler(UInt32 channelCount, UInt32 inputRate, UInt32 outputRate, UInt32 quality) :
+	m_channelSamples(channelCount),
+	m_channelCount(channelCount),
+	m_inputRate(inputRate),
+	m_outputRate(outputRate)
+	{
+		NazaraAssert(channelCount > 0, "invalid channel count");
+		NazaraAssert(inputRate > 0 && outputRate > 0, "invalid sample rate");
+		NazaraAssert(quality > 0, "invalid quality");
+
+		// Output sample n is located at input position n * step / denominator
+		UInt32 divisor = std::gcd(inputRate, outputRate);
+		m_phaseDenominator = outputRate / divisor;
+		m_phaseStep = inputRate / divisor;
+		m_phaseCount = std::min(m_phaseDenominator, MaxPhaseCount);
+
+		// When downsampling, the filter cutoff follows the output Nyquist frequency and the filter gets wider
+		double ratio = std::min(1.0, double(outputRate) / inputRate);
+		double cutoff = 0.5 * ratio * 0.95; //< in cycles per input sample, with a small transition band
+
+		m_halfTapCount = std::min(static_cast<UInt32>(std::ceil(quality / ratio)), MaxHalfTapCount);
+		m_tapCount = (2 * m_halfTapCount + 3) & ~3U; //< multiple of four for the dot product
+
+		double windowNorm = 1.0 / BesselI0(KaiserBeta);
+
+		m_filterBank.resize(std::size_t(m_phaseCount) * m_tapCount);
+		for (UInt32 phase = 0; phase < m_phaseCount; ++phase)
+		{
+			float* coefficients = &m_filterBank[std::size_t(phase) * m_tapCount];
+			double fraction = double(phase) / m_phaseCount;
+
+			double sum = 0.0;
+			for (UInt32 tap = 0; tap < m_tapCount; ++tap)
+			{
+				// Distance between the input sample read by this tap and the output position
+				double distance = double(tap) - double(m_halfTapCount - 1) - fraction;
+				double windowPos = distance / m_halfTapCount;
+
+				double value = 0.0;
+				if (std::abs(windowPos) < 1.0)
+				{
+					double x = 2.0 * cutoff * distance;
+					double sinc = (std::abs(x) < 1e-9) ? 1.0 : std::sin(Pi * x) / (Pi * x);
+					double window = BesselI0(KaiserBeta * std::sqrt(1.0 - windowPos * windowPos)) * windowNorm;
+
+					value = 2.0 * cutoff * sinc * window;
+				}
+
+				coefficients[tap] = static_cast<float>(value);
+				sum += value;
+			}
+
+			// Normalize each phase to unity gain so that a constant signal stays constant
+			if (sum > 0.0)
+			{
+				for (UInt32 tap = 0; tap < m_tapCount; ++tap)
+					coefficients[tap] = static_cast<float>(coefficients[tap] / sum);
+			}
+		}
+
+		Reset();
+	}
+
+	/*!
+	* \brief Outputs the remaining frames once every input frame has been processed
+	* \return Number of frames written
+	*
+	* \param output Output buffer, receiving interleaved samples
+	* \param maxFrameCount Maximum number of frames to write, Flush can be called again to get the remaining ones
+	*
+	* \remark Process shouldn't be called after Flush unless Reset is called first
+	*/
+	UInt64 AudioResampler::Flush(Int16* output, UInt64 maxFrameCount)
+	{
+		if (!m_isFlushing)
+		{
+			// Pad with silence so the last input samples reach the center of the filter
+			for (std::vector<float>& samples : m_channelSamples)
+				samples.resize(samples.size() + m_tapCount, 0.f);
+
+			m_isFlushing = true;
+		}
+
+		UInt64 remainingFrameCount = GetOutputFrameCount(m_inputFrameCount) - m_outputFrameCount;
+		UInt64 frameCount = Produce(std::min(maxFrameCount, remainingFrameCount));
+		ConvertSamples(m_outputSamples.data(), output, frameCount * m_channelCount);
+
+		return frameCount;
+	}
+
+	/*!
+	* \brief Computes the number of output frames corresponding to an input frame count
+	* \return Number of output frames, rounded up
+	*
+	* \param inputFrameCount Number of input frames
+	*/
+	UInt64 AudioResampler::GetOutputFrameCount(UInt64 inputFrameCount) const
+	{
+		return (inputFrameCount * m_phaseDenominator + m_phaseStep - 1) / m_phaseStep;
+	}
+
+	/*!
+	* \brief Resamples a chunk of frames
+	* \return Number of frames written
+	*
+	* Input frames are always consumed entirely, frames which didn't fit in the output buffer are kept and returned by the next call.
+	*
+	* \param input Input buffer of interleaved samples (can be null if frameCount is zero)
+	* \param frameCount Number of input frames
+	* \param output Output buffer, receiving interleaved samples
+	* \param maxFrameCount Maximum number of frames to write
+	*/
+	UInt64 AudioResampler::Process(const Int16* input, UInt64 frameCount, Int16* output, UInt64 maxFrameCount)
+	{
+		NazaraAssert(!m_isFlushing, "resampler is being flushed, call Reset first");
+
+		if (frameCount > 0)
+		{
+			for (UInt32 channelIndex = 0; channelIndex < m_channelCount; ++channelIndex)
+			{
+				std::vector<float>& samples = m_channelSamples[channelIndex];
+				std::size_t offset = samples.size();
+				samples.resize(offset + frameCount);
+
+				if (m_channelCount == 1)
+					ConvertSamples(input, &samples[offset], frameCount);
+				else
+				{
+					for (UInt64 i = 0; i < frameCount; ++i)
+						samples[offset + i] = input[i * m_channelCount + channelIndex] * (1.f / 32768.f);
+				}
+			}
+
+			m_inputFrameCount += frameCount;
+		}
+
+		UInt64 producedFrameCount = Produce(maxFrameCount);
+		ConvertSamples(m_outputSamples.data(), output, producedFrameCount * m_channelCount);
+
+		return producedFrameCount;
+	}
+
+	/*!
+	* \brief Resets the resampler to its initial state, discarding pending samples
+	*/
+	void AudioResampler::Reset()
+	{
+		// Silence before the first sample, so that the first output is centered on it
+		for (std::vector<float>& samples : m_channelSamples)
+			samples.assign(m_halfTapCount - 1, 0.f);
+
+		m_inputFrameCount = 0;
+		m_isFlushing = false;
+		m_outputFrameCount = 0;
+		m_phase = 0;
+		m_position = 0;
+	}
+
+	/*!
+	* \brief Resamples a whole buffer
+	* \return Resampled interleaved samples
+	*
+	* \param input Input buffer of interleaved samples
+	* \param frameCount Number of input frames
+	* \param channelCount Number of interleaved channels
+	* \param inputRate Sample rate of the input
+	* \param outputRate Sample rate of the output
+	* \param quality Filter quality (see constructor)
+	*/
+	std::vector<Int16> AudioResampler::Resample(const Int16* input, UInt64 frameCount, UInt32 channelCount, UInt32 inputRate, UInt32 outputRate, UInt32 quality)
+	{
+		if (inputRate == outputRate)
+			return std::vector<Int16>(input, input + frameCount * channelCount);
+
+		AudioResampler resampler(channelCount, inputRate, outputRate, quality);
+
+		UInt64 outputFrameCount = resampler.GetOutputFrameCount(frameCount);
+		std::vector<Int16> output(outputFrameCount * channelCount);
+
+		// Feed the input by chunks to keep the floating-point buffers small
+		UInt64 writtenFrameCount = 0;
+		for (UInt64 offset = 0; offset < frameCount; offset += ResampleChunkSize)
+		{
+			UInt64 chunkSize = std::min(ResampleChunkSize, frameCount - offset);
+			writtenFrameCount += resampler.Process(input + offset * channelCount, chunkSize, output.data() + writtenFrameCount * channelCount, outputFrameCount - writtenFrameCount);
+		}
+
+		writtenFrameCount += resampler.Flush(output.data() + writtenFrameCount * channelCount, outputFrameCount - writtenFrameCount);
+		output.resize(writtenFrameCount * channelCount);
+
+		return output;
+	}
+
+	UInt64 AudioResampler::Produce(UInt64 maxFrameCount)
+	{
+		std::size_t availableSampleCount = m_channelSamples.front().size();
+
+		m_outputSamples.clear();
+
+		UInt64 frameCount = 0;
+		while (frameCount < maxFrameCount && m_position + m_tapCount <= availableSampleCount)
+		{
+			UInt32 phaseIndex = (m_phaseCount == m_phaseDenominator) ? m_phase : static_cast<UInt32>(UInt64(m_phase) * m_phaseCount / m_phaseDenominator);
+			const float* coefficients = &m_filterBank[std::size_t(phaseIndex) * m_tapCount];
+
+			for (const std::vector<float>& samples : m_channelSamples)
+				m_outputSamples.push_back(DotProduct(&samples[m_position], coefficients, m_tapCount));
+
+			m_phase += m_phaseStep;
+			m_position += m_phase / m_phaseDenominator;
+			m_phase %= m_phaseDenominator;
+
+			frameCount++;
+		}
+
+		// Drop samples which won't be read anymore
+		if (m_position > 0)
+		{
+			std::size_t droppedCount = std::min(m_position, availableSampleCount);
+			for (std::vector<float>& samples : m_channelSamples)
+				samples.erase(samples.begin(), samples.begin() + droppedCount);
+
+			m_position -= droppedCount;
+		}
+
+		m_outputFrameCount += frameCount;
+
+		return frameCount;
+	}
+}
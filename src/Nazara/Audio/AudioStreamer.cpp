@@ -0,0 +1,253 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Audio/AudioStreamer.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/ThreadExt.hpp>
+#include <algorithm>
+#include <Nazara/Audio/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup audio
+	* \class Nz::AudioStreamer
+	* \brief Audio class that refills every streamed source of a device from a shared set of threads
+	*
+	* Each stream registers a callback which refills its buffers and reports how much audio is left before it underruns.
+	* Streams are then updated by order of underrun deadline, ahead of it by their prefetch duration, instead of each one polling from its own thread.
+	*/
+
+	/*!
+	* \brief Constructs an AudioStreamer and starts its threads
+	*
+	* \param threadCount Number of threads used to update streams (at least one)
+	*/
+	AudioStreamer::AudioStreamer(std::size_t threadCount) :
+	m_nextStreamId(0),
+	m_isRunning(true)
+	{
+		threadCount = std::max<std::size_t>(threadCount, 1);
+
+		m_threads.reserve(threadCount);
+		for (std::size_t i = 0; i < threadCount; ++i)
+			m_threads.emplace_back(&AudioStreamer::ThreadMain, this);
+	}
+
+	/*!
+	* \brief Stops and joins the streaming threads
+	*
+	* \remark Streams still registered at this point are not updated anymore
+	*/
+	AudioStreamer::~AudioStreamer()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_isRunning = false;
+		}
+		m_queueCondition.notify_all();
+
+		for (std::thread& thread : m_threads)
+			thread.join();
+	}
+
+	/*!
+	* \brief Registers a stream to be updated by the streaming threads
+	* \return Identifier of the stream, to be passed to UnregisterStream
+	*
+	* \param callback Callback refilling the stream, returning the playing time left before underrun (or std::nullopt to unregister the stream)
+	* \param prefetchDuration How long before its underrun deadline the stream should be updated
+	*
+	* \remark The callback will be called as soon as possible after registration
+	*/
+	std::size_t AudioStreamer::RegisterStream(UpdateCallback callback, Time prefetchDuration)
+	{
+		NazaraAssert(callback, "invalid callback");
+
+		std::size_t streamId;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			streamId = m_nextStreamId++;
+
+			StreamData& stream = m_streams[streamId];
+			stream.callback = std::move(callback);
+			stream.prefetchDuration = prefetchDuration;
+
+			Clock::time_point now = Clock::now();
+			PushQueueEntry(m_readyQueue, QueueEntry{ now, now, streamId, stream.generation }, true);
+		}
+		m_queueCondition.notify_one();
+
+		return streamId;
+	}
+
+	/*!
+	* \brief Requests a stream to be updated as soon as possible, regardless of its deadline
+	*
+	* If the stream callback is currently running, it will be called again right after it returns.
+	*
+	* \param streamId Identifier of the stream returned by RegisterStream
+	*/
+	void AudioStreamer::RequestUpdate(std::size_t streamId)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			auto it = m_streams.find(streamId);
+			if (it == m_streams.end())
+				return;
+
+			StreamData& stream = it->second;
+			if (stream.isUpdating)
+			{
+				stream.isUpdateRequested = true;
+				return;
+			}
+
+			// Invalidate the current queue entry of the stream
+			stream.generation++;
+
+			Clock::time_point now = Clock::now();
+			PushQueueEntry(m_readyQueue, QueueEntry{ now, now, streamId, stream.generation }, true);
+		}
+		m_queueCondition.notify_one();
+	}
+
+	/*!
+	* \brief Unregisters a stream
+	*
+	* If the stream callback is currently running on a streaming thread, this waits for it to return.
+	* When called from the stream own callback, the stream is unregistered once the callback returns.
+	*
+	* \param streamId Identifier of the stream returned by RegisterStream
+	*
+	* \remark Stream which callback returned std::nullopt are already unregistered, unregistering them again does nothing
+	*/
+	void AudioStreamer::UnregisterStream(std::size_t streamId)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		auto it = m_streams.find(streamId);
+		if (it == m_streams.end())
+			return;
+
+		StreamData& stream = it->second;
+		if (!stream.isUpdating)
+		{
+			// Its queue entry will be skipped
+			m_streams.erase(it);
+			return;
+		}
+
+		stream.isRemoved = true;
+		if (stream.updatingThread == std::this_thread::get_id())
+			return;
+
+		m_updateCondition.wait(lock, [&] { return m_streams.find(streamId) == m_streams.end(); });
+	}
+
+	void AudioStreamer::PushQueueEntry(std::vector<QueueEntry>& queue, const QueueEntry& entry, bool byDeadline)
+	{
+		queue.push_back(entry);
+		if (byDeadline)
+			std::push_heap(queue.begin(), queue.end(), [](const QueueEntry& lhs, const QueueEntry& rhs) { return lhs.deadline > rhs.deadline; });
+		else
+			std::push_heap(queue.begin(), queue.end(), [](const QueueEntry& lhs, const QueueEntry& rhs) { return lhs.wakeTime > rhs.wakeTime; });
+	}
+
+	auto AudioStreamer::PopQueueEntry(std::vector<QueueEntry>& queue, bool byDeadline) -> QueueEntry
+	{
+		if (byDeadline)
+			std::pop_heap(queue.begin(), queue.end(), [](const QueueEntry& lhs, const QueueEntry& rhs) { return lhs.deadline > rhs.deadline; });
+		else
+			std::pop_heap(queue.begin(), queue.end(), [](const QueueEntry& lhs, const QueueEntry& rhs) { return lhs.wakeTime > rhs.wakeTime; });
+
+		QueueEntry entry = queue.back();
+		queue.pop_back();
+
+		return entry;
+	}
+
+	void AudioStreamer::ThreadMain()
+	{
+		SetCurrentThreadName("AudioStreamer");
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (m_isRunning)
+		{
+			Clock::time_point now = Clock::now();
+
+			// Streams reaching their wake time compete by underrun deadline
+			while (!m_waitingQueue.empty() && m_waitingQueue.front().wakeTime <= now)
+				PushQueueEntry(m_readyQueue, PopQueueEntry(m_waitingQueue, false), true);
+
+			if (m_readyQueue.empty())
+			{
+				if (m_waitingQueue.empty())
+					m_queueCondition.wait(lock);
+				else
+				{
+					// Copy the wake time as other threads may modify the queue while we're waiting
+					Clock::time_point wakeTime = m_waitingQueue.front().wakeTime;
+					m_queueCondition.wait_until(lock, wakeTime);
+				}
+
+				continue;
+			}
+
+			QueueEntry entry = PopQueueEntry(m_readyQueue, true);
+
+			auto it = m_streams.find(entry.streamId);
+			if (it == m_streams.end() || it->second.generation != entry.generation)
+				continue; //< unregistered or rescheduled in the meantime
+
+			// unordered_map references are stable, and the stream cannot be erased by another thread while it's updating
+			StreamData& stream = it->second;
+			stream.isUpdating = true;
+			stream.updatingThread = std::this_thread::get_id();
+
+			lock.unlock();
+
+			std::optional<Time> remainingTime;
+			try
+			{
+				remainingTime = stream.callback();
+			}
+			catch (const std::exception& e)
+			{
+				NazaraError("audio stream update failed: {0}", e.what());
+			}
+
+			lock.lock();
+
+			stream.isUpdating = false;
+			if (stream.isRemoved || !remainingTime)
+			{
+				m_streams.erase(entry.streamId);
+				m_updateCondition.notify_all();
+				continue;
+			}
+
+			now = Clock::now();
+
+			if (stream.isUpdateRequested)
+			{
+				stream.isUpdateRequested = false;
+
+				PushQueueEntry(m_readyQueue, QueueEntry{ now, now, entry.streamId, stream.generation }, true);
+				continue;
+			}
+
+			Clock::time_point deadline = now + std::chrono::duration_cast<Clock::duration>(remainingTime->AsDuration<std::chrono::nanoseconds>());
+			Clock::time_point wakeTime = deadline - std::chrono::duration_cast<Clock::duration>(stream.prefetchDuration.AsDuration<std::chrono::nanoseconds>());
+			wakeTime = std::max(wakeTime, now + std::chrono::duration_cast<Clock::duration>(MinUpdateInterval.AsDuration<std::chrono::nanoseconds>()));
+
+			PushQueueEntry(m_waitingQueue, QueueEntry{ deadline, wakeTime, entry.streamId, stream.generation }, false);
+
+			// Another thread may be sleeping until a later wake time
+			m_queueCondition.notify_one();
+		}
+	}
+}
@@ -0,0 +1,235 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Audio/AudioVoiceManager.hpp>
+#include <Nazara/Audio/AudioDevice.hpp>
+#include <Nazara/Audio/AudioStreamer.hpp>
+#include <Nazara/Audio/VirtualAudioSource.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <algorithm>
+#include <Nazara/Audio/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup audio
+	* \class Nz::AudioVoiceManager
+	* \brief Audio class that limits how many device sources (voices) are used at once, giving them to the most audible sources
+	*
+	* Sources created by the voice manager are virtual: when they aren't audible enough, or when more sources are playing than there are voices,
+	* they keep playing silently without a voice until they get one back.
+	* Sources are ranked by their audibility (volume and distance attenuation) multiplied by their priority, from the device streamer.
+	*/
+
+	/*!
+	* \brief Constructs a voice manager for a device, use AudioDevice::GetVoiceManager instead
+	*
+	* \param device Audio device creating the voices
+	* \param maxVoiceCount Maximum number of voices used at once
+	*/
+	AudioVoiceManager::AudioVoiceManager(AudioDevice& device, std::size_t maxVoiceCount) :
+	m_maxVoiceCount(maxVoiceCount),
+	m_voiceCount(0),
+	m_device(device),
+	m_audibilityThreshold(DefaultAudibilityThreshold)
+	{
+		m_streamId = m_device.GetStreamer().RegisterStream([this]() -> std::optional<Time>
+		{
+			Update();
+			return UpdateInterval;
+		}, Time::Zero());
+	}
+
+	AudioVoiceManager::~AudioVoiceManager()
+	{
+		m_device.GetStreamer().UnregisterStream(m_streamId);
+
+		NazaraAssert(m_sources.empty(), "sources outlived their voice manager");
+	}
+
+	/*!
+	* \brief Creates a virtual source, which will only use a voice while it's audible enough
+	* \return Newly created source
+	*/
+	std::shared_ptr<VirtualAudioSource> AudioVoiceManager::CreateSource()
+	{
+		std::shared_ptr<VirtualAudioSource> source = std::make_shared<VirtualAudioSource>(m_device.shared_from_this(), *this);
+
+		std::lock_guard<std::mutex> lock(m_sourceMutex);
+		m_sources.push_back(source.get());
+
+		return source;
+	}
+
+	/*!
+	* \brief Gets the audibility below which playing sources don't get a voice
+	* \return Audibility threshold, compared to the source volume multiplied by its distance attenuation
+	*/
+	float AudioVoiceManager::GetAudibilityThreshold() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_audibilityThreshold;
+	}
+
+	/*!
+	* \brief Gets the maximum number of voices used at once
+	* \return Maximum voice count
+	*/
+	std::size_t AudioVoiceManager::GetMaxVoiceCount() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_maxVoiceCount;
+	}
+
+	/*!
+	* \brief Gets the number of voices currently in use
+	* \return Voice count
+	*/
+	std::size_t AudioVoiceManager::GetVoiceCount() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_voiceCount;
+	}
+
+	/*!
+	* \brief Sets the audibility below which playing sources don't get a voice
+	*
+	* \param threshold Audibility threshold
+	*/
+	void AudioVoiceManager::SetAudibilityThreshold(float threshold)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_audibilityThreshold = threshold;
+		}
+
+		RequestUpdate();
+	}
+
+	/*!
+	* \brief Sets the maximum number of voices used at once
+	*
+	* \param maxVoiceCount Maximum voice count
+	*
+	* \remark Exceeding voices are reclaimed on the next update
+	*/
+	void AudioVoiceManager::SetMaxVoiceCount(std::size_t maxVoiceCount)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_maxVoiceCount = maxVoiceCount;
+		}
+
+		RequestUpdate();
+	}
+
+	/*!
+	* \brief Gives voices to the most audible playing sources and takes them back from the others
+	*
+	* \remark This is periodically called from the device streamer, calling it manually applies changes immediately
+	*/
+	void AudioVoiceManager::Update()
+	{
+		struct Candidate
+		{
+			VirtualAudioSource* source;
+			float score;
+			bool isVirtual;
+		};
+
+		std::lock_guard<std::mutex> sourceLock(m_sourceMutex);
+		if (m_sources.empty())
+			return;
+
+		float audibilityThreshold;
+		std::size_t maxVoiceCount;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			audibilityThreshold = m_audibilityThreshold;
+			maxVoiceCount = m_maxVoiceCount;
+		}
+
+		Vector3f listenerPosition = m_device.GetListenerPosition();
+
+		std::vector<Candidate> candidates;
+		candidates.reserve(m_sources.size());
+
+		for (VirtualAudioSource* source : m_sources)
+		{
+			VirtualAudioSource::VoiceState state = source->QueryVoiceState(listenerPosition);
+			if (state.status == SoundStatus::Playing && state.audibility >= audibilityThreshold)
+			{
+				candidates.push_back({ source, state.score, state.isVirtual });
+				continue;
+			}
+
+			// Stopped, paused and inaudible sources don't need a voice
+			if (!state.isVirtual)
+			{
+				std::lock_guard<std::recursive_mutex> lock(source->m_mutex);
+				source->Virtualize();
+			}
+		}
+
+		std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate& lhs, const Candidate& rhs) { return lhs.score > rhs.score; });
+
+		// Take voices back before giving them, as there may not be enough free voices otherwise
+		for (std::size_t i = maxVoiceCount; i < candidates.size(); ++i)
+		{
+			const Candidate& candidate = candidates[i];
+			if (!candidate.isVirtual)
+			{
+				std::lock_guard<std::recursive_mutex> lock(candidate.source->m_mutex);
+				candidate.source->Virtualize();
+			}
+		}
+
+		std::size_t voicedCount = std::min(maxVoiceCount, candidates.size());
+		for (std::size_t i = 0; i < voicedCount; ++i)
+		{
+			const Candidate& candidate = candidates[i];
+			if (candidate.isVirtual)
+			{
+				std::lock_guard<std::recursive_mutex> lock(candidate.source->m_mutex);
+				candidate.source->Devirtualize();
+			}
+		}
+	}
+
+	void AudioVoiceManager::ReleaseVoice()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		NazaraAssert(m_voiceCount > 0, "no voice to release");
+		m_voiceCount--;
+	}
+
+	void AudioVoiceManager::RequestUpdate()
+	{
+		m_device.GetStreamer().RequestUpdate(m_streamId);
+	}
+
+	bool AudioVoiceManager::TryReserveVoice()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_voiceCount >= m_maxVoiceCount)
+			return false;
+
+		m_voiceCount++;
+		return true;
+	}
+
+	void AudioVoiceManager::UnregisterSource(VirtualAudioSource* source)
+	{
+		// Waits for a running update (which may be using the source) to end
+		std::lock_guard<std::mutex> lock(m_sourceMutex);
+
+		auto it = std::find(m_sources.begin(), m_sources.end(), source);
+		NazaraAssert(it != m_sources.end(), "source is not registered");
+
+		// Order doesn't matter, sources are ranked on every update
+		std::swap(*it, m_sources.back());
+		m_sources.pop_back();
+	}
+}
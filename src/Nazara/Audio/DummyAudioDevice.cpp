@@ -30,6 +30,11 @@ namespace Nz
 		return std::make_shared<DummyAudioSource>(shared_from_this());
 	}
 
+	void DummyAudioDevice::DeferUpdates()
+	{
+		// Nothing to defer
+	}
+
 	float DummyAudioDevice::GetDopplerFactor() const
 	{
 		return m_dopplerFactor;
@@ -78,6 +83,11 @@ namespace Nz
 		return true;
 	}
 
+	void DummyAudioDevice::ProcessUpdates()
+	{
+		// Nothing to process
+	}
+
 	void DummyAudioDevice::SetDopplerFactor(float dopplerFactor)
 	{
 		m_dopplerFactor = dopplerFactor;
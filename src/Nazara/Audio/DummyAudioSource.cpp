@@ -41,6 +41,8 @@ namespace Nz
 
 	Time DummyAudioSource::GetPlayingOffset() const
 	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
 		if (m_status == SoundStatus::Stopped)
 			return Time::Zero(); //< Always return 0 when stopped, to mimic OpenAL behavior
 
@@ -67,6 +69,8 @@ namespace Nz
 
 	UInt32 DummyAudioSource::GetSampleOffset() const
 	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
 		if (m_status == SoundStatus::Stopped)
 			return 0; //< Always return 0 when stopped, to mimic OpenAL behavior
 
@@ -91,6 +95,8 @@ namespace Nz
 
 	auto DummyAudioSource::GetSampleOffsetAndLatency() const -> OffsetWithLatency
 	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
 		OffsetWithLatency info;
 		info.sampleOffset = GetSampleOffset() * 1000;
 		info.sourceLatency = Time::Zero();
@@ -105,6 +111,8 @@ namespace Nz
 
 	SoundStatus DummyAudioSource::GetStatus() const
 	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
 		UpdateTime();
 
 		return m_status;
@@ -127,6 +135,8 @@ namespace Nz
 
 	void DummyAudioSource::QueueBuffer(std::shared_ptr<AudioBuffer> audioBuffer)
 	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
 		NazaraAssert(audioBuffer, "invalid buffer");
 		NazaraAssert(audioBuffer->IsCompatibleWith(*GetAudioDevice()), "incompatible buffer");
 
@@ -135,12 +145,16 @@ namespace Nz
 
 	void DummyAudioSource::Pause()
 	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
 		m_playClock.Pause();
 		m_status = SoundStatus::Paused;
 	}
 
 	void DummyAudioSource::Play()
 	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
 		if (m_status != SoundStatus::Paused)
 		{
 			// playing or stopped, restart
@@ -165,10 +179,13 @@ namespace Nz
 
 	void DummyAudioSource::SetBuffer(std::shared_ptr<AudioBuffer> audioBuffer)
 	{
-		NazaraAssert(audioBuffer->IsCompatibleWith(*GetAudioDevice()), "incompatible buffer");
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		NazaraAssert(!audioBuffer || audioBuffer->IsCompatibleWith(*GetAudioDevice()), "incompatible buffer");
 
 		m_queuedBuffers.clear();
-		m_queuedBuffers.emplace_back(std::static_pointer_cast<DummyAudioBuffer>(audioBuffer));
+		if (audioBuffer)
+			m_queuedBuffers.emplace_back(std::static_pointer_cast<DummyAudioBuffer>(audioBuffer));
 		m_processedBuffers.clear();
 	}
 
@@ -184,6 +201,8 @@ namespace Nz
 
 	void DummyAudioSource::SetPlayingOffset(Time offset)
 	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
 		// Next UpdateTime call will handle this properly
 		RequeueBuffers();
 		m_playClock.Restart(offset, m_playClock.IsPaused());
@@ -196,6 +215,8 @@ namespace Nz
 
 	void DummyAudioSource::SetSampleOffset(UInt32 offset)
 	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
 		RequeueBuffers();
 
 		if (m_queuedBuffers.empty())
@@ -234,12 +255,16 @@ namespace Nz
 
 	void DummyAudioSource::Stop()
 	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
 		m_playClock.Restart(Time::Zero(), true);
 		m_status = SoundStatus::Stopped;
 	}
 
 	std::shared_ptr<AudioBuffer> DummyAudioSource::TryUnqueueProcessedBuffer()
 	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
 		UpdateTime();
 
 		if (m_processedBuffers.empty())
@@ -253,6 +278,8 @@ namespace Nz
 
 	void DummyAudioSource::UnqueueAllBuffers()
 	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
 		m_processedBuffers.clear();
 		m_queuedBuffers.clear();
 		Stop();
@@ -0,0 +1,86 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Audio/Formats/CompressedSoundBufferLoader.hpp>
+#include <Nazara/Audio/Audio.hpp>
+#include <Nazara/Audio/SoundStream.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Core/Stream.hpp>
+#include <vector>
+#include <Nazara/Audio/Debug.hpp>
+
+namespace Nz
+{
+	namespace Loaders
+	{
+		SoundBufferLoader::Entry GetSoundBufferLoader_Compressed()
+		{
+			SoundBufferLoader::Entry loaderEntry;
+			loaderEntry.extensionSupport = [](std::string_view extension)
+			{
+				return Audio::Instance()->GetSoundStreamLoader().IsExtensionSupported(extension);
+			};
+
+			loaderEntry.streamLoader = [](Stream& stream, const SoundBufferParams& parameters) -> Result<std::shared_ptr<SoundBuffer>, ResourceLoadingError>
+			{
+				SoundStreamParams streamParams;
+				streamParams.custom = parameters.custom;
+				streamParams.forceMono = parameters.forceMono;
+
+				UInt64 streamPos = stream.GetCursorPos();
+
+				// Sound streams only parse the file header when opened, which is enough to know the decoded size
+				std::shared_ptr<SoundStream> soundStream;
+				{
+					ErrorFlags errFlags(ErrorMode::Silent, ~ErrorMode::ThrowException);
+					soundStream = Audio::Instance()->GetSoundStreamLoader().LoadFromStream(stream, streamParams);
+				}
+
+				if (!soundStream)
+					return Err(ResourceLoadingError::Unrecognized);
+
+				AudioFormat format = soundStream->GetFormat();
+				UInt64 sampleCount = soundStream->GetSampleCount();
+				UInt32 sampleRate = soundStream->GetSampleRate();
+
+				// The sound stream reads from the stream, release it before we do
+				soundStream.reset();
+
+				UInt64 compressedSize = stream.GetSize() - streamPos;
+				if (parameters.storage == SoundBufferStorage::Automatic)
+				{
+					// Small sounds are cheap to keep decoded, and so are files which barely compress (such as PCM wav), let the decoding loaders handle them
+					UInt64 decodedSize = sampleCount * sizeof(Int16);
+					if (decodedSize < parameters.compressedStorageThreshold || decodedSize < 2 * compressedSize)
+						return Err(ResourceLoadingError::Unrecognized);
+				}
+
+				std::vector<UInt8> compressedData(compressedSize);
+
+				stream.SetCursorPos(streamPos);
+				if (stream.Read(compressedData.data(), compressedData.size()) != compressedData.size())
+				{
+					NazaraError("failed to read compressed data");
+					return Err(ResourceLoadingError::DecodingError);
+				}
+
+				return std::make_shared<SoundBuffer>(format, sampleCount, sampleRate, std::move(compressedData), streamParams);
+			};
+
+			loaderEntry.parameterFilter = [](const SoundBufferParams& parameters)
+			{
+				if (parameters.storage == SoundBufferStorage::Decoded)
+					return false;
+
+				if (auto result = parameters.custom.GetBooleanParameter("SkipBuiltinCompressedLoader"); result.GetValueOr(false))
+					return false;
+
+				return true;
+			};
+
+			return loaderEntry;
+		}
+	}
+}
@@ -0,0 +1,18 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_AUDIO_FORMATS_COMPRESSEDSOUNDBUFFERLOADER_HPP
+#define NAZARA_AUDIO_FORMATS_COMPRESSEDSOUNDBUFFERLOADER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Audio/SoundBuffer.hpp>
+
+namespace Nz::Loaders
+{
+	SoundBufferLoader::Entry GetSoundBufferLoader_Compressed();
+}
+
+#endif // NAZARA_AUDIO_FORMATS_COMPRESSEDSOUNDBUFFERLOADER_HPP
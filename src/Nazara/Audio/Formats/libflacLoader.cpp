@@ -14,6 +14,7 @@
 #include <Nazara/Core/Stream.hpp>
 #include <NazaraUtils/CallOnExit.hpp>
 #include <NazaraUtils/Endianness.hpp>
+#include <NazaraUtils/StackArray.hpp>
 #include <FLAC/stream_decoder.h>
 #include <optional>
 #include <set>
@@ -96,39 +97,31 @@ namespace Nz
 				return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
 		}
 
-		template<UInt32 Bits, typename TargetType>
-		bool DecodeFlacFrameSamplesImpl(const FLAC__Frame* frame, const FLAC__int32* const buffer[], TargetType* samples, UInt32 frameIndex, UInt32 frameCount)
-		{
-			constexpr UInt32 TargetBits = sizeof(TargetType) * CHAR_BIT;
-			for (; frameIndex < frameCount; ++frameIndex)
-			{
-				for (UInt32 channelIndex = 0; channelIndex < frame->header.channels; ++channelIndex)
-				{
-					Int32 sample = buffer[channelIndex][frameIndex];
-					if constexpr (Bits > TargetBits)
-						sample >>= (Bits - TargetBits);
-					else
-						sample <<= (TargetBits - Bits);
-
-					*samples++ = static_cast<TargetType>(sample);
-				}
-			}
-
-			return true;
-		}
-
 		bool DecodeFlacFrameSamples(const FLAC__Frame* frame, const FLAC__int32* const buffer[], Int16* samples, UInt32 frameIndex, UInt32 frameCount)
 		{
 			switch (frame->header.bits_per_sample)
 			{
-				case 8:  return DecodeFlacFrameSamplesImpl<8>(frame, buffer, samples, frameIndex, frameCount);
-				case 12: return DecodeFlacFrameSamplesImpl<12>(frame, buffer, samples, frameIndex, frameCount);
-				case 16: return DecodeFlacFrameSamplesImpl<16>(frame, buffer, samples, frameIndex, frameCount);
-				case 20: return DecodeFlacFrameSamplesImpl<20>(frame, buffer, samples, frameIndex, frameCount);
-				case 24: return DecodeFlacFrameSamplesImpl<24>(frame, buffer, samples, frameIndex, frameCount);
-				case 32: return DecodeFlacFrameSamplesImpl<32>(frame, buffer, samples, frameIndex, frameCount);
-				default: return false;
+				case 8:
+				case 12:
+				case 16:
+				case 20:
+				case 24:
+				case 32:
+					break;
+
+				default:
+					return false;
 			}
+
+			if (frameIndex >= frameCount)
+				return true;
+
+			StackArray<const Int32*> channels = NazaraStackArrayNoInit(const Int32*, frame->header.channels);
+			for (UInt32 channelIndex = 0; channelIndex < frame->header.channels; ++channelIndex)
+				channels[channelIndex] = buffer[channelIndex] + frameIndex;
+
+			ConvertSamples(channels.data(), frame->header.channels, frame->header.bits_per_sample, samples, frameCount - frameIndex);
+			return true;
 		}
 
 		bool DecodeFlacFrameSamples(const FLAC__Frame* frame, const FLAC__int32* const buffer[], Int16* samples)
@@ -3,17 +3,10 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Audio/Music.hpp>
-#include <Nazara/Audio/Algorithm.hpp>
 #include <Nazara/Audio/Audio.hpp>
-#include <Nazara/Audio/AudioBuffer.hpp>
-#include <Nazara/Audio/AudioDevice.hpp>
-#include <Nazara/Audio/AudioSource.hpp>
 #include <Nazara/Audio/SoundStream.hpp>
-#include <Nazara/Core/ThreadExt.hpp>
-#include <NazaraUtils/CallOnExit.hpp>
-#include <array>
-#include <chrono>
-#include <optional>
+#include <Nazara/Audio/VirtualAudioSource.hpp>
+#include <Nazara/Core/Error.hpp>
 #include <Nazara/Audio/Debug.hpp>
 
 namespace Nz
@@ -23,6 +16,8 @@ namespace Nz
 	* \class Nz::Music
 	* \brief Audio class that represents a music
 	*
+	* Musics are streamed by a SoundStreamPlayer: their buffers are refilled by the AudioStreamer of their device while playing.
+	*
 	* \remark Module Audio needs to be initialized to use this class
 	*/
 
@@ -33,8 +28,6 @@ namespace Nz
 	
 	Music::Music(AudioDevice& device) :
 	SoundEmitter(device),
-	m_streaming(false),
-	m_bufferCount(2),
 	m_looping(false)
 	{
 	}
@@ -61,14 +54,8 @@ namespace Nz
 
 		Destroy();
 
-		AudioFormat format = soundStream->GetFormat();
-
-		m_sampleRate = soundStream->GetSampleRate();
-		m_audioFormat = soundStream->GetFormat();
-		m_chunkSamples.resize(GetChannelCount(format) * m_sampleRate); // One second of samples
-		m_stream = std::move(soundStream);
-
-		SeekToSampleOffset(0);
+		m_player = std::make_unique<SoundStreamPlayer>(m_source, std::move(soundStream));
+		m_player->EnableLooping(m_looping);
 
 		return true;
 	}
@@ -80,7 +67,7 @@ namespace Nz
 	*/
 	void Music::Destroy()
 	{
-		StopThread();
+		m_player.reset();
 	}
 
 	/*!
@@ -92,9 +79,9 @@ namespace Nz
 	*/
 	void Music::EnableLooping(bool loop)
 	{
-		std::lock_guard<std::recursive_mutex> lock(m_sourceLock);
-
 		m_looping = loop;
+		if (m_player)
+			m_player->EnableLooping(loop);
 	}
 
 	/*!
@@ -105,9 +92,9 @@ namespace Nz
 	*/
 	Time Music::GetDuration() const
 	{
-		NazaraAssert(m_stream, "Music not created");
+		NazaraAssert(m_player, "Music not created");
 
-		return m_stream->GetDuration();
+		return m_player->GetStream()->GetDuration();
 	}
 
 	/*!
@@ -118,9 +105,9 @@ namespace Nz
 	*/
 	AudioFormat Music::GetFormat() const
 	{
-		NazaraAssert(m_stream, "Music not created");
+		NazaraAssert(m_player, "Music not created");
 
-		return m_stream->GetFormat();
+		return m_player->GetStream()->GetFormat();
 	}
 
 	/*!
@@ -129,28 +116,9 @@ namespace Nz
 	*/
 	Time Music::GetPlayingOffset() const
 	{
-		NazaraAssert(m_stream, "Music not created");
-
-		if (!m_streaming)
-			return Time::Zero();
+		NazaraAssert(m_player, "Music not created");
 
-		// Prevent music thread from enqueuing new buffers while we're getting the count
-		std::lock_guard<std::recursive_mutex> lock(m_sourceLock);
-
-		Time playingOffset = m_source->GetPlayingOffset();
-		Time processedTime = Time::Microseconds(1'000'000ll * m_processedSamples / (GetChannelCount(m_stream->GetFormat()) * m_sampleRate));
-		playingOffset += processedTime;
-
-		Time sampleCount = m_stream->GetDuration();
-		if (playingOffset > sampleCount)
-		{
-			if (m_looping)
-				playingOffset %= sampleCount;
-			else
-				playingOffset = Time::Zero(); //< stopped
-		}
-
-		return playingOffset;
+		return m_player->GetPlayingOffset();
 	}
 
 	/*!
@@ -161,9 +129,9 @@ namespace Nz
 	*/
 	UInt64 Music::GetSampleCount() const
 	{
-		NazaraAssert(m_stream, "Music not created");
+		NazaraAssert(m_player, "Music not created");
 
-		return m_stream->GetSampleCount();
+		return m_player->GetStream()->GetSampleCount();
 	}
 
 	/*!
@@ -172,25 +140,9 @@ namespace Nz
 	*/
 	UInt64 Music::GetSampleOffset() const
 	{
-		NazaraAssert(m_stream, "Music not created");
-
-		if (!m_streaming)
-			return 0;
-
-		// Prevent music thread from enqueuing new buffers while we're getting the count
-		std::lock_guard<std::recursive_mutex> lock(m_sourceLock);
+		NazaraAssert(m_player, "Music not created");
 
-		UInt64 sampleOffset = m_processedSamples + m_source->GetSampleOffset();
-		UInt64 sampleCount = m_stream->GetSampleCount();
-		if (sampleOffset > sampleCount)
-		{
-			if (m_looping)
-				sampleOffset %= sampleCount;
-			else
-				sampleOffset = 0; //< stopped
-		}
-
-		return sampleOffset;
+		return m_player->GetSampleOffset();
 	}
 
 	/*!
@@ -201,9 +153,9 @@ namespace Nz
 	*/
 	UInt32 Music::GetSampleRate() const
 	{
-		NazaraAssert(m_stream, "Music not created");
+		NazaraAssert(m_player, "Music not created");
 
-		return m_sampleRate;
+		return m_player->GetStream()->GetSampleRate();
 	}
 
 	/*!
@@ -214,17 +166,9 @@ namespace Nz
 	*/
 	SoundStatus Music::GetStatus() const
 	{
-		NazaraAssert(m_stream, "Music not created");
-
-		std::lock_guard<std::recursive_mutex> lock(m_sourceLock);
-
-		SoundStatus status = m_source->GetStatus();
+		NazaraAssert(m_player, "Music not created");
 
-		// To compensate any delays (or the timelaps between Play() and the thread startup)
-		if (m_streaming && status == SoundStatus::Stopped)
-			status = SoundStatus::Playing;
-
-		return status;
+		return m_player->GetStatus();
 	}
 
 	/*!
@@ -235,8 +179,6 @@ namespace Nz
 	*/
 	bool Music::IsLooping() const
 	{
-		std::lock_guard<std::recursive_mutex> lock(m_sourceLock);
-
 		return m_looping;
 	}
 
@@ -297,9 +239,9 @@ namespace Nz
 	*/
 	void Music::Pause()
 	{
-		std::lock_guard<std::recursive_mutex> lock(m_sourceLock);
+		NazaraAssert(m_player, "Music not created");
 
-		m_source->Pause();
+		m_player->Pause();
 	}
 
 	/*!
@@ -314,44 +256,16 @@ namespace Nz
 	*/
 	void Music::Play()
 	{
-		NazaraAssert(m_stream, "Music not created");
-
-		// Maybe we are already playing
-		if (m_streaming)
-		{
-			std::lock_guard<std::recursive_mutex> lock(m_sourceLock);
-
-			switch (GetStatus())
-			{
-				case SoundStatus::Playing:
-					SeekToSampleOffset(0);
-					break;
-
-				case SoundStatus::Paused:
-					m_source->Play();
-					break;
-
-				default:
-					break; // We shouldn't be stopped
-			}
-		}
-		else
-		{
-			// Ensure we're restarting
-			StopThread();
-
-			// Special case of SetPlayingOffset(end) before Play(), restart from beginning
-			if (m_streamOffset >= m_stream->GetSampleCount())
-				m_streamOffset = 0;
+		NazaraAssert(m_player, "Music not created");
 
-			StartThread(false);
-		}
+		m_player->Play();
 	}
 
 	/*!
 	* \brief Changes the playing offset of the music
 	*
-	* If the music is not playing, this sets the playing offset for the next Play call
+	* If the music is not playing, this sets the playing offset for the next Play call.
+	* If it is, the seek is applied asynchronously by the streamer (offset queries report the new offset right away).
 	*
 	* \param offset The offset in samples
 	*
@@ -359,21 +273,9 @@ namespace Nz
 	*/
 	void Music::SeekToSampleOffset(UInt64 offset)
 	{
-		NazaraAssert(m_stream, "Music not created");
-
-		bool isPlaying = m_streaming;
-		bool isPaused = GetStatus() == SoundStatus::Paused;
-
-		if (isPlaying)
-			StopThread();
+		NazaraAssert(m_player, "Music not created");
 
-		UInt64 sampleOffset = offset * GetChannelCount(m_stream->GetFormat());
-
-		m_processedSamples = sampleOffset;
-		m_streamOffset = sampleOffset;
-
-		if (isPlaying)
-			StartThread(isPaused);
+		m_player->SeekToSampleOffset(offset);
 	}
 
 	/*!
@@ -383,157 +285,8 @@ namespace Nz
 	*/
 	void Music::Stop()
 	{
-		StopThread();
-		SeekToSampleOffset(0);
-	}
-
-	bool Music::FillAndQueueBuffer(std::shared_ptr<AudioBuffer> buffer)
-	{
-		std::size_t sampleCount = m_chunkSamples.size();
-		std::size_t sampleRead = 0;
-		{
-			std::lock_guard<std::mutex> lock(m_stream->GetMutex());
-
-			m_stream->Seek(m_streamOffset);
-
-			// Fill the buffer by reading from the stream
-			for (;;)
-			{
-				sampleRead += m_stream->Read(&m_chunkSamples[sampleRead], sampleCount - sampleRead);
-				if (sampleRead < sampleCount && m_looping)
-				{
-					// In case we read less than expected, assume we reached the end of the stream and seek back to the beginning
-					m_stream->Seek(0);
-					continue;
-				}
-
-				// Either we read the size we wanted, either we're not looping
-				break;
-			}
-
-			m_streamOffset = m_stream->Tell();
-		}
-
-		// Update the buffer on the AudioDevice and queue it if we got any data
-		if (sampleRead > 0)
-		{
-			buffer->Reset(m_audioFormat, sampleRead, m_sampleRate, &m_chunkSamples[0]);
-			m_source->QueueBuffer(buffer);
-		}
-
-		return sampleRead != sampleCount; // End of stream (Does not happen when looping)
-	}
-
-	void Music::MusicThread(std::condition_variable& cv, std::mutex& m, std::exception_ptr& err, bool startPaused)
-	{
-		SetCurrentThreadName("MusicThread");
-
-		std::optional<std::lock_guard<std::recursive_mutex>> exitLock;
-
-		// Allocation of streaming buffers
-		CallOnExit unqueueBuffers([&]
-		{
-			m_source->UnqueueAllBuffers();
-		});
-
-		try
-		{
-			for (std::size_t i = 0; i < m_bufferCount; ++i)
-			{
-				std::shared_ptr<AudioBuffer> buffer = m_source->GetAudioDevice()->CreateBuffer();
-
-				if (FillAndQueueBuffer(std::move(buffer)))
-					break; // We have reached the end of the stream, there is no use to add new buffers
-			}
-		}
-		catch (const std::exception&)
-		{
-			err = std::current_exception();
-
-			std::unique_lock<std::mutex> lock(m);
-			cv.notify_all();
-			return;
-		}
-
-		m_source->Play();
-		if (startPaused)
-		{
-			// little hack to start paused (required by SetPlayingOffset)
-			m_source->Pause();
-			m_source->SetSampleOffset(0);
-		}
-
-		CallOnExit stopSource([&]
-		{
-			// Stop playing of the sound (in the case where it has not been already done)
-			m_source->Stop();
-		});
-
-		// Signal we're good
-		{
-			std::unique_lock<std::mutex> lock(m);
-			cv.notify_all();
-		} // m & cv no longer exists from here
-
-		// From now, the source can be accessed from another thread, lock it before others destructors
-		CallOnExit lockSource([&]
-		{
-			exitLock.emplace(m_sourceLock);
-		});
-
-		// Reading loop (Filling new buffers as playing)
-		while (m_streaming)
-		{
-			// Wait until buffers are processed
-			std::this_thread::sleep_for(std::chrono::milliseconds(50));
-
-			std::lock_guard<std::recursive_mutex> lock(m_sourceLock);
-
-			SoundStatus status = m_source->GetStatus();
-			if (status == SoundStatus::Stopped)
-			{
-				// The reading has stopped, we have reached the end of the stream
-				m_streaming = false;
-				break;
-			}
-
-			// We treat read buffers
-			while (std::shared_ptr<AudioBuffer> buffer = m_source->TryUnqueueProcessedBuffer())
-			{
-				m_processedSamples += buffer->GetSampleCount();
-
-				if (FillAndQueueBuffer(std::move(buffer)))
-					break;
-			}
-		}
-	}
-
-	void Music::StartThread(bool startPaused)
-	{
-		std::mutex mutex;
-		std::condition_variable cv;
-
-		// Starting streaming thread
-		m_streaming = true;
-
-		std::exception_ptr exceptionPtr;
-
-		std::unique_lock<std::mutex> lock(mutex);
-		m_thread = std::thread(&Music::MusicThread, this, std::ref(cv), std::ref(mutex), std::ref(exceptionPtr), startPaused);
-
-		// Wait until thread signal it has properly started (or an error occurred)
-		cv.wait(lock);
-
-		if (exceptionPtr)
-			std::rethrow_exception(exceptionPtr);
-	}
-
-	void Music::StopThread()
-	{
-		if (m_streaming)
-			m_streaming = false;
+		NazaraAssert(m_player, "Music not created");
 
-		if (m_thread.joinable())
-			m_thread.join();
+		m_player->Stop();
 	}
 }
@@ -17,6 +17,11 @@ namespace Nz
 		m_library.alDeleteBuffers(1, &m_bufferId);
 	}
 
+	AudioFormat OpenALBuffer::GetAudioFormat() const
+	{
+		return m_format;
+	}
+
 	UInt64 OpenALBuffer::GetSampleCount() const
 	{
 		GetDevice().MakeContextCurrent();
@@ -82,6 +87,8 @@ namespace Nz
 			return false;
 		}
 
+		m_format = format;
+
 		return true;
 	}
 
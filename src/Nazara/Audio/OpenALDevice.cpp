@@ -48,6 +48,9 @@ namespace Nz
 			m_audioFormatValues[AudioFormat::I16_Quad] = m_library.alGetEnumValue("AL_FORMAT_QUAD16_LOKI");
 
 		m_extensionStatus.fill(false);
+		if (library.alIsExtensionPresent("AL_SOFT_deferred_updates"))
+			m_extensionStatus[OpenALExtension::DeferredUpdates] = true;
+
 		if (library.alIsExtensionPresent("AL_SOFT_source_latency"))
 			m_extensionStatus[OpenALExtension::SourceLatency] = true;
 
@@ -91,6 +94,29 @@ namespace Nz
 		return std::make_shared<OpenALSource>(shared_from_this(), m_library, sourceId);
 	}
 
+	/*!
+	* \brief Defers every following source and listener change until ProcessUpdates is called
+	*
+	* This allows the changes to be applied at once, instead of one at a time while they're being made.
+	* Uses AL_SOFT_deferred_updates when supported, and suspends the context otherwise.
+	*
+	* \see ProcessUpdates
+	*/
+	void OpenALDevice::DeferUpdates()
+	{
+		MakeContextCurrent();
+
+#ifdef AL_SOFT_deferred_updates
+		if (IsExtensionSupported(OpenALExtension::DeferredUpdates))
+		{
+			m_library.alDeferUpdatesSOFT();
+			return;
+		}
+#endif
+
+		m_library.alcSuspendContext(m_context);
+	}
+
 	/*!
 	* \brief Gets the factor of the Doppler effect
 	* \return Global factor of the Doppler effect
@@ -229,6 +255,26 @@ namespace Nz
 		return m_audioFormatValues[format] != 0;
 	}
 
+	/*!
+	* \brief Applies every change made since DeferUpdates was called
+	*
+	* \see DeferUpdates
+	*/
+	void OpenALDevice::ProcessUpdates()
+	{
+		MakeContextCurrent();
+
+#ifdef AL_SOFT_deferred_updates
+		if (IsExtensionSupported(OpenALExtension::DeferredUpdates))
+		{
+			m_library.alProcessUpdatesSOFT();
+			return;
+		}
+#endif
+
+		m_library.alcProcessContext(m_context);
+	}
+
 	/*!
 	* \brief Sets the factor of the doppler effect
 	*
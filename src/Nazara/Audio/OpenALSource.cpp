@@ -199,7 +199,7 @@ namespace Nz
 	void OpenALSource::QueueBuffer(std::shared_ptr<AudioBuffer> audioBuffer)
 	{
 		NazaraAssert(audioBuffer, "invalid buffer");
-		NazaraAssert(audioBuffer->IsCompatibleWith(*GetAudioDevice()), "incompatible buffer");
+		NazaraAssert(!audioBuffer || audioBuffer->IsCompatibleWith(*GetAudioDevice()), "incompatible buffer");
 
 		std::shared_ptr<OpenALBuffer> newBuffer = std::static_pointer_cast<OpenALBuffer>(std::move(audioBuffer));
 
@@ -234,7 +234,7 @@ namespace Nz
 
 	void OpenALSource::SetBuffer(std::shared_ptr<AudioBuffer> audioBuffer)
 	{
-		NazaraAssert(audioBuffer->IsCompatibleWith(*GetAudioDevice()), "incompatible buffer");
+		NazaraAssert(!audioBuffer || audioBuffer->IsCompatibleWith(*GetAudioDevice()), "incompatible buffer");
 
 		std::shared_ptr<OpenALBuffer> newBuffer = std::static_pointer_cast<OpenALBuffer>(std::move(audioBuffer));
 
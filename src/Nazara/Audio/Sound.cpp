@@ -4,10 +4,11 @@
 
 #include <Nazara/Audio/Sound.hpp>
 #include <Nazara/Audio/Audio.hpp>
-#include <Nazara/Audio/AudioSource.hpp>
 #include <Nazara/Audio/Config.hpp>
+#include <Nazara/Audio/VirtualAudioSource.hpp>
 #include <Nazara/Core/Algorithm.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <stdexcept>
 #include <Nazara/Audio/Debug.hpp>
 
 namespace Nz
@@ -17,6 +18,8 @@ namespace Nz
 	* \class Nz::Sound
 	* \brief Audio class that represents a sound
 	*
+	* Sounds playing a compressed sound buffer decode it on the fly, streaming it through a few short buffers.
+	*
 	* \remark Module Audio needs to be initialized to use this class
 	*/
 
@@ -45,6 +48,9 @@ namespace Nz
 	{
 		if (m_source)
 			Stop();
+
+		// The player reads from the buffer data
+		m_player.reset();
 	}
 
 	/*!
@@ -54,7 +60,10 @@ namespace Nz
 	*/
 	void Sound::EnableLooping(bool loop)
 	{
-		m_source->EnableLooping(loop);
+		if (m_player)
+			m_player->EnableLooping(loop);
+		else
+			m_source->EnableLooping(loop);
 	}
 
 	/*!
@@ -85,7 +94,10 @@ namespace Nz
 	*/
 	Time Sound::GetPlayingOffset() const
 	{
-		return m_source->GetPlayingOffset();
+		if (m_player)
+			return m_player->GetPlayingOffset();
+		else
+			return m_source->GetPlayingOffset();
 	}
 
 	/*!
@@ -94,7 +106,10 @@ namespace Nz
 	*/
 	UInt64 Sound::GetSampleOffset() const
 	{
-		return m_source->GetSampleOffset();
+		if (m_player)
+			return m_player->GetSampleOffset();
+		else
+			return m_source->GetSampleOffset();
 	}
 
 	/*!
@@ -112,7 +127,10 @@ namespace Nz
 	*/
 	SoundStatus Sound::GetStatus() const
 	{
-		return m_source->GetStatus();
+		if (m_player)
+			return m_player->GetStatus();
+		else
+			return m_source->GetStatus();
 	}
 
 	/*!
@@ -121,7 +139,10 @@ namespace Nz
 	*/
 	bool Sound::IsLooping() const
 	{
-		return m_source->IsLooping();
+		if (m_player)
+			return m_player->IsLooping();
+		else
+			return m_source->IsLooping();
 	}
 
 	/*!
@@ -205,7 +226,10 @@ namespace Nz
 	*/
 	void Sound::Pause()
 	{
-		m_source->Pause();
+		if (m_player)
+			m_player->Pause();
+		else
+			m_source->Pause();
 	}
 
 	/*!
@@ -215,13 +239,18 @@ namespace Nz
 	{
 		NazaraAssert(IsPlayable(), "Sound is not playable");
 
-		m_source->Play();
+		if (m_player)
+			m_player->Play();
+		else
+			m_source->Play();
 	}
 
 	/*!
 	* \brief Sets the audio buffer
 	*
 	* \param buffer Audio buffer
+	*
+	* \remark Compressed sound buffers are decoded on the fly while playing, by a sound stream opened on them
 	*/
 	void Sound::SetBuffer(std::shared_ptr<SoundBuffer> buffer)
 	{
@@ -230,10 +259,32 @@ namespace Nz
 		if (m_buffer == buffer)
 			return;
 
+		bool looping = IsLooping();
+
 		Stop();
 
+		// Release the previous player before the buffer it reads from
+		m_player.reset();
+
 		m_buffer = std::move(buffer);
-		m_source->SetBuffer(m_buffer->GetAudioBuffer(m_source->GetAudioDevice().get()));
+		if (m_buffer->IsCompressed())
+		{
+			std::shared_ptr<SoundStream> stream = m_buffer->OpenStream();
+			if (!stream)
+				throw std::runtime_error("failed to open compressed sound buffer");
+
+			// The player queues its own buffers and handles looping by itself
+			m_source->SetBuffer(nullptr);
+			m_source->EnableLooping(false);
+
+			m_player = std::make_unique<SoundStreamPlayer>(m_source, std::move(stream), StreamChunkDuration, StreamBufferCount);
+			m_player->EnableLooping(looping);
+		}
+		else
+		{
+			m_source->SetBuffer(m_buffer->GetAudioBuffer(m_source->GetAudioDevice().get()));
+			m_source->EnableLooping(looping);
+		}
 	}
 
 	/*!
@@ -243,7 +294,10 @@ namespace Nz
 	*/
 	void Sound::SeekToSampleOffset(UInt64 offset)
 	{
-		m_source->SetSampleOffset(SafeCast<UInt32>(offset));
+		if (m_player)
+			m_player->SeekToSampleOffset(offset);
+		else
+			m_source->SetSampleOffset(SafeCast<UInt32>(offset));
 	}
 
 	/*!
@@ -251,6 +305,9 @@ namespace Nz
 	*/
 	void Sound::Stop()
 	{
-		m_source->Stop();
+		if (m_player)
+			m_player->Stop();
+		else
+			m_source->Stop();
 	}
 }
@@ -6,8 +6,11 @@
 #include <Nazara/Audio/Algorithm.hpp>
 #include <Nazara/Audio/Audio.hpp>
 #include <Nazara/Audio/AudioBuffer.hpp>
+#include <Nazara/Audio/AudioResampler.hpp>
 #include <Nazara/Audio/Config.hpp>
+#include <Nazara/Core/Core.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <algorithm>
 #include <cstring>
 #include <memory>
 #include <stdexcept>
@@ -20,6 +23,9 @@ namespace Nz
 	* \class Nz::SoundBuffer
 	* \brief Audio class that represents a buffer for sound
 	*
+	* Sound buffers either hold decoded samples, uploaded once per audio device, or the compressed file they were loaded from (see SoundBufferStorage).
+	* Compressed sound buffers are decoded on the fly by each sound playing them, trading some CPU time for a much lower memory usage.
+	*
 	* \remark Module Audio needs to be initialized to use this class
 	*/
 
@@ -55,9 +61,41 @@ namespace Nz
 		std::memcpy(&m_samples[0], samples, sampleCount * sizeof(Int16));
 	}
 
+	/*!
+	* \brief Constructs a compressed SoundBuffer object
+	*
+	* \param format Format of the decoded audio
+	* \param sampleCount Number of decoded samples
+	* \param sampleRate Rate of samples
+	* \param compressedData Encoded file data, decoded by a sound stream when playing
+	* \param streamParams Parameters used to open sound streams on the encoded data
+	*/
+	SoundBuffer::SoundBuffer(AudioFormat format, UInt64 sampleCount, UInt32 sampleRate, std::vector<UInt8> compressedData, const SoundStreamParams& streamParams)
+	{
+		NazaraAssert(sampleCount > 0, "sample count must be different from zero");
+		NazaraAssert(sampleRate > 0, "sample rate must be different from zero");
+		NazaraAssert(!compressedData.empty(), "invalid compressed data");
+
+		m_compressedData = std::move(compressedData);
+		m_duration = Time::Microseconds((1'000'000LL * sampleCount / (GetChannelCount(format) * sampleRate)));
+		m_format = format;
+		m_sampleCount = sampleCount;
+		m_sampleRate = sampleRate;
+		m_streamParams = streamParams;
+	}
+
+	/*!
+	* \brief Gets the audio buffer holding the samples for an audio device (created on first use)
+	* \return Audio buffer
+	*
+	* \param device Audio device
+	*
+	* \remark Compressed sound buffers have no audio buffer, use OpenStream instead
+	*/
 	const std::shared_ptr<AudioBuffer>& SoundBuffer::GetAudioBuffer(AudioDevice* device)
 	{
 		NazaraAssert(device, "invalid device");
+		NazaraAssert(!IsCompressed(), "compressed sound buffers must be streamed");
 
 		auto it = m_audioBufferByDevice.find(device);
 		if (it == m_audioBufferByDevice.end())
@@ -95,6 +133,46 @@ namespace Nz
 		return it->second.audioBuffer;
 	}
 
+	/*!
+	* \brief Gets the memory used by the sound buffer
+	* \return Size (in bytes) of the samples or compressed data, and of the audio buffers they were uploaded to
+	*/
+	std::size_t SoundBuffer::GetMemoryUsage() const
+	{
+		std::size_t sampleSize = static_cast<std::size_t>(m_sampleCount * sizeof(Int16));
+
+		std::size_t memoryUsage = m_compressedData.size();
+		if (m_samples)
+			memoryUsage += sampleSize;
+
+		// Compatible devices share their audio buffer
+		std::vector<const AudioBuffer*> audioBuffers;
+		for (auto&& [device, entry] : m_audioBufferByDevice)
+		{
+			if (std::find(audioBuffers.begin(), audioBuffers.end(), entry.audioBuffer.get()) == audioBuffers.end())
+			{
+				audioBuffers.push_back(entry.audioBuffer.get());
+				memoryUsage += sampleSize;
+			}
+		}
+
+		return memoryUsage;
+	}
+
+	/*!
+	* \brief Opens a sound stream decoding the compressed data
+	* \return Sound stream, or nullptr if it failed
+	*
+	* \remark The sound stream reads the compressed data in place, the sound buffer must outlive it
+	* \remark The sound buffer must be compressed
+	*/
+	std::shared_ptr<SoundStream> SoundBuffer::OpenStream() const
+	{
+		NazaraAssert(IsCompressed(), "sound buffer is not compressed");
+
+		return SoundStream::OpenFromMemory(m_compressedData.data(), m_compressedData.size(), m_streamParams);
+	}
+
 	/*!
 	* \brief Loads the sound buffer from file
 	* \return true if loading is successful
@@ -107,7 +185,37 @@ namespace Nz
 		Audio* audio = Audio::Instance();
 		NazaraAssert(audio, "Audio module has not been initialized");
 
-		return audio->GetSoundBufferLoader().LoadFromFile(filePath, params);
+		return ApplyParams(audio->GetSoundBufferLoader().LoadFromFile(filePath, params), params);
+	}
+
+	/*!
+	* \brief Loads the sound buffer from file in the background
+	* \return Handle to the loading, which gives the sound buffer once it's finished
+	*
+	* Decoding (including mono downmixing) runs on the engine task scheduler, loading many files at once spreads them over its workers.
+	*
+	* \param filePath Path to the file
+	* \param params Parameters for the sound buffer
+	* \param uploadDevice If set, the audio buffer of this device is also created by the loading task, so the first play doesn't have to upload the samples
+	*
+	* \remark Compressed sound buffers (see SoundBufferStorage) have no audio buffer to upload
+	*/
+	auto SoundBuffer::LoadFromFileAsync(std::filesystem::path filePath, SoundBufferParams params, std::shared_ptr<AudioDevice> uploadDevice) -> LoadHandle
+	{
+		NazaraAssert(Audio::Instance(), "Audio module has not been initialized");
+
+		LoadHandle handle;
+		handle.m_soundBuffer = std::make_shared<std::shared_ptr<SoundBuffer>>();
+		handle.m_task = Core::Instance()->GetTaskScheduler().AddTask([soundBuffer = handle.m_soundBuffer, filePath = std::move(filePath), params = std::move(params), uploadDevice = std::move(uploadDevice)]
+		{
+			std::shared_ptr<SoundBuffer> loadedBuffer = LoadFromFile(filePath, params);
+			if (loadedBuffer && uploadDevice && !loadedBuffer->IsCompressed())
+				loadedBuffer->GetAudioBuffer(uploadDevice.get());
+
+			*soundBuffer = std::move(loadedBuffer);
+		});
+
+		return handle;
 	}
 
 	/*!
@@ -123,7 +231,7 @@ namespace Nz
 		Audio* audio = Audio::Instance();
 		NazaraAssert(audio, "Audio module has not been initialized");
 
-		return audio->GetSoundBufferLoader().LoadFromMemory(data, size, params);
+		return ApplyParams(audio->GetSoundBufferLoader().LoadFromMemory(data, size, params), params);
 	}
 
 	/*!
@@ -138,6 +246,51 @@ namespace Nz
 		Audio* audio = Audio::Instance();
 		NazaraAssert(audio, "Audio module has not been initialized");
 
-		return audio->GetSoundBufferLoader().LoadFromStream(stream, params);
+		return ApplyParams(audio->GetSoundBufferLoader().LoadFromStream(stream, params), params);
+	}
+
+	std::shared_ptr<SoundBuffer> SoundBuffer::ApplyParams(std::shared_ptr<SoundBuffer> soundBuffer, const SoundBufferParams& params)
+	{
+		if (!soundBuffer || params.sampleRate == 0 || soundBuffer->IsCompressed() || soundBuffer->GetSampleRate() == params.sampleRate)
+			return soundBuffer;
+
+		UInt32 channelCount = GetChannelCount(soundBuffer->GetFormat());
+		std::vector<Int16> samples = AudioResampler::Resample(soundBuffer->GetSamples(), soundBuffer->GetSampleCount() / channelCount, channelCount, soundBuffer->GetSampleRate(), params.sampleRate);
+
+		return std::make_shared<SoundBuffer>(soundBuffer->GetFormat(), samples.size(), params.sampleRate, samples.data());
+	}
+
+	/*!
+	* \brief Gets the loaded sound buffer
+	* \return Sound buffer, or nullptr if the loading is not finished or failed
+	*/
+	std::shared_ptr<SoundBuffer> SoundBuffer::LoadHandle::GetSoundBuffer() const
+	{
+		if (!m_soundBuffer || !IsFinished())
+			return nullptr;
+
+		return *m_soundBuffer;
+	}
+
+	/*!
+	* \brief Checks whether the loading is finished
+	* \return true if the sound buffer can be retrieved
+	*/
+	bool SoundBuffer::LoadHandle::IsFinished() const
+	{
+		return m_task.IsFinished();
+	}
+
+	/*!
+	* \brief Waits for the loading to finish, running other tasks of the scheduler in the meantime
+	* \return Sound buffer, or nullptr if the loading failed
+	*/
+	std::shared_ptr<SoundBuffer> SoundBuffer::LoadHandle::Wait() const
+	{
+		NazaraAssert(IsValid(), "invalid handle");
+
+		Core::Instance()->GetTaskScheduler().WaitFor(m_task);
+
+		return *m_soundBuffer;
 	}
 }
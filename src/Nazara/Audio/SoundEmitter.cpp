@@ -4,7 +4,8 @@
 
 #include <Nazara/Audio/SoundEmitter.hpp>
 #include <Nazara/Audio/AudioDevice.hpp>
-#include <Nazara/Audio/AudioSource.hpp>
+#include <Nazara/Audio/AudioVoiceManager.hpp>
+#include <Nazara/Audio/VirtualAudioSource.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Audio/Debug.hpp>
 
@@ -17,13 +18,14 @@ namespace Nz
 	*
 	* \remark Module Audio needs to be initialized to use this class
 	* \remark This class is abstract
+	* \remark Sound emitters only use a device source while they're among the most audible ones, see AudioVoiceManager
 	*/
 
 	/*!
 	* \brief Constructs a SoundEmitter object
 	*/
 	SoundEmitter::SoundEmitter(AudioDevice& audioDevice) :
-	m_source(audioDevice.CreateSource())
+	m_source(audioDevice.GetVoiceManager().CreateSource())
 	{
 	}
 
@@ -51,6 +53,15 @@ namespace Nz
 		return m_source->GetAttenuation();
 	}
 
+	/*!
+	* \brief Gets the audio device playing this emitter
+	* \return Audio device the emitter was created with
+	*/
+	const std::shared_ptr<AudioDevice>& SoundEmitter::GetAudioDevice() const
+	{
+		return m_source->GetAudioDevice();
+	}
+
 	/*!
 	* \brief Gets the minimum distance to hear
 	* \return Distance to begin to hear
@@ -78,6 +89,15 @@ namespace Nz
 		return m_source->GetPosition();
 	}
 
+	/*!
+	* \brief Gets the priority of the emitter
+	* \return Priority used to rank emitters when they compete for a voice
+	*/
+	float SoundEmitter::GetPriority() const
+	{
+		return m_source->GetPriority();
+	}
+
 	/*!
 	* \brief Gets the velocity of the emitter
 	* \return Velocity of the sound
@@ -105,6 +125,17 @@ namespace Nz
 		return m_source->IsSpatializationEnabled();
 	}
 
+	/*!
+	* \brief Checks whether the sound emitter is currently virtual
+	* \return true if it has no voice, because it's not audible enough or because more audible emitters use every voice
+	*
+	* \remark Virtual emitters keep playing (silently) and their playing offset still advances
+	*/
+	bool SoundEmitter::IsVirtual() const
+	{
+		return m_source->IsVirtual();
+	}
+
 	/*!
 	* \brief Seek the sound to a point in time
 	*
@@ -156,6 +187,16 @@ namespace Nz
 		m_source->SetPosition(position);
 	}
 
+	/*!
+	* \brief Sets the priority of the emitter
+	*
+	* \param priority Priority multiplying the audibility of the emitter when emitters compete for a voice (defaults to 1)
+	*/
+	void SoundEmitter::SetPriority(float priority)
+	{
+		m_source->SetPriority(priority);
+	}
+
 	/*!
 	* \brief Sets the velocity of the emitter
 	*
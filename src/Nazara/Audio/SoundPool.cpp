@@ -0,0 +1,257 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Audio/SoundPool.hpp>
+#include <Nazara/Audio/AudioDevice.hpp>
+#include <Nazara/Audio/AudioSource.hpp>
+#include <Nazara/Audio/AudioStreamer.hpp>
+#include <Nazara/Audio/SoundBuffer.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Audio/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup audio
+	* \class Nz::SoundPool
+	* \brief Audio class playing short fire-and-forget sounds on a fixed set of preallocated device sources (voices)
+	*
+	* Voices are recycled once their sound is over, without creating or destroying any device source.
+	* When every voice is in use, the voice playing the lowest priority sound (the oldest one on equal priorities) is stolen, unless the new sound has an even lower priority.
+	* The number of instances of a sound buffer playing at once is limited as well, playing it again restarts its oldest instance instead of stacking it.
+	*/
+
+	/*!
+	* \brief Constructs a sound pool and allocates its voices
+	*
+	* \param device Audio device creating the voices
+	* \param voiceCount Number of voices, which is the maximum number of one-shot sounds playing at once
+	* \param maxInstancesPerBuffer Maximum number of instances of the same sound buffer playing at once (zero for no limit)
+	*/
+	SoundPool::SoundPool(std::shared_ptr<AudioDevice> device, std::size_t voiceCount, std::size_t maxInstancesPerBuffer) :
+	m_device(std::move(device)),
+	m_maxInstancesPerBuffer(maxInstancesPerBuffer),
+	m_nextPlayIndex(0)
+	{
+		NazaraAssert(m_device, "invalid device");
+
+		m_voices.resize(voiceCount);
+		for (Voice& voice : m_voices)
+		{
+			voice.source = m_device->CreateSource();
+			voice.playIndex = 0;
+			voice.priority = 0.f;
+		}
+
+		m_streamId = m_device->GetStreamer().RegisterStream([this]() -> std::optional<Time>
+		{
+			Update();
+			return UpdateInterval;
+		}, Time::Zero());
+	}
+
+	SoundPool::~SoundPool()
+	{
+		// Waits for a running update to end
+		m_device->GetStreamer().UnregisterStream(m_streamId);
+
+		StopAll();
+	}
+
+	/*!
+	* \brief Gets the number of voices currently playing a sound
+	* \return Active voice count
+	*
+	* \remark Voices whose sound is over are only counted until the next update
+	*/
+	std::size_t SoundPool::GetActiveVoiceCount() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		std::size_t activeCount = 0;
+		for (const Voice& voice : m_voices)
+		{
+			if (voice.soundBuffer)
+				activeCount++;
+		}
+
+		return activeCount;
+	}
+
+	const std::shared_ptr<AudioDevice>& SoundPool::GetAudioDevice() const
+	{
+		return m_device;
+	}
+
+	/*!
+	* \brief Gets the default maximum number of instances of the same sound buffer playing at once
+	* \return Maximum instance count per sound buffer (zero for no limit)
+	*/
+	std::size_t SoundPool::GetMaxInstancesPerBuffer() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_maxInstancesPerBuffer;
+	}
+
+	/*!
+	* \brief Gets the number of voices of the pool
+	* \return Voice count
+	*/
+	std::size_t SoundPool::GetVoiceCount() const
+	{
+		return m_voices.size();
+	}
+
+	/*!
+	* \brief Plays a sound once at a position, with default parameters
+	* \return True if the sound got a voice
+	*
+	* \param soundBuffer Sound to play
+	* \param position Position of the sound
+	*/
+	bool SoundPool::PlayOneShot(std::shared_ptr<SoundBuffer> soundBuffer, const Vector3f& position)
+	{
+		return PlayOneShot(std::move(soundBuffer), position, OneShotParams{});
+	}
+
+	/*!
+	* \brief Plays a sound once at a position
+	* \return True if the sound got a voice, false if every voice is playing a higher priority sound
+	*
+	* \param soundBuffer Sound to play, kept alive until the sound is over
+	* \param position Position of the sound
+	* \param params Playing parameters
+	*
+	* \remark Compressed sound buffers must be streamed and cannot be played by a sound pool
+	*/
+	bool SoundPool::PlayOneShot(std::shared_ptr<SoundBuffer> soundBuffer, const Vector3f& position, const OneShotParams& params)
+	{
+		NazaraAssert(soundBuffer, "invalid sound buffer");
+
+		if (soundBuffer->IsCompressed())
+		{
+			NazaraError("compressed sound buffers cannot be played by a sound pool");
+			return false;
+		}
+
+		const std::shared_ptr<AudioBuffer>& audioBuffer = soundBuffer->GetAudioBuffer(m_device.get());
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		std::size_t maxInstances = (params.maxInstances > 0) ? params.maxInstances : m_maxInstancesPerBuffer;
+
+		Voice* freeVoice = nullptr;
+		Voice* oldestInstance = nullptr;
+		Voice* stealCandidate = nullptr;
+		std::size_t instanceCount = 0;
+		for (Voice& voice : m_voices)
+		{
+			// Recycle voices whose sound ended since last update
+			if (voice.soundBuffer && voice.source->GetStatus() == SoundStatus::Stopped)
+				ReleaseVoice(voice);
+
+			if (!voice.soundBuffer)
+			{
+				if (!freeVoice)
+					freeVoice = &voice;
+
+				continue;
+			}
+
+			if (voice.soundBuffer == soundBuffer)
+			{
+				instanceCount++;
+				if (!oldestInstance || voice.playIndex < oldestInstance->playIndex)
+					oldestInstance = &voice;
+			}
+
+			if (!stealCandidate || voice.priority < stealCandidate->priority || (voice.priority == stealCandidate->priority && voice.playIndex < stealCandidate->playIndex))
+				stealCandidate = &voice;
+		}
+
+		Voice* voice;
+		if (maxInstances > 0 && instanceCount >= maxInstances)
+			voice = oldestInstance;
+		else if (freeVoice)
+			voice = freeVoice;
+		else if (stealCandidate && stealCandidate->priority <= params.priority)
+			voice = stealCandidate;
+		else
+			return false;
+
+		AudioSource& source = *voice->source;
+		if (voice->soundBuffer)
+			source.Stop();
+
+		source.SetBuffer(audioBuffer);
+		source.EnableLooping(false);
+		source.EnableSpatialization(params.spatialized);
+		source.SetAttenuation(params.attenuation);
+		source.SetMinDistance(params.minDistance);
+		source.SetPitch(params.pitch);
+		source.SetPosition(position);
+		source.SetVelocity(Vector3f::Zero());
+		source.SetVolume(params.volume);
+		source.Play();
+
+		voice->playIndex = m_nextPlayIndex++;
+		voice->priority = params.priority;
+		voice->soundBuffer = std::move(soundBuffer);
+
+		return true;
+	}
+
+	/*!
+	* \brief Sets the default maximum number of instances of the same sound buffer playing at once
+	*
+	* \param maxInstances Maximum instance count per sound buffer (zero for no limit)
+	*
+	* \remark This only applies to sounds played afterwards
+	*/
+	void SoundPool::SetMaxInstancesPerBuffer(std::size_t maxInstances)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_maxInstancesPerBuffer = maxInstances;
+	}
+
+	/*!
+	* \brief Stops every playing sound and frees all voices
+	*/
+	void SoundPool::StopAll()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		for (Voice& voice : m_voices)
+		{
+			if (voice.soundBuffer)
+			{
+				voice.source->Stop();
+				ReleaseVoice(voice);
+			}
+		}
+	}
+
+	/*!
+	* \brief Frees voices whose sound is over
+	*
+	* \remark This is periodically called from the device streamer
+	*/
+	void SoundPool::Update()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		for (Voice& voice : m_voices)
+		{
+			if (voice.soundBuffer && voice.source->GetStatus() == SoundStatus::Stopped)
+				ReleaseVoice(voice);
+		}
+	}
+
+	void SoundPool::ReleaseVoice(Voice& voice)
+	{
+		// Detach the buffer so it can be released along with the sound buffer
+		voice.source->SetBuffer(nullptr);
+		voice.soundBuffer.reset();
+	}
+}
@@ -0,0 +1,485 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Audio/SoundStreamPlayer.hpp>
+#include <Nazara/Audio/Algorithm.hpp>
+#include <Nazara/Audio/AudioBuffer.hpp>
+#include <Nazara/Audio/AudioDevice.hpp>
+#include <Nazara/Audio/AudioSource.hpp>
+#include <Nazara/Audio/AudioStreamer.hpp>
+#include <Nazara/Audio/SoundStream.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <Nazara/Audio/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup audio
+	* \class Nz::SoundStreamPlayer
+	* \brief Audio class that plays a sound stream on an audio source
+	*
+	* The source buffers are refilled by the AudioStreamer of its device while playing.
+	* Samples are decoded ahead in a lock-free ring buffer, seeking is handled by the streamer and offset queries never wait for it.
+	* This is used by Music and by sounds playing compressed sound buffers.
+	*/
+
+	/*!
+	* \brief Constructs a SoundStreamPlayer object
+	*
+	* \param source Audio source to queue buffers on, it should not be used by anything else while the player is alive
+	* \param stream Sound stream to play
+	* \param chunkDuration Duration of each queued buffer
+	* \param bufferCount Number of buffers queued on the source (at least two)
+	*/
+	SoundStreamPlayer::SoundStreamPlayer(std::shared_ptr<AudioSource> source, std::shared_ptr<SoundStream> stream, Time chunkDuration, std::size_t bufferCount) :
+	m_looping(false),
+	m_paused(false),
+	m_streaming(false),
+	m_positionVersion(0),
+	m_processedSamples(0),
+	m_seekOffset(NoSeek),
+	m_bufferCount(bufferCount),
+	m_source(std::move(source)),
+	m_stream(std::move(stream)),
+	m_queuedSamples(0),
+	m_streamOffset(0)
+	{
+		NazaraAssert(m_source, "invalid source");
+		NazaraAssert(m_stream, "invalid stream");
+		NazaraAssert(m_bufferCount >= 2, "at least two buffers are required");
+
+		m_audioFormat = m_stream->GetFormat();
+		m_sampleRate = m_stream->GetSampleRate();
+
+		UInt64 frameCount = std::max<UInt64>(chunkDuration.AsMicroseconds() * m_sampleRate / 1'000'000, 1);
+		m_chunkSamples.resize(GetChannelCount(m_audioFormat) * frameCount);
+		m_decodedSamples.Resize(m_chunkSamples.size()); // Decode one chunk ahead of the queued buffers
+	}
+
+	/*!
+	* \brief Stops streaming and releases the source buffers
+	*/
+	SoundStreamPlayer::~SoundStreamPlayer()
+	{
+		StopStreaming();
+	}
+
+	/*!
+	* \brief Enables the looping of the stream
+	*
+	* \param loop Should the stream loop
+	*/
+	void SoundStreamPlayer::EnableLooping(bool loop)
+	{
+		m_looping = loop;
+	}
+
+	/*!
+	* \brief Gets the current playing offset of the stream
+	* \return Time offset
+	*/
+	Time SoundStreamPlayer::GetPlayingOffset() const
+	{
+		if (!m_streaming)
+			return Time::Zero();
+
+		UInt64 processedSamples;
+		Time playingOffset = ReadSourceOffset(&AudioSource::GetPlayingOffset, processedSamples);
+		Time processedTime = Time::Microseconds(1'000'000ll * processedSamples / (GetChannelCount(m_stream->GetFormat()) * m_sampleRate));
+		playingOffset += processedTime;
+
+		Time sampleCount = m_stream->GetDuration();
+		if (playingOffset > sampleCount)
+		{
+			if (m_looping)
+				playingOffset %= sampleCount;
+			else
+				playingOffset = Time::Zero(); //< stopped
+		}
+
+		return playingOffset;
+	}
+
+	/*!
+	* \brief Gets the current offset in the stream
+	* \return Offset in samples
+	*/
+	UInt64 SoundStreamPlayer::GetSampleOffset() const
+	{
+		if (!m_streaming)
+			return 0;
+
+		UInt64 processedSamples;
+		UInt64 sampleOffset = ReadSourceOffset(&AudioSource::GetSampleOffset, processedSamples);
+		sampleOffset += processedSamples;
+		UInt64 sampleCount = m_stream->GetSampleCount();
+		if (sampleOffset > sampleCount)
+		{
+			if (m_looping)
+				sampleOffset %= sampleCount;
+			else
+				sampleOffset = 0; //< stopped
+		}
+
+		return sampleOffset;
+	}
+
+	/*!
+	* \brief Gets the status of the stream
+	* \return Enumeration of type SoundStatus (Playing, Stopped, ...)
+	*/
+	SoundStatus SoundStreamPlayer::GetStatus() const
+	{
+		SoundStatus status = m_source->GetStatus();
+
+		// To compensate any delays (or the timelaps between Play() or a seek and the streamer update)
+		if (m_streaming && status == SoundStatus::Stopped)
+			status = (m_paused) ? SoundStatus::Paused : SoundStatus::Playing;
+
+		return status;
+	}
+
+	/*!
+	* \brief Checks whether the stream is looping
+	* \return true if it is the case
+	*/
+	bool SoundStreamPlayer::IsLooping() const
+	{
+		return m_looping;
+	}
+
+	/*!
+	* \brief Pauses the stream
+	*/
+	void SoundStreamPlayer::Pause()
+	{
+		// Also read by the streamer when it restarts the source
+		m_paused = true;
+		m_source->Pause();
+	}
+
+	/*!
+	* \brief Plays the stream
+	*
+	* Plays/Resume the stream.
+	* If the stream is currently playing, resets the playing offset to the beginning offset.
+	* If the stream is currently paused,  resumes the playing.
+	* If the stream is currently stopped, starts the playing at the previously set playing offset.
+	*/
+	void SoundStreamPlayer::Play()
+	{
+		// Maybe we are already playing
+		if (m_streaming)
+		{
+			switch (GetStatus())
+			{
+				case SoundStatus::Playing:
+					SeekToSampleOffset(0);
+					break;
+
+				case SoundStatus::Paused:
+					m_paused = false;
+					m_source->Play();
+					break;
+
+				default:
+					break; // We shouldn't be stopped
+			}
+		}
+		else
+		{
+			// Ensure we're restarting
+			StopStreaming();
+
+			// Special case of SetPlayingOffset(end) before Play(), restart from beginning
+			if (m_streamOffset >= m_stream->GetSampleCount())
+				m_streamOffset = 0;
+
+			StartStreaming();
+		}
+	}
+
+	/*!
+	* \brief Changes the playing offset of the stream
+	*
+	* If the stream is not playing, this sets the playing offset for the next Play call.
+	* If it is, the seek is applied asynchronously by the streamer (offset queries report the new offset right away).
+	*
+	* \param offset The offset in samples
+	*/
+	void SoundStreamPlayer::SeekToSampleOffset(UInt64 offset)
+	{
+		UInt64 sampleOffset = offset * GetChannelCount(m_stream->GetFormat());
+
+		if (m_streaming)
+		{
+			m_seekOffset = sampleOffset;
+			m_source->GetAudioDevice()->GetStreamer().RequestUpdate(*m_streamId);
+		}
+		else
+		{
+			m_processedSamples = sampleOffset;
+			m_streamOffset = sampleOffset;
+		}
+	}
+
+	/*!
+	* \brief Stops the stream
+	*/
+	void SoundStreamPlayer::Stop()
+	{
+		StopStreaming();
+		SeekToSampleOffset(0);
+	}
+
+
+	void SoundStreamPlayer::DecodeSamples()
+	{
+		// Fill the free part of the ring buffer by reading from the stream
+		std::size_t sampleCount = std::min(m_decodedSamples.GetWritableCount(), m_chunkSamples.size());
+		if (sampleCount == 0)
+			return;
+
+		std::size_t sampleRead = 0;
+		{
+			std::lock_guard<std::mutex> lock(m_stream->GetMutex());
+
+			m_stream->Seek(m_streamOffset);
+
+			for (;;)
+			{
+				sampleRead += m_stream->Read(&m_chunkSamples[sampleRead], sampleCount - sampleRead);
+				if (sampleRead < sampleCount && m_looping)
+				{
+					// In case we read less than expected, assume we reached the end of the stream and seek back to the beginning
+					m_stream->Seek(0);
+					continue;
+				}
+
+				// Either we read the size we wanted, either we're not looping
+				break;
+			}
+
+			m_streamOffset = m_stream->Tell();
+		}
+
+		m_decodedSamples.Write(&m_chunkSamples[0], sampleRead);
+	}
+
+	bool SoundStreamPlayer::QueueDecodedSamples()
+	{
+		NazaraAssert(!m_freeBuffers.empty(), "no free buffer");
+
+		std::size_t sampleCount = m_decodedSamples.Read(&m_chunkSamples[0], m_chunkSamples.size());
+		if (sampleCount == 0)
+			return false; // End of stream (Does not happen when looping)
+
+		std::shared_ptr<AudioBuffer> buffer = std::move(m_freeBuffers.back());
+		m_freeBuffers.pop_back();
+
+		// Update the buffer on the AudioDevice and queue it
+		buffer->Reset(m_audioFormat, sampleCount, m_sampleRate, &m_chunkSamples[0]);
+		m_source->QueueBuffer(std::move(buffer));
+
+		m_queuedSamples += sampleCount;
+
+		return true;
+	}
+
+	template<typename T>
+	T SoundStreamPlayer::ReadSourceOffset(T(AudioSource::*offsetGetter)() const, UInt64& processedSamples) const
+	{
+		// A pending seek (or start) is reported as if it was already applied
+		UInt64 seekOffset = m_seekOffset.load(std::memory_order_acquire);
+		if (seekOffset != NoSeek)
+		{
+			processedSamples = seekOffset;
+			return T{};
+		}
+
+		// The source offset is relative to its first queued buffer, retry if the streamer unqueued buffers while we were querying it
+		for (;;)
+		{
+			UInt32 version = m_positionVersion.load(std::memory_order_acquire);
+			if (version % 2 != 0)
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			processedSamples = m_processedSamples.load(std::memory_order_acquire);
+			T sourceOffset = (*m_source.*offsetGetter)();
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (m_positionVersion.load(std::memory_order_relaxed) == version)
+				return sourceOffset;
+		}
+	}
+
+	void SoundStreamPlayer::ReleaseQueuedBuffers()
+	{
+		m_source->Stop();
+		m_source->UnqueueAllBuffers();
+		m_queuedSamples = 0;
+	}
+
+	void SoundStreamPlayer::RestartSource()
+	{
+		m_positionVersion.fetch_add(1, std::memory_order_acq_rel);
+		{
+			ReleaseQueuedBuffers();
+
+			// Take the latest seek, offset queries stop reporting it once the version is even again
+			UInt64 sampleOffset = m_seekOffset.exchange(NoSeek, std::memory_order_acq_rel);
+			m_processedSamples = sampleOffset;
+			m_streamOffset = sampleOffset;
+		}
+		m_positionVersion.fetch_add(1, std::memory_order_release);
+
+		m_decodedSamples.Clear();
+
+		const std::shared_ptr<AudioDevice>& device = m_source->GetAudioDevice();
+		while (m_freeBuffers.size() < m_bufferCount)
+			m_freeBuffers.push_back(device->CreateBuffer());
+
+		// Start playing as soon as the first buffer is queued
+		for (bool isPlaying = false; !m_freeBuffers.empty(); isPlaying = true)
+		{
+			DecodeSamples();
+			if (!QueueDecodedSamples())
+				break; // We have reached the end of the stream, there is no use to add new buffers
+
+			if (!isPlaying)
+			{
+				m_source->Play();
+				if (m_paused)
+				{
+					// little hack to start paused (required by SetPlayingOffset)
+					m_source->Pause();
+					m_source->SetSampleOffset(0);
+				}
+			}
+		}
+
+		DecodeSamples();
+	}
+
+	void SoundStreamPlayer::StartStreaming()
+	{
+		const std::shared_ptr<AudioDevice>& device = m_source->GetAudioDevice();
+
+		// The first streamer update starts the source from the current offset
+		m_paused = false;
+		m_seekOffset = m_streamOffset;
+
+		// Refill a buffer as soon as it may have been processed, everything queued after it is the margin against underruns
+		Time chunkDuration = Time::Microseconds(1'000'000ll * m_chunkSamples.size() / (GetChannelCount(m_audioFormat) * m_sampleRate));
+		m_prefetchDuration = Time::Microseconds(chunkDuration.AsMicroseconds() * (m_bufferCount - 1)) - Time::Milliseconds(10);
+
+		m_streaming = true;
+		m_streamId = device->GetStreamer().RegisterStream([this]() -> std::optional<Time>
+		{
+			try
+			{
+				return UpdateStream();
+			}
+			catch (const std::exception& e)
+			{
+				NazaraError("failed to stream sound: {0}", e.what());
+
+				ReleaseQueuedBuffers();
+				m_streaming = false;
+
+				return std::nullopt;
+			}
+		}, m_prefetchDuration);
+	}
+
+	void SoundStreamPlayer::StopStreaming()
+	{
+		if (!m_streamId)
+			return;
+
+		m_streaming = false;
+
+		// Once unregistered, the streamer no longer accesses the music
+		m_source->GetAudioDevice()->GetStreamer().UnregisterStream(*m_streamId);
+		m_streamId.reset();
+
+		// Stop playing of the sound (in the case where it has not been already done)
+		ReleaseQueuedBuffers();
+
+		// Keep a seek the streamer didn't get to apply for the next Play()
+		UInt64 seekOffset = m_seekOffset.exchange(NoSeek);
+		if (seekOffset != NoSeek)
+		{
+			m_processedSamples = seekOffset;
+			m_streamOffset = seekOffset;
+		}
+	}
+
+	std::optional<Time> SoundStreamPlayer::UpdateStream()
+	{
+		if (!m_streaming)
+			return std::nullopt; //< StopStreaming takes care of the source
+
+		if (m_seekOffset.load(std::memory_order_acquire) != NoSeek)
+			RestartSource();
+		else
+		{
+			if (m_source->GetStatus() == SoundStatus::Stopped)
+			{
+				// The reading has stopped, we have reached the end of the stream
+				ReleaseQueuedBuffers();
+				m_streaming = false;
+
+				return std::nullopt;
+			}
+
+			// We treat read buffers
+			for (;;)
+			{
+				m_positionVersion.fetch_add(1, std::memory_order_acq_rel);
+
+				std::shared_ptr<AudioBuffer> buffer = m_source->TryUnqueueProcessedBuffer();
+				if (buffer)
+					m_processedSamples += buffer->GetSampleCount();
+
+				m_positionVersion.fetch_add(1, std::memory_order_release);
+
+				if (!buffer)
+					break;
+
+				m_queuedSamples -= buffer->GetSampleCount();
+				m_freeBuffers.push_back(std::move(buffer));
+			}
+
+			// Requeue them from already decoded samples before decoding more
+			while (!m_freeBuffers.empty())
+			{
+				if (m_decodedSamples.GetReadableCount() == 0)
+					DecodeSamples();
+
+				if (!QueueDecodedSamples())
+					break;
+			}
+
+			DecodeSamples();
+		}
+
+		Time queuedDuration = Time::Microseconds(1'000'000ll * m_queuedSamples / (GetChannelCount(m_audioFormat) * m_sampleRate));
+		Time remainingDuration = std::max(queuedDuration - m_source->GetPlayingOffset(), Time::Zero());
+
+		// Paused sources don't consume their buffers and ended streams have nothing left to prefetch, only check them periodically (or when they end)
+		if (m_source->GetStatus() == SoundStatus::Paused)
+			remainingDuration = m_prefetchDuration + Time::Milliseconds(50);
+		else if (!m_looping && m_streamOffset >= m_stream->GetSampleCount() && m_decodedSamples.GetReadableCount() == 0)
+			remainingDuration += m_prefetchDuration;
+
+		return remainingDuration;
+	}
+}
@@ -0,0 +1,168 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Audio/Systems/AudioSystem.hpp>
+#include <Nazara/Audio/AudioDevice.hpp>
+#include <Nazara/Utility/Components/NodeComponent.hpp>
+#include <Nazara/Utility/Components/VelocityComponent.hpp>
+#include <algorithm>
+#include <Nazara/Audio/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup audio
+	* \class Nz::AudioSystem
+	* \brief Audio system that makes sound emitters follow the node of their entity
+	*
+	* Only the emitters of entities which moved since the last update are updated, and their changes are applied at once per device (see AudioDevice::DeferUpdates).
+	* Entities having a VelocityComponent also give their linear velocity to their emitters, for the Doppler effect.
+	*/
+
+	AudioSystem::AudioSystem(entt::registry& registry) :
+	m_registry(registry),
+	m_emitterConstructObserver(registry, entt::collector.group<SoundEmitterComponent, NodeComponent>())
+	{
+		m_emitterDestroyConnection = registry.on_destroy<SoundEmitterComponent>().connect<&AudioSystem::OnEmitterDestroy>(this);
+		m_nodeDestroyConnection = registry.on_destroy<NodeComponent>().connect<&AudioSystem::OnNodeDestroy>(this);
+	}
+
+	AudioSystem::~AudioSystem()
+	{
+		m_emitterConstructObserver.disconnect();
+	}
+
+	void AudioSystem::Update(Time /*elapsedTime*/)
+	{
+		UpdateObservers();
+
+		for (std::size_t entityIndex : m_invalidatedEmitters.IterBits())
+		{
+			entt::entity entity = m_emitterEntries[entityIndex].entity;
+
+			const NodeComponent& entityNode = m_registry.get<NodeComponent>(entity);
+			const SoundEmitterComponent& entityEmitters = m_registry.get<SoundEmitterComponent>(entity);
+			const VelocityComponent* entityVelocity = m_registry.try_get<VelocityComponent>(entity);
+
+			Vector3f position = entityNode.GetPosition(CoordSys::Global);
+			Vector3f velocity = (entityVelocity) ? entityVelocity->GetLinearVelocity() : Vector3f::Zero();
+
+			bool isMoving = (velocity != Vector3f::Zero());
+			bool updateVelocity = isMoving || m_movingEmitters.UnboundedTest(entityIndex);
+
+			for (const auto& emitter : entityEmitters.GetEmitters())
+			{
+				DeferDeviceUpdates(*emitter->GetAudioDevice());
+
+				emitter->SetPosition(position);
+				if (updateVelocity)
+					emitter->SetVelocity(velocity);
+			}
+
+			if (isMoving)
+				m_movingEmitters.UnboundedSet(entityIndex);
+			else
+				m_movingEmitters.UnboundedReset(entityIndex);
+		}
+
+		// Entities which stopped moving don't invalidate their node anymore, reset their velocity
+		for (std::size_t entityIndex : m_movingEmitters.IterBits())
+		{
+			if (m_invalidatedEmitters.UnboundedTest(entityIndex))
+				continue;
+
+			entt::entity entity = m_emitterEntries[entityIndex].entity;
+			const VelocityComponent* entityVelocity = m_registry.try_get<VelocityComponent>(entity);
+			if (entityVelocity && entityVelocity->GetLinearVelocity() != Vector3f::Zero())
+				continue;
+
+			const SoundEmitterComponent& entityEmitters = m_registry.get<SoundEmitterComponent>(entity);
+			for (const auto& emitter : entityEmitters.GetEmitters())
+			{
+				DeferDeviceUpdates(*emitter->GetAudioDevice());
+				emitter->SetVelocity(Vector3f::Zero());
+			}
+
+			m_stoppedEmitters.push_back(entityIndex);
+		}
+
+		for (std::size_t entityIndex : m_stoppedEmitters)
+			m_movingEmitters.UnboundedReset(entityIndex);
+
+		m_invalidatedEmitters.Clear();
+		m_stoppedEmitters.clear();
+
+		for (AudioDevice* device : m_deferredDevices)
+			device->ProcessUpdates();
+
+		m_deferredDevices.clear();
+	}
+
+	void AudioSystem::DeferDeviceUpdates(AudioDevice& device)
+	{
+		// Emitters usually share a single device
+		if (std::find(m_deferredDevices.begin(), m_deferredDevices.end(), &device) != m_deferredDevices.end())
+			return;
+
+		device.DeferUpdates();
+		m_deferredDevices.push_back(&device);
+	}
+
+	void AudioSystem::OnEmitterDestroy([[maybe_unused]] entt::registry& registry, entt::entity entity)
+	{
+		assert(&m_registry == &registry);
+
+		ReleaseEntry(entity);
+	}
+
+	void AudioSystem::OnNodeDestroy([[maybe_unused]] entt::registry& registry, entt::entity entity)
+	{
+		assert(&m_registry == &registry);
+
+		ReleaseEntry(entity);
+	}
+
+	void AudioSystem::ReleaseEntry(entt::entity entity)
+	{
+		std::size_t entityIndex = static_cast<std::size_t>(entt::to_entity(entity));
+		if (entityIndex >= m_emitterEntries.size() || m_emitterEntries[entityIndex].entity != entity)
+			return;
+
+		EmitterEntry& emitterEntry = m_emitterEntries[entityIndex];
+		emitterEntry.entity = entt::null;
+		emitterEntry.onEmitterAttached.Disconnect();
+		emitterEntry.onNodeInvalidation.Disconnect();
+
+		m_invalidatedEmitters.UnboundedReset(entityIndex);
+		m_movingEmitters.UnboundedReset(entityIndex);
+	}
+
+	void AudioSystem::UpdateObservers()
+	{
+		m_emitterConstructObserver.each([&](entt::entity entity)
+		{
+			std::size_t entityIndex = static_cast<std::size_t>(entt::to_entity(entity));
+			if (entityIndex >= m_emitterEntries.size())
+				m_emitterEntries.resize(entityIndex + 1);
+
+			NodeComponent& entityNode = m_registry.get<NodeComponent>(entity);
+			SoundEmitterComponent& entityEmitters = m_registry.get<SoundEmitterComponent>(entity);
+
+			EmitterEntry& emitterEntry = m_emitterEntries[entityIndex];
+			emitterEntry.entity = entity;
+			emitterEntry.onNodeInvalidation.Connect(entityNode.OnNodeInvalidation, [this, entityIndex](const Node* /*node*/)
+			{
+				m_invalidatedEmitters.UnboundedSet(entityIndex);
+			});
+
+			// Newly attached emitters have to be moved to the entity
+			emitterEntry.onEmitterAttached.Connect(entityEmitters.OnEmitterAttached, [this, entityIndex](SoundEmitterComponent* /*emitterComponent*/, const std::shared_ptr<SoundEmitter>& /*emitter*/)
+			{
+				m_invalidatedEmitters.UnboundedSet(entityIndex);
+			});
+
+			m_invalidatedEmitters.UnboundedSet(entityIndex);
+		});
+	}
+}
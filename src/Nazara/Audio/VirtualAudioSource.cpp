@@ -0,0 +1,696 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Audio/VirtualAudioSource.hpp>
+#include <Nazara/Audio/Algorithm.hpp>
+#include <Nazara/Audio/AudioBuffer.hpp>
+#include <Nazara/Audio/AudioDevice.hpp>
+#include <Nazara/Audio/AudioVoiceManager.hpp>
+#include <Nazara/Core/Algorithm.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <algorithm>
+#include <Nazara/Audio/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup audio
+	* \class Nz::VirtualAudioSource
+	* \brief Audio class that represents an audio source which only uses a device source (a voice) while it's audible
+	*
+	* The voice manager gives voices to the most audible playing sources. The others are virtual: they keep track of their playing offset
+	* and of their buffers queue without a voice, until they get one back.
+	*/
+
+	/*!
+	* \brief Constructs a virtual source, use AudioVoiceManager::CreateSource instead
+	*
+	* \param device Audio device creating the voices
+	* \param voiceManager Voice manager of the device
+	*/
+	VirtualAudioSource::VirtualAudioSource(std::shared_ptr<AudioDevice> device, AudioVoiceManager& voiceManager) :
+	AudioSource(std::move(device)),
+	m_playClock(Time::Zero(), true),
+	m_virtualStatus(SoundStatus::Stopped),
+	m_virtualOffset(Time::Zero()),
+	m_processedBufferCount(0),
+	m_detachedBufferCount(0),
+	m_voiceManager(voiceManager),
+	m_position(Vector3f::Zero()),
+	m_velocity(Vector3f::Zero()),
+	m_isLooping(false),
+	m_isSpatialized(true),
+	m_isStaticBuffer(false),
+	m_attenuation(1.f),
+	m_minDistance(1.f),
+	m_pitch(1.f),
+	m_priority(1.f),
+	m_volume(1.f)
+	{
+	}
+
+	VirtualAudioSource::~VirtualAudioSource()
+	{
+		m_voiceManager.UnregisterSource(this);
+
+		if (m_voice)
+		{
+			m_voice.reset();
+			m_voiceManager.ReleaseVoice();
+		}
+	}
+
+	void VirtualAudioSource::EnableLooping(bool loop)
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		UpdateVirtualState();
+
+		m_isLooping = loop;
+		if (m_voice)
+			m_voice->EnableLooping(loop);
+	}
+
+	void VirtualAudioSource::EnableSpatialization(bool spatialization)
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		m_isSpatialized = spatialization;
+		if (m_voice)
+			m_voice->EnableSpatialization(spatialization);
+	}
+
+	float VirtualAudioSource::GetAttenuation() const
+	{
+		return m_attenuation;
+	}
+
+	float VirtualAudioSource::GetMinDistance() const
+	{
+		return m_minDistance;
+	}
+
+	float VirtualAudioSource::GetPitch() const
+	{
+		return m_pitch;
+	}
+
+	Time VirtualAudioSource::GetPlayingOffset() const
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		if (m_voice)
+		{
+			if (m_voice->GetStatus() == SoundStatus::Stopped)
+				return Time::Zero();
+
+			return GetDetachedDuration() + m_voice->GetPlayingOffset();
+		}
+
+		UpdateVirtualState();
+		if (m_virtualStatus == SoundStatus::Stopped)
+			return Time::Zero(); //< Always return 0 when stopped, to mimic OpenAL behavior
+
+		return GetVirtualOffset();
+	}
+
+	Vector3f VirtualAudioSource::GetPosition() const
+	{
+		return m_position;
+	}
+
+	/*!
+	* \brief Gets the priority of the source
+	* \return Priority, which multiplies the audibility of the source when the voice manager ranks sources
+	*/
+	float VirtualAudioSource::GetPriority() const
+	{
+		return m_priority;
+	}
+
+	UInt32 VirtualAudioSource::GetSampleOffset() const
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		if (m_voice)
+		{
+			if (m_voice->GetStatus() == SoundStatus::Stopped)
+				return 0;
+
+			return SafeCast<UInt32>(GetDetachedFrameCount() + m_voice->GetSampleOffset());
+		}
+
+		UpdateVirtualState();
+		if (m_virtualStatus == SoundStatus::Stopped)
+			return 0; //< Always return 0 when stopped, to mimic OpenAL behavior
+
+		Time offset = GetVirtualOffset();
+
+		UInt64 sampleOffset = 0;
+		for (const QueuedBuffer& queuedBuffer : m_queuedBuffers)
+		{
+			if (offset < queuedBuffer.duration)
+			{
+				sampleOffset += queuedBuffer.frameCount * offset.AsMicroseconds() / queuedBuffer.duration.AsMicroseconds();
+				break;
+			}
+
+			offset -= queuedBuffer.duration;
+			sampleOffset += queuedBuffer.frameCount;
+		}
+
+		return SafeCast<UInt32>(sampleOffset);
+	}
+
+	auto VirtualAudioSource::GetSampleOffsetAndLatency() const -> OffsetWithLatency
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		if (m_voice)
+		{
+			OffsetWithLatency info = m_voice->GetSampleOffsetAndLatency();
+			if (m_voice->GetStatus() != SoundStatus::Stopped)
+				info.sampleOffset += GetDetachedFrameCount() * 1000;
+
+			return info;
+		}
+
+		OffsetWithLatency info;
+		info.sampleOffset = GetSampleOffset() * 1000;
+		info.sourceLatency = Time::Zero();
+
+		return info;
+	}
+
+	Vector3f VirtualAudioSource::GetVelocity() const
+	{
+		return m_velocity;
+	}
+
+	SoundStatus VirtualAudioSource::GetStatus() const
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		if (m_voice)
+			return m_voice->GetStatus();
+
+		UpdateVirtualState();
+
+		return m_virtualStatus;
+	}
+
+	float VirtualAudioSource::GetVolume() const
+	{
+		return m_volume;
+	}
+
+	bool VirtualAudioSource::IsLooping() const
+	{
+		return m_isLooping;
+	}
+
+	bool VirtualAudioSource::IsSpatializationEnabled() const
+	{
+		return m_isSpatialized;
+	}
+
+	/*!
+	* \brief Checks whether the source is currently virtual
+	* \return true if the source has no voice (and is not heard)
+	*/
+	bool VirtualAudioSource::IsVirtual() const
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		return m_voice == nullptr;
+	}
+
+	void VirtualAudioSource::QueueBuffer(std::shared_ptr<AudioBuffer> audioBuffer)
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		NazaraAssert(audioBuffer, "invalid buffer");
+		NazaraAssert(audioBuffer->IsCompatibleWith(*GetAudioDevice()), "incompatible buffer");
+
+		UpdateVirtualState();
+
+		UInt64 frameCount = audioBuffer->GetSampleCount() / GetChannelCount(audioBuffer->GetAudioFormat());
+
+		QueuedBuffer& queuedBuffer = m_queuedBuffers.emplace_back();
+		queuedBuffer.buffer = audioBuffer;
+		queuedBuffer.duration = Time::Microseconds(1'000'000ll * frameCount / audioBuffer->GetSampleRate());
+		queuedBuffer.frameCount = frameCount;
+
+		m_isStaticBuffer = false;
+
+		if (m_voice)
+			m_voice->QueueBuffer(std::move(audioBuffer));
+	}
+
+	void VirtualAudioSource::Pause()
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		if (m_voice)
+		{
+			m_voice->Pause();
+			return;
+		}
+
+		UpdateVirtualState();
+		if (m_virtualStatus != SoundStatus::Playing)
+			return;
+
+		m_virtualStatus = SoundStatus::Paused;
+		RestartVirtualClock(GetVirtualOffset());
+	}
+
+	void VirtualAudioSource::Play()
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		if (m_voice)
+		{
+			m_voice->Play();
+			return;
+		}
+
+		UpdateVirtualState();
+
+		// Playing sources restart from the beginning, paused ones resume, and stopped ones start from the offset set while stopped (if any)
+		Time offset = (m_virtualStatus == SoundStatus::Playing) ? Time::Zero() : GetVirtualOffset();
+
+		m_virtualStatus = SoundStatus::Playing;
+		m_processedBufferCount = CountProcessedBuffers(offset);
+		RestartVirtualClock(offset);
+
+		if (ComputeAudibility(GetAudioDevice()->GetListenerPosition()) < m_voiceManager.GetAudibilityThreshold())
+			return;
+
+		// No voice left, let the voice manager steal one from a less audible source
+		if (!Devirtualize())
+			m_voiceManager.RequestUpdate();
+	}
+
+	void VirtualAudioSource::SetAttenuation(float attenuation)
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		m_attenuation = attenuation;
+		if (m_voice)
+			m_voice->SetAttenuation(attenuation);
+	}
+
+	void VirtualAudioSource::SetBuffer(std::shared_ptr<AudioBuffer> audioBuffer)
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		NazaraAssert(!audioBuffer || audioBuffer->IsCompatibleWith(*GetAudioDevice()), "incompatible buffer");
+
+		m_queuedBuffers.clear();
+		if (audioBuffer)
+		{
+			UInt64 frameCount = audioBuffer->GetSampleCount() / GetChannelCount(audioBuffer->GetAudioFormat());
+
+			QueuedBuffer& queuedBuffer = m_queuedBuffers.emplace_back();
+			queuedBuffer.buffer = audioBuffer;
+			queuedBuffer.duration = Time::Microseconds(1'000'000ll * frameCount / audioBuffer->GetSampleRate());
+			queuedBuffer.frameCount = frameCount;
+		}
+
+		m_detachedBufferCount = 0;
+		m_isStaticBuffer = true;
+		m_processedBufferCount = 0;
+		RestartVirtualClock(Time::Zero());
+
+		if (m_voice)
+			m_voice->SetBuffer(std::move(audioBuffer));
+	}
+
+	void VirtualAudioSource::SetMinDistance(float minDistance)
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		m_minDistance = minDistance;
+		if (m_voice)
+			m_voice->SetMinDistance(minDistance);
+	}
+
+	void VirtualAudioSource::SetPitch(float pitch)
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		// Offset elapsed until now was played at the previous pitch
+		UpdateVirtualState();
+		RestartVirtualClock(GetVirtualOffset());
+
+		m_pitch = pitch;
+		if (m_voice)
+			m_voice->SetPitch(pitch);
+	}
+
+	void VirtualAudioSource::SetPlayingOffset(Time offset)
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		if (m_voice)
+		{
+			m_voice->SetPlayingOffset(std::max(offset - GetDetachedDuration(), Time::Zero()));
+			return;
+		}
+
+		// When stopped, this sets the offset of the next Play()
+		RestartVirtualClock(offset);
+		if (m_virtualStatus != SoundStatus::Stopped)
+		{
+			m_processedBufferCount = CountProcessedBuffers(offset);
+			UpdateVirtualState();
+		}
+	}
+
+	void VirtualAudioSource::SetPosition(const Vector3f& position)
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		m_position = position;
+		if (m_voice)
+			m_voice->SetPosition(position);
+	}
+
+	/*!
+	* \brief Sets the priority of the source
+	*
+	* The voice manager ranks playing sources by their audibility multiplied by their priority, the first ones get a voice.
+	*
+	* \param priority Priority of the source (defaults to 1)
+	*/
+	void VirtualAudioSource::SetPriority(float priority)
+	{
+		NazaraAssert(priority >= 0.f, "priority must be positive");
+
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+		m_priority = priority;
+	}
+
+	void VirtualAudioSource::SetSampleOffset(UInt32 offset)
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		if (m_voice)
+		{
+			UInt64 detachedFrameCount = GetDetachedFrameCount();
+			m_voice->SetSampleOffset((offset > detachedFrameCount) ? SafeCast<UInt32>(offset - detachedFrameCount) : 0);
+			return;
+		}
+
+		Time timeOffset = Time::Zero();
+		UInt64 frameOffset = offset;
+		for (const QueuedBuffer& queuedBuffer : m_queuedBuffers)
+		{
+			if (frameOffset < queuedBuffer.frameCount)
+			{
+				timeOffset += Time::Microseconds(queuedBuffer.duration.AsMicroseconds() * SafeCast<Int64>(frameOffset) / SafeCast<Int64>(queuedBuffer.frameCount));
+				break;
+			}
+
+			frameOffset -= queuedBuffer.frameCount;
+			timeOffset += queuedBuffer.duration;
+		}
+
+		SetPlayingOffset(timeOffset);
+	}
+
+	void VirtualAudioSource::SetVelocity(const Vector3f& velocity)
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		m_velocity = velocity;
+		if (m_voice)
+			m_voice->SetVelocity(velocity);
+	}
+
+	void VirtualAudioSource::SetVolume(float volume)
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		m_volume = volume;
+		if (m_voice)
+			m_voice->SetVolume(volume);
+	}
+
+	void VirtualAudioSource::Stop()
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		// Stopped sources keep their voice until the voice manager reclaims it, to avoid recreating one when they're restarted right away
+		if (m_voice)
+		{
+			m_voice->Stop();
+			return;
+		}
+
+		// Like OpenAL, stopping marks every queued buffer as processed
+		m_virtualStatus = SoundStatus::Stopped;
+		m_processedBufferCount = m_queuedBuffers.size();
+		RestartVirtualClock(Time::Zero());
+	}
+
+	std::shared_ptr<AudioBuffer> VirtualAudioSource::TryUnqueueProcessedBuffer()
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		if (m_voice)
+		{
+			if (m_detachedBufferCount > 0)
+			{
+				std::shared_ptr<AudioBuffer> processedBuffer = std::move(m_queuedBuffers.front().buffer);
+				m_queuedBuffers.erase(m_queuedBuffers.begin());
+				m_detachedBufferCount--;
+
+				return processedBuffer;
+			}
+
+			std::shared_ptr<AudioBuffer> processedBuffer = m_voice->TryUnqueueProcessedBuffer();
+			if (processedBuffer)
+			{
+				NazaraAssert(!m_queuedBuffers.empty() && m_queuedBuffers.front().buffer == processedBuffer, "voice buffer queue mismatch");
+				m_queuedBuffers.erase(m_queuedBuffers.begin());
+			}
+
+			return processedBuffer;
+		}
+
+		UpdateVirtualState();
+
+		if (m_processedBufferCount == 0)
+			return {};
+
+		QueuedBuffer processedBuffer = std::move(m_queuedBuffers.front());
+		m_queuedBuffers.erase(m_queuedBuffers.begin());
+		m_processedBufferCount--;
+
+		// Offsets are relative to the first queued buffer
+		if (m_virtualStatus != SoundStatus::Stopped)
+			m_virtualOffset -= processedBuffer.duration;
+
+		return std::move(processedBuffer.buffer);
+	}
+
+	void VirtualAudioSource::UnqueueAllBuffers()
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		m_queuedBuffers.clear();
+		m_detachedBufferCount = 0;
+		m_processedBufferCount = 0;
+
+		if (m_voice)
+			m_voice->UnqueueAllBuffers();
+		else
+		{
+			m_virtualStatus = SoundStatus::Stopped;
+			RestartVirtualClock(Time::Zero());
+		}
+	}
+
+	float VirtualAudioSource::ComputeAudibility(const Vector3f& listenerPosition) const
+	{
+		// Non-spatialized sources are positioned relatively to the listener
+		float distance = (m_isSpatialized) ? m_position.Distance(listenerPosition) : m_position.GetLength();
+
+		// Inverse distance clamped model (OpenAL default)
+		float gain = 1.f;
+		if (distance > m_minDistance)
+			gain = m_minDistance / (m_minDistance + m_attenuation * (distance - m_minDistance));
+
+		return m_volume * gain;
+	}
+
+	std::size_t VirtualAudioSource::CountProcessedBuffers(Time offset) const
+	{
+		// Looping sources never process their buffers, like OpenAL
+		if (m_isLooping)
+			return 0;
+
+		std::size_t processedBufferCount = 0;
+		for (const QueuedBuffer& queuedBuffer : m_queuedBuffers)
+		{
+			if (offset < queuedBuffer.duration)
+				break;
+
+			offset -= queuedBuffer.duration;
+			processedBufferCount++;
+		}
+
+		return processedBufferCount;
+	}
+
+	bool VirtualAudioSource::Devirtualize()
+	{
+		if (m_voice)
+			return true;
+
+		UpdateVirtualState();
+		if (m_virtualStatus == SoundStatus::Stopped)
+			return false;
+
+		if (!m_voiceManager.TryReserveVoice())
+			return false;
+
+		std::shared_ptr<AudioSource> voice = GetAudioDevice()->CreateSource();
+		if (!voice)
+		{
+			// The device may support less sources than the voice manager limit
+			m_voiceManager.ReleaseVoice();
+			return false;
+		}
+
+		voice->EnableLooping(m_isLooping);
+		voice->EnableSpatialization(m_isSpatialized);
+		voice->SetAttenuation(m_attenuation);
+		voice->SetMinDistance(m_minDistance);
+		voice->SetPitch(m_pitch);
+		voice->SetPosition(m_position);
+		voice->SetVelocity(m_velocity);
+		voice->SetVolume(m_volume);
+
+		Time offset = GetVirtualOffset();
+		if (m_isStaticBuffer)
+		{
+			if (!m_queuedBuffers.empty())
+				voice->SetBuffer(m_queuedBuffers.front().buffer);
+		}
+		else
+		{
+			// Buffers processed while virtual are only unqueued from the mirrored queue
+			m_detachedBufferCount = m_processedBufferCount;
+			for (std::size_t i = m_detachedBufferCount; i < m_queuedBuffers.size(); ++i)
+				voice->QueueBuffer(m_queuedBuffers[i].buffer);
+
+			offset -= GetDetachedDuration();
+		}
+
+		voice->Play();
+		voice->SetPlayingOffset(offset);
+		if (m_virtualStatus == SoundStatus::Paused)
+			voice->Pause();
+
+		m_voice = std::move(voice);
+		return true;
+	}
+
+	Time VirtualAudioSource::GetDetachedDuration() const
+	{
+		Time duration = Time::Zero();
+		for (std::size_t i = 0; i < m_detachedBufferCount; ++i)
+			duration += m_queuedBuffers[i].duration;
+
+		return duration;
+	}
+
+	UInt64 VirtualAudioSource::GetDetachedFrameCount() const
+	{
+		UInt64 frameCount = 0;
+		for (std::size_t i = 0; i < m_detachedBufferCount; ++i)
+			frameCount += m_queuedBuffers[i].frameCount;
+
+		return frameCount;
+	}
+
+	Time VirtualAudioSource::GetVirtualOffset() const
+	{
+		Time elapsedTime = m_playClock.GetElapsedTime();
+		return m_virtualOffset + Time::Microseconds(static_cast<Int64>(elapsedTime.AsMicroseconds() * m_pitch));
+	}
+
+	auto VirtualAudioSource::QueryVoiceState(const Vector3f& listenerPosition) const -> VoiceState
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+		VoiceState state;
+		state.audibility = ComputeAudibility(listenerPosition);
+		state.isVirtual = (m_voice == nullptr);
+		state.score = state.audibility * m_priority;
+		state.status = GetStatus();
+
+		return state;
+	}
+
+	void VirtualAudioSource::RestartVirtualClock(Time offset) const
+	{
+		m_virtualOffset = offset;
+		m_playClock.Restart(Time::Zero(), m_virtualStatus != SoundStatus::Playing);
+	}
+
+	void VirtualAudioSource::UpdateVirtualState() const
+	{
+		if (m_voice || m_virtualStatus != SoundStatus::Playing)
+			return;
+
+		Time offset = GetVirtualOffset();
+
+		Time queueDuration = Time::Zero();
+		for (const QueuedBuffer& queuedBuffer : m_queuedBuffers)
+			queueDuration += queuedBuffer.duration;
+
+		if (offset >= queueDuration)
+		{
+			if (m_isLooping && queueDuration > Time::Zero())
+				RestartVirtualClock(offset % queueDuration);
+			else
+			{
+				// Reached the end of the queue, every buffer has been processed
+				m_virtualStatus = SoundStatus::Stopped;
+				m_processedBufferCount = m_queuedBuffers.size();
+				RestartVirtualClock(Time::Zero());
+				return;
+			}
+		}
+
+		m_processedBufferCount = CountProcessedBuffers(GetVirtualOffset());
+	}
+
+	void VirtualAudioSource::Virtualize()
+	{
+		if (!m_voice)
+			return;
+
+		SoundStatus status = m_voice->GetStatus();
+		Time offset = (status != SoundStatus::Stopped) ? GetDetachedDuration() + m_voice->GetPlayingOffset() : Time::Zero();
+
+		m_voice->Stop();
+		if (m_isStaticBuffer)
+			m_voice->SetBuffer(nullptr);
+		else
+			m_voice->UnqueueAllBuffers();
+
+		m_voice.reset();
+		m_voiceManager.ReleaseVoice();
+
+		m_detachedBufferCount = 0;
+		m_virtualStatus = status;
+		m_processedBufferCount = (status == SoundStatus::Stopped) ? m_queuedBuffers.size() : CountProcessedBuffers(offset);
+		RestartVirtualClock(offset);
+	}
+}
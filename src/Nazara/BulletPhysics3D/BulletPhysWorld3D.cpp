@@ -4,14 +4,21 @@
 
 #include <Nazara/BulletPhysics3D/BulletPhysWorld3D.hpp>
 #include <Nazara/BulletPhysics3D/BulletHelper.hpp>
+#include <Nazara/Core/Core.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
 #include <NazaraUtils/MemoryPool.hpp>
 #include <NazaraUtils/StackVector.hpp>
 #include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
 #include <BulletCollision/CollisionDispatch/btCollisionDispatcher.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
 #include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
 #include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolver.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
 #include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
+#include <LinearMath/btThreads.h>
 #include <cassert>
+#include <vector>
 #include <Nazara/BulletPhysics3D/Debug.hpp>
 
 namespace Nz
@@ -49,22 +56,103 @@ namespace Nz
 				Vector3f m_from;
 				Vector3f m_to;
 		};
+
+		// Bullet task scheduler running parallel loops on the Core task scheduler
+		class BulletTaskScheduler : public btITaskScheduler
+		{
+			public:
+				BulletTaskScheduler(TaskScheduler& taskScheduler) :
+				btITaskScheduler("Nazara"),
+				m_taskScheduler(taskScheduler)
+				{
+				}
+
+				int getMaxNumThreads() const override
+				{
+					// Calling thread takes part in parallel loops
+					return std::min(int(m_taskScheduler.GetWorkerCount()) + 1, BT_MAX_THREAD_COUNT);
+				}
+
+				int getNumThreads() const override
+				{
+					return getMaxNumThreads();
+				}
+
+				void setNumThreads(int /*numThreads*/) override
+				{
+					// Thread count is the one of the Core task scheduler
+				}
+
+				void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override
+				{
+					m_taskScheduler.ForEachChunk(std::size_t(iEnd - iBegin), std::size_t(std::max(grainSize, 1)), [&](std::size_t first, std::size_t last)
+					{
+						body.forLoop(iBegin + int(first), iBegin + int(last));
+					});
+				}
+
+				btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override
+				{
+					std::size_t count = std::size_t(iEnd - iBegin);
+					std::size_t chunkSize = std::size_t(std::max(grainSize, 1));
+
+					std::vector<btScalar> chunkSums((count + chunkSize - 1) / chunkSize, btScalar(0));
+
+					m_taskScheduler.ForEachChunk(count, chunkSize, [&](std::size_t first, std::size_t last)
+					{
+						chunkSums[first / chunkSize] = body.sumLoop(iBegin + int(first), iBegin + int(last));
+					});
+
+					btScalar sum = btScalar(0);
+					for (btScalar chunkSum : chunkSums)
+						sum += chunkSum;
+
+					return sum;
+				}
+
+			private:
+				TaskScheduler& m_taskScheduler;
+		};
+
+		void InstallBulletTaskScheduler()
+		{
+			// Bullet task scheduler is global
+			static BulletTaskScheduler s_taskScheduler(Core::Instance()->GetTaskScheduler());
+			if (btGetTaskScheduler() != &s_taskScheduler)
+				btSetTaskScheduler(&s_taskScheduler);
+		}
 	}
 
 	struct BulletPhysWorld3D::BulletWorld
 	{
 		btDefaultCollisionConfiguration collisionConfiguration;
-		btCollisionDispatcher dispatcher;
+		std::unique_ptr<btCollisionDispatcher> dispatcher;
 		btDbvtBroadphase broadphase;
-		btSequentialImpulseConstraintSolver constraintSolver;
-		btDiscreteDynamicsWorld dynamicWorld;
+		std::unique_ptr<btConstraintSolverPoolMt> constraintSolverPool;
+		std::unique_ptr<btConstraintSolver> constraintSolver;
+		std::unique_ptr<btDiscreteDynamicsWorld> dynamicWorld;
 		MemoryPool<btRigidBody> rigidBodyPool;
 
-		BulletWorld() :
-		dispatcher(&collisionConfiguration),
-		dynamicWorld(&dispatcher, &broadphase, &constraintSolver, &collisionConfiguration),
+		BulletWorld(bool multithreaded) :
 		rigidBodyPool(256)
 		{
+			if (multithreaded)
+			{
+				NAZARA_USE_ANONYMOUS_NAMESPACE
+
+				InstallBulletTaskScheduler();
+
+				dispatcher = std::make_unique<btCollisionDispatcherMt>(&collisionConfiguration);
+				constraintSolverPool = std::make_unique<btConstraintSolverPoolMt>(BT_MAX_THREAD_COUNT);
+				constraintSolver = std::make_unique<btSequentialImpulseConstraintSolverMt>();
+				dynamicWorld = std::make_unique<btDiscreteDynamicsWorldMt>(dispatcher.get(), &broadphase, constraintSolverPool.get(), constraintSolver.get(), &collisionConfiguration);
+			}
+			else
+			{
+				dispatcher = std::make_unique<btCollisionDispatcher>(&collisionConfiguration);
+				constraintSolver = std::make_unique<btSequentialImpulseConstraintSolver>();
+				dynamicWorld = std::make_unique<btDiscreteDynamicsWorld>(dispatcher.get(), &broadphase, constraintSolver.get(), &collisionConfiguration);
+			}
 		}
 
 		BulletWorld(const BulletWorld&) = delete;
@@ -75,24 +163,29 @@ namespace Nz
 	};
 
 	BulletPhysWorld3D::BulletPhysWorld3D() :
+	BulletPhysWorld3D(Settings{})
+	{
+	}
+
+	BulletPhysWorld3D::BulletPhysWorld3D(const Settings& settings) :
 	m_maxStepCount(50),
 	m_gravity(Vector3f::Zero()),
 	m_stepSize(Time::TickDuration(120)),
 	m_timestepAccumulator(Time::Zero())
 	{
-		m_world = std::make_unique<BulletWorld>();
+		m_world = std::make_unique<BulletWorld>(settings.multithreaded);
 	}
 
 	BulletPhysWorld3D::~BulletPhysWorld3D() = default;
 
 	btDynamicsWorld* BulletPhysWorld3D::GetDynamicsWorld()
 	{
-		return &m_world->dynamicWorld;
+		return m_world->dynamicWorld.get();
 	}
 
 	Vector3f BulletPhysWorld3D::GetGravity() const
 	{
-		return FromBullet(m_world->dynamicWorld.getGravity());
+		return FromBullet(m_world->dynamicWorld->getGravity());
 	}
 
 	std::size_t BulletPhysWorld3D::GetMaxStepCount() const
@@ -105,12 +198,17 @@ namespace Nz
 		return m_stepSize;
 	}
 
+	bool BulletPhysWorld3D::IsMultithreaded() const
+	{
+		return m_world->constraintSolverPool != nullptr;
+	}
+
 	bool BulletPhysWorld3D::RaycastQuery(const Vector3f& from, const Vector3f& to, const FunctionRef<std::optional<float>(const RaycastHit& hitInfo)>& callback)
 	{
 		NAZARA_USE_ANONYMOUS_NAMESPACE
 
 		CallbackHitResult resultHandler(from, to, callback);
-		m_world->dynamicWorld.rayTest(ToBullet(from), ToBullet(to), resultHandler);
+		m_world->dynamicWorld->rayTest(ToBullet(from), ToBullet(to), resultHandler);
 
 		return resultHandler.hasHit();
 	}
@@ -118,7 +216,7 @@ namespace Nz
 	bool BulletPhysWorld3D::RaycastQueryFirst(const Vector3f& from, const Vector3f& to, RaycastHit* hitInfo)
 	{
 		btCollisionWorld::ClosestRayResultCallback resultHandler(ToBullet(from), ToBullet(to));
-		m_world->dynamicWorld.rayTest(ToBullet(from), ToBullet(to), resultHandler);
+		m_world->dynamicWorld->rayTest(ToBullet(from), ToBullet(to), resultHandler);
 
 		if (!resultHandler.hasHit())
 			return false;
@@ -138,7 +236,7 @@ namespace Nz
 
 	void BulletPhysWorld3D::SetGravity(const Vector3f& gravity)
 	{
-		m_world->dynamicWorld.setGravity(ToBullet(gravity));
+		m_world->dynamicWorld->setGravity(ToBullet(gravity));
 	}
 
 	void BulletPhysWorld3D::SetMaxStepCount(std::size_t maxStepCount)
@@ -160,7 +258,7 @@ namespace Nz
 		std::size_t stepCount = 0;
 		while (m_timestepAccumulator >= m_stepSize && stepCount < m_maxStepCount)
 		{
-			m_world->dynamicWorld.stepSimulation(stepSize, 0, stepSize);
+			m_world->dynamicWorld->stepSimulation(stepSize, 0, stepSize);
 			m_timestepAccumulator -= m_stepSize;
 			stepCount++;
 		}
@@ -175,14 +273,14 @@ namespace Nz
 		rigidBodyIndex = index++;
 		btRigidBody* rigidBody = (btRigidBody*) ::operator new(sizeof(btRigidBody));
 		constructor(rigidBody);
-		m_world->dynamicWorld.addRigidBody(rigidBody);
+		m_world->dynamicWorld->addRigidBody(rigidBody);
 #else
 		btRigidBody* rigidBody = m_world->rigidBodyPool.Allocate(m_world->rigidBodyPool.DeferConstruct, rigidBodyIndex);
 		constructor(rigidBody);
-		m_world->dynamicWorld.addRigidBody(rigidBody);
+		m_world->dynamicWorld->addRigidBody(rigidBody);
 
 		// Small hack to order rigid bodies to make it cache friendly
-		auto& rigidBodies = m_world->dynamicWorld.getNonStaticRigidBodies();
+		auto& rigidBodies = m_world->dynamicWorld->getNonStaticRigidBodies();
 		if (rigidBodies.size() >= 2 && rigidBodies[rigidBodies.size() - 1] == rigidBody)
 		{
 			// Sort rigid bodies
@@ -205,7 +303,7 @@ namespace Nz
 	void BulletPhysWorld3D::RemoveRigidBody(btRigidBody* rigidBody, std::size_t rigidBodyIndex)
 	{
 		// TODO: Improve deletion (since rigid bodies are sorted)
-		m_world->dynamicWorld.removeRigidBody(rigidBody); //< this does a linear search
+		m_world->dynamicWorld->removeRigidBody(rigidBody); //< this does a linear search
 #if HACK
 		::operator delete(rigidBody);
 #else
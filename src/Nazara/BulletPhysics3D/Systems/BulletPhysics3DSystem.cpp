@@ -10,8 +10,14 @@
 namespace Nz
 {
 	BulletPhysics3DSystem::BulletPhysics3DSystem(entt::registry& registry) :
+	BulletPhysics3DSystem(registry, BulletPhysWorld3D::Settings{})
+	{
+	}
+
+	BulletPhysics3DSystem::BulletPhysics3DSystem(entt::registry& registry, const BulletPhysWorld3D::Settings& settings) :
 	m_registry(registry),
-	m_physicsConstructObserver(m_registry, entt::collector.group<BulletRigidBody3DComponent, NodeComponent>())
+	m_physicsConstructObserver(m_registry, entt::collector.group<BulletRigidBody3DComponent, NodeComponent>()),
+	m_physWorld(settings)
 	{
 		m_constructConnection = registry.on_construct<BulletRigidBody3DComponent>().connect<&BulletPhysics3DSystem::OnConstruct>(this);
 		m_destructConnection = registry.on_destroy<BulletRigidBody3DComponent>().connect<&BulletPhysics3DSystem::OnDestruct>(this);
@@ -4,8 +4,12 @@
 
 #include <Nazara/ChipmunkPhysics2D/ChipmunkPhysWorld2D.hpp>
 #include <Nazara/ChipmunkPhysics2D/ChipmunkArbiter2D.hpp>
+#include <Nazara/Core/Error.hpp>
 #include <NazaraUtils/StackArray.hpp>
 #include <chipmunk/chipmunk.h>
+#include <chipmunk/chipmunk_private.h>
+#include <chipmunk/cpHastySpace.h>
+#include <algorithm>
 #include <Nazara/ChipmunkPhysics2D/Debug.hpp>
 
 namespace Nz
@@ -82,17 +86,36 @@ namespace Nz
 	}
 
 	ChipmunkPhysWorld2D::ChipmunkPhysWorld2D() :
+	ChipmunkPhysWorld2D(Settings{})
+	{
+	}
+
+	ChipmunkPhysWorld2D::ChipmunkPhysWorld2D(const Settings& settings) :
 	m_maxStepCount(50),
+	m_postStepArenaBlock(0),
+	m_postStepArenaOffset(0),
 	m_stepSize(Time::TickDuration(120)),
-	m_timestepAccumulator(Time::Zero())
+	m_timestepAccumulator(Time::Zero()),
+	m_isSolverMultithreaded(settings.solverThreadCount != 1)
 	{
-		m_handle = cpSpaceNew();
+		if (m_isSolverMultithreaded)
+		{
+			// Hasty spaces have a multithreaded solver but are otherwise regular spaces
+			m_handle = cpHastySpaceNew();
+			cpHastySpaceSetThreads(m_handle, static_cast<unsigned long>(settings.solverThreadCount));
+		}
+		else
+			m_handle = cpSpaceNew();
+
 		cpSpaceSetUserData(m_handle, this);
 	}
 
 	ChipmunkPhysWorld2D::~ChipmunkPhysWorld2D()
 	{
-		cpSpaceFree(m_handle);
+		if (m_isSolverMultithreaded)
+			cpHastySpaceFree(m_handle);
+		else
+			cpSpaceFree(m_handle);
 	}
 
 	void ChipmunkPhysWorld2D::DebugDraw(const DebugDrawOptions& options, bool drawShapes, bool drawConstraints, bool drawCollisions) const
@@ -157,6 +180,14 @@ namespace Nz
 		return m_maxStepCount;
 	}
 
+	std::size_t ChipmunkPhysWorld2D::GetSolverThreadCount() const
+	{
+		if (!m_isSolverMultithreaded)
+			return 1;
+
+		return cpHastySpaceGetThreads(m_handle);
+	}
+
 	Time ChipmunkPhysWorld2D::GetStepSize() const
 	{
 		return m_stepSize;
@@ -319,6 +350,157 @@ namespace Nz
 		InitCallbacks(cpSpaceAddCollisionHandler(m_handle, collisionIdA, collisionIdB), std::move(callbacks));
 	}
 
+	/*!
+	* \brief Restores the simulation state captured by SaveState
+	* \return True if every captured body could be restored
+	*
+	* \param snapshot Snapshot previously filled by SaveState on this world
+	*
+	* Positions, rotations, velocities, forces and sleeping states of captured bodies are restored, as well as the accumulated impulses of contacts which still exist (which are used to warm start the solver).
+	* Bodies which weren't captured (sleeping bodies in a delta snapshot) are left untouched.
+	*
+	* \remark Bodies are identified by their index, bodies created or destroyed since the snapshot was taken are not handled
+	* \remark This must not be called during a step
+	*/
+	bool ChipmunkPhysWorld2D::RestoreState(const StateSnapshot& snapshot)
+	{
+		NazaraAssert(!IsSpaceLocked(), "state cannot be restored during a step");
+
+		bool succeeded = true;
+		for (const StateSnapshot::BodyState& bodyState : snapshot.bodies)
+		{
+			ChipmunkRigidBody2D* rigidBody = (bodyState.bodyIndex < m_bodies.size()) ? m_bodies[bodyState.bodyIndex] : nullptr;
+			if (!rigidBody || cpBodyGetSpace(rigidBody->GetHandle()) != m_handle)
+			{
+				NazaraError("body #{0} from snapshot doesn't exist or isn't simulated anymore", bodyState.bodyIndex);
+				succeeded = false;
+				continue;
+			}
+
+			// Setters wake up the body, rotation has to be set first as position depends on the center of gravity
+			cpBody* body = rigidBody->GetHandle();
+			cpBodySetAngle(body, bodyState.angle);
+			cpBodySetPosition(body, cpv(bodyState.position.x, bodyState.position.y));
+			cpBodySetVelocity(body, cpv(bodyState.linearVelocity.x, bodyState.linearVelocity.y));
+			cpBodySetAngularVelocity(body, bodyState.angularVelocity);
+			cpBodySetForce(body, cpv(bodyState.force.x, bodyState.force.y));
+			cpBodySetTorque(body, bodyState.torque);
+		}
+
+		// Put bodies back to sleep once every body has been moved, with their shapes bounding boxes up to date
+		for (const StateSnapshot::BodyState& bodyState : snapshot.bodies)
+		{
+			if (!bodyState.isSleeping || bodyState.bodyIndex >= m_bodies.size() || !m_bodies[bodyState.bodyIndex])
+				continue;
+
+			cpBody* body = m_bodies[bodyState.bodyIndex]->GetHandle();
+			if (cpBodyGetSpace(body) != m_handle || cpBodyIsSleeping(body))
+				continue;
+
+			cpSpaceReindexShapesForBody(m_handle, body);
+			cpBodySleep(body);
+		}
+
+		for (const StateSnapshot::ArbiterState& arbiterState : snapshot.arbiters)
+		{
+			const cpShape* shapes[] = { arbiterState.shapeA, arbiterState.shapeB };
+			cpHashValue arbiterHash = CP_HASH_PAIR(arbiterState.shapeA, arbiterState.shapeB);
+
+			cpArbiter* arbiter = static_cast<cpArbiter*>(cpHashSetFind(m_handle->cachedArbiters, arbiterHash, shapes));
+			if (!arbiter)
+				continue; //< contact will be recomputed from scratch
+
+			for (int i = 0; i < arbiter->count; ++i)
+			{
+				cpContact& contact = arbiter->contacts[i];
+				for (UInt32 j = 0; j < arbiterState.contactCount; ++j)
+				{
+					const auto& contactState = arbiterState.contacts[j];
+					if (contactState.hash == contact.hash)
+					{
+						contact.jnAcc = contactState.normalImpulse;
+						contact.jtAcc = contactState.tangentImpulse;
+						break;
+					}
+				}
+			}
+		}
+
+		m_timestepAccumulator = snapshot.timestepAccumulator;
+
+		return succeeded;
+	}
+
+	/*!
+	* \brief Captures the simulation state of the world
+	*
+	* \param snapshot Snapshot receiving the state, its content is replaced (but its memory is reused)
+	* \param activeBodiesOnly If true, only awake bodies are captured (delta snapshot)
+	*
+	* Positions, rotations, velocities, forces and sleeping states of non-static bodies are captured along with accumulated contact impulses.
+	* This is meant to be called frequently (for rollback netcode), a snapshot can be kept and reused to avoid memory allocations.
+	*
+	* \remark This must not be called during a step
+	*/
+	void ChipmunkPhysWorld2D::SaveState(StateSnapshot& snapshot, bool activeBodiesOnly) const
+	{
+		NazaraAssert(!IsSpaceLocked(), "state cannot be saved during a step");
+		static_assert(CP_MAX_CONTACTS_PER_ARBITER <= std::tuple_size_v<decltype(StateSnapshot::ArbiterState::contacts)>);
+
+		snapshot.bodies.clear();
+		for (const ChipmunkRigidBody2D* rigidBody : m_bodies)
+		{
+			if (!rigidBody)
+				continue;
+
+			cpBody* body = rigidBody->GetHandle();
+			if (cpBodyGetSpace(body) != m_handle || cpBodyGetType(body) == CP_BODY_TYPE_STATIC)
+				continue;
+
+			bool isSleeping = cpBodyIsSleeping(body);
+			if (isSleeping && activeBodiesOnly)
+				continue;
+
+			cpVect force = cpBodyGetForce(body);
+			cpVect position = cpBodyGetPosition(body);
+			cpVect velocity = cpBodyGetVelocity(body);
+
+			auto& bodyState = snapshot.bodies.emplace_back();
+			bodyState.angle = cpBodyGetAngle(body);
+			bodyState.angularVelocity = cpBodyGetAngularVelocity(body);
+			bodyState.bodyIndex = rigidBody->GetBodyIndex();
+			bodyState.force = Vector2d(force.x, force.y);
+			bodyState.isSleeping = isSleeping;
+			bodyState.linearVelocity = Vector2d(velocity.x, velocity.y);
+			bodyState.position = Vector2d(position.x, position.y);
+			bodyState.torque = cpBodyGetTorque(body);
+		}
+
+		// Arbiters of sleeping bodies are not in the cache, so this only captures contacts of awake bodies
+		snapshot.arbiters.clear();
+		cpHashSetEach(m_handle->cachedArbiters, [](void* elt, void* data)
+		{
+			const cpArbiter* arbiter = static_cast<const cpArbiter*>(elt);
+			auto& arbiterStates = *static_cast<std::vector<StateSnapshot::ArbiterState>*>(data);
+
+			auto& arbiterState = arbiterStates.emplace_back();
+			arbiterState.contactCount = static_cast<UInt32>(arbiter->count);
+			arbiterState.shapeA = arbiter->a;
+			arbiterState.shapeB = arbiter->b;
+
+			for (int i = 0; i < arbiter->count; ++i)
+			{
+				auto& contactState = arbiterState.contacts[i];
+				contactState.hash = arbiter->contacts[i].hash;
+				contactState.normalImpulse = arbiter->contacts[i].jnAcc;
+				contactState.tangentImpulse = arbiter->contacts[i].jtAcc;
+			}
+		}, &snapshot.arbiters);
+
+		snapshot.isDelta = activeBodiesOnly;
+		snapshot.timestepAccumulator = m_timestepAccumulator;
+	}
+
 	void ChipmunkPhysWorld2D::SetDamping(float dampingValue)
 	{
 		cpSpaceSetDamping(m_handle, dampingValue);
@@ -347,6 +529,19 @@ namespace Nz
 			cpSpaceSetSleepTimeThreshold(m_handle, std::numeric_limits<cpFloat>::infinity());
 	}
 
+	void ChipmunkPhysWorld2D::SetSolverThreadCount(std::size_t threadCount)
+	{
+		if (!m_isSolverMultithreaded)
+		{
+			if (threadCount != 1)
+				NazaraError("physics world was not created with a multithreaded solver (see Settings::solverThreadCount)");
+
+			return;
+		}
+
+		cpHastySpaceSetThreads(m_handle, static_cast<unsigned long>(threadCount));
+	}
+
 	void ChipmunkPhysWorld2D::SetStepSize(Time stepSize)
 	{
 		m_stepSize = stepSize;
@@ -364,27 +559,57 @@ namespace Nz
 		{
 			OnPhysWorld2DPreStep(this, invStepCount);
 
-			cpSpaceStep(m_handle, dt);
+			if (m_isSolverMultithreaded)
+				cpHastySpaceStep(m_handle, dt);
+			else
+				cpSpaceStep(m_handle, dt);
 
 			OnPhysWorld2DPostStep(this, invStepCount);
-			if (!m_rigidBodyPostSteps.empty())
-			{
-				for (auto&& [bodyIndex, callbackVec] : m_rigidBodyPostSteps)
-				{
-					ChipmunkRigidBody2D* rigidBody = m_bodies[bodyIndex];
-					assert(rigidBody);
-
-					for (const auto& step : callbackVec)
-						step(rigidBody);
-				}
-
-				m_rigidBodyPostSteps.clear();
-			}
+			if (!m_postStepCommands.empty())
+				ExecutePostSteps();
 
 			m_timestepAccumulator -= m_stepSize;
 		}
 	}
 
+	float ChipmunkPhysWorld2D::UseAutoTunedSpatialHash()
+	{
+		// Chipmunk recommends a cell size matching the typical shape size and about ten cells per shape
+		struct ShapeStats
+		{
+			std::size_t shapeCount = 0;
+			std::vector<cpFloat> dynamicShapeSizes;
+		};
+
+		ShapeStats stats;
+		cpSpaceEachShape(m_handle, [](cpShape* shape, void* data)
+		{
+			ShapeStats& shapeStats = *static_cast<ShapeStats*>(data);
+			shapeStats.shapeCount++;
+
+			// Static shapes (usually level geometry) are often much bigger than moving objects and would skew the cell size
+			if (cpBodyGetType(cpShapeGetBody(shape)) == CP_BODY_TYPE_STATIC)
+				return;
+
+			cpBB bb = cpShapeGetBB(shape);
+			shapeStats.dynamicShapeSizes.push_back(std::max(bb.r - bb.l, bb.t - bb.b));
+		}, &stats);
+
+		// Keep the current broadphase if there's nothing to tune from
+		if (stats.dynamicShapeSizes.empty())
+			return 0.f;
+
+		auto medianIt = stats.dynamicShapeSizes.begin() + stats.dynamicShapeSizes.size() / 2;
+		std::nth_element(stats.dynamicShapeSizes.begin(), medianIt, stats.dynamicShapeSizes.end());
+
+		cpFloat cellSize = *medianIt;
+		if (cellSize <= 0.0)
+			return 0.f;
+
+		cpSpaceUseSpatialHash(m_handle, cellSize, SafeCast<int>(stats.shapeCount * 10));
+		return float(cellSize);
+	}
+
 	void ChipmunkPhysWorld2D::UseSpatialHash(float cellSize, std::size_t entityCount)
 	{
 		cpSpaceUseSpatialHash(m_handle, cpFloat(cellSize), int(entityCount));
@@ -510,16 +735,50 @@ namespace Nz
 		}
 	}
 
-	void ChipmunkPhysWorld2D::DeferBodyAction(ChipmunkRigidBody2D& rigidBody, PostStep&& func)
+	void* ChipmunkPhysWorld2D::AllocatePostStepStorage(std::size_t size, std::size_t alignment)
 	{
-		// If space isn't locked, no need to wait
-		if (!cpSpaceIsLocked(m_handle))
+		assert(size <= PostStepArenaBlockSize);
+
+		std::size_t offset = (m_postStepArenaOffset + alignment - 1) & ~(alignment - 1);
+		if (m_postStepArenaBlock < m_postStepArena.size() && offset + size > PostStepArenaBlockSize)
 		{
-			func(&rigidBody);
-			return;
+			m_postStepArenaBlock++;
+			offset = 0;
 		}
 
-		UInt32 bodyIndex = rigidBody.GetBodyIndex();
-		m_rigidBodyPostSteps[bodyIndex].emplace_back(std::move(func));
+		// Blocks are kept from one step to another
+		if (m_postStepArenaBlock >= m_postStepArena.size())
+			m_postStepArena.emplace_back(std::make_unique<UInt8[]>(PostStepArenaBlockSize));
+
+		m_postStepArenaOffset = offset + size;
+		return &m_postStepArena[m_postStepArenaBlock][offset];
+	}
+
+	void ChipmunkPhysWorld2D::ExecutePostSteps()
+	{
+		// Space is unlocked at this point, actions deferring other actions will run them immediately so the command list doesn't grow
+		for (PostStepCommand& command : m_postStepCommands)
+		{
+			// Actions may destroy bodies, which cancels their remaining actions
+			if (command.bodyIndex != InvalidBodyIndex)
+			{
+				ChipmunkRigidBody2D* rigidBody = m_bodies[command.bodyIndex];
+				assert(rigidBody);
+
+				command.execute(command.callable, rigidBody);
+			}
+
+			if (command.destroy)
+				command.destroy(command.callable);
+		}
+
+		m_postStepCommands.clear();
+		m_postStepArenaBlock = 0;
+		m_postStepArenaOffset = 0;
+	}
+
+	bool ChipmunkPhysWorld2D::IsSpaceLocked() const
+	{
+		return cpSpaceIsLocked(m_handle);
 	}
 }
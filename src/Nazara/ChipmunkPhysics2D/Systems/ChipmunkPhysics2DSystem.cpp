@@ -21,8 +21,14 @@ namespace Nz
 	}
 
 	ChipmunkPhysics2DSystem::ChipmunkPhysics2DSystem(entt::registry& registry) :
+	ChipmunkPhysics2DSystem(registry, ChipmunkPhysWorld2D::Settings{})
+	{
+	}
+
+	ChipmunkPhysics2DSystem::ChipmunkPhysics2DSystem(entt::registry& registry, const ChipmunkPhysWorld2D::Settings& settings) :
 	m_registry(registry),
-	m_physicsConstructObserver(m_registry, entt::collector.group<ChipmunkRigidBody2DComponent, NodeComponent>())
+	m_physicsConstructObserver(m_registry, entt::collector.group<ChipmunkRigidBody2DComponent, NodeComponent>()),
+	m_physWorld(settings)
 	{
 		m_bodyConstructConnection = registry.on_construct<ChipmunkRigidBody2DComponent>().connect<&ChipmunkPhysics2DSystem::OnBodyConstruct>(this);
 		m_bodyDestructConnection = registry.on_destroy<ChipmunkRigidBody2DComponent>().connect<&ChipmunkPhysics2DSystem::OnBodyDestruct>(this);
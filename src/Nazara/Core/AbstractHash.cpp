@@ -16,6 +16,7 @@
 #include <Nazara/Core/Hash/SHA384.hpp>
 #include <Nazara/Core/Hash/SHA512.hpp>
 #include <Nazara/Core/Hash/Whirlpool.hpp>
+#include <Nazara/Core/Hash/XXH64.hpp>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -74,6 +75,9 @@ namespace Nz
 
 			case HashType::Whirlpool:
 				return std::make_unique<WhirlpoolHasher>();
+
+			case HashType::XXH64:
+				return std::make_unique<XXH64Hasher>();
 		}
 
 		NazaraInternalError("Hash type not handled ({0:#x})", UnderlyingCast(type));
@@ -29,6 +29,15 @@ namespace Nz
 	*/
 	AbstractLogger::~AbstractLogger() = default;
 
+	/*!
+	* \brief Checks whether the logger emits log signals itself
+	* \return True if Log::OnLogWrite and Log::OnLogWriteError are emitted by the logger (e.g. from another thread) instead of Log
+	*/
+	bool AbstractLogger::DispatchesLogSignals() const
+	{
+		return false;
+	}
+
 	/*!
 	* \brief Writes the error in StringStream
 	*
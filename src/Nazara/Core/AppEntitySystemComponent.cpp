@@ -3,13 +3,41 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Core/AppEntitySystemComponent.hpp>
+#include <Nazara/Core/Core.hpp>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
 {
 	void AppEntitySystemComponent::Update(Time elapsedTime)
 	{
+		if (!m_parallelUpdateEnabled || m_worlds.size() < 2 || !Core::Instance())
+		{
+			for (auto& worldPtr : m_worlds)
+				worldPtr->Update(elapsedTime);
+
+			return;
+		}
+
+		TaskScheduler& taskScheduler = Core::Instance()->GetTaskScheduler();
+
+		m_worldTasks.clear();
+		for (std::size_t worldIndex = 0; worldIndex < m_worlds.size(); ++worldIndex)
+		{
+			EntityWorld* world = m_worlds[worldIndex].get();
+			if (world->IsMainThreadOnly())
+				continue;
+
+			// World index gives each world a stable worker
+			m_worldTasks.push_back(taskScheduler.AddTaskOnWorker([world, elapsedTime] { world->Update(elapsedTime); }, static_cast<unsigned int>(worldIndex)));
+		}
+
 		for (auto& worldPtr : m_worlds)
-			worldPtr->Update(elapsedTime);
+		{
+			if (worldPtr->IsMainThreadOnly())
+				worldPtr->Update(elapsedTime);
+		}
+
+		for (const TaskScheduler::TaskHandle& handle : m_worldTasks)
+			taskScheduler.WaitFor(handle);
 	}
 }
@@ -4,6 +4,10 @@
 
 #include <Nazara/Core/ApplicationBase.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/Log.hpp>
+#include <Nazara/Core/Profiler.hpp>
+#include <algorithm>
+#include <thread>
 #ifdef NAZARA_PLATFORM_WEB
 #include <emscripten/html5.h>
 #endif
@@ -11,10 +15,21 @@
 
 namespace Nz
 {
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		// Waits are split in chunks so Quit() called from another thread is noticed
+		constexpr Time MaxIdleWait = Time::Milliseconds(100);
+
+		// OS sleeps can overshoot by the scheduler granularity, the end of the wait is spent yielding instead
+		constexpr Time SleepMargin = Time::Milliseconds(2);
+	}
+
 	ApplicationBase::ApplicationBase(int argc, const Pointer<const char>* argv) :
 	m_running(true),
 	m_commandLineParams(CommandLineParameters::Parse(argc, argv)),
-	m_currentTime(Time::Zero())
+	m_currentTime(Time::Zero()),
+	m_updateRateLimit(0),
+	m_timingStatsEnabled(true)
 	{
 		NazaraAssert(s_instance == nullptr, "only one instance of ApplicationBase can exist at a given time");
 		s_instance = this;
@@ -26,6 +41,29 @@ namespace Nz
 		s_instance = nullptr;
 	}
 
+	/*!
+	* \brief Writes the timing statistics of every updater and component to the log
+	*/
+	void ApplicationBase::LogTimingStats() const
+	{
+		ForEachTimingStats([](std::string_view name, const TimingStats& stats)
+		{
+			NazaraNotice("{0}: {1}", name, stats.ToString());
+		});
+	}
+
+	/*!
+	* \brief Clears the timing statistics of every updater and component, keeping their budget
+	*/
+	void ApplicationBase::ResetTimingStats()
+	{
+		for (Updater& updaterEntry : m_updaters)
+			updaterEntry.timingStats.Reset();
+
+		for (ComponentTiming& componentTiming : m_componentTimings)
+			componentTiming.stats.Reset();
+	}
+
 	int ApplicationBase::Run()
 	{
 		// Ignore time between creation and Run() call
@@ -36,6 +74,8 @@ namespace Nz
 		{
 			Time elapsedTime = m_clock.Restart();
 			Update(elapsedTime);
+
+			WaitForNextUpdate();
 		}
 #else
 		emscripten_set_main_loop_arg([](void* application)
@@ -65,6 +105,8 @@ namespace Nz
 
 	bool ApplicationBase::Update(Time elapsedTime)
 	{
+		NazaraProfileScope("ApplicationBase::Update");
+
 		m_currentTime += elapsedTime;
 
 		for (auto& updaterEntry : m_updaters)
@@ -81,7 +123,14 @@ namespace Nz
 				updaterEntry.lastUpdate = m_currentTime;
 			}
 
+			NazaraProfileScope("ApplicationUpdater::Update");
+
+			Time updateBeginTime = (m_timingStatsEnabled) ? GetElapsedNanoseconds() : Time::Zero();
+
 			Time interval = updaterEntry.updater->Update(timeSinceLastUpdate);
+
+			if (m_timingStatsEnabled)
+				AddTimingSample(updaterEntry.name, updaterEntry.timingStats, GetElapsedNanoseconds() - updateBeginTime);
 			if (interval >= Time::Zero())
 				updaterEntry.nextUpdate = m_currentTime + interval;
 			else
@@ -91,14 +140,83 @@ namespace Nz
 			updaterEntry.nextUpdate = std::max(updaterEntry.nextUpdate, m_currentTime);
 		}
 
-		for (auto& componentPtr : m_components)
+		for (std::size_t componentIndex = 0; componentIndex < m_components.size(); ++componentIndex)
 		{
+			auto& componentPtr = m_components[componentIndex];
 			if (componentPtr)
+			{
+				NazaraProfileScope("ApplicationComponent::Update");
+
+				Time updateBeginTime = (m_timingStatsEnabled) ? GetElapsedNanoseconds() : Time::Zero();
+
 				componentPtr->Update(elapsedTime);
+
+				if (m_timingStatsEnabled)
+				{
+					ComponentTiming& componentTiming = m_componentTimings[componentIndex];
+					AddTimingSample(componentTiming.name, componentTiming.stats, GetElapsedNanoseconds() - updateBeginTime);
+				}
+			}
 		}
 
 		return m_running;
 	}
 
+	void ApplicationBase::AddTimingSample(std::string_view name, TimingStats& stats, Time duration)
+	{
+		stats.AddSample(duration);
+		if (stats.IsOverBudget())
+			OnTimingBudgetExceeded(this, name, stats);
+	}
+
+	/*!
+	* \brief Sleeps until the next update is due
+	*
+	* The next update is delayed to respect the update rate limit. Applications without components (such as headless servers only using updaters)
+	* also sleep until their next updater is due, instead of spinning.
+	*/
+	void ApplicationBase::WaitForNextUpdate()
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		// m_clock was restarted at the beginning of the update
+		Time updateDuration = m_clock.GetElapsedTime();
+
+		Time waitDuration = Time::Zero();
+		if (m_updateRateLimit > 0)
+			waitDuration = Time::TickDuration(m_updateRateLimit) - updateDuration;
+
+		bool hasComponents = std::any_of(m_components.begin(), m_components.end(), [](const auto& componentPtr) { return componentPtr != nullptr; });
+		if (!hasComponents)
+		{
+			Time now = m_currentTime + updateDuration;
+
+			Time idleDuration = MaxIdleWait;
+			for (const auto& updaterEntry : m_updaters)
+				idleDuration = std::min(idleDuration, updaterEntry.nextUpdate - now);
+
+			waitDuration = std::max(waitDuration, idleDuration);
+		}
+
+		if (waitDuration <= Time::Zero())
+			return;
+
+		NazaraProfileScope("ApplicationBase::WaitForNextUpdate");
+
+		// Rate limits below 1 / MaxIdleWait sleep for several chunks to reach the deadline
+		Time wakeTime = updateDuration + waitDuration;
+		while (m_running)
+		{
+			Time remainingTime = wakeTime - m_clock.GetElapsedTime();
+			if (remainingTime <= SleepMargin)
+				break;
+
+			std::this_thread::sleep_for(std::min(remainingTime - SleepMargin, MaxIdleWait).AsDuration<std::chrono::nanoseconds>());
+		}
+
+		while (m_clock.GetElapsedTime() < wakeTime && m_running)
+			std::this_thread::yield();
+	}
+
 	ApplicationBase* ApplicationBase::s_instance = nullptr;
 }
@@ -0,0 +1,300 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/AsyncFileReader.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/ThreadExt.hpp>
+#include <NazaraUtils/EnumArray.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	struct AsyncFileReader::ReadRequest
+	{
+		enum class State
+		{
+			Cancelled,
+			Finished,
+			Pending,
+			Running
+		};
+
+		std::shared_ptr<File> file;
+		std::size_t readSize = 0;
+		std::size_t size;
+		void* buffer;
+		State state = State::Pending;
+		UInt64 offset;
+	};
+
+	// Outlives the reader as long as handles reference it, so waiting on a handle never touches a destroyed reader
+	struct AsyncFileReader::SharedState
+	{
+		std::condition_variable completionCondition;
+		std::condition_variable wakeCondition;
+		std::mutex mutex;
+		std::size_t pendingReadCount = 0;
+		EnumArray<FileReadPriority, std::deque<std::shared_ptr<ReadRequest>>> queues;
+		bool isStopping = false;
+	};
+
+	/*!
+	* \ingroup core
+	* \class Nz::AsyncFileReader
+	* \brief Core class reading files from background threads
+	*
+	* Reads are queued with a priority and performed by a small pool of dedicated threads, using positional reads (see File::ReadAt),
+	* keeping blocking I/O off the main thread and off the task scheduler workers.
+	* Threads take the queued reads in batches (highest priority first) and perform each batch ordered by file and offset to favor sequential accesses.
+	*
+	* \remark Buffers must stay valid until their read is finished or cancelled
+	*/
+
+	/*!
+	* \brief Constructs the reader and starts its threads
+	*
+	* \param threadCount Number of reading threads, more than one only helps with storage handling parallel requests (like SSDs)
+	* \param maxBatchSize Maximum number of reads taken at once by a thread
+	*/
+	AsyncFileReader::AsyncFileReader(unsigned int threadCount, std::size_t maxBatchSize) :
+	m_sharedState(std::make_shared<SharedState>()),
+	m_maxBatchSize(maxBatchSize)
+	{
+		NazaraAssert(threadCount > 0, "thread count must be over zero");
+		NazaraAssert(maxBatchSize > 0, "max batch size must be over zero");
+
+		m_threads.reserve(threadCount);
+		for (unsigned int i = 0; i < threadCount; ++i)
+			m_threads.emplace_back(&AsyncFileReader::ReaderThread, this);
+	}
+
+	/*!
+	* \brief Cancels queued reads, waits for running ones and stops the threads
+	*/
+	AsyncFileReader::~AsyncFileReader()
+	{
+		{
+			std::unique_lock lock(m_sharedState->mutex);
+			m_sharedState->isStopping = true;
+
+			for (auto& queue : m_sharedState->queues)
+			{
+				for (const std::shared_ptr<ReadRequest>& request : queue)
+				{
+					request->file.reset();
+					request->state = ReadRequest::State::Cancelled;
+				}
+
+				m_sharedState->pendingReadCount -= queue.size();
+				queue.clear();
+			}
+		}
+		m_sharedState->wakeCondition.notify_all();
+		m_sharedState->completionCondition.notify_all();
+
+		for (std::thread& thread : m_threads)
+			thread.join();
+	}
+
+	/*!
+	* \brief Gets the number of reads which are queued or running
+	*/
+	std::size_t AsyncFileReader::GetPendingReadCount() const
+	{
+		std::unique_lock lock(m_sharedState->mutex);
+		return m_sharedState->pendingReadCount;
+	}
+
+	/*!
+	* \brief Queues a read
+	* \return Handle allowing to wait for the read or to cancel it
+	*
+	* \param file Opened file to read from, kept alive until the read is done
+	* \param offset Offset of the first byte to read
+	* \param size Number of bytes to read
+	* \param buffer Buffer receiving the data, which must stay valid until the read is finished or cancelled
+	* \param priority Priority of the read, reads of higher priorities are performed first
+	*/
+	auto AsyncFileReader::Read(std::shared_ptr<File> file, UInt64 offset, std::size_t size, void* buffer, FileReadPriority priority) -> ReadHandle
+	{
+		NazaraAssert(file && file->IsOpen(), "invalid file");
+		NazaraAssert(buffer || size == 0, "invalid buffer");
+
+		std::shared_ptr<ReadRequest> request = std::make_shared<ReadRequest>();
+		request->buffer = buffer;
+		request->file = std::move(file);
+		request->offset = offset;
+		request->size = size;
+
+		{
+			std::unique_lock lock(m_sharedState->mutex);
+			m_sharedState->queues[priority].push_back(request);
+			m_sharedState->pendingReadCount++;
+		}
+		m_sharedState->wakeCondition.notify_one();
+
+		return ReadHandle(m_sharedState, std::move(request));
+	}
+
+	/*!
+	* \brief Waits until every queued read is finished
+	*/
+	void AsyncFileReader::WaitForReads()
+	{
+		std::unique_lock lock(m_sharedState->mutex);
+		m_sharedState->completionCondition.wait(lock, [&] { return m_sharedState->pendingReadCount == 0; });
+	}
+
+	void AsyncFileReader::ReaderThread()
+	{
+		SetCurrentThreadName("NzFileReader");
+
+		SharedState& sharedState = *m_sharedState;
+
+		std::vector<std::shared_ptr<ReadRequest>> batch;
+		for (;;)
+		{
+			{
+				std::unique_lock lock(sharedState.mutex);
+				sharedState.wakeCondition.wait(lock, [&]
+				{
+					return sharedState.isStopping || std::any_of(sharedState.queues.begin(), sharedState.queues.end(), [](const auto& queue) { return !queue.empty(); });
+				});
+
+				if (sharedState.isStopping)
+					return;
+
+				// Only batch reads of the highest priority, lower priority reads shouldn't delay higher priority ones
+				auto queueIt = std::find_if(sharedState.queues.begin(), sharedState.queues.end(), [](const auto& queue) { return !queue.empty(); });
+				auto& queue = *queueIt;
+
+				std::size_t batchSize = std::min(queue.size(), m_maxBatchSize);
+				for (std::size_t i = 0; i < batchSize; ++i)
+				{
+					queue.front()->state = ReadRequest::State::Running;
+					batch.push_back(std::move(queue.front()));
+					queue.pop_front();
+				}
+			}
+
+			std::sort(batch.begin(), batch.end(), [](const std::shared_ptr<ReadRequest>& lhs, const std::shared_ptr<ReadRequest>& rhs)
+			{
+				if (lhs->file != rhs->file)
+					return lhs->file < rhs->file;
+
+				return lhs->offset < rhs->offset;
+			});
+
+			// Running requests can't be cancelled, they're only accessed by this thread until they're marked as finished
+			for (const std::shared_ptr<ReadRequest>& request : batch)
+				request->readSize = (request->size > 0) ? request->file->ReadAt(request->offset, request->buffer, request->size) : 0;
+
+			{
+				std::unique_lock lock(sharedState.mutex);
+				for (const std::shared_ptr<ReadRequest>& request : batch)
+				{
+					request->file.reset();
+					request->state = ReadRequest::State::Finished;
+				}
+
+				sharedState.pendingReadCount -= batch.size();
+			}
+			sharedState.completionCondition.notify_all();
+
+			batch.clear();
+		}
+	}
+
+	/*!
+	* \ingroup core
+	* \class Nz::AsyncFileReader::ReadHandle
+	* \brief Handle to a read queued to an AsyncFileReader
+	*/
+
+	/*!
+	* \brief Cancels the read if it hasn't started yet
+	* \return True if the read was cancelled (its buffer won't be written), false if it's running or finished
+	*/
+	bool AsyncFileReader::ReadHandle::Cancel()
+	{
+		NazaraAssert(IsValid(), "invalid handle");
+
+		{
+			std::unique_lock lock(m_sharedState->mutex);
+			if (m_request->state == ReadRequest::State::Cancelled)
+				return true;
+
+			if (m_request->state != ReadRequest::State::Pending)
+				return false;
+
+			for (auto& queue : m_sharedState->queues)
+			{
+				auto it = std::find(queue.begin(), queue.end(), m_request);
+				if (it != queue.end())
+				{
+					queue.erase(it);
+					break;
+				}
+			}
+
+			m_request->file.reset();
+			m_request->state = ReadRequest::State::Cancelled;
+			m_sharedState->pendingReadCount--;
+		}
+		m_sharedState->completionCondition.notify_all();
+
+		return true;
+	}
+
+	/*!
+	* \brief Gets the number of bytes read
+	* \return Number of bytes read, which is less than the requested size if the end of the file was reached, zero if the read isn't finished
+	*/
+	std::size_t AsyncFileReader::ReadHandle::GetReadSize() const
+	{
+		NazaraAssert(IsValid(), "invalid handle");
+
+		std::unique_lock lock(m_sharedState->mutex);
+		return (m_request->state == ReadRequest::State::Finished) ? m_request->readSize : 0;
+	}
+
+	bool AsyncFileReader::ReadHandle::IsCancelled() const
+	{
+		NazaraAssert(IsValid(), "invalid handle");
+
+		std::unique_lock lock(m_sharedState->mutex);
+		return m_request->state == ReadRequest::State::Cancelled;
+	}
+
+	/*!
+	* \brief Checks if the read is finished
+	* \return True if the read was performed, false if it's pending, running or was cancelled
+	*/
+	bool AsyncFileReader::ReadHandle::IsFinished() const
+	{
+		NazaraAssert(IsValid(), "invalid handle");
+
+		std::unique_lock lock(m_sharedState->mutex);
+		return m_request->state == ReadRequest::State::Finished;
+	}
+
+	/*!
+	* \brief Waits until the read is finished or cancelled
+	* \return Number of bytes read, zero if the read was cancelled
+	*/
+	std::size_t AsyncFileReader::ReadHandle::Wait() const
+	{
+		NazaraAssert(IsValid(), "invalid handle");
+
+		std::unique_lock lock(m_sharedState->mutex);
+		m_sharedState->completionCondition.wait(lock, [&] { return m_request->state == ReadRequest::State::Finished || m_request->state == ReadRequest::State::Cancelled; });
+
+		return (m_request->state == ReadRequest::State::Finished) ? m_request->readSize : 0;
+	}
+}
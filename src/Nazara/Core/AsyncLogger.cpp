@@ -0,0 +1,244 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/AsyncLogger.hpp>
+#include <Nazara/Core/Format.hpp>
+#include <Nazara/Core/Log.hpp>
+#include <Nazara/Core/ThreadExt.hpp>
+#include <algorithm>
+#include <chrono>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::AsyncLogger
+	* \brief Core class that represents a logger writing records from a background thread
+	*
+	* Records are pushed to a lock-free queue and written by a dedicated thread, in batches, using a wrapped logger (such as FileLogger).
+	* This keeps file writes (and the formatting they need) off the threads which are logging.
+	*
+	* To bound memory usage, records are dropped when too many of them are pending, which is reported in the log once possible.
+	* Assertion failures are written synchronously, as the application is about to stop.
+	*
+	* \remark Log signals (Log::OnLogWrite and Log::OnLogWriteError) are emitted from the logging thread
+	*/
+
+	/*!
+	* \brief Constructs an AsyncLogger object wrapping another logger
+	*
+	* \param logger Logger used to write records, from the logging thread
+	* \param maxPendingRecords Number of records waiting to be written from which new ones are dropped
+	* \param flushInterval Maximum time between two batches of writes
+	*/
+	AsyncLogger::AsyncLogger(std::unique_ptr<AbstractLogger> logger, std::size_t maxPendingRecords, Time flushInterval) :
+	m_pendingRecordCount(0),
+	m_nextFlushTicket(0),
+	m_droppedRecordCount(0),
+	m_maxPendingRecords(maxPendingRecords),
+	m_logger(std::move(logger)),
+	m_flushInterval(flushInterval),
+	m_reportedDroppedRecordCount(0),
+	m_isFlushRequested(false),
+	m_isStopping(false)
+	{
+		NazaraAssert(m_logger, "invalid logger");
+
+		m_writerThread = std::thread(&AsyncLogger::WriterThread, this);
+	}
+
+	/*!
+	* \brief Destructs the object, writing pending records
+	*/
+	AsyncLogger::~AsyncLogger()
+	{
+		{
+			std::unique_lock lock(m_mutex);
+			m_isStopping = true;
+		}
+		m_wakeCondition.notify_one();
+
+		m_writerThread.join();
+	}
+
+	bool AsyncLogger::DispatchesLogSignals() const
+	{
+		return true;
+	}
+
+	void AsyncLogger::EnableStdReplication(bool enable)
+	{
+		std::unique_lock lock(m_loggerMutex);
+		m_logger->EnableStdReplication(enable);
+	}
+
+	/*!
+	* \brief Waits until every record written by the calling thread before this call has been written by the wrapped logger
+	*
+	* A flush marker is queued after the records of the calling thread, this function returns once the logging thread processed it.
+	*
+	* \remark Does nothing when called from the logging thread (e.g. by the wrapped logger)
+	*/
+	void AsyncLogger::Flush()
+	{
+		if (std::this_thread::get_id() == m_writerThread.get_id())
+			return;
+
+		// Flush markers bypass the pending record limit, they must never be dropped
+		Record flushMarker;
+		flushMarker.flushTicket = m_nextFlushTicket.fetch_add(1, std::memory_order_relaxed) + 1;
+		flushMarker.isError = false;
+
+		UInt64 flushTicket = flushMarker.flushTicket;
+		m_records.Push(std::move(flushMarker));
+
+		std::unique_lock lock(m_mutex);
+		m_isFlushRequested = true;
+		m_wakeCondition.notify_one();
+
+		m_flushCondition.wait(lock, [&]
+		{
+			auto it = std::find(m_completedFlushTickets.begin(), m_completedFlushTickets.end(), flushTicket);
+			if (it == m_completedFlushTickets.end())
+				return false;
+
+			m_completedFlushTickets.erase(it);
+			return true;
+		});
+	}
+
+	bool AsyncLogger::IsStdReplicationEnabled() const
+	{
+		std::unique_lock lock(m_loggerMutex);
+		return m_logger->IsStdReplicationEnabled();
+	}
+
+	/*!
+	* \brief Queues a string to be written in the log
+	*
+	* \param string String to log
+	*/
+	void AsyncLogger::Write(std::string_view string)
+	{
+		Record record;
+		record.message = string;
+		record.isError = false;
+
+		PushRecord(std::move(record));
+	}
+
+	/*!
+	* \brief Queues an error to be written in the log
+	*
+	* \param type The error type
+	* \param error The error text
+	* \param line The line the error occurred
+	* \param file The file the error occurred
+	* \param function The function the error occurred
+	*
+	* \remark Assertion failures are written before returning
+	*/
+	void AsyncLogger::WriteError(ErrorType type, std::string_view error, unsigned int line, const char* file, const char* function)
+	{
+		Record record;
+		record.message = error;
+		record.errorType = type;
+		record.line = line;
+		record.isError = true;
+
+		if (file)
+			record.file = file;
+
+		if (function)
+			record.function = function;
+
+		PushRecord(std::move(record));
+
+		if (type == ErrorType::AssertFailed)
+			Flush();
+	}
+
+	void AsyncLogger::PushRecord(Record&& record)
+	{
+		if (m_pendingRecordCount.fetch_add(1, std::memory_order_relaxed) >= m_maxPendingRecords)
+		{
+			m_pendingRecordCount.fetch_sub(1, std::memory_order_relaxed);
+			m_droppedRecordCount.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		m_records.Push(std::move(record));
+	}
+
+	void AsyncLogger::WriterThread()
+	{
+		SetCurrentThreadName("NzAsyncLogger");
+
+		std::vector<UInt64> flushTickets;
+
+		std::unique_lock lock(m_mutex);
+		for (;;)
+		{
+			m_wakeCondition.wait_for(lock, m_flushInterval.AsDuration<std::chrono::microseconds>(), [&] { return m_isFlushRequested || m_isStopping; });
+
+			bool isStopping = m_isStopping;
+			m_isFlushRequested = false;
+			lock.unlock();
+
+			WriteRecords(flushTickets);
+
+			lock.lock();
+			if (!flushTickets.empty())
+			{
+				m_completedFlushTickets.insert(m_completedFlushTickets.end(), flushTickets.begin(), flushTickets.end());
+				flushTickets.clear();
+
+				m_flushCondition.notify_all();
+			}
+
+			if (isStopping)
+				break;
+		}
+	}
+
+	void AsyncLogger::WriteRecords(std::vector<UInt64>& flushTickets)
+	{
+		std::unique_lock lock(m_loggerMutex);
+
+		Record record;
+		while (m_records.Pop(record))
+		{
+			if (record.flushTicket != 0)
+			{
+				// Records pushed by the flushing thread before the marker have been written, the flush completes at the end of this batch
+				flushTickets.push_back(record.flushTicket);
+				continue;
+			}
+
+			m_pendingRecordCount.fetch_sub(1, std::memory_order_relaxed);
+
+			if (record.isError)
+			{
+				const char* file = (!record.file.empty()) ? record.file.c_str() : nullptr;
+				const char* function = (!record.function.empty()) ? record.function.c_str() : nullptr;
+
+				m_logger->WriteError(record.errorType, record.message, record.line, file, function);
+				Log::OnLogWriteError(record.errorType, record.message, record.line, file, function);
+			}
+			else
+			{
+				m_logger->Write(record.message);
+				Log::OnLogWrite(record.message);
+			}
+		}
+
+		UInt64 droppedRecordCount = m_droppedRecordCount.load(std::memory_order_relaxed);
+		if (droppedRecordCount != m_reportedDroppedRecordCount)
+		{
+			m_logger->Write(Format("{0} log records were dropped as too many of them were pending", droppedRecordCount - m_reportedDroppedRecordCount));
+			m_reportedDroppedRecordCount = droppedRecordCount;
+		}
+	}
+}
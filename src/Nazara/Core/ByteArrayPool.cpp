@@ -0,0 +1,188 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/ByteArrayPool.hpp>
+#include <Nazara/Core/MemoryTracker.hpp>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		std::size_t FloorLog2(std::size_t value)
+		{
+			std::size_t log2 = 0;
+			while (value >>= 1)
+				log2++;
+
+			return log2;
+		}
+	}
+
+	/*!
+	* \ingroup core
+	* \class Nz::ByteArrayPool
+	* \brief Thread-safe pool of byte arrays, bucketed by power-of-two capacity
+	*
+	* Each size class holds arrays whose capacity lies between its capacity and the next one, acquiring an array is a pop from the matching class.
+	* Every size class has its own lock so threads working on different sizes don't contend, and retains at most a fixed amount of bytes.
+	*
+	* Retained bytes are accounted under the pool memory tag by the MemoryTracker, arrays given by the pool belong to their user.
+	*/
+
+	/*!
+	* \brief Constructs a pool
+	*
+	* \param maxRetainedBytesPerClass Maximum number of bytes kept by each size class, arrays returned past this limit are freed
+	* \param memoryTag Subsystem to which retained bytes are accounted
+	*/
+	ByteArrayPool::ByteArrayPool(std::size_t maxRetainedBytesPerClass, MemoryTag memoryTag) :
+	m_maxRetainedBytesPerClass(maxRetainedBytesPerClass),
+	m_memoryTag(memoryTag)
+	{
+	}
+
+	ByteArrayPool::~ByteArrayPool()
+	{
+		Clear();
+	}
+
+	/*!
+	* \brief Frees every retained byte array
+	*/
+	void ByteArrayPool::Clear()
+	{
+		for (SizeClass& sizeClass : m_sizeClasses)
+		{
+			std::unique_lock lock(sizeClass.mutex);
+			NazaraTrackDeallocation(m_memoryTag, sizeClass.retainedBytes);
+			sizeClass.byteArrays.clear();
+			sizeClass.retainedBytes = 0;
+		}
+	}
+
+	/*!
+	* \brief Gets an empty byte array with at least the given capacity
+	* \return A retained byte array if its size class has one, a newly allocated byte array otherwise
+	*
+	* \param capacity Minimum capacity of the byte array
+	*
+	* \remark Capacities bigger than the largest size class are allocated directly
+	*/
+	ByteArray ByteArrayPool::GetByteArray(std::size_t capacity)
+	{
+		std::size_t sizeClassIndex = GetAcquireSizeClass(capacity);
+		if (sizeClassIndex >= SizeClassCount)
+		{
+			ByteArray byteArray;
+			byteArray.Reserve(capacity);
+
+			return byteArray;
+		}
+
+		SizeClass& sizeClass = m_sizeClasses[sizeClassIndex];
+		{
+			std::unique_lock lock(sizeClass.mutex);
+			if (!sizeClass.byteArrays.empty())
+			{
+				ByteArray byteArray = std::move(sizeClass.byteArrays.back());
+				sizeClass.byteArrays.pop_back();
+				sizeClass.retainedBytes -= byteArray.GetCapacity();
+				NazaraTrackDeallocation(m_memoryTag, byteArray.GetCapacity());
+
+				return byteArray;
+			}
+		}
+
+		ByteArray byteArray;
+		byteArray.Reserve(GetSizeClassCapacity(sizeClassIndex));
+
+		return byteArray;
+	}
+
+	/*!
+	* \brief Gets the number of bytes currently retained by the pool
+	*/
+	std::size_t ByteArrayPool::GetRetainedBytes() const
+	{
+		std::size_t retainedBytes = 0;
+		for (SizeClass& sizeClass : m_sizeClasses)
+		{
+			std::unique_lock lock(sizeClass.mutex);
+			retainedBytes += sizeClass.retainedBytes;
+		}
+
+		return retainedBytes;
+	}
+
+	/*!
+	* \brief Gives a byte array back to the pool
+	*
+	* \param byteArray Byte array to retain, its content is cleared but its buffer is kept
+	*
+	* \remark The byte array is freed if its capacity is out of the size classes range or if its size class is full
+	*/
+	void ByteArrayPool::ReturnByteArray(ByteArray byteArray)
+	{
+		std::size_t capacity = byteArray.GetCapacity();
+		if (capacity < GetSizeClassCapacity(0))
+			return;
+
+		std::size_t sizeClassIndex = GetReturnSizeClass(capacity);
+		if (sizeClassIndex >= SizeClassCount)
+			return;
+
+		byteArray.Clear(true);
+
+		SizeClass& sizeClass = m_sizeClasses[sizeClassIndex];
+
+		std::unique_lock lock(sizeClass.mutex);
+		if (sizeClass.retainedBytes + capacity > m_maxRetainedBytesPerClass)
+			return; //< byteArray is freed once the lock is released
+
+		sizeClass.byteArrays.push_back(std::move(byteArray));
+		sizeClass.retainedBytes += capacity;
+		NazaraTrackAllocation(m_memoryTag, capacity);
+	}
+
+	/*!
+	* \brief Sets the maximum number of bytes retained by each size class
+	*
+	* \param maxRetainedBytes Maximum number of bytes, arrays already retained past this limit are freed
+	*
+	* \remark Unlike other methods, this must not be called while other threads are using the pool
+	*/
+	void ByteArrayPool::SetMaxRetainedBytesPerClass(std::size_t maxRetainedBytes)
+	{
+		m_maxRetainedBytesPerClass = maxRetainedBytes;
+
+		for (SizeClass& sizeClass : m_sizeClasses)
+		{
+			std::unique_lock lock(sizeClass.mutex);
+			while (sizeClass.retainedBytes > m_maxRetainedBytesPerClass)
+			{
+				std::size_t capacity = sizeClass.byteArrays.back().GetCapacity();
+				sizeClass.retainedBytes -= capacity;
+				sizeClass.byteArrays.pop_back();
+
+				NazaraTrackDeallocation(m_memoryTag, capacity);
+			}
+		}
+	}
+
+	std::size_t ByteArrayPool::GetAcquireSizeClass(std::size_t capacity)
+	{
+		// Smallest class whose capacity is at least the requested one
+		if (capacity <= GetSizeClassCapacity(0))
+			return 0;
+
+		return FloorLog2(capacity - 1) + 1 - MinSizeClassShift;
+	}
+
+	std::size_t ByteArrayPool::GetReturnSizeClass(std::size_t capacity)
+	{
+		// Biggest class whose capacity is at most the array one, so that every array in a class can serve any request of that class
+		return FloorLog2(capacity) - MinSizeClassShift;
+	}
+}
@@ -8,7 +8,6 @@
 #include <Nazara/Core/HardwareInfo.hpp>
 #include <Nazara/Core/Log.hpp>
 #include <Nazara/Core/PluginLoader.hpp>
-#include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -31,12 +30,25 @@ namespace Nz
 
 	Core::~Core()
 	{
+		m_taskScheduler.reset();
 		m_hardwareInfo.reset();
 
-		TaskScheduler::Uninitialize();
 		LogUninit();
 		Log::Uninitialize();
 	}
 
+	/*!
+	* \brief Returns the engine task scheduler, starting its worker threads on first call
+	* \return Task scheduler shared by the engine modules
+	*
+	* \remark This function can be called from multiple threads at once
+	*/
+	TaskScheduler& Core::GetTaskScheduler()
+	{
+		std::call_once(m_taskSchedulerInitFlag, [&] { m_taskScheduler.emplace(); });
+
+		return *m_taskScheduler;
+	}
+
 	Core* Core::s_instance = nullptr;
 }
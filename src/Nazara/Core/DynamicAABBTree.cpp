@@ -0,0 +1,408 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+// Based on the dynamic AABB tree of Box2D by Erin Catto (zlib license)
+// https://github.com/erincatto/box2d
+
+#include <Nazara/Core/DynamicAABBTree.hpp>
+#include <algorithm>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::DynamicAABBTree
+	* \brief Core class that represents a bounding volume hierarchy of axis-aligned boxes which can be updated incrementally
+	*
+	* Every proxy is stored with an AABB enlarged by a margin (its "fat AABB"), allowing small moves to be handled without touching the tree.
+	* Insertion uses a surface area heuristic to choose where to put the new leaf and tree rotations keep it balanced.
+	*/
+
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		// Half the surface area of the box
+		float ComputeCost(const Vector3f& min, const Vector3f& max)
+		{
+			Vector3f lengths = max - min;
+			return lengths.x * lengths.y + lengths.y * lengths.z + lengths.z * lengths.x;
+		}
+
+		template<typename N>
+		void Merge(N& target, const N& first, const N& second)
+		{
+			target.min = Vector3f::Min(first.min, second.min);
+			target.max = Vector3f::Max(first.max, second.max);
+		}
+	}
+
+	/*!
+	* \brief Constructs an empty tree
+	*
+	* \param margin Distance by which the AABB of each proxy are extended, bigger margins means less tree updates but more false positives when querying
+	*/
+	DynamicAABBTree::DynamicAABBTree(float margin) :
+	m_freeList(InvalidProxy),
+	m_proxyCount(0),
+	m_root(InvalidProxy),
+	m_margin(margin)
+	{
+	}
+
+	/*!
+	* \brief Inserts a new proxy in the tree
+	* \return Proxy identifier, stays valid until RemoveProxy or Clear is called
+	*
+	* \param aabb Bounding box of the proxy
+	* \param userData Value reported by queries for this proxy
+	*/
+	std::size_t DynamicAABBTree::AddProxy(const Boxf& aabb, std::size_t userData)
+	{
+		std::size_t proxyId = AllocateNode();
+
+		Node& node = m_nodes[proxyId];
+		node.min = aabb.GetMinimum() - Vector3f(m_margin);
+		node.max = aabb.GetMaximum() + Vector3f(m_margin);
+		node.userData = userData;
+
+		InsertLeaf(proxyId);
+		m_proxyCount++;
+
+		return proxyId;
+	}
+
+	/*!
+	* \brief Removes every proxy from the tree
+	*/
+	void DynamicAABBTree::Clear()
+	{
+		m_freeList = InvalidProxy;
+		m_nodes.clear();
+		m_proxyCount = 0;
+		m_root = InvalidProxy;
+	}
+
+	/*!
+	* \brief Updates the AABB of a proxy
+	* \return true if the proxy was reinserted in the tree, false if its fat AABB still contained the new AABB
+	*
+	* \param proxyId Proxy identifier
+	* \param aabb New bounding box of the proxy
+	*/
+	bool DynamicAABBTree::MoveProxy(std::size_t proxyId, const Boxf& aabb)
+	{
+		NazaraAssert(proxyId < m_nodes.size() && m_nodes[proxyId].height == 0, "invalid proxy");
+
+		Vector3f aabbMin = aabb.GetMinimum();
+		Vector3f aabbMax = aabb.GetMaximum();
+
+		Node& node = m_nodes[proxyId];
+		if (node.min.x <= aabbMin.x && node.min.y <= aabbMin.y && node.min.z <= aabbMin.z &&
+		    node.max.x >= aabbMax.x && node.max.y >= aabbMax.y && node.max.z >= aabbMax.z)
+			return false;
+
+		RemoveLeaf(proxyId);
+
+		node.min = aabbMin - Vector3f(m_margin);
+		node.max = aabbMax + Vector3f(m_margin);
+
+		InsertLeaf(proxyId);
+
+		return true;
+	}
+
+	/*!
+	* \brief Removes a proxy from the tree
+	*
+	* \param proxyId Proxy identifier
+	*/
+	void DynamicAABBTree::RemoveProxy(std::size_t proxyId)
+	{
+		NazaraAssert(proxyId < m_nodes.size() && m_nodes[proxyId].height == 0, "invalid proxy");
+
+		RemoveLeaf(proxyId);
+		FreeNode(proxyId);
+		m_proxyCount--;
+	}
+
+	std::size_t DynamicAABBTree::AllocateNode()
+	{
+		std::size_t nodeIndex;
+		if (m_freeList != InvalidProxy)
+		{
+			nodeIndex = m_freeList;
+			m_freeList = m_nodes[nodeIndex].parent;
+		}
+		else
+		{
+			nodeIndex = m_nodes.size();
+			m_nodes.emplace_back();
+		}
+
+		Node& node = m_nodes[nodeIndex];
+		node.child1 = InvalidProxy;
+		node.child2 = InvalidProxy;
+		node.parent = InvalidProxy;
+		node.userData = 0;
+		node.height = 0;
+
+		return nodeIndex;
+	}
+
+	std::size_t DynamicAABBTree::Balance(std::size_t nodeIndex)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		// Rotates the higher child up if children heights differ by more than one, returns the new root of the subtree
+		Node& a = m_nodes[nodeIndex];
+		if (a.IsLeaf() || a.height < 2)
+			return nodeIndex;
+
+		std::size_t bIndex = a.child1;
+		std::size_t cIndex = a.child2;
+		Node& b = m_nodes[bIndex];
+		Node& c = m_nodes[cIndex];
+
+		int balance = c.height - b.height;
+
+		auto ReplaceInParent = [&](std::size_t newNodeIndex, std::size_t parentIndex)
+		{
+			if (parentIndex != InvalidProxy)
+			{
+				Node& parent = m_nodes[parentIndex];
+				if (parent.child1 == nodeIndex)
+					parent.child1 = newNodeIndex;
+				else
+				{
+					NazaraAssert(parent.child2 == nodeIndex, "broken tree");
+					parent.child2 = newNodeIndex;
+				}
+			}
+			else
+				m_root = newNodeIndex;
+		};
+
+		if (balance > 1)
+		{
+			// Rotate C up
+			std::size_t fIndex = c.child1;
+			std::size_t gIndex = c.child2;
+			Node& f = m_nodes[fIndex];
+			Node& g = m_nodes[gIndex];
+
+			c.child1 = nodeIndex;
+			c.parent = a.parent;
+			a.parent = cIndex;
+			ReplaceInParent(cIndex, c.parent);
+
+			if (f.height > g.height)
+			{
+				c.child2 = fIndex;
+				a.child2 = gIndex;
+				g.parent = nodeIndex;
+				Merge(a, b, g);
+				Merge(c, a, f);
+
+				a.height = 1 + std::max(b.height, g.height);
+				c.height = 1 + std::max(a.height, f.height);
+			}
+			else
+			{
+				c.child2 = gIndex;
+				a.child2 = fIndex;
+				f.parent = nodeIndex;
+				Merge(a, b, f);
+				Merge(c, a, g);
+
+				a.height = 1 + std::max(b.height, f.height);
+				c.height = 1 + std::max(a.height, g.height);
+			}
+
+			return cIndex;
+		}
+
+		if (balance < -1)
+		{
+			// Rotate B up
+			std::size_t dIndex = b.child1;
+			std::size_t eIndex = b.child2;
+			Node& d = m_nodes[dIndex];
+			Node& e = m_nodes[eIndex];
+
+			b.child1 = nodeIndex;
+			b.parent = a.parent;
+			a.parent = bIndex;
+			ReplaceInParent(bIndex, b.parent);
+
+			if (d.height > e.height)
+			{
+				b.child2 = dIndex;
+				a.child1 = eIndex;
+				e.parent = nodeIndex;
+				Merge(a, c, e);
+				Merge(b, a, d);
+
+				a.height = 1 + std::max(c.height, e.height);
+				b.height = 1 + std::max(a.height, d.height);
+			}
+			else
+			{
+				b.child2 = eIndex;
+				a.child1 = dIndex;
+				d.parent = nodeIndex;
+				Merge(a, c, d);
+				Merge(b, a, e);
+
+				a.height = 1 + std::max(c.height, d.height);
+				b.height = 1 + std::max(a.height, e.height);
+			}
+
+			return bIndex;
+		}
+
+		return nodeIndex;
+	}
+
+	void DynamicAABBTree::FreeNode(std::size_t nodeIndex)
+	{
+		Node& node = m_nodes[nodeIndex];
+		node.parent = m_freeList;
+		node.height = -1;
+
+		m_freeList = nodeIndex;
+	}
+
+	void DynamicAABBTree::InsertLeaf(std::size_t leafIndex)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		if (m_root == InvalidProxy)
+		{
+			m_root = leafIndex;
+			m_nodes[leafIndex].parent = InvalidProxy;
+			return;
+		}
+
+		// Find the best sibling for the new leaf
+		Vector3f leafMin = m_nodes[leafIndex].min;
+		Vector3f leafMax = m_nodes[leafIndex].max;
+
+		auto ComputeDescentCost = [&](const Node& child, float inheritanceCost)
+		{
+			float cost = ComputeCost(Vector3f::Min(leafMin, child.min), Vector3f::Max(leafMax, child.max));
+			if (!child.IsLeaf())
+				cost -= ComputeCost(child.min, child.max);
+
+			return cost + inheritanceCost;
+		};
+
+		std::size_t siblingIndex = m_root;
+		while (!m_nodes[siblingIndex].IsLeaf())
+		{
+			const Node& node = m_nodes[siblingIndex];
+
+			float area = ComputeCost(node.min, node.max);
+			float combinedArea = ComputeCost(Vector3f::Min(leafMin, node.min), Vector3f::Max(leafMax, node.max));
+
+			// Cost of creating a new parent for this node and the new leaf
+			float cost = 2.f * combinedArea;
+
+			// Minimum cost of pushing the leaf further down the tree
+			float inheritanceCost = 2.f * (combinedArea - area);
+
+			float cost1 = ComputeDescentCost(m_nodes[node.child1], inheritanceCost);
+			float cost2 = ComputeDescentCost(m_nodes[node.child2], inheritanceCost);
+
+			if (cost < cost1 && cost < cost2)
+				break;
+
+			siblingIndex = (cost1 < cost2) ? node.child1 : node.child2;
+		}
+
+		// Create a new parent (this may reallocate the node storage)
+		std::size_t newParentIndex = AllocateNode();
+
+		Node& sibling = m_nodes[siblingIndex];
+		Node& leaf = m_nodes[leafIndex];
+		Node& newParent = m_nodes[newParentIndex];
+
+		std::size_t oldParentIndex = sibling.parent;
+		newParent.parent = oldParentIndex;
+		newParent.child1 = siblingIndex;
+		newParent.child2 = leafIndex;
+		newParent.height = sibling.height + 1;
+		Merge(newParent, sibling, leaf);
+
+		if (oldParentIndex != InvalidProxy)
+		{
+			Node& oldParent = m_nodes[oldParentIndex];
+			if (oldParent.child1 == siblingIndex)
+				oldParent.child1 = newParentIndex;
+			else
+				oldParent.child2 = newParentIndex;
+		}
+		else
+			m_root = newParentIndex;
+
+		sibling.parent = newParentIndex;
+		leaf.parent = newParentIndex;
+
+		RefitAncestors(newParentIndex);
+	}
+
+	void DynamicAABBTree::RefitAncestors(std::size_t nodeIndex)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		while (nodeIndex != InvalidProxy)
+		{
+			nodeIndex = Balance(nodeIndex);
+
+			Node& node = m_nodes[nodeIndex];
+			const Node& child1 = m_nodes[node.child1];
+			const Node& child2 = m_nodes[node.child2];
+
+			node.height = 1 + std::max(child1.height, child2.height);
+			Merge(node, child1, child2);
+
+			nodeIndex = node.parent;
+		}
+	}
+
+	void DynamicAABBTree::RemoveLeaf(std::size_t leafIndex)
+	{
+		if (leafIndex == m_root)
+		{
+			m_root = InvalidProxy;
+			return;
+		}
+
+		std::size_t parentIndex = m_nodes[leafIndex].parent;
+		const Node& parent = m_nodes[parentIndex];
+
+		std::size_t grandParentIndex = parent.parent;
+		std::size_t siblingIndex = (parent.child1 == leafIndex) ? parent.child2 : parent.child1;
+
+		if (grandParentIndex != InvalidProxy)
+		{
+			// Replace the parent by the sibling
+			Node& grandParent = m_nodes[grandParentIndex];
+			if (grandParent.child1 == parentIndex)
+				grandParent.child1 = siblingIndex;
+			else
+				grandParent.child2 = siblingIndex;
+
+			m_nodes[siblingIndex].parent = grandParentIndex;
+			FreeNode(parentIndex);
+
+			RefitAncestors(grandParentIndex);
+		}
+		else
+		{
+			m_root = siblingIndex;
+			m_nodes[siblingIndex].parent = InvalidProxy;
+			FreeNode(parentIndex);
+		}
+	}
+}
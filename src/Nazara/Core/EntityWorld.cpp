@@ -8,4 +8,9 @@
 namespace Nz
 {
 	EntityWorld::~EntityWorld() = default;
+
+	bool EntityWorld::IsMainThreadOnly() const
+	{
+		return m_isMainThreadOnly;
+	}
 }
@@ -0,0 +1,258 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/EnttSnapshot.hpp>
+#include <NazaraUtils/CallOnExit.hpp>
+#include <NazaraUtils/Endianness.hpp>
+#include <algorithm>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::EnttSnapshot
+	* \brief Core class used to save and load the components of a registry in a binary format
+	*
+	* Only registered components are stored, as blocks of components of the same type:
+	* - components which can be bulk copied (see EnttSnapshotComponent) are stored as a single memory block, in native endianness
+	* - other components are stored one after the other using EnttSnapshotComponent<T>::Serialize
+	*
+	* Entities are created when loading a snapshot and snapshot entities are remapped to them, full snapshots start a new mapping.
+	*
+	* Component changes are tracked from the registry signals, which allows to save incremental snapshots containing
+	* only components emplaced, patched, replaced or removed (and entities destroyed) since last snapshot (see SaveChanges).
+	*/
+
+	static_assert(sizeof(entt::entity) == sizeof(UInt32), "entities are expected to be 32-bit identifiers");
+
+	EnttSnapshot::EnttSnapshot(entt::registry& registry) :
+	m_registry(registry),
+	m_isLoading(false)
+	{
+	}
+
+	EnttSnapshot::~EnttSnapshot() = default;
+
+	/*!
+	* \brief Forgets every change made since last snapshot, next incremental snapshot will only contain further changes
+	*/
+	void EnttSnapshot::ClearChanges()
+	{
+		for (auto& componentPtr : m_components)
+		{
+			componentPtr->removedEntities.clear();
+			componentPtr->updatedEntities.clear();
+		}
+	}
+
+	/*!
+	* \brief Loads a snapshot (full or incremental) in the registry
+	* \return True if the snapshot was successfully loaded
+	*
+	* Loading a full snapshot creates new entities, incremental snapshots have to be loaded after the snapshot they're based on.
+	* Changes made by loading a snapshot are not tracked.
+	*
+	* \param context Context of unserialization
+	*/
+	bool EnttSnapshot::Load(SerializationContext& context)
+	{
+		UInt32 magic;
+		if (!Unserialize(context, &magic))
+			return false;
+
+		if (magic != Magic)
+		{
+			NazaraError("invalid snapshot magic");
+			return false;
+		}
+
+		UInt16 version;
+		if (!Unserialize(context, &version))
+			return false;
+
+		if (version != Version)
+		{
+			NazaraError("unsupported snapshot version {0}", version);
+			return false;
+		}
+
+		bool isIncremental;
+		if (!Unserialize(context, &isIncremental))
+			return false;
+
+		UInt8 endianness;
+		if (!Unserialize(context, &endianness))
+			return false;
+
+		bool isSwapped = static_cast<Endianness>(endianness) != PlatformEndianness;
+
+		m_isLoading = true;
+		CallOnExit resetLoading([this] { m_isLoading = false; });
+
+		if (!isIncremental)
+			m_entityRemapping.clear();
+
+		if (!ReadEntities(context, m_entityBuffer, isSwapped))
+			return false;
+
+		for (entt::entity entity : m_entityBuffer)
+		{
+			auto it = m_entityRemapping.find(entity);
+			if (it == m_entityRemapping.end())
+				continue;
+
+			if (m_registry.valid(it->second))
+				m_registry.destroy(it->second);
+
+			m_entityRemapping.erase(it);
+		}
+
+		UInt32 componentCount;
+		if (!Unserialize(context, &componentCount))
+			return false;
+
+		for (UInt32 i = 0; i < componentCount; ++i)
+		{
+			UInt32 componentId;
+			if (!Unserialize(context, &componentId))
+				return false;
+
+			bool isBulkCopied;
+			if (!Unserialize(context, &isBulkCopied))
+				return false;
+
+			auto it = std::find_if(m_components.begin(), m_components.end(), [&](const std::unique_ptr<ComponentBase>& component) { return component->componentId == componentId; });
+			if (it == m_components.end())
+			{
+				NazaraError("snapshot contains unregistered component {0}", componentId);
+				return false;
+			}
+
+			if (!(*it)->Load(*this, context, isBulkCopied, isSwapped))
+			{
+				NazaraError("failed to load component {0}", componentId);
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/*!
+	* \brief Saves every registered component of the registry
+	* \return True if the snapshot was successfully saved
+	*
+	* This also clears tracked changes, as the snapshot becomes the base of the next incremental snapshot.
+	*
+	* \param context Context of serialization
+	*/
+	bool EnttSnapshot::Save(SerializationContext& context)
+	{
+		return SaveInternal(context, false);
+	}
+
+	/*!
+	* \brief Saves the changes made to registered components since the last snapshot
+	* \return True if the snapshot was successfully saved
+	*
+	* \param context Context of serialization
+	*
+	* \see MarkUpdated
+	*/
+	bool EnttSnapshot::SaveChanges(SerializationContext& context)
+	{
+		return SaveInternal(context, true);
+	}
+
+	bool EnttSnapshot::ReadEntities(SerializationContext& context, std::vector<entt::entity>& entities, bool isSwapped)
+	{
+		UInt32 entityCount;
+		if (!Unserialize(context, &entityCount))
+			return false;
+
+		entities.resize(entityCount);
+		std::size_t byteSize = entities.size() * sizeof(entt::entity);
+
+		context.ResetReadBitPosition();
+		if (context.stream->Read(entities.data(), byteSize) != byteSize)
+			return false;
+
+		if (isSwapped)
+		{
+			for (entt::entity& entity : entities)
+				entity = static_cast<entt::entity>(ByteSwap(static_cast<UInt32>(entity)));
+		}
+
+		return true;
+	}
+
+	entt::entity EnttSnapshot::RemapEntity(entt::entity snapshotEntity)
+	{
+		auto it = m_entityRemapping.find(snapshotEntity);
+		if (it != m_entityRemapping.end() && m_registry.valid(it->second))
+			return it->second;
+
+		entt::entity entity = m_registry.create();
+		m_entityRemapping.insert_or_assign(snapshotEntity, entity);
+
+		return entity;
+	}
+
+	bool EnttSnapshot::SaveInternal(SerializationContext& context, bool changesOnly)
+	{
+		if (!Serialize(context, Magic))
+			return false;
+
+		if (!Serialize(context, Version))
+			return false;
+
+		if (!Serialize(context, changesOnly))
+			return false;
+
+		if (!Serialize(context, static_cast<UInt8>(PlatformEndianness)))
+			return false;
+
+		m_entityBuffer.clear();
+		if (changesOnly)
+		{
+			for (auto& componentPtr : m_components)
+				componentPtr->RegisterDestroyedEntities(m_entityBuffer);
+
+			std::sort(m_entityBuffer.begin(), m_entityBuffer.end());
+			m_entityBuffer.erase(std::unique(m_entityBuffer.begin(), m_entityBuffer.end()), m_entityBuffer.end());
+		}
+
+		if (!WriteEntities(context, m_entityBuffer))
+			return false;
+
+		if (!Serialize(context, SafeCast<UInt32>(m_components.size())))
+			return false;
+
+		for (auto& componentPtr : m_components)
+		{
+			if (!componentPtr->Save(*this, context, changesOnly))
+			{
+				NazaraError("failed to save component {0}", componentPtr->componentId);
+				return false;
+			}
+		}
+
+		ClearChanges();
+		return true;
+	}
+
+	bool EnttSnapshot::WriteEntities(SerializationContext& context, const std::vector<entt::entity>& entities)
+	{
+		if (!Serialize(context, SafeCast<UInt32>(entities.size())))
+			return false;
+
+		std::size_t byteSize = entities.size() * sizeof(entt::entity);
+
+		context.FlushBits();
+		return context.stream->Write(entities.data(), byteSize) == byteSize;
+	}
+
+	EnttSnapshot::ComponentBase::~ComponentBase() = default;
+}
@@ -3,35 +3,271 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Core/EnttSystemGraph.hpp>
+#include <Nazara/Core/Core.hpp>
+#include <Nazara/Core/Log.hpp>
+#include <algorithm>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
 {
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		bool Intersects(const std::vector<entt::id_type>& lhs, const std::vector<entt::id_type>& rhs)
+		{
+			for (entt::id_type id : lhs)
+			{
+				if (std::find(rhs.begin(), rhs.end(), id) != rhs.end())
+					return true;
+			}
+
+			return false;
+		}
+	}
+
 	EnttSystemGraph::NodeBase::~NodeBase() = default;
 
+	bool EnttSystemGraph::NodeBase::ConflictsWith(const NodeBase& node) const
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		if (!allowConcurrent || !node.allowConcurrent)
+			return true;
+
+		if (accessAllComponents || node.accessAllComponents)
+			return true;
+
+		// Systems only reading the same components can run concurrently
+		return Intersects(writeComponents, node.writeComponents) || Intersects(writeComponents, node.readComponents) || Intersects(readComponents, node.writeComponents);
+	}
+
+	/*!
+	* \brief Checks if any system of the graph declares RunOnMainThread
+	*
+	* Such a graph must be updated from the main thread for these systems to run on it.
+	*/
+	bool EnttSystemGraph::HasMainThreadSystems() const
+	{
+		return std::any_of(m_nodes.begin(), m_nodes.end(), [](const std::unique_ptr<NodeBase>& node) { return node->runOnMainThread; });
+	}
+
+	/*!
+	* \brief Writes the timing statistics of every system to the log
+	*/
+	void EnttSystemGraph::LogTimingStats() const
+	{
+		ForEachSystemTimingStats([](std::string_view name, const TimingStats& stats)
+		{
+			NazaraNotice("{0}: {1}", name, stats.ToString());
+		});
+	}
+
+	/*!
+	* \brief Clears the timing statistics of every system, keeping their budget
+	*/
+	void EnttSystemGraph::ResetTimingStats()
+	{
+		for (auto& nodePtr : m_nodes)
+			nodePtr->timingStats.Reset();
+	}
+
 	void EnttSystemGraph::Update()
 	{
 		return Update(m_clock.Restart());
 	}
 
+	/*!
+	* \brief Updates every system of the graph
+	*
+	* Systems are run by execution order, however systems which don't share any component they write (see below) can run concurrently on the engine task scheduler,
+	* two systems conflicting are always run one after the other in execution order.
+	*
+	* A system can declare the components it uses with the following members:
+	* - using Components = TypeList<...>: components read and written by the system
+	* - using ReadOnlyComponents = TypeList<...>: components only read by the system
+	* - static constexpr bool AllowConcurrent = false: the system has to run alone on the calling thread
+	* - static constexpr bool RunOnMainThread = true: the system has to run on the calling thread, possibly concurrently with other systems
+	* - static constexpr bool FixedUpdate = true: the system is run at the fixed timestep (see SetFixedTimestep), before other systems
+	*
+	* Systems can take the fixed step informations as a second parameter of their Update method (for example to interpolate between fixed steps).
+	*
+	* Systems which don't declare Components are considered to access every component and are never run concurrently with another system.
+	* Systems creating or destroying entities, or connecting to registry signals during their update, should not declare their components or disable AllowConcurrent.
+	*
+	* \param elapsedTime Time elapsed since last update
+	*/
 	void EnttSystemGraph::Update(Time elapsedTime)
 	{
+		NazaraProfileScope("EnttSystemGraph::Update");
+
 		if (!m_systemOrderUpdated)
 		{
-			m_orderedNodes.clear();
-			m_orderedNodes.reserve(m_nodes.size());
+			m_fixedSchedule.orderedNodes.clear();
+			m_variableSchedule.orderedNodes.clear();
 			for (auto& nodePtr : m_nodes)
-				m_orderedNodes.emplace_back(nodePtr.get());
+			{
+				Schedule& schedule = (nodePtr->fixedUpdate) ? m_fixedSchedule : m_variableSchedule;
+				schedule.orderedNodes.emplace_back(nodePtr.get());
+			}
 
-			std::sort(m_orderedNodes.begin(), m_orderedNodes.end(), [](const NodeBase* a, const NodeBase* b)
+			for (Schedule* schedule : { &m_fixedSchedule, &m_variableSchedule })
 			{
-				return a->executionOrder < b->executionOrder;
-			});
+				std::stable_sort(schedule->orderedNodes.begin(), schedule->orderedNodes.end(), [](const NodeBase* a, const NodeBase* b)
+				{
+					return a->executionOrder < b->executionOrder;
+				});
+
+				BuildSchedule(*schedule);
+			}
 
 			m_systemOrderUpdated = true;
 		}
 
-		for (NodeBase* node : m_orderedNodes)
-			node->Update(elapsedTime);
+		if (m_fixedTimestep > Time::Zero())
+		{
+			m_fixedStepInfo.timestep = m_fixedTimestep;
+			m_fixedStepAccumulator += elapsedTime;
+
+			std::size_t stepCount = 0;
+			while (m_fixedStepAccumulator >= m_fixedTimestep && stepCount < m_maxFixedStepCount)
+			{
+				RunSchedule(m_fixedSchedule, m_fixedTimestep);
+
+				m_fixedStepAccumulator -= m_fixedTimestep;
+				m_fixedStepInfo.stepIndex++;
+				stepCount++;
+			}
+
+			// Fixed systems can't keep up, drop the time we couldn't simulate instead of trying to catch up during next updates
+			if (m_fixedStepAccumulator >= m_fixedTimestep)
+				m_fixedStepAccumulator = Time::Nanoseconds(m_fixedStepAccumulator.AsNanoseconds() % m_fixedTimestep.AsNanoseconds());
+
+			m_fixedStepInfo.alpha = static_cast<float>(m_fixedStepAccumulator.AsSeconds<double>() / m_fixedTimestep.AsSeconds<double>());
+		}
+		else
+		{
+			m_fixedStepInfo.timestep = Time::Zero();
+			m_fixedStepInfo.alpha = 1.f;
+
+			if (!m_fixedSchedule.orderedNodes.empty())
+			{
+				RunSchedule(m_fixedSchedule, elapsedTime);
+				m_fixedStepInfo.stepIndex++;
+			}
+		}
+
+		RunSchedule(m_variableSchedule, elapsedTime);
+	}
+
+	void EnttSystemGraph::BuildSchedule(Schedule& schedule)
+	{
+		schedule.hasConcurrentNodes = false;
+
+		for (std::size_t nodeIndex = 0; nodeIndex < schedule.orderedNodes.size(); ++nodeIndex)
+		{
+			NodeBase* node = schedule.orderedNodes[nodeIndex];
+			node->dependencies.clear();
+
+			bool dependsOnPreviousNode = (nodeIndex == 0);
+			for (std::size_t previousIndex = 0; previousIndex < nodeIndex; ++previousIndex)
+			{
+				if (node->ConflictsWith(*schedule.orderedNodes[previousIndex]))
+				{
+					node->dependencies.push_back(previousIndex);
+					if (previousIndex == nodeIndex - 1)
+						dependsOnPreviousNode = true;
+				}
+			}
+
+			// If every node depends on the previous one, the graph is sequential
+			if (!dependsOnPreviousNode)
+				schedule.hasConcurrentNodes = true;
+		}
+	}
+
+	void EnttSystemGraph::RunSchedule(const Schedule& schedule, Time elapsedTime)
+	{
+		if (m_concurrentUpdateEnabled && schedule.hasConcurrentNodes && Core::Instance())
+			UpdateConcurrently(schedule, elapsedTime);
+		else
+		{
+			for (NodeBase* node : schedule.orderedNodes)
+				UpdateNode(*node, elapsedTime);
+		}
+
+		// Budgets are checked once every system is done, so the signal is always triggered on the calling thread
+		if (m_timingStatsEnabled)
+		{
+			for (NodeBase* node : schedule.orderedNodes)
+			{
+				if (node->timingStats.IsOverBudget())
+					OnTimingBudgetExceeded(this, node->name, node->timingStats);
+			}
+		}
+	}
+
+	void EnttSystemGraph::UpdateConcurrently(const Schedule& schedule, Time elapsedTime)
+	{
+		TaskScheduler& taskScheduler = Core::Instance()->GetTaskScheduler();
+
+		// Systems running on the calling thread have an invalid task handle once done, which is ignored as a dependency
+		m_nodeTasks.clear();
+		m_nodeTasks.resize(schedule.orderedNodes.size());
+
+		for (std::size_t nodeIndex = 0; nodeIndex < schedule.orderedNodes.size(); ++nodeIndex)
+		{
+			NodeBase* node = schedule.orderedNodes[nodeIndex];
+
+			if (!node->allowConcurrent)
+			{
+				for (std::size_t previousIndex = 0; previousIndex < nodeIndex; ++previousIndex)
+				{
+					if (m_nodeTasks[previousIndex].IsValid())
+						taskScheduler.WaitFor(m_nodeTasks[previousIndex]);
+				}
+
+				UpdateNode(*node, elapsedTime);
+				continue;
+			}
+
+			if (node->runOnMainThread)
+			{
+				for (std::size_t dependencyIndex : node->dependencies)
+				{
+					if (m_nodeTasks[dependencyIndex].IsValid())
+						taskScheduler.WaitFor(m_nodeTasks[dependencyIndex]);
+				}
+
+				UpdateNode(*node, elapsedTime);
+				continue;
+			}
+
+			m_dependencyHandles.clear();
+			for (std::size_t dependencyIndex : node->dependencies)
+				m_dependencyHandles.push_back(m_nodeTasks[dependencyIndex]);
+
+			m_nodeTasks[nodeIndex] = taskScheduler.AddTask([this, node, elapsedTime]
+			{
+				UpdateNode(*node, elapsedTime);
+			}, m_dependencyHandles.data(), m_dependencyHandles.size());
+		}
+
+		for (const TaskScheduler::TaskHandle& taskHandle : m_nodeTasks)
+		{
+			if (taskHandle.IsValid())
+				taskScheduler.WaitFor(taskHandle);
+		}
+	}
+
+	void EnttSystemGraph::UpdateNode(NodeBase& node, Time elapsedTime)
+	{
+		if (!m_timingStatsEnabled)
+		{
+			node.Update(elapsedTime, m_fixedStepInfo);
+			return;
+		}
+
+		Time updateBeginTime = GetElapsedNanoseconds();
+		node.Update(elapsedTime, m_fixedStepInfo);
+		node.timingStats.AddSample(GetElapsedNanoseconds() - updateBeginTime);
 	}
 }
@@ -7,6 +7,15 @@
 
 namespace Nz
 {
+	/*!
+	* \brief Checks whether the world has to be updated on the main thread
+	* \return True if the world was flagged as main thread only or if one of its systems declares RunOnMainThread
+	*/
+	bool EnttWorld::IsMainThreadOnly() const
+	{
+		return EntityWorld::IsMainThreadOnly() || m_systemGraph.HasMainThreadSystems();
+	}
+
 	void EnttWorld::Update(Time elapsedTime)
 	{
 		m_systemGraph.Update(elapsedTime);
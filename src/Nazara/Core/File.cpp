@@ -226,6 +226,30 @@ namespace Nz
 		return Open(openMode);
 	}
 
+	/*!
+	* \brief Reads data at a given offset, without using the stream cursor
+	* \return Number of bytes read, less than size if the end of the file was reached
+	*
+	* Multiple threads can read from the same file using this function, as long as the file isn't closed or written to meanwhile.
+	* As it bypasses the stream, text mode isn't handled.
+	*
+	* \remark The cursor position is unspecified afterwards on some platforms (Windows updates it), don't mix it with cursor-based reads from other threads
+	*
+	* \param offset Offset of the first byte to read, from the beginning of the file
+	* \param buffer Buffer receiving the data, of at least size bytes
+	* \param size Number of bytes to read
+	*/
+	std::size_t File::ReadAt(UInt64 offset, void* buffer, std::size_t size) const
+	{
+		NazaraAssert(IsOpen(), "File is not open");
+		NazaraAssert(buffer || size == 0, "invalid buffer");
+
+		if (size == 0)
+			return 0;
+
+		return m_impl->ReadAt(offset, buffer, size);
+	}
+
 	/*!
 	* \brief Sets the file path
 	* \return true if file opening is successful
@@ -8,7 +8,6 @@
 #include <array>
 #include <ctime>
 #include <filesystem>
-#include <sstream>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -118,21 +117,18 @@ namespace Nz
 			}
 		}
 
-		// Apply some processing before writing
-		std::ostringstream stream;
 		if (m_timeLoggingEnabled)
 		{
 			std::array<char, 24> buffer;
 
 			time_t currentTime = std::time(nullptr);
-			std::strftime(buffer.data(), 24, "%d/%m/%Y - %H:%M:%S: ", std::localtime(&currentTime));
+			std::size_t length = std::strftime(buffer.data(), buffer.size(), "%d/%m/%Y - %H:%M:%S: ", std::localtime(&currentTime));
 
-			stream << buffer.data();
+			m_outputFile.write(buffer.data(), length);
 		}
 
-		stream << string << '\n';
-
-		m_outputFile << stream.str();
+		m_outputFile.write(string.data(), string.size());
+		m_outputFile.put('\n');
 	}
 
 	/*!
@@ -3,16 +3,101 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Core/HandledObject.hpp>
+#include <memory>
+#include <mutex>
+#include <vector>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
 {
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		struct HandleSlotAllocator
+		{
+			std::mutex mutex;
+			std::vector<UInt32> freeSlots;
+			std::vector<std::unique_ptr<Detail::HandleSlot[]>> chunks;
+			UInt32 nextSlot = 0;
+		};
+
+		HandleSlotAllocator& GetAllocator()
+		{
+			// Never destroyed, as handled objects with static storage may be destroyed after it
+			static HandleSlotAllocator& allocator = *new HandleSlotAllocator;
+			return allocator;
+		}
+	}
+
 	namespace Detail
 	{
-		std::shared_ptr<HandleData> HandleData::GetEmptyObject()
+		/*!
+		* \brief Allocates a slot for a handled object
+		* \return Slot index, or InvalidSlot if every slot is in use
+		*
+		* Slots are never released to the system, their memory stays valid so handles can always check their generation.
+		*
+		* \param object Object to store in the slot
+		*/
+		UInt32 HandleSlotTable::Allocate(void* object)
 		{
-			static std::shared_ptr<HandleData> emptyHandleData = std::make_shared<HandleData>(HandleData{});
-			return emptyHandleData;
+			NAZARA_USE_ANONYMOUS_NAMESPACE
+
+			HandleSlotAllocator& allocator = GetAllocator();
+			std::lock_guard lock(allocator.mutex);
+
+			UInt32 slotIndex;
+			if (!allocator.freeSlots.empty())
+			{
+				slotIndex = allocator.freeSlots.back();
+				allocator.freeSlots.pop_back();
+			}
+			else
+			{
+				if (allocator.nextSlot == ChunkSize * MaxChunkCount)
+				{
+					NazaraError("handle slot table is full ({0} handled objects)", ChunkSize * MaxChunkCount);
+					return InvalidSlot;
+				}
+
+				slotIndex = allocator.nextSlot++;
+
+				UInt32 chunkIndex = slotIndex / ChunkSize;
+				if (!s_chunks[chunkIndex])
+				{
+					std::unique_ptr<HandleSlot[]> chunk = std::make_unique<HandleSlot[]>(ChunkSize);
+					for (UInt32 i = 0; i < ChunkSize; ++i)
+						chunk[i] = HandleSlot{ nullptr, 0 };
+
+					s_chunks[chunkIndex] = chunk.get();
+					allocator.chunks.push_back(std::move(chunk));
+				}
+			}
+
+			GetSlot(slotIndex).object = object;
+
+			return slotIndex;
+		}
+
+		/*!
+		* \brief Frees a slot, invalidating the handles referencing it
+		*
+		* \param slotIndex Index of the slot to free
+		*/
+		void HandleSlotTable::Free(UInt32 slotIndex)
+		{
+			NAZARA_USE_ANONYMOUS_NAMESPACE
+
+			HandleSlotAllocator& allocator = GetAllocator();
+			std::lock_guard lock(allocator.mutex);
+
+			HandleSlot& slot = GetSlot(slotIndex);
+			slot.object = nullptr;
+
+			// Retire slots whose generation would wrap around, as stale handles could become valid again
+			if (++slot.generation != std::numeric_limits<UInt32>::max())
+				allocator.freeSlots.push_back(slotIndex);
 		}
+
+		HandleSlot* HandleSlotTable::s_chunks[MaxChunkCount] = {};
 	}
 }
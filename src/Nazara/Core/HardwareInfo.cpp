@@ -156,23 +156,33 @@ namespace Nz
 		else
 			m_cpuVendor = ProcessorVendor::Unknown;
 
-		if (eax >= 1)
+		UInt32 maxSupportedFunction = eax;
+		if (maxSupportedFunction >= 1)
 		{
 			// Retrieval of certain capacities of the processor (ECX and EDX, function 1)
 			HardwareInfoImpl::Cpuid(1, 0, registers.data());
 
-			m_cpuCapabilities[ProcessorCap::AES]    = (ecx & (1U << 25)) != 0;
-			m_cpuCapabilities[ProcessorCap::AVX]    = (ecx & (1U << 28)) != 0;
-			m_cpuCapabilities[ProcessorCap::FMA3]   = (ecx & (1U << 12)) != 0;
-			m_cpuCapabilities[ProcessorCap::MMX]    = (edx & (1U << 23)) != 0;
-			m_cpuCapabilities[ProcessorCap::Popcnt] = (ecx & (1U << 23)) != 0;
-			m_cpuCapabilities[ProcessorCap::RDRAND] = (ecx & (1U << 30)) != 0;
-			m_cpuCapabilities[ProcessorCap::SSE]    = (edx & (1U << 25)) != 0;
-			m_cpuCapabilities[ProcessorCap::SSE2]   = (edx & (1U << 26)) != 0;
-			m_cpuCapabilities[ProcessorCap::SSE3]   = (ecx & (1U << 0)) != 0;
-			m_cpuCapabilities[ProcessorCap::SSSE3]  = (ecx & (1U << 9)) != 0;
-			m_cpuCapabilities[ProcessorCap::SSE41]  = (ecx & (1U << 19)) != 0;
-			m_cpuCapabilities[ProcessorCap::SSE42]  = (ecx & (1U << 20)) != 0;
+			m_cpuCapabilities[ProcessorCap::AES]       = (ecx & (1U << 25)) != 0;
+			m_cpuCapabilities[ProcessorCap::AVX]       = (ecx & (1U << 28)) != 0;
+			m_cpuCapabilities[ProcessorCap::FMA3]      = (ecx & (1U << 12)) != 0;
+			m_cpuCapabilities[ProcessorCap::MMX]       = (edx & (1U << 23)) != 0;
+			m_cpuCapabilities[ProcessorCap::PCLMULQDQ] = (ecx & (1U << 1)) != 0;
+			m_cpuCapabilities[ProcessorCap::Popcnt]    = (ecx & (1U << 23)) != 0;
+			m_cpuCapabilities[ProcessorCap::RDRAND]    = (ecx & (1U << 30)) != 0;
+			m_cpuCapabilities[ProcessorCap::SSE]       = (edx & (1U << 25)) != 0;
+			m_cpuCapabilities[ProcessorCap::SSE2]      = (edx & (1U << 26)) != 0;
+			m_cpuCapabilities[ProcessorCap::SSE3]      = (ecx & (1U << 0)) != 0;
+			m_cpuCapabilities[ProcessorCap::SSSE3]     = (ecx & (1U << 9)) != 0;
+			m_cpuCapabilities[ProcessorCap::SSE41]     = (ecx & (1U << 19)) != 0;
+			m_cpuCapabilities[ProcessorCap::SSE42]     = (ecx & (1U << 20)) != 0;
+		}
+
+		if (maxSupportedFunction >= 7)
+		{
+			// Retrieval of structured extended features (EBX, function 7 subfunction 0)
+			HardwareInfoImpl::Cpuid(7, 0, registers.data());
+
+			m_cpuCapabilities[ProcessorCap::SHA] = (ebx & (1U << 29)) != 0;
 		}
 
 		// Retrieval of biggest extended function handled (EAX, function 0x80000000)
@@ -3,7 +3,28 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Core/Hash/CRC32.hpp>
+#include <Nazara/Core/Core.hpp>
+#include <Nazara/Core/HardwareInfo.hpp>
 #include <NazaraUtils/Endianness.hpp>
+
+#if defined(NAZARA_ARCH_x86) || defined(NAZARA_ARCH_x86_64)
+#include <emmintrin.h>
+#include <smmintrin.h>
+#include <wmmintrin.h>
+#define NAZARA_CORE_CRC32_CLMUL
+
+// The SSE4.2 crc32 instruction computes CRC-32C (Castagnoli), the standard polynomial is computed by folding with carry-less multiplications
+#if defined(NAZARA_COMPILER_CLANG) || defined(NAZARA_COMPILER_GCC)
+#define NAZARA_CORE_CLMUL_TARGET __attribute__((target("pclmul,sse4.1")))
+#else
+#define NAZARA_CORE_CLMUL_TARGET
+#endif
+#elif defined(__ARM_FEATURE_CRC32) && defined(NAZARA_LITTLE_ENDIAN)
+#include <arm_acle.h>
+#include <cstring>
+#define NAZARA_CORE_CRC32_ARM
+#endif
+
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -59,6 +80,83 @@ namespace Nz
 			0xBDBDF21C, 0xCABAC28A, 0x53B39330, 0x24B4A3A6, 0xBAD03605, 0xCDD70693, 0x54DE5729, 0x23D967BF,
 			0xB3667A2E, 0xC4614AB8, 0x5D681B02, 0x2A6F2B94, 0xB40BBE37, 0xC30C8EA1, 0x5A05DF1B, 0x2D02EF8D
 		};
+
+#ifdef NAZARA_CORE_CRC32_CLMUL
+		NAZARA_CORE_CLMUL_TARGET inline __m128i crc32_fold(__m128i value, __m128i constants, __m128i next)
+		{
+			__m128i low = _mm_clmulepi64_si128(value, constants, 0x00);
+			__m128i high = _mm_clmulepi64_si128(value, constants, 0x11);
+			return _mm_xor_si128(_mm_xor_si128(high, low), next);
+		}
+
+		// Folds blocks of 16 bytes (len must be a multiple of 16 and at least 64) into the running crc, see "Fast CRC Computation Using PCLMULQDQ Instruction" (Intel)
+		NAZARA_CORE_CLMUL_TARGET UInt32 crc32_clmul(const UInt8* data, std::size_t len, UInt32 crc)
+		{
+			alignas(16) static const UInt64 k1k2[] = { 0x0154442BD4, 0x01C6E41596 };
+			alignas(16) static const UInt64 k3k4[] = { 0x01751997D0, 0x00CCAA009E };
+			alignas(16) static const UInt64 k5k0[] = { 0x0163CD6124, 0x0000000000 };
+			alignas(16) static const UInt64 poly[] = { 0x01DB710641, 0x01F7011641 };
+
+			const __m128i* ptr = reinterpret_cast<const __m128i*>(data);
+
+			__m128i x1 = _mm_xor_si128(_mm_loadu_si128(ptr + 0), _mm_cvtsi32_si128(static_cast<int>(crc)));
+			__m128i x2 = _mm_loadu_si128(ptr + 1);
+			__m128i x3 = _mm_loadu_si128(ptr + 2);
+			__m128i x4 = _mm_loadu_si128(ptr + 3);
+			ptr += 4;
+			len -= 64;
+
+			// Fold 64 bytes at once
+			__m128i constants = _mm_load_si128(reinterpret_cast<const __m128i*>(k1k2));
+			for (; len >= 64; ptr += 4, len -= 64)
+			{
+				x1 = crc32_fold(x1, constants, _mm_loadu_si128(ptr + 0));
+				x2 = crc32_fold(x2, constants, _mm_loadu_si128(ptr + 1));
+				x3 = crc32_fold(x3, constants, _mm_loadu_si128(ptr + 2));
+				x4 = crc32_fold(x4, constants, _mm_loadu_si128(ptr + 3));
+			}
+
+			// Fold into 128 bits
+			constants = _mm_load_si128(reinterpret_cast<const __m128i*>(k3k4));
+			x1 = crc32_fold(x1, constants, x2);
+			x1 = crc32_fold(x1, constants, x3);
+			x1 = crc32_fold(x1, constants, x4);
+
+			for (; len >= 16; ++ptr, len -= 16)
+				x1 = crc32_fold(x1, constants, _mm_loadu_si128(ptr));
+
+			// Fold 128 bits to 64 bits
+			__m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+			x2 = _mm_clmulepi64_si128(x1, constants, 0x10);
+			x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+			constants = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+			x2 = _mm_srli_si128(x1, 4);
+			x1 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), constants, 0x00);
+			x1 = _mm_xor_si128(x1, x2);
+
+			// Barrett reduction to 32 bits
+			constants = _mm_load_si128(reinterpret_cast<const __m128i*>(poly));
+			x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), constants, 0x10);
+			x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask), constants, 0x00);
+			x1 = _mm_xor_si128(x1, x2);
+
+			return static_cast<UInt32>(_mm_extract_epi32(x1, 1));
+		}
+
+		bool crc32_hasClmul()
+		{
+			auto CheckCapabilities = [](const HardwareInfo& hardwareInfo)
+			{
+				return hardwareInfo.HasCapability(ProcessorCap::PCLMULQDQ) && hardwareInfo.HasCapability(ProcessorCap::SSE41);
+			};
+
+			if (Core* core = Core::Instance())
+				return CheckCapabilities(core->GetHardwareInfo());
+			else
+				return CheckCapabilities(HardwareInfo{});
+		}
+#endif
 	}
 
 	CRC32Hasher::CRC32Hasher(UInt32 polynomial)
@@ -94,6 +192,30 @@ namespace Nz
 
 	void CRC32Hasher::Append(const UInt8* data, std::size_t len)
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		// Hardware paths only handle the default polynomial
+		if (m_table == crc32_table)
+		{
+#if defined(NAZARA_CORE_CRC32_CLMUL)
+			static bool hasClmul = crc32_hasClmul();
+			if (hasClmul && len >= 64)
+			{
+				std::size_t blockLen = len & ~std::size_t(15);
+				m_crc = crc32_clmul(data, blockLen, m_crc);
+				data += blockLen;
+				len -= blockLen;
+			}
+#elif defined(NAZARA_CORE_CRC32_ARM)
+			for (; len >= 8; data += 8, len -= 8)
+			{
+				UInt64 value;
+				std::memcpy(&value, data, sizeof(value));
+				m_crc = __crc32d(m_crc, value);
+			}
+#endif
+		}
+
 		while (len--)
 			m_crc = m_table[(m_crc ^ *data++) & 0xFF] ^ (m_crc >> 8);
 	}
@@ -38,8 +38,26 @@
  */
 
 #include <Nazara/Core/Hash/SHA/Internal.hpp>
+#include <Nazara/Core/Core.hpp>
+#include <Nazara/Core/HardwareInfo.hpp>
 #include <NazaraUtils/Endianness.hpp>
 #include <cstring>
+
+#if defined(NAZARA_ARCH_x86) || defined(NAZARA_ARCH_x86_64)
+#include <emmintrin.h>
+#include <immintrin.h>
+#include <smmintrin.h>
+#include <tmmintrin.h>
+#define NAZARA_CORE_SHA_NI
+
+// SHA extensions kernels are only called after checking the CPU supports them
+#if defined(NAZARA_COMPILER_CLANG) || defined(NAZARA_COMPILER_GCC)
+#define NAZARA_CORE_SHA_NI_TARGET __attribute__((target("sha,sse4.1")))
+#else
+#define NAZARA_CORE_SHA_NI_TARGET
+#endif
+#endif
+
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -321,7 +339,26 @@ namespace Nz
 
 	namespace
 	{
-		void SHA1_Internal_Transform(SHA_CTX* context, const UInt32* data)
+		using SHA_TransformFunc = void(*)(SHA_CTX*, const UInt32*);
+
+		bool SHA_HasHardwareSupport()
+		{
+	#ifdef NAZARA_CORE_SHA_NI
+			auto CheckCapabilities = [](const HardwareInfo& hardwareInfo)
+			{
+				return hardwareInfo.HasCapability(ProcessorCap::SHA) && hardwareInfo.HasCapability(ProcessorCap::SSE41);
+			};
+
+			if (Core* core = Core::Instance())
+				return CheckCapabilities(core->GetHardwareInfo());
+			else
+				return CheckCapabilities(HardwareInfo{});
+	#else
+			return false;
+	#endif
+		}
+
+		void SHA1_Internal_TransformSoftware(SHA_CTX* context, const UInt32* data)
 		{
 			UInt32 a, b, c, d, e;
 			UInt32 T1, *W1;
@@ -435,6 +472,69 @@ namespace Nz
 			context->s1.state[3] += d;
 			context->s1.state[4] += e;
 		}
+
+	#ifdef NAZARA_CORE_SHA_NI
+		NAZARA_CORE_SHA_NI_TARGET void SHA1_Internal_TransformSHANI(SHA_CTX* context, const UInt32* data)
+		{
+			const __m128i byteSwapMask = _mm_set_epi64x(0x0001020304050607ULL, 0x08090A0B0C0D0E0FULL);
+
+			UInt32* state = context->s1.state;
+			const __m128i* block = reinterpret_cast<const __m128i*>(data);
+
+			__m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0x1B);
+			__m128i e0 = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+
+			__m128i abcdSave = abcd;
+			__m128i e0Save = e0;
+
+			/* Four rounds per iteration, the message schedule is kept in a four vectors ring */
+			__m128i msg[4];
+			__m128i e;
+			__m128i abcdPrev;
+			for (unsigned int i = 0; i < 20; ++i)
+			{
+				__m128i& w = msg[i % 4];
+				if (i < 4)
+					w = _mm_shuffle_epi8(_mm_loadu_si128(block + i), byteSwapMask);
+				else
+					w = _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(w, msg[(i + 1) % 4]), msg[(i + 2) % 4]), msg[(i + 3) % 4]);
+
+				e = (i == 0) ? _mm_add_epi32(e0, w) : _mm_sha1nexte_epu32(abcdPrev, w);
+				abcdPrev = abcd;
+
+				/* The round function selector has to be an immediate */
+				switch (i / 5)
+				{
+					case 0: abcd = _mm_sha1rnds4_epu32(abcd, e, 0); break;
+					case 1: abcd = _mm_sha1rnds4_epu32(abcd, e, 1); break;
+					case 2: abcd = _mm_sha1rnds4_epu32(abcd, e, 2); break;
+					default: abcd = _mm_sha1rnds4_epu32(abcd, e, 3); break;
+				}
+			}
+
+			e0 = _mm_sha1nexte_epu32(abcdPrev, e0Save);
+			abcd = _mm_add_epi32(abcd, abcdSave);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(abcd, 0x1B));
+			state[4] = static_cast<UInt32>(_mm_extract_epi32(e0, 3));
+		}
+	#endif
+
+		SHA_TransformFunc SHA1_Internal_SelectTransform()
+		{
+	#ifdef NAZARA_CORE_SHA_NI
+			if (SHA_HasHardwareSupport())
+				return &SHA1_Internal_TransformSHANI;
+	#endif
+
+			return &SHA1_Internal_TransformSoftware;
+		}
+
+		void SHA1_Internal_Transform(SHA_CTX* context, const UInt32* data)
+		{
+			static SHA_TransformFunc transform = SHA1_Internal_SelectTransform();
+			transform(context, data);
+		}
 	}
 
 	void SHA1_Update(SHA_CTX* context, const UInt8* data, std::size_t len)
@@ -589,64 +689,132 @@ namespace Nz
 		(h) = T1 + Sigma0_256(a) + Maj((a), (b), (c)); \
 		j++
 
-	void SHA256_Internal_Transform(SHA_CTX* context, const UInt32* data)
+	namespace
 	{
-		UInt32 a, b, c, d, e, f, g, h;
-		UInt32 T1, *W256;
-		int	j;
+		void SHA256_Internal_TransformSoftware(SHA_CTX* context, const UInt32* data)
+		{
+			UInt32 a, b, c, d, e, f, g, h;
+			UInt32 T1, *W256;
+			int	j;
 
-		W256 = reinterpret_cast<UInt32*>(context->s256.buffer);
+			W256 = reinterpret_cast<UInt32*>(context->s256.buffer);
 
-		/* Initialize registers with the prev. intermediate value */
-		a = context->s256.state[0];
-		b = context->s256.state[1];
-		c = context->s256.state[2];
-		d = context->s256.state[3];
-		e = context->s256.state[4];
-		f = context->s256.state[5];
-		g = context->s256.state[6];
-		h = context->s256.state[7];
+			/* Initialize registers with the prev. intermediate value */
+			a = context->s256.state[0];
+			b = context->s256.state[1];
+			c = context->s256.state[2];
+			d = context->s256.state[3];
+			e = context->s256.state[4];
+			f = context->s256.state[5];
+			g = context->s256.state[6];
+			h = context->s256.state[7];
 
-		j = 0;
-		do
+			j = 0;
+			do
+			{
+				/* Rounds 0 to 15 (unrolled): */
+				ROUND256_0_TO_15(a,b,c,d,e,f,g,h);
+				ROUND256_0_TO_15(h,a,b,c,d,e,f,g);
+				ROUND256_0_TO_15(g,h,a,b,c,d,e,f);
+				ROUND256_0_TO_15(f,g,h,a,b,c,d,e);
+				ROUND256_0_TO_15(e,f,g,h,a,b,c,d);
+				ROUND256_0_TO_15(d,e,f,g,h,a,b,c);
+				ROUND256_0_TO_15(c,d,e,f,g,h,a,b);
+				ROUND256_0_TO_15(b,c,d,e,f,g,h,a);
+			}
+			while (j < 16);
+
+			/* Now for the remaining rounds to 64: */
+			do
+			{
+				UInt32 s0, s1;
+
+				ROUND256(a,b,c,d,e,f,g,h);
+				ROUND256(h,a,b,c,d,e,f,g);
+				ROUND256(g,h,a,b,c,d,e,f);
+				ROUND256(f,g,h,a,b,c,d,e);
+				ROUND256(e,f,g,h,a,b,c,d);
+				ROUND256(d,e,f,g,h,a,b,c);
+				ROUND256(c,d,e,f,g,h,a,b);
+				ROUND256(b,c,d,e,f,g,h,a);
+			}
+			while (j < 64);
+
+			/* Compute the current intermediate hash value */
+			context->s256.state[0] += a;
+			context->s256.state[1] += b;
+			context->s256.state[2] += c;
+			context->s256.state[3] += d;
+			context->s256.state[4] += e;
+			context->s256.state[5] += f;
+			context->s256.state[6] += g;
+			context->s256.state[7] += h;
+		}
+
+	#ifdef NAZARA_CORE_SHA_NI
+		NAZARA_CORE_SHA_NI_TARGET void SHA256_Internal_TransformSHANI(SHA_CTX* context, const UInt32* data)
 		{
-			/* Rounds 0 to 15 (unrolled): */
-			ROUND256_0_TO_15(a,b,c,d,e,f,g,h);
-			ROUND256_0_TO_15(h,a,b,c,d,e,f,g);
-			ROUND256_0_TO_15(g,h,a,b,c,d,e,f);
-			ROUND256_0_TO_15(f,g,h,a,b,c,d,e);
-			ROUND256_0_TO_15(e,f,g,h,a,b,c,d);
-			ROUND256_0_TO_15(d,e,f,g,h,a,b,c);
-			ROUND256_0_TO_15(c,d,e,f,g,h,a,b);
-			ROUND256_0_TO_15(b,c,d,e,f,g,h,a);
+			const __m128i byteSwapMask = _mm_set_epi64x(0x0C0D0E0F08090A0BULL, 0x0405060700010203ULL);
+
+			UInt32* state = context->s256.state;
+			const __m128i* block = reinterpret_cast<const __m128i*>(data);
+
+			/* sha256rnds2 works on the ABEF and CDGH halves of the state */
+			__m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0])), 0xB1); // CDAB
+			__m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4])), 0x1B); // EFGH
+			__m128i state0 = _mm_alignr_epi8(tmp, state1, 8); // ABEF
+			state1 = _mm_blend_epi16(state1, tmp, 0xF0); // CDGH
+
+			__m128i abefSave = state0;
+			__m128i cdghSave = state1;
+
+			/* Four rounds per iteration, the message schedule is kept in a four vectors ring */
+			__m128i msg[4];
+			for (unsigned int i = 0; i < 16; ++i)
+			{
+				__m128i& w = msg[i % 4];
+				if (i < 4)
+					w = _mm_shuffle_epi8(_mm_loadu_si128(block + i), byteSwapMask);
+				else
+				{
+					const __m128i& previous = msg[(i + 3) % 4];
+					w = _mm_add_epi32(_mm_sha256msg1_epu32(w, msg[(i + 1) % 4]), _mm_alignr_epi8(previous, msg[(i + 2) % 4], 4));
+					w = _mm_sha256msg2_epu32(w, previous);
+				}
+
+				__m128i wk = _mm_add_epi32(w, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&K256[i * 4])));
+				state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+				state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(wk, 0x0E));
+			}
+
+			state0 = _mm_add_epi32(state0, abefSave);
+			state1 = _mm_add_epi32(state1, cdghSave);
+
+			tmp = _mm_shuffle_epi32(state0, 0x1B); // FEBA
+			state1 = _mm_shuffle_epi32(state1, 0xB1); // DCHG
+			state0 = _mm_blend_epi16(tmp, state1, 0xF0); // DCBA
+			state1 = _mm_alignr_epi8(state1, tmp, 8); // HGFE
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
 		}
-		while (j < 16);
+	#endif
 
-		/* Now for the remaining rounds to 64: */
-		do
+		SHA_TransformFunc SHA256_Internal_SelectTransform()
 		{
-			UInt32 s0, s1;
-
-			ROUND256(a,b,c,d,e,f,g,h);
-			ROUND256(h,a,b,c,d,e,f,g);
-			ROUND256(g,h,a,b,c,d,e,f);
-			ROUND256(f,g,h,a,b,c,d,e);
-			ROUND256(e,f,g,h,a,b,c,d);
-			ROUND256(d,e,f,g,h,a,b,c);
-			ROUND256(c,d,e,f,g,h,a,b);
-			ROUND256(b,c,d,e,f,g,h,a);
+	#ifdef NAZARA_CORE_SHA_NI
+			if (SHA_HasHardwareSupport())
+				return &SHA256_Internal_TransformSHANI;
+	#endif
+
+			return &SHA256_Internal_TransformSoftware;
 		}
-		while (j < 64);
+	}
 
-		/* Compute the current intermediate hash value */
-		context->s256.state[0] += a;
-		context->s256.state[1] += b;
-		context->s256.state[2] += c;
-		context->s256.state[3] += d;
-		context->s256.state[4] += e;
-		context->s256.state[5] += f;
-		context->s256.state[6] += g;
-		context->s256.state[7] += h;
+	void SHA256_Internal_Transform(SHA_CTX* context, const UInt32* data)
+	{
+		static SHA_TransformFunc transform = SHA256_Internal_SelectTransform();
+		transform(context, data);
 	}
 
 	void SHA256_Update(SHA_CTX* context, const UInt8 *data, std::size_t len)
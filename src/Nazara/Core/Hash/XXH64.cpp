@@ -0,0 +1,184 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Hash/XXH64.hpp>
+#include <NazaraUtils/Endianness.hpp>
+#include <cstring>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		constexpr UInt64 xxh64_prime1 = 0x9E3779B185EBCA87ULL;
+		constexpr UInt64 xxh64_prime2 = 0xC2B2AE3D27D4EB4FULL;
+		constexpr UInt64 xxh64_prime3 = 0x165667B19E3779F9ULL;
+		constexpr UInt64 xxh64_prime4 = 0x85EBCA77C2B2AE63ULL;
+		constexpr UInt64 xxh64_prime5 = 0x27D4EB2F165667C5ULL;
+
+		inline UInt64 xxh64_rotl(UInt64 value, unsigned int shift)
+		{
+			return (value << shift) | (value >> (64 - shift));
+		}
+
+		// xxHash reads its input as little-endian words
+		inline UInt64 xxh64_read64(const UInt8* data)
+		{
+			UInt64 value;
+			std::memcpy(&value, data, sizeof(value));
+#ifdef NAZARA_BIG_ENDIAN
+			value = ByteSwap(value);
+#endif
+			return value;
+		}
+
+		inline UInt32 xxh64_read32(const UInt8* data)
+		{
+			UInt32 value;
+			std::memcpy(&value, data, sizeof(value));
+#ifdef NAZARA_BIG_ENDIAN
+			value = ByteSwap(value);
+#endif
+			return value;
+		}
+
+		inline UInt64 xxh64_round(UInt64 acc, UInt64 input)
+		{
+			acc += input * xxh64_prime2;
+			acc = xxh64_rotl(acc, 31);
+			acc *= xxh64_prime1;
+			return acc;
+		}
+
+		inline UInt64 xxh64_merge(UInt64 acc, UInt64 value)
+		{
+			acc ^= xxh64_round(0, value);
+			acc = acc * xxh64_prime1 + xxh64_prime4;
+			return acc;
+		}
+
+		inline void xxh64_stripe(std::array<UInt64, 4>& accumulators, const UInt8* data)
+		{
+			accumulators[0] = xxh64_round(accumulators[0], xxh64_read64(data));
+			accumulators[1] = xxh64_round(accumulators[1], xxh64_read64(data + 8));
+			accumulators[2] = xxh64_round(accumulators[2], xxh64_read64(data + 16));
+			accumulators[3] = xxh64_round(accumulators[3], xxh64_read64(data + 24));
+		}
+	}
+
+	/*!
+	* \ingroup core
+	* \class Nz::XXH64Hasher
+	* \brief Core class that computes the 64 bits xxHash (XXH64) of a stream, a fast non-cryptographic hash suited for checksums and cache keys
+	*
+	* \remark The digest is the canonical (big-endian) representation of the hash
+	*/
+
+	XXH64Hasher::XXH64Hasher(UInt64 seed) :
+	m_seed(seed)
+	{
+	}
+
+	void XXH64Hasher::Append(const UInt8* data, std::size_t len)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		m_totalLength += len;
+
+		if (m_bufferSize > 0)
+		{
+			std::size_t copySize = std::min(len, m_buffer.size() - m_bufferSize);
+			std::memcpy(&m_buffer[m_bufferSize], data, copySize);
+			m_bufferSize += copySize;
+			data += copySize;
+			len -= copySize;
+
+			if (m_bufferSize < m_buffer.size())
+				return;
+
+			xxh64_stripe(m_accumulators, m_buffer.data());
+			m_bufferSize = 0;
+		}
+
+		for (; len >= 32; data += 32, len -= 32)
+			xxh64_stripe(m_accumulators, data);
+
+		if (len > 0)
+		{
+			std::memcpy(m_buffer.data(), data, len);
+			m_bufferSize = len;
+		}
+	}
+
+	void XXH64Hasher::Begin()
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		m_accumulators[0] = m_seed + xxh64_prime1 + xxh64_prime2;
+		m_accumulators[1] = m_seed + xxh64_prime2;
+		m_accumulators[2] = m_seed;
+		m_accumulators[3] = m_seed - xxh64_prime1;
+		m_bufferSize = 0;
+		m_totalLength = 0;
+	}
+
+	ByteArray XXH64Hasher::End()
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		UInt64 hash;
+		if (m_totalLength >= 32)
+		{
+			hash = xxh64_rotl(m_accumulators[0], 1) + xxh64_rotl(m_accumulators[1], 7) + xxh64_rotl(m_accumulators[2], 12) + xxh64_rotl(m_accumulators[3], 18);
+			for (UInt64 acc : m_accumulators)
+				hash = xxh64_merge(hash, acc);
+		}
+		else
+			hash = m_seed + xxh64_prime5;
+
+		hash += m_totalLength;
+
+		const UInt8* data = m_buffer.data();
+		std::size_t len = m_bufferSize;
+		for (; len >= 8; data += 8, len -= 8)
+		{
+			hash ^= xxh64_round(0, xxh64_read64(data));
+			hash = xxh64_rotl(hash, 27) * xxh64_prime1 + xxh64_prime4;
+		}
+
+		if (len >= 4)
+		{
+			hash ^= UInt64(xxh64_read32(data)) * xxh64_prime1;
+			hash = xxh64_rotl(hash, 23) * xxh64_prime2 + xxh64_prime3;
+			data += 4;
+			len -= 4;
+		}
+
+		for (; len > 0; ++data, --len)
+		{
+			hash ^= *data * xxh64_prime5;
+			hash = xxh64_rotl(hash, 11) * xxh64_prime1;
+		}
+
+		// Final avalanche
+		hash ^= hash >> 33;
+		hash *= xxh64_prime2;
+		hash ^= hash >> 29;
+		hash *= xxh64_prime3;
+		hash ^= hash >> 32;
+
+		hash = BigEndianToHost(hash);
+		return ByteArray(reinterpret_cast<UInt8*>(&hash), 8);
+	}
+
+	std::size_t XXH64Hasher::GetDigestLength() const
+	{
+		return 8;
+	}
+
+	const char* XXH64Hasher::GetHashName() const
+	{
+		return "XXH64";
+	}
+}
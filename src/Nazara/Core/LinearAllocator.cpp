@@ -0,0 +1,96 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/LinearAllocator.hpp>
+#include <algorithm>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::LinearAllocator
+	* \brief Core class of a bump allocator, for temporaries which are all released at once (typically at the end of a frame)
+	*
+	* Allocations are made by moving a cursor into memory blocks, individual allocations are never freed and destructors are not called.
+	* Reset reclaims all allocations at once; if more than one block was needed, they are merged into one large enough block
+	* so that the same usage pattern is served from a single block without allocating afterward.
+	*
+	* \remark This class is not thread-safe, use one allocator per thread
+	*/
+
+	/*!
+	* \brief Constructs an empty allocator, memory is only allocated on first use
+	*
+	* \param blockSize Minimum size of a memory block
+	*/
+	LinearAllocator::LinearAllocator(std::size_t blockSize) :
+	m_allocatedSize(0),
+	m_blockSize(blockSize),
+	m_currentBlock(0),
+	m_currentOffset(0)
+	{
+		NazaraAssert(blockSize > 0, "block size must be over zero");
+	}
+
+	/*!
+	* \brief Returns the total size of the memory blocks owned by the allocator
+	*/
+	std::size_t LinearAllocator::GetCapacity() const
+	{
+		std::size_t capacity = 0;
+		for (const Block& block : m_blocks)
+			capacity += block.size;
+
+		return capacity;
+	}
+
+	/*!
+	* \brief Reclaims all allocations at once
+	*
+	* Every pointer returned since the last reset becomes invalid. Memory blocks are kept for subsequent allocations.
+	*/
+	void LinearAllocator::Reset()
+	{
+		if (m_blocks.size() > 1)
+		{
+			// More than one block was used, replace them all by a single one
+			Block mergedBlock;
+			mergedBlock.size = GetCapacity();
+			mergedBlock.memory.reset(new UInt8[mergedBlock.size]);
+
+			m_blocks.clear();
+			m_blocks.push_back(std::move(mergedBlock));
+		}
+
+		m_allocatedSize = 0;
+		m_currentBlock = 0;
+		m_currentOffset = 0;
+	}
+
+	void* LinearAllocator::AllocateFromNextBlock(std::size_t size, std::size_t alignment)
+	{
+		// Try remaining blocks first
+		while (m_currentBlock + 1 < m_blocks.size())
+		{
+			m_currentBlock++;
+			m_currentOffset = 0;
+
+			if (void* ptr = AllocateFromCurrentBlock(size, alignment))
+				return ptr;
+		}
+
+		Block& block = m_blocks.emplace_back();
+		block.size = std::max(m_blockSize, size + alignment - 1);
+		block.memory.reset(new UInt8[block.size]);
+
+		m_currentBlock = m_blocks.size() - 1;
+		m_currentOffset = 0;
+
+		void* ptr = AllocateFromCurrentBlock(size, alignment);
+		NazaraAssert(ptr, "new block is too small");
+
+		return ptr;
+	}
+}
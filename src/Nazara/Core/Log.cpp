@@ -81,7 +81,11 @@ namespace Nz
 	void Log::Write(std::string_view string)
 	{
 		if (s_enabled)
+		{
 			s_logger->Write(string);
+			if (s_logger->DispatchesLogSignals())
+				return;
+		}
 
 		OnLogWrite(string);
 	}
@@ -101,7 +105,11 @@ namespace Nz
 	void Log::WriteError(ErrorType type, std::string_view error, unsigned int line, const char* file, const char* function)
 	{
 		if (s_enabled)
+		{
 			s_logger->WriteError(type, error, line, file, function);
+			if (s_logger->DispatchesLogSignals())
+				return;
+		}
 
 		OnLogWriteError(type, error, line, file, function);
 	}
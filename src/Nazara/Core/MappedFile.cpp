@@ -0,0 +1,209 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/MappedFile.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <algorithm>
+#include <cstring>
+
+#if defined(NAZARA_PLATFORM_WINDOWS)
+	#include <Nazara/Core/Win32/MappedFileImpl.hpp>
+#elif defined(NAZARA_PLATFORM_POSIX)
+	#include <Nazara/Core/Posix/MappedFileImpl.hpp>
+#else
+	#error OS not handled
+#endif
+
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::MappedFile
+	* \brief Core class that maps a whole file in memory for read-only access
+	*
+	* A mapped file is a memory-mapped stream: its content can be accessed in place through GetData (or Stream::GetMappedPointer),
+	* which lets loaders parse it without copying it to intermediate buffers. Pages are loaded by the system when first accessed,
+	* the access pattern tunes its read-ahead and Prefetch can be used to start loading a range ahead of time.
+	*
+	* \remark Modifying or truncating the file while it is mapped has undefined behavior
+	*/
+
+	MappedFile::MappedFile() :
+	Stream(StreamOption::MemoryMapped, OpenMode::NotOpen),
+	m_pos(0)
+	{
+	}
+
+	/*!
+	* \brief Constructs a MappedFile object and maps a file
+	*
+	* \param filePath Path to the file
+	* \param accessPattern Expected access pattern
+	*
+	* \see Open
+	*/
+	MappedFile::MappedFile(const std::filesystem::path& filePath, FileAccessPattern accessPattern) :
+	MappedFile()
+	{
+		Open(filePath, accessPattern);
+	}
+
+	MappedFile::MappedFile(MappedFile&& file) noexcept = default;
+
+	MappedFile::~MappedFile() = default;
+
+	/*!
+	* \brief Unmaps the file
+	*/
+	void MappedFile::Close()
+	{
+		if (m_impl)
+		{
+			m_impl.reset();
+
+			m_openMode = OpenMode::NotOpen;
+			m_pos = 0;
+		}
+	}
+
+	/*!
+	* \brief Gets a pointer to the file content
+	* \return Pointer to the first byte of the file, or nullptr if the file is not open or empty
+	*/
+	const void* MappedFile::GetData() const
+	{
+		return (m_impl) ? m_impl->GetPointer() : nullptr;
+	}
+
+	std::filesystem::path MappedFile::GetDirectory() const
+	{
+		return m_filePath.parent_path();
+	}
+
+	std::filesystem::path MappedFile::GetPath() const
+	{
+		return m_filePath;
+	}
+
+	UInt64 MappedFile::GetSize() const
+	{
+		return (m_impl) ? m_impl->GetSize() : 0;
+	}
+
+	bool MappedFile::IsOpen() const
+	{
+		return m_impl != nullptr;
+	}
+
+	/*!
+	* \brief Maps a file in memory
+	* \return true if the file was successfully mapped
+	*
+	* \param filePath Path to the file
+	* \param accessPattern Expected access pattern, used as a hint for the system read-ahead
+	*
+	* \remark An empty file can be opened but has no data pointer
+	*/
+	bool MappedFile::Open(const std::filesystem::path& filePath, FileAccessPattern accessPattern)
+	{
+		Close();
+
+		std::unique_ptr<MappedFileImpl> impl = std::make_unique<MappedFileImpl>();
+		if (!impl->Open(filePath, accessPattern))
+		{
+			NazaraError("failed to map file {0}: {1}", filePath, Error::GetLastSystemError());
+			return false;
+		}
+
+		m_filePath = std::filesystem::absolute(filePath);
+		m_impl = std::move(impl);
+		m_openMode = OpenMode::ReadOnly;
+		m_pos = 0;
+
+		return true;
+	}
+
+	/*!
+	* \brief Asks the system to start loading a range of the file
+	*
+	* \param offset Offset of the first byte to prefetch
+	* \param size Number of bytes to prefetch, clamped to the file size
+	*/
+	void MappedFile::Prefetch(UInt64 offset, UInt64 size)
+	{
+		NazaraAssert(IsOpen(), "file is not open");
+
+		UInt64 fileSize = m_impl->GetSize();
+		if (offset >= fileSize)
+			return;
+
+		m_impl->Prefetch(offset, std::min(size, fileSize - offset));
+	}
+
+	/*!
+	* \brief Changes the expected access pattern of the file
+	*
+	* \param accessPattern New access pattern
+	*
+	* \remark On Windows, the access pattern can only be specified when opening the file and this is a no-op
+	*/
+	void MappedFile::SetAccessPattern(FileAccessPattern accessPattern)
+	{
+		NazaraAssert(IsOpen(), "file is not open");
+
+		m_impl->SetAccessPattern(accessPattern);
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& file) noexcept = default;
+
+	void MappedFile::FlushStream()
+	{
+		// Nothing to do
+	}
+
+	void* MappedFile::GetMemoryMappedPointer() const
+	{
+		return const_cast<void*>(GetData()); //< stream is read-only
+	}
+
+	std::size_t MappedFile::ReadBlock(void* buffer, std::size_t size)
+	{
+		NazaraAssert(IsOpen(), "file is not open");
+
+		UInt64 fileSize = m_impl->GetSize();
+		std::size_t readSize = static_cast<std::size_t>(std::min<UInt64>(size, fileSize - m_pos));
+
+		if (buffer && readSize > 0)
+			std::memcpy(buffer, static_cast<const UInt8*>(m_impl->GetPointer()) + m_pos, readSize);
+
+		m_pos += readSize;
+		return readSize;
+	}
+
+	bool MappedFile::SeekStreamCursor(UInt64 offset)
+	{
+		NazaraAssert(IsOpen(), "file is not open");
+
+		m_pos = std::min(offset, m_impl->GetSize());
+		return true;
+	}
+
+	UInt64 MappedFile::TellStreamCursor() const
+	{
+		return m_pos;
+	}
+
+	bool MappedFile::TestStreamEnd() const
+	{
+		return m_pos >= GetSize();
+	}
+
+	std::size_t MappedFile::WriteBlock(const void* /*buffer*/, std::size_t /*size*/)
+	{
+		NazaraError("mapped files are read-only");
+		return 0;
+	}
+}
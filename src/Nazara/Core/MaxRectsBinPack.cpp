@@ -0,0 +1,448 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+// Based on the public domain work of Jukka Jylänki
+// http://clb.demon.fi/projects/even-more-rectangle-bin-packing
+
+#include <Nazara/Core/MaxRectsBinPack.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <NazaraUtils/StackVector.hpp>
+#include <algorithm>
+#include <limits>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		bool IsContainedIn(const Rectui& rect, const Rectui& container)
+		{
+			return rect.x >= container.x && rect.y >= container.y &&
+			       rect.x + rect.width <= container.x + container.width &&
+			       rect.y + rect.height <= container.y + container.height;
+		}
+
+		bool Overlaps(const Rectui& first, const Rectui& second)
+		{
+			return first.x < second.x + second.width && first.x + first.width > second.x &&
+			       first.y < second.y + second.height && first.y + first.height > second.y;
+		}
+	}
+
+	/*!
+	* \ingroup core
+	* \class Nz::MaxRectsBinPack
+	* \brief Core class packing rectangles by keeping track of every maximal free rectangle
+	*
+	* Free rectangles may overlap, which gives the best fill rate of the engine bin packers at the cost of slower insertions.
+	* It's best suited for offline packing (e.g. sprite atlases built at load time), where every rectangle is inserted at once and placed by order of best fit.
+	*/
+
+	/*!
+	* \brief Constructs an empty MaxRectsBinPack object
+	*/
+	MaxRectsBinPack::MaxRectsBinPack()
+	{
+		Reset();
+	}
+
+	/*!
+	* \brief Constructs a MaxRectsBinPack object with width and height
+	*
+	* \param width Width
+	* \param height Height
+	*/
+	MaxRectsBinPack::MaxRectsBinPack(unsigned int width, unsigned int height)
+	{
+		Reset(width, height);
+	}
+
+	/*!
+	* \brief Constructs a MaxRectsBinPack object with area
+	*
+	* \param size Vector2 representing the area (width, height)
+	*/
+	MaxRectsBinPack::MaxRectsBinPack(const Vector2ui& size)
+	{
+		Reset(size);
+	}
+
+	/*!
+	* \brief Clears the content
+	*/
+	void MaxRectsBinPack::Clear()
+	{
+		m_freeRectangles.clear();
+		if (m_width > 0 && m_height > 0)
+			m_freeRectangles.push_back(Rectui(0, 0, m_width, m_height));
+
+		m_usedArea = 0;
+	}
+
+	/*!
+	* \brief Expands the content
+	*
+	* \param newWidth New width for the expansion
+	* \param newHeight New height for the expansion
+	*/
+	void MaxRectsBinPack::Expand(unsigned int newWidth, unsigned newHeight)
+	{
+		unsigned int oldWidth = m_width;
+		unsigned int oldHeight = m_height;
+
+		m_width = std::max(newWidth, m_width);
+		m_height = std::max(newHeight, m_height);
+
+		// Free rectangles touching the old borders extend into the new area
+		for (Rectui& freeRect : m_freeRectangles)
+		{
+			if (freeRect.x + freeRect.width == oldWidth)
+				freeRect.width = m_width - freeRect.x;
+
+			if (freeRect.y + freeRect.height == oldHeight)
+				freeRect.height = m_height - freeRect.y;
+		}
+
+		if (m_width > oldWidth)
+			m_freeRectangles.push_back(Rectui(oldWidth, 0, m_width - oldWidth, m_height));
+
+		if (m_height > oldHeight)
+			m_freeRectangles.push_back(Rectui(0, oldHeight, m_width, m_height - oldHeight));
+
+		PruneFreeRectangles(0);
+	}
+
+	/*!
+	* \brief Expands the content
+	*
+	* \param newSize New area for the expansion
+	*/
+	void MaxRectsBinPack::Expand(const Vector2ui& newSize)
+	{
+		Expand(newSize.x, newSize.y);
+	}
+
+	/*!
+	* \brief Frees a rectangle
+	*
+	* \param rect Area to free, which must have been returned by Insert
+	*
+	* \remark The freed rectangle isn't merged with the free space around it, freeing a lot of rectangles fragments the free space
+	*/
+	void MaxRectsBinPack::FreeRectangle(const Rectui& rect)
+	{
+		m_freeRectangles.push_back(rect);
+
+		m_usedArea -= UInt64(rect.width) * rect.height;
+	}
+
+	/*!
+	* \brief Gets the height
+	* \return Height of the area
+	*/
+	unsigned int MaxRectsBinPack::GetHeight() const
+	{
+		return m_height;
+	}
+
+	/*!
+	* \brief Gets percentage of occupation
+	* \return Percentage of the already occupied area
+	*/
+	float MaxRectsBinPack::GetOccupancy() const
+	{
+		return static_cast<float>(m_usedArea) / (UInt64(m_width) * m_height);
+	}
+
+	/*!
+	* \brief Gets the size of the area
+	* \return Size of the area
+	*/
+	Vector2ui MaxRectsBinPack::GetSize() const
+	{
+		return Vector2ui(m_width, m_height);
+	}
+
+	/*!
+	* \brief Gets the width
+	* \return Width of the area
+	*/
+	unsigned int MaxRectsBinPack::GetWidth() const
+	{
+		return m_width;
+	}
+
+	/*!
+	* \brief Inserts rectangles in the area, without flipping them
+	* \return true if each rectangle could be inserted
+	*
+	* \param rects List of rectangles
+	* \param count Count of rectangles
+	* \param heuristic Heuristic used to choose the free rectangle receiving each rectangle
+	*/
+	bool MaxRectsBinPack::Insert(Rectui* rects, unsigned int count, Heuristic heuristic)
+	{
+		return Insert(rects, nullptr, nullptr, count, heuristic);
+	}
+
+	/*!
+	* \brief Inserts rectangles in the area
+	* \return true if each rectangle could be inserted
+	*
+	* \param rects List of rectangles
+	* \param flipped List receiving whether rectangles were flipped (their width and height swapped), rectangles are never flipped if null
+	* \param count Count of rectangles
+	* \param heuristic Heuristic used to choose the free rectangle receiving each rectangle
+	*/
+	bool MaxRectsBinPack::Insert(Rectui* rects, bool* flipped, unsigned int count, Heuristic heuristic)
+	{
+		return Insert(rects, flipped, nullptr, count, heuristic);
+	}
+
+	/*!
+	* \brief Inserts rectangles in the area
+	* \return true if each rectangle could be inserted
+	*
+	* At each step, the rectangle having the best fit among the remaining ones is placed, which packs better than inserting them in order.
+	*
+	* \param rects List of rectangles
+	* \param flipped List receiving whether rectangles were flipped (their width and height swapped), rectangles are never flipped if null
+	* \param inserted List receiving whether rectangles were inserted, can be null
+	* \param count Count of rectangles
+	* \param heuristic Heuristic used to choose the free rectangle receiving each rectangle
+	*/
+	bool MaxRectsBinPack::Insert(Rectui* rects, bool* flipped, bool* inserted, unsigned int count, Heuristic heuristic)
+	{
+		bool allowFlip = (flipped != nullptr);
+
+		StackVector<Rectui*> remainingRects = NazaraStackVector(Rectui*, count);
+		remainingRects.resize(count);
+		for (unsigned int i = 0; i < count; ++i)
+			remainingRects[i] = &rects[i];
+
+		while (!remainingRects.empty())
+		{
+			std::size_t bestFreeRect = m_freeRectangles.size();
+			std::size_t bestRect = remainingRects.size();
+			Int64 bestPrimaryScore = std::numeric_limits<Int64>::max();
+			Int64 bestSecondaryScore = std::numeric_limits<Int64>::max();
+			bool bestFlipped = false;
+
+			auto TestPlacement = [&](std::size_t rectIndex, unsigned int width, unsigned int height, bool isFlipped)
+			{
+				std::size_t freeRectIndex;
+				Int64 primaryScore;
+				Int64 secondaryScore;
+				if (!ScoreRectangle(width, height, heuristic, &freeRectIndex, &primaryScore, &secondaryScore))
+					return;
+
+				if (primaryScore < bestPrimaryScore || (primaryScore == bestPrimaryScore && secondaryScore < bestSecondaryScore))
+				{
+					bestFreeRect = freeRectIndex;
+					bestRect = rectIndex;
+					bestPrimaryScore = primaryScore;
+					bestSecondaryScore = secondaryScore;
+					bestFlipped = isFlipped;
+				}
+			};
+
+			for (std::size_t i = 0; i < remainingRects.size(); ++i)
+			{
+				const Rectui& rect = *remainingRects[i];
+
+				TestPlacement(i, rect.width, rect.height, false);
+				if (allowFlip && rect.width != rect.height)
+					TestPlacement(i, rect.height, rect.width, true);
+			}
+
+			if (bestRect == remainingRects.size())
+			{
+				if (inserted)
+				{
+					for (Rectui* rect : remainingRects)
+						inserted[rect - rects] = false;
+				}
+
+				return false;
+			}
+
+			std::ptrdiff_t position = remainingRects[bestRect] - rects;
+			Rectui& rect = *remainingRects[bestRect];
+			if (bestFlipped)
+				std::swap(rect.width, rect.height);
+
+			rect.x = m_freeRectangles[bestFreeRect].x;
+			rect.y = m_freeRectangles[bestFreeRect].y;
+
+			if (flipped)
+				flipped[position] = bestFlipped;
+
+			if (inserted)
+				inserted[position] = true;
+
+			PlaceRectangle(rect);
+
+			remainingRects.erase(remainingRects.begin() + bestRect);
+
+			m_usedArea += UInt64(rect.width) * rect.height;
+		}
+
+		return true;
+	}
+
+	/*!
+	* \brief Resets the area
+	*/
+	void MaxRectsBinPack::Reset()
+	{
+		Reset(0, 0);
+	}
+
+	/*!
+	* \brief Resets the area
+	*
+	* \param width Width
+	* \param height Height
+	*/
+	void MaxRectsBinPack::Reset(unsigned int width, unsigned int height)
+	{
+		m_height = height;
+		m_width = width;
+
+		Clear();
+	}
+
+	/*!
+	* \brief Resets the area
+	*
+	* \param size Size of the area
+	*/
+	void MaxRectsBinPack::Reset(const Vector2ui& size)
+	{
+		Reset(size.x, size.y);
+	}
+
+	void MaxRectsBinPack::PlaceRectangle(const Rectui& rect)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		// Free rectangles overlapping the placed one are replaced by their (up to four) maximal parts around it
+		std::size_t keptCount = 0;
+		std::size_t freeRectCount = m_freeRectangles.size();
+		for (std::size_t i = 0; i < freeRectCount; ++i)
+		{
+			Rectui freeRect = m_freeRectangles[i];
+			if (!Overlaps(freeRect, rect))
+			{
+				m_freeRectangles[keptCount++] = freeRect;
+				continue;
+			}
+
+			unsigned int freeRight = freeRect.x + freeRect.width;
+			unsigned int freeTop = freeRect.y + freeRect.height;
+			unsigned int rectRight = rect.x + rect.width;
+			unsigned int rectTop = rect.y + rect.height;
+
+			if (rect.x > freeRect.x)
+				m_freeRectangles.push_back(Rectui(freeRect.x, freeRect.y, rect.x - freeRect.x, freeRect.height));
+
+			if (rectRight < freeRight)
+				m_freeRectangles.push_back(Rectui(rectRight, freeRect.y, freeRight - rectRight, freeRect.height));
+
+			if (rect.y > freeRect.y)
+				m_freeRectangles.push_back(Rectui(freeRect.x, freeRect.y, freeRect.width, rect.y - freeRect.y));
+
+			if (rectTop < freeTop)
+				m_freeRectangles.push_back(Rectui(freeRect.x, rectTop, freeRect.width, freeTop - rectTop));
+		}
+
+		// Move the new rectangles right after the kept ones
+		m_freeRectangles.erase(m_freeRectangles.begin() + keptCount, m_freeRectangles.begin() + freeRectCount);
+
+		PruneFreeRectangles(keptCount);
+	}
+
+	void MaxRectsBinPack::PruneFreeRectangles(std::size_t firstNewRect)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		// Rectangles before firstNewRect are already maximal and can't be contained by new ones (which are parts of removed free rectangles)
+		for (std::size_t i = firstNewRect; i < m_freeRectangles.size();)
+		{
+			bool isContained = false;
+			for (std::size_t j = 0; j < m_freeRectangles.size(); ++j)
+			{
+				if (i != j && IsContainedIn(m_freeRectangles[i], m_freeRectangles[j]))
+				{
+					isContained = true;
+					break;
+				}
+			}
+
+			if (isContained)
+			{
+				m_freeRectangles[i] = m_freeRectangles.back();
+				m_freeRectangles.pop_back();
+			}
+			else
+				++i;
+		}
+	}
+
+	bool MaxRectsBinPack::ScoreRectangle(unsigned int width, unsigned int height, Heuristic heuristic, std::size_t* freeRectIndex, Int64* primaryScore, Int64* secondaryScore) const
+	{
+		bool found = false;
+		*primaryScore = std::numeric_limits<Int64>::max();
+		*secondaryScore = std::numeric_limits<Int64>::max();
+
+		for (std::size_t i = 0; i < m_freeRectangles.size(); ++i)
+		{
+			const Rectui& freeRect = m_freeRectangles[i];
+			if (width > freeRect.width || height > freeRect.height)
+				continue;
+
+			Int64 leftoverHoriz = freeRect.width - width;
+			Int64 leftoverVert = freeRect.height - height;
+
+			Int64 primary;
+			Int64 secondary;
+			switch (heuristic)
+			{
+				case Heuristic::BestAreaFit:
+					primary = Int64(freeRect.width) * freeRect.height - Int64(width) * height;
+					secondary = std::min(leftoverHoriz, leftoverVert);
+					break;
+
+				case Heuristic::BestLongSideFit:
+					primary = std::max(leftoverHoriz, leftoverVert);
+					secondary = std::min(leftoverHoriz, leftoverVert);
+					break;
+
+				case Heuristic::BestShortSideFit:
+					primary = std::min(leftoverHoriz, leftoverVert);
+					secondary = std::max(leftoverHoriz, leftoverVert);
+					break;
+
+				case Heuristic::BottomLeft:
+					primary = Int64(freeRect.y) + height;
+					secondary = freeRect.x;
+					break;
+
+				default:
+					NazaraError("unhandled max rects heuristic {0:#x}", UnderlyingCast(heuristic));
+					return false;
+			}
+
+			if (primary < *primaryScore || (primary == *primaryScore && secondary < *secondaryScore))
+			{
+				*freeRectIndex = i;
+				*primaryScore = primary;
+				*secondaryScore = secondary;
+				found = true;
+			}
+		}
+
+		return found;
+	}
+}
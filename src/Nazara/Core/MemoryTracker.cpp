@@ -0,0 +1,92 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/MemoryTracker.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::MemoryTracker
+	* \brief Core class accounting engine memory per subsystem
+	*
+	* Engine allocations (pools, software buffers and containers using TrackedAllocator) report their size under a MemoryTag,
+	* giving live and peak bytes of each subsystem. Allocation rates can be computed from the difference of allocatedBytes/allocationCount between two GetStats calls.
+	*
+	* Accounting is done through the NazaraTrackAllocation/NazaraTrackDeallocation macros, which are compiled out unless NAZARA_CORE_ENABLE_MEMORY_TRACKING is enabled.
+	* Counters are relaxed atomics, each tag living on its own cache line.
+	*/
+
+	/*!
+	* \brief Gets the current counters of a tag
+	* \return Counters, each of them read atomically but not as a whole
+	*/
+	auto MemoryTracker::GetStats(MemoryTag tag) -> Stats
+	{
+		const TagCounters& counters = s_counters[tag];
+
+		Stats stats;
+		stats.allocatedBytes = counters.allocatedBytes.load(std::memory_order_relaxed);
+		stats.allocationCount = counters.allocationCount.load(std::memory_order_relaxed);
+		stats.budget = counters.budget.load(std::memory_order_relaxed);
+		stats.deallocationCount = counters.deallocationCount.load(std::memory_order_relaxed);
+		stats.liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+		stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+
+		return stats;
+	}
+
+	/*!
+	* \brief Gets the display name of a tag
+	*/
+	const char* MemoryTracker::GetTagName(MemoryTag tag)
+	{
+		switch (tag)
+		{
+			case MemoryTag::Audio:    return "Audio";
+			case MemoryTag::Core:     return "Core";
+			case MemoryTag::Fonts:    return "Fonts";
+			case MemoryTag::Graphics: return "Graphics";
+			case MemoryTag::Network:  return "Network";
+			case MemoryTag::Physics:  return "Physics";
+			case MemoryTag::Renderer: return "Renderer";
+			case MemoryTag::Utility:  return "Utility";
+			case MemoryTag::Widgets:  return "Widgets";
+		}
+
+		NazaraError("unhandled MemoryTag {0:#x}", UnderlyingCast(tag));
+		return "<unknown>";
+	}
+
+	/*!
+	* \brief Resets the peak of every tag to its live bytes
+	*/
+	void MemoryTracker::ResetPeaks()
+	{
+		for (TagCounters& counters : s_counters)
+			counters.peakBytes.store(counters.liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+
+	/*!
+	* \brief Sets the memory budget of a tag
+	*
+	* A warning is emitted each time an allocation makes the tag exceed its budget, and IsOverBudget can be polled to react to it (e.g. by evicting caches).
+	*
+	* \param tag Subsystem to bound
+	* \param budget Budget in bytes, zero to remove it
+	*/
+	void MemoryTracker::SetBudget(MemoryTag tag, UInt64 budget)
+	{
+		s_counters[tag].budget.store(budget, std::memory_order_relaxed);
+	}
+
+	void MemoryTracker::OnBudgetExceeded(MemoryTag tag, UInt64 liveBytes, UInt64 budget)
+	{
+		NazaraWarning("{0} memory budget exceeded ({1} bytes used out of {2})", GetTagName(tag), liveBytes, budget);
+	}
+
+	EnumArray<MemoryTag, MemoryTracker::TagCounters> MemoryTracker::s_counters;
+}
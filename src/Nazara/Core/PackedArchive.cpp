@@ -0,0 +1,445 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/PackedArchive.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/ByteStream.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/MemoryView.hpp>
+#include <Nazara/Core/OwnedMemoryStream.hpp>
+#include <Nazara/Core/StringExt.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <lz4.h>
+#include <lz4hc.h>
+#include <zstd.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		constexpr std::array<UInt8, 4> ArchiveIdentifier = { 'N', 'Z', 'P', 'K' };
+
+		// identifier, version, entry count, reserved, TOC offset, TOC size
+		constexpr UInt64 ArchiveHeaderSize = 4 + 4 + 4 + 4 + 8 + 8;
+
+		// path length, (path), compression, offset, size, stored size
+		constexpr UInt64 TocEntryFixedSize = 2 + 1 + 8 + 8 + 8;
+
+		bool CompressEntry(ArchiveCompression compression, int compressionLevel, const std::vector<UInt8>& content, std::vector<UInt8>& compressedContent)
+		{
+			switch (compression)
+			{
+				case ArchiveCompression::None:
+					return false;
+
+				case ArchiveCompression::LZ4:
+				{
+					if (content.size() > LZ4_MAX_INPUT_SIZE)
+						return false;
+
+					int inputSize = SafeCast<int>(content.size());
+					compressedContent.resize(LZ4_compressBound(inputSize));
+
+					const char* input = reinterpret_cast<const char*>(content.data());
+					char* output = reinterpret_cast<char*>(compressedContent.data());
+					int outputCapacity = SafeCast<int>(compressedContent.size());
+
+					// Archives are built offline, so use the slower high compression mode when a level is given
+					int compressedSize;
+					if (compressionLevel > 0)
+						compressedSize = LZ4_compress_HC(input, output, inputSize, outputCapacity, compressionLevel);
+					else
+						compressedSize = LZ4_compress_default(input, output, inputSize, outputCapacity);
+
+					if (compressedSize <= 0)
+						return false;
+
+					compressedContent.resize(compressedSize);
+					return true;
+				}
+
+				case ArchiveCompression::Zstd:
+				{
+					compressedContent.resize(ZSTD_compressBound(content.size()));
+
+					std::size_t compressedSize = ZSTD_compress(compressedContent.data(), compressedContent.size(), content.data(), content.size(), (compressionLevel > 0) ? compressionLevel : ZSTD_CLEVEL_DEFAULT);
+					if (ZSTD_isError(compressedSize))
+						return false;
+
+					compressedContent.resize(compressedSize);
+					return true;
+				}
+			}
+
+			NazaraError("unhandled compression {0:#x}", UnderlyingCast(compression));
+			return false;
+		}
+	}
+
+	/*!
+	* \ingroup core
+	* \class Nz::PackedArchive
+	* \brief Core class that represents a read-only archive packing many files into one
+	*
+	* Packed archives are memory-mapped and store a table of content sorted by path, so looking up an entry doesn't require any system call.
+	* Entries can be compressed individually (using LZ4 or Zstd), uncompressed ones are read in place without copying their content.
+	*
+	* \remark Archives must be owned by a std::shared_ptr, as streams opened from the archive keep it alive
+	* \see VirtualDirectoryArchiveResolver
+	*/
+
+	/*!
+	* \brief Finds an entry of the archive
+	* \return Pointer to the entry, or nullptr if there's no file at this path
+	*
+	* \param path Path of the file relative to the archive root, using '/' as separator
+	*/
+	auto PackedArchive::FindEntry(std::string_view path) const -> const Entry*
+	{
+		auto it = std::lower_bound(m_entries.begin(), m_entries.end(), path, [](const Entry& entry, std::string_view path) { return entry.path < path; });
+		if (it == m_entries.end() || it->path != path)
+			return nullptr;
+
+		return &*it;
+	}
+
+	/*!
+	* \brief Calls a callback for each file and directory in a directory of the archive
+	*
+	* \param directoryPath Path of the directory relative to the archive root, empty for root
+	* \param callback Callback called with the entry name and the file entry (nullptr for directories), returning false stops the iteration
+	*/
+	void PackedArchive::ForEachDirectoryEntry(std::string_view directoryPath, FunctionRef<bool(std::string_view name, const Entry* fileEntry)> callback) const
+	{
+		std::size_t prefixSize = (!directoryPath.empty()) ? directoryPath.size() + 1 : 0;
+
+		std::string_view lastDirectory;
+		for (auto it = FindDirectoryBegin(directoryPath); it != m_entries.end(); ++it)
+		{
+			std::string_view entryPath = it->path;
+			if (prefixSize > 0 && (entryPath.size() <= prefixSize || !StartsWith(entryPath, directoryPath) || entryPath[directoryPath.size()] != '/'))
+				break;
+
+			std::string_view name = entryPath.substr(prefixSize);
+			if (std::size_t separatorPos = name.find('/'); separatorPos != name.npos)
+			{
+				// Entries of a subdirectory are contiguous as they share the same prefix
+				name = name.substr(0, separatorPos);
+				if (name == lastDirectory)
+					continue;
+
+				lastDirectory = name;
+				if (!callback(name, nullptr))
+					return;
+			}
+			else if (!callback(name, &*it))
+				return;
+		}
+	}
+
+	/*!
+	* \brief Checks whether the archive contains a directory
+	* \return True if at least one file is stored under this directory
+	*
+	* \param directoryPath Path of the directory relative to the archive root, empty for root
+	*/
+	bool PackedArchive::HasDirectory(std::string_view directoryPath) const
+	{
+		if (directoryPath.empty())
+			return true;
+
+		auto it = FindDirectoryBegin(directoryPath);
+		if (it == m_entries.end())
+			return false;
+
+		return it->path.size() > directoryPath.size() && StartsWith(it->path, directoryPath) && it->path[directoryPath.size()] == '/';
+	}
+
+	/*!
+	* \brief Opens an archive from a file
+	* \return True if the archive was successfully opened
+	*
+	* \param filePath Path to the archive
+	*/
+	bool PackedArchive::Open(const std::filesystem::path& filePath)
+	{
+		m_entries.clear();
+		m_filePath.clear();
+
+		if (!m_file.Open(filePath, FileAccessPattern::Random))
+			return false;
+
+		UInt64 fileSize = m_file.GetSize();
+		const UInt8* fileData = static_cast<const UInt8*>(m_file.GetData());
+		if (fileSize < ArchiveHeaderSize || std::memcmp(fileData, ArchiveIdentifier.data(), ArchiveIdentifier.size()) != 0)
+		{
+			NazaraError("{0} is not a packed archive", filePath);
+			m_file.Close();
+			return false;
+		}
+
+		ByteStream headerStream(fileData + ArchiveIdentifier.size(), ArchiveHeaderSize - ArchiveIdentifier.size());
+		headerStream.SetDataEndianness(Endianness::LittleEndian);
+
+		UInt32 version, entryCount, reserved;
+		UInt64 tocOffset, tocSize;
+		headerStream >> version >> entryCount >> reserved >> tocOffset >> tocSize;
+
+		if (version != FormatVersion)
+		{
+			NazaraError("{0} has an unsupported version ({1}, expected {2})", filePath, version, FormatVersion);
+			m_file.Close();
+			return false;
+		}
+
+		auto Corrupted = [&]
+		{
+			NazaraError("packed archive {0} is corrupted", filePath);
+			m_entries.clear();
+			m_file.Close();
+			return false;
+		};
+
+		if (tocOffset < ArchiveHeaderSize || tocOffset > fileSize || tocSize > fileSize - tocOffset || tocSize < entryCount * TocEntryFixedSize)
+			return Corrupted();
+
+		MemoryView tocView(fileData + tocOffset, tocSize);
+
+		ByteStream tocStream(&tocView);
+		tocStream.SetDataEndianness(Endianness::LittleEndian);
+
+		m_entries.resize(entryCount);
+		for (Entry& entry : m_entries)
+		{
+			if (tocSize - tocView.GetCursorPos() < TocEntryFixedSize)
+				return Corrupted();
+
+			UInt16 pathLength;
+			tocStream >> pathLength;
+
+			if (tocSize - tocView.GetCursorPos() < pathLength + TocEntryFixedSize - sizeof(UInt16))
+				return Corrupted();
+
+			entry.path.resize(pathLength);
+			tocStream.Read(entry.path.data(), pathLength);
+
+			UInt8 compression;
+			tocStream >> compression >> entry.offset >> entry.size >> entry.storedSize;
+
+			if (compression > UnderlyingCast(ArchiveCompression::Max) || entry.offset > tocOffset || entry.storedSize > tocOffset - entry.offset)
+				return Corrupted();
+
+			entry.compression = static_cast<ArchiveCompression>(compression);
+			if (entry.compression == ArchiveCompression::None && entry.size != entry.storedSize)
+				return Corrupted();
+		}
+
+		// Lookups rely on entries being sorted, which the packer guarantees
+		if (!std::is_sorted(m_entries.begin(), m_entries.end(), [](const Entry& lhs, const Entry& rhs) { return lhs.path < rhs.path; }))
+			return Corrupted();
+
+		m_filePath = filePath;
+		return true;
+	}
+
+	/*!
+	* \brief Opens a stream on the content of an entry
+	* \return Stream on the content of the entry, or nullptr if it failed to decompress
+	*
+	* \param entry Entry of this archive
+	*
+	* \remark Uncompressed entries are read in place from the mapped archive, compressed ones are decompressed in memory
+	*/
+	std::shared_ptr<Stream> PackedArchive::OpenEntry(const Entry& entry) const
+	{
+		NazaraAssert(m_file.IsOpen(), "archive is not open");
+
+		const UInt8* storedData = static_cast<const UInt8*>(m_file.GetData()) + entry.offset;
+		switch (entry.compression)
+		{
+			case ArchiveCompression::None:
+			{
+				// The view must keep the archive alive, as it refers to its mapped memory
+				struct EntryView
+				{
+					std::shared_ptr<const PackedArchive> archive;
+					MemoryView view;
+				};
+
+				auto entryView = std::make_shared<EntryView>(EntryView{ shared_from_this(), MemoryView(storedData, entry.size) });
+				return std::shared_ptr<Stream>(entryView, &entryView->view);
+			}
+
+			case ArchiveCompression::LZ4:
+			{
+				if (entry.size > LZ4_MAX_INPUT_SIZE || entry.storedSize > std::numeric_limits<int>::max())
+				{
+					NazaraError("entry {0} is too large for LZ4", entry.path);
+					return nullptr;
+				}
+
+				ByteArray content(entry.size, 0);
+				int decompressedSize = LZ4_decompress_safe(reinterpret_cast<const char*>(storedData), reinterpret_cast<char*>(content.GetBuffer()), SafeCast<int>(entry.storedSize), SafeCast<int>(entry.size));
+				if (decompressedSize < 0 || UInt64(decompressedSize) != entry.size)
+				{
+					NazaraError("failed to decompress entry {0}", entry.path);
+					return nullptr;
+				}
+
+				return std::make_shared<OwnedMemoryStream>(std::move(content));
+			}
+
+			case ArchiveCompression::Zstd:
+			{
+				ByteArray content(entry.size, 0);
+				std::size_t decompressedSize = ZSTD_decompress(content.GetBuffer(), content.GetSize(), storedData, entry.storedSize);
+				if (ZSTD_isError(decompressedSize) || decompressedSize != entry.size)
+				{
+					NazaraError("failed to decompress entry {0}: {1}", entry.path, (ZSTD_isError(decompressedSize)) ? ZSTD_getErrorName(decompressedSize) : "unexpected size");
+					return nullptr;
+				}
+
+				return std::make_shared<OwnedMemoryStream>(std::move(content));
+			}
+		}
+
+		NazaraError("unhandled compression {0:#x}", UnderlyingCast(entry.compression));
+		return nullptr;
+	}
+
+	/*!
+	* \brief Builds an archive from the content of a directory
+	* \return True if the archive was successfully built
+	*
+	* \param archivePath Path of the archive file to create (overwritten if it exists)
+	* \param sourceDirectory Directory whose files (including subdirectories) will be packed
+	* \param params Compression and alignment parameters
+	*/
+	bool PackedArchive::Build(const std::filesystem::path& archivePath, const std::filesystem::path& sourceDirectory, const BuildParams& params)
+	{
+		NazaraAssert(params.alignment > 0, "alignment must be greater than zero");
+
+		struct SourceFile
+		{
+			std::string path;
+			std::filesystem::path filePath;
+		};
+
+		std::vector<SourceFile> sourceFiles;
+		for (auto&& directoryEntry : std::filesystem::recursive_directory_iterator(sourceDirectory))
+		{
+			if (!directoryEntry.is_regular_file())
+				continue;
+
+			std::string path = PathToString(directoryEntry.path().lexically_relative(sourceDirectory));
+			std::replace(path.begin(), path.end(), '\\', '/');
+
+			if (path.size() > std::numeric_limits<UInt16>::max())
+			{
+				NazaraError("path of {0} is too long", directoryEntry.path());
+				return false;
+			}
+
+			sourceFiles.push_back({ std::move(path), directoryEntry.path() });
+		}
+
+		if (sourceFiles.size() > std::numeric_limits<UInt32>::max())
+		{
+			NazaraError("too many files to pack ({0})", sourceFiles.size());
+			return false;
+		}
+
+		std::sort(sourceFiles.begin(), sourceFiles.end(), [](const SourceFile& lhs, const SourceFile& rhs) { return lhs.path < rhs.path; });
+
+		File archive(archivePath, OpenMode::WriteOnly | OpenMode::Truncate);
+		if (!archive.IsOpen())
+		{
+			NazaraError("failed to open {0}", archivePath);
+			return false;
+		}
+
+		ByteStream archiveStream(&archive);
+		archiveStream.SetDataEndianness(Endianness::LittleEndian);
+
+		// Header is written once the table of content is known
+		std::vector<UInt8> padding(std::max<UInt64>(ArchiveHeaderSize, params.alignment), 0);
+		archive.Write(padding.data(), ArchiveHeaderSize);
+
+		std::vector<Entry> entries;
+		entries.reserve(sourceFiles.size());
+
+		std::vector<UInt8> compressedContent;
+		for (const SourceFile& sourceFile : sourceFiles)
+		{
+			std::optional<std::vector<UInt8>> content = File::ReadWhole(sourceFile.filePath);
+			if (!content)
+			{
+				NazaraError("failed to read {0}", sourceFile.filePath);
+				return false;
+			}
+
+			Entry& entry = entries.emplace_back();
+			entry.path = sourceFile.path;
+			entry.compression = ArchiveCompression::None;
+			entry.size = content->size();
+
+			const std::vector<UInt8>* storedContent = &content.value();
+			if (!content->empty() && CompressEntry(params.compression, params.compressionLevel, *content, compressedContent))
+			{
+				// Keep the entry uncompressed if it doesn't save enough memory, so it can be read in place
+				if (compressedContent.size() < entry.size * params.maxCompressionRatio)
+				{
+					entry.compression = params.compression;
+					storedContent = &compressedContent;
+				}
+			}
+
+			entry.storedSize = storedContent->size();
+
+			UInt64 cursorPos = archive.GetCursorPos();
+			entry.offset = (cursorPos + params.alignment - 1) / params.alignment * params.alignment;
+
+			archive.Write(padding.data(), entry.offset - cursorPos);
+			if (archive.Write(storedContent->data(), storedContent->size()) != storedContent->size())
+			{
+				NazaraError("failed to write {0} to archive", entry.path);
+				return false;
+			}
+		}
+
+		UInt64 tocOffset = archive.GetCursorPos();
+		for (const Entry& entry : entries)
+		{
+			archiveStream << SafeCast<UInt16>(entry.path.size());
+			archiveStream.Write(entry.path.data(), entry.path.size());
+			archiveStream << static_cast<UInt8>(entry.compression) << entry.offset << entry.size << entry.storedSize;
+		}
+		UInt64 tocSize = archive.GetCursorPos() - tocOffset;
+
+		archive.SetCursorPos(0);
+		archive.Write(ArchiveIdentifier.data(), ArchiveIdentifier.size());
+		archiveStream << FormatVersion << SafeCast<UInt32>(entries.size()) << UInt32(0) << tocOffset << tocSize;
+
+		return true;
+	}
+
+	auto PackedArchive::FindDirectoryBegin(std::string_view directoryPath) const -> std::vector<Entry>::const_iterator
+	{
+		if (directoryPath.empty())
+			return m_entries.begin();
+
+		std::string prefix;
+		prefix.reserve(directoryPath.size() + 1);
+		prefix.append(directoryPath);
+		prefix.push_back('/');
+
+		return std::lower_bound(m_entries.begin(), m_entries.end(), prefix, [](const Entry& entry, const std::string& prefix) { return entry.path < prefix; });
+	}
+}
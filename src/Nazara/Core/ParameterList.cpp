@@ -7,6 +7,9 @@
 #include <Nazara/Core/StringExt.hpp>
 #include <NazaraUtils/MemoryHelper.hpp>
 #include <cstring>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -15,6 +18,9 @@ namespace Nz
 	* \ingroup core
 	* \class Nz::ParameterList
 	* \brief Core class that represents a list of parameters
+	*
+	* Parameters are stored in a flat array and looked up by the hash of their name. Names are interned in a global table on first use,
+	* which means setting a parameter or copying a list never allocates a string for its names.
 	*/
 
 	/*!
@@ -38,12 +44,40 @@ namespace Nz
 	*/
 	void ParameterList::Clear()
 	{
-		for (auto& parameter : m_parameters)
-			DestroyValue(parameter.second);
-
 		m_parameters.clear();
 	}
 
+	/*!
+	* \brief Iterates over every value of the parameter list
+	*
+	* \param callback Callback function called with every parameter contained in the list, which can return true to remove the key (or false to keep it)
+	*
+	* \remark Changing the ParameterList while iterating on it may cause bugs, but querying data is safe.
+	*/
+	void ParameterList::ForEach(const std::function<bool(const ParameterList& list, const std::string& name)>& callback)
+	{
+		for (auto it = m_parameters.begin(); it != m_parameters.end();)
+		{
+			if (callback(*this, *it->name))
+				it = m_parameters.erase(it);
+			else
+				++it;
+		}
+	}
+
+	/*!
+	* \brief Iterates over every value of the parameter list
+	*
+	* \param callback Callback function called with every parameter contained in the list
+	*
+	* \remark Changing the ParameterList while iterating on it may cause bugs, but querying data is safe.
+	*/
+	void ParameterList::ForEach(const std::function<void(const ParameterList& list, const std::string& name)>& callback) const
+	{
+		for (const Parameter& parameter : m_parameters)
+			callback(*this, *parameter.name);
+	}
+
 	/*!
 	* \brief Gets a parameter as a boolean
 	* \return result containing the value or an error
@@ -55,31 +89,31 @@ namespace Nz
 	          Integer: 0 is interpreted as false, any other value is interpreted as true
 	          std::string:  Conversion obeys the rule as described by std::string::ToBool
 	*/
-	auto ParameterList::GetBooleanParameter(const std::string& name, bool strict) const -> Result<bool, Error>
+	auto ParameterList::GetBooleanParameter(std::string_view name, bool strict) const -> Result<bool, Error>
 	{
-		auto it = m_parameters.find(name);
-		if (it == m_parameters.end())
+		const Parameter* parameter = FindParameter(name);
+		if (!parameter)
 			return Err(Error::MissingValue);
 
-		switch (it->second.type)
+		switch (parameter->type)
 		{
 			case ParameterType::Boolean:
-				return it->second.value.boolVal;
+				return parameter->value.boolVal;
 
 			case ParameterType::Integer:
 				if (strict)
 					return Err(Error::WouldRequireConversion);
 
-				return (it->second.value.intVal != 0);
+				return (parameter->value.intVal != 0);
 
 			case ParameterType::String:
 			{
 				if (strict)
 					return Err(Error::WouldRequireConversion);
 
-				if (it->second.value.stringVal == "1" || it->second.value.stringVal == "yes" || it->second.value.stringVal == "true")
+				if (parameter->value.stringVal == "1" || parameter->value.stringVal == "yes" || parameter->value.stringVal == "true")
 					return true;
-				else if (it->second.value.stringVal == "0" || it->second.value.stringVal == "no" || it->second.value.stringVal == "false")
+				else if (parameter->value.stringVal == "0" || parameter->value.stringVal == "no" || parameter->value.stringVal == "false")
 					return false;
 
 				return Err(Error::ConversionFailed);
@@ -105,16 +139,16 @@ namespace Nz
 	*
 	* \remark If the parameter is not a color, the function fails
 	*/
-	auto ParameterList::GetColorParameter(const std::string& name, bool /*strict*/) const -> Result<Color, Error>
+	auto ParameterList::GetColorParameter(std::string_view name, bool /*strict*/) const -> Result<Color, Error>
 	{
-		auto it = m_parameters.find(name);
-		if (it == m_parameters.end())
+		const Parameter* parameter = FindParameter(name);
+		if (!parameter)
 			return Err(Error::MissingValue);
 
-		switch (it->second.type)
+		switch (parameter->type)
 		{
 			case ParameterType::Color:
-				return it->second.value.colorVal;
+				return parameter->value.colorVal;
 
 			case ParameterType::Boolean:
 			case ParameterType::Double:
@@ -140,29 +174,29 @@ namespace Nz
 	          Integer: The integer value is converted to its double representation
 	          std::string:  Conversion obeys the rule as described by std::string::ToDouble
 	*/
-	auto ParameterList::GetDoubleParameter(const std::string& name, bool strict) const -> Result<double, Error>
+	auto ParameterList::GetDoubleParameter(std::string_view name, bool strict) const -> Result<double, Error>
 	{
-		auto it = m_parameters.find(name);
-		if (it == m_parameters.end())
+		const Parameter* parameter = FindParameter(name);
+		if (!parameter)
 			return Err(Error::MissingValue);
 
-		switch (it->second.type)
+		switch (parameter->type)
 		{
 			case ParameterType::Double:
-				return it->second.value.doubleVal;
+				return parameter->value.doubleVal;
 
 			case ParameterType::Integer:
 				if (strict)
 					return Err(Error::WouldRequireConversion);
 
-				return static_cast<double>(it->second.value.intVal);
+				return static_cast<double>(parameter->value.intVal);
 
 			case ParameterType::String:
 			{
 				if (strict)
 					return Err(Error::WouldRequireConversion);
 
-				const std::string& str = it->second.value.stringVal;
+				const std::string& str = parameter->value.stringVal;
 
 				int& err = errno;
 				err = 0;
@@ -199,35 +233,35 @@ namespace Nz
 	          Double:  The floating-point value is truncated and converted to a integer
 	          std::string:  Conversion obeys the rule as described by std::string::ToInteger
 	*/
-	auto ParameterList::GetIntegerParameter(const std::string& name, bool strict) const -> Result<long long, Error>
+	auto ParameterList::GetIntegerParameter(std::string_view name, bool strict) const -> Result<long long, Error>
 	{
-		auto it = m_parameters.find(name);
-		if (it == m_parameters.end())
+		const Parameter* parameter = FindParameter(name);
+		if (!parameter)
 			return Err(Error::MissingValue);
 
-		switch (it->second.type)
+		switch (parameter->type)
 		{
 			case ParameterType::Boolean:
 				if (strict)
 					return Err(Error::WouldRequireConversion);
 
-				return (it->second.value.boolVal) ? 1LL : 0LL;
+				return (parameter->value.boolVal) ? 1LL : 0LL;
 
 			case ParameterType::Double:
 				if (strict)
 					return Err(Error::WouldRequireConversion);
 
-				return static_cast<long long>(it->second.value.doubleVal);
+				return static_cast<long long>(parameter->value.doubleVal);
 
 			case ParameterType::Integer:
-				return it->second.value.intVal;
+				return parameter->value.intVal;
 
 			case ParameterType::String:
 			{
 				if (strict)
 					return Err(Error::WouldRequireConversion);
 
-				const std::string& str = it->second.value.stringVal;
+				const std::string& str = parameter->value.stringVal;
 
 				int& err = errno;
 				err = 0;
@@ -259,13 +293,13 @@ namespace Nz
 	*
 	* \remark type must be a valid pointer to a ParameterType variable
 	*/
-	auto ParameterList::GetParameterType(const std::string& name) const -> Result<ParameterType, Error>
+	auto ParameterList::GetParameterType(std::string_view name) const -> Result<ParameterType, Error>
 	{
-		auto it = m_parameters.find(name);
-		if (it == m_parameters.end())
+		const Parameter* parameter = FindParameter(name);
+		if (!parameter)
 			return Err(Error::MissingValue);
 
-		return it->second.type;
+		return parameter->type;
 	}
 
 	/*!
@@ -278,22 +312,22 @@ namespace Nz
 	* \remark If the parameter is not a pointer, a conversion may be performed if strict parameter is set to false, compatibles types are:
 	          Userdata: The pointer part of the userdata is returned
 	*/
-	auto ParameterList::GetPointerParameter(const std::string& name, bool strict) const -> Result<void*, Error>
+	auto ParameterList::GetPointerParameter(std::string_view name, bool strict) const -> Result<void*, Error>
 	{
-		auto it = m_parameters.find(name);
-		if (it == m_parameters.end())
+		const Parameter* parameter = FindParameter(name);
+		if (!parameter)
 			return Err(Error::MissingValue);
 
-		switch (it->second.type)
+		switch (parameter->type)
 		{
 			case ParameterType::Pointer:
-				return it->second.value.ptrVal;
+				return parameter->value.ptrVal;
 
 			case ParameterType::Userdata:
 				if (strict)
 					return Err(Error::WouldRequireConversion);
 
-				return it->second.value.userdataVal->ptr.Get();
+				return parameter->value.userdataVal->ptr.Get();
 
 			case ParameterType::Boolean:
 			case ParameterType::Color:
@@ -323,52 +357,52 @@ namespace Nz
 	          Pointer:  Conversion obeys the rules of PointerToString
 	          Userdata: Conversion obeys the rules of PointerToString
 	*/
-	auto ParameterList::GetStringParameter(const std::string& name, bool strict) const -> Result<std::string, Error>
+	auto ParameterList::GetStringParameter(std::string_view name, bool strict) const -> Result<std::string, Error>
 	{
-		auto it = m_parameters.find(name);
-		if (it == m_parameters.end())
+		const Parameter* parameter = FindParameter(name);
+		if (!parameter)
 			return Err(Error::MissingValue);
 
-		switch (it->second.type)
+		switch (parameter->type)
 		{
 			case ParameterType::Boolean:
 				if (strict)
 					return Err(Error::WouldRequireConversion);
 
-				return std::string{ (it->second.value.boolVal) ? "true" : "false" };
+				return std::string{ (parameter->value.boolVal) ? "true" : "false" };
 
 			case ParameterType::Color:
 				if (strict)
 					return Err(Error::WouldRequireConversion);
 
-				return it->second.value.colorVal.ToString();
+				return parameter->value.colorVal.ToString();
 
 			case ParameterType::Double:
 				if (strict)
 					return Err(Error::WouldRequireConversion);
 
-				return std::to_string(it->second.value.doubleVal);
+				return std::to_string(parameter->value.doubleVal);
 
 			case ParameterType::Integer:
 				if (strict)
 					return Err(Error::WouldRequireConversion);
 
-				return std::to_string(it->second.value.intVal);
+				return std::to_string(parameter->value.intVal);
 
 			case ParameterType::String:
-				return it->second.value.stringVal;
+				return parameter->value.stringVal;
 
 			case ParameterType::Pointer:
 				if (strict)
 					return Err(Error::WouldRequireConversion);
 
-				return PointerToString(it->second.value.ptrVal);
+				return PointerToString(parameter->value.ptrVal);
 
 			case ParameterType::Userdata:
 				if (strict)
 					return Err(Error::WouldRequireConversion);
 
-				return PointerToString(it->second.value.userdataVal->ptr);
+				return PointerToString(parameter->value.userdataVal->ptr);
 
 			case ParameterType::None:
 				if (strict)
@@ -391,22 +425,22 @@ namespace Nz
 			  Boolean:  A string view containing true or false
 			  None:     An empty string view is returned
 	*/
-	auto ParameterList::GetStringViewParameter(const std::string& name, bool strict) const -> Result<std::string_view, Error>
+	auto ParameterList::GetStringViewParameter(std::string_view name, bool strict) const -> Result<std::string_view, Error>
 	{
-		auto it = m_parameters.find(name);
-		if (it == m_parameters.end())
+		const Parameter* parameter = FindParameter(name);
+		if (!parameter)
 			return Err(Error::MissingValue);
 
-		switch (it->second.type)
+		switch (parameter->type)
 		{
 			case ParameterType::Boolean:
 				if (strict)
 					return Err(Error::WouldRequireConversion);
 
-				return std::string_view{ (it->second.value.boolVal) ? "true" : "false" };
+				return std::string_view{ (parameter->value.boolVal) ? "true" : "false" };
 
 			case ParameterType::String:
-				return std::string_view{ it->second.value.stringVal };
+				return std::string_view{ parameter->value.stringVal };
 
 			case ParameterType::None:
 				if (strict)
@@ -436,18 +470,16 @@ namespace Nz
 	*
 	* \see GetPointerParameter
 	*/
-	auto ParameterList::GetUserdataParameter(const std::string& name, bool /*strict*/) const -> Result<void*, Error>
+	auto ParameterList::GetUserdataParameter(std::string_view name, bool /*strict*/) const -> Result<void*, Error>
 	{
-		auto it = m_parameters.find(name);
-		if (it == m_parameters.end())
+		const Parameter* parameter = FindParameter(name);
+		if (!parameter)
 			return Err(Error::MissingValue);
 
-		const auto& parameter = it->second;
-
-		if (parameter.type != ParameterType::Userdata)
+		if (parameter->type != ParameterType::Userdata)
 			return Err(Error::WrongType);
 
-		return parameter.value.userdataVal->ptr.Get();
+		return parameter->value.userdataVal->ptr.Get();
 	}
 
 	/*!
@@ -456,9 +488,9 @@ namespace Nz
 	*
 	* \param name Name of the parameter
 	*/
-	bool ParameterList::HasParameter(const std::string& name) const
+	bool ParameterList::HasParameter(std::string_view name) const
 	{
-		return m_parameters.find(name) != m_parameters.end();
+		return FindParameter(name) != nullptr;
 	}
 
 	/*!
@@ -469,14 +501,10 @@ namespace Nz
 	*
 	* \param name Name of the parameter
 	*/
-	void ParameterList::RemoveParameter(const std::string& name)
+	void ParameterList::RemoveParameter(std::string_view name)
 	{
-		auto it = m_parameters.find(name);
-		if (it != m_parameters.end())
-		{
-			DestroyValue(it->second);
-			m_parameters.erase(it);
-		}
+		if (const Parameter* parameter = FindParameter(name))
+			m_parameters.erase(m_parameters.begin() + (parameter - m_parameters.data()));
 	}
 
 	/*!
@@ -486,7 +514,7 @@ namespace Nz
 	*
 	* \param name Name of the parameter
 	*/
-	void ParameterList::SetParameter(const std::string& name)
+	void ParameterList::SetParameter(std::string_view name)
 	{
 		Parameter& parameter = CreateValue(name);
 		parameter.type = ParameterType::None;
@@ -500,7 +528,7 @@ namespace Nz
 	* \param name Name of the parameter
 	* \param value The color value
 	*/
-	void ParameterList::SetParameter(const std::string& name, const Color& value)
+	void ParameterList::SetParameter(std::string_view name, const Color& value)
 	{
 		Parameter& parameter = CreateValue(name);
 		parameter.type = ParameterType::Color;
@@ -516,7 +544,7 @@ namespace Nz
 	* \param name Name of the parameter
 	* \param value The string value
 	*/
-	void ParameterList::SetParameter(const std::string& name, const std::string& value)
+	void ParameterList::SetParameter(std::string_view name, const std::string& value)
 	{
 		Parameter& parameter = CreateValue(name);
 		parameter.type = ParameterType::String;
@@ -532,7 +560,7 @@ namespace Nz
 	* \param name Name of the parameter
 	* \param value The string value
 	*/
-	void ParameterList::SetParameter(const std::string& name, const char* value)
+	void ParameterList::SetParameter(std::string_view name, const char* value)
 	{
 		Parameter& parameter = CreateValue(name);
 		parameter.type = ParameterType::String;
@@ -548,7 +576,7 @@ namespace Nz
 	* \param name Name of the parameter
 	* \param value The boolean value
 	*/
-	void ParameterList::SetParameter(const std::string& name, bool value)
+	void ParameterList::SetParameter(std::string_view name, bool value)
 	{
 		Parameter& parameter = CreateValue(name);
 		parameter.type = ParameterType::Boolean;
@@ -563,7 +591,7 @@ namespace Nz
 	* \param name Name of the parameter
 	* \param value The double value
 	*/
-	void ParameterList::SetParameter(const std::string& name, double value)
+	void ParameterList::SetParameter(std::string_view name, double value)
 	{
 		Parameter& parameter = CreateValue(name);
 		parameter.type = ParameterType::Double;
@@ -578,7 +606,7 @@ namespace Nz
 	* \param name Name of the parameter
 	* \param value The integer value
 	*/
-	void ParameterList::SetParameter(const std::string& name, long long value)
+	void ParameterList::SetParameter(std::string_view name, long long value)
 	{
 		Parameter& parameter = CreateValue(name);
 		parameter.type = ParameterType::Integer;
@@ -596,7 +624,7 @@ namespace Nz
 	* \remark This sets a raw pointer, this class takes no responsibility toward it,
 	          if you wish to destroy the pointed variable along with the parameter list, you should set a userdata
 	*/
-	void ParameterList::SetParameter(const std::string& name, void* value)
+	void ParameterList::SetParameter(std::string_view name, void* value)
 	{
 		Parameter& parameter = CreateValue(name);
 		parameter.type = ParameterType::Pointer;
@@ -615,10 +643,10 @@ namespace Nz
 		ss << "ParameterList(";
 		for (auto it = m_parameters.cbegin(); it != m_parameters.cend();)
 		{
-			const auto& parameter = it->second;
+			const Parameter& parameter = *it;
 
-			ss << it->first << ": ";
-			switch (it->second.type)
+			ss << *parameter.name << ": ";
+			switch (parameter.type)
 			{
 				case ParameterType::Boolean:
 					ss << "Boolean(" << parameter.value.boolVal << ")";
@@ -666,7 +694,7 @@ namespace Nz
 	* \remark The destructor is called once when all copies of the userdata are destroyed, which means
 	          you can safely copy the parameter list around.
 	*/
-	void ParameterList::SetParameter(const std::string& name, void* value, Destructor destructor)
+	void ParameterList::SetParameter(std::string_view name, void* value, Destructor destructor)
 	{
 		Parameter& parameter = CreateValue(name);
 		parameter.type = ParameterType::Userdata;
@@ -681,39 +709,7 @@ namespace Nz
 	*/
 	ParameterList& ParameterList::operator=(const ParameterList& list)
 	{
-		Clear();
-
-		for (auto it = list.m_parameters.begin(); it != list.m_parameters.end(); ++it)
-		{
-			Parameter& parameter = m_parameters[it->first];
-
-			switch (it->second.type)
-			{
-				case ParameterType::Boolean:
-				case ParameterType::Color:
-				case ParameterType::Double:
-				case ParameterType::Integer:
-				case ParameterType::Pointer:
-					std::memcpy(&parameter, &it->second, sizeof(Parameter));
-					break;
-
-				case ParameterType::String:
-					parameter.type = ParameterType::String;
-
-					PlacementNew(&parameter.value.stringVal, it->second.value.stringVal);
-					break;
-
-				case ParameterType::Userdata:
-					parameter.type = ParameterType::Userdata;
-					parameter.value.userdataVal = it->second.value.userdataVal;
-					++(parameter.value.userdataVal->counter);
-					break;
-
-				case ParameterType::None:
-					parameter.type = ParameterType::None;
-					break;
-			}
-		}
+		m_parameters = list.m_parameters;
 
 		return *this;
 	}
@@ -725,40 +721,93 @@ namespace Nz
 	*
 	* \remark The previous value if any gets destroyed
 	*/
-	ParameterList::Parameter& ParameterList::CreateValue(const std::string& name)
+	ParameterList::Parameter& ParameterList::CreateValue(std::string_view name)
 	{
-		std::pair<ParameterMap::iterator, bool> pair = m_parameters.insert(std::make_pair(name, Parameter()));
-		Parameter& parameter = pair.first->second;
+		if (const Parameter* parameter = FindParameter(name))
+		{
+			Parameter& existingParameter = m_parameters[parameter - m_parameters.data()];
+			existingParameter.DestroyValue();
 
-		if (!pair.second)
-			DestroyValue(parameter);
+			return existingParameter;
+		}
 
-		return parameter;
+		return m_parameters.emplace_back(InternName(name), FNV1a64(name));
 	}
 
 	/*!
-	* \brief Destroys the value for the parameter
+	* \brief Returns the unique string holding a parameter name
+	* \return Interned name, valid until the program exits
 	*
-	* \param parameter Parameter to destroy
+	* \param name Name of the parameter
+	*/
+	const std::string* ParameterList::InternName(std::string_view name)
+	{
+		static std::mutex s_mutex;
+		static std::unordered_map<std::string_view, std::unique_ptr<std::string>> s_names;
+
+		std::lock_guard lock(s_mutex);
+
+		auto it = s_names.find(name);
+		if (it == s_names.end())
+		{
+			auto internedName = std::make_unique<std::string>(name);
+			std::string_view key = *internedName;
+
+			it = s_names.emplace(key, std::move(internedName)).first;
+		}
+
+		return it->second.get();
+	}
+
+	ParameterList::Parameter::Parameter(const std::string* internedName, UInt64 hash) :
+	name(internedName),
+	nameHash(hash),
+	type(ParameterType::None)
+	{
+	}
+
+	ParameterList::Parameter::Parameter(const Parameter& parameter) :
+	name(parameter.name),
+	nameHash(parameter.nameHash),
+	type(ParameterType::None)
+	{
+		operator=(parameter);
+	}
+
+	ParameterList::Parameter::Parameter(Parameter&& parameter) noexcept :
+	name(parameter.name),
+	nameHash(parameter.nameHash),
+	type(ParameterType::None)
+	{
+		operator=(std::move(parameter));
+	}
+
+	ParameterList::Parameter::~Parameter()
+	{
+		DestroyValue();
+	}
+
+	/*!
+	* \brief Destroys the value of the parameter, leaving it with no value
 	*/
-	void ParameterList::DestroyValue(Parameter& parameter)
+	void ParameterList::Parameter::DestroyValue()
 	{
-		switch (parameter.type)
+		switch (type)
 		{
 			case ParameterType::String:
-				PlacementDestroy(&parameter.value.stringVal);
+				PlacementDestroy(&value.stringVal);
 				break;
 
 			case ParameterType::Userdata:
+			{
+				UserdataValue* userdata = value.userdataVal;
+				if (--userdata->counter == 0)
 				{
-					Parameter::UserdataValue* userdata = parameter.value.userdataVal;
-					if (--userdata->counter == 0)
-					{
-						userdata->destructor(userdata->ptr);
-						delete userdata;
-					}
-					break;
+					userdata->destructor(userdata->ptr);
+					delete userdata;
 				}
+				break;
+			}
 
 			case ParameterType::Boolean:
 			case ParameterType::Color:
@@ -768,6 +817,81 @@ namespace Nz
 			case ParameterType::Pointer:
 				break;
 		}
+
+		type = ParameterType::None;
+	}
+
+	auto ParameterList::Parameter::operator=(const Parameter& parameter) -> Parameter&
+	{
+		if (this == &parameter)
+			return *this;
+
+		DestroyValue();
+
+		name = parameter.name;
+		nameHash = parameter.nameHash;
+		type = parameter.type;
+
+		switch (type)
+		{
+			case ParameterType::Boolean:
+			case ParameterType::Color:
+			case ParameterType::Double:
+			case ParameterType::Integer:
+			case ParameterType::Pointer:
+				std::memcpy(&value, &parameter.value, sizeof(Value));
+				break;
+
+			case ParameterType::String:
+				PlacementNew(&value.stringVal, parameter.value.stringVal);
+				break;
+
+			case ParameterType::Userdata:
+				value.userdataVal = parameter.value.userdataVal;
+				++(value.userdataVal->counter);
+				break;
+
+			case ParameterType::None:
+				break;
+		}
+
+		return *this;
+	}
+
+	auto ParameterList::Parameter::operator=(Parameter&& parameter) noexcept -> Parameter&
+	{
+		if (this == &parameter)
+			return *this;
+
+		DestroyValue();
+
+		name = parameter.name;
+		nameHash = parameter.nameHash;
+		type = parameter.type;
+
+		switch (type)
+		{
+			case ParameterType::Boolean:
+			case ParameterType::Color:
+			case ParameterType::Double:
+			case ParameterType::Integer:
+			case ParameterType::Pointer:
+			case ParameterType::Userdata:
+				std::memcpy(&value, &parameter.value, sizeof(Value));
+				break;
+
+			case ParameterType::String:
+				PlacementNew(&value.stringVal, std::move(parameter.value.stringVal));
+				PlacementDestroy(&parameter.value.stringVal);
+				break;
+
+			case ParameterType::None:
+				break;
+		}
+
+		parameter.type = ParameterType::None; //< ownership was transferred
+
+		return *this;
 	}
 
 	/*!
@@ -6,6 +6,7 @@
 #include <Nazara/Core/Algorithm.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/StringExt.hpp>
+#include <cerrno>
 #include <cstdio>
 #include <fcntl.h>
 #include <unistd.h>
@@ -143,6 +144,30 @@ namespace Nz
 			return 0;
 	}
 
+	std::size_t FileImpl::ReadAt(UInt64 offset, void* buffer, std::size_t size) const
+	{
+		// pread doesn't use the file cursor, allowing concurrent reads
+		std::size_t totalRead = 0;
+		while (totalRead < size)
+		{
+			ssize_t bytes = Pread(m_fileDescriptor, static_cast<UInt8*>(buffer) + totalRead, size - totalRead, static_cast<Off_t>(offset + totalRead));
+			if (bytes < 0)
+			{
+				if (errno == EINTR)
+					continue;
+
+				NazaraError("failed to read file: {0}", Error::GetLastSystemError());
+				break;
+			}
+			else if (bytes == 0)
+				break; //< end of file
+
+			totalRead += static_cast<std::size_t>(bytes);
+		}
+
+		return totalRead;
+	}
+
 	bool FileImpl::SetCursorPos(CursorPosition pos, Int64 offset)
 	{
 		int moveMethod;
@@ -23,6 +23,7 @@
 	#define Lseek lseek
 	#define Open_def open
 	#define Ftruncate ftruncate
+	#define Pread pread
 #elif defined(NAZARA_PLATFORM_LINUX) || defined(NAZARA_PLATFORM_WEB)
 	#define Stat stat64
 	#define Fstat fstat64
@@ -30,6 +31,7 @@
 	#define Lseek lseek64
 	#define Open_def open64
 	#define Ftruncate ftruncate64
+	#define Pread pread64
 #else
     #error This operating system is not fully supported by the Nazara Engine
 #endif
@@ -52,6 +54,7 @@ namespace Nz
 			UInt64 GetCursorPos() const;
 			bool Open(const std::filesystem::path& filePath, OpenModeFlags mode);
 			std::size_t Read(void* buffer, std::size_t size);
+			std::size_t ReadAt(UInt64 offset, void* buffer, std::size_t size) const;
 			bool SetCursorPos(CursorPosition pos, Int64 offset);
 			bool SetSize(UInt64 size);
 			std::size_t Write(const void* buffer, std::size_t size);
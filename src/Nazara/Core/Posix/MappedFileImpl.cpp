@@ -0,0 +1,101 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Posix/MappedFileImpl.hpp>
+#include <Nazara/Core/Algorithm.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <NazaraUtils/CallOnExit.hpp>
+#include <cerrno>
+#include <limits>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		int ToPosixAdvice(FileAccessPattern accessPattern)
+		{
+			switch (accessPattern)
+			{
+				case FileAccessPattern::Normal:     return POSIX_MADV_NORMAL;
+				case FileAccessPattern::Random:     return POSIX_MADV_RANDOM;
+				case FileAccessPattern::Sequential: return POSIX_MADV_SEQUENTIAL;
+			}
+
+			NazaraError("unhandled FileAccessPattern {0:#x}", UnderlyingCast(accessPattern));
+			return POSIX_MADV_NORMAL;
+		}
+	}
+
+	MappedFileImpl::MappedFileImpl() :
+	m_ptr(nullptr),
+	m_size(0)
+	{
+	}
+
+	MappedFileImpl::~MappedFileImpl()
+	{
+		if (m_ptr)
+			munmap(m_ptr, static_cast<std::size_t>(m_size));
+	}
+
+	bool MappedFileImpl::Open(const std::filesystem::path& filePath, FileAccessPattern accessPattern)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		int fileDescriptor = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fileDescriptor == -1)
+			return false;
+
+		// The mapping stays valid once the descriptor is closed
+		CallOnExit closeOnExit([&] { close(fileDescriptor); });
+
+		struct stat fileInfo;
+		if (fstat(fileDescriptor, &fileInfo) == -1)
+			return false;
+
+		m_size = static_cast<UInt64>(fileInfo.st_size);
+		if (m_size == 0)
+			return true; //< mmap fails on empty files
+
+		if (m_size > std::numeric_limits<std::size_t>::max())
+		{
+			errno = EFBIG;
+			return false;
+		}
+
+		void* ptr = mmap(nullptr, static_cast<std::size_t>(m_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+		if (ptr == MAP_FAILED)
+			return false;
+
+		m_ptr = ptr;
+		posix_madvise(m_ptr, static_cast<std::size_t>(m_size), ToPosixAdvice(accessPattern));
+
+		return true;
+	}
+
+	void MappedFileImpl::Prefetch(UInt64 offset, UInt64 size)
+	{
+		if (!m_ptr || size == 0)
+			return;
+
+		// Advice range must start on a page boundary
+		UInt64 pageSize = static_cast<UInt64>(sysconf(_SC_PAGESIZE));
+		UInt64 alignedOffset = offset - offset % pageSize;
+
+		posix_madvise(static_cast<UInt8*>(m_ptr) + alignedOffset, static_cast<std::size_t>(size + offset - alignedOffset), POSIX_MADV_WILLNEED);
+	}
+
+	void MappedFileImpl::SetAccessPattern(FileAccessPattern accessPattern)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		if (m_ptr)
+			posix_madvise(m_ptr, static_cast<std::size_t>(m_size), ToPosixAdvice(accessPattern));
+	}
+}
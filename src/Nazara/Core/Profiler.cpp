@@ -0,0 +1,296 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Profiler.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/Format.hpp>
+#include <Nazara/Core/SpscRingBuffer.hpp>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		struct ThreadZones
+		{
+			ThreadZones(std::size_t capacity, UInt32 index) :
+			zones(capacity),
+			threadIndex(index)
+			{
+			}
+
+			SpscRingBuffer<Profiler::Zone> zones;
+			UInt32 threadIndex;
+		};
+
+		struct ProfilerData
+		{
+			std::atomic<UInt64> droppedZoneCount = 0;
+			std::mutex mutex;
+			std::set<std::string, std::less<>> names;
+			std::size_t threadBufferSize = 16 * 1024;
+			std::vector<std::shared_ptr<ThreadZones>> threads;
+			UInt32 nextThreadIndex = 0;
+		};
+
+		ProfilerData& GetProfilerData()
+		{
+			static ProfilerData profilerData;
+			return profilerData;
+		}
+
+		ThreadZones& GetThreadZones()
+		{
+			// Each thread writes to its own ring buffer, the only synchronization happens when a thread records its first zone
+			thread_local std::shared_ptr<ThreadZones> threadZones = []
+			{
+				ProfilerData& profilerData = GetProfilerData();
+
+				std::unique_lock lock(profilerData.mutex);
+				auto zones = std::make_shared<ThreadZones>(profilerData.threadBufferSize, profilerData.nextThreadIndex++);
+				profilerData.threads.push_back(zones);
+
+				return zones;
+			}();
+
+			return *threadZones;
+		}
+
+		void AppendJsonString(std::string& str, std::string_view value)
+		{
+			str += '"';
+			for (char c : value)
+			{
+				switch (c)
+				{
+					case '"':  str += "\\\""; break;
+					case '\\': str += "\\\\"; break;
+					case '\n': str += "\\n"; break;
+					case '\r': str += "\\r"; break;
+					case '\t': str += "\\t"; break;
+					default:
+						if (static_cast<unsigned char>(c) < 0x20)
+							str += Format("\\u{0:04x}", static_cast<unsigned int>(c));
+						else
+							str += c;
+						break;
+				}
+			}
+			str += '"';
+		}
+	}
+
+	/*!
+	* \ingroup core
+	* \class Nz::Profiler
+	* \brief Core class that records timed zones of code, from any thread
+	*
+	* Zones are written to a ring buffer owned by the recording thread, and gathered by CollectZones (usually once per frame or at the end of a capture).
+	* When a thread records more zones than its buffer can hold between two collections, new zones are dropped.
+	*
+	* Engine subsystems (application updates, entity systems, frame pipeline and frame graph passes) are instrumented with the NazaraProfileScope macro,
+	* which is compiled out unless NAZARA_CORE_ENABLE_PROFILING is enabled.
+	*/
+
+	/*!
+	* \brief Gathers every zone recorded since the last collection
+	* \return Zones, sorted by their beginning time
+	*/
+	std::vector<Profiler::Zone> Profiler::CollectZones()
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		ProfilerData& profilerData = GetProfilerData();
+
+		std::vector<Zone> zones;
+
+		std::unique_lock lock(profilerData.mutex);
+		for (auto it = profilerData.threads.begin(); it != profilerData.threads.end();)
+		{
+			ThreadZones& threadZones = **it;
+
+			std::size_t zoneCount = threadZones.zones.GetReadableCount();
+			if (zoneCount > 0)
+			{
+				std::size_t offset = zones.size();
+				zones.resize(offset + zoneCount);
+				threadZones.zones.Read(zones.data() + offset, zoneCount);
+			}
+
+			// Forget threads which exited, once their zones have been gathered
+			if (it->use_count() == 1)
+				it = profilerData.threads.erase(it);
+			else
+				++it;
+		}
+		lock.unlock();
+
+		std::sort(zones.begin(), zones.end(), [](const Zone& lhs, const Zone& rhs) { return lhs.beginTime < rhs.beginTime; });
+
+		return zones;
+	}
+
+	/*!
+	* \brief Enables or disables zone recording
+	*
+	* \param enable Should zones be recorded
+	*/
+	void Profiler::Enable(bool enable)
+	{
+		s_isEnabled.store(enable, std::memory_order_relaxed);
+	}
+
+	/*!
+	* \brief Writes zones to a file using the Chrome trace event format
+	* \return True if the file was written
+	*
+	* \param filePath Path of the file to write
+	* \param zones Zones to export, as returned by CollectZones
+	*
+	* \see ExportChromeTrace
+	*/
+	bool Profiler::ExportChromeTrace(const std::filesystem::path& filePath, const std::vector<Zone>& zones)
+	{
+		File file(filePath, OpenMode::WriteOnly | OpenMode::Truncate);
+		if (!file.IsOpen())
+		{
+			NazaraError("failed to open {0}", filePath);
+			return false;
+		}
+
+		return ExportChromeTrace(file, zones);
+	}
+
+	/*!
+	* \brief Writes zones to a stream using the Chrome trace event format
+	* \return True if the trace was written
+	*
+	* The resulting JSON can be opened with chrome://tracing, Perfetto or imported in Tracy (using its import-chrome tool).
+	*
+	* \param stream Stream to write the trace to
+	* \param zones Zones to export, as returned by CollectZones
+	*/
+	bool Profiler::ExportChromeTrace(Stream& stream, const std::vector<Zone>& zones)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		std::string trace = R"({"displayTimeUnit":"ms","traceEvents":[)";
+
+		bool first = true;
+		for (const Zone& zone : zones)
+		{
+			if (!first)
+				trace += ',';
+
+			first = false;
+
+			trace += R"({"name":)";
+			AppendJsonString(trace, (zone.name) ? zone.name : "");
+			trace += Format(R"(,"ph":"X","ts":{0:.3f},"dur":{1:.3f},"pid":0,"tid":{2}}})", zone.beginTime.AsNanoseconds() / 1000.0, (zone.endTime - zone.beginTime).AsNanoseconds() / 1000.0, zone.threadIndex);
+		}
+
+		trace += "]}";
+
+		return stream.Write(trace.data(), trace.size()) == trace.size();
+	}
+
+	/*!
+	* \brief Returns the number of zones which were dropped because a thread buffer was full
+	* \return Dropped zone count since the application started
+	*/
+	UInt64 Profiler::GetDroppedZoneCount()
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		return GetProfilerData().droppedZoneCount.load(std::memory_order_relaxed);
+	}
+
+	/*!
+	* \brief Returns the number of zones a thread can record between two collections
+	* \return Thread buffer size, in zones
+	*/
+	std::size_t Profiler::GetThreadBufferSize()
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		ProfilerData& profilerData = GetProfilerData();
+
+		std::unique_lock lock(profilerData.mutex);
+		return profilerData.threadBufferSize;
+	}
+
+	/*!
+	* \brief Stores a zone name for the lifetime of the application
+	* \return Pointer to a null-terminated copy of the name, which can be given to zones
+	*
+	* This is intended for names built at runtime (such as frame pass names), call it once and keep the returned pointer.
+	*
+	* \param name Name to store
+	*/
+	const char* Profiler::InternName(std::string_view name)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		ProfilerData& profilerData = GetProfilerData();
+
+		std::unique_lock lock(profilerData.mutex);
+		auto it = profilerData.names.find(name);
+		if (it == profilerData.names.end())
+			it = profilerData.names.emplace(name).first;
+
+		return it->c_str();
+	}
+
+	/*!
+	* \brief Records a zone for the current thread
+	*
+	* \param name Name of the zone, must stay valid as long as the profiler is used (a string literal or a name returned by InternName)
+	* \param beginTime Time at which the zone began (from GetElapsedNanoseconds)
+	* \param endTime Time at which the zone ended (from GetElapsedNanoseconds)
+	*
+	* \remark Zones are dropped if the thread buffer is full
+	*/
+	void Profiler::RecordZone(const char* name, Time beginTime, Time endTime)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		ThreadZones& threadZones = GetThreadZones();
+
+		Zone zone;
+		zone.name = name;
+		zone.beginTime = beginTime;
+		zone.endTime = endTime;
+		zone.threadIndex = threadZones.threadIndex;
+
+		if (threadZones.zones.Write(&zone, 1) == 0)
+			GetProfilerData().droppedZoneCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	/*!
+	* \brief Sets the number of zones a thread can record between two collections
+	*
+	* \param zoneCount Thread buffer size, in zones
+	*
+	* \remark Only applies to threads which haven't recorded a zone yet
+	*/
+	void Profiler::SetThreadBufferSize(std::size_t zoneCount)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		NazaraAssert(zoneCount > 0, "thread buffer size must be positive");
+
+		ProfilerData& profilerData = GetProfilerData();
+
+		std::unique_lock lock(profilerData.mutex);
+		profilerData.threadBufferSize = zoneCount;
+	}
+
+	std::atomic_bool Profiler::s_isEnabled = false;
+}
@@ -25,6 +25,18 @@ namespace Nz
 		return m_filePath;
 	}
 
+	/*!
+	* \brief Gets the memory (in bytes) used by the resource
+	* \return Estimated CPU and GPU memory used by the resource, zero if unknown
+	*
+	* \remark This is used by ResourceManager to enforce its memory budget
+	*/
+
+	std::size_t Resource::GetMemoryUsage() const
+	{
+		return 0;
+	}
+
 	/*!
 	* \brief Sets the file path associated with the resource
 	*
@@ -5,6 +5,7 @@
 #include <Nazara/Core/SerializationContext.hpp>
 #include <Nazara/Core/Algorithm.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <algorithm>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -32,4 +33,85 @@ namespace Nz
 				NazaraWarning("Failed to flush bits");
 		}
 	}
+
+	/*!
+	* \brief Reads bits from the stream, using the current bit cursor
+	* \return true if the bits were read
+	*
+	* Bits are read from the least significant to the most significant one, like booleans, a new byte is read
+	* from the stream each time the current one is exhausted.
+	*
+	* \param value Output value, bits above bitCount are set to zero
+	* \param bitCount Number of bits to read (up to 64)
+	*
+	* \see WriteBits
+	*/
+	bool SerializationContext::ReadBits(UInt64* value, UInt8 bitCount)
+	{
+		NazaraAssert(value, "invalid value");
+		NazaraAssert(bitCount <= 64, "bit count must be 64 or less");
+
+		UInt64 result = 0;
+		UInt8 bitOffset = 0;
+		while (bitOffset < bitCount)
+		{
+			if (readBitPos == 8)
+			{
+				if (stream->Read(&readByte, 1) != 1)
+					return false;
+
+				readBitPos = 0;
+			}
+
+			UInt8 count = std::min<UInt8>(bitCount - bitOffset, 8 - readBitPos);
+			result |= UInt64((readByte >> readBitPos) & ((1u << count) - 1)) << bitOffset;
+
+			readBitPos += count;
+			bitOffset += count;
+		}
+
+		*value = result;
+		return true;
+	}
+
+	/*!
+	* \brief Writes bits to the stream, using the current bit cursor
+	* \return true if the bits were written
+	*
+	* Bits are written from the least significant to the most significant one, like booleans, bytes are written
+	* to the stream as soon as they are complete (remaining bits are written by FlushBits).
+	*
+	* \param value Value to write, bits above bitCount are ignored
+	* \param bitCount Number of bits to write (up to 64)
+	*
+	* \see FlushBits, ReadBits
+	*/
+	bool SerializationContext::WriteBits(UInt64 value, UInt8 bitCount)
+	{
+		NazaraAssert(bitCount <= 64, "bit count must be 64 or less");
+
+		while (bitCount > 0)
+		{
+			if (writeBitPos == 8)
+			{
+				writeBitPos = 0;
+				writeByte = 0;
+			}
+
+			UInt8 count = std::min<UInt8>(bitCount, 8 - writeBitPos);
+			writeByte |= UInt8((value & ((1u << count) - 1)) << writeBitPos);
+
+			value >>= count;
+			bitCount -= count;
+			writeBitPos += count;
+
+			if (writeBitPos == 8)
+			{
+				if (stream->Write(&writeByte, 1) != 1)
+					return false;
+			}
+		}
+
+		return true;
+	}
 }
@@ -0,0 +1,482 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+// Based on the public domain work of Jukka Jylänki
+// http://clb.demon.fi/projects/even-more-rectangle-bin-packing
+
+#include <Nazara/Core/SkylineBinPack.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <algorithm>
+#include <limits>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::SkylineBinPack
+	* \brief Core class packing rectangles by keeping track of the top edge (the skyline) of the packed rectangles
+	*
+	* Placing a rectangle only looks at the skyline segments, making insertions much cheaper than with GuillotineBinPack while keeping a good fill rate for
+	* rectangles of similar heights (such as glyphs).
+	* Areas left below the skyline and freed rectangles are kept in a waste map which is tried first by every insertion, so freed space gets reused.
+	*/
+
+	/*!
+	* \brief Constructs an empty SkylineBinPack object
+	*/
+	SkylineBinPack::SkylineBinPack()
+	{
+		Reset();
+	}
+
+	/*!
+	* \brief Constructs a SkylineBinPack object with width and height
+	*
+	* \param width Width
+	* \param height Height
+	*/
+	SkylineBinPack::SkylineBinPack(unsigned int width, unsigned int height)
+	{
+		Reset(width, height);
+	}
+
+	/*!
+	* \brief Constructs a SkylineBinPack object with area
+	*
+	* \param size Vector2 representing the area (width, height)
+	*/
+	SkylineBinPack::SkylineBinPack(const Vector2ui& size)
+	{
+		Reset(size);
+	}
+
+	/*!
+	* \brief Clears the content
+	*/
+	void SkylineBinPack::Clear()
+	{
+		m_skyline.clear();
+		m_skyline.push_back(SkylineNode{ 0, 0, m_width });
+		m_wasteRectangles.clear();
+
+		m_usedArea = 0;
+	}
+
+	/*!
+	* \brief Expands the content
+	*
+	* \param newWidth New width for the expansion
+	* \param newHeight New height for the expansion
+	*/
+	void SkylineBinPack::Expand(unsigned int newWidth, unsigned newHeight)
+	{
+		unsigned int oldWidth = m_width;
+
+		m_width = std::max(newWidth, m_width);
+		m_height = std::max(newHeight, m_height);
+
+		// A taller bin only raises the limit of the skyline, a wider one extends the skyline at ground level
+		if (m_width > oldWidth)
+		{
+			if (m_skyline.back().y == 0)
+				m_skyline.back().width += m_width - oldWidth;
+			else
+				m_skyline.push_back(SkylineNode{ oldWidth, 0, m_width - oldWidth });
+		}
+	}
+
+	/*!
+	* \brief Expands the content
+	*
+	* \param newSize New area for the expansion
+	*/
+	void SkylineBinPack::Expand(const Vector2ui& newSize)
+	{
+		Expand(newSize.x, newSize.y);
+	}
+
+	/*!
+	* \brief Frees a rectangle
+	*
+	* \param rect Area to free, which must have been returned by Insert
+	*
+	* \remark The skyline is not lowered, the freed area is added to the waste map and will be reused by next insertions
+	*/
+	void SkylineBinPack::FreeRectangle(const Rectui& rect)
+	{
+		m_wasteRectangles.push_back(rect);
+
+		m_usedArea -= UInt64(rect.width) * rect.height;
+	}
+
+	/*!
+	* \brief Gets the height
+	* \return Height of the area
+	*/
+	unsigned int SkylineBinPack::GetHeight() const
+	{
+		return m_height;
+	}
+
+	/*!
+	* \brief Gets percentage of occupation
+	* \return Percentage of the already occupied area
+	*/
+	float SkylineBinPack::GetOccupancy() const
+	{
+		return static_cast<float>(m_usedArea) / (UInt64(m_width) * m_height);
+	}
+
+	/*!
+	* \brief Gets the size of the area
+	* \return Size of the area
+	*/
+	Vector2ui SkylineBinPack::GetSize() const
+	{
+		return Vector2ui(m_width, m_height);
+	}
+
+	/*!
+	* \brief Gets the width
+	* \return Width of the area
+	*/
+	unsigned int SkylineBinPack::GetWidth() const
+	{
+		return m_width;
+	}
+
+	/*!
+	* \brief Inserts rectangles in the area, without flipping them
+	* \return true if each rectangle could be inserted
+	*
+	* \param rects List of rectangles
+	* \param count Count of rectangles
+	* \param heuristic Heuristic used to choose the position of the rectangles on the skyline
+	*/
+	bool SkylineBinPack::Insert(Rectui* rects, unsigned int count, Heuristic heuristic)
+	{
+		return Insert(rects, nullptr, nullptr, count, heuristic);
+	}
+
+	/*!
+	* \brief Inserts rectangles in the area
+	* \return true if each rectangle could be inserted
+	*
+	* \param rects List of rectangles
+	* \param flipped List receiving whether rectangles were flipped (their width and height swapped), rectangles are never flipped if null
+	* \param count Count of rectangles
+	* \param heuristic Heuristic used to choose the position of the rectangles on the skyline
+	*/
+	bool SkylineBinPack::Insert(Rectui* rects, bool* flipped, unsigned int count, Heuristic heuristic)
+	{
+		return Insert(rects, flipped, nullptr, count, heuristic);
+	}
+
+	/*!
+	* \brief Inserts rectangles in the area
+	* \return true if each rectangle could be inserted
+	*
+	* Rectangles are inserted in order, a rectangle which doesn't fit is skipped and the next ones are still inserted.
+	*
+	* \param rects List of rectangles
+	* \param flipped List receiving whether rectangles were flipped (their width and height swapped), rectangles are never flipped if null
+	* \param inserted List receiving whether rectangles were inserted, can be null
+	* \param count Count of rectangles
+	* \param heuristic Heuristic used to choose the position of the rectangles on the skyline
+	*/
+	bool SkylineBinPack::Insert(Rectui* rects, bool* flipped, bool* inserted, unsigned int count, Heuristic heuristic)
+	{
+		bool allowFlip = (flipped != nullptr);
+		bool everyRectInserted = true;
+
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			Rectui& rect = rects[i];
+
+			bool rectFlipped = false;
+			if (!InsertIntoWasteMap(rect, allowFlip, &rectFlipped))
+			{
+				std::size_t bestNode;
+				unsigned int bestY;
+				UInt64 bestPrimaryScore;
+				UInt64 bestSecondaryScore;
+				bool found = FindSkylinePosition(rect.width, rect.height, heuristic, &bestNode, &bestY, &bestPrimaryScore, &bestSecondaryScore);
+
+				if (allowFlip && rect.width != rect.height)
+				{
+					std::size_t node;
+					unsigned int y;
+					UInt64 primaryScore;
+					UInt64 secondaryScore;
+					if (FindSkylinePosition(rect.height, rect.width, heuristic, &node, &y, &primaryScore, &secondaryScore))
+					{
+						if (!found || primaryScore < bestPrimaryScore || (primaryScore == bestPrimaryScore && secondaryScore < bestSecondaryScore))
+						{
+							bestNode = node;
+							bestY = y;
+							found = true;
+							rectFlipped = true;
+						}
+					}
+				}
+
+				if (!found)
+				{
+					if (inserted)
+						inserted[i] = false;
+
+					everyRectInserted = false;
+					continue;
+				}
+
+				if (rectFlipped)
+					std::swap(rect.width, rect.height);
+
+				rect.x = m_skyline[bestNode].x;
+				rect.y = bestY;
+
+				AddWastedAreas(bestNode, rect);
+				AddSkylineLevel(bestNode, rect);
+			}
+
+			if (flipped)
+				flipped[i] = rectFlipped;
+
+			if (inserted)
+				inserted[i] = true;
+
+			m_usedArea += UInt64(rect.width) * rect.height;
+		}
+
+		return everyRectInserted;
+	}
+
+	/*!
+	* \brief Resets the area
+	*/
+	void SkylineBinPack::Reset()
+	{
+		Reset(0, 0);
+	}
+
+	/*!
+	* \brief Resets the area
+	*
+	* \param width Width
+	* \param height Height
+	*/
+	void SkylineBinPack::Reset(unsigned int width, unsigned int height)
+	{
+		m_height = height;
+		m_width = width;
+
+		Clear();
+	}
+
+	/*!
+	* \brief Resets the area
+	*
+	* \param size Size of the area
+	*/
+	void SkylineBinPack::Reset(const Vector2ui& size)
+	{
+		Reset(size.x, size.y);
+	}
+
+	void SkylineBinPack::AddSkylineLevel(std::size_t nodeIndex, const Rectui& rect)
+	{
+		m_skyline.insert(m_skyline.begin() + nodeIndex, SkylineNode{ rect.x, rect.y + rect.height, rect.width });
+
+		// Shrink or remove the nodes now covered by the new one
+		for (std::size_t i = nodeIndex + 1; i < m_skyline.size();)
+		{
+			const SkylineNode& previousNode = m_skyline[i - 1];
+			SkylineNode& node = m_skyline[i];
+
+			unsigned int previousEnd = previousNode.x + previousNode.width;
+			if (node.x >= previousEnd)
+				break;
+
+			unsigned int shrink = previousEnd - node.x;
+			if (node.width > shrink)
+			{
+				node.x += shrink;
+				node.width -= shrink;
+				break;
+			}
+
+			m_skyline.erase(m_skyline.begin() + i);
+		}
+
+		// Merge neighbors of the same level
+		for (std::size_t i = 0; i + 1 < m_skyline.size();)
+		{
+			if (m_skyline[i].y == m_skyline[i + 1].y)
+			{
+				m_skyline[i].width += m_skyline[i + 1].width;
+				m_skyline.erase(m_skyline.begin() + i + 1);
+			}
+			else
+				++i;
+		}
+	}
+
+	void SkylineBinPack::AddWastedAreas(std::size_t nodeIndex, const Rectui& rect)
+	{
+		unsigned int rectEnd = rect.x + rect.width;
+		for (std::size_t i = nodeIndex; i < m_skyline.size() && m_skyline[i].x < rectEnd; ++i)
+		{
+			const SkylineNode& node = m_skyline[i];
+			if (node.y >= rect.y)
+				continue;
+
+			unsigned int left = std::max(node.x, rect.x);
+			unsigned int right = std::min(node.x + node.width, rectEnd);
+			m_wasteRectangles.push_back(Rectui(left, node.y, right - left, rect.y - node.y));
+		}
+	}
+
+	bool SkylineBinPack::FindSkylinePosition(unsigned int width, unsigned int height, Heuristic heuristic, std::size_t* nodeIndex, unsigned int* y, UInt64* primaryScore, UInt64* secondaryScore) const
+	{
+		bool found = false;
+		*primaryScore = std::numeric_limits<UInt64>::max();
+		*secondaryScore = std::numeric_limits<UInt64>::max();
+
+		for (std::size_t i = 0; i < m_skyline.size(); ++i)
+		{
+			unsigned int nodeY;
+			UInt64 wastedArea;
+			if (!RectangleFits(i, width, height, &nodeY, &wastedArea))
+				continue;
+
+			UInt64 topSide = UInt64(nodeY) + height;
+
+			UInt64 primary;
+			UInt64 secondary;
+			switch (heuristic)
+			{
+				case Heuristic::BottomLeft:
+					primary = topSide;
+					secondary = m_skyline[i].width;
+					break;
+
+				case Heuristic::MinWaste:
+					primary = wastedArea;
+					secondary = topSide;
+					break;
+
+				default:
+					NazaraError("unhandled skyline heuristic {0:#x}", UnderlyingCast(heuristic));
+					return false;
+			}
+
+			if (primary < *primaryScore || (primary == *primaryScore && secondary < *secondaryScore))
+			{
+				*nodeIndex = i;
+				*primaryScore = primary;
+				*secondaryScore = secondary;
+				*y = nodeY;
+				found = true;
+			}
+		}
+
+		return found;
+	}
+
+	bool SkylineBinPack::InsertIntoWasteMap(Rectui& rect, bool allowFlip, bool* flipped)
+	{
+		std::size_t bestRect = m_wasteRectangles.size();
+		UInt64 bestScore = std::numeric_limits<UInt64>::max();
+		bool bestFlipped = false;
+
+		UInt64 area = UInt64(rect.width) * rect.height;
+		for (std::size_t i = 0; i < m_wasteRectangles.size(); ++i)
+		{
+			const Rectui& freeRect = m_wasteRectangles[i];
+
+			bool fitsUpright = (rect.width <= freeRect.width && rect.height <= freeRect.height);
+			bool fitsFlipped = allowFlip && (rect.height <= freeRect.width && rect.width <= freeRect.height);
+			if (!fitsUpright && !fitsFlipped)
+				continue;
+
+			// Best area fit
+			UInt64 score = UInt64(freeRect.width) * freeRect.height - area;
+			if (score < bestScore)
+			{
+				bestRect = i;
+				bestScore = score;
+				bestFlipped = !fitsUpright;
+
+				if (score == 0)
+					break;
+			}
+		}
+
+		if (bestRect == m_wasteRectangles.size())
+			return false;
+
+		Rectui freeRect = m_wasteRectangles[bestRect];
+		m_wasteRectangles[bestRect] = m_wasteRectangles.back();
+		m_wasteRectangles.pop_back();
+
+		if (bestFlipped)
+			std::swap(rect.width, rect.height);
+
+		rect.x = freeRect.x;
+		rect.y = freeRect.y;
+
+		// Split the L-shaped leftover along its shorter axis, keeping the bigger rectangle as large as possible
+		unsigned int leftoverWidth = freeRect.width - rect.width;
+		unsigned int leftoverHeight = freeRect.height - rect.height;
+		bool splitHorizontal = (leftoverWidth <= leftoverHeight);
+
+		Rectui bottom(freeRect.x, freeRect.y + rect.height, (splitHorizontal) ? freeRect.width : rect.width, leftoverHeight);
+		Rectui right(freeRect.x + rect.width, freeRect.y, leftoverWidth, (splitHorizontal) ? rect.height : freeRect.height);
+
+		if (bottom.width > 0 && bottom.height > 0)
+			m_wasteRectangles.push_back(bottom);
+
+		if (right.width > 0 && right.height > 0)
+			m_wasteRectangles.push_back(right);
+
+		*flipped = bestFlipped;
+		return true;
+	}
+
+	bool SkylineBinPack::RectangleFits(std::size_t nodeIndex, unsigned int width, unsigned int height, unsigned int* y, UInt64* wastedArea) const
+	{
+		unsigned int x = m_skyline[nodeIndex].x;
+		if (UInt64(x) + width > m_width)
+			return false;
+
+		// The rectangle rests on the highest node it spans
+		unsigned int restY = 0;
+		std::size_t lastNode = nodeIndex;
+		for (unsigned int spannedWidth = 0; spannedWidth < width; ++lastNode)
+		{
+			NazaraAssert(lastNode < m_skyline.size(), "skyline doesn't cover the whole width");
+
+			const SkylineNode& node = m_skyline[lastNode];
+			restY = std::max(restY, node.y);
+			if (UInt64(restY) + height > m_height)
+				return false;
+
+			spannedWidth = node.x + node.width - x;
+		}
+
+		UInt64 waste = 0;
+		unsigned int rectEnd = x + width;
+		for (std::size_t i = nodeIndex; i < lastNode; ++i)
+		{
+			const SkylineNode& node = m_skyline[i];
+			unsigned int right = std::min(node.x + node.width, rectEnd);
+			waste += UInt64(restY - node.y) * (right - node.x);
+		}
+
+		*wastedArea = waste;
+		*y = restY;
+		return true;
+	}
+}
@@ -7,12 +7,51 @@
 #include <Nazara/Core/Error.hpp>
 #include <Utfcpp/utf8.h>
 #include <cinttypes>
+#include <cstring>
+
+#if defined(NAZARA_ARCH_x86) || defined(NAZARA_ARCH_x86_64)
+#include <emmintrin.h>
+#endif
+
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
 {
 	namespace NAZARA_ANONYMOUS_NAMESPACE
 	{
+		// Returns the number of ASCII characters starting at ptr, text being mostly ASCII they can be skipped 16 bytes at a time
+		std::size_t ComputeAsciiLength(const char* ptr, const char* end)
+		{
+			const char* start = ptr;
+
+#if defined(NAZARA_ARCH_x86) || defined(NAZARA_ARCH_x86_64)
+			while (end - ptr >= 16)
+			{
+				// Non-ASCII bytes have their most significant bit set
+				__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+				if (_mm_movemask_epi8(bytes) != 0)
+					break; //< let the scalar loop find which byte it is
+
+				ptr += 16;
+			}
+#else
+			while (end - ptr >= 8)
+			{
+				UInt64 bytes;
+				std::memcpy(&bytes, ptr, sizeof(bytes));
+				if (bytes & 0x8080808080808080ULL)
+					break;
+
+				ptr += 8;
+			}
+#endif
+
+			while (ptr < end && static_cast<UInt8>(*ptr) < 0x80)
+				++ptr;
+
+			return ptr - start;
+		}
+
 		bool IsSpace(char32_t character)
 		{
 			switch (character)
@@ -94,7 +133,26 @@ namespace Nz
 
 	std::size_t ComputeCharacterCount(std::string_view str)
 	{
-		return utf8::distance(str.data(), str.data() + str.size());
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		const char* ptr = str.data();
+		const char* end = ptr + str.size();
+
+		std::size_t characterCount = 0;
+		while (ptr < end)
+		{
+			std::size_t asciiLength = ComputeAsciiLength(ptr, end);
+			characterCount += asciiLength;
+			ptr += asciiLength;
+
+			if (ptr < end)
+			{
+				utf8::next(ptr, end);
+				characterCount++;
+			}
+		}
+
+		return characterCount;
 	}
 	
 	bool EndsWith(std::string_view lhs, std::string_view rhs, CaseIndependent)
@@ -187,12 +245,28 @@ namespace Nz
 
 	std::size_t GetCharacterPosition(std::string_view str, std::size_t characterIndex)
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
 		const char* ptr = str.data();
 		const char* end = ptr + str.size();
 
 		try
 		{
-			utf8::advance(ptr, characterIndex, end);
+			while (characterIndex > 0)
+			{
+				std::size_t asciiLength = ComputeAsciiLength(ptr, ptr + std::min<std::size_t>(end - ptr, characterIndex));
+				characterIndex -= asciiLength;
+				ptr += asciiLength;
+
+				if (characterIndex > 0)
+				{
+					if (ptr == end)
+						return std::string::npos;
+
+					utf8::next(ptr, end);
+					characterIndex--;
+				}
+			}
 
 			return ptr - str.data();
 		}
@@ -261,14 +335,25 @@ namespace Nz
 
 	void IterateOnCodepoints(std::string_view str, FunctionRef<bool(const char32_t* characters, std::size_t characterCount)> callback)
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
 		std::array<char32_t, 32> buffer;
 		std::size_t charCount = 0;
 
-		utf8::unchecked::iterator<const char*> it(str.data());
-		utf8::unchecked::iterator<const char*> end(str.data() + str.size());
-		for (; it != end; ++it)
+		const char* ptr = str.data();
+		const char* end = ptr + str.size();
+		while (ptr < end)
 		{
-			buffer[charCount++] = *it;
+			// Widen ASCII runs directly, only decoding other codepoints
+			std::size_t asciiLength = ComputeAsciiLength(ptr, ptr + std::min<std::size_t>(end - ptr, buffer.size() - charCount));
+			for (std::size_t i = 0; i < asciiLength; ++i)
+				buffer[charCount++] = static_cast<char32_t>(ptr[i]);
+
+			ptr += asciiLength;
+
+			if (charCount < buffer.size() && ptr < end)
+				buffer[charCount++] = utf8::unchecked::next(ptr);
+
 			if (charCount == buffer.size())
 			{
 				if (!callback(&buffer[0], charCount))
@@ -282,6 +367,28 @@ namespace Nz
 			callback(&buffer[0], charCount);
 	}
 
+	/*!
+	* \brief Checks if a string is valid UTF-8
+	* \return True if the string only contains well-formed UTF-8 sequences (no overlong encoding, surrogate or out of range codepoint)
+	*
+	* \param str String to check
+	*/
+	bool IsValidUtf8(std::string_view str)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		const char* ptr = str.data();
+		const char* end = ptr + str.size();
+		while (ptr < end)
+		{
+			ptr += ComputeAsciiLength(ptr, end);
+			if (ptr < end && utf8::internal::validate_next(ptr, end) != utf8::internal::UTF8_OK)
+				return false;
+		}
+
+		return true;
+	}
+
 	bool MatchPattern(std::string_view str, std::string_view pattern)
 	{
 		if (str.empty() || pattern.empty())
@@ -503,8 +610,21 @@ namespace Nz
 
 	std::u32string ToUtf32String(std::string_view str)
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		const char* ptr = str.data();
+		const char* end = ptr + str.size();
+
 		std::u32string result;
-		utf8::utf8to32(str.begin(), str.end(), std::back_inserter(result));
+		while (ptr < end)
+		{
+			std::size_t asciiLength = ComputeAsciiLength(ptr, end);
+			result.append(ptr, ptr + asciiLength);
+			ptr += asciiLength;
+
+			if (ptr < end)
+				result.push_back(utf8::next(ptr, end));
+		}
 
 		return result;
 	}
@@ -5,18 +5,117 @@
 #include <Nazara/Core/Systems/LifetimeSystem.hpp>
 #include <Nazara/Core/Components/DisabledComponent.hpp>
 #include <Nazara/Core/Components/LifetimeComponent.hpp>
+#include <algorithm>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
 {
+	LifetimeSystem::LifetimeSystem(entt::registry& registry) :
+	m_registry(registry),
+	m_currentTime(Time::Zero())
+	{
+		m_disabledConstructConnection = registry.on_construct<DisabledComponent>().connect<&LifetimeSystem::OnDisabledConstruct>(this);
+		m_disabledDestroyConnection = registry.on_destroy<DisabledComponent>().connect<&LifetimeSystem::OnDisabledDestroy>(this);
+		m_lifetimeConstructConnection = registry.on_construct<LifetimeComponent>().connect<&LifetimeSystem::OnLifetimeUpdate>(this);
+		m_lifetimeDestroyConnection = registry.on_destroy<LifetimeComponent>().connect<&LifetimeSystem::OnLifetimeDestroy>(this);
+		m_lifetimeUpdateConnection = registry.on_update<LifetimeComponent>().connect<&LifetimeSystem::OnLifetimeUpdate>(this);
+
+		for (auto [entity, lifetimeComponent] : registry.view<LifetimeComponent>(entt::exclude<DisabledComponent>).each())
+			Schedule(entity, lifetimeComponent);
+	}
+
+	LifetimeSystem::~LifetimeSystem()
+	{
+		// Components must not reference our clock once we're gone
+		for (auto [entity, lifetimeComponent] : m_registry.view<LifetimeComponent>().each())
+		{
+			if (lifetimeComponent.m_systemTime == &m_currentTime)
+			{
+				lifetimeComponent.m_lifetime = lifetimeComponent.GetRemainingLifeTime();
+				lifetimeComponent.m_systemTime = nullptr;
+			}
+		}
+	}
+
 	void LifetimeSystem::Update(Time elapsedTime)
 	{
-		auto view = m_registry.view<LifetimeComponent>(entt::exclude<DisabledComponent>);
-		for (auto [entity, lifetimeComponent] : view.each())
+		m_currentTime += elapsedTime;
+
+		m_timerWheel.Advance(ToWheelTime(m_currentTime, false), [&](std::size_t timerId)
+		{
+			// Lifetimes longer than the wheel range (or extended without a patch) fire early
+			entt::entity entity = m_timerEntities[timerId];
+			LifetimeComponent& lifetimeComponent = m_registry.get<LifetimeComponent>(entity);
+			if (lifetimeComponent.GetRemainingLifeTime() > Time::Zero())
+			{
+				Schedule(entity, lifetimeComponent);
+				return;
+			}
+
+			m_expiredEntities.push_back(m_timerEntities[timerId]);
+		});
+
+		if (!m_expiredEntities.empty())
+		{
+			m_registry.destroy(m_expiredEntities.begin(), m_expiredEntities.end());
+			m_expiredEntities.clear();
+		}
+	}
+
+	void LifetimeSystem::OnDisabledConstruct(entt::registry& registry, entt::entity entity)
+	{
+		LifetimeComponent* lifetimeComponent = registry.try_get<LifetimeComponent>(entity);
+		if (!lifetimeComponent)
+			return;
+
+		// Disabled entities don't age, remember how long they had left
+		std::size_t timerId = entt::to_entity(entity);
+		if (timerId < m_timerEntities.size() && m_timerEntities[timerId] == entity && m_timerWheel.IsScheduled(timerId))
+		{
+			lifetimeComponent->m_lifetime = lifetimeComponent->GetRemainingLifeTime();
+			lifetimeComponent->m_systemTime = nullptr;
+			m_timerWheel.Cancel(timerId);
+		}
+	}
+
+	void LifetimeSystem::OnDisabledDestroy(entt::registry& registry, entt::entity entity)
+	{
+		if (LifetimeComponent* lifetimeComponent = registry.try_get<LifetimeComponent>(entity))
+			Schedule(entity, *lifetimeComponent);
+	}
+
+	void LifetimeSystem::OnLifetimeDestroy(entt::registry& /*registry*/, entt::entity entity)
+	{
+		std::size_t timerId = entt::to_entity(entity);
+		if (timerId < m_timerEntities.size() && m_timerEntities[timerId] == entity)
+			m_timerWheel.Cancel(timerId);
+	}
+
+	void LifetimeSystem::OnLifetimeUpdate(entt::registry& registry, entt::entity entity)
+	{
+		if (registry.all_of<DisabledComponent>(entity))
+			return;
+
+		Schedule(entity, registry.get<LifetimeComponent>(entity));
+	}
+
+	void LifetimeSystem::Schedule(entt::entity entity, LifetimeComponent& lifetimeComponent)
+	{
+		// Entity indices are unique among alive entities, use them as timer identifiers
+		std::size_t timerId = entt::to_entity(entity);
+		if (timerId >= m_timerEntities.size())
 		{
-			lifetimeComponent.DecreaseLifetime(elapsedTime);
-			if (!lifetimeComponent.IsAlive())
-				m_registry.destroy(entity);
+			std::size_t timerCount = std::max(timerId + 1, m_timerEntities.size() * 2);
+			m_timerEntities.resize(timerCount, entt::null);
+			m_timerWheel.Resize(timerCount);
 		}
+
+		// Store the expiration time in the component, so its remaining lifetime follows our clock
+		Time expirationTime = m_currentTime + lifetimeComponent.GetRemainingLifeTime();
+		lifetimeComponent.m_lifetime = expirationTime;
+		lifetimeComponent.m_systemTime = &m_currentTime;
+
+		m_timerEntities[timerId] = entity;
+		m_timerWheel.Schedule(timerId, ToWheelTime(expirationTime, true));
 	}
 }
@@ -5,139 +5,373 @@
 #include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Core/Core.hpp>
 #include <Nazara/Core/Error.hpp>
-
-#if defined(NAZARA_PLATFORM_WINDOWS)
-	#include <Nazara/Core/Win32/TaskSchedulerImpl.hpp>
-#elif defined(NAZARA_PLATFORM_POSIX)
-	#include <Nazara/Core/Posix/TaskSchedulerImpl.hpp>
-#else
-	#error Lack of implementation: Task Scheduler
-#endif
-
+#include <Nazara/Core/ThreadExt.hpp>
+#include <deque>
+#include <exception>
+#include <string>
+#include <thread>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
 {
-	namespace
+	namespace NAZARA_ANONYMOUS_NAMESPACE
 	{
-		std::vector<Functor*> s_pendingWorks;
-		unsigned int s_workerCount = 0;
+		thread_local TaskScheduler* s_currentScheduler = nullptr;
+		thread_local unsigned int s_currentWorkerIndex = TaskScheduler::InvalidWorkerIndex;
 	}
 
+	struct TaskScheduler::TaskData
+	{
+		Task func;
+		std::atomic_bool isFinished = false;
+		std::exception_ptr exception; //< set before isFinished if the task threw
+		std::atomic_uint remainingDependencies = 1; //< starts at one to prevent scheduling while dependencies are being registered
+		unsigned int preferredWorkerIndex = InvalidWorkerIndex;
+		std::mutex continuationMutex;
+		std::vector<std::shared_ptr<TaskData>> continuations;
+	};
+
+	struct TaskScheduler::Worker
+	{
+		std::deque<std::shared_ptr<TaskData>> tasks;
+		std::mutex mutex;
+		std::thread thread;
+	};
+
 	/*!
 	* \ingroup core
 	* \class Nz::TaskScheduler
-	* \brief Core class that represents a pool of threads
+	* \brief Core class that represents a work-stealing pool of threads
+	*
+	* Each worker owns its own task queue, tasks spawned from a worker are pushed to its queue (and processed LIFO for locality)
+	* while idle workers steal tasks from the other queues (FIFO), this way there is no global lock to fight over.
 	*
-	* \remark Initialized should be called first
+	* Tasks can depend on other tasks, in which case they will only be scheduled once all of their dependencies are finished.
+	* Waiting on a task (or for all tasks to finish) makes the calling thread run pending tasks instead of simply blocking.
+	*
+	* A task throwing an exception is still considered finished (its dependents are run), the exception is rethrown by WaitFor.
 	*/
 
 	/*!
-	* \brief Gets the number of threads
-	* \return Number of threads, if none, the number of logical threads on the processor is returned
+	* \brief Starts the worker threads
+	*
+	* \param workerCount Number of workers to spawn, zero means the number of logical threads on the processor
 	*/
-
-	unsigned int TaskScheduler::GetWorkerCount()
+	TaskScheduler::TaskScheduler(unsigned int workerCount) :
+	m_running(true),
+	m_pendingTaskCount(0),
+	m_queuedTaskCount(0),
+	m_nextWorkerIndex(0),
+	m_sleepingWorkerCount(0)
 	{
-		return (s_workerCount > 0) ? s_workerCount : Core::Instance()->GetHardwareInfo().GetCpuThreadCount();
+		if (workerCount == 0)
+			workerCount = std::max(Core::Instance()->GetHardwareInfo().GetCpuThreadCount(), 1u);
+
+		m_workers.reserve(workerCount);
+		for (unsigned int i = 0; i < workerCount; ++i)
+			m_workers.push_back(std::make_unique<Worker>());
+
+		// Start threads only once every worker exists as they may start stealing from each other right away
+		for (unsigned int i = 0; i < workerCount; ++i)
+		{
+			Worker& worker = *m_workers[i];
+			worker.thread = std::thread(&TaskScheduler::WorkerProc, this, i);
+			SetThreadName(worker.thread, ("NzWorker #" + std::to_string(i)).c_str());
+		}
 	}
 
 	/*!
-	* \brief Initializes the TaskScheduler class
-	* \return true if everything is ok
+	* \brief Waits for every task to finish before stopping workers
 	*/
+	TaskScheduler::~TaskScheduler()
+	{
+		WaitForTasks();
+
+		{
+			std::unique_lock lock(m_sleepMutex);
+			m_running = false;
+		}
+		m_sleepCondition.notify_all();
 
-	bool TaskScheduler::Initialize()
+		for (auto& workerPtr : m_workers)
+			workerPtr->thread.join();
+	}
+
+	/*!
+	* \brief Adds a task to the scheduler
+	* \return Handle to the task, which can be used to wait for it or as a dependency of another task
+	*
+	* \param task Function to call
+	*/
+	auto TaskScheduler::AddTask(Task&& task) -> TaskHandle
 	{
-		return TaskSchedulerImpl::Initialize(GetWorkerCount());
+		return AddTask(std::move(task), nullptr, 0);
 	}
 
 	/*!
-	* \brief Runs the pending works
+	* \brief Adds a task to the scheduler which will only be run once all its dependencies are finished
+	* \return Handle to the task, which can be used to wait for it or as a dependency of another task
 	*
-	* \remark Produce a NazaraError if the class is not initialized
+	* \param task Function to call
+	* \param dependencies Tasks that have to finish before this one is run, invalid handles are ignored
 	*/
+	auto TaskScheduler::AddTask(Task&& task, std::initializer_list<TaskHandle> dependencies) -> TaskHandle
+	{
+		return AddTask(std::move(task), dependencies.begin(), dependencies.size());
+	}
 
-	void TaskScheduler::Run()
+	/*!
+	* \brief Adds a task to the scheduler which will only be run once all its dependencies are finished
+	* \return Handle to the task, which can be used to wait for it or as a dependency of another task
+	*
+	* \param task Function to call
+	* \param dependencies Pointer to an array of tasks that have to finish before this one is run, invalid handles are ignored
+	* \param dependencyCount Number of dependencies
+	*/
+	auto TaskScheduler::AddTask(Task&& task, const TaskHandle* dependencies, std::size_t dependencyCount) -> TaskHandle
 	{
-		if (!Initialize())
-		{
-			NazaraError("Failed to initialize Task Scheduler");
-			return;
-		}
+		NazaraAssert(dependencies || dependencyCount == 0, "invalid dependencies");
 
-		if (!s_pendingWorks.empty())
+		std::shared_ptr<TaskData> taskData = std::make_shared<TaskData>();
+		taskData->func = std::move(task);
+
+		m_pendingTaskCount++;
+
+		for (std::size_t i = 0; i < dependencyCount; ++i)
 		{
-			TaskSchedulerImpl::Run(&s_pendingWorks[0], s_pendingWorks.size());
-			s_pendingWorks.clear();
+			TaskData* dependency = dependencies[i].m_data.get();
+			if (!dependency)
+				continue;
+
+			std::unique_lock lock(dependency->continuationMutex);
+			if (dependency->isFinished)
+				continue;
+
+			taskData->remainingDependencies++;
+			dependency->continuations.push_back(taskData);
 		}
+
+		// Release the registration reference, the last finished dependency will schedule it otherwise
+		if (--taskData->remainingDependencies == 0)
+			Schedule(taskData);
+
+		return TaskHandle(std::move(taskData));
 	}
 
 	/*!
-	* \brief Sets the number of workers
+	* \brief Adds a task to the queue of a specific worker
+	* \return Handle to the task, which can be used to wait for it or as a dependency of another task
 	*
-	* \param workerCount Number of simulatnous threads handling the tasks
+	* Pushing related tasks to the same worker each time keeps their data in that worker's cache.
+	* This is only a preference: if the worker is busy, the task can still be stolen by an idle worker.
 	*
-	* \remark Produce a NazaraError if the class is not initialized and NAZARA_CORE_SAFE is defined
+	* \param task Function to call
+	* \param workerIndex Index of the worker which should run the task, wrapped around the worker count
 	*/
+	auto TaskScheduler::AddTaskOnWorker(Task&& task, unsigned int workerIndex) -> TaskHandle
+	{
+		std::shared_ptr<TaskData> taskData = std::make_shared<TaskData>();
+		taskData->func = std::move(task);
+		taskData->preferredWorkerIndex = workerIndex % GetWorkerCount();
+		taskData->remainingDependencies = 0;
+
+		m_pendingTaskCount++;
+		Schedule(taskData);
+
+		return TaskHandle(std::move(taskData));
+	}
 
-	void TaskScheduler::SetWorkerCount(unsigned int workerCount)
+	/*!
+	* \brief Waits for a task to finish, running other tasks in the meantime
+	*
+	* \param handle Handle to the task to wait for
+	*
+	* \remark If the task threw an exception, it is rethrown by this function
+	*/
+	void TaskScheduler::WaitFor(const TaskHandle& handle)
 	{
-		#ifdef NAZARA_CORE_SAFE
-		if (TaskSchedulerImpl::IsInitialized())
-		{
-			NazaraError("Worker count cannot be set while initialized");
+		if (!handle.IsValid())
 			return;
+
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		unsigned int workerIndex = (s_currentScheduler == this) ? s_currentWorkerIndex : 0;
+		while (!handle.IsFinished())
+		{
+			if (!TryRunTask(workerIndex))
+				std::this_thread::yield(); //< the task we're waiting for is running on another thread
 		}
-		#endif
 
-		s_workerCount = workerCount;
+		if (handle.m_data->exception)
+			std::rethrow_exception(handle.m_data->exception);
 	}
 
 	/*!
-	* \brief Uninitializes the TaskScheduler class
+	* \brief Waits for every task to finish, running tasks in the meantime
+	*
+	* \remark Calling this from a task of the same scheduler will deadlock
+	* \remark Exceptions thrown by tasks are not rethrown by this function, use WaitFor to retrieve them
 	*/
-
-	void TaskScheduler::Uninitialize()
+	void TaskScheduler::WaitForTasks()
 	{
-		if (TaskSchedulerImpl::IsInitialized())
-			TaskSchedulerImpl::Uninitialize();
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		NazaraAssert(s_currentScheduler != this, "WaitForTasks cannot be called from a worker of the same scheduler");
+
+		while (m_pendingTaskCount > 0)
+		{
+			if (TryRunTask(0))
+				continue;
+
+			// Nothing left to steal, remaining tasks are running on workers (which will handle their continuations)
+			std::unique_lock lock(m_idleMutex);
+			m_idleCondition.wait(lock, [&] { return m_pendingTaskCount == 0; });
+		}
 	}
 
 	/*!
-	* \brief Waits for tasks to be done
+	* \brief Returns the index of the worker running the current thread
+	* \return Worker index or InvalidWorkerIndex if the current thread is not a worker
 	*
-	* \remark Produce a NazaraError if the class is not initialized
+	* This can be used to index per-worker data without synchronization.
 	*/
+	unsigned int TaskScheduler::GetCurrentWorkerIndex()
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
 
-	void TaskScheduler::WaitForTasks()
+		return s_currentWorkerIndex;
+	}
+
+	void TaskScheduler::RunTask(std::shared_ptr<TaskData> task)
 	{
-		if (!Initialize())
+		// An exception must not leave the task unfinished, it would never release its dependents nor the pending task count
+		std::exception_ptr exception;
+		try
 		{
-			NazaraError("Failed to initialize Task Scheduler");
-			return;
+			task->func();
+		}
+		catch (...)
+		{
+			exception = std::current_exception();
+		}
+		task->func = nullptr; //< release captured resources as soon as possible
+
+		std::vector<std::shared_ptr<TaskData>> continuations;
+		{
+			std::unique_lock lock(task->continuationMutex);
+			task->exception = std::move(exception);
+			task->isFinished = true;
+			continuations = std::move(task->continuations);
+		}
+
+		for (std::shared_ptr<TaskData>& continuation : continuations)
+		{
+			if (--continuation->remainingDependencies == 0)
+				Schedule(std::move(continuation));
 		}
 
-		TaskSchedulerImpl::WaitForTasks();
+		if (--m_pendingTaskCount == 0)
+		{
+			std::unique_lock lock(m_idleMutex);
+			m_idleCondition.notify_all();
+		}
 	}
 
-	/*!
-	* \brief Adds a task on the pending list
-	*
-	* \param taskFunctor Functor represeting a task to be done
-	*
-	* \remark Produce a NazaraError if the class is not initialized
-	* \remark A task containing a call on this class is undefined behaviour
-	*/
+	void TaskScheduler::Schedule(std::shared_ptr<TaskData> task)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		// Tasks spawned from a worker are pushed to its own queue, others are distributed between workers
+		unsigned int workerIndex;
+		if (task->preferredWorkerIndex != InvalidWorkerIndex)
+			workerIndex = task->preferredWorkerIndex;
+		else if (s_currentScheduler == this)
+			workerIndex = s_currentWorkerIndex;
+		else
+			workerIndex = m_nextWorkerIndex++ % m_workers.size();
+
+		Worker& worker = *m_workers[workerIndex];
+		{
+			std::unique_lock lock(worker.mutex);
+			worker.tasks.push_back(std::move(task));
+		}
+
+		m_queuedTaskCount++;
+
+		// Only take the lock if a worker may be sleeping (which implies it checked m_queuedTaskCount before we incremented it)
+		if (m_sleepingWorkerCount > 0)
+		{
+			{
+				std::unique_lock lock(m_sleepMutex);
+			}
+			m_sleepCondition.notify_one();
+		}
+	}
 
-	void TaskScheduler::AddTaskFunctor(Functor* taskFunctor)
+	bool TaskScheduler::TryRunTask(unsigned int workerIndex)
 	{
-		if (!Initialize())
+		if (m_queuedTaskCount == 0)
+			return false;
+
+		std::shared_ptr<TaskData> task;
+
+		// Pop from our own queue first (LIFO for cache locality) then steal from others (FIFO, oldest tasks are usually the biggest)
+		unsigned int workerCount = GetWorkerCount();
+		for (unsigned int i = 0; i < workerCount; ++i)
 		{
-			NazaraError("Failed to initialize Task Scheduler");
-			return;
+			unsigned int victimIndex = (workerIndex + i) % workerCount;
+			Worker& worker = *m_workers[victimIndex];
+
+			std::unique_lock lock(worker.mutex);
+			if (worker.tasks.empty())
+				continue;
+
+			if (i == 0)
+			{
+				task = std::move(worker.tasks.back());
+				worker.tasks.pop_back();
+			}
+			else
+			{
+				task = std::move(worker.tasks.front());
+				worker.tasks.pop_front();
+			}
+			break;
+		}
+
+		if (!task)
+			return false;
+
+		m_queuedTaskCount--;
+		RunTask(std::move(task));
+
+		return true;
+	}
+
+	void TaskScheduler::WorkerProc(unsigned int workerIndex)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		s_currentScheduler = this;
+		s_currentWorkerIndex = workerIndex;
+
+		while (m_running)
+		{
+			if (TryRunTask(workerIndex))
+				continue;
+
+			std::unique_lock lock(m_sleepMutex);
+			m_sleepingWorkerCount++;
+			m_sleepCondition.wait(lock, [&] { return !m_running || m_queuedTaskCount > 0; });
+			m_sleepingWorkerCount--;
 		}
 
-		s_pendingWorks.push_back(taskFunctor);
+		s_currentScheduler = nullptr;
+		s_currentWorkerIndex = InvalidWorkerIndex;
+	}
+
+	bool TaskScheduler::TaskHandle::IsFinished() const
+	{
+		return !m_data || m_data->isFinished;
 	}
 }
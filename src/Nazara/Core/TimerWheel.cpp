@@ -0,0 +1,247 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/TimerWheel.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <cassert>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::TimerWheel
+	* \brief Core class that tracks a fixed set of timers and reports the ones whose deadline passed
+	*
+	* Timers are identified by their index and each one has at most one pending deadline, expressed as a wrapping
+	* time in milliseconds. Scheduling and cancelling a timer are constant time, and advancing the wheel costs one step
+	* per elapsed millisecond (skipped while no timer is scheduled) plus the timers it fires.
+	*
+	* Deadlines are stored in a hierarchy of four wheels (256 slots of 1ms, then 64 slots of 256ms, 16s and 17min),
+	* timers are moved to the lower wheel when its current revolution reaches their slot.
+	*/
+
+	/*!
+	* \brief Constructs a timer wheel
+	*
+	* \param timerCount Number of timers, all of them start unscheduled
+	* \param currentTime Time of the wheel, subsequent deadlines are relative to this
+	*/
+	TimerWheel::TimerWheel(std::size_t timerCount, UInt32 currentTime)
+	{
+		Reset(timerCount, currentTime);
+	}
+
+	/*!
+	* \brief Advances the wheel to a time, calling a callback for every timer whose deadline passed
+	*
+	* Fired timers are unscheduled before the callback is called, which is free to schedule or cancel any timer.
+	* Timers scheduled from the callback with a deadline which already passed will only fire on the next call.
+	*
+	* \param currentTime New time of the wheel, nothing happens if it's older than the wheel time
+	* \param callback Callback called with the identifier of every fired timer
+	*/
+	void TimerWheel::Advance(UInt32 currentTime, const FunctionRef<void(std::size_t timerId)>& callback)
+	{
+		UInt32 elapsedTime = currentTime - m_currentTime;
+		if (elapsedTime > std::numeric_limits<Int32>::max())
+			return;
+
+		Fire(DueSlot, callback);
+
+		constexpr UInt32 FirstLevelMask = (1u << FirstLevelBits) - 1;
+
+		while (m_currentTime != currentTime)
+		{
+			if (m_scheduledTimerCount == 0)
+			{
+				m_currentTime = currentTime;
+				break;
+			}
+
+			m_currentTime++;
+
+			// Move timers of the higher wheels down when the lower ones complete a revolution
+			if ((m_currentTime & FirstLevelMask) == 0)
+			{
+				for (std::size_t level = LevelCount - 1; level > 0; --level)
+				{
+					std::size_t shift = FirstLevelBits + (level - 1) * LevelBits;
+					if ((m_currentTime & ((UInt32(1) << shift) - 1)) != 0)
+						continue;
+
+					std::size_t slotIndex = (1 << FirstLevelBits) + (level - 1) * (1 << LevelBits) + ((m_currentTime >> shift) & ((1 << LevelBits) - 1));
+
+					std::size_t timerId = m_slots[slotIndex];
+					m_slots[slotIndex] = InvalidIndex;
+
+					while (timerId != InvalidIndex)
+					{
+						std::size_t nextTimerId = m_timers[timerId].next;
+						Insert(timerId);
+
+						timerId = nextTimerId;
+					}
+				}
+			}
+
+			Fire(m_currentTime & FirstLevelMask, callback);
+		}
+	}
+
+	/*!
+	* \brief Unschedules a timer
+	*
+	* \param timerId Timer to unschedule, nothing happens if it wasn't scheduled
+	*/
+	void TimerWheel::Cancel(std::size_t timerId)
+	{
+		NazaraAssert(timerId < m_timers.size(), "invalid timer");
+
+		if (m_timers[timerId].slot == InvalidIndex)
+			return;
+
+		Unlink(timerId);
+		m_scheduledTimerCount--;
+	}
+
+	/*!
+	* \brief Resets the wheel, unscheduling every timer
+	*
+	* \param timerCount New number of timers
+	* \param currentTime New time of the wheel
+	*/
+	void TimerWheel::Reset(std::size_t timerCount, UInt32 currentTime)
+	{
+		m_slots.fill(InvalidIndex);
+		m_timers.clear();
+		m_timers.resize(timerCount);
+		m_scheduledTimerCount = 0;
+		m_currentTime = currentTime;
+	}
+
+	/*!
+	* \brief Adds timers to the wheel, keeping the scheduled ones
+	*
+	* \param timerCount New number of timers, which can't be lower than the current one
+	*/
+	void TimerWheel::Resize(std::size_t timerCount)
+	{
+		NazaraAssert(timerCount >= m_timers.size(), "timers cannot be removed");
+
+		m_timers.resize(timerCount);
+	}
+
+	/*!
+	* \brief Schedules a timer, replacing its previous deadline if it had one
+	*
+	* \param timerId Timer to schedule
+	* \param deadline Time at which the timer fires, a deadline which already passed fires on the next call to Advance.
+	*        Deadlines further than MaxDelay are clamped.
+	*/
+	void TimerWheel::Schedule(std::size_t timerId, UInt32 deadline)
+	{
+		NazaraAssert(timerId < m_timers.size(), "invalid timer");
+
+		Timer& timer = m_timers[timerId];
+		if (timer.slot != InvalidIndex)
+			Unlink(timerId);
+		else
+			m_scheduledTimerCount++;
+
+		UInt32 delay = deadline - m_currentTime;
+		if (delay == 0 || delay > std::numeric_limits<Int32>::max())
+		{
+			timer.deadline = deadline;
+			Link(timerId, DueSlot);
+			return;
+		}
+
+		timer.deadline = (delay > MaxDelay) ? m_currentTime + MaxDelay : deadline;
+		Insert(timerId);
+	}
+
+	void TimerWheel::Fire(std::size_t slotIndex, const FunctionRef<void(std::size_t timerId)>& callback)
+	{
+		if (m_slots[slotIndex] == InvalidIndex)
+			return;
+
+		// Isolate the fired timers, so callbacks can freely reschedule them (even in the same slot)
+		MoveSlot(slotIndex, FiringSlot);
+
+		while (m_slots[FiringSlot] != InvalidIndex)
+		{
+			std::size_t timerId = m_slots[FiringSlot];
+			Unlink(timerId);
+			m_scheduledTimerCount--;
+
+			callback(timerId);
+		}
+	}
+
+	void TimerWheel::Insert(std::size_t timerId)
+	{
+		UInt32 deadline = m_timers[timerId].deadline;
+		UInt32 delay = deadline - m_currentTime;
+		assert(delay <= MaxDelay);
+
+		if (delay < (1u << FirstLevelBits))
+		{
+			Link(timerId, deadline & ((1u << FirstLevelBits) - 1));
+			return;
+		}
+
+		std::size_t level = 1;
+		std::size_t shift = FirstLevelBits;
+		while (level < LevelCount - 1 && delay >= (UInt32(1) << (shift + LevelBits)))
+		{
+			level++;
+			shift += LevelBits;
+		}
+
+		Link(timerId, (1 << FirstLevelBits) + (level - 1) * (1 << LevelBits) + ((deadline >> shift) & ((1 << LevelBits) - 1)));
+	}
+
+	void TimerWheel::Link(std::size_t timerId, std::size_t slotIndex)
+	{
+		Timer& timer = m_timers[timerId];
+		timer.previous = InvalidIndex;
+		timer.next = m_slots[slotIndex];
+		timer.slot = slotIndex;
+
+		if (timer.next != InvalidIndex)
+			m_timers[timer.next].previous = timerId;
+
+		m_slots[slotIndex] = timerId;
+	}
+
+	void TimerWheel::MoveSlot(std::size_t fromSlot, std::size_t toSlot)
+	{
+		assert(m_slots[toSlot] == InvalidIndex);
+
+		for (std::size_t timerId = m_slots[fromSlot]; timerId != InvalidIndex; timerId = m_timers[timerId].next)
+			m_timers[timerId].slot = toSlot;
+
+		m_slots[toSlot] = m_slots[fromSlot];
+		m_slots[fromSlot] = InvalidIndex;
+	}
+
+	void TimerWheel::Unlink(std::size_t timerId)
+	{
+		Timer& timer = m_timers[timerId];
+		assert(timer.slot != InvalidIndex);
+
+		if (timer.previous != InvalidIndex)
+			m_timers[timer.previous].next = timer.next;
+		else
+			m_slots[timer.slot] = timer.next;
+
+		if (timer.next != InvalidIndex)
+			m_timers[timer.next].previous = timer.previous;
+
+		timer.next = InvalidIndex;
+		timer.previous = InvalidIndex;
+		timer.slot = InvalidIndex;
+	}
+}
@@ -0,0 +1,65 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/TimingStats.hpp>
+#include <Nazara/Core/Format.hpp>
+#include <algorithm>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Returns the average duration of the last samples
+	* \return Average duration over the last WindowSize samples (or less if fewer were added)
+	*/
+	Time TimingStats::GetAverageDuration() const
+	{
+		std::size_t windowSampleCount = static_cast<std::size_t>(std::min<UInt64>(m_sampleCount, WindowSize));
+		if (windowSampleCount == 0)
+			return Time::Zero();
+
+		return Time::Nanoseconds(m_windowSum / static_cast<Int64>(windowSampleCount));
+	}
+
+	/*!
+	* \brief Returns the longest duration of the last samples
+	* \return Max duration over the last WindowSize samples (or less if fewer were added)
+	*/
+	Time TimingStats::GetMaxDuration() const
+	{
+		std::size_t windowSampleCount = static_cast<std::size_t>(std::min<UInt64>(m_sampleCount, WindowSize));
+		if (windowSampleCount == 0)
+			return Time::Zero();
+
+		return Time::Nanoseconds(*std::max_element(m_window.begin(), m_window.begin() + windowSampleCount));
+	}
+
+	/*!
+	* \brief Clears every sample, the budget is kept
+	*/
+	void TimingStats::Reset()
+	{
+		m_histogram.fill(0);
+		m_window.fill(0);
+		m_windowSum = 0;
+		m_lastDuration = Time::Zero();
+		m_peakDuration = Time::Zero();
+		m_overBudgetCount = 0;
+		m_sampleCount = 0;
+	}
+
+	/*!
+	* \brief Formats the statistics on a single line, for logging
+	*/
+	std::string TimingStats::ToString() const
+	{
+		auto ToMilliseconds = [](Time time) { return time.AsSeconds<double>() * 1000.0; };
+
+		std::string str = Format("avg {0:.3f}ms, max {1:.3f}ms, peak {2:.3f}ms, last {3:.3f}ms ({4} samples)", ToMilliseconds(GetAverageDuration()), ToMilliseconds(GetMaxDuration()), ToMilliseconds(m_peakDuration), ToMilliseconds(m_lastDuration), m_sampleCount);
+		if (m_budget > Time::Zero())
+			str += Format(", {0} over the {1:.3f}ms budget", m_overBudgetCount, ToMilliseconds(m_budget));
+
+		return str;
+	}
+}
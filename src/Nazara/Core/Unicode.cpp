@@ -5,7 +5,13 @@
 #include <Nazara/Core/Unicode.hpp>
 #include <Nazara/Core/Config.hpp>
 #include <algorithm>
+#include <array>
+#include <cassert>
 #include <iterator>
+#include <limits>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 #include <Nazara/Core/Debug.hpp>
 
 #if NAZARA_CORE_INCLUDE_UNICODEDATA
@@ -35,24 +41,82 @@ namespace Nz
 
 	namespace NAZARA_ANONYMOUS_NAMESPACE
 	{
-		const UnicodeCharacter* GetCharacter(Nz::UInt32 codepoint)
+		// Two-level lookup table of character properties: codepoints are split in blocks of 256, identical blocks (most of them) being shared
+		class CharacterPropertyTable
 		{
-			auto it = std::lower_bound(std::begin(unicodeCharacters), std::end(unicodeCharacters), codepoint, [](const UnicodeCharacter& character, Nz::UInt32 otherCodepoint) { return character.codepoint < otherCodepoint; });
-			if (it != std::end(unicodeCharacters) && it->codepoint == codepoint)
-				return &*it;
-			else
-			{
-				// Character is not part of the common character array, search in set
-				auto itSet = std::lower_bound(std::begin(unicodeSets), std::end(unicodeSets), codepoint, [](const UnicodeSet& character, Nz::UInt32 otherCodepoint) { return character.firstCodepoint < otherCodepoint; });
-				if (itSet != std::begin(unicodeSets))
+			public:
+				CharacterPropertyTable()
+				{
+					// Properties of codepoints absent from the Unicode data
+					m_properties.push_back({ 0, Unicode::Category_NoCategory, Unicode::Direction_Boundary_Neutral });
+
+					std::unordered_map<UInt32, UInt8> propertyIndices;
+					auto GetPropertyIndex = [&](const UnicodeCharacter& character) -> UInt8
+					{
+						UInt32 key = (UInt32(character.category) << 8) | UInt32(character.direction);
+						auto it = propertyIndices.find(key);
+						if (it == propertyIndices.end())
+						{
+							assert(m_properties.size() <= std::numeric_limits<UInt8>::max());
+							it = propertyIndices.emplace(key, UInt8(m_properties.size())).first;
+							m_properties.push_back({ 0, character.category, character.direction });
+						}
+
+						return it->second;
+					};
+
+					std::vector<UInt8> codepointProperties(MaxCodepoint + 1, 0);
+
+					// Characters take precedence over sets
+					for (const UnicodeSet& set : unicodeSets)
+						std::fill(codepointProperties.begin() + set.firstCodepoint, codepointProperties.begin() + set.lastCodepoint + 1, GetPropertyIndex(set.character));
+
+					for (const UnicodeCharacter& character : unicodeCharacters)
+						codepointProperties[character.codepoint] = GetPropertyIndex(character);
+
+					std::unordered_map<std::string_view, UInt16> blockIndices;
+					for (std::size_t i = 0; i < m_blockIndices.size(); ++i)
+					{
+						std::string_view block(reinterpret_cast<const char*>(&codepointProperties[i * BlockSize]), BlockSize);
+
+						auto it = blockIndices.find(block);
+						if (it == blockIndices.end())
+						{
+							UInt16 blockIndex = UInt16(m_blocks.size() / BlockSize);
+							m_blocks.insert(m_blocks.end(), block.begin(), block.end());
+
+							// Reference the codepoint properties vector, which outlives the map
+							it = blockIndices.emplace(block, blockIndex).first;
+						}
+
+						m_blockIndices[i] = it->second;
+					}
+
+					m_blocks.shrink_to_fit();
+				}
+
+				const UnicodeCharacter& Get(UInt32 codepoint) const
 				{
-					--itSet;
-					if (itSet != std::end(unicodeSets) && codepoint >= itSet->firstCodepoint && codepoint <= itSet->lastCodepoint)
-						return &itSet->character;
+					if (codepoint > MaxCodepoint)
+						return m_properties[0];
+
+					return m_properties[m_blocks[m_blockIndices[codepoint / BlockSize] * BlockSize + codepoint % BlockSize]];
 				}
-			}
 
-			return nullptr;
+			private:
+				static constexpr UInt32 BlockSize = 256;
+				static constexpr UInt32 MaxCodepoint = 0x10FFFF;
+
+				std::array<UInt16, (MaxCodepoint + 1) / BlockSize> m_blockIndices;
+				std::vector<UInt8> m_blocks;
+				std::vector<UnicodeCharacter> m_properties;
+		};
+
+		const UnicodeCharacter& GetCharacter(UInt32 codepoint)
+		{
+			// Built on first use from the sorted tables
+			static CharacterPropertyTable propertyTable;
+			return propertyTable.Get(codepoint);
 		}
 
 		template<std::size_t N>
@@ -76,10 +140,7 @@ namespace Nz
 	{
 		NAZARA_USE_ANONYMOUS_NAMESPACE
 
-		if (const UnicodeCharacter* characterData = GetCharacter(character))
-			return characterData->category;
-		else
-			return Category_NoCategory;
+		return GetCharacter(character).category;
 	}
 
 	/*!
@@ -93,10 +154,7 @@ namespace Nz
 	{
 		NAZARA_USE_ANONYMOUS_NAMESPACE
 
-		if (const UnicodeCharacter* characterData = GetCharacter(character))
-			return characterData->direction;
-		else
-			return Direction_Boundary_Neutral;
+		return GetCharacter(character).direction;
 	}
 
 	/*!
@@ -0,0 +1,73 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/VirtualDirectoryArchiveResolver.hpp>
+#include <Nazara/Core/PackedArchive.hpp>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::VirtualDirectoryArchiveResolver
+	* \brief Core class resolving virtual directory entries from a packed archive
+	*
+	* Entries are looked up in the archive table of content, without any system call.
+	*
+	* \remark Compressed entries are decompressed when resolved, iterating over a directory decompresses all its files
+	*/
+
+	void VirtualDirectoryArchiveResolver::ForEach(std::weak_ptr<VirtualDirectory> parent, FunctionRef<bool(std::string_view name, VirtualDirectory::Entry&& entry)> callback) const
+	{
+		m_archive->ForEachDirectoryEntry(m_directoryPath, [&](std::string_view name, const PackedArchive::Entry* fileEntry)
+		{
+			if (fileEntry)
+			{
+				std::shared_ptr<Stream> stream = m_archive->OpenEntry(*fileEntry);
+				if (!stream)
+					return true;
+
+				return callback(name, VirtualDirectory::FileEntry{ std::move(stream) });
+			}
+			else
+			{
+				std::string directoryPath = (!m_directoryPath.empty()) ? m_directoryPath + '/' : std::string{};
+				directoryPath += name;
+
+				return callback(name, VirtualDirectory::DirectoryEntry{ { MakeDirectory(parent, std::move(directoryPath)) } });
+			}
+		});
+	}
+
+	std::optional<VirtualDirectory::Entry> VirtualDirectoryArchiveResolver::Resolve(std::weak_ptr<VirtualDirectory> parent, const std::string_view* parts, std::size_t partCount) const
+	{
+		std::string path = m_directoryPath;
+		for (std::size_t i = 0; i < partCount; ++i)
+		{
+			if (!path.empty())
+				path += '/';
+
+			path += parts[i];
+		}
+
+		// Archives are indexed by path, no need to walk directories
+		if (const PackedArchive::Entry* fileEntry = m_archive->FindEntry(path))
+		{
+			std::shared_ptr<Stream> stream = m_archive->OpenEntry(*fileEntry);
+			if (!stream)
+				return std::nullopt;
+
+			return VirtualDirectory::FileEntry{ std::move(stream) };
+		}
+		else if (m_archive->HasDirectory(path))
+			return VirtualDirectory::DirectoryEntry{ { MakeDirectory(std::move(parent), std::move(path)) } };
+		else
+			return std::nullopt;
+	}
+
+	VirtualDirectoryPtr VirtualDirectoryArchiveResolver::MakeDirectory(std::weak_ptr<VirtualDirectory> parent, std::string directoryPath) const
+	{
+		return std::make_shared<VirtualDirectory>(std::make_shared<VirtualDirectoryArchiveResolver>(m_archive, std::move(directoryPath)), std::move(parent));
+	}
+}
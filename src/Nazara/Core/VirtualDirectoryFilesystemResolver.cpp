@@ -8,46 +8,86 @@
 
 namespace Nz
 {
+	/*!
+	* \ingroup core
+	* \class Nz::VirtualDirectoryFilesystemResolver
+	* \brief Core class resolving virtual directory entries from a physical directory
+	*
+	* Resolved files and directories are cached, so resolving them again doesn't require querying the filesystem.
+	* Files which don't exist are not cached, they can be created at any time.
+	*/
+
 	void VirtualDirectoryFilesystemResolver::ForEach(std::weak_ptr<VirtualDirectory> parent, FunctionRef<bool(std::string_view name, VirtualDirectory::Entry&& entry)> callback) const
 	{
 		for (auto&& physicalEntry : std::filesystem::directory_iterator(m_physicalPath))
 		{
+			bool isDirectory;
+			if (physicalEntry.is_regular_file())
+				isDirectory = false;
+			else if (physicalEntry.is_directory())
+				isDirectory = true;
+			else
+				continue;
+
 			std::string filename = PathToString(physicalEntry.path().filename());
 
-			std::filesystem::file_status status = physicalEntry.status();
+			// Iterating gives us the entry types for free, use it to fill the cache
+			auto it = m_cachedEntries.find(filename);
+			const CachedEntry& cachedEntry = (it != m_cachedEntries.end() && (it->second.directoryResolver != nullptr) == isDirectory) ? it->second : CacheEntry(filename, physicalEntry.path(), isDirectory);
 
-			VirtualDirectory::Entry entry;
-			if (physicalEntry.is_regular_file())
-			{
-				if (!callback(filename, VirtualDirectory::FileEntry{ std::make_shared<File>(physicalEntry.path(), m_fileOpenMode) }))
-					return;
-			}
-			else if (physicalEntry.is_directory())
-			{
-				VirtualDirectoryPtr virtualDir = std::make_shared<VirtualDirectory>(std::make_shared<VirtualDirectoryFilesystemResolver>(physicalEntry.path()), parent);
-				if (!callback(filename, VirtualDirectory::DirectoryEntry{ { std::move(virtualDir) } }))
-					return;
-			}
+			if (!callback(filename, MakeEntry(cachedEntry, parent)))
+				return;
 		}
 	}
 
 	std::optional<VirtualDirectory::Entry> VirtualDirectoryFilesystemResolver::Resolve(std::weak_ptr<VirtualDirectory> parent, const std::string_view* parts, std::size_t partCount) const
 	{
+		std::string relativePath;
+		for (std::size_t i = 0; i < partCount; ++i)
+		{
+			if (i > 0)
+				relativePath += '/';
+
+			relativePath += parts[i];
+		}
+
+		if (auto it = m_cachedEntries.find(relativePath); it != m_cachedEntries.end())
+			return MakeEntry(it->second, std::move(parent));
+
 		std::filesystem::path filePath = m_physicalPath;
 		for (std::size_t i = 0; i < partCount; ++i)
 			filePath /= Utf8Path(parts[i]);
 
 		std::filesystem::file_status status = std::filesystem::status(filePath); //< FIXME: This will follow symlink, is this the intended behavior? (see symlink_status)
 
-		VirtualDirectory::Entry entry;
 		if (std::filesystem::is_regular_file(status))
-			return VirtualDirectory::FileEntry{ std::make_shared<File>(std::move(filePath), m_fileOpenMode) };
+			return MakeEntry(CacheEntry(std::move(relativePath), std::move(filePath), false), std::move(parent));
 		else if (std::filesystem::is_directory(status))
+			return MakeEntry(CacheEntry(std::move(relativePath), std::move(filePath), true), std::move(parent));
+		else
+			return std::nullopt; //< either not known or of a special type
+	}
+
+	auto VirtualDirectoryFilesystemResolver::CacheEntry(std::string relativePath, std::filesystem::path physicalPath, bool isDirectory) const -> const CachedEntry&
+	{
+		CachedEntry cachedEntry;
+		if (isDirectory)
+			cachedEntry.directoryResolver = std::make_shared<VirtualDirectoryFilesystemResolver>(physicalPath, m_fileOpenMode);
+
+		cachedEntry.physicalPath = std::move(physicalPath);
+
+		return m_cachedEntries.insert_or_assign(std::move(relativePath), std::move(cachedEntry)).first->second;
+	}
+
+	VirtualDirectory::Entry VirtualDirectoryFilesystemResolver::MakeEntry(const CachedEntry& cachedEntry, std::weak_ptr<VirtualDirectory> parent) const
+	{
+		if (cachedEntry.directoryResolver)
 		{
-			VirtualDirectoryPtr virtualDir = std::make_shared<VirtualDirectory>(std::make_shared<VirtualDirectoryFilesystemResolver>(std::move(filePath)), parent);
+			// Directories are created on each resolution as their parent may differ, but they share their resolver (and its cache)
+			VirtualDirectoryPtr virtualDir = std::make_shared<VirtualDirectory>(cachedEntry.directoryResolver, std::move(parent));
 			return VirtualDirectory::DirectoryEntry{ { std::move(virtualDir) } };
 		}
 		else
-			return std::nullopt; //< either not known or of a special type
+			return VirtualDirectory::FileEntry{ std::make_shared<File>(cachedEntry.physicalPath, m_fileOpenMode) };
 	}
 }
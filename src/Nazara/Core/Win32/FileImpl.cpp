@@ -7,6 +7,8 @@
 #include <Nazara/Core/StringExt.hpp>
 #include <Nazara/Core/Win32/Utils.hpp>
 #include <NazaraUtils/CallOnExit.hpp>
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <Nazara/Core/Debug.hpp>
 
@@ -135,6 +137,38 @@ namespace Nz
 			return 0;
 	}
 
+	std::size_t FileImpl::ReadAt(UInt64 offset, void* buffer, std::size_t size) const
+	{
+		// The offset is given through an OVERLAPPED structure, making the read atomic with respect to other ReadAt calls
+		// (the file pointer of synchronous handles is still updated, cursor-based reads shouldn't run concurrently)
+		std::size_t totalRead = 0;
+		while (totalRead < size)
+		{
+			UInt64 readOffset = offset + totalRead;
+
+			OVERLAPPED overlapped = {};
+			overlapped.Offset = static_cast<DWORD>(readOffset & 0xFFFFFFFF);
+			overlapped.OffsetHigh = static_cast<DWORD>(readOffset >> 32);
+
+			DWORD readSize = static_cast<DWORD>(std::min<std::size_t>(size - totalRead, std::numeric_limits<DWORD>::max()));
+			DWORD read = 0;
+			if (!ReadFile(m_handle, static_cast<UInt8*>(buffer) + totalRead, readSize, &read, &overlapped))
+			{
+				if (GetLastError() != ERROR_HANDLE_EOF)
+					NazaraError("failed to read file: {0}", Error::GetLastSystemError());
+
+				break;
+			}
+
+			if (read == 0)
+				break; //< end of file
+
+			totalRead += read;
+		}
+
+		return totalRead;
+	}
+
 	bool FileImpl::SetCursorPos(CursorPosition pos, Int64 offset)
 	{
 		DWORD moveMethod;
@@ -30,6 +30,7 @@ namespace Nz
 			UInt64 GetCursorPos() const;
 			bool Open(const std::filesystem::path& filePath, OpenModeFlags mode);
 			std::size_t Read(void* buffer, std::size_t size);
+			std::size_t ReadAt(UInt64 offset, void* buffer, std::size_t size) const;
 			bool SetCursorPos(CursorPosition pos, Int64 offset);
 			bool SetSize(UInt64 size);
 			std::size_t Write(const void* buffer, std::size_t size);
@@ -0,0 +1,119 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Win32/MappedFileImpl.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/StringExt.hpp>
+#include <limits>
+#include <type_traits>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		struct MemoryRangeEntry
+		{
+			PVOID VirtualAddress;
+			SIZE_T NumberOfBytes;
+		};
+
+		// PrefetchVirtualMemory is only available since Windows 8
+		using PrefetchVirtualMemoryFunc = BOOL(WINAPI*)(HANDLE hProcess, ULONG_PTR NumberOfEntries, MemoryRangeEntry* VirtualAddresses, ULONG Flags);
+
+		PrefetchVirtualMemoryFunc GetPrefetchVirtualMemory()
+		{
+			static PrefetchVirtualMemoryFunc prefetchVirtualMemory = []
+			{
+				HMODULE kernel32 = GetModuleHandleW(L"kernel32.dll");
+				return (kernel32) ? reinterpret_cast<PrefetchVirtualMemoryFunc>(reinterpret_cast<void(*)()>(GetProcAddress(kernel32, "PrefetchVirtualMemory"))) : nullptr;
+			}();
+
+			return prefetchVirtualMemory;
+		}
+	}
+
+	MappedFileImpl::MappedFileImpl() :
+	m_fileHandle(INVALID_HANDLE_VALUE),
+	m_mappingHandle(nullptr),
+	m_ptr(nullptr),
+	m_size(0)
+	{
+	}
+
+	MappedFileImpl::~MappedFileImpl()
+	{
+		if (m_ptr)
+			UnmapViewOfFile(m_ptr);
+
+		if (m_mappingHandle)
+			CloseHandle(m_mappingHandle);
+
+		if (m_fileHandle != INVALID_HANDLE_VALUE)
+			CloseHandle(m_fileHandle);
+	}
+
+	bool MappedFileImpl::Open(const std::filesystem::path& filePath, FileAccessPattern accessPattern)
+	{
+		DWORD flags = FILE_ATTRIBUTE_NORMAL;
+		switch (accessPattern)
+		{
+			case FileAccessPattern::Normal:     break;
+			case FileAccessPattern::Random:     flags |= FILE_FLAG_RANDOM_ACCESS; break;
+			case FileAccessPattern::Sequential: flags |= FILE_FLAG_SEQUENTIAL_SCAN; break;
+		}
+
+		if constexpr (std::is_same_v<std::filesystem::path::value_type, wchar_t>)
+			m_fileHandle = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+		else
+			m_fileHandle = CreateFileW(ToWideString(filePath.generic_u8string()).data(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+
+		if (m_fileHandle == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(m_fileHandle, &fileSize))
+			return false;
+
+		m_size = static_cast<UInt64>(fileSize.QuadPart);
+		if (m_size == 0)
+			return true; //< CreateFileMapping fails on empty files
+
+		if (m_size > std::numeric_limits<std::size_t>::max())
+		{
+			SetLastError(ERROR_FILE_TOO_LARGE);
+			return false;
+		}
+
+		m_mappingHandle = CreateFileMappingW(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!m_mappingHandle)
+			return false;
+
+		m_ptr = MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+		return m_ptr != nullptr;
+	}
+
+	void MappedFileImpl::Prefetch(UInt64 offset, UInt64 size)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		if (!m_ptr || size == 0)
+			return;
+
+		PrefetchVirtualMemoryFunc prefetchVirtualMemory = GetPrefetchVirtualMemory();
+		if (!prefetchVirtualMemory)
+			return;
+
+		MemoryRangeEntry range;
+		range.VirtualAddress = static_cast<UInt8*>(m_ptr) + offset;
+		range.NumberOfBytes = static_cast<SIZE_T>(size);
+
+		prefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+	}
+
+	void MappedFileImpl::SetAccessPattern(FileAccessPattern /*accessPattern*/)
+	{
+		// Access pattern can only be specified when opening the file
+	}
+}
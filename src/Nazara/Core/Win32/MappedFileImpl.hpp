@@ -0,0 +1,57 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_CORE_WIN32_MAPPEDFILEIMPL_HPP
+#define NAZARA_CORE_WIN32_MAPPEDFILEIMPL_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Core/Enums.hpp>
+#include <filesystem>
+#include <Windows.h>
+
+namespace Nz
+{
+	class MappedFileImpl
+	{
+		public:
+			MappedFileImpl();
+			MappedFileImpl(const MappedFileImpl&) = delete;
+			MappedFileImpl(MappedFileImpl&&) = delete;
+			~MappedFileImpl();
+
+			inline const void* GetPointer() const;
+			inline UInt64 GetSize() const;
+
+			bool Open(const std::filesystem::path& filePath, FileAccessPattern accessPattern);
+
+			void Prefetch(UInt64 offset, UInt64 size);
+
+			void SetAccessPattern(FileAccessPattern accessPattern);
+
+			MappedFileImpl& operator=(const MappedFileImpl&) = delete;
+			MappedFileImpl& operator=(MappedFileImpl&&) = delete;
+
+		private:
+			HANDLE m_fileHandle;
+			HANDLE m_mappingHandle;
+			void* m_ptr;
+			UInt64 m_size;
+	};
+
+	inline const void* MappedFileImpl::GetPointer() const
+	{
+		return m_ptr;
+	}
+
+	inline UInt64 MappedFileImpl::GetSize() const
+	{
+		return m_size;
+	}
+}
+
+#endif // NAZARA_CORE_WIN32_MAPPEDFILEIMPL_HPP
+
+#include <Nazara/Core/AntiWindows.hpp>
@@ -5,12 +5,29 @@
 #include <Nazara/Graphics/AbstractViewer.hpp>
 #include <Nazara/Graphics/ViewerInstance.hpp>
 #include <Nazara/Renderer/RenderTarget.hpp>
+#include <algorithm>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
 {
 	AbstractViewer::~AbstractViewer() = default;
 
+	/*!
+	* \brief Returns the region of the viewer attachments which is rendered to
+	*
+	* This is the viewport scaled by the viewer instance render scale, which is lower than one when using dynamic resolution.
+	*/
+	Recti AbstractViewer::GetRenderViewport() const
+	{
+		const Recti& viewport = GetViewport();
+
+		float renderScale = GetViewerInstance().GetRenderScale();
+		if (renderScale >= 1.f)
+			return viewport;
+
+		return Recti(int(viewport.x * renderScale), int(viewport.y * renderScale), std::max(int(viewport.width * renderScale), 1), std::max(int(viewport.height * renderScale), 1));
+	}
+
 	Vector3f AbstractViewer::Project(const Vector3f& worldPos)
 	{
 		const Matrix4f& viewProj = GetViewerInstance().GetViewProjMatrix();
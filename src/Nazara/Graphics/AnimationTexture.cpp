@@ -0,0 +1,154 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/AnimationTexture.hpp>
+#include <Nazara/Graphics/Graphics.hpp>
+#include <Nazara/Math/Matrix4.hpp>
+#include <Nazara/Renderer/RenderDevice.hpp>
+#include <Nazara/Renderer/Texture.hpp>
+#include <Nazara/Utility/Animation.hpp>
+#include <Nazara/Utility/Joint.hpp>
+#include <Nazara/Utility/SkeletalPose.hpp>
+#include <Nazara/Utility/Skeleton.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup graphics
+	* \class Nz::AnimationTexture
+	* \brief Graphics class storing the skinning matrices of every frame of a skeletal animation in a texture
+	*
+	* Each texture row holds the skinning matrices of an animation frame, using four RGBA32F texels (the matrix columns) per joint.
+	* Instances animated from an animation texture only carry a clip index and a playback time (see WorldInstance::UpdateAnimation),
+	* which allows SubmeshRenderer to render many animated instances of a skinned mesh using a single instanced draw call.
+	*/
+
+	/*!
+	* \brief Bakes an animation into a texture
+	*
+	* Frames are sampled without interpolation, clips are copied from the animation sequences.
+	*
+	* \param animation Skeletal animation to bake
+	* \param skeleton Skeleton used to play the animation, its hierarchy and inverse bind matrices are used to compute skinning matrices
+	*
+	* \remark Joints from the skeleton must be sorted so that parents come before their children
+	*/
+	AnimationTexture::AnimationTexture(const Animation& animation, const Skeleton& skeleton) :
+	m_frameCount(animation.GetFrameCount()),
+	m_jointCount(skeleton.GetJointCount()),
+	m_loopPointInterpolation(animation.IsLoopPointInterpolationEnabled())
+	{
+		if (animation.GetType() != AnimationType::Skeletal)
+			throw std::runtime_error("animation is not skeletal");
+
+		if (animation.GetJointCount() != m_jointCount)
+			throw std::runtime_error("animation joint count (" + std::to_string(animation.GetJointCount()) + ") doesn't match skeleton joint count (" + std::to_string(m_jointCount) + ")");
+
+		if (m_frameCount == 0 || m_jointCount == 0)
+			throw std::runtime_error("animation has no frame or no joint");
+
+		m_clips.reserve(animation.GetSequenceCount());
+		for (std::size_t i = 0; i < animation.GetSequenceCount(); ++i)
+			m_clips.push_back(*animation.GetSequence(i));
+
+		std::vector<Matrix4f> inverseBindMatrices(m_jointCount);
+		std::vector<std::size_t> parentIndices(m_jointCount);
+
+		const Joint* joints = skeleton.GetJoints();
+		for (std::size_t i = 0; i < m_jointCount; ++i)
+		{
+			inverseBindMatrices[i] = joints[i].GetInverseBindMatrix();
+
+			const Node* parent = joints[i].GetParent();
+			if (parent && parent >= joints && parent < joints + m_jointCount)
+				parentIndices[i] = SafeCast<std::size_t>(static_cast<const Joint*>(parent) - joints);
+			else
+				parentIndices[i] = SkeletalPose::NoParent;
+		}
+
+		// Matrix4f is stored in column-major order, so each matrix gives four texels (one per column)
+		std::vector<Matrix4f> skinningMatrices(m_frameCount * m_jointCount);
+
+		SkeletalPose pose;
+		SkeletalPose modelPose;
+		for (std::size_t frame = 0; frame < m_frameCount; ++frame)
+		{
+			animation.SamplePose(pose, frame, frame, 0.f);
+			pose.ComputeModelPose(parentIndices.data(), modelPose);
+			modelPose.ComputeSkinningMatrices(inverseBindMatrices.data(), &skinningMatrices[frame * m_jointCount]);
+		}
+
+		TextureInfo texInfo;
+		texInfo.type = ImageType::E2D;
+		texInfo.pixelFormat = PixelFormat::RGBA32F;
+		texInfo.width = SafeCast<unsigned int>(m_jointCount * TexelPerJoint);
+		texInfo.height = SafeCast<unsigned int>(m_frameCount);
+		texInfo.levelCount = 1;
+		texInfo.usageFlags = TextureUsage::ShaderSampling | TextureUsage::TransferDestination;
+
+		m_texture = Graphics::Instance()->GetRenderDevice()->InstantiateTexture(texInfo, skinningMatrices.data(), false);
+		m_texture->UpdateDebugName("Animation texture");
+	}
+
+	/*!
+	* \brief Returns the index of a clip
+	* \return Clip index or the clip count if no clip has this name
+	*
+	* \param clipName Name of the animation sequence
+	*/
+	std::size_t AnimationTexture::GetClipIndex(const std::string& clipName) const
+	{
+		auto it = std::find_if(m_clips.begin(), m_clips.end(), [&](const Sequence& clip) { return clip.name == clipName; });
+		return SafeCast<std::size_t>(std::distance(m_clips.begin(), it));
+	}
+
+	/*!
+	* \brief Computes the texture rows to sample for a looping clip at a given time
+	* \return Texture coordinates of the two frames to interpolate, and the interpolation factor between them
+	*
+	* \param clipIndex Index of the clip
+	* \param time Playback time of the clip, in seconds
+	*/
+	auto AnimationTexture::Sample(std::size_t clipIndex, float time) const -> FrameSample
+	{
+		NazaraAssert(clipIndex < m_clips.size(), "clip index out of range");
+
+		const Sequence& clip = m_clips[clipIndex];
+		NazaraAssert(clip.frameCount > 0, "clip has no frame");
+
+		float frameTime = std::fmod(time * clip.frameRate, float(clip.frameCount));
+		if (frameTime < 0.f)
+			frameTime += float(clip.frameCount);
+
+		std::size_t frame = std::min<std::size_t>(static_cast<std::size_t>(frameTime), clip.frameCount - 1);
+		float interpolation = frameTime - float(frame);
+
+		std::size_t nextFrame = frame + 1;
+		if (nextFrame >= clip.frameCount)
+		{
+			if (m_loopPointInterpolation)
+				nextFrame = 0;
+			else
+			{
+				nextFrame = frame;
+				interpolation = 0.f;
+			}
+		}
+
+		// Sample texel centers
+		float invFrameCount = 1.f / float(m_frameCount);
+
+		FrameSample frameSample;
+		frameSample.frameCoords.x = (float(clip.firstFrame + frame) + 0.5f) * invFrameCount;
+		frameSample.frameCoords.y = (float(clip.firstFrame + nextFrame) + 0.5f) * invFrameCount;
+		frameSample.interpolation = interpolation;
+
+		return frameSample;
+	}
+}
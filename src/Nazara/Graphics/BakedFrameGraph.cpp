@@ -3,9 +3,13 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Graphics/BakedFrameGraph.hpp>
+#include <Nazara/Core/Core.hpp>
+#include <Nazara/Core/Profiler.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Graphics/Graphics.hpp>
 #include <Nazara/Renderer/CommandBufferBuilder.hpp>
 #include <Nazara/Renderer/RenderFrame.hpp>
+#include <NazaraUtils/EnumArray.hpp>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
@@ -19,33 +23,63 @@ namespace Nz
 	m_width(0)
 	{
 		const std::shared_ptr<RenderDevice>& renderDevice = Graphics::Instance()->GetRenderDevice();
-		m_commandPool = renderDevice->InstantiateCommandPool(QueueType::Graphics);
+		m_parallelRecording = renderDevice->IsParallelCommandRecordingSupported();
+
+		// Command pools are not thread-safe, give each pass its own pool so they can be recorded concurrently
+		EnumArray<QueueType, std::shared_ptr<CommandPool>> sharedCommandPools;
+		for (auto& passData : m_passes)
+		{
+			passData.zoneName = Profiler::InternName((!passData.name.empty()) ? std::string_view(passData.name) : std::string_view("FramePass"));
+
+			if (m_parallelRecording)
+				passData.commandPool = renderDevice->InstantiateCommandPool(passData.queueType);
+			else
+			{
+				std::shared_ptr<CommandPool>& sharedCommandPool = sharedCommandPools[passData.queueType];
+				if (!sharedCommandPool)
+					sharedCommandPool = renderDevice->InstantiateCommandPool(passData.queueType);
+
+				passData.commandPool = sharedCommandPool;
+			}
+		}
 	}
 
 	void BakedFrameGraph::Execute(RenderFrame& renderFrame)
 	{
+		NazaraProfileScope("BakedFrameGraph::Execute");
+
+		m_passesToRecord.clear();
 		for (auto& passData : m_passes)
 		{
 			bool regenerateCommandBuffer = (passData.forceCommandBufferRegeneration || passData.commandBuffer == nullptr);
-			if (passData.executionCallback)
+
+			// Merged passes are skipped as a whole only if every subpass is, otherwise skipped subpasses are recorded empty
+			bool isExecuted = false;
+			for (auto& subpass : passData.subpasses)
 			{
-				switch (passData.executionCallback())
+				FramePassExecution execution = (subpass.executionCallback) ? subpass.executionCallback() : FramePassExecution::Execute;
+				if (execution == FramePassExecution::UpdateAndExecute)
+					regenerateCommandBuffer = true;
+
+				bool isSkipped = (execution == FramePassExecution::Skip);
+				if (subpass.isSkipped != isSkipped)
 				{
-					case FramePassExecution::Execute:
-						break;
+					subpass.isSkipped = isSkipped;
+					regenerateCommandBuffer = true;
+				}
 
-					case FramePassExecution::Skip:
-						if (passData.commandBuffer)
-						{
-							renderFrame.PushForRelease(std::move(passData.commandBuffer));
-							passData.commandBuffer.reset();
-						}
-						continue; //< Skip the pass
+				if (!isSkipped)
+					isExecuted = true;
+			}
 
-					case FramePassExecution::UpdateAndExecute:
-						regenerateCommandBuffer = true;
-						break;
+			if (!isExecuted)
+			{
+				if (passData.commandBuffer)
+				{
+					renderFrame.PushForRelease(std::move(passData.commandBuffer));
+					passData.commandBuffer.reset();
 				}
+				continue; //< Skip the pass
 			}
 
 			if (!regenerateCommandBuffer)
@@ -54,50 +88,34 @@ namespace Nz
 			if (passData.commandBuffer)
 				renderFrame.PushForRelease(std::move(passData.commandBuffer));
 
-			passData.commandBuffer = m_commandPool->BuildCommandBuffer([&](CommandBufferBuilder& builder)
-			{
-				for (auto& textureTransition : passData.invalidationBarriers)
-				{
-					const std::shared_ptr<Texture>& texture = m_textures[textureTransition.textureId].texture;
-					builder.TextureBarrier(textureTransition.srcStageMask, textureTransition.dstStageMask, textureTransition.srcAccessMask, textureTransition.dstAccessMask, textureTransition.oldLayout, textureTransition.newLayout, *texture);
-				}
-
-				builder.BeginRenderPass(*passData.framebuffer, *passData.renderPass, passData.renderRect, passData.outputClearValues.data(), passData.outputClearValues.size());
-
-				if (!passData.name.empty())
-					builder.BeginDebugRegion(passData.name, Color::Green());
-
-				FramePassEnvironment env{
-					*this,
-					passData.renderRect,
-					renderFrame
-				};
-
-				bool first = true;
-				for (auto& subpass : passData.subpasses)
-				{
-					if (!first)
-						builder.NextSubpass();
-
-					first = false;
-
-					subpass.commandCallback(builder, env);
-				}
-
-				if (!passData.name.empty())
-					builder.EndDebugRegion();
+			m_passesToRecord.push_back(&passData);
+		}
 
-				builder.EndRenderPass();
+		// Passes only depend on each other through the barriers they record, which are executed in submission order,
+		// this means their command buffers can be recorded in any order (and in parallel)
+		if (m_parallelRecording && m_passesToRecord.size() > 1)
+		{
+			Core::Instance()->GetTaskScheduler().ForEachChunk(m_passesToRecord.size(), 1, [&](std::size_t first, std::size_t last)
+			{
+				for (std::size_t i = first; i < last; ++i)
+					RecordPass(*m_passesToRecord[i], renderFrame);
 			});
-
-			passData.forceCommandBufferRegeneration = false;
+		}
+		else
+		{
+			for (PassData* passData : m_passesToRecord)
+				RecordPass(*passData, renderFrame);
 		}
 
 		//TODO: Submit all commands buffer at once
 		for (auto& passData : m_passes)
 		{
+			// Passes depending on work of other queues have to wait for them (even if skipped, as passes after them may rely on it)
+			for (QueueType waitedQueue : passData.waitedQueues)
+				renderFrame.SynchronizeQueues(passData.queueType, waitedQueue);
+
 			if (passData.commandBuffer)
-				renderFrame.SubmitCommandBuffer(passData.commandBuffer.get(), QueueType::Graphics);
+				renderFrame.SubmitCommandBuffer(passData.commandBuffer.get(), passData.queueType);
 		}
 	}
 
@@ -129,7 +147,14 @@ namespace Nz
 		return m_passes[physicalPassIndex].renderPass;
 	}
 
-	bool BakedFrameGraph::Resize(RenderFrame& renderFrame)
+	/*!
+	* \brief Creates the textures and framebuffers of the graph if the frame size changed
+	* \return True if the graph was resized (and its attachment textures changed)
+	*
+	* \param renderFrame Frame whose size is used for swapchain-relative attachments
+	* \param textureSource Optional graph whose textures can be shared when they have the same parameters (useful when switching between baked graphs, which are never executed at the same time)
+	*/
+	bool BakedFrameGraph::Resize(RenderFrame& renderFrame, const BakedFrameGraph* textureSource)
 	{
 		auto [frameWidth, frameHeight] = renderFrame.GetSize();
 		if (m_width == frameWidth && m_height == frameHeight)
@@ -147,6 +172,34 @@ namespace Nz
 		for (auto& textureData : m_textures)
 			renderFrame.PushForRelease(std::move(textureData.texture));
 
+		std::vector<bool> sharedSourceTextures;
+		if (textureSource)
+			sharedSourceTextures.resize(textureSource->m_textures.size(), false);
+
+		auto FindSourceTexture = [&](const TextureInfo& textureInfo) -> std::shared_ptr<Texture>
+		{
+			if (!textureSource)
+				return nullptr;
+
+			for (std::size_t i = 0; i < textureSource->m_textures.size(); ++i)
+			{
+				const TextureData& sourceTextureData = textureSource->m_textures[i];
+				if (sharedSourceTextures[i] || sourceTextureData.viewData || !sourceTextureData.texture)
+					continue;
+
+				const TextureInfo& sourceTextureInfo = sourceTextureData.texture->GetTextureInfo();
+				if (sourceTextureInfo.type != textureInfo.type || sourceTextureInfo.pixelFormat != textureInfo.pixelFormat || sourceTextureInfo.usageFlags != textureInfo.usageFlags ||
+				    sourceTextureInfo.width != textureInfo.width || sourceTextureInfo.height != textureInfo.height || sourceTextureInfo.depth != textureInfo.depth ||
+				    sourceTextureInfo.layerCount != textureInfo.layerCount || sourceTextureInfo.levelCount != textureInfo.levelCount)
+					continue;
+
+				sharedSourceTextures[i] = true;
+				return sourceTextureData.texture;
+			}
+
+			return nullptr;
+		};
+
 		for (auto& textureData : m_textures)
 		{
 			if (textureData.viewData)
@@ -189,6 +242,9 @@ namespace Nz
 						break;
 				}
 
+				if (textureData.texture = FindSourceTexture(textureCreationParams); textureData.texture)
+					continue;
+
 				textureData.texture = renderDevice->InstantiateTexture(textureCreationParams);
 				if (!textureData.name.empty())
 					textureData.texture->UpdateDebugName(textureData.name);
@@ -227,12 +283,14 @@ namespace Nz
 			}
 
 			passData.renderRect = Recti(0, 0, int(framebufferWidth), int(framebufferHeight));
+			passData.forceCommandBufferRegeneration = true;
+
+			if (!passData.renderPass)
+				continue; //< compute passes don't have a framebuffer
 
 			passData.framebuffer = renderDevice->InstantiateFramebuffer(framebufferWidth, framebufferHeight, passData.renderPass, textures);
 			if (!passData.name.empty())
 				passData.framebuffer->UpdateDebugName(passData.name);
-
-			passData.forceCommandBufferRegeneration = true;
 		}
 
 		m_width = frameWidth;
@@ -240,4 +298,59 @@ namespace Nz
 
 		return true;
 	}
+
+	void BakedFrameGraph::RecordPass(PassData& passData, RenderFrame& renderFrame)
+	{
+		NazaraProfileScope(passData.zoneName);
+
+		passData.commandBuffer = passData.commandPool->BuildCommandBuffer([&](CommandBufferBuilder& builder)
+		{
+			for (auto& textureTransition : passData.invalidationBarriers)
+			{
+				const std::shared_ptr<Texture>& texture = m_textures[textureTransition.textureId].texture;
+				if (textureTransition.srcQueue != textureTransition.dstQueue)
+					builder.TextureAcquireBarrier(textureTransition.srcStageMask, textureTransition.dstStageMask, textureTransition.srcAccessMask, textureTransition.dstAccessMask, textureTransition.oldLayout, textureTransition.newLayout, textureTransition.srcQueue, textureTransition.dstQueue, *texture);
+				else
+					builder.TextureBarrier(textureTransition.srcStageMask, textureTransition.dstStageMask, textureTransition.srcAccessMask, textureTransition.dstAccessMask, textureTransition.oldLayout, textureTransition.newLayout, *texture);
+			}
+
+			if (passData.renderPass)
+				builder.BeginRenderPass(*passData.framebuffer, *passData.renderPass, passData.renderRect, passData.outputClearValues.data(), passData.outputClearValues.size());
+
+			if (!passData.name.empty())
+				builder.BeginDebugRegion(passData.name, Color::Green());
+
+			FramePassEnvironment env{
+				*this,
+				passData.renderRect,
+				renderFrame
+			};
+
+			bool first = true;
+			for (auto& subpass : passData.subpasses)
+			{
+				if (!first)
+					builder.NextSubpass();
+
+				first = false;
+
+				if (!subpass.isSkipped)
+					subpass.commandCallback(builder, env);
+			}
+
+			if (!passData.name.empty())
+				builder.EndDebugRegion();
+
+			if (passData.renderPass)
+				builder.EndRenderPass();
+
+			for (auto& textureTransition : passData.releaseBarriers)
+			{
+				const std::shared_ptr<Texture>& texture = m_textures[textureTransition.textureId].texture;
+				builder.TextureReleaseBarrier(textureTransition.srcStageMask, textureTransition.dstStageMask, textureTransition.srcAccessMask, textureTransition.dstAccessMask, textureTransition.oldLayout, textureTransition.newLayout, textureTransition.srcQueue, textureTransition.dstQueue, *texture);
+			}
+		});
+
+		passData.forceCommandBufferRegeneration = false;
+	}
 }
@@ -0,0 +1,160 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/BindlessTextureTable.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Renderer/RenderDevice.hpp>
+#include <Nazara/Renderer/RenderFrame.hpp>
+#include <Nazara/Renderer/Texture.hpp>
+#include <Nazara/Renderer/TextureSampler.hpp>
+#include <stdexcept>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Constructs the table and allocates its shader binding
+	*
+	* \param renderDevice Device on which the table is created, it must support bindless textures
+	*/
+	BindlessTextureTable::BindlessTextureTable(std::shared_ptr<RenderDevice> renderDevice) :
+	m_freeSlots(std::make_shared<FreeSlotList>()),
+	m_usedSlotCount(0)
+	{
+		NazaraAssert(renderDevice->GetEnabledFeatures().bindlessTextures, "bindless textures are not enabled");
+
+		RenderPipelineLayoutInfo layoutInfo;
+		layoutInfo.bindings.push_back(GetBindingInfo());
+
+		m_pipelineLayout = renderDevice->InstantiateRenderPipelineLayout(std::move(layoutInfo));
+		m_shaderBinding = m_pipelineLayout->AllocateShaderBinding(SetIndex);
+		m_shaderBinding->UpdateDebugName("BindlessTextureTable");
+	}
+
+	/*!
+	* \brief Gets a slot sampling a texture with a sampler
+	* \return Index of the slot in the table, shared by every registration of the same texture and sampler
+	*
+	* \param texture 2D texture to sample
+	* \param sampler Sampler used to sample the texture
+	*
+	* \remark Every registration must be matched by a call to Unregister
+	*/
+	UInt32 BindlessTextureTable::Register(std::shared_ptr<Texture> texture, std::shared_ptr<TextureSampler> sampler)
+	{
+		NazaraAssert(texture, "invalid texture");
+		NazaraAssert(texture->GetType() == ImageType::E2D, "only 2D textures can be registered");
+		NazaraAssert(sampler, "invalid sampler");
+
+		std::lock_guard lock(m_mutex);
+
+		SlotKey key(texture.get(), sampler.get());
+		if (auto it = m_slotByKey.find(key); it != m_slotByKey.end())
+		{
+			m_slots[it->second].refCount++;
+			return it->second;
+		}
+
+		UInt32 slotIndex;
+		{
+			std::lock_guard freeSlotLock(m_freeSlots->mutex);
+			if (!m_freeSlots->slots.empty())
+			{
+				slotIndex = m_freeSlots->slots.back();
+				m_freeSlots->slots.pop_back();
+			}
+			else if (m_slots.size() < MaxTextureCount)
+			{
+				slotIndex = SafeCast<UInt32>(m_slots.size());
+				m_slots.emplace_back();
+			}
+			else
+				throw std::runtime_error("bindless texture table is full (" + std::to_string(MaxTextureCount) + " textures)");
+		}
+
+		// The slot isn't used by any submitted command, it can be written while the table is bound
+		ShaderBinding::SampledTextureBinding textureBinding = { texture.get(), sampler.get() };
+		m_shaderBinding->Update({
+			{
+				BindingIndex,
+				ShaderBinding::SampledTextureBindings {
+					1, &textureBinding, slotIndex
+				}
+			}
+		});
+
+		Slot& slot = m_slots[slotIndex];
+		slot.texture = std::move(texture);
+		slot.sampler = std::move(sampler);
+		slot.refCount = 1;
+
+		m_slotByKey.emplace(key, slotIndex);
+		m_usedSlotCount++;
+
+		return slotIndex;
+	}
+
+	/*!
+	* \brief Releases a registration made by Register
+	*
+	* Once a slot isn't registered anymore, it's only reused after the frames which may sample it are over (see Update).
+	*
+	* \param slot Slot returned by Register
+	*/
+	void BindlessTextureTable::Unregister(UInt32 slot)
+	{
+		std::lock_guard lock(m_mutex);
+
+		NazaraAssert(slot < m_slots.size(), "invalid slot");
+		Slot& slotData = m_slots[slot];
+		NazaraAssert(slotData.refCount > 0, "slot is not registered");
+
+		if (--slotData.refCount > 0)
+			return;
+
+		m_slotByKey.erase(SlotKey(slotData.texture.get(), slotData.sampler.get()));
+		m_releasedSlots.push_back(std::move(slotData));
+		m_releasedSlotIndices.push_back(slot);
+		m_usedSlotCount--;
+	}
+
+	/*!
+	* \brief Recycles slots unregistered since the last call once the frame is over
+	*
+	* \param renderFrame Frame being recorded, this should be called once per frame
+	*/
+	void BindlessTextureTable::Update(RenderFrame& renderFrame)
+	{
+		std::lock_guard lock(m_mutex);
+
+		if (m_releasedSlotIndices.empty())
+			return;
+
+		renderFrame.PushReleaseCallback([freeSlots = m_freeSlots, releasedSlots = std::move(m_releasedSlots), releasedSlotIndices = std::move(m_releasedSlotIndices)]() mutable
+		{
+			std::lock_guard freeSlotLock(freeSlots->mutex);
+			freeSlots->slots.insert(freeSlots->slots.end(), releasedSlotIndices.begin(), releasedSlotIndices.end());
+		});
+
+		m_releasedSlots.clear();
+		m_releasedSlotIndices.clear();
+	}
+
+	/*!
+	* \brief Gets the layout binding of the table
+	* \return Binding which materials declaring the table must use in their pipeline layout, for it to be compatible with the table shader binding
+	*/
+	RenderPipelineLayoutInfo::Binding BindlessTextureTable::GetBindingInfo()
+	{
+		RenderPipelineLayoutInfo::Binding bindingInfo;
+		bindingInfo.setIndex = SetIndex;
+		bindingInfo.bindingIndex = BindingIndex;
+		bindingInfo.arraySize = MaxTextureCount;
+		bindingInfo.type = ShaderBindingType::Sampler;
+		bindingInfo.shaderStageFlags = nzsl::ShaderStageType_All;
+		bindingInfo.flags = ShaderBindingFlag::PartiallyBound | ShaderBindingFlag::UpdateAfterBind | ShaderBindingFlag::UpdateUnusedWhilePending;
+
+		return bindingInfo;
+	}
+}
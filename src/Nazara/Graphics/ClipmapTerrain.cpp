@@ -0,0 +1,476 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/ClipmapTerrain.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Graphics/ElementRendererRegistry.hpp>
+#include <Nazara/Graphics/Graphics.hpp>
+#include <Nazara/Graphics/RenderTerrain.hpp>
+#include <Nazara/Renderer/CommandBufferBuilder.hpp>
+#include <Nazara/Renderer/RenderBuffer.hpp>
+#include <Nazara/Renderer/RenderDevice.hpp>
+#include <Nazara/Renderer/RenderFrame.hpp>
+#include <Nazara/Renderer/Texture.hpp>
+#include <Nazara/Renderer/UploadPool.hpp>
+#include <NZSL/Math/FieldOffsets.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	NAZARA_ANONYMOUS_NAMESPACE
+	{
+		constexpr UInt32 NoLevel = std::numeric_limits<UInt32>::max();
+
+		struct BlitSegment
+		{
+			UInt32 sourceBegin;
+			UInt32 sourceEnd;
+			UInt32 targetBegin;
+			UInt32 targetEnd;
+		};
+
+		struct TerrainDataOffsets
+		{
+			std::size_t levels;
+			std::size_t levelStride;
+			std::size_t terrainSize;
+			std::size_t clipmapSize;
+			std::size_t gridSize;
+			std::size_t levelCount;
+			std::size_t heightScale;
+			std::size_t texelSize;
+			std::size_t totalSize;
+		};
+
+		// Splits [targetBegin, targetEnd) into ranges of whole source texels, when a source texel covers scale target texels (blits can't start in the middle of a texel)
+		std::size_t ComputeBlitSegments(UInt32 targetBegin, UInt32 targetEnd, UInt32 scale, std::array<BlitSegment, 3>& segments)
+		{
+			std::size_t segmentCount = 0;
+			auto AddSegment = [&](UInt32 begin, UInt32 end, UInt32 sourceBegin, UInt32 sourceEnd)
+			{
+				if (begin < end)
+					segments[segmentCount++] = { sourceBegin, sourceEnd, begin, end };
+			};
+
+			UInt32 alignedBegin = (targetBegin + scale - 1) / scale * scale;
+			UInt32 alignedEnd = targetEnd / scale * scale;
+			if (alignedBegin < alignedEnd)
+			{
+				AddSegment(targetBegin, alignedBegin, targetBegin / scale, targetBegin / scale + 1);
+				AddSegment(alignedBegin, alignedEnd, alignedBegin / scale, alignedEnd / scale);
+				AddSegment(alignedEnd, targetEnd, alignedEnd / scale, alignedEnd / scale + 1);
+			}
+			else
+			{
+				// The range doesn't cover a whole source texel
+				UInt32 split = std::min(alignedBegin, targetEnd);
+				AddSegment(targetBegin, split, targetBegin / scale, targetBegin / scale + 1);
+				AddSegment(split, targetEnd, split / scale, split / scale + 1);
+			}
+
+			return segmentCount;
+		}
+
+		// Must match TerrainRender shader
+		TerrainDataOffsets GetTerrainDataOffsets()
+		{
+			nzsl::FieldOffsets terrainStruct(nzsl::StructLayout::Std140);
+
+			TerrainDataOffsets offsets;
+			offsets.levels = terrainStruct.AddField(nzsl::StructFieldType::Int4);
+			for (std::size_t i = 1; i < ClipmapTerrain::MaxLevelCount; ++i)
+				terrainStruct.AddField(nzsl::StructFieldType::Int4);
+
+			offsets.levelStride = 4 * sizeof(Int32); //< std140 arrays of vec4 are tightly packed
+			offsets.terrainSize = terrainStruct.AddField(nzsl::StructFieldType::Float2);
+			offsets.clipmapSize = terrainStruct.AddField(nzsl::StructFieldType::Float2);
+			offsets.gridSize = terrainStruct.AddField(nzsl::StructFieldType::Int1);
+			offsets.levelCount = terrainStruct.AddField(nzsl::StructFieldType::Int1);
+			offsets.heightScale = terrainStruct.AddField(nzsl::StructFieldType::Float1);
+			offsets.texelSize = terrainStruct.AddField(nzsl::StructFieldType::Float1);
+			offsets.totalSize = terrainStruct.GetAlignedSize();
+
+			return offsets;
+		}
+	}
+
+	/*!
+	* \ingroup graphics
+	* \class ClipmapTerrain
+	* \brief Heightfield terrain drawn as geometry clipmaps around the viewer
+	*
+	* The terrain is made of levels of the same grid of gridSize x gridSize cells, every level having twice the cell size of the previous one,
+	* centered on the viewer. Every level is drawn with the same index buffer (as an instance of a single draw), the vertex shader reads
+	* its heights from a clipmap texture and blends the vertices close to the level border toward the next level to hide the transition.
+	* Draw count and vertex count only depend on the grid size and level count, not on the terrain size.
+	*
+	* Heights (and optional colors) are split into chunks of chunkSize x chunkSize texels registered in a TextureStreamer, the terrain reports
+	* the texture level needed by every chunk each frame and copies the resident texels around the viewer into its clipmaps.
+	* Until a chunk has the needed level resident, its finest resident level is stretched in its place.
+	*
+	* The terrain lies on the XZ plane, from the origin to chunkCount * chunkSize * texelSize, and is not lit (its color comes from the color chunks).
+	*/
+	ClipmapTerrain::ClipmapTerrain(TextureStreamer& textureStreamer, Params params) :
+	m_params(std::move(params)),
+	m_textureStreamer(textureStreamer),
+	m_areClipmapsInitialized(false),
+	m_isTerrainBufferDirty(true)
+	{
+		NazaraAssert(m_params.chunkCount.x > 0 && m_params.chunkCount.y > 0, "invalid chunk count");
+		NazaraAssert(m_params.heightChunks.size() == std::size_t(m_params.chunkCount.x) * m_params.chunkCount.y, "height chunks don't match chunk count");
+		NazaraAssert(m_params.colorChunks.empty() || m_params.colorChunks.size() == m_params.heightChunks.size(), "color chunks don't match height chunks");
+		NazaraAssert(m_params.gridSize >= 4 && m_params.gridSize % 4 == 0, "grid size must be a multiple of four");
+		NazaraAssert(m_params.levelCount > 0 && m_params.levelCount <= MaxLevelCount, "invalid level count");
+		NazaraAssert(m_params.chunkSize > 0 && (m_params.chunkSize & (m_params.chunkSize - 1)) == 0, "chunk size must be a power of two");
+		NazaraAssert((m_params.chunkSize >> (m_params.levelCount - 1)) > 0, "chunks must have at least one texel at the coarsest level");
+
+		Graphics* graphics = Graphics::Instance();
+		RenderDevice& renderDevice = *graphics->GetRenderDevice();
+
+		// Grid shared by every level, vertex positions are computed from their index
+		UInt32 vertexCount = m_params.gridSize + 1;
+
+		std::vector<UInt32> indices;
+		indices.reserve(GetIndexCount());
+		for (UInt32 y = 0; y < m_params.gridSize; ++y)
+		{
+			for (UInt32 x = 0; x < m_params.gridSize; ++x)
+			{
+				UInt32 i00 = y * vertexCount + x;
+				UInt32 i10 = i00 + 1;
+				UInt32 i01 = i00 + vertexCount;
+				UInt32 i11 = i01 + 1;
+
+				indices.insert(indices.end(), { i00, i01, i10, i10, i01, i11 });
+			}
+		}
+
+		m_indexBuffer = renderDevice.InstantiateBuffer(BufferType::Index, indices.size() * sizeof(UInt32), BufferUsage::DeviceLocal | BufferUsage::Write, indices.data());
+
+		static TerrainDataOffsets terrainDataOffsets = GetTerrainDataOffsets();
+		m_terrainBuffer = renderDevice.InstantiateBuffer(BufferType::Uniform, terrainDataOffsets.totalSize, BufferUsage::DeviceLocal | BufferUsage::Dynamic | BufferUsage::Write);
+
+		// Levels are stored side by side, a texel per vertex
+		TextureInfo clipmapInfo;
+		clipmapInfo.type = ImageType::E2D;
+		clipmapInfo.levelCount = 1;
+		clipmapInfo.width = vertexCount * m_params.levelCount;
+		clipmapInfo.height = vertexCount;
+
+		TextureInfo heightClipmapInfo = clipmapInfo;
+		heightClipmapInfo.pixelFormat = PixelFormat::R32F;
+		heightClipmapInfo.usageFlags = TextureUsage::ShaderReadWrite | TextureUsage::TransferDestination;
+
+		m_heightClipmap = renderDevice.InstantiateTexture(heightClipmapInfo);
+		if (!m_heightClipmap)
+			throw std::runtime_error("failed to instantiate terrain height clipmap");
+
+		m_heightClipmap->UpdateDebugName("Terrain height clipmap");
+
+		if (!m_params.colorChunks.empty())
+		{
+			TextureInfo colorClipmapInfo = clipmapInfo;
+			colorClipmapInfo.pixelFormat = PixelFormat::RGBA8;
+			colorClipmapInfo.usageFlags = TextureUsage::ShaderSampling | TextureUsage::TransferDestination;
+
+			m_colorClipmap = renderDevice.InstantiateTexture(colorClipmapInfo);
+			if (!m_colorClipmap)
+				throw std::runtime_error("failed to instantiate terrain color clipmap");
+
+			m_colorClipmap->UpdateDebugName("Terrain color clipmap");
+		}
+		else
+			m_colorClipmap = graphics->GetDefaultTextures().whiteTextures[ImageType::E2D];
+
+		m_levels.resize(m_params.levelCount);
+
+		for (std::size_t i = 0; i < m_params.heightChunks.size(); ++i)
+			m_chunkByTexture[m_params.heightChunks[i]] = i;
+
+		for (std::size_t i = 0; i < m_params.colorChunks.size(); ++i)
+			m_chunkByTexture[m_params.colorChunks[i]] = i;
+
+		m_onTextureResidencyChanged.Connect(m_textureStreamer.OnTextureResidencyChanged, [this](TextureStreamer* /*textureStreamer*/, std::size_t textureIndex, const std::shared_ptr<Texture>& /*newTexture*/)
+		{
+			// Texels of the chunk are copied again by the next update
+			auto it = m_chunkByTexture.find(textureIndex);
+			if (it != m_chunkByTexture.end())
+				m_dirtyChunks.UnboundedSet(it->second);
+		});
+
+		Vector2f terrainSize = Vector2f(m_params.chunkCount * m_params.chunkSize) * m_params.texelSize;
+		UpdateAABB(Boxf(0.f, 0.f, 0.f, terrainSize.x, m_params.heightScale, terrainSize.y));
+	}
+
+	void ClipmapTerrain::BuildElement(ElementRendererRegistry& registry, const ElementData& elementData, std::size_t passIndex, std::vector<RenderElementOwner>& elements) const
+	{
+		Graphics* graphics = Graphics::Instance();
+		if (!graphics->IsTerrainEnabled())
+			return;
+
+		// Terrains are only drawn by the forward pass, they don't write to the depth pre-pass nor cast shadows
+		if (passIndex != graphics->GetMaterialPassRegistry().GetPassIndex("ForwardPass"))
+			return;
+
+		elements.emplace_back(registry.AllocateElement<RenderTerrain>(GetRenderLayer(), *this, *elementData.worldInstance));
+	}
+
+	const std::shared_ptr<MaterialInstance>& ClipmapTerrain::GetMaterial(std::size_t i) const
+	{
+		NazaraUnused(i);
+
+		// Terrains have no material (see GetMaterialCount)
+		static std::shared_ptr<MaterialInstance> s_noMaterial;
+		return s_noMaterial;
+	}
+
+	std::size_t ClipmapTerrain::GetMaterialCount() const
+	{
+		return 0;
+	}
+
+	/*!
+	* \brief Moves the levels around the viewer, reports the chunk usage to the texture streamer and copies the chunk texels needed by the levels
+	*
+	* \param renderFrame Frame in which the clipmaps are updated, before the terrain is drawn
+	* \param viewerPosition Position of the viewer in the terrain space (relative to the entity the terrain is attached to)
+	*
+	* \remark This should be called every frame before the texture streamer update, with the position of the main viewer
+	*/
+	void ClipmapTerrain::Update(RenderFrame& renderFrame, const Vector3f& viewerPosition)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		static TerrainDataOffsets terrainDataOffsets = GetTerrainDataOffsets();
+
+		Int32 halfGrid = SafeCast<Int32>(m_params.gridSize / 2);
+		Vector2f viewerTexel(viewerPosition.x / m_params.texelSize, viewerPosition.z / m_params.texelSize);
+
+		bool hasDirtyLevel = false;
+		for (UInt32 levelIndex = 0; levelIndex < m_params.levelCount; ++levelIndex)
+		{
+			// Levels are centered on one of their even vertices, so their border lies on vertices of the next level
+			Int32 step = 1 << levelIndex;
+			Vector2i center(2 * step * Int32(std::floor(viewerTexel.x / (2 * step))), 2 * step * Int32(std::floor(viewerTexel.y / (2 * step))));
+			Vector2i origin = center - Vector2i(halfGrid * step);
+
+			LevelData& level = m_levels[levelIndex];
+			if (level.origin != origin)
+			{
+				level.origin = origin;
+				level.isDirty = true;
+				m_isTerrainBufferDirty = true;
+			}
+
+			hasDirtyLevel |= level.isDirty;
+		}
+
+		// Chunks only need the texture level of the finest terrain level covering them
+		m_chunkLevels.assign(m_params.heightChunks.size(), NoLevel);
+		for (UInt32 levelIndex = m_params.levelCount; levelIndex-- > 0;)
+		{
+			Vector2ui firstChunk, lastChunk;
+			if (!ComputeChunkRange(m_levels[levelIndex], levelIndex, firstChunk, lastChunk))
+				continue;
+
+			for (UInt32 y = firstChunk.y; y <= lastChunk.y; ++y)
+			{
+				for (UInt32 x = firstChunk.x; x <= lastChunk.x; ++x)
+					m_chunkLevels[y * m_params.chunkCount.x + x] = levelIndex;
+			}
+		}
+
+		for (std::size_t chunkIndex = 0; chunkIndex < m_chunkLevels.size(); ++chunkIndex)
+		{
+			UInt32 levelIndex = m_chunkLevels[chunkIndex];
+			if (levelIndex == NoLevel)
+				continue;
+
+			// A screen size of the texture level size requests it
+			float screenSize = float(m_params.chunkSize >> levelIndex);
+			m_textureStreamer.ReportTextureUsage(m_params.heightChunks[chunkIndex], screenSize);
+			if (!m_params.colorChunks.empty())
+				m_textureStreamer.ReportTextureUsage(m_params.colorChunks[chunkIndex], screenSize);
+		}
+
+		if (!m_isTerrainBufferDirty && !hasDirtyLevel && !m_dirtyChunks.TestAny())
+			return;
+
+		renderFrame.Execute([&](CommandBufferBuilder& builder)
+		{
+			builder.BeginDebugRegion("Clipmap terrain update", Color::Orange());
+			{
+				if (m_isTerrainBufferDirty)
+				{
+					auto& allocation = renderFrame.GetUploadPool().Allocate(terrainDataOffsets.totalSize);
+					UInt8* terrainData = static_cast<UInt8*>(allocation.mappedPtr);
+					std::memset(terrainData, 0, terrainDataOffsets.totalSize);
+
+					for (UInt32 levelIndex = 0; levelIndex < m_params.levelCount; ++levelIndex)
+					{
+						Int32* levelData = AccessByOffset<Int32*>(terrainData, terrainDataOffsets.levels + levelIndex * terrainDataOffsets.levelStride);
+						levelData[0] = m_levels[levelIndex].origin.x;
+						levelData[1] = m_levels[levelIndex].origin.y;
+						levelData[2] = 1 << levelIndex;
+					}
+
+					AccessByOffset<Vector2f&>(terrainData, terrainDataOffsets.terrainSize) = Vector2f(m_params.chunkCount * m_params.chunkSize);
+					AccessByOffset<Vector2f&>(terrainData, terrainDataOffsets.clipmapSize) = Vector2f(float(m_heightClipmap->GetSize().x), float(m_heightClipmap->GetSize().y));
+					AccessByOffset<Int32&>(terrainData, terrainDataOffsets.gridSize) = SafeCast<Int32>(m_params.gridSize);
+					AccessByOffset<Int32&>(terrainData, terrainDataOffsets.levelCount) = SafeCast<Int32>(m_params.levelCount);
+					AccessByOffset<float&>(terrainData, terrainDataOffsets.heightScale) = m_params.heightScale;
+					AccessByOffset<float&>(terrainData, terrainDataOffsets.texelSize) = m_params.texelSize;
+
+					// Terrain data may still be read by the previous frame
+					builder.MemoryBarrier(PipelineStage::VertexShader | PipelineStage::FragmentShader, PipelineStage::Transfer, MemoryAccess::UniformBufferRead, MemoryAccess::TransferWrite);
+					builder.CopyBuffer(allocation, RenderBufferView(m_terrainBuffer.get()));
+					builder.MemoryBarrier(PipelineStage::Transfer, PipelineStage::VertexShader | PipelineStage::FragmentShader, MemoryAccess::TransferWrite, MemoryAccess::UniformBufferRead);
+
+					m_isTerrainBufferDirty = false;
+				}
+
+				bool hasColorChunks = !m_params.colorChunks.empty();
+
+				// Heights are read as a storage texture by the vertex shader, colors are sampled by the fragment shader
+				builder.TextureBarrier(PipelineStage::VertexShader, PipelineStage::Transfer, MemoryAccess::ShaderRead, MemoryAccess::TransferWrite, (m_areClipmapsInitialized) ? TextureLayout::General : TextureLayout::Undefined, TextureLayout::TransferDestination, *m_heightClipmap);
+				if (hasColorChunks)
+					builder.TextureBarrier(PipelineStage::FragmentShader, PipelineStage::Transfer, MemoryAccess::ShaderRead, MemoryAccess::TransferWrite, (m_areClipmapsInitialized) ? TextureLayout::ColorInput : TextureLayout::Undefined, TextureLayout::TransferDestination, *m_colorClipmap);
+
+				for (UInt32 levelIndex = 0; levelIndex < m_params.levelCount; ++levelIndex)
+				{
+					LevelData& level = m_levels[levelIndex];
+
+					Vector2ui firstChunk, lastChunk;
+					if (ComputeChunkRange(level, levelIndex, firstChunk, lastChunk))
+					{
+						for (UInt32 y = firstChunk.y; y <= lastChunk.y; ++y)
+						{
+							for (UInt32 x = firstChunk.x; x <= lastChunk.x; ++x)
+							{
+								std::size_t chunkIndex = y * m_params.chunkCount.x + x;
+								if (!level.isDirty && !m_dirtyChunks.UnboundedTest(chunkIndex))
+									continue;
+
+								// Chunks which aren't loaded yet are copied once their residency changes
+								std::size_t heightTextureIndex = m_params.heightChunks[chunkIndex];
+								if (const std::shared_ptr<Texture>& heightTexture = m_textureStreamer.GetTexture(heightTextureIndex))
+									RefreshChunk(builder, renderFrame, *heightTexture, m_textureStreamer.GetResidentLevel(heightTextureIndex), Vector2ui(x, y), levelIndex, *m_heightClipmap);
+
+								if (hasColorChunks)
+								{
+									std::size_t colorTextureIndex = m_params.colorChunks[chunkIndex];
+									if (const std::shared_ptr<Texture>& colorTexture = m_textureStreamer.GetTexture(colorTextureIndex))
+										RefreshChunk(builder, renderFrame, *colorTexture, m_textureStreamer.GetResidentLevel(colorTextureIndex), Vector2ui(x, y), levelIndex, *m_colorClipmap);
+								}
+							}
+						}
+					}
+
+					level.isDirty = false;
+				}
+
+				builder.TextureBarrier(PipelineStage::Transfer, PipelineStage::VertexShader, MemoryAccess::TransferWrite, MemoryAccess::ShaderRead, TextureLayout::TransferDestination, TextureLayout::General, *m_heightClipmap);
+				if (hasColorChunks)
+					builder.TextureBarrier(PipelineStage::Transfer, PipelineStage::FragmentShader, MemoryAccess::TransferWrite, MemoryAccess::ShaderRead, TextureLayout::TransferDestination, TextureLayout::ColorInput, *m_colorClipmap);
+			}
+			builder.EndDebugRegion();
+		}, QueueType::Graphics);
+
+		m_areClipmapsInitialized = true;
+		m_dirtyChunks.Clear();
+	}
+
+	bool ClipmapTerrain::ComputeChunkRange(const LevelData& level, UInt32 levelIndex, Vector2ui& firstChunk, Vector2ui& lastChunk) const
+	{
+		Int64 levelSize = Int64(m_params.gridSize) << levelIndex;
+		Int64 chunkSize = m_params.chunkSize;
+
+		for (std::size_t axis = 0; axis < 2; ++axis)
+		{
+			Int64 levelBegin = level.origin[axis];
+			Int64 levelEnd = levelBegin + levelSize;
+			Int64 terrainEnd = Int64(m_params.chunkCount[axis]) * chunkSize - 1;
+			if (levelEnd < 0 || levelBegin > terrainEnd)
+				return false;
+
+			firstChunk[axis] = SafeCast<UInt32>(std::max<Int64>(levelBegin, 0) / chunkSize);
+			lastChunk[axis] = SafeCast<UInt32>(std::min(levelEnd, terrainEnd) / chunkSize);
+		}
+
+		return true;
+	}
+
+	void ClipmapTerrain::RefreshChunk(CommandBufferBuilder& builder, RenderFrame& renderFrame, Texture& chunkTexture, UInt8 residentLevel, const Vector2ui& chunk, UInt32 levelIndex, const Texture& clipmap)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		const LevelData& level = m_levels[levelIndex];
+		Int64 step = Int64(1) << levelIndex;
+		Int64 vertexCount = m_params.gridSize + 1;
+
+		// Level vertices lying in the chunk, level origin and chunk borders are multiples of the level step
+		std::array<std::array<BlitSegment, 3>, 2> segments;
+		std::array<std::size_t, 2> segmentCounts;
+		std::array<Int64, 2> targetOffsets;
+
+		UInt32 scale = (levelIndex < residentLevel) ? 1 << (residentLevel - levelIndex) : 1;
+		for (std::size_t axis = 0; axis < 2; ++axis)
+		{
+			Int64 chunkBegin = Int64(chunk[axis]) * m_params.chunkSize;
+			Int64 chunkEnd = chunkBegin + m_params.chunkSize;
+
+			Int64 firstVertex = std::max<Int64>((chunkBegin - level.origin[axis]) / step, 0);
+			Int64 lastVertex = std::min<Int64>((chunkEnd - level.origin[axis]) / step, vertexCount);
+			if (firstVertex >= lastVertex)
+				return;
+
+			// Texels of the chunk at the terrain level, the source texture is coarser when the chunk isn't resident enough
+			Int64 firstTexel = firstVertex + (level.origin[axis] - chunkBegin) / step;
+			Int64 lastTexel = firstTexel + (lastVertex - firstVertex);
+
+			segmentCounts[axis] = ComputeBlitSegments(SafeCast<UInt32>(firstTexel), SafeCast<UInt32>(lastTexel), scale, segments[axis]);
+			targetOffsets[axis] = firstVertex - firstTexel;
+		}
+
+		targetOffsets[0] += Int64(levelIndex) * vertexCount;
+
+		UInt8 sourceLevel = (levelIndex > residentLevel) ? SafeCast<UInt8>(levelIndex - residentLevel) : 0;
+		if (sourceLevel >= chunkTexture.GetLevelCount())
+			return;
+
+		TextureViewInfo viewInfo;
+		viewInfo.viewType = ImageType::E2D;
+		viewInfo.reinterpretFormat = chunkTexture.GetFormat();
+		viewInfo.baseMipLevel = sourceLevel;
+
+		std::shared_ptr<Texture> sourceTexture = chunkTexture.CreateView(viewInfo);
+
+		// Streamed textures are kept in the shader read layout
+		builder.TextureBarrier(PipelineStage::FragmentShader, PipelineStage::Transfer, MemoryAccess::ShaderRead, MemoryAccess::TransferRead, TextureLayout::ColorInput, TextureLayout::TransferSource, *sourceTexture);
+
+		for (std::size_t y = 0; y < segmentCounts[1]; ++y)
+		{
+			const BlitSegment& segmentY = segments[1][y];
+			for (std::size_t x = 0; x < segmentCounts[0]; ++x)
+			{
+				const BlitSegment& segmentX = segments[0][x];
+
+				Boxui fromBox(segmentX.sourceBegin, segmentY.sourceBegin, 0, segmentX.sourceEnd - segmentX.sourceBegin, segmentY.sourceEnd - segmentY.sourceBegin, 1);
+				Boxui toBox(SafeCast<UInt32>(segmentX.targetBegin + targetOffsets[0]), SafeCast<UInt32>(segmentY.targetBegin + targetOffsets[1]), 0, segmentX.targetEnd - segmentX.targetBegin, segmentY.targetEnd - segmentY.targetBegin, 1);
+
+				builder.BlitTexture(*sourceTexture, fromBox, TextureLayout::TransferSource, clipmap, toBox, TextureLayout::TransferDestination, SamplerFilter::Nearest);
+			}
+		}
+
+		builder.TextureBarrier(PipelineStage::Transfer, PipelineStage::FragmentShader, MemoryAccess::TransferRead, MemoryAccess::ShaderRead, TextureLayout::TransferSource, TextureLayout::ColorInput, *sourceTexture);
+
+		renderFrame.PushForRelease(std::move(sourceTexture));
+	}
+}
@@ -0,0 +1,14 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/DeferredFramePipeline.hpp>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	DeferredFramePipeline::DeferredFramePipeline(ElementRendererRegistry& elementRegistry) :
+	ForwardFramePipeline(elementRegistry, true)
+	{
+	}
+}
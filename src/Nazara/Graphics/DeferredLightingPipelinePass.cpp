@@ -0,0 +1,482 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/DeferredLightingPipelinePass.hpp>
+#include <Nazara/Graphics/AbstractViewer.hpp>
+#include <Nazara/Graphics/BakedFrameGraph.hpp>
+#include <Nazara/Graphics/FrameGraph.hpp>
+#include <Nazara/Graphics/FramePipeline.hpp>
+#include <Nazara/Graphics/Graphics.hpp>
+#include <Nazara/Graphics/Light.hpp>
+#include <Nazara/Graphics/LightShadowData.hpp>
+#include <Nazara/Graphics/PredefinedShaderStructs.hpp>
+#include <Nazara/Graphics/ViewerInstance.hpp>
+#include <Nazara/Math/Vector4.hpp>
+#include <Nazara/Renderer/CommandBufferBuilder.hpp>
+#include <Nazara/Renderer/RenderBuffer.hpp>
+#include <Nazara/Renderer/RenderFrame.hpp>
+#include <Nazara/Renderer/UploadPool.hpp>
+#include <NZSL/Math/FieldOffsets.hpp>
+#include <algorithm>
+#include <limits>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	NAZARA_ANONYMOUS_NAMESPACE
+	{
+		struct LightingDataOffsets
+		{
+			std::size_t clearColor;
+			std::size_t renderRect;
+			std::size_t tileScale;
+			std::size_t tileCountX;
+			std::size_t tileCountY;
+			std::size_t shadowedLightCount;
+			std::size_t totalSize;
+		};
+
+		// Must match DeferredLighting shader
+		LightingDataOffsets GetLightingDataOffsets()
+		{
+			nzsl::FieldOffsets lightingStruct(nzsl::StructLayout::Std140);
+
+			LightingDataOffsets offsets;
+			offsets.clearColor = lightingStruct.AddField(nzsl::StructFieldType::Float4);
+			offsets.renderRect = lightingStruct.AddField(nzsl::StructFieldType::Float4);
+			offsets.tileScale = lightingStruct.AddField(nzsl::StructFieldType::Float2);
+			offsets.tileCountX = lightingStruct.AddField(nzsl::StructFieldType::UInt1);
+			offsets.tileCountY = lightingStruct.AddField(nzsl::StructFieldType::UInt1);
+			offsets.shadowedLightCount = lightingStruct.AddField(nzsl::StructFieldType::UInt1);
+			offsets.totalSize = lightingStruct.GetAlignedSize();
+
+			return offsets;
+		}
+
+		// Tile entries are vec4[u32] (std140 arrays of scalars would have a 16 bytes stride anyway)
+		constexpr std::size_t TileEntrySize = 4 * sizeof(UInt32);
+
+		// Doubles storage buffers capacity to avoid reallocating them every time a light is added, returns true if the buffer was reallocated
+		bool EnsureStorageBuffer(std::shared_ptr<RenderBuffer>& buffer, UInt64 size, RenderFrame& renderFrame, const char* debugName)
+		{
+			UInt64 capacity = (buffer) ? buffer->GetSize() : 0;
+			if (buffer && capacity >= size)
+				return false;
+
+			if (buffer)
+				renderFrame.PushForRelease(std::move(buffer));
+
+			buffer = Graphics::Instance()->GetRenderDevice()->InstantiateBuffer(BufferType::Storage, std::max({ size, capacity * 2, UInt64(1024) }), BufferUsage::DeviceLocal | BufferUsage::Dynamic | BufferUsage::Write);
+			buffer->UpdateDebugName(debugName);
+
+			return true;
+		}
+	}
+
+	DeferredLightingPipelinePass::DeferredLightingPipelinePass(FramePipeline& owner, AbstractViewer* viewer) :
+	m_depthAttachment(0),
+	m_shadowedLightCount(0),
+	m_viewer(viewer),
+	m_pipeline(owner),
+	m_lastViewport(Recti::Zero()),
+	m_tileCountX(0),
+	m_tileCountY(0),
+	m_rebuildCommandBuffer(true)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		static LightingDataOffsets lightingDataOffsets = GetLightingDataOffsets();
+
+		m_gbufferAttachments.fill(0);
+		m_boundTextures.fill(nullptr);
+		m_shadowMaps.fill(nullptr);
+
+		m_lightingDataBuffer = Graphics::Instance()->GetRenderDevice()->InstantiateBuffer(BufferType::Uniform, lightingDataOffsets.totalSize, BufferUsage::DeviceLocal | BufferUsage::Dynamic | BufferUsage::Write);
+		m_lightingDataBuffer->UpdateDebugName("Deferred lighting data");
+	}
+
+	DeferredLightingPipelinePass::~DeferredLightingPipelinePass() = default;
+
+	/*!
+	* \brief Sorts and bins the visible lights of the viewer, uploads them and updates the pass bindings
+	*
+	* Must be called every frame, after the frame graph has been baked (as G-buffer attachments are bound).
+	*/
+	void DeferredLightingPipelinePass::Prepare(RenderFrame& renderFrame, const BakedFrameGraph& bakedGraph, const std::vector<std::size_t>& visibleLights)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		static LightingDataOffsets lightingDataOffsets = GetLightingDataOffsets();
+		static PredefinedLightData lightOffsets = PredefinedLightData::GetOffsets();
+
+		// Shadow casting lights go first, as they're evaluated for every pixel
+		m_lights.clear();
+		m_lightIndices.clear();
+
+		std::array<const Texture*, MaxShadowedLightCount> shadowMaps;
+		shadowMaps.fill(nullptr);
+
+		for (std::size_t lightIndex : visibleLights)
+		{
+			if (m_lights.size() >= MaxShadowedLightCount)
+				break;
+
+			const Texture* shadowMap = m_pipeline.RetrieveLightShadowmap(lightIndex, m_viewer);
+			if (!shadowMap)
+				continue;
+
+			shadowMaps[m_lights.size()] = shadowMap;
+			m_lights.push_back(m_pipeline.RetrieveLight(lightIndex));
+			m_lightIndices.push_back(lightIndex);
+		}
+		m_shadowedLightCount = m_lights.size();
+
+		for (std::size_t lightIndex : visibleLights)
+		{
+			if (std::find(m_lightIndices.begin(), m_lightIndices.begin() + m_shadowedLightCount, lightIndex) != m_lightIndices.begin() + m_shadowedLightCount)
+				continue;
+
+			const Light* light = m_pipeline.RetrieveLight(lightIndex);
+			if (light->GetBoundingVolume().IsNull())
+				continue; //< null volumes don't light anything
+
+			m_lights.push_back(light);
+			m_lightIndices.push_back(lightIndex);
+		}
+
+		Recti viewport = m_viewer->GetRenderViewport();
+		if (viewport != m_lastViewport)
+		{
+			m_lastViewport = viewport;
+			m_rebuildCommandBuffer = true;
+		}
+
+		std::size_t lightBufferSize = m_lights.size() * lightOffsets.lightSize;
+		std::size_t tileDataSize = ComputeTileDataSize(viewport);
+
+		bool rebuildBinding = !m_shaderBinding;
+		rebuildBinding |= EnsureStorageBuffer(m_lightBuffer, lightBufferSize, renderFrame, "Deferred lights");
+		rebuildBinding |= EnsureStorageBuffer(m_tileBuffer, tileDataSize, renderFrame, "Deferred light tiles");
+
+		for (std::size_t i = 0; i < GBufferCount + 1; ++i)
+		{
+			const Texture* texture = bakedGraph.GetAttachmentTexture((i < GBufferCount) ? m_gbufferAttachments[i] : m_depthAttachment).get();
+			if (m_boundTextures[i] != texture)
+			{
+				m_boundTextures[i] = texture;
+				rebuildBinding = true;
+			}
+		}
+
+		if (m_shadowMaps != shadowMaps)
+		{
+			m_shadowMaps = shadowMaps;
+			rebuildBinding = true;
+		}
+
+		if (rebuildBinding)
+		{
+			UpdateShaderBinding(renderFrame);
+			m_rebuildCommandBuffer = true;
+		}
+
+		UploadPool& uploadPool = renderFrame.GetUploadPool();
+
+		auto& lightingDataAllocation = uploadPool.Allocate(lightingDataOffsets.totalSize);
+		{
+			const Color& clearColor = m_viewer->GetClearColor();
+			Vector2f invFrameSize = 1.f / Vector2f(renderFrame.GetSize());
+
+			AccessByOffset<Vector4f&>(lightingDataAllocation.mappedPtr, lightingDataOffsets.clearColor) = Vector4f(clearColor.r, clearColor.g, clearColor.b, clearColor.a);
+			AccessByOffset<Vector4f&>(lightingDataAllocation.mappedPtr, lightingDataOffsets.renderRect) = Vector4f(viewport.x * invFrameSize.x, viewport.y * invFrameSize.y, viewport.width * invFrameSize.x, viewport.height * invFrameSize.y);
+			AccessByOffset<Vector2f&>(lightingDataAllocation.mappedPtr, lightingDataOffsets.tileScale) = Vector2f(float(viewport.width), float(viewport.height)) / float(TileSize);
+			AccessByOffset<UInt32&>(lightingDataAllocation.mappedPtr, lightingDataOffsets.tileCountX) = SafeCast<UInt32>(m_tileCountX);
+			AccessByOffset<UInt32&>(lightingDataAllocation.mappedPtr, lightingDataOffsets.tileCountY) = SafeCast<UInt32>(m_tileCountY);
+			AccessByOffset<UInt32&>(lightingDataAllocation.mappedPtr, lightingDataOffsets.shadowedLightCount) = SafeCast<UInt32>(m_shadowedLightCount);
+		}
+
+		UploadPool::Allocation* lightAllocation = nullptr;
+		if (lightBufferSize > 0)
+		{
+			lightAllocation = &uploadPool.Allocate(lightBufferSize);
+
+			UInt8* lightPtr = static_cast<UInt8*>(lightAllocation->mappedPtr);
+			for (std::size_t i = 0; i < m_lights.size(); ++i)
+			{
+				m_lights[i]->FillLightData(lightPtr);
+				if (const LightShadowData* shadowData = m_pipeline.RetrieveLightShadowData(m_lightIndices[i]))
+					shadowData->FillShadowData(lightPtr, m_viewer);
+
+				lightPtr += lightOffsets.lightSize;
+			}
+		}
+
+		auto& tileAllocation = uploadPool.Allocate(tileDataSize);
+		BinLights(tileAllocation.mappedPtr);
+
+		renderFrame.Execute([&](CommandBufferBuilder& builder)
+		{
+			builder.BeginDebugRegion("Deferred lights update", Color::Yellow());
+			{
+				builder.CopyBuffer(lightingDataAllocation, RenderBufferView(m_lightingDataBuffer.get(), 0, lightingDataOffsets.totalSize));
+				if (lightAllocation)
+					builder.CopyBuffer(*lightAllocation, RenderBufferView(m_lightBuffer.get(), 0, lightBufferSize));
+				builder.CopyBuffer(tileAllocation, RenderBufferView(m_tileBuffer.get(), 0, tileDataSize));
+
+				builder.PostTransferBarrier();
+			}
+			builder.EndDebugRegion();
+		}, QueueType::Transfer);
+	}
+
+	/*!
+	* \brief Registers the lighting pass, reading the G-buffer and depth buffer filled by the geometry pass
+	*
+	* The depth buffer must be a depth-only format (depth-stencil textures can't be sampled).
+	*/
+	FramePass& DeferredLightingPipelinePass::RegisterToFrameGraph(FrameGraph& frameGraph, const std::array<std::size_t, GBufferCount>& gbufferIndices, std::size_t depthBufferIndex, std::size_t outputColorBufferIndex)
+	{
+		m_gbufferAttachments = gbufferIndices;
+		m_depthAttachment = depthBufferIndex;
+
+		FramePass& lightingPass = frameGraph.AddPass("Deferred lighting pass");
+		for (std::size_t gbufferIndex : gbufferIndices)
+			lightingPass.AddInput(gbufferIndex);
+
+		lightingPass.AddInput(depthBufferIndex);
+		lightingPass.AddOutput(outputColorBufferIndex);
+		lightingPass.SetClearColor(0, m_viewer->GetClearColor());
+
+		lightingPass.SetExecutionCallback([&]()
+		{
+			return (m_rebuildCommandBuffer) ? FramePassExecution::UpdateAndExecute : FramePassExecution::Execute;
+		});
+
+		lightingPass.SetCommandCallback([this](CommandBufferBuilder& builder, const FramePassEnvironment& /*env*/)
+		{
+			Recti viewport = m_viewer->GetRenderViewport();
+
+			builder.SetScissor(viewport);
+			builder.SetViewport(viewport);
+
+			builder.BindRenderPipeline(*Graphics::Instance()->GetDeferredLightingPipeline());
+			builder.BindRenderShaderBinding(0, *m_shaderBinding);
+			builder.Draw(3);
+
+			m_rebuildCommandBuffer = false;
+		});
+
+		return lightingPass;
+	}
+
+	void DeferredLightingPipelinePass::BinLights(void* tileDataPtr)
+	{
+		std::size_t tileCount = std::size_t(m_tileCountX) * m_tileCountY;
+
+		UInt32* tileData = static_cast<UInt32*>(tileDataPtr);
+		for (std::size_t tileIndex = 0; tileIndex < tileCount; ++tileIndex)
+		{
+			UInt32* header = &tileData[tileIndex * 4];
+			header[0] = m_tileOffsets[tileIndex];
+			header[1] = m_tileLightCounts[tileIndex];
+			header[2] = 0;
+			header[3] = 0;
+		}
+
+		// Reuse counts as write cursors
+		std::fill(m_tileLightCounts.begin(), m_tileLightCounts.end(), 0);
+
+		for (std::size_t i = 0; i < m_lightTileRanges.size(); ++i)
+		{
+			const LightTileRange& range = m_lightTileRanges[i];
+			UInt32 lightIndex = SafeCast<UInt32>(m_shadowedLightCount + i);
+
+			for (unsigned int y = range.firstY; y <= range.lastY; ++y)
+			{
+				for (unsigned int x = range.firstX; x <= range.lastX; ++x)
+				{
+					std::size_t tileIndex = std::size_t(y) * m_tileCountX + x;
+					tileData[m_tileOffsets[tileIndex] * 4 + m_tileLightCounts[tileIndex]++] = lightIndex;
+				}
+			}
+		}
+	}
+
+	std::size_t DeferredLightingPipelinePass::ComputeTileDataSize(const Recti& viewport)
+	{
+		m_tileCountX = std::max((SafeCast<unsigned int>(viewport.width) + TileSize - 1) / TileSize, 1u);
+		m_tileCountY = std::max((SafeCast<unsigned int>(viewport.height) + TileSize - 1) / TileSize, 1u);
+
+		const Matrix4f& viewProjMatrix = m_viewer->GetViewerInstance().GetViewProjMatrix();
+		Vector2f tileScale = Vector2f(float(viewport.width), float(viewport.height)) / float(TileSize);
+
+		// Compute the screen tiles overlapped by the bounds of every unshadowed light
+		m_lightTileRanges.clear();
+		for (std::size_t i = m_shadowedLightCount; i < m_lights.size(); ++i)
+		{
+			LightTileRange& range = m_lightTileRanges.emplace_back();
+			range.firstX = 0;
+			range.firstY = 0;
+			range.lastX = m_tileCountX - 1;
+			range.lastY = m_tileCountY - 1;
+
+			const BoundingVolumef& boundingVolume = m_lights[i]->GetBoundingVolume();
+			if (!boundingVolume.IsFinite())
+				continue;
+
+			Vector2f minCoords(std::numeric_limits<float>::infinity());
+			Vector2f maxCoords(-std::numeric_limits<float>::infinity());
+
+			bool isBehindViewer = false;
+			for (const Vector3f& corner : boundingVolume.aabb.GetCorners())
+			{
+				Vector4f clipPos = viewProjMatrix.Transform(Vector4f(corner, 1.f));
+				if (clipPos.w <= 0.f)
+				{
+					// Bounds cross the near plane, keep the whole screen
+					isBehindViewer = true;
+					break;
+				}
+
+				Vector2f tileCoords = (Vector2f(clipPos.x, clipPos.y) / clipPos.w * 0.5f + Vector2f(0.5f)) * tileScale;
+				minCoords.Minimize(tileCoords);
+				maxCoords.Maximize(tileCoords);
+			}
+
+			if (isBehindViewer)
+				continue;
+
+			minCoords.x = std::clamp(minCoords.x, 0.f, float(m_tileCountX - 1));
+			minCoords.y = std::clamp(minCoords.y, 0.f, float(m_tileCountY - 1));
+			maxCoords.x = std::clamp(maxCoords.x, 0.f, float(m_tileCountX - 1));
+			maxCoords.y = std::clamp(maxCoords.y, 0.f, float(m_tileCountY - 1));
+
+			range.firstX = static_cast<unsigned int>(minCoords.x);
+			range.firstY = static_cast<unsigned int>(minCoords.y);
+			range.lastX = static_cast<unsigned int>(maxCoords.x);
+			range.lastY = static_cast<unsigned int>(maxCoords.y);
+		}
+
+		std::size_t tileCount = std::size_t(m_tileCountX) * m_tileCountY;
+
+		m_tileLightCounts.assign(tileCount, 0);
+		for (const LightTileRange& range : m_lightTileRanges)
+		{
+			for (unsigned int y = range.firstY; y <= range.lastY; ++y)
+			{
+				for (unsigned int x = range.firstX; x <= range.lastX; ++x)
+					m_tileLightCounts[std::size_t(y) * m_tileCountX + x]++;
+			}
+		}
+
+		// Light indices of every tile start on a new entry, after the tile headers
+		m_tileOffsets.resize(tileCount);
+
+		std::size_t entryCount = tileCount;
+		for (std::size_t tileIndex = 0; tileIndex < tileCount; ++tileIndex)
+		{
+			m_tileOffsets[tileIndex] = SafeCast<UInt32>(entryCount);
+			entryCount += (m_tileLightCounts[tileIndex] + 3) / 4;
+		}
+
+		return entryCount * TileEntrySize;
+	}
+
+	void DeferredLightingPipelinePass::UpdateShaderBinding(RenderFrame& renderFrame)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		static LightingDataOffsets lightingDataOffsets = GetLightingDataOffsets();
+
+		Graphics* graphics = Graphics::Instance();
+
+		if (m_shaderBinding)
+			renderFrame.PushForRelease(std::move(m_shaderBinding));
+
+		m_shaderBinding = graphics->GetDeferredLightingPipelineLayout()->AllocateShaderBinding(0);
+
+		TextureSamplerInfo gbufferSamplerInfo;
+		gbufferSamplerInfo.magFilter = SamplerFilter::Nearest;
+		gbufferSamplerInfo.minFilter = SamplerFilter::Nearest;
+		gbufferSamplerInfo.mipmapMode = SamplerMipmapMode::Nearest;
+		const auto& gbufferSampler = graphics->GetSamplerCache().Get(gbufferSamplerInfo);
+
+		TextureSamplerInfo shadowSamplerInfo;
+		shadowSamplerInfo.depthCompare = true;
+		const auto& shadowSampler = graphics->GetSamplerCache().Get(shadowSamplerInfo);
+		const auto& defaultSampler = graphics->GetSamplerCache().Get({});
+
+		const auto& depthTextures = graphics->GetDefaultTextures().depthTextures;
+
+		// Shadow maps are bound to the array matching their type, others entries get a default texture
+		std::array<ShaderBinding::SampledTextureBinding, MaxShadowedLightCount * 3> shadowMapBindings;
+		for (std::size_t i = 0; i < MaxShadowedLightCount; ++i)
+		{
+			const Texture* shadowMap = m_shadowMaps[i];
+			ImageType shadowMapType = (shadowMap) ? shadowMap->GetType() : ImageType::E2D;
+
+			shadowMapBindings[i] = { (shadowMapType == ImageType::E2D && shadowMap) ? shadowMap : depthTextures[ImageType::E2D].get(), shadowSampler.get() };
+			shadowMapBindings[MaxShadowedLightCount + i] = { (shadowMapType == ImageType::Cubemap) ? shadowMap : depthTextures[ImageType::Cubemap].get(), defaultSampler.get() }; //< cube shadowmap don't use depth compare
+			shadowMapBindings[MaxShadowedLightCount * 2 + i] = { (shadowMapType == ImageType::E2D_Array) ? shadowMap : depthTextures[ImageType::E2D_Array].get(), shadowSampler.get() };
+		}
+
+		std::vector<ShaderBinding::Binding> bindings;
+		bindings.reserve(4 + GBufferCount + 1 + 3);
+
+		bindings.push_back({
+			0,
+			ShaderBinding::UniformBufferBinding {
+				m_viewer->GetViewerInstance().GetViewerBuffer().get(),
+				0, m_viewer->GetViewerInstance().GetViewerBuffer()->GetSize()
+			}
+		});
+
+		bindings.push_back({
+			1,
+			ShaderBinding::UniformBufferBinding {
+				m_lightingDataBuffer.get(),
+				0, lightingDataOffsets.totalSize
+			}
+		});
+
+		bindings.push_back({
+			2,
+			ShaderBinding::StorageBufferBinding {
+				m_lightBuffer.get(),
+				0, m_lightBuffer->GetSize()
+			}
+		});
+
+		bindings.push_back({
+			3,
+			ShaderBinding::StorageBufferBinding {
+				m_tileBuffer.get(),
+				0, m_tileBuffer->GetSize()
+			}
+		});
+
+		for (std::size_t i = 0; i < GBufferCount + 1; ++i)
+		{
+			bindings.push_back({
+				SafeCast<UInt32>(4 + i),
+				ShaderBinding::SampledTextureBinding {
+					m_boundTextures[i],
+					gbufferSampler.get()
+				}
+			});
+		}
+
+		for (std::size_t i = 0; i < 3; ++i)
+		{
+			bindings.push_back({
+				SafeCast<UInt32>(4 + GBufferCount + 1 + i),
+				ShaderBinding::SampledTextureBindings {
+					SafeCast<UInt32>(MaxShadowedLightCount), &shadowMapBindings[i * MaxShadowedLightCount]
+				}
+			});
+		}
+
+		m_shaderBinding->Update(bindings.data(), bindings.size());
+	}
+}
@@ -39,7 +39,8 @@ namespace Nz
 				InstancedRenderable::ElementData elementData{
 					&renderableData.scissorBox,
 					renderableData.skeletonInstance,
-					renderableData.worldInstance
+					renderableData.worldInstance,
+					renderableData.lodIndex
 				};
 
 				renderableData.instancedRenderable->BuildElement(m_elementRegistry, elementData, m_passIndex, m_renderElements);
@@ -101,6 +102,12 @@ namespace Nz
 			m_rebuildCommandBuffer = true;
 			m_rebuildElements = false;
 		}
+
+		m_elementRegistry.ForEachElementRenderer([&](std::size_t elementType, ElementRenderer& elementRenderer)
+		{
+			if (elementType < m_elementRendererData.size() && m_elementRendererData[elementType])
+				elementRenderer.Update(renderFrame, *m_elementRendererData[elementType]);
+		});
 	}
 
 	void DepthPipelinePass::RegisterMaterialInstance(const MaterialInstance& materialInstance)
@@ -130,9 +137,24 @@ namespace Nz
 	}
 
 	FramePass& DepthPipelinePass::RegisterToFrameGraph(FrameGraph& frameGraph, std::size_t outputAttachment)
+	{
+		return RegisterToFrameGraph(frameGraph, {}, outputAttachment);
+	}
+
+	/*!
+	* \brief Registers the pass with color outputs (cleared to zero) written by the material pass alongside depth, such as the G-buffer of deferred shading
+	*/
+	FramePass& DepthPipelinePass::RegisterToFrameGraph(FrameGraph& frameGraph, std::initializer_list<std::size_t> colorOutputAttachments, std::size_t depthOutputAttachment)
 	{
 		FramePass& depthPrepass = frameGraph.AddPass(m_passName);
-		depthPrepass.SetDepthStencilOutput(outputAttachment);
+
+		for (std::size_t colorOutputAttachment : colorOutputAttachments)
+		{
+			std::size_t outputIndex = depthPrepass.AddOutput(colorOutputAttachment);
+			depthPrepass.SetClearColor(outputIndex, Color(0.f, 0.f, 0.f, 0.f));
+		}
+
+		depthPrepass.SetDepthStencilOutput(depthOutputAttachment);
 		depthPrepass.SetDepthStencilClear(1.f, 0);
 
 		depthPrepass.SetExecutionCallback([&]()
@@ -142,7 +164,7 @@ namespace Nz
 
 		depthPrepass.SetCommandCallback([this](CommandBufferBuilder& builder, const FramePassEnvironment& /*env*/)
 		{
-			Recti viewport = m_viewer->GetViewport();
+			Recti viewport = m_viewer->GetRenderViewport();
 
 			builder.SetScissor(viewport);
 			builder.SetViewport(viewport);
@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Graphics/DirectionalLight.hpp>
+#include <Nazara/Graphics/DirectionalLightShadowData.hpp>
 #include <Nazara/Graphics/Enums.hpp>
 #include <Nazara/Graphics/Graphics.hpp>
 #include <Nazara/Graphics/PredefinedShaderStructs.hpp>
@@ -14,7 +15,7 @@
 
 namespace Nz
 {
-	float DirectionalLight::ComputeContributionScore(const BoundingVolumef& /*boundingVolume*/) const
+	float DirectionalLight::ComputeContributionScore(const Boxf& /*worldAABB*/) const
 	{
 		return -std::numeric_limits<float>::infinity();
 	}
@@ -27,12 +28,15 @@ namespace Nz
 		AccessByOffset<Vector4f&>(data, lightOffset.lightMemberOffsets.color) = Vector4f(m_color.r, m_color.g, m_color.b, m_color.a);
 		AccessByOffset<Vector2f&>(data, lightOffset.lightMemberOffsets.factor) = Vector2f(m_ambientFactor, m_diffuseFactor);
 		AccessByOffset<Vector4f&>(data, lightOffset.lightMemberOffsets.parameter1) = Vector4f(m_direction.x, m_direction.y, m_direction.z, 0.f);
-		AccessByOffset<Vector2f&>(data, lightOffset.lightMemberOffsets.shadowMapSize) = Vector2f(-1.f, -1.f);
+		AccessByOffset<Vector2f&>(data, lightOffset.lightMemberOffsets.shadowMapSize) = (IsShadowCaster()) ? Vector2f(1.f / GetShadowMapSize()) : Vector2f(-1.f, -1.f);
+
+		// Cascades depend on the viewer, they are filled by the shadow data
+		AccessByOffset<UInt32&>(data, lightOffset.lightMemberOffsets.cascadeCount) = 0;
 	}
 
 	std::unique_ptr<LightShadowData> DirectionalLight::InstanciateShadowData(FramePipeline& pipeline, ElementRendererRegistry& elementRegistry) const
 	{
-		return nullptr; //< TODO
+		return std::make_unique<DirectionalLightShadowData>(pipeline, elementRegistry, *this);
 	}
 
 	void DirectionalLight::UpdateTransform(const Vector3f& /*position*/, const Quaternionf& rotation, const Vector3f& /*scale*/)
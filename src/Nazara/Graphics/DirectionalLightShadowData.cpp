@@ -0,0 +1,363 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/DirectionalLightShadowData.hpp>
+#include <Nazara/Graphics/AbstractViewer.hpp>
+#include <Nazara/Graphics/BakedFrameGraph.hpp>
+#include <Nazara/Graphics/DirectionalLight.hpp>
+#include <Nazara/Graphics/FrameGraph.hpp>
+#include <Nazara/Graphics/FramePipeline.hpp>
+#include <Nazara/Graphics/Graphics.hpp>
+#include <Nazara/Math/Vector4.hpp>
+#include <Nazara/Renderer/RenderFrame.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <string>
+#include <string_view>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		using CascadeArray = std::array<std::size_t, DirectionalLightShadowData::CascadeCount>;
+
+		// Far cascades cover a larger area with the same resolution, they can be refitted less often
+		constexpr CascadeArray s_cascadeUpdateIntervals = { 1, 1, 2, 4 };
+
+		constexpr std::array<std::string_view, DirectionalLightShadowData::CascadeCount> s_cascadeNames = {
+			"Directional-light shadow mapping (cascade #0)",
+			"Directional-light shadow mapping (cascade #1)",
+			"Directional-light shadow mapping (cascade #2)",
+			"Directional-light shadow mapping (cascade #3)"
+		};
+
+		// Blend factor between logarithmic (1) and uniform (0) cascade splits
+		constexpr float s_cascadeSplitLambda = 0.75f;
+
+		// Throttled cascades are fitted around a slightly larger area to keep covering their slice while the viewer moves
+		constexpr float s_throttledCascadeMargin = 0.1f;
+	}
+
+	DirectionalLightShadowData::DirectionalLightShadowData(FramePipeline& pipeline, ElementRendererRegistry& elementRegistry, const DirectionalLight& light) :
+	m_elementRegistry(elementRegistry),
+	m_pipeline(pipeline),
+	m_light(light)
+	{
+		UpdatePerViewerStatus(true);
+
+		m_shadowPassIndex = Graphics::Instance()->GetMaterialPassRegistry().GetPassIndex("ShadowPass");
+
+		m_onLightDataInvalidated.Connect(m_light.OnLightDataInvalided, [this]([[maybe_unused]] Light* light)
+		{
+			assert(&m_light == light);
+
+			// Direction or shadow distance may have changed
+			for (auto&& [viewer, viewerData] : m_viewerData)
+			{
+				for (CascadeData& cascade : viewerData->cascades)
+					cascade.isFitted = false;
+			}
+		});
+
+		m_onLightShadowMapSettingChange.Connect(m_light.OnLightShadowMapSettingChange, [this](Light* /*light*/, PixelFormat /*newPixelFormat*/, UInt32 newSize)
+		{
+			for (auto&& [viewer, viewerData] : m_viewerData)
+			{
+				for (CascadeData& cascade : viewerData->cascades)
+				{
+					cascade.viewer.UpdateViewport(Recti(0, 0, SafeCast<int>(newSize), SafeCast<int>(newSize)));
+					cascade.isFitted = false; //< texel size changed
+				}
+			}
+		});
+	}
+
+	void DirectionalLightShadowData::FillShadowData(void* data, const AbstractViewer* viewer) const
+	{
+		static_assert(CascadeCount == 4, "cascade distances are stored in a vec4");
+
+		auto it = m_viewerData.find(viewer);
+		if (it == m_viewerData.end() || !it->second->hasCascades)
+			return; //< cascade count is left to zero by the light
+
+		const ViewerData& viewerData = *it->second;
+
+		auto lightOffset = PredefinedLightData::GetOffsets();
+
+		AccessByOffset<UInt32&>(data, lightOffset.lightMemberOffsets.cascadeCount) = SafeCast<UInt32>(CascadeCount);
+		AccessByOffset<Vector4f&>(data, lightOffset.lightMemberOffsets.cascadeDistances) = Vector4f(viewerData.splitDistances[0], viewerData.splitDistances[1], viewerData.splitDistances[2], viewerData.splitDistances[3]);
+
+		Matrix4f* cascadeMatrices = AccessByOffset<Matrix4f*>(data, lightOffset.lightMemberOffsets.cascadeViewProjMatrices);
+		for (std::size_t i = 0; i < CascadeCount; ++i)
+			cascadeMatrices[i] = viewerData.cascades[i].shadowMatrix;
+	}
+
+	void DirectionalLightShadowData::PrepareRendering(RenderFrame& renderFrame, const AbstractViewer* viewer)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		assert(viewer);
+		auto it = m_viewerData.find(viewer);
+		assert(it != m_viewerData.end());
+
+		ViewerData& viewerData = *it->second;
+
+		std::array<CascadeBounds, CascadeCount> cascadeBounds;
+		ComputeCascadeBounds(viewer->GetViewerInstance(), viewerData, cascadeBounds);
+		if (!viewerData.hasCascades)
+			return;
+
+		Matrix4f lightViewMatrix = Matrix4f::TransformInverse(Vector3f::Zero(), m_light.GetRotation());
+
+		for (std::size_t cascadeIndex = 0; cascadeIndex < CascadeCount; ++cascadeIndex)
+		{
+			CascadeData& cascade = viewerData.cascades[cascadeIndex];
+			const CascadeBounds& bounds = cascadeBounds[cascadeIndex];
+
+			std::size_t updateInterval = s_cascadeUpdateIntervals[cascadeIndex];
+
+			// Cascades are updated in turns (staggered by their index) to spread the cost over frames
+			bool refit;
+			if (!cascade.isFitted || (viewerData.frameIndex + cascadeIndex) % updateInterval == 0)
+				refit = true;
+			else
+			{
+				// Don't wait for the next update if the cascade no longer covers its slice of the viewer frustum
+				Vector3f offset = lightViewMatrix.Transform(bounds.center) - cascade.lightSpaceCenter;
+				float maxOffset = cascade.radius - bounds.radius;
+
+				refit = (std::abs(offset.x) > maxOffset || std::abs(offset.y) > maxOffset || std::abs(offset.z) > maxOffset);
+			}
+
+			if (refit)
+				FitCascade(cascade, bounds, (updateInterval > 1) ? s_throttledCascadeMargin : 0.f);
+
+			// Renderables may have moved or been removed, culling is still done every frame (depth passes only rebuild their elements if the visible set changed)
+			std::size_t visibilityHash = 5U;
+			const auto& visibleRenderables = m_pipeline.FrustumCull(cascade.frustum, 0xFFFFFFFF, visibilityHash);
+
+			cascade.depthPass->Prepare(renderFrame, cascade.frustum, visibleRenderables, visibilityHash);
+		}
+
+		viewerData.frameIndex++;
+	}
+
+	void DirectionalLightShadowData::RegisterMaterialInstance(const MaterialInstance& matInstance)
+	{
+		for (auto&& [viewer, viewerData] : m_viewerData)
+		{
+			for (CascadeData& cascade : viewerData->cascades)
+				cascade.depthPass->RegisterMaterialInstance(matInstance);
+		}
+	}
+
+	void DirectionalLightShadowData::RegisterPassInputs(FramePass& pass, const AbstractViewer* viewer)
+	{
+		auto it = m_viewerData.find(viewer);
+		assert(it != m_viewerData.end());
+
+		ViewerData& viewerData = *it->second;
+
+		std::size_t arrayInputIndex = pass.AddInput(viewerData.textureArrayAttachmentIndex);
+		pass.SetInputLayout(arrayInputIndex, TextureLayout::ColorInput);
+
+		for (CascadeData& cascade : viewerData.cascades)
+			pass.AddInput(cascade.attachmentIndex);
+	}
+
+	void DirectionalLightShadowData::RegisterToFrameGraph(FrameGraph& frameGraph, const AbstractViewer* viewer)
+	{
+		auto it = m_viewerData.find(viewer);
+		assert(it != m_viewerData.end());
+
+		ViewerData& viewerData = *it->second;
+
+		UInt32 shadowMapSize = m_light.GetShadowMapSize();
+
+		viewerData.textureArrayAttachmentIndex = frameGraph.AddAttachmentArray({
+			"Directional-light shadowmap",
+			m_light.GetShadowMapFormat(),
+			FramePassAttachmentSize::Fixed,
+			shadowMapSize, shadowMapSize,
+		}, CascadeCount);
+
+		for (std::size_t i = 0; i < CascadeCount; ++i)
+		{
+			CascadeData& cascade = viewerData.cascades[i];
+			cascade.attachmentIndex = frameGraph.AddAttachmentArrayLayer(viewerData.textureArrayAttachmentIndex, i);
+			cascade.depthPass->RegisterToFrameGraph(frameGraph, cascade.attachmentIndex);
+		}
+	}
+
+	void DirectionalLightShadowData::RegisterViewer(const AbstractViewer* viewer)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		assert(m_viewerData.find(viewer) == m_viewerData.end());
+
+		auto viewerData = std::make_unique<ViewerData>();
+
+		UInt32 shadowMapSize = m_light.GetShadowMapSize();
+		for (std::size_t i = 0; i < CascadeCount; ++i)
+		{
+			CascadeData& cascade = viewerData->cascades[i];
+			cascade.viewer.UpdateRenderMask(0xFFFFFFFF);
+			cascade.viewer.UpdateViewport(Recti(0, 0, SafeCast<int>(shadowMapSize), SafeCast<int>(shadowMapSize)));
+
+			cascade.depthPass.emplace(m_pipeline, m_elementRegistry, &cascade.viewer, m_shadowPassIndex, std::string(s_cascadeNames[i]));
+		}
+
+		m_pipeline.ForEachRegisteredMaterialInstance([&](const MaterialInstance& matInstance)
+		{
+			for (CascadeData& cascade : viewerData->cascades)
+				cascade.depthPass->RegisterMaterialInstance(matInstance);
+		});
+
+		m_viewerData.emplace(viewer, std::move(viewerData));
+	}
+
+	const Texture* DirectionalLightShadowData::RetrieveLightShadowmap(const BakedFrameGraph& bakedGraph, const AbstractViewer* viewer) const
+	{
+		auto it = m_viewerData.find(viewer);
+		if (it == m_viewerData.end())
+			return nullptr;
+
+		return bakedGraph.GetAttachmentTexture(it->second->textureArrayAttachmentIndex).get();
+	}
+
+	void DirectionalLightShadowData::UnregisterMaterialInstance(const MaterialInstance& matInstance)
+	{
+		for (auto&& [viewer, viewerData] : m_viewerData)
+		{
+			for (CascadeData& cascade : viewerData->cascades)
+				cascade.depthPass->UnregisterMaterialInstance(matInstance);
+		}
+	}
+
+	void DirectionalLightShadowData::UnregisterViewer(RenderFrame& renderFrame, const AbstractViewer* viewer)
+	{
+		auto it = m_viewerData.find(viewer);
+		if (it == m_viewerData.end())
+			return;
+
+		// Cascade passes may still be used by the GPU
+		renderFrame.PushForRelease(std::move(it->second));
+		m_viewerData.erase(it);
+	}
+
+	void DirectionalLightShadowData::ComputeCascadeBounds(const ViewerInstance& viewerInstance, ViewerData& viewerData, std::array<CascadeBounds, CascadeCount>& cascadeBounds) const
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		const Matrix4f& invViewProjMatrix = viewerInstance.GetInvViewProjMatrix();
+		const Matrix4f& viewMatrix = viewerInstance.GetViewMatrix();
+
+		// Viewer frustum corners, near plane ones first (depth goes from 0 to 1)
+		std::array<Vector3f, 8> frustumCorners;
+		for (std::size_t i = 0; i < frustumCorners.size(); ++i)
+		{
+			Vector4f corner = invViewProjMatrix.Transform(Vector4f((i & 1) ? 1.f : -1.f, (i & 2) ? 1.f : -1.f, (i & 4) ? 1.f : 0.f, 1.f));
+			frustumCorners[i] = Vector3f(corner.x, corner.y, corner.z) / corner.w;
+		}
+
+		auto GetViewDepth = [&](const Vector3f& position)
+		{
+			return -viewMatrix.Transform(position).z;
+		};
+
+		float nearDepth = GetViewDepth(frustumCorners[0]);
+		float farDepth = GetViewDepth(frustumCorners[4]);
+		float maxDepth = std::min(farDepth, m_light.GetShadowMaxDistance());
+
+		viewerData.hasCascades = (maxDepth > nearDepth);
+		if (!viewerData.hasCascades)
+			return;
+
+		float invDepthRange = 1.f / (farDepth - nearDepth);
+		float logNearDepth = std::max(nearDepth, 0.01f);
+
+		float sliceNearDepth = nearDepth;
+		for (std::size_t cascadeIndex = 0; cascadeIndex < CascadeCount; ++cascadeIndex)
+		{
+			// Practical split scheme (blend of logarithmic and uniform splits)
+			float ratio = float(cascadeIndex + 1) / CascadeCount;
+			float logSplit = logNearDepth * std::pow(maxDepth / logNearDepth, ratio);
+			float uniformSplit = nearDepth + (maxDepth - nearDepth) * ratio;
+			float sliceFarDepth = s_cascadeSplitLambda * logSplit + (1.f - s_cascadeSplitLambda) * uniformSplit;
+
+			// Frustum edges are linear with view depth
+			std::array<Vector3f, 8> sliceCorners;
+			for (std::size_t i = 0; i < 4; ++i)
+			{
+				Vector3f edge = frustumCorners[i + 4] - frustumCorners[i];
+				sliceCorners[i] = frustumCorners[i] + edge * ((sliceNearDepth - nearDepth) * invDepthRange);
+				sliceCorners[i + 4] = frustumCorners[i] + edge * ((sliceFarDepth - nearDepth) * invDepthRange);
+			}
+
+			// Fit a sphere rather than a box, its size doesn't depend on the viewer orientation
+			Vector3f center = Vector3f::Zero();
+			for (const Vector3f& corner : sliceCorners)
+				center += corner;
+
+			center /= float(sliceCorners.size());
+
+			float radius = 0.f;
+			for (const Vector3f& corner : sliceCorners)
+				radius = std::max(radius, Vector3f::Distance(center, corner));
+
+			cascadeBounds[cascadeIndex] = { center, radius };
+			viewerData.splitDistances[cascadeIndex] = sliceFarDepth;
+
+			sliceNearDepth = sliceFarDepth;
+		}
+	}
+
+	bool DirectionalLightShadowData::FitCascade(CascadeData& cascade, const CascadeBounds& bounds, float radiusMargin)
+	{
+		// Round the radius so float imprecisions don't change the texel size when the viewer rotates
+		float radius = std::ceil(bounds.radius * (1.f + radiusMargin) * 16.f) / 16.f;
+
+		// Light view only rotates, the cascade position is handled by the projection
+		Matrix4f lightViewMatrix = Matrix4f::TransformInverse(Vector3f::Zero(), m_light.GetRotation());
+
+		// Snap the cascade to shadow map texels so static shadows don't shimmer when the viewer moves
+		float texelSize = 2.f * radius / m_light.GetShadowMapSize();
+
+		Vector3f lightSpaceCenter = lightViewMatrix.Transform(bounds.center);
+		lightSpaceCenter.x = std::floor(lightSpaceCenter.x / texelSize) * texelSize;
+		lightSpaceCenter.y = std::floor(lightSpaceCenter.y / texelSize) * texelSize;
+		lightSpaceCenter.z = std::floor(lightSpaceCenter.z / texelSize) * texelSize;
+
+		if (cascade.isFitted && cascade.radius == radius && cascade.lightSpaceCenter == lightSpaceCenter)
+			return false;
+
+		// Shadow casters between the light and the cascade have to be rendered as well, extend the depth range toward the light
+		float casterDistance = m_light.GetShadowMaxDistance();
+		float zNear = -lightSpaceCenter.z - radius - casterDistance;
+		float zFar = -lightSpaceCenter.z + radius;
+
+		Matrix4f projectionMatrix = Matrix4f::Ortho(lightSpaceCenter.x - radius, lightSpaceCenter.x + radius, lightSpaceCenter.y - radius, lightSpaceCenter.y + radius, zNear, zFar);
+
+		ViewerInstance& viewerInstance = cascade.viewer.GetViewerInstance();
+		viewerInstance.UpdateEyePosition(m_light.GetRotation() * (lightSpaceCenter + Vector3f::Backward() * (radius + casterDistance)));
+		viewerInstance.UpdateProjViewMatrices(projectionMatrix, lightViewMatrix);
+
+		m_pipeline.QueueTransfer(&viewerInstance);
+
+		Matrix4f biasMatrix(0.5f, 0.0f, 0.0f, 0.0f,
+		                    0.0f, 0.5f, 0.0f, 0.0f,
+		                    0.0f, 0.0f, 1.0f, 0.0f,
+		                    0.5f, 0.5f, 0.0f, 1.0f);
+
+		cascade.frustum = Frustumf::Extract(viewerInstance.GetViewProjMatrix());
+		cascade.shadowMatrix = viewerInstance.GetViewProjMatrix() * biasMatrix;
+		cascade.lightSpaceCenter = lightSpaceCenter;
+		cascade.radius = radius;
+		cascade.isFitted = true;
+
+		return true;
+	}
+}
@@ -17,9 +17,28 @@ namespace Nz
 	{
 	}
 
+	/*!
+	* \brief Called once per frame, after every pass was rendered
+	*
+	* \param currentFrame Frame being rendered
+	*/
+	void ElementRenderer::EndFrame(RenderFrame& /*currentFrame*/)
+	{
+	}
+
 	void ElementRenderer::Reset(ElementRendererData& /*rendererData*/, RenderFrame& /*currentFrame*/)
 	{
 	}
 
+	/*!
+	* \brief Called every frame (after Prepare and PrepareEnd when elements were rebuilt) to refresh per-frame data of prepared elements
+	*
+	* \param currentFrame Frame being rendered
+	* \param rendererData Renderer data passed to Prepare
+	*/
+	void ElementRenderer::Update(RenderFrame& /*currentFrame*/, ElementRendererData& /*rendererData*/)
+	{
+	}
+
 	ElementRendererData::~ElementRendererData() = default;
 }
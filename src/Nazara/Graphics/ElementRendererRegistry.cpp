@@ -5,10 +5,16 @@
 #include <Nazara/Graphics/ElementRendererRegistry.hpp>
 #include <Nazara/Graphics/Enums.hpp>
 #include <Nazara/Graphics/Graphics.hpp>
+#include <Nazara/Graphics/ImpostorRenderer.hpp>
+#include <Nazara/Graphics/ParticleRenderer.hpp>
+#include <Nazara/Graphics/RenderImpostor.hpp>
+#include <Nazara/Graphics/RenderParticles.hpp>
 #include <Nazara/Graphics/RenderSpriteChain.hpp>
 #include <Nazara/Graphics/RenderSubmesh.hpp>
+#include <Nazara/Graphics/RenderTerrain.hpp>
 #include <Nazara/Graphics/SpriteChainRenderer.hpp>
 #include <Nazara/Graphics/SubmeshRenderer.hpp>
+#include <Nazara/Graphics/TerrainRenderer.hpp>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
@@ -16,6 +22,15 @@ namespace Nz
 	ElementRendererRegistry::ElementRendererRegistry()
 	{
 		RegisterElementRenderer<RenderSpriteChain>(std::make_unique<SpriteChainRenderer>(*Graphics::Instance()->GetRenderDevice()));
-		RegisterElementRenderer<RenderSubmesh>(std::make_unique<SubmeshRenderer>());
+		RegisterElementRenderer<RenderSubmesh>(std::make_unique<SubmeshRenderer>(*Graphics::Instance()->GetRenderDevice()));
+
+		if (Graphics::Instance()->IsParticleSystemEnabled())
+			RegisterElementRenderer<RenderParticles>(std::make_unique<ParticleRenderer>(*Graphics::Instance()->GetRenderDevice()));
+
+		if (Graphics::Instance()->IsImpostorEnabled())
+			RegisterElementRenderer<RenderImpostor>(std::make_unique<ImpostorRenderer>(*Graphics::Instance()->GetRenderDevice()));
+
+		if (Graphics::Instance()->IsTerrainEnabled())
+			RegisterElementRenderer<RenderTerrain>(std::make_unique<TerrainRenderer>());
 	}
 }
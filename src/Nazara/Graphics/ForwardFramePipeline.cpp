@@ -3,15 +3,21 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Graphics/ForwardFramePipeline.hpp>
+#include <Nazara/Core/Core.hpp>
+#include <Nazara/Core/Profiler.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Graphics/AbstractViewer.hpp>
 #include <Nazara/Graphics/FrameGraph.hpp>
 #include <Nazara/Graphics/Graphics.hpp>
 #include <Nazara/Graphics/InstancedRenderable.hpp>
 #include <Nazara/Graphics/Material.hpp>
+#include <Nazara/Graphics/MaterialPipeline.hpp>
 #include <Nazara/Graphics/PointLight.hpp>
 #include <Nazara/Graphics/PredefinedShaderStructs.hpp>
 #include <Nazara/Graphics/RenderElement.hpp>
+#include <Nazara/Graphics/SkeletonInstance.hpp>
 #include <Nazara/Graphics/SpotLight.hpp>
+#include <Nazara/Graphics/TextureStreamer.hpp>
 #include <Nazara/Graphics/ViewerInstance.hpp>
 #include <Nazara/Graphics/WorldInstance.hpp>
 #include <Nazara/Math/Angle.hpp>
@@ -22,21 +28,220 @@
 #include <Nazara/Renderer/RenderTarget.hpp>
 #include <Nazara/Renderer/UploadPool.hpp>
 #include <NazaraUtils/StackArray.hpp>
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <limits>
+
+#if defined(NAZARA_ARCH_x86_64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define NAZARA_GRAPHICS_CULLING_SSE2
+#endif
+
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
 {
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		constexpr std::size_t CullingBatchSize = 4;
+		constexpr std::size_t CullingChunkSize = 1024;
+		constexpr std::size_t ParallelCullingThreshold = 4 * CullingChunkSize;
+
+		// Levels of detail are selected so their simplification error covers less than LODErrorThreshold pixels,
+		// a less detailed level is only selected once its error is below (1 - LODHysteresis) times the threshold to prevent popping back and forth
+		constexpr float LODErrorThreshold = 1.f;
+		constexpr float LODHysteresis = 0.25f;
+
+		// Render scale is only adjusted once the frame time has settled after the last change, and in steps of RenderScaleStep
+		// it's lowered above RenderScaleUpperMargin times the target frame time and raised below RenderScaleLowerMargin times it
+		constexpr float FrameTimeSmoothing = 0.2f;
+		constexpr float RenderScaleLowerMargin = 0.85f;
+		constexpr float RenderScaleUpperMargin = 1.05f;
+		constexpr float RenderScaleStep = 0.05f;
+		constexpr std::size_t RenderScaleMaxProbeInterval = 960;
+		constexpr std::size_t RenderScaleProbeInterval = 60;
+		constexpr std::size_t RenderScaleSettleFrames = 8;
+
+		// Baked frame graphs kept (with their textures) to switch back to them without stalling, when toggling a shadow caster for example
+		constexpr std::size_t FrameGraphCacheSize = 4;
+
+		constexpr std::size_t CombineHash(std::size_t currentHash, std::size_t newHash)
+		{
+			return currentHash * 23 + newHash;
+		}
+
+		// Frustum with the average orientation of two frustums, its planes are pushed back until every corner of both frustums is inside
+		// (frustums being convex, they're entirely inside as well)
+		Frustumf ComputeEnclosingFrustum(const Frustumf& first, const Frustumf& second)
+		{
+			EnumArray<BoxCorner, Vector3f> firstCorners = first.ComputeCorners();
+			EnumArray<BoxCorner, Vector3f> secondCorners = second.ComputeCorners();
+
+			EnumArray<FrustumPlane, Planef> planes;
+			for (auto&& [planeType, plane] : planes.iter_kv())
+			{
+				Vector3f normal = Vector3f::Normalize(first.GetPlane(planeType).normal + second.GetPlane(planeType).normal);
+
+				float distance = -std::numeric_limits<float>::infinity();
+				for (const Vector3f& corner : firstCorners)
+					distance = std::max(distance, -normal.DotProduct(corner));
+
+				for (const Vector3f& corner : secondCorners)
+					distance = std::max(distance, -normal.DotProduct(corner));
+
+				plane = Planef(normal, distance);
+			}
+
+			return Frustumf(planes);
+		}
+
+		// Approximates the projected size (in pixels) of a box by the size of its bounding sphere
+		float ComputeScreenSize(const Boxf& worldAABB, const Vector3f& eyePosition, float projectionScale, bool isPerspective)
+		{
+			float diameter = worldAABB.GetLengths().GetLength();
+			float screenSize = diameter * projectionScale;
+			if (isPerspective)
+			{
+				float distance = eyePosition.Distance(worldAABB.GetCenter()) - diameter * 0.5f;
+				screenSize /= std::max(distance, 0.01f);
+			}
+
+			return screenSize;
+		}
+
+		Boxf ComputeWorldAABB(const Boxf& localAABB, const Matrix4f& worldMatrix)
+		{
+			// Transform the center and project the extents on each world axis (Arvo's method), cheaper than transforming the 8 corners
+			Vector3f center = worldMatrix.Transform(localAABB.GetCenter());
+			Vector3f extents = localAABB.GetLengths() * 0.5f;
+
+			Vector3f worldExtents;
+			worldExtents.x = std::abs(worldMatrix.m11) * extents.x + std::abs(worldMatrix.m21) * extents.y + std::abs(worldMatrix.m31) * extents.z;
+			worldExtents.y = std::abs(worldMatrix.m12) * extents.x + std::abs(worldMatrix.m22) * extents.y + std::abs(worldMatrix.m32) * extents.z;
+			worldExtents.z = std::abs(worldMatrix.m13) * extents.x + std::abs(worldMatrix.m23) * extents.y + std::abs(worldMatrix.m33) * extents.z;
+
+			return Boxf::FromExtents(center - worldExtents, center + worldExtents);
+		}
+
+		/*
+		* Tests boxes [first, last) against the frustum using the "positive vertex" of each box: the corner which is the furthest along the plane normal.
+		* If this corner is behind any plane, the box is outside.
+		* Since the normal is the same for every box, which of min or max is the positive vertex only depends on the plane, allowing to test multiple boxes at once.
+		*/
+		template<typename Bounds, typename F>
+		void CullBoxes(const Frustumf& frustum, const Bounds& bounds, UInt32 renderMask, std::size_t first, std::size_t last, F&& visibleCallback)
+		{
+			struct PlaneData
+			{
+				const float* px;
+				const float* py;
+				const float* pz;
+				float nx, ny, nz, d;
+			};
+
+			std::array<PlaneData, FrustumPlaneCount> planes;
+			for (std::size_t i = 0; i < FrustumPlaneCount; ++i)
+			{
+				const Planef& plane = frustum.GetPlane(static_cast<FrustumPlane>(i));
+
+				PlaneData& planeData = planes[i];
+				planeData.px = (plane.normal.x >= 0.f) ? bounds.maxX.data() : bounds.minX.data();
+				planeData.py = (plane.normal.y >= 0.f) ? bounds.maxY.data() : bounds.minY.data();
+				planeData.pz = (plane.normal.z >= 0.f) ? bounds.maxZ.data() : bounds.minZ.data();
+				planeData.nx = plane.normal.x;
+				planeData.ny = plane.normal.y;
+				planeData.nz = plane.normal.z;
+				planeData.d = plane.distance;
+			}
+
+			const UInt32* renderMasks = bounds.renderMask.data();
+
+			std::size_t index = first;
+
+#ifdef NAZARA_GRAPHICS_CULLING_SSE2
+			__m128i maskVec = _mm_set1_epi32(static_cast<int>(renderMask));
+			__m128i zero = _mm_setzero_si128();
+
+			std::size_t batchEnd = first + (last - first) / CullingBatchSize * CullingBatchSize;
+			for (; index < batchEnd; index += CullingBatchSize)
+			{
+				// Discard boxes not matching the render mask (unused slots have a zero mask)
+				__m128i boxMasks = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&renderMasks[index]));
+				__m128 rejected = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(boxMasks, maskVec), zero));
+
+				for (const PlaneData& plane : planes)
+				{
+					__m128 dist = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&plane.px[index]), _mm_set1_ps(plane.nx)), _mm_set1_ps(plane.d));
+					dist = _mm_add_ps(dist, _mm_mul_ps(_mm_loadu_ps(&plane.py[index]), _mm_set1_ps(plane.ny)));
+					dist = _mm_add_ps(dist, _mm_mul_ps(_mm_loadu_ps(&plane.pz[index]), _mm_set1_ps(plane.nz)));
+
+					rejected = _mm_or_ps(rejected, _mm_cmplt_ps(dist, _mm_setzero_ps()));
+				}
+
+				int visibleMask = ~_mm_movemask_ps(rejected) & 0xF;
+				while (visibleMask != 0)
+				{
+					int lane = 0;
+					while ((visibleMask & (1 << lane)) == 0)
+						lane++;
+
+					visibleCallback(index + lane);
+					visibleMask &= ~(1 << lane);
+				}
+			}
+#endif
+
+			for (; index < last; ++index)
+			{
+				if ((renderMasks[index] & renderMask) == 0)
+					continue;
+
+				bool isVisible = true;
+				for (const PlaneData& plane : planes)
+				{
+					if (plane.px[index] * plane.nx + plane.py[index] * plane.ny + plane.pz[index] * plane.nz + plane.d < 0.f)
+					{
+						isVisible = false;
+						break;
+					}
+				}
+
+				if (isVisible)
+					visibleCallback(index);
+			}
+		}
+	}
+
 	ForwardFramePipeline::ForwardFramePipeline(ElementRendererRegistry& elementRegistry) :
+	ForwardFramePipeline(elementRegistry, false)
+	{
+	}
+
+	/*!
+	* \brief Constructs the pipeline, shading opaque materials supporting it with a G-buffer and a deferred lighting pass if useDeferredShading is true
+	*
+	* Falls back to forward shading if the deferred lighting pipeline isn't available (see Graphics::Config::useDeferredShading).
+	*/
+	ForwardFramePipeline::ForwardFramePipeline(ElementRendererRegistry& elementRegistry, bool useDeferredShading) :
 	m_elementRegistry(elementRegistry),
 	m_renderablePool(4096),
 	m_lightPool(64),
 	m_skeletonInstances(1024),
 	m_viewerPool(8),
 	m_worldInstances(2048),
+	m_bakedFrameGraphHash(0),
+	m_textureStreamer(nullptr),
+	m_averageFrameTime(0.f),
 	m_generationCounter(0),
-	m_rebuildFrameGraph(true)
+	m_rebuildFrameGraph(true),
+	m_useDeferredShading(useDeferredShading)
 	{
+		if (m_useDeferredShading && !Graphics::Instance()->IsDeferredShadingEnabled())
+		{
+			NazaraWarning("deferred shading is not enabled (see Graphics::Config::useDeferredShading), falling back to forward shading");
+			m_useDeferredShading = false;
+		}
 	}
 
 	ForwardFramePipeline::~ForwardFramePipeline()
@@ -45,42 +250,202 @@ namespace Nz
 		m_viewerPool.Clear();
 	}
 
+	/*!
+	* \brief Renders the viewer at its full resolution again
+	*/
+	void ForwardFramePipeline::DisableDynamicResolution(std::size_t viewerIndex)
+	{
+		ViewerData* viewerData = m_viewerPool.RetrieveFromIndex(viewerIndex);
+		if (!viewerData->dynamicResolution)
+			return;
+
+		viewerData->dynamicResolution.reset();
+		m_rebuildFrameGraph = true;
+	}
+
+	/*!
+	* \brief Computes the visibility of a viewer and of the other eye of its stereo pair separately again
+	*
+	* \param viewerIndex Index of any viewer of the pair
+	*/
+	void ForwardFramePipeline::DisableStereoCulling(std::size_t viewerIndex)
+	{
+		ViewerData* viewerData = m_viewerPool.RetrieveFromIndex(viewerIndex);
+		if (viewerData->stereoViewerIndex == NoStereoViewer)
+			return;
+
+		ViewerData* stereoViewerData = m_viewerPool.RetrieveFromIndex(viewerData->stereoViewerIndex);
+		stereoViewerData->stereoViewerIndex = NoStereoViewer;
+		stereoViewerData->isStereoSecondary = false;
+
+		viewerData->stereoViewerIndex = NoStereoViewer;
+		viewerData->isStereoSecondary = false;
+	}
+
+	/*!
+	* \brief Renders the viewer at a lower resolution when the frame time goes over a target, and upscales it to the viewer viewport
+	*
+	* The render scale is adjusted every few frames from the measured frame time, between the minimum and maximum scales of the parameters.
+	* Requires dynamic resolution to be enabled in the graphics module configuration.
+	*
+	* \param viewerIndex Index of the viewer (as returned by RegisterViewer)
+	* \param params Target frame time, upscaling mode and render scale range
+	*/
+	void ForwardFramePipeline::EnableDynamicResolution(std::size_t viewerIndex, const DynamicResolutionParams& params)
+	{
+		NazaraAssert(params.minScale > 0.f && params.minScale <= params.maxScale && params.maxScale <= 1.f, "invalid render scale range");
+		NazaraAssert(params.targetFrameTime > Time::Zero(), "target frame time must be positive");
+
+		if (!Graphics::Instance()->IsDynamicResolutionEnabled())
+		{
+			NazaraWarning("dynamic resolution has not been enabled in graphics configuration");
+			return;
+		}
+
+		ViewerData* viewerData = m_viewerPool.RetrieveFromIndex(viewerIndex);
+
+		auto& dynamicResolution = viewerData->dynamicResolution.emplace();
+		dynamicResolution.params = params;
+		dynamicResolution.probeInterval = RenderScaleProbeInterval;
+
+		m_rebuildFrameGraph = true;
+	}
+
+	/*!
+	* \brief Computes the visibility of two viewers (the eyes of a stereo viewer) with a single culling pass
+	*
+	* Renderables and lights are culled once against a frustum enclosing both eye frustums, level of details are selected for the first viewer and used by both eyes.
+	* Occlusion culling (when enabled) is still done per eye, from the depth of each viewer.
+	*
+	* \param firstViewerIndex Index of the first viewer (as returned by RegisterViewer), its render mask is used for both eyes
+	* \param secondViewerIndex Index of the second viewer
+	*
+	* \remark Viewers already part of a stereo pair are removed from it
+	*/
+	void ForwardFramePipeline::EnableStereoCulling(std::size_t firstViewerIndex, std::size_t secondViewerIndex)
+	{
+		NazaraAssert(firstViewerIndex != secondViewerIndex, "a viewer cannot be paired with itself");
+
+		DisableStereoCulling(firstViewerIndex);
+		DisableStereoCulling(secondViewerIndex);
+
+		ViewerData* firstViewerData = m_viewerPool.RetrieveFromIndex(firstViewerIndex);
+		firstViewerData->stereoViewerIndex = secondViewerIndex;
+
+		ViewerData* secondViewerData = m_viewerPool.RetrieveFromIndex(secondViewerIndex);
+		secondViewerData->stereoViewerIndex = firstViewerIndex;
+		secondViewerData->isStereoSecondary = true;
+	}
+
 	const std::vector<Nz::FramePipelinePass::VisibleRenderable>& ForwardFramePipeline::FrustumCull(const Frustumf& frustum, UInt32 mask, std::size_t& visibilityHash) const
 	{
-		auto CombineHash = [](std::size_t currentHash, std::size_t newHash)
+		return FrustumCull(frustum, mask, visibilityHash, m_cullingScratch);
+	}
+
+	const std::vector<Nz::FramePipelinePass::VisibleRenderable>& ForwardFramePipeline::FrustumCull(const Frustumf& frustum, UInt32 mask, std::size_t& visibilityHash, CullingScratch& scratch) const
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		// Walk the spatial tree, renderables in subtrees fully inside the frustum are visible without further tests
+		// while the exact AABB of renderables on the frustum boundary has still to be checked
+		scratch.candidates.clear();
+		scratch.visibleRenderableIndices.clear();
+		m_renderableTree.Query(frustum, [&](std::size_t renderableIndex, IntersectionSide side)
 		{
-			return currentHash * 23 + newHash;
-		};
+			if ((m_renderableBounds.renderMask[renderableIndex] & mask) == 0)
+				return;
+
+			if (side == IntersectionSide::Inside)
+				scratch.visibleRenderableIndices.push_back(renderableIndex);
+			else
+				scratch.candidates.push_back(renderableIndex);
+		});
 
-		m_visibleRenderables.clear();
-		for (const RenderableData& renderableData : m_renderablePool)
+		if (!scratch.candidates.empty())
 		{
-			if ((mask & renderableData.renderMask) == 0)
-				continue;
+			// Gather candidates bounds to test them in batches
+			std::size_t candidateCount = scratch.candidates.size();
+			scratch.candidateBounds.minX.resize(candidateCount);
+			scratch.candidateBounds.minY.resize(candidateCount);
+			scratch.candidateBounds.minZ.resize(candidateCount);
+			scratch.candidateBounds.maxX.resize(candidateCount);
+			scratch.candidateBounds.maxY.resize(candidateCount);
+			scratch.candidateBounds.maxZ.resize(candidateCount);
+			scratch.candidateBounds.renderMask.resize(candidateCount);
+
+			for (std::size_t i = 0; i < candidateCount; ++i)
+			{
+				std::size_t renderableIndex = scratch.candidates[i];
+				scratch.candidateBounds.minX[i] = m_renderableBounds.minX[renderableIndex];
+				scratch.candidateBounds.minY[i] = m_renderableBounds.minY[renderableIndex];
+				scratch.candidateBounds.minZ[i] = m_renderableBounds.minZ[renderableIndex];
+				scratch.candidateBounds.maxX[i] = m_renderableBounds.maxX[renderableIndex];
+				scratch.candidateBounds.maxY[i] = m_renderableBounds.maxY[renderableIndex];
+				scratch.candidateBounds.maxZ[i] = m_renderableBounds.maxZ[renderableIndex];
+				scratch.candidateBounds.renderMask[i] = m_renderableBounds.renderMask[renderableIndex];
+			}
 
-			const WorldInstancePtr& worldInstance = m_worldInstances.RetrieveFromIndex(renderableData.worldInstanceIndex)->worldInstance;
+			CullBoxes(frustum, scratch.candidateBounds, mask, 0, candidateCount, [&](std::size_t candidateIndex)
+			{
+				scratch.visibleRenderableIndices.push_back(scratch.candidates[candidateIndex]);
+			});
+		}
 
-			// Get global AABB
-			BoundingVolumef boundingVolume(renderableData.renderable->GetAABB());
-			boundingVolume.Update(worldInstance->GetWorldMatrix());
+		// Tree traversal order depends on its layout, sort visible renderables to keep a stable order (and visibility hash) as long as the same renderables are visible
+		std::sort(scratch.visibleRenderableIndices.begin(), scratch.visibleRenderableIndices.end());
 
-			if (frustum.Intersect(boundingVolume) == IntersectionSide::Outside)
-				continue;
+		// Visible renderables are processed by fixed-size chunks (whether they are processed in parallel or not) so the visibility hash doesn't depend on the worker count
+		std::size_t visibleCount = scratch.visibleRenderableIndices.size();
+		std::size_t chunkCount = (visibleCount + CullingChunkSize - 1) / CullingChunkSize;
+		if (scratch.chunks.size() < chunkCount)
+			scratch.chunks.resize(chunkCount);
 
-			auto& visibleRenderable = m_visibleRenderables.emplace_back();
-			visibleRenderable.instancedRenderable = renderableData.renderable;
-			visibleRenderable.scissorBox = renderableData.scissorBox;
-			visibleRenderable.worldInstance = worldInstance.get();
+		auto ProcessChunk = [&](std::size_t first, std::size_t last)
+		{
+			std::size_t chunkIndex = first / CullingChunkSize;
+			CullingChunk& chunk = scratch.chunks[chunkIndex];
+			chunk.visibleRenderables.clear();
+			chunk.visibilityHash = 0;
 
-			if (renderableData.skeletonInstanceIndex != NoSkeletonInstance)
-				visibleRenderable.skeletonInstance = m_skeletonInstances.RetrieveFromIndex(renderableData.skeletonInstanceIndex)->skeleton.get();
-			else
-				visibleRenderable.skeletonInstance = nullptr;
+			for (std::size_t i = first; i < last; ++i)
+			{
+				std::size_t renderableIndex = scratch.visibleRenderableIndices[i];
+				const RenderableData* renderableData = m_renderablePool.RetrieveFromIndex(renderableIndex);
+
+				auto& visibleRenderable = chunk.visibleRenderables.emplace_back();
+				visibleRenderable.instancedRenderable = renderableData->renderable;
+				visibleRenderable.lodIndex = 0;
+				visibleRenderable.scissorBox = renderableData->scissorBox;
+				visibleRenderable.worldAABB = Boxf::FromExtents({ m_renderableBounds.minX[renderableIndex], m_renderableBounds.minY[renderableIndex], m_renderableBounds.minZ[renderableIndex] }, { m_renderableBounds.maxX[renderableIndex], m_renderableBounds.maxY[renderableIndex], m_renderableBounds.maxZ[renderableIndex] });
+				visibleRenderable.worldInstance = m_worldInstances.RetrieveFromIndex(renderableData->worldInstanceIndex)->worldInstance.get();
+
+				if (renderableData->skeletonInstanceIndex != NoSkeletonInstance)
+					visibleRenderable.skeletonInstance = m_skeletonInstances.RetrieveFromIndex(renderableData->skeletonInstanceIndex)->skeleton.get();
+				else
+					visibleRenderable.skeletonInstance = nullptr;
+
+				chunk.visibilityHash = CombineHash(chunk.visibilityHash, std::hash<const void*>()(renderableData) + renderableData->generation);
+			}
+		};
 
-			visibilityHash = CombineHash(visibilityHash, std::hash<const void*>()(&renderableData) + renderableData.generation);
+		if (visibleCount >= ParallelCullingThreshold)
+			Core::Instance()->GetTaskScheduler().ForEachChunk(visibleCount, CullingChunkSize, ProcessChunk);
+		else
+		{
+			for (std::size_t first = 0; first < visibleCount; first += CullingChunkSize)
+				ProcessChunk(first, std::min(first + CullingChunkSize, visibleCount));
 		}
 
-		return m_visibleRenderables;
+		scratch.visibleRenderables.clear();
+		for (std::size_t chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+		{
+			const CullingChunk& chunk = scratch.chunks[chunkIndex];
+			scratch.visibleRenderables.insert(scratch.visibleRenderables.end(), chunk.visibleRenderables.begin(), chunk.visibleRenderables.end());
+
+			visibilityHash = CombineHash(visibilityHash, chunk.visibilityHash);
+		}
+
+		return scratch.visibleRenderables;
 	}
 
 	void ForwardFramePipeline::ForEachRegisteredMaterialInstance(FunctionRef<void(const MaterialInstance& materialInstance)> callback)
@@ -109,14 +474,8 @@ namespace Nz
 		lightData->renderMask = renderMask;
 		lightData->onLightInvalidated.Connect(lightData->light->OnLightDataInvalided, [=](Light*)
 		{
-			//TODO: Switch lights to storage buffers so they can all be part of GPU memory
-			for (auto& viewerData : m_viewerPool)
-			{
-				UInt32 viewerRenderMask = viewerData.viewer->GetRenderMask();
-
-				if (viewerRenderMask & renderMask)
-					viewerData.forwardPass->InvalidateElements();
-			}
+			// Forward passes upload their lights every frame
+			UpdateLightBounds(lightIndex);
 		});
 
 		lightData->onLightShadowCastingChanged.Connect(lightData->light->OnLightShadowCastingChanged, [=](Light* light, bool isCastingShadows)
@@ -125,6 +484,11 @@ namespace Nz
 			{
 				m_shadowCastingLights.UnboundedSet(lightIndex);
 				lightData->shadowData = light->InstanciateShadowData(*this, m_elementRegistry);
+				if (lightData->shadowData->IsPerViewer())
+				{
+					for (auto& viewerData : m_viewerPool)
+						lightData->shadowData->RegisterViewer(viewerData.viewer);
+				}
 			}
 			else
 			{
@@ -139,9 +503,17 @@ namespace Nz
 		{
 			m_shadowCastingLights.UnboundedSet(lightIndex);
 			lightData->shadowData = light->InstanciateShadowData(*this, m_elementRegistry);
+			if (lightData->shadowData->IsPerViewer())
+			{
+				for (auto& viewerData : m_viewerPool)
+					lightData->shadowData->RegisterViewer(viewerData.viewer);
+			}
+
 			m_rebuildFrameGraph = true;
 		}
 
+		UpdateLightBounds(lightIndex);
+
 		return lightIndex;
 	}
 	
@@ -156,21 +528,38 @@ namespace Nz
 		renderableData->skeletonInstanceIndex = skeletonInstanceIndex;
 		renderableData->worldInstanceIndex = worldInstanceIndex;
 
-		renderableData->onElementInvalidated.Connect(instancedRenderable->OnElementInvalidated, [=](InstancedRenderable* /*instancedRenderable*/)
+		if (skeletonInstanceIndex != NoSkeletonInstance && Graphics::Instance()->IsComputeSkinningEnabled())
+			instancedRenderable->RegisterComputeSkinning(*m_skeletonInstances.RetrieveFromIndex(skeletonInstanceIndex)->skeleton);
+
+		if (instancedRenderable->IsSimulated())
+			m_simulatedRenderables.UnboundedSet(renderableIndex);
+
+		m_worldInstances.RetrieveFromIndex(worldInstanceIndex)->renderables.push_back(renderableIndex);
+
+		if (renderableIndex >= m_renderableBounds.renderMask.size())
 		{
-			// TODO: Invalidate only relevant viewers and passes
-			for (auto& viewerData : m_viewerPool)
-			{
-				UInt32 viewerRenderMask = viewerData.viewer->GetRenderMask();
+			std::size_t boundsCount = renderableIndex + 1;
+			m_renderableBounds.minX.resize(boundsCount);
+			m_renderableBounds.minY.resize(boundsCount);
+			m_renderableBounds.minZ.resize(boundsCount);
+			m_renderableBounds.maxX.resize(boundsCount);
+			m_renderableBounds.maxY.resize(boundsCount);
+			m_renderableBounds.maxZ.resize(boundsCount);
+			m_renderableBounds.renderMask.resize(boundsCount, 0);
+		}
 
-				if (viewerRenderMask & renderMask)
-				{
-					if (viewerData.depthPrepass)
-						viewerData.depthPrepass->InvalidateElements();
+		m_renderableBounds.renderMask[renderableIndex] = renderMask;
+		m_invalidatedRenderableBounds.UnboundedSet(renderableIndex);
 
-					viewerData.forwardPass->InvalidateElements();
-				}
-			}
+		renderableData->onAABBUpdate.Connect(instancedRenderable->OnAABBUpdate, [=](InstancedRenderable* /*instancedRenderable*/, const Boxf& /*aabb*/)
+		{
+			m_invalidatedRenderableBounds.UnboundedSet(renderableIndex);
+		});
+
+		renderableData->onElementInvalidated.Connect(instancedRenderable->OnElementInvalidated, [=](InstancedRenderable* /*instancedRenderable*/)
+		{
+			// Renderables may invalidate their elements many times per frame, passes are only notified once in Render
+			m_invalidatedRenderableElements.UnboundedSet(renderableIndex);
 		});
 
 		renderableData->onMaterialInvalidated.Connect(instancedRenderable->OnMaterialInvalidated, [this](InstancedRenderable* instancedRenderable, std::size_t materialIndex, const std::shared_ptr<MaterialInstance>& newMaterial)
@@ -239,15 +628,31 @@ namespace Nz
 
 	std::size_t ForwardFramePipeline::RegisterViewer(AbstractViewer* viewerInstance, Int32 renderOrder)
 	{
-		std::size_t depthPassIndex = Graphics::Instance()->GetMaterialPassRegistry().GetPassIndex("DepthPass");
+		const MaterialPassRegistry& materialPassRegistry = Graphics::Instance()->GetMaterialPassRegistry();
 
 		std::size_t viewerIndex;
 		auto& viewerData = *m_viewerPool.Allocate(viewerIndex);
 		viewerData.renderOrder = renderOrder;
 		viewerData.debugDrawPass = std::make_unique<DebugDrawPipelinePass>(*this, viewerInstance);
-		viewerData.depthPrepass = std::make_unique<DepthPipelinePass>(*this, m_elementRegistry, viewerInstance, depthPassIndex, "Depth pre-pass");
-		viewerData.forwardPass = std::make_unique<ForwardPipelinePass>(*this, m_elementRegistry, viewerInstance);
 		viewerData.viewer = viewerInstance;
+
+		if (m_useDeferredShading)
+		{
+			// The G-buffer pass takes the place of the depth pre-pass (it fills the depth buffer as well), materials it renders are skipped by the forward pass
+			std::size_t gbufferPassIndex = materialPassRegistry.GetPassIndex("GBufferPass");
+
+			viewerData.depthPrepass = std::make_unique<DepthPipelinePass>(*this, m_elementRegistry, viewerInstance, gbufferPassIndex, "G-buffer pass");
+			viewerData.forwardPass = std::make_unique<ForwardPipelinePass>(*this, m_elementRegistry, viewerInstance, gbufferPassIndex);
+			viewerData.lightingPass = std::make_unique<DeferredLightingPipelinePass>(*this, viewerInstance);
+		}
+		else
+		{
+			viewerData.depthPrepass = std::make_unique<DepthPipelinePass>(*this, m_elementRegistry, viewerInstance, materialPassRegistry.GetPassIndex("DepthPass"), "Depth pre-pass");
+			viewerData.forwardPass = std::make_unique<ForwardPipelinePass>(*this, m_elementRegistry, viewerInstance);
+		}
+
+		if (Graphics::Instance()->IsOcclusionCullingEnabled())
+			viewerData.occlusionCuller = std::make_unique<OcclusionCuller>(viewerInstance);
 		viewerData.onTransferRequired.Connect(viewerInstance->GetViewerInstance().OnTransferRequired, [this](TransferInterface* transferInterface)
 		{
 			m_transferSet.insert(transferInterface);
@@ -255,6 +660,13 @@ namespace Nz
 
 		m_transferSet.insert(&viewerInstance->GetViewerInstance());
 
+		for (std::size_t i : m_shadowCastingLights.IterBits())
+		{
+			LightData* lightData = m_lightPool.RetrieveFromIndex(i);
+			if (lightData->shadowData->IsPerViewer())
+				lightData->shadowData->RegisterViewer(viewerInstance);
+		}
+
 		m_rebuildFrameGraph = true;
 
 		return viewerIndex;
@@ -265,9 +677,13 @@ namespace Nz
 		std::size_t worldInstanceIndex;
 		WorldInstanceData& worldInstanceData = *m_worldInstances.Allocate(worldInstanceIndex);
 		worldInstanceData.worldInstance = std::move(worldInstance);
-		worldInstanceData.onTransferRequired.Connect(worldInstanceData.worldInstance->OnTransferRequired, [this](TransferInterface* transferInterface)
+		worldInstanceData.onTransferRequired.Connect(worldInstanceData.worldInstance->OnTransferRequired, [this, worldInstanceDataPtr = &worldInstanceData](TransferInterface* transferInterface)
 		{
 			m_transferSet.insert(transferInterface);
+
+			// World matrix changed, world AABB of its renderables have to be recomputed
+			for (std::size_t renderableIndex : worldInstanceDataPtr->renderables)
+				m_invalidatedRenderableBounds.UnboundedSet(renderableIndex);
 		});
 
 		m_transferSet.insert(worldInstanceData.worldInstance.get());
@@ -275,25 +691,56 @@ namespace Nz
 		return worldInstanceIndex;
 	}
 
+	bool ForwardFramePipeline::IsCullingInvalidated(const Frustumf& frustum) const
+	{
+		for (const Boxf& box : m_invalidatedCullingBoxes)
+		{
+			if (frustum.Intersect(box) != IntersectionSide::Outside)
+				return true;
+		}
+
+		return false;
+	}
+
 	const Light* ForwardFramePipeline::RetrieveLight(std::size_t lightIndex) const
 	{
 		return m_lightPool.RetrieveFromIndex(lightIndex)->light;
 	}
 
-	const Texture* ForwardFramePipeline::RetrieveLightShadowmap(std::size_t lightIndex) const
+	const LightShadowData* ForwardFramePipeline::RetrieveLightShadowData(std::size_t lightIndex) const
 	{
 		if (!m_shadowCastingLights.UnboundedTest(lightIndex))
 			return nullptr;
 
-		return m_lightPool.RetrieveFromIndex(lightIndex)->shadowData->RetrieveLightShadowmap(m_bakedFrameGraph);
+		return m_lightPool.RetrieveFromIndex(lightIndex)->shadowData.get();
+	}
+
+	const Texture* ForwardFramePipeline::RetrieveLightShadowmap(std::size_t lightIndex, const AbstractViewer* viewer) const
+	{
+		if (!m_shadowCastingLights.UnboundedTest(lightIndex))
+			return nullptr;
+
+		const LightShadowData* shadowData = m_lightPool.RetrieveFromIndex(lightIndex)->shadowData.get();
+		return shadowData->RetrieveLightShadowmap(m_bakedFrameGraph, (shadowData->IsPerViewer()) ? viewer : nullptr);
 	}
 
 	void ForwardFramePipeline::Render(RenderFrame& renderFrame)
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		NazaraProfileScope("ForwardFramePipeline::Render");
+
 		m_currentRenderFrame = &renderFrame;
 
 		Graphics* graphics = Graphics::Instance();
 
+		// Instantiate pipelines whose shaders were compiled in the background, renderables waiting on them will invalidate their elements
+		MaterialPipeline::ProcessPrewarmedPipelines();
+
+		// Texture table slots released since the last frame can be reused once this frame is over
+		if (const std::shared_ptr<BindlessTextureTable>& textureTable = graphics->GetBindlessTextureTable())
+			textureTable->Update(renderFrame);
+
 		// Destroy instances at the end of the frame
 		for (std::size_t skeletonInstanceIndex : m_removedSkeletonInstances.IterBits())
 		{
@@ -304,7 +751,17 @@ namespace Nz
 
 		for (std::size_t viewerIndex : m_removedViewerInstances.IterBits())
 		{
-			renderFrame.PushForRelease(std::move(*m_viewerPool.RetrieveFromIndex(viewerIndex)));
+			DisableStereoCulling(viewerIndex);
+
+			ViewerData* viewerData = m_viewerPool.RetrieveFromIndex(viewerIndex);
+			for (std::size_t i : m_shadowCastingLights.IterBits())
+			{
+				LightData* lightData = m_lightPool.RetrieveFromIndex(i);
+				if (lightData->shadowData->IsPerViewer())
+					lightData->shadowData->UnregisterViewer(renderFrame, viewerData->viewer);
+			}
+
+			renderFrame.PushForRelease(std::move(*viewerData));
 			m_viewerPool.Free(viewerIndex);
 		}
 		m_removedViewerInstances.Clear();
@@ -316,17 +773,125 @@ namespace Nz
 		}
 		m_removedWorldInstances.Clear();
 
+		UpdateRenderableBounds();
+		UpdateRenderableElements();
+
+		Time frameTime = m_frameClock.Restart();
+		float frameTimeSeconds = frameTime.AsSeconds();
+		m_averageFrameTime = (m_averageFrameTime > 0.f) ? Lerp(m_averageFrameTime, frameTimeSeconds, FrameTimeSmoothing) : frameTimeSeconds;
+
+		// Create or release upscale passes of viewers whose dynamic resolution changed (the frame graph is rebuilt in that case)
+		if (m_rebuildFrameGraph)
+		{
+			for (auto& viewerData : m_viewerPool)
+			{
+				const auto& dynamicResolution = viewerData.dynamicResolution;
+				if (viewerData.upscalePass && (!dynamicResolution || viewerData.upscalePass->GetUpscalingMode() != dynamicResolution->params.upscalingMode))
+					renderFrame.PushForRelease(std::move(viewerData.upscalePass));
+
+				if (dynamicResolution && !viewerData.upscalePass)
+					viewerData.upscalePass = std::make_unique<UpscalePipelinePass>(viewerData.viewer, dynamicResolution->params.upscalingMode);
+
+				ViewerInstance& viewerInstance = viewerData.viewer->GetViewerInstance();
+				if (!dynamicResolution || dynamicResolution->params.upscalingMode != UpscalingMode::Temporal)
+					viewerInstance.UpdateJitter(Vector2f::Zero());
+
+				if (!dynamicResolution && viewerInstance.GetRenderScale() != 1.f)
+				{
+					viewerInstance.UpdateRenderScale(1.f);
+
+					if (viewerData.depthPrepass)
+						viewerData.depthPrepass->InvalidateCommandBuffers();
+
+					viewerData.forwardPass->InvalidateCommandBuffers();
+				}
+			}
+		}
+
+		// Apply texture usage reported last frame before materials are transferred
+		if (m_textureStreamer)
+			m_textureStreamer->Update(renderFrame);
+
 		bool frameGraphInvalidated;
 		if (m_rebuildFrameGraph)
 		{
-			renderFrame.PushForRelease(std::move(m_bakedFrameGraph));
-			m_bakedFrameGraph = BuildFrameGraph();
-			m_bakedFrameGraph.Resize(renderFrame);
+			// Passes register their callbacks and attachments again, but the graph is only baked if its structure changed and isn't cached
+			FrameGraph frameGraph = BuildFrameGraph();
+			std::size_t structureHash = frameGraph.ComputeStructureHash();
+
+			if (structureHash != m_bakedFrameGraphHash)
+			{
+				BakedFrameGraph previousFrameGraph = std::move(m_bakedFrameGraph);
+
+				auto it = std::find_if(m_frameGraphCache.begin(), m_frameGraphCache.end(), [&](const CachedFrameGraph& cachedFrameGraph) { return cachedFrameGraph.structureHash == structureHash; });
+				if (it != m_frameGraphCache.end())
+				{
+					m_bakedFrameGraph = std::move(it->bakedFrameGraph);
+					m_frameGraphCache.erase(it);
+
+					frameGraph.UpdateBakedCallbacks(m_bakedFrameGraph);
+				}
+				else
+					m_bakedFrameGraph = frameGraph.Bake();
+
+				// Textures matching the previous graph ones are shared instead of being created again
+				m_bakedFrameGraph.Resize(renderFrame, &previousFrameGraph);
+
+				if (m_bakedFrameGraphHash != 0)
+				{
+					m_frameGraphCache.insert(m_frameGraphCache.begin(), CachedFrameGraph{ std::move(previousFrameGraph), m_bakedFrameGraphHash });
+					if (m_frameGraphCache.size() > FrameGraphCacheSize)
+					{
+						renderFrame.PushForRelease(std::move(m_frameGraphCache.back().bakedFrameGraph));
+						m_frameGraphCache.pop_back();
+					}
+				}
+				else
+					renderFrame.PushForRelease(std::move(previousFrameGraph));
+
+				m_bakedFrameGraphHash = structureHash;
+			}
+			else
+			{
+				frameGraph.UpdateBakedCallbacks(m_bakedFrameGraph);
+				m_bakedFrameGraph.Resize(renderFrame);
+			}
+
 			frameGraphInvalidated = true;
 		}
 		else
 			frameGraphInvalidated = m_bakedFrameGraph.Resize(renderFrame);
 
+		// Dynamic resolution (before transfers, as it changes the viewer data)
+		for (auto& viewerData : m_viewerPool)
+		{
+			if (!viewerData.upscalePass)
+				continue;
+
+			UpdateRenderScale(viewerData);
+
+			viewerData.upscalePass->Prepare();
+			m_transferSet.insert(viewerData.upscalePass.get());
+		}
+
+		// Shadow map handling (before transfers, as shadow viewers may be refitted to the viewers)
+		for (std::size_t i = m_shadowCastingLights.FindFirst(); i != m_shadowCastingLights.npos; i = m_shadowCastingLights.FindNext(i))
+		{
+			LightData* lightData = m_lightPool.RetrieveFromIndex(i);
+			if (lightData->shadowData->IsPerViewer())
+			{
+				for (auto& viewerData : m_viewerPool)
+				{
+					if ((viewerData.viewer->GetRenderMask() & lightData->renderMask) == 0)
+						continue;
+
+					lightData->shadowData->PrepareRendering(renderFrame, viewerData.viewer);
+				}
+			}
+			else
+				lightData->shadowData->PrepareRendering(renderFrame, nullptr);
+		}
+
 		// Update UBOs and materials
 		renderFrame.Execute([&](CommandBufferBuilder& builder)
 		{
@@ -345,54 +910,102 @@ namespace Nz
 			builder.EndDebugRegion();
 		}, QueueType::Transfer);
 
-		// Shadow map handling
-		for (std::size_t i = m_shadowCastingLights.FindFirst(); i != m_shadowCastingLights.npos; i = m_shadowCastingLights.FindNext(i))
+		// Skin meshes once for every pass using them (skeletal data has been transferred above)
+		m_skinnedSkeletonInstances.clear();
+		for (SkeletonInstanceData& skeletonInstanceData : m_skeletonInstances)
 		{
-			LightData* lightData = m_lightPool.RetrieveFromIndex(i);
-			lightData->shadowData->PrepareRendering(renderFrame);
+			if (skeletonInstanceData.skeleton->HasPendingSkinning())
+				m_skinnedSkeletonInstances.push_back(skeletonInstanceData.skeleton.get());
 		}
 
-		// Render queues handling
-		for (auto& viewerData : m_viewerPool)
+		if (!m_skinnedSkeletonInstances.empty())
 		{
-			UInt32 renderMask = viewerData.viewer->GetRenderMask();
-
-			// Frustum culling
-			const Matrix4f& viewProjMatrix = viewerData.viewer->GetViewerInstance().GetViewProjMatrix();
+			renderFrame.Execute([&](CommandBufferBuilder& builder)
+			{
+				builder.BeginDebugRegion("Compute skinning", Color::Orange());
+				{
+					// Skinned vertex buffers may still be read by the previous frame
+					builder.MemoryBarrier(PipelineStage::VertexInput, PipelineStage::ComputeShader, MemoryAccess::VertexBufferRead, MemoryAccess::ShaderWrite);
 
-			Frustumf frustum = Frustumf::Extract(viewProjMatrix);
-			std::size_t visibilityHash = 5;
-			const auto& visibleRenderables = FrustumCull(frustum, renderMask, visibilityHash);
+					for (SkeletonInstance* skeletonInstance : m_skinnedSkeletonInstances)
+						skeletonInstance->DispatchSkinning(builder);
 
-			// Lights update don't trigger a rebuild of the depth pre-pass
-			std::size_t depthVisibilityHash = visibilityHash;
+					builder.MemoryBarrier(PipelineStage::ComputeShader, PipelineStage::VertexInput, MemoryAccess::ShaderWrite, MemoryAccess::VertexBufferRead);
+				}
+				builder.EndDebugRegion();
+			}, QueueType::Compute);
+		}
 
-			m_visibleLights.clear();
-			for (auto it = m_lightPool.begin(); it != m_lightPool.end(); ++it)
+		// Simulate particles (and other GPU-driven renderables) once per frame, even when they're not visible
+		if (m_simulatedRenderables.TestAny() && Graphics::Instance()->IsParticleSystemEnabled())
+		{
+			renderFrame.Execute([&](CommandBufferBuilder& builder)
 			{
-				const LightData& lightData = *it;
-				std::size_t lightIndex = it.GetIndex();
-
-				const BoundingVolumef& boundingVolume = lightData.light->GetBoundingVolume();
-
-				// TODO: Use more precise tests for point lights (frustum/sphere is cheap)
-				if (renderMask & lightData.renderMask && frustum.Intersect(boundingVolume) != IntersectionSide::Outside)
+				builder.BeginDebugRegion("Particle simulation", Color::Orange());
 				{
-					m_visibleLights.push_back(lightIndex);
-
-					auto CombineHash = [](std::size_t currentHash, std::size_t newHash)
+					for (std::size_t renderableIndex : m_simulatedRenderables.IterBits())
 					{
-						return currentHash * 23 + newHash;
-					};
+						const RenderableData* renderableData = m_renderablePool.RetrieveFromIndex(renderableIndex);
+
+						InstancedRenderable::SimulationData simulationData;
+						simulationData.elapsedTime = frameTime;
+
+						// Collisions use the depth of the first viewer seeing the renderable, as it was when the occlusion culling depth pyramid was built
+						for (auto& viewerData : m_viewerPool)
+						{
+							if (!viewerData.occlusionCuller || !viewerData.depthPrepass || (viewerData.viewer->GetRenderMask() & renderableData->renderMask) == 0)
+								continue;
+
+							const OcclusionCuller& occlusionCuller = *viewerData.occlusionCuller;
+							if (const Texture* depthPyramid = occlusionCuller.GetDepthPyramid())
+							{
+								simulationData.depthTexture = depthPyramid;
+								simulationData.depthEyePosition = occlusionCuller.GetDepthPyramidEyePosition();
+								simulationData.depthViewProjMatrix = occlusionCuller.GetDepthPyramidViewProjMatrix();
+								simulationData.depthViewport = occlusionCuller.GetDepthPyramidViewport();
+								break;
+							}
+						}
 
-					visibilityHash = CombineHash(visibilityHash, std::hash<const void*>()(lightData.light));
+						const WorldInstancePtr& worldInstance = m_worldInstances.RetrieveFromIndex(renderableData->worldInstanceIndex)->worldInstance;
+						renderableData->renderable->Simulate(renderFrame, builder, *worldInstance, simulationData);
+					}
 				}
-			}
+				builder.EndDebugRegion();
+			}, QueueType::Compute);
+		}
+
+		// Visibility of every viewer is computed in parallel as it only reads the scene
+		m_preparedViewers.clear();
+		for (auto& viewerData : m_viewerPool)
+			m_preparedViewers.push_back(&viewerData);
+
+		auto ComputeVisibility = [&](std::size_t first, std::size_t last)
+		{
+			for (std::size_t i = first; i < last; ++i)
+				ComputeViewerVisibility(*m_preparedViewers[i]);
+		};
+
+		if (m_preparedViewers.size() > 1)
+			Core::Instance()->GetTaskScheduler().ForEachChunk(m_preparedViewers.size(), 1, ComputeVisibility);
+		else
+			ComputeVisibility(0, m_preparedViewers.size());
+
+		// Render queues handling (passes allocate from the upload pool and build elements, which isn't thread-safe)
+		for (ViewerData* viewerDataPtr : m_preparedViewers)
+		{
+			ViewerData& viewerData = *viewerDataPtr;
+
+			if (m_textureStreamer)
+				ReportTextureUsage(*viewerData.viewer, viewerData.cullingScratch.visibleRenderables);
 
 			if (viewerData.depthPrepass)
-				viewerData.depthPrepass->Prepare(renderFrame, frustum, visibleRenderables, depthVisibilityHash);
+				viewerData.depthPrepass->Prepare(renderFrame, viewerData.frustum, *viewerData.visibleRenderables, viewerData.depthVisibilityHash);
+
+			viewerData.forwardPass->Prepare(renderFrame, viewerData.frustum, *viewerData.visibleRenderables, viewerData.visibleLights, viewerData.visibilityHash);
 
-			viewerData.forwardPass->Prepare(renderFrame, frustum, visibleRenderables, m_visibleLights, visibilityHash);
+			if (viewerData.lightingPass)
+				viewerData.lightingPass->Prepare(renderFrame, m_bakedFrameGraph, viewerData.visibleLights);
 
 			viewerData.debugDrawPass->Prepare(renderFrame);
 		}
@@ -415,6 +1028,12 @@ namespace Nz
 						}
 					}
 				});
+
+				if (viewerData.occlusionCuller && viewerData.depthPrepass)
+					viewerData.occlusionCuller->UpdateBindings(renderFrame, m_bakedFrameGraph);
+
+				if (viewerData.upscalePass)
+					viewerData.upscalePass->UpdateBindings(renderFrame, m_bakedFrameGraph);
 			}
 
 			for (auto&& [_, renderTargetData] : m_renderTargets)
@@ -438,6 +1057,38 @@ namespace Nz
 		m_bakedFrameGraph.Execute(renderFrame);
 		m_rebuildFrameGraph = false;
 
+		m_elementRegistry.ForEachElementRenderer([&](std::size_t /*elementType*/, ElementRenderer& elementRenderer)
+		{
+			elementRenderer.EndFrame(renderFrame);
+		});
+
+		// Keep the upscaled frames for the next ones
+		for (auto& viewerData : m_viewerPool)
+		{
+			if (!viewerData.upscalePass || viewerData.upscalePass->GetUpscalingMode() != UpscalingMode::Temporal)
+				continue;
+
+			renderFrame.Execute([&](CommandBufferBuilder& builder)
+			{
+				viewerData.upscalePass->UpdateHistory(builder, m_bakedFrameGraph);
+			}, QueueType::Graphics);
+		}
+
+		// Build depth pyramids from this frame and test renderables against them, results will be available in a few frames
+		for (auto& viewerData : m_viewerPool)
+		{
+			if (!viewerData.occlusionCuller || !viewerData.depthPrepass)
+				continue;
+
+			renderFrame.Execute([&](CommandBufferBuilder& builder)
+			{
+				viewerData.occlusionCuller->Dispatch(renderFrame, builder, m_bakedFrameGraph);
+			}, QueueType::Compute);
+		}
+
+		// Shadow maps culling results are kept as long as no renderable changes in their frustum
+		m_invalidatedCullingBoxes.clear();
+
 		// Final blit (TODO: Make part of frame graph)
 		const Vector2ui& frameSize = renderFrame.GetSize();
 		for (auto&& [renderTargetPtr, renderTargetData] : m_renderTargets)
@@ -482,8 +1133,13 @@ namespace Nz
 
 	void ForwardFramePipeline::UnregisterLight(std::size_t lightIndex)
 	{
+		LightData* lightData = m_lightPool.RetrieveFromIndex(lightIndex);
+		if (lightData->cullingProxy != DynamicAABBTree::InvalidProxy)
+			m_lightTree.RemoveProxy(lightData->cullingProxy);
+
 		m_lightPool.Free(lightIndex);
 		m_shadowCastingLights.UnboundedReset(lightIndex);
+		m_unboundedLights.UnboundedReset(lightIndex);
 	}
 
 	void ForwardFramePipeline::UnregisterRenderable(std::size_t renderableIndex)
@@ -505,6 +1161,32 @@ namespace Nz
 			}
 		}
 
+		// Forward passes cache elements per renderable, make sure they won't be reused if a new renderable is registered at the same address
+		for (auto& viewerData : m_viewerPool)
+		{
+			viewerData.forwardPass->InvalidateElements(renderable.renderable);
+
+			// Don't let a new renderable registered at the same index start from this one level of detail
+			if (renderableIndex < viewerData.renderableLODs.size())
+				viewerData.renderableLODs[renderableIndex] = 0;
+		}
+
+		std::vector<std::size_t>& worldInstanceRenderables = m_worldInstances.RetrieveFromIndex(renderable.worldInstanceIndex)->renderables;
+		auto it = std::find(worldInstanceRenderables.begin(), worldInstanceRenderables.end(), renderableIndex);
+		assert(it != worldInstanceRenderables.end());
+		std::swap(*it, worldInstanceRenderables.back());
+		worldInstanceRenderables.pop_back();
+
+		InvalidateRenderableCulling(renderableIndex);
+
+		m_renderableBounds.renderMask[renderableIndex] = 0;
+		m_invalidatedRenderableBounds.UnboundedReset(renderableIndex);
+		m_invalidatedRenderableElements.UnboundedReset(renderableIndex);
+		m_simulatedRenderables.UnboundedReset(renderableIndex);
+
+		if (renderable.cullingProxy != DynamicAABBTree::InvalidProxy)
+			m_renderableTree.RemoveProxy(renderable.cullingProxy);
+
 		m_renderablePool.Free(renderableIndex);
 	}
 
@@ -531,12 +1213,19 @@ namespace Nz
 	{
 		LightData* lightData = m_lightPool.RetrieveFromIndex(lightIndex);
 		lightData->renderMask = renderMask;
+
+		// Per-viewer shadow maps are only registered for the viewers seeing the light
+		if (m_shadowCastingLights.UnboundedTest(lightIndex) && lightData->shadowData->IsPerViewer())
+			m_rebuildFrameGraph = true;
 	}
 
 	void ForwardFramePipeline::UpdateRenderableRenderMask(std::size_t renderableIndex, UInt32 renderMask)
 	{
 		RenderableData* renderableData = m_renderablePool.RetrieveFromIndex(renderableIndex);
 		renderableData->renderMask = renderMask;
+
+		m_renderableBounds.renderMask[renderableIndex] = renderMask;
+		InvalidateRenderableCulling(renderableIndex);
 	}
 
 	void ForwardFramePipeline::UpdateRenderableScissorBox(std::size_t renderableIndex, const Recti& scissorBox)
@@ -544,19 +1233,8 @@ namespace Nz
 		RenderableData* renderableData = m_renderablePool.RetrieveFromIndex(renderableIndex);
 		renderableData->scissorBox = scissorBox;
 
-		// TODO: Invalidate only relevant viewers and passes
-		for (auto& viewerData : m_viewerPool)
-		{
-			UInt32 viewerRenderMask = viewerData.viewer->GetRenderMask();
-
-			if (viewerRenderMask & renderableData->renderMask)
-			{
-				if (viewerData.depthPrepass)
-					viewerData.depthPrepass->InvalidateElements();
-
-				viewerData.forwardPass->InvalidateElements();
-			}
-		}
+		InvalidateRenderableCulling(renderableIndex);
+		m_invalidatedRenderableElements.UnboundedSet(renderableIndex);
 	}
 
 	void ForwardFramePipeline::UpdateRenderableSkeletonInstance(std::size_t renderableIndex, std::size_t skeletonIndex)
@@ -564,19 +1242,11 @@ namespace Nz
 		RenderableData* renderableData = m_renderablePool.RetrieveFromIndex(renderableIndex);
 		renderableData->skeletonInstanceIndex = skeletonIndex;
 
-		// TODO: Invalidate only relevant viewers and passes
-		for (auto& viewerData : m_viewerPool)
-		{
-			UInt32 viewerRenderMask = viewerData.viewer->GetRenderMask();
-
-			if (viewerRenderMask & renderableData->renderMask)
-			{
-				if (viewerData.depthPrepass)
-					viewerData.depthPrepass->InvalidateElements();
+		if (skeletonIndex != NoSkeletonInstance && Graphics::Instance()->IsComputeSkinningEnabled())
+			renderableData->renderable->RegisterComputeSkinning(*m_skeletonInstances.RetrieveFromIndex(skeletonIndex)->skeleton);
 
-				viewerData.forwardPass->InvalidateElements();
-			}
-		}
+		InvalidateRenderableCulling(renderableIndex);
+		m_invalidatedRenderableElements.UnboundedSet(renderableIndex);
 	}
 
 	void ForwardFramePipeline::UpdateViewerRenderMask(std::size_t viewerIndex, Int32 renderOrder)
@@ -589,41 +1259,129 @@ namespace Nz
 		}
 	}
 
-	BakedFrameGraph ForwardFramePipeline::BuildFrameGraph()
+	FrameGraph ForwardFramePipeline::BuildFrameGraph()
 	{
 		FrameGraph frameGraph;
 
 		for (std::size_t i : m_shadowCastingLights.IterBits())
 		{
 			LightData* lightData = m_lightPool.RetrieveFromIndex(i);
-			lightData->shadowData->RegisterToFrameGraph(frameGraph);
+			if (!lightData->shadowData->IsPerViewer())
+				lightData->shadowData->RegisterToFrameGraph(frameGraph, nullptr);
 		}
 
 		for (auto& viewerData : m_viewerPool)
 		{
-			viewerData.forwardColorAttachment = frameGraph.AddAttachment({
-				"Forward output",
-				PixelFormat::RGBA8
-			});
-			
-			viewerData.debugColorAttachment = frameGraph.AddAttachmentProxy("Debug draw output", viewerData.forwardColorAttachment);
+			// With deferred shading, the forward pass draws over the lighting pass output
+			if (viewerData.lightingPass)
+			{
+				viewerData.lightingColorAttachment = frameGraph.AddAttachment({
+					"Deferred lighting output",
+					PixelFormat::RGBA8
+				});
 
-			viewerData.depthStencilAttachment = frameGraph.AddAttachment({
+				viewerData.forwardColorAttachment = frameGraph.AddAttachmentProxy("Forward output", viewerData.lightingColorAttachment);
+			}
+			else
+			{
+				viewerData.forwardColorAttachment = frameGraph.AddAttachment({
+					"Forward output",
+					PixelFormat::RGBA8
+				});
+			}
+
+			// Debug drawing happens at the viewer resolution, after upscaling
+			if (viewerData.upscalePass)
+			{
+				viewerData.upscaledColorAttachment = frameGraph.AddAttachment({
+					"Upscaled output",
+					PixelFormat::RGBA8
+				});
+
+				viewerData.debugColorAttachment = frameGraph.AddAttachmentProxy("Debug draw output", viewerData.upscaledColorAttachment);
+			}
+			else
+				viewerData.debugColorAttachment = frameGraph.AddAttachmentProxy("Debug draw output", viewerData.forwardColorAttachment);
+
+			// Occlusion culling, deferred lighting and temporal upscaling sample the depth buffer, which isn't possible with depth-stencil formats
+			bool hasOcclusionCulling = viewerData.occlusionCuller && viewerData.depthPrepass;
+			bool hasTemporalUpscale = viewerData.upscalePass && viewerData.upscalePass->GetUpscalingMode() == UpscalingMode::Temporal;
+			bool isDepthSampled = hasOcclusionCulling || hasTemporalUpscale || viewerData.lightingPass;
+
+			FramePassAttachment depthStencilAttachment{
 				"Depth-stencil buffer",
-				Graphics::Instance()->GetPreferredDepthStencilFormat()
-			});
+				(isDepthSampled) ? Graphics::Instance()->GetPreferredDepthFormat() : Graphics::Instance()->GetPreferredDepthStencilFormat()
+			};
+			depthStencilAttachment.transient = !isDepthSampled; //< only used by the depth prepass and the forward pass
 
-			if (viewerData.depthPrepass)
+			viewerData.depthStencilAttachment = frameGraph.AddAttachment(std::move(depthStencilAttachment));
+
+			if (viewerData.lightingPass)
+			{
+				viewerData.gbufferAttachments[0] = frameGraph.AddAttachment({
+					"G-buffer albedo",
+					PixelFormat::RGBA8
+				});
+
+				viewerData.gbufferAttachments[1] = frameGraph.AddAttachment({
+					"G-buffer normal",
+					PixelFormat::RGBA16F
+				});
+
+				viewerData.gbufferAttachments[2] = frameGraph.AddAttachment({
+					"G-buffer specular",
+					PixelFormat::RGBA8
+				});
+
+				viewerData.depthPrepass->RegisterToFrameGraph(frameGraph, { viewerData.gbufferAttachments[0], viewerData.gbufferAttachments[1], viewerData.gbufferAttachments[2] }, viewerData.depthStencilAttachment);
+			}
+			else if (viewerData.depthPrepass)
 				viewerData.depthPrepass->RegisterToFrameGraph(frameGraph, viewerData.depthStencilAttachment);
 
-			FramePass& forwardPass = viewerData.forwardPass->RegisterToFrameGraph(frameGraph, viewerData.forwardColorAttachment, viewerData.depthStencilAttachment, viewerData.depthPrepass != nullptr);
+			if (hasOcclusionCulling)
+				viewerData.occlusionCuller->RegisterToFrameGraph(frameGraph, viewerData.depthStencilAttachment);
+
+			UInt32 viewerRenderMask = viewerData.viewer->GetRenderMask();
 			for (std::size_t i : m_shadowCastingLights.IterBits())
 			{
 				LightData* lightData = m_lightPool.RetrieveFromIndex(i);
-				lightData->shadowData->RegisterPassInputs(forwardPass);
+				if (lightData->shadowData->IsPerViewer() && (viewerRenderMask & lightData->renderMask) != 0)
+					lightData->shadowData->RegisterToFrameGraph(frameGraph, viewerData.viewer);
+			}
+
+			auto RegisterShadowMapInputs = [&](FramePass& pass)
+			{
+				for (std::size_t i : m_shadowCastingLights.IterBits())
+				{
+					LightData* lightData = m_lightPool.RetrieveFromIndex(i);
+					if (!lightData->shadowData->IsPerViewer())
+						lightData->shadowData->RegisterPassInputs(pass, nullptr);
+					else if ((viewerRenderMask & lightData->renderMask) != 0)
+						lightData->shadowData->RegisterPassInputs(pass, viewerData.viewer);
+				}
+			};
+
+			if (viewerData.lightingPass)
+			{
+				FramePass& lightingPass = viewerData.lightingPass->RegisterToFrameGraph(frameGraph, viewerData.gbufferAttachments, viewerData.depthStencilAttachment, viewerData.lightingColorAttachment);
+				RegisterShadowMapInputs(lightingPass);
+
+				FramePass& forwardPass = viewerData.forwardPass->RegisterToFrameGraph(frameGraph, viewerData.lightingColorAttachment, viewerData.forwardColorAttachment, viewerData.depthStencilAttachment);
+				RegisterShadowMapInputs(forwardPass);
+			}
+			else
+			{
+				FramePass& forwardPass = viewerData.forwardPass->RegisterToFrameGraph(frameGraph, viewerData.forwardColorAttachment, viewerData.depthStencilAttachment, viewerData.depthPrepass != nullptr);
+				RegisterShadowMapInputs(forwardPass);
 			}
 
-			viewerData.debugDrawPass->RegisterToFrameGraph(frameGraph, viewerData.forwardColorAttachment, viewerData.debugColorAttachment);
+			if (viewerData.upscalePass)
+			{
+				viewerData.upscalePass->RegisterToFrameGraph(frameGraph, viewerData.forwardColorAttachment, viewerData.depthStencilAttachment, viewerData.upscaledColorAttachment);
+				viewerData.debugDrawPass->RegisterToFrameGraph(frameGraph, viewerData.upscaledColorAttachment, viewerData.debugColorAttachment);
+			}
+			else
+				viewerData.debugDrawPass->RegisterToFrameGraph(frameGraph, viewerData.forwardColorAttachment, viewerData.debugColorAttachment);
 		}
 
 		using ViewerPair = std::pair<const RenderTarget*, const ViewerData*>;
@@ -696,7 +1454,144 @@ namespace Nz
 			frameGraph.AddBackbufferOutput(renderTargetData.finalAttachment);
 		}
 
-		return frameGraph.Bake();
+		return frameGraph;
+	}
+
+	/*!
+	* \brief Culls renderables and lights of a viewer for the current frame
+	*
+	* Only reads shared pipeline data and writes to the viewer data (and to the data of the other eye for stereo pairs), this can be called for multiple viewers in parallel.
+	*/
+	void ForwardFramePipeline::ComputeViewerVisibility(ViewerData& viewerData)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		// The second eye of a stereo pair is handled along with the first one
+		if (viewerData.isStereoSecondary)
+			return;
+
+		UInt32 renderMask = viewerData.viewer->GetRenderMask();
+
+		// Frustum culling
+		const Matrix4f& viewProjMatrix = viewerData.viewer->GetViewerInstance().GetViewProjMatrix();
+		Frustumf frustum = Frustumf::Extract(viewProjMatrix);
+
+		ViewerData* stereoViewerData = nullptr;
+		Frustumf stereoFrustum;
+		Frustumf cullingFrustum = frustum;
+		if (viewerData.stereoViewerIndex != NoStereoViewer)
+		{
+			stereoViewerData = m_viewerPool.RetrieveFromIndex(viewerData.stereoViewerIndex);
+			stereoFrustum = Frustumf::Extract(stereoViewerData->viewer->GetViewerInstance().GetViewProjMatrix());
+			cullingFrustum = ComputeEnclosingFrustum(frustum, stereoFrustum);
+		}
+
+		std::size_t visibilityHash = 5;
+		FrustumCull(cullingFrustum, renderMask, visibilityHash, viewerData.cullingScratch);
+		SelectLODs(viewerData, visibilityHash);
+
+		std::size_t stereoVisibilityHash = visibilityHash;
+
+		CullViewerOcclusion(viewerData, frustum, viewerData.cullingScratch, visibilityHash);
+		if (stereoViewerData)
+			CullViewerOcclusion(*stereoViewerData, stereoFrustum, viewerData.cullingScratch, stereoVisibilityHash);
+
+		std::vector<std::size_t>& visibleLights = viewerData.visibleLights;
+		visibleLights.clear();
+		m_lightTree.Query(cullingFrustum, [&](std::size_t lightIndex, IntersectionSide side)
+		{
+			const LightData* lightData = m_lightPool.RetrieveFromIndex(lightIndex);
+			if ((renderMask & lightData->renderMask) == 0)
+				return;
+
+			// TODO: Use more precise tests for point lights (frustum/sphere is cheap)
+			if (side == IntersectionSide::Intersecting && cullingFrustum.Intersect(lightData->light->GetBoundingVolume()) == IntersectionSide::Outside)
+				return;
+
+			visibleLights.push_back(lightIndex);
+		});
+
+		for (std::size_t lightIndex : m_unboundedLights.IterBits())
+		{
+			const LightData* lightData = m_lightPool.RetrieveFromIndex(lightIndex);
+			if (renderMask & lightData->renderMask)
+				visibleLights.push_back(lightIndex);
+		}
+
+		// Keep lights sorted by index so the visibility hash doesn't depend on the tree layout
+		std::sort(visibleLights.begin(), visibleLights.end());
+		for (std::size_t lightIndex : visibleLights)
+		{
+			std::size_t lightHash = std::hash<const void*>()(m_lightPool.RetrieveFromIndex(lightIndex)->light);
+			visibilityHash = CombineHash(visibilityHash, lightHash);
+			stereoVisibilityHash = CombineHash(stereoVisibilityHash, lightHash);
+		}
+
+		viewerData.frustum = frustum;
+		viewerData.visibilityHash = visibilityHash;
+
+		if (stereoViewerData)
+		{
+			stereoViewerData->frustum = stereoFrustum;
+			stereoViewerData->visibilityHash = stereoVisibilityHash;
+			stereoViewerData->visibleLights = visibleLights;
+		}
+	}
+
+	/*!
+	* \brief Removes the renderables hidden from a viewer by occluders from the result of a frustum culling
+	*
+	* Sets the visible renderables and the depth visibility hash of the viewer.
+	*
+	* \param viewerData Viewer
+	* \param frustum Frustum of the viewer
+	* \param scratch Result of the frustum culling, which may have been done for both eyes of a stereo pair
+	* \param visibilityHash Visibility hash of the frustum culling, updated with the occluded renderables
+	*/
+	void ForwardFramePipeline::CullViewerOcclusion(ViewerData& viewerData, const Frustumf& frustum, CullingScratch& scratch, std::size_t& visibilityHash)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		viewerData.visibleRenderables = &scratch.visibleRenderables;
+
+		// Occlusion culling (every renderable inside the frustum is tested again this frame, even the ones being skipped)
+		if (viewerData.occlusionCuller && viewerData.depthPrepass)
+		{
+			OcclusionCuller& occlusionCuller = *viewerData.occlusionCuller;
+			if (IsCullingInvalidated(frustum))
+				occlusionCuller.Invalidate();
+
+			occlusionCuller.Prepare();
+
+			viewerData.unoccludedRenderables.clear();
+			for (std::size_t i = 0; i < scratch.visibleRenderables.size(); ++i)
+			{
+				const FramePipelinePass::VisibleRenderable& visibleRenderable = scratch.visibleRenderables[i];
+				std::size_t renderableIndex = scratch.visibleRenderableIndices[i];
+				UInt8 generation = m_renderablePool.RetrieveFromIndex(renderableIndex)->generation;
+
+				occlusionCuller.AddCandidate(renderableIndex, visibleRenderable.worldAABB, generation);
+				if (occlusionCuller.IsOccluded(renderableIndex, visibleRenderable.worldAABB, generation))
+					visibilityHash = CombineHash(visibilityHash, renderableIndex);
+				else
+					viewerData.unoccludedRenderables.push_back(visibleRenderable);
+			}
+
+			viewerData.visibleRenderables = &viewerData.unoccludedRenderables;
+		}
+
+		// Lights update don't trigger a rebuild of the depth pre-pass
+		viewerData.depthVisibilityHash = visibilityHash;
+	}
+
+	void ForwardFramePipeline::InvalidateRenderableCulling(std::size_t renderableIndex)
+	{
+		// Renderables which never had their bounds computed can't be visible yet
+		const RenderableData* renderableData = m_renderablePool.RetrieveFromIndex(renderableIndex);
+		if (renderableData->cullingProxy == DynamicAABBTree::InvalidProxy)
+			return;
+
+		m_invalidatedCullingBoxes.push_back(Boxf::FromExtents({ m_renderableBounds.minX[renderableIndex], m_renderableBounds.minY[renderableIndex], m_renderableBounds.minZ[renderableIndex] }, { m_renderableBounds.maxX[renderableIndex], m_renderableBounds.maxY[renderableIndex], m_renderableBounds.maxZ[renderableIndex] }));
 	}
 
 	void ForwardFramePipeline::RegisterMaterialInstance(MaterialInstance* materialInstance)
@@ -715,6 +1610,217 @@ namespace Nz
 		it->second.usedCount++;
 	}
 
+	void ForwardFramePipeline::ReportTextureUsage(const AbstractViewer& viewer, const std::vector<FramePipelinePass::VisibleRenderable>& visibleRenderables)
+	{
+		const ViewerInstance& viewerInstance = viewer.GetViewerInstance();
+		const Matrix4f& projectionMatrix = viewerInstance.GetProjectionMatrix();
+		const Vector3f& eyePosition = viewerInstance.GetEyePosition();
+
+		// Pixels covered by one world unit at distance one (or at any distance for orthographic projections)
+		float projectionScale = std::abs(projectionMatrix.m22) * 0.5f * float(viewer.GetRenderViewport().height);
+		bool isPerspective = (projectionMatrix.m44 == 0.f);
+
+		for (const FramePipelinePass::VisibleRenderable& visibleRenderable : visibleRenderables)
+		{
+			float screenSize = ComputeScreenSize(visibleRenderable.worldAABB, eyePosition, projectionScale, isPerspective);
+
+			const InstancedRenderable* instancedRenderable = visibleRenderable.instancedRenderable;
+			for (std::size_t i = 0; i < instancedRenderable->GetMaterialCount(); ++i)
+			{
+				if (const auto& materialInstance = instancedRenderable->GetMaterial(i))
+					m_textureStreamer->ReportMaterialUsage(materialInstance.get(), screenSize);
+			}
+		}
+	}
+
+	void ForwardFramePipeline::SelectLODs(ViewerData& viewerData, std::size_t& visibilityHash)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		const ViewerInstance& viewerInstance = viewerData.viewer->GetViewerInstance();
+		const Matrix4f& projectionMatrix = viewerInstance.GetProjectionMatrix();
+		const Vector3f& eyePosition = viewerInstance.GetEyePosition();
+
+		float projectionScale = std::abs(projectionMatrix.m22) * 0.5f * float(viewerData.viewer->GetRenderViewport().height);
+		bool isPerspective = (projectionMatrix.m44 == 0.f);
+
+		// FrustumCull outputs visible renderables in the same order as their indices
+		CullingScratch& scratch = viewerData.cullingScratch;
+		assert(scratch.visibleRenderables.size() == scratch.visibleRenderableIndices.size());
+		for (std::size_t i = 0; i < scratch.visibleRenderables.size(); ++i)
+		{
+			FramePipelinePass::VisibleRenderable& visibleRenderable = scratch.visibleRenderables[i];
+
+			std::size_t lodCount = visibleRenderable.instancedRenderable->GetLODCount();
+			if (lodCount <= 1)
+				continue;
+
+			std::size_t renderableIndex = scratch.visibleRenderableIndices[i];
+			if (renderableIndex >= viewerData.renderableLODs.size())
+				viewerData.renderableLODs.resize(renderableIndex + 1, 0);
+
+			float screenSize = ComputeScreenSize(visibleRenderable.worldAABB, eyePosition, projectionScale, isPerspective);
+			auto GetPixelError = [&](std::size_t lodIndex)
+			{
+				return visibleRenderable.instancedRenderable->GetLODError(lodIndex) * screenSize;
+			};
+
+			// Start from the level used by the previous frame, refine it if its error became visible and only coarsen it with some margin
+			std::size_t lodIndex = std::min<std::size_t>(viewerData.renderableLODs[renderableIndex], lodCount - 1);
+			while (lodIndex > 0 && GetPixelError(lodIndex) > LODErrorThreshold)
+				lodIndex--;
+
+			while (lodIndex + 1 < lodCount && GetPixelError(lodIndex + 1) <= LODErrorThreshold * (1.f - LODHysteresis))
+				lodIndex++;
+
+			viewerData.renderableLODs[renderableIndex] = static_cast<UInt8>(std::min<std::size_t>(lodIndex, std::numeric_limits<UInt8>::max()));
+			visibleRenderable.lodIndex = viewerData.renderableLODs[renderableIndex];
+
+			visibilityHash = CombineHash(visibilityHash, CombineHash(renderableIndex, visibleRenderable.lodIndex));
+		}
+	}
+
+	void ForwardFramePipeline::UpdateLightBounds(std::size_t lightIndex)
+	{
+		LightData* lightData = m_lightPool.RetrieveFromIndex(lightIndex);
+
+		// Infinite lights (such as directional lights) can't be stored in the tree and are always tested
+		const BoundingVolumef& boundingVolume = lightData->light->GetBoundingVolume();
+		if (boundingVolume.extent == Extent::Finite)
+		{
+			if (lightData->cullingProxy == DynamicAABBTree::InvalidProxy)
+				lightData->cullingProxy = m_lightTree.AddProxy(boundingVolume.aabb, lightIndex);
+			else
+				m_lightTree.MoveProxy(lightData->cullingProxy, boundingVolume.aabb);
+
+			m_unboundedLights.UnboundedReset(lightIndex);
+		}
+		else
+		{
+			if (lightData->cullingProxy != DynamicAABBTree::InvalidProxy)
+			{
+				m_lightTree.RemoveProxy(lightData->cullingProxy);
+				lightData->cullingProxy = DynamicAABBTree::InvalidProxy;
+			}
+
+			if (boundingVolume.extent == Extent::Infinite)
+				m_unboundedLights.UnboundedSet(lightIndex);
+			else
+				m_unboundedLights.UnboundedReset(lightIndex);
+		}
+	}
+
+	void ForwardFramePipeline::UpdateRenderScale(ViewerData& viewerData)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		DynamicResolutionData& dynamicResolution = *viewerData.dynamicResolution;
+		const DynamicResolutionParams& params = dynamicResolution.params;
+
+		// Frame time of the last frames doesn't reflect the last change yet
+		if (++dynamicResolution.framesSinceChange < RenderScaleSettleFrames)
+			return;
+
+		ViewerInstance& viewerInstance = viewerData.viewer->GetViewerInstance();
+		float renderScale = viewerInstance.GetRenderScale();
+		float targetFrameTime = params.targetFrameTime.AsSeconds();
+
+		// Rendering cost is mostly proportional to the pixel count, which is proportional to the squared scale
+		float newScale = renderScale;
+		if (m_averageFrameTime > targetFrameTime * RenderScaleUpperMargin)
+		{
+			newScale = std::floor(renderScale * std::sqrt(targetFrameTime / m_averageFrameTime) / RenderScaleStep) * RenderScaleStep;
+
+			// Don't try to raise the scale again as often if it was already too high
+			if (dynamicResolution.isProbing)
+				dynamicResolution.probeInterval = std::min(dynamicResolution.probeInterval * 2, RenderScaleMaxProbeInterval);
+		}
+		else if (m_averageFrameTime < targetFrameTime * RenderScaleLowerMargin)
+			newScale = std::floor(renderScale * std::sqrt(targetFrameTime / m_averageFrameTime) / RenderScaleStep) * RenderScaleStep;
+		else
+		{
+			if (dynamicResolution.isProbing)
+				dynamicResolution.probeInterval = RenderScaleProbeInterval;
+
+			// Frame time may be capped by vertical sync, try a higher scale from time to time to find out if there's room for it
+			if (dynamicResolution.framesSinceChange >= dynamicResolution.probeInterval)
+				newScale = renderScale + RenderScaleStep;
+		}
+
+		newScale = std::clamp(newScale, params.minScale, params.maxScale);
+		dynamicResolution.isProbing = false;
+
+		if (std::abs(newScale - renderScale) < RenderScaleStep * 0.5f)
+			return;
+
+		dynamicResolution.framesSinceChange = 0;
+		dynamicResolution.isProbing = (newScale > renderScale && m_averageFrameTime >= targetFrameTime * RenderScaleLowerMargin);
+
+		viewerInstance.UpdateRenderScale(newScale);
+
+		// Recorded command buffers use the previous viewport
+		if (viewerData.depthPrepass)
+			viewerData.depthPrepass->InvalidateCommandBuffers();
+
+		viewerData.forwardPass->InvalidateCommandBuffers();
+	}
+
+	void ForwardFramePipeline::UpdateRenderableBounds()
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		for (std::size_t renderableIndex : m_invalidatedRenderableBounds.IterBits())
+		{
+			RenderableData* renderableData = m_renderablePool.RetrieveFromIndex(renderableIndex);
+			const WorldInstancePtr& worldInstance = m_worldInstances.RetrieveFromIndex(renderableData->worldInstanceIndex)->worldInstance;
+
+			// Both the previous and the new bounds are invalidated
+			InvalidateRenderableCulling(renderableIndex);
+
+			Boxf worldAABB = ComputeWorldAABB(renderableData->renderable->GetAABB(), worldInstance->GetWorldMatrix());
+			m_invalidatedCullingBoxes.push_back(worldAABB);
+			m_renderableBounds.minX[renderableIndex] = worldAABB.x;
+			m_renderableBounds.minY[renderableIndex] = worldAABB.y;
+			m_renderableBounds.minZ[renderableIndex] = worldAABB.z;
+			m_renderableBounds.maxX[renderableIndex] = worldAABB.x + worldAABB.width;
+			m_renderableBounds.maxY[renderableIndex] = worldAABB.y + worldAABB.height;
+			m_renderableBounds.maxZ[renderableIndex] = worldAABB.z + worldAABB.depth;
+
+			if (renderableData->cullingProxy == DynamicAABBTree::InvalidProxy)
+				renderableData->cullingProxy = m_renderableTree.AddProxy(worldAABB, renderableIndex);
+			else
+				m_renderableTree.MoveProxy(renderableData->cullingProxy, worldAABB);
+		}
+		m_invalidatedRenderableBounds.Clear();
+	}
+
+	void ForwardFramePipeline::UpdateRenderableElements()
+	{
+		if (!m_invalidatedRenderableElements.TestAny())
+			return;
+
+		// TODO: Invalidate only relevant passes
+		for (auto& viewerData : m_viewerPool)
+		{
+			UInt32 viewerRenderMask = viewerData.viewer->GetRenderMask();
+
+			bool invalidateDepthPrepass = false;
+			for (std::size_t renderableIndex : m_invalidatedRenderableElements.IterBits())
+			{
+				const RenderableData* renderableData = m_renderablePool.RetrieveFromIndex(renderableIndex);
+				if (viewerRenderMask & renderableData->renderMask)
+				{
+					viewerData.forwardPass->InvalidateElements(renderableData->renderable);
+					invalidateDepthPrepass = true;
+				}
+			}
+
+			if (invalidateDepthPrepass && viewerData.depthPrepass)
+				viewerData.depthPrepass->InvalidateElements();
+		}
+		m_invalidatedRenderableElements.Clear();
+	}
+
 	void ForwardFramePipeline::UnregisterMaterialInstance(MaterialInstance* materialInstance)
 	{
 		auto it = m_materialInstances.find(materialInstance);
@@ -9,17 +9,47 @@
 #include <Nazara/Graphics/FramePipeline.hpp>
 #include <Nazara/Graphics/Graphics.hpp>
 #include <Nazara/Graphics/InstancedRenderable.hpp>
+#include <Nazara/Graphics/LightShadowData.hpp>
 #include <Nazara/Graphics/Material.hpp>
 #include <Nazara/Graphics/PredefinedShaderStructs.hpp>
 #include <Nazara/Graphics/ViewerInstance.hpp>
 #include <Nazara/Renderer/CommandBufferBuilder.hpp>
 #include <Nazara/Renderer/RenderFrame.hpp>
+#include <algorithm>
+#include <cmath>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
 {
-	ForwardPipelinePass::ForwardPipelinePass(FramePipeline& owner, ElementRendererRegistry& elementRegistry, AbstractViewer* viewer) :
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		bool EnsureStorageBuffer(std::shared_ptr<RenderBuffer>& buffer, UInt64 size, RenderFrame& renderFrame, const char* debugName)
+		{
+			UInt64 capacity = (buffer) ? buffer->GetSize() : 0;
+			if (buffer && capacity >= size)
+				return false;
+
+			if (buffer)
+				renderFrame.PushForRelease(std::move(buffer));
+
+			buffer = Graphics::Instance()->GetRenderDevice()->InstantiateBuffer(BufferType::Storage, std::max({ size, capacity * 2, UInt64(1024) }), BufferUsage::DeviceLocal | BufferUsage::Dynamic | BufferUsage::Write);
+			buffer->UpdateDebugName(debugName);
+
+			return true;
+		}
+	}
+
+	/*!
+	* \brief Constructs the forward pass of a viewer
+	*
+	* \param excludedPassIndex Material pass whose materials are not rendered by this pass (as they're rendered by another pass, such as a G-buffer pass)
+	*/
+	ForwardPipelinePass::ForwardPipelinePass(FramePipeline& owner, ElementRendererRegistry& elementRegistry, AbstractViewer* viewer, std::size_t excludedPassIndex) :
+	m_elementGeneration(0),
+	m_excludedPassIndex(excludedPassIndex),
+	m_globalLightCount(0),
 	m_lastVisibilityHash(0),
+	m_shadowedLightCount(0),
 	m_viewer(viewer),
 	m_elementRegistry(elementRegistry),
 	m_pipeline(owner),
@@ -28,174 +58,107 @@ namespace Nz
 	{
 		Graphics* graphics = Graphics::Instance();
 		m_forwardPassIndex = graphics->GetMaterialPassRegistry().GetPassIndex("ForwardPass");
-		m_lightUboPool = std::make_shared<LightUboPool>();
+
+		m_shadowMaps.fill(nullptr);
+
+		if (graphics->IsClusteredLightingEnabled())
+		{
+			m_lightDataBuffer = graphics->GetRenderDevice()->InstantiateBuffer(BufferType::Uniform, PredefinedLightData::GetOffsets().totalSize, BufferUsage::DeviceLocal | BufferUsage::Write);
+			m_lightDataBuffer->UpdateDebugName("Forward light data");
+		}
 	}
 
 	void ForwardPipelinePass::Prepare(RenderFrame& renderFrame, const Frustumf& frustum, const std::vector<FramePipelinePass::VisibleRenderable>& visibleRenderables, const std::vector<std::size_t>& visibleLights, std::size_t visibilityHash)
 	{
-		if (m_lastVisibilityHash != visibilityHash || m_rebuildElements) //< FIXME
-		{
-			renderFrame.PushForRelease(std::move(m_renderElements));
-			m_renderElements.clear();
-			m_renderQueueRegistry.Clear();
-			m_renderQueue.Clear();
-			m_lightBufferPerLights.clear();
-			m_lightPerRenderElement.clear();
+		// Lights are uploaded and binned every frame, element renderers only have to prepare elements again when light buffers were reallocated
+		bool rebuildRenderStates = PrepareLights(renderFrame, visibleLights);
 
-			for (auto& lightDataUbo : m_lightDataBuffers)
+		if (m_lastVisibilityHash != visibilityHash || m_rebuildElements || !m_invalidatedRenderables.empty())
+		{
+			// Elements are kept per renderable as long as it stays visible, only invalidations require to rebuild all of them
+			if (m_rebuildElements)
 			{
-				renderFrame.PushReleaseCallback([pool = m_lightUboPool, lightUbo = std::move(lightDataUbo.renderBuffer)]() mutable
-				{
-					pool->lightUboBuffers.push_back(std::move(lightUbo));
-				});
-			}
-			m_lightDataBuffers.clear();
+				for (auto&& [key, renderableElements] : m_renderableElements)
+					renderFrame.PushForRelease(std::move(renderableElements.elements));
 
-			Graphics* graphics = Graphics::Instance();
+				m_renderableElements.clear();
+				m_renderQueue.Clear();
+			}
 
-			PredefinedLightData lightOffsets = PredefinedLightData::GetOffsets();
-			std::size_t lightUboAlignedSize = AlignPow2(lightOffsets.totalSize, SafeCast<std::size_t>(graphics->GetRenderDevice()->GetDeviceInfo().limits.minUniformBufferOffsetAlignment));
+			bool hasRemovedElements = false;
 
-			UploadPool& uploadPool = renderFrame.GetUploadPool();
+			m_elementGeneration++;
+			m_renderQueueRegistry.Clear();
+			m_visibleElements.clear();
 
 			for (const auto& renderableData : visibleRenderables)
 			{
-				BoundingVolumef renderableBoundingVolume(renderableData.instancedRenderable->GetAABB());
-				renderableBoundingVolume.Update(renderableData.worldInstance->GetWorldMatrix());
-
-				// Select lights
-				m_renderableLights.clear();
-				for (std::size_t lightIndex : visibleLights)
-				{
-					const Light* light = m_pipeline.RetrieveLight(lightIndex);
-
-					const BoundingVolumef& boundingVolume = light->GetBoundingVolume();
-					if (boundingVolume.Intersect(renderableBoundingVolume.aabb))
-					{
-						float contributionScore = light->ComputeContributionScore(renderableBoundingVolume);
-						m_renderableLights.push_back({ light, lightIndex, contributionScore });
-					}
-				}
-
-				// Sort lights
-				std::sort(m_renderableLights.begin(), m_renderableLights.end(), [&](const RenderableLight& lhs, const RenderableLight& rhs)
-				{
-					return lhs.contributionScore < rhs.contributionScore;
-				});
-
-				std::size_t lightCount = std::min(m_renderableLights.size(), MaxLightCountPerDraw);
-
-				LightKey lightKey;
-				lightKey.fill(nullptr);
-				for (std::size_t i = 0; i < lightCount; ++i)
-					lightKey[i] = m_renderableLights[i].light;
-
-				RenderBufferView lightUboView;
-
-				auto it = m_lightBufferPerLights.find(lightKey);
-				if (it == m_lightBufferPerLights.end())
-				{
-					// Prepare light ubo upload
-
-					// Find light ubo
-					LightDataUbo* targetLightData = nullptr;
-					for (auto& lightUboData : m_lightDataBuffers)
-					{
-						if (lightUboData.offset + lightUboAlignedSize <= lightUboData.renderBuffer->GetSize())
-						{
-							targetLightData = &lightUboData;
-							break;
-						}
-					}
-
-					if (!targetLightData)
-					{
-						// Make a new light UBO
-						auto& lightUboData = m_lightDataBuffers.emplace_back();
-
-						// Reuse from pool if possible
-						if (!m_lightUboPool->lightUboBuffers.empty())
-						{
-							lightUboData.renderBuffer = m_lightUboPool->lightUboBuffers.back();
-							m_lightUboPool->lightUboBuffers.pop_back();
-						}
-						else
-							lightUboData.renderBuffer = graphics->GetRenderDevice()->InstantiateBuffer(BufferType::Uniform, 256 * lightUboAlignedSize, BufferUsage::DeviceLocal | BufferUsage::Dynamic | BufferUsage::Write);
-
-						targetLightData = &lightUboData;
-					}
-
-					assert(targetLightData);
-					if (!targetLightData->allocation)
-						targetLightData->allocation = &uploadPool.Allocate(targetLightData->renderBuffer->GetSize());
-
-					void* lightDataPtr = static_cast<UInt8*>(targetLightData->allocation->mappedPtr) + targetLightData->offset;
-					AccessByOffset<UInt32&>(lightDataPtr, lightOffsets.lightCountOffset) = SafeCast<UInt32>(lightCount);
-
-					UInt8* lightPtr = static_cast<UInt8*>(lightDataPtr) + lightOffsets.lightsOffset;
-					for (std::size_t i = 0; i < lightCount; ++i)
-					{
-						m_renderableLights[i].light->FillLightData(lightPtr);
-						lightPtr += lightOffsets.lightSize;
-					}
-
-					// Associate render element with light ubo
-					lightUboView = RenderBufferView(targetLightData->renderBuffer.get(), targetLightData->offset, lightUboAlignedSize);
-
-					targetLightData->offset += lightUboAlignedSize;
-
-					m_lightBufferPerLights.emplace(lightKey, lightUboView);
-				}
-				else
-					lightUboView = it->second;
-
 				InstancedRenderable::ElementData elementData{
 					&renderableData.scissorBox,
 					renderableData.skeletonInstance,
-					renderableData.worldInstance
+					renderableData.worldInstance,
+					renderableData.lodIndex,
+					m_excludedPassIndex
 				};
 
-				std::size_t previousCount = m_renderElements.size();
-				renderableData.instancedRenderable->BuildElement(m_elementRegistry, elementData, m_forwardPassIndex, m_renderElements);
-				for (std::size_t i = previousCount; i < m_renderElements.size(); ++i)
+				// Switching to another level of detail builds new elements, the previous ones are released as any element which is no longer visible
+				auto [elementIt, inserted] = m_renderableElements.try_emplace(RenderableElementKey{ renderableData.instancedRenderable, renderableData.skeletonInstance, renderableData.worldInstance, renderableData.lodIndex });
+				RenderableElements& renderableElements = elementIt->second;
+				if (renderableElements.generation == m_elementGeneration)
+					continue; //< same renderable listed twice
+
+				renderableElements.generation = m_elementGeneration;
+
+				if (!inserted && m_invalidatedRenderables.count(renderableData.instancedRenderable) > 0)
 				{
-					const RenderElement* element = m_renderElements[i].GetElement();
+					hasRemovedElements = true;
+					renderFrame.PushForRelease(std::move(renderableElements.elements));
+					renderableElements.elements.clear();
+					inserted = true;
+				}
 
-					LightPerElementData perElementData;
-					perElementData.lightCount = lightCount;
-					perElementData.lightUniformBuffer = lightUboView;
+				if (inserted)
+				{
+					renderableData.instancedRenderable->BuildElement(m_elementRegistry, elementData, m_forwardPassIndex, renderableElements.elements);
+					for (const RenderElementOwner& renderElement : renderableElements.elements)
+						m_renderQueue.Insert(renderElement.GetElement());
+				}
 
-					for (std::size_t j = 0; j < lightCount; ++j)
-						perElementData.shadowMaps[j] = m_pipeline.RetrieveLightShadowmap(m_renderableLights[j].lightIndex);
+				for (const RenderElementOwner& renderElement : renderableElements.elements)
+				{
+					const RenderElement* element = renderElement.GetElement();
 
-					m_lightPerRenderElement.emplace(element, perElementData);
+					// Register elements to the registry here since it's rebuilt every time
+					element->Register(m_renderQueueRegistry);
+					m_visibleElements.insert(element);
 				}
 			}
 
-			for (const auto& renderElement : m_renderElements)
+			// Release elements of renderables which are no longer visible and remove them from the render queue (keeping the previous order of remaining elements)
+			for (auto it = m_renderableElements.begin(); it != m_renderableElements.end();)
 			{
-				renderElement->Register(m_renderQueueRegistry);
-				m_renderQueue.Insert(renderElement.GetElement());
+				RenderableElements& renderableElements = it->second;
+				if (renderableElements.generation != m_elementGeneration)
+				{
+					hasRemovedElements = true;
+					renderFrame.PushForRelease(std::move(renderableElements.elements));
+					it = m_renderableElements.erase(it);
+				}
+				else
+					++it;
 			}
 
-			m_renderQueueRegistry.Finalize();
-
-			renderFrame.Execute([&](CommandBufferBuilder& builder)
+			if (hasRemovedElements)
 			{
-				builder.BeginDebugRegion("Light UBO Update", Color::Yellow());
+				m_renderQueue.RemoveIf([&](const RenderElement* element)
 				{
-					for (auto& lightUboData : m_lightDataBuffers)
-					{
-						if (!lightUboData.allocation)
-							continue;
+					return m_visibleElements.find(element) == m_visibleElements.end();
+				});
+			}
 
-						builder.CopyBuffer(*lightUboData.allocation, RenderBufferView(lightUboData.renderBuffer.get(), 0, lightUboData.offset));
-					}
+			m_invalidatedRenderables.clear();
 
-					builder.PostTransferBarrier();
-				}
-				builder.EndDebugRegion();
-			}, QueueType::Transfer);
+			m_renderQueueRegistry.Finalize();
 
 			m_lastVisibilityHash = visibilityHash;
 			m_rebuildElements = true;
@@ -207,7 +170,7 @@ namespace Nz
 			return element->ComputeSortingScore(frustum, m_renderQueueRegistry);
 		});
 
-		if (m_rebuildElements)
+		if (m_rebuildElements || rebuildRenderStates)
 		{
 			m_elementRegistry.ForEachElementRenderer([&](std::size_t elementType, ElementRenderer& elementRenderer)
 			{
@@ -222,39 +185,44 @@ namespace Nz
 
 			const auto& viewerInstance = m_viewer->GetViewerInstance();
 
-			auto& lightPerRenderElement = m_lightPerRenderElement;
-			m_elementRegistry.ProcessRenderQueue(m_renderQueue, [&](std::size_t elementType, const Pointer<const RenderElement>* elements, std::size_t elementCount)
+			// Every element reads lights from the same clusters
+			ElementRenderer::RenderStates renderStates;
+			if (m_lightDataBuffer)
 			{
-				ElementRenderer& elementRenderer = m_elementRegistry.GetElementRenderer(elementType);
+				renderStates.lightArray = RenderBufferView(m_lightBuffer.get());
+				renderStates.lightClusters = RenderBufferView(m_lightClusterBuffer.get());
+				renderStates.lightData = RenderBufferView(m_lightDataBuffer.get());
+			}
 
-				m_renderStates.clear();
+			for (std::size_t i = 0; i < m_shadowMaps.size(); ++i)
+			{
+				const Texture* texture = m_shadowMaps[i];
+				if (!texture)
+					continue;
 
-				m_renderStates.reserve(elementCount);
-				for (std::size_t i = 0; i < elementCount; ++i)
+				switch (texture->GetType())
 				{
-					auto it = lightPerRenderElement.find(elements[i]);
-					assert(it != lightPerRenderElement.end());
-
-					const LightPerElementData& lightData = it->second;
-
-					auto& renderStates = m_renderStates.emplace_back();
-					renderStates.lightData = lightData.lightUniformBuffer;
-
-					for (std::size_t j = 0; j < lightData.lightCount; ++j)
-					{
-						const Texture* texture = lightData.shadowMaps[j];
-						if (!texture)
-							continue;
-
-						if (texture->GetType() == ImageType::E2D)
-							renderStates.shadowMaps2D[j] = texture;
-						else
-						{
-							assert(texture->GetType() == ImageType::Cubemap);
-							renderStates.shadowMapsCube[j] = texture;
-						}
-					}
+					case ImageType::E2D:
+						renderStates.shadowMaps2D[i] = texture;
+						break;
+
+					case ImageType::E2D_Array:
+						renderStates.shadowMapsDirectional[i] = texture;
+						break;
+
+					default:
+						assert(texture->GetType() == ImageType::Cubemap);
+						renderStates.shadowMapsCube[i] = texture;
+						break;
 				}
+			}
+
+			m_elementRegistry.ProcessRenderQueue(m_renderQueue, [&](std::size_t elementType, const Pointer<const RenderElement>* elements, std::size_t elementCount)
+			{
+				ElementRenderer& elementRenderer = m_elementRegistry.GetElementRenderer(elementType);
+
+				m_renderStates.clear();
+				m_renderStates.resize(elementCount, renderStates);
 
 				elementRenderer.Prepare(viewerInstance, *m_elementRendererData[elementType], renderFrame, elementCount, elements, m_renderStates.data());
 			});
@@ -267,6 +235,12 @@ namespace Nz
 			m_rebuildCommandBuffer = true;
 			m_rebuildElements = false;
 		}
+
+		m_elementRegistry.ForEachElementRenderer([&](std::size_t elementType, ElementRenderer& elementRenderer)
+		{
+			if (elementType < m_elementRendererData.size() && m_elementRendererData[elementType])
+				elementRenderer.Update(renderFrame, *m_elementRendererData[elementType]);
+		});
 	}
 
 	void ForwardPipelinePass::RegisterMaterialInstance(const MaterialInstance& materialInstance)
@@ -307,6 +281,196 @@ namespace Nz
 		forwardPass.SetClearColor(0, m_viewer->GetClearColor());
 		forwardPass.SetDepthStencilClear(1.f, 0);
 
+		SetupFramePass(forwardPass);
+
+		return forwardPass;
+	}
+
+	/*!
+	* \brief Registers the forward pass to draw over an existing color buffer (such as the output of deferred lighting), depth is tested against the depth buffer without clearing it
+	*/
+	FramePass& ForwardPipelinePass::RegisterToFrameGraph(FrameGraph& frameGraph, std::size_t inputColorBufferIndex, std::size_t outputColorBufferIndex, std::size_t depthBufferIndex)
+	{
+		FramePass& forwardPass = frameGraph.AddPass("Forward pass");
+		forwardPass.AddInput(inputColorBufferIndex);
+		forwardPass.AddOutput(outputColorBufferIndex);
+		forwardPass.SetDepthStencilInput(depthBufferIndex);
+
+		SetupFramePass(forwardPass);
+
+		return forwardPass;
+	}
+
+	void ForwardPipelinePass::UnregisterMaterialInstance(const MaterialInstance& materialInstance)
+	{
+		auto it = m_materialInstances.find(&materialInstance);
+		if (it != m_materialInstances.end())
+		{
+			if (--it->second.usedCount == 0)
+				m_materialInstances.erase(it);
+		}
+	}
+
+	/*!
+	* \brief Uploads the visible lights of the viewer and bins them in clusters, returns true if the light bindings of the elements changed
+	*
+	* Shadow casting lights go first as they're evaluated for every fragment, as well as lights without bounds (such as directional lights).
+	*/
+	bool ForwardPipelinePass::PrepareLights(RenderFrame& renderFrame, const std::vector<std::size_t>& visibleLights)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		static PredefinedLightData lightOffsets = PredefinedLightData::GetOffsets();
+
+		// Materials don't declare lighting bindings without clustered lighting
+		if (!m_lightDataBuffer)
+			return false;
+
+		m_lights.clear();
+		m_lightIndices.clear();
+
+		std::array<const Texture*, PredefinedLightData::MaxShadowedLightCount> shadowMaps;
+		shadowMaps.fill(nullptr);
+
+		for (std::size_t lightIndex : visibleLights)
+		{
+			if (m_lights.size() >= PredefinedLightData::MaxShadowedLightCount)
+				break;
+
+			const Texture* shadowMap = m_pipeline.RetrieveLightShadowmap(lightIndex, m_viewer);
+			if (!shadowMap)
+				continue;
+
+			shadowMaps[m_lights.size()] = shadowMap;
+			m_lights.push_back(m_pipeline.RetrieveLight(lightIndex));
+			m_lightIndices.push_back(lightIndex);
+		}
+		m_shadowedLightCount = m_lights.size();
+
+		auto AddLights = [&](auto&& predicate)
+		{
+			for (std::size_t lightIndex : visibleLights)
+			{
+				const Light* light = m_pipeline.RetrieveLight(lightIndex);
+				if (!predicate(light->GetBoundingVolume()))
+					continue;
+
+				if (std::find(m_lightIndices.begin(), m_lightIndices.begin() + m_shadowedLightCount, lightIndex) != m_lightIndices.begin() + m_shadowedLightCount)
+					continue;
+
+				m_lights.push_back(light);
+				m_lightIndices.push_back(lightIndex);
+			}
+		};
+
+		// Null volumes don't light anything
+		AddLights([](const BoundingVolumef& boundingVolume) { return boundingVolume.IsInfinite(); });
+		m_globalLightCount = m_lights.size();
+
+		AddLights([](const BoundingVolumef& boundingVolume) { return boundingVolume.IsFinite(); });
+
+		const ViewerInstance& viewerInstance = m_viewer->GetViewerInstance();
+
+		// Depth slices are distributed between the near and far planes of the projection
+		auto ComputeViewDepth = [&](float ndcDepth)
+		{
+			Vector4f viewPos = viewerInstance.GetInvProjectionMatrix().Transform(Vector4f(0.f, 0.f, ndcDepth, 1.f));
+			return -viewPos.z / viewPos.w;
+		};
+
+		float zNear = std::max(ComputeViewDepth(0.f), 0.01f);
+		float zFar = ComputeViewDepth(1.f);
+		if (!std::isfinite(zFar) || zFar <= zNear)
+			zFar = zNear * 10000.f; //< infinite projection
+
+		constexpr UInt32 clusterStride = 1 + MaxLightsPerCluster / 4;
+		constexpr UInt64 clusterDataSize = UInt64(ClusterCountX) * ClusterCountY * ClusterCountZ * clusterStride * sizeof(Vector4ui32);
+
+		UInt64 lightBufferSize = m_lights.size() * lightOffsets.lightSize;
+
+		bool rebuildBindings = false;
+		rebuildBindings |= EnsureStorageBuffer(m_lightBuffer, lightBufferSize, renderFrame, "Forward lights");
+		rebuildBindings |= EnsureStorageBuffer(m_lightClusterBuffer, clusterDataSize, renderFrame, "Forward light clusters");
+
+		if (rebuildBindings || !m_lightClusteringBinding)
+			UpdateClusteringBinding(renderFrame);
+
+		if (m_shadowMaps != shadowMaps)
+		{
+			m_shadowMaps = shadowMaps;
+			rebuildBindings = true;
+		}
+
+		UploadPool& uploadPool = renderFrame.GetUploadPool();
+
+		auto& lightDataAllocation = uploadPool.Allocate(lightOffsets.totalSize);
+		{
+			void* lightDataPtr = lightDataAllocation.mappedPtr;
+
+			AccessByOffset<UInt32&>(lightDataPtr, lightOffsets.clusterCountXOffset) = ClusterCountX;
+			AccessByOffset<UInt32&>(lightDataPtr, lightOffsets.clusterCountYOffset) = ClusterCountY;
+			AccessByOffset<UInt32&>(lightDataPtr, lightOffsets.clusterCountZOffset) = ClusterCountZ;
+			AccessByOffset<UInt32&>(lightDataPtr, lightOffsets.clusterStrideOffset) = clusterStride;
+			AccessByOffset<UInt32&>(lightDataPtr, lightOffsets.lightCountOffset) = SafeCast<UInt32>(m_lights.size());
+			AccessByOffset<UInt32&>(lightDataPtr, lightOffsets.globalLightCountOffset) = SafeCast<UInt32>(m_globalLightCount);
+			AccessByOffset<UInt32&>(lightDataPtr, lightOffsets.shadowedLightCountOffset) = SafeCast<UInt32>(m_shadowedLightCount);
+			AccessByOffset<float&>(lightDataPtr, lightOffsets.zNearOffset) = zNear;
+			AccessByOffset<float&>(lightDataPtr, lightOffsets.zFarOffset) = zFar;
+			AccessByOffset<float&>(lightDataPtr, lightOffsets.depthSliceScaleOffset) = ClusterCountZ / std::log2(zFar / zNear);
+		}
+
+		UploadPool::Allocation* lightAllocation = nullptr;
+		if (lightBufferSize > 0)
+		{
+			lightAllocation = &uploadPool.Allocate(lightBufferSize);
+
+			UInt8* lightPtr = static_cast<UInt8*>(lightAllocation->mappedPtr);
+			for (std::size_t i = 0; i < m_lights.size(); ++i)
+			{
+				m_lights[i]->FillLightData(lightPtr);
+				if (const LightShadowData* shadowData = m_pipeline.RetrieveLightShadowData(m_lightIndices[i]))
+					shadowData->FillShadowData(lightPtr, m_viewer);
+
+				lightPtr += lightOffsets.lightSize;
+			}
+		}
+
+		renderFrame.Execute([&](CommandBufferBuilder& builder)
+		{
+			builder.BeginDebugRegion("Forward lights update", Color::Yellow());
+			{
+				builder.CopyBuffer(lightDataAllocation, RenderBufferView(m_lightDataBuffer.get(), 0, lightOffsets.totalSize));
+				if (lightAllocation)
+					builder.CopyBuffer(*lightAllocation, RenderBufferView(m_lightBuffer.get(), 0, lightBufferSize));
+
+				builder.PostTransferBarrier();
+			}
+			builder.EndDebugRegion();
+		}, QueueType::Transfer);
+
+		// Clusters are rebuilt even without binned lights, as their headers must be reset
+		renderFrame.Execute([&](CommandBufferBuilder& builder)
+		{
+			Graphics* graphics = Graphics::Instance();
+
+			builder.BeginDebugRegion("Forward light clustering", Color::Orange());
+			{
+				builder.MemoryBarrier(PipelineStage::FragmentShader, PipelineStage::ComputeShader, MemoryAccess::ShaderRead, MemoryAccess::ShaderWrite);
+
+				builder.BindComputePipeline(*graphics->GetLightClusteringPipeline());
+				builder.BindComputeShaderBinding(0, *m_lightClusteringBinding);
+				builder.Dispatch((ClusterCountX + 3) / 4, (ClusterCountY + 3) / 4, (ClusterCountZ + 3) / 4);
+
+				builder.MemoryBarrier(PipelineStage::ComputeShader, PipelineStage::FragmentShader, MemoryAccess::ShaderWrite, MemoryAccess::ShaderRead);
+			}
+			builder.EndDebugRegion();
+		}, QueueType::Compute);
+
+		return rebuildBindings;
+	}
+
+	void ForwardPipelinePass::SetupFramePass(FramePass& forwardPass)
+	{
 		forwardPass.SetExecutionCallback([&]()
 		{
 			return (m_rebuildCommandBuffer) ? FramePassExecution::UpdateAndExecute : FramePassExecution::Execute;
@@ -314,7 +478,7 @@ namespace Nz
 
 		forwardPass.SetCommandCallback([this](CommandBufferBuilder& builder, const FramePassEnvironment& /*env*/)
 		{
-			Recti viewport = m_viewer->GetViewport();
+			Recti viewport = m_viewer->GetRenderViewport();
 
 			builder.SetScissor(viewport);
 			builder.SetViewport(viewport);
@@ -329,17 +493,48 @@ namespace Nz
 
 			m_rebuildCommandBuffer = false;
 		});
-
-		return forwardPass;
 	}
 
-	void ForwardPipelinePass::UnregisterMaterialInstance(const MaterialInstance& materialInstance)
+	void ForwardPipelinePass::UpdateClusteringBinding(RenderFrame& renderFrame)
 	{
-		auto it = m_materialInstances.find(&materialInstance);
-		if (it != m_materialInstances.end())
-		{
-			if (--it->second.usedCount == 0)
-				m_materialInstances.erase(it);
-		}
+		static PredefinedLightData lightOffsets = PredefinedLightData::GetOffsets();
+
+		if (m_lightClusteringBinding)
+			renderFrame.PushForRelease(std::move(m_lightClusteringBinding));
+
+		m_lightClusteringBinding = Graphics::Instance()->GetLightClusteringPipelineLayout()->AllocateShaderBinding(0);
+
+		const auto& viewerBuffer = m_viewer->GetViewerInstance().GetViewerBuffer();
+
+		m_lightClusteringBinding->Update({
+			{
+				0,
+				ShaderBinding::UniformBufferBinding {
+					viewerBuffer.get(),
+					0, viewerBuffer->GetSize()
+				}
+			},
+			{
+				1,
+				ShaderBinding::UniformBufferBinding {
+					m_lightDataBuffer.get(),
+					0, lightOffsets.totalSize
+				}
+			},
+			{
+				2,
+				ShaderBinding::StorageBufferBinding {
+					m_lightBuffer.get(),
+					0, m_lightBuffer->GetSize()
+				}
+			},
+			{
+				3,
+				ShaderBinding::StorageBufferBinding {
+					m_lightClusterBuffer.get(),
+					0, m_lightClusterBuffer->GetSize()
+				}
+			}
+		});
 	}
 }
@@ -8,8 +8,11 @@
 #include <Nazara/Graphics/FrameGraph.hpp>
 #include <Nazara/Core/Algorithm.hpp>
 #include <Nazara/Graphics/Graphics.hpp>
+#include <NazaraUtils/Algorithm.hpp>
 #include <NazaraUtils/Bitset.hpp>
 #include <NazaraUtils/StackArray.hpp>
+#include <algorithm>
+#include <limits>
 #include <stdexcept>
 #include <unordered_set>
 #include <Nazara/Graphics/Debug.hpp>
@@ -76,38 +79,66 @@ namespace Nz
 			bakedPass.name = std::move(physicalPass.name);
 			bakedPass.renderPass = std::move(m_pending.renderPasses[renderPassIndex++]);
 			bakedPass.invalidationBarriers = std::move(physicalPass.textureBarrier);
+			bakedPass.releaseBarriers = std::move(physicalPass.releaseBarriers);
+			bakedPass.queueType = physicalPass.queueType;
+			bakedPass.waitedQueues = physicalPass.waitedQueues;
 
+			// Attachments are listed in the same order as the render pass attachments (see BuildPhysicalPasses)
+			const FramePass::DepthStencilClear* depthStencilClear = nullptr;
+			std::size_t depthStencilAttachmentId = FramePass::InvalidAttachmentId;
 			for (auto& subpass : physicalPass.passes)
 			{
 				const FramePass& framePass = m_framePasses[subpass.passIndex];
-				bakedPass.executionCallback = framePass.GetExecutionCallback(); //< FIXME
 
 				auto& bakedSubpass = bakedPass.subpasses.emplace_back();
+				bakedSubpass.passIndex = subpass.passIndex;
 				bakedSubpass.commandCallback = framePass.GetCommandCallback();
+				bakedSubpass.executionCallback = framePass.GetExecutionCallback();
 
 				for (const auto& output : framePass.GetOutputs())
 				{
-					bakedPass.outputTextureIndices.push_back(Retrieve(m_pending.attachmentToTextures, output.attachmentId));
+					std::size_t textureId = Retrieve(m_pending.attachmentToTextures, output.attachmentId);
+					if (std::find(bakedPass.outputTextureIndices.begin(), bakedPass.outputTextureIndices.end(), textureId) != bakedPass.outputTextureIndices.end())
+						continue; //< already written by a previous subpass
+
+					bakedPass.outputTextureIndices.push_back(textureId);
+
+					if (physicalPass.queueType == QueueType::Compute)
+						continue; //< storage textures aren't cleared by render passes
 
 					auto& clearValues = bakedPass.outputClearValues.emplace_back();
 					if (output.clearColor)
 						clearValues.color = *output.clearColor;
 				}
 
-				// Add depth-stencil clear values
-				auto& dsClearValues = bakedPass.outputClearValues.emplace_back();
-				if (const auto& depthStencilClear = framePass.GetDepthStencilClear())
+				if (physicalPass.queueType == QueueType::Compute)
+					continue;
+
+				if (!depthStencilClear && framePass.GetDepthStencilClear())
+					depthStencilClear = &framePass.GetDepthStencilClear().value();
+
+				if (depthStencilAttachmentId == FramePass::InvalidAttachmentId)
 				{
-					dsClearValues.depth = depthStencilClear->depth;
-					dsClearValues.stencil = depthStencilClear->stencil;
+					if (std::size_t attachmentId = framePass.GetDepthStencilOutput(); attachmentId != FramePass::InvalidAttachmentId)
+						depthStencilAttachmentId = attachmentId;
+					else
+						depthStencilAttachmentId = framePass.GetDepthStencilInput(); //< FIXME?
 				}
+			}
+
+			if (physicalPass.queueType == QueueType::Compute)
+				continue;
 
-				std::size_t attachmentId;
-				if (attachmentId = framePass.GetDepthStencilOutput(); attachmentId != FramePass::InvalidAttachmentId)
-					bakedPass.outputTextureIndices.push_back(Retrieve(m_pending.attachmentToTextures, attachmentId));
-				else if (attachmentId = framePass.GetDepthStencilInput(); attachmentId != FramePass::InvalidAttachmentId)
-					bakedPass.outputTextureIndices.push_back(Retrieve(m_pending.attachmentToTextures, attachmentId)); //< FIXME?
+			// Add depth-stencil clear values
+			auto& dsClearValues = bakedPass.outputClearValues.emplace_back();
+			if (depthStencilClear)
+			{
+				dsClearValues.depth = depthStencilClear->depth;
+				dsClearValues.stencil = depthStencilClear->stencil;
 			}
+
+			if (depthStencilAttachmentId != FramePass::InvalidAttachmentId)
+				bakedPass.outputTextureIndices.push_back(Retrieve(m_pending.attachmentToTextures, depthStencilAttachmentId));
 		}
 
 		std::vector<BakedFrameGraph::TextureData> bakedTextures;
@@ -121,12 +152,239 @@ namespace Nz
 		return BakedFrameGraph(std::move(bakedPasses), std::move(bakedTextures), std::move(m_pending.attachmentToTextures), std::move(m_pending.passIdToPhysicalPassIndex));
 	}
 
+	/*!
+	* \brief Computes a hash of the attachments and passes of the graph (everything but the pass callbacks)
+	* \return Structure hash
+	*
+	* Frame graphs with the same structure hash bake to the same graph, which allows to reuse a previously baked graph (see UpdateBakedCallbacks).
+	*/
+	std::size_t FrameGraph::ComputeStructureHash() const
+	{
+		std::size_t seed = 0;
+
+		HashCombine(seed, m_attachments.size());
+		for (const AttachmentType& attachmentVariant : m_attachments)
+		{
+			HashCombine(seed, attachmentVariant.index());
+
+			std::visit([&](auto&& arg)
+			{
+				using T = std::decay_t<decltype(arg)>;
+
+				if constexpr (std::is_base_of_v<FramePassAttachment, T>)
+				{
+					HashCombine(seed, arg.name);
+					HashCombine(seed, arg.format);
+					HashCombine(seed, arg.size);
+					HashCombine(seed, arg.width);
+					HashCombine(seed, arg.height);
+					HashCombine(seed, arg.transient);
+
+					if constexpr (std::is_same_v<T, AttachmentArray>)
+						HashCombine(seed, arg.layerCount);
+				}
+				else if constexpr (std::is_same_v<T, AttachmentLayer>)
+				{
+					HashCombine(seed, arg.attachmentId);
+					HashCombine(seed, arg.layerIndex);
+				}
+				else if constexpr (std::is_same_v<T, AttachmentProxy>)
+				{
+					HashCombine(seed, arg.attachmentId);
+					HashCombine(seed, arg.name);
+				}
+				else
+					static_assert(AlwaysFalse<T>::value, "non-exhaustive visitor");
+
+			}, attachmentVariant);
+		}
+
+		HashCombine(seed, m_framePasses.size());
+		for (const FramePass& framePass : m_framePasses)
+		{
+			HashCombine(seed, framePass.GetName());
+			HashCombine(seed, framePass.GetQueueType());
+
+			HashCombine(seed, framePass.GetInputs().size());
+			for (const auto& input : framePass.GetInputs())
+			{
+				HashCombine(seed, input.attachmentId);
+				HashCombine(seed, input.assumedLayout);
+				HashCombine(seed, input.doesRead);
+				HashCombine(seed, input.isInputAttachment);
+			}
+
+			// Clear values are baked in the graph
+			HashCombine(seed, framePass.GetOutputs().size());
+			for (const auto& output : framePass.GetOutputs())
+			{
+				HashCombine(seed, output.attachmentId);
+				HashCombine(seed, output.clearColor.has_value());
+				if (output.clearColor)
+				{
+					HashCombine(seed, output.clearColor->r);
+					HashCombine(seed, output.clearColor->g);
+					HashCombine(seed, output.clearColor->b);
+					HashCombine(seed, output.clearColor->a);
+				}
+			}
+
+			HashCombine(seed, framePass.GetDepthStencilInput());
+			HashCombine(seed, framePass.GetDepthStencilOutput());
+
+			const auto& depthStencilClear = framePass.GetDepthStencilClear();
+			HashCombine(seed, depthStencilClear.has_value());
+			if (depthStencilClear)
+			{
+				HashCombine(seed, depthStencilClear->depth);
+				HashCombine(seed, depthStencilClear->stencil);
+			}
+		}
+
+		HashCombine(seed, m_backbufferOutputs.size());
+		for (std::size_t backbufferOutput : m_backbufferOutputs)
+			HashCombine(seed, backbufferOutput);
+
+		return seed;
+	}
+
+	/*!
+	* \brief Replaces the pass callbacks of a graph baked from a frame graph with the same structure by the callbacks of this frame graph
+	*
+	* This allows to switch back to a previously baked graph (keeping its textures, render passes and framebuffers) when the frame graph is rebuilt.
+	* Every pass command buffer will be recorded again on the next execution.
+	*
+	* \param bakedFrameGraph Graph baked from a frame graph with the same structure hash as this one
+	*
+	* \see ComputeStructureHash
+	*/
+	void FrameGraph::UpdateBakedCallbacks(BakedFrameGraph& bakedFrameGraph) const
+	{
+		for (auto& passData : bakedFrameGraph.m_passes)
+		{
+			for (auto& subpass : passData.subpasses)
+			{
+				assert(subpass.passIndex < m_framePasses.size());
+				const FramePass& framePass = m_framePasses[subpass.passIndex];
+
+				subpass.commandCallback = framePass.GetCommandCallback();
+				subpass.executionCallback = framePass.GetExecutionCallback();
+			}
+
+			passData.forceCommandBufferRegeneration = true;
+		}
+	}
+
 	void FrameGraph::AssignPhysicalPasses()
 	{
+		constexpr std::size_t InvalidTextureId = std::numeric_limits<std::size_t>::max();
+
+		// Backends without subpasses support emulate them by executing every subpass on the whole framebuffer
+		bool isSubpassMergingSupported = Graphics::Instance()->GetRenderDevice()->GetEnabledFeatures().multipleSubpasses;
+
+		auto GetTextureId = [&](std::size_t attachmentId)
+		{
+			return Retrieve(m_pending.attachmentToTextures, attachmentId);
+		};
+
+		auto GetDepthStencilTextureId = [&](const FramePass& pass)
+		{
+			std::size_t attachmentId = pass.GetDepthStencilOutput();
+			if (attachmentId == FramePass::InvalidAttachmentId)
+				attachmentId = pass.GetDepthStencilInput();
+
+			return (attachmentId != FramePass::InvalidAttachmentId) ? GetTextureId(attachmentId) : InvalidTextureId;
+		};
+
+		auto IsColorOutput = [&](const FramePass& pass, std::size_t attachmentId)
+		{
+			attachmentId = ResolveAttachmentIndex(attachmentId);
+			return std::any_of(pass.GetOutputs().begin(), pass.GetOutputs().end(), [&](const FramePass::Output& output)
+			{
+				return ResolveAttachmentIndex(output.attachmentId) == attachmentId;
+			});
+		};
+
+		auto IsWrittenBy = [&](const FramePass& pass, std::size_t attachmentId)
+		{
+			if (IsColorOutput(pass, attachmentId))
+				return true;
+
+			std::size_t dsOutput = pass.GetDepthStencilOutput();
+			return dsOutput != FramePass::InvalidAttachmentId && ResolveAttachmentIndex(dsOutput) == ResolveAttachmentIndex(attachmentId);
+		};
+
 		auto ShouldMerge = [&](const FramePass& prevPass, const FramePass& nextPass)
 		{
-			//TODO
-			return false;
+			// Only passes from the same queue can be merged
+			if (prevPass.GetQueueType() != nextPass.GetQueueType() || prevPass.GetQueueType() == QueueType::Compute)
+				return false;
+
+			if (!isSubpassMergingSupported)
+				return false;
+
+			// Subpasses share the depth-stencil attachment of their render pass
+			if (GetDepthStencilTextureId(prevPass) != GetDepthStencilTextureId(nextPass))
+				return false;
+
+			// Subpasses share the framebuffer of their render pass, their attachments must have the same size
+			const FrameGraphTextureData* referenceTexture = nullptr;
+			bool isSizeMatching = true;
+			auto CheckSize = [&](std::size_t attachmentId)
+			{
+				const FrameGraphTextureData& textureData = m_pending.textures[GetTextureId(attachmentId)];
+				if (!referenceTexture)
+					referenceTexture = &textureData;
+				else if (textureData.size != referenceTexture->size || textureData.width != referenceTexture->width || textureData.height != referenceTexture->height)
+					isSizeMatching = false;
+			};
+
+			for (const FramePass* pass : { &prevPass, &nextPass })
+			{
+				for (const auto& output : pass->GetOutputs())
+					CheckSize(output.attachmentId);
+
+				if (std::size_t dsOutput = pass->GetDepthStencilOutput(); dsOutput != FramePass::InvalidAttachmentId)
+					CheckSize(dsOutput);
+				else if (std::size_t dsInput = pass->GetDepthStencilInput(); dsInput != FramePass::InvalidAttachmentId)
+					CheckSize(dsInput);
+			}
+
+			if (!isSizeMatching)
+				return false;
+
+			// Attachments written by the previous pass can only be read through input attachments (at the current fragment location)
+			for (const auto& input : nextPass.GetInputs())
+			{
+				if (IsWrittenBy(prevPass, input.attachmentId) && (!input.isInputAttachment || !IsColorOutput(prevPass, input.attachmentId)))
+					return false;
+			}
+
+			// Sampled attachments can't be written in the same render pass
+			for (const auto& input : prevPass.GetInputs())
+			{
+				if (!input.isInputAttachment && IsWrittenBy(nextPass, input.attachmentId))
+					return false;
+			}
+
+			// Attachments with non-overlapping lifetimes may share the same texture, which can't happen inside a render pass
+			for (const auto& output : nextPass.GetOutputs())
+			{
+				std::size_t attachmentId = ResolveAttachmentIndex(output.attachmentId);
+				std::size_t textureId = GetTextureId(output.attachmentId);
+
+				bool isAliased = false;
+				prevPass.ForEachAttachment([&](std::size_t prevAttachmentId)
+				{
+					if (GetTextureId(prevAttachmentId) == textureId && ResolveAttachmentIndex(prevAttachmentId) != attachmentId)
+						isAliased = true;
+				});
+
+				if (isAliased)
+					return false;
+			}
+
+			return true;
 		};
 
 		for (std::size_t passIndex = 0; passIndex < m_pending.passList.size();)
@@ -150,6 +408,7 @@ namespace Nz
 
 			std::size_t physPassIndex = m_pending.physicalPasses.size();
 			PhysicalPassData& currentPass = m_pending.physicalPasses.emplace_back();
+			currentPass.queueType = m_framePasses[m_pending.passList[passIndex]].GetQueueType();
 
 			auto it = m_pending.passList.begin() + passIndex;
 			auto end = m_pending.passList.begin() + mergeEnd;
@@ -193,15 +452,16 @@ namespace Nz
 				std::size_t textureId = RegisterTexture(input.attachmentId);
 
 				FrameGraphTextureData& attachmentData = m_pending.textures[textureId];
-				attachmentData.usage |= TextureUsage::ShaderSampling;
+				attachmentData.usage |= (input.isInputAttachment) ? TextureUsage::InputAttachment : TextureUsage::ShaderSampling;
 			}
 
 			for (const auto& output : framePass.GetOutputs())
 			{
 				std::size_t textureId = RegisterTexture(output.attachmentId);
 
+				// Compute passes write their outputs as storage textures
 				FrameGraphTextureData& attachmentData = m_pending.textures[textureId];
-				attachmentData.usage |= TextureUsage::ColorAttachment;
+				attachmentData.usage |= (framePass.GetQueueType() == QueueType::Compute) ? TextureUsage::ShaderReadWrite : TextureUsage::ColorAttachment;
 			}
 
 			if (std::size_t depthStencilInput = framePass.GetDepthStencilInput(); depthStencilInput != FramePass::InvalidAttachmentId)
@@ -248,7 +508,8 @@ namespace Nz
 				auto it = m_pending.attachmentLastUse.find(attachmentId);
 
 				// If this pass is the last one where this attachment is used, push the texture to the reuse pool
-				if (it != m_pending.attachmentLastUse.end() && passIndex == it->second)
+				// (except for backbuffer outputs which are read after the frame graph execution)
+				if (it != m_pending.attachmentLastUse.end() && passIndex == it->second && !IsBackbufferOutput(attachmentId))
 				{
 					const auto& attachmentData = m_attachments[attachmentId];
 					if (std::holds_alternative<FramePassAttachment>(attachmentData))
@@ -262,7 +523,7 @@ namespace Nz
 					{
 						std::size_t textureId = Retrieve(m_pending.attachmentToTextures, attachmentId);
 
-						assert(std::find(m_pending.textureCubePool.begin(), m_pending.textureCubePool.end(), textureId) == m_pending.textureCubePool.end());
+						assert(std::find(m_pending.texture2DArrayPool.begin(), m_pending.texture2DArrayPool.end(), textureId) == m_pending.texture2DArrayPool.end());
 						m_pending.texture2DArrayPool.push_back(textureId);
 					}
 					else if (std::holds_alternative<AttachmentCube>(attachmentData))
@@ -276,14 +537,14 @@ namespace Nz
 			});
 		}
 
-		// Add TextureUsage::ShaderSampling to backbuffer output
+		// Add TextureUsage::ShaderSampling and TextureUsage::TransferSource to backbuffer output (they can be blit or copied)
 		for (std::size_t output : m_backbufferOutputs)
 		{
 			auto it = m_pending.attachmentToTextures.find(output);
 			assert(it != m_pending.attachmentToTextures.end());
 
 			auto& backbufferTexture = m_pending.textures[it->second];
-			backbufferTexture.usage |= TextureUsage::ShaderSampling;
+			backbufferTexture.usage |= TextureUsage::ShaderSampling | TextureUsage::TransferSource;
 		}
 
 		// Apply texture view usage to their parents
@@ -295,6 +556,13 @@ namespace Nz
 				parentTextureData.usage |= textureData.usage;
 			}
 		}
+		// Transient attachments can only be used as render pass attachments
+		constexpr TextureUsageFlags transientCompatibleUsages = TextureUsage::ColorAttachment | TextureUsage::DepthStencilAttachment | TextureUsage::InputAttachment;
+		for (auto& textureData : m_pending.textures)
+		{
+			if (textureData.transient && !textureData.viewData && !(textureData.usage & ~transientCompatibleUsages))
+				textureData.usage |= TextureUsage::TransientAttachment;
+		}
 	}
 
 	void FrameGraph::BuildBarriers()
@@ -329,6 +597,43 @@ namespace Nz
 			auto GetInvalidationBarrier = [&](std::size_t attachmentId) -> Barrier& { return GetBarrier(barriers.invalidationBarriers, attachmentId); };
 			auto GetFlushBarrier = [&](std::size_t attachmentId) -> Barrier& { return GetBarrier(barriers.flushBarriers, attachmentId); };
 
+			if (framePass.GetQueueType() == QueueType::Compute)
+			{
+				// Compute passes sample their inputs and write their outputs as storage textures
+				if (framePass.GetDepthStencilInput() != FramePass::InvalidAttachmentId || framePass.GetDepthStencilOutput() != FramePass::InvalidAttachmentId)
+					throw std::runtime_error("compute pass " + framePass.GetName() + " cannot have a depth-stencil attachment");
+
+				for (const auto& input : framePass.GetInputs())
+				{
+					auto& barrier = GetInvalidationBarrier(input.attachmentId);
+					if (barrier.layout != TextureLayout::Undefined)
+						throw std::runtime_error("layout mismatch");
+
+					// Read-write storage textures stay in the general layout
+					bool isOutput = std::any_of(framePass.GetOutputs().begin(), framePass.GetOutputs().end(), [&](const FramePass::Output& output)
+					{
+						return ResolveAttachmentIndex(output.attachmentId) == ResolveAttachmentIndex(input.attachmentId);
+					});
+
+					barrier.access |= MemoryAccess::ShaderRead;
+					barrier.stages |= PipelineStage::ComputeShader;
+					barrier.layout = (isOutput) ? TextureLayout::General : TextureLayout::ColorInput;
+				}
+
+				for (const auto& output : framePass.GetOutputs())
+				{
+					auto& barrier = GetFlushBarrier(output.attachmentId);
+					if (barrier.layout != TextureLayout::Undefined)
+						throw std::runtime_error("layout mismatch");
+
+					barrier.access |= MemoryAccess::ShaderWrite;
+					barrier.stages |= PipelineStage::ComputeShader;
+					barrier.layout = TextureLayout::General;
+				}
+
+				continue;
+			}
+
 			for (const auto& input : framePass.GetInputs())
 			{
 				auto& barrier = GetInvalidationBarrier(input.attachmentId);
@@ -397,6 +702,8 @@ namespace Nz
 
 	void FrameGraph::BuildPhysicalBarriers()
 	{
+		constexpr std::size_t InvalidPassIndex = std::numeric_limits<std::size_t>::max();
+
 		struct PassTextureStates
 		{
 			MemoryAccessFlags invalidatedAccesses;
@@ -405,21 +712,27 @@ namespace Nz
 			PipelineStageFlags flushedStages;
 			TextureLayout initialLayout = TextureLayout::Undefined;
 			TextureLayout finalLayout = TextureLayout::Undefined;
+			bool discardContent = false;
 		};
 
 		struct TextureStates
 		{
 			MemoryAccessFlags flushedAccesses;
 			PipelineStageFlags flushedStages;
+			PipelineStageFlags usedStages;
+			QueueType queueType = QueueType::Graphics;
 			TextureLayout currentLayout = TextureLayout::Undefined;
+			std::size_t lastPhysicalPassIndex = InvalidPassIndex;
 		};
 
 		std::vector<TextureStates> textureStates(m_pending.textures.size());
 		std::vector<PassTextureStates> passTextureStates;
 
 		auto barriersIt = m_pending.barrierList.begin();
-		for (auto& physicalPass : m_pending.physicalPasses)
+		for (std::size_t physicalPassIndex = 0; physicalPassIndex < m_pending.physicalPasses.size(); ++physicalPassIndex)
 		{
+			auto& physicalPass = m_pending.physicalPasses[physicalPassIndex];
+
 			passTextureStates.clear();
 			passTextureStates.resize(m_pending.textures.size());
 
@@ -458,8 +771,11 @@ namespace Nz
 						states.initialLayout = flush.layout;
 						states.invalidatedAccesses = flush.access;
 						states.invalidatedStages = flush.stages;
+						states.discardContent = true;
 
-						textureStates[flush.textureId].currentLayout = flush.layout;
+						// Render passes handle the initial layout transition, compute passes need an explicit barrier
+						if (physicalPass.queueType != QueueType::Compute)
+							textureStates[flush.textureId].currentLayout = flush.layout;
 
 						if (states.invalidatedStages & PipelineStage::FragmentTestsLate)
 							states.invalidatedStages |= PipelineStage::FragmentTestsEarly;
@@ -488,24 +804,74 @@ namespace Nz
 
 				assert(state.finalLayout != TextureLayout::Undefined);
 
-				if (textureStates[textureId].flushedAccesses != 0)
+				auto& textureState = textureStates[textureId];
+				if (textureState.lastPhysicalPassIndex != InvalidPassIndex && textureState.queueType != physicalPass.queueType)
+				{
+					// Texture was last used on another queue, this pass has to wait for it (using a semaphore)
+					physicalPass.waitedQueues |= textureState.queueType;
+
+					if (!state.discardContent)
+					{
+						// Transfer texture ownership, released by the last pass using it on the other queue and acquired by this one
+						TextureBarrier transferBarrier;
+						transferBarrier.textureId = textureId;
+						transferBarrier.srcAccessMask = textureState.flushedAccesses;
+						transferBarrier.srcStageMask = textureState.usedStages;
+						transferBarrier.dstAccessMask = state.invalidatedAccesses;
+						transferBarrier.dstStageMask = state.invalidatedStages;
+						transferBarrier.srcQueue = textureState.queueType;
+						transferBarrier.dstQueue = physicalPass.queueType;
+						transferBarrier.oldLayout = textureState.currentLayout;
+						transferBarrier.newLayout = state.initialLayout;
+
+						m_pending.physicalPasses[textureState.lastPhysicalPassIndex].releaseBarriers.push_back(transferBarrier);
+						physicalPass.textureBarrier.push_back(transferBarrier);
+					}
+					else if (physicalPass.queueType == QueueType::Compute)
+					{
+						// Content is discarded, no ownership transfer is required (only a layout transition)
+						auto& invalidationBarrier = physicalPass.textureBarrier.emplace_back();
+						invalidationBarrier.textureId = textureId;
+						invalidationBarrier.srcAccessMask = 0;
+						invalidationBarrier.srcStageMask = state.invalidatedStages;
+						invalidationBarrier.dstAccessMask = state.invalidatedAccesses;
+						invalidationBarrier.dstStageMask = state.invalidatedStages;
+						invalidationBarrier.oldLayout = TextureLayout::Undefined;
+						invalidationBarrier.newLayout = state.initialLayout;
+						invalidationBarrier.srcQueue = physicalPass.queueType;
+						invalidationBarrier.dstQueue = physicalPass.queueType;
+					}
+
+					textureState.flushedAccesses = 0;
+					textureState.flushedStages = 0;
+				}
+				else if (textureState.flushedAccesses != 0 || (physicalPass.queueType == QueueType::Compute && textureState.currentLayout != state.initialLayout))
 				{
+					PipelineStageFlags srcStages = (textureState.flushedAccesses != 0) ? textureState.flushedStages : textureState.usedStages;
+					if (!srcStages)
+						srcStages = PipelineStage::TopOfPipe;
+
 					auto& invalidationBarrier = physicalPass.textureBarrier.emplace_back();
 					invalidationBarrier.textureId = textureId;
-					invalidationBarrier.srcAccessMask = textureStates[textureId].flushedAccesses;
-					invalidationBarrier.srcStageMask = textureStates[textureId].flushedStages;
+					invalidationBarrier.srcAccessMask = textureState.flushedAccesses;
+					invalidationBarrier.srcStageMask = srcStages;
 					invalidationBarrier.dstAccessMask = state.invalidatedAccesses;
 					invalidationBarrier.dstStageMask = state.invalidatedStages;
-					invalidationBarrier.oldLayout = textureStates[textureId].currentLayout;
+					invalidationBarrier.oldLayout = (physicalPass.queueType == QueueType::Compute && state.discardContent) ? TextureLayout::Undefined : textureState.currentLayout;
 					invalidationBarrier.newLayout = state.initialLayout;
+					invalidationBarrier.srcQueue = physicalPass.queueType;
+					invalidationBarrier.dstQueue = physicalPass.queueType;
 
-					textureStates[textureId].flushedAccesses = 0;
-					textureStates[textureId].flushedStages = 0;
+					textureState.flushedAccesses = 0;
+					textureState.flushedStages = 0;
 				}
 
-				textureStates[textureId].currentLayout = state.finalLayout;
-				textureStates[textureId].flushedAccesses |= state.flushedAccesses;
-				textureStates[textureId].flushedStages |= state.flushedStages;
+				textureState.currentLayout = state.finalLayout;
+				textureState.flushedAccesses |= state.flushedAccesses;
+				textureState.flushedStages |= state.flushedStages;
+				textureState.usedStages = state.invalidatedStages | state.flushedStages;
+				textureState.queueType = physicalPass.queueType;
+				textureState.lastPhysicalPassIndex = physicalPassIndex;
 			}
 		}
 	}
@@ -533,6 +899,7 @@ namespace Nz
 			bool hasColorWrite = false;
 			bool hasDepthStencilRead = false;
 			bool hasDepthStencilWrite = false;
+			bool hasInputAttachmentRead = false;
 			bool externalColorSynchronization = false;
 			bool externalDepthSynchronization = false;
 		};
@@ -565,15 +932,38 @@ namespace Nz
 				return nullptr;
 			};
 
+			auto FindInput = [&](std::size_t subpassIndex) -> RenderPass::AttachmentReference*
+			{
+				auto& subpassDesc = subpasses[subpassIndex];
+				for (auto& inputReference : subpassDesc.inputAttachments)
+				{
+					if (inputReference.attachmentIndex == attachmentIndex)
+						return &inputReference;
+				}
+
+				return nullptr;
+			};
+
 			for (std::size_t subpassIndex = 0; subpassIndex < subpasses.size(); ++subpassIndex)
 			{
 				RenderPass::SubpassDescription& subpassDesc = subpasses[subpassIndex];
 
 				RenderPass::AttachmentReference* colorAttachment = FindColor(subpassIndex);
 				RenderPass::AttachmentReference* depthStencilAttachment = FindDepthStencil(subpassIndex);
+				RenderPass::AttachmentReference* inputAttachment = FindInput(subpassIndex);
+
+				if (inputAttachment)
+				{
+					// Input attachments are always written by a previous subpass, the pass to pass dependency handles them
+					subpassInfo[subpassIndex].hasInputAttachmentRead = true;
+					currentLayout = inputAttachment->attachmentLayout;
+				}
 
 				if (!colorAttachment && !depthStencilAttachment)
 				{
+					if (inputAttachment)
+						continue;
+
 					if (used)
 						subpassDesc.preserveAttachments.push_back(attachmentIndex);
 
@@ -694,7 +1084,11 @@ namespace Nz
 				subpassDependency.toAccessFlags |= MemoryAccess::DepthStencilRead | MemoryAccess::DepthStencilWrite;
 			}
 
-			// TODO: Handle InputAttachment
+			if (sync.hasInputAttachmentRead)
+			{
+				subpassDependency.toStages |= PipelineStage::FragmentShader;
+				subpassDependency.toAccessFlags |= MemoryAccess::InputAttachmentRead;
+			}
 		}
 	}
 
@@ -741,7 +1135,7 @@ namespace Nz
 			auto& attachment = renderPassAttachments.emplace_back();
 			attachment.format = m_pending.textures[textureId].format;
 			attachment.initialLayout = initialLayout;
-			attachment.storeOp = AttachmentStoreOp::Store;
+			attachment.storeOp = AttachmentStoreOp::Discard; //< see IsStoreRequired
 			attachment.stencilLoadOp = AttachmentLoadOp::Discard;
 			attachment.stencilStoreOp = AttachmentStoreOp::Discard;
 
@@ -758,18 +1152,21 @@ namespace Nz
 
 		auto RegisterDepthStencil = [&](std::size_t attachmentId, TextureLayout textureLayout, bool* first) -> RenderPass::Attachment&
 		{
+			std::size_t textureId = Retrieve(m_pending.attachmentToTextures, attachmentId);
+
 			if (depthStencilAttachmentIndex)
 			{
-				assert(depthStencilAttachmentId == attachmentId);
+				// Merged subpasses may use different attachments sharing the same depth-stencil texture
+				assert(Retrieve(m_pending.attachmentToTextures, depthStencilAttachmentId) == textureId);
 				*first = false;
 
+				textureLayouts[textureId] = textureLayout;
+
 				return renderPassAttachments[depthStencilAttachmentIndex.value()];
 			}
 
 			*first = true;
 
-			std::size_t textureId = Retrieve(m_pending.attachmentToTextures, attachmentId);
-
 			TextureLayout initialLayout = textureLayouts[textureId];
 			textureLayouts[textureId] = textureLayout;
 
@@ -781,32 +1178,106 @@ namespace Nz
 			auto& depthStencilAttachment = renderPassAttachments.emplace_back();
 			depthStencilAttachment.format = m_pending.textures[textureId].format;
 			depthStencilAttachment.initialLayout = initialLayout;
+			depthStencilAttachment.storeOp = AttachmentStoreOp::Discard; //< see IsStoreRequired
 
 			return depthStencilAttachment;
 		};
 
+		// Check if a future pass reads from an attachment or if we can discard it after this pass
+		auto IsReadAfterPass = [&](std::size_t attachmentId, std::size_t physicalPassIndex)
+		{
+			attachmentId = ResolveAttachmentIndex(attachmentId);
+
+			// Attachments may be read through proxies
+			for (const auto& [readAttachmentId, readPasses] : m_pending.attachmentReadList)
+			{
+				if (ResolveAttachmentIndex(readAttachmentId) != attachmentId)
+					continue;
+
+				for (std::size_t passIndex : readPasses)
+				{
+					auto it = m_pending.passIdToPhysicalPassIndex.find(passIndex);
+					if (it == m_pending.passIdToPhysicalPassIndex.end())
+						continue; //< pass may have been discarded
+
+					std::size_t readPhysicalPassIndex = it->second;
+					if (readPhysicalPassIndex > physicalPassIndex) //< Read in a future pass?
+						return true;
+				}
+			}
+
+			return false;
+		};
+
+		// Attachment content only has to leave tile memory if something reads it after the render pass
+		auto IsStoreRequired = [&](std::size_t attachmentId, std::size_t physicalPassIndex)
+		{
+			if (IsBackbufferOutput(attachmentId))
+				return true;
+
+			// Layers are part of a bigger texture which may be read by other means
+			if (!std::holds_alternative<FramePassAttachment>(m_attachments[ResolveAttachmentIndex(attachmentId)]))
+				return true;
+
+			return IsReadAfterPass(attachmentId, physicalPassIndex);
+		};
+
 		std::size_t physicalPassIndex = 0;
 		for (auto& physicalPass : m_pending.physicalPasses)
 		{
+			if (physicalPass.queueType == QueueType::Compute)
+			{
+				// Compute passes don't use a render pass, only keep track of their texture layouts
+				for (auto& subpass : physicalPass.passes)
+				{
+					const FramePass& framePass = m_framePasses[subpass.passIndex];
+					for (const auto& input : framePass.GetInputs())
+					{
+						if (input.doesRead)
+							RegisterColorInputRead(input);
+					}
+
+					for (const auto& output : framePass.GetOutputs())
+						textureLayouts[Retrieve(m_pending.attachmentToTextures, output.attachmentId)] = TextureLayout::General;
+				}
+
+				m_pending.renderPasses.push_back(nullptr);
+
+				physicalPassIndex++;
+				continue;
+			}
+
 			depthStencilAttachmentIndex = std::nullopt;
 			usedTextureAttachments.clear();
 			renderPassAttachments.clear();
 			subpassesDesc.clear();
 			subpassesDeps.clear();
 
-			std::size_t subpassIndex = 0;
-
-			std::vector<RenderPass::AttachmentReference> colorAttachments;
 			for (auto& subpass : physicalPass.passes)
 			{
 				const FramePass& framePass = m_framePasses[subpass.passIndex];
 				const auto& subpassInputs = framePass.GetInputs();
 				const auto& subpassOutputs = framePass.GetOutputs();
 
-				colorAttachments.reserve(subpassOutputs.size());
+				auto& subpassDesc = subpassesDesc.emplace_back();
+				subpassDesc.colorAttachment.reserve(subpassOutputs.size());
 
 				for (const auto& input : subpassInputs)
 				{
+					if (input.isInputAttachment)
+					{
+						// Input attachments are read from an attachment written by a previous subpass
+						std::size_t textureId = Retrieve(m_pending.attachmentToTextures, input.attachmentId);
+						auto it = usedTextureAttachments.find(textureId);
+						if (it == usedTextureAttachments.end())
+							throw std::runtime_error("pass " + framePass.GetName() + " reads an input attachment which is not written by a previous subpass (passes couldn't be merged)");
+
+						subpassDesc.inputAttachments.push_back({
+							it->second,
+							TextureLayout::ColorInput
+						});
+					}
+
 					if (input.doesRead)
 						RegisterColorInputRead(input);
 				}
@@ -821,7 +1292,11 @@ namespace Nz
 
 					std::size_t attachmentIndex = RegisterColorOutput(output, shouldLoad);
 
-					colorAttachments.push_back({
+					// Content which isn't used after this pass can stay in tile memory
+					if (IsStoreRequired(output.attachmentId, physicalPassIndex))
+						renderPassAttachments[attachmentIndex].storeOp = AttachmentStoreOp::Store;
+
+					subpassDesc.colorAttachment.push_back({
 						attachmentIndex,
 						TextureLayout::ColorOutput
 					});
@@ -830,13 +1305,13 @@ namespace Nz
 
 			std::size_t colorAttachmentCount = renderPassAttachments.size();
 
-			std::optional<RenderPass::AttachmentReference> depthStencilAttachment;
-			for (auto& subpass : physicalPass.passes)
+			for (std::size_t subpassIndex = 0; subpassIndex < physicalPass.passes.size(); ++subpassIndex)
 			{
-				const FramePass& framePass = m_framePasses[subpass.passIndex];
+				const FramePass& framePass = m_framePasses[physicalPass.passes[subpassIndex].passIndex];
 				std::size_t dsInputAttachment = framePass.GetDepthStencilInput();
 				std::size_t dsOutputAttachement = framePass.GetDepthStencilOutput();
 
+				std::optional<RenderPass::AttachmentReference>& depthStencilAttachment = subpassesDesc[subpassIndex].depthStencilAttachment;
 				if (dsInputAttachment != FramePass::InvalidAttachmentId && dsOutputAttachement != FramePass::InvalidAttachmentId)
 				{
 					// DS input/output
@@ -844,10 +1319,10 @@ namespace Nz
 					auto& dsAttachment = RegisterDepthStencil(dsInputAttachment, TextureLayout::DepthStencilReadWrite, &first);
 
 					if (first)
-					{
 						dsAttachment.loadOp = AttachmentLoadOp::Load;
+
+					if (IsStoreRequired(dsOutputAttachement, physicalPassIndex))
 						dsAttachment.storeOp = AttachmentStoreOp::Store;
-					}
 
 					depthStencilAttachment = RenderPass::AttachmentReference{
 						depthStencilAttachmentIndex.value(),
@@ -861,30 +1336,10 @@ namespace Nz
 					auto& dsAttachment = RegisterDepthStencil(dsInputAttachment, TextureLayout::DepthStencilReadOnly, &first);
 
 					if (first)
-					{
-						bool canDiscard = true;
-
-						// Check if a future pass reads from the DS buffer or if we can discard it after this pass
-						if (auto readIt = m_pending.attachmentReadList.find(dsInputAttachment); readIt != m_pending.attachmentReadList.end())
-						{
-							for (std::size_t passIndex : readIt->second)
-							{
-								auto it = m_pending.passIdToPhysicalPassIndex.find(passIndex);
-								if (it == m_pending.passIdToPhysicalPassIndex.end())
-									continue; //< pass may have been discarded
-
-								std::size_t readPhysicalPassIndex = it->second;
-								if (readPhysicalPassIndex > physicalPassIndex) //< Read in a future pass?
-								{
-									// Yes, store it
-									canDiscard = false;
-									break;
-								}
-							}
-						}
+						dsAttachment.loadOp = AttachmentLoadOp::Load;
 
-						dsAttachment.storeOp = (canDiscard) ? AttachmentStoreOp::Discard : AttachmentStoreOp::Store;
-					}
+					if (IsStoreRequired(dsInputAttachment, physicalPassIndex))
+						dsAttachment.storeOp = AttachmentStoreOp::Store;
 
 					depthStencilAttachment = RenderPass::AttachmentReference{
 						depthStencilAttachmentIndex.value(),
@@ -901,23 +1356,16 @@ namespace Nz
 					{
 						dsAttachment.initialLayout = TextureLayout::Undefined; //< Don't care about initial layout
 						dsAttachment.loadOp = (framePass.GetDepthStencilClear()) ? AttachmentLoadOp::Clear : AttachmentLoadOp::Discard;
-						dsAttachment.storeOp = AttachmentStoreOp::Store;
 					}
 
+					if (IsStoreRequired(dsOutputAttachement, physicalPassIndex))
+						dsAttachment.storeOp = AttachmentStoreOp::Store;
+
 					depthStencilAttachment = RenderPass::AttachmentReference{
 						depthStencilAttachmentIndex.value(),
 						TextureLayout::DepthStencilReadWrite
 					};
 				}
-
-				subpassesDesc.push_back({
-					std::move(colorAttachments),
-					{},
-					{},
-					std::move(depthStencilAttachment)
-				});
-
-				subpassIndex++;
 			}
 
 			// Assign final layout (TODO: Use this to perform layouts useful for future passes?)
@@ -968,6 +1416,19 @@ namespace Nz
 		return false;
 	}
 
+	bool FrameGraph::IsBackbufferOutput(std::size_t attachmentIndex) const
+	{
+		attachmentIndex = ResolveAttachmentIndex(attachmentIndex);
+
+		for (std::size_t output : m_backbufferOutputs)
+		{
+			if (ResolveAttachmentIndex(output) == attachmentIndex)
+				return true;
+		}
+
+		return false;
+	}
+
 	void FrameGraph::RegisterPassInput(std::size_t passIndex, std::size_t attachmentIndex)
 	{
 		auto it = m_pending.attachmentWriteList.find(attachmentIndex);
@@ -1014,6 +1475,8 @@ namespace Nz
 					if (!attachmentData.name.empty() && data.name != attachmentData.name)
 						data.name += " / " + attachmentData.name;
 
+					data.transient &= attachmentData.transient;
+
 					return textureId;
 				}
 
@@ -1028,6 +1491,7 @@ namespace Nz
 				data.height = attachmentData.height;
 				data.size = attachmentData.size;
 				data.layerCount = 1;
+				data.transient = attachmentData.transient;
 
 				return textureId;
 			}
@@ -1050,12 +1514,14 @@ namespace Nz
 						data.layerCount != attachmentData.layerCount)
 						continue;
 
-					m_pending.textureCubePool.erase(it);
+					m_pending.texture2DArrayPool.erase(it);
 					m_pending.attachmentToTextures.emplace(attachmentIndex, textureId);
 
 					if (!attachmentData.name.empty() && data.name != attachmentData.name)
 						data.name += " / " + attachmentData.name;
 
+					data.transient &= attachmentData.transient;
+
 					return textureId;
 				}
 
@@ -1070,6 +1536,7 @@ namespace Nz
 				data.height = attachmentData.height;
 				data.size = attachmentData.size;
 				data.layerCount = attachmentData.layerCount;
+				data.transient = attachmentData.transient;
 
 				return textureId;
 			}
@@ -1097,6 +1564,8 @@ namespace Nz
 					if (!attachmentData.name.empty() && data.name != attachmentData.name)
 						data.name += " / " + attachmentData.name;
 
+					data.transient &= attachmentData.transient;
+
 					return textureId;
 				}
 
@@ -1111,6 +1580,7 @@ namespace Nz
 				data.height = attachmentData.height;
 				data.size = attachmentData.size;
 				data.layerCount = 1;
+				data.transient = attachmentData.transient;
 
 				return textureId;
 			}
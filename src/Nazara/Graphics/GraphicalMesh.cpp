@@ -4,18 +4,130 @@
 
 #include <Nazara/Graphics/GraphicalMesh.hpp>
 #include <Nazara/Graphics/Graphics.hpp>
+#include <Nazara/Graphics/PredefinedShaderStructs.hpp>
 #include <Nazara/Utility/SoftwareBuffer.hpp>
 #include <Nazara/Utility/StaticMesh.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <NazaraUtils/SparsePtr.hpp>
+#include <algorithm>
 #include <cassert>
+#include <vector>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
 {
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		std::shared_ptr<RenderBuffer> BuildSkinningBuffer(RenderDevice& renderDevice, const VertexBuffer& vertexBuffer, const UInt8* vertexData)
+		{
+			const VertexDeclaration& vertexDeclaration = *vertexBuffer.GetVertexDeclaration();
+
+			// Compressed declarations aren't supported, they will be skinned by the vertex shader
+			const auto* positionComponent = vertexDeclaration.GetComponentByType<Vector3f>(VertexComponent::Position);
+			const auto* jointIndicesComponent = vertexDeclaration.GetComponentByType<Vector4i32>(VertexComponent::JointIndices);
+			const auto* jointWeightsComponent = vertexDeclaration.GetComponentByType<Vector4f>(VertexComponent::JointWeights);
+			if (!positionComponent || !jointIndicesComponent || !jointWeightsComponent)
+				return nullptr;
+
+			const auto* normalComponent = vertexDeclaration.GetComponentByType<Vector3f>(VertexComponent::Normal);
+			const auto* tangentComponent = vertexDeclaration.GetComponentByType<Vector3f>(VertexComponent::Tangent);
+			const auto* uvComponent = vertexDeclaration.GetComponentByType<Vector2f>(VertexComponent::TexCoord);
+
+			std::size_t stride = vertexDeclaration.GetStride();
+			auto ComponentPtr = [&](const VertexDeclaration::Component* component, auto dummy)
+			{
+				using T = decltype(dummy);
+				return (component) ? SparsePtr<const T>(vertexData + component->offset, stride) : SparsePtr<const T>();
+			};
+
+			SparsePtr<const Vector3f> positionPtr = ComponentPtr(positionComponent, Vector3f{});
+			SparsePtr<const Vector3f> normalPtr = ComponentPtr(normalComponent, Vector3f{});
+			SparsePtr<const Vector3f> tangentPtr = ComponentPtr(tangentComponent, Vector3f{});
+			SparsePtr<const Vector2f> uvPtr = ComponentPtr(uvComponent, Vector2f{});
+			SparsePtr<const Vector4i32> jointIndicesPtr = ComponentPtr(jointIndicesComponent, Vector4i32{});
+			SparsePtr<const Vector4f> jointWeightsPtr = ComponentPtr(jointWeightsComponent, Vector4f{});
+
+			PredefinedSkinningData skinningData = PredefinedSkinningData::GetOffsets();
+
+			UInt32 vertexCount = SafeCast<UInt32>(vertexBuffer.GetVertexCount());
+
+			std::vector<UInt8> skinningBufferData(skinningData.verticesOffset + vertexCount * skinningData.vertexSize);
+			AccessByOffset<UInt32&>(skinningBufferData.data(), skinningData.vertexCountOffset) = vertexCount;
+
+			for (UInt32 i = 0; i < vertexCount; ++i)
+			{
+				UInt8* vertexPtr = &skinningBufferData[skinningData.verticesOffset + i * skinningData.vertexSize];
+
+				AccessByOffset<Vector3f&>(vertexPtr, skinningData.vertexMemberOffsets.position) = positionPtr[i];
+				AccessByOffset<Vector3f&>(vertexPtr, skinningData.vertexMemberOffsets.normal) = (normalPtr) ? normalPtr[i] : Vector3f::Zero();
+				AccessByOffset<Vector3f&>(vertexPtr, skinningData.vertexMemberOffsets.tangent) = (tangentPtr) ? tangentPtr[i] : Vector3f::Zero();
+				AccessByOffset<Vector2f&>(vertexPtr, skinningData.vertexMemberOffsets.uv) = (uvPtr) ? uvPtr[i] : Vector2f::Zero();
+				AccessByOffset<Vector4f&>(vertexPtr, skinningData.vertexMemberOffsets.jointWeights) = jointWeightsPtr[i];
+				AccessByOffset<Vector4i32&>(vertexPtr, skinningData.vertexMemberOffsets.jointIndices) = jointIndicesPtr[i];
+			}
+
+			std::shared_ptr<RenderBuffer> skinningBuffer = renderDevice.InstantiateBuffer(BufferType::Storage, skinningBufferData.size(), BufferUsage::DeviceLocal | BufferUsage::Write);
+			if (!skinningBuffer->Fill(skinningBufferData.data(), 0, skinningBufferData.size()))
+				throw std::runtime_error("failed to fill skinning buffer");
+
+			return skinningBuffer;
+		}
+	}
+
+	GraphicalMesh::~GraphicalMesh()
+	{
+		ReleaseArenaAllocations();
+	}
+
+	/*!
+	* \brief Builds a graphical mesh from a static mesh, using the mesh arena of the graphics module if it's enabled
+	*
+	* \param mesh Static mesh (with software buffers) to upload
+	*
+	* \see Graphics::GetMeshArena
+	*/
 	std::shared_ptr<GraphicalMesh> GraphicalMesh::BuildFromMesh(const Mesh& mesh)
 	{
-		const std::shared_ptr<RenderDevice>& renderDevice = Graphics::Instance()->GetRenderDevice();
+		return BuildFromMesh(mesh, Graphics::Instance()->GetMeshArena());
+	}
+
+	/*!
+	* \brief Builds a graphical mesh from a static mesh
+	*
+	* \param mesh Static mesh (with software buffers) to upload
+	* \param arena Arena to allocate vertices and indices from (submeshes are then drawn using offsets), or a null pointer to give every submesh its own buffers
+	*/
+	std::shared_ptr<GraphicalMesh> GraphicalMesh::BuildFromMesh(const Mesh& mesh, std::shared_ptr<MeshArena> arena)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		Graphics* graphics = Graphics::Instance();
+		const std::shared_ptr<RenderDevice>& renderDevice = graphics->GetRenderDevice();
 
 		std::shared_ptr<GraphicalMesh> gfxMesh = std::make_shared<GraphicalMesh>();
+		gfxMesh->m_arena = arena;
+
+		auto UploadBuffer = [&](BufferType bufferType, const std::shared_ptr<const VertexDeclaration>& vertexDeclaration, const UInt8* data, UInt64 size, UInt64& offset) -> std::shared_ptr<RenderBuffer>
+		{
+			if (arena)
+			{
+				MeshArena::Allocation allocation = (bufferType == BufferType::Index) ? arena->AllocateIndices(size) : arena->AllocateVertices(vertexDeclaration, size);
+				gfxMesh->m_arenaAllocations.push_back(allocation); //< released with the mesh, even if filling fails
+
+				if (!allocation.buffer->Fill(data, allocation.offset, size))
+					throw std::runtime_error((bufferType == BufferType::Index) ? "failed to fill index buffer" : "failed to fill vertex buffer");
+
+				offset = allocation.offset;
+				return std::move(allocation.buffer);
+			}
+
+			std::shared_ptr<RenderBuffer> renderBuffer = renderDevice->InstantiateBuffer(bufferType, size, BufferUsage::DeviceLocal | BufferUsage::Write);
+			if (!renderBuffer->Fill(data, 0, size))
+				throw std::runtime_error((bufferType == BufferType::Index) ? "failed to fill index buffer" : "failed to fill vertex buffer");
+
+			offset = 0;
+			return renderBuffer;
+		};
 
 		for (std::size_t i = 0; i < mesh.GetSubMeshCount(); ++i)
 		{
@@ -29,27 +141,48 @@ namespace Nz
 
 			GraphicalMesh::SubMesh submeshData;
 
-			const std::shared_ptr<const IndexBuffer>& indexBuffer = staticMesh.GetIndexBuffer();
-			if (indexBuffer)
+			auto UploadIndexBuffer = [&](const IndexBuffer& indexBuffer, UInt32& firstIndex)
 			{
-				assert(indexBuffer->GetBuffer()->GetStorage() == DataStorage::Software);
-				const SoftwareBuffer* indexBufferContent = static_cast<const SoftwareBuffer*>(indexBuffer->GetBuffer().get());
+				assert(indexBuffer.GetBuffer()->GetStorage() == DataStorage::Software);
+				const SoftwareBuffer* indexBufferContent = static_cast<const SoftwareBuffer*>(indexBuffer.GetBuffer().get());
+
+				UInt64 offset;
+				std::shared_ptr<RenderBuffer> renderBuffer = UploadBuffer(BufferType::Index, nullptr, indexBufferContent->GetData() + indexBuffer.GetStartOffset(), indexBuffer.GetEndOffset() - indexBuffer.GetStartOffset(), offset);
 
-				submeshData.indexBuffer = renderDevice->InstantiateBuffer(BufferType::Index, indexBuffer->GetStride() * indexBuffer->GetIndexCount(), BufferUsage::DeviceLocal | BufferUsage::Write);
-				if (!submeshData.indexBuffer->Fill(indexBufferContent->GetData() + indexBuffer->GetStartOffset(), 0, indexBuffer->GetEndOffset() - indexBuffer->GetStartOffset()))
-					throw std::runtime_error("failed to fill index buffer");
+				// Arena index allocations are aligned on four bytes, and thus on the index size
+				firstIndex = SafeCast<UInt32>(offset / indexBuffer.GetStride());
 
+				return renderBuffer;
+			};
+
+			const std::shared_ptr<const IndexBuffer>& indexBuffer = staticMesh.GetIndexBuffer();
+			if (indexBuffer)
+			{
+				submeshData.indexBuffer = UploadIndexBuffer(*indexBuffer, submeshData.firstIndex);
 				submeshData.indexCount = indexBuffer->GetIndexCount();
 				submeshData.indexType = indexBuffer->GetIndexType();
+
+				for (std::size_t lodIndex = 1; lodIndex < subMesh.GetLODCount(); ++lodIndex)
+				{
+					const std::shared_ptr<IndexBuffer>& lodIndexBuffer = subMesh.GetLODIndexBuffer(lodIndex);
+					if (lodIndexBuffer->GetIndexType() != submeshData.indexType)
+						throw std::runtime_error("levels of detail must use the submesh index type");
+
+					auto& levelOfDetail = submeshData.levelsOfDetail.emplace_back();
+					levelOfDetail.indexBuffer = UploadIndexBuffer(*lodIndexBuffer, levelOfDetail.firstIndex);
+					levelOfDetail.indexCount = lodIndexBuffer->GetIndexCount();
+					levelOfDetail.error = subMesh.GetLODError(lodIndex);
+				}
 			}
 			else
 				submeshData.indexCount = vertexBuffer->GetVertexCount();
 
-			submeshData.vertexBuffer = renderDevice->InstantiateBuffer(BufferType::Vertex, vertexBuffer->GetStride() * vertexBuffer->GetVertexCount(), BufferUsage::DeviceLocal | BufferUsage::Write);
-			if (!submeshData.vertexBuffer->Fill(vertexBufferContent->GetData() + vertexBuffer->GetStartOffset(), 0, vertexBuffer->GetEndOffset() - vertexBuffer->GetStartOffset()))
-				throw std::runtime_error("failed to fill vertex buffer");
-
 			submeshData.vertexDeclaration = vertexBuffer->GetVertexDeclaration();
+			submeshData.vertexBuffer = UploadBuffer(BufferType::Vertex, submeshData.vertexDeclaration, vertexBufferContent->GetData() + vertexBuffer->GetStartOffset(), vertexBuffer->GetEndOffset() - vertexBuffer->GetStartOffset(), submeshData.vertexOffset);
+			submeshData.vertexCount = SafeCast<UInt32>(vertexBuffer->GetVertexCount());
+
+			if (graphics->IsComputeSkinningEnabled() && submeshData.vertexDeclaration->HasComponent(VertexComponent::JointIndices))
+				submeshData.skinningBuffer = BuildSkinningBuffer(*renderDevice, *vertexBuffer, vertexBufferContent->GetData() + vertexBuffer->GetStartOffset());
 
 			gfxMesh->AddSubMesh(std::move(submeshData));
 		}
@@ -58,4 +191,38 @@ namespace Nz
 
 		return gfxMesh;
 	}
+
+	void GraphicalMesh::ReleaseArenaAllocations()
+	{
+		if (!m_arena)
+			return;
+
+		for (const MeshArena::Allocation& allocation : m_arenaAllocations)
+			m_arena->Free(allocation);
+
+		m_arenaAllocations.clear();
+	}
+
+	void GraphicalMesh::UpdateLODErrors()
+	{
+		// A level of detail is only available if every submesh has it, its error is the highest of the submeshes
+		m_lodErrors.clear();
+		for (std::size_t i = 0; i < m_subMeshes.size(); ++i)
+		{
+			const auto& levelsOfDetail = m_subMeshes[i].levelsOfDetail;
+			if (i == 0)
+			{
+				for (const LevelOfDetail& levelOfDetail : levelsOfDetail)
+					m_lodErrors.push_back(levelOfDetail.error);
+			}
+			else
+			{
+				if (levelsOfDetail.size() < m_lodErrors.size())
+					m_lodErrors.resize(levelsOfDetail.size());
+
+				for (std::size_t j = 0; j < m_lodErrors.size(); ++j)
+					m_lodErrors[j] = std::max(m_lodErrors[j], levelsOfDetail[j].error);
+			}
+		}
+	}
 }
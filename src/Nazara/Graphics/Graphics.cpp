@@ -5,6 +5,7 @@
 #include <Nazara/Graphics/Graphics.hpp>
 #include <Nazara/Core/AppFilesystemComponent.hpp>
 #include <Nazara/Core/CommandLineParameters.hpp>
+#include <Nazara/Graphics/DeferredLightingPipelinePass.hpp>
 #include <Nazara/Graphics/GuillotineTextureAtlas.hpp>
 #include <Nazara/Graphics/MaterialInstance.hpp>
 #include <Nazara/Graphics/MaterialPipeline.hpp>
@@ -12,6 +13,7 @@
 #include <Nazara/Graphics/PredefinedShaderStructs.hpp>
 #include <Nazara/Graphics/Formats/TextureLoader.hpp>
 #include <Nazara/Utility/Font.hpp>
+#include <Nazara/Utility/VertexDeclaration.hpp>
 #include <NZSL/Ast/AstSerializer.hpp>
 #include <NZSL/Ast/Module.hpp>
 #include <array>
@@ -26,14 +28,66 @@ namespace Nz
 			#include <Nazara/Graphics/Resources/Shaders/TextureBlit.nzslb.h>
 		};
 
+		const UInt8 r_computeSkinningShader[] = {
+			#include <Nazara/Graphics/Resources/Shaders/ComputeSkinning.nzslb.h>
+		};
+
 		const UInt8 r_basicMaterialShader[] = {
 			#include <Nazara/Graphics/Resources/Shaders/BasicMaterial.nzslb.h>
 		};
 
+		const UInt8 r_deferredLightingShader[] = {
+			#include <Nazara/Graphics/Resources/Shaders/DeferredLighting.nzslb.h>
+		};
+
 		const UInt8 r_fullscreenVertexShader[] = {
 			#include <Nazara/Graphics/Resources/Shaders/FullscreenVertex.nzslb.h>
 		};
 
+		const UInt8 r_hiZDepthCopyShader[] = {
+			#include <Nazara/Graphics/Resources/Shaders/HiZDepthCopy.nzslb.h>
+		};
+
+		const UInt8 r_hiZDownsampleShader[] = {
+			#include <Nazara/Graphics/Resources/Shaders/HiZDownsample.nzslb.h>
+		};
+
+		const UInt8 r_hiZOcclusionTestShader[] = {
+			#include <Nazara/Graphics/Resources/Shaders/HiZOcclusionTest.nzslb.h>
+		};
+
+		const UInt8 r_impostorBakeShader[] = {
+			#include <Nazara/Graphics/Resources/Shaders/ImpostorBake.nzslb.h>
+		};
+
+		const UInt8 r_impostorRenderShader[] = {
+			#include <Nazara/Graphics/Resources/Shaders/ImpostorRender.nzslb.h>
+		};
+
+		const UInt8 r_instanceCullingShader[] = {
+			#include <Nazara/Graphics/Resources/Shaders/InstanceCulling.nzslb.h>
+		};
+
+		const UInt8 r_lightClusteringShader[] = {
+			#include <Nazara/Graphics/Resources/Shaders/LightClustering.nzslb.h>
+		};
+
+		const UInt8 r_particleRenderShader[] = {
+			#include <Nazara/Graphics/Resources/Shaders/ParticleRender.nzslb.h>
+		};
+
+		const UInt8 r_particleSimulationShader[] = {
+			#include <Nazara/Graphics/Resources/Shaders/ParticleSimulation.nzslb.h>
+		};
+
+		const UInt8 r_particleSortShader[] = {
+			#include <Nazara/Graphics/Resources/Shaders/ParticleSort.nzslb.h>
+		};
+
+		const UInt8 r_particleSortKeysShader[] = {
+			#include <Nazara/Graphics/Resources/Shaders/ParticleSortKeys.nzslb.h>
+		};
+
 		const UInt8 r_phongMaterialShader[] = {
 			#include <Nazara/Graphics/Resources/Shaders/PhongMaterial.nzslb.h>
 		};
@@ -42,6 +96,18 @@ namespace Nz
 			#include <Nazara/Graphics/Resources/Shaders/PhysicallyBasedMaterial.nzslb.h>
 		};
 
+		const UInt8 r_spatialUpscaleShader[] = {
+			#include <Nazara/Graphics/Resources/Shaders/SpatialUpscale.nzslb.h>
+		};
+
+		const UInt8 r_temporalUpscaleShader[] = {
+			#include <Nazara/Graphics/Resources/Shaders/TemporalUpscale.nzslb.h>
+		};
+
+		const UInt8 r_terrainRenderShader[] = {
+			#include <Nazara/Graphics/Resources/Shaders/TerrainRender.nzslb.h>
+		};
+
 		// Modules
 		const UInt8 r_instanceDataModule[] = {
 			#include <Nazara/Graphics/Resources/Shaders/Modules/Engine/InstanceData.nzslb.h>
@@ -51,6 +117,10 @@ namespace Nz
 			#include <Nazara/Graphics/Resources/Shaders/Modules/Engine/LightData.nzslb.h>
 		};
 
+		const UInt8 r_particleDataModule[] = {
+			#include <Nazara/Graphics/Resources/Shaders/Modules/Engine/ParticleData.nzslb.h>
+		};
+
 		const UInt8 r_skeletalDataModule[] = {
 			#include <Nazara/Graphics/Resources/Shaders/Modules/Engine/SkeletalData.nzslb.h>
 		};
@@ -74,6 +144,10 @@ namespace Nz
 		const UInt8 r_mathCookTorrancePBRModule[] = {
 			#include <Nazara/Graphics/Resources/Shaders/Modules/Math/CookTorrancePBR.nzslb.h>
 		};
+
+		const UInt8 r_mathOctahedralModule[] = {
+			#include <Nazara/Graphics/Resources/Shaders/Modules/Math/Octahedral.nzslb.h>
+		};
 	}
 
 	/*!
@@ -88,6 +162,10 @@ namespace Nz
 	{
 		Renderer* renderer = Renderer::Instance();
 
+		// Graphics builds its shaders from NZSL modules, which the WebGPU renderer can't instantiate yet (it only accepts WGSL sources)
+		if (renderer->QueryAPI() == RenderAPI::WebGPU)
+			throw std::runtime_error("WebGPU renderer can only be used through the Renderer module, select another render API to use the Graphics module");
+
 		const std::vector<RenderDeviceInfo>& renderDeviceInfo = renderer->QueryRenderDevices();
 		if (renderDeviceInfo.empty())
 			throw std::runtime_error("no render device available");
@@ -110,8 +188,12 @@ namespace Nz
 
 		RenderDeviceFeatures enabledFeatures;
 		enabledFeatures.anisotropicFiltering = !config.forceDisableFeatures.anisotropicFiltering && renderDeviceInfo[bestRenderDeviceIndex].features.anisotropicFiltering;
+		enabledFeatures.bindlessTextures = !config.forceDisableFeatures.bindlessTextures && renderDeviceInfo[bestRenderDeviceIndex].features.bindlessTextures;
 		enabledFeatures.computeShaders = !config.forceDisableFeatures.computeShaders && renderDeviceInfo[bestRenderDeviceIndex].features.computeShaders;
 		enabledFeatures.depthClamping = !config.forceDisableFeatures.depthClamping && renderDeviceInfo[bestRenderDeviceIndex].features.depthClamping;
+		enabledFeatures.drawIndirectCount = !config.forceDisableFeatures.drawIndirectCount && renderDeviceInfo[bestRenderDeviceIndex].features.drawIndirectCount;
+		enabledFeatures.multiDrawIndirect = !config.forceDisableFeatures.multiDrawIndirect && renderDeviceInfo[bestRenderDeviceIndex].features.multiDrawIndirect;
+		enabledFeatures.multipleSubpasses = !config.forceDisableFeatures.multipleSubpasses && renderDeviceInfo[bestRenderDeviceIndex].features.multipleSubpasses;
 		enabledFeatures.nonSolidFaceFilling = !config.forceDisableFeatures.nonSolidFaceFilling && renderDeviceInfo[bestRenderDeviceIndex].features.nonSolidFaceFilling;
 		enabledFeatures.storageBuffers = !config.forceDisableFeatures.storageBuffers && renderDeviceInfo[bestRenderDeviceIndex].features.storageBuffers;
 		enabledFeatures.textureReadWithoutFormat = !config.forceDisableFeatures.textureReadWithoutFormat && renderDeviceInfo[bestRenderDeviceIndex].features.textureReadWithoutFormat;
@@ -123,19 +205,106 @@ namespace Nz
 		if (!m_renderDevice)
 			throw std::runtime_error("failed to instantiate render device");
 
+		m_instanceDataBufferPool.emplace(m_renderDevice, BufferType::Uniform, PredefinedInstanceData::GetOffsets().totalSize);
+		if (config.useMeshArena)
+			m_meshArena = std::make_shared<MeshArena>(m_renderDevice);
+
 		m_renderPassCache.emplace(*m_renderDevice);
 		m_samplerCache.emplace(m_renderDevice);
+		PreallocateSamplers(config.preallocatedSamplers);
+
+		if (!config.shaderVariantArchivePath.empty())
+		{
+			m_shaderVariantArchivePath = std::move(config.shaderVariantArchivePath);
+			if (std::filesystem::is_regular_file(m_shaderVariantArchivePath))
+				m_shaderVariantArchive.LoadFromFile(m_shaderVariantArchivePath);
+
+			m_shaderVariantArchive.EnableRecording(config.recordShaderVariants);
+		}
 
 		BuildDefaultTextures();
 		RegisterShaderModules();
 		BuildBlitPipeline();
+
+		// Forward lighting relies on lights binned in clusters by a compute shader
+		if (enabledFeatures.computeShaders && enabledFeatures.storageBuffers)
+			BuildLightClusteringPipeline();
+		else
+			NazaraWarning("clustered lighting requires compute shaders and storage buffers, forward shading will be unlit");
+
+		if (config.useBindlessTextures)
+		{
+			if (enabledFeatures.bindlessTextures && enabledFeatures.storageBuffers)
+				m_bindlessTextureTable = std::make_shared<BindlessTextureTable>(m_renderDevice);
+			else
+				NazaraWarning("bindless texturing requires bindless textures and storage buffers, materials will bind their textures");
+		}
+
+		if (config.useComputeSkinning)
+		{
+			if (enabledFeatures.computeShaders && enabledFeatures.storageBuffers)
+				BuildSkinningPipeline();
+			else
+				NazaraWarning("compute skinning requires compute shaders and storage buffers, falling back to vertex shader skinning");
+		}
+
+		if (config.useGpuDrivenRendering)
+		{
+			if (enabledFeatures.computeShaders && enabledFeatures.storageBuffers)
+				BuildInstanceCullingPipeline();
+			else
+				NazaraWarning("GPU-driven rendering requires compute shaders and storage buffers, instanced submeshes will be drawn directly");
+		}
+
+		if (config.useOcclusionCulling)
+		{
+			if (enabledFeatures.computeShaders && enabledFeatures.storageBuffers && enabledFeatures.textureReadWrite)
+				BuildOcclusionCullingPipelines();
+			else
+				NazaraWarning("occlusion culling requires compute shaders, storage buffers and texture read-write, it will be disabled");
+		}
+
+		if (config.useParticleSystem)
+		{
+			if (enabledFeatures.computeShaders && enabledFeatures.storageBuffers)
+				BuildParticlePipelines();
+			else
+				NazaraWarning("particle system requires compute shaders and storage buffers, particle emitters will not be rendered");
+		}
+
+		if (config.useDeferredShading)
+		{
+			if (enabledFeatures.storageBuffers)
+				BuildDeferredLightingPipeline();
+			else
+				NazaraWarning("deferred shading requires storage buffers, deferred frame pipelines will fall back to forward shading");
+		}
+
+		if (config.useDynamicResolution)
+			BuildUpscalePipelines();
+
+		if (config.useImpostors)
+			BuildImpostorPipelines();
+
+		if (config.useTerrain)
+		{
+			if (enabledFeatures.textureReadWrite)
+				BuildTerrainPipeline();
+			else
+				NazaraWarning("terrain requires texture read-write, clipmap terrains will not be rendered");
+		}
+
 		RegisterMaterialPasses();
 		SelectDepthStencilFormats();
 
 		MaterialPipeline::Initialize();
-		BuildDefaultMaterials();
 
-		Font::SetDefaultAtlas(std::make_shared<GuillotineTextureAtlas>(*m_renderDevice));
+		// Default materials (and their uber-shaders) are built on first use, shortening the time to first frame of applications which don't rely on them
+		if (config.preloadDefaultMaterials)
+			GetDefaultMaterials();
+
+		// Glyphs have similar heights and are inserted one by one, which the skyline packer handles quickly and with a good fill rate
+		Font::SetDefaultAtlas(std::make_shared<GuillotineTextureAtlas>(*m_renderDevice, BinPackAlgorithm::Skyline));
 
 		m_materialInstanceLoader.RegisterLoader(Loaders::GetMaterialInstanceLoader_Texture()); // texture to material loader
 	}
@@ -168,10 +337,51 @@ namespace Nz
 		defaultAtlas.reset();
 
 		MaterialPipeline::Uninitialize();
+
+		if (m_shaderVariantArchive.IsRecording())
+			m_shaderVariantArchive.SaveToFile(m_shaderVariantArchivePath);
+
+		m_bindlessTextureTable.reset();
+		m_instanceDataBufferPool.reset();
+		m_meshArena.reset();
 		m_renderPassCache.reset();
 		m_samplerCache.reset();
 		m_blitPipeline.reset();
 		m_blitPipelineLayout.reset();
+		m_deferredLightingPipeline.reset();
+		m_deferredLightingPipelineLayout.reset();
+		m_instanceCullingPipeline.reset();
+		m_instanceCullingPipelineLayout.reset();
+		m_lightClusteringPipeline.reset();
+		m_lightClusteringPipelineLayout.reset();
+		m_skinningPipeline.reset();
+		m_skinningPipelineLayout.reset();
+		m_skinnedVertexDeclaration.reset();
+		m_hiZDepthCopyPipeline.reset();
+		m_hiZDepthCopyPipelineLayout.reset();
+		m_hiZDownsamplePipeline.reset();
+		m_hiZDownsamplePipelineLayout.reset();
+		m_impostorBakePipelineLayout.reset();
+		m_impostorRenderPipeline.reset();
+		m_impostorRenderPipelineLayout.reset();
+		m_occlusionTestPipeline.reset();
+		m_occlusionTestPipelineLayout.reset();
+		m_particleSimulationPipeline.reset();
+		m_particleSimulationCollisionPipeline.reset();
+		m_particleSimulationPipelineLayout.reset();
+		m_particleSortKeysPipeline.reset();
+		m_particleSortKeysPipelineLayout.reset();
+		m_particleSortPipeline.reset();
+		m_particleSortPipelineLayout.reset();
+		m_particleRenderPipelineLayout.reset();
+		m_terrainRenderPipeline.reset();
+		m_terrainRenderPipelineLayout.reset();
+		for (auto& pipeline : m_particleRenderPipelines)
+			pipeline.reset();
+		for (auto& pipeline : m_upscalePipelines)
+			pipeline.reset();
+		for (auto& pipelineLayout : m_upscalePipelineLayouts)
+			pipelineLayout.reset();
 		m_defaultMaterials = DefaultMaterials{};
 		m_defaultTextures = DefaultTextures{};
 	}
@@ -227,11 +437,12 @@ namespace Nz
 		m_blitPipelineTransparent = m_renderDevice->InstantiateRenderPipeline(std::move(pipelineInfo));
 	}
 
-	void Graphics::BuildDefaultMaterials()
+	void Graphics::BuildDefaultMaterials() const
 	{
 		std::size_t depthPassIndex = m_materialPassRegistry.GetPassIndex("DepthPass");
 		std::size_t shadowPassIndex = m_materialPassRegistry.GetPassIndex("ShadowPass");
 		std::size_t forwardPassIndex = m_materialPassRegistry.GetPassIndex("ForwardPass");
+		std::size_t gbufferPassIndex = m_materialPassRegistry.GetPassIndex("GBufferPass");
 
 		// BasicMaterial
 		{
@@ -298,6 +509,11 @@ namespace Nz
 			shadowPass.states.depthBiasSlopeFactor = 0.05f;
 			settings.AddPass(shadowPassIndex, shadowPass);
 
+			// Opaque Phong materials are shaded by the deferred lighting pass with DeferredFramePipeline
+			MaterialPass gbufferPass = forwardPass;
+			gbufferPass.options[CRC32("GBufferPass")] = true;
+			settings.AddPass(gbufferPassIndex, gbufferPass);
+
 			m_defaultMaterials.materials[MaterialType::Phong].material = std::make_shared<Material>(std::move(settings), "PhongMaterial");
 		}
 
@@ -308,6 +524,8 @@ namespace Nz
 			materialData.presets[MaterialInstancePreset::NoDepth] = materialData.material->Instantiate();
 			materialData.presets[MaterialInstancePreset::NoDepth]->DisablePass(depthPassIndex);
 			materialData.presets[MaterialInstancePreset::NoDepth]->DisablePass(shadowPassIndex);
+			if (materialData.presets[MaterialInstancePreset::NoDepth]->HasPass(gbufferPassIndex))
+				materialData.presets[MaterialInstancePreset::NoDepth]->DisablePass(gbufferPassIndex);
 			materialData.presets[MaterialInstancePreset::NoDepth]->UpdatePassStates(forwardPassIndex, [](RenderStates& states)
 			{
 				states.depthBuffer = false;
@@ -316,6 +534,8 @@ namespace Nz
 			materialData.presets[MaterialInstancePreset::Transparent] = materialData.material->Instantiate();
 			materialData.presets[MaterialInstancePreset::Transparent]->DisablePass(depthPassIndex);
 			materialData.presets[MaterialInstancePreset::Transparent]->DisablePass(shadowPassIndex);
+			if (materialData.presets[MaterialInstancePreset::Transparent]->HasPass(gbufferPassIndex))
+				materialData.presets[MaterialInstancePreset::Transparent]->DisablePass(gbufferPassIndex);
 			materialData.presets[MaterialInstancePreset::Transparent]->UpdatePassFlags(forwardPassIndex, MaterialPassFlag::SortByDistance);
 			materialData.presets[MaterialInstancePreset::Transparent]->UpdatePassStates(forwardPassIndex, [](RenderStates& renderStates)
 			{
@@ -385,27 +605,832 @@ namespace Nz
 		}
 	}
 
+	void Graphics::BuildDeferredLightingPipeline()
+	{
+		UInt32 gbufferCount = SafeCast<UInt32>(DeferredLightingPipelinePass::GBufferCount);
+		UInt32 maxShadowedLightCount = SafeCast<UInt32>(DeferredLightingPipelinePass::MaxShadowedLightCount);
+
+		RenderPipelineLayoutInfo layoutInfo;
+		layoutInfo.bindings.assign({
+			{
+				0, 0, 1,
+				ShaderBindingType::UniformBuffer,
+				nzsl::ShaderStageType::Fragment
+			},
+			{
+				0, 1, 1,
+				ShaderBindingType::UniformBuffer,
+				nzsl::ShaderStageType::Fragment
+			},
+			{
+				0, 2, 1,
+				ShaderBindingType::StorageBuffer,
+				nzsl::ShaderStageType::Fragment
+			},
+			{
+				0, 3, 1,
+				ShaderBindingType::StorageBuffer,
+				nzsl::ShaderStageType::Fragment
+			}
+		});
+
+		// G-buffer textures and depth buffer
+		for (UInt32 i = 0; i < gbufferCount + 1; ++i)
+		{
+			layoutInfo.bindings.push_back({
+				0, 4 + i, 1,
+				ShaderBindingType::Sampler,
+				nzsl::ShaderStageType::Fragment
+			});
+		}
+
+		// Shadow maps of the shadowed lights (2D, cube and directional)
+		UInt32 shadowMapBindingIndex = 4 + gbufferCount + 1;
+		for (UInt32 i = 0; i < 3; ++i)
+		{
+			layoutInfo.bindings.push_back({
+				0, shadowMapBindingIndex + i, maxShadowedLightCount,
+				ShaderBindingType::Sampler,
+				nzsl::ShaderStageType::Fragment
+			});
+		}
+
+		m_deferredLightingPipelineLayout = m_renderDevice->InstantiateRenderPipelineLayout(std::move(layoutInfo));
+		if (!m_deferredLightingPipelineLayout)
+			throw std::runtime_error("failed to instantiate deferred lighting pipeline layout");
+
+		nzsl::Ast::ModulePtr lightingShaderModule = m_shaderModuleResolver->Resolve("DeferredLighting");
+
+		nzsl::ShaderWriter::States states;
+		states.shaderModuleResolver = m_shaderModuleResolver;
+
+		auto lightingShader = m_renderDevice->InstantiateShaderModule(nzsl::ShaderStageType::Fragment | nzsl::ShaderStageType::Vertex, *lightingShaderModule, states);
+		if (!lightingShader)
+			throw std::runtime_error("failed to instantiate deferred lighting shader");
+
+		RenderPipelineInfo pipelineInfo;
+		pipelineInfo.pipelineLayout = m_deferredLightingPipelineLayout;
+		pipelineInfo.shaderModules.push_back(std::move(lightingShader));
+
+		m_deferredLightingPipeline = m_renderDevice->InstantiateRenderPipeline(std::move(pipelineInfo));
+		if (!m_deferredLightingPipeline)
+			throw std::runtime_error("failed to instantiate deferred lighting pipeline");
+	}
+
+	void Graphics::BuildImpostorPipelines()
+	{
+		// Baking (pipelines depend on the vertex declaration of baked models and are built by ImpostorAtlas::Bake)
+		{
+			RenderPipelineLayoutInfo layoutInfo;
+			layoutInfo.bindings.assign({
+				{
+					0, 0, 1,
+					ShaderBindingType::UniformBuffer,
+					nzsl::ShaderStageType::Fragment | nzsl::ShaderStageType::Vertex
+				},
+				{
+					0, 1, 1,
+					ShaderBindingType::Sampler,
+					nzsl::ShaderStageType::Fragment
+				}
+			});
+
+			m_impostorBakePipelineLayout = m_renderDevice->InstantiateRenderPipelineLayout(std::move(layoutInfo));
+			if (!m_impostorBakePipelineLayout)
+				throw std::runtime_error("failed to instantiate impostor bake pipeline layout");
+		}
+
+		// Rendering
+		{
+			RenderPipelineLayoutInfo layoutInfo;
+			layoutInfo.bindings.assign({
+				{
+					0, 0, 1,
+					ShaderBindingType::UniformBuffer,
+					nzsl::ShaderStageType::Fragment | nzsl::ShaderStageType::Vertex
+				},
+				{
+					0, 1, 1,
+					ShaderBindingType::UniformBuffer,
+					nzsl::ShaderStageType::Vertex
+				},
+				{
+					0, 2, 1,
+					ShaderBindingType::UniformBuffer,
+					nzsl::ShaderStageType::Vertex
+				},
+				{
+					0, 3, 1,
+					ShaderBindingType::Sampler,
+					nzsl::ShaderStageType::Fragment
+				}
+			});
+
+			m_impostorRenderPipelineLayout = m_renderDevice->InstantiateRenderPipelineLayout(std::move(layoutInfo));
+			if (!m_impostorRenderPipelineLayout)
+				throw std::runtime_error("failed to instantiate impostor render pipeline layout");
+
+			nzsl::Ast::ModulePtr renderShaderModule = m_shaderModuleResolver->Resolve("ImpostorRender");
+
+			nzsl::ShaderWriter::States states;
+			states.shaderModuleResolver = m_shaderModuleResolver;
+
+			auto renderShader = m_renderDevice->InstantiateShaderModule(nzsl::ShaderStageType::Fragment | nzsl::ShaderStageType::Vertex, *renderShaderModule, states);
+			if (!renderShader)
+				throw std::runtime_error("failed to instantiate impostor render shader");
+
+			RenderPipelineInfo pipelineInfo;
+			pipelineInfo.pipelineLayout = m_impostorRenderPipelineLayout;
+			pipelineInfo.shaderModules.push_back(std::move(renderShader));
+			pipelineInfo.depthBuffer = true;
+			pipelineInfo.faceCulling = FaceCulling::None;
+
+			m_impostorRenderPipeline = m_renderDevice->InstantiateRenderPipeline(std::move(pipelineInfo));
+			if (!m_impostorRenderPipeline)
+				throw std::runtime_error("failed to instantiate impostor render pipeline");
+		}
+	}
+
+	void Graphics::BuildInstanceCullingPipeline()
+	{
+		RenderPipelineLayoutInfo layoutInfo;
+		layoutInfo.bindings.assign({
+			{
+				0, 0, 1,
+				ShaderBindingType::UniformBuffer,
+				nzsl::ShaderStageType::Compute
+			},
+			{
+				0, 1, 1,
+				ShaderBindingType::UniformBuffer,
+				nzsl::ShaderStageType::Compute
+			},
+			{
+				0, 2, 1,
+				ShaderBindingType::StorageBuffer,
+				nzsl::ShaderStageType::Compute
+			},
+			{
+				0, 3, 1,
+				ShaderBindingType::StorageBuffer,
+				nzsl::ShaderStageType::Compute
+			},
+			{
+				0, 4, 1,
+				ShaderBindingType::StorageBuffer,
+				nzsl::ShaderStageType::Compute
+			},
+			{
+				0, 5, 1,
+				ShaderBindingType::StorageBuffer,
+				nzsl::ShaderStageType::Compute
+			}
+		});
+
+		m_instanceCullingPipelineLayout = m_renderDevice->InstantiateRenderPipelineLayout(std::move(layoutInfo));
+		if (!m_instanceCullingPipelineLayout)
+			throw std::runtime_error("failed to instantiate instance culling pipeline layout");
+
+		nzsl::Ast::ModulePtr cullingShaderModule = m_shaderModuleResolver->Resolve("InstanceCulling");
+
+		nzsl::ShaderWriter::States states;
+		states.shaderModuleResolver = m_shaderModuleResolver;
+
+		auto cullingShader = m_renderDevice->InstantiateShaderModule(nzsl::ShaderStageType::Compute, *cullingShaderModule, states);
+		if (!cullingShader)
+			throw std::runtime_error("failed to instantiate instance culling shader");
+
+		ComputePipelineInfo pipelineInfo;
+		pipelineInfo.pipelineLayout = m_instanceCullingPipelineLayout;
+		pipelineInfo.shaderModule = std::move(cullingShader);
+
+		m_instanceCullingPipeline = m_renderDevice->InstantiateComputePipeline(std::move(pipelineInfo));
+		if (!m_instanceCullingPipeline)
+			throw std::runtime_error("failed to instantiate instance culling pipeline");
+	}
+
+	void Graphics::BuildLightClusteringPipeline()
+	{
+		RenderPipelineLayoutInfo layoutInfo;
+		layoutInfo.bindings.assign({
+			{
+				0, 0, 1,
+				ShaderBindingType::UniformBuffer,
+				nzsl::ShaderStageType::Compute
+			},
+			{
+				0, 1, 1,
+				ShaderBindingType::UniformBuffer,
+				nzsl::ShaderStageType::Compute
+			},
+			{
+				0, 2, 1,
+				ShaderBindingType::StorageBuffer,
+				nzsl::ShaderStageType::Compute
+			},
+			{
+				0, 3, 1,
+				ShaderBindingType::StorageBuffer,
+				nzsl::ShaderStageType::Compute
+			}
+		});
+
+		m_lightClusteringPipelineLayout = m_renderDevice->InstantiateRenderPipelineLayout(std::move(layoutInfo));
+		if (!m_lightClusteringPipelineLayout)
+			throw std::runtime_error("failed to instantiate light clustering pipeline layout");
+
+		nzsl::Ast::ModulePtr clusteringShaderModule = m_shaderModuleResolver->Resolve("LightClustering");
+
+		nzsl::ShaderWriter::States states;
+		states.shaderModuleResolver = m_shaderModuleResolver;
+
+		auto clusteringShader = m_renderDevice->InstantiateShaderModule(nzsl::ShaderStageType::Compute, *clusteringShaderModule, states);
+		if (!clusteringShader)
+			throw std::runtime_error("failed to instantiate light clustering shader");
+
+		ComputePipelineInfo pipelineInfo;
+		pipelineInfo.pipelineLayout = m_lightClusteringPipelineLayout;
+		pipelineInfo.shaderModule = std::move(clusteringShader);
+
+		m_lightClusteringPipeline = m_renderDevice->InstantiateComputePipeline(std::move(pipelineInfo));
+		if (!m_lightClusteringPipeline)
+			throw std::runtime_error("failed to instantiate light clustering pipeline");
+	}
+
+	void Graphics::BuildOcclusionCullingPipelines()
+	{
+		nzsl::ShaderWriter::States states;
+		states.shaderModuleResolver = m_shaderModuleResolver;
+
+		// Depth copy (depth attachments can't be copied to color textures nor be used as storage images)
+		{
+			RenderPipelineLayoutInfo layoutInfo;
+			layoutInfo.bindings.assign({
+				{
+					0, 0, 1,
+					ShaderBindingType::Sampler,
+					nzsl::ShaderStageType::Fragment
+				}
+			});
+
+			m_hiZDepthCopyPipelineLayout = m_renderDevice->InstantiateRenderPipelineLayout(std::move(layoutInfo));
+			if (!m_hiZDepthCopyPipelineLayout)
+				throw std::runtime_error("failed to instantiate depth copy pipeline layout");
+
+			nzsl::Ast::ModulePtr depthCopyShaderModule = m_shaderModuleResolver->Resolve("HiZDepthCopy");
+
+			auto depthCopyShader = m_renderDevice->InstantiateShaderModule(nzsl::ShaderStageType::Fragment | nzsl::ShaderStageType::Vertex, *depthCopyShaderModule, states);
+			if (!depthCopyShader)
+				throw std::runtime_error("failed to instantiate depth copy shader");
+
+			RenderPipelineInfo pipelineInfo;
+			pipelineInfo.pipelineLayout = m_hiZDepthCopyPipelineLayout;
+			pipelineInfo.shaderModules.push_back(std::move(depthCopyShader));
+
+			m_hiZDepthCopyPipeline = m_renderDevice->InstantiateRenderPipeline(std::move(pipelineInfo));
+			if (!m_hiZDepthCopyPipeline)
+				throw std::runtime_error("failed to instantiate depth copy pipeline");
+		}
+
+		// Depth pyramid downsampling
+		{
+			RenderPipelineLayoutInfo layoutInfo;
+			layoutInfo.bindings.assign({
+				{
+					0, 0, 1,
+					ShaderBindingType::UniformBuffer,
+					nzsl::ShaderStageType::Compute
+				},
+				{
+					0, 1, 1,
+					ShaderBindingType::Texture,
+					nzsl::ShaderStageType::Compute
+				},
+				{
+					0, 2, 1,
+					ShaderBindingType::Texture,
+					nzsl::ShaderStageType::Compute
+				}
+			});
+
+			m_hiZDownsamplePipelineLayout = m_renderDevice->InstantiateRenderPipelineLayout(std::move(layoutInfo));
+			if (!m_hiZDownsamplePipelineLayout)
+				throw std::runtime_error("failed to instantiate depth downsample pipeline layout");
+
+			nzsl::Ast::ModulePtr downsampleShaderModule = m_shaderModuleResolver->Resolve("HiZDownsample");
+
+			auto downsampleShader = m_renderDevice->InstantiateShaderModule(nzsl::ShaderStageType::Compute, *downsampleShaderModule, states);
+			if (!downsampleShader)
+				throw std::runtime_error("failed to instantiate depth downsample shader");
+
+			ComputePipelineInfo pipelineInfo;
+			pipelineInfo.pipelineLayout = m_hiZDownsamplePipelineLayout;
+			pipelineInfo.shaderModule = std::move(downsampleShader);
+
+			m_hiZDownsamplePipeline = m_renderDevice->InstantiateComputePipeline(std::move(pipelineInfo));
+			if (!m_hiZDownsamplePipeline)
+				throw std::runtime_error("failed to instantiate depth downsample pipeline");
+		}
+
+		// Bounding boxes test
+		{
+			RenderPipelineLayoutInfo layoutInfo;
+			layoutInfo.bindings.assign({
+				{
+					0, 0, 1,
+					ShaderBindingType::UniformBuffer,
+					nzsl::ShaderStageType::Compute
+				},
+				{
+					0, 1, 1,
+					ShaderBindingType::Texture,
+					nzsl::ShaderStageType::Compute
+				},
+				{
+					0, 2, 1,
+					ShaderBindingType::StorageBuffer,
+					nzsl::ShaderStageType::Compute
+				},
+				{
+					0, 3, 1,
+					ShaderBindingType::StorageBuffer,
+					nzsl::ShaderStageType::Compute
+				}
+			});
+
+			m_occlusionTestPipelineLayout = m_renderDevice->InstantiateRenderPipelineLayout(std::move(layoutInfo));
+			if (!m_occlusionTestPipelineLayout)
+				throw std::runtime_error("failed to instantiate occlusion test pipeline layout");
+
+			nzsl::Ast::ModulePtr occlusionTestShaderModule = m_shaderModuleResolver->Resolve("HiZOcclusionTest");
+
+			auto occlusionTestShader = m_renderDevice->InstantiateShaderModule(nzsl::ShaderStageType::Compute, *occlusionTestShaderModule, states);
+			if (!occlusionTestShader)
+				throw std::runtime_error("failed to instantiate occlusion test shader");
+
+			ComputePipelineInfo pipelineInfo;
+			pipelineInfo.pipelineLayout = m_occlusionTestPipelineLayout;
+			pipelineInfo.shaderModule = std::move(occlusionTestShader);
+
+			m_occlusionTestPipeline = m_renderDevice->InstantiateComputePipeline(std::move(pipelineInfo));
+			if (!m_occlusionTestPipeline)
+				throw std::runtime_error("failed to instantiate occlusion test pipeline");
+		}
+	}
+
+	void Graphics::BuildParticlePipelines()
+	{
+		// Simulation
+		{
+			RenderPipelineLayoutInfo layoutInfo;
+			layoutInfo.bindings.assign({
+				{
+					0, 0, 1,
+					ShaderBindingType::UniformBuffer,
+					nzsl::ShaderStageType::Compute
+				},
+				{
+					0, 1, 1,
+					ShaderBindingType::StorageBuffer,
+					nzsl::ShaderStageType::Compute
+				},
+				{
+					0, 2, 1,
+					ShaderBindingType::Texture,
+					nzsl::ShaderStageType::Compute
+				}
+			});
+
+			m_particleSimulationPipelineLayout = m_renderDevice->InstantiateRenderPipelineLayout(std::move(layoutInfo));
+			if (!m_particleSimulationPipelineLayout)
+				throw std::runtime_error("failed to instantiate particle simulation pipeline layout");
+
+			nzsl::Ast::ModulePtr simulationShaderModule = m_shaderModuleResolver->Resolve("ParticleSimulation");
+
+			for (bool depthCollision : { false, true })
+			{
+				nzsl::ShaderWriter::States states;
+				states.optionValues[CRC32("DepthCollision")] = depthCollision;
+				states.shaderModuleResolver = m_shaderModuleResolver;
+
+				auto simulationShader = m_renderDevice->InstantiateShaderModule(nzsl::ShaderStageType::Compute, *simulationShaderModule, states);
+				if (!simulationShader)
+					throw std::runtime_error("failed to instantiate particle simulation shader");
+
+				ComputePipelineInfo pipelineInfo;
+				pipelineInfo.pipelineLayout = m_particleSimulationPipelineLayout;
+				pipelineInfo.shaderModule = std::move(simulationShader);
+
+				std::shared_ptr<ComputePipeline>& pipeline = (depthCollision) ? m_particleSimulationCollisionPipeline : m_particleSimulationPipeline;
+				pipeline = m_renderDevice->InstantiateComputePipeline(std::move(pipelineInfo));
+				if (!pipeline)
+					throw std::runtime_error("failed to instantiate particle simulation pipeline");
+			}
+		}
+
+		nzsl::ShaderWriter::States states;
+		states.shaderModuleResolver = m_shaderModuleResolver;
+
+		// Sort keys (distance to the viewer)
+		{
+			RenderPipelineLayoutInfo layoutInfo;
+			layoutInfo.bindings.assign({
+				{
+					0, 0, 1,
+					ShaderBindingType::UniformBuffer,
+					nzsl::ShaderStageType::Compute
+				},
+				{
+					0, 1, 1,
+					ShaderBindingType::UniformBuffer,
+					nzsl::ShaderStageType::Compute
+				},
+				{
+					0, 2, 1,
+					ShaderBindingType::StorageBuffer,
+					nzsl::ShaderStageType::Compute
+				},
+				{
+					0, 3, 1,
+					ShaderBindingType::StorageBuffer,
+					nzsl::ShaderStageType::Compute
+				}
+			});
+
+			m_particleSortKeysPipelineLayout = m_renderDevice->InstantiateRenderPipelineLayout(std::move(layoutInfo));
+			if (!m_particleSortKeysPipelineLayout)
+				throw std::runtime_error("failed to instantiate particle sort keys pipeline layout");
+
+			nzsl::Ast::ModulePtr sortKeysShaderModule = m_shaderModuleResolver->Resolve("ParticleSortKeys");
+
+			auto sortKeysShader = m_renderDevice->InstantiateShaderModule(nzsl::ShaderStageType::Compute, *sortKeysShaderModule, states);
+			if (!sortKeysShader)
+				throw std::runtime_error("failed to instantiate particle sort keys shader");
+
+			ComputePipelineInfo pipelineInfo;
+			pipelineInfo.pipelineLayout = m_particleSortKeysPipelineLayout;
+			pipelineInfo.shaderModule = std::move(sortKeysShader);
+
+			m_particleSortKeysPipeline = m_renderDevice->InstantiateComputePipeline(std::move(pipelineInfo));
+			if (!m_particleSortKeysPipeline)
+				throw std::runtime_error("failed to instantiate particle sort keys pipeline");
+		}
+
+		// Bitonic sort step
+		{
+			RenderPipelineLayoutInfo layoutInfo;
+			layoutInfo.bindings.assign({
+				{
+					0, 0, 1,
+					ShaderBindingType::UniformBuffer,
+					nzsl::ShaderStageType::Compute
+				},
+				{
+					0, 1, 1,
+					ShaderBindingType::StorageBuffer,
+					nzsl::ShaderStageType::Compute
+				}
+			});
+
+			m_particleSortPipelineLayout = m_renderDevice->InstantiateRenderPipelineLayout(std::move(layoutInfo));
+			if (!m_particleSortPipelineLayout)
+				throw std::runtime_error("failed to instantiate particle sort pipeline layout");
+
+			nzsl::Ast::ModulePtr sortShaderModule = m_shaderModuleResolver->Resolve("ParticleSort");
+
+			auto sortShader = m_renderDevice->InstantiateShaderModule(nzsl::ShaderStageType::Compute, *sortShaderModule, states);
+			if (!sortShader)
+				throw std::runtime_error("failed to instantiate particle sort shader");
+
+			ComputePipelineInfo pipelineInfo;
+			pipelineInfo.pipelineLayout = m_particleSortPipelineLayout;
+			pipelineInfo.shaderModule = std::move(sortShader);
+
+			m_particleSortPipeline = m_renderDevice->InstantiateComputePipeline(std::move(pipelineInfo));
+			if (!m_particleSortPipeline)
+				throw std::runtime_error("failed to instantiate particle sort pipeline");
+		}
+
+		// Rendering
+		{
+			RenderPipelineLayoutInfo layoutInfo;
+			layoutInfo.bindings.assign({
+				{
+					0, 0, 1,
+					ShaderBindingType::UniformBuffer,
+					nzsl::ShaderStageType::Vertex
+				},
+				{
+					0, 1, 1,
+					ShaderBindingType::UniformBuffer,
+					nzsl::ShaderStageType::Vertex
+				},
+				{
+					0, 2, 1,
+					ShaderBindingType::StorageBuffer,
+					nzsl::ShaderStageType::Vertex
+				},
+				{
+					0, 3, 1,
+					ShaderBindingType::Sampler,
+					nzsl::ShaderStageType::Fragment
+				},
+				{
+					0, 4, 1,
+					ShaderBindingType::StorageBuffer,
+					nzsl::ShaderStageType::Vertex
+				}
+			});
+
+			m_particleRenderPipelineLayout = m_renderDevice->InstantiateRenderPipelineLayout(std::move(layoutInfo));
+			if (!m_particleRenderPipelineLayout)
+				throw std::runtime_error("failed to instantiate particle render pipeline layout");
+
+			nzsl::Ast::ModulePtr renderShaderModule = m_shaderModuleResolver->Resolve("ParticleRender");
+
+			for (auto&& [blendMode, pipeline] : m_particleRenderPipelines.iter_kv())
+			{
+				nzsl::ShaderWriter::States renderStates;
+				renderStates.optionValues[CRC32("SortedParticles")] = (blendMode == ParticleBlendMode::AlphaBlend);
+				renderStates.shaderModuleResolver = m_shaderModuleResolver;
+
+				auto renderShader = m_renderDevice->InstantiateShaderModule(nzsl::ShaderStageType::Fragment | nzsl::ShaderStageType::Vertex, *renderShaderModule, renderStates);
+				if (!renderShader)
+					throw std::runtime_error("failed to instantiate particle render shader");
+
+				RenderPipelineInfo pipelineInfo;
+				pipelineInfo.pipelineLayout = m_particleRenderPipelineLayout;
+				pipelineInfo.shaderModules.push_back(std::move(renderShader));
+
+				pipelineInfo.depthBuffer = true;
+				pipelineInfo.depthWrite = false;
+				pipelineInfo.faceCulling = FaceCulling::None;
+
+				pipelineInfo.blending = true;
+				pipelineInfo.blend.modeColor = BlendEquation::Add;
+				pipelineInfo.blend.modeAlpha = BlendEquation::Add;
+
+				switch (blendMode)
+				{
+					case ParticleBlendMode::Additive:
+						pipelineInfo.blend.srcColor = BlendFunc::SrcAlpha;
+						pipelineInfo.blend.dstColor = BlendFunc::One;
+						pipelineInfo.blend.srcAlpha = BlendFunc::Zero;
+						pipelineInfo.blend.dstAlpha = BlendFunc::One;
+						break;
+
+					case ParticleBlendMode::AlphaBlend:
+						pipelineInfo.blend.srcColor = BlendFunc::SrcAlpha;
+						pipelineInfo.blend.dstColor = BlendFunc::InvSrcAlpha;
+						pipelineInfo.blend.srcAlpha = BlendFunc::One;
+						pipelineInfo.blend.dstAlpha = BlendFunc::InvSrcAlpha;
+						break;
+				}
+
+				pipeline = m_renderDevice->InstantiateRenderPipeline(std::move(pipelineInfo));
+				if (!pipeline)
+					throw std::runtime_error("failed to instantiate particle render pipeline");
+			}
+		}
+	}
+
+	void Graphics::BuildSkinningPipeline()
+	{
+		RenderPipelineLayoutInfo layoutInfo;
+		layoutInfo.bindings.assign({
+			{
+				0, 0, 1,
+				ShaderBindingType::UniformBuffer,
+				nzsl::ShaderStageType::Compute
+			},
+			{
+				0, 1, 1,
+				ShaderBindingType::StorageBuffer,
+				nzsl::ShaderStageType::Compute
+			},
+			{
+				0, 2, 1,
+				ShaderBindingType::StorageBuffer,
+				nzsl::ShaderStageType::Compute
+			}
+		});
+
+		m_skinningPipelineLayout = m_renderDevice->InstantiateRenderPipelineLayout(std::move(layoutInfo));
+		if (!m_skinningPipelineLayout)
+			throw std::runtime_error("failed to instantiate skinning pipeline layout");
+
+		nzsl::Ast::ModulePtr skinningShaderModule = m_shaderModuleResolver->Resolve("ComputeSkinning");
+
+		nzsl::ShaderWriter::States states;
+		states.shaderModuleResolver = m_shaderModuleResolver;
+
+		auto skinningShader = m_renderDevice->InstantiateShaderModule(nzsl::ShaderStageType::Compute, *skinningShaderModule, states);
+		if (!skinningShader)
+			throw std::runtime_error("failed to instantiate skinning shader");
+
+		ComputePipelineInfo pipelineInfo;
+		pipelineInfo.pipelineLayout = m_skinningPipelineLayout;
+		pipelineInfo.shaderModule = std::move(skinningShader);
+
+		m_skinningPipeline = m_renderDevice->InstantiateComputePipeline(std::move(pipelineInfo));
+		if (!m_skinningPipeline)
+			throw std::runtime_error("failed to instantiate skinning pipeline");
+
+		// Skinned vertices are written as std140 vec4 (see ComputeSkinning shader), vertex shaders only read the components they need
+		m_skinnedVertexDeclaration = std::make_shared<VertexDeclaration>(VertexInputRate::Vertex, std::initializer_list<VertexDeclaration::ComponentEntry>{
+			{
+				VertexComponent::Position,
+				ComponentType::Float4,
+				0
+			},
+			{
+				VertexComponent::Normal,
+				ComponentType::Float4,
+				0
+			},
+			{
+				VertexComponent::TexCoord,
+				ComponentType::Float4,
+				0
+			},
+			{
+				VertexComponent::Tangent,
+				ComponentType::Float4,
+				0
+			}
+		});
+	}
+
+	void Graphics::BuildTerrainPipeline()
+	{
+		RenderPipelineLayoutInfo layoutInfo;
+		layoutInfo.bindings.assign({
+			{
+				0, 0, 1,
+				ShaderBindingType::UniformBuffer,
+				nzsl::ShaderStageType::Fragment | nzsl::ShaderStageType::Vertex
+			},
+			{
+				0, 1, 1,
+				ShaderBindingType::UniformBuffer,
+				nzsl::ShaderStageType::Vertex
+			},
+			{
+				0, 2, 1,
+				ShaderBindingType::UniformBuffer,
+				nzsl::ShaderStageType::Fragment | nzsl::ShaderStageType::Vertex
+			},
+			{
+				0, 3, 1,
+				ShaderBindingType::Texture,
+				nzsl::ShaderStageType::Vertex
+			},
+			{
+				0, 4, 1,
+				ShaderBindingType::Sampler,
+				nzsl::ShaderStageType::Fragment
+			}
+		});
+
+		m_terrainRenderPipelineLayout = m_renderDevice->InstantiateRenderPipelineLayout(std::move(layoutInfo));
+		if (!m_terrainRenderPipelineLayout)
+			throw std::runtime_error("failed to instantiate terrain render pipeline layout");
+
+		nzsl::Ast::ModulePtr renderShaderModule = m_shaderModuleResolver->Resolve("TerrainRender");
+
+		nzsl::ShaderWriter::States states;
+		states.shaderModuleResolver = m_shaderModuleResolver;
+
+		auto renderShader = m_renderDevice->InstantiateShaderModule(nzsl::ShaderStageType::Fragment | nzsl::ShaderStageType::Vertex, *renderShaderModule, states);
+		if (!renderShader)
+			throw std::runtime_error("failed to instantiate terrain render shader");
+
+		RenderPipelineInfo pipelineInfo;
+		pipelineInfo.pipelineLayout = m_terrainRenderPipelineLayout;
+		pipelineInfo.shaderModules.push_back(std::move(renderShader));
+		pipelineInfo.depthBuffer = true;
+
+		m_terrainRenderPipeline = m_renderDevice->InstantiateRenderPipeline(std::move(pipelineInfo));
+		if (!m_terrainRenderPipeline)
+			throw std::runtime_error("failed to instantiate terrain render pipeline");
+	}
+
+	void Graphics::BuildUpscalePipelines()
+	{
+		nzsl::ShaderWriter::States states;
+		states.shaderModuleResolver = m_shaderModuleResolver;
+
+		for (UpscalingMode upscalingMode : { UpscalingMode::Spatial, UpscalingMode::Temporal })
+		{
+			RenderPipelineLayoutInfo layoutInfo;
+			layoutInfo.bindings.assign({
+				{
+					0, 0, 1,
+					ShaderBindingType::UniformBuffer,
+					nzsl::ShaderStageType::Fragment
+				},
+				{
+					0, 1, 1,
+					ShaderBindingType::Sampler,
+					nzsl::ShaderStageType::Fragment
+				}
+			});
+
+			const char* moduleName = "SpatialUpscale";
+			if (upscalingMode == UpscalingMode::Temporal)
+			{
+				// Depth (for reprojection) and history of the previous frames
+				layoutInfo.bindings.push_back({
+					0, 2, 1,
+					ShaderBindingType::Sampler,
+					nzsl::ShaderStageType::Fragment
+				});
+
+				layoutInfo.bindings.push_back({
+					0, 3, 1,
+					ShaderBindingType::Sampler,
+					nzsl::ShaderStageType::Fragment
+				});
+
+				moduleName = "TemporalUpscale";
+			}
+
+			std::shared_ptr<RenderPipelineLayout>& pipelineLayout = m_upscalePipelineLayouts[upscalingMode];
+			pipelineLayout = m_renderDevice->InstantiateRenderPipelineLayout(std::move(layoutInfo));
+			if (!pipelineLayout)
+				throw std::runtime_error("failed to instantiate upscale pipeline layout");
+
+			nzsl::Ast::ModulePtr upscaleShaderModule = m_shaderModuleResolver->Resolve(moduleName);
+
+			auto upscaleShader = m_renderDevice->InstantiateShaderModule(nzsl::ShaderStageType::Fragment | nzsl::ShaderStageType::Vertex, *upscaleShaderModule, states);
+			if (!upscaleShader)
+				throw std::runtime_error("failed to instantiate upscale shader");
+
+			RenderPipelineInfo pipelineInfo;
+			pipelineInfo.pipelineLayout = pipelineLayout;
+			pipelineInfo.shaderModules.push_back(std::move(upscaleShader));
+
+			m_upscalePipelines[upscalingMode] = m_renderDevice->InstantiateRenderPipeline(std::move(pipelineInfo));
+			if (!m_upscalePipelines[upscalingMode])
+				throw std::runtime_error("failed to instantiate upscale pipeline");
+		}
+	}
+
+	void Graphics::PreallocateSamplers(const std::vector<TextureSamplerInfo>& userSamplers)
+	{
+		// Samplers used by the engine renderers and passes
+		TextureSamplerInfo nearestSampler;
+		nearestSampler.magFilter = SamplerFilter::Nearest;
+		nearestSampler.minFilter = SamplerFilter::Nearest;
+		nearestSampler.mipmapMode = SamplerMipmapMode::Nearest;
+
+		TextureSamplerInfo shadowSampler;
+		shadowSampler.depthCompare = true;
+
+		m_samplerCache->Preallocate({ TextureSamplerInfo{}, nearestSampler, shadowSampler });
+		m_samplerCache->Preallocate(userSamplers.data(), userSamplers.size());
+	}
+
 	void Graphics::RegisterMaterialPasses()
 	{
 		m_materialPassRegistry.RegisterPass("ForwardPass");
 		m_materialPassRegistry.RegisterPass("DepthPass");
 		m_materialPassRegistry.RegisterPass("ShadowPass");
+		m_materialPassRegistry.RegisterPass("GBufferPass");
 	}
 
 	void Graphics::RegisterShaderModules()
 	{
 		m_shaderModuleResolver = std::make_shared<nzsl::FilesystemModuleResolver>();
 		RegisterEmbedShaderModule(r_basicMaterialShader);
+		RegisterEmbedShaderModule(r_computeSkinningShader);
+		RegisterEmbedShaderModule(r_deferredLightingShader);
 		RegisterEmbedShaderModule(r_fullscreenVertexShader);
+		RegisterEmbedShaderModule(r_hiZDepthCopyShader);
+		RegisterEmbedShaderModule(r_hiZDownsampleShader);
+		RegisterEmbedShaderModule(r_hiZOcclusionTestShader);
+		RegisterEmbedShaderModule(r_impostorBakeShader);
+		RegisterEmbedShaderModule(r_impostorRenderShader);
+		RegisterEmbedShaderModule(r_instanceCullingShader);
 		RegisterEmbedShaderModule(r_instanceDataModule);
+		RegisterEmbedShaderModule(r_lightClusteringShader);
 		RegisterEmbedShaderModule(r_lightDataModule);
 		RegisterEmbedShaderModule(r_mathConstantsModule);
 		RegisterEmbedShaderModule(r_mathCookTorrancePBRModule);
+		RegisterEmbedShaderModule(r_mathOctahedralModule);
+		RegisterEmbedShaderModule(r_particleDataModule);
+		RegisterEmbedShaderModule(r_particleRenderShader);
+		RegisterEmbedShaderModule(r_particleSimulationShader);
+		RegisterEmbedShaderModule(r_particleSortShader);
+		RegisterEmbedShaderModule(r_particleSortKeysShader);
 		RegisterEmbedShaderModule(r_phongMaterialShader);
 		RegisterEmbedShaderModule(r_physicallyBasedMaterialShader);
 		RegisterEmbedShaderModule(r_skinningDataModule);
 		RegisterEmbedShaderModule(r_skinningLinearModule);
 		RegisterEmbedShaderModule(r_skeletalDataModule);
+		RegisterEmbedShaderModule(r_spatialUpscaleShader);
+		RegisterEmbedShaderModule(r_temporalUpscaleShader);
+		RegisterEmbedShaderModule(r_terrainRenderShader);
 		RegisterEmbedShaderModule(r_textureBlitShader);
 		RegisterEmbedShaderModule(r_viewerDataModule);
 
@@ -463,5 +1488,45 @@ namespace Nz
 
 		if (parameters.HasFlag("use-integrated-gpu"))
 			useDedicatedRenderDevice = false;
+
+		std::string_view archivePath;
+		if (parameters.GetParameter("shader-variant-archive", &archivePath))
+			shaderVariantArchivePath = Utf8Path(archivePath);
+
+		if (parameters.HasFlag("preload-default-materials"))
+			preloadDefaultMaterials = true;
+
+		if (parameters.HasFlag("record-shader-variants"))
+			recordShaderVariants = true;
+
+		if (parameters.HasFlag("bindless-textures"))
+			useBindlessTextures = true;
+
+		if (parameters.HasFlag("compute-skinning"))
+			useComputeSkinning = true;
+
+		if (parameters.HasFlag("deferred-shading"))
+			useDeferredShading = true;
+
+		if (parameters.HasFlag("dynamic-resolution"))
+			useDynamicResolution = true;
+
+		if (parameters.HasFlag("gpu-driven-rendering"))
+			useGpuDrivenRendering = true;
+
+		if (parameters.HasFlag("impostors"))
+			useImpostors = true;
+
+		if (parameters.HasFlag("mesh-arena"))
+			useMeshArena = true;
+
+		if (parameters.HasFlag("occlusion-culling"))
+			useOcclusionCulling = true;
+
+		if (parameters.HasFlag("particle-system"))
+			useParticleSystem = true;
+
+		if (parameters.HasFlag("terrain"))
+			useTerrain = true;
 	}
 }
@@ -0,0 +1,253 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/ImageStreamTexture.hpp>
+#include <Nazara/Core/Core.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Graphics/Graphics.hpp>
+#include <Nazara/Graphics/MaterialInstance.hpp>
+#include <Nazara/Renderer/RenderDevice.hpp>
+#include <Nazara/Renderer/Texture.hpp>
+#include <Nazara/Utility/ImageStream.hpp>
+#include <Nazara/Utility/PixelFormat.hpp>
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup graphics
+	* \class Nz::ImageStreamTexture
+	* \brief Graphics class playing an image stream (animated GIF, video, ...) into a texture
+	*
+	* Frames are decoded one at a time by the task scheduler workers into a ring of staging buffers, ahead of the playback time.
+	* Once a frame is due, it is uploaded to the next texture of a texture ring (so a texture which may still be in use by frames in flight
+	* is never overwritten) and this texture replaces the previous one in every bound material instance.
+	*
+	* \remark The buffer count should be greater than the number of frames in flight of the render device
+	*/
+
+	ImageStreamTexture::ImageStreamTexture(std::shared_ptr<ImageStream> imageStream, std::size_t bufferCount) :
+	ImageStreamTexture(Graphics::Instance()->GetRenderDevice(), std::move(imageStream), bufferCount)
+	{
+	}
+
+	ImageStreamTexture::ImageStreamTexture(std::shared_ptr<RenderDevice> renderDevice, std::shared_ptr<ImageStream> imageStream, std::size_t bufferCount) :
+	m_imageStream(std::move(imageStream)),
+	m_renderDevice(std::move(renderDevice)),
+	m_currentTexture(InvalidIndex),
+	m_decodingFrame(InvalidIndex),
+	m_loopOffset(Time::Zero()),
+	m_playbackTime(Time::Zero()),
+	m_isLooping(false),
+	m_isPaused(false),
+	m_streamEnded(false)
+	{
+		NazaraAssert(m_imageStream, "invalid image stream");
+		NazaraAssert(m_renderDevice, "invalid render device");
+		NazaraAssert(bufferCount >= 2, "at least two buffers are required");
+
+		PixelFormat pixelFormat = m_imageStream->GetPixelFormat();
+		Vector2ui size = m_imageStream->GetSize();
+		std::size_t frameSize = PixelFormatInfo::ComputeSize(pixelFormat, size.x, size.y, 1);
+
+		TextureInfo textureInfo;
+		textureInfo.pixelFormat = pixelFormat;
+		textureInfo.type = ImageType::E2D;
+		textureInfo.usageFlags = TextureUsage::ShaderSampling | TextureUsage::TransferDestination;
+		textureInfo.width = size.x;
+		textureInfo.height = size.y;
+		textureInfo.levelCount = 1;
+
+		m_stagingFrames.resize(bufferCount);
+		m_textures.reserve(bufferCount);
+		for (std::size_t i = 0; i < bufferCount; ++i)
+		{
+			m_stagingFrames[i].pixels.resize(frameSize);
+			m_freeFrames.push_back(bufferCount - i - 1);
+
+			std::shared_ptr<Texture> texture = m_renderDevice->InstantiateTexture(textureInfo);
+			if (!texture)
+				throw std::runtime_error("failed to instantiate image stream texture");
+
+			if (std::string debugName = m_imageStream->GetFilePath().generic_u8string(); !debugName.empty())
+				texture->UpdateDebugName(debugName);
+
+			m_textures.push_back(std::move(texture));
+		}
+
+		StartDecoding();
+	}
+
+	ImageStreamTexture::~ImageStreamTexture()
+	{
+		if (m_decodingTask.IsValid())
+			Core::Instance()->GetTaskScheduler().WaitFor(m_decodingTask);
+	}
+
+	/*!
+	* \brief Sets a material texture property to the stream texture and keeps it updated when a new frame is presented
+	*
+	* \param materialInstance Material instance using the texture, it will be kept alive until unbound
+	* \param texturePropertyIndex Texture property index in the material instance
+	*/
+	void ImageStreamTexture::BindMaterialTexture(std::shared_ptr<MaterialInstance> materialInstance, std::size_t texturePropertyIndex)
+	{
+		NazaraAssert(materialInstance, "invalid material instance");
+
+		if (m_currentTexture != InvalidIndex)
+			materialInstance->SetTextureProperty(texturePropertyIndex, m_textures[m_currentTexture]);
+
+		auto& binding = m_materialBindings.emplace_back();
+		binding.materialInstance = std::move(materialInstance);
+		binding.texturePropertyIndex = texturePropertyIndex;
+	}
+
+	/*!
+	* \brief Returns the texture holding the last presented frame
+	*
+	* \return Current texture, or a null pointer if no frame has been presented yet
+	*/
+	const std::shared_ptr<Texture>& ImageStreamTexture::GetTexture() const
+	{
+		static std::shared_ptr<Texture> s_noTexture;
+		if (m_currentTexture == InvalidIndex)
+			return s_noTexture;
+
+		return m_textures[m_currentTexture];
+	}
+
+	/*!
+	* \brief Restarts playback from the first frame of the stream
+	*
+	* \remark This waits for the frame being decoded, if any
+	*/
+	void ImageStreamTexture::Restart()
+	{
+		if (m_decodingTask.IsValid())
+		{
+			Core::Instance()->GetTaskScheduler().WaitFor(m_decodingTask);
+			RetrieveDecodedFrame();
+		}
+
+		for (std::size_t frameIndex : m_readyFrames)
+			m_freeFrames.push_back(frameIndex);
+
+		m_readyFrames.clear();
+
+		m_imageStream->Seek(0);
+		m_loopOffset = Time::Zero();
+		m_playbackTime = Time::Zero();
+		m_streamEnded = false;
+
+		StartDecoding();
+	}
+
+	void ImageStreamTexture::UnbindMaterial(const MaterialInstance* materialInstance)
+	{
+		auto it = std::remove_if(m_materialBindings.begin(), m_materialBindings.end(), [&](const MaterialBinding& binding) { return binding.materialInstance.get() == materialInstance; });
+		m_materialBindings.erase(it, m_materialBindings.end());
+	}
+
+	/*!
+	* \brief Advances playback and presents the most recent frame which is due
+	*
+	* Frames whose time was exceeded by the playback time before they were presented are skipped.
+	*
+	* \param elapsedTime Time elapsed since the last update (ignored while paused)
+	*
+	* \remark This uploads texture data and must be called from the rendering thread
+	*/
+	void ImageStreamTexture::Update(Time elapsedTime)
+	{
+		if (!m_isPaused)
+			m_playbackTime += elapsedTime;
+
+		if (m_decodingTask.IsValid() && m_decodingTask.IsFinished())
+			RetrieveDecodedFrame();
+
+		std::size_t presentedFrame = InvalidIndex;
+		while (!m_readyFrames.empty() && m_stagingFrames[m_readyFrames.front()].frameTime <= m_playbackTime)
+		{
+			if (presentedFrame != InvalidIndex)
+				m_freeFrames.push_back(presentedFrame);
+
+			presentedFrame = m_readyFrames.front();
+			m_readyFrames.pop_front();
+		}
+
+		if (presentedFrame != InvalidIndex)
+		{
+			PresentFrame(presentedFrame);
+			m_freeFrames.push_back(presentedFrame);
+		}
+
+		if (!m_decodingTask.IsValid())
+			StartDecoding();
+	}
+
+	void ImageStreamTexture::PresentFrame(std::size_t frameIndex)
+	{
+		std::size_t textureIndex = (m_currentTexture != InvalidIndex) ? (m_currentTexture + 1) % m_textures.size() : 0;
+
+		const std::shared_ptr<Texture>& texture = m_textures[textureIndex];
+		if (!texture->Update(m_stagingFrames[frameIndex].pixels.data()))
+		{
+			NazaraError("failed to upload image stream frame");
+			return;
+		}
+
+		m_currentTexture = textureIndex;
+
+		for (const MaterialBinding& binding : m_materialBindings)
+			binding.materialInstance->SetTextureProperty(binding.texturePropertyIndex, texture);
+
+		OnTextureFlip(this, texture);
+	}
+
+	void ImageStreamTexture::RetrieveDecodedFrame()
+	{
+		assert(m_decodingFrame != InvalidIndex);
+
+		if (m_stagingFrames[m_decodingFrame].decoded)
+			m_readyFrames.push_back(m_decodingFrame);
+		else
+		{
+			m_freeFrames.push_back(m_decodingFrame);
+			m_streamEnded = true;
+		}
+
+		m_decodingFrame = InvalidIndex;
+		m_decodingTask = {};
+	}
+
+	void ImageStreamTexture::StartDecoding()
+	{
+		if (m_streamEnded || m_freeFrames.empty())
+			return;
+
+		m_decodingFrame = m_freeFrames.back();
+		m_freeFrames.pop_back();
+
+		// The stream and loop offset are only accessed by the decoding task while it runs
+		m_decodingTask = Core::Instance()->GetTaskScheduler().AddTask([this, frameIndex = m_decodingFrame, loop = m_isLooping]
+		{
+			StagingFrame& frame = m_stagingFrames[frameIndex];
+
+			Time frameTime;
+			frame.decoded = m_imageStream->DecodeNextFrame(frame.pixels.data(), &frameTime);
+			if (!frame.decoded && loop && m_imageStream->GetFrameCount() > 0)
+			{
+				// frameTime holds the stream duration once its end is reached
+				m_loopOffset += frameTime;
+				m_imageStream->Seek(0);
+				frame.decoded = m_imageStream->DecodeNextFrame(frame.pixels.data(), &frameTime);
+			}
+
+			frame.frameTime = m_loopOffset + frameTime;
+		});
+	}
+}
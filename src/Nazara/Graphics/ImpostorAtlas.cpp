@@ -0,0 +1,413 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/ImpostorAtlas.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Graphics/GraphicalMesh.hpp>
+#include <Nazara/Graphics/Graphics.hpp>
+#include <Nazara/Graphics/MaterialInstance.hpp>
+#include <Nazara/Graphics/Model.hpp>
+#include <Nazara/Math/Matrix4.hpp>
+#include <Nazara/Renderer/CommandBufferBuilder.hpp>
+#include <Nazara/Renderer/Framebuffer.hpp>
+#include <Nazara/Renderer/RenderBuffer.hpp>
+#include <Nazara/Renderer/RenderDevice.hpp>
+#include <Nazara/Renderer/RenderFrame.hpp>
+#include <Nazara/Renderer/ShaderBinding.hpp>
+#include <Nazara/Renderer/Texture.hpp>
+#include <Nazara/Utility/Algorithm.hpp>
+#include <Nazara/Utility/VertexDeclaration.hpp>
+#include <NZSL/Math/FieldOffsets.hpp>
+#include <cmath>
+#include <stdexcept>
+#include <unordered_map>
+#include <variant>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	NAZARA_ANONYMOUS_NAMESPACE
+	{
+		struct BakeDataOffsets
+		{
+			std::size_t viewProjMatrix;
+			std::size_t baseColor;
+			std::size_t alphaThreshold;
+			std::size_t totalSize;
+		};
+
+		struct ImpostorDataOffsets
+		{
+			std::size_t center;
+			std::size_t radius;
+			std::size_t frameCount;
+			std::size_t fadeStartSize;
+			std::size_t fadeEndSize;
+			std::size_t totalSize;
+		};
+
+		// Must match ImpostorBake shader
+		BakeDataOffsets GetBakeDataOffsets()
+		{
+			nzsl::FieldOffsets bakeStruct(nzsl::StructLayout::Std140);
+
+			BakeDataOffsets offsets;
+			offsets.viewProjMatrix = bakeStruct.AddMatrix(nzsl::StructFieldType::Float1, 4, 4, true);
+			offsets.baseColor = bakeStruct.AddField(nzsl::StructFieldType::Float4);
+			offsets.alphaThreshold = bakeStruct.AddField(nzsl::StructFieldType::Float1);
+			offsets.totalSize = bakeStruct.GetAlignedSize();
+
+			return offsets;
+		}
+
+		// Must match ImpostorRender shader
+		ImpostorDataOffsets GetImpostorDataOffsets()
+		{
+			nzsl::FieldOffsets impostorStruct(nzsl::StructLayout::Std140);
+
+			ImpostorDataOffsets offsets;
+			offsets.center = impostorStruct.AddField(nzsl::StructFieldType::Float3);
+			offsets.radius = impostorStruct.AddField(nzsl::StructFieldType::Float1);
+			offsets.frameCount = impostorStruct.AddField(nzsl::StructFieldType::Float1);
+			offsets.fadeStartSize = impostorStruct.AddField(nzsl::StructFieldType::Float1);
+			offsets.fadeEndSize = impostorStruct.AddField(nzsl::StructFieldType::Float1);
+			offsets.totalSize = impostorStruct.GetAlignedSize();
+
+			return offsets;
+		}
+
+		// Must match ImpostorRender shader billboard basis
+		Vector3f GetBakeUp(const Vector3f& direction)
+		{
+			return (std::abs(direction.y) > 0.99f) ? Vector3f::UnitZ() : Vector3f::Up();
+		}
+	}
+
+	/*!
+	* \ingroup graphics
+	* \class ImpostorAtlas
+	* \brief Atlas of model views used by Model to render distant instances as camera-facing quads
+	*
+	* The atlas only stores the (unlit) base color of the model, with its coverage in the alpha channel.
+	*
+	* \see Model::SetImpostor
+	*/
+
+	/*!
+	* \brief Constructs an impostor atlas from an already baked texture
+	*
+	* \param atlasTexture Texture holding frameCount x frameCount frames (see Bake for the layout of frames)
+	* \param frameCount Number of frames on each side of the atlas
+	* \param center Center of the bounding sphere of the model, in model space
+	* \param radius Radius of the bounding sphere of the model
+	* \param screenSize Projected size (in pixels) of the model below which the impostor replaces it, the size of a frame gives an impostor as sharp as the model
+	*/
+	ImpostorAtlas::ImpostorAtlas(std::shared_ptr<Texture> atlasTexture, UInt32 frameCount, const Vector3f& center, float radius, float screenSize) :
+	m_atlasTexture(std::move(atlasTexture)),
+	m_center(center),
+	m_frameCount(frameCount),
+	m_radius(radius),
+	m_screenSize(screenSize)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		NazaraAssert(m_atlasTexture, "invalid atlas texture");
+		NazaraAssert(m_frameCount > 0, "invalid frame count");
+		NazaraAssert(m_radius > 0.f, "invalid radius");
+		NazaraAssert(m_screenSize > 0.f, "invalid screen size");
+
+		static ImpostorDataOffsets impostorDataOffsets = GetImpostorDataOffsets();
+
+		// The impostor fades in over the mesh (dithered) from 1.5x its screen size, which matches the transition level of detail of Model
+		std::vector<UInt8> impostorData(impostorDataOffsets.totalSize);
+		AccessByOffset<Vector3f&>(impostorData.data(), impostorDataOffsets.center) = m_center;
+		AccessByOffset<float&>(impostorData.data(), impostorDataOffsets.radius) = m_radius;
+		AccessByOffset<float&>(impostorData.data(), impostorDataOffsets.frameCount) = float(m_frameCount);
+		AccessByOffset<float&>(impostorData.data(), impostorDataOffsets.fadeStartSize) = m_screenSize * 1.5f;
+		AccessByOffset<float&>(impostorData.data(), impostorDataOffsets.fadeEndSize) = m_screenSize;
+
+		m_impostorBuffer = Graphics::Instance()->GetRenderDevice()->InstantiateBuffer(BufferType::Uniform, impostorData.size(), BufferUsage::DeviceLocal | BufferUsage::Write, impostorData.data());
+	}
+
+	/*!
+	* \brief Renders the views of a model to a new atlas
+	* \return Impostor atlas, its texture is filled when the render frame is submitted
+	*
+	* Every submesh is rendered with the base color (value and texture) of its material, with no lighting.
+	* Frame (x, y) is an orthographic view of the bounding sphere of the model, looking at its center from the direction DecodeOctahedral((x + 0.5, y + 0.5) / frameCount * 2 - 1).
+	*
+	* \param renderFrame Frame in which the rendering commands are recorded
+	* \param model Model to bake, in its bind pose
+	* \param params Bake parameters
+	*
+	* \remark Impostors must be enabled (see Graphics::Config::useImpostors)
+	*/
+	std::shared_ptr<ImpostorAtlas> ImpostorAtlas::Bake(RenderFrame& renderFrame, const Model& model, const BakeParams& params)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		NazaraAssert(params.frameCount > 0, "invalid frame count");
+		NazaraAssert(params.frameSize > 0, "invalid frame size");
+
+		Graphics* graphics = Graphics::Instance();
+		if (!graphics->IsImpostorEnabled())
+		{
+			NazaraError("impostors are not enabled (see Graphics::Config::useImpostors)");
+			return nullptr;
+		}
+
+		const std::shared_ptr<RenderDevice>& renderDevice = graphics->GetRenderDevice();
+		const GraphicalMesh& graphicalMesh = *model.GetGraphicalMesh();
+
+		const Boxf& aabb = model.GetAABB();
+		Vector3f center = aabb.GetCenter();
+		float radius = std::max(aabb.GetLengths().GetLength() * 0.5f, 0.0001f);
+
+		unsigned int atlasSize = params.frameCount * params.frameSize;
+
+		TextureInfo atlasTextureInfo;
+		atlasTextureInfo.pixelFormat = PixelFormat::RGBA8;
+		atlasTextureInfo.type = ImageType::E2D;
+		atlasTextureInfo.usageFlags = TextureUsage::ColorAttachment | TextureUsage::ShaderSampling;
+		atlasTextureInfo.levelCount = 1;
+		atlasTextureInfo.width = atlasSize;
+		atlasTextureInfo.height = atlasSize;
+
+		std::shared_ptr<Texture> atlasTexture = renderDevice->InstantiateTexture(atlasTextureInfo);
+		if (!atlasTexture)
+		{
+			NazaraError("failed to instantiate impostor atlas texture");
+			return nullptr;
+		}
+
+		TextureInfo depthTextureInfo;
+		depthTextureInfo.pixelFormat = graphics->GetPreferredDepthFormat();
+		depthTextureInfo.type = ImageType::E2D;
+		depthTextureInfo.usageFlags = TextureUsage::DepthStencilAttachment | TextureUsage::TransientAttachment;
+		depthTextureInfo.levelCount = 1;
+		depthTextureInfo.width = atlasSize;
+		depthTextureInfo.height = atlasSize;
+
+		std::shared_ptr<Texture> depthTexture = renderDevice->InstantiateTexture(depthTextureInfo);
+		if (!depthTexture)
+		{
+			NazaraError("failed to instantiate impostor depth texture");
+			return nullptr;
+		}
+
+		std::vector<RenderPass::Attachment> attachments = {
+			{
+				PixelFormat::RGBA8,
+				AttachmentLoadOp::Clear,
+				AttachmentLoadOp::Discard,
+				AttachmentStoreOp::Store,
+				AttachmentStoreOp::Discard,
+				TextureLayout::Undefined,
+				TextureLayout::ColorInput
+			},
+			{
+				depthTextureInfo.pixelFormat,
+				AttachmentLoadOp::Clear,
+				AttachmentLoadOp::Discard,
+				AttachmentStoreOp::Discard,
+				AttachmentStoreOp::Discard,
+				TextureLayout::Undefined,
+				TextureLayout::DepthStencilReadWrite
+			}
+		};
+
+		std::vector<RenderPass::SubpassDescription> subpasses = {
+			{
+				{ { 0, TextureLayout::ColorOutput } },
+				{},
+				{},
+				RenderPass::AttachmentReference{ 1, TextureLayout::DepthStencilReadWrite }
+			}
+		};
+
+		// The atlas is sampled by the impostor renderer once baked
+		std::vector<RenderPass::SubpassDependency> dependencies = {
+			{
+				0, PipelineStage::ColorOutput, MemoryAccess::ColorWrite,
+				RenderPass::ExternalSubpassIndex, PipelineStage::FragmentShader, MemoryAccess::ShaderRead
+			}
+		};
+
+		const std::shared_ptr<RenderPass>& renderPass = graphics->GetRenderPassCache().Get(attachments, subpasses, dependencies);
+		std::shared_ptr<Framebuffer> framebuffer = renderDevice->InstantiateFramebuffer(atlasSize, atlasSize, renderPass, { atlasTexture, depthTexture });
+
+		// Pipelines depend on the vertex declaration of submeshes
+		std::unordered_map<const VertexDeclaration*, std::shared_ptr<RenderPipeline>> pipelines;
+		nzsl::Ast::ModulePtr bakeShaderModule = graphics->GetShaderModuleResolver()->Resolve("ImpostorBake");
+
+		auto GetPipeline = [&](std::size_t subMeshIndex) -> const std::shared_ptr<RenderPipeline>&
+		{
+			const auto& vertexBufferData = model.GetVertexBufferData(subMeshIndex);
+			const VertexDeclaration& vertexDeclaration = *vertexBufferData.front().declaration;
+
+			std::shared_ptr<RenderPipeline>& pipeline = pipelines[&vertexDeclaration];
+			if (pipeline)
+				return pipeline;
+
+			nzsl::ShaderWriter::States states;
+			states.shaderModuleResolver = graphics->GetShaderModuleResolver();
+
+			// Same locations as Material vertex options
+			Int32 locationIndex = 0;
+			for (const auto& component : vertexDeclaration.GetComponents())
+			{
+				if (component.component == VertexComponent::Position)
+					states.optionValues[CRC32("VertexPositionLoc")] = locationIndex;
+				else if (component.component == VertexComponent::TexCoord)
+					states.optionValues[CRC32("VertexUvLoc")] = locationIndex;
+
+				++locationIndex;
+			}
+
+			auto bakeShader = renderDevice->InstantiateShaderModule(nzsl::ShaderStageType::Fragment | nzsl::ShaderStageType::Vertex, *bakeShaderModule, states);
+			if (!bakeShader)
+				throw std::runtime_error("failed to instantiate impostor bake shader");
+
+			RenderPipelineInfo pipelineInfo;
+			pipelineInfo.pipelineLayout = graphics->GetImpostorBakePipelineLayout();
+			pipelineInfo.shaderModules.push_back(std::move(bakeShader));
+			pipelineInfo.vertexBuffers = vertexBufferData;
+			pipelineInfo.depthBuffer = true;
+			pipelineInfo.faceCulling = FaceCulling::None;
+
+			pipeline = renderDevice->InstantiateRenderPipeline(std::move(pipelineInfo));
+			if (!pipeline)
+				throw std::runtime_error("failed to instantiate impostor bake pipeline");
+
+			return pipeline;
+		};
+
+		static BakeDataOffsets bakeDataOffsets = GetBakeDataOffsets();
+		std::size_t bakeDataAlignedSize = AlignPow2(bakeDataOffsets.totalSize, SafeCast<std::size_t>(renderDevice->GetDeviceInfo().limits.minUniformBufferOffsetAlignment));
+
+		std::size_t subMeshCount = model.GetSubMeshCount();
+		std::size_t frameCount = std::size_t(params.frameCount) * params.frameCount;
+
+		// One entry per frame and submesh
+		std::vector<UInt8> bakeData(frameCount * subMeshCount * bakeDataAlignedSize);
+		for (std::size_t frameIndex = 0; frameIndex < frameCount; ++frameIndex)
+		{
+			std::size_t x = frameIndex % params.frameCount;
+			std::size_t y = frameIndex / params.frameCount;
+
+			Vector2f encodedDirection((x + 0.5f) / params.frameCount * 2.f - 1.f, (y + 0.5f) / params.frameCount * 2.f - 1.f);
+			Vector3f direction = DecodeOctahedral(encodedDirection);
+
+			Matrix4f viewMatrix = Matrix4f::LookAt(center + direction * (radius * 2.f), center, GetBakeUp(direction));
+			Matrix4f projectionMatrix = Matrix4f::Ortho(-radius, radius, -radius, radius, radius, radius * 3.f);
+			Matrix4f viewProjMatrix = viewMatrix * projectionMatrix;
+
+			for (std::size_t subMeshIndex = 0; subMeshIndex < subMeshCount; ++subMeshIndex)
+			{
+				const MaterialInstance& material = *model.GetMaterial(subMeshIndex);
+
+				Color baseColor = Color::White();
+				if (std::size_t propertyIndex = material.FindValueProperty("BaseColor"); propertyIndex != MaterialSettings::InvalidPropertyIndex)
+				{
+					if (const Color* color = std::get_if<Color>(&material.GetValueProperty(propertyIndex)))
+						baseColor = *color;
+				}
+
+				UInt8* entryData = &bakeData[(frameIndex * subMeshCount + subMeshIndex) * bakeDataAlignedSize];
+				AccessByOffset<Matrix4f&>(entryData, bakeDataOffsets.viewProjMatrix) = viewProjMatrix;
+				AccessByOffset<Vector4f&>(entryData, bakeDataOffsets.baseColor) = Vector4f(baseColor.r, baseColor.g, baseColor.b, baseColor.a);
+				AccessByOffset<float&>(entryData, bakeDataOffsets.alphaThreshold) = params.alphaThreshold;
+			}
+		}
+
+		std::shared_ptr<RenderBuffer> bakeBuffer = renderDevice->InstantiateBuffer(BufferType::Uniform, bakeData.size(), BufferUsage::DeviceLocal | BufferUsage::Write, bakeData.data());
+
+		const std::shared_ptr<Texture>& whiteTexture = graphics->GetDefaultTextures().whiteTextures[ImageType::E2D];
+
+		std::vector<ShaderBindingPtr> shaderBindings;
+		shaderBindings.reserve(frameCount * subMeshCount);
+		for (std::size_t frameIndex = 0; frameIndex < frameCount; ++frameIndex)
+		{
+			for (std::size_t subMeshIndex = 0; subMeshIndex < subMeshCount; ++subMeshIndex)
+			{
+				const MaterialInstance& material = *model.GetMaterial(subMeshIndex);
+
+				const Texture* baseColorMap = whiteTexture.get();
+				TextureSamplerInfo samplerInfo;
+				if (std::size_t propertyIndex = material.FindTextureProperty("BaseColorMap"); propertyIndex != MaterialSettings::InvalidPropertyIndex)
+				{
+					if (const std::shared_ptr<Texture>& texture = material.GetTextureProperty(propertyIndex))
+					{
+						baseColorMap = texture.get();
+						samplerInfo = material.GetTextureSamplerProperty(propertyIndex);
+					}
+				}
+
+				ShaderBindingPtr& shaderBinding = shaderBindings.emplace_back(graphics->GetImpostorBakePipelineLayout()->AllocateShaderBinding(0));
+				shaderBinding->Update({
+					{
+						0,
+						ShaderBinding::UniformBufferBinding {
+							bakeBuffer.get(),
+							(frameIndex * subMeshCount + subMeshIndex) * bakeDataAlignedSize, bakeDataOffsets.totalSize
+						}
+					},
+					{
+						1,
+						ShaderBinding::SampledTextureBinding {
+							baseColorMap,
+							graphics->GetSamplerCache().Get(samplerInfo).get()
+						}
+					}
+				});
+			}
+		}
+
+		renderFrame.Execute([&](CommandBufferBuilder& builder)
+		{
+			builder.BeginDebugRegion("Impostor bake", Color::Green());
+			{
+				// Transparent texels are black so that bilinear filtering doesn't bleed a color at the silhouette
+				builder.BeginRenderPass(*framebuffer, *renderPass, Recti(0, 0, int(atlasSize), int(atlasSize)), { CommandBufferBuilder::ClearValues{ Color(0.f, 0.f, 0.f, 0.f) }, CommandBufferBuilder::ClearValues{} });
+
+				for (std::size_t frameIndex = 0; frameIndex < frameCount; ++frameIndex)
+				{
+					int x = int(frameIndex % params.frameCount);
+					int y = int(frameIndex / params.frameCount);
+
+					Recti frameRect(x * int(params.frameSize), y * int(params.frameSize), int(params.frameSize), int(params.frameSize));
+					builder.SetViewport(frameRect);
+					builder.SetScissor(frameRect);
+
+					for (std::size_t subMeshIndex = 0; subMeshIndex < subMeshCount; ++subMeshIndex)
+					{
+						builder.BindRenderPipeline(*GetPipeline(subMeshIndex));
+						builder.BindRenderShaderBinding(0, *shaderBindings[frameIndex * subMeshCount + subMeshIndex]);
+						builder.BindVertexBuffer(0, *graphicalMesh.GetVertexBuffer(subMeshIndex), graphicalMesh.GetVertexBufferOffset(subMeshIndex));
+
+						if (const auto& indexBuffer = graphicalMesh.GetIndexBuffer(subMeshIndex))
+						{
+							builder.BindIndexBuffer(*indexBuffer, graphicalMesh.GetIndexType(subMeshIndex));
+							builder.DrawIndexed(graphicalMesh.GetIndexCount(subMeshIndex), 1, graphicalMesh.GetFirstIndex(subMeshIndex));
+						}
+						else
+							builder.Draw(graphicalMesh.GetVertexCount(subMeshIndex));
+					}
+				}
+
+				builder.EndRenderPass();
+			}
+			builder.EndDebugRegion();
+		}, QueueType::Graphics);
+
+		// Bake resources must live until the frame has been executed
+		renderFrame.PushForRelease(std::move(shaderBindings));
+		renderFrame.PushForRelease(std::move(bakeBuffer));
+		renderFrame.PushForRelease(std::move(framebuffer));
+		renderFrame.PushForRelease(std::move(depthTexture));
+		renderFrame.PushForRelease(std::move(pipelines));
+
+		return std::make_shared<ImpostorAtlas>(std::move(atlasTexture), params.frameCount, center, radius, float(params.frameSize));
+	}
+}
@@ -0,0 +1,162 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/ImpostorRenderer.hpp>
+#include <Nazara/Graphics/Graphics.hpp>
+#include <Nazara/Graphics/ImpostorAtlas.hpp>
+#include <Nazara/Graphics/ViewerInstance.hpp>
+#include <Nazara/Renderer/CommandBufferBuilder.hpp>
+#include <Nazara/Renderer/RenderBuffer.hpp>
+#include <Nazara/Renderer/RenderDevice.hpp>
+#include <Nazara/Renderer/RenderFrame.hpp>
+#include <array>
+#include <cmath>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup graphics
+	* \class ImpostorRenderer
+	* \brief Element renderer drawing model impostors as camera-facing quads
+	*
+	* Every impostor is a single quad expanded in the vertex shader, which blends the atlas frames closest to the viewer direction.
+	*/
+	ImpostorRenderer::ImpostorRenderer(RenderDevice& device) :
+	m_device(device)
+	{
+		// Impostor quads are expanded from their corner index in the vertex shader
+		std::array<UInt16, 6> indices = { 0, 1, 2, 2, 1, 3 };
+		m_indexBuffer = m_device.InstantiateBuffer(BufferType::Index, indices.size() * sizeof(UInt16), BufferUsage::DeviceLocal | BufferUsage::Write, indices.data());
+	}
+
+	RenderElementPool<RenderImpostor>& ImpostorRenderer::GetPool()
+	{
+		return m_impostorPool;
+	}
+
+	std::unique_ptr<ElementRendererData> ImpostorRenderer::InstanciateData()
+	{
+		return std::make_unique<ImpostorRendererData>();
+	}
+
+	void ImpostorRenderer::Prepare(const ViewerInstance& viewerInstance, ElementRendererData& rendererData, RenderFrame& currentFrame, std::size_t elementCount, const Pointer<const RenderElement>* elements, const RenderStates* /*renderStates*/)
+	{
+		Graphics* graphics = Graphics::Instance();
+
+		auto& data = static_cast<ImpostorRendererData&>(rendererData);
+
+		const auto& defaultSampler = graphics->GetSamplerCache().Get({});
+
+		for (std::size_t i = 0; i < elementCount; ++i)
+		{
+			assert(elements[i]->GetElementType() == UnderlyingCast(BasicRenderElement::Impostor));
+			const RenderImpostor& renderImpostor = static_cast<const RenderImpostor&>(*elements[i]);
+			const ImpostorAtlas& impostor = renderImpostor.GetImpostor();
+			const WorldInstance& worldInstance = renderImpostor.GetWorldInstance();
+			const RenderBufferView& instanceBuffer = worldInstance.GetInstanceBuffer();
+
+			auto& instanceData = data.instances[{ &worldInstance, &impostor }];
+			if (instanceData.shaderBinding)
+			{
+				// Another world instance or impostor may have been allocated at the address of a released one
+				if (instanceData.impostorBuffer == impostor.GetImpostorBuffer() && instanceData.instanceBuffer == instanceBuffer.GetBuffer() && instanceData.instanceBufferOffset == instanceBuffer.GetOffset())
+				{
+					instanceData.isUsed = true;
+					continue;
+				}
+
+				currentFrame.PushForRelease(std::move(instanceData));
+				instanceData = ImpostorRendererData::InstanceData{};
+			}
+
+			instanceData.impostorBuffer = impostor.GetImpostorBuffer();
+			instanceData.instanceBuffer = instanceBuffer.GetBuffer();
+			instanceData.instanceBufferOffset = instanceBuffer.GetOffset();
+			instanceData.isUsed = true;
+
+			instanceData.shaderBinding = graphics->GetImpostorRenderPipelineLayout()->AllocateShaderBinding(0);
+			instanceData.shaderBinding->Update({
+				{
+					0,
+					ShaderBinding::UniformBufferBinding {
+						viewerInstance.GetViewerBuffer().get(),
+						0, viewerInstance.GetViewerBuffer()->GetSize()
+					}
+				},
+				{
+					1,
+					ShaderBinding::UniformBufferBinding {
+						instanceBuffer.GetBuffer(),
+						instanceBuffer.GetOffset(), instanceBuffer.GetSize()
+					}
+				},
+				{
+					2,
+					ShaderBinding::UniformBufferBinding {
+						impostor.GetImpostorBuffer().get(),
+						0, impostor.GetImpostorBuffer()->GetSize()
+					}
+				},
+				{
+					3,
+					ShaderBinding::SampledTextureBinding {
+						impostor.GetAtlasTexture().get(),
+						defaultSampler.get()
+					}
+				}
+			});
+		}
+	}
+
+	void ImpostorRenderer::PrepareEnd(RenderFrame& currentFrame, ElementRendererData& rendererData)
+	{
+		auto& data = static_cast<ImpostorRendererData&>(rendererData);
+
+		// Release data of impostors which are no longer visible
+		for (auto it = data.instances.begin(); it != data.instances.end();)
+		{
+			if (!it->second.isUsed)
+			{
+				currentFrame.PushForRelease(std::move(it->second));
+				it = data.instances.erase(it);
+			}
+			else
+				++it;
+		}
+	}
+
+	void ImpostorRenderer::Render(const ViewerInstance& viewerInstance, ElementRendererData& rendererData, CommandBufferBuilder& commandBuffer, std::size_t elementCount, const Pointer<const RenderElement>* elements)
+	{
+		Graphics* graphics = Graphics::Instance();
+
+		auto& data = static_cast<ImpostorRendererData&>(rendererData);
+
+		commandBuffer.BindRenderPipeline(*graphics->GetImpostorRenderPipeline());
+		commandBuffer.BindIndexBuffer(*m_indexBuffer, IndexType::U16);
+
+		Vector2f targetSize = viewerInstance.GetTargetSize();
+		commandBuffer.SetScissor(Recti(0, 0, SafeCast<int>(std::floor(targetSize.x)), SafeCast<int>(std::floor(targetSize.y))));
+
+		for (std::size_t i = 0; i < elementCount; ++i)
+		{
+			const RenderImpostor& renderImpostor = static_cast<const RenderImpostor&>(*elements[i]);
+
+			auto it = data.instances.find({ &renderImpostor.GetWorldInstance(), &renderImpostor.GetImpostor() });
+			assert(it != data.instances.end());
+
+			commandBuffer.BindRenderShaderBinding(0, *it->second.shaderBinding);
+			commandBuffer.DrawIndexed(6);
+		}
+	}
+
+	void ImpostorRenderer::Reset(ElementRendererData& rendererData, RenderFrame& /*currentFrame*/)
+	{
+		auto& data = static_cast<ImpostorRendererData&>(rendererData);
+
+		// Shader bindings are kept for impostors which are still visible after the next Prepare
+		for (auto&& [key, instanceData] : data.instances)
+			instanceData.isUsed = false;
+	}
+}
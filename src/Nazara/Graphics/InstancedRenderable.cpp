@@ -8,4 +8,66 @@
 namespace Nz
 {
 	InstancedRenderable::~InstancedRenderable() = default;
+
+	/*!
+	* \brief Gets the number of levels of detail the renderable can build its elements with
+	* \return Level of detail count, one if the renderable has no simplified version
+	*/
+	std::size_t InstancedRenderable::GetLODCount() const
+	{
+		return 1;
+	}
+
+	/*!
+	* \brief Gets the simplification error of a level of detail
+	* \return Error relative to the size of the renderable (length of its AABB diagonal), zero for the full detail level
+	*
+	* \param lodIndex Level of detail index
+	*/
+	float InstancedRenderable::GetLODError(std::size_t lodIndex) const
+	{
+		NazaraUnused(lodIndex);
+		return 0.f;
+	}
+
+	/*!
+	* \brief Checks if the renderable has to be simulated every frame (see Simulate)
+	* \return True if the frame pipeline should call Simulate once per frame
+	*/
+	bool InstancedRenderable::IsSimulated() const
+	{
+		return false;
+	}
+
+	/*!
+	* \brief Registers the meshes of the renderable to be skinned by a compute shader (see SkeletonInstance::EnableComputeSkinning)
+	*
+	* This is called by the frame pipeline when the renderable is associated with a skeleton instance and compute skinning is enabled,
+	* renderables which don't support compute skinning keep being skinned by the vertex shader.
+	*
+	* \param skeletonInstance Skeleton instance used to render the renderable
+	*/
+	void InstancedRenderable::RegisterComputeSkinning(SkeletonInstance& skeletonInstance) const
+	{
+		NazaraUnused(skeletonInstance);
+	}
+
+	/*!
+	* \brief Records the GPU simulation of the renderable for this frame
+	*
+	* This is called by the frame pipeline once per frame for every registered renderable returning true from IsSimulated, before any pass is prepared.
+	* The commands are recorded to a compute command buffer, barriers between the simulation and the passes using its results are left to the renderable.
+	*
+	* \param renderFrame Frame being rendered
+	* \param builder Command buffer builder used to record the simulation
+	* \param worldInstance World instance the renderable is registered with
+	* \param simulationData Elapsed time since the last simulation and depth of a viewer (if any) for collisions
+	*/
+	void InstancedRenderable::Simulate(RenderFrame& renderFrame, CommandBufferBuilder& builder, const WorldInstance& worldInstance, const SimulationData& simulationData) const
+	{
+		NazaraUnused(renderFrame);
+		NazaraUnused(builder);
+		NazaraUnused(worldInstance);
+		NazaraUnused(simulationData);
+	}
 }
@@ -8,4 +8,21 @@
 namespace Nz
 {
 	LightShadowData::~LightShadowData() = default;
+
+	/*!
+	* \brief Fills the viewer-dependent shadow parameters of a light UBO entry (after Light::FillLightData)
+	*
+	* Does nothing by default, as most lights store their shadow parameters in the light itself.
+	*/
+	void LightShadowData::FillShadowData(void* /*data*/, const AbstractViewer* /*viewer*/) const
+	{
+	}
+
+	void LightShadowData::RegisterViewer(const AbstractViewer* /*viewer*/)
+	{
+	}
+
+	void LightShadowData::UnregisterViewer(RenderFrame& /*renderFrame*/, const AbstractViewer* /*viewer*/)
+	{
+	}
 }
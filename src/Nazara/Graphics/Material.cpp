@@ -4,10 +4,12 @@
 
 #include <Nazara/Graphics/Material.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Graphics/BindlessTextureTable.hpp>
 #include <Nazara/Graphics/Graphics.hpp>
 #include <Nazara/Graphics/MaterialInstance.hpp>
 #include <Nazara/Graphics/PredefinedShaderStructs.hpp>
 #include <NZSL/Ast/SanitizeVisitor.hpp>
+#include <stdexcept>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
@@ -32,18 +34,53 @@ namespace Nz
 
 		const std::shared_ptr<RenderDevice>& renderDevice = graphics->GetRenderDevice();
 
+		// Forward lighting reads lights from the clusters built by ForwardPipelinePass, which requires compute shaders and storage buffers
+		bool clusteredLighting = graphics->IsClusteredLightingEnabled();
+
+		// Instanced submeshes culled by SubmeshRenderer read their instances from the storage buffer filled by the culling pass
+		bool instanceDataStorage = graphics->IsGpuDrivenRenderingEnabled();
+
+		// Materials declaring the bindless texture table sample their textures from it
+		bool bindlessTextures = graphics->IsBindlessTexturingEnabled();
+
 		nzsl::Ast::SanitizeVisitor::Options options;
 		options.forceAutoBindingResolve = true;
 		options.partialSanitization = true;
 		options.moduleResolver = graphics->GetShaderModuleResolver();
-		options.optionValues[CRC32("MaxLightCount")] = SafeCast<UInt32>(PredefinedLightData::MaxLightCount);
+		options.optionValues[CRC32("BindlessTextures")] = bindlessTextures;
+		options.optionValues[CRC32("ClusteredLighting")] = clusteredLighting;
+		options.optionValues[CRC32("InstanceDataStorage")] = instanceDataStorage;
+		options.optionValues[CRC32("MaxBindlessTextureCount")] = BindlessTextureTable::MaxTextureCount;
+		options.optionValues[CRC32("MaxShadowedLightCount")] = SafeCast<UInt32>(PredefinedLightData::MaxShadowedLightCount);
 		options.optionValues[CRC32("MaxJointCount")] = SafeCast<UInt32>(PredefinedSkeletalData::MaxMatricesCount);
 
 		nzsl::Ast::ModulePtr sanitizedModule = nzsl::Ast::Sanitize(*referenceModule, options);
 
 		m_reflection.Reflect(*sanitizedModule);
 
-		m_renderPipelineLayout = renderDevice->InstantiateRenderPipelineLayout(m_reflection.GetPipelineLayoutInfo());
+		RenderPipelineLayoutInfo pipelineLayoutInfo = m_reflection.GetPipelineLayoutInfo();
+
+		// Only declared when bindless textures are enabled, the table binding must match the table layout for its shader binding to be bound with the material layout
+		if (const ShaderReflection::ExternalBlockData* block = m_reflection.GetExternalBlockByTag("EngineBindless"))
+		{
+			auto it = block->samplers.find("TextureTable");
+			if (it == block->samplers.end())
+				throw std::runtime_error("EngineBindless block has no TextureTable sampler");
+
+			RenderPipelineLayoutInfo::Binding tableBinding = BindlessTextureTable::GetBindingInfo();
+			for (auto& binding : pipelineLayoutInfo.bindings)
+			{
+				if (binding.setIndex != it->second.bindingSet || binding.bindingIndex != it->second.bindingIndex)
+					continue;
+
+				if (binding.setIndex != tableBinding.setIndex || binding.bindingIndex != tableBinding.bindingIndex || binding.arraySize != tableBinding.arraySize)
+					throw std::runtime_error("TextureTable must be an array of " + std::to_string(tableBinding.arraySize) + " samplers bound to set " + std::to_string(tableBinding.setIndex) + ", binding " + std::to_string(tableBinding.bindingIndex));
+
+				binding = tableBinding;
+			}
+		}
+
+		m_renderPipelineLayout = renderDevice->InstantiateRenderPipelineLayout(std::move(pipelineLayoutInfo));
 
 		if (const ShaderReflection::ExternalBlockData* block = m_reflection.GetExternalBlockByTag("Material"))
 		{
@@ -55,6 +92,7 @@ namespace Nz
 				texture.bindingIndex = shaderSampler.bindingIndex;
 				texture.bindingSet = shaderSampler.bindingSet;
 				texture.imageType = ToImageType(shaderSampler.imageType);
+				texture.bindlessIndexOffset = InvalidIndex;
 
 				m_textureByTag.emplace(tag, textureIndex);
 			}
@@ -80,31 +118,88 @@ namespace Nz
 			}
 		}
 
+		// Only declared with the texture table, textures whose slot is stored in the index buffer are sampled from the table instead of being bound
+		if (const ShaderReflection::ExternalBlockData* block = m_reflection.GetExternalBlockByTag("MaterialBindless"))
+		{
+			auto it = block->storageBlocks.find("TextureIndices");
+			if (it == block->storageBlocks.end())
+				throw std::runtime_error("MaterialBindless block has no TextureIndices storage buffer");
+
+			const ShaderReflection::StructData* structData = m_reflection.GetStructByIndex(it->second.structIndex);
+			assert(structData);
+
+			for (const auto& [tag, member] : structData->members)
+			{
+				std::size_t textureIndex = FindTextureByTag(tag);
+				if (textureIndex == InvalidIndex)
+					throw std::runtime_error("texture index " + tag + " doesn't match any material texture");
+
+				auto& texture = m_textures[textureIndex];
+				if (texture.imageType != ImageType::E2D)
+					throw std::runtime_error("texture " + tag + " can't be sampled from the bindless texture table (only 2D textures can)");
+
+				texture.bindlessIndexOffset = member.offset;
+			}
+
+			m_textureIndexBuffer.bindingIndex = it->second.bindingIndex;
+			m_textureIndexBuffer.bindingSet = it->second.bindingSet;
+			m_textureIndexBuffer.bufferPool = std::make_unique<RenderBufferPool>(renderDevice, BufferType::Storage, structData->fieldOffsets.GetAlignedSize());
+		}
+
 		m_engineShaderBindings.fill(InvalidBindingIndex);
 		if (const ShaderReflection::ExternalBlockData* block = m_reflection.GetExternalBlockByTag("Engine"))
 		{
 			// TODO: Ensure structs layout is what's expected
 
+			if (auto it = block->samplers.find("AnimationTexture"); it != block->samplers.end())
+				m_engineShaderBindings[EngineShaderBinding::AnimationTexture] = it->second.bindingIndex;
+
+			if (auto it = block->uniformBlocks.find("InstanceAnimationDataArray"); it != block->uniformBlocks.end())
+				m_engineShaderBindings[EngineShaderBinding::InstanceAnimationDataArrayUbo] = it->second.bindingIndex;
+
 			if (auto it = block->uniformBlocks.find("InstanceData"); it != block->uniformBlocks.end())
 				m_engineShaderBindings[EngineShaderBinding::InstanceDataUbo] = it->second.bindingIndex;
 
-			if (auto it = block->uniformBlocks.find("LightData"); it != block->uniformBlocks.end())
-				m_engineShaderBindings[EngineShaderBinding::LightDataUbo] = it->second.bindingIndex;
+			if (auto it = block->uniformBlocks.find("InstanceDataArray"); it != block->uniformBlocks.end())
+				m_engineShaderBindings[EngineShaderBinding::InstanceDataArrayUbo] = it->second.bindingIndex;
 
 			if (auto it = block->uniformBlocks.find("ViewerData"); it != block->uniformBlocks.end())
 				m_engineShaderBindings[EngineShaderBinding::ViewerDataUbo] = it->second.bindingIndex;
 
+			if (auto it = block->uniformBlocks.find("SkeletalData"); it != block->uniformBlocks.end())
+				m_engineShaderBindings[EngineShaderBinding::SkeletalDataUbo] = it->second.bindingIndex;
+
+			if (auto it = block->samplers.find("TextureOverlay"); it != block->samplers.end())
+				m_engineShaderBindings[EngineShaderBinding::OverlayTexture] = it->second.bindingIndex;
+		}
+
+		// Only declared when GPU-driven rendering is enabled
+		if (const ShaderReflection::ExternalBlockData* block = m_reflection.GetExternalBlockByTag("EngineInstancing"))
+		{
+			if (auto it = block->storageBlocks.find("InstanceDataBuffer"); it != block->storageBlocks.end())
+				m_engineShaderBindings[EngineShaderBinding::InstanceDataArraySsbo] = it->second.bindingIndex;
+		}
+
+		// Only declared by lit materials when clustered lighting is enabled
+		if (const ShaderReflection::ExternalBlockData* block = m_reflection.GetExternalBlockByTag("EngineLighting"))
+		{
+			if (auto it = block->storageBlocks.find("LightArray"); it != block->storageBlocks.end())
+				m_engineShaderBindings[EngineShaderBinding::LightArraySsbo] = it->second.bindingIndex;
+
+			if (auto it = block->storageBlocks.find("LightClusters"); it != block->storageBlocks.end())
+				m_engineShaderBindings[EngineShaderBinding::LightClusterSsbo] = it->second.bindingIndex;
+
+			if (auto it = block->uniformBlocks.find("LightData"); it != block->uniformBlocks.end())
+				m_engineShaderBindings[EngineShaderBinding::LightDataUbo] = it->second.bindingIndex;
+
 			if (auto it = block->samplers.find("ShadowMaps2D"); it != block->samplers.end())
 				m_engineShaderBindings[EngineShaderBinding::Shadowmap2D] = it->second.bindingIndex;
 
 			if (auto it = block->samplers.find("ShadowMapsCube"); it != block->samplers.end())
 				m_engineShaderBindings[EngineShaderBinding::ShadowmapCube] = it->second.bindingIndex;
 
-			if (auto it = block->uniformBlocks.find("SkeletalData"); it != block->uniformBlocks.end())
-				m_engineShaderBindings[EngineShaderBinding::SkeletalDataUbo] = it->second.bindingIndex;
-
-			if (auto it = block->samplers.find("TextureOverlay"); it != block->samplers.end())
-				m_engineShaderBindings[EngineShaderBinding::OverlayTexture] = it->second.bindingIndex;
+			if (auto it = block->samplers.find("ShadowMapsDirectional"); it != block->samplers.end())
+				m_engineShaderBindings[EngineShaderBinding::ShadowmapDirectional] = it->second.bindingIndex;
 		}
 
 		for (const auto& handlerPtr : m_settings.GetPropertyHandlers())
@@ -119,12 +214,23 @@ namespace Nz
 			{
 				uberShader->UpdateConfigCallback([=](UberShader::Config& config, const std::vector<RenderPipelineInfo::VertexBufferData>& vertexBuffers)
 				{
+					// Must match the pipeline layout
+					config.optionValues[CRC32("BindlessTextures")] = bindlessTextures;
+					config.optionValues[CRC32("ClusteredLighting")] = clusteredLighting;
+					config.optionValues[CRC32("InstanceDataStorage")] = instanceDataStorage;
+
 					if (vertexBuffers.empty())
 						return;
 
 					const VertexDeclaration& vertexDeclaration = *vertexBuffers.front().declaration;
 					const auto& components = vertexDeclaration.GetComponents();
 
+					// Normals and tangents with two components are octahedral-encoded (see EncodeOctahedral) and decoded by the shaders
+					auto IsOctahedral = [](ComponentType componentType)
+					{
+						return componentType == ComponentType::Float2 || componentType == ComponentType::Half2 || componentType == ComponentType::SNorm16x2;
+					};
+
 					Int32 locationIndex = 0;
 					for (const auto& component : components)
 					{
@@ -136,6 +242,7 @@ namespace Nz
 
 							case VertexComponent::Normal:
 								config.optionValues[CRC32("VertexNormalLoc")] = locationIndex;
+								config.optionValues[CRC32("VertexNormalOctahedral")] = IsOctahedral(component.type);
 								break;
 
 							case VertexComponent::Position:
@@ -144,6 +251,7 @@ namespace Nz
 
 							case VertexComponent::Tangent:
 								config.optionValues[CRC32("VertexTangentLoc")] = locationIndex;
+								config.optionValues[CRC32("VertexTangentOctahedral")] = IsOctahedral(component.type);
 								break;
 
 							case VertexComponent::TexCoord:
@@ -3,13 +3,11 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Graphics/MaterialInstance.hpp>
+#include <Nazara/Graphics/BindlessTextureTable.hpp>
 #include <Nazara/Graphics/Graphics.hpp>
 #include <Nazara/Graphics/Material.hpp>
 #include <Nazara/Graphics/MaterialPass.hpp>
 #include <Nazara/Graphics/MaterialPipeline.hpp>
-#include <Nazara/Renderer/CommandBufferBuilder.hpp>
-#include <Nazara/Renderer/RenderFrame.hpp>
-#include <Nazara/Renderer/UploadPool.hpp>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
@@ -69,7 +67,17 @@ namespace Nz
 
 			auto& uniformBuffer = m_uniformBuffers[i];
 			uniformBuffer.bufferView = uniformBlockData.bufferPool->Allocate(uniformBuffer.bufferIndex);
-			uniformBuffer.values.resize(uniformBlockData.bufferPool->GetBufferSize());
+		}
+
+		if (m_parent->HasBindlessTextures())
+		{
+			m_bindlessTextureTable = Graphics::Instance()->GetBindlessTextureTable();
+			m_bindlessTextureSlots.resize(m_textureBinding.size(), BindlessTextureTable::InvalidSlot);
+			m_textureIndexBuffer.bufferView = m_parent->GetTextureIndexBufferData().bufferPool->Allocate(m_textureIndexBuffer.bufferIndex);
+
+			// Textures which aren't set by property handlers sample the default texture
+			for (std::size_t i = 0; i < m_textureBinding.size(); ++i)
+				UpdateBindlessTextureSlot(i);
 		}
 
 		for (const auto& handler : m_materialSettings.GetPropertyHandlers())
@@ -109,8 +117,20 @@ namespace Nz
 
 			auto& uniformBuffer = m_uniformBuffers[i];
 			uniformBuffer.bufferView = uniformBlockData.bufferPool->Allocate(uniformBuffer.bufferIndex);
-			assert(material.m_uniformBuffers[i].values.size() == uniformBlockData.bufferPool->GetBufferSize());
-			uniformBuffer.values = material.m_uniformBuffers[i].values;
+
+			RenderBufferPool& bufferPool = *uniformBlockData.bufferPool;
+			bufferPool.Update(uniformBuffer.bufferIndex, 0, bufferPool.GetBufferSize(), bufferPool.GetEntryData(material.m_uniformBuffers[i].bufferIndex));
+		}
+
+		if (m_parent->HasBindlessTextures())
+		{
+			m_bindlessTextureTable = material.m_bindlessTextureTable;
+			m_bindlessTextureSlots.resize(m_textureBinding.size(), BindlessTextureTable::InvalidSlot);
+			m_textureIndexBuffer.bufferView = m_parent->GetTextureIndexBufferData().bufferPool->Allocate(m_textureIndexBuffer.bufferIndex);
+
+			// Registers the same textures again, which gives the copy its own references to the same slots
+			for (std::size_t i = 0; i < m_textureBinding.size(); ++i)
+				UpdateBindlessTextureSlot(i);
 		}
 	}
 
@@ -121,6 +141,17 @@ namespace Nz
 			auto& uniformBuffer = m_uniformBuffers[i];
 			m_parent->GetUniformBlockData(i).bufferPool->Free(uniformBuffer.bufferIndex);
 		}
+
+		if (m_parent->HasBindlessTextures())
+		{
+			for (UInt32 slot : m_bindlessTextureSlots)
+			{
+				if (slot != BindlessTextureTable::InvalidSlot)
+					m_bindlessTextureTable->Unregister(slot);
+			}
+
+			m_parent->GetTextureIndexBufferData().bufferPool->Free(m_textureIndexBuffer.bufferIndex);
+		}
 	}
 
 	void MaterialInstance::DisablePass(std::string_view passName)
@@ -143,6 +174,9 @@ namespace Nz
 		for (std::size_t i = 0; i < m_textureBinding.size(); ++i)
 		{
 			const auto& textureSlot = m_parent->GetTextureData(i);
+			if (textureSlot.bindlessIndexOffset != Material::InvalidIndex)
+				continue; //< sampled from the bindless texture table
+
 			const auto& textureBinding = m_textureBinding[i];
 
 			const std::shared_ptr<Texture>& texture = (textureBinding.texture) ? textureBinding.texture : defaultTextures.whiteTextures[textureSlot.imageType];
@@ -169,6 +203,17 @@ namespace Nz
 				}
 			});
 		}
+
+		// Bindless texture indices
+		if (m_parent->HasBindlessTextures())
+		{
+			bindings.push_back({
+				m_parent->GetTextureIndexBufferData().bindingIndex,
+				ShaderBinding::StorageBufferBinding {
+					m_textureIndexBuffer.bufferView.GetBuffer(), m_textureIndexBuffer.bufferView.GetOffset(), m_textureIndexBuffer.bufferView.GetSize()
+				}
+			});
+		}
 	}
 
 	const std::shared_ptr<MaterialPipeline>& MaterialInstance::GetPipeline(std::size_t passIndex) const
@@ -226,19 +271,12 @@ namespace Nz
 
 	void MaterialInstance::OnTransfer(RenderFrame& renderFrame, CommandBufferBuilder& builder)
 	{
-		UploadPool& uploadPool = renderFrame.GetUploadPool();
-		for (UniformBuffer& uniformBuffer : m_uniformBuffers)
-		{
-			if (!uniformBuffer.dataInvalidated)
-				continue;
-
-			auto& allocation = uploadPool.Allocate(uniformBuffer.values.size());
-			std::memcpy(allocation.mappedPtr, uniformBuffer.values.data(), uniformBuffer.values.size());
-
-			builder.CopyBuffer(allocation, uniformBuffer.bufferView);
+		// Uniform buffers are shared by all instances of the material, the first instance to be transferred uploads every instance update at once
+		for (std::size_t i = 0; i < m_uniformBuffers.size(); ++i)
+			m_parent->GetUniformBlockData(i).bufferPool->OnTransfer(renderFrame, builder);
 
-			uniformBuffer.dataInvalidated = false;
-		}
+		if (m_parent->HasBindlessTextures())
+			m_parent->GetTextureIndexBufferData().bufferPool->OnTransfer(renderFrame, builder);
 	}
 
 	void MaterialInstance::UpdatePassFlags(std::string_view passName, MaterialPassFlags materialFlags)
@@ -330,17 +368,19 @@ namespace Nz
 		binding.texture = std::move(texture);
 		binding.sampler = std::move(textureSampler);
 
-		InvalidateShaderBinding();
+		// Textures sampled from the bindless texture table only change the content of the texture index buffer, the shader binding stays valid
+		if (m_parent->GetTextureData(textureBinding).bindlessIndexOffset != Material::InvalidIndex)
+			UpdateBindlessTextureSlot(textureBinding);
+		else
+			InvalidateShaderBinding();
 	}
 
 	void MaterialInstance::UpdateUniformBufferData(std::size_t uniformBufferIndex, std::size_t offset, std::size_t size, const void* data)
 	{
 		assert(uniformBufferIndex < m_uniformBuffers.size());
 		auto& uniformBlock = m_uniformBuffers[uniformBufferIndex];
-		uniformBlock.dataInvalidated = true;
 
-		assert(offset + size <= uniformBlock.values.size());
-		std::memcpy(&uniformBlock.values[offset], data, size);
+		m_parent->GetUniformBlockData(uniformBufferIndex).bufferPool->Update(uniformBlock.bufferIndex, offset, size, data);
 
 		OnTransferRequired(this);
 	}
@@ -381,4 +421,30 @@ namespace Nz
 	{
 		return GetDefault(materialType, preset)->Clone();
 	}
+
+	void MaterialInstance::UpdateBindlessTextureSlot(std::size_t textureIndex)
+	{
+		const auto& textureSlot = m_parent->GetTextureData(textureIndex);
+		if (textureSlot.bindlessIndexOffset == Material::InvalidIndex)
+			return;
+
+		Graphics* graphics = Graphics::Instance();
+		const auto& textureBinding = m_textureBinding[textureIndex];
+
+		std::shared_ptr<Texture> texture = (textureBinding.texture) ? textureBinding.texture : graphics->GetDefaultTextures().whiteTextures[ImageType::E2D];
+		std::shared_ptr<TextureSampler> sampler = (textureBinding.sampler) ? textureBinding.sampler : graphics->GetSamplerCache().Get({});
+
+		// Registering before releasing the previous slot keeps it if the texture and sampler didn't change
+		UInt32 slot = m_bindlessTextureTable->Register(std::move(texture), std::move(sampler));
+
+		UInt32& currentSlot = m_bindlessTextureSlots[textureIndex];
+		if (currentSlot != BindlessTextureTable::InvalidSlot)
+			m_bindlessTextureTable->Unregister(currentSlot);
+
+		currentSlot = slot;
+
+		m_parent->GetTextureIndexBufferData().bufferPool->Update(m_textureIndexBuffer.bufferIndex, textureSlot.bindlessIndexOffset, sizeof(UInt32), &slot);
+
+		OnTransferRequired(this);
+	}
 }
@@ -3,11 +3,14 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Graphics/MaterialPipeline.hpp>
+#include <Nazara/Core/Core.hpp>
+#include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/File.hpp>
 #include <Nazara/Core/Log.hpp>
 #include <Nazara/Graphics/Graphics.hpp>
 #include <Nazara/Graphics/MaterialPass.hpp>
 #include <Nazara/Graphics/UberShader.hpp>
+#include <algorithm>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
@@ -19,57 +22,128 @@ namespace Nz
 	* \brief Graphics class used to contains all rendering states that are not allowed to change individually on rendering devices
 	*/
 
+	/*!
+	* \brief Retrieve (and generate if required) an instanced pipeline instance
+	*
+	* Instanced pipelines are built with the Instancing option enabled, their shaders fetch world matrices from the InstanceDataArray engine binding using the instance index
+	*
+	* \param vertexBuffers Vertex buffers description
+	* \param vertexBufferCount Vertex buffer count
+	*
+	* \return Pipeline instance, or a null pointer if the shaders don't support instancing
+	*
+	* \see SupportsInstancing
+	*/
+	const std::shared_ptr<RenderPipeline>& MaterialPipeline::GetInstancedRenderPipeline(const RenderPipelineInfo::VertexBufferData* vertexBuffers, std::size_t vertexBufferCount) const
+	{
+		static const std::shared_ptr<RenderPipeline> noPipeline;
+		if (!SupportsInstancing())
+			return noPipeline;
+
+		if (const std::shared_ptr<RenderPipeline>* pipeline = FindRenderPipeline(m_instancedRenderPipelines, vertexBuffers, vertexBufferCount))
+			return *pipeline;
+
+		if (const std::shared_ptr<PrewarmedPipeline>* prewarmedPipeline = FindPrewarmedPipeline(vertexBuffers, vertexBufferCount, true))
+			return FinalizePrewarmedPipeline(*prewarmedPipeline);
+
+		return m_instancedRenderPipelines.emplace_back(BuildRenderPipeline(vertexBuffers, vertexBufferCount, true));
+	}
+
 	/*!
 	* \brief Retrieve (and generate if required) a pipeline instance using shader flags without applying it
 	*
+	* If the pipeline is being prewarmed, this waits for its shaders to be compiled instead of compiling them a second time
+	*
 	* \param flags Shader flags
 	*
 	* \return Pipeline instance
+	*
+	* \see IsPrewarming
 	*/
 	const std::shared_ptr<RenderPipeline>& MaterialPipeline::GetRenderPipeline(const RenderPipelineInfo::VertexBufferData* vertexBuffers, std::size_t vertexBufferCount) const
 	{
-		for (const auto& pipeline : m_renderPipelines)
-		{
-			const auto& pipelineInfo = pipeline->GetPipelineInfo();
-			if (pipelineInfo.vertexBuffers.size() != vertexBufferCount)
-				continue;
+		if (const std::shared_ptr<RenderPipeline>* pipeline = FindRenderPipeline(m_renderPipelines, vertexBuffers, vertexBufferCount))
+			return *pipeline;
 
-			bool isEqual = std::equal(pipelineInfo.vertexBuffers.begin(), pipelineInfo.vertexBuffers.end(), vertexBuffers, [](const auto& v1, const auto& v2)
-			{
-				return v1.binding == v2.binding && v1.declaration == v2.declaration;
-			});
+		if (const std::shared_ptr<PrewarmedPipeline>* prewarmedPipeline = FindPrewarmedPipeline(vertexBuffers, vertexBufferCount, false))
+			return FinalizePrewarmedPipeline(*prewarmedPipeline);
 
-			if (isEqual)
-				return pipeline;
-		}
+		return m_renderPipelines.emplace_back(BuildRenderPipeline(vertexBuffers, vertexBufferCount, false));
+	}
 
-		RenderPipelineInfo renderPipelineInfo;
-		static_cast<RenderStates&>(renderPipelineInfo) = m_pipelineInfo;
+	/*!
+	* \brief Checks if the shaders of a pipeline are still being compiled by a prewarm task
+	* \return True if retrieving the pipeline right now would block until its shaders are compiled
+	*
+	* Renderables can use this to render with a fallback material until the pipeline is ready, OnRenderPipelineReady is then triggered on the render thread by ProcessPrewarmedPipelines
+	*
+	* \param vertexBuffers Vertex buffers description
+	* \param vertexBufferCount Vertex buffer count
+	* \param instancing Instanced pipeline instead of the regular one
+	*/
+	bool MaterialPipeline::IsPrewarming(const RenderPipelineInfo::VertexBufferData* vertexBuffers, std::size_t vertexBufferCount, bool instancing) const
+	{
+		const std::shared_ptr<PrewarmedPipeline>* prewarmedPipeline = FindPrewarmedPipeline(vertexBuffers, vertexBufferCount, instancing);
+		return prewarmedPipeline && !(*prewarmedPipeline)->task.IsFinished();
+	}
 
-		renderPipelineInfo.pipelineLayout = m_pipelineInfo.pipelineLayout;
+	/*!
+	* \brief Starts compiling the shaders of a pipeline on the task scheduler workers
+	* \return Handle to the compilation task (invalid if the pipeline is already available)
+	*
+	* Only the shader variants are compiled on the workers, the backend pipeline is instantiated on the render thread once they're ready (as some backends require a context bound to the thread)
+	*
+	* \param vertexBuffers Vertex buffers description
+	* \param vertexBufferCount Vertex buffer count
+	* \param instancing Prewarm the instanced pipeline instead of the regular one
+	*
+	* \remark This must be called from the render thread
+	*/
+	TaskScheduler::TaskHandle MaterialPipeline::Prewarm(const RenderPipelineInfo::VertexBufferData* vertexBuffers, std::size_t vertexBufferCount, bool instancing) const
+	{
+		if (instancing && !SupportsInstancing())
+			return {};
 
-		std::unordered_map<UInt32, nzsl::Ast::ConstantSingleValue> optionValues;
-		for (std::size_t i = 0; i < m_pipelineInfo.optionValues.size(); ++i)
-		{
-			const auto& option = m_pipelineInfo.optionValues[i];
+		if (FindRenderPipeline((instancing) ? m_instancedRenderPipelines : m_renderPipelines, vertexBuffers, vertexBufferCount))
+			return {};
 
-			optionValues[option.hash] = option.value;
-		}
+		if (const std::shared_ptr<PrewarmedPipeline>* prewarmedPipeline = FindPrewarmedPipeline(vertexBuffers, vertexBufferCount, instancing))
+			return (*prewarmedPipeline)->task;
 
-		renderPipelineInfo.vertexBuffers.assign(vertexBuffers, vertexBuffers + vertexBufferCount);
+		std::shared_ptr<PrewarmedPipeline> prewarmedPipeline = std::make_shared<PrewarmedPipeline>();
+		prewarmedPipeline->instancing = instancing;
+		prewarmedPipeline->failed = false;
+		prewarmedPipeline->pipelineInfo = BuildPipelineInfo(vertexBuffers, vertexBufferCount);
 
-		for (const auto& shader : m_pipelineInfo.shaders)
+		prewarmedPipeline->task = Core::Instance()->GetTaskScheduler().AddTask([this, prewarmedPipeline]
 		{
-			if (shader.uberShader)
+			try
 			{
-				UberShader::Config config{ optionValues };
-				shader.uberShader->UpdateConfig(config, renderPipelineInfo.vertexBuffers);
-
-				renderPipelineInfo.shaderModules.push_back(shader.uberShader->Get(config));
+				BuildShaderModules(prewarmedPipeline->pipelineInfo, prewarmedPipeline->instancing);
 			}
-		}
+			catch (const std::exception& e)
+			{
+				NazaraError("failed to prewarm pipeline: {0}", e.what());
+				prewarmedPipeline->failed = true;
+			}
+		});
+
+		if (m_prewarmedPipelines.empty())
+			s_prewarmingPipelines.push_back(this);
 
-		return m_renderPipelines.emplace_back(Graphics::Instance()->GetRenderDevice()->InstantiateRenderPipeline(std::move(renderPipelineInfo)));
+		return m_prewarmedPipelines.emplace_back(std::move(prewarmedPipeline))->task;
+	}
+
+	/*!
+	* \brief Checks if the shaders of this pipeline can be used for instanced rendering
+	* \return True if at least one of the shaders has an Instancing option
+	*/
+	bool MaterialPipeline::SupportsInstancing() const
+	{
+		return std::any_of(m_pipelineInfo.shaders.begin(), m_pipelineInfo.shaders.end(), [](const MaterialPipelineInfo::Shader& shader)
+		{
+			return shader.uberShader && shader.uberShader->HasOption("Instancing");
+		});
 	}
 
 	/*!
@@ -88,6 +162,45 @@ namespace Nz
 		return it->second;
 	}
 
+	/*!
+	* \brief Starts compiling a list of pipelines on the task scheduler workers
+	* \return Handles to the compilation tasks, which can be waited on to know when loading is over
+	*
+	* This is meant to be called during loading with the pipelines used in a previous run, to prevent compiling them on the render thread when they're first used
+	*
+	* \param prewarmInfos Material pipelines and vertex layouts to compile
+	*
+	* \remark This must be called from the render thread
+	*/
+	std::vector<TaskScheduler::TaskHandle> MaterialPipeline::Prewarm(const std::vector<MaterialPipelinePrewarmInfo>& prewarmInfos)
+	{
+		std::vector<TaskScheduler::TaskHandle> tasks;
+		tasks.reserve(prewarmInfos.size());
+
+		for (const MaterialPipelinePrewarmInfo& prewarmInfo : prewarmInfos)
+		{
+			TaskScheduler::TaskHandle task = Get(prewarmInfo.pipelineInfo)->Prewarm(prewarmInfo.vertexBuffers.data(), prewarmInfo.vertexBuffers.size(), prewarmInfo.instancing);
+			if (task.IsValid())
+				tasks.push_back(std::move(task));
+		}
+
+		return tasks;
+	}
+
+	/*!
+	* \brief Instantiates the prewarmed pipelines whose shaders are compiled and triggers their OnRenderPipelineReady signal
+	*
+	* \remark This must be called from the render thread (frame pipelines call it once per frame)
+	*/
+	void MaterialPipeline::ProcessPrewarmedPipelines()
+	{
+		auto it = std::remove_if(s_prewarmingPipelines.begin(), s_prewarmingPipelines.end(), [](const MaterialPipeline* materialPipeline)
+		{
+			return !materialPipeline->ProcessPrewarmedPipeline();
+		});
+		s_prewarmingPipelines.erase(it, s_prewarmingPipelines.end());
+	}
+
 	bool MaterialPipeline::Initialize()
 	{
 		/*BasicMaterialPass::Initialize();
@@ -100,6 +213,11 @@ namespace Nz
 
 	void MaterialPipeline::Uninitialize()
 	{
+		// Prewarm tasks reference their material pipeline
+		for (const MaterialPipeline* materialPipeline : s_prewarmingPipelines)
+			materialPipeline->WaitForPrewarmedPipelines();
+
+		s_prewarmingPipelines.clear();
 		s_pipelineCache.clear();
 		/*PhysicallyBasedMaterialPass::Uninitialize();
 		PhongLightingMaterialPass::Uninitialize();
@@ -107,5 +225,131 @@ namespace Nz
 		BasicMaterialPass::Uninitialize();*/
 	}
 
+	RenderPipelineInfo MaterialPipeline::BuildPipelineInfo(const RenderPipelineInfo::VertexBufferData* vertexBuffers, std::size_t vertexBufferCount) const
+	{
+		RenderPipelineInfo renderPipelineInfo;
+		static_cast<RenderStates&>(renderPipelineInfo) = m_pipelineInfo;
+
+		renderPipelineInfo.pipelineLayout = m_pipelineInfo.pipelineLayout;
+		renderPipelineInfo.vertexBuffers.assign(vertexBuffers, vertexBuffers + vertexBufferCount);
+
+		return renderPipelineInfo;
+	}
+
+	std::shared_ptr<RenderPipeline> MaterialPipeline::BuildRenderPipeline(const RenderPipelineInfo::VertexBufferData* vertexBuffers, std::size_t vertexBufferCount, bool instancing) const
+	{
+		RenderPipelineInfo renderPipelineInfo = BuildPipelineInfo(vertexBuffers, vertexBufferCount);
+		BuildShaderModules(renderPipelineInfo, instancing);
+
+		return Graphics::Instance()->GetRenderDevice()->InstantiateRenderPipeline(std::move(renderPipelineInfo));
+	}
+
+	void MaterialPipeline::BuildShaderModules(RenderPipelineInfo& renderPipelineInfo, bool instancing) const
+	{
+		std::unordered_map<UInt32, nzsl::Ast::ConstantSingleValue> optionValues;
+		for (std::size_t i = 0; i < m_pipelineInfo.optionValues.size(); ++i)
+		{
+			const auto& option = m_pipelineInfo.optionValues[i];
+
+			optionValues[option.hash] = option.value;
+		}
+
+		if (instancing)
+			optionValues[CRC32("Instancing")] = true;
+
+		for (const auto& shader : m_pipelineInfo.shaders)
+		{
+			if (shader.uberShader)
+			{
+				UberShader::Config config{ optionValues };
+				shader.uberShader->UpdateConfig(config, renderPipelineInfo.vertexBuffers);
+
+				renderPipelineInfo.shaderModules.push_back(shader.uberShader->Get(config));
+			}
+		}
+	}
+
+	auto MaterialPipeline::FindPrewarmedPipeline(const RenderPipelineInfo::VertexBufferData* vertexBuffers, std::size_t vertexBufferCount, bool instancing) const -> const std::shared_ptr<PrewarmedPipeline>*
+	{
+		for (const auto& prewarmedPipeline : m_prewarmedPipelines)
+		{
+			if (prewarmedPipeline->instancing == instancing && IsEqual(prewarmedPipeline->pipelineInfo.vertexBuffers, vertexBuffers, vertexBufferCount))
+				return &prewarmedPipeline;
+		}
+
+		return nullptr;
+	}
+
+	const std::shared_ptr<RenderPipeline>& MaterialPipeline::FinalizePrewarmedPipeline(std::shared_ptr<PrewarmedPipeline> prewarmedPipeline) const
+	{
+		Core::Instance()->GetTaskScheduler().WaitFor(prewarmedPipeline->task);
+
+		m_prewarmedPipelines.erase(std::find(m_prewarmedPipelines.begin(), m_prewarmedPipelines.end(), prewarmedPipeline));
+
+		RenderPipelineInfo& renderPipelineInfo = prewarmedPipeline->pipelineInfo;
+
+		std::shared_ptr<RenderPipeline> renderPipeline;
+		if (prewarmedPipeline->failed)
+		{
+			// Try again on this thread to report the error the same way as if the pipeline hadn't been prewarmed
+			renderPipeline = BuildRenderPipeline(renderPipelineInfo.vertexBuffers.data(), renderPipelineInfo.vertexBuffers.size(), prewarmedPipeline->instancing);
+		}
+		else
+			renderPipeline = Graphics::Instance()->GetRenderDevice()->InstantiateRenderPipeline(std::move(renderPipelineInfo));
+
+		auto& renderPipelines = (prewarmedPipeline->instancing) ? m_instancedRenderPipelines : m_renderPipelines;
+		return renderPipelines.emplace_back(std::move(renderPipeline));
+	}
+
+	bool MaterialPipeline::ProcessPrewarmedPipeline() const
+	{
+		bool hasReadyPipeline = false;
+		for (std::size_t i = 0; i < m_prewarmedPipelines.size();)
+		{
+			if (m_prewarmedPipelines[i]->task.IsFinished())
+			{
+				FinalizePrewarmedPipeline(m_prewarmedPipelines[i]);
+				hasReadyPipeline = true;
+			}
+			else
+				++i;
+		}
+
+		if (hasReadyPipeline)
+			OnRenderPipelineReady(this);
+
+		return !m_prewarmedPipelines.empty();
+	}
+
+	void MaterialPipeline::WaitForPrewarmedPipelines() const
+	{
+		TaskScheduler& taskScheduler = Core::Instance()->GetTaskScheduler();
+		for (const auto& prewarmedPipeline : m_prewarmedPipelines)
+			taskScheduler.WaitFor(prewarmedPipeline->task);
+	}
+
+	const std::shared_ptr<RenderPipeline>* MaterialPipeline::FindRenderPipeline(const std::vector<std::shared_ptr<RenderPipeline>>& renderPipelines, const RenderPipelineInfo::VertexBufferData* vertexBuffers, std::size_t vertexBufferCount)
+	{
+		for (const auto& pipeline : renderPipelines)
+		{
+			if (IsEqual(pipeline->GetPipelineInfo().vertexBuffers, vertexBuffers, vertexBufferCount))
+				return &pipeline;
+		}
+
+		return nullptr;
+	}
+
+	bool MaterialPipeline::IsEqual(const std::vector<RenderPipelineInfo::VertexBufferData>& lhs, const RenderPipelineInfo::VertexBufferData* vertexBuffers, std::size_t vertexBufferCount)
+	{
+		if (lhs.size() != vertexBufferCount)
+			return false;
+
+		return std::equal(lhs.begin(), lhs.end(), vertexBuffers, [](const auto& v1, const auto& v2)
+		{
+			return v1.binding == v2.binding && v1.declaration == v2.declaration;
+		});
+	}
+
 	MaterialPipeline::PipelineCache MaterialPipeline::s_pipelineCache;
+	std::vector<const MaterialPipeline*> MaterialPipeline::s_prewarmingPipelines;
 }
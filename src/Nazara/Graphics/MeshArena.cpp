@@ -0,0 +1,169 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/MeshArena.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Renderer/RenderDevice.hpp>
+#include <Nazara/Utility/VertexDeclaration.hpp>
+#include <algorithm>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Constructs an arena
+	*
+	* \param renderDevice Device on which buffers are created
+	* \param blockSize Size of every buffer, bigger allocations get their own buffer
+	*/
+	MeshArena::MeshArena(std::shared_ptr<RenderDevice> renderDevice, UInt64 blockSize) :
+	m_renderDevice(std::move(renderDevice)),
+	m_blockSize(blockSize)
+	{
+		NazaraAssert(m_blockSize > 0, "invalid block size");
+	}
+
+	/*!
+	* \brief Allocates space for indices
+	* \return Allocation, its buffer can be filled from its offset
+	*
+	* \param size Size of the indices, in bytes
+	*/
+	auto MeshArena::AllocateIndices(UInt64 size) -> Allocation
+	{
+		std::lock_guard lock(m_mutex);
+		return Allocate(m_indexPool, BufferType::Index, size, IndexAlignment);
+	}
+
+	/*!
+	* \brief Allocates space for vertices
+	* \return Allocation, its buffer can be filled from its offset
+	*
+	* \param vertexDeclaration Declaration of the vertices, only vertices using the same declaration share buffers
+	* \param size Size of the vertices, in bytes
+	*/
+	auto MeshArena::AllocateVertices(const std::shared_ptr<const VertexDeclaration>& vertexDeclaration, UInt64 size) -> Allocation
+	{
+		NazaraAssert(vertexDeclaration, "invalid vertex declaration");
+
+		std::lock_guard lock(m_mutex);
+
+		Pool& pool = m_vertexPools[vertexDeclaration.get()];
+		if (!pool.vertexDeclaration)
+			pool.vertexDeclaration = vertexDeclaration; //< keeps the declaration (and thus the map key) alive
+
+		return Allocate(pool, BufferType::Vertex, size, vertexDeclaration->GetStride());
+	}
+
+	/*!
+	* \brief Releases an allocation, its space may be reused by future allocations
+	*/
+	void MeshArena::Free(const Allocation& allocation)
+	{
+		std::lock_guard lock(m_mutex);
+
+		NazaraAssert(allocation.blockIndex < m_blocks.size(), "invalid allocation");
+		Block& block = m_blocks[allocation.blockIndex];
+		NazaraAssert(block.buffer == allocation.buffer, "allocation doesn't belong to this arena");
+
+		auto& freeRanges = block.freeRanges;
+		auto it = std::lower_bound(freeRanges.begin(), freeRanges.end(), allocation.offset, [](const FreeRange& range, UInt64 offset) { return range.offset < offset; });
+
+		bool mergeWithPrevious = (it != freeRanges.begin() && std::prev(it)->offset + std::prev(it)->size == allocation.offset);
+		bool mergeWithNext = (it != freeRanges.end() && allocation.offset + allocation.size == it->offset);
+
+		if (mergeWithPrevious && mergeWithNext)
+		{
+			std::prev(it)->size += allocation.size + it->size;
+			freeRanges.erase(it);
+		}
+		else if (mergeWithPrevious)
+			std::prev(it)->size += allocation.size;
+		else if (mergeWithNext)
+		{
+			it->offset = allocation.offset;
+			it->size += allocation.size;
+		}
+		else
+			freeRanges.insert(it, FreeRange{ allocation.offset, allocation.size });
+	}
+
+	/*!
+	* \brief Returns the number of buffers created by the arena
+	*/
+	std::size_t MeshArena::GetBufferCount() const
+	{
+		std::lock_guard lock(m_mutex);
+		return m_blocks.size();
+	}
+
+	auto MeshArena::Allocate(Pool& pool, BufferType bufferType, UInt64 size, UInt64 alignment) -> Allocation
+	{
+		NazaraAssert(size > 0, "invalid size");
+
+		// First fit in the existing blocks of the pool
+		auto TryAllocate = [&](std::size_t blockIndex, Allocation& allocation)
+		{
+			Block& block = m_blocks[blockIndex];
+			for (auto it = block.freeRanges.begin(); it != block.freeRanges.end(); ++it)
+			{
+				// Alignment is not always a power of two (vertex strides)
+				UInt64 alignedOffset = (it->offset + alignment - 1) / alignment * alignment;
+				UInt64 rangeEnd = it->offset + it->size;
+				if (alignedOffset + size > rangeEnd)
+					continue;
+
+				allocation.buffer = block.buffer;
+				allocation.blockIndex = blockIndex;
+				allocation.offset = alignedOffset;
+				allocation.size = size;
+
+				// Keep the padding before the allocation and the space after it available
+				UInt64 paddingSize = alignedOffset - it->offset;
+				UInt64 remainingSize = rangeEnd - (alignedOffset + size);
+				if (paddingSize > 0 && remainingSize > 0)
+				{
+					it->size = paddingSize;
+					block.freeRanges.insert(std::next(it), FreeRange{ alignedOffset + size, remainingSize });
+				}
+				else if (paddingSize > 0)
+					it->size = paddingSize;
+				else if (remainingSize > 0)
+				{
+					it->offset = alignedOffset + size;
+					it->size = remainingSize;
+				}
+				else
+					block.freeRanges.erase(it);
+
+				return true;
+			}
+
+			return false;
+		};
+
+		Allocation allocation;
+		for (std::size_t blockIndex : pool.blockIndices)
+		{
+			if (TryAllocate(blockIndex, allocation))
+				return allocation;
+		}
+
+		// Allocations bigger than the block size get a buffer of their own
+		UInt64 bufferSize = std::max(m_blockSize, size);
+
+		std::size_t blockIndex = m_blocks.size();
+		Block& block = m_blocks.emplace_back();
+		block.buffer = m_renderDevice->InstantiateBuffer(bufferType, bufferSize, BufferUsage::DeviceLocal | BufferUsage::Write);
+		block.freeRanges.push_back(FreeRange{ 0, bufferSize });
+
+		pool.blockIndices.push_back(blockIndex);
+
+		bool allocated = TryAllocate(blockIndex, allocation);
+		NazaraAssert(allocated, "failed to allocate from a new block");
+		NazaraUnused(allocated);
+
+		return allocation;
+	}
+}
@@ -3,12 +3,19 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Graphics/Model.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Graphics/AnimationTexture.hpp>
 #include <Nazara/Graphics/ElementRendererRegistry.hpp>
 #include <Nazara/Graphics/GraphicalMesh.hpp>
+#include <Nazara/Graphics/Graphics.hpp>
+#include <Nazara/Graphics/ImpostorAtlas.hpp>
 #include <Nazara/Graphics/MaterialInstance.hpp>
+#include <Nazara/Graphics/RenderImpostor.hpp>
 #include <Nazara/Graphics/RenderSubmesh.hpp>
+#include <Nazara/Graphics/SkeletonInstance.hpp>
 #include <Nazara/Graphics/WorldInstance.hpp>
 #include <Nazara/Renderer/CommandBufferBuilder.hpp>
+#include <algorithm>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
@@ -16,6 +23,8 @@ namespace Nz
 	Model::Model(std::shared_ptr<GraphicalMesh> graphicalMesh) :
 	m_graphicalMesh(std::move(graphicalMesh))
 	{
+		Graphics* graphics = Graphics::Instance();
+
 		m_submeshes.reserve(m_graphicalMesh->GetSubMeshCount());
 		for (std::size_t i = 0; i < m_graphicalMesh->GetSubMeshCount(); ++i)
 		{
@@ -27,6 +36,17 @@ namespace Nz
 					m_graphicalMesh->GetVertexDeclaration(i)
 				}
 			};
+			subMeshData.hasJoints = m_graphicalMesh->GetVertexDeclaration(i)->HasComponent(VertexComponent::JointIndices);
+
+			if (m_graphicalMesh->GetSkinningBuffer(i))
+			{
+				subMeshData.skinnedVertexBufferData = {
+					{
+						0,
+						graphics->GetSkinnedVertexDeclaration()
+					}
+				};
+			}
 		}
 
 		m_onInvalidated.Connect(m_graphicalMesh->OnInvalidated, [this](GraphicalMesh*)
@@ -40,24 +60,97 @@ namespace Nz
 
 	void Model::BuildElement(ElementRendererRegistry& registry, const ElementData& elementData, std::size_t passIndex, std::vector<RenderElementOwner>& elements) const
 	{
+		std::size_t meshLODCount = m_graphicalMesh->GetLODCount();
+		if (m_impostor && elementData.lodIndex >= meshLODCount)
+		{
+			// Impostors are only drawn by the forward pass, they don't write to the depth pre-pass nor cast shadows
+			Graphics* graphics = Graphics::Instance();
+			if (passIndex == graphics->GetMaterialPassRegistry().GetPassIndex("ForwardPass"))
+				elements.emplace_back(registry.AllocateElement<RenderImpostor>(GetRenderLayer(), *m_impostor, *elementData.worldInstance));
+
+			// The first impostor level is a transition where the coarsest mesh level is still drawn below the impostor fading in
+			if (elementData.lodIndex > meshLODCount)
+				return;
+		}
+
 		for (std::size_t i = 0; i < m_submeshes.size(); ++i)
 		{
 			const auto& submeshData = m_submeshes[i];
 
-			const auto& materialPipeline = submeshData.material->GetPipeline(passIndex);
+			auto WatchPrewarmedPipeline = [&](const MaterialPipeline& prewarmingPipeline)
+			{
+				submeshData.onRenderPipelineReady.Connect(prewarmingPipeline.OnRenderPipelineReady, [this](const MaterialPipeline*)
+				{
+					OnElementInvalidated(const_cast<Model*>(this));
+				});
+			};
+
+			// Submeshes animated from an animation texture don't use the skeleton instance, as the animation state is carried by the world instance
+			// Submeshes skinned by a compute shader are rendered from the skinned vertices as static geometry
+			const AnimationTexture* animationTexture = nullptr;
+			const SkeletonInstance* skeletonInstance = elementData.skeletonInstance;
+			const std::vector<RenderPipelineInfo::VertexBufferData>* vertexBufferData = &submeshData.vertexBufferData;
+			const std::shared_ptr<RenderBuffer>* vertexBuffer = &m_graphicalMesh->GetVertexBuffer(i);
+			UInt64 vertexBufferOffset = m_graphicalMesh->GetVertexBufferOffset(i);
+			bool hasJoints = submeshData.hasJoints;
+			if (hasJoints && m_animationTexture)
+			{
+				animationTexture = m_animationTexture.get();
+				skeletonInstance = nullptr;
+			}
+			else if (skeletonInstance && !submeshData.skinnedVertexBufferData.empty())
+			{
+				if (const auto& skinnedVertexBuffer = skeletonInstance->GetSkinnedVertexBuffer(*m_graphicalMesh, i))
+				{
+					skeletonInstance = nullptr;
+					vertexBufferData = &submeshData.skinnedVertexBufferData;
+					vertexBuffer = &skinnedVertexBuffer;
+					vertexBufferOffset = 0;
+					hasJoints = false;
+				}
+			}
+
+			std::shared_ptr<MaterialInstance> material = submeshData.material;
+			if (material->HasPass(elementData.excludedPassIndex))
+				continue;
+
+			const MaterialPipeline* materialPipeline = material->GetPipeline(passIndex).get();
 			if (!materialPipeline)
 				continue;
 
-			MaterialPassFlags passFlags = submeshData.material->GetPassFlags(passIndex);
+			if (materialPipeline->IsPrewarming(vertexBufferData->data(), vertexBufferData->size()))
+			{
+				// Don't stall the render thread until the pipeline shaders are compiled, render using the default material in the meantime
+				WatchPrewarmedPipeline(*materialPipeline);
+
+				material = MaterialInstance::GetDefault(MaterialType::Basic);
+				materialPipeline = material->GetPipeline(passIndex).get();
+				if (!materialPipeline)
+					continue;
+			}
+
+			MaterialPassFlags passFlags = material->GetPassFlags(passIndex);
+
+			std::size_t lodIndex = std::min(elementData.lodIndex, meshLODCount - 1);
+
+			const auto& indexBuffer = m_graphicalMesh->GetIndexBuffer(i, lodIndex);
+			const auto& renderPipeline = materialPipeline->GetRenderPipeline(vertexBufferData->data(), vertexBufferData->size());
 
-			const auto& indexBuffer = m_graphicalMesh->GetIndexBuffer(i);
-			const auto& vertexBuffer = m_graphicalMesh->GetVertexBuffer(i);
-			const auto& renderPipeline = materialPipeline->GetRenderPipeline(submeshData.vertexBufferData.data(), submeshData.vertexBufferData.size());
+			// Skinned submeshes have their own skeletal data and can't be batched together, unless they're animated from an animation texture (which instanced shaders use in place of skeletal data)
+			std::shared_ptr<RenderPipeline> instancedRenderPipeline;
+			if (!skeletonInstance && (!hasJoints || animationTexture))
+			{
+				if (!materialPipeline->IsPrewarming(vertexBufferData->data(), vertexBufferData->size(), true))
+					instancedRenderPipeline = materialPipeline->GetInstancedRenderPipeline(vertexBufferData->data(), vertexBufferData->size());
+				else
+					WatchPrewarmedPipeline(*materialPipeline);
+			}
 
-			std::size_t indexCount = m_graphicalMesh->GetIndexCount(i);
+			std::size_t firstIndex = m_graphicalMesh->GetFirstIndex(i, lodIndex);
+			std::size_t indexCount = m_graphicalMesh->GetIndexCount(i, lodIndex);
 			IndexType indexType = m_graphicalMesh->GetIndexType(i);
 
-			elements.emplace_back(registry.AllocateElement<RenderSubmesh>(GetRenderLayer(), submeshData.material, passFlags, renderPipeline, *elementData.worldInstance, elementData.skeletonInstance, indexCount, indexType, indexBuffer, vertexBuffer, *elementData.scissorBox));
+			elements.emplace_back(registry.AllocateElement<RenderSubmesh>(GetRenderLayer(), std::move(material), passFlags, renderPipeline, std::move(instancedRenderPipeline), *elementData.worldInstance, GetAABB(), skeletonInstance, animationTexture, firstIndex, indexCount, indexType, indexBuffer, *vertexBuffer, vertexBufferOffset, *elementData.scissorBox));
 		}
 	}
 
@@ -71,6 +164,36 @@ namespace Nz
 		return m_graphicalMesh->GetIndexCount(subMeshIndex);
 	}
 
+	/*!
+	* \brief Returns the number of levels of detail of the model
+	*
+	* Models with an impostor have two more levels than their mesh: a transition level (drawing both the coarsest mesh level and the impostor fading in) and an impostor level.
+	*/
+	std::size_t Model::GetLODCount() const
+	{
+		std::size_t lodCount = m_graphicalMesh->GetLODCount();
+		if (m_impostor)
+			lodCount += 2;
+
+		return lodCount;
+	}
+
+	float Model::GetLODError(std::size_t lodIndex) const
+	{
+		std::size_t meshLODCount = m_graphicalMesh->GetLODCount();
+		if (lodIndex < meshLODCount)
+			return m_graphicalMesh->GetLODError(lodIndex);
+
+		// Errors are relative to the model size, the impostor is exact when the model is drawn at its screen size.
+		// With the LOD hysteresis, the transition level starts at 1.5x the screen size (where the impostor starts fading in) and the impostor level below the screen size
+		float error = m_graphicalMesh->GetLODError(meshLODCount - 1);
+		error = std::max(error, 0.5f / m_impostor->GetScreenSize());
+		if (lodIndex > meshLODCount)
+			error = std::max(error, 1.f / m_impostor->GetScreenSize());
+
+		return error;
+	}
+
 	const std::shared_ptr<MaterialInstance>& Model::GetMaterial(std::size_t subMeshIndex) const
 	{
 		assert(subMeshIndex < m_submeshes.size());
@@ -94,4 +217,57 @@ namespace Nz
 	{
 		return m_graphicalMesh->GetVertexBuffer(subMeshIndex);
 	}
+
+	void Model::RegisterComputeSkinning(SkeletonInstance& skeletonInstance) const
+	{
+		// Submeshes animated from an animation texture use the base vertices
+		if (m_animationTexture)
+			return;
+
+		skeletonInstance.EnableComputeSkinning(m_graphicalMesh);
+	}
+
+	/*!
+	* \brief Animates the skinned submeshes of this model from a baked animation texture
+	*
+	* Skinned submeshes then ignore skeleton instances and are rendered using instancing (if their material supports it), each instance playing the clip
+	* set on its world instance (see WorldInstance::UpdateAnimation). This is meant for crowds, where many instances share the same animation.
+	*
+	* \param animationTexture Animation texture baked for the mesh skeleton, or a null pointer to go back to skeletal animation
+	*/
+	void Model::SetAnimationTexture(std::shared_ptr<AnimationTexture> animationTexture)
+	{
+		if (m_animationTexture != animationTexture)
+		{
+			m_animationTexture = std::move(animationTexture);
+
+			OnElementInvalidated(this);
+		}
+	}
+
+	/*!
+	* \brief Replaces the model by an impostor when its projected size is small enough
+	*
+	* The impostor adds two levels of detail past the levels of the mesh (see GetLODCount), the model fades to its impostor (using dithering) between 1.5x and 1x the impostor screen size.
+	* Impostors are unlit and are only drawn by the forward pass.
+	*
+	* \param impostor Impostor atlas of the model (see ImpostorAtlas::Bake), or a null pointer to always draw the mesh
+	*
+	* \remark Impostors must be enabled (see Graphics::Config::useImpostors)
+	*/
+	void Model::SetImpostor(std::shared_ptr<ImpostorAtlas> impostor)
+	{
+		if (impostor && !Graphics::Instance()->IsImpostorEnabled())
+		{
+			NazaraError("impostors are not enabled (see Graphics::Config::useImpostors)");
+			return;
+		}
+
+		if (m_impostor != impostor)
+		{
+			m_impostor = std::move(impostor);
+
+			OnElementInvalidated(this);
+		}
+	}
 }
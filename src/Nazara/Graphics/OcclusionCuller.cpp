@@ -0,0 +1,527 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/OcclusionCuller.hpp>
+#include <Nazara/Graphics/AbstractViewer.hpp>
+#include <Nazara/Graphics/BakedFrameGraph.hpp>
+#include <Nazara/Graphics/FrameGraph.hpp>
+#include <Nazara/Graphics/Graphics.hpp>
+#include <Nazara/Graphics/ViewerInstance.hpp>
+#include <Nazara/Renderer/CommandBufferBuilder.hpp>
+#include <Nazara/Renderer/RenderBuffer.hpp>
+#include <Nazara/Renderer/RenderFrame.hpp>
+#include <NZSL/Math/FieldOffsets.hpp>
+#include <algorithm>
+#include <cstring>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	NAZARA_ANONYMOUS_NAMESPACE
+	{
+		// Results are still used while the eye moves by less than this distance, bounding boxes are enlarged by the same amount when tested
+		constexpr float MaxEyeDisplacement = 0.05f;
+
+		struct LevelDataOffsets
+		{
+			std::size_t sourceOffset;
+			std::size_t sourceSize;
+			std::size_t targetOffset;
+			std::size_t targetSize;
+			std::size_t totalSize;
+		};
+
+		struct CullingDataOffsets
+		{
+			std::size_t viewProjMatrix;
+			std::size_t viewportOffset;
+			std::size_t viewportSize;
+			std::size_t candidateCount;
+			std::size_t levelCount;
+			std::size_t levels;
+			std::size_t levelStride;
+			std::size_t totalSize;
+		};
+
+		struct CandidateOffsets
+		{
+			std::size_t minPos;
+			std::size_t maxPos;
+			std::size_t boxSize;
+			std::size_t resultSize;
+		};
+
+		// Must match HiZDownsample shader
+		LevelDataOffsets GetLevelDataOffsets()
+		{
+			nzsl::FieldOffsets levelStruct(nzsl::StructLayout::Std140);
+
+			LevelDataOffsets offsets;
+			offsets.sourceOffset = levelStruct.AddField(nzsl::StructFieldType::Int2);
+			offsets.sourceSize = levelStruct.AddField(nzsl::StructFieldType::Int2);
+			offsets.targetOffset = levelStruct.AddField(nzsl::StructFieldType::Int2);
+			offsets.targetSize = levelStruct.AddField(nzsl::StructFieldType::Int2);
+			offsets.totalSize = levelStruct.GetAlignedSize();
+
+			return offsets;
+		}
+
+		// Must match HiZOcclusionTest shader
+		CullingDataOffsets GetCullingDataOffsets()
+		{
+			nzsl::FieldOffsets cullingStruct(nzsl::StructLayout::Std140);
+
+			CullingDataOffsets offsets;
+			offsets.viewProjMatrix = cullingStruct.AddMatrix(nzsl::StructFieldType::Float1, 4, 4, true);
+			offsets.viewportOffset = cullingStruct.AddField(nzsl::StructFieldType::Float2);
+			offsets.viewportSize = cullingStruct.AddField(nzsl::StructFieldType::Float2);
+			offsets.candidateCount = cullingStruct.AddField(nzsl::StructFieldType::UInt1);
+			offsets.levelCount = cullingStruct.AddField(nzsl::StructFieldType::UInt1);
+			offsets.levels = cullingStruct.AddField(nzsl::StructFieldType::Int4);
+			for (std::size_t i = 1; i < OcclusionCuller::MaxLevelCount; ++i)
+				cullingStruct.AddField(nzsl::StructFieldType::Int4);
+
+			offsets.levelStride = 4 * sizeof(Int32); //< std140 arrays of vec4 are tightly packed
+			offsets.totalSize = cullingStruct.GetAlignedSize();
+
+			return offsets;
+		}
+
+		CandidateOffsets GetCandidateOffsets()
+		{
+			nzsl::FieldOffsets boxStruct(nzsl::StructLayout::Std140);
+
+			CandidateOffsets offsets;
+			offsets.minPos = boxStruct.AddField(nzsl::StructFieldType::Float3);
+			offsets.maxPos = boxStruct.AddField(nzsl::StructFieldType::Float3);
+			offsets.boxSize = boxStruct.GetAlignedSize();
+
+			nzsl::FieldOffsets resultStruct(nzsl::StructLayout::Std140);
+			resultStruct.AddField(nzsl::StructFieldType::UInt1);
+			offsets.resultSize = resultStruct.GetAlignedSize();
+
+			return offsets;
+		}
+	}
+
+	OcclusionCuller::OcclusionCuller(AbstractViewer* viewer) :
+	m_readbackState(std::make_shared<ReadbackState>()),
+	m_depthBufferIndex(0),
+	m_depthCopyAttachment(0),
+	m_levelCount(0),
+	m_viewer(viewer),
+	m_epoch(0),
+	m_nextReadbackIndex(1),
+	m_pyramidViewProjMatrix(Matrix4f::Identity()),
+	m_pyramidBaseSize(0, 0),
+	m_areResultsUsable(false)
+	{
+	}
+
+	/*!
+	* \brief Queues a renderable bounding box to be tested against the depth of this frame
+	*/
+	void OcclusionCuller::AddCandidate(std::size_t renderableIndex, const Boxf& aabb, UInt8 generation)
+	{
+		auto& candidate = m_candidates.emplace_back();
+		candidate.aabb = aabb;
+		candidate.generation = generation;
+		candidate.renderableIndex = renderableIndex;
+	}
+
+	/*!
+	* \brief Builds the depth pyramid from the depth copy of this frame and tests candidates against it
+	*
+	* Must be called after the frame graph has been executed (as the depth copy is one of its outputs)
+	*/
+	void OcclusionCuller::Dispatch(RenderFrame& renderFrame, CommandBufferBuilder& builder, const BakedFrameGraph& bakedGraph)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		if (m_candidates.empty())
+			return;
+
+		Graphics* graphics = Graphics::Instance();
+		const std::shared_ptr<RenderDevice>& renderDevice = graphics->GetRenderDevice();
+
+		const std::shared_ptr<Texture>& depthCopy = bakedGraph.GetAttachmentTexture(m_depthCopyAttachment);
+		Vector3ui depthSize = depthCopy->GetSize();
+
+		if (!m_pyramidTexture || m_pyramidBaseSize != Vector2ui(depthSize.x, depthSize.y))
+			BuildPyramid(renderFrame, Vector2ui(depthSize.x, depthSize.y));
+
+		// Reuse a slot whose readback is over
+		ReadbackSlot slot;
+		if (!m_readbackState->freeSlots.empty())
+		{
+			slot = std::move(m_readbackState->freeSlots.back());
+			m_readbackState->freeSlots.pop_back();
+		}
+
+		static CandidateOffsets candidateOffsets = GetCandidateOffsets();
+		static CullingDataOffsets cullingDataOffsets = GetCullingDataOffsets();
+
+		std::size_t candidateCount = m_candidates.size();
+		if (slot.capacity < candidateCount)
+		{
+			if (slot.shaderBinding)
+				renderFrame.PushForRelease(std::move(slot.shaderBinding));
+
+			slot.capacity = std::max(candidateCount, slot.capacity * 2);
+			slot.candidateBuffer = renderDevice->InstantiateBuffer(BufferType::Storage, slot.capacity * candidateOffsets.boxSize, BufferUsage::DirectMapping | BufferUsage::Write);
+			slot.resultBuffer = renderDevice->InstantiateBuffer(BufferType::Storage, slot.capacity * candidateOffsets.resultSize, BufferUsage::DirectMapping | BufferUsage::Read);
+			slot.pyramidTexture = nullptr;
+		}
+
+		if (!slot.cullingDataBuffer)
+			slot.cullingDataBuffer = renderDevice->InstantiateBuffer(BufferType::Uniform, cullingDataOffsets.totalSize, BufferUsage::DirectMapping | BufferUsage::Write);
+
+		if (slot.pyramidTexture != m_pyramidTexture.get())
+		{
+			if (slot.shaderBinding)
+				renderFrame.PushForRelease(std::move(slot.shaderBinding));
+
+			slot.shaderBinding = graphics->GetOcclusionTestPipelineLayout()->AllocateShaderBinding(0);
+			slot.shaderBinding->Update({
+				{
+					0,
+					ShaderBinding::UniformBufferBinding {
+						slot.cullingDataBuffer.get(),
+						0, cullingDataOffsets.totalSize
+					}
+				},
+				{
+					1,
+					ShaderBinding::TextureBinding {
+						m_pyramidTexture.get(),
+						TextureAccess::ReadOnly
+					}
+				},
+				{
+					2,
+					ShaderBinding::StorageBufferBinding {
+						slot.candidateBuffer.get(),
+						0, slot.capacity * candidateOffsets.boxSize
+					}
+				},
+				{
+					3,
+					ShaderBinding::StorageBufferBinding {
+						slot.resultBuffer.get(),
+						0, slot.capacity * candidateOffsets.resultSize
+					}
+				}
+			});
+
+			slot.pyramidTexture = m_pyramidTexture.get();
+		}
+
+		// Candidates (the slot buffers are no longer used by the GPU once the slot is free)
+		if (void* candidateData = slot.candidateBuffer->Map(0, candidateCount * candidateOffsets.boxSize))
+		{
+			Vector3f margin(MaxEyeDisplacement);
+			for (std::size_t i = 0; i < candidateCount; ++i)
+			{
+				const Boxf& aabb = m_candidates[i].aabb;
+
+				UInt8* boxData = static_cast<UInt8*>(candidateData) + i * candidateOffsets.boxSize;
+				AccessByOffset<Vector3f&>(boxData, candidateOffsets.minPos) = aabb.GetMinimum() - margin;
+				AccessByOffset<Vector3f&>(boxData, candidateOffsets.maxPos) = aabb.GetMaximum() + margin;
+			}
+
+			slot.candidateBuffer->Unmap();
+		}
+		else
+		{
+			NazaraError("failed to map occlusion culling candidate buffer");
+			m_readbackState->freeSlots.push_back(std::move(slot));
+			return;
+		}
+
+		std::vector<UInt8> cullingData(cullingDataOffsets.totalSize);
+		AccessByOffset<Matrix4f&>(cullingData.data(), cullingDataOffsets.viewProjMatrix) = m_viewer->GetViewerInstance().GetViewProjMatrix();
+		AccessByOffset<Vector2f&>(cullingData.data(), cullingDataOffsets.viewportOffset) = Vector2f(float(m_viewState.viewport.x), float(m_viewState.viewport.y));
+		AccessByOffset<Vector2f&>(cullingData.data(), cullingDataOffsets.viewportSize) = Vector2f(float(m_viewState.viewport.width), float(m_viewState.viewport.height));
+		AccessByOffset<UInt32&>(cullingData.data(), cullingDataOffsets.candidateCount) = SafeCast<UInt32>(candidateCount);
+		AccessByOffset<UInt32&>(cullingData.data(), cullingDataOffsets.levelCount) = SafeCast<UInt32>(m_levelCount);
+		for (std::size_t i = 0; i < m_levelCount; ++i)
+		{
+			Int32* levelData = AccessByOffset<Int32*>(cullingData.data(), cullingDataOffsets.levels + i * cullingDataOffsets.levelStride);
+			levelData[0] = m_levels[i].x;
+			levelData[1] = m_levels[i].y;
+			levelData[2] = m_levels[i].width;
+			levelData[3] = m_levels[i].height;
+		}
+
+		if (!slot.cullingDataBuffer->Fill(cullingData.data(), 0, cullingData.size()))
+		{
+			NazaraError("failed to fill occlusion culling data buffer");
+			m_readbackState->freeSlots.push_back(std::move(slot));
+			return;
+		}
+
+		builder.BeginDebugRegion("Occlusion culling", Color::Orange());
+		{
+			// Copy the depth of this frame as the pyramid base level
+			builder.TextureBarrier(PipelineStage::ColorOutput, PipelineStage::Transfer, MemoryAccess::ColorWrite, MemoryAccess::TransferRead, TextureLayout::ColorOutput, TextureLayout::TransferSource, *depthCopy);
+			builder.TextureBarrier(PipelineStage::ComputeShader, PipelineStage::Transfer, MemoryAccess::ShaderRead, MemoryAccess::TransferWrite, TextureLayout::Undefined, TextureLayout::TransferDestination, *m_pyramidTexture);
+
+			builder.CopyTexture(*depthCopy, Boxui(0, 0, 0, depthSize.x, depthSize.y, 1), TextureLayout::TransferSource, *m_pyramidTexture, Vector3ui::Zero(), TextureLayout::TransferDestination);
+
+			builder.TextureBarrier(PipelineStage::Transfer, PipelineStage::ComputeShader, MemoryAccess::TransferWrite, MemoryAccess::ShaderRead | MemoryAccess::ShaderWrite, TextureLayout::TransferDestination, TextureLayout::General, *m_pyramidTexture);
+
+			builder.BindComputePipeline(*graphics->GetHiZDownsamplePipeline());
+			for (std::size_t i = 1; i < m_levelCount; ++i)
+			{
+				const Recti& level = m_levels[i];
+
+				builder.BindComputeShaderBinding(0, *m_levelShaderBindings[i - 1]);
+				builder.Dispatch(SafeCast<UInt32>((level.width + 7) / 8), SafeCast<UInt32>((level.height + 7) / 8), 1);
+
+				// Next level reads this one
+				builder.MemoryBarrier(PipelineStage::ComputeShader, PipelineStage::ComputeShader, MemoryAccess::ShaderWrite, MemoryAccess::ShaderRead);
+			}
+
+			builder.BindComputePipeline(*graphics->GetOcclusionTestPipeline());
+			builder.BindComputeShaderBinding(0, *slot.shaderBinding);
+			builder.Dispatch(SafeCast<UInt32>((candidateCount + 63) / 64), 1, 1);
+
+			builder.MemoryBarrier(PipelineStage::ComputeShader, PipelineStage::Host, MemoryAccess::ShaderWrite, MemoryAccess::HostRead);
+		}
+		builder.EndDebugRegion();
+
+		std::swap(slot.candidates, m_candidates);
+		slot.viewState = m_viewState;
+
+		m_pyramidViewProjMatrix = m_viewer->GetViewerInstance().GetViewProjMatrix();
+		m_pyramidViewState = m_viewState;
+
+		// Results are read once the GPU is done with this frame
+		UInt64 readbackIndex = m_nextReadbackIndex++;
+		renderFrame.PushReleaseCallback([state = m_readbackState, slot = std::move(slot), readbackIndex]() mutable
+		{
+			ReadResults(*state, slot, readbackIndex);
+			state->freeSlots.push_back(std::move(slot));
+		});
+	}
+
+	/*!
+	* \brief Starts a new frame for the viewer
+	*
+	* Checks if the last results are still valid for the current viewer state and clears the candidate list.
+	*/
+	void OcclusionCuller::Prepare()
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		const ViewerInstance& viewerInstance = m_viewer->GetViewerInstance();
+		m_viewState.epoch = m_epoch;
+		m_viewState.eyePosition = viewerInstance.GetEyePosition();
+		m_viewState.projectionMatrix = viewerInstance.GetProjectionMatrix();
+		m_viewState.viewport = m_viewer->GetRenderViewport();
+
+		// Occlusion doesn't depend on the camera rotation (boxes partially out of the screen are never occluded) but it does depend on its position
+		const ViewState& resultViewState = m_readbackState->viewState;
+		m_areResultsUsable = m_readbackState->lastReadbackIndex != 0 &&
+		                     resultViewState.epoch == m_viewState.epoch &&
+		                     resultViewState.viewport == m_viewState.viewport &&
+		                     resultViewState.projectionMatrix == m_viewState.projectionMatrix &&
+		                     resultViewState.eyePosition.SquaredDistance(m_viewState.eyePosition) <= MaxEyeDisplacement * MaxEyeDisplacement;
+
+		m_candidates.clear();
+	}
+
+	/*!
+	* \brief Registers the depth copy pass
+	*
+	* The depth buffer must be a depth-only format (depth-stencil textures can't be sampled).
+	*/
+	void OcclusionCuller::RegisterToFrameGraph(FrameGraph& frameGraph, std::size_t depthBufferIndex)
+	{
+		m_depthBufferIndex = depthBufferIndex;
+		m_depthCopyAttachment = frameGraph.AddAttachment({
+			"Occlusion depth copy",
+			PixelFormat::R32F
+		});
+
+		FramePass& depthCopyPass = frameGraph.AddPass("Occlusion depth copy");
+		depthCopyPass.AddInput(depthBufferIndex);
+		depthCopyPass.AddOutput(m_depthCopyAttachment);
+		depthCopyPass.SetCommandCallback([this](CommandBufferBuilder& builder, const FramePassEnvironment& env)
+		{
+			builder.SetScissor(env.renderRect);
+			builder.SetViewport(env.renderRect);
+
+			builder.BindRenderPipeline(*Graphics::Instance()->GetHiZDepthCopyPipeline());
+			builder.BindRenderShaderBinding(0, *m_depthCopyShaderBinding);
+			builder.Draw(3);
+		});
+
+		// Keep the copy alive after the frame graph execution so the depth pyramid can be built from it
+		frameGraph.AddBackbufferOutput(m_depthCopyAttachment);
+	}
+
+	/*!
+	* \brief Updates the depth copy pass binding, must be called when the frame graph has been rebuilt or resized
+	*/
+	void OcclusionCuller::UpdateBindings(RenderFrame& renderFrame, const BakedFrameGraph& bakedGraph)
+	{
+		Graphics* graphics = Graphics::Instance();
+
+		if (m_depthCopyShaderBinding)
+			renderFrame.PushForRelease(std::move(m_depthCopyShaderBinding));
+
+		TextureSamplerInfo samplerInfo;
+		samplerInfo.magFilter = SamplerFilter::Nearest;
+		samplerInfo.minFilter = SamplerFilter::Nearest;
+		samplerInfo.mipmapMode = SamplerMipmapMode::Nearest;
+
+		m_depthCopyShaderBinding = graphics->GetHiZDepthCopyPipelineLayout()->AllocateShaderBinding(0);
+		m_depthCopyShaderBinding->Update({
+			{
+				0,
+				ShaderBinding::SampledTextureBinding {
+					bakedGraph.GetAttachmentTexture(m_depthBufferIndex).get(),
+					graphics->GetSamplerCache().Get(samplerInfo).get()
+				}
+			}
+		});
+	}
+
+	void OcclusionCuller::BuildPyramid(RenderFrame& renderFrame, const Vector2ui& baseSize)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		Graphics* graphics = Graphics::Instance();
+		const std::shared_ptr<RenderDevice>& renderDevice = graphics->GetRenderDevice();
+
+		// Level sizes are rounded up so every texel of a level is covered by the next one, down to 1x1
+		// The base level (the depth copy) is stored at the origin and the next levels are stacked on its right
+		m_levels.clear();
+		m_levels.emplace_back(0, 0, int(baseSize.x), int(baseSize.y));
+
+		Vector2i levelPos(int(baseSize.x), 0);
+		Vector2i levelSize(int(baseSize.x), int(baseSize.y));
+		Vector2ui pyramidSize = baseSize;
+		while ((levelSize.x > 1 || levelSize.y > 1) && m_levels.size() < MaxLevelCount)
+		{
+			levelSize.x = (levelSize.x + 1) / 2;
+			levelSize.y = (levelSize.y + 1) / 2;
+
+			m_levels.emplace_back(levelPos.x, levelPos.y, levelSize.x, levelSize.y);
+			levelPos.y += levelSize.y;
+
+			pyramidSize.x = std::max(pyramidSize.x, static_cast<unsigned int>(levelPos.x + levelSize.x));
+			pyramidSize.y = std::max(pyramidSize.y, static_cast<unsigned int>(levelPos.y));
+		}
+		m_levelCount = m_levels.size();
+
+		if (m_pyramidTexture)
+			renderFrame.PushForRelease(std::move(m_pyramidTexture));
+
+		TextureInfo pyramidInfo;
+		pyramidInfo.pixelFormat = PixelFormat::R32F;
+		pyramidInfo.type = ImageType::E2D;
+		pyramidInfo.usageFlags = TextureUsage::ShaderReadWrite | TextureUsage::TransferDestination;
+		pyramidInfo.levelCount = 1;
+		pyramidInfo.width = pyramidSize.x;
+		pyramidInfo.height = pyramidSize.y;
+
+		m_pyramidTexture = renderDevice->InstantiateTexture(pyramidInfo);
+		m_pyramidTexture->UpdateDebugName("Occlusion depth pyramid");
+		m_pyramidBaseSize = baseSize;
+
+		// Downsample parameters never change for a given size
+		static LevelDataOffsets levelDataOffsets = GetLevelDataOffsets();
+		std::size_t levelAlignedSize = AlignPow2(levelDataOffsets.totalSize, SafeCast<std::size_t>(renderDevice->GetDeviceInfo().limits.minUniformBufferOffsetAlignment));
+
+		std::vector<UInt8> levelData((m_levelCount - 1) * levelAlignedSize);
+		for (std::size_t i = 1; i < m_levelCount; ++i)
+		{
+			UInt8* data = &levelData[(i - 1) * levelAlignedSize];
+			AccessByOffset<Vector2i32&>(data, levelDataOffsets.sourceOffset) = Vector2i32(m_levels[i - 1].x, m_levels[i - 1].y);
+			AccessByOffset<Vector2i32&>(data, levelDataOffsets.sourceSize) = Vector2i32(m_levels[i - 1].width, m_levels[i - 1].height);
+			AccessByOffset<Vector2i32&>(data, levelDataOffsets.targetOffset) = Vector2i32(m_levels[i].x, m_levels[i].y);
+			AccessByOffset<Vector2i32&>(data, levelDataOffsets.targetSize) = Vector2i32(m_levels[i].width, m_levels[i].height);
+		}
+
+		for (ShaderBindingPtr& shaderBinding : m_levelShaderBindings)
+			renderFrame.PushForRelease(std::move(shaderBinding));
+
+		m_levelShaderBindings.clear();
+
+		if (m_levelDataBuffer)
+			renderFrame.PushForRelease(std::move(m_levelDataBuffer));
+
+		if (levelData.empty())
+			return;
+
+		m_levelDataBuffer = renderDevice->InstantiateBuffer(BufferType::Uniform, levelData.size(), BufferUsage::DirectMapping | BufferUsage::Write, levelData.data());
+
+		for (std::size_t i = 1; i < m_levelCount; ++i)
+		{
+			ShaderBindingPtr& shaderBinding = m_levelShaderBindings.emplace_back(graphics->GetHiZDownsamplePipelineLayout()->AllocateShaderBinding(0));
+			shaderBinding->Update({
+				{
+					0,
+					ShaderBinding::UniformBufferBinding {
+						m_levelDataBuffer.get(),
+						(i - 1) * levelAlignedSize, levelDataOffsets.totalSize
+					}
+				},
+				{
+					1,
+					ShaderBinding::TextureBinding {
+						m_pyramidTexture.get(),
+						TextureAccess::ReadOnly
+					}
+				},
+				{
+					2,
+					ShaderBinding::TextureBinding {
+						m_pyramidTexture.get(),
+						TextureAccess::WriteOnly
+					}
+				}
+			});
+		}
+	}
+
+	void OcclusionCuller::ReadResults(ReadbackState& state, ReadbackSlot& slot, UInt64 readbackIndex)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		static CandidateOffsets candidateOffsets = GetCandidateOffsets();
+
+		// Frames are released in order, but don't go back in time if this changes
+		if (readbackIndex < state.lastReadbackIndex)
+			return;
+
+		std::size_t candidateCount = slot.candidates.size();
+		const void* resultData = slot.resultBuffer->Map(0, candidateCount * candidateOffsets.resultSize);
+		if (!resultData)
+		{
+			NazaraError("failed to map occlusion culling result buffer");
+			return;
+		}
+
+		for (std::size_t i = 0; i < candidateCount; ++i)
+		{
+			const Candidate& candidate = slot.candidates[i];
+			if (candidate.renderableIndex >= state.results.size())
+				state.results.resize(candidate.renderableIndex + 1);
+
+			RenderableResult& result = state.results[candidate.renderableIndex];
+			result.aabb = candidate.aabb;
+			result.generation = candidate.generation;
+			result.occluded = AccessByOffset<const UInt32&>(static_cast<const UInt8*>(resultData), i * candidateOffsets.resultSize) != 0;
+			result.readbackIndex = readbackIndex;
+		}
+
+		slot.resultBuffer->Unmap();
+
+		state.lastReadbackIndex = readbackIndex;
+		state.viewState = slot.viewState;
+	}
+}
@@ -0,0 +1,341 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/ParticleEmitter.hpp>
+#include <Nazara/Graphics/ElementRendererRegistry.hpp>
+#include <Nazara/Graphics/Graphics.hpp>
+#include <Nazara/Graphics/RenderParticles.hpp>
+#include <Nazara/Graphics/WorldInstance.hpp>
+#include <Nazara/Renderer/CommandBufferBuilder.hpp>
+#include <Nazara/Renderer/RenderBuffer.hpp>
+#include <Nazara/Renderer/RenderFrame.hpp>
+#include <Nazara/Renderer/UploadPool.hpp>
+#include <NZSL/Math/FieldOffsets.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	NAZARA_ANONYMOUS_NAMESPACE
+	{
+		// Particles can't be spawned more than this time apart, long frames would otherwise make them jump
+		constexpr float MaxSimulationStep = 0.1f;
+
+		struct EmitterDataOffsets
+		{
+			std::size_t worldMatrix;
+			std::size_t depthViewProjMatrix;
+			std::size_t depthInvViewProjMatrix;
+			std::size_t depthEyePosition;
+			std::size_t deltaTime;
+			std::size_t depthViewportOffset;
+			std::size_t depthViewportSize;
+			std::size_t gravity;
+			std::size_t drag;
+			std::size_t spawnExtent;
+			std::size_t randomSeed;
+			std::size_t minVelocity;
+			std::size_t minLifetime;
+			std::size_t maxVelocity;
+			std::size_t maxLifetime;
+			std::size_t startColor;
+			std::size_t endColor;
+			std::size_t startSize;
+			std::size_t endSize;
+			std::size_t restitution;
+			std::size_t collisionThickness;
+			std::size_t capacity;
+			std::size_t activeFirst;
+			std::size_t activeCount;
+			std::size_t spawnCount;
+			std::size_t totalSize;
+		};
+
+		// Must match Engine.ParticleData shader module
+		EmitterDataOffsets GetEmitterDataOffsets()
+		{
+			nzsl::FieldOffsets emitterStruct(nzsl::StructLayout::Std140);
+
+			EmitterDataOffsets offsets;
+			offsets.worldMatrix = emitterStruct.AddMatrix(nzsl::StructFieldType::Float1, 4, 4, true);
+			offsets.depthViewProjMatrix = emitterStruct.AddMatrix(nzsl::StructFieldType::Float1, 4, 4, true);
+			offsets.depthInvViewProjMatrix = emitterStruct.AddMatrix(nzsl::StructFieldType::Float1, 4, 4, true);
+			offsets.depthEyePosition = emitterStruct.AddField(nzsl::StructFieldType::Float3);
+			offsets.deltaTime = emitterStruct.AddField(nzsl::StructFieldType::Float1);
+			offsets.depthViewportOffset = emitterStruct.AddField(nzsl::StructFieldType::Float2);
+			offsets.depthViewportSize = emitterStruct.AddField(nzsl::StructFieldType::Float2);
+			offsets.gravity = emitterStruct.AddField(nzsl::StructFieldType::Float3);
+			offsets.drag = emitterStruct.AddField(nzsl::StructFieldType::Float1);
+			offsets.spawnExtent = emitterStruct.AddField(nzsl::StructFieldType::Float3);
+			offsets.randomSeed = emitterStruct.AddField(nzsl::StructFieldType::Float1);
+			offsets.minVelocity = emitterStruct.AddField(nzsl::StructFieldType::Float3);
+			offsets.minLifetime = emitterStruct.AddField(nzsl::StructFieldType::Float1);
+			offsets.maxVelocity = emitterStruct.AddField(nzsl::StructFieldType::Float3);
+			offsets.maxLifetime = emitterStruct.AddField(nzsl::StructFieldType::Float1);
+			offsets.startColor = emitterStruct.AddField(nzsl::StructFieldType::Float4);
+			offsets.endColor = emitterStruct.AddField(nzsl::StructFieldType::Float4);
+			offsets.startSize = emitterStruct.AddField(nzsl::StructFieldType::Float1);
+			offsets.endSize = emitterStruct.AddField(nzsl::StructFieldType::Float1);
+			offsets.restitution = emitterStruct.AddField(nzsl::StructFieldType::Float1);
+			offsets.collisionThickness = emitterStruct.AddField(nzsl::StructFieldType::Float1);
+			offsets.capacity = emitterStruct.AddField(nzsl::StructFieldType::UInt1);
+			offsets.activeFirst = emitterStruct.AddField(nzsl::StructFieldType::UInt1);
+			offsets.activeCount = emitterStruct.AddField(nzsl::StructFieldType::UInt1);
+			offsets.spawnCount = emitterStruct.AddField(nzsl::StructFieldType::UInt1);
+			offsets.totalSize = emitterStruct.GetAlignedSize();
+
+			return offsets;
+		}
+
+		std::size_t GetParticleSize()
+		{
+			nzsl::FieldOffsets particleStruct(nzsl::StructLayout::Std140);
+			particleStruct.AddField(nzsl::StructFieldType::Float3); //< position
+			particleStruct.AddField(nzsl::StructFieldType::Float1); //< age
+			particleStruct.AddField(nzsl::StructFieldType::Float3); //< velocity
+			particleStruct.AddField(nzsl::StructFieldType::Float1); //< lifetime
+			particleStruct.AddField(nzsl::StructFieldType::Float4); //< color
+			particleStruct.AddField(nzsl::StructFieldType::Float1); //< size
+
+			return particleStruct.GetAlignedSize();
+		}
+	}
+
+	/*!
+	* \ingroup graphics
+	* \class ParticleEmitter
+	* \brief Renderable spawning particles simulated, sorted (for alpha-blending) and drawn by the GPU
+	*
+	* Particles are allocated in a ring buffer of maxParticleCount entries, when more particles are alive than that the oldest ones are replaced.
+	*/
+	ParticleEmitter::ParticleEmitter(std::shared_ptr<Texture> texture, ParticleBlendMode blendMode, std::size_t maxParticleCount) :
+	m_texture(std::move(texture)),
+	m_maxParticleCount(maxParticleCount),
+	m_pendingParticleCount(0),
+	m_ringCursor(0),
+	m_spawnHistoryCount(0),
+	m_simulationDepthTexture(nullptr),
+	m_simulationFrame(0),
+	m_simulationTime(0.f),
+	m_spawnAccumulator(0.f),
+	m_endColor(1.f, 1.f, 1.f, 0.f),
+	m_startColor(Color::White()),
+	m_blendMode(blendMode),
+	m_gravity(0.f, -9.81f, 0.f),
+	m_maxVelocity(1.f, 5.f, 1.f),
+	m_minVelocity(-1.f, 3.f, -1.f),
+	m_spawnExtent(Vector3f::Zero()),
+	m_collisionsEnabled(false),
+	m_collisionRestitution(0.5f),
+	m_collisionThickness(0.5f),
+	m_drag(0.f),
+	m_emissionRate(100.f),
+	m_endSize(0.1f),
+	m_maxLifetime(2.f),
+	m_minLifetime(1.f),
+	m_startSize(0.1f)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		assert(m_texture);
+		assert(m_maxParticleCount > 0);
+
+		static EmitterDataOffsets emitterDataOffsets = GetEmitterDataOffsets();
+
+		RenderDevice& renderDevice = *Graphics::Instance()->GetRenderDevice();
+
+		// A zero lifetime marks particles as dead
+		std::vector<UInt8> particleData(m_maxParticleCount * GetParticleSize(), 0);
+		m_particleBuffer = renderDevice.InstantiateBuffer(BufferType::Storage, particleData.size(), BufferUsage::DeviceLocal | BufferUsage::Write, particleData.data());
+
+		m_emitterBuffer = renderDevice.InstantiateBuffer(BufferType::Uniform, emitterDataOffsets.totalSize, BufferUsage::DeviceLocal | BufferUsage::Dynamic | BufferUsage::Write);
+
+		CommandBufferBuilder::DrawIndexedIndirectCommand drawCommand = { 6, 0, 0, 0, 0 };
+		m_drawBuffer = renderDevice.InstantiateBuffer(BufferType::Storage, sizeof(drawCommand), BufferUsage::DeviceLocal | BufferUsage::Dynamic | BufferUsage::Write, &drawCommand);
+
+		UpdateBounds();
+	}
+
+	void ParticleEmitter::BuildElement(ElementRendererRegistry& registry, const ElementData& elementData, std::size_t passIndex, std::vector<RenderElementOwner>& elements) const
+	{
+		Graphics* graphics = Graphics::Instance();
+		if (!graphics->IsParticleSystemEnabled())
+			return;
+
+		// Particles are only drawn by the forward pass, they don't write depth nor cast shadows
+		if (passIndex != graphics->GetMaterialPassRegistry().GetPassIndex("ForwardPass"))
+			return;
+
+		elements.emplace_back(registry.AllocateElement<RenderParticles>(GetRenderLayer(), *this, *elementData.worldInstance));
+	}
+
+	const std::shared_ptr<MaterialInstance>& ParticleEmitter::GetMaterial(std::size_t i) const
+	{
+		NazaraUnused(i);
+
+		// Particle emitters have no material (see GetMaterialCount)
+		static std::shared_ptr<MaterialInstance> s_noMaterial;
+		return s_noMaterial;
+	}
+
+	std::size_t ParticleEmitter::GetMaterialCount() const
+	{
+		return 0;
+	}
+
+	bool ParticleEmitter::IsSimulated() const
+	{
+		return true;
+	}
+
+	void ParticleEmitter::Simulate(RenderFrame& renderFrame, CommandBufferBuilder& builder, const WorldInstance& worldInstance, const SimulationData& simulationData) const
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		static EmitterDataOffsets emitterDataOffsets = GetEmitterDataOffsets();
+
+		Graphics* graphics = Graphics::Instance();
+
+		float deltaTime = std::min(simulationData.elapsedTime.AsSeconds(), MaxSimulationStep);
+		m_simulationTime += deltaTime;
+		m_simulationFrame++;
+
+		// Spawning
+		m_spawnAccumulator += m_emissionRate * deltaTime;
+		float spawnedFromRate = std::floor(m_spawnAccumulator);
+		m_spawnAccumulator -= spawnedFromRate;
+
+		std::size_t spawnCount = std::min(static_cast<std::size_t>(spawnedFromRate) + m_pendingParticleCount, m_maxParticleCount);
+		m_pendingParticleCount = 0;
+
+		if (spawnCount > 0)
+		{
+			m_spawnHistory.push_back({ m_simulationTime, spawnCount });
+			m_spawnHistoryCount += spawnCount;
+		}
+
+		// Particles spawned more than a lifetime ago are dead
+		while (!m_spawnHistory.empty() && m_simulationTime - m_spawnHistory.front().spawnTime > m_maxLifetime + MaxSimulationStep)
+		{
+			m_spawnHistoryCount -= m_spawnHistory.front().particleCount;
+			m_spawnHistory.pop_front();
+		}
+
+		m_ringCursor = (m_ringCursor + spawnCount) % m_maxParticleCount;
+
+		std::size_t activeCount = std::min(m_spawnHistoryCount, m_maxParticleCount);
+		std::size_t activeFirst = (m_ringCursor + m_maxParticleCount - activeCount) % m_maxParticleCount;
+
+		bool depthCollision = m_collisionsEnabled && simulationData.depthTexture != nullptr;
+		if (!m_simulationShaderBinding || m_simulationDepthTexture != simulationData.depthTexture)
+		{
+			if (m_simulationShaderBinding)
+				renderFrame.PushForRelease(std::move(m_simulationShaderBinding));
+
+			m_simulationShaderBinding = graphics->GetParticleSimulationPipelineLayout()->AllocateShaderBinding(0);
+			m_simulationShaderBinding->Update({
+				{
+					0,
+					ShaderBinding::UniformBufferBinding {
+						m_emitterBuffer.get(),
+						0, m_emitterBuffer->GetSize()
+					}
+				},
+				{
+					1,
+					ShaderBinding::StorageBufferBinding {
+						m_particleBuffer.get(),
+						0, m_particleBuffer->GetSize()
+					}
+				}
+			});
+
+			if (simulationData.depthTexture)
+			{
+				m_simulationShaderBinding->Update({
+					{
+						2,
+						ShaderBinding::TextureBinding {
+							simulationData.depthTexture,
+							TextureAccess::ReadOnly
+						}
+					}
+				});
+			}
+
+			m_simulationDepthTexture = simulationData.depthTexture;
+		}
+
+		Matrix4f depthInvViewProjMatrix = Matrix4f::Identity();
+		if (depthCollision)
+			simulationData.depthViewProjMatrix.GetInverse(&depthInvViewProjMatrix);
+
+		UploadPool& uploadPool = renderFrame.GetUploadPool();
+
+		auto& emitterAllocation = uploadPool.Allocate(emitterDataOffsets.totalSize);
+		UInt8* emitterData = static_cast<UInt8*>(emitterAllocation.mappedPtr);
+		AccessByOffset<Matrix4f&>(emitterData, emitterDataOffsets.worldMatrix) = worldInstance.GetWorldMatrix();
+		AccessByOffset<Matrix4f&>(emitterData, emitterDataOffsets.depthViewProjMatrix) = simulationData.depthViewProjMatrix;
+		AccessByOffset<Matrix4f&>(emitterData, emitterDataOffsets.depthInvViewProjMatrix) = depthInvViewProjMatrix;
+		AccessByOffset<Vector3f&>(emitterData, emitterDataOffsets.depthEyePosition) = simulationData.depthEyePosition;
+		AccessByOffset<float&>(emitterData, emitterDataOffsets.deltaTime) = deltaTime;
+		AccessByOffset<Vector2f&>(emitterData, emitterDataOffsets.depthViewportOffset) = Vector2f(float(simulationData.depthViewport.x), float(simulationData.depthViewport.y));
+		AccessByOffset<Vector2f&>(emitterData, emitterDataOffsets.depthViewportSize) = Vector2f(float(simulationData.depthViewport.width), float(simulationData.depthViewport.height));
+		AccessByOffset<Vector3f&>(emitterData, emitterDataOffsets.gravity) = m_gravity;
+		AccessByOffset<float&>(emitterData, emitterDataOffsets.drag) = m_drag;
+		AccessByOffset<Vector3f&>(emitterData, emitterDataOffsets.spawnExtent) = m_spawnExtent;
+		AccessByOffset<float&>(emitterData, emitterDataOffsets.randomSeed) = float(m_simulationFrame % 1024) + 0.5f; //< kept small for the float hash precision
+		AccessByOffset<Vector3f&>(emitterData, emitterDataOffsets.minVelocity) = m_minVelocity;
+		AccessByOffset<float&>(emitterData, emitterDataOffsets.minLifetime) = m_minLifetime;
+		AccessByOffset<Vector3f&>(emitterData, emitterDataOffsets.maxVelocity) = m_maxVelocity;
+		AccessByOffset<float&>(emitterData, emitterDataOffsets.maxLifetime) = m_maxLifetime;
+		AccessByOffset<Vector4f&>(emitterData, emitterDataOffsets.startColor) = Vector4f(m_startColor.r, m_startColor.g, m_startColor.b, m_startColor.a);
+		AccessByOffset<Vector4f&>(emitterData, emitterDataOffsets.endColor) = Vector4f(m_endColor.r, m_endColor.g, m_endColor.b, m_endColor.a);
+		AccessByOffset<float&>(emitterData, emitterDataOffsets.startSize) = m_startSize;
+		AccessByOffset<float&>(emitterData, emitterDataOffsets.endSize) = m_endSize;
+		AccessByOffset<float&>(emitterData, emitterDataOffsets.restitution) = m_collisionRestitution;
+		AccessByOffset<float&>(emitterData, emitterDataOffsets.collisionThickness) = m_collisionThickness;
+		AccessByOffset<UInt32&>(emitterData, emitterDataOffsets.capacity) = SafeCast<UInt32>(m_maxParticleCount);
+		AccessByOffset<UInt32&>(emitterData, emitterDataOffsets.activeFirst) = SafeCast<UInt32>(activeFirst);
+		AccessByOffset<UInt32&>(emitterData, emitterDataOffsets.activeCount) = SafeCast<UInt32>(activeCount);
+		AccessByOffset<UInt32&>(emitterData, emitterDataOffsets.spawnCount) = SafeCast<UInt32>(spawnCount);
+
+		// The draw command is read by the forward pass command buffers, which are only recorded when their elements change
+		CommandBufferBuilder::DrawIndexedIndirectCommand drawCommand = { 6, SafeCast<UInt32>(activeCount), 0, 0, 0 };
+
+		auto& drawAllocation = uploadPool.Allocate(sizeof(drawCommand));
+		std::memcpy(drawAllocation.mappedPtr, &drawCommand, sizeof(drawCommand));
+
+		// Emitter data and draw command may still be read by the previous frame
+		builder.MemoryBarrier(PipelineStage::ComputeShader | PipelineStage::VertexShader | PipelineStage::DrawIndirect, PipelineStage::Transfer, MemoryAccess::UniformBufferRead | MemoryAccess::IndirectCommandRead, MemoryAccess::TransferWrite);
+
+		builder.CopyBuffer(emitterAllocation, RenderBufferView(m_emitterBuffer.get()));
+		builder.CopyBuffer(drawAllocation, RenderBufferView(m_drawBuffer.get()));
+
+		if (activeCount > 0)
+		{
+			builder.MemoryBarrier(PipelineStage::Transfer | PipelineStage::VertexShader, PipelineStage::ComputeShader, MemoryAccess::TransferWrite | MemoryAccess::ShaderRead, MemoryAccess::UniformBufferRead | MemoryAccess::ShaderRead | MemoryAccess::ShaderWrite);
+
+			builder.BindComputePipeline(*graphics->GetParticleSimulationPipeline(depthCollision));
+			builder.BindComputeShaderBinding(0, *m_simulationShaderBinding);
+			builder.Dispatch(SafeCast<UInt32>((activeCount + 63) / 64), 1, 1);
+		}
+
+		builder.MemoryBarrier(PipelineStage::Transfer | PipelineStage::ComputeShader, PipelineStage::ComputeShader | PipelineStage::VertexShader | PipelineStage::DrawIndirect, MemoryAccess::TransferWrite | MemoryAccess::ShaderWrite, MemoryAccess::UniformBufferRead | MemoryAccess::ShaderRead | MemoryAccess::IndirectCommandRead);
+	}
+
+	void ParticleEmitter::UpdateBounds()
+	{
+		// Conservative bounds of a particle moving at its highest initial speed and pulled by the gravity during its whole lifetime (particles spawned before the emitter moved are not taken into account)
+		float maxSpeed = std::max(m_minVelocity.GetLength(), m_maxVelocity.GetLength());
+		float maxDisplacement = maxSpeed * m_maxLifetime + 0.5f * m_gravity.GetLength() * m_maxLifetime * m_maxLifetime;
+		float halfSize = 0.5f * std::max(m_startSize, m_endSize);
+
+		Vector3f extent = m_spawnExtent + Vector3f(maxDisplacement + halfSize);
+		UpdateAABB(Boxf(-extent, 2.f * extent));
+	}
+}
@@ -0,0 +1,374 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/ParticleRenderer.hpp>
+#include <Nazara/Graphics/Graphics.hpp>
+#include <Nazara/Graphics/ParticleEmitter.hpp>
+#include <Nazara/Graphics/ViewerInstance.hpp>
+#include <Nazara/Renderer/CommandBufferBuilder.hpp>
+#include <Nazara/Renderer/RenderBuffer.hpp>
+#include <Nazara/Renderer/RenderDevice.hpp>
+#include <Nazara/Renderer/RenderFrame.hpp>
+#include <NZSL/Math/FieldOffsets.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	NAZARA_ANONYMOUS_NAMESPACE
+	{
+		// Sorting a few entries is as fast as sorting one workgroup of pairs
+		constexpr std::size_t MinSortEntryCount = 128;
+
+		struct SortStepOffsets
+		{
+			std::size_t blockSize;
+			std::size_t compareDistance;
+			std::size_t totalSize;
+		};
+
+		// Must match ParticleSort shader
+		SortStepOffsets GetSortStepOffsets()
+		{
+			nzsl::FieldOffsets stepStruct(nzsl::StructLayout::Std140);
+
+			SortStepOffsets offsets;
+			offsets.blockSize = stepStruct.AddField(nzsl::StructFieldType::UInt1);
+			offsets.compareDistance = stepStruct.AddField(nzsl::StructFieldType::UInt1);
+			offsets.totalSize = stepStruct.GetAlignedSize();
+
+			return offsets;
+		}
+
+		std::size_t GetSortEntrySize()
+		{
+			nzsl::FieldOffsets entryStruct(nzsl::StructLayout::Std140);
+			entryStruct.AddField(nzsl::StructFieldType::Float1); //< key
+			entryStruct.AddField(nzsl::StructFieldType::UInt1); //< index
+
+			return entryStruct.GetAlignedSize();
+		}
+
+		// A bitonic sort of 2^n entries requires n(n+1)/2 steps
+		constexpr std::size_t GetSortStepCount(std::size_t sortEntryCountLog2)
+		{
+			return sortEntryCountLog2 * (sortEntryCountLog2 + 1) / 2;
+		}
+	}
+
+	/*!
+	* \ingroup graphics
+	* \class ParticleRenderer
+	* \brief Element renderer drawing the particles of emitters with one indirect draw per emitter
+	*
+	* The instance count of draws is written by the emitter simulation, the draw commands can be recorded once and reused while particles are spawned and die.
+	* Alpha-blended particles are sorted back to front for every viewer using a bitonic sort in compute shaders.
+	*/
+	ParticleRenderer::ParticleRenderer(RenderDevice& device) :
+	m_device(device)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		// Particle quads are expanded from their corner index in the vertex shader
+		std::array<UInt16, 6> indices = { 0, 1, 2, 2, 1, 3 };
+		m_indexBuffer = m_device.InstantiateBuffer(BufferType::Index, indices.size() * sizeof(UInt16), BufferUsage::DeviceLocal | BufferUsage::Write, indices.data());
+
+		// Every bitonic sort step (for every supported entry count) is stored once and shared by every emitter, as sorts of 2^n entries are made of the first steps of sorts of 2^(n+1) entries
+		SortStepOffsets sortStepOffsets = GetSortStepOffsets();
+		m_sortStepAlignedSize = AlignPow2(sortStepOffsets.totalSize, SafeCast<std::size_t>(m_device.GetDeviceInfo().limits.minUniformBufferOffsetAlignment));
+
+		std::vector<UInt8> sortSteps(GetSortStepCount(MaxSortEntryCountLog2) * m_sortStepAlignedSize);
+
+		std::size_t stepIndex = 0;
+		for (std::size_t blockSize = 2; blockSize <= (std::size_t(1) << MaxSortEntryCountLog2); blockSize *= 2)
+		{
+			for (std::size_t compareDistance = blockSize / 2; compareDistance > 0; compareDistance /= 2)
+			{
+				UInt8* stepData = &sortSteps[stepIndex * m_sortStepAlignedSize];
+				AccessByOffset<UInt32&>(stepData, sortStepOffsets.blockSize) = SafeCast<UInt32>(blockSize);
+				AccessByOffset<UInt32&>(stepData, sortStepOffsets.compareDistance) = SafeCast<UInt32>(compareDistance);
+
+				stepIndex++;
+			}
+		}
+
+		m_sortStepBuffer = m_device.InstantiateBuffer(BufferType::Uniform, sortSteps.size(), BufferUsage::DeviceLocal | BufferUsage::Write, sortSteps.data());
+	}
+
+	RenderElementPool<RenderParticles>& ParticleRenderer::GetPool()
+	{
+		return m_particlesPool;
+	}
+
+	std::unique_ptr<ElementRendererData> ParticleRenderer::InstanciateData()
+	{
+		return std::make_unique<ParticleRendererData>();
+	}
+
+	void ParticleRenderer::Prepare(const ViewerInstance& viewerInstance, ElementRendererData& rendererData, RenderFrame& currentFrame, std::size_t elementCount, const Pointer<const RenderElement>* elements, const RenderStates* /*renderStates*/)
+	{
+		Graphics* graphics = Graphics::Instance();
+
+		auto& data = static_cast<ParticleRendererData&>(rendererData);
+
+		const auto& defaultSampler = graphics->GetSamplerCache().Get({});
+
+		for (std::size_t i = 0; i < elementCount; ++i)
+		{
+			assert(elements[i]->GetElementType() == UnderlyingCast(BasicRenderElement::Particles));
+			const RenderParticles& renderParticles = static_cast<const RenderParticles&>(*elements[i]);
+			const ParticleEmitter& emitter = renderParticles.GetEmitter();
+
+			auto& emitterData = data.emitters[&emitter];
+			if (emitterData.particleBuffer != emitter.GetParticleBuffer())
+			{
+				// Another emitter was allocated at the address of a released one
+				if (emitterData.particleBuffer)
+					currentFrame.PushForRelease(std::move(emitterData));
+
+				emitterData = ParticleRendererData::EmitterData{};
+				emitterData.particleBuffer = emitter.GetParticleBuffer();
+			}
+			else if (emitterData.isUsed)
+				continue; //< already prepared
+
+			emitterData.isUsed = true;
+
+			bool isSorted = emitter.GetBlendMode() == ParticleBlendMode::AlphaBlend;
+			if (isSorted)
+			{
+				PrepareSorting(viewerInstance, emitter, emitterData);
+				data.sortedEmitters.push_back(&emitter);
+			}
+
+			if (!emitterData.drawShaderBinding || emitterData.texture != emitter.GetTexture().get())
+			{
+				if (emitterData.drawShaderBinding)
+					currentFrame.PushForRelease(std::move(emitterData.drawShaderBinding));
+
+				emitterData.drawShaderBinding = graphics->GetParticleRenderPipelineLayout()->AllocateShaderBinding(0);
+				emitterData.drawShaderBinding->Update({
+					{
+						0,
+						ShaderBinding::UniformBufferBinding {
+							viewerInstance.GetViewerBuffer().get(),
+							0, viewerInstance.GetViewerBuffer()->GetSize()
+						}
+					},
+					{
+						1,
+						ShaderBinding::UniformBufferBinding {
+							emitter.GetEmitterBuffer().get(),
+							0, emitter.GetEmitterBuffer()->GetSize()
+						}
+					},
+					{
+						2,
+						ShaderBinding::StorageBufferBinding {
+							emitter.GetParticleBuffer().get(),
+							0, emitter.GetParticleBuffer()->GetSize()
+						}
+					},
+					{
+						3,
+						ShaderBinding::SampledTextureBinding {
+							emitter.GetTexture().get(),
+							defaultSampler.get()
+						}
+					}
+				});
+
+				if (isSorted)
+				{
+					emitterData.drawShaderBinding->Update({
+						{
+							4,
+							ShaderBinding::StorageBufferBinding {
+								emitterData.sortBuffer.get(),
+								0, emitterData.sortBuffer->GetSize()
+							}
+						}
+					});
+				}
+
+				emitterData.texture = emitter.GetTexture().get();
+			}
+		}
+	}
+
+	void ParticleRenderer::PrepareEnd(RenderFrame& currentFrame, ElementRendererData& rendererData)
+	{
+		auto& data = static_cast<ParticleRendererData&>(rendererData);
+
+		// Release data of emitters which are no longer visible
+		for (auto it = data.emitters.begin(); it != data.emitters.end();)
+		{
+			if (!it->second.isUsed)
+			{
+				currentFrame.PushForRelease(std::move(it->second));
+				it = data.emitters.erase(it);
+			}
+			else
+				++it;
+		}
+	}
+
+	void ParticleRenderer::Render(const ViewerInstance& viewerInstance, ElementRendererData& rendererData, CommandBufferBuilder& commandBuffer, std::size_t elementCount, const Pointer<const RenderElement>* elements)
+	{
+		Graphics* graphics = Graphics::Instance();
+
+		auto& data = static_cast<ParticleRendererData&>(rendererData);
+
+		commandBuffer.BindIndexBuffer(*m_indexBuffer, IndexType::U16);
+
+		Vector2f targetSize = viewerInstance.GetTargetSize();
+		commandBuffer.SetScissor(Recti(0, 0, SafeCast<int>(std::floor(targetSize.x)), SafeCast<int>(std::floor(targetSize.y))));
+
+		for (std::size_t i = 0; i < elementCount; ++i)
+		{
+			const RenderParticles& renderParticles = static_cast<const RenderParticles&>(*elements[i]);
+			const ParticleEmitter& emitter = renderParticles.GetEmitter();
+
+			auto it = data.emitters.find(&emitter);
+			assert(it != data.emitters.end());
+
+			commandBuffer.BindRenderPipeline(*graphics->GetParticleRenderPipeline(emitter.GetBlendMode()));
+			commandBuffer.BindRenderShaderBinding(0, *it->second.drawShaderBinding);
+			commandBuffer.DrawIndexedIndirect(RenderBufferView(emitter.GetDrawBuffer().get()), 1);
+		}
+	}
+
+	void ParticleRenderer::Reset(ElementRendererData& rendererData, RenderFrame& /*currentFrame*/)
+	{
+		auto& data = static_cast<ParticleRendererData&>(rendererData);
+
+		// Emitter data is kept for emitters which are still visible after the next Prepare
+		for (auto&& [emitter, emitterData] : data.emitters)
+			emitterData.isUsed = false;
+
+		data.sortedEmitters.clear();
+	}
+
+	void ParticleRenderer::Update(RenderFrame& currentFrame, ElementRendererData& rendererData)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		auto& data = static_cast<ParticleRendererData&>(rendererData);
+		if (data.sortedEmitters.empty())
+			return;
+
+		Graphics* graphics = Graphics::Instance();
+
+		// Particles move every frame, they are sorted again for the current viewer position every frame
+		currentFrame.Execute([&](CommandBufferBuilder& builder)
+		{
+			builder.BeginDebugRegion("Particle sorting", Color::Orange());
+			{
+				// Sort entries may still be read by the previous frame
+				builder.MemoryBarrier(PipelineStage::VertexShader, PipelineStage::ComputeShader, MemoryAccess::ShaderRead, MemoryAccess::ShaderWrite);
+
+				for (const ParticleEmitter* emitter : data.sortedEmitters)
+				{
+					auto it = data.emitters.find(emitter);
+					assert(it != data.emitters.end());
+
+					const ParticleRendererData::EmitterData& emitterData = it->second;
+
+					builder.BindComputePipeline(*graphics->GetParticleSortKeysPipeline());
+					builder.BindComputeShaderBinding(0, *emitterData.sortKeysShaderBinding);
+					builder.Dispatch(SafeCast<UInt32>(emitterData.sortEntryCount / 64), 1, 1);
+
+					builder.BindComputePipeline(*graphics->GetParticleSortPipeline());
+					for (const ShaderBindingPtr& stepShaderBinding : emitterData.sortStepShaderBindings)
+					{
+						builder.MemoryBarrier(PipelineStage::ComputeShader, PipelineStage::ComputeShader, MemoryAccess::ShaderWrite, MemoryAccess::ShaderRead | MemoryAccess::ShaderWrite);
+
+						builder.BindComputeShaderBinding(0, *stepShaderBinding);
+						builder.Dispatch(SafeCast<UInt32>(emitterData.sortEntryCount / 2 / 64), 1, 1);
+					}
+				}
+
+				builder.MemoryBarrier(PipelineStage::ComputeShader, PipelineStage::VertexShader, MemoryAccess::ShaderWrite, MemoryAccess::ShaderRead);
+			}
+			builder.EndDebugRegion();
+		}, QueueType::Compute);
+	}
+
+	void ParticleRenderer::PrepareSorting(const ViewerInstance& viewerInstance, const ParticleEmitter& emitter, ParticleRendererData::EmitterData& emitterData)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		if (emitterData.sortBuffer)
+			return;
+
+		Graphics* graphics = Graphics::Instance();
+
+		static SortStepOffsets sortStepOffsets = GetSortStepOffsets();
+		static std::size_t sortEntrySize = GetSortEntrySize();
+
+		emitterData.sortEntryCount = std::max<std::size_t>(RoundToPow2(emitter.GetMaxParticleCount()), MinSortEntryCount);
+
+		std::size_t sortEntryCountLog2 = IntegralLog2(emitterData.sortEntryCount);
+		NazaraAssert(sortEntryCountLog2 <= MaxSortEntryCountLog2, "particle emitter has too many particles to be sorted");
+
+		emitterData.sortBuffer = m_device.InstantiateBuffer(BufferType::Storage, emitterData.sortEntryCount * sortEntrySize, BufferUsage::DeviceLocal);
+
+		emitterData.sortKeysShaderBinding = graphics->GetParticleSortKeysPipelineLayout()->AllocateShaderBinding(0);
+		emitterData.sortKeysShaderBinding->Update({
+			{
+				0,
+				ShaderBinding::UniformBufferBinding {
+					viewerInstance.GetViewerBuffer().get(),
+					0, viewerInstance.GetViewerBuffer()->GetSize()
+				}
+			},
+			{
+				1,
+				ShaderBinding::UniformBufferBinding {
+					emitter.GetEmitterBuffer().get(),
+					0, emitter.GetEmitterBuffer()->GetSize()
+				}
+			},
+			{
+				2,
+				ShaderBinding::StorageBufferBinding {
+					emitter.GetParticleBuffer().get(),
+					0, emitter.GetParticleBuffer()->GetSize()
+				}
+			},
+			{
+				3,
+				ShaderBinding::StorageBufferBinding {
+					emitterData.sortBuffer.get(),
+					0, emitterData.sortBuffer->GetSize()
+				}
+			}
+		});
+
+		std::size_t stepCount = GetSortStepCount(sortEntryCountLog2);
+		emitterData.sortStepShaderBindings.reserve(stepCount);
+		for (std::size_t i = 0; i < stepCount; ++i)
+		{
+			ShaderBindingPtr& stepShaderBinding = emitterData.sortStepShaderBindings.emplace_back(graphics->GetParticleSortPipelineLayout()->AllocateShaderBinding(0));
+			stepShaderBinding->Update({
+				{
+					0,
+					ShaderBinding::UniformBufferBinding {
+						m_sortStepBuffer.get(),
+						i * m_sortStepAlignedSize, sortStepOffsets.totalSize
+					}
+				},
+				{
+					1,
+					ShaderBinding::StorageBufferBinding {
+						emitterData.sortBuffer.get(),
+						0, emitterData.sortBuffer->GetSize()
+					}
+				}
+			});
+		}
+	}
+}
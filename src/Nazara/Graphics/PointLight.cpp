@@ -14,10 +14,10 @@
 
 namespace Nz
 {
-	float PointLight::ComputeContributionScore(const BoundingVolumef& boundingVolume) const
+	float PointLight::ComputeContributionScore(const Boxf& worldAABB) const
 	{
 		// TODO: take luminosity/radius into account
-		return Vector3f::SquaredDistance(m_position, boundingVolume.aabb.GetCenter());
+		return Vector3f::SquaredDistance(m_position, worldAABB.GetCenter());
 	}
 
 	void PointLight::FillLightData(void* data) const
@@ -9,6 +9,7 @@
 #include <Nazara/Graphics/Graphics.hpp>
 #include <Nazara/Graphics/PointLight.hpp>
 #include <Nazara/Math/Quaternion.hpp>
+#include <functional>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
@@ -33,11 +34,31 @@ namespace Nz
 			"Point-light shadow mapping -Z",
 			"Point-light shadow mapping +Z"
 		};
+
+		constexpr std::size_t CombineHash(std::size_t currentHash, std::size_t newHash)
+		{
+			return currentHash * 23 + newHash;
+		}
+
+		// Frustum of the whole light range (a cube around the light containing the frustums of the six faces)
+		Frustumf BuildRangeFrustum(const Vector3f& position, float radius)
+		{
+			EnumArray<FrustumPlane, Planef> planes;
+			planes[FrustumPlane::Left]   = Planef( Vector3f::UnitX(), position - Vector3f::UnitX() * radius);
+			planes[FrustumPlane::Right]  = Planef(-Vector3f::UnitX(), position + Vector3f::UnitX() * radius);
+			planes[FrustumPlane::Bottom] = Planef( Vector3f::UnitY(), position - Vector3f::UnitY() * radius);
+			planes[FrustumPlane::Top]    = Planef(-Vector3f::UnitY(), position + Vector3f::UnitY() * radius);
+			planes[FrustumPlane::Near]   = Planef( Vector3f::UnitZ(), position - Vector3f::UnitZ() * radius);
+			planes[FrustumPlane::Far]    = Planef(-Vector3f::UnitZ(), position + Vector3f::UnitZ() * radius);
+
+			return Frustumf(planes);
+		}
 	}
 
 	PointLightShadowData::PointLightShadowData(FramePipeline& pipeline, ElementRendererRegistry& elementRegistry, const PointLight& light) :
 	m_pipeline(pipeline),
-	m_light(light)
+	m_light(light),
+	m_isCullingValid(false)
 	{
 		m_onLightShadowMapSettingChange.Connect(m_light.OnLightShadowMapSettingChange, [this](Light* /*light*/, PixelFormat /*newPixelFormat*/, UInt32 newSize)
 		{
@@ -90,18 +111,74 @@ namespace Nz
 		});
 	}
 
-	void PointLightShadowData::PrepareRendering(RenderFrame& renderFrame)
+	void PointLightShadowData::PrepareRendering(RenderFrame& renderFrame, const AbstractViewer* /*viewer*/)
 	{
-		for (DirectionData& direction : m_directions)
+		std::array<Frustumf, 6> frustums;
+
+		bool shouldCull = !m_isCullingValid;
+		for (std::size_t i = 0; i < m_directions.size(); ++i)
 		{
+			DirectionData& direction = m_directions[i];
+
 			const Matrix4f& viewProjMatrix = direction.viewer.GetViewerInstance().GetViewProjMatrix();
+			frustums[i] = Frustumf::Extract(viewProjMatrix);
 
-			Frustumf frustum = Frustumf::Extract(viewProjMatrix);
+			if (viewProjMatrix != direction.cullingViewProjMatrix)
+			{
+				direction.cullingViewProjMatrix = viewProjMatrix;
+				shouldCull = true;
+			}
+		}
 
+		// Keep the previous culling results as long as neither the light nor the renderables in its range changed
+		Frustumf rangeFrustum = BuildRangeFrustum(m_light.GetPosition(), m_light.GetRadius());
+		if (shouldCull || m_pipeline.IsCullingInvalidated(rangeFrustum))
+		{
+			// Walk the scene once for the whole light range, faces only test the renderables found in it
 			std::size_t visibilityHash = 5U;
-			const auto& visibleRenderables = m_pipeline.FrustumCull(frustum, 0xFFFFFFFF, visibilityHash);
+			m_visibleRenderables = m_pipeline.FrustumCull(rangeFrustum, 0xFFFFFFFF, visibilityHash);
 
-			direction.depthPass->Prepare(renderFrame, frustum, visibleRenderables, visibilityHash);
+			m_visibleFaceMasks.resize(m_visibleRenderables.size());
+			for (std::size_t i = 0; i < m_visibleRenderables.size(); ++i)
+			{
+				UInt8 faceMask = 0;
+				for (std::size_t faceIndex = 0; faceIndex < frustums.size(); ++faceIndex)
+				{
+					if (frustums[faceIndex].Intersect(m_visibleRenderables[i].worldAABB) != IntersectionSide::Outside)
+						faceMask |= UInt8(1U << faceIndex);
+				}
+
+				m_visibleFaceMasks[i] = faceMask;
+			}
+
+			for (std::size_t faceIndex = 0; faceIndex < m_directions.size(); ++faceIndex)
+			{
+				DirectionData& direction = m_directions[faceIndex];
+				direction.visibleRenderables.clear();
+
+				// Each face hashes its own renderables, so that its elements are only rebuilt if they changed
+				direction.visibilityHash = 5U;
+				for (std::size_t i = 0; i < m_visibleRenderables.size(); ++i)
+				{
+					if ((m_visibleFaceMasks[i] & (1U << faceIndex)) == 0)
+						continue;
+
+					const FramePipelinePass::VisibleRenderable& visibleRenderable = m_visibleRenderables[i];
+					direction.visibleRenderables.push_back(visibleRenderable);
+
+					direction.visibilityHash = CombineHash(direction.visibilityHash, std::hash<const void*>()(visibleRenderable.instancedRenderable));
+					direction.visibilityHash = CombineHash(direction.visibilityHash, std::hash<const void*>()(visibleRenderable.worldInstance));
+					direction.visibilityHash = CombineHash(direction.visibilityHash, std::hash<const void*>()(visibleRenderable.skeletonInstance));
+				}
+			}
+
+			m_isCullingValid = true;
+		}
+
+		for (std::size_t i = 0; i < m_directions.size(); ++i)
+		{
+			DirectionData& direction = m_directions[i];
+			direction.depthPass->Prepare(renderFrame, frustums[i], direction.visibleRenderables, direction.visibilityHash);
 		}
 	}
 
@@ -111,7 +188,7 @@ namespace Nz
 			direction.depthPass->RegisterMaterialInstance(matInstance);
 	}
 
-	void PointLightShadowData::RegisterPassInputs(FramePass& pass)
+	void PointLightShadowData::RegisterPassInputs(FramePass& pass, const AbstractViewer* /*viewer*/)
 	{
 		std::size_t cubeInputIndex = pass.AddInput(m_cubeAttachmentIndex);
 		pass.SetInputLayout(cubeInputIndex, TextureLayout::ColorInput);
@@ -120,7 +197,7 @@ namespace Nz
 			pass.AddInput(direction.attachmentIndex);
 	}
 
-	void PointLightShadowData::RegisterToFrameGraph(FrameGraph& frameGraph)
+	void PointLightShadowData::RegisterToFrameGraph(FrameGraph& frameGraph, const AbstractViewer* /*viewer*/)
 	{
 		UInt32 shadowMapSize = m_light.GetShadowMapSize();
 
@@ -139,7 +216,7 @@ namespace Nz
 		}
 	}
 
-	const Texture* PointLightShadowData::RetrieveLightShadowmap(const BakedFrameGraph& bakedGraph) const
+	const Texture* PointLightShadowData::RetrieveLightShadowmap(const BakedFrameGraph& bakedGraph, const AbstractViewer* /*viewer*/) const
 	{
 		return bakedGraph.GetAttachmentTexture(m_cubeAttachmentIndex).get();
 	}
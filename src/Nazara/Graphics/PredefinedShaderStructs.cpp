@@ -22,12 +22,23 @@ namespace Nz
 		lightData.lightMemberOffsets.parameter3 = lightStruct.AddField(nzsl::StructFieldType::Float4);
 		lightData.lightMemberOffsets.shadowMapSize = lightStruct.AddField(nzsl::StructFieldType::Float2);
 		lightData.lightMemberOffsets.viewProjMatrix = lightStruct.AddMatrix(nzsl::StructFieldType::Float1, 4, 4, true);
+		lightData.lightMemberOffsets.cascadeCount = lightStruct.AddField(nzsl::StructFieldType::UInt1);
+		lightData.lightMemberOffsets.cascadeDistances = lightStruct.AddField(nzsl::StructFieldType::Float4);
+		lightData.lightMemberOffsets.cascadeViewProjMatrices = lightStruct.AddMatrixArray(nzsl::StructFieldType::Float1, 4, 4, true, MaxLightCascadeCount);
 
 		lightData.lightSize = lightStruct.GetAlignedSize();
 
 		nzsl::FieldOffsets lightDataStruct(nzsl::StructLayout::Std140);
-		lightData.lightsOffset = lightDataStruct.AddStructArray(lightStruct, MaxLightCount);
+		lightData.clusterCountXOffset = lightDataStruct.AddField(nzsl::StructFieldType::UInt1);
+		lightData.clusterCountYOffset = lightDataStruct.AddField(nzsl::StructFieldType::UInt1);
+		lightData.clusterCountZOffset = lightDataStruct.AddField(nzsl::StructFieldType::UInt1);
+		lightData.clusterStrideOffset = lightDataStruct.AddField(nzsl::StructFieldType::UInt1);
 		lightData.lightCountOffset = lightDataStruct.AddField(nzsl::StructFieldType::UInt1);
+		lightData.globalLightCountOffset = lightDataStruct.AddField(nzsl::StructFieldType::UInt1);
+		lightData.shadowedLightCountOffset = lightDataStruct.AddField(nzsl::StructFieldType::UInt1);
+		lightData.zNearOffset = lightDataStruct.AddField(nzsl::StructFieldType::Float1);
+		lightData.zFarOffset = lightDataStruct.AddField(nzsl::StructFieldType::Float1);
+		lightData.depthSliceScaleOffset = lightDataStruct.AddField(nzsl::StructFieldType::Float1);
 
 		lightData.totalSize = lightDataStruct.GetAlignedSize();
 
@@ -48,6 +59,45 @@ namespace Nz
 		return instanceData;
 	}
 
+	// PredefinedInstanceAnimationArrayData
+	PredefinedInstanceAnimationArrayData PredefinedInstanceAnimationArrayData::GetOffsets()
+	{
+		PredefinedInstanceAnimationArrayData instanceAnimationArrayData;
+
+		nzsl::FieldOffsets instanceAnimationStruct(nzsl::StructLayout::Std140);
+		instanceAnimationArrayData.instanceMemberOffsets.frameCoords = instanceAnimationStruct.AddField(nzsl::StructFieldType::Float2);
+		instanceAnimationArrayData.instanceMemberOffsets.interpolation = instanceAnimationStruct.AddField(nzsl::StructFieldType::Float1);
+		instanceAnimationArrayData.instanceMemberOffsets.texelWidth = instanceAnimationStruct.AddField(nzsl::StructFieldType::Float1);
+
+		instanceAnimationArrayData.instanceStride = instanceAnimationStruct.GetAlignedSize();
+
+		nzsl::FieldOffsets instanceAnimationArrayStruct(nzsl::StructLayout::Std140);
+		instanceAnimationArrayData.instancesOffset = instanceAnimationArrayStruct.AddStructArray(instanceAnimationStruct, PredefinedInstanceArrayData::MaxInstanceCount);
+
+		instanceAnimationArrayData.totalSize = instanceAnimationArrayStruct.GetAlignedSize();
+
+		return instanceAnimationArrayData;
+	}
+
+	// PredefinedInstanceArrayData
+	PredefinedInstanceArrayData PredefinedInstanceArrayData::GetOffsets()
+	{
+		nzsl::FieldOffsets instanceStruct(nzsl::StructLayout::Std140);
+		instanceStruct.AddMatrix(nzsl::StructFieldType::Float1, 4, 4, true);
+		instanceStruct.AddMatrix(nzsl::StructFieldType::Float1, 4, 4, true);
+
+		nzsl::FieldOffsets instanceArrayStruct(nzsl::StructLayout::Std140);
+
+		PredefinedInstanceArrayData instanceArrayData;
+		instanceArrayData.instanceMemberOffsets = PredefinedInstanceData::GetOffsets();
+		instanceArrayData.instanceStride = instanceStruct.GetAlignedSize();
+		instanceArrayData.instancesOffset = instanceArrayStruct.AddStructArray(instanceStruct, MaxInstanceCount);
+
+		instanceArrayData.totalSize = instanceArrayStruct.GetAlignedSize();
+
+		return instanceArrayData;
+	}
+
 	// PredefinedSkeletalData
 	PredefinedSkeletalData PredefinedSkeletalData::GetOffsets()
 	{
@@ -61,6 +111,29 @@ namespace Nz
 		return skeletalData;
 	}
 
+	// PredefinedSkinningData
+	PredefinedSkinningData PredefinedSkinningData::GetOffsets()
+	{
+		nzsl::FieldOffsets vertexStruct(nzsl::StructLayout::Std140);
+
+		PredefinedSkinningData skinningData;
+		skinningData.vertexMemberOffsets.position = vertexStruct.AddField(nzsl::StructFieldType::Float3);
+		skinningData.vertexMemberOffsets.normal = vertexStruct.AddField(nzsl::StructFieldType::Float3);
+		skinningData.vertexMemberOffsets.tangent = vertexStruct.AddField(nzsl::StructFieldType::Float3);
+		skinningData.vertexMemberOffsets.uv = vertexStruct.AddField(nzsl::StructFieldType::Float2);
+		skinningData.vertexMemberOffsets.jointWeights = vertexStruct.AddField(nzsl::StructFieldType::Float4);
+		skinningData.vertexMemberOffsets.jointIndices = vertexStruct.AddField(nzsl::StructFieldType::Int4);
+
+		skinningData.vertexSize = vertexStruct.GetAlignedSize();
+
+		// Vertices are a dynamic array after the vertex count
+		nzsl::FieldOffsets skinningStruct(nzsl::StructLayout::Std140);
+		skinningData.vertexCountOffset = skinningStruct.AddField(nzsl::StructFieldType::UInt1);
+		skinningData.verticesOffset = skinningStruct.AddStructArray(vertexStruct, 1);
+
+		return skinningData;
+	}
+
 	// PredefinedViewerData
 	PredefinedViewerData PredefinedViewerData::GetOffsets()
 	{
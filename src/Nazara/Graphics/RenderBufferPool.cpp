@@ -3,7 +3,11 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Graphics/RenderBufferPool.hpp>
+#include <Nazara/Renderer/CommandBufferBuilder.hpp>
 #include <Nazara/Renderer/RenderDevice.hpp>
+#include <Nazara/Renderer/RenderFrame.hpp>
+#include <Nazara/Renderer/UploadPool.hpp>
+#include <cstring>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
@@ -12,7 +16,8 @@ namespace Nz
 	m_bufferPerBlock(bufferPerBlock),
 	m_bufferSize(bufferSize),
 	m_renderDevice(std::move(renderDevice)),
-	m_bufferType(bufferType)
+	m_bufferType(bufferType),
+	m_isTransferQueued(false)
 	{
 		m_bufferAlignedSize = m_bufferSize;
 
@@ -37,27 +42,38 @@ namespace Nz
 	{
 		// First try to fetch from an already allocated block
 		index = m_availableEntries.FindFirst();
-		if (index != m_availableEntries.npos)
+		if (index == m_availableEntries.npos)
 		{
-			std::size_t blockIndex = index / m_bufferPerBlock;
-			m_availableEntries.Set(index, false);
+			// Allocate a new block
+			std::size_t blockIndex = m_bufferBlocks.size();
 
-			std::size_t localIndex = index - (blockIndex * m_bufferPerBlock); //< faster than index % m_bufferPerBlock
+			auto& bufferBlock = m_bufferBlocks.emplace_back();
+			bufferBlock.buffer = m_renderDevice->InstantiateBuffer(m_bufferType, m_bufferAlignedSize * m_bufferPerBlock, BufferUsage::DeviceLocal);
+			bufferBlock.data.resize(m_bufferAlignedSize * m_bufferPerBlock);
 
-			return RenderBufferView(m_bufferBlocks[blockIndex].get(), localIndex * m_bufferAlignedSize, m_bufferSize);
-		}
+			m_availableEntries.Resize(m_availableEntries.GetSize() + m_bufferPerBlock, true);
+			m_dirtyEntries.Resize(m_availableEntries.GetSize(), false);
 
-		// Allocate a new block
-		std::size_t blockIndex = m_bufferBlocks.size();
-		m_bufferBlocks.emplace_back(m_renderDevice->InstantiateBuffer(m_bufferType, m_bufferAlignedSize * m_bufferPerBlock, BufferUsage::DeviceLocal));
-		m_availableEntries.Resize(m_availableEntries.GetSize() + m_bufferPerBlock, true);
+			index = blockIndex * m_bufferPerBlock;
+		}
 
-		index = blockIndex * m_bufferPerBlock;
+		std::size_t blockIndex = index / m_bufferPerBlock;
 		m_availableEntries.Set(index, false);
 
 		std::size_t localIndex = index - (blockIndex * m_bufferPerBlock); //< faster than index % m_bufferPerBlock
 
-		return RenderBufferView(m_bufferBlocks[blockIndex].get(), localIndex * m_bufferAlignedSize, m_bufferSize);
+		// Buffers start zero-initialized, upload it in case the content is not fully updated
+		auto& bufferBlock = m_bufferBlocks[blockIndex];
+		std::memset(&bufferBlock.data[localIndex * m_bufferAlignedSize], 0, m_bufferSize);
+		m_dirtyEntries.Set(index, true);
+
+		if (!m_isTransferQueued)
+		{
+			m_isTransferQueued = true;
+			OnTransferRequired(this);
+		}
+
+		return RenderBufferView(bufferBlock.buffer.get(), localIndex * m_bufferAlignedSize, m_bufferSize);
 	}
 
 	void RenderBufferPool::Free(std::size_t index)
@@ -65,5 +81,74 @@ namespace Nz
 		NazaraAssert(!m_availableEntries.Test(index), "index is not a currently active buffer");
 
 		m_availableEntries.Set(index, true);
+		m_dirtyEntries.Set(index, false);
+	}
+
+	void RenderBufferPool::OnTransfer(RenderFrame& renderFrame, CommandBufferBuilder& builder)
+	{
+		if (!m_isTransferQueued)
+			return;
+
+		UploadPool& uploadPool = renderFrame.GetUploadPool();
+
+		auto UploadRange = [&](std::size_t firstIndex, std::size_t lastIndex)
+		{
+			std::size_t blockIndex = firstIndex / m_bufferPerBlock;
+			std::size_t localIndex = firstIndex - (blockIndex * m_bufferPerBlock);
+
+			UInt64 offset = localIndex * m_bufferAlignedSize;
+			UInt64 size = (lastIndex - firstIndex) * m_bufferAlignedSize + m_bufferSize;
+
+			auto& bufferBlock = m_bufferBlocks[blockIndex];
+
+			auto& allocation = uploadPool.Allocate(size);
+			std::memcpy(allocation.mappedPtr, &bufferBlock.data[offset], size);
+
+			builder.CopyBuffer(allocation, RenderBufferView(bufferBlock.buffer.get(), offset, size));
+		};
+
+		// Merge dirty entries (and the few clean entries between them) of a block into a single copy
+		std::size_t firstIndex = m_dirtyEntries.FindFirst();
+		std::size_t lastIndex = firstIndex;
+		while (firstIndex != m_dirtyEntries.npos)
+		{
+			std::size_t nextIndex = m_dirtyEntries.FindNext(lastIndex);
+			if (nextIndex != m_dirtyEntries.npos && nextIndex - lastIndex <= MaxMergedCleanEntries + 1 && nextIndex / m_bufferPerBlock == firstIndex / m_bufferPerBlock)
+			{
+				lastIndex = nextIndex;
+				continue;
+			}
+
+			UploadRange(firstIndex, lastIndex);
+
+			firstIndex = nextIndex;
+			lastIndex = nextIndex;
+		}
+
+		m_dirtyEntries.Reset();
+		m_isTransferQueued = false;
+	}
+
+	/*!
+	* \brief Updates part of a buffer content
+	*
+	* The data is copied right away to the CPU copy of the buffer and will be uploaded on the next OnTransfer call
+	*/
+	void RenderBufferPool::Update(std::size_t index, UInt64 offset, UInt64 size, const void* data)
+	{
+		NazaraAssert(!m_availableEntries.Test(index), "index is not a currently active buffer");
+		NazaraAssert(offset + size <= m_bufferSize, "update out of buffer range");
+
+		std::size_t blockIndex = index / m_bufferPerBlock;
+		std::size_t localIndex = index - (blockIndex * m_bufferPerBlock); //< faster than index % m_bufferPerBlock
+
+		std::memcpy(&m_bufferBlocks[blockIndex].data[localIndex * m_bufferAlignedSize + offset], data, size);
+		m_dirtyEntries.Set(index, true);
+
+		if (!m_isTransferQueued)
+		{
+			m_isTransferQueued = true;
+			OnTransferRequired(this);
+		}
 	}
 }
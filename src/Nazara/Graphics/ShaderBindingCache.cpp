@@ -0,0 +1,163 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/ShaderBindingCache.hpp>
+#include <Nazara/Core/Algorithm.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Renderer/RenderBuffer.hpp>
+#include <Nazara/Renderer/RenderFrame.hpp>
+#include <Nazara/Renderer/RenderPipelineLayout.hpp>
+#include <Nazara/Renderer/Texture.hpp>
+#include <Nazara/Renderer/TextureSampler.hpp>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		UInt64 GetResourceId(const RenderBuffer* buffer)
+		{
+			return (buffer) ? buffer->GetResourceId() : 0;
+		}
+
+		UInt64 GetResourceId(const Texture* texture)
+		{
+			return (texture) ? texture->GetResourceId() : 0;
+		}
+
+		UInt64 GetResourceId(const TextureSampler* sampler)
+		{
+			return (sampler) ? sampler->GetResourceId() : 0;
+		}
+	}
+
+	/*!
+	* \brief Retrieves a shader binding matching the bindings, allocating and updating a new one if none exists
+	* \return Shader binding which has to be released (using Release) when it's no longer used
+	*
+	* \param pipelineLayout Pipeline layout to allocate the shader binding from
+	* \param setIndex Binding set index
+	* \param bindings Bindings the shader binding should hold
+	* \param bindingCount Binding count
+	*/
+	const ShaderBinding* ShaderBindingCache::Acquire(const std::shared_ptr<RenderPipelineLayout>& pipelineLayout, UInt32 setIndex, const ShaderBinding::Binding* bindings, std::size_t bindingCount)
+	{
+		NazaraAssert(pipelineLayout, "invalid pipeline layout");
+
+		m_lookupKey.pipelineLayout = pipelineLayout.get();
+		m_lookupKey.setIndex = setIndex;
+		BuildSignature(bindings, bindingCount);
+
+		auto it = m_entries.find(m_lookupKey);
+		if (it == m_entries.end())
+		{
+			ShaderBindingPtr shaderBinding = pipelineLayout->AllocateShaderBinding(setIndex);
+			shaderBinding->Update(bindings, bindingCount);
+
+			Entry entry;
+			entry.pipelineLayout = pipelineLayout;
+			entry.shaderBinding = std::move(shaderBinding);
+
+			it = m_entries.emplace(m_lookupKey, std::move(entry)).first;
+			m_entryByBinding.emplace(it->second.shaderBinding.get(), &*it);
+		}
+
+		Entry& entry = it->second;
+		entry.referenceCount++;
+
+		return entry.shaderBinding.get();
+	}
+
+	/*!
+	* \brief Releases a shader binding retrieved by Acquire
+	*
+	* The shader binding is kept alive until it hasn't been acquired for a few frames (see Update)
+	*/
+	void ShaderBindingCache::Release(const ShaderBinding* shaderBinding)
+	{
+		auto it = m_entryByBinding.find(shaderBinding);
+		NazaraAssert(it != m_entryByBinding.end(), "shader binding is not part of this cache");
+
+		Entry& entry = it->second->second;
+		NazaraAssert(entry.referenceCount > 0, "shader binding has already been released");
+
+		entry.referenceCount--;
+		entry.lastReleaseFrame = m_frameIndex;
+	}
+
+	/*!
+	* \brief Advances the cache by a frame, releasing shader bindings which weren't used for long enough
+	*
+	* \param renderFrame Frame used to delay the destruction of the expired shader bindings until the GPU is done with them
+	*/
+	void ShaderBindingCache::Update(RenderFrame& renderFrame)
+	{
+		m_frameIndex++;
+
+		for (auto it = m_entries.begin(); it != m_entries.end();)
+		{
+			Entry& entry = it->second;
+			if (entry.referenceCount == 0 && m_frameIndex - entry.lastReleaseFrame > m_expirationFrameCount)
+			{
+				m_entryByBinding.erase(entry.shaderBinding.get());
+
+				// Release are processed in order, the layout will outlive the shader binding
+				renderFrame.PushForRelease(std::move(entry.shaderBinding));
+				renderFrame.PushForRelease(std::move(entry.pipelineLayout));
+
+				it = m_entries.erase(it);
+			}
+			else
+				++it;
+		}
+	}
+
+	void ShaderBindingCache::BuildSignature(const ShaderBinding::Binding* bindings, std::size_t bindingCount)
+	{
+		std::vector<UInt64>& signature = m_lookupKey.signature;
+		signature.clear();
+
+		for (std::size_t i = 0; i < bindingCount; ++i)
+		{
+			const ShaderBinding::Binding& binding = bindings[i];
+			signature.push_back(binding.bindingIndex);
+			signature.push_back(binding.content.index());
+
+			std::visit([&](auto&& arg)
+			{
+				using T = std::decay_t<decltype(arg)>;
+
+				if constexpr (std::is_same_v<T, ShaderBinding::SampledTextureBinding>)
+				{
+					signature.push_back(GetResourceId(arg.texture));
+					signature.push_back(GetResourceId(arg.sampler));
+				}
+				else if constexpr (std::is_same_v<T, ShaderBinding::SampledTextureBindings>)
+				{
+					signature.push_back(arg.arraySize);
+					signature.push_back(arg.firstArrayElement);
+					for (UInt32 j = 0; j < arg.arraySize; ++j)
+					{
+						signature.push_back(GetResourceId(arg.textureBindings[j].texture));
+						signature.push_back(GetResourceId(arg.textureBindings[j].sampler));
+					}
+				}
+				else if constexpr (std::is_same_v<T, ShaderBinding::StorageBufferBinding> || std::is_same_v<T, ShaderBinding::UniformBufferBinding>)
+				{
+					signature.push_back(GetResourceId(arg.buffer));
+					signature.push_back(arg.offset);
+					signature.push_back(arg.range);
+				}
+				else if constexpr (std::is_same_v<T, ShaderBinding::TextureBinding>)
+				{
+					signature.push_back(GetResourceId(arg.texture));
+					signature.push_back(UInt64(arg.access));
+				}
+				else
+					static_assert(AlwaysFalse<T>::value, "non-exhaustive visitor");
+
+			}, binding.content);
+		}
+	}
+}
@@ -182,6 +182,10 @@ namespace Nz
 			if (!member.type.IsResultingValue())
 				throw std::runtime_error("unresolved member " + member.name + " type in struct " + node.description.name);
 
+			// Runtime-sized arrays (always last) don't contribute to the struct size
+			if (nzsl::Ast::IsDynArrayType(member.type.GetResultingValue()))
+				continue;
+
 			std::size_t offset = nzsl::Ast::RegisterStructField(structData.fieldOffsets, member.type.GetResultingValue(), [&](std::size_t structIndex) -> const nzsl::FieldOffsets&
 			{
 				auto it = m_structs.find(structIndex);
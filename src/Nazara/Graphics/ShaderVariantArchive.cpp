@@ -0,0 +1,308 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/ShaderVariantArchive.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/File.hpp>
+#include <NZSL/Ast/AstSerializer.hpp>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		constexpr UInt32 ArchiveMagic = 0x56535A4E; //< 'NZSV'
+		constexpr UInt32 ArchiveVersion = 2;
+
+		struct ArchiveHeader
+		{
+			UInt32 magic;
+			UInt32 version;
+			UInt32 variantCount;
+		};
+
+		struct VariantHeader
+		{
+			UInt64 variantHash;
+			UInt64 moduleHash;
+			UInt32 language;
+			UInt32 dataSize;
+		};
+
+		// FNV-1a, std::hash is not guaranteed to give the same results across runs and implementations
+		constexpr UInt64 FnvOffsetBasis = 14695981039346656037ULL;
+		constexpr UInt64 FnvPrime = 1099511628211ULL;
+
+		void HashBytes(UInt64& hash, const void* data, std::size_t size)
+		{
+			const UInt8* bytes = static_cast<const UInt8*>(data);
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				hash ^= bytes[i];
+				hash *= FnvPrime;
+			}
+		}
+	}
+
+	/*!
+	* \ingroup graphics
+	* \class Nz::ShaderVariantArchive
+	* \brief Graphics class storing precompiled shader variants, allowing UberShader to skip shader compilation
+	*
+	* Variants are stored in the language the render backend would have compiled them to (SPIR-V for Vulkan, sanitized NZSL binary for OpenGL)
+	* and are identified by a hash of the shader module name, of its content and of the option values, so variants of an edited module are never used.
+	*
+	* \remark This class is thread-safe
+	*/
+
+	/*!
+	* \brief Adds a variant to the archive
+	*
+	* \param variantHash Hash of the variant, as computed by ComputeVariantHash
+	* \param variant Compiled variant
+	*
+	* \remark An archive only stores one language per variant, a variant added previously with the same hash is kept
+	*/
+	void ShaderVariantArchive::AddVariant(UInt64 variantHash, std::shared_ptr<const Variant> variant)
+	{
+		NazaraAssert(variant, "invalid variant");
+
+		std::lock_guard lock(m_mutex);
+		m_variants.try_emplace(variantHash, std::move(variant));
+	}
+
+	void ShaderVariantArchive::Clear()
+	{
+		std::lock_guard lock(m_mutex);
+		m_variants.clear();
+	}
+
+	/*!
+	* \brief Looks for a variant in the archive
+	* \return Variant if found or nullptr
+	*
+	* \param variantHash Hash of the variant, as computed by ComputeVariantHash
+	* \param moduleHash Hash of the shader module, as computed by ComputeModuleHash
+	* \param language Language the render backend expects
+	*
+	* \remark The returned variant stays valid even if the archive is cleared or loaded again
+	*/
+	auto ShaderVariantArchive::FindVariant(UInt64 variantHash, UInt64 moduleHash, ShaderLanguage language) const -> std::shared_ptr<const Variant>
+	{
+		std::lock_guard lock(m_mutex);
+
+		auto it = m_variants.find(variantHash);
+		if (it == m_variants.end() || it->second->moduleHash != moduleHash || it->second->language != language)
+			return nullptr;
+
+		return it->second;
+	}
+
+	std::size_t ShaderVariantArchive::GetVariantCount() const
+	{
+		std::lock_guard lock(m_mutex);
+		return m_variants.size();
+	}
+
+	/*!
+	* \brief Replaces the archive content by the variants stored in a file
+	* \return True if the file was loaded
+	*
+	* \param filePath Path to an archive saved by SaveToFile
+	*/
+	bool ShaderVariantArchive::LoadFromFile(const std::filesystem::path& filePath)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		std::optional<std::vector<UInt8>> fileContent = File::ReadWhole(filePath);
+		if (!fileContent)
+		{
+			NazaraError("failed to read shader variant archive {0}", filePath);
+			return false;
+		}
+
+		const UInt8* ptr = fileContent->data();
+		const UInt8* end = ptr + fileContent->size();
+
+		ArchiveHeader header;
+		if (fileContent->size() < sizeof(header))
+		{
+			NazaraError("shader variant archive {0} is truncated", filePath);
+			return false;
+		}
+
+		std::memcpy(&header, ptr, sizeof(header));
+		ptr += sizeof(header);
+
+		if (header.magic != ArchiveMagic || header.version != ArchiveVersion)
+		{
+			NazaraError("{0} is not a shader variant archive or was created by another engine version", filePath);
+			return false;
+		}
+
+		std::unordered_map<UInt64, std::shared_ptr<const Variant>> variants;
+		variants.reserve(header.variantCount);
+
+		for (UInt32 i = 0; i < header.variantCount; ++i)
+		{
+			VariantHeader variantHeader;
+			if (static_cast<std::size_t>(end - ptr) < sizeof(variantHeader))
+			{
+				NazaraError("shader variant archive {0} is truncated", filePath);
+				return false;
+			}
+
+			std::memcpy(&variantHeader, ptr, sizeof(variantHeader));
+			ptr += sizeof(variantHeader);
+
+			if (static_cast<std::size_t>(end - ptr) < variantHeader.dataSize)
+			{
+				NazaraError("shader variant archive {0} is truncated", filePath);
+				return false;
+			}
+
+			Variant variant;
+			variant.language = static_cast<ShaderLanguage>(variantHeader.language);
+			variant.moduleHash = variantHeader.moduleHash;
+			variant.data.assign(ptr, ptr + variantHeader.dataSize);
+			ptr += variantHeader.dataSize;
+
+			variants.try_emplace(variantHeader.variantHash, std::make_shared<const Variant>(std::move(variant)));
+		}
+
+		std::lock_guard lock(m_mutex);
+		m_variants = std::move(variants);
+
+		return true;
+	}
+
+	/*!
+	* \brief Saves the archive content to a file
+	* \return True if the file was written
+	*
+	* \param filePath Path of the archive file
+	*/
+	bool ShaderVariantArchive::SaveToFile(const std::filesystem::path& filePath) const
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		std::vector<UInt8> fileContent;
+		{
+			std::lock_guard lock(m_mutex);
+
+			std::size_t fileSize = sizeof(ArchiveHeader);
+			for (const auto& [variantHash, variant] : m_variants)
+				fileSize += sizeof(VariantHeader) + variant->data.size();
+
+			fileContent.resize(fileSize);
+			UInt8* ptr = fileContent.data();
+
+			ArchiveHeader header;
+			header.magic = ArchiveMagic;
+			header.version = ArchiveVersion;
+			header.variantCount = SafeCast<UInt32>(m_variants.size());
+
+			std::memcpy(ptr, &header, sizeof(header));
+			ptr += sizeof(header);
+
+			for (const auto& [variantHash, variant] : m_variants)
+			{
+				VariantHeader variantHeader;
+				variantHeader.variantHash = variantHash;
+				variantHeader.moduleHash = variant->moduleHash;
+				variantHeader.language = static_cast<UInt32>(variant->language);
+				variantHeader.dataSize = SafeCast<UInt32>(variant->data.size());
+
+				std::memcpy(ptr, &variantHeader, sizeof(variantHeader));
+				ptr += sizeof(variantHeader);
+
+				if (!variant->data.empty())
+				{
+					std::memcpy(ptr, variant->data.data(), variant->data.size());
+					ptr += variant->data.size();
+				}
+			}
+		}
+
+		if (!File::WriteWhole(filePath, fileContent.data(), fileContent.size()))
+		{
+			NazaraError("failed to write shader variant archive {0}", filePath);
+			return false;
+		}
+
+		return true;
+	}
+
+	/*!
+	* \brief Computes a hash of a shader module content, which stays the same across runs as long as the module isn't edited
+	* \return Module hash
+	*
+	* \param module Shader module
+	*/
+	UInt64 ShaderVariantArchive::ComputeModuleHash(const nzsl::Ast::Module& module)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		nzsl::Serializer serializer;
+		nzsl::Ast::SerializeShader(serializer, module);
+
+		const std::vector<UInt8>& data = serializer.GetData();
+
+		UInt64 hash = FnvOffsetBasis;
+		HashBytes(hash, data.data(), data.size());
+
+		return hash;
+	}
+
+	/*!
+	* \brief Computes a hash identifying a shader variant, which stays the same across runs
+	* \return Variant hash
+	*
+	* \param moduleName Name of the shader module
+	* \param moduleHash Hash of the shader module, as computed by ComputeModuleHash
+	* \param config Option values the variant is compiled with
+	*/
+	UInt64 ShaderVariantArchive::ComputeVariantHash(std::string_view moduleName, UInt64 moduleHash, const UberShader::Config& config)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		UInt64 hash = FnvOffsetBasis;
+		HashBytes(hash, moduleName.data(), moduleName.size());
+		HashBytes(hash, &moduleHash, sizeof(moduleHash));
+
+		// Option values are stored in an unordered map, sort them to get the same hash for the same config
+		std::vector<UInt32> optionHashes;
+		optionHashes.reserve(config.optionValues.size());
+		for (const auto& [optionHash, optionValue] : config.optionValues)
+			optionHashes.push_back(optionHash);
+
+		std::sort(optionHashes.begin(), optionHashes.end());
+
+		for (UInt32 optionHash : optionHashes)
+		{
+			const nzsl::Ast::ConstantSingleValue& optionValue = config.optionValues.at(optionHash);
+
+			HashBytes(hash, &optionHash, sizeof(optionHash));
+
+			UInt32 typeIndex = SafeCast<UInt32>(optionValue.index());
+			HashBytes(hash, &typeIndex, sizeof(typeIndex));
+
+			std::visit([&](auto&& arg)
+			{
+				using T = std::decay_t<decltype(arg)>;
+
+				if constexpr (std::is_same_v<T, std::string>)
+					HashBytes(hash, arg.data(), arg.size());
+				else if constexpr (!std::is_same_v<T, nzsl::Ast::NoValue>)
+					HashBytes(hash, &arg, sizeof(arg));
+			}, optionValue);
+		}
+
+		return hash;
+	}
+}
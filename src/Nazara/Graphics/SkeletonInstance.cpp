@@ -4,19 +4,26 @@
 
 #include <Nazara/Graphics/SkeletonInstance.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Graphics/GraphicalMesh.hpp>
 #include <Nazara/Graphics/Graphics.hpp>
 #include <Nazara/Graphics/PredefinedShaderStructs.hpp>
 #include <Nazara/Renderer/CommandBufferBuilder.hpp>
 #include <Nazara/Renderer/RenderFrame.hpp>
 #include <Nazara/Renderer/UploadPool.hpp>
 #include <Nazara/Utility/Joint.hpp>
+#include <algorithm>
+#include <cstring>
+#include <limits>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
 {
 	SkeletonInstance::SkeletonInstance(std::shared_ptr<const Skeleton> skeleton) :
 	m_skeleton(std::move(skeleton)),
-	m_dataInvalided(true)
+	m_invalidatedJointBegin(0),
+	m_invalidatedJointEnd(std::numeric_limits<std::size_t>::max()),
+	m_dataInvalided(true),
+	m_skinningPending(false)
 	{
 		NazaraAssert(m_skeleton, "invalid skeleton");
 
@@ -24,25 +31,158 @@ namespace Nz
 
 		m_skeletalDataBuffer = Graphics::Instance()->GetRenderDevice()->InstantiateBuffer(BufferType::Uniform, skeletalUboOffsets.totalSize, BufferUsage::DeviceLocal | BufferUsage::Dynamic | BufferUsage::Write);
 		m_skeletalDataBuffer->UpdateDebugName("Skeletal data");
-		m_onSkeletonJointsInvalidated.Connect(m_skeleton->OnSkeletonJointsInvalidated, [this](const Skeleton*)
+		m_onSkeletonJointsInvalidated.Connect(m_skeleton->OnSkeletonJointsInvalidated, [this](const Skeleton*, std::size_t firstJoint, std::size_t jointCount)
 		{
-			m_dataInvalided = true;
-			OnTransferRequired(this);
+			// Skinning matrices overriding the skeleton are unaffected by joints
+			if (m_skinningMatrices.empty())
+				InvalidateData(firstJoint, jointCount);
 		});
 	}
 
 	SkeletonInstance::SkeletonInstance(SkeletonInstance&& skeletonInstance) noexcept :
 	m_skeletalDataBuffer(std::move(skeletonInstance.m_skeletalDataBuffer)),
 	m_skeleton(std::move(skeletonInstance.m_skeleton)),
-	m_dataInvalided(skeletonInstance.m_dataInvalided)
+	m_skinningMatrices(std::move(skeletonInstance.m_skinningMatrices)),
+	m_skinnedMeshes(std::move(skeletonInstance.m_skinnedMeshes)),
+	m_invalidatedJointBegin(skeletonInstance.m_invalidatedJointBegin),
+	m_invalidatedJointEnd(skeletonInstance.m_invalidatedJointEnd),
+	m_dataInvalided(skeletonInstance.m_dataInvalided),
+	m_skinningPending(skeletonInstance.m_skinningPending)
 	{
-		m_onSkeletonJointsInvalidated.Connect(m_skeleton->OnSkeletonJointsInvalidated, [this](const Skeleton*)
+		m_onSkeletonJointsInvalidated.Connect(m_skeleton->OnSkeletonJointsInvalidated, [this](const Skeleton*, std::size_t firstJoint, std::size_t jointCount)
 		{
-			m_dataInvalided = true;
-			OnTransferRequired(this);
+			// Skinning matrices overriding the skeleton are unaffected by joints
+			if (m_skinningMatrices.empty())
+				InvalidateData(firstJoint, jointCount);
 		});
 	}
 
+	/*!
+	* \brief Records the skinning of every mesh registered with EnableComputeSkinning
+	*
+	* This must be recorded after the skeletal data transfer and before any pass using the skinned vertex buffers,
+	* barriers between compute and vertex input stages are left to the caller (so they are only recorded once for every skeleton instance).
+	*
+	* \param builder Command buffer builder used to record the compute dispatches
+	*/
+	void SkeletonInstance::DispatchSkinning(CommandBufferBuilder& builder)
+	{
+		const std::shared_ptr<ComputePipeline>& skinningPipeline = Graphics::Instance()->GetSkinningPipeline();
+		NazaraAssert(skinningPipeline, "compute skinning is not enabled");
+
+		builder.BindComputePipeline(*skinningPipeline);
+		for (const SkinnedMesh& skinnedMesh : m_skinnedMeshes)
+		{
+			for (const SkinnedSubMesh& skinnedSubMesh : skinnedMesh.subMeshes)
+			{
+				if (!skinnedSubMesh.shaderBinding)
+					continue;
+
+				builder.BindComputeShaderBinding(0, *skinnedSubMesh.shaderBinding);
+				builder.Dispatch((skinnedSubMesh.vertexCount + 63) / 64, 1, 1);
+			}
+		}
+
+		m_skinningPending = false;
+	}
+
+	/*!
+	* \brief Skins a mesh using a compute shader instead of the vertex shader
+	*
+	* Skinned vertices are written once per frame to persistent vertex buffers (see GetSkinnedVertexBuffer), which are then used by every pass (depth, shadows, forward, ...)
+	* without further skinning. Submeshes without a skinning buffer (see GraphicalMesh::GetSkinningBuffer) are ignored and keep being skinned by the vertex shader.
+	*
+	* \param graphicalMesh Mesh to skin, registering the same mesh twice does nothing
+	*
+	* \remark Compute skinning must be enabled (see Graphics::IsComputeSkinningEnabled)
+	*/
+	void SkeletonInstance::EnableComputeSkinning(std::shared_ptr<GraphicalMesh> graphicalMesh)
+	{
+		NazaraAssert(graphicalMesh, "invalid graphical mesh");
+
+		Graphics* graphics = Graphics::Instance();
+		NazaraAssert(graphics->IsComputeSkinningEnabled(), "compute skinning is not enabled");
+
+		if (std::any_of(m_skinnedMeshes.begin(), m_skinnedMeshes.end(), [&](const SkinnedMesh& skinnedMesh) { return skinnedMesh.graphicalMesh == graphicalMesh; }))
+			return;
+
+		const std::shared_ptr<RenderDevice>& renderDevice = graphics->GetRenderDevice();
+		const std::shared_ptr<RenderPipelineLayout>& skinningPipelineLayout = graphics->GetSkinningPipelineLayout();
+		std::size_t skinnedVertexSize = graphics->GetSkinnedVertexDeclaration()->GetStride();
+
+		SkinnedMesh skinnedMesh;
+		skinnedMesh.subMeshes.resize(graphicalMesh->GetSubMeshCount());
+
+		bool hasSkinnedSubMesh = false;
+		for (std::size_t i = 0; i < graphicalMesh->GetSubMeshCount(); ++i)
+		{
+			const std::shared_ptr<RenderBuffer>& skinningBuffer = graphicalMesh->GetSkinningBuffer(i);
+			if (!skinningBuffer)
+				continue;
+
+			SkinnedSubMesh& skinnedSubMesh = skinnedMesh.subMeshes[i];
+			skinnedSubMesh.vertexCount = graphicalMesh->GetVertexCount(i);
+			skinnedSubMesh.vertexBuffer = renderDevice->InstantiateBuffer(BufferType::Vertex, skinnedSubMesh.vertexCount * skinnedVertexSize, BufferUsage::DeviceLocal);
+			skinnedSubMesh.vertexBuffer->UpdateDebugName("Skinned vertices");
+
+			skinnedSubMesh.shaderBinding = skinningPipelineLayout->AllocateShaderBinding(0);
+			skinnedSubMesh.shaderBinding->Update({
+				{
+					0,
+					ShaderBinding::UniformBufferBinding {
+						m_skeletalDataBuffer.get(), 0, m_skeletalDataBuffer->GetSize()
+					}
+				},
+				{
+					1,
+					ShaderBinding::StorageBufferBinding {
+						skinningBuffer.get(), 0, skinningBuffer->GetSize()
+					}
+				},
+				{
+					2,
+					ShaderBinding::StorageBufferBinding {
+						skinnedSubMesh.vertexBuffer.get(), 0, skinnedSubMesh.vertexBuffer->GetSize()
+					}
+				}
+			});
+
+			hasSkinnedSubMesh = true;
+		}
+
+		if (!hasSkinnedSubMesh)
+			return;
+
+		skinnedMesh.graphicalMesh = std::move(graphicalMesh);
+		m_skinnedMeshes.push_back(std::move(skinnedMesh));
+
+		// Skinned vertices have to be written before the mesh is rendered for the first time
+		m_skinningPending = true;
+	}
+
+	/*!
+	* \brief Returns the vertex buffer holding the vertices of a submesh skinned by this instance
+	* \return Skinned vertex buffer (see Graphics::GetSkinnedVertexDeclaration) or a null pointer if the submesh isn't skinned by a compute shader
+	*
+	* \param graphicalMesh Mesh registered with EnableComputeSkinning
+	* \param subMeshIndex Submesh index
+	*/
+	const std::shared_ptr<RenderBuffer>& SkeletonInstance::GetSkinnedVertexBuffer(const GraphicalMesh& graphicalMesh, std::size_t subMeshIndex) const
+	{
+		static std::shared_ptr<RenderBuffer> dummy;
+
+		for (const SkinnedMesh& skinnedMesh : m_skinnedMeshes)
+		{
+			if (skinnedMesh.graphicalMesh.get() != &graphicalMesh)
+				continue;
+
+			NazaraAssert(subMeshIndex < skinnedMesh.subMeshes.size(), "submesh index out of range");
+			return skinnedMesh.subMeshes[subMeshIndex].vertexBuffer;
+		}
+
+		return dummy;
+	}
+
 	void SkeletonInstance::OnTransfer(RenderFrame& renderFrame, CommandBufferBuilder& builder)
 	{
 		if (!m_dataInvalided)
@@ -50,27 +190,71 @@ namespace Nz
 
 		PredefinedSkeletalData skeletalUboOffsets = PredefinedSkeletalData::GetOffsets();
 
-		auto& allocation = renderFrame.GetUploadPool().Allocate(m_skeletalDataBuffer->GetSize());
-		Matrix4f* matrices = AccessByOffset<Matrix4f*>(allocation.mappedPtr, skeletalUboOffsets.jointMatricesOffset);
+		// Only upload matrices of invalidated joints (joint matrices are tightly packed in the skeletal UBO)
+		std::size_t matrixCount = (!m_skinningMatrices.empty()) ? m_skinningMatrices.size() : m_skeleton->GetJointCount();
+		std::size_t firstMatrix = m_invalidatedJointBegin;
+		std::size_t lastMatrix = std::min(m_invalidatedJointEnd, matrixCount);
 
-		for (std::size_t i = 0; i < m_skeleton->GetJointCount(); ++i)
-			matrices[i] = m_skeleton->GetJoint(i)->GetSkinningMatrix();
+		m_invalidatedJointBegin = std::numeric_limits<std::size_t>::max();
+		m_invalidatedJointEnd = 0;
+		m_dataInvalided = false;
 
-		builder.CopyBuffer(allocation, m_skeletalDataBuffer.get());
+		if (firstMatrix >= lastMatrix)
+			return;
 
-		m_dataInvalided = false;
+		UInt64 uploadSize = (lastMatrix - firstMatrix) * sizeof(Matrix4f);
+		auto& allocation = renderFrame.GetUploadPool().Allocate(uploadSize);
+		Matrix4f* matrices = static_cast<Matrix4f*>(allocation.mappedPtr);
+
+		if (!m_skinningMatrices.empty())
+			std::memcpy(matrices, &m_skinningMatrices[firstMatrix], uploadSize);
+		else
+		{
+			for (std::size_t i = firstMatrix; i < lastMatrix; ++i)
+				matrices[i - firstMatrix] = m_skeleton->GetJoint(i)->GetSkinningMatrix();
+		}
+
+		builder.CopyBuffer(allocation, m_skeletalDataBuffer.get(), uploadSize, 0, skeletalUboOffsets.jointMatricesOffset + firstMatrix * sizeof(Matrix4f));
+
+		if (!m_skinnedMeshes.empty())
+			m_skinningPending = true;
+	}
+
+	/*!
+	* \brief Overrides the skinning matrices computed from the skeleton joints
+	*
+	* This is meant to be used with poses evaluated outside of the skeleton (see AnimationBlendTree), which don't require to update the joints.
+	* Once set, the skeleton joints are no longer used until the skinning matrices are cleared (by passing a zero matrix count).
+	*
+	* \param skinningMatrices Skinning matrices, one per joint
+	* \param matrixCount Matrix count
+	*/
+	void SkeletonInstance::UpdateSkinningMatrices(const Matrix4f* skinningMatrices, std::size_t matrixCount)
+	{
+		NazaraAssert(matrixCount <= PredefinedSkeletalData::MaxMatricesCount, "too many skinning matrices");
+
+		m_skinningMatrices.assign(skinningMatrices, skinningMatrices + matrixCount);
+
+		// Clearing the override means joint matrices have to be uploaded again
+		InvalidateData(0, (matrixCount > 0) ? matrixCount : m_skeleton->GetJointCount());
 	}
 
 	SkeletonInstance& SkeletonInstance::operator=(SkeletonInstance&& skeletonInstance) noexcept
 	{
 		m_skeletalDataBuffer = std::move(skeletonInstance.m_skeletalDataBuffer);
 		m_skeleton = std::move(skeletonInstance.m_skeleton);
+		m_skinningMatrices = std::move(skeletonInstance.m_skinningMatrices);
+		m_skinnedMeshes = std::move(skeletonInstance.m_skinnedMeshes);
+		m_invalidatedJointBegin = skeletonInstance.m_invalidatedJointBegin;
+		m_invalidatedJointEnd = skeletonInstance.m_invalidatedJointEnd;
 		m_dataInvalided = skeletonInstance.m_dataInvalided;
+		m_skinningPending = skeletonInstance.m_skinningPending;
 
-		m_onSkeletonJointsInvalidated.Connect(m_skeleton->OnSkeletonJointsInvalidated, [this](const Skeleton*)
+		m_onSkeletonJointsInvalidated.Connect(m_skeleton->OnSkeletonJointsInvalidated, [this](const Skeleton*, std::size_t firstJoint, std::size_t jointCount)
 		{
-			m_dataInvalided = true;
-			OnTransferRequired(this);
+			// Skinning matrices overriding the skeleton are unaffected by joints
+			if (m_skinningMatrices.empty())
+				InvalidateData(firstJoint, jointCount);
 		});
 
 		return *this;
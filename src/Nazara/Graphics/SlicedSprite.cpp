@@ -23,6 +23,9 @@ namespace Nz
 
 	void SlicedSprite::BuildElement(ElementRendererRegistry& registry, const ElementData& elementData, std::size_t passIndex, std::vector<RenderElementOwner>& elements) const
 	{
+		if (m_material->HasPass(elementData.excludedPassIndex))
+			return;
+
 		const auto& materialPipeline = m_material->GetPipeline(passIndex);
 		if (!materialPipeline)
 			return;
@@ -14,10 +14,10 @@
 
 namespace Nz
 {
-	float SpotLight::ComputeContributionScore(const BoundingVolumef& boundingVolume) const
+	float SpotLight::ComputeContributionScore(const Boxf& worldAABB) const
 	{
 		// TODO: take luminosity/radius/direction into account
-		return Vector3f::SquaredDistance(m_position, boundingVolume.aabb.GetCenter());
+		return Vector3f::SquaredDistance(m_position, worldAABB.GetCenter());
 	}
 
 	void SpotLight::FillLightData(void* data) const
@@ -14,7 +14,8 @@ namespace Nz
 {
 	SpotLightShadowData::SpotLightShadowData(FramePipeline& pipeline, ElementRendererRegistry& elementRegistry, const SpotLight& light) :
 	m_pipeline(pipeline),
-	m_light(light)
+	m_light(light),
+	m_isCullingValid(false)
 	{
 		UInt32 shadowMapSize = light.GetShadowMapSize();
 		m_viewer.UpdateRenderMask(0xFFFFFFFF);
@@ -51,16 +52,22 @@ namespace Nz
 		});
 	}
 
-	void SpotLightShadowData::PrepareRendering(RenderFrame& renderFrame)
-{
+	void SpotLightShadowData::PrepareRendering(RenderFrame& renderFrame, const AbstractViewer* /*viewer*/)
+	{
 		const Matrix4f& viewProjMatrix = m_viewer.GetViewerInstance().GetViewProjMatrix();
 
 		Frustumf frustum = Frustumf::Extract(viewProjMatrix);
 
-		std::size_t visibilityHash = 5U;
-		const auto& visibleRenderables = m_pipeline.FrustumCull(frustum, 0xFFFFFFFF, visibilityHash);
+		// Keep the previous culling results as long as neither the light nor the renderables in its range changed
+		if (!m_isCullingValid || viewProjMatrix != m_cullingViewProjMatrix || m_pipeline.IsCullingInvalidated(frustum))
+		{
+			m_visibilityHash = 5U;
+			m_visibleRenderables = m_pipeline.FrustumCull(frustum, 0xFFFFFFFF, m_visibilityHash);
+			m_cullingViewProjMatrix = viewProjMatrix;
+			m_isCullingValid = true;
+		}
 
-		m_depthPass->Prepare(renderFrame, frustum, visibleRenderables, visibilityHash);
+		m_depthPass->Prepare(renderFrame, frustum, m_visibleRenderables, m_visibilityHash);
 	}
 
 	void SpotLightShadowData::RegisterMaterialInstance(const MaterialInstance& matInstance)
@@ -68,12 +75,12 @@ namespace Nz
 		m_depthPass->RegisterMaterialInstance(matInstance);
 	}
 
-	void SpotLightShadowData::RegisterPassInputs(FramePass& pass)
+	void SpotLightShadowData::RegisterPassInputs(FramePass& pass, const AbstractViewer* /*viewer*/)
 	{
 		pass.AddInput(m_attachmentIndex);
 	}
 
-	void SpotLightShadowData::RegisterToFrameGraph(FrameGraph& frameGraph)
+	void SpotLightShadowData::RegisterToFrameGraph(FrameGraph& frameGraph, const AbstractViewer* /*viewer*/)
 	{
 		UInt32 shadowMapSize = m_light.GetShadowMapSize();
 
@@ -87,7 +94,7 @@ namespace Nz
 		m_depthPass->RegisterToFrameGraph(frameGraph, m_attachmentIndex);
 	}
 
-	const Nz::Texture* SpotLightShadowData::RetrieveLightShadowmap(const BakedFrameGraph& bakedGraph) const
+	const Nz::Texture* SpotLightShadowData::RetrieveLightShadowmap(const BakedFrameGraph& bakedGraph, const AbstractViewer* /*viewer*/) const
 	{
 		return bakedGraph.GetAttachmentTexture(m_attachmentIndex).get();
 	}
@@ -6,11 +6,14 @@
 #include <Nazara/Graphics/Graphics.hpp>
 #include <Nazara/Graphics/MaterialInstance.hpp>
 #include <Nazara/Graphics/RenderSpriteChain.hpp>
+#include <Nazara/Graphics/ShaderBindingCache.hpp>
 #include <Nazara/Graphics/ViewerInstance.hpp>
 #include <Nazara/Renderer/CommandBufferBuilder.hpp>
 #include <Nazara/Renderer/RenderFrame.hpp>
 #include <Nazara/Renderer/UploadPool.hpp>
+#include <cstring>
 #include <iostream>
+#include <limits>
 #include <utility>
 #include <Nazara/Graphics/Debug.hpp>
 
@@ -21,29 +24,51 @@ namespace Nz
 	m_maxVertexCount(m_maxVertexBufferSize / (2 * sizeof(float))), // Treat vec2 as the minimum declaration possible
 	m_device(device)
 	{
-		m_vertexBufferPool = std::make_shared<VertexBufferPool>();
-
 		std::size_t maxQuadCount = m_maxVertexCount / 4;
 		std::size_t indexCount = 6 * maxQuadCount;
 
 		// Generate indices for quad (0, 1, 2, 2, 1, 3, ...)
-		std::vector<UInt16> indices(indexCount);
-		UInt16* indexPtr = indices.data();
-
-		for (std::size_t i = 0; i < maxQuadCount; ++i)
+		auto GenerateIndices = [&](auto dummy)
 		{
-			UInt16 index = static_cast<UInt16>(i);
+			using T = decltype(dummy);
+
+			std::vector<T> indices(indexCount);
+			T* indexPtr = indices.data();
+
+			for (std::size_t i = 0; i < maxQuadCount; ++i)
+			{
+				T index = static_cast<T>(i);
 
-			*indexPtr++ = index * 4 + 0;
-			*indexPtr++ = index * 4 + 1;
-			*indexPtr++ = index * 4 + 2;
+				*indexPtr++ = index * 4 + 0;
+				*indexPtr++ = index * 4 + 1;
+				*indexPtr++ = index * 4 + 2;
 
-			*indexPtr++ = index * 4 + 2;
-			*indexPtr++ = index * 4 + 1;
-			*indexPtr++ = index * 4 + 3;
+				*indexPtr++ = index * 4 + 2;
+				*indexPtr++ = index * 4 + 1;
+				*indexPtr++ = index * 4 + 3;
+			}
+
+			m_indexBuffer = m_device.InstantiateBuffer(BufferType::Index, indexCount * sizeof(T), BufferUsage::DeviceLocal | BufferUsage::Write, indices.data());
+		};
+
+		// Big vertex buffers mean less draw calls but may require 32bits indices
+		if (4 * maxQuadCount <= std::size_t(std::numeric_limits<UInt16>::max()) + 1)
+		{
+			m_indexType = IndexType::U16;
+			GenerateIndices(UInt16{});
 		}
+		else
+		{
+			m_indexType = IndexType::U32;
+			GenerateIndices(UInt32{});
+		}
+
+		m_shaderBindingCache = std::make_shared<ShaderBindingCache>();
+	}
 
-		m_indexBuffer = m_device.InstantiateBuffer(BufferType::Index, indexCount * sizeof(UInt16), BufferUsage::DeviceLocal | BufferUsage::Write, indices.data());
+	void SpriteChainRenderer::EndFrame(RenderFrame& currentFrame)
+	{
+		m_shaderBindingCache->Update(currentFrame);
 	}
 
 	RenderElementPool<RenderSpriteChain>& SpriteChainRenderer::GetPool()
@@ -53,7 +78,10 @@ namespace Nz
 
 	std::unique_ptr<ElementRendererData> SpriteChainRenderer::InstanciateData()
 	{
-		return std::make_unique<SpriteChainRendererData>();
+		auto data = std::make_unique<SpriteChainRendererData>();
+		data->shaderBindingCache = m_shaderBindingCache;
+
+		return data;
 	}
 
 	void SpriteChainRenderer::Prepare(const ViewerInstance& viewerInstance, ElementRendererData& rendererData, RenderFrame& currentFrame, std::size_t elementCount, const Pointer<const RenderElement>* elements, const RenderStates* renderStates)
@@ -93,7 +121,7 @@ namespace Nz
 
 			if (const MaterialInstance* materialInstance = &spriteChain.GetMaterialInstance(); m_pendingData.currentMaterialInstance != materialInstance)
 			{
-				FlushDrawData();
+				InvalidateShaderBinding();
 				m_pendingData.currentMaterialInstance = materialInstance;
 			}
 
@@ -101,19 +129,21 @@ namespace Nz
 			{
 				// TODO: Flushing draw calls on instance binding means we can have e.g. 1000 sprites rendered using a draw call for each one
 				// which is far from being efficient, using some bindless could help (or at least instancing?)
-				FlushDrawData();
+				InvalidateShaderBinding();
 				m_pendingData.currentWorldInstance = worldInstance;
 			}
 
 			if (const Texture* textureOverlay = spriteChain.GetTextureOverlay(); m_pendingData.currentTextureOverlay != textureOverlay)
 			{
-				FlushDrawData();
+				InvalidateShaderBinding();
 				m_pendingData.currentTextureOverlay = textureOverlay;
 			}
 
-			if (m_pendingData.currentLightData != renderState.lightData)
+			if (m_pendingData.currentLightData != renderState.lightData || m_pendingData.currentLightArray != renderState.lightArray || m_pendingData.currentLightClusters != renderState.lightClusters)
 			{
-				FlushDrawData();
+				InvalidateShaderBinding();
+				m_pendingData.currentLightArray = renderState.lightArray;
+				m_pendingData.currentLightClusters = renderState.lightClusters;
 				m_pendingData.currentLightData = renderState.lightData;
 			}
 
@@ -130,25 +160,18 @@ namespace Nz
 
 			while (remainingQuads > 0)
 			{
-				if (!m_pendingData.currentAllocation)
+				if (!m_pendingData.currentVertexBuffer)
 				{
-					m_pendingData.currentAllocation = &currentFrame.GetUploadPool().Allocate(m_maxVertexBufferSize);
-					m_pendingData.currentAllocationMemPtr = static_cast<UInt8*>(m_pendingData.currentAllocation->mappedPtr);
-
-					std::shared_ptr<RenderBuffer> vertexBuffer;
-
-					// Try to reuse vertex buffers from pool if any
-					if (!m_vertexBufferPool->vertexBuffers.empty())
+					// Reuse vertex buffers in the same order as the last time, static content will most likely end up at the same place
+					if (data.usedVertexBufferCount >= data.vertexBuffers.size())
 					{
-						vertexBuffer = std::move(m_vertexBufferPool->vertexBuffers.back());
-						m_vertexBufferPool->vertexBuffers.pop_back();
+						auto& vertexBuffer = data.vertexBuffers.emplace_back();
+						vertexBuffer.buffer = m_device.InstantiateBuffer(BufferType::Vertex, m_maxVertexBufferSize, BufferUsage::DeviceLocal | BufferUsage::Dynamic | BufferUsage::Write);
+						vertexBuffer.content.resize(m_maxVertexBufferSize);
 					}
-					else
-						vertexBuffer = m_device.InstantiateBuffer(BufferType::Vertex, m_maxVertexBufferSize, BufferUsage::DeviceLocal | BufferUsage::Dynamic | BufferUsage::Write);
 
-					m_pendingData.currentVertexBuffer = vertexBuffer.get();
-
-					data.vertexBuffers.emplace_back(std::move(vertexBuffer));
+					m_pendingData.currentVertexBuffer = &data.vertexBuffers[data.usedVertexBufferCount++];
+					m_pendingData.currentVertexBufferOffset = 0;
 				}
 
 				if (!m_pendingData.currentShaderBinding)
@@ -168,8 +191,28 @@ namespace Nz
 						auto& bindingEntry = m_bindingCache.emplace_back();
 						bindingEntry.bindingIndex = bindingIndex;
 						bindingEntry.content = ShaderBinding::UniformBufferBinding{
-							instanceBuffer.get(),
-							0, instanceBuffer->GetSize()
+							instanceBuffer.GetBuffer(),
+							instanceBuffer.GetOffset(), instanceBuffer.GetSize()
+						};
+					}
+
+					if (UInt32 bindingIndex = material.GetEngineBindingIndex(EngineShaderBinding::LightArraySsbo); bindingIndex != Material::InvalidBindingIndex && m_pendingData.currentLightArray)
+					{
+						auto& bindingEntry = m_bindingCache.emplace_back();
+						bindingEntry.bindingIndex = bindingIndex;
+						bindingEntry.content = ShaderBinding::StorageBufferBinding{
+							m_pendingData.currentLightArray.GetBuffer(),
+							m_pendingData.currentLightArray.GetOffset(), m_pendingData.currentLightArray.GetSize()
+						};
+					}
+
+					if (UInt32 bindingIndex = material.GetEngineBindingIndex(EngineShaderBinding::LightClusterSsbo); bindingIndex != Material::InvalidBindingIndex && m_pendingData.currentLightClusters)
+					{
+						auto& bindingEntry = m_bindingCache.emplace_back();
+						bindingEntry.bindingIndex = bindingIndex;
+						bindingEntry.content = ShaderBinding::StorageBufferBinding{
+							m_pendingData.currentLightClusters.GetBuffer(),
+							m_pendingData.currentLightClusters.GetOffset(), m_pendingData.currentLightClusters.GetSize()
 						};
 					}
 
@@ -204,29 +247,42 @@ namespace Nz
 						};
 					}
 
-					ShaderBindingPtr drawDataBinding = m_pendingData.currentPipeline->GetPipelineInfo().pipelineLayout->AllocateShaderBinding(0);
-					drawDataBinding->Update(m_bindingCache.data(), m_bindingCache.size());
+					// Elements with different materials, instances or lights may still use the same bindings (e.g. unlit materials don't bind light data), keep batching them
+					const std::shared_ptr<RenderPipelineLayout>& pipelineLayout = m_pendingData.currentPipeline->GetPipelineInfo().pipelineLayout;
+					if (m_pendingData.lastShaderBinding && m_pendingData.lastPipelineLayout == pipelineLayout.get() && m_bindingCache == m_lastBindingCache)
+						m_pendingData.currentShaderBinding = m_pendingData.lastShaderBinding;
+					else
+					{
+						FlushDrawCall();
 
-					m_pendingData.currentShaderBinding = drawDataBinding.get();
+						// Identical bindings (from previous rebuilds or non-adjacent elements) share the same shader binding
+						const ShaderBinding* drawDataBinding = m_shaderBindingCache->Acquire(pipelineLayout, 0, m_bindingCache.data(), m_bindingCache.size());
 
-					data.shaderBindings.emplace_back(std::move(drawDataBinding));
+						m_pendingData.currentShaderBinding = drawDataBinding;
+						m_pendingData.lastPipelineLayout = pipelineLayout.get();
+						m_pendingData.lastShaderBinding = drawDataBinding;
+						std::swap(m_bindingCache, m_lastBindingCache);
+
+						data.shaderBindings.push_back(drawDataBinding);
+					}
 				}
 
 				if (!m_pendingData.currentDrawCall)
 				{
 					data.drawCalls.push_back(SpriteChainRendererData::DrawCall{
-						m_pendingData.currentVertexBuffer,
+						m_pendingData.currentVertexBuffer->buffer.get(),
 						m_pendingData.currentPipeline,
 						m_pendingData.currentShaderBinding,
 						6 * m_pendingData.firstQuadIndex,
 						0,
-						m_pendingData.currentScissorBox
+						m_pendingData.currentScissorBox,
+						m_pendingData.currentMaterialInstance->GetParentMaterial()->HasBindlessTextures()
 					});
 
 					m_pendingData.currentDrawCall = &data.drawCalls.back();
 				}
 
-				std::size_t remainingSpace = m_maxVertexBufferSize - (m_pendingData.currentAllocationMemPtr - static_cast<UInt8*>(m_pendingData.currentAllocation->mappedPtr));
+				std::size_t remainingSpace = m_maxVertexBufferSize - m_pendingData.currentVertexBufferOffset;
 				std::size_t maxQuads = remainingSpace / (4 * stride);
 				if (maxQuads == 0)
 				{
@@ -237,8 +293,21 @@ namespace Nz
 				std::size_t copiedQuadCount = std::min(maxQuads, remainingQuads);
 				std::size_t copiedSize = 4 * copiedQuadCount * stride;
 
-				std::memcpy(m_pendingData.currentAllocationMemPtr, spriteData, copiedSize);
-				m_pendingData.currentAllocationMemPtr += copiedSize;
+				auto& vertexBuffer = *m_pendingData.currentVertexBuffer;
+				std::size_t offset = m_pendingData.currentVertexBufferOffset;
+
+				UInt8* contentPtr = vertexBuffer.content.data() + offset;
+				if (offset + copiedSize > vertexBuffer.uploadedSize || std::memcmp(contentPtr, spriteData, copiedSize) != 0)
+				{
+					std::memcpy(contentPtr, spriteData, copiedSize);
+
+					if (m_pendingData.invalidatedBegin == m_pendingData.invalidatedEnd)
+						m_pendingData.invalidatedBegin = offset;
+
+					m_pendingData.invalidatedEnd = offset + copiedSize;
+				}
+
+				m_pendingData.currentVertexBufferOffset += copiedSize;
 				spriteData += copiedSize;
 
 				m_pendingData.firstQuadIndex += copiedQuadCount;
@@ -264,10 +333,20 @@ namespace Nz
 
 		if (!m_pendingCopies.empty())
 		{
+			UploadPool& uploadPool = currentFrame.GetUploadPool();
+
 			currentFrame.Execute([&](CommandBufferBuilder& builder)
 			{
+				// Vertex buffers are persistent and may still be read by the previous frame
+				builder.PreTransferBarrier();
+
 				for (auto& copy : m_pendingCopies)
-					builder.CopyBuffer(*copy.allocation, copy.targetBuffer, copy.size);
+				{
+					auto& allocation = uploadPool.Allocate(copy.size);
+					std::memcpy(allocation.mappedPtr, copy.data, copy.size);
+
+					builder.CopyBuffer(allocation, copy.targetBuffer, copy.size, 0, copy.offset);
+				}
 
 				builder.PostTransferBarrier();
 			}, Nz::QueueType::Transfer);
@@ -282,7 +361,7 @@ namespace Nz
 	{
 		auto& data = static_cast<SpriteChainRendererData&>(rendererData);
 
-		commandBuffer.BindIndexBuffer(*m_indexBuffer, Nz::IndexType::U16);
+		commandBuffer.BindIndexBuffer(*m_indexBuffer, m_indexType);
 
 		Vector2f targetSize = viewerInstance.GetTargetSize();
 		Recti fullscreenScissorBox(0, 0, SafeCast<int>(std::floor(targetSize.x)), SafeCast<int>(std::floor(targetSize.y)));
@@ -290,8 +369,11 @@ namespace Nz
 		const RenderBuffer* currentVertexBuffer = nullptr;
 		const RenderPipeline* currentPipeline = nullptr;
 		const ShaderBinding* currentShaderBinding = nullptr;
+		const RenderPipelineLayout* textureTableLayout = nullptr; //< layout the bindless texture table is bound with
 		Recti currentScissorBox(-1, -1, -1, -1);
 
+		const std::shared_ptr<BindlessTextureTable>& textureTable = Graphics::Instance()->GetBindlessTextureTable();
+
 		const RenderSpriteChain* firstSpriteChain = static_cast<const RenderSpriteChain*>(elements[0]);
 		auto it = data.drawCallPerElement.find(firstSpriteChain);
 		assert(it != data.drawCallPerElement.end());
@@ -318,6 +400,18 @@ namespace Nz
 			{
 				commandBuffer.BindRenderShaderBinding(0, *drawData.shaderBinding);
 				currentShaderBinding = drawData.shaderBinding;
+
+				// Binding set 0 with another pipeline layout unbinds the texture table set
+				const RenderPipelineLayout* pipelineLayout = drawData.renderPipeline->GetPipelineInfo().pipelineLayout.get();
+				if (textureTableLayout != pipelineLayout)
+				{
+					textureTableLayout = nullptr;
+					if (drawData.bindlessTextures)
+					{
+						commandBuffer.BindRenderShaderBinding(*pipelineLayout, BindlessTextureTable::SetIndex, textureTable->GetShaderBinding());
+						textureTableLayout = pipelineLayout;
+					}
+				}
 			}
 
 			const Recti& targetScissorBox = (drawData.scissorBox.width >= 0) ? drawData.scissorBox : fullscreenScissorBox;
@@ -331,21 +425,16 @@ namespace Nz
 		}
 	}
 
-	void SpriteChainRenderer::Reset(ElementRendererData& rendererData, RenderFrame& currentFrame)
+	void SpriteChainRenderer::Reset(ElementRendererData& rendererData, RenderFrame& /*currentFrame*/)
 	{
 		auto& data = static_cast<SpriteChainRendererData&>(rendererData);
 
-		for (auto& vertexBufferPtr : data.vertexBuffers)
-		{
-			currentFrame.PushReleaseCallback([pool = m_vertexBufferPool, vertexBuffer = std::move(vertexBufferPtr)]() mutable
-			{
-				pool->vertexBuffers.push_back(std::move(vertexBuffer));
-			});
-		}
-		data.vertexBuffers.clear();
+		// Vertex buffers and their content are kept, the next Prepare will only upload what changed
+		data.usedVertexBufferCount = 0;
 
-		for (auto& shaderBinding : data.shaderBindings)
-			currentFrame.PushForRelease(std::move(shaderBinding));
+		// Shader bindings are only destroyed by the cache once they weren't used for a few frames
+		for (const ShaderBinding* shaderBinding : data.shaderBindings)
+			m_shaderBindingCache->Release(shaderBinding);
 		data.shaderBindings.clear();
 
 		data.drawCalls.clear();
@@ -356,19 +445,28 @@ namespace Nz
 		// changing vertex buffer always mean we have to switch draw calls
 		FlushDrawCall();
 
-		if (m_pendingData.currentAllocation)
+		if (m_pendingData.currentVertexBuffer)
 		{
-			std::size_t size = m_pendingData.currentAllocationMemPtr - static_cast<UInt8*>(m_pendingData.currentAllocation->mappedPtr);
+			auto& vertexBuffer = *m_pendingData.currentVertexBuffer;
 
-			m_pendingCopies.emplace_back(BufferCopy{
-				m_pendingData.currentVertexBuffer,
-				m_pendingData.currentAllocation,
-				size
-			});
+			if (m_pendingData.invalidatedBegin != m_pendingData.invalidatedEnd)
+			{
+				m_pendingCopies.emplace_back(BufferCopy{
+					vertexBuffer.buffer.get(),
+					vertexBuffer.content.data() + m_pendingData.invalidatedBegin,
+					m_pendingData.invalidatedBegin,
+					m_pendingData.invalidatedEnd - m_pendingData.invalidatedBegin
+				});
+			}
+
+			// Everything written in this buffer will match its memory once copies are done (vertices are always written from the beginning)
+			vertexBuffer.uploadedSize = std::max(vertexBuffer.uploadedSize, m_pendingData.currentVertexBufferOffset);
 
 			m_pendingData.firstQuadIndex = 0;
-			m_pendingData.currentAllocation = nullptr;
+			m_pendingData.invalidatedBegin = 0;
+			m_pendingData.invalidatedEnd = 0;
 			m_pendingData.currentVertexBuffer = nullptr;
+			m_pendingData.currentVertexBufferOffset = 0;
 		}
 	}
 
@@ -380,7 +478,18 @@ namespace Nz
 	void SpriteChainRenderer::FlushDrawData()
 	{
 		FlushDrawCall();
+		InvalidateShaderBinding();
+	}
 
+	void SpriteChainRenderer::InvalidateShaderBinding()
+	{
+		// Draw call is only flushed if the new shader binding differs from the current one
 		m_pendingData.currentShaderBinding = nullptr;
 	}
+
+	SpriteChainRendererData::~SpriteChainRendererData()
+	{
+		for (const ShaderBinding* shaderBinding : shaderBindings)
+			shaderBindingCache->Release(shaderBinding);
+	}
 }
@@ -0,0 +1,254 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/StaticBatcher.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Graphics/GraphicalMesh.hpp>
+#include <Nazara/Graphics/MaterialInstance.hpp>
+#include <Nazara/Graphics/Model.hpp>
+#include <Nazara/Utility/Algorithm.hpp>
+#include <Nazara/Utility/BufferMapper.hpp>
+#include <Nazara/Utility/IndexBuffer.hpp>
+#include <Nazara/Utility/IndexMapper.hpp>
+#include <Nazara/Utility/Mesh.hpp>
+#include <Nazara/Utility/SoftwareBuffer.hpp>
+#include <Nazara/Utility/StaticMesh.hpp>
+#include <Nazara/Utility/VertexBuffer.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Adds a static mesh to the batch
+	* \return True if the mesh was added, false if it can't be batched (animated mesh or strip/fan primitives)
+	*
+	* The mesh vertices are copied and transformed right away, the mesh doesn't have to outlive the batcher.
+	* The whole mesh is assigned to the cluster containing the center of its transformed AABB.
+	*
+	* \param mesh Static mesh to add
+	* \param transformMatrix World transformation of the mesh
+	* \param materials Materials of the mesh submeshes (indexed by submesh), submeshes without material use the default basic material
+	*/
+	bool StaticBatcher::AddMesh(const Mesh& mesh, const Matrix4f& transformMatrix, const std::vector<std::shared_ptr<MaterialInstance>>& materials)
+	{
+		if (mesh.GetAnimationType() != AnimationType::Static)
+		{
+			NazaraError("only static meshes can be batched");
+			return false;
+		}
+
+		for (std::size_t i = 0; i < mesh.GetSubMeshCount(); ++i)
+		{
+			switch (mesh.GetSubMesh(i)->GetPrimitiveMode())
+			{
+				case PrimitiveMode::LineList:
+				case PrimitiveMode::PointList:
+				case PrimitiveMode::TriangleList:
+					break;
+
+				case PrimitiveMode::LineStrip:
+				case PrimitiveMode::TriangleFan:
+				case PrimitiveMode::TriangleStrip:
+					NazaraError("submesh #{0} uses a strip or fan primitive mode which cannot be batched", i);
+					return false;
+			}
+		}
+
+		Boxf meshAABB = mesh.GetAABB();
+		meshAABB.Transform(transformMatrix);
+
+		Vector3f clusterPosition = meshAABB.GetCenter() / m_clusterSize;
+		Vector3i32 clusterIndex(Int32(std::floor(clusterPosition.x)), Int32(std::floor(clusterPosition.y)), Int32(std::floor(clusterPosition.z)));
+
+		Cluster& cluster = m_clusters[clusterIndex];
+
+		// Normals are transformed by the inverse transpose matrix to stay perpendicular to non-uniformly scaled surfaces
+		Matrix4f normalMatrix;
+		if (!transformMatrix.GetInverseTransform(&normalMatrix))
+			normalMatrix = transformMatrix;
+
+		normalMatrix.Transpose();
+
+		// Mirroring transformations flip the triangle winding
+		bool flipWinding = transformMatrix.GetDeterminantTransform() < 0.f;
+
+		for (std::size_t i = 0; i < mesh.GetSubMeshCount(); ++i)
+		{
+			const std::shared_ptr<SubMesh>& subMesh = mesh.GetSubMesh(i);
+			const StaticMesh& staticMesh = static_cast<const StaticMesh&>(*subMesh);
+
+			const std::shared_ptr<VertexBuffer>& vertexBuffer = staticMesh.GetVertexBuffer();
+			const std::shared_ptr<const VertexDeclaration>& vertexDeclaration = vertexBuffer->GetVertexDeclaration();
+
+			UInt32 vertexCount = staticMesh.GetVertexCount();
+			if (vertexCount == 0)
+				continue;
+
+			std::size_t stride = vertexDeclaration->GetStride();
+			std::vector<UInt8> vertices(vertexCount * stride);
+			{
+				BufferMapper<VertexBuffer> vertexMapper(*vertexBuffer, 0, vertexCount);
+				if (!vertexMapper.GetPointer())
+				{
+					NazaraError("failed to map vertex buffer");
+					return false;
+				}
+
+				std::memcpy(vertices.data(), vertexMapper.GetPointer(), vertices.size());
+			}
+
+			// Components are decoded and encoded back to support compressed vertex declarations
+			for (const auto& component : vertexDeclaration->GetComponents())
+			{
+				const Matrix4f* matrix;
+				float w;
+				switch (component.component)
+				{
+					case VertexComponent::Position:
+						matrix = &transformMatrix;
+						w = 1.f;
+						break;
+
+					case VertexComponent::Normal:
+						matrix = &normalMatrix;
+						w = 0.f;
+						break;
+
+					case VertexComponent::Tangent:
+						matrix = &transformMatrix;
+						w = 0.f;
+						break;
+
+					default:
+						continue;
+				}
+
+				for (UInt32 vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+				{
+					UInt8* componentPtr = &vertices[vertexIndex * stride + component.offset];
+
+					Vector4f value = DecodeVertexComponent(componentPtr, component.type, component.component);
+					Vector3f transformedValue = matrix->Transform(Vector3f(value.x, value.y, value.z), w);
+					if (w == 0.f)
+						transformedValue.Normalize();
+
+					// Keep the fourth element (tangent handedness)
+					EncodeVertexComponent(Vector4f(transformedValue, value.w), component.type, component.component, componentPtr);
+				}
+			}
+
+			std::shared_ptr<MaterialInstance> material = (i < materials.size() && materials[i]) ? materials[i] : MaterialInstance::GetDefault(MaterialType::Basic);
+			PrimitiveMode primitiveMode = subMesh->GetPrimitiveMode();
+
+			auto batchIt = std::find_if(cluster.batches.begin(), cluster.batches.end(), [&](const Batch& batch)
+			{
+				return batch.material == material && batch.vertexDeclaration == vertexDeclaration && batch.primitiveMode == primitiveMode;
+			});
+
+			Boxf subMeshAABB = staticMesh.GetAABB();
+			subMeshAABB.Transform(transformMatrix);
+
+			if (batchIt == cluster.batches.end())
+			{
+				Batch& batch = cluster.batches.emplace_back();
+				batch.aabb = subMeshAABB;
+				batch.material = std::move(material);
+				batch.primitiveMode = primitiveMode;
+				batch.vertexDeclaration = vertexDeclaration;
+
+				batchIt = cluster.batches.end() - 1;
+			}
+			else
+				batchIt->aabb.ExtendTo(subMeshAABB);
+
+			Batch& batch = *batchIt;
+			batch.vertices.insert(batch.vertices.end(), vertices.begin(), vertices.end());
+
+			UInt32 baseVertex = batch.vertexCount;
+			std::size_t firstIndex = batch.indices.size();
+			if (subMesh->GetIndexBuffer())
+			{
+				IndexMapper indexMapper(*subMesh);
+
+				UInt32 indexCount = indexMapper.GetIndexCount();
+				batch.indices.resize(firstIndex + indexCount);
+				for (UInt32 j = 0; j < indexCount; ++j)
+					batch.indices[firstIndex + j] = baseVertex + indexMapper.Get(j);
+			}
+			else
+			{
+				batch.indices.resize(firstIndex + vertexCount);
+				for (UInt32 j = 0; j < vertexCount; ++j)
+					batch.indices[firstIndex + j] = baseVertex + j;
+			}
+
+			if (flipWinding && primitiveMode == PrimitiveMode::TriangleList)
+			{
+				for (std::size_t j = firstIndex; j + 2 < batch.indices.size(); j += 3)
+					std::swap(batch.indices[j + 1], batch.indices[j + 2]);
+			}
+
+			batch.vertexCount += vertexCount;
+		}
+
+		return true;
+	}
+
+	/*!
+	* \brief Builds a model per cluster out of the added meshes
+	* \return Models of every non-empty cluster, expressed in world space
+	*
+	* Each model has one submesh per material (and vertex declaration) of its cluster, and thus requires a single draw per material.
+	* The batcher keeps its content and can be cleared after building.
+	*/
+	std::vector<std::shared_ptr<Model>> StaticBatcher::Build() const
+	{
+		// GraphicalMesh uploads from software buffers
+		BufferUsageFlags bufferUsage = BufferUsage::DirectMapping | BufferUsage::Read | BufferUsage::Write;
+
+		std::vector<std::shared_ptr<Model>> models;
+		models.reserve(m_clusters.size());
+
+		for (auto&& [clusterIndex, cluster] : m_clusters)
+		{
+			if (cluster.batches.empty())
+				continue;
+
+			Mesh mesh;
+			mesh.CreateStatic();
+
+			for (const Batch& batch : cluster.batches)
+			{
+				IndexType indexType = (batch.vertexCount <= std::numeric_limits<UInt16>::max()) ? IndexType::U16 : IndexType::U32;
+				UInt32 indexCount = SafeCast<UInt32>(batch.indices.size());
+
+				std::shared_ptr<VertexBuffer> vertexBuffer = std::make_shared<VertexBuffer>(batch.vertexDeclaration, batch.vertexCount, bufferUsage, &SoftwareBufferFactory, batch.vertices.data());
+				std::shared_ptr<IndexBuffer> indexBuffer = std::make_shared<IndexBuffer>(indexType, indexCount, bufferUsage, &SoftwareBufferFactory);
+				{
+					IndexMapper indexMapper(*indexBuffer);
+					for (UInt32 i = 0; i < indexCount; ++i)
+						indexMapper.Set(i, batch.indices[i]);
+				}
+
+				std::shared_ptr<StaticMesh> staticMesh = std::make_shared<StaticMesh>(std::move(vertexBuffer), std::move(indexBuffer));
+				staticMesh->SetAABB(batch.aabb);
+				staticMesh->SetPrimitiveMode(batch.primitiveMode);
+
+				mesh.AddSubMesh(std::move(staticMesh));
+			}
+
+			std::shared_ptr<Model> model = std::make_shared<Model>(GraphicalMesh::BuildFromMesh(mesh));
+			for (std::size_t i = 0; i < cluster.batches.size(); ++i)
+				model->SetMaterial(i, cluster.batches[i].material);
+
+			models.push_back(std::move(model));
+		}
+
+		return models;
+	}
+}
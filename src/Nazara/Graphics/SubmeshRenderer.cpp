@@ -3,17 +3,127 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Graphics/SubmeshRenderer.hpp>
+#include <Nazara/Graphics/AnimationTexture.hpp>
+#include <Nazara/Graphics/BindlessTextureTable.hpp>
 #include <Nazara/Graphics/Graphics.hpp>
 #include <Nazara/Graphics/MaterialInstance.hpp>
 #include <Nazara/Graphics/RenderSubmesh.hpp>
+#include <Nazara/Graphics/ShaderBindingCache.hpp>
 #include <Nazara/Graphics/SkeletonInstance.hpp>
 #include <Nazara/Graphics/ViewerInstance.hpp>
+#include <Nazara/Graphics/WorldInstance.hpp>
 #include <Nazara/Renderer/CommandBufferBuilder.hpp>
+#include <Nazara/Renderer/RenderDevice.hpp>
 #include <Nazara/Renderer/RenderFrame.hpp>
+#include <Nazara/Renderer/RenderPipelineLayout.hpp>
+#include <Nazara/Renderer/UploadPool.hpp>
+#include <NZSL/Math/FieldOffsets.hpp>
+#include <algorithm>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
 {
+	NAZARA_ANONYMOUS_NAMESPACE
+	{
+		struct CullingOffsets
+		{
+			std::size_t batchCount;
+			std::size_t cullingDataSize;
+			std::size_t instanceWorldMatrix;
+			std::size_t instanceInvWorldMatrix;
+			std::size_t instanceAabbMin;
+			std::size_t instanceAabbMax;
+			std::size_t instanceStride;
+			std::size_t batchFirstInstance;
+			std::size_t batchInstanceCount;
+			std::size_t batchOutputOffset;
+			std::size_t batchIndexCount;
+			std::size_t batchFirstIndex;
+			std::size_t batchCullingEnabled;
+			std::size_t batchStride;
+			std::size_t drawCommandStride;
+		};
+
+		// Must match InstanceCulling shader
+		CullingOffsets GetCullingOffsets()
+		{
+			CullingOffsets offsets;
+
+			nzsl::FieldOffsets cullingDataStruct(nzsl::StructLayout::Std140);
+			offsets.batchCount = cullingDataStruct.AddField(nzsl::StructFieldType::UInt1);
+			offsets.cullingDataSize = cullingDataStruct.GetAlignedSize();
+
+			nzsl::FieldOffsets instanceStruct(nzsl::StructLayout::Std140);
+			offsets.instanceWorldMatrix = instanceStruct.AddMatrix(nzsl::StructFieldType::Float1, 4, 4, true);
+			offsets.instanceInvWorldMatrix = instanceStruct.AddMatrix(nzsl::StructFieldType::Float1, 4, 4, true);
+			offsets.instanceAabbMin = instanceStruct.AddField(nzsl::StructFieldType::Float3);
+			offsets.instanceAabbMax = instanceStruct.AddField(nzsl::StructFieldType::Float3);
+			offsets.instanceStride = instanceStruct.GetAlignedSize();
+
+			nzsl::FieldOffsets batchStruct(nzsl::StructLayout::Std140);
+			offsets.batchFirstInstance = batchStruct.AddField(nzsl::StructFieldType::UInt1);
+			offsets.batchInstanceCount = batchStruct.AddField(nzsl::StructFieldType::UInt1);
+			offsets.batchOutputOffset = batchStruct.AddField(nzsl::StructFieldType::UInt1);
+			offsets.batchIndexCount = batchStruct.AddField(nzsl::StructFieldType::UInt1);
+			offsets.batchFirstIndex = batchStruct.AddField(nzsl::StructFieldType::UInt1);
+			offsets.batchCullingEnabled = batchStruct.AddField(nzsl::StructFieldType::UInt1);
+			offsets.batchStride = batchStruct.GetAlignedSize();
+
+			// Fields are tightly packed like DrawIndexedIndirectCommand, only the array stride is padded
+			nzsl::FieldOffsets drawCommandStruct(nzsl::StructLayout::Std140);
+			drawCommandStruct.AddField(nzsl::StructFieldType::UInt1); //< indexCount
+			drawCommandStruct.AddField(nzsl::StructFieldType::UInt1); //< instanceCount
+			drawCommandStruct.AddField(nzsl::StructFieldType::UInt1); //< firstIndex
+			drawCommandStruct.AddField(nzsl::StructFieldType::Int1);  //< vertexOffset
+			drawCommandStruct.AddField(nzsl::StructFieldType::UInt1); //< firstInstance
+			offsets.drawCommandStride = drawCommandStruct.GetAlignedSize();
+
+			return offsets;
+		}
+
+		bool EnsureStorageBuffer(std::shared_ptr<RenderBuffer>& buffer, UInt64 size, RenderFrame& renderFrame, const char* debugName)
+		{
+			UInt64 capacity = (buffer) ? buffer->GetSize() : 0;
+			if (buffer && capacity >= size)
+				return false;
+
+			if (buffer)
+				renderFrame.PushForRelease(std::move(buffer));
+
+			buffer = Graphics::Instance()->GetRenderDevice()->InstantiateBuffer(BufferType::Storage, std::max({ size, capacity * 2, UInt64(1024) }), BufferUsage::DeviceLocal | BufferUsage::Dynamic | BufferUsage::Write);
+			buffer->UpdateDebugName(debugName);
+
+			return true;
+		}
+	}
+
+	/*!
+	* \brief Constructs a submesh renderer
+	*
+	* Consecutive submeshes only differing by their world instance are rendered using a single instanced draw call (if their material supports it),
+	* submeshes animated from an animation texture are always rendered this way as their animation state is part of the instance data.
+	*
+	* When GPU-driven rendering is enabled (see Graphics::Config::useGpuDrivenRendering), instanced batches are frustum culled by a compute pass
+	* which compacts their visible instances in a storage buffer and writes their indirect draw commands.
+	*
+	* \param device Render device used to allocate instance buffers
+	* \param minInstanceCount Minimum number of consecutive identical submeshes required to use an instanced draw call
+	*/
+	SubmeshRenderer::SubmeshRenderer(RenderDevice& device, std::size_t minInstanceCount) :
+	m_minInstanceCount(std::max<std::size_t>(minInstanceCount, 2)),
+	m_instanceAnimationArrayOffsets(PredefinedInstanceAnimationArrayData::GetOffsets()),
+	m_instanceArrayOffsets(PredefinedInstanceArrayData::GetOffsets()),
+	m_device(device)
+	{
+		m_instanceBufferPool = std::make_shared<InstanceBufferPool>();
+		m_shaderBindingCache = std::make_shared<ShaderBindingCache>();
+	}
+
+	void SubmeshRenderer::EndFrame(RenderFrame& currentFrame)
+	{
+		m_shaderBindingCache->Update(currentFrame);
+	}
+
 	RenderElementPool<RenderSubmesh>& SubmeshRenderer::GetPool()
 	{
 		return m_submeshPool;
@@ -21,7 +131,10 @@ namespace Nz
 
 	std::unique_ptr<ElementRendererData> SubmeshRenderer::InstanciateData()
 	{
-		return std::make_unique<SubmeshRendererData>();
+		auto data = std::make_unique<SubmeshRendererData>();
+		data->shaderBindingCache = m_shaderBindingCache;
+
+		return data;
 	}
 
 	void SubmeshRenderer::Prepare(const ViewerInstance& viewerInstance, ElementRendererData& rendererData, RenderFrame& /*currentFrame*/, std::size_t elementCount, const Pointer<const RenderElement>* elements, const RenderStates* renderStates)
@@ -29,22 +142,27 @@ namespace Nz
 		Graphics* graphics = Graphics::Instance();
 
 		auto& data = static_cast<SubmeshRendererData&>(rendererData);
+		data.viewerInstance = &viewerInstance;
 
 		Recti invalidScissorBox(-1, -1, -1, -1);
 
+		const AnimationTexture* currentAnimationTexture = nullptr;
 		const RenderBuffer* currentIndexBuffer = nullptr;
 		const RenderBuffer* currentVertexBuffer = nullptr;
+		UInt64 currentVertexBufferOffset = 0;
 		const MaterialInstance* currentMaterialInstance = nullptr;
 		const RenderPipeline* currentPipeline = nullptr;
 		const ShaderBinding* currentShaderBinding = nullptr;
 		const SkeletonInstance* currentSkeletonInstance = nullptr;
 		const WorldInstance* currentWorldInstance = nullptr;
 		Recti currentScissorBox = invalidScissorBox;
+		RenderBufferView currentLightArray;
+		RenderBufferView currentLightClusters;
 		RenderBufferView currentLightData;
 
 		auto FlushDrawCall = [&]()
 		{
-			// Does nothing for now (but will serve once instancing is implemented)
+			// Does nothing for now (instanced draw calls are emitted directly)
 		};
 
 		auto FlushDrawData = [&]()
@@ -55,14 +173,219 @@ namespace Nz
 		};
 
 		const auto& depthTexture2D = Graphics::Instance()->GetDefaultTextures().depthTextures[ImageType::E2D];
+		const auto& depthTexture2DArray = Graphics::Instance()->GetDefaultTextures().depthTextures[ImageType::E2D_Array];
 		const auto& depthTextureCube = Graphics::Instance()->GetDefaultTextures().depthTextures[ImageType::Cubemap];
 		const auto& whiteTexture2D = Graphics::Instance()->GetDefaultTextures().whiteTextures[ImageType::E2D];
 		const auto& defaultSampler = graphics->GetSamplerCache().Get({});
 
+		TextureSamplerInfo animationSamplerInfo;
+		animationSamplerInfo.magFilter = SamplerFilter::Nearest;
+		animationSamplerInfo.minFilter = SamplerFilter::Nearest;
+		animationSamplerInfo.mipmapMode = SamplerMipmapMode::Nearest;
+		const auto& animationSampler = graphics->GetSamplerCache().Get(animationSamplerInfo);
+
 		TextureSamplerInfo samplerInfo;
 		samplerInfo.depthCompare = true;
 		const auto& shadowSampler = graphics->GetSamplerCache().Get(samplerInfo);
 
+		auto FillShaderBindings = [&](const RenderStates& renderState, RenderBuffer* instanceArrayBuffer, RenderBuffer* instanceAnimationArrayBuffer, bool culledInstances)
+		{
+			assert(currentMaterialInstance);
+
+			m_bindingCache.clear();
+			m_textureBindingCache.clear();
+			m_textureBindingCache.reserve(renderState.shadowMaps2D.size() + renderState.shadowMapsCube.size() + renderState.shadowMapsDirectional.size());
+			currentMaterialInstance->FillShaderBinding(m_bindingCache);
+
+			const Material& material = *currentMaterialInstance->GetParentMaterial();
+
+			// Predefined shader bindings
+			if (instanceArrayBuffer)
+			{
+				UInt32 bindingIndex = material.GetEngineBindingIndex(EngineShaderBinding::InstanceDataArrayUbo);
+				assert(bindingIndex != Material::InvalidBindingIndex);
+
+				auto& bindingEntry = m_bindingCache.emplace_back();
+				bindingEntry.bindingIndex = bindingIndex;
+				bindingEntry.content = ShaderBinding::UniformBufferBinding{
+					instanceArrayBuffer,
+					0, instanceArrayBuffer->GetSize()
+				};
+			}
+			else if (UInt32 bindingIndex = material.GetEngineBindingIndex(EngineShaderBinding::InstanceDataUbo); bindingIndex != Material::InvalidBindingIndex && !culledInstances)
+			{
+				assert(currentWorldInstance);
+				const auto& instanceBuffer = currentWorldInstance->GetInstanceBuffer();
+
+				auto& bindingEntry = m_bindingCache.emplace_back();
+				bindingEntry.bindingIndex = bindingIndex;
+				bindingEntry.content = ShaderBinding::UniformBufferBinding{
+					instanceBuffer.GetBuffer(),
+					instanceBuffer.GetOffset(), instanceBuffer.GetSize()
+				};
+			}
+
+			if (UInt32 bindingIndex = material.GetEngineBindingIndex(EngineShaderBinding::InstanceAnimationDataArrayUbo); bindingIndex != Material::InvalidBindingIndex && instanceAnimationArrayBuffer)
+			{
+				auto& bindingEntry = m_bindingCache.emplace_back();
+				bindingEntry.bindingIndex = bindingIndex;
+				bindingEntry.content = ShaderBinding::UniformBufferBinding{
+					instanceAnimationArrayBuffer,
+					0, instanceAnimationArrayBuffer->GetSize()
+				};
+			}
+
+			if (UInt32 bindingIndex = material.GetEngineBindingIndex(EngineShaderBinding::AnimationTexture); bindingIndex != Material::InvalidBindingIndex && currentAnimationTexture)
+			{
+				auto& bindingEntry = m_bindingCache.emplace_back();
+				bindingEntry.bindingIndex = bindingIndex;
+				bindingEntry.content = ShaderBinding::SampledTextureBinding{
+					currentAnimationTexture->GetTexture().get(), animationSampler.get()
+				};
+			}
+
+			if (UInt32 bindingIndex = material.GetEngineBindingIndex(EngineShaderBinding::LightArraySsbo); bindingIndex != Material::InvalidBindingIndex && currentLightArray)
+			{
+				auto& bindingEntry = m_bindingCache.emplace_back();
+				bindingEntry.bindingIndex = bindingIndex;
+				bindingEntry.content = ShaderBinding::StorageBufferBinding{
+					currentLightArray.GetBuffer(),
+					currentLightArray.GetOffset(), currentLightArray.GetSize()
+				};
+			}
+
+			if (UInt32 bindingIndex = material.GetEngineBindingIndex(EngineShaderBinding::LightClusterSsbo); bindingIndex != Material::InvalidBindingIndex && currentLightClusters)
+			{
+				auto& bindingEntry = m_bindingCache.emplace_back();
+				bindingEntry.bindingIndex = bindingIndex;
+				bindingEntry.content = ShaderBinding::StorageBufferBinding{
+					currentLightClusters.GetBuffer(),
+					currentLightClusters.GetOffset(), currentLightClusters.GetSize()
+				};
+			}
+
+			if (UInt32 bindingIndex = material.GetEngineBindingIndex(EngineShaderBinding::LightDataUbo); bindingIndex != Material::InvalidBindingIndex && currentLightData)
+			{
+				auto& bindingEntry = m_bindingCache.emplace_back();
+				bindingEntry.bindingIndex = bindingIndex;
+				bindingEntry.content = ShaderBinding::UniformBufferBinding{
+					currentLightData.GetBuffer(),
+					currentLightData.GetOffset(), currentLightData.GetSize()
+				};
+			}
+
+			if (UInt32 bindingIndex = material.GetEngineBindingIndex(EngineShaderBinding::Shadowmap2D); bindingIndex != Material::InvalidBindingIndex)
+			{
+				std::size_t textureBindingBaseIndex = m_textureBindingCache.size();
+
+				for (std::size_t j = 0; j < renderState.shadowMaps2D.size(); ++j)
+				{
+					const Texture* texture = renderState.shadowMaps2D[j];
+					if (!texture)
+						texture = depthTexture2D.get();
+
+					auto& textureEntry = m_textureBindingCache.emplace_back();
+					textureEntry.texture = texture;
+					textureEntry.sampler = shadowSampler.get();
+				}
+
+				auto& bindingEntry = m_bindingCache.emplace_back();
+				bindingEntry.bindingIndex = bindingIndex;
+				bindingEntry.content = ShaderBinding::SampledTextureBindings {
+					SafeCast<UInt32>(renderState.shadowMaps2D.size()), &m_textureBindingCache[textureBindingBaseIndex]
+				};
+			}
+
+			if (UInt32 bindingIndex = material.GetEngineBindingIndex(EngineShaderBinding::ShadowmapCube); bindingIndex != Material::InvalidBindingIndex)
+			{
+				std::size_t textureBindingBaseIndex = m_textureBindingCache.size();
+				
+				for (std::size_t j = 0; j < renderState.shadowMapsCube.size(); ++j)
+				{
+					const Texture* texture = renderState.shadowMapsCube[j];
+					if (!texture)
+						texture = depthTextureCube.get();
+
+					auto& textureEntry = m_textureBindingCache.emplace_back();
+					textureEntry.texture = texture;
+					textureEntry.sampler = defaultSampler.get(); //< cube shadowmap don't use depth compare
+				}
+
+				auto& bindingEntry = m_bindingCache.emplace_back();
+				bindingEntry.bindingIndex = bindingIndex;
+				bindingEntry.content = ShaderBinding::SampledTextureBindings {
+					SafeCast<UInt32>(renderState.shadowMapsCube.size()), &m_textureBindingCache[textureBindingBaseIndex]
+				};
+			}
+
+			if (UInt32 bindingIndex = material.GetEngineBindingIndex(EngineShaderBinding::ShadowmapDirectional); bindingIndex != Material::InvalidBindingIndex)
+			{
+				std::size_t textureBindingBaseIndex = m_textureBindingCache.size();
+
+				for (std::size_t j = 0; j < renderState.shadowMapsDirectional.size(); ++j)
+				{
+					const Texture* texture = renderState.shadowMapsDirectional[j];
+					if (!texture)
+						texture = depthTexture2DArray.get();
+
+					auto& textureEntry = m_textureBindingCache.emplace_back();
+					textureEntry.texture = texture;
+					textureEntry.sampler = shadowSampler.get();
+				}
+
+				auto& bindingEntry = m_bindingCache.emplace_back();
+				bindingEntry.bindingIndex = bindingIndex;
+				bindingEntry.content = ShaderBinding::SampledTextureBindings {
+					SafeCast<UInt32>(renderState.shadowMapsDirectional.size()), &m_textureBindingCache[textureBindingBaseIndex]
+				};
+			}
+
+			if (UInt32 bindingIndex = material.GetEngineBindingIndex(EngineShaderBinding::SkeletalDataUbo); bindingIndex != Material::InvalidBindingIndex && currentSkeletonInstance)
+			{
+				const auto& skeletalBuffer = currentSkeletonInstance->GetSkeletalBuffer();
+
+				auto& bindingEntry = m_bindingCache.emplace_back();
+				bindingEntry.bindingIndex = bindingIndex;
+				bindingEntry.content = ShaderBinding::UniformBufferBinding{
+					skeletalBuffer.get(),
+					0, skeletalBuffer->GetSize()
+				};
+			}
+
+			if (UInt32 bindingIndex = material.GetEngineBindingIndex(EngineShaderBinding::ViewerDataUbo); bindingIndex != Material::InvalidBindingIndex)
+			{
+				const auto& viewerBuffer = viewerInstance.GetViewerBuffer();
+
+				auto& bindingEntry = m_bindingCache.emplace_back();
+				bindingEntry.bindingIndex = bindingIndex;
+				bindingEntry.content = ShaderBinding::UniformBufferBinding{
+					viewerBuffer.get(),
+					0, viewerBuffer->GetSize()
+				};
+			}
+
+			if (UInt32 bindingIndex = material.GetEngineBindingIndex(EngineShaderBinding::OverlayTexture); bindingIndex != Material::InvalidBindingIndex)
+			{
+				auto& bindingEntry = m_bindingCache.emplace_back();
+				bindingEntry.bindingIndex = bindingIndex;
+				bindingEntry.content = ShaderBinding::SampledTextureBinding{
+					whiteTexture2D.get(), defaultSampler.get()
+				};
+			}
+		};
+
+		auto BuildShaderBinding = [&](const RenderStates& renderState, RenderBuffer* instanceArrayBuffer, RenderBuffer* instanceAnimationArrayBuffer) -> const ShaderBinding*
+		{
+			FillShaderBindings(renderState, instanceArrayBuffer, instanceAnimationArrayBuffer, false);
+
+			assert(currentPipeline);
+			// Submeshes sharing the same resources (materials, instance buffers) share the same shader binding, even between rebuilds
+			const ShaderBinding* shaderBinding = m_shaderBindingCache->Acquire(currentPipeline->GetPipelineInfo().pipelineLayout, 0, m_bindingCache.data(), m_bindingCache.size());
+			data.shaderBindings.push_back(shaderBinding);
+
+			return shaderBinding;
+		};
+
 		std::size_t oldDrawCallCount = data.drawCalls.size();
 
 		for (std::size_t i = 0; i < elementCount; ++i)
@@ -71,6 +394,142 @@ namespace Nz
 			const RenderSubmesh& submesh = static_cast<const RenderSubmesh&>(*elements[i]);
 			const RenderStates& renderState = renderStates[i];
 
+			const Material& material = *submesh.GetMaterialInstance().GetParentMaterial();
+
+			// Instanced submeshes of materials reading their instances from a storage buffer are culled by the GPU and drawn using indirect indexed draws
+			UInt32 instanceStorageBindingIndex = material.GetEngineBindingIndex(EngineShaderBinding::InstanceDataArraySsbo);
+			bool gpuCulling = (instanceStorageBindingIndex != Material::InvalidBindingIndex);
+
+			// Look for consecutive submeshes which could be rendered along this one using instancing
+			std::size_t instanceCount = 1;
+			bool supportsInstancing = submesh.GetInstancedRenderPipeline() && material.GetEngineBindingIndex(EngineShaderBinding::InstanceDataArrayUbo) != Material::InvalidBindingIndex && (!gpuCulling || submesh.GetIndexBuffer());
+			if (supportsInstancing)
+			{
+				// Culled batches aren't limited by the size of the instance uniform buffer (but animation data still is)
+				std::size_t maxInstanceCount = elementCount - i;
+				if (!gpuCulling || submesh.GetAnimationTexture())
+					maxInstanceCount = std::min(maxInstanceCount, PredefinedInstanceArrayData::MaxInstanceCount);
+
+				while (instanceCount < maxInstanceCount && CanBeInstanced(submesh, renderState, static_cast<const RenderSubmesh&>(*elements[i + instanceCount]), renderStates[i + instanceCount]))
+					instanceCount++;
+			}
+
+			if (instanceCount >= m_minInstanceCount || (supportsInstancing && submesh.GetAnimationTexture()))
+			{
+				FlushDrawData();
+
+				currentAnimationTexture = submesh.GetAnimationTexture();
+				currentPipeline = submesh.GetInstancedRenderPipeline();
+				currentMaterialInstance = &submesh.GetMaterialInstance();
+				currentIndexBuffer = submesh.GetIndexBuffer();
+				currentVertexBuffer = submesh.GetVertexBuffer();
+				currentVertexBufferOffset = submesh.GetVertexBufferOffset();
+				currentSkeletonInstance = nullptr;
+				currentWorldInstance = nullptr; //< force a new shader binding for the next non-instanced submesh
+				currentLightArray = renderState.lightArray;
+				currentLightClusters = renderState.lightClusters;
+				currentLightData = renderState.lightData;
+
+				const Recti& scissorBox = submesh.GetScissorBox();
+				currentScissorBox = (scissorBox.width >= 0) ? scissorBox : invalidScissorBox;
+
+				// Instances of culled batches are written by the culling pass
+				std::shared_ptr<RenderBuffer> instanceBuffer;
+				if (!gpuCulling)
+				{
+					if (!m_instanceBufferPool->instanceBuffers.empty())
+					{
+						instanceBuffer = std::move(m_instanceBufferPool->instanceBuffers.back());
+						m_instanceBufferPool->instanceBuffers.pop_back();
+					}
+					else
+						instanceBuffer = m_device.InstantiateBuffer(BufferType::Uniform, m_instanceArrayOffsets.totalSize, BufferUsage::DeviceLocal | BufferUsage::Dynamic | BufferUsage::Write);
+				}
+
+				std::shared_ptr<RenderBuffer> instanceAnimationBuffer;
+				if (currentAnimationTexture)
+				{
+					if (!m_instanceBufferPool->instanceAnimationBuffers.empty())
+					{
+						instanceAnimationBuffer = std::move(m_instanceBufferPool->instanceAnimationBuffers.back());
+						m_instanceBufferPool->instanceAnimationBuffers.pop_back();
+					}
+					else
+						instanceAnimationBuffer = m_device.InstantiateBuffer(BufferType::Uniform, m_instanceAnimationArrayOffsets.totalSize, BufferUsage::DeviceLocal | BufferUsage::Dynamic | BufferUsage::Write);
+				}
+
+				std::size_t firstWorldInstance = data.batchedWorldInstances.size();
+				for (std::size_t j = 0; j < instanceCount; ++j)
+					data.batchedWorldInstances.push_back(&static_cast<const RenderSubmesh&>(*elements[i + j]).GetWorldInstance());
+
+				// Instance data is uploaded every frame in Update (as world instances can move without elements being rebuilt)
+				if (instanceBuffer || instanceAnimationBuffer)
+				{
+					auto& instanceBatch = data.instanceBatches.emplace_back();
+					instanceBatch.animationTexture = currentAnimationTexture;
+					instanceBatch.firstWorldInstance = firstWorldInstance;
+					instanceBatch.instanceAnimationBuffer = instanceAnimationBuffer.get();
+					instanceBatch.instanceBuffer = instanceBuffer.get();
+					instanceBatch.instanceCount = instanceCount;
+				}
+
+				const ShaderBinding* instancedShaderBinding;
+				std::size_t cullingBatchIndex = SubmeshRendererData::InvalidBatchIndex;
+				if (gpuCulling)
+				{
+					FillShaderBindings(renderState, nullptr, instanceAnimationBuffer.get(), true);
+
+					// Each batch reads its instances from the start of its own range (as the instance index doesn't include the first instance on every backend)
+					UInt64 outputOffset = AlignPow2<UInt64>(data.instanceOutputSize, m_device.GetDeviceInfo().limits.minStorageBufferOffsetAlignment);
+					data.instanceOutputSize = outputOffset + instanceCount * m_instanceArrayOffsets.instanceStride;
+
+					cullingBatchIndex = data.cullingBatches.size();
+
+					auto& cullingBatch = data.cullingBatches.emplace_back();
+					cullingBatch.aabb = submesh.GetAABB();
+					cullingBatch.cullingEnabled = (currentAnimationTexture == nullptr); //< animation data is indexed like the batch instances, which must keep their order
+					cullingBatch.firstIndex = submesh.GetFirstIndex();
+					cullingBatch.firstWorldInstance = firstWorldInstance;
+					cullingBatch.indexCount = submesh.GetIndexCount();
+					cullingBatch.instanceBindingIndex = instanceStorageBindingIndex;
+					cullingBatch.instanceCount = instanceCount;
+					cullingBatch.outputOffset = outputOffset;
+
+					// Not shared through the cache as the instance output buffer is only known (and bound) in PrepareEnd
+					cullingBatch.shaderBinding = currentPipeline->GetPipelineInfo().pipelineLayout->AllocateShaderBinding(0);
+					cullingBatch.shaderBinding->Update(m_bindingCache.data(), m_bindingCache.size());
+
+					instancedShaderBinding = cullingBatch.shaderBinding.get();
+				}
+				else
+					instancedShaderBinding = BuildShaderBinding(renderState, instanceBuffer.get(), instanceAnimationBuffer.get());
+
+				if (instanceBuffer)
+					data.instanceBuffers.emplace_back(std::move(instanceBuffer));
+
+				if (instanceAnimationBuffer)
+					data.instanceAnimationBuffers.emplace_back(std::move(instanceAnimationBuffer));
+
+				currentAnimationTexture = nullptr;
+
+				auto& drawCall = data.drawCalls.emplace_back();
+				drawCall.bindlessTextures = submesh.GetMaterialInstance().GetParentMaterial()->HasBindlessTextures();
+				drawCall.cullingBatchIndex = cullingBatchIndex;
+				drawCall.firstIndex = submesh.GetFirstIndex();
+				drawCall.indexBuffer = currentIndexBuffer;
+				drawCall.indexCount = submesh.GetIndexCount();
+				drawCall.indexType = submesh.GetIndexType();
+				drawCall.instanceCount = instanceCount;
+				drawCall.renderPipeline = currentPipeline;
+				drawCall.scissorBox = currentScissorBox;
+				drawCall.shaderBinding = instancedShaderBinding;
+				drawCall.vertexBuffer = currentVertexBuffer;
+				drawCall.vertexBufferOffset = currentVertexBufferOffset;
+
+				i += instanceCount - 1;
+				continue;
+			}
+
 			if (const RenderPipeline* pipeline = submesh.GetRenderPipeline(); currentPipeline != pipeline)
 			{
 				FlushDrawCall();
@@ -89,10 +548,11 @@ namespace Nz
 				currentIndexBuffer = indexBuffer;
 			}
 
-			if (const RenderBuffer* vertexBuffer = submesh.GetVertexBuffer(); currentVertexBuffer != vertexBuffer)
+			if (const RenderBuffer* vertexBuffer = submesh.GetVertexBuffer(); currentVertexBuffer != vertexBuffer || currentVertexBufferOffset != submesh.GetVertexBufferOffset())
 			{
 				FlushDrawCall();
 				currentVertexBuffer = vertexBuffer;
+				currentVertexBufferOffset = submesh.GetVertexBufferOffset();
 			}
 
 			if (const SkeletonInstance* skeletonInstance = submesh.GetSkeletonInstance(); currentSkeletonInstance != skeletonInstance)
@@ -109,9 +569,11 @@ namespace Nz
 				currentWorldInstance = worldInstance;
 			}
 
-			if (currentLightData != renderState.lightData)
+			if (currentLightData != renderState.lightData || currentLightArray != renderState.lightArray || currentLightClusters != renderState.lightClusters)
 			{
 				FlushDrawData();
+				currentLightArray = renderState.lightArray;
+				currentLightClusters = renderState.lightClusters;
 				currentLightData = renderState.lightData;
 			}
 
@@ -124,144 +586,127 @@ namespace Nz
 			}
 
 			if (!currentShaderBinding)
-			{
-				assert(currentMaterialInstance);
-
-				m_bindingCache.clear();
-				m_textureBindingCache.clear();
-				m_textureBindingCache.reserve(renderState.shadowMaps2D.size() + renderState.shadowMapsCube.size());
-				currentMaterialInstance->FillShaderBinding(m_bindingCache);
+				currentShaderBinding = BuildShaderBinding(renderState, nullptr, nullptr);
 
-				const Material& material = *currentMaterialInstance->GetParentMaterial();
+			auto& drawCall = data.drawCalls.emplace_back();
+			drawCall.bindlessTextures = submesh.GetMaterialInstance().GetParentMaterial()->HasBindlessTextures();
+			drawCall.cullingBatchIndex = SubmeshRendererData::InvalidBatchIndex;
+			drawCall.firstIndex = submesh.GetFirstIndex();
+			drawCall.indexBuffer = currentIndexBuffer;
+			drawCall.indexCount = submesh.GetIndexCount();
+			drawCall.indexType = submesh.GetIndexType();
+			drawCall.instanceCount = 1;
+			drawCall.renderPipeline = currentPipeline;
+			drawCall.scissorBox = currentScissorBox;
+			drawCall.shaderBinding = currentShaderBinding;
+			drawCall.vertexBuffer = currentVertexBuffer;
+			drawCall.vertexBufferOffset = currentVertexBufferOffset;
+		}
 
-				// Predefined shader bindings
-				if (UInt32 bindingIndex = material.GetEngineBindingIndex(EngineShaderBinding::InstanceDataUbo); bindingIndex != Material::InvalidBindingIndex)
-				{
-					assert(currentWorldInstance);
-					const auto& instanceBuffer = currentWorldInstance->GetInstanceBuffer();
-
-					auto& bindingEntry = m_bindingCache.emplace_back();
-					bindingEntry.bindingIndex = bindingIndex;
-					bindingEntry.content = ShaderBinding::UniformBufferBinding{
-						instanceBuffer.get(),
-						0, instanceBuffer->GetSize()
-					};
-				}
+		const RenderSubmesh* firstSubmesh = static_cast<const RenderSubmesh*>(elements[0]);
+		std::size_t drawCallCount = data.drawCalls.size() - oldDrawCallCount;
+		data.drawCallPerElement[firstSubmesh] = SubmeshRendererData::DrawCallIndices{ oldDrawCallCount, drawCallCount };
+	}
 
-				if (UInt32 bindingIndex = material.GetEngineBindingIndex(EngineShaderBinding::LightDataUbo); bindingIndex != Material::InvalidBindingIndex && currentLightData)
-				{
-					auto& bindingEntry = m_bindingCache.emplace_back();
-					bindingEntry.bindingIndex = bindingIndex;
-					bindingEntry.content = ShaderBinding::UniformBufferBinding{
-						currentLightData.GetBuffer(),
-						currentLightData.GetOffset(), currentLightData.GetSize()
-					};
-				}
+	void SubmeshRenderer::PrepareEnd(RenderFrame& currentFrame, ElementRendererData& rendererData)
+	{
+		auto& data = static_cast<SubmeshRendererData&>(rendererData);
+		if (data.cullingBatches.empty())
+			return;
 
-				if (UInt32 bindingIndex = material.GetEngineBindingIndex(EngineShaderBinding::Shadowmap2D); bindingIndex != Material::InvalidBindingIndex)
-				{
-					std::size_t textureBindingBaseIndex = m_textureBindingCache.size();
+		static CullingOffsets cullingOffsets = GetCullingOffsets();
 
-					for (std::size_t j = 0; j < renderState.shadowMaps2D.size(); ++j)
-					{
-						const Texture* texture = renderState.shadowMaps2D[j];
-						if (!texture)
-							texture = depthTexture2D.get();
+		std::size_t culledInstanceCount = 0;
+		for (const auto& cullingBatch : data.cullingBatches)
+			culledInstanceCount += cullingBatch.instanceCount;
 
-						auto& textureEntry = m_textureBindingCache.emplace_back();
-						textureEntry.texture = texture;
-						textureEntry.sampler = shadowSampler.get();
-					}
+		bool rebuildBinding = false;
+		rebuildBinding |= EnsureStorageBuffer(data.cullingInstanceBuffer, culledInstanceCount * cullingOffsets.instanceStride, currentFrame, "Submesh culling instances");
+		rebuildBinding |= EnsureStorageBuffer(data.cullingBatchBuffer, data.cullingBatches.size() * cullingOffsets.batchStride, currentFrame, "Submesh culling batches");
+		rebuildBinding |= EnsureStorageBuffer(data.drawCommandBuffer, data.cullingBatches.size() * cullingOffsets.drawCommandStride, currentFrame, "Submesh draw commands");
+		rebuildBinding |= EnsureStorageBuffer(data.instanceOutputBuffer, data.instanceOutputSize, currentFrame, "Submesh culled instances");
 
-					auto& bindingEntry = m_bindingCache.emplace_back();
-					bindingEntry.bindingIndex = bindingIndex;
-					bindingEntry.content = ShaderBinding::SampledTextureBindings {
-						SafeCast<UInt32>(renderState.shadowMaps2D.size()), &m_textureBindingCache[textureBindingBaseIndex]
-					};
-				}
+		if (!data.cullingDataBuffer)
+		{
+			data.cullingDataBuffer = m_device.InstantiateBuffer(BufferType::Uniform, cullingOffsets.cullingDataSize, BufferUsage::DeviceLocal | BufferUsage::Write);
+			rebuildBinding = true;
+		}
 
-				if (UInt32 bindingIndex = material.GetEngineBindingIndex(EngineShaderBinding::ShadowmapCube); bindingIndex != Material::InvalidBindingIndex)
+		// Complete the batch shader bindings now that the instance output buffer is large enough for every batch
+		for (auto& cullingBatch : data.cullingBatches)
+		{
+			cullingBatch.shaderBinding->Update({
 				{
-					std::size_t textureBindingBaseIndex = m_textureBindingCache.size();
-					
-					for (std::size_t j = 0; j < renderState.shadowMapsCube.size(); ++j)
-					{
-						const Texture* texture = renderState.shadowMapsCube[j];
-						if (!texture)
-							texture = depthTextureCube.get();
-
-						auto& textureEntry = m_textureBindingCache.emplace_back();
-						textureEntry.texture = texture;
-						textureEntry.sampler = defaultSampler.get(); //< cube shadowmap don't use depth compare
+					cullingBatch.instanceBindingIndex,
+					ShaderBinding::StorageBufferBinding {
+						data.instanceOutputBuffer.get(),
+						cullingBatch.outputOffset, cullingBatch.instanceCount * m_instanceArrayOffsets.instanceStride
 					}
-
-					auto& bindingEntry = m_bindingCache.emplace_back();
-					bindingEntry.bindingIndex = bindingIndex;
-					bindingEntry.content = ShaderBinding::SampledTextureBindings {
-						SafeCast<UInt32>(renderState.shadowMapsCube.size()), &m_textureBindingCache[textureBindingBaseIndex]
-					};
-				}
-
-				if (UInt32 bindingIndex = material.GetEngineBindingIndex(EngineShaderBinding::SkeletalDataUbo); bindingIndex != Material::InvalidBindingIndex && currentSkeletonInstance)
-				{
-					const auto& skeletalBuffer = currentSkeletonInstance->GetSkeletalBuffer();
-
-					auto& bindingEntry = m_bindingCache.emplace_back();
-					bindingEntry.bindingIndex = bindingIndex;
-					bindingEntry.content = ShaderBinding::UniformBufferBinding{
-						skeletalBuffer.get(),
-						0, skeletalBuffer->GetSize()
-					};
 				}
+			});
+		}
 
-				if (UInt32 bindingIndex = material.GetEngineBindingIndex(EngineShaderBinding::ViewerDataUbo); bindingIndex != Material::InvalidBindingIndex)
-				{
-					const auto& viewerBuffer = viewerInstance.GetViewerBuffer();
-
-					auto& bindingEntry = m_bindingCache.emplace_back();
-					bindingEntry.bindingIndex = bindingIndex;
-					bindingEntry.content = ShaderBinding::UniformBufferBinding{
-						viewerBuffer.get(),
-						0, viewerBuffer->GetSize()
-					};
-				}
+		if (!rebuildBinding && data.cullingShaderBinding)
+			return;
 
-				if (UInt32 bindingIndex = material.GetEngineBindingIndex(EngineShaderBinding::OverlayTexture); bindingIndex != Material::InvalidBindingIndex)
-				{
-					auto& bindingEntry = m_bindingCache.emplace_back();
-					bindingEntry.bindingIndex = bindingIndex;
-					bindingEntry.content = ShaderBinding::SampledTextureBinding{
-						whiteTexture2D.get(), defaultSampler.get()
-					};
-				}
+		if (data.cullingShaderBinding)
+			currentFrame.PushForRelease(std::move(data.cullingShaderBinding));
 
-				assert(currentPipeline);
-				ShaderBindingPtr drawDataBinding = currentPipeline->GetPipelineInfo().pipelineLayout->AllocateShaderBinding(0);
-				drawDataBinding->Update(m_bindingCache.data(), m_bindingCache.size());
+		data.cullingShaderBinding = Graphics::Instance()->GetInstanceCullingPipelineLayout()->AllocateShaderBinding(0);
 
-				currentShaderBinding = drawDataBinding.get();
+		assert(data.viewerInstance);
+		const auto& viewerBuffer = data.viewerInstance->GetViewerBuffer();
 
-				data.shaderBindings.emplace_back(std::move(drawDataBinding));
+		data.cullingShaderBinding->Update({
+			{
+				0,
+				ShaderBinding::UniformBufferBinding {
+					viewerBuffer.get(),
+					0, viewerBuffer->GetSize()
+				}
+			},
+			{
+				1,
+				ShaderBinding::UniformBufferBinding {
+					data.cullingDataBuffer.get(),
+					0, cullingOffsets.cullingDataSize
+				}
+			},
+			{
+				2,
+				ShaderBinding::StorageBufferBinding {
+					data.cullingInstanceBuffer.get(),
+					0, data.cullingInstanceBuffer->GetSize()
+				}
+			},
+			{
+				3,
+				ShaderBinding::StorageBufferBinding {
+					data.cullingBatchBuffer.get(),
+					0, data.cullingBatchBuffer->GetSize()
+				}
+			},
+			{
+				4,
+				ShaderBinding::StorageBufferBinding {
+					data.instanceOutputBuffer.get(),
+					0, data.instanceOutputBuffer->GetSize()
+				}
+			},
+			{
+				5,
+				ShaderBinding::StorageBufferBinding {
+					data.drawCommandBuffer.get(),
+					0, data.drawCommandBuffer->GetSize()
+				}
 			}
-
-			auto& drawCall = data.drawCalls.emplace_back();
-			drawCall.firstIndex = 0;
-			drawCall.indexBuffer = currentIndexBuffer;
-			drawCall.indexCount = submesh.GetIndexCount();
-			drawCall.indexType = submesh.GetIndexType();
-			drawCall.renderPipeline = currentPipeline;
-			drawCall.scissorBox = currentScissorBox;
-			drawCall.shaderBinding = currentShaderBinding;
-			drawCall.vertexBuffer = currentVertexBuffer;
-		}
-
-		const RenderSubmesh* firstSubmesh = static_cast<const RenderSubmesh*>(elements[0]);
-		std::size_t drawCallCount = data.drawCalls.size() - oldDrawCallCount;
-		data.drawCallPerElement[firstSubmesh] = SubmeshRendererData::DrawCallIndices{ oldDrawCallCount, drawCallCount };
+		});
 	}
 
 	void SubmeshRenderer::Render(const ViewerInstance& viewerInstance, ElementRendererData& rendererData, CommandBufferBuilder& commandBuffer, std::size_t /*elementCount*/, const Pointer<const RenderElement>* elements)
 	{
+		static CullingOffsets cullingOffsets = GetCullingOffsets();
+
 		auto& data = static_cast<SubmeshRendererData&>(rendererData);
 
 		Vector2f targetSize = viewerInstance.GetTargetSize();
@@ -269,10 +714,14 @@ namespace Nz
 
 		const RenderBuffer* currentIndexBuffer = nullptr;
 		const RenderBuffer* currentVertexBuffer = nullptr;
+		UInt64 currentVertexBufferOffset = 0;
 		const RenderPipeline* currentPipeline = nullptr;
 		const ShaderBinding* currentShaderBinding = nullptr;
+		const RenderPipelineLayout* textureTableLayout = nullptr; //< layout the bindless texture table is bound with
 		Recti currentScissorBox(-1, -1, -1, -1);
 
+		const std::shared_ptr<BindlessTextureTable>& textureTable = Graphics::Instance()->GetBindlessTextureTable();
+
 		const RenderSubmesh* firstSubmesh = static_cast<const RenderSubmesh*>(elements[0]);
 		auto it = data.drawCallPerElement.find(firstSubmesh);
 		assert(it != data.drawCallPerElement.end());
@@ -293,6 +742,18 @@ namespace Nz
 			{
 				commandBuffer.BindRenderShaderBinding(0, *drawData.shaderBinding);
 				currentShaderBinding = drawData.shaderBinding;
+
+				// Binding set 0 with another pipeline layout unbinds the texture table set
+				const RenderPipelineLayout* pipelineLayout = drawData.renderPipeline->GetPipelineInfo().pipelineLayout.get();
+				if (textureTableLayout != pipelineLayout)
+				{
+					textureTableLayout = nullptr;
+					if (drawData.bindlessTextures)
+					{
+						commandBuffer.BindRenderShaderBinding(*pipelineLayout, BindlessTextureTable::SetIndex, textureTable->GetShaderBinding());
+						textureTableLayout = pipelineLayout;
+					}
+				}
 			}
 
 			if (currentIndexBuffer != drawData.indexBuffer)
@@ -303,10 +764,12 @@ namespace Nz
 				currentIndexBuffer = drawData.indexBuffer;
 			}
 
-			if (currentVertexBuffer != drawData.vertexBuffer)
+			// Submeshes sharing a vertex buffer (see MeshArena) only differ by their offset, and share their index buffer (bound once, using first index)
+			if (currentVertexBuffer != drawData.vertexBuffer || currentVertexBufferOffset != drawData.vertexBufferOffset)
 			{
-				commandBuffer.BindVertexBuffer(0, *drawData.vertexBuffer);
+				commandBuffer.BindVertexBuffer(0, *drawData.vertexBuffer, drawData.vertexBufferOffset);
 				currentVertexBuffer = drawData.vertexBuffer;
+				currentVertexBufferOffset = drawData.vertexBufferOffset;
 			}
 
 			const Recti& targetScissorBox = (drawData.scissorBox.width >= 0) ? drawData.scissorBox : fullscreenScissorBox;
@@ -316,10 +779,16 @@ namespace Nz
 				currentScissorBox = targetScissorBox;
 			}
 
-			if (currentIndexBuffer)
-				commandBuffer.DrawIndexed(SafeCast<UInt32>(drawData.indexCount), 1U, SafeCast<UInt32>(drawData.firstIndex));
+			if (drawData.cullingBatchIndex != SubmeshRendererData::InvalidBatchIndex)
+			{
+				// Culled batches are drawn one by one as each of them binds its own range of instances, their instance count is written by the culling pass
+				UInt64 commandOffset = drawData.cullingBatchIndex * cullingOffsets.drawCommandStride;
+				commandBuffer.DrawIndexedIndirect(RenderBufferView(data.drawCommandBuffer.get(), commandOffset, cullingOffsets.drawCommandStride), 1, SafeCast<UInt32>(cullingOffsets.drawCommandStride));
+			}
+			else if (currentIndexBuffer)
+				commandBuffer.DrawIndexed(SafeCast<UInt32>(drawData.indexCount), SafeCast<UInt32>(drawData.instanceCount), SafeCast<UInt32>(drawData.firstIndex));
 			else
-				commandBuffer.Draw(SafeCast<UInt32>(drawData.indexCount), 1U, SafeCast<UInt32>(drawData.firstIndex));
+				commandBuffer.Draw(SafeCast<UInt32>(drawData.indexCount), SafeCast<UInt32>(drawData.instanceCount), SafeCast<UInt32>(drawData.firstIndex));
 		}
 	}
 
@@ -327,10 +796,207 @@ namespace Nz
 	{
 		auto& data = static_cast<SubmeshRendererData&>(rendererData);
 
-		for (auto& shaderBinding : data.shaderBindings)
-			currentFrame.PushForRelease(std::move(shaderBinding));
+		for (auto& instanceBufferPtr : data.instanceBuffers)
+		{
+			currentFrame.PushReleaseCallback([pool = m_instanceBufferPool, instanceBuffer = std::move(instanceBufferPtr)]() mutable
+			{
+				pool->instanceBuffers.push_back(std::move(instanceBuffer));
+			});
+		}
+		data.instanceBuffers.clear();
+
+		for (auto& instanceAnimationBufferPtr : data.instanceAnimationBuffers)
+		{
+			currentFrame.PushReleaseCallback([pool = m_instanceBufferPool, instanceAnimationBuffer = std::move(instanceAnimationBufferPtr)]() mutable
+			{
+				pool->instanceAnimationBuffers.push_back(std::move(instanceAnimationBuffer));
+			});
+		}
+		data.instanceAnimationBuffers.clear();
+
+		// Shader bindings are only destroyed by the cache once they weren't used for a few frames
+		for (const ShaderBinding* shaderBinding : data.shaderBindings)
+			m_shaderBindingCache->Release(shaderBinding);
 		data.shaderBindings.clear();
 
+		// Culling buffers are kept for the next rebuild, only the batch bindings (referencing the previous instance output ranges) are released
+		for (auto& cullingBatch : data.cullingBatches)
+			currentFrame.PushForRelease(std::move(cullingBatch.shaderBinding));
+		data.cullingBatches.clear();
+		data.instanceOutputSize = 0;
+
+		data.batchedWorldInstances.clear();
 		data.drawCalls.clear();
+		data.instanceBatches.clear();
+	}
+
+	void SubmeshRenderer::Update(RenderFrame& currentFrame, ElementRendererData& rendererData)
+	{
+		static CullingOffsets cullingOffsets = GetCullingOffsets();
+
+		auto& data = static_cast<SubmeshRendererData&>(rendererData);
+		if (data.instanceBatches.empty() && data.cullingBatches.empty())
+			return;
+
+		const auto& instanceOffsets = m_instanceArrayOffsets.instanceMemberOffsets;
+
+		UploadPool& uploadPool = currentFrame.GetUploadPool();
+
+		currentFrame.Execute([&](CommandBufferBuilder& builder)
+		{
+			for (const auto& instanceBatch : data.instanceBatches)
+			{
+				// Culled batches only have animation data, their instances are written by the culling pass
+				if (instanceBatch.instanceBuffer)
+				{
+					std::size_t size = m_instanceArrayOffsets.instancesOffset + instanceBatch.instanceCount * m_instanceArrayOffsets.instanceStride;
+
+					auto& allocation = uploadPool.Allocate(size);
+					for (std::size_t i = 0; i < instanceBatch.instanceCount; ++i)
+					{
+						const WorldInstance* worldInstance = data.batchedWorldInstances[instanceBatch.firstWorldInstance + i];
+
+						UInt8* instancePtr = static_cast<UInt8*>(allocation.mappedPtr) + m_instanceArrayOffsets.instancesOffset + i * m_instanceArrayOffsets.instanceStride;
+						AccessByOffset<Matrix4f&>(instancePtr, instanceOffsets.worldMatrixOffset) = worldInstance->GetWorldMatrix();
+						AccessByOffset<Matrix4f&>(instancePtr, instanceOffsets.invWorldMatrixOffset) = worldInstance->GetInvWorldMatrix();
+					}
+
+					builder.CopyBuffer(allocation, RenderBufferView(instanceBatch.instanceBuffer, 0, size));
+				}
+
+				if (instanceBatch.animationTexture)
+				{
+					const auto& animationOffsets = m_instanceAnimationArrayOffsets.instanceMemberOffsets;
+					float texelWidth = instanceBatch.animationTexture->GetTexelWidth();
+
+					std::size_t animationSize = m_instanceAnimationArrayOffsets.instancesOffset + instanceBatch.instanceCount * m_instanceAnimationArrayOffsets.instanceStride;
+
+					auto& animationAllocation = uploadPool.Allocate(animationSize);
+					for (std::size_t i = 0; i < instanceBatch.instanceCount; ++i)
+					{
+						const WorldInstance* worldInstance = data.batchedWorldInstances[instanceBatch.firstWorldInstance + i];
+						AnimationTexture::FrameSample frameSample = instanceBatch.animationTexture->Sample(worldInstance->GetAnimationClip(), worldInstance->GetAnimationTime());
+
+						UInt8* instancePtr = static_cast<UInt8*>(animationAllocation.mappedPtr) + m_instanceAnimationArrayOffsets.instancesOffset + i * m_instanceAnimationArrayOffsets.instanceStride;
+						AccessByOffset<Vector2f&>(instancePtr, animationOffsets.frameCoords) = frameSample.frameCoords;
+						AccessByOffset<float&>(instancePtr, animationOffsets.interpolation) = frameSample.interpolation;
+						AccessByOffset<float&>(instancePtr, animationOffsets.texelWidth) = texelWidth;
+					}
+
+					builder.CopyBuffer(animationAllocation, RenderBufferView(instanceBatch.instanceAnimationBuffer, 0, animationSize));
+				}
+			}
+
+			if (!data.cullingBatches.empty())
+			{
+				auto& cullingDataAllocation = uploadPool.Allocate(cullingOffsets.cullingDataSize);
+				AccessByOffset<UInt32&>(cullingDataAllocation.mappedPtr, cullingOffsets.batchCount) = SafeCast<UInt32>(data.cullingBatches.size());
+
+				builder.CopyBuffer(cullingDataAllocation, RenderBufferView(data.cullingDataBuffer.get(), 0, cullingOffsets.cullingDataSize));
+
+				std::size_t culledInstanceCount = 0;
+				for (const auto& cullingBatch : data.cullingBatches)
+					culledInstanceCount += cullingBatch.instanceCount;
+
+				std::size_t batchSize = data.cullingBatches.size() * cullingOffsets.batchStride;
+				std::size_t instanceSize = culledInstanceCount * cullingOffsets.instanceStride;
+
+				auto& batchAllocation = uploadPool.Allocate(batchSize);
+				auto& instanceAllocation = uploadPool.Allocate(instanceSize);
+
+				UInt8* batchPtr = static_cast<UInt8*>(batchAllocation.mappedPtr);
+				UInt8* instancePtr = static_cast<UInt8*>(instanceAllocation.mappedPtr);
+
+				std::size_t firstInstance = 0;
+				for (const auto& cullingBatch : data.cullingBatches)
+				{
+					AccessByOffset<UInt32&>(batchPtr, cullingOffsets.batchFirstInstance) = SafeCast<UInt32>(firstInstance);
+					AccessByOffset<UInt32&>(batchPtr, cullingOffsets.batchInstanceCount) = SafeCast<UInt32>(cullingBatch.instanceCount);
+					AccessByOffset<UInt32&>(batchPtr, cullingOffsets.batchOutputOffset) = SafeCast<UInt32>(cullingBatch.outputOffset / m_instanceArrayOffsets.instanceStride);
+					AccessByOffset<UInt32&>(batchPtr, cullingOffsets.batchIndexCount) = SafeCast<UInt32>(cullingBatch.indexCount);
+					AccessByOffset<UInt32&>(batchPtr, cullingOffsets.batchFirstIndex) = SafeCast<UInt32>(cullingBatch.firstIndex);
+					AccessByOffset<UInt32&>(batchPtr, cullingOffsets.batchCullingEnabled) = (cullingBatch.cullingEnabled) ? 1 : 0;
+					batchPtr += cullingOffsets.batchStride;
+
+					for (std::size_t i = 0; i < cullingBatch.instanceCount; ++i)
+					{
+						const WorldInstance* worldInstance = data.batchedWorldInstances[cullingBatch.firstWorldInstance + i];
+
+						AccessByOffset<Matrix4f&>(instancePtr, cullingOffsets.instanceWorldMatrix) = worldInstance->GetWorldMatrix();
+						AccessByOffset<Matrix4f&>(instancePtr, cullingOffsets.instanceInvWorldMatrix) = worldInstance->GetInvWorldMatrix();
+						AccessByOffset<Vector3f&>(instancePtr, cullingOffsets.instanceAabbMin) = cullingBatch.aabb.GetMinimum();
+						AccessByOffset<Vector3f&>(instancePtr, cullingOffsets.instanceAabbMax) = cullingBatch.aabb.GetMaximum();
+						instancePtr += cullingOffsets.instanceStride;
+					}
+
+					firstInstance += cullingBatch.instanceCount;
+				}
+
+				builder.CopyBuffer(batchAllocation, RenderBufferView(data.cullingBatchBuffer.get(), 0, batchSize));
+				builder.CopyBuffer(instanceAllocation, RenderBufferView(data.cullingInstanceBuffer.get(), 0, instanceSize));
+			}
+
+			builder.PostTransferBarrier();
+		}, QueueType::Transfer);
+
+		if (data.cullingBatches.empty())
+			return;
+
+		// Batches are culled every frame as the viewer and world instances can move without elements being rebuilt
+		currentFrame.Execute([&](CommandBufferBuilder& builder)
+		{
+			Graphics* graphics = Graphics::Instance();
+
+			builder.BeginDebugRegion("Submesh culling", Color::Orange());
+			{
+				builder.MemoryBarrier(PipelineStage::DrawIndirect | PipelineStage::VertexShader, PipelineStage::ComputeShader, MemoryAccess::IndirectCommandRead | MemoryAccess::ShaderRead, MemoryAccess::ShaderWrite);
+
+				builder.BindComputePipeline(*graphics->GetInstanceCullingPipeline());
+				builder.BindComputeShaderBinding(0, *data.cullingShaderBinding);
+				builder.Dispatch(SafeCast<UInt32>((data.cullingBatches.size() + 63) / 64), 1, 1);
+
+				builder.MemoryBarrier(PipelineStage::ComputeShader, PipelineStage::DrawIndirect | PipelineStage::VertexShader, MemoryAccess::ShaderWrite, MemoryAccess::IndirectCommandRead | MemoryAccess::ShaderRead);
+			}
+			builder.EndDebugRegion();
+		}, QueueType::Compute);
+	}
+
+	bool SubmeshRenderer::CanBeInstanced(const RenderSubmesh& first, const RenderStates& firstStates, const RenderSubmesh& submesh, const RenderStates& renderStates)
+	{
+		if (submesh.GetInstancedRenderPipeline() != first.GetInstancedRenderPipeline())
+			return false;
+
+		if (&submesh.GetMaterialInstance() != &first.GetMaterialInstance())
+			return false;
+
+		if (submesh.GetIndexBuffer() != first.GetIndexBuffer() || submesh.GetVertexBuffer() != first.GetVertexBuffer() || submesh.GetVertexBufferOffset() != first.GetVertexBufferOffset())
+			return false;
+
+		if (submesh.GetFirstIndex() != first.GetFirstIndex() || submesh.GetIndexCount() != first.GetIndexCount() || submesh.GetIndexType() != first.GetIndexType())
+			return false;
+
+		if (submesh.GetSkeletonInstance() || first.GetSkeletonInstance())
+			return false;
+
+		if (submesh.GetAnimationTexture() != first.GetAnimationTexture())
+			return false;
+
+		if (submesh.GetScissorBox() != first.GetScissorBox())
+			return false;
+
+		// Culled batches share the bounding box of their first submesh
+		if (submesh.GetAABB() != first.GetAABB())
+			return false;
+
+		if (renderStates.lightArray != firstStates.lightArray || renderStates.lightClusters != firstStates.lightClusters)
+			return false;
+
+		return renderStates.lightData == firstStates.lightData && renderStates.shadowMaps2D == firstStates.shadowMaps2D && renderStates.shadowMapsCube == firstStates.shadowMapsCube && renderStates.shadowMapsDirectional == firstStates.shadowMapsDirectional;
+	}
+
+	SubmeshRendererData::~SubmeshRendererData()
+	{
+		for (const ShaderBinding* shaderBinding : shaderBindings)
+			shaderBindingCache->Release(shaderBinding);
 	}
 }
@@ -3,7 +3,10 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Graphics/Systems/RenderSystem.hpp>
+#include <Nazara/Core/Core.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Core/Components/DisabledComponent.hpp>
+#include <Nazara/Graphics/DeferredFramePipeline.hpp>
 #include <Nazara/Graphics/ForwardFramePipeline.hpp>
 #include <Nazara/Graphics/ViewerInstance.hpp>
 #include <Nazara/Graphics/WorldInstance.hpp>
@@ -20,6 +23,34 @@
 
 namespace Nz
 {
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		constexpr std::size_t InstanceChunkSize = 1024;
+		constexpr std::size_t ParallelInstanceThreshold = 4 * InstanceChunkSize;
+
+		template<typename T>
+		T* RetrieveEntityData(const std::vector<T*>& entityData, entt::entity entity)
+		{
+			std::size_t entityIndex = static_cast<std::size_t>(entt::to_entity(entity));
+			if (entityIndex >= entityData.size())
+				return nullptr;
+
+			assert(!entityData[entityIndex] || entityData[entityIndex]->entity == entity);
+			return entityData[entityIndex];
+		}
+
+		template<typename T>
+		void StoreEntityData(std::vector<T*>& entityData, entt::entity entity, T* data)
+		{
+			std::size_t entityIndex = static_cast<std::size_t>(entt::to_entity(entity));
+			if (entityIndex >= entityData.size())
+				entityData.resize(entityIndex + 1, nullptr);
+
+			assert(!data || !entityData[entityIndex]);
+			entityData[entityIndex] = data;
+		}
+	}
+
 	RenderSystem::RenderSystem(entt::registry& registry) :
 	m_registry(registry),
 	m_cameraConstructObserver(registry, entt::collector.group<CameraComponent, NodeComponent>(entt::exclude<DisabledComponent>)),
@@ -27,9 +58,12 @@ namespace Nz
 	m_lightConstructObserver(registry, entt::collector.group<LightComponent, NodeComponent>(entt::exclude<DisabledComponent>)),
 	m_sharedSkeletonConstructObserver(registry, entt::collector.group<GraphicsComponent, NodeComponent, SharedSkeletonComponent>(entt::exclude<DisabledComponent, SkeletonComponent>)),
 	m_skeletonConstructObserver(registry, entt::collector.group<GraphicsComponent, NodeComponent, SkeletonComponent>(entt::exclude<DisabledComponent, SharedSkeletonComponent>)),
+	m_cameraCount(0),
 	m_cameraEntityPool(8),
 	m_graphicsEntityPool(1024),
-	m_lightEntityPool(32)
+	m_lightEntityPool(32),
+	m_lastFixedStepIndex(0),
+	m_transformInterpolation(false)
 	{
 		m_cameraDestroyConnection = registry.on_destroy<CameraComponent>().connect<&RenderSystem::OnCameraDestroy>(this);
 		m_disabledConstructedConnection = registry.on_construct<DisabledComponent>().connect<&RenderSystem::OnDisabledConstructed>(this);
@@ -39,7 +73,10 @@ namespace Nz
 		m_sharedSkeletonDestroyConnection = registry.on_destroy<SharedSkeletonComponent>().connect<&RenderSystem::OnSharedSkeletonDestroy>(this);
 		m_skeletonDestroyConnection = registry.on_destroy<SkeletonComponent>().connect<&RenderSystem::OnSkeletonDestroy>(this);
 
-		m_pipeline = std::make_unique<ForwardFramePipeline>(m_elementRegistry);
+		if (Graphics::Instance()->IsDeferredShadingEnabled())
+			m_pipeline = std::make_unique<DeferredFramePipeline>(m_elementRegistry);
+		else
+			m_pipeline = std::make_unique<ForwardFramePipeline>(m_elementRegistry);
 	}
 
 	RenderSystem::~RenderSystem()
@@ -55,10 +92,15 @@ namespace Nz
 		return *m_windowSwapchains.emplace_back(std::make_unique<WindowSwapchain>(Graphics::Instance()->GetRenderDevice(), window, parameters));
 	}
 
-	void RenderSystem::Update(Time /*elapsedTime*/)
+	void RenderSystem::Update(Time elapsedTime)
+	{
+		Update(elapsedTime, EnttSystemGraph::FixedStepInfo{});
+	}
+
+	void RenderSystem::Update(Time /*elapsedTime*/, const EnttSystemGraph::FixedStepInfo& fixedStepInfo)
 	{
 		UpdateObservers();
-		UpdateInstances();
+		UpdateInstances(fixedStepInfo);
 
 		for (auto& swapchainPtr : m_windowSwapchains)
 		{
@@ -66,7 +108,7 @@ namespace Nz
 			if (!frame)
 				continue;
 
-			if (!m_cameraEntities.empty())
+			if (m_cameraCount > 0)
 				m_pipeline->Render(frame);
 
 			frame.Present();
@@ -77,14 +119,15 @@ namespace Nz
 	{
 		assert(&m_registry == &registry);
 
-		auto it = m_cameraEntities.find(entity);
-		if (it == m_cameraEntities.end())
-			return;
+		NAZARA_USE_ANONYMOUS_NAMESPACE
 
-		CameraEntity* cameraEntity = it->second;
+		CameraEntity* cameraEntity = RetrieveEntityData(m_cameraEntities, entity);
+		if (!cameraEntity)
+			return;
 
-		m_cameraEntities.erase(it);
-		m_invalidatedCameraNode.erase(cameraEntity);
+		StoreEntityData<CameraEntity>(m_cameraEntities, entity, nullptr);
+		m_cameraCount--;
+		m_invalidatedCameraNode.UnboundedReset(cameraEntity->poolIndex);
 		m_pipeline->UnregisterViewer(cameraEntity->viewerIndex);
 
 		m_cameraEntityPool.Free(cameraEntity->poolIndex);
@@ -100,14 +143,15 @@ namespace Nz
 	{
 		assert(&m_registry == &registry);
 
-		auto it = m_graphicsEntities.find(entity);
-		if (it == m_graphicsEntities.end())
-			return;
+		NAZARA_USE_ANONYMOUS_NAMESPACE
 
-		GraphicsEntity* graphicsEntity = it->second;
+		GraphicsEntity* graphicsEntity = RetrieveEntityData(m_graphicsEntities, entity);
+		if (!graphicsEntity)
+			return;
 
-		m_graphicsEntities.erase(entity);
-		m_invalidatedGfxWorldNode.erase(graphicsEntity);
+		StoreEntityData<GraphicsEntity>(m_graphicsEntities, entity, nullptr);
+		m_invalidatedGfxWorldNode.UnboundedReset(graphicsEntity->poolIndex);
+		m_interpolatedGfxEntities.UnboundedReset(graphicsEntity->poolIndex);
 
 		GraphicsComponent& entityGfx = m_registry.get<GraphicsComponent>(entity);
 		if (entityGfx.IsVisible())
@@ -131,14 +175,14 @@ namespace Nz
 	{
 		assert(&m_registry == &registry);
 
-		auto it = m_lightEntities.find(entity);
-		if (it == m_lightEntities.end())
-			return;
+		NAZARA_USE_ANONYMOUS_NAMESPACE
 
-		LightEntity* lightEntity = it->second;
+		LightEntity* lightEntity = RetrieveEntityData(m_lightEntities, entity);
+		if (!lightEntity)
+			return;
 
-		m_lightEntities.erase(entity);
-		m_invalidatedLightWorldNode.erase(lightEntity);
+		StoreEntityData<LightEntity>(m_lightEntities, entity, nullptr);
+		m_invalidatedLightWorldNode.UnboundedReset(lightEntity->poolIndex);
 
 		LightComponent& entityLight = m_registry.get<LightComponent>(entity);
 		if (entityLight.IsVisible())
@@ -180,6 +224,8 @@ namespace Nz
 	{
 		assert(&m_registry == &registry);
 
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
 		SharedSkeletonComponent& skeletonComponent = registry.get<SharedSkeletonComponent>(entity);
 		Skeleton* skeleton = skeletonComponent.GetSkeleton().get();
 
@@ -194,11 +240,10 @@ namespace Nz
 			m_sharedSkeletonInstances.erase(skeletonInstanceIt);
 		}
 
-		auto it = m_graphicsEntities.find(entity);
-		if (it == m_graphicsEntities.end())
+		GraphicsEntity* graphicsEntity = RetrieveEntityData(m_graphicsEntities, entity);
+		if (!graphicsEntity)
 			return;
 
-		GraphicsEntity* graphicsEntity = it->second;
 		graphicsEntity->skeletonInstanceIndex = NoInstance;
 	}
 
@@ -206,11 +251,11 @@ namespace Nz
 	{
 		assert(&m_registry == &registry);
 
-		auto it = m_graphicsEntities.find(entity);
-		if (it == m_graphicsEntities.end())
-			return;
+		NAZARA_USE_ANONYMOUS_NAMESPACE
 
-		GraphicsEntity* graphicsEntity = it->second;
+		GraphicsEntity* graphicsEntity = RetrieveEntityData(m_graphicsEntities, entity);
+		if (!graphicsEntity)
+			return;
 
 		m_pipeline->UnregisterSkeleton(graphicsEntity->skeletonInstanceIndex);
 		graphicsEntity->skeletonInstanceIndex = NoInstance;
@@ -268,14 +313,21 @@ namespace Nz
 		}
 	}
 
-	void RenderSystem::UpdateInstances()
+	void RenderSystem::UpdateInstances(const EnttSystemGraph::FixedStepInfo& fixedStepInfo)
 	{
-		for (CameraEntity* cameraEntity : m_invalidatedCameraNode)
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		// Retrieve storages once instead of looking them up in the registry for every entity
+		const auto& nodeStorage = m_registry.storage<NodeComponent>();
+
+		auto& cameraStorage = m_registry.storage<CameraComponent>();
+		for (std::size_t poolIndex : m_invalidatedCameraNode.IterBits())
 		{
+			CameraEntity* cameraEntity = m_cameraEntityPool.RetrieveFromIndex(poolIndex);
 			entt::entity entity = cameraEntity->entity;
 
-			const NodeComponent& entityNode = m_registry.get<const NodeComponent>(entity);
-			CameraComponent& entityCamera = m_registry.get<CameraComponent>(entity);
+			const NodeComponent& entityNode = nodeStorage.get(entity);
+			CameraComponent& entityCamera = cameraStorage.get(entity);
 
 			Vector3f cameraPosition = entityNode.GetPosition(CoordSys::Global);
 			
@@ -283,26 +335,132 @@ namespace Nz
 			viewerInstance.UpdateEyePosition(cameraPosition);
 			viewerInstance.UpdateViewMatrix(Nz::Matrix4f::TransformInverse(cameraPosition, entityNode.GetRotation(CoordSys::Global)));
 		}
-		m_invalidatedCameraNode.clear();
+		m_invalidatedCameraNode.Clear();
+
+		// Nodes compute their transform matrix lazily (and may share parents) and world instances signal the frame pipeline when updated,
+		// so only matrix inversion (which is the expensive part) is done in parallel
+		m_invalidatedWorldInstances.clear();
 
-		for (GraphicsEntity* graphicsEntity : m_invalidatedGfxWorldNode)
+		auto& graphicsStorage = m_registry.storage<GraphicsComponent>();
+
+		bool interpolateTransforms = m_transformInterpolation && fixedStepInfo.timestep > Time::Zero();
+		bool newFixedStep = (fixedStepInfo.stepIndex != m_lastFixedStepIndex);
+		m_lastFixedStepIndex = fixedStepInfo.stepIndex;
+
+		if (!interpolateTransforms)
+		{
+			// Entities still being interpolated (if interpolation was just disabled) snap to their node transform
+			for (std::size_t poolIndex : m_interpolatedGfxEntities.IterBits())
+				m_invalidatedGfxWorldNode.UnboundedSet(poolIndex);
+
+			m_interpolatedGfxEntities.Clear();
+		}
+		else if (newFixedStep)
 		{
+			// Interpolated entities which didn't move during the last fixed steps have reached their final transform
+			for (std::size_t poolIndex : m_interpolatedGfxEntities.IterBits())
+			{
+				if (m_invalidatedGfxWorldNode.UnboundedTest(poolIndex))
+					continue;
+
+				GraphicsEntity* graphicsEntity = m_graphicsEntityPool.RetrieveFromIndex(poolIndex);
+				graphicsEntity->previousTransform = graphicsEntity->currentTransform;
+				m_interpolatedGfxEntities.Reset(poolIndex);
+
+				auto& invalidatedInstance = m_invalidatedWorldInstances.emplace_back();
+				invalidatedInstance.worldInstance = graphicsStorage.get(graphicsEntity->entity).GetWorldInstance().get();
+				invalidatedInstance.worldMatrix = nodeStorage.get(graphicsEntity->entity).GetTransformMatrix();
+			}
+		}
+
+		for (std::size_t poolIndex : m_invalidatedGfxWorldNode.IterBits())
+		{
+			GraphicsEntity* graphicsEntity = m_graphicsEntityPool.RetrieveFromIndex(poolIndex);
 			entt::entity entity = graphicsEntity->entity;
 
-			const NodeComponent& entityNode = m_registry.get<const NodeComponent>(entity);
-			GraphicsComponent& entityGraphics = m_registry.get<GraphicsComponent>(entity);
+			const NodeComponent& entityNode = nodeStorage.get(entity);
+
+			if (interpolateTransforms)
+			{
+				TransformState newTransform;
+				newTransform.position = entityNode.GetPosition(CoordSys::Global);
+				newTransform.rotation = entityNode.GetRotation(CoordSys::Global);
+				newTransform.scale = entityNode.GetScale(CoordSys::Global);
+
+				if (newFixedStep && graphicsEntity->hasTransformState)
+				{
+					graphicsEntity->previousTransform = graphicsEntity->currentTransform;
+					graphicsEntity->currentTransform = newTransform;
+					m_interpolatedGfxEntities.UnboundedSet(poolIndex);
+					continue; //< handled below
+				}
+
+				// New entities and entities moved outside of fixed steps are teleported
+				graphicsEntity->previousTransform = newTransform;
+				graphicsEntity->currentTransform = newTransform;
+				graphicsEntity->hasTransformState = true;
+				m_interpolatedGfxEntities.UnboundedReset(poolIndex);
+			}
+			else
+				graphicsEntity->hasTransformState = false;
+
+			auto& invalidatedInstance = m_invalidatedWorldInstances.emplace_back();
+			invalidatedInstance.worldInstance = graphicsStorage.get(entity).GetWorldInstance().get();
+			invalidatedInstance.worldMatrix = entityNode.GetTransformMatrix();
+		}
+		m_invalidatedGfxWorldNode.Clear();
+
+		// Render entities moved by fixed steps between their two last states
+		for (std::size_t poolIndex : m_interpolatedGfxEntities.IterBits())
+		{
+			GraphicsEntity* graphicsEntity = m_graphicsEntityPool.RetrieveFromIndex(poolIndex);
+			const TransformState& from = graphicsEntity->previousTransform;
+			const TransformState& to = graphicsEntity->currentTransform;
+
+			Vector3f position = Vector3f::Lerp(from.position, to.position, fixedStepInfo.alpha);
+			Quaternionf rotation = Quaternionf::Slerp(from.rotation, to.rotation, fixedStepInfo.alpha);
+			Vector3f scale = Vector3f::Lerp(from.scale, to.scale, fixedStepInfo.alpha);
+
+			auto& invalidatedInstance = m_invalidatedWorldInstances.emplace_back();
+			invalidatedInstance.worldInstance = graphicsStorage.get(graphicsEntity->entity).GetWorldInstance().get();
+			invalidatedInstance.worldMatrix = Matrix4f::Transform(position, rotation, scale);
+		}
+
+		auto InvertChunk = [&](std::size_t first, std::size_t last)
+		{
+			for (std::size_t i = first; i < last; ++i)
+			{
+				auto& invalidatedInstance = m_invalidatedWorldInstances[i];
+				invalidatedInstance.isInvertible = invalidatedInstance.worldMatrix.GetInverseTransform(&invalidatedInstance.invWorldMatrix);
+			}
+		};
+
+		std::size_t invalidatedInstanceCount = m_invalidatedWorldInstances.size();
+		if (invalidatedInstanceCount >= ParallelInstanceThreshold)
+			Core::Instance()->GetTaskScheduler().ForEachChunk(invalidatedInstanceCount, InstanceChunkSize, InvertChunk);
+		else
+			InvertChunk(0, invalidatedInstanceCount);
+
+		for (const auto& invalidatedInstance : m_invalidatedWorldInstances)
+		{
+			if (!invalidatedInstance.isInvertible)
+			{
+				NazaraError("failed to inverse world matrix");
+				invalidatedInstance.worldInstance->UpdateWorldMatrix(invalidatedInstance.worldMatrix, invalidatedInstance.worldInstance->GetInvWorldMatrix());
+				continue;
+			}
 
-			const WorldInstancePtr& worldInstance = entityGraphics.GetWorldInstance();
-			worldInstance->UpdateWorldMatrix(entityNode.GetTransformMatrix());
+			invalidatedInstance.worldInstance->UpdateWorldMatrix(invalidatedInstance.worldMatrix, invalidatedInstance.invWorldMatrix);
 		}
-		m_invalidatedGfxWorldNode.clear();
 
-		for (LightEntity* lightEntity : m_invalidatedLightWorldNode)
+		auto& lightStorage = m_registry.storage<LightComponent>();
+		for (std::size_t poolIndex : m_invalidatedLightWorldNode.IterBits())
 		{
+			LightEntity* lightEntity = m_lightEntityPool.RetrieveFromIndex(poolIndex);
 			entt::entity entity = lightEntity->entity;
 
-			const NodeComponent& entityNode = m_registry.get<const NodeComponent>(entity);
-			LightComponent& entityLight = m_registry.get<LightComponent>(entity);
+			const NodeComponent& entityNode = nodeStorage.get(entity);
+			LightComponent& entityLight = lightStorage.get(entity);
 
 			const Vector3f& position = entityNode.GetPosition(CoordSys::Global);
 			const Quaternionf& rotation = entityNode.GetRotation(CoordSys::Global);
@@ -316,11 +474,13 @@ namespace Nz
 				lightEntry.light->UpdateTransform(position, rotation, scale);
 			}
 		}
-		m_invalidatedLightWorldNode.clear();
+		m_invalidatedLightWorldNode.Clear();
 	}
 
 	void RenderSystem::UpdateObservers()
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
 		m_cameraConstructObserver.each([&](entt::entity entity)
 		{
 			CameraComponent& entityCamera = m_registry.get<CameraComponent>(entity);
@@ -333,13 +493,13 @@ namespace Nz
 			cameraEntity->viewerIndex = m_pipeline->RegisterViewer(&entityCamera, entityCamera.GetRenderOrder());
 			cameraEntity->onNodeInvalidation.Connect(entityNode.OnNodeInvalidation, [this, cameraEntity](const Node* /*node*/)
 			{
-				m_invalidatedCameraNode.insert(cameraEntity);
+				m_invalidatedCameraNode.UnboundedSet(cameraEntity->poolIndex);
 			});
 
-			m_invalidatedCameraNode.insert(cameraEntity);
+			m_invalidatedCameraNode.UnboundedSet(poolIndex);
 
-			assert(m_cameraEntities.find(entity) == m_cameraEntities.end());
-			m_cameraEntities.emplace(entity, cameraEntity);
+			StoreEntityData(m_cameraEntities, entity, cameraEntity);
+			m_cameraCount++;
 		});
 		
 		m_graphicsConstructObserver.each([&](entt::entity entity)
@@ -354,9 +514,10 @@ namespace Nz
 			graphicsEntity->renderableIndices.fill(NoInstance);
 			graphicsEntity->skeletonInstanceIndex = NoInstance; //< will be set in skeleton observer
 			graphicsEntity->worldInstanceIndex = m_pipeline->RegisterWorldInstance(entityGfx.GetWorldInstance());
+			graphicsEntity->hasTransformState = false;
 			graphicsEntity->onNodeInvalidation.Connect(entityNode.OnNodeInvalidation, [this, graphicsEntity](const Node* /*node*/)
 			{
-				m_invalidatedGfxWorldNode.insert(graphicsEntity);
+				m_invalidatedGfxWorldNode.UnboundedSet(graphicsEntity->poolIndex);
 			});
 
 			graphicsEntity->onRenderableAttached.Connect(entityGfx.OnRenderableAttached, [this, graphicsEntity](GraphicsComponent* gfx, std::size_t renderableIndex)
@@ -396,13 +557,12 @@ namespace Nz
 			{
 				UpdateGraphicsVisibility(graphicsEntity, *gfx, isVisible);
 			});
-			m_invalidatedGfxWorldNode.insert(graphicsEntity);
+			m_invalidatedGfxWorldNode.UnboundedSet(poolIndex);
 
 			if (entityGfx.IsVisible())
 				UpdateGraphicsVisibility(graphicsEntity, m_registry.get<GraphicsComponent>(entity), true);
 
-			assert(m_graphicsEntities.find(entity) == m_graphicsEntities.end());
-			m_graphicsEntities.emplace(entity, graphicsEntity);
+			StoreEntityData(m_graphicsEntities, entity, graphicsEntity);
 		});
 
 		m_lightConstructObserver.each([&](entt::entity entity)
@@ -416,12 +576,7 @@ namespace Nz
 			lightEntity->poolIndex = poolIndex;
 			lightEntity->onNodeInvalidation.Connect(entityNode.OnNodeInvalidation, [this, lightEntity](const Node* /*node*/)
 			{
-				m_invalidatedLightWorldNode.insert(lightEntity);
-			});
-
-			lightEntity->onNodeInvalidation.Connect(entityNode.OnNodeInvalidation, [this, lightEntity](const Node* /*node*/)
-			{
-				m_invalidatedLightWorldNode.insert(lightEntity);
+				m_invalidatedLightWorldNode.UnboundedSet(lightEntity->poolIndex);
 			});
 
 			lightEntity->onLightAttached.Connect(entityLight.OnLightAttached, [this, lightEntity](LightComponent* light, std::size_t lightIndex)
@@ -446,18 +601,18 @@ namespace Nz
 				UpdateLightVisibility(lightEntity, *light, isVisible);
 			});
 
-			m_invalidatedLightWorldNode.insert(lightEntity);
+			m_invalidatedLightWorldNode.UnboundedSet(poolIndex);
 
 			if (entityLight.IsVisible())
 				UpdateLightVisibility(lightEntity, m_registry.get<LightComponent>(entity), true);
 
-			assert(m_lightEntities.find(entity) == m_lightEntities.end());
-			m_lightEntities.emplace(entity, lightEntity);
+			StoreEntityData(m_lightEntities, entity, lightEntity);
 		});
 
 		m_sharedSkeletonConstructObserver.each([&](entt::entity entity)
 		{
-			GraphicsEntity* graphicsEntity = Retrieve(m_graphicsEntities, entity);
+			GraphicsEntity* graphicsEntity = RetrieveEntityData(m_graphicsEntities, entity);
+			assert(graphicsEntity);
 
 			SharedSkeletonComponent& skeletonComponent = m_registry.get<SharedSkeletonComponent>(entity);
 			const std::shared_ptr<Skeleton>& skeleton = skeletonComponent.GetSkeleton();
@@ -485,7 +640,8 @@ namespace Nz
 
 		m_skeletonConstructObserver.each([&](entt::entity entity)
 		{
-			GraphicsEntity* graphicsEntity = Retrieve(m_graphicsEntities, entity);
+			GraphicsEntity* graphicsEntity = RetrieveEntityData(m_graphicsEntities, entity);
+			assert(graphicsEntity);
 
 			SkeletonComponent& skeletonComponent = m_registry.get<SkeletonComponent>(entity);
 			const std::shared_ptr<Skeleton>& skeleton = skeletonComponent.GetSkeleton();
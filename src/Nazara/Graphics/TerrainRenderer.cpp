@@ -0,0 +1,160 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/TerrainRenderer.hpp>
+#include <Nazara/Graphics/ClipmapTerrain.hpp>
+#include <Nazara/Graphics/Graphics.hpp>
+#include <Nazara/Graphics/ViewerInstance.hpp>
+#include <Nazara/Renderer/CommandBufferBuilder.hpp>
+#include <Nazara/Renderer/RenderBuffer.hpp>
+#include <Nazara/Renderer/RenderFrame.hpp>
+#include <cmath>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup graphics
+	* \class TerrainRenderer
+	* \brief Element renderer drawing clipmap terrains
+	*
+	* Every terrain is a single instanced draw of its grid, with one instance per clipmap level.
+	*/
+	RenderElementPool<RenderTerrain>& TerrainRenderer::GetPool()
+	{
+		return m_terrainPool;
+	}
+
+	std::unique_ptr<ElementRendererData> TerrainRenderer::InstanciateData()
+	{
+		return std::make_unique<TerrainRendererData>();
+	}
+
+	void TerrainRenderer::Prepare(const ViewerInstance& viewerInstance, ElementRendererData& rendererData, RenderFrame& currentFrame, std::size_t elementCount, const Pointer<const RenderElement>* elements, const RenderStates* /*renderStates*/)
+	{
+		Graphics* graphics = Graphics::Instance();
+
+		auto& data = static_cast<TerrainRendererData&>(rendererData);
+
+		const auto& colorSampler = graphics->GetSamplerCache().Get({});
+
+		for (std::size_t i = 0; i < elementCount; ++i)
+		{
+			assert(elements[i]->GetElementType() == UnderlyingCast(BasicRenderElement::Terrain));
+			const RenderTerrain& renderTerrain = static_cast<const RenderTerrain&>(*elements[i]);
+			const ClipmapTerrain& terrain = renderTerrain.GetTerrain();
+			const WorldInstance& worldInstance = renderTerrain.GetWorldInstance();
+			const RenderBufferView& instanceBuffer = worldInstance.GetInstanceBuffer();
+
+			auto& instanceData = data.instances[{ &worldInstance, &terrain }];
+			if (instanceData.shaderBinding)
+			{
+				// Another world instance or terrain may have been allocated at the address of a released one
+				if (instanceData.terrainBuffer == terrain.GetTerrainBuffer() && instanceData.instanceBuffer == instanceBuffer.GetBuffer() && instanceData.instanceBufferOffset == instanceBuffer.GetOffset())
+				{
+					instanceData.isUsed = true;
+					continue;
+				}
+
+				currentFrame.PushForRelease(std::move(instanceData));
+				instanceData = TerrainRendererData::InstanceData{};
+			}
+
+			instanceData.terrainBuffer = terrain.GetTerrainBuffer();
+			instanceData.instanceBuffer = instanceBuffer.GetBuffer();
+			instanceData.instanceBufferOffset = instanceBuffer.GetOffset();
+			instanceData.isUsed = true;
+
+			instanceData.shaderBinding = graphics->GetTerrainRenderPipelineLayout()->AllocateShaderBinding(0);
+			instanceData.shaderBinding->Update({
+				{
+					0,
+					ShaderBinding::UniformBufferBinding {
+						viewerInstance.GetViewerBuffer().get(),
+						0, viewerInstance.GetViewerBuffer()->GetSize()
+					}
+				},
+				{
+					1,
+					ShaderBinding::UniformBufferBinding {
+						instanceBuffer.GetBuffer(),
+						instanceBuffer.GetOffset(), instanceBuffer.GetSize()
+					}
+				},
+				{
+					2,
+					ShaderBinding::UniformBufferBinding {
+						terrain.GetTerrainBuffer().get(),
+						0, terrain.GetTerrainBuffer()->GetSize()
+					}
+				},
+				{
+					3,
+					ShaderBinding::TextureBinding {
+						terrain.GetHeightClipmap().get(),
+						TextureAccess::ReadOnly
+					}
+				},
+				{
+					4,
+					ShaderBinding::SampledTextureBinding {
+						terrain.GetColorClipmap().get(),
+						colorSampler.get()
+					}
+				}
+			});
+		}
+	}
+
+	void TerrainRenderer::PrepareEnd(RenderFrame& currentFrame, ElementRendererData& rendererData)
+	{
+		auto& data = static_cast<TerrainRendererData&>(rendererData);
+
+		// Release data of terrains which are no longer visible
+		for (auto it = data.instances.begin(); it != data.instances.end();)
+		{
+			if (!it->second.isUsed)
+			{
+				currentFrame.PushForRelease(std::move(it->second));
+				it = data.instances.erase(it);
+			}
+			else
+				++it;
+		}
+	}
+
+	void TerrainRenderer::Render(const ViewerInstance& viewerInstance, ElementRendererData& rendererData, CommandBufferBuilder& commandBuffer, std::size_t elementCount, const Pointer<const RenderElement>* elements)
+	{
+		Graphics* graphics = Graphics::Instance();
+
+		auto& data = static_cast<TerrainRendererData&>(rendererData);
+
+		commandBuffer.BindRenderPipeline(*graphics->GetTerrainRenderPipeline());
+
+		Vector2f targetSize = viewerInstance.GetTargetSize();
+		commandBuffer.SetScissor(Recti(0, 0, SafeCast<int>(std::floor(targetSize.x)), SafeCast<int>(std::floor(targetSize.y))));
+
+		for (std::size_t i = 0; i < elementCount; ++i)
+		{
+			const RenderTerrain& renderTerrain = static_cast<const RenderTerrain&>(*elements[i]);
+			const ClipmapTerrain& terrain = renderTerrain.GetTerrain();
+
+			auto it = data.instances.find({ &renderTerrain.GetWorldInstance(), &terrain });
+			assert(it != data.instances.end());
+
+			commandBuffer.BindIndexBuffer(*terrain.GetIndexBuffer(), IndexType::U32);
+			commandBuffer.BindRenderShaderBinding(0, *it->second.shaderBinding);
+			commandBuffer.DrawIndexed(terrain.GetIndexCount(), terrain.GetLevelCount());
+		}
+	}
+
+	void TerrainRenderer::Reset(ElementRendererData& rendererData, RenderFrame& /*currentFrame*/)
+	{
+		auto& data = static_cast<TerrainRendererData&>(rendererData);
+
+		// Shader bindings are kept for terrains which are still visible after the next Prepare
+		for (auto&& [key, instanceData] : data.instances)
+			instanceData.isUsed = false;
+	}
+}
@@ -9,6 +9,7 @@
 #include <Nazara/Graphics/WorldInstance.hpp>
 #include <Nazara/Utility/AbstractTextDrawer.hpp>
 #include <NazaraUtils/CallOnExit.hpp>
+#include <algorithm>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
@@ -23,6 +24,9 @@ namespace Nz
 
 	void TextSprite::BuildElement(ElementRendererRegistry& registry, const ElementData& elementData, std::size_t passIndex, std::vector<RenderElementOwner>& elements) const
 	{
+		if (m_material->HasPass(elementData.excludedPassIndex))
+			return;
+
 		const auto& materialPipeline = m_material->GetPipeline(passIndex);
 		if (!materialPipeline)
 			return;
@@ -61,6 +65,22 @@ namespace Nz
 	}
 
 	void TextSprite::Update(const AbstractTextDrawer& drawer, float scale)
+	{
+		Update(drawer, 0, drawer.GetGlyphCount(), scale);
+	}
+
+	/*!
+	* \brief Builds the sprite from a range of glyphs of a text drawer
+	*
+	* Only the glyphs of the range are turned into quads (which is useful when only a part of the text is visible),
+	* they are positioned (and the AABB is computed) relative to the whole text bounds.
+	*
+	* \param drawer Text drawer
+	* \param firstGlyph Index of the first glyph to display
+	* \param glyphCount Number of glyphs to display, clamped to the drawer glyph count
+	* \param scale Scale applied to the glyphs
+	*/
+	void TextSprite::Update(const AbstractTextDrawer& drawer, std::size_t firstGlyph, std::size_t glyphCount, float scale)
 	{
 		CallOnExit clearOnFail([this]()
 		{
@@ -103,7 +123,7 @@ namespace Nz
 				++atlasIt;
 		}
 
-		std::size_t glyphCount = drawer.GetGlyphCount();
+		std::size_t endGlyph = std::min(drawer.GetGlyphCount(), firstGlyph + std::min(glyphCount, drawer.GetGlyphCount()));
 
 		// Reset glyph count for every texture to zero
 		for (auto& pair : m_renderInfos)
@@ -115,7 +135,7 @@ namespace Nz
 
 		// Iterate over visible (non-space) glyphs
 		std::size_t visibleGlyphCount = 0;
-		for (std::size_t i = 0; i < glyphCount; ++i)
+		for (std::size_t i = firstGlyph; i < endGlyph; ++i)
 		{
 			const AbstractTextDrawer::Glyph& glyph = drawer.GetGlyph(i);
 			if (!glyph.atlas)
@@ -164,7 +184,7 @@ namespace Nz
 
 		lastRenderKey = { nullptr, 0 };
 		RenderIndices* indices = nullptr;
-		for (unsigned int i = 0; i < glyphCount; ++i)
+		for (std::size_t i = firstGlyph; i < endGlyph; ++i)
 		{
 			const AbstractTextDrawer::Glyph& glyph = drawer.GetGlyph(i);
 			if (!glyph.atlas)
@@ -4,16 +4,47 @@
 
 #include <Nazara/Graphics/TextureSamplerCache.hpp>
 #include <Nazara/Renderer/RenderDevice.hpp>
+#include <mutex>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
 {
 	const std::shared_ptr<TextureSampler>& TextureSamplerCache::Get(const TextureSamplerInfo& info)
 	{
+		{
+			std::shared_lock lock(m_mutex);
+
+			// References to unordered_map elements are stable, samplers are never removed
+			auto it = m_samplers.find(info);
+			if (it != m_samplers.end())
+				return it->second;
+		}
+
+		std::unique_lock lock(m_mutex);
+
+		// Another thread may have created it between the two locks
 		auto it = m_samplers.find(info);
 		if (it == m_samplers.end())
 			it = m_samplers.emplace(info, m_device->InstantiateTextureSampler(info)).first;
 
 		return it->second;
 	}
+
+	/*!
+	* \brief Creates samplers ahead of time
+	*
+	* Avoids creating them (and taking the exclusive lock) later, when loading resources.
+	*/
+	void TextureSamplerCache::Preallocate(const TextureSamplerInfo* infos, std::size_t infoCount)
+	{
+		std::unique_lock lock(m_mutex);
+
+		m_samplers.reserve(m_samplers.size() + infoCount);
+		for (std::size_t i = 0; i < infoCount; ++i)
+		{
+			const TextureSamplerInfo& info = infos[i];
+			if (m_samplers.find(info) == m_samplers.end())
+				m_samplers.emplace(info, m_device->InstantiateTextureSampler(info));
+		}
+	}
 }
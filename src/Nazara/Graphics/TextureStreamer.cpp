@@ -0,0 +1,512 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/TextureStreamer.hpp>
+#include <Nazara/Core/Core.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Graphics/MaterialInstance.hpp>
+#include <Nazara/Renderer/RenderDevice.hpp>
+#include <Nazara/Renderer/RenderFrame.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup graphics
+	* \class Nz::TextureStreamer
+	* \brief Graphics class keeping textures partially resident on the GPU according to their on-screen usage
+	*
+	* Registered textures are first uploaded with their coarsest levels only (up to Config::minResidentSize), finer levels are
+	* uploaded once usage reports (usually coming from the ForwardFramePipeline) require them, as long as the memory budget allows it.
+	* Textures which are not used anymore fall back to their coarsest levels after Config::evictionDelay frames.
+	*
+	* Since texture level count cannot change once created, raising or lowering residency creates a new texture which replaces
+	* the previous one in every bound material instance.
+	*
+	* The memory budget is lowered when the device reports less free memory than needed (see RenderDevice::GetMemoryHeapStatistics),
+	* so residency is lowered before the device memory is exhausted. Streamed textures are frequently reallocated, their memory is
+	* defragmented every Config::defragmentationInterval frames and relocated textures are rebound like on residency changes.
+	*
+	* \remark Only 2D textures are streamed, other image types are kept fully resident
+	*/
+
+	TextureStreamer::TextureStreamer(std::shared_ptr<RenderDevice> renderDevice, Config config) :
+	m_renderDevice(std::move(renderDevice)),
+	m_config(config),
+	m_textures(256),
+	m_frameIndex(0),
+	m_memoryBudget(m_config.memoryBudget),
+	m_residentMemory(0)
+	{
+		NazaraAssert(m_renderDevice, "invalid render device");
+	}
+
+	TextureStreamer::~TextureStreamer() = default;
+
+	/*!
+	* \brief Sets a material texture property to a streamed texture and keeps it updated when residency changes
+	*
+	* \param textureIndex Streamed texture index
+	* \param materialInstance Material instance using the texture, it will be kept alive until unbound
+	* \param texturePropertyIndex Texture property index in the material instance
+	*/
+	void TextureStreamer::BindMaterialTexture(std::size_t textureIndex, std::shared_ptr<MaterialInstance> materialInstance, std::size_t texturePropertyIndex)
+	{
+		NazaraAssert(m_registeredTextures.UnboundedTest(textureIndex), "invalid texture index");
+		NazaraAssert(materialInstance, "invalid material instance");
+
+		TextureData* textureData = m_textures.RetrieveFromIndex(textureIndex);
+		if (textureData->texture)
+			materialInstance->SetTextureProperty(texturePropertyIndex, textureData->texture);
+
+		std::vector<std::size_t>& materialTextures = m_materialTextures[materialInstance.get()];
+		if (std::find(materialTextures.begin(), materialTextures.end(), textureIndex) == materialTextures.end())
+			materialTextures.push_back(textureIndex);
+
+		auto& binding = textureData->materialBindings.emplace_back();
+		binding.materialInstance = std::move(materialInstance);
+		binding.texturePropertyIndex = texturePropertyIndex;
+	}
+
+	UInt8 TextureStreamer::GetResidentLevel(std::size_t textureIndex) const
+	{
+		NazaraAssert(m_registeredTextures.UnboundedTest(textureIndex), "invalid texture index");
+
+		return m_textures.RetrieveFromIndex(textureIndex)->residentLevel;
+	}
+
+	/*!
+	* \brief Returns the texture currently holding the resident levels
+	* \return Texture pointer, which is null until the image has been loaded
+	*
+	* \remark The returned texture is replaced (and not updated) when residency changes
+	*/
+	const std::shared_ptr<Texture>& TextureStreamer::GetTexture(std::size_t textureIndex) const
+	{
+		NazaraAssert(m_registeredTextures.UnboundedTest(textureIndex), "invalid texture index");
+
+		return m_textures.RetrieveFromIndex(textureIndex)->texture;
+	}
+
+	/*!
+	* \brief Registers an in-memory image for streaming
+	* \return Streamed texture index
+	*
+	* \remark Single-level uncompressed 2D images get their mipmaps generated in the background on a copy
+	*/
+	std::size_t TextureStreamer::RegisterTexture(std::shared_ptr<Image> image)
+	{
+		NazaraAssert(image && image->IsValid(), "invalid image");
+
+		std::size_t textureIndex;
+		TextureData* textureData = m_textures.Allocate(textureIndex);
+		m_registeredTextures.UnboundedSet(textureIndex);
+
+		if (image->GetType() == ImageType::E2D && image->GetLevelCount() == 1 && !PixelFormatInfo::IsCompressed(image->GetFormat()))
+		{
+			textureData->pendingImage = std::make_shared<PendingImage>();
+			textureData->loadingTask = Core::Instance()->GetTaskScheduler().AddTask([pendingImage = textureData->pendingImage, sourceImage = std::move(image)]
+			{
+				std::shared_ptr<Image> mipmappedImage = std::make_shared<Image>(*sourceImage);
+				if (!mipmappedImage->GenerateMipmaps())
+					mipmappedImage = sourceImage; //< streaming will be disabled for this texture
+
+				pendingImage->image = std::move(mipmappedImage);
+			});
+		}
+		else
+			textureData->image = std::move(image);
+
+		return textureIndex;
+	}
+
+	/*!
+	* \brief Registers an image file for streaming, the file is loaded in the background
+	* \return Streamed texture index
+	*/
+	std::size_t TextureStreamer::RegisterTexture(std::filesystem::path filePath, ImageParams params)
+	{
+		std::size_t textureIndex;
+		TextureData* textureData = m_textures.Allocate(textureIndex);
+		m_registeredTextures.UnboundedSet(textureIndex);
+
+		textureData->pendingImage = std::make_shared<PendingImage>();
+		textureData->loadingTask = Core::Instance()->GetTaskScheduler().AddTask([pendingImage = textureData->pendingImage, filePath = std::move(filePath), params = std::move(params)]
+		{
+			std::shared_ptr<Image> image = Image::LoadFromFile(filePath, params);
+			if (!image)
+				return;
+
+			if (image->GetType() == ImageType::E2D && image->GetLevelCount() == 1 && !PixelFormatInfo::IsCompressed(image->GetFormat()))
+				image->GenerateMipmaps();
+
+			pendingImage->image = std::move(image);
+		});
+
+		return textureIndex;
+	}
+
+	/*!
+	* \brief Reports every streamed texture bound to a material as used this frame
+	*
+	* \param materialInstance Material instance
+	* \param screenSize Size (in pixels) of the largest on-screen dimension of the object using the material
+	*/
+	void TextureStreamer::ReportMaterialUsage(const MaterialInstance* materialInstance, float screenSize)
+	{
+		auto it = m_materialTextures.find(materialInstance);
+		if (it == m_materialTextures.end())
+			return;
+
+		for (std::size_t textureIndex : it->second)
+			ReportTextureUsage(textureIndex, screenSize);
+	}
+
+	/*!
+	* \brief Reports a streamed texture as used this frame
+	*
+	* \param textureIndex Streamed texture index
+	* \param screenSize Size (in pixels) of the largest on-screen dimension of the object using the texture
+	*
+	* The requested level is the one whose texel density matches the screen size, assuming the texture covers the object once
+	*/
+	void TextureStreamer::ReportTextureUsage(std::size_t textureIndex, float screenSize)
+	{
+		NazaraAssert(m_registeredTextures.UnboundedTest(textureIndex), "invalid texture index");
+
+		TextureData* textureData = m_textures.RetrieveFromIndex(textureIndex);
+		textureData->lastUsedFrame = m_frameIndex;
+
+		if (!textureData->image || screenSize <= 0.f)
+			return;
+
+		float textureSize = float(std::max(textureData->image->GetWidth(), textureData->image->GetHeight()));
+		float level = std::log2(textureSize / screenSize) + m_config.lodBias;
+
+		textureData->requestedLevel = std::min(textureData->requestedLevel, level);
+		textureData->screenCoverage = std::max(textureData->screenCoverage, screenSize);
+	}
+
+	void TextureStreamer::UnbindMaterial(const MaterialInstance* materialInstance)
+	{
+		auto it = m_materialTextures.find(materialInstance);
+		if (it == m_materialTextures.end())
+			return;
+
+		for (std::size_t textureIndex : it->second)
+		{
+			TextureData* textureData = m_textures.RetrieveFromIndex(textureIndex);
+			auto& bindings = textureData->materialBindings;
+			bindings.erase(std::remove_if(bindings.begin(), bindings.end(), [&](const MaterialBinding& binding) { return binding.materialInstance.get() == materialInstance; }), bindings.end());
+		}
+
+		m_materialTextures.erase(it);
+	}
+
+	/*!
+	* \brief Unregisters a streamed texture
+	*
+	* \remark Bound material instances keep the last texture they were given
+	*/
+	void TextureStreamer::UnregisterTexture(std::size_t textureIndex)
+	{
+		NazaraAssert(m_registeredTextures.UnboundedTest(textureIndex), "invalid texture index");
+
+		TextureData* textureData = m_textures.RetrieveFromIndex(textureIndex);
+		for (const MaterialBinding& binding : textureData->materialBindings)
+		{
+			auto it = m_materialTextures.find(binding.materialInstance.get());
+			if (it == m_materialTextures.end())
+				continue;
+
+			auto& materialTextures = it->second;
+			materialTextures.erase(std::remove(materialTextures.begin(), materialTextures.end(), textureIndex), materialTextures.end());
+			if (materialTextures.empty())
+				m_materialTextures.erase(it);
+		}
+
+		m_residentMemory -= textureData->memoryUsage;
+
+		// A pending loading task only references its own result and can safely outlive the texture data
+		m_textures.Free(textureIndex);
+		m_registeredTextures.UnboundedReset(textureIndex);
+	}
+
+	/*!
+	* \brief Finishes background loads and updates texture residency from usage reported since the last update
+	*
+	* Textures are first given the level they requested, if the memory budget is exceeded the least recently used
+	* and smallest on-screen textures are lowered first. Raising residency is limited by Config::uploadBudget per frame,
+	* giving priority to the most recently used and largest on-screen textures.
+	*
+	* \param renderFrame Frame used to release replaced textures once the GPU is done with them
+	*/
+	void TextureStreamer::Update(RenderFrame& renderFrame)
+	{
+		++m_frameIndex;
+
+		m_sortedTextures.clear();
+		for (std::size_t textureIndex : m_registeredTextures.IterBits())
+		{
+			TextureData* textureData = m_textures.RetrieveFromIndex(textureIndex);
+			if (!textureData->image)
+			{
+				if (!textureData->loadingTask.IsValid() || !textureData->loadingTask.IsFinished())
+					continue;
+
+				textureData->loadingTask = {};
+				textureData->image = std::move(textureData->pendingImage->image);
+				textureData->pendingImage.reset();
+
+				if (!textureData->image)
+				{
+					NazaraError("failed to load streamed texture #{0}", textureIndex);
+					continue;
+				}
+			}
+
+			if (!textureData->texture)
+			{
+				textureData->baseLevel = ComputeBaseLevel(*textureData->image);
+				textureData->targetLevel = textureData->baseLevel;
+
+				if (!Reside(textureIndex, *textureData, textureData->baseLevel, renderFrame))
+					continue;
+			}
+
+			// Keep the last requested level until the texture stays unused for too long
+			if (std::isfinite(textureData->requestedLevel))
+				textureData->targetLevel = SafeCast<UInt8>(std::clamp(std::floor(textureData->requestedLevel), 0.f, float(textureData->baseLevel)));
+			else if (m_frameIndex - textureData->lastUsedFrame > m_config.evictionDelay)
+			{
+				textureData->targetLevel = textureData->baseLevel;
+				textureData->screenCoverage = 0.f;
+			}
+
+			textureData->requestedLevel = std::numeric_limits<float>::infinity();
+
+			m_sortedTextures.push_back(textureIndex);
+		}
+
+		// Most recently used and largest on-screen textures first
+		std::sort(m_sortedTextures.begin(), m_sortedTextures.end(), [&](std::size_t lhs, std::size_t rhs)
+		{
+			const TextureData* lhsData = m_textures.RetrieveFromIndex(lhs);
+			const TextureData* rhsData = m_textures.RetrieveFromIndex(rhs);
+			if (lhsData->lastUsedFrame != rhsData->lastUsedFrame)
+				return lhsData->lastUsedFrame > rhsData->lastUsedFrame;
+
+			return lhsData->screenCoverage > rhsData->screenCoverage;
+		});
+
+		// Fit targets in the memory budget, lowering textures starting from the lowest priority
+		m_memoryBudget = ComputeMemoryBudget();
+
+		UInt64 targetMemory = 0;
+		for (std::size_t textureIndex : m_sortedTextures)
+		{
+			const TextureData* textureData = m_textures.RetrieveFromIndex(textureIndex);
+			targetMemory += ComputeMemoryUsage(*textureData, textureData->targetLevel);
+		}
+
+		for (auto it = m_sortedTextures.rbegin(); it != m_sortedTextures.rend() && targetMemory > m_memoryBudget; ++it)
+		{
+			TextureData* textureData = m_textures.RetrieveFromIndex(*it);
+			while (textureData->targetLevel < textureData->baseLevel && targetMemory > m_memoryBudget)
+			{
+				targetMemory -= ComputeMemoryUsage(*textureData, textureData->targetLevel);
+				textureData->targetLevel++;
+				targetMemory += ComputeMemoryUsage(*textureData, textureData->targetLevel);
+			}
+		}
+
+		// Evict first to free memory before raising residency
+		for (std::size_t textureIndex : m_sortedTextures)
+		{
+			TextureData* textureData = m_textures.RetrieveFromIndex(textureIndex);
+			if (textureData->targetLevel > textureData->residentLevel)
+				Reside(textureIndex, *textureData, textureData->targetLevel, renderFrame);
+		}
+
+		UInt64 uploadedBytes = 0;
+		for (std::size_t textureIndex : m_sortedTextures)
+		{
+			TextureData* textureData = m_textures.RetrieveFromIndex(textureIndex);
+			if (textureData->targetLevel >= textureData->residentLevel)
+				continue;
+
+			// Go as fine as the upload budget allows, always allowing at least one step per frame to ensure progress
+			UInt8 level = SafeCast<UInt8>(textureData->residentLevel - 1);
+			while (level > textureData->targetLevel && uploadedBytes + ComputeMemoryUsage(*textureData, level - 1) <= m_config.uploadBudget)
+				level--;
+
+			UInt64 uploadSize = ComputeMemoryUsage(*textureData, level);
+			if (uploadedBytes > 0 && uploadedBytes + uploadSize > m_config.uploadBudget)
+				break;
+
+			if (Reside(textureIndex, *textureData, level, renderFrame))
+				uploadedBytes += uploadSize;
+		}
+
+		if (m_config.defragmentationInterval > 0 && m_frameIndex % m_config.defragmentationInterval == 0)
+		{
+			m_renderDevice->DefragmentStreamedTextures(renderFrame, m_config.defragmentationBudget, [&](Texture& texture)
+			{
+				// Few textures are relocated by each step, a linear search is fine
+				for (std::size_t textureIndex : m_sortedTextures)
+				{
+					TextureData* textureData = m_textures.RetrieveFromIndex(textureIndex);
+					if (textureData->texture.get() == &texture)
+					{
+						RefreshBindings(textureIndex, *textureData);
+						break;
+					}
+				}
+			});
+		}
+	}
+
+	UInt8 TextureStreamer::ComputeBaseLevel(const Image& image) const
+	{
+		if (image.GetType() != ImageType::E2D)
+			return 0;
+
+		UInt8 lastLevel = image.GetLevelCount() - 1;
+		for (UInt8 level = 0; level < lastLevel; ++level)
+		{
+			if (std::max(image.GetWidth(level), image.GetHeight(level)) <= m_config.minResidentSize)
+				return level;
+		}
+
+		return lastLevel;
+	}
+
+	UInt64 TextureStreamer::ComputeMemoryBudget() const
+	{
+		UInt64 availableMemory = 0;
+		bool hasBudget = false;
+		for (const RenderMemoryHeapStatistics& heapStatistics : m_renderDevice->GetMemoryHeapStatistics())
+		{
+			if (!heapStatistics.isDeviceLocal || heapStatistics.budgetBytes == 0)
+				continue;
+
+			hasBudget = true;
+			if (heapStatistics.budgetBytes > heapStatistics.processUsageBytes)
+				availableMemory += heapStatistics.budgetBytes - heapStatistics.processUsageBytes;
+		}
+
+		if (!hasBudget)
+			return m_config.memoryBudget;
+
+		// Resident textures are already accounted in the process usage
+		availableMemory = (availableMemory > m_config.deviceMemoryMargin) ? availableMemory - m_config.deviceMemoryMargin : 0;
+		return std::min(m_config.memoryBudget, m_residentMemory + availableMemory);
+	}
+
+	UInt64 TextureStreamer::ComputeMemoryUsage(const TextureData& textureData, UInt8 residentLevel) const
+	{
+		UInt64 memoryUsage = 0;
+		for (UInt8 level = residentLevel; level < textureData.image->GetLevelCount(); ++level)
+			memoryUsage += textureData.image->GetMemoryUsage(level);
+
+		return memoryUsage;
+	}
+
+	void TextureStreamer::RefreshBindings(std::size_t textureIndex, TextureData& textureData)
+	{
+		for (const MaterialBinding& binding : textureData.materialBindings)
+			binding.materialInstance->SetTextureProperty(binding.texturePropertyIndex, textureData.texture);
+
+		OnTextureResidencyChanged(this, textureIndex, textureData.texture);
+	}
+
+	bool TextureStreamer::Reside(std::size_t textureIndex, TextureData& textureData, UInt8 residentLevel, RenderFrame& renderFrame)
+	{
+		const Image& image = *textureData.image;
+
+		std::shared_ptr<Texture> texture;
+		if (image.GetType() == ImageType::E2D)
+		{
+			TextureInfo textureInfo;
+			textureInfo.pixelFormat = image.GetFormat();
+			textureInfo.type = ImageType::E2D;
+			// Levels can be copied to other textures by their users (see ClipmapTerrain)
+			textureInfo.usageFlags = TextureUsage::ShaderSampling | TextureUsage::Streamed | TextureUsage::TransferDestination | TextureUsage::TransferSource;
+			textureInfo.width = image.GetWidth(residentLevel);
+			textureInfo.height = image.GetHeight(residentLevel);
+			textureInfo.levelCount = SafeCast<UInt8>(image.GetLevelCount() - residentLevel);
+
+			// Streamed textures allocation fails instead of exceeding the device memory budget
+			try
+			{
+				texture = m_renderDevice->InstantiateTexture(textureInfo);
+			}
+			catch (const std::exception& e)
+			{
+				NazaraError("failed to instantiate streamed texture #{0}: {1}", textureIndex, e.what());
+				return false;
+			}
+
+			if (!texture)
+			{
+				NazaraError("failed to instantiate streamed texture #{0}", textureIndex);
+				return false;
+			}
+
+			for (UInt8 level = 0; level < textureInfo.levelCount; ++level)
+			{
+				if (!texture->Update(image.GetConstPixels(0, 0, 0, residentLevel + level), 0, 0, level))
+				{
+					NazaraError("failed to upload level #{0} of streamed texture #{1}", residentLevel + level, textureIndex);
+					return false;
+				}
+			}
+
+			texture->SetFilePath(image.GetFilePath());
+			if (std::string debugName = texture->GetFilePath().generic_u8string(); !debugName.empty())
+				texture->UpdateDebugName(debugName);
+		}
+		else
+		{
+			TextureParams textureParams;
+			textureParams.renderDevice = m_renderDevice;
+			textureParams.buildMipmaps = false;
+			textureParams.usageFlags = TextureUsage::ShaderSampling | TextureUsage::Streamed | TextureUsage::TransferDestination | TextureUsage::TransferSource;
+
+			try
+			{
+				texture = Texture::CreateFromImage(image, textureParams);
+			}
+			catch (const std::exception& e)
+			{
+				NazaraError("failed to instantiate streamed texture #{0}: {1}", textureIndex, e.what());
+				return false;
+			}
+
+			if (!texture)
+			{
+				NazaraError("failed to instantiate streamed texture #{0}", textureIndex);
+				return false;
+			}
+		}
+
+		if (textureData.texture)
+			renderFrame.PushForRelease(std::move(textureData.texture));
+
+		m_residentMemory -= textureData.memoryUsage;
+		textureData.memoryUsage = ComputeMemoryUsage(textureData, residentLevel);
+		m_residentMemory += textureData.memoryUsage;
+
+		textureData.residentLevel = residentLevel;
+		textureData.texture = std::move(texture);
+
+		RefreshBindings(textureIndex, textureData);
+
+		return true;
+	}
+}
@@ -7,6 +7,8 @@
 #include <Nazara/Graphics/Graphics.hpp>
 #include <Nazara/Graphics/MaterialInstance.hpp>
 #include <Nazara/Graphics/RenderSpriteChain.hpp>
+#include <NazaraUtils/StackArray.hpp>
+#include <algorithm>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
@@ -28,14 +30,18 @@ namespace Nz
 	m_tiles(mapSize.x* mapSize.y),
 	m_origin(0.f, 0.f),
 	m_tileSize(tileSize),
+	m_chunkCount((mapSize.x + ChunkSize - 1) / ChunkSize, (mapSize.y + ChunkSize - 1) / ChunkSize),
 	m_mapSize(mapSize),
-	m_isometricModeEnabled(false),
-	m_shouldRebuildVertices(false)
+	m_isometricModeEnabled(false)
 	{
 		NazaraAssert(m_tiles.size() != 0U, "Invalid map size");
 		NazaraAssert(m_tileSize.x > 0 && m_tileSize.y > 0, "Invalid tile size");
 		NazaraAssert(m_layers.size() != 0U, "Invalid material count");
 
+		std::size_t chunkCount = std::size_t(m_chunkCount.x) * m_chunkCount.y;
+		m_chunks.resize(chunkCount);
+		m_invalidatedChunks.Resize(chunkCount, false);
+
 		std::shared_ptr<MaterialInstance> defaultMaterialInstance = MaterialInstance::GetDefault(MaterialType::Basic);
 		for (auto& layer : m_layers)
 			layer.material = defaultMaterialInstance;
@@ -45,8 +51,7 @@ namespace Nz
 
 	void Tilemap::BuildElement(ElementRendererRegistry& registry, const ElementData& elementData, std::size_t passIndex, std::vector<RenderElementOwner>& elements) const
 	{
-		if (m_shouldRebuildVertices)
-			UpdateVertices();
+		UpdateVertices();
 
 		const std::shared_ptr<VertexDeclaration>& vertexDeclaration = VertexDeclaration::Get(VertexLayout::XYZ_Color_UV);
 
@@ -57,11 +62,10 @@ namespace Nz
 
 		const auto& whiteTexture = Graphics::Instance()->GetDefaultTextures().whiteTextures[ImageType::E2D];
 
-		const VertexStruct_XYZ_Color_UV* vertices = reinterpret_cast<const VertexStruct_XYZ_Color_UV*>(m_vertices.data());
 		for (std::size_t layerIndex = 0; layerIndex < m_layers.size(); ++layerIndex)
 		{
 			const auto& layer = m_layers[layerIndex];
-			if (!layer.enabledTiles.TestAny())
+			if (!layer.enabledTiles.TestAny() || layer.material->HasPass(elementData.excludedPassIndex))
 				continue;
 
 			const auto& materialPipeline = layer.material->GetPipeline(passIndex);
@@ -72,10 +76,19 @@ namespace Nz
 
 			const auto& renderPipeline = materialPipeline->GetRenderPipeline(&vertexBufferData, 1);
 
-			std::size_t spriteCount = layer.enabledTileCount;
-			elements.emplace_back(registry.AllocateElement<RenderSpriteChain>(GetRenderLayer(), layer.material, passFlags, renderPipeline, *elementData.worldInstance, vertexDeclaration, whiteTexture, spriteCount, vertices, *elementData.scissorBox));
+			// One element per chunk, consecutive elements sharing the same material are batched by the sprite chain renderer
+			for (const Chunk& chunk : m_chunks)
+			{
+				if (chunk.layerFirstSprite.empty())
+					continue;
+
+				std::size_t firstSprite = chunk.layerFirstSprite[layerIndex];
+				std::size_t spriteCount = chunk.layerFirstSprite[layerIndex + 1] - firstSprite;
+				if (spriteCount == 0)
+					continue;
 
-			vertices += 4 * spriteCount;
+				elements.emplace_back(registry.AllocateElement<RenderSpriteChain>(GetRenderLayer(), layer.material, passFlags, renderPipeline, *elementData.worldInstance, vertexDeclaration, whiteTexture, spriteCount, &chunk.vertices[4 * firstSprite], *elementData.scissorBox));
+			}
 		}
 	}
 	
@@ -115,32 +128,51 @@ namespace Nz
 		return Vector3ui::Unit(); //< prevents division by zero
 	}
 
-	void Tilemap::UpdateVertices() const
+	void Tilemap::UpdateChunk(std::size_t chunkIndex) const
 	{
+		Chunk& chunk = m_chunks[chunkIndex];
+
+		unsigned int firstX = (chunkIndex % m_chunkCount.x) * ChunkSize;
+		unsigned int firstY = (chunkIndex / m_chunkCount.x) * ChunkSize;
+		unsigned int lastX = std::min(firstX + ChunkSize, m_mapSize.x);
+		unsigned int lastY = std::min(firstY + ChunkSize, m_mapSize.y);
+
+		// Sprites are grouped by layer (material), count them to know where each layer starts
+		chunk.layerFirstSprite.assign(m_layers.size() + 1, 0);
+		for (unsigned int y = firstY; y < lastY; ++y)
+		{
+			for (unsigned int x = firstX; x < lastX; ++x)
+			{
+				const Tile& tile = m_tiles[y * m_mapSize.x + x];
+				if (tile.enabled)
+					chunk.layerFirstSprite[tile.layerIndex + 1]++;
+			}
+		}
+
+		for (std::size_t i = 1; i < chunk.layerFirstSprite.size(); ++i)
+			chunk.layerFirstSprite[i] += chunk.layerFirstSprite[i - 1];
+
+		chunk.vertices.resize(4 * chunk.layerFirstSprite.back());
+
+		StackArray<std::size_t> layerSpriteIndex = NazaraStackArrayNoInit(std::size_t, m_layers.size());
+		std::copy(chunk.layerFirstSprite.begin(), chunk.layerFirstSprite.end() - 1, layerSpriteIndex.begin());
+
 		EnumArray<RectCorner, Vector2f> cornerExtent;
 		cornerExtent[RectCorner::LeftBottom]  = Vector2f(0.f, 0.f);
 		cornerExtent[RectCorner::RightBottom] = Vector2f(1.f, 0.f);
 		cornerExtent[RectCorner::LeftTop]     = Vector2f(0.f, 1.f);
 		cornerExtent[RectCorner::RightTop]    = Vector2f(1.f, 1.f);
 
-		std::size_t spriteCount = 0;
-		for (const Layer& layer : m_layers)
-			spriteCount += layer.enabledTileCount;
-
-		m_vertices.resize(spriteCount * 4);
-		VertexStruct_XYZ_Color_UV* vertexPtr = m_vertices.data();
-
 		float topCorner = m_tileSize.y * (m_mapSize.y - 1);
 		Vector2f originShift = m_origin * GetSize();
 
-		for (const Layer& layer : m_layers)
+		for (unsigned int y = firstY; y < lastY; ++y)
 		{
-			for (std::size_t tileIndex : layer.enabledTiles.IterBits())
+			for (unsigned int x = firstX; x < lastX; ++x)
 			{
-				const Tile& tile = m_tiles[tileIndex];
-
-				std::size_t x = tileIndex % m_mapSize.x;
-				std::size_t y = tileIndex / m_mapSize.x;
+				const Tile& tile = m_tiles[y * m_mapSize.x + x];
+				if (!tile.enabled)
+					continue;
 
 				Vector3f tileLeftBottom;
 				if (m_isometricModeEnabled)
@@ -148,6 +180,7 @@ namespace Nz
 				else
 					tileLeftBottom = Vector3f(x * m_tileSize.x, topCorner - y * m_tileSize.y, 0.f);
 
+				VertexStruct_XYZ_Color_UV* vertexPtr = &chunk.vertices[4 * layerSpriteIndex[tile.layerIndex]++];
 				for (RectCorner corner : { RectCorner::LeftBottom, RectCorner::RightBottom, RectCorner::LeftTop, RectCorner::RightTop })
 				{
 					vertexPtr->color = tile.color;
@@ -158,7 +191,13 @@ namespace Nz
 				}
 			}
 		}
+	}
+
+	void Tilemap::UpdateVertices() const
+	{
+		for (std::size_t chunkIndex : m_invalidatedChunks.IterBits())
+			UpdateChunk(chunkIndex);
 
-		m_shouldRebuildVertices = false;
+		m_invalidatedChunks.Reset();
 	}
 }
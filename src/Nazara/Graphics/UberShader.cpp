@@ -5,9 +5,14 @@
 #include <Nazara/Graphics/UberShader.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Graphics/Graphics.hpp>
+#include <Nazara/Graphics/ShaderVariantArchive.hpp>
 #include <Nazara/Renderer/RenderDevice.hpp>
+#include <Nazara/Renderer/Renderer.hpp>
+#include <NZSL/SpirvWriter.hpp>
+#include <NZSL/Ast/AstSerializer.hpp>
 #include <NZSL/Ast/ReflectVisitor.hpp>
 #include <NZSL/Ast/SanitizeVisitor.hpp>
+#include <cstring>
 #include <limits>
 #include <stdexcept>
 #include <Nazara/Graphics/Debug.hpp>
@@ -20,6 +25,7 @@ namespace Nz
 	}
 
 	UberShader::UberShader(nzsl::ShaderStageTypeFlags shaderStages, nzsl::ModuleResolver& moduleResolver, std::string moduleName) :
+	m_moduleName(moduleName),
 	m_shaderStages(shaderStages)
 	{
 		m_shaderModule = moduleResolver.Resolve(moduleName);
@@ -35,6 +41,8 @@ namespace Nz
 			throw;
 		}
 
+		m_moduleHash = ShaderVariantArchive::ComputeModuleHash(*m_shaderModule);
+
 		m_onShaderModuleUpdated.Connect(moduleResolver.OnModuleUpdated, [this, name = std::move(moduleName)](nzsl::ModuleResolver* resolver, const std::string& updatedModuleName)
 		{
 			if (updatedModuleName != name)
@@ -49,7 +57,7 @@ namespace Nz
 
 			try
 			{
-				m_shaderModule = Validate(*newShaderModule, &m_optionIndexByName);
+				newShaderModule = Validate(*newShaderModule, &m_optionIndexByName);
 			}
 			catch (const std::exception& e)
 			{
@@ -57,8 +65,17 @@ namespace Nz
 				return;
 			}
 
-			// Clear cache
-			m_combinations.clear();
+			// Archived variants of the previous version of the module won't match the new hash
+			UInt64 newModuleHash = ShaderVariantArchive::ComputeModuleHash(*newShaderModule);
+
+			{
+				std::lock_guard lock(m_combinationMutex);
+				m_shaderModule = std::move(newShaderModule);
+				m_moduleHash = newModuleHash;
+
+				// Clear cache
+				m_combinations.clear();
+			}
 
 			OnShaderUpdated(this);
 		});
@@ -66,6 +83,7 @@ namespace Nz
 
 	UberShader::UberShader(nzsl::ShaderStageTypeFlags shaderStages, nzsl::Ast::ModulePtr shaderModule) :
 	m_shaderModule(std::move(shaderModule)),
+	m_moduleHash(0),
 	m_shaderStages(shaderStages)
 	{
 		NazaraAssert(m_shaderModule, "invalid shader module");
@@ -81,30 +99,127 @@ namespace Nz
 		}
 	}
 
+	/*!
+	* \brief Retrieve (and compile if required) the shader module matching a configuration
+	*
+	* This function can be called from multiple threads at once, variants are compiled outside of the cache lock so different configurations can be compiled concurrently
+	*
+	* Variants are loaded from the graphics shader variant archive when available, which skips shader compilation entirely
+	*
+	* \param config Option values used to compile the shader
+	*
+	* \return Shader module compiled with the configuration
+	*/
 	const std::shared_ptr<ShaderModule>& UberShader::Get(const Config& config)
 	{
-		auto it = m_combinations.find(config);
-		if (it == m_combinations.end())
+		nzsl::Ast::ModulePtr shaderModule;
+		std::string moduleName;
+		UInt64 moduleHash;
+		{
+			std::lock_guard lock(m_combinationMutex);
+
+			auto it = m_combinations.find(config);
+			if (it != m_combinations.end())
+				return it->second;
+
+			shaderModule = m_shaderModule;
+			moduleName = m_moduleName;
+			moduleHash = m_moduleHash;
+		}
+
+		nzsl::ShaderWriter::States states;
+		// TODO: Remove this when arrays are accepted as config values
+		for (const auto& [optionHash, optionValue] : config.optionValues)
+		{
+			std::uint32_t hash = optionHash;
+
+			std::visit([&](auto&& arg)
+			{
+				states.optionValues[hash] = arg;
+			}, optionValue);
+		}
+		Graphics* graphics = Graphics::Instance();
+		states.shaderModuleResolver = graphics->GetShaderModuleResolver();
+
+		std::shared_ptr<ShaderModule> stage;
+		if (!moduleName.empty())
+			stage = InstantiateFromArchive(graphics->GetShaderVariantArchive(), moduleName, moduleHash, config, *shaderModule, states);
+
+		if (!stage)
+			stage = graphics->GetRenderDevice()->InstantiateShaderModule(m_shaderStages, *shaderModule, std::move(states));
+
+		std::lock_guard lock(m_combinationMutex);
+
+		// Another thread may have compiled the same configuration in the meantime, keep the first one
+		return m_combinations.emplace(config, std::move(stage)).first->second;
+	}
+
+	std::shared_ptr<ShaderModule> UberShader::InstantiateFromArchive(ShaderVariantArchive& archive, std::string_view moduleName, UInt64 moduleHash, const Config& config, const nzsl::Ast::Module& shaderModule, const nzsl::ShaderWriter::States& states) const
+	{
+		// Use the language the backend would have compiled the shader to
+		ShaderLanguage language;
+		switch (Renderer::Instance()->QueryAPI())
 		{
-			nzsl::ShaderWriter::States states;
-			// TODO: Remove this when arrays are accepted as config values
-			for (const auto& [optionHash, optionValue] : config.optionValues)
+			case RenderAPI::OpenGL:
+			case RenderAPI::OpenGL_ES:
+				// GLSL depends on the context and the pipeline layout, store the sanitized shader instead
+				language = ShaderLanguage::NazaraBinary;
+				break;
+
+			case RenderAPI::Vulkan:
+				language = ShaderLanguage::SpirV;
+				break;
+
+			case RenderAPI::Direct3D:
+			case RenderAPI::Mantle:
+			case RenderAPI::Metal:
+			case RenderAPI::Null:
+			case RenderAPI::WebGPU:
+			case RenderAPI::Unknown:
+				return nullptr;
+		}
+
+		UInt64 variantHash = ShaderVariantArchive::ComputeVariantHash(moduleName, moduleHash, config);
+
+		std::shared_ptr<const ShaderVariantArchive::Variant> variant = archive.FindVariant(variantHash, moduleHash, language);
+		if (!variant)
+		{
+			if (!archive.IsRecording())
+				return nullptr;
+
+			ShaderVariantArchive::Variant newVariant;
+			newVariant.language = language;
+			newVariant.moduleHash = moduleHash;
+
+			if (language == ShaderLanguage::SpirV)
 			{
-				std::uint32_t hash = optionHash;
-				
-				std::visit([&](auto&& arg)
-				{
-					states.optionValues[hash] = arg;
-				}, optionValue);
+				// Same environment as VulkanShaderModule
+				nzsl::SpirvWriter writer;
+				std::vector<UInt32> code = writer.Generate(shaderModule, states);
+
+				newVariant.data.resize(code.size() * sizeof(UInt32));
+				std::memcpy(newVariant.data.data(), code.data(), newVariant.data.size());
 			}
-			states.shaderModuleResolver = Graphics::Instance()->GetShaderModuleResolver();
+			else
+			{
+				nzsl::Ast::SanitizeVisitor::Options sanitizeOptions;
+				sanitizeOptions.moduleResolver = states.shaderModuleResolver;
+				sanitizeOptions.optionValues = states.optionValues;
+
+				nzsl::Ast::ModulePtr sanitizedModule = nzsl::Ast::Sanitize(shaderModule, sanitizeOptions);
 
-			std::shared_ptr<ShaderModule> stage = Graphics::Instance()->GetRenderDevice()->InstantiateShaderModule(m_shaderStages, *m_shaderModule, std::move(states));
+				nzsl::Serializer serializer;
+				nzsl::Ast::SerializeShader(serializer, *sanitizedModule);
+
+				newVariant.data = serializer.GetData();
+			}
 
-			it = m_combinations.emplace(config, std::move(stage)).first;
+			// Another thread may have archived the same variant in the meantime, ours is used either way
+			variant = std::make_shared<const ShaderVariantArchive::Variant>(std::move(newVariant));
+			archive.AddVariant(variantHash, variant);
 		}
 
-		return it->second;
+		return Graphics::Instance()->GetRenderDevice()->InstantiateShaderModule(m_shaderStages, variant->language, variant->data.data(), variant->data.size(), states);
 	}
 
 	nzsl::Ast::ModulePtr UberShader::Validate(const nzsl::Ast::Module& module, std::unordered_map<std::string, Option>* options)
@@ -0,0 +1,326 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/UpscalePipelinePass.hpp>
+#include <Nazara/Graphics/AbstractViewer.hpp>
+#include <Nazara/Graphics/BakedFrameGraph.hpp>
+#include <Nazara/Graphics/FrameGraph.hpp>
+#include <Nazara/Graphics/Graphics.hpp>
+#include <Nazara/Graphics/ViewerInstance.hpp>
+#include <Nazara/Math/Vector4.hpp>
+#include <Nazara/Renderer/CommandBufferBuilder.hpp>
+#include <Nazara/Renderer/RenderBuffer.hpp>
+#include <Nazara/Renderer/RenderFrame.hpp>
+#include <Nazara/Renderer/UploadPool.hpp>
+#include <NZSL/Math/FieldOffsets.hpp>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	NAZARA_ANONYMOUS_NAMESPACE
+	{
+		// Part of the history kept every frame, higher values reduce aliasing more but increase ghosting
+		constexpr float HistoryWeight = 0.9f;
+
+		struct UpscaleDataOffsets
+		{
+			std::size_t invViewProjMatrix;
+			std::size_t previousViewProjMatrix;
+			std::size_t inputRect;
+			std::size_t outputRect;
+			std::size_t inputSize;
+			std::size_t invInputSize;
+			std::size_t jitter;
+			std::size_t historyWeight;
+			std::size_t totalSize;
+		};
+
+		// Must match SpatialUpscale and TemporalUpscale shaders
+		UpscaleDataOffsets GetUpscaleDataOffsets()
+		{
+			nzsl::FieldOffsets upscaleStruct(nzsl::StructLayout::Std140);
+
+			UpscaleDataOffsets offsets;
+			offsets.invViewProjMatrix = upscaleStruct.AddMatrix(nzsl::StructFieldType::Float1, 4, 4, true);
+			offsets.previousViewProjMatrix = upscaleStruct.AddMatrix(nzsl::StructFieldType::Float1, 4, 4, true);
+			offsets.inputRect = upscaleStruct.AddField(nzsl::StructFieldType::Float4);
+			offsets.outputRect = upscaleStruct.AddField(nzsl::StructFieldType::Float4);
+			offsets.inputSize = upscaleStruct.AddField(nzsl::StructFieldType::Float2);
+			offsets.invInputSize = upscaleStruct.AddField(nzsl::StructFieldType::Float2);
+			offsets.jitter = upscaleStruct.AddField(nzsl::StructFieldType::Float2);
+			offsets.historyWeight = upscaleStruct.AddField(nzsl::StructFieldType::Float1);
+			offsets.totalSize = upscaleStruct.GetAlignedSize();
+
+			return offsets;
+		}
+
+		float Halton(std::size_t index, std::size_t base)
+		{
+			float fraction = 1.f;
+			float result = 0.f;
+			while (index > 0)
+			{
+				fraction /= float(base);
+				result += fraction * float(index % base);
+				index /= base;
+			}
+
+			return result;
+		}
+
+		Vector4f ToTextureRect(const Recti& rect, const Vector2f& invSize)
+		{
+			return Vector4f(rect.x * invSize.x, rect.y * invSize.y, rect.width * invSize.x, rect.height * invSize.y);
+		}
+	}
+
+	UpscalePipelinePass::UpscalePipelinePass(AbstractViewer* viewer, UpscalingMode upscalingMode) :
+	m_frameIndex(0),
+	m_historyAttachment(0),
+	m_inputColorBufferIndex(0),
+	m_inputDepthBufferIndex(0),
+	m_viewer(viewer),
+	m_previousViewProjMatrix(Matrix4f::Identity()),
+	m_upscalingMode(upscalingMode),
+	m_jitter(Vector2f::Zero()),
+	m_isHistoryValid(false)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		static UpscaleDataOffsets upscaleDataOffsets = GetUpscaleDataOffsets();
+
+		m_upscaleDataBuffer = Graphics::Instance()->GetRenderDevice()->InstantiateBuffer(BufferType::Uniform, upscaleDataOffsets.totalSize, BufferUsage::DeviceLocal | BufferUsage::Dynamic | BufferUsage::Write);
+		m_upscaleDataBuffer->UpdateDebugName("Upscale data");
+	}
+
+	UpscalePipelinePass::~UpscalePipelinePass() = default;
+
+	void UpscalePipelinePass::OnTransfer(RenderFrame& renderFrame, CommandBufferBuilder& builder)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		static UpscaleDataOffsets upscaleDataOffsets = GetUpscaleDataOffsets();
+
+		const ViewerInstance& viewerInstance = m_viewer->GetViewerInstance();
+
+		// Attachments have the size of the frame, the viewer only renders to a part of them
+		Vector2f frameSize = Vector2f(renderFrame.GetSize());
+		Vector2f invFrameSize = 1.f / frameSize;
+
+		auto& allocation = renderFrame.GetUploadPool().Allocate(upscaleDataOffsets.totalSize);
+		AccessByOffset<Matrix4f&>(allocation.mappedPtr, upscaleDataOffsets.invViewProjMatrix) = viewerInstance.GetInvViewProjMatrix();
+		AccessByOffset<Matrix4f&>(allocation.mappedPtr, upscaleDataOffsets.previousViewProjMatrix) = (m_isHistoryValid) ? m_previousViewProjMatrix : viewerInstance.GetViewProjMatrix();
+		AccessByOffset<Vector4f&>(allocation.mappedPtr, upscaleDataOffsets.inputRect) = ToTextureRect(m_viewer->GetRenderViewport(), invFrameSize);
+		AccessByOffset<Vector4f&>(allocation.mappedPtr, upscaleDataOffsets.outputRect) = ToTextureRect(m_viewer->GetViewport(), invFrameSize);
+		AccessByOffset<Vector2f&>(allocation.mappedPtr, upscaleDataOffsets.inputSize) = frameSize;
+		AccessByOffset<Vector2f&>(allocation.mappedPtr, upscaleDataOffsets.invInputSize) = invFrameSize;
+		AccessByOffset<Vector2f&>(allocation.mappedPtr, upscaleDataOffsets.jitter) = m_jitter * 0.5f; //< NDC to texture coordinates
+		AccessByOffset<float&>(allocation.mappedPtr, upscaleDataOffsets.historyWeight) = (m_isHistoryValid) ? HistoryWeight : 0.f;
+
+		builder.CopyBuffer(allocation, m_upscaleDataBuffer.get());
+
+		m_previousViewProjMatrix = viewerInstance.GetViewProjMatrix();
+	}
+
+	/*!
+	* \brief Starts a new frame for the viewer
+	*
+	* In temporal mode, moves the viewer projection to the next sample position.
+	* Must be called before transfers, the pass has to be transferred every frame.
+	*/
+	void UpscalePipelinePass::Prepare()
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		if (m_upscalingMode != UpscalingMode::Temporal)
+			return;
+
+		// Halton(2, 3) sequence covers the pixel evenly in a few frames, index 0 is skipped as it would always be (0, 0)
+		m_frameIndex = (m_frameIndex + 1) % JitterSampleCount;
+		Vector2f sampleOffset(Halton(m_frameIndex + 1, 2) - 0.5f, Halton(m_frameIndex + 1, 3) - 0.5f);
+
+		Recti renderViewport = m_viewer->GetRenderViewport();
+		m_jitter = Vector2f(2.f * sampleOffset.x / renderViewport.width, 2.f * sampleOffset.y / renderViewport.height);
+
+		m_viewer->GetViewerInstance().UpdateJitter(m_jitter);
+	}
+
+	/*!
+	* \brief Registers the upscale pass
+	*
+	* In temporal mode, the depth buffer must be a depth-only format (depth-stencil textures can't be sampled).
+	*/
+	FramePass& UpscalePipelinePass::RegisterToFrameGraph(FrameGraph& frameGraph, std::size_t inputColorBufferIndex, std::size_t inputDepthBufferIndex, std::size_t outputColorBufferIndex)
+	{
+		m_inputColorBufferIndex = inputColorBufferIndex;
+		m_inputDepthBufferIndex = inputDepthBufferIndex;
+
+		FramePass& upscalePass = frameGraph.AddPass("Upscale pass");
+		upscalePass.AddInput(inputColorBufferIndex);
+		upscalePass.AddOutput(outputColorBufferIndex);
+
+		if (m_upscalingMode == UpscalingMode::Temporal)
+		{
+			m_historyAttachment = frameGraph.AddAttachment({
+				"Upscale history",
+				PixelFormat::RGBA8
+			});
+
+			upscalePass.AddInput(inputDepthBufferIndex);
+			upscalePass.AddOutput(m_historyAttachment);
+
+			// Keep the history alive after the frame graph execution so it can be copied for the next frame
+			frameGraph.AddBackbufferOutput(m_historyAttachment);
+		}
+
+		upscalePass.SetCommandCallback([this](CommandBufferBuilder& builder, const FramePassEnvironment& /*env*/)
+		{
+			Recti viewport = m_viewer->GetViewport();
+
+			builder.SetScissor(viewport);
+			builder.SetViewport(viewport);
+
+			builder.BindRenderPipeline(*Graphics::Instance()->GetUpscalePipeline(m_upscalingMode));
+			builder.BindRenderShaderBinding(0, *m_shaderBinding);
+			builder.Draw(3);
+		});
+
+		return upscalePass;
+	}
+
+	/*!
+	* \brief Updates the upscale pass binding, must be called when the frame graph has been rebuilt or resized
+	*/
+	void UpscalePipelinePass::UpdateBindings(RenderFrame& renderFrame, const BakedFrameGraph& bakedGraph)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		static UpscaleDataOffsets upscaleDataOffsets = GetUpscaleDataOffsets();
+
+		Graphics* graphics = Graphics::Instance();
+
+		if (m_shaderBinding)
+			renderFrame.PushForRelease(std::move(m_shaderBinding));
+
+		const std::shared_ptr<TextureSampler>& sampler = graphics->GetSamplerCache().Get({});
+
+		m_shaderBinding = graphics->GetUpscalePipelineLayout(m_upscalingMode)->AllocateShaderBinding(0);
+
+		if (m_upscalingMode == UpscalingMode::Temporal)
+		{
+			const std::shared_ptr<Texture>& historyAttachment = bakedGraph.GetAttachmentTexture(m_historyAttachment);
+			Vector3ui historySize = historyAttachment->GetSize();
+
+			if (!m_historyTexture || m_historyTexture->GetSize() != historySize)
+			{
+				if (m_historyTexture)
+					renderFrame.PushForRelease(std::move(m_historyTexture));
+
+				TextureInfo historyInfo;
+				historyInfo.pixelFormat = PixelFormat::RGBA8;
+				historyInfo.type = ImageType::E2D;
+				historyInfo.usageFlags = TextureUsage::ShaderSampling | TextureUsage::TransferDestination;
+				historyInfo.levelCount = 1;
+				historyInfo.width = historySize.x;
+				historyInfo.height = historySize.y;
+
+				m_historyTexture = graphics->GetRenderDevice()->InstantiateTexture(historyInfo);
+				m_historyTexture->UpdateDebugName("Upscale history");
+
+				// History is sampled (with a zero weight) before being written for the first time
+				renderFrame.Execute([&](CommandBufferBuilder& builder)
+				{
+					builder.TextureBarrier(PipelineStage::TopOfPipe, PipelineStage::FragmentShader, {}, MemoryAccess::ShaderRead, TextureLayout::Undefined, TextureLayout::ColorInput, *m_historyTexture);
+				}, QueueType::Graphics);
+
+				m_isHistoryValid = false;
+			}
+
+			TextureSamplerInfo depthSamplerInfo;
+			depthSamplerInfo.magFilter = SamplerFilter::Nearest;
+			depthSamplerInfo.minFilter = SamplerFilter::Nearest;
+			depthSamplerInfo.mipmapMode = SamplerMipmapMode::Nearest;
+
+			m_shaderBinding->Update({
+				{
+					0,
+					ShaderBinding::UniformBufferBinding {
+						m_upscaleDataBuffer.get(),
+						0, upscaleDataOffsets.totalSize
+					}
+				},
+				{
+					1,
+					ShaderBinding::SampledTextureBinding {
+						bakedGraph.GetAttachmentTexture(m_inputColorBufferIndex).get(),
+						sampler.get()
+					}
+				},
+				{
+					2,
+					ShaderBinding::SampledTextureBinding {
+						bakedGraph.GetAttachmentTexture(m_inputDepthBufferIndex).get(),
+						graphics->GetSamplerCache().Get(depthSamplerInfo).get()
+					}
+				},
+				{
+					3,
+					ShaderBinding::SampledTextureBinding {
+						m_historyTexture.get(),
+						sampler.get()
+					}
+				}
+			});
+		}
+		else
+		{
+			m_shaderBinding->Update({
+				{
+					0,
+					ShaderBinding::UniformBufferBinding {
+						m_upscaleDataBuffer.get(),
+						0, upscaleDataOffsets.totalSize
+					}
+				},
+				{
+					1,
+					ShaderBinding::SampledTextureBinding {
+						bakedGraph.GetAttachmentTexture(m_inputColorBufferIndex).get(),
+						sampler.get()
+					}
+				}
+			});
+		}
+	}
+
+	/*!
+	* \brief Copies the upscaled frame to the history texture, used by the next frame
+	*
+	* Must be called after the frame graph has been executed (as the history attachment is one of its outputs), does nothing in spatial mode
+	*/
+	void UpscalePipelinePass::UpdateHistory(CommandBufferBuilder& builder, const BakedFrameGraph& bakedGraph)
+	{
+		if (m_upscalingMode != UpscalingMode::Temporal)
+			return;
+
+		const std::shared_ptr<Texture>& historyAttachment = bakedGraph.GetAttachmentTexture(m_historyAttachment);
+
+		// Only the viewer region is part of the history
+		Recti viewport = m_viewer->GetViewport();
+		Boxui copyBox(SafeCast<unsigned int>(viewport.x), SafeCast<unsigned int>(viewport.y), 0, SafeCast<unsigned int>(viewport.width), SafeCast<unsigned int>(viewport.height), 1);
+
+		builder.BeginDebugRegion("Upscale history", Color::Blue());
+		{
+			builder.TextureBarrier(PipelineStage::ColorOutput, PipelineStage::Transfer, MemoryAccess::ColorWrite, MemoryAccess::TransferRead, TextureLayout::ColorOutput, TextureLayout::TransferSource, *historyAttachment);
+			builder.TextureBarrier(PipelineStage::FragmentShader, PipelineStage::Transfer, MemoryAccess::ShaderRead, MemoryAccess::TransferWrite, TextureLayout::ColorInput, TextureLayout::TransferDestination, *m_historyTexture);
+
+			builder.CopyTexture(*historyAttachment, copyBox, TextureLayout::TransferSource, *m_historyTexture, Vector3ui(copyBox.x, copyBox.y, 0), TextureLayout::TransferDestination);
+
+			builder.TextureBarrier(PipelineStage::Transfer, PipelineStage::FragmentShader, MemoryAccess::TransferWrite, MemoryAccess::ShaderRead, TextureLayout::TransferDestination, TextureLayout::ColorInput, *m_historyTexture);
+		}
+		builder.EndDebugRegion();
+
+		m_isHistoryValid = true;
+	}
+}
@@ -21,9 +21,11 @@ namespace Nz
 	m_projectionMatrix(Matrix4f::Identity()),
 	m_viewProjMatrix(Matrix4f::Identity()),
 	m_viewMatrix(Matrix4f::Identity()),
+	m_jitter(Vector2f::Zero()),
 	m_targetSize(Vector2f::Zero()),
 	m_eyePosition(Vector3f::Zero()),
-	m_dataInvalidated(true)
+	m_dataInvalidated(true),
+	m_renderScale(1.f)
 	{
 		PredefinedViewerData viewerUboOffsets = PredefinedViewerData::GetOffsets();
 
@@ -38,18 +40,35 @@ namespace Nz
 
 		PredefinedViewerData viewerDataOffsets = PredefinedViewerData::GetOffsets();
 
+		Vector2f targetSize = m_targetSize * m_renderScale;
+
 		auto& allocation = renderFrame.GetUploadPool().Allocate(viewerDataOffsets.totalSize);
 		AccessByOffset<Vector3f&>(allocation.mappedPtr, viewerDataOffsets.eyePositionOffset) = m_eyePosition;
-		AccessByOffset<Vector2f&>(allocation.mappedPtr, viewerDataOffsets.invTargetSizeOffset) = 1.f / m_targetSize;
-		AccessByOffset<Vector2f&>(allocation.mappedPtr, viewerDataOffsets.targetSizeOffset) = m_targetSize;
+		AccessByOffset<Vector2f&>(allocation.mappedPtr, viewerDataOffsets.invTargetSizeOffset) = 1.f / targetSize;
+		AccessByOffset<Vector2f&>(allocation.mappedPtr, viewerDataOffsets.targetSizeOffset) = targetSize;
 
-		AccessByOffset<Matrix4f&>(allocation.mappedPtr, viewerDataOffsets.invProjMatrixOffset) = m_invProjectionMatrix;
 		AccessByOffset<Matrix4f&>(allocation.mappedPtr, viewerDataOffsets.invViewMatrixOffset) = m_invViewMatrix;
-		AccessByOffset<Matrix4f&>(allocation.mappedPtr, viewerDataOffsets.invViewProjMatrixOffset) = m_invViewProjMatrix;
-		AccessByOffset<Matrix4f&>(allocation.mappedPtr, viewerDataOffsets.projMatrixOffset) = m_projectionMatrix;
-		AccessByOffset<Matrix4f&>(allocation.mappedPtr, viewerDataOffsets.viewProjMatrixOffset) = m_viewProjMatrix;
 		AccessByOffset<Matrix4f&>(allocation.mappedPtr, viewerDataOffsets.viewMatrixOffset) = m_viewMatrix;
 
+		if (m_jitter != Vector2f::Zero())
+		{
+			// Translating clip-space by jitter * w moves every projected point by jitter in normalized device coordinates
+			Matrix4f jitteredProjMatrix = m_projectionMatrix * Matrix4f::Translate(Vector3f(m_jitter.x, m_jitter.y, 0.f));
+			Matrix4f invJitteredProjMatrix = Matrix4f::Translate(Vector3f(-m_jitter.x, -m_jitter.y, 0.f)) * m_invProjectionMatrix;
+
+			AccessByOffset<Matrix4f&>(allocation.mappedPtr, viewerDataOffsets.invProjMatrixOffset) = invJitteredProjMatrix;
+			AccessByOffset<Matrix4f&>(allocation.mappedPtr, viewerDataOffsets.invViewProjMatrixOffset) = invJitteredProjMatrix * m_invViewMatrix;
+			AccessByOffset<Matrix4f&>(allocation.mappedPtr, viewerDataOffsets.projMatrixOffset) = jitteredProjMatrix;
+			AccessByOffset<Matrix4f&>(allocation.mappedPtr, viewerDataOffsets.viewProjMatrixOffset) = m_viewMatrix * jitteredProjMatrix;
+		}
+		else
+		{
+			AccessByOffset<Matrix4f&>(allocation.mappedPtr, viewerDataOffsets.invProjMatrixOffset) = m_invProjectionMatrix;
+			AccessByOffset<Matrix4f&>(allocation.mappedPtr, viewerDataOffsets.invViewProjMatrixOffset) = m_invViewProjMatrix;
+			AccessByOffset<Matrix4f&>(allocation.mappedPtr, viewerDataOffsets.projMatrixOffset) = m_projectionMatrix;
+			AccessByOffset<Matrix4f&>(allocation.mappedPtr, viewerDataOffsets.viewProjMatrixOffset) = m_viewProjMatrix;
+		}
+
 		builder.CopyBuffer(allocation, m_viewerDataBuffer.get());
 
 		m_dataInvalidated = false;
@@ -4,25 +4,54 @@
 
 #include <Nazara/Graphics/WorldInstance.hpp>
 #include <Nazara/Graphics/Graphics.hpp>
-#include <Nazara/Graphics/MaterialSettings.hpp>
 #include <Nazara/Graphics/PredefinedShaderStructs.hpp>
-#include <Nazara/Renderer/CommandBufferBuilder.hpp>
-#include <Nazara/Renderer/RenderFrame.hpp>
-#include <Nazara/Renderer/UploadPool.hpp>
-#include <NazaraUtils/StackVector.hpp>
+#include <Nazara/Graphics/RenderBufferPool.hpp>
+#include <limits>
+#include <utility>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
 {
+	namespace
+	{
+		constexpr std::size_t InvalidIndex = std::numeric_limits<std::size_t>::max();
+	}
+
+	/*!
+	* \ingroup graphics
+	* \class Nz::WorldInstance
+	* \brief Graphics class holding the per-instance shader data (world matrices) of a renderable
+	*
+	* Instance data lives in a block of a few thousands instances allocated from the Graphics instance data pool,
+	* matrix updates are written to its CPU copy and every dirty instance is uploaded in a few merged copies once per frame.
+	*/
 	WorldInstance::WorldInstance() :
 	m_invWorldMatrix(Matrix4f::Identity()),
 	m_worldMatrix(Matrix4f::Identity()),
+	m_animationClip(0),
+	m_animationTime(0.f),
 	m_dataInvalided(true)
 	{
-		PredefinedInstanceData instanceUboOffsets = PredefinedInstanceData::GetOffsets();
+		m_instanceDataBuffer = Graphics::Instance()->GetInstanceDataBufferPool().Allocate(m_instanceDataIndex);
+		UpdateInstanceData();
+	}
+
+	WorldInstance::WorldInstance(WorldInstance&& instance) noexcept :
+	TransferInterface(std::move(instance)),
+	m_instanceDataBuffer(instance.m_instanceDataBuffer),
+	m_instanceDataIndex(std::exchange(instance.m_instanceDataIndex, InvalidIndex)),
+	m_invWorldMatrix(instance.m_invWorldMatrix),
+	m_worldMatrix(instance.m_worldMatrix),
+	m_animationClip(instance.m_animationClip),
+	m_animationTime(instance.m_animationTime),
+	m_dataInvalided(instance.m_dataInvalided)
+	{
+	}
 
-		m_instanceDataBuffer = Graphics::Instance()->GetRenderDevice()->InstantiateBuffer(BufferType::Uniform, instanceUboOffsets.totalSize, BufferUsage::DeviceLocal | BufferUsage::Dynamic | BufferUsage::Write);
-		m_instanceDataBuffer->UpdateDebugName("Instance data");
+	WorldInstance::~WorldInstance()
+	{
+		if (m_instanceDataIndex != InvalidIndex)
+			Graphics::Instance()->GetInstanceDataBufferPool().Free(m_instanceDataIndex);
 	}
 
 	void WorldInstance::OnTransfer(RenderFrame& renderFrame, CommandBufferBuilder& builder)
@@ -30,14 +59,50 @@ namespace Nz
 		if (!m_dataInvalided)
 			return;
 
-		PredefinedInstanceData instanceUboOffsets = PredefinedInstanceData::GetOffsets();
+		// Uploads dirty ranges of every instance at once, the following world instances won't have anything left to do
+		Graphics::Instance()->GetInstanceDataBufferPool().OnTransfer(renderFrame, builder);
 
-		auto& allocation = renderFrame.GetUploadPool().Allocate(m_instanceDataBuffer->GetSize());
-		AccessByOffset<Matrix4f&>(allocation.mappedPtr, instanceUboOffsets.worldMatrixOffset) = m_worldMatrix;
-		AccessByOffset<Matrix4f&>(allocation.mappedPtr, instanceUboOffsets.invWorldMatrixOffset) = m_invWorldMatrix;
+		m_dataInvalided = false;
+	}
 
-		builder.CopyBuffer(allocation, m_instanceDataBuffer.get());
+	WorldInstance& WorldInstance::operator=(WorldInstance&& instance) noexcept
+	{
+		if (this == &instance)
+			return *this;
 
-		m_dataInvalided = false;
+		if (m_instanceDataIndex != InvalidIndex)
+			Graphics::Instance()->GetInstanceDataBufferPool().Free(m_instanceDataIndex);
+
+		TransferInterface::operator=(std::move(instance));
+		m_instanceDataBuffer = instance.m_instanceDataBuffer;
+		m_instanceDataIndex = std::exchange(instance.m_instanceDataIndex, InvalidIndex);
+		m_invWorldMatrix = instance.m_invWorldMatrix;
+		m_worldMatrix = instance.m_worldMatrix;
+		m_animationClip = instance.m_animationClip;
+		m_animationTime = instance.m_animationTime;
+		m_dataInvalided = instance.m_dataInvalided;
+
+		return *this;
+	}
+
+	void WorldInstance::InvalidateData()
+	{
+		UpdateInstanceData();
+
+		// Listeners were already notified since the last transfer
+		if (m_dataInvalided)
+			return;
+
+		m_dataInvalided = true;
+		OnTransferRequired(this);
+	}
+
+	void WorldInstance::UpdateInstanceData()
+	{
+		PredefinedInstanceData instanceUboOffsets = PredefinedInstanceData::GetOffsets();
+
+		RenderBufferPool& bufferPool = Graphics::Instance()->GetInstanceDataBufferPool();
+		bufferPool.Update(m_instanceDataIndex, instanceUboOffsets.worldMatrixOffset, sizeof(Matrix4f), &m_worldMatrix);
+		bufferPool.Update(m_instanceDataIndex, instanceUboOffsets.invWorldMatrixOffset, sizeof(Matrix4f), &m_invWorldMatrix);
 	}
 }
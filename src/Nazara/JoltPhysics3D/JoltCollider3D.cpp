@@ -4,7 +4,10 @@
 
 #include <Nazara/JoltPhysics3D/JoltCollider3D.hpp>
 #include <Nazara/Core/PrimitiveList.hpp>
+#include <Nazara/Core/Hash/XXH64.hpp>
 #include <Nazara/JoltPhysics3D/JoltHelper.hpp>
+#include <Nazara/JoltPhysics3D/JoltPhysics3D.hpp>
+#include <Nazara/JoltPhysics3D/JoltShapeCache.hpp>
 #include <Nazara/Utility/Algorithm.hpp>
 #include <Nazara/Utility/IndexBuffer.hpp>
 #include <Nazara/Utility/SoftwareBuffer.hpp>
@@ -19,12 +22,108 @@
 #include <Jolt/Physics/Collision/Shape/RotatedTranslatedShape.h>
 #include <Jolt/Physics/Collision/Shape/SphereShape.h>
 #include <Jolt/Physics/Collision/Shape/StaticCompoundShape.h>
+#include <array>
 #include <optional>
+#include <type_traits>
 #include <unordered_map>
 #include <Nazara/JoltPhysics3D/Debug.hpp>
 
 namespace Nz
 {
+	NAZARA_ANONYMOUS_NAMESPACE
+	{
+		// Allows a collider to reuse a shape cooked for another one
+		template<typename T>
+		class SharedShapeSettings final : public T
+		{
+			public:
+				void ShareCookedShape(UInt64 contentHash)
+				{
+					JoltPhysics3D* physics = JoltPhysics3D::Instance();
+					if (!physics)
+						return;
+
+					this->mCachedResult = physics->GetShapeCache().GetOrCook(contentHash, [&] { return T::Create(); });
+				}
+		};
+
+		class ShapeContentHasher
+		{
+			public:
+				ShapeContentHasher(JoltColliderType3D colliderType)
+				{
+					m_hasher.Begin();
+					Append(UnderlyingCast(colliderType));
+				}
+
+				template<typename T>
+				void Append(const T& value)
+				{
+					static_assert(std::is_trivially_copyable_v<T>);
+					m_hasher.Append(reinterpret_cast<const UInt8*>(&value), sizeof(value));
+				}
+
+				void AppendPosition(float x, float y, float z)
+				{
+					// Don't hash Jolt vectors directly, their padding component is unspecified
+					std::array<float, 3> position = { x, y, z };
+					Append(position);
+				}
+
+				UInt64 End()
+				{
+					ByteArray digest = m_hasher.End();
+
+					UInt64 hash = 0;
+					for (std::size_t i = 0; i < digest.GetSize(); ++i)
+						hash = (hash << 8) | digest[i];
+
+					return hash;
+				}
+
+			private:
+				XXH64Hasher m_hasher;
+		};
+
+		template<typename T>
+		void SetupMeshShapeSettings(SharedShapeSettings<JPH::MeshShapeSettings>& settings, SparsePtr<const Vector3f> vertices, std::size_t vertexCount, SparsePtr<const T> indices, std::size_t indexCount)
+		{
+			settings.mTriangleVertices.resize(vertexCount);
+			for (std::size_t i = 0; i < vertexCount; ++i)
+			{
+				settings.mTriangleVertices[i].x = vertices[i].x;
+				settings.mTriangleVertices[i].y = vertices[i].y;
+				settings.mTriangleVertices[i].z = vertices[i].z;
+			}
+
+			std::size_t triangleCount = indexCount / 3;
+			settings.mIndexedTriangles.resize(triangleCount);
+			for (std::size_t i = 0; i < triangleCount; ++i)
+			{
+				settings.mIndexedTriangles[i].mIdx[0] = indices[i * 3 + 0];
+				settings.mIndexedTriangles[i].mIdx[1] = indices[i * 3 + 1];
+				settings.mIndexedTriangles[i].mIdx[2] = indices[i * 3 + 2];
+			}
+
+			settings.Sanitize();
+
+			ShapeContentHasher hasher(JoltColliderType3D::Mesh);
+			hasher.Append(settings.mTriangleVertices.size());
+			for (const JPH::Float3& vertex : settings.mTriangleVertices)
+				hasher.AppendPosition(vertex.x, vertex.y, vertex.z);
+
+			hasher.Append(settings.mIndexedTriangles.size());
+			for (const JPH::IndexedTriangle& triangle : settings.mIndexedTriangles)
+				hasher.Append(triangle.mIdx);
+
+			settings.ShareCookedShape(hasher.End());
+
+			// Cooked shape is all we need from now on
+			settings.mTriangleVertices = {};
+			settings.mIndexedTriangles = {};
+		}
+	}
+
 	JoltCollider3D::JoltCollider3D() = default;
 	JoltCollider3D::~JoltCollider3D() = default;
 
@@ -290,14 +389,30 @@ namespace Nz
 
 	JoltConvexHullCollider3D::JoltConvexHullCollider3D(SparsePtr<const Vector3f> vertices, std::size_t vertexCount, float hullTolerance, float convexRadius, float maxErrorConvexRadius)
 	{
-		std::unique_ptr<JPH::ConvexHullShapeSettings> settings = std::make_unique<JPH::ConvexHullShapeSettings>();
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		std::unique_ptr<SharedShapeSettings<JPH::ConvexHullShapeSettings>> settings = std::make_unique<SharedShapeSettings<JPH::ConvexHullShapeSettings>>();
 		settings->mHullTolerance = hullTolerance;
 		settings->mMaxConvexRadius = convexRadius;
 		settings->mMaxErrorConvexRadius = maxErrorConvexRadius;
 
+		ShapeContentHasher hasher(JoltColliderType3D::Convex);
+		hasher.Append(hullTolerance);
+		hasher.Append(convexRadius);
+		hasher.Append(maxErrorConvexRadius);
+		hasher.Append(vertexCount);
+
 		settings->mPoints.resize(vertexCount);
 		for (std::size_t i = 0; i < vertexCount; ++i)
+		{
 			settings->mPoints[i] = ToJolt(vertices[i]);
+			hasher.AppendPosition(vertices[i].x, vertices[i].y, vertices[i].z);
+		}
+
+		settings->ShareCookedShape(hasher.End());
+
+		// Cooked shape is all we need from now on
+		settings->mPoints = {};
 
 		SetupShapeSettings(std::move(settings));
 	}
@@ -357,50 +472,20 @@ namespace Nz
 	
 	JoltMeshCollider3D::JoltMeshCollider3D(SparsePtr<const Vector3f> vertices, std::size_t vertexCount, SparsePtr<const UInt16> indices, std::size_t indexCount)
 	{
-		std::unique_ptr<JPH::MeshShapeSettings> settings = std::make_unique<JPH::MeshShapeSettings>();
-		settings->mTriangleVertices.resize(vertexCount);
-		for (std::size_t i = 0; i < vertexCount; ++i)
-		{
-			settings->mTriangleVertices[i].x = vertices[i].x;
-			settings->mTriangleVertices[i].y = vertices[i].y;
-			settings->mTriangleVertices[i].z = vertices[i].z;
-		}
-
-		std::size_t triangleCount = indexCount / 3;
-		settings->mIndexedTriangles.resize(triangleCount);
-		for (std::size_t i = 0; i < triangleCount; ++i)
-		{
-			settings->mIndexedTriangles[i].mIdx[0] = indices[i * 3 + 0];
-			settings->mIndexedTriangles[i].mIdx[1] = indices[i * 3 + 1];
-			settings->mIndexedTriangles[i].mIdx[2] = indices[i * 3 + 2];
-		}
+		NAZARA_USE_ANONYMOUS_NAMESPACE
 
-		settings->Sanitize();
+		std::unique_ptr<SharedShapeSettings<JPH::MeshShapeSettings>> settings = std::make_unique<SharedShapeSettings<JPH::MeshShapeSettings>>();
+		SetupMeshShapeSettings(*settings, vertices, vertexCount, indices, indexCount);
 
 		SetupShapeSettings(std::move(settings));
 	}
 
 	JoltMeshCollider3D::JoltMeshCollider3D(SparsePtr<const Vector3f> vertices, std::size_t vertexCount, SparsePtr<const UInt32> indices, std::size_t indexCount)
 	{
-		std::unique_ptr<JPH::MeshShapeSettings> settings = std::make_unique<JPH::MeshShapeSettings>();
-		settings->mTriangleVertices.resize(vertexCount);
-		for (std::size_t i = 0; i < vertexCount; ++i)
-		{
-			settings->mTriangleVertices[i].x = vertices[i].x;
-			settings->mTriangleVertices[i].y = vertices[i].y;
-			settings->mTriangleVertices[i].z = vertices[i].z;
-		}
-
-		std::size_t triangleCount = indexCount / 3;
-		settings->mIndexedTriangles.resize(triangleCount);
-		for (std::size_t i = 0; i < triangleCount; ++i)
-		{
-			settings->mIndexedTriangles[i].mIdx[0] = indices[i * 3 + 0];
-			settings->mIndexedTriangles[i].mIdx[1] = indices[i * 3 + 1];
-			settings->mIndexedTriangles[i].mIdx[2] = indices[i * 3 + 2];
-		}
+		NAZARA_USE_ANONYMOUS_NAMESPACE
 
-		settings->Sanitize();
+		std::unique_ptr<SharedShapeSettings<JPH::MeshShapeSettings>> settings = std::make_unique<SharedShapeSettings<JPH::MeshShapeSettings>>();
+		SetupMeshShapeSettings(*settings, vertices, vertexCount, indices, indexCount);
 
 		SetupShapeSettings(std::move(settings));
 	}
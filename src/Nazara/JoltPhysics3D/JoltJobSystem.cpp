@@ -0,0 +1,102 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - JoltPhysics3D module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/JoltPhysics3D/JoltJobSystem.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <thread>
+#include <Nazara/JoltPhysics3D/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup joltphysics3d
+	* \class Nz::JoltJobSystem
+	* \brief JoltPhysics3D class that runs Jolt jobs on the engine task scheduler
+	*
+	* Physics jobs are queued as regular tasks, so they share the scheduler workers with every other engine job
+	* instead of competing with them on a dedicated thread pool.
+	* Barriers are handled by JPH::JobSystemWithBarrier, the thread waiting on a barrier helps running its jobs.
+	*/
+
+	JoltJobSystem::JoltJobSystem(TaskScheduler& taskScheduler, JPH::uint maxJobs, JPH::uint maxBarriers) :
+	JobSystemWithBarrier(maxBarriers),
+	m_queuedJobCount(0),
+	m_taskScheduler(taskScheduler)
+	{
+		m_jobs.Init(maxJobs, maxJobs);
+	}
+
+	/*!
+	* \brief Waits for the queued tasks to release their jobs before freeing them
+	*
+	* A job can be run by a thread waiting on a barrier before the task queued for it starts,
+	* which leaves the task holding a reference to the job.
+	*/
+	JoltJobSystem::~JoltJobSystem()
+	{
+		while (m_queuedJobCount > 0)
+			std::this_thread::yield();
+	}
+
+	auto JoltJobSystem::CreateJob(const char* name, JPH::ColorArg color, const JobFunction& jobFunction, JPH::uint32 dependencyCount) -> JobHandle
+	{
+		JPH::uint32 jobIndex;
+		for (;;)
+		{
+			jobIndex = m_jobs.ConstructObject(name, color, this, jobFunction, dependencyCount);
+			if (jobIndex != JPH::FixedSizeFreeList<Job>::cInvalidObjectIndex)
+				break;
+
+			// Every job slot is in use, wait for running jobs to release theirs
+			NazaraAssert(false, "no more jobs available");
+			std::this_thread::yield();
+		}
+
+		Job* job = &m_jobs.Get(jobIndex);
+
+		// Take the handle before queuing the job, as it could finish and be freed right away otherwise
+		JobHandle handle(job);
+
+		// Jobs with dependencies are queued by their last dependency
+		if (dependencyCount == 0)
+			QueueJob(job);
+
+		return handle;
+	}
+
+	int JoltJobSystem::GetMaxConcurrency() const
+	{
+		// The thread stepping the physics runs jobs while waiting on barriers
+		return SafeCast<int>(m_taskScheduler.GetWorkerCount() + 1);
+	}
+
+	void JoltJobSystem::FreeJob(Job* job)
+	{
+		m_jobs.DestructObject(job);
+	}
+
+	void JoltJobSystem::QueueJob(Job* job)
+	{
+		// Keep the job alive until the task has run, it will be released there
+		job->AddRef();
+		m_queuedJobCount++;
+
+		m_taskScheduler.AddTask([this, job]
+		{
+			// Does nothing if the job was already run by a thread waiting on a barrier
+			job->Execute();
+			job->Release();
+
+			m_queuedJobCount--;
+		});
+	}
+
+	void JoltJobSystem::QueueJobs(Job** jobs, JPH::uint jobCount)
+	{
+		for (JPH::uint i = 0; i < jobCount; ++i)
+			QueueJob(jobs[i]);
+	}
+}
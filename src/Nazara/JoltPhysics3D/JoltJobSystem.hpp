@@ -0,0 +1,47 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - JoltPhysics3D module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_JOLTPHYSICS3D_JOLTJOBSYSTEM_HPP
+#define NAZARA_JOLTPHYSICS3D_JOLTJOBSYSTEM_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/FixedSizeFreeList.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
+#include <atomic>
+
+namespace Nz
+{
+	class TaskScheduler;
+
+	class JoltJobSystem final : public JPH::JobSystemWithBarrier
+	{
+		public:
+			JoltJobSystem(TaskScheduler& taskScheduler, JPH::uint maxJobs, JPH::uint maxBarriers);
+			JoltJobSystem(const JoltJobSystem&) = delete;
+			JoltJobSystem(JoltJobSystem&&) = delete;
+			~JoltJobSystem();
+
+			JobHandle CreateJob(const char* name, JPH::ColorArg color, const JobFunction& jobFunction, JPH::uint32 dependencyCount = 0) override;
+
+			int GetMaxConcurrency() const override;
+
+			JoltJobSystem& operator=(const JoltJobSystem&) = delete;
+			JoltJobSystem& operator=(JoltJobSystem&&) = delete;
+
+		protected:
+			void FreeJob(Job* job) override;
+			void QueueJob(Job* job) override;
+			void QueueJobs(Job** jobs, JPH::uint jobCount) override;
+
+		private:
+			JPH::FixedSizeFreeList<Job> m_jobs;
+			std::atomic_uint m_queuedJobCount;
+			TaskScheduler& m_taskScheduler;
+	};
+}
+
+#endif // NAZARA_JOLTPHYSICS3D_JOLTJOBSYSTEM_HPP
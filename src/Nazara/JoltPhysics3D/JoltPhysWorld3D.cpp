@@ -3,10 +3,16 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/JoltPhysics3D/JoltPhysWorld3D.hpp>
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/Core.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/JoltPhysics3D/JoltCharacter.hpp>
+#include <Nazara/JoltPhysics3D/JoltCollider3D.hpp>
 #include <Nazara/JoltPhysics3D/JoltHelper.hpp>
 #include <Nazara/JoltPhysics3D/JoltPhysics3D.hpp>
 #include <Nazara/JoltPhysics3D/JoltPhysicsStepListener.hpp>
+#include <Nazara/JoltPhysics3D/JoltVirtualCharacter.hpp>
 #include <NazaraUtils/MemoryPool.hpp>
 #include <NazaraUtils/StackVector.hpp>
 #include <Jolt/Jolt.h>
@@ -14,15 +20,21 @@
 #include <Jolt/Physics/PhysicsSettings.h>
 #include <Jolt/Physics/PhysicsStepListener.h>
 #include <Jolt/Physics/PhysicsSystem.h>
+#include <Jolt/Physics/StateRecorder.h>
 #include <Jolt/Physics/Body/BodyActivationListener.h>
+#include <Jolt/Physics/Body/BodyLockMulti.h>
 #include <Jolt/Physics/Collision/CastResult.h>
+#include <Jolt/Physics/Collision/CollideShape.h>
 #include <Jolt/Physics/Collision/CollisionCollectorImpl.h>
 #include <Jolt/Physics/Collision/ObjectLayer.h>
 #include <Jolt/Physics/Collision/RayCast.h>
+#include <Jolt/Physics/Collision/ShapeCast.h>
 #include <Jolt/Physics/Collision/BroadPhase/BroadPhaseLayer.h>
 #include <Jolt/Physics/Collision/Shape/SphereShape.h>
 #include <tsl/ordered_set.h>
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <Nazara/JoltPhysics3D/Debug.hpp>
 
 namespace DitchMeAsap
@@ -162,6 +174,32 @@ namespace Nz
 {
 	namespace NAZARA_ANONYMOUS_NAMESPACE
 	{
+		constexpr std::size_t BodyAdditionChunkSize = 1024;
+		constexpr std::size_t BodyTransformChunkSize = 1024;
+		constexpr std::size_t BroadphaseOptimizationThreshold = 4096;
+		constexpr std::size_t QueryChunkSize = 64;
+		constexpr std::size_t StateChunkSize = 1024;
+		constexpr std::size_t VirtualCharacterChunkSize = 32;
+
+		template<typename F>
+		void ForEachQueryChunk(std::size_t queryCount, F&& func)
+		{
+			if (queryCount > QueryChunkSize)
+				Core::Instance()->GetTaskScheduler().ForEachChunk(queryCount, QueryChunkSize, func);
+			else
+				func(0, queryCount);
+		}
+
+		JoltRigidBody3D* GetHitBody(const JPH::BodyLockInterface& bodyLockInterface, const JPH::BodyID& bodyID)
+		{
+			// Read lock so that queries running on multiple threads don't block each other
+			JPH::BodyLockRead lock(bodyLockInterface, bodyID);
+			if (!lock.Succeeded())
+				return nullptr; //< body was destroyed
+
+			return reinterpret_cast<JoltRigidBody3D*>(static_cast<std::uintptr_t>(lock.GetBody().GetUserData()));
+		}
+
 		class CallbackHitResult : public JPH::CastRayCollector
 		{
 			public:
@@ -214,6 +252,84 @@ namespace Nz
 				Vector3f m_to;
 				bool m_didHit;
 		};
+
+		// Jolt state recorders serializing to a reusable buffer (default implementation goes through a std::stringstream)
+		class SnapshotReader : public JPH::StateRecorder
+		{
+			public:
+				SnapshotReader(const std::vector<UInt8>& buffer) :
+				m_buffer(buffer),
+				m_offset(0),
+				m_failed(false)
+				{
+				}
+
+				bool IsEOF() const override
+				{
+					return m_offset >= m_buffer.size();
+				}
+
+				bool IsFailed() const override
+				{
+					return m_failed;
+				}
+
+				void ReadBytes(void* outData, std::size_t inNumBytes) override
+				{
+					if (m_buffer.size() - m_offset < inNumBytes)
+					{
+						std::memset(outData, 0, inNumBytes);
+						m_failed = true;
+						return;
+					}
+
+					std::memcpy(outData, &m_buffer[m_offset], inNumBytes);
+					m_offset += inNumBytes;
+				}
+
+				void WriteBytes(const void* /*inData*/, std::size_t /*inNumBytes*/) override
+				{
+					m_failed = true;
+				}
+
+			private:
+				const std::vector<UInt8>& m_buffer;
+				std::size_t m_offset;
+				bool m_failed;
+		};
+
+		class SnapshotWriter : public JPH::StateRecorder
+		{
+			public:
+				SnapshotWriter(std::vector<UInt8>& buffer) :
+				m_buffer(buffer)
+				{
+				}
+
+				bool IsEOF() const override
+				{
+					return true;
+				}
+
+				bool IsFailed() const override
+				{
+					return false;
+				}
+
+				void ReadBytes(void* outData, std::size_t inNumBytes) override
+				{
+					std::memset(outData, 0, inNumBytes);
+				}
+
+				void WriteBytes(const void* inData, std::size_t inNumBytes) override
+				{
+					const UInt8* data = static_cast<const UInt8*>(inData);
+					m_buffer.insert(m_buffer.end(), data, data + inNumBytes);
+				}
+
+			private:
+				std::vector<UInt8>& m_buffer;
+		};
 	}
 
 	class JoltPhysWorld3D::BodyActivationListener : public JPH::BodyActivationListener
@@ -265,16 +381,138 @@ namespace Nz
 			JoltPhysWorld3D& m_physWorld;
 	};
 
+	class JoltPhysWorld3D::TempAllocator : public JPH::TempAllocator
+	{
+		public:
+			TempAllocator(std::size_t size) :
+			m_allocationCount(0),
+			m_overflowCount(0),
+			m_peakUsage(0),
+			m_usage(0),
+			m_top(0)
+			{
+				Resize(size);
+			}
+
+			TempAllocator(const TempAllocator&) = delete;
+			TempAllocator(TempAllocator&&) = delete;
+
+			~TempAllocator()
+			{
+				assert(m_allocationCount == 0);
+				if (m_buffer)
+					JPH::AlignedFree(m_buffer);
+			}
+
+			void* Allocate(JPH::uint size) override
+			{
+				if (size == 0)
+					return nullptr;
+
+				std::size_t alignedSize = AlignedSize(size);
+
+				m_allocationCount++;
+				m_usage += alignedSize;
+				m_peakUsage = std::max(m_peakUsage, m_usage);
+
+				if (m_top + alignedSize <= m_size)
+				{
+					void* ptr = m_buffer + m_top;
+					m_top += alignedSize;
+
+					return ptr;
+				}
+
+				// Buffer is full, fallback to the heap (and remember it so the buffer size can be tuned)
+				m_overflowCount++;
+				return JPH::AlignedAllocate(alignedSize, JPH_RVECTOR_ALIGNMENT);
+			}
+
+			void Free(void* address, JPH::uint size) override
+			{
+				if (!address)
+					return;
+
+				std::size_t alignedSize = AlignedSize(size);
+
+				assert(m_allocationCount > 0);
+				m_allocationCount--;
+				m_usage -= alignedSize;
+
+				UInt8* ptr = static_cast<UInt8*>(address);
+				if (ptr >= m_buffer && ptr < m_buffer + m_size)
+				{
+					assert(ptr + alignedSize == m_buffer + m_top); //< allocations are freed in reverse order
+					m_top -= alignedSize;
+				}
+				else
+					JPH::AlignedFree(address);
+			}
+
+			std::size_t GetOverflowCount() const
+			{
+				return m_overflowCount;
+			}
+
+			std::size_t GetPeakUsage() const
+			{
+				return m_peakUsage;
+			}
+
+			std::size_t GetSize() const
+			{
+				return m_size;
+			}
+
+			void ResetStats()
+			{
+				m_overflowCount = 0;
+				m_peakUsage = m_usage;
+			}
+
+			void Resize(std::size_t size)
+			{
+				NazaraAssert(m_allocationCount == 0, "temp allocator cannot be resized while in use");
+
+				if (m_buffer)
+					JPH::AlignedFree(m_buffer);
+
+				m_size = AlignedSize(size);
+				m_buffer = (m_size > 0) ? static_cast<UInt8*>(JPH::AlignedAllocate(m_size, JPH_RVECTOR_ALIGNMENT)) : nullptr;
+			}
+
+			TempAllocator& operator=(const TempAllocator&) = delete;
+			TempAllocator& operator=(TempAllocator&&) = delete;
+
+		private:
+			static std::size_t AlignedSize(std::size_t size)
+			{
+				return (size + JPH_RVECTOR_ALIGNMENT - 1) / JPH_RVECTOR_ALIGNMENT * JPH_RVECTOR_ALIGNMENT;
+			}
+
+			std::size_t m_allocationCount;
+			std::size_t m_overflowCount;
+			std::size_t m_peakUsage;
+			std::size_t m_size;
+			std::size_t m_usage;
+			std::size_t m_top;
+			UInt8* m_buffer = nullptr;
+	};
+
 	struct JoltPhysWorld3D::JoltWorld
 	{
 		using BodySet = tsl::ordered_set<JPH::BodyID, std::hash<JPH::BodyID>, std::equal_to<JPH::BodyID>, std::allocator<JPH::BodyID>, std::vector<JPH::BodyID>>;
 
-		JPH::TempAllocatorImpl tempAllocator;
+		JoltPhysWorld3D::TempAllocator tempAllocator;
 		JPH::PhysicsSystem physicsSystem;
 		BodySet pendingAdditionActivate;
 		BodySet pendingAdditionNoActivate;
 		BodySet pendingDeactivations;
 		std::vector<JPH::BodyID> tempBodyIDVec;
+		std::vector<JPH::BodyID> tempRemovedBodyIDVec;
+		std::vector<JPH::BodyInterface::AddState> tempAddStates;
+		JPH::BodyIDVector activeBodyIDs;
+		std::size_t addedBodyCountSinceOptimization = 0;
 		std::unique_ptr<JPH::SphereShape> nullShape;
 
 		JoltPhysWorld3D::BodyActivationListener bodyActivationListener;
@@ -284,7 +522,7 @@ namespace Nz
 		DitchMeAsap::ObjectLayerPairFilterImpl objectLayerFilter;
 		DitchMeAsap::ObjectVsBroadPhaseLayerFilterImpl objectBroadphaseLayerFilter;
 
-		JoltWorld(JoltPhysWorld3D& world, JPH::uint tempAllocatorSize) :
+		JoltWorld(JoltPhysWorld3D& world, std::size_t tempAllocatorSize) :
 		tempAllocator(tempAllocatorSize),
 		bodyActivationListener(world),
 		stepListener(world)
@@ -323,11 +561,126 @@ namespace Nz
 
 	JoltPhysWorld3D::~JoltPhysWorld3D() = default;
 
+	std::vector<JoltRigidBody3D> JoltPhysWorld3D::CreateRigidBodies(const JoltRigidBody3D::DynamicSettings* settings, std::size_t bodyCount)
+	{
+		// Bodies are only queued here, they are inserted all at once by the next RefreshBodies
+		std::vector<JoltRigidBody3D> bodies;
+		bodies.reserve(bodyCount);
+
+		for (std::size_t i = 0; i < bodyCount; ++i)
+			bodies.emplace_back(*this, settings[i]);
+
+		return bodies;
+	}
+
+	std::vector<JoltRigidBody3D> JoltPhysWorld3D::CreateRigidBodies(const JoltRigidBody3D::StaticSettings* settings, std::size_t bodyCount)
+	{
+		std::vector<JoltRigidBody3D> bodies;
+		bodies.reserve(bodyCount);
+
+		for (std::size_t i = 0; i < bodyCount; ++i)
+			bodies.emplace_back(*this, settings[i]);
+
+		return bodies;
+	}
+
+	void JoltPhysWorld3D::DestroyRigidBodies(JoltRigidBody3D* const* bodies, std::size_t bodyCount)
+	{
+		std::vector<JPH::BodyID>& destroyedBodyIDs = m_world->tempBodyIDVec;
+		std::vector<JPH::BodyID>& removedBodyIDs = m_world->tempRemovedBodyIDVec;
+		destroyedBodyIDs.clear();
+		removedBodyIDs.clear();
+
+		for (std::size_t i = 0; i < bodyCount; ++i)
+		{
+			JoltRigidBody3D* body = bodies[i];
+			if (!body->m_body)
+				continue;
+
+			NazaraAssert(body->m_world == this, "body doesn't belong to this world");
+
+			JPH::BodyID bodyID = body->m_body->GetID();
+			m_world->pendingAdditionActivate.erase(bodyID);
+			m_world->pendingAdditionNoActivate.erase(bodyID);
+			m_world->pendingDeactivations.erase(bodyID);
+
+			UInt32 bodyIndex = bodyID.GetIndex();
+			if (IsBodyRegistered(bodyIndex))
+			{
+				UInt32 blockIndex = bodyIndex / 64;
+				UInt32 localIndex = bodyIndex % 64;
+
+				m_registeredBodies[blockIndex] &= ~(UInt64(1u) << localIndex);
+
+				removedBodyIDs.push_back(bodyID);
+			}
+
+			destroyedBodyIDs.push_back(bodyID);
+
+			body->m_body = nullptr;
+			body->m_geom.reset();
+		}
+
+		JPH::BodyInterface& bodyInterface = m_world->physicsSystem.GetBodyInterface();
+		if (!removedBodyIDs.empty())
+			bodyInterface.RemoveBodies(removedBodyIDs.data(), SafeCast<int>(removedBodyIDs.size()));
+
+		if (!destroyedBodyIDs.empty())
+			bodyInterface.DestroyBodies(destroyedBodyIDs.data(), SafeCast<int>(destroyedBodyIDs.size()));
+	}
+
 	UInt32 JoltPhysWorld3D::GetActiveBodyCount() const
 	{
 		return m_world->physicsSystem.GetNumActiveBodies();
 	}
 
+	/*!
+	* \brief Retrieves the position and rotation of every active rigid body
+	*
+	* Only bodies which moved during the last step are returned, which makes this suitable to replicate bodies to their owners without visiting sleeping and static bodies.
+	* Bodies are locked once for all and read in parallel chunks on the task scheduler workers when there are many of them.
+	*
+	* \param transforms Vector receiving the transforms, its content is replaced
+	*
+	* \remark This must not be called during a step
+	*/
+	void JoltPhysWorld3D::GetActiveBodyTransforms(std::vector<ActiveBodyTransform>& transforms) const
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		JPH::BodyIDVector& bodyIDs = m_world->activeBodyIDs;
+#if JPH_VERSION_MAJOR >= 4
+		m_world->physicsSystem.GetActiveBodies(JPH::EBodyType::RigidBody, bodyIDs);
+#else
+		m_world->physicsSystem.GetActiveBodies(bodyIDs);
+#endif
+
+		transforms.resize(bodyIDs.size());
+		if (bodyIDs.empty())
+			return;
+
+		JPH::BodyLockMultiRead lock(m_world->physicsSystem.GetBodyLockInterface(), bodyIDs.data(), SafeCast<int>(bodyIDs.size()));
+
+		auto ReadTransforms = [&](std::size_t first, std::size_t last)
+		{
+			for (std::size_t i = first; i < last; ++i)
+			{
+				const JPH::Body* body = lock.GetBody(SafeCast<int>(i));
+				assert(body);
+
+				ActiveBodyTransform& transform = transforms[i];
+				transform.bodyIndex = bodyIDs[i].GetIndex();
+				transform.position = FromJolt(body->GetPosition());
+				transform.rotation = FromJolt(body->GetRotation());
+			}
+		};
+
+		if (bodyIDs.size() > BodyTransformChunkSize)
+			Core::Instance()->GetTaskScheduler().ForEachChunk(bodyIDs.size(), BodyTransformChunkSize, ReadTransforms);
+		else
+			ReadTransforms(0, bodyIDs.size());
+	}
+
 	Vector3f JoltPhysWorld3D::GetGravity() const
 	{
 		return FromJolt(m_world->physicsSystem.GetGravity());
@@ -348,6 +701,11 @@ namespace Nz
 		return m_stepSize;
 	}
 
+	std::size_t JoltPhysWorld3D::GetTempAllocatorSize() const
+	{
+		return m_world->tempAllocator.GetSize();
+	}
+
 	bool JoltPhysWorld3D::RaycastQuery(const Vector3f& from, const Vector3f& to, const FunctionRef<std::optional<float>(const RaycastHit& hitInfo)>& callback)
 	{
 		NAZARA_USE_ANONYMOUS_NAMESPACE
@@ -394,6 +752,93 @@ namespace Nz
 		return true;
 	}
 
+	void JoltPhysWorld3D::RaycastQueryFirstBatch(const RaySegment* rays, std::size_t rayCount, std::optional<RaycastHit>* results)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		NazaraAssert(rayCount == 0 || (rays && results), "invalid query arrays");
+
+		const JPH::BodyLockInterface& bodyLockInterface = m_world->physicsSystem.GetBodyLockInterface();
+		const JPH::NarrowPhaseQuery& narrowPhaseQuery = m_world->physicsSystem.GetNarrowPhaseQuery();
+
+		ForEachQueryChunk(rayCount, [&](std::size_t first, std::size_t last)
+		{
+			JPH::RayCastSettings rayCastSettings;
+
+			for (std::size_t i = first; i < last; ++i)
+			{
+				const RaySegment& ray = rays[i];
+				results[i].reset();
+
+				JPH::RRayCast rayCast;
+				rayCast.mDirection = ToJolt(ray.to - ray.from);
+				rayCast.mOrigin = ToJolt(ray.from);
+
+				JPH::ClosestHitCollisionCollector<JPH::CastRayCollector> collector;
+				narrowPhaseQuery.CastRay(rayCast, rayCastSettings, collector);
+				if (!collector.HadHit())
+					continue;
+
+				JPH::BodyLockRead lock(bodyLockInterface, collector.mHit.mBodyID);
+				if (!lock.Succeeded())
+					continue; //< body was destroyed before lock
+
+				const JPH::Body& body = lock.GetBody();
+
+				RaycastHit& hitInfo = results[i].emplace();
+				hitInfo.fraction = collector.mHit.mFraction;
+				hitInfo.hitPosition = Lerp(ray.from, ray.to, hitInfo.fraction);
+				hitInfo.hitBody = reinterpret_cast<JoltRigidBody3D*>(static_cast<std::uintptr_t>(body.GetUserData()));
+				hitInfo.hitNormal = FromJolt(body.GetWorldSpaceSurfaceNormal(collector.mHit.mSubShapeID2, rayCast.GetPointOnRay(collector.mHit.mFraction)));
+			}
+		});
+	}
+
+	void JoltPhysWorld3D::OverlapQueryBatch(const JoltCollider3D& collider, const ShapeTransform* transforms, std::size_t queryCount, std::vector<JoltRigidBody3D*>* results)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		NazaraAssert(queryCount == 0 || (transforms && results), "invalid query arrays");
+
+		JPH::ShapeRefC shape = collider.GetShapeSettings()->Create().Get();
+
+		const JPH::BodyLockInterface& bodyLockInterface = m_world->physicsSystem.GetBodyLockInterface();
+		const JPH::NarrowPhaseQuery& narrowPhaseQuery = m_world->physicsSystem.GetNarrowPhaseQuery();
+
+		ForEachQueryChunk(queryCount, [&](std::size_t first, std::size_t last)
+		{
+			JPH::CollideShapeSettings collideShapeSettings;
+			JPH::AllHitCollisionCollector<JPH::CollideShapeCollector> collector;
+			std::vector<JPH::BodyID> hitBodies;
+
+			for (std::size_t i = first; i < last; ++i)
+			{
+				const ShapeTransform& transform = transforms[i];
+
+				JPH::RMat44 centerOfMassTransform = JPH::RMat44::sRotationTranslation(ToJolt(transform.rotation), ToJolt(transform.position)) * JPH::Mat44::sTranslation(shape->GetCenterOfMass());
+
+				collector.Reset();
+				narrowPhaseQuery.CollideShape(shape, JPH::Vec3::sReplicate(1.f), centerOfMassTransform, collideShapeSettings, JPH::RVec3::sZero(), collector);
+
+				// A body may be hit multiple times (by different sub-shapes)
+				hitBodies.clear();
+				for (const JPH::CollideShapeResult& hit : collector.mHits)
+					hitBodies.push_back(hit.mBodyID2);
+
+				std::sort(hitBodies.begin(), hitBodies.end());
+				hitBodies.erase(std::unique(hitBodies.begin(), hitBodies.end()), hitBodies.end());
+
+				std::vector<JoltRigidBody3D*>& bodies = results[i];
+				bodies.clear();
+				for (const JPH::BodyID& bodyID : hitBodies)
+				{
+					if (JoltRigidBody3D* body = GetHitBody(bodyLockInterface, bodyID))
+						bodies.push_back(body);
+				}
+			}
+		});
+	}
+
 	void JoltPhysWorld3D::RefreshBodies()
 	{
 		// Batch add bodies (keeps the broadphase efficient)
@@ -413,12 +858,38 @@ namespace Nz
 				bodyInterface.AddBody(bodies.front(), activation);
 			else
 			{
-				m_world->tempBodyIDVec.resize(bodies.size());
-				std::memcpy(&m_world->tempBodyIDVec[0], bodies.data(), bodies.size() * sizeof(JPH::BodyID));
+				std::vector<JPH::BodyID>& bodyIDs = m_world->tempBodyIDVec;
+				bodyIDs.resize(bodies.size());
+				std::memcpy(&bodyIDs[0], bodies.data(), bodies.size() * sizeof(JPH::BodyID));
+
+				if (bodyIDs.size() > BodyAdditionChunkSize)
+				{
+					// Build the broadphase trees of large insertions in parallel on workers (which doesn't touch the physics system),
+					// only inserting those trees needs to be done here
+					std::size_t chunkCount = (bodyIDs.size() + BodyAdditionChunkSize - 1) / BodyAdditionChunkSize;
+					m_world->tempAddStates.resize(chunkCount);
+
+					Core::Instance()->GetTaskScheduler().ForEachChunk(bodyIDs.size(), BodyAdditionChunkSize, [&](std::size_t first, std::size_t last)
+					{
+						m_world->tempAddStates[first / BodyAdditionChunkSize] = bodyInterface.AddBodiesPrepare(&bodyIDs[first], SafeCast<int>(last - first));
+					});
+
+					for (std::size_t chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+					{
+						std::size_t first = chunkIndex * BodyAdditionChunkSize;
+						std::size_t count = std::min(BodyAdditionChunkSize, bodyIDs.size() - first);
 
-				JPH::BodyInterface::AddState addState = bodyInterface.AddBodiesPrepare(m_world->tempBodyIDVec.data(), SafeCast<int>(m_world->tempBodyIDVec.size()));
-				bodyInterface.AddBodiesFinalize(m_world->tempBodyIDVec.data(), SafeCast<int>(m_world->tempBodyIDVec.size()), addState, activation);
+						bodyInterface.AddBodiesFinalize(&bodyIDs[first], SafeCast<int>(count), m_world->tempAddStates[chunkIndex], activation);
+					}
+				}
+				else
+				{
+					JPH::BodyInterface::AddState addState = bodyInterface.AddBodiesPrepare(bodyIDs.data(), SafeCast<int>(bodyIDs.size()));
+					bodyInterface.AddBodiesFinalize(bodyIDs.data(), SafeCast<int>(bodyIDs.size()), addState, activation);
+				}
 			}
+
+			m_world->addedBodyCountSinceOptimization += bodies.size();
 		};
 
 		// Handle pending register/unregister bodies
@@ -439,6 +910,155 @@ namespace Nz
 			bodyInterface.DeactivateBodies(m_world->pendingDeactivations.data(), SafeCast<int>(m_world->pendingDeactivations.size()));
 			m_world->pendingDeactivations.clear();
 		}
+
+		// Batch insertions are added as separate subtrees, which slows down queries until the broadphase gets rebuilt
+		if (m_world->addedBodyCountSinceOptimization >= BroadphaseOptimizationThreshold)
+		{
+			m_world->physicsSystem.OptimizeBroadPhase();
+			m_world->addedBodyCountSinceOptimization = 0;
+		}
+	}
+
+	/*!
+	* \brief Restores the simulation state captured by SaveState
+	* \return True if the state was restored successfully
+	*
+	* \param snapshot Snapshot previously filled by SaveState on this world
+	*
+	* A full snapshot restores every body, contact cache and constraint state, this requires the same bodies and constraints to exist as when the snapshot was taken.
+	* A delta snapshot only restores positions, rotations and velocities of the bodies which were active, other bodies are left untouched.
+	*
+	* \remark This must not be called during a step
+	*/
+	bool JoltPhysWorld3D::RestoreState(const StateSnapshot& snapshot)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		RefreshBodies();
+
+		if (snapshot.isDelta)
+		{
+			JPH::BodyInterface& bodyInterface = m_world->physicsSystem.GetBodyInterface();
+
+			std::vector<JPH::BodyID>& restoredBodyIDs = m_world->tempBodyIDVec;
+			restoredBodyIDs.clear();
+
+			bool succeeded = true;
+			for (const StateSnapshot::BodyState& bodyState : snapshot.activeBodies)
+			{
+				JPH::BodyID bodyID(bodyState.bodyID);
+				if (!bodyInterface.IsAdded(bodyID))
+				{
+					NazaraError("body #{0} from snapshot doesn't exist anymore", bodyID.GetIndex());
+					succeeded = false;
+					continue;
+				}
+
+				bodyInterface.SetPositionRotationAndVelocity(bodyID, ToJolt(bodyState.position), ToJolt(bodyState.rotation), ToJolt(bodyState.linearVelocity), ToJolt(bodyState.angularVelocity));
+				restoredBodyIDs.push_back(bodyID);
+			}
+
+			// Bodies were active when captured, even if they had no velocity
+			if (!restoredBodyIDs.empty())
+				bodyInterface.ActivateBodies(restoredBodyIDs.data(), SafeCast<int>(restoredBodyIDs.size()));
+
+			m_timestepAccumulator = snapshot.timestepAccumulator;
+			return succeeded;
+		}
+
+		SnapshotReader reader(snapshot.data);
+		if (!m_world->physicsSystem.RestoreState(reader) || reader.IsFailed())
+		{
+			NazaraError("failed to restore physics state, bodies or constraints don't match the snapshot");
+			return false;
+		}
+
+		// Activation states were restored without going through the activation listener
+		std::size_t blockCount = (m_world->physicsSystem.GetMaxBodies() - 1) / 64 + 1;
+		for (std::size_t i = 0; i < blockCount; ++i)
+			m_activeBodies[i] = 0;
+
+		JPH::BodyIDVector& activeBodyIDs = m_world->activeBodyIDs;
+#if JPH_VERSION_MAJOR >= 4
+		m_world->physicsSystem.GetActiveBodies(JPH::EBodyType::RigidBody, activeBodyIDs);
+#else
+		m_world->physicsSystem.GetActiveBodies(activeBodyIDs);
+#endif
+
+		for (const JPH::BodyID& bodyID : activeBodyIDs)
+		{
+			UInt32 bodyIndex = bodyID.GetIndex();
+			m_activeBodies[bodyIndex / 64] |= UInt64(1u) << (bodyIndex % 64);
+		}
+
+		m_timestepAccumulator = snapshot.timestepAccumulator;
+		return true;
+	}
+
+	/*!
+	* \brief Captures the simulation state of the world
+	*
+	* \param snapshot Snapshot receiving the state, its content is replaced (but its memory is reused)
+	* \param activeBodiesOnly If true, only positions, rotations and velocities of active bodies are captured (delta snapshot)
+	*
+	* A full snapshot serializes the whole physics system state (bodies, contact cache and constraints), which allows for exact rollbacks.
+	* A delta snapshot is much cheaper when most bodies are sleeping, active bodies are read in parallel chunks on the task scheduler workers when there are many of them.
+	* This is meant to be called frequently (for rollback netcode), a snapshot can be kept and reused to avoid memory allocations.
+	*
+	* \remark Pending bodies are added to the simulation before capturing the state
+	* \remark This must not be called during a step
+	*/
+	void JoltPhysWorld3D::SaveState(StateSnapshot& snapshot, bool activeBodiesOnly)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		RefreshBodies();
+
+		snapshot.activeBodies.clear();
+		snapshot.data.clear();
+		snapshot.isDelta = activeBodiesOnly;
+		snapshot.timestepAccumulator = m_timestepAccumulator;
+
+		if (!activeBodiesOnly)
+		{
+			SnapshotWriter writer(snapshot.data);
+			m_world->physicsSystem.SaveState(writer);
+			return;
+		}
+
+		JPH::BodyIDVector& bodyIDs = m_world->activeBodyIDs;
+#if JPH_VERSION_MAJOR >= 4
+		m_world->physicsSystem.GetActiveBodies(JPH::EBodyType::RigidBody, bodyIDs);
+#else
+		m_world->physicsSystem.GetActiveBodies(bodyIDs);
+#endif
+
+		snapshot.activeBodies.resize(bodyIDs.size());
+		if (bodyIDs.empty())
+			return;
+
+		JPH::BodyLockMultiRead lock(m_world->physicsSystem.GetBodyLockInterface(), bodyIDs.data(), SafeCast<int>(bodyIDs.size()));
+
+		auto ReadStates = [&](std::size_t first, std::size_t last)
+		{
+			for (std::size_t i = first; i < last; ++i)
+			{
+				const JPH::Body* body = lock.GetBody(SafeCast<int>(i));
+				assert(body);
+
+				StateSnapshot::BodyState& bodyState = snapshot.activeBodies[i];
+				bodyState.angularVelocity = FromJolt(body->GetAngularVelocity());
+				bodyState.bodyID = bodyIDs[i].GetIndexAndSequenceNumber();
+				bodyState.linearVelocity = FromJolt(body->GetLinearVelocity());
+				bodyState.position = FromJolt(body->GetPosition());
+				bodyState.rotation = FromJolt(body->GetRotation());
+			}
+		};
+
+		if (bodyIDs.size() > StateChunkSize)
+			Core::Instance()->GetTaskScheduler().ForEachChunk(bodyIDs.size(), StateChunkSize, ReadStates);
+		else
+			ReadStates(0, bodyIDs.size());
 	}
 
 	void JoltPhysWorld3D::SetGravity(const Vector3f& gravity)
@@ -456,8 +1076,72 @@ namespace Nz
 		m_stepSize = stepSize;
 	}
 
+	/*!
+	* \brief Changes the size of the buffer used for temporary allocations during a step
+	*
+	* \param size New buffer size in bytes
+	*
+	* \remark Allocations which don't fit in the buffer fall back to the heap, StepStats::tempAllocatorOverflowCount and StepStats::tempAllocatorPeakUsage can be used to tune this
+	* \remark This must not be called during a step
+	*/
+	void JoltPhysWorld3D::SetTempAllocatorSize(std::size_t size)
+	{
+		m_world->tempAllocator.Resize(size);
+	}
+
+	/*!
+	* \brief Advances the simulation by a number of fixed steps matching the elapsed time
+	*
+	* \param timestep Elapsed time since last call
+	*
+	* At most GetMaxStepCount() steps are taken, the remaining time is kept for the next calls.
+	* Statistics about the call can be retrieved afterwards using GetLastStepStats.
+	*/
+	void JoltPhysWorld3D::ShapeCastQueryFirstBatch(const JoltCollider3D& collider, const ShapeCast* casts, std::size_t castCount, std::optional<RaycastHit>* results)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		NazaraAssert(castCount == 0 || (casts && results), "invalid query arrays");
+
+		JPH::ShapeRefC shape = collider.GetShapeSettings()->Create().Get();
+
+		const JPH::BodyLockInterface& bodyLockInterface = m_world->physicsSystem.GetBodyLockInterface();
+		const JPH::NarrowPhaseQuery& narrowPhaseQuery = m_world->physicsSystem.GetNarrowPhaseQuery();
+
+		ForEachQueryChunk(castCount, [&](std::size_t first, std::size_t last)
+		{
+			JPH::ShapeCastSettings shapeCastSettings;
+
+			for (std::size_t i = first; i < last; ++i)
+			{
+				const ShapeCast& cast = casts[i];
+				results[i].reset();
+
+				JPH::RMat44 startTransform = JPH::RMat44::sRotationTranslation(ToJolt(cast.rotation), ToJolt(cast.from));
+				JPH::RShapeCast shapeCast = JPH::RShapeCast::sFromWorldTransform(shape, JPH::Vec3::sReplicate(1.f), startTransform, ToJolt(cast.to - cast.from));
+
+				JPH::ClosestHitCollisionCollector<JPH::CastShapeCollector> collector;
+				narrowPhaseQuery.CastShape(shapeCast, shapeCastSettings, JPH::RVec3::sZero(), collector);
+				if (!collector.HadHit())
+					continue;
+
+				JoltRigidBody3D* hitBody = GetHitBody(bodyLockInterface, collector.mHit.mBodyID2);
+				if (!hitBody)
+					continue;
+
+				RaycastHit& hitInfo = results[i].emplace();
+				hitInfo.fraction = collector.mHit.mFraction;
+				hitInfo.hitBody = hitBody;
+				hitInfo.hitNormal = FromJolt(-collector.mHit.mPenetrationAxis.NormalizedOr(JPH::Vec3::sZero()));
+				hitInfo.hitPosition = FromJolt(collector.mHit.mContactPointOn2);
+			}
+		});
+	}
+
 	void JoltPhysWorld3D::Step(Time timestep)
 	{
+		HighPrecisionClock clock;
+
 		RefreshBodies();
 
 		JPH::JobSystem& jobSystem = JoltPhysics3D::Instance()->GetThreadPool();
@@ -465,9 +1149,14 @@ namespace Nz
 
 		m_timestepAccumulator += timestep;
 
+		m_world->tempAllocator.ResetStats();
+
 		std::size_t stepCount = 0;
 		while (m_timestepAccumulator >= m_stepSize && stepCount < m_maxStepCount)
 		{
+			// Characters query the world using locking interfaces, which cannot be done from a step listener as all bodies are locked during the update
+			UpdateVirtualCharacters(stepSize);
+
 			m_world->physicsSystem.Update(stepSize, 1, 1, &m_world->tempAllocator, &jobSystem);
 
 			for (JoltPhysicsStepListener* stepListener : m_stepListeners)
@@ -476,6 +1165,16 @@ namespace Nz
 			m_timestepAccumulator -= m_stepSize;
 			stepCount++;
 		}
+
+		m_lastStepStats.activeBodyCount = GetActiveBodyCount();
+		m_lastStepStats.isLagging = (m_timestepAccumulator >= m_stepSize);
+		m_lastStepStats.maxStepCount = m_maxStepCount;
+		m_lastStepStats.remainingTime = m_timestepAccumulator;
+		m_lastStepStats.stepCount = stepCount;
+		m_lastStepStats.stepSize = m_stepSize;
+		m_lastStepStats.tempAllocatorOverflowCount = m_world->tempAllocator.GetOverflowCount();
+		m_lastStepStats.tempAllocatorPeakUsage = m_world->tempAllocator.GetPeakUsage();
+		m_lastStepStats.duration = clock.GetElapsedTime();
 	}
 
 	void JoltPhysWorld3D::RegisterBody(const JPH::BodyID& bodyID, bool activate, bool removeFromDeactivationList)
@@ -548,4 +1247,23 @@ namespace Nz
 		for (JoltPhysicsStepListener* stepListener : m_stepListeners)
 			stepListener->PreSimulate(deltatime);
 	}
+
+	void JoltPhysWorld3D::UpdateVirtualCharacters(float elapsedTime)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		// Virtual characters aren't bodies and don't see each other, which allows them to be updated concurrently
+		auto UpdateCharacters = [&](std::size_t first, std::size_t last)
+		{
+			// The world temporary allocator isn't thread-safe
+			JPH::TempAllocatorMalloc tempAllocator;
+			for (std::size_t i = first; i < last; ++i)
+				m_virtualCharacters[i]->Update(elapsedTime, tempAllocator);
+		};
+
+		if (m_virtualCharacters.size() > VirtualCharacterChunkSize)
+			Core::Instance()->GetTaskScheduler().ForEachChunk(m_virtualCharacters.size(), VirtualCharacterChunkSize, UpdateCharacters);
+		else if (!m_virtualCharacters.empty())
+			UpdateCharacters(0, m_virtualCharacters.size());
+	}
 }
@@ -7,6 +7,8 @@
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/Log.hpp>
 #include <Nazara/JoltPhysics3D/Config.hpp>
+#include <Nazara/JoltPhysics3D/JoltJobSystem.hpp>
+#include <Nazara/JoltPhysics3D/JoltShapeCache.hpp>
 #include <Jolt/Jolt.h>
 #include <Jolt/RegisterTypes.h>
 #include <Jolt/Core/Factory.h>
@@ -31,7 +33,7 @@ static void TraceImpl(const char* inFMT, ...)
 
 namespace Nz
 {
-	JoltPhysics3D::JoltPhysics3D(Config /*config*/) :
+	JoltPhysics3D::JoltPhysics3D(Config config) :
 	ModuleBase("JoltPhysics3D", this)
 	{
 		JPH::RegisterDefaultAllocator();
@@ -39,17 +41,21 @@ namespace Nz
 		JPH::Factory::sInstance = new JPH::Factory;
 		JPH::RegisterTypes();
 
-		int threadCount = -1; //< system CPU core count
 #ifdef NAZARA_PLATFORM_WEB
-		threadCount = 0; // no thread on web for now
+		// No thread on web for now, jobs are run by the thread waiting on the barriers
+		m_jobSystem = std::make_unique<JPH::JobSystemThreadPool>(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, 0);
+#else
+		// Run physics jobs on the engine workers instead of spawning a thread pool competing with them
+		m_jobSystem = std::make_unique<JoltJobSystem>(Core::Instance()->GetTaskScheduler(), JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers);
 #endif
 
-		m_threadPool = std::make_unique<JPH::JobSystemThreadPool>(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, threadCount);
+		m_shapeCache = std::make_unique<JoltShapeCache>(std::move(config.cookedShapeDirectory));
 	}
 
 	JoltPhysics3D::~JoltPhysics3D()
 	{
-		m_threadPool.reset();
+		m_shapeCache.reset();
+		m_jobSystem.reset();
 		JPH::UnregisterTypes();
 
 		delete JPH::Factory::sInstance;
@@ -58,7 +64,12 @@ namespace Nz
 
 	JPH::JobSystem& JoltPhysics3D::GetThreadPool()
 	{
-		return *m_threadPool;
+		return *m_jobSystem;
+	}
+
+	std::size_t JoltPhysics3D::PurgeShapeCache()
+	{
+		return m_shapeCache->Purge();
 	}
 
 	JoltPhysics3D* JoltPhysics3D::s_instance;
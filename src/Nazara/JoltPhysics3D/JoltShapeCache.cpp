@@ -0,0 +1,224 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - JoltPhysics3D module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/JoltPhysics3D/JoltShapeCache.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Jolt/Core/StreamIn.h>
+#include <Jolt/Core/StreamOut.h>
+#include <cstdio>
+#include <cstring>
+#include <optional>
+#include <Nazara/JoltPhysics3D/Debug.hpp>
+
+namespace Nz
+{
+	NAZARA_ANONYMOUS_NAMESPACE
+	{
+		constexpr UInt32 CookedShapeMagic = 0x434A534E; //< NSJC
+		constexpr UInt32 CookedShapeVersion = 1;
+
+		struct CookedShapeHeader
+		{
+			UInt32 magic;
+			UInt32 version;
+			UInt64 contentHash;
+		};
+
+		class MemoryStreamIn final : public JPH::StreamIn
+		{
+			public:
+				MemoryStreamIn(const UInt8* data, std::size_t size) :
+				m_data(data),
+				m_offset(0),
+				m_size(size),
+				m_failed(false)
+				{
+				}
+
+				void ReadBytes(void* outData, std::size_t numBytes) override
+				{
+					if (numBytes > m_size - m_offset)
+					{
+						m_failed = true;
+						m_offset = m_size;
+						return;
+					}
+
+					std::memcpy(outData, &m_data[m_offset], numBytes);
+					m_offset += numBytes;
+				}
+
+				bool IsEOF() const override
+				{
+					return m_offset >= m_size;
+				}
+
+				bool IsFailed() const override
+				{
+					return m_failed;
+				}
+
+			private:
+				const UInt8* m_data;
+				std::size_t m_offset;
+				std::size_t m_size;
+				bool m_failed;
+		};
+
+		class MemoryStreamOut final : public JPH::StreamOut
+		{
+			public:
+				MemoryStreamOut(std::vector<UInt8>& data) :
+				m_data(data)
+				{
+				}
+
+				void WriteBytes(const void* inData, std::size_t numBytes) override
+				{
+					const UInt8* bytes = static_cast<const UInt8*>(inData);
+					m_data.insert(m_data.end(), bytes, bytes + numBytes);
+				}
+
+				bool IsFailed() const override
+				{
+					return false;
+				}
+
+			private:
+				std::vector<UInt8>& m_data;
+		};
+	}
+
+	JoltShapeCache::JoltShapeCache(std::filesystem::path cookedShapeDirectory) :
+	m_cookedShapeDirectory(std::move(cookedShapeDirectory))
+	{
+		if (!m_cookedShapeDirectory.empty())
+		{
+			std::error_code ec;
+			std::filesystem::create_directories(m_cookedShapeDirectory, ec);
+			if (ec)
+			{
+				NazaraWarning("failed to create cooked shape directory {0}: {1}, cooked shapes will not be stored", m_cookedShapeDirectory, ec.message());
+				m_cookedShapeDirectory.clear();
+			}
+		}
+	}
+
+	JPH::ShapeResult JoltShapeCache::GetOrCook(UInt64 contentHash, const FunctionRef<JPH::ShapeResult()>& cookCallback)
+	{
+		{
+			std::unique_lock lock(m_mutex);
+			if (auto it = m_shapes.find(contentHash); it != m_shapes.end())
+			{
+				JPH::ShapeResult result;
+				result.Set(it->second);
+				return result;
+			}
+		}
+
+		// Cook without holding the lock, cooking a mesh may take a while
+		JPH::ShapeResult result;
+		if (!m_cookedShapeDirectory.empty())
+			result = LoadCookedShape(contentHash);
+
+		if (!result.IsValid())
+		{
+			result = cookCallback();
+			if (!result.IsValid())
+				return result;
+
+			if (!m_cookedShapeDirectory.empty())
+				SaveCookedShape(contentHash, *result.Get());
+		}
+
+		std::unique_lock lock(m_mutex);
+
+		// Another thread may have cooked the same shape in the meantime, keep a single instance
+		auto [it, inserted] = m_shapes.emplace(contentHash, result.Get());
+		if (!inserted)
+			result.Set(it->second);
+
+		return result;
+	}
+
+	std::size_t JoltShapeCache::Purge()
+	{
+		std::unique_lock lock(m_mutex);
+
+		std::size_t purgedCount = 0;
+		for (auto it = m_shapes.begin(); it != m_shapes.end();)
+		{
+			// Only referenced by the cache
+			if (it->second->GetRefCount() == 1)
+			{
+				it = m_shapes.erase(it);
+				purgedCount++;
+			}
+			else
+				++it;
+		}
+
+		return purgedCount;
+	}
+
+	std::filesystem::path JoltShapeCache::GetCookedShapePath(UInt64 contentHash) const
+	{
+		char fileName[32];
+		std::snprintf(fileName, sizeof(fileName), "%016llX.joltshape", static_cast<unsigned long long>(contentHash));
+
+		return m_cookedShapeDirectory / fileName;
+	}
+
+	JPH::ShapeResult JoltShapeCache::LoadCookedShape(UInt64 contentHash) const
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		std::filesystem::path filePath = GetCookedShapePath(contentHash);
+		if (!std::filesystem::is_regular_file(filePath))
+			return {};
+
+		std::optional<std::vector<UInt8>> fileContent = File::ReadWhole(filePath);
+		if (!fileContent || fileContent->size() < sizeof(CookedShapeHeader))
+			return {};
+
+		CookedShapeHeader header;
+		std::memcpy(&header, fileContent->data(), sizeof(header));
+		if (header.magic != CookedShapeMagic || header.version != CookedShapeVersion || header.contentHash != contentHash)
+		{
+			NazaraWarning("cooked shape {0} is outdated or corrupted, ignoring it", filePath);
+			return {};
+		}
+
+		MemoryStreamIn stream(fileContent->data() + sizeof(header), fileContent->size() - sizeof(header));
+		JPH::ShapeResult result = JPH::Shape::sRestoreFromBinaryState(stream);
+		if (stream.IsFailed())
+		{
+			NazaraWarning("failed to restore cooked shape {0}, ignoring it", filePath);
+			return {};
+		}
+
+		return result;
+	}
+
+	void JoltShapeCache::SaveCookedShape(UInt64 contentHash, const JPH::Shape& shape) const
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		CookedShapeHeader header;
+		header.magic = CookedShapeMagic;
+		header.version = CookedShapeVersion;
+		header.contentHash = contentHash;
+
+		std::vector<UInt8> fileContent(sizeof(header));
+		std::memcpy(fileContent.data(), &header, sizeof(header));
+
+		MemoryStreamOut stream(fileContent);
+		shape.SaveBinaryState(stream);
+
+		std::filesystem::path filePath = GetCookedShapePath(contentHash);
+		if (!File::WriteWhole(filePath, fileContent.data(), fileContent.size()))
+			NazaraWarning("failed to save cooked shape to {0}", filePath);
+	}
+}
@@ -0,0 +1,47 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - JoltPhysics3D module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_JOLTPHYSICS3D_JOLTSHAPECACHE_HPP
+#define NAZARA_JOLTPHYSICS3D_JOLTSHAPECACHE_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <NazaraUtils/FunctionRef.hpp>
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Collision/Shape/Shape.h>
+#include <filesystem>
+#include <mutex>
+#include <unordered_map>
+
+namespace Nz
+{
+	// Shares cooked shapes (mesh, convex hulls) between colliders built from the same data, and optionally stores them on disk
+	class JoltShapeCache
+	{
+		public:
+			JoltShapeCache(std::filesystem::path cookedShapeDirectory);
+			JoltShapeCache(const JoltShapeCache&) = delete;
+			JoltShapeCache(JoltShapeCache&&) = delete;
+			~JoltShapeCache() = default;
+
+			JPH::ShapeResult GetOrCook(UInt64 contentHash, const FunctionRef<JPH::ShapeResult()>& cookCallback);
+
+			std::size_t Purge();
+
+			JoltShapeCache& operator=(const JoltShapeCache&) = delete;
+			JoltShapeCache& operator=(JoltShapeCache&&) = delete;
+
+		private:
+			std::filesystem::path GetCookedShapePath(UInt64 contentHash) const;
+			JPH::ShapeResult LoadCookedShape(UInt64 contentHash) const;
+			void SaveCookedShape(UInt64 contentHash, const JPH::Shape& shape) const;
+
+			std::filesystem::path m_cookedShapeDirectory;
+			std::mutex m_mutex;
+			std::unordered_map<UInt64, JPH::Ref<JPH::Shape>> m_shapes;
+	};
+}
+
+#endif // NAZARA_JOLTPHYSICS3D_JOLTSHAPECACHE_HPP
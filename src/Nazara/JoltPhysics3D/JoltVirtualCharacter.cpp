@@ -0,0 +1,168 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - JoltPhysics3D module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/JoltPhysics3D/JoltVirtualCharacter.hpp>
+#include <Nazara/JoltPhysics3D/JoltCollider3D.hpp>
+#include <Nazara/JoltPhysics3D/JoltHelper.hpp>
+#include <Nazara/JoltPhysics3D/JoltPhysWorld3D.hpp>
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+#include <Jolt/Physics/Body/BodyFilter.h>
+#include <Jolt/Physics/Character/CharacterVirtual.h>
+#include <Jolt/Physics/Collision/ShapeFilter.h>
+#include <Nazara/JoltPhysics3D/Debug.hpp>
+
+namespace Nz
+{
+	JoltVirtualCharacter::JoltVirtualCharacter() = default;
+
+	JoltVirtualCharacter::JoltVirtualCharacter(JoltPhysWorld3D& physWorld, const Settings& settings)
+	{
+		Create(physWorld, settings);
+	}
+
+	JoltVirtualCharacter::JoltVirtualCharacter(JoltVirtualCharacter&& character) noexcept :
+	m_collider(std::move(character.m_collider)),
+	m_character(std::move(character.m_character)),
+	m_world(std::move(character.m_world)),
+	m_isGhost(character.m_isGhost)
+	{
+		if (m_world)
+		{
+			m_world->UnregisterVirtualCharacter(&character);
+			m_world->RegisterVirtualCharacter(this);
+		}
+	}
+
+	JoltVirtualCharacter::~JoltVirtualCharacter()
+	{
+		Destroy();
+	}
+
+	void JoltVirtualCharacter::EnableGhost(bool enable)
+	{
+		m_isGhost = enable;
+	}
+
+	Vector3f JoltVirtualCharacter::GetLinearVelocity() const
+	{
+		return FromJolt(m_character->GetLinearVelocity());
+	}
+
+	Vector3f JoltVirtualCharacter::GetPosition() const
+	{
+		return FromJolt(m_character->GetPosition());
+	}
+
+	std::pair<Vector3f, Quaternionf> JoltVirtualCharacter::GetPositionAndRotation() const
+	{
+		return { FromJolt(m_character->GetPosition()), FromJolt(m_character->GetRotation()) };
+	}
+
+	Quaternionf JoltVirtualCharacter::GetRotation() const
+	{
+		return FromJolt(m_character->GetRotation());
+	}
+
+	Vector3f JoltVirtualCharacter::GetUp() const
+	{
+		return FromJolt(m_character->GetUp());
+	}
+
+	bool JoltVirtualCharacter::IsOnGround() const
+	{
+		return m_character->GetGroundState() == JPH::CharacterVirtual::EGroundState::OnGround;
+	}
+
+	void JoltVirtualCharacter::SetLinearVelocity(const Vector3f& linearVel)
+	{
+		m_character->SetLinearVelocity(ToJolt(linearVel));
+	}
+
+	void JoltVirtualCharacter::SetRotation(const Quaternionf& rotation)
+	{
+		m_character->SetRotation(ToJolt(rotation));
+	}
+
+	void JoltVirtualCharacter::SetUp(const Vector3f& up)
+	{
+		m_character->SetUp(ToJolt(up));
+	}
+
+	void JoltVirtualCharacter::TeleportTo(const Vector3f& position, const Quaternionf& rotation)
+	{
+		m_character->SetPosition(ToJolt(position));
+		m_character->SetRotation(ToJolt(rotation));
+	}
+
+	JoltVirtualCharacter& JoltVirtualCharacter::operator=(JoltVirtualCharacter&& character) noexcept
+	{
+		Destroy();
+
+		m_collider = std::move(character.m_collider);
+		m_character = std::move(character.m_character);
+		m_isGhost = character.m_isGhost;
+		m_world = std::move(character.m_world);
+
+		if (m_world)
+		{
+			m_world->UnregisterVirtualCharacter(&character);
+			m_world->RegisterVirtualCharacter(this);
+		}
+
+		return *this;
+	}
+
+	void JoltVirtualCharacter::Create(JoltPhysWorld3D& physWorld, const Settings& settings)
+	{
+		m_collider = settings.collider;
+		m_isGhost = settings.isGhost;
+		m_world = &physWorld;
+
+		auto shapeResult = m_collider->GetShapeSettings()->Create();
+		if (!shapeResult.IsValid())
+			throw std::runtime_error("invalid shape");
+
+		JPH::CharacterVirtualSettings characterSettings;
+		characterSettings.mShape = shapeResult.Get();
+		characterSettings.mMass = settings.mass;
+		characterSettings.mMaxSlopeAngle = settings.maxSlopeAngle.ToRadians();
+		characterSettings.mMaxStrength = settings.maxStrength;
+
+		m_character = std::make_unique<JPH::CharacterVirtual>(&characterSettings, ToJolt(settings.position), ToJolt(settings.rotation), m_world->GetPhysicsSystem());
+
+		m_world->RegisterVirtualCharacter(this);
+	}
+
+	void JoltVirtualCharacter::Destroy()
+	{
+		m_character.reset();
+
+		if (m_world)
+		{
+			m_world->UnregisterVirtualCharacter(this);
+			m_world = nullptr;
+		}
+
+		m_collider.reset();
+	}
+
+	void JoltVirtualCharacter::Update(float elapsedTime, JPH::TempAllocator& tempAllocator)
+	{
+		if (m_isGhost)
+		{
+			m_character->SetPosition(m_character->GetPosition() + m_character->GetLinearVelocity() * elapsedTime);
+			return;
+		}
+
+		JPH::PhysicsSystem* physicsSystem = m_world->GetPhysicsSystem();
+		JPH::Vec3 gravity = physicsSystem->GetGravity();
+
+		// Virtual characters aren't simulated, apply gravity ourselves when falling
+		if (m_character->GetGroundState() != JPH::CharacterVirtual::EGroundState::OnGround)
+			m_character->SetLinearVelocity(m_character->GetLinearVelocity() + gravity * elapsedTime);
+
+		m_character->Update(elapsedTime, gravity, physicsSystem->GetDefaultBroadPhaseLayerFilter(1), physicsSystem->GetDefaultLayerFilter(1), JPH::BodyFilter{}, JPH::ShapeFilter{}, tempAllocator);
+	}
+}
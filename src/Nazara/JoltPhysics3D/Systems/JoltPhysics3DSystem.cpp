@@ -3,19 +3,28 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/JoltPhysics3D/Systems/JoltPhysics3DSystem.hpp>
+#include <Nazara/Core/Core.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Core/Components/DisabledComponent.hpp>
 #include <Nazara/Utility/Components/NodeComponent.hpp>
 #include <Nazara/JoltPhysics3D/Debug.hpp>
 
 namespace Nz
 {
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		constexpr std::size_t NodeSyncChunkSize = 512;
+	}
+
 	JoltPhysics3DSystem::JoltPhysics3DSystem(entt::registry& registry) :
 	m_registry(registry),
 	m_characterConstructObserver(m_registry, entt::collector.group<JoltCharacterComponent,   NodeComponent>(entt::exclude<DisabledComponent, JoltRigidBody3DComponent>)),
-	m_rigidBodyConstructObserver(m_registry, entt::collector.group<JoltRigidBody3DComponent, NodeComponent>(entt::exclude<DisabledComponent, JoltCharacterComponent>))
+	m_rigidBodyConstructObserver(m_registry, entt::collector.group<JoltRigidBody3DComponent, NodeComponent>(entt::exclude<DisabledComponent, JoltCharacterComponent>)),
+	m_virtualCharacterConstructObserver(m_registry, entt::collector.group<JoltVirtualCharacterComponent, NodeComponent>(entt::exclude<DisabledComponent>))
 	{
 		m_bodyConstructConnection = registry.on_construct<JoltRigidBody3DComponent>().connect<&JoltPhysics3DSystem::OnBodyConstruct>(this);
 		m_characterConstructConnection = registry.on_construct<JoltCharacterComponent>().connect<&JoltPhysics3DSystem::OnCharacterConstruct>(this);
+		m_virtualCharacterConstructConnection = registry.on_construct<JoltVirtualCharacterComponent>().connect<&JoltPhysics3DSystem::OnVirtualCharacterConstruct>(this);
 		m_bodyDestructConnection = registry.on_destroy<JoltRigidBody3DComponent>().connect<&JoltPhysics3DSystem::OnBodyDestruct>(this);
 	}
 
@@ -23,12 +32,17 @@ namespace Nz
 	{
 		m_characterConstructObserver.disconnect();
 		m_rigidBodyConstructObserver.disconnect();
+		m_virtualCharacterConstructObserver.disconnect();
 
 		// Ensure every RigidBody3D is destroyed before world is
 		auto characterView = m_registry.view<JoltCharacterComponent>();
 		for (auto [entity, characterComponent] : characterView.each())
 			characterComponent.Destroy();
 
+		auto virtualCharacterView = m_registry.view<JoltVirtualCharacterComponent>();
+		for (auto [entity, virtualCharacterComponent] : virtualCharacterView.each())
+			virtualCharacterComponent.Destroy();
+
 		auto rigidBodyView = m_registry.view<JoltRigidBody3DComponent>();
 		for (auto [entity, rigidBodyComponent] : rigidBodyView.each())
 			rigidBodyComponent.Destroy(true);
@@ -89,6 +103,14 @@ namespace Nz
 			entityBody.TeleportTo(entityNode.GetPosition(), entityNode.GetRotation());
 		});
 
+		m_virtualCharacterConstructObserver.each([this](entt::entity entity)
+		{
+			JoltVirtualCharacterComponent& entityCharacter = m_registry.get<JoltVirtualCharacterComponent>(entity);
+			NodeComponent& entityNode = m_registry.get<NodeComponent>(entity);
+
+			entityCharacter.TeleportTo(entityNode.GetPosition(), entityNode.GetRotation());
+		});
+
 		// Update the physics world
 		m_physWorld.Step(elapsedTime);
 
@@ -108,21 +130,64 @@ namespace Nz
 			}
 		}
 
-		// Replicate active rigid body position to their node components
+		// Replicate virtual characters to their NodeComponent
 		{
-			auto view = m_registry.view<NodeComponent, const JoltRigidBody3DComponent>(entt::exclude<DisabledComponent>);
-			for (auto entity : m_registry.view<NodeComponent, const JoltRigidBody3DComponent>(entt::exclude<DisabledComponent>))
+			auto view = m_registry.view<NodeComponent, const JoltVirtualCharacterComponent>(entt::exclude<DisabledComponent>);
+			for (auto entity : view)
 			{
-				auto& rigidBodyComponent = view.get<const JoltRigidBody3DComponent>(entity);
-				if (!m_physWorld.IsBodyActive(rigidBodyComponent.GetBodyIndex()))
-					continue;
-
+				auto& characterComponent = view.get<const JoltVirtualCharacterComponent>(entity);
 				auto& nodeComponent = view.get<NodeComponent>(entity);
 
-				auto [position, rotation] = rigidBodyComponent.GetPositionAndRotation();
+				auto [position, rotation] = characterComponent.GetPositionAndRotation();
 				nodeComponent.SetTransform(position, rotation);
 			}
 		}
+
+		// Replicate active rigid body position to their node components
+		{
+			NAZARA_USE_ANONYMOUS_NAMESPACE
+
+			// Only bodies which moved are returned, sleeping and static bodies don't cost anything
+			m_physWorld.GetActiveBodyTransforms(m_activeBodyTransforms);
+			m_activeBodyNodes.resize(m_activeBodyTransforms.size());
+
+			// Retrieve storages once so they can be accessed concurrently
+			auto& nodeStorage = m_registry.storage<NodeComponent>();
+			const auto& disabledStorage = m_registry.storage<DisabledComponent>();
+
+			// Nodes are written in parallel without being invalidated, as invalidation triggers signals
+			auto WriteTransforms = [&](std::size_t first, std::size_t last)
+			{
+				for (std::size_t i = first; i < last; ++i)
+				{
+					const JoltPhysWorld3D::ActiveBodyTransform& bodyTransform = m_activeBodyTransforms[i];
+
+					NodeComponent* nodeComponent = nullptr;
+					if (bodyTransform.bodyIndex < m_bodyIndicesToEntity.size())
+					{
+						entt::entity entity = m_bodyIndicesToEntity[bodyTransform.bodyIndex];
+						if (entity != entt::null && nodeStorage.contains(entity) && !disabledStorage.contains(entity))
+						{
+							nodeComponent = &nodeStorage.get(entity);
+							nodeComponent->SetTransform(bodyTransform.position, bodyTransform.rotation, CoordSys::Local, Node::Invalidation::DontInvalidate);
+						}
+					}
+
+					m_activeBodyNodes[i] = nodeComponent;
+				}
+			};
+
+			if (m_activeBodyTransforms.size() > NodeSyncChunkSize)
+				Core::Instance()->GetTaskScheduler().ForEachChunk(m_activeBodyTransforms.size(), NodeSyncChunkSize, WriteTransforms);
+			else
+				WriteTransforms(0, m_activeBodyTransforms.size());
+
+			for (NodeComponent* nodeComponent : m_activeBodyNodes)
+			{
+				if (nodeComponent)
+					nodeComponent->Invalidate();
+			}
+		}
 	}
 
 	void JoltPhysics3DSystem::OnBodyConstruct(entt::registry& registry, entt::entity entity)
@@ -144,6 +209,12 @@ namespace Nz
 		character.Construct(m_physWorld);
 	}
 
+	void JoltPhysics3DSystem::OnVirtualCharacterConstruct(entt::registry& registry, entt::entity entity)
+	{
+		JoltVirtualCharacterComponent& character = registry.get<JoltVirtualCharacterComponent>(entity);
+		character.Construct(m_physWorld);
+	}
+
 	void JoltPhysics3DSystem::OnBodyDestruct(entt::registry& registry, entt::entity entity)
 	{
 		// Unregister owning entity
@@ -18,6 +18,7 @@
 #include <Nazara/Network/ENetPeer.hpp>
 #include <Nazara/Network/NetPacket.hpp>
 #include <NazaraUtils/OffsetOf.hpp>
+#include <algorithm>
 #include <Nazara/Network/Debug.hpp>
 
 namespace Nz
@@ -40,6 +41,9 @@ namespace Nz
 			sizeof(ENetProtocolThrottleConfigure),
 			sizeof(ENetProtocolSendFragment)
 		};
+
+		// Header (with sent time) followed by either a full MTU of commands or a compressed payload of the same size
+		constexpr std::size_t MaxOutgoingDatagramSize = sizeof(ENetProtocolHeader) + sizeof(UInt32) + ENetConstants::ENetProtocol_MaximumMTU;
 	}
 
 
@@ -57,16 +61,24 @@ namespace Nz
 		return enetPacket;
 	}
 
-	void ENetHost::Broadcast(UInt8 channelId, ENetPacketFlags flags, NetPacket&& packet)
+	/*!
+	* \brief Sends a packet to every connected peer
+	*
+	* The packet is shared by all peers without being copied.
+	*
+	* \param channelId Channel to send the packet on
+	* \param packetRef Packet to send, usually allocated with AllocatePacket
+	*/
+	void ENetHost::Broadcast(UInt8 channelId, const ENetPacketRef& packetRef)
 	{
-		ENetPacketRef enetPacket = AllocatePacket(flags, std::move(packet));
+		NazaraAssert(packetRef, "invalid packet");
 
 		for (ENetPeer& peer : m_peers)
 		{
 			if (peer.GetState() != ENetPeerState::Connected)
 				continue;
 
-			peer.Send(channelId, enetPacket);
+			peer.Send(channelId, packetRef);
 		}
 	}
 
@@ -192,6 +204,9 @@ namespace Nz
 		m_receivedAddress = IpAddress::AnyIpV4;
 		m_receivedData = nullptr;
 		m_receivedDataLength = 0;
+		m_incomingDatagramCount = 0;
+		m_incomingDatagramIndex = 0;
+		m_outgoingDatagramCount = 0;
 
 		m_totalSentData = 0;
 		m_totalSentPackets = 0;
@@ -204,6 +219,10 @@ namespace Nz
 		m_maximumPacketSize = ENetConstants::ENetHost_DefaultMaximumPacketSize;
 		m_maximumWaitingData = ENetConstants::ENetHost_DefaultMaximumWaitingData;
 
+		UpdateServiceTime();
+		m_activePeers.Clear();
+		m_peerTimers.Reset(peerCount, m_serviceTime);
+
 		m_peers.reserve(peerCount);
 		for (std::size_t i = 0; i < peerCount; ++i)
 			m_peers.emplace_back(this, UInt16(i));
@@ -334,6 +353,12 @@ namespace Nz
 		m_socket.SetReceiveBufferSize(ENetConstants::ENetHost_ReceiveBufferSize);
 		m_socket.SetSendBufferSize(ENetConstants::ENetHost_SendBufferSize);
 
+		if (m_isReusingPort && !m_socket.EnablePortReuse(true))
+		{
+			NazaraError("failed to enable port reuse: {0}", ErrorToString(m_socket.GetLastError()));
+			return false;
+		}
+
 		if (address.IsValid() && !address.IsLoopback())
 		{
 			if (m_socket.Bind(address) != SocketState::Bound)
@@ -348,11 +373,42 @@ namespace Nz
 		return true;
 	}
 
+	NetDatagram& ENetHost::AllocateOutgoingDatagram(ENetPeer* peer)
+	{
+		if (m_outgoingDatagrams.size() != m_datagramBatchSize)
+		{
+			m_outgoingDatagrams.resize(m_datagramBatchSize);
+			m_outgoingDatagramData.resize(m_datagramBatchSize * MaxOutgoingDatagramSize);
+			m_outgoingDatagramPeers.resize(m_datagramBatchSize);
+		}
+
+		NetDatagram& datagram = m_outgoingDatagrams[m_outgoingDatagramCount];
+		datagram.address = peer->GetAddress();
+		datagram.buffer.data = &m_outgoingDatagramData[m_outgoingDatagramCount * MaxOutgoingDatagramSize];
+		datagram.buffer.dataLength = 0;
+
+		m_outgoingDatagramPeers[m_outgoingDatagramCount] = peer;
+		m_outgoingDatagramCount++;
+
+		return datagram;
+	}
+
+	void ENetHost::AddToActivePeers(ENetPeer* peer)
+	{
+		m_activePeers.UnboundedSet(peer->GetPeerId());
+	}
+
 	void ENetHost::AddToDispatchQueue(ENetPeer* peer)
 	{
 		m_dispatchQueue.UnboundedSet(peer->GetPeerId());
 	}
 
+	void ENetHost::RemoveFromActivePeers(ENetPeer* peer)
+	{
+		m_activePeers.UnboundedReset(peer->GetPeerId());
+		m_peerTimers.Cancel(peer->GetPeerId());
+	}
+
 	void ENetHost::RemoveFromDispatchQueue(ENetPeer* peer)
 	{
 		m_dispatchQueue.UnboundedReset(peer->GetPeerId());
@@ -532,10 +588,17 @@ namespace Nz
 			if (!m_compressor)
 				return false;
 
+			Time decompressionStart = GetElapsedNanoseconds();
 			std::size_t newSize = m_compressor->Decompress(peer, m_receivedData + headerSize, m_receivedDataLength - headerSize, m_packetData[1].data() + headerSize, m_packetData[1].size() - headerSize);
 			if (newSize == 0 || newSize > m_packetData[1].size() - headerSize)
 				return false;
 
+			if (peer)
+			{
+				peer->m_compressionStats.decompressionTime += GetElapsedNanoseconds() - decompressionStart;
+				peer->m_compressionStats.decompressedPacketCount++;
+			}
+
 			std::memcpy(m_packetData[1].data(), header, headerSize);
 			m_receivedData = m_packetData[1].data();
 			m_receivedDataLength = headerSize + newSize;
@@ -548,6 +611,9 @@ namespace Nz
 			peer->m_address = m_receivedAddress;
 			peer->m_incomingDataTotal += UInt32(m_receivedDataLength);
 			peer->m_totalByteReceived += UInt32(m_receivedDataLength);
+
+			// Incoming commands may acknowledge sent ones or delay the next ping, update its timer on next send
+			AddToActivePeers(peer);
 		}
 
 		auto commandError = [&]() -> bool
@@ -706,6 +772,7 @@ namespace Nz
 		{
 			bool shouldReceive = true;
 			std::size_t receivedLength;
+			UInt8* receivedData = m_packetData[0].data();
 
 			if (m_isSimulationEnabled)
 			{
@@ -727,11 +794,22 @@ namespace Nz
 
 			if (shouldReceive)
 			{
-				if (!m_socket.Receive(m_packetData[0].data(), m_packetData[0].size(), &m_receivedAddress, &receivedLength))
-					return -1; //< Error
+				if (m_incomingDatagramIndex >= m_incomingDatagramCount)
+				{
+					if (!ReceiveIncomingDatagrams())
+						return -1; //< Error
 
-				if (receivedLength == 0)
-					return 0;
+					if (m_incomingDatagramCount == 0)
+						return 0;
+				}
+
+				const NetDatagram& datagram = m_incomingDatagrams[m_incomingDatagramIndex++];
+				if (datagram.receivedLength == 0)
+					continue; //< truncated datagram
+
+				m_receivedAddress = datagram.address;
+				receivedData = static_cast<UInt8*>(datagram.buffer.data);
+				receivedLength = datagram.receivedLength;
 
 				if (m_isSimulationEnabled)
 				{
@@ -744,7 +822,7 @@ namespace Nz
 						PendingIncomingPacket pendingPacket;
 						pendingPacket.deliveryTime = m_serviceTime + delay;
 						pendingPacket.from = m_receivedAddress;
-						pendingPacket.data.Reset(0, m_packetData[0].data(), receivedLength);
+						pendingPacket.data.Reset(0, receivedData, receivedLength);
 
 						auto it = std::upper_bound(m_pendingIncomingPackets.begin(), m_pendingIncomingPackets.end(), pendingPacket, [] (const PendingIncomingPacket& first, const PendingIncomingPacket& second)
 						{
@@ -757,7 +835,7 @@ namespace Nz
 				}
 			}
 
-			m_receivedData = m_packetData[0].data();
+			m_receivedData = receivedData;
 			m_receivedDataLength = receivedLength;
 
 			m_totalReceivedData += receivedLength;
@@ -771,6 +849,28 @@ namespace Nz
 		return -1;
 	}
 
+	bool ENetHost::ReceiveIncomingDatagrams()
+	{
+		// Batch size changes are only applied here, as previous datagrams may not have been processed yet
+		if (m_incomingDatagrams.size() != m_datagramBatchSize)
+		{
+			m_incomingDatagrams.resize(m_datagramBatchSize);
+			m_incomingDatagramData.resize(m_datagramBatchSize * ENetConstants::ENetProtocol_MaximumMTU);
+
+			for (std::size_t i = 0; i < m_datagramBatchSize; ++i)
+			{
+				NetBuffer& buffer = m_incomingDatagrams[i].buffer;
+				buffer.data = &m_incomingDatagramData[i * ENetConstants::ENetProtocol_MaximumMTU];
+				buffer.dataLength = ENetConstants::ENetProtocol_MaximumMTU;
+			}
+		}
+
+		m_incomingDatagramCount = 0;
+		m_incomingDatagramIndex = 0;
+
+		return m_socket.ReceiveBatch(m_incomingDatagrams.data(), m_incomingDatagrams.size(), &m_incomingDatagramCount);
+	}
+
 	void ENetHost::NotifyConnect(ENetPeer* peer, ENetEvent* event, bool incoming)
 	{
 		m_recalculateBandwidthLimits = true;
@@ -816,7 +916,7 @@ namespace Nz
 		auto it = peer->m_acknowledgements.begin();
 		for (; it != peer->m_acknowledgements.end(); ++it)
 		{
-			if (m_commandCount >= m_commands.size() || m_bufferCount >= m_buffers.size() || peer->GetMtu() - m_packetSize < sizeof(ENetProtocolAcknowledge))
+			if (m_commandCount >= m_commands.size() || m_bufferCount >= m_buffers.size() || !FitsInDatagram(*peer, sizeof(ENetProtocolAcknowledge)))
 			{
 				m_continueSending = true;
 				break;
@@ -850,6 +950,43 @@ namespace Nz
 		peer->m_acknowledgements.erase(peer->m_acknowledgements.begin(), it);
 	}
 
+	void ENetHost::SendMtuProbe(ENetPeer* peer, UInt32 probeSize)
+	{
+		assert(probeSize <= ENetConstants::ENetProtocol_MaximumMTU);
+
+		m_totalSentPackets++;
+
+		// Simulated packet loss applies to probes (but they're never delayed)
+		if (peer->IsSimulationEnabled() && peer->m_packetLossProbability(s_randomGenerator))
+			return;
+
+		// A probe is an acknowledged ping padded with zeroes up to the probed size, a zero byte ends command parsing on the receiving side (this is also true for native ENet)
+		NetDatagram& datagram = AllocateOutgoingDatagram(peer);
+
+		UInt8* datagramData = static_cast<UInt8*>(datagram.buffer.data);
+		std::memset(datagramData, 0, probeSize);
+
+		UInt16 headerFlags = ENetProtocolHeaderFlag_SentTime;
+		if (peer->m_outgoingPeerID < ENetConstants::ENetProtocol_MaximumPeerId)
+			headerFlags |= peer->m_outgoingSessionID << ENetProtocolHeaderSessionShift;
+
+		ENetProtocolHeader header;
+		header.peerID = HostToNet(static_cast<UInt16>(peer->m_outgoingPeerID | headerFlags));
+		header.sentTime = HostToNet(static_cast<UInt16>(m_serviceTime));
+		std::memcpy(datagramData, &header, sizeof(header));
+
+		ENetProtocolPing ping;
+		ping.header.command = ENetProtocolCommand_Ping | ENetProtocolFlag_Acknowledge;
+		ping.header.channelID = 0xFF;
+		ping.header.reliableSequenceNumber = HostToNet(peer->m_mtuProbeSequenceNumber);
+		std::memcpy(datagramData + sizeof(header), &ping, sizeof(ping));
+
+		datagram.buffer.dataLength = probeSize;
+
+		peer->m_outgoingDataTotal += probeSize;
+		peer->m_totalByteSent += probeSize;
+	}
+
 	bool ENetHost::SendReliableOutgoingCommands(ENetPeer* peer)
 	{
 		bool canPing = true;
@@ -899,8 +1036,8 @@ namespace Nz
 
 			assert((outgoingCommand->command.header.command & ENetProtocolCommand_Mask) < ENetProtocolCommand_Count);
 			std::size_t commandSize = s_enetCommandSizes[outgoingCommand->command.header.command & ENetProtocolCommand_Mask];
-			if (m_commandCount >= m_commands.size() || m_bufferCount + 1 >= m_buffers.size() || peer->GetMtu() - m_packetSize < commandSize ||
-			    (outgoingCommand->packet && UInt16(peer->GetMtu() - m_packetSize) < UInt16(commandSize + outgoingCommand->fragmentLength)))
+			std::size_t fragmentLength = (outgoingCommand->packet) ? outgoingCommand->fragmentLength : 0;
+			if (m_commandCount >= m_commands.size() || m_bufferCount + 1 >= m_buffers.size() || !FitsInDatagram(*peer, commandSize + fragmentLength))
 			{
 				m_continueSending = true;
 				break;
@@ -971,15 +1108,19 @@ namespace Nz
 		std::array<UInt8, sizeof(ENetProtocolHeader) + sizeof(UInt32)> headerData;
 		ENetProtocolHeader* header = reinterpret_cast<ENetProtocolHeader*>(headerData.data());
 
+		// Only visit peers having something to send or whose retransmission timeout/ping interval expired
+		if (checkForTimeouts)
+			m_peerTimers.Advance(m_serviceTime, [&](std::size_t peerIndex) { m_activePeers.UnboundedSet(peerIndex); });
+
 		m_continueSending = true;
 
 		while (m_continueSending)
 		{
 			m_continueSending = false;
 
-			for (std::size_t peer = 0; peer < m_peerCount; ++peer)
+			for (std::size_t peerIndex : m_activePeers.IterBits())
 			{
-				ENetPeer* currentPeer = &m_peers[peer];
+				ENetPeer* currentPeer = &m_peers[peerIndex];
 				if (currentPeer->GetState() == ENetPeerState::Disconnected || currentPeer->GetState() == ENetPeerState::Zombie)
 					continue;
 
@@ -988,19 +1129,34 @@ namespace Nz
 				m_bufferCount = 1;
 				m_packetSize = sizeof(ENetProtocolHeader);
 
+				if (UInt32 probeSize = currentPeer->PrepareMtuProbe(); probeSize > 0)
+				{
+					SendMtuProbe(currentPeer, probeSize);
+
+					if (m_outgoingDatagramCount >= m_outgoingDatagrams.size())
+					{
+						if (int result = SendOutgoingDatagrams(event); result != 0)
+							return result;
+					}
+				}
+
 				if (!currentPeer->m_acknowledgements.empty())
 					SendAcknowledgements(currentPeer);
 
 				if (checkForTimeouts && !currentPeer->m_sentReliableCommands.empty() && ENetTimeGreaterEqual(m_serviceTime, currentPeer->m_nextTimeout) && currentPeer->CheckTimeouts(event))
 				{
 					if (event && event->type != ENetEventType::None)
+					{
+						// Don't hold back datagrams which were already queued, errors (if any) will be reported on next send
+						SendOutgoingDatagrams(nullptr);
 						return 1;
+					}
 					else
 						continue;
 				}
 
 				if ((currentPeer->m_outgoingReliableCommands.empty() || SendReliableOutgoingCommands(currentPeer)) && currentPeer->m_sentReliableCommands.empty() &&
-				    ENetTimeDifference(m_serviceTime, currentPeer->m_lastReceiveTime) >= currentPeer->m_pingInterval && currentPeer->m_mtu - m_packetSize >= sizeof(ENetProtocolPing))
+				    ENetTimeDifference(m_serviceTime, currentPeer->m_lastReceiveTime) >= currentPeer->m_pingInterval && FitsInDatagram(*currentPeer, sizeof(ENetProtocolPing)))
 				{
 					currentPeer->Ping();
 					SendReliableOutgoingCommands(currentPeer);
@@ -1055,9 +1211,41 @@ namespace Nz
 				std::size_t compressedSize = 0;
 				if (m_compressor)
 				{
-					compressedSize = m_compressor->Compress(currentPeer, &m_buffers[1], m_bufferCount - 1, m_packetSize - sizeof(ENetProtocolHeader), m_packetData[1].data(), m_packetData[1].size());
-					if (compressedSize > 0)
-						m_headerFlags |= ENetProtocolHeaderFlag_Compressed;
+					ENetPeer::CompressionStats& compressionStats = currentPeer->m_compressionStats;
+					if (currentPeer->m_compressionSkipCount > 0)
+					{
+						// This peer traffic recently didn't compress, don't waste time trying again yet
+						currentPeer->m_compressionSkipCount--;
+						compressionStats.skippedPacketCount++;
+					}
+					else
+					{
+						std::size_t inputSize = m_packetSize - sizeof(ENetProtocolHeader);
+
+						Time compressionStart = GetElapsedNanoseconds();
+						compressedSize = m_compressor->Compress(currentPeer, &m_buffers[1], m_bufferCount - 1, inputSize, m_packetData[1].data(), m_packetData[1].size());
+						compressionStats.compressionTime += GetElapsedNanoseconds() - compressionStart;
+
+						if (compressedSize > 0 && compressedSize < inputSize)
+						{
+							m_headerFlags |= ENetProtocolHeaderFlag_Compressed;
+
+							compressionStats.compressedInputSize += inputSize;
+							compressionStats.compressedOutputSize += compressedSize;
+							compressionStats.compressedPacketCount++;
+
+							currentPeer->m_compressionBackoff /= 2;
+						}
+						else
+						{
+							compressedSize = 0;
+							compressionStats.incompressiblePacketCount++;
+
+							// Exponentially back off on peers whose traffic doesn't compress
+							currentPeer->m_compressionSkipCount = currentPeer->m_compressionBackoff;
+							currentPeer->m_compressionBackoff = std::clamp<UInt32>(currentPeer->m_compressionBackoff * 2, 1, ENetConstants::ENetPeer_MaximumCompressionBackoff);
+						}
+					}
 				}
 
 				if (currentPeer->m_outgoingPeerID < ENetConstants::ENetProtocol_MaximumPeerId)
@@ -1112,36 +1300,57 @@ namespace Nz
 
 				if (sendNow)
 				{
-					std::size_t sentLength = 0;
+					// Temporary buffers are reused for the next peer, copy them to the outgoing datagram batch
+					NetDatagram& datagram = AllocateOutgoingDatagram(currentPeer);
 
-					if (!m_socket.SendMultiple(currentPeer->GetAddress(), m_buffers.data(), m_bufferCount, &sentLength))
+					UInt8* datagramData = static_cast<UInt8*>(datagram.buffer.data);
+					std::size_t datagramSize = 0;
+					for (std::size_t i = 0; i < m_bufferCount; ++i)
 					{
-						switch (m_socket.GetLastError())
-						{
-							case SocketError::NetworkError:
-							case SocketError::UnreachableHost:
-							{
-								if (!currentPeer->IsConnected())
-								{
-									//< Network is down or unreachable (ex: IPv6 address when not supported), fails peer connection immediately
-									NotifyDisconnect(currentPeer, event, true);
-									return 1;
-								}
-
-								[[fallthrough]];
-							}
+						const NetBuffer& buffer = m_buffers[i];
+						NazaraAssert(datagramSize + buffer.dataLength <= MaxOutgoingDatagramSize, "datagram is too big");
 
-							default:
-								return -1;
-						}
+						std::memcpy(datagramData + datagramSize, buffer.data, buffer.dataLength);
+						datagramSize += buffer.dataLength;
 					}
 
-					m_totalSentData += sentLength;
+					datagram.buffer.dataLength = datagramSize;
 				}
 
 				currentPeer->RemoveSentUnreliableCommands();
 				m_totalSentPackets++;
+
+				if (m_outgoingDatagramCount >= m_outgoingDatagrams.size() && m_outgoingDatagramCount > 0)
+				{
+					if (int result = SendOutgoingDatagrams(event); result != 0)
+						return result;
+				}
+			}
+		}
+
+		// Schedule the next timeout check of visited peers, and stop visiting them until they have something to send
+		for (std::size_t peerIndex : m_activePeers.IterBits())
+		{
+			ENetPeer& peer = m_peers[peerIndex];
+			if (peer.GetState() == ENetPeerState::Disconnected || peer.GetState() == ENetPeerState::Zombie)
+			{
+				RemoveFromActivePeers(&peer);
+				continue;
 			}
+
+			if (!peer.m_sentReliableCommands.empty())
+				m_peerTimers.Schedule(peerIndex, peer.m_nextTimeout);
+			else
+				m_peerTimers.Schedule(peerIndex, peer.m_lastReceiveTime + peer.m_pingInterval);
+
+			if (peer.m_acknowledgements.empty() && peer.m_outgoingReliableCommands.empty() && peer.m_outgoingUnreliableCommands.empty())
+				m_activePeers.Reset(peerIndex);
+		}
+
+		if (m_outgoingDatagramCount > 0)
+		{
+			if (int result = SendOutgoingDatagrams(event); result != 0)
+				return result;
 		}
 
 		if (!m_pendingOutgoingPackets.empty())
@@ -1162,6 +1371,52 @@ namespace Nz
 		return 0;
 	}
 
+	int ENetHost::SendOutgoingDatagrams(ENetEvent* event)
+	{
+		std::size_t datagramCount = m_outgoingDatagramCount;
+		m_outgoingDatagramCount = 0;
+
+		std::size_t firstDatagram = 0;
+		while (firstDatagram < datagramCount)
+		{
+			std::size_t sentCount;
+			if (!m_socket.SendBatch(&m_outgoingDatagrams[firstDatagram], datagramCount - firstDatagram, &sentCount))
+			{
+				// Remaining datagrams are dropped, which the protocol handles as packet loss
+				switch (m_socket.GetLastError())
+				{
+					case SocketError::NetworkError:
+					case SocketError::UnreachableHost:
+					{
+						ENetPeer* peer = m_outgoingDatagramPeers[firstDatagram];
+						if (!peer->IsConnected())
+						{
+							//< Network is down or unreachable (ex: IPv6 address when not supported), fails peer connection immediately
+							NotifyDisconnect(peer, event, true);
+							return 1;
+						}
+
+						[[fallthrough]];
+					}
+
+					default:
+						return -1;
+				}
+			}
+
+			for (std::size_t i = 0; i < sentCount; ++i)
+				m_totalSentData += m_outgoingDatagrams[firstDatagram + i].buffer.dataLength;
+
+			// Socket send buffer is full, drop remaining datagrams as if they were lost
+			if (sentCount == 0)
+				break;
+
+			firstDatagram += sentCount;
+		}
+
+		return 0;
+	}
+
 	void ENetHost::SendUnreliableOutgoingCommands(ENetPeer* peer)
 	{
 		auto currentCommand = peer->m_outgoingUnreliableCommands.begin();
@@ -1172,8 +1427,8 @@ namespace Nz
 			assert((outgoingCommand->command.header.command & ENetProtocolCommand_Mask) < ENetProtocolCommand_Count);
 			std::size_t commandSize = s_enetCommandSizes[outgoingCommand->command.header.command & ENetProtocolCommand_Mask];
 
-			if (m_commandCount >= m_commands.size() || m_bufferCount + 1 >= m_buffers.size() || peer->m_mtu - m_packetSize < commandSize ||
-			    (outgoingCommand->packet && peer->m_mtu - m_packetSize < commandSize + outgoingCommand->fragmentLength))
+			std::size_t fragmentLength = (outgoingCommand->packet) ? outgoingCommand->fragmentLength : 0;
+			if (m_commandCount >= m_commands.size() || m_bufferCount + 1 >= m_buffers.size() || !FitsInDatagram(*peer, commandSize + fragmentLength))
 			{
 				m_continueSending = true;
 				break;
@@ -0,0 +1,73 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Network/ENetLz4Compressor.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <lz4.h>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <Nazara/Network/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup network
+	* \class Nz::ENetLz4Compressor
+	* \brief Network class that compresses ENet packets using LZ4, favoring latency over compression ratio
+	*/
+
+	ENetLz4Compressor::ENetLz4Compressor(int acceleration) :
+	m_acceleration(acceleration)
+	{
+	}
+
+	std::size_t ENetLz4Compressor::Compress(const ENetPeer* /*peer*/, const NetBuffer* buffers, std::size_t bufferCount, std::size_t totalInputSize, UInt8* output, std::size_t maxOutputSize)
+	{
+		if (totalInputSize == 0 || totalInputSize > LZ4_MAX_INPUT_SIZE)
+			return 0;
+
+		// A compressed packet is only useful if it's smaller than the original one
+		std::size_t outputCapacity = std::min(maxOutputSize, totalInputSize - 1);
+		if (outputCapacity == 0 || outputCapacity > std::numeric_limits<int>::max())
+			return 0;
+
+		const char* input;
+		if (bufferCount == 1)
+			input = static_cast<const char*>(buffers[0].data);
+		else
+		{
+			m_inputBuffer.resize(totalInputSize);
+
+			std::size_t offset = 0;
+			for (std::size_t i = 0; i < bufferCount; ++i)
+			{
+				std::memcpy(&m_inputBuffer[offset], buffers[i].data, buffers[i].dataLength);
+				offset += buffers[i].dataLength;
+			}
+			NazaraAssert(offset == totalInputSize, "buffer sizes don't match total input size");
+
+			input = reinterpret_cast<const char*>(m_inputBuffer.data());
+		}
+
+		int compressedSize = LZ4_compress_fast(input, reinterpret_cast<char*>(output), SafeCast<int>(totalInputSize), SafeCast<int>(outputCapacity), m_acceleration);
+		if (compressedSize <= 0)
+			return 0;
+
+		return SafeCast<std::size_t>(compressedSize);
+	}
+
+	std::size_t ENetLz4Compressor::Decompress(const ENetPeer* /*peer*/, const UInt8* input, std::size_t inputSize, UInt8* output, std::size_t maxOutputSize)
+	{
+		if (inputSize > std::numeric_limits<int>::max())
+			return 0;
+
+		int decompressedSize = LZ4_decompress_safe(reinterpret_cast<const char*>(input), reinterpret_cast<char*>(output), SafeCast<int>(inputSize), SafeCast<int>(std::min<std::size_t>(maxOutputSize, std::numeric_limits<int>::max())));
+		if (decompressedSize <= 0)
+			return 0;
+
+		return SafeCast<std::size_t>(decompressedSize);
+	}
+}
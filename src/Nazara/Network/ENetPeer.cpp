@@ -157,6 +157,14 @@ namespace Nz
 		m_roundTripTime = ENetConstants::ENetPeer_DefaultRoundTripTime;
 		m_roundTripTimeVariance = 0;
 		m_mtu = m_host->m_mtu;
+		m_mtuProbeAttempts = 0;
+		m_mtuProbeSentTime = 0;
+		m_mtuProbeSequenceNumber = 0;
+		m_mtuProbeSize = 0;
+		m_mtuProbeUpperBound = 0;
+		m_nextMtuProbeTime = 0;
+		m_pathMtu = m_mtu;
+		m_pathMtuStats = PathMtuStats{};
 		m_reliableDataInTransit = 0;
 		m_outgoingReliableSequenceNumber = 0;
 		m_windowSize = ENetConstants::ENetProtocol_MaximumWindowSize;
@@ -170,9 +178,14 @@ namespace Nz
 		m_totalPacketLost = 0;
 		m_totalPacketSent = 0;
 		m_totalWaitingData = 0;
+		m_compressionBackoff = 0;
+		m_compressionSkipCount = 0;
+		m_compressionStats = CompressionStats{};
 
 		m_unsequencedWindow.fill(0);
 
+		m_host->RemoveFromActivePeers(this);
+
 		ResetQueues();
 	}
 
@@ -202,7 +215,7 @@ namespace Nz
 
 		Channel& channel = m_channels[channelId];
 
-		UInt16 fragmentLength = static_cast<UInt16>(m_mtu - sizeof(ENetProtocolHeader) - sizeof(ENetProtocolSendFragment));
+		UInt16 fragmentLength = static_cast<UInt16>(m_pathMtu - sizeof(ENetProtocolHeader) - sizeof(ENetProtocolSendFragment));
 
 		UInt32 packetSize = static_cast<UInt32>(packetRef->data.GetDataSize());
 		if (packetSize > fragmentLength)
@@ -211,6 +224,9 @@ namespace Nz
 			if (fragmentCount > ENetConstants::ENetProtocol_MaximumFragmentCount)
 				return false;
 
+			m_pathMtuStats.fragmentCount += fragmentCount;
+			m_pathMtuStats.fragmentedPacketCount++;
+
 			UInt8 commandNumber;
 			UInt16 startSequenceNumber;
 			if ((packetRef->flags & (ENetPacketFlag_Reliable | ENetPacketFlag_UnreliableFragment)) == ENetPacketFlag_UnreliableFragment &&
@@ -316,6 +332,11 @@ namespace Nz
 			if (command.packet)
 				m_reliableDataInTransit -= command.fragmentLength;
 
+			// A large command which keeps being lost while the peer acknowledges others hints at a path MTU decrease
+			if (command.packet && command.sendAttempts >= ENetConstants::ENetPeer_MtuBlackHoleAttempts && ENetTimeLess(command.sentTime, m_lastReceiveTime) &&
+			    sizeof(ENetProtocolHeader) + ENetHost::GetCommandSize(command.command.header.command) + command.fragmentLength > ENetConstants::ENetPeer_MtuProbeBase)
+				OnMtuBlackHole();
+
 			++m_packetsLost;
 			++m_totalPacketLost;
 
@@ -496,6 +517,14 @@ namespace Nz
 
 		UInt16 receivedReliableSequenceNumber = NetToHost(command->acknowledge.receivedReliableSequenceNumber);
 
+		if (m_mtuProbeSize != 0 && command->header.channelID == 0xFF && receivedReliableSequenceNumber == m_mtuProbeSequenceNumber)
+		{
+			// Probe made it through, keep on searching from this size
+			m_pathMtu = std::max(m_pathMtu, m_mtuProbeSize);
+			m_mtuProbeSize = 0;
+			m_nextMtuProbeTime = serviceTime;
+		}
+
 		ENetProtocolCommand commandNumber = RemoveSentReliableCommand(receivedReliableSequenceNumber, command->header.channelID);
 
 		switch (m_state)
@@ -958,6 +987,12 @@ namespace Nz
 				++m_host->m_bandwidthLimitedPeers;
 
 			++m_host->m_connectedPeers;
+
+			// MTU is negotiated at this point, start from a size most paths support and probe for a larger one
+			m_pathMtu = std::min<UInt32>(m_mtu, ENetConstants::ENetPeer_MtuProbeBase);
+			m_mtuProbeSize = 0;
+			m_mtuProbeUpperBound = m_mtu + 1;
+			m_nextMtuProbeTime = m_host->GetServiceTime();
 		}
 	}
 
@@ -972,6 +1007,72 @@ namespace Nz
 		}
 	}
 
+	void ENetPeer::OnMtuBlackHole()
+	{
+		if (m_pathMtu <= ENetConstants::ENetPeer_MtuProbeBase)
+			return;
+
+		// Fall back to the base size and search again below the size which stopped working
+		m_mtuProbeUpperBound = m_pathMtu;
+		m_mtuProbeSize = 0;
+		m_nextMtuProbeTime = m_host->GetServiceTime();
+		m_pathMtu = ENetConstants::ENetPeer_MtuProbeBase;
+
+		m_pathMtuStats.blackHoleCount++;
+	}
+
+	/*!
+	* \brief Updates the path MTU search
+	* \return Size of the probe to send now, or zero if no probe has to be sent
+	*
+	* Probes are reliable pings padded up to the probed size, they're not retransmitted as regular reliable commands since their loss only means they were too big.
+	* The negotiated MTU is probed first, then a binary search between the path MTU and the smallest size which failed is performed.
+	*/
+	UInt32 ENetPeer::PrepareMtuProbe()
+	{
+		if (m_state != ENetPeerState::Connected)
+			return 0;
+
+		UInt32 serviceTime = m_host->GetServiceTime();
+
+		if (m_mtuProbeSize != 0)
+		{
+			if (ENetTimeDifference(serviceTime, m_mtuProbeSentTime) < m_roundTripTime + 4 * m_roundTripTimeVariance)
+				return 0;
+
+			m_pathMtuStats.lostProbeCount++;
+
+			if (++m_mtuProbeAttempts < ENetConstants::ENetPeer_MtuProbeMaxAttempts)
+			{
+				m_mtuProbeSentTime = serviceTime;
+				m_pathMtuStats.probeCount++;
+
+				return m_mtuProbeSize;
+			}
+
+			m_mtuProbeUpperBound = m_mtuProbeSize;
+			m_mtuProbeSize = 0;
+		}
+		else if (m_pathMtu >= m_mtu || ENetTimeLess(serviceTime, m_nextMtuProbeTime))
+			return 0;
+
+		if (m_mtuProbeUpperBound - m_pathMtu <= ENetConstants::ENetPeer_MtuProbeGranularity)
+		{
+			// Search is over, the route may change so try to raise the path MTU again later
+			m_mtuProbeUpperBound = m_mtu + 1;
+			m_nextMtuProbeTime = serviceTime + ENetConstants::ENetPeer_MtuRaiseInterval;
+			return 0;
+		}
+
+		m_mtuProbeSize = (m_mtuProbeUpperBound > m_mtu) ? m_mtu : (m_pathMtu + m_mtuProbeUpperBound) / 2;
+		m_mtuProbeAttempts = 0;
+		m_mtuProbeSentTime = serviceTime;
+		m_mtuProbeSequenceNumber = ++m_outgoingReliableSequenceNumber;
+		m_pathMtuStats.probeCount++;
+
+		return m_mtuProbeSize;
+	}
+
 	ENetProtocolCommand ENetPeer::RemoveSentReliableCommand(UInt16 reliableSequenceNumber, UInt8 channelId)
 	{
 		std::list<OutgoingCommand>* commandList = nullptr;
@@ -1092,6 +1193,7 @@ namespace Nz
 		m_totalByteSent += sizeof(Acknowledgement);
 
 		m_acknowledgements.emplace_back(acknowledgment);
+		m_host->AddToActivePeers(this);
 
 		return true;
 	}
@@ -1334,6 +1436,8 @@ namespace Nz
 			m_outgoingReliableCommands.emplace_back(outgoingCommand);
 		else
 			m_outgoingUnreliableCommands.emplace_back(outgoingCommand);
+
+		m_host->AddToActivePeers(this);
 	}
 
 	int ENetPeer::Throttle(UInt32 rtt)
@@ -0,0 +1,301 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Network/ENetShardedHost.hpp>
+#include <Nazara/Core/Core.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/ThreadExt.hpp>
+#include <Nazara/Network/ENetHost.hpp>
+#include <Nazara/Network/ENetPeer.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <Nazara/Network/Debug.hpp>
+
+namespace Nz
+{
+	struct ENetShardedHost::Command
+	{
+		enum class Type
+		{
+			Broadcast,
+			Disconnect,
+			Send
+		};
+
+		Type type;
+		NetPacket packet;
+		ENetPacketFlags flags;
+		UInt32 data = 0;
+		UInt32 generation = 0;
+		UInt16 peerId = 0;
+		UInt8 channelId = 0;
+	};
+
+	struct ENetShardedHost::Shard
+	{
+		ENetHost host;
+		MpscQueue<Command> commands;
+		std::thread thread;
+		std::vector<UInt32> peerGenerations;
+		UInt32 index;
+	};
+
+	/*!
+	* \ingroup network
+	* \class Nz::ENetShardedHost
+	* \brief Network class that represents a server spreading its peers over multiple ENet hosts, each serviced by its own thread
+	*
+	* Every shard owns an ENetHost bound to the same port (using port reuse), the system balances incoming datagrams
+	* between them by hashing the sender address, so a peer always talks to the same shard.
+	* Shards have no shared state: events are forwarded to the owner thread through a lock-free queue (see PollEvent)
+	* and Send/Disconnect/Broadcast calls are queued to the shards, which process them between two services.
+	*
+	* \remark Port reuse is not available on Windows, where a single shard is used
+	*/
+
+	ENetShardedHost::ENetShardedHost() :
+	m_running(false),
+	m_serviceTimeout(1)
+	{
+	}
+
+	ENetShardedHost::~ENetShardedHost()
+	{
+		Destroy();
+	}
+
+	/*!
+	* \brief Sends a packet to every connected peer of every shard
+	*
+	* \param channelId Channel to send the packet on
+	* \param flags Packet flags
+	* \param packet Packet to send, copied for every shard but the last one
+	*/
+	void ENetShardedHost::Broadcast(UInt8 channelId, ENetPacketFlags flags, NetPacket&& packet)
+	{
+		NazaraAssert(!m_shards.empty(), "host has not been created");
+
+		for (std::size_t i = 0; i < m_shards.size(); ++i)
+		{
+			Command command;
+			command.type = Command::Type::Broadcast;
+			command.channelId = channelId;
+			command.flags = flags;
+
+			if (i + 1 < m_shards.size())
+				command.packet.Reset(packet.GetNetCode(), packet.GetConstData() + NetPacket::HeaderSize, packet.GetDataSize());
+			else
+				command.packet = std::move(packet);
+
+			m_shards[i]->commands.Push(std::move(command));
+		}
+	}
+
+	/*!
+	* \brief Creates the shards and starts their threads
+	* \return True if every shard was created
+	*
+	* \param listenAddress Address to listen on, its port must be set explicitly when using more than one shard
+	* \param peerCountPerShard Maximum number of peers of each shard
+	* \param channelCount Number of channels per peer
+	* \param shardCount Number of shards, zero means one per logical thread of the processor
+	*/
+	bool ENetShardedHost::Create(const IpAddress& listenAddress, std::size_t peerCountPerShard, std::size_t channelCount, std::size_t shardCount)
+	{
+		NazaraAssert(listenAddress.IsValid(), "Invalid listening address");
+
+		Destroy();
+
+		if (shardCount == 0)
+			shardCount = std::max(Core::Instance()->GetHardwareInfo().GetCpuThreadCount(), 1u);
+
+#ifdef NAZARA_PLATFORM_WINDOWS
+		shardCount = 1;
+#endif
+
+		if (shardCount > 1 && listenAddress.GetPort() == 0)
+		{
+			NazaraError("listen port must be set explicitly when using multiple shards");
+			return false;
+		}
+
+		m_shards.reserve(shardCount);
+		for (std::size_t i = 0; i < shardCount; ++i)
+		{
+			std::unique_ptr<Shard> shard = std::make_unique<Shard>();
+			shard->index = SafeCast<UInt32>(i);
+			shard->peerGenerations.resize(peerCountPerShard, 0);
+
+			shard->host.EnablePortReuse(shardCount > 1);
+			if (!shard->host.Create(listenAddress, peerCountPerShard, channelCount))
+			{
+				NazaraError("failed to create shard #{0}", i);
+				m_shards.clear();
+				return false;
+			}
+
+			m_shards.push_back(std::move(shard));
+		}
+
+		m_running = true;
+		for (auto& shardPtr : m_shards)
+		{
+			Shard& shard = *shardPtr;
+			shard.thread = std::thread(&ENetShardedHost::ShardProc, this, std::ref(shard));
+			SetThreadName(shard.thread, ("NzENetShard #" + std::to_string(shard.index)).c_str());
+		}
+
+		return true;
+	}
+
+	/*!
+	* \brief Stops the shard threads and destroys their hosts, without notifying peers
+	*/
+	void ENetShardedHost::Destroy()
+	{
+		m_running = false;
+		for (auto& shardPtr : m_shards)
+		{
+			if (shardPtr->thread.joinable())
+				shardPtr->thread.join();
+		}
+
+		m_shards.clear();
+
+		Event event;
+		while (m_events.Pop(event));
+	}
+
+	/*!
+	* \brief Requests a peer to be disconnected, a Disconnect event will be received once it's done
+	*
+	* \param peer Peer to disconnect, ignored if it's no longer connected
+	* \param data User data sent to the peer
+	*/
+	void ENetShardedHost::Disconnect(const PeerHandle& peer, UInt32 data)
+	{
+		NazaraAssert(peer.shardIndex < m_shards.size(), "invalid shard index");
+
+		Command command;
+		command.type = Command::Type::Disconnect;
+		command.data = data;
+		command.generation = peer.generation;
+		command.peerId = peer.peerId;
+
+		m_shards[peer.shardIndex]->commands.Push(std::move(command));
+	}
+
+	/*!
+	* \brief Retrieves the next event of any shard, this must always be called from the same thread
+	* \return True if an event was retrieved
+	*
+	* \param event Event to fill
+	*/
+	bool ENetShardedHost::PollEvent(Event* event)
+	{
+		NazaraAssert(event, "invalid event");
+
+		return m_events.Pop(*event);
+	}
+
+	/*!
+	* \brief Queues a packet to be sent to a peer by its shard
+	*
+	* \param peer Peer to send the packet to, ignored if it's no longer connected
+	* \param channelId Channel to send the packet on
+	* \param flags Packet flags
+	* \param packet Packet to send
+	*/
+	void ENetShardedHost::Send(const PeerHandle& peer, UInt8 channelId, ENetPacketFlags flags, NetPacket&& packet)
+	{
+		NazaraAssert(peer.shardIndex < m_shards.size(), "invalid shard index");
+
+		Command command;
+		command.type = Command::Type::Send;
+		command.channelId = channelId;
+		command.flags = flags;
+		command.generation = peer.generation;
+		command.packet = std::move(packet);
+		command.peerId = peer.peerId;
+
+		m_shards[peer.shardIndex]->commands.Push(std::move(command));
+	}
+
+	void ENetShardedHost::HandleCommand(Shard& shard, Command& command)
+	{
+		switch (command.type)
+		{
+			case Command::Type::Broadcast:
+				shard.host.Broadcast(command.channelId, command.flags, std::move(command.packet));
+				break;
+
+			case Command::Type::Disconnect:
+			case Command::Type::Send:
+			{
+				ENetPeer* peer = shard.host.GetPeer(command.peerId);
+				if (!peer || shard.peerGenerations[command.peerId] != command.generation || !peer->IsConnected())
+					break; //< peer is gone
+
+				if (command.type == Command::Type::Disconnect)
+					peer->Disconnect(command.data);
+				else
+					peer->Send(command.channelId, command.flags, std::move(command.packet));
+
+				break;
+			}
+		}
+	}
+
+	void ENetShardedHost::ShardProc(Shard& shard)
+	{
+		ENetEvent enetEvent;
+		Command command;
+
+		while (m_running)
+		{
+			while (shard.commands.Pop(command))
+				HandleCommand(shard, command);
+
+			// Once an event occurred, keep servicing without waiting to retrieve all of them
+			UInt32 timeout = m_serviceTimeout;
+			while (shard.host.Service(&enetEvent, timeout) > 0)
+			{
+				timeout = 0;
+
+				ENetPeer* peer = enetEvent.peer;
+				UInt16 peerId = peer->GetPeerId();
+
+				Event event;
+				event.type = enetEvent.type;
+				event.address = peer->GetAddress();
+				event.channelId = enetEvent.channelId;
+				event.data = enetEvent.data;
+				event.peer.generation = shard.peerGenerations[peerId];
+				event.peer.shardIndex = shard.index;
+				event.peer.peerId = peerId;
+
+				switch (enetEvent.type)
+				{
+					case ENetEventType::Disconnect:
+					case ENetEventType::DisconnectTimeout:
+						shard.peerGenerations[peerId]++; //< invalidate handles to this peer
+						break;
+
+					case ENetEventType::Receive:
+						// Packet pools are owned by the shard, only move the packet data to the consumer thread
+						event.packet = std::move(enetEvent.packet->data);
+						enetEvent.packet.Reset();
+						break;
+
+					default:
+						break;
+				}
+
+				m_events.Push(std::move(event));
+			}
+		}
+	}
+}
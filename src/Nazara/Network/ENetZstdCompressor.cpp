@@ -0,0 +1,158 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Network/ENetZstdCompressor.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <zdict.h>
+#include <zstd.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <Nazara/Network/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup network
+	* \class Nz::ENetZstdCompressor
+	* \brief Network class that compresses ENet packets using Zstandard, optionally with a dictionary shared by both sides
+	*
+	* Game packets are usually too small to compress well on their own, a dictionary trained on captured traffic
+	* (see TrainDictionary) greatly improves the compression ratio. Both hosts must then use the same dictionary.
+	*/
+
+	/*!
+	* \brief Constructs a Zstd compressor
+	*
+	* \param compressionLevel Zstd compression level, low levels are advised for realtime traffic
+	* \param dictionary Dictionary to use for both compression and decompression, can be empty
+	*
+	* \remark Produces a std::runtime_error if zstd contexts or dictionaries couldn't be created
+	*/
+	ENetZstdCompressor::ENetZstdCompressor(int compressionLevel, const std::vector<UInt8>& dictionary) :
+	m_compressionContext(nullptr),
+	m_compressionDictionary(nullptr),
+	m_decompressionContext(nullptr),
+	m_decompressionDictionary(nullptr),
+	m_compressionLevel(compressionLevel)
+	{
+		m_compressionContext = ZSTD_createCCtx();
+		m_decompressionContext = ZSTD_createDCtx();
+		if (!m_compressionContext || !m_decompressionContext)
+		{
+			ZSTD_freeCCtx(m_compressionContext);
+			ZSTD_freeDCtx(m_decompressionContext);
+			throw std::runtime_error("failed to create zstd contexts");
+		}
+
+		if (!dictionary.empty())
+		{
+			m_compressionDictionary = ZSTD_createCDict(dictionary.data(), dictionary.size(), m_compressionLevel);
+			m_decompressionDictionary = ZSTD_createDDict(dictionary.data(), dictionary.size());
+			if (!m_compressionDictionary || !m_decompressionDictionary)
+			{
+				ZSTD_freeCDict(m_compressionDictionary);
+				ZSTD_freeDDict(m_decompressionDictionary);
+				ZSTD_freeCCtx(m_compressionContext);
+				ZSTD_freeDCtx(m_decompressionContext);
+				throw std::runtime_error("failed to create zstd dictionaries");
+			}
+		}
+	}
+
+	ENetZstdCompressor::~ENetZstdCompressor()
+	{
+		ZSTD_freeCDict(m_compressionDictionary);
+		ZSTD_freeDDict(m_decompressionDictionary);
+		ZSTD_freeCCtx(m_compressionContext);
+		ZSTD_freeDCtx(m_decompressionContext);
+	}
+
+	std::size_t ENetZstdCompressor::Compress(const ENetPeer* /*peer*/, const NetBuffer* buffers, std::size_t bufferCount, std::size_t totalInputSize, UInt8* output, std::size_t maxOutputSize)
+	{
+		if (totalInputSize == 0)
+			return 0;
+
+		// A compressed packet is only useful if it's smaller than the original one
+		std::size_t outputCapacity = std::min(maxOutputSize, totalInputSize - 1);
+		if (outputCapacity == 0)
+			return 0;
+
+		const void* input;
+		if (bufferCount == 1)
+			input = buffers[0].data;
+		else
+		{
+			m_inputBuffer.resize(totalInputSize);
+
+			std::size_t offset = 0;
+			for (std::size_t i = 0; i < bufferCount; ++i)
+			{
+				std::memcpy(&m_inputBuffer[offset], buffers[i].data, buffers[i].dataLength);
+				offset += buffers[i].dataLength;
+			}
+			NazaraAssert(offset == totalInputSize, "buffer sizes don't match total input size");
+
+			input = m_inputBuffer.data();
+		}
+
+		std::size_t compressedSize;
+		if (m_compressionDictionary)
+			compressedSize = ZSTD_compress_usingCDict(m_compressionContext, output, outputCapacity, input, totalInputSize, m_compressionDictionary);
+		else
+			compressedSize = ZSTD_compressCCtx(m_compressionContext, output, outputCapacity, input, totalInputSize, m_compressionLevel);
+
+		// Failing because the output doesn't fit is expected for incompressible data
+		if (ZSTD_isError(compressedSize))
+			return 0;
+
+		return compressedSize;
+	}
+
+	std::size_t ENetZstdCompressor::Decompress(const ENetPeer* /*peer*/, const UInt8* input, std::size_t inputSize, UInt8* output, std::size_t maxOutputSize)
+	{
+		std::size_t decompressedSize;
+		if (m_decompressionDictionary)
+			decompressedSize = ZSTD_decompress_usingDDict(m_decompressionContext, output, maxOutputSize, input, inputSize, m_decompressionDictionary);
+		else
+			decompressedSize = ZSTD_decompressDCtx(m_decompressionContext, output, maxOutputSize, input, inputSize);
+
+		if (ZSTD_isError(decompressedSize))
+			return 0;
+
+		return decompressedSize;
+	}
+
+	/*!
+	* \brief Trains a zstd dictionary on sample packets
+	* \return Dictionary data, or an empty vector if training failed
+	*
+	* \param samples Packets representative of the traffic to compress, zstd advises around a hundred times the dictionary size of samples
+	* \param maxDictionarySize Maximum size of the dictionary
+	*/
+	std::vector<UInt8> ENetZstdCompressor::TrainDictionary(const std::vector<std::vector<UInt8>>& samples, std::size_t maxDictionarySize)
+	{
+		std::vector<UInt8> sampleData;
+		std::vector<std::size_t> sampleSizes;
+		sampleSizes.reserve(samples.size());
+
+		for (const std::vector<UInt8>& sample : samples)
+		{
+			sampleData.insert(sampleData.end(), sample.begin(), sample.end());
+			sampleSizes.push_back(sample.size());
+		}
+
+		std::vector<UInt8> dictionary(maxDictionarySize);
+		std::size_t dictionarySize = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), sampleData.data(), sampleSizes.data(), SafeCast<unsigned int>(sampleSizes.size()));
+		if (ZDICT_isError(dictionarySize))
+		{
+			NazaraError("failed to train zstd dictionary: {0}", ZDICT_getErrorName(dictionarySize));
+			return {};
+		}
+
+		dictionary.resize(dictionarySize);
+		return dictionary;
+	}
+}
@@ -6,10 +6,14 @@
 #include <Nazara/Core/Algorithm.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/StringExt.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Network/Algorithm.hpp>
+#include <Nazara/Network/Network.hpp>
 #include <algorithm>
 #include <limits>
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
 
 #if defined(NAZARA_PLATFORM_WINDOWS)
 #include <Nazara/Network/Win32/IpAddressImpl.hpp>
@@ -23,6 +27,44 @@
 
 namespace Nz
 {
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		struct CachedHostname
+		{
+			std::vector<HostnameInfo> results;
+			Time expirationTime;
+		};
+
+		// Shared by every hostname resolution of the process (TcpClient, ENetHost, ...)
+		struct ResolveCache
+		{
+			std::mutex mutex;
+			std::unordered_map<std::string, CachedHostname> hostnames;
+			Time duration = Time::Seconds(60);
+		};
+
+		constexpr std::size_t ResolveCachePurgeThreshold = 256;
+
+		ResolveCache& GetResolveCache()
+		{
+			static ResolveCache cache;
+			return cache;
+		}
+
+		std::string BuildResolveCacheKey(NetProtocol protocol, const std::string& hostname, const std::string& service)
+		{
+			std::string key;
+			key.reserve(hostname.size() + service.size() + 3);
+			key += static_cast<char>('0' + UnderlyingCast(protocol));
+			key += ':';
+			key += service;
+			key += '@';
+			key += hostname;
+
+			return key;
+		}
+	}
+
 	/*!
 	* \ingroup network
 	* \class Nz::IpAddress
@@ -207,6 +249,39 @@ namespace Nz
 		return stream.str();
 	}
 
+	/*!
+	* \brief Clears the hostname resolution cache
+	*
+	* \remark This function is thread-safe
+	*
+	* \see SetResolveCacheDuration
+	*/
+	void IpAddress::ClearResolveCache()
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		ResolveCache& cache = GetResolveCache();
+
+		std::unique_lock lock(cache.mutex);
+		cache.hostnames.clear();
+	}
+
+	/*!
+	* \brief Returns how long successful hostname resolutions are kept in cache
+	* \return Cache duration
+	*
+	* \remark This function is thread-safe
+	*/
+	Time IpAddress::GetResolveCacheDuration()
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		ResolveCache& cache = GetResolveCache();
+
+		std::unique_lock lock(cache.mutex);
+		return cache.duration;
+	}
+
 	/*!
 	* \brief Resolves the address based on the IP
 	* \return Hostname of the address
@@ -227,10 +302,45 @@ namespace Nz
 		return hostname;
 	}
 
+	/*!
+	* \brief Resolves the address based on the IP without blocking
+	*
+	* The resolution runs on the resolver threads of the network module (see Network::GetResolverScheduler).
+	*
+	* \param address IP address to resolve
+	* \param callback Function called with the hostname, the service and the error once the address has been resolved
+	*
+	* \remark The callback is called from a resolver thread, or immediately if the network module isn't initialized
+	* \remark Produces a NazaraAssert if address is invalid
+	*/
+	void IpAddress::ResolveAddressAsync(const IpAddress& address, ResolveAddressCallback callback)
+	{
+		NazaraAssert(address.IsValid(), "Invalid address");
+		NazaraAssert(callback, "Invalid callback");
+
+		Network* network = Network::Instance();
+		if (!network)
+		{
+			callback({}, {}, ResolveError::NotInitialized);
+			return;
+		}
+
+		network->GetResolverScheduler().AddTask([address, callback = std::move(callback)]
+		{
+			ResolveError error = ResolveError::NoError;
+			std::string service;
+			std::string hostname = ResolveAddress(address, &service, &error);
+
+			callback(std::move(hostname), std::move(service), error);
+		});
+	}
+
 	/*!
 	* \brief Resolves the address based on the hostname
 	* \return Informations about the host: IP(s) of the address, names, ...
 	*
+	* Successful resolutions are cached for the cache duration (see SetResolveCacheDuration), so a cached hostname doesn't block.
+	*
 	* \param protocol Net protocol to use
 	* \param hostname Hostname to resolve
 	* \param service Specify the service used (http, ...)
@@ -240,9 +350,127 @@ namespace Nz
 	*/
 	std::vector<HostnameInfo> IpAddress::ResolveHostname(NetProtocol protocol, const std::string& hostname, const std::string& service, ResolveError* error)
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
 		NazaraAssert(protocol != NetProtocol::Unknown, "Invalid protocol");
 
-		return IpAddressImpl::ResolveHostname(protocol, hostname, service, error);
+		ResolveCache& cache = GetResolveCache();
+		std::string cacheKey = BuildResolveCacheKey(protocol, hostname, service);
+
+		{
+			std::unique_lock lock(cache.mutex);
+			if (auto it = cache.hostnames.find(cacheKey); it != cache.hostnames.end())
+			{
+				if (GetElapsedMilliseconds() < it->second.expirationTime)
+				{
+					if (error)
+						*error = ResolveError::NoError;
+
+					return it->second.results;
+				}
+
+				cache.hostnames.erase(it);
+			}
+		}
+
+		// Resolve without holding the lock, concurrent resolutions of the same hostname are harmless
+		std::vector<HostnameInfo> results = IpAddressImpl::ResolveHostname(protocol, hostname, service, error);
+		if (results.empty())
+			return results;
+
+		Time now = GetElapsedMilliseconds();
+
+		std::unique_lock lock(cache.mutex);
+		if (cache.duration <= Time::Zero())
+			return results;
+
+		if (cache.hostnames.size() >= ResolveCachePurgeThreshold)
+		{
+			for (auto it = cache.hostnames.begin(); it != cache.hostnames.end();)
+			{
+				if (now >= it->second.expirationTime)
+					it = cache.hostnames.erase(it);
+				else
+					++it;
+			}
+		}
+
+		CachedHostname& cachedHostname = cache.hostnames[std::move(cacheKey)];
+		cachedHostname.results = results;
+		cachedHostname.expirationTime = now + cache.duration;
+
+		return results;
+	}
+
+	/*!
+	* \brief Resolves the address based on the hostname without blocking
+	*
+	* Cached hostnames are returned immediately, other resolutions run on the resolver threads of the network module (see Network::GetResolverScheduler).
+	*
+	* \param protocol Net protocol to use
+	* \param hostname Hostname to resolve
+	* \param service Specify the service used (http, ...)
+	* \param callback Function called with the results and the error once the hostname has been resolved
+	*
+	* \remark The callback is called from a resolver thread, or immediately if the hostname was cached or if the network module isn't initialized
+	* \remark Produces a NazaraAssert if net protocol is set to unknown
+	*/
+	void IpAddress::ResolveHostnameAsync(NetProtocol protocol, std::string hostname, std::string service, ResolveHostnameCallback callback)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		NazaraAssert(protocol != NetProtocol::Unknown, "Invalid protocol");
+		NazaraAssert(callback, "Invalid callback");
+
+		ResolveCache& cache = GetResolveCache();
+
+		{
+			std::unique_lock lock(cache.mutex);
+			if (auto it = cache.hostnames.find(BuildResolveCacheKey(protocol, hostname, service)); it != cache.hostnames.end() && GetElapsedMilliseconds() < it->second.expirationTime)
+			{
+				std::vector<HostnameInfo> results = it->second.results;
+				lock.unlock();
+
+				callback(std::move(results), ResolveError::NoError);
+				return;
+			}
+		}
+
+		Network* network = Network::Instance();
+		if (!network)
+		{
+			callback({}, ResolveError::NotInitialized);
+			return;
+		}
+
+		network->GetResolverScheduler().AddTask([protocol, hostname = std::move(hostname), service = std::move(service), callback = std::move(callback)]
+		{
+			ResolveError error = ResolveError::NoError;
+			std::vector<HostnameInfo> results = ResolveHostname(protocol, hostname, service, &error);
+
+			callback(std::move(results), error);
+		});
+	}
+
+	/*!
+	* \brief Sets how long successful hostname resolutions are kept in cache
+	*
+	* The operating system resolver doesn't report record TTLs, this duration is used for every hostname instead (60 seconds by default).
+	* It also applies to the DNS cache of web requests (see WebService).
+	*
+	* \param duration Cache duration, a zero duration disables the cache
+	*
+	* \remark Already cached hostnames keep their expiration time, use ClearResolveCache to discard them
+	* \remark This function is thread-safe
+	*/
+	void IpAddress::SetResolveCacheDuration(Time duration)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		ResolveCache& cache = GetResolveCache();
+
+		std::unique_lock lock(cache.mutex);
+		cache.duration = duration;
 	}
 
 	IpAddress IpAddress::AnyIpV4(0, 0, 0, 0);
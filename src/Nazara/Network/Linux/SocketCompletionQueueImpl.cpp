@@ -0,0 +1,716 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Network/Linux/SocketCompletionQueueImpl.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Network/Posix/SocketImpl.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <Nazara/Network/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		// io_uring is used through system calls directly, it only requires the kernel headers
+		int IoUringSetup(unsigned int entries, io_uring_params* params)
+		{
+			return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+		}
+
+		int IoUringEnter(int ringHandle, unsigned int toSubmit, unsigned int minComplete, unsigned int flags, const void* arg, std::size_t argSize)
+		{
+			return static_cast<int>(syscall(__NR_io_uring_enter, ringHandle, toSubmit, minComplete, flags, arg, argSize));
+		}
+
+		int IoUringRegister(int ringHandle, unsigned int opcode, const void* arg, unsigned int argCount)
+		{
+			return static_cast<int>(syscall(__NR_io_uring_register, ringHandle, opcode, arg, argCount));
+		}
+
+		template<typename T>
+		T LoadAcquire(const T* ptr)
+		{
+			return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+		}
+
+		template<typename T>
+		void StoreRelease(T* ptr, T value)
+		{
+			__atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+		}
+	}
+
+	SocketCompletionQueueImpl::SocketCompletionQueueImpl() :
+	m_bufferSize(0),
+	m_bufferRing(nullptr),
+	m_completionEntries(nullptr),
+	m_submissionEntries(nullptr),
+	m_submissionRing(MAP_FAILED),
+	m_bufferRingSize(0),
+	m_submissionEntriesSize(0),
+	m_submissionRingSize(0),
+	m_nextOperationId(1),
+	m_submittedTail(0),
+	m_submissionLocalTail(0),
+	m_bufferMask(0),
+	m_bufferRingTail(0),
+	m_ringHandle(-1)
+	{
+	}
+
+	SocketCompletionQueueImpl::~SocketCompletionQueueImpl()
+	{
+		Release();
+	}
+
+	bool SocketCompletionQueueImpl::Create(std::size_t receiveBufferSize, std::size_t receiveBufferCount)
+	{
+		io_uring_params params;
+		std::memset(&params, 0, sizeof(params));
+		params.flags = IORING_SETUP_CQSIZE;
+		params.cq_entries = SubmissionQueueSize * 4; //< multishot operations can post a lot of completions
+
+		m_ringHandle = IoUringSetup(SubmissionQueueSize, &params);
+		if (m_ringHandle < 0)
+		{
+			NazaraError("failed to create io_uring instance (errno {0}: {1})", errno, Error::GetLastSystemError());
+			return false;
+		}
+
+		constexpr UInt32 RequiredFeatures = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG;
+		if ((params.features & RequiredFeatures) != RequiredFeatures)
+		{
+			NazaraError("io_uring lacks required features (Linux 5.11 or newer is required)");
+			Release();
+			return false;
+		}
+
+		// Both rings share the same mapping (IORING_FEAT_SINGLE_MMAP)
+		std::size_t submissionRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+		std::size_t completionRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+		m_submissionRingSize = std::max(submissionRingSize, completionRingSize);
+
+		m_submissionRing = mmap(nullptr, m_submissionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringHandle, IORING_OFF_SQ_RING);
+		if (m_submissionRing == MAP_FAILED)
+		{
+			NazaraError("failed to map io_uring rings (errno {0}: {1})", errno, Error::GetLastSystemError());
+			Release();
+			return false;
+		}
+
+		m_submissionEntriesSize = params.sq_entries * sizeof(io_uring_sqe);
+		void* submissionEntries = mmap(nullptr, m_submissionEntriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringHandle, IORING_OFF_SQES);
+		if (submissionEntries == MAP_FAILED)
+		{
+			NazaraError("failed to map io_uring submission entries (errno {0}: {1})", errno, Error::GetLastSystemError());
+			Release();
+			return false;
+		}
+		m_submissionEntries = static_cast<io_uring_sqe*>(submissionEntries);
+
+		UInt8* submissionRing = static_cast<UInt8*>(m_submissionRing);
+		m_submissionHead = reinterpret_cast<unsigned int*>(submissionRing + params.sq_off.head);
+		m_submissionTail = reinterpret_cast<unsigned int*>(submissionRing + params.sq_off.tail);
+		m_submissionMask = *reinterpret_cast<unsigned int*>(submissionRing + params.sq_off.ring_mask);
+		m_submissionArray = reinterpret_cast<unsigned int*>(submissionRing + params.sq_off.array);
+		m_submissionEntryCount = params.sq_entries;
+		m_submissionLocalTail = *m_submissionTail;
+		m_submittedTail = m_submissionLocalTail;
+
+		m_completionHead = reinterpret_cast<unsigned int*>(submissionRing + params.cq_off.head);
+		m_completionTail = reinterpret_cast<unsigned int*>(submissionRing + params.cq_off.tail);
+		m_completionMask = *reinterpret_cast<unsigned int*>(submissionRing + params.cq_off.ring_mask);
+		m_completionEntries = reinterpret_cast<io_uring_cqe*>(submissionRing + params.cq_off.cqes);
+
+		// Register receive buffers, the kernel picks one of them for every completed receive
+		std::size_t bufferCount = 1;
+		while (bufferCount < receiveBufferCount && bufferCount < 32768)
+			bufferCount *= 2;
+
+		m_bufferRingSize = bufferCount * sizeof(io_uring_buf);
+		void* bufferRing = mmap(nullptr, m_bufferRingSize, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+		if (bufferRing == MAP_FAILED)
+		{
+			NazaraError("failed to allocate io_uring buffer ring (errno {0}: {1})", errno, Error::GetLastSystemError());
+			Release();
+			return false;
+		}
+		m_bufferRing = static_cast<io_uring_buf*>(bufferRing);
+
+		io_uring_buf_reg bufferRegistration;
+		std::memset(&bufferRegistration, 0, sizeof(bufferRegistration));
+		bufferRegistration.ring_addr = reinterpret_cast<UInt64>(m_bufferRing);
+		bufferRegistration.ring_entries = SafeCast<UInt32>(bufferCount);
+		bufferRegistration.bgid = BufferGroupId;
+
+		if (IoUringRegister(m_ringHandle, IORING_REGISTER_PBUF_RING, &bufferRegistration, 1) < 0)
+		{
+			NazaraError("failed to register io_uring buffer ring, Linux 5.19 or newer is required (errno {0}: {1})", errno, Error::GetLastSystemError());
+			Release();
+			return false;
+		}
+
+		m_bufferSize = receiveBufferSize;
+		m_bufferData.resize(bufferCount * receiveBufferSize);
+		m_bufferMask = SafeCast<UInt16>(bufferCount - 1);
+		m_bufferRingTail = 0;
+
+		for (std::size_t i = 0; i < bufferCount; ++i)
+			RecycleBuffer(SafeCast<UInt16>(i));
+
+		return true;
+	}
+
+	unsigned int SocketCompletionQueueImpl::Process(int msTimeout, SocketError* error)
+	{
+		// Submit pending operations and wait for at least one of them to complete
+		bool hasCompletions = (*m_completionHead != LoadAcquire(m_completionTail));
+		if (!Enter(!hasCompletions && msTimeout != 0, msTimeout, error))
+			return 0;
+
+		unsigned int completionCount = 0;
+
+		unsigned int head = *m_completionHead;
+		unsigned int tail = LoadAcquire(m_completionTail);
+		for (; head != tail; ++head)
+		{
+			const io_uring_cqe& completionEntry = m_completionEntries[head & m_completionMask];
+			UInt64 userData = completionEntry.user_data;
+			Int32 result = completionEntry.res;
+			UInt32 flags = completionEntry.flags;
+
+			// Give the entry back to the kernel before calling callbacks
+			StoreRelease(m_completionHead, head + 1);
+
+			if (userData != 0)
+			{
+				HandleCompletion(userData, result, flags);
+				completionCount++;
+			}
+		}
+
+		// Resume receives which ran out of buffers, as callbacks gave them back
+		if (!m_stalledReceives.empty())
+		{
+			std::vector<UInt64> stalledReceives = std::move(m_stalledReceives);
+			m_stalledReceives.clear();
+
+			for (UInt64 operationId : stalledReceives)
+			{
+				auto it = m_operations.find(operationId);
+				if (it == m_operations.end())
+					continue;
+
+				if (it->second.isCancelled || !SubmitReceive(operationId, it->second))
+					m_operations.erase(it);
+			}
+		}
+
+		// Submit operations queued by callbacks
+		if (!Enter(false, 0, error))
+			return completionCount;
+
+		if (error)
+			*error = SocketError::NoError;
+
+		return completionCount;
+	}
+
+	bool SocketCompletionQueueImpl::Send(SocketHandle socket, const void* data, std::size_t size, SendCallback callback)
+	{
+		UInt64 operationId = AllocateOperation(OperationType::Send, socket);
+
+		Operation& operation = m_operations[operationId];
+		operation.sendCallback = std::move(callback);
+		operation.sendData = static_cast<const UInt8*>(data);
+		operation.sendSize = size;
+
+		SocketData& socketData = m_sockets[socket];
+		socketData.sendOperations.push_back(operationId);
+		if (socketData.sendOperations.size() > 1)
+			return true; //< will be submitted once previous sends are done
+
+		if (!SubmitSend(operationId, operation))
+		{
+			socketData.sendOperations.pop_back();
+			m_operations.erase(operationId);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool SocketCompletionQueueImpl::StartAccepting(SocketHandle socket, AcceptCallback callback)
+	{
+		SocketData& socketData = m_sockets[socket];
+		NazaraAssert(socketData.acceptOperation == 0, "socket is already accepting");
+
+		UInt64 operationId = AllocateOperation(OperationType::Accept, socket);
+
+		Operation& operation = m_operations[operationId];
+		operation.acceptCallback = std::move(callback);
+
+		if (!SubmitAccept(operationId, operation))
+		{
+			m_operations.erase(operationId);
+			return false;
+		}
+
+		socketData.acceptOperation = operationId;
+		return true;
+	}
+
+	bool SocketCompletionQueueImpl::StartReceiving(SocketHandle socket, ReceiveCallback callback)
+	{
+		SocketData& socketData = m_sockets[socket];
+		NazaraAssert(socketData.receiveOperation == 0, "socket is already receiving");
+
+		UInt64 operationId = AllocateOperation(OperationType::Receive, socket);
+
+		Operation& operation = m_operations[operationId];
+		operation.receiveCallback = std::move(callback);
+
+		if (!SubmitReceive(operationId, operation))
+		{
+			m_operations.erase(operationId);
+			return false;
+		}
+
+		socketData.receiveOperation = operationId;
+		return true;
+	}
+
+	void SocketCompletionQueueImpl::Stop(SocketHandle socket)
+	{
+		auto socketIt = m_sockets.find(socket);
+		if (socketIt == m_sockets.end())
+			return;
+
+		SocketData& socketData = socketIt->second;
+
+		// Submitted operations are freed once the kernel reports their completion
+		auto CancelOperation = [&](UInt64 operationId, bool isSubmitted)
+		{
+			auto it = m_operations.find(operationId);
+			if (it == m_operations.end())
+				return;
+
+			if (isSubmitted)
+			{
+				it->second.isCancelled = true;
+				SubmitCancel(operationId);
+			}
+			else
+				m_operations.erase(it);
+		};
+
+		if (socketData.acceptOperation != 0)
+			CancelOperation(socketData.acceptOperation, true);
+
+		if (socketData.receiveOperation != 0)
+		{
+			bool isStalled = (std::find(m_stalledReceives.begin(), m_stalledReceives.end(), socketData.receiveOperation) != m_stalledReceives.end());
+			CancelOperation(socketData.receiveOperation, !isStalled);
+		}
+
+		for (std::size_t i = 0; i < socketData.sendOperations.size(); ++i)
+			CancelOperation(socketData.sendOperations[i], i == 0);
+
+		m_sockets.erase(socketIt);
+
+		// Submit cancellations now, as the socket is likely to be closed right after
+		Enter(false, 0, nullptr);
+	}
+
+	UInt64 SocketCompletionQueueImpl::AllocateOperation(OperationType type, SocketHandle socket)
+	{
+		UInt64 operationId = m_nextOperationId++;
+
+		Operation& operation = m_operations[operationId];
+		operation.type = type;
+		operation.socket = socket;
+
+		return operationId;
+	}
+
+	bool SocketCompletionQueueImpl::Enter(bool waitForCompletion, int msTimeout, SocketError* error)
+	{
+		unsigned int toSubmit = m_submissionLocalTail - m_submittedTail;
+		if (toSubmit == 0 && !waitForCompletion)
+			return true;
+
+		unsigned int flags = 0;
+		unsigned int minComplete = 0;
+		if (waitForCompletion)
+		{
+			flags |= IORING_ENTER_GETEVENTS;
+			minComplete = 1;
+		}
+
+		int result;
+		if (waitForCompletion && msTimeout > 0)
+		{
+			__kernel_timespec timeout;
+			timeout.tv_sec = msTimeout / 1000;
+			timeout.tv_nsec = (msTimeout % 1000) * 1'000'000;
+
+			io_uring_getevents_arg args;
+			std::memset(&args, 0, sizeof(args));
+			args.sigmask_sz = _NSIG / 8;
+			args.ts = reinterpret_cast<UInt64>(&timeout);
+
+			result = IoUringEnter(m_ringHandle, toSubmit, minComplete, flags | IORING_ENTER_EXT_ARG, &args, sizeof(args));
+		}
+		else
+			result = IoUringEnter(m_ringHandle, toSubmit, minComplete, flags, nullptr, _NSIG / 8);
+
+		if (result < 0)
+		{
+			int errorCode = errno;
+			if (errorCode == ETIME || errorCode == EINTR || errorCode == EAGAIN || errorCode == EBUSY)
+			{
+				// Nothing completed before the timeout, or the kernel is busy and will retry submission on next call
+				if (error)
+					*error = SocketError::NoError;
+
+				return true;
+			}
+
+			if (error)
+				*error = SocketImpl::TranslateErrorToSocketError(errorCode);
+
+			return false;
+		}
+
+		m_submittedTail += static_cast<unsigned int>(result);
+		return true;
+	}
+
+	void SocketCompletionQueueImpl::FinishSend(std::unordered_map<UInt64, Operation>::iterator operationIt, SocketError error)
+	{
+		UInt64 operationId = operationIt->first;
+		SocketHandle socket = operationIt->second.socket;
+		std::size_t sentSize = operationIt->second.sentSize;
+		SendCallback callback = std::move(operationIt->second.sendCallback);
+		m_operations.erase(operationIt);
+
+		auto socketIt = m_sockets.find(socket);
+		if (socketIt != m_sockets.end())
+		{
+			std::deque<UInt64>& sendOperations = socketIt->second.sendOperations;
+			NazaraAssert(!sendOperations.empty() && sendOperations.front() == operationId, "unexpected send completion");
+			sendOperations.pop_front();
+
+			// Submit the next send of this socket
+			while (!sendOperations.empty())
+			{
+				UInt64 nextOperationId = sendOperations.front();
+				auto nextIt = m_operations.find(nextOperationId);
+				if (nextIt != m_operations.end() && SubmitSend(nextOperationId, nextIt->second))
+					break;
+
+				if (nextIt != m_operations.end())
+				{
+					SendCallback nextCallback = std::move(nextIt->second.sendCallback);
+					m_operations.erase(nextIt);
+					sendOperations.pop_front();
+
+					if (nextCallback)
+						nextCallback(0, SocketError::ResourceError);
+				}
+				else
+					sendOperations.pop_front();
+			}
+		}
+
+		if (callback)
+			callback(sentSize, error);
+	}
+
+	io_uring_sqe* SocketCompletionQueueImpl::GetSubmissionEntry()
+	{
+		if (m_submissionLocalTail - LoadAcquire(m_submissionHead) >= m_submissionEntryCount)
+		{
+			// Submission queue is full, submit it to make room
+			Enter(false, 0, nullptr);
+			if (m_submissionLocalTail - LoadAcquire(m_submissionHead) >= m_submissionEntryCount)
+			{
+				NazaraError("io_uring submission queue is full");
+				return nullptr;
+			}
+		}
+
+		unsigned int index = m_submissionLocalTail & m_submissionMask;
+
+		io_uring_sqe* submissionEntry = &m_submissionEntries[index];
+		std::memset(submissionEntry, 0, sizeof(io_uring_sqe));
+
+		m_submissionArray[index] = index;
+		m_submissionLocalTail++;
+
+		// The entry is only published once filled, entries are submitted on the next Enter call so publishing it here is fine
+		// as long as callers fill it right away (no system call happens in between)
+		return submissionEntry;
+	}
+
+	void SocketCompletionQueueImpl::HandleCompletion(UInt64 userData, Int32 result, UInt32 flags)
+	{
+		std::optional<UInt16> bufferId;
+		if (flags & IORING_CQE_F_BUFFER)
+			bufferId = SafeCast<UInt16>(flags >> IORING_CQE_BUFFER_SHIFT);
+
+		auto it = m_operations.find(userData);
+		if (it == m_operations.end())
+		{
+			if (bufferId)
+				RecycleBuffer(*bufferId);
+
+			return;
+		}
+
+		Operation& operation = it->second;
+		bool hasMore = (flags & IORING_CQE_F_MORE) != 0;
+
+		switch (operation.type)
+		{
+			case OperationType::Accept:
+			{
+				if (operation.isCancelled)
+				{
+					if (result >= 0)
+						SocketImpl::Close(result);
+				}
+				else if (result >= 0)
+				{
+					IpAddress peerAddress = SocketImpl::QueryPeerAddress(result);
+					operation.acceptCallback(result, peerAddress);
+				}
+				else if (!hasMore && result != -ENFILE && result != -EMFILE && result != -ENOBUFS && result != -ENOMEM)
+				{
+					NazaraError("failed to accept client (errno {0})", -result);
+
+					auto socketIt = m_sockets.find(operation.socket);
+					if (socketIt != m_sockets.end())
+						socketIt->second.acceptOperation = 0;
+
+					m_operations.erase(it);
+					return;
+				}
+
+				// Callbacks may have submitted operations, invalidating the iterator
+				if (!hasMore)
+				{
+					if (operation.isCancelled || !SubmitAccept(userData, operation))
+						m_operations.erase(userData);
+				}
+
+				break;
+			}
+
+			case OperationType::Receive:
+			{
+				if (operation.isCancelled)
+				{
+					if (bufferId)
+						RecycleBuffer(*bufferId);
+
+					if (!hasMore)
+						m_operations.erase(it);
+
+					break;
+				}
+
+				if (result > 0)
+				{
+					NazaraAssert(bufferId, "receive completed without a buffer");
+					operation.receiveCallback(&m_bufferData[*bufferId * m_bufferSize], SafeCast<std::size_t>(result), SocketError::NoError);
+					RecycleBuffer(*bufferId);
+
+					if (!hasMore)
+					{
+						// The kernel may stop a multishot receive at any time, rearm it
+						if (operation.isCancelled || !SubmitReceive(userData, operation))
+							m_operations.erase(userData);
+					}
+				}
+				else if (result == -ENOBUFS)
+				{
+					if (!hasMore)
+						m_stalledReceives.push_back(userData);
+				}
+				else
+				{
+					if (bufferId)
+						RecycleBuffer(*bufferId);
+
+					// Connection closed or failed, receiving stops
+					ReceiveCallback callback = std::move(operation.receiveCallback);
+					if (!hasMore)
+					{
+						auto socketIt = m_sockets.find(operation.socket);
+						if (socketIt != m_sockets.end())
+							socketIt->second.receiveOperation = 0;
+
+						m_operations.erase(it);
+					}
+
+					if (callback)
+						callback(nullptr, 0, (result == 0) ? SocketError::ConnectionClosed : SocketImpl::TranslateErrorToSocketError(-result));
+				}
+
+				break;
+			}
+
+			case OperationType::Send:
+			{
+				if (operation.isCancelled)
+				{
+					m_operations.erase(it);
+					break;
+				}
+
+				if (result < 0)
+				{
+					FinishSend(it, SocketImpl::TranslateErrorToSocketError(-result));
+					break;
+				}
+
+				operation.sentSize += SafeCast<std::size_t>(result);
+				if (result > 0 && operation.sentSize < operation.sendSize)
+				{
+					// Partial send, send the remaining data
+					if (SubmitSend(userData, operation))
+						break;
+
+					FinishSend(it, SocketError::ResourceError);
+					break;
+				}
+
+				FinishSend(it, (operation.sentSize == operation.sendSize) ? SocketError::NoError : SocketError::ConnectionClosed);
+				break;
+			}
+		}
+	}
+
+	void SocketCompletionQueueImpl::RecycleBuffer(UInt16 bufferId)
+	{
+		io_uring_buf& buffer = m_bufferRing[m_bufferRingTail & m_bufferMask];
+		buffer.addr = reinterpret_cast<UInt64>(&m_bufferData[bufferId * m_bufferSize]);
+		buffer.len = SafeCast<UInt32>(m_bufferSize);
+		buffer.bid = bufferId;
+
+		m_bufferRingTail++;
+		// The ring tail overlays the reserved field of the first entry (io_uring_buf_ring::bufs is not used as it is misplaced in C++)
+		StoreRelease(&m_bufferRing[0].resv, m_bufferRingTail);
+	}
+
+	void SocketCompletionQueueImpl::Release()
+	{
+		// Closing the ring cancels every pending operation
+		if (m_ringHandle >= 0)
+		{
+			close(m_ringHandle);
+			m_ringHandle = -1;
+		}
+
+		if (m_bufferRing)
+		{
+			munmap(m_bufferRing, m_bufferRingSize);
+			m_bufferRing = nullptr;
+		}
+
+		if (m_submissionEntries)
+		{
+			munmap(m_submissionEntries, m_submissionEntriesSize);
+			m_submissionEntries = nullptr;
+		}
+
+		if (m_submissionRing != MAP_FAILED)
+		{
+			munmap(m_submissionRing, m_submissionRingSize);
+			m_submissionRing = MAP_FAILED;
+		}
+
+		m_operations.clear();
+		m_sockets.clear();
+		m_stalledReceives.clear();
+	}
+
+	bool SocketCompletionQueueImpl::SubmitAccept(UInt64 operationId, const Operation& operation)
+	{
+		io_uring_sqe* submissionEntry = GetSubmissionEntry();
+		if (!submissionEntry)
+			return false;
+
+		submissionEntry->opcode = IORING_OP_ACCEPT;
+		submissionEntry->fd = operation.socket;
+		submissionEntry->ioprio = IORING_ACCEPT_MULTISHOT;
+		submissionEntry->accept_flags = SOCK_CLOEXEC;
+		submissionEntry->user_data = operationId;
+
+		StoreRelease(m_submissionTail, m_submissionLocalTail);
+		return true;
+	}
+
+	void SocketCompletionQueueImpl::SubmitCancel(UInt64 operationId)
+	{
+		io_uring_sqe* submissionEntry = GetSubmissionEntry();
+		if (!submissionEntry)
+			return; //< the operation will complete at some point anyway
+
+		submissionEntry->opcode = IORING_OP_ASYNC_CANCEL;
+		submissionEntry->fd = -1;
+		submissionEntry->addr = operationId;
+		submissionEntry->user_data = 0;
+
+		StoreRelease(m_submissionTail, m_submissionLocalTail);
+	}
+
+	bool SocketCompletionQueueImpl::SubmitReceive(UInt64 operationId, const Operation& operation)
+	{
+		io_uring_sqe* submissionEntry = GetSubmissionEntry();
+		if (!submissionEntry)
+			return false;
+
+		submissionEntry->opcode = IORING_OP_RECV;
+		submissionEntry->fd = operation.socket;
+		submissionEntry->ioprio = IORING_RECV_MULTISHOT;
+		submissionEntry->flags = IOSQE_BUFFER_SELECT;
+		submissionEntry->buf_group = BufferGroupId;
+		submissionEntry->user_data = operationId;
+
+		StoreRelease(m_submissionTail, m_submissionLocalTail);
+		return true;
+	}
+
+	bool SocketCompletionQueueImpl::SubmitSend(UInt64 operationId, const Operation& operation)
+	{
+		io_uring_sqe* submissionEntry = GetSubmissionEntry();
+		if (!submissionEntry)
+			return false;
+
+		std::size_t remainingSize = operation.sendSize - operation.sentSize;
+
+		submissionEntry->opcode = IORING_OP_SEND;
+		submissionEntry->fd = operation.socket;
+		submissionEntry->addr = reinterpret_cast<UInt64>(operation.sendData + operation.sentSize);
+		submissionEntry->len = SafeCast<UInt32>(std::min<std::size_t>(remainingSize, std::numeric_limits<Int32>::max()));
+		submissionEntry->msg_flags = MSG_NOSIGNAL;
+		submissionEntry->user_data = operationId;
+
+		StoreRelease(m_submissionTail, m_submissionLocalTail);
+		return true;
+	}
+}
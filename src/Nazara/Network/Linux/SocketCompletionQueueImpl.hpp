@@ -0,0 +1,122 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NETWORK_LINUX_SOCKETCOMPLETIONQUEUEIMPL_HPP
+#define NAZARA_NETWORK_LINUX_SOCKETCOMPLETIONQUEUEIMPL_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Network/IpAddress.hpp>
+#include <Nazara/Network/SocketCompletionQueue.hpp>
+#include <Nazara/Network/SocketHandle.hpp>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+struct io_uring_buf;
+struct io_uring_cqe;
+struct io_uring_sqe;
+
+namespace Nz
+{
+	class SocketCompletionQueueImpl
+	{
+		public:
+			using AcceptCallback = std::function<void(SocketHandle handle, const IpAddress& address)>;
+			using ReceiveCallback = SocketCompletionQueue::ReceiveCallback;
+			using SendCallback = SocketCompletionQueue::SendCallback;
+
+			SocketCompletionQueueImpl();
+			SocketCompletionQueueImpl(const SocketCompletionQueueImpl&) = delete;
+			SocketCompletionQueueImpl(SocketCompletionQueueImpl&&) = delete;
+			~SocketCompletionQueueImpl();
+
+			bool Create(std::size_t receiveBufferSize, std::size_t receiveBufferCount);
+
+			unsigned int Process(int msTimeout, SocketError* error);
+
+			bool Send(SocketHandle socket, const void* data, std::size_t size, SendCallback callback);
+
+			bool StartAccepting(SocketHandle socket, AcceptCallback callback);
+			bool StartReceiving(SocketHandle socket, ReceiveCallback callback);
+			void Stop(SocketHandle socket);
+
+			SocketCompletionQueueImpl& operator=(const SocketCompletionQueueImpl&) = delete;
+			SocketCompletionQueueImpl& operator=(SocketCompletionQueueImpl&&) = delete;
+
+		private:
+			enum class OperationType
+			{
+				Accept,
+				Receive,
+				Send
+			};
+
+			struct Operation
+			{
+				AcceptCallback acceptCallback;
+				ReceiveCallback receiveCallback;
+				SendCallback sendCallback;
+				OperationType type;
+				SocketHandle socket;
+				const UInt8* sendData = nullptr;
+				std::size_t sendSize = 0;
+				std::size_t sentSize = 0;
+				bool isCancelled = false;
+			};
+
+			struct SocketData
+			{
+				std::deque<UInt64> sendOperations; //< only the first one is submitted, to keep the stream in order
+				UInt64 acceptOperation = 0;
+				UInt64 receiveOperation = 0;
+			};
+
+			UInt64 AllocateOperation(OperationType type, SocketHandle socket);
+			bool Enter(bool waitForCompletion, int msTimeout, SocketError* error);
+			void FinishSend(std::unordered_map<UInt64, Operation>::iterator operationIt, SocketError error);
+			io_uring_sqe* GetSubmissionEntry();
+			void HandleCompletion(UInt64 userData, Int32 result, UInt32 flags);
+			void RecycleBuffer(UInt16 bufferId);
+			void Release();
+			bool SubmitAccept(UInt64 operationId, const Operation& operation);
+			void SubmitCancel(UInt64 operationId);
+			bool SubmitReceive(UInt64 operationId, const Operation& operation);
+			bool SubmitSend(UInt64 operationId, const Operation& operation);
+
+			static constexpr UInt16 BufferGroupId = 0;
+			static constexpr unsigned int SubmissionQueueSize = 1024;
+
+			std::unordered_map<SocketHandle, SocketData> m_sockets;
+			std::unordered_map<UInt64, Operation> m_operations;
+			std::vector<UInt64> m_stalledReceives; //< multishot receives which ran out of buffers
+			std::vector<UInt8> m_bufferData;
+			std::size_t m_bufferSize;
+			io_uring_buf* m_bufferRing;
+			io_uring_cqe* m_completionEntries;
+			io_uring_sqe* m_submissionEntries;
+			void* m_submissionRing; //< also holds the completion ring
+			std::size_t m_bufferRingSize;
+			std::size_t m_submissionEntriesSize;
+			std::size_t m_submissionRingSize;
+			UInt64 m_nextOperationId;
+			unsigned int* m_completionHead;
+			unsigned int* m_completionTail;
+			unsigned int* m_submissionArray;
+			unsigned int* m_submissionHead;
+			unsigned int* m_submissionTail;
+			unsigned int m_completionMask;
+			unsigned int m_submissionEntryCount;
+			unsigned int m_submissionMask;
+			unsigned int m_submittedTail;
+			unsigned int m_submissionLocalTail;
+			UInt16 m_bufferMask;
+			UInt16 m_bufferRingTail;
+			int m_ringHandle;
+	};
+}
+
+#endif // NAZARA_NETWORK_LINUX_SOCKETCOMPLETIONQUEUEIMPL_HPP
@@ -6,6 +6,7 @@
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/StringExt.hpp>
 #include <Nazara/Network/Posix/SocketImpl.hpp>
+#include <algorithm>
 #include <cstring>
 #include <unistd.h>
 #include <Nazara/Network/Debug.hpp>
@@ -24,6 +25,10 @@ namespace Nz
 
 	void SocketPollerImpl::Clear()
 	{
+		// epoll events reference socket data, sockets have to be removed from it
+		for (auto&& [socket, socketData] : m_sockets)
+			epoll_ctl(m_handle, EPOLL_CTL_DEL, socket, nullptr);
+
 		m_readyToReadSockets.clear();
 		m_readyToWriteSockets.clear();
 		m_sockets.clear();
@@ -44,14 +49,18 @@ namespace Nz
 		return m_sockets.count(socket) != 0;
 	}
 
-	bool SocketPollerImpl::RegisterSocket(SocketHandle socket, SocketPollEventFlags eventFlags)
+	bool SocketPollerImpl::RegisterSocket(SocketHandle socket, SocketPollEventFlags eventFlags, void* userdata, SocketPollMode pollMode)
 	{
 		NazaraAssert(!IsRegistered(socket), "Socket is already registered");
 
+		SocketData& socketData = m_sockets[socket];
+		socketData.socket = socket;
+		socketData.userdata = userdata;
+
 		epoll_event entry;
 		std::memset(&entry, 0, sizeof(epoll_event));
 
-		entry.data.fd = socket;
+		entry.data.ptr = &socketData;
 
 		if (eventFlags & SocketPollEvent::Read)
 			entry.events |= EPOLLIN;
@@ -59,14 +68,16 @@ namespace Nz
 		if (eventFlags & SocketPollEvent::Write)
 			entry.events |= EPOLLOUT;
 
+		if (pollMode == SocketPollMode::EdgeTriggered)
+			entry.events |= EPOLLET;
+
 		if (epoll_ctl(m_handle, EPOLL_CTL_ADD, socket, &entry) != 0)
 		{
 			NazaraError("failed to add socket to epoll structure (errno {0}: {1})", errno, Error::GetLastSystemError());
+			m_sockets.erase(socket);
 			return false;
 		}
 
-		m_sockets.insert(socket);
-
 		return true;
 	}
 
@@ -84,20 +95,9 @@ namespace Nz
 
 	unsigned int SocketPollerImpl::Wait(int msTimeout, SocketError* error)
 	{
-		int activeSockets;
-
-		// Reset status of sockets
-		m_events.resize(m_sockets.size());
-		std::memset(m_events.data(), 0, m_events.size() * sizeof(epoll_event));
-
-		activeSockets = epoll_wait(m_handle, m_events.data(), static_cast<int>(m_events.size()), static_cast<int>(msTimeout));
-		if (activeSockets == -1)
-		{
-			if (error)
-				*error = SocketImpl::TranslateErrorToSocketError(errno);
-
+		int activeSockets = WaitForEvents(msTimeout, m_sockets.size(), error);
+		if (activeSockets < 0)
 			return 0;
-		}
 
 		m_readyToReadSockets.clear();
 		m_readyToWriteSockets.clear();
@@ -106,22 +106,70 @@ namespace Nz
 			int socketCount = activeSockets;
 			for (int i = 0; i < socketCount; ++i)
 			{
+				SocketHandle socket = static_cast<const SocketData*>(m_events[i].data.ptr)->socket;
 				if (m_events[i].events & (EPOLLIN | EPOLLOUT | EPOLLHUP | EPOLLERR))
 				{
 					if (m_events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
-						m_readyToReadSockets.insert(m_events[i].data.fd);
+						m_readyToReadSockets.insert(socket);
 
 					if (m_events[i].events & (EPOLLOUT | EPOLLERR))
-						m_readyToWriteSockets.insert(m_events[i].data.fd);
+						m_readyToWriteSockets.insert(socket);
 				}
 				else
 				{
-					NazaraWarning("Descriptor " + NumberToString(m_events[i].data.fd) + " was returned by epoll without EPOLLIN nor EPOLLOUT flags (events: 0x" + NumberToString(m_events[i].events, 16) + ')');
+					NazaraWarning("Descriptor " + NumberToString(socket) + " was returned by epoll without EPOLLIN nor EPOLLOUT flags (events: 0x" + NumberToString(m_events[i].events, 16) + ')');
 					activeSockets--;
 				}
 			}
 		}
 
+		return activeSockets;
+	}
+
+	unsigned int SocketPollerImpl::Wait(int msTimeout, SocketPollerEvent* events, std::size_t maxEventCount, SocketError* error)
+	{
+		int activeSockets = WaitForEvents(msTimeout, maxEventCount, error);
+		if (activeSockets < 0)
+			return 0;
+
+		unsigned int eventCount = 0;
+		for (int i = 0; i < activeSockets; ++i)
+		{
+			const SocketData* socketData = static_cast<const SocketData*>(m_events[i].data.ptr);
+
+			SocketPollEventFlags eventFlags;
+			if (m_events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+				eventFlags |= SocketPollEvent::Read;
+
+			if (m_events[i].events & (EPOLLOUT | EPOLLERR))
+				eventFlags |= SocketPollEvent::Write;
+
+			if (!eventFlags)
+				continue;
+
+			SocketPollerEvent& event = events[eventCount++];
+			event.socket = socketData->socket;
+			event.events = eventFlags;
+			event.userdata = socketData->userdata;
+		}
+
+		return eventCount;
+	}
+
+	int SocketPollerImpl::WaitForEvents(int msTimeout, std::size_t maxEventCount, SocketError* error)
+	{
+		// epoll_wait fails on a zero-sized event array
+		m_events.resize(std::max<std::size_t>(maxEventCount, 1));
+
+		int activeSockets = epoll_wait(m_handle, m_events.data(), static_cast<int>(m_events.size()), msTimeout);
+		if (activeSockets == -1)
+		{
+			if (error)
+				*error = SocketImpl::TranslateErrorToSocketError(errno);
+
+			return -1;
+		}
+
 		if (error)
 			*error = SocketError::NoError;
 
@@ -9,6 +9,8 @@
 
 #include <Nazara/Network/IpAddress.hpp>
 #include <Nazara/Network/SocketHandle.hpp>
+#include <Nazara/Network/SocketPoller.hpp>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 #include <sys/epoll.h>
@@ -27,15 +29,24 @@ namespace Nz
 			bool IsReadyToWrite(SocketHandle socket) const;
 			bool IsRegistered(SocketHandle socket) const;
 
-			bool RegisterSocket(SocketHandle socket, SocketPollEventFlags eventFlags);
+			bool RegisterSocket(SocketHandle socket, SocketPollEventFlags eventFlags, void* userdata, SocketPollMode pollMode);
 			void UnregisterSocket(SocketHandle socket);
 
 			unsigned int Wait(int msTimeout, SocketError* error);
+			unsigned int Wait(int msTimeout, SocketPollerEvent* events, std::size_t maxEventCount, SocketError* error);
 
 		private:
+			struct SocketData
+			{
+				SocketHandle socket;
+				void* userdata;
+			};
+
+			int WaitForEvents(int msTimeout, std::size_t maxEventCount, SocketError* error);
+
 			std::unordered_set<SocketHandle> m_readyToReadSockets;
 			std::unordered_set<SocketHandle> m_readyToWriteSockets;
-			std::unordered_set<SocketHandle> m_sockets;
+			std::unordered_map<SocketHandle, SocketData> m_sockets; //< epoll events point to the values, which have stable addresses
 			std::vector<epoll_event> m_events;
 			int m_handle;
 	};
@@ -4,6 +4,7 @@
 
 #include <Nazara/Network/NetPacket.hpp>
 #include <Nazara/Core/MemoryView.hpp>
+#include <algorithm>
 #include <Nazara/Network/Debug.hpp>
 
 namespace Nz
@@ -110,10 +111,28 @@ namespace Nz
 		if (!m_buffer)
 			return;
 
-		std::size_t size = m_buffer->GetSize();
-
 		std::lock_guard<std::recursive_mutex> lock(s_availableBuffersMutex);
-		s_availableBuffers.emplace_back(std::make_pair(size, std::move(m_buffer)));
+
+		std::size_t capacity = m_buffer->GetCapacity();
+		auto it = std::lower_bound(s_availableBuffers.begin(), s_availableBuffers.end(), capacity, [](const std::unique_ptr<ByteArray>& buffer, std::size_t refCapacity)
+		{
+			return buffer->GetCapacity() < refCapacity;
+		});
+
+		if (s_availableBuffers.size() >= MaxPooledBufferCount)
+		{
+			// Keep the biggest buffers, as they are the most expensive to allocate
+			if (it == s_availableBuffers.begin())
+			{
+				m_buffer.reset();
+				return;
+			}
+
+			s_availableBuffers.erase(s_availableBuffers.begin());
+			--it;
+		}
+
+		s_availableBuffers.emplace(it, std::move(m_buffer));
 	}
 
 	/*!
@@ -137,8 +156,17 @@ namespace Nz
 
 			if (!s_availableBuffers.empty())
 			{
-				m_buffer = std::move(s_availableBuffers.back().second);
-				s_availableBuffers.pop_back();
+				// Take the smallest buffer big enough to avoid a reallocation, or the biggest one if none is
+				auto it = std::lower_bound(s_availableBuffers.begin(), s_availableBuffers.end(), minCapacity, [](const std::unique_ptr<ByteArray>& buffer, std::size_t refCapacity)
+				{
+					return buffer->GetCapacity() < refCapacity;
+				});
+
+				if (it == s_availableBuffers.end())
+					--it;
+
+				m_buffer = std::move(*it);
+				s_availableBuffers.erase(it);
 			}
 		}
 
@@ -172,5 +200,5 @@ namespace Nz
 	}
 
 	std::recursive_mutex NetPacket::s_availableBuffersMutex;
-	std::vector<std::pair<std::size_t, std::unique_ptr<ByteArray>>> NetPacket::s_availableBuffers;
+	std::vector<std::unique_ptr<ByteArray>> NetPacket::s_availableBuffers;
 }
@@ -37,7 +37,8 @@ namespace Nz
 	*/
 
 	Network::Network(Config config) :
-	ModuleBase("Network", this)
+	ModuleBase("Network", this),
+	m_resolverThreadCount(config.resolverThreadCount)
 	{
 		// Initialize module here
 		if (!SocketImpl::Initialize())
@@ -58,6 +59,9 @@ namespace Nz
 
 	Network::~Network()
 	{
+		// Pending resolutions are completed before sockets are uninitialized
+		m_resolverScheduler.reset();
+
 #ifndef NAZARA_PLATFORM_WEB
 		m_curlLibrary.reset();
 #endif
@@ -66,6 +70,24 @@ namespace Nz
 		SocketImpl::Uninitialize();
 	}
 
+	/*!
+	* \brief Returns the task scheduler running blocking hostname resolutions
+	* \return Task scheduler with Config::resolverThreadCount workers, started on first call
+	*
+	* Hostname resolution can block for seconds, a separate scheduler prevents it from stalling the tasks of Core scheduler.
+	*
+	* \remark This function is thread-safe
+	*/
+	TaskScheduler& Network::GetResolverScheduler()
+	{
+		std::call_once(m_resolverSchedulerFlag, [this]
+		{
+			m_resolverScheduler.emplace(m_resolverThreadCount);
+		});
+
+		return *m_resolverScheduler;
+	}
+
 	std::unique_ptr<WebService> Network::InstantiateWebService()
 	{
 #ifndef NAZARA_PLATFORM_WEB
@@ -0,0 +1,243 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Network/Posix/SocketCompletionQueueImpl.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Network/Algorithm.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <limits>
+#include <poll.h>
+#include <sys/socket.h>
+#include <Nazara/Network/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+#ifdef MSG_NOSIGNAL
+		constexpr int SendFlags = MSG_DONTWAIT | MSG_NOSIGNAL;
+#else
+		constexpr int SendFlags = MSG_DONTWAIT;
+#endif
+	}
+
+	bool SocketCompletionQueueImpl::Create(std::size_t receiveBufferSize, std::size_t /*receiveBufferCount*/)
+	{
+		// Receive callbacks are called synchronously, a single buffer is enough
+		m_receiveBuffer.resize(receiveBufferSize);
+		return true;
+	}
+
+	unsigned int SocketCompletionQueueImpl::Process(int msTimeout, SocketError* error)
+	{
+		m_pollSockets.clear();
+		m_pollGenerations.clear();
+		for (auto&& [socket, socketData] : m_sockets)
+		{
+			PollSocket entry = {
+				socket,
+				0,
+				0
+			};
+
+			if (socketData.acceptCallback || socketData.receiveCallback)
+				entry.events |= POLLRDNORM;
+
+			if (!socketData.sendOperations.empty())
+				entry.events |= POLLWRNORM;
+
+			if (entry.events == 0)
+				continue;
+
+			m_pollSockets.push_back(entry);
+			m_pollGenerations.push_back(socketData.generation);
+		}
+
+		if (m_pollSockets.empty())
+		{
+			if (error)
+				*error = SocketError::NoError;
+
+			return 0;
+		}
+
+		SocketError waitError;
+		int activeSockets = SocketImpl::Poll(m_pollSockets.data(), m_pollSockets.size(), msTimeout, &waitError);
+		if (waitError != SocketError::NoError && waitError != SocketError::Interrupted)
+		{
+			NazaraError("failed to poll sockets: {0}", ErrorToString(waitError));
+
+			if (error)
+				*error = waitError;
+
+			return 0;
+		}
+
+		unsigned int completionCount = 0;
+		if (activeSockets > 0)
+		{
+			// Callbacks may stop sockets and start new operations, every socket is looked up again before processing it
+			for (std::size_t i = 0; i < m_pollSockets.size(); ++i)
+			{
+				const PollSocket& entry = m_pollSockets[i];
+				if (entry.revents == 0)
+					continue;
+
+				bool hasError = (entry.revents & (POLLERR | POLLHUP)) != 0;
+				if (hasError || (entry.revents & POLLRDNORM))
+				{
+					if (ProcessAccept(entry.fd, m_pollGenerations[i]))
+						completionCount++;
+
+					if (ProcessReceive(entry.fd, m_pollGenerations[i]))
+						completionCount++;
+				}
+
+				if (hasError || (entry.revents & POLLWRNORM))
+				{
+					if (ProcessSend(entry.fd, m_pollGenerations[i]))
+						completionCount++;
+				}
+			}
+		}
+
+		if (error)
+			*error = SocketError::NoError;
+
+		return completionCount;
+	}
+
+	bool SocketCompletionQueueImpl::Send(SocketHandle socket, const void* data, std::size_t size, SendCallback callback)
+	{
+		SocketData& socketData = RegisterSocket(socket);
+
+		auto& sendOperation = socketData.sendOperations.emplace_back();
+		sendOperation.callback = std::move(callback);
+		sendOperation.data = static_cast<const UInt8*>(data);
+		sendOperation.size = size;
+
+		return true;
+	}
+
+	bool SocketCompletionQueueImpl::StartAccepting(SocketHandle socket, AcceptCallback callback)
+	{
+		SocketData& socketData = RegisterSocket(socket);
+		NazaraAssert(!socketData.acceptCallback, "socket is already accepting");
+
+		socketData.acceptCallback = std::move(callback);
+		return true;
+	}
+
+	bool SocketCompletionQueueImpl::StartReceiving(SocketHandle socket, ReceiveCallback callback)
+	{
+		SocketData& socketData = RegisterSocket(socket);
+		NazaraAssert(!socketData.receiveCallback, "socket is already receiving");
+
+		socketData.receiveCallback = std::move(callback);
+		return true;
+	}
+
+	void SocketCompletionQueueImpl::Stop(SocketHandle socket)
+	{
+		m_sockets.erase(socket);
+	}
+
+	bool SocketCompletionQueueImpl::ProcessAccept(SocketHandle socket, UInt64 generation)
+	{
+		auto it = m_sockets.find(socket);
+		if (it == m_sockets.end() || it->second.generation != generation || !it->second.acceptCallback)
+			return false;
+
+		IpAddress peerAddress;
+		SocketError acceptError;
+		SocketHandle client = SocketImpl::Accept(socket, &peerAddress, &acceptError);
+		if (client == SocketImpl::InvalidHandle)
+			return false; //< accept errors are transient (connection aborted, too many open files, ...), keep accepting
+
+		// Copy the callback, as it may stop the socket
+		AcceptCallback callback = it->second.acceptCallback;
+		callback(client, peerAddress);
+
+		return true;
+	}
+
+	bool SocketCompletionQueueImpl::ProcessReceive(SocketHandle socket, UInt64 generation)
+	{
+		auto it = m_sockets.find(socket);
+		if (it == m_sockets.end() || it->second.generation != generation || !it->second.receiveCallback)
+			return false;
+
+		ssize_t byteRead = recv(socket, m_receiveBuffer.data(), m_receiveBuffer.size(), MSG_DONTWAIT);
+		if (byteRead > 0)
+		{
+			ReceiveCallback callback = it->second.receiveCallback;
+			callback(m_receiveBuffer.data(), SafeCast<std::size_t>(byteRead), SocketError::NoError);
+			return true;
+		}
+
+		int errorCode = errno;
+		if (byteRead < 0 && (errorCode == EAGAIN || errorCode == EWOULDBLOCK || errorCode == EINTR))
+			return false;
+
+		// Connection closed or failed, receiving stops
+		ReceiveCallback callback = std::move(it->second.receiveCallback);
+		it->second.receiveCallback = nullptr;
+
+		callback(nullptr, 0, (byteRead == 0) ? SocketError::ConnectionClosed : SocketImpl::TranslateErrorToSocketError(errorCode));
+		return true;
+	}
+
+	bool SocketCompletionQueueImpl::ProcessSend(SocketHandle socket, UInt64 generation)
+	{
+		auto it = m_sockets.find(socket);
+		if (it == m_sockets.end() || it->second.generation != generation || it->second.sendOperations.empty())
+			return false;
+
+		SendOperation& sendOperation = it->second.sendOperations.front();
+
+		SocketError sendError = SocketError::NoError;
+		if (sendOperation.sentSize < sendOperation.size)
+		{
+			std::size_t remainingSize = sendOperation.size - sendOperation.sentSize;
+			ssize_t byteSent = send(socket, sendOperation.data + sendOperation.sentSize, remainingSize, SendFlags);
+			if (byteSent < 0)
+			{
+				int errorCode = errno;
+				if (errorCode == EAGAIN || errorCode == EWOULDBLOCK || errorCode == EINTR)
+					return false;
+
+				sendError = SocketImpl::TranslateErrorToSocketError(errorCode);
+			}
+			else
+			{
+				sendOperation.sentSize += SafeCast<std::size_t>(byteSent);
+				if (sendOperation.sentSize < sendOperation.size)
+					return false; //< wait for the socket to be writable again
+			}
+		}
+
+		std::size_t sentSize = sendOperation.sentSize;
+		SendCallback callback = std::move(sendOperation.callback);
+		it->second.sendOperations.pop_front();
+
+		if (callback)
+			callback(sentSize, sendError);
+
+		return true;
+	}
+
+	auto SocketCompletionQueueImpl::RegisterSocket(SocketHandle socket) -> SocketData&
+	{
+		auto it = m_sockets.find(socket);
+		if (it == m_sockets.end())
+		{
+			it = m_sockets.emplace(socket, SocketData{}).first;
+			it->second.generation = m_nextGeneration++;
+		}
+
+		return it->second;
+	}
+}
@@ -0,0 +1,78 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NETWORK_POSIX_SOCKETCOMPLETIONQUEUEIMPL_HPP
+#define NAZARA_NETWORK_POSIX_SOCKETCOMPLETIONQUEUEIMPL_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Network/IpAddress.hpp>
+#include <Nazara/Network/SocketCompletionQueue.hpp>
+#include <Nazara/Network/SocketHandle.hpp>
+#include <Nazara/Network/Posix/SocketImpl.hpp>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace Nz
+{
+	// Emulates completions by running operations once poll reports their socket as ready
+	class SocketCompletionQueueImpl
+	{
+		public:
+			using AcceptCallback = std::function<void(SocketHandle handle, const IpAddress& address)>;
+			using ReceiveCallback = SocketCompletionQueue::ReceiveCallback;
+			using SendCallback = SocketCompletionQueue::SendCallback;
+
+			SocketCompletionQueueImpl() = default;
+			SocketCompletionQueueImpl(const SocketCompletionQueueImpl&) = delete;
+			SocketCompletionQueueImpl(SocketCompletionQueueImpl&&) = delete;
+			~SocketCompletionQueueImpl() = default;
+
+			bool Create(std::size_t receiveBufferSize, std::size_t receiveBufferCount);
+
+			unsigned int Process(int msTimeout, SocketError* error);
+
+			bool Send(SocketHandle socket, const void* data, std::size_t size, SendCallback callback);
+
+			bool StartAccepting(SocketHandle socket, AcceptCallback callback);
+			bool StartReceiving(SocketHandle socket, ReceiveCallback callback);
+			void Stop(SocketHandle socket);
+
+			SocketCompletionQueueImpl& operator=(const SocketCompletionQueueImpl&) = delete;
+			SocketCompletionQueueImpl& operator=(SocketCompletionQueueImpl&&) = delete;
+
+		private:
+			struct SendOperation
+			{
+				SendCallback callback;
+				const UInt8* data;
+				std::size_t size;
+				std::size_t sentSize = 0;
+			};
+
+			struct SocketData
+			{
+				AcceptCallback acceptCallback;
+				ReceiveCallback receiveCallback;
+				std::deque<SendOperation> sendOperations;
+				UInt64 generation; //< identifies the registration, as handles may be reused by the system
+			};
+
+			bool ProcessAccept(SocketHandle socket, UInt64 generation);
+			bool ProcessReceive(SocketHandle socket, UInt64 generation);
+			bool ProcessSend(SocketHandle socket, UInt64 generation);
+			SocketData& RegisterSocket(SocketHandle socket);
+
+			std::unordered_map<SocketHandle, SocketData> m_sockets;
+			std::vector<PollSocket> m_pollSockets;
+			std::vector<UInt64> m_pollGenerations;
+			std::vector<UInt8> m_receiveBuffer;
+			UInt64 m_nextGeneration = 1;
+	};
+}
+
+#endif // NAZARA_NETWORK_POSIX_SOCKETCOMPLETIONQUEUEIMPL_HPP
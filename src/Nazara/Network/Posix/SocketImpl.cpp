@@ -8,6 +8,7 @@
 #include <Nazara/Core/StringExt.hpp>
 #include <Nazara/Network/Algorithm.hpp>
 #include <Nazara/Network/NetBuffer.hpp>
+#include <Nazara/Network/NetDatagram.hpp>
 #include <Nazara/Network/Posix/IpAddressImpl.hpp>
 #include <NazaraUtils/EnumArray.hpp>
 #include <NazaraUtils/StackArray.hpp>
@@ -16,6 +17,7 @@
 #include <unistd.h>
 #include <netinet/tcp.h>
 #include <sys/ioctl.h>
+#include <sys/socket.h>
 #include <sys/types.h>
 #include <sys/uio.h>
 #include <Nazara/Network/Debug.hpp>
@@ -497,6 +499,109 @@ namespace Nz
 		return true;
 	}
 
+	/*!
+	* \brief Receives up to datagramCount datagrams, one per NetDatagram
+	*
+	* On Linux this is done using a single recvmmsg call, other platforms receive datagrams one by one until none is available.
+	* Truncated datagrams are reported with a zero receivedLength.
+	*/
+	bool SocketImpl::ReceiveBatch(SocketHandle handle, NetDatagram* datagrams, std::size_t datagramCount, std::size_t* receivedCount, SocketError* error)
+	{
+		NazaraAssert(handle != InvalidHandle, "Invalid handle");
+		NazaraAssert(datagrams && datagramCount > 0, "Invalid datagrams");
+
+		std::size_t datagramReceived = 0;
+
+#ifdef NAZARA_PLATFORM_LINUX
+		StackArray<mmsghdr> messages = NazaraStackArray(mmsghdr, datagramCount);
+		StackArray<iovec> sysBuffers = NazaraStackArray(iovec, datagramCount);
+		StackArray<IpAddressImpl::SockAddrBuffer> nameBuffers = NazaraStackArray(IpAddressImpl::SockAddrBuffer, datagramCount);
+
+		for (std::size_t i = 0; i < datagramCount; ++i)
+		{
+			sysBuffers[i].iov_base = datagrams[i].buffer.data;
+			sysBuffers[i].iov_len = datagrams[i].buffer.dataLength;
+
+			nameBuffers[i].fill(0);
+
+			mmsghdr& message = messages[i];
+			std::memset(&message, 0, sizeof(message));
+			message.msg_hdr.msg_iov = &sysBuffers[i];
+			message.msg_hdr.msg_iovlen = 1;
+			message.msg_hdr.msg_name = nameBuffers[i].data();
+			message.msg_hdr.msg_namelen = static_cast<socklen_t>(nameBuffers[i].size());
+		}
+
+		// MSG_WAITFORONE prevents blocking sockets from waiting for the whole batch
+		int messageCount = recvmmsg(handle, messages.data(), static_cast<unsigned int>(datagramCount), MSG_WAITFORONE, nullptr);
+		if (messageCount == -1)
+		{
+			int errorCode = errno;
+			if (errorCode == EAGAIN)
+				errorCode = EWOULDBLOCK;
+
+			if (errorCode != EWOULDBLOCK)
+			{
+				if (error)
+					*error = TranslateErrorToSocketError(errorCode);
+
+				return false; //< Error
+			}
+
+			messageCount = 0;
+		}
+
+		for (int i = 0; i < messageCount; ++i)
+		{
+			const mmsghdr& message = messages[i];
+
+			NetDatagram& datagram = datagrams[i];
+			datagram.address = IpAddressImpl::FromSockAddr(reinterpret_cast<const sockaddr*>(nameBuffers[i].data()));
+			datagram.receivedLength = (message.msg_hdr.msg_flags & MSG_TRUNC) ? 0 : message.msg_len;
+		}
+
+		datagramReceived = static_cast<std::size_t>(messageCount);
+#else
+		for (; datagramReceived < datagramCount; ++datagramReceived)
+		{
+			NetDatagram& datagram = datagrams[datagramReceived];
+
+			int read;
+			SocketError receiveError;
+			if (!ReceiveFrom(handle, datagram.buffer.data, static_cast<int>(datagram.buffer.dataLength), &datagram.address, &read, &receiveError))
+			{
+				if (receiveError == SocketError::ConnectionClosed)
+					read = 0; //< empty datagram
+				else if (receiveError == SocketError::DatagramSize)
+					read = 0; //< truncated datagram
+				else
+				{
+					// Report the error on next call if we already received some datagrams
+					if (datagramReceived > 0)
+						break;
+
+					if (error)
+						*error = receiveError;
+
+					return false;
+				}
+			}
+			else if (read == 0)
+				break; //< no more datagram available
+
+			datagram.receivedLength = static_cast<std::size_t>(read);
+		}
+#endif
+
+		if (receivedCount)
+			*receivedCount = datagramReceived;
+
+		if (error)
+			*error = SocketError::NoError;
+
+		return true;
+	}
+
 	bool SocketImpl::ReceiveFrom(SocketHandle handle, void* buffer, int length, IpAddress* from, int* read, SocketError* error)
 	{
 		NazaraAssert(handle != InvalidHandle, "Invalid handle");
@@ -684,6 +789,85 @@ namespace Nz
 		return true;
 	}
 
+	/*!
+	* \brief Sends one datagram per NetDatagram, stopping at the first one which couldn't be sent
+	*
+	* On Linux this is done using a single sendmmsg call, other platforms send datagrams one by one.
+	* If sentCount is lower than datagramCount without error, the socket send buffer is full.
+	*/
+	bool SocketImpl::SendBatch(SocketHandle handle, const NetDatagram* datagrams, std::size_t datagramCount, std::size_t* sentCount, SocketError* error)
+	{
+		NazaraAssert(handle != InvalidHandle, "Invalid handle");
+		NazaraAssert(datagrams && datagramCount > 0, "Invalid datagrams");
+
+		std::size_t datagramSent = 0;
+
+#ifdef NAZARA_PLATFORM_LINUX
+		StackArray<mmsghdr> messages = NazaraStackArray(mmsghdr, datagramCount);
+		StackArray<iovec> sysBuffers = NazaraStackArray(iovec, datagramCount);
+		StackArray<IpAddressImpl::SockAddrBuffer> nameBuffers = NazaraStackArray(IpAddressImpl::SockAddrBuffer, datagramCount);
+
+		for (std::size_t i = 0; i < datagramCount; ++i)
+		{
+			sysBuffers[i].iov_base = datagrams[i].buffer.data;
+			sysBuffers[i].iov_len = datagrams[i].buffer.dataLength;
+
+			mmsghdr& message = messages[i];
+			std::memset(&message, 0, sizeof(message));
+			message.msg_hdr.msg_iov = &sysBuffers[i];
+			message.msg_hdr.msg_iovlen = 1;
+			message.msg_hdr.msg_name = nameBuffers[i].data();
+			message.msg_hdr.msg_namelen = IpAddressImpl::ToSockAddr(datagrams[i].address, nameBuffers[i].data());
+		}
+
+		int messageCount = sendmmsg(handle, messages.data(), static_cast<unsigned int>(datagramCount), MSG_NOSIGNAL);
+		if (messageCount == -1)
+		{
+			int errorCode = errno;
+			if (errorCode == EAGAIN)
+				errorCode = EWOULDBLOCK;
+
+			if (errorCode != EWOULDBLOCK)
+			{
+				if (error)
+					*error = TranslateErrorToSocketError(errorCode);
+
+				return false; //< Error
+			}
+
+			messageCount = 0;
+		}
+
+		datagramSent = static_cast<std::size_t>(messageCount);
+#else
+		for (; datagramSent < datagramCount; ++datagramSent)
+		{
+			const NetDatagram& datagram = datagrams[datagramSent];
+
+			int sent;
+			if (!SendTo(handle, datagram.buffer.data, static_cast<int>(datagram.buffer.dataLength), datagram.address, &sent, error))
+			{
+				// Report the error on next call if we already sent some datagrams
+				if (datagramSent > 0)
+					break;
+
+				return false;
+			}
+
+			if (sent == 0)
+				break; //< would block
+		}
+#endif
+
+		if (sentCount)
+			*sentCount = datagramSent;
+
+		if (error)
+			*error = SocketError::NoError;
+
+		return true;
+	}
+
 	bool SocketImpl::SendMultiple(SocketHandle handle, const NetBuffer* buffers, std::size_t bufferCount, const IpAddress& to, int* sent, SocketError* error)
 	{
 		NazaraAssert(handle != InvalidHandle, "Invalid handle");
@@ -927,6 +1111,34 @@ namespace Nz
 		return true;
 	}
 
+	bool SocketImpl::SetReusePort(SocketHandle handle, bool reusePort, SocketError* error)
+	{
+		NazaraAssert(handle != InvalidHandle, "Invalid handle");
+
+#ifdef SO_REUSEPORT
+		int option = reusePort;
+		if (setsockopt(handle, SOL_SOCKET, SO_REUSEPORT, reinterpret_cast<const char*>(&option), sizeof(option)) == -1)
+		{
+			if (error)
+				*error = TranslateErrorToSocketError(errno);
+
+			return false; //< Error
+		}
+
+		if (error)
+			*error = SocketError::NoError;
+
+		return true;
+#else
+		NazaraUnused(reusePort);
+
+		if (error)
+			*error = SocketError::NotSupported;
+
+		return false;
+#endif
+	}
+
 	bool SocketImpl::SetSendBufferSize(SocketHandle handle, std::size_t size, SocketError* error)
 	{
 		NazaraAssert(handle != InvalidHandle, "Invalid handle");
@@ -15,6 +15,7 @@ namespace Nz
 		m_readyToWriteSockets.clear();
 		m_allSockets.clear();
 		m_sockets.clear();
+		m_userdata.clear();
 	}
 
 	bool SocketPollerImpl::IsReadyToRead(SocketHandle socket) const
@@ -32,10 +33,12 @@ namespace Nz
 		return m_allSockets.count(socket) != 0;
 	}
 
-	bool SocketPollerImpl::RegisterSocket(SocketHandle socket, SocketPollEventFlags eventFlags)
+	bool SocketPollerImpl::RegisterSocket(SocketHandle socket, SocketPollEventFlags eventFlags, void* userdata, SocketPollMode /*pollMode*/)
 	{
 		NazaraAssert(!IsRegistered(socket), "Socket is already registered");
 
+		// poll has no edge-triggered mode, sockets are always level-triggered
+
 		PollSocket entry = {
 			socket,
 			0,
@@ -50,6 +53,7 @@ namespace Nz
 
 		m_allSockets[socket] = m_sockets.size();
 		m_sockets.emplace_back(entry);
+		m_userdata.push_back(userdata);
 
 		return true;
 	}
@@ -69,8 +73,10 @@ namespace Nz
 
 			// Now move it properly (lastElement is invalid after the following line) and pop it
 			m_sockets[entry] = std::move(m_sockets.back());
+			m_userdata[entry] = m_userdata.back();
 		}
 		m_sockets.pop_back();
+		m_userdata.pop_back();
 
 		m_allSockets.erase(socket);
 		m_readyToReadSockets.erase(socket);
@@ -117,4 +123,44 @@ namespace Nz
 
 		return activeSockets;
 	}
+
+	unsigned int SocketPollerImpl::Wait(int msTimeout, SocketPollerEvent* events, std::size_t maxEventCount, SocketError* error)
+	{
+		unsigned int activeSockets = SocketImpl::Poll(m_sockets.data(), m_sockets.size(), static_cast<int>(msTimeout), error);
+
+		unsigned int eventCount = 0;
+		if (activeSockets > 0U)
+		{
+			unsigned int socketRemaining = activeSockets;
+			for (std::size_t i = 0; i < m_sockets.size(); ++i)
+			{
+				PollSocket& entry = m_sockets[i];
+				if (!entry.revents)
+					continue;
+
+				SocketPollEventFlags eventFlags;
+				if (entry.revents & (POLLRDNORM | POLLHUP | POLLERR))
+					eventFlags |= SocketPollEvent::Read;
+
+				if (entry.revents & (POLLWRNORM | POLLERR))
+					eventFlags |= SocketPollEvent::Write;
+
+				entry.revents = 0;
+
+				// Sockets which don't fit will still be ready on next call
+				if (eventFlags && eventCount < maxEventCount)
+				{
+					SocketPollerEvent& event = events[eventCount++];
+					event.socket = entry.fd;
+					event.events = eventFlags;
+					event.userdata = m_userdata[i];
+				}
+
+				if (--socketRemaining == 0)
+					break;
+			}
+		}
+
+		return eventCount;
+	}
 }
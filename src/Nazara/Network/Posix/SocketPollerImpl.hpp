@@ -8,6 +8,7 @@
 #define NAZARA_NETWORK_POSIX_SOCKETPOLLERIMPL_HPP
 
 #include <Nazara/Network/SocketHandle.hpp>
+#include <Nazara/Network/SocketPoller.hpp>
 #include <Nazara/Network/Posix/SocketImpl.hpp>
 #include <unordered_map>
 #include <unordered_set>
@@ -27,16 +28,18 @@ namespace Nz
 			bool IsReadyToWrite(SocketHandle socket) const;
 			bool IsRegistered(SocketHandle socket) const;
 
-			bool RegisterSocket(SocketHandle socket, SocketPollEventFlags eventFlags);
+			bool RegisterSocket(SocketHandle socket, SocketPollEventFlags eventFlags, void* userdata, SocketPollMode pollMode);
 			void UnregisterSocket(SocketHandle socket);
 
 			unsigned int Wait(int msTimeout, SocketError* error);
+			unsigned int Wait(int msTimeout, SocketPollerEvent* events, std::size_t maxEventCount, SocketError* error);
 
 		private:
 			std::unordered_set<SocketHandle> m_readyToReadSockets;
 			std::unordered_set<SocketHandle> m_readyToWriteSockets;
 			std::unordered_map<SocketHandle, std::size_t> m_allSockets;
 			std::vector<PollSocket> m_sockets;
+			std::vector<void*> m_userdata; //< indexed like m_sockets
 	};
 }
 
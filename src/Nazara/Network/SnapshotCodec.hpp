@@ -0,0 +1,214 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NETWORK_SNAPSHOTCODEC_HPP
+#define NAZARA_NETWORK_SNAPSHOTCODEC_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Network/SnapshotSchema.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace Nz
+{
+	class SnapshotBitWriter
+	{
+		public:
+			SnapshotBitWriter() = default;
+
+			void Append(const SnapshotBitWriter& writer)
+			{
+				for (std::size_t i = 0; i < writer.m_bitCount; i += 32)
+				{
+					UInt8 bitCount = static_cast<UInt8>(std::min<std::size_t>(writer.m_bitCount - i, 32));
+					UInt32 value = 0;
+					for (UInt8 bit = 0; bit < bitCount; ++bit)
+					{
+						std::size_t bitIndex = i + bit;
+						value |= UInt32((writer.m_data[bitIndex / 8] >> (bitIndex % 8)) & 1) << bit;
+					}
+
+					Write(value, bitCount);
+				}
+			}
+
+			void Clear()
+			{
+				m_bitCount = 0;
+				m_data.clear();
+			}
+
+			std::size_t GetBitCount() const { return m_bitCount; }
+			std::size_t GetByteCount() const { return m_data.size(); }
+			const UInt8* GetData() const { return m_data.data(); }
+
+			void Write(UInt32 value, UInt8 bitCount)
+			{
+				for (UInt8 bit = 0; bit < bitCount; ++bit)
+				{
+					if (m_bitCount % 8 == 0)
+						m_data.push_back(0);
+
+					m_data.back() |= UInt8(((value >> bit) & 1) << (m_bitCount % 8));
+					m_bitCount++;
+				}
+			}
+
+			void WriteBool(bool value)
+			{
+				Write(value, 1);
+			}
+
+			// 8 bits at a time plus a continuation bit, network ids are usually small
+			void WriteVarUInt(UInt32 value)
+			{
+				do
+				{
+					Write(value & 0xFF, 8);
+					value >>= 8;
+					WriteBool(value != 0);
+				}
+				while (value != 0);
+			}
+
+		private:
+			std::size_t m_bitCount = 0;
+			std::vector<UInt8> m_data;
+	};
+
+	class SnapshotBitReader
+	{
+		public:
+			SnapshotBitReader(const UInt8* data, std::size_t size) :
+			m_data(data),
+			m_bitCount(size * 8),
+			m_bitOffset(0),
+			m_hasFailed(false)
+			{
+			}
+
+			bool HasFailed() const { return m_hasFailed; }
+
+			UInt32 Read(UInt8 bitCount)
+			{
+				if (m_bitCount - m_bitOffset < bitCount)
+				{
+					m_hasFailed = true;
+					m_bitOffset = m_bitCount;
+					return 0;
+				}
+
+				UInt32 value = 0;
+				for (UInt8 bit = 0; bit < bitCount; ++bit)
+				{
+					value |= UInt32((m_data[m_bitOffset / 8] >> (m_bitOffset % 8)) & 1) << bit;
+					m_bitOffset++;
+				}
+
+				return value;
+			}
+
+			bool ReadBool()
+			{
+				return Read(1) != 0;
+			}
+
+			UInt32 ReadVarUInt()
+			{
+				UInt32 value = 0;
+				for (unsigned int shift = 0; shift < 32; shift += 8)
+				{
+					value |= Read(8) << shift;
+					if (!ReadBool())
+						return value;
+				}
+
+				m_hasFailed = true;
+				return 0;
+			}
+
+		private:
+			const UInt8* m_data;
+			std::size_t m_bitCount;
+			std::size_t m_bitOffset;
+			bool m_hasFailed;
+	};
+
+	namespace SnapshotCodec
+	{
+		// Snapshot layout: sequence (32), baseline sequence (32), despawned count, despawned network ids, updated count, updated entities
+		// Each updated entity is its network id, its component mask and the fields of present components
+		// Fields of components already present in the baseline are prefixed with a changed bit and only written if they changed
+
+		inline void EncodeEntity(SnapshotBitWriter& writer, const SnapshotSchema& schema, UInt32 networkId, const SnapshotEntityState* baseline, const SnapshotEntityState& state)
+		{
+			writer.WriteVarUInt(networkId);
+
+			std::size_t componentCount = schema.GetComponentCount();
+			for (std::size_t componentIndex = 0; componentIndex < componentCount; ++componentIndex)
+				writer.WriteBool(state.componentMask & (UInt64(1) << componentIndex));
+
+			for (std::size_t componentIndex = 0; componentIndex < componentCount; ++componentIndex)
+			{
+				UInt64 componentBit = UInt64(1) << componentIndex;
+				if ((state.componentMask & componentBit) == 0)
+					continue;
+
+				const SnapshotSchema::Component& component = schema.GetComponent(componentIndex);
+				bool isDelta = baseline && (baseline->componentMask & componentBit);
+				for (std::size_t fieldIndex = 0; fieldIndex < component.fieldBits.size(); ++fieldIndex)
+				{
+					std::size_t field = component.fieldOffset + fieldIndex;
+					if (isDelta)
+					{
+						bool hasChanged = state.fields[field] != baseline->fields[field];
+						writer.WriteBool(hasChanged);
+						if (!hasChanged)
+							continue;
+					}
+
+					writer.Write(state.fields[field], component.fieldBits[fieldIndex]);
+				}
+			}
+		}
+
+		inline bool DecodeEntity(SnapshotBitReader& reader, const SnapshotSchema& schema, const SnapshotEntityState* baseline, SnapshotEntityState& state)
+		{
+			std::size_t componentCount = schema.GetComponentCount();
+
+			state.componentMask = 0;
+			state.fields.assign(schema.GetFieldCount(), 0);
+
+			for (std::size_t componentIndex = 0; componentIndex < componentCount; ++componentIndex)
+			{
+				if (reader.ReadBool())
+					state.componentMask |= UInt64(1) << componentIndex;
+			}
+
+			for (std::size_t componentIndex = 0; componentIndex < componentCount; ++componentIndex)
+			{
+				UInt64 componentBit = UInt64(1) << componentIndex;
+				if ((state.componentMask & componentBit) == 0)
+					continue;
+
+				const SnapshotSchema::Component& component = schema.GetComponent(componentIndex);
+				bool isDelta = baseline && (baseline->componentMask & componentBit);
+				for (std::size_t fieldIndex = 0; fieldIndex < component.fieldBits.size(); ++fieldIndex)
+				{
+					std::size_t field = component.fieldOffset + fieldIndex;
+					if (isDelta && !reader.ReadBool())
+						state.fields[field] = baseline->fields[field];
+					else
+						state.fields[field] = reader.Read(component.fieldBits[fieldIndex]);
+				}
+			}
+
+			return !reader.HasFailed();
+		}
+	}
+}
+
+#endif // NAZARA_NETWORK_SNAPSHOTCODEC_HPP
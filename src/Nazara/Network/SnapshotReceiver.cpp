@@ -0,0 +1,193 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Network/SnapshotReceiver.hpp>
+#include <Nazara/Core/ByteStream.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Network/SnapshotCodec.hpp>
+#include <Nazara/Network/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup network
+	* \class Nz::SnapshotReceiver
+	* \brief Network class applying snapshots built by a SnapshotReplicator to a local EnTT registry
+	*
+	* Entities are created in the registry the first time they are received and destroyed once the replicator despawns them,
+	* their replicated components are created, updated and removed to match the server state.
+	*
+	* \see SnapshotReplicator
+	*/
+
+	/*!
+	* \brief Constructs a receiver over a registry
+	*
+	* \param registry Registry replicated entities are created in
+	* \param schema Schema of the replicated components, which must outlive the receiver and be the same on the server side
+	*/
+	SnapshotReceiver::SnapshotReceiver(entt::registry& registry, const SnapshotSchema& schema) :
+	m_registry(registry),
+	m_schema(schema),
+	m_lastSequence(0)
+	{
+	}
+
+	/*!
+	* \brief Destroys the receiver, replicated entities are left in the registry
+	*/
+	SnapshotReceiver::~SnapshotReceiver() = default;
+
+	/*!
+	* \brief Destroys every replicated entity and forgets received snapshots
+	*/
+	void SnapshotReceiver::Clear()
+	{
+		for (auto&& [networkId, entity] : m_entities)
+		{
+			if (m_registry.valid(entity))
+				m_registry.destroy(entity);
+		}
+		m_entities.clear();
+
+		for (Snapshot& snapshot : m_snapshots)
+		{
+			snapshot.entities.clear();
+			snapshot.sequence = 0;
+		}
+
+		m_lastSequence = 0;
+	}
+
+	/*!
+	* \brief Reads a snapshot and applies it to the registry
+	* \return Sequence to acknowledge to the replicator, or std::nullopt if the snapshot was not applied
+	*
+	* Snapshots older than the last applied one are ignored.
+	*
+	* \param stream Stream (usually a NetPacket) the snapshot is read from
+	*/
+	std::optional<UInt32> SnapshotReceiver::ProcessSnapshot(ByteStream& stream)
+	{
+		UInt32 byteCount;
+		stream >> byteCount;
+
+		m_buffer.resize(byteCount);
+		if (stream.Read(m_buffer.data(), byteCount) != byteCount)
+		{
+			NazaraError("failed to read snapshot: stream is too short");
+			return std::nullopt;
+		}
+
+		SnapshotBitReader reader(m_buffer.data(), m_buffer.size());
+		UInt32 sequence = reader.Read(32);
+		UInt32 baselineSequence = reader.Read(32);
+
+		if (reader.HasFailed() || sequence == 0)
+		{
+			NazaraError("failed to read snapshot: invalid header");
+			return std::nullopt;
+		}
+
+		if (sequence <= m_lastSequence)
+			return std::nullopt;
+
+		const Snapshot* baseline = nullptr;
+		if (baselineSequence != 0)
+		{
+			const Snapshot& baselineSnapshot = m_snapshots[baselineSequence % SnapshotSchema::BaselineCount];
+			if (baselineSnapshot.sequence != baselineSequence)
+			{
+				NazaraError("failed to read snapshot {0}: baseline {1} is not available", sequence, baselineSequence);
+				return std::nullopt;
+			}
+
+			baseline = &baselineSnapshot;
+		}
+
+		std::unordered_map<UInt32, SnapshotEntityState> entities;
+		if (baseline)
+			entities = baseline->entities;
+
+		UInt32 despawnCount = reader.ReadVarUInt();
+		for (UInt32 i = 0; i < despawnCount && !reader.HasFailed(); ++i)
+			entities.erase(reader.ReadVarUInt());
+
+		UInt32 updateCount = reader.ReadVarUInt();
+		for (UInt32 i = 0; i < updateCount && !reader.HasFailed(); ++i)
+		{
+			UInt32 networkId = reader.ReadVarUInt();
+
+			const SnapshotEntityState* baselineState = nullptr;
+			if (baseline)
+			{
+				auto it = baseline->entities.find(networkId);
+				if (it != baseline->entities.end())
+					baselineState = &it->second;
+			}
+
+			SnapshotCodec::DecodeEntity(reader, m_schema, baselineState, entities[networkId]);
+		}
+
+		if (reader.HasFailed())
+		{
+			NazaraError("failed to read snapshot {0}: corrupted data", sequence);
+			return std::nullopt;
+		}
+
+		// The registry reflects the last applied snapshot, which may be more recent than the baseline
+		static const SnapshotEntityState s_emptyState;
+
+		const Snapshot* previous = nullptr;
+		if (m_lastSequence != 0)
+		{
+			const Snapshot& previousSnapshot = m_snapshots[m_lastSequence % SnapshotSchema::BaselineCount];
+			if (previousSnapshot.sequence == m_lastSequence)
+				previous = &previousSnapshot;
+		}
+
+		for (auto it = m_entities.begin(); it != m_entities.end();)
+		{
+			if (entities.find(it->first) == entities.end())
+			{
+				if (m_registry.valid(it->second))
+					m_registry.destroy(it->second);
+
+				it = m_entities.erase(it);
+			}
+			else
+				++it;
+		}
+
+		for (auto&& [networkId, state] : entities)
+		{
+			auto entityIt = m_entities.find(networkId);
+			if (entityIt == m_entities.end())
+			{
+				entityIt = m_entities.emplace(networkId, m_registry.create()).first;
+				m_schema.ApplyState(m_registry, entityIt->second, s_emptyState, state);
+				continue;
+			}
+
+			const SnapshotEntityState* previousState = &s_emptyState;
+			if (previous)
+			{
+				auto it = previous->entities.find(networkId);
+				if (it != previous->entities.end())
+					previousState = &it->second;
+			}
+
+			if (*previousState != state)
+				m_schema.ApplyState(m_registry, entityIt->second, *previousState, state);
+		}
+
+		Snapshot& snapshot = m_snapshots[sequence % SnapshotSchema::BaselineCount];
+		snapshot.entities = std::move(entities);
+		snapshot.sequence = sequence;
+
+		m_lastSequence = sequence;
+
+		return sequence;
+	}
+}
@@ -0,0 +1,412 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Network/SnapshotReplicator.hpp>
+#include <Nazara/Core/ByteStream.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Math/Box.hpp>
+#include <Nazara/Network/ENetPeer.hpp>
+#include <Nazara/Network/SnapshotCodec.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <Nazara/Network/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup network
+	* \class Nz::SnapshotReplicator
+	* \brief Network class replicating entities of an EnTT registry to clients, using delta-compressed snapshots
+	*
+	* Each call to BuildSnapshot produces a snapshot for a client, encoding only the fields which changed since the last
+	* snapshot the client acknowledged (the baseline). Both sides keep the last SnapshotSchema::BaselineCount snapshots,
+	* if the client didn't acknowledge any of them the entities are sent in full.
+	*
+	* When a position callback is set, only entities in the view radius of a client are sent to it (entities leaving that
+	* radius are despawned on the client). Entities are sent by order of priority, which accumulates each time a changed
+	* entity couldn't fit the bandwidth budget of the client and is higher for closer entities.
+	*
+	* Snapshots are meant to be sent unreliably, the client acknowledges the sequence returned by SnapshotReceiver::ProcessSnapshot
+	* which has to be forwarded to HandleAcknowledgement.
+	*
+	* \see SnapshotReceiver
+	*/
+
+	/*!
+	* \brief Constructs a replicator over a registry
+	*
+	* \param registry Registry the replicated entities belong to
+	* \param schema Schema of the replicated components, which must outlive the replicator and be the same on the client side
+	*/
+	SnapshotReplicator::SnapshotReplicator(entt::registry& registry, const SnapshotSchema& schema) :
+	m_registry(registry),
+	m_schema(schema),
+	m_nextNetworkId(1)
+	{
+	}
+
+	SnapshotReplicator::~SnapshotReplicator() = default;
+
+	/*!
+	* \brief Adds a client to replicate entities to
+	* \return Index of the client
+	*
+	* \param peer Optional peer the snapshots are sent to, its incoming bandwidth and packet throttle reduce the budget of the client
+	*/
+	std::size_t SnapshotReplicator::AddClient(ENetPeer* peer)
+	{
+		auto it = std::find(m_clients.begin(), m_clients.end(), nullptr);
+		if (it == m_clients.end())
+			it = m_clients.insert(it, nullptr);
+
+		*it = std::make_unique<ClientData>();
+		(*it)->peer = peer;
+
+		return static_cast<std::size_t>(std::distance(m_clients.begin(), it));
+	}
+
+	/*!
+	* \brief Builds the next snapshot of a client
+	* \return Number of bytes written to the stream
+	*
+	* \param clientIndex Index of the client
+	* \param stream Stream (usually a NetPacket) the snapshot is written to
+	* \param elapsedTime Time since the last snapshot of this client, used to refill its bandwidth budget
+	*
+	* \remark Update should be called before building snapshots, to capture the current state of entities
+	*/
+	std::size_t SnapshotReplicator::BuildSnapshot(std::size_t clientIndex, ByteStream& stream, Time elapsedTime)
+	{
+		NazaraAssert(clientIndex < m_clients.size() && m_clients[clientIndex], "invalid client index");
+		ClientData& client = *m_clients[clientIndex];
+
+		UInt32 sequence = ++client.lastSequence;
+
+		const Snapshot* baseline = nullptr;
+		if (client.lastAckedSequence != 0 && sequence - client.lastAckedSequence < SnapshotSchema::BaselineCount)
+		{
+			const Snapshot& baselineSnapshot = client.snapshots[client.lastAckedSequence % SnapshotSchema::BaselineCount];
+			if (baselineSnapshot.sequence == client.lastAckedSequence)
+				baseline = &baselineSnapshot;
+		}
+
+		std::unordered_map<UInt32, SnapshotEntityState> entities;
+
+		// Gather entities of interest, those which didn't change since the baseline cost nothing
+		m_candidates.clear();
+		auto AddEntity = [&](UInt32 networkId, const EntityData& entityData, float priorityWeight)
+		{
+			const SnapshotEntityState* baselineState = nullptr;
+			if (baseline)
+			{
+				auto it = baseline->entities.find(networkId);
+				if (it != baseline->entities.end())
+				{
+					// until it gets sent, the entity stays in its baseline state
+					baselineState = &it->second;
+					entities.emplace(networkId, *baselineState);
+					if (*baselineState == entityData.state)
+						return;
+				}
+			}
+
+			float& priority = client.priorities[networkId];
+			priority += priorityWeight;
+
+			m_candidates.push_back({ baselineState, &entityData.state, priority, networkId });
+		};
+
+		if (m_positionCallback && std::isfinite(client.viewRadius))
+		{
+			Boxf viewBox(client.viewPosition - Vector3f(client.viewRadius), Vector3f(client.viewRadius * 2.f));
+			float sqViewRadius = client.viewRadius * client.viewRadius;
+
+			m_spatialTree.Query(viewBox, [&](std::size_t networkId)
+			{
+				const EntityData& entityData = m_entities.find(SafeCast<UInt32>(networkId))->second;
+
+				float sqDistance = client.viewPosition.SquaredDistance(entityData.position);
+				if (sqDistance > sqViewRadius)
+					return;
+
+				// closer entities get their priority raised faster
+				AddEntity(SafeCast<UInt32>(networkId), entityData, std::max(1.f - std::sqrt(sqDistance) / client.viewRadius, 0.1f));
+			});
+		}
+		else
+		{
+			for (auto&& [networkId, entityData] : m_entities)
+				AddEntity(networkId, entityData, 1.f);
+		}
+
+		// Baseline entities which are not of interest anymore left the view or stopped being replicated
+		m_despawnedEntities.clear();
+		if (baseline)
+		{
+			for (auto&& [networkId, state] : baseline->entities)
+			{
+				if (entities.find(networkId) != entities.end())
+					continue;
+
+				m_despawnedEntities.push_back(networkId);
+				client.priorities.erase(networkId);
+			}
+		}
+
+		std::sort(m_candidates.begin(), m_candidates.end(), [](const Candidate& lhs, const Candidate& rhs)
+		{
+			if (lhs.priority != rhs.priority)
+				return lhs.priority > rhs.priority;
+
+			return lhs.networkId < rhs.networkId;
+		});
+
+		SnapshotBitWriter writer;
+		writer.Write(sequence, 32);
+		writer.Write((baseline) ? baseline->sequence : 0, 32);
+
+		writer.WriteVarUInt(SafeCast<UInt32>(m_despawnedEntities.size()));
+		for (UInt32 networkId : m_despawnedEntities)
+			writer.WriteVarUInt(networkId);
+
+		// Fill the remaining budget with the entities of highest priorities
+		std::size_t budgetBits = std::numeric_limits<std::size_t>::max();
+
+		bool isBudgetLimited = ComputeBudget(client, elapsedTime, budgetBits);
+		if (isBudgetLimited)
+			budgetBits *= 8;
+
+		SnapshotBitWriter entityWriter;
+		SnapshotBitWriter updateWriter;
+		UInt32 updateCount = 0;
+		for (const Candidate& candidate : m_candidates)
+		{
+			entityWriter.Clear();
+			SnapshotCodec::EncodeEntity(entityWriter, m_schema, candidate.networkId, candidate.baseline, *candidate.state);
+
+			// account for the update count field, which takes at most 36 bits
+			// delayed entities keep their baseline state, new entities will be considered again on the next snapshot
+			if (writer.GetBitCount() + updateWriter.GetBitCount() + entityWriter.GetBitCount() + 36 > budgetBits)
+				continue;
+
+			updateWriter.Append(entityWriter);
+			updateCount++;
+
+			entities.insert_or_assign(candidate.networkId, *candidate.state);
+			client.priorities.erase(candidate.networkId);
+		}
+
+		writer.WriteVarUInt(updateCount);
+		writer.Append(updateWriter);
+
+		std::size_t byteCount = writer.GetByteCount();
+		if (isBudgetLimited)
+			client.bandwidthCredit -= double(byteCount);
+
+		Snapshot& snapshot = client.snapshots[sequence % SnapshotSchema::BaselineCount];
+		snapshot.entities = std::move(entities);
+		snapshot.sequence = sequence;
+
+		stream << SafeCast<UInt32>(byteCount);
+		stream.Write(writer.GetData(), byteCount);
+
+		return sizeof(UInt32) + byteCount;
+	}
+
+	/*!
+	* \brief Handles the acknowledgement of a snapshot by a client, which can then be used as a baseline
+	*
+	* \param clientIndex Index of the client
+	* \param sequence Sequence of the acknowledged snapshot
+	*/
+	void SnapshotReplicator::HandleAcknowledgement(std::size_t clientIndex, UInt32 sequence)
+	{
+		NazaraAssert(clientIndex < m_clients.size() && m_clients[clientIndex], "invalid client index");
+		ClientData& client = *m_clients[clientIndex];
+
+		if (sequence <= client.lastAckedSequence || sequence > client.lastSequence)
+			return;
+
+		if (client.snapshots[sequence % SnapshotSchema::BaselineCount].sequence != sequence)
+			return;
+
+		client.lastAckedSequence = sequence;
+	}
+
+	/*!
+	* \brief Removes a client, its index may be reused by a later AddClient call
+	*/
+	void SnapshotReplicator::RemoveClient(std::size_t clientIndex)
+	{
+		NazaraAssert(clientIndex < m_clients.size() && m_clients[clientIndex], "invalid client index");
+		m_clients[clientIndex].reset();
+	}
+
+	/*!
+	* \brief Starts replicating an entity
+	* \return Network id of the entity, identifying it on clients
+	*
+	* Entities destroyed from the registry stop being replicated on next Update.
+	*
+	* \param entity Entity to replicate
+	*/
+	UInt32 SnapshotReplicator::Replicate(entt::entity entity)
+	{
+		NazaraAssert(m_registry.valid(entity), "invalid entity");
+
+		auto it = m_networkIds.find(entity);
+		if (it != m_networkIds.end())
+			return it->second;
+
+		// network ids are never reused to avoid mixing up entities in in-flight snapshots
+		UInt32 networkId = m_nextNetworkId++;
+		m_networkIds.emplace(entity, networkId);
+
+		EntityData& entityData = m_entities[networkId];
+		entityData.entity = entity;
+		m_schema.ExtractState(m_registry, entity, entityData.state);
+
+		if (m_positionCallback)
+		{
+			entityData.position = m_positionCallback(m_registry, entity);
+			entityData.proxyId = m_spatialTree.AddProxy(Boxf(entityData.position, Vector3f::Zero()), networkId);
+		}
+
+		return networkId;
+	}
+
+	/*!
+	* \brief Sets the bandwidth budget of a client
+	*
+	* \param clientIndex Index of the client
+	* \param bytesPerSecond Bandwidth allocated to the snapshots of this client, zero means it isn't limited (other than by its peer)
+	*/
+	void SnapshotReplicator::SetClientBandwidth(std::size_t clientIndex, UInt32 bytesPerSecond)
+	{
+		NazaraAssert(clientIndex < m_clients.size() && m_clients[clientIndex], "invalid client index");
+		m_clients[clientIndex]->bandwidth = bytesPerSecond;
+	}
+
+	/*!
+	* \brief Sets the view of a client, used to filter entities when a position callback is set
+	*
+	* \param clientIndex Index of the client
+	* \param position Position of the client viewer
+	* \param radius Radius around the position where entities are replicated, infinity disables filtering
+	*/
+	void SnapshotReplicator::SetClientView(std::size_t clientIndex, const Vector3f& position, float radius)
+	{
+		NazaraAssert(clientIndex < m_clients.size() && m_clients[clientIndex], "invalid client index");
+		NazaraAssert(radius >= 0.f, "invalid radius");
+
+		ClientData& client = *m_clients[clientIndex];
+		client.viewPosition = position;
+		client.viewRadius = radius;
+	}
+
+	/*!
+	* \brief Sets the callback retrieving the position of entities, enabling interest management
+	*
+	* \param positionCallback Callback returning the position of an entity, or an empty callback to replicate every entity to every client
+	*/
+	void SnapshotReplicator::SetPositionCallback(PositionCallback positionCallback)
+	{
+		m_positionCallback = std::move(positionCallback);
+
+		m_spatialTree.Clear();
+		for (auto&& [networkId, entityData] : m_entities)
+		{
+			if (m_positionCallback)
+			{
+				entityData.position = m_positionCallback(m_registry, entityData.entity);
+				entityData.proxyId = m_spatialTree.AddProxy(Boxf(entityData.position, Vector3f::Zero()), networkId);
+			}
+			else
+				entityData.proxyId = DynamicAABBTree::InvalidProxy;
+		}
+	}
+
+	/*!
+	* \brief Stops replicating an entity, it will be despawned on clients with the next snapshots
+	*/
+	void SnapshotReplicator::StopReplicating(entt::entity entity)
+	{
+		auto it = m_networkIds.find(entity);
+		if (it == m_networkIds.end())
+			return;
+
+		UInt32 networkId = it->second;
+		m_networkIds.erase(it);
+
+		auto entityIt = m_entities.find(networkId);
+		if (entityIt->second.proxyId != DynamicAABBTree::InvalidProxy)
+			m_spatialTree.RemoveProxy(entityIt->second.proxyId);
+
+		m_entities.erase(entityIt);
+
+		for (auto& clientPtr : m_clients)
+		{
+			if (clientPtr)
+				clientPtr->priorities.erase(networkId);
+		}
+	}
+
+	/*!
+	* \brief Captures the state of every replicated entity, which is shared by all the snapshots built until next update
+	*/
+	void SnapshotReplicator::Update()
+	{
+		for (auto it = m_entities.begin(); it != m_entities.end();)
+		{
+			EntityData& entityData = it->second;
+			if (!m_registry.valid(entityData.entity))
+			{
+				m_networkIds.erase(entityData.entity);
+				if (entityData.proxyId != DynamicAABBTree::InvalidProxy)
+					m_spatialTree.RemoveProxy(entityData.proxyId);
+
+				for (auto& clientPtr : m_clients)
+				{
+					if (clientPtr)
+						clientPtr->priorities.erase(it->first);
+				}
+
+				it = m_entities.erase(it);
+				continue;
+			}
+
+			m_schema.ExtractState(m_registry, entityData.entity, entityData.state);
+
+			if (m_positionCallback)
+			{
+				entityData.position = m_positionCallback(m_registry, entityData.entity);
+				m_spatialTree.MoveProxy(entityData.proxyId, Boxf(entityData.position, Vector3f::Zero()));
+			}
+
+			++it;
+		}
+	}
+
+	bool SnapshotReplicator::ComputeBudget(ClientData& client, Time elapsedTime, std::size_t& budget)
+	{
+		UInt32 bandwidth = client.bandwidth;
+		if (client.peer && client.peer->GetIncomingBandwidth() != 0)
+			bandwidth = (bandwidth != 0) ? std::min(bandwidth, client.peer->GetIncomingBandwidth()) : client.peer->GetIncomingBandwidth();
+
+		if (bandwidth == 0)
+			return false;
+
+		// unused bandwidth can be spent later, up to one second worth of it
+		client.bandwidthCredit = std::min(client.bandwidthCredit + double(bandwidth) * elapsedTime.AsSeconds<double>(), double(bandwidth));
+
+		// scale it down when ENet throttles the peer because of packet loss
+		double credit = client.bandwidthCredit;
+		if (client.peer)
+			credit *= double(client.peer->GetPacketThrottle()) / ENetConstants::ENetPeer_PacketThrottleScale;
+
+		budget = (credit > 0.0) ? static_cast<std::size_t>(credit) : 0;
+		return true;
+	}
+}
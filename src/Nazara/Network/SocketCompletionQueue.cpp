@@ -0,0 +1,175 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Network/SocketCompletionQueue.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Network/TcpClient.hpp>
+#include <Nazara/Network/TcpServer.hpp>
+#include <memory>
+
+#if defined(NAZARA_PLATFORM_WINDOWS)
+#include <Nazara/Network/Win32/SocketImpl.hpp>
+#include <Nazara/Network/Win32/SocketCompletionQueueImpl.hpp>
+#elif defined(NAZARA_PLATFORM_LINUX)
+#include <Nazara/Network/Posix/SocketImpl.hpp>
+#include <Nazara/Network/Linux/SocketCompletionQueueImpl.hpp>
+#elif defined(NAZARA_PLATFORM_POSIX)
+#include <Nazara/Network/Posix/SocketImpl.hpp>
+#include <Nazara/Network/Posix/SocketCompletionQueueImpl.hpp>
+#else
+#error Missing implementation: SocketCompletionQueue
+#endif
+
+#include <Nazara/Network/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup network
+	* \class Nz::SocketCompletionQueue
+	* \brief Network class running socket operations asynchronously and reporting their completion through callbacks
+	*
+	* Unlike SocketPoller, which reports sockets ready to be read or written, this class submits the operations themselves
+	* and calls back once they are done, which saves a system call per operation and allows the system to batch them.
+	* It is backed by io_uring on Linux (6.0 or newer), with multishot accept and receive operations filling buffers
+	* registered to the kernel, and by I/O completion ports on Windows. Other platforms emulate it using poll.
+	*
+	* Callbacks are only called from Process, on the thread calling it. Sockets must be stopped (see Stop) before being
+	* closed or destroyed.
+	*/
+
+	/*!
+	* \brief Constructs an invalid completion queue, Create has to be called before using it
+	*/
+	SocketCompletionQueue::SocketCompletionQueue() = default;
+
+	/*!
+	* \brief Destroys the queue, stopping every socket operation on it
+	*/
+	SocketCompletionQueue::~SocketCompletionQueue()
+	{
+		Destroy();
+	}
+
+	/*!
+	* \brief Creates the completion queue
+	* \return True if the queue was created
+	*
+	* \param receiveBufferSize Size of each receive buffer, which is the maximum size of data reported by a receive callback call
+	* \param receiveBufferCount Number of receive buffers shared by every receiving socket (may be rounded up)
+	*
+	* \remark Produces a NazaraError if the system backend isn't available (e.g. io_uring disabled or kernel too old)
+	*/
+	bool SocketCompletionQueue::Create(std::size_t receiveBufferSize, std::size_t receiveBufferCount)
+	{
+		NazaraAssert(receiveBufferSize > 0, "receive buffer size must be over zero");
+		NazaraAssert(receiveBufferCount > 0, "receive buffer count must be over zero");
+
+		Destroy();
+
+		std::unique_ptr<SocketCompletionQueueImpl> impl = std::make_unique<SocketCompletionQueueImpl>();
+		if (!impl->Create(receiveBufferSize, receiveBufferCount))
+			return false;
+
+		m_impl = impl.release();
+		return true;
+	}
+
+	/*!
+	* \brief Destroys the completion queue, pending operations are cancelled and their callbacks won't be called
+	*/
+	void SocketCompletionQueue::Destroy()
+	{
+		delete m_impl;
+		m_impl = nullptr;
+	}
+
+	/*!
+	* \brief Waits for operations to complete and calls their callbacks
+	* \return Number of completed operations
+	*
+	* \param msTimeout Maximum time to wait for a completion in milliseconds, 0 returns immediately and a negative value waits indefinitely
+	* \param error If valid, this will be set to the error which occurred while waiting
+	*/
+	unsigned int SocketCompletionQueue::Process(int msTimeout, SocketError* error)
+	{
+		NazaraAssert(m_impl, "completion queue has not been created");
+
+		return m_impl->Process(msTimeout, error);
+	}
+
+	/*!
+	* \brief Sends data through a connected client
+	* \return True if the operation was submitted
+	*
+	* Data is sent entirely unless an error occurs, sends submitted on the same socket are completed in order.
+	*
+	* \param client Connected client
+	* \param data Data to send, which must stay valid until the callback is called (or the socket is stopped)
+	* \param size Size of the data
+	* \param callback Optional callback receiving the number of bytes sent
+	*/
+	bool SocketCompletionQueue::Send(TcpClient& client, const void* data, std::size_t size, SendCallback callback)
+	{
+		NazaraAssert(m_impl, "completion queue has not been created");
+		NazaraAssert(client.GetNativeHandle() != SocketImpl::InvalidHandle, "invalid client");
+
+		return m_impl->Send(client.GetNativeHandle(), data, size, std::move(callback));
+	}
+
+	/*!
+	* \brief Starts accepting clients on a listening server
+	* \return True if the operation was submitted
+	*
+	* \param server Listening server
+	* \param callback Callback receiving every accepted client
+	*/
+	bool SocketCompletionQueue::StartAccepting(TcpServer& server, AcceptCallback callback)
+	{
+		NazaraAssert(m_impl, "completion queue has not been created");
+		NazaraAssert(server.GetNativeHandle() != SocketImpl::InvalidHandle, "server is not listening");
+		NazaraAssert(callback, "invalid callback");
+
+		return m_impl->StartAccepting(server.GetNativeHandle(), [callback = std::move(callback)](SocketHandle handle, const IpAddress& address)
+		{
+			TcpClient client;
+			client.Reset(handle, address);
+
+			callback(std::move(client));
+		});
+	}
+
+	/*!
+	* \brief Starts receiving data from a connected client
+	* \return True if the operation was submitted
+	*
+	* The callback is called with every received chunk of data, which is only valid during the call.
+	* Receiving stops when an error occurs or the connection is closed (reported as SocketError::ConnectionClosed).
+	*
+	* \param client Connected client
+	* \param callback Callback receiving data
+	*/
+	bool SocketCompletionQueue::StartReceiving(TcpClient& client, ReceiveCallback callback)
+	{
+		NazaraAssert(m_impl, "completion queue has not been created");
+		NazaraAssert(client.GetNativeHandle() != SocketImpl::InvalidHandle, "invalid client");
+		NazaraAssert(callback, "invalid callback");
+
+		return m_impl->StartReceiving(client.GetNativeHandle(), std::move(callback));
+	}
+
+	/*!
+	* \brief Cancels every operation of a socket, their callbacks won't be called
+	*
+	* \param socket Socket to stop
+	*
+	* \remark This must be called before closing a socket used with this queue
+	*/
+	void SocketCompletionQueue::Stop(AbstractSocket& socket)
+	{
+		NazaraAssert(m_impl, "completion queue has not been created");
+
+		m_impl->Stop(socket.GetNativeHandle());
+	}
+}
@@ -131,20 +131,24 @@ namespace Nz
 	*
 	* \remark It is an error to register a socket twice in the same SocketPoller.
 	* \remark The socket should not be freed while it is registered in the SocketPooler.
+	* \remark Edge-triggered sockets must be read (or written) until the operation would block, as readiness is not reported again before that.
+	*         It is only supported by epoll (Linux), other systems fall back to level-triggered mode which may report readiness more often.
 	*
 	* \param socket Reference to the socket to register
 	* \param eventFlags Socket events to watch
+	* \param userdata Pointer reported along with the socket events by Wait
+	* \param pollMode Whether readiness should be reported on every wait or only when it changes
 	*
 	* \return True if the socket is registered, false otherwise
 	*
 	* \see IsRegistered
 	* \see UnregisterSocket
 	*/
-	bool SocketPoller::RegisterSocket(AbstractSocket& socket, SocketPollEventFlags eventFlags)
+	bool SocketPoller::RegisterSocket(AbstractSocket& socket, SocketPollEventFlags eventFlags, void* userdata, SocketPollMode pollMode)
 	{
 		NazaraAssert(!IsRegistered(socket), "This socket is already registered in this SocketPoller");
 
-		return m_impl->RegisterSocket(socket.GetNativeHandle(), eventFlags);
+		return m_impl->RegisterSocket(socket.GetNativeHandle(), eventFlags, userdata, pollMode);
 	}
 
 	/*!
@@ -205,4 +209,45 @@ namespace Nz
 
 		return readySockets > 0;
 	}
+
+	/*!
+	* \brief Wait until any registered socket switches to a ready state and retrieves the ready sockets
+	*
+	* Waits a specific/undetermined amount of time until at least one socket part of the SocketPoller becomes ready, and fills events with every ready socket
+	* (up to maxEventCount), along with the userdata they were registered with. Sockets which didn't fit will be reported by the next call.
+	*
+	* Unlike the other Wait overload, this doesn't update the state queried by IsReadyToRead/IsReadyToWrite, which saves the lookup of every socket.
+	*
+	* \param msTimeout Maximum time to wait in milliseconds, 0 will returns immediately and -1 will block indefinitely
+	* \param events Array receiving ready socket events
+	* \param maxEventCount Size of the events array
+	* \param error If valid, this will be used to report the error status from the poller (if no error occurred, a value of NoError will be reported).
+	*
+	* \return The number of events written to the events array (may be zero if no socket is ready or if an error occurred)
+	*
+	* \remark In case of error, a NazaraError is triggered (except for interrupted errors)
+	*
+	* \see RegisterSocket
+	*/
+	unsigned int SocketPoller::Wait(int msTimeout, SocketPollerEvent* events, std::size_t maxEventCount, SocketError* error)
+	{
+		NazaraAssert(events && maxEventCount > 0, "invalid events array");
+
+		SocketError waitError;
+
+		unsigned int eventCount = m_impl->Wait(msTimeout, events, maxEventCount, &waitError);
+
+		if (error)
+			*error = waitError;
+
+		if (waitError != SocketError::NoError)
+		{
+			if (waitError != SocketError::Interrupted) //< Do not log interrupted error
+				NazaraError("SocketPoller encountered an error (code: {0:#x}): {1}", UnderlyingCast(waitError), ErrorToString(waitError));
+
+			return 0;
+		}
+
+		return eventCount;
+	}
 }
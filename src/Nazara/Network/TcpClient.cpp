@@ -5,8 +5,13 @@
 #include <Nazara/Network/TcpClient.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/StringExt.hpp>
+#include <Nazara/Network/NetBuffer.hpp>
 #include <Nazara/Network/NetPacket.hpp>
 #include <NazaraUtils/CallOnExit.hpp>
+#include <NazaraUtils/MathUtils.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <limits>
 
 #if defined(NAZARA_PLATFORM_WINDOWS)
@@ -97,6 +102,27 @@ namespace Nz
 		return Connect(hostnameAddress);
 	}
 
+	/*!
+	* \brief Enables corking of the send queue
+	*
+	* While corked, FlushSendQueue doesn't send anything so a burst of queued packets can be sent at once, in as few segments as possible.
+	* Uncorking flushes the send queue.
+	*
+	* \param corking Should the send queue be corked
+	*
+	* \see QueueSend
+	*/
+
+	void TcpClient::EnableCorking(bool corking)
+	{
+		if (m_isCorkingEnabled == corking)
+			return;
+
+		m_isCorkingEnabled = corking;
+		if (!corking && m_sendRingSize > 0 && m_handle != SocketImpl::InvalidHandle)
+			FlushSendQueue();
+	}
+
 	/*!
 	* \brief Enables low delay in emitting
 	*
@@ -137,6 +163,66 @@ namespace Nz
 		}
 	}
 
+	/*!
+	* \brief Sends as much of the send queue as the socket accepts
+	* \return true If no error occurred (even if the queue couldn't be entirely sent)
+	*
+	* Queued data is sent with scatter-gather I/O (at most two buffers as the queue is a ring), so many small packets only cost a single system call.
+	* With a non-blocking socket, this should be called when the socket becomes writable (see SocketPoller) until the queue is empty.
+	*
+	* \remark Doesn't send anything while corking is enabled
+	* \remark Produces a NazaraAssert if socket is invalid
+	*
+	* \see QueueSend
+	*/
+
+	bool TcpClient::FlushSendQueue()
+	{
+		NazaraAssert(m_handle != SocketImpl::InvalidHandle, "Invalid handle");
+
+		if (m_isCorkingEnabled)
+			return true;
+
+		while (m_sendRingSize > 0)
+		{
+			std::size_t ringCapacity = m_sendRing.size();
+			std::size_t firstSize = std::min(m_sendRingSize, ringCapacity - m_sendRingBegin);
+
+			std::array<NetBuffer, 2> buffers;
+			buffers[0].data = &m_sendRing[m_sendRingBegin];
+			buffers[0].dataLength = firstSize;
+
+			std::size_t bufferCount = 1;
+			if (firstSize < m_sendRingSize)
+			{
+				buffers[1].data = &m_sendRing[0];
+				buffers[1].dataLength = m_sendRingSize - firstSize;
+				bufferCount++;
+			}
+
+			std::size_t sent;
+			if (!SendMultiple(buffers.data(), bufferCount, &sent))
+				return false;
+
+			if (sent == 0)
+				break; //< Would block
+
+			m_sendRingBegin = (m_sendRingBegin + sent) % ringCapacity;
+			m_sendRingSize -= sent;
+		}
+
+		if (m_sendRingSize == 0)
+			m_sendRingBegin = 0;
+
+		if (m_isSendQueueAboveHighWatermark && m_sendRingSize <= m_sendLowWatermark)
+		{
+			m_isSendQueueAboveHighWatermark = false;
+			OnSendQueueLowWatermark(this, m_sendRingSize);
+		}
+
+		return true;
+	}
+
 	/*!
 	* \brief Gets the size of the raw memory available
 	* \return Size of the memory available
@@ -191,6 +277,87 @@ namespace Nz
 		return m_state;
 	}
 
+	/*!
+	* \brief Queues data to be sent by the next FlushSendQueue call
+	*
+	* Data is copied in the send queue of the client, coalescing it with previously queued data.
+	* Unlike Send, this never blocks nor sends partially, the queue grows as needed.
+	*
+	* \param buffer Raw memory to send
+	* \param size Size of the buffer
+	*
+	* \remark OnSendQueueHighWatermark is triggered if the queue grows over the high watermark
+	* \remark Produces a NazaraAssert if buffer and its size is invalid
+	*
+	* \see FlushSendQueue
+	* \see SetSendQueueWatermarks
+	*/
+
+	void TcpClient::QueueSend(const void* buffer, std::size_t size)
+	{
+		NazaraAssert(buffer && size > 0, "Invalid buffer");
+
+		std::size_t ringCapacity = m_sendRing.size();
+		if (m_sendRingSize + size > ringCapacity)
+		{
+			// Grow the ring and unwrap queued data at the same time
+			std::vector<UInt8> newRing(std::max<std::size_t>(RoundToPow2(m_sendRingSize + size), 4096));
+
+			std::size_t firstSize = std::min(m_sendRingSize, ringCapacity - m_sendRingBegin);
+			if (firstSize > 0)
+				std::memcpy(&newRing[0], &m_sendRing[m_sendRingBegin], firstSize);
+
+			if (firstSize < m_sendRingSize)
+				std::memcpy(&newRing[firstSize], &m_sendRing[0], m_sendRingSize - firstSize);
+
+			m_sendRing = std::move(newRing);
+			m_sendRingBegin = 0;
+			ringCapacity = m_sendRing.size();
+		}
+
+		const UInt8* data = static_cast<const UInt8*>(buffer);
+
+		std::size_t writeOffset = (m_sendRingBegin + m_sendRingSize) % ringCapacity;
+		std::size_t firstSize = std::min(size, ringCapacity - writeOffset);
+		std::memcpy(&m_sendRing[writeOffset], data, firstSize);
+		if (firstSize < size)
+			std::memcpy(&m_sendRing[0], data + firstSize, size - firstSize);
+
+		m_sendRingSize += size;
+
+		if (!m_isSendQueueAboveHighWatermark && m_sendRingSize > m_sendHighWatermark)
+		{
+			m_isSendQueueAboveHighWatermark = true;
+			OnSendQueueHighWatermark(this, m_sendRingSize);
+		}
+	}
+
+	/*!
+	* \brief Queues a packet to be sent by the next FlushSendQueue call
+	* \return true If the packet was queued
+	*
+	* \param packet Packet to send
+	*
+	* \remark Produces a NazaraError if packet could not be prepared for sending
+	*
+	* \see QueueSend
+	*/
+
+	bool TcpClient::QueueSendPacket(const NetPacket& packet)
+	{
+		std::size_t size = 0;
+		const UInt8* ptr = static_cast<const UInt8*>(packet.OnSend(&size));
+		if (!ptr)
+		{
+			m_lastError = SocketError::Packet;
+			NazaraError("Failed to prepare packet");
+			return false;
+		}
+
+		QueueSend(ptr, size);
+		return true;
+	}
+
 	/*!
 	* \brief Receives the data available
 	* \return true If data received
@@ -501,6 +668,11 @@ namespace Nz
 
 		m_openMode = OpenMode::NotOpen;
 		m_peerAddress = IpAddress::Invalid;
+
+		// Queued data can't be sent anymore
+		m_sendRingBegin = 0;
+		m_sendRingSize = 0;
+		m_isSendQueueAboveHighWatermark = false;
 	}
 
 	/*!
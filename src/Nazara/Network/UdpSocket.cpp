@@ -5,6 +5,7 @@
 #include <Nazara/Network/UdpSocket.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/StringExt.hpp>
+#include <Nazara/Network/NetDatagram.hpp>
 #include <Nazara/Network/NetPacket.hpp>
 
 #if defined(NAZARA_PLATFORM_WINDOWS)
@@ -67,6 +68,25 @@ namespace Nz
 		}
 	}
 
+	/*!
+	* \brief Allows multiple sockets to bind the same address and port
+	* \return true If the option was set
+	*
+	* \param reusePort Should the port be reusable
+	*
+	* When enabled on every socket bound to an address, the system balances incoming datagrams between them
+	* (hashing the sender address), so that a peer always reaches the same socket.
+	*
+	* \remark This must be set before binding the socket
+	* \remark This relies on SO_REUSEPORT, which is not supported on Windows
+	*/
+	bool UdpSocket::EnablePortReuse(bool reusePort)
+	{
+		NazaraAssert(m_handle != SocketImpl::InvalidHandle, "Invalid handle");
+
+		return SocketImpl::SetReusePort(m_handle, reusePort, &m_lastError);
+	}
+
 	/*!
 	* \brief Gets the maximum datagram size allowed
 	* \return Number of bytes
@@ -120,6 +140,25 @@ namespace Nz
 		return true;
 	}
 
+	/*!
+	* \brief Receives multiple datagrams at once, each one in its own NetDatagram
+	* \return true If no error occurred (even if no datagram was received)
+	*
+	* \param datagrams Datagrams to fill, buffers must be set and their dataLength is the maximum size of the datagram they can receive
+	* \param datagramCount Number of datagrams which can be received
+	* \param receivedCount Optional argument to get the number of datagrams received
+	*
+	* \remark On Linux, this uses a single system call for the whole batch
+	* \remark Truncated datagrams are received with a zero receivedLength
+	*/
+	bool UdpSocket::ReceiveBatch(NetDatagram* datagrams, std::size_t datagramCount, std::size_t* receivedCount)
+	{
+		NazaraAssert(m_handle != SocketImpl::InvalidHandle, "Socket hasn't been created");
+		NazaraAssert(datagrams && datagramCount > 0, "Invalid datagrams");
+
+		return SocketImpl::ReceiveBatch(m_handle, datagrams, datagramCount, receivedCount, &m_lastError);
+	}
+
 	/*!
 	* \brief Receive multiple datagram from one peer
 	* \return true If data were sent
@@ -233,6 +272,32 @@ namespace Nz
 		return true;
 	}
 
+	/*!
+	* \brief Sends multiple datagrams at once, possibly to different peers
+	* \return true If no error occurred
+	*
+	* \param datagrams Datagrams to send, with their destination address (must match socket protocol)
+	* \param datagramCount Number of datagrams to send
+	* \param sentCount Optional argument to get the number of datagrams sent, can be lower than datagramCount if the send buffer is full
+	*
+	* \remark On Linux, this uses a single system call for the whole batch
+	* \remark If an error occurs after some datagrams were sent, this returns true and the error is reported on the next call
+	*/
+	bool UdpSocket::SendBatch(const NetDatagram* datagrams, std::size_t datagramCount, std::size_t* sentCount)
+	{
+		NazaraAssert(m_handle != SocketImpl::InvalidHandle, "Socket hasn't been created");
+		NazaraAssert(datagrams && datagramCount > 0, "Invalid datagrams");
+#ifdef NAZARA_DEBUG
+		for (std::size_t i = 0; i < datagramCount; ++i)
+		{
+			NazaraAssert(datagrams[i].address.IsValid(), "Invalid ip address");
+			NazaraAssert(datagrams[i].address.GetProtocol() == m_protocol, "IP Address has a different protocol than the socket");
+		}
+#endif
+
+		return SocketImpl::SendBatch(m_handle, datagrams, datagramCount, sentCount, &m_lastError);
+	}
+
 	/*!
 	* \brief Sends multiple buffers as one datagram
 	* \return true If data were sent
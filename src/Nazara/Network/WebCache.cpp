@@ -0,0 +1,179 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Network/WebCache.hpp>
+#include <Nazara/Core/Algorithm.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/ByteStream.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Core/File.hpp>
+#include <fmt/format.h>
+#include <chrono>
+#include <system_error>
+#include <Nazara/Network/Debug.hpp>
+
+namespace Nz
+{
+	NAZARA_ANONYMOUS_NAMESPACE
+	{
+		constexpr UInt32 s_cacheEntryMagic = 0x4E574345; //< "NWCE"
+		constexpr UInt32 s_cacheEntryVersion = 1;
+	}
+
+	/*!
+	* \ingroup network
+	* \class WebCache
+	* \brief Network class that stores HTTP responses on disk along with their validators (ETag/Last-Modified)
+	*
+	* Entries are indexed by URL, each one of them being stored in its own file in the cache directory.
+	* This is used by WebService to serve fresh responses without any transfer and to turn other requests into conditional ones.
+	*/
+
+	/*!
+	* \brief Constructs a WebCache storing its entries in a directory, which is created if it doesn't exist
+	*
+	* \param directory Cache directory
+	*/
+	WebCache::WebCache(std::filesystem::path directory) :
+	m_directory(std::move(directory))
+	{
+		std::error_code ec;
+		std::filesystem::create_directories(m_directory, ec);
+		if (ec)
+			throw std::runtime_error(fmt::format("failed to create web cache directory {0}: {1}", m_directory.generic_u8string(), ec.message()));
+	}
+
+	/*!
+	* \brief Removes every entry of the cache
+	*/
+	void WebCache::Clear()
+	{
+		std::error_code ec;
+		for (const auto& entry : std::filesystem::directory_iterator(m_directory, ec))
+		{
+			if (entry.path().extension() == ".cache")
+				std::filesystem::remove(entry.path(), ec);
+		}
+	}
+
+	/*!
+	* \brief Loads the cache entry of an URL
+	* \return Cached entry, or std::nullopt if this URL is not cached
+	*
+	* \param url URL of the resource
+	*
+	* \remark Corrupted entries are removed from the cache
+	*/
+	std::optional<WebCache::Entry> WebCache::Load(std::string_view url) const
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		std::filesystem::path entryPath = GetEntryPath(url);
+
+		std::error_code ec;
+		if (!std::filesystem::is_regular_file(entryPath, ec))
+			return std::nullopt;
+
+		std::optional<std::vector<UInt8>> content = File::ReadWhole(entryPath);
+		if (!content)
+			return std::nullopt;
+
+		try
+		{
+			ErrorFlags errFlags(ErrorMode::ThrowException | ErrorMode::Silent);
+
+			ByteStream stream(content->data(), content->size());
+
+			UInt32 magic, version;
+			stream >> magic >> version;
+			if (magic != s_cacheEntryMagic || version != s_cacheEntryVersion)
+				throw std::runtime_error("invalid header");
+
+			// Two URLs may share the same hash
+			std::string entryUrl;
+			stream >> entryUrl;
+			if (entryUrl != url)
+				return std::nullopt;
+
+			Entry entry;
+			stream >> entry.etag >> entry.lastModified >> entry.expirationTime >> entry.body;
+
+			return entry;
+		}
+		catch (const std::exception& e)
+		{
+			NazaraWarning(fmt::format("removing corrupted web cache entry {0}: {1}", entryPath.generic_u8string(), e.what()));
+			std::filesystem::remove(entryPath, ec);
+
+			return std::nullopt;
+		}
+	}
+
+	/*!
+	* \brief Removes the cache entry of an URL, if any
+	*
+	* \param url URL of the resource
+	*/
+	void WebCache::Remove(std::string_view url)
+	{
+		std::error_code ec;
+		std::filesystem::remove(GetEntryPath(url), ec);
+	}
+
+	/*!
+	* \brief Stores (or replaces) the cache entry of an URL
+	* \return True if the entry was written successfully
+	*
+	* \param url URL of the resource
+	* \param entry Response body and validators
+	*
+	* \remark The entry is written to a temporary file first, so a concurrent or interrupted write never leaves a truncated entry behind
+	*/
+	bool WebCache::Store(std::string_view url, const Entry& entry)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		std::filesystem::path entryPath = GetEntryPath(url);
+		std::filesystem::path tempPath = entryPath;
+		tempPath.replace_extension(".tmp");
+
+		{
+			File file(tempPath, OpenMode::WriteOnly | OpenMode::Truncate);
+			if (!file.IsOpen())
+			{
+				NazaraError(fmt::format("failed to open web cache entry {0}", tempPath.generic_u8string()));
+				return false;
+			}
+
+			ByteStream stream(&file);
+			stream << s_cacheEntryMagic << s_cacheEntryVersion;
+			stream << std::string(url) << entry.etag << entry.lastModified << entry.expirationTime << entry.body;
+		}
+
+		std::error_code ec;
+		std::filesystem::rename(tempPath, entryPath, ec);
+		if (ec)
+		{
+			NazaraError(fmt::format("failed to write web cache entry {0}: {1}", entryPath.generic_u8string(), ec.message()));
+			std::filesystem::remove(tempPath, ec);
+			return false;
+		}
+
+		return true;
+	}
+
+	/*!
+	* \brief Returns the current time as an unix timestamp, in seconds, as used by entries expiration times
+	*/
+	Int64 WebCache::GetCurrentTimestamp()
+	{
+		return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+	}
+
+	std::filesystem::path WebCache::GetEntryPath(std::string_view url) const
+	{
+		return m_directory / (ComputeHash(HashType::SHA1, url).ToHex() + ".cache");
+	}
+}
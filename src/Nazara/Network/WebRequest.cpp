@@ -3,6 +3,8 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Network/WebRequest.hpp>
+#include <Nazara/Core/StringExt.hpp>
+#include <Nazara/Network/IpAddress.hpp>
 #include <Nazara/Network/WebService.hpp>
 #include <cstring>
 
@@ -19,15 +21,31 @@ namespace Nz
 #ifndef NAZARA_PLATFORM_WEB
 	WebRequest::WebRequest(WebService& webService) :
 	m_webService(webService),
+	m_isCacheEnabled(true),
+	m_isGetRequest(false),
+	m_isResponseFromCache(false),
+	m_isResponseStorable(true),
 	m_isUserAgentSet(false)
 	{
 		auto& libcurl = m_webService.GetCurlLibrary();
 
 		m_curlHandle = libcurl.easy_init();
+
+		// Prefer HTTP/2 over TLS, and wait for an existing connection to the same host to be multiplexed on rather than opening a new one
+		libcurl.easy_setopt(m_curlHandle, CURLOPT_HTTP_VERSION, long(CURL_HTTP_VERSION_2TLS));
+		libcurl.easy_setopt(m_curlHandle, CURLOPT_PIPEWAIT, long(1));
+		libcurl.easy_setopt(m_curlHandle, CURLOPT_TCP_KEEPALIVE, long(1));
+
+		// curl resolves hostnames itself, keep its DNS cache in sync with the one of IpAddress
+		libcurl.easy_setopt(m_curlHandle, CURLOPT_DNS_CACHE_TIMEOUT, long(IpAddress::GetResolveCacheDuration().AsMilliseconds() / 1000));
 	}
 #else
 	WebRequest::WebRequest(WebService& webService) :
 	m_webService(webService),
+	m_isCacheEnabled(true),
+	m_isGetRequest(false),
+	m_isResponseFromCache(false),
+	m_isResponseStorable(true),
 	m_isUserAgentSet(false)
 	{
 	}
@@ -130,9 +148,9 @@ namespace Nz
 #ifndef NAZARA_PLATFORM_WEB
 		auto& libcurl = m_webService.GetCurlLibrary();
 		libcurl.easy_setopt(m_curlHandle, CURLOPT_URL, url.data());
-#else
-		m_url = url;
 #endif
+
+		m_url = url;
 	}
 
 	void WebRequest::SetupGet()
@@ -143,6 +161,8 @@ namespace Nz
 #else
 		m_httpMethod = "GET";
 #endif
+
+		m_isGetRequest = true;
 	}
 
 	void WebRequest::SetupPost()
@@ -153,9 +173,59 @@ namespace Nz
 #else
 		m_httpMethod = "POST";
 #endif
+
+		m_isGetRequest = false;
 	}
 
 #ifndef NAZARA_PLATFORM_WEB
+	void WebRequest::OnHeaderResponse(std::string_view header)
+	{
+		// A new response begins (after a redirection or an informational response), headers of the previous one are irrelevant
+		if (StartsWith(header, "HTTP/"))
+		{
+			m_responseCacheEntry = WebCache::Entry{};
+			m_isResponseStorable = true;
+			return;
+		}
+
+		std::size_t separatorPos = header.find(':');
+		if (separatorPos == header.npos)
+			return;
+
+		std::string_view name = Trim(header.substr(0, separatorPos));
+		std::string_view value = Trim(header.substr(separatorPos + 1));
+
+		if (StringEqual(name, "ETag", CaseIndependent{}))
+			m_responseCacheEntry.etag = value;
+		else if (StringEqual(name, "Last-Modified", CaseIndependent{}))
+			m_responseCacheEntry.lastModified = value;
+		else if (StringEqual(name, "Cache-Control", CaseIndependent{}))
+		{
+			long long maxAge = 0;
+			bool mustRevalidate = false;
+			SplitString(value, ",", [&](std::string_view directive)
+			{
+				directive = Trim(directive);
+				if (StringEqual(directive, "no-store", CaseIndependent{}))
+					m_isResponseStorable = false;
+				else if (StringEqual(directive, "no-cache", CaseIndependent{}))
+					mustRevalidate = true;
+				else if (StartsWith(directive, "max-age=", CaseIndependent{}))
+				{
+					bool ok;
+					long long seconds = StringToNumber(directive.substr(8), 10, &ok);
+					if (ok)
+						maxAge = seconds;
+				}
+
+				return true;
+			});
+
+			// Responses without a positive max-age can still be stored, but have to be revalidated before being used
+			m_responseCacheEntry.expirationTime = (!mustRevalidate && maxAge > 0) ? WebCache::GetCurrentTimestamp() + maxAge : 0;
+		}
+	}
+
 	CURL* WebRequest::Prepare()
 	{
 		if (!m_isUserAgentSet)
@@ -179,6 +249,61 @@ namespace Nz
 
 		return m_curlHandle;
 	}
+
+	void WebRequest::PrepareCacheRevalidation(WebCache::Entry&& cachedEntry)
+	{
+		// The server answers 304 (with an empty body) if the resource didn't change since it was cached
+		if (!cachedEntry.etag.empty())
+			SetHeader("If-None-Match", cachedEntry.etag);
+
+		if (!cachedEntry.lastModified.empty())
+			SetHeader("If-Modified-Since", cachedEntry.lastModified);
+
+		m_cachedEntry = std::move(cachedEntry);
+	}
+
+	void WebRequest::UpdateCache(WebCache& cache)
+	{
+		auto& libcurl = m_webService.GetCurlLibrary();
+
+		long responseCode = 0;
+		libcurl.easy_getinfo(m_curlHandle, CURLINFO_RESPONSE_CODE, &responseCode);
+
+		if (responseCode == 304 && m_cachedEntry)
+		{
+			// Not modified, serve the cached body and refresh the entry with the new validators and expiration time
+			WebCache::Entry& entry = *m_cachedEntry;
+			entry.expirationTime = m_responseCacheEntry.expirationTime;
+			if (!m_responseCacheEntry.etag.empty())
+				entry.etag = std::move(m_responseCacheEntry.etag);
+
+			if (!m_responseCacheEntry.lastModified.empty())
+				entry.lastModified = std::move(m_responseCacheEntry.lastModified);
+
+			if (m_isResponseStorable)
+				cache.Store(m_url, entry);
+			else
+				cache.Remove(m_url);
+
+			m_responseBody = std::move(entry.body);
+			m_isResponseFromCache = true;
+		}
+		else if (responseCode == 200)
+		{
+			// Responses which can neither be revalidated nor reused as-is are not worth storing
+			bool hasValidator = !m_responseCacheEntry.etag.empty() || !m_responseCacheEntry.lastModified.empty();
+			if (m_isResponseStorable && (hasValidator || m_responseCacheEntry.IsFresh()))
+			{
+				m_responseCacheEntry.body = std::move(m_responseBody);
+				cache.Store(m_url, m_responseCacheEntry);
+				m_responseBody = std::move(m_responseCacheEntry.body);
+			}
+			else
+				cache.Remove(m_url);
+		}
+
+		m_cachedEntry.reset();
+	}
 #else
 	emscripten_fetch_t* WebRequest::Prepare(emscripten_fetch_attr_t* fetchAttr)
 	{
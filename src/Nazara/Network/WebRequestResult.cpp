@@ -54,6 +54,10 @@ namespace Nz
 #ifndef NAZARA_PLATFORM_WEB
 		assert(HasSucceeded());
 
+		// Conditional requests answered by a 304 are reported as the cached response they revalidated
+		if (m_isFromCache)
+			return 200;
+
 		auto& libcurl = m_webService.GetCurlLibrary();
 
 		long responseCode;
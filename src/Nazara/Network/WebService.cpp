@@ -5,12 +5,14 @@
 #include <Nazara/Network/WebService.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/ErrorFlags.hpp>
+#include <NazaraUtils/Algorithm.hpp>
 #ifndef NAZARA_PLATFORM_WEB
 #include <Nazara/Network/CurlLibrary.hpp>
 #else
 #include <emscripten/fetch.h>
 #endif
 #include <fmt/format.h>
+#include <algorithm>
 #include <Nazara/Network/Debug.hpp>
 
 namespace Nz
@@ -24,6 +26,8 @@ namespace Nz
 		m_userAgent = fmt::format("Nazara WebService - curl/{}", curlVersionData->version);
 
 		m_curlMulti = m_curl.multi_init();
+
+		EnableMultiplexing(true);
 	}
 #else
 	WebService::WebService() :
@@ -45,21 +49,102 @@ namespace Nz
 #endif
 	}
 
+#ifndef NAZARA_PLATFORM_WEB
+	/*!
+	* \brief Disables the response cache, previously cached responses are kept on disk
+	*
+	* \remark This must not be called while requests are pending
+	*/
+	void WebService::DisableCache()
+	{
+		NazaraAssert(m_activeRequests.empty() && m_cachedRequests.empty(), "cache cannot be disabled while requests are pending");
+		m_cache.reset();
+	}
+
+	/*!
+	* \brief Enables an on-disk cache for GET requests responses
+	*
+	* Responses are stored along with their ETag/Last-Modified validators and Cache-Control max-age, unless Cache-Control forbids it (no-store).
+	* Fresh responses are then served without reaching the server while stale ones are revalidated by a conditional request (If-None-Match/If-Modified-Since),
+	* the cached body being used if the server answers 304 (not modified).
+	*
+	* \param cacheDirectory Directory where responses are stored, created if it doesn't exist
+	*
+	* \remark This must not be called while requests are pending
+	* \remark Produces a std::runtime_error if the cache directory cannot be created
+	*
+	* \see WebRequest::EnableCache, WebRequestResult::IsFromCache
+	*/
+	void WebService::EnableCache(std::filesystem::path cacheDirectory)
+	{
+		NazaraAssert(m_activeRequests.empty() && m_cachedRequests.empty(), "cache cannot be enabled while requests are pending");
+		m_cache = std::make_unique<WebCache>(std::move(cacheDirectory));
+	}
+
+	/*!
+	* \brief Enables or disables HTTP/2 multiplexing, allowing concurrent requests to the same host to share a connection
+	*
+	* Multiplexing is enabled by default.
+	*/
+	void WebService::EnableMultiplexing(bool enable)
+	{
+		assert(m_curlMulti);
+		m_curl.multi_setopt(m_curlMulti, CURLMOPT_PIPELINING, (enable) ? long(CURLPIPE_MULTIPLEX) : long(CURLPIPE_NOTHING));
+	}
+#else
+	void WebService::DisableCache()
+	{
+		// Handled by the browser
+	}
+
+	void WebService::EnableCache(std::filesystem::path /*cacheDirectory*/)
+	{
+		// Handled by the browser
+	}
+
+	void WebService::EnableMultiplexing(bool /*enable*/)
+	{
+		// Handled by the browser
+	}
+#endif
+
 	bool WebService::Poll()
 	{
 #ifndef NAZARA_PLATFORM_WEB
 		assert(m_curlMulti);
 
+		bool finishedRequest = false;
+
+		// Requests served from the cache without any transfer, callbacks may queue other requests
+		if (!m_cachedRequests.empty())
+		{
+			std::vector<std::unique_ptr<WebRequest>> cachedRequests;
+			std::swap(cachedRequests, m_cachedRequests);
+
+			for (auto& request : cachedRequests)
+				request->TriggerSuccessCallback();
+
+			finishedRequest = true;
+		}
+
+		// Resume paused transfers, curl submits pending data again from this call (which may pause them again)
+		if (!m_pausedRequests.empty())
+		{
+			std::vector<CURL*> pausedRequests;
+			std::swap(pausedRequests, m_pausedRequests);
+
+			for (CURL* handle : pausedRequests)
+				m_curl.easy_pause(handle, CURLPAUSE_CONT);
+		}
+
 		int reportedActiveRequest;
 		CURLMcode err = m_curl.multi_perform(m_curlMulti, &reportedActiveRequest);
 		if (err != CURLM_OK)
 		{
 			NazaraError(fmt::format("[WebService] curl_multi_perform failed with {0}: {1}", UnderlyingCast(err), m_curl.multi_strerror(err)));
-			return false;
+			return finishedRequest;
 		}
 
-		bool finishedRequest = false;
-
 		CURLMsg* m;
 		do
 		{
@@ -75,12 +160,22 @@ namespace Nz
 				WebRequest& request = *it->second;
 
 				if (m->data.result == CURLE_OK)
+				{
+					if (m_cache && request.IsCacheable())
+						request.UpdateCache(*m_cache);
+
 					request.TriggerSuccessCallback();
+				}
 				else
 					request.TriggerErrorCallback(m_curl.easy_strerror(m->data.result));
 
 				m_curl.multi_remove_handle(m_curlMulti, handle);
 
+				// A paused transfer may still fail (e.g. on timeout)
+				auto pausedIt = std::find(m_pausedRequests.begin(), m_pausedRequests.end(), handle);
+				if (pausedIt != m_pausedRequests.end())
+					m_pausedRequests.erase(pausedIt);
+
 				m_activeRequests.erase(handle);
 
 				finishedRequest = true;
@@ -113,6 +208,25 @@ namespace Nz
 #ifndef NAZARA_PLATFORM_WEB
 		assert(m_curlMulti);
 
+		bool useCache = m_cache && request->IsCacheable();
+		if (useCache)
+		{
+			if (std::optional<WebCache::Entry> cachedEntry = m_cache->Load(request->m_url))
+			{
+				if (cachedEntry->IsFresh())
+				{
+					// No need to reach the server, the callback is triggered by the next Poll
+					request->m_responseBody = std::move(cachedEntry->body);
+					request->m_isResponseFromCache = true;
+
+					m_cachedRequests.push_back(std::move(request));
+					return;
+				}
+
+				request->PrepareCacheRevalidation(std::move(*cachedEntry));
+			}
+		}
+
 		CURL* handle = request->Prepare();
 
 		curl_write_callback writeCallback = [](char* ptr, std::size_t size, std::size_t nmemb, void* userdata) -> std::size_t
@@ -120,15 +234,57 @@ namespace Nz
 			WebRequest* request = static_cast<WebRequest*>(userdata);
 
 			std::size_t totalSize = size * nmemb;
-			if (!request->OnBodyResponse(ptr, totalSize))
-				return 0;
+			switch (request->OnBodyResponse(ptr, totalSize))
+			{
+				case WebRequestDataStatus::Abort:
+					return 0;
 
-			return totalSize;
+				case WebRequestDataStatus::Continue:
+					return totalSize;
+
+				case WebRequestDataStatus::Pause:
+					request->m_webService.m_pausedRequests.push_back(request->m_curlHandle);
+					return CURL_WRITEFUNC_PAUSE;
+			}
+
+			return 0;
 		};
 
 		m_curl.easy_setopt(handle, CURLOPT_WRITEFUNCTION, writeCallback);
 		m_curl.easy_setopt(handle, CURLOPT_WRITEDATA, request.get());
 
+		if (useCache)
+		{
+			// Response headers hold the validators and the Cache-Control directives
+			curl_write_callback headerCallback = [](char* ptr, std::size_t size, std::size_t nitems, void* userdata) -> std::size_t
+			{
+				WebRequest* request = static_cast<WebRequest*>(userdata);
+
+				std::size_t totalSize = size * nitems;
+				request->OnHeaderResponse(std::string_view(ptr, totalSize));
+
+				return totalSize;
+			};
+
+			m_curl.easy_setopt(handle, CURLOPT_HEADERFUNCTION, headerCallback);
+			m_curl.easy_setopt(handle, CURLOPT_HEADERDATA, request.get());
+		}
+
+		if (request->m_progressCallback)
+		{
+			curl_xferinfo_callback progressCallback = [](void* userdata, curl_off_t downloadTotal, curl_off_t downloadNow, curl_off_t /*uploadTotal*/, curl_off_t /*uploadNow*/) -> int
+			{
+				WebRequest* request = static_cast<WebRequest*>(userdata);
+				request->m_progressCallback(SafeCast<UInt64>(downloadNow), SafeCast<UInt64>(downloadTotal));
+
+				return 0;
+			};
+
+			m_curl.easy_setopt(handle, CURLOPT_XFERINFOFUNCTION, progressCallback);
+			m_curl.easy_setopt(handle, CURLOPT_XFERINFODATA, request.get());
+			m_curl.easy_setopt(handle, CURLOPT_NOPROGRESS, long(0));
+		}
+
 		m_activeRequests.emplace(handle, std::move(request));
 
 		m_curl.multi_add_handle(m_curlMulti, handle);
@@ -179,10 +335,71 @@ namespace Nz
 			});
 		};
 
+		attr.onprogress = [](emscripten_fetch_t* fetch)
+		{
+			WebService* service = static_cast<WebService*>(fetch->userData);
+
+			auto it = service->m_activeRequests.find(fetch);
+			if (it == service->m_activeRequests.end() || !it->second->m_progressCallback)
+				return;
+
+			it->second->m_progressCallback(fetch->dataOffset + fetch->numBytes, fetch->totalBytes);
+		};
+
 		attr.userData = this;
 
 		emscripten_fetch_t* handle = request->Prepare(&attr);
 		m_activeRequests.emplace(handle, std::move(request));
 #endif
 	}
+
+#ifndef NAZARA_PLATFORM_WEB
+	/*!
+	* \brief Sets the maximum number of idle connections kept open to be reused by later requests
+	*
+	* \param connectionCount Cache size, zero lets curl pick a size based on the number of requests
+	*/
+	void WebService::SetConnectionCacheSize(std::size_t connectionCount)
+	{
+		assert(m_curlMulti);
+		m_curl.multi_setopt(m_curlMulti, CURLMOPT_MAXCONNECTS, SafeCast<long>(connectionCount));
+	}
+
+	/*!
+	* \brief Sets the maximum number of simultaneous connections to a single host, additional requests are queued
+	*
+	* \param connectionCount Connection limit, zero means unlimited
+	*/
+	void WebService::SetMaxHostConnections(std::size_t connectionCount)
+	{
+		assert(m_curlMulti);
+		m_curl.multi_setopt(m_curlMulti, CURLMOPT_MAX_HOST_CONNECTIONS, SafeCast<long>(connectionCount));
+	}
+
+	/*!
+	* \brief Sets the maximum number of simultaneous connections, additional requests are queued
+	*
+	* \param connectionCount Connection limit, zero means unlimited
+	*/
+	void WebService::SetMaxTotalConnections(std::size_t connectionCount)
+	{
+		assert(m_curlMulti);
+		m_curl.multi_setopt(m_curlMulti, CURLMOPT_MAX_TOTAL_CONNECTIONS, SafeCast<long>(connectionCount));
+	}
+#else
+	void WebService::SetConnectionCacheSize(std::size_t /*connectionCount*/)
+	{
+		// Handled by the browser
+	}
+
+	void WebService::SetMaxHostConnections(std::size_t /*connectionCount*/)
+	{
+		// Handled by the browser
+	}
+
+	void WebService::SetMaxTotalConnections(std::size_t /*connectionCount*/)
+	{
+		// Handled by the browser
+	}
+#endif
 }
@@ -0,0 +1,484 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Network/Win32/SocketCompletionQueueImpl.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <Nazara/Network/Debug.hpp>
+
+namespace Nz
+{
+	SocketCompletionQueueImpl::SocketCompletionQueueImpl() :
+	m_receiveBufferSize(0),
+	m_completionPort(nullptr),
+	m_acceptEx(nullptr)
+	{
+	}
+
+	SocketCompletionQueueImpl::~SocketCompletionQueueImpl()
+	{
+		Release();
+	}
+
+	bool SocketCompletionQueueImpl::Create(std::size_t receiveBufferSize, std::size_t receiveBufferCount)
+	{
+		m_completionPort = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 1);
+		if (!m_completionPort)
+		{
+			NazaraError("failed to create I/O completion port: {0}", Error::GetLastSystemError());
+			return false;
+		}
+
+		// Every receive operation owns its buffer, the buffer count is only used to size the completion batch
+		m_receiveBufferSize = receiveBufferSize;
+		m_completionEntries.resize(std::clamp<std::size_t>(receiveBufferCount, 16, 1024));
+
+		return true;
+	}
+
+	unsigned int SocketCompletionQueueImpl::Process(int msTimeout, SocketError* error)
+	{
+		ULONG entryCount = 0;
+		if (!GetQueuedCompletionStatusEx(m_completionPort, m_completionEntries.data(), SafeCast<ULONG>(m_completionEntries.size()), &entryCount, (msTimeout >= 0) ? DWORD(msTimeout) : INFINITE, FALSE))
+		{
+			DWORD errorCode = GetLastError();
+			if (errorCode == WAIT_TIMEOUT)
+			{
+				if (error)
+					*error = SocketError::NoError;
+
+				return 0;
+			}
+
+			NazaraError("failed to retrieve completions: {0}", Error::GetLastSystemError(errorCode));
+			if (error)
+				*error = SocketError::Unknown;
+
+			return 0;
+		}
+
+		unsigned int completionCount = 0;
+		for (ULONG i = 0; i < entryCount; ++i)
+		{
+			const OVERLAPPED_ENTRY& entry = m_completionEntries[i];
+			Operation* operation = reinterpret_cast<Operation*>(entry.lpOverlapped);
+
+			int errorCode = 0;
+			DWORD transferredBytes = 0;
+			DWORD flags;
+			if (!WSAGetOverlappedResult(operation->socket, &operation->overlapped, &transferredBytes, FALSE, &flags))
+				errorCode = WSAGetLastError();
+
+			if (!operation->isCancelled)
+				completionCount++;
+
+			HandleCompletion(operation, transferredBytes, errorCode);
+		}
+
+		if (error)
+			*error = SocketError::NoError;
+
+		return completionCount;
+	}
+
+	bool SocketCompletionQueueImpl::Send(SocketHandle socket, const void* data, std::size_t size, SendCallback callback)
+	{
+		SocketData* socketData = RegisterSocket(socket);
+		if (!socketData)
+			return false;
+
+		Operation* operation = AllocateOperation(OperationType::Send, socket);
+		operation->sendCallback = std::move(callback);
+		operation->sendData = static_cast<const UInt8*>(data);
+		operation->sendSize = size;
+
+		socketData->sendOperations.push_back(operation);
+		if (socketData->sendOperations.size() > 1)
+			return true; //< will be submitted once previous sends are done
+
+		if (!SubmitSend(operation))
+		{
+			socketData->sendOperations.pop_back();
+			FreeOperation(operation);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool SocketCompletionQueueImpl::StartAccepting(SocketHandle socket, AcceptCallback callback)
+	{
+		if (!m_acceptEx)
+		{
+			GUID acceptExGuid = WSAID_ACCEPTEX;
+			DWORD bytes;
+			if (WSAIoctl(socket, SIO_GET_EXTENSION_FUNCTION_POINTER, &acceptExGuid, sizeof(acceptExGuid), &m_acceptEx, sizeof(m_acceptEx), &bytes, nullptr, nullptr) == SOCKET_ERROR)
+			{
+				NazaraError("failed to retrieve AcceptEx: {0}", Error::GetLastSystemError(WSAGetLastError()));
+				return false;
+			}
+		}
+
+		SocketData* socketData = RegisterSocket(socket);
+		if (!socketData)
+			return false;
+
+		NazaraAssert(!socketData->acceptOperation, "socket is already accepting");
+
+		Operation* operation = AllocateOperation(OperationType::Accept, socket);
+		operation->acceptCallback = std::move(callback);
+		operation->buffer.resize(AcceptAddressSize * 2);
+
+		if (!SubmitAccept(operation))
+		{
+			FreeOperation(operation);
+			return false;
+		}
+
+		socketData->acceptOperation = operation;
+		return true;
+	}
+
+	bool SocketCompletionQueueImpl::StartReceiving(SocketHandle socket, ReceiveCallback callback)
+	{
+		SocketData* socketData = RegisterSocket(socket);
+		if (!socketData)
+			return false;
+
+		NazaraAssert(!socketData->receiveOperation, "socket is already receiving");
+
+		Operation* operation = AllocateOperation(OperationType::Receive, socket);
+		operation->receiveCallback = std::move(callback);
+		operation->buffer.resize(m_receiveBufferSize);
+
+		if (!SubmitReceive(operation))
+		{
+			FreeOperation(operation);
+			return false;
+		}
+
+		socketData->receiveOperation = operation;
+		return true;
+	}
+
+	void SocketCompletionQueueImpl::Stop(SocketHandle socket)
+	{
+		auto socketIt = m_sockets.find(socket);
+		if (socketIt == m_sockets.end())
+			return;
+
+		SocketData& socketData = socketIt->second;
+		if (socketData.acceptOperation)
+			CancelOperation(socketData.acceptOperation);
+
+		if (socketData.receiveOperation)
+			CancelOperation(socketData.receiveOperation);
+
+		for (std::size_t i = 0; i < socketData.sendOperations.size(); ++i)
+		{
+			// Only the first send was submitted
+			if (i == 0)
+				CancelOperation(socketData.sendOperations[i]);
+			else
+				FreeOperation(socketData.sendOperations[i]);
+		}
+
+		m_sockets.erase(socketIt);
+	}
+
+	auto SocketCompletionQueueImpl::AllocateOperation(OperationType type, SocketHandle socket) -> Operation*
+	{
+		std::unique_ptr<Operation> operation = std::make_unique<Operation>();
+		std::memset(&operation->overlapped, 0, sizeof(OVERLAPPED));
+		operation->type = type;
+		operation->socket = socket;
+
+		Operation* operationPtr = operation.get();
+		m_operations.emplace(operationPtr, std::move(operation));
+
+		return operationPtr;
+	}
+
+	void SocketCompletionQueueImpl::CancelOperation(Operation* operation)
+	{
+		// The operation is freed once its (aborted) completion is dequeued
+		operation->isCancelled = true;
+		CancelIoEx(reinterpret_cast<HANDLE>(operation->socket), &operation->overlapped);
+	}
+
+	void SocketCompletionQueueImpl::FinishSend(Operation* operation, SocketError error)
+	{
+		SocketHandle socket = operation->socket;
+		std::size_t sentSize = operation->sentSize;
+		SendCallback callback = std::move(operation->sendCallback);
+
+		auto socketIt = m_sockets.find(socket);
+		if (socketIt != m_sockets.end())
+		{
+			std::deque<Operation*>& sendOperations = socketIt->second.sendOperations;
+			NazaraAssert(!sendOperations.empty() && sendOperations.front() == operation, "unexpected send completion");
+			sendOperations.pop_front();
+			FreeOperation(operation);
+
+			// Submit the next send of this socket
+			while (!sendOperations.empty())
+			{
+				Operation* nextOperation = sendOperations.front();
+				if (SubmitSend(nextOperation))
+					break;
+
+				SendCallback nextCallback = std::move(nextOperation->sendCallback);
+				FreeOperation(nextOperation);
+				sendOperations.pop_front();
+
+				if (nextCallback)
+					nextCallback(0, SocketError::ResourceError);
+			}
+		}
+		else
+			FreeOperation(operation);
+
+		if (callback)
+			callback(sentSize, error);
+	}
+
+	void SocketCompletionQueueImpl::FreeOperation(Operation* operation)
+	{
+		if (operation->acceptedSocket != SocketImpl::InvalidHandle)
+			SocketImpl::Close(operation->acceptedSocket);
+
+		m_operations.erase(operation);
+	}
+
+	void SocketCompletionQueueImpl::HandleCompletion(Operation* operation, DWORD transferredBytes, int errorCode)
+	{
+		if (operation->isCancelled)
+		{
+			FreeOperation(operation);
+			return;
+		}
+
+		switch (operation->type)
+		{
+			case OperationType::Accept:
+			{
+				if (errorCode == 0)
+				{
+					SocketHandle client = operation->acceptedSocket;
+					operation->acceptedSocket = SocketImpl::InvalidHandle;
+
+					// Required for the accepted socket to behave like one returned by accept
+					setsockopt(client, SOL_SOCKET, SO_UPDATE_ACCEPT_CONTEXT, reinterpret_cast<const char*>(&operation->socket), sizeof(operation->socket));
+
+					IpAddress peerAddress = SocketImpl::QueryPeerAddress(client);
+					operation->acceptCallback(client, peerAddress);
+
+					// The callback may have stopped the socket
+					if (operation->isCancelled)
+					{
+						FreeOperation(operation);
+						return;
+					}
+				}
+				else if (errorCode != WSAECONNRESET)
+					NazaraError("failed to accept client: {0}", Error::GetLastSystemError(errorCode));
+
+				if (!SubmitAccept(operation))
+				{
+					auto socketIt = m_sockets.find(operation->socket);
+					if (socketIt != m_sockets.end())
+						socketIt->second.acceptOperation = nullptr;
+
+					FreeOperation(operation);
+				}
+
+				break;
+			}
+
+			case OperationType::Receive:
+			{
+				if (errorCode == 0 && transferredBytes > 0)
+				{
+					operation->receiveCallback(operation->buffer.data(), transferredBytes, SocketError::NoError);
+
+					// The callback may have stopped the socket, in which case the operation is no longer submitted
+					if (operation->isCancelled)
+					{
+						FreeOperation(operation);
+						return;
+					}
+
+					// Emulate multishot receive by submitting it again
+					if (SubmitReceive(operation))
+						break;
+
+					errorCode = WSAGetLastError();
+				}
+
+				// Connection closed or failed, receiving stops
+				ReceiveCallback callback = std::move(operation->receiveCallback);
+
+				auto socketIt = m_sockets.find(operation->socket);
+				if (socketIt != m_sockets.end())
+					socketIt->second.receiveOperation = nullptr;
+
+				FreeOperation(operation);
+
+				callback(nullptr, 0, (errorCode == 0) ? SocketError::ConnectionClosed : SocketImpl::TranslateWSAErrorToSocketError(errorCode));
+				break;
+			}
+
+			case OperationType::Send:
+			{
+				if (errorCode != 0)
+				{
+					FinishSend(operation, SocketImpl::TranslateWSAErrorToSocketError(errorCode));
+					break;
+				}
+
+				operation->sentSize += transferredBytes;
+				if (transferredBytes > 0 && operation->sentSize < operation->sendSize)
+				{
+					// Partial send, send the remaining data
+					if (SubmitSend(operation))
+						break;
+
+					FinishSend(operation, SocketImpl::TranslateWSAErrorToSocketError(WSAGetLastError()));
+					break;
+				}
+
+				FinishSend(operation, (operation->sentSize == operation->sendSize) ? SocketError::NoError : SocketError::ConnectionClosed);
+				break;
+			}
+		}
+	}
+
+	auto SocketCompletionQueueImpl::RegisterSocket(SocketHandle socket) -> SocketData*
+	{
+		auto it = m_sockets.find(socket);
+		if (it != m_sockets.end())
+			return &it->second;
+
+		// A socket can only be associated once with a completion port and this cannot be undone, it may have been done by a previous registration
+		if (!CreateIoCompletionPort(reinterpret_cast<HANDLE>(socket), m_completionPort, 0, 0) && GetLastError() != ERROR_INVALID_PARAMETER)
+		{
+			NazaraError("failed to associate socket with completion port: {0}", Error::GetLastSystemError());
+			return nullptr;
+		}
+
+		return &m_sockets[socket];
+	}
+
+	void SocketCompletionQueueImpl::Release()
+	{
+		if (!m_completionPort)
+			return;
+
+		// Operations memory must stay valid until the system is done with them, cancel and wait for all of them
+		for (auto&& [operationPtr, operation] : m_operations)
+		{
+			if (!operation->isCancelled)
+				CancelOperation(operationPtr);
+		}
+
+		// Unsubmitted sends never complete
+		for (auto&& [socket, socketData] : m_sockets)
+		{
+			for (std::size_t i = 1; i < socketData.sendOperations.size(); ++i)
+				FreeOperation(socketData.sendOperations[i]);
+		}
+		m_sockets.clear();
+
+		while (!m_operations.empty())
+		{
+			ULONG entryCount = 0;
+			if (!GetQueuedCompletionStatusEx(m_completionPort, m_completionEntries.data(), SafeCast<ULONG>(m_completionEntries.size()), &entryCount, INFINITE, FALSE))
+				break;
+
+			for (ULONG i = 0; i < entryCount; ++i)
+				FreeOperation(reinterpret_cast<Operation*>(m_completionEntries[i].lpOverlapped));
+		}
+
+		CloseHandle(m_completionPort);
+		m_completionPort = nullptr;
+	}
+
+	bool SocketCompletionQueueImpl::SubmitAccept(Operation* operation)
+	{
+		WSAPROTOCOL_INFOW protocolInfo;
+		int protocolInfoSize = sizeof(protocolInfo);
+		if (getsockopt(operation->socket, SOL_SOCKET, SO_PROTOCOL_INFOW, reinterpret_cast<char*>(&protocolInfo), &protocolInfoSize) == SOCKET_ERROR)
+		{
+			NazaraError("failed to query listening socket protocol: {0}", Error::GetLastSystemError(WSAGetLastError()));
+			return false;
+		}
+
+		operation->acceptedSocket = WSASocketW(protocolInfo.iAddressFamily, SOCK_STREAM, IPPROTO_TCP, nullptr, 0, WSA_FLAG_OVERLAPPED);
+		if (operation->acceptedSocket == INVALID_SOCKET)
+		{
+			operation->acceptedSocket = SocketImpl::InvalidHandle;
+			NazaraError("failed to create accept socket: {0}", Error::GetLastSystemError(WSAGetLastError()));
+			return false;
+		}
+
+		std::memset(&operation->overlapped, 0, sizeof(OVERLAPPED));
+
+		DWORD receivedBytes;
+		if (!m_acceptEx(operation->socket, operation->acceptedSocket, operation->buffer.data(), 0, AcceptAddressSize, AcceptAddressSize, &receivedBytes, &operation->overlapped))
+		{
+			int errorCode = WSAGetLastError();
+			if (errorCode != ERROR_IO_PENDING)
+			{
+				NazaraError("failed to submit accept: {0}", Error::GetLastSystemError(errorCode));
+				SocketImpl::Close(operation->acceptedSocket);
+				operation->acceptedSocket = SocketImpl::InvalidHandle;
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool SocketCompletionQueueImpl::SubmitReceive(Operation* operation)
+	{
+		std::memset(&operation->overlapped, 0, sizeof(OVERLAPPED));
+
+		WSABUF buffer;
+		buffer.buf = reinterpret_cast<CHAR*>(operation->buffer.data());
+		buffer.len = SafeCast<ULONG>(operation->buffer.size());
+
+		DWORD flags = 0;
+		if (WSARecv(operation->socket, &buffer, 1, nullptr, &flags, &operation->overlapped, nullptr) == SOCKET_ERROR)
+		{
+			int errorCode = WSAGetLastError();
+			if (errorCode != WSA_IO_PENDING)
+				return false;
+		}
+
+		return true;
+	}
+
+	bool SocketCompletionQueueImpl::SubmitSend(Operation* operation)
+	{
+		std::memset(&operation->overlapped, 0, sizeof(OVERLAPPED));
+
+		std::size_t remainingSize = operation->sendSize - operation->sentSize;
+
+		WSABUF buffer;
+		buffer.buf = reinterpret_cast<CHAR*>(const_cast<UInt8*>(operation->sendData + operation->sentSize));
+		buffer.len = SafeCast<ULONG>(std::min<std::size_t>(remainingSize, std::numeric_limits<ULONG>::max()));
+
+		if (WSASend(operation->socket, &buffer, 1, nullptr, 0, &operation->overlapped, nullptr) == SOCKET_ERROR)
+		{
+			int errorCode = WSAGetLastError();
+			if (errorCode != WSA_IO_PENDING)
+				return false;
+		}
+
+		return true;
+	}
+}
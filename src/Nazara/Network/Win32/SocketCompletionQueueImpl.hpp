@@ -0,0 +1,102 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NETWORK_WIN32_SOCKETCOMPLETIONQUEUEIMPL_HPP
+#define NAZARA_NETWORK_WIN32_SOCKETCOMPLETIONQUEUEIMPL_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Network/IpAddress.hpp>
+#include <Nazara/Network/SocketCompletionQueue.hpp>
+#include <Nazara/Network/SocketHandle.hpp>
+#include <Nazara/Network/Win32/SocketImpl.hpp>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <MSWSock.h>
+
+namespace Nz
+{
+	class SocketCompletionQueueImpl
+	{
+		public:
+			using AcceptCallback = std::function<void(SocketHandle handle, const IpAddress& address)>;
+			using ReceiveCallback = SocketCompletionQueue::ReceiveCallback;
+			using SendCallback = SocketCompletionQueue::SendCallback;
+
+			SocketCompletionQueueImpl();
+			SocketCompletionQueueImpl(const SocketCompletionQueueImpl&) = delete;
+			SocketCompletionQueueImpl(SocketCompletionQueueImpl&&) = delete;
+			~SocketCompletionQueueImpl();
+
+			bool Create(std::size_t receiveBufferSize, std::size_t receiveBufferCount);
+
+			unsigned int Process(int msTimeout, SocketError* error);
+
+			bool Send(SocketHandle socket, const void* data, std::size_t size, SendCallback callback);
+
+			bool StartAccepting(SocketHandle socket, AcceptCallback callback);
+			bool StartReceiving(SocketHandle socket, ReceiveCallback callback);
+			void Stop(SocketHandle socket);
+
+			SocketCompletionQueueImpl& operator=(const SocketCompletionQueueImpl&) = delete;
+			SocketCompletionQueueImpl& operator=(SocketCompletionQueueImpl&&) = delete;
+
+		private:
+			enum class OperationType
+			{
+				Accept,
+				Receive,
+				Send
+			};
+
+			struct Operation
+			{
+				OVERLAPPED overlapped; //< must stay the first member, completions are mapped back to operations from it
+				AcceptCallback acceptCallback;
+				ReceiveCallback receiveCallback;
+				SendCallback sendCallback;
+				OperationType type;
+				SocketHandle socket;
+				SocketHandle acceptedSocket = SocketImpl::InvalidHandle;
+				std::vector<UInt8> buffer; //< receive buffer, or accepted addresses
+				const UInt8* sendData = nullptr;
+				std::size_t sendSize = 0;
+				std::size_t sentSize = 0;
+				bool isCancelled = false;
+			};
+
+			struct SocketData
+			{
+				std::deque<Operation*> sendOperations; //< only the first one is submitted, to keep the stream in order
+				Operation* acceptOperation = nullptr;
+				Operation* receiveOperation = nullptr;
+			};
+
+			Operation* AllocateOperation(OperationType type, SocketHandle socket);
+			void CancelOperation(Operation* operation);
+			void FinishSend(Operation* operation, SocketError error);
+			void FreeOperation(Operation* operation);
+			void HandleCompletion(Operation* operation, DWORD transferredBytes, int errorCode);
+			SocketData* RegisterSocket(SocketHandle socket);
+			void Release();
+			bool SubmitAccept(Operation* operation);
+			bool SubmitReceive(Operation* operation);
+			bool SubmitSend(Operation* operation);
+
+			static constexpr std::size_t AcceptAddressSize = sizeof(sockaddr_storage) + 16;
+
+			std::unordered_map<SocketHandle, SocketData> m_sockets;
+			std::unordered_map<Operation*, std::unique_ptr<Operation>> m_operations;
+			std::vector<OVERLAPPED_ENTRY> m_completionEntries;
+			std::size_t m_receiveBufferSize;
+			HANDLE m_completionPort;
+			LPFN_ACCEPTEX m_acceptEx;
+	};
+}
+
+#endif // NAZARA_NETWORK_WIN32_SOCKETCOMPLETIONQUEUEIMPL_HPP
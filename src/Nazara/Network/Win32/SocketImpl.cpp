@@ -538,6 +538,56 @@ namespace Nz
 		return true;
 	}
 
+	/*!
+	* \brief Receives up to datagramCount datagrams, one per NetDatagram, until none is available
+	*
+	* Truncated datagrams are reported with a zero receivedLength.
+	*/
+	bool SocketImpl::ReceiveBatch(SocketHandle handle, NetDatagram* datagrams, std::size_t datagramCount, std::size_t* receivedCount, SocketError* error)
+	{
+		NazaraAssert(handle != InvalidHandle, "Invalid handle");
+		NazaraAssert(datagrams && datagramCount > 0, "Invalid datagrams");
+
+		std::size_t datagramReceived = 0;
+		for (; datagramReceived < datagramCount; ++datagramReceived)
+		{
+			NetDatagram& datagram = datagrams[datagramReceived];
+
+			int read;
+			SocketError receiveError;
+			if (!ReceiveFrom(handle, datagram.buffer.data, static_cast<int>(datagram.buffer.dataLength), &datagram.address, &read, &receiveError))
+			{
+				if (receiveError == SocketError::ConnectionClosed)
+					read = 0; //< empty datagram
+				else if (receiveError == SocketError::DatagramSize)
+					read = 0; //< truncated datagram
+				else
+				{
+					// Report the error on next call if we already received some datagrams
+					if (datagramReceived > 0)
+						break;
+
+					if (error)
+						*error = receiveError;
+
+					return false;
+				}
+			}
+			else if (read == 0)
+				break; //< no more datagram available
+
+			datagram.receivedLength = static_cast<std::size_t>(read);
+		}
+
+		if (receivedCount)
+			*receivedCount = datagramReceived;
+
+		if (error)
+			*error = SocketError::NoError;
+
+		return true;
+	}
+
 	bool SocketImpl::ReceiveFrom(SocketHandle handle, void* buffer, int length, IpAddress* from, int* read, SocketError* error)
 	{
 		NazaraAssert(handle != InvalidHandle, "Invalid handle");
@@ -698,6 +748,44 @@ namespace Nz
 		return true;
 	}
 
+	/*!
+	* \brief Sends one datagram per NetDatagram, stopping at the first one which couldn't be sent
+	*
+	* If sentCount is lower than datagramCount without error, the socket send buffer is full.
+	*/
+	bool SocketImpl::SendBatch(SocketHandle handle, const NetDatagram* datagrams, std::size_t datagramCount, std::size_t* sentCount, SocketError* error)
+	{
+		NazaraAssert(handle != InvalidHandle, "Invalid handle");
+		NazaraAssert(datagrams && datagramCount > 0, "Invalid datagrams");
+
+		std::size_t datagramSent = 0;
+		for (; datagramSent < datagramCount; ++datagramSent)
+		{
+			const NetDatagram& datagram = datagrams[datagramSent];
+
+			int sent;
+			if (!SendTo(handle, datagram.buffer.data, static_cast<int>(datagram.buffer.dataLength), datagram.address, &sent, error))
+			{
+				// Report the error on next call if we already sent some datagrams
+				if (datagramSent > 0)
+					break;
+
+				return false;
+			}
+
+			if (sent == 0)
+				break; //< would block
+		}
+
+		if (sentCount)
+			*sentCount = datagramSent;
+
+		if (error)
+			*error = SocketError::NoError;
+
+		return true;
+	}
+
 	bool SocketImpl::SendMultiple(SocketHandle handle, const NetBuffer* buffers, std::size_t bufferCount, const IpAddress& to, int* sent, SocketError* error)
 	{
 		NazaraAssert(handle != InvalidHandle, "Invalid handle");
@@ -909,6 +997,17 @@ namespace Nz
 		return true;
 	}
 
+	bool SocketImpl::SetReusePort(SocketHandle handle, bool /*reusePort*/, SocketError* error)
+	{
+		NazaraAssert(handle != InvalidHandle, "Invalid handle");
+
+		// Windows has no equivalent to SO_REUSEPORT (SO_REUSEADDR doesn't balance datagrams between sockets)
+		if (error)
+			*error = SocketError::NotSupported;
+
+		return false;
+	}
+
 	bool SocketImpl::SetSendBufferSize(SocketHandle handle, std::size_t size, SocketError* error)
 	{
 		NazaraAssert(handle != InvalidHandle, "Invalid handle");
@@ -26,7 +26,9 @@ namespace Nz
 		m_readyToReadSockets.clear();
 		m_readyToWriteSockets.clear();
 		m_sockets.clear();
+		m_userdata.clear();
 		#else
+		m_userdata.clear();
 		FD_ZERO(&m_readSockets);
 		FD_ZERO(&m_readyToReadSockets);
 		FD_ZERO(&m_readyToWriteSockets);
@@ -63,10 +65,12 @@ namespace Nz
 		#endif
 	}
 
-	bool SocketPollerImpl::RegisterSocket(SocketHandle socket, SocketPollEventFlags eventFlags)
+	bool SocketPollerImpl::RegisterSocket(SocketHandle socket, SocketPollEventFlags eventFlags, void* userdata, SocketPollMode /*pollMode*/)
 	{
 		NazaraAssert(!IsRegistered(socket), "Socket is already registered");
 
+		// Neither WSAPoll nor select have an edge-triggered mode, sockets are always level-triggered
+
 		#if NAZARA_NETWORK_POLL_SUPPORT
 		PollSocket entry = {
 			socket,
@@ -82,6 +86,7 @@ namespace Nz
 
 		m_allSockets[socket] = m_sockets.size();
 		m_sockets.emplace_back(entry);
+		m_userdata.push_back(userdata);
 		#else
 		for (std::size_t i = 0; i < 2; ++i)
 		{
@@ -97,6 +102,8 @@ namespace Nz
 
 			FD_SET(socket, &targetSet);
 		}
+
+		m_userdata[socket] = userdata;
 		#endif
 
 		return true;
@@ -118,8 +125,10 @@ namespace Nz
 
 			// Now move it properly (lastElement is invalid after the following line) and pop it
 			m_sockets[entry] = std::move(m_sockets.back());
+			m_userdata[entry] = m_userdata.back();
 		}
 		m_sockets.pop_back();
+		m_userdata.pop_back();
 
 		m_allSockets.erase(socket);
 		m_readyToReadSockets.erase(socket);
@@ -129,6 +138,7 @@ namespace Nz
 		FD_CLR(socket, &m_readyToReadSockets);
 		FD_CLR(socket, &m_readyToWriteSockets);
 		FD_CLR(socket, &m_writeSockets);
+		m_userdata.erase(socket);
 		#endif
 	}
 
@@ -173,6 +183,9 @@ namespace Nz
 		fd_set* readSet = nullptr;
 		fd_set* writeSet = nullptr;
 
+		FD_ZERO(&m_readyToReadSockets);
+		FD_ZERO(&m_readyToWriteSockets);
+
 		if (m_readSockets.fd_count > 0)
 		{
 			m_readyToReadSockets = m_readSockets;
@@ -182,7 +195,7 @@ namespace Nz
 		if (m_writeSockets.fd_count > 0)
 		{
 			m_readyToWriteSockets = m_writeSockets;
-			readSet = &m_readyToWriteSockets;
+			writeSet = &m_readyToWriteSockets;
 		}
 
 		timeval tv;
@@ -207,4 +220,78 @@ namespace Nz
 
 		return activeSockets;
 	}
+
+	unsigned int SocketPollerImpl::Wait(int msTimeout, SocketPollerEvent* events, std::size_t maxEventCount, SocketError* error)
+	{
+		unsigned int eventCount = 0;
+
+		#if NAZARA_NETWORK_POLL_SUPPORT
+		unsigned int activeSockets = SocketImpl::Poll(m_sockets.data(), m_sockets.size(), static_cast<int>(msTimeout), error);
+		if (activeSockets > 0U)
+		{
+			unsigned int socketRemaining = activeSockets;
+			for (std::size_t i = 0; i < m_sockets.size(); ++i)
+			{
+				PollSocket& entry = m_sockets[i];
+				if (!entry.revents)
+					continue;
+
+				SocketPollEventFlags eventFlags;
+				if (entry.revents & (POLLRDNORM | POLLHUP | POLLERR))
+					eventFlags |= SocketPollEvent::Read;
+
+				if (entry.revents & (POLLWRNORM | POLLERR))
+					eventFlags |= SocketPollEvent::Write;
+
+				entry.revents = 0;
+
+				// Sockets which don't fit will still be ready on next call
+				if (eventFlags && eventCount < maxEventCount)
+				{
+					SocketPollerEvent& event = events[eventCount++];
+					event.socket = entry.fd;
+					event.events = eventFlags;
+					event.userdata = m_userdata[i];
+				}
+
+				if (--socketRemaining == 0)
+					break;
+			}
+		}
+		#else
+		if (Wait(msTimeout, error) == 0)
+			return 0;
+
+		auto PushEvent = [&](SocketHandle socket, SocketPollEventFlags eventFlags)
+		{
+			if (eventCount >= maxEventCount)
+				return;
+
+			SocketPollerEvent& event = events[eventCount++];
+			event.socket = socket;
+			event.events = eventFlags;
+			event.userdata = m_userdata[socket];
+		};
+
+		for (u_int i = 0; i < m_readyToReadSockets.fd_count; ++i)
+		{
+			SocketHandle socket = m_readyToReadSockets.fd_array[i];
+
+			SocketPollEventFlags eventFlags = SocketPollEvent::Read;
+			if (FD_ISSET(socket, &m_readyToWriteSockets))
+				eventFlags |= SocketPollEvent::Write;
+
+			PushEvent(socket, eventFlags);
+		}
+
+		for (u_int i = 0; i < m_readyToWriteSockets.fd_count; ++i)
+		{
+			SocketHandle socket = m_readyToWriteSockets.fd_array[i];
+			if (!FD_ISSET(socket, &m_readyToReadSockets))
+				PushEvent(socket, SocketPollEvent::Write);
+		}
+		#endif
+
+		return eventCount;
+	}
 }
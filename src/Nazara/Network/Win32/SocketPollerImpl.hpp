@@ -9,6 +9,7 @@
 
 #include <Nazara/Network/IpAddress.hpp>
 #include <Nazara/Network/SocketHandle.hpp>
+#include <Nazara/Network/SocketPoller.hpp>
 #include <Nazara/Network/Win32/SocketImpl.hpp>
 #include <WinSock2.h>
 #include <unordered_map>
@@ -29,10 +30,11 @@ namespace Nz
 			bool IsReadyToWrite(SocketHandle socket) const;
 			bool IsRegistered(SocketHandle socket) const;
 
-			bool RegisterSocket(SocketHandle socket, SocketPollEventFlags eventFlags);
+			bool RegisterSocket(SocketHandle socket, SocketPollEventFlags eventFlags, void* userdata, SocketPollMode pollMode);
 			void UnregisterSocket(SocketHandle socket);
 
 			unsigned int Wait(int msTimeout, SocketError* error);
+			unsigned int Wait(int msTimeout, SocketPollerEvent* events, std::size_t maxEventCount, SocketError* error);
 
 		private:
 			#if NAZARA_NETWORK_POLL_SUPPORT
@@ -40,7 +42,9 @@ namespace Nz
 			std::unordered_set<SocketHandle> m_readyToWriteSockets;
 			std::unordered_map<SocketHandle, std::size_t> m_allSockets;
 			std::vector<PollSocket> m_sockets;
+			std::vector<void*> m_userdata; //< indexed like m_sockets
 			#else
+			std::unordered_map<SocketHandle, void*> m_userdata;
 			fd_set m_readSockets;
 			fd_set m_readyToReadSockets;
 			fd_set m_readyToWriteSockets;
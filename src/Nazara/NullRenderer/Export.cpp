@@ -0,0 +1,19 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/NullRenderer/NullRenderer.hpp>
+
+#ifndef NAZARA_RENDERER_EMBEDDEDBACKENDS
+
+extern "C"
+{
+	NAZARA_EXPORT Nz::RendererImpl* NazaraRenderer_Instantiate()
+	{
+		std::unique_ptr<Nz::NullRenderer> renderer = std::make_unique<Nz::NullRenderer>();
+		return renderer.release();
+	}
+}
+
+#endif
@@ -0,0 +1,46 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/NullRenderer/NullBuffer.hpp>
+#include <Nazara/NullRenderer/NullDevice.hpp>
+#include <cstring>
+#include <Nazara/NullRenderer/Debug.hpp>
+
+namespace Nz
+{
+	NullBuffer::NullBuffer(NullDevice& device, BufferType type, UInt64 size, BufferUsageFlags usage, const void* initialData) :
+	RenderBuffer(device, type, size, usage)
+	{
+		// Keep a CPU copy of the contents since the engine may read back mapped buffers
+		m_buffer = std::make_unique<UInt8[]>(size);
+		if (initialData)
+			std::memcpy(m_buffer.get(), initialData, size);
+	}
+
+	bool NullBuffer::Fill(const void* data, UInt64 offset, UInt64 size)
+	{
+		NazaraAssert(offset + size <= GetSize(), "fill range exceeds buffer size");
+
+		std::memcpy(&m_buffer[offset], data, size);
+		return true;
+	}
+
+	void* NullBuffer::Map(UInt64 offset, UInt64 size)
+	{
+		NazaraAssert(offset + size <= GetSize(), "map range exceeds buffer size");
+		NazaraUnused(size);
+
+		return &m_buffer[offset];
+	}
+
+	bool NullBuffer::Unmap()
+	{
+		return true;
+	}
+
+	void NullBuffer::UpdateDebugName(std::string_view /*name*/)
+	{
+		// No object to name
+	}
+}
@@ -0,0 +1,176 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/NullRenderer/NullCommandBufferBuilder.hpp>
+#include <Nazara/NullRenderer/Debug.hpp>
+
+namespace Nz
+{
+	void NullCommandBufferBuilder::BeginDebugRegion(std::string_view /*regionName*/, const Color& /*color*/)
+	{
+		/* nothing to do */
+	}
+
+	void NullCommandBufferBuilder::BeginRenderPass(const Framebuffer& /*framebuffer*/, const RenderPass& /*renderPass*/, const Recti& /*renderRect*/, const ClearValues* /*clearValues*/, std::size_t /*clearValueCount*/)
+	{
+		m_statistics.renderPassCount++;
+	}
+
+	void NullCommandBufferBuilder::BindComputePipeline(const ComputePipeline& /*pipeline*/)
+	{
+		m_statistics.pipelineBindCount++;
+	}
+
+	void NullCommandBufferBuilder::BindComputeShaderBinding(UInt32 /*set*/, const ShaderBinding& /*binding*/)
+	{
+		m_statistics.shaderBindingBindCount++;
+	}
+
+	void NullCommandBufferBuilder::BindComputeShaderBinding(const RenderPipelineLayout& /*pipelineLayout*/, UInt32 /*set*/, const ShaderBinding& /*binding*/)
+	{
+		m_statistics.shaderBindingBindCount++;
+	}
+
+	void NullCommandBufferBuilder::BindIndexBuffer(const RenderBuffer& /*indexBuffer*/, IndexType /*indexType*/, UInt64 /*offset*/)
+	{
+		/* nothing to do */
+	}
+
+	void NullCommandBufferBuilder::BindRenderPipeline(const RenderPipeline& /*pipeline*/)
+	{
+		m_statistics.pipelineBindCount++;
+	}
+
+	void NullCommandBufferBuilder::BindRenderShaderBinding(UInt32 /*set*/, const ShaderBinding& /*binding*/)
+	{
+		m_statistics.shaderBindingBindCount++;
+	}
+
+	void NullCommandBufferBuilder::BindRenderShaderBinding(const RenderPipelineLayout& /*pipelineLayout*/, UInt32 /*set*/, const ShaderBinding& /*binding*/)
+	{
+		m_statistics.shaderBindingBindCount++;
+	}
+
+	void NullCommandBufferBuilder::BindVertexBuffer(UInt32 /*binding*/, const RenderBuffer& /*vertexBuffer*/, UInt64 /*offset*/)
+	{
+		/* nothing to do */
+	}
+
+	void NullCommandBufferBuilder::BlitTexture(const Texture& /*fromTexture*/, const Boxui& /*fromBox*/, TextureLayout /*fromLayout*/, const Texture& /*toTexture*/, const Boxui& /*toBox*/, TextureLayout /*toLayout*/, SamplerFilter /*filter*/)
+	{
+		/* nothing to do */
+	}
+
+	void NullCommandBufferBuilder::BuildMipmaps(Texture& /*texture*/, UInt8 /*baseLevel*/, UInt8 /*levelCount*/, PipelineStageFlags /*srcStageMask*/, PipelineStageFlags /*dstStageMask*/, MemoryAccessFlags /*srcAccessMask*/, MemoryAccessFlags /*dstAccessMask*/, TextureLayout /*oldLayout*/, TextureLayout /*newLayout*/)
+	{
+		/* nothing to do */
+	}
+
+	void NullCommandBufferBuilder::CopyBuffer(const RenderBufferView& /*source*/, const RenderBufferView& /*target*/, UInt64 size, UInt64 /*sourceOffset*/, UInt64 /*targetOffset*/)
+	{
+		m_statistics.transferredBytes += size;
+	}
+
+	void NullCommandBufferBuilder::CopyBuffer(const UploadPool::Allocation& /*allocation*/, const RenderBufferView& /*target*/, UInt64 size, UInt64 /*sourceOffset*/, UInt64 /*targetOffset*/)
+	{
+		m_statistics.transferredBytes += size;
+	}
+
+	void NullCommandBufferBuilder::CopyTexture(const Texture& /*fromTexture*/, const Boxui& /*fromBox*/, TextureLayout /*fromLayout*/, const Texture& /*toTexture*/, const Vector3ui& /*toPos*/, TextureLayout /*toLayout*/)
+	{
+		/* nothing to do */
+	}
+
+	void NullCommandBufferBuilder::Dispatch(UInt32 /*workgroupX*/, UInt32 /*workgroupY*/, UInt32 /*workgroupZ*/)
+	{
+		m_statistics.computeDispatchCount++;
+	}
+
+	void NullCommandBufferBuilder::Draw(UInt32 vertexCount, UInt32 instanceCount, UInt32 /*firstVertex*/, UInt32 /*firstInstance*/)
+	{
+		m_statistics.drawCallCount++;
+		m_statistics.drawnVertexCount += UInt64(vertexCount) * instanceCount;
+	}
+
+	void NullCommandBufferBuilder::DrawIndexed(UInt32 indexCount, UInt32 instanceCount, UInt32 /*firstIndex*/, UInt32 /*firstInstance*/)
+	{
+		m_statistics.drawCallCount++;
+		m_statistics.drawnVertexCount += UInt64(indexCount) * instanceCount;
+	}
+
+	void NullCommandBufferBuilder::DrawIndexedIndirect(const RenderBufferView& /*indirectBuffer*/, UInt32 drawCount, UInt32 /*stride*/)
+	{
+		m_statistics.drawCallCount += drawCount;
+	}
+
+	void NullCommandBufferBuilder::DrawIndexedIndirectCount(const RenderBufferView& /*indirectBuffer*/, const RenderBufferView& /*countBuffer*/, UInt32 /*maxDrawCount*/, UInt32 /*stride*/)
+	{
+		m_statistics.drawCallCount++; //< actual draw count would only be known by the GPU
+	}
+
+	void NullCommandBufferBuilder::EndDebugRegion()
+	{
+		/* nothing to do */
+	}
+
+	void NullCommandBufferBuilder::EndRenderPass()
+	{
+		/* nothing to do */
+	}
+
+	void NullCommandBufferBuilder::InsertDebugLabel(std::string_view /*label*/, const Color& /*color*/)
+	{
+		/* nothing to do */
+	}
+
+	void NullCommandBufferBuilder::MemoryBarrier(PipelineStageFlags /*srcStageMask*/, PipelineStageFlags /*dstStageMask*/, MemoryAccessFlags /*srcAccessMask*/, MemoryAccessFlags /*dstAccessMask*/)
+	{
+		/* nothing to do */
+	}
+
+	void NullCommandBufferBuilder::NextSubpass()
+	{
+		/* nothing to do */
+	}
+
+	void NullCommandBufferBuilder::PreTransferBarrier()
+	{
+		/* nothing to do */
+	}
+
+	void NullCommandBufferBuilder::PostTransferBarrier()
+	{
+		/* nothing to do */
+	}
+
+	void NullCommandBufferBuilder::PushConstants(const RenderPipelineLayout& /*pipelineLayout*/, UInt32 /*offset*/, UInt32 /*size*/, const void* /*data*/)
+	{
+		/* nothing to do */
+	}
+
+	void NullCommandBufferBuilder::SetScissor(const Recti& /*scissorRegion*/)
+	{
+		/* nothing to do */
+	}
+
+	void NullCommandBufferBuilder::SetViewport(const Recti& /*viewportRegion*/)
+	{
+		/* nothing to do */
+	}
+
+	void NullCommandBufferBuilder::TextureAcquireBarrier(PipelineStageFlags /*srcStageMask*/, PipelineStageFlags /*dstStageMask*/, MemoryAccessFlags /*srcAccessMask*/, MemoryAccessFlags /*dstAccessMask*/, TextureLayout /*oldLayout*/, TextureLayout /*newLayout*/, QueueType /*srcQueue*/, QueueType /*dstQueue*/, const Texture& /*texture*/)
+	{
+		/* nothing to do */
+	}
+
+	void NullCommandBufferBuilder::TextureBarrier(PipelineStageFlags /*srcStageMask*/, PipelineStageFlags /*dstStageMask*/, MemoryAccessFlags /*srcAccessMask*/, MemoryAccessFlags /*dstAccessMask*/, TextureLayout /*oldLayout*/, TextureLayout /*newLayout*/, const Texture& /*texture*/)
+	{
+		/* nothing to do */
+	}
+
+	void NullCommandBufferBuilder::TextureReleaseBarrier(PipelineStageFlags /*srcStageMask*/, PipelineStageFlags /*dstStageMask*/, MemoryAccessFlags /*srcAccessMask*/, MemoryAccessFlags /*dstAccessMask*/, TextureLayout /*oldLayout*/, TextureLayout /*newLayout*/, QueueType /*srcQueue*/, QueueType /*dstQueue*/, const Texture& /*texture*/)
+	{
+		/* nothing to do */
+	}
+}
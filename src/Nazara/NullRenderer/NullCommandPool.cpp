@@ -0,0 +1,28 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/NullRenderer/NullCommandPool.hpp>
+#include <Nazara/NullRenderer/NullCommandBuffer.hpp>
+#include <Nazara/NullRenderer/NullCommandBufferBuilder.hpp>
+#include <Nazara/NullRenderer/Debug.hpp>
+
+namespace Nz
+{
+	CommandBufferPtr NullCommandPool::BuildCommandBuffer(const std::function<void(CommandBufferBuilder& builder)>& callback)
+	{
+		CommandBufferPtr commandBuffer(new NullCommandBuffer);
+
+		NullCommandBufferBuilder builder;
+		callback(builder);
+
+		commandBuffer->UpdateStatistics(builder.GetStatistics());
+
+		return commandBuffer;
+	}
+
+	void NullCommandPool::UpdateDebugName(std::string_view /*name*/)
+	{
+		// No object to name
+	}
+}
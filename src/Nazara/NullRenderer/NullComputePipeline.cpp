@@ -0,0 +1,19 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/NullRenderer/NullComputePipeline.hpp>
+#include <Nazara/NullRenderer/Debug.hpp>
+
+namespace Nz
+{
+	const ComputePipelineInfo& NullComputePipeline::GetPipelineInfo() const
+	{
+		return m_pipelineInfo;
+	}
+
+	void NullComputePipeline::UpdateDebugName(std::string_view /*name*/)
+	{
+		// No object to name
+	}
+}
@@ -0,0 +1,151 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/NullRenderer/NullDevice.hpp>
+#include <Nazara/NullRenderer/NullBuffer.hpp>
+#include <Nazara/NullRenderer/NullCommandPool.hpp>
+#include <Nazara/NullRenderer/NullComputePipeline.hpp>
+#include <Nazara/NullRenderer/NullFramebuffer.hpp>
+#include <Nazara/NullRenderer/NullRenderPass.hpp>
+#include <Nazara/NullRenderer/NullRenderPipeline.hpp>
+#include <Nazara/NullRenderer/NullRenderPipelineLayout.hpp>
+#include <Nazara/NullRenderer/NullShaderModule.hpp>
+#include <Nazara/NullRenderer/NullSwapchain.hpp>
+#include <Nazara/NullRenderer/NullTexture.hpp>
+#include <Nazara/NullRenderer/NullTextureSampler.hpp>
+#include <Nazara/NullRenderer/Debug.hpp>
+
+namespace Nz
+{
+	NullDevice::NullDevice(const RenderDeviceInfo& deviceInfo, const RenderDeviceFeatures& enabledFeatures) :
+	m_enabledFeatures(enabledFeatures),
+	m_deviceInfo(deviceInfo)
+	{
+	}
+
+	const RenderDeviceInfo& NullDevice::GetDeviceInfo() const
+	{
+		return m_deviceInfo;
+	}
+
+	const RenderDeviceFeatures& NullDevice::GetEnabledFeatures() const
+	{
+		return m_enabledFeatures;
+	}
+
+	std::shared_ptr<RenderBuffer> NullDevice::InstantiateBuffer(BufferType type, UInt64 size, BufferUsageFlags usageFlags, const void* initialData)
+	{
+		return std::make_shared<NullBuffer>(*this, type, size, usageFlags, initialData);
+	}
+
+	std::shared_ptr<CommandPool> NullDevice::InstantiateCommandPool(QueueType /*queueType*/)
+	{
+		return std::make_shared<NullCommandPool>();
+	}
+
+	std::shared_ptr<ComputePipeline> NullDevice::InstantiateComputePipeline(ComputePipelineInfo pipelineInfo)
+	{
+		return std::make_shared<NullComputePipeline>(std::move(pipelineInfo));
+	}
+
+	std::shared_ptr<Framebuffer> NullDevice::InstantiateFramebuffer(unsigned int /*width*/, unsigned int /*height*/, const std::shared_ptr<RenderPass>& /*renderPass*/, const std::vector<std::shared_ptr<Texture>>& /*attachments*/)
+	{
+		return std::make_shared<NullFramebuffer>(FramebufferType::Texture);
+	}
+
+	std::shared_ptr<RenderPass> NullDevice::InstantiateRenderPass(std::vector<RenderPass::Attachment> attachments, std::vector<RenderPass::SubpassDescription> subpassDescriptions, std::vector<RenderPass::SubpassDependency> subpassDependencies)
+	{
+		return std::make_shared<NullRenderPass>(std::move(attachments), std::move(subpassDescriptions), std::move(subpassDependencies));
+	}
+
+	std::shared_ptr<RenderPipeline> NullDevice::InstantiateRenderPipeline(RenderPipelineInfo pipelineInfo)
+	{
+		return std::make_shared<NullRenderPipeline>(std::move(pipelineInfo));
+	}
+
+	std::shared_ptr<RenderPipelineLayout> NullDevice::InstantiateRenderPipelineLayout(RenderPipelineLayoutInfo pipelineLayoutInfo)
+	{
+		return std::make_shared<NullRenderPipelineLayout>(std::move(pipelineLayoutInfo));
+	}
+
+	std::shared_ptr<ShaderModule> NullDevice::InstantiateShaderModule(nzsl::ShaderStageTypeFlags shaderStages, const nzsl::Ast::Module& /*shaderModule*/, const nzsl::ShaderWriter::States& /*states*/)
+	{
+		return std::make_shared<NullShaderModule>(shaderStages);
+	}
+
+	std::shared_ptr<ShaderModule> NullDevice::InstantiateShaderModule(nzsl::ShaderStageTypeFlags shaderStages, ShaderLanguage /*lang*/, const void* /*source*/, std::size_t /*sourceSize*/, const nzsl::ShaderWriter::States& /*states*/)
+	{
+		return std::make_shared<NullShaderModule>(shaderStages);
+	}
+
+	std::shared_ptr<Swapchain> NullDevice::InstantiateSwapchain(WindowHandle /*windowHandle*/, const Vector2ui& windowSize, const SwapchainParameters& parameters)
+	{
+		return std::make_shared<NullSwapchain>(*this, windowSize, parameters);
+	}
+
+	std::shared_ptr<Texture> NullDevice::InstantiateTexture(const TextureInfo& params)
+	{
+		return std::make_shared<NullTexture>(params);
+	}
+
+	std::shared_ptr<Texture> NullDevice::InstantiateTexture(const TextureInfo& params, const void* /*initialData*/, bool /*buildMipmaps*/, unsigned int /*srcWidth*/, unsigned int /*srcHeight*/)
+	{
+		return std::make_shared<NullTexture>(params);
+	}
+
+	std::shared_ptr<TextureSampler> NullDevice::InstantiateTextureSampler(const TextureSamplerInfo& /*params*/)
+	{
+		return std::make_shared<NullTextureSampler>();
+	}
+
+	bool NullDevice::IsParallelCommandRecordingSupported() const
+	{
+		return true;
+	}
+
+	bool NullDevice::IsTextureFormatSupported(PixelFormat format, TextureUsage /*usage*/) const
+	{
+		return format != PixelFormat::Undefined;
+	}
+
+	void NullDevice::WaitForIdle()
+	{
+		/* nothing to do */
+	}
+
+	RenderDeviceInfo NullDevice::BuildDeviceInfo()
+	{
+		RenderDeviceInfo deviceInfo;
+		deviceInfo.name = "Null Device";
+		deviceInfo.type = RenderDeviceType::Virtual;
+
+		// Report every feature so the engine takes its most complete code paths
+		deviceInfo.features.anisotropicFiltering = true;
+		deviceInfo.features.bindlessTextures = true;
+		deviceInfo.features.computeShaders = true;
+		deviceInfo.features.depthClamping = true;
+		deviceInfo.features.drawIndirectCount = true;
+		deviceInfo.features.multiDrawIndirect = true;
+		deviceInfo.features.multipleSubpasses = true;
+		deviceInfo.features.nonSolidFaceFilling = true;
+		deviceInfo.features.storageBuffers = true;
+		deviceInfo.features.textureReadWithoutFormat = true;
+		deviceInfo.features.textureReadWrite = true;
+		deviceInfo.features.textureWriteWithoutFormat = true;
+		deviceInfo.features.unrestrictedTextureViews = true;
+
+		// Limits match the minimums guaranteed by Vulkan, which common desktop GPUs exceed
+		deviceInfo.limits.maxComputeSharedMemorySize = 16384;
+		deviceInfo.limits.maxComputeWorkGroupInvocations = 128;
+		deviceInfo.limits.maxComputeWorkGroupCount = { 65535, 65535, 65535 };
+		deviceInfo.limits.maxComputeWorkGroupSize = { 128, 128, 64 };
+		deviceInfo.limits.maxPushConstantsSize = 128;
+		deviceInfo.limits.maxStorageBufferSize = 128 * 1024 * 1024;
+		deviceInfo.limits.maxUniformBufferSize = 16384;
+		deviceInfo.limits.minStorageBufferOffsetAlignment = 256;
+		deviceInfo.limits.minUniformBufferOffsetAlignment = 256;
+
+		return deviceInfo;
+	}
+}
@@ -0,0 +1,51 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/NullRenderer/NullRenderImage.hpp>
+#include <Nazara/NullRenderer/NullCommandBuffer.hpp>
+#include <Nazara/NullRenderer/NullCommandBufferBuilder.hpp>
+#include <Nazara/NullRenderer/NullDevice.hpp>
+#include <Nazara/NullRenderer/NullSwapchain.hpp>
+#include <Nazara/NullRenderer/Debug.hpp>
+
+namespace Nz
+{
+	NullRenderImage::NullRenderImage(NullSwapchain& owner) :
+	m_owner(owner),
+	m_uploadPool(2 * 1024 * 1024)
+	{
+	}
+
+	void NullRenderImage::Execute(const FunctionRef<void(CommandBufferBuilder& builder)>& callback, QueueTypeFlags /*queueTypeFlags*/)
+	{
+		NullCommandBufferBuilder builder;
+		callback(builder);
+
+		m_owner.GetDevice().RegisterCommandBufferSubmission(builder.GetStatistics());
+	}
+
+	NullUploadPool& NullRenderImage::GetUploadPool()
+	{
+		return m_uploadPool;
+	}
+
+	void NullRenderImage::Present()
+	{
+		m_owner.GetDevice().RegisterFramePresentation(m_uploadPool);
+
+		m_owner.Present();
+		m_uploadPool.Reset();
+		FlushReleaseQueue();
+	}
+
+	void NullRenderImage::SubmitCommandBuffer(CommandBuffer* commandBuffer, QueueTypeFlags /*queueTypeFlags*/)
+	{
+		m_owner.GetDevice().RegisterCommandBufferSubmission(commandBuffer->GetStatistics());
+	}
+
+	void NullRenderImage::SynchronizeQueues(QueueType /*waitingQueue*/, QueueType /*signalingQueue*/)
+	{
+		/* nothing to do */
+	}
+}
@@ -0,0 +1,24 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/NullRenderer/NullRenderPipelineLayout.hpp>
+#include <Nazara/NullRenderer/Debug.hpp>
+
+namespace Nz
+{
+	ShaderBindingPtr NullRenderPipelineLayout::AllocateShaderBinding(UInt32 /*setIndex*/)
+	{
+		return ShaderBindingPtr(new NullShaderBinding(*this));
+	}
+
+	void NullRenderPipelineLayout::UpdateDebugName(std::string_view /*name*/)
+	{
+		// No object to name
+	}
+
+	void NullRenderPipelineLayout::Release(ShaderBinding& binding)
+	{
+		delete static_cast<NullShaderBinding*>(&binding);
+	}
+}
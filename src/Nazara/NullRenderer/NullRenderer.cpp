@@ -0,0 +1,46 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/NullRenderer/NullRenderer.hpp>
+#include <cassert>
+#include <Nazara/NullRenderer/Debug.hpp>
+
+namespace Nz
+{
+	std::shared_ptr<RenderDevice> NullRenderer::InstanciateRenderDevice([[maybe_unused]] std::size_t deviceIndex, const RenderDeviceFeatures& enabledFeatures)
+	{
+		assert(deviceIndex < m_deviceInfos.size());
+
+		RenderDeviceFeatures validatedFeatures = enabledFeatures;
+		RenderDevice::ValidateFeatures(m_deviceInfos[deviceIndex].features, validatedFeatures);
+
+		return std::make_shared<NullDevice>(m_deviceInfos[deviceIndex], validatedFeatures);
+	}
+
+	bool NullRenderer::Prepare(const Renderer::Config& /*config*/)
+	{
+		m_deviceInfos.push_back(NullDevice::BuildDeviceInfo());
+		return true;
+	}
+
+	RenderAPI NullRenderer::QueryAPI() const
+	{
+		return RenderAPI::Null;
+	}
+
+	std::string NullRenderer::QueryAPIString() const
+	{
+		return "Null renderer";
+	}
+
+	UInt32 NullRenderer::QueryAPIVersion() const
+	{
+		return 100;
+	}
+
+	const std::vector<RenderDeviceInfo>& NullRenderer::QueryRenderDevices() const
+	{
+		return m_deviceInfos;
+	}
+}
@@ -0,0 +1,25 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/NullRenderer/NullShaderBinding.hpp>
+#include <Nazara/NullRenderer/NullRenderPipelineLayout.hpp>
+#include <Nazara/NullRenderer/Debug.hpp>
+
+namespace Nz
+{
+	void NullShaderBinding::Update(const Binding* /*bindings*/, std::size_t /*bindingCount*/)
+	{
+		// No descriptor to update
+	}
+
+	void NullShaderBinding::UpdateDebugName(std::string_view /*name*/)
+	{
+		// No object to name
+	}
+
+	void NullShaderBinding::Release()
+	{
+		m_owner.Release(*this);
+	}
+}
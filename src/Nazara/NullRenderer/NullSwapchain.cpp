@@ -0,0 +1,106 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/NullRenderer/NullSwapchain.hpp>
+#include <Nazara/NullRenderer/NullCommandPool.hpp>
+#include <Nazara/NullRenderer/NullDevice.hpp>
+#include <Nazara/Renderer/RenderFrame.hpp>
+#include <Nazara/NullRenderer/Debug.hpp>
+
+namespace Nz
+{
+	NullSwapchain::NullSwapchain(NullDevice& device, const Vector2ui& size, const SwapchainParameters& parameters) :
+	m_currentFrame(0),
+	m_device(device),
+	m_framebuffer(FramebufferType::Window),
+	m_presentMode(PresentMode::Immediate),
+	m_size(size),
+	m_sizeInvalidated(false)
+	{
+		// Nothing is presented, so every present mode is supported
+		if (!parameters.presentMode.empty())
+			m_presentMode = parameters.presentMode.front();
+
+		std::vector<RenderPass::Attachment> attachments;
+		std::vector<RenderPass::SubpassDescription> subpassDescriptions;
+		std::vector<RenderPass::SubpassDependency> subpassDependencies;
+
+		BuildRenderPass(PixelFormat::RGBA8, PixelFormat::Depth24Stencil8, attachments, subpassDescriptions, subpassDependencies);
+		m_renderPass.emplace(std::move(attachments), std::move(subpassDescriptions), std::move(subpassDependencies));
+
+		constexpr std::size_t RenderImageCount = 2;
+
+		m_renderImage.reserve(RenderImageCount);
+		for (std::size_t i = 0; i < RenderImageCount; ++i)
+			m_renderImage.emplace_back(std::make_unique<NullRenderImage>(*this));
+	}
+
+	RenderFrame NullSwapchain::AcquireFrame()
+	{
+		bool sizeInvalidated = m_sizeInvalidated;
+		m_sizeInvalidated = false;
+
+		return RenderFrame(m_renderImage[m_currentFrame].get(), sizeInvalidated, m_size, 0);
+	}
+
+	std::shared_ptr<CommandPool> NullSwapchain::CreateCommandPool(QueueType /*queueType*/)
+	{
+		return std::make_shared<NullCommandPool>();
+	}
+
+	const NullFramebuffer& NullSwapchain::GetFramebuffer(std::size_t i) const
+	{
+		assert(i == 0);
+		NazaraUnused(i);
+		return m_framebuffer;
+	}
+
+	std::size_t NullSwapchain::GetFramebufferCount() const
+	{
+		return 1;
+	}
+
+	PresentMode NullSwapchain::GetPresentMode() const
+	{
+		return m_presentMode;
+	}
+
+	const NullRenderPass& NullSwapchain::GetRenderPass() const
+	{
+		return *m_renderPass;
+	}
+
+	const Vector2ui& NullSwapchain::GetSize() const
+	{
+		return m_size;
+	}
+
+	PresentModeFlags NullSwapchain::GetSupportedPresentModes() const
+	{
+		return PresentMode::Immediate | PresentMode::Mailbox | PresentMode::RelaxedVerticalSync | PresentMode::VerticalSync;
+	}
+
+	void NullSwapchain::NotifyResize(const Vector2ui& newSize)
+	{
+		OnRenderTargetSizeChange(this, newSize);
+
+		m_size = newSize;
+		m_sizeInvalidated = true;
+	}
+
+	void NullSwapchain::Present()
+	{
+		m_currentFrame = (m_currentFrame + 1) % m_renderImage.size();
+	}
+
+	void NullSwapchain::SetPresentMode(PresentMode presentMode)
+	{
+		m_presentMode = presentMode;
+	}
+
+	TransientResources& NullSwapchain::Transient()
+	{
+		return *m_renderImage[m_currentFrame];
+	}
+}
@@ -0,0 +1,53 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Null renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/NullRenderer/NullTexture.hpp>
+#include <Nazara/Utility/Image.hpp>
+#include <Nazara/NullRenderer/Debug.hpp>
+
+namespace Nz
+{
+	NullTexture::NullTexture(const TextureInfo& textureInfo) :
+	m_textureInfo(textureInfo)
+	{
+		m_textureInfo.levelCount = std::min(m_textureInfo.levelCount, Image::GetMaxLevel(m_textureInfo.type, m_textureInfo.width, m_textureInfo.height, m_textureInfo.depth));
+	}
+
+	NullTexture::NullTexture(std::shared_ptr<NullTexture> parentTexture, const TextureViewInfo& viewInfo) :
+	m_parentTexture(std::move(parentTexture))
+	{
+		NazaraAssert(viewInfo.layerCount <= m_parentTexture->m_textureInfo.layerCount - viewInfo.baseArrayLayer, "layer count exceeds number of layers");
+		NazaraAssert(viewInfo.levelCount <= m_parentTexture->m_textureInfo.levelCount - viewInfo.baseMipLevel, "level count exceeds number of levels");
+
+		m_textureInfo = ApplyView(m_parentTexture->m_textureInfo, viewInfo);
+	}
+
+	bool NullTexture::Copy(const Texture& /*source*/, const Boxui& /*srcBox*/, const Vector3ui& /*dstPos*/)
+	{
+		// Texture contents are not stored
+		return true;
+	}
+
+	std::shared_ptr<Texture> NullTexture::CreateView(const TextureViewInfo& viewInfo)
+	{
+		if (m_parentTexture)
+		{
+			assert(!m_parentTexture->m_parentTexture); //< views of views are not allowed (to prevent cycles)
+			return std::make_shared<NullTexture>(m_parentTexture, viewInfo);
+		}
+
+		return std::make_shared<NullTexture>(std::static_pointer_cast<NullTexture>(shared_from_this()), viewInfo);
+	}
+
+	bool NullTexture::Update(const void* /*ptr*/, const Boxui& /*box*/, unsigned int /*srcWidth*/, unsigned int /*srcHeight*/, UInt8 /*level*/)
+	{
+		// Texture contents are not stored
+		return true;
+	}
+
+	void NullTexture::UpdateDebugName(std::string_view /*name*/)
+	{
+		// No object to name
+	}
+}
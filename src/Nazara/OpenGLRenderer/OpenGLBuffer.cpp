@@ -4,13 +4,15 @@
 
 #include <Nazara/OpenGLRenderer/OpenGLBuffer.hpp>
 #include <NazaraUtils/CallOnExit.hpp>
+#include <cstring>
 #include <stdexcept>
 #include <Nazara/OpenGLRenderer/Debug.hpp>
 
 namespace Nz
 {
 	OpenGLBuffer::OpenGLBuffer(OpenGLDevice& device, BufferType type, UInt64 size, BufferUsageFlags usage, const void* initialData) :
-	RenderBuffer(device, type, size, usage)
+	RenderBuffer(device, type, size, usage),
+	m_persistentMapping(nullptr)
 	{
 		if (!m_buffer.Create(device))
 			throw std::runtime_error("failed to create buffer"); //< TODO: Handle OpenGL error
@@ -27,6 +29,29 @@ namespace Nz
 				throw std::runtime_error("unknown buffer type 0x" + NumberToString(UnderlyingCast(type), 16));
 		}
 
+		if (usage & BufferUsage::DirectMapping && device.GetReferenceContext().IsExtensionSupported(GL::Extension::BufferStorage))
+		{
+			GLbitfield accessBit = 0;
+			if (usage & BufferUsage::Read)
+				accessBit |= GL_MAP_READ_BIT;
+
+			if (usage & BufferUsage::Write)
+				accessBit |= GL_MAP_WRITE_BIT;
+
+			if (accessBit != 0)
+			{
+				// Immutable storage can stay mapped for its whole lifetime, which saves a map/unmap round-trip on every update
+				accessBit |= GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+				m_buffer.Storage(target, GLsizeiptr(size), initialData, accessBit | GL_DYNAMIC_STORAGE_BIT);
+				m_persistentMapping = static_cast<UInt8*>(m_buffer.MapRange(0, GLsizeiptr(size), accessBit));
+				if (!m_persistentMapping)
+					throw std::runtime_error("failed to map buffer storage");
+
+				return;
+			}
+		}
+
 		GLenum hint = GL_STREAM_COPY;
 
 		if (usage & BufferUsage::Dynamic)
@@ -42,12 +67,21 @@ namespace Nz
 
 	bool OpenGLBuffer::Fill(const void* data, UInt64 offset, UInt64 size)
 	{
+		if (m_persistentMapping)
+		{
+			std::memcpy(m_persistentMapping + offset, data, size);
+			return true;
+		}
+
 		m_buffer.SubData(GLintptr(offset), GLsizeiptr(size), data);
 		return true;
 	}
 
 	void* OpenGLBuffer::Map(UInt64 offset, UInt64 size)
 	{
+		if (m_persistentMapping)
+			return m_persistentMapping + offset;
+
 		GLbitfield accessBit = 0;
 		if (GetUsageFlags() & BufferUsage::Read)
 			accessBit |= GL_MAP_READ_BIT;
@@ -60,6 +94,9 @@ namespace Nz
 
 	bool OpenGLBuffer::Unmap()
 	{
+		if (m_persistentMapping)
+			return true; //< persistent mappings are coherent and only released with the buffer
+
 		return m_buffer.Unmap();
 	}
 
@@ -5,6 +5,7 @@
 #include <Nazara/OpenGLRenderer/OpenGLCommandBuffer.hpp>
 #include <Nazara/OpenGLRenderer/OpenGLCommandPool.hpp>
 #include <Nazara/OpenGLRenderer/OpenGLComputePipeline.hpp>
+#include <Nazara/OpenGLRenderer/OpenGLDevice.hpp>
 #include <Nazara/OpenGLRenderer/OpenGLFboFramebuffer.hpp>
 #include <Nazara/OpenGLRenderer/OpenGLRenderPass.hpp>
 #include <Nazara/OpenGLRenderer/OpenGLRenderPipelineLayout.hpp>
@@ -14,6 +15,7 @@
 #include <Nazara/OpenGLRenderer/Wrapper/VertexArray.hpp>
 #include <NazaraUtils/StackArray.hpp>
 #include <NazaraUtils/StackVector.hpp>
+#include <cstring>
 #include <Nazara/OpenGLRenderer/Debug.hpp>
 
 namespace Nz
@@ -48,6 +50,39 @@ namespace Nz
 					attrib.type = GL_INT;
 					return;
 
+				case ComponentType::Half2:
+				case ComponentType::Half4:
+					attrib.normalized = GL_FALSE;
+					attrib.size = (component == ComponentType::Half2) ? 2 : 4;
+					attrib.type = GL_HALF_FLOAT;
+					return;
+
+				case ComponentType::SNorm8x4:
+					attrib.normalized = GL_TRUE;
+					attrib.size = 4;
+					attrib.type = GL_BYTE;
+					return;
+
+				case ComponentType::SNorm16x2:
+				case ComponentType::SNorm16x4:
+					attrib.normalized = GL_TRUE;
+					attrib.size = (component == ComponentType::SNorm16x2) ? 2 : 4;
+					attrib.type = GL_SHORT;
+					return;
+
+				case ComponentType::UNorm8x4:
+					attrib.normalized = GL_TRUE;
+					attrib.size = 4;
+					attrib.type = GL_UNSIGNED_BYTE;
+					return;
+
+				case ComponentType::UNorm16x2:
+				case ComponentType::UNorm16x4:
+					attrib.normalized = GL_TRUE;
+					attrib.size = (component == ComponentType::UNorm16x2) ? 2 : 4;
+					attrib.type = GL_UNSIGNED_SHORT;
+					return;
+
 				case ComponentType::Double1:
 				case ComponentType::Double2:
 				case ComponentType::Double3:
@@ -63,6 +98,15 @@ namespace Nz
 	{
 		const GL::Context* context = GL::Context::GetCurrentContext();
 
+		// Push constants can't change once recorded, upload every snapshot once and reuse them for every execution
+		if (!m_pushConstantData.empty() && !m_pushConstantBuffer.IsValid())
+		{
+			if (!m_pushConstantBuffer.Create(m_owner->GetDevice()))
+				throw std::runtime_error("failed to create push constant buffer");
+
+			m_pushConstantBuffer.Reset(GL::BufferTarget::Uniform, GLsizeiptr(m_pushConstantData.size()), m_pushConstantData.data(), GL_STATIC_DRAW);
+		}
+
 		for (const auto& commandVariant : m_commands)
 		{
 			switch (commandVariant.index())
@@ -78,6 +122,30 @@ namespace Nz
 		}
 	}
 
+	void OpenGLCommandBuffer::PushConstants(const OpenGLRenderPipelineLayout& pipelineLayout, UInt32 offset, UInt32 size, const void* data)
+	{
+		UInt32 pushConstantSize = pipelineLayout.GetPushConstantSize();
+		NazaraAssert(offset + size <= pushConstantSize, "push constants are out of the pipeline layout push constant ranges");
+
+		if (m_currentPushConstants.size() < pushConstantSize)
+			m_currentPushConstants.resize(pushConstantSize);
+
+		std::memcpy(&m_currentPushConstants[offset], data, size);
+
+		// The uniform block is bound as a whole, take a snapshot of every push constant for the next commands
+		std::size_t alignment = SafeCast<std::size_t>(m_owner->GetDevice().GetDeviceInfo().limits.minUniformBufferOffsetAlignment);
+		std::size_t snapshotOffset = AlignPow2(m_pushConstantData.size(), alignment);
+
+		m_pushConstantData.resize(snapshotOffset + pushConstantSize);
+		std::memcpy(&m_pushConstantData[snapshotOffset], m_currentPushConstants.data(), pushConstantSize);
+
+		for (ShaderBindings* bindings : { &m_currentComputeShaderBindings, &m_currentGraphicsShaderBindings })
+		{
+			bindings->pushConstantLayout = &pipelineLayout;
+			bindings->pushConstantOffset = snapshotOffset;
+		}
+	}
+
 	void OpenGLCommandBuffer::UpdateDebugName(std::string_view /*name*/)
 	{
 		// No OpenGL object to name
@@ -95,6 +163,12 @@ namespace Nz
 
 			setIndex++;
 		}
+
+		if (states.pushConstantLayout)
+		{
+			assert(m_pushConstantBuffer.IsValid());
+			context.BindUniformBuffer(states.pushConstantLayout->GetPushConstantBinding(), m_pushConstantBuffer.GetObjectId(), GLintptr(states.pushConstantOffset), GLsizeiptr(states.pushConstantLayout->GetPushConstantSize()));
+		}
 	}
 
 	void OpenGLCommandBuffer::ApplyStates(const GL::Context& context, const DrawStates& states)
@@ -203,6 +277,38 @@ namespace Nz
 		context->glDrawElementsInstanced(ToOpenGL(command.states.pipeline->GetPipelineInfo().primitiveMode), command.indexCount, ToOpenGL(command.states.indexBufferType), origin, command.instanceCount);
 	}
 
+	inline void OpenGLCommandBuffer::Execute(const GL::Context* context, const DrawIndexedIndirectCommand& command)
+	{
+		if (!context->glDrawElementsIndirect)
+			throw std::runtime_error("indirect draws are not supported on this device");
+
+		const UInt8* origin = 0; //< For an easy way to cast an integer to a pointer
+		origin += command.indirectOffset;
+
+		GLenum primitiveMode = ToOpenGL(command.states.pipeline->GetPipelineInfo().primitiveMode);
+		GLenum indexType = ToOpenGL(command.states.indexBufferType);
+
+		ApplyStates(*context, command.states);
+		ApplyBindings(*context, command.bindings);
+		context->BindBuffer(GL::BufferTarget::DrawIndirect, command.indirectBuffer);
+
+		if (command.countBuffer != 0)
+		{
+			if (!context->glMultiDrawElementsIndirectCount)
+				throw std::runtime_error("indirect draw count is not supported on this device");
+
+			context->BindBuffer(GL::BufferTarget::Parameter, command.countBuffer);
+			context->glMultiDrawElementsIndirectCount(primitiveMode, indexType, origin, GLintptr(command.countOffset), GLsizei(command.drawCount), GLsizei(command.stride));
+		}
+		else if (context->glMultiDrawElementsIndirect)
+			context->glMultiDrawElementsIndirect(primitiveMode, indexType, origin, GLsizei(command.drawCount), GLsizei(command.stride));
+		else
+		{
+			for (UInt32 i = 0; i < command.drawCount; ++i)
+				context->glDrawElementsIndirect(primitiveMode, indexType, origin + i * command.stride);
+		}
+	}
+
 	inline void OpenGLCommandBuffer::Execute(const GL::Context* context, const EndDebugRegionCommand& /*command*/)
 	{
 		if (context->glPopDebugGroup)
@@ -221,6 +327,48 @@ namespace Nz
 			context->glMemoryBarrier(command.barriers);
 	}
 
+	inline void OpenGLCommandBuffer::Execute(const GL::Context* context, const MultiDrawIndexedCommand& command)
+	{
+		GLenum primitiveMode = ToOpenGL(command.states.pipeline->GetPipelineInfo().primitiveMode);
+		GLenum indexType = ToOpenGL(command.states.indexBufferType);
+
+		ApplyStates(*context, command.states);
+		ApplyBindings(*context, command.bindings);
+
+		if (context->glMultiDrawElementsIndirect)
+		{
+			// Draws can't change once recorded, upload them once and reuse them for every execution
+			if (!command.indirectBuffer.IsValid())
+			{
+				if (!command.indirectBuffer.Create(m_owner->GetDevice()))
+					throw std::runtime_error("failed to create indirect buffer");
+
+				command.indirectBuffer.Reset(GL::BufferTarget::DrawIndirect, GLsizeiptr(command.draws.size() * sizeof(DrawElementsIndirectCommand)), command.draws.data(), GL_STATIC_DRAW);
+			}
+
+			context->BindBuffer(GL::BufferTarget::DrawIndirect, command.indirectBuffer.GetObjectId());
+			context->glMultiDrawElementsIndirect(primitiveMode, indexType, nullptr, GLsizei(command.draws.size()), GLsizei(sizeof(DrawElementsIndirectCommand)));
+		}
+		else
+		{
+			UInt64 indexSize = 0;
+			switch (command.states.indexBufferType)
+			{
+				case IndexType::U8:  indexSize = sizeof(UInt8); break;
+				case IndexType::U16: indexSize = sizeof(UInt16); break;
+				case IndexType::U32: indexSize = sizeof(UInt32); break;
+			}
+
+			for (const DrawElementsIndirectCommand& draw : command.draws)
+			{
+				const UInt8* origin = 0; //< For an easy way to cast an integer to a pointer
+				origin += draw.firstIndex * indexSize;
+
+				context->glDrawElementsInstanced(primitiveMode, GLsizei(draw.count), indexType, origin, GLsizei(draw.instanceCount));
+			}
+		}
+	}
+
 	inline void OpenGLCommandBuffer::Execute(const GL::Context*& context, const SetFrameBufferCommand& command)
 	{
 		command.framebuffer->Activate();
@@ -367,8 +515,7 @@ namespace Nz
 				{
 					context->ResetColorWriteMasks();
 
-					const Color& color = command.clearValues[colorAttachmentIndex].color;
-					context->glClearColor(color.r, color.g, color.b, color.a);
+					context->SetClearColor(command.clearValues[colorAttachmentIndex].color);
 
 					clearFields |= GL_COLOR_BUFFER_BIT;
 				}
@@ -385,7 +532,7 @@ namespace Nz
 				if (depthStencilAttachment.loadOp == AttachmentLoadOp::Clear)
 				{
 					context->ResetDepthWriteMasks();
-					context->glClearDepthf(clearValues.depth);
+					context->SetClearDepth(clearValues.depth);
 					clearFields |= GL_DEPTH_BUFFER_BIT;
 				}
 				else if (depthStencilAttachment.loadOp == AttachmentLoadOp::Discard)
@@ -394,7 +541,7 @@ namespace Nz
 				if (depthStencilAttachment.stencilLoadOp == AttachmentLoadOp::Clear && PixelFormatInfo::GetContent(depthStencilAttachment.format) == PixelFormatContent::DepthStencil)
 				{
 					context->ResetStencilWriteMasks();
-					context->glClearStencil(clearValues.stencil);
+					context->SetClearStencil(static_cast<GLint>(clearValues.stencil));
 					clearFields |= GL_STENCIL_BUFFER_BIT;
 				}
 				else if (depthStencilAttachment.stencilLoadOp == AttachmentLoadOp::Discard)
@@ -24,11 +24,15 @@ namespace Nz
 
 	void OpenGLCommandBufferBuilder::BeginRenderPass(const Framebuffer& framebuffer, const RenderPass& renderPass, const Recti& /*renderRect*/, const ClearValues* clearValues, std::size_t clearValueCount)
 	{
+		m_statistics.renderPassCount++;
+
 		m_commandBuffer.SetFramebuffer(static_cast<const OpenGLFramebuffer&>(framebuffer), static_cast<const OpenGLRenderPass&>(renderPass), clearValues, clearValueCount);
 	}
 
 	void OpenGLCommandBufferBuilder::BindComputePipeline(const ComputePipeline& pipeline)
 	{
+		m_statistics.pipelineBindCount++;
+
 		const OpenGLComputePipeline& glPipeline = static_cast<const OpenGLComputePipeline&>(pipeline);
 
 		m_commandBuffer.BindComputePipeline(&glPipeline);
@@ -36,6 +40,8 @@ namespace Nz
 
 	void OpenGLCommandBufferBuilder::BindComputeShaderBinding(UInt32 set, const ShaderBinding& binding)
 	{
+		m_statistics.shaderBindingBindCount++;
+
 		const OpenGLShaderBinding& glBinding = static_cast<const OpenGLShaderBinding&>(binding);
 
 		m_commandBuffer.BindComputeShaderBinding(glBinding.GetOwner(), set, &glBinding);
@@ -43,6 +49,8 @@ namespace Nz
 
 	void OpenGLCommandBufferBuilder::BindComputeShaderBinding(const RenderPipelineLayout& pipelineLayout, UInt32 set, const ShaderBinding& binding)
 	{
+		m_statistics.shaderBindingBindCount++;
+
 		const OpenGLRenderPipelineLayout& glPipelineLayout = static_cast<const OpenGLRenderPipelineLayout&>(pipelineLayout);
 		const OpenGLShaderBinding& glBinding = static_cast<const OpenGLShaderBinding&>(binding);
 
@@ -58,6 +66,8 @@ namespace Nz
 
 	void OpenGLCommandBufferBuilder::BindRenderPipeline(const RenderPipeline& pipeline)
 	{
+		m_statistics.pipelineBindCount++;
+
 		const OpenGLRenderPipeline& glPipeline = static_cast<const OpenGLRenderPipeline&>(pipeline);
 
 		m_commandBuffer.BindRenderPipeline(&glPipeline);
@@ -65,6 +75,8 @@ namespace Nz
 
 	void OpenGLCommandBufferBuilder::BindRenderShaderBinding(UInt32 set, const ShaderBinding& binding)
 	{
+		m_statistics.shaderBindingBindCount++;
+
 		const OpenGLShaderBinding& glBinding = static_cast<const OpenGLShaderBinding&>(binding);
 
 		m_commandBuffer.BindRenderShaderBinding(glBinding.GetOwner(), set, &glBinding);
@@ -72,6 +84,8 @@ namespace Nz
 
 	void OpenGLCommandBufferBuilder::BindRenderShaderBinding(const RenderPipelineLayout& pipelineLayout, UInt32 set, const ShaderBinding& binding)
 	{
+		m_statistics.shaderBindingBindCount++;
+
 		const OpenGLRenderPipelineLayout& glPipelineLayout = static_cast<const OpenGLRenderPipelineLayout&>(pipelineLayout);
 		const OpenGLShaderBinding& glBinding = static_cast<const OpenGLShaderBinding&>(binding);
 
@@ -102,6 +116,8 @@ namespace Nz
 
 	void OpenGLCommandBufferBuilder::CopyBuffer(const RenderBufferView& source, const RenderBufferView& target, UInt64 size, UInt64 sourceOffset, UInt64 targetOffset)
 	{
+		m_statistics.transferredBytes += size;
+
 		OpenGLBuffer& sourceBuffer = *static_cast<OpenGLBuffer*>(source.GetBuffer());
 		OpenGLBuffer& targetBuffer = *static_cast<OpenGLBuffer*>(target.GetBuffer());
 
@@ -110,6 +126,8 @@ namespace Nz
 
 	void OpenGLCommandBufferBuilder::CopyBuffer(const UploadPool::Allocation& allocation, const RenderBufferView& target, UInt64 size, UInt64 sourceOffset, UInt64 targetOffset)
 	{
+		m_statistics.transferredBytes += size;
+
 		OpenGLBuffer& targetBuffer = *static_cast<OpenGLBuffer*>(target.GetBuffer());
 
 		m_commandBuffer.CopyBuffer(allocation, targetBuffer.GetBuffer().GetObjectId(), size, sourceOffset, target.GetOffset() + targetOffset);
@@ -125,19 +143,46 @@ namespace Nz
 
 	void OpenGLCommandBufferBuilder::Dispatch(UInt32 workgroupX, UInt32 workgroupY, UInt32 workgroupZ)
 	{
+		m_statistics.computeDispatchCount++;
+
 		m_commandBuffer.Dispatch(workgroupX, workgroupY, workgroupZ);
 	}
 
 	void OpenGLCommandBufferBuilder::Draw(UInt32 vertexCount, UInt32 instanceCount, UInt32 firstVertex, UInt32 firstInstance)
 	{
+		m_statistics.drawCallCount++;
+		m_statistics.drawnVertexCount += UInt64(vertexCount) * instanceCount;
+
 		m_commandBuffer.Draw(vertexCount, instanceCount, firstVertex, firstInstance);
 	}
 
 	void OpenGLCommandBufferBuilder::DrawIndexed(UInt32 indexCount, UInt32 instanceCount, UInt32 firstIndex, UInt32 firstInstance)
 	{
+		m_statistics.drawCallCount++;
+		m_statistics.drawnVertexCount += UInt64(indexCount) * instanceCount;
+
 		m_commandBuffer.DrawIndexed(indexCount, instanceCount, firstIndex, firstInstance);
 	}
 
+	void OpenGLCommandBufferBuilder::DrawIndexedIndirect(const RenderBufferView& indirectBuffer, UInt32 drawCount, UInt32 stride)
+	{
+		m_statistics.drawCallCount += drawCount;
+
+		OpenGLBuffer& glBuffer = *static_cast<OpenGLBuffer*>(indirectBuffer.GetBuffer());
+
+		m_commandBuffer.DrawIndexedIndirect(glBuffer.GetBuffer().GetObjectId(), indirectBuffer.GetOffset(), drawCount, stride);
+	}
+
+	void OpenGLCommandBufferBuilder::DrawIndexedIndirectCount(const RenderBufferView& indirectBuffer, const RenderBufferView& countBuffer, UInt32 maxDrawCount, UInt32 stride)
+	{
+		m_statistics.drawCallCount++; //< actual draw count is only known by the GPU
+
+		OpenGLBuffer& glBuffer = *static_cast<OpenGLBuffer*>(indirectBuffer.GetBuffer());
+		OpenGLBuffer& glCountBuffer = *static_cast<OpenGLBuffer*>(countBuffer.GetBuffer());
+
+		m_commandBuffer.DrawIndexedIndirect(glBuffer.GetBuffer().GetObjectId(), indirectBuffer.GetOffset(), maxDrawCount, stride, glCountBuffer.GetBuffer().GetObjectId(), countBuffer.GetOffset());
+	}
+
 	void OpenGLCommandBufferBuilder::EndDebugRegion()
 	{
 		m_commandBuffer.EndDebugRegion();
@@ -153,6 +198,36 @@ namespace Nz
 		m_commandBuffer.InsertDebugLabel(label, color);
 	}
 
+	void OpenGLCommandBufferBuilder::MemoryBarrier(PipelineStageFlags /*srcStageMask*/, PipelineStageFlags /*dstStageMask*/, MemoryAccessFlags srcAccessMask, MemoryAccessFlags dstAccessMask)
+	{
+		// Only writes from shaders are incoherent with OpenGL
+		if (srcAccessMask.Test(MemoryAccess::ShaderWrite))
+		{
+			GLbitfield barriers = 0;
+
+			if (dstAccessMask.Test(MemoryAccess::IndexBufferRead))
+				barriers |= GL_ELEMENT_ARRAY_BARRIER_BIT;
+
+			if (dstAccessMask.Test(MemoryAccess::IndirectCommandRead))
+				barriers |= GL_COMMAND_BARRIER_BIT;
+
+			if (dstAccessMask.Test(MemoryAccess::ShaderRead) || dstAccessMask.Test(MemoryAccess::ShaderWrite))
+				barriers |= GL_SHADER_STORAGE_BARRIER_BIT;
+
+			if (dstAccessMask.Test(MemoryAccess::TransferRead) || dstAccessMask.Test(MemoryAccess::TransferWrite))
+				barriers |= GL_BUFFER_UPDATE_BARRIER_BIT;
+
+			if (dstAccessMask.Test(MemoryAccess::UniformBufferRead))
+				barriers |= GL_UNIFORM_BARRIER_BIT;
+
+			if (dstAccessMask.Test(MemoryAccess::VertexBufferRead))
+				barriers |= GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT;
+
+			if (barriers != 0)
+				m_commandBuffer.InsertMemoryBarrier(barriers);
+		}
+	}
+
 	void OpenGLCommandBufferBuilder::NextSubpass()
 	{
 		/* nothing to do */
@@ -168,6 +243,13 @@ namespace Nz
 		m_commandBuffer.InsertMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
 	}
 
+	void OpenGLCommandBufferBuilder::PushConstants(const RenderPipelineLayout& pipelineLayout, UInt32 offset, UInt32 size, const void* data)
+	{
+		const OpenGLRenderPipelineLayout& glPipelineLayout = static_cast<const OpenGLRenderPipelineLayout&>(pipelineLayout);
+
+		m_commandBuffer.PushConstants(glPipelineLayout, offset, size, data);
+	}
+
 	void OpenGLCommandBufferBuilder::SetScissor(const Recti& scissorRegion)
 	{
 		m_commandBuffer.SetScissor(scissorRegion);
@@ -178,6 +260,12 @@ namespace Nz
 		m_commandBuffer.SetViewport(viewportRegion);
 	}
 
+	void OpenGLCommandBufferBuilder::TextureAcquireBarrier(PipelineStageFlags srcStageMask, PipelineStageFlags dstStageMask, MemoryAccessFlags srcAccessMask, MemoryAccessFlags dstAccessMask, TextureLayout oldLayout, TextureLayout newLayout, QueueType /*srcQueue*/, QueueType /*dstQueue*/, const Texture& texture)
+	{
+		// OpenGL only has one queue, the acquire half performs the whole barrier
+		return TextureBarrier(srcStageMask, dstStageMask, srcAccessMask, dstAccessMask, oldLayout, newLayout, texture);
+	}
+
 	void OpenGLCommandBufferBuilder::TextureBarrier(PipelineStageFlags /*srcStageMask*/, PipelineStageFlags /*dstStageMask*/, MemoryAccessFlags srcAccessMask, MemoryAccessFlags dstAccessMask, TextureLayout /*oldLayout*/, TextureLayout /*newLayout*/, const Texture& /*texture*/)
 	{
 		if (srcAccessMask.Test(MemoryAccess::ShaderWrite))
@@ -197,4 +285,9 @@ namespace Nz
 				m_commandBuffer.InsertMemoryBarrier(barriers);
 		}
 	}
+
+	void OpenGLCommandBufferBuilder::TextureReleaseBarrier(PipelineStageFlags /*srcStageMask*/, PipelineStageFlags /*dstStageMask*/, MemoryAccessFlags /*srcAccessMask*/, MemoryAccessFlags /*dstAccessMask*/, TextureLayout /*oldLayout*/, TextureLayout /*newLayout*/, QueueType /*srcQueue*/, QueueType /*dstQueue*/, const Texture& /*texture*/)
+	{
+		/* nothing to do */
+	}
 }
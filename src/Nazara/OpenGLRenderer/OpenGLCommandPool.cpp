@@ -33,6 +33,8 @@ namespace Nz
 		OpenGLCommandBufferBuilder builder(static_cast<OpenGLCommandBuffer&>(*commandBuffer.get()));
 		callback(builder);
 
+		commandBuffer->UpdateStatistics(builder.GetStatistics());
+
 		return commandBuffer;
 	}
 
@@ -32,15 +32,12 @@ namespace Nz
 		OpenGLShaderModule& shaderModule = static_cast<OpenGLShaderModule&>(*m_pipelineInfo.shaderModule);
 
 		std::vector<OpenGLShaderModule::ExplicitBinding> explicitBindings;
-		nzsl::ShaderStageTypeFlags stageFlags = shaderModule.Attach(m_program, pipelineLayout.GetBindingMapping(), &explicitBindings);
+		std::vector<OpenGLShaderModule::Source> sources;
+		nzsl::ShaderStageTypeFlags stageFlags = shaderModule.GenerateSources(pipelineLayout.GetBindingMapping(), sources, &explicitBindings);
 		if (!stageFlags.Test(nzsl::ShaderStageType::Compute))
 			throw std::runtime_error("shader module has no compute stage");
 
-		m_program.Link();
-
-		std::string errLog;
-		if (!m_program.GetLinkStatus(&errLog))
-			throw std::runtime_error("failed to link program: " + errLog);
+		OpenGLShaderModule::LinkProgram(device, m_program, sources);
 
 		for (const auto& explicitBinding : explicitBindings)
 		{
@@ -3,6 +3,9 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/OpenGLRenderer/OpenGLDevice.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/Hash/XXH64.hpp>
 #include <Nazara/OpenGLRenderer/OpenGLBuffer.hpp>
 #include <Nazara/OpenGLRenderer/OpenGLCommandBufferBuilder.hpp>
 #include <Nazara/OpenGLRenderer/OpenGLCommandPool.hpp>
@@ -16,16 +19,22 @@
 #include <Nazara/OpenGLRenderer/OpenGLTexture.hpp>
 #include <Nazara/OpenGLRenderer/OpenGLTextureSampler.hpp>
 #include <Nazara/OpenGLRenderer/Wrapper/Loader.hpp>
+#include <Nazara/OpenGLRenderer/Wrapper/Program.hpp>
 #include <Nazara/Renderer/CommandPool.hpp>
 #include <NazaraUtils/Algorithm.hpp>
 #include <array>
+#include <cstring>
 #include <stdexcept>
 #include <Nazara/OpenGLRenderer/Debug.hpp>
 
 namespace Nz
 {
 	OpenGLDevice::OpenGLDevice(GL::Loader& loader, const Renderer::Config& config) :
-	m_loader(loader)
+	m_loader(loader),
+	m_completedTimelineValue(0),
+	m_signaledTimelineValue(0),
+	m_isProgramBinarySupported(false),
+	m_isProgramCacheUpdated(false)
 	{
 		GL::ContextParams params;
 		params.type = loader.GetPreferredContextType();
@@ -72,6 +81,12 @@ namespace Nz
 		if (m_referenceContext->IsExtensionSupported(GL::Extension::DepthClamp))
 			m_deviceInfo.features.depthClamping = true;
 
+		if (m_referenceContext->glMultiDrawElementsIndirectCount)
+			m_deviceInfo.features.drawIndirectCount = true;
+
+		if (m_referenceContext->glMultiDrawElementsIndirect)
+			m_deviceInfo.features.multiDrawIndirect = true;
+
 		if (m_referenceContext->glPolygonMode) //< not supported in core OpenGL ES, but supported in OpenGL or with GL_NV_polygon_mode extension
 			m_deviceInfo.features.nonSolidFaceFilling = true;
 
@@ -91,6 +106,7 @@ namespace Nz
 			m_deviceInfo.features.unrestrictedTextureViews = true;
 
 		// Limits
+		m_deviceInfo.limits.maxPushConstantsSize = OpenGLRenderPipelineLayout::MaxPushConstantsSize; //< emulated with a uniform buffer
 		m_deviceInfo.limits.maxUniformBufferSize = m_referenceContext->GetInteger<UInt64>(GL_MAX_UNIFORM_BLOCK_SIZE);
 		m_deviceInfo.limits.minUniformBufferOffsetAlignment = RoundToPow2(m_referenceContext->GetInteger<UInt64>(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT));
 
@@ -118,11 +134,50 @@ namespace Nz
 			};
 		}
 
+		// Program binaries are only valid for the driver which generated them, identify it using its strings
+		{
+			XXH64Hasher hasher;
+			hasher.Begin();
+			for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+			{
+				if (const GLubyte* str = m_referenceContext->glGetString(name))
+					hasher.Append(str, std::strlen(reinterpret_cast<const char*>(str)));
+			}
+
+			ByteArray digest = hasher.End();
+			std::memcpy(&m_driverHash, digest.GetConstBuffer(), sizeof(m_driverHash));
+		}
+
+#ifndef NAZARA_PLATFORM_WEB
+		// WebGL doesn't expose program binaries
+		if (m_referenceContext->glGetProgramBinary && m_referenceContext->glProgramBinary && m_referenceContext->glProgramParameteri)
+			m_isProgramBinarySupported = (m_referenceContext->GetInteger<GLint>(GL_NUM_PROGRAM_BINARY_FORMATS) > 0);
+#endif
+
 		m_contexts.insert(m_referenceContext.get());
+
+		if (auto result = config.customParameters.GetStringParameter("GLDeviceInfo_ProgramCachePath"))
+			InitializeProgramCache(Utf8Path(std::move(result).GetValue()));
+
+#ifndef NAZARA_PLATFORM_WEB
+		// WebGL contexts are bound to the browser main thread
+		if (config.customParameters.GetBooleanParameter("GLDeviceInfo_UseSubmissionThread").GetValueOr(false))
+			m_submissionThread = std::make_unique<OpenGLSubmissionThread>();
+#endif
 	}
 
 	OpenGLDevice::~OpenGLDevice()
 	{
+		// Swapchains release their contexts from the submission thread when destroyed, this executes remaining jobs
+		m_submissionThread.reset();
+
+		// Pending sync objects are freed along with the contexts
+		m_pendingSyncs.clear();
+		ReleaseAllResources();
+
+		if (m_isProgramCacheUpdated && IsProgramCacheEnabled())
+			SaveProgramCache();
+
 		// Free reference context first as it will unregister itself from m_contexts
 		m_referenceContext.reset();
 	}
@@ -168,6 +223,88 @@ namespace Nz
 		return m_deviceInfo.features;
 	}
 
+	/*!
+	* \brief Enables the program binary cache, loading binaries previously saved in a file
+	* \return True if the cache file was loaded, false if it doesn't exist or couldn't be used (the cache is still enabled)
+	*
+	* Program binaries are retrieved from the driver after linking and saved to the file when the device is destroyed (or by calling SaveProgramCache),
+	* which allows to skip shader compilation on next runs. Binaries are only reused if the driver (vendor, renderer and version) didn't change.
+	*
+	* \param cacheFilePath Path of the cache file
+	*
+	* \remark This has no effect if the driver doesn't support program binaries (including WebGL)
+	*/
+	bool OpenGLDevice::InitializeProgramCache(std::filesystem::path cacheFilePath)
+	{
+		m_programBinaries.clear();
+		m_programCacheFilePath = std::move(cacheFilePath);
+		m_isProgramCacheUpdated = false;
+
+		if (!m_isProgramBinarySupported || m_programCacheFilePath.empty())
+			return false;
+
+		if (!std::filesystem::is_regular_file(m_programCacheFilePath))
+			return false;
+
+		std::optional<std::vector<UInt8>> fileContent = File::ReadWhole(m_programCacheFilePath);
+		if (!fileContent)
+		{
+			NazaraWarning("failed to read program cache file {0}", m_programCacheFilePath);
+			return false;
+		}
+
+		const std::vector<UInt8>& content = *fileContent;
+
+		ProgramCacheHeader header;
+		if (content.size() < sizeof(header))
+		{
+			NazaraWarning("program cache file {0} is corrupted, ignoring it", m_programCacheFilePath);
+			return false;
+		}
+
+		std::memcpy(&header, content.data(), sizeof(header));
+		if (header.magic != ProgramCacheMagic || header.version != ProgramCacheVersion)
+		{
+			NazaraWarning("program cache file {0} has an unsupported format, ignoring it", m_programCacheFilePath);
+			return false;
+		}
+
+		if (header.driverHash != m_driverHash)
+		{
+			NazaraWarning("program cache file {0} was created by another device or driver, ignoring it", m_programCacheFilePath);
+			return false;
+		}
+
+		std::size_t offset = sizeof(header);
+		for (UInt64 i = 0; i < header.programCount; ++i)
+		{
+			ProgramCacheEntryHeader entryHeader;
+			if (content.size() - offset < sizeof(entryHeader))
+				break;
+
+			std::memcpy(&entryHeader, &content[offset], sizeof(entryHeader));
+			offset += sizeof(entryHeader);
+
+			if (content.size() - offset < entryHeader.binarySize)
+				break;
+
+			ProgramBinary& programBinary = m_programBinaries[entryHeader.programHash];
+			programBinary.data.assign(&content[offset], &content[offset] + entryHeader.binarySize);
+			programBinary.format = entryHeader.binaryFormat;
+
+			offset += entryHeader.binarySize;
+		}
+
+		if (m_programBinaries.size() != header.programCount)
+		{
+			NazaraWarning("program cache file {0} is corrupted, ignoring it", m_programCacheFilePath);
+			m_programBinaries.clear();
+			return false;
+		}
+
+		return true;
+	}
+
 	std::shared_ptr<RenderBuffer> OpenGLDevice::InstantiateBuffer(BufferType type, UInt64 size, BufferUsageFlags usageFlags, const void* initialData)
 	{
 		return std::make_shared<OpenGLBuffer>(*this, type, size, usageFlags, initialData);
@@ -175,7 +312,7 @@ namespace Nz
 
 	std::shared_ptr<CommandPool> OpenGLDevice::InstantiateCommandPool(QueueType /*queueType*/)
 	{
-		return std::make_shared<OpenGLCommandPool>();
+		return std::make_shared<OpenGLCommandPool>(*this);
 	}
 
 	std::shared_ptr<ComputePipeline> OpenGLDevice::InstantiateComputePipeline(ComputePipelineInfo pipelineInfo)
@@ -293,13 +430,59 @@ namespace Nz
 			case PixelFormat::RGBA32F:
 			case PixelFormat::RGBA32I:
 			case PixelFormat::RGBA32UI:
-				return usage == TextureUsage::ColorAttachment || usage == TextureUsage::InputAttachment || usage == TextureUsage::ShaderSampling || usage == TextureUsage::ShaderReadWrite || usage == TextureUsage::TransferDestination || usage == TextureUsage::TransferSource;
-
+				return usage == TextureUsage::ColorAttachment || usage == TextureUsage::InputAttachment || usage == TextureUsage::ShaderSampling || usage == TextureUsage::ShaderReadWrite || usage == TextureUsage::TransferDestination || usage == TextureUsage::TransferSource || usage == TextureUsage::TransientAttachment || usage == TextureUsage::Streamed;
+
+			case PixelFormat::ASTC4x4:
+			case PixelFormat::ASTC4x4_SRGB:
+			case PixelFormat::ASTC8x8:
+			case PixelFormat::ASTC8x8_SRGB:
+			case PixelFormat::BC4:
+			case PixelFormat::BC5:
+			case PixelFormat::BC6H:
+			case PixelFormat::BC7:
+			case PixelFormat::BC7_SRGB:
 			case PixelFormat::DXT1:
 			case PixelFormat::DXT3:
 			case PixelFormat::DXT5:
+			case PixelFormat::ETC2_RGB8:
+			case PixelFormat::ETC2_RGB8_SRGB:
+			case PixelFormat::ETC2_RGBA8:
+			case PixelFormat::ETC2_RGBA8_SRGB:
 			{
-				if (!m_referenceContext->IsExtensionSupported(GL::Extension::TextureCompressionS3tc))
+				GL::Extension extension;
+				switch (format)
+				{
+					case PixelFormat::ASTC4x4:
+					case PixelFormat::ASTC4x4_SRGB:
+					case PixelFormat::ASTC8x8:
+					case PixelFormat::ASTC8x8_SRGB:
+						extension = GL::Extension::TextureCompressionASTC;
+						break;
+
+					case PixelFormat::BC4:
+					case PixelFormat::BC5:
+						extension = GL::Extension::TextureCompressionRGTC;
+						break;
+
+					case PixelFormat::BC6H:
+					case PixelFormat::BC7:
+					case PixelFormat::BC7_SRGB:
+						extension = GL::Extension::TextureCompressionBPTC;
+						break;
+
+					case PixelFormat::ETC2_RGB8:
+					case PixelFormat::ETC2_RGB8_SRGB:
+					case PixelFormat::ETC2_RGBA8:
+					case PixelFormat::ETC2_RGBA8_SRGB:
+						extension = GL::Extension::TextureCompressionETC2;
+						break;
+
+					default:
+						extension = GL::Extension::TextureCompressionS3tc;
+						break;
+				}
+
+				if (!m_referenceContext->IsExtensionSupported(extension))
 					return false;
 
 				return usage == TextureUsage::InputAttachment || usage == TextureUsage::ShaderSampling || usage == TextureUsage::TransferDestination || usage == TextureUsage::TransferSource;
@@ -315,14 +498,141 @@ namespace Nz
 			case PixelFormat::Stencil4:
 			case PixelFormat::Stencil8:
 			case PixelFormat::Stencil16:
-				return usage == TextureUsage::DepthStencilAttachment || usage == TextureUsage::ShaderSampling || usage == TextureUsage::TransferDestination || usage == TextureUsage::TransferSource;
+				return usage == TextureUsage::DepthStencilAttachment || usage == TextureUsage::ShaderSampling || usage == TextureUsage::TransferDestination || usage == TextureUsage::TransferSource || usage == TextureUsage::TransientAttachment || usage == TextureUsage::Streamed;
 		}
 
 		return false;
 	}
 
+	/*!
+	* \brief Loads a program from the binary cache
+	* \return True if the program was loaded and linked from its binary, false if it has to be built from source
+	*
+	* Binaries rejected by the driver are removed from the cache.
+	*
+	* \param program Program to load the binary into
+	* \param programHash Hash of the program sources
+	*/
+	bool OpenGLDevice::LoadProgramBinary(GL::Program& program, UInt64 programHash)
+	{
+		if (!IsProgramCacheEnabled())
+			return false;
+
+		auto it = m_programBinaries.find(programHash);
+		if (it == m_programBinaries.end())
+			return false;
+
+		const ProgramBinary& programBinary = it->second;
+		program.SetBinary(programBinary.format, programBinary.data.data(), SafeCast<GLsizei>(programBinary.data.size()));
+
+		if (!program.GetLinkStatus())
+		{
+			// Driver may reject binaries even with the same version string (updated without changing it), rebuild the program
+			m_programBinaries.erase(it);
+			m_isProgramCacheUpdated = true;
+			return false;
+		}
+
+		return true;
+	}
+
+	/*!
+	* \brief Saves the program binary cache to its file
+	* \return True if the cache was successfully saved
+	*
+	* \see InitializeProgramCache
+	*/
+	bool OpenGLDevice::SaveProgramCache() const
+	{
+		if (!IsProgramCacheEnabled())
+			return false;
+
+		ProgramCacheHeader header;
+		header.magic = ProgramCacheMagic;
+		header.version = ProgramCacheVersion;
+		header.driverHash = m_driverHash;
+		header.programCount = m_programBinaries.size();
+
+		std::size_t fileSize = sizeof(header);
+		for (auto&& [programHash, programBinary] : m_programBinaries)
+			fileSize += sizeof(ProgramCacheEntryHeader) + programBinary.data.size();
+
+		std::vector<UInt8> content(fileSize);
+		std::memcpy(content.data(), &header, sizeof(header));
+
+		std::size_t offset = sizeof(header);
+		for (auto&& [programHash, programBinary] : m_programBinaries)
+		{
+			ProgramCacheEntryHeader entryHeader;
+			entryHeader.programHash = programHash;
+			entryHeader.binaryFormat = programBinary.format;
+			entryHeader.binarySize = SafeCast<UInt32>(programBinary.data.size());
+
+			std::memcpy(&content[offset], &entryHeader, sizeof(entryHeader));
+			offset += sizeof(entryHeader);
+
+			if (!programBinary.data.empty())
+				std::memcpy(&content[offset], programBinary.data.data(), programBinary.data.size());
+
+			offset += programBinary.data.size();
+		}
+
+		if (!File::WriteWhole(m_programCacheFilePath, content.data(), content.size()))
+		{
+			NazaraError("failed to write program cache file {0}", m_programCacheFilePath);
+			return false;
+		}
+
+		return true;
+	}
+
+	/*!
+	* \brief Stores the binary of a linked program in the cache
+	*
+	* \param program Linked program, which should have been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+	* \param programHash Hash of the program sources
+	*/
+	/*!
+	* \brief Marks the end of the commands submitted so far, resources pushed for release until now are freed once they're executed
+	*
+	* \remark Without a submission thread, this must be called with a context of this device active
+	*/
+	void OpenGLDevice::SignalTimeline()
+	{
+		std::unique_lock lock(m_timelineMutex);
+
+		PendingSync& sync = m_pendingSyncs.emplace_back();
+		sync.fence = nullptr;
+		sync.submissionJob = 0;
+		sync.timelineValue = ++m_signaledTimelineValue;
+
+		if (m_submissionThread)
+		{
+			// GL objects are only freed by the driver once the GPU is done with them, resources just have to outlive the jobs using them
+			sync.submissionJob = m_submissionThread->GetSubmittedJobCount();
+		}
+		else if (const GL::Context* currentContext = GL::Context::GetCurrentContext(); currentContext && currentContext->glFenceSync)
+			sync.fence = currentContext->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+
+	void OpenGLDevice::StoreProgramBinary(const GL::Program& program, UInt64 programHash)
+	{
+		if (!IsProgramCacheEnabled())
+			return;
+
+		ProgramBinary programBinary;
+		if (!program.GetBinary(&programBinary.format, &programBinary.data))
+			return;
+
+		m_programBinaries.insert_or_assign(programHash, std::move(programBinary));
+		m_isProgramCacheUpdated = true;
+	}
+
 	void OpenGLDevice::WaitForIdle()
 	{
+		if (m_submissionThread)
+			m_submissionThread->WaitForIdle();
+
 		const GL::Context* activeContext = GL::Context::GetCurrentContext();
 		if (!activeContext || activeContext->GetDevice() != this)
 		{
@@ -331,5 +641,65 @@ namespace Nz
 		}
 
 		m_referenceContext->glFinish();
+
+		{
+			std::unique_lock lock(m_timelineMutex);
+			for (PendingSync& sync : m_pendingSyncs)
+			{
+				if (sync.fence)
+					m_referenceContext->glDeleteSync(sync.fence);
+			}
+			m_pendingSyncs.clear();
+
+			m_completedTimelineValue = m_signaledTimelineValue;
+		}
+
+		ReleaseAllResources();
+	}
+
+	auto OpenGLDevice::GetSubmittedTimelineValues() const -> QueueTimelineValues
+	{
+		std::unique_lock lock(m_timelineMutex);
+
+		// OpenGL has a single implicit queue
+		QueueTimelineValues timelineValues;
+		timelineValues.fill(m_signaledTimelineValue);
+
+		return timelineValues;
+	}
+
+	auto OpenGLDevice::QueryCompletedTimelineValues() -> QueueTimelineValues
+	{
+		std::unique_lock lock(m_timelineMutex);
+
+		const GL::Context* currentContext = GL::Context::GetCurrentContext();
+		if (currentContext && currentContext->GetDevice() != this)
+			currentContext = nullptr;
+
+		while (!m_pendingSyncs.empty())
+		{
+			PendingSync& sync = m_pendingSyncs.front();
+			if (sync.fence)
+			{
+				// Sync objects are shared between the contexts of this device, but can only be queried with one of them active
+				if (!currentContext)
+					break;
+
+				if (currentContext->glClientWaitSync(sync.fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+					break;
+
+				currentContext->glDeleteSync(sync.fence);
+			}
+			else if (sync.submissionJob > 0 && m_submissionThread->GetCompletedJobCount() < sync.submissionJob)
+				break;
+
+			m_completedTimelineValue = sync.timelineValue;
+			m_pendingSyncs.pop_front();
+		}
+
+		QueueTimelineValues timelineValues;
+		timelineValues.fill(m_completedTimelineValue);
+
+		return timelineValues;
 	}
 }
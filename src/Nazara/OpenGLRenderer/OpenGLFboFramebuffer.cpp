@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/OpenGLRenderer/OpenGLFboFramebuffer.hpp>
+#include <Nazara/OpenGLRenderer/OpenGLDevice.hpp>
 #include <Nazara/OpenGLRenderer/OpenGLRenderPass.hpp>
 #include <Nazara/OpenGLRenderer/OpenGLTexture.hpp>
 #include <NazaraUtils/StackArray.hpp>
@@ -42,6 +43,28 @@ namespace Nz
 		CreateFramebuffer(*currentContext);
 	}
 
+	OpenGLFboFramebuffer::~OpenGLFboFramebuffer()
+	{
+		if (OpenGLSubmissionThread* submissionThread = m_device.GetSubmissionThread())
+		{
+			// Framebuffer objects aren't shared between contexts, those of the contexts used by the submission thread have to be destroyed there
+			for (auto it = m_framebuffers.begin(); it != m_framebuffers.end();)
+			{
+				const GL::Context* context = it->first;
+				if (context == &m_device.GetReferenceContext())
+				{
+					++it;
+					continue;
+				}
+
+				auto framebuffer = std::make_shared<GL::Framebuffer>(std::move(it->second.framebuffer));
+				submissionThread->Submit(context, [framebuffer] { framebuffer->Destroy(); });
+
+				it = m_framebuffers.erase(it);
+			}
+		}
+	}
+
 	void OpenGLFboFramebuffer::Activate() const
 	{
 		const GL::Context* currentContext = GL::Context::GetCurrentContext();
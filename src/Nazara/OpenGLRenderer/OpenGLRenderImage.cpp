@@ -5,7 +5,9 @@
 #include <Nazara/OpenGLRenderer/OpenGLRenderImage.hpp>
 #include <Nazara/OpenGLRenderer/OpenGLCommandBuffer.hpp>
 #include <Nazara/OpenGLRenderer/OpenGLCommandBufferBuilder.hpp>
+#include <Nazara/OpenGLRenderer/OpenGLDevice.hpp>
 #include <Nazara/OpenGLRenderer/OpenGLSwapchain.hpp>
+#include <memory>
 #include <stdexcept>
 #include <Nazara/OpenGLRenderer/Debug.hpp>
 
@@ -13,16 +15,33 @@ namespace Nz
 {
 	OpenGLRenderImage::OpenGLRenderImage(OpenGLSwapchain& owner) :
 	m_owner(owner),
-	m_uploadPool(2 * 1024 * 1024)
+	m_uploadPool(2 * 1024 * 1024),
+	m_pendingSubmission(0)
 	{
 	}
 
 	void OpenGLRenderImage::Execute(const FunctionRef<void(CommandBufferBuilder& builder)>& callback, QueueTypeFlags /*queueTypeFlags*/)
 	{
+		OpenGLDevice& device = m_owner.GetDevice();
+		if (OpenGLSubmissionThread* submissionThread = device.GetSubmissionThread())
+		{
+			// The command buffer is replayed later on the submission thread, which takes ownership of it
+			auto commandBuffer = std::make_shared<OpenGLCommandBuffer>();
+			OpenGLCommandBufferBuilder builder(*commandBuffer);
+			callback(builder);
+
+			device.RegisterCommandBufferSubmission(builder.GetStatistics());
+
+			m_pendingSubmission = submissionThread->Submit(&m_owner.GetContext(), [commandBuffer] { commandBuffer->Execute(); });
+			return;
+		}
+
 		OpenGLCommandBuffer commandBuffer; //< TODO: Use a pool and remove default constructor
 		OpenGLCommandBufferBuilder builder(commandBuffer);
 		callback(builder);
 
+		device.RegisterCommandBufferSubmission(builder.GetStatistics());
+
 		commandBuffer.Execute();
 	}
 
@@ -33,14 +52,57 @@ namespace Nz
 
 	void OpenGLRenderImage::Present()
 	{
+		OpenGLDevice& device = m_owner.GetDevice();
+		device.RegisterFramePresentation(m_uploadPool);
+
 		m_owner.Present();
+		device.SignalTimeline();
+
+		if (OpenGLSubmissionThread* submissionThread = device.GetSubmissionThread())
+		{
+			// Upload memory and released resources may still be used by the submission thread, they're freed when this image is acquired again
+			m_pendingSubmission = submissionThread->GetSubmittedJobCount();
+			return;
+		}
+
 		m_uploadPool.Reset();
 		FlushReleaseQueue();
 	}
 
 	void OpenGLRenderImage::SubmitCommandBuffer(CommandBuffer* commandBuffer, QueueTypeFlags /*queueTypeFlags*/)
 	{
+		OpenGLDevice& device = m_owner.GetDevice();
+		device.RegisterCommandBufferSubmission(commandBuffer->GetStatistics());
+
 		OpenGLCommandBuffer* oglCommandBuffer = static_cast<OpenGLCommandBuffer*>(commandBuffer);
+		if (OpenGLSubmissionThread* submissionThread = device.GetSubmissionThread())
+		{
+			m_pendingSubmission = submissionThread->Submit(&m_owner.GetContext(), [oglCommandBuffer] { oglCommandBuffer->Execute(); });
+			return;
+		}
+
 		oglCommandBuffer->Execute();
 	}
+
+	void OpenGLRenderImage::SynchronizeQueues(QueueType /*waitingQueue*/, QueueType /*signalingQueue*/)
+	{
+		/* nothing to do */
+	}
+
+	/*!
+	* \brief Waits for the submission thread to execute the work submitted with this image, then frees its transient resources
+	*
+	* This does nothing if the device doesn't use a submission thread.
+	*/
+	void OpenGLRenderImage::WaitForSubmissions()
+	{
+		if (m_pendingSubmission == 0)
+			return;
+
+		m_owner.GetDevice().GetSubmissionThread()->WaitForCompletion(m_pendingSubmission);
+		m_pendingSubmission = 0;
+
+		m_uploadPool.Reset();
+		FlushReleaseQueue();
+	}
 }
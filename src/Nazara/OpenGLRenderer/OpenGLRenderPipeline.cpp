@@ -35,11 +35,12 @@ namespace Nz
 
 		nzsl::ShaderStageTypeFlags stageFlags;
 		std::vector<OpenGLShaderModule::ExplicitBinding> explicitBindings;
+		std::vector<OpenGLShaderModule::Source> sources;
 
 		for (const auto& shaderModulePtr : m_pipelineInfo.shaderModules)
 		{
 			OpenGLShaderModule& shaderModule = static_cast<OpenGLShaderModule&>(*shaderModulePtr);
-			stageFlags |= shaderModule.Attach(m_program, pipelineLayout.GetBindingMapping(), &explicitBindings);
+			stageFlags |= shaderModule.GenerateSources(pipelineLayout.GetBindingMapping(), sources, &explicitBindings);
 		}
 
 		// OpenGL ES programs must have both vertex and fragment shaders or a compute shader or a mesh and fragment shader.
@@ -54,7 +55,7 @@ namespace Nz
 					dummyModule.rootNode->statements.push_back(nzsl::ShaderBuilder::DeclareFunction(stage, "main", {}, {}));
 
 					OpenGLShaderModule shaderModule(device, stage, dummyModule);
-					stageFlags |= shaderModule.Attach(m_program, pipelineLayout.GetBindingMapping(), &explicitBindings);
+					stageFlags |= shaderModule.GenerateSources(pipelineLayout.GetBindingMapping(), sources, &explicitBindings);
 				}
 			};
 
@@ -62,11 +63,7 @@ namespace Nz
 			GenerateIfMissing(nzsl::ShaderStageType::Vertex);
 		}
 
-		m_program.Link();
-
-		std::string errLog;
-		if (!m_program.GetLinkStatus(&errLog))
-			throw std::runtime_error("failed to link program: " + errLog);
+		OpenGLShaderModule::LinkProgram(device, m_program, sources);
 
 		m_flipYUniformLocation = m_program.GetUniformLocation(nzsl::GlslWriter::GetFlipYUniformName().data());
 		if (m_flipYUniformLocation != -1)
@@ -15,7 +15,8 @@ namespace Nz
 {
 	OpenGLRenderPipelineLayout::OpenGLRenderPipelineLayout(RenderPipelineLayoutInfo layoutInfo) :
 	m_maxDescriptorCount(0),
-	m_layoutInfo(std::move(layoutInfo))
+	m_layoutInfo(std::move(layoutInfo)),
+	m_pushConstantSize(0)
 	{
 		// Build binding mapping (vulkan-like set | binding => GL binding) and register max descriptor count
 		unsigned int bindingIndex = 0;
@@ -30,6 +31,14 @@ namespace Nz
 
 			m_maxDescriptorCount = std::max<std::size_t>(m_maxDescriptorCount, binding.bindingIndex + binding.arraySize);
 		}
+
+		// OpenGL has no push constants, they're emulated using a uniform block bound after every other binding
+		m_pushConstantBinding = bindingIndex;
+		for (const auto& pushConstantRange : m_layoutInfo.pushConstantRanges)
+			m_pushConstantSize = std::max(m_pushConstantSize, pushConstantRange.offset + pushConstantRange.size);
+
+		if (m_pushConstantSize > MaxPushConstantsSize)
+			throw std::runtime_error("push constant ranges exceed max push constant size (" + std::to_string(MaxPushConstantsSize) + ")");
 	}
 
 	OpenGLRenderPipelineLayout::~OpenGLRenderPipelineLayout()
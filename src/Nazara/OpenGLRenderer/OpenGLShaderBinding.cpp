@@ -94,7 +94,7 @@ namespace Nz
 				else if constexpr (std::is_same_v<T, SampledTextureBindings>)
 				{
 					for (UInt32 i = 0; i < arg.arraySize; ++i)
-						HandleTextureBinding(binding.bindingIndex + i, arg.textureBindings[i]);
+						HandleTextureBinding(binding.bindingIndex + arg.firstArrayElement + i, arg.textureBindings[i]);
 				}
 				else if constexpr (std::is_same_v<T, StorageBufferBinding>)
 				{
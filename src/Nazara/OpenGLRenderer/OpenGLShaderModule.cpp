@@ -3,11 +3,14 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/OpenGLRenderer/OpenGLShaderModule.hpp>
+#include <Nazara/Core/ByteArray.hpp>
 #include <Nazara/Core/MemoryView.hpp>
+#include <Nazara/Core/Hash/XXH64.hpp>
 #include <Nazara/OpenGLRenderer/Utils.hpp>
 #include <NZSL/Lexer.hpp>
 #include <NZSL/Parser.hpp>
 #include <NZSL/Ast/AstSerializer.hpp>
+#include <cstring>
 #include <stdexcept>
 #include <Nazara/OpenGLRenderer/Debug.hpp>
 
@@ -79,7 +82,17 @@ namespace Nz
 		}
 	}
 
-	nzsl::ShaderStageTypeFlags OpenGLShaderModule::Attach(GL::Program& program, const nzsl::GlslWriter::BindingMapping& bindingMapping, std::vector<ExplicitBinding>* explicitBindings) const
+	/*!
+	* \brief Generates the GLSL source code of every stage of the module for the current device
+	* \return Stages of the module
+	*
+	* \param bindingMapping Binding mapping of the pipeline layout
+	* \param sources Vector receiving the source code of each stage
+	* \param explicitBindings Optional vector receiving bindings which have to be set after linking the program
+	*
+	* \see LinkProgram
+	*/
+	nzsl::ShaderStageTypeFlags OpenGLShaderModule::GenerateSources(const nzsl::GlslWriter::BindingMapping& bindingMapping, std::vector<Source>& sources, std::vector<ExplicitBinding>* explicitBindings) const
 	{
 		const auto& context = m_device.GetReferenceContext();
 		const auto& contextParams = context.GetParams();
@@ -104,23 +117,19 @@ namespace Nz
 		nzsl::ShaderStageTypeFlags stageFlags;
 		for (const auto& shaderEntry : m_shaders)
 		{
-			GL::Shader shader;
-
-			if (!shader.Create(m_device, ToOpenGL(shaderEntry.stage)))
-				throw std::runtime_error("failed to create shader"); //< TODO: Handle error message
-
-			if (!m_debugName.empty())
-				shader.SetDebugName(m_debugName);
+			Source& source = sources.emplace_back();
+			source.stage = shaderEntry.stage;
+			source.debugName = m_debugName;
 
 			std::visit([&](auto&& arg)
 			{
 				using T = std::decay_t<decltype(arg)>;
 				if constexpr (std::is_same_v<T, GlslShader>)
-					shader.SetSource(arg.sourceCode.data(), GLint(arg.sourceCode.size()));
+					source.code = arg.sourceCode;
 				else if constexpr (std::is_same_v<T, ShaderStatement>)
 				{
 					nzsl::GlslWriter::Output output = writer.Generate(shaderEntry.stage, *arg.ast, bindingMapping, m_states);
-					shader.SetSource(output.code.data(), GLint(output.code.size()));
+					source.code = std::move(output.code);
 
 					if (explicitBindings)
 					{
@@ -147,13 +156,6 @@ namespace Nz
 
 			}, shaderEntry.shader);
 
-			shader.Compile();
-
-			CheckCompilationStatus(shader);
-
-			program.AttachShader(shader.GetObjectId());
-			// Shader object can be safely released now (it won't be deleted by the driver until program gets deleted)
-
 			stageFlags |= shaderEntry.stage;
 		}
 
@@ -188,6 +190,68 @@ namespace Nz
 		}
 	}
 
+	/*!
+	* \brief Links a program from shader sources, using the device program cache when possible
+	*
+	* The program binary is loaded from the device program cache if it contains one for the same sources,
+	* otherwise (or if the driver rejects the binary) sources are compiled and linked, and the resulting binary is stored in the cache.
+	*
+	* \param device Device owning the program
+	* \param program Program to link, no shader must be attached to it
+	* \param sources Source code of every stage of the program
+	*
+	* \remark Throws a std::runtime_error if a shader fails to compile or if the program fails to link
+	*/
+	void OpenGLShaderModule::LinkProgram(OpenGLDevice& device, GL::Program& program, const std::vector<Source>& sources)
+	{
+		XXH64Hasher hasher;
+		hasher.Begin();
+		for (const Source& source : sources)
+		{
+			UInt8 stage = static_cast<UInt8>(source.stage);
+			hasher.Append(&stage, sizeof(stage));
+			hasher.Append(reinterpret_cast<const UInt8*>(source.code.data()), source.code.size());
+		}
+
+		ByteArray digest = hasher.End();
+
+		UInt64 programHash;
+		std::memcpy(&programHash, digest.GetConstBuffer(), sizeof(programHash));
+
+		if (device.LoadProgramBinary(program, programHash))
+			return;
+
+		for (const Source& source : sources)
+		{
+			GL::Shader shader;
+
+			if (!shader.Create(device, ToOpenGL(source.stage)))
+				throw std::runtime_error("failed to create shader"); //< TODO: Handle error message
+
+			if (!source.debugName.empty())
+				shader.SetDebugName(source.debugName);
+
+			shader.SetSource(source.code.data(), GLint(source.code.size()));
+			shader.Compile();
+
+			CheckCompilationStatus(shader);
+
+			program.AttachShader(shader.GetObjectId());
+			// Shader object can be safely released now (it won't be deleted by the driver until program gets deleted)
+		}
+
+		if (device.IsProgramCacheEnabled())
+			program.SetParameter(GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+		program.Link();
+
+		std::string errLog;
+		if (!program.GetLinkStatus(&errLog))
+			throw std::runtime_error("failed to link program: " + errLog);
+
+		device.StoreProgramBinary(program, programHash);
+	}
+
 	void OpenGLShaderModule::CheckCompilationStatus(GL::Shader& shader)
 	{
 		std::string errorLog;
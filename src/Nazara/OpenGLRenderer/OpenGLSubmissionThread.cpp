@@ -0,0 +1,172 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - OpenGL renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/OpenGLRenderer/OpenGLSubmissionThread.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/ThreadExt.hpp>
+#include <Nazara/OpenGLRenderer/Wrapper/Context.hpp>
+#include <Nazara/OpenGLRenderer/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup OpenGLRenderer
+	* \class Nz::OpenGLSubmissionThread
+	* \brief OpenGL class executing GL work (command buffer replay, buffer swapping) on a dedicated thread
+	*
+	* Jobs are pushed to a lock-free queue and executed in submission order with their context activated on the submission thread,
+	* which allows GL driver work to overlap with the thread submitting them.
+	*
+	* Resources are still created and updated by the submitting thread through the device reference context (which shares its objects
+	* with other contexts), a fence is inserted on submission so that jobs only start when these commands are visible.
+	*
+	* \remark Contexts used by jobs must not be activated on other threads
+	* \remark Jobs should be submitted by a single thread, as completion indices are only ordered for a given submitting thread
+	*/
+
+	OpenGLSubmissionThread::OpenGLSubmissionThread() :
+	m_submittedJobCount(0),
+	m_completedJobCount(0),
+	m_isStopping(false)
+	{
+		m_thread = std::thread(&OpenGLSubmissionThread::ThreadFunc, this);
+	}
+
+	/*!
+	* \brief Destructs the object, executing pending jobs
+	*/
+	OpenGLSubmissionThread::~OpenGLSubmissionThread()
+	{
+		{
+			std::unique_lock lock(m_mutex);
+			m_isStopping = true;
+		}
+		m_wakeCondition.notify_one();
+
+		m_thread.join();
+	}
+
+	/*!
+	* \brief Deactivates a context on the submission thread (if active) so it can be used or destroyed by another thread
+	*
+	* This waits for the submission thread to execute every job submitted before.
+	*
+	* \param context Context to release
+	*/
+	void OpenGLSubmissionThread::ReleaseContext(const GL::Context& context)
+	{
+		UInt64 jobIndex = Submit(nullptr, [&context]
+		{
+			if (GL::Context::GetCurrentContext() == &context)
+				GL::Context::SetCurrentContext(nullptr);
+		});
+
+		WaitForCompletion(jobIndex);
+	}
+
+	/*!
+	* \brief Submits a job to be executed on the submission thread
+	* \return Index of the job, which can be used to wait for its completion
+	*
+	* \param context Context which will be activated before executing the job, or nullptr for jobs which don't issue GL commands
+	* \param job Job callback
+	*
+	* \see WaitForCompletion
+	*/
+	UInt64 OpenGLSubmissionThread::Submit(const GL::Context* context, Job job)
+	{
+		GLsync fence = nullptr;
+		if (context)
+		{
+			if (const GL::Context* currentContext = GL::Context::GetCurrentContext(); currentContext && currentContext->glFenceSync)
+			{
+				// Commands have to be flushed for the fence to be waited on by another context
+				fence = currentContext->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+				currentContext->glFlush();
+			}
+		}
+
+		m_jobs.Push(PendingJob{ std::move(job), context, fence });
+		UInt64 jobIndex = m_submittedJobCount.fetch_add(1, std::memory_order_release) + 1;
+
+		{
+			std::unique_lock lock(m_mutex);
+		}
+		m_wakeCondition.notify_one();
+
+		return jobIndex;
+	}
+
+	/*!
+	* \brief Waits until a job (and every job submitted before it) has been executed
+	*
+	* \param jobIndex Index of the job, as returned by Submit
+	*
+	* \remark This must not be called from the submission thread
+	*/
+	void OpenGLSubmissionThread::WaitForCompletion(UInt64 jobIndex)
+	{
+		NazaraAssert(!IsSubmissionThread(), "cannot wait for jobs on the submission thread");
+
+		if (GetCompletedJobCount() >= jobIndex)
+			return;
+
+		std::unique_lock lock(m_mutex);
+		m_completionCondition.wait(lock, [&] { return m_completedJobCount.load(std::memory_order_acquire) >= jobIndex; });
+	}
+
+	void OpenGLSubmissionThread::ThreadFunc()
+	{
+		SetCurrentThreadName("NzGLSubmission");
+
+		UInt64 executedJobCount = 0;
+		for (;;)
+		{
+			{
+				std::unique_lock lock(m_mutex);
+				m_wakeCondition.wait(lock, [&] { return m_isStopping || m_submittedJobCount.load(std::memory_order_acquire) > executedJobCount; });
+
+				if (m_isStopping && m_submittedJobCount.load(std::memory_order_acquire) == executedJobCount)
+					break;
+			}
+
+			PendingJob job;
+			while (m_jobs.Pop(job))
+			{
+				if (!job.context || GL::Context::SetCurrentContext(job.context))
+				{
+					if (job.fence)
+					{
+						job.context->glWaitSync(job.fence, 0, GL_TIMEOUT_IGNORED);
+						job.context->glDeleteSync(job.fence);
+					}
+
+					try
+					{
+						job.callback();
+					}
+					catch (const std::exception& e)
+					{
+						NazaraError("submission job failed: {0}", e.what());
+					}
+				}
+				else
+					NazaraError("failed to activate context on submission thread");
+
+				// Release resources held by the job before signaling its completion
+				job.callback = nullptr;
+
+				executedJobCount++;
+				m_completedJobCount.store(executedJobCount, std::memory_order_release);
+
+				{
+					std::unique_lock lock(m_mutex);
+				}
+				m_completionCondition.notify_all();
+			}
+		}
+
+		GL::Context::SetCurrentContext(nullptr);
+	}
+}
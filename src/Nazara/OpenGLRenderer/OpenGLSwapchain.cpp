@@ -12,6 +12,7 @@ namespace Nz
 {
 	OpenGLSwapchain::OpenGLSwapchain(OpenGLDevice& device, WindowHandle windowHandle, const Vector2ui& windowSize, const SwapchainParameters& parameters) :
 	m_currentFrame(0),
+	m_device(device),
 	m_framebuffer(*this),
 	m_size(windowSize),
 	m_sizeInvalidated(false)
@@ -61,6 +62,10 @@ namespace Nz
 		m_presentMode = PresentMode::VerticalSync; //< default present mode
 #endif
 
+		// The context will be activated by the submission thread from now on, it can't stay current on this one
+		if (m_device.GetSubmissionThread() && GL::Context::GetCurrentContext() == m_context.get())
+			GL::Context::SetCurrentContext(nullptr);
+
 		for (PresentMode presentMode : parameters.presentMode)
 		{
 			if (m_supportedPresentModes & presentMode)
@@ -84,8 +89,23 @@ namespace Nz
 			m_renderImage.emplace_back(std::make_unique<OpenGLRenderImage>(*this));
 	}
 
+	OpenGLSwapchain::~OpenGLSwapchain()
+	{
+		if (OpenGLSubmissionThread* submissionThread = m_device.GetSubmissionThread())
+		{
+			for (auto& renderImagePtr : m_renderImage)
+				renderImagePtr->WaitForSubmissions();
+
+			submissionThread->ReleaseContext(*m_context);
+		}
+	}
+
 	RenderFrame OpenGLSwapchain::AcquireFrame()
 	{
+		// With a submission thread, this waits for the previous frame using this image (which lets one frame be executed while the next one is prepared)
+		m_renderImage[m_currentFrame]->WaitForSubmissions();
+		m_device.ReleaseCompletedResources();
+
 		bool sizeInvalidated = m_sizeInvalidated;
 		m_sizeInvalidated = false;
 
@@ -94,7 +114,7 @@ namespace Nz
 
 	std::shared_ptr<CommandPool> OpenGLSwapchain::CreateCommandPool(QueueType /*queueType*/)
 	{
-		return std::make_shared<OpenGLCommandPool>();
+		return std::make_shared<OpenGLCommandPool>(m_device);
 	}
 
 	const OpenGLFramebuffer& OpenGLSwapchain::GetFramebuffer(std::size_t i) const
@@ -139,7 +159,11 @@ namespace Nz
 
 	void OpenGLSwapchain::Present()
 	{
-		m_context->SwapBuffers();
+		if (OpenGLSubmissionThread* submissionThread = m_device.GetSubmissionThread())
+			submissionThread->Submit(m_context.get(), [context = m_context.get()] { context->SwapBuffers(); });
+		else
+			m_context->SwapBuffers();
+
 		m_currentFrame = (m_currentFrame + 1) % m_renderImage.size();
 	}
 
@@ -149,7 +173,11 @@ namespace Nz
 
 		if (m_presentMode != presentMode)
 		{
-			m_context->SetPresentMode(presentMode);
+			if (OpenGLSubmissionThread* submissionThread = m_device.GetSubmissionThread())
+				submissionThread->Submit(m_context.get(), [context = m_context.get(), presentMode] { context->SetPresentMode(presentMode); });
+			else
+				m_context->SetPresentMode(presentMode);
+
 			m_presentMode = presentMode;
 		}
 	}
@@ -4,6 +4,7 @@
 
 #include <Nazara/OpenGLRenderer/OpenGLTexture.hpp>
 #include <Nazara/Utility/PixelFormat.hpp>
+#include <NazaraUtils/Algorithm.hpp>
 #include <NazaraUtils/CallOnExit.hpp>
 #include <stdexcept>
 #include <Nazara/OpenGLRenderer/Debug.hpp>
@@ -159,6 +160,10 @@ namespace Nz
 		context.glPixelStorei(GL_UNPACK_ROW_LENGTH,   srcWidth);
 		context.glPixelStorei(GL_UNPACK_IMAGE_HEIGHT, srcHeight);
 
+		// Block-compressed data is expected to be tightly packed (unpack row length and image height are ignored for them)
+		bool isCompressed = PixelFormatInfo::IsCompressed(m_textureInfo.pixelFormat);
+		GLsizei compressedSize = (isCompressed) ? SafeCast<GLsizei>(PixelFormatInfo::ComputeSize(m_textureInfo.pixelFormat, box.width, box.height, 1)) : 0;
+
 		switch (m_textureInfo.type)
 		{
 			case ImageType::E1D:
@@ -168,7 +173,10 @@ namespace Nz
 				break;
 
 			case ImageType::E2D:
-				m_texture.TexSubImage2D(GL::TextureTarget::Target2D, level, box.x, box.y, box.width, box.height, format->format, format->type, ptr);
+				if (isCompressed)
+					m_texture.CompressedTexSubImage2D(GL::TextureTarget::Target2D, level, box.x, box.y, box.width, box.height, format->internalFormat, compressedSize, ptr);
+				else
+					m_texture.TexSubImage2D(GL::TextureTarget::Target2D, level, box.x, box.y, box.width, box.height, format->format, format->type, ptr);
 				break;
 
 			case ImageType::E2D_Array:
@@ -184,7 +192,11 @@ namespace Nz
 
 				for (GL::TextureTarget face : { GL::TextureTarget::CubemapPositiveX, GL::TextureTarget::CubemapNegativeX, GL::TextureTarget::CubemapPositiveY, GL::TextureTarget::CubemapNegativeY, GL::TextureTarget::CubemapPositiveZ, GL::TextureTarget::CubemapNegativeZ })
 				{
-					m_texture.TexSubImage2D(face, level, box.x, box.y, box.width, box.height, format->format, format->type, facePtr);
+					if (isCompressed)
+						m_texture.CompressedTexSubImage2D(face, level, box.x, box.y, box.width, box.height, format->internalFormat, compressedSize, facePtr);
+					else
+						m_texture.TexSubImage2D(face, level, box.x, box.y, box.width, box.height, format->format, format->type, facePtr);
+
 					facePtr += faceSize;
 				}
 				break;
@@ -134,7 +134,7 @@ namespace Nz::GL
 		force = true;
 #endif
 
-		if (m_state.bufferTargets[target] != buffer || force)
+		if (TrackStateChange(m_state.bufferTargets[target] != buffer || force))
 		{
 			if (!SetCurrentContext(this))
 				throw std::runtime_error("failed to activate context");
@@ -147,10 +147,8 @@ namespace Nz::GL
 
 	GLenum Context::BindFramebuffer(GLuint fbo) const
 	{
-		if (m_state.boundDrawFBO == fbo)
-			return GL_DRAW_FRAMEBUFFER;
-		else if (m_state.boundReadFBO == fbo)
-			return GL_READ_FRAMEBUFFER;
+		if (!TrackStateChange(m_state.boundDrawFBO != fbo && m_state.boundReadFBO != fbo))
+			return (m_state.boundDrawFBO == fbo) ? GL_DRAW_FRAMEBUFFER : GL_READ_FRAMEBUFFER;
 		else
 		{
 			if (!SetCurrentContext(this))
@@ -166,7 +164,7 @@ namespace Nz::GL
 	void Context::BindFramebuffer(FramebufferTarget target, GLuint fbo) const
 	{
 		auto& currentFbo = (target == FramebufferTarget::Draw) ? m_state.boundDrawFBO : m_state.boundReadFBO;
-		if (currentFbo != fbo)
+		if (TrackStateChange(currentFbo != fbo))
 		{
 			if (!SetCurrentContext(this))
 				throw std::runtime_error("failed to activate context");
@@ -184,7 +182,7 @@ namespace Nz::GL
 		layer = (layered == GL_TRUE) ? layer : 0;
 
 		auto& unit = m_state.imageUnits[imageUnit];
-		if (unit.texture != texture || unit.level != level || unit.layered != layered || unit.layer != layer || unit.access != access || unit.format != format)
+		if (TrackStateChange(unit.texture != texture || unit.level != level || unit.layered != layered || unit.layer != layer || unit.access != access || unit.format != format))
 		{
 			if (!SetCurrentContext(this))
 				throw std::runtime_error("failed to activate context");
@@ -204,7 +202,7 @@ namespace Nz::GL
 
 	void Context::BindProgram(GLuint program) const
 	{
-		if (m_state.boundProgram != program)
+		if (TrackStateChange(m_state.boundProgram != program))
 		{
 			if (!SetCurrentContext(this))
 				throw std::runtime_error("failed to activate context");
@@ -220,7 +218,7 @@ namespace Nz::GL
 			throw std::runtime_error("unsupported texture unit #" + std::to_string(textureUnit));
 
 		auto& unit = m_state.textureUnits[textureUnit];
-		if (unit.sampler != sampler)
+		if (TrackStateChange(unit.sampler != sampler))
 		{
 			if (!SetCurrentContext(this))
 				throw std::runtime_error("failed to activate context");
@@ -236,7 +234,7 @@ namespace Nz::GL
 			throw std::runtime_error("unsupported storage buffer unit #" + std::to_string(storageUnit));
 
 		auto& unit = m_state.storageUnits[storageUnit];
-		if (unit.buffer != buffer || unit.offset != offset || unit.size != size)
+		if (TrackStateChange(unit.buffer != buffer || unit.offset != offset || unit.size != size))
 		{
 			if (!SetCurrentContext(this))
 				throw std::runtime_error("failed to activate context");
@@ -263,7 +261,7 @@ namespace Nz::GL
 			throw std::runtime_error("unsupported texture unit #" + std::to_string(textureUnit));
 
 		auto& unit = m_state.textureUnits[textureUnit];
-		if (unit.textureTargets[target] != texture)
+		if (TrackStateChange(unit.textureTargets[target] != texture))
 		{
 			if (!SetCurrentContext(this))
 				throw std::runtime_error("failed to activate context");
@@ -282,7 +280,7 @@ namespace Nz::GL
 			throw std::runtime_error("unsupported uniform buffer unit #" + std::to_string(uboUnit));
 
 		auto& unit = m_state.uboUnits[uboUnit];
-		if (unit.buffer != buffer || unit.offset != offset || unit.size != size)
+		if (TrackStateChange(unit.buffer != buffer || unit.offset != offset || unit.size != size))
 		{
 			if (!SetCurrentContext(this))
 				throw std::runtime_error("failed to activate context");
@@ -300,7 +298,7 @@ namespace Nz::GL
 
 	void Context::BindVertexArray(GLuint vertexArray, bool force) const
 	{
-		if (m_state.boundVertexArray != vertexArray || force)
+		if (TrackStateChange(m_state.boundVertexArray != vertexArray || force))
 		{
 			if (!SetCurrentContext(this))
 				throw std::runtime_error("failed to activate context");
@@ -455,6 +453,14 @@ namespace Nz::GL
 
 		m_extensionStatus.fill(ExtensionStatus::NotSupported);
 
+		// Buffer storage
+		if (m_params.type == ContextType::OpenGL && glVersion >= 440)
+			m_extensionStatus[Extension::BufferStorage] = ExtensionStatus::Core;
+		else if (m_supportedExtensions.count("GL_ARB_buffer_storage"))
+			m_extensionStatus[Extension::BufferStorage] = ExtensionStatus::ARB;
+		else if (m_supportedExtensions.count("GL_EXT_buffer_storage"))
+			m_extensionStatus[Extension::BufferStorage] = ExtensionStatus::EXT;
+
 		// Clip control
 		if (m_params.type == ContextType::OpenGL && glVersion >= 450)
 			m_extensionStatus[Extension::ClipControl] = ExtensionStatus::Core;
@@ -517,6 +523,34 @@ namespace Nz::GL
 		else if (m_supportedExtensions.count("GL_ARB_shader_storage_buffer_object"))
 			m_extensionStatus[Extension::StorageBuffers] = ExtensionStatus::ARB;
 
+		// Texture compression (ASTC LDR)
+		if (m_params.type == ContextType::OpenGL_ES && glVersion >= 320)
+			m_extensionStatus[Extension::TextureCompressionASTC] = ExtensionStatus::Core;
+		else if (m_supportedExtensions.count("GL_KHR_texture_compression_astc_ldr"))
+			m_extensionStatus[Extension::TextureCompressionASTC] = ExtensionStatus::KHR;
+
+		// Texture compression (BPTC, aka BC6H/BC7)
+		if (m_params.type == ContextType::OpenGL && glVersion >= 420)
+			m_extensionStatus[Extension::TextureCompressionBPTC] = ExtensionStatus::Core;
+		else if (m_supportedExtensions.count("GL_ARB_texture_compression_bptc"))
+			m_extensionStatus[Extension::TextureCompressionBPTC] = ExtensionStatus::ARB;
+		else if (m_supportedExtensions.count("GL_EXT_texture_compression_bptc"))
+			m_extensionStatus[Extension::TextureCompressionBPTC] = ExtensionStatus::EXT;
+
+		// Texture compression (ETC2)
+		if ((m_params.type == ContextType::OpenGL && glVersion >= 430) || (m_params.type == ContextType::OpenGL_ES && glVersion >= 300))
+			m_extensionStatus[Extension::TextureCompressionETC2] = ExtensionStatus::Core;
+		else if (m_supportedExtensions.count("GL_ARB_ES3_compatibility"))
+			m_extensionStatus[Extension::TextureCompressionETC2] = ExtensionStatus::ARB;
+
+		// Texture compression (RGTC, aka BC4/BC5)
+		if (m_params.type == ContextType::OpenGL && glVersion >= 300)
+			m_extensionStatus[Extension::TextureCompressionRGTC] = ExtensionStatus::Core;
+		else if (m_supportedExtensions.count("GL_ARB_texture_compression_rgtc"))
+			m_extensionStatus[Extension::TextureCompressionRGTC] = ExtensionStatus::ARB;
+		else if (m_supportedExtensions.count("GL_EXT_texture_compression_rgtc"))
+			m_extensionStatus[Extension::TextureCompressionRGTC] = ExtensionStatus::EXT;
+
 		// Texture compression (S3tc)
 		if (m_supportedExtensions.count("GL_EXT_texture_compression_s3tc"))
 			m_extensionStatus[Extension::TextureCompressionS3tc] = ExtensionStatus::EXT;
@@ -719,9 +753,45 @@ namespace Nz::GL
 		return hasAnyError;
 	}
 
+	void Context::SetClearColor(const Color& color) const
+	{
+		if (TrackStateChange(m_state.clearColor != color))
+		{
+			if (!SetCurrentContext(this))
+				throw std::runtime_error("failed to activate context");
+
+			glClearColor(color.r, color.g, color.b, color.a);
+			m_state.clearColor = color;
+		}
+	}
+
+	void Context::SetClearDepth(float depth) const
+	{
+		if (TrackStateChange(!NumberEquals(m_state.clearDepth, depth)))
+		{
+			if (!SetCurrentContext(this))
+				throw std::runtime_error("failed to activate context");
+
+			glClearDepthf(depth);
+			m_state.clearDepth = depth;
+		}
+	}
+
+	void Context::SetClearStencil(GLint stencil) const
+	{
+		if (TrackStateChange(m_state.clearStencil != stencil))
+		{
+			if (!SetCurrentContext(this))
+				throw std::runtime_error("failed to activate context");
+
+			glClearStencil(stencil);
+			m_state.clearStencil = stencil;
+		}
+	}
+
 	void Context::SetCurrentTextureUnit(UInt32 textureUnit) const
 	{
-		if (m_state.currentTextureUnit != textureUnit)
+		if (TrackStateChange(m_state.currentTextureUnit != textureUnit))
 		{
 			if (!SetCurrentContext(this))
 				throw std::runtime_error("failed to activate context");
@@ -733,10 +803,10 @@ namespace Nz::GL
 
 	void Context::SetScissorBox(GLint x, GLint y, GLsizei width, GLsizei height) const
 	{
-		if (m_state.scissorBox.x != x ||
-		    m_state.scissorBox.y != y ||
-		    m_state.scissorBox.width != width ||
-		    m_state.scissorBox.height != height)
+		if (TrackStateChange(m_state.scissorBox.x != x ||
+		                     m_state.scissorBox.y != y ||
+		                     m_state.scissorBox.width != width ||
+		                     m_state.scissorBox.height != height))
 		{
 			if (!SetCurrentContext(this))
 				throw std::runtime_error("failed to activate context");
@@ -752,10 +822,10 @@ namespace Nz::GL
 
 	void Context::SetViewport(GLint x, GLint y, GLsizei width, GLsizei height) const
 	{
-		if (m_state.viewport.x != x ||
-		    m_state.viewport.y != y ||
-		    m_state.viewport.width != width ||
-		    m_state.viewport.height != height)
+		if (TrackStateChange(m_state.viewport.x != x ||
+		                     m_state.viewport.y != y ||
+		                     m_state.viewport.width != width ||
+		                     m_state.viewport.height != height))
 		{
 			if (!SetCurrentContext(this))
 				throw std::runtime_error("failed to activate context");
@@ -777,8 +847,8 @@ namespace Nz::GL
 		// Depth bias
 		if (renderStates.depthBias)
 		{
-			if (!NumberEquals(m_state.renderStates.depthBiasConstantFactor, renderStates.depthBiasConstantFactor) ||
-			    !NumberEquals(m_state.renderStates.depthBiasSlopeFactor, renderStates.depthBiasSlopeFactor))
+			if (TrackStateChange(!NumberEquals(m_state.renderStates.depthBiasConstantFactor, renderStates.depthBiasConstantFactor) ||
+			                     !NumberEquals(m_state.renderStates.depthBiasSlopeFactor, renderStates.depthBiasSlopeFactor)))
 			{
 				glPolygonOffset(renderStates.depthBiasConstantFactor, renderStates.depthBiasSlopeFactor);
 				m_state.renderStates.depthBiasConstantFactor = renderStates.depthBiasConstantFactor;
@@ -789,13 +859,13 @@ namespace Nz::GL
 		// Depth compare and depth write
 		if (renderStates.depthBuffer)
 		{
-			if (m_state.renderStates.depthCompare != renderStates.depthCompare)
+			if (TrackStateChange(m_state.renderStates.depthCompare != renderStates.depthCompare))
 			{
 				glDepthFunc(ToOpenGL(renderStates.depthCompare));
 				m_state.renderStates.depthCompare = renderStates.depthCompare;
 			}
 
-			if (m_state.renderStates.depthWrite != renderStates.depthWrite)
+			if (TrackStateChange(m_state.renderStates.depthWrite != renderStates.depthWrite))
 			{
 				glDepthMask((renderStates.depthWrite) ? GL_TRUE : GL_FALSE);
 				m_state.renderStates.depthWrite = renderStates.depthWrite;
@@ -803,7 +873,7 @@ namespace Nz::GL
 		}
 
 		// Face culling
-		if (m_state.renderStates.faceCulling != renderStates.faceCulling)
+		if (TrackStateChange(m_state.renderStates.faceCulling != renderStates.faceCulling))
 		{
 			bool wasEnabled = (m_state.renderStates.faceCulling != FaceCulling::None);
 			bool isEnabled = (renderStates.faceCulling != FaceCulling::None);
@@ -826,14 +896,14 @@ namespace Nz::GL
 		if (!isViewportFlipped)
 			targetFrontFace = (targetFrontFace == FrontFace::Clockwise) ? FrontFace::CounterClockwise : FrontFace::Clockwise;
 
-		if (m_state.renderStates.frontFace != targetFrontFace)
+		if (TrackStateChange(m_state.renderStates.frontFace != targetFrontFace))
 		{
 			glFrontFace(ToOpenGL(targetFrontFace));
 			m_state.renderStates.frontFace = targetFrontFace;
 		}
 
 		// Face filling
-		if (m_state.renderStates.faceFilling != renderStates.faceFilling)
+		if (TrackStateChange(m_state.renderStates.faceFilling != renderStates.faceFilling))
 		{
 			assert(glPolygonMode);
 
@@ -849,9 +919,9 @@ namespace Nz::GL
 				auto& currentStencilData = (front) ? m_state.renderStates.stencilFront : m_state.renderStates.stencilBack;
 				auto& newStencilData = (front) ? renderStates.stencilFront : renderStates.stencilBack;
 
-				if (currentStencilData.compare != newStencilData.compare ||
-				    currentStencilData.reference != newStencilData.reference ||
-				    currentStencilData.compareMask != newStencilData.compareMask)
+				if (TrackStateChange(currentStencilData.compare != newStencilData.compare ||
+				                     currentStencilData.reference != newStencilData.reference ||
+				                     currentStencilData.compareMask != newStencilData.compareMask))
 				{
 					glStencilFuncSeparate((front) ? GL_FRONT : GL_BACK, ToOpenGL(newStencilData.compare), newStencilData.reference, newStencilData.compareMask);
 					currentStencilData.compare = newStencilData.compare;
@@ -859,9 +929,9 @@ namespace Nz::GL
 					currentStencilData.reference = newStencilData.reference;
 				}
 
-				if (currentStencilData.depthFail != newStencilData.depthFail ||
-				    currentStencilData.fail != newStencilData.fail ||
-				    currentStencilData.pass != newStencilData.pass)
+				if (TrackStateChange(currentStencilData.depthFail != newStencilData.depthFail ||
+				                     currentStencilData.fail != newStencilData.fail ||
+				                     currentStencilData.pass != newStencilData.pass))
 				{
 					glStencilOpSeparate((front) ? GL_FRONT : GL_BACK, ToOpenGL(newStencilData.fail), ToOpenGL(newStencilData.depthFail), ToOpenGL(newStencilData.pass));
 					currentStencilData.depthFail = newStencilData.depthFail;
@@ -869,7 +939,7 @@ namespace Nz::GL
 					currentStencilData.pass = newStencilData.pass;
 				}
 
-				if (currentStencilData.writeMask != newStencilData.writeMask)
+				if (TrackStateChange(currentStencilData.writeMask != newStencilData.writeMask))
 				{
 					glStencilMaskSeparate((front) ? GL_FRONT : GL_BACK, newStencilData.writeMask);
 					currentStencilData.writeMask = newStencilData.writeMask;
@@ -881,7 +951,7 @@ namespace Nz::GL
 		}
 
 		// Line width
-		if (!NumberEquals(m_state.renderStates.lineWidth, renderStates.lineWidth, 0.001f))
+		if (TrackStateChange(!NumberEquals(m_state.renderStates.lineWidth, renderStates.lineWidth, 0.001f)))
 		{
 			glLineWidth(renderStates.lineWidth);
 			m_state.renderStates.lineWidth = renderStates.lineWidth;
@@ -895,7 +965,7 @@ namespace Nz::GL
 		}*/
 
 		// Blend states
-		if (m_state.renderStates.blending != renderStates.blending)
+		if (TrackStateChange(m_state.renderStates.blending != renderStates.blending))
 		{
 			if (renderStates.blending)
 				glEnable(GL_BLEND);
@@ -910,15 +980,15 @@ namespace Nz::GL
 			auto& currentBlend = m_state.renderStates.blend;
 			const auto& targetBlend = renderStates.blend;
 
-			if (currentBlend.modeColor != targetBlend.modeColor || currentBlend.modeAlpha != targetBlend.modeAlpha)
+			if (TrackStateChange(currentBlend.modeColor != targetBlend.modeColor || currentBlend.modeAlpha != targetBlend.modeAlpha))
 			{
 				glBlendEquationSeparate(ToOpenGL(targetBlend.modeColor), ToOpenGL(targetBlend.modeAlpha));
 				currentBlend.modeAlpha = targetBlend.modeAlpha;
 				currentBlend.modeColor = targetBlend.modeColor;
 			}
 
-			if (currentBlend.dstAlpha != targetBlend.dstAlpha || currentBlend.dstColor != targetBlend.dstColor ||
-				currentBlend.srcAlpha != targetBlend.srcAlpha || currentBlend.srcColor != targetBlend.srcColor)
+			if (TrackStateChange(currentBlend.dstAlpha != targetBlend.dstAlpha || currentBlend.dstColor != targetBlend.dstColor ||
+			                     currentBlend.srcAlpha != targetBlend.srcAlpha || currentBlend.srcColor != targetBlend.srcColor))
 			{
 				glBlendFuncSeparate(ToOpenGL(targetBlend.srcColor), ToOpenGL(targetBlend.dstColor), ToOpenGL(targetBlend.srcAlpha), ToOpenGL(targetBlend.dstAlpha));
 				currentBlend.dstAlpha = targetBlend.dstAlpha;
@@ -929,14 +999,14 @@ namespace Nz::GL
 		}
 
 		// Color write
-		if (m_state.renderStates.colorWriteMask != renderStates.colorWriteMask)
+		if (TrackStateChange(m_state.renderStates.colorWriteMask != renderStates.colorWriteMask))
 		{
 			glColorMask(renderStates.colorWriteMask.Test(ColorComponent::Red), renderStates.colorWriteMask.Test(ColorComponent::Green), renderStates.colorWriteMask.Test(ColorComponent::Blue), renderStates.colorWriteMask.Test(ColorComponent::Alpha));
 			m_state.renderStates.colorWriteMask = renderStates.colorWriteMask;
 		}
 
 		// Depth bias
-		if (m_state.renderStates.depthBias != renderStates.depthBias)
+		if (TrackStateChange(m_state.renderStates.depthBias != renderStates.depthBias))
 		{
 			// TODO: Handle line and points
 			if (renderStates.depthBias)
@@ -948,7 +1018,7 @@ namespace Nz::GL
 		}
 
 		// Depth buffer
-		if (m_state.renderStates.depthBuffer != renderStates.depthBuffer)
+		if (TrackStateChange(m_state.renderStates.depthBuffer != renderStates.depthBuffer))
 		{
 			if (renderStates.depthBuffer)
 				glEnable(GL_DEPTH_TEST);
@@ -959,7 +1029,7 @@ namespace Nz::GL
 		}
 
 		// Depth clamp
-		if (m_state.renderStates.depthClamp != renderStates.depthClamp)
+		if (TrackStateChange(m_state.renderStates.depthClamp != renderStates.depthClamp))
 		{
 			assert(IsExtensionSupported(Extension::DepthClamp));
 
@@ -972,7 +1042,7 @@ namespace Nz::GL
 		}
 
 		// Scissor test
-		if (m_state.renderStates.scissorTest != renderStates.scissorTest)
+		if (TrackStateChange(m_state.renderStates.scissorTest != renderStates.scissorTest))
 		{
 			if (renderStates.scissorTest)
 				glEnable(GL_SCISSOR_TEST);
@@ -983,7 +1053,7 @@ namespace Nz::GL
 		}
 
 		// Stencil test
-		if (m_state.renderStates.stencilTest != renderStates.stencilTest)
+		if (TrackStateChange(m_state.renderStates.stencilTest != renderStates.stencilTest))
 		{
 			if (renderStates.stencilTest)
 				glEnable(GL_STENCIL_TEST);
@@ -1034,7 +1104,13 @@ namespace Nz::GL
 	{
 		SymbolLoader loader(*this);
 
-		if (function == "glClipControl")
+		if (function == "glBufferStorage")
+		{
+			constexpr std::size_t functionIndex = UnderlyingCast(FunctionIndex::glBufferStorage);
+
+			return loader.Load<PFNGLBUFFERSTORAGEEXTPROC, functionIndex>(glBufferStorage, "glBufferStorageEXT", false); //< from GL_EXT_buffer_storage
+		}
+		else if (function == "glClipControl")
 		{
 			constexpr std::size_t functionIndex = UnderlyingCast(FunctionIndex::glClipControl);
 
@@ -1048,6 +1124,16 @@ namespace Nz::GL
 			return loader.Load<PFNGLDEBUGMESSAGECALLBACKKHRPROC, functionIndex>(glDebugMessageCallback, "glDebugMessageCallbackKHR", false) || //< from GL_KHR_debug
 			       loader.Load<PFNGLDEBUGMESSAGECALLBACKPROC, functionIndex>(glDebugMessageCallback, "glDebugMessageCallbackARB", false);      //< from GL_ARB_debug_output
 		}
+		else if (function == "glMultiDrawElementsIndirect")
+		{
+			constexpr std::size_t functionIndex = UnderlyingCast(FunctionIndex::glMultiDrawElementsIndirect);
+			return loader.Load<PFNGLMULTIDRAWELEMENTSINDIRECTEXTPROC, functionIndex>(glMultiDrawElementsIndirect, "glMultiDrawElementsIndirectEXT", false); //< from GL_EXT_multi_draw_indirect
+		}
+		else if (function == "glMultiDrawElementsIndirectCount")
+		{
+			constexpr std::size_t functionIndex = UnderlyingCast(FunctionIndex::glMultiDrawElementsIndirectCount);
+			return loader.Load<PFNGLMULTIDRAWELEMENTSINDIRECTCOUNTPROC, functionIndex>(glMultiDrawElementsIndirectCount, "glMultiDrawElementsIndirectCountARB", false); //< from GL_ARB_indirect_parameters
+		}
 		else if (function == "glPolygonMode")
 		{
 			constexpr std::size_t functionIndex = UnderlyingCast(FunctionIndex::glPolygonMode);
@@ -4,14 +4,36 @@
 
 #include <Nazara/Platform/Window.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/SpscRingBuffer.hpp>
 #include <Nazara/Platform/Cursor.hpp>
 #include <Nazara/Platform/Icon.hpp>
 #include <Nazara/Platform/SDL2/WindowImpl.hpp>
 #include <NazaraUtils/CallOnExit.hpp>
+#include <atomic>
 #include <Nazara/Platform/Debug.hpp>
 
 namespace Nz
 {
+	struct Window::EventQueue
+	{
+		struct QueuedEvent
+		{
+			WindowEvent event;
+			Time timestamp;
+		};
+
+		EventQueue(std::size_t capacity) :
+		events(capacity),
+		readBuffer(capacity),
+		droppedEventCount(0)
+		{
+		}
+
+		SpscRingBuffer<QueuedEvent> events;
+		std::vector<QueuedEvent> readBuffer;
+		std::atomic_size_t droppedEventCount;
+	};
+
 	Window::Window() :
 	m_closeOnQuit(true),
 	m_waitForEvent(false)
@@ -22,8 +44,10 @@ namespace Nz
 	Window::Window(Window&& window) noexcept :
 	m_cursor(std::move(window.m_cursor)),
 	m_icon(std::move(window.m_icon)),
+	m_eventQueue(std::move(window.m_eventQueue)),
 	m_impl(std::move(window.m_impl)),
 	m_cursorController(std::move(window.m_cursorController)),
+	m_inputSnapshot(window.m_inputSnapshot),
 	m_eventHandler(std::move(window.m_eventHandler)),
 	m_closed(window.m_closed),
 	m_closeOnQuit(window.m_closeOnQuit),
@@ -126,6 +150,30 @@ namespace Nz
 		m_cursor.reset();
 	}
 
+	/*!
+	* \brief Enables or disables the event queue
+	*
+	* When enabled, events are timestamped and pushed into a lock-free queue when pumped (by ProcessEvents) instead of being dispatched right away.
+	* They are dispatched later, along with an input snapshot update, by ProcessQueuedEvents, which can be called from another thread
+	* (allowing the game to run on a separate thread while the main thread keeps pumping events).
+	*
+	* \param enable Should events be queued
+	* \param capacity Maximum count of events kept in the queue, further events are dropped until the queue is processed
+	*
+	* \remark Events still queued when disabling the queue are lost
+	* \remark This must not be called while events are being pumped or processed
+	*/
+	void Window::EnableEventQueue(bool enable, std::size_t capacity)
+	{
+		if (enable)
+		{
+			NazaraAssert(capacity > 0, "event queue capacity must be over zero");
+			m_eventQueue = std::make_unique<EventQueue>(capacity);
+		}
+		else
+			m_eventQueue.reset();
+	}
+
 	WindowStyleFlags Window::GetStyle() const
 	{
 		NazaraAssert(m_impl, "Window not created");
@@ -140,7 +188,17 @@ namespace Nz
 
 	void Window::HandleEvent(const WindowEvent& event)
 	{
-		m_eventHandler.Dispatch(event);
+		if (m_eventQueue)
+		{
+			EventQueue::QueuedEvent queuedEvent;
+			queuedEvent.event = event;
+			queuedEvent.timestamp = GetElapsedNanoseconds();
+
+			if (m_eventQueue->events.Write(&queuedEvent, 1) == 0)
+				m_eventQueue->droppedEventCount.fetch_add(1, std::memory_order_relaxed);
+		}
+		else
+			m_eventHandler.Dispatch(event);
 
 		switch (event.type)
 		{
@@ -208,6 +266,62 @@ namespace Nz
 		return m_impl->IsVisible();
 	}
 
+	/*!
+	* \brief Processes events queued since the last call, on the calling thread
+	*
+	* Consecutive mouse motion events are coalesced into a single one (holding the last position and the sum of the deltas),
+	* then every event updates the input snapshot and is dispatched through the event handler.
+	* Per-frame input state (pressed and released keys and buttons, mouse and wheel deltas) is reset before processing.
+	*
+	* \return Number of dispatched events
+	*
+	* \remark The event queue must be enabled
+	* \remark This can be called from another thread than the one pumping events, but always from the same one
+	*/
+	std::size_t Window::ProcessQueuedEvents()
+	{
+		NazaraAssert(m_eventQueue, "event queue is not enabled");
+
+		if (std::size_t droppedEventCount = m_eventQueue->droppedEventCount.exchange(0, std::memory_order_relaxed); droppedEventCount > 0)
+			NazaraWarning("event queue is full, {0} event(s) were dropped", droppedEventCount);
+
+		m_inputSnapshot.pressedKeys.fill(false);
+		m_inputSnapshot.releasedKeys.fill(false);
+		m_inputSnapshot.pressedButtons.fill(false);
+		m_inputSnapshot.releasedButtons.fill(false);
+		m_inputSnapshot.mouseDelta = Vector2i::Zero();
+		m_inputSnapshot.wheelDelta = 0.f;
+		m_inputSnapshot.eventCount = 0;
+
+		auto& readBuffer = m_eventQueue->readBuffer;
+		std::size_t eventCount = m_eventQueue->events.Read(readBuffer.data(), readBuffer.size());
+		for (std::size_t i = 0; i < eventCount; ++i)
+		{
+			EventQueue::QueuedEvent& queuedEvent = readBuffer[i];
+			WindowEvent& event = queuedEvent.event;
+			if (event.type == WindowEventType::MouseMoved)
+			{
+				while (i + 1 < eventCount && readBuffer[i + 1].event.type == WindowEventType::MouseMoved)
+				{
+					const EventQueue::QueuedEvent& nextEvent = readBuffer[++i];
+					event.mouseMove.deltaX += nextEvent.event.mouseMove.deltaX;
+					event.mouseMove.deltaY += nextEvent.event.mouseMove.deltaY;
+					event.mouseMove.x = nextEvent.event.mouseMove.x;
+					event.mouseMove.y = nextEvent.event.mouseMove.y;
+					queuedEvent.timestamp = nextEvent.timestamp;
+				}
+			}
+
+			m_inputSnapshot.timestamp = queuedEvent.timestamp;
+			m_inputSnapshot.eventCount++;
+			UpdateInputSnapshot(event);
+
+			m_eventHandler.Dispatch(event);
+		}
+
+		return m_inputSnapshot.eventCount;
+	}
+
 	void Window::SetCursor(std::shared_ptr<Cursor> cursor)
 	{
 		NazaraAssert(m_impl, "Window not created");
@@ -387,8 +501,10 @@ namespace Nz
 		m_cursorController = std::move(window.m_cursorController);
 		m_cursor = std::move(window.m_cursor);
 		m_eventHandler = std::move(window.m_eventHandler);
+		m_eventQueue = std::move(window.m_eventQueue);
 		m_icon = std::move(window.m_icon);
 		m_impl = std::move(window.m_impl);
+		m_inputSnapshot = window.m_inputSnapshot;
 		m_closed = window.m_closed;
 		m_closeOnQuit = window.m_closeOnQuit;
 		m_ownsWindow = window.m_ownsWindow;
@@ -446,4 +562,81 @@ namespace Nz
 	{
 		WindowImpl::Uninitialize();
 	}
+
+	void Window::UpdateInputSnapshot(const WindowEvent& event)
+	{
+		switch (event.type)
+		{
+			case WindowEventType::KeyPressed:
+			case WindowEventType::KeyReleased:
+			{
+				if (event.key.scancode == Keyboard::Scancode::Undefined)
+					break;
+
+				std::size_t keyIndex = static_cast<std::size_t>(event.key.scancode);
+				bool pressed = (event.type == WindowEventType::KeyPressed);
+
+				m_inputSnapshot.keyStates[keyIndex] = pressed;
+				if (pressed)
+					m_inputSnapshot.pressedKeys[keyIndex] = true;
+				else
+					m_inputSnapshot.releasedKeys[keyIndex] = true;
+
+				break;
+			}
+
+			case WindowEventType::LostFocus:
+			{
+				// Release events won't be received for keys and buttons released outside of the window
+				for (std::size_t i = 0; i < Keyboard::ScancodeCount; ++i)
+				{
+					if (m_inputSnapshot.keyStates[i])
+						m_inputSnapshot.releasedKeys[i] = true;
+				}
+
+				for (std::size_t i = 0; i < Mouse::ButtonCount; ++i)
+				{
+					if (m_inputSnapshot.buttonStates[i])
+						m_inputSnapshot.releasedButtons[i] = true;
+				}
+
+				m_inputSnapshot.keyStates.fill(false);
+				m_inputSnapshot.buttonStates.fill(false);
+				break;
+			}
+
+			case WindowEventType::MouseButtonPressed:
+			case WindowEventType::MouseButtonReleased:
+			{
+				std::size_t buttonIndex = static_cast<std::size_t>(event.mouseButton.button);
+				bool pressed = (event.type == WindowEventType::MouseButtonPressed);
+
+				m_inputSnapshot.buttonStates[buttonIndex] = pressed;
+				if (pressed)
+					m_inputSnapshot.pressedButtons[buttonIndex] = true;
+				else
+					m_inputSnapshot.releasedButtons[buttonIndex] = true;
+
+				m_inputSnapshot.mousePosition = { event.mouseButton.x, event.mouseButton.y };
+				break;
+			}
+
+			case WindowEventType::MouseMoved:
+			{
+				m_inputSnapshot.mouseDelta += Vector2i(event.mouseMove.deltaX, event.mouseMove.deltaY);
+				m_inputSnapshot.mousePosition = { event.mouseMove.x, event.mouseMove.y };
+				break;
+			}
+
+			case WindowEventType::MouseWheelMoved:
+			{
+				m_inputSnapshot.wheelDelta += event.mouseWheel.delta;
+				m_inputSnapshot.mousePosition = { event.mouseWheel.x, event.mouseWheel.y };
+				break;
+			}
+
+			default:
+				break;
+		}
+	}
 }
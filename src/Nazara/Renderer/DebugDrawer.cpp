@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Renderer/DebugDrawer.hpp>
+#include <Nazara/Math/Angle.hpp>
 #include <Nazara/Renderer/CommandBufferBuilder.hpp>
 #include <Nazara/Renderer/RenderDevice.hpp>
 #include <Nazara/Renderer/RenderFrame.hpp>
@@ -10,9 +11,11 @@
 #include <Nazara/Renderer/RenderPipelineLayout.hpp>
 #include <Nazara/Utility/Joint.hpp>
 #include <Nazara/Utility/Skeleton.hpp>
+#include <NazaraUtils/Algorithm.hpp>
 #include <NZSL/Serializer.hpp>
 #include <NZSL/Ast/AstSerializer.hpp>
 #include <NZSL/Math/FieldOffsets.hpp>
+#include <cmath>
 #include <Nazara/Renderer/Debug.hpp>
 
 namespace Nz
@@ -22,26 +25,44 @@ namespace Nz
 		const UInt8 r_debugDrawShader[] = {
 			#include <Nazara/Renderer/Resources/Shaders/DebugDraw.nzslb.h>
 		};
+
+		constexpr std::size_t InstanceDataSize = 80; //< std140 size of InstanceData (mat4 + vec4)
 	}
 
 	DebugDrawer::DebugDrawer(RenderDevice& renderDevice, std::size_t maxVertexPerDraw) :
 	m_vertexPerBlock(maxVertexPerDraw),
 	m_renderDevice(renderDevice),
+	m_depthTest(true),
+	m_drawDataPrepared(false),
 	m_viewerDataUpdated(false)
 	{
+		static_assert(sizeof(InstanceData) == InstanceDataSize);
+
 		nzsl::Unserializer unserializer(r_debugDrawShader, sizeof(r_debugDrawShader));
 		nzsl::Ast::ModulePtr shaderModule = nzsl::Ast::UnserializeShader(unserializer);
 
-		auto debugDrawShader = m_renderDevice.InstantiateShaderModule(nzsl::ShaderStageType::Fragment | nzsl::ShaderStageType::Vertex, *shaderModule, {});
-		if (!debugDrawShader)
+		auto lineShader = m_renderDevice.InstantiateShaderModule(nzsl::ShaderStageType::Fragment | nzsl::ShaderStageType::Vertex, *shaderModule, {});
+		if (!lineShader)
 			throw std::runtime_error("failed to instantiate debug draw shader");
-		
+
+		nzsl::ShaderWriter::States instancedStates;
+		instancedStates.optionValues[CRC32("Instanced")] = true;
+
+		auto instancedShader = m_renderDevice.InstantiateShaderModule(nzsl::ShaderStageType::Fragment | nzsl::ShaderStageType::Vertex, *shaderModule, instancedStates);
+		if (!instancedShader)
+			throw std::runtime_error("failed to instantiate instanced debug draw shader");
+
 		RenderPipelineLayoutInfo layoutInfo;
 		layoutInfo.bindings.assign({
 			{
 				0, 0, 1,
 				ShaderBindingType::UniformBuffer,
 				nzsl::ShaderStageType::Vertex
+			},
+			{
+				0, 1, 1,
+				ShaderBindingType::UniformBuffer,
+				nzsl::ShaderStageType::Vertex
 			}
 		});
 
@@ -51,8 +72,6 @@ namespace Nz
 
 		RenderPipelineInfo pipelineInfo;
 		pipelineInfo.pipelineLayout = m_renderPipelineLayout;
-		pipelineInfo.shaderModules.push_back(std::move(debugDrawShader));
-		pipelineInfo.depthBuffer = true;
 		pipelineInfo.depthWrite = false;
 
 		pipelineInfo.blending = true;
@@ -60,38 +79,134 @@ namespace Nz
 		pipelineInfo.blend.dstColor = BlendFunc::InvSrcAlpha;
 
 		pipelineInfo.primitiveMode = PrimitiveMode::LineList;
-		pipelineInfo.vertexBuffers.push_back({
-			0,
-			VertexDeclaration::Get(Nz::VertexLayout::XYZ_Color)
-		});
 
-		m_renderPipeline = m_renderDevice.InstantiateRenderPipeline(pipelineInfo);
+		// Index 0: always visible, index 1: depth-tested
+		for (bool depthTest : { false, true })
+		{
+			pipelineInfo.depthBuffer = depthTest;
+
+			pipelineInfo.shaderModules.assign({ lineShader });
+			pipelineInfo.vertexBuffers.assign({
+				{
+					0,
+					VertexDeclaration::Get(VertexLayout::XYZ_Color)
+				}
+			});
+
+			m_linePipelines[depthTest] = m_renderDevice.InstantiateRenderPipeline(pipelineInfo);
 
-		m_dataPool = std::make_shared<DataPool>();
+			pipelineInfo.shaderModules.assign({ instancedShader });
+			pipelineInfo.vertexBuffers.assign({
+				{
+					0,
+					VertexDeclaration::Get(VertexLayout::XYZ)
+				}
+			});
+
+			m_instancePipelines[depthTest] = m_renderDevice.InstantiateRenderPipeline(pipelineInfo);
+		}
+
+		nzsl::FieldOffsets viewerDataFields(nzsl::StructLayout::Std140);
+		viewerDataFields.AddMatrix(nzsl::StructFieldType::Float1, 4, 4, true);
+
+		m_viewerDataBuffer = m_renderDevice.InstantiateBuffer(BufferType::Uniform, viewerDataFields.GetSize(), BufferUsage::DeviceLocal | BufferUsage::Dynamic | BufferUsage::Write);
+		m_lineVertexBuffer = m_renderDevice.InstantiateBuffer(BufferType::Vertex, m_vertexPerBlock * sizeof(VertexStruct_XYZ_Color), BufferUsage::DeviceLocal | BufferUsage::Dynamic | BufferUsage::Write);
+
+		BuildUnitMeshes();
+
+		// Line draws use the first block binding (for the viewer data)
+		m_instanceBlocks.reserve(1);
+		auto& firstBlock = m_instanceBlocks.emplace_back();
+		firstBlock.buffer = m_renderDevice.InstantiateBuffer(BufferType::Uniform, MaxInstancePerDraw * InstanceDataSize, BufferUsage::DeviceLocal | BufferUsage::Dynamic | BufferUsage::Write);
+		firstBlock.binding = m_renderPipelineLayout->AllocateShaderBinding(0);
+		firstBlock.binding->Update({
+			{
+				0,
+				ShaderBinding::UniformBufferBinding {
+					m_viewerDataBuffer.get(),
+					0, m_viewerDataBuffer->GetSize()
+				}
+			},
+			{
+				1,
+				ShaderBinding::UniformBufferBinding {
+					firstBlock.buffer.get(),
+					0, firstBlock.buffer->GetSize()
+				}
+			}
+		});
 	}
 
 	DebugDrawer::~DebugDrawer()
 	{
-		m_drawCalls.clear();
-		m_dataPool.reset();
-		m_currentViewerData = {};
+		// Shader bindings have to be freed before their pipeline layout
+		m_instanceBlocks.clear();
 	}
 
 	void DebugDrawer::Draw(CommandBufferBuilder& builder)
 	{
-		if (m_drawCalls.empty())
+		if (m_lineDrawCalls.empty() && m_instanceDrawCalls.empty())
 			return;
 
-		builder.BindRenderShaderBinding(0, *m_currentViewerData.binding);
-		builder.BindRenderPipeline(*m_renderPipeline);
+		for (const LineDrawCall& drawCall : m_lineDrawCalls)
+		{
+			builder.BindRenderPipeline(*m_linePipelines[drawCall.depthTest]);
+			builder.BindRenderShaderBinding(0, *m_instanceBlocks.front().binding);
+			builder.BindVertexBuffer(0, *m_lineVertexBuffer);
+			builder.Draw(SafeCast<UInt32>(drawCall.vertexCount), 1, SafeCast<UInt32>(drawCall.firstVertex));
+		}
 
-		for (auto& drawCall : m_drawCalls)
+		if (!m_instanceDrawCalls.empty())
 		{
-			builder.BindVertexBuffer(0, *drawCall.vertexBuffer);
-			builder.Draw(SafeCast<UInt32>(drawCall.vertexCount));
+			builder.BindVertexBuffer(0, *m_unitMeshBuffer);
+
+			for (const InstanceDrawCall& drawCall : m_instanceDrawCalls)
+			{
+				const UnitMesh& unitMesh = m_unitMeshes[UnderlyingCast(drawCall.primitive)];
+
+				builder.BindRenderPipeline(*m_instancePipelines[drawCall.depthTest]);
+				builder.BindRenderShaderBinding(0, *m_instanceBlocks[drawCall.blockIndex].binding);
+				builder.Draw(SafeCast<UInt32>(unitMesh.vertexCount), SafeCast<UInt32>(drawCall.instanceCount), SafeCast<UInt32>(unitMesh.firstVertex));
+			}
 		}
 	}
 
+	void DebugDrawer::DrawBox(const Boxf& box, const Color& color)
+	{
+		AddInstance(Primitive::Box, Matrix4f::Transform(box.GetCenter(), Quaternionf::Identity(), box.GetLengths()), color);
+	}
+
+	/*!
+	* \brief Draws an oriented box
+	*
+	* \param transformMatrix Transformation applied to a unit box centered on the origin
+	* \param color Color of the box
+	*/
+	void DebugDrawer::DrawBox(const Matrix4f& transformMatrix, const Color& color)
+	{
+		AddInstance(Primitive::Box, transformMatrix, color);
+	}
+
+	/*!
+	* \brief Draws the frustum of a view-projection matrix
+	*
+	* The frustum is computed on the GPU from the unit box, by applying the inverse of the view-projection matrix.
+	*
+	* \param viewProjMatrix View-projection matrix of the frustum to draw
+	* \param color Color of the frustum
+	*/
+	void DebugDrawer::DrawFrustum(const Matrix4f& viewProjMatrix, const Color& color)
+	{
+		Matrix4f invViewProj;
+		if (!viewProjMatrix.GetInverse(&invViewProj))
+			return;
+
+		// Unit box ([-0.5, 0.5]) to clip space ([-1, 1] on X and Y, [0, 1] on Z) to world space
+		Matrix4f unitBoxToClip = Matrix4f::Transform(Vector3f(0.f, 0.f, 0.5f), Quaternionf::Identity(), Vector3f(2.f, 2.f, 1.f));
+
+		AddInstance(Primitive::Box, unitBoxToClip * invViewProj, color);
+	}
+
 	void DebugDrawer::DrawSkeleton(const Skeleton& skeleton, const Color& color)
 	{
 		std::size_t jointCount = skeleton.GetJointCount();
@@ -104,120 +219,166 @@ namespace Nz
 		}
 	}
 
-	void DebugDrawer::Prepare(RenderFrame& renderFrame)
+	void DebugDrawer::DrawSphere(const Vector3f& center, float radius, const Color& color)
 	{
-		UploadPool& uploadPool = renderFrame.GetUploadPool();
+		AddInstance(Primitive::Sphere, Matrix4f::Transform(center, Quaternionf::Identity(), Vector3f(radius)), color);
+	}
 
-		if (!m_lineVertices.empty())
+	void DebugDrawer::Prepare(RenderFrame& renderFrame)
+	{
+		// Prepare can be called once per viewer, draw data only has to be uploaded once per frame
+		bool uploadDrawData = !m_drawDataPrepared;
+		if (uploadDrawData)
 		{
-			std::size_t vertexCount = m_lineVertices.size();
-			m_drawCalls.clear();
-			m_drawCalls.reserve(vertexCount / m_vertexPerBlock + 1);
+			m_lineDrawCalls.clear();
+			m_instanceDrawCalls.clear();
 
-			m_pendingUploads.clear();
-			m_pendingUploads.reserve(vertexCount / m_vertexPerBlock + 1);
-
-			// Handle vertex buffers
-			const VertexStruct_XYZ_Color* lineVertices = m_lineVertices.data();
-			while (vertexCount > 0)
+			// Lines
+			std::size_t lineVertexCount = 0;
+			for (bool depthTest : { false, true })
 			{
-				auto& drawCall = m_drawCalls.emplace_back();
+				std::size_t vertexCount = m_drawLists[depthTest].lineVertices.size();
+				if (vertexCount == 0)
+					continue;
 
-				// Try to reuse vertex buffers from pool if any
-				if (!m_dataPool->vertexBuffers.empty())
-				{
-					drawCall.vertexBuffer = std::move(m_dataPool->vertexBuffers.back());
-					m_dataPool->vertexBuffers.pop_back();
-				}
-				else
-					drawCall.vertexBuffer = m_renderDevice.InstantiateBuffer(BufferType::Vertex, m_vertexPerBlock * sizeof(VertexStruct_XYZ_Color), BufferUsage::DeviceLocal | BufferUsage::Dynamic | BufferUsage::Write);
+				auto& drawCall = m_lineDrawCalls.emplace_back();
+				drawCall.depthTest = depthTest;
+				drawCall.firstVertex = lineVertexCount;
+				drawCall.vertexCount = vertexCount;
 
-				drawCall.vertexCount = std::min(vertexCount, m_vertexPerBlock);
+				lineVertexCount += vertexCount;
+			}
 
-				auto& pendingUpload = m_pendingUploads.emplace_back();
-				pendingUpload.allocation = &uploadPool.Allocate(drawCall.vertexCount * sizeof(VertexStruct_XYZ_Color));
-				pendingUpload.vertexBuffer = drawCall.vertexBuffer.get();
-				std::memcpy(pendingUpload.allocation->mappedPtr, lineVertices, drawCall.vertexCount * sizeof(VertexStruct_XYZ_Color));
+			std::size_t lineVertexSize = lineVertexCount * sizeof(VertexStruct_XYZ_Color);
+			if (lineVertexSize > m_lineVertexBuffer->GetSize())
+			{
+				UInt64 newSize = std::max<UInt64>(lineVertexSize, m_lineVertexBuffer->GetSize() * 2);
 
-				lineVertices += drawCall.vertexCount;
-				vertexCount -= drawCall.vertexCount;
+				renderFrame.PushForRelease(std::move(m_lineVertexBuffer));
+				m_lineVertexBuffer = m_renderDevice.InstantiateBuffer(BufferType::Vertex, newSize, BufferUsage::DeviceLocal | BufferUsage::Dynamic | BufferUsage::Write);
 			}
-			m_lineVertices.clear();
-		}
 
-		// Handle viewer data
-		if (m_viewerDataUpdated)
-		{
-			if (!m_dataPool->viewerData.empty())
+			// Instances, each draw call uses its own block
+			for (bool depthTest : { false, true })
 			{
-				m_currentViewerData = std::move(m_dataPool->viewerData.back());
-				m_dataPool->viewerData.pop_back();
+				for (std::size_t primitiveIndex = 0; primitiveIndex < PrimitiveCount; ++primitiveIndex)
+				{
+					std::size_t instanceCount = m_drawLists[depthTest].instances[primitiveIndex].size();
+					for (std::size_t firstInstance = 0; firstInstance < instanceCount; firstInstance += MaxInstancePerDraw)
+					{
+						auto& drawCall = m_instanceDrawCalls.emplace_back();
+						drawCall.blockIndex = m_instanceDrawCalls.size() - 1;
+						drawCall.depthTest = depthTest;
+						drawCall.instanceCount = std::min(instanceCount - firstInstance, MaxInstancePerDraw);
+						drawCall.primitive = static_cast<Primitive>(primitiveIndex);
+					}
+				}
 			}
-			else
+
+			while (m_instanceBlocks.size() < m_instanceDrawCalls.size())
 			{
-				m_currentViewerData.buffer = m_renderDevice.InstantiateBuffer(BufferType::Uniform, m_viewerData.size(), BufferUsage::DeviceLocal | BufferUsage::Dynamic | BufferUsage::Write);
-				m_currentViewerData.binding = m_renderPipelineLayout->AllocateShaderBinding(0);
-				m_currentViewerData.binding->Update({
+				auto& block = m_instanceBlocks.emplace_back();
+				block.buffer = m_renderDevice.InstantiateBuffer(BufferType::Uniform, MaxInstancePerDraw * InstanceDataSize, BufferUsage::DeviceLocal | BufferUsage::Dynamic | BufferUsage::Write);
+				block.binding = m_renderPipelineLayout->AllocateShaderBinding(0);
+				block.binding->Update({
 					{
 						0,
-						Nz::ShaderBinding::UniformBufferBinding {
-							m_currentViewerData.buffer.get(),
-							0, m_currentViewerData.buffer->GetSize()
+						ShaderBinding::UniformBufferBinding {
+							m_viewerDataBuffer.get(),
+							0, m_viewerDataBuffer->GetSize()
+						}
+					},
+					{
+						1,
+						ShaderBinding::UniformBufferBinding {
+							block.buffer.get(),
+							0, block.buffer->GetSize()
 						}
 					}
 				});
 			}
+
+			m_drawDataPrepared = true;
 		}
 
-		if (m_viewerDataUpdated || !m_pendingUploads.empty())
+		bool hasDrawData = !m_lineDrawCalls.empty() || !m_instanceDrawCalls.empty();
+		if (!m_viewerDataUpdated && !(uploadDrawData && hasDrawData))
+			return;
+
+		UploadPool& uploadPool = renderFrame.GetUploadPool();
+
+		renderFrame.Execute([&](CommandBufferBuilder& builder)
 		{
-			renderFrame.Execute([&](CommandBufferBuilder& builder)
+			builder.BeginDebugRegion("Debug drawer upload", Color::Yellow());
 			{
-				builder.BeginDebugRegion("Debug drawer upload", Color::Yellow());
+				// Buffers are updated in place, wait for the previous frame to be done with them
+				builder.PreTransferBarrier();
+
+				if (m_viewerDataUpdated)
+				{
+					auto& viewerDataAllocation = uploadPool.Allocate(m_viewerData.size());
+					std::memcpy(viewerDataAllocation.mappedPtr, m_viewerData.data(), m_viewerData.size());
+
+					builder.CopyBuffer(viewerDataAllocation, m_viewerDataBuffer.get());
+				}
+
+				if (uploadDrawData)
 				{
-					if (m_viewerDataUpdated)
+					if (!m_lineDrawCalls.empty())
 					{
-						const UploadPool::Allocation& viewerDataAllocation = uploadPool.Allocate(m_viewerData.size());
-						std::memcpy(viewerDataAllocation.mappedPtr, m_viewerData.data(), m_viewerData.size());
+						const LineDrawCall& lastDrawCall = m_lineDrawCalls.back();
+						std::size_t lineVertexSize = (lastDrawCall.firstVertex + lastDrawCall.vertexCount) * sizeof(VertexStruct_XYZ_Color);
+
+						auto& vertexAllocation = uploadPool.Allocate(lineVertexSize);
+						UInt8* vertexPtr = static_cast<UInt8*>(vertexAllocation.mappedPtr);
+						for (const LineDrawCall& drawCall : m_lineDrawCalls)
+						{
+							std::size_t size = drawCall.vertexCount * sizeof(VertexStruct_XYZ_Color);
+							std::memcpy(vertexPtr, m_drawLists[drawCall.depthTest].lineVertices.data(), size);
+							vertexPtr += size;
+						}
 
-						builder.CopyBuffer(viewerDataAllocation, m_currentViewerData.buffer.get());
+						builder.CopyBuffer(vertexAllocation, RenderBufferView(m_lineVertexBuffer.get(), 0, lineVertexSize));
 					}
 
-					for (auto& pendingUpload : m_pendingUploads)
-						builder.CopyBuffer(*pendingUpload.allocation, pendingUpload.vertexBuffer);
-					m_pendingUploads.clear();
+					std::array<std::array<std::size_t, PrimitiveCount>, 2> uploadedInstances = {};
+					for (const InstanceDrawCall& drawCall : m_instanceDrawCalls)
+					{
+						std::size_t& firstInstance = uploadedInstances[drawCall.depthTest][UnderlyingCast(drawCall.primitive)];
+						const auto& instances = m_drawLists[drawCall.depthTest].instances[UnderlyingCast(drawCall.primitive)];
+
+						std::size_t size = drawCall.instanceCount * InstanceDataSize;
+
+						auto& instanceAllocation = uploadPool.Allocate(size);
+						std::memcpy(instanceAllocation.mappedPtr, &instances[firstInstance], size);
 
-					builder.PostTransferBarrier();
+						builder.CopyBuffer(instanceAllocation, RenderBufferView(m_instanceBlocks[drawCall.blockIndex].buffer.get(), 0, size));
+
+						firstInstance += drawCall.instanceCount;
+					}
 				}
-				builder.EndDebugRegion();
-			}, QueueType::Graphics);
-		}
+
+				builder.PostTransferBarrier();
+			}
+			builder.EndDebugRegion();
+		}, QueueType::Graphics);
 
 		m_viewerDataUpdated = false;
 	}
 
-	void DebugDrawer::Reset(RenderFrame& renderFrame)
+	void DebugDrawer::Reset(RenderFrame& /*renderFrame*/)
 	{
-		if (m_currentViewerData.binding)
+		for (DrawList& drawList : m_drawLists)
 		{
-			// keep pipeline layout alive as needs to stay alive until all shader bindings have been freed
-			renderFrame.PushReleaseCallback([pool = m_dataPool, data = std::move(m_currentViewerData), pipelineLayout = m_renderPipelineLayout]() mutable
-			{
-				pool->viewerData.push_back(std::move(data));
-			});
-		}
-		m_currentViewerData.binding = {};
+			for (auto& instances : drawList.instances)
+				instances.clear();
 
-		for (auto& drawCall : m_drawCalls)
-		{
-			renderFrame.PushReleaseCallback([pool = m_dataPool, buffer = std::move(drawCall.vertexBuffer)]() mutable
-			{
-				pool->vertexBuffers.push_back(std::move(buffer));
-			});
+			drawList.lineVertices.clear();
 		}
-		m_drawCalls.clear();
 
-		m_lineVertices.clear();
+		m_instanceDrawCalls.clear();
+		m_lineDrawCalls.clear();
+		m_drawDataPrepared = false;
 	}
 
 	void DebugDrawer::SetViewerData(const Matrix4f& viewProjMatrix)
@@ -231,4 +392,70 @@ namespace Nz
 
 		m_viewerDataUpdated = true;
 	}
+
+	void DebugDrawer::AddInstance(Primitive primitive, const Matrix4f& transformMatrix, const Color& color)
+	{
+		auto& instanceData = m_drawLists[m_depthTest].instances[UnderlyingCast(primitive)].emplace_back();
+		instanceData.transformMatrix = transformMatrix;
+		instanceData.color = color;
+	}
+
+	void DebugDrawer::BuildUnitMeshes()
+	{
+		std::vector<VertexStruct_XYZ> vertices;
+		vertices.reserve(24 + 3 * SphereSegmentCount * 2);
+
+		auto AddLine = [&](const Vector3f& start, const Vector3f& end)
+		{
+			vertices.push_back({ start });
+			vertices.push_back({ end });
+		};
+
+		// Box ([-0.5, 0.5] on all axis)
+		{
+			UnitMesh& box = m_unitMeshes[UnderlyingCast(Primitive::Box)];
+			box.firstVertex = vertices.size();
+
+			Vector3f min(-0.5f);
+			Vector3f max(0.5f);
+
+			AddLine({ min.x, min.y, min.z }, { max.x, min.y, min.z });
+			AddLine({ min.x, min.y, min.z }, { min.x, max.y, min.z });
+			AddLine({ min.x, min.y, min.z }, { min.x, min.y, max.z });
+			AddLine({ max.x, max.y, max.z }, { min.x, max.y, max.z });
+			AddLine({ max.x, max.y, max.z }, { max.x, min.y, max.z });
+			AddLine({ max.x, max.y, max.z }, { max.x, max.y, min.z });
+			AddLine({ min.x, min.y, max.z }, { max.x, min.y, max.z });
+			AddLine({ min.x, min.y, max.z }, { min.x, max.y, max.z });
+			AddLine({ min.x, max.y, min.z }, { max.x, max.y, min.z });
+			AddLine({ min.x, max.y, min.z }, { min.x, max.y, max.z });
+			AddLine({ max.x, min.y, min.z }, { max.x, max.y, min.z });
+			AddLine({ max.x, min.y, min.z }, { max.x, min.y, max.z });
+
+			box.vertexCount = vertices.size() - box.firstVertex;
+		}
+
+		// Sphere (one circle of radius 1 around each axis)
+		{
+			UnitMesh& sphere = m_unitMeshes[UnderlyingCast(Primitive::Sphere)];
+			sphere.firstVertex = vertices.size();
+
+			constexpr float angleStep = 2.f * Pi<float> / SphereSegmentCount;
+			for (std::size_t i = 0; i < SphereSegmentCount; ++i)
+			{
+				float startCos = std::cos(i * angleStep);
+				float startSin = std::sin(i * angleStep);
+				float endCos = std::cos((i + 1) * angleStep);
+				float endSin = std::sin((i + 1) * angleStep);
+
+				AddLine({ startCos, startSin, 0.f }, { endCos, endSin, 0.f });
+				AddLine({ startCos, 0.f, startSin }, { endCos, 0.f, endSin });
+				AddLine({ 0.f, startCos, startSin }, { 0.f, endCos, endSin });
+			}
+
+			sphere.vertexCount = vertices.size() - sphere.firstVertex;
+		}
+
+		m_unitMeshBuffer = m_renderDevice.InstantiateBuffer(BufferType::Vertex, vertices.size() * sizeof(VertexStruct_XYZ), BufferUsage::DeviceLocal, vertices.data());
+	}
 }
@@ -17,4 +17,6 @@ namespace Nz
 			return device->InstantiateBuffer(type, size, usage, initialData);
 		};
 	}
+
+	std::atomic<UInt64> RenderBuffer::s_nextResourceId = 1;
 }
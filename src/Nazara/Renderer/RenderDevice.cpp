@@ -5,11 +5,68 @@
 #include <Nazara/Renderer/RenderDevice.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/File.hpp>
+#include <Nazara/Renderer/UploadPool.hpp>
 #include <Nazara/Renderer/Debug.hpp>
 
 namespace Nz
 {
-	RenderDevice::~RenderDevice() = default;
+	NAZARA_ANONYMOUS_NAMESPACE
+	{
+		class CompletedUpload final : public AsyncUpload
+		{
+			public:
+				bool IsFinished() const override
+				{
+					return true;
+				}
+
+				void Wait() override
+				{
+				}
+		};
+	}
+
+	RenderDevice::~RenderDevice()
+	{
+		// Backends should release resources before destroying their device objects, this only handles resources pushed afterwards
+		ReleaseAllResources();
+	}
+
+	/*!
+	* \brief Runs an incremental defragmentation step over the memory of streamed textures (see TextureUsage::Streamed)
+	*
+	* Relocated textures keep their content but use a new image, which means bindings (shader bindings, framebuffers) referencing them must be recreated.
+	* The copies are recorded in the frame and the previous memory is released with it, a new step can't begin until then.
+	* The default implementation does nothing.
+	*
+	* \param renderFrame Frame used to copy relocated textures, copies are executed before any command buffer recorded afterwards in this frame
+	* \param maxBytes Maximum number of bytes moved during this step
+	* \param relocationCallback Callback called for each relocated texture
+	*/
+	void RenderDevice::DefragmentStreamedTextures(RenderFrame& /*renderFrame*/, UInt64 /*maxBytes*/, const FunctionRef<void(Texture& texture)>& /*relocationCallback*/)
+	{
+	}
+
+	/*!
+	* \brief Returns the statistics of the last presented frame
+	* \return Statistics of the command buffers submitted and of the uploads made between the two last presentations
+	*
+	* \remark Command buffers are accounted each time they are submitted, even if they were recorded once
+	*/
+	RenderFrameStatistics RenderDevice::GetFrameStatistics() const
+	{
+		std::unique_lock lock(m_frameStatisticsMutex);
+		return m_lastFrameStatistics;
+	}
+
+	/*!
+	* \brief Returns the memory usage of the device for each of its memory heaps
+	* \return Statistics for each memory heap, empty if the backend cannot query them (default implementation)
+	*/
+	std::vector<RenderMemoryHeapStatistics> RenderDevice::GetMemoryHeapStatistics() const
+	{
+		return {};
+	}
 
 	std::shared_ptr<ShaderModule> RenderDevice::InstantiateShaderModule(nzsl::ShaderStageTypeFlags shaderStages, ShaderLanguage lang, const std::filesystem::path& sourcePath, const nzsl::ShaderWriter::States& states)
 	{
@@ -32,6 +89,146 @@ namespace Nz
 		return InstantiateShaderModule(shaderStages, lang, source.data(), source.size(), states);
 	}
 
+	/*!
+	* \brief Checks if command buffers from different command pools can be recorded concurrently from multiple threads
+	* \return True if concurrent recording is supported (false by default)
+	*/
+	bool RenderDevice::IsParallelCommandRecordingSupported() const
+	{
+		return false;
+	}
+
+	/*!
+	* \brief Accounts the commands of a submitted command buffer in the current frame statistics
+	*
+	* \param statistics Statistics of the submitted command buffer
+	*
+	* \remark This is called by the renderer backends
+	*/
+	void RenderDevice::RegisterCommandBufferSubmission(const CommandBufferStatistics& statistics)
+	{
+		std::unique_lock lock(m_frameStatisticsMutex);
+
+		CommandBufferStatistics& frameCommands = m_currentFrameStatistics.commands;
+		frameCommands.computeDispatchCount += statistics.computeDispatchCount;
+		frameCommands.drawCallCount += statistics.drawCallCount;
+		frameCommands.drawnVertexCount += statistics.drawnVertexCount;
+		frameCommands.pipelineBindCount += statistics.pipelineBindCount;
+		frameCommands.renderPassCount += statistics.renderPassCount;
+		frameCommands.shaderBindingBindCount += statistics.shaderBindingBindCount;
+		frameCommands.transferredBytes += statistics.transferredBytes;
+
+		m_currentFrameStatistics.submittedCommandBufferCount++;
+	}
+
+	/*!
+	* \brief Ends the current frame statistics, which become the ones returned by GetFrameStatistics
+	*
+	* \param uploadPool Upload pool of the presented frame, which must not have been reset since the frame began
+	*
+	* \remark This is called by the renderer backends
+	*/
+	void RenderDevice::RegisterFramePresentation(const UploadPool& uploadPool)
+	{
+		const UploadPool::Stats& uploadStats = uploadPool.GetStats();
+
+		std::unique_lock lock(m_frameStatisticsMutex);
+		m_currentFrameStatistics.uploadAllocationCount += uploadStats.allocationCount;
+		m_currentFrameStatistics.uploadedBytes += uploadStats.allocatedBytes;
+
+		m_lastFrameStatistics = m_currentFrameStatistics;
+		m_currentFrameStatistics = RenderFrameStatistics{};
+	}
+
+	/*!
+	* \brief Calls release callbacks (see PushReleaseCallback) of resources the GPU is done with
+	*
+	* Backends call this regularly (when acquiring a frame or uploading data), applications without a swapchain should call it themselves.
+	*
+	* \remark This function is thread-safe, callbacks are called from the calling thread
+	*/
+	void RenderDevice::ReleaseCompletedResources()
+	{
+		std::vector<std::unique_ptr<TransientResources::Releasable>> completedReleases;
+		{
+			std::unique_lock lock(m_releaseQueueMutex);
+			if (m_releaseQueue.empty())
+				return;
+
+			QueueTimelineValues completedValues = QueryCompletedTimelineValues();
+
+			// Timeline values only increase, so releases are completed in the order they were pushed
+			while (!m_releaseQueue.empty())
+			{
+				const PendingRelease& pendingRelease = m_releaseQueue.front();
+
+				bool isCompleted = true;
+				for (auto&& [queueType, timelineValue] : pendingRelease.timelineValues.iter_kv())
+				{
+					if (timelineValue > completedValues[queueType])
+					{
+						isCompleted = false;
+						break;
+					}
+				}
+
+				if (!isCompleted)
+					break;
+
+				completedReleases.push_back(std::move(m_releaseQueue.front().releasable));
+				m_releaseQueue.pop_front();
+			}
+		}
+
+		// Callbacks may push other releases, don't hold the lock while calling them
+		for (auto& releasable : completedReleases)
+			releasable->Release();
+	}
+
+	/*!
+	* \brief Uploads data to a buffer without waiting for the transfer to complete
+	* \return Handle to wait for the transfer completion, or nullptr on failure
+	*
+	* \param buffer Buffer to upload data to, must be kept alive until the upload has finished
+	* \param data Data to upload, it is copied before this function returns
+	* \param offset Offset in the buffer to write the data to
+	* \param size Size of the data
+	*
+	* \remark The default implementation performs a synchronous upload and returns an already finished handle
+	*/
+	std::shared_ptr<AsyncUpload> RenderDevice::UploadAsync(RenderBuffer& buffer, const void* data, UInt64 offset, UInt64 size)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		if (!buffer.Fill(data, offset, size))
+			return nullptr;
+
+		return std::make_shared<CompletedUpload>();
+	}
+
+	/*!
+	* \brief Uploads data to a texture region without waiting for the transfer to complete
+	* \return Handle to wait for the transfer completion, or nullptr on failure
+	*
+	* \param texture Texture to upload data to, must be kept alive until the upload has finished
+	* \param data Pixels to upload, they are copied before this function returns
+	* \param box Texture region to update
+	* \param srcWidth Width of a row of the source data (in pixels), zero to use the box width
+	* \param srcHeight Height of a slice of the source data (in pixels), zero to use the box height
+	* \param level Mipmap level to update
+	*
+	* \remark The default implementation performs a synchronous upload and returns an already finished handle
+	*/
+	std::shared_ptr<AsyncUpload> RenderDevice::UploadAsync(Texture& texture, const void* data, const Boxui& box, unsigned int srcWidth, unsigned int srcHeight, UInt8 level)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		if (!texture.Update(data, box, srcWidth, srcHeight, level))
+			return nullptr;
+
+		return std::make_shared<CompletedUpload>();
+	}
+
 	void RenderDevice::ValidateFeatures(const RenderDeviceFeatures& supportedFeatures, RenderDeviceFeatures& enabledFeatures)
 	{
 #define NzValidateFeature(field, name) \
@@ -42,8 +239,12 @@ namespace Nz
 		}
 
 		NzValidateFeature(anisotropicFiltering, "anistropic filtering feature")
+		NzValidateFeature(bindlessTextures, "bindless textures feature")
 		NzValidateFeature(computeShaders, "compute shaders feature")
 		NzValidateFeature(depthClamping, "depth clamping feature")
+		NzValidateFeature(drawIndirectCount, "indirect draw count feature")
+		NzValidateFeature(multiDrawIndirect, "multi-draw indirect feature")
+		NzValidateFeature(multipleSubpasses, "multiple subpasses feature")
 		NzValidateFeature(nonSolidFaceFilling, "non-solid face filling feature")
 		NzValidateFeature(storageBuffers, "storage buffers support")
 		NzValidateFeature(textureReadWithoutFormat, "texture read without format")
@@ -53,4 +254,56 @@ namespace Nz
 
 #undef NzValidateFeature
 	}
+
+	/*!
+	* \brief Returns the timeline value of the last work submitted to each queue
+	*
+	* Backends supporting deferred releases have to increase these values each time they submit work and report them as completed
+	* once the GPU is done with it (see QueryCompletedTimelineValues).
+	* The default implementation returns zero for every queue, which means releases are done on the next call to ReleaseCompletedResources.
+	*/
+	auto RenderDevice::GetSubmittedTimelineValues() const -> QueueTimelineValues
+	{
+		QueueTimelineValues timelineValues;
+		timelineValues.fill(0);
+
+		return timelineValues;
+	}
+
+	/*!
+	* \brief Queries the timeline value of the last work the GPU executed on each queue
+	*
+	* \remark This is called with the release queue lock held
+	*/
+	auto RenderDevice::QueryCompletedTimelineValues() -> QueueTimelineValues
+	{
+		return GetSubmittedTimelineValues();
+	}
+
+	/*!
+	* \brief Calls every pending release callback, regardless of the GPU progress
+	*
+	* Backends call this once the device is idle (see WaitForIdle) and before destroying their device objects.
+	*/
+	void RenderDevice::ReleaseAllResources()
+	{
+		std::deque<PendingRelease> releaseQueue;
+		{
+			std::unique_lock lock(m_releaseQueueMutex);
+			releaseQueue = std::move(m_releaseQueue);
+			m_releaseQueue.clear();
+		}
+
+		for (PendingRelease& pendingRelease : releaseQueue)
+			pendingRelease.releasable->Release();
+	}
+
+	void RenderDevice::PushReleasable(std::unique_ptr<TransientResources::Releasable> releasable)
+	{
+		std::unique_lock lock(m_releaseQueueMutex);
+
+		auto& pendingRelease = m_releaseQueue.emplace_back();
+		pendingRelease.releasable = std::move(releasable);
+		pendingRelease.timelineValues = GetSubmittedTimelineValues();
+	}
 }
@@ -22,9 +22,12 @@
 
 #ifdef NAZARA_RENDERER_EMBEDDEDBACKENDS
 
+#include <Nazara/NullRenderer/NullRenderer.hpp>
 #include <Nazara/OpenGLRenderer/OpenGLRenderer.hpp>
 
-#ifndef NAZARA_PLATFORM_WEB
+#ifdef NAZARA_PLATFORM_WEB
+#include <Nazara/WebGPURenderer/WebGPURenderer.hpp>
+#else
 #include <Nazara/VulkanRenderer/VulkanRenderer.hpp>
 #endif
 
@@ -115,18 +118,25 @@ namespace Nz
 		};
 
 		RegisterImpl(RenderAPI::OpenGL, [] { return 50; }, [] { return std::make_unique<OpenGLRenderer>(); });
-#ifndef NAZARA_PLATFORM_WEB
+#ifdef NAZARA_PLATFORM_WEB
+		// WebGPU requires the page to provide a device and WGSL shaders (the Graphics module can't use it), only use it when explicitly requested
+		RegisterImpl(RenderAPI::WebGPU, [&] { return (preferredAPI == RenderAPI::WebGPU) ? 0 : -1; }, [] { return std::make_unique<WebGPURenderer>(); });
+#else
 		RegisterImpl(RenderAPI::Vulkan, [] { return 100; }, [] { return std::make_unique<VulkanRenderer>(); });
 #endif
+		// The null renderer doesn't display anything, only use it when explicitly requested
+		RegisterImpl(RenderAPI::Null, [&] { return (preferredAPI == RenderAPI::Null) ? 0 : -1; }, [] { return std::make_unique<NullRenderer>(); });
 
 #else
 		constexpr EnumArray<RenderAPI, const char*> rendererPaths = {
 			NazaraRendererPrefix "NazaraDirect3DRenderer" NazaraRendererDebugSuffix, // Direct3D
 			NazaraRendererPrefix "NazaraMantleRenderer"   NazaraRendererDebugSuffix, // Mantle
 			NazaraRendererPrefix "NazaraMetalRenderer"    NazaraRendererDebugSuffix, // Metal
+			NazaraRendererPrefix "NazaraNullRenderer"     NazaraRendererDebugSuffix, // Null
 			NazaraRendererPrefix "NazaraOpenGLRenderer"   NazaraRendererDebugSuffix, // OpenGL
 			NazaraRendererPrefix "NazaraOpenGLRenderer"   NazaraRendererDebugSuffix, // OpenGL_ES
 			NazaraRendererPrefix "NazaraVulkanRenderer"   NazaraRendererDebugSuffix, // Vulkan
+			NazaraRendererPrefix "NazaraWebGPURenderer"   NazaraRendererDebugSuffix, // WebGPU
 
 			nullptr // Unknown
 		};
@@ -149,9 +159,13 @@ namespace Nz
 		};
 
 		RegisterImpl(RenderAPI::OpenGL, [] { return 50; });
-#ifndef NAZARA_PLATFORM_WEB
+#ifdef NAZARA_PLATFORM_WEB
+		RegisterImpl(RenderAPI::WebGPU, [&] { return (preferredAPI == RenderAPI::WebGPU) ? 0 : -1; });
+#else
 		RegisterImpl(RenderAPI::Vulkan, [] { return 100; });
 #endif
+		// The null renderer doesn't display anything, only use it when explicitly requested
+		RegisterImpl(RenderAPI::Null, [&] { return (preferredAPI == RenderAPI::Null) ? 0 : -1; });
 
 #endif
 
@@ -227,9 +241,11 @@ namespace Nz
 				{ "direct3d", RenderAPI::Direct3D },
 				{ "mantle",   RenderAPI::Mantle },
 				{ "metal",    RenderAPI::Metal },
+				{ "null",     RenderAPI::Null },
 				{ "opengl",   RenderAPI::OpenGL },
 				{ "opengles", RenderAPI::OpenGL_ES },
-				{ "vulkan",   RenderAPI::Vulkan }
+				{ "vulkan",   RenderAPI::Vulkan },
+				{ "webgpu",   RenderAPI::WebGPU }
 			});
 
 			if (auto it = renderAPIStr.find(value); it != renderAPIStr.end())
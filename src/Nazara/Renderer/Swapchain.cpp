@@ -9,6 +9,36 @@ namespace Nz
 {
 	Swapchain::~Swapchain() = default;
 
+	/*!
+	* \brief Returns the frame pacing mode used by the swapchain
+	*
+	* Implementations which don't support frame pacing always report FramePacing::Throughput
+	*/
+	FramePacing Swapchain::GetFramePacing() const
+	{
+		return FramePacing::Throughput;
+	}
+
+	/*!
+	* \brief Returns the time elapsed between the last measured frame WaitForFrame call and its presentation on screen
+	*
+	* This is only available if the implementation is able to know when a frame was presented (e.g. VK_KHR_present_wait) and uses the low-latency frame pacing
+	*/
+	std::optional<Time> Swapchain::GetLastPresentLatency() const
+	{
+		return std::nullopt;
+	}
+
+	/*!
+	* \brief Waits until the next frame can be acquired without blocking
+	*
+	* With the low-latency frame pacing, this should be called right before sampling inputs so they are as recent as possible when the frame is rendered.
+	* AcquireFrame performs this wait by itself if it wasn't done.
+	*/
+	void Swapchain::WaitForFrame()
+	{
+	}
+
 	void Swapchain::BuildRenderPass(PixelFormat colorFormat, PixelFormat depthFormat, std::vector<RenderPass::Attachment>& attachments, std::vector<RenderPass::SubpassDescription>& subpassDescriptions, std::vector<RenderPass::SubpassDependency>& subpassDependencies)
 	{
 		assert(colorFormat != PixelFormat::Undefined);
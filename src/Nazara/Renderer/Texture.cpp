@@ -10,6 +10,11 @@
 
 namespace Nz
 {
+	Texture::Texture() :
+	m_resourceId(s_nextResourceId++)
+	{
+	}
+
 	Texture::~Texture() = default;
 
 	bool TextureParams::IsValid() const
@@ -42,6 +47,25 @@ namespace Nz
 		usageFlags |= params.usageFlags;
 	}
 
+	std::size_t Texture::GetMemoryUsage() const
+	{
+		// Views share the memory of their parent texture
+		if (GetParentTexture())
+			return 0;
+
+		PixelFormat format = GetFormat();
+		bool isCubemap = IsCubemap();
+
+		std::size_t size = 0;
+		for (UInt8 level = 0; level < GetLevelCount(); ++level)
+		{
+			Vector3ui levelSize = GetSize(level);
+			size += PixelFormatInfo::ComputeSize(format, levelSize.x, levelSize.y, (isCubemap) ? 6 : levelSize.z);
+		}
+
+		return size;
+	}
+
 	std::shared_ptr<Texture> Texture::CreateFromImage(const Image& image, const TextureParams& params)
 	{
 		NazaraAssert(params.IsValid(), "Invalid TextureParams");
@@ -175,4 +199,6 @@ namespace Nz
 
 		return CreateFromImage(*image, textureParams);
 	}
+
+	std::atomic<UInt64> Texture::s_nextResourceId = 1;
 }
@@ -8,6 +8,11 @@
 
 namespace Nz
 {
+	TextureSampler::TextureSampler() :
+	m_resourceId(s_nextResourceId++)
+	{
+	}
+
 	TextureSampler::~TextureSampler() = default;
 
 	void TextureSampler::ValidateSamplerInfo(const RenderDevice& device, TextureSamplerInfo& samplerInfo)
@@ -19,4 +24,6 @@ namespace Nz
 			samplerInfo.anisotropyLevel = 0.f;
 		}
 	}
+
+	std::atomic<UInt64> TextureSampler::s_nextResourceId = 1;
 }
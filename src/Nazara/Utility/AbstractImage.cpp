@@ -24,4 +24,29 @@ namespace Nz
 	{
 		return GetType() == ImageType::Cubemap;
 	}
+
+	/*!
+	* \brief Updates multiple regions of the image at once
+	* \return true if every region was updated
+	*
+	* \param pixels Buffer holding the pixels of every region
+	* \param regions Regions to update, each one referencing its tightly packed pixels in the buffer
+	* \param regionCount Number of regions
+	*
+	* \remark The default implementation updates regions one by one, images backed by a GPU should override it to upload everything at once
+	*/
+	bool AbstractImage::UpdateRegions(const void* pixels, const UpdateRegion* regions, std::size_t regionCount)
+	{
+		const UInt8* pixelPtr = static_cast<const UInt8*>(pixels);
+
+		bool success = true;
+		for (std::size_t i = 0; i < regionCount; ++i)
+		{
+			const UpdateRegion& region = regions[i];
+			if (!Update(pixelPtr + region.offset, region.box, 0, 0, region.level))
+				success = false;
+		}
+
+		return success;
+	}
 }
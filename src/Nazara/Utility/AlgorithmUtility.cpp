@@ -25,14 +25,23 @@
  * THE SOFTWARE.
  */
 
+#include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Math/Angle.hpp>
+#include <Nazara/Math/Simd.hpp>
 #include <Nazara/Utility/Algorithm.hpp>
 #include <Nazara/Utility/IndexIterator.hpp>
 #include <Nazara/Utility/Joint.hpp>
 #include <Nazara/Utility/Mesh.hpp>
 #include <Nazara/Utility/SkeletalMesh.hpp>
+#include <Nazara/Utility/VertexDeclaration.hpp>
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
@@ -629,6 +638,136 @@ namespace Nz
 				float m_valenceBoostScale;
 				float m_valenceBoostPower;
 		};
+
+		// Sum of squared distances to a set of planes (Garland & Heckbert), as a symmetric 4x4 matrix
+		struct Quadric
+		{
+			void AddPlane(const Vector3f& normal, float distance, float planeWeight)
+			{
+				double x = normal.x;
+				double y = normal.y;
+				double z = normal.z;
+				double d = distance;
+				double w = planeWeight;
+
+				a00 += w * x * x;
+				a01 += w * x * y;
+				a02 += w * x * z;
+				a11 += w * y * y;
+				a12 += w * y * z;
+				a22 += w * z * z;
+				b0 += w * d * x;
+				b1 += w * d * y;
+				b2 += w * d * z;
+				c += w * d * d;
+				weight += w;
+			}
+
+			// Returns the weighted mean of the squared distances between the position and the planes
+			double Evaluate(const Vector3f& position) const
+			{
+				if (weight <= 0.0)
+					return 0.0;
+
+				double x = position.x;
+				double y = position.y;
+				double z = position.z;
+
+				double error = a00 * x * x + a11 * y * y + a22 * z * z + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) + 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+				return std::max(error, 0.0) / weight;
+			}
+
+			Quadric& operator+=(const Quadric& quadric)
+			{
+				a00 += quadric.a00;
+				a01 += quadric.a01;
+				a02 += quadric.a02;
+				a11 += quadric.a11;
+				a12 += quadric.a12;
+				a22 += quadric.a22;
+				b0 += quadric.b0;
+				b1 += quadric.b1;
+				b2 += quadric.b2;
+				c += quadric.c;
+				weight += quadric.weight;
+
+				return *this;
+			}
+
+			double a00 = 0.0, a01 = 0.0, a02 = 0.0, a11 = 0.0, a12 = 0.0, a22 = 0.0;
+			double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+			double c = 0.0;
+			double weight = 0.0;
+		};
+
+		template<typename T, std::size_t N, typename F>
+		Vector4f DecodeComponentElements(const void* data, F&& decode)
+		{
+			std::array<T, N> elements;
+			std::memcpy(elements.data(), data, sizeof(elements));
+
+			// Missing elements are read as (0, 0, 0, 1), as the GPU does
+			Vector4f value(0.f, 0.f, 0.f, 1.f);
+			for (std::size_t i = 0; i < N; ++i)
+				value[i] = decode(elements[i]);
+
+			return value;
+		}
+
+		template<typename T, std::size_t N, typename F>
+		void EncodeComponentElements(const Vector4f& value, void* data, F&& encode)
+		{
+			std::array<T, N> elements;
+			for (std::size_t i = 0; i < N; ++i)
+				elements[i] = encode(value[i]);
+
+			std::memcpy(data, elements.data(), sizeof(elements));
+		}
+
+		// Normals and tangents stored with two signed elements are octahedral-encoded
+		bool IsOctahedralEncoded(ComponentType type, VertexComponent component)
+		{
+			if (component != VertexComponent::Normal && component != VertexComponent::Tangent)
+				return false;
+
+			switch (type)
+			{
+				case ComponentType::Double2:
+				case ComponentType::Float2:
+				case ComponentType::Half2:
+				case ComponentType::SNorm16x2:
+					return true;
+
+				default:
+					return false;
+			}
+		}
+
+		template<typename T>
+		T EncodeSNorm(float value)
+		{
+			constexpr float maxValue = float(std::numeric_limits<T>::max());
+			return T(std::round(std::clamp(value, -1.f, 1.f) * maxValue));
+		}
+
+		template<typename T>
+		T EncodeUNorm(float value)
+		{
+			constexpr float maxValue = float(std::numeric_limits<T>::max());
+			return T(std::round(std::clamp(value, 0.f, 1.f) * maxValue));
+		}
+
+		template<typename T>
+		float DecodeSNorm(T value)
+		{
+			return std::max(float(value) / float(std::numeric_limits<T>::max()), -1.f);
+		}
+
+		template<typename T>
+		float DecodeUNorm(T value)
+		{
+			return float(value) / float(std::numeric_limits<T>::max());
+		}
 	}
 
 	/**********************************Compute**********************************/
@@ -730,6 +869,263 @@ namespace Nz
 			*vertexCount = sliceCount * stackCount;
 	}
 
+	/**********************************Convert**********************************/
+
+	/*!
+	* \brief Converts vertices from a declaration to another
+	*
+	* Each component of the output declaration takes the value of the same component (and component index) of the input declaration, converted to its type,
+	* output components missing from the input declaration are zeroed. This is mostly useful to compress vertices once a mesh is fully processed.
+	*
+	* \param vertices Pointer to the input vertices
+	* \param declaration Declaration of the input vertices
+	* \param outputVertices Pointer to the output vertices (must not overlap the input vertices)
+	* \param outputDeclaration Declaration of the output vertices
+	* \param vertexCount Vertex count
+	*
+	* \see DecodeVertexComponent
+	* \see EncodeVertexComponent
+	*/
+	void ConvertVertices(const void* vertices, const VertexDeclaration& declaration, void* outputVertices, const VertexDeclaration& outputDeclaration, UInt32 vertexCount)
+	{
+		struct ComponentConversion
+		{
+			const VertexDeclaration::Component* input;
+			const VertexDeclaration::Component* output;
+		};
+
+		std::vector<ComponentConversion> conversions;
+		for (const auto& outputComponent : outputDeclaration.GetComponents())
+		{
+			if (outputComponent.component == VertexComponent::Unused)
+				continue;
+
+			if (const auto* inputComponent = declaration.FindComponent(outputComponent.component, outputComponent.componentIndex))
+				conversions.push_back({ inputComponent, &outputComponent });
+		}
+
+		const UInt8* inputPtr = static_cast<const UInt8*>(vertices);
+		UInt8* outputPtr = static_cast<UInt8*>(outputVertices);
+
+		std::size_t inputStride = declaration.GetStride();
+		std::size_t outputStride = outputDeclaration.GetStride();
+
+		std::memset(outputPtr, 0, outputStride * vertexCount);
+		for (UInt32 i = 0; i < vertexCount; ++i)
+		{
+			for (const ComponentConversion& conversion : conversions)
+			{
+				const void* inputData = inputPtr + conversion.input->offset;
+				void* outputData = outputPtr + conversion.output->offset;
+
+				if (conversion.input->type == conversion.output->type)
+					std::memcpy(outputData, inputData, VertexDeclaration::GetComponentTypeSize(conversion.input->type));
+				else
+				{
+					Vector4f value = DecodeVertexComponent(inputData, conversion.input->type, conversion.input->component);
+					EncodeVertexComponent(value, conversion.output->type, conversion.output->component, outputData);
+				}
+			}
+
+			inputPtr += inputStride;
+			outputPtr += outputStride;
+		}
+	}
+
+	/*!
+	* \brief Reads a vertex component value, whatever its type is
+	* \return Component value, missing elements being read as (0, 0, 0, 1)
+	*
+	* Normalized types are returned in [-1, 1] (snorm) or [0, 1] (unorm), normals and tangents stored with two signed elements are decoded from their octahedral encoding.
+	*
+	* \param data Pointer to the component data
+	* \param type Component type
+	* \param component Kind of component
+	*
+	* \remark Integer and double values are converted to floats and may lose precision
+	*/
+	Vector4f DecodeVertexComponent(const void* data, ComponentType type, VertexComponent component)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		auto Identity = [](auto value) { return float(value); };
+
+		Vector4f value(0.f, 0.f, 0.f, 1.f);
+		switch (type)
+		{
+			case ComponentType::Color:
+			case ComponentType::Float4:    value = DecodeComponentElements<float, 4>(data, Identity);  break;
+			case ComponentType::Double1:   value = DecodeComponentElements<double, 1>(data, Identity); break;
+			case ComponentType::Double2:   value = DecodeComponentElements<double, 2>(data, Identity); break;
+			case ComponentType::Double3:   value = DecodeComponentElements<double, 3>(data, Identity); break;
+			case ComponentType::Double4:   value = DecodeComponentElements<double, 4>(data, Identity); break;
+			case ComponentType::Float1:    value = DecodeComponentElements<float, 1>(data, Identity);  break;
+			case ComponentType::Float2:    value = DecodeComponentElements<float, 2>(data, Identity);  break;
+			case ComponentType::Float3:    value = DecodeComponentElements<float, 3>(data, Identity);  break;
+			case ComponentType::Int1:      value = DecodeComponentElements<Int32, 1>(data, Identity);  break;
+			case ComponentType::Int2:      value = DecodeComponentElements<Int32, 2>(data, Identity);  break;
+			case ComponentType::Int3:      value = DecodeComponentElements<Int32, 3>(data, Identity);  break;
+			case ComponentType::Int4:      value = DecodeComponentElements<Int32, 4>(data, Identity);  break;
+			case ComponentType::Half2:     value = DecodeComponentElements<UInt16, 2>(data, HalfToFloat); break;
+			case ComponentType::Half4:     value = DecodeComponentElements<UInt16, 4>(data, HalfToFloat); break;
+			case ComponentType::SNorm8x4:  value = DecodeComponentElements<Int8, 4>(data, DecodeSNorm<Int8>);    break;
+			case ComponentType::SNorm16x2: value = DecodeComponentElements<Int16, 2>(data, DecodeSNorm<Int16>);  break;
+			case ComponentType::SNorm16x4: value = DecodeComponentElements<Int16, 4>(data, DecodeSNorm<Int16>);  break;
+			case ComponentType::UNorm8x4:  value = DecodeComponentElements<UInt8, 4>(data, DecodeUNorm<UInt8>);  break;
+			case ComponentType::UNorm16x2: value = DecodeComponentElements<UInt16, 2>(data, DecodeUNorm<UInt16>); break;
+			case ComponentType::UNorm16x4: value = DecodeComponentElements<UInt16, 4>(data, DecodeUNorm<UInt16>); break;
+		}
+
+		if (IsOctahedralEncoded(type, component))
+			value = Vector4f(DecodeOctahedral(Vector2f(value.x, value.y)), 1.f);
+
+		return value;
+	}
+
+	/*!
+	* \brief Writes a vertex component value, whatever its type is
+	*
+	* Values are clamped to the range of normalized types, normals and tangents stored with two signed elements are octahedral-encoded.
+	*
+	* \param value Component value, only the elements fitting the component type are used
+	* \param type Component type
+	* \param component Kind of component
+	* \param data Pointer to the component data
+	*/
+	void EncodeVertexComponent(const Vector4f& value, ComponentType type, VertexComponent component, void* data)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		Vector4f encodedValue = value;
+		if (IsOctahedralEncoded(type, component))
+		{
+			Vector2f octahedral = EncodeOctahedral(Vector3f(value));
+			encodedValue = Vector4f(octahedral.x, octahedral.y, 0.f, 1.f);
+		}
+
+		auto Identity = [](float element) { return element; };
+		auto ToDouble = [](float element) { return double(element); };
+		auto ToInt = [](float element) { return Int32(std::round(element)); };
+
+		switch (type)
+		{
+			case ComponentType::Color:
+			case ComponentType::Float4:    EncodeComponentElements<float, 4>(encodedValue, data, Identity);  break;
+			case ComponentType::Double1:   EncodeComponentElements<double, 1>(encodedValue, data, ToDouble); break;
+			case ComponentType::Double2:   EncodeComponentElements<double, 2>(encodedValue, data, ToDouble); break;
+			case ComponentType::Double3:   EncodeComponentElements<double, 3>(encodedValue, data, ToDouble); break;
+			case ComponentType::Double4:   EncodeComponentElements<double, 4>(encodedValue, data, ToDouble); break;
+			case ComponentType::Float1:    EncodeComponentElements<float, 1>(encodedValue, data, Identity);  break;
+			case ComponentType::Float2:    EncodeComponentElements<float, 2>(encodedValue, data, Identity);  break;
+			case ComponentType::Float3:    EncodeComponentElements<float, 3>(encodedValue, data, Identity);  break;
+			case ComponentType::Int1:      EncodeComponentElements<Int32, 1>(encodedValue, data, ToInt);     break;
+			case ComponentType::Int2:      EncodeComponentElements<Int32, 2>(encodedValue, data, ToInt);     break;
+			case ComponentType::Int3:      EncodeComponentElements<Int32, 3>(encodedValue, data, ToInt);     break;
+			case ComponentType::Int4:      EncodeComponentElements<Int32, 4>(encodedValue, data, ToInt);     break;
+			case ComponentType::Half2:     EncodeComponentElements<UInt16, 2>(encodedValue, data, FloatToHalf); break;
+			case ComponentType::Half4:     EncodeComponentElements<UInt16, 4>(encodedValue, data, FloatToHalf); break;
+			case ComponentType::SNorm8x4:  EncodeComponentElements<Int8, 4>(encodedValue, data, EncodeSNorm<Int8>);    break;
+			case ComponentType::SNorm16x2: EncodeComponentElements<Int16, 2>(encodedValue, data, EncodeSNorm<Int16>);  break;
+			case ComponentType::SNorm16x4: EncodeComponentElements<Int16, 4>(encodedValue, data, EncodeSNorm<Int16>);  break;
+			case ComponentType::UNorm8x4:  EncodeComponentElements<UInt8, 4>(encodedValue, data, EncodeUNorm<UInt8>);  break;
+			case ComponentType::UNorm16x2: EncodeComponentElements<UInt16, 2>(encodedValue, data, EncodeUNorm<UInt16>); break;
+			case ComponentType::UNorm16x4: EncodeComponentElements<UInt16, 4>(encodedValue, data, EncodeUNorm<UInt16>); break;
+		}
+	}
+
+	/*!
+	* \brief Converts a float to a half-float (IEEE 754 binary16), rounding to the nearest value
+	* \return Half-float bits
+	*
+	* \param value Float value, values too large for a half-float are converted to infinity
+	*/
+	UInt16 FloatToHalf(float value)
+	{
+		UInt32 bits;
+		std::memcpy(&bits, &value, sizeof(float));
+
+		UInt32 sign = (bits >> 16) & 0x8000;
+		UInt32 exponent = (bits >> 23) & 0xFF;
+		UInt32 mantissa = bits & 0x7FFFFF;
+
+		// Infinity and NaN
+		if (exponent == 0xFF)
+			return UInt16(sign | 0x7C00 | ((mantissa != 0) ? 0x200 : 0));
+
+		Int32 halfExponent = Int32(exponent) - 127 + 15;
+		if (halfExponent >= 0x1F)
+			return UInt16(sign | 0x7C00);
+
+		if (halfExponent <= 0)
+		{
+			// Too small even for a subnormal half-float
+			if (halfExponent < -10)
+				return UInt16(sign);
+
+			// Subnormal half-float, the implicit bit becomes explicit
+			mantissa |= 0x800000;
+
+			UInt32 shift = UInt32(14 - halfExponent);
+			UInt32 halfMantissa = mantissa >> shift;
+			UInt32 remainder = mantissa & ((1u << shift) - 1);
+			UInt32 halfway = 1u << (shift - 1);
+			if (remainder > halfway || (remainder == halfway && (halfMantissa & 1) != 0))
+				halfMantissa++;
+
+			return UInt16(sign | halfMantissa);
+		}
+
+		UInt32 half = sign | (UInt32(halfExponent) << 10) | (mantissa >> 13);
+
+		// Round to nearest even, a carry correctly propagates to the exponent (up to infinity)
+		UInt32 remainder = mantissa & 0x1FFF;
+		if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1) != 0))
+			half++;
+
+		return UInt16(half);
+	}
+
+	/*!
+	* \brief Converts a half-float (IEEE 754 binary16) to a float
+	* \return Float value, the conversion is exact
+	*
+	* \param value Half-float bits
+	*/
+	float HalfToFloat(UInt16 value)
+	{
+		UInt32 sign = UInt32(value & 0x8000) << 16;
+		UInt32 exponent = (value >> 10) & 0x1F;
+		UInt32 mantissa = value & 0x3FF;
+
+		UInt32 bits;
+		if (exponent == 0)
+		{
+			if (mantissa != 0)
+			{
+				// Subnormal half-float, normalize it
+				exponent = 127 - 15 + 1;
+				while ((mantissa & 0x400) == 0)
+				{
+					mantissa <<= 1;
+					exponent--;
+				}
+
+				bits = sign | (exponent << 23) | ((mantissa & 0x3FF) << 13);
+			}
+			else
+				bits = sign;
+		}
+		else if (exponent == 0x1F)
+			bits = sign | 0x7F800000 | (mantissa << 13);
+		else
+			bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+
+		float result;
+		std::memcpy(&result, &bits, sizeof(float));
+
+		return result;
+	}
+
 	/**********************************Generate*********************************/
 
 	void GenerateBox(const Vector3f& lengths, const Vector3ui& subdivision, const Matrix4f& matrix, const Rectf& textureCoords, VertexPointers vertexPointers, IndexIterator indices, Boxf* aabb, UInt32 indexOffset)
@@ -1063,72 +1459,592 @@ namespace Nz
 			NazaraWarning("Indices optimizer failed");
 	}
 
-	/************************************Skin***********************************/
+	/*!
+	* \brief Reorders triangles to reduce overdraw while keeping most of the vertex cache efficiency
+	*
+	* Triangles are split into clusters wherever the (already cache-optimized) order has to reload a whole triangle from memory,
+	* clusters are then sorted so that the ones facing away from the mesh center, which are the most likely to occlude the others, are drawn first.
+	*
+	* \param indices Triangle list indices, should have been optimized by OptimizeIndices first
+	* \param indexCount Index count
+	* \param positions Vertex positions
+	*/
+	void OptimizeOverdraw(IndexIterator indices, UInt32 indexCount, SparsePtr<const Vector3f> positions)
+	{
+		UInt32 triangleCount = indexCount / 3;
+		if (triangleCount < 2)
+			return;
+
+		std::vector<UInt32> triangles(triangleCount * 3);
+		for (UInt32 i = 0; i < triangleCount * 3; ++i)
+			triangles[i] = indices[i];
+
+		// Hard cluster boundaries: triangles where a small FIFO cache misses every vertex
+		constexpr std::size_t CacheSize = 16;
+		std::array<UInt32, CacheSize> cache;
+		cache.fill(std::numeric_limits<UInt32>::max());
+		std::size_t cacheOffset = 0;
+
+		std::vector<UInt32> clusterStarts;
+		for (UInt32 i = 0; i < triangleCount; ++i)
+		{
+			unsigned int missCount = 0;
+			for (UInt32 j = 0; j < 3; ++j)
+			{
+				UInt32 index = triangles[i * 3 + j];
+				if (std::find(cache.begin(), cache.end(), index) == cache.end())
+				{
+					cache[cacheOffset] = index;
+					cacheOffset = (cacheOffset + 1) % CacheSize;
+					missCount++;
+				}
+			}
 
-	void SkinLinearBlend(const SkinningData& skinningInfos, UInt32 startVertex, UInt32 vertexCount)
+			if (i == 0 || missCount == 3)
+				clusterStarts.push_back(i);
+		}
+
+		if (clusterStarts.size() < 2)
+			return;
+
+		Vector3f meshCenter = Vector3f::Zero();
+		for (UInt32 index : triangles)
+			meshCenter += positions[index];
+
+		meshCenter /= float(triangles.size());
+
+		struct Cluster
+		{
+			UInt32 firstTriangle;
+			UInt32 triangleCount;
+			float sortKey;
+		};
+
+		std::vector<Cluster> clusters(clusterStarts.size());
+		for (std::size_t i = 0; i < clusterStarts.size(); ++i)
+		{
+			Cluster& cluster = clusters[i];
+			cluster.firstTriangle = clusterStarts[i];
+			cluster.triangleCount = ((i + 1 < clusterStarts.size()) ? clusterStarts[i + 1] : triangleCount) - cluster.firstTriangle;
+
+			// Area-weighted centroid and normal
+			Vector3f centroid = Vector3f::Zero();
+			Vector3f normal = Vector3f::Zero();
+			float area = 0.f;
+			for (UInt32 j = 0; j < cluster.triangleCount; ++j)
+			{
+				const UInt32* triangle = &triangles[(cluster.firstTriangle + j) * 3];
+				const Vector3f& p0 = positions[triangle[0]];
+				const Vector3f& p1 = positions[triangle[1]];
+				const Vector3f& p2 = positions[triangle[2]];
+
+				Vector3f triangleNormal = (p1 - p0).CrossProduct(p2 - p0);
+				float triangleArea = triangleNormal.GetLength();
+
+				centroid += (p0 + p1 + p2) * (triangleArea / 3.f);
+				normal += triangleNormal;
+				area += triangleArea;
+			}
+
+			if (area > 0.f)
+				centroid /= area;
+
+			float normalLength = normal.GetLength();
+			cluster.sortKey = (normalLength > 0.f) ? (centroid - meshCenter).DotProduct(normal / normalLength) : 0.f;
+		}
+
+		std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster& lhs, const Cluster& rhs)
+		{
+			return lhs.sortKey > rhs.sortKey;
+		});
+
+		for (const Cluster& cluster : clusters)
+		{
+			for (UInt32 i = 0; i < cluster.triangleCount * 3; ++i)
+				*indices++ = triangles[cluster.firstTriangle * 3 + i];
+		}
+	}
+
+	/*!
+	* \brief Computes a vertex order matching the first use of every vertex by the index buffer
+	* \return Number of vertices referenced by the indices
+	*
+	* Indices are rewritten to use the new vertex order, vertices have to be moved using the remap table
+	* (vertex i should go to vertexRemap[i], unreferenced vertices are remapped to InvalidVertexIndex and can be dropped).
+	*
+	* \param indices Indices
+	* \param indexCount Index count
+	* \param vertexCount Vertex count
+	* \param vertexRemap Output table of vertexCount entries
+	*/
+	UInt32 OptimizeVertexFetch(IndexIterator indices, UInt32 indexCount, UInt32 vertexCount, UInt32* vertexRemap)
+	{
+		std::fill(vertexRemap, vertexRemap + vertexCount, InvalidVertexIndex);
+
+		UInt32 nextVertex = 0;
+		for (UInt32 i = 0; i < indexCount; ++i)
+		{
+			UInt32 index = indices[i];
+			NazaraAssert(index < vertexCount, "index out of range");
+
+			if (vertexRemap[index] == InvalidVertexIndex)
+				vertexRemap[index] = nextVertex++;
+
+			indices[i] = vertexRemap[index];
+		}
+
+		return nextVertex;
+	}
+
+	/*!
+	* \brief Finds vertices sharing the exact same data
+	* \return Number of unique vertices
+	*
+	* \param vertices Pointer to the vertex data
+	* \param vertexCount Vertex count
+	* \param stride Size of a vertex
+	* \param vertexRemap Output table of vertexCount entries, receiving for each vertex the index of its unique version (unique vertices keep their relative order)
+	*/
+	UInt32 WeldVertices(const void* vertices, UInt32 vertexCount, std::size_t stride, UInt32* vertexRemap)
 	{
-		NazaraAssert(skinningInfos.inputJointIndices, "missing input joint indices");
-		NazaraAssert(skinningInfos.inputJointWeights, "missing input joint weights");
+		const char* vertexData = static_cast<const char*>(vertices);
+
+		std::unordered_map<std::string_view, UInt32> uniqueVertices;
+		uniqueVertices.reserve(vertexCount);
+
+		for (UInt32 i = 0; i < vertexCount; ++i)
+		{
+			std::string_view vertex(vertexData + i * stride, stride);
+			auto it = uniqueVertices.emplace(vertex, SafeCast<UInt32>(uniqueVertices.size())).first;
+			vertexRemap[i] = it->second;
+		}
+
+		return SafeCast<UInt32>(uniqueVertices.size());
+	}
+
+	/*********************************Simplify*********************************/
+
+	/*!
+	* \brief Simplifies a triangle list by collapsing its edges, using quadric error metrics
+	* \return Number of indices written to outputIndices
+	*
+	* Each collapse merges a vertex into one of its neighbours, vertices are never moved or created so the simplified indices can be used with the original vertices.
+	* Vertices on the mesh borders and vertices sharing their position with other vertices (seams between UV islands or hard edges) are never collapsed to preserve the mesh outline and attributes.
+	*
+	* \param indices Triangle list indices
+	* \param indexCount Index count
+	* \param positions Vertex positions
+	* \param vertexCount Vertex count
+	* \param targetIndexCount Index count to reach, the simplification stops before if no edge can be collapsed under the error limit
+	* \param maxError Maximum distance between the simplified surface and the original one
+	* \param outputIndices Output array of indexCount entries (must not overlap the input indices)
+	* \param resultError If not null, receives the distance between the simplified surface and the original one
+	*/
+	UInt32 SimplifyMesh(IndexIterator indices, UInt32 indexCount, SparsePtr<const Vector3f> positions, UInt32 vertexCount, UInt32 targetIndexCount, float maxError, UInt32* outputIndices, float* resultError)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		UInt32 currentIndexCount = indexCount - indexCount % 3;
+		for (UInt32 i = 0; i < currentIndexCount; ++i)
+		{
+			UInt32 index = indices[i];
+			NazaraAssert(index < vertexCount, "index out of range");
+
+			outputIndices[i] = index;
+		}
+
+		if (resultError)
+			*resultError = 0.f;
+
+		if (currentIndexCount <= targetIndexCount)
+			return currentIndexCount;
+
+		// Identify vertices sharing the same position
+		std::vector<Vector3f> vertexPositions(vertexCount);
+		for (UInt32 i = 0; i < vertexCount; ++i)
+			vertexPositions[i] = positions[i];
+
+		std::vector<UInt32> positionIds(vertexCount);
+		UInt32 positionCount = WeldVertices(vertexPositions.data(), vertexCount, sizeof(Vector3f), positionIds.data());
+
+		// Lock seam vertices (referenced vertices sharing their position)
+		std::vector<bool> isReferenced(vertexCount, false);
+		for (UInt32 i = 0; i < currentIndexCount; ++i)
+			isReferenced[outputIndices[i]] = true;
+
+		std::vector<UInt32> positionUseCount(positionCount, 0);
+		for (UInt32 i = 0; i < vertexCount; ++i)
+		{
+			if (isReferenced[i])
+				positionUseCount[positionIds[i]]++;
+		}
+
+		std::vector<bool> isLocked(positionCount, false);
+		for (UInt32 i = 0; i < positionCount; ++i)
+			isLocked[i] = (positionUseCount[i] > 1);
+
+		// Lock border (and non-manifold) vertices, edges are identified by their positions so seams aren't considered as borders
+		std::unordered_map<UInt64, UInt32> edgeUseCount;
+		edgeUseCount.reserve(currentIndexCount);
+		for (UInt32 i = 0; i < currentIndexCount; i += 3)
+		{
+			for (UInt32 j = 0; j < 3; ++j)
+			{
+				UInt32 a = positionIds[outputIndices[i + j]];
+				UInt32 b = positionIds[outputIndices[i + (j + 1) % 3]];
+				edgeUseCount[(UInt64(std::min(a, b)) << 32) | std::max(a, b)]++;
+			}
+		}
+
+		for (auto&& [edge, useCount] : edgeUseCount)
+		{
+			if (useCount != 2)
+			{
+				isLocked[UInt32(edge >> 32)] = true;
+				isLocked[UInt32(edge & 0xFFFFFFFF)] = true;
+			}
+		}
+
+		// Accumulate the plane of each triangle (weighted by its area) in the quadric of its positions
+		std::vector<Quadric> quadrics(positionCount);
+		for (UInt32 i = 0; i < currentIndexCount; i += 3)
+		{
+			const Vector3f& p0 = vertexPositions[outputIndices[i + 0]];
+			const Vector3f& p1 = vertexPositions[outputIndices[i + 1]];
+			const Vector3f& p2 = vertexPositions[outputIndices[i + 2]];
+
+			Vector3f normal = (p1 - p0).CrossProduct(p2 - p0);
+			float length = normal.GetLength();
+			if (length <= 0.f)
+				continue;
+
+			normal /= length;
+			float distance = -normal.DotProduct(p0);
 
-		UInt32 endVertex = startVertex + vertexCount - 1;
-		if (skinningInfos.outputPositions || skinningInfos.outputNormals || skinningInfos.outputTangents)
+			for (UInt32 j = 0; j < 3; ++j)
+				quadrics[positionIds[outputIndices[i + j]]].AddPlane(normal, distance, length * 0.5f);
+		}
+
+		struct Collapse
 		{
-			NazaraAssert(skinningInfos.joints, "missing skeleton joints");
+			UInt32 from;
+			UInt32 to;
+			double error;
+		};
 
-			if (skinningInfos.outputPositions)
-				NazaraAssert(skinningInfos.inputPositions, "missing input positions");
+		double maxSquaredError = double(maxError) * double(maxError);
+		double resultSquaredError = 0.0;
 
-			if (skinningInfos.outputNormals)
-				NazaraAssert(skinningInfos.inputNormals, "missing input positions");
+		std::vector<Collapse> collapses;
+		std::vector<UInt32> collapseRemap(vertexCount);
+		std::vector<UInt32> triangleOffsets(vertexCount + 1);
+		std::vector<UInt32> vertexTriangles;
+		std::vector<bool> isCollapseLocked(vertexCount);
 
-			if (skinningInfos.outputTangents)
-				NazaraAssert(skinningInfos.inputTangents, "missing input positions");
+		UInt32 targetTriangleCount = targetIndexCount / 3;
+
+		// Collapse the cheapest edges by passes, each pass collapsing edges whose neighbourhood hasn't been modified yet by the same pass
+		while (currentIndexCount > targetIndexCount)
+		{
+			UInt32 triangleCount = currentIndexCount / 3;
 
-			bool hasPositions = skinningInfos.inputPositions && skinningInfos.outputPositions;
-			bool hasNormals = skinningInfos.inputNormals && skinningInfos.outputNormals;
-			bool hasTangents = skinningInfos.inputTangents && skinningInfos.outputTangents;
+			// Vertex to triangles adjacency
+			std::fill(triangleOffsets.begin(), triangleOffsets.end(), 0);
+			for (UInt32 i = 0; i < currentIndexCount; ++i)
+				triangleOffsets[outputIndices[i] + 1]++;
 
-			for (UInt32 i = startVertex; i <= endVertex; ++i)
+			for (UInt32 i = 0; i < vertexCount; ++i)
+				triangleOffsets[i + 1] += triangleOffsets[i];
+
+			vertexTriangles.resize(currentIndexCount);
 			{
-				Vector3f finalPosition = Vector3f::Zero();
-				Vector3f finalNormal = Vector3f::Zero();
-				Vector3f finalTangent = Vector3f::Zero();
+				std::vector<UInt32> cursors(triangleOffsets.begin(), triangleOffsets.end() - 1);
+				for (UInt32 i = 0; i < currentIndexCount; ++i)
+					vertexTriangles[cursors[outputIndices[i]]++] = i / 3;
+			}
 
-				for (Int32 j = 0; j < 4; ++j)
+			collapses.clear();
+			for (UInt32 i = 0; i < currentIndexCount; i += 3)
+			{
+				for (UInt32 j = 0; j < 3; ++j)
 				{
-					Int32 jointIndex = skinningInfos.inputJointIndices[i][j];
+					UInt32 a = outputIndices[i + j];
+					UInt32 b = outputIndices[i + (j + 1) % 3];
 
-					Matrix4f mat = skinningInfos.joints[jointIndex].GetSkinningMatrix();
-					mat *= skinningInfos.inputJointWeights[i][j];
+					for (auto [from, to] : { std::make_pair(a, b), std::make_pair(b, a) })
+					{
+						if (isLocked[positionIds[from]])
+							continue;
 
-					// Hopefully the branch predictor will help here
-					if (hasPositions)
-						finalPosition += mat.Transform(skinningInfos.inputPositions[i]);
+						Quadric quadric = quadrics[positionIds[from]];
+						quadric += quadrics[positionIds[to]];
 
-					if (hasNormals)
-						finalNormal += mat.Transform(skinningInfos.inputNormals[i], 0.f);
+						double error = quadric.Evaluate(vertexPositions[to]);
+						if (error <= maxSquaredError)
+							collapses.push_back({ from, to, error });
+					}
+				}
+			}
 
-					if (hasTangents)
-						finalTangent += mat.Transform(skinningInfos.inputTangents[i], 0.f);
+			std::sort(collapses.begin(), collapses.end(), [](const Collapse& lhs, const Collapse& rhs)
+			{
+				return lhs.error < rhs.error;
+			});
+
+			std::fill(isCollapseLocked.begin(), isCollapseLocked.end(), false);
+			for (UInt32 i = 0; i < vertexCount; ++i)
+				collapseRemap[i] = i;
+
+			UInt32 removedTriangleCount = 0;
+			for (const Collapse& collapse : collapses)
+			{
+				if (triangleCount - removedTriangleCount <= targetTriangleCount)
+					break;
+
+				if (isCollapseLocked[collapse.from] || isCollapseLocked[collapse.to])
+					continue;
+
+				const Vector3f& targetPosition = vertexPositions[collapse.to];
+
+				// Refuse collapses flipping the remaining triangles around the vertex
+				bool isValid = true;
+				UInt32 collapsedTriangleCount = 0;
+				for (UInt32 j = triangleOffsets[collapse.from]; j < triangleOffsets[collapse.from + 1]; ++j)
+				{
+					const UInt32* triangle = &outputIndices[vertexTriangles[j] * 3];
+					if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+					{
+						collapsedTriangleCount++;
+						continue;
+					}
+
+					const Vector3f& p0 = vertexPositions[triangle[0]];
+					const Vector3f& p1 = vertexPositions[triangle[1]];
+					const Vector3f& p2 = vertexPositions[triangle[2]];
+					Vector3f normal = (p1 - p0).CrossProduct(p2 - p0);
+
+					const Vector3f& q0 = (triangle[0] == collapse.from) ? targetPosition : p0;
+					const Vector3f& q1 = (triangle[1] == collapse.from) ? targetPosition : p1;
+					const Vector3f& q2 = (triangle[2] == collapse.from) ? targetPosition : p2;
+					Vector3f collapsedNormal = (q1 - q0).CrossProduct(q2 - q0);
+
+					if (normal.DotProduct(collapsedNormal) <= 0.f)
+					{
+						isValid = false;
+						break;
+					}
 				}
 
-				if (hasPositions)
-					skinningInfos.outputPositions[i] = finalPosition;
+				if (!isValid)
+					continue;
 
-				if (hasNormals)
-					skinningInfos.outputNormals[i] = finalNormal.GetNormal();
+				for (UInt32 j = triangleOffsets[collapse.from]; j < triangleOffsets[collapse.from + 1]; ++j)
+				{
+					const UInt32* triangle = &outputIndices[vertexTriangles[j] * 3];
+					for (UInt32 k = 0; k < 3; ++k)
+						isCollapseLocked[triangle[k]] = true;
+				}
 
-				if (hasTangents)
-					skinningInfos.outputTangents[i] = finalTangent.GetNormal();
+				collapseRemap[collapse.from] = collapse.to;
+				quadrics[positionIds[collapse.to]] += quadrics[positionIds[collapse.from]];
+
+				removedTriangleCount += collapsedTriangleCount;
+				resultSquaredError = std::max(resultSquaredError, collapse.error);
 			}
+
+			if (removedTriangleCount == 0)
+				break;
+
+			// Apply collapses and remove degenerate triangles
+			UInt32 writeIndex = 0;
+			for (UInt32 i = 0; i < currentIndexCount; i += 3)
+			{
+				UInt32 a = collapseRemap[outputIndices[i + 0]];
+				UInt32 b = collapseRemap[outputIndices[i + 1]];
+				UInt32 c = collapseRemap[outputIndices[i + 2]];
+				if (a == b || b == c || c == a)
+					continue;
+
+				outputIndices[writeIndex++] = a;
+				outputIndices[writeIndex++] = b;
+				outputIndices[writeIndex++] = c;
+			}
+
+			currentIndexCount = writeIndex;
 		}
 
-		if (skinningInfos.outputUv)
+		if (resultError)
+			*resultError = float(std::sqrt(resultSquaredError));
+
+		return currentIndexCount;
+	}
+
+	/************************************Skin***********************************/
+
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		struct SkinningRange
 		{
-			NazaraAssert(skinningInfos.inputUv, "missing input uv");
+			const SkinningData* skinningInfos;
+			const Matrix4f* skinningMatrices;
+			bool hasNormals;
+			bool hasPositions;
+			bool hasTangents;
+		};
+
+		// Skinning matrices are gathered once in a contiguous array, this also makes sure every joint lazy update happened before skinning starts (which may run on multiple threads)
+		std::vector<Matrix4f> GatherSkinningMatrices(const SkinningData& skinningInfos, UInt32 startVertex, UInt32 endVertex)
+		{
+			Int32 maxJointIndex = -1;
+			for (UInt32 i = startVertex; i < endVertex; ++i)
+			{
+				const Vector4i32& jointIndices = skinningInfos.inputJointIndices[i];
+				maxJointIndex = std::max({ maxJointIndex, jointIndices.x, jointIndices.y, jointIndices.z, jointIndices.w });
+			}
+
+			std::vector<Matrix4f> skinningMatrices(maxJointIndex + 1);
+			for (Int32 i = 0; i <= maxJointIndex; ++i)
+				skinningMatrices[i] = skinningInfos.joints[i].GetSkinningMatrix();
+
+			return skinningMatrices;
+		}
+
+		void SkinLinearBlendRange(const SkinningRange& range, UInt32 startVertex, UInt32 endVertex)
+		{
+			const SkinningData& skinningInfos = *range.skinningInfos;
+
+			for (UInt32 i = startVertex; i < endVertex; ++i)
+			{
+				const Vector4i32& jointIndices = skinningInfos.inputJointIndices[i];
+				const Vector4f& jointWeights = skinningInfos.inputJointWeights[i];
+
+#ifdef NAZARA_MATH_SIMD
+				// Blend the four joint matrices first, so each attribute is transformed once instead of once per joint
+				Simd::Float4 rows[4];
+				for (std::size_t row = 0; row < 4; ++row)
+				{
+					Simd::Float4 blendedRow = Simd::Mul(Simd::Load(&range.skinningMatrices[jointIndices[0]][row * 4]), Simd::Splat(jointWeights[0]));
+					for (std::size_t j = 1; j < 4; ++j)
+						blendedRow = Simd::MulAdd(Simd::Load(&range.skinningMatrices[jointIndices[j]][row * 4]), Simd::Splat(jointWeights[j]), blendedRow);
+
+					rows[row] = blendedRow;
+				}
+
+				auto Transform = [&](const Vector3f& vec, Simd::Float4 translation)
+				{
+					Simd::Float4 result = Simd::MulAdd(Simd::Splat(vec.x), rows[0], translation);
+					result = Simd::MulAdd(Simd::Splat(vec.y), rows[1], result);
+					result = Simd::MulAdd(Simd::Splat(vec.z), rows[2], result);
+
+					alignas(16) float output[4];
+					Simd::Store(output, result);
+
+					return Vector3f(output[0], output[1], output[2]);
+				};
+
+				if (range.hasPositions)
+					skinningInfos.outputPositions[i] = Transform(skinningInfos.inputPositions[i], rows[3]);
+
+				if (range.hasNormals)
+					skinningInfos.outputNormals[i] = Transform(skinningInfos.inputNormals[i], Simd::Splat(0.f)).GetNormal();
+
+				if (range.hasTangents)
+					skinningInfos.outputTangents[i] = Transform(skinningInfos.inputTangents[i], Simd::Splat(0.f)).GetNormal();
+#else
+				Matrix4f mat = range.skinningMatrices[jointIndices[0]] * jointWeights[0];
+				for (std::size_t j = 1; j < 4; ++j)
+				{
+					const Matrix4f& jointMatrix = range.skinningMatrices[jointIndices[j]];
+					for (std::size_t k = 0; k < 16; ++k)
+						mat[k] += jointMatrix[k] * jointWeights[j];
+				}
 
-			for (UInt64 i = startVertex; i <= endVertex; ++i)
+				if (range.hasPositions)
+					skinningInfos.outputPositions[i] = mat.Transform(skinningInfos.inputPositions[i]);
+
+				if (range.hasNormals)
+					skinningInfos.outputNormals[i] = mat.Transform(skinningInfos.inputNormals[i], 0.f).GetNormal();
+
+				if (range.hasTangents)
+					skinningInfos.outputTangents[i] = mat.Transform(skinningInfos.inputTangents[i], 0.f).GetNormal();
+#endif
+			}
+		}
+
+		void CopySkinningUv(const SkinningData& skinningInfos, UInt32 startVertex, UInt32 endVertex)
+		{
+			for (UInt32 i = startVertex; i < endVertex; ++i)
 				skinningInfos.outputUv[i] = skinningInfos.inputUv[i];
 		}
+
+		template<typename F>
+		void DispatchSkinLinearBlend(const SkinningData& skinningInfos, UInt32 startVertex, UInt32 vertexCount, F&& dispatch)
+		{
+			NazaraAssert(skinningInfos.inputJointIndices, "missing input joint indices");
+			NazaraAssert(skinningInfos.inputJointWeights, "missing input joint weights");
+
+			UInt32 endVertex = startVertex + vertexCount;
+
+			std::vector<Matrix4f> skinningMatrices;
+			SkinningRange range;
+			range.skinningInfos = &skinningInfos;
+			range.skinningMatrices = nullptr;
+			range.hasPositions = skinningInfos.inputPositions && skinningInfos.outputPositions;
+			range.hasNormals = skinningInfos.inputNormals && skinningInfos.outputNormals;
+			range.hasTangents = skinningInfos.inputTangents && skinningInfos.outputTangents;
+
+			bool skinVertices = (skinningInfos.outputPositions || skinningInfos.outputNormals || skinningInfos.outputTangents);
+			if (skinVertices)
+			{
+				NazaraAssert(skinningInfos.joints, "missing skeleton joints");
+
+				if (skinningInfos.outputPositions)
+					NazaraAssert(skinningInfos.inputPositions, "missing input positions");
+
+				if (skinningInfos.outputNormals)
+					NazaraAssert(skinningInfos.inputNormals, "missing input normals");
+
+				if (skinningInfos.outputTangents)
+					NazaraAssert(skinningInfos.inputTangents, "missing input tangents");
+
+				skinningMatrices = GatherSkinningMatrices(skinningInfos, startVertex, endVertex);
+				range.skinningMatrices = skinningMatrices.data();
+			}
+
+			if (skinningInfos.outputUv)
+				NazaraAssert(skinningInfos.inputUv, "missing input uv");
+
+			dispatch([&](UInt32 first, UInt32 last)
+			{
+				if (skinVertices)
+					SkinLinearBlendRange(range, first, last);
+
+				if (skinningInfos.outputUv)
+					CopySkinningUv(skinningInfos, first, last);
+			});
+		}
+	}
+
+	void SkinLinearBlend(const SkinningData& skinningInfos, UInt32 startVertex, UInt32 vertexCount)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		DispatchSkinLinearBlend(skinningInfos, startVertex, vertexCount, [&](auto&& func)
+		{
+			func(startVertex, startVertex + vertexCount);
+		});
+	}
+
+	void SkinLinearBlend(const SkinningData& skinningInfos, UInt32 startVertex, UInt32 vertexCount, TaskScheduler& taskScheduler, UInt32 chunkSize)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		DispatchSkinLinearBlend(skinningInfos, startVertex, vertexCount, [&](auto&& func)
+		{
+			taskScheduler.ForEachChunk(vertexCount, chunkSize, [&](std::size_t first, std::size_t last)
+			{
+				func(startVertex + UInt32(first), startVertex + UInt32(last));
+			});
+		});
 	}
 }
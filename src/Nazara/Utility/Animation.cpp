@@ -7,8 +7,11 @@
 #include <Nazara/Utility/Config.hpp>
 #include <Nazara/Utility/Joint.hpp>
 #include <Nazara/Utility/Sequence.hpp>
+#include <Nazara/Utility/SkeletalPose.hpp>
 #include <Nazara/Utility/Skeleton.hpp>
 #include <Nazara/Utility/Utility.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 #include <Nazara/Utility/Debug.hpp>
@@ -19,6 +22,7 @@ namespace Nz
 	{
 		std::unordered_map<std::string, std::size_t> sequenceMap;
 		std::vector<Sequence> sequences;
+		std::optional<CompressedAnimationTracks> compressedTracks; // Replaces sequenceJoints once compressed
 		std::vector<SequenceJoint> sequenceJoints; // Uniquement pour les animations squelettiques
 		AnimationType type;
 		bool loopPointInterpolation = false;
@@ -57,6 +61,12 @@ namespace Nz
 			std::size_t endFrame = sequence.firstFrame + sequence.frameCount - 1;
 			if (endFrame >= m_impl->frameCount)
 			{
+				if (m_impl->compressedTracks)
+				{
+					NazaraError("sequence is out of the frames range of a compressed animation");
+					return false;
+				}
+
 				m_impl->frameCount = endFrame+1;
 				m_impl->sequenceJoints.resize(m_impl->frameCount*m_impl->jointCount);
 			}
@@ -90,6 +100,20 @@ namespace Nz
 		NazaraAssert(frameA < m_impl->frameCount, "FrameA is out of range");
 		NazaraAssert(frameB < m_impl->frameCount, "FrameB is out of range");
 
+		if (m_impl->compressedTracks)
+		{
+			for (std::size_t i = 0; i < m_impl->jointCount; ++i)
+			{
+				Vector3f position, scale;
+				Quaternionf rotation;
+				m_impl->compressedTracks->SampleJoint(i, frameA, frameB, interpolation, &position, &rotation, &scale);
+
+				targetSkeleton->GetJoint(i)->SetTransform(position, rotation, scale);
+			}
+
+			return;
+		}
+
 		for (std::size_t i = 0; i < m_impl->jointCount; ++i)
 		{
 			Joint* joint = targetSkeleton->GetJoint(i);
@@ -103,6 +127,37 @@ namespace Nz
 		}
 	}
 
+	/*!
+	* \brief Compresses the frames of the animation, reducing its memory usage
+	* \return True if the animation is compressed
+	*
+	* Frames are replaced by reduced and quantized keys (see CompressedAnimationTracks), sequence joints are no longer available afterwards
+	* and the animation can only be sampled. Compressing an already compressed animation does nothing.
+	*
+	* \param params Error tolerances of the compression
+	*/
+	bool Animation::Compress(const AnimationCompressionParams& params)
+	{
+		NazaraAssert(m_impl, "Animation not created");
+		NazaraAssert(m_impl->type == AnimationType::Skeletal, "Animation is not skeletal");
+
+		if (m_impl->compressedTracks)
+			return true;
+
+		if (m_impl->frameCount > CompressedAnimationTracks::MaxFrameCount)
+		{
+			NazaraError("animation has too many frames to be compressed ({0} > {1})", m_impl->frameCount, CompressedAnimationTracks::MaxFrameCount);
+			return false;
+		}
+
+		m_impl->compressedTracks = CompressedAnimationTracks::Compress(m_impl->sequenceJoints.data(), SafeCast<UInt32>(m_impl->frameCount), SafeCast<UInt32>(m_impl->jointCount), params);
+
+		m_impl->sequenceJoints.clear();
+		m_impl->sequenceJoints.shrink_to_fit();
+
+		return true;
+	}
+
 	bool Animation::CreateSkeletal(std::size_t frameCount, std::size_t jointCount)
 	{
 		NazaraAssert(frameCount > 0, "Frame count must be over zero");
@@ -119,6 +174,28 @@ namespace Nz
 		return true;
 	}
 
+	/*!
+	* \brief Creates a skeletal animation from compressed tracks
+	* \return True if the animation was created
+	*
+	* \param compressedTracks Compressed tracks, with at least one frame and one joint
+	*/
+	bool Animation::CreateSkeletal(CompressedAnimationTracks compressedTracks)
+	{
+		NazaraAssert(compressedTracks.GetFrameCount() > 0, "Frame count must be over zero");
+		NazaraAssert(compressedTracks.GetJointCount() > 0, "Joint count must be over zero");
+
+		Destroy();
+
+		m_impl = std::make_unique<AnimationImpl>();
+		m_impl->frameCount = compressedTracks.GetFrameCount();
+		m_impl->jointCount = compressedTracks.GetJointCount();
+		m_impl->compressedTracks = std::move(compressedTracks);
+		m_impl->type = AnimationType::Skeletal;
+
+		return true;
+	}
+
 	void Animation::Destroy()
 	{
 		m_impl.reset();
@@ -131,6 +208,17 @@ namespace Nz
 		m_impl->loopPointInterpolation = loopPointInterpolation;
 	}
 
+	/*!
+	* \brief Returns the compressed tracks of the animation
+	* \return Compressed tracks or a null pointer if the animation isn't compressed
+	*/
+	const CompressedAnimationTracks* Animation::GetCompressedTracks() const
+	{
+		NazaraAssert(m_impl, "Animation not created");
+
+		return (m_impl->compressedTracks) ? &m_impl->compressedTracks.value() : nullptr;
+	}
+
 	std::size_t Animation::GetFrameCount() const
 	{
 		NazaraAssert(m_impl, "Animation not created");
@@ -214,6 +302,7 @@ namespace Nz
 	{
 		NazaraAssert(m_impl, "Animation not created");
 		NazaraAssert(m_impl->type == AnimationType::Skeletal, "Animation is not skeletal");
+		NazaraAssert(!m_impl->compressedTracks, "Animation is compressed");
 
 		return &m_impl->sequenceJoints[frameIndex*m_impl->jointCount];
 	}
@@ -222,6 +311,7 @@ namespace Nz
 	{
 		NazaraAssert(m_impl, "Animation not created");
 		NazaraAssert(m_impl->type == AnimationType::Skeletal, "Animation is not skeletal");
+		NazaraAssert(!m_impl->compressedTracks, "Animation is compressed");
 
 		return &m_impl->sequenceJoints[frameIndex*m_impl->jointCount];
 	}
@@ -247,6 +337,13 @@ namespace Nz
 		return index >= m_impl->sequences.size();
 	}
 
+	bool Animation::IsCompressed() const
+	{
+		NazaraAssert(m_impl, "Animation not created");
+
+		return m_impl->compressedTracks.has_value();
+	}
+
 	bool Animation::IsLoopPointInterpolationEnabled() const
 	{
 		NazaraAssert(m_impl, "Animation not created");
@@ -287,6 +384,60 @@ namespace Nz
 		m_impl->sequences.erase(it);
 	}
 
+	/*!
+	* \brief Samples the animation into a pose, without involving any skeleton
+	*
+	* \param pose Output pose, resized to the animation joint count if required
+	* \param frameA First frame
+	* \param frameB Second frame
+	* \param interpolation Interpolation factor between the two frames
+	*/
+	void Animation::SamplePose(SkeletalPose& pose, std::size_t frameA, std::size_t frameB, float interpolation) const
+	{
+		NazaraAssert(m_impl, "Animation not created");
+		NazaraAssert(m_impl->type == AnimationType::Skeletal, "Animation is not skeletal");
+		NazaraAssert(frameA < m_impl->frameCount, "FrameA is out of range");
+		NazaraAssert(frameB < m_impl->frameCount, "FrameB is out of range");
+
+		if (pose.GetJointCount() != m_impl->jointCount)
+			pose.Reset(m_impl->jointCount);
+
+		Vector3f* positions = pose.GetPositions();
+		Quaternionf* rotations = pose.GetRotations();
+		Vector3f* scales = pose.GetScales();
+
+		if (m_impl->compressedTracks)
+		{
+			m_impl->compressedTracks->Sample(frameA, frameB, interpolation, positions, rotations, scales);
+			return;
+		}
+
+		const SequenceJoint* sequenceJointsA = &m_impl->sequenceJoints[frameA*m_impl->jointCount];
+		const SequenceJoint* sequenceJointsB = &m_impl->sequenceJoints[frameB*m_impl->jointCount];
+		for (std::size_t i = 0; i < m_impl->jointCount; ++i)
+		{
+			positions[i] = Vector3f::Lerp(sequenceJointsA[i].position, sequenceJointsB[i].position, interpolation);
+			rotations[i] = Quaternionf::Slerp(sequenceJointsA[i].rotation, sequenceJointsB[i].rotation, interpolation);
+			scales[i] = Vector3f::Lerp(sequenceJointsA[i].scale, sequenceJointsB[i].scale, interpolation);
+		}
+	}
+
+	bool Animation::SaveToFile(const std::filesystem::path& filePath, const AnimationParams& params) const
+	{
+		Utility* utility = Utility::Instance();
+		NazaraAssert(utility, "Utility module has not been initialized");
+
+		return utility->GetAnimationSaver().SaveToFile(*this, filePath, params);
+	}
+
+	bool Animation::SaveToStream(Stream& stream, const std::string& format, const AnimationParams& params) const
+	{
+		Utility* utility = Utility::Instance();
+		NazaraAssert(utility, "Utility module has not been initialized");
+
+		return utility->GetAnimationSaver().SaveToStream(*this, stream, format, params);
+	}
+
 	Animation& Animation::operator=(Animation&&) noexcept = default;
 
 	std::shared_ptr<Animation> Animation::LoadFromFile(const std::filesystem::path& filePath, const AnimationParams& params)
@@ -0,0 +1,297 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/AnimationBlendTree.hpp>
+#include <Nazara/Core/Core.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Utility/Animation.hpp>
+#include <Nazara/Utility/Joint.hpp>
+#include <Nazara/Utility/Sequence.hpp>
+#include <Nazara/Utility/Skeleton.hpp>
+#include <algorithm>
+#include <cmath>
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		constexpr std::size_t BlendTreeChunkSize = 4;
+	}
+
+	/*!
+	* \ingroup utility
+	* \class Nz::AnimationBlendTree
+	* \brief Utility class evaluating a tree of animation clips into a pose and its skinning matrices, without updating any skeleton joint
+	*
+	* Leaves of the tree are animation clips, which are combined by blend nodes (blending two poses) and layer nodes (blending a pose over another one with per-joint weights).
+	* The resulting skinning matrices can be sent to the GPU directly (see SkeletonInstance::UpdateSkinningMatrices).
+	*
+	* \remark Joints from the skeleton must be sorted so that parents come before their children
+	*/
+
+	/*!
+	* \brief Constructs a blend tree for a skeleton
+	*
+	* The skeleton hierarchy, inverse bind matrices and current pose (used as the bind pose) are captured, and the skeleton isn't referenced afterwards.
+	*/
+	AnimationBlendTree::AnimationBlendTree(const Skeleton& skeleton) :
+	m_rootNode(InvalidNodeIndex),
+	m_bindPose(skeleton)
+	{
+		std::size_t jointCount = skeleton.GetJointCount();
+		m_inverseBindMatrices.resize(jointCount);
+		m_parentIndices.resize(jointCount);
+		m_skinningMatrices.resize(jointCount, Matrix4f::Identity());
+
+		const Joint* joints = skeleton.GetJoints();
+		for (std::size_t i = 0; i < jointCount; ++i)
+		{
+			m_inverseBindMatrices[i] = joints[i].GetInverseBindMatrix();
+
+			const Node* parent = joints[i].GetParent();
+			if (parent && parent >= joints && parent < joints + jointCount)
+				m_parentIndices[i] = SafeCast<std::size_t>(static_cast<const Joint*>(parent) - joints);
+			else
+				m_parentIndices[i] = SkeletalPose::NoParent;
+		}
+
+		m_pose = m_bindPose;
+	}
+
+	/*!
+	* \brief Adds a node blending two other nodes
+	* \return Index of the new node
+	*
+	* \param first First node
+	* \param second Second node
+	* \param weight Weight of the second node, from zero (only the first node is used) to one (only the second node is used)
+	*/
+	auto AnimationBlendTree::AddBlend(NodeIndex first, NodeIndex second, float weight) -> NodeIndex
+	{
+		NazaraAssert(first < m_nodes.size(), "first node index out of range");
+		NazaraAssert(second < m_nodes.size(), "second node index out of range");
+
+		NodeIndex nodeIndex = m_nodes.size();
+
+		auto& node = m_nodes.emplace_back();
+		node.type = TreeNodeType::Blend;
+		node.first = first;
+		node.second = second;
+		node.weight = weight;
+
+		return nodeIndex;
+	}
+
+	/*!
+	* \brief Adds an animation clip node, playing a sequence of a skeletal animation
+	* \return Index of the new node
+	*
+	* \param animation Skeletal animation, must have the same joint count as the skeleton
+	* \param sequenceIndex Index of the sequence to play
+	* \param loop Should the sequence loop once its end is reached, if false the last frame is kept
+	*/
+	auto AnimationBlendTree::AddClip(std::shared_ptr<const Animation> animation, std::size_t sequenceIndex, bool loop) -> NodeIndex
+	{
+		NazaraAssert(animation && animation->IsValid(), "invalid animation");
+		NazaraAssert(animation->GetType() == AnimationType::Skeletal, "animation is not skeletal");
+		NazaraAssert(animation->GetJointCount() == GetJointCount(), "animation joint count must match skeleton joint count");
+		NazaraAssert(animation->HasSequence(sequenceIndex), "sequence index out of range");
+
+		NodeIndex nodeIndex = m_nodes.size();
+
+		auto& node = m_nodes.emplace_back();
+		node.type = TreeNodeType::Clip;
+		node.animation = std::move(animation);
+		node.sequenceIndex = sequenceIndex;
+		node.loop = loop;
+
+		return nodeIndex;
+	}
+
+	/*!
+	* \brief Adds a node blending a layer over a base node using per-joint weights (e.g. to play an upper-body animation over a walk cycle)
+	* \return Index of the new node
+	*
+	* \param base Base node
+	* \param layer Layer node
+	* \param jointWeights Weight of the layer for every joint, joints with a zero weight keep the base pose
+	* \param weight Global weight of the layer
+	*/
+	auto AnimationBlendTree::AddLayer(NodeIndex base, NodeIndex layer, std::vector<float> jointWeights, float weight) -> NodeIndex
+	{
+		NazaraAssert(base < m_nodes.size(), "base node index out of range");
+		NazaraAssert(layer < m_nodes.size(), "layer node index out of range");
+		NazaraAssert(jointWeights.size() == GetJointCount(), "there must be one weight per joint");
+
+		NodeIndex nodeIndex = m_nodes.size();
+
+		auto& node = m_nodes.emplace_back();
+		node.type = TreeNodeType::Layer;
+		node.first = base;
+		node.second = layer;
+		node.jointWeights = std::move(jointWeights);
+		node.weight = weight;
+
+		return nodeIndex;
+	}
+
+	void AnimationBlendTree::SetClipTime(NodeIndex clipIndex, Time time)
+	{
+		NazaraAssert(clipIndex < m_nodes.size(), "node index out of range");
+		NazaraAssert(m_nodes[clipIndex].type == TreeNodeType::Clip, "node is not a clip");
+
+		m_nodes[clipIndex].time = time.AsSeconds();
+	}
+
+	void AnimationBlendTree::SetRootNode(NodeIndex nodeIndex)
+	{
+		NazaraAssert(nodeIndex == InvalidNodeIndex || nodeIndex < m_nodes.size(), "node index out of range");
+
+		m_rootNode = nodeIndex;
+	}
+
+	void AnimationBlendTree::SetWeight(NodeIndex nodeIndex, float weight)
+	{
+		NazaraAssert(nodeIndex < m_nodes.size(), "node index out of range");
+		NazaraAssert(m_nodes[nodeIndex].type != TreeNodeType::Clip, "clips have no weight");
+
+		m_nodes[nodeIndex].weight = weight;
+	}
+
+	/*!
+	* \brief Advances every clip of the tree and evaluates the pose and skinning matrices
+	*
+	* If the tree has no root node, the bind pose is used.
+	*
+	* \param elapsedTime Time elapsed since last update
+	*/
+	void AnimationBlendTree::Update(Time elapsedTime)
+	{
+		float elapsedSeconds = elapsedTime.AsSeconds();
+		for (TreeNode& node : m_nodes)
+		{
+			if (node.type == TreeNodeType::Clip)
+				node.time += elapsedSeconds;
+		}
+
+		if (m_rootNode != InvalidNodeIndex)
+		{
+			// Scratch poses are allocated once per depth level so references to them stay valid during evaluation
+			std::size_t depth = ComputeDepth(m_rootNode);
+			if (m_scratchPoses.size() < depth)
+				m_scratchPoses.resize(depth);
+
+			Evaluate(m_rootNode, m_pose, 0);
+		}
+		else
+			m_pose = m_bindPose;
+
+		m_pose.ComputeModelPose(m_parentIndices.data(), m_modelPose);
+		m_modelPose.ComputeSkinningMatrices(m_inverseBindMatrices.data(), m_skinningMatrices.data());
+	}
+
+	/*!
+	* \brief Updates multiple blend trees (e.g. one per character) concurrently on the engine task scheduler
+	*
+	* \param blendTrees Blend trees to update, a blend tree must not appear more than once
+	* \param blendTreeCount Blend tree count
+	* \param elapsedTime Time elapsed since last update
+	*/
+	void AnimationBlendTree::Update(AnimationBlendTree* const* blendTrees, std::size_t blendTreeCount, Time elapsedTime)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		NazaraAssert(blendTrees || blendTreeCount == 0, "invalid blend trees");
+
+		if (blendTreeCount > BlendTreeChunkSize && Core::Instance())
+		{
+			Core::Instance()->GetTaskScheduler().ForEachChunk(blendTreeCount, BlendTreeChunkSize, [&](std::size_t first, std::size_t last)
+			{
+				for (std::size_t i = first; i < last; ++i)
+					blendTrees[i]->Update(elapsedTime);
+			});
+		}
+		else
+		{
+			for (std::size_t i = 0; i < blendTreeCount; ++i)
+				blendTrees[i]->Update(elapsedTime);
+		}
+	}
+
+	std::size_t AnimationBlendTree::ComputeDepth(NodeIndex nodeIndex) const
+	{
+		const TreeNode& node = m_nodes[nodeIndex];
+		if (node.type == TreeNodeType::Clip)
+			return 0;
+
+		return 1 + std::max(ComputeDepth(node.first), ComputeDepth(node.second));
+	}
+
+	void AnimationBlendTree::Evaluate(NodeIndex nodeIndex, SkeletalPose& pose, std::size_t depth)
+	{
+		const TreeNode& node = m_nodes[nodeIndex];
+		switch (node.type)
+		{
+			case TreeNodeType::Blend:
+			case TreeNodeType::Layer:
+			{
+				Evaluate(node.first, pose, depth);
+
+				// Don't bother evaluating the second branch if it has no influence
+				if (node.weight <= 0.f)
+					break;
+
+				SkeletalPose& secondPose = m_scratchPoses[depth];
+				Evaluate(node.second, secondPose, depth + 1);
+
+				if (node.type == TreeNodeType::Blend)
+					pose.Blend(secondPose, node.weight);
+				else
+					pose.Blend(secondPose, node.weight, node.jointWeights.data());
+
+				break;
+			}
+
+			case TreeNodeType::Clip:
+				SampleClip(node, pose);
+				break;
+		}
+	}
+
+	void AnimationBlendTree::SampleClip(const TreeNode& clipNode, SkeletalPose& pose) const
+	{
+		const Sequence* sequence = clipNode.animation->GetSequence(clipNode.sequenceIndex);
+		NazaraAssert(sequence->frameCount > 0, "sequence has no frame");
+
+		float frameTime = clipNode.time * sequence->frameRate;
+		float lastFrame = float(sequence->frameCount - 1);
+		if (clipNode.loop)
+		{
+			frameTime = std::fmod(frameTime, float(sequence->frameCount));
+			if (frameTime < 0.f)
+				frameTime += float(sequence->frameCount);
+		}
+		else
+			frameTime = std::clamp(frameTime, 0.f, lastFrame);
+
+		std::size_t frame = std::min<std::size_t>(static_cast<std::size_t>(frameTime), sequence->frameCount - 1);
+		float interpolation = frameTime - float(frame);
+
+		std::size_t nextFrame = frame + 1;
+		if (nextFrame >= sequence->frameCount)
+		{
+			if (clipNode.loop && clipNode.animation->IsLoopPointInterpolationEnabled())
+				nextFrame = 0;
+			else
+			{
+				nextFrame = frame;
+				interpolation = 0.f;
+			}
+		}
+
+		clipNode.animation->SamplePose(pose, sequence->firstFrame + frame, sequence->firstFrame + nextFrame, interpolation);
+	}
+}
@@ -4,13 +4,17 @@
 
 #include <Nazara/Utility/Components/SharedSkeletonComponent.hpp>
 #include <Nazara/Utility/Joint.hpp>
+#include <algorithm>
+#include <functional>
+#include <limits>
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
 {
 	SharedSkeletonComponent::SharedSkeletonComponent(std::shared_ptr<Skeleton> skeleton) :
 	SkeletonComponentBase(std::move(skeleton)),
-	m_skeletonJointInvalidated(true)
+	m_invalidatedJointBegin(0),
+	m_invalidatedJointEnd(std::numeric_limits<std::size_t>::max())
 	{
 		SetupSkeleton();
 	}
@@ -18,7 +22,8 @@ namespace Nz
 	SharedSkeletonComponent::SharedSkeletonComponent(const SharedSkeletonComponent& sharedSkeletalComponent) :
 	SkeletonComponentBase(sharedSkeletalComponent),
 	m_attachedSkeleton(sharedSkeletalComponent.m_attachedSkeleton),
-	m_skeletonJointInvalidated(true)
+	m_invalidatedJointBegin(0),
+	m_invalidatedJointEnd(std::numeric_limits<std::size_t>::max())
 	{
 		SetupSkeleton();
 	}
@@ -26,7 +31,8 @@ namespace Nz
 	SharedSkeletonComponent::SharedSkeletonComponent(SharedSkeletonComponent&& sharedSkeletalComponent) noexcept :
 	SkeletonComponentBase(std::move(sharedSkeletalComponent)),
 	m_attachedSkeleton(std::move(sharedSkeletalComponent.m_attachedSkeleton)),
-	m_skeletonJointInvalidated(sharedSkeletalComponent.m_skeletonJointInvalidated)
+	m_invalidatedJointBegin(sharedSkeletalComponent.m_invalidatedJointBegin),
+	m_invalidatedJointEnd(sharedSkeletalComponent.m_invalidatedJointEnd)
 	{
 		SetupSkeleton();
 	}
@@ -36,7 +42,8 @@ namespace Nz
 		SkeletonComponentBase::operator=(sharedSkeletalComponent);
 
 		m_attachedSkeleton = sharedSkeletalComponent.m_attachedSkeleton;
-		m_skeletonJointInvalidated = true;
+		m_invalidatedJointBegin = 0;
+		m_invalidatedJointEnd = std::numeric_limits<std::size_t>::max();
 		SetupSkeleton();
 
 		return *this;
@@ -47,7 +54,8 @@ namespace Nz
 		SkeletonComponentBase::operator=(std::move(sharedSkeletalComponent));
 
 		m_attachedSkeleton = std::move(sharedSkeletalComponent.m_attachedSkeleton);
-		m_skeletonJointInvalidated = sharedSkeletalComponent.m_skeletonJointInvalidated;
+		m_invalidatedJointBegin = sharedSkeletalComponent.m_invalidatedJointBegin;
+		m_invalidatedJointEnd = sharedSkeletalComponent.m_invalidatedJointEnd;
 		SetupSkeleton();
 
 		return *this;
@@ -58,9 +66,10 @@ namespace Nz
 		return m_attachedSkeleton;
 	}
 
-	void SharedSkeletonComponent::OnReferenceJointsInvalidated(const Skeleton* /*skeleton*/)
+	void SharedSkeletonComponent::OnReferenceJointsInvalidated(const Skeleton* /*skeleton*/, std::size_t firstJoint, std::size_t jointCount)
 	{
-		m_skeletonJointInvalidated = true;
+		m_invalidatedJointBegin = std::min(m_invalidatedJointBegin, firstJoint);
+		m_invalidatedJointEnd = std::max(m_invalidatedJointEnd, firstJoint + jointCount);
 	}
 
 	void SharedSkeletonComponent::SetSkeletonParent(Node* parent)
@@ -72,24 +81,37 @@ namespace Nz
 	{
 		assert(m_referenceSkeleton);
 		m_attachedSkeleton = *m_referenceSkeleton;
-		m_referenceSkeleton->OnSkeletonJointsInvalidated.Connect(this, &SharedSkeletonComponent::OnReferenceJointsInvalidated);
+		m_onSkeletonJointsInvalidated.Connect(m_referenceSkeleton->OnSkeletonJointsInvalidated, this, &SharedSkeletonComponent::OnReferenceJointsInvalidated);
 	}
 
 	void SharedSkeletonComponent::UpdateAttachedSkeletonJoints()
 	{
 		std::size_t jointCount = m_referenceSkeleton->GetJointCount();
 		assert(jointCount == m_attachedSkeleton.GetJointCount());
-		if (jointCount == 0)
+
+		std::size_t firstJoint = m_invalidatedJointBegin;
+		std::size_t lastJoint = std::min(m_invalidatedJointEnd, jointCount);
+
+		m_invalidatedJointBegin = std::numeric_limits<std::size_t>::max();
+		m_invalidatedJointEnd = 0;
+
+		if (firstJoint >= lastJoint)
 			return;
 
-		const Joint* referenceJoints = m_referenceSkeleton->GetJoints();
+		// Only joints of the invalidated range (which contains the descendants of every modified joint) have to be synchronized
+		const Joint* referenceJoints = static_cast<const Skeleton&>(*m_referenceSkeleton).GetJoints();
 		Joint* attachedJoints = m_attachedSkeleton.GetJoints();
 
-		for (std::size_t i = 0; i < jointCount; ++i)
+		for (std::size_t i = firstJoint; i < lastJoint; ++i)
 			attachedJoints[i].SetTransform(referenceJoints[i].GetPosition(), referenceJoints[i].GetRotation(), referenceJoints[i].GetScale(), CoordSys::Local, Node::Invalidation::DontInvalidate);
 
-		m_attachedSkeleton.GetRootJoint()->Invalidate();
-
-		m_skeletonJointInvalidated = false;
+		// Recursively invalidate the top joints of the range, which also invalidates nodes attached to the joints
+		std::less<const Node*> lessThan;
+		for (std::size_t i = firstJoint; i < lastJoint; ++i)
+		{
+			const Node* parent = attachedJoints[i].GetParent();
+			if (!parent || lessThan(parent, attachedJoints + firstJoint) || !lessThan(parent, attachedJoints + lastJoint))
+				attachedJoints[i].Invalidate();
+		}
 	}
 }
@@ -0,0 +1,395 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/CompressedAnimationTracks.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Utility/Sequence.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		using Channel = CompressedAnimationTracks::Channel;
+		using Track = CompressedAnimationTracks::Track;
+		using Value = std::array<float, 4>;
+
+		constexpr float QuantizationScale = 65535.f;
+
+		UInt16 Quantize(float value, float rangeMin, float rangeExtent)
+		{
+			if (rangeExtent <= 0.f)
+				return 0;
+
+			float normalized = std::clamp((value - rangeMin) / rangeExtent, 0.f, 1.f);
+			return static_cast<UInt16>(std::lround(normalized * QuantizationScale));
+		}
+
+		float Dequantize(UInt16 value, float rangeMin, float rangeExtent)
+		{
+			return rangeMin + value * (rangeExtent / QuantizationScale);
+		}
+
+		float ComputeError(Channel channel, const Value& value, const Value& reference)
+		{
+			switch (channel)
+			{
+				case Channel::Position:
+				{
+					float dx = value[0] - reference[0];
+					float dy = value[1] - reference[1];
+					float dz = value[2] - reference[2];
+					return std::sqrt(dx * dx + dy * dy + dz * dz);
+				}
+
+				case Channel::Rotation:
+				{
+					// Both quaternions are normalized
+					float dot = std::abs(value[0] * reference[0] + value[1] * reference[1] + value[2] * reference[2] + value[3] * reference[3]);
+					return 2.f * std::acos(std::min(dot, 1.f));
+				}
+
+				case Channel::Scale:
+					return std::max({ std::abs(value[0] - reference[0]), std::abs(value[1] - reference[1]), std::abs(value[2] - reference[2]) });
+			}
+
+			NazaraInternalError("unhandled channel {0}", UnderlyingCast(channel));
+			return 0.f;
+		}
+
+		// Same as the interpolation done by CompressedAnimationTracks::Evaluate (normalized lerp for rotations)
+		Value InterpolateKeys(Channel channel, const Value& from, const Value& to, float interpolation)
+		{
+			Value result;
+			for (std::size_t i = 0; i < 4; ++i)
+				result[i] = from[i] + (to[i] - from[i]) * interpolation;
+
+			if (channel == Channel::Rotation)
+			{
+				float invLength = 1.f / std::sqrt(result[0] * result[0] + result[1] * result[1] + result[2] * result[2] + result[3] * result[3]);
+				for (float& component : result)
+					component *= invLength;
+			}
+
+			return result;
+		}
+
+		void CompressChannel(Channel channel, const std::vector<Value>& frames, float tolerance, Track& track, std::vector<UInt16>& keyFrames, std::vector<UInt16>& keyValues)
+		{
+			std::size_t componentCount = CompressedAnimationTracks::GetComponentCount(channel);
+
+			for (std::size_t i = 0; i < 4; ++i)
+			{
+				float rangeMin = frames[0][i];
+				float rangeMax = frames[0][i];
+				for (const Value& frame : frames)
+				{
+					rangeMin = std::min(rangeMin, frame[i]);
+					rangeMax = std::max(rangeMax, frame[i]);
+				}
+
+				track.rangeMin[i] = rangeMin;
+				track.rangeExtent[i] = (i < componentCount) ? rangeMax - rangeMin : 0.f;
+			}
+
+			// Reduction works on the dequantized keys so the tolerance also bounds the quantization error between keys
+			auto QuantizedValue = [&](std::size_t frameIndex)
+			{
+				Value value = {};
+				for (std::size_t i = 0; i < componentCount; ++i)
+					value[i] = Dequantize(Quantize(frames[frameIndex][i], track.rangeMin[i], track.rangeExtent[i]), track.rangeMin[i], track.rangeExtent[i]);
+
+				return value;
+			};
+
+			auto SegmentFits = [&](std::size_t first, std::size_t last)
+			{
+				Value firstValue = QuantizedValue(first);
+				Value lastValue = QuantizedValue(last);
+
+				for (std::size_t frameIndex = first + 1; frameIndex < last; ++frameIndex)
+				{
+					float interpolation = float(frameIndex - first) / float(last - first);
+					if (ComputeError(channel, InterpolateKeys(channel, firstValue, lastValue, interpolation), frames[frameIndex]) > tolerance)
+						return false;
+				}
+
+				return true;
+			};
+
+			std::size_t lastFrame = frames.size() - 1;
+
+			track.firstKey = SafeCast<UInt32>(keyFrames.size());
+			track.firstValue = SafeCast<UInt32>(keyValues.size());
+
+			auto AddKey = [&](std::size_t frameIndex)
+			{
+				keyFrames.push_back(SafeCast<UInt16>(frameIndex));
+				for (std::size_t i = 0; i < componentCount; ++i)
+					keyValues.push_back(Quantize(frames[frameIndex][i], track.rangeMin[i], track.rangeExtent[i]));
+			};
+
+			AddKey(0);
+
+			// Constant tracks (the most common ones) only need one key, checking them first avoids a quadratic reduction
+			Value firstValue = QuantizedValue(0);
+			bool isConstant = std::all_of(frames.begin(), frames.end(), [&](const Value& frame) { return ComputeError(channel, firstValue, frame) <= tolerance; });
+			if (!isConstant)
+			{
+				// Greedily extend each segment as long as every frame it skips is close enough from the interpolated keys
+				std::size_t segmentStart = 0;
+				while (segmentStart < lastFrame)
+				{
+					std::size_t segmentEnd = segmentStart + 1;
+					while (segmentEnd < lastFrame && SegmentFits(segmentStart, segmentEnd + 1))
+						segmentEnd++;
+
+					AddKey(segmentEnd);
+					segmentStart = segmentEnd;
+				}
+			}
+
+			track.keyCount = SafeCast<UInt32>(keyFrames.size() - track.firstKey);
+		}
+	}
+
+	/*!
+	* \ingroup utility
+	* \class Nz::CompressedAnimationTracks
+	* \brief Utility class storing skeletal animation frames as reduced and quantized keys
+	*
+	* Each joint has a position, rotation and scale track made of keys which are linearly interpolated,
+	* keys which can be interpolated from their neighbors within a tolerance are dropped and key components are quantized to 16 bits over the track range.
+	*/
+
+	/*!
+	* \brief Constructs the tracks from already compressed data (e.g. loaded from a file)
+	*
+	* \remark Data must be valid (see Validate)
+	*/
+	CompressedAnimationTracks::CompressedAnimationTracks(UInt32 frameCount, UInt32 jointCount, std::vector<Track> tracks, std::vector<UInt16> keyFrames, std::vector<UInt16> keyValues) :
+	m_tracks(std::move(tracks)),
+	m_keyFrames(std::move(keyFrames)),
+	m_keyValues(std::move(keyValues)),
+	m_frameCount(frameCount),
+	m_jointCount(jointCount)
+	{
+	}
+
+	/*!
+	* \brief Returns the memory used by the tracks, in bytes
+	*/
+	std::size_t CompressedAnimationTracks::GetMemoryUsage() const
+	{
+		return sizeof(*this) + m_tracks.size() * sizeof(Track) + m_keyFrames.size() * sizeof(UInt16) + m_keyValues.size() * sizeof(UInt16);
+	}
+
+	/*!
+	* \brief Samples every joint between two frames
+	*
+	* \param frameA First frame
+	* \param frameB Second frame
+	* \param interpolation Interpolation factor between the two frames
+	* \param positions Output positions, there must be room for one per joint
+	* \param rotations Output rotations, there must be room for one per joint
+	* \param scales Output scales, there must be room for one per joint
+	*/
+	void CompressedAnimationTracks::Sample(std::size_t frameA, std::size_t frameB, float interpolation, Vector3f* positions, Quaternionf* rotations, Vector3f* scales) const
+	{
+		for (std::size_t i = 0; i < m_jointCount; ++i)
+			SampleJoint(i, frameA, frameB, interpolation, &positions[i], &rotations[i], &scales[i]);
+	}
+
+	/*!
+	* \brief Samples a joint between two frames
+	*
+	* \param jointIndex Joint index
+	* \param frameA First frame
+	* \param frameB Second frame
+	* \param interpolation Interpolation factor between the two frames
+	* \param position Output position
+	* \param rotation Output rotation
+	* \param scale Output scale
+	*/
+	void CompressedAnimationTracks::SampleJoint(std::size_t jointIndex, std::size_t frameA, std::size_t frameB, float interpolation, Vector3f* position, Quaternionf* rotation, Vector3f* scale) const
+	{
+		NazaraAssert(jointIndex < m_jointCount, "joint index out of range");
+		NazaraAssert(frameA < m_frameCount, "frameA is out of range");
+		NazaraAssert(frameB < m_frameCount, "frameB is out of range");
+
+		const Track* tracks = &m_tracks[jointIndex * ChannelCount];
+
+		float values[4];
+		auto EvaluateJoint = [&](float frame, Vector3f* jointPosition, Quaternionf* jointRotation, Vector3f* jointScale)
+		{
+			Evaluate<3>(tracks[UnderlyingCast(Channel::Position)], frame, values);
+			*jointPosition = Vector3f(values[0], values[1], values[2]);
+
+			Evaluate<4>(tracks[UnderlyingCast(Channel::Rotation)], frame, values);
+			*jointRotation = Quaternionf(values[0], values[1], values[2], values[3]).GetNormal();
+
+			Evaluate<3>(tracks[UnderlyingCast(Channel::Scale)], frame, values);
+			*jointScale = Vector3f(values[0], values[1], values[2]);
+		};
+
+		// Consecutive frames (the usual case) can be evaluated at once between their keys
+		if (frameB == frameA || frameB == frameA + 1)
+			EvaluateJoint(frameA + interpolation * (frameB - frameA), position, rotation, scale);
+		else
+		{
+			Vector3f positionB, scaleB;
+			Quaternionf rotationB;
+			EvaluateJoint(float(frameA), position, rotation, scale);
+			EvaluateJoint(float(frameB), &positionB, &rotationB, &scaleB);
+
+			*position = Vector3f::Lerp(*position, positionB, interpolation);
+			*rotation = Quaternionf::Slerp(*rotation, rotationB, interpolation);
+			*scale = Vector3f::Lerp(*scale, scaleB, interpolation);
+		}
+	}
+
+	/*!
+	* \brief Checks the tracks can be sampled safely, this should be used on data coming from untrusted sources
+	* \return True if every track references keys in range, sorted by frame
+	*/
+	bool CompressedAnimationTracks::Validate() const
+	{
+		if (m_tracks.size() != std::size_t(m_jointCount) * ChannelCount)
+			return false;
+
+		for (std::size_t i = 0; i < m_tracks.size(); ++i)
+		{
+			const Track& track = m_tracks[i];
+			std::size_t componentCount = GetComponentCount(static_cast<Channel>(i % ChannelCount));
+
+			if (track.keyCount == 0 || track.firstKey > m_keyFrames.size() || track.keyCount > m_keyFrames.size() - track.firstKey)
+				return false;
+
+			if (track.firstValue > m_keyValues.size() || track.keyCount * componentCount > m_keyValues.size() - track.firstValue)
+				return false;
+
+			for (UInt32 keyIndex = 0; keyIndex < track.keyCount; ++keyIndex)
+			{
+				UInt16 keyFrame = m_keyFrames[track.firstKey + keyIndex];
+				if (keyFrame >= m_frameCount || (keyIndex > 0 && keyFrame <= m_keyFrames[track.firstKey + keyIndex - 1]))
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	/*!
+	* \brief Compresses the frames of a skeletal animation
+	* \return Compressed tracks
+	*
+	* \param sequenceJoints Joints of every frame, frame after frame (as stored by Animation)
+	* \param frameCount Frame count, up to MaxFrameCount
+	* \param jointCount Joint count
+	* \param params Error tolerances of the compression, a sampled value is never further than the tolerance from the original value (besides quantization of the keys themselves)
+	*/
+	CompressedAnimationTracks CompressedAnimationTracks::Compress(const SequenceJoint* sequenceJoints, UInt32 frameCount, UInt32 jointCount, const AnimationCompressionParams& params)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		NazaraAssert(sequenceJoints, "invalid sequence joints");
+		NazaraAssert(frameCount > 0 && frameCount <= MaxFrameCount, "frame count out of range");
+
+		CompressedAnimationTracks compressedTracks;
+		compressedTracks.m_frameCount = frameCount;
+		compressedTracks.m_jointCount = jointCount;
+		compressedTracks.m_tracks.resize(std::size_t(jointCount) * ChannelCount);
+
+		std::vector<Value> frames(frameCount);
+		for (UInt32 jointIndex = 0; jointIndex < jointCount; ++jointIndex)
+		{
+			for (std::size_t channelIndex = 0; channelIndex < ChannelCount; ++channelIndex)
+			{
+				Channel channel = static_cast<Channel>(channelIndex);
+				float tolerance = 0.f;
+
+				for (UInt32 frameIndex = 0; frameIndex < frameCount; ++frameIndex)
+				{
+					const SequenceJoint& sequenceJoint = sequenceJoints[std::size_t(frameIndex) * jointCount + jointIndex];
+					Value& value = frames[frameIndex];
+
+					switch (channel)
+					{
+						case Channel::Position:
+							value = { sequenceJoint.position.x, sequenceJoint.position.y, sequenceJoint.position.z, 0.f };
+							tolerance = params.positionTolerance;
+							break;
+
+						case Channel::Rotation:
+						{
+							Quaternionf rotation = sequenceJoint.rotation.GetNormal();
+							value = { rotation.w, rotation.x, rotation.y, rotation.z };
+
+							// Keep consecutive rotations in the same hemisphere so interpolating keys takes the shortest path
+							if (frameIndex > 0)
+							{
+								const Value& previousValue = frames[frameIndex - 1];
+								if (value[0] * previousValue[0] + value[1] * previousValue[1] + value[2] * previousValue[2] + value[3] * previousValue[3] < 0.f)
+								{
+									for (float& component : value)
+										component = -component;
+								}
+							}
+
+							tolerance = params.rotationTolerance;
+							break;
+						}
+
+						case Channel::Scale:
+							value = { sequenceJoint.scale.x, sequenceJoint.scale.y, sequenceJoint.scale.z, 0.f };
+							tolerance = params.scaleTolerance;
+							break;
+					}
+				}
+
+				Track& track = compressedTracks.m_tracks[std::size_t(jointIndex) * ChannelCount + channelIndex];
+				CompressChannel(channel, frames, tolerance, track, compressedTracks.m_keyFrames, compressedTracks.m_keyValues);
+			}
+		}
+
+		compressedTracks.m_keyFrames.shrink_to_fit();
+		compressedTracks.m_keyValues.shrink_to_fit();
+
+		return compressedTracks;
+	}
+
+	template<std::size_t N>
+	void CompressedAnimationTracks::Evaluate(const Track& track, float frame, float* values) const
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		const UInt16* keyFrames = &m_keyFrames[track.firstKey];
+		const UInt16* keyValues = &m_keyValues[track.firstValue];
+
+		std::size_t keyIndex = 0;
+		float interpolation = 0.f;
+		if (track.keyCount > 1 && frame > keyFrames[0])
+		{
+			if (frame < keyFrames[track.keyCount - 1])
+			{
+				const UInt16* nextKey = std::upper_bound(keyFrames + 1, keyFrames + track.keyCount, frame, [](float value, UInt16 keyFrame) { return value < keyFrame; });
+				keyIndex = std::distance(keyFrames, nextKey) - 1;
+				interpolation = (frame - keyFrames[keyIndex]) / float(keyFrames[keyIndex + 1] - keyFrames[keyIndex]);
+			}
+			else
+				keyIndex = track.keyCount - 1;
+		}
+
+		const UInt16* key = &keyValues[keyIndex * N];
+		for (std::size_t i = 0; i < N; ++i)
+		{
+			values[i] = Dequantize(key[i], track.rangeMin[i], track.rangeExtent[i]);
+			if (interpolation > 0.f)
+				values[i] += (Dequantize(key[N + i], track.rangeMin[i], track.rangeExtent[i]) - values[i]) * interpolation;
+		}
+	}
+}
@@ -3,12 +3,19 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Utility/Font.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <Nazara/Core/Core.hpp>
 #include <Nazara/Core/StringExt.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Utility/Config.hpp>
 #include <Nazara/Utility/FontData.hpp>
 #include <Nazara/Utility/FontGlyph.hpp>
 #include <Nazara/Utility/GuillotineImageAtlas.hpp>
 #include <Nazara/Utility/Utility.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
@@ -18,6 +25,118 @@ namespace Nz
 		const UInt8 r_sansationRegular[] = {
 			#include <Nazara/Utility/Resources/Fonts/OpenSans-Regular.ttf.h>
 		};
+
+		constexpr float DistanceInfinity = std::numeric_limits<float>::max() / 2.f;
+
+		// Felzenszwalb & Huttenlocher squared euclidean distance transform of a row or column, in place
+		void ComputeSquaredDistances(float* values, std::size_t count, std::size_t stride, std::vector<float>& distances, std::vector<std::size_t>& parabolas, std::vector<float>& boundaries)
+		{
+			distances.resize(count);
+			parabolas.resize(count);
+			boundaries.resize(count + 1);
+
+			auto Intersect = [&](std::size_t q, std::size_t p)
+			{
+				float fq = values[q * stride] + float(q * q);
+				float fp = values[p * stride] + float(p * p);
+				return (fq - fp) / (2.f * (float(q) - float(p)));
+			};
+
+			std::size_t k = 0;
+			parabolas[0] = 0;
+			boundaries[0] = -DistanceInfinity;
+			boundaries[1] = DistanceInfinity;
+			for (std::size_t q = 1; q < count; ++q)
+			{
+				float s = Intersect(q, parabolas[k]);
+				while (s <= boundaries[k])
+				{
+					k--;
+					s = Intersect(q, parabolas[k]);
+				}
+
+				k++;
+				parabolas[k] = q;
+				boundaries[k] = s;
+				boundaries[k + 1] = DistanceInfinity;
+			}
+
+			k = 0;
+			for (std::size_t q = 0; q < count; ++q)
+			{
+				while (boundaries[k + 1] < float(q))
+					k++;
+
+				float offset = float(q) - float(parabolas[k]);
+				distances[q] = offset * offset + values[parabolas[k] * stride];
+			}
+
+			for (std::size_t q = 0; q < count; ++q)
+				values[q * stride] = distances[q];
+		}
+
+		void ComputeSquaredDistances(std::vector<float>& grid, std::size_t width, std::size_t height)
+		{
+			std::vector<float> distances;
+			std::vector<std::size_t> parabolas;
+			std::vector<float> boundaries;
+
+			for (std::size_t x = 0; x < width; ++x)
+				ComputeSquaredDistances(&grid[x], height, width, distances, parabolas, boundaries);
+
+			for (std::size_t y = 0; y < height; ++y)
+				ComputeSquaredDistances(&grid[y * width], width, 1, distances, parabolas, boundaries);
+		}
+
+		// Replaces a glyph coverage bitmap by its signed distance field, padded by spread pixels on every side
+		void GenerateSignedDistanceField(FontGlyph& glyph, unsigned int spread)
+		{
+			if (!glyph.image.IsValid())
+				return;
+
+			unsigned int glyphWidth = glyph.image.GetWidth();
+			unsigned int glyphHeight = glyph.image.GetHeight();
+			const UInt8* coverage = glyph.image.GetConstPixels();
+
+			std::size_t width = glyphWidth + 2 * spread;
+			std::size_t height = glyphHeight + 2 * spread;
+
+			// Squared distance to the nearest pixel inside (resp. outside) the glyph
+			std::vector<float> insideDistances(width * height, DistanceInfinity);
+			std::vector<float> outsideDistances(width * height, 0.f);
+			for (unsigned int y = 0; y < glyphHeight; ++y)
+			{
+				for (unsigned int x = 0; x < glyphWidth; ++x)
+				{
+					if (coverage[y * glyphWidth + x] >= 128)
+					{
+						std::size_t index = (y + spread) * width + x + spread;
+						insideDistances[index] = 0.f;
+						outsideDistances[index] = DistanceInfinity;
+					}
+				}
+			}
+
+			ComputeSquaredDistances(insideDistances, width, height);
+			ComputeSquaredDistances(outsideDistances, width, height);
+
+			glyph.image.Create(ImageType::E2D, PixelFormat::A8, SafeCast<unsigned int>(width), SafeCast<unsigned int>(height));
+			UInt8* pixels = glyph.image.GetPixels();
+
+			// Edge lies halfway between an inside and an outside pixel, 0.5 (127) maps to it
+			float invRange = 1.f / (2.f * spread);
+			for (std::size_t i = 0; i < width * height; ++i)
+			{
+				float distance = (insideDistances[i] > 0.f) ? 0.5f - std::sqrt(insideDistances[i]) : std::sqrt(outsideDistances[i]) - 0.5f;
+				float value = std::clamp(0.5f + distance * invRange, 0.f, 1.f);
+				pixels[i] = static_cast<UInt8>(value * 255.f + 0.5f);
+			}
+
+			glyph.aabb.x -= int(spread);
+			glyph.aabb.y -= int(spread);
+			glyph.aabb.width += int(2 * spread);
+			glyph.aabb.height += int(2 * spread);
+		}
 	}
 
 	bool FontParams::IsValid() const
@@ -27,7 +146,10 @@ namespace Nz
 
 	Font::Font() :
 	m_glyphBorder(s_defaultGlyphBorder),
-	m_minimumStepSize(s_defaultMinimumStepSize)
+	m_minimumStepSize(s_defaultMinimumStepSize),
+	m_sdfReferenceSize(DefaultSignedDistanceFieldReferenceSize),
+	m_sdfSpread(DefaultSignedDistanceFieldSpread),
+	m_sdfEnabled(false)
 	{
 		SetAtlas(s_defaultAtlas);
 	}
@@ -55,12 +177,14 @@ namespace Nz
 					for (auto glyphIt = glyphMap.begin(); glyphIt != glyphMap.end(); ++glyphIt)
 					{
 						Glyph& glyph = glyphIt->second;
-						m_atlas->Free(&glyph.atlasRect, &glyph.layerIndex, 1);
+						if (glyph.valid && !glyph.sharesAtlasRect)
+							m_atlas->Free(&glyph.atlasRect, &glyph.layerIndex, 1);
 					}
 				}
 
 				// Destruction des glyphes mémorisés et notification
 				m_glyphes.clear();
+				m_recentGlyphMaps.fill({});
 
 				OnFontGlyphCacheCleared(this);
 			}
@@ -104,6 +228,26 @@ namespace Nz
 		}
 	}
 
+	/*!
+	* \brief Enables or disables signed distance field glyphs
+	*
+	* When enabled, glyphs are rasterized once at the reference size and stored in the atlas as a signed distance field,
+	* glyphs of every other character size and outline thickness reuse that atlas rect with a scaled bounding box.
+	* Rendering them requires a shader thresholding the distance field (shifting the threshold to draw outlines, up to the spread).
+	*
+	* \param enable Should signed distance field glyphs be enabled
+	*
+	* \remark This clears the glyph cache if the mode changes
+	*/
+	void Font::EnableSignedDistanceField(bool enable)
+	{
+		if (m_sdfEnabled != enable)
+		{
+			m_sdfEnabled = enable;
+			ClearGlyphCache();
+		}
+	}
+
 	bool Font::ExtractGlyph(unsigned int characterSize, char32_t character, TextStyleFlags style, float outlineThickness, FontGlyph* glyph) const
 	{
 		#if NAZARA_UTILITY_SAFE
@@ -184,7 +328,7 @@ namespace Nz
 	const Font::Glyph& Font::GetGlyph(unsigned int characterSize, TextStyleFlags style, float outlineThickness, char32_t character) const
 	{
 		UInt64 key = ComputeKey(characterSize, style, outlineThickness);
-		return PrecacheGlyph(m_glyphes[key], characterSize, style, outlineThickness, character);
+		return PrecacheGlyph(GetGlyphMap(key), characterSize, style, outlineThickness, character);
 	}
 
 	unsigned int Font::GetGlyphBorder() const
@@ -197,6 +341,16 @@ namespace Nz
 		return m_minimumStepSize;
 	}
 
+	unsigned int Font::GetSignedDistanceFieldReferenceSize() const
+	{
+		return m_sdfReferenceSize;
+	}
+
+	unsigned int Font::GetSignedDistanceFieldSpread() const
+	{
+		return m_sdfSpread;
+	}
+
 	const Font::SizeInfo& Font::GetSizeInfo(unsigned int characterSize) const
 	{
 		#if NAZARA_UTILITY_SAFE
@@ -245,6 +399,11 @@ namespace Nz
 		return m_data->GetStyleName();
 	}
 
+	bool Font::IsSignedDistanceFieldEnabled() const
+	{
+		return m_sdfEnabled;
+	}
+
 	bool Font::IsValid() const
 	{
 		return m_data != nullptr;
@@ -253,15 +412,18 @@ namespace Nz
 	bool Font::Precache(unsigned int characterSize, TextStyleFlags style, float outlineThickness, char32_t character) const
 	{
 		UInt64 key = ComputeKey(characterSize, style, outlineThickness);
-		return PrecacheGlyph(m_glyphes[key], characterSize, style, outlineThickness, character).valid;
+		return PrecacheGlyph(GetGlyphMap(key), characterSize, style, outlineThickness, character).valid;
 	}
 
 	bool Font::Precache(unsigned int characterSize, TextStyleFlags style, float outlineThickness, std::string_view characterSet) const
 	{
 		NazaraAssert(!characterSet.empty(), "empty character set");
 
+		if (m_sdfEnabled)
+			PrecacheSignedDistanceFields(style, characterSet);
+
 		UInt64 key = ComputeKey(characterSize, style, outlineThickness);
-		auto& glyphMap = m_glyphes[key];
+		auto& glyphMap = GetGlyphMap(key);
 
 		IterateOnCodepoints(characterSet, [&](const char32_t* characters, std::size_t characterCount)
 		{
@@ -316,6 +478,30 @@ namespace Nz
 		}
 	}
 
+	void Font::SetSignedDistanceFieldReferenceSize(unsigned int referenceSize)
+	{
+		if (m_sdfReferenceSize != referenceSize)
+		{
+			NazaraAssert(referenceSize != 0, "Reference size cannot be zero");
+
+			m_sdfReferenceSize = referenceSize;
+			if (m_sdfEnabled)
+				ClearGlyphCache();
+		}
+	}
+
+	void Font::SetSignedDistanceFieldSpread(unsigned int spread)
+	{
+		if (m_sdfSpread != spread)
+		{
+			NazaraAssert(spread != 0, "Spread cannot be zero");
+
+			m_sdfSpread = spread;
+			if (m_sdfEnabled)
+				ClearGlyphCache();
+		}
+	}
+
 	std::shared_ptr<AbstractAtlas> Font::GetDefaultAtlas()
 	{
 		return s_defaultAtlas;
@@ -405,6 +591,26 @@ namespace Nz
 		return (sizeStylePart << 32) | reinterpret_cast<Nz::UInt32&>(outlineThickness);
 	}
 
+	auto Font::GetGlyphMap(UInt64 key) const -> GlyphMap&
+	{
+		// Glyphs are usually queried in runs of the same size and style, skip hashing the key in that case
+		if (m_recentGlyphMaps[0].glyphMap && m_recentGlyphMaps[0].key == key)
+			return *m_recentGlyphMaps[0].glyphMap;
+
+		if (m_recentGlyphMaps[1].glyphMap && m_recentGlyphMaps[1].key == key)
+		{
+			std::swap(m_recentGlyphMaps[0], m_recentGlyphMaps[1]);
+			return *m_recentGlyphMaps[0].glyphMap;
+		}
+
+		// std::unordered_map never invalidates references to its elements
+		GlyphMap& glyphMap = m_glyphes[key];
+		m_recentGlyphMaps[1] = m_recentGlyphMaps[0];
+		m_recentGlyphMaps[0] = { key, &glyphMap };
+
+		return glyphMap;
+	}
+
 	void Font::OnAtlasCleared(const AbstractAtlas* atlas)
 	{
 		NazaraUnused(atlas);
@@ -420,6 +626,7 @@ namespace Nz
 
 		// Notre atlas vient d'être vidé, détruisons le cache de glyphe
 		m_glyphes.clear();
+		m_recentGlyphMaps.fill({});
 
 		OnFontGlyphCacheCleared(this);
 	}
@@ -443,6 +650,18 @@ namespace Nz
 		OnFontAtlasLayerChanged(this, oldLayer, newLayer);
 	}
 
+	TextStyleFlags Font::GetSupportedStyle(TextStyleFlags style) const
+	{
+		TextStyleFlags supportedStyle = style;
+		if (style & TextStyle::Bold && !m_data->SupportsStyle(TextStyle::Bold))
+			supportedStyle &= ~TextStyle::Bold;
+
+		if (style & TextStyle::Italic && !m_data->SupportsStyle(TextStyle::Italic))
+			supportedStyle &= ~TextStyle::Italic;
+
+		return supportedStyle;
+	}
+
 	const Font::Glyph& Font::PrecacheGlyph(GlyphMap& glyphMap, unsigned int characterSize, TextStyleFlags style, float outlineThickness, char32_t character) const
 	{
 		auto it = glyphMap.find(character);
@@ -450,6 +669,7 @@ namespace Nz
 			return it->second;
 
 		Glyph& glyph = glyphMap[character]; //< Insert a new glyph
+		glyph.sharesAtlasRect = false;
 		glyph.valid = false;
 
 		#if NAZARA_UTILITY_SAFE
@@ -465,18 +685,41 @@ namespace Nz
 		glyph.requireFauxBold = false;
 		glyph.requireFauxItalic = false;
 
-		TextStyleFlags supportedStyle = style;
-		if (style & TextStyle::Bold && !m_data->SupportsStyle(TextStyle::Bold))
+		if (m_sdfEnabled)
 		{
-			glyph.requireFauxBold = true;
-			supportedStyle &= ~TextStyle::Bold;
+			// Every size and outline thickness reuses the distance field rasterized at reference size, only metrics are scaled
+			UInt64 referenceKey = ComputeKey(m_sdfReferenceSize, style, 0.f);
+			if (ComputeKey(characterSize, style, outlineThickness) != referenceKey)
+			{
+				const Glyph& referenceGlyph = PrecacheGlyph(GetGlyphMap(referenceKey), m_sdfReferenceSize, style, 0.f, character);
+				if (referenceGlyph.valid)
+				{
+					float scale = float(characterSize) / float(m_sdfReferenceSize);
+
+					glyph.aabb.x = static_cast<int>(std::lround(referenceGlyph.aabb.x * scale));
+					glyph.aabb.y = static_cast<int>(std::lround(referenceGlyph.aabb.y * scale));
+					glyph.aabb.width = static_cast<int>(std::lround(referenceGlyph.aabb.width * scale));
+					glyph.aabb.height = static_cast<int>(std::lround(referenceGlyph.aabb.height * scale));
+					glyph.advance = static_cast<int>(std::lround(referenceGlyph.advance * scale));
+					glyph.atlasRect = referenceGlyph.atlasRect;
+					glyph.flipped = referenceGlyph.flipped;
+					glyph.layerIndex = referenceGlyph.layerIndex;
+					glyph.requireFauxBold = referenceGlyph.requireFauxBold;
+					glyph.requireFauxItalic = referenceGlyph.requireFauxItalic;
+					glyph.sharesAtlasRect = true;
+					glyph.valid = true;
+				}
+
+				return glyph;
+			}
 		}
 
-		if (style & TextStyle::Italic && !m_data->SupportsStyle(TextStyle::Italic))
-		{
+		TextStyleFlags supportedStyle = GetSupportedStyle(style);
+		if (style & TextStyle::Bold && !(supportedStyle & TextStyle::Bold))
+			glyph.requireFauxBold = true;
+
+		if (style & TextStyle::Italic && !(supportedStyle & TextStyle::Italic))
 			glyph.requireFauxItalic = true;
-			supportedStyle &= ~TextStyle::Italic;
-		}
 
 		float supportedOutlineThickness = outlineThickness;
 		if (outlineThickness > 0.f && !m_data->SupportsOutline(outlineThickness))
@@ -491,40 +734,10 @@ namespace Nz
 			FontGlyph fontGlyph;
 			if (ExtractGlyph(characterSize, character, style, outlineThickness, &fontGlyph))
 			{
-				if (fontGlyph.image.IsValid())
-				{
-					glyph.atlasRect.width = fontGlyph.image.GetWidth();
-					glyph.atlasRect.height = fontGlyph.image.GetHeight();
-				}
-				else
-				{
-					glyph.atlasRect.width = 0;
-					glyph.atlasRect.height = 0;
-				}
+				if (m_sdfEnabled)
+					GenerateSignedDistanceField(fontGlyph, m_sdfSpread);
 
-				// Insert rectangle (if not empty) into our atlas
-				if (glyph.atlasRect.width > 0 && glyph.atlasRect.height > 0)
-				{
-					// Add a small border to prevent GPU to sample another glyph pixel
-					glyph.atlasRect.width += m_glyphBorder*2;
-					glyph.atlasRect.height += m_glyphBorder*2;
-
-					if (!m_atlas->Insert(fontGlyph.image, &glyph.atlasRect, &glyph.flipped, &glyph.layerIndex))
-					{
-						NazaraError("Failed to insert glyph into atlas");
-						return glyph;
-					}
-
-					// Recenter and remove glyph border
-					glyph.atlasRect.x += m_glyphBorder;
-					glyph.atlasRect.y += m_glyphBorder;
-					glyph.atlasRect.width -= m_glyphBorder*2;
-					glyph.atlasRect.height -= m_glyphBorder*2;
-				}
-
-				glyph.aabb = fontGlyph.aabb;
-				glyph.advance = fontGlyph.advance;
-				glyph.valid = true;
+				StoreGlyph(glyph, fontGlyph);
 			}
 			else
 				NazaraWarning("Failed to extract glyph \"" + FromUtf32String(std::u32string_view(&character, 1)) + "\"");
@@ -533,7 +746,7 @@ namespace Nz
 		{
 			// Font doesn't support request style, precache the minimal supported version and copy its data
 			UInt64 newKey = ComputeKey(characterSize, supportedStyle, supportedOutlineThickness);
-			const Glyph& referenceGlyph = PrecacheGlyph(m_glyphes[newKey], characterSize, supportedStyle, supportedOutlineThickness, character);
+			const Glyph& referenceGlyph = PrecacheGlyph(GetGlyphMap(newKey), characterSize, supportedStyle, supportedOutlineThickness, character);
 			if (referenceGlyph.valid)
 			{
 				glyph.aabb = referenceGlyph.aabb;
@@ -541,6 +754,7 @@ namespace Nz
 				glyph.atlasRect = referenceGlyph.atlasRect;
 				glyph.flipped = referenceGlyph.flipped;
 				glyph.layerIndex = referenceGlyph.layerIndex;
+				glyph.sharesAtlasRect = true;
 				glyph.valid = true;
 			}
 		}
@@ -548,9 +762,106 @@ namespace Nz
 		return glyph;
 	}
 
+	void Font::PrecacheSignedDistanceFields(TextStyleFlags style, std::string_view characterSet) const
+	{
+		if (!m_atlas || !IsValid())
+			return; //< errors are reported by PrecacheGlyph
+
+		// FreeType rasterization and atlas insertion must happen on this thread but distance fields are computed in parallel
+		TextStyleFlags supportedStyle = GetSupportedStyle(style);
+		GlyphMap& referenceGlyphMap = GetGlyphMap(ComputeKey(m_sdfReferenceSize, supportedStyle, 0.f));
+
+		std::vector<char32_t> characters;
+		IterateOnCodepoints(characterSet, [&](const char32_t* codepoints, std::size_t codepointCount)
+		{
+			for (std::size_t i = 0; i < codepointCount; ++i)
+			{
+				if (referenceGlyphMap.find(codepoints[i]) == referenceGlyphMap.end())
+					characters.push_back(codepoints[i]);
+			}
+
+			return true;
+		});
+
+		std::sort(characters.begin(), characters.end());
+		characters.erase(std::unique(characters.begin(), characters.end()), characters.end());
+
+		struct PendingGlyph
+		{
+			FontGlyph fontGlyph;
+			char32_t character;
+		};
+
+		std::vector<PendingGlyph> pendingGlyphs;
+		pendingGlyphs.reserve(characters.size());
+		for (char32_t character : characters)
+		{
+			// Failed extractions are retried (and reported) by PrecacheGlyph
+			FontGlyph fontGlyph;
+			if (ExtractGlyph(m_sdfReferenceSize, character, supportedStyle, 0.f, &fontGlyph))
+				pendingGlyphs.push_back({ std::move(fontGlyph), character });
+		}
+
+		Core::Instance()->GetTaskScheduler().ForEachChunk(pendingGlyphs.size(), 4, [&](std::size_t first, std::size_t last)
+		{
+			for (std::size_t i = first; i < last; ++i)
+				GenerateSignedDistanceField(pendingGlyphs[i].fontGlyph, m_sdfSpread);
+		});
+
+		for (const PendingGlyph& pendingGlyph : pendingGlyphs)
+		{
+			Glyph& glyph = referenceGlyphMap[pendingGlyph.character];
+			glyph.fauxOutlineThickness = 0.f;
+			glyph.requireFauxBold = false;
+			glyph.requireFauxItalic = false;
+			glyph.sharesAtlasRect = false;
+			glyph.valid = false;
+
+			StoreGlyph(glyph, pendingGlyph.fontGlyph);
+		}
+	}
+
+	void Font::StoreGlyph(Glyph& glyph, const FontGlyph& fontGlyph) const
+	{
+		if (fontGlyph.image.IsValid())
+		{
+			glyph.atlasRect.width = fontGlyph.image.GetWidth();
+			glyph.atlasRect.height = fontGlyph.image.GetHeight();
+		}
+		else
+		{
+			glyph.atlasRect.width = 0;
+			glyph.atlasRect.height = 0;
+		}
+
+		// Insert rectangle (if not empty) into our atlas
+		if (glyph.atlasRect.width > 0 && glyph.atlasRect.height > 0)
+		{
+			// Add a small border to prevent GPU to sample another glyph pixel
+			glyph.atlasRect.width += m_glyphBorder*2;
+			glyph.atlasRect.height += m_glyphBorder*2;
+
+			if (!m_atlas->Insert(fontGlyph.image, &glyph.atlasRect, &glyph.flipped, &glyph.layerIndex))
+			{
+				NazaraError("Failed to insert glyph into atlas");
+				return;
+			}
+
+			// Recenter and remove glyph border
+			glyph.atlasRect.x += m_glyphBorder;
+			glyph.atlasRect.y += m_glyphBorder;
+			glyph.atlasRect.width -= m_glyphBorder*2;
+			glyph.atlasRect.height -= m_glyphBorder*2;
+		}
+
+		glyph.aabb = fontGlyph.aabb;
+		glyph.advance = fontGlyph.advance;
+		glyph.valid = true;
+	}
+
 	bool Font::Initialize()
 	{
-		s_defaultAtlas = std::make_shared<GuillotineImageAtlas>();
+		s_defaultAtlas = std::make_shared<GuillotineImageAtlas>(BinPackAlgorithm::Skyline);
 		s_defaultGlyphBorder = 1;
 		s_defaultMinimumStepSize = 1;
 
@@ -183,7 +183,7 @@ namespace Nz
 							break;
 
 						case D3DFMT_DXT5:
-							*format = PixelFormat::DXT3;
+							*format = PixelFormat::DXT5;
 							break;
 
 						case D3DFMT_DX10:
@@ -216,11 +216,34 @@ namespace Nz
 								case DXGI_FORMAT_R16G16B16A16_UNORM:
 									*format = PixelFormat::RGBA16UI;
 									break;
+								case DXGI_FORMAT_BC1_UNORM:
+									*format = PixelFormat::DXT1;
+									break;
+								case DXGI_FORMAT_BC2_UNORM:
+									*format = PixelFormat::DXT3;
+									break;
+								case DXGI_FORMAT_BC3_UNORM:
+									*format = PixelFormat::DXT5;
+									break;
+								case DXGI_FORMAT_BC4_UNORM:
+									*format = PixelFormat::BC4;
+									break;
+								case DXGI_FORMAT_BC5_UNORM:
+									*format = PixelFormat::BC5;
+									break;
+								case DXGI_FORMAT_BC6H_UF16:
+									*format = PixelFormat::BC6H;
+									break;
+								case DXGI_FORMAT_BC7_UNORM:
+									*format = PixelFormat::BC7;
+									break;
+								case DXGI_FORMAT_BC7_UNORM_SRGB:
+									*format = PixelFormat::BC7_SRGB;
+									break;
 
 								default:
-									//TODO
-									NazaraError("TODO");
-									break;
+									NazaraError("unhandled DXGI format {0}", static_cast<UInt32>(headerExt.dxgiFormat));
+									return false;
 							}
 							break;
 						}
@@ -61,168 +61,51 @@ namespace Nz
 						return false;
 					}
 
-					UInt8* outputImage = static_cast<UInt8*>(frameBuffer);
-					auto& frameData = m_frames[m_currentFrame];
-
 					if (frameTime)
-						*frameTime = frameData.time;
-
-					UInt16 left;
-					UInt16 top;
-					UInt16 width;
-					UInt16 height;
-					UInt8 flag;
-
-					m_byteStream.GetStream()->SetCursorPos(frameData.streamOffset);
-					m_byteStream >> left >> top >> width >> height >> flag;
+						*frameTime = m_frames[m_currentFrame].time;
 
-					ImageDecodingData decodingData;
-					decodingData.lineSize = m_header.width * 4;
-					decodingData.startX = left * 4;
-					decodingData.startY = top * decodingData.lineSize;
-					decodingData.maxX = decodingData.startX + width * 4;
-					decodingData.maxY = decodingData.startY + decodingData.lineSize * height;
-					decodingData.currentX = decodingData.startX;
-					decodingData.currentY = decodingData.startY;
-
-					// Render to previous frame if frame history is required
-					if (m_requiresFrameHistory)
-						decodingData.outputImage = m_previousFrame.get();
-					else
-						decodingData.outputImage = outputImage;
-
-					std::size_t pixelCount = m_header.width * m_header.height;
+					UInt8* outputImage = static_cast<UInt8*>(frameBuffer);
+					std::size_t frameSize = GetFrameSize();
 
-					if (m_currentFrame == 0)
+					if (!m_cachedFrames.empty() && m_cachedFrames[m_currentFrame])
 					{
-						if (m_requiresFrameHistory)
-							std::memset(m_previousFrame.get(), 0, pixelCount * 4);
-						else if (outputImage)
-							std::memset(outputImage, 0, pixelCount * 4);
+						if (outputImage)
+							std::memcpy(outputImage, m_cachedFrames[m_currentFrame].get(), frameSize);
 
-						if (m_disposedRendering)
-							std::memset(m_disposedRendering.get(), 0, pixelCount * 4);
+						m_currentFrame++;
+						return true;
 					}
-					else if (m_requiresFrameHistory)
-					{
-						if (m_frames[m_currentFrame - 1].disposalMethod == DisposeToBackground)
-						{
-							// FIXME: Is background color something else than transparent?
-							std::array<UInt8, 4> backgroundColor;
-							backgroundColor.fill(0);
 
-							// restore affected pixels to background
-							for (std::size_t i = 0; i < pixelCount; ++i)
-							{
-								if (m_affectedPixels[i])
-									std::memcpy(&m_previousFrame[i * 4], &backgroundColor[0], 4);
-							}
-						}
-						else if (m_frames[m_currentFrame - 1].disposalMethod == DisposeToPrevious)
-						{
-							// restore affected pixels to frame N - 2
-							for (std::size_t i = 0; i < pixelCount; ++i)
-							{
-								if (m_affectedPixels[i])
-									std::memcpy(&m_previousFrame[i * 4], &m_disposedRendering[i * 4], 4);
-							}
-						}
+					PrepareDecoding();
 
-						if (m_disposedRendering)
-							std::memcpy(&m_disposedRendering[0], &m_previousFrame[0], pixelCount * 4);
-					}
-					else if (m_frames[m_currentFrame - 1].disposalMethod == DisposeToBackground)
+					// Decode into the cache if it has enough room left
+					std::size_t frameIndex = m_currentFrame;
+					UInt8* cachedFrame = nullptr;
+					if (!m_cachedFrames.empty() && m_cacheMemory + frameSize <= m_cacheMemoryLimit)
 					{
-						// Special case where each frame dispose to background but does full rendering
-						// simply clear to transparent
-						if (outputImage)
-							std::memset(outputImage, 0, pixelCount * 4);
-					}
-
-					// if the width of the specified rectangle is 0, that means
-					// we may not see *any* pixels or the image is malformed;
-					// to make sure this is caught, move the current y down to
-					// max_y (which is what out_gif_code checks).
-					if (width == 0)
-						decodingData.currentY = decodingData.maxY;
+						m_cachedFrames[frameIndex] = std::make_unique<UInt8[]>(frameSize);
+						m_cacheMemory += frameSize;
 
-					bool interlace = (flag & 0b0100'0000);
-					if (interlace)
-					{
-						decodingData.step = 8 * decodingData.lineSize;
-						decodingData.parseMode = 3;
-					}
-					else
-					{
-						decodingData.step = decodingData.lineSize;
-						decodingData.parseMode = 0;
+						cachedFrame = m_cachedFrames[frameIndex].get();
 					}
 
-					bool hasLocalColorTable = (flag & 0b1000'0000);
-					if (hasLocalColorTable)
+					if (!DecodeFrame((cachedFrame) ? cachedFrame : outputImage))
 					{
-						UInt16 numEntries = 2ULL << (flag & 0b0000'0111);
-						m_localColorTable.resize(numEntries);
-						for (std::size_t i = 0; i < numEntries; ++i)
+						if (cachedFrame)
 						{
-							m_byteStream >> m_localColorTable[i].r >> m_localColorTable[i].g >> m_localColorTable[i].b;
-							m_localColorTable[i].a = 0xFF;
+							m_cachedFrames[frameIndex].reset();
+							m_cacheMemory -= frameSize;
 						}
 
-						decodingData.colorTable = &m_localColorTable[0];
-						decodingData.transparentColorIndex = frameData.transparentIndex;
-					}
-					else if (!m_globalColorTable.empty())
-					{
-						decodingData.colorTable = &m_globalColorTable[0];
-						decodingData.transparentColorIndex = frameData.transparentIndex;
-					}
-					else
-					{
-						// this error should have been caught already when loading
-						NazaraInternalError("expected color table");
 						return false;
 					}
 
-					UInt8 minimumCodeSize;
-					m_byteStream >> minimumCodeSize;
-					if (minimumCodeSize > 12)
-					{
-						NazaraInternalError("unexpected LZW Minimum Code Size (" + std::to_string(minimumCodeSize) + ")");
-						return false;
-					}
-
-					if (decodingData.outputImage)
-					{
-						if (!DecodeImageDescriptor(minimumCodeSize, decodingData))
-							return false;
-					}
-					else
-						SkipUntilTerminationBlock();
-
-					if (m_currentFrame == 0)
-					{
-						// if first frame, any pixel not drawn to gets the background color
-						if (!m_globalColorTable.empty())
-						{
-							for (std::size_t i = 0; i < pixelCount; ++i)
-							{
-								if (!m_affectedPixels[i])
-								{
-									UInt8* outputPixel = &outputImage[i * 4];
-									outputPixel[0] = m_globalColorTable[m_header.backgroundPaletteIndex].r;
-									outputPixel[1] = m_globalColorTable[m_header.backgroundPaletteIndex].g;
-									outputPixel[2] = m_globalColorTable[m_header.backgroundPaletteIndex].b;
-									outputPixel[3] = m_globalColorTable[m_header.backgroundPaletteIndex].a;
-								}
-							}
-						}
-					}
+					if (cachedFrame && outputImage)
+						std::memcpy(outputImage, cachedFrame, frameSize);
 
-					if (outputImage && decodingData.outputImage != outputImage)
-						std::memcpy(outputImage, decodingData.outputImage, pixelCount * 4);
+					if (m_requiresFrameHistory && m_keyframeInterval > 0 && m_currentFrame % m_keyframeInterval == 0)
+						StoreKeyframe();
 
-					m_currentFrame++;
 					return true;
 				}
 
@@ -245,16 +128,8 @@ namespace Nz
 				{
 					assert(frameIndex <= m_frames.size());
 
-					if (m_requiresFrameHistory)
-					{
-						if (m_currentFrame > frameIndex)
-							m_currentFrame = 0;
-
-						while (m_currentFrame < frameIndex)
-							DecodeNextFrame(nullptr, nullptr);
-					}
-					else
-						m_currentFrame = frameIndex;
+					// Decoder state is restored lazily, seeking to cached frames doesn't decode anything
+					m_currentFrame = frameIndex;
 				}
 
 				UInt64 Tell() override
@@ -262,8 +137,11 @@ namespace Nz
 					return m_currentFrame;
 				}
 
-				Result<void, ResourceLoadingError> Open()
+				Result<void, ResourceLoadingError> Open(const ImageStreamParams& parameters)
 				{
+					m_cacheMemoryLimit = SafeCast<std::size_t>(std::max(parameters.custom.GetIntegerParameter("GIFLoader_FrameCacheSize").GetValueOr(0), 0LL));
+					m_keyframeInterval = SafeCast<std::size_t>(std::max(parameters.custom.GetIntegerParameter("GIFLoader_KeyframeInterval").GetValueOr(16), 0LL));
+
 					if (!Check())
 						return Err(ResourceLoadingError::Unrecognized);
 
@@ -440,7 +318,14 @@ namespace Nz
 					else
 						m_disposedRendering.reset();
 
+					m_cachedFrames.clear();
+					if (m_cacheMemoryLimit > 0)
+						m_cachedFrames.resize(m_frames.size());
+
+					m_keyframes.clear();
+					m_cacheMemory = 0;
 					m_currentFrame = 0;
+					m_decoderFrame = 0;
 
 					return Ok();
 				}
@@ -473,6 +358,242 @@ namespace Nz
 			private:
 				struct ImageDecodingData;
 
+				// Decodes the current frame, the decoder state must be ready for it (see PrepareDecoding)
+				bool DecodeFrame(UInt8* outputImage)
+				{
+					auto& frameData = m_frames[m_currentFrame];
+
+					UInt16 left;
+					UInt16 top;
+					UInt16 width;
+					UInt16 height;
+					UInt8 flag;
+
+					m_byteStream.GetStream()->SetCursorPos(frameData.streamOffset);
+					m_byteStream >> left >> top >> width >> height >> flag;
+
+					ImageDecodingData decodingData;
+					decodingData.lineSize = m_header.width * 4;
+					decodingData.startX = left * 4;
+					decodingData.startY = top * decodingData.lineSize;
+					decodingData.maxX = decodingData.startX + width * 4;
+					decodingData.maxY = decodingData.startY + decodingData.lineSize * height;
+					decodingData.currentX = decodingData.startX;
+					decodingData.currentY = decodingData.startY;
+
+					// Render to previous frame if frame history is required
+					if (m_requiresFrameHistory)
+						decodingData.outputImage = m_previousFrame.get();
+					else
+						decodingData.outputImage = outputImage;
+
+					std::size_t pixelCount = m_header.width * m_header.height;
+
+					if (m_currentFrame == 0)
+					{
+						if (m_requiresFrameHistory)
+							std::memset(m_previousFrame.get(), 0, pixelCount * 4);
+						else if (outputImage)
+							std::memset(outputImage, 0, pixelCount * 4);
+
+						if (m_disposedRendering)
+							std::memset(m_disposedRendering.get(), 0, pixelCount * 4);
+					}
+					else if (m_requiresFrameHistory)
+					{
+						if (m_frames[m_currentFrame - 1].disposalMethod == DisposeToBackground)
+						{
+							// FIXME: Is background color something else than transparent?
+							std::array<UInt8, 4> backgroundColor;
+							backgroundColor.fill(0);
+
+							// restore affected pixels to background
+							for (std::size_t i = 0; i < pixelCount; ++i)
+							{
+								if (m_affectedPixels[i])
+									std::memcpy(&m_previousFrame[i * 4], &backgroundColor[0], 4);
+							}
+						}
+						else if (m_frames[m_currentFrame - 1].disposalMethod == DisposeToPrevious)
+						{
+							// restore affected pixels to frame N - 2
+							for (std::size_t i = 0; i < pixelCount; ++i)
+							{
+								if (m_affectedPixels[i])
+									std::memcpy(&m_previousFrame[i * 4], &m_disposedRendering[i * 4], 4);
+							}
+						}
+
+						if (m_disposedRendering)
+							std::memcpy(&m_disposedRendering[0], &m_previousFrame[0], pixelCount * 4);
+					}
+					else if (m_frames[m_currentFrame - 1].disposalMethod == DisposeToBackground)
+					{
+						// Special case where each frame dispose to background but does full rendering
+						// simply clear to transparent
+						if (outputImage)
+							std::memset(outputImage, 0, pixelCount * 4);
+					}
+
+					// if the width of the specified rectangle is 0, that means
+					// we may not see *any* pixels or the image is malformed;
+					// to make sure this is caught, move the current y down to
+					// max_y (which is what out_gif_code checks).
+					if (width == 0)
+						decodingData.currentY = decodingData.maxY;
+
+					bool interlace = (flag & 0b0100'0000);
+					if (interlace)
+					{
+						decodingData.step = 8 * decodingData.lineSize;
+						decodingData.parseMode = 3;
+					}
+					else
+					{
+						decodingData.step = decodingData.lineSize;
+						decodingData.parseMode = 0;
+					}
+
+					bool hasLocalColorTable = (flag & 0b1000'0000);
+					if (hasLocalColorTable)
+					{
+						UInt16 numEntries = 2ULL << (flag & 0b0000'0111);
+						m_localColorTable.resize(numEntries);
+						for (std::size_t i = 0; i < numEntries; ++i)
+						{
+							m_byteStream >> m_localColorTable[i].r >> m_localColorTable[i].g >> m_localColorTable[i].b;
+							m_localColorTable[i].a = 0xFF;
+						}
+
+						decodingData.colorTable = &m_localColorTable[0];
+						decodingData.transparentColorIndex = frameData.transparentIndex;
+					}
+					else if (!m_globalColorTable.empty())
+					{
+						decodingData.colorTable = &m_globalColorTable[0];
+						decodingData.transparentColorIndex = frameData.transparentIndex;
+					}
+					else
+					{
+						// this error should have been caught already when loading
+						NazaraInternalError("expected color table");
+						return false;
+					}
+
+					UInt8 minimumCodeSize;
+					m_byteStream >> minimumCodeSize;
+					if (minimumCodeSize > 12)
+					{
+						NazaraInternalError("unexpected LZW Minimum Code Size (" + std::to_string(minimumCodeSize) + ")");
+						return false;
+					}
+
+					if (decodingData.outputImage)
+					{
+						if (!DecodeImageDescriptor(minimumCodeSize, decodingData))
+							return false;
+					}
+					else
+						SkipUntilTerminationBlock();
+
+					if (m_currentFrame == 0)
+					{
+						// if first frame, any pixel not drawn to gets the background color
+						if (decodingData.outputImage && !m_globalColorTable.empty())
+						{
+							for (std::size_t i = 0; i < pixelCount; ++i)
+							{
+								if (!m_affectedPixels[i])
+								{
+									UInt8* outputPixel = &decodingData.outputImage[i * 4];
+									outputPixel[0] = m_globalColorTable[m_header.backgroundPaletteIndex].r;
+									outputPixel[1] = m_globalColorTable[m_header.backgroundPaletteIndex].g;
+									outputPixel[2] = m_globalColorTable[m_header.backgroundPaletteIndex].b;
+									outputPixel[3] = m_globalColorTable[m_header.backgroundPaletteIndex].a;
+								}
+							}
+						}
+					}
+
+					if (outputImage && decodingData.outputImage != outputImage)
+						std::memcpy(outputImage, decodingData.outputImage, pixelCount * 4);
+
+					m_currentFrame++;
+					m_decoderFrame = m_currentFrame;
+
+					return true;
+				}
+
+
+				std::size_t GetFrameSize() const
+				{
+					return std::size_t(m_header.width) * m_header.height * 4;
+				}
+
+				// Brings the decoder state to the current frame, which only matters for frames composited over the previous ones
+				void PrepareDecoding()
+				{
+					if (!m_requiresFrameHistory || m_decoderFrame == m_currentFrame)
+						return;
+
+					std::size_t targetFrame = m_currentFrame;
+
+					// Resume from the closest point before the target frame, either the decoder state or a keyframe
+					std::size_t startFrame = (m_decoderFrame < targetFrame) ? m_decoderFrame : 0;
+					if (auto it = m_keyframes.upper_bound(targetFrame); it != m_keyframes.begin())
+					{
+						--it;
+						if (it->first > startFrame)
+						{
+							const Keyframe& keyframe = it->second;
+							std::size_t pixelCount = std::size_t(m_header.width) * m_header.height;
+
+							std::memcpy(m_previousFrame.get(), keyframe.previousFrame.get(), pixelCount * 4);
+							if (m_disposedRendering)
+								std::memcpy(m_disposedRendering.get(), keyframe.disposedRendering.get(), pixelCount * 4);
+
+							m_affectedPixels = keyframe.affectedPixels;
+							startFrame = it->first;
+						}
+					}
+
+					m_currentFrame = startFrame;
+					while (m_currentFrame < targetFrame)
+					{
+						if (!DecodeFrame(nullptr))
+							break;
+					}
+
+					m_currentFrame = targetFrame;
+				}
+
+				// Snapshots the decoder state so seeking can resume from here instead of the first frame
+				void StoreKeyframe()
+				{
+					if (m_currentFrame >= m_frames.size() || m_keyframes.find(m_currentFrame) != m_keyframes.end())
+						return;
+
+					std::size_t pixelCount = std::size_t(m_header.width) * m_header.height;
+					std::size_t keyframeSize = pixelCount * ((m_disposedRendering) ? 8 : 4) + pixelCount / 8;
+					if (m_cacheMemory + keyframeSize > m_cacheMemoryLimit)
+						return;
+
+					Keyframe keyframe;
+					keyframe.previousFrame = std::make_unique<UInt8[]>(pixelCount * 4);
+					std::memcpy(keyframe.previousFrame.get(), m_previousFrame.get(), pixelCount * 4);
+
+					if (m_disposedRendering)
+					{
+						keyframe.disposedRendering = std::make_unique<UInt8[]>(pixelCount * 4);
+						std::memcpy(keyframe.disposedRendering.get(), m_disposedRendering.get(), pixelCount * 4);
+					}
+
+					keyframe.affectedPixels = m_affectedPixels;
+
+					m_keyframes.emplace(m_currentFrame, std::move(keyframe));
+					m_cacheMemory += keyframeSize;
+				}
+
 				bool DecodeImageDescriptor(UInt8 minimumCodeSize, ImageDecodingData& decodingData)
 				{
 					Int32 clear = 1 << minimumCodeSize;
@@ -682,6 +803,13 @@ namespace Nz
 					UInt8 ratio;
 				};
 
+				struct Keyframe
+				{
+					std::unique_ptr<UInt8[]> disposedRendering;
+					std::unique_ptr<UInt8[]> previousFrame;
+					Bitset<UInt64> affectedPixels;
+				};
+
 				struct LZWEntry
 				{
 					Int16 prefix = 0;
@@ -689,7 +817,13 @@ namespace Nz
 					UInt8 suffix = 0;
 				};
 
+				std::map<std::size_t, Keyframe> m_keyframes; //< decoder state before the frame index
+				std::size_t m_cacheMemory;
+				std::size_t m_cacheMemoryLimit;
 				std::size_t m_currentFrame;
+				std::size_t m_decoderFrame; //< frame the decoder state is ready to decode
+				std::size_t m_keyframeInterval;
+				std::vector<std::unique_ptr<UInt8[]>> m_cachedFrames; //< indexed by frame index, empty if caching is disabled
 				std::vector<Color> m_globalColorTable;
 				std::vector<Color> m_localColorTable;
 				std::vector<FrameMetadata> m_frames;
@@ -709,31 +843,31 @@ namespace Nz
 			return extension == ".gif";
 		}
 
-		Result<std::shared_ptr<ImageStream>, ResourceLoadingError> LoadGIFFile(const std::filesystem::path& filePath, const ImageStreamParams& /*parameters*/)
+		Result<std::shared_ptr<ImageStream>, ResourceLoadingError> LoadGIFFile(const std::filesystem::path& filePath, const ImageStreamParams& parameters)
 		{
 			std::shared_ptr<GIFImageStream> gifStream = std::make_shared<GIFImageStream>();
 			if (!gifStream->SetFile(filePath))
 				return Err(ResourceLoadingError::FailedToOpenFile);
 
-			Result status = gifStream->Open();
+			Result status = gifStream->Open(parameters);
 			return status.Map([&] { return std::move(gifStream); });
 		}
 
-		Result<std::shared_ptr<ImageStream>, ResourceLoadingError> LoadGIFMemory(const void* ptr, std::size_t size, const ImageStreamParams& /*parameters*/)
+		Result<std::shared_ptr<ImageStream>, ResourceLoadingError> LoadGIFMemory(const void* ptr, std::size_t size, const ImageStreamParams& parameters)
 		{
 			std::shared_ptr<GIFImageStream> gifStream = std::make_shared<GIFImageStream>();
 			gifStream->SetMemory(ptr, size);
 
-			Result status = gifStream->Open();
+			Result status = gifStream->Open(parameters);
 			return status.Map([&] { return std::move(gifStream); });
 		}
 
-		Result<std::shared_ptr<ImageStream>, ResourceLoadingError> LoadGIFStream(Stream& stream, const ImageStreamParams& /*parameters*/)
+		Result<std::shared_ptr<ImageStream>, ResourceLoadingError> LoadGIFStream(Stream& stream, const ImageStreamParams& parameters)
 		{
 			std::shared_ptr<GIFImageStream> gifStream = std::make_shared<GIFImageStream>();
 			gifStream->SetStream(stream);
 
-			Result status = gifStream->Open();
+			Result status = gifStream->Open(parameters);
 			return status.Map([&] { return std::move(gifStream); });
 		}
 	}
@@ -0,0 +1,325 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/Formats/KTXLoader.hpp>
+#include <Nazara/Core/ByteStream.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/Stream.hpp>
+#include <Nazara/Utility/Image.hpp>
+#include <Nazara/Utility/PixelFormat.hpp>
+#include <array>
+#include <cstring>
+#include <optional>
+#include <vector>
+#include <Nazara/Utility/Debug.hpp>
+
+// KTX 2.0 specification: https://registry.khronos.org/KTX/specs/2.0/ktxspec.v2.html
+
+namespace Nz
+{
+	namespace
+	{
+		constexpr std::array<UInt8, 12> KTX2Identifier = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+		enum KTX2SupercompressionScheme : UInt32
+		{
+			KTX2Supercompression_None   = 0,
+			KTX2Supercompression_BasisLZ = 1,
+			KTX2Supercompression_Zstd   = 2,
+			KTX2Supercompression_ZLIB   = 3
+		};
+
+		// KTX2 stores pixel formats as VkFormat values, the Utility module doesn't depend on Vulkan headers
+		enum KTX2VkFormat : UInt32
+		{
+			KTX2VkFormat_Undefined               = 0,
+			KTX2VkFormat_R8_UNORM                = 9,
+			KTX2VkFormat_R8G8_UNORM              = 16,
+			KTX2VkFormat_R8G8B8_UNORM            = 23,
+			KTX2VkFormat_R8G8B8_SRGB             = 29,
+			KTX2VkFormat_B8G8R8_UNORM            = 30,
+			KTX2VkFormat_B8G8R8_SRGB             = 36,
+			KTX2VkFormat_R8G8B8A8_UNORM          = 37,
+			KTX2VkFormat_R8G8B8A8_SRGB           = 43,
+			KTX2VkFormat_B8G8R8A8_UNORM          = 44,
+			KTX2VkFormat_B8G8R8A8_SRGB           = 50,
+			KTX2VkFormat_R16G16B16A16_SFLOAT     = 97,
+			KTX2VkFormat_R32_SFLOAT              = 100,
+			KTX2VkFormat_R32G32_SFLOAT           = 103,
+			KTX2VkFormat_R32G32B32_SFLOAT        = 106,
+			KTX2VkFormat_R32G32B32A32_SFLOAT     = 109,
+			KTX2VkFormat_BC1_RGBA_UNORM_BLOCK    = 133,
+			KTX2VkFormat_BC2_UNORM_BLOCK         = 135,
+			KTX2VkFormat_BC3_UNORM_BLOCK         = 137,
+			KTX2VkFormat_BC4_UNORM_BLOCK         = 139,
+			KTX2VkFormat_BC5_UNORM_BLOCK         = 141,
+			KTX2VkFormat_BC6H_UFLOAT_BLOCK       = 143,
+			KTX2VkFormat_BC7_UNORM_BLOCK         = 145,
+			KTX2VkFormat_BC7_SRGB_BLOCK          = 146,
+			KTX2VkFormat_ETC2_R8G8B8_UNORM_BLOCK = 147,
+			KTX2VkFormat_ETC2_R8G8B8_SRGB_BLOCK  = 148,
+			KTX2VkFormat_ETC2_R8G8B8A8_UNORM_BLOCK = 151,
+			KTX2VkFormat_ETC2_R8G8B8A8_SRGB_BLOCK  = 152,
+			KTX2VkFormat_ASTC_4x4_UNORM_BLOCK    = 157,
+			KTX2VkFormat_ASTC_4x4_SRGB_BLOCK     = 158,
+			KTX2VkFormat_ASTC_8x8_UNORM_BLOCK    = 171,
+			KTX2VkFormat_ASTC_8x8_SRGB_BLOCK     = 172
+		};
+
+		struct KTX2Header
+		{
+			UInt32 vkFormat;
+			UInt32 typeSize;
+			UInt32 pixelWidth;
+			UInt32 pixelHeight;
+			UInt32 pixelDepth;
+			UInt32 layerCount;
+			UInt32 faceCount;
+			UInt32 levelCount;
+			UInt32 supercompressionScheme;
+
+			// Index
+			UInt32 dfdByteOffset;
+			UInt32 dfdByteLength;
+			UInt32 kvdByteOffset;
+			UInt32 kvdByteLength;
+			UInt64 sgdByteOffset;
+			UInt64 sgdByteLength;
+		};
+
+		struct KTX2LevelIndex
+		{
+			UInt64 byteOffset;
+			UInt64 byteLength;
+			UInt64 uncompressedByteLength;
+		};
+
+		std::optional<PixelFormat> IdentifyKTX2PixelFormat(UInt32 vkFormat)
+		{
+			switch (vkFormat)
+			{
+				case KTX2VkFormat_R8_UNORM:                  return PixelFormat::R8;
+				case KTX2VkFormat_R8G8_UNORM:                return PixelFormat::RG8;
+				case KTX2VkFormat_R8G8B8_UNORM:              return PixelFormat::RGB8;
+				case KTX2VkFormat_R8G8B8_SRGB:               return PixelFormat::RGB8_SRGB;
+				case KTX2VkFormat_B8G8R8_UNORM:              return PixelFormat::BGR8;
+				case KTX2VkFormat_B8G8R8_SRGB:               return PixelFormat::BGR8_SRGB;
+				case KTX2VkFormat_R8G8B8A8_UNORM:            return PixelFormat::RGBA8;
+				case KTX2VkFormat_R8G8B8A8_SRGB:             return PixelFormat::RGBA8_SRGB;
+				case KTX2VkFormat_B8G8R8A8_UNORM:            return PixelFormat::BGRA8;
+				case KTX2VkFormat_B8G8R8A8_SRGB:             return PixelFormat::BGRA8_SRGB;
+				case KTX2VkFormat_R16G16B16A16_SFLOAT:       return PixelFormat::RGBA16F;
+				case KTX2VkFormat_R32_SFLOAT:                return PixelFormat::R32F;
+				case KTX2VkFormat_R32G32_SFLOAT:             return PixelFormat::RG32F;
+				case KTX2VkFormat_R32G32B32_SFLOAT:          return PixelFormat::RGB32F;
+				case KTX2VkFormat_R32G32B32A32_SFLOAT:       return PixelFormat::RGBA32F;
+				case KTX2VkFormat_BC1_RGBA_UNORM_BLOCK:      return PixelFormat::DXT1;
+				case KTX2VkFormat_BC2_UNORM_BLOCK:           return PixelFormat::DXT3;
+				case KTX2VkFormat_BC3_UNORM_BLOCK:           return PixelFormat::DXT5;
+				case KTX2VkFormat_BC4_UNORM_BLOCK:           return PixelFormat::BC4;
+				case KTX2VkFormat_BC5_UNORM_BLOCK:           return PixelFormat::BC5;
+				case KTX2VkFormat_BC6H_UFLOAT_BLOCK:         return PixelFormat::BC6H;
+				case KTX2VkFormat_BC7_UNORM_BLOCK:           return PixelFormat::BC7;
+				case KTX2VkFormat_BC7_SRGB_BLOCK:            return PixelFormat::BC7_SRGB;
+				case KTX2VkFormat_ETC2_R8G8B8_UNORM_BLOCK:   return PixelFormat::ETC2_RGB8;
+				case KTX2VkFormat_ETC2_R8G8B8_SRGB_BLOCK:    return PixelFormat::ETC2_RGB8_SRGB;
+				case KTX2VkFormat_ETC2_R8G8B8A8_UNORM_BLOCK: return PixelFormat::ETC2_RGBA8;
+				case KTX2VkFormat_ETC2_R8G8B8A8_SRGB_BLOCK:  return PixelFormat::ETC2_RGBA8_SRGB;
+				case KTX2VkFormat_ASTC_4x4_UNORM_BLOCK:      return PixelFormat::ASTC4x4;
+				case KTX2VkFormat_ASTC_4x4_SRGB_BLOCK:       return PixelFormat::ASTC4x4_SRGB;
+				case KTX2VkFormat_ASTC_8x8_UNORM_BLOCK:      return PixelFormat::ASTC8x8;
+				case KTX2VkFormat_ASTC_8x8_SRGB_BLOCK:       return PixelFormat::ASTC8x8_SRGB;
+			}
+
+			return std::nullopt;
+		}
+
+		bool IsKTXSupported(std::string_view extension)
+		{
+			return (extension == ".ktx2");
+		}
+
+		Result<std::shared_ptr<Image>, ResourceLoadingError> LoadKTX(Stream& stream, const ImageParams& parameters)
+		{
+			UInt64 fileStart = stream.GetCursorPos();
+
+			std::array<UInt8, 12> identifier;
+			if (stream.Read(identifier.data(), identifier.size()) != identifier.size() || identifier != KTX2Identifier)
+				return Err(ResourceLoadingError::Unrecognized);
+
+			ByteStream byteStream(&stream);
+			byteStream.SetDataEndianness(Endianness::LittleEndian);
+
+			KTX2Header header;
+			byteStream >> header.vkFormat >> header.typeSize >> header.pixelWidth >> header.pixelHeight >> header.pixelDepth;
+			byteStream >> header.layerCount >> header.faceCount >> header.levelCount >> header.supercompressionScheme;
+			byteStream >> header.dfdByteOffset >> header.dfdByteLength >> header.kvdByteOffset >> header.kvdByteLength;
+			byteStream >> header.sgdByteOffset >> header.sgdByteLength;
+
+			switch (header.supercompressionScheme)
+			{
+				case KTX2Supercompression_None:
+					break;
+
+				case KTX2Supercompression_BasisLZ:
+					NazaraError("Basis Universal (BasisLZ/ETC1S) KTX2 files require transcoding, which is not supported");
+					return Err(ResourceLoadingError::Unsupported);
+
+				case KTX2Supercompression_Zstd:
+				case KTX2Supercompression_ZLIB:
+				default:
+					NazaraError("unsupported KTX2 supercompression scheme {0}", header.supercompressionScheme);
+					return Err(ResourceLoadingError::Unsupported);
+			}
+
+			if (header.vkFormat == KTX2VkFormat_Undefined)
+			{
+				// Undefined format without supercompression is used by UASTC files
+				NazaraError("KTX2 files with an undefined format (UASTC) require transcoding, which is not supported");
+				return Err(ResourceLoadingError::Unsupported);
+			}
+
+			std::optional<PixelFormat> format = IdentifyKTX2PixelFormat(header.vkFormat);
+			if (!format)
+			{
+				NazaraError("unhandled KTX2 format {0}", header.vkFormat);
+				return Err(ResourceLoadingError::Unsupported);
+			}
+
+			if (header.pixelWidth == 0)
+			{
+				NazaraError("invalid KTX2 file (width is zero)");
+				return Err(ResourceLoadingError::DecodingError);
+			}
+
+			ImageType type;
+			unsigned int width = header.pixelWidth;
+			unsigned int height = std::max(header.pixelHeight, 1U);
+			unsigned int depth = std::max(header.pixelDepth, 1U);
+			unsigned int sliceCount = depth; //< number of 2D slices stored for each level (faces and layers included)
+
+			if (header.faceCount == 6)
+			{
+				if (header.layerCount > 0)
+				{
+					NazaraError("Cubemap arrays are not yet supported, sorry");
+					return Err(ResourceLoadingError::Unsupported);
+				}
+
+				type = ImageType::Cubemap;
+				sliceCount = 6;
+			}
+			else if (header.faceCount != 1)
+			{
+				NazaraError("invalid KTX2 face count ({0})", header.faceCount);
+				return Err(ResourceLoadingError::DecodingError);
+			}
+			else if (header.layerCount > 0)
+			{
+				if (header.pixelHeight == 0)
+				{
+					type = ImageType::E1D_Array;
+					height = header.layerCount;
+				}
+				else
+				{
+					type = ImageType::E2D_Array;
+					depth = header.layerCount;
+					sliceCount = header.layerCount;
+				}
+			}
+			else if (header.pixelDepth > 0)
+				type = ImageType::E3D;
+			else if (header.pixelHeight == 0)
+				type = ImageType::E1D;
+			else
+				type = ImageType::E2D;
+
+			// A level count of zero means the file only stores the base level and asks the loader to generate the others
+			UInt32 fileLevelCount = std::max(header.levelCount, 1U);
+
+			std::vector<KTX2LevelIndex> levelIndices(fileLevelCount);
+			for (KTX2LevelIndex& levelIndex : levelIndices)
+				byteStream >> levelIndex.byteOffset >> levelIndex.byteLength >> levelIndex.uncompressedByteLength;
+
+			UInt8 levelCount = SafeCast<UInt8>(std::min<UInt32>(fileLevelCount, Image::GetMaxLevel(type, width, height, depth)));
+			if (parameters.levelCount > 0)
+				levelCount = std::min(levelCount, parameters.levelCount);
+
+			// Our array images shrink their layer count along with their levels, which doesn't match KTX2 layout
+			if ((type == ImageType::E1D_Array || type == ImageType::E2D_Array) && levelCount > 1)
+			{
+				NazaraWarning("mipmaps of array images are not supported yet, only the base level will be loaded");
+				levelCount = 1;
+			}
+
+			std::shared_ptr<Image> image = std::make_shared<Image>();
+			if (!image->Create(type, *format, width, height, depth, levelCount))
+			{
+				NazaraError("failed to create image");
+				return Err(ResourceLoadingError::Internal);
+			}
+
+			unsigned int levelWidth = width;
+			unsigned int levelHeight = (type == ImageType::E1D_Array) ? 1U : height;
+			unsigned int levelSliceCount = sliceCount;
+			for (UInt8 level = 0; level < image->GetLevelCount(); ++level)
+			{
+				const KTX2LevelIndex& levelIndex = levelIndices[level];
+
+				std::size_t byteCount = image->GetMemoryUsage(level);
+				std::size_t expectedByteCount = PixelFormatInfo::ComputeSize(*format, levelWidth, levelHeight, levelSliceCount);
+				if (type == ImageType::E1D_Array)
+					expectedByteCount *= height;
+
+				if (levelIndex.byteLength != expectedByteCount || byteCount != expectedByteCount)
+				{
+					NazaraError("KTX2 level #{0} has an unexpected size ({1} bytes, expected {2})", level, levelIndex.byteLength, expectedByteCount);
+					return Err(ResourceLoadingError::DecodingError);
+				}
+
+				if (!stream.SetCursorPos(fileStart + levelIndex.byteOffset) || stream.Read(image->GetPixels(0, 0, 0, level), byteCount) != byteCount)
+				{
+					NazaraError("failed to read level #{0}", level);
+					return Err(ResourceLoadingError::DecodingError);
+				}
+
+				levelWidth = std::max(levelWidth / 2, 1U);
+				levelHeight = std::max(levelHeight / 2, 1U);
+				if (type == ImageType::E3D)
+					levelSliceCount = std::max(levelSliceCount / 2, 1U);
+			}
+
+			if (parameters.loadFormat != PixelFormat::Undefined && parameters.loadFormat != *format)
+			{
+				if (!image->Convert(parameters.loadFormat))
+				{
+					NazaraError("failed to convert image to required format");
+					return Err(ResourceLoadingError::Unsupported);
+				}
+			}
+
+			return image;
+		}
+	}
+
+	namespace Loaders
+	{
+		ImageLoader::Entry GetImageLoader_KTX()
+		{
+			ImageLoader::Entry loaderEntry;
+			loaderEntry.extensionSupport = IsKTXSupported;
+			loaderEntry.streamLoader = LoadKTX;
+			loaderEntry.parameterFilter = [](const ImageParams& parameters)
+			{
+				if (auto result = parameters.custom.GetBooleanParameter("SkipBuiltinKTXLoader"); result.GetValueOr(false))
+					return false;
+
+				return true;
+			};
+
+			return loaderEntry;
+		}
+	}
+}
@@ -0,0 +1,18 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_UTILITY_FORMATS_KTXLOADER_HPP
+#define NAZARA_UTILITY_FORMATS_KTXLOADER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Utility/Image.hpp>
+
+namespace Nz::Loaders
+{
+	ImageLoader::Entry GetImageLoader_KTX();
+}
+
+#endif // NAZARA_UTILITY_FORMATS_KTXLOADER_HPP
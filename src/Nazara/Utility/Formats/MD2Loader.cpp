@@ -242,9 +242,18 @@ namespace Nz
 
 			mesh->AddSubMesh(subMesh);
 
+			if (parameters.optimizeMesh)
+				mesh->Optimize(parameters);
+
+			if (parameters.lodCount > 0)
+				mesh->GenerateLODs(parameters);
+
 			if (parameters.center)
 				mesh->Recenter();
 
+			if (parameters.compressVertices)
+				mesh->CompressVertices(parameters);
+
 			return mesh;
 		}
 	}
@@ -17,9 +17,9 @@ namespace Nz
 			return extension == ".md5anim";
 		}
 
-		Result<std::shared_ptr<Animation>, ResourceLoadingError> LoadMD5Anim(Stream& stream, const AnimationParams& /*parameters*/)
+		Result<std::shared_ptr<Animation>, ResourceLoadingError> LoadMD5Anim(Stream& stream, const AnimationParams& parameters)
 		{
-			// TODO: Use parameters
+			// TODO: Use joint transformations
 
 			MD5AnimParser parser(stream);
 
@@ -87,6 +87,12 @@ namespace Nz
 				}
 			}
 
+			if (parameters.compress && !animation->Compress(parameters.compression))
+			{
+				NazaraError("failed to compress animation");
+				return Err(ResourceLoadingError::Internal);
+			}
+
 			return animation;
 		}
 	}
@@ -242,6 +242,15 @@ namespace Nz
 					}
 				}
 
+				if (parameters.optimizeMesh)
+					mesh->Optimize(parameters);
+
+				if (parameters.lodCount > 0)
+					mesh->GenerateLODs(parameters);
+
+				if (parameters.compressVertices)
+					mesh->CompressVertices(parameters);
+
 				return mesh;
 			}
 			else
@@ -343,9 +352,18 @@ namespace Nz
 					mesh->SetMaterialData(i, std::move(matData));
 				}
 
+				if (parameters.optimizeMesh)
+					mesh->Optimize(parameters);
+
+				if (parameters.lodCount > 0)
+					mesh->GenerateLODs(parameters);
+
 				if (parameters.center)
 					mesh->Recenter();
 
+				if (parameters.compressVertices)
+					mesh->CompressVertices(parameters);
+
 				return mesh;
 			}
 		}
@@ -0,0 +1,31 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_UTILITY_FORMATS_NZANIMCONSTANTS_HPP
+#define NAZARA_UTILITY_FORMATS_NZANIMCONSTANTS_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+
+/*
+ * .nzanim layout (little endian, version 1), storing compressed skeletal animations (see CompressedAnimationTracks):
+ *
+ * UInt32 magic, UInt32 version
+ * UInt32 frameCount, UInt32 jointCount, UInt32 sequenceCount, UInt8 loopPointInterpolation
+ * sequences: string name, UInt32 firstFrame, UInt32 frameCount, UInt32 frameRate
+ * UInt32 keyFrameCount, UInt32 keyValueCount
+ * tracks (position, rotation and scale for each joint): float rangeMin[4], float rangeExtent[4], UInt32 firstKey, UInt32 keyCount, UInt32 firstValue
+ * key frames (UInt16) then key values (UInt16), each one starting on a NZAnim_DataAlignment boundary so they can be read in one go
+ */
+
+namespace Nz
+{
+	constexpr UInt32 NZAnim_Magic = 'N' << 0 | 'Z' << 8 | 'A' << 16 | 'N' << 24;
+	constexpr UInt32 NZAnim_Version = 1;
+
+	constexpr UInt64 NZAnim_DataAlignment = 16;
+}
+
+#endif // NAZARA_UTILITY_FORMATS_NZANIMCONSTANTS_HPP
@@ -0,0 +1,207 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/Formats/NZAnimLoader.hpp>
+#include <Nazara/Core/Algorithm.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/SerializationContext.hpp>
+#include <Nazara/Core/Stream.hpp>
+#include <Nazara/Utility/CompressedAnimationTracks.hpp>
+#include <Nazara/Utility/Sequence.hpp>
+#include <Nazara/Utility/Skeleton.hpp>
+#include <Nazara/Utility/Formats/NZAnimConstants.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <NazaraUtils/Endianness.hpp>
+#include <vector>
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		bool IsNZAnimSupported(std::string_view extension)
+		{
+			return (extension == ".nzanim");
+		}
+
+		UInt64 GetRemainingSize(const Stream& stream)
+		{
+			UInt64 size = stream.GetSize();
+			UInt64 cursorPos = stream.GetCursorPos();
+			return (size > cursorPos) ? size - cursorPos : 0;
+		}
+
+		bool ReadString(SerializationContext& context, std::string* str)
+		{
+			UInt32 size;
+			if (!Unserialize(context, &size))
+				return false;
+
+			// Don't allocate more than what the file can hold
+			if (size > GetRemainingSize(*context.stream))
+				return false;
+
+			str->resize(size);
+			return size == 0 || context.stream->Read(str->data(), size) == size;
+		}
+
+		bool ReadKeys(Stream& stream, UInt32 keyCount, std::vector<UInt16>& keys)
+		{
+			UInt64 dataOffset = AlignPow2(stream.GetCursorPos(), NZAnim_DataAlignment);
+			UInt64 dataSize = UInt64(keyCount) * sizeof(UInt16);
+			if (dataOffset > stream.GetSize() || dataSize > stream.GetSize() - dataOffset)
+				return false;
+
+			if (!stream.SetCursorPos(dataOffset))
+				return false;
+
+			keys.resize(keyCount);
+			if (stream.Read(keys.data(), dataSize) != dataSize)
+				return false;
+
+#ifdef NAZARA_BIG_ENDIAN
+			for (UInt16& key : keys)
+				key = ByteSwap(key);
+#endif
+
+			return true;
+		}
+
+		Result<std::shared_ptr<Animation>, ResourceLoadingError> LoadNZAnim(Stream& stream, const AnimationParams& parameters)
+		{
+			SerializationContext context;
+			context.endianness = Endianness::LittleEndian;
+			context.stream = &stream;
+
+			UInt32 magic;
+			if (!Unserialize(context, &magic) || magic != NZAnim_Magic)
+				return Err(ResourceLoadingError::Unrecognized);
+
+			UInt32 version;
+			if (!Unserialize(context, &version))
+				return Err(ResourceLoadingError::DecodingError);
+
+			if (version != NZAnim_Version)
+			{
+				NazaraError("unsupported nzanim version {0}", version);
+				return Err(ResourceLoadingError::Unsupported);
+			}
+
+			UInt32 frameCount;
+			UInt32 jointCount;
+			UInt32 sequenceCount;
+			UInt8 loopPointInterpolation;
+
+			if (!Unserialize(context, &frameCount) ||
+			    !Unserialize(context, &jointCount) ||
+			    !Unserialize(context, &sequenceCount) ||
+			    !Unserialize(context, &loopPointInterpolation))
+			{
+				NazaraError("failed to read header");
+				return Err(ResourceLoadingError::DecodingError);
+			}
+
+			if (frameCount == 0 || frameCount > CompressedAnimationTracks::MaxFrameCount || jointCount == 0 || jointCount > GetRemainingSize(stream) || sequenceCount > GetRemainingSize(stream))
+			{
+				NazaraError("ill-formed nzanim header");
+				return Err(ResourceLoadingError::DecodingError);
+			}
+
+			// Joint transformations are already applied to the saved tracks
+			if (parameters.skeleton && parameters.skeleton->GetJointCount() != jointCount)
+			{
+				NazaraError("animation joint count ({0}) doesn't match skeleton joint count ({1})", jointCount, parameters.skeleton->GetJointCount());
+				return Err(ResourceLoadingError::Unsupported);
+			}
+
+			std::vector<Sequence> sequences(sequenceCount);
+			for (UInt32 i = 0; i < sequenceCount; ++i)
+			{
+				Sequence& sequence = sequences[i];
+				if (!ReadString(context, &sequence.name) ||
+				    !Unserialize(context, &sequence.firstFrame) ||
+				    !Unserialize(context, &sequence.frameCount) ||
+				    !Unserialize(context, &sequence.frameRate))
+				{
+					NazaraError("failed to read sequence #{0}", i);
+					return Err(ResourceLoadingError::DecodingError);
+				}
+
+				if (sequence.frameCount == 0 || sequence.firstFrame >= frameCount || sequence.frameCount > frameCount - sequence.firstFrame)
+				{
+					NazaraError("sequence #{0} is out of the animation frames range", i);
+					return Err(ResourceLoadingError::DecodingError);
+				}
+			}
+
+			UInt32 keyFrameCount;
+			UInt32 keyValueCount;
+			if (!Unserialize(context, &keyFrameCount) || !Unserialize(context, &keyValueCount))
+			{
+				NazaraError("failed to read key counts");
+				return Err(ResourceLoadingError::DecodingError);
+			}
+
+			std::vector<CompressedAnimationTracks::Track> tracks(std::size_t(jointCount) * CompressedAnimationTracks::ChannelCount);
+			for (CompressedAnimationTracks::Track& track : tracks)
+			{
+				for (float& rangeMin : track.rangeMin)
+				{
+					if (!Unserialize(context, &rangeMin))
+						return Err(ResourceLoadingError::DecodingError);
+				}
+
+				for (float& rangeExtent : track.rangeExtent)
+				{
+					if (!Unserialize(context, &rangeExtent))
+						return Err(ResourceLoadingError::DecodingError);
+				}
+
+				if (!Unserialize(context, &track.firstKey) || !Unserialize(context, &track.keyCount) || !Unserialize(context, &track.firstValue))
+					return Err(ResourceLoadingError::DecodingError);
+			}
+
+			std::vector<UInt16> keyFrames;
+			std::vector<UInt16> keyValues;
+			if (!ReadKeys(stream, keyFrameCount, keyFrames) || !ReadKeys(stream, keyValueCount, keyValues))
+			{
+				NazaraError("failed to read keys");
+				return Err(ResourceLoadingError::DecodingError);
+			}
+
+			CompressedAnimationTracks compressedTracks(frameCount, jointCount, std::move(tracks), std::move(keyFrames), std::move(keyValues));
+			if (!compressedTracks.Validate())
+			{
+				NazaraError("ill-formed animation tracks");
+				return Err(ResourceLoadingError::DecodingError);
+			}
+
+			std::shared_ptr<Animation> animation = std::make_shared<Animation>();
+			animation->CreateSkeletal(std::move(compressedTracks));
+			animation->EnableLoopPointInterpolation(loopPointInterpolation != 0);
+
+			for (const Sequence& sequence : sequences)
+			{
+				if (!animation->AddSequence(sequence))
+					return Err(ResourceLoadingError::DecodingError);
+			}
+
+			return animation;
+		}
+	}
+
+	namespace Loaders
+	{
+		AnimationLoader::Entry GetAnimationLoader_NZAnim()
+		{
+			NAZARA_USE_ANONYMOUS_NAMESPACE
+
+			AnimationLoader::Entry loader;
+			loader.extensionSupport = IsNZAnimSupported;
+			loader.streamLoader = LoadNZAnim;
+
+			return loader;
+		}
+	}
+}
@@ -0,0 +1,154 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/Formats/NZAnimSaver.hpp>
+#include <Nazara/Core/Algorithm.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/SerializationContext.hpp>
+#include <Nazara/Core/Stream.hpp>
+#include <Nazara/Utility/CompressedAnimationTracks.hpp>
+#include <Nazara/Utility/Sequence.hpp>
+#include <Nazara/Utility/Formats/NZAnimConstants.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <NazaraUtils/Endianness.hpp>
+#include <array>
+#include <optional>
+#include <vector>
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		bool IsNZAnimSupportedSave(std::string_view extension)
+		{
+			return (extension == ".nzanim");
+		}
+
+		bool WriteKeys(SerializationContext& context, const std::vector<UInt16>& keys)
+		{
+			constexpr std::array<UInt8, NZAnim_DataAlignment> padding = {};
+
+			UInt64 cursorPos = context.stream->GetCursorPos();
+			UInt64 paddingSize = AlignPow2(cursorPos, NZAnim_DataAlignment) - cursorPos;
+			if (paddingSize > 0 && context.stream->Write(padding.data(), paddingSize) != paddingSize)
+				return false;
+
+			UInt64 dataSize = keys.size() * sizeof(UInt16);
+#ifdef NAZARA_BIG_ENDIAN
+			std::vector<UInt16> swappedKeys(keys.size());
+			for (std::size_t i = 0; i < keys.size(); ++i)
+				swappedKeys[i] = ByteSwap(keys[i]);
+
+			return context.stream->Write(swappedKeys.data(), dataSize) == dataSize;
+#else
+			return context.stream->Write(keys.data(), dataSize) == dataSize;
+#endif
+		}
+
+		bool SaveNZAnimToStream(const Animation& animation, const std::string& format, Stream& stream, const AnimationParams& parameters)
+		{
+			NAZARA_USE_ANONYMOUS_NAMESPACE
+
+			NazaraUnused(format);
+
+			if (!animation.IsValid() || animation.GetType() != AnimationType::Skeletal)
+			{
+				NazaraError("invalid skeletal animation");
+				return false;
+			}
+
+			// Uncompressed animations are compressed on the fly using the parameters tolerances
+			std::optional<CompressedAnimationTracks> compressedTracks;
+			const CompressedAnimationTracks* tracks = animation.GetCompressedTracks();
+			if (!tracks)
+			{
+				if (animation.GetFrameCount() > CompressedAnimationTracks::MaxFrameCount)
+				{
+					NazaraError("animation has too many frames ({0} > {1})", animation.GetFrameCount(), CompressedAnimationTracks::MaxFrameCount);
+					return false;
+				}
+
+				compressedTracks = CompressedAnimationTracks::Compress(animation.GetSequenceJoints(), SafeCast<UInt32>(animation.GetFrameCount()), SafeCast<UInt32>(animation.GetJointCount()), parameters.compression);
+				tracks = &compressedTracks.value();
+			}
+
+			SerializationContext context;
+			context.endianness = Endianness::LittleEndian;
+			context.stream = &stream;
+
+			if (!Serialize(context, NZAnim_Magic) ||
+			    !Serialize(context, NZAnim_Version) ||
+			    !Serialize(context, tracks->GetFrameCount()) ||
+			    !Serialize(context, tracks->GetJointCount()) ||
+			    !Serialize(context, SafeCast<UInt32>(animation.GetSequenceCount())) ||
+			    !Serialize(context, UInt8((animation.IsLoopPointInterpolationEnabled()) ? 1 : 0)))
+			{
+				NazaraError("failed to write header");
+				return false;
+			}
+
+			for (std::size_t i = 0; i < animation.GetSequenceCount(); ++i)
+			{
+				const Sequence& sequence = *animation.GetSequence(i);
+				if (!Serialize(context, sequence.name) ||
+				    !Serialize(context, sequence.firstFrame) ||
+				    !Serialize(context, sequence.frameCount) ||
+				    !Serialize(context, sequence.frameRate))
+				{
+					NazaraError("failed to write sequence #{0}", i);
+					return false;
+				}
+			}
+
+			const std::vector<UInt16>& keyFrames = tracks->GetKeyFrames();
+			const std::vector<UInt16>& keyValues = tracks->GetKeyValues();
+			if (!Serialize(context, SafeCast<UInt32>(keyFrames.size())) || !Serialize(context, SafeCast<UInt32>(keyValues.size())))
+			{
+				NazaraError("failed to write key counts");
+				return false;
+			}
+
+			for (const CompressedAnimationTracks::Track& track : tracks->GetTracks())
+			{
+				for (float rangeMin : track.rangeMin)
+				{
+					if (!Serialize(context, rangeMin))
+						return false;
+				}
+
+				for (float rangeExtent : track.rangeExtent)
+				{
+					if (!Serialize(context, rangeExtent))
+						return false;
+				}
+
+				if (!Serialize(context, track.firstKey) || !Serialize(context, track.keyCount) || !Serialize(context, track.firstValue))
+					return false;
+			}
+
+			if (!WriteKeys(context, keyFrames) || !WriteKeys(context, keyValues))
+			{
+				NazaraError("failed to write keys");
+				return false;
+			}
+
+			return true;
+		}
+	}
+
+	namespace Loaders
+	{
+		AnimationSaver::Entry GetAnimationSaver_NZAnim()
+		{
+			NAZARA_USE_ANONYMOUS_NAMESPACE
+
+			AnimationSaver::Entry entry;
+			entry.formatSupport = IsNZAnimSupportedSave;
+			entry.streamSaver = SaveNZAnimToStream;
+
+			return entry;
+		}
+	}
+}
@@ -0,0 +1,18 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_UTILITY_FORMATS_NZANIMSAVER_HPP
+#define NAZARA_UTILITY_FORMATS_NZANIMSAVER_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Utility/Animation.hpp>
+
+namespace Nz::Loaders
+{
+	AnimationSaver::Entry GetAnimationSaver_NZAnim();
+}
+
+#endif // NAZARA_UTILITY_FORMATS_NZANIMSAVER_HPP
@@ -0,0 +1,90 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/Formats/NZMeshConstants.hpp>
+#include <Nazara/Utility/VertexDeclaration.hpp>
+#include <NazaraUtils/Endianness.hpp>
+#include <cstring>
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		template<typename T>
+		void SwapArray(UInt8* data, std::size_t count)
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				T value;
+				std::memcpy(&value, data, sizeof(T));
+				value = ByteSwap(value);
+				std::memcpy(data, &value, sizeof(T));
+
+				data += sizeof(T);
+			}
+		}
+	}
+
+	void NZMesh_SwapIndices(void* indices, IndexType indexType, UInt32 indexCount)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		UInt8* ptr = static_cast<UInt8*>(indices);
+		switch (indexType)
+		{
+			case IndexType::U8:
+				break;
+
+			case IndexType::U16:
+				SwapArray<UInt16>(ptr, indexCount);
+				break;
+
+			case IndexType::U32:
+				SwapArray<UInt32>(ptr, indexCount);
+				break;
+		}
+	}
+
+	void NZMesh_SwapVertices(void* vertices, const VertexDeclaration& declaration, UInt32 vertexCount)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		UInt8* ptr = static_cast<UInt8*>(vertices);
+		std::size_t stride = declaration.GetStride();
+		for (UInt32 i = 0; i < vertexCount; ++i)
+		{
+			for (const auto& component : declaration.GetComponents())
+			{
+				UInt8* componentPtr = ptr + component.offset;
+				switch (component.type)
+				{
+					case ComponentType::Double1: SwapArray<UInt64>(componentPtr, 1); break;
+					case ComponentType::Double2: SwapArray<UInt64>(componentPtr, 2); break;
+					case ComponentType::Double3: SwapArray<UInt64>(componentPtr, 3); break;
+					case ComponentType::Double4: SwapArray<UInt64>(componentPtr, 4); break;
+					case ComponentType::Float1:
+					case ComponentType::Int1:    SwapArray<UInt32>(componentPtr, 1); break;
+					case ComponentType::Float2:
+					case ComponentType::Int2:    SwapArray<UInt32>(componentPtr, 2); break;
+					case ComponentType::Float3:
+					case ComponentType::Int3:    SwapArray<UInt32>(componentPtr, 3); break;
+					case ComponentType::Color:
+					case ComponentType::Float4:
+					case ComponentType::Int4:    SwapArray<UInt32>(componentPtr, 4); break;
+					case ComponentType::Half2:
+					case ComponentType::SNorm16x2:
+					case ComponentType::UNorm16x2: SwapArray<UInt16>(componentPtr, 2); break;
+					case ComponentType::Half4:
+					case ComponentType::SNorm16x4:
+					case ComponentType::UNorm16x4: SwapArray<UInt16>(componentPtr, 4); break;
+					case ComponentType::SNorm8x4:
+					case ComponentType::UNorm8x4:  break;
+				}
+			}
+
+			ptr += stride;
+		}
+	}
+}
@@ -0,0 +1,44 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_UTILITY_FORMATS_NZMESHCONSTANTS_HPP
+#define NAZARA_UTILITY_FORMATS_NZMESHCONSTANTS_HPP
+
+#include <NazaraUtils/Prerequisites.hpp>
+#include <Nazara/Utility/Enums.hpp>
+
+/*
+ * .nzmesh layout (little endian, version 2):
+ *
+ * UInt32 magic, UInt32 version
+ * UInt8 animationType, UInt32 jointCount, UInt32 materialCount, UInt32 subMeshCount
+ * string animationPath
+ * materials: UInt32 parameterCount, then (string name, UInt8 type, value) for each parameter
+ * joints: string name, Int32 parent, Vector3f position, Quaternionf rotation, Vector3f scale, Matrix4f inverseBindMatrix
+ * submeshes:
+ *   UInt8 animationType, UInt8 primitiveMode, UInt32 materialIndex, Boxf aabb
+ *   UInt8 inputRate, UInt32 componentCount, then (Int8 component, UInt8 type, UInt32 componentIndex) for each component
+ *   UInt32 vertexCount, UInt8 indexType (NZMesh_NoIndices if none), UInt32 indexCount
+ *   vertex data then index data, each one starting on a NZMesh_DataAlignment boundary and laid out as the GPU expects them
+ *   UInt32 lodCount, then (float error, UInt32 indexCount, index data) for each level of detail, using the submesh index type
+ */
+
+namespace Nz
+{
+	class VertexDeclaration;
+
+	constexpr UInt32 NZMesh_Magic = 'N' << 0 | 'Z' << 8 | 'M' << 16 | 'H' << 24;
+	constexpr UInt32 NZMesh_Version = 2;
+
+	constexpr UInt64 NZMesh_DataAlignment = 16;
+	constexpr UInt8 NZMesh_NoIndices = 0xFF;
+
+	// Converts vertex/index data between little endian and the platform endianness
+	void NZMesh_SwapIndices(void* indices, IndexType indexType, UInt32 indexCount);
+	void NZMesh_SwapVertices(void* vertices, const VertexDeclaration& declaration, UInt32 vertexCount);
+}
+
+#endif // NAZARA_UTILITY_FORMATS_NZMESHCONSTANTS_HPP
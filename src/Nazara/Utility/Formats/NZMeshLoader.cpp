@@ -0,0 +1,512 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/Formats/NZMeshLoader.hpp>
+#include <Nazara/Core/Algorithm.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/SerializationContext.hpp>
+#include <Nazara/Core/Stream.hpp>
+#include <Nazara/Utility/IndexBuffer.hpp>
+#include <Nazara/Utility/Joint.hpp>
+#include <Nazara/Utility/Mesh.hpp>
+#include <Nazara/Utility/SkeletalMesh.hpp>
+#include <Nazara/Utility/StaticMesh.hpp>
+#include <Nazara/Utility/VertexBuffer.hpp>
+#include <Nazara/Utility/Formats/NZMeshConstants.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <vector>
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		bool IsNZMeshSupported(std::string_view extension)
+		{
+			return (extension == ".nzmesh");
+		}
+
+		UInt64 GetRemainingSize(const Stream& stream)
+		{
+			UInt64 size = stream.GetSize();
+			UInt64 cursorPos = stream.GetCursorPos();
+			return (size > cursorPos) ? size - cursorPos : 0;
+		}
+
+		bool ReadString(SerializationContext& context, std::string* str)
+		{
+			UInt32 size;
+			if (!Unserialize(context, &size))
+				return false;
+
+			// Don't allocate more than what the file can hold
+			if (size > GetRemainingSize(*context.stream))
+				return false;
+
+			str->resize(size);
+			return size == 0 || context.stream->Read(str->data(), size) == size;
+		}
+
+		// Returns a pointer to size bytes of data aligned on NZMesh_DataAlignment, in place if the stream is memory-mapped
+		const void* ReadData(Stream& stream, UInt64 size, std::vector<UInt8>& buffer)
+		{
+			UInt64 dataOffset = AlignPow2(stream.GetCursorPos(), NZMesh_DataAlignment);
+			if (dataOffset > stream.GetSize() || size > stream.GetSize() - dataOffset)
+				return nullptr;
+
+			if (!stream.SetCursorPos(dataOffset))
+				return nullptr;
+
+#ifndef NAZARA_BIG_ENDIAN
+			if (stream.IsMemoryMapped())
+			{
+				const UInt8* data = static_cast<const UInt8*>(stream.GetMappedPointer()) + dataOffset;
+				stream.SetCursorPos(dataOffset + size);
+
+				return data;
+			}
+#endif
+
+			buffer.resize(size);
+			if (stream.Read(buffer.data(), size) != size)
+				return nullptr;
+
+			return buffer.data();
+		}
+
+		bool ReadMaterial(SerializationContext& context, ParameterList& materialData)
+		{
+			UInt32 parameterCount;
+			if (!Unserialize(context, &parameterCount))
+				return false;
+
+			for (UInt32 i = 0; i < parameterCount; ++i)
+			{
+				std::string name;
+				UInt8 type;
+				if (!ReadString(context, &name) || !Unserialize(context, &type))
+					return false;
+
+				switch (static_cast<ParameterType>(type))
+				{
+					case ParameterType::Boolean:
+					{
+						UInt8 value;
+						if (!Unserialize(context, &value))
+							return false;
+
+						materialData.SetParameter(name, value != 0);
+						break;
+					}
+
+					case ParameterType::Color:
+					{
+						Color value;
+						if (!Unserialize(context, &value))
+							return false;
+
+						materialData.SetParameter(name, value);
+						break;
+					}
+
+					case ParameterType::Double:
+					{
+						double value;
+						if (!Unserialize(context, &value))
+							return false;
+
+						materialData.SetParameter(name, value);
+						break;
+					}
+
+					case ParameterType::Integer:
+					{
+						Int64 value;
+						if (!Unserialize(context, &value))
+							return false;
+
+						materialData.SetParameter(name, static_cast<long long>(value));
+						break;
+					}
+
+					case ParameterType::String:
+					{
+						std::string value;
+						if (!ReadString(context, &value))
+							return false;
+
+						materialData.SetParameter(name, value);
+						break;
+					}
+
+					case ParameterType::None:
+						materialData.SetParameter(name);
+						break;
+
+					default:
+						NazaraError("unexpected parameter type {0:#x}", type);
+						return false;
+				}
+			}
+
+			return true;
+		}
+
+		bool ReadJoints(SerializationContext& context, Skeleton& skeleton)
+		{
+			std::size_t jointCount = skeleton.GetJointCount();
+			for (std::size_t i = 0; i < jointCount; ++i)
+			{
+				std::string name;
+				Int32 parentIndex;
+				Vector3f position;
+				Quaternionf rotation;
+				Vector3f scale;
+				Matrix4f inverseBindMatrix;
+
+				if (!ReadString(context, &name) ||
+				    !Unserialize(context, &parentIndex) ||
+				    !Unserialize(context, &position) ||
+				    !Unserialize(context, &rotation) ||
+				    !Unserialize(context, &scale) ||
+				    !Unserialize(context, &inverseBindMatrix))
+					return false;
+
+				if (parentIndex >= 0 && static_cast<std::size_t>(parentIndex) >= jointCount)
+				{
+					NazaraError("joint #{0} has an invalid parent index ({1})", i, parentIndex);
+					return false;
+				}
+
+				Joint* joint = skeleton.GetJoint(i);
+				if (parentIndex >= 0)
+					joint->SetParent(skeleton.GetJoint(parentIndex));
+
+				joint->SetInverseBindMatrix(inverseBindMatrix);
+				joint->SetName(std::move(name));
+				joint->SetTransform(position, rotation, scale);
+			}
+
+			return true;
+		}
+
+		std::shared_ptr<const VertexDeclaration> ReadVertexDeclaration(SerializationContext& context)
+		{
+			UInt8 inputRate;
+			UInt32 componentCount;
+			if (!Unserialize(context, &inputRate) || !Unserialize(context, &componentCount))
+				return nullptr;
+
+			if (inputRate > UnderlyingCast(VertexInputRate::Vertex) || componentCount > GetRemainingSize(*context.stream))
+				return nullptr;
+
+			std::vector<VertexDeclaration::ComponentEntry> components(componentCount);
+			for (auto& entry : components)
+			{
+				Int8 component;
+				UInt8 type;
+				UInt32 componentIndex;
+				if (!Unserialize(context, &component) || !Unserialize(context, &type) || !Unserialize(context, &componentIndex))
+					return nullptr;
+
+				if (component < UnderlyingCast(VertexComponent::Unused) || component > UnderlyingCast(VertexComponent::Max) || type > UnderlyingCast(ComponentType::Max))
+					return nullptr;
+
+				if (componentIndex != 0 && component != UnderlyingCast(VertexComponent::Userdata))
+					return nullptr;
+
+				entry.component = static_cast<VertexComponent>(component);
+				entry.componentIndex = componentIndex;
+				entry.type = static_cast<ComponentType>(type);
+			}
+
+			// Share predefined declarations when possible
+			for (std::size_t i = 0; i < VertexLayoutCount; ++i)
+			{
+				const std::shared_ptr<VertexDeclaration>& declaration = VertexDeclaration::Get(static_cast<VertexLayout>(i));
+				if (UnderlyingCast(declaration->GetInputRate()) != inputRate || declaration->GetComponentCount() != componentCount)
+					continue;
+
+				bool isEqual = true;
+				for (std::size_t j = 0; j < componentCount; ++j)
+				{
+					const auto& component = declaration->GetComponent(j);
+					if (component.component != components[j].component || component.type != components[j].type || component.componentIndex != components[j].componentIndex)
+					{
+						isEqual = false;
+						break;
+					}
+				}
+
+				if (isEqual)
+					return declaration;
+			}
+
+			try
+			{
+				return std::make_shared<VertexDeclaration>(static_cast<VertexInputRate>(inputRate), components);
+			}
+			catch (const std::exception& e)
+			{
+				NazaraError("invalid vertex declaration: {0}", e.what());
+				return nullptr;
+			}
+		}
+
+		std::shared_ptr<SubMesh> ReadSubMesh(SerializationContext& context, const MeshParams& parameters, std::vector<UInt8>& buffer)
+		{
+			UInt8 animationType;
+			UInt8 primitiveMode;
+			UInt32 materialIndex;
+			Boxf aabb;
+
+			if (!Unserialize(context, &animationType) ||
+			    !Unserialize(context, &primitiveMode) ||
+			    !Unserialize(context, &materialIndex) ||
+			    !Unserialize(context, &aabb))
+				return nullptr;
+
+			if (animationType > UnderlyingCast(AnimationType::Max) || primitiveMode > UnderlyingCast(PrimitiveMode::Max))
+				return nullptr;
+
+			std::shared_ptr<const VertexDeclaration> vertexDeclaration = ReadVertexDeclaration(context);
+			if (!vertexDeclaration)
+				return nullptr;
+
+			UInt32 vertexCount;
+			UInt8 indexType;
+			UInt32 indexCount;
+			if (!Unserialize(context, &vertexCount) || !Unserialize(context, &indexType) || !Unserialize(context, &indexCount))
+				return nullptr;
+
+			if (indexType != NZMesh_NoIndices && indexType > UnderlyingCast(IndexType::Max))
+				return nullptr;
+
+			Stream& stream = *context.stream;
+
+			// Vertex and index data are stored as the GPU expects them, give them directly to the buffer factory
+			const void* vertexData = nullptr;
+			if (vertexCount > 0)
+			{
+				vertexData = ReadData(stream, UInt64(vertexCount) * vertexDeclaration->GetStride(), buffer);
+				if (!vertexData)
+					return nullptr;
+
+#ifdef NAZARA_BIG_ENDIAN
+				NZMesh_SwapVertices(buffer.data(), *vertexDeclaration, vertexCount);
+#endif
+			}
+
+			std::shared_ptr<VertexBuffer> vertexBuffer = std::make_shared<VertexBuffer>(vertexDeclaration, vertexCount, parameters.vertexBufferFlags, parameters.bufferFactory, vertexData);
+
+			auto ReadIndexBuffer = [&](IndexType type, UInt32 count) -> std::shared_ptr<IndexBuffer>
+			{
+				const void* indexData = nullptr;
+				if (count > 0)
+				{
+					UInt64 indexStride = (type == IndexType::U8) ? 1 : (type == IndexType::U16) ? 2 : 4;
+					indexData = ReadData(stream, UInt64(count) * indexStride, buffer);
+					if (!indexData)
+						return nullptr;
+
+#ifdef NAZARA_BIG_ENDIAN
+					NZMesh_SwapIndices(buffer.data(), type, count);
+#endif
+				}
+
+				return std::make_shared<IndexBuffer>(type, count, parameters.indexBufferFlags, parameters.bufferFactory, indexData);
+			};
+
+			std::shared_ptr<IndexBuffer> indexBuffer;
+			if (indexType != NZMesh_NoIndices)
+			{
+				indexBuffer = ReadIndexBuffer(static_cast<IndexType>(indexType), indexCount);
+				if (!indexBuffer)
+					return nullptr;
+			}
+
+			UInt32 lodCount;
+			if (!Unserialize(context, &lodCount))
+				return nullptr;
+
+			if (lodCount > 0 && indexType == NZMesh_NoIndices)
+				return nullptr;
+
+			std::vector<std::pair<std::shared_ptr<IndexBuffer>, float>> levelsOfDetail;
+			for (UInt32 i = 0; i < lodCount; ++i)
+			{
+				float lodError;
+				UInt32 lodIndexCount;
+				if (!Unserialize(context, &lodError) || !Unserialize(context, &lodIndexCount))
+					return nullptr;
+
+				// Levels of detail are stored from the most detailed to the least detailed
+				if (!levelsOfDetail.empty() && lodError < levelsOfDetail.back().second)
+					return nullptr;
+
+				std::shared_ptr<IndexBuffer> lodIndexBuffer = ReadIndexBuffer(static_cast<IndexType>(indexType), lodIndexCount);
+				if (!lodIndexBuffer)
+					return nullptr;
+
+				levelsOfDetail.emplace_back(std::move(lodIndexBuffer), lodError);
+			}
+
+			std::shared_ptr<SubMesh> subMesh;
+			if (static_cast<AnimationType>(animationType) == AnimationType::Skeletal)
+			{
+				std::shared_ptr<SkeletalMesh> skeletalMesh = std::make_shared<SkeletalMesh>(std::move(vertexBuffer), std::move(indexBuffer));
+				skeletalMesh->SetAABB(aabb);
+
+				subMesh = std::move(skeletalMesh);
+			}
+			else
+			{
+				std::shared_ptr<StaticMesh> staticMesh = std::make_shared<StaticMesh>(std::move(vertexBuffer), std::move(indexBuffer));
+				staticMesh->SetAABB(aabb);
+
+				subMesh = std::move(staticMesh);
+			}
+
+			subMesh->SetMaterialIndex(materialIndex);
+			subMesh->SetPrimitiveMode(static_cast<PrimitiveMode>(primitiveMode));
+
+			for (auto& [lodIndexBuffer, lodError] : levelsOfDetail)
+				subMesh->AddLOD(std::move(lodIndexBuffer), lodError);
+
+			return subMesh;
+		}
+
+		Result<std::shared_ptr<Mesh>, ResourceLoadingError> LoadNZMesh(Stream& stream, const MeshParams& parameters)
+		{
+			SerializationContext context;
+			context.endianness = Endianness::LittleEndian;
+			context.stream = &stream;
+
+			UInt32 magic;
+			if (!Unserialize(context, &magic) || magic != NZMesh_Magic)
+				return Err(ResourceLoadingError::Unrecognized);
+
+			UInt32 version;
+			if (!Unserialize(context, &version))
+				return Err(ResourceLoadingError::DecodingError);
+
+			if (version != NZMesh_Version)
+			{
+				NazaraError("unsupported nzmesh version {0}", version);
+				return Err(ResourceLoadingError::Unsupported);
+			}
+
+			UInt8 animationType;
+			UInt32 jointCount;
+			UInt32 materialCount;
+			UInt32 subMeshCount;
+			std::string animationPath;
+
+			if (!Unserialize(context, &animationType) ||
+			    !Unserialize(context, &jointCount) ||
+			    !Unserialize(context, &materialCount) ||
+			    !Unserialize(context, &subMeshCount) ||
+			    !ReadString(context, &animationPath))
+			{
+				NazaraError("failed to read header");
+				return Err(ResourceLoadingError::DecodingError);
+			}
+
+			if (animationType > UnderlyingCast(AnimationType::Max) || materialCount > GetRemainingSize(stream) || subMeshCount > GetRemainingSize(stream))
+			{
+				NazaraError("ill-formed nzmesh header");
+				return Err(ResourceLoadingError::DecodingError);
+			}
+
+			bool isSkeletal = (static_cast<AnimationType>(animationType) == AnimationType::Skeletal);
+			if (isSkeletal && !parameters.animated)
+			{
+				// Skinning data is baked into the vertices, we can't generate a static version of the mesh here
+				NazaraError("skeletal nzmesh cannot be loaded as a static mesh");
+				return Err(ResourceLoadingError::Unsupported);
+			}
+
+			std::shared_ptr<Mesh> mesh = std::make_shared<Mesh>();
+			if (isSkeletal)
+			{
+				if (jointCount > GetRemainingSize(stream) || !mesh->CreateSkeletal(jointCount))
+				{
+					NazaraError("failed to create skeletal mesh");
+					return Err(ResourceLoadingError::DecodingError);
+				}
+			}
+			else
+			{
+				if (!mesh->CreateStatic())
+				{
+					NazaraInternalError("Failed to create mesh");
+					return Err(ResourceLoadingError::Internal);
+				}
+			}
+
+			if (!animationPath.empty())
+				mesh->SetAnimation(Utf8Path(animationPath));
+
+			mesh->SetMaterialCount(std::max<UInt32>(materialCount, 1));
+			for (UInt32 i = 0; i < materialCount; ++i)
+			{
+				ParameterList materialData;
+				if (!ReadMaterial(context, materialData))
+				{
+					NazaraError("failed to read material #{0}", i);
+					return Err(ResourceLoadingError::DecodingError);
+				}
+
+				mesh->SetMaterialData(i, std::move(materialData));
+			}
+
+			if (isSkeletal && !ReadJoints(context, *mesh->GetSkeleton()))
+			{
+				NazaraError("failed to read skeleton");
+				return Err(ResourceLoadingError::DecodingError);
+			}
+
+			std::vector<UInt8> buffer;
+			for (UInt32 i = 0; i < subMeshCount; ++i)
+			{
+				std::shared_ptr<SubMesh> subMesh = ReadSubMesh(context, parameters, buffer);
+				if (!subMesh)
+				{
+					NazaraError("failed to read submesh #{0}", i);
+					return Err(ResourceLoadingError::DecodingError);
+				}
+
+				if (subMesh->GetAnimationType() != mesh->GetAnimationType())
+				{
+					NazaraError("submesh #{0} animation type doesn't match the mesh one", i);
+					return Err(ResourceLoadingError::DecodingError);
+				}
+
+				if (subMesh->GetMaterialIndex() >= mesh->GetMaterialCount())
+				{
+					NazaraError("submesh #{0} has an invalid material index", i);
+					return Err(ResourceLoadingError::DecodingError);
+				}
+
+				mesh->AddSubMesh(std::move(subMesh));
+			}
+
+			return mesh;
+		}
+	}
+
+	namespace Loaders
+	{
+		MeshLoader::Entry GetMeshLoader_NZMesh()
+		{
+			NAZARA_USE_ANONYMOUS_NAMESPACE
+
+			MeshLoader::Entry loader;
+			loader.extensionSupport = IsNZMeshSupported;
+			loader.streamLoader = LoadNZMesh;
+
+			return loader;
+		}
+	}
+}
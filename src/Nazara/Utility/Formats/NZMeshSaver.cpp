@@ -0,0 +1,315 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/Formats/NZMeshSaver.hpp>
+#include <Nazara/Core/Algorithm.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/SerializationContext.hpp>
+#include <Nazara/Core/Stream.hpp>
+#include <Nazara/Utility/BufferMapper.hpp>
+#include <Nazara/Utility/IndexBuffer.hpp>
+#include <Nazara/Utility/Joint.hpp>
+#include <Nazara/Utility/Mesh.hpp>
+#include <Nazara/Utility/SkeletalMesh.hpp>
+#include <Nazara/Utility/StaticMesh.hpp>
+#include <Nazara/Utility/VertexBuffer.hpp>
+#include <Nazara/Utility/Formats/NZMeshConstants.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <array>
+#include <cstring>
+#include <vector>
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		bool IsNZMeshSupportedSave(std::string_view extension)
+		{
+			return (extension == ".nzmesh");
+		}
+
+		bool WriteData(SerializationContext& context, const void* data, UInt64 size)
+		{
+			constexpr std::array<UInt8, NZMesh_DataAlignment> padding = {};
+
+			UInt64 cursorPos = context.stream->GetCursorPos();
+			UInt64 paddingSize = AlignPow2(cursorPos, NZMesh_DataAlignment) - cursorPos;
+			if (paddingSize > 0 && context.stream->Write(padding.data(), paddingSize) != paddingSize)
+				return false;
+
+			return context.stream->Write(data, size) == size;
+		}
+
+		bool WriteMaterial(SerializationContext& context, const ParameterList& materialData)
+		{
+			// Pointers and userdata cannot be stored
+			std::vector<std::pair<const std::string*, ParameterType>> parameters;
+			materialData.ForEach([&](const ParameterList& list, const std::string& name)
+			{
+				ParameterType type = list.GetParameterType(name).GetValue();
+				if (type != ParameterType::Pointer && type != ParameterType::Userdata)
+					parameters.emplace_back(&name, type);
+			});
+
+			if (!Serialize(context, SafeCast<UInt32>(parameters.size())))
+				return false;
+
+			for (auto&& [namePtr, type] : parameters)
+			{
+				const std::string& name = *namePtr;
+				if (!Serialize(context, name) || !Serialize(context, UInt8(UnderlyingCast(type))))
+					return false;
+
+				bool succeeded;
+				switch (type)
+				{
+					case ParameterType::Boolean:
+						succeeded = Serialize(context, UInt8((materialData.GetBooleanParameter(name).GetValue()) ? 1 : 0));
+						break;
+
+					case ParameterType::Color:
+						succeeded = Serialize(context, materialData.GetColorParameter(name).GetValue());
+						break;
+
+					case ParameterType::Double:
+						succeeded = Serialize(context, materialData.GetDoubleParameter(name).GetValue());
+						break;
+
+					case ParameterType::Integer:
+						succeeded = Serialize(context, Int64(materialData.GetIntegerParameter(name).GetValue()));
+						break;
+
+					case ParameterType::String:
+						succeeded = Serialize(context, materialData.GetStringParameter(name).GetValue());
+						break;
+
+					case ParameterType::None:
+						succeeded = true;
+						break;
+
+					default:
+						NazaraInternalError("unexpected parameter type {0:#x}", UnderlyingCast(type));
+						return false;
+				}
+
+				if (!succeeded)
+					return false;
+			}
+
+			return true;
+		}
+
+		bool WriteJoint(SerializationContext& context, const Skeleton& skeleton, const Joint& joint)
+		{
+			Int32 parentIndex = -1;
+			if (const Node* parent = joint.GetParent())
+			{
+				const Joint* joints = skeleton.GetJoints();
+				for (std::size_t i = 0; i < skeleton.GetJointCount(); ++i)
+				{
+					if (&joints[i] == parent)
+					{
+						parentIndex = SafeCast<Int32>(i);
+						break;
+					}
+				}
+			}
+
+			return Serialize(context, joint.GetName()) &&
+			       Serialize(context, parentIndex) &&
+			       Serialize(context, joint.GetPosition()) &&
+			       Serialize(context, joint.GetRotation()) &&
+			       Serialize(context, joint.GetScale()) &&
+			       Serialize(context, joint.GetInverseBindMatrix());
+		}
+
+		bool WriteSubMesh(SerializationContext& context, const SubMesh& subMesh)
+		{
+			const std::shared_ptr<VertexBuffer>* vertexBuffer;
+			if (subMesh.GetAnimationType() == AnimationType::Skeletal)
+				vertexBuffer = &static_cast<const SkeletalMesh&>(subMesh).GetVertexBuffer();
+			else
+				vertexBuffer = &static_cast<const StaticMesh&>(subMesh).GetVertexBuffer();
+
+			const VertexDeclaration& vertexDeclaration = *(*vertexBuffer)->GetVertexDeclaration();
+			const std::shared_ptr<IndexBuffer>& indexBuffer = subMesh.GetIndexBuffer();
+
+			if (!Serialize(context, UInt8(UnderlyingCast(subMesh.GetAnimationType()))) ||
+			    !Serialize(context, UInt8(UnderlyingCast(subMesh.GetPrimitiveMode()))) ||
+			    !Serialize(context, SafeCast<UInt32>(subMesh.GetMaterialIndex())) ||
+			    !Serialize(context, subMesh.GetAABB()))
+				return false;
+
+			if (!Serialize(context, UInt8(UnderlyingCast(vertexDeclaration.GetInputRate()))) ||
+			    !Serialize(context, SafeCast<UInt32>(vertexDeclaration.GetComponentCount())))
+				return false;
+
+			for (const auto& component : vertexDeclaration.GetComponents())
+			{
+				if (!Serialize(context, Int8(UnderlyingCast(component.component))) ||
+				    !Serialize(context, UInt8(UnderlyingCast(component.type))) ||
+				    !Serialize(context, SafeCast<UInt32>(component.componentIndex)))
+					return false;
+			}
+
+			UInt32 vertexCount = (*vertexBuffer)->GetVertexCount();
+			UInt32 indexCount = (indexBuffer) ? indexBuffer->GetIndexCount() : 0;
+			UInt8 indexType = (indexBuffer) ? UInt8(UnderlyingCast(indexBuffer->GetIndexType())) : NZMesh_NoIndices;
+
+			if (!Serialize(context, vertexCount) || !Serialize(context, indexType) || !Serialize(context, indexCount))
+				return false;
+
+			if (vertexCount > 0)
+			{
+				BufferMapper<VertexBuffer> vertexMapper(**vertexBuffer, 0, vertexCount);
+				if (!vertexMapper.GetPointer())
+				{
+					NazaraError("failed to map vertex buffer");
+					return false;
+				}
+
+				UInt64 dataSize = vertexCount * (*vertexBuffer)->GetStride();
+#ifdef NAZARA_BIG_ENDIAN
+				std::vector<UInt8> vertexData(dataSize);
+				std::memcpy(vertexData.data(), vertexMapper.GetPointer(), dataSize);
+				NZMesh_SwapVertices(vertexData.data(), vertexDeclaration, vertexCount);
+
+				if (!WriteData(context, vertexData.data(), dataSize))
+					return false;
+#else
+				if (!WriteData(context, vertexMapper.GetPointer(), dataSize))
+					return false;
+#endif
+			}
+
+			auto WriteIndices = [&](IndexBuffer& buffer) -> bool
+			{
+				UInt32 count = buffer.GetIndexCount();
+				if (count == 0)
+					return true;
+
+				BufferMapper<IndexBuffer> indexMapper(buffer, 0, count);
+				if (!indexMapper.GetPointer())
+				{
+					NazaraError("failed to map index buffer");
+					return false;
+				}
+
+				UInt64 dataSize = count * buffer.GetStride();
+#ifdef NAZARA_BIG_ENDIAN
+				std::vector<UInt8> indexData(dataSize);
+				std::memcpy(indexData.data(), indexMapper.GetPointer(), dataSize);
+				NZMesh_SwapIndices(indexData.data(), buffer.GetIndexType(), count);
+
+				return WriteData(context, indexData.data(), dataSize);
+#else
+				return WriteData(context, indexMapper.GetPointer(), dataSize);
+#endif
+			};
+
+			if (indexBuffer && !WriteIndices(*indexBuffer))
+				return false;
+
+			// Levels of detail share the submesh vertices
+			UInt32 lodCount = (indexBuffer) ? SafeCast<UInt32>(subMesh.GetLODCount() - 1) : 0;
+			if (!Serialize(context, lodCount))
+				return false;
+
+			for (UInt32 i = 1; i <= lodCount; ++i)
+			{
+				IndexBuffer& lodIndexBuffer = *subMesh.GetLODIndexBuffer(i);
+				if (lodIndexBuffer.GetIndexType() != indexBuffer->GetIndexType())
+				{
+					NazaraError("levels of detail must use the submesh index type");
+					return false;
+				}
+
+				if (!Serialize(context, subMesh.GetLODError(i)) || !Serialize(context, lodIndexBuffer.GetIndexCount()) || !WriteIndices(lodIndexBuffer))
+					return false;
+			}
+
+			return true;
+		}
+
+		bool SaveNZMeshToStream(const Mesh& mesh, const std::string& format, Stream& stream, const MeshParams& parameters)
+		{
+			NAZARA_USE_ANONYMOUS_NAMESPACE
+
+			NazaraUnused(format);
+			NazaraUnused(parameters);
+
+			if (!mesh.IsValid())
+			{
+				NazaraError("invalid mesh");
+				return false;
+			}
+
+			SerializationContext context;
+			context.endianness = Endianness::LittleEndian;
+			context.stream = &stream;
+
+			std::size_t jointCount = (mesh.IsAnimable()) ? mesh.GetJointCount() : 0;
+
+			if (!Serialize(context, NZMesh_Magic) ||
+			    !Serialize(context, NZMesh_Version) ||
+			    !Serialize(context, UInt8(UnderlyingCast(mesh.GetAnimationType()))) ||
+			    !Serialize(context, SafeCast<UInt32>(jointCount)) ||
+			    !Serialize(context, SafeCast<UInt32>(mesh.GetMaterialCount())) ||
+			    !Serialize(context, SafeCast<UInt32>(mesh.GetSubMeshCount())) ||
+			    !Serialize(context, mesh.GetAnimation().generic_u8string()))
+			{
+				NazaraError("failed to write header");
+				return false;
+			}
+
+			for (std::size_t i = 0; i < mesh.GetMaterialCount(); ++i)
+			{
+				if (!WriteMaterial(context, mesh.GetMaterialData(i)))
+				{
+					NazaraError("failed to write material #{0}", i);
+					return false;
+				}
+			}
+
+			if (jointCount > 0)
+			{
+				const Skeleton& skeleton = *mesh.GetSkeleton();
+				for (std::size_t i = 0; i < jointCount; ++i)
+				{
+					if (!WriteJoint(context, skeleton, *skeleton.GetJoint(i)))
+					{
+						NazaraError("failed to write joint #{0}", i);
+						return false;
+					}
+				}
+			}
+
+			for (std::size_t i = 0; i < mesh.GetSubMeshCount(); ++i)
+			{
+				if (!WriteSubMesh(context, *mesh.GetSubMesh(i)))
+				{
+					NazaraError("failed to write submesh #{0}", i);
+					return false;
+				}
+			}
+
+			return true;
+		}
+	}
+
+	namespace Loaders
+	{
+		MeshSaver::Entry GetMeshSaver_NZMesh()
+		{
+			NAZARA_USE_ANONYMOUS_NAMESPACE
+
+			MeshSaver::Entry entry;
+			entry.formatSupport = IsNZMeshSupportedSave;
+			entry.streamSaver = SaveNZMeshToStream;
+
+			return entry;
+		}
+	}
+}
@@ -334,9 +334,18 @@ namespace Nz
 			}
 			mesh->SetMaterialCount(parser.GetMaterialCount());
 
+			if (parameters.optimizeMesh)
+				mesh->Optimize(parameters);
+
+			if (parameters.lodCount > 0)
+				mesh->GenerateLODs(parameters);
+
 			if (parameters.center)
 				mesh->Recenter();
 
+			if (parameters.compressVertices)
+				mesh->CompressVertices(parameters);
+
 			// On charge les matériaux si demandé
 			std::filesystem::path mtlLib = parser.GetMtlLib();
 			if (!mtlLib.empty())
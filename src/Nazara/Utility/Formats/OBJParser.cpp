@@ -7,13 +7,84 @@
 #include <Nazara/Utility/Config.hpp>
 #include <NazaraUtils/CallOnExit.hpp>
 #include <tsl/ordered_map.h>
+#include <algorithm>
+#include <array>
 #include <cctype>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <unordered_map>
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
 {
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		bool IsBlank(char c)
+		{
+			return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+		}
+
+		const char* SkipBlanks(const char* ptr, const char* end)
+		{
+			while (ptr != end && IsBlank(*ptr))
+				++ptr;
+
+			return ptr;
+		}
+
+		// Parses an integer the way %d does (skipping leading blanks and accepting a sign)
+		bool ParseInteger(const char*& ptr, const char* end, int& value)
+		{
+			ptr = SkipBlanks(ptr, end);
+			if (ptr != end && *ptr == '+')
+				++ptr;
+
+			auto [numberEnd, ec] = std::from_chars(ptr, end, value);
+			if (ec != std::errc())
+				return false;
+
+			ptr = numberEnd;
+			return true;
+		}
+
+		// Parses up to valueCount blank-separated floats the way %f does, returns the number of parsed values
+		std::size_t ParseFloats(const char* ptr, const char* end, float* values, std::size_t valueCount)
+		{
+			for (std::size_t i = 0; i < valueCount; ++i)
+			{
+				ptr = SkipBlanks(ptr, end);
+				if (ptr != end && *ptr == '+')
+					++ptr;
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+				auto [numberEnd, ec] = std::from_chars(ptr, end, values[i]);
+				if (ec != std::errc())
+					return i;
+
+				ptr = numberEnd;
+#else
+				// Floating-point std::from_chars is not available, fallback on strtof (which requires a null-terminated string)
+				char buffer[64];
+				std::size_t length = std::min<std::size_t>(end - ptr, sizeof(buffer) - 1);
+				std::memcpy(buffer, ptr, length);
+				buffer[length] = '\0';
+
+				char* numberEnd;
+				values[i] = std::strtof(buffer, &numberEnd);
+				if (numberEnd == buffer)
+					return i;
+
+				ptr += numberEnd - buffer;
+#endif
+			}
+
+			return valueCount;
+		}
+	}
+
 	bool OBJParser::Check(Stream& stream)
 	{
 		m_currentStream = &stream;
@@ -87,21 +158,51 @@ namespace Nz
 
 	bool OBJParser::Parse(Nz::Stream& stream, std::size_t reservedVertexCount)
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
 		m_currentStream = &stream;
 		m_errorCount = 0;
 		m_keepLastLine = false;
 		m_lineCount = 0;
 
-		// force stream in text mode, reset it at the end
-		CallOnExit resetTextMode([&stream]
+		// Parse the whole content in place if the stream is memory-mapped, or read it at once otherwise
+		const char* data;
+		std::size_t dataSize;
+		std::vector<char> readBuffer;
+		if (stream.IsMemoryMapped())
 		{
-			stream.EnableTextMode(false);
-		});
+			UInt64 streamPos = stream.GetCursorPos();
+			UInt64 remainingSize = stream.GetSize() - streamPos;
+			if (remainingSize > std::numeric_limits<std::size_t>::max())
+			{
+				NazaraError("OBJ file is too big");
+				return false;
+			}
 
-		if ((stream.GetStreamOptions() & StreamOption::Text) == 0)
-			stream.EnableTextMode(true);
+			data = static_cast<const char*>(stream.GetMappedPointer()) + streamPos;
+			dataSize = static_cast<std::size_t>(remainingSize);
+			stream.SetCursorPos(streamPos + remainingSize);
+		}
 		else
-			resetTextMode.Reset();
+		{
+			constexpr std::size_t ReadChunkSize = 64 * 1024;
+
+			if (!stream.IsSequential())
+				readBuffer.reserve(static_cast<std::size_t>(stream.GetSize() - stream.GetCursorPos()));
+
+			std::size_t readSize;
+			do
+			{
+				std::size_t offset = readBuffer.size();
+				readBuffer.resize(offset + ReadChunkSize);
+				readSize = stream.Read(&readBuffer[offset], ReadChunkSize);
+				readBuffer.resize(offset + readSize);
+			}
+			while (readSize == ReadChunkSize);
+
+			data = readBuffer.data();
+			dataSize = readBuffer.size();
+		}
 
 		std::string matName, meshName;
 		matName = meshName = "default";
@@ -141,32 +242,68 @@ namespace Nz
 			return &meshData;
 		};
 
+		// Some softwares write comments to gives the number of vertex/faces an importer can expect
+		auto ParseCountHint = [](std::string_view comment, std::string_view prefix, UInt32& count)
+		{
+			if (!StartsWith(comment, prefix))
+				return false;
+
+			comment = TrimLeft(comment.substr(prefix.size()));
+			return std::from_chars(comment.data(), comment.data() + comment.size(), count).ec == std::errc();
+		};
+
 		// On prépare le mesh par défaut
 		Mesh* currentMesh = nullptr;
 
-		while (Advance(false))
+		const char* dataPtr = data;
+		const char* dataEnd = data + dataSize;
+		while (dataPtr < dataEnd)
 		{
-			switch (std::tolower(m_currentLine[0]))
+			const char* lineEnd = static_cast<const char*>(std::memchr(dataPtr, '\n', dataEnd - dataPtr));
+			if (!lineEnd)
+				lineEnd = dataEnd;
+
+			std::string_view line(dataPtr, lineEnd - dataPtr);
+			dataPtr = (lineEnd < dataEnd) ? lineEnd + 1 : dataEnd;
+
+			m_lineCount++;
+
+			if (std::size_t p = line.find('#'); p != line.npos)
 			{
-				case '#': //< Comment
-					// Some softwares write comments to gives the number of vertex/faces an importer can expect
-					unsigned int data;
-					if (std::sscanf(m_currentLine.data(), "# position count: %u", &data) == 1)
-						m_positions.reserve(data);
-					else if (std::sscanf(m_currentLine.data(), "# normal count: %u", &data) == 1)
-						m_normals.reserve(data);
-					else if (std::sscanf(m_currentLine.data(), "# texcoords count: %u", &data) == 1)
-						m_texCoords.reserve(data);
-					else if (std::sscanf(m_currentLine.data(), "# face count: %u", &data) == 1)
-						faceReserve = data;
-					else if (std::sscanf(m_currentLine.data(), "# vertex count: %u", &data) == 1)
-						vertexReserve = data;
+				if (p == 0)
+				{
+					UInt32 count;
+					if (ParseCountHint(line, "# position count:", count))
+						m_positions.reserve(count);
+					else if (ParseCountHint(line, "# normal count:", count))
+						m_normals.reserve(count);
+					else if (ParseCountHint(line, "# texcoords count:", count))
+						m_texCoords.reserve(count);
+					else if (ParseCountHint(line, "# face count:", count))
+						faceReserve = count;
+					else if (ParseCountHint(line, "# vertex count:", count))
+						vertexReserve = count;
 
-					break;
+					continue;
+				}
+
+				line = line.substr(0, p);
+			}
+
+			line = Trim(line);
+			if (line.empty())
+				continue;
 
+			m_currentLine = line;
+
+			const char* linePtr = line.data();
+			const char* lineLast = line.data() + line.size();
+
+			switch (std::tolower(line[0]))
+			{
 				case 'f': //< Face
 				{
-					if (m_currentLine.size() < 7) // Since we only treat triangles, this is the minimum length of a face line (f 1 2 3)
+					if (line.size() < 7) // Since we only treat triangles, this is the minimum length of a face line (f 1 2 3)
 					{
 						#if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
 						if (!UnrecognizedLine())
@@ -175,7 +312,13 @@ namespace Nz
 						break;
 					}
 
-					std::size_t vertexCount = std::count(m_currentLine.begin(), m_currentLine.end(), ' ');
+					std::size_t vertexCount = 0;
+					for (std::size_t i = 1; i < line.size(); ++i)
+					{
+						if (IsBlank(line[i - 1]) && !IsBlank(line[i]))
+							vertexCount++;
+					}
+
 					if (vertexCount < 3)
 					{
 						#if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
@@ -195,33 +338,44 @@ namespace Nz
 					currentMesh->vertices.resize(face.firstVertex + vertexCount, FaceVertex{0, 0, 0});
 
 					bool error = false;
-					unsigned int pos = 2;
-					for (unsigned int i = 0; i < vertexCount; ++i)
+					linePtr += 2;
+					for (std::size_t i = 0; i < vertexCount; ++i)
 					{
-						int offset;
 						int n = 0;
 						int p = 0;
 						int t = 0;
 
-						if (std::sscanf(&m_currentLine[pos], "%d/%d/%d%n", &p, &t, &n, &offset) != 3)
+						// p, p/t, p//n or p/t/n
+						bool valid = ParseInteger(linePtr, lineLast, p);
+						if (valid && linePtr != lineLast && *linePtr == '/')
 						{
-							if (std::sscanf(&m_currentLine[pos], "%d//%d%n", &p, &n, &offset) != 2)
+							++linePtr;
+							if (linePtr != lineLast && *linePtr == '/')
+							{
+								++linePtr;
+								valid = ParseInteger(linePtr, lineLast, n);
+							}
+							else
 							{
-								if (std::sscanf(&m_currentLine[pos], "%d/%d%n", &p, &t, &offset) != 2)
+								valid = ParseInteger(linePtr, lineLast, t);
+								if (valid && linePtr != lineLast && *linePtr == '/')
 								{
-									if (std::sscanf(&m_currentLine[pos], "%d%n", &p, &offset) != 1)
-									{
-										#if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
-										if (!UnrecognizedLine())
-											return false;
-										#endif
-										error = true;
-										break;
-									}
+									++linePtr;
+									valid = ParseInteger(linePtr, lineLast, n);
 								}
 							}
 						}
 
+						if (!valid || (linePtr != lineLast && !IsBlank(*linePtr)))
+						{
+							#if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
+							if (!UnrecognizedLine())
+								return false;
+							#endif
+							error = true;
+							break;
+						}
+
 						if (p < 0)
 						{
 							p += static_cast<int>(m_positions.size());
@@ -283,8 +437,6 @@ namespace Nz
 						currentMesh->vertices[face.firstVertex + i].normal = static_cast<UInt32>(n);
 						currentMesh->vertices[face.firstVertex + i].position = static_cast<UInt32>(p);
 						currentMesh->vertices[face.firstVertex + i].texCoord = static_cast<UInt32>(t);
-
-						pos += offset;
 					}
 
 					if (!error)
@@ -297,8 +449,8 @@ namespace Nz
 
 				case 'm': //< MTLLib
 				{
-					const char prefix[] = "mtllib ";
-					if (!StartsWith(m_currentLine, prefix))
+					constexpr std::string_view prefix = "mtllib ";
+					if (!StartsWith(line, prefix))
 					{
 #if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
 						if (!UnrecognizedLine())
@@ -308,14 +460,14 @@ namespace Nz
 						break;
 					}
 
-					m_mtlLib = m_currentLine.substr(sizeof(prefix) - 1);
+					m_mtlLib = std::string(line.substr(prefix.size()));
 					break;
 				}
 
 				case 'g': //< Group (inside a mesh)
 				case 'o': //< Object (defines a mesh)
 				{
-					if (m_currentLine.size() <= 2 || m_currentLine[1] != ' ')
+					if (line.size() <= 2 || line[1] != ' ')
 					{
 #if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
 						if (!UnrecognizedLine())
@@ -324,7 +476,7 @@ namespace Nz
 						break;
 					}
 
-					std::string objectName = m_currentLine.substr(2);
+					std::string_view objectName = line.substr(2);
 					if (objectName.empty())
 					{
 						#if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
@@ -341,9 +493,9 @@ namespace Nz
 
 #if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
 				case 's': //< Smooth
-					if (m_currentLine.size() <= 2 || m_currentLine[1] == ' ')
+					if (line.size() <= 2 || line[1] == ' ')
 					{
-						std::string param = m_currentLine.substr(2);
+						std::string_view param = line.substr(2);
 						if (param != "all" && param != "on" && param != "off" && !IsNumber(param))
 						{
 							if (!UnrecognizedLine())
@@ -357,8 +509,8 @@ namespace Nz
 
 				case 'u': //< Usemtl
 				{
-					const char prefix[] = "usemtl ";
-					if (!StartsWith(m_currentLine, prefix))
+					constexpr std::string_view prefix = "usemtl ";
+					if (!StartsWith(line, prefix))
 					{
 #if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
 						if (!UnrecognizedLine())
@@ -368,7 +520,7 @@ namespace Nz
 						break;
 					}
 
-					std::string newMatName = m_currentLine.substr(sizeof(prefix) - 1);
+					std::string_view newMatName = line.substr(prefix.size());
 					if (newMatName.empty())
 					{
 #if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
@@ -378,14 +530,14 @@ namespace Nz
 						break;
 					}
 
-					matName = std::move(newMatName);
+					matName = newMatName;
 					currentMesh = nullptr;
 					break;
 				}
 
 				case 'v': //< Position/Normal/Texcoords
 				{
-					if (m_currentLine.size() < 7)
+					if (line.size() < 7)
 					{
 #if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
 						if (!UnrecognizedLine())
@@ -394,34 +546,34 @@ namespace Nz
 						break;
 					}
 
-					if (std::isspace(m_currentLine[1]))
+					if (std::isspace(line[1]))
 					{
-						Vector4f vertex(Vector3f::Zero(), 1.f);
-						unsigned int paramCount = std::sscanf(&m_currentLine[2], " %f %f %f %f", &vertex.x, &vertex.y, &vertex.z, &vertex.w);
+						std::array<float, 4> values = { 0.f, 0.f, 0.f, 1.f };
+						std::size_t paramCount = ParseFloats(linePtr + 2, lineLast, values.data(), values.size());
 						if (paramCount >= 1)
-							m_positions.push_back(vertex);
+							m_positions.emplace_back(values[0], values[1], values[2], values[3]);
 						#if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
 						else if (!UnrecognizedLine())
 							return false;
 						#endif
 					}
-					else if (m_currentLine[1] == 'n' && std::isspace(m_currentLine[2]))
+					else if (line[1] == 'n' && std::isspace(line[2]))
 					{
-						Vector3f normal(Vector3f::Zero());
-						unsigned int paramCount = std::sscanf(&m_currentLine[3], " %f %f %f", &normal.x, &normal.y, &normal.z);
+						std::array<float, 3> values = { 0.f, 0.f, 0.f };
+						std::size_t paramCount = ParseFloats(linePtr + 3, lineLast, values.data(), values.size());
 						if (paramCount == 3)
-							m_normals.push_back(normal);
+							m_normals.emplace_back(values[0], values[1], values[2]);
 						#if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
 						else if (!UnrecognizedLine())
 							return false;
 						#endif
 					}
-					else if (m_currentLine[1] == 't' && std::isspace(m_currentLine[2]))
+					else if (line[1] == 't' && std::isspace(line[2]))
 					{
-						Vector3f uvw(Vector3f::Zero());
-						unsigned int paramCount = std::sscanf(&m_currentLine[3], " %f %f %f", &uvw.x, &uvw.y, &uvw.z);
+						std::array<float, 3> values = { 0.f, 0.f, 0.f };
+						std::size_t paramCount = ParseFloats(linePtr + 3, lineLast, values.data(), values.size());
 						if (paramCount >= 2)
-							m_texCoords.push_back(uvw);
+							m_texCoords.emplace_back(values[0], values[1], values[2]);
 						#if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
 						else if (!UnrecognizedLine())
 							return false;
@@ -647,16 +799,13 @@ namespace Nz
 
 				m_lineCount++;
 
-				m_currentLine = m_currentStream->ReadLine();
-				if (std::size_t p = m_currentLine.find('#'); p != m_currentLine.npos)
-				{
-					if (p > 0)
-						m_currentLine = m_currentLine.substr(0, p - 1);
-					else
-						m_currentLine.clear();
-				}
+				m_lineBuffer = m_currentStream->ReadLine();
+
+				std::string_view line = m_lineBuffer;
+				if (std::size_t p = line.find('#'); p != line.npos)
+					line = line.substr(0, p);
 
-				m_currentLine = Trim(m_currentLine);
+				m_currentLine = Trim(line);
 
 				if (m_currentLine.empty())
 					continue;
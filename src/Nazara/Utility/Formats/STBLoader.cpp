@@ -10,6 +10,7 @@
 #include <NazaraUtils/Endianness.hpp>
 #include <frozen/string.h>
 #include <frozen/unordered_set.h>
+#include <limits>
 
 #define STB_IMAGE_STATIC
 #define STB_IMAGE_IMPLEMENTATION
@@ -52,16 +53,42 @@ namespace Nz
 		{
 			UInt64 streamPos = stream.GetCursorPos();
 
+			// Memory-mapped streams (mapped files, memory views) are parsed in place instead of going through the read callbacks
+			const stbi_uc* mappedData = nullptr;
+			int mappedSize = 0;
+			if (stream.IsMemoryMapped())
+			{
+				UInt64 remainingSize = stream.GetSize() - streamPos;
+				if (remainingSize <= static_cast<UInt64>(std::numeric_limits<int>::max()))
+				{
+					mappedData = static_cast<const stbi_uc*>(stream.GetMappedPointer()) + streamPos;
+					mappedSize = static_cast<int>(remainingSize);
+				}
+			}
+
 			int width, height, bpp;
-			if (!stbi_info_from_callbacks(&s_stbiCallbacks, &stream, &width, &height, &bpp))
-				return Err(ResourceLoadingError::Unrecognized);
+			if (mappedData)
+			{
+				if (!stbi_info_from_memory(mappedData, mappedSize, &width, &height, &bpp))
+					return Err(ResourceLoadingError::Unrecognized);
+			}
+			else
+			{
+				if (!stbi_info_from_callbacks(&s_stbiCallbacks, &stream, &width, &height, &bpp))
+					return Err(ResourceLoadingError::Unrecognized);
 
-			stream.SetCursorPos(streamPos);
+				stream.SetCursorPos(streamPos);
+			}
 
 			// Load everything as RGBA8 and then convert using the Image::Convert method
 			// This is because of a STB bug when loading some JPG images with default settings
 
-			UInt8* ptr = stbi_load_from_callbacks(&s_stbiCallbacks, &stream, &width, &height, &bpp, STBI_rgb_alpha);
+			UInt8* ptr;
+			if (mappedData)
+				ptr = stbi_load_from_memory(mappedData, mappedSize, &width, &height, &bpp, STBI_rgb_alpha);
+			else
+				ptr = stbi_load_from_callbacks(&s_stbiCallbacks, &stream, &width, &height, &bpp, STBI_rgb_alpha);
+
 			if (!ptr)
 			{
 				NazaraError("failed to load image: {0}", std::string(stbi_failure_reason()));
@@ -4,6 +4,7 @@
 
 #include <Nazara/Utility/GuillotineImageAtlas.hpp>
 #include <Nazara/Utility/Config.hpp>
+#include <cstring>
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
@@ -13,10 +14,16 @@ namespace Nz
 		constexpr Vector2ui s_guillotineAtlasStartSize(512);
 	}
 
-	GuillotineImageAtlas::GuillotineImageAtlas() :
+	/*!
+	* \brief Constructs an empty atlas
+	*
+	* \param packingAlgorithm Algorithm placing images in the layers (Skyline is best suited to glyphs, MaxRects to atlases built at once)
+	*/
+	GuillotineImageAtlas::GuillotineImageAtlas(BinPackAlgorithm packingAlgorithm) :
 	m_rectChoiceHeuristic(GuillotineBinPack::RectBestAreaFit),
 	m_rectSplitHeuristic(GuillotineBinPack::SplitMinimizeArea),
-	m_maxLayerSize(16384)
+	m_maxLayerSize(16384),
+	m_packingAlgorithm(packingAlgorithm)
 	{
 	}
 
@@ -38,7 +45,7 @@ namespace Nz
 			}
 			#endif
 
-			m_layers[layers[i]].binPack.FreeRectangle(rects[i]);
+			std::visit([&](auto& binPack) { binPack.FreeRectangle(rects[i]); }, m_layers[layers[i]].binPack);
 			m_layers[layers[i]].freedRectangles++;
 		}
 	}
@@ -48,6 +55,11 @@ namespace Nz
 		return m_maxLayerSize;
 	}
 
+	BinPackAlgorithm GuillotineImageAtlas::GetPackingAlgorithm() const
+	{
+		return m_packingAlgorithm;
+	}
+
 	GuillotineBinPack::FreeRectChoiceHeuristic GuillotineImageAtlas::GetRectChoiceHeuristic() const
 	{
 		return m_rectChoiceHeuristic;
@@ -88,21 +100,14 @@ namespace Nz
 	{
 		if (m_layers.empty())
 			// On créé une première couche s'il n'y en a pas
-			m_layers.resize(1);
+			m_layers.push_back(CreateLayer());
 
 		// Cette fonction ne fait qu'insérer un rectangle de façon virtuelle, l'insertion des images se fait après
 		for (unsigned int i = 0; i < m_layers.size(); ++i)
 		{
 			Layer& layer = m_layers[i];
 
-			// Une fois qu'un certain nombre de rectangles ont étés libérés d'une couche, on fusionne les rectangles libres
-			if (layer.freedRectangles > 10) // Valeur totalement arbitraire
-			{
-				while (layer.binPack.MergeFreeRectangles()); // Tant qu'une fusion est possible
-				layer.freedRectangles = 0; // Et on repart de zéro
-			}
-
-			if (layer.binPack.Insert(rect, flipped, 1, false, m_rectChoiceHeuristic, m_rectSplitHeuristic))
+			if (InsertIntoLayer(layer, rect, flipped))
 			{
 				// Insertion réussie dans l'une des couches, on place le glyphe en file d'attente
 				layer.queuedGlyphs.resize(layer.queuedGlyphs.size()+1);
@@ -117,7 +122,7 @@ namespace Nz
 			else if (i == m_layers.size() - 1) // Dernière itération ?
 			{
 				// Dernière couche, et le glyphe ne rentre pas, peut-on agrandir la taille de l'image ?
-				Vector2ui newSize = layer.binPack.GetSize()*2;
+				Vector2ui newSize = std::visit([](const auto& binPack) { return binPack.GetSize(); }, layer.binPack) * 2;
 				if (newSize == Vector2ui::Zero())
 					newSize = s_guillotineAtlasStartSize;
 
@@ -125,7 +130,7 @@ namespace Nz
 				if (newSize.x <= m_maxLayerSize && newSize.y <= m_maxLayerSize && ResizeLayer(layer, newSize))
 				{
 					// Yes we can!
-					layer.binPack.Expand(newSize); // On ajuste l'atlas virtuel
+					std::visit([&](auto& binPack) { binPack.Expand(newSize); }, layer.binPack); // On ajuste l'atlas virtuel
 
 					// Et on relance la boucle sur la nouvelle dernière couche
 					i--;
@@ -135,7 +140,7 @@ namespace Nz
 					// On ne peut plus agrandir la dernière couche, il est temps d'en créer une nouvelle
 					newSize = s_guillotineAtlasStartSize;
 
-					Layer newLayer;
+					Layer newLayer = CreateLayer();
 					if (!ResizeLayer(newLayer, newSize))
 					{
 						// Impossible d'allouer une nouvelle couche, nous manquons probablement de mémoire (ou le glyphe est trop grand)
@@ -143,7 +148,7 @@ namespace Nz
 						return false;
 					}
 
-					newLayer.binPack.Reset(newSize);
+					std::visit([&](auto& binPack) { binPack.Reset(newSize); }, newLayer.binPack);
 
 					m_layers.emplace_back(std::move(newLayer)); // Insertion du layer
 
@@ -161,6 +166,23 @@ namespace Nz
 		m_maxLayerSize = maxLayerSize;
 	}
 
+	/*!
+	* \brief Sets the algorithm placing images in the layers
+	*
+	* \param packingAlgorithm New packing algorithm
+	*
+	* \remark The atlas is cleared if the algorithm changes
+	*/
+	void GuillotineImageAtlas::SetPackingAlgorithm(BinPackAlgorithm packingAlgorithm)
+	{
+		if (m_packingAlgorithm == packingAlgorithm)
+			return;
+
+		m_packingAlgorithm = packingAlgorithm;
+		if (!m_layers.empty())
+			Clear();
+	}
+
 	void GuillotineImageAtlas::SetRectChoiceHeuristic(GuillotineBinPack::FreeRectChoiceHeuristic heuristic)
 	{
 		m_rectChoiceHeuristic = heuristic;
@@ -199,12 +221,58 @@ namespace Nz
 		return true;
 	}
 
+	auto GuillotineImageAtlas::CreateLayer() const -> Layer
+	{
+		Layer layer;
+		switch (m_packingAlgorithm)
+		{
+			case BinPackAlgorithm::Guillotine: layer.binPack.emplace<GuillotineBinPack>(); break;
+			case BinPackAlgorithm::MaxRects:   layer.binPack.emplace<MaxRectsBinPack>(); break;
+			case BinPackAlgorithm::Skyline:    layer.binPack.emplace<SkylineBinPack>(); break;
+		}
+
+		return layer;
+	}
+
+	bool GuillotineImageAtlas::InsertIntoLayer(Layer& layer, Rectui* rect, bool* flipped) const
+	{
+		if (GuillotineBinPack* guillotineBinPack = std::get_if<GuillotineBinPack>(&layer.binPack))
+		{
+			// Une fois qu'un certain nombre de rectangles ont étés libérés d'une couche, on fusionne les rectangles libres
+			if (layer.freedRectangles > 10) // Valeur totalement arbitraire
+			{
+				while (guillotineBinPack->MergeFreeRectangles()); // Tant qu'une fusion est possible
+				layer.freedRectangles = 0; // Et on repart de zéro
+			}
+
+			return guillotineBinPack->Insert(rect, flipped, 1, false, m_rectChoiceHeuristic, m_rectSplitHeuristic);
+		}
+		else if (MaxRectsBinPack* maxRectsBinPack = std::get_if<MaxRectsBinPack>(&layer.binPack))
+			return maxRectsBinPack->Insert(rect, flipped, 1, MaxRectsBinPack::Heuristic::BestShortSideFit);
+		else
+			return std::get<SkylineBinPack>(layer.binPack).Insert(rect, flipped, 1, SkylineBinPack::Heuristic::BottomLeft);
+	}
+
 	void GuillotineImageAtlas::ProcessGlyphQueue(Layer& layer) const
 	{
-		std::vector<UInt8> pixelBuffer;
+		if (layer.queuedGlyphs.empty())
+			return;
 
+		// Chaque glyphe (contour compris) est écrit dans un unique tampon, envoyé en une fois à l'image
+		std::size_t pixelCount = 0;
+		for (const QueuedGlyph& glyph : layer.queuedGlyphs)
+			pixelCount += glyph.rect.width * glyph.rect.height;
+
+		std::vector<UInt8> pixelBuffer(pixelCount, 0); // BPP = 1, les contours restent à zéro
+		std::vector<AbstractImage::UpdateRegion> regions;
+		regions.reserve(layer.queuedGlyphs.size());
+
+		std::size_t offset = 0;
 		for (QueuedGlyph& glyph : layer.queuedGlyphs)
 		{
+			if (glyph.rect.width == 0 || glyph.rect.height == 0)
+				continue;
+
 			unsigned int glyphWidth = glyph.image.GetWidth();
 			unsigned int glyphHeight = glyph.image.GetHeight();
 
@@ -222,48 +290,45 @@ namespace Nz
 				paddingY = (glyph.rect.height - glyphHeight)/2;
 			}
 
-			if (paddingX > 0 || paddingY > 0)
-			{
-				// On remplit les contours
-				pixelBuffer.resize(glyph.rect.width * glyph.rect.height);
-				std::memset(pixelBuffer.data(), 0, glyph.rect.width*glyph.rect.height*sizeof(UInt8));
-
-				layer.image->Update(pixelBuffer.data(), glyph.rect);
-			}
+			unsigned int dstStride = glyph.rect.width;
+			UInt8* dst = &pixelBuffer[offset + paddingY * dstStride + paddingX];
+			const UInt8* src = glyph.image.GetConstPixels();
 
-			const UInt8* pixels;
-			// On copie le glyphe dans l'atlas
+			// On copie le glyphe dans la région
 			if (glyph.flipped)
 			{
-				pixelBuffer.resize(glyphHeight * glyphWidth);
-
 				// On tourne le glyphe pour qu'il rentre dans le rectangle
-				const UInt8* src = glyph.image.GetConstPixels();
-				UInt8* ptr = pixelBuffer.data();
-
 				unsigned int lineStride = glyphWidth*sizeof(UInt8); // BPP = 1
-				src += lineStride-1; // Départ en haut à droite
 				for (unsigned int x = 0; x < glyphWidth; ++x)
 				{
+					const UInt8* column = src + lineStride - 1 - x; // Départ en haut à droite
 					for (unsigned int y = 0; y < glyphHeight; ++y)
-					{
-						*ptr++ = *src;
-						src += lineStride;
-					}
+						dst[y] = column[y * lineStride];
 
-					src -= glyphHeight*lineStride + 1;
+					dst += dstStride;
 				}
-
-				pixels = pixelBuffer.data();
-				std::swap(glyphWidth, glyphHeight);
 			}
 			else
-				pixels = glyph.image.GetConstPixels();
+			{
+				for (unsigned int y = 0; y < glyphHeight; ++y)
+				{
+					std::memcpy(dst, src, glyphWidth*sizeof(UInt8));
+					dst += dstStride;
+					src += glyphWidth;
+				}
+			}
+
+			AbstractImage::UpdateRegion& region = regions.emplace_back();
+			region.box = Boxui(glyph.rect.x, glyph.rect.y, 0, glyph.rect.width, glyph.rect.height, 1);
+			region.offset = offset;
 
-			layer.image->Update(pixels, Rectui(glyph.rect.x + paddingX, glyph.rect.y + paddingY, glyphWidth, glyphHeight), 0, glyphWidth, glyphHeight);
+			offset += glyph.rect.width * glyph.rect.height;
 			glyph.image.Destroy(); // On libère l'image dès que possible (pour réduire la consommation)
 		}
 
+		if (!layer.image->UpdateRegions(pixelBuffer.data(), regions.data(), regions.size()))
+			NazaraError("failed to upload {0} glyph(s) to atlas layer", regions.size());
+
 		layer.queuedGlyphs.clear();
 	}
 }
@@ -3,13 +3,27 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Utility/Image.hpp>
+#include <Nazara/Core/Core.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/ErrorFlags.hpp>
 #include <Nazara/Core/StringExt.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Utility/Config.hpp>
 #include <Nazara/Utility/PixelFormat.hpp>
 #include <Nazara/Utility/Utility.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
 #include <memory>
+#include <optional>
+
+#if defined(NAZARA_ARCH_x86_64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define NAZARA_UTILITY_RESAMPLE_SSE2
+#endif
+
 #include <Nazara/Utility/Debug.hpp>
 
 ///TODO: Rajouter des warnings (Formats compressés avec les méthodes Copy/Update, tests taille dans Copy)
@@ -32,6 +46,497 @@ namespace Nz
 		{
 			return &base[(width*(height*z + y) + x)*bpp];
 		}
+
+		// Resampling (resizing and mipmap generation) works on RGBA float texels (unused channels are zero), whatever the image format
+		// Colors are premultiplied by alpha while filtering, so transparent texels don't bleed their color into their neighbors
+		constexpr std::size_t ResampleChunkTexelCount = 16 * 1024;
+
+		enum class ResampleFilter
+		{
+			Bilinear,
+			Box,
+			Kaiser,
+			Lanczos,
+			Mitchell
+		};
+
+		struct ResampleFormat
+		{
+			Int8 alphaChannel; //< -1 if the format has no alpha to premultiply colors with
+			UInt8 channelCount;
+			UInt8 srgbChannelCount; //< alpha is always stored linearly
+			bool isFloat;
+		};
+
+		std::optional<ResampleFormat> GetResampleFormat(PixelFormat format)
+		{
+			switch (format)
+			{
+				case PixelFormat::A8:
+				case PixelFormat::L8:
+				case PixelFormat::R8:
+					return ResampleFormat{ -1, 1, 0, false };
+
+				case PixelFormat::LA8:
+					return ResampleFormat{ 1, 2, 0, false };
+
+				case PixelFormat::RG8:
+					return ResampleFormat{ -1, 2, 0, false };
+
+				case PixelFormat::BGR8:
+				case PixelFormat::RGB8:
+					return ResampleFormat{ -1, 3, 0, false };
+
+				case PixelFormat::BGR8_SRGB:
+				case PixelFormat::RGB8_SRGB:
+					return ResampleFormat{ -1, 3, 3, false };
+
+				case PixelFormat::BGRA8:
+				case PixelFormat::RGBA8:
+					return ResampleFormat{ 3, 4, 0, false };
+
+				case PixelFormat::BGRA8_SRGB:
+				case PixelFormat::RGBA8_SRGB:
+					return ResampleFormat{ 3, 4, 3, false };
+
+				case PixelFormat::R32F:    return ResampleFormat{ -1, 1, 0, true };
+				case PixelFormat::RG32F:   return ResampleFormat{ -1, 2, 0, true };
+				case PixelFormat::RGB32F:  return ResampleFormat{ -1, 3, 0, true };
+				case PixelFormat::RGBA32F: return ResampleFormat{ 3, 4, 0, true };
+
+				default:
+					return std::nullopt;
+			}
+		}
+
+		ResampleFilter GetResampleFilter(ImageMipmapFilter filter)
+		{
+			switch (filter)
+			{
+				case ImageMipmapFilter::Box:    return ResampleFilter::Box;
+				case ImageMipmapFilter::Kaiser: return ResampleFilter::Kaiser;
+			}
+
+			NazaraInternalError("unhandled ImageMipmapFilter {0:#x}", UnderlyingCast(filter));
+			return ResampleFilter::Box;
+		}
+
+		ResampleFilter GetResampleFilter(ImageResizeFilter filter)
+		{
+			switch (filter)
+			{
+				case ImageResizeFilter::Bilinear: return ResampleFilter::Bilinear;
+				case ImageResizeFilter::Box:      return ResampleFilter::Box;
+				case ImageResizeFilter::Lanczos:  return ResampleFilter::Lanczos;
+				case ImageResizeFilter::Mitchell: return ResampleFilter::Mitchell;
+			}
+
+			NazaraInternalError("unhandled ImageResizeFilter {0:#x}", UnderlyingCast(filter));
+			return ResampleFilter::Bilinear;
+		}
+
+		const std::array<float, 256>& GetSRGBToLinearTable()
+		{
+			static std::array<float, 256> table = []
+			{
+				std::array<float, 256> values;
+				for (std::size_t i = 0; i < values.size(); ++i)
+				{
+					float value = i / 255.f;
+					values[i] = (value <= 0.04045f) ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+				}
+
+				return values;
+			}();
+
+			return table;
+		}
+
+		float LinearToSRGB(float value)
+		{
+			return (value <= 0.0031308f) ? value * 12.92f : 1.055f * std::pow(value, 1.f / 2.4f) - 0.055f;
+		}
+
+#ifdef NAZARA_UTILITY_RESAMPLE_SSE2
+		// RGB lanes of a RGBA texel
+		inline __m128 GetColorMask()
+		{
+			return _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+		}
+
+		inline __m128 PremultiplyTexel(__m128 texel, __m128 colorMask)
+		{
+			__m128 alpha = _mm_shuffle_ps(texel, texel, _MM_SHUFFLE(3, 3, 3, 3));
+			return _mm_or_ps(_mm_and_ps(colorMask, _mm_mul_ps(texel, alpha)), _mm_andnot_ps(colorMask, texel));
+		}
+
+		inline __m128 UnpremultiplyTexel(__m128 texel, __m128 colorMask)
+		{
+			// Fully transparent texels have no color left, keep them black instead of dividing by zero
+			__m128 alpha = _mm_shuffle_ps(texel, texel, _MM_SHUFFLE(3, 3, 3, 3));
+			__m128 invAlpha = _mm_and_ps(_mm_cmpgt_ps(alpha, _mm_setzero_ps()), _mm_div_ps(_mm_set1_ps(1.f), alpha));
+			return _mm_or_ps(_mm_and_ps(colorMask, _mm_mul_ps(texel, invAlpha)), _mm_andnot_ps(colorMask, texel));
+		}
+#endif
+
+		void DecodeResampleTexels(const ResampleFormat& format, const UInt8* src, std::size_t texelCount, float* dst)
+		{
+#ifdef NAZARA_UTILITY_RESAMPLE_SSE2
+			// Fast path for linear RGBA formats, which are the most common ones
+			if (format.channelCount == 4 && format.srgbChannelCount == 0)
+			{
+				__m128 colorMask = GetColorMask();
+				if (format.isFloat)
+				{
+					const float* srcValues = reinterpret_cast<const float*>(src);
+					for (std::size_t i = 0; i < texelCount; ++i)
+						_mm_storeu_ps(&dst[i * 4], PremultiplyTexel(_mm_loadu_ps(&srcValues[i * 4]), colorMask));
+				}
+				else
+				{
+					__m128 scale = _mm_set1_ps(1.f / 255.f);
+					__m128i zero = _mm_setzero_si128();
+					for (std::size_t i = 0; i < texelCount; ++i)
+					{
+						int packedTexel;
+						std::memcpy(&packedTexel, &src[i * 4], sizeof(packedTexel));
+
+						__m128i texel = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packedTexel), zero), zero);
+						_mm_storeu_ps(&dst[i * 4], PremultiplyTexel(_mm_mul_ps(_mm_cvtepi32_ps(texel), scale), colorMask));
+					}
+				}
+
+				return;
+			}
+#endif
+
+			const std::array<float, 256>& srgbToLinear = GetSRGBToLinearTable();
+			for (std::size_t i = 0; i < texelCount; ++i)
+			{
+				for (std::size_t c = 0; c < 4; ++c)
+				{
+					if (c >= format.channelCount)
+						dst[c] = 0.f;
+					else if (format.isFloat)
+						dst[c] = reinterpret_cast<const float*>(src)[c];
+					else if (c < format.srgbChannelCount)
+						dst[c] = srgbToLinear[src[c]];
+					else
+						dst[c] = src[c] / 255.f;
+				}
+
+				if (format.alphaChannel >= 0)
+				{
+					float alpha = dst[format.alphaChannel];
+					for (std::size_t c = 0; c < format.channelCount; ++c)
+					{
+						if (c != std::size_t(format.alphaChannel))
+							dst[c] *= alpha;
+					}
+				}
+
+				src += format.channelCount * ((format.isFloat) ? sizeof(float) : 1);
+				dst += 4;
+			}
+		}
+
+		void EncodeResampleTexels(const ResampleFormat& format, const float* src, std::size_t texelCount, UInt8* dst)
+		{
+#ifdef NAZARA_UTILITY_RESAMPLE_SSE2
+			if (format.channelCount == 4 && format.srgbChannelCount == 0)
+			{
+				__m128 colorMask = GetColorMask();
+				if (format.isFloat)
+				{
+					float* dstValues = reinterpret_cast<float*>(dst);
+					for (std::size_t i = 0; i < texelCount; ++i)
+						_mm_storeu_ps(&dstValues[i * 4], UnpremultiplyTexel(_mm_loadu_ps(&src[i * 4]), colorMask));
+				}
+				else
+				{
+					__m128 zero = _mm_setzero_ps();
+					__m128 one = _mm_set1_ps(1.f);
+					__m128 half = _mm_set1_ps(0.5f);
+					__m128 scale = _mm_set1_ps(255.f);
+					for (std::size_t i = 0; i < texelCount; ++i)
+					{
+						// Some filters (like Kaiser or Lanczos) can ring outside of the [0;1] range
+						__m128 texel = _mm_min_ps(_mm_max_ps(UnpremultiplyTexel(_mm_loadu_ps(&src[i * 4]), colorMask), zero), one);
+						__m128i values = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(texel, scale), half));
+						values = _mm_packs_epi32(values, values);
+						values = _mm_packus_epi16(values, values);
+
+						int packedTexel = _mm_cvtsi128_si32(values);
+						std::memcpy(&dst[i * 4], &packedTexel, sizeof(packedTexel));
+					}
+				}
+
+				return;
+			}
+#endif
+
+			for (std::size_t i = 0; i < texelCount; ++i)
+			{
+				float invAlpha = 1.f;
+				if (format.alphaChannel >= 0)
+				{
+					float alpha = src[format.alphaChannel];
+					invAlpha = (alpha > 0.f) ? 1.f / alpha : 0.f;
+				}
+
+				for (std::size_t c = 0; c < format.channelCount; ++c)
+				{
+					float value = src[c];
+					if (std::ptrdiff_t(c) != format.alphaChannel)
+						value *= invAlpha;
+
+					if (format.isFloat)
+					{
+						reinterpret_cast<float*>(dst)[c] = value;
+						continue;
+					}
+
+					// Some filters (like Kaiser or Lanczos) can ring outside of the [0;1] range
+					value = Clamp(value, 0.f, 1.f);
+					if (c < format.srgbChannelCount)
+						value = LinearToSRGB(value);
+
+					dst[c] = static_cast<UInt8>(value * 255.f + 0.5f);
+				}
+
+				src += 4;
+				dst += format.channelCount * ((format.isFloat) ? sizeof(float) : 1);
+			}
+		}
+
+		float Sinc(float x)
+		{
+			return (std::abs(x) < 1e-5f) ? 1.f : std::sin(Pi<float> * x) / (Pi<float> * x);
+		}
+
+		float BesselI0(float x)
+		{
+			// Power series, converges quickly for the small values used by the Kaiser window
+			float sum = 1.f;
+			float term = 1.f;
+			float halfX = x * 0.5f;
+			for (unsigned int k = 1; k < 32; ++k)
+			{
+				term *= (halfX / k) * (halfX / k);
+				sum += term;
+				if (term < sum * 1e-7f)
+					break;
+			}
+
+			return sum;
+		}
+
+		float KaiserWindowedSinc(float x, float radius, float alpha)
+		{
+			float ratio = x / radius;
+			if (ratio <= -1.f || ratio >= 1.f)
+				return 0.f;
+
+			return Sinc(x) * BesselI0(alpha * std::sqrt(1.f - ratio * ratio)) / BesselI0(alpha);
+		}
+
+		float Mitchell(float x)
+		{
+			// Mitchell-Netravali cubic with B = C = 1/3
+			constexpr float B = 1.f / 3.f;
+			constexpr float C = 1.f / 3.f;
+
+			x = std::abs(x);
+			if (x < 1.f)
+				return ((12.f - 9.f * B - 6.f * C) * x * x * x + (-18.f + 12.f * B + 6.f * C) * x * x + (6.f - 2.f * B)) / 6.f;
+			else if (x < 2.f)
+				return ((-B - 6.f * C) * x * x * x + (6.f * B + 30.f * C) * x * x + (-12.f * B - 48.f * C) * x + (8.f * B + 24.f * C)) / 6.f;
+			else
+				return 0.f;
+		}
+
+		// Weights of source texels contributing to each destination texel, along a single axis
+		struct ResampleKernel
+		{
+			struct Texel
+			{
+				std::size_t firstWeight;
+				unsigned int firstSource;
+				unsigned int sourceCount;
+			};
+
+			std::vector<Texel> texels;
+			std::vector<float> weights;
+		};
+
+		ResampleKernel BuildResampleKernel(ResampleFilter filter, unsigned int srcSize, unsigned int dstSize)
+		{
+			constexpr float KaiserAlpha = 4.f;
+			constexpr float KaiserRadius = 3.f;
+			constexpr float LanczosRadius = 3.f;
+
+			float radius = 1.f;
+			switch (filter)
+			{
+				case ResampleFilter::Bilinear: radius = 1.f; break;
+				case ResampleFilter::Box:      radius = 0.5f; break;
+				case ResampleFilter::Kaiser:   radius = KaiserRadius; break;
+				case ResampleFilter::Lanczos:  radius = LanczosRadius; break;
+				case ResampleFilter::Mitchell: radius = 2.f; break;
+			}
+
+			// When downscaling, the filter is stretched to cover every source texel (which prevents aliasing)
+			float scale = float(srcSize) / float(dstSize);
+			float filterScale = std::max(scale, 1.f);
+			float support = radius * filterScale;
+
+			ResampleKernel kernel;
+			kernel.texels.resize(dstSize);
+			for (unsigned int i = 0; i < dstSize; ++i)
+			{
+				float center = (i + 0.5f) * scale;
+				int first = static_cast<int>(std::floor(center - support));
+				int last = static_cast<int>(std::ceil(center + support));
+
+				// Texels out of the image are clamped to the edge, which folds their weight on the edge texels
+				int firstSource = Clamp(first, 0, int(srcSize) - 1);
+				int lastSource = Clamp(last - 1, 0, int(srcSize) - 1);
+
+				auto& texel = kernel.texels[i];
+				texel.firstWeight = kernel.weights.size();
+				texel.firstSource = static_cast<unsigned int>(firstSource);
+				texel.sourceCount = static_cast<unsigned int>(lastSource - firstSource + 1);
+
+				kernel.weights.resize(kernel.weights.size() + texel.sourceCount, 0.f);
+				float* weights = &kernel.weights[texel.firstWeight];
+
+				float weightSum = 0.f;
+				for (int j = first; j < last; ++j)
+				{
+					float x = (j + 0.5f - center) / filterScale;
+
+					float weight = 0.f;
+					switch (filter)
+					{
+						case ResampleFilter::Bilinear: weight = std::max(1.f - std::abs(x), 0.f); break;
+						case ResampleFilter::Box:      weight = std::max(std::min(j + 1.f, center + support) - std::max(float(j), center - support), 0.f); break; //< coverage of the source texel
+						case ResampleFilter::Kaiser:   weight = KaiserWindowedSinc(x, KaiserRadius, KaiserAlpha); break;
+						case ResampleFilter::Lanczos:  weight = (std::abs(x) < LanczosRadius) ? Sinc(x) * Sinc(x / LanczosRadius) : 0.f; break;
+						case ResampleFilter::Mitchell: weight = Mitchell(x); break;
+					}
+
+					weights[Clamp(j, firstSource, lastSource) - firstSource] += weight;
+					weightSum += weight;
+				}
+
+				if (weightSum != 0.f)
+				{
+					for (unsigned int j = 0; j < texel.sourceCount; ++j)
+						weights[j] /= weightSum;
+				}
+			}
+
+			return kernel;
+		}
+
+		// dst[i] += weight * src[i] for texelCount RGBA texels
+		void AccumulateResampleTexels(float* dst, const float* src, float weight, std::size_t texelCount)
+		{
+#ifdef NAZARA_UTILITY_RESAMPLE_SSE2
+			__m128 weights = _mm_set1_ps(weight);
+			for (std::size_t i = 0; i < texelCount; ++i)
+				_mm_storeu_ps(&dst[i * 4], _mm_add_ps(_mm_loadu_ps(&dst[i * 4]), _mm_mul_ps(weights, _mm_loadu_ps(&src[i * 4]))));
+#else
+			for (std::size_t i = 0; i < texelCount * 4; ++i)
+				dst[i] += weight * src[i];
+#endif
+		}
+
+		// Filters width-wise rows of RGBA texels
+		void ResampleRows(TaskScheduler& taskScheduler, const ResampleKernel& kernel, const float* src, unsigned int srcWidth, float* dst, std::size_t rowCount)
+		{
+			std::size_t dstWidth = kernel.texels.size();
+			taskScheduler.ForEachChunk(rowCount, std::max<std::size_t>(ResampleChunkTexelCount / std::max<std::size_t>(srcWidth, dstWidth), 1), [&](std::size_t firstRow, std::size_t lastRow)
+			{
+				for (std::size_t row = firstRow; row < lastRow; ++row)
+				{
+					const float* srcRow = &src[row * srcWidth * 4];
+					float* dstRow = &dst[row * dstWidth * 4];
+
+					for (std::size_t x = 0; x < dstWidth; ++x)
+					{
+						const auto& texel = kernel.texels[x];
+						const float* weights = &kernel.weights[texel.firstWeight];
+						const float* srcTexels = &srcRow[texel.firstSource * 4];
+
+#ifdef NAZARA_UTILITY_RESAMPLE_SSE2
+						__m128 value = _mm_setzero_ps();
+						for (unsigned int i = 0; i < texel.sourceCount; ++i)
+							value = _mm_add_ps(value, _mm_mul_ps(_mm_set1_ps(weights[i]), _mm_loadu_ps(&srcTexels[i * 4])));
+
+						_mm_storeu_ps(&dstRow[x * 4], value);
+#else
+						float* dstTexel = &dstRow[x * 4];
+						std::fill(dstTexel, dstTexel + 4, 0.f);
+						for (unsigned int i = 0; i < texel.sourceCount; ++i)
+							AccumulateResampleTexels(dstTexel, &srcTexels[i * 4], weights[i], 1);
+#endif
+					}
+				}
+			});
+		}
+
+		// Filters along an outer axis (height or depth), lines are contiguous blocks of lineTexelCount RGBA texels
+		void ResampleLines(TaskScheduler& taskScheduler, const ResampleKernel& kernel, const float* src, unsigned int srcLineCount, float* dst, std::size_t lineTexelCount, std::size_t blockCount)
+		{
+			std::size_t dstLineCount = kernel.texels.size();
+			taskScheduler.ForEachChunk(blockCount * dstLineCount, std::max<std::size_t>(ResampleChunkTexelCount / lineTexelCount, 1), [&](std::size_t firstLine, std::size_t lastLine)
+			{
+				for (std::size_t line = firstLine; line < lastLine; ++line)
+				{
+					std::size_t block = line / dstLineCount;
+					const auto& texel = kernel.texels[line % dstLineCount];
+					const float* weights = &kernel.weights[texel.firstWeight];
+
+					float* dstLine = &dst[line * lineTexelCount * 4];
+					std::fill(dstLine, dstLine + lineTexelCount * 4, 0.f);
+
+					for (unsigned int i = 0; i < texel.sourceCount; ++i)
+					{
+						const float* srcLine = &src[(block * srcLineCount + texel.firstSource + i) * lineTexelCount * 4];
+						AccumulateResampleTexels(dstLine, srcLine, weights[i], lineTexelCount);
+					}
+				}
+			});
+		}
+
+		// Resamples RGBA texels to a new size, one axis at a time (size is updated along)
+		void ResampleTexels(TaskScheduler& taskScheduler, ResampleFilter filter, std::vector<float>& texels, std::vector<float>& buffer, Vector3ui& size, const Vector3ui& newSize)
+		{
+			if (newSize.x != size.x)
+			{
+				buffer.resize(std::size_t(newSize.x) * size.y * size.z * 4);
+				ResampleRows(taskScheduler, BuildResampleKernel(filter, size.x, newSize.x), texels.data(), size.x, buffer.data(), std::size_t(size.y) * size.z);
+				std::swap(texels, buffer);
+				size.x = newSize.x;
+			}
+
+			if (newSize.y != size.y)
+			{
+				buffer.resize(std::size_t(size.x) * newSize.y * size.z * 4);
+				ResampleLines(taskScheduler, BuildResampleKernel(filter, size.y, newSize.y), texels.data(), size.y, buffer.data(), size.x, size.z);
+				std::swap(texels, buffer);
+				size.y = newSize.y;
+			}
+
+			if (newSize.z != size.z)
+			{
+				buffer.resize(std::size_t(size.x) * size.y * newSize.z * 4);
+				ResampleLines(taskScheduler, BuildResampleKernel(filter, size.z, newSize.z), texels.data(), size.z, buffer.data(), std::size_t(size.x) * size.y, 1);
+				std::swap(texels, buffer);
+				size.z = newSize.z;
+			}
+		}
 	}
 
 	bool ImageParams::IsValid() const
@@ -567,6 +1072,87 @@ namespace Nz
 		return true;
 	}
 
+	/*!
+	* \brief Generates every mipmap level of the image from its base level
+	* \return True if mipmaps were successfully generated
+	*
+	* \param filter Filter used to downsample each level from the previous one
+	*
+	* \remark If the image only has its base level, the full mipmap chain is allocated first
+	* \remark sRGB formats are filtered in linear space
+	* \remark Work is split by rows on the core task scheduler
+	*/
+	bool Image::GenerateMipmaps(ImageMipmapFilter filter)
+	{
+		#if NAZARA_UTILITY_SAFE
+		if (m_sharedImage == &emptyImage)
+		{
+			NazaraError("Image must be valid");
+			return false;
+		}
+		#endif
+
+		std::optional<ResampleFormat> resampleFormat = GetResampleFormat(m_sharedImage->format);
+		if (!resampleFormat)
+		{
+			NazaraError("mipmap generation is not supported for pixel format {0}", PixelFormatInfo::GetName(m_sharedImage->format));
+			return false;
+		}
+
+		// Array layers are stored as an extra dimension which gets halved with levels, which we cannot filter meaningfully
+		if (m_sharedImage->type == ImageType::E1D_Array || m_sharedImage->type == ImageType::E2D_Array)
+		{
+			NazaraError("mipmap generation is not supported for array images");
+			return false;
+		}
+
+		if (m_sharedImage->levels.size() == 1)
+			SetLevelCount(GetMaxLevel());
+
+		EnsureOwnership();
+
+		TaskScheduler& taskScheduler = Core::Instance()->GetTaskScheduler();
+
+		// Cubemap faces are filtered independently
+		bool filterDepth = (m_sharedImage->type == ImageType::E3D);
+
+		Vector3ui size(m_sharedImage->width, m_sharedImage->height, (m_sharedImage->type == ImageType::Cubemap) ? 6 : m_sharedImage->depth);
+
+		UInt8 bpp = PixelFormatInfo::GetBytesPerPixel(m_sharedImage->format);
+		auto ProcessTexels = [&](std::size_t texelCount, auto&& func)
+		{
+			taskScheduler.ForEachChunk(texelCount, ResampleChunkTexelCount, func);
+		};
+
+		// Each level is filtered from the previous one, kept as float to prevent quantization from accumulating
+		std::vector<float> texels(std::size_t(size.x) * size.y * size.z * 4);
+		std::vector<float> buffer;
+
+		const UInt8* basePixels = m_sharedImage->levels[0].get();
+		ProcessTexels(std::size_t(size.x) * size.y * size.z, [&](std::size_t first, std::size_t last)
+		{
+			DecodeResampleTexels(*resampleFormat, &basePixels[first * bpp], last - first, &texels[first * 4]);
+		});
+
+		for (UInt8 level = 1; level < m_sharedImage->levels.size(); ++level)
+		{
+			Vector3ui levelSize;
+			levelSize.x = GetImageLevelSize(m_sharedImage->width, level);
+			levelSize.y = GetImageLevelSize(m_sharedImage->height, level);
+			levelSize.z = (filterDepth) ? GetImageLevelSize(m_sharedImage->depth, level) : size.z;
+
+			ResampleTexels(taskScheduler, GetResampleFilter(filter), texels, buffer, size, levelSize);
+
+			UInt8* levelPixels = m_sharedImage->levels[level].get();
+			ProcessTexels(std::size_t(size.x) * size.y * size.z, [&](std::size_t first, std::size_t last)
+			{
+				EncodeResampleTexels(*resampleFormat, &texels[first * 4], last - first, &levelPixels[first * bpp]);
+			});
+		}
+
+		return true;
+	}
+
 	const UInt8* Image::GetConstPixels(unsigned int x, unsigned int y, unsigned int z, UInt8 level) const
 	{
 		#if NAZARA_UTILITY_SAFE
@@ -1138,6 +1724,77 @@ namespace Nz
 		return LoadFaceFromImage(face, *image);;
 	}
 
+	/*!
+	* \brief Resizes the image by resampling its first level
+	* \return True if the image was resized
+	*
+	* \param newSize New size of the image (depth is the layer count of 2D array images and stays 1 for cubemaps)
+	* \param filter Resampling filter
+	*
+	* \remark The resized image only has one level, call GenerateMipmaps if more are required
+	* \remark The layer count of array images cannot be changed
+	* \remark Colors are filtered in linear space (for sRGB formats) and premultiplied by alpha
+	*/
+	bool Image::Resize(const Vector3ui& newSize, ImageResizeFilter filter)
+	{
+		#if NAZARA_UTILITY_SAFE
+		if (m_sharedImage == &emptyImage)
+		{
+			NazaraError("Image must be valid");
+			return false;
+		}
+		#endif
+
+		std::optional<ResampleFormat> resampleFormat = GetResampleFormat(m_sharedImage->format);
+		if (!resampleFormat)
+		{
+			NazaraError("resizing is not supported for pixel format {0}", PixelFormatInfo::GetName(m_sharedImage->format));
+			return false;
+		}
+
+		ImageType type = m_sharedImage->type;
+		if ((type == ImageType::E1D_Array && newSize.y != m_sharedImage->height) || (type == ImageType::E2D_Array && newSize.z != m_sharedImage->depth))
+		{
+			NazaraError("the layer count of array images cannot be changed");
+			return false;
+		}
+
+		if (newSize == GetSize() && m_sharedImage->levels.size() == 1)
+			return true;
+
+		// Creating the resized image first validates the new size
+		Image resizedImage;
+		if (!resizedImage.Create(type, m_sharedImage->format, newSize.x, newSize.y, newSize.z, 1))
+			return false;
+
+		TaskScheduler& taskScheduler = Core::Instance()->GetTaskScheduler();
+
+		Vector3ui size(m_sharedImage->width, m_sharedImage->height, (type == ImageType::Cubemap) ? 6 : m_sharedImage->depth);
+		Vector3ui targetSize(newSize.x, newSize.y, (type == ImageType::Cubemap) ? 6 : newSize.z);
+
+		UInt8 bpp = PixelFormatInfo::GetBytesPerPixel(m_sharedImage->format);
+
+		std::vector<float> texels(std::size_t(size.x) * size.y * size.z * 4);
+		std::vector<float> buffer;
+
+		const UInt8* srcPixels = m_sharedImage->levels[0].get();
+		taskScheduler.ForEachChunk(std::size_t(size.x) * size.y * size.z, ResampleChunkTexelCount, [&](std::size_t first, std::size_t last)
+		{
+			DecodeResampleTexels(*resampleFormat, &srcPixels[first * bpp], last - first, &texels[first * 4]);
+		});
+
+		ResampleTexels(taskScheduler, GetResampleFilter(filter), texels, buffer, size, targetSize);
+
+		UInt8* dstPixels = resizedImage.m_sharedImage->levels[0].get();
+		taskScheduler.ForEachChunk(std::size_t(size.x) * size.y * size.z, ResampleChunkTexelCount, [&](std::size_t first, std::size_t last)
+		{
+			EncodeResampleTexels(*resampleFormat, &texels[first * 4], last - first, &dstPixels[first * bpp]);
+		});
+
+		*this = std::move(resizedImage);
+		return true;
+	}
+
 	bool Image::SaveToFile(const std::filesystem::path& filePath, const ImageParams& params)
 	{
 		Utility* utility = Utility::Instance();
@@ -9,20 +9,90 @@
 #include <Nazara/Core/StringExt.hpp>
 #include <Nazara/Utility/Algorithm.hpp>
 #include <Nazara/Utility/Buffer.hpp>
+#include <Nazara/Utility/BufferMapper.hpp>
 #include <Nazara/Utility/Config.hpp>
 #include <Nazara/Utility/IndexMapper.hpp>
+#include <Nazara/Utility/SkeletalMesh.hpp>
 #include <Nazara/Utility/Skeleton.hpp>
 #include <Nazara/Utility/StaticMesh.hpp>
 #include <Nazara/Utility/SubMesh.hpp>
 #include <Nazara/Utility/Utility.hpp>
 #include <Nazara/Utility/VertexMapper.hpp>
+#include <algorithm>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
 {
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		std::shared_ptr<VertexDeclaration> BuildCompressedDeclaration(const VertexDeclaration& declaration)
+		{
+			// Use predefined declarations when possible, as pipelines are cached by declaration
+			if (&declaration == VertexDeclaration::Get(VertexLayout::XYZ_Normal_UV_Tangent).get())
+				return VertexDeclaration::Get(VertexLayout::XYZ_Normal_UV_Tangent_Packed);
+
+			if (&declaration == VertexDeclaration::Get(VertexLayout::XYZ_Normal_UV_Tangent_Skinning).get())
+				return VertexDeclaration::Get(VertexLayout::XYZ_Normal_UV_Tangent_Skinning_Packed);
+
+			bool isCompressed = false;
+
+			std::vector<VertexDeclaration::ComponentEntry> components;
+			components.reserve(declaration.GetComponentCount());
+			for (const auto& component : declaration.GetComponents())
+			{
+				ComponentType type = component.type;
+				switch (component.component)
+				{
+					case VertexComponent::Color:
+						if (type == ComponentType::Color || type == ComponentType::Float4)
+							type = ComponentType::UNorm8x4;
+						break;
+
+					case VertexComponent::JointWeights:
+						if (type == ComponentType::Float4)
+							type = ComponentType::UNorm16x4;
+						break;
+
+					case VertexComponent::Normal:
+					case VertexComponent::Tangent:
+						if (type == ComponentType::Float3)
+							type = ComponentType::SNorm16x2; //< octahedral
+						break;
+
+					case VertexComponent::Position:
+						if (type == ComponentType::Float2)
+							type = ComponentType::Half2;
+						else if (type == ComponentType::Float3)
+							type = ComponentType::Half4;
+						break;
+
+					case VertexComponent::TexCoord:
+						if (type == ComponentType::Float2)
+							type = ComponentType::Half2;
+						break;
+
+					case VertexComponent::JointIndices:
+					case VertexComponent::Unused:
+					case VertexComponent::Userdata:
+						break;
+				}
+
+				isCompressed |= (type != component.type);
+				components.push_back({ component.component, type, component.componentIndex });
+			}
+
+			if (!isCompressed)
+				return nullptr;
+
+			return std::make_shared<VertexDeclaration>(declaration.GetInputRate(), components);
+		}
+	}
+
 	bool MeshParams::IsValid() const
 	{
 		if (!vertexDeclaration)
@@ -255,6 +325,82 @@ namespace Nz
 			BuildSubMesh(primitiveList.GetPrimitive(i), params);
 	}
 
+	/*!
+	* \brief Compresses the vertices of the submeshes
+	*
+	* Positions and texture coordinates are converted to half-floats, normals and tangents are octahedral-encoded in two snorm16,
+	* colors are converted to unorm8 and joint weights to unorm16, which roughly halves the vertex size.
+	* Shaders read the compressed components as floats (normals and tangents are decoded by the material shaders).
+	*
+	* \param params Parameters used to allocate the vertex buffers (bufferFactory and vertexBufferFlags are used)
+	*
+	* \remark This should be the last processing step, as functions accessing vertices as Vector3f (normal generation, simplification, recentering, ...) ignore compressed components
+	* \remark Half-floats have an 11-bit precision, which may not be enough for large meshes not centered around their origin
+	* \remark Colors are clamped to [0, 1]
+	* \remark Vertex buffers have to be readable
+	*/
+	void Mesh::CompressVertices(const MeshParams& params)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		NazaraAssert(m_isValid, "Mesh should be created first");
+
+		// Submeshes sharing a declaration also share the compressed one (keys are kept alive as submeshes are replaced)
+		std::unordered_map<std::shared_ptr<const VertexDeclaration>, std::shared_ptr<VertexDeclaration>> compressedDeclarations;
+
+		for (SubMeshData& data : m_subMeshes)
+		{
+			SubMesh& subMesh = *data.subMesh;
+
+			const std::shared_ptr<VertexBuffer>& vertexBuffer = (m_animationType == AnimationType::Skeletal) ? static_cast<SkeletalMesh&>(subMesh).GetVertexBuffer() : static_cast<StaticMesh&>(subMesh).GetVertexBuffer();
+			const std::shared_ptr<const VertexDeclaration>& vertexDeclaration = vertexBuffer->GetVertexDeclaration();
+
+			auto it = compressedDeclarations.find(vertexDeclaration);
+			if (it == compressedDeclarations.end())
+				it = compressedDeclarations.emplace(vertexDeclaration, BuildCompressedDeclaration(*vertexDeclaration)).first;
+
+			const std::shared_ptr<VertexDeclaration>& compressedDeclaration = it->second;
+			if (!compressedDeclaration)
+				continue;
+
+			UInt32 vertexCount = vertexBuffer->GetVertexCount();
+			std::vector<UInt8> compressedVertices(vertexCount * compressedDeclaration->GetStride());
+			if (vertexCount > 0)
+			{
+				BufferMapper<VertexBuffer> vertexMapper(*vertexBuffer, 0, vertexCount);
+				ConvertVertices(vertexMapper.GetPointer(), *vertexDeclaration, compressedVertices.data(), *compressedDeclaration, vertexCount);
+			}
+
+			std::shared_ptr<VertexBuffer> compressedVertexBuffer = std::make_shared<VertexBuffer>(compressedDeclaration, vertexCount, params.vertexBufferFlags, params.bufferFactory, compressedVertices.data());
+
+			std::shared_ptr<SubMesh> compressedSubMesh;
+			if (m_animationType == AnimationType::Skeletal)
+			{
+				std::shared_ptr<SkeletalMesh> skeletalMesh = std::make_shared<SkeletalMesh>(std::move(compressedVertexBuffer), subMesh.GetIndexBuffer());
+				skeletalMesh->SetAABB(subMesh.GetAABB());
+
+				compressedSubMesh = std::move(skeletalMesh);
+			}
+			else
+			{
+				std::shared_ptr<StaticMesh> staticMesh = std::make_shared<StaticMesh>(std::move(compressedVertexBuffer), subMesh.GetIndexBuffer());
+				staticMesh->SetAABB(subMesh.GetAABB());
+
+				compressedSubMesh = std::move(staticMesh);
+			}
+
+			compressedSubMesh->SetMaterialIndex(subMesh.GetMaterialIndex());
+			compressedSubMesh->SetPrimitiveMode(subMesh.GetPrimitiveMode());
+
+			// Levels of detail only reference vertices
+			for (std::size_t lodIndex = 1; lodIndex < subMesh.GetLODCount(); ++lodIndex)
+				compressedSubMesh->AddLOD(subMesh.GetLODIndexBuffer(lodIndex), subMesh.GetLODError(lodIndex));
+
+			data.subMesh = std::move(compressedSubMesh);
+			data.onSubMeshInvalidated.Connect(data.subMesh->OnSubMeshInvalidateAABB, [this](const SubMesh* /*subMesh*/) { InvalidateAABB(); });
+		}
+	}
+
 	bool Mesh::CreateSkeletal(std::size_t jointCount)
 	{
 		Destroy();
@@ -297,6 +443,82 @@ namespace Nz
 		}
 	}
 
+	/*!
+	* \brief Generates simplified levels of detail for the submeshes
+	*
+	* Each level of detail has params.lodReduction times the triangles of the previous one and is simplified from the original indices,
+	* levels are no longer generated once the simplification error would exceed params.lodMaxError or the mesh can't be simplified further.
+	* Levels of detail are stored as additional index buffers of the submeshes (see SubMesh::AddLOD), replacing the existing ones.
+	*
+	* \param params Parameters used to allocate the index buffers (bufferFactory, indexBufferFlags, lodCount, lodMaxError and lodReduction are used)
+	*
+	* \remark Only indexed triangle lists are simplified, other submeshes keep a single level of detail
+	* \remark Vertex and index buffers have to be readable
+	*/
+	void Mesh::GenerateLODs(const MeshParams& params)
+	{
+		NazaraAssert(m_isValid, "Mesh should be created first");
+		NazaraAssert(params.lodReduction > 0.f && params.lodReduction < 1.f, "LOD reduction must be in ]0, 1[");
+
+		float meshSize = GetAABB().GetLengths().GetLength();
+
+		for (SubMeshData& data : m_subMeshes)
+		{
+			SubMesh& subMesh = *data.subMesh;
+			subMesh.ClearLODs();
+
+			const std::shared_ptr<IndexBuffer>& indexBuffer = subMesh.GetIndexBuffer();
+			if (!indexBuffer || subMesh.GetPrimitiveMode() != PrimitiveMode::TriangleList || meshSize <= 0.f)
+				continue;
+
+			VertexMapper vertexMapper(subMesh);
+			SparsePtr<Vector3f> positions = vertexMapper.GetComponentPtr<Vector3f>(VertexComponent::Position);
+			if (!positions)
+				continue;
+
+			IndexMapper indexMapper(*indexBuffer);
+			UInt32 indexCount = indexMapper.GetIndexCount();
+			UInt32 vertexCount = vertexMapper.GetVertexCount();
+			IndexType indexType = indexBuffer->GetIndexType();
+
+			std::vector<UInt32> lodIndices(indexCount);
+			std::vector<UInt8> lodIndexData;
+
+			UInt32 previousIndexCount = indexCount;
+			float previousError = 0.f;
+			float targetRatio = 1.f;
+			for (UInt32 lodIndex = 0; lodIndex < params.lodCount; ++lodIndex)
+			{
+				targetRatio *= params.lodReduction;
+
+				UInt32 targetIndexCount = UInt32(float(indexCount / 3) * targetRatio) * 3;
+
+				float lodError;
+				UInt32 lodIndexCount = SimplifyMesh(indexMapper.begin(), indexCount, positions, vertexCount, targetIndexCount, params.lodMaxError * meshSize, lodIndices.data(), &lodError);
+				if (lodIndexCount == 0 || lodIndexCount >= previousIndexCount)
+					break;
+
+				lodIndexData.resize(lodIndexCount * ((indexType == IndexType::U8) ? 1 : (indexType == IndexType::U16) ? 2 : 4));
+				for (UInt32 i = 0; i < lodIndexCount; ++i)
+				{
+					UInt32 index = lodIndices[i];
+					switch (indexType)
+					{
+						case IndexType::U8:  lodIndexData[i] = SafeCast<UInt8>(index); break;
+						case IndexType::U16: reinterpret_cast<UInt16*>(lodIndexData.data())[i] = SafeCast<UInt16>(index); break;
+						case IndexType::U32: reinterpret_cast<UInt32*>(lodIndexData.data())[i] = index; break;
+					}
+				}
+
+				// Levels are simplified independently from the original mesh, keep their error monotonic
+				previousError = std::max(previousError, lodError / meshSize);
+				previousIndexCount = lodIndexCount;
+
+				subMesh.AddLOD(std::make_shared<IndexBuffer>(indexType, lodIndexCount, params.indexBufferFlags, params.bufferFactory, lodIndexData.data()), previousError);
+			}
+		}
+	}
+
 	void Mesh::GenerateNormals()
 	{
 		NazaraAssert(m_isValid, "Mesh should be created first");
@@ -496,6 +718,34 @@ namespace Nz
 		return m_isValid;
 	}
 
+	/*!
+	* \brief Optimizes the submeshes for rendering
+	*
+	* Duplicate vertices are welded, triangles are reordered for the post-transform vertex cache and to reduce overdraw,
+	* vertices are then reordered by first use (which drops unreferenced ones) for vertex fetch locality.
+	* If params.narrowIndices is set, 32-bit index buffers are narrowed to 16-bit when possible.
+	*
+	* \param params Parameters used to allocate the new buffers (bufferFactory, indexBufferFlags, vertexBufferFlags and narrowIndices are used)
+	*
+	* \remark Only indexed triangle lists are optimized, other submeshes are left untouched
+	* \remark Vertex and index buffers have to be readable
+	* \remark Optimized submeshes lose their levels of detail, which should be generated afterwards
+	*/
+	void Mesh::Optimize(const MeshParams& params)
+	{
+		NazaraAssert(m_isValid, "Mesh should be created first");
+
+		for (SubMeshData& data : m_subMeshes)
+		{
+			std::shared_ptr<SubMesh> optimizedSubMesh = OptimizeSubMesh(*data.subMesh, params);
+			if (!optimizedSubMesh)
+				continue;
+
+			data.subMesh = std::move(optimizedSubMesh);
+			data.onSubMeshInvalidated.Connect(data.subMesh->OnSubMeshInvalidateAABB, [this](const SubMesh* /*subMesh*/) { InvalidateAABB(); });
+		}
+	}
+
 	void Mesh::Recenter()
 	{
 		NazaraAssert(m_isValid, "Mesh should be created first");
@@ -624,6 +874,107 @@ namespace Nz
 		}
 	}
 
+	std::shared_ptr<SubMesh> Mesh::OptimizeSubMesh(SubMesh& subMesh, const MeshParams& params)
+	{
+		const std::shared_ptr<IndexBuffer>& indexBuffer = subMesh.GetIndexBuffer();
+		if (!indexBuffer || subMesh.GetPrimitiveMode() != PrimitiveMode::TriangleList)
+			return nullptr;
+
+		const std::shared_ptr<VertexBuffer>& vertexBuffer = (m_animationType == AnimationType::Skeletal) ? static_cast<SkeletalMesh&>(subMesh).GetVertexBuffer() : static_cast<StaticMesh&>(subMesh).GetVertexBuffer();
+		const std::shared_ptr<const VertexDeclaration>& vertexDeclaration = vertexBuffer->GetVertexDeclaration();
+
+		std::size_t stride = vertexDeclaration->GetStride();
+		UInt32 indexCount = indexBuffer->GetIndexCount();
+		UInt32 vertexCount = vertexBuffer->GetVertexCount();
+		if (indexCount < 3 || vertexCount == 0)
+			return nullptr;
+
+		std::vector<UInt8> vertices(vertexCount * stride);
+		{
+			BufferMapper<VertexBuffer> vertexMapper(*vertexBuffer, 0, vertexCount);
+			if (!vertexMapper.GetPointer())
+			{
+				NazaraError("failed to map vertex buffer");
+				return nullptr;
+			}
+
+			std::memcpy(vertices.data(), vertexMapper.GetPointer(), vertices.size());
+		}
+
+		// Weld duplicate vertices
+		std::vector<UInt32> vertexRemap(vertexCount);
+		UInt32 uniqueVertexCount = WeldVertices(vertices.data(), vertexCount, stride, vertexRemap.data());
+
+		std::vector<UInt8> uniqueVertices(uniqueVertexCount * stride);
+		for (UInt32 i = 0; i < vertexCount; ++i)
+			std::memcpy(&uniqueVertices[vertexRemap[i] * stride], &vertices[i * stride], stride);
+
+		// Reorder triangles in a temporary 32-bit software buffer
+		IndexBuffer workIndexBuffer(IndexType::U32, indexCount, BufferUsage::DirectMapping | BufferUsage::Read | BufferUsage::Write, &SoftwareBufferFactory);
+		IndexMapper workMapper(workIndexBuffer);
+		{
+			IndexMapper indexMapper(*indexBuffer);
+			for (UInt32 i = 0; i < indexCount; ++i)
+				workMapper.Set(i, vertexRemap[indexMapper.Get(i)]);
+		}
+
+		OptimizeIndices(workMapper.begin(), indexCount);
+
+		if (const auto* positionComponent = vertexDeclaration->GetComponentByType<Vector3f>(VertexComponent::Position))
+			OptimizeOverdraw(workMapper.begin(), indexCount, SparsePtr<const Vector3f>(uniqueVertices.data() + positionComponent->offset, stride));
+
+		// Reorder vertices by first use
+		UInt32 optimizedVertexCount = OptimizeVertexFetch(workMapper.begin(), indexCount, uniqueVertexCount, vertexRemap.data());
+
+		std::vector<UInt8> optimizedVertices(optimizedVertexCount * stride);
+		for (UInt32 i = 0; i < uniqueVertexCount; ++i)
+		{
+			if (vertexRemap[i] != InvalidVertexIndex)
+				std::memcpy(&optimizedVertices[vertexRemap[i] * stride], &uniqueVertices[i * stride], stride);
+		}
+
+		IndexType indexType = indexBuffer->GetIndexType();
+		if (params.narrowIndices && indexType == IndexType::U32 && optimizedVertexCount <= std::numeric_limits<UInt16>::max())
+			indexType = IndexType::U16;
+
+		// Buffers are created with their initial content, they don't need to be mappable
+		std::vector<UInt8> optimizedIndices(indexCount * ((indexType == IndexType::U8) ? 1 : (indexType == IndexType::U16) ? 2 : 4));
+		for (UInt32 i = 0; i < indexCount; ++i)
+		{
+			UInt32 index = workMapper.Get(i);
+			switch (indexType)
+			{
+				case IndexType::U8:  optimizedIndices[i] = SafeCast<UInt8>(index); break;
+				case IndexType::U16: reinterpret_cast<UInt16*>(optimizedIndices.data())[i] = SafeCast<UInt16>(index); break;
+				case IndexType::U32: reinterpret_cast<UInt32*>(optimizedIndices.data())[i] = index; break;
+			}
+		}
+
+		std::shared_ptr<VertexBuffer> optimizedVertexBuffer = std::make_shared<VertexBuffer>(vertexDeclaration, optimizedVertexCount, params.vertexBufferFlags, params.bufferFactory, optimizedVertices.data());
+		std::shared_ptr<IndexBuffer> optimizedIndexBuffer = std::make_shared<IndexBuffer>(indexType, indexCount, params.indexBufferFlags, params.bufferFactory, optimizedIndices.data());
+
+		std::shared_ptr<SubMesh> optimizedSubMesh;
+		if (m_animationType == AnimationType::Skeletal)
+		{
+			std::shared_ptr<SkeletalMesh> skeletalMesh = std::make_shared<SkeletalMesh>(std::move(optimizedVertexBuffer), std::move(optimizedIndexBuffer));
+			skeletalMesh->SetAABB(subMesh.GetAABB());
+
+			optimizedSubMesh = std::move(skeletalMesh);
+		}
+		else
+		{
+			std::shared_ptr<StaticMesh> staticMesh = std::make_shared<StaticMesh>(std::move(optimizedVertexBuffer), std::move(optimizedIndexBuffer));
+			staticMesh->SetAABB(subMesh.GetAABB());
+
+			optimizedSubMesh = std::move(staticMesh);
+		}
+
+		optimizedSubMesh->SetMaterialIndex(subMesh.GetMaterialIndex());
+		optimizedSubMesh->SetPrimitiveMode(subMesh.GetPrimitiveMode());
+
+		return optimizedSubMesh;
+	}
+
 	std::shared_ptr<Mesh> Mesh::LoadFromFile(const std::filesystem::path& filePath, const MeshParams& params)
 	{
 		Utility* utility = Utility::Instance();
@@ -3,9 +3,25 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Utility/PixelFormat.hpp>
+#include <Nazara/Core/Core.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/HardwareInfo.hpp>
 #include <Nazara/Core/StringExt.hpp>
 #include <NazaraUtils/Endianness.hpp>
+
+#if defined(NAZARA_ARCH_x86) || defined(NAZARA_ARCH_x86_64)
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#define NAZARA_UTILITY_PIXELFORMAT_SSE
+
+// SSSE3 kernels are only called after checking the CPU supports it
+#if defined(NAZARA_COMPILER_CLANG) || defined(NAZARA_COMPILER_GCC)
+#define NAZARA_UTILITY_SSSE3_TARGET __attribute__((target("ssse3")))
+#else
+#define NAZARA_UTILITY_SSSE3_TARGET
+#endif
+#endif
+
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
@@ -1370,6 +1386,111 @@ namespace Nz
 			return dst;
 		}
 
+#ifdef NAZARA_UTILITY_PIXELFORMAT_SSE
+		// SIMD kernels convert as many pixels as possible by blocks and let the scalar version handle the remaining ones
+
+		// BGRA8 <=> RGBA8
+		template<PixelFormat From, PixelFormat To>
+		UInt8* ConvertPixelsSwapRedBlueSSE2(const UInt8* start, const UInt8* end, UInt8* dst)
+		{
+			const __m128i alphaGreenMask = _mm_set1_epi32(static_cast<int>(0xFF00FF00));
+			const __m128i redBlueMask = _mm_set1_epi32(0x00FF00FF);
+
+			for (; end - start >= 16; start += 16, dst += 16)
+			{
+				__m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(start));
+				__m128i redBlue = _mm_and_si128(pixels, redBlueMask);
+				__m128i swappedRedBlue = _mm_or_si128(_mm_slli_epi32(redBlue, 16), _mm_srli_epi32(redBlue, 16));
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_or_si128(_mm_and_si128(pixels, alphaGreenMask), swappedRedBlue));
+			}
+
+			return ConvertPixels<From, To>(start, end, dst);
+		}
+
+		// BGR8/RGB8 => BGRA8/RGBA8
+		template<PixelFormat From, PixelFormat To>
+		NAZARA_UTILITY_SSSE3_TARGET UInt8* ConvertPixelsExpand24SSSE3(const UInt8* start, const UInt8* end, UInt8* dst)
+		{
+			constexpr bool swapRedBlue = (From == PixelFormat::BGR8) != (To == PixelFormat::BGRA8);
+
+			const __m128i shuffleMask = (swapRedBlue) ? _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1)
+			                                          : _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+			const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+
+			// Only 12 of the 16 loaded bytes are used, stop while the load still stays in bounds
+			for (; end - start >= 16; start += 12, dst += 16)
+			{
+				__m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(start));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_or_si128(_mm_shuffle_epi8(pixels, shuffleMask), alphaMask));
+			}
+
+			return ConvertPixels<From, To>(start, end, dst);
+		}
+
+		// BGRA8/RGBA8 => BGR8/RGB8
+		template<PixelFormat From, PixelFormat To>
+		NAZARA_UTILITY_SSSE3_TARGET UInt8* ConvertPixelsPack24SSSE3(const UInt8* start, const UInt8* end, UInt8* dst)
+		{
+			constexpr bool swapRedBlue = (From == PixelFormat::BGRA8) != (To == PixelFormat::BGR8);
+
+			const __m128i shuffleMask = (swapRedBlue) ? _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)
+			                                          : _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+
+			for (; end - start >= 16; start += 16, dst += 12)
+			{
+				__m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(start)), shuffleMask);
+
+				// Store only the 12 meaningful bytes as dst may not have room for more
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(dst), pixels);
+
+				UInt32 lastPixelBytes = static_cast<UInt32>(_mm_cvtsi128_si32(_mm_srli_si128(pixels, 8)));
+				std::memcpy(dst + 8, &lastPixelBytes, sizeof(UInt32));
+			}
+
+			return ConvertPixels<From, To>(start, end, dst);
+		}
+
+		// L8 => BGRA8/RGBA8
+		template<PixelFormat From, PixelFormat To>
+		NAZARA_UTILITY_SSSE3_TARGET UInt8* ConvertPixelsExpandLuminanceSSSE3(const UInt8* start, const UInt8* end, UInt8* dst)
+		{
+			const __m128i shuffleMasks[4] = {
+				_mm_setr_epi8(0, 0, 0, -1, 1, 1, 1, -1, 2, 2, 2, -1, 3, 3, 3, -1),
+				_mm_setr_epi8(4, 4, 4, -1, 5, 5, 5, -1, 6, 6, 6, -1, 7, 7, 7, -1),
+				_mm_setr_epi8(8, 8, 8, -1, 9, 9, 9, -1, 10, 10, 10, -1, 11, 11, 11, -1),
+				_mm_setr_epi8(12, 12, 12, -1, 13, 13, 13, -1, 14, 14, 14, -1, 15, 15, 15, -1)
+			};
+			const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+
+			for (; end - start >= 16; start += 16, dst += 64)
+			{
+				__m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(start));
+				for (std::size_t i = 0; i < 4; ++i)
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 16), _mm_or_si128(_mm_shuffle_epi8(pixels, shuffleMasks[i]), alphaMask));
+			}
+
+			return ConvertPixels<From, To>(start, end, dst);
+		}
+
+		// LA8 => BGRA8/RGBA8
+		template<PixelFormat From, PixelFormat To>
+		NAZARA_UTILITY_SSSE3_TARGET UInt8* ConvertPixelsExpandLuminanceAlphaSSSE3(const UInt8* start, const UInt8* end, UInt8* dst)
+		{
+			const __m128i lowShuffleMask = _mm_setr_epi8(0, 0, 0, 1, 2, 2, 2, 3, 4, 4, 4, 5, 6, 6, 6, 7);
+			const __m128i highShuffleMask = _mm_setr_epi8(8, 8, 8, 9, 10, 10, 10, 11, 12, 12, 12, 13, 14, 14, 14, 15);
+
+			for (; end - start >= 16; start += 16, dst += 32)
+			{
+				__m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(start));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_shuffle_epi8(pixels, lowShuffleMask));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16), _mm_shuffle_epi8(pixels, highShuffleMask));
+			}
+
+			return ConvertPixels<From, To>(start, end, dst);
+		}
+#endif
+
 		template<PixelFormat Format1, PixelFormat Format2>
 		void RegisterConverter()
 		{
@@ -1497,6 +1618,15 @@ namespace Nz
 
 		// Setup informations about every pixel format
 		SetupPixelFormat(PixelFormat::A8,               PixelFormatDescription("A8",               PixelFormatContent::ColorRGBA,    0,                  0,                  0,                  0xFF,               PixelFormatSubType::Unsigned));
+		SetupPixelFormat(PixelFormat::ASTC4x4,          PixelFormatDescription("ASTC4x4",          PixelFormatContent::ColorRGBA,    16,                                                                             PixelFormatSubType::Compressed));
+		SetupPixelFormat(PixelFormat::ASTC4x4_SRGB,     PixelFormatDescription("ASTC4x4_SRGB",     PixelFormatContent::ColorRGBA,    16,                                                                             PixelFormatSubType::Compressed));
+		SetupPixelFormat(PixelFormat::ASTC8x8,          PixelFormatDescription("ASTC8x8",          PixelFormatContent::ColorRGBA,    16,                                                                             PixelFormatSubType::Compressed));
+		SetupPixelFormat(PixelFormat::ASTC8x8_SRGB,     PixelFormatDescription("ASTC8x8_SRGB",     PixelFormatContent::ColorRGBA,    16,                                                                             PixelFormatSubType::Compressed));
+		SetupPixelFormat(PixelFormat::BC4,              PixelFormatDescription("BC4",              PixelFormatContent::ColorRGBA,    8,                                                                              PixelFormatSubType::Compressed));
+		SetupPixelFormat(PixelFormat::BC5,              PixelFormatDescription("BC5",              PixelFormatContent::ColorRGBA,    16,                                                                             PixelFormatSubType::Compressed));
+		SetupPixelFormat(PixelFormat::BC6H,             PixelFormatDescription("BC6H",             PixelFormatContent::ColorRGBA,    16,                                                                             PixelFormatSubType::Compressed));
+		SetupPixelFormat(PixelFormat::BC7,              PixelFormatDescription("BC7",              PixelFormatContent::ColorRGBA,    16,                                                                             PixelFormatSubType::Compressed));
+		SetupPixelFormat(PixelFormat::BC7_SRGB,         PixelFormatDescription("BC7_SRGB",         PixelFormatContent::ColorRGBA,    16,                                                                             PixelFormatSubType::Compressed));
 		SetupPixelFormat(PixelFormat::BGR8,             PixelFormatDescription("BGR8",             PixelFormatContent::ColorRGBA,    0x0000FF,           0x00FF00,           0xFF0000,           0,                  PixelFormatSubType::Unsigned));
 		SetupPixelFormat(PixelFormat::BGR8_SRGB,        PixelFormatDescription("BGR8_SRGB",        PixelFormatContent::ColorRGBA,    0x0000FF,           0x00FF00,           0xFF0000,           0,                  PixelFormatSubType::Unsigned));
 		SetupPixelFormat(PixelFormat::BGRA8,            PixelFormatDescription("BGRA8",            PixelFormatContent::ColorRGBA,    0x0000FF00,         0x00FF0000,         0xFF000000,         0x000000FF,         PixelFormatSubType::Unsigned));
@@ -1504,6 +1634,10 @@ namespace Nz
 		SetupPixelFormat(PixelFormat::DXT1,             PixelFormatDescription("DXT1",             PixelFormatContent::ColorRGBA,    8,                                                                              PixelFormatSubType::Compressed));
 		SetupPixelFormat(PixelFormat::DXT3,             PixelFormatDescription("DXT3",             PixelFormatContent::ColorRGBA,    16,                                                                             PixelFormatSubType::Compressed));
 		SetupPixelFormat(PixelFormat::DXT5,             PixelFormatDescription("DXT5",             PixelFormatContent::ColorRGBA,    16,                                                                             PixelFormatSubType::Compressed));
+		SetupPixelFormat(PixelFormat::ETC2_RGB8,        PixelFormatDescription("ETC2_RGB8",        PixelFormatContent::ColorRGBA,    8,                                                                              PixelFormatSubType::Compressed));
+		SetupPixelFormat(PixelFormat::ETC2_RGB8_SRGB,   PixelFormatDescription("ETC2_RGB8_SRGB",   PixelFormatContent::ColorRGBA,    8,                                                                              PixelFormatSubType::Compressed));
+		SetupPixelFormat(PixelFormat::ETC2_RGBA8,       PixelFormatDescription("ETC2_RGBA8",       PixelFormatContent::ColorRGBA,    16,                                                                             PixelFormatSubType::Compressed));
+		SetupPixelFormat(PixelFormat::ETC2_RGBA8_SRGB,  PixelFormatDescription("ETC2_RGBA8_SRGB",  PixelFormatContent::ColorRGBA,    16,                                                                             PixelFormatSubType::Compressed));
 		SetupPixelFormat(PixelFormat::L8,               PixelFormatDescription("L8",               PixelFormatContent::ColorRGBA,    0xFF,               0xFF,               0xFF,               0,                  PixelFormatSubType::Unsigned));
 		SetupPixelFormat(PixelFormat::LA8,              PixelFormatDescription("LA8",              PixelFormatContent::ColorRGBA,    0xFF00,             0xFF00,             0xFF00,             0x00FF,             PixelFormatSubType::Unsigned));
 		SetupPixelFormat(PixelFormat::R8,               PixelFormatDescription("R8",               PixelFormatContent::ColorRGBA,    0xFF,               0,                  0,                  0,                  PixelFormatSubType::Unsigned));
@@ -1788,6 +1922,35 @@ namespace Nz
 		RegisterConverter<PixelFormat::RGBA8, PixelFormat::RGBA8_SRGB>();
 		RegisterConverter<PixelFormat::RGBA8, PixelFormat::RGBA32F>();
 
+#ifdef NAZARA_UTILITY_PIXELFORMAT_SSE
+		// Override the most common conversions with SIMD versions, if the CPU supports them
+		const HardwareInfo& hardwareInfo = Core::Instance()->GetHardwareInfo();
+		if (hardwareInfo.HasCapability(ProcessorCap::SSE2))
+		{
+			SetConvertFunction(PixelFormat::BGRA8, PixelFormat::RGBA8, &ConvertPixelsSwapRedBlueSSE2<PixelFormat::BGRA8, PixelFormat::RGBA8>);
+			SetConvertFunction(PixelFormat::RGBA8, PixelFormat::BGRA8, &ConvertPixelsSwapRedBlueSSE2<PixelFormat::RGBA8, PixelFormat::BGRA8>);
+		}
+
+		if (hardwareInfo.HasCapability(ProcessorCap::SSSE3))
+		{
+			SetConvertFunction(PixelFormat::BGR8, PixelFormat::BGRA8, &ConvertPixelsExpand24SSSE3<PixelFormat::BGR8, PixelFormat::BGRA8>);
+			SetConvertFunction(PixelFormat::BGR8, PixelFormat::RGBA8, &ConvertPixelsExpand24SSSE3<PixelFormat::BGR8, PixelFormat::RGBA8>);
+			SetConvertFunction(PixelFormat::RGB8, PixelFormat::BGRA8, &ConvertPixelsExpand24SSSE3<PixelFormat::RGB8, PixelFormat::BGRA8>);
+			SetConvertFunction(PixelFormat::RGB8, PixelFormat::RGBA8, &ConvertPixelsExpand24SSSE3<PixelFormat::RGB8, PixelFormat::RGBA8>);
+
+			SetConvertFunction(PixelFormat::BGRA8, PixelFormat::BGR8, &ConvertPixelsPack24SSSE3<PixelFormat::BGRA8, PixelFormat::BGR8>);
+			SetConvertFunction(PixelFormat::BGRA8, PixelFormat::RGB8, &ConvertPixelsPack24SSSE3<PixelFormat::BGRA8, PixelFormat::RGB8>);
+			SetConvertFunction(PixelFormat::RGBA8, PixelFormat::BGR8, &ConvertPixelsPack24SSSE3<PixelFormat::RGBA8, PixelFormat::BGR8>);
+			SetConvertFunction(PixelFormat::RGBA8, PixelFormat::RGB8, &ConvertPixelsPack24SSSE3<PixelFormat::RGBA8, PixelFormat::RGB8>);
+
+			SetConvertFunction(PixelFormat::L8, PixelFormat::BGRA8, &ConvertPixelsExpandLuminanceSSSE3<PixelFormat::L8, PixelFormat::BGRA8>);
+			SetConvertFunction(PixelFormat::L8, PixelFormat::RGBA8, &ConvertPixelsExpandLuminanceSSSE3<PixelFormat::L8, PixelFormat::RGBA8>);
+
+			SetConvertFunction(PixelFormat::LA8, PixelFormat::BGRA8, &ConvertPixelsExpandLuminanceAlphaSSSE3<PixelFormat::LA8, PixelFormat::BGRA8>);
+			SetConvertFunction(PixelFormat::LA8, PixelFormat::RGBA8, &ConvertPixelsExpandLuminanceAlphaSSSE3<PixelFormat::LA8, PixelFormat::RGBA8>);
+		}
+#endif
+
 		return true;
 	}
 
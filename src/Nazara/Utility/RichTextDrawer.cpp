@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Utility/RichTextDrawer.hpp>
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <Nazara/Utility/Debug.hpp>
@@ -13,6 +14,7 @@ namespace Nz
 	m_currentColor(Color::White()),
 	m_currentOutlineColor(Color::Black()),
 	m_currentStyle(TextStyle_Regular),
+	m_firstInvalidatedBlock(0),
 	m_glyphUpdated(false),
 	m_currentCharacterSpacingOffset(0.f),
 	m_currentLineSpacingOffset(0.f),
@@ -27,6 +29,7 @@ namespace Nz
 	m_currentColor(drawer.m_currentColor),
 	m_currentOutlineColor(drawer.m_currentOutlineColor),
 	m_currentStyle(drawer.m_currentStyle),
+	m_firstInvalidatedBlock(0),
 	m_fontIndexes(drawer.m_fontIndexes),
 	m_blocks(drawer.m_blocks),
 	m_glyphUpdated(false),
@@ -104,7 +107,8 @@ namespace Nz
 		else
 			m_blocks.back().text += str;
 
-		InvalidateGlyphs();
+		// Previous blocks layout is unaffected
+		InvalidateBlocks(m_blocks.size() - 1);
 
 		return BlockRef(*this, m_blocks.size() - 1);
 	}
@@ -115,6 +119,7 @@ namespace Nz
 		m_blocks.clear();
 		m_fonts.clear();
 		m_glyphs.clear();
+		m_blockLayouts.clear();
 		ClearGlyphs();
 	}
 
@@ -196,6 +201,7 @@ namespace Nz
 			if (TestBlockProperties(m_blocks[previousBlockIndex], m_blocks[i]))
 			{
 				m_blocks[previousBlockIndex].text += m_blocks[i].text;
+				InvalidateBlocks(previousBlockIndex); //< kerning now applies between the merged texts
 
 				RemoveBlock(i);
 				--i;
@@ -216,11 +222,11 @@ namespace Nz
 
 		for (std::size_t i = index; i < m_blocks.size(); ++i)
 		{
-			assert(m_blocks[i].glyphIndex > textLength);
+			assert(m_blocks[i].glyphIndex >= textLength);
 			m_blocks[i].glyphIndex -= textLength;
 		}
 
-		InvalidateGlyphs();
+		InvalidateBlocks(index);
 	}
 
 	void RichTextDrawer::SetMaxLineWidth(float lineWidth)
@@ -262,6 +268,7 @@ namespace Nz
 	{
 		DisconnectFontSlots();
 
+		m_blockLayouts = std::move(drawer.m_blockLayouts);
 		m_blocks = std::move(drawer.m_blocks);
 		m_bounds = std::move(drawer.m_bounds);
 		m_currentCharacterSize = std::move(drawer.m_currentCharacterSize);
@@ -273,7 +280,10 @@ namespace Nz
 		m_currentOutlineThickness = std::move(drawer.m_currentOutlineThickness);
 		m_currentStyle = std::move(drawer.m_currentStyle);
 		m_drawPos = std::move(drawer.m_drawPos);
+		m_firstInvalidatedBlock = drawer.m_firstInvalidatedBlock;
 		m_fontIndexes = std::move(drawer.m_fontIndexes);
+		m_lastSeparatorGlyph = drawer.m_lastSeparatorGlyph;
+		m_lastSeparatorPosition = drawer.m_lastSeparatorPosition;
 		m_fonts = std::move(drawer.m_fonts);
 		m_glyphs = std::move(drawer.m_glyphs);
 		m_lines = std::move(drawer.m_lines);
@@ -287,8 +297,8 @@ namespace Nz
 
 	void RichTextDrawer::AppendNewLine(const Font& font, unsigned int characterSize, float lineSpacingOffset, std::size_t glyphIndex, float glyphPosition) const
 	{
-		// Ensure we're appending from last line
-		Line& lastLine = m_lines.back();
+		// Ensure we're appending from last line (by index as appending a line may reallocate)
+		std::size_t lastLineIndex = m_lines.size() - 1;
 
 		const Font::SizeInfo& sizeInfo = font.GetSizeInfo(characterSize);
 
@@ -301,9 +311,10 @@ namespace Nz
 		m_drawPos.y += lineHeight;
 		m_lastSeparatorGlyph = InvalidGlyph;
 
-		m_bounds.ExtendTo(lastLine.bounds);
+		m_bounds.ExtendTo(m_lines[lastLineIndex].bounds);
 		m_lines.emplace_back(Line{ Rectf(0.f, lineHeight * m_lines.size(), 0.f, lineHeight), m_glyphs.size() + 1 });
 
+		Line& lastLine = m_lines[lastLineIndex];
 		if (glyphIndex != InvalidGlyph && glyphIndex > lastLine.glyphIndex)
 		{
 			Line& newLine = m_lines.back();
@@ -513,6 +524,15 @@ namespace Nz
 			if (glyph.atlas == oldLayer)
 				glyph.atlas = newLayer;
 		}
+
+		for (BlockLayout& layout : m_blockLayouts)
+		{
+			for (Glyph& glyph : layout.lineGlyphs)
+			{
+				if (glyph.atlas == oldLayer)
+					glyph.atlas = newLayer;
+			}
+		}
 	}
 
 	void RichTextDrawer::OnFontInvalidated(const Font* font)
@@ -528,7 +548,7 @@ namespace Nz
 		}
 #endif
 
-		m_glyphUpdated = false;
+		InvalidateGlyphs();
 	}
 
 	void RichTextDrawer::OnFontRelease(const Font* font)
@@ -548,33 +568,80 @@ namespace Nz
 		//SetTextFont(nullptr);
 	}
 
-	void RichTextDrawer::UpdateGlyphs() const
+	void RichTextDrawer::RestoreLayout(const BlockLayout& layout) const
 	{
-		ClearGlyphs();
+		assert(layout.glyphCount <= m_glyphs.size());
+		assert(layout.lineCount > 0 && layout.lineCount <= m_lines.size());
 
-		if (!m_blocks.empty())
-		{
-			const Block& firstBlock = m_blocks.front();
+		m_glyphs.resize(layout.glyphCount);
+		std::copy(layout.lineGlyphs.begin(), layout.lineGlyphs.end(), m_glyphs.end() - layout.lineGlyphs.size());
 
-			assert(firstBlock.fontIndex < m_fonts.size());
-			const auto& firstFont = m_fonts[firstBlock.fontIndex];
+		m_lines.resize(layout.lineCount);
+		m_lines.back() = layout.line;
 
-			if (firstFont.font)
-				m_lines.emplace_back(Line{ Rectf(0.f, 0.f, 0.f, GetLineHeight(firstBlock)), 0 });
-			else
-				m_lines.emplace_back(Line{ Rectf::Zero(), 0 });
+		m_bounds = layout.bounds;
+		m_drawPos = layout.drawPos;
+		m_lastSeparatorGlyph = layout.lastSeparatorGlyph;
+		m_lastSeparatorPosition = layout.lastSeparatorPosition;
+	}
 
-			m_drawPos = Vector2f(0.f, SafeCast<float>(firstBlock.characterSize));
+	void RichTextDrawer::SaveLayout(BlockLayout& layout) const
+	{
+		const Line& line = m_lines.back();
+		std::size_t lineFirstGlyph = std::min(line.glyphIndex, m_glyphs.size());
+
+		layout.bounds = m_bounds;
+		layout.drawPos = m_drawPos;
+		layout.glyphCount = m_glyphs.size();
+		layout.lastSeparatorGlyph = m_lastSeparatorGlyph;
+		layout.lastSeparatorPosition = m_lastSeparatorPosition;
+		layout.line = line;
+		layout.lineCount = m_lines.size();
+		layout.lineGlyphs.assign(m_glyphs.begin() + lineFirstGlyph, m_glyphs.end());
+	}
 
-			for (const Block& block : m_blocks)
+	void RichTextDrawer::UpdateGlyphs() const
+	{
+		// Blocks are laid out sequentially, resume from the layout state saved before the first invalidated block
+		std::size_t firstBlockIndex = std::min(m_firstInvalidatedBlock, m_blockLayouts.size());
+		if (firstBlockIndex == 0)
+		{
+			ClearGlyphs();
+			if (!m_blocks.empty())
 			{
-				assert(block.fontIndex < m_fonts.size());
-				const auto& fontData = m_fonts[block.fontIndex];
+				const Block& firstBlock = m_blocks.front();
+
+				assert(firstBlock.fontIndex < m_fonts.size());
+				const auto& firstFont = m_fonts[firstBlock.fontIndex];
 
-				GenerateGlyphs(*fontData.font, block.color, block.style, block.characterSize, block.outlineColor, block.outlineThickness, block.characterSpacingOffset, block.lineSpacingOffset, block.text);
+				if (firstFont.font)
+					m_lines.emplace_back(Line{ Rectf(0.f, 0.f, 0.f, GetLineHeight(firstBlock)), 0 });
+				else
+					m_lines.emplace_back(Line{ Rectf::Zero(), 0 });
+
+				m_drawPos = Vector2f(0.f, SafeCast<float>(firstBlock.characterSize));
 			}
+			else
+				m_lines.emplace_back(Line{ Rectf::Zero(), 0 }); //< Ensure there's always a line
 		}
-		else
-			m_lines.emplace_back(Line{ Rectf::Zero(), 0 }); //< Ensure there's always a line
+		else if (firstBlockIndex < m_blockLayouts.size())
+			RestoreLayout(m_blockLayouts[firstBlockIndex]);
+
+		m_blockLayouts.resize(firstBlockIndex);
+		m_blockLayouts.reserve(m_blocks.size());
+
+		for (std::size_t blockIndex = firstBlockIndex; blockIndex < m_blocks.size(); ++blockIndex)
+		{
+			const Block& block = m_blocks[blockIndex];
+			SaveLayout(m_blockLayouts.emplace_back());
+
+			assert(block.fontIndex < m_fonts.size());
+			const auto& fontData = m_fonts[block.fontIndex];
+
+			GenerateGlyphs(*fontData.font, block.color, block.style, block.characterSize, block.outlineColor, block.outlineThickness, block.characterSpacingOffset, block.lineSpacingOffset, block.text);
+		}
+
+		m_firstInvalidatedBlock = InvalidBlockIndex;
+		m_glyphUpdated = true;
 	}
 }
@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Utility/SimpleTextDrawer.hpp>
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <Nazara/Utility/Debug.hpp>
@@ -38,7 +39,8 @@ namespace Nz
 	{
 		if (!m_glyphUpdated)
 			UpdateGlyphs();
-		else if (!m_colorUpdated)
+
+		if (!m_colorUpdated)
 			UpdateGlyphColor();
 
 		return m_glyphs[index];
@@ -76,8 +78,8 @@ namespace Nz
 
 	void SimpleTextDrawer::AppendNewLine(std::size_t glyphIndex, float glyphPosition) const
 	{
-		// Ensure we're appending from last line
-		Line& lastLine = m_lines.back();
+		// Ensure we're appending from last line (by index as appending a line may reallocate)
+		std::size_t lastLineIndex = m_lines.size() - 1;
 
 		float previousDrawPos = m_drawPos.x;
 
@@ -88,9 +90,10 @@ namespace Nz
 		m_drawPos.y += lineHeight;
 		m_lastSeparatorGlyph = InvalidGlyph;
 
-		m_bounds.ExtendTo(lastLine.bounds);
+		m_bounds.ExtendTo(m_lines[lastLineIndex].bounds);
 		m_lines.emplace_back(Line{ Rectf(0.f, lineHeight * m_lines.size(), 0.f, lineHeight), m_glyphs.size() + 1 });
 
+		Line& lastLine = m_lines[lastLineIndex];
 		if (glyphIndex != InvalidGlyph && glyphIndex > lastLine.glyphIndex)
 		{
 			Line& newLine = m_lines.back();
@@ -129,6 +132,7 @@ namespace Nz
 		m_colorUpdated = true;
 		m_drawPos = Vector2f(0.f, SafeCast<float>(m_characterSize)); //< Our draw "cursor"
 		m_lastSeparatorGlyph = InvalidGlyph;
+		m_lineLayouts.clear();
 		m_lines.clear();
 		m_glyphs.clear();
 		m_glyphUpdated = true;
@@ -180,13 +184,16 @@ namespace Nz
 			return false;
 	};
 
-	void SimpleTextDrawer::GenerateGlyphs(std::string_view text) const
+	void SimpleTextDrawer::GenerateGlyphs(std::size_t textOffset, std::size_t textLength) const
 	{
+		std::string_view text = std::string_view(m_text).substr(textOffset, textLength);
 		if (text.empty())
 			return;
 
 		const Font::SizeInfo& sizeInfo = m_font->GetSizeInfo(m_characterSize);
 
+		// '\n' can't appear inside an UTF-8 sequence, which allows to track line breaks offsets
+		std::size_t lineBreakOffset = textOffset;
 
 		IterateOnCodepoints(text, [&](const char32_t* characters, std::size_t characterCount)
 		{
@@ -242,6 +249,7 @@ namespace Nz
 
 					glyph.atlas = nullptr;
 					glyph.bounds = Rectf(m_drawPos.x, m_lines.back().bounds.y, advance, GetLineHeight(sizeInfo));
+					glyph.renderOrder = 0;
 
 					glyph.corners[0] = glyph.bounds.GetCorner(RectCorner::LeftTop);
 					glyph.corners[1] = glyph.bounds.GetCorner(RectCorner::RightTop);
@@ -271,6 +279,23 @@ namespace Nz
 				}
 
 				m_glyphs.push_back(glyph);
+
+				if (character == '\n')
+				{
+					lineBreakOffset = m_text.find('\n', lineBreakOffset);
+					assert(lineBreakOffset != std::string::npos);
+					lineBreakOffset++;
+
+					LineLayout& lineLayout = m_lineLayouts.emplace_back();
+					lineLayout.bounds = m_bounds;
+					lineLayout.drawPos = m_drawPos;
+					lineLayout.glyphCount = m_glyphs.size();
+					lineLayout.lastSeparatorGlyph = m_lastSeparatorGlyph;
+					lineLayout.lastSeparatorPosition = m_lastSeparatorPosition;
+					lineLayout.line = m_lines.back();
+					lineLayout.lineCount = m_lines.size();
+					lineLayout.textOffset = lineBreakOffset;
+				}
 			}
 
 			return true; //< continue iteration
@@ -278,7 +303,6 @@ namespace Nz
 
 		m_bounds.ExtendTo(m_lines.back().bounds);
 
-		m_colorUpdated = true;
 		m_glyphUpdated = true;
 	}
 
@@ -333,4 +357,169 @@ namespace Nz
 
 		SetTextFont(nullptr);
 	}
+
+	void SimpleTextDrawer::UpdateGlyphs() const
+	{
+		NazaraAssert(m_font && m_font->IsValid(), "Invalid font");
+
+		if (m_pendingEdit)
+		{
+			TextEdit edit = *m_pendingEdit;
+			m_pendingEdit.reset();
+
+			if (UpdateGlyphsAfterEdit(edit))
+				return;
+		}
+
+		// Resume layout from the last line break before the first modified character
+		auto it = std::upper_bound(m_lineLayouts.begin(), m_lineLayouts.end(), m_firstInvalidatedTextOffset, [](std::size_t textOffset, const LineLayout& lineLayout)
+		{
+			return textOffset < lineLayout.textOffset;
+		});
+
+		m_firstInvalidatedTextOffset = std::numeric_limits<std::size_t>::max();
+
+		if (it == m_lineLayouts.begin())
+		{
+			ClearGlyphs();
+			GenerateGlyphs(0);
+			return;
+		}
+
+		const LineLayout& lineLayout = *--it;
+		assert(lineLayout.glyphCount <= m_glyphs.size());
+		assert(lineLayout.lineCount <= m_lines.size());
+
+		m_bounds = lineLayout.bounds;
+		m_drawPos = lineLayout.drawPos;
+		m_glyphs.resize(lineLayout.glyphCount);
+		m_lastSeparatorGlyph = lineLayout.lastSeparatorGlyph;
+		m_lastSeparatorPosition = lineLayout.lastSeparatorPosition;
+		m_lines.resize(lineLayout.lineCount);
+		m_lines.back() = lineLayout.line;
+		m_previousCharacter = '\n';
+
+		std::size_t textOffset = lineLayout.textOffset;
+		m_lineLayouts.erase(it + 1, m_lineLayouts.end());
+
+		m_glyphUpdated = true;
+		if (textOffset < m_text.size())
+			GenerateGlyphs(textOffset);
+		else
+			m_bounds.ExtendTo(m_lines.back().bounds); //< text ends with this line break
+	}
+
+	bool SimpleTextDrawer::UpdateGlyphsAfterEdit(const TextEdit& edit) const
+	{
+		// Lines following the first line break after the edited text keep the same layout, only shifted vertically
+		// so only the lines between the line break preceding the edit and the one following it have to be laid out again
+		std::size_t editEnd = edit.textOffset + edit.removedLength;
+
+		auto resumeIt = std::upper_bound(m_lineLayouts.begin(), m_lineLayouts.end(), edit.textOffset, [](std::size_t textOffset, const LineLayout& lineLayout)
+		{
+			return textOffset < lineLayout.textOffset;
+		});
+
+		auto reuseIt = std::upper_bound(resumeIt, m_lineLayouts.end(), editEnd, [](std::size_t textOffset, const LineLayout& lineLayout)
+		{
+			return textOffset < lineLayout.textOffset;
+		});
+
+		if (resumeIt == m_lineLayouts.begin() || reuseIt == m_lineLayouts.end())
+			return false; //< nothing to resume from or to reuse, perform a regular layout
+
+		LineLayout resumeLayout = *(resumeIt - 1);
+		LineLayout reuseLayout = *reuseIt;
+
+		// Save the layout of the lines following the edit
+		std::vector<Glyph> reusedGlyphs(m_glyphs.begin() + reuseLayout.glyphCount, m_glyphs.end());
+		std::vector<Line> reusedLines(m_lines.begin() + (reuseLayout.lineCount - 1), m_lines.end());
+		std::vector<LineLayout> reusedLineLayouts(reuseIt + 1, m_lineLayouts.end());
+		std::size_t lastSeparatorGlyph = m_lastSeparatorGlyph;
+		float lastSeparatorPosition = m_lastSeparatorPosition;
+		UInt32 previousCharacter = m_previousCharacter;
+		Vector2f drawPos = m_drawPos;
+
+		// Lay out the edited lines
+		m_bounds = resumeLayout.bounds;
+		m_drawPos = resumeLayout.drawPos;
+		m_glyphs.resize(resumeLayout.glyphCount);
+		m_lastSeparatorGlyph = resumeLayout.lastSeparatorGlyph;
+		m_lastSeparatorPosition = resumeLayout.lastSeparatorPosition;
+		m_lines.resize(resumeLayout.lineCount);
+		m_lines.back() = resumeLayout.line;
+		m_previousCharacter = '\n';
+
+		std::size_t textOffset = resumeLayout.textOffset;
+		std::size_t reuseTextOffset = reuseLayout.textOffset - edit.removedLength + edit.insertedLength;
+		m_lineLayouts.erase(resumeIt, m_lineLayouts.end());
+
+		m_firstInvalidatedTextOffset = std::numeric_limits<std::size_t>::max();
+		m_glyphUpdated = true;
+
+		GenerateGlyphs(textOffset, reuseTextOffset - textOffset);
+
+		LineLayout newReuseLayout = m_lineLayouts.back();
+		assert(newReuseLayout.textOffset == reuseTextOffset);
+
+		// Append the previous layout of the following lines, with shifted indices and positions
+		float offsetY = newReuseLayout.drawPos.y - reuseLayout.drawPos.y;
+		auto RemapGlyphIndex = [&](std::size_t glyphIndex)
+		{
+			// Unsigned arithmetic wraps around, giving the right index even if fewer glyphs precede the reused lines
+			return (glyphIndex != InvalidGlyph) ? glyphIndex - reuseLayout.glyphCount + newReuseLayout.glyphCount : InvalidGlyph;
+		};
+
+		auto ShiftLine = [&](Line line)
+		{
+			line.bounds.y += offsetY;
+			line.glyphIndex = RemapGlyphIndex(line.glyphIndex);
+			return line;
+		};
+
+		m_glyphs.reserve(m_glyphs.size() + reusedGlyphs.size());
+		for (Glyph& glyph : reusedGlyphs)
+		{
+			glyph.bounds.y += offsetY;
+			for (auto& corner : glyph.corners)
+				corner.y += offsetY;
+
+			m_glyphs.push_back(glyph);
+		}
+
+		m_lines.back() = ShiftLine(reusedLines.front());
+		for (std::size_t i = 1; i < reusedLines.size(); ++i)
+			m_lines.push_back(ShiftLine(reusedLines[i]));
+
+		// Layout bounds include every line preceding their own, extend them line by line
+		Rectf bounds = newReuseLayout.bounds;
+		std::size_t boundsLineCount = newReuseLayout.lineCount - 1;
+		for (LineLayout& lineLayout : reusedLineLayouts)
+		{
+			lineLayout.drawPos.y += offsetY;
+			lineLayout.glyphCount = RemapGlyphIndex(lineLayout.glyphCount);
+			lineLayout.lastSeparatorGlyph = RemapGlyphIndex(lineLayout.lastSeparatorGlyph);
+			lineLayout.line = ShiftLine(lineLayout.line);
+			lineLayout.lineCount = lineLayout.lineCount - reuseLayout.lineCount + newReuseLayout.lineCount;
+			lineLayout.textOffset = lineLayout.textOffset - reuseLayout.textOffset + reuseTextOffset;
+
+			for (; boundsLineCount < lineLayout.lineCount - 1; ++boundsLineCount)
+				bounds.ExtendTo(m_lines[boundsLineCount].bounds);
+
+			lineLayout.bounds = bounds;
+
+			m_lineLayouts.push_back(lineLayout);
+		}
+
+		for (; boundsLineCount < m_lines.size(); ++boundsLineCount)
+			bounds.ExtendTo(m_lines[boundsLineCount].bounds);
+
+		m_bounds = bounds;
+		m_drawPos = Vector2f(drawPos.x, drawPos.y + offsetY);
+		m_lastSeparatorGlyph = RemapGlyphIndex(lastSeparatorGlyph);
+		m_lastSeparatorPosition = lastSeparatorPosition;
+		m_previousCharacter = previousCharacter;
+
+		return true;
+	}
 }
@@ -0,0 +1,221 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/SkeletalPose.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Utility/Joint.hpp>
+#include <Nazara/Utility/Skeleton.hpp>
+#include <cmath>
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		// Those loops work on plain floats without branches so they can be vectorized by the compiler
+
+		void LerpVectors(const Vector3f* from, const Vector3f* to, float interpolation, Vector3f* result, std::size_t count)
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				result[i].x = from[i].x + (to[i].x - from[i].x) * interpolation;
+				result[i].y = from[i].y + (to[i].y - from[i].y) * interpolation;
+				result[i].z = from[i].z + (to[i].z - from[i].z) * interpolation;
+			}
+		}
+
+		// Normalized lerp taking the shortest path, close enough to a slerp for blending animation poses and much cheaper
+		void NlerpQuaternions(const Quaternionf* from, const Quaternionf* to, float interpolation, Quaternionf* result, std::size_t count)
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				float dot = from[i].w * to[i].w + from[i].x * to[i].x + from[i].y * to[i].y + from[i].z * to[i].z;
+				float sign = (dot < 0.f) ? -1.f : 1.f;
+				float fromWeight = 1.f - interpolation;
+				float toWeight = interpolation * sign;
+
+				float w = from[i].w * fromWeight + to[i].w * toWeight;
+				float x = from[i].x * fromWeight + to[i].x * toWeight;
+				float y = from[i].y * fromWeight + to[i].y * toWeight;
+				float z = from[i].z * fromWeight + to[i].z * toWeight;
+
+				float invLength = 1.f / std::sqrt(w * w + x * x + y * y + z * z);
+				result[i].w = w * invLength;
+				result[i].x = x * invLength;
+				result[i].y = y * invLength;
+				result[i].z = z * invLength;
+			}
+		}
+	}
+
+	/*!
+	* \brief Constructs a pose of jointCount joints in their identity transform
+	*/
+	SkeletalPose::SkeletalPose(std::size_t jointCount)
+	{
+		Reset(jointCount);
+	}
+
+	/*!
+	* \brief Constructs a pose from the local transforms of the skeleton joints
+	*/
+	SkeletalPose::SkeletalPose(const Skeleton& skeleton)
+	{
+		NazaraAssert(skeleton.IsValid(), "invalid skeleton");
+
+		std::size_t jointCount = skeleton.GetJointCount();
+		m_positions.resize(jointCount);
+		m_rotations.resize(jointCount);
+		m_scales.resize(jointCount);
+
+		const Joint* joints = skeleton.GetJoints();
+		for (std::size_t i = 0; i < jointCount; ++i)
+		{
+			m_positions[i] = joints[i].GetPosition();
+			m_rotations[i] = joints[i].GetRotation();
+			m_scales[i] = joints[i].GetScale();
+		}
+	}
+
+	/*!
+	* \brief Blends this pose toward another one
+	*
+	* \param pose Pose to blend with, must have the same joint count
+	* \param weight Weight of the other pose, from zero (this pose is kept) to one (this pose is replaced)
+	*/
+	void SkeletalPose::Blend(const SkeletalPose& pose, float weight)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		NazaraAssert(pose.GetJointCount() == GetJointCount(), "poses must have the same joint count");
+
+		std::size_t jointCount = GetJointCount();
+		LerpVectors(m_positions.data(), pose.m_positions.data(), weight, m_positions.data(), jointCount);
+		NlerpQuaternions(m_rotations.data(), pose.m_rotations.data(), weight, m_rotations.data(), jointCount);
+		LerpVectors(m_scales.data(), pose.m_scales.data(), weight, m_scales.data(), jointCount);
+	}
+
+	/*!
+	* \brief Blends this pose toward another one with a per-joint weight, used for layered animations (e.g. upper body)
+	*
+	* \param pose Pose to blend with, must have the same joint count
+	* \param weight Global weight of the other pose
+	* \param jointWeights Per-joint weights (multiplied by weight), there must be one per joint
+	*/
+	void SkeletalPose::Blend(const SkeletalPose& pose, float weight, const float* jointWeights)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		NazaraAssert(pose.GetJointCount() == GetJointCount(), "poses must have the same joint count");
+		NazaraAssert(jointWeights, "invalid joint weights");
+
+		std::size_t jointCount = GetJointCount();
+		for (std::size_t i = 0; i < jointCount; ++i)
+		{
+			float jointWeight = weight * jointWeights[i];
+			if (jointWeight <= 0.f)
+				continue;
+
+			LerpVectors(&m_positions[i], &pose.m_positions[i], jointWeight, &m_positions[i], 1);
+			NlerpQuaternions(&m_rotations[i], &pose.m_rotations[i], jointWeight, &m_rotations[i], 1);
+			LerpVectors(&m_scales[i], &pose.m_scales[i], jointWeight, &m_scales[i], 1);
+		}
+	}
+
+	/*!
+	* \brief Computes the model-space transforms of the joints from their local transforms
+	*
+	* Joint transforms are concatenated the same way nodes are, with joints inheriting position, rotation and scale from their parent.
+	*
+	* \param parentIndices Parent index of every joint (or NoParent), parents must come before their children
+	* \param modelPose Output pose, resized if required (it must not be this pose)
+	*/
+	void SkeletalPose::ComputeModelPose(const std::size_t* parentIndices, SkeletalPose& modelPose) const
+	{
+		NazaraAssert(parentIndices, "invalid parent indices");
+		NazaraAssert(&modelPose != this, "model pose must be a different pose");
+
+		std::size_t jointCount = GetJointCount();
+		modelPose.m_positions.resize(jointCount);
+		modelPose.m_rotations.resize(jointCount);
+		modelPose.m_scales.resize(jointCount);
+
+		for (std::size_t i = 0; i < jointCount; ++i)
+		{
+			std::size_t parentIndex = parentIndices[i];
+			if (parentIndex != NoParent)
+			{
+				NazaraAssert(parentIndex < i, "parents must come before their children");
+
+				const Vector3f& parentPosition = modelPose.m_positions[parentIndex];
+				const Quaternionf& parentRotation = modelPose.m_rotations[parentIndex];
+				const Vector3f& parentScale = modelPose.m_scales[parentIndex];
+
+				// Same as Node::UpdateDerived
+				modelPose.m_positions[i] = parentRotation * (parentScale * m_positions[i]) + parentPosition;
+				modelPose.m_rotations[i] = parentRotation * Quaternionf::Mirror(m_rotations[i], parentScale);
+				modelPose.m_rotations[i].Normalize();
+				modelPose.m_scales[i] = m_scales[i] * parentScale;
+			}
+			else
+			{
+				modelPose.m_positions[i] = m_positions[i];
+				modelPose.m_rotations[i] = m_rotations[i];
+				modelPose.m_scales[i] = m_scales[i];
+			}
+		}
+	}
+
+	/*!
+	* \brief Computes the skinning matrices of a model-space pose (see ComputeModelPose)
+	*
+	* \param inverseBindMatrices Inverse bind matrix of every joint
+	* \param skinningMatrices Output skinning matrices, there must be room for one per joint
+	*/
+	void SkeletalPose::ComputeSkinningMatrices(const Matrix4f* inverseBindMatrices, Matrix4f* skinningMatrices) const
+	{
+		NazaraAssert(inverseBindMatrices, "invalid inverse bind matrices");
+		NazaraAssert(skinningMatrices, "invalid skinning matrices");
+
+		std::size_t jointCount = GetJointCount();
+		for (std::size_t i = 0; i < jointCount; ++i)
+			skinningMatrices[i] = Matrix4f::Transform(m_positions[i], m_rotations[i], m_scales[i]);
+
+		Matrix4f::ConcatenateTransform(inverseBindMatrices, skinningMatrices, skinningMatrices, jointCount);
+	}
+
+	/*!
+	* \brief Resets the pose to jointCount joints in their identity transform
+	*/
+	void SkeletalPose::Reset(std::size_t jointCount)
+	{
+		m_positions.assign(jointCount, Vector3f::Zero());
+		m_rotations.assign(jointCount, Quaternionf::Identity());
+		m_scales.assign(jointCount, Vector3f::Unit());
+	}
+
+	/*!
+	* \brief Interpolates two poses into another one
+	*
+	* \param poseA First pose
+	* \param poseB Second pose, must have the same joint count as the first one
+	* \param interpolation Interpolation factor between the two poses
+	* \param result Output pose, resized if required (it may be one of the input poses)
+	*/
+	void SkeletalPose::Interpolate(const SkeletalPose& poseA, const SkeletalPose& poseB, float interpolation, SkeletalPose& result)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		NazaraAssert(poseA.GetJointCount() == poseB.GetJointCount(), "poses must have the same joint count");
+
+		std::size_t jointCount = poseA.GetJointCount();
+		result.m_positions.resize(jointCount);
+		result.m_rotations.resize(jointCount);
+		result.m_scales.resize(jointCount);
+
+		LerpVectors(poseA.m_positions.data(), poseB.m_positions.data(), interpolation, result.m_positions.data(), jointCount);
+		NlerpQuaternions(poseA.m_rotations.data(), poseB.m_rotations.data(), interpolation, result.m_rotations.data(), jointCount);
+		LerpVectors(poseA.m_scales.data(), poseB.m_scales.data(), interpolation, result.m_scales.data(), jointCount);
+	}
+}
@@ -4,6 +4,10 @@
 
 #include <Nazara/Utility/Skeleton.hpp>
 #include <Nazara/Utility/Joint.hpp>
+#include <Nazara/Utility/SkeletalPose.hpp>
+#include <algorithm>
+#include <functional>
+#include <limits>
 #include <unordered_map>
 #include <Nazara/Utility/Debug.hpp>
 
@@ -78,7 +82,7 @@ namespace Nz
 		auto it = m_impl->jointMap.find(jointName);
 		NazaraAssert(it != m_impl->jointMap.end(), "joint not found");
 
-		InvalidateJoints();
+		InvalidateJointHierarchy(it->second);
 		return &m_impl->joints[it->second];
 	}
 
@@ -87,7 +91,7 @@ namespace Nz
 		NazaraAssert(m_impl, "skeleton must have been created");
 		NazaraAssert(index < m_impl->joints.size(), "joint index out of range");
 
-		InvalidateJoints();
+		InvalidateJointHierarchy(index);
 		return &m_impl->joints[index];
 	}
 
@@ -184,6 +188,12 @@ namespace Nz
 		NazaraAssert(skeletonB.IsValid(), "second skeleton is invalid");
 		NazaraAssert(skeletonA.GetJointCount() == skeletonB.GetJointCount() && m_impl->joints.size() == skeletonA.GetJointCount(), "both skeletons must have the same number of joints");
 
+		if (indiceCount == 0)
+			return;
+
+		std::size_t firstJoint = std::numeric_limits<std::size_t>::max();
+		std::size_t lastJoint = 0;
+
 		const Joint* jointsA = &skeletonA.m_impl->joints[0];
 		const Joint* jointsB = &skeletonB.m_impl->joints[0];
 		for (std::size_t i = 0; i < indiceCount; ++i)
@@ -192,9 +202,10 @@ namespace Nz
 			NazaraAssert(index < m_impl->joints.size(), "joint index out of range");
 
 			m_impl->joints[index].Interpolate(jointsA[index], jointsB[index], interpolation, CoordSys::Local);
+			ExtendJointHierarchyRange(index, firstJoint, lastJoint);
 		}
 
-		InvalidateJoints();
+		InvalidateJoints(firstJoint, lastJoint - firstJoint + 1);
 	}
 
 	bool Skeleton::IsValid() const
@@ -202,6 +213,22 @@ namespace Nz
 		return m_impl != nullptr;
 	}
 
+	void Skeleton::SetPose(const SkeletalPose& pose)
+	{
+		NazaraAssert(m_impl, "skeleton must have been created");
+		NazaraAssert(pose.GetJointCount() == m_impl->joints.size(), "pose joint count must match skeleton joint count");
+
+		const Vector3f* positions = pose.GetPositions();
+		const Quaternionf* rotations = pose.GetRotations();
+		const Vector3f* scales = pose.GetScales();
+
+		// Every joint is updated so there's no need to invalidate recursively
+		for (std::size_t i = 0; i < m_impl->joints.size(); ++i)
+			m_impl->joints[i].SetTransform(positions[i], rotations[i], scales[i], CoordSys::Local, Node::Invalidation::InvalidateNodeOnly);
+
+		InvalidateJoints();
+	}
+
 	Skeleton& Skeleton::operator=(const Skeleton& skeleton)
 	{
 		if (this == &skeleton)
@@ -236,11 +263,46 @@ namespace Nz
 
 	Skeleton& Skeleton::operator=(Skeleton&&) noexcept = default;
 
+	void Skeleton::ExtendJointHierarchyRange(std::size_t jointIndex, std::size_t& firstJoint, std::size_t& lastJoint) const
+	{
+		firstJoint = std::min(firstJoint, jointIndex);
+		lastJoint = std::max(lastJoint, jointIndex);
+
+		// Children can also be nodes attached to a joint which are not part of the skeleton
+		const Node* jointBegin = m_impl->joints.data();
+		const Node* jointEnd = jointBegin + m_impl->joints.size();
+
+		std::less<const Node*> lessThan;
+		for (const Node* child : m_impl->joints[jointIndex].GetChilds())
+		{
+			if (lessThan(child, jointBegin) || !lessThan(child, jointEnd))
+				continue;
+
+			ExtendJointHierarchyRange(SafeCast<std::size_t>(static_cast<const Joint*>(child) - m_impl->joints.data()), firstJoint, lastJoint);
+		}
+	}
+
+	void Skeleton::InvalidateJointHierarchy(std::size_t jointIndex)
+	{
+		// Modifying a joint changes the skinning matrix of all its descendants
+		std::size_t firstJoint = jointIndex;
+		std::size_t lastJoint = jointIndex;
+		ExtendJointHierarchyRange(jointIndex, firstJoint, lastJoint);
+
+		InvalidateJoints(firstJoint, lastJoint - firstJoint + 1);
+	}
+
 	void Skeleton::InvalidateJoints()
 	{
+		InvalidateJoints(0, m_impl->joints.size());
+	}
+
+	void Skeleton::InvalidateJoints(std::size_t firstJoint, std::size_t jointCount)
+	{
+		assert(firstJoint + jointCount <= m_impl->joints.size());
 		m_impl->aabbUpdated = false;
 
-		OnSkeletonJointsInvalidated(this);
+		OnSkeletonJointsInvalidated(this, firstJoint, jointCount);
 	}
 
 	void Skeleton::InvalidateJointMap()
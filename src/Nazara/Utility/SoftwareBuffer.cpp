@@ -4,6 +4,7 @@
 
 #include <Nazara/Utility/SoftwareBuffer.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/MemoryTracker.hpp>
 #include <cstring>
 #include <exception>
 #include <Nazara/Utility/Debug.hpp>
@@ -17,6 +18,13 @@ namespace Nz
 		m_buffer = std::make_unique<UInt8[]>(size);
 		if (initialData)
 			std::memcpy(&m_buffer[0], initialData, size);
+
+		NazaraTrackAllocation(MemoryTag::Utility, size);
+	}
+
+	SoftwareBuffer::~SoftwareBuffer()
+	{
+		NazaraTrackDeallocation(MemoryTag::Utility, GetSize());
 	}
 
 	bool SoftwareBuffer::Fill(const void* data, UInt64 offset, UInt64 size)
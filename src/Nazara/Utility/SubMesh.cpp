@@ -19,6 +19,29 @@ namespace Nz
 
 	SubMesh::~SubMesh() = default;
 
+	/*!
+	* \brief Adds a simplified level of detail to the submesh
+	*
+	* Levels of detail share the vertices of the submesh and only replace its indices, they should be added from the most detailed to the least detailed.
+	*
+	* \param indexBuffer Index buffer of the level of detail
+	* \param error Simplification error of the level of detail, relative to the mesh size (length of its AABB diagonal)
+	*/
+	void SubMesh::AddLOD(std::shared_ptr<IndexBuffer> indexBuffer, float error)
+	{
+		NazaraAssert(indexBuffer, "invalid index buffer");
+		NazaraAssert(m_levelsOfDetail.empty() || m_levelsOfDetail.back().error <= error, "levels of detail must be added from the most detailed to the least detailed");
+
+		auto& levelOfDetail = m_levelsOfDetail.emplace_back();
+		levelOfDetail.indexBuffer = std::move(indexBuffer);
+		levelOfDetail.error = error;
+	}
+
+	void SubMesh::ClearLODs()
+	{
+		m_levelsOfDetail.clear();
+	}
+
 	void SubMesh::GenerateNormals()
 	{
 		VertexMapper mapper(*this);
@@ -189,6 +212,27 @@ namespace Nz
 		return 0;
 	}
 
+	/*!
+	* \brief Gets the number of levels of detail of the submesh
+	* \return Level of detail count, including the submesh itself (level zero)
+	*/
+	std::size_t SubMesh::GetLODCount() const
+	{
+		return m_levelsOfDetail.size() + 1;
+	}
+
+	float SubMesh::GetLODError(std::size_t lodIndex) const
+	{
+		NazaraAssert(lodIndex < GetLODCount(), "level of detail out of range");
+		return (lodIndex > 0) ? m_levelsOfDetail[lodIndex - 1].error : 0.f;
+	}
+
+	const std::shared_ptr<IndexBuffer>& SubMesh::GetLODIndexBuffer(std::size_t lodIndex) const
+	{
+		NazaraAssert(lodIndex < GetLODCount(), "level of detail out of range");
+		return (lodIndex > 0) ? m_levelsOfDetail[lodIndex - 1].indexBuffer : GetIndexBuffer();
+	}
+
 	std::size_t SubMesh::GetMaterialIndex() const
 	{
 		return m_matIndex;
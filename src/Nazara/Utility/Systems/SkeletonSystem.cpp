@@ -7,6 +7,7 @@
 #include <Nazara/Utility/Components/NodeComponent.hpp>
 #include <Nazara/Utility/Components/SharedSkeletonComponent.hpp>
 #include <Nazara/Utility/Components/SkeletonComponent.hpp>
+#include <algorithm>
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
@@ -16,6 +17,9 @@ namespace Nz
 	m_sharedSkeletonConstructObserver(registry, entt::collector.group<NodeComponent, SharedSkeletonComponent>(entt::exclude<SkeletonComponent>)),
 	m_skeletonConstructObserver(registry, entt::collector.group<NodeComponent, SkeletonComponent>(entt::exclude<SharedSkeletonComponent>))
 	{
+		m_disabledDestroyConnection = registry.on_destroy<DisabledComponent>().connect<&SkeletonSystem::OnDisabledDestroy>(this);
+		m_nodeDestroyConnection = registry.on_destroy<NodeComponent>().connect<&SkeletonSystem::OnNodeDestroy>(this);
+		m_sharedSkeletonDestroyConnection = registry.on_destroy<SharedSkeletonComponent>().connect<&SkeletonSystem::OnSharedSkeletonDestroy>(this);
 	}
 
 	SkeletonSystem::~SkeletonSystem()
@@ -32,6 +36,8 @@ namespace Nz
 			SharedSkeletonComponent& entitySkeleton = m_registry.get<SharedSkeletonComponent>(entity);
 
 			entitySkeleton.SetSkeletonParent(&entityNode);
+
+			RegisterSharedSkeleton(entity, entitySkeleton.GetSkeleton().get());
 		});
 		
 		m_skeletonConstructObserver.each([&](entt::entity entity)
@@ -43,13 +49,105 @@ namespace Nz
 			entityNode.SetParent(entitySkeleton.GetRootNode());
 		});
 
-		// Updated attached skeleton joints (TODO: Only do this if necessary)
-		auto view = m_registry.view<NodeComponent, SharedSkeletonComponent>(entt::exclude<DisabledComponent>);
-		for (auto entity : view)
+		// Update attached skeleton joints of entities whose reference skeleton was invalidated since the last update
+		for (const Skeleton* skeleton : m_invalidatedSkeletons)
+		{
+			auto it = m_sharedSkeletons.find(skeleton);
+			if (it == m_sharedSkeletons.end())
+				continue; //< skeleton is no longer used
+
+			SharedSkeleton& sharedSkeleton = it->second;
+			sharedSkeleton.isInvalidated = false;
+
+			for (entt::entity entity : sharedSkeleton.entities)
+			{
+				// Disabled entities are updated when enabled again
+				if (m_registry.all_of<DisabledComponent>(entity))
+					continue;
+
+				auto& sharedSkeletonComponent = m_registry.get<SharedSkeletonComponent>(entity);
+				if (sharedSkeletonComponent.IsAttachedSkeletonOutdated())
+					sharedSkeletonComponent.UpdateAttachedSkeletonJoints();
+			}
+		}
+		m_invalidatedSkeletons.clear();
+	}
+
+	void SkeletonSystem::InvalidateSharedSkeleton(const Skeleton* skeleton)
+	{
+		auto it = m_sharedSkeletons.find(skeleton);
+		assert(it != m_sharedSkeletons.end());
+
+		SharedSkeleton& sharedSkeleton = it->second;
+		if (sharedSkeleton.isInvalidated)
+			return;
+
+		sharedSkeleton.isInvalidated = true;
+		m_invalidatedSkeletons.push_back(skeleton);
+	}
+
+	void SkeletonSystem::OnDisabledDestroy(entt::registry& registry, entt::entity entity)
+	{
+		assert(&m_registry == &registry);
+
+		// Reference skeleton may have been invalidated while the entity was disabled
+		if (SharedSkeletonComponent* sharedSkeletonComponent = registry.try_get<SharedSkeletonComponent>(entity))
+		{
+			const Skeleton* skeleton = sharedSkeletonComponent->GetSkeleton().get();
+			if (sharedSkeletonComponent->IsAttachedSkeletonOutdated() && m_sharedSkeletons.find(skeleton) != m_sharedSkeletons.end())
+				InvalidateSharedSkeleton(skeleton);
+		}
+	}
+
+	void SkeletonSystem::OnNodeDestroy(entt::registry& registry, entt::entity entity)
+	{
+		assert(&m_registry == &registry);
+
+		if (SharedSkeletonComponent* sharedSkeletonComponent = registry.try_get<SharedSkeletonComponent>(entity))
+			UnregisterSharedSkeleton(entity, sharedSkeletonComponent->GetSkeleton().get());
+	}
+
+	void SkeletonSystem::OnSharedSkeletonDestroy(entt::registry& registry, entt::entity entity)
+	{
+		assert(&m_registry == &registry);
+
+		SharedSkeletonComponent& sharedSkeletonComponent = registry.get<SharedSkeletonComponent>(entity);
+		UnregisterSharedSkeleton(entity, sharedSkeletonComponent.GetSkeleton().get());
+	}
+
+	void SkeletonSystem::RegisterSharedSkeleton(entt::entity entity, const Skeleton* skeleton)
+	{
+		bool isNewSkeleton = (m_sharedSkeletons.find(skeleton) == m_sharedSkeletons.end());
+
+		SharedSkeleton& sharedSkeleton = m_sharedSkeletons[skeleton];
+		if (isNewSkeleton)
 		{
-			auto& sharedSkeletonComponent = view.get<SharedSkeletonComponent>(entity);
-			if (sharedSkeletonComponent.IsAttachedSkeletonOutdated())
-				sharedSkeletonComponent.UpdateAttachedSkeletonJoints();
+			sharedSkeleton.onJointsInvalidated.Connect(skeleton->OnSkeletonJointsInvalidated, [this](const Skeleton* invalidatedSkeleton, std::size_t /*firstJoint*/, std::size_t /*jointCount*/)
+			{
+				InvalidateSharedSkeleton(invalidatedSkeleton);
+			});
 		}
+
+		if (std::find(sharedSkeleton.entities.begin(), sharedSkeleton.entities.end(), entity) == sharedSkeleton.entities.end())
+			sharedSkeleton.entities.push_back(entity);
+
+		// Attached skeleton has to be synchronized at least once
+		InvalidateSharedSkeleton(skeleton);
+	}
+
+	void SkeletonSystem::UnregisterSharedSkeleton(entt::entity entity, const Skeleton* skeleton)
+	{
+		auto it = m_sharedSkeletons.find(skeleton);
+		if (it == m_sharedSkeletons.end())
+			return;
+
+		SharedSkeleton& sharedSkeleton = it->second;
+		auto entityIt = std::find(sharedSkeleton.entities.begin(), sharedSkeleton.entities.end(), entity);
+		if (entityIt == sharedSkeleton.entities.end())
+			return;
+
+		sharedSkeleton.entities.erase(entityIt);
+		if (sharedSkeleton.entities.empty())
+			m_sharedSkeletons.erase(it); //< stale entries of m_invalidatedSkeletons are skipped by Update
 	}
 }
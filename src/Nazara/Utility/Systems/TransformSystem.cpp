@@ -0,0 +1,68 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/Systems/TransformSystem.hpp>
+#include <Nazara/Utility/Components/NodeComponent.hpp>
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	TransformSystem::TransformSystem(entt::registry& registry) :
+	m_registry(registry)
+	{
+		m_nodeConstructConnection = registry.on_construct<NodeComponent>().connect<&TransformSystem::OnNodeConstruct>(this);
+		m_nodeDestroyConnection = registry.on_destroy<NodeComponent>().connect<&TransformSystem::OnNodeDestroy>(this);
+
+		for (entt::entity entity : registry.view<NodeComponent>())
+			OnNodeConstruct(registry, entity);
+	}
+
+	TransformSystem::~TransformSystem() = default;
+
+	void TransformSystem::Update(Time /*elapsedTime*/)
+	{
+		// Resolve every invalidated node transform at once, so further accesses (rendering, etc.) don't have to go up the hierarchy
+		const auto& nodeStorage = m_registry.storage<NodeComponent>();
+		for (std::size_t entityIndex : m_invalidatedNodes.IterBits())
+			m_transformHierarchy.Insert(&nodeStorage.get(m_nodeEntries[entityIndex].entity));
+
+		m_invalidatedNodes.Clear();
+
+		m_transformHierarchy.Update();
+	}
+
+	void TransformSystem::OnNodeConstruct([[maybe_unused]] entt::registry& registry, entt::entity entity)
+	{
+		assert(&m_registry == &registry);
+
+		std::size_t entityIndex = static_cast<std::size_t>(entt::to_entity(entity));
+		if (entityIndex >= m_nodeEntries.size())
+			m_nodeEntries.resize(entityIndex + 1);
+
+		NodeComponent& entityNode = m_registry.get<NodeComponent>(entity);
+
+		NodeEntry& nodeEntry = m_nodeEntries[entityIndex];
+		nodeEntry.entity = entity;
+		nodeEntry.onNodeInvalidation.Connect(entityNode.OnNodeInvalidation, [this, entityIndex](const Node* /*node*/)
+		{
+			m_invalidatedNodes.UnboundedSet(entityIndex);
+		});
+
+		m_invalidatedNodes.UnboundedSet(entityIndex);
+	}
+
+	void TransformSystem::OnNodeDestroy([[maybe_unused]] entt::registry& registry, entt::entity entity)
+	{
+		assert(&m_registry == &registry);
+
+		std::size_t entityIndex = static_cast<std::size_t>(entt::to_entity(entity));
+		assert(entityIndex < m_nodeEntries.size());
+
+		NodeEntry& nodeEntry = m_nodeEntries[entityIndex];
+		nodeEntry.entity = entt::null;
+		nodeEntry.onNodeInvalidation.Disconnect();
+
+		m_invalidatedNodes.UnboundedReset(entityIndex);
+	}
+}
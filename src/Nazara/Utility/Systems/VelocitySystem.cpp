@@ -3,22 +3,125 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Utility/Systems/VelocitySystem.hpp>
+#include <Nazara/Core/Core.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Core/Components/DisabledComponent.hpp>
+#include <Nazara/Math/Simd.hpp>
 #include <Nazara/Utility/Components/NodeComponent.hpp>
 #include <Nazara/Utility/Components/VelocityComponent.hpp>
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
 {
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		constexpr std::size_t IntegrationChunkSize = 1024;
+		constexpr std::size_t ParallelIntegrationThreshold = 4 * IntegrationChunkSize;
+	}
+
 	void VelocitySystem::Update(Time elapsedTime)
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
 		float delta = elapsedTime.AsSeconds();
 
+		// Nodes are moved without invalidation (which isn't thread-safe as it triggers signals) and invalidated afterwards
+		m_movingEntities.clear();
+
 		auto view = m_registry.view<NodeComponent, VelocityComponent>(entt::exclude<DisabledComponent>);
 		for (auto [entity, nodeComponent, velocityComponent] : view.each())
 		{
 			NazaraUnused(entity);
-			nodeComponent.Move(velocityComponent.GetLinearVelocity() * delta);
+
+			const Vector3f& linearVelocity = velocityComponent.GetLinearVelocity();
+			if (linearVelocity == Vector3f::Zero())
+				continue;
+
+			auto& movingEntity = m_movingEntities.emplace_back();
+			movingEntity.node = &nodeComponent;
+			movingEntity.movement = linearVelocity * delta;
+		}
+
+		std::size_t movingEntityCount = m_movingEntities.size();
+		if (movingEntityCount >= ParallelIntegrationThreshold && Core::Instance())
+		{
+			Core::Instance()->GetTaskScheduler().ForEachChunk(movingEntityCount, IntegrationChunkSize, [&](std::size_t first, std::size_t last)
+			{
+				IntegrateChunk(&m_movingEntities[first], last - first);
+			});
+		}
+		else
+			IntegrateChunk(m_movingEntities.data(), movingEntityCount);
+
+		for (const MovingEntity& movingEntity : m_movingEntities)
+			movingEntity.node->Invalidate();
+	}
+
+	void VelocitySystem::IntegrateChunk(MovingEntity* entities, std::size_t entityCount)
+	{
+		// Movement is expressed in the local coordinate system of the node (same as Node::Move with CoordSys::Local)
+		std::size_t index = 0;
+
+#ifdef NAZARA_MATH_SIMD
+		constexpr std::size_t BatchSize = 4;
+
+		std::size_t batchEnd = entityCount / BatchSize * BatchSize;
+		for (; index < batchEnd; index += BatchSize)
+		{
+			alignas(16) float px[BatchSize], py[BatchSize], pz[BatchSize];
+			alignas(16) float qx[BatchSize], qy[BatchSize], qz[BatchSize], qw[BatchSize];
+			alignas(16) float mx[BatchSize], my[BatchSize], mz[BatchSize];
+			for (std::size_t lane = 0; lane < BatchSize; ++lane)
+			{
+				const MovingEntity& movingEntity = entities[index + lane];
+
+				Vector3f position = movingEntity.node->GetPosition(CoordSys::Local);
+				Quaternionf rotation = movingEntity.node->GetRotation(CoordSys::Local);
+
+				px[lane] = position.x;
+				py[lane] = position.y;
+				pz[lane] = position.z;
+				qx[lane] = rotation.x;
+				qy[lane] = rotation.y;
+				qz[lane] = rotation.z;
+				qw[lane] = rotation.w;
+				mx[lane] = movingEntity.movement.x;
+				my[lane] = movingEntity.movement.y;
+				mz[lane] = movingEntity.movement.z;
+			}
+
+			Simd::Float4 rotX = Simd::Load(qx);
+			Simd::Float4 rotY = Simd::Load(qy);
+			Simd::Float4 rotZ = Simd::Load(qz);
+			Simd::Float4 rotW = Simd::Load(qw);
+			Simd::Float4 moveX = Simd::Load(mx);
+			Simd::Float4 moveY = Simd::Load(my);
+			Simd::Float4 moveZ = Simd::Load(mz);
+
+			// t = 2 * cross(q.xyz, m)
+			Simd::Float4 two = Simd::Splat(2.f);
+			Simd::Float4 tX = Simd::Mul(two, Simd::Sub(Simd::Mul(rotY, moveZ), Simd::Mul(rotZ, moveY)));
+			Simd::Float4 tY = Simd::Mul(two, Simd::Sub(Simd::Mul(rotZ, moveX), Simd::Mul(rotX, moveZ)));
+			Simd::Float4 tZ = Simd::Mul(two, Simd::Sub(Simd::Mul(rotX, moveY), Simd::Mul(rotY, moveX)));
+
+			// position += m + w * t + cross(q.xyz, t)
+			Simd::Float4 resultX = Simd::Add(Simd::Load(px), Simd::MulAdd(rotW, tX, Simd::Add(moveX, Simd::Sub(Simd::Mul(rotY, tZ), Simd::Mul(rotZ, tY)))));
+			Simd::Float4 resultY = Simd::Add(Simd::Load(py), Simd::MulAdd(rotW, tY, Simd::Add(moveY, Simd::Sub(Simd::Mul(rotZ, tX), Simd::Mul(rotX, tZ)))));
+			Simd::Float4 resultZ = Simd::Add(Simd::Load(pz), Simd::MulAdd(rotW, tZ, Simd::Add(moveZ, Simd::Sub(Simd::Mul(rotX, tY), Simd::Mul(rotY, tX)))));
+
+			Simd::Store(px, resultX);
+			Simd::Store(py, resultY);
+			Simd::Store(pz, resultZ);
+
+			for (std::size_t lane = 0; lane < BatchSize; ++lane)
+				entities[index + lane].node->SetPosition(Vector3f(px[lane], py[lane], pz[lane]), CoordSys::Local, Node::Invalidation::DontInvalidate);
+		}
+#endif
+
+		for (; index < entityCount; ++index)
+		{
+			MovingEntity& movingEntity = entities[index];
+			movingEntity.node->Move(movingEntity.movement, CoordSys::Local, Node::Invalidation::DontInvalidate);
 		}
 	}
 }
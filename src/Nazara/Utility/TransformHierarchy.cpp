@@ -0,0 +1,231 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/TransformHierarchy.hpp>
+#include <Nazara/Core/Core.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Utility/Node.hpp>
+#include <algorithm>
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		constexpr std::size_t TransformChunkSize = 1024;
+		constexpr std::size_t ParallelTransformThreshold = 4 * TransformChunkSize;
+
+		template<typename F>
+		void ForEachTransformChunk(std::size_t first, std::size_t last, F&& func)
+		{
+			std::size_t count = last - first;
+			if (count >= ParallelTransformThreshold)
+			{
+				Core::Instance()->GetTaskScheduler().ForEachChunk(count, TransformChunkSize, [&](std::size_t chunkFirst, std::size_t chunkLast)
+				{
+					func(first + chunkFirst, first + chunkLast);
+				});
+			}
+			else
+				func(first, last);
+		}
+	}
+
+	/*!
+	* \brief Adds a node to update on the next call to Update
+	*
+	* Nodes whose derived transform is already up to date are ignored, as are nodes inserted multiple times.
+	*
+	* \param node Node to update, its type must not override Node::UpdateDerived
+	*/
+	void TransformHierarchy::Insert(const Node* node)
+	{
+		NazaraAssert(node, "invalid node");
+
+		if (node->m_derivedUpdated)
+			return;
+
+		auto& pendingNode = m_pendingNodes.emplace_back();
+		pendingNode.node = node;
+		pendingNode.depth = 0;
+	}
+
+	/*!
+	* \brief Computes the derived transform and transform matrix of every inserted node
+	*
+	* Nodes are sorted by depth and their local/inherited transforms are gathered in contiguous arrays,
+	* each depth level is then resolved in a linear sweep (in parallel for large levels) before being written back to the nodes.
+	* This gives the same results as Node lazy evaluation without chasing parent pointers for every node.
+	*
+	* Parents which were not inserted are updated (if required) when gathering their children.
+	*/
+	void TransformHierarchy::Update()
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		if (m_pendingNodes.empty())
+			return;
+
+		SortNodes();
+
+		for (std::size_t levelIndex = 0; levelIndex + 1 < m_levelOffsets.size(); ++levelIndex)
+			ForEachTransformChunk(m_levelOffsets[levelIndex], m_levelOffsets[levelIndex + 1], [&](std::size_t first, std::size_t last) { UpdateLevel(first, last); });
+
+		ForEachTransformChunk(0, m_levelOffsets.back(), [&](std::size_t first, std::size_t last) { WriteBack(first, last); });
+
+		m_pendingNodes.clear();
+	}
+
+	void TransformHierarchy::SortNodes()
+	{
+		for (PendingNode& pendingNode : m_pendingNodes)
+		{
+			std::size_t depth = 0;
+			for (const Node* parent = pendingNode.node->m_parent; parent; parent = parent->m_parent)
+				depth++;
+
+			pendingNode.depth = depth;
+		}
+
+		// Parents always have a lower depth than their children
+		std::sort(m_pendingNodes.begin(), m_pendingNodes.end(), [](const PendingNode& lhs, const PendingNode& rhs)
+		{
+			if (lhs.depth != rhs.depth)
+				return lhs.depth < rhs.depth;
+
+			return lhs.node < rhs.node;
+		});
+
+		m_pendingNodes.erase(std::unique(m_pendingNodes.begin(), m_pendingNodes.end(), [](const PendingNode& lhs, const PendingNode& rhs) { return lhs.node == rhs.node; }), m_pendingNodes.end());
+
+		m_levelOffsets.clear();
+		m_nodeIndices.clear();
+		m_nodes.clear();
+		for (std::size_t i = 0; i < m_pendingNodes.size(); ++i)
+		{
+			const PendingNode& pendingNode = m_pendingNodes[i];
+			if (i == 0 || pendingNode.depth != m_pendingNodes[i - 1].depth)
+				m_levelOffsets.push_back(i);
+
+			m_nodeIndices.emplace(pendingNode.node, UInt32(i));
+			m_nodes.push_back(pendingNode.node);
+		}
+
+		std::size_t pendingNodeCount = m_nodes.size();
+		m_levelOffsets.push_back(pendingNodeCount);
+
+		m_parentIndices.resize(pendingNodeCount);
+		m_inheritFlags.resize(pendingNodeCount);
+		m_localPositions.resize(pendingNodeCount);
+		m_localRotations.resize(pendingNodeCount);
+		m_localScales.resize(pendingNodeCount);
+
+		for (std::size_t i = 0; i < pendingNodeCount; ++i)
+		{
+			const Node* node = m_nodes[i];
+
+			m_localPositions[i] = node->m_initialPosition + node->m_position;
+			m_localRotations[i] = node->m_initialRotation * node->m_rotation;
+			m_localScales[i] = node->m_initialScale * node->m_scale;
+
+			UInt8 inheritFlags = 0;
+			if (node->m_inheritPosition)
+				inheritFlags |= InheritPosition;
+
+			if (node->m_inheritRotation)
+				inheritFlags |= InheritRotation;
+
+			if (node->m_inheritScale)
+				inheritFlags |= InheritScale;
+
+			m_inheritFlags[i] = inheritFlags;
+
+			if (const Node* parent = node->m_parent)
+			{
+				// Parents which weren't inserted are stored after the inserted nodes, with their transform already resolved
+				auto it = m_nodeIndices.find(parent);
+				if (it == m_nodeIndices.end())
+				{
+					it = m_nodeIndices.emplace(parent, UInt32(m_nodes.size())).first;
+					m_nodes.push_back(parent);
+				}
+
+				m_parentIndices[i] = it->second;
+			}
+			else
+				m_parentIndices[i] = NoParent;
+		}
+
+		m_globalPositions.resize(m_nodes.size());
+		m_globalRotations.resize(m_nodes.size());
+		m_globalScales.resize(m_nodes.size());
+
+		for (std::size_t i = pendingNodeCount; i < m_nodes.size(); ++i)
+		{
+			const Node* parent = m_nodes[i];
+			parent->EnsureDerivedUpdate();
+
+			m_globalPositions[i] = parent->m_derivedPosition;
+			m_globalRotations[i] = parent->m_derivedRotation;
+			m_globalScales[i] = parent->m_derivedScale;
+		}
+	}
+
+	void TransformHierarchy::UpdateLevel(std::size_t first, std::size_t last)
+	{
+		// Same computations as Node::UpdateDerived
+		for (std::size_t i = first; i < last; ++i)
+		{
+			UInt32 parentIndex = m_parentIndices[i];
+			if (parentIndex == NoParent)
+			{
+				m_globalPositions[i] = m_localPositions[i];
+				m_globalRotations[i] = m_localRotations[i];
+				m_globalScales[i] = m_localScales[i];
+				continue;
+			}
+
+			const Vector3f& parentPosition = m_globalPositions[parentIndex];
+			const Quaternionf& parentRotation = m_globalRotations[parentIndex];
+			const Vector3f& parentScale = m_globalScales[parentIndex];
+			UInt8 inheritFlags = m_inheritFlags[i];
+
+			if (inheritFlags & InheritPosition)
+				m_globalPositions[i] = parentRotation * (parentScale * m_localPositions[i]) + parentPosition;
+			else
+				m_globalPositions[i] = m_localPositions[i];
+
+			if (inheritFlags & InheritRotation)
+			{
+				Quaternionf rotation = m_localRotations[i];
+				if (inheritFlags & InheritScale)
+					rotation = Quaternionf::Mirror(rotation, parentScale);
+
+				m_globalRotations[i] = parentRotation * rotation;
+				m_globalRotations[i].Normalize();
+			}
+			else
+				m_globalRotations[i] = m_localRotations[i];
+
+			m_globalScales[i] = m_localScales[i];
+			if (inheritFlags & InheritScale)
+				m_globalScales[i] *= parentScale;
+		}
+	}
+
+	void TransformHierarchy::WriteBack(std::size_t first, std::size_t last)
+	{
+		for (std::size_t i = first; i < last; ++i)
+		{
+			const Node* node = m_nodes[i];
+			node->m_derivedPosition = m_globalPositions[i];
+			node->m_derivedRotation = m_globalRotations[i];
+			node->m_derivedScale = m_globalScales[i];
+			node->m_derivedUpdated = true;
+
+			node->m_transformMatrix = Matrix4f::Transform(m_globalPositions[i], m_globalRotations[i], m_globalScales[i]);
+			node->m_transformMatrixUpdated = true;
+		}
+	}
+}
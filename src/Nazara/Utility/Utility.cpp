@@ -17,9 +17,14 @@
 #include <Nazara/Utility/Formats/DDSLoader.hpp>
 #include <Nazara/Utility/Formats/FreeTypeLoader.hpp>
 #include <Nazara/Utility/Formats/GIFLoader.hpp>
+#include <Nazara/Utility/Formats/KTXLoader.hpp>
 #include <Nazara/Utility/Formats/MD2Loader.hpp>
 #include <Nazara/Utility/Formats/MD5AnimLoader.hpp>
 #include <Nazara/Utility/Formats/MD5MeshLoader.hpp>
+#include <Nazara/Utility/Formats/NZAnimLoader.hpp>
+#include <Nazara/Utility/Formats/NZAnimSaver.hpp>
+#include <Nazara/Utility/Formats/NZMeshLoader.hpp>
+#include <Nazara/Utility/Formats/NZMeshSaver.hpp>
 #include <Nazara/Utility/Formats/OBJLoader.hpp>
 #include <Nazara/Utility/Formats/OBJSaver.hpp>
 #include <Nazara/Utility/Formats/PCXLoader.hpp>
@@ -67,6 +72,8 @@ namespace Nz
 		/// Loaders spécialisés
 		// Animation
 		m_animationLoader.RegisterLoader(Loaders::GetAnimationLoader_MD5Anim()); // Loader de fichiers .md5anim (v10)
+		m_animationLoader.RegisterLoader(Loaders::GetAnimationLoader_NZAnim()); // .nzanim (v1, compressed binary clips)
+		m_animationSaver.RegisterSaver(Loaders::GetAnimationSaver_NZAnim());
 
 		// Mesh (text)
 		m_meshLoader.RegisterLoader(Loaders::GetMeshLoader_OBJ());
@@ -75,10 +82,13 @@ namespace Nz
 		// Mesh
 		m_meshLoader.RegisterLoader(Loaders::GetMeshLoader_MD2()); // .md2 (v8)
 		m_meshLoader.RegisterLoader(Loaders::GetMeshLoader_MD5Mesh()); // .md5mesh (v10)
+		m_meshLoader.RegisterLoader(Loaders::GetMeshLoader_NZMesh()); // .nzmesh (v1, binary cache)
+		m_meshSaver.RegisterSaver(Loaders::GetMeshSaver_NZMesh());
 		m_meshLoader.RegisterLoader(Loaders::GetMeshLoader_OBJ()); // .obj
 
 		// Image
 		m_imageLoader.RegisterLoader(Loaders::GetImageLoader_DDS()); // DDS Loader (DirectX format)
+		m_imageLoader.RegisterLoader(Loaders::GetImageLoader_KTX()); // KTX2 loader (Khronos format)
 		m_imageLoader.RegisterLoader(Loaders::GetImageLoader_PCX()); // .pcx loader (1, 4, 8, 24 bits)
 	}
 
@@ -101,6 +111,16 @@ namespace Nz
 		return m_animationLoader;
 	}
 
+	AnimationSaver& Utility::GetAnimationSaver()
+	{
+		return m_animationSaver;
+	}
+
+	const AnimationSaver& Utility::GetAnimationSaver() const
+	{
+		return m_animationSaver;
+	}
+
 	FontLoader& Utility::GetFontLoader()
 	{
 		return m_fontLoader;
@@ -30,10 +30,23 @@ namespace Nz
 			2 * sizeof(UInt32),   // ComponentType::Int2
 			3 * sizeof(UInt32),   // ComponentType::Int3
 			4 * sizeof(UInt32),   // ComponentType::Int4
+			2 * sizeof(UInt16),   // ComponentType::Half2
+			4 * sizeof(UInt16),   // ComponentType::Half4
+			4 * sizeof(Int8),     // ComponentType::SNorm8x4
+			2 * sizeof(Int16),    // ComponentType::SNorm16x2
+			4 * sizeof(Int16),    // ComponentType::SNorm16x4
+			4 * sizeof(UInt8),    // ComponentType::UNorm8x4
+			2 * sizeof(UInt16),   // ComponentType::UNorm16x2
+			4 * sizeof(UInt16),   // ComponentType::UNorm16x4
 		};
 	}
 
 	VertexDeclaration::VertexDeclaration(VertexInputRate inputRate, std::initializer_list<ComponentEntry> components) :
+	VertexDeclaration(inputRate, std::vector<ComponentEntry>(components))
+	{
+	}
+
+	VertexDeclaration::VertexDeclaration(VertexInputRate inputRate, const std::vector<ComponentEntry>& components) :
 	m_inputRate(inputRate)
 	{
 		NAZARA_USE_ANONYMOUS_NAMESPACE
@@ -69,6 +82,14 @@ namespace Nz
 		m_stride = offset;
 	}
 
+	std::size_t VertexDeclaration::GetComponentTypeSize(ComponentType type)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		NazaraAssert(type <= ComponentType::Max, "Component type out of enum");
+		return s_componentStride[type];
+	}
+
 	bool VertexDeclaration::IsTypeSupported(ComponentType type)
 	{
 		switch (type)
@@ -86,6 +107,14 @@ namespace Nz
 			case ComponentType::Int2:
 			case ComponentType::Int3:
 			case ComponentType::Int4:
+			case ComponentType::Half2:
+			case ComponentType::Half4:
+			case ComponentType::SNorm8x4:
+			case ComponentType::SNorm16x2:
+			case ComponentType::SNorm16x4:
+			case ComponentType::UNorm8x4:
+			case ComponentType::UNorm16x2:
+			case ComponentType::UNorm16x4:
 				return true;
 		}
 
@@ -309,6 +338,68 @@ namespace Nz
 
 			NazaraAssert(s_declarations[VertexLayout::XYZ_UV]->GetStride() == sizeof(VertexStruct_XYZ_UV), "Invalid stride for declaration VertexLayout::XYZ_UV");
 
+			// VertexLayout::XYZ_Normal_UV_Tangent_Packed : VertexStruct_XYZ_Normal_UV_Tangent_Packed
+			s_declarations[VertexLayout::XYZ_Normal_UV_Tangent_Packed] = NewDeclaration(VertexInputRate::Vertex, {
+				{
+					VertexComponent::Position,
+					ComponentType::Half4,
+					0
+				},
+				{
+					VertexComponent::Normal,
+					ComponentType::SNorm16x2,
+					0
+				},
+				{
+					VertexComponent::TexCoord,
+					ComponentType::Half2,
+					0
+				},
+				{
+					VertexComponent::Tangent,
+					ComponentType::SNorm16x2,
+					0
+				}
+			});
+
+			NazaraAssert(s_declarations[VertexLayout::XYZ_Normal_UV_Tangent_Packed]->GetStride() == sizeof(VertexStruct_XYZ_Normal_UV_Tangent_Packed), "Invalid stride for declaration VertexLayout::XYZ_Normal_UV_Tangent_Packed");
+
+			// VertexLayout::XYZ_Normal_UV_Tangent_Skinning_Packed : VertexStruct_XYZ_Normal_UV_Tangent_Skinning_Packed
+			s_declarations[VertexLayout::XYZ_Normal_UV_Tangent_Skinning_Packed] = NewDeclaration(VertexInputRate::Vertex, {
+				{
+					VertexComponent::Position,
+					ComponentType::Half4,
+					0
+				},
+				{
+					VertexComponent::Normal,
+					ComponentType::SNorm16x2,
+					0
+				},
+				{
+					VertexComponent::TexCoord,
+					ComponentType::Half2,
+					0
+				},
+				{
+					VertexComponent::Tangent,
+					ComponentType::SNorm16x2,
+					0
+				},
+				{
+					VertexComponent::JointWeights,
+					ComponentType::UNorm16x4,
+					0
+				},
+				{
+					VertexComponent::JointIndices,
+					ComponentType::Int4,
+					0
+				},
+			});
+
+			NazaraAssert(s_declarations[VertexLayout::XYZ_Normal_UV_Tangent_Skinning_Packed]->GetStride() == sizeof(VertexStruct_XYZ_Normal_UV_Tangent_Skinning_Packed), "Invalid stride for declaration VertexLayout::XYZ_Normal_UV_Tangent_Skinning_Packed");
+
 			// VertexLayout::Matrix4 : Matrix4f
 			s_declarations[VertexLayout::Matrix4] = NewDeclaration(VertexInputRate::Vertex, {
 				{
@@ -3,7 +3,9 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Utility/VertexMapper.hpp>
+#include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Utility/Algorithm.hpp>
 #include <Nazara/Utility/BufferMapper.hpp>
 #include <Nazara/Utility/SkeletalMesh.hpp>
 #include <Nazara/Utility/StaticMesh.hpp>
@@ -50,6 +52,54 @@ namespace Nz
 	
 	VertexMapper::~VertexMapper() = default;
 
+	/*!
+	* \brief Reads the value of a vertex component, whatever its type is (including compressed types)
+	* \return Component value (see DecodeVertexComponent), or (0, 0, 0, 1) if the vertex declaration has no such component
+	*
+	* \param component Kind of component
+	* \param vertexIndex Index of the vertex
+	* \param componentIndex Index of the component (for userdata components)
+	*
+	* \remark This is slower than accessing components through GetComponentPtr, which should be preferred for components of known types
+	*/
+	Vector4f VertexMapper::GetComponentValue(VertexComponent component, UInt32 vertexIndex, std::size_t componentIndex)
+	{
+		NazaraAssert(vertexIndex < GetVertexCount(), "vertex index out of range");
+
+		const std::shared_ptr<const VertexDeclaration>& declaration = m_mapper.GetBuffer()->GetVertexDeclaration();
+
+		const auto* componentData = declaration->FindComponent(component, componentIndex);
+		if (!componentData)
+			return Vector4f(0.f, 0.f, 0.f, 1.f);
+
+		const UInt8* vertexPtr = static_cast<const UInt8*>(m_mapper.GetPointer()) + vertexIndex * declaration->GetStride();
+		return DecodeVertexComponent(vertexPtr + componentData->offset, componentData->type, component);
+	}
+
+	/*!
+	* \brief Writes the value of a vertex component, whatever its type is (including compressed types)
+	*
+	* \param component Kind of component
+	* \param vertexIndex Index of the vertex
+	* \param value Component value (see EncodeVertexComponent)
+	* \param componentIndex Index of the component (for userdata components)
+	*
+	* \remark Does nothing if the vertex declaration has no such component
+	*/
+	void VertexMapper::SetComponentValue(VertexComponent component, UInt32 vertexIndex, const Vector4f& value, std::size_t componentIndex)
+	{
+		NazaraAssert(vertexIndex < GetVertexCount(), "vertex index out of range");
+
+		const std::shared_ptr<const VertexDeclaration>& declaration = m_mapper.GetBuffer()->GetVertexDeclaration();
+
+		const auto* componentData = declaration->FindComponent(component, componentIndex);
+		if (!componentData)
+			return;
+
+		UInt8* vertexPtr = static_cast<UInt8*>(m_mapper.GetPointer()) + vertexIndex * declaration->GetStride();
+		EncodeVertexComponent(value, componentData->type, component, vertexPtr + componentData->offset);
+	}
+
 	void VertexMapper::Unmap()
 	{
 		m_mapper.Unmap();
@@ -55,8 +55,18 @@ namespace Nz
 		deviceInfo.name = physDevice.properties.deviceName;
 
 		deviceInfo.features.anisotropicFiltering = physDevice.features.samplerAnisotropy;
+		deviceInfo.features.bindlessTextures = physDevice.vulkan12Features.descriptorIndexing &&
+		                                       physDevice.vulkan12Features.runtimeDescriptorArray &&
+		                                       physDevice.vulkan12Features.descriptorBindingPartiallyBound &&
+		                                       physDevice.vulkan12Features.descriptorBindingSampledImageUpdateAfterBind &&
+		                                       physDevice.vulkan12Features.descriptorBindingUpdateUnusedWhilePending &&
+		                                       physDevice.vulkan12Features.shaderSampledImageArrayNonUniformIndexing;
 		deviceInfo.features.computeShaders = true;
 		deviceInfo.features.depthClamping = physDevice.features.depthClamp;
+		deviceInfo.features.drawIndirectCount = physDevice.extensions.count(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME) != 0 ||
+		                                        (physDevice.properties.apiVersion >= VK_API_VERSION_1_2 && physDevice.vulkan12Features.drawIndirectCount);
+		deviceInfo.features.multiDrawIndirect = physDevice.features.multiDrawIndirect;
+		deviceInfo.features.multipleSubpasses = true;
 		deviceInfo.features.nonSolidFaceFilling = physDevice.features.fillModeNonSolid;
 		deviceInfo.features.storageBuffers = true;
 		deviceInfo.features.textureReadWithoutFormat = physDevice.features.shaderStorageImageReadWithoutFormat;
@@ -68,6 +78,7 @@ namespace Nz
 		deviceInfo.limits.maxComputeWorkGroupCount = { physDevice.properties.limits.maxComputeWorkGroupCount[0], physDevice.properties.limits.maxComputeWorkGroupCount[1], physDevice.properties.limits.maxComputeWorkGroupCount[2] };
 		deviceInfo.limits.maxComputeWorkGroupSize = { physDevice.properties.limits.maxComputeWorkGroupSize[0], physDevice.properties.limits.maxComputeWorkGroupSize[1], physDevice.properties.limits.maxComputeWorkGroupSize[2] };
 		deviceInfo.limits.maxComputeWorkGroupInvocations = physDevice.properties.limits.maxComputeWorkGroupInvocations;
+		deviceInfo.limits.maxPushConstantsSize = physDevice.properties.limits.maxPushConstantsSize;
 		deviceInfo.limits.maxStorageBufferSize = physDevice.properties.limits.maxStorageBufferRange;
 		deviceInfo.limits.maxUniformBufferSize = physDevice.properties.limits.maxUniformBufferRange;
 		deviceInfo.limits.minStorageBufferOffsetAlignment = RoundToPow2(physDevice.properties.limits.minStorageBufferOffsetAlignment);
@@ -359,6 +370,50 @@ namespace Nz
 			else
 				NazaraWarning("failed to query physical device extensions for {0} ({1:#x})", deviceInfo.properties.deviceName, deviceInfo.properties.deviceID);
 
+			deviceInfo.dynamicRenderingFeatures = {};
+			deviceInfo.dynamicRenderingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES;
+			deviceInfo.presentIdFeatures = {};
+			deviceInfo.presentIdFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+			deviceInfo.presentWaitFeatures = {};
+			deviceInfo.presentWaitFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+			deviceInfo.vulkan12Features = {};
+			deviceInfo.vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+			if (deviceInfo.properties.apiVersion >= VK_API_VERSION_1_1 && s_instance.vkGetPhysicalDeviceFeatures2)
+			{
+				VkPhysicalDeviceFeatures2 features2 = {};
+				features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+
+				if (deviceInfo.properties.apiVersion >= VK_API_VERSION_1_2)
+				{
+					deviceInfo.vulkan12Features.pNext = features2.pNext;
+					features2.pNext = &deviceInfo.vulkan12Features;
+				}
+
+				if (deviceInfo.properties.apiVersion >= VK_API_VERSION_1_3 || deviceInfo.extensions.count(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME))
+				{
+					deviceInfo.dynamicRenderingFeatures.pNext = features2.pNext;
+					features2.pNext = &deviceInfo.dynamicRenderingFeatures;
+				}
+
+				if (deviceInfo.extensions.count(VK_KHR_PRESENT_ID_EXTENSION_NAME))
+				{
+					deviceInfo.presentIdFeatures.pNext = features2.pNext;
+					features2.pNext = &deviceInfo.presentIdFeatures;
+				}
+
+				if (deviceInfo.extensions.count(VK_KHR_PRESENT_WAIT_EXTENSION_NAME))
+				{
+					deviceInfo.presentWaitFeatures.pNext = features2.pNext;
+					features2.pNext = &deviceInfo.presentWaitFeatures;
+				}
+
+				s_instance.vkGetPhysicalDeviceFeatures2(physDevice, &features2);
+				deviceInfo.dynamicRenderingFeatures.pNext = nullptr;
+				deviceInfo.presentIdFeatures.pNext = nullptr;
+				deviceInfo.presentWaitFeatures.pNext = nullptr;
+				deviceInfo.vulkan12Features.pNext = nullptr;
+			}
+
 			s_physDevices.emplace_back(std::move(deviceInfo));
 		}
 
@@ -398,6 +453,17 @@ namespace Nz
 			}
 		}
 
+		// Search for a dedicated compute queue (async compute), fallback to the graphics one
+		UInt32 computeQueueNodeFamily = graphicsQueueNodeIndex;
+		for (UInt32 i = 0; i < deviceInfo.queueFamilies.size(); i++)
+		{
+			if ((deviceInfo.queueFamilies[i].queueFlags & (VK_QUEUE_COMPUTE_BIT | VK_QUEUE_GRAPHICS_BIT)) == VK_QUEUE_COMPUTE_BIT)
+			{
+				computeQueueNodeFamily = i;
+				break;
+			}
+		}
+
 		for (UInt32 i = 0; i < deviceInfo.queueFamilies.size(); i++)
 		{
 			if (deviceInfo.queueFamilies[i].queueFlags & (VK_QUEUE_COMPUTE_BIT | VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_TRANSFER_BIT)) //< Compute and graphics queue implicitly support transfer operations
@@ -408,9 +474,10 @@ namespace Nz
 			}
 		}
 
-		std::array<QueueFamily, 2> queuesFamilies = {
+		std::array<QueueFamily, 3> queuesFamilies = {
 			{
 				{ graphicsQueueNodeIndex, 1.f },
+				{ computeQueueNodeFamily, 1.f },
 				{ transfertQueueNodeFamily, 1.f }
 			}
 		};
@@ -462,6 +529,17 @@ namespace Nz
 			return {};
 		}
 
+		// Search for a dedicated compute queue (async compute), fallback to the graphics one
+		UInt32 computeQueueNodeFamily = graphicsQueueNodeIndex;
+		for (UInt32 i = 0; i < deviceInfo.queueFamilies.size(); i++)
+		{
+			if ((deviceInfo.queueFamilies[i].queueFlags & (VK_QUEUE_COMPUTE_BIT | VK_QUEUE_GRAPHICS_BIT)) == VK_QUEUE_COMPUTE_BIT)
+			{
+				computeQueueNodeFamily = i;
+				break;
+			}
+		}
+
 		// Search for a transfer queue (first one being different to the graphics one)
 		for (UInt32 i = 0; i < deviceInfo.queueFamilies.size(); i++)
 		{
@@ -475,10 +553,12 @@ namespace Nz
 		}
 		assert(transferQueueNodeFamily != UINT32_MAX);
 
-		std::array<QueueFamily, 3> queuesFamilies = {
+		// Compute family comes before the transfer one so the device picks it as its default compute queue
+		std::array<QueueFamily, 4> queuesFamilies = {
 			{
 				{graphicsQueueNodeIndex, 1.f},
 				{presentQueueNodeIndex, 1.f},
+				{computeQueueNodeFamily, 1.f},
 				{transferQueueNodeFamily, 1.f}
 			}
 		};
@@ -521,6 +601,9 @@ namespace Nz
 
 		std::vector<const char*> enabledLayers;
 		std::vector<const char*> enabledExtensions;
+		bool enableDynamicRendering = false;
+		bool enablePresentWait = false;
+		bool enableTimelineSemaphore = false;
 
 		if (auto result = s_initializationParameters.GetBooleanParameter("VkDeviceInfo_OverrideEnabledLayers"); !result.GetValueOr(false))
 		{
@@ -563,6 +646,38 @@ namespace Nz
 				EnableIfSupported(VK_KHR_BIND_MEMORY_2_EXTENSION_NAME);
 				EnableIfSupported(VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME);
 			}
+
+			if (enabledFeatures.drawIndirectCount)
+				EnableIfSupported(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+
+			// Dynamic rendering allows to skip render pass and framebuffer objects (VK_KHR_dynamic_rendering dependencies are part of Vulkan 1.2)
+			if (deviceInfo.dynamicRenderingFeatures.dynamicRendering && !s_initializationParameters.GetBooleanParameter("VkDeviceInfo_DisableDynamicRendering").GetValueOr(false))
+			{
+				if (deviceInfo.properties.apiVersion >= VK_API_VERSION_1_3)
+					enableDynamicRendering = true;
+				else if (deviceInfo.properties.apiVersion >= VK_API_VERSION_1_2)
+				{
+					enabledExtensions.emplace_back(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
+					enableDynamicRendering = true;
+				}
+			}
+
+			// Timeline semaphores track GPU progress for deferred resource releases (part of Vulkan 1.2, where the feature is always supported)
+			if (deviceInfo.properties.apiVersion >= VK_API_VERSION_1_2)
+				enableTimelineSemaphore = deviceInfo.vulkan12Features.timelineSemaphore == VK_TRUE;
+			else if (deviceInfo.extensions.count(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME))
+			{
+				enabledExtensions.emplace_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+				enableTimelineSemaphore = true;
+			}
+
+			// Used by swapchains to know when a frame was presented (frame pacing and latency measurement)
+			if (deviceInfo.presentIdFeatures.presentId && deviceInfo.presentWaitFeatures.presentWait)
+			{
+				enabledExtensions.emplace_back(VK_KHR_PRESENT_ID_EXTENSION_NAME);
+				enabledExtensions.emplace_back(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+				enablePresentWait = true;
+			}
 		}
 
 		std::vector<std::string> additionalExtensions; // Just to keep the String alive
@@ -588,12 +703,86 @@ namespace Nz
 		if (enabledFeatures.depthClamping)
 			deviceFeatures.depthClamp = VK_TRUE;
 
+		if (enabledFeatures.multiDrawIndirect)
+			deviceFeatures.multiDrawIndirect = VK_TRUE;
+
 		if (enabledFeatures.nonSolidFaceFilling)
 			deviceFeatures.fillModeNonSolid = VK_TRUE;
 
+		// Vulkan 1.2 promoted VK_KHR_draw_indirect_count to an optional feature, which must be enabled as such to use the core functions
+		VkPhysicalDeviceVulkan12Features vulkan12Features = {};
+		vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+		const void* deviceFeaturesNext = nullptr;
+		if (deviceInfo.properties.apiVersion >= VK_API_VERSION_1_2 && enabledFeatures.drawIndirectCount && deviceInfo.vulkan12Features.drawIndirectCount)
+		{
+			vulkan12Features.drawIndirectCount = VK_TRUE;
+			deviceFeaturesNext = &vulkan12Features;
+		}
+
+		// Bindless textures rely on descriptor indexing (only supported through Vulkan 1.2 core, see BuildRenderDeviceInfo)
+		if (enabledFeatures.bindlessTextures)
+		{
+			vulkan12Features.descriptorIndexing = VK_TRUE;
+			vulkan12Features.descriptorBindingPartiallyBound = VK_TRUE;
+			vulkan12Features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+			vulkan12Features.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+			vulkan12Features.runtimeDescriptorArray = VK_TRUE;
+			vulkan12Features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+			deviceFeaturesNext = &vulkan12Features;
+		}
+
+		VkPhysicalDeviceTimelineSemaphoreFeatures timelineSemaphoreFeatures = {};
+		timelineSemaphoreFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+
+		if (enableTimelineSemaphore)
+		{
+			if (deviceInfo.properties.apiVersion >= VK_API_VERSION_1_2)
+			{
+				vulkan12Features.timelineSemaphore = VK_TRUE;
+				deviceFeaturesNext = &vulkan12Features;
+			}
+			else
+			{
+				// VK_KHR_timeline_semaphore requires the feature to be supported
+				timelineSemaphoreFeatures.timelineSemaphore = VK_TRUE;
+				timelineSemaphoreFeatures.pNext = const_cast<void*>(deviceFeaturesNext);
+
+				deviceFeaturesNext = &timelineSemaphoreFeatures;
+			}
+		}
+
+		VkPhysicalDeviceDynamicRenderingFeatures dynamicRenderingFeatures = {};
+		dynamicRenderingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES;
+
+		if (enableDynamicRendering)
+		{
+			dynamicRenderingFeatures.dynamicRendering = VK_TRUE;
+			dynamicRenderingFeatures.pNext = const_cast<void*>(deviceFeaturesNext);
+
+			deviceFeaturesNext = &dynamicRenderingFeatures;
+		}
+
+		VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures = {};
+		presentIdFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+
+		VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures = {};
+		presentWaitFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+
+		if (enablePresentWait)
+		{
+			presentIdFeatures.presentId = VK_TRUE;
+			presentIdFeatures.pNext = const_cast<void*>(deviceFeaturesNext);
+
+			presentWaitFeatures.presentWait = VK_TRUE;
+			presentWaitFeatures.pNext = &presentIdFeatures;
+
+			deviceFeaturesNext = &presentWaitFeatures;
+		}
+
 		VkDeviceCreateInfo createInfo = {
 			VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
-			nullptr,
+			deviceFeaturesNext,
 			0,
 			UInt32(queueCreateInfos.size()),
 			queueCreateInfos.data(),
@@ -611,6 +800,13 @@ namespace Nz
 			return {};
 		}
 
+		std::filesystem::path pipelineCachePath;
+		if (auto result = s_initializationParameters.GetStringParameter("VkDeviceInfo_PipelineCachePath"))
+			pipelineCachePath = Utf8Path(std::move(result).GetValue());
+
+		if (!device->InitializePipelineCache(std::move(pipelineCachePath)))
+			return {};
+
 		return device;
 	}
 
@@ -0,0 +1,178 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Vulkan renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/VulkanRenderer/VulkanAsyncUpload.hpp>
+#include <Nazara/VulkanRenderer/Utils.hpp>
+#include <Nazara/VulkanRenderer/VulkanBuffer.hpp>
+#include <Nazara/VulkanRenderer/VulkanDevice.hpp>
+#include <Nazara/VulkanRenderer/Wrapper/QueueHandle.hpp>
+#include <stdexcept>
+#include <Nazara/VulkanRenderer/Debug.hpp>
+
+namespace Nz
+{
+	VulkanAsyncUpload::VulkanAsyncUpload(VulkanDevice& device) :
+	m_transferCommandBuffer(device.AllocateCommandBuffer(QueueType::Transfer)),
+	m_device(device),
+	m_graphicsFamilyIndex(device.GetDefaultFamilyIndex(QueueType::Graphics)),
+	m_transferFamilyIndex(device.GetDefaultFamilyIndex(QueueType::Transfer)),
+	m_isSubmitted(false)
+	{
+		if (!m_transferCommandBuffer->Begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT))
+			throw std::runtime_error("failed to begin transfer command buffer: " + TranslateVulkanError(m_transferCommandBuffer->GetLastErrorCode()));
+
+		if (RequiresOwnershipTransfer())
+		{
+			m_acquireCommandBuffer.emplace(device.AllocateCommandBuffer(QueueType::Graphics));
+			if (!m_acquireCommandBuffer->Get().Begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT))
+				throw std::runtime_error("failed to begin acquire command buffer: " + TranslateVulkanError(m_acquireCommandBuffer->Get().GetLastErrorCode()));
+
+			if (!m_ownershipSemaphore.Create(device))
+				throw std::runtime_error("failed to create semaphore: " + TranslateVulkanError(m_ownershipSemaphore.GetLastErrorCode()));
+		}
+
+		if (!m_fence.Create(device))
+			throw std::runtime_error("failed to create fence: " + TranslateVulkanError(m_fence.GetLastErrorCode()));
+	}
+
+	VulkanAsyncUpload::~VulkanAsyncUpload()
+	{
+		// Command buffers and staging buffer must outlive the GPU work
+		if (m_isSubmitted)
+			m_fence.Wait();
+	}
+
+	/*!
+	* \brief Records the barriers making the buffer region written by the transfer command buffer visible to the graphics queue
+	*/
+	void VulkanAsyncUpload::FinishBufferUpload(VkBuffer buffer, UInt64 offset, UInt64 size)
+	{
+		NazaraAssert(!m_isSubmitted, "upload has already been submitted");
+
+		constexpr VkAccessFlags BufferReadAccess = VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+
+		VkBufferMemoryBarrier bufferBarrier = {
+			VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+			nullptr,
+			VK_ACCESS_TRANSFER_WRITE_BIT,
+			BufferReadAccess,
+			VK_QUEUE_FAMILY_IGNORED,
+			VK_QUEUE_FAMILY_IGNORED,
+			buffer,
+			offset,
+			size
+		};
+
+		if (RequiresOwnershipTransfer())
+		{
+			bufferBarrier.srcQueueFamilyIndex = m_transferFamilyIndex;
+			bufferBarrier.dstQueueFamilyIndex = m_graphicsFamilyIndex;
+
+			// Release on the transfer queue (destination access is ignored)
+			bufferBarrier.dstAccessMask = 0;
+			m_transferCommandBuffer->PipelineBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 1, &bufferBarrier, 0, nullptr);
+
+			// Acquire on the graphics queue (source access is ignored)
+			bufferBarrier.srcAccessMask = 0;
+			bufferBarrier.dstAccessMask = BufferReadAccess;
+			m_acquireCommandBuffer->Get().PipelineBarrier(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 1, &bufferBarrier, 0, nullptr);
+		}
+		else
+			m_transferCommandBuffer->PipelineBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 1, &bufferBarrier, 0, nullptr);
+	}
+
+	/*!
+	* \brief Records the barriers transitioning the image written by the transfer command buffer to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL for the graphics queue
+	*/
+	void VulkanAsyncUpload::FinishImageUpload(VkImage image, const VkImageSubresourceRange& subresourceRange)
+	{
+		NazaraAssert(!m_isSubmitted, "upload has already been submitted");
+
+		if (RequiresOwnershipTransfer())
+		{
+			VkImageMemoryBarrier imageBarrier = {
+				VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+				nullptr,
+				VK_ACCESS_TRANSFER_WRITE_BIT,
+				0,
+				VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+				VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+				m_transferFamilyIndex,
+				m_graphicsFamilyIndex,
+				image,
+				subresourceRange
+			};
+
+			// The layout transition is performed once, between the release and the acquire operations
+			m_transferCommandBuffer->PipelineBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, imageBarrier);
+
+			imageBarrier.srcAccessMask = 0;
+			imageBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+			m_acquireCommandBuffer->Get().PipelineBarrier(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, imageBarrier);
+		}
+		else
+			m_transferCommandBuffer->SetImageLayout(image, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, subresourceRange);
+	}
+
+	bool VulkanAsyncUpload::IsFinished() const
+	{
+		if (!m_isSubmitted)
+			return false;
+
+		bool didTimeout;
+		if (!m_fence.Wait(0, &didTimeout))
+			return true; //< don't report a device error as a never-ending upload
+
+		return !didTimeout;
+	}
+
+	/*!
+	* \brief Submits the recorded commands to the transfer queue (and to the graphics queue if an ownership transfer is required)
+	*
+	* \param stagingBuffer Buffer holding the data to upload, released when the upload object is destroyed
+	*/
+	void VulkanAsyncUpload::Submit(std::unique_ptr<VulkanBuffer> stagingBuffer)
+	{
+		NazaraAssert(!m_isSubmitted, "upload has already been submitted");
+
+		m_stagingBuffer = std::move(stagingBuffer);
+
+		if (!m_transferCommandBuffer->End())
+			throw std::runtime_error("failed to end transfer command buffer: " + TranslateVulkanError(m_transferCommandBuffer->GetLastErrorCode()));
+
+		Vk::QueueHandle transferQueue = m_device.GetQueue(m_transferFamilyIndex, 0);
+
+		if (RequiresOwnershipTransfer())
+		{
+			Vk::CommandBuffer& acquireCommandBuffer = *m_acquireCommandBuffer;
+			if (!acquireCommandBuffer.End())
+				throw std::runtime_error("failed to end acquire command buffer: " + TranslateVulkanError(acquireCommandBuffer.GetLastErrorCode()));
+
+			if (!transferQueue.Submit(m_transferCommandBuffer, VK_NULL_HANDLE, 0, m_ownershipSemaphore))
+				throw std::runtime_error("failed to submit transfer command buffer: " + TranslateVulkanError(transferQueue.GetLastErrorCode()));
+
+			Vk::QueueHandle graphicsQueue = m_device.GetQueue(m_graphicsFamilyIndex, 0);
+			if (!graphicsQueue.Submit(acquireCommandBuffer, m_ownershipSemaphore, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_NULL_HANDLE, m_fence))
+				throw std::runtime_error("failed to submit acquire command buffer: " + TranslateVulkanError(graphicsQueue.GetLastErrorCode()));
+
+			m_device.SignalQueueTimeline(QueueType::Graphics, graphicsQueue);
+		}
+		else
+		{
+			if (!transferQueue.Submit(m_transferCommandBuffer, m_fence))
+				throw std::runtime_error("failed to submit transfer command buffer: " + TranslateVulkanError(transferQueue.GetLastErrorCode()));
+
+			m_device.SignalQueueTimeline(QueueType::Transfer, transferQueue);
+		}
+
+		m_isSubmitted = true;
+	}
+
+	void VulkanAsyncUpload::Wait()
+	{
+		NazaraAssert(m_isSubmitted, "upload has not been submitted");
+
+		m_fence.Wait();
+	}
+}
@@ -43,6 +43,14 @@ namespace Nz
 		if (usage & BufferUsage::PersistentMapping)
 			allocInfo.flags |= VMA_ALLOCATION_CREATE_MAPPED_BIT;
 
+		// Uniform buffers are small and frequently reallocated, keep them in their own blocks
+		if (type == BufferType::Uniform)
+		{
+			UInt32 memoryTypeIndex;
+			if (vmaFindMemoryTypeIndexForBufferInfo(m_device.GetMemoryAllocator(), &createInfo, &allocInfo, &memoryTypeIndex) == VK_SUCCESS)
+				allocInfo.pool = m_device.GetMemoryPool(Vk::Device::MemoryPool::UniformBuffers, memoryTypeIndex);
+		}
+
 		VkResult result = vmaCreateBuffer(m_device.GetMemoryAllocator(), &createInfo, &allocInfo, &m_buffer, &m_allocation, nullptr);
 		if (result != VK_SUCCESS)
 			throw std::runtime_error("failed to allocate buffer: " + TranslateVulkanError(result));
@@ -31,6 +31,8 @@ namespace Nz
 
 	void VulkanCommandBufferBuilder::BeginRenderPass(const Framebuffer& framebuffer, const RenderPass& renderPass, const Recti& renderRect, const ClearValues* clearValues, std::size_t clearValueCount)
 	{
+		m_statistics.renderPassCount++;
+
 		const VulkanRenderPass& vkRenderPass = static_cast<const VulkanRenderPass&>(renderPass);
 		const VulkanFramebuffer& vkFramebuffer = static_cast<const VulkanFramebuffer&>(framebuffer);
 
@@ -56,6 +58,13 @@ namespace Nz
 			}
 		}
 
+		m_currentFramebuffer = &vkFramebuffer;
+		m_currentRenderPass = &vkRenderPass;
+		m_currentSubpassIndex = 0;
+
+		if (vkRenderPass.UsesDynamicRendering())
+			return BeginRendering(vkFramebuffer, vkRenderPass, renderRect, vkClearValues.data());
+
 		VkRenderPassBeginInfo beginInfo = {};
 		beginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
 		beginInfo.renderPass = vkRenderPass.GetRenderPass();
@@ -68,13 +77,12 @@ namespace Nz
 		beginInfo.pClearValues = vkClearValues.data();
 
 		m_commandBuffer.BeginRenderPass(beginInfo);
-
-		m_currentRenderPass = &vkRenderPass;
-		m_currentSubpassIndex = 0;
 	}
 
 	void VulkanCommandBufferBuilder::BindComputePipeline(const ComputePipeline& pipeline)
 	{
+		m_statistics.pipelineBindCount++;
+
 		const VulkanComputePipeline& vkPipeline = static_cast<const VulkanComputePipeline&>(pipeline);
 
 		m_commandBuffer.BindPipeline(VK_PIPELINE_BIND_POINT_COMPUTE, vkPipeline.GetPipeline());
@@ -82,6 +90,8 @@ namespace Nz
 
 	void VulkanCommandBufferBuilder::BindComputeShaderBinding(UInt32 set, const ShaderBinding& binding)
 	{
+		m_statistics.shaderBindingBindCount++;
+
 		const VulkanShaderBinding& vkBinding = static_cast<const VulkanShaderBinding&>(binding);
 		const VulkanRenderPipelineLayout& pipelineLayout = vkBinding.GetOwner();
 
@@ -90,6 +100,8 @@ namespace Nz
 
 	void VulkanCommandBufferBuilder::BindComputeShaderBinding(const RenderPipelineLayout& pipelineLayout, UInt32 set, const ShaderBinding& binding)
 	{
+		m_statistics.shaderBindingBindCount++;
+
 		const VulkanRenderPipelineLayout& vkPipelineLayout = static_cast<const VulkanRenderPipelineLayout&>(pipelineLayout);
 		const VulkanShaderBinding& vkBinding = static_cast<const VulkanShaderBinding&>(binding);
 
@@ -105,6 +117,8 @@ namespace Nz
 
 	void VulkanCommandBufferBuilder::BindRenderPipeline(const RenderPipeline& pipeline)
 	{
+		m_statistics.pipelineBindCount++;
+
 		if (!m_currentRenderPass)
 			throw std::runtime_error("BindPipeline must be called in a RenderPass");
 
@@ -115,6 +129,8 @@ namespace Nz
 
 	void VulkanCommandBufferBuilder::BindRenderShaderBinding(UInt32 set, const ShaderBinding& binding)
 	{
+		m_statistics.shaderBindingBindCount++;
+
 		const VulkanShaderBinding& vkBinding = static_cast<const VulkanShaderBinding&>(binding);
 		const VulkanRenderPipelineLayout& pipelineLayout = vkBinding.GetOwner();
 
@@ -123,6 +139,8 @@ namespace Nz
 
 	void VulkanCommandBufferBuilder::BindRenderShaderBinding(const RenderPipelineLayout& pipelineLayout, UInt32 set, const ShaderBinding& binding)
 	{
+		m_statistics.shaderBindingBindCount++;
+
 		const VulkanRenderPipelineLayout& vkPipelineLayout = static_cast<const VulkanRenderPipelineLayout&>(pipelineLayout);
 		const VulkanShaderBinding& vkBinding = static_cast<const VulkanShaderBinding&>(binding);
 
@@ -241,6 +259,8 @@ namespace Nz
 
 	void VulkanCommandBufferBuilder::CopyBuffer(const RenderBufferView& source, const RenderBufferView& target, UInt64 size, UInt64 sourceOffset, UInt64 targetOffset)
 	{
+		m_statistics.transferredBytes += size;
+
 		VulkanBuffer& sourceBuffer = *static_cast<VulkanBuffer*>(source.GetBuffer());
 		VulkanBuffer& targetBuffer = *static_cast<VulkanBuffer*>(target.GetBuffer());
 
@@ -249,6 +269,8 @@ namespace Nz
 
 	void VulkanCommandBufferBuilder::CopyBuffer(const UploadPool::Allocation& allocation, const RenderBufferView& target, UInt64 size, UInt64 sourceOffset, UInt64 targetOffset)
 	{
+		m_statistics.transferredBytes += size;
+
 		const auto& vkAllocation = static_cast<const VulkanUploadPool::VulkanAllocation&>(allocation);
 		VulkanBuffer& targetBuffer = *static_cast<VulkanBuffer*>(target.GetBuffer());
 
@@ -291,19 +313,46 @@ namespace Nz
 
 	void VulkanCommandBufferBuilder::Dispatch(UInt32 workgroupX, UInt32 workgroupY, UInt32 workgroupZ)
 	{
+		m_statistics.computeDispatchCount++;
+
 		m_commandBuffer.Dispatch(workgroupX, workgroupY, workgroupZ);
 	}
 
 	void VulkanCommandBufferBuilder::Draw(UInt32 vertexCount, UInt32 instanceCount, UInt32 firstVertex, UInt32 firstInstance)
 	{
+		m_statistics.drawCallCount++;
+		m_statistics.drawnVertexCount += UInt64(vertexCount) * instanceCount;
+
 		m_commandBuffer.Draw(vertexCount, instanceCount, firstVertex, firstInstance);
 	}
 
 	void VulkanCommandBufferBuilder::DrawIndexed(UInt32 indexCount, UInt32 instanceCount, UInt32 firstIndex, UInt32 firstInstance)
 	{
+		m_statistics.drawCallCount++;
+		m_statistics.drawnVertexCount += UInt64(indexCount) * instanceCount;
+
 		m_commandBuffer.DrawIndexed(indexCount, instanceCount, firstIndex, 0, firstInstance);
 	}
 
+	void VulkanCommandBufferBuilder::DrawIndexedIndirect(const RenderBufferView& indirectBuffer, UInt32 drawCount, UInt32 stride)
+	{
+		m_statistics.drawCallCount += drawCount;
+
+		VulkanBuffer& vkBuffer = *static_cast<VulkanBuffer*>(indirectBuffer.GetBuffer());
+
+		m_commandBuffer.DrawIndexedIndirect(vkBuffer.GetBuffer(), indirectBuffer.GetOffset(), drawCount, stride);
+	}
+
+	void VulkanCommandBufferBuilder::DrawIndexedIndirectCount(const RenderBufferView& indirectBuffer, const RenderBufferView& countBuffer, UInt32 maxDrawCount, UInt32 stride)
+	{
+		m_statistics.drawCallCount++; //< actual draw count is only known by the GPU
+
+		VulkanBuffer& vkBuffer = *static_cast<VulkanBuffer*>(indirectBuffer.GetBuffer());
+		VulkanBuffer& vkCountBuffer = *static_cast<VulkanBuffer*>(countBuffer.GetBuffer());
+
+		m_commandBuffer.DrawIndexedIndirectCount(vkBuffer.GetBuffer(), indirectBuffer.GetOffset(), vkCountBuffer.GetBuffer(), countBuffer.GetOffset(), maxDrawCount, stride);
+	}
+
 	void VulkanCommandBufferBuilder::EndDebugRegion()
 	{
 		m_commandBuffer.EndDebugRegion();
@@ -311,7 +360,13 @@ namespace Nz
 
 	void VulkanCommandBufferBuilder::EndRenderPass()
 	{
-		m_commandBuffer.EndRenderPass();
+		assert(m_currentRenderPass);
+		if (m_currentRenderPass->UsesDynamicRendering())
+			EndRendering();
+		else
+			m_commandBuffer.EndRenderPass();
+
+		m_currentFramebuffer = nullptr;
 		m_currentRenderPass = nullptr;
 	}
 
@@ -325,8 +380,15 @@ namespace Nz
 		m_commandBuffer.InsertDebugLabel(labelEOS.data(), color);
 	}
 
+	void VulkanCommandBufferBuilder::MemoryBarrier(PipelineStageFlags srcStageMask, PipelineStageFlags dstStageMask, MemoryAccessFlags srcAccessMask, MemoryAccessFlags dstAccessMask)
+	{
+		m_commandBuffer.MemoryBarrier(ToVulkan(srcStageMask), ToVulkan(dstStageMask), ToVulkan(srcAccessMask), ToVulkan(dstAccessMask));
+	}
+
 	void VulkanCommandBufferBuilder::NextSubpass()
 	{
+		NazaraAssert(m_currentRenderPass && !m_currentRenderPass->UsesDynamicRendering(), "dynamic rendering passes have a single subpass");
+
 		m_commandBuffer.NextSubpass();
 		m_currentSubpassIndex++;
 	}
@@ -341,6 +403,16 @@ namespace Nz
 		m_commandBuffer.MemoryBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT);
 	}
 
+	void VulkanCommandBufferBuilder::PushConstants(const RenderPipelineLayout& pipelineLayout, UInt32 offset, UInt32 size, const void* data)
+	{
+		const VulkanRenderPipelineLayout& vkPipelineLayout = static_cast<const VulkanRenderPipelineLayout&>(pipelineLayout);
+
+		VkShaderStageFlags stageFlags = vkPipelineLayout.GetPushConstantStageFlags(offset, size);
+		NazaraAssert(stageFlags != 0, "push constants don't overlap any range of the pipeline layout");
+
+		m_commandBuffer.PushConstants(vkPipelineLayout.GetPipelineLayout(), stageFlags, offset, size, data);
+	}
+
 	void VulkanCommandBufferBuilder::SetScissor(const Recti& scissorRegion)
 	{
 		m_commandBuffer.SetScissor(scissorRegion);
@@ -351,10 +423,146 @@ namespace Nz
 		m_commandBuffer.SetViewport(Rectf(viewportRegion), 0.f, 1.f);
 	}
 
+	void VulkanCommandBufferBuilder::TextureAcquireBarrier(PipelineStageFlags srcStageMask, PipelineStageFlags dstStageMask, MemoryAccessFlags srcAccessMask, MemoryAccessFlags dstAccessMask, TextureLayout oldLayout, TextureLayout newLayout, QueueType srcQueue, QueueType dstQueue, const Texture& texture)
+	{
+		const VulkanTexture& vkTexture = static_cast<const VulkanTexture&>(texture);
+
+		const Vk::Device& device = *m_commandBuffer.GetPool().GetDevice();
+		UInt32 srcFamilyIndex = device.GetDefaultFamilyIndex(srcQueue);
+		UInt32 dstFamilyIndex = device.GetDefaultFamilyIndex(dstQueue);
+		if (srcFamilyIndex == dstFamilyIndex)
+		{
+			// No ownership transfer between queues of the same family, the acquire half performs the whole barrier
+			return TextureBarrier(srcStageMask, dstStageMask, srcAccessMask, dstAccessMask, oldLayout, newLayout, texture);
+		}
+
+		// Source accesses were made available by the release barrier and the semaphore signaled by the source queue
+		m_commandBuffer.ImageBarrier(ToVulkan(dstStageMask), ToVulkan(dstStageMask), VkDependencyFlags(0), 0, ToVulkan(dstAccessMask), ToVulkan(oldLayout), ToVulkan(newLayout), srcFamilyIndex, dstFamilyIndex, vkTexture.GetImage(), vkTexture.GetSubresourceRange());
+	}
+
 	void VulkanCommandBufferBuilder::TextureBarrier(PipelineStageFlags srcStageMask, PipelineStageFlags dstStageMask, MemoryAccessFlags srcAccessMask, MemoryAccessFlags dstAccessMask, TextureLayout oldLayout, TextureLayout newLayout, const Texture& texture)
 	{
 		const VulkanTexture& vkTexture = static_cast<const VulkanTexture&>(texture);
 
 		m_commandBuffer.ImageBarrier(ToVulkan(srcStageMask), ToVulkan(dstStageMask), VkDependencyFlags(0), ToVulkan(srcAccessMask), ToVulkan(dstAccessMask), ToVulkan(oldLayout), ToVulkan(newLayout), vkTexture.GetImage(), vkTexture.GetSubresourceRange());
 	}
+
+	void VulkanCommandBufferBuilder::TextureReleaseBarrier(PipelineStageFlags srcStageMask, PipelineStageFlags /*dstStageMask*/, MemoryAccessFlags srcAccessMask, MemoryAccessFlags /*dstAccessMask*/, TextureLayout oldLayout, TextureLayout newLayout, QueueType srcQueue, QueueType dstQueue, const Texture& texture)
+	{
+		const VulkanTexture& vkTexture = static_cast<const VulkanTexture&>(texture);
+
+		const Vk::Device& device = *m_commandBuffer.GetPool().GetDevice();
+		UInt32 srcFamilyIndex = device.GetDefaultFamilyIndex(srcQueue);
+		UInt32 dstFamilyIndex = device.GetDefaultFamilyIndex(dstQueue);
+		if (srcFamilyIndex == dstFamilyIndex)
+			return; //< handled by the acquire barrier
+
+		m_commandBuffer.ImageBarrier(ToVulkan(srcStageMask), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, VkDependencyFlags(0), ToVulkan(srcAccessMask), 0, ToVulkan(oldLayout), ToVulkan(newLayout), srcFamilyIndex, dstFamilyIndex, vkTexture.GetImage(), vkTexture.GetSubresourceRange());
+	}
+
+	void VulkanCommandBufferBuilder::BeginRendering(const VulkanFramebuffer& framebuffer, const VulkanRenderPass& renderPass, const Recti& renderRect, const VkClearValue* clearValues)
+	{
+		const auto& attachments = framebuffer.GetAttachments();
+		std::size_t attachmentCount = renderPass.GetAttachmentCount();
+		NazaraAssert(attachments.size() >= attachmentCount, "framebuffer has not enough attachments for this render pass");
+
+		// Render passes transition attachments to their subpass layout, we have to do it ourselves
+		const VulkanRenderPass::DynamicRenderingBarrier& beginBarrier = renderPass.GetBeginBarrier();
+
+		StackArray<VkImageMemoryBarrier> imageBarriers = NazaraStackArrayNoInit(VkImageMemoryBarrier, attachmentCount);
+		for (std::size_t i = 0; i < attachmentCount; ++i)
+		{
+			imageBarriers[i] = {
+				VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+				nullptr,
+				beginBarrier.srcAccessMask,
+				beginBarrier.dstAccessMask,
+				ToVulkan(renderPass.GetAttachment(i).initialLayout),
+				renderPass.GetAttachmentLayout(i),
+				VK_QUEUE_FAMILY_IGNORED,
+				VK_QUEUE_FAMILY_IGNORED,
+				attachments[i].image,
+				attachments[i].subresourceRange
+			};
+		}
+
+		m_commandBuffer.PipelineBarrier(beginBarrier.srcStageMask, beginBarrier.dstStageMask, 0, 0, nullptr, 0, nullptr, UInt32(imageBarriers.size()), imageBarriers.data());
+
+		auto BuildAttachmentInfo = [&](const RenderPass::AttachmentReference& attachmentRef, bool stencil)
+		{
+			std::size_t attachmentIndex = attachmentRef.attachmentIndex;
+			const RenderPass::Attachment& attachmentInfo = renderPass.GetAttachment(attachmentIndex);
+
+			VkRenderingAttachmentInfo attachmentRendering = {};
+			attachmentRendering.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+			attachmentRendering.imageView = attachments[attachmentIndex].imageView;
+			attachmentRendering.imageLayout = ToVulkan(attachmentRef.attachmentLayout);
+			attachmentRendering.resolveMode = VK_RESOLVE_MODE_NONE;
+			attachmentRendering.loadOp = ToVulkan((stencil) ? attachmentInfo.stencilLoadOp : attachmentInfo.loadOp);
+			attachmentRendering.storeOp = ToVulkan((stencil) ? attachmentInfo.stencilStoreOp : attachmentInfo.storeOp);
+			attachmentRendering.clearValue = clearValues[attachmentIndex];
+
+			return attachmentRendering;
+		};
+
+		const RenderPass::SubpassDescription& subpassInfo = renderPass.GetSubpassDescriptions().front();
+		const VulkanRenderPass::RenderingFormats& renderingFormats = renderPass.GetRenderingFormats();
+
+		StackArray<VkRenderingAttachmentInfo> colorAttachments = NazaraStackArrayNoInit(VkRenderingAttachmentInfo, subpassInfo.colorAttachment.size());
+		for (std::size_t i = 0; i < subpassInfo.colorAttachment.size(); ++i)
+			colorAttachments[i] = BuildAttachmentInfo(subpassInfo.colorAttachment[i], false);
+
+		VkRenderingAttachmentInfo depthAttachment;
+		VkRenderingAttachmentInfo stencilAttachment;
+		if (subpassInfo.depthStencilAttachment)
+		{
+			depthAttachment = BuildAttachmentInfo(*subpassInfo.depthStencilAttachment, false);
+			stencilAttachment = BuildAttachmentInfo(*subpassInfo.depthStencilAttachment, true);
+		}
+
+		VkRenderingInfo renderingInfo = {};
+		renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
+		renderingInfo.renderArea.offset.x = renderRect.x;
+		renderingInfo.renderArea.offset.y = renderRect.y;
+		renderingInfo.renderArea.extent.width = renderRect.width;
+		renderingInfo.renderArea.extent.height = renderRect.height;
+		renderingInfo.layerCount = 1;
+		renderingInfo.colorAttachmentCount = UInt32(colorAttachments.size());
+		renderingInfo.pColorAttachments = colorAttachments.data();
+		renderingInfo.pDepthAttachment = (renderingFormats.depthFormat != VK_FORMAT_UNDEFINED) ? &depthAttachment : nullptr;
+		renderingInfo.pStencilAttachment = (renderingFormats.stencilFormat != VK_FORMAT_UNDEFINED) ? &stencilAttachment : nullptr;
+
+		m_commandBuffer.BeginRendering(renderingInfo);
+	}
+
+	void VulkanCommandBufferBuilder::EndRendering()
+	{
+		assert(m_currentFramebuffer && m_currentRenderPass);
+
+		m_commandBuffer.EndRendering();
+
+		// Transition attachments to their final layout, as render passes do
+		const auto& attachments = m_currentFramebuffer->GetAttachments();
+		const VulkanRenderPass::DynamicRenderingBarrier& endBarrier = m_currentRenderPass->GetEndBarrier();
+		std::size_t attachmentCount = m_currentRenderPass->GetAttachmentCount();
+
+		StackArray<VkImageMemoryBarrier> imageBarriers = NazaraStackArrayNoInit(VkImageMemoryBarrier, attachmentCount);
+		for (std::size_t i = 0; i < attachmentCount; ++i)
+		{
+			imageBarriers[i] = {
+				VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+				nullptr,
+				endBarrier.srcAccessMask,
+				endBarrier.dstAccessMask,
+				m_currentRenderPass->GetAttachmentLayout(i),
+				ToVulkan(m_currentRenderPass->GetAttachment(i).finalLayout),
+				VK_QUEUE_FAMILY_IGNORED,
+				VK_QUEUE_FAMILY_IGNORED,
+				attachments[i].image,
+				attachments[i].subresourceRange
+			};
+		}
+
+		m_commandBuffer.PipelineBarrier(endBarrier.srcStageMask, endBarrier.dstStageMask, 0, 0, nullptr, 0, nullptr, UInt32(imageBarriers.size()), imageBarriers.data());
+	}
 }
@@ -24,19 +24,28 @@ namespace Nz
 		if (!commandBuffer->End())
 			throw std::runtime_error("failed to build command buffer: " + TranslateVulkanError(commandBuffer->GetLastErrorCode()));
 
+		CommandBufferPtr builtCommandBuffer;
 		for (std::size_t i = 0; i < m_commandPools.size(); ++i)
 		{
 			if (m_commandPools[i].freeCommands.TestNone())
 				continue;
 
-			return AllocateFromPool(i, std::move(commandBuffer));
+			builtCommandBuffer = AllocateFromPool(i, std::move(commandBuffer));
+			break;
 		}
 
-		// No allocation could be made, time to allocate a new pool
-		std::size_t newPoolIndex = m_commandPools.size();
-		AllocatePool();
+		if (!builtCommandBuffer)
+		{
+			// No allocation could be made, time to allocate a new pool
+			std::size_t newPoolIndex = m_commandPools.size();
+			AllocatePool();
+
+			builtCommandBuffer = AllocateFromPool(newPoolIndex, std::move(commandBuffer));
+		}
+
+		builtCommandBuffer->UpdateStatistics(builder.GetStatistics());
 
-		return AllocateFromPool(newPoolIndex, std::move(commandBuffer));
+		return builtCommandBuffer;
 	}
 
 	void VulkanCommandPool::UpdateDebugName(std::string_view name)
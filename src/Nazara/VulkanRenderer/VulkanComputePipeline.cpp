@@ -45,7 +45,7 @@ namespace Nz
 		VulkanRenderPipelineLayout& pipelineLayout = *static_cast<VulkanRenderPipelineLayout*>(m_pipelineInfo.pipelineLayout.get());
 		createInfo.layout = pipelineLayout.GetPipelineLayout();
 
-		if (!m_pipeline.CreateCompute(device, createInfo))
+		if (!m_pipeline.CreateCompute(device, createInfo, device.GetPipelineCache()))
 			throw std::runtime_error("failed to create compute pipeline: " + TranslateVulkanError(m_pipeline.GetLastErrorCode()));
 	}
 
@@ -3,6 +3,11 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/VulkanRenderer/VulkanDevice.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Renderer/RenderFrame.hpp>
+#include <Nazara/VulkanRenderer/Utils.hpp>
+#include <Nazara/VulkanRenderer/VulkanAsyncUpload.hpp>
 #include <Nazara/VulkanRenderer/VulkanCommandBufferBuilder.hpp>
 #include <Nazara/VulkanRenderer/VulkanCommandPool.hpp>
 #include <Nazara/VulkanRenderer/VulkanComputePipeline.hpp>
@@ -15,11 +20,166 @@
 #include <Nazara/VulkanRenderer/VulkanTextureFramebuffer.hpp>
 #include <Nazara/VulkanRenderer/VulkanTextureSampler.hpp>
 #include <Nazara/VulkanRenderer/Wrapper/QueueHandle.hpp>
+#include <vma/vk_mem_alloc.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
 #include <Nazara/VulkanRenderer/Debug.hpp>
 
 namespace Nz
 {
-	VulkanDevice::~VulkanDevice() = default;
+	VulkanDevice::~VulkanDevice()
+	{
+		// Destroying an upload waits for its completion
+		m_pendingUploads.clear();
+
+		// Deferred releases may reference device objects, they must be released before the device is destroyed
+		if (static_cast<VkDevice>(*this) != VK_NULL_HANDLE)
+			Device::WaitForIdle();
+
+		ReleaseAllResources();
+
+		if (m_pipelineCache.IsValid() && !m_pipelineCacheFilePath.empty())
+			SavePipelineCache();
+
+		if (m_defragmentation.context != VK_NULL_HANDLE)
+		{
+			if (m_defragmentation.isPassPending)
+				EndDefragmentationPass();
+
+			if (m_defragmentation.context != VK_NULL_HANDLE)
+				vmaEndDefragmentation(GetMemoryAllocator(), m_defragmentation.context, nullptr);
+		}
+	}
+
+	/*!
+	* \brief Gives up the relocation of an allocation by the pending defragmentation pass, if any
+	* \return True if the allocation was being relocated, it will then be freed at the end of the pass
+	*
+	* This is called when destroying a relocated texture before the end of the pass, the texture only has to destroy its (new) image.
+	*
+	* \param allocation Allocation owned by the destroyed texture
+	*/
+	bool VulkanDevice::AbandonRelocation(VmaAllocation allocation)
+	{
+		if (!m_defragmentation.isPassPending)
+			return false;
+
+		for (UInt32 i = 0; i < m_defragmentation.moveCount; ++i)
+		{
+			VmaDefragmentationMove& move = m_defragmentation.moves[i];
+			if (move.srcAllocation == allocation && move.operation == VMA_DEFRAGMENTATION_MOVE_OPERATION_COPY)
+			{
+				move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_DESTROY;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void VulkanDevice::DefragmentStreamedTextures(RenderFrame& renderFrame, UInt64 maxBytes, const FunctionRef<void(Texture& texture)>& relocationCallback)
+	{
+		// Previous pass copies are still in flight
+		if (m_defragmentation.isPassPending)
+			return;
+
+		VmaAllocator allocator = GetMemoryAllocator();
+		if (m_defragmentation.context == VK_NULL_HANDLE)
+		{
+			// Streamed textures have a pool per memory type, defragment them one after the other
+			VmaPool pool = VK_NULL_HANDLE;
+			for (UInt32 i = 0; i < VK_MAX_MEMORY_TYPES && pool == VK_NULL_HANDLE; ++i)
+			{
+				m_defragmentation.memoryTypeIndex = (m_defragmentation.memoryTypeIndex + 1) % VK_MAX_MEMORY_TYPES;
+				pool = FindMemoryPool(MemoryPool::StreamedTextures, m_defragmentation.memoryTypeIndex);
+			}
+
+			if (pool == VK_NULL_HANDLE)
+				return;
+
+			VmaDefragmentationInfo defragmentationInfo = {};
+			defragmentationInfo.flags = VMA_DEFRAGMENTATION_FLAG_ALGORITHM_FAST_BIT;
+			defragmentationInfo.pool = pool;
+			defragmentationInfo.maxBytesPerPass = maxBytes;
+
+			VkResult result = vmaBeginDefragmentation(allocator, &defragmentationInfo, &m_defragmentation.context);
+			if (result != VK_SUCCESS)
+			{
+				NazaraError("failed to begin defragmentation: {0}", TranslateVulkanError(result));
+				m_defragmentation.context = VK_NULL_HANDLE;
+				return;
+			}
+		}
+
+		VmaDefragmentationPassMoveInfo passInfo = {};
+		VkResult result = vmaBeginDefragmentationPass(allocator, m_defragmentation.context, &passInfo);
+		if (result != VK_INCOMPLETE)
+		{
+			// VK_SUCCESS means there's nothing left to move in this pool
+			if (result != VK_SUCCESS)
+				NazaraError("failed to begin defragmentation pass: {0}", TranslateVulkanError(result));
+
+			vmaEndDefragmentation(allocator, m_defragmentation.context, nullptr);
+			m_defragmentation.context = VK_NULL_HANDLE;
+			return;
+		}
+
+		m_defragmentation.isPassPending = true;
+		m_defragmentation.moveCount = passInfo.moveCount;
+		m_defragmentation.moves = passInfo.pMoves;
+
+		struct PreviousImage
+		{
+			VkImage image;
+			Vk::ImageView imageView;
+		};
+
+		std::vector<PreviousImage> previousImages;
+		std::vector<VulkanTexture*> relocatedTextures;
+
+		renderFrame.Execute([&](CommandBufferBuilder& builder)
+		{
+			Vk::CommandBuffer& commandBuffer = static_cast<VulkanCommandBufferBuilder&>(builder).GetCommandBuffer();
+
+			for (UInt32 i = 0; i < passInfo.moveCount; ++i)
+			{
+				VmaDefragmentationMove& move = passInfo.pMoves[i];
+
+				VmaAllocationInfo allocationInfo;
+				vmaGetAllocationInfo(allocator, move.srcAllocation, &allocationInfo);
+
+				VulkanTexture* texture = static_cast<VulkanTexture*>(allocationInfo.pUserData);
+
+				PreviousImage& previousImage = previousImages.emplace_back();
+				if (!texture || !texture->Relocate(commandBuffer, move.dstTmpAllocation, previousImage.image, previousImage.imageView))
+				{
+					previousImages.pop_back();
+					move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+					continue;
+				}
+
+				relocatedTextures.push_back(texture);
+			}
+		}, QueueType::Graphics);
+
+		// Previous images may still be used by frames in flight, release them (and their memory) with this frame
+		renderFrame.PushReleaseCallback([this, previousImages = std::move(previousImages)]() mutable
+		{
+			for (PreviousImage& previousImage : previousImages)
+			{
+				previousImage.imageView.Destroy();
+				vkDestroyImage(*this, previousImage.image, nullptr);
+			}
+
+			EndDefragmentationPass();
+		});
+
+		for (VulkanTexture* texture : relocatedTextures)
+			relocationCallback(*texture);
+	}
 
 	const RenderDeviceInfo& VulkanDevice::GetDeviceInfo() const
 	{
@@ -31,6 +191,85 @@ namespace Nz
 		return m_enabledFeatures;
 	}
 
+	std::vector<RenderMemoryHeapStatistics> VulkanDevice::GetMemoryHeapStatistics() const
+	{
+		const VkPhysicalDeviceMemoryProperties& memoryProperties = GetPhysicalDeviceInfo().memoryProperties;
+
+		// Budget and process usage are estimated by VMA when VK_EXT_memory_budget isn't available
+		std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> budgets;
+		vmaGetHeapBudgets(GetMemoryAllocator(), budgets.data());
+
+		std::vector<RenderMemoryHeapStatistics> heapStatistics(memoryProperties.memoryHeapCount);
+		for (UInt32 heapIndex = 0; heapIndex < memoryProperties.memoryHeapCount; ++heapIndex)
+		{
+			const VkMemoryHeap& memoryHeap = memoryProperties.memoryHeaps[heapIndex];
+			const VmaBudget& budget = budgets[heapIndex];
+
+			RenderMemoryHeapStatistics& statistics = heapStatistics[heapIndex];
+			statistics.allocatedBytes = budget.statistics.blockBytes;
+			statistics.budgetBytes = budget.budget;
+			statistics.isDeviceLocal = (memoryHeap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+			statistics.processUsageBytes = budget.usage;
+			statistics.resourceBytes = budget.statistics.allocationBytes;
+			statistics.size = memoryHeap.size;
+		}
+
+		return heapStatistics;
+	}
+
+	/*!
+	* \brief Creates the pipeline cache used for every pipeline created by this device
+	*
+	* If a cache file path is given, the cache is filled with its content (if it was saved by the same physical device and driver) and it will be saved back to this path on device destruction.
+	*
+	* \param cacheFilePath Pipeline cache file path, can be empty to only keep the cache in memory
+	*
+	* \return True if the pipeline cache was created
+	*/
+	bool VulkanDevice::InitializePipelineCache(std::filesystem::path cacheFilePath)
+	{
+		m_pipelineCacheFilePath = std::move(cacheFilePath);
+
+		std::optional<std::vector<UInt8>> fileContent;
+		if (!m_pipelineCacheFilePath.empty() && std::filesystem::is_regular_file(m_pipelineCacheFilePath))
+			fileContent = File::ReadWhole(m_pipelineCacheFilePath);
+
+		const UInt8* initialData = nullptr;
+		std::size_t initialDataSize = 0;
+		if (fileContent && fileContent->size() >= sizeof(PipelineCacheHeader))
+		{
+			PipelineCacheHeader header;
+			std::memcpy(&header, fileContent->data(), sizeof(header));
+
+			const VkPhysicalDeviceProperties& properties = GetPhysicalDeviceInfo().properties;
+
+			// Drivers are not required to validate cache data, discard caches from another device or driver version
+			if (header.magic == PipelineCacheMagic && header.version == PipelineCacheVersion &&
+			    header.vendorID == properties.vendorID && header.deviceID == properties.deviceID && header.driverVersion == properties.driverVersion &&
+			    std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0 &&
+			    header.dataSize == fileContent->size() - sizeof(PipelineCacheHeader))
+			{
+				initialData = fileContent->data() + sizeof(PipelineCacheHeader);
+				initialDataSize = SafeCast<std::size_t>(header.dataSize);
+			}
+			else
+				NazaraWarning("pipeline cache {0} was created by another device or driver, ignoring it", m_pipelineCacheFilePath);
+		}
+
+		VkPipelineCacheCreateInfo createInfo = {};
+		createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		createInfo.initialDataSize = initialDataSize;
+		createInfo.pInitialData = initialData;
+
+		if (!m_pipelineCache.Create(*this, createInfo))
+		{
+			NazaraError("failed to create pipeline cache: {0}", TranslateVulkanError(m_pipelineCache.GetLastErrorCode()));
+			return false;
+		}
+
+		return true;
+	}
+
 	std::shared_ptr<RenderBuffer> VulkanDevice::InstantiateBuffer(BufferType type, UInt64 size, BufferUsageFlags usageFlags, const void* initialData)
 	{
 		return std::make_shared<VulkanBuffer>(*this, type, size, usageFlags, initialData);
@@ -108,6 +347,11 @@ namespace Nz
 		return std::make_shared<VulkanTextureSampler>(*this, params);
 	}
 
+	bool VulkanDevice::IsParallelCommandRecordingSupported() const
+	{
+		return true;
+	}
+
 	bool VulkanDevice::IsTextureFormatSupported(PixelFormat format, TextureUsage usage) const
 	{
 		VkFormat vulkanFormat = ToVulkan(format);
@@ -141,14 +385,284 @@ namespace Nz
 			case TextureUsage::TransferDestination:
 				flags = VK_FORMAT_FEATURE_TRANSFER_DST_BIT;
 				break;
+
+			case TextureUsage::TransientAttachment:
+				flags = VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT | VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT;
+				break;
+
+			case TextureUsage::Streamed:
+				flags = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
+				break;
 		}
 
 		VkFormatProperties formatProperties = GetInstance().GetPhysicalDeviceFormatProperties(GetPhysicalDevice(), vulkanFormat);
 		return formatProperties.optimalTilingFeatures & flags; //< Assume optimal tiling
 	}
 
+	/*!
+	* \brief Saves the pipeline cache to the file given to InitializePipelineCache
+	* \return True if the pipeline cache was saved
+	*/
+	bool VulkanDevice::SavePipelineCache() const
+	{
+		NazaraAssert(m_pipelineCache.IsValid(), "pipeline cache has not been initialized");
+
+		if (m_pipelineCacheFilePath.empty())
+		{
+			NazaraError("no pipeline cache file path was set");
+			return false;
+		}
+
+		std::vector<UInt8> cacheData;
+		if (!m_pipelineCache.GetData(&cacheData))
+			return false;
+
+		const VkPhysicalDeviceProperties& properties = GetPhysicalDeviceInfo().properties;
+
+		PipelineCacheHeader header = {};
+		header.magic = PipelineCacheMagic;
+		header.version = PipelineCacheVersion;
+		header.vendorID = properties.vendorID;
+		header.deviceID = properties.deviceID;
+		header.driverVersion = properties.driverVersion;
+		std::memcpy(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE);
+		header.dataSize = cacheData.size();
+
+		std::vector<UInt8> fileContent(sizeof(header) + cacheData.size());
+		std::memcpy(fileContent.data(), &header, sizeof(header));
+		if (!cacheData.empty())
+			std::memcpy(fileContent.data() + sizeof(header), cacheData.data(), cacheData.size());
+
+		if (!File::WriteWhole(m_pipelineCacheFilePath, fileContent.data(), fileContent.size()))
+		{
+			NazaraError("failed to save pipeline cache to {0}", m_pipelineCacheFilePath);
+			return false;
+		}
+
+		return true;
+	}
+
+	/*!
+	* \brief Uploads data to a buffer using the transfer queue, without waiting for the transfer to complete
+	* \return Handle to wait for the transfer completion
+	*
+	* If the transfer queue belongs to a different queue family than the graphics queue, a queue family ownership transfer is performed
+	* and the buffer becomes usable by the graphics queue once the handle is finished.
+	*
+	* \remark Directly-mapped buffers are filled synchronously
+	* \remark This function uses the device command pools and must be called from the thread submitting rendering commands
+	*/
+	std::shared_ptr<AsyncUpload> VulkanDevice::UploadAsync(RenderBuffer& buffer, const void* data, UInt64 offset, UInt64 size)
+	{
+		if (buffer.GetUsageFlags() & BufferUsage::DirectMapping)
+			return RenderDevice::UploadAsync(buffer, data, offset, size);
+
+		ReleaseFinishedUploads();
+
+		auto stagingBuffer = std::make_unique<VulkanBuffer>(*this, BufferType::Upload, size, BufferUsage::DirectMapping, data);
+
+		std::shared_ptr<VulkanAsyncUpload> upload = std::make_shared<VulkanAsyncUpload>(*this);
+
+		VkBuffer vkBuffer = static_cast<VulkanBuffer&>(buffer).GetBuffer();
+		upload->GetTransferCommandBuffer().CopyBuffer(stagingBuffer->GetBuffer(), vkBuffer, size, 0, offset);
+		upload->FinishBufferUpload(vkBuffer, offset, size);
+		upload->Submit(std::move(stagingBuffer));
+
+		m_pendingUploads.push_back(upload);
+		return upload;
+	}
+
+	/*!
+	* \brief Uploads data to a texture region using the transfer queue, without waiting for the transfer to complete
+	* \return Handle to wait for the transfer completion
+	*
+	* If the transfer queue belongs to a different queue family than the graphics queue, a queue family ownership transfer is performed
+	* and the texture becomes usable by the graphics queue once the handle is finished.
+	*
+	* \remark As with Texture::Update, previous contents of the updated layers of the mipmap level are discarded
+	* \remark This function uses the device command pools and must be called from the thread submitting rendering commands
+	*/
+	std::shared_ptr<AsyncUpload> VulkanDevice::UploadAsync(Texture& texture, const void* data, const Boxui& box, unsigned int srcWidth, unsigned int srcHeight, UInt8 level)
+	{
+		ReleaseFinishedUploads();
+
+		VulkanTexture& vkTexture = static_cast<VulkanTexture&>(texture);
+
+		unsigned int baseLayer, layerCount;
+		Image::RegionToArray(vkTexture.GetType(), box, baseLayer, layerCount);
+
+		VkImageSubresourceRange subresourceRange = vkTexture.BuildSubresourceRange(level, 1, baseLayer, layerCount);
+
+		std::shared_ptr<VulkanAsyncUpload> upload = std::make_shared<VulkanAsyncUpload>(*this);
+
+		Vk::CommandBuffer& transferCommandBuffer = upload->GetTransferCommandBuffer();
+		transferCommandBuffer.SetImageLayout(vkTexture.GetImage(), VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, subresourceRange);
+
+		std::unique_ptr<VulkanBuffer> stagingBuffer;
+		if (!vkTexture.Update(transferCommandBuffer, stagingBuffer, data, box, srcWidth, srcHeight, level))
+			return nullptr;
+
+		upload->FinishImageUpload(vkTexture.GetImage(), subresourceRange);
+		upload->Submit(std::move(stagingBuffer));
+
+		m_pendingUploads.push_back(upload);
+		return upload;
+	}
+
+	/*!
+	* \brief Signals the timeline of a queue once the GPU is done with the work submitted to it so far
+	*
+	* This is used to know when resources pushed for release (see RenderDevice::PushReleaseCallback) can be released,
+	* it has to be called after submitting work to a queue (timelines are tracked per queue type).
+	*
+	* With timeline semaphores (VK_KHR_timeline_semaphore or Vulkan 1.2) this submits a signal operation, otherwise a fence is used.
+	*
+	* \param queueType Type of the queue the work was submitted to
+	* \param queue Queue the work was submitted to
+	*
+	* \remark The queue has to be externally synchronized, as for any submission
+	*/
+	void VulkanDevice::SignalQueueTimeline(QueueType queueType, Vk::QueueHandle& queue)
+	{
+		std::unique_lock lock(m_queueTimelineMutex);
+
+		QueueTimeline& timeline = m_queueTimelines[queueType];
+		UInt64 signalValue = timeline.signaledValue + 1;
+
+		// Semaphore signal and fence operations are executed after every command submitted before them to the queue, submissions don't need command buffers
+		VkSubmitInfo submitInfo = {};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+
+		if (IsTimelineSemaphoreEnabled())
+		{
+			if (!timeline.semaphore.IsValid() && !timeline.semaphore.CreateTimeline(*this))
+				throw std::runtime_error("failed to create timeline semaphore: " + TranslateVulkanError(timeline.semaphore.GetLastErrorCode()));
+
+			VkSemaphore semaphore = timeline.semaphore;
+
+			VkTimelineSemaphoreSubmitInfo timelineSubmitInfo = {};
+			timelineSubmitInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+			timelineSubmitInfo.signalSemaphoreValueCount = 1;
+			timelineSubmitInfo.pSignalSemaphoreValues = &signalValue;
+
+			submitInfo.pNext = &timelineSubmitInfo;
+			submitInfo.signalSemaphoreCount = 1;
+			submitInfo.pSignalSemaphores = &semaphore;
+
+			if (!queue.Submit(submitInfo))
+				throw std::runtime_error("failed to signal timeline semaphore: " + TranslateVulkanError(queue.GetLastErrorCode()));
+		}
+		else
+		{
+			PendingFence& pendingFence = timeline.pendingFences.emplace_back();
+			pendingFence.timelineValue = signalValue;
+
+			if (!pendingFence.fence.Create(*this))
+			{
+				VkResult errorCode = pendingFence.fence.GetLastErrorCode();
+				timeline.pendingFences.pop_back();
+
+				throw std::runtime_error("failed to create fence: " + TranslateVulkanError(errorCode));
+			}
+
+			if (!queue.Submit(submitInfo, pendingFence.fence))
+			{
+				timeline.pendingFences.pop_back();
+				throw std::runtime_error("failed to signal fence: " + TranslateVulkanError(queue.GetLastErrorCode()));
+			}
+		}
+
+		timeline.signaledValue = signalValue;
+	}
+
 	void VulkanDevice::WaitForIdle()
 	{
 		Device::WaitForIdle();
+
+		m_pendingUploads.clear();
+
+		{
+			std::unique_lock lock(m_queueTimelineMutex);
+			for (QueueTimeline& timeline : m_queueTimelines)
+			{
+				timeline.completedValue = timeline.signaledValue;
+				timeline.pendingFences.clear();
+			}
+		}
+
+		ReleaseAllResources();
+	}
+
+	auto VulkanDevice::GetSubmittedTimelineValues() const -> QueueTimelineValues
+	{
+		std::unique_lock lock(m_queueTimelineMutex);
+
+		QueueTimelineValues timelineValues;
+		for (auto&& [queueType, timeline] : m_queueTimelines.iter_kv())
+			timelineValues[queueType] = timeline.signaledValue;
+
+		return timelineValues;
+	}
+
+	auto VulkanDevice::QueryCompletedTimelineValues() -> QueueTimelineValues
+	{
+		std::unique_lock lock(m_queueTimelineMutex);
+
+		QueueTimelineValues timelineValues;
+		for (auto&& [queueType, timeline] : m_queueTimelines.iter_kv())
+		{
+			if (timeline.semaphore.IsValid())
+			{
+				UInt64 counterValue;
+				if (timeline.semaphore.GetCounterValue(&counterValue))
+					timeline.completedValue = counterValue;
+			}
+			else
+			{
+				while (!timeline.pendingFences.empty())
+				{
+					PendingFence& pendingFence = timeline.pendingFences.front();
+
+					bool didTimeout;
+					if (!pendingFence.fence.Wait(0, &didTimeout) || didTimeout)
+						break;
+
+					timeline.completedValue = pendingFence.timelineValue;
+					timeline.pendingFences.pop_front();
+				}
+			}
+
+			timelineValues[queueType] = timeline.completedValue;
+		}
+
+		return timelineValues;
+	}
+
+	void VulkanDevice::EndDefragmentationPass()
+	{
+		assert(m_defragmentation.isPassPending);
+
+		VmaDefragmentationPassMoveInfo passInfo;
+		passInfo.moveCount = m_defragmentation.moveCount;
+		passInfo.pMoves = m_defragmentation.moves;
+
+		m_defragmentation.isPassPending = false;
+		m_defragmentation.moveCount = 0;
+		m_defragmentation.moves = nullptr;
+
+		// VK_INCOMPLETE means more passes are required
+		if (vmaEndDefragmentationPass(GetMemoryAllocator(), m_defragmentation.context, &passInfo) != VK_INCOMPLETE)
+		{
+			vmaEndDefragmentation(GetMemoryAllocator(), m_defragmentation.context, nullptr);
+			m_defragmentation.context = VK_NULL_HANDLE;
+		}
+	}
+
+	void VulkanDevice::ReleaseFinishedUploads()
+	{
+		auto it = std::remove_if(m_pendingUploads.begin(), m_pendingUploads.end(), [](const std::shared_ptr<VulkanAsyncUpload>& upload) { return upload->IsFinished(); });
+		m_pendingUploads.erase(it, m_pendingUploads.end());
+
+		ReleaseCompletedResources();
 	}
 }
@@ -9,6 +9,8 @@ namespace Nz
 {
 	void VulkanFramebuffer::UpdateDebugName(std::string_view name)
 	{
-		GetFramebuffer().SetDebugName(name);
+		Vk::Framebuffer& framebuffer = GetFramebuffer();
+		if (framebuffer.IsValid())
+			framebuffer.SetDebugName(name);
 	}
 }
@@ -3,9 +3,12 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/VulkanRenderer/VulkanRenderImage.hpp>
+#include <Nazara/Core/Error.hpp>
 #include <Nazara/VulkanRenderer/VulkanCommandBuffer.hpp>
 #include <Nazara/VulkanRenderer/VulkanCommandBufferBuilder.hpp>
+#include <Nazara/VulkanRenderer/VulkanDevice.hpp>
 #include <Nazara/VulkanRenderer/VulkanSwapchain.hpp>
+#include <NazaraUtils/StackVector.hpp>
 #include <cassert>
 #include <stdexcept>
 #include <Nazara/VulkanRenderer/Debug.hpp>
@@ -14,6 +17,7 @@ namespace Nz
 {
 	VulkanRenderImage::VulkanRenderImage(VulkanSwapchain& owner) :
 	m_freeCommandBufferIndex(0),
+	m_freeSemaphoreIndex(0),
 	m_owner(owner),
 	m_uploadPool(m_owner.GetDevice(), 2 * 1024 * 1024)
 	{
@@ -49,6 +53,8 @@ namespace Nz
 		if (!commandBuffer.End())
 			throw std::runtime_error("failed to build command buffer: " + TranslateVulkanError(commandBuffer.GetLastErrorCode()));
 
+		m_owner.GetDevice().RegisterCommandBufferSubmission(builder.GetStatistics());
+
 		SubmitCommandBuffer(commandBuffer, queueTypeFlags);
 	}
 
@@ -59,16 +65,51 @@ namespace Nz
 
 	void VulkanRenderImage::Present()
 	{
-		Vk::QueueHandle& graphicsQueue = m_owner.GetGraphicsQueue();
-		if (!graphicsQueue.Submit(UInt32(m_graphicalCommandBuffers.size()), m_graphicalCommandBuffers.data(), m_imageAvailableSemaphore, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, m_renderFinishedSemaphore, m_inFlightFence))
-			throw std::runtime_error("Failed to submit command buffers: " + TranslateVulkanError(graphicsQueue.GetLastErrorCode()));
+		// The in-flight fence is signaled by the last graphics submission, which has to wait for all compute work of the frame
+		if (FindLastSubmission(QueueType::Compute))
+			m_pendingQueueWaits[QueueType::Graphics] |= QueueType::Compute;
+
+		std::size_t finalSubmissionIndex = GetSubmission(QueueType::Graphics);
+
+		QueueSubmission& finalSubmission = m_submissions[finalSubmissionIndex];
+		finalSubmission.waitSemaphores.push_back(m_imageAvailableSemaphore);
+		finalSubmission.waitStages.push_back(VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+		finalSubmission.signalSemaphores.push_back(m_renderFinishedSemaphore);
+
+		for (std::size_t i = 0; i < m_submissions.size(); ++i)
+		{
+			const QueueSubmission& submission = m_submissions[i];
+
+			Vk::QueueHandle& queue = (submission.queueType == QueueType::Compute) ? m_owner.GetComputeQueue() : m_owner.GetGraphicsQueue();
+			VkFence signalFence = (i == finalSubmissionIndex) ? static_cast<VkFence>(m_inFlightFence) : VK_NULL_HANDLE;
+
+			if (!queue.Submit(UInt32(submission.commandBuffers.size()), submission.commandBuffers.data(), UInt32(submission.waitSemaphores.size()), submission.waitSemaphores.data(), submission.waitStages.data(), UInt32(submission.signalSemaphores.size()), submission.signalSemaphores.data(), signalFence))
+				throw std::runtime_error("Failed to submit command buffers: " + TranslateVulkanError(queue.GetLastErrorCode()));
+		}
+
+		VulkanDevice& device = m_owner.GetDevice();
+		if (FindLastSubmission(QueueType::Compute))
+			device.SignalQueueTimeline(QueueType::Compute, m_owner.GetComputeQueue());
+
+		device.SignalQueueTimeline(QueueType::Graphics, m_owner.GetGraphicsQueue());
 
 		m_owner.Present(m_imageIndex, m_renderFinishedSemaphore);
+
+		device.RegisterFramePresentation(m_uploadPool);
 	}
 
 	void VulkanRenderImage::SubmitCommandBuffer(CommandBuffer* commandBuffer, QueueTypeFlags queueTypeFlags)
 	{
 		VulkanCommandBuffer& vkCommandBuffer = *static_cast<VulkanCommandBuffer*>(commandBuffer);
+		m_owner.GetDevice().RegisterCommandBufferSubmission(vkCommandBuffer.GetStatistics());
+
+		// Command buffers submitted only to the compute queue come from a compute command pool and run on the (async) compute queue
+		if (queueTypeFlags == QueueType::Compute)
+		{
+			std::size_t submissionIndex = GetSubmission(QueueType::Compute);
+			m_submissions[submissionIndex].commandBuffers.push_back(vkCommandBuffer.GetCommandBuffer());
+			return;
+		}
 
 		return SubmitCommandBuffer(vkCommandBuffer.GetCommandBuffer(), queueTypeFlags);
 	}
@@ -76,12 +117,102 @@ namespace Nz
 	void VulkanRenderImage::SubmitCommandBuffer(VkCommandBuffer commandBuffer, QueueTypeFlags queueTypeFlags)
 	{
 		if (queueTypeFlags & QueueType::Graphics)
-			m_graphicalCommandBuffers.push_back(commandBuffer);
+		{
+			std::size_t submissionIndex = GetSubmission(QueueType::Graphics);
+			m_submissions[submissionIndex].commandBuffers.push_back(commandBuffer);
+		}
 		else
 		{
 			Vk::QueueHandle& graphicsQueue = m_owner.GetGraphicsQueue();
 			if (!graphicsQueue.Submit(commandBuffer))
 				throw std::runtime_error("Failed to submit command buffer: " + TranslateVulkanError(graphicsQueue.GetLastErrorCode()));
+
+			m_owner.GetDevice().SignalQueueTimeline(QueueType::Graphics, graphicsQueue);
 		}
 	}
+
+	void VulkanRenderImage::SynchronizeQueues(QueueType waitingQueue, QueueType signalingQueue)
+	{
+		NazaraAssert(waitingQueue != QueueType::Transfer && signalingQueue != QueueType::Transfer, "transfer queue cannot be synchronized");
+		if (waitingQueue == signalingQueue)
+			return; //< submissions to the same queue are already ordered
+
+		// Semaphores are only created once a command buffer is submitted to the waiting queue
+		m_pendingQueueWaits[waitingQueue] |= signalingQueue;
+	}
+
+	VkSemaphore VulkanRenderImage::AllocateSemaphore()
+	{
+		if (m_freeSemaphoreIndex >= m_queueSemaphores.size())
+		{
+			assert(m_freeSemaphoreIndex == m_queueSemaphores.size());
+
+			Vk::Semaphore& semaphore = m_queueSemaphores.emplace_back();
+			if (!semaphore.Create(m_owner.GetDevice()))
+				throw std::runtime_error("failed to create queue semaphore: " + TranslateVulkanError(semaphore.GetLastErrorCode()));
+		}
+
+		return m_queueSemaphores[m_freeSemaphoreIndex++];
+	}
+
+	auto VulkanRenderImage::FindLastSubmission(QueueType queueType) -> QueueSubmission*
+	{
+		for (auto it = m_submissions.rbegin(); it != m_submissions.rend(); ++it)
+		{
+			if (it->queueType == queueType)
+				return &*it;
+		}
+
+		return nullptr;
+	}
+
+	std::size_t VulkanRenderImage::GetSubmission(QueueType queueType)
+	{
+		QueueTypeFlags waitedQueues = m_pendingQueueWaits[queueType];
+		m_pendingQueueWaits[queueType] = QueueTypeFlags{};
+
+		// Frame graph resources are shared between frames, the first compute work of a frame waits for the graphics work of the previous ones
+		if (queueType == QueueType::Compute && !FindLastSubmission(QueueType::Compute))
+			waitedQueues |= QueueType::Graphics;
+
+		QueueSubmission* lastSubmission = FindLastSubmission(queueType);
+		if (lastSubmission && !lastSubmission->isClosed && !waitedQueues)
+			return static_cast<std::size_t>(lastSubmission - m_submissions.data());
+
+		if (lastSubmission)
+			lastSubmission->isClosed = true;
+
+		// Signal before creating the new submission as it may add submissions
+		StackVector<VkSemaphore> waitSemaphores = NazaraStackVector(VkSemaphore, static_cast<std::size_t>(QueueType::Max) + 1);
+		for (QueueType waitedQueue : waitedQueues)
+			waitSemaphores.push_back(SignalQueue(waitedQueue));
+
+		std::size_t submissionIndex = m_submissions.size();
+		QueueSubmission& submission = m_submissions.emplace_back();
+		submission.queueType = queueType;
+		for (VkSemaphore semaphore : waitSemaphores)
+		{
+			submission.waitSemaphores.push_back(semaphore);
+			submission.waitStages.push_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+		}
+
+		return submissionIndex;
+	}
+
+	VkSemaphore VulkanRenderImage::SignalQueue(QueueType queueType)
+	{
+		// Signal after all previous work submitted to that queue (an empty submission is enough if nothing was submitted during this frame)
+		QueueSubmission* submission = FindLastSubmission(queueType);
+		if (!submission)
+		{
+			submission = &m_submissions.emplace_back();
+			submission->queueType = queueType;
+		}
+
+		VkSemaphore semaphore = AllocateSemaphore();
+		submission->signalSemaphores.push_back(semaphore);
+		submission->isClosed = true;
+
+		return semaphore;
+	}
 }
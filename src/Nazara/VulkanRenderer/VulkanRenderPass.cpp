@@ -3,15 +3,112 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/VulkanRenderer/VulkanRenderPass.hpp>
+#include <Nazara/Utility/PixelFormat.hpp>
 #include <Nazara/VulkanRenderer/Utils.hpp>
+#include <NazaraUtils/Hash.hpp>
 #include <NazaraUtils/StackVector.hpp>
 #include <stdexcept>
+#include <utility>
 #include <Nazara/VulkanRenderer/Debug.hpp>
 
 namespace Nz
 {
 	VulkanRenderPass::VulkanRenderPass(Vk::Device& device, std::vector<Attachment> attachments, std::vector<SubpassDescription> subpassDescriptions, std::vector<SubpassDependency> subpassDependencies) :
-	RenderPass(std::move(attachments), std::move(subpassDescriptions), std::move(subpassDependencies))
+	RenderPass(std::move(attachments), std::move(subpassDescriptions), std::move(subpassDependencies)),
+	m_usesDynamicRendering(false)
+	{
+		// Dynamic rendering has no concept of subpasses, render passes relying on them still need a render pass object
+		if (device.IsDynamicRenderingEnabled() && m_subpassDescriptions.size() == 1 && m_subpassDescriptions.front().inputAttachments.empty())
+		{
+			m_usesDynamicRendering = true;
+			BuildDynamicRenderingInfo();
+		}
+		else
+			CreateRenderPass(device);
+	}
+
+	VulkanRenderPass::~VulkanRenderPass()
+	{
+		OnRenderPassRelease(this);
+	}
+
+	void VulkanRenderPass::UpdateDebugName(std::string_view name)
+	{
+		if (m_renderPass.IsValid())
+			m_renderPass.SetDebugName(name);
+	}
+
+	void VulkanRenderPass::BuildDynamicRenderingInfo()
+	{
+		const SubpassDescription& subpassInfo = m_subpassDescriptions.front();
+
+		// Attachments not referenced by the subpass are directly transitioned to their final layout
+		m_attachmentLayouts.resize(m_attachments.size());
+		for (std::size_t i = 0; i < m_attachments.size(); ++i)
+			m_attachmentLayouts[i] = ToVulkan(m_attachments[i].finalLayout);
+
+		m_renderingFormats.colorFormats.reserve(subpassInfo.colorAttachment.size());
+		for (const AttachmentReference& attachmentRef : subpassInfo.colorAttachment)
+		{
+			m_attachmentLayouts[attachmentRef.attachmentIndex] = ToVulkan(attachmentRef.attachmentLayout);
+			m_renderingFormats.colorFormats.push_back(ToVulkan(m_attachments[attachmentRef.attachmentIndex].format));
+		}
+
+		if (subpassInfo.depthStencilAttachment)
+		{
+			const AttachmentReference& attachmentRef = *subpassInfo.depthStencilAttachment;
+			m_attachmentLayouts[attachmentRef.attachmentIndex] = ToVulkan(attachmentRef.attachmentLayout);
+
+			PixelFormat format = m_attachments[attachmentRef.attachmentIndex].format;
+			PixelFormatContent content = PixelFormatInfo::GetContent(format);
+			if (content == PixelFormatContent::Depth || content == PixelFormatContent::DepthStencil)
+				m_renderingFormats.depthFormat = ToVulkan(format);
+
+			if (content == PixelFormatContent::DepthStencil || content == PixelFormatContent::Stencil)
+				m_renderingFormats.stencilFormat = ToVulkan(format);
+		}
+
+		for (VkFormat format : m_renderingFormats.colorFormats)
+			HashCombine(m_renderingFormats.hash, format);
+
+		HashCombine(m_renderingFormats.hash, m_renderingFormats.depthFormat);
+		HashCombine(m_renderingFormats.hash, m_renderingFormats.stencilFormat);
+
+		// Without external dependencies, render passes rely on implicit ones
+		constexpr VkAccessFlags attachmentReadWriteAccess = VK_ACCESS_INPUT_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+		constexpr VkAccessFlags attachmentWriteAccess = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+		m_beginBarrier = { 0, attachmentReadWriteAccess, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT };
+		m_endBarrier = { attachmentWriteAccess, 0, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT };
+
+		bool hasBeginDependency = false;
+		bool hasEndDependency = false;
+		for (const SubpassDependency& subpassDependency : m_subpassDependencies)
+		{
+			DynamicRenderingBarrier* barrier;
+			if (subpassDependency.fromSubpassIndex == ExternalSubpassIndex && subpassDependency.toSubpassIndex == 0)
+			{
+				barrier = &m_beginBarrier;
+				if (!std::exchange(hasBeginDependency, true))
+					*barrier = {};
+			}
+			else if (subpassDependency.fromSubpassIndex == 0 && subpassDependency.toSubpassIndex == ExternalSubpassIndex)
+			{
+				barrier = &m_endBarrier;
+				if (!std::exchange(hasEndDependency, true))
+					*barrier = {};
+			}
+			else
+				continue;
+
+			barrier->srcAccessMask |= ToVulkan(subpassDependency.fromAccessFlags);
+			barrier->dstAccessMask |= ToVulkan(subpassDependency.toAccessFlags);
+			barrier->srcStageMask |= ToVulkan(subpassDependency.fromStages);
+			barrier->dstStageMask |= ToVulkan(subpassDependency.toStages);
+		}
+	}
+
+	void VulkanRenderPass::CreateRenderPass(Vk::Device& device)
 	{
 		std::size_t totalAttachmentReference = 0;
 		for (const SubpassDescription& subpassInfo : m_subpassDescriptions)
@@ -40,7 +137,7 @@ namespace Nz
 		}
 
 		StackVector<VkAttachmentReference> vkAttachmentReferences = NazaraStackVector(VkAttachmentReference, totalAttachmentReference);
-		StackVector<UInt32> vkPreserveAttachments = NazaraStackVector(UInt32, attachments.size());
+		StackVector<UInt32> vkPreserveAttachments = NazaraStackVector(UInt32, m_attachments.size());
 
 		StackVector<VkSubpassDescription> vkSubpassDescs = NazaraStackVector(VkSubpassDescription, m_subpassDescriptions.size());
 		for (const SubpassDescription& subpassInfo : m_subpassDescriptions)
@@ -128,14 +225,4 @@ namespace Nz
 		if (!m_renderPass.Create(device, renderPassInfo))
 			throw std::runtime_error("failed to instantiate Vulkan render pass: " + TranslateVulkanError(m_renderPass.GetLastErrorCode()));
 	}
-
-	VulkanRenderPass::~VulkanRenderPass()
-	{
-		OnRenderPassRelease(this);
-	}
-
-	void VulkanRenderPass::UpdateDebugName(std::string_view name)
-	{
-		return m_renderPass.SetDebugName(name);
-	}
 }
@@ -24,6 +24,10 @@ namespace Nz
 
 	VkPipeline VulkanRenderPipeline::Get(const VulkanRenderPass& renderPass, std::size_t subpassIndex) const
 	{
+		// Dynamic rendering pipelines only depend on attachment formats
+		if (renderPass.UsesDynamicRendering())
+			return GetDynamicRenderingPipeline(renderPass.GetRenderingFormats());
+
 		const Vk::RenderPass& renderPassHandle = renderPass.GetRenderPass();
 
 		// Use color attachment count as a key
@@ -34,6 +38,8 @@ namespace Nz
 
 		std::pair<VkRenderPass, std::size_t> key = { renderPassHandle, colorAttachmentCount };
 
+		std::lock_guard lock(m_pipelineMutex);
+
 		if (auto it = m_pipelines.find(key); it != m_pipelines.end())
 			return it->second.pipeline;
 
@@ -45,10 +51,11 @@ namespace Nz
 		PipelineData pipelineData;
 		pipelineData.onRenderPassRelease.Connect(renderPass.OnRenderPassRelease, [this, key](const VulkanRenderPass*)
 		{
+			std::lock_guard lock(m_pipelineMutex);
 			m_pipelines.erase(key);
 		});
 
-		if (!pipelineData.pipeline.CreateGraphics(*m_device, pipelineCreateInfo))
+		if (!pipelineData.pipeline.CreateGraphics(*m_device, pipelineCreateInfo, m_device->GetPipelineCache()))
 			return VK_NULL_HANDLE;
 
 		if (!m_debugName.empty())
@@ -312,6 +319,42 @@ namespace Nz
 		return createInfo;
 	}
 
+	VkPipeline VulkanRenderPipeline::GetDynamicRenderingPipeline(const VulkanRenderPass::RenderingFormats& renderingFormats) const
+	{
+		std::lock_guard lock(m_pipelineMutex);
+
+		if (auto it = m_dynamicRenderingPipelines.find(renderingFormats); it != m_dynamicRenderingPipelines.end())
+			return it->second;
+
+		UInt32 colorAttachmentCount = UInt32(renderingFormats.colorFormats.size());
+		UpdateCreateInfo(colorAttachmentCount);
+
+		VkPipelineColorBlendStateCreateInfo colorBlendState = m_pipelineCreateInfo.stateData->colorBlendState;
+		colorBlendState.attachmentCount = colorAttachmentCount;
+
+		VkPipelineRenderingCreateInfo renderingCreateInfo = {};
+		renderingCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+		renderingCreateInfo.colorAttachmentCount = colorAttachmentCount;
+		renderingCreateInfo.pColorAttachmentFormats = renderingFormats.colorFormats.data();
+		renderingCreateInfo.depthAttachmentFormat = renderingFormats.depthFormat;
+		renderingCreateInfo.stencilAttachmentFormat = renderingFormats.stencilFormat;
+
+		VkGraphicsPipelineCreateInfo pipelineCreateInfo = m_pipelineCreateInfo.pipelineInfo;
+		pipelineCreateInfo.pNext = &renderingCreateInfo;
+		pipelineCreateInfo.pColorBlendState = &colorBlendState;
+		pipelineCreateInfo.renderPass = VK_NULL_HANDLE;
+
+		Vk::Pipeline pipeline;
+		if (!pipeline.CreateGraphics(*m_device, pipelineCreateInfo, m_device->GetPipelineCache()))
+			return VK_NULL_HANDLE;
+
+		if (!m_debugName.empty())
+			pipeline.SetDebugName(m_debugName);
+
+		auto it = m_dynamicRenderingPipelines.emplace(renderingFormats, std::move(pipeline)).first;
+		return it->second;
+	}
+
 	void VulkanRenderPipeline::UpdateCreateInfo(std::size_t colorBufferCount) const
 	{
 		// TODO: Add support for independent blend
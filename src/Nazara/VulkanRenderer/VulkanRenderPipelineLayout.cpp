@@ -9,6 +9,7 @@
 #include <NazaraUtils/MemoryHelper.hpp>
 #include <NazaraUtils/StackArray.hpp>
 #include <NazaraUtils/StackVector.hpp>
+#include <algorithm>
 #include <cassert>
 #include <stdexcept>
 #include <Nazara/VulkanRenderer/Debug.hpp>
@@ -19,7 +20,7 @@ namespace Nz
 	{
 		for (auto& pool : m_descriptorPools)
 		{
-			if (!pool.freeBindings.TestAll())
+			if (pool.usedBindingCount > 0)
 				NazaraWarning("Not all ShaderBinding have been released!");
 		}
 	}
@@ -28,18 +29,36 @@ namespace Nz
 	{
 		NazaraAssert(setIndex < m_descriptorSetLayouts.size(), "invalid set index");
 
+		// Fill the most used pools first, this gives lightly used pools a chance to become empty and to be released
+		std::size_t bestPoolIndex = m_descriptorPools.size();
 		for (std::size_t i = 0; i < m_descriptorPools.size(); ++i)
 		{
-			ShaderBindingPtr bindingPtr = AllocateFromPool(i, setIndex);
-			if (!bindingPtr)
+			const DescriptorPool& pool = m_descriptorPools[i];
+			if (!pool.descriptorPool || pool.usedBindingCount >= pool.freeBindings.GetSize())
 				continue;
 
-			return bindingPtr;
+			if (bestPoolIndex == m_descriptorPools.size() || pool.usedBindingCount > m_descriptorPools[bestPoolIndex].usedBindingCount)
+				bestPoolIndex = i;
+		}
+
+		if (bestPoolIndex != m_descriptorPools.size())
+		{
+			if (ShaderBindingPtr bindingPtr = AllocateFromPool(bestPoolIndex, setIndex))
+				return bindingPtr;
+
+			// Pool may be out of descriptors of a particular type, try the other ones
+			for (std::size_t i = 0; i < m_descriptorPools.size(); ++i)
+			{
+				if (i == bestPoolIndex || !m_descriptorPools[i].descriptorPool)
+					continue;
+
+				if (ShaderBindingPtr bindingPtr = AllocateFromPool(i, setIndex))
+					return bindingPtr;
+			}
 		}
 
 		// No allocation could be made, time to allocate a new pool
-		std::size_t newPoolIndex = m_descriptorPools.size();
-		AllocatePool();
+		std::size_t newPoolIndex = AllocatePool();
 
 		ShaderBindingPtr bindingPtr = AllocateFromPool(newPoolIndex, setIndex);
 		if (!bindingPtr)
@@ -73,6 +92,18 @@ namespace Nz
 			layoutBinding.descriptorType = ToVulkan(bindingInfo.type);
 			layoutBinding.pImmutableSamplers = nullptr;
 			layoutBinding.stageFlags = ToVulkan(bindingInfo.shaderStageFlags);
+
+			if (bindingInfo.flags)
+			{
+				// Binding flags are specified for every binding of the set, or none
+				descriptorSetLayoutInfo.bindingFlags.resize(descriptorSetLayoutInfo.bindings.size(), 0);
+				descriptorSetLayoutInfo.bindingFlags.back() = ToVulkan(bindingInfo.flags);
+
+				if (bindingInfo.flags.Test(ShaderBindingFlag::UpdateAfterBind))
+					descriptorSetLayoutInfo.createFlags |= VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+			}
+			else if (!descriptorSetLayoutInfo.bindingFlags.empty())
+				descriptorSetLayoutInfo.bindingFlags.push_back(0);
 		}
 
 		for (UInt32 i = 0; i < setCount; ++i)
@@ -81,40 +112,86 @@ namespace Nz
 			setLayouts[i] = *m_descriptorSetLayouts[i];
 		}
 
-		if (!m_pipelineLayout.Create(*m_device, UInt32(setLayouts.size()), setLayouts.data()))
+		StackArray<VkPushConstantRange> pushConstantRanges = NazaraStackArrayNoInit(VkPushConstantRange, m_layoutInfo.pushConstantRanges.size());
+		for (std::size_t i = 0; i < m_layoutInfo.pushConstantRanges.size(); ++i)
+		{
+			const auto& rangeInfo = m_layoutInfo.pushConstantRanges[i];
+
+			VkPushConstantRange& pushConstantRange = pushConstantRanges[i];
+			pushConstantRange.offset = rangeInfo.offset;
+			pushConstantRange.size = rangeInfo.size;
+			pushConstantRange.stageFlags = ToVulkan(rangeInfo.shaderStageFlags);
+		}
+
+		if (!m_pipelineLayout.Create(*m_device, UInt32(setLayouts.size()), setLayouts.data(), UInt32(pushConstantRanges.size()), pushConstantRanges.data()))
 			return false;
 
 		return true;
 	}
 
+	VkShaderStageFlags VulkanRenderPipelineLayout::GetPushConstantStageFlags(UInt32 offset, UInt32 size) const
+	{
+		// vkCmdPushConstants expects the stages of every range overlapping the updated bytes
+		VkShaderStageFlags stageFlags = 0;
+		for (const auto& rangeInfo : m_layoutInfo.pushConstantRanges)
+		{
+			if (offset < rangeInfo.offset + rangeInfo.size && rangeInfo.offset < offset + size)
+				stageFlags |= ToVulkan(rangeInfo.shaderStageFlags);
+		}
+
+		return stageFlags;
+	}
+
 	void VulkanRenderPipelineLayout::UpdateDebugName(std::string_view name)
 	{
 		m_pipelineLayout.SetDebugName(name);
 	}
 
-	auto VulkanRenderPipelineLayout::AllocatePool() -> DescriptorPool&
+	std::size_t VulkanRenderPipelineLayout::AllocatePool()
 	{
 		StackVector<VkDescriptorPoolSize> poolSizes = NazaraStackVector(VkDescriptorPoolSize, m_layoutInfo.bindings.size());
 
 		constexpr UInt32 MaxSet = 128;
+		constexpr UInt32 MaxUpdateAfterBindSet = 4; //< update-after-bind bindings are usually large arrays shared by many draws
 
+		VkDescriptorPoolCreateFlags poolFlags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
 		for (const auto& bindingInfo : m_layoutInfo.bindings)
 		{
+			UInt32 setCount = MaxSet;
+			if (bindingInfo.flags.Test(ShaderBindingFlag::UpdateAfterBind))
+			{
+				poolFlags |= VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+				setCount = MaxUpdateAfterBindSet;
+			}
+
 			VkDescriptorPoolSize& poolSize = poolSizes.emplace_back();
-			poolSize.descriptorCount = MaxSet;
+			poolSize.descriptorCount = setCount * bindingInfo.arraySize;
 			poolSize.type = ToVulkan(bindingInfo.type);
 		}
 
 		DescriptorPool pool;
 		pool.descriptorPool = std::make_unique<Vk::DescriptorPool>();
 
-		if (!pool.descriptorPool->Create(*m_device, MaxSet, UInt32(poolSizes.size()), poolSizes.data(), VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT))
+		if (!pool.descriptorPool->Create(*m_device, MaxSet, UInt32(poolSizes.size()), poolSizes.data(), poolFlags))
 			throw std::runtime_error("failed to allocate new descriptor pool: " + TranslateVulkanError(pool.descriptorPool->GetLastErrorCode()));
 
 		pool.freeBindings.Resize(MaxSet, true);
 		pool.storage = std::make_unique<DescriptorPool::BindingStorage[]>(MaxSet);
 
-		return m_descriptorPools.emplace_back(std::move(pool));
+		m_stats.descriptorPoolCount++;
+
+		// Reuse released pool slots before growing the pool list
+		for (std::size_t i = 0; i < m_descriptorPools.size(); ++i)
+		{
+			if (!m_descriptorPools[i].descriptorPool)
+			{
+				m_descriptorPools[i] = std::move(pool);
+				return i;
+			}
+		}
+
+		m_descriptorPools.emplace_back(std::move(pool));
+		return m_descriptorPools.size() - 1;
 	}
 
 	ShaderBindingPtr VulkanRenderPipelineLayout::AllocateFromPool(std::size_t poolIndex, UInt32 setIndex)
@@ -125,17 +202,49 @@ namespace Nz
 		if (freeBindingId == pool.freeBindings.npos)
 			return {}; //< No free binding in this pool
 
-		Vk::DescriptorSet descriptorSet = pool.descriptorPool->AllocateDescriptorSet(*m_descriptorSetLayouts[setIndex]);
-		if (!descriptorSet)
+		Vk::DescriptorSet descriptorSet;
+
+		auto it = std::find_if(pool.recycledSets.begin(), pool.recycledSets.end(), [&](const RecycledDescriptorSet& recycledSet) { return recycledSet.setIndex == setIndex; });
+		if (it != pool.recycledSets.end())
 		{
-			NazaraWarning("Failed to allocate descriptor set: " + TranslateVulkanError(pool.descriptorPool->GetLastErrorCode()));
-			return {};
+			descriptorSet = std::move(it->descriptorSet);
+			if (it != pool.recycledSets.end() - 1)
+				*it = std::move(pool.recycledSets.back());
+
+			pool.recycledSets.pop_back();
+
+			m_stats.recycledSetCount--;
+			m_stats.reusedSetCount++;
+		}
+		else
+		{
+			descriptorSet = pool.descriptorPool->AllocateDescriptorSet(*m_descriptorSetLayouts[setIndex]);
+			if (!descriptorSet && !pool.recycledSets.empty())
+			{
+				// Pool space may be held by descriptor sets recycled for other set indices, free them and retry
+				for (RecycledDescriptorSet& recycledSet : pool.recycledSets)
+					recycledSet.descriptorSet.Free();
+
+				m_stats.recycledSetCount -= pool.recycledSets.size();
+				pool.recycledSets.clear();
+
+				descriptorSet = pool.descriptorPool->AllocateDescriptorSet(*m_descriptorSetLayouts[setIndex]);
+			}
+
+			if (!descriptorSet)
+			{
+				NazaraWarning("Failed to allocate descriptor set: " + TranslateVulkanError(pool.descriptorPool->GetLastErrorCode()));
+				return {};
+			}
 		}
 
 		pool.freeBindings.Reset(freeBindingId);
+		pool.usedBindingCount++;
+
+		m_stats.allocatedBindingCount++;
 
 		VulkanShaderBinding* freeBindingMemory = reinterpret_cast<VulkanShaderBinding*>(&pool.storage[freeBindingId]);
-		return ShaderBindingPtr(PlacementNew(freeBindingMemory, *this, poolIndex, freeBindingId, std::move(descriptorSet)));
+		return ShaderBindingPtr(PlacementNew(freeBindingMemory, *this, poolIndex, freeBindingId, setIndex, std::move(descriptorSet)));
 	}
 
 	void VulkanRenderPipelineLayout::Release(ShaderBinding& binding)
@@ -149,13 +258,55 @@ namespace Nz
 		auto& pool = m_descriptorPools[poolIndex];
 		assert(!pool.freeBindings.Test(bindingIndex));
 
+		// Shader bindings are released once the GPU no longer uses them, keep their descriptor set for a future binding of the same set
+		auto& recycledSet = pool.recycledSets.emplace_back();
+		recycledSet.descriptorSet = std::move(vulkanBinding.m_descriptorSet.Get());
+		recycledSet.setIndex = vulkanBinding.GetSetIndex();
+
+		m_stats.recycledSetCount++;
+
 		VulkanShaderBinding* bindingMemory = reinterpret_cast<VulkanShaderBinding*>(&pool.storage[bindingIndex]);
 		PlacementDestroy(bindingMemory);
 
 		pool.freeBindings.Set(bindingIndex);
+		pool.usedBindingCount--;
+
+		m_stats.allocatedBindingCount--;
+
+		if (pool.usedBindingCount == 0)
+		{
+			// Keep a single empty pool around to prevent allocating a new pool right after releasing one
+			bool hasOtherEmptyPool = false;
+			for (std::size_t i = 0; i < m_descriptorPools.size(); ++i)
+			{
+				if (i != poolIndex && m_descriptorPools[i].descriptorPool && m_descriptorPools[i].usedBindingCount == 0)
+				{
+					hasOtherEmptyPool = true;
+					break;
+				}
+			}
+
+			if (hasOtherEmptyPool)
+			{
+				ReleasePool(poolIndex);
+				TryToShrink();
+			}
+		}
+	}
+
+	void VulkanRenderPipelineLayout::ReleasePool(std::size_t poolIndex)
+	{
+		auto& pool = m_descriptorPools[poolIndex];
+		assert(pool.usedBindingCount == 0);
+
+		// Destroying the pool frees every descriptor set allocated from it
+		m_stats.descriptorPoolCount--;
+		m_stats.recycledSetCount -= pool.recycledSets.size();
+		m_stats.releasedPoolCount++;
 
-		// Try to free pool if it's one of the last one
-		if (poolIndex >= m_descriptorPools.size() - 1 && poolIndex <= m_descriptorPools.size())
-			TryToShrink();
+		pool.descriptorPool.reset();
+		pool.freeBindings.Clear();
+		pool.recycledSets.clear();
+		pool.storage.reset();
 	}
 }
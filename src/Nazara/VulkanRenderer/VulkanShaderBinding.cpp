@@ -87,6 +87,7 @@ namespace Nz
 
 					writeOp.descriptorCount = arg.arraySize;
 					writeOp.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+					writeOp.dstArrayElement = arg.firstArrayElement;
 					writeOp.pImageInfo = &imageBinding[imageBinding.size() - arg.arraySize];
 				}
 				else if constexpr (std::is_same_v<T, StorageBufferBinding>)
@@ -75,6 +75,7 @@ namespace Nz
 			case ShaderLanguage::GLSL:
 			case ShaderLanguage::HLSL:
 			case ShaderLanguage::MSL:
+			case ShaderLanguage::WGSL:
 				break;
 
 			case ShaderLanguage::NazaraBinary:
@@ -36,8 +36,13 @@ namespace Nz
 	VulkanSwapchain::VulkanSwapchain(VulkanDevice& device, WindowHandle windowHandle, const Vector2ui& windowSize, const SwapchainParameters& parameters) :
 	m_currentFrame(0),
 	m_surface(device.GetInstance()),
+	m_framePacing(parameters.framePacing),
+	m_requestedFramesInFlight(parameters.framesInFlight),
+	m_firstPresentId(0),
+	m_lastPresentId(0),
 	m_swapchainSize(windowSize),
 	m_device(device),
+	m_hasWaitedForFrame(false),
 	m_shouldRecreateSwapchain(false)
 	{
 		if (!SetupSurface(windowHandle))
@@ -99,6 +104,9 @@ namespace Nz
 
 		assert(transferFamilyQueueIndex != UINT32_MAX);
 
+		m_isPresentWaitSupported = m_device.IsExtensionLoaded(VK_KHR_PRESENT_ID_EXTENSION_NAME) && m_device.IsExtensionLoaded(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+
+		m_computeQueue = m_device.GetQueue(m_device.GetDefaultFamilyIndex(QueueType::Compute), 0);
 		m_graphicsQueue = m_device.GetQueue(graphicsFamilyQueueIndex, 0);
 		m_presentQueue = m_device.GetQueue(presentableFamilyQueueIndex, 0);
 		m_transferQueue = m_device.GetQueue(transferFamilyQueueIndex, 0);
@@ -202,6 +210,9 @@ namespace Nz
 			invalidateFramebuffer = true;
 		}
 
+		if (m_framePacing == FramePacing::LowLatency)
+			WaitForFrame();
+
 		VulkanRenderImage& currentFrame = *m_concurrentImageData[m_currentFrame];
 		Vk::Fence& inFlightFence = currentFrame.GetInFlightFence();
 
@@ -245,6 +256,8 @@ namespace Nz
 
 		currentFrame.Reset(imageIndex);
 
+		m_device.ReleaseCompletedResources();
+
 		return RenderFrame(&currentFrame, invalidateFramebuffer, m_swapchainSize, imageIndex);
 	}
 
@@ -292,6 +305,11 @@ namespace Nz
 		return true;
 	}
 
+	FramePacing VulkanSwapchain::GetFramePacing() const
+	{
+		return m_framePacing;
+	}
+
 	const VulkanWindowFramebuffer& VulkanSwapchain::GetFramebuffer(std::size_t i) const
 	{
 		assert(i < m_framebuffers.size());
@@ -303,6 +321,11 @@ namespace Nz
 		return m_framebuffers.size();
 	}
 
+	std::optional<Time> VulkanSwapchain::GetLastPresentLatency() const
+	{
+		return m_lastPresentLatency;
+	}
+
 	const VulkanRenderPass& VulkanSwapchain::GetRenderPass() const
 	{
 		return *m_renderPass;
@@ -335,9 +358,32 @@ namespace Nz
 	{
 		NazaraAssert(imageIndex < m_inflightFences.size(), "Invalid image index");
 
-		m_currentFrame = (m_currentFrame + 1) % m_inflightFences.size();
+		m_currentFrame = (m_currentFrame + 1) % m_concurrentImageData.size();
+		m_hasWaitedForFrame = false;
 
-		m_presentQueue.Present(m_swapchain, imageIndex, waitSemaphore);
+		UInt64 presentId = ++m_lastPresentId;
+
+		VkSwapchainKHR swapchain = m_swapchain;
+
+		VkPresentIdKHR presentIdInfo = {
+			VK_STRUCTURE_TYPE_PRESENT_ID_KHR,
+			nullptr,
+			1U,
+			&presentId
+		};
+
+		VkPresentInfoKHR presentInfo = {
+			VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
+			(m_isPresentWaitSupported) ? &presentIdInfo : nullptr,
+			(waitSemaphore) ? 1U : 0U,
+			&waitSemaphore,
+			1U,
+			&swapchain,
+			&imageIndex,
+			nullptr
+		};
+
+		m_presentQueue.Present(presentInfo);
 
 		switch (m_presentQueue.GetLastErrorCode())
 		{
@@ -379,8 +425,36 @@ namespace Nz
 		return *m_concurrentImageData[m_currentFrame];
 	}
 
+	void VulkanSwapchain::WaitForFrame()
+	{
+		if (m_hasWaitedForFrame)
+			return;
+
+		UInt64 framesInFlight = m_concurrentImageData.size();
+		if (m_framePacing == FramePacing::LowLatency && m_isPresentWaitSupported)
+		{
+			// Each queued presentation adds a frame of latency, don't start a frame before the presentation engine caught up
+			if (m_lastPresentId >= m_firstPresentId + framesInFlight)
+				WaitForPresent(m_lastPresentId + 1 - framesInFlight);
+		}
+
+		// Wait until previous rendering using this frame resources has been done
+		m_concurrentImageData[m_currentFrame]->GetInFlightFence().Wait();
+
+		m_frameSampleTimes[(m_lastPresentId + 1) % m_frameSampleTimes.size()] = GetElapsedNanoseconds();
+		m_hasWaitedForFrame = true;
+	}
+
 	bool VulkanSwapchain::SetupDepthBuffer()
 	{
+		// Previous depth buffer may still be used by frames in flight
+		if (m_depthBuffer.IsValid())
+		{
+			m_device.PushForRelease(std::move(m_depthBufferView));
+			m_device.PushForRelease(std::move(m_depthBuffer));
+			m_device.PushForRelease(std::move(m_depthBufferMemory));
+		}
+
 		VkImageCreateInfo imageCreateInfo = {
 			VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,                                           // VkStructureType          sType;
 			nullptr,                                                                       // const void*              pNext;
@@ -461,11 +535,34 @@ namespace Nz
 	{
 		UInt32 imageCount = m_swapchain.GetImageCount();
 
+		VkImageSubresourceRange colorRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+		VkImageSubresourceRange depthStencilRange = { VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, 1 };
+		if (m_depthStencilFormat != VK_FORMAT_MAX_ENUM && PixelFormatInfo::GetContent(FromVulkan(m_depthStencilFormat).value()) == PixelFormatContent::DepthStencil)
+			depthStencilRange.aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
+
+		// Previous framebuffers may still be used by frames in flight
+		if (!m_framebuffers.empty())
+			m_device.PushForRelease(std::move(m_framebuffers));
+
 		m_framebuffers.clear();
 		m_framebuffers.reserve(imageCount);
 		for (UInt32 i = 0; i < imageCount; ++i)
 		{
-			std::array<VkImageView, 2> attachments = { m_swapchain.GetImage(i).view, m_depthBufferView };
+			const Vk::Swapchain::Image& image = m_swapchain.GetImage(i);
+
+			std::vector<VulkanFramebuffer::Attachment> framebufferAttachments;
+			framebufferAttachments.push_back({ image.image, image.view, colorRange });
+			if (m_depthBufferView.IsValid())
+				framebufferAttachments.push_back({ m_depthBuffer, m_depthBufferView, depthStencilRange });
+
+			// Dynamic rendering directly uses attachments
+			if (m_renderPass->UsesDynamicRendering())
+			{
+				m_framebuffers.emplace_back(Vk::Framebuffer{}, std::move(framebufferAttachments));
+				continue;
+			}
+
+			std::array<VkImageView, 2> attachments = { image.view, m_depthBufferView };
 
 			VkFramebufferCreateInfo frameBufferCreate = {
 				VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
@@ -487,7 +584,7 @@ namespace Nz
 				return false;
 			}
 
-			m_framebuffers.emplace_back(std::move(framebuffer));
+			m_framebuffers.emplace_back(std::move(framebuffer), std::move(framebufferAttachments));
 		}
 
 		return true;
@@ -614,8 +711,13 @@ namespace Nz
 		else
 			compositeAlpha = VK_COMPOSITE_ALPHA_INHERIT_BIT_KHR;
 
-		// Ensure all operations on the device have been finished before recreating the swapchain (this can be avoided but is more complicated)
-		m_device.WaitForIdle();
+		// Only wait for the rendering to the images of the previous swapchain instead of the whole device (async work keeps running),
+		// its resources are then destroyed through the device release queue
+		for (Vk::Fence* inflightFence : m_inflightFences)
+		{
+			if (inflightFence)
+				inflightFence->Wait();
+		}
 
 		VkSwapchainCreateInfoKHR swapchainInfo = {
 			VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR,
@@ -644,25 +746,72 @@ namespace Nz
 			return false;
 		}
 
+		// Passing the previous swapchain as oldSwapchain retired it, but it may still be used by the presentation engine
+		if (m_swapchain.IsValid())
+		{
+			Vk::Swapchain oldSwapchain = std::move(m_swapchain);
+			m_device.PushForRelease(std::move(oldSwapchain));
+		}
+
 		m_swapchain = std::move(newSwapchain);
 		m_swapchainSize = { SafeCast<unsigned int>(extent.width), SafeCast<unsigned int>(extent.height) };
 
 		// Framebuffers
 		imageCount = m_swapchain.GetImageCount();
 
+		m_inflightFences.clear();
 		m_inflightFences.resize(imageCount);
 
-		if (m_concurrentImageData.size() != imageCount)
+		// Present ids of the previous swapchain cannot be waited on using the new one
+		m_firstPresentId = m_lastPresentId;
+
+		std::size_t framesInFlight = (m_requestedFramesInFlight > 0) ? std::min<std::size_t>(m_requestedFramesInFlight, imageCount) : imageCount;
+		if (m_concurrentImageData.size() != framesInFlight)
 		{
+			// Frame resources are destroyed right away, wait until they're no longer used (fences of unused frames are created signaled)
+			for (auto& frame : m_concurrentImageData)
+				frame->GetInFlightFence().Wait();
+
 			m_concurrentImageData.clear();
-			m_concurrentImageData.reserve(imageCount);
+			m_concurrentImageData.reserve(framesInFlight);
 
-			for (std::size_t i = 0; i < imageCount; ++i)
+			for (std::size_t i = 0; i < framesInFlight; ++i)
 				m_concurrentImageData.emplace_back(std::make_unique<VulkanRenderImage>(*this));
+
+			m_currentFrame = 0;
+			m_frameSampleTimes.resize(framesInFlight + 1);
 		}
 
 		return true;
 	}
+
+	void VulkanSwapchain::WaitForPresent(UInt64 presentId)
+	{
+		if (!m_swapchain.WaitForPresent(presentId, PresentWaitTimeout))
+		{
+			switch (m_swapchain.GetLastErrorCode())
+			{
+				case VK_ERROR_OUT_OF_DATE_KHR:
+					m_shouldRecreateSwapchain = true;
+					return;
+
+				// Unhandled errors
+				case VK_ERROR_DEVICE_LOST:
+				case VK_ERROR_OUT_OF_DEVICE_MEMORY:
+				case VK_ERROR_OUT_OF_HOST_MEMORY:
+				case VK_ERROR_SURFACE_LOST_KHR: //< TODO: Handle it by recreating the surface?
+				case VK_ERROR_FULL_SCREEN_EXCLUSIVE_MODE_LOST_EXT:
+				default:
+					throw std::runtime_error("failed to wait for presentation: " + TranslateVulkanError(m_swapchain.GetLastErrorCode()));
+			}
+		}
+
+		if (m_swapchain.GetLastErrorCode() == VK_TIMEOUT)
+			return;
+
+		// The frame was presented, which gives us the input-to-photon latency of that frame
+		m_lastPresentLatency = GetElapsedNanoseconds() - m_frameSampleTimes[presentId % m_frameSampleTimes.size()];
+	}
 }
 
 #if defined(NAZARA_PLATFORM_WINDOWS)
@@ -9,8 +9,12 @@
 #include <Nazara/VulkanRenderer/Wrapper/CommandBuffer.hpp>
 #include <Nazara/VulkanRenderer/Wrapper/QueueHandle.hpp>
 #include <NazaraUtils/CallOnExit.hpp>
+#include <NazaraUtils/StackArray.hpp>
 #include <vma/vk_mem_alloc.h>
+#include <algorithm>
+#include <limits>
 #include <stdexcept>
+#include <utility>
 #include <Nazara/VulkanRenderer/Debug.hpp>
 
 namespace Nz
@@ -19,7 +23,8 @@ namespace Nz
 	m_device(device),
 	m_image(VK_NULL_HANDLE),
 	m_allocation(nullptr),
-	m_textureInfo(textureInfo)
+	m_textureInfo(textureInfo),
+	m_isRelocatable(true)
 	{
 		m_textureInfo.levelCount = std::min(m_textureInfo.levelCount, Image::GetMaxLevel(m_textureInfo.type, m_textureInfo.width, m_textureInfo.height, m_textureInfo.depth));
 		m_textureViewInfo = m_textureInfo;
@@ -109,7 +114,38 @@ namespace Nz
 		VmaAllocationCreateInfo allocInfo = {};
 		allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
 
-		VkResult result = vmaCreateImage(m_device.GetMemoryAllocator(), &createInfo, &allocInfo, &m_image, &m_allocation, nullptr);
+		auto SelectMemoryPool = [&](VmaAllocationCreateInfo& allocationInfo, Vk::Device::MemoryPool memoryPool)
+		{
+			UInt32 memoryTypeIndex;
+			if (vmaFindMemoryTypeIndexForImageInfo(m_device.GetMemoryAllocator(), &createInfo, &allocationInfo, &memoryTypeIndex) == VK_SUCCESS)
+				allocationInfo.pool = m_device.GetMemoryPool(memoryPool, memoryTypeIndex);
+		};
+
+		VkResult result = VK_ERROR_FEATURE_NOT_PRESENT;
+		if (m_textureInfo.usageFlags & TextureUsage::TransientAttachment)
+		{
+			// Transient attachments can live in tile memory on tiled GPUs, use lazily allocated memory if the device has some
+			VmaAllocationCreateInfo lazyAllocInfo = {};
+			lazyAllocInfo.usage = VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED;
+			SelectMemoryPool(lazyAllocInfo, Vk::Device::MemoryPool::TransientAttachments);
+
+			if (lazyAllocInfo.pool)
+				result = vmaCreateImage(m_device.GetMemoryAllocator(), &createInfo, &lazyAllocInfo, &m_image, &m_allocation, nullptr);
+
+			SelectMemoryPool(allocInfo, Vk::Device::MemoryPool::TransientAttachments);
+		}
+		else if (m_textureInfo.usageFlags & TextureUsage::Streamed)
+		{
+			// Streamed textures must not spill out of device memory (the streamer lowers their residency instead),
+			// they are tagged with the texture so defragmentation can relocate them
+			allocInfo.flags |= VMA_ALLOCATION_CREATE_WITHIN_BUDGET_BIT;
+			allocInfo.pUserData = this;
+			SelectMemoryPool(allocInfo, Vk::Device::MemoryPool::StreamedTextures);
+		}
+
+		if (result != VK_SUCCESS)
+			result = vmaCreateImage(m_device.GetMemoryAllocator(), &createInfo, &allocInfo, &m_image, &m_allocation, nullptr);
+
 		if (result != VK_SUCCESS)
 			throw std::runtime_error("Failed to allocate image: " + TranslateVulkanError(result));
 
@@ -130,6 +166,10 @@ namespace Nz
 		if (!m_imageView.Create(m_device, createInfoView))
 			throw std::runtime_error("Failed to create default image view: " + TranslateVulkanError(m_imageView.GetLastErrorCode()));
 
+		// Keep creation infos to be able to recreate the image and its view on relocation
+		m_imageCreateInfo = createInfo;
+		m_imageViewCreateInfo = createInfoView;
+
 		releaseImage.Reset();
 	}
 
@@ -209,8 +249,12 @@ namespace Nz
 	m_device(m_parentTexture->m_device),
 	m_image(m_parentTexture->m_image),
 	m_allocation(nullptr),
-	m_textureInfo(m_parentTexture->m_textureInfo)
+	m_textureInfo(m_parentTexture->m_textureInfo),
+	m_isRelocatable(false)
 	{
+		// Views reference the parent image, which can no longer be replaced
+		m_parentTexture->m_isRelocatable = false;
+
 		m_textureViewInfo = ApplyView(m_parentTexture->m_textureViewInfo, viewInfo);
 
 		NazaraAssert(viewInfo.layerCount <= m_parentTexture->m_textureViewInfo.layerCount - viewInfo.baseArrayLayer, "layer count exceeds number of layers");
@@ -299,7 +343,13 @@ namespace Nz
 	VulkanTexture::~VulkanTexture()
 	{
 		if (m_allocation)
-			vmaDestroyImage(m_device.GetMemoryAllocator(), m_image, m_allocation);
+		{
+			// A texture relocated by a pending defragmentation pass only owns its new image, allocations are released when the pass ends
+			if ((m_textureInfo.usageFlags & TextureUsage::Streamed) && m_device.AbandonRelocation(m_allocation))
+				m_device.vkDestroyImage(m_device, m_image, nullptr);
+			else
+				vmaDestroyImage(m_device.GetMemoryAllocator(), m_image, m_allocation);
+		}
 	}
 
 	bool VulkanTexture::Copy(const Texture& source, const Boxui& srcBox, const Vector3ui& dstPos)
@@ -371,6 +421,83 @@ namespace Nz
 		return std::make_shared<VulkanTexture>(std::static_pointer_cast<VulkanTexture>(shared_from_this()), viewInfo);
 	}
 
+	/*!
+	* \brief Moves the texture content to another allocation, as part of memory defragmentation
+	* \return True if the texture was relocated
+	*
+	* A new image is created and bound to the allocation and the copy of the texture content is recorded in the command buffer.
+	* The texture uses the new image and view right away, the previous ones are returned to be released once the command buffer has been executed.
+	*
+	* \param commandBuffer Command buffer used to copy the texture content, it must be executed before any use of the texture
+	* \param allocation Destination allocation (as given by VMA defragmentation pass)
+	* \param previousImage Image used by the texture until now
+	* \param previousImageView Default image view used by the texture until now
+	*
+	* \remark The texture is expected to be in the shader read-only layout, as streamed textures are
+	*/
+	bool VulkanTexture::Relocate(Vk::CommandBuffer& commandBuffer, VmaAllocation allocation, VkImage& previousImage, Vk::ImageView& previousImageView)
+	{
+		if (!m_isRelocatable)
+			return false;
+
+		VkImage image;
+		VkResult result = m_device.vkCreateImage(m_device, &m_imageCreateInfo, nullptr, &image);
+		if (result != VK_SUCCESS)
+		{
+			NazaraError("failed to create relocated image: {0}", TranslateVulkanError(result));
+			return false;
+		}
+
+		CallOnExit destroyImage([&] { m_device.vkDestroyImage(m_device, image, nullptr); });
+
+		result = vmaBindImageMemory(m_device.GetMemoryAllocator(), allocation, image);
+		if (result != VK_SUCCESS)
+		{
+			NazaraError("failed to bind relocated image memory: {0}", TranslateVulkanError(result));
+			return false;
+		}
+
+		VkImageViewCreateInfo createInfoView = m_imageViewCreateInfo;
+		createInfoView.image = image;
+
+		Vk::ImageView imageView;
+		if (!imageView.Create(m_device, createInfoView))
+		{
+			NazaraError("failed to create relocated image view: {0}", TranslateVulkanError(imageView.GetLastErrorCode()));
+			return false;
+		}
+
+		VkImageSubresourceRange subresourceRange = BuildSubresourceRange(0, m_textureInfo.levelCount, 0, m_textureInfo.layerCount);
+
+		commandBuffer.SetImageLayout(m_image, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, subresourceRange);
+		commandBuffer.SetImageLayout(image, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, subresourceRange);
+
+		StackArray<VkImageCopy> regions = NazaraStackArrayNoInit(VkImageCopy, m_textureInfo.levelCount);
+		for (UInt8 level = 0; level < m_textureInfo.levelCount; ++level)
+		{
+			Vector3ui levelSize = GetSize(level);
+
+			VkImageCopy& region = regions[level];
+			region.srcSubresource = BuildSubresourceLayers(level, 0, m_textureInfo.layerCount);
+			region.srcOffset = { 0, 0, 0 };
+			region.dstSubresource = region.srcSubresource;
+			region.dstOffset = { 0, 0, 0 };
+			region.extent = { levelSize.x, levelSize.y, levelSize.z };
+		}
+
+		commandBuffer.CopyImage(m_image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, SafeCast<UInt32>(regions.size()), regions.data());
+
+		commandBuffer.SetImageLayout(image, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, subresourceRange);
+
+		destroyImage.Reset();
+
+		previousImage = std::exchange(m_image, image);
+		previousImageView = std::move(m_imageView);
+		m_imageView = std::move(imageView);
+
+		return true;
+	}
+
 	bool VulkanTexture::Update(const void* ptr, const Boxui& box, unsigned int srcWidth, unsigned int srcHeight, UInt8 level)
 	{
 		Vk::AutoCommandBuffer copyCommandBuffer = m_device.AllocateCommandBuffer(QueueType::Graphics);
@@ -403,7 +530,7 @@ namespace Nz
 
 	bool VulkanTexture::Update(Vk::CommandBuffer& commandBuffer, std::unique_ptr<VulkanBuffer>& uploadBuffer, const void* ptr, const Boxui& box, unsigned int srcWidth, unsigned int srcHeight, UInt8 level)
 	{
-		std::size_t memorySize = box.width * box.height * box.depth * PixelFormatInfo::GetBytesPerPixel(m_textureViewInfo.pixelFormat);
+		std::size_t memorySize = PixelFormatInfo::ComputeSize(m_textureViewInfo.pixelFormat, box.width, box.height, box.depth);
 
 		uploadBuffer = std::make_unique<VulkanBuffer>(m_device, BufferType::Upload, memorySize, BufferUsage::DirectMapping);
 		void* mappedUploadBuffer = uploadBuffer->Map(0, memorySize);
@@ -414,7 +541,8 @@ namespace Nz
 		if (srcHeight == 0)
 			srcHeight = box.height;
 
-		if (srcWidth == box.width && srcHeight == box.height)
+		// Block-compressed data is expected to be tightly packed
+		if ((srcWidth == box.width && srcHeight == box.height) || PixelFormatInfo::IsCompressed(m_textureViewInfo.pixelFormat))
 			std::memcpy(mappedUploadBuffer, ptr, memorySize);
 		else
 		{
@@ -472,6 +600,70 @@ namespace Nz
 		return true;
 	}
 
+	bool VulkanTexture::UpdateRegions(const void* pixels, const UpdateRegion* regions, std::size_t regionCount)
+	{
+		if (regionCount == 0)
+			return true;
+
+		// Every region goes through the same staging buffer and command buffer, so a batch costs a single submission
+		StackArray<VkBufferImageCopy> copyRegions = NazaraStackArrayNoInit(VkBufferImageCopy, regionCount);
+
+		std::size_t uploadSize = 0;
+		UInt32 minLevel = std::numeric_limits<UInt32>::max();
+		UInt32 maxLevel = 0;
+		UInt32 minLayer = std::numeric_limits<UInt32>::max();
+		UInt32 maxLayer = 0;
+		for (std::size_t i = 0; i < regionCount; ++i)
+		{
+			const UpdateRegion& region = regions[i];
+			uploadSize = std::max(uploadSize, region.offset + PixelFormatInfo::ComputeSize(m_textureViewInfo.pixelFormat, region.box.width, region.box.height, region.box.depth));
+
+			unsigned int baseLayer, layerCount;
+			Boxui copyBox = Image::RegionToArray(m_textureViewInfo.type, region.box, baseLayer, layerCount);
+
+			minLevel = std::min<UInt32>(minLevel, region.level);
+			maxLevel = std::max<UInt32>(maxLevel, region.level);
+			minLayer = std::min<UInt32>(minLayer, baseLayer);
+			maxLayer = std::max<UInt32>(maxLayer, baseLayer + layerCount - 1);
+
+			copyRegions[i] = {
+				region.offset,
+				0,
+				0,
+				BuildSubresourceLayers(region.level, baseLayer, layerCount),
+				{ // imageOffset
+					SafeCast<Int32>(copyBox.x), SafeCast<Int32>(copyBox.y), SafeCast<Int32>(copyBox.z)
+				},
+				{ // imageExtent
+					copyBox.width, copyBox.height, copyBox.depth
+				}
+			};
+		}
+
+		VulkanBuffer uploadBuffer(m_device, BufferType::Upload, uploadSize, BufferUsage::DirectMapping, pixels);
+
+		Vk::AutoCommandBuffer copyCommandBuffer = m_device.AllocateCommandBuffer(QueueType::Graphics);
+		if (!copyCommandBuffer->Begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT))
+			return false;
+
+		VkImageSubresourceRange subresourceRange = BuildSubresourceRange(minLevel, maxLevel - minLevel + 1, minLayer, maxLayer - minLayer + 1);
+
+		copyCommandBuffer->SetImageLayout(m_image, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, subresourceRange);
+		copyCommandBuffer->CopyBufferToImage(uploadBuffer.GetBuffer(), m_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, SafeCast<UInt32>(regionCount), copyRegions.data());
+		copyCommandBuffer->SetImageLayout(m_image, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, subresourceRange);
+
+		if (!copyCommandBuffer->End())
+			return false;
+
+		Vk::QueueHandle transferQueue = m_device.GetQueue(m_device.GetDefaultFamilyIndex(QueueType::Graphics), 0);
+		if (!transferQueue.Submit(copyCommandBuffer))
+			return false;
+
+		transferQueue.WaitIdle();
+
+		return true;
+	}
+
 	void VulkanTexture::UpdateDebugName(std::string_view name)
 	{
 		if (!m_parentTexture)
@@ -18,14 +18,21 @@ namespace Nz
 		const VulkanRenderPass& vkRenderPass = static_cast<const VulkanRenderPass&>(*renderPass);
 
 		StackArray<VkImageView> imageViews = NazaraStackArrayNoInit(VkImageView, attachments.size());
+		m_attachments.reserve(attachments.size());
 		for (std::size_t i = 0; i < attachments.size(); ++i)
 		{
 			assert(attachments[i]);
 
 			const VulkanTexture& vkTexture = static_cast<const VulkanTexture&>(*attachments[i]);
 			imageViews[i] = vkTexture.GetImageView();
+
+			m_attachments.push_back({ vkTexture.GetImage(), vkTexture.GetImageView(), vkTexture.GetSubresourceRange() });
 		}
 
+		// Dynamic rendering only needs attachment views, which allows to skip framebuffer creation (notably on resize)
+		if (vkRenderPass.UsesDynamicRendering())
+			return;
+
 		VkFramebufferCreateInfo createInfo = {
 			VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
 			nullptr,
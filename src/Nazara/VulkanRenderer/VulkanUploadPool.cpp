@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/VulkanRenderer/VulkanUploadPool.hpp>
+#include <algorithm>
 #include <cassert>
 #include <stdexcept>
 #include <Nazara/VulkanRenderer/Debug.hpp>
@@ -46,8 +47,9 @@ namespace Nz
 		// No block found, allocate a new one
 		if (!bestBlock.block)
 		{
+			// Grow geometrically to limit block creations under heavy usage, unused blocks will be released by Reset
 			// Handle really big allocations (TODO: Handle them separately as they shouldn't be common and can consume a lot of memory)
-			UInt64 blockSize = std::max(m_blockSize, size);
+			UInt64 blockSize = std::max({ m_blockSize, size, GetStats().reservedBytes });
 
 			Block newBlock;
 			newBlock.size = blockSize;
@@ -66,6 +68,8 @@ namespace Nz
 			if (!newBlock.blockMemory.Map())
 				throw std::runtime_error("failed to map buffer memory: " + TranslateVulkanError(newBlock.buffer.GetLastErrorCode()));
 
+			RegisterBlock(blockSize);
+
 			bestBlock.block = &m_blocks.emplace_back(std::move(newBlock));
 			bestBlock.alignedOffset = 0;
 			bestBlock.lostSpace = 0;
@@ -89,17 +93,35 @@ namespace Nz
 		allocationData.offset = bestBlock.alignedOffset;
 		allocationData.size = size;
 
-		bestBlock.block->freeOffset += size;
+		bestBlock.block->freeOffset = bestBlock.alignedOffset + size;
 		m_nextAllocationIndex++;
 
+		RegisterAllocation(size);
+
 		return allocationData;
 	}
 
 	void VulkanUploadPool::Reset()
 	{
 		for (Block& block : m_blocks)
+		{
+			if (block.freeOffset == 0)
+				block.unusedResetCount++;
+			else
+				block.unusedResetCount = 0;
+
 			block.freeOffset = 0;
+		}
+
+		// Allocations go to the first blocks with enough space, blocks past the high-water mark are at the end, release them if they stayed unused for a while (always keeping one)
+		while (m_blocks.size() > 1 && m_blocks.back().unusedResetCount >= UnusedBlockReleaseDelay)
+		{
+			UnregisterBlock(m_blocks.back().size);
+			m_blocks.pop_back();
+		}
 
 		m_nextAllocationIndex = 0;
+
+		RegisterReset();
 	}
 }
@@ -10,6 +10,7 @@
 #include <Nazara/VulkanRenderer/Wrapper/CommandPool.hpp>
 #include <Nazara/VulkanRenderer/Wrapper/QueueHandle.hpp>
 #include <NazaraUtils/CallOnExit.hpp>
+#include <mutex>
 
 #define VMA_IMPLEMENTATION
 #define VMA_STATIC_VULKAN_FUNCTIONS 0
@@ -29,7 +30,9 @@ namespace Nz
 			}
 
 			EnumArray<QueueType, Vk::CommandPool> commandPools;
+			EnumArray<MemoryPool, std::array<VmaPool, VK_MAX_MEMORY_TYPES>> memoryPools = {};
 			VulkanDescriptorSetLayoutCache setLayoutCache;
+			mutable std::mutex memoryPoolMutex;
 		};
 
 		Device::Device(Instance& instance) :
@@ -37,7 +40,9 @@ namespace Nz
 		m_physicalDevice(nullptr),
 		m_device(VK_NULL_HANDLE),
 		m_lastErrorCode(VK_SUCCESS),
-		m_memAllocator(VK_NULL_HANDLE)
+		m_memAllocator(VK_NULL_HANDLE),
+		m_isDynamicRenderingEnabled(false),
+		m_isTimelineSemaphoreEnabled(false)
 		{
 		}
 
@@ -78,6 +83,30 @@ namespace Nz
 			for (UInt32 i = 0; i < createInfo.enabledLayerCount; ++i)
 				m_loadedLayers.emplace(createInfo.ppEnabledLayerNames[i]);
 
+			// Look for enabled features we may rely on
+			m_isDynamicRenderingEnabled = false;
+			m_isTimelineSemaphoreEnabled = false;
+			for (const VkBaseInStructure* structure = static_cast<const VkBaseInStructure*>(createInfo.pNext); structure; structure = structure->pNext)
+			{
+				switch (structure->sType)
+				{
+					case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES:
+						m_isDynamicRenderingEnabled = reinterpret_cast<const VkPhysicalDeviceDynamicRenderingFeatures*>(structure)->dynamicRendering == VK_TRUE;
+						break;
+
+					case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES:
+						m_isTimelineSemaphoreEnabled = reinterpret_cast<const VkPhysicalDeviceTimelineSemaphoreFeatures*>(structure)->timelineSemaphore == VK_TRUE;
+						break;
+
+					case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES:
+						m_isTimelineSemaphoreEnabled = reinterpret_cast<const VkPhysicalDeviceVulkan12Features*>(structure)->timelineSemaphore == VK_TRUE;
+						break;
+
+					default:
+						break;
+				}
+			}
+
 			// Load all device-related functions
 			try
 			{
@@ -162,11 +191,8 @@ namespace Nz
 
 					m_defaultQueues[queueType] = familyInfo.familyIndex;
 
-					// Break only if queue has not been selected before
-					auto queueBegin = m_defaultQueues.begin();
-					auto queueEnd = queueBegin + static_cast<std::size_t>(queueType);
-
-					if (std::find(queueBegin, queueEnd, familyInfo.familyIndex) == queueEnd)
+					// Break only if queue has not been selected before (by another queue type)
+					if (std::count(m_defaultQueues.begin(), m_defaultQueues.end(), familyInfo.familyIndex) == 1)
 						break;
 				}
 
@@ -255,12 +281,64 @@ namespace Nz
 			}
 		}
 
+		/*!
+		* \brief Returns the VMA pool of a usage class for a memory type, if it was already created
+		* \return Memory pool or VK_NULL_HANDLE if no resource of this class was allocated from this memory type yet
+		*
+		* \param memoryPool Usage class of the pool
+		* \param memoryTypeIndex Memory type of the pool
+		*
+		* \see GetMemoryPool
+		*/
+		VmaPool Device::FindMemoryPool(MemoryPool memoryPool, UInt32 memoryTypeIndex) const
+		{
+			assert(m_internalData);
+			NazaraAssert(memoryTypeIndex < VK_MAX_MEMORY_TYPES, "invalid memory type index");
+
+			std::unique_lock lock(m_internalData->memoryPoolMutex);
+			return m_internalData->memoryPools[memoryPool][memoryTypeIndex];
+		}
+
 		const VulkanDescriptorSetLayoutCache& Device::GetDescriptorSetLayoutCache() const
 		{
 			assert(m_internalData);
 			return m_internalData->setLayoutCache;
 		}
 
+		/*!
+		* \brief Returns the VMA pool of a usage class for a memory type, creating it if necessary
+		* \return Memory pool or VK_NULL_HANDLE if it couldn't be created (allocations should then fallback to default pools)
+		*
+		* Resources of the same usage class share their memory blocks, which keeps short-lived or frequently reallocated resources from fragmenting the memory of other resources.
+		* A VMA pool only covers a single memory type, which must be chosen beforehand (using vmaFindMemoryTypeIndexForBufferInfo or vmaFindMemoryTypeIndexForImageInfo).
+		*
+		* \param memoryPool Usage class of the pool
+		* \param memoryTypeIndex Memory type of the pool
+		*/
+		VmaPool Device::GetMemoryPool(MemoryPool memoryPool, UInt32 memoryTypeIndex)
+		{
+			assert(m_internalData);
+			NazaraAssert(memoryTypeIndex < VK_MAX_MEMORY_TYPES, "invalid memory type index");
+
+			std::unique_lock lock(m_internalData->memoryPoolMutex);
+
+			VmaPool& pool = m_internalData->memoryPools[memoryPool][memoryTypeIndex];
+			if (pool == VK_NULL_HANDLE)
+			{
+				VmaPoolCreateInfo poolInfo = {};
+				poolInfo.memoryTypeIndex = memoryTypeIndex;
+
+				m_lastErrorCode = vmaCreatePool(m_memAllocator, &poolInfo, &pool);
+				if (m_lastErrorCode != VK_SUCCESS)
+				{
+					NazaraError("failed to create memory pool: {0}", TranslateVulkanError(m_lastErrorCode));
+					pool = VK_NULL_HANDLE;
+				}
+			}
+
+			return pool;
+		}
+
 		QueueHandle Device::GetQueue(UInt32 queueFamilyIndex, UInt32 queueIndex)
 		{
 			const auto& queues = GetEnabledQueues(queueFamilyIndex);
@@ -289,7 +367,21 @@ namespace Nz
 				vkDeviceWaitIdle(m_device);
 
 			if (m_memAllocator != VK_NULL_HANDLE)
+			{
+				if (m_internalData)
+				{
+					for (auto& memoryPools : m_internalData->memoryPools)
+					{
+						for (VmaPool pool : memoryPools)
+						{
+							if (pool != VK_NULL_HANDLE)
+								vmaDestroyPool(m_memAllocator, pool);
+						}
+					}
+				}
+
 				vmaDestroyAllocator(m_memAllocator);
+			}
 
 			m_internalData.reset();
 
@@ -0,0 +1,126 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/WebGPURenderer/WebGPUBuffer.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/WebGPURenderer/Utils.hpp>
+#include <Nazara/WebGPURenderer/WebGPUDevice.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	WebGPUBuffer::WebGPUBuffer(WebGPUDevice& device, BufferType type, UInt64 size, BufferUsageFlags usage, const void* initialData) :
+	RenderBuffer(device, type, size, usage),
+	m_mappedOffset(0),
+	m_mappedSize(0),
+	m_device(device)
+	{
+		// WebGPU requires buffer sizes and writes to be multiple of 4
+		UInt64 alignedSize = AlignPow2<UInt64>(size, 4);
+
+		WGPUBufferDescriptor bufferDesc = {};
+		bufferDesc.mappedAtCreation = (initialData != nullptr);
+		bufferDesc.size = alignedSize;
+		bufferDesc.usage = ToWebGPU(type);
+
+		m_buffer = wgpuDeviceCreateBuffer(m_device.GetHandle(), &bufferDesc);
+		if (!m_buffer)
+			throw std::runtime_error("failed to create WebGPU buffer");
+
+		if (initialData)
+		{
+			void* mappedPtr = wgpuBufferGetMappedRange(m_buffer, 0, alignedSize);
+			std::memcpy(mappedPtr, initialData, size);
+			wgpuBufferUnmap(m_buffer);
+		}
+
+		// Buffers can't be read back synchronously, keep a CPU copy of the contents of readable buffers
+		if (usage & BufferUsage::Read)
+		{
+			m_shadowBuffer.resize(alignedSize);
+			if (initialData)
+				std::memcpy(m_shadowBuffer.data(), initialData, size);
+		}
+	}
+
+	WebGPUBuffer::~WebGPUBuffer()
+	{
+		wgpuBufferRelease(m_buffer);
+	}
+
+	bool WebGPUBuffer::Fill(const void* data, UInt64 offset, UInt64 size)
+	{
+		NazaraAssert(offset + size <= GetSize(), "fill range exceeds buffer size");
+
+		if (!m_shadowBuffer.empty())
+			std::memcpy(&m_shadowBuffer[offset], data, size);
+
+		return Upload(data, offset, size);
+	}
+
+	void* WebGPUBuffer::Map(UInt64 offset, UInt64 size)
+	{
+		NazaraAssert(offset + size <= GetSize(), "map range exceeds buffer size");
+
+		m_mappedOffset = offset;
+		m_mappedSize = size;
+
+		if (!m_shadowBuffer.empty())
+			return &m_shadowBuffer[offset];
+
+		// Mapping is write-only without the Read usage, contents are uploaded on Unmap
+		m_stagingBuffer.resize(size);
+		return m_stagingBuffer.data();
+	}
+
+	bool WebGPUBuffer::Unmap()
+	{
+		const void* data = (!m_shadowBuffer.empty()) ? &m_shadowBuffer[m_mappedOffset] : m_stagingBuffer.data();
+		return Upload(data, m_mappedOffset, m_mappedSize);
+	}
+
+	void WebGPUBuffer::UpdateDebugName(std::string_view name)
+	{
+		wgpuBufferSetLabel(m_buffer, std::string(name).c_str());
+	}
+
+	bool WebGPUBuffer::Upload(const void* data, UInt64 offset, UInt64 size)
+	{
+		WGPUQueue queue = m_device.GetQueue();
+
+		if (offset % 4 == 0 && size % 4 == 0)
+		{
+			wgpuQueueWriteBuffer(queue, m_buffer, offset, data, size);
+			return true;
+		}
+
+		// Unaligned write, expand it using the shadow copy (which already holds the new data)
+		if (!m_shadowBuffer.empty())
+		{
+			UInt64 alignedOffset = offset & ~UInt64(3);
+			UInt64 alignedEnd = AlignPow2<UInt64>(offset + size, 4);
+
+			wgpuQueueWriteBuffer(queue, m_buffer, alignedOffset, &m_shadowBuffer[alignedOffset], alignedEnd - alignedOffset);
+			return true;
+		}
+
+		// Writing to the end of the buffer, the padding bytes can be overwritten
+		if (offset % 4 == 0 && offset + size == GetSize())
+		{
+			m_stagingBuffer.resize(AlignPow2<UInt64>(size, 4));
+			if (data != m_stagingBuffer.data())
+				std::memcpy(m_stagingBuffer.data(), data, size);
+
+			wgpuQueueWriteBuffer(queue, m_buffer, offset, m_stagingBuffer.data(), m_stagingBuffer.size());
+			return true;
+		}
+
+		NazaraError("unaligned WebGPU buffer write (offset: {0}, size: {1}), offset and size must be multiple of 4", offset, size);
+		return false;
+	}
+}
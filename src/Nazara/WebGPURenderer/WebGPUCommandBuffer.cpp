@@ -0,0 +1,304 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/WebGPURenderer/WebGPUCommandBuffer.hpp>
+#include <Nazara/Utility/PixelFormat.hpp>
+#include <Nazara/WebGPURenderer/Utils.hpp>
+#include <Nazara/WebGPURenderer/WebGPUComputePipeline.hpp>
+#include <Nazara/WebGPURenderer/WebGPUDevice.hpp>
+#include <Nazara/WebGPURenderer/WebGPUFramebuffer.hpp>
+#include <Nazara/WebGPURenderer/WebGPURenderPass.hpp>
+#include <Nazara/WebGPURenderer/WebGPURenderPipeline.hpp>
+#include <Nazara/WebGPURenderer/WebGPUShaderBinding.hpp>
+#include <Nazara/WebGPURenderer/WebGPUTexture.hpp>
+#include <NazaraUtils/StackArray.hpp>
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	struct WebGPUCommandBuffer::EncodingState
+	{
+		void EndComputePass()
+		{
+			if (!computePass)
+				return;
+
+			wgpuComputePassEncoderEnd(computePass);
+			wgpuComputePassEncoderRelease(computePass);
+			computePass = nullptr;
+		}
+
+		std::vector<const WebGPUShaderBinding*> computeBindings;
+		const WebGPUComputePipeline* computePipeline = nullptr;
+		const WebGPURenderPass* renderPass = nullptr;
+		WebGPUDevice& device;
+		WGPUCommandEncoder encoder;
+		WGPUComputePassEncoder computePass = nullptr;
+		WGPURenderPassEncoder renderPassEncoder = nullptr;
+	};
+
+	WGPUCommandBuffer WebGPUCommandBuffer::Encode(WebGPUDevice& device) const
+	{
+		WGPUCommandEncoderDescriptor encoderDesc = {};
+		encoderDesc.label = (!m_debugName.empty()) ? m_debugName.c_str() : nullptr;
+
+		EncodingState state{ {}, nullptr, nullptr, device, wgpuDeviceCreateCommandEncoder(device.GetHandle(), &encoderDesc) };
+
+		for (const CommandData& command : m_commands)
+			std::visit([&](auto&& commandData) { Execute(state, commandData); }, command);
+
+		state.EndComputePass();
+		NazaraAssert(!state.renderPassEncoder, "render pass was not ended");
+
+		WGPUCommandBufferDescriptor commandBufferDesc = {};
+		commandBufferDesc.label = encoderDesc.label;
+
+		WGPUCommandBuffer commandBuffer = wgpuCommandEncoderFinish(state.encoder, &commandBufferDesc);
+		wgpuCommandEncoderRelease(state.encoder);
+
+		return commandBuffer;
+	}
+
+	void WebGPUCommandBuffer::UpdateDebugName(std::string_view name)
+	{
+		m_debugName = name;
+	}
+
+	void WebGPUCommandBuffer::Release()
+	{
+		delete this;
+	}
+
+	void WebGPUCommandBuffer::Execute(EncodingState& state, const BeginDebugRegionCommand& command) const
+	{
+		if (state.renderPassEncoder)
+			wgpuRenderPassEncoderPushDebugGroup(state.renderPassEncoder, command.regionName.c_str());
+		else
+		{
+			state.EndComputePass();
+			wgpuCommandEncoderPushDebugGroup(state.encoder, command.regionName.c_str());
+		}
+	}
+
+	void WebGPUCommandBuffer::Execute(EncodingState& state, const BeginRenderPassCommand& command) const
+	{
+		NazaraAssert(!state.renderPassEncoder, "a render pass is already active");
+		state.EndComputePass();
+
+		const WebGPUFramebuffer& framebuffer = *command.framebuffer;
+		const WebGPURenderPass& renderPass = *command.renderPass;
+
+		const std::vector<std::size_t>& colorAttachmentIndices = renderPass.GetColorAttachmentIndices();
+
+		StackArray<WGPURenderPassColorAttachment> colorAttachments = NazaraStackArrayNoInit(WGPURenderPassColorAttachment, colorAttachmentIndices.size());
+		for (std::size_t i = 0; i < colorAttachmentIndices.size(); ++i)
+		{
+			std::size_t attachmentIndex = colorAttachmentIndices[i];
+			const auto& attachmentInfo = renderPass.GetAttachment(attachmentIndex);
+			const Color& clearColor = command.clearValues[attachmentIndex].color;
+
+			WGPURenderPassColorAttachment& colorAttachment = colorAttachments[i];
+			colorAttachment = {};
+			colorAttachment.clearValue = { clearColor.r, clearColor.g, clearColor.b, clearColor.a };
+			colorAttachment.loadOp = ToWebGPU(attachmentInfo.loadOp);
+			colorAttachment.storeOp = ToWebGPU(attachmentInfo.storeOp);
+			colorAttachment.view = framebuffer.GetAttachment(attachmentIndex);
+#ifdef WGPU_DEPTH_SLICE_UNDEFINED
+			colorAttachment.depthSlice = WGPU_DEPTH_SLICE_UNDEFINED;
+#endif
+		}
+
+		WGPURenderPassDescriptor renderPassDesc = {};
+		renderPassDesc.colorAttachmentCount = colorAttachments.size();
+		renderPassDesc.colorAttachments = colorAttachments.data();
+
+		WGPURenderPassDepthStencilAttachment depthStencilAttachment = {};
+
+		std::size_t depthStencilIndex = renderPass.GetDepthStencilAttachmentIndex();
+		if (depthStencilIndex != WebGPURenderPass::InvalidAttachmentIndex)
+		{
+			const auto& attachmentInfo = renderPass.GetAttachment(depthStencilIndex);
+			const auto& clearValues = command.clearValues[depthStencilIndex];
+
+			depthStencilAttachment.depthClearValue = clearValues.depth;
+			depthStencilAttachment.depthLoadOp = ToWebGPU(attachmentInfo.loadOp);
+			depthStencilAttachment.depthStoreOp = ToWebGPU(attachmentInfo.storeOp);
+			depthStencilAttachment.view = framebuffer.GetAttachment(depthStencilIndex);
+
+			// Stencil operations must not be set for formats without stencil
+			if (PixelFormatInfo::GetContent(attachmentInfo.format) == PixelFormatContent::DepthStencil)
+			{
+				depthStencilAttachment.stencilClearValue = clearValues.stencil;
+				depthStencilAttachment.stencilLoadOp = ToWebGPU(attachmentInfo.stencilLoadOp);
+				depthStencilAttachment.stencilStoreOp = ToWebGPU(attachmentInfo.stencilStoreOp);
+			}
+
+			renderPassDesc.depthStencilAttachment = &depthStencilAttachment;
+		}
+
+		state.renderPass = &renderPass;
+		state.renderPassEncoder = wgpuCommandEncoderBeginRenderPass(state.encoder, &renderPassDesc);
+
+		const Recti& renderRect = command.renderRect;
+		wgpuRenderPassEncoderSetViewport(state.renderPassEncoder, float(renderRect.x), float(renderRect.y), float(renderRect.width), float(renderRect.height), 0.f, 1.f);
+		wgpuRenderPassEncoderSetScissorRect(state.renderPassEncoder, UInt32(renderRect.x), UInt32(renderRect.y), UInt32(renderRect.width), UInt32(renderRect.height));
+	}
+
+	void WebGPUCommandBuffer::Execute(EncodingState& state, const BindComputePipelineCommand& command) const
+	{
+		// Compute states are applied when dispatching, as compute passes can't overlap other commands
+		state.computePipeline = command.pipeline;
+	}
+
+	void WebGPUCommandBuffer::Execute(EncodingState& state, const BindComputeShaderBindingCommand& command) const
+	{
+		if (command.set >= state.computeBindings.size())
+			state.computeBindings.resize(command.set + 1);
+
+		state.computeBindings[command.set] = command.binding;
+	}
+
+	void WebGPUCommandBuffer::Execute(EncodingState& state, const BindIndexBufferCommand& command) const
+	{
+		NazaraAssert(state.renderPassEncoder, "no render pass active");
+		wgpuRenderPassEncoderSetIndexBuffer(state.renderPassEncoder, command.buffer, command.format, command.offset, command.size);
+	}
+
+	void WebGPUCommandBuffer::Execute(EncodingState& state, const BindRenderPipelineCommand& command) const
+	{
+		NazaraAssert(state.renderPassEncoder, "no render pass active");
+
+		WGPURenderPipeline pipeline = command.pipeline->Get(*state.renderPass);
+		if (!pipeline)
+			return;
+
+		wgpuRenderPassEncoderSetPipeline(state.renderPassEncoder, pipeline);
+
+		// Stencil reference is a dynamic state in WebGPU
+		const RenderPipelineInfo& pipelineInfo = command.pipeline->GetPipelineInfo();
+		if (pipelineInfo.stencilTest)
+			wgpuRenderPassEncoderSetStencilReference(state.renderPassEncoder, pipelineInfo.stencilFront.reference);
+	}
+
+	void WebGPUCommandBuffer::Execute(EncodingState& state, const BindRenderShaderBindingCommand& command) const
+	{
+		NazaraAssert(state.renderPassEncoder, "no render pass active");
+		wgpuRenderPassEncoderSetBindGroup(state.renderPassEncoder, command.set, command.binding->GetHandle(), 0, nullptr);
+	}
+
+	void WebGPUCommandBuffer::Execute(EncodingState& state, const BindVertexBufferCommand& command) const
+	{
+		NazaraAssert(state.renderPassEncoder, "no render pass active");
+		wgpuRenderPassEncoderSetVertexBuffer(state.renderPassEncoder, command.binding, command.buffer, command.offset, command.size);
+	}
+
+	void WebGPUCommandBuffer::Execute(EncodingState& state, const CopyBufferCommand& command) const
+	{
+		NazaraAssert(!state.renderPassEncoder, "copies are not allowed during a render pass");
+		state.EndComputePass();
+
+		wgpuCommandEncoderCopyBufferToBuffer(state.encoder, command.source, command.sourceOffset, command.target, command.targetOffset, command.size);
+	}
+
+	void WebGPUCommandBuffer::Execute(EncodingState& state, const CopyBufferFromMemoryCommand& command) const
+	{
+		// Queue writes happen before the submission of the command buffer being encoded, like upload pool copies happening at the start of the frame
+		wgpuQueueWriteBuffer(state.device.GetQueue(), command.target, command.targetOffset, command.memory, command.size);
+	}
+
+	void WebGPUCommandBuffer::Execute(EncodingState& state, const CopyTextureCommand& command) const
+	{
+		NazaraAssert(!state.renderPassEncoder, "copies are not allowed during a render pass");
+		state.EndComputePass();
+
+		command.target->EncodeCopy(state.encoder, *command.source, command.sourceBox, command.targetPoint);
+	}
+
+	void WebGPUCommandBuffer::Execute(EncodingState& state, const DispatchCommand& command) const
+	{
+		NazaraAssert(!state.renderPassEncoder, "dispatches are not allowed during a render pass");
+		NazaraAssert(state.computePipeline, "no compute pipeline bound");
+
+		if (!state.computePass)
+			state.computePass = wgpuCommandEncoderBeginComputePass(state.encoder, nullptr);
+
+		wgpuComputePassEncoderSetPipeline(state.computePass, state.computePipeline->GetHandle());
+		for (std::size_t setIndex = 0; setIndex < state.computeBindings.size(); ++setIndex)
+		{
+			if (const WebGPUShaderBinding* binding = state.computeBindings[setIndex])
+				wgpuComputePassEncoderSetBindGroup(state.computePass, UInt32(setIndex), binding->GetHandle(), 0, nullptr);
+		}
+
+		wgpuComputePassEncoderDispatchWorkgroups(state.computePass, command.workgroupX, command.workgroupY, command.workgroupZ);
+	}
+
+	void WebGPUCommandBuffer::Execute(EncodingState& state, const DrawCommand& command) const
+	{
+		NazaraAssert(state.renderPassEncoder, "no render pass active");
+		wgpuRenderPassEncoderDraw(state.renderPassEncoder, command.vertexCount, command.instanceCount, command.firstVertex, command.firstInstance);
+	}
+
+	void WebGPUCommandBuffer::Execute(EncodingState& state, const DrawIndexedCommand& command) const
+	{
+		NazaraAssert(state.renderPassEncoder, "no render pass active");
+		wgpuRenderPassEncoderDrawIndexed(state.renderPassEncoder, command.indexCount, command.instanceCount, command.firstIndex, 0, command.firstInstance);
+	}
+
+	void WebGPUCommandBuffer::Execute(EncodingState& state, const DrawIndexedIndirectCommand& command) const
+	{
+		NazaraAssert(state.renderPassEncoder, "no render pass active");
+
+		// WebGPU has no multi-draw indirect
+		for (UInt32 i = 0; i < command.drawCount; ++i)
+			wgpuRenderPassEncoderDrawIndexedIndirect(state.renderPassEncoder, command.indirectBuffer, command.indirectOffset + UInt64(i) * command.stride);
+	}
+
+	void WebGPUCommandBuffer::Execute(EncodingState& state, const EndDebugRegionCommand& /*command*/) const
+	{
+		if (state.renderPassEncoder)
+			wgpuRenderPassEncoderPopDebugGroup(state.renderPassEncoder);
+		else
+		{
+			state.EndComputePass();
+			wgpuCommandEncoderPopDebugGroup(state.encoder);
+		}
+	}
+
+	void WebGPUCommandBuffer::Execute(EncodingState& state, const EndRenderPassCommand& /*command*/) const
+	{
+		NazaraAssert(state.renderPassEncoder, "no render pass active");
+
+		wgpuRenderPassEncoderEnd(state.renderPassEncoder);
+		wgpuRenderPassEncoderRelease(state.renderPassEncoder);
+
+		state.renderPass = nullptr;
+		state.renderPassEncoder = nullptr;
+	}
+
+	void WebGPUCommandBuffer::Execute(EncodingState& state, const InsertDebugLabelCommand& command) const
+	{
+		if (state.renderPassEncoder)
+			wgpuRenderPassEncoderInsertDebugMarker(state.renderPassEncoder, command.label.c_str());
+		else if (state.computePass)
+			wgpuComputePassEncoderInsertDebugMarker(state.computePass, command.label.c_str());
+		else
+			wgpuCommandEncoderInsertDebugMarker(state.encoder, command.label.c_str());
+	}
+
+	void WebGPUCommandBuffer::Execute(EncodingState& state, const SetScissorCommand& command) const
+	{
+		NazaraAssert(state.renderPassEncoder, "no render pass active");
+
+		const Recti& scissorRegion = command.scissorRegion;
+		wgpuRenderPassEncoderSetScissorRect(state.renderPassEncoder, UInt32(scissorRegion.x), UInt32(scissorRegion.y), UInt32(scissorRegion.width), UInt32(scissorRegion.height));
+	}
+
+	void WebGPUCommandBuffer::Execute(EncodingState& state, const SetViewportCommand& command) const
+	{
+		NazaraAssert(state.renderPassEncoder, "no render pass active");
+
+		const Recti& viewportRegion = command.viewportRegion;
+		wgpuRenderPassEncoderSetViewport(state.renderPassEncoder, float(viewportRegion.x), float(viewportRegion.y), float(viewportRegion.width), float(viewportRegion.height), 0.f, 1.f);
+	}
+}
@@ -0,0 +1,238 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/WebGPURenderer/WebGPUCommandBufferBuilder.hpp>
+#include <Nazara/WebGPURenderer/Utils.hpp>
+#include <Nazara/WebGPURenderer/WebGPUBuffer.hpp>
+#include <Nazara/WebGPURenderer/WebGPUCommandBuffer.hpp>
+#include <Nazara/WebGPURenderer/WebGPUComputePipeline.hpp>
+#include <Nazara/WebGPURenderer/WebGPUFramebuffer.hpp>
+#include <Nazara/WebGPURenderer/WebGPURenderPass.hpp>
+#include <Nazara/WebGPURenderer/WebGPURenderPipeline.hpp>
+#include <Nazara/WebGPURenderer/WebGPUShaderBinding.hpp>
+#include <Nazara/WebGPURenderer/WebGPUTexture.hpp>
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	void WebGPUCommandBufferBuilder::BeginDebugRegion(std::string_view regionName, const Color& /*color*/)
+	{
+		m_commandBuffer.BeginDebugRegion(regionName);
+	}
+
+	void WebGPUCommandBufferBuilder::BeginRenderPass(const Framebuffer& framebuffer, const RenderPass& renderPass, const Recti& renderRect, const ClearValues* clearValues, std::size_t clearValueCount)
+	{
+		m_statistics.renderPassCount++;
+
+		m_commandBuffer.BeginRenderPass(static_cast<const WebGPUFramebuffer&>(framebuffer), static_cast<const WebGPURenderPass&>(renderPass), renderRect, clearValues, clearValueCount);
+	}
+
+	void WebGPUCommandBufferBuilder::BindComputePipeline(const ComputePipeline& pipeline)
+	{
+		m_statistics.pipelineBindCount++;
+
+		const WebGPUComputePipeline& wgpuPipeline = static_cast<const WebGPUComputePipeline&>(pipeline);
+
+		m_commandBuffer.BindComputePipeline(&wgpuPipeline);
+	}
+
+	void WebGPUCommandBufferBuilder::BindComputeShaderBinding(UInt32 set, const ShaderBinding& binding)
+	{
+		m_statistics.shaderBindingBindCount++;
+
+		const WebGPUShaderBinding& wgpuBinding = static_cast<const WebGPUShaderBinding&>(binding);
+
+		m_commandBuffer.BindComputeShaderBinding(set, &wgpuBinding);
+	}
+
+	void WebGPUCommandBufferBuilder::BindComputeShaderBinding(const RenderPipelineLayout& /*pipelineLayout*/, UInt32 set, const ShaderBinding& binding)
+	{
+		// Bind groups are compatible with any pipeline layout sharing the same bind group layout
+		return BindComputeShaderBinding(set, binding);
+	}
+
+	void WebGPUCommandBufferBuilder::BindIndexBuffer(const RenderBuffer& indexBuffer, IndexType indexType, UInt64 offset)
+	{
+		const WebGPUBuffer& wgpuBuffer = static_cast<const WebGPUBuffer&>(indexBuffer);
+
+		m_commandBuffer.BindIndexBuffer(wgpuBuffer.GetHandle(), ToWebGPU(indexType), offset, WGPU_WHOLE_SIZE);
+	}
+
+	void WebGPUCommandBufferBuilder::BindRenderPipeline(const RenderPipeline& pipeline)
+	{
+		m_statistics.pipelineBindCount++;
+
+		const WebGPURenderPipeline& wgpuPipeline = static_cast<const WebGPURenderPipeline&>(pipeline);
+
+		m_commandBuffer.BindRenderPipeline(&wgpuPipeline);
+	}
+
+	void WebGPUCommandBufferBuilder::BindRenderShaderBinding(UInt32 set, const ShaderBinding& binding)
+	{
+		m_statistics.shaderBindingBindCount++;
+
+		const WebGPUShaderBinding& wgpuBinding = static_cast<const WebGPUShaderBinding&>(binding);
+
+		m_commandBuffer.BindRenderShaderBinding(set, &wgpuBinding);
+	}
+
+	void WebGPUCommandBufferBuilder::BindRenderShaderBinding(const RenderPipelineLayout& /*pipelineLayout*/, UInt32 set, const ShaderBinding& binding)
+	{
+		return BindRenderShaderBinding(set, binding);
+	}
+
+	void WebGPUCommandBufferBuilder::BindVertexBuffer(UInt32 binding, const RenderBuffer& vertexBuffer, UInt64 offset)
+	{
+		const WebGPUBuffer& wgpuBuffer = static_cast<const WebGPUBuffer&>(vertexBuffer);
+
+		m_commandBuffer.BindVertexBuffer(binding, wgpuBuffer.GetHandle(), offset, WGPU_WHOLE_SIZE);
+	}
+
+	void WebGPUCommandBufferBuilder::BlitTexture(const Texture& fromTexture, const Boxui& fromBox, TextureLayout fromLayout, const Texture& toTexture, const Boxui& toBox, TextureLayout toLayout, SamplerFilter /*filter*/)
+	{
+		// WebGPU has no blit command, only same-size blits can be handled (as copies)
+		if (fromBox.width != toBox.width || fromBox.height != toBox.height || fromBox.depth != toBox.depth)
+		{
+			NazaraError("scaled texture blits are not supported by the WebGPU renderer");
+			return;
+		}
+
+		CopyTexture(fromTexture, fromBox, fromLayout, toTexture, Vector3ui(toBox.x, toBox.y, toBox.z), toLayout);
+	}
+
+	void WebGPUCommandBufferBuilder::BuildMipmaps(Texture& /*texture*/, UInt8 /*baseLevel*/, UInt8 /*levelCount*/, PipelineStageFlags /*srcStageMask*/, PipelineStageFlags /*dstStageMask*/, MemoryAccessFlags /*srcAccessMask*/, MemoryAccessFlags /*dstAccessMask*/, TextureLayout /*oldLayout*/, TextureLayout /*newLayout*/)
+	{
+		// TODO: Generate mipmaps using a render pipeline
+		NazaraError("mipmap generation is not yet supported by the WebGPU renderer");
+	}
+
+	void WebGPUCommandBufferBuilder::CopyBuffer(const RenderBufferView& source, const RenderBufferView& target, UInt64 size, UInt64 sourceOffset, UInt64 targetOffset)
+	{
+		m_statistics.transferredBytes += size;
+
+		WebGPUBuffer& sourceBuffer = *static_cast<WebGPUBuffer*>(source.GetBuffer());
+		WebGPUBuffer& targetBuffer = *static_cast<WebGPUBuffer*>(target.GetBuffer());
+
+		m_commandBuffer.CopyBuffer(sourceBuffer.GetHandle(), targetBuffer.GetHandle(), size, sourceOffset + source.GetOffset(), targetOffset + target.GetOffset());
+	}
+
+	void WebGPUCommandBufferBuilder::CopyBuffer(const UploadPool::Allocation& allocation, const RenderBufferView& target, UInt64 size, UInt64 sourceOffset, UInt64 targetOffset)
+	{
+		m_statistics.transferredBytes += size;
+
+		WebGPUBuffer& targetBuffer = *static_cast<WebGPUBuffer*>(target.GetBuffer());
+
+		m_commandBuffer.CopyBuffer(static_cast<const UInt8*>(allocation.mappedPtr) + sourceOffset, targetBuffer.GetHandle(), size, target.GetOffset() + targetOffset);
+	}
+
+	void WebGPUCommandBufferBuilder::CopyTexture(const Texture& fromTexture, const Boxui& fromBox, TextureLayout /*fromLayout*/, const Texture& toTexture, const Vector3ui& toPos, TextureLayout /*toLayout*/)
+	{
+		const WebGPUTexture& sourceTexture = static_cast<const WebGPUTexture&>(fromTexture);
+		const WebGPUTexture& targetTexture = static_cast<const WebGPUTexture&>(toTexture);
+
+		m_commandBuffer.CopyTexture(sourceTexture, fromBox, targetTexture, toPos);
+	}
+
+	void WebGPUCommandBufferBuilder::Dispatch(UInt32 workgroupX, UInt32 workgroupY, UInt32 workgroupZ)
+	{
+		m_statistics.computeDispatchCount++;
+
+		m_commandBuffer.Dispatch(workgroupX, workgroupY, workgroupZ);
+	}
+
+	void WebGPUCommandBufferBuilder::Draw(UInt32 vertexCount, UInt32 instanceCount, UInt32 firstVertex, UInt32 firstInstance)
+	{
+		m_statistics.drawCallCount++;
+		m_statistics.drawnVertexCount += UInt64(vertexCount) * instanceCount;
+
+		m_commandBuffer.Draw(vertexCount, instanceCount, firstVertex, firstInstance);
+	}
+
+	void WebGPUCommandBufferBuilder::DrawIndexed(UInt32 indexCount, UInt32 instanceCount, UInt32 firstIndex, UInt32 firstInstance)
+	{
+		m_statistics.drawCallCount++;
+		m_statistics.drawnVertexCount += UInt64(indexCount) * instanceCount;
+
+		m_commandBuffer.DrawIndexed(indexCount, instanceCount, firstIndex, firstInstance);
+	}
+
+	void WebGPUCommandBufferBuilder::DrawIndexedIndirect(const RenderBufferView& indirectBuffer, UInt32 drawCount, UInt32 stride)
+	{
+		m_statistics.drawCallCount += drawCount;
+
+		WebGPUBuffer& wgpuBuffer = *static_cast<WebGPUBuffer*>(indirectBuffer.GetBuffer());
+
+		m_commandBuffer.DrawIndexedIndirect(wgpuBuffer.GetHandle(), indirectBuffer.GetOffset(), drawCount, stride);
+	}
+
+	void WebGPUCommandBufferBuilder::DrawIndexedIndirectCount(const RenderBufferView& /*indirectBuffer*/, const RenderBufferView& /*countBuffer*/, UInt32 /*maxDrawCount*/, UInt32 /*stride*/)
+	{
+		NazaraError("indirect draw count is not supported by the WebGPU renderer");
+	}
+
+	void WebGPUCommandBufferBuilder::EndDebugRegion()
+	{
+		m_commandBuffer.EndDebugRegion();
+	}
+
+	void WebGPUCommandBufferBuilder::EndRenderPass()
+	{
+		m_commandBuffer.EndRenderPass();
+	}
+
+	void WebGPUCommandBufferBuilder::InsertDebugLabel(std::string_view label, const Color& /*color*/)
+	{
+		m_commandBuffer.InsertDebugLabel(label);
+	}
+
+	void WebGPUCommandBufferBuilder::MemoryBarrier(PipelineStageFlags /*srcStageMask*/, PipelineStageFlags /*dstStageMask*/, MemoryAccessFlags /*srcAccessMask*/, MemoryAccessFlags /*dstAccessMask*/)
+	{
+		/* nothing to do, WebGPU tracks resource usage */
+	}
+
+	void WebGPUCommandBufferBuilder::NextSubpass()
+	{
+		NazaraError("subpasses are not supported by the WebGPU renderer");
+	}
+
+	void WebGPUCommandBufferBuilder::PreTransferBarrier()
+	{
+		/* nothing to do */
+	}
+
+	void WebGPUCommandBufferBuilder::PostTransferBarrier()
+	{
+		/* nothing to do */
+	}
+
+	void WebGPUCommandBufferBuilder::PushConstants(const RenderPipelineLayout& /*pipelineLayout*/, UInt32 /*offset*/, UInt32 /*size*/, const void* /*data*/)
+	{
+		NazaraError("push constants are not supported by the WebGPU renderer");
+	}
+
+	void WebGPUCommandBufferBuilder::SetScissor(const Recti& scissorRegion)
+	{
+		m_commandBuffer.SetScissor(scissorRegion);
+	}
+
+	void WebGPUCommandBufferBuilder::SetViewport(const Recti& viewportRegion)
+	{
+		m_commandBuffer.SetViewport(viewportRegion);
+	}
+
+	void WebGPUCommandBufferBuilder::TextureAcquireBarrier(PipelineStageFlags /*srcStageMask*/, PipelineStageFlags /*dstStageMask*/, MemoryAccessFlags /*srcAccessMask*/, MemoryAccessFlags /*dstAccessMask*/, TextureLayout /*oldLayout*/, TextureLayout /*newLayout*/, QueueType /*srcQueue*/, QueueType /*dstQueue*/, const Texture& /*texture*/)
+	{
+		/* nothing to do */
+	}
+
+	void WebGPUCommandBufferBuilder::TextureBarrier(PipelineStageFlags /*srcStageMask*/, PipelineStageFlags /*dstStageMask*/, MemoryAccessFlags /*srcAccessMask*/, MemoryAccessFlags /*dstAccessMask*/, TextureLayout /*oldLayout*/, TextureLayout /*newLayout*/, const Texture& /*texture*/)
+	{
+		/* nothing to do */
+	}
+
+	void WebGPUCommandBufferBuilder::TextureReleaseBarrier(PipelineStageFlags /*srcStageMask*/, PipelineStageFlags /*dstStageMask*/, MemoryAccessFlags /*srcAccessMask*/, MemoryAccessFlags /*dstAccessMask*/, TextureLayout /*oldLayout*/, TextureLayout /*newLayout*/, QueueType /*srcQueue*/, QueueType /*dstQueue*/, const Texture& /*texture*/)
+	{
+		/* nothing to do */
+	}
+}
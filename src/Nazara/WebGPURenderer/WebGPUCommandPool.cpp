@@ -0,0 +1,29 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/WebGPURenderer/WebGPUCommandPool.hpp>
+#include <Nazara/WebGPURenderer/WebGPUCommandBuffer.hpp>
+#include <Nazara/WebGPURenderer/WebGPUCommandBufferBuilder.hpp>
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	CommandBufferPtr WebGPUCommandPool::BuildCommandBuffer(const std::function<void(CommandBufferBuilder& builder)>& callback)
+	{
+		WebGPUCommandBuffer* commandBuffer = new WebGPUCommandBuffer;
+		CommandBufferPtr commandBufferPtr(commandBuffer);
+
+		WebGPUCommandBufferBuilder builder(*commandBuffer);
+		callback(builder);
+
+		commandBuffer->UpdateStatistics(builder.GetStatistics());
+
+		return commandBufferPtr;
+	}
+
+	void WebGPUCommandPool::UpdateDebugName(std::string_view /*name*/)
+	{
+		// No object to name
+	}
+}
@@ -0,0 +1,49 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/WebGPURenderer/WebGPUComputePipeline.hpp>
+#include <Nazara/WebGPURenderer/WebGPUDevice.hpp>
+#include <Nazara/WebGPURenderer/WebGPURenderPipelineLayout.hpp>
+#include <Nazara/WebGPURenderer/WebGPUShaderModule.hpp>
+#include <stdexcept>
+#include <string>
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	WebGPUComputePipeline::WebGPUComputePipeline(WebGPUDevice& device, ComputePipelineInfo pipelineInfo) :
+	m_pipelineInfo(std::move(pipelineInfo))
+	{
+		if (!device.GetEnabledFeatures().computeShaders)
+			throw std::runtime_error("compute shaders are not enabled on the device");
+
+		const WebGPUShaderModule& shaderModule = static_cast<const WebGPUShaderModule&>(*m_pipelineInfo.shaderModule);
+		if (!shaderModule.GetShaderStages().Test(nzsl::ShaderStageType::Compute))
+			throw std::runtime_error("shader module has no compute stage");
+
+		WGPUComputePipelineDescriptor pipelineDesc = {};
+		pipelineDesc.compute.entryPoint = WebGPUShaderModule::GetEntryPointName(nzsl::ShaderStageType::Compute);
+		pipelineDesc.compute.module = shaderModule.GetHandle();
+		pipelineDesc.layout = static_cast<const WebGPURenderPipelineLayout&>(*m_pipelineInfo.pipelineLayout).GetHandle();
+
+		m_pipeline = wgpuDeviceCreateComputePipeline(device.GetHandle(), &pipelineDesc);
+		if (!m_pipeline)
+			throw std::runtime_error("failed to create WebGPU compute pipeline");
+	}
+
+	WebGPUComputePipeline::~WebGPUComputePipeline()
+	{
+		wgpuComputePipelineRelease(m_pipeline);
+	}
+
+	const ComputePipelineInfo& WebGPUComputePipeline::GetPipelineInfo() const
+	{
+		return m_pipelineInfo;
+	}
+
+	void WebGPUComputePipeline::UpdateDebugName(std::string_view name)
+	{
+		wgpuComputePipelineSetLabel(m_pipeline, std::string(name).c_str());
+	}
+}
@@ -0,0 +1,264 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/WebGPURenderer/WebGPUDevice.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Utility/Image.hpp>
+#include <Nazara/Utility/PixelFormat.hpp>
+#include <Nazara/WebGPURenderer/Utils.hpp>
+#include <Nazara/WebGPURenderer/WebGPUBuffer.hpp>
+#include <Nazara/WebGPURenderer/WebGPUCommandPool.hpp>
+#include <Nazara/WebGPURenderer/WebGPUComputePipeline.hpp>
+#include <Nazara/WebGPURenderer/WebGPUFramebuffer.hpp>
+#include <Nazara/WebGPURenderer/WebGPURenderPass.hpp>
+#include <Nazara/WebGPURenderer/WebGPURenderPipeline.hpp>
+#include <Nazara/WebGPURenderer/WebGPURenderPipelineLayout.hpp>
+#include <Nazara/WebGPURenderer/WebGPUShaderModule.hpp>
+#include <Nazara/WebGPURenderer/WebGPUSwapchain.hpp>
+#include <Nazara/WebGPURenderer/WebGPUTexture.hpp>
+#include <Nazara/WebGPURenderer/WebGPUTextureSampler.hpp>
+#include <stdexcept>
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	WebGPUDevice::WebGPUDevice(WGPUDevice device, const RenderDeviceInfo& deviceInfo, const RenderDeviceFeatures& enabledFeatures) :
+	m_enabledFeatures(enabledFeatures),
+	m_deviceInfo(deviceInfo),
+	m_device(device)
+	{
+		wgpuDeviceReference(m_device);
+		m_queue = wgpuDeviceGetQueue(m_device);
+	}
+
+	WebGPUDevice::~WebGPUDevice()
+	{
+		wgpuQueueRelease(m_queue);
+		wgpuDeviceRelease(m_device);
+	}
+
+	const RenderDeviceInfo& WebGPUDevice::GetDeviceInfo() const
+	{
+		return m_deviceInfo;
+	}
+
+	const RenderDeviceFeatures& WebGPUDevice::GetEnabledFeatures() const
+	{
+		return m_enabledFeatures;
+	}
+
+	std::shared_ptr<RenderBuffer> WebGPUDevice::InstantiateBuffer(BufferType type, UInt64 size, BufferUsageFlags usageFlags, const void* initialData)
+	{
+		return std::make_shared<WebGPUBuffer>(*this, type, size, usageFlags, initialData);
+	}
+
+	std::shared_ptr<CommandPool> WebGPUDevice::InstantiateCommandPool(QueueType /*queueType*/)
+	{
+		return std::make_shared<WebGPUCommandPool>();
+	}
+
+	std::shared_ptr<ComputePipeline> WebGPUDevice::InstantiateComputePipeline(ComputePipelineInfo pipelineInfo)
+	{
+		return std::make_shared<WebGPUComputePipeline>(*this, std::move(pipelineInfo));
+	}
+
+	std::shared_ptr<Framebuffer> WebGPUDevice::InstantiateFramebuffer(unsigned int /*width*/, unsigned int /*height*/, const std::shared_ptr<RenderPass>& /*renderPass*/, const std::vector<std::shared_ptr<Texture>>& attachments)
+	{
+		std::vector<WGPUTextureView> attachmentViews;
+		attachmentViews.reserve(attachments.size());
+		for (const auto& attachment : attachments)
+			attachmentViews.push_back(static_cast<WebGPUTexture*>(attachment.get())->GetViewHandle());
+
+		return std::make_shared<WebGPUFramebuffer>(FramebufferType::Texture, std::move(attachmentViews));
+	}
+
+	std::shared_ptr<RenderPass> WebGPUDevice::InstantiateRenderPass(std::vector<RenderPass::Attachment> attachments, std::vector<RenderPass::SubpassDescription> subpassDescriptions, std::vector<RenderPass::SubpassDependency> subpassDependencies)
+	{
+		return std::make_shared<WebGPURenderPass>(std::move(attachments), std::move(subpassDescriptions), std::move(subpassDependencies));
+	}
+
+	std::shared_ptr<RenderPipeline> WebGPUDevice::InstantiateRenderPipeline(RenderPipelineInfo pipelineInfo)
+	{
+		return std::make_shared<WebGPURenderPipeline>(*this, std::move(pipelineInfo));
+	}
+
+	std::shared_ptr<RenderPipelineLayout> WebGPUDevice::InstantiateRenderPipelineLayout(RenderPipelineLayoutInfo pipelineLayoutInfo)
+	{
+		return std::make_shared<WebGPURenderPipelineLayout>(*this, std::move(pipelineLayoutInfo));
+	}
+
+	std::shared_ptr<ShaderModule> WebGPUDevice::InstantiateShaderModule(nzsl::ShaderStageTypeFlags /*shaderStages*/, const nzsl::Ast::Module& /*shaderModule*/, const nzsl::ShaderWriter::States& /*states*/)
+	{
+		// TODO: Generate WGSL from NZSL once a WGSL writer is available
+		throw std::runtime_error("WebGPU renderer only supports WGSL shader sources");
+	}
+
+	std::shared_ptr<ShaderModule> WebGPUDevice::InstantiateShaderModule(nzsl::ShaderStageTypeFlags shaderStages, ShaderLanguage lang, const void* source, std::size_t sourceSize, const nzsl::ShaderWriter::States& /*states*/)
+	{
+		return std::make_shared<WebGPUShaderModule>(*this, shaderStages, lang, source, sourceSize);
+	}
+
+	std::shared_ptr<Swapchain> WebGPUDevice::InstantiateSwapchain(WindowHandle windowHandle, const Vector2ui& windowSize, const SwapchainParameters& parameters)
+	{
+		return std::make_shared<WebGPUSwapchain>(*this, windowHandle, windowSize, parameters);
+	}
+
+	std::shared_ptr<Texture> WebGPUDevice::InstantiateTexture(const TextureInfo& params)
+	{
+		return std::make_shared<WebGPUTexture>(*this, params);
+	}
+
+	std::shared_ptr<Texture> WebGPUDevice::InstantiateTexture(const TextureInfo& params, const void* initialData, bool buildMipmaps, unsigned int srcWidth, unsigned int srcHeight)
+	{
+		if (!initialData || !buildMipmaps)
+		{
+			std::shared_ptr<WebGPUTexture> texture = std::make_shared<WebGPUTexture>(*this, params);
+			if (initialData)
+				texture->Update(initialData, srcWidth, srcHeight);
+
+			return texture;
+		}
+
+		// WebGPU has no blit to generate mipmaps with, build them on the CPU instead (array images can't be filtered this way)
+		TextureInfo textureInfo = params;
+
+		Image image;
+		bool hasMipmaps = false;
+		if (params.type != ImageType::E1D && params.type != ImageType::E1D_Array && params.type != ImageType::E2D_Array)
+		{
+			ErrorFlags errFlags(ErrorMode::Silent);
+
+			unsigned int depth = (params.type == ImageType::E3D) ? params.depth : 1;
+			hasMipmaps = image.Create(params.type, params.pixelFormat, params.width, params.height, depth) &&
+			             image.Update(initialData, srcWidth, srcHeight) &&
+			             image.GenerateMipmaps();
+		}
+
+		if (hasMipmaps)
+			textureInfo.levelCount = std::min(textureInfo.levelCount, image.GetLevelCount());
+		else
+		{
+			NazaraWarning("failed to generate mipmaps for {0} texture, only the base level is kept", PixelFormatInfo::GetName(params.pixelFormat));
+			textureInfo.levelCount = 1;
+		}
+
+		std::shared_ptr<WebGPUTexture> texture = std::make_shared<WebGPUTexture>(*this, textureInfo);
+		if (!hasMipmaps)
+		{
+			texture->Update(initialData, srcWidth, srcHeight);
+			return texture;
+		}
+
+		for (UInt8 level = 0; level < texture->GetLevelCount(); ++level)
+			texture->Update(image.GetConstPixels(0, 0, 0, level), 0, 0, level);
+
+		return texture;
+	}
+
+	std::shared_ptr<TextureSampler> WebGPUDevice::InstantiateTextureSampler(const TextureSamplerInfo& params)
+	{
+		return std::make_shared<WebGPUTextureSampler>(*this, params);
+	}
+
+	bool WebGPUDevice::IsParallelCommandRecordingSupported() const
+	{
+		// Browsers run WebGPU on the main thread
+		return false;
+	}
+
+	bool WebGPUDevice::IsTextureFormatSupported(PixelFormat format, TextureUsage usage) const
+	{
+		WGPUTextureFormat textureFormat = ToWebGPU(format);
+		if (textureFormat == WGPUTextureFormat_Undefined)
+			return false;
+
+		switch (usage)
+		{
+			case TextureUsage::ColorAttachment:
+				return PixelFormatInfo::GetContent(format) == PixelFormatContent::ColorRGBA;
+
+			case TextureUsage::DepthStencilAttachment:
+				return PixelFormatInfo::GetContent(format) != PixelFormatContent::ColorRGBA;
+
+			case TextureUsage::ShaderReadWrite:
+			{
+				// Only a few formats can be used as storage textures without extensions
+				switch (textureFormat)
+				{
+					case WGPUTextureFormat_R32Float:
+					case WGPUTextureFormat_R32Sint:
+					case WGPUTextureFormat_R32Uint:
+					case WGPUTextureFormat_RG32Float:
+					case WGPUTextureFormat_RG32Sint:
+					case WGPUTextureFormat_RG32Uint:
+					case WGPUTextureFormat_RGBA16Float:
+					case WGPUTextureFormat_RGBA16Sint:
+					case WGPUTextureFormat_RGBA16Uint:
+					case WGPUTextureFormat_RGBA32Float:
+					case WGPUTextureFormat_RGBA32Sint:
+					case WGPUTextureFormat_RGBA32Uint:
+					case WGPUTextureFormat_RGBA8Sint:
+					case WGPUTextureFormat_RGBA8Snorm:
+					case WGPUTextureFormat_RGBA8Uint:
+					case WGPUTextureFormat_RGBA8Unorm:
+						return true;
+
+					default:
+						return false;
+				}
+			}
+
+			case TextureUsage::InputAttachment: //< read as a regular texture
+			case TextureUsage::ShaderSampling:
+			case TextureUsage::Streamed:
+			case TextureUsage::TransientAttachment:
+			case TextureUsage::TransferSource:
+			case TextureUsage::TransferDestination:
+				return true;
+		}
+
+		return false;
+	}
+
+	void WebGPUDevice::SubmitCommandBuffer(WGPUCommandBuffer commandBuffer)
+	{
+		wgpuQueueSubmit(m_queue, 1, &commandBuffer);
+		wgpuCommandBufferRelease(commandBuffer); //< command buffers can only be submitted once
+	}
+
+	void WebGPUDevice::WaitForIdle()
+	{
+		// Objects are reference counted by the browser and only destroyed once the GPU is done with them
+	}
+
+	RenderDeviceInfo WebGPUDevice::BuildDeviceInfo(WGPUDevice device)
+	{
+		RenderDeviceInfo deviceInfo;
+		deviceInfo.name = "WebGPU Device";
+		deviceInfo.type = RenderDeviceType::Unknown; //< Browsers don't expose the adapter type
+
+		deviceInfo.features.anisotropicFiltering = true;
+		deviceInfo.features.computeShaders = true;
+		deviceInfo.features.depthClamping = wgpuDeviceHasFeature(device, WGPUFeatureName_DepthClipControl);
+		deviceInfo.features.storageBuffers = true;
+
+		WGPUSupportedLimits supportedLimits = {};
+		if (!wgpuDeviceGetLimits(device, &supportedLimits))
+			NazaraWarning("failed to query WebGPU device limits");
+
+		const WGPULimits& limits = supportedLimits.limits;
+		deviceInfo.limits.maxComputeSharedMemorySize = limits.maxComputeWorkgroupStorageSize;
+		deviceInfo.limits.maxComputeWorkGroupInvocations = limits.maxComputeInvocationsPerWorkgroup;
+		deviceInfo.limits.maxComputeWorkGroupCount = { limits.maxComputeWorkgroupsPerDimension, limits.maxComputeWorkgroupsPerDimension, limits.maxComputeWorkgroupsPerDimension };
+		deviceInfo.limits.maxComputeWorkGroupSize = { limits.maxComputeWorkgroupSizeX, limits.maxComputeWorkgroupSizeY, limits.maxComputeWorkgroupSizeZ };
+		deviceInfo.limits.maxPushConstantsSize = 0; //< WebGPU has no push constants
+		deviceInfo.limits.maxStorageBufferSize = limits.maxStorageBufferBindingSize;
+		deviceInfo.limits.maxUniformBufferSize = limits.maxUniformBufferBindingSize;
+		deviceInfo.limits.minStorageBufferOffsetAlignment = limits.minStorageBufferOffsetAlignment;
+		deviceInfo.limits.minUniformBufferOffsetAlignment = limits.minUniformBufferOffsetAlignment;
+
+		return deviceInfo;
+	}
+}
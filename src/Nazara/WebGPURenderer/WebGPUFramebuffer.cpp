@@ -0,0 +1,48 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/WebGPURenderer/WebGPUFramebuffer.hpp>
+#include <cassert>
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	WebGPUFramebuffer::WebGPUFramebuffer(FramebufferType type, std::vector<WGPUTextureView> attachments) :
+	Framebuffer(type),
+	m_attachments(std::move(attachments))
+	{
+		for (WGPUTextureView attachment : m_attachments)
+		{
+			if (attachment)
+				wgpuTextureViewReference(attachment);
+		}
+	}
+
+	WebGPUFramebuffer::~WebGPUFramebuffer()
+	{
+		for (WGPUTextureView attachment : m_attachments)
+		{
+			if (attachment)
+				wgpuTextureViewRelease(attachment);
+		}
+	}
+
+	void WebGPUFramebuffer::UpdateAttachment(std::size_t attachmentIndex, WGPUTextureView attachment)
+	{
+		assert(attachmentIndex < m_attachments.size());
+
+		if (attachment)
+			wgpuTextureViewReference(attachment);
+
+		if (m_attachments[attachmentIndex])
+			wgpuTextureViewRelease(m_attachments[attachmentIndex]);
+
+		m_attachments[attachmentIndex] = attachment;
+	}
+
+	void WebGPUFramebuffer::UpdateDebugName(std::string_view /*name*/)
+	{
+		// Framebuffers are only described when encoding commands, there's no object to name
+	}
+}
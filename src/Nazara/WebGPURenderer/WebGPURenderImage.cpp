@@ -0,0 +1,54 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/WebGPURenderer/WebGPURenderImage.hpp>
+#include <Nazara/WebGPURenderer/WebGPUCommandBuffer.hpp>
+#include <Nazara/WebGPURenderer/WebGPUCommandBufferBuilder.hpp>
+#include <Nazara/WebGPURenderer/WebGPUDevice.hpp>
+#include <Nazara/WebGPURenderer/WebGPUSwapchain.hpp>
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	WebGPURenderImage::WebGPURenderImage(WebGPUSwapchain& owner) :
+	m_owner(owner),
+	m_uploadPool(2 * 1024 * 1024)
+	{
+	}
+
+	void WebGPURenderImage::Execute(const FunctionRef<void(CommandBufferBuilder& builder)>& callback, QueueTypeFlags /*queueTypeFlags*/)
+	{
+		WebGPUCommandBuffer commandBuffer;
+		WebGPUCommandBufferBuilder builder(commandBuffer);
+		callback(builder);
+
+		WebGPUDevice& device = m_owner.GetDevice();
+		device.SubmitCommandBuffer(commandBuffer.Encode(device));
+	}
+
+	WebGPUUploadPool& WebGPURenderImage::GetUploadPool()
+	{
+		return m_uploadPool;
+	}
+
+	void WebGPURenderImage::Present()
+	{
+		m_owner.Present();
+		m_uploadPool.Reset();
+		FlushReleaseQueue();
+	}
+
+	void WebGPURenderImage::SubmitCommandBuffer(CommandBuffer* commandBuffer, QueueTypeFlags /*queueTypeFlags*/)
+	{
+		WebGPUCommandBuffer& wgpuCommandBuffer = *static_cast<WebGPUCommandBuffer*>(commandBuffer);
+
+		WebGPUDevice& device = m_owner.GetDevice();
+		device.SubmitCommandBuffer(wgpuCommandBuffer.Encode(device));
+	}
+
+	void WebGPURenderImage::SynchronizeQueues(QueueType /*waitingQueue*/, QueueType /*signalingQueue*/)
+	{
+		/* nothing to do, WebGPU has a single queue */
+	}
+}
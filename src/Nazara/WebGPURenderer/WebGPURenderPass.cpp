@@ -0,0 +1,42 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/WebGPURenderer/WebGPURenderPass.hpp>
+#include <Nazara/WebGPURenderer/Utils.hpp>
+#include <stdexcept>
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	WebGPURenderPass::WebGPURenderPass(std::vector<Attachment> attachments, std::vector<SubpassDescription> subpassDescriptions, std::vector<SubpassDependency> subpassDependencies) :
+	RenderPass(std::move(attachments), std::move(subpassDescriptions), std::move(subpassDependencies)),
+	m_depthStencilAttachmentIndex(InvalidAttachmentIndex),
+	m_depthStencilFormat(WGPUTextureFormat_Undefined)
+	{
+		// WebGPU render passes have no subpasses
+		if (m_subpassDescriptions.size() != 1)
+			throw std::runtime_error("WebGPU renderer only supports render passes with a single subpass");
+
+		const SubpassDescription& subpass = m_subpassDescriptions.front();
+		if (!subpass.inputAttachments.empty())
+			throw std::runtime_error("WebGPU renderer doesn't support input attachments");
+
+		for (const AttachmentReference& colorAttachment : subpass.colorAttachment)
+		{
+			m_colorAttachmentIndices.push_back(colorAttachment.attachmentIndex);
+			m_colorFormats.push_back(ToWebGPU(m_attachments[colorAttachment.attachmentIndex].format));
+		}
+
+		if (subpass.depthStencilAttachment)
+		{
+			m_depthStencilAttachmentIndex = subpass.depthStencilAttachment->attachmentIndex;
+			m_depthStencilFormat = ToWebGPU(m_attachments[m_depthStencilAttachmentIndex].format);
+		}
+	}
+
+	void WebGPURenderPass::UpdateDebugName(std::string_view /*name*/)
+	{
+		// Render passes are only described when encoding commands, there's no object to name
+	}
+}
@@ -0,0 +1,236 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/WebGPURenderer/WebGPURenderPipeline.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Utility/VertexDeclaration.hpp>
+#include <Nazara/WebGPURenderer/Utils.hpp>
+#include <Nazara/WebGPURenderer/WebGPUDevice.hpp>
+#include <Nazara/WebGPURenderer/WebGPURenderPass.hpp>
+#include <Nazara/WebGPURenderer/WebGPURenderPipelineLayout.hpp>
+#include <Nazara/WebGPURenderer/WebGPUShaderModule.hpp>
+#include <algorithm>
+#include <cmath>
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	WebGPURenderPipeline::WebGPURenderPipeline(WebGPUDevice& device, RenderPipelineInfo pipelineInfo) :
+	m_pipelineInfo(std::move(pipelineInfo)),
+	m_device(device)
+	{
+		ValidatePipelineInfo(device, m_pipelineInfo);
+	}
+
+	WebGPURenderPipeline::~WebGPURenderPipeline()
+	{
+		for (const PipelineData& pipelineData : m_pipelines)
+			wgpuRenderPipelineRelease(pipelineData.pipeline);
+	}
+
+	WGPURenderPipeline WebGPURenderPipeline::Get(const WebGPURenderPass& renderPass) const
+	{
+		const std::vector<WGPUTextureFormat>& colorFormats = renderPass.GetColorFormats();
+		WGPUTextureFormat depthStencilFormat = renderPass.GetDepthStencilFormat();
+
+		// Few render pass layouts are used with the same pipeline, a linear search is enough
+		for (const PipelineData& pipelineData : m_pipelines)
+		{
+			if (pipelineData.colorFormats == colorFormats && pipelineData.depthStencilFormat == depthStencilFormat)
+				return pipelineData.pipeline;
+		}
+
+		WGPURenderPipeline pipeline = CreatePipeline(colorFormats, depthStencilFormat);
+		if (!pipeline)
+			return nullptr;
+
+		auto& pipelineData = m_pipelines.emplace_back();
+		pipelineData.colorFormats = colorFormats;
+		pipelineData.depthStencilFormat = depthStencilFormat;
+		pipelineData.pipeline = pipeline;
+
+		return pipeline;
+	}
+
+	const RenderPipelineInfo& WebGPURenderPipeline::GetPipelineInfo() const
+	{
+		return m_pipelineInfo;
+	}
+
+	void WebGPURenderPipeline::UpdateDebugName(std::string_view name)
+	{
+		m_debugName = name;
+	}
+
+	WGPURenderPipeline WebGPURenderPipeline::CreatePipeline(const std::vector<WGPUTextureFormat>& colorFormats, WGPUTextureFormat depthStencilFormat) const
+	{
+		const WebGPUShaderModule* fragmentModule = nullptr;
+		const WebGPUShaderModule* vertexModule = nullptr;
+		for (const auto& shaderModulePtr : m_pipelineInfo.shaderModules)
+		{
+			const WebGPUShaderModule& shaderModule = static_cast<const WebGPUShaderModule&>(*shaderModulePtr);
+			if (shaderModule.GetShaderStages().Test(nzsl::ShaderStageType::Fragment))
+				fragmentModule = &shaderModule;
+
+			if (shaderModule.GetShaderStages().Test(nzsl::ShaderStageType::Vertex))
+				vertexModule = &shaderModule;
+		}
+
+		if (!vertexModule)
+		{
+			NazaraError("render pipeline has no vertex shader");
+			return nullptr;
+		}
+
+		// Vertex buffers are identified by their index in the layout array, unused slots have no attribute
+		std::size_t vertexBufferCount = 0;
+		std::size_t vertexAttributeCount = 0;
+		for (const auto& bufferData : m_pipelineInfo.vertexBuffers)
+		{
+			vertexBufferCount = std::max(vertexBufferCount, bufferData.binding + 1);
+			vertexAttributeCount += bufferData.declaration->GetComponents().size();
+		}
+
+		std::vector<WGPUVertexAttribute> vertexAttributes;
+		vertexAttributes.reserve(vertexAttributeCount); //< layouts point inside this vector, it must not reallocate
+
+		std::vector<WGPUVertexBufferLayout> vertexBuffers(vertexBufferCount);
+		for (WGPUVertexBufferLayout& vertexBuffer : vertexBuffers)
+		{
+			vertexBuffer = {};
+			vertexBuffer.stepMode = WGPUVertexStepMode_VertexBufferNotUsed;
+		}
+
+		UInt32 locationIndex = 0;
+		for (const auto& bufferData : m_pipelineInfo.vertexBuffers)
+		{
+			std::size_t firstAttribute = vertexAttributes.size();
+			for (const auto& componentInfo : bufferData.declaration->GetComponents())
+			{
+				if (componentInfo.component == VertexComponent::Unused)
+					continue;
+
+				auto& vertexAttribute = vertexAttributes.emplace_back();
+				vertexAttribute.format = ToWebGPU(componentInfo.type);
+				vertexAttribute.offset = componentInfo.offset;
+				vertexAttribute.shaderLocation = locationIndex++;
+			}
+
+			WGPUVertexBufferLayout& vertexBuffer = vertexBuffers[bufferData.binding];
+			vertexBuffer.arrayStride = bufferData.declaration->GetStride();
+			vertexBuffer.attributeCount = vertexAttributes.size() - firstAttribute;
+			vertexBuffer.attributes = vertexAttributes.data() + firstAttribute;
+			vertexBuffer.stepMode = ToWebGPU(bufferData.declaration->GetInputRate());
+		}
+
+		WGPURenderPipelineDescriptor pipelineDesc = {};
+		pipelineDesc.label = (!m_debugName.empty()) ? m_debugName.c_str() : nullptr;
+		pipelineDesc.layout = static_cast<const WebGPURenderPipelineLayout&>(*m_pipelineInfo.pipelineLayout).GetHandle();
+
+		pipelineDesc.vertex.bufferCount = vertexBuffers.size();
+		pipelineDesc.vertex.buffers = vertexBuffers.data();
+		pipelineDesc.vertex.entryPoint = WebGPUShaderModule::GetEntryPointName(nzsl::ShaderStageType::Vertex);
+		pipelineDesc.vertex.module = vertexModule->GetHandle();
+
+		pipelineDesc.primitive.cullMode = ToWebGPU(m_pipelineInfo.faceCulling);
+		pipelineDesc.primitive.frontFace = ToWebGPU(m_pipelineInfo.frontFace);
+		pipelineDesc.primitive.topology = ToWebGPU(m_pipelineInfo.primitiveMode);
+
+		WGPUPrimitiveDepthClipControl depthClipControl = {};
+		if (m_pipelineInfo.depthClamp)
+		{
+			depthClipControl.chain.sType = WGPUSType_PrimitiveDepthClipControl;
+			depthClipControl.unclippedDepth = true;
+
+			pipelineDesc.primitive.nextInChain = &depthClipControl.chain;
+		}
+
+		pipelineDesc.multisample.count = 1;
+		pipelineDesc.multisample.mask = 0xFFFFFFFF;
+
+		WGPUDepthStencilState depthStencilState = {};
+		if (depthStencilFormat != WGPUTextureFormat_Undefined)
+		{
+			depthStencilState.format = depthStencilFormat;
+
+			if (m_pipelineInfo.depthBuffer)
+			{
+				depthStencilState.depthCompare = ToWebGPU(m_pipelineInfo.depthCompare);
+				depthStencilState.depthWriteEnabled = m_pipelineInfo.depthWrite;
+			}
+			else
+			{
+				depthStencilState.depthCompare = WGPUCompareFunction_Always;
+				depthStencilState.depthWriteEnabled = false;
+			}
+
+			if (m_pipelineInfo.depthBias)
+			{
+				depthStencilState.depthBias = static_cast<Int32>(std::round(m_pipelineInfo.depthBiasConstantFactor));
+				depthStencilState.depthBiasSlopeScale = m_pipelineInfo.depthBiasSlopeFactor;
+			}
+
+			auto FillStencilFace = [&](WGPUStencilFaceState& stencilFace, const auto& stencilStates)
+			{
+				if (m_pipelineInfo.stencilTest)
+				{
+					stencilFace.compare = ToWebGPU(stencilStates.compare);
+					stencilFace.depthFailOp = ToWebGPU(stencilStates.depthFail);
+					stencilFace.failOp = ToWebGPU(stencilStates.fail);
+					stencilFace.passOp = ToWebGPU(stencilStates.pass);
+				}
+				else
+				{
+					stencilFace.compare = WGPUCompareFunction_Always;
+					stencilFace.depthFailOp = WGPUStencilOperation_Keep;
+					stencilFace.failOp = WGPUStencilOperation_Keep;
+					stencilFace.passOp = WGPUStencilOperation_Keep;
+				}
+			};
+
+			// WebGPU has a single mask (and reference) for both faces
+			FillStencilFace(depthStencilState.stencilBack, m_pipelineInfo.stencilBack);
+			FillStencilFace(depthStencilState.stencilFront, m_pipelineInfo.stencilFront);
+			depthStencilState.stencilReadMask = (m_pipelineInfo.stencilTest) ? m_pipelineInfo.stencilFront.compareMask : 0xFFFFFFFF;
+			depthStencilState.stencilWriteMask = (m_pipelineInfo.stencilTest) ? m_pipelineInfo.stencilFront.writeMask : 0;
+
+			pipelineDesc.depthStencil = &depthStencilState;
+		}
+
+		WGPUBlendState blendState = {};
+		blendState.alpha.dstFactor = ToWebGPU(m_pipelineInfo.blend.dstAlpha);
+		blendState.alpha.operation = ToWebGPU(m_pipelineInfo.blend.modeAlpha);
+		blendState.alpha.srcFactor = ToWebGPU(m_pipelineInfo.blend.srcAlpha);
+		blendState.color.dstFactor = ToWebGPU(m_pipelineInfo.blend.dstColor);
+		blendState.color.operation = ToWebGPU(m_pipelineInfo.blend.modeColor);
+		blendState.color.srcFactor = ToWebGPU(m_pipelineInfo.blend.srcColor);
+
+		std::vector<WGPUColorTargetState> colorTargets(colorFormats.size());
+		for (std::size_t i = 0; i < colorFormats.size(); ++i)
+		{
+			WGPUColorTargetState& colorTarget = colorTargets[i];
+			colorTarget = {};
+			colorTarget.blend = (m_pipelineInfo.blending) ? &blendState : nullptr;
+			colorTarget.format = colorFormats[i];
+			colorTarget.writeMask = static_cast<WGPUColorWriteMaskFlags>(m_pipelineInfo.colorWriteMask); //< same bit order
+		}
+
+		WGPUFragmentState fragmentState = {};
+		if (fragmentModule)
+		{
+			fragmentState.entryPoint = WebGPUShaderModule::GetEntryPointName(nzsl::ShaderStageType::Fragment);
+			fragmentState.module = fragmentModule->GetHandle();
+			fragmentState.targetCount = colorTargets.size();
+			fragmentState.targets = colorTargets.data();
+
+			pipelineDesc.fragment = &fragmentState;
+		}
+
+		WGPURenderPipeline pipeline = wgpuDeviceCreateRenderPipeline(m_device.GetHandle(), &pipelineDesc);
+		if (!pipeline)
+			NazaraError("failed to create WebGPU render pipeline");
+
+		return pipeline;
+	}
+}
@@ -0,0 +1,128 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/WebGPURenderer/WebGPURenderPipelineLayout.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/WebGPURenderer/Utils.hpp>
+#include <Nazara/WebGPURenderer/WebGPUDevice.hpp>
+#include <stdexcept>
+#include <string>
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	WebGPURenderPipelineLayout::WebGPURenderPipelineLayout(WebGPUDevice& device, RenderPipelineLayoutInfo layoutInfo) :
+	m_layoutInfo(std::move(layoutInfo)),
+	m_device(device)
+	{
+		if (!m_layoutInfo.pushConstantRanges.empty())
+			throw std::runtime_error("WebGPU renderer doesn't support push constants");
+
+		std::vector<std::vector<WGPUBindGroupLayoutEntry>> setEntries;
+		for (const auto& bindingInfo : m_layoutInfo.bindings)
+		{
+			if (bindingInfo.arraySize != 1)
+				throw std::runtime_error("WebGPU renderer doesn't support binding arrays");
+
+			if (bindingInfo.setIndex >= setEntries.size())
+				setEntries.resize(bindingInfo.setIndex + 1);
+
+			auto& entries = setEntries[bindingInfo.setIndex];
+
+			WGPUShaderStageFlags visibility = ToWebGPU(bindingInfo.shaderStageFlags);
+
+			WGPUBindGroupLayoutEntry& entry = entries.emplace_back();
+			entry = {};
+			entry.binding = bindingInfo.bindingIndex;
+			entry.visibility = visibility;
+
+			switch (bindingInfo.type)
+			{
+				case ShaderBindingType::Sampler:
+				{
+					// TODO: Layout infos don't describe texture dimensions and sample types, assume filterable 2D textures
+					entry.texture.sampleType = WGPUTextureSampleType_Float;
+					entry.texture.viewDimension = WGPUTextureViewDimension_2D;
+
+					WGPUBindGroupLayoutEntry& samplerEntry = entries.emplace_back();
+					samplerEntry = {};
+					samplerEntry.binding = bindingInfo.bindingIndex + SamplerBindingOffset;
+					samplerEntry.sampler.type = WGPUSamplerBindingType_Filtering;
+					samplerEntry.visibility = visibility;
+					break;
+				}
+
+				case ShaderBindingType::StorageBuffer:
+					// Vertex shaders can't write to storage buffers
+					entry.buffer.type = (visibility & WGPUShaderStage_Vertex) ? WGPUBufferBindingType_ReadOnlyStorage : WGPUBufferBindingType_Storage;
+					break;
+
+				case ShaderBindingType::Texture:
+					// TODO: Layout infos don't describe storage texture formats
+					entry.storageTexture.access = WGPUStorageTextureAccess_WriteOnly;
+					entry.storageTexture.format = WGPUTextureFormat_RGBA8Unorm;
+					entry.storageTexture.viewDimension = WGPUTextureViewDimension_2D;
+					break;
+
+				case ShaderBindingType::UniformBuffer:
+					entry.buffer.type = WGPUBufferBindingType_Uniform;
+					break;
+			}
+		}
+
+		m_bindGroupLayouts.resize(setEntries.size());
+
+		std::vector<WGPUBindGroupLayout> bindGroupLayouts(setEntries.size());
+		for (std::size_t setIndex = 0; setIndex < setEntries.size(); ++setIndex)
+		{
+			const auto& entries = setEntries[setIndex];
+
+			WGPUBindGroupLayoutDescriptor bindGroupLayoutDesc = {};
+			bindGroupLayoutDesc.entries = entries.data();
+			bindGroupLayoutDesc.entryCount = entries.size();
+
+			WGPUBindGroupLayout bindGroupLayout = wgpuDeviceCreateBindGroupLayout(m_device.GetHandle(), &bindGroupLayoutDesc);
+			if (!bindGroupLayout)
+				throw std::runtime_error("failed to create WebGPU bind group layout");
+
+			m_bindGroupLayouts[setIndex].entryCount = entries.size();
+			m_bindGroupLayouts[setIndex].layout = bindGroupLayout;
+
+			bindGroupLayouts[setIndex] = bindGroupLayout;
+		}
+
+		WGPUPipelineLayoutDescriptor pipelineLayoutDesc = {};
+		pipelineLayoutDesc.bindGroupLayoutCount = bindGroupLayouts.size();
+		pipelineLayoutDesc.bindGroupLayouts = bindGroupLayouts.data();
+
+		m_pipelineLayout = wgpuDeviceCreatePipelineLayout(m_device.GetHandle(), &pipelineLayoutDesc);
+		if (!m_pipelineLayout)
+			throw std::runtime_error("failed to create WebGPU pipeline layout");
+	}
+
+	WebGPURenderPipelineLayout::~WebGPURenderPipelineLayout()
+	{
+		wgpuPipelineLayoutRelease(m_pipelineLayout);
+		for (const BindGroupLayout& bindGroupLayout : m_bindGroupLayouts)
+			wgpuBindGroupLayoutRelease(bindGroupLayout.layout);
+	}
+
+	ShaderBindingPtr WebGPURenderPipelineLayout::AllocateShaderBinding(UInt32 setIndex)
+	{
+		NazaraAssert(setIndex < m_bindGroupLayouts.size(), "invalid set index");
+
+		// Bind groups are immutable and allocated by the device, there's no pool to manage
+		return ShaderBindingPtr(new WebGPUShaderBinding(*this, setIndex));
+	}
+
+	void WebGPURenderPipelineLayout::UpdateDebugName(std::string_view name)
+	{
+		wgpuPipelineLayoutSetLabel(m_pipelineLayout, std::string(name).c_str());
+	}
+
+	void WebGPURenderPipelineLayout::Release(ShaderBinding& binding)
+	{
+		delete static_cast<WebGPUShaderBinding*>(&binding);
+	}
+}
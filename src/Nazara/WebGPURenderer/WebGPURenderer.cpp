@@ -0,0 +1,63 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/WebGPURenderer/WebGPURenderer.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <emscripten/html5_webgpu.h>
+#include <cassert>
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	WebGPURenderer::~WebGPURenderer()
+	{
+		if (m_device)
+			wgpuDeviceRelease(m_device);
+	}
+
+	std::shared_ptr<RenderDevice> WebGPURenderer::InstanciateRenderDevice([[maybe_unused]] std::size_t deviceIndex, const RenderDeviceFeatures& enabledFeatures)
+	{
+		assert(deviceIndex < m_deviceInfos.size());
+
+		RenderDeviceFeatures validatedFeatures = enabledFeatures;
+		RenderDevice::ValidateFeatures(m_deviceInfos[deviceIndex].features, validatedFeatures);
+
+		return std::make_shared<WebGPUDevice>(m_device, m_deviceInfos[deviceIndex], validatedFeatures);
+	}
+
+	bool WebGPURenderer::Prepare(const Renderer::Config& /*config*/)
+	{
+		// Adapter and device requests are asynchronous in browsers, the page has to request them before running the
+		// application and to store the device in Module.preinitializedWebGPUDevice
+		m_device = emscripten_webgpu_get_device();
+		if (!m_device)
+		{
+			NazaraError("no WebGPU device available (Module.preinitializedWebGPUDevice must be set before starting the application)");
+			return false;
+		}
+
+		m_deviceInfos.push_back(WebGPUDevice::BuildDeviceInfo(m_device));
+		return true;
+	}
+
+	RenderAPI WebGPURenderer::QueryAPI() const
+	{
+		return RenderAPI::WebGPU;
+	}
+
+	std::string WebGPURenderer::QueryAPIString() const
+	{
+		return "WebGPU renderer";
+	}
+
+	UInt32 WebGPURenderer::QueryAPIVersion() const
+	{
+		return 100;
+	}
+
+	const std::vector<RenderDeviceInfo>& WebGPURenderer::QueryRenderDevices() const
+	{
+		return m_deviceInfos;
+	}
+}
@@ -0,0 +1,126 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/WebGPURenderer/WebGPUShaderBinding.hpp>
+#include <Nazara/Core/Algorithm.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/WebGPURenderer/WebGPUBuffer.hpp>
+#include <Nazara/WebGPURenderer/WebGPUDevice.hpp>
+#include <Nazara/WebGPURenderer/WebGPURenderPipelineLayout.hpp>
+#include <Nazara/WebGPURenderer/WebGPUTexture.hpp>
+#include <Nazara/WebGPURenderer/WebGPUTextureSampler.hpp>
+#include <algorithm>
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	WebGPUShaderBinding::~WebGPUShaderBinding()
+	{
+		if (m_bindGroup)
+			wgpuBindGroupRelease(m_bindGroup);
+	}
+
+	void WebGPUShaderBinding::Update(const Binding* bindings, std::size_t bindingCount)
+	{
+		auto SetSampledTexture = [&](UInt32 bindingIndex, const SampledTextureBinding& textureBinding)
+		{
+			NazaraAssert(textureBinding.texture, "invalid texture");
+			NazaraAssert(textureBinding.sampler, "invalid sampler");
+
+			WGPUBindGroupEntry textureEntry = {};
+			textureEntry.binding = bindingIndex;
+			textureEntry.textureView = static_cast<const WebGPUTexture*>(textureBinding.texture)->GetViewHandle();
+			SetEntry(textureEntry);
+
+			WGPUBindGroupEntry samplerEntry = {};
+			samplerEntry.binding = bindingIndex + WebGPURenderPipelineLayout::SamplerBindingOffset;
+			samplerEntry.sampler = static_cast<const WebGPUTextureSampler*>(textureBinding.sampler)->GetHandle();
+			SetEntry(samplerEntry);
+		};
+
+		for (std::size_t i = 0; i < bindingCount; ++i)
+		{
+			const Binding& binding = bindings[i];
+
+			std::visit([&](auto&& arg)
+			{
+				using T = std::decay_t<decltype(arg)>;
+
+				if constexpr (std::is_same_v<T, SampledTextureBinding>)
+					SetSampledTexture(binding.bindingIndex, arg);
+				else if constexpr (std::is_same_v<T, SampledTextureBindings>)
+				{
+					if (arg.arraySize != 1 || arg.firstArrayElement != 0)
+					{
+						NazaraError("WebGPU renderer doesn't support binding arrays");
+						return;
+					}
+
+					SetSampledTexture(binding.bindingIndex, arg.textureBindings[0]);
+				}
+				else if constexpr (std::is_same_v<T, StorageBufferBinding> || std::is_same_v<T, UniformBufferBinding>)
+				{
+					NazaraAssert(arg.buffer, "invalid buffer");
+
+					WGPUBindGroupEntry entry = {};
+					entry.binding = binding.bindingIndex;
+					entry.buffer = static_cast<WebGPUBuffer*>(arg.buffer)->GetHandle();
+					entry.offset = arg.offset;
+					entry.size = arg.range;
+					SetEntry(entry);
+				}
+				else if constexpr (std::is_same_v<T, TextureBinding>)
+				{
+					NazaraAssert(arg.texture, "invalid texture");
+
+					WGPUBindGroupEntry entry = {};
+					entry.binding = binding.bindingIndex;
+					entry.textureView = static_cast<const WebGPUTexture*>(arg.texture)->GetViewHandle();
+					SetEntry(entry);
+				}
+				else
+					static_assert(AlwaysFalse<T>(), "non-exhaustive visitor");
+
+			}, binding.content);
+		}
+
+		// Bind groups are immutable and have to be complete, recreate it once every entry has been set
+		if (m_entries.size() < m_owner.GetBindGroupEntryCount(m_setIndex))
+			return;
+
+		if (m_bindGroup)
+			wgpuBindGroupRelease(m_bindGroup);
+
+		WGPUBindGroupDescriptor bindGroupDesc = {};
+		bindGroupDesc.entries = m_entries.data();
+		bindGroupDesc.entryCount = m_entries.size();
+		bindGroupDesc.label = (!m_debugName.empty()) ? m_debugName.c_str() : nullptr;
+		bindGroupDesc.layout = m_owner.GetBindGroupLayout(m_setIndex);
+
+		m_bindGroup = wgpuDeviceCreateBindGroup(m_owner.GetDevice().GetHandle(), &bindGroupDesc);
+		if (!m_bindGroup)
+			NazaraError("failed to create WebGPU bind group");
+	}
+
+	void WebGPUShaderBinding::UpdateDebugName(std::string_view name)
+	{
+		m_debugName = name;
+		if (m_bindGroup)
+			wgpuBindGroupSetLabel(m_bindGroup, m_debugName.c_str());
+	}
+
+	void WebGPUShaderBinding::Release()
+	{
+		m_owner.Release(*this);
+	}
+
+	void WebGPUShaderBinding::SetEntry(const WGPUBindGroupEntry& entry)
+	{
+		auto it = std::find_if(m_entries.begin(), m_entries.end(), [&](const WGPUBindGroupEntry& bindGroupEntry) { return bindGroupEntry.binding == entry.binding; });
+		if (it != m_entries.end())
+			*it = entry;
+		else
+			m_entries.push_back(entry);
+	}
+}
@@ -0,0 +1,69 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/WebGPURenderer/WebGPUShaderModule.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/WebGPURenderer/WebGPUDevice.hpp>
+#include <stdexcept>
+#include <string>
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	WebGPUShaderModule::WebGPUShaderModule(WebGPUDevice& device, nzsl::ShaderStageTypeFlags shaderStages, ShaderLanguage lang, const void* source, std::size_t sourceSize) :
+	m_shaderStages(shaderStages)
+	{
+		switch (lang)
+		{
+			case ShaderLanguage::WGSL:
+				break;
+
+			case ShaderLanguage::GLSL:
+			case ShaderLanguage::HLSL:
+			case ShaderLanguage::MSL:
+			case ShaderLanguage::NazaraBinary:
+			case ShaderLanguage::NazaraShader:
+			case ShaderLanguage::SpirV:
+				throw std::runtime_error("WebGPU renderer only supports WGSL shader sources");
+		}
+
+		// WGSL source isn't null-terminated
+		std::string code(static_cast<const char*>(source), sourceSize);
+
+		WGPUShaderModuleWGSLDescriptor wgslDesc = {};
+		wgslDesc.chain.sType = WGPUSType_ShaderModuleWGSLDescriptor;
+		wgslDesc.code = code.c_str();
+
+		WGPUShaderModuleDescriptor shaderModuleDesc = {};
+		shaderModuleDesc.nextInChain = &wgslDesc.chain;
+
+		m_shaderModule = wgpuDeviceCreateShaderModule(device.GetHandle(), &shaderModuleDesc);
+		if (!m_shaderModule)
+			throw std::runtime_error("failed to create WebGPU shader module");
+	}
+
+	WebGPUShaderModule::~WebGPUShaderModule()
+	{
+		wgpuShaderModuleRelease(m_shaderModule);
+	}
+
+	void WebGPUShaderModule::UpdateDebugName(std::string_view name)
+	{
+		wgpuShaderModuleSetLabel(m_shaderModule, std::string(name).c_str());
+	}
+
+	const char* WebGPUShaderModule::GetEntryPointName(nzsl::ShaderStageType stage)
+	{
+		// WGSL modules have to use these entry point names
+		switch (stage)
+		{
+			case nzsl::ShaderStageType::Compute:  return "compMain";
+			case nzsl::ShaderStageType::Fragment: return "fragMain";
+			case nzsl::ShaderStageType::Vertex:   return "vertMain";
+		}
+
+		NazaraError("unhandled ShaderStageType {0:#x})", UnderlyingCast(stage));
+		return {};
+	}
+}
@@ -0,0 +1,208 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/WebGPURenderer/WebGPUSwapchain.hpp>
+#include <Nazara/Renderer/RenderFrame.hpp>
+#include <Nazara/WebGPURenderer/Utils.hpp>
+#include <Nazara/WebGPURenderer/WebGPUCommandPool.hpp>
+#include <Nazara/WebGPURenderer/WebGPUDevice.hpp>
+#include <cassert>
+#include <stdexcept>
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	WebGPUSwapchain::WebGPUSwapchain(WebGPUDevice& device, WindowHandle /*windowHandle*/, const Vector2ui& windowSize, const SwapchainParameters& parameters) :
+	m_currentFrame(0),
+	m_device(device),
+	m_presentMode(PresentMode::VerticalSync),
+	m_size(windowSize),
+	m_swapchain(nullptr),
+	m_sizeInvalidated(false)
+	{
+		// Browsers only present to canvas elements, emscripten windows always render to the #canvas element
+		WGPUSurfaceDescriptorFromCanvasHTMLSelector canvasDesc = {};
+		canvasDesc.chain.sType = WGPUSType_SurfaceDescriptorFromCanvasHTMLSelector;
+		canvasDesc.selector = "#canvas";
+
+		WGPUSurfaceDescriptor surfaceDesc = {};
+		surfaceDesc.nextInChain = &canvasDesc.chain;
+
+		m_surface = wgpuInstanceCreateSurface(nullptr, &surfaceDesc);
+		if (!m_surface)
+			throw std::runtime_error("failed to create WebGPU surface");
+
+		m_colorFormat = wgpuSurfaceGetPreferredFormat(m_surface, nullptr);
+
+		std::optional<PixelFormat> colorFormat = FromWebGPU(m_colorFormat);
+		if (!colorFormat)
+		{
+			wgpuSurfaceRelease(m_surface);
+			throw std::runtime_error("unhandled surface preferred format");
+		}
+
+		for (PresentMode presentMode : parameters.presentMode)
+		{
+			if (GetSupportedPresentModes().Test(presentMode))
+			{
+				m_presentMode = presentMode;
+				break;
+			}
+		}
+
+		std::vector<RenderPass::Attachment> attachments;
+		std::vector<RenderPass::SubpassDescription> subpassDescriptions;
+		std::vector<RenderPass::SubpassDependency> subpassDependencies;
+
+		BuildRenderPass(*colorFormat, PixelFormat::Depth24Stencil8, attachments, subpassDescriptions, subpassDependencies);
+		m_renderPass.emplace(std::move(attachments), std::move(subpassDescriptions), std::move(subpassDependencies));
+
+		// Color attachment is updated each frame with the current swapchain texture
+		m_framebuffer.emplace(FramebufferType::Window, std::vector<WGPUTextureView>{ nullptr, nullptr });
+
+		CreateSwapchain();
+
+		constexpr std::size_t RenderImageCount = 2;
+
+		m_renderImage.reserve(RenderImageCount);
+		for (std::size_t i = 0; i < RenderImageCount; ++i)
+			m_renderImage.emplace_back(std::make_unique<WebGPURenderImage>(*this));
+	}
+
+	WebGPUSwapchain::~WebGPUSwapchain()
+	{
+		m_renderImage.clear();
+		m_framebuffer.reset();
+
+		ReleaseSwapchain();
+		wgpuSurfaceRelease(m_surface);
+	}
+
+	RenderFrame WebGPUSwapchain::AcquireFrame()
+	{
+		bool sizeInvalidated = m_sizeInvalidated;
+		if (sizeInvalidated)
+		{
+			ReleaseSwapchain();
+			CreateSwapchain();
+
+			m_sizeInvalidated = false;
+		}
+
+		WGPUTextureView textureView = wgpuSwapChainGetCurrentTextureView(m_swapchain);
+		m_framebuffer->UpdateAttachment(0, textureView);
+		wgpuTextureViewRelease(textureView);
+
+		return RenderFrame(m_renderImage[m_currentFrame].get(), sizeInvalidated, m_size, 0);
+	}
+
+	std::shared_ptr<CommandPool> WebGPUSwapchain::CreateCommandPool(QueueType /*queueType*/)
+	{
+		return std::make_shared<WebGPUCommandPool>();
+	}
+
+	const WebGPUFramebuffer& WebGPUSwapchain::GetFramebuffer(std::size_t i) const
+	{
+		assert(i == 0);
+		NazaraUnused(i);
+		return *m_framebuffer;
+	}
+
+	std::size_t WebGPUSwapchain::GetFramebufferCount() const
+	{
+		return 1;
+	}
+
+	PresentMode WebGPUSwapchain::GetPresentMode() const
+	{
+		return m_presentMode;
+	}
+
+	const WebGPURenderPass& WebGPUSwapchain::GetRenderPass() const
+	{
+		return *m_renderPass;
+	}
+
+	const Vector2ui& WebGPUSwapchain::GetSize() const
+	{
+		return m_size;
+	}
+
+	PresentModeFlags WebGPUSwapchain::GetSupportedPresentModes() const
+	{
+		// Browsers present in sync with their own compositor
+		return PresentMode::VerticalSync;
+	}
+
+	void WebGPUSwapchain::NotifyResize(const Vector2ui& newSize)
+	{
+		OnRenderTargetSizeChange(this, newSize);
+
+		m_size = newSize;
+		m_sizeInvalidated = true;
+	}
+
+	void WebGPUSwapchain::Present()
+	{
+		// Browsers present the canvas texture once control returns to the event loop, release our reference to it
+		m_framebuffer->UpdateAttachment(0, nullptr);
+
+		m_currentFrame = (m_currentFrame + 1) % m_renderImage.size();
+	}
+
+	void WebGPUSwapchain::SetPresentMode(PresentMode presentMode)
+	{
+		if (presentMode != PresentMode::VerticalSync)
+		{
+			NazaraError("present mode is not supported by the WebGPU renderer");
+			return;
+		}
+
+		m_presentMode = presentMode;
+	}
+
+	TransientResources& WebGPUSwapchain::Transient()
+	{
+		return *m_renderImage[m_currentFrame];
+	}
+
+	void WebGPUSwapchain::CreateSwapchain()
+	{
+		WGPUSwapChainDescriptor swapchainDesc = {};
+		swapchainDesc.format = m_colorFormat;
+		swapchainDesc.width = m_size.x;
+		swapchainDesc.height = m_size.y;
+		swapchainDesc.presentMode = ToWebGPU(m_presentMode);
+		swapchainDesc.usage = WGPUTextureUsage_RenderAttachment;
+
+		m_swapchain = wgpuDeviceCreateSwapChain(m_device.GetHandle(), m_surface, &swapchainDesc);
+		if (!m_swapchain)
+			throw std::runtime_error("failed to create WebGPU swapchain");
+
+		TextureInfo depthBufferInfo;
+		depthBufferInfo.pixelFormat = PixelFormat::Depth24Stencil8;
+		depthBufferInfo.type = ImageType::E2D;
+		depthBufferInfo.usageFlags = TextureUsage::DepthStencilAttachment;
+		depthBufferInfo.levelCount = 1;
+		depthBufferInfo.width = m_size.x;
+		depthBufferInfo.height = m_size.y;
+
+		m_depthBuffer = std::make_shared<WebGPUTexture>(m_device, depthBufferInfo);
+		m_framebuffer->UpdateAttachment(1, m_depthBuffer->GetViewHandle());
+	}
+
+	void WebGPUSwapchain::ReleaseSwapchain()
+	{
+		if (m_framebuffer)
+			m_framebuffer->UpdateAttachment(1, nullptr);
+
+		m_depthBuffer.reset();
+
+		if (m_swapchain)
+		{
+			wgpuSwapChainRelease(m_swapchain);
+			m_swapchain = nullptr;
+		}
+	}
+}
@@ -0,0 +1,253 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/WebGPURenderer/WebGPUTexture.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Utility/Image.hpp>
+#include <Nazara/Utility/PixelFormat.hpp>
+#include <Nazara/WebGPURenderer/Utils.hpp>
+#include <Nazara/WebGPURenderer/WebGPUDevice.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	WebGPUTexture::WebGPUTexture(WebGPUDevice& device, const TextureInfo& textureInfo) :
+	m_textureInfo(textureInfo),
+	m_device(device)
+	{
+		m_textureInfo.levelCount = std::min(m_textureInfo.levelCount, Image::GetMaxLevel(m_textureInfo.type, m_textureInfo.width, m_textureInfo.height, m_textureInfo.depth));
+
+		WGPUTextureDescriptor textureDesc = {};
+		textureDesc.dimension = ToWebGPU(m_textureInfo.type);
+		textureDesc.format = ToWebGPU(m_textureInfo.pixelFormat);
+		textureDesc.mipLevelCount = m_textureInfo.levelCount;
+		textureDesc.sampleCount = 1;
+		textureDesc.size.width = m_textureInfo.width;
+		textureDesc.usage = ToWebGPU(m_textureInfo.usageFlags);
+
+		if (textureDesc.format == WGPUTextureFormat_Undefined)
+			throw std::runtime_error("unsupported texture format");
+
+		switch (m_textureInfo.type)
+		{
+			case ImageType::E1D:
+				m_textureInfo.levelCount = 1; //< WebGPU 1D textures can't have mipmaps
+				textureDesc.mipLevelCount = 1;
+				textureDesc.size.height = 1;
+				textureDesc.size.depthOrArrayLayers = 1;
+				break;
+
+			case ImageType::E1D_Array:
+				textureDesc.size.height = 1;
+				textureDesc.size.depthOrArrayLayers = m_textureInfo.layerCount;
+				break;
+
+			case ImageType::E2D:
+				textureDesc.size.height = m_textureInfo.height;
+				textureDesc.size.depthOrArrayLayers = 1;
+				break;
+
+			case ImageType::E2D_Array:
+				textureDesc.size.height = m_textureInfo.height;
+				textureDesc.size.depthOrArrayLayers = m_textureInfo.layerCount;
+				break;
+
+			case ImageType::E3D:
+				textureDesc.size.height = m_textureInfo.height;
+				textureDesc.size.depthOrArrayLayers = m_textureInfo.depth;
+				break;
+
+			case ImageType::Cubemap:
+				textureDesc.size.height = m_textureInfo.height;
+				textureDesc.size.depthOrArrayLayers = 6;
+				break;
+		}
+
+		m_texture = wgpuDeviceCreateTexture(m_device.GetHandle(), &textureDesc);
+		if (!m_texture)
+			throw std::runtime_error("failed to create WebGPU texture");
+
+		WGPUTextureViewDescriptor viewDesc = {};
+		viewDesc.arrayLayerCount = textureDesc.size.depthOrArrayLayers;
+		viewDesc.aspect = WGPUTextureAspect_All;
+		viewDesc.dimension = ToWebGPUViewDimension(m_textureInfo.type);
+		viewDesc.format = textureDesc.format;
+		viewDesc.mipLevelCount = m_textureInfo.levelCount;
+
+		if (m_textureInfo.type == ImageType::E3D)
+			viewDesc.arrayLayerCount = 1;
+
+		m_textureView = wgpuTextureCreateView(m_texture, &viewDesc);
+	}
+
+	WebGPUTexture::WebGPUTexture(std::shared_ptr<WebGPUTexture> parentTexture, const TextureViewInfo& viewInfo) :
+	m_parentTexture(std::move(parentTexture)),
+	m_viewInfo(viewInfo),
+	m_device(m_parentTexture->m_device),
+	m_texture(m_parentTexture->m_texture)
+	{
+		NazaraAssert(viewInfo.layerCount <= m_parentTexture->m_textureInfo.layerCount - viewInfo.baseArrayLayer, "layer count exceeds number of layers");
+		NazaraAssert(viewInfo.levelCount <= m_parentTexture->m_textureInfo.levelCount - viewInfo.baseMipLevel, "level count exceeds number of levels");
+
+		m_textureInfo = ApplyView(m_parentTexture->m_textureInfo, viewInfo);
+
+		wgpuTextureReference(m_texture);
+
+		WGPUTextureViewDescriptor viewDesc = {};
+		viewDesc.arrayLayerCount = (viewInfo.viewType == ImageType::Cubemap) ? 6 : viewInfo.layerCount;
+		viewDesc.aspect = WGPUTextureAspect_All;
+		viewDesc.baseArrayLayer = viewInfo.baseArrayLayer;
+		viewDesc.baseMipLevel = viewInfo.baseMipLevel;
+		viewDesc.dimension = ToWebGPUViewDimension(viewInfo.viewType);
+		viewDesc.format = ToWebGPU(viewInfo.reinterpretFormat);
+		viewDesc.mipLevelCount = viewInfo.levelCount;
+
+		m_textureView = wgpuTextureCreateView(m_texture, &viewDesc);
+	}
+
+	WebGPUTexture::~WebGPUTexture()
+	{
+		wgpuTextureViewRelease(m_textureView);
+		wgpuTextureRelease(m_texture);
+	}
+
+	bool WebGPUTexture::Copy(const Texture& source, const Boxui& srcBox, const Vector3ui& dstPos)
+	{
+		const WebGPUTexture& sourceTexture = static_cast<const WebGPUTexture&>(source);
+
+		WGPUCommandEncoder encoder = wgpuDeviceCreateCommandEncoder(m_device.GetHandle(), nullptr);
+		EncodeCopy(encoder, sourceTexture, srcBox, dstPos);
+
+		WGPUCommandBuffer commandBuffer = wgpuCommandEncoderFinish(encoder, nullptr);
+		wgpuCommandEncoderRelease(encoder);
+
+		m_device.SubmitCommandBuffer(commandBuffer);
+		wgpuCommandBufferRelease(commandBuffer);
+
+		return true;
+	}
+
+	std::shared_ptr<Texture> WebGPUTexture::CreateView(const TextureViewInfo& viewInfo)
+	{
+		if (m_parentTexture)
+		{
+			NazaraAssert(viewInfo.layerCount <= m_viewInfo.layerCount - viewInfo.baseArrayLayer, "layer count exceeds number of layers");
+			NazaraAssert(viewInfo.levelCount <= m_viewInfo.levelCount - viewInfo.baseMipLevel, "level count exceeds number of levels");
+
+			TextureViewInfo ajustedView = viewInfo;
+			ajustedView.baseArrayLayer += m_viewInfo.baseArrayLayer;
+			ajustedView.baseMipLevel += m_viewInfo.baseMipLevel;
+
+			return m_parentTexture->CreateView(ajustedView);
+		}
+
+		return std::make_shared<WebGPUTexture>(std::static_pointer_cast<WebGPUTexture>(shared_from_this()), viewInfo);
+	}
+
+	void WebGPUTexture::EncodeCopy(WGPUCommandEncoder encoder, const WebGPUTexture& source, const Boxui& srcBox, const Vector3ui& dstPos) const
+	{
+		WGPUExtent3D copySize;
+		WGPUImageCopyTexture sourceCopy = source.BuildCopyTexture(srcBox, 0, &copySize);
+		WGPUImageCopyTexture targetCopy = BuildCopyTexture(Boxui(dstPos.x, dstPos.y, dstPos.z, srcBox.width, srcBox.height, srcBox.depth), 0, nullptr);
+
+		wgpuCommandEncoderCopyTextureToTexture(encoder, &sourceCopy, &targetCopy, &copySize);
+	}
+
+	bool WebGPUTexture::Update(const void* ptr, const Boxui& box, unsigned int srcWidth, unsigned int srcHeight, UInt8 level)
+	{
+		Boxui updateBox = box;
+
+		// Like other backends, updating a cubemap updates its six faces
+		if (m_textureInfo.type == ImageType::Cubemap)
+		{
+			updateBox.z = 0;
+			updateBox.depth = 6;
+		}
+
+		WGPUExtent3D writeSize;
+		WGPUImageCopyTexture destination = BuildCopyTexture(updateBox, level, &writeSize);
+
+		unsigned int rowWidth = (srcWidth != 0) ? srcWidth : writeSize.width;
+		unsigned int rowCount = (srcHeight != 0) ? srcHeight : writeSize.height;
+
+		// Computing sizes from the pixel format handles block-compressed formats (where rows are rows of blocks)
+		std::size_t bytesPerRow = PixelFormatInfo::ComputeSize(m_textureInfo.pixelFormat, rowWidth, 1, 1);
+		std::size_t imageSize = PixelFormatInfo::ComputeSize(m_textureInfo.pixelFormat, rowWidth, rowCount, 1);
+
+		WGPUTextureDataLayout dataLayout = {};
+		dataLayout.bytesPerRow = SafeCast<UInt32>(bytesPerRow);
+		dataLayout.rowsPerImage = SafeCast<UInt32>(imageSize / bytesPerRow);
+
+		wgpuQueueWriteTexture(m_device.GetQueue(), &destination, ptr, imageSize * writeSize.depthOrArrayLayers, &dataLayout, &writeSize);
+		return true;
+	}
+
+	void WebGPUTexture::UpdateDebugName(std::string_view name)
+	{
+		std::string label(name);
+		if (!m_parentTexture)
+			wgpuTextureSetLabel(m_texture, label.c_str());
+
+		wgpuTextureViewSetLabel(m_textureView, label.c_str());
+	}
+
+	WGPUImageCopyTexture WebGPUTexture::BuildCopyTexture(const Boxui& box, UInt8 level, WGPUExtent3D* extent) const
+	{
+		// Views share the texture of their parent, coordinates have to be offset by the view base level and layer
+		UInt32 baseLayer = (m_parentTexture) ? m_viewInfo.baseArrayLayer : 0;
+		UInt32 baseLevel = (m_parentTexture) ? m_viewInfo.baseMipLevel : 0;
+
+		WGPUImageCopyTexture copyTexture = {};
+		copyTexture.aspect = WGPUTextureAspect_All;
+		copyTexture.mipLevel = baseLevel + level;
+		copyTexture.texture = m_texture;
+		copyTexture.origin.x = box.x;
+
+		WGPUExtent3D copyExtent;
+		copyExtent.width = box.width;
+
+		switch (m_textureInfo.type)
+		{
+			case ImageType::E1D:
+				copyTexture.origin.y = 0;
+				copyTexture.origin.z = 0;
+				copyExtent.height = 1;
+				copyExtent.depthOrArrayLayers = 1;
+				break;
+
+			case ImageType::E1D_Array:
+				// 1D arrays store their layers along the Y axis
+				copyTexture.origin.y = 0;
+				copyTexture.origin.z = baseLayer + box.y;
+				copyExtent.height = 1;
+				copyExtent.depthOrArrayLayers = box.height;
+				break;
+
+			case ImageType::E2D:
+			case ImageType::E2D_Array:
+			case ImageType::Cubemap:
+				copyTexture.origin.y = box.y;
+				copyTexture.origin.z = baseLayer + box.z;
+				copyExtent.height = box.height;
+				copyExtent.depthOrArrayLayers = box.depth;
+				break;
+
+			case ImageType::E3D:
+				copyTexture.origin.y = box.y;
+				copyTexture.origin.z = box.z;
+				copyExtent.height = box.height;
+				copyExtent.depthOrArrayLayers = box.depth;
+				break;
+		}
+
+		if (extent)
+			*extent = copyExtent;
+
+		return copyTexture;
+	}
+}
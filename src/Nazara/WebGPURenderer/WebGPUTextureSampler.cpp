@@ -0,0 +1,47 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/WebGPURenderer/WebGPUTextureSampler.hpp>
+#include <Nazara/WebGPURenderer/Utils.hpp>
+#include <Nazara/WebGPURenderer/WebGPUDevice.hpp>
+#include <stdexcept>
+#include <string>
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	WebGPUTextureSampler::WebGPUTextureSampler(WebGPUDevice& device, const TextureSamplerInfo& samplerInfo)
+	{
+		WGPUSamplerDescriptor samplerDesc = {};
+		samplerDesc.addressModeU = ToWebGPU(samplerInfo.wrapModeU);
+		samplerDesc.addressModeV = ToWebGPU(samplerInfo.wrapModeV);
+		samplerDesc.addressModeW = ToWebGPU(samplerInfo.wrapModeW);
+		samplerDesc.compare = (samplerInfo.depthCompare) ? ToWebGPU(samplerInfo.depthComparison) : WGPUCompareFunction_Undefined;
+		samplerDesc.lodMaxClamp = 1000.f;
+		samplerDesc.lodMinClamp = 0.f;
+		samplerDesc.magFilter = ToWebGPU(samplerInfo.magFilter);
+		samplerDesc.maxAnisotropy = 1;
+		samplerDesc.minFilter = ToWebGPU(samplerInfo.minFilter);
+		samplerDesc.mipmapFilter = ToWebGPU(samplerInfo.mipmapMode);
+
+		// Anisotropic filtering is only allowed when every filter is linear
+		bool isLinear = (samplerInfo.magFilter == SamplerFilter::Linear && samplerInfo.minFilter == SamplerFilter::Linear && samplerInfo.mipmapMode == SamplerMipmapMode::Linear);
+		if (samplerInfo.anisotropyLevel > 1.f && isLinear)
+			samplerDesc.maxAnisotropy = static_cast<UInt16>(samplerInfo.anisotropyLevel);
+
+		m_sampler = wgpuDeviceCreateSampler(device.GetHandle(), &samplerDesc);
+		if (!m_sampler)
+			throw std::runtime_error("failed to create WebGPU sampler");
+	}
+
+	WebGPUTextureSampler::~WebGPUTextureSampler()
+	{
+		wgpuSamplerRelease(m_sampler);
+	}
+
+	void WebGPUTextureSampler::UpdateDebugName(std::string_view name)
+	{
+		wgpuSamplerSetLabel(m_sampler, std::string(name).c_str());
+	}
+}
@@ -0,0 +1,105 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - WebGPU renderer"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/WebGPURenderer/WebGPUUploadPool.hpp>
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <Nazara/WebGPURenderer/Debug.hpp>
+
+namespace Nz
+{
+	auto WebGPUUploadPool::Allocate(UInt64 size) -> Allocation&
+	{
+		return Allocate(size, 1); //< Alignment doesn't matter
+	}
+
+	auto WebGPUUploadPool::Allocate(UInt64 size, UInt64 /*alignment*/) -> Allocation&
+	{
+		// Try to minimize lost space
+		struct
+		{
+			Block* block = nullptr;
+			UInt64 offset = 0;
+		} bestBlock;
+
+		for (Block& block : m_blocks)
+		{
+			if (block.freeOffset + size > block.size)
+				continue; //< Not enough space
+
+			if (!bestBlock.block)
+			{
+				bestBlock.block = &block;
+				bestBlock.offset = block.freeOffset;
+				break; //< Since we have no alignment constraint, the first block is good
+			}
+		}
+
+		// No block found, allocate a new one
+		if (!bestBlock.block)
+		{
+			// Grow geometrically to limit block creations under heavy usage, unused blocks will be released by Reset
+			// Handle really big allocations (TODO: Handle them separately as they shouldn't be common and can consume a lot of memory)
+			UInt64 blockSize = std::max({ m_blockSize, size, GetStats().reservedBytes });
+
+			Block newBlock;
+			newBlock.size = blockSize;
+
+			newBlock.memory.resize(blockSize);
+
+			RegisterBlock(blockSize);
+
+			bestBlock.block = &m_blocks.emplace_back(std::move(newBlock));
+			bestBlock.offset = 0;
+		}
+
+		// Now find the proper allocation buffer
+		std::size_t allocationBlockIndex = m_nextAllocationIndex / AllocationPerBlock;
+		std::size_t allocationIndex = m_nextAllocationIndex % AllocationPerBlock;
+
+		if (allocationBlockIndex >= m_allocationBlocks.size())
+		{
+			assert(allocationBlockIndex == m_allocationBlocks.size());
+			m_allocationBlocks.emplace_back(std::make_unique<AllocationBlock>());
+		}
+
+		auto& allocationBlock = *m_allocationBlocks[allocationBlockIndex];
+
+		Allocation& allocationData = allocationBlock[allocationIndex];
+		allocationData.mappedPtr = static_cast<UInt8*>(bestBlock.block->memory.data()) + bestBlock.offset;
+		allocationData.size = size;
+
+		bestBlock.block->freeOffset += size;
+		m_nextAllocationIndex++;
+
+		RegisterAllocation(size);
+
+		return allocationData;
+	}
+
+	void WebGPUUploadPool::Reset()
+	{
+		for (Block& block : m_blocks)
+		{
+			if (block.freeOffset == 0)
+				block.unusedResetCount++;
+			else
+				block.unusedResetCount = 0;
+
+			block.freeOffset = 0;
+		}
+
+		// Allocations go to the first blocks with enough space, blocks past the high-water mark are at the end, release them if they stayed unused for a while (always keeping one)
+		while (m_blocks.size() > 1 && m_blocks.back().unusedResetCount >= UnusedBlockReleaseDelay)
+		{
+			UnregisterBlock(m_blocks.back().size);
+			m_blocks.pop_back();
+		}
+
+		m_nextAllocationIndex = 0;
+
+		RegisterReset();
+	}
+}
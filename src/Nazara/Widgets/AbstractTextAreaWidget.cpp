@@ -22,6 +22,7 @@ namespace Nz
 
 	AbstractTextAreaWidget::AbstractTextAreaWidget(BaseWidget* parent) :
 	BaseWidget(parent),
+	m_visibleGlyphs(0, 0),
 	m_characterFilter(),
 	m_echoMode(EchoMode::Normal),
 	m_cursorPositionBegin(0U, 0U),
@@ -135,6 +136,72 @@ namespace Nz
 		return !m_readOnly;
 	}
 
+	void AbstractTextAreaWidget::SetRenderingRect(const Rectf& renderingRect)
+	{
+		BaseWidget::SetRenderingRect(renderingRect);
+
+		// Only rebuild the text sprite if scrolling revealed or hid some lines
+		std::pair<std::size_t, std::size_t> visibleGlyphs = ComputeVisibleGlyphRange();
+		if (m_visibleGlyphs != visibleGlyphs)
+		{
+			m_visibleGlyphs = visibleGlyphs;
+			m_textSprite->Update(GetTextDrawer(), visibleGlyphs.first, visibleGlyphs.second - visibleGlyphs.first);
+		}
+	}
+
+	/*!
+	* \brief Computes the range of glyphs of the lines intersecting both the widget and its rendering rect
+	* \return Index of the first visible glyph and index past the last visible glyph
+	*/
+	std::pair<std::size_t, std::size_t> AbstractTextAreaWidget::ComputeVisibleGlyphRange() const
+	{
+		const AbstractTextDrawer& textDrawer = GetTextDrawer();
+		std::size_t lineCount = textDrawer.GetLineCount();
+
+		float height = GetHeight();
+		const Rectf& renderingRect = GetRenderingRect();
+
+		float visibleTop = std::min(height, renderingRect.y + renderingRect.height);
+		float visibleBottom = std::max(0.f, renderingRect.y);
+		if (lineCount == 0 || visibleTop <= visibleBottom)
+			return { 0, 0 };
+
+		// Lines are laid out downwards from the top of the text (minus padding) while the widget y axis goes up
+		float textTop = height - s_textAreaPaddingHeight;
+		float visibleMinY = textTop - visibleTop;
+		float visibleMaxY = textTop - visibleBottom;
+
+		// Lines are sorted vertically, find the first line for which the predicate is false
+		auto FindLine = [&](auto&& predicate)
+		{
+			std::size_t first = 0;
+			std::size_t count = lineCount;
+			while (count > 0)
+			{
+				std::size_t step = count / 2;
+				if (predicate(textDrawer.GetLine(first + step).bounds))
+				{
+					first += step + 1;
+					count -= step + 1;
+				}
+				else
+					count = step;
+			}
+
+			return first;
+		};
+
+		std::size_t firstLine = FindLine([&](const Rectf& lineBounds) { return lineBounds.y + lineBounds.height <= visibleMinY; });
+		std::size_t endLine = FindLine([&](const Rectf& lineBounds) { return lineBounds.y < visibleMaxY; });
+		if (firstLine >= endLine)
+			return { 0, 0 };
+
+		std::size_t firstGlyph = textDrawer.GetLine(firstLine).glyphIndex;
+		std::size_t endGlyph = (endLine < lineCount) ? textDrawer.GetLine(endLine).glyphIndex : textDrawer.GetGlyphCount();
+
+		return { firstGlyph, endGlyph };
+	}
+
 	void AbstractTextAreaWidget::Layout()
 	{
 		BaseWidget::Layout();
@@ -664,15 +731,20 @@ namespace Nz
 	void AbstractTextAreaWidget::UpdateTextSprite()
 	{
 		const AbstractTextDrawer& textDrawer = GetTextDrawer();
-		m_textSprite->Update(textDrawer);
 
 		float preferredHeight = 0.f;
-		std::size_t lineCount = textDrawer.GetLineCount();
-		for (std::size_t i = 0; i < lineCount; ++i)
-			preferredHeight += textDrawer.GetLine(i).bounds.height;
+		if (std::size_t lineCount = textDrawer.GetLineCount(); lineCount > 0)
+		{
+			const Rectf& lastLineBounds = textDrawer.GetLine(lineCount - 1).bounds;
+			preferredHeight = lastLineBounds.y + lastLineBounds.height;
+		}
 
 		SetPreferredSize({ -1.f, preferredHeight + s_textAreaPaddingHeight * 2.f });
 
+		// Only build quads for the visible lines, which matters for long texts scrolled in a ScrollAreaWidget
+		m_visibleGlyphs = ComputeVisibleGlyphRange();
+		m_textSprite->Update(textDrawer, m_visibleGlyphs.first, m_visibleGlyphs.second - m_visibleGlyphs.first);
+
 		Vector2f textSize = Vector2f(m_textSprite->GetAABB().GetLengths());
 
 		auto& textNode = GetRegistry().get<NodeComponent>(m_textEntity);
@@ -153,7 +153,7 @@ namespace Nz
 		NotifyParentResized(newSize);
 		m_size = newSize;
 
-		Layout();
+		InvalidateLayout();
 
 		OnWidgetResized(this, newSize);
 	}
@@ -272,6 +272,29 @@ namespace Nz
 		m_registry->destroy(entity);
 	}
 
+	/*!
+	 * \brief Requests the widget to be laid out again
+	 *
+	 * If the canvas has deferred layout enabled, the layout is postponed until the next Canvas::UpdateLayouts call,
+	 * coalescing every invalidation happening in-between into a single Layout call. Otherwise, Layout is called immediately.
+	 */
+	void BaseWidget::InvalidateLayout()
+	{
+		if (m_canvas && m_canvas->IsDeferredLayoutEnabled())
+		{
+			if (!m_isLayoutInvalidated)
+			{
+				m_isLayoutInvalidated = true;
+
+				// Hidden widgets will be scheduled when registering back to the canvas
+				if (IsRegisteredToCanvas())
+					m_canvas->InvalidateWidgetLayout(m_canvasIndex);
+			}
+		}
+		else
+			Layout();
+	}
+
 	void BaseWidget::Layout()
 	{
 		if (m_backgroundSprite)
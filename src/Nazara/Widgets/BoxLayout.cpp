@@ -145,24 +145,24 @@ namespace Nz
 	void BoxLayout::OnChildAdded(const BaseWidget* /*child*/)
 	{
 		RecomputePreferredSize();
-		Layout();
+		InvalidateLayout();
 	}
 
 	void BoxLayout::OnChildPreferredSizeUpdated(const BaseWidget* /*child*/)
 	{
-		Layout();
+		InvalidateLayout();
 	}
 
 	void BoxLayout::OnChildVisibilityUpdated(const BaseWidget* /*child*/)
 	{
 		RecomputePreferredSize();
-		Layout();
+		InvalidateLayout();
 	}
 
 	void BoxLayout::OnChildRemoved(const BaseWidget* /*child*/)
 	{
 		RecomputePreferredSize();
-		Layout();
+		InvalidateLayout();
 	}
 
 	void BoxLayout::RecomputePreferredSize()
@@ -25,7 +25,7 @@ namespace Nz
 		SetMinimumSize(size);
 		SetPreferredSize(size + Vector2f(20.f, 10.f)); //< corner size (TODO: Retrieve them from theme)
 
-		Layout();
+		InvalidateLayout();
 	}
 
 	void ButtonWidget::Layout()
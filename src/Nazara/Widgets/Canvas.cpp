@@ -4,6 +4,9 @@
 
 #include <Nazara/Widgets/Canvas.hpp>
 #include <Nazara/Widgets/DefaultWidgetTheme.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
 #include <limits>
 #include <Nazara/Widgets/Debug.hpp>
 
@@ -16,7 +19,8 @@ namespace Nz
 	m_keyboardOwner(InvalidCanvasIndex),
 	m_hoveredWidget(InvalidCanvasIndex),
 	m_mouseOwner(InvalidCanvasIndex),
-	m_registry(registry)
+	m_registry(registry),
+	m_deferredLayout(false)
 	{
 		m_canvas = this;
 		BaseWidget::m_registry = &m_registry;
@@ -40,16 +44,98 @@ namespace Nz
 		m_textEditedSlot.Connect(eventHandler.OnTextEdited, this, &Canvas::OnEventTextEdited);
 	}
 
+	/*!
+	 * \brief Enables or disables deferred layout
+	 *
+	 * When enabled, widgets resizes and content changes only mark widgets as needing a layout, which is then resolved once by UpdateLayouts (parents first).
+	 * This prevents layouts (such as BoxLayout) from being recomputed multiple times when multiple changes happen in a row.
+	 * Pending layouts are also resolved before handling mouse events.
+	 *
+	 * \param enable Should layouts be deferred
+	 *
+	 * \remark Disabling deferred layout resolves pending layouts immediately
+	 * \see UpdateLayouts
+	 */
+	void Canvas::EnableDeferredLayout(bool enable)
+	{
+		if (m_deferredLayout == enable)
+			return;
+
+		if (!enable)
+			UpdateLayouts();
+
+		m_deferredLayout = enable;
+	}
+
+	/*!
+	 * \brief Lays out every widget whose layout was invalidated since the last call
+	 *
+	 * Parents are laid out before their children, so a widget resized by its parent layout is only laid out once.
+	 * This should be called once per frame when deferred layout is enabled.
+	 */
+	void Canvas::UpdateLayouts()
+	{
+		while (!m_invalidatedLayouts.empty())
+		{
+			m_pendingLayouts.clear();
+			for (BaseWidget* widget : m_invalidatedLayouts)
+			{
+				if (!widget)
+					continue; //< unregistered
+
+				std::size_t depth = 0;
+				for (BaseWidget* parent = widget->m_parentWidget; parent; parent = parent->m_parentWidget)
+					depth++;
+
+				m_pendingLayouts.push_back({ widget, depth });
+			}
+			m_invalidatedLayouts.clear();
+
+			std::stable_sort(m_pendingLayouts.begin(), m_pendingLayouts.end(), [](const PendingLayout& lhs, const PendingLayout& rhs)
+			{
+				return lhs.depth < rhs.depth;
+			});
+
+			// Layouts can invalidate other widgets (which will be handled in the next iteration) or destroy them (nulling their entry)
+			for (std::size_t i = 0; i < m_pendingLayouts.size(); ++i)
+			{
+				BaseWidget* widget = m_pendingLayouts[i].widget;
+				if (!widget)
+					continue;
+
+				widget->m_isLayoutInvalidated = false;
+				widget->Layout();
+			}
+		}
+
+		m_pendingLayouts.clear();
+	}
+
 	std::size_t Canvas::RegisterWidget(BaseWidget* widget)
 	{
 		WidgetEntry box;
 		box.cursor = widget->GetCursor();
+		box.isInHitGrid = false;
+		box.isOversized = false;
 		box.widget = widget;
 
 		std::size_t index = m_widgetEntries.size();
 		m_widgetEntries.emplace_back(box);
 
 		NotifyWidgetBoxUpdate(index);
+
+		if (widget->m_isLayoutInvalidated)
+		{
+			// Layout was invalidated while the widget was hidden
+			if (m_deferredLayout)
+				m_invalidatedLayouts.push_back(widget);
+			else
+			{
+				widget->m_isLayoutInvalidated = false;
+				widget->Layout();
+			}
+		}
+
 		return index;
 	}
 
@@ -57,6 +143,19 @@ namespace Nz
 	{
 		WidgetEntry& entry = m_widgetEntries[index];
 
+		RemoveFromHitGrid(index);
+
+		if (entry.widget->m_isLayoutInvalidated)
+		{
+			// Keep the invalidation flag so the widget gets scheduled again if it registers back
+			std::replace(m_invalidatedLayouts.begin(), m_invalidatedLayouts.end(), entry.widget, static_cast<BaseWidget*>(nullptr));
+			for (PendingLayout& pendingLayout : m_pendingLayouts)
+			{
+				if (pendingLayout.widget == entry.widget)
+					pendingLayout.widget = nullptr;
+			}
+		}
+
 		if (m_hoveredWidget == index)
 			m_hoveredWidget = InvalidCanvasIndex;
 
@@ -69,14 +168,18 @@ namespace Nz
 		if (m_keyboardOwner == index)
 			m_keyboardOwner = InvalidCanvasIndex;
 
-		if (m_widgetEntries.size() > 1U)
+		if (index != m_widgetEntries.size() - 1)
 		{
 			WidgetEntry& lastEntry = m_widgetEntries.back();
 			std::size_t lastEntryIndex = m_widgetEntries.size() - 1;
 
+			RemoveFromHitGrid(lastEntryIndex);
+
 			entry = std::move(lastEntry);
 			entry.widget->UpdateCanvasIndex(index);
 
+			InsertIntoHitGrid(index);
+
 			if (m_hoveredWidget == lastEntryIndex)
 				m_hoveredWidget = index;
 
@@ -106,8 +209,30 @@ namespace Nz
 		}
 	}
 
+	void Canvas::InsertIntoHitGrid(std::size_t index)
+	{
+		WidgetEntry& entry = m_widgetEntries[index];
+		assert(!entry.isInHitGrid);
+
+		entry.isOversized = !ComputeHitGridCells(entry.box, entry.firstHitCell, entry.lastHitCell);
+		if (entry.isOversized)
+			m_oversizedHitEntries.push_back(index);
+		else
+		{
+			for (int y = entry.firstHitCell.y; y <= entry.lastHitCell.y; ++y)
+			{
+				for (int x = entry.firstHitCell.x; x <= entry.lastHitCell.x; ++x)
+					m_hitGridCells[GetHitGridCellKey(x, y)].push_back(index);
+			}
+		}
+
+		entry.isInHitGrid = true;
+	}
+
 	void Canvas::OnEventMouseButtonPressed(const WindowEventHandler* /*eventHandler*/, const WindowEvent::MouseButtonEvent& event)
 	{
+		UpdateLayouts(); //< widgets boxes must be up to date
+
 		UpdateHoveredWidget(event.x, event.y);
 
 		if (std::size_t targetWidgetIndex = GetMouseEventTarget(); targetWidgetIndex != InvalidCanvasIndex)
@@ -132,6 +257,8 @@ namespace Nz
 
 	void Canvas::OnEventMouseButtonRelease(const WindowEventHandler* /*eventHandler*/, const WindowEvent::MouseButtonEvent& event)
 	{
+		UpdateLayouts(); //< widgets boxes must be up to date
+
 		if (std::size_t targetWidgetIndex = GetMouseEventTarget(); targetWidgetIndex != InvalidCanvasIndex)
 		{
 			DispatchEvent(targetWidgetIndex, [&](WidgetEntry& widgetEntry)
@@ -187,6 +314,8 @@ namespace Nz
 
 	void Canvas::OnEventMouseMoved(const WindowEventHandler* /*eventHandler*/, const WindowEvent::MouseMoveEvent& event)
 	{
+		UpdateLayouts(); //< widgets boxes must be up to date
+
 		// Don't update hovered widget while the user doesn't release its mouse
 		UpdateHoveredWidget(event.x, event.y);
 
@@ -203,6 +332,8 @@ namespace Nz
 
 	void Canvas::OnEventMouseWheelMoved(const WindowEventHandler* /*eventHandler*/, const WindowEvent::MouseWheelEvent& event)
 	{
+		UpdateLayouts(); //< widgets boxes must be up to date
+
 		if (std::size_t targetWidgetIndex = GetMouseEventTarget(); targetWidgetIndex != InvalidCanvasIndex)
 		{
 			DispatchEvent(targetWidgetIndex, [&](WidgetEntry& widgetEntry)
@@ -293,6 +424,60 @@ namespace Nz
 			m_widgetEntries[m_keyboardOwner].widget->OnTextEdited(event.text, event.length);
 	}
 
+	void Canvas::RemoveFromHitGrid(std::size_t index)
+	{
+		WidgetEntry& entry = m_widgetEntries[index];
+		if (!entry.isInHitGrid)
+			return;
+
+		auto RemoveIndex = [&](std::vector<std::size_t>& indices)
+		{
+			auto it = std::find(indices.begin(), indices.end(), index);
+			assert(it != indices.end());
+
+			*it = indices.back();
+			indices.pop_back();
+		};
+
+		if (entry.isOversized)
+			RemoveIndex(m_oversizedHitEntries);
+		else
+		{
+			for (int y = entry.firstHitCell.y; y <= entry.lastHitCell.y; ++y)
+			{
+				for (int x = entry.firstHitCell.x; x <= entry.lastHitCell.x; ++x)
+				{
+					auto it = m_hitGridCells.find(GetHitGridCellKey(x, y));
+					assert(it != m_hitGridCells.end());
+
+					RemoveIndex(it->second);
+					if (it->second.empty())
+						m_hitGridCells.erase(it);
+				}
+			}
+		}
+
+		entry.isInHitGrid = false;
+	}
+
+	void Canvas::UpdateHitGrid(std::size_t index)
+	{
+		WidgetEntry& entry = m_widgetEntries[index];
+		if (entry.isInHitGrid)
+		{
+			// Widget boxes are updated on every node invalidation, skip grid update if the widget still covers the same cells
+			Vector2i firstCell;
+			Vector2i lastCell;
+			bool isOversized = !ComputeHitGridCells(entry.box, firstCell, lastCell);
+			if (isOversized == entry.isOversized && (isOversized || (firstCell == entry.firstHitCell && lastCell == entry.lastHitCell)))
+				return;
+
+			RemoveFromHitGrid(index);
+		}
+
+		InsertIntoHitGrid(index);
+	}
+
 	void Canvas::UpdateHoveredWidget(int x, int y)
 	{
 		std::size_t bestEntry = InvalidCanvasIndex;
@@ -300,7 +485,19 @@ namespace Nz
 		int bestEntryLayer = std::numeric_limits<int>::min();
 
 		Vector3f mousePos(float(x), m_size.y - float(y), 0.f);
-		for (std::size_t i = 0; i < m_widgetEntries.size(); ++i)
+
+		// Only test widgets whose box overlaps the mouse cell
+		m_hitCandidates = m_oversizedHitEntries;
+
+		int cellX = static_cast<int>(std::floor(mousePos.x / HitGridCellSize));
+		int cellY = static_cast<int>(std::floor(mousePos.y / HitGridCellSize));
+		if (auto it = m_hitGridCells.find(GetHitGridCellKey(cellX, cellY)); it != m_hitGridCells.end())
+			m_hitCandidates.insert(m_hitCandidates.end(), it->second.begin(), it->second.end());
+
+		// Keep canvas order as the selection below favors the first widget on equal area
+		std::sort(m_hitCandidates.begin(), m_hitCandidates.end());
+
+		for (std::size_t i : m_hitCandidates)
 		{
 			const Boxf& box = m_widgetEntries[i].box;
 			int layer = m_widgetEntries[i].widget->GetBaseRenderLayer();
@@ -349,4 +546,20 @@ namespace Nz
 				m_cursorController->UpdateCursor(Cursor::Get(SystemCursor::Default));
 		}
 	}
+
+	bool Canvas::ComputeHitGridCells(const Boxf& box, Vector2i& firstCell, Vector2i& lastCell)
+	{
+		constexpr float MaxCoordinate = HitGridCellSize * float(1 << 24); //< keeps cell coordinates in int range
+
+		if (!(std::abs(box.x) < MaxCoordinate && std::abs(box.y) < MaxCoordinate && box.width < MaxCoordinate && box.height < MaxCoordinate))
+			return false; //< also handles NaN
+
+		firstCell.x = static_cast<int>(std::floor(box.x / HitGridCellSize));
+		firstCell.y = static_cast<int>(std::floor(box.y / HitGridCellSize));
+		lastCell.x = static_cast<int>(std::floor((box.x + box.width) / HitGridCellSize));
+		lastCell.y = static_cast<int>(std::floor((box.y + box.height) / HitGridCellSize));
+
+		std::size_t cellCount = std::size_t(lastCell.x - firstCell.x + 1) * std::size_t(lastCell.y - firstCell.y + 1);
+		return cellCount <= MaxHitGridCellsPerWidget;
+	}
 }
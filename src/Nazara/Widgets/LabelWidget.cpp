@@ -25,7 +25,7 @@ namespace Nz
 		SetMinimumSize(size);
 		SetPreferredSize(size);
 
-		Layout();
+		InvalidateLayout();
 	}
 
 	void LabelWidget::OnMouseEnter()
@@ -0,0 +1,237 @@
+// Copyright (C) 2023 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Engine - Widgets module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Widgets/ListViewWidget.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <Nazara/Widgets/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Constructs an empty list view
+	*
+	* \param parent Parent widget
+	* \param itemHeight Height of every row
+	* \param columnCount Number of items per row, the width of the widget being evenly split between them
+	*/
+	ListViewWidget::ListViewWidget(BaseWidget* parent, float itemHeight, std::size_t columnCount) :
+	BaseWidget(parent),
+	m_columnCount(columnCount),
+	m_itemCount(0),
+	m_itemHeight(itemHeight)
+	{
+		NazaraAssert(m_columnCount > 0, "column count must be over zero");
+		NazaraAssert(m_itemHeight > 0.f, "item height must be over zero");
+
+		UpdatePreferredSize();
+	}
+
+	/*!
+	* \brief Gets the widget currently displaying an item
+	* \return Item widget or a null pointer if the item is not visible
+	*
+	* \param itemIndex Index of the item
+	*/
+	BaseWidget* ListViewWidget::GetItemWidget(std::size_t itemIndex) const
+	{
+		auto it = std::find_if(m_itemWidgets.begin(), m_itemWidgets.end(), [&](const ItemWidget& itemWidget) { return itemWidget.itemIndex == itemIndex; });
+		if (it == m_itemWidgets.end())
+			return nullptr;
+
+		return it->widget;
+	}
+
+	/*!
+	* \brief Binds an item again if it's visible, should be called when the item data changed
+	*
+	* \param itemIndex Index of the item
+	*/
+	void ListViewWidget::InvalidateItem(std::size_t itemIndex)
+	{
+		if (!m_itemBinder)
+			return;
+
+		if (BaseWidget* widget = GetItemWidget(itemIndex))
+			m_itemBinder(widget, itemIndex);
+	}
+
+	/*!
+	* \brief Binds every visible item again, should be called when the items data changed
+	*/
+	void ListViewWidget::InvalidateItems()
+	{
+		UpdateVisibleItems(true);
+	}
+
+	void ListViewWidget::SetColumnCount(std::size_t columnCount)
+	{
+		NazaraAssert(columnCount > 0, "column count must be over zero");
+
+		if (m_columnCount != columnCount)
+		{
+			m_columnCount = columnCount;
+
+			UpdatePreferredSize();
+			UpdateVisibleItems(false);
+		}
+	}
+
+	/*!
+	* \brief Sets the callbacks used to create and fill item widgets
+	*
+	* The factory is called when more item widgets are required and must create them as children of the list view (using ListViewWidget::Add),
+	* item widgets are then reused for other items, the binder being called each time an item widget is assigned a new item.
+	* Existing item widgets are destroyed.
+	*
+	* \param factory Callback creating an item widget
+	* \param binder Callback filling an item widget from the item data
+	*/
+	void ListViewWidget::SetItemCallbacks(ItemFactory factory, ItemBinder binder)
+	{
+		for (ItemWidget& itemWidget : m_itemWidgets)
+			itemWidget.widget->Destroy();
+
+		m_itemWidgets.clear();
+
+		m_itemBinder = std::move(binder);
+		m_itemFactory = std::move(factory);
+
+		UpdateVisibleItems(true);
+	}
+
+	/*!
+	* \brief Sets the number of items of the list
+	*
+	* Visible items are bound again, as the items they display may have changed.
+	*
+	* \param itemCount Item count
+	*/
+	void ListViewWidget::SetItemCount(std::size_t itemCount)
+	{
+		m_itemCount = itemCount;
+
+		UpdatePreferredSize();
+		UpdateVisibleItems(true);
+	}
+
+	void ListViewWidget::SetItemHeight(float itemHeight)
+	{
+		NazaraAssert(itemHeight > 0.f, "item height must be over zero");
+
+		if (m_itemHeight != itemHeight)
+		{
+			m_itemHeight = itemHeight;
+
+			UpdatePreferredSize();
+			UpdateVisibleItems(false);
+		}
+	}
+
+	void ListViewWidget::SetRenderingRect(const Rectf& renderingRect)
+	{
+		BaseWidget::SetRenderingRect(renderingRect);
+
+		UpdateVisibleItems(false);
+	}
+
+	void ListViewWidget::Layout()
+	{
+		BaseWidget::Layout();
+
+		UpdateVisibleItems(false);
+	}
+
+	void ListViewWidget::ShowChildren(bool show)
+	{
+		// Recycled item widgets must stay hidden
+		for (const ItemWidget& itemWidget : m_itemWidgets)
+			itemWidget.widget->Show(show && itemWidget.itemIndex != InvalidItem);
+	}
+
+	void ListViewWidget::UpdatePreferredSize()
+	{
+		SetPreferredSize({ GetPreferredWidth(), GetRowCount() * m_itemHeight });
+	}
+
+	void ListViewWidget::UpdateVisibleItems(bool rebind)
+	{
+		if (!m_itemFactory)
+			return;
+
+		// Rows are laid out from the top of the widget, whose y axis goes up
+		float height = GetHeight();
+		const Rectf& renderingRect = GetRenderingRect();
+
+		float visibleTop = std::min(height, renderingRect.y + renderingRect.height);
+		float visibleBottom = std::max(0.f, renderingRect.y);
+
+		std::size_t firstItem = 0;
+		std::size_t endItem = 0;
+		if (visibleTop > visibleBottom)
+		{
+			std::size_t firstRow = static_cast<std::size_t>(std::floor((height - visibleTop) / m_itemHeight));
+			std::size_t endRow = std::min(GetRowCount(), static_cast<std::size_t>(std::ceil((height - visibleBottom) / m_itemHeight)));
+
+			firstItem = firstRow * m_columnCount;
+			endItem = std::min(m_itemCount, endRow * m_columnCount);
+		}
+
+		// Release widgets of items which are no longer visible
+		std::vector<std::size_t> itemSlots(endItem - std::min(firstItem, endItem), InvalidItem);
+		std::vector<std::size_t> freeWidgets;
+		for (std::size_t i = 0; i < m_itemWidgets.size(); ++i)
+		{
+			ItemWidget& itemWidget = m_itemWidgets[i];
+			if (itemWidget.itemIndex != InvalidItem && itemWidget.itemIndex >= firstItem && itemWidget.itemIndex < endItem)
+				itemSlots[itemWidget.itemIndex - firstItem] = i;
+			else
+			{
+				itemWidget.itemIndex = InvalidItem;
+				itemWidget.widget->Hide();
+
+				freeWidgets.push_back(i);
+			}
+		}
+
+		float itemWidth = GetWidth() / m_columnCount;
+		for (std::size_t itemIndex = firstItem; itemIndex < endItem; ++itemIndex)
+		{
+			std::size_t& widgetIndex = itemSlots[itemIndex - firstItem];
+
+			bool bind = rebind;
+			if (widgetIndex == InvalidItem)
+			{
+				if (!freeWidgets.empty())
+				{
+					widgetIndex = freeWidgets.back();
+					freeWidgets.pop_back();
+				}
+				else
+				{
+					BaseWidget* widget = m_itemFactory(this);
+					assert(widget);
+
+					widgetIndex = m_itemWidgets.size();
+					m_itemWidgets.push_back({ widget, InvalidItem });
+				}
+
+				m_itemWidgets[widgetIndex].itemIndex = itemIndex;
+				bind = true;
+			}
+
+			BaseWidget* widget = m_itemWidgets[widgetIndex].widget;
+			if (bind && m_itemBinder)
+				m_itemBinder(widget, itemIndex);
+
+			std::size_t row = itemIndex / m_columnCount;
+			std::size_t column = itemIndex % m_columnCount;
+
+			widget->Resize({ itemWidth, m_itemHeight });
+			widget->SetPosition(column * itemWidth, height - (row + 1) * m_itemHeight);
+			widget->Show(IsVisible());
+		}
+	}
+}
@@ -23,10 +23,7 @@ namespace Nz
 		m_horizontalScrollbar = Add<ScrollbarWidget>(ScrollbarOrientation::Vertical);
 		m_horizontalScrollbar->OnScrollbarValueUpdate.Connect([this](ScrollbarWidget*, float newValue)
 		{
-			float contentPosition = (GetHeight() - m_content->GetHeight()) * (1.f - newValue);
-
-			m_content->SetPosition(0.f, contentPosition);
-			m_content->SetRenderingRect(Nz::Rectf(-std::numeric_limits<float>::infinity(), -contentPosition, std::numeric_limits<float>::infinity(), GetHeight()));
+			UpdateContentPosition(m_content->GetHeight(), newValue);
 		});
 
 		Resize(m_content->GetSize()); //< will automatically layout
@@ -72,7 +69,9 @@ namespace Nz
 		{
 			m_hasScrollbar = true;
 
+			// Place the content before resizing it, so it knows which part of it is visible when laid out (see ListViewWidget)
 			Nz::Vector2f contentSize(areaWidth - scrollBarWidth, contentHeight);
+			UpdateContentPosition(contentHeight, m_horizontalScrollbar->GetValue());
 			m_content->Resize(contentSize);
 
 			if (m_isScrollbarEnabled)
@@ -97,6 +96,12 @@ namespace Nz
 		BaseWidget::Layout();
 	}
 
+	void ScrollAreaWidget::OnChildPreferredSizeUpdated(const BaseWidget* child)
+	{
+		if (child == m_content)
+			InvalidateLayout();
+	}
+
 	bool ScrollAreaWidget::OnMouseWheelMoved(int /*x*/, int /*y*/, float delta)
 	{
 		constexpr float scrollStep = 100.f;
@@ -104,4 +109,12 @@ namespace Nz
 		ScrollToHeight(GetScrollHeight() - scrollStep * delta);
 		return true;
 	}
+
+	void ScrollAreaWidget::UpdateContentPosition(float contentHeight, float ratio)
+	{
+		float contentPosition = (GetHeight() - contentHeight) * (1.f - ratio);
+
+		m_content->SetPosition(0.f, contentPosition);
+		m_content->SetRenderingRect(Nz::Rectf(-std::numeric_limits<float>::infinity(), -contentPosition, std::numeric_limits<float>::infinity(), GetHeight()));
+	}
 }
@@ -90,27 +90,39 @@ namespace Nz
 			std::swap(firstGlyph, lastGlyph);
 
 		std::size_t textLength = ComputeCharacterCount(m_text);
-		if (firstGlyph > textLength)
+		if (firstGlyph >= textLength)
 			return;
 
-		std::string newText;
-		if (firstGlyph > 0)
-		{
-			std::size_t characterPosition = GetCharacterPosition(m_text, firstGlyph);
-			NazaraAssert(characterPosition != std::string::npos, "Invalid character position");
+		lastGlyph = std::min(lastGlyph, textLength);
 
-			newText.append(m_text.substr(0, characterPosition));
-		}
+		std::size_t firstPosition = GetCharacterPosition(m_text, firstGlyph);
+		NazaraAssert(firstPosition != std::string::npos, "Invalid character position");
+
+		std::size_t lastPosition = (lastGlyph < textLength) ? GetCharacterPosition(m_text, lastGlyph) : m_text.size();
+		NazaraAssert(lastPosition != std::string::npos, "Invalid character position");
 
-		if (lastGlyph < textLength)
+		// Edit text in place, letting the drawer only lay out again the modified lines
+		m_text.erase(firstPosition, lastPosition - firstPosition);
+		OnTextChanged(this, m_text);
+
+		switch (m_echoMode)
 		{
-			std::size_t characterPosition = GetCharacterPosition(m_text, lastGlyph);
-			NazaraAssert(characterPosition != std::string::npos, "Invalid character position");
+			case EchoMode::Normal:
+				m_drawer.EraseText(firstPosition, lastPosition - firstPosition);
+				break;
 
-			newText.append(m_text.substr(characterPosition));
+			case EchoMode::Hidden:
+				m_drawer.EraseText(firstGlyph, lastGlyph - firstGlyph);
+				break;
+
+			case EchoMode::HiddenExceptLast:
+				m_drawer.SetText(std::string(ComputeCharacterCount(m_text), '*'));
+				break;
 		}
 
-		SetText(newText);
+		UpdateTextSprite();
+
+		SetCursorPosition(m_cursorPositionBegin); //< Refresh cursor position (prevent it from being outside of the text)
 	}
 
 	void TextAreaWidget::Write(std::string_view text, std::size_t glyphPosition)
@@ -123,8 +135,28 @@ namespace Nz
 		}
 		else
 		{
-			m_text.insert(GetCharacterPosition(m_text, glyphPosition), text);
-			SetText(m_text);
+			std::size_t characterPosition = GetCharacterPosition(m_text, glyphPosition);
+			NazaraAssert(characterPosition != std::string::npos, "Invalid character position");
+
+			m_text.insert(characterPosition, text);
+			OnTextChanged(this, m_text);
+
+			switch (m_echoMode)
+			{
+				case EchoMode::Normal:
+					m_drawer.InsertText(characterPosition, text);
+					break;
+
+				case EchoMode::Hidden:
+					m_drawer.InsertText(glyphPosition, std::string(ComputeCharacterCount(text), '*'));
+					break;
+
+				case EchoMode::HiddenExceptLast:
+					m_drawer.SetText(std::string(ComputeCharacterCount(m_text), '*'));
+					break;
+			}
+
+			UpdateTextSprite();
 
 			SetCursorPosition(glyphPosition + ComputeCharacterCount(text));
 		}
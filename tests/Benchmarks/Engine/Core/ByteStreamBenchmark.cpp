@@ -0,0 +1,70 @@
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/ByteStream.hpp>
+#include <Nazara/Math/Quaternion.hpp>
+#include <Nazara/Math/Vector3.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+
+TEST_CASE("ByteStream serialization", "[CORE][BYTESTREAM][!benchmark]")
+{
+	constexpr std::size_t EntityCount = 1000;
+
+	struct EntityState
+	{
+		Nz::Quaternionf rotation;
+		Nz::Vector3f position;
+		std::string name;
+		Nz::UInt32 id;
+	};
+
+	std::vector<EntityState> entities(EntityCount);
+	for (std::size_t i = 0; i < EntityCount; ++i)
+	{
+		EntityState& entity = entities[i];
+		entity.id = static_cast<Nz::UInt32>(i);
+		entity.name = "Entity #" + std::to_string(i);
+		entity.position = Nz::Vector3f(float(i), float(i) * 0.5f, -float(i));
+		entity.rotation = Nz::Quaternionf::Identity();
+	}
+
+	auto Serialize = [&](Nz::ByteArray& byteArray)
+	{
+		Nz::ByteStream stream(&byteArray, Nz::OpenMode::WriteOnly);
+		for (const EntityState& entity : entities)
+		{
+			stream << entity.id << entity.name;
+			stream << entity.position.x << entity.position.y << entity.position.z;
+			stream << entity.rotation.w << entity.rotation.x << entity.rotation.y << entity.rotation.z;
+		}
+	};
+
+	BENCHMARK("Write 1000 entity states")
+	{
+		Nz::ByteArray byteArray;
+		Serialize(byteArray);
+
+		return byteArray.GetSize();
+	};
+
+	Nz::ByteArray serializedEntities;
+	Serialize(serializedEntities);
+
+	BENCHMARK("Read 1000 entity states")
+	{
+		Nz::ByteStream stream(&serializedEntities, Nz::OpenMode::ReadOnly);
+
+		EntityState entity;
+		Nz::UInt64 idSum = 0;
+		for (std::size_t i = 0; i < EntityCount; ++i)
+		{
+			stream >> entity.id >> entity.name;
+			stream >> entity.position.x >> entity.position.y >> entity.position.z;
+			stream >> entity.rotation.w >> entity.rotation.x >> entity.rotation.y >> entity.rotation.z;
+
+			idSum += entity.id;
+		}
+
+		return idSum;
+	};
+}
@@ -0,0 +1,76 @@
+#include <Nazara/Graphics/RenderQueue.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+TEST_CASE("RenderQueue sorting", "[GRAPHICS][RENDERQUEUE][!benchmark]")
+{
+	constexpr std::size_t ElementCount = 10'000;
+
+	struct RenderElement
+	{
+		Nz::UInt64 sortKey;
+	};
+
+	std::mt19937 rng(42);
+	std::uniform_int_distribution<Nz::UInt64> keyDis;
+
+	std::vector<Nz::UInt64> randomKeys(ElementCount);
+	for (Nz::UInt64& key : randomKeys)
+		key = keyDis(rng);
+
+	// Frame-to-frame coherency: most elements keep their order, a few swap places
+	std::vector<Nz::UInt64> nearlySortedKeys = randomKeys;
+	std::sort(nearlySortedKeys.begin(), nearlySortedKeys.end());
+	std::uniform_int_distribution<std::size_t> indexDis(0, ElementCount - 1);
+	for (std::size_t i = 0; i < ElementCount / 100; ++i)
+		std::swap(nearlySortedKeys[indexDis(rng)], nearlySortedKeys[indexDis(rng)]);
+
+	// Sorted runs interleaved with each other, only a few descents but most elements are far from their place
+	constexpr std::size_t RunCount = 8;
+	std::vector<Nz::UInt64> sortedKeys = randomKeys;
+	std::sort(sortedKeys.begin(), sortedKeys.end());
+	std::vector<Nz::UInt64> interleavedRunKeys;
+	interleavedRunKeys.reserve(ElementCount);
+	for (std::size_t run = 0; run < RunCount; ++run)
+	{
+		for (std::size_t i = run; i < ElementCount; i += RunCount)
+			interleavedRunKeys.push_back(sortedKeys[i]);
+	}
+
+	auto BenchmarkSort = [](Catch::Benchmark::Chronometer meter, const std::vector<Nz::UInt64>& keys)
+	{
+		std::vector<Nz::RenderQueue<const RenderElement*>> renderQueues(meter.runs());
+		std::vector<RenderElement> elements(keys.size());
+		for (std::size_t i = 0; i < keys.size(); ++i)
+			elements[i].sortKey = keys[i];
+
+		for (auto& renderQueue : renderQueues)
+		{
+			for (const RenderElement& element : elements)
+				renderQueue.Insert(&element);
+		}
+
+		meter.measure([&](int i)
+		{
+			renderQueues[i].Sort([](const RenderElement* element) { return element->sortKey; });
+		});
+	};
+
+	BENCHMARK_ADVANCED("Sort 10000 elements with random keys")(Catch::Benchmark::Chronometer meter)
+	{
+		BenchmarkSort(meter, randomKeys);
+	};
+
+	BENCHMARK_ADVANCED("Sort 10000 elements with nearly sorted keys")(Catch::Benchmark::Chronometer meter)
+	{
+		BenchmarkSort(meter, nearlySortedKeys);
+	};
+
+	BENCHMARK_ADVANCED("Sort 10000 elements with interleaved sorted runs")(Catch::Benchmark::Chronometer meter)
+	{
+		BenchmarkSort(meter, interleavedRunKeys);
+	};
+}
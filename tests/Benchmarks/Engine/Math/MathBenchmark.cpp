@@ -0,0 +1,219 @@
+#include <Nazara/Math/Box.hpp>
+#include <Nazara/Math/EulerAngles.hpp>
+#include <Nazara/Math/Frustum.hpp>
+#include <Nazara/Math/Matrix4.hpp>
+#include <Nazara/Math/Quaternion.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+	std::vector<Nz::Quaternionf> GenerateRotations(std::mt19937& rng, std::size_t count)
+	{
+		std::uniform_real_distribution<float> angleDis(-180.f, 180.f);
+
+		std::vector<Nz::Quaternionf> rotations(count);
+		for (Nz::Quaternionf& rotation : rotations)
+			rotation = Nz::EulerAnglesf(Nz::DegreeAnglef(angleDis(rng)), Nz::DegreeAnglef(angleDis(rng)), Nz::DegreeAnglef(angleDis(rng)));
+
+		return rotations;
+	}
+}
+
+TEST_CASE("Matrix4 operations", "[MATH][MATRIX4][!benchmark]")
+{
+	constexpr std::size_t MatrixCount = 1000;
+
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<float> posDis(-100.f, 100.f);
+
+	std::vector<Nz::Quaternionf> rotations = GenerateRotations(rng, MatrixCount);
+
+	std::vector<Nz::Matrix4f> matrices(MatrixCount);
+	std::vector<Nz::Vector3f> positions(MatrixCount);
+	for (std::size_t i = 0; i < MatrixCount; ++i)
+	{
+		positions[i] = Nz::Vector3f(posDis(rng), posDis(rng), posDis(rng));
+		matrices[i] = Nz::Matrix4f::Transform(positions[i], rotations[i]);
+	}
+
+	BENCHMARK("Build 1000 transform matrices")
+	{
+		float accumulator = 0.f;
+		for (std::size_t i = 0; i < MatrixCount; ++i)
+			accumulator += Nz::Matrix4f::Transform(positions[i], rotations[i]).m41;
+
+		return accumulator;
+	};
+
+	BENCHMARK("Multiply 1000 matrices")
+	{
+		Nz::Matrix4f result = Nz::Matrix4f::Identity();
+		for (const Nz::Matrix4f& matrix : matrices)
+			result = Nz::Matrix4f::ConcatenateTransform(result, matrix);
+
+		return result;
+	};
+
+	BENCHMARK("Multiply 1000 matrix pairs")
+	{
+		std::vector<Nz::Matrix4f> results(MatrixCount);
+		for (std::size_t i = 1; i < MatrixCount; ++i)
+			results[i] = Nz::Matrix4f::ConcatenateTransform(matrices[i - 1], matrices[i]);
+
+		return results;
+	};
+
+	BENCHMARK("Multiply 1000 matrix pairs (batch)")
+	{
+		std::vector<Nz::Matrix4f> results(MatrixCount);
+		Nz::Matrix4f::ConcatenateTransform(matrices.data(), matrices.data() + 1, results.data() + 1, MatrixCount - 1);
+
+		return results;
+	};
+
+	BENCHMARK("Inverse 1000 matrices")
+	{
+		float accumulator = 0.f;
+		for (const Nz::Matrix4f& matrix : matrices)
+		{
+			Nz::Matrix4f inverse;
+			matrix.GetInverse(&inverse);
+			accumulator += inverse.m41;
+		}
+
+		return accumulator;
+	};
+
+	BENCHMARK("Inverse 1000 transform matrices")
+	{
+		float accumulator = 0.f;
+		for (const Nz::Matrix4f& matrix : matrices)
+		{
+			Nz::Matrix4f inverse;
+			matrix.GetInverseTransform(&inverse);
+			accumulator += inverse.m41;
+		}
+
+		return accumulator;
+	};
+
+	BENCHMARK("Transform 1000 vectors")
+	{
+		Nz::Vector3f accumulator = Nz::Vector3f::Zero();
+		for (std::size_t i = 0; i < MatrixCount; ++i)
+			accumulator += matrices[i].Transform(positions[i]);
+
+		return accumulator;
+	};
+
+	BENCHMARK("Transform 1000 vectors by one matrix")
+	{
+		std::vector<Nz::Vector3f> results(MatrixCount);
+		for (std::size_t i = 0; i < MatrixCount; ++i)
+			results[i] = matrices[0].Transform(positions[i]);
+
+		return results;
+	};
+
+	BENCHMARK("Transform 1000 vectors by one matrix (batch)")
+	{
+		std::vector<Nz::Vector3f> results(MatrixCount);
+		matrices[0].Transform(positions.data(), results.data(), MatrixCount);
+
+		return results;
+	};
+
+	std::vector<Nz::Boxf> boxes(MatrixCount);
+	for (std::size_t i = 0; i < MatrixCount; ++i)
+		boxes[i] = Nz::Boxf(positions[i], Nz::Vector3f(1.f, 2.f, 3.f));
+
+	BENCHMARK("Transform 1000 boxes by one matrix")
+	{
+		std::vector<Nz::Boxf> results(boxes);
+		for (Nz::Boxf& box : results)
+			box.Transform(matrices[0]);
+
+		return results;
+	};
+
+	BENCHMARK("Transform 1000 boxes by one matrix (batch)")
+	{
+		std::vector<Nz::Boxf> results(MatrixCount);
+		Nz::Boxf::Transform(matrices[0], boxes.data(), results.data(), MatrixCount);
+
+		return results;
+	};
+}
+
+TEST_CASE("Quaternion operations", "[MATH][QUATERNION][!benchmark]")
+{
+	constexpr std::size_t QuaternionCount = 1000;
+
+	std::mt19937 rng(42);
+	std::vector<Nz::Quaternionf> rotations = GenerateRotations(rng, QuaternionCount);
+
+	BENCHMARK("Multiply 1000 quaternions")
+	{
+		Nz::Quaternionf result = Nz::Quaternionf::Identity();
+		for (const Nz::Quaternionf& rotation : rotations)
+			result = result * rotation;
+
+		return result;
+	};
+
+	BENCHMARK("Slerp 1000 quaternions")
+	{
+		Nz::Quaternionf accumulator = Nz::Quaternionf::Zero();
+		for (std::size_t i = 1; i < QuaternionCount; ++i)
+			accumulator += Nz::Quaternionf::Slerp(rotations[i - 1], rotations[i], 0.3f);
+
+		return accumulator;
+	};
+
+	BENCHMARK("Slerp 1000 quaternions (batch)")
+	{
+		std::vector<Nz::Quaternionf> results(QuaternionCount);
+		Nz::Quaternionf::Slerp(rotations.data(), rotations.data() + 1, 0.3f, results.data() + 1, QuaternionCount - 1);
+
+		return results;
+	};
+}
+
+TEST_CASE("Frustum culling", "[MATH][FRUSTUM][!benchmark]")
+{
+	constexpr std::size_t BoxCount = 10'000;
+
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<float> posDis(-500.f, 500.f);
+	std::uniform_real_distribution<float> sizeDis(0.5f, 10.f);
+
+	std::vector<Nz::Boxf> boxes(BoxCount);
+	for (Nz::Boxf& box : boxes)
+		box = Nz::Boxf(posDis(rng), posDis(rng), posDis(rng), sizeDis(rng), sizeDis(rng), sizeDis(rng));
+
+	Nz::Frustumf frustum = Nz::Frustumf::Build(Nz::DegreeAnglef(70.f), 16.f / 9.f, 0.1f, 1000.f, Nz::Vector3f::Zero(), Nz::Vector3f::Forward());
+
+	BENCHMARK("Cull 10000 boxes")
+	{
+		std::size_t visibleCount = 0;
+		for (const Nz::Boxf& box : boxes)
+		{
+			if (frustum.Intersect(box) != Nz::IntersectionSide::Outside)
+				visibleCount++;
+		}
+
+		return visibleCount;
+	};
+
+	std::vector<Nz::IntersectionSide> sides(BoxCount);
+
+	BENCHMARK("Cull 10000 boxes (batch)")
+	{
+		frustum.Intersect(boxes.data(), boxes.size(), sides.data());
+		return std::count_if(sides.begin(), sides.end(), [](Nz::IntersectionSide side) { return side != Nz::IntersectionSide::Outside; });
+	};
+}
@@ -0,0 +1,92 @@
+#include <Nazara/Network/ENetHost.hpp>
+#include <Nazara/Network/ENetPeer.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <random>
+
+namespace
+{
+	bool WaitForEvent(Nz::ENetHost& host, Nz::ENetEvent& event, Nz::ENetEventType eventType, Nz::ENetHost* otherHost)
+	{
+		for (std::size_t i = 0; i < 1000; ++i)
+		{
+			if (otherHost)
+			{
+				Nz::ENetEvent otherEvent;
+				otherHost->Service(&otherEvent, 0);
+			}
+
+			if (host.Service(&event, 1) > 0 && event.type == eventType)
+				return true;
+		}
+
+		return false;
+	}
+}
+
+TEST_CASE("ENetHost loopback throughput", "[NETWORK][ENETHOST][!benchmark]")
+{
+	constexpr std::size_t PacketCount = 100;
+	constexpr Nz::UInt16 NetCode = 42;
+
+	Nz::ENetHost server;
+	REQUIRE(server.Create(Nz::IpAddress::LoopbackIpV4, 1));
+
+	Nz::ENetHost client;
+	REQUIRE(client.Create(Nz::NetProtocol::IPv4, 0, 1));
+
+	Nz::IpAddress serverAddress = server.GetBoundAddress();
+	Nz::ENetPeer* serverPeer = client.Connect(serverAddress);
+	REQUIRE(serverPeer);
+
+	Nz::ENetEvent event;
+	REQUIRE(WaitForEvent(server, event, Nz::ENetEventType::IncomingConnect, &client));
+	REQUIRE(WaitForEvent(client, event, Nz::ENetEventType::OutgoingConnect, &server));
+
+	std::mt19937 rng(42);
+	std::uniform_int_distribution<unsigned int> byteDis(0, 255);
+
+	std::array<Nz::UInt8, 512> payload;
+	for (Nz::UInt8& byte : payload)
+		byte = static_cast<Nz::UInt8>(byteDis(rng));
+
+	auto SendAndReceive = [&](Nz::ENetPacketFlags flags)
+	{
+		for (std::size_t i = 0; i < PacketCount; ++i)
+			serverPeer->Send(0, flags, Nz::NetPacket(NetCode, payload.data(), payload.size()));
+
+		client.Flush();
+
+		std::size_t receivedCount = 0;
+		for (std::size_t i = 0; i < 10'000 && receivedCount < PacketCount; ++i)
+		{
+			Nz::ENetEvent clientEvent;
+			client.Service(&clientEvent, 0);
+
+			Nz::ENetEvent serverEvent;
+			if (server.Service(&serverEvent, 1) > 0 && serverEvent.type == Nz::ENetEventType::Receive)
+			{
+				receivedCount++;
+
+				while (server.CheckEvents(&serverEvent))
+				{
+					if (serverEvent.type == Nz::ENetEventType::Receive)
+						receivedCount++;
+				}
+			}
+		}
+
+		return receivedCount;
+	};
+
+	BENCHMARK("Send and receive 100 reliable packets of 512B")
+	{
+		return SendAndReceive(Nz::ENetPacketFlag_Reliable);
+	};
+
+	BENCHMARK("Send and receive 100 unreliable packets of 512B")
+	{
+		return SendAndReceive(Nz::ENetPacketFlag_Unreliable);
+	};
+}
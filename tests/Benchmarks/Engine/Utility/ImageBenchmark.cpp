@@ -0,0 +1,29 @@
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Utility/Image.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+std::filesystem::path GetAssetDir();
+
+TEST_CASE("Image loading", "[UTILITY][IMAGE][!benchmark]")
+{
+	std::optional<std::vector<Nz::UInt8>> pngContent = Nz::File::ReadWhole(GetAssetDir() / "Logo.png");
+	REQUIRE(pngContent);
+
+	std::optional<std::vector<Nz::UInt8>> jpgContent = Nz::File::ReadWhole(GetAssetDir() / "Utility/stars-background.jpg");
+	REQUIRE(jpgContent);
+
+	// Decode from memory to keep disk accesses out of the measurements
+	BENCHMARK("Decode Logo.png")
+	{
+		return Nz::Image::LoadFromMemory(pngContent->data(), pngContent->size());
+	};
+
+	BENCHMARK("Decode stars-background.jpg")
+	{
+		return Nz::Image::LoadFromMemory(jpgContent->data(), jpgContent->size());
+	};
+}
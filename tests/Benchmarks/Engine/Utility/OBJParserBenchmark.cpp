@@ -0,0 +1,57 @@
+#include <Nazara/Core/MemoryView.hpp>
+#include <Nazara/Utility/Formats/OBJParser.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <string>
+
+TEST_CASE("OBJ parsing", "[UTILITY][OBJPARSER][!benchmark]")
+{
+	// Generate a grid mesh so the benchmark doesn't depend on the asset repository
+	constexpr std::size_t GridSize = 100;
+
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<float> heightDis(-1.f, 1.f);
+
+	std::string objContent = "o Grid\n";
+	for (std::size_t y = 0; y < GridSize; ++y)
+	{
+		for (std::size_t x = 0; x < GridSize; ++x)
+		{
+			objContent += "v " + std::to_string(float(x)) + ' ' + std::to_string(heightDis(rng)) + ' ' + std::to_string(float(y)) + '\n';
+			objContent += "vt " + std::to_string(float(x) / GridSize) + ' ' + std::to_string(float(y) / GridSize) + '\n';
+			objContent += "vn 0.0 1.0 0.0\n";
+		}
+	}
+
+	objContent += "usemtl Default\n";
+	for (std::size_t y = 0; y + 1 < GridSize; ++y)
+	{
+		for (std::size_t x = 0; x + 1 < GridSize; ++x)
+		{
+			std::size_t i0 = y * GridSize + x + 1;
+			std::size_t i1 = i0 + 1;
+			std::size_t i2 = i0 + GridSize;
+			std::size_t i3 = i2 + 1;
+
+			auto Vertex = [](std::size_t index)
+			{
+				std::string indexStr = std::to_string(index);
+				return indexStr + '/' + indexStr + '/' + indexStr;
+			};
+
+			objContent += "f " + Vertex(i0) + ' ' + Vertex(i2) + ' ' + Vertex(i3) + ' ' + Vertex(i1) + '\n';
+		}
+	}
+
+	BENCHMARK("Parse a 100x100 grid")
+	{
+		Nz::MemoryView stream(objContent.data(), objContent.size());
+
+		Nz::OBJParser parser;
+		if (!parser.Parse(stream))
+			return std::size_t(0);
+
+		return parser.GetPositionCount();
+	};
+}
@@ -0,0 +1,36 @@
+#include <Nazara/Utility/PixelFormat.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <vector>
+
+TEST_CASE("Pixel format conversion", "[UTILITY][PIXELFORMAT][!benchmark]")
+{
+	constexpr std::size_t PixelCount = 512 * 512;
+
+	std::mt19937 rng(42);
+	std::uniform_int_distribution<unsigned int> byteDis(0, 255);
+
+	std::vector<Nz::UInt8> rgba8(PixelCount * 4);
+	for (Nz::UInt8& byte : rgba8)
+		byte = static_cast<Nz::UInt8>(byteDis(rng));
+
+	std::vector<Nz::UInt8> rgb8(PixelCount * 3);
+	std::vector<Nz::UInt8> bgra8(PixelCount * 4);
+	std::vector<float> rgba32f(PixelCount * 4);
+
+	BENCHMARK("RGBA8 to BGRA8 (512x512)")
+	{
+		return Nz::PixelFormatInfo::Convert(Nz::PixelFormat::RGBA8, Nz::PixelFormat::BGRA8, rgba8.data(), rgba8.data() + rgba8.size(), bgra8.data());
+	};
+
+	BENCHMARK("RGBA8 to RGB8 (512x512)")
+	{
+		return Nz::PixelFormatInfo::Convert(Nz::PixelFormat::RGBA8, Nz::PixelFormat::RGB8, rgba8.data(), rgba8.data() + rgba8.size(), rgb8.data());
+	};
+
+	BENCHMARK("RGBA8 to RGBA32F (512x512)")
+	{
+		return Nz::PixelFormatInfo::Convert(Nz::PixelFormat::RGBA8, Nz::PixelFormat::RGBA32F, rgba8.data(), rgba8.data() + rgba8.size(), rgba32f.data());
+	};
+}
@@ -0,0 +1,31 @@
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_session.hpp>
+
+#include <Nazara/Core/Modules.hpp>
+#include <Nazara/Network/Network.hpp>
+#include <Nazara/Utility/Utility.hpp>
+#include <filesystem>
+
+// Benchmarks use fixed seeds and datasets so results can be compared between runs
+// Run with "--reporter JSON::out=benchmarks.json" to get machine-readable results
+
+std::filesystem::path GetAssetDir()
+{
+	static std::filesystem::path resourceDir = []
+	{
+		std::filesystem::path dir = "assets";
+		if (!std::filesystem::is_directory(dir) && std::filesystem::is_directory("../.." / dir))
+			dir = "../.." / dir;
+
+		return dir / "unittests";
+	}();
+
+	return resourceDir;
+}
+
+int main(int argc, char* argv[])
+{
+	Nz::Modules<Nz::Network, Nz::Utility> nazara;
+
+	return Catch::Session().run(argc, argv);
+}
@@ -0,0 +1,9 @@
+add_requires("catch2 >=3.x")
+
+target("Benchmarks", function ()
+	set_kind("binary")
+	add_deps("NazaraCore", "NazaraNetwork", "NazaraUtility")
+	add_packages("catch2")
+	add_files("main.cpp")
+	add_files("Engine/**.cpp")
+end)
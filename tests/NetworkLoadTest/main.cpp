@@ -0,0 +1,581 @@
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/CommandLineParameters.hpp>
+#include <Nazara/Core/Modules.hpp>
+#include <Nazara/Core/StringExt.hpp>
+#include <Nazara/Core/ThreadExt.hpp>
+#include <Nazara/Network/ENetHost.hpp>
+#include <Nazara/Network/ENetPeer.hpp>
+#include <Nazara/Network/Network.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Drives a local ENet server with many simulated clients spread over several threads, to know how many players a machine supports
+//
+// NetworkLoadTest [--clients=N] [--threads=N] [--duration=seconds] [--send-rate=Hz] [--packet-size=bytes] [--reliable=percent]
+//                 [--tick-rate=Hz] [--snapshot-size=bytes] [--loss=percent] [--min-delay=ms] [--max-delay=ms]
+//
+// Every client sends timestamped packets at a fixed rate, which the server echoes back (giving the RTT distribution),
+// the server can also broadcast a snapshot to every client at each tick like a game server would.
+
+namespace
+{
+	// Allocations are counted per thread by the global operator new replacement below
+	// On Windows, with shared libraries, allocations made from inside the Nazara DLLs use their own CRT and are not counted
+	thread_local Nz::UInt64 s_allocationCount = 0;
+	thread_local Nz::UInt64 s_allocatedBytes = 0;
+
+	// Network codes are not transmitted by ENet, traffic kinds are told apart by their channel
+	constexpr Nz::UInt8 EchoChannel = 0;
+	constexpr Nz::UInt8 SnapshotChannel = 1;
+	constexpr std::size_t ChannelCount = 2;
+
+	enum class Phase
+	{
+		Connecting,
+		Measuring,
+		Draining, //< no more traffic is generated but in-flight echoes are still received
+		Done
+	};
+
+	struct Config
+	{
+		std::size_t clientCount = 1000;
+		std::size_t packetSize = 64;
+		std::size_t snapshotSize = 0;
+		std::size_t threadCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+		double packetLoss = 0.0;
+		double reliableRatio = 0.25;
+		Nz::Int64 durationSeconds = 10;
+		Nz::Int64 sendRate = 20;
+		Nz::Int64 tickRate = 20;
+		Nz::UInt16 maxDelay = 0;
+		Nz::UInt16 minDelay = 0;
+	};
+
+	struct SharedState
+	{
+		std::atomic<Phase> phase{ Phase::Connecting };
+		std::atomic<std::size_t> connectedClients{ 0 };
+		std::atomic<std::size_t> failedClients{ 0 };
+	};
+
+	struct ThreadStats
+	{
+		std::vector<Nz::Int64> roundTripTimes; //< microseconds
+		Nz::Time busyTime = Nz::Time::Zero();
+		Nz::UInt64 allocatedBytes = 0;
+		Nz::UInt64 allocationCount = 0;
+		Nz::UInt64 receivedBytes = 0;
+		Nz::UInt64 receivedPackets = 0;
+		Nz::UInt64 reliableReceived = 0;
+		Nz::UInt64 reliableSent = 0;
+		Nz::UInt64 sentBytes = 0;
+		Nz::UInt64 sentPackets = 0;
+		Nz::UInt64 unreliableReceived = 0;
+		Nz::UInt64 unreliableSent = 0;
+		std::size_t lostConnections = 0;
+	};
+
+	// Tracks the measured part of a thread loop: busy time (everything but sleeping) and allocations
+	class PhaseTracker
+	{
+		public:
+			PhaseTracker(ThreadStats& stats) :
+			m_stats(stats),
+			m_measuring(false)
+			{
+			}
+
+			// Returns true when the measure starts
+			bool Update(Phase phase)
+			{
+				bool measuring = (phase == Phase::Measuring);
+				if (measuring == m_measuring)
+					return false;
+
+				m_measuring = measuring;
+				if (measuring)
+				{
+					m_allocationStart = s_allocationCount;
+					m_allocatedBytesStart = s_allocatedBytes;
+					return true;
+				}
+				else
+				{
+					m_stats.allocationCount += s_allocationCount - m_allocationStart;
+					m_stats.allocatedBytes += s_allocatedBytes - m_allocatedBytesStart;
+					return false;
+				}
+			}
+
+			void Sleep(Nz::Time loopStart)
+			{
+				if (m_measuring)
+					m_stats.busyTime += Nz::HighPrecisionClock::Now() - loopStart;
+
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+
+			bool IsMeasuring() const
+			{
+				return m_measuring;
+			}
+
+		private:
+			ThreadStats& m_stats;
+			Nz::UInt64 m_allocatedBytesStart;
+			Nz::UInt64 m_allocationStart;
+			bool m_measuring;
+	};
+
+	template<typename T>
+	bool ParseNumber(const Nz::CommandLineParameters& params, const std::string& name, T minValue, T maxValue, T* value)
+	{
+		std::string_view str;
+		if (!params.GetParameter(name, &str))
+			return true;
+
+		bool ok;
+		long long number = Nz::StringToNumber(str, 10, &ok);
+		if (!ok || number < static_cast<long long>(minValue) || number > static_cast<long long>(maxValue))
+		{
+			std::cerr << "invalid value for --" << name << ": " << str << " (expected a number between " << minValue << " and " << maxValue << ")" << std::endl;
+			return false;
+		}
+
+		*value = static_cast<T>(number);
+		return true;
+	}
+
+	bool ParseConfig(const Nz::CommandLineParameters& params, Config& config)
+	{
+		long long lossPercent = 0;
+		long long reliablePercent = 25;
+
+		bool ok = true;
+		ok &= ParseNumber<std::size_t>(params, "clients", 1, Nz::ENetConstants::ENetProtocol_MaximumPeerId, &config.clientCount);
+		ok &= ParseNumber<std::size_t>(params, "threads", 1, 256, &config.threadCount);
+		ok &= ParseNumber<Nz::Int64>(params, "duration", 1, 3600, &config.durationSeconds);
+		ok &= ParseNumber<Nz::Int64>(params, "send-rate", 1, 1000, &config.sendRate);
+		ok &= ParseNumber<std::size_t>(params, "packet-size", sizeof(Nz::Int64), 64 * 1024, &config.packetSize);
+		ok &= ParseNumber<long long>(params, "reliable", 0, 100, &reliablePercent);
+		ok &= ParseNumber<Nz::Int64>(params, "tick-rate", 1, 1000, &config.tickRate);
+		ok &= ParseNumber<std::size_t>(params, "snapshot-size", 0, 64 * 1024, &config.snapshotSize);
+		ok &= ParseNumber<long long>(params, "loss", 0, 100, &lossPercent);
+		ok &= ParseNumber<Nz::UInt16>(params, "min-delay", 0, 10'000, &config.minDelay);
+		ok &= ParseNumber<Nz::UInt16>(params, "max-delay", 0, 10'000, &config.maxDelay);
+		if (!ok)
+			return false;
+
+		if (config.maxDelay < config.minDelay)
+		{
+			std::cerr << "--max-delay cannot be lower than --min-delay" << std::endl;
+			return false;
+		}
+
+		config.packetLoss = lossPercent / 100.0;
+		config.reliableRatio = reliablePercent / 100.0;
+		config.threadCount = std::min(config.threadCount, config.clientCount);
+
+		return true;
+	}
+
+	template<typename F>
+	void PollEvents(Nz::ENetHost& host, F&& eventHandler)
+	{
+		Nz::ENetEvent event;
+		if (host.Service(&event, 0) > 0)
+		{
+			do
+			{
+				eventHandler(event);
+			}
+			while (host.CheckEvents(&event));
+		}
+	}
+
+	void RunServer(const Config& config, SharedState& sharedState, Nz::ENetHost& server, ThreadStats& stats)
+	{
+		Nz::SetCurrentThreadName("LoadTest server");
+
+		std::vector<Nz::UInt8> snapshot(config.snapshotSize, 0);
+		Nz::Time tickInterval = Nz::Time::TickDuration(config.tickRate);
+		Nz::Time nextTick = Nz::HighPrecisionClock::Now();
+		std::size_t connectedPeers = 0;
+
+		PhaseTracker tracker(stats);
+		for (;;)
+		{
+			Phase phase = sharedState.phase.load(std::memory_order_acquire);
+			if (phase == Phase::Done)
+				break;
+
+			Nz::Time loopStart = Nz::HighPrecisionClock::Now();
+			tracker.Update(phase);
+
+			PollEvents(server, [&](Nz::ENetEvent& event)
+			{
+				switch (event.type)
+				{
+					case Nz::ENetEventType::IncomingConnect:
+						connectedPeers++;
+						break;
+
+					case Nz::ENetEventType::Disconnect:
+					case Nz::ENetEventType::DisconnectTimeout:
+						connectedPeers--;
+						break;
+
+					case Nz::ENetEventType::Receive:
+					{
+						std::size_t size = event.packet->data.GetDataSize();
+						if (tracker.IsMeasuring())
+						{
+							stats.receivedBytes += size;
+							stats.receivedPackets++;
+						}
+
+						// Echo the packet as-is (same flags), without copying it
+						if (event.channelId == EchoChannel && event.peer->Send(EchoChannel, event.packet) && tracker.IsMeasuring())
+						{
+							stats.sentBytes += size;
+							stats.sentPackets++;
+						}
+						break;
+					}
+
+					case Nz::ENetEventType::None:
+					case Nz::ENetEventType::OutgoingConnect:
+						break;
+				}
+			});
+
+			if (!snapshot.empty() && phase == Phase::Measuring && loopStart >= nextTick)
+			{
+				server.Broadcast(SnapshotChannel, Nz::ENetPacketFlag_Unreliable, Nz::NetPacket(0, snapshot.data(), snapshot.size()));
+				stats.sentBytes += snapshot.size() * connectedPeers;
+				stats.sentPackets += connectedPeers;
+
+				nextTick += tickInterval;
+				if (nextTick < loopStart)
+					nextTick = loopStart + tickInterval; //< don't try to catch up missed ticks
+			}
+			else if (phase != Phase::Measuring)
+				nextTick = loopStart;
+
+			tracker.Sleep(loopStart);
+		}
+	}
+
+	void RunClients(const Config& config, SharedState& sharedState, const Nz::IpAddress& serverAddress, std::size_t threadIndex, std::size_t clientCount, ThreadStats& stats)
+	{
+		Nz::SetCurrentThreadName(("LoadTest clients #" + std::to_string(threadIndex)).c_str());
+
+		struct Client
+		{
+			Nz::ENetPeer* peer;
+			Nz::Time nextSendTime;
+			bool connected = false;
+		};
+
+		Nz::ENetHost host;
+		if (!host.Create(Nz::NetProtocol::IPv4, 0, clientCount, ChannelCount))
+		{
+			std::cerr << "failed to create client host #" << threadIndex << std::endl;
+			sharedState.failedClients += clientCount;
+			return;
+		}
+
+		if (config.packetLoss > 0.0 || config.maxDelay > 0)
+			host.SimulateNetwork(config.packetLoss, config.minDelay, config.maxDelay);
+
+		// Peers are allocated in order, so their peer id is also their index
+		std::vector<Client> clients(clientCount);
+		for (Client& client : clients)
+		{
+			client.peer = host.Connect(serverAddress, ChannelCount);
+			if (!client.peer)
+				sharedState.failedClients++;
+		}
+
+		std::mt19937 rng(static_cast<std::mt19937::result_type>(threadIndex));
+		std::bernoulli_distribution reliableDis(config.reliableRatio);
+
+		Nz::Time sendInterval = Nz::Time::TickDuration(config.sendRate);
+		std::uniform_int_distribution<Nz::Int64> sendOffsetDis(0, sendInterval.AsMicroseconds());
+
+		std::vector<Nz::UInt8> payload(config.packetSize, 0);
+
+		PhaseTracker tracker(stats);
+		for (;;)
+		{
+			Phase phase = sharedState.phase.load(std::memory_order_acquire);
+			if (phase == Phase::Done)
+				break;
+
+			Nz::Time loopStart = Nz::HighPrecisionClock::Now();
+			if (tracker.Update(phase))
+			{
+				// Spread clients over the send interval instead of having them all send at once
+				for (Client& client : clients)
+					client.nextSendTime = loopStart + Nz::Time::Microseconds(sendOffsetDis(rng));
+			}
+
+			if (phase == Phase::Measuring)
+			{
+				for (Client& client : clients)
+				{
+					if (!client.connected || client.nextSendTime > loopStart)
+						continue;
+
+					Nz::Int64 sendTime = loopStart.AsMicroseconds();
+					std::memcpy(payload.data(), &sendTime, sizeof(sendTime));
+
+					bool reliable = reliableDis(rng);
+					if (client.peer->Send(EchoChannel, (reliable) ? Nz::ENetPacketFlag_Reliable : Nz::ENetPacketFlag_Unreliable, Nz::NetPacket(0, payload.data(), payload.size())))
+					{
+						stats.sentBytes += payload.size();
+						stats.sentPackets++;
+						if (reliable)
+							stats.reliableSent++;
+						else
+							stats.unreliableSent++;
+					}
+
+					client.nextSendTime += sendInterval;
+					if (client.nextSendTime <= loopStart)
+						client.nextSendTime = loopStart + sendInterval; //< thread is overloaded, don't burst to catch up
+				}
+			}
+
+			PollEvents(host, [&](Nz::ENetEvent& event)
+			{
+				Client& client = clients[event.peer->GetPeerId()];
+				switch (event.type)
+				{
+					case Nz::ENetEventType::OutgoingConnect:
+						client.connected = true;
+						sharedState.connectedClients++;
+						break;
+
+					case Nz::ENetEventType::Disconnect:
+					case Nz::ENetEventType::DisconnectTimeout:
+						if (client.connected)
+						{
+							client.connected = false;
+							stats.lostConnections++;
+						}
+						else
+							sharedState.failedClients++;
+						break;
+
+					case Nz::ENetEventType::Receive:
+					{
+						if (phase == Phase::Connecting)
+							break;
+
+						std::size_t size = event.packet->data.GetDataSize();
+						stats.receivedBytes += size;
+						stats.receivedPackets++;
+
+						if (event.channelId == EchoChannel && size >= sizeof(Nz::Int64))
+						{
+							Nz::Int64 sendTime;
+							std::memcpy(&sendTime, event.packet->data.GetConstData() + Nz::NetPacket::HeaderSize, sizeof(sendTime));
+							stats.roundTripTimes.push_back(Nz::HighPrecisionClock::Now().AsMicroseconds() - sendTime);
+
+							if (event.packet->flags.Test(Nz::ENetPacketFlag_Reliable))
+								stats.reliableReceived++;
+							else
+								stats.unreliableReceived++;
+						}
+						break;
+					}
+
+					case Nz::ENetEventType::None:
+					case Nz::ENetEventType::IncomingConnect:
+						break;
+				}
+			});
+
+			tracker.Sleep(loopStart);
+		}
+
+		for (Client& client : clients)
+		{
+			if (client.connected)
+				client.peer->DisconnectNow(0);
+		}
+	}
+
+	double Percentile(const std::vector<Nz::Int64>& sortedValues, double percentile)
+	{
+		if (sortedValues.empty())
+			return 0.0;
+
+		std::size_t index = static_cast<std::size_t>(percentile / 100.0 * (sortedValues.size() - 1) + 0.5);
+		return sortedValues[index] / 1000.0;
+	}
+
+	double Ratio(double value, double total)
+	{
+		return (total > 0.0) ? value / total : 0.0;
+	}
+
+	void PrintReport(const Config& config, std::size_t connectedClients, Nz::Time connectionTime, const ThreadStats& serverStats, const std::vector<ThreadStats>& clientStats)
+	{
+		ThreadStats clients;
+		for (const ThreadStats& stats : clientStats)
+		{
+			clients.roundTripTimes.insert(clients.roundTripTimes.end(), stats.roundTripTimes.begin(), stats.roundTripTimes.end());
+			clients.busyTime += stats.busyTime;
+			clients.allocatedBytes += stats.allocatedBytes;
+			clients.allocationCount += stats.allocationCount;
+			clients.receivedBytes += stats.receivedBytes;
+			clients.receivedPackets += stats.receivedPackets;
+			clients.reliableReceived += stats.reliableReceived;
+			clients.reliableSent += stats.reliableSent;
+			clients.sentBytes += stats.sentBytes;
+			clients.sentPackets += stats.sentPackets;
+			clients.unreliableReceived += stats.unreliableReceived;
+			clients.unreliableSent += stats.unreliableSent;
+			clients.lostConnections += stats.lostConnections;
+		}
+
+		std::sort(clients.roundTripTimes.begin(), clients.roundTripTimes.end());
+
+		double duration = static_cast<double>(config.durationSeconds);
+		double peerSeconds = connectedClients * duration;
+		constexpr double MiB = 1024.0 * 1024.0;
+
+		std::cout << "== Configuration\n";
+		std::cout << "clients: " << config.clientCount << " over " << config.threadCount << " thread(s), " << config.sendRate << " packets/s of " << config.packetSize << "B each (" << config.reliableRatio * 100.0 << "% reliable)\n";
+		std::cout << "server: echo";
+		if (config.snapshotSize > 0)
+			std::cout << " + " << config.snapshotSize << "B snapshots at " << config.tickRate << "Hz";
+		std::cout << "\n";
+		std::cout << "simulated network: " << config.packetLoss * 100.0 << "% loss, " << config.minDelay << "-" << config.maxDelay << "ms delay\n";
+		std::cout << "duration: " << config.durationSeconds << "s\n";
+
+		std::cout << "\n== Connections\n";
+		std::cout << "connected: " << connectedClients << "/" << config.clientCount << " in " << connectionTime.AsMilliseconds() << "ms\n";
+		std::cout << "lost during test: " << clients.lostConnections << "\n";
+
+		std::cout << "\n== Throughput (server)\n";
+		std::cout << "received: " << serverStats.receivedPackets / duration << " packets/s, " << serverStats.receivedBytes / duration / MiB << " MiB/s\n";
+		std::cout << "sent: " << serverStats.sentPackets / duration << " packets/s, " << serverStats.sentBytes / duration / MiB << " MiB/s\n";
+
+		std::cout << "\n== Echo round-trip time (" << clients.roundTripTimes.size() << " samples)\n";
+		if (!clients.roundTripTimes.empty())
+		{
+			std::cout << "min: " << clients.roundTripTimes.front() / 1000.0 << "ms, p50: " << Percentile(clients.roundTripTimes, 50.0) << "ms, p95: " << Percentile(clients.roundTripTimes, 95.0) << "ms, p99: " << Percentile(clients.roundTripTimes, 99.0) << "ms, max: " << clients.roundTripTimes.back() / 1000.0 << "ms\n";
+		}
+		std::cout << "reliable echoes: " << clients.reliableReceived << "/" << clients.reliableSent << "\n";
+		std::cout << "unreliable echoes: " << clients.unreliableReceived << "/" << clients.unreliableSent << " (" << (1.0 - Ratio(clients.unreliableReceived, clients.unreliableSent)) * 100.0 << "% lost)\n";
+
+		std::cout << "\n== CPU (busy time, excluding sleep)\n";
+		std::cout << "server thread: " << Ratio(serverStats.busyTime.AsSeconds<double>(), duration) * 100.0 << "% of a core, " << Ratio(serverStats.busyTime.AsMicroseconds(), peerSeconds) << "us per peer per second\n";
+		std::cout << "client threads: " << Ratio(clients.busyTime.AsSeconds<double>(), duration * config.threadCount) * 100.0 << "% of " << config.threadCount << " core(s) (load generator, should stay well under 100%)\n";
+
+		std::cout << "\n== Allocations\n";
+		std::cout << "server thread: " << serverStats.allocationCount / duration << " allocations/s (" << Ratio(serverStats.allocationCount, peerSeconds) << " per peer per second), " << serverStats.allocatedBytes / duration / MiB << " MiB/s\n";
+		std::cout << "client threads: " << clients.allocationCount / duration << " allocations/s, " << clients.allocatedBytes / duration / MiB << " MiB/s\n";
+		std::cout << std::flush;
+	}
+}
+
+void* operator new(std::size_t size)
+{
+	s_allocationCount++;
+	s_allocatedBytes += size;
+
+	if (void* ptr = std::malloc((size > 0) ? size : 1))
+		return ptr;
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept
+{
+	std::free(ptr);
+}
+
+int main(int argc, char* argv[])
+{
+	Nz::CommandLineParameters params = Nz::CommandLineParameters::Parse(argc, argv);
+
+	Config config;
+	if (!ParseConfig(params, config))
+		return EXIT_FAILURE;
+
+	Nz::Modules<Nz::Network> nazara;
+
+	Nz::ENetHost server;
+	if (!server.Create(Nz::IpAddress::LoopbackIpV4, config.clientCount, ChannelCount))
+	{
+		std::cerr << "failed to create server host" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (config.packetLoss > 0.0 || config.maxDelay > 0)
+		server.SimulateNetwork(config.packetLoss, config.minDelay, config.maxDelay);
+
+	Nz::IpAddress serverAddress = server.GetBoundAddress();
+
+	SharedState sharedState;
+
+	ThreadStats serverStats;
+	std::thread serverThread(RunServer, std::cref(config), std::ref(sharedState), std::ref(server), std::ref(serverStats));
+
+	std::vector<ThreadStats> clientStats(config.threadCount);
+	std::vector<std::thread> clientThreads;
+	clientThreads.reserve(config.threadCount);
+	for (std::size_t i = 0; i < config.threadCount; ++i)
+	{
+		std::size_t clientCount = config.clientCount / config.threadCount + ((i < config.clientCount % config.threadCount) ? 1 : 0);
+		clientThreads.emplace_back(RunClients, std::cref(config), std::ref(sharedState), std::cref(serverAddress), i, clientCount, std::ref(clientStats[i]));
+	}
+
+	std::cout << "connecting " << config.clientCount << " clients to " << serverAddress << "..." << std::endl;
+
+	Nz::HighPrecisionClock connectionClock;
+	while (sharedState.connectedClients + sharedState.failedClients < config.clientCount && connectionClock.GetElapsedTime() < Nz::Time::Seconds(30))
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+	Nz::Time connectionTime = connectionClock.GetElapsedTime();
+	std::size_t connectedClients = sharedState.connectedClients;
+
+	std::cout << "measuring for " << config.durationSeconds << "s..." << std::endl;
+
+	sharedState.phase = Phase::Measuring;
+	std::this_thread::sleep_for(std::chrono::seconds(config.durationSeconds));
+
+	// Give in-flight echoes (and retransmissions) some time to come back
+	sharedState.phase = Phase::Draining;
+	std::this_thread::sleep_for(std::chrono::milliseconds(1000 + 2 * config.maxDelay));
+
+	sharedState.phase = Phase::Done;
+	for (std::thread& thread : clientThreads)
+		thread.join();
+
+	serverThread.join();
+
+	std::cout << std::endl;
+	PrintReport(config, connectedClients, connectionTime, serverStats, clientStats);
+
+	return EXIT_SUCCESS;
+}
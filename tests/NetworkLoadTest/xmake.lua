@@ -0,0 +1,3 @@
+target("NetworkLoadTest")
+	add_deps("NazaraNetwork")
+	add_files("main.cpp")
@@ -2,7 +2,9 @@
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
 #include <array>
+#include <vector>
 
 TEST_CASE("MixToMono", "[AUDIO][ALGORITHM]")
 {
@@ -18,3 +20,80 @@ TEST_CASE("MixToMono", "[AUDIO][ALGORITHM]")
 		CHECK(output == theoric);
 	}
 }
+
+TEST_CASE("MixToMono Int16", "[AUDIO][ALGORITHM]")
+{
+	// Enough frames to go through the vectorized path and the remainder
+	std::vector<Nz::Int16> input;
+	for (int i = 0; i < 37; ++i)
+	{
+		input.push_back(static_cast<Nz::Int16>(i * 997 - 18000));
+		input.push_back(static_cast<Nz::Int16>(-i * 613 + 5001));
+	}
+
+	std::vector<Nz::Int16> output(input.size() / 2);
+	Nz::MixToMono(input.data(), output.data(), 2, output.size());
+
+	for (std::size_t i = 0; i < output.size(); ++i)
+		CHECK(output[i] == static_cast<Nz::Int16>((int(input[i * 2]) + int(input[i * 2 + 1])) / 2));
+
+	SECTION("In place")
+	{
+		std::vector<Nz::Int16> inPlace = input;
+		Nz::MixToMono(inPlace.data(), inPlace.data(), 2, output.size());
+
+		CHECK(std::equal(output.begin(), output.end(), inPlace.begin()));
+	}
+}
+
+TEST_CASE("ConvertSamples", "[AUDIO][ALGORITHM]")
+{
+	SECTION("Float to Int16 and back")
+	{
+		std::array<float, 11> input = { { -2.f, -1.f, -0.5f, -0.25f, 0.f, 0.25f, 0.5f, 0.75f, 1.f, 2.f, 0.1f } };
+		std::array<Nz::Int16, 11> output;
+		Nz::ConvertSamples(input.data(), output.data(), input.size());
+
+		std::array<Nz::Int16, 11> expected = { { -32768, -32768, -16384, -8192, 0, 8192, 16384, 24576, 32767, 32767, 3277 } };
+		CHECK(output == expected);
+
+		std::array<float, 11> floats;
+		Nz::ConvertSamples(output.data(), floats.data(), output.size());
+		for (std::size_t i = 0; i < floats.size(); ++i)
+			CHECK(floats[i] == Catch::Approx(std::clamp(input[i], -1.f, 1.f)).margin(1.0 / 32768.0));
+	}
+
+	SECTION("Planar 24 bits to interleaved Int16")
+	{
+		std::vector<Nz::Int32> left;
+		std::vector<Nz::Int32> right;
+		for (int i = 0; i < 19; ++i)
+		{
+			left.push_back(i * 65536 - 8388608);
+			right.push_back(8388607 - i * 300000);
+		}
+
+		const Nz::Int32* channels[] = { left.data(), right.data() };
+
+		std::vector<Nz::Int16> output(left.size() * 2);
+		Nz::ConvertSamples(channels, 2, 24, output.data(), left.size());
+
+		for (std::size_t i = 0; i < left.size(); ++i)
+		{
+			CHECK(output[i * 2] == static_cast<Nz::Int16>(left[i] >> 8));
+			CHECK(output[i * 2 + 1] == static_cast<Nz::Int16>(right[i] >> 8));
+		}
+	}
+
+	SECTION("Planar 8 bits to Int16")
+	{
+		std::vector<Nz::Int32> mono = { -128, -1, 0, 1, 127, 64, -64, 3, 5 };
+		const Nz::Int32* channels[] = { mono.data() };
+
+		std::vector<Nz::Int16> output(mono.size());
+		Nz::ConvertSamples(channels, 1, 8, output.data(), mono.size());
+
+		for (std::size_t i = 0; i < mono.size(); ++i)
+			CHECK(output[i] == static_cast<Nz::Int16>(mono[i] * 256));
+	}
+}
@@ -0,0 +1,108 @@
+#include <Nazara/Audio/AudioResampler.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+	std::vector<Nz::Int16> GenerateSine(double frequency, Nz::UInt32 sampleRate, Nz::UInt64 frameCount, Nz::UInt32 channelCount)
+	{
+		std::vector<Nz::Int16> samples(frameCount * channelCount);
+		for (Nz::UInt64 i = 0; i < frameCount; ++i)
+		{
+			double value = std::sin(2.0 * 3.14159265358979323846 * frequency * double(i) / sampleRate);
+			for (Nz::UInt32 j = 0; j < channelCount; ++j)
+				samples[i * channelCount + j] = static_cast<Nz::Int16>(std::lround(value * 16000.0 * (j + 1) / channelCount));
+		}
+
+		return samples;
+	}
+
+	double ComputeError(const std::vector<Nz::Int16>& lhs, const std::vector<Nz::Int16>& rhs, std::size_t begin, std::size_t end)
+	{
+		double maxError = 0.0;
+		for (std::size_t i = begin; i < end; ++i)
+			maxError = std::max(maxError, std::abs(double(lhs[i]) - double(rhs[i])));
+
+		return maxError;
+	}
+}
+
+SCENARIO("AudioResampler", "[AUDIO][AUDIORESAMPLER]")
+{
+	WHEN("Upsampling a stereo sine from 44.1kHz to 48kHz")
+	{
+		std::vector<Nz::Int16> input = GenerateSine(440.0, 44100, 44100 / 4, 2);
+		std::vector<Nz::Int16> output = Nz::AudioResampler::Resample(input.data(), input.size() / 2, 2, 44100, 48000);
+
+		THEN("We get the expected frame count and the same sine at the new rate")
+		{
+			REQUIRE(output.size() == 48000 / 4 * 2);
+
+			std::vector<Nz::Int16> expected = GenerateSine(440.0, 48000, 48000 / 4, 2);
+
+			// Skip the edges, which are affected by the silence around the signal
+			CHECK(ComputeError(output, expected, 200, output.size() - 200) < 40.0);
+		}
+	}
+
+	WHEN("Downsampling a mono sine from 48kHz to 22.05kHz")
+	{
+		std::vector<Nz::Int16> input = GenerateSine(1000.0, 48000, 48000 / 4, 1);
+		std::vector<Nz::Int16> output = Nz::AudioResampler::Resample(input.data(), input.size(), 1, 48000, 22050);
+
+		THEN("The sine is preserved")
+		{
+			REQUIRE(output.size() == (48000 / 4 * 22050 + 47999) / 48000);
+
+			std::vector<Nz::Int16> expected = GenerateSine(1000.0, 22050, output.size(), 1);
+			CHECK(ComputeError(output, expected, 100, output.size() - 100) < 40.0);
+		}
+	}
+
+	WHEN("Downsampling a tone above the output Nyquist frequency")
+	{
+		std::vector<Nz::Int16> input = GenerateSine(15000.0, 48000, 48000 / 4, 1);
+		std::vector<Nz::Int16> output = Nz::AudioResampler::Resample(input.data(), input.size(), 1, 48000, 16000);
+
+		THEN("It is filtered out instead of aliasing")
+		{
+			std::vector<Nz::Int16> silence(output.size(), 0);
+			CHECK(ComputeError(output, silence, 100, output.size() - 100) < 50.0);
+		}
+	}
+
+	WHEN("Feeding data by small chunks")
+	{
+		std::vector<Nz::Int16> input = GenerateSine(440.0, 32000, 5000, 2);
+		std::vector<Nz::Int16> reference = Nz::AudioResampler::Resample(input.data(), input.size() / 2, 2, 32000, 44100);
+
+		Nz::AudioResampler resampler(2, 32000, 44100);
+
+		std::vector<Nz::Int16> output(reference.size());
+		std::size_t outputFrame = 0;
+		for (std::size_t inputFrame = 0; inputFrame < input.size() / 2; inputFrame += 37)
+		{
+			std::size_t chunkSize = std::min<std::size_t>(37, input.size() / 2 - inputFrame);
+
+			// Use a small output buffer too, pending frames are returned by the next calls
+			outputFrame += resampler.Process(&input[inputFrame * 2], chunkSize, output.data() + outputFrame * 2, std::min<std::size_t>(40, output.size() / 2 - outputFrame));
+		}
+
+		while (outputFrame < output.size() / 2)
+		{
+			Nz::UInt64 written = resampler.Flush(output.data() + outputFrame * 2, output.size() / 2 - outputFrame);
+			if (written == 0)
+				break;
+
+			outputFrame += written;
+		}
+
+		THEN("We get the same result as a one-shot resampling")
+		{
+			CHECK(outputFrame == reference.size() / 2);
+			CHECK(output == reference);
+		}
+	}
+}
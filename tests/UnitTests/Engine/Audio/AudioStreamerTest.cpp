@@ -0,0 +1,81 @@
+#include <Nazara/Audio/AudioStreamer.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+SCENARIO("AudioStreamer", "[AUDIO][AUDIOSTREAMER]")
+{
+	using namespace Nz::Literals;
+
+	GIVEN("An audio streamer")
+	{
+		// Declared first so the streamer (and its callbacks) are destroyed before them
+		std::atomic_uint urgentUpdateCount = 0;
+		std::atomic_uint relaxedUpdateCount = 0;
+		std::atomic_uint updateCount = 0;
+
+		Nz::AudioStreamer streamer;
+
+		WHEN("We register streams with different deadlines")
+		{
+			std::size_t urgentStream = streamer.RegisterStream([&]() -> std::optional<Nz::Time>
+			{
+				urgentUpdateCount++;
+				return 20_ms;
+			}, 10_ms);
+
+			std::size_t relaxedStream = streamer.RegisterStream([&]() -> std::optional<Nz::Time>
+			{
+				relaxedUpdateCount++;
+				return 10_s;
+			}, 10_ms);
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+			THEN("Streams are updated when they get close to their deadline")
+			{
+				CHECK(urgentUpdateCount > 2);
+				CHECK(relaxedUpdateCount == 1);
+			}
+
+			AND_THEN("Streams can request an update ahead of their deadline")
+			{
+				streamer.RequestUpdate(relaxedStream);
+				std::this_thread::sleep_for(std::chrono::milliseconds(50));
+				CHECK(relaxedUpdateCount == 2);
+			}
+
+			AND_THEN("Unregistered streams aren't updated anymore")
+			{
+				streamer.UnregisterStream(urgentStream);
+				streamer.UnregisterStream(relaxedStream);
+
+				unsigned int lastUpdateCount = urgentUpdateCount;
+				std::this_thread::sleep_for(std::chrono::milliseconds(50));
+				CHECK(urgentUpdateCount == lastUpdateCount);
+			}
+		}
+
+		WHEN("A stream reports it has ended")
+		{
+			std::size_t streamId = streamer.RegisterStream([&]() -> std::optional<Nz::Time>
+			{
+				if (++updateCount == 3)
+					return std::nullopt;
+
+				return 0_ms;
+			}, 0_ms);
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+			THEN("It's unregistered")
+			{
+				CHECK(updateCount == 3);
+
+				// unregistering it again does nothing
+				streamer.UnregisterStream(streamId);
+			}
+		}
+	}
+}
@@ -0,0 +1,89 @@
+#include <Nazara/Audio/Sound.hpp>
+#include <Nazara/Audio/Components/SoundEmitterComponent.hpp>
+#include <Nazara/Audio/Systems/AudioSystem.hpp>
+#include <Nazara/Utility/Components/NodeComponent.hpp>
+#include <Nazara/Utility/Components/VelocityComponent.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <entt/entt.hpp>
+
+SCENARIO("AudioSystem", "[AUDIO][AUDIOSYSTEM]")
+{
+	using namespace Nz::Literals;
+
+	GIVEN("An audio system and an entity emitting a sound")
+	{
+		entt::registry registry;
+		Nz::AudioSystem audioSystem(registry);
+
+		std::shared_ptr<Nz::Sound> sound = std::make_shared<Nz::Sound>();
+
+		entt::entity entity = registry.create();
+		Nz::NodeComponent& entityNode = registry.emplace<Nz::NodeComponent>(entity);
+		entityNode.SetPosition(Nz::Vector3f(1.f, 2.f, 3.f));
+
+		Nz::SoundEmitterComponent& entityEmitters = registry.emplace<Nz::SoundEmitterComponent>(entity);
+		entityEmitters.AttachEmitter(sound);
+
+		audioSystem.Update(16_ms);
+
+		THEN("The emitter follows the entity")
+		{
+			CHECK(sound->GetPosition() == Nz::Vector3f(1.f, 2.f, 3.f));
+			CHECK(sound->GetVelocity() == Nz::Vector3f::Zero());
+		}
+
+		WHEN("The entity moves")
+		{
+			registry.get<Nz::NodeComponent>(entity).Move(Nz::Vector3f::UnitX());
+			audioSystem.Update(16_ms);
+
+			THEN("The emitter is moved with it")
+			{
+				CHECK(sound->GetPosition() == Nz::Vector3f(2.f, 2.f, 3.f));
+			}
+		}
+
+		WHEN("The emitter is moved by hand while the entity doesn't move")
+		{
+			sound->SetPosition(Nz::Vector3f::Zero());
+			audioSystem.Update(16_ms);
+
+			THEN("It isn't updated again")
+			{
+				CHECK(sound->GetPosition() == Nz::Vector3f::Zero());
+			}
+		}
+
+		WHEN("The entity has a velocity")
+		{
+			registry.emplace<Nz::VelocityComponent>(entity, Nz::Vector3f::UnitZ() * 10.f);
+			registry.get<Nz::NodeComponent>(entity).Move(Nz::Vector3f::UnitZ());
+			audioSystem.Update(16_ms);
+
+			THEN("The emitter gets its velocity")
+			{
+				CHECK(sound->GetVelocity() == Nz::Vector3f::UnitZ() * 10.f);
+			}
+
+			AND_THEN("The emitter velocity is reset when the entity stops")
+			{
+				registry.get<Nz::VelocityComponent>(entity).UpdateLinearVelocity(Nz::Vector3f::Zero());
+				audioSystem.Update(16_ms);
+
+				CHECK(sound->GetVelocity() == Nz::Vector3f::Zero());
+			}
+		}
+
+		WHEN("Another emitter is attached")
+		{
+			std::shared_ptr<Nz::Sound> otherSound = std::make_shared<Nz::Sound>();
+			registry.get<Nz::SoundEmitterComponent>(entity).AttachEmitter(otherSound);
+			audioSystem.Update(16_ms);
+
+			THEN("It's moved to the entity")
+			{
+				CHECK(otherSound->GetPosition() == Nz::Vector3f(1.f, 2.f, 3.f));
+			}
+		}
+	}
+}
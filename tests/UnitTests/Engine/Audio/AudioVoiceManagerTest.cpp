@@ -0,0 +1,103 @@
+#include <Nazara/Audio/Audio.hpp>
+#include <Nazara/Audio/AudioDevice.hpp>
+#include <Nazara/Audio/AudioVoiceManager.hpp>
+#include <Nazara/Audio/Sound.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <thread>
+
+std::filesystem::path GetAssetDir();
+
+SCENARIO("AudioVoiceManager", "[AUDIO][AUDIOVOICEMANAGER]")
+{
+	using namespace Nz::Literals;
+
+	GIVEN("A voice manager limited to a single voice and two sounds")
+	{
+		const std::shared_ptr<Nz::AudioDevice>& device = Nz::Audio::Instance()->GetDefaultDevice();
+		device->SetGlobalVolume(0.f);
+
+		Nz::AudioVoiceManager& voiceManager = device->GetVoiceManager();
+		std::size_t previousMaxVoiceCount = voiceManager.GetMaxVoiceCount();
+		voiceManager.SetMaxVoiceCount(1);
+
+		{
+			Nz::Sound nearSound;
+			Nz::Sound farSound;
+			REQUIRE(nearSound.LoadFromFile(GetAssetDir() / "Audio/Cat.flac"));
+			REQUIRE(farSound.LoadFromFile(GetAssetDir() / "Audio/Cat.flac"));
+
+			nearSound.SetPosition(device->GetListenerPosition());
+			farSound.SetPosition(device->GetListenerPosition() + Nz::Vector3f::UnitX() * 50.f);
+
+			WHEN("We play both sounds")
+			{
+				nearSound.Play();
+				farSound.Play();
+
+				// Let streamed sounds queue their first buffers
+				std::this_thread::sleep_for(std::chrono::milliseconds(100));
+				voiceManager.Update();
+
+				THEN("Only the most audible one gets the voice")
+				{
+					CHECK(voiceManager.GetVoiceCount() == 1);
+					CHECK_FALSE(nearSound.IsVirtual());
+					CHECK(farSound.IsVirtual());
+				}
+
+				AND_THEN("The virtual sound keeps playing")
+				{
+					std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+					CHECK(farSound.GetStatus() == Nz::SoundStatus::Playing);
+					CHECK(farSound.GetPlayingOffset() >= 250_ms);
+					CHECK(farSound.GetPlayingOffset() <= 600_ms);
+
+					farSound.Pause();
+					Nz::Time playingOffset = farSound.GetPlayingOffset();
+					std::this_thread::sleep_for(std::chrono::milliseconds(50));
+					CHECK(farSound.GetStatus() == Nz::SoundStatus::Paused);
+					CHECK(farSound.GetPlayingOffset() == playingOffset);
+
+					farSound.SeekToPlayingOffset(8_s);
+					std::this_thread::sleep_for(std::chrono::milliseconds(50));
+					CHECK(farSound.GetPlayingOffset() == 8_s);
+
+					farSound.Play();
+					std::this_thread::sleep_for(std::chrono::milliseconds(400));
+					CHECK(farSound.GetStatus() == Nz::SoundStatus::Stopped);
+					CHECK(farSound.GetPlayingOffset() == 0_ms);
+				}
+
+				AND_THEN("Voices follow priority")
+				{
+					farSound.SetPriority(1'000'000.f);
+					voiceManager.Update();
+
+					CHECK(voiceManager.GetVoiceCount() == 1);
+					CHECK(nearSound.IsVirtual());
+					CHECK_FALSE(farSound.IsVirtual());
+					CHECK(nearSound.GetStatus() == Nz::SoundStatus::Playing);
+				}
+
+				AND_THEN("Stopping the audible sound gives its voice to the other one")
+				{
+					Nz::Time playingOffset = farSound.GetPlayingOffset();
+
+					nearSound.Stop();
+					voiceManager.Update();
+
+					CHECK(nearSound.IsVirtual());
+					CHECK(nearSound.GetStatus() == Nz::SoundStatus::Stopped);
+					CHECK_FALSE(farSound.IsVirtual());
+					CHECK(farSound.GetStatus() == Nz::SoundStatus::Playing);
+					CHECK(farSound.GetPlayingOffset() >= playingOffset);
+				}
+			}
+		}
+
+		voiceManager.SetMaxVoiceCount(previousMaxVoiceCount);
+		CHECK(voiceManager.GetVoiceCount() == 0);
+	}
+}
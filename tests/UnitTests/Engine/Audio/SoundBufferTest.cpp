@@ -1,3 +1,4 @@
+#include <Nazara/Audio/Audio.hpp>
 #include <Nazara/Audio/SoundBuffer.hpp>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
@@ -61,5 +62,87 @@ SCENARIO("SoundBuffer", "[AUDIO][SOUNDBUFFER]")
 				CHECK(soundBuffer->GetSampleRate() == 44100);
 			}
 		}
+
+		WHEN("We load several files asynchronously")
+		{
+			Nz::SoundBufferParams monoParams;
+			monoParams.forceMono = true;
+			monoParams.storage = Nz::SoundBufferStorage::Decoded;
+
+			Nz::SoundBuffer::LoadHandle flacHandle = Nz::SoundBuffer::LoadFromFileAsync(GetAssetDir() / "Audio/Cat.flac", monoParams, Nz::Audio::Instance()->GetDefaultDevice());
+			Nz::SoundBuffer::LoadHandle wavHandle = Nz::SoundBuffer::LoadFromFileAsync(GetAssetDir() / "Audio/explosion1.wav");
+			Nz::SoundBuffer::LoadHandle missingHandle = Nz::SoundBuffer::LoadFromFileAsync(GetAssetDir() / "Audio/missing.wav");
+
+			REQUIRE(flacHandle.IsValid());
+			REQUIRE(wavHandle.IsValid());
+			REQUIRE(missingHandle.IsValid());
+
+			THEN("We get the sound buffers once they're decoded")
+			{
+				std::shared_ptr<Nz::SoundBuffer> flacBuffer = flacHandle.Wait();
+				REQUIRE(flacBuffer);
+				CHECK(flacHandle.IsFinished());
+				CHECK(flacHandle.GetSoundBuffer() == flacBuffer);
+				CHECK(flacBuffer->GetDuration() == 8192_ms);
+				CHECK(flacBuffer->GetFormat() == Nz::AudioFormat::I16_Mono);
+
+				std::shared_ptr<Nz::SoundBuffer> wavBuffer = wavHandle.Wait();
+				REQUIRE(wavBuffer);
+				CHECK(wavBuffer->GetDuration() == 2'490'340_us);
+
+				CHECK_FALSE(missingHandle.Wait());
+			}
+		}
+
+		WHEN("We load a .ogg file with compressed storage")
+		{
+			Nz::SoundBufferParams params;
+			params.storage = Nz::SoundBufferStorage::Compressed;
+
+			std::shared_ptr<Nz::SoundBuffer> soundBuffer = Nz::SoundBuffer::LoadFromFile(GetAssetDir() / "Audio/The_Brabanconne.ogg", params);
+			REQUIRE(soundBuffer);
+
+			THEN("Its samples are kept compressed")
+			{
+				CHECK(soundBuffer->IsCompressed());
+				CHECK(soundBuffer->GetSamples() == nullptr);
+				CHECK(soundBuffer->GetCompressedData().size() < soundBuffer->GetSampleCount() * sizeof(Nz::Int16));
+				CHECK(soundBuffer->GetDuration() == 63'059'591_us);
+				CHECK(soundBuffer->GetFormat() == Nz::AudioFormat::I16_Stereo);
+				CHECK(soundBuffer->GetSampleRate() == 44100);
+			}
+
+			AND_THEN("We can open a stream decoding them")
+			{
+				std::shared_ptr<Nz::SoundStream> soundStream = soundBuffer->OpenStream();
+				REQUIRE(soundStream);
+				CHECK(soundStream->GetSampleCount() == soundBuffer->GetSampleCount());
+			}
+		}
+
+		WHEN("We load files with automatic storage")
+		{
+			THEN("Only large files which compress well are kept compressed")
+			{
+				std::shared_ptr<Nz::SoundBuffer> oggBuffer = Nz::SoundBuffer::LoadFromFile(GetAssetDir() / "Audio/The_Brabanconne.ogg");
+				REQUIRE(oggBuffer);
+				CHECK(oggBuffer->IsCompressed());
+
+				std::shared_ptr<Nz::SoundBuffer> wavBuffer = Nz::SoundBuffer::LoadFromFile(GetAssetDir() / "Audio/explosion1.wav");
+				REQUIRE(wavBuffer);
+				CHECK_FALSE(wavBuffer->IsCompressed());
+			}
+
+			AND_THEN("Decoded storage always decodes them")
+			{
+				Nz::SoundBufferParams params;
+				params.storage = Nz::SoundBufferStorage::Decoded;
+
+				std::shared_ptr<Nz::SoundBuffer> soundBuffer = Nz::SoundBuffer::LoadFromFile(GetAssetDir() / "Audio/The_Brabanconne.ogg", params);
+				REQUIRE(soundBuffer);
+				CHECK_FALSE(soundBuffer->IsCompressed());
+				CHECK(soundBuffer->GetSamples() != nullptr);
+			}
+		}
 	}
 }
@@ -0,0 +1,87 @@
+#include <Nazara/Audio/Audio.hpp>
+#include <Nazara/Audio/AudioDevice.hpp>
+#include <Nazara/Audio/SoundBuffer.hpp>
+#include <Nazara/Audio/SoundPool.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+SCENARIO("SoundPool", "[AUDIO][SOUNDPOOL]")
+{
+	GIVEN("A sound pool with two voices")
+	{
+		const std::shared_ptr<Nz::AudioDevice>& device = Nz::Audio::Instance()->GetDefaultDevice();
+		device->SetGlobalVolume(0.f);
+
+		constexpr Nz::UInt32 sampleRate = 44100;
+		std::vector<Nz::Int16> samples(sampleRate * 2, 0); //< two seconds of silence
+
+		auto longSound = std::make_shared<Nz::SoundBuffer>(Nz::AudioFormat::I16_Mono, samples.size(), sampleRate, samples.data());
+		auto otherSound = std::make_shared<Nz::SoundBuffer>(Nz::AudioFormat::I16_Mono, samples.size(), sampleRate, samples.data());
+		auto shortSound = std::make_shared<Nz::SoundBuffer>(Nz::AudioFormat::I16_Mono, sampleRate / 20, sampleRate, samples.data());
+
+		Nz::SoundPool pool(device, 2, 0);
+		CHECK(pool.GetVoiceCount() == 2);
+		CHECK(pool.GetActiveVoiceCount() == 0);
+
+		WHEN("We play more sounds than there are voices")
+		{
+			Nz::SoundPool::OneShotParams params;
+			params.priority = 2.f;
+
+			CHECK(pool.PlayOneShot(longSound, Nz::Vector3f::Zero(), params));
+			CHECK(pool.PlayOneShot(longSound, Nz::Vector3f::Zero(), params));
+			CHECK(pool.GetActiveVoiceCount() == 2);
+
+			THEN("Lower priority sounds are rejected")
+			{
+				params.priority = 1.f;
+				CHECK_FALSE(pool.PlayOneShot(otherSound, Nz::Vector3f::Zero(), params));
+			}
+
+			AND_THEN("Sounds with the same priority steal the oldest voice")
+			{
+				CHECK(pool.PlayOneShot(otherSound, Nz::Vector3f::Zero(), params));
+				CHECK(pool.GetActiveVoiceCount() == 2);
+			}
+
+			AND_THEN("Stopping them frees every voice")
+			{
+				pool.StopAll();
+				CHECK(pool.GetActiveVoiceCount() == 0);
+			}
+		}
+
+		WHEN("We limit the number of instances of a sound")
+		{
+			pool.SetMaxInstancesPerBuffer(1);
+
+			CHECK(pool.PlayOneShot(longSound, Nz::Vector3f::Zero()));
+			CHECK(pool.PlayOneShot(longSound, Nz::Vector3f::Zero()));
+
+			THEN("Playing it again restarts the previous instance")
+			{
+				CHECK(pool.GetActiveVoiceCount() == 1);
+			}
+
+			AND_THEN("Other sounds are not affected")
+			{
+				CHECK(pool.PlayOneShot(otherSound, Nz::Vector3f::Zero()));
+				CHECK(pool.GetActiveVoiceCount() == 2);
+			}
+		}
+
+		WHEN("A sound is over")
+		{
+			CHECK(pool.PlayOneShot(shortSound, Nz::Vector3f::Zero()));
+			std::this_thread::sleep_for(std::chrono::milliseconds(300));
+			pool.Update();
+
+			THEN("Its voice is recycled")
+			{
+				CHECK(pool.GetActiveVoiceCount() == 0);
+			}
+		}
+	}
+}
@@ -97,5 +97,42 @@ SCENARIO("Sound", "[AUDIO][SOUND]")
 				Nz::Audio::Instance()->GetDefaultDevice()->SetGlobalVolume(100.f);
 			}
 		}
+
+		WHEN("We load our sound with compressed storage")
+		{
+			Nz::SoundBufferParams params;
+			params.storage = Nz::SoundBufferStorage::Compressed;
+
+			REQUIRE(sound.LoadFromFile(GetAssetDir() / "Audio/Cat.flac", params));
+			REQUIRE(sound.GetBuffer()->IsCompressed());
+
+			THEN("It is decoded while playing")
+			{
+				Nz::Audio::Instance()->GetDefaultDevice()->SetGlobalVolume(0.f);
+
+				CHECK(sound.GetDuration() == 8192_ms);
+				CHECK(sound.GetStatus() == Nz::SoundStatus::Stopped);
+
+				sound.Play();
+				std::this_thread::sleep_for(std::chrono::seconds(1));
+
+				CHECK(sound.GetStatus() == Nz::SoundStatus::Playing);
+				CHECK(sound.GetPlayingOffset() >= 950_ms);
+				CHECK(sound.GetPlayingOffset() <= 1500_ms);
+
+				sound.SeekToPlayingOffset(8000_ms);
+				std::this_thread::sleep_for(std::chrono::milliseconds(500));
+				CHECK(sound.GetStatus() == Nz::SoundStatus::Stopped);
+
+				sound.EnableLooping(true);
+				sound.SeekToPlayingOffset(8000_ms);
+				sound.Play();
+				std::this_thread::sleep_for(std::chrono::milliseconds(500));
+				CHECK(sound.GetStatus() == Nz::SoundStatus::Playing);
+				CHECK(sound.GetPlayingOffset() < 1000_ms);
+
+				Nz::Audio::Instance()->GetDefaultDevice()->SetGlobalVolume(100.f);
+			}
+		}
 	}
 }
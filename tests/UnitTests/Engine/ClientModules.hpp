@@ -2,6 +2,7 @@
 #include <Engine/Modules.hpp>
 #include <Nazara/Audio.hpp>
 #include <Nazara/Graphics.hpp>
+#include <Nazara/NullRenderer.hpp>
 #include <Nazara/OpenGLRenderer.hpp>
 #include <Nazara/Platform.hpp>
 #include <Nazara/VulkanRenderer.hpp>
@@ -36,6 +36,7 @@ TEST_CASE("ComputeHash", "[CORE][ALGORITHM]")
 		Test{ Nz::HashType::SHA384,     "Nazara Engine", "80064D11A4E4C2A44DE03406E03025C52641E04BA80DE78B1BB0BA6EA577B4B6914F2BDED5B95BB7285F8EA785B9B996" },
 		Test{ Nz::HashType::SHA512,     "Nazara Engine", "C3A8212B61B88D77E8C4B40884D49BA6A54202865CAA847F676D2EA20E60F43B1C8024DE982A214EB3670B752AF3EE37189F1EBDCA608DD0DD427D8C19371FA5" },
 		Test{ Nz::HashType::Whirlpool,  "Nazara Engine", "92113DC95C25057C4154E9A8B2A4C4C800D24DD22FA7D796F300AF9C4EFA4FAAB6030F66B0DC74B270A911DA18E007544B79B84440A1D58AA7C79A73C39C29F8" },
+		Test{ Nz::HashType::XXH64,      "Nazara Engine", "48B03613D4309E15" },
 
 		//Test{ Nz::HashType::CRC16,      "The quick brown fox jumps over the lazy dog", "FCDF" },
 		Test{ Nz::HashType::CRC32,      "The quick brown fox jumps over the lazy dog", "414FA339" },
@@ -48,6 +49,7 @@ TEST_CASE("ComputeHash", "[CORE][ALGORITHM]")
 		Test{ Nz::HashType::SHA384,     "The quick brown fox jumps over the lazy dog", "CA737F1014A48F4C0B6DD43CB177B0AFD9E5169367544C494011E3317DBF9A509CB1E5DC1E85A941BBEE3D7F2AFBC9B1" },
 		Test{ Nz::HashType::SHA512,     "The quick brown fox jumps over the lazy dog", "07E547D9586F6A73F73FBAC0435ED76951218FB7D0C8D788A309D785436BBB642E93A252A954F23912547D1E8A3B5ED6E1BFD7097821233FA0538F3DB854FEE6" },
 		Test{ Nz::HashType::Whirlpool,  "The quick brown fox jumps over the lazy dog", "B97DE512E91E3828B40D2B0FDCE9CEB3C4A71F9BEA8D88E75C4FA854DF36725FD2B52EB6544EDCACD6F8BEDDFEA403CB55AE31F03AD62A5EF54E42EE82C3FB35" },
+		Test{ Nz::HashType::XXH64,      "The quick brown fox jumps over the lazy dog", "0B242D361FDA71BC" },
 
 		//Test{ Nz::HashType::CRC16,      testFilePath, "30A6" },
 		Test{ Nz::HashType::CRC32,      testFilePath, "5A2024CD" },
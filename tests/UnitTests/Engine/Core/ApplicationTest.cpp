@@ -1,6 +1,8 @@
 #include <Nazara/Core/Application.hpp>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <thread>
 
 SCENARIO("Application", "[CORE][Application]")
 {
@@ -87,4 +89,102 @@ SCENARIO("Application", "[CORE][Application]")
 		app.Update(Nz::Time::Milliseconds(90));
 		CHECK(triggerCount == 3); // lost time is caught up
 	}
+
+	WHEN("Running with an update rate limit")
+	{
+		Nz::ApplicationBase app;
+		app.SetUpdateRateLimit(100);
+		CHECK(app.GetUpdateRateLimit() == 100);
+
+		std::size_t triggerCount = 0;
+		app.AddUpdaterFunc([&]
+		{
+			if (++triggerCount == 10)
+				app.Quit();
+		});
+
+		Nz::HighPrecisionClock clock;
+		app.Run();
+
+		INFO("Nine updates should have been spaced by at least 10ms");
+		CHECK(triggerCount == 10);
+		CHECK(clock.GetElapsedTime() >= Nz::Time::Milliseconds(90));
+	}
+
+	WHEN("Running with an update rate limit below 10Hz")
+	{
+		Nz::ApplicationBase app;
+		app.SetUpdateRateLimit(4);
+
+		std::size_t triggerCount = 0;
+		app.AddUpdaterFunc([&]
+		{
+			if (++triggerCount == 3)
+				app.Quit();
+		});
+
+		Nz::HighPrecisionClock clock;
+		app.Run();
+
+		INFO("Two updates should have been spaced by at least 250ms");
+		CHECK(triggerCount == 3);
+		CHECK(clock.GetElapsedTime() >= Nz::Time::Milliseconds(500));
+	}
+
+	WHEN("Running with only interval updaters")
+	{
+		Nz::ApplicationBase app;
+
+		std::size_t triggerCount = 0;
+		app.AddUpdaterFunc(Nz::ApplicationBase::Interval{ Nz::Time::Milliseconds(20) }, [&]
+		{
+			if (++triggerCount == 5)
+				app.Quit();
+		});
+
+		Nz::HighPrecisionClock clock;
+		app.Run();
+
+		CHECK(triggerCount == 5);
+		CHECK(clock.GetElapsedTime() >= Nz::Time::Milliseconds(80));
+	}
+
+	WHEN("Measuring updater timings")
+	{
+		Nz::ApplicationBase app;
+
+		std::size_t slowUpdater = app.AddUpdaterFunc([&]
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		});
+		app.SetUpdaterName(slowUpdater, "SlowUpdater");
+		app.GetUpdaterTimingStats(slowUpdater).SetBudget(Nz::Time::Microseconds(500));
+
+		std::size_t budgetExceededCount = 0;
+		std::string exceedingName;
+		app.OnTimingBudgetExceeded.Connect([&](Nz::ApplicationBase* /*app*/, std::string_view name, const Nz::TimingStats& /*stats*/)
+		{
+			budgetExceededCount++;
+			exceedingName = name;
+		});
+
+		for (std::size_t i = 0; i < 3; ++i)
+			app.Update(Nz::Time::Milliseconds(10));
+
+		const Nz::TimingStats& stats = app.GetUpdaterTimingStats(slowUpdater);
+		CHECK(stats.GetSampleCount() == 3);
+		CHECK(stats.GetLastDuration() >= Nz::Time::Milliseconds(2));
+		CHECK(stats.GetAverageDuration() >= Nz::Time::Milliseconds(2));
+		CHECK(stats.GetOverBudgetCount() == 3);
+		CHECK(budgetExceededCount == 3);
+		CHECK(exceedingName == "SlowUpdater");
+
+		app.EnableTimingStats(false);
+		app.Update(Nz::Time::Milliseconds(10));
+		CHECK(stats.GetSampleCount() == 3);
+
+		app.ResetTimingStats();
+		CHECK(stats.GetSampleCount() == 0);
+		CHECK(stats.GetBudget() == Nz::Time::Microseconds(500));
+	}
 }
@@ -0,0 +1,86 @@
+#include <Nazara/Core/AsyncFileReader.hpp>
+#include <Nazara/Core/File.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+SCENARIO("AsyncFileReader", "[CORE][ASYNCFILEREADER]")
+{
+	GIVEN("A file filled with known bytes")
+	{
+		std::vector<Nz::UInt8> content(64 * 1024);
+		std::iota(content.begin(), content.end(), Nz::UInt8(0));
+
+		std::filesystem::path filePath = "AsyncFileReaderTest.bin";
+		REQUIRE(Nz::File::WriteWhole(filePath, content.data(), content.size()));
+
+		std::shared_ptr<Nz::File> file = std::make_shared<Nz::File>(filePath, Nz::OpenMode::ReadOnly);
+		REQUIRE(file->IsOpen());
+
+		WHEN("We read it at an offset without using the cursor")
+		{
+			std::array<Nz::UInt8, 16> buffer;
+			CHECK(file->ReadAt(1000, buffer.data(), buffer.size()) == buffer.size());
+			CHECK(std::equal(buffer.begin(), buffer.end(), content.begin() + 1000));
+
+			CHECK(file->ReadAt(content.size() - 4, buffer.data(), buffer.size()) == 4);
+		}
+
+		WHEN("We queue many reads of different priorities")
+		{
+			constexpr std::size_t ChunkSize = 1024;
+			constexpr std::size_t ChunkCount = 64;
+
+			std::vector<Nz::UInt8> readContent(content.size());
+			std::vector<Nz::AsyncFileReader::ReadHandle> handles;
+			{
+				Nz::AsyncFileReader reader(2, 4);
+
+				// Queue chunks in reverse order, the reader sorts batches by offset
+				for (std::size_t i = ChunkCount; i > 0; --i)
+				{
+					std::size_t offset = (i - 1) * ChunkSize;
+					Nz::FileReadPriority priority = (i % 2 == 0) ? Nz::FileReadPriority::High : Nz::FileReadPriority::Low;
+					handles.push_back(reader.Read(file, offset, ChunkSize, &readContent[offset], priority));
+				}
+
+				reader.WaitForReads();
+				CHECK(reader.GetPendingReadCount() == 0);
+			}
+
+			THEN("Every read is finished with the right content")
+			{
+				for (const auto& handle : handles)
+				{
+					CHECK(handle.IsFinished());
+					CHECK(handle.Wait() == ChunkSize);
+				}
+
+				CHECK(readContent == content);
+			}
+		}
+
+		WHEN("We read past the end of the file")
+		{
+			std::array<Nz::UInt8, 32> buffer;
+
+			Nz::AsyncFileReader reader;
+			Nz::AsyncFileReader::ReadHandle handle = reader.Read(file, content.size() - 8, buffer.size(), buffer.data());
+
+			THEN("Only the remaining bytes are read")
+			{
+				CHECK(handle.Wait() == 8);
+				CHECK(handle.GetReadSize() == 8);
+				CHECK(std::equal(buffer.begin(), buffer.begin() + 8, content.end() - 8));
+				CHECK_FALSE(handle.Cancel());
+			}
+		}
+
+		file.reset();
+		std::filesystem::remove(filePath);
+	}
+}
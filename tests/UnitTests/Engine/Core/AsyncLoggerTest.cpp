@@ -0,0 +1,196 @@
+#include <Nazara/Core/AsyncLogger.hpp>
+#include <Nazara/Core/Log.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	class TestLogger : public Nz::AbstractLogger
+	{
+		public:
+			TestLogger(std::mutex& writeMutex, std::atomic_bool& isWriting) :
+			m_writeMutex(writeMutex),
+			m_isWriting(isWriting),
+			m_stdReplication(false)
+			{
+			}
+
+			void EnableStdReplication(bool enable) override
+			{
+				m_stdReplication = enable;
+			}
+
+			bool IsStdReplicationEnabled() const override
+			{
+				return m_stdReplication;
+			}
+
+			void Write(std::string_view string) override
+			{
+				m_isWriting = true;
+				std::unique_lock lock(m_writeMutex);
+
+				messages.emplace_back(string);
+				writerThreads.push_back(std::this_thread::get_id());
+			}
+
+			std::vector<std::string> messages;
+			std::vector<std::thread::id> writerThreads;
+
+		private:
+			std::mutex& m_writeMutex;
+			std::atomic_bool& m_isWriting;
+			bool m_stdReplication;
+	};
+}
+
+SCENARIO("AsyncLogger", "[CORE][ASYNCLOGGER]")
+{
+	std::mutex writeMutex;
+	std::atomic_bool isWriting = false;
+
+	GIVEN("An asynchronous logger")
+	{
+		auto testLoggerPtr = std::make_unique<TestLogger>(writeMutex, isWriting);
+		TestLogger& testLogger = *testLoggerPtr;
+
+		Nz::AsyncLogger logger(std::move(testLoggerPtr), 4);
+		CHECK(logger.DispatchesLogSignals());
+		CHECK(&logger.GetLogger() == &testLogger);
+
+		WHEN("We enable std replication")
+		{
+			logger.EnableStdReplication(true);
+
+			THEN("It is forwarded to the wrapped logger")
+			{
+				CHECK(testLogger.IsStdReplicationEnabled());
+				CHECK(logger.IsStdReplicationEnabled());
+			}
+		}
+
+		WHEN("We write records from multiple threads")
+		{
+			std::atomic_size_t signalCount = 0;
+			auto signalConnection = Nz::Log::OnLogWrite.Connect([&](std::string_view string)
+			{
+				if (string.substr(0, 9) == "AsyncTest")
+					signalCount++;
+			});
+
+			std::vector<std::thread> threads;
+			for (std::size_t i = 0; i < 2; ++i)
+			{
+				threads.emplace_back([&, i]
+				{
+					logger.Write("AsyncTest" + std::to_string(i));
+				});
+			}
+
+			for (std::thread& thread : threads)
+				thread.join();
+
+			logger.Flush();
+			signalConnection.Disconnect();
+
+			THEN("Every record is written by the logging thread")
+			{
+				REQUIRE(testLogger.messages.size() == 2);
+				CHECK(((testLogger.messages[0] == "AsyncTest0" && testLogger.messages[1] == "AsyncTest1") || (testLogger.messages[0] == "AsyncTest1" && testLogger.messages[1] == "AsyncTest0")));
+
+				for (std::thread::id threadId : testLogger.writerThreads)
+					CHECK(threadId != std::this_thread::get_id());
+
+				CHECK(signalCount == 2);
+				CHECK(logger.GetDroppedRecordCount() == 0);
+			}
+		}
+
+		WHEN("We flush while other threads flood the logger")
+		{
+			auto floodLoggerPtr = std::make_unique<TestLogger>(writeMutex, isWriting);
+			TestLogger& floodLogger = *floodLoggerPtr;
+
+			Nz::AsyncLogger asyncLogger(std::move(floodLoggerPtr), 8192);
+
+			std::atomic_bool stop = false;
+			std::vector<std::thread> threads;
+			for (std::size_t i = 0; i < 4; ++i)
+			{
+				threads.emplace_back([&, i]
+				{
+					for (std::size_t j = 0; j < 1000 && !stop; ++j)
+						asyncLogger.Write("Flood" + std::to_string(i));
+				});
+			}
+
+			bool isPresent = true;
+			for (std::size_t i = 0; i < 50; ++i)
+			{
+				std::string lastRecord = "Last" + std::to_string(i);
+				asyncLogger.Write(lastRecord);
+				asyncLogger.Flush();
+
+				std::unique_lock lock(writeMutex);
+				if (std::find(floodLogger.messages.begin(), floodLogger.messages.end(), lastRecord) == floodLogger.messages.end())
+					isPresent = false;
+			}
+
+			stop = true;
+			for (std::thread& thread : threads)
+				thread.join();
+
+			THEN("The last record of the flushing thread is always written")
+			{
+				CHECK(isPresent);
+				CHECK(asyncLogger.GetDroppedRecordCount() == 0);
+			}
+		}
+
+		WHEN("We write an error")
+		{
+			logger.WriteError(Nz::ErrorType::Normal, "Error", 42, "File.cpp", "Function");
+			logger.Flush();
+
+			THEN("It is formatted by the wrapped logger")
+			{
+				REQUIRE(testLogger.messages.size() == 1);
+				CHECK(testLogger.messages[0].find("Error") != std::string::npos);
+			}
+		}
+
+		WHEN("We write more records than the logging thread can handle")
+		{
+			{
+				std::unique_lock lock(writeMutex);
+
+				logger.Write("First");
+				while (!isWriting)
+					std::this_thread::yield();
+
+				// The first record is being written, the two last records should be dropped
+				for (std::size_t i = 0; i < 6; ++i)
+					logger.Write("Record" + std::to_string(i));
+			}
+
+			logger.Flush();
+
+			THEN("Excess records are dropped and reported")
+			{
+				CHECK(logger.GetDroppedRecordCount() == 2);
+
+				REQUIRE(testLogger.messages.size() == 6);
+				CHECK(testLogger.messages[0] == "First");
+				for (std::size_t i = 0; i < 4; ++i)
+					CHECK(testLogger.messages[i + 1] == "Record" + std::to_string(i));
+
+				CHECK(testLogger.messages[5].find("2 log records were dropped") != std::string::npos);
+			}
+		}
+	}
+}
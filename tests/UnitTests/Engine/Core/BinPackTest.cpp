@@ -0,0 +1,104 @@
+#include <Nazara/Core/MaxRectsBinPack.hpp>
+#include <Nazara/Core/SkylineBinPack.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+namespace
+{
+	std::vector<Nz::Rectui> BuildGlyphLikeRects()
+	{
+		std::vector<Nz::Rectui> rects;
+		for (unsigned int i = 0; i < 200; ++i)
+			rects.emplace_back(0u, 0u, 4u + (i * 7) % 13, 10u + (i * 3) % 5);
+
+		return rects;
+	}
+
+	bool Overlaps(const Nz::Rectui& lhs, const Nz::Rectui& rhs)
+	{
+		// Rect::Intersect also reports rectangles sharing an edge
+		return lhs.x < rhs.x + rhs.width && rhs.x < lhs.x + lhs.width && lhs.y < rhs.y + rhs.height && rhs.y < lhs.y + lhs.height;
+	}
+
+	void CheckPlacement(const std::vector<Nz::Rectui>& rects, const std::vector<char>& inserted, const Nz::Vector2ui& binSize)
+	{
+		for (std::size_t i = 0; i < rects.size(); ++i)
+		{
+			if (!inserted[i])
+				continue;
+
+			const Nz::Rectui& rect = rects[i];
+			CHECK(rect.x + rect.width <= binSize.x);
+			CHECK(rect.y + rect.height <= binSize.y);
+
+			for (std::size_t j = i + 1; j < rects.size(); ++j)
+			{
+				if (inserted[j])
+					CHECK_FALSE(Overlaps(rect, rects[j]));
+			}
+		}
+	}
+
+	template<typename T, typename... Args>
+	void TestBinPack(Args... args)
+	{
+		T binPack(256, 256);
+
+		std::vector<Nz::Rectui> rects = BuildGlyphLikeRects();
+		std::vector<char> inserted(rects.size());
+		std::vector<char> flipped(rects.size());
+
+		CHECK(binPack.Insert(rects.data(), reinterpret_cast<bool*>(flipped.data()), reinterpret_cast<bool*>(inserted.data()), static_cast<unsigned int>(rects.size()), args...));
+		CheckPlacement(rects, inserted, binPack.GetSize());
+		CHECK(binPack.GetOccupancy() > 0.3f);
+
+		// Free half of the rectangles and reinsert them
+		std::vector<Nz::Rectui> freedRects;
+		for (std::size_t i = 0; i < rects.size(); i += 2)
+		{
+			binPack.FreeRectangle(rects[i]);
+			freedRects.push_back(Nz::Rectui(0u, 0u, rects[i].width, rects[i].height));
+		}
+
+		std::vector<char> reinserted(freedRects.size());
+		binPack.Insert(freedRects.data(), nullptr, reinterpret_cast<bool*>(reinserted.data()), static_cast<unsigned int>(freedRects.size()), args...);
+
+		std::vector<Nz::Rectui> allRects;
+		std::vector<char> allInserted;
+		for (std::size_t i = 1; i < rects.size(); i += 2)
+		{
+			allRects.push_back(rects[i]);
+			allInserted.push_back(inserted[i]);
+		}
+
+		allRects.insert(allRects.end(), freedRects.begin(), freedRects.end());
+		allInserted.insert(allInserted.end(), reinserted.begin(), reinserted.end());
+
+		CheckPlacement(allRects, allInserted, binPack.GetSize());
+
+		// Expanding must allow more insertions without overlapping existing ones
+		binPack.Expand(512, 512);
+		Nz::Rectui bigRect(0u, 0u, 240u, 240u);
+		CHECK(binPack.Insert(&bigRect, 1, args...));
+
+		allRects.push_back(bigRect);
+		allInserted.push_back(1);
+		CheckPlacement(allRects, allInserted, binPack.GetSize());
+	}
+}
+
+SCENARIO("BinPack", "[CORE][BINPACK]")
+{
+	WHEN("Packing glyph-like rectangles with the skyline algorithm")
+	{
+		TestBinPack<Nz::SkylineBinPack>(Nz::SkylineBinPack::Heuristic::BottomLeft);
+		TestBinPack<Nz::SkylineBinPack>(Nz::SkylineBinPack::Heuristic::MinWaste);
+	}
+
+	WHEN("Packing glyph-like rectangles with the maximal rectangles algorithm")
+	{
+		TestBinPack<Nz::MaxRectsBinPack>(Nz::MaxRectsBinPack::Heuristic::BestShortSideFit);
+		TestBinPack<Nz::MaxRectsBinPack>(Nz::MaxRectsBinPack::Heuristic::BestAreaFit);
+		TestBinPack<Nz::MaxRectsBinPack>(Nz::MaxRectsBinPack::Heuristic::BottomLeft);
+	}
+}
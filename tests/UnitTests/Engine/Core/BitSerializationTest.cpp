@@ -0,0 +1,101 @@
+#include <Nazara/Core/BitSerialization.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/ByteStream.hpp>
+#include <Nazara/Math/EulerAngles.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+SCENARIO("BitSerialization", "[CORE][BITSERIALIZATION]")
+{
+	GIVEN("A byte stream over a byte array")
+	{
+		Nz::ByteArray byteArray;
+		Nz::ByteStream writeStream(&byteArray, Nz::OpenMode::WriteOnly);
+
+		WHEN("We write bit-packed values")
+		{
+			int smallValue = -5;
+			bool flag = true;
+			Nz::UInt32 varValue = 1000;
+			Nz::Int64 negativeVarValue = -123456789012;
+			float quantizedValue = 3.3f;
+			int boundedValue = 57;
+			Nz::Quaternionf rotation(Nz::EulerAnglesf(30.f, 45.f, -60.f));
+
+			writeStream << Nz::BitField(smallValue, 5);
+			writeStream << flag;
+			writeStream << Nz::VarInteger(varValue);
+			writeStream << Nz::VarInteger(negativeVarValue);
+			writeStream << Nz::QuantizedFloat(quantizedValue, -10.f, 10.f, 12);
+			writeStream << Nz::BoundedInteger(boundedValue, 10, 100);
+			writeStream << Nz::CompressedQuaternion(rotation, 10);
+			writeStream.FlushBits();
+
+			THEN("They take a fraction of their byte-aligned size")
+			{
+				// 5 + 1 + 16 + 48 + 12 + 7 + 32 bits
+				CHECK(byteArray.GetSize() == 16);
+			}
+
+			AND_THEN("We can read them back")
+			{
+				Nz::ByteStream readStream(byteArray.GetConstBuffer(), byteArray.GetSize());
+
+				int readSmallValue;
+				bool readFlag;
+				Nz::UInt32 readVarValue;
+				Nz::Int64 readNegativeVarValue;
+				float readQuantizedValue;
+				int readBoundedValue;
+				Nz::Quaternionf readRotation;
+
+				readStream >> Nz::BitField(readSmallValue, 5);
+				readStream >> readFlag;
+				readStream >> Nz::VarInteger(readVarValue);
+				readStream >> Nz::VarInteger(readNegativeVarValue);
+				readStream >> Nz::QuantizedFloat(readQuantizedValue, -10.f, 10.f, 12);
+				readStream >> Nz::BoundedInteger(readBoundedValue, 10, 100);
+				readStream >> Nz::CompressedQuaternion(readRotation, 10);
+
+				CHECK(readSmallValue == smallValue);
+				CHECK(readFlag == flag);
+				CHECK(readVarValue == varValue);
+				CHECK(readNegativeVarValue == negativeVarValue);
+				CHECK(readQuantizedValue == Catch::Approx(quantizedValue).margin(20.f / 4095.f));
+				CHECK(readBoundedValue == boundedValue);
+
+				// dot product close to +/-1 means the same rotation
+				float dot = rotation.DotProduct(readRotation);
+				CHECK(std::abs(dot) == Catch::Approx(1.f).margin(0.001f));
+			}
+		}
+
+		WHEN("We mix bit-packed and byte-aligned values")
+		{
+			Nz::UInt8 bits = 0b101;
+			Nz::UInt32 alignedValue = 0xDEADBEEF;
+			Nz::UInt8 moreBits = 0b11;
+
+			writeStream << Nz::BitField(bits, 3);
+			writeStream << alignedValue;
+			writeStream << Nz::BitField(moreBits, 2);
+			writeStream.FlushBits();
+
+			THEN("Byte-aligned values flush pending bits")
+			{
+				CHECK(byteArray.GetSize() == 1 + sizeof(Nz::UInt32) + 1);
+
+				Nz::ByteStream readStream(byteArray.GetConstBuffer(), byteArray.GetSize());
+
+				Nz::UInt8 readBits;
+				Nz::UInt32 readAlignedValue;
+				Nz::UInt8 readMoreBits;
+				readStream >> Nz::BitField(readBits, 3) >> readAlignedValue >> Nz::BitField(readMoreBits, 2);
+
+				CHECK(readBits == bits);
+				CHECK(readAlignedValue == alignedValue);
+				CHECK(readMoreBits == moreBits);
+			}
+		}
+	}
+}
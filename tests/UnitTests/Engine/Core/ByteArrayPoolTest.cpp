@@ -0,0 +1,138 @@
+#include <Nazara/Core/ByteArrayPool.hpp>
+#include <Nazara/Core/PoolByteStream.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <limits>
+#include <thread>
+#include <vector>
+
+SCENARIO("ByteArrayPool", "[CORE][BYTEARRAYPOOL]")
+{
+	GIVEN("A pool retaining up to 1KiB per size class")
+	{
+		Nz::ByteArrayPool pool(1024);
+		CHECK(pool.GetMaxRetainedBytesPerClass() == 1024);
+		CHECK(pool.GetRetainedBytes() == 0);
+
+		WHEN("We get a byte array")
+		{
+			Nz::ByteArray byteArray = pool.GetByteArray(100);
+
+			THEN("Its capacity is rounded up to its size class")
+			{
+				CHECK(byteArray.IsEmpty());
+				CHECK(byteArray.GetCapacity() >= 128);
+				CHECK(pool.GetByteArray(0).GetCapacity() >= Nz::ByteArrayPool::GetSizeClassCapacity(0));
+			}
+
+			AND_WHEN("We return it")
+			{
+				byteArray.Resize(100);
+				const Nz::UInt8* buffer = byteArray.GetConstBuffer();
+				std::size_t capacity = byteArray.GetCapacity();
+
+				pool.ReturnByteArray(std::move(byteArray));
+				CHECK(pool.GetRetainedBytes() == capacity);
+
+				THEN("It is cleared and reused for requests of its size class")
+				{
+					Nz::ByteArray reusedByteArray = pool.GetByteArray(128);
+					CHECK(reusedByteArray.IsEmpty());
+					CHECK(reusedByteArray.GetCapacity() == capacity);
+					CHECK(reusedByteArray.GetConstBuffer() == buffer);
+					CHECK(pool.GetRetainedBytes() == 0);
+				}
+
+				THEN("It is not used for bigger requests")
+				{
+					CHECK(pool.GetByteArray(129).GetConstBuffer() != buffer);
+					CHECK(pool.GetRetainedBytes() == capacity);
+				}
+
+				THEN("Clearing the pool frees it")
+				{
+					pool.Clear();
+					CHECK(pool.GetRetainedBytes() == 0);
+				}
+			}
+		}
+
+		WHEN("We return more bytes than a size class can retain")
+		{
+			for (std::size_t i = 0; i < 5; ++i)
+				pool.ReturnByteArray(pool.GetByteArray(256));
+
+			std::vector<Nz::ByteArray> byteArrays;
+			for (std::size_t i = 0; i < 5; ++i)
+				byteArrays.push_back(pool.GetByteArray(256));
+
+			for (Nz::ByteArray& byteArray : byteArrays)
+				pool.ReturnByteArray(std::move(byteArray));
+
+			THEN("Excess arrays are freed")
+			{
+				CHECK(pool.GetRetainedBytes() <= 1024);
+				CHECK(pool.GetRetainedBytes() > 0);
+			}
+
+			AND_WHEN("We lower the limit")
+			{
+				pool.SetMaxRetainedBytesPerClass(256);
+
+				THEN("Retained arrays are freed to match it")
+				{
+					CHECK(pool.GetRetainedBytes() <= 256);
+				}
+			}
+		}
+
+		WHEN("We return a byte array bigger than the largest size class")
+		{
+			Nz::ByteArray byteArray = pool.GetByteArray(Nz::ByteArrayPool::GetSizeClassCapacity(Nz::ByteArrayPool::SizeClassCount - 1) * 2);
+			pool.SetMaxRetainedBytesPerClass(std::numeric_limits<std::size_t>::max() / 2);
+			pool.ReturnByteArray(std::move(byteArray));
+
+			THEN("It is not retained")
+			{
+				CHECK(pool.GetRetainedBytes() == 0);
+			}
+		}
+
+		WHEN("Multiple threads use the pool")
+		{
+			std::vector<std::thread> threads;
+			for (std::size_t i = 0; i < 4; ++i)
+			{
+				threads.emplace_back([&pool, i]
+				{
+					for (std::size_t j = 0; j < 1000; ++j)
+					{
+						Nz::ByteArray byteArray = pool.GetByteArray(64 << (j % 4));
+						byteArray.Resize(64, Nz::UInt8(i));
+						pool.ReturnByteArray(std::move(byteArray));
+					}
+				});
+			}
+
+			for (std::thread& thread : threads)
+				thread.join();
+
+			THEN("Retained bytes stay within limits")
+			{
+				CHECK(pool.GetRetainedBytes() <= 4 * 1024);
+			}
+		}
+
+		WHEN("A PoolByteStream uses it")
+		{
+			{
+				Nz::PoolByteStream stream(pool, 100);
+				stream << Nz::UInt32(42);
+			}
+
+			THEN("Its buffer is given back to the pool")
+			{
+				CHECK(pool.GetRetainedBytes() >= 128);
+			}
+		}
+	}
+}
@@ -0,0 +1,138 @@
+#include <Nazara/Core/DynamicAABBTree.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+SCENARIO("DynamicAABBTree", "[CORE][DYNAMICAABBTREE]")
+{
+	GIVEN("A tree filled with random boxes")
+	{
+		std::mt19937 randomEngine(42);
+		std::uniform_real_distribution<float> positionDis(-100.f, 100.f);
+		std::uniform_real_distribution<float> sizeDis(0.1f, 5.f);
+
+		auto GenerateBox = [&]
+		{
+			return Nz::Boxf(positionDis(randomEngine), positionDis(randomEngine), positionDis(randomEngine), sizeDis(randomEngine), sizeDis(randomEngine), sizeDis(randomEngine));
+		};
+
+		Nz::DynamicAABBTree tree(0.5f);
+
+		std::vector<Nz::Boxf> boxes(500);
+		std::vector<std::size_t> proxies(boxes.size());
+		for (std::size_t i = 0; i < boxes.size(); ++i)
+		{
+			boxes[i] = GenerateBox();
+			proxies[i] = tree.AddProxy(boxes[i], i);
+			CHECK(tree.GetFatAABB(proxies[i]).Contains(boxes[i]));
+			CHECK(tree.GetUserData(proxies[i]) == i);
+		}
+
+		CHECK(tree.GetProxyCount() == boxes.size());
+
+		auto CheckBoxQuery = [&](const Nz::Boxf& queryBox, const std::vector<bool>& alive)
+		{
+			std::vector<bool> reported(boxes.size(), false);
+			tree.Query(queryBox, [&](std::size_t userData)
+			{
+				CHECK_FALSE(reported[userData]);
+				reported[userData] = true;
+			});
+
+			for (std::size_t i = 0; i < boxes.size(); ++i)
+			{
+				if (!alive[i])
+					CHECK_FALSE(reported[i]);
+				else if (queryBox.Intersect(boxes[i]))
+					CHECK(reported[i]); //< proxies are reported in a conservative way, every overlapping box must be found
+			}
+		};
+
+		auto CheckFrustumQuery = [&](const Nz::Frustumf& frustum, const std::vector<bool>& alive)
+		{
+			std::vector<bool> reported(boxes.size(), false);
+			tree.Query(frustum, [&](std::size_t userData, Nz::IntersectionSide side)
+			{
+				CHECK_FALSE(reported[userData]);
+				reported[userData] = true;
+
+				if (side == Nz::IntersectionSide::Inside)
+					CHECK(frustum.Intersect(boxes[userData]) == Nz::IntersectionSide::Inside);
+			});
+
+			for (std::size_t i = 0; i < boxes.size(); ++i)
+			{
+				if (!alive[i])
+					CHECK_FALSE(reported[i]);
+				else if (frustum.Intersect(boxes[i]) != Nz::IntersectionSide::Outside)
+					CHECK(reported[i]);
+			}
+		};
+
+		Nz::Frustumf frustum = Nz::Frustumf::Build(Nz::DegreeAnglef(70.f), 1.f, 1.f, 150.f, Nz::Vector3f::Zero(), Nz::Vector3f::UnitX());
+
+		WHEN("We query it")
+		{
+			std::vector<bool> alive(boxes.size(), true);
+
+			THEN("Every overlapping proxy is reported once")
+			{
+				CheckBoxQuery(Nz::Boxf(-20.f, -20.f, -20.f, 40.f, 40.f, 40.f), alive);
+				CheckBoxQuery(Nz::Boxf(-200.f, -200.f, -200.f, 400.f, 400.f, 400.f), alive);
+				CheckFrustumQuery(frustum, alive);
+			}
+		}
+
+		WHEN("We move and remove proxies")
+		{
+			std::vector<bool> alive(boxes.size(), true);
+
+			for (std::size_t i = 0; i < boxes.size(); i += 3)
+			{
+				boxes[i] = GenerateBox();
+				tree.MoveProxy(proxies[i], boxes[i]);
+			}
+
+			for (std::size_t i = 1; i < boxes.size(); i += 4)
+			{
+				tree.RemoveProxy(proxies[i]);
+				alive[i] = false;
+			}
+
+			THEN("Queries reflect the changes")
+			{
+				CHECK(tree.GetProxyCount() == static_cast<std::size_t>(std::count(alive.begin(), alive.end(), true)));
+
+				CheckBoxQuery(Nz::Boxf(-50.f, -10.f, -50.f, 100.f, 20.f, 100.f), alive);
+				CheckFrustumQuery(frustum, alive);
+			}
+		}
+
+		WHEN("We slightly move a proxy")
+		{
+			Nz::Boxf movedBox = boxes[0];
+			movedBox.x += 0.1f;
+
+			THEN("It stays in its fat AABB")
+			{
+				CHECK_FALSE(tree.MoveProxy(proxies[0], movedBox));
+				CHECK(tree.MoveProxy(proxies[0], Nz::Boxf(500.f, 500.f, 500.f, 1.f, 1.f, 1.f)));
+			}
+		}
+
+		WHEN("We clear it")
+		{
+			tree.Clear();
+
+			THEN("Nothing is reported anymore")
+			{
+				CHECK(tree.GetProxyCount() == 0);
+
+				bool reported = false;
+				tree.Query(Nz::Boxf(-200.f, -200.f, -200.f, 400.f, 400.f, 400.f), [&](std::size_t) { reported = true; });
+				CHECK_FALSE(reported);
+			}
+		}
+	}
+}
@@ -0,0 +1,146 @@
+#include <Nazara/Core/EnttSnapshot.hpp>
+#include <Nazara/Core/MemoryStream.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+
+namespace
+{
+	struct PositionComponent
+	{
+		float x;
+		float y;
+	};
+
+	struct NameComponent
+	{
+		std::string name;
+	};
+
+	struct PlayerTag {};
+
+	entt::entity FindEntity(entt::registry& registry, const std::string& name)
+	{
+		for (auto&& [entity, nameComponent] : registry.view<NameComponent>().each())
+		{
+			if (nameComponent.name == name)
+				return entity;
+		}
+
+		return entt::null;
+	}
+}
+
+template<>
+struct Nz::EnttSnapshotComponent<NameComponent>
+{
+	static constexpr bool BulkCopy = false;
+
+	static bool Serialize(SerializationContext& context, const NameComponent& component)
+	{
+		return Nz::Serialize(context, component.name);
+	}
+
+	static bool Unserialize(SerializationContext& context, NameComponent* component)
+	{
+		return Nz::Unserialize(context, &component->name);
+	}
+};
+
+SCENARIO("EnttSnapshot", "[CORE][ENTTSNAPSHOT]")
+{
+	GIVEN("Two registries with snapshots registering the same components")
+	{
+		entt::registry sourceRegistry;
+		Nz::EnttSnapshot sourceSnapshot(sourceRegistry);
+
+		entt::registry targetRegistry;
+		Nz::EnttSnapshot targetSnapshot(targetRegistry);
+
+		for (Nz::EnttSnapshot* snapshot : { &sourceSnapshot, &targetSnapshot })
+		{
+			snapshot->RegisterComponent<PositionComponent>(0);
+			snapshot->RegisterComponent<NameComponent>(1);
+			snapshot->RegisterComponent<PlayerTag>(2);
+		}
+
+		entt::entity alice = sourceRegistry.create();
+		sourceRegistry.emplace<PositionComponent>(alice, 1.f, 2.f);
+		sourceRegistry.emplace<NameComponent>(alice, "alice");
+		sourceRegistry.emplace<PlayerTag>(alice);
+
+		entt::entity bob = sourceRegistry.create();
+		sourceRegistry.emplace<PositionComponent>(bob, 3.f, 4.f);
+		sourceRegistry.emplace<NameComponent>(bob, "bob");
+
+		entt::entity carol = sourceRegistry.create();
+		sourceRegistry.emplace<NameComponent>(carol, "carol");
+		sourceRegistry.emplace<PlayerTag>(carol);
+
+		Nz::MemoryStream stream;
+		Nz::SerializationContext context;
+		context.stream = &stream;
+
+		REQUIRE(sourceSnapshot.Save(context));
+
+		stream.SetCursorPos(0);
+		REQUIRE(targetSnapshot.Load(context));
+
+		WHEN("Loading a full snapshot")
+		{
+			THEN("Entities are recreated with their components")
+			{
+				CHECK(targetRegistry.view<NameComponent>().size() == 3);
+
+				entt::entity loadedAlice = FindEntity(targetRegistry, "alice");
+				REQUIRE(loadedAlice != entt::null);
+				CHECK(targetSnapshot.GetLoadedEntity(alice) == loadedAlice);
+				CHECK(targetRegistry.all_of<PlayerTag>(loadedAlice));
+				CHECK(targetRegistry.get<PositionComponent>(loadedAlice).x == 1.f);
+				CHECK(targetRegistry.get<PositionComponent>(loadedAlice).y == 2.f);
+
+				entt::entity loadedBob = FindEntity(targetRegistry, "bob");
+				REQUIRE(loadedBob != entt::null);
+				CHECK_FALSE(targetRegistry.all_of<PlayerTag>(loadedBob));
+				CHECK(targetRegistry.get<PositionComponent>(loadedBob).x == 3.f);
+
+				entt::entity loadedCarol = FindEntity(targetRegistry, "carol");
+				REQUIRE(loadedCarol != entt::null);
+				CHECK_FALSE(targetRegistry.all_of<PositionComponent>(loadedCarol));
+			}
+		}
+
+		WHEN("Loading an incremental snapshot")
+		{
+			sourceRegistry.patch<PositionComponent>(alice, [](PositionComponent& position) { position.x = 10.f; });
+			sourceRegistry.remove<PlayerTag>(carol);
+			sourceRegistry.destroy(bob);
+
+			entt::entity dave = sourceRegistry.create();
+			sourceRegistry.emplace<NameComponent>(dave, "dave");
+
+			Nz::MemoryStream changeStream;
+			context.stream = &changeStream;
+
+			REQUIRE(sourceSnapshot.SaveChanges(context));
+
+			changeStream.SetCursorPos(0);
+			REQUIRE(targetSnapshot.Load(context));
+
+			THEN("Only changes are applied")
+			{
+				CHECK(targetRegistry.view<NameComponent>().size() == 3);
+				CHECK(FindEntity(targetRegistry, "bob") == entt::null);
+				CHECK(FindEntity(targetRegistry, "dave") != entt::null);
+
+				entt::entity loadedAlice = FindEntity(targetRegistry, "alice");
+				REQUIRE(loadedAlice != entt::null);
+				CHECK(targetRegistry.get<PositionComponent>(loadedAlice).x == 10.f);
+				CHECK(targetRegistry.all_of<PlayerTag>(loadedAlice));
+
+				entt::entity loadedCarol = FindEntity(targetRegistry, "carol");
+				REQUIRE(loadedCarol != entt::null);
+				CHECK_FALSE(targetRegistry.all_of<PlayerTag>(loadedCarol));
+			}
+		}
+	}
+}
@@ -0,0 +1,242 @@
+#include <Nazara/Core/EnttSystemGraph.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <thread>
+
+namespace
+{
+	struct PositionComponent {};
+	struct VelocityComponent {};
+	struct HealthComponent {};
+
+	struct ExecutionLog
+	{
+		std::atomic_uint counter = 0;
+		unsigned int movementOrder = 0;
+		unsigned int cameraOrder = 0;
+		unsigned int healthOrder = 0;
+		unsigned int exclusiveOrder = 0;
+		std::thread::id exclusiveThread;
+		std::thread::id mainThreadSystemThread;
+	};
+
+	struct MovementSystem
+	{
+		using Components = Nz::TypeList<PositionComponent>;
+		using ReadOnlyComponents = Nz::TypeList<VelocityComponent>;
+
+		MovementSystem(entt::registry& /*registry*/, ExecutionLog& log) : m_log(log) {}
+		void Update(Nz::Time /*elapsedTime*/) { m_log.movementOrder = ++m_log.counter; }
+
+		ExecutionLog& m_log;
+	};
+
+	struct CameraSystem
+	{
+		static constexpr Nz::Int64 ExecutionOrder = 1;
+		static constexpr bool RunOnMainThread = true;
+		using Components = Nz::TypeList<>;
+		using ReadOnlyComponents = Nz::TypeList<PositionComponent>;
+
+		CameraSystem(entt::registry& /*registry*/, ExecutionLog& log) : m_log(log) {}
+		void Update(Nz::Time /*elapsedTime*/)
+		{
+			m_log.cameraOrder = ++m_log.counter;
+			m_log.mainThreadSystemThread = std::this_thread::get_id();
+		}
+
+		ExecutionLog& m_log;
+	};
+
+	struct HealthSystem
+	{
+		using Components = Nz::TypeList<HealthComponent>;
+
+		HealthSystem(entt::registry& /*registry*/, ExecutionLog& log) : m_log(log) {}
+		void Update(Nz::Time /*elapsedTime*/) { m_log.healthOrder = ++m_log.counter; }
+
+		ExecutionLog& m_log;
+	};
+
+	struct ExclusiveSystem
+	{
+		static constexpr bool AllowConcurrent = false;
+		static constexpr Nz::Int64 ExecutionOrder = 10;
+
+		ExclusiveSystem(entt::registry& /*registry*/, ExecutionLog& log) : m_log(log) {}
+		void Update(Nz::Time /*elapsedTime*/)
+		{
+			m_log.exclusiveOrder = ++m_log.counter;
+			m_log.exclusiveThread = std::this_thread::get_id();
+		}
+
+		ExecutionLog& m_log;
+	};
+
+	struct FixedStepLog
+	{
+		unsigned int fixedUpdateCount = 0;
+		unsigned int variableUpdateCount = 0;
+		Nz::Time fixedElapsedTime = Nz::Time::Zero();
+		float alpha = 0.f;
+	};
+
+	struct SimulationSystem
+	{
+		static constexpr bool FixedUpdate = true;
+
+		SimulationSystem(entt::registry& /*registry*/, FixedStepLog& log) : m_log(log) {}
+		void Update(Nz::Time elapsedTime)
+		{
+			m_log.fixedUpdateCount++;
+			m_log.fixedElapsedTime = elapsedTime;
+		}
+
+		FixedStepLog& m_log;
+	};
+
+	struct PresentationSystem
+	{
+		PresentationSystem(entt::registry& /*registry*/, FixedStepLog& log) : m_log(log) {}
+		void Update(Nz::Time /*elapsedTime*/, const Nz::EnttSystemGraph::FixedStepInfo& fixedStepInfo)
+		{
+			m_log.variableUpdateCount++;
+			m_log.alpha = fixedStepInfo.alpha;
+		}
+
+		FixedStepLog& m_log;
+	};
+}
+
+SCENARIO("EnttSystemGraph", "[CORE][ENTTSYSTEMGRAPH]")
+{
+	GIVEN("A system graph with systems declaring their components")
+	{
+		entt::registry registry;
+		ExecutionLog log;
+
+		Nz::EnttSystemGraph systemGraph(registry);
+		systemGraph.AddSystem<ExclusiveSystem>(log);
+		systemGraph.AddSystem<CameraSystem>(log);
+		systemGraph.AddSystem<HealthSystem>(log);
+		systemGraph.AddSystem<MovementSystem>(log);
+
+		auto CheckOrder = [&]
+		{
+			CHECK(log.counter == 4);
+
+			// Camera reads positions written by the movement system
+			CHECK(log.movementOrder < log.cameraOrder);
+			CHECK(log.mainThreadSystemThread == std::this_thread::get_id());
+
+			// Exclusive systems run after every system preceding them, on the calling thread
+			CHECK(log.exclusiveOrder == 4);
+			CHECK(log.exclusiveThread == std::this_thread::get_id());
+		};
+
+		WHEN("Updating it concurrently")
+		{
+			for (unsigned int i = 0; i < 10; ++i)
+			{
+				log.counter = 0;
+				systemGraph.Update(Nz::Time::Zero());
+				CheckOrder();
+			}
+		}
+
+		WHEN("Updating it sequentially")
+		{
+			systemGraph.EnableConcurrentUpdate(false);
+			CHECK_FALSE(systemGraph.IsConcurrentUpdateEnabled());
+
+			systemGraph.Update(Nz::Time::Zero());
+			CheckOrder();
+
+			// Systems with the same execution order run in insertion order
+			CHECK(log.healthOrder == 1);
+			CHECK(log.movementOrder == 2);
+		}
+
+		WHEN("Removing a system")
+		{
+			systemGraph.RemoveSystem<CameraSystem>();
+
+			CHECK(&systemGraph.GetSystem<MovementSystem>().m_log == &log);
+			CHECK(&systemGraph.GetSystem<HealthSystem>().m_log == &log);
+
+			systemGraph.Update(Nz::Time::Zero());
+			CHECK(log.counter == 3);
+		}
+	}
+
+	GIVEN("A system graph with a fixed timestep")
+	{
+		entt::registry registry;
+		FixedStepLog log;
+
+		Nz::EnttSystemGraph systemGraph(registry);
+		systemGraph.AddSystem<SimulationSystem>(log);
+		systemGraph.AddSystem<PresentationSystem>(log);
+		systemGraph.SetFixedTimestep(Nz::Time::Milliseconds(10));
+		systemGraph.SetMaxFixedStepCount(4);
+
+		WHEN("Updating it with less than a timestep")
+		{
+			systemGraph.Update(Nz::Time::Milliseconds(5));
+
+			CHECK(log.fixedUpdateCount == 0);
+			CHECK(log.variableUpdateCount == 1);
+			CHECK(log.alpha == 0.5f);
+
+			systemGraph.Update(Nz::Time::Milliseconds(5));
+
+			CHECK(log.fixedUpdateCount == 1);
+			CHECK(log.fixedElapsedTime == Nz::Time::Milliseconds(10));
+			CHECK(log.variableUpdateCount == 2);
+			CHECK(log.alpha == 0.f);
+			CHECK(systemGraph.GetFixedStepInfo().stepIndex == 1);
+		}
+
+		WHEN("Updating it with multiple timesteps")
+		{
+			systemGraph.Update(Nz::Time::Milliseconds(25));
+
+			CHECK(log.fixedUpdateCount == 2);
+			CHECK(log.variableUpdateCount == 1);
+			CHECK(log.alpha == 0.5f);
+		}
+
+		WHEN("Updating it with more than the maximum step count")
+		{
+			systemGraph.Update(Nz::Time::Milliseconds(105));
+
+			// Excess time is dropped instead of making the simulation spiral
+			CHECK(log.fixedUpdateCount == 4);
+			CHECK(log.alpha == 0.5f);
+
+			systemGraph.Update(Nz::Time::Milliseconds(5));
+			CHECK(log.fixedUpdateCount == 5);
+		}
+
+		WHEN("Reading system timings")
+		{
+			systemGraph.Update(Nz::Time::Milliseconds(25));
+
+			// Fixed systems add a sample per step
+			CHECK(systemGraph.GetSystemTimingStats<SimulationSystem>().GetSampleCount() == 2);
+			CHECK(systemGraph.GetSystemTimingStats<PresentationSystem>().GetSampleCount() == 1);
+
+			std::size_t systemCount = 0;
+			systemGraph.ForEachSystemTimingStats([&](std::string_view name, const Nz::TimingStats& stats)
+			{
+				CHECK_FALSE(name.empty());
+				CHECK(stats.GetSampleCount() > 0);
+				systemCount++;
+			});
+			CHECK(systemCount == 2);
+
+			systemGraph.ResetTimingStats();
+			CHECK(systemGraph.GetSystemTimingStats<SimulationSystem>().GetSampleCount() == 0);
+		}
+	}
+}
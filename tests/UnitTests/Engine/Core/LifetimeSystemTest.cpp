@@ -0,0 +1,124 @@
+#include <Nazara/Core/Components/DisabledComponent.hpp>
+#include <Nazara/Core/Components/LifetimeComponent.hpp>
+#include <Nazara/Core/Systems/LifetimeSystem.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+SCENARIO("LifetimeSystem", "[CORE][LIFETIMESYSTEM]")
+{
+	GIVEN("A registry with entities of different lifetimes")
+	{
+		entt::registry registry;
+		Nz::LifetimeSystem lifetimeSystem(registry);
+
+		entt::entity shortLived = registry.create();
+		registry.emplace<Nz::LifetimeComponent>(shortLived, Nz::Time::Milliseconds(100));
+
+		entt::entity longLived = registry.create();
+		registry.emplace<Nz::LifetimeComponent>(longLived, Nz::Time::Seconds(10));
+
+		entt::entity disabled = registry.create();
+		registry.emplace<Nz::LifetimeComponent>(disabled, Nz::Time::Milliseconds(100));
+		registry.emplace<Nz::DisabledComponent>(disabled);
+
+		WHEN("Less time than the shortest lifetime passes")
+		{
+			lifetimeSystem.Update(Nz::Time::Milliseconds(50));
+
+			THEN("Every entity is alive")
+			{
+				CHECK(registry.valid(shortLived));
+				CHECK(registry.valid(longLived));
+				CHECK(registry.valid(disabled));
+			}
+		}
+
+		WHEN("The shortest lifetime is over")
+		{
+			lifetimeSystem.Update(Nz::Time::Milliseconds(60));
+			lifetimeSystem.Update(Nz::Time::Milliseconds(60));
+
+			THEN("Only the enabled short-lived entity is destroyed")
+			{
+				CHECK_FALSE(registry.valid(shortLived));
+				CHECK(registry.valid(longLived));
+				CHECK(registry.valid(disabled));
+			}
+		}
+
+		WHEN("A disabled entity is enabled again")
+		{
+			lifetimeSystem.Update(Nz::Time::Seconds(1));
+			registry.remove<Nz::DisabledComponent>(disabled);
+
+			lifetimeSystem.Update(Nz::Time::Milliseconds(50));
+			CHECK(registry.valid(disabled));
+
+			lifetimeSystem.Update(Nz::Time::Milliseconds(60));
+
+			THEN("Its lifetime resumes from where it was")
+			{
+				CHECK_FALSE(registry.valid(disabled));
+			}
+		}
+
+		WHEN("Time passes")
+		{
+			lifetimeSystem.Update(Nz::Time::Milliseconds(50));
+
+			THEN("Remaining lifetimes decrease, except for disabled entities")
+			{
+				CHECK(registry.get<Nz::LifetimeComponent>(shortLived).GetRemainingLifeTime() == Nz::Time::Milliseconds(50));
+				CHECK(registry.get<Nz::LifetimeComponent>(shortLived).IsAlive());
+				CHECK(registry.get<Nz::LifetimeComponent>(longLived).GetRemainingLifeTime() == Nz::Time::Milliseconds(9950));
+				CHECK(registry.get<Nz::LifetimeComponent>(disabled).GetRemainingLifeTime() == Nz::Time::Milliseconds(100));
+			}
+		}
+
+		WHEN("A lifetime is decreased")
+		{
+			lifetimeSystem.Update(Nz::Time::Milliseconds(50));
+			registry.patch<Nz::LifetimeComponent>(longLived, [](Nz::LifetimeComponent& lifetime) { lifetime.DecreaseLifetime(Nz::Time::Milliseconds(9900)); });
+
+			CHECK(registry.get<Nz::LifetimeComponent>(longLived).GetRemainingLifeTime() == Nz::Time::Milliseconds(50));
+
+			lifetimeSystem.Update(Nz::Time::Milliseconds(60));
+
+			THEN("The entity expires earlier")
+			{
+				CHECK_FALSE(registry.valid(longLived));
+			}
+		}
+
+		WHEN("A component is copied to another registry")
+		{
+			lifetimeSystem.Update(Nz::Time::Milliseconds(50));
+
+			entt::registry otherRegistry;
+			entt::entity copy = otherRegistry.create();
+			otherRegistry.emplace<Nz::LifetimeComponent>(copy, registry.get<Nz::LifetimeComponent>(longLived));
+
+			lifetimeSystem.Update(Nz::Time::Milliseconds(50));
+
+			THEN("The copy doesn't follow the original system clock")
+			{
+				CHECK(registry.get<Nz::LifetimeComponent>(longLived).GetRemainingLifeTime() == Nz::Time::Milliseconds(9900));
+				CHECK(otherRegistry.get<Nz::LifetimeComponent>(copy).GetRemainingLifeTime() == Nz::Time::Milliseconds(9950));
+
+				Nz::LifetimeSystem otherLifetimeSystem(otherRegistry);
+				otherLifetimeSystem.Update(Nz::Time::Milliseconds(100));
+				CHECK(otherRegistry.get<Nz::LifetimeComponent>(copy).GetRemainingLifeTime() == Nz::Time::Milliseconds(9850));
+			}
+		}
+
+		WHEN("A lifetime is changed")
+		{
+			registry.patch<Nz::LifetimeComponent>(longLived, [](Nz::LifetimeComponent& lifetime) { lifetime = Nz::LifetimeComponent(Nz::Time::Milliseconds(10)); });
+			lifetimeSystem.Update(Nz::Time::Milliseconds(20));
+
+			THEN("The entity expires at its new time")
+			{
+				CHECK_FALSE(registry.valid(longLived));
+			}
+		}
+	}
+}
@@ -0,0 +1,89 @@
+#include <Nazara/Core/LinearAllocator.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <vector>
+
+SCENARIO("LinearAllocator", "[CORE][LINEARALLOCATOR]")
+{
+	GIVEN("A linear allocator with small blocks")
+	{
+		Nz::LinearAllocator allocator(256);
+		CHECK(allocator.GetBlockSize() == 256);
+		CHECK(allocator.GetCapacity() == 0);
+
+		WHEN("We allocate memory with different alignments")
+		{
+			void* first = allocator.Allocate(3, 1);
+			void* second = allocator.Allocate(16, 16);
+			void* third = allocator.Allocate(8, 64);
+
+			THEN("Allocations are aligned and don't overlap")
+			{
+				CHECK(reinterpret_cast<std::uintptr_t>(second) % 16 == 0);
+				CHECK(reinterpret_cast<std::uintptr_t>(third) % 64 == 0);
+				CHECK(static_cast<Nz::UInt8*>(second) >= static_cast<Nz::UInt8*>(first) + 3);
+				CHECK(static_cast<Nz::UInt8*>(third) >= static_cast<Nz::UInt8*>(second) + 16);
+				CHECK(allocator.GetAllocatedSize() == 27);
+				CHECK(allocator.GetCapacity() == 256);
+			}
+		}
+
+		WHEN("We allocate more than a block")
+		{
+			int* values = allocator.AllocateArray<int>(50);
+			for (int i = 0; i < 50; ++i)
+				values[i] = i;
+
+			int* otherValues = allocator.AllocateArray<int>(50);
+			for (int i = 0; i < 50; ++i)
+				otherValues[i] = -i;
+
+			Nz::UInt8* bigAllocation = allocator.AllocateArray<Nz::UInt8>(1000);
+
+			THEN("New blocks are allocated and previous allocations are kept")
+			{
+				REQUIRE(bigAllocation);
+				CHECK(allocator.GetCapacity() >= 256 + 256 + 1000);
+				for (int i = 0; i < 50; ++i)
+				{
+					CHECK(values[i] == i);
+					CHECK(otherValues[i] == -i);
+				}
+			}
+
+			AND_WHEN("We reset it")
+			{
+				std::size_t capacity = allocator.GetCapacity();
+				allocator.Reset();
+
+				THEN("Blocks are merged and the same allocations fit in it")
+				{
+					CHECK(allocator.GetAllocatedSize() == 0);
+					CHECK(allocator.GetCapacity() == capacity);
+
+					Nz::UInt8* first = static_cast<Nz::UInt8*>(allocator.Allocate(400));
+					Nz::UInt8* second = static_cast<Nz::UInt8*>(allocator.Allocate(1000));
+					CHECK(second >= first + 400);
+					CHECK(allocator.GetCapacity() == capacity);
+				}
+			}
+		}
+
+		WHEN("A standard container uses it")
+		{
+			std::vector<int, Nz::LinearStlAllocator<int>> values{ Nz::LinearStlAllocator<int>(allocator) };
+			for (int i = 0; i < 100; ++i)
+				values.push_back(i);
+
+			THEN("Its memory comes from the allocator")
+			{
+				CHECK(&values.get_allocator().GetAllocator() == &allocator);
+				CHECK(values.get_allocator() == Nz::LinearStlAllocator<float>(allocator));
+				CHECK(allocator.GetAllocatedSize() >= 100 * sizeof(int));
+
+				for (int i = 0; i < 100; ++i)
+					CHECK(values[i] == i);
+			}
+		}
+	}
+}
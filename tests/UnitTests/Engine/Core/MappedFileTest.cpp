@@ -0,0 +1,95 @@
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/MappedFile.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstring>
+#include <filesystem>
+#include <string_view>
+
+SCENARIO("MappedFile", "[CORE][MAPPEDFILE]")
+{
+	GIVEN("A file on disk")
+	{
+		constexpr std::string_view content = "Nazara memory-mapped file content";
+		REQUIRE(Nz::File::WriteWhole("MappedFile.txt", content.data(), content.size()));
+
+		WHEN("We map it")
+		{
+			Nz::MappedFile file("MappedFile.txt", Nz::FileAccessPattern::Sequential);
+			REQUIRE(file.IsOpen());
+
+			THEN("Its content is accessible in place")
+			{
+				CHECK(file.IsMemoryMapped());
+				CHECK(file.GetSize() == content.size());
+				REQUIRE(file.GetData() != nullptr);
+				CHECK(std::memcmp(file.GetData(), content.data(), content.size()) == 0);
+				CHECK(file.GetMappedPointer() == file.GetData());
+				CHECK(file.GetPath() == std::filesystem::absolute("MappedFile.txt"));
+			}
+
+			AND_THEN("It can be read as a stream")
+			{
+				char buffer[6] = {};
+				REQUIRE(file.Read(buffer, 6) == 6);
+				CHECK(std::string_view(buffer, 6) == "Nazara");
+
+				REQUIRE(file.SetCursorPos(content.size() - 7));
+				char end[16];
+				CHECK(file.Read(end, sizeof(end)) == 7);
+				CHECK(std::string_view(end, 7) == "content");
+				CHECK(file.EndOfStream());
+			}
+
+			AND_THEN("Hints can be given")
+			{
+				file.SetAccessPattern(Nz::FileAccessPattern::Random);
+				file.Prefetch(0, content.size());
+				file.Prefetch(content.size(), 42); //< out of range, ignored
+				CHECK(std::memcmp(file.GetData(), content.data(), content.size()) == 0);
+			}
+
+			AND_THEN("We close it")
+			{
+				file.Close();
+				CHECK_FALSE(file.IsOpen());
+				CHECK(file.GetData() == nullptr);
+			}
+		}
+
+		std::filesystem::remove("MappedFile.txt");
+	}
+
+	GIVEN("An empty file")
+	{
+		{
+			Nz::File emptyFile("EmptyMappedFile.txt", Nz::OpenMode::WriteOnly | Nz::OpenMode::Truncate);
+			REQUIRE(emptyFile.IsOpen());
+		}
+
+		WHEN("We map it")
+		{
+			Nz::MappedFile file("EmptyMappedFile.txt");
+
+			THEN("It is open but has no content")
+			{
+				CHECK(file.IsOpen());
+				CHECK(file.GetSize() == 0);
+				CHECK(file.GetData() == nullptr);
+				CHECK(file.EndOfStream());
+			}
+		}
+
+		std::filesystem::remove("EmptyMappedFile.txt");
+	}
+
+	GIVEN("A missing file")
+	{
+		Nz::MappedFile file;
+
+		THEN("It cannot be mapped")
+		{
+			CHECK_FALSE(file.Open("ThisFileDoesNotExist.txt"));
+			CHECK_FALSE(file.IsOpen());
+		}
+	}
+}
@@ -0,0 +1,65 @@
+#include <Nazara/Core/MemoryTracker.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+SCENARIO("MemoryTracker", "[CORE][MEMORYTRACKER]")
+{
+	GIVEN("The counters of a tag")
+	{
+		Nz::MemoryTracker::Stats initialStats = Nz::MemoryTracker::GetStats(Nz::MemoryTag::Audio);
+
+		WHEN("We record allocations and deallocations")
+		{
+			Nz::MemoryTracker::RecordAllocation(Nz::MemoryTag::Audio, 100);
+			Nz::MemoryTracker::RecordAllocation(Nz::MemoryTag::Audio, 50);
+			Nz::MemoryTracker::RecordDeallocation(Nz::MemoryTag::Audio, 100);
+
+			THEN("Live bytes, peak and rates are updated")
+			{
+				Nz::MemoryTracker::Stats stats = Nz::MemoryTracker::GetStats(Nz::MemoryTag::Audio);
+				CHECK(stats.liveBytes == initialStats.liveBytes + 50);
+				CHECK(stats.peakBytes >= initialStats.liveBytes + 150);
+				CHECK(stats.allocatedBytes - initialStats.allocatedBytes == 150);
+				CHECK(stats.allocationCount - initialStats.allocationCount == 2);
+				CHECK(stats.deallocationCount - initialStats.deallocationCount == 1);
+
+				Nz::MemoryTracker::ResetPeaks();
+				CHECK(Nz::MemoryTracker::GetStats(Nz::MemoryTag::Audio).peakBytes == stats.liveBytes);
+			}
+
+			Nz::MemoryTracker::RecordDeallocation(Nz::MemoryTag::Audio, 50);
+		}
+
+		WHEN("We set a budget")
+		{
+			Nz::MemoryTracker::SetBudget(Nz::MemoryTag::Audio, initialStats.liveBytes + 1000);
+			CHECK(Nz::MemoryTracker::GetBudget(Nz::MemoryTag::Audio) == initialStats.liveBytes + 1000);
+			CHECK_FALSE(Nz::MemoryTracker::IsOverBudget(Nz::MemoryTag::Audio));
+
+			Nz::MemoryTracker::RecordAllocation(Nz::MemoryTag::Audio, 2000);
+			CHECK(Nz::MemoryTracker::IsOverBudget(Nz::MemoryTag::Audio));
+
+			Nz::MemoryTracker::RecordDeallocation(Nz::MemoryTag::Audio, 2000);
+			CHECK_FALSE(Nz::MemoryTracker::IsOverBudget(Nz::MemoryTag::Audio));
+
+			Nz::MemoryTracker::SetBudget(Nz::MemoryTag::Audio, 0);
+		}
+
+		WHEN("We use a tracked allocator")
+		{
+			std::vector<int, Nz::TrackedAllocator<int, Nz::MemoryTag::Audio>> values;
+			for (int i = 0; i < 1000; ++i)
+				values.push_back(i);
+
+			CHECK(values[999] == 999);
+
+#if NAZARA_CORE_ENABLE_MEMORY_TRACKING
+			CHECK(Nz::MemoryTracker::GetStats(Nz::MemoryTag::Audio).liveBytes >= initialStats.liveBytes + 1000 * sizeof(int));
+
+			values.clear();
+			values.shrink_to_fit();
+			CHECK(Nz::MemoryTracker::GetStats(Nz::MemoryTag::Audio).liveBytes == initialStats.liveBytes);
+#endif
+		}
+	}
+}
@@ -0,0 +1,83 @@
+#include <Nazara/Core/MpscQueue.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <thread>
+#include <vector>
+
+SCENARIO("MpscQueue", "[CORE][MPSCQUEUE]")
+{
+	GIVEN("An empty queue")
+	{
+		Nz::MpscQueue<std::unique_ptr<int>> queue;
+
+		std::unique_ptr<int> value;
+		CHECK_FALSE(queue.Pop(value));
+
+		WHEN("We push values from the consumer thread")
+		{
+			for (int i = 0; i < 10; ++i)
+				queue.Push(std::make_unique<int>(i));
+
+			THEN("They are popped in order")
+			{
+				for (int i = 0; i < 10; ++i)
+				{
+					REQUIRE(queue.Pop(value));
+					REQUIRE(value);
+					CHECK(*value == i);
+				}
+
+				CHECK_FALSE(queue.Pop(value));
+			}
+		}
+
+		WHEN("We push values from multiple threads")
+		{
+			constexpr int ProducerCount = 4;
+			constexpr int ValuePerProducer = 10'000;
+
+			std::vector<std::thread> producers;
+			for (int producerIndex = 0; producerIndex < ProducerCount; ++producerIndex)
+			{
+				producers.emplace_back([&, producerIndex]
+				{
+					for (int i = 0; i < ValuePerProducer; ++i)
+						queue.Push(std::make_unique<int>(producerIndex * ValuePerProducer + i));
+				});
+			}
+
+			// Consume while producers are running
+			std::vector<int> lastValues(ProducerCount, -1);
+			int poppedCount = 0;
+			bool isOrdered = true;
+			while (poppedCount < ProducerCount * ValuePerProducer)
+			{
+				if (!queue.Pop(value))
+				{
+					std::this_thread::yield();
+					continue;
+				}
+
+				int producerIndex = *value / ValuePerProducer;
+				int localIndex = *value % ValuePerProducer;
+				if (localIndex <= lastValues[producerIndex])
+					isOrdered = false;
+
+				lastValues[producerIndex] = localIndex;
+				poppedCount++;
+			}
+
+			for (std::thread& producer : producers)
+				producer.join();
+
+			THEN("Every value was popped once, in the order of each producer")
+			{
+				CHECK(isOrdered);
+				for (int lastValue : lastValues)
+					CHECK(lastValue == ValuePerProducer - 1);
+
+				CHECK_FALSE(queue.Pop(value));
+			}
+		}
+	}
+}
@@ -117,6 +117,19 @@ SCENARIO("Handle", "[CORE][HandledObject][ObjectHandle]")
 			{
 				REQUIRE(!invalidHandle.IsValid());
 			}
+
+			AND_WHEN("Another object gets a handle after it died")
+			{
+				ObjectHandle_Test newTest(6);
+				Nz::ObjectHandle<ObjectHandle_Test> newHandle = newTest.CreateHandle();
+
+				THEN("The dead object handle should stay invalid")
+				{
+					CHECK(newHandle.GetObject() == &newTest);
+					CHECK(!invalidHandle.IsValid());
+					CHECK(invalidHandle.GetObject() == nullptr);
+				}
+			}
 		}
 	}
 
@@ -0,0 +1,135 @@
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/PackedArchive.hpp>
+#include <Nazara/Core/VirtualDirectory.hpp>
+#include <Nazara/Core/VirtualDirectoryArchiveResolver.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <set>
+#include <string>
+
+SCENARIO("PackedArchive", "[CORE][PACKEDARCHIVE]")
+{
+	std::filesystem::path sourceDir = std::filesystem::temp_directory_path() / "NazaraPackedArchiveTest";
+	std::filesystem::remove_all(sourceDir);
+	std::filesystem::create_directories(sourceDir / "data" / "sub");
+
+	std::string compressibleContent;
+	for (unsigned int i = 0; i < 1000; ++i)
+		compressibleContent += "Nazara Engine ";
+
+	std::string smallContent = "Hello";
+
+	REQUIRE(Nz::File::WriteWhole(sourceDir / "readme.txt", compressibleContent.data(), compressibleContent.size()));
+	REQUIRE(Nz::File::WriteWhole(sourceDir / "data" / "small.txt", smallContent.data(), smallContent.size()));
+	REQUIRE(Nz::File::WriteWhole(sourceDir / "data" / "sub" / "nested.txt", compressibleContent.data(), compressibleContent.size()));
+
+	std::filesystem::path archivePath = std::filesystem::temp_directory_path() / "NazaraPackedArchiveTest.nzpak";
+
+	for (Nz::ArchiveCompression compression : { Nz::ArchiveCompression::None, Nz::ArchiveCompression::LZ4, Nz::ArchiveCompression::Zstd })
+	{
+		GIVEN("An archive built with compression " + std::to_string(Nz::UnderlyingCast(compression)))
+		{
+			Nz::PackedArchive::BuildParams buildParams;
+			buildParams.alignment = 64;
+			buildParams.compression = compression;
+			REQUIRE(Nz::PackedArchive::Build(archivePath, sourceDir, buildParams));
+
+			std::shared_ptr<Nz::PackedArchive> archive = std::make_shared<Nz::PackedArchive>();
+			REQUIRE(archive->Open(archivePath));
+
+			WHEN("We look up its entries")
+			{
+				REQUIRE(archive->GetEntries().size() == 3);
+				CHECK(archive->GetEntries()[0].path == "data/small.txt");
+				CHECK(archive->GetEntries()[1].path == "data/sub/nested.txt");
+				CHECK(archive->GetEntries()[2].path == "readme.txt");
+
+				const Nz::PackedArchive::Entry* readmeEntry = archive->FindEntry("readme.txt");
+				REQUIRE(readmeEntry);
+				CHECK(readmeEntry->offset % 64 == 0);
+				CHECK(readmeEntry->size == compressibleContent.size());
+				CHECK(readmeEntry->compression == compression);
+				if (compression != Nz::ArchiveCompression::None)
+					CHECK(readmeEntry->storedSize < readmeEntry->size);
+
+				// Too small to be worth compressing
+				const Nz::PackedArchive::Entry* smallEntry = archive->FindEntry("data/small.txt");
+				REQUIRE(smallEntry);
+				CHECK(smallEntry->compression == Nz::ArchiveCompression::None);
+
+				CHECK_FALSE(archive->FindEntry("data"));
+				CHECK_FALSE(archive->FindEntry("missing.txt"));
+				CHECK(archive->HasDirectory("data"));
+				CHECK(archive->HasDirectory("data/sub"));
+				CHECK_FALSE(archive->HasDirectory("dat"));
+				CHECK_FALSE(archive->HasDirectory("readme.txt"));
+
+				THEN("Uncompressed entries are read in place")
+				{
+					std::shared_ptr<Nz::Stream> stream = archive->OpenEntry(*smallEntry);
+					REQUIRE(stream);
+					CHECK(stream->IsMemoryMapped());
+					CHECK(stream->GetSize() == smallContent.size());
+
+					std::string content(stream->GetSize(), '\0');
+					CHECK(stream->Read(content.data(), content.size()) == content.size());
+					CHECK(content == smallContent);
+				}
+			}
+
+			WHEN("We mount it in a virtual directory")
+			{
+				auto rootDir = std::make_shared<Nz::VirtualDirectory>();
+				rootDir->StoreDirectory("pak", std::make_shared<Nz::VirtualDirectoryArchiveResolver>(archive));
+
+				// The archive is kept alive by the resolver and the streams it opens
+				archive.reset();
+
+				THEN("Files can be read through it")
+				{
+					CHECK(rootDir->GetFileContent("pak/data/sub/nested.txt", [&](const void* data, std::size_t size)
+					{
+						return std::string(static_cast<const char*>(data), size) == compressibleContent;
+					}));
+
+					CHECK(rootDir->GetFileContent("pak/readme.txt", [&](const void* data, std::size_t size)
+					{
+						return std::string(static_cast<const char*>(data), size) == compressibleContent;
+					}));
+
+					CHECK(rootDir->Exists("pak/data/sub"));
+					CHECK_FALSE(rootDir->Exists("pak/data/missing.txt"));
+				}
+
+				AND_THEN("Directories can be listed")
+				{
+					std::set<std::string> files;
+					std::set<std::string> directories;
+					CHECK(rootDir->GetDirectoryEntry("pak/data", [&](const Nz::VirtualDirectory::DirectoryEntry& directoryEntry)
+					{
+						directoryEntry.directory->Foreach([&](std::string_view entryName, const Nz::VirtualDirectory::Entry& entry)
+						{
+							if (std::holds_alternative<Nz::VirtualDirectory::DirectoryEntry>(entry))
+								directories.emplace(entryName);
+							else
+								files.emplace(entryName);
+						});
+
+						return true;
+					}));
+
+					CHECK(files == std::set<std::string>{ "small.txt" });
+					CHECK(directories == std::set<std::string>{ "sub" });
+				}
+			}
+		}
+	}
+
+	WHEN("We open a file which isn't an archive")
+	{
+		Nz::PackedArchive archive;
+		CHECK_FALSE(archive.Open(sourceDir / "readme.txt"));
+	}
+
+	std::filesystem::remove(archivePath);
+	std::filesystem::remove_all(sourceDir);
+}
@@ -243,5 +243,62 @@ SCENARIO("ParameterList", "[CORE][PARAMETERLIST]")
 				CHECK(parameterList.HasParameter("str"));
 			}
 		}
+
+		WHEN("We look up parameters using string views")
+		{
+			std::string_view names = "string";
+
+			THEN("Only the exact name matches")
+			{
+				CHECK(parameterList.GetStringParameter(names.substr(0, 3)).GetValue() == "ing");
+				CHECK(!parameterList.HasParameter(names.substr(0, 2)));
+				CHECK(parameterList.GetIntegerParameter(std::string("i")).GetValue() == 3);
+			}
+		}
+
+		WHEN("We replace and remove values while iterating")
+		{
+			parameterList.SetParameter("str", 42LL);
+			parameterList.ForEach([](const Nz::ParameterList& /*list*/, const std::string& name)
+			{
+				return name == "d";
+			});
+
+			THEN("Parameters were updated")
+			{
+				std::size_t parameterCount = 0;
+				parameterList.ForEach([&](const Nz::ParameterList& /*list*/, const std::string& /*name*/) { parameterCount++; });
+
+				CHECK(parameterCount == 3);
+				CHECK(!parameterList.HasParameter("d"));
+				CHECK(parameterList.GetIntegerParameter("str").GetValue() == 42);
+				CHECK(parameterList.GetParameterType("toaster").GetValue() == Nz::ParameterType::None);
+			}
+		}
+	}
+
+	GIVEN("A parameter list with userdata")
+	{
+		static unsigned int destructorCallCount;
+		destructorCallCount = 0;
+
+		{
+			Nz::ParameterList parameterList;
+			parameterList.SetParameter("userdata", nullptr, [](void*) { destructorCallCount++; });
+
+			Nz::ParameterList copy = parameterList;
+			copy.SetParameter("other", 1LL);
+			copy.RemoveParameter("other");
+
+			Nz::ParameterList moved = std::move(copy);
+
+			CHECK(moved.HasParameter("userdata"));
+			CHECK(destructorCallCount == 0);
+		}
+
+		THEN("Userdata is destroyed once after every copy")
+		{
+			CHECK(destructorCallCount == 1);
+		}
 	}
 }
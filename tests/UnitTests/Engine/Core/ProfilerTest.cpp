@@ -0,0 +1,107 @@
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/MemoryStream.hpp>
+#include <Nazara/Core/Profiler.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <thread>
+
+SCENARIO("Profiler", "[CORE][PROFILER]")
+{
+	GIVEN("An enabled profiler")
+	{
+		Nz::Profiler::CollectZones(); //< discard previous zones
+		Nz::Profiler::Enable(true);
+
+		WHEN("We record nested zones from two threads")
+		{
+			{
+				Nz::ProfileScope outerScope("Outer");
+				{
+					Nz::ProfileScope innerScope("Inner");
+				}
+
+				std::thread thread([]
+				{
+					Nz::ProfileScope threadScope(Nz::Profiler::InternName(std::string("Thread") + "Zone"));
+				});
+				thread.join();
+			}
+
+			Nz::Profiler::Enable(false);
+
+			{
+				Nz::ProfileScope disabledScope("Disabled");
+			}
+
+			std::vector<Nz::Profiler::Zone> zones = Nz::Profiler::CollectZones();
+
+			THEN("Zones are collected in order")
+			{
+				REQUIRE(zones.size() == 3);
+				CHECK(std::string_view(zones[0].name) == "Outer");
+				CHECK(std::string_view(zones[1].name) == "Inner");
+				CHECK(std::string_view(zones[2].name) == "ThreadZone");
+
+				CHECK(zones[0].beginTime <= zones[1].beginTime);
+				CHECK(zones[1].endTime <= zones[0].endTime);
+				CHECK(zones[2].endTime <= zones[0].endTime);
+
+				CHECK(zones[0].threadIndex == zones[1].threadIndex);
+				CHECK(zones[0].threadIndex != zones[2].threadIndex);
+
+				CHECK(Nz::Profiler::CollectZones().empty());
+			}
+
+			AND_THEN("They can be exported as a Chrome trace")
+			{
+				Nz::ByteArray byteArray;
+				Nz::MemoryStream stream(&byteArray, Nz::OpenMode::WriteOnly);
+				REQUIRE(Nz::Profiler::ExportChromeTrace(stream, zones));
+
+				std::string trace(reinterpret_cast<const char*>(byteArray.GetConstBuffer()), byteArray.GetSize());
+				CHECK(trace.find(R"("traceEvents":[)") != std::string::npos);
+				CHECK(trace.find(R"({"name":"Outer","ph":"X")") != std::string::npos);
+				CHECK(trace.find(R"("name":"ThreadZone")") != std::string::npos);
+				CHECK(std::count(trace.begin(), trace.end(), '{') == 4);
+			}
+		}
+
+		WHEN("We intern the same name twice")
+		{
+			const char* name = Nz::Profiler::InternName("Pass");
+
+			THEN("The same pointer is returned")
+			{
+				CHECK(Nz::Profiler::InternName(std::string("Pa") + "ss") == name);
+			}
+		}
+
+		WHEN("A thread records more zones than its buffer can hold")
+		{
+			std::size_t previousBufferSize = Nz::Profiler::GetThreadBufferSize();
+			Nz::Profiler::SetThreadBufferSize(4);
+
+			Nz::UInt64 droppedZoneCount = Nz::Profiler::GetDroppedZoneCount();
+
+			std::thread thread([]
+			{
+				for (std::size_t i = 0; i < 6; ++i)
+					Nz::ProfileScope scope("Zone");
+			});
+			thread.join();
+
+			Nz::Profiler::SetThreadBufferSize(previousBufferSize);
+			Nz::Profiler::Enable(false);
+
+			THEN("Excess zones are dropped")
+			{
+				CHECK(Nz::Profiler::CollectZones().size() == 4);
+				CHECK(Nz::Profiler::GetDroppedZoneCount() - droppedZoneCount == 2);
+			}
+		}
+
+		Nz::Profiler::Enable(false);
+	}
+}
@@ -0,0 +1,206 @@
+#include <Nazara/Core/Resource.hpp>
+#include <Nazara/Core/ResourceManager.hpp>
+#include <Nazara/Core/ResourceParameters.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+std::filesystem::path GetAssetDir();
+
+namespace
+{
+	struct TestResourceParams : Nz::ResourceParameters
+	{
+		bool IsValid() const
+		{
+			return true;
+		}
+
+		int value = 0;
+	};
+
+	struct TestResource : Nz::Resource
+	{
+		std::size_t GetMemoryUsage() const override
+		{
+			return 100;
+		}
+
+		std::filesystem::path filePath;
+		int value;
+	};
+}
+
+SCENARIO("ResourceManager", "[CORE][RESOURCEMANAGER]")
+{
+	GIVEN("A resource manager with a slow loader")
+	{
+		std::atomic_uint loadCount = 0;
+
+		Nz::ResourceLoader<TestResource, TestResourceParams> loader;
+
+		Nz::ResourceLoader<TestResource, TestResourceParams>::Entry loaderEntry;
+		loaderEntry.extensionSupport = [](std::string_view extension) { return extension == ".png"; };
+		loaderEntry.fileLoader = [&](const std::filesystem::path& filePath, const TestResourceParams& parameters) -> Nz::Result<std::shared_ptr<TestResource>, Nz::ResourceLoadingError>
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			loadCount++;
+
+			auto resource = std::make_shared<TestResource>();
+			resource->filePath = filePath;
+			resource->value = parameters.value;
+
+			return resource;
+		};
+		loader.RegisterLoader(std::move(loaderEntry));
+
+		Nz::ResourceManager<TestResource, TestResourceParams> manager(loader);
+
+		TestResourceParams defaultParams;
+		defaultParams.value = 42;
+		manager.SetDefaultParameters(defaultParams);
+
+		std::filesystem::path filePath = GetAssetDir() / "Logo.png";
+
+		WHEN("We load the same file asynchronously twice")
+		{
+			unsigned int callbackCount = 0;
+			auto callback = [&](const std::shared_ptr<TestResource>& resource)
+			{
+				CHECK(resource);
+				callbackCount++;
+			};
+
+			auto firstHandle = manager.GetAsync(filePath, callback);
+			auto secondHandle = manager.GetAsync(filePath, callback);
+			CHECK(firstHandle.IsValid());
+			CHECK(secondHandle.IsValid());
+
+			std::shared_ptr<TestResource> resource = firstHandle.Wait();
+
+			THEN("The file was loaded once, with the default parameters")
+			{
+				REQUIRE(resource);
+				CHECK(loadCount == 1);
+				CHECK(resource->value == 42);
+				CHECK(firstHandle.IsFinished());
+				CHECK(secondHandle.IsFinished());
+				CHECK(secondHandle.GetResource() == resource);
+				CHECK(manager.Get(filePath) == resource);
+			}
+
+			AND_THEN("Callbacks are called by Update")
+			{
+				CHECK(callbackCount == 0);
+				manager.Update();
+				CHECK(callbackCount == 2);
+				manager.Update();
+				CHECK(callbackCount == 2);
+			}
+
+			AND_THEN("Loading it again gives the loaded resource immediately")
+			{
+				auto handle = manager.GetAsync(filePath, callback);
+				CHECK(callbackCount == 1);
+				CHECK(handle.IsFinished());
+				CHECK(handle.GetResource() == resource);
+				CHECK(loadCount == 1);
+			}
+
+			AND_THEN("Statistics reflect this")
+			{
+				auto statistics = manager.GetStatistics();
+				CHECK(statistics.hitCount == 1);
+				CHECK(statistics.missCount == 1);
+				CHECK(statistics.resourceCount == 1);
+				CHECK(statistics.memoryUsage == 100);
+			}
+		}
+
+		WHEN("We retrieve a file synchronously while it's being loaded")
+		{
+			auto handle = manager.GetAsync(filePath);
+			std::shared_ptr<TestResource> resource = manager.Get(filePath);
+
+			THEN("The pending load is used")
+			{
+				REQUIRE(resource);
+				CHECK(handle.IsFinished());
+				CHECK(handle.GetResource() == resource);
+				CHECK(loadCount == 1);
+			}
+		}
+
+		WHEN("We set a memory budget")
+		{
+			std::filesystem::path catPath = GetAssetDir() / "Audio/Cat.flac";
+			std::filesystem::path ambiencePath = GetAssetDir() / "Audio/ambience.ogg";
+
+			std::shared_ptr<TestResource> logo = manager.Get(filePath);
+			manager.Register(catPath, std::make_shared<TestResource>());
+			manager.Register(ambiencePath, std::make_shared<TestResource>());
+			CHECK(manager.GetStatistics().memoryUsage == 300);
+
+			// Logo is the least recently used resource, but it's still in use
+			manager.SetMemoryBudget(200);
+
+			THEN("The least recently used unused resource is evicted")
+			{
+				CHECK(manager.GetMemoryBudget() == 200);
+
+				auto statistics = manager.GetStatistics();
+				CHECK(statistics.evictionCount == 1);
+				CHECK(statistics.memoryUsage == 200);
+				CHECK(statistics.resourceCount == 2);
+				CHECK(manager.Get(filePath) == logo);
+			}
+
+			AND_THEN("Resources are evicted once they are no longer used")
+			{
+				logo.reset();
+				manager.Get(ambiencePath);
+				manager.Register(catPath, std::make_shared<TestResource>());
+				CHECK(manager.GetStatistics().evictionCount == 2);
+
+				std::shared_ptr<TestResource> reloadedLogo = manager.Get(filePath);
+				REQUIRE(reloadedLogo);
+				CHECK(loadCount == 2);
+
+				auto statistics = manager.GetStatistics();
+				CHECK(statistics.missCount == 2);
+				CHECK(statistics.evictionCount == 3);
+				CHECK(statistics.resourceCount == 2);
+			}
+
+			AND_THEN("Unused resources can be evicted explicitly")
+			{
+				CHECK(manager.EvictUnused() == 1);
+				CHECK(manager.GetStatistics().resourceCount == 1);
+
+				manager.ResetStatistics();
+				CHECK(manager.GetStatistics().evictionCount == 0);
+			}
+		}
+
+		WHEN("We load an unsupported file asynchronously")
+		{
+			bool called = false;
+			auto handle = manager.GetAsync(GetAssetDir() / "Audio/Cat.flac", [&](const std::shared_ptr<TestResource>& resource)
+			{
+				CHECK_FALSE(resource);
+				called = true;
+			});
+
+			THEN("The load fails")
+			{
+				CHECK_FALSE(handle.Wait());
+				CHECK_FALSE(handle.GetResource());
+
+				manager.Update();
+				CHECK(called);
+				CHECK(loadCount == 0);
+			}
+		}
+	}
+}
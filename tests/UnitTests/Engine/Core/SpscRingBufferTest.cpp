@@ -0,0 +1,89 @@
+#include <Nazara/Core/SpscRingBuffer.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <thread>
+
+SCENARIO("SpscRingBuffer", "[CORE][SPSCRINGBUFFER]")
+{
+	GIVEN("A ring buffer of 8 values")
+	{
+		Nz::SpscRingBuffer<int> ringBuffer(8);
+		CHECK(ringBuffer.GetCapacity() == 8);
+		CHECK(ringBuffer.GetReadableCount() == 0);
+		CHECK(ringBuffer.GetWritableCount() == 8);
+
+		WHEN("We write more values than it can hold")
+		{
+			std::array<int, 10> values = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+			CHECK(ringBuffer.Write(values.data(), values.size()) == 8);
+
+			THEN("It's full")
+			{
+				CHECK(ringBuffer.GetReadableCount() == 8);
+				CHECK(ringBuffer.GetWritableCount() == 0);
+				CHECK(ringBuffer.Write(values.data(), 1) == 0);
+			}
+
+			AND_THEN("Values are read back in order, across the end of the storage")
+			{
+				std::array<int, 10> readValues;
+				CHECK(ringBuffer.Read(readValues.data(), 5) == 5);
+				CHECK(ringBuffer.Write(&values[8], 2) == 2);
+				CHECK(ringBuffer.Read(&readValues[5], 10) == 5);
+
+				CHECK(readValues == values);
+				CHECK(ringBuffer.Read(readValues.data(), 1) == 0);
+			}
+		}
+
+		WHEN("A producer and a consumer run concurrently")
+		{
+			constexpr int ValueCount = 100'000;
+
+			std::thread producer([&]
+			{
+				std::array<int, 3> values;
+				int nextValue = 0;
+				while (nextValue < ValueCount)
+				{
+					std::size_t count = std::min<std::size_t>(values.size(), ValueCount - nextValue);
+					for (std::size_t i = 0; i < count; ++i)
+						values[i] = nextValue + int(i);
+
+					std::size_t writtenCount = ringBuffer.Write(values.data(), count);
+					if (writtenCount == 0)
+						std::this_thread::yield();
+
+					nextValue += int(writtenCount);
+				}
+			});
+
+			std::array<int, 5> readValues;
+			int expectedValue = 0;
+			bool isOrdered = true;
+			while (expectedValue < ValueCount)
+			{
+				std::size_t count = ringBuffer.Read(readValues.data(), readValues.size());
+				if (count == 0)
+				{
+					std::this_thread::yield();
+					continue;
+				}
+
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					if (readValues[i] != expectedValue++)
+						isOrdered = false;
+				}
+			}
+
+			producer.join();
+
+			THEN("Every value is received once and in order")
+			{
+				CHECK(isOrdered);
+				CHECK(ringBuffer.GetReadableCount() == 0);
+			}
+		}
+	}
+}
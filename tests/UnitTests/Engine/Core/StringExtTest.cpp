@@ -42,6 +42,42 @@ SCENARIO("String", "[CORE][STRING]")
 		CHECK(Nz::FromUtf32String(Nz::ToUtf32String(unicodeString)) == unicodeString);
 	}
 
+	WHEN("Decoding long mixed strings")
+	{
+		// Long enough to go through the ASCII fast path multiple times
+		std::string asciiString = "The quick brown fox jumps over the lazy dog";
+		std::string mixedString = asciiString + unicodeString + asciiString + unicodeString;
+
+		std::size_t characterCount = 2 * asciiString.size() + 2 * 7;
+		CHECK(Nz::ComputeCharacterCount(mixedString) == characterCount);
+		CHECK(Nz::GetCharacterPosition(mixedString, asciiString.size() + 7) == asciiString.size() + unicodeString.size());
+		CHECK(Nz::GetCharacterPosition(mixedString, characterCount) == mixedString.size());
+		CHECK(Nz::GetCharacterPosition(mixedString, characterCount + 1) == std::string::npos);
+
+		std::u32string utf32String = Nz::ToUtf32String(mixedString);
+		CHECK(utf32String.size() == characterCount);
+		CHECK(utf32String[asciiString.size() + 5] == U'\u5B98');
+		CHECK(Nz::FromUtf32String(utf32String) == mixedString);
+
+		std::u32string iteratedString;
+		Nz::IterateOnCodepoints(mixedString, [&](const char32_t* characters, std::size_t count)
+		{
+			iteratedString.append(characters, count);
+			return true;
+		});
+		CHECK(iteratedString == utf32String);
+	}
+
+	WHEN("Validating UTF-8")
+	{
+		CHECK(Nz::IsValidUtf8(""));
+		CHECK(Nz::IsValidUtf8("Nazara Engine, a fast cross-platform engine"));
+		CHECK(Nz::IsValidUtf8(unicodeString));
+		CHECK_FALSE(Nz::IsValidUtf8("Nazara Engine, a fast cross-platform engine\xC3"));
+		CHECK_FALSE(Nz::IsValidUtf8("\xC0\xAF")); //< overlong encoding
+		CHECK_FALSE(Nz::IsValidUtf8("\xED\xA0\x80")); //< surrogate
+	}
+
 	WHEN("Fetching words")
 	{
 		CHECK(Nz::GetWord({}, 0).empty());
@@ -0,0 +1,124 @@
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+SCENARIO("TaskScheduler", "[CORE][TASKSCHEDULER]")
+{
+	GIVEN("A task scheduler with four workers")
+	{
+		Nz::TaskScheduler scheduler(4);
+		CHECK(scheduler.GetWorkerCount() == 4);
+
+		WHEN("We add many tasks")
+		{
+			std::atomic_uint counter = 0;
+			for (unsigned int i = 0; i < 1000; ++i)
+				scheduler.AddTask([&] { counter++; });
+
+			scheduler.WaitForTasks();
+
+			THEN("They all ran")
+			{
+				CHECK(counter == 1000);
+			}
+		}
+
+		WHEN("We add tasks with dependencies")
+		{
+			std::atomic_uint order = 0;
+			unsigned int first = 0, second = 0, third = 0;
+
+			Nz::TaskScheduler::TaskHandle firstTask = scheduler.AddTask([&] { first = ++order; });
+			Nz::TaskScheduler::TaskHandle secondTask = scheduler.AddTask([&] { second = ++order; }, { firstTask });
+			Nz::TaskScheduler::TaskHandle thirdTask = scheduler.AddTask([&] { third = ++order; }, { firstTask, secondTask });
+
+			scheduler.WaitFor(thirdTask);
+
+			THEN("They ran in order")
+			{
+				CHECK(firstTask.IsFinished());
+				CHECK(secondTask.IsFinished());
+				CHECK(thirdTask.IsFinished());
+				CHECK(first == 1);
+				CHECK(second == 2);
+				CHECK(third == 3);
+			}
+		}
+
+		WHEN("A task spawns and waits for other tasks")
+		{
+			std::atomic_uint counter = 0;
+			Nz::TaskScheduler::TaskHandle parentTask = scheduler.AddTask([&]
+			{
+				std::vector<Nz::TaskScheduler::TaskHandle> childTasks;
+				for (unsigned int i = 0; i < 100; ++i)
+					childTasks.push_back(scheduler.AddTask([&] { counter++; }));
+
+				for (const Nz::TaskScheduler::TaskHandle& childTask : childTasks)
+					scheduler.WaitFor(childTask);
+			});
+
+			scheduler.WaitFor(parentTask);
+
+			THEN("Children ran before the parent finished")
+			{
+				CHECK(counter == 100);
+			}
+		}
+
+		WHEN("We add tasks to specific workers")
+		{
+			std::atomic_uint counter = 0;
+			std::vector<Nz::TaskScheduler::TaskHandle> tasks;
+			for (unsigned int i = 0; i < 100; ++i)
+				tasks.push_back(scheduler.AddTaskOnWorker([&] { counter++; }, i));
+
+			for (const Nz::TaskScheduler::TaskHandle& task : tasks)
+				scheduler.WaitFor(task);
+
+			THEN("They all ran")
+			{
+				CHECK(counter == 100);
+			}
+		}
+
+		WHEN("We process a range by chunks")
+		{
+			std::vector<unsigned int> values(10'007);
+			std::iota(values.begin(), values.end(), 0u);
+
+			std::vector<unsigned int> chunkSums((values.size() + 127) / 128);
+			scheduler.ForEachChunk(values.size(), 128, [&](std::size_t first, std::size_t last)
+			{
+				chunkSums[first / 128] = std::accumulate(values.begin() + first, values.begin() + last, 0u);
+			});
+
+			THEN("Every element was processed exactly once")
+			{
+				CHECK(std::accumulate(chunkSums.begin(), chunkSums.end(), 0u) == std::accumulate(values.begin(), values.end(), 0u));
+			}
+		}
+
+		WHEN("A task throws an exception")
+		{
+			bool dependentRan = false;
+
+			Nz::TaskScheduler::TaskHandle failingTask = scheduler.AddTask([] { throw std::runtime_error("task failure"); });
+			Nz::TaskScheduler::TaskHandle dependentTask = scheduler.AddTask([&] { dependentRan = true; }, { failingTask });
+
+			THEN("It is rethrown by WaitFor and its dependents still run")
+			{
+				CHECK_THROWS_AS(scheduler.WaitFor(failingTask), std::runtime_error);
+				CHECK(failingTask.IsFinished());
+
+				scheduler.WaitFor(dependentTask);
+				CHECK(dependentRan);
+
+				scheduler.WaitForTasks();
+			}
+		}
+	}
+}
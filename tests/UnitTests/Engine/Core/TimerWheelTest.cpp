@@ -0,0 +1,166 @@
+#include <Nazara/Core/TimerWheel.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <optional>
+#include <random>
+#include <vector>
+
+SCENARIO("TimerWheel", "[CORE][TIMERWHEEL]")
+{
+	GIVEN("A timer wheel with a few timers")
+	{
+		Nz::TimerWheel timerWheel(4, 1000);
+		CHECK(timerWheel.GetTimerCount() == 4);
+		CHECK(timerWheel.GetScheduledTimerCount() == 0);
+
+		std::vector<std::size_t> firedTimers;
+		auto Advance = [&](Nz::UInt32 time)
+		{
+			firedTimers.clear();
+			timerWheel.Advance(time, [&](std::size_t timerId) { firedTimers.push_back(timerId); });
+		};
+
+		WHEN("We schedule timers at different distances")
+		{
+			timerWheel.Schedule(0, 1010);
+			timerWheel.Schedule(1, 1300);
+			timerWheel.Schedule(2, 1000 + 20'000);
+			timerWheel.Schedule(3, 1000 + 2'000'000);
+			CHECK(timerWheel.GetScheduledTimerCount() == 4);
+
+			THEN("They fire when their deadline passed, not before")
+			{
+				Advance(1009);
+				CHECK(firedTimers.empty());
+
+				Advance(1010);
+				CHECK(firedTimers == std::vector<std::size_t>{ 0 });
+				CHECK_FALSE(timerWheel.IsScheduled(0));
+
+				Advance(1299);
+				CHECK(firedTimers.empty());
+
+				Advance(1500);
+				CHECK(firedTimers == std::vector<std::size_t>{ 1 });
+
+				Advance(1000 + 19'999);
+				CHECK(firedTimers.empty());
+
+				Advance(1000 + 20'000);
+				CHECK(firedTimers == std::vector<std::size_t>{ 2 });
+
+				Advance(1000 + 2'000'000);
+				CHECK(firedTimers == std::vector<std::size_t>{ 3 });
+				CHECK(timerWheel.GetScheduledTimerCount() == 0);
+			}
+		}
+
+		WHEN("We reschedule and cancel timers")
+		{
+			timerWheel.Schedule(0, 1100);
+			timerWheel.Schedule(1, 1100);
+			timerWheel.Schedule(0, 1200);
+			timerWheel.Cancel(1);
+			CHECK(timerWheel.GetScheduledTimerCount() == 1);
+
+			THEN("Only the last deadline is kept")
+			{
+				Advance(1150);
+				CHECK(firedTimers.empty());
+
+				Advance(1200);
+				CHECK(firedTimers == std::vector<std::size_t>{ 0 });
+			}
+		}
+
+		WHEN("We schedule a timer in the past")
+		{
+			timerWheel.Schedule(2, 900);
+
+			THEN("It fires on the next advance")
+			{
+				Advance(1000);
+				CHECK(firedTimers == std::vector<std::size_t>{ 2 });
+			}
+		}
+
+		WHEN("A timer is rescheduled from its callback")
+		{
+			timerWheel.Schedule(0, 1001);
+
+			std::size_t fireCount = 0;
+			timerWheel.Advance(1100, [&](std::size_t timerId)
+			{
+				fireCount++;
+				timerWheel.Schedule(timerId, timerWheel.GetCurrentTime() + 10);
+			});
+
+			THEN("It fires periodically")
+			{
+				CHECK(fireCount == 10);
+				CHECK(timerWheel.IsScheduled(0));
+				CHECK(timerWheel.GetDeadline(0) == 1101);
+			}
+		}
+	}
+
+	GIVEN("A timer wheel close to time wraparound")
+	{
+		Nz::TimerWheel timerWheel(1, 0xFFFFFF00);
+		timerWheel.Schedule(0, 0x100);
+
+		std::size_t fireCount = 0;
+		timerWheel.Advance(0xFF, [&](std::size_t) { fireCount++; });
+		CHECK(fireCount == 0);
+
+		timerWheel.Advance(0x100, [&](std::size_t) { fireCount++; });
+		CHECK(fireCount == 1);
+	}
+
+	GIVEN("Many random timers")
+	{
+		constexpr std::size_t TimerCount = 200;
+
+		std::mt19937 randomEngine(42);
+		std::uniform_int_distribution<Nz::UInt32> delayDistribution(0, 100'000);
+		std::uniform_int_distribution<Nz::UInt32> stepDistribution(1, 3'000);
+
+		Nz::UInt32 currentTime = 0xFFF00000;
+		Nz::TimerWheel timerWheel(TimerCount, currentTime);
+
+		std::vector<std::optional<Nz::UInt32>> deadlines(TimerCount);
+		for (std::size_t i = 0; i < TimerCount; ++i)
+		{
+			deadlines[i] = currentTime + delayDistribution(randomEngine);
+			timerWheel.Schedule(i, *deadlines[i]);
+		}
+
+		bool valid = true;
+		for (std::size_t step = 0; step < 200; ++step)
+		{
+			currentTime += stepDistribution(randomEngine);
+			timerWheel.Advance(currentTime, [&](std::size_t timerId)
+			{
+				// Timers must never fire early
+				if (!deadlines[timerId] || Nz::Int32(currentTime - *deadlines[timerId]) < 0)
+					valid = false;
+
+				deadlines[timerId].reset();
+
+				if (timerId % 2 == 0)
+				{
+					deadlines[timerId] = currentTime + delayDistribution(randomEngine);
+					timerWheel.Schedule(timerId, *deadlines[timerId]);
+				}
+			});
+
+			// Every expired timer must have fired (those rescheduled from the callback are at least due now)
+			for (std::size_t i = 0; i < TimerCount; ++i)
+			{
+				if (deadlines[i] && Nz::Int32(currentTime - *deadlines[i]) > 0)
+					valid = false;
+			}
+		}
+
+		CHECK(valid);
+	}
+}
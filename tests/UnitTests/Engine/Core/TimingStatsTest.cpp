@@ -0,0 +1,69 @@
+#include <Nazara/Core/TimingStats.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+SCENARIO("TimingStats", "[CORE][TIMINGSTATS]")
+{
+	GIVEN("Timing statistics with a budget")
+	{
+		Nz::TimingStats stats;
+		stats.SetBudget(Nz::Time::Milliseconds(2));
+
+		CHECK(stats.GetSampleCount() == 0);
+		CHECK(stats.GetAverageDuration() == Nz::Time::Zero());
+		CHECK(stats.GetMaxDuration() == Nz::Time::Zero());
+
+		WHEN("We add a few samples")
+		{
+			stats.AddSample(Nz::Time::Milliseconds(1));
+			stats.AddSample(Nz::Time::Milliseconds(3));
+			stats.AddSample(Nz::Time::Milliseconds(2));
+
+			THEN("They are aggregated")
+			{
+				CHECK(stats.GetSampleCount() == 3);
+				CHECK(stats.GetAverageDuration() == Nz::Time::Milliseconds(2));
+				CHECK(stats.GetMaxDuration() == Nz::Time::Milliseconds(3));
+				CHECK(stats.GetPeakDuration() == Nz::Time::Milliseconds(3));
+				CHECK(stats.GetLastDuration() == Nz::Time::Milliseconds(2));
+				CHECK(stats.GetOverBudgetCount() == 1);
+				CHECK_FALSE(stats.IsOverBudget());
+
+				const auto& histogram = stats.GetHistogram();
+				CHECK(histogram[Nz::TimingStats::GetHistogramBucket(Nz::Time::Milliseconds(1))] == 1);
+				CHECK(histogram[Nz::TimingStats::GetHistogramBucket(Nz::Time::Milliseconds(3))] == 1);
+			}
+
+			AND_THEN("Resetting them keeps the budget")
+			{
+				stats.Reset();
+				CHECK(stats.GetSampleCount() == 0);
+				CHECK(stats.GetPeakDuration() == Nz::Time::Zero());
+				CHECK(stats.GetBudget() == Nz::Time::Milliseconds(2));
+			}
+		}
+
+		WHEN("We add more samples than the window size")
+		{
+			stats.AddSample(Nz::Time::Milliseconds(10));
+			for (std::size_t i = 0; i < Nz::TimingStats::WindowSize; ++i)
+				stats.AddSample(Nz::Time::Milliseconds(1));
+
+			THEN("Old samples leave the rolling average and max, but not the peak")
+			{
+				CHECK(stats.GetAverageDuration() == Nz::Time::Milliseconds(1));
+				CHECK(stats.GetMaxDuration() == Nz::Time::Milliseconds(1));
+				CHECK(stats.GetPeakDuration() == Nz::Time::Milliseconds(10));
+				CHECK(stats.GetOverBudgetCount() == 1);
+			}
+		}
+	}
+
+	GIVEN("Histogram buckets")
+	{
+		CHECK(Nz::TimingStats::GetHistogramBucket(Nz::Time::Zero()) == 0);
+		CHECK(Nz::TimingStats::GetHistogramBucket(Nz::TimingStats::GetHistogramBucketLimit(0) - Nz::Time::Nanosecond()) == 0);
+		CHECK(Nz::TimingStats::GetHistogramBucket(Nz::TimingStats::GetHistogramBucketLimit(0)) == 1);
+		CHECK(Nz::TimingStats::GetHistogramBucket(Nz::TimingStats::GetHistogramBucketLimit(4)) == 5);
+		CHECK(Nz::TimingStats::GetHistogramBucket(Nz::Time::Seconds(10)) == Nz::TimingStats::HistogramBucketCount - 1);
+	}
+}
@@ -311,4 +311,35 @@ TEST_CASE("VirtualDirectory", "[Core][VirtualDirectory]")
 			CHECK(CheckFileHash(engineDir, "../Audio/The_Brabanconne.ogg", "E07706E0BEEC7770CDE36008826743AF9EEE5C80CA0BD83C37771CBC8B52E738"));
 		}
 	}
+
+	SECTION("Caching physical entries")
+	{
+		std::filesystem::path physicalDir = std::filesystem::temp_directory_path() / "NazaraVirtualDirectoryTest";
+		std::filesystem::remove_all(physicalDir);
+		std::filesystem::create_directories(physicalDir / "dir");
+
+		auto resolver = std::make_shared<Nz::VirtualDirectoryFilesystemResolver>(physicalDir);
+		std::shared_ptr<Nz::VirtualDirectory> virtualDir = std::make_shared<Nz::VirtualDirectory>(resolver);
+
+		// Missing files are not cached
+		CHECK_FALSE(virtualDir->Exists("dir/file.txt"));
+		REQUIRE(Nz::File::WriteWhole(physicalDir / "dir" / "file.txt", "Nazara", 6));
+		CHECK(virtualDir->Exists("dir"));
+		CHECK(virtualDir->Exists("dir/file.txt"));
+		CHECK(virtualDir->GetFileContent("dir/file.txt", [](const void* data, std::size_t size)
+		{
+			return std::string_view(static_cast<const char*>(data), size) == "Nazara";
+		}));
+
+		// Resolved entries are kept until the cache is cleared
+		std::filesystem::remove_all(physicalDir / "dir");
+		CHECK(virtualDir->Exists("dir/file.txt"));
+		CHECK(virtualDir->Exists("dir"));
+
+		resolver->ClearCache();
+		CHECK_FALSE(virtualDir->Exists("dir/file.txt"));
+		CHECK_FALSE(virtualDir->Exists("dir"));
+
+		std::filesystem::remove_all(physicalDir);
+	}
 }
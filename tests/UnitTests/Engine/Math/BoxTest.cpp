@@ -1,6 +1,7 @@
 #include <Nazara/Math/Box.hpp>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <array>
 
 SCENARIO("Box", "[MATH][BOX]")
 {
@@ -172,4 +173,50 @@ SCENARIO("Box", "[MATH][BOX]")
 			}
 		}
 	}
+
+	GIVEN("Some boxes and a transform matrix")
+	{
+		std::array<Nz::Boxf, 3> boxes = {
+			Nz::Boxf(0.f, 0.f, 0.f, 1.f, 2.f, 3.f),
+			Nz::Boxf(-5.f, 2.f, 1.f, 10.f, 0.5f, 4.f),
+			Nz::Boxf::Zero()
+		};
+
+		Nz::Matrix4f matrix = Nz::Matrix4f::Transform(Nz::Vector3f(1.f, -2.f, 3.f), Nz::EulerAnglesf(30.f, 60.f, 0.f), Nz::Vector3f(2.f, 1.f, 0.5f));
+
+		WHEN("We transform a box")
+		{
+			Nz::Boxf box = boxes[0];
+			box.Transform(Nz::Matrix4f::Transform(Nz::Vector3f::Zero(), Nz::EulerAnglesf(0.f, 0.f, 90.f), Nz::Vector3f(1.f, 3.f, 1.f)));
+
+			THEN("It encloses the transformed corners")
+			{
+				// Scale is applied first: (1, 6, 3) box rotated by 90 degrees around Z
+				CHECK(box.ApproxEqual(Nz::Boxf(-6.f, 0.f, 0.f, 6.f, 1.f, 3.f), 0.0001f));
+			}
+		}
+
+		WHEN("We transform them in a batch")
+		{
+			std::array<Nz::Boxf, 3> results;
+			Nz::Boxf::Transform(matrix, boxes.data(), results.data(), boxes.size());
+
+			std::array<Nz::Boxf, 3> directionResults = boxes;
+			Nz::Boxf::Transform(matrix, directionResults.data(), directionResults.data(), directionResults.size(), false);
+
+			THEN("We get the same results as one at a time")
+			{
+				for (std::size_t i = 0; i < boxes.size(); ++i)
+				{
+					Nz::Boxf expected = boxes[i];
+					expected.Transform(matrix);
+					CHECK(results[i].ApproxEqual(expected, 0.0001f));
+
+					Nz::Boxf expectedDirection = boxes[i];
+					expectedDirection.Transform(matrix, false);
+					CHECK(directionResults[i].ApproxEqual(expectedDirection, 0.0001f));
+				}
+			}
+		}
+	}
 }
@@ -1,6 +1,7 @@
 #include <Nazara/Math/Frustum.hpp>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <array>
 
 SCENARIO("Frustum", "[MATH][FRUSTUM]")
 {
@@ -44,6 +45,41 @@ SCENARIO("Frustum", "[MATH][FRUSTUM]")
 				CHECK(frustum.Intersect(outsideBox) == Nz::IntersectionSide::Outside);
 			}
 
+			GIVEN("Boxes tested in a batch")
+			{
+				std::array<Nz::Boxf, 4> boxes = {
+					Nz::Boxf(Nz::Vector3f::UnitX() * 50.f, Nz::Vector3f::Unit() * 10.f),
+					Nz::Boxf(Nz::Vector3f::Zero(), Nz::Vector3f::Unit() * 10.f),
+					Nz::Boxf(Nz::Vector3f::UnitX() * -50.f, Nz::Vector3f::Unit() * 10.f),
+					Nz::Boxf(Nz::Vector3f(995.f, 0.f, 0.f), Nz::Vector3f::Unit() * 10.f)
+				};
+
+				std::array<Nz::IntersectionSide, 4> sides;
+				frustum.Intersect(boxes.data(), boxes.size(), sides.data());
+
+				CHECK(sides[0] == Nz::IntersectionSide::Inside);
+				CHECK(sides[1] == Nz::IntersectionSide::Intersecting);
+				CHECK(sides[2] == Nz::IntersectionSide::Outside);
+				CHECK(sides[3] == Nz::IntersectionSide::Intersecting);
+			}
+
+			GIVEN("Nested boxes tested with a plane mask")
+			{
+				Nz::Boxf parentBox(Nz::Vector3f(990.f, -5.f, -5.f), Nz::Vector3f::Unit() * 20.f);
+				Nz::Boxf childBox(Nz::Vector3f(990.f, 0.f, 0.f), Nz::Vector3f::Unit() * 5.f);
+
+				Nz::FrustumPlaneFlags planeMask = Nz::FrustumPlane_All;
+				CHECK(frustum.Intersect(parentBox, &planeMask) == Nz::IntersectionSide::Intersecting);
+				CHECK(planeMask == Nz::FrustumPlaneFlags(Nz::FrustumPlane::Far));
+
+				Nz::FrustumPlaneFlags childPlaneMask = planeMask;
+				CHECK(frustum.Intersect(childBox, &childPlaneMask) == Nz::IntersectionSide::Inside);
+				CHECK(!childPlaneMask);
+
+				Nz::FrustumPlaneFlags emptyPlaneMask;
+				CHECK(frustum.Intersect(Nz::Boxf(Nz::Vector3f::UnitX() * -50.f, Nz::Vector3f::Unit()), &emptyPlaneMask) == Nz::IntersectionSide::Inside);
+			}
+
 			THEN("These results are expected")
 			{
 				Nz::OrientedBoxf obb(Nz::Boxf(Nz::Vector3f::Zero(), Nz::Vector3f::Unit() * 0.9f));
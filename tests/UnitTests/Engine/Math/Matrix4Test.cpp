@@ -306,4 +306,62 @@ SCENARIO("Matrix4", "[MATH][MATRIX4]")
 			}
 		}
 	}
+
+	GIVEN("Some arrays of transform matrices and vectors")
+	{
+		std::array<Nz::Matrix4f, 3> left = {
+			Nz::Matrix4f::Transform(Nz::Vector3f(1.f, 2.f, 3.f), Nz::EulerAnglesf(30.f, 0.f, 0.f)),
+			Nz::Matrix4f::Transform(Nz::Vector3f(-4.f, 0.5f, 2.f), Nz::EulerAnglesf(0.f, 45.f, 10.f), Nz::Vector3f(2.f, 1.f, 0.5f)),
+			Nz::Matrix4f::Identity()
+		};
+
+		std::array<Nz::Matrix4f, 3> right = {
+			Nz::Matrix4f::Scale(Nz::Vector3f(3.f)),
+			Nz::Matrix4f::Transform(Nz::Vector3f(0.f, -1.f, 8.f), Nz::EulerAnglesf(-60.f, 20.f, 0.f)),
+			Nz::Matrix4f::Transform(Nz::Vector3f::Unit(), Nz::EulerAnglesf(0.f, 0.f, 90.f))
+		};
+
+		WHEN("We concatenate them in a batch")
+		{
+			std::array<Nz::Matrix4f, 3> results;
+			Nz::Matrix4f::Concatenate(left.data(), right.data(), results.data(), results.size());
+
+			std::array<Nz::Matrix4f, 3> transformResults = left;
+			Nz::Matrix4f::ConcatenateTransform(transformResults.data(), right.data(), transformResults.data(), transformResults.size());
+
+			THEN("We get the same results as one at a time")
+			{
+				for (std::size_t i = 0; i < results.size(); ++i)
+				{
+					CHECK(results[i].ApproxEqual(Nz::Matrix4f::Concatenate(left[i], right[i]), 0.0001f));
+					CHECK(transformResults[i].ApproxEqual(Nz::Matrix4f::ConcatenateTransform(left[i], right[i]), 0.0001f));
+				}
+			}
+		}
+
+		WHEN("We transform vectors in a batch")
+		{
+			std::array<Nz::Vector3f, 3> points = { Nz::Vector3f(1.f, 2.f, 3.f), Nz::Vector3f::Zero(), Nz::Vector3f(-5.f, 0.25f, 10.f) };
+			std::array<Nz::Vector4f, 3> vectors = { Nz::Vector4f(1.f, 2.f, 3.f, 1.f), Nz::Vector4f(0.f, 1.f, 0.f, 0.f), Nz::Vector4f(-5.f, 0.25f, 10.f, 2.f) };
+
+			std::array<Nz::Vector3f, 3> transformedPoints;
+			left[1].Transform(points.data(), transformedPoints.data(), points.size());
+
+			std::array<Nz::Vector3f, 3> transformedDirections = points;
+			left[1].Transform(transformedDirections.data(), transformedDirections.data(), transformedDirections.size(), 0.f);
+
+			std::array<Nz::Vector4f, 3> transformedVectors;
+			left[1].Transform(vectors.data(), transformedVectors.data(), vectors.size());
+
+			THEN("We get the same results as one at a time")
+			{
+				for (std::size_t i = 0; i < points.size(); ++i)
+				{
+					CHECK(transformedPoints[i].ApproxEqual(left[1].Transform(points[i]), 0.0001f));
+					CHECK(transformedDirections[i].ApproxEqual(left[1].Transform(points[i], 0.f), 0.0001f));
+					CHECK(transformedVectors[i].ApproxEqual(left[1].Transform(vectors[i]), 0.0001f));
+				}
+			}
+		}
+	}
 }
@@ -1,6 +1,7 @@
 #include <Nazara/Math/Quaternion.hpp>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <array>
 
 SCENARIO("Quaternion", "[MATH][QUATERNION]")
 {
@@ -170,6 +171,18 @@ SCENARIO("Quaternion", "[MATH][QUATERNION]")
 				REQUIRE(quaternionC.y == Catch::Approx(unitZ225.y));
 				REQUIRE(quaternionC.z == Catch::Approx(unitZ225.z));
 			}
+
+			AND_THEN("Slerping in a batch gives the same results")
+			{
+				std::array<Nz::Quaternionf, 3> from = { x10, x10, Nz::Quaternionf(Nz::DegreeAnglef(0.f), Nz::Vector3f::UnitZ()) };
+				std::array<Nz::Quaternionf, 3> to = { x30a, x30b, Nz::Quaternionf(Nz::DegreeAnglef(45.f), Nz::Vector3f::UnitZ()) };
+
+				std::array<Nz::Quaternionf, 3> results;
+				Nz::Quaternionf::Slerp(from.data(), to.data(), 0.25f, results.data(), results.size());
+
+				for (std::size_t i = 0; i < results.size(); ++i)
+					CHECK(results[i].ApproxEqual(Nz::Quaternionf::Slerp(from[i], to[i], 0.25f), 0.00001f));
+			}
 		}
 
 		WHEN("We get the rotation between two vectors")
@@ -0,0 +1,106 @@
+#include <Nazara/Network/ENetLz4Compressor.hpp>
+#include <Nazara/Network/ENetZstdCompressor.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+
+SCENARIO("ENetCompressor", "[NETWORK][ENETCOMPRESSOR]")
+{
+	auto CheckRoundTrip = [](Nz::ENetCompressor& compressor)
+	{
+		WHEN("Compressing redundant data split over multiple buffers")
+		{
+			std::string first = "PlayerUpdate{position=(0,0,0),rotation=(0,0,0,1),velocity=(0,0,0)};";
+			std::string second = first + first + first;
+
+			std::array<Nz::NetBuffer, 2> buffers;
+			buffers[0].data = first.data();
+			buffers[0].dataLength = first.size();
+			buffers[1].data = second.data();
+			buffers[1].dataLength = second.size();
+
+			std::size_t totalSize = first.size() + second.size();
+
+			std::vector<Nz::UInt8> compressed(totalSize);
+			std::size_t compressedSize = compressor.Compress(nullptr, buffers.data(), buffers.size(), totalSize, compressed.data(), compressed.size());
+
+			THEN("It is smaller and decompresses to the original data")
+			{
+				REQUIRE(compressedSize > 0);
+				CHECK(compressedSize < totalSize);
+
+				std::vector<Nz::UInt8> decompressed(totalSize);
+				std::size_t decompressedSize = compressor.Decompress(nullptr, compressed.data(), compressedSize, decompressed.data(), decompressed.size());
+				REQUIRE(decompressedSize == totalSize);
+				CHECK(std::string(reinterpret_cast<const char*>(decompressed.data()), decompressedSize) == first + second);
+			}
+		}
+
+		WHEN("Compressing random data")
+		{
+			std::mt19937 randomEngine(42);
+			std::uniform_int_distribution<unsigned int> distribution(0, 255);
+
+			std::vector<Nz::UInt8> data(256);
+			for (Nz::UInt8& value : data)
+				value = Nz::UInt8(distribution(randomEngine));
+
+			Nz::NetBuffer buffer;
+			buffer.data = data.data();
+			buffer.dataLength = data.size();
+
+			std::vector<Nz::UInt8> compressed(data.size());
+
+			THEN("It is reported as incompressible")
+			{
+				CHECK(compressor.Compress(nullptr, &buffer, 1, data.size(), compressed.data(), compressed.size()) == 0);
+			}
+		}
+
+		WHEN("Decompressing garbage")
+		{
+			std::array<Nz::UInt8, 8> garbage = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+			std::vector<Nz::UInt8> decompressed(64);
+
+			THEN("It fails")
+			{
+				CHECK(compressor.Decompress(nullptr, garbage.data(), garbage.size(), decompressed.data(), decompressed.size()) == 0);
+			}
+		}
+	};
+
+	GIVEN("A LZ4 compressor")
+	{
+		Nz::ENetLz4Compressor compressor;
+		CheckRoundTrip(compressor);
+	}
+
+	GIVEN("A Zstd compressor")
+	{
+		Nz::ENetZstdCompressor compressor;
+		CHECK_FALSE(compressor.HasDictionary());
+		CheckRoundTrip(compressor);
+	}
+
+	GIVEN("A Zstd compressor using a trained dictionary")
+	{
+		std::mt19937 randomEngine(1337);
+		std::uniform_int_distribution<int> distribution(0, 1000);
+
+		std::vector<std::vector<Nz::UInt8>> samples;
+		for (std::size_t i = 0; i < 1000; ++i)
+		{
+			std::string sample = "PlayerUpdate{id=" + std::to_string(i % 64) + ",health=" + std::to_string(distribution(randomEngine)) + ",position=(" + std::to_string(distribution(randomEngine)) + "," + std::to_string(distribution(randomEngine)) + ")}";
+			samples.emplace_back(sample.begin(), sample.end());
+		}
+
+		std::vector<Nz::UInt8> dictionary = Nz::ENetZstdCompressor::TrainDictionary(samples, 4 * 1024);
+		REQUIRE(!dictionary.empty());
+
+		Nz::ENetZstdCompressor compressor(Nz::ENetZstdCompressor::DefaultCompressionLevel, dictionary);
+		CHECK(compressor.HasDictionary());
+		CheckRoundTrip(compressor);
+	}
+}
@@ -0,0 +1,82 @@
+#include <Nazara/Network/ENetHost.hpp>
+#include <Nazara/Network/ENetPeer.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+namespace
+{
+	bool WaitForEvent(Nz::ENetHost& host, Nz::ENetEvent& event, Nz::ENetEventType eventType, Nz::ENetHost* otherHost)
+	{
+		for (std::size_t i = 0; i < 2000; ++i)
+		{
+			if (otherHost)
+			{
+				Nz::ENetEvent otherEvent;
+				otherHost->Service(&otherEvent, 0);
+			}
+
+			if (host.Service(&event, 1) > 0 && event.type == eventType)
+				return true;
+		}
+
+		return false;
+	}
+}
+
+SCENARIO("ENetPeer", "[NETWORK][ENETPEER]")
+{
+	GIVEN("Two connected hosts on the loopback interface")
+	{
+		Nz::ENetHost server;
+		REQUIRE(server.Create(Nz::IpAddress::LoopbackIpV4, 1));
+
+		Nz::ENetHost client;
+		REQUIRE(client.Create(Nz::NetProtocol::IPv4, 0, 1));
+
+		Nz::ENetPeer* serverPeer = client.Connect(server.GetBoundAddress());
+		REQUIRE(serverPeer);
+
+		Nz::ENetEvent event;
+		REQUIRE(WaitForEvent(server, event, Nz::ENetEventType::IncomingConnect, &client));
+		REQUIRE(WaitForEvent(client, event, Nz::ENetEventType::OutgoingConnect, &server));
+
+		WHEN("Path MTU discovery runs")
+		{
+			CHECK(serverPeer->GetPathMtu() <= Nz::UInt32(Nz::ENetConstants::ENetPeer_MtuProbeBase));
+
+			for (std::size_t i = 0; i < 2000 && serverPeer->GetPathMtu() < serverPeer->GetMtu(); ++i)
+			{
+				Nz::ENetEvent serverEvent;
+				server.Service(&serverEvent, 0);
+
+				Nz::ENetEvent clientEvent;
+				client.Service(&clientEvent, 1);
+			}
+
+			THEN("The negotiated MTU is confirmed by a probe")
+			{
+				CHECK(serverPeer->GetPathMtu() == serverPeer->GetMtu());
+
+				const Nz::ENetPeer::PathMtuStats& stats = serverPeer->GetPathMtuStats();
+				CHECK(stats.probeCount >= 1);
+				CHECK(stats.blackHoleCount == 0);
+			}
+
+			AND_THEN("Large packets are fragmented to the path MTU")
+			{
+				std::vector<Nz::UInt8> payload(5000, 0x42);
+				REQUIRE(serverPeer->Send(0, Nz::ENetPacketFlag_Reliable, Nz::NetPacket(1, payload.data(), payload.size())));
+
+				Nz::UInt32 fragmentLength = serverPeer->GetPathMtu() - sizeof(Nz::ENetProtocolHeader) - sizeof(Nz::ENetProtocolSendFragment);
+				Nz::UInt32 packetSize = Nz::UInt32(payload.size());
+
+				const Nz::ENetPeer::PathMtuStats& stats = serverPeer->GetPathMtuStats();
+				CHECK(stats.fragmentedPacketCount == 1);
+				CHECK(stats.fragmentCount == (packetSize + fragmentLength - 1) / fragmentLength);
+
+				REQUIRE(WaitForEvent(server, event, Nz::ENetEventType::Receive, &client));
+				CHECK(event.packet->data.GetDataSize() == packetSize);
+			}
+		}
+	}
+}
@@ -2,6 +2,7 @@
 #include <Nazara/Network/IpAddress.hpp>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <future>
 
 SCENARIO("IpAddress", "[NETWORK][IPADDRESS]")
 {
@@ -152,5 +153,42 @@ SCENARIO("IpAddress", "[NETWORK][IPADDRESS]")
 				CHECK(dnsCheck);
 			}
 		}
+
+		WHEN("We resolve a hostname asynchronously")
+		{
+			Nz::IpAddress::ClearResolveCache();
+
+			std::promise<std::pair<std::vector<Nz::HostnameInfo>, Nz::ResolveError>> resolvePromise;
+			std::future<std::pair<std::vector<Nz::HostnameInfo>, Nz::ResolveError>> resolveFuture = resolvePromise.get_future();
+
+			Nz::IpAddress::ResolveHostnameAsync(Nz::NetProtocol::IPv4, "localhost", "http", [&](std::vector<Nz::HostnameInfo> results, Nz::ResolveError error)
+			{
+				resolvePromise.set_value({ std::move(results), error });
+			});
+
+			auto resolveResult = resolveFuture.get();
+			const std::vector<Nz::HostnameInfo>& results = resolveResult.first;
+			Nz::ResolveError error = resolveResult.second;
+
+			THEN("Localhost resolves to the loopback address")
+			{
+				CHECK(error == Nz::ResolveError::NoError);
+				REQUIRE_FALSE(results.empty());
+				CHECK(results.front().address.IsLoopback());
+			}
+
+			AND_THEN("The hostname is cached")
+			{
+				bool calledImmediately = false;
+				Nz::IpAddress::ResolveHostnameAsync(Nz::NetProtocol::IPv4, "localhost", "http", [&](std::vector<Nz::HostnameInfo> cachedResults, Nz::ResolveError cachedError)
+				{
+					calledImmediately = true;
+					CHECK(cachedError == Nz::ResolveError::NoError);
+					CHECK(cachedResults.size() == results.size());
+				});
+
+				CHECK(calledImmediately);
+			}
+		}
 	}
 }
@@ -0,0 +1,231 @@
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/ByteStream.hpp>
+#include <Nazara/Network/SnapshotReceiver.hpp>
+#include <Nazara/Network/SnapshotReplicator.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <optional>
+#include <vector>
+
+namespace
+{
+	struct ReplicatedPosition
+	{
+		float x = 0.f;
+		float y = 0.f;
+	};
+
+	struct ReplicatedHealth
+	{
+		unsigned int value = 0;
+	};
+
+	std::optional<Nz::UInt32> TransferSnapshot(Nz::SnapshotReplicator& replicator, std::size_t clientIndex, Nz::SnapshotReceiver& receiver, std::size_t* byteCount = nullptr)
+	{
+		Nz::ByteArray buffer;
+		Nz::ByteStream writeStream(&buffer, Nz::OpenMode::WriteOnly);
+		std::size_t size = replicator.BuildSnapshot(clientIndex, writeStream, Nz::Time::Milliseconds(50));
+		if (byteCount)
+			*byteCount = size;
+
+		Nz::ByteStream readStream(buffer.GetConstBuffer(), buffer.GetSize());
+		return receiver.ProcessSnapshot(readStream);
+	}
+}
+
+SCENARIO("SnapshotReplicator", "[NETWORK][SNAPSHOTREPLICATOR]")
+{
+	Nz::SnapshotSchema schema;
+	schema.RegisterComponent<ReplicatedPosition>({ 16, 16 }, [](const ReplicatedPosition& position, Nz::UInt32* fields)
+	{
+		fields[0] = Nz::SnapshotSchema::QuantizeFloat(position.x, -100.f, 100.f, 16);
+		fields[1] = Nz::SnapshotSchema::QuantizeFloat(position.y, -100.f, 100.f, 16);
+	},
+	[](ReplicatedPosition& position, const Nz::UInt32* fields)
+	{
+		position.x = Nz::SnapshotSchema::DequantizeFloat(fields[0], -100.f, 100.f, 16);
+		position.y = Nz::SnapshotSchema::DequantizeFloat(fields[1], -100.f, 100.f, 16);
+	});
+
+	schema.RegisterComponent<ReplicatedHealth>({ 8 }, [](const ReplicatedHealth& health, Nz::UInt32* fields)
+	{
+		fields[0] = health.value;
+	},
+	[](ReplicatedHealth& health, const Nz::UInt32* fields)
+	{
+		health.value = fields[0];
+	});
+
+	entt::registry serverRegistry;
+	entt::registry clientRegistry;
+
+	Nz::SnapshotReplicator replicator(serverRegistry, schema);
+	Nz::SnapshotReceiver receiver(clientRegistry, schema);
+
+	std::vector<entt::entity> serverEntities;
+	for (unsigned int i = 0; i < 100; ++i)
+	{
+		entt::entity entity = serverRegistry.create();
+		serverRegistry.emplace<ReplicatedPosition>(entity, float(i % 10) * 10.f - 50.f, float(i / 10) * 10.f - 50.f);
+		if (i % 2 == 0)
+			serverRegistry.emplace<ReplicatedHealth>(entity, 100u);
+
+		replicator.Replicate(entity);
+		serverEntities.push_back(entity);
+	}
+
+	std::size_t clientIndex = replicator.AddClient();
+
+	auto GetClientEntity = [&](entt::entity serverEntity)
+	{
+		return receiver.GetEntity(replicator.GetNetworkId(serverEntity));
+	};
+
+	GIVEN("A first snapshot")
+	{
+		replicator.Update();
+
+		std::size_t fullSize;
+		std::optional<Nz::UInt32> ack = TransferSnapshot(replicator, clientIndex, receiver, &fullSize);
+		REQUIRE(ack);
+		CHECK(*ack == 1);
+
+		THEN("Every entity has been created on the client")
+		{
+			for (unsigned int i = 0; i < serverEntities.size(); ++i)
+			{
+				entt::entity clientEntity = GetClientEntity(serverEntities[i]);
+				REQUIRE(clientRegistry.valid(clientEntity));
+
+				const ReplicatedPosition& position = clientRegistry.get<ReplicatedPosition>(clientEntity);
+				CHECK(position.x == Catch::Approx(serverRegistry.get<ReplicatedPosition>(serverEntities[i]).x).margin(0.01f));
+				CHECK(position.y == Catch::Approx(serverRegistry.get<ReplicatedPosition>(serverEntities[i]).y).margin(0.01f));
+				CHECK(clientRegistry.all_of<ReplicatedHealth>(clientEntity) == (i % 2 == 0));
+			}
+		}
+
+		WHEN("A few entities change after the snapshot was acknowledged")
+		{
+			replicator.HandleAcknowledgement(clientIndex, *ack);
+
+			serverRegistry.get<ReplicatedPosition>(serverEntities[3]).x += 1.f;
+			serverRegistry.get<ReplicatedHealth>(serverEntities[4]).value = 42;
+			serverRegistry.remove<ReplicatedHealth>(serverEntities[6]);
+
+			Nz::UInt32 destroyedNetworkId = replicator.GetNetworkId(serverEntities[7]);
+			entt::entity destroyedEntity = GetClientEntity(serverEntities[7]);
+			serverRegistry.destroy(serverEntities[7]);
+			replicator.Update();
+
+			std::size_t deltaSize;
+			ack = TransferSnapshot(replicator, clientIndex, receiver, &deltaSize);
+			REQUIRE(ack);
+
+			THEN("Only the changes are sent")
+			{
+				CHECK(deltaSize * 10 < fullSize);
+
+				CHECK(clientRegistry.get<ReplicatedPosition>(GetClientEntity(serverEntities[3])).x == Catch::Approx(serverRegistry.get<ReplicatedPosition>(serverEntities[3]).x).margin(0.01f));
+				CHECK(clientRegistry.get<ReplicatedHealth>(GetClientEntity(serverEntities[4])).value == 42);
+				CHECK_FALSE(clientRegistry.all_of<ReplicatedHealth>(GetClientEntity(serverEntities[6])));
+				CHECK(receiver.GetEntity(destroyedNetworkId) == entt::entity(entt::null));
+				CHECK_FALSE(clientRegistry.valid(destroyedEntity));
+			}
+		}
+
+		WHEN("Snapshots are lost or not acknowledged")
+		{
+			replicator.HandleAcknowledgement(clientIndex, *ack);
+
+			serverRegistry.get<ReplicatedPosition>(serverEntities[0]).x = 10.f;
+			replicator.Update();
+
+			Nz::ByteArray lostSnapshot;
+			Nz::ByteStream lostStream(&lostSnapshot, Nz::OpenMode::WriteOnly);
+			replicator.BuildSnapshot(clientIndex, lostStream, Nz::Time::Milliseconds(50));
+
+			serverRegistry.get<ReplicatedPosition>(serverEntities[0]).x = 0.f;
+			serverRegistry.get<ReplicatedPosition>(serverEntities[1]).x = 20.f;
+			replicator.Update();
+
+			ack = TransferSnapshot(replicator, clientIndex, receiver);
+			REQUIRE(ack);
+
+			THEN("The client still converges to the server state")
+			{
+				CHECK(*ack == 3);
+				CHECK(clientRegistry.get<ReplicatedPosition>(GetClientEntity(serverEntities[0])).x == Catch::Approx(0.f).margin(0.01f));
+				CHECK(clientRegistry.get<ReplicatedPosition>(GetClientEntity(serverEntities[1])).x == Catch::Approx(20.f).margin(0.01f));
+			}
+
+			AND_THEN("The lost snapshot is ignored if it arrives late")
+			{
+				Nz::ByteStream readStream(lostSnapshot.GetConstBuffer(), lostSnapshot.GetSize());
+				CHECK_FALSE(receiver.ProcessSnapshot(readStream));
+			}
+		}
+
+		WHEN("The client view only covers a corner")
+		{
+			replicator.HandleAcknowledgement(clientIndex, *ack);
+
+			replicator.SetPositionCallback([](const entt::registry& registry, entt::entity entity)
+			{
+				const ReplicatedPosition& position = registry.get<ReplicatedPosition>(entity);
+				return Nz::Vector3f(position.x, position.y, 0.f);
+			});
+			replicator.SetClientView(clientIndex, Nz::Vector3f(-50.f, -50.f, 0.f), 15.f);
+			replicator.Update();
+
+			REQUIRE(TransferSnapshot(replicator, clientIndex, receiver));
+
+			THEN("Entities out of view are despawned")
+			{
+				for (entt::entity serverEntity : serverEntities)
+				{
+					const ReplicatedPosition& position = serverRegistry.get<ReplicatedPosition>(serverEntity);
+					bool isInView = Nz::Vector3f(position.x, position.y, 0.f).Distance(Nz::Vector3f(-50.f, -50.f, 0.f)) <= 15.f;
+
+					CHECK(clientRegistry.valid(GetClientEntity(serverEntity)) == isInView);
+				}
+			}
+		}
+
+		WHEN("The client bandwidth is limited")
+		{
+			replicator.HandleAcknowledgement(clientIndex, *ack);
+			replicator.SetClientBandwidth(clientIndex, 2000); //< 100 bytes per snapshot
+
+			for (entt::entity serverEntity : serverEntities)
+				serverRegistry.get<ReplicatedPosition>(serverEntity).y += 1.f;
+
+			replicator.Update();
+
+			std::size_t limitedSize;
+			ack = TransferSnapshot(replicator, clientIndex, receiver, &limitedSize);
+			REQUIRE(ack);
+
+			THEN("Snapshots stay within the budget until every entity is up to date")
+			{
+				// unused budget can be spent by later snapshots, each one also starts with its size
+				std::size_t totalSize = limitedSize;
+				CHECK(totalSize <= 100 + sizeof(Nz::UInt32));
+
+				for (unsigned int i = 1; i <= 20; ++i)
+				{
+					replicator.HandleAcknowledgement(clientIndex, *ack);
+					replicator.Update();
+
+					ack = TransferSnapshot(replicator, clientIndex, receiver, &limitedSize);
+					REQUIRE(ack);
+
+					totalSize += limitedSize;
+					CHECK(totalSize <= (i + 1) * (100 + sizeof(Nz::UInt32)));
+				}
+
+				for (entt::entity serverEntity : serverEntities)
+					CHECK(clientRegistry.get<ReplicatedPosition>(GetClientEntity(serverEntity)).y == Catch::Approx(serverRegistry.get<ReplicatedPosition>(serverEntity).y).margin(0.01f));
+			}
+		}
+	}
+}
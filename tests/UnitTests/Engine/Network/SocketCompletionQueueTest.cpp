@@ -0,0 +1,130 @@
+#include <Nazara/Network/SocketCompletionQueue.hpp>
+#include <Nazara/Network/TcpClient.hpp>
+#include <Nazara/Network/TcpServer.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <chrono>
+#include <optional>
+#include <random>
+#include <string>
+
+SCENARIO("SocketCompletionQueue", "[NETWORK][SOCKETCOMPLETIONQUEUE]")
+{
+	GIVEN("A TcpServer accepting clients through a completion queue")
+	{
+		Nz::SocketCompletionQueue completionQueue;
+		REQUIRE(completionQueue.Create(1024, 16));
+
+		std::random_device rd;
+		std::uniform_int_distribution<Nz::UInt16> dis(1025, 65535);
+
+		Nz::UInt16 port = dis(rd);
+		Nz::TcpServer server;
+		REQUIRE(server.Listen(Nz::NetProtocol::IPv4, port) == Nz::SocketState::Bound);
+
+		std::optional<Nz::TcpClient> serverToClient;
+		REQUIRE(completionQueue.StartAccepting(server, [&](Nz::TcpClient&& client)
+		{
+			serverToClient = std::move(client);
+		}));
+
+		auto ProcessUntil = [&](auto&& condition)
+		{
+			auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+			while (!condition() && std::chrono::steady_clock::now() < deadline)
+				completionQueue.Process(100);
+
+			return condition();
+		};
+
+		Nz::TcpClient clientToServer;
+		REQUIRE(clientToServer.Connect(Nz::IpAddress(Nz::IpAddress::LoopbackIpV4.ToIPv4(), port)) == Nz::SocketState::Connected);
+
+		REQUIRE(ProcessUntil([&] { return serverToClient.has_value(); }));
+		CHECK(serverToClient->GetState() == Nz::SocketState::Connected);
+		CHECK(serverToClient->GetRemoteAddress().IsLoopback());
+
+		WHEN("Receiving data on the server side")
+		{
+			std::string received;
+			std::optional<Nz::SocketError> receiveEnd;
+			REQUIRE(completionQueue.StartReceiving(*serverToClient, [&](const void* data, std::size_t size, Nz::SocketError error)
+			{
+				if (error == Nz::SocketError::NoError)
+					received.append(static_cast<const char*>(data), size);
+				else
+					receiveEnd = error;
+			}));
+
+			std::string message = "Hello from the client";
+			REQUIRE(clientToServer.Send(message.data(), message.size(), nullptr));
+
+			THEN("Data is received")
+			{
+				CHECK(ProcessUntil([&] { return received.size() >= message.size(); }));
+				CHECK(received == message);
+			}
+
+			AND_WHEN("The client disconnects")
+			{
+				clientToServer.Disconnect();
+
+				THEN("The end of the connection is reported")
+				{
+					REQUIRE(ProcessUntil([&] { return receiveEnd.has_value(); }));
+					CHECK(*receiveEnd == Nz::SocketError::ConnectionClosed);
+					CHECK(received == message);
+				}
+			}
+
+			completionQueue.Stop(*serverToClient);
+		}
+
+		WHEN("Sending data from the server side")
+		{
+			std::string message(100'000, 'N');
+			for (std::size_t i = 0; i < message.size(); ++i)
+				message[i] = static_cast<char>('A' + i % 26);
+
+			std::size_t firstSent = 0;
+			std::size_t secondSent = 0;
+			REQUIRE(completionQueue.Send(*serverToClient, message.data(), message.size() / 2, [&](std::size_t sent, Nz::SocketError error)
+			{
+				CHECK(error == Nz::SocketError::NoError);
+				firstSent = sent;
+			}));
+
+			REQUIRE(completionQueue.Send(*serverToClient, message.data() + message.size() / 2, message.size() - message.size() / 2, [&](std::size_t sent, Nz::SocketError error)
+			{
+				CHECK(error == Nz::SocketError::NoError);
+				secondSent = sent;
+			}));
+
+			THEN("Data is sent entirely and in order")
+			{
+				std::string received;
+				std::array<char, 4096> buffer;
+
+				auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+				while ((received.size() < message.size() || secondSent == 0) && std::chrono::steady_clock::now() < deadline)
+				{
+					completionQueue.Process(10);
+
+					while (clientToServer.QueryAvailableBytes() > 0)
+					{
+						std::size_t read = clientToServer.Read(buffer.data(), buffer.size());
+						received.append(buffer.data(), read);
+					}
+				}
+
+				CHECK(firstSent == message.size() / 2);
+				CHECK(secondSent == message.size() - message.size() / 2);
+				CHECK(received == message);
+			}
+
+			completionQueue.Stop(*serverToClient);
+		}
+
+		completionQueue.Stop(server);
+	}
+}
@@ -5,6 +5,7 @@
 #include <Nazara/Network/TcpServer.hpp>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <array>
 #include <random>
 
 SCENARIO("SocketPoller", "[NETWORK][SOCKETPOLLER]")
@@ -82,4 +83,69 @@ SCENARIO("SocketPoller", "[NETWORK][SOCKETPOLLER]")
 			}
 		}
  	}
+
+	GIVEN("A TcpServer and a TcpClient registered with userdata")
+	{
+		std::random_device rd;
+		std::uniform_int_distribution<Nz::UInt16> dis(1025, 65535);
+
+		Nz::UInt16 port = dis(rd);
+		Nz::TcpServer server;
+		server.EnableBlocking(false);
+
+		REQUIRE(server.Listen(Nz::NetProtocol::IPv4, port) == Nz::SocketState::Bound);
+
+		int serverTag = 0;
+		int clientTag = 0;
+
+		Nz::SocketPoller poller;
+		REQUIRE(poller.RegisterSocket(server, Nz::SocketPollEvent::Read, &serverTag));
+
+		std::array<Nz::SocketPollerEvent, 4> events;
+
+		Nz::TcpClient clientToServer;
+		CHECK(clientToServer.Connect(Nz::IpAddress(Nz::IpAddress::LoopbackIpV4.ToIPv4(), port)) != Nz::SocketState::NotConnected);
+
+		WHEN("We wait for events")
+		{
+			unsigned int eventCount = poller.Wait(1000, events.data(), events.size());
+
+			THEN("Only the server socket is reported, along with its userdata")
+			{
+				REQUIRE(eventCount == 1);
+				CHECK(events[0].socket == server.GetNativeHandle());
+				CHECK(events[0].userdata == &serverTag);
+				CHECK(events[0].events == Nz::SocketPollEvent::Read);
+			}
+
+			AND_WHEN("We register the accepted client in edge-triggered mode and send data")
+			{
+				Nz::TcpClient serverToClient;
+				REQUIRE(server.AcceptClient(&serverToClient));
+				REQUIRE(poller.RegisterSocket(serverToClient, Nz::SocketPollEvent::Read, &clientTag, Nz::SocketPollMode::EdgeTriggered));
+
+				std::array<char, 5> buffer = {"Data"};
+				REQUIRE(clientToServer.Send(buffer.data(), buffer.size(), nullptr));
+
+				eventCount = poller.Wait(1000, events.data(), events.size());
+
+				THEN("The client socket is reported")
+				{
+					REQUIRE(eventCount == 1);
+					CHECK(events[0].socket == serverToClient.GetNativeHandle());
+					CHECK(events[0].userdata == &clientTag);
+					CHECK(events[0].events == Nz::SocketPollEvent::Read);
+
+					CHECK(serverToClient.Read(buffer.data(), buffer.size()) == buffer.size());
+
+					AND_THEN("No socket is reported once data has been read")
+					{
+						CHECK(poller.Wait(100, events.data(), events.size()) == 0);
+					}
+				}
+
+				poller.UnregisterSocket(serverToClient);
+			}
+		}
+	}
 }
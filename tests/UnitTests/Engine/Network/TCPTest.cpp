@@ -61,5 +61,47 @@ SCENARIO("TCP", "[NETWORK][TCP]")
 				CHECK(result == vector123);
 			}
 		}
+
+		WHEN("We queue packets from client")
+		{
+			std::size_t highWatermarkCount = 0;
+			std::size_t lowWatermarkCount = 0;
+			client.OnSendQueueHighWatermark.Connect([&](Nz::TcpClient*, std::size_t) { highWatermarkCount++; });
+			client.OnSendQueueLowWatermark.Connect([&](Nz::TcpClient*, std::size_t) { lowWatermarkCount++; });
+			client.SetSendQueueWatermarks(0, 32);
+
+			client.EnableCorking(true);
+			for (int i = 0; i < 10; ++i)
+			{
+				Nz::NetPacket packet(1);
+				packet << Nz::Vector3f(float(i), 0.f, 0.f);
+				REQUIRE(client.QueueSendPacket(packet));
+			}
+
+			CHECK(highWatermarkCount == 1);
+			CHECK(client.GetSendQueueSize() > 0);
+			REQUIRE(client.FlushSendQueue());
+			CHECK(client.GetSendQueueSize() > 0); //< corked
+
+			client.EnableCorking(false);
+			CHECK(client.GetSendQueueSize() == 0);
+			CHECK(lowWatermarkCount == 1);
+
+			std::this_thread::yield();
+
+			THEN("We should get them in order on the server")
+			{
+				for (int i = 0; i < 10; ++i)
+				{
+					Nz::NetPacket resultPacket;
+					REQUIRE(serverToClient.ReceivePacket(&resultPacket));
+
+					Nz::Vector3f result;
+					resultPacket >> result;
+
+					CHECK(result == Nz::Vector3f(float(i), 0.f, 0.f));
+				}
+			}
+		}
 	}
 }
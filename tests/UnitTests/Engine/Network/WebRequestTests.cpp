@@ -1,9 +1,11 @@
 #include <Nazara/Core/Clock.hpp>
 #include <Nazara/Core/StringExt.hpp>
 #include <Nazara/Network/Network.hpp>
+#include <Nazara/Network/WebCache.hpp>
 #include <Nazara/Network/WebRequest.hpp>
 #include <Nazara/Network/WebService.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <filesystem>
 #include <thread>
 
 SCENARIO("WebService", "[NETWORK][WebService]")
@@ -40,6 +42,44 @@ SCENARIO("WebService", "[NETWORK][WebService]")
 		WaitForRequest();
 	}
 
+	GIVEN("When performing a GET web request streaming its body")
+	{
+		std::string receivedData;
+		bool pausedOnce = false;
+		bool progressReported = false;
+
+		std::unique_ptr<Nz::WebRequest> webRequest = webService->CreateGetRequest("https://test.digitalpulse.software", [&](const Nz::WebRequestResult& result)
+		{
+			REQUIRE(result);
+			CHECK(result.GetStatusCode() == 200);
+			CHECK(result.GetBody().empty());
+		});
+		webRequest->SetStreamingDataCallback([&](const void* data, std::size_t length)
+		{
+			// Applies backpressure once, the same data is submitted again after that
+			if (!pausedOnce)
+			{
+				pausedOnce = true;
+				return Nz::WebRequestDataStatus::Pause;
+			}
+
+			receivedData.append(static_cast<const char*>(data), length);
+			return Nz::WebRequestDataStatus::Continue;
+		});
+		webRequest->SetProgressCallback([&](Nz::UInt64 downloadedSize, Nz::UInt64 /*totalSize*/)
+		{
+			if (downloadedSize > 0)
+				progressReported = true;
+		});
+		webService->QueueRequest(std::move(webRequest));
+
+		WaitForRequest();
+
+		CHECK(pausedOnce);
+		CHECK(progressReported);
+		CHECK(receivedData == "Hello Nazara from web!");
+	}
+
 	GIVEN("When performing a GET web request on a non-existing URL")
 	{
 		std::unique_ptr<Nz::WebRequest> webRequest = webService->CreateGetRequest("https://test.digitalpulse.software/404", [&](const Nz::WebRequestResult& result)
@@ -74,3 +114,66 @@ SCENARIO("WebService", "[NETWORK][WebService]")
 		WaitForRequest();
 	}
 }
+
+SCENARIO("WebCache", "[NETWORK][WebCache]")
+{
+	std::filesystem::path cacheDirectory = std::filesystem::temp_directory_path() / "NazaraWebCacheTest";
+	std::filesystem::remove_all(cacheDirectory);
+
+	Nz::WebCache cache(cacheDirectory);
+	CHECK(std::filesystem::is_directory(cacheDirectory));
+
+	const std::string url = "https://test.digitalpulse.software/manifest.json";
+
+	GIVEN("An empty cache")
+	{
+		CHECK_FALSE(cache.Load(url));
+
+		WHEN("We store an entry")
+		{
+			Nz::WebCache::Entry entry;
+			entry.body = "Hello Nazara from cache!";
+			entry.etag = "\"42\"";
+			entry.lastModified = "Wed, 21 Oct 2015 07:28:00 GMT";
+			entry.expirationTime = Nz::WebCache::GetCurrentTimestamp() + 60;
+
+			REQUIRE(cache.Store(url, entry));
+
+			THEN("It can be loaded back")
+			{
+				std::optional<Nz::WebCache::Entry> cachedEntry = cache.Load(url);
+				REQUIRE(cachedEntry);
+				CHECK(cachedEntry->body == entry.body);
+				CHECK(cachedEntry->etag == entry.etag);
+				CHECK(cachedEntry->lastModified == entry.lastModified);
+				CHECK(cachedEntry->expirationTime == entry.expirationTime);
+				CHECK(cachedEntry->IsFresh());
+
+				CHECK_FALSE(cache.Load(url + "?v=2"));
+			}
+
+			THEN("Expired entries are still loaded, to be revalidated")
+			{
+				entry.expirationTime = 0;
+				REQUIRE(cache.Store(url, entry));
+
+				std::optional<Nz::WebCache::Entry> cachedEntry = cache.Load(url);
+				REQUIRE(cachedEntry);
+				CHECK_FALSE(cachedEntry->IsFresh());
+				CHECK(cachedEntry->etag == entry.etag);
+			}
+
+			THEN("It can be removed")
+			{
+				cache.Remove(url);
+				CHECK_FALSE(cache.Load(url));
+
+				REQUIRE(cache.Store(url, entry));
+				cache.Clear();
+				CHECK_FALSE(cache.Load(url));
+			}
+		}
+	}
+
+	std::filesystem::remove_all(cacheDirectory);
+}
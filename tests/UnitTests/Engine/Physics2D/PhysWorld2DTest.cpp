@@ -190,6 +190,103 @@ SCENARIO("PhysWorld2D", "[PHYSICS2D][PHYSWORLD2D]")
 				CHECK(statusWallCollision == 3);
 			}
 		}
+
+		WHEN("We change the character from a collision callback")
+		{
+			float momentInCallback = 0.f;
+			characterTriggerCallback.startCallback = [&](Nz::ChipmunkPhysWorld2D&, Nz::ChipmunkArbiter2D&, Nz::ChipmunkRigidBody2D& bodyA, Nz::ChipmunkRigidBody2D& bodyB, void*) -> bool {
+				Nz::ChipmunkRigidBody2D& characterBody = (&bodyA == &character) ? bodyA : bodyB;
+				characterBody.SetMomentOfInertia(42.f);
+				momentInCallback = characterBody.GetMomentOfInertia();
+				return true;
+			};
+			world.RegisterCallbacks(CHARACTER_COLLISION_ID, TRIGGER_COLLISION_ID, characterTriggerCallback);
+
+			float initialMoment = character.GetMomentOfInertia();
+
+			character.SetVelocity(Nz::Vector2f(1.f, 0.f));
+			for (int i = 0; i != 11; ++i)
+				world.Step(Nz::Time::TickDuration(10));
+
+			THEN("The change should be applied once the step is over")
+			{
+				CHECK(momentInCallback == Catch::Approx(initialMoment));
+				CHECK(character.GetMomentOfInertia() == Catch::Approx(42.f));
+			}
+		}
+	}
+}
+
+SCENARIO("PhysWorld2D state snapshots", "[PHYSICS2D][PHYSWORLD2D]")
+{
+	GIVEN("A physic world with a stack of bodies falling on the ground")
+	{
+		Nz::ChipmunkPhysWorld2D world;
+		world.SetGravity(Nz::Vector2f(0.f, -9.81f));
+
+		std::vector<Nz::ChipmunkRigidBody2D> bodies;
+		bodies.reserve(4);
+		bodies.push_back(CreateBody(world, Nz::Vector2f(-10.f, -1.f), false, Nz::Vector2f(20.f, 1.f)));
+		for (int i = 0; i != 3; ++i)
+			bodies.push_back(CreateBody(world, Nz::Vector2f(0.f, 1.5f * i)));
+
+		auto StepWorld = [&]
+		{
+			for (int i = 0; i != 30; ++i)
+				world.Step(Nz::Time::TickDuration(60));
+		};
+
+		auto GetPositions = [&]
+		{
+			std::vector<Nz::Vector2f> positions;
+			for (const Nz::ChipmunkRigidBody2D& body : bodies)
+				positions.push_back(body.GetPosition());
+
+			return positions;
+		};
+
+		StepWorld();
+
+		for (bool delta : { false, true })
+		{
+			WHEN(delta ? "We save a delta snapshot and restore it" : "We save a full snapshot and restore it")
+			{
+				Nz::ChipmunkPhysWorld2D::StateSnapshot snapshot;
+				world.SaveState(snapshot, delta);
+				CHECK(snapshot.isDelta == delta);
+				CHECK(snapshot.bodies.size() == bodies.size());
+
+				std::vector<Nz::Vector2f> savedPositions = GetPositions();
+
+				StepWorld();
+				std::vector<Nz::Vector2f> futurePositions = GetPositions();
+				CHECK(futurePositions != savedPositions);
+
+				REQUIRE(world.RestoreState(snapshot));
+
+				THEN("Bodies are back to their previous state")
+				{
+					std::vector<Nz::Vector2f> restoredPositions = GetPositions();
+					for (std::size_t i = 0; i < bodies.size(); ++i)
+					{
+						CHECK(restoredPositions[i].x == Catch::Approx(savedPositions[i].x));
+						CHECK(restoredPositions[i].y == Catch::Approx(savedPositions[i].y));
+					}
+				}
+
+				AND_THEN("The simulation replays the same way")
+				{
+					StepWorld();
+
+					std::vector<Nz::Vector2f> replayedPositions = GetPositions();
+					for (std::size_t i = 0; i < bodies.size(); ++i)
+					{
+						CHECK(replayedPositions[i].x == Catch::Approx(futurePositions[i].x).margin(0.001f));
+						CHECK(replayedPositions[i].y == Catch::Approx(futurePositions[i].y).margin(0.001f));
+					}
+				}
+			}
+		}
 	}
 }
 
@@ -0,0 +1,163 @@
+#include <Nazara/Math/EulerAngles.hpp>
+#include <Nazara/Utility/Animation.hpp>
+#include <Nazara/Utility/CompressedAnimationTracks.hpp>
+#include <Nazara/Utility/Sequence.hpp>
+#include <Nazara/Utility/SkeletalPose.hpp>
+#include <Nazara/Utility/Skeleton.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <filesystem>
+#include <memory>
+
+SCENARIO("Animation compression", "[Utility][Animation]")
+{
+	constexpr std::size_t FrameCount = 120;
+	constexpr std::size_t JointCount = 3;
+
+	auto CreateAnimation = [&]
+	{
+		std::shared_ptr<Nz::Animation> animation = std::make_shared<Nz::Animation>();
+		animation->CreateSkeletal(FrameCount, JointCount);
+
+		Nz::Sequence sequence;
+		sequence.name = "Wave";
+		sequence.firstFrame = 0;
+		sequence.frameCount = FrameCount;
+		sequence.frameRate = 30;
+		animation->AddSequence(sequence);
+
+		for (std::size_t frame = 0; frame < FrameCount; ++frame)
+		{
+			float t = float(frame) / (FrameCount - 1);
+
+			Nz::SequenceJoint* sequenceJoints = animation->GetSequenceJoints(frame);
+
+			// Constant joint
+			sequenceJoints[0].position = Nz::Vector3f(0.f, 1.f, 0.f);
+			sequenceJoints[0].rotation = Nz::Quaternionf(Nz::EulerAnglesf(0.f, 30.f, 0.f));
+
+			// Linear joint
+			sequenceJoints[1].position = Nz::Vector3f(5.f * t, 0.f, -2.f * t);
+			sequenceJoints[1].scale = Nz::Vector3f(1.f + t);
+
+			// Waving joint
+			sequenceJoints[2].position = Nz::Vector3f(0.f, std::sin(t * 6.f), 0.f);
+			sequenceJoints[2].rotation = Nz::Quaternionf(Nz::EulerAnglesf(0.f, 0.f, 90.f * std::sin(t * 6.f)));
+		}
+
+		return animation;
+	};
+
+	std::shared_ptr<Nz::Animation> referenceAnimation = CreateAnimation();
+
+	auto CheckPoses = [&](const Nz::Animation& animation, float positionTolerance, float rotationTolerance)
+	{
+		Nz::SkeletalPose pose;
+		Nz::SkeletalPose referencePose;
+
+		for (std::size_t frame = 0; frame < FrameCount; frame += 7)
+		{
+			std::size_t nextFrame = (frame + 1) % FrameCount;
+			for (float interpolation : { 0.f, 0.3f, 0.8f })
+			{
+				animation.SamplePose(pose, frame, nextFrame, interpolation);
+				referenceAnimation->SamplePose(referencePose, frame, nextFrame, interpolation);
+
+				REQUIRE(pose.GetJointCount() == JointCount);
+				for (std::size_t i = 0; i < JointCount; ++i)
+				{
+					CHECK(pose.GetPositions()[i].Distance(referencePose.GetPositions()[i]) <= positionTolerance);
+					CHECK(std::abs(pose.GetRotations()[i].DotProduct(referencePose.GetRotations()[i])) >= std::cos(rotationTolerance * 0.5f));
+					CHECK(pose.GetScales()[i].x == Catch::Approx(referencePose.GetScales()[i].x).margin(0.01f));
+				}
+			}
+		}
+	};
+
+	GIVEN("A compressed animation")
+	{
+		std::shared_ptr<Nz::Animation> animation = CreateAnimation();
+
+		Nz::AnimationCompressionParams compressionParams;
+		compressionParams.positionTolerance = 0.005f;
+		compressionParams.rotationTolerance = 0.005f;
+		REQUIRE(animation->Compress(compressionParams));
+		CHECK(animation->IsCompressed());
+		CHECK(animation->GetFrameCount() == FrameCount);
+
+		const Nz::CompressedAnimationTracks* tracks = animation->GetCompressedTracks();
+		REQUIRE(tracks);
+		CHECK(tracks->Validate());
+
+		WHEN("Checking keys")
+		{
+			using Channel = Nz::CompressedAnimationTracks::Channel;
+
+			CHECK(tracks->GetTrack(0, Channel::Position).keyCount == 1);
+			CHECK(tracks->GetTrack(0, Channel::Rotation).keyCount == 1);
+			CHECK(tracks->GetTrack(0, Channel::Scale).keyCount == 1);
+			CHECK(tracks->GetTrack(1, Channel::Position).keyCount == 2);
+			CHECK(tracks->GetTrack(1, Channel::Scale).keyCount == 2);
+			CHECK(tracks->GetTrack(2, Channel::Position).keyCount > 2);
+			CHECK(tracks->GetTrack(2, Channel::Position).keyCount < FrameCount);
+
+			CHECK(tracks->GetMemoryUsage() * 8 < FrameCount * JointCount * sizeof(Nz::SequenceJoint));
+		}
+
+		WHEN("Sampling it")
+		{
+			// Quantization adds a little error on top of the tolerances
+			CheckPoses(*animation, 0.006f, 0.006f);
+		}
+
+		WHEN("Animating a skeleton")
+		{
+			Nz::Skeleton skeleton;
+			skeleton.Create(JointCount);
+
+			Nz::Skeleton referenceSkeleton;
+			referenceSkeleton.Create(JointCount);
+
+			animation->AnimateSkeleton(&skeleton, 10, 11, 0.5f);
+			referenceAnimation->AnimateSkeleton(&referenceSkeleton, 10, 11, 0.5f);
+
+			for (std::size_t i = 0; i < JointCount; ++i)
+				CHECK(skeleton.GetJoint(i)->GetPosition().Distance(referenceSkeleton.GetJoint(i)->GetPosition()) <= 0.006f);
+		}
+	}
+
+	GIVEN("An animation saved as nzanim")
+	{
+		REQUIRE(referenceAnimation->SaveToFile("wave.nzanim"));
+
+		Nz::Skeleton skeleton;
+		skeleton.Create(JointCount);
+
+		Nz::AnimationParams params;
+		params.skeleton = &skeleton;
+
+		std::shared_ptr<Nz::Animation> animation = Nz::Animation::LoadFromFile("wave.nzanim", params);
+		REQUIRE(animation);
+
+		CHECK(animation->IsCompressed());
+		CHECK(animation->GetFrameCount() == FrameCount);
+		CHECK(animation->GetJointCount() == JointCount);
+		REQUIRE(animation->GetSequenceCount() == 1);
+		CHECK(animation->GetSequence(0)->name == "Wave");
+		CHECK(animation->GetSequence(0)->frameRate == 30);
+
+		CheckPoses(*animation, 0.002f, 0.002f);
+
+		WHEN("Loading it with a mismatching skeleton")
+		{
+			Nz::Skeleton otherSkeleton;
+			otherSkeleton.Create(JointCount + 1);
+			params.skeleton = &otherSkeleton;
+
+			CHECK(!Nz::Animation::LoadFromFile("wave.nzanim", params));
+		}
+
+		std::filesystem::remove("wave.nzanim");
+	}
+}
@@ -149,4 +149,59 @@ SCENARIO("Fonts", "[Utility][Font]")
 			}
 		}
 	}
+
+	WHEN("Using signed distance field glyphs")
+	{
+		std::shared_ptr<Nz::Font> font = Nz::Font::GetDefault();
+
+		std::shared_ptr<Nz::GuillotineImageAtlas> imageAtlas = std::make_shared<Nz::GuillotineImageAtlas>();
+		imageAtlas->SetMaxLayerSize(1024);
+
+		font->SetAtlas(imageAtlas);
+		font->EnableSignedDistanceField(true);
+		CHECK(font->IsSignedDistanceFieldEnabled());
+
+		unsigned int referenceSize = font->GetSignedDistanceFieldReferenceSize();
+		unsigned int spread = font->GetSignedDistanceFieldSpread();
+
+		const auto& referenceGlyph = font->GetGlyph(referenceSize, Nz::TextStyle_Regular, 0.f, 'L');
+		REQUIRE(referenceGlyph.valid);
+		CHECK_FALSE(referenceGlyph.sharesAtlasRect);
+		CHECK(referenceGlyph.atlasRect.width == static_cast<unsigned int>(referenceGlyph.aabb.width));
+		CHECK(referenceGlyph.atlasRect.width > 2 * spread);
+
+		THEN("Other sizes and outlines reuse the reference distance field")
+		{
+			const auto& doubleGlyph = font->GetGlyph(referenceSize * 2, Nz::TextStyle_Regular, 0.f, 'L');
+			REQUIRE(doubleGlyph.valid);
+			CHECK(doubleGlyph.sharesAtlasRect);
+			CHECK(doubleGlyph.atlasRect == referenceGlyph.atlasRect);
+			CHECK(doubleGlyph.layerIndex == referenceGlyph.layerIndex);
+			CHECK(doubleGlyph.aabb.width == referenceGlyph.aabb.width * 2);
+			CHECK(doubleGlyph.advance == referenceGlyph.advance * 2);
+
+			const auto& outlinedGlyph = font->GetGlyph(referenceSize / 2, Nz::TextStyle_Regular, 2.f, 'L');
+			REQUIRE(outlinedGlyph.valid);
+			CHECK(outlinedGlyph.atlasRect == referenceGlyph.atlasRect);
+			CHECK(outlinedGlyph.fauxOutlineThickness == 0.f);
+		}
+
+		AND_THEN("Precaching many sizes only rasterizes glyphs once")
+		{
+			std::string characterSet;
+			for (char c = 'a'; c <= 'z'; ++c)
+				characterSet += c;
+
+			for (unsigned int fontSize : {24, 36, 48, 72, 140})
+			{
+				for (float outlineThickness : { 0.f, 1.f, 2.f, 5.f })
+					CHECK(font->Precache(fontSize, Nz::TextStyle_Regular, outlineThickness, characterSet));
+			}
+
+			CHECK(font->GetCachedGlyphCount(referenceSize, Nz::TextStyle_Regular, 0.f) == 27);
+			CHECK(font->GetAtlas()->GetLayerCount() == 1);
+		}
+
+		font->EnableSignedDistanceField(false);
+	}
 }
@@ -0,0 +1,104 @@
+#include <Nazara/Utility/Image.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+
+SCENARIO("Image mipmap generation", "[Utility][Image]")
+{
+	GIVEN("A 8x8 RGBA8 checkerboard")
+	{
+		Nz::Image image(Nz::ImageType::E2D, Nz::PixelFormat::RGBA8, 8, 8);
+		for (unsigned int y = 0; y < 8; ++y)
+		{
+			for (unsigned int x = 0; x < 8; ++x)
+				image.SetPixelColor(((x + y) % 2 == 0) ? Nz::Color::White() : Nz::Color::Black(), x, y);
+		}
+
+		WHEN("Generating mipmaps with a box filter")
+		{
+			REQUIRE(image.GenerateMipmaps(Nz::ImageMipmapFilter::Box));
+
+			THEN("The mipmap chain is allocated and every texel is averaged")
+			{
+				REQUIRE(image.GetLevelCount() == image.GetMaxLevel());
+
+				for (Nz::UInt8 level = 1; level < image.GetLevelCount(); ++level)
+				{
+					CHECK(image.GetWidth(level) == 8u >> level);
+
+					const Nz::UInt8* pixels = image.GetConstPixels(0, 0, 0, level);
+					bool valid = true;
+					for (std::size_t i = 0; i < image.GetMemoryUsage(level); i += 4)
+					{
+						valid &= pixels[i + 0] == 128;
+						valid &= pixels[i + 1] == 128;
+						valid &= pixels[i + 2] == 128;
+						valid &= pixels[i + 3] == 255;
+					}
+					CHECK(valid);
+				}
+			}
+		}
+	}
+
+	GIVEN("A 8x8 RGBA8_SRGB image with black and white columns")
+	{
+		Nz::Image image(Nz::ImageType::E2D, Nz::PixelFormat::RGBA8_SRGB, 8, 8);
+		Nz::UInt8* pixels = image.GetPixels();
+		for (std::size_t i = 0; i < 8 * 8; ++i)
+		{
+			Nz::UInt8 value = (i % 2 == 0) ? 255 : 0;
+			pixels[i * 4 + 0] = value;
+			pixels[i * 4 + 1] = value;
+			pixels[i * 4 + 2] = value;
+			pixels[i * 4 + 3] = 255;
+		}
+
+		WHEN("Generating mipmaps")
+		{
+			REQUIRE(image.GenerateMipmaps());
+
+			THEN("Colors are averaged in linear space")
+			{
+				// Linear 0.5 is encoded as ~188 in sRGB, not 128
+				const Nz::UInt8* levelPixels = image.GetConstPixels(0, 0, 0, 1);
+				CHECK(levelPixels[0] == 188);
+				CHECK(levelPixels[1] == 188);
+				CHECK(levelPixels[2] == 188);
+				CHECK(levelPixels[3] == 255);
+			}
+		}
+	}
+
+	GIVEN("A 16x16 uniform RGBA32F image")
+	{
+		Nz::Image image(Nz::ImageType::E2D, Nz::PixelFormat::RGBA32F, 16, 16);
+		float* texels = reinterpret_cast<float*>(image.GetPixels());
+		for (std::size_t i = 0; i < 16 * 16 * 4; ++i)
+			texels[i] = 0.25f;
+
+		WHEN("Generating mipmaps with a Kaiser filter")
+		{
+			REQUIRE(image.GenerateMipmaps(Nz::ImageMipmapFilter::Kaiser));
+
+			THEN("The result stays uniform")
+			{
+				const float* levelTexels = reinterpret_cast<const float*>(image.GetConstPixels(0, 0, 0, 1));
+				bool valid = true;
+				for (std::size_t i = 0; i < 8 * 8 * 4; ++i)
+					valid &= std::abs(levelTexels[i] - 0.25f) < 1e-5f;
+
+				CHECK(valid);
+			}
+		}
+	}
+
+	GIVEN("A compressed image")
+	{
+		Nz::Image image(Nz::ImageType::E2D, Nz::PixelFormat::DXT1, 8, 8);
+
+		THEN("Mipmap generation is refused")
+		{
+			CHECK_FALSE(image.GenerateMipmaps());
+		}
+	}
+}
@@ -0,0 +1,94 @@
+#include <Nazara/Utility/Image.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+SCENARIO("Image resizing", "[Utility][Image]")
+{
+	GIVEN("A 16x8 uniform RGBA8 image")
+	{
+		constexpr std::array<Nz::UInt8, 4> expectedTexel = { 51, 102, 153, 255 };
+
+		Nz::Image image(Nz::ImageType::E2D, Nz::PixelFormat::RGBA8, 16, 8);
+		Nz::UInt8* imagePixels = image.GetPixels();
+		for (std::size_t i = 0; i < 16 * 8; ++i)
+			std::copy(expectedTexel.begin(), expectedTexel.end(), &imagePixels[i * 4]);
+
+		WHEN("Downscaling and upscaling it with every filter")
+		{
+			THEN("The sizes change and the image stays uniform")
+			{
+				for (Nz::ImageResizeFilter filter : { Nz::ImageResizeFilter::Bilinear, Nz::ImageResizeFilter::Box, Nz::ImageResizeFilter::Lanczos, Nz::ImageResizeFilter::Mitchell })
+				{
+					Nz::Image downscaled = image;
+					REQUIRE(downscaled.Resize(Nz::Vector3ui(5, 3, 1), filter));
+					CHECK(downscaled.GetSize() == Nz::Vector3ui(5, 3, 1));
+					CHECK(downscaled.GetLevelCount() == 1);
+
+					Nz::Image upscaled = image;
+					REQUIRE(upscaled.Resize(Nz::Vector3ui(37, 21, 1), filter));
+					CHECK(upscaled.GetSize() == Nz::Vector3ui(37, 21, 1));
+
+					for (const Nz::Image* resized : { &downscaled, &upscaled })
+					{
+						const Nz::UInt8* pixels = resized->GetConstPixels();
+						bool valid = true;
+						for (std::size_t i = 0; i < resized->GetMemoryUsage(); i += 4)
+						{
+							for (std::size_t c = 0; c < 4; ++c)
+								valid &= std::abs(int(pixels[i + c]) - int(expectedTexel[c])) <= 1;
+						}
+						CHECK(valid);
+					}
+				}
+
+				// The source image is shared with the copies, it must be left untouched
+				CHECK(image.GetSize() == Nz::Vector3ui(16, 8, 1));
+			}
+		}
+	}
+
+	GIVEN("A 2x1 image with a transparent red texel and an opaque blue texel")
+	{
+		Nz::Image image(Nz::ImageType::E2D, Nz::PixelFormat::RGBA8, 2, 1);
+		constexpr std::array<Nz::UInt8, 8> texels = { 255, 0, 0, 0, 0, 0, 255, 255 };
+		std::copy(texels.begin(), texels.end(), image.GetPixels());
+
+		WHEN("Downscaling it to a single texel")
+		{
+			REQUIRE(image.Resize(Nz::Vector3ui(1, 1, 1), Nz::ImageResizeFilter::Box));
+
+			THEN("The transparent texel color does not bleed")
+			{
+				const Nz::UInt8* pixels = image.GetConstPixels();
+				CHECK(pixels[0] == 0);
+				CHECK(pixels[1] == 0);
+				CHECK(pixels[2] == 255);
+				CHECK(pixels[3] == 128);
+			}
+		}
+	}
+
+	GIVEN("A 2D array image")
+	{
+		Nz::Image image(Nz::ImageType::E2D_Array, Nz::PixelFormat::RGBA32F, 8, 8, 3);
+
+		THEN("Its layers are kept when resizing")
+		{
+			CHECK(image.Resize(Nz::Vector3ui(4, 4, 3)));
+			CHECK(image.GetSize() == Nz::Vector3ui(4, 4, 3));
+			CHECK_FALSE(image.Resize(Nz::Vector3ui(4, 4, 2)));
+		}
+	}
+
+	GIVEN("A compressed image")
+	{
+		Nz::Image image(Nz::ImageType::E2D, Nz::PixelFormat::DXT1, 8, 8);
+
+		THEN("Resizing is refused")
+		{
+			CHECK_FALSE(image.Resize(Nz::Vector3ui(4, 4, 1)));
+		}
+	}
+}
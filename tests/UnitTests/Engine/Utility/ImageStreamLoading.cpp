@@ -163,6 +163,27 @@ SCENARIO("Streamed images", "[Utility][ImageStream]")
 
 				CompareFrames(*gif, frameData, *expectedFrame.referenceImage);
 			}
+
+			// Same with a frame cache too small to hold every frame, mixing cached and decoded frames
+			Nz::ImageStreamParams cacheParams;
+			cacheParams.custom.SetParameter("GIFLoader_FrameCacheSize", static_cast<long long>(frameData.size() * 3));
+			cacheParams.custom.SetParameter("GIFLoader_KeyframeInterval", 2LL);
+
+			std::shared_ptr<Nz::ImageStream> cachedGif = Nz::ImageStream::OpenFromFile(resourcePath / "Utility/GIF/canvas_prev.gif", cacheParams);
+			REQUIRE(cachedGif);
+
+			for (std::size_t frameIndex : { 0, 1, 2, 3, 4, 3, 1, 4, 2, 0 })
+			{
+				INFO("Decoding frame " << frameIndex << " with a frame cache");
+
+				ExpectedFrame& expectedFrame = expectedFrames[frameIndex];
+				cachedGif->Seek(frameIndex);
+
+				REQUIRE(cachedGif->DecodeNextFrame(frameData.data(), &frameTime));
+				CHECK(frameTime == expectedFrame.time);
+
+				CompareFrames(*cachedGif, frameData, *expectedFrame.referenceImage);
+			}
 		}
 	}
 }
@@ -0,0 +1,109 @@
+#include <Nazara/Utility/Image.hpp>
+#include <Nazara/Utility/PixelFormat.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+	void AppendUInt32(std::vector<Nz::UInt8>& data, Nz::UInt32 value)
+	{
+		for (unsigned int i = 0; i < 4; ++i)
+			data.push_back(static_cast<Nz::UInt8>(value >> (i * 8)));
+	}
+
+	void AppendUInt64(std::vector<Nz::UInt8>& data, Nz::UInt64 value)
+	{
+		for (unsigned int i = 0; i < 8; ++i)
+			data.push_back(static_cast<Nz::UInt8>(value >> (i * 8)));
+	}
+
+	// Builds a minimal KTX2 file (no DFD, no key/value data), levels are stored from the smallest to the largest as required by the specification
+	std::vector<Nz::UInt8> BuildKTX2(Nz::UInt32 vkFormat, Nz::UInt32 width, Nz::UInt32 height, const std::vector<std::vector<Nz::UInt8>>& levels)
+	{
+		std::vector<Nz::UInt8> data = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+		AppendUInt32(data, vkFormat);
+		AppendUInt32(data, 1); //< typeSize
+		AppendUInt32(data, width);
+		AppendUInt32(data, height);
+		AppendUInt32(data, 0); //< pixelDepth
+		AppendUInt32(data, 0); //< layerCount
+		AppendUInt32(data, 1); //< faceCount
+		AppendUInt32(data, static_cast<Nz::UInt32>(levels.size()));
+		AppendUInt32(data, 0); //< supercompressionScheme
+
+		for (unsigned int i = 0; i < 4; ++i)
+			AppendUInt32(data, 0); //< dfd & kvd offsets and sizes
+
+		AppendUInt64(data, 0); //< sgdByteOffset
+		AppendUInt64(data, 0); //< sgdByteLength
+
+		std::size_t dataOffset = data.size() + levels.size() * 3 * sizeof(Nz::UInt64);
+
+		std::vector<Nz::UInt64> levelOffsets(levels.size());
+		for (std::size_t i = levels.size(); i-- > 0;)
+		{
+			levelOffsets[i] = dataOffset;
+			dataOffset += levels[i].size();
+		}
+
+		for (std::size_t i = 0; i < levels.size(); ++i)
+		{
+			AppendUInt64(data, levelOffsets[i]);
+			AppendUInt64(data, levels[i].size());
+			AppendUInt64(data, levels[i].size());
+		}
+
+		for (std::size_t i = levels.size(); i-- > 0;)
+			data.insert(data.end(), levels[i].begin(), levels[i].end());
+
+		return data;
+	}
+}
+
+SCENARIO("KTX2 images", "[Utility][Image][KTX]")
+{
+	WHEN("Computing block-compressed sizes")
+	{
+		CHECK(Nz::PixelFormatInfo::IsCompressed(Nz::PixelFormat::BC7));
+		CHECK(Nz::PixelFormatInfo::ComputeSize(Nz::PixelFormat::BC4, 8, 8, 1) == 4 * 8);
+		CHECK(Nz::PixelFormatInfo::ComputeSize(Nz::PixelFormat::BC7, 5, 5, 1) == 4 * 16);
+		CHECK(Nz::PixelFormatInfo::ComputeSize(Nz::PixelFormat::ETC2_RGB8, 4, 4, 6) == 6 * 8);
+		CHECK(Nz::PixelFormatInfo::ComputeSize(Nz::PixelFormat::ASTC8x8, 16, 9, 1) == 4 * 16);
+	}
+
+	GIVEN("A 8x8 BC7 file with two levels")
+	{
+		std::vector<Nz::UInt8> level0(4 * 16);
+		std::vector<Nz::UInt8> level1(16);
+		for (std::size_t i = 0; i < level0.size(); ++i)
+			level0[i] = static_cast<Nz::UInt8>(i);
+
+		std::fill(level1.begin(), level1.end(), Nz::UInt8(0xCD));
+
+		std::vector<Nz::UInt8> fileData = BuildKTX2(145 /* VK_FORMAT_BC7_UNORM_BLOCK */, 8, 8, { level0, level1 });
+
+		std::shared_ptr<Nz::Image> image = Nz::Image::LoadFromMemory(fileData.data(), fileData.size());
+		REQUIRE(image);
+
+		CHECK(image->GetType() == Nz::ImageType::E2D);
+		CHECK(image->GetFormat() == Nz::PixelFormat::BC7);
+		CHECK(image->GetWidth() == 8);
+		CHECK(image->GetHeight() == 8);
+		REQUIRE(image->GetLevelCount() == 2);
+
+		CHECK(std::memcmp(image->GetConstPixels(0, 0, 0, 0), level0.data(), level0.size()) == 0);
+		CHECK(std::memcmp(image->GetConstPixels(0, 0, 0, 1), level1.data(), level1.size()) == 0);
+	}
+
+	GIVEN("A KTX2 file with a truncated level")
+	{
+		std::vector<Nz::UInt8> fileData = BuildKTX2(37 /* VK_FORMAT_R8G8B8A8_UNORM */, 4, 4, { std::vector<Nz::UInt8>(4 * 4 * 4 - 1) });
+
+		THEN("Loading fails")
+		{
+			CHECK_FALSE(Nz::Image::LoadFromMemory(fileData.data(), fileData.size()));
+		}
+	}
+}
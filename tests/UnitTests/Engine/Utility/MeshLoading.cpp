@@ -1,6 +1,11 @@
+#include <Nazara/Utility/BufferMapper.hpp>
+#include <Nazara/Utility/MaterialData.hpp>
 #include <Nazara/Utility/Mesh.hpp>
+#include <Nazara/Utility/StaticMesh.hpp>
+#include <Nazara/Utility/VertexBuffer.hpp>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <cstring>
 #include <filesystem>
 
 std::filesystem::path GetAssetDir();
@@ -48,4 +53,44 @@ SCENARIO("Meshes", "[Utility][Mesh]")
 			CHECK(drfreak->GetVertexCount() == 496);
 		}
 	}
+
+	WHEN("Saving and reloading a nzmesh cache")
+	{
+		std::shared_ptr<Nz::Mesh> spaceship = Nz::Mesh::LoadFromFile(GetAssetDir() / "Utility/Spaceship/spaceship.obj");
+		REQUIRE(spaceship);
+
+		REQUIRE(spaceship->SaveToFile("spaceship.nzmesh"));
+
+		std::shared_ptr<Nz::Mesh> cachedSpaceship = Nz::Mesh::LoadFromFile("spaceship.nzmesh");
+		REQUIRE(cachedSpaceship);
+
+		CHECK(!cachedSpaceship->IsAnimable());
+		CHECK(cachedSpaceship->GetAABB() == spaceship->GetAABB());
+		REQUIRE(cachedSpaceship->GetMaterialCount() == spaceship->GetMaterialCount());
+		for (std::size_t i = 0; i < spaceship->GetMaterialCount(); ++i)
+			CHECK(cachedSpaceship->GetMaterialData(i).GetStringParameter(Nz::MaterialData::Name).GetValueOr("") == spaceship->GetMaterialData(i).GetStringParameter(Nz::MaterialData::Name).GetValueOr(""));
+
+		REQUIRE(cachedSpaceship->GetSubMeshCount() == spaceship->GetSubMeshCount());
+		CHECK(cachedSpaceship->GetTriangleCount() == spaceship->GetTriangleCount());
+		CHECK(cachedSpaceship->GetVertexCount() == spaceship->GetVertexCount());
+
+		for (std::size_t i = 0; i < spaceship->GetSubMeshCount(); ++i)
+		{
+			const Nz::StaticMesh& original = static_cast<const Nz::StaticMesh&>(*spaceship->GetSubMesh(i));
+			const Nz::StaticMesh& cached = static_cast<const Nz::StaticMesh&>(*cachedSpaceship->GetSubMesh(i));
+
+			CHECK(cached.GetAABB() == original.GetAABB());
+			CHECK(cached.GetMaterialIndex() == original.GetMaterialIndex());
+			CHECK(cached.GetVertexBuffer()->GetVertexDeclaration() == original.GetVertexBuffer()->GetVertexDeclaration());
+
+			Nz::UInt32 vertexCount = original.GetVertexCount();
+			REQUIRE(cached.GetVertexCount() == vertexCount);
+
+			Nz::BufferMapper<Nz::VertexBuffer> originalMapper(*original.GetVertexBuffer(), 0, vertexCount);
+			Nz::BufferMapper<Nz::VertexBuffer> cachedMapper(*cached.GetVertexBuffer(), 0, vertexCount);
+			CHECK(std::memcmp(originalMapper.GetPointer(), cachedMapper.GetPointer(), vertexCount * original.GetVertexBuffer()->GetStride()) == 0);
+		}
+
+		std::filesystem::remove("spaceship.nzmesh");
+	}
 }
@@ -0,0 +1,106 @@
+#include <Nazara/Utility/IndexBuffer.hpp>
+#include <Nazara/Utility/IndexMapper.hpp>
+#include <Nazara/Utility/Mesh.hpp>
+#include <Nazara/Utility/StaticMesh.hpp>
+#include <Nazara/Utility/VertexBuffer.hpp>
+#include <Nazara/Utility/VertexMapper.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+SCENARIO("Mesh optimization", "[Utility][Mesh]")
+{
+	GIVEN("A quad made of two unindexed triangles and unused vertices")
+	{
+		const std::array<Nz::VertexStruct_XYZ, 8> vertices = {
+			Nz::VertexStruct_XYZ{ Nz::Vector3f(0.f, 0.f, 0.f) },
+			Nz::VertexStruct_XYZ{ Nz::Vector3f(1.f, 0.f, 0.f) },
+			Nz::VertexStruct_XYZ{ Nz::Vector3f(1.f, 1.f, 0.f) },
+			Nz::VertexStruct_XYZ{ Nz::Vector3f(5.f, 5.f, 5.f) }, //< unused
+			Nz::VertexStruct_XYZ{ Nz::Vector3f(0.f, 0.f, 0.f) },
+			Nz::VertexStruct_XYZ{ Nz::Vector3f(1.f, 1.f, 0.f) },
+			Nz::VertexStruct_XYZ{ Nz::Vector3f(0.f, 1.f, 0.f) },
+			Nz::VertexStruct_XYZ{ Nz::Vector3f(6.f, 6.f, 6.f) }, //< unused
+		};
+
+		const std::array<Nz::UInt32, 6> indices = { 0, 1, 2, 4, 5, 6 };
+
+		auto vertexBuffer = std::make_shared<Nz::VertexBuffer>(Nz::VertexDeclaration::Get(Nz::VertexLayout::XYZ), Nz::UInt32(vertices.size()), Nz::BufferUsage::DirectMapping | Nz::BufferUsage::Read | Nz::BufferUsage::Write, &Nz::SoftwareBufferFactory, vertices.data());
+		auto indexBuffer = std::make_shared<Nz::IndexBuffer>(Nz::IndexType::U32, Nz::UInt32(indices.size()), Nz::BufferUsage::DirectMapping | Nz::BufferUsage::Read | Nz::BufferUsage::Write, &Nz::SoftwareBufferFactory, indices.data());
+
+		auto staticMesh = std::make_shared<Nz::StaticMesh>(vertexBuffer, indexBuffer);
+		staticMesh->GenerateAABB();
+
+		std::shared_ptr<Nz::Mesh> mesh = Nz::Mesh::Build(staticMesh);
+
+		auto GetTriangles = [](Nz::StaticMesh& subMesh)
+		{
+			std::vector<std::array<Nz::Vector3f, 3>> triangles;
+
+			Nz::VertexMapper vertexMapper(*subMesh.GetVertexBuffer());
+			Nz::SparsePtr<Nz::Vector3f> positions = vertexMapper.GetComponentPtr<Nz::Vector3f>(Nz::VertexComponent::Position);
+
+			Nz::IndexMapper indexMapper(*subMesh.GetIndexBuffer());
+			for (Nz::UInt32 i = 0; i < indexMapper.GetIndexCount(); i += 3)
+			{
+				std::array<Nz::Vector3f, 3> triangle = { positions[indexMapper.Get(i)], positions[indexMapper.Get(i + 1)], positions[indexMapper.Get(i + 2)] };
+
+				// Normalize the first vertex of the triangle without changing its winding
+				auto minIt = std::min_element(triangle.begin(), triangle.end());
+				std::rotate(triangle.begin(), minIt, triangle.end());
+
+				triangles.push_back(triangle);
+			}
+
+			std::sort(triangles.begin(), triangles.end());
+			return triangles;
+		};
+
+		auto originalTriangles = GetTriangles(*staticMesh);
+
+		WHEN("Optimizing it")
+		{
+			mesh->Optimize();
+
+			Nz::StaticMesh& optimizedMesh = static_cast<Nz::StaticMesh&>(*mesh->GetSubMesh(0));
+
+			THEN("Duplicate and unused vertices are removed and indices are narrowed")
+			{
+				CHECK(optimizedMesh.GetVertexCount() == 4);
+				CHECK(optimizedMesh.GetIndexBuffer()->GetIndexType() == Nz::IndexType::U16);
+				CHECK(optimizedMesh.GetIndexBuffer()->GetIndexCount() == 6);
+				CHECK(optimizedMesh.GetAABB() == staticMesh->GetAABB());
+			}
+
+			THEN("Triangles are preserved")
+			{
+				CHECK(GetTriangles(optimizedMesh) == originalTriangles);
+			}
+
+			THEN("Vertices are ordered by first use")
+			{
+				Nz::IndexMapper indexMapper(*optimizedMesh.GetIndexBuffer());
+
+				Nz::UInt32 nextVertex = 0;
+				for (Nz::UInt32 i = 0; i < indexMapper.GetIndexCount(); ++i)
+				{
+					Nz::UInt32 index = indexMapper.Get(i);
+					CHECK(index <= nextVertex);
+					if (index == nextVertex)
+						nextVertex++;
+				}
+			}
+		}
+
+		WHEN("Optimizing it without narrowing indices")
+		{
+			Nz::MeshParams params;
+			params.narrowIndices = false;
+
+			mesh->Optimize(params);
+
+			CHECK(mesh->GetSubMesh(0)->GetIndexBuffer()->GetIndexType() == Nz::IndexType::U32);
+		}
+	}
+}
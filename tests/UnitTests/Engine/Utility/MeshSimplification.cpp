@@ -0,0 +1,123 @@
+#include <Nazara/Core/MemoryStream.hpp>
+#include <Nazara/Core/Primitive.hpp>
+#include <Nazara/Utility/Algorithm.hpp>
+#include <Nazara/Utility/IndexBuffer.hpp>
+#include <Nazara/Utility/IndexMapper.hpp>
+#include <Nazara/Utility/Mesh.hpp>
+#include <Nazara/Utility/StaticMesh.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <vector>
+
+SCENARIO("Mesh simplification", "[Utility][Mesh]")
+{
+	GIVEN("A subdivided plane")
+	{
+		std::shared_ptr<Nz::Mesh> mesh = Nz::Mesh::Build(Nz::Primitive::Plane(Nz::Vector2f(10.f, 10.f), Nz::Vector2ui(16, 16)));
+		REQUIRE(mesh);
+
+		const Nz::SubMesh& subMesh = *mesh->GetSubMesh(0);
+		Nz::UInt32 indexCount = subMesh.GetIndexBuffer()->GetIndexCount();
+
+		WHEN("Generating levels of detail")
+		{
+			Nz::MeshParams params;
+			params.lodCount = 2;
+			params.lodReduction = 0.5f;
+
+			mesh->GenerateLODs(params);
+
+			THEN("Each level has less triangles than the previous one and keeps valid indices")
+			{
+				REQUIRE(subMesh.GetLODCount() == 3);
+				CHECK(subMesh.GetLODIndexBuffer(0) == subMesh.GetIndexBuffer());
+				CHECK(subMesh.GetLODError(0) == 0.f);
+
+				Nz::UInt32 previousIndexCount = indexCount;
+				for (std::size_t lodIndex = 1; lodIndex < subMesh.GetLODCount(); ++lodIndex)
+				{
+					const auto& lodIndexBuffer = subMesh.GetLODIndexBuffer(lodIndex);
+					CHECK(lodIndexBuffer->GetIndexType() == subMesh.GetIndexBuffer()->GetIndexType());
+
+					Nz::UInt32 lodIndexCount = lodIndexBuffer->GetIndexCount();
+					CHECK(lodIndexCount % 3 == 0);
+					CHECK(lodIndexCount < previousIndexCount);
+					CHECK(lodIndexCount <= previousIndexCount / 2 + 3);
+
+					// The plane is flat, collapses don't change its surface
+					CHECK(subMesh.GetLODError(lodIndex) == Catch::Approx(0.f).margin(0.0001f));
+
+					Nz::IndexMapper indexMapper(*lodIndexBuffer);
+					for (Nz::UInt32 i = 0; i < lodIndexCount; ++i)
+						CHECK(indexMapper.Get(i) < subMesh.GetVertexCount());
+
+					previousIndexCount = lodIndexCount;
+				}
+			}
+
+			AND_WHEN("Saving and reloading it as a nzmesh")
+			{
+				Nz::MemoryStream stream;
+				REQUIRE(mesh->SaveToStream(stream, ".nzmesh"));
+
+				stream.SetCursorPos(0);
+				std::shared_ptr<Nz::Mesh> cachedMesh = Nz::Mesh::LoadFromStream(stream);
+				REQUIRE(cachedMesh);
+
+				const Nz::SubMesh& cachedSubMesh = *cachedMesh->GetSubMesh(0);
+				REQUIRE(cachedSubMesh.GetLODCount() == subMesh.GetLODCount());
+				for (std::size_t lodIndex = 1; lodIndex < subMesh.GetLODCount(); ++lodIndex)
+				{
+					CHECK(cachedSubMesh.GetLODIndexBuffer(lodIndex)->GetIndexCount() == subMesh.GetLODIndexBuffer(lodIndex)->GetIndexCount());
+					CHECK(cachedSubMesh.GetLODError(lodIndex) == subMesh.GetLODError(lodIndex));
+				}
+			}
+		}
+	}
+
+	GIVEN("A curved grid")
+	{
+		constexpr Nz::UInt32 GridSize = 17;
+
+		std::vector<Nz::Vector3f> positions;
+		for (Nz::UInt32 y = 0; y < GridSize; ++y)
+		{
+			for (Nz::UInt32 x = 0; x < GridSize; ++x)
+				positions.emplace_back(float(x), float(y), std::sin(float(x) * 0.3f) * std::cos(float(y) * 0.3f) * 3.f);
+		}
+
+		std::vector<Nz::UInt32> indices;
+		for (Nz::UInt32 y = 0; y < GridSize - 1; ++y)
+		{
+			for (Nz::UInt32 x = 0; x < GridSize - 1; ++x)
+			{
+				Nz::UInt32 i = y * GridSize + x;
+				indices.insert(indices.end(), { i, i + 1, i + GridSize + 1, i, i + GridSize + 1, i + GridSize });
+			}
+		}
+
+		Nz::IndexBuffer indexBuffer(Nz::IndexType::U32, Nz::UInt32(indices.size()), Nz::BufferUsage::DirectMapping | Nz::BufferUsage::Read | Nz::BufferUsage::Write, &Nz::SoftwareBufferFactory, indices.data());
+		Nz::IndexMapper indexMapper(indexBuffer);
+
+		std::vector<Nz::UInt32> simplifiedIndices(indices.size());
+
+		WHEN("Simplifying it without error limit")
+		{
+			float error;
+			Nz::UInt32 simplifiedIndexCount = Nz::SimplifyMesh(indexMapper.begin(), Nz::UInt32(indices.size()), positions.data(), Nz::UInt32(positions.size()), Nz::UInt32(indices.size() / 4), 100.f, simplifiedIndices.data(), &error);
+
+			CHECK(simplifiedIndexCount <= indices.size() / 4);
+			CHECK(error > 0.f);
+		}
+
+		WHEN("Simplifying it with a tight error limit")
+		{
+			float error;
+			Nz::UInt32 simplifiedIndexCount = Nz::SimplifyMesh(indexMapper.begin(), Nz::UInt32(indices.size()), positions.data(), Nz::UInt32(positions.size()), 0, 0.0001f, simplifiedIndices.data(), &error);
+
+			CHECK(simplifiedIndexCount == indices.size());
+			CHECK(error <= 0.0001f);
+		}
+	}
+}
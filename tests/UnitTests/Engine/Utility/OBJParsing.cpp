@@ -0,0 +1,92 @@
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/MemoryView.hpp>
+#include <Nazara/Utility/Formats/OBJParser.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <string_view>
+
+SCENARIO("OBJ parsing", "[Utility][OBJ]")
+{
+	constexpr std::string_view content =
+		"# position count: 4\r\n"
+		"mtllib scene.mtl\r\n"
+		"v 0 0 0\r\n"
+		"v 1.5 0 -2e1\r\n"
+		"v\t0 1 0 0.5\r\n"
+		"v +1 1 0 # trailing comment\r\n"
+		"vn 0 0 1\r\n"
+		"vt 0.25 0.75\r\n"
+		"\r\n"
+		"o Quad\r\n"
+		"usemtl Red\r\n"
+		"f 1/1/1 2/1/1 3/1/1\r\n"
+		"f 1//1  3//1 4//1\r\n"
+		"usemtl Blue\r\n"
+		"f -4/-1 -3/-1 -2/-1 -1/-1\r\n"
+		"f 1 2 42\r\n" //< out of range, skipped
+		"f 1 2 3"; //< no final line ending
+
+	auto CheckParser = [&](const Nz::OBJParser& parser)
+	{
+		CHECK(parser.GetMtlLib() == "scene.mtl");
+
+		REQUIRE(parser.GetPositionCount() == 4);
+		CHECK(parser.GetPositions()[1] == Nz::Vector4f(1.5f, 0.f, -20.f, 1.f));
+		CHECK(parser.GetPositions()[2] == Nz::Vector4f(0.f, 1.f, 0.f, 0.5f));
+		CHECK(parser.GetPositions()[3] == Nz::Vector4f(1.f, 1.f, 0.f, 1.f));
+		REQUIRE(parser.GetNormalCount() == 1);
+		CHECK(parser.GetNormals()[0] == Nz::Vector3f::UnitZ());
+		REQUIRE(parser.GetTexCoordCount() == 1);
+		CHECK(parser.GetTexCoords()[0] == Nz::Vector3f(0.25f, 0.75f, 0.f));
+
+		REQUIRE(parser.GetMeshCount() == 2);
+
+		const Nz::OBJParser::Mesh& redMesh = parser.GetMeshes()[0];
+		CHECK(redMesh.name == "Quad");
+		CHECK(parser.GetMaterials()[redMesh.material] == "Red");
+		REQUIRE(redMesh.faces.size() == 2);
+		REQUIRE(redMesh.vertices.size() == 6);
+		CHECK(redMesh.vertices[1].position == 2);
+		CHECK(redMesh.vertices[1].texCoord == 1);
+		CHECK(redMesh.vertices[1].normal == 1);
+		CHECK(redMesh.vertices[4].position == 3);
+		CHECK(redMesh.vertices[4].texCoord == 0);
+		CHECK(redMesh.vertices[4].normal == 1);
+
+		const Nz::OBJParser::Mesh& blueMesh = parser.GetMeshes()[1];
+		CHECK(parser.GetMaterials()[blueMesh.material] == "Blue");
+		REQUIRE(blueMesh.faces.size() == 2);
+		CHECK(blueMesh.faces[0].vertexCount == 4);
+		for (std::size_t i = 0; i < 4; ++i)
+		{
+			CHECK(blueMesh.vertices[i].position == i + 1);
+			CHECK(blueMesh.vertices[i].texCoord == 1);
+			CHECK(blueMesh.vertices[i].normal == 0);
+		}
+		CHECK(blueMesh.faces[1].vertexCount == 3);
+	};
+
+	WHEN("Parsing from memory")
+	{
+		Nz::MemoryView stream(content.data(), content.size());
+
+		Nz::OBJParser parser;
+		REQUIRE(parser.Parse(stream));
+		CheckParser(parser);
+	}
+
+	WHEN("Parsing from a file")
+	{
+		REQUIRE(Nz::File::WriteWhole("OBJParsing.obj", content.data(), content.size()));
+
+		{
+			Nz::File file("OBJParsing.obj", Nz::OpenMode::ReadOnly);
+
+			Nz::OBJParser parser;
+			REQUIRE(parser.Parse(file));
+			CheckParser(parser);
+		}
+
+		std::filesystem::remove("OBJParsing.obj");
+	}
+}
@@ -0,0 +1,146 @@
+#include <Nazara/Utility/PixelFormat.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <vector>
+
+SCENARIO("Pixel format conversion", "[Utility][PixelFormat]")
+{
+	// Odd pixel count so both the vectorized and the remaining scalar parts of the conversions are exercised
+	constexpr std::size_t PixelCount = 1003;
+
+	std::mt19937 randomEngine(42);
+	std::uniform_int_distribution<unsigned int> byteDis(0, 255);
+
+	auto GeneratePixels = [&](Nz::PixelFormat format)
+	{
+		std::vector<Nz::UInt8> pixels(PixelCount * Nz::PixelFormatInfo::GetBytesPerPixel(format));
+		for (Nz::UInt8& byte : pixels)
+			byte = static_cast<Nz::UInt8>(byteDis(randomEngine));
+
+		return pixels;
+	};
+
+	auto Convert = [](Nz::PixelFormat srcFormat, Nz::PixelFormat dstFormat, const std::vector<Nz::UInt8>& src)
+	{
+		std::vector<Nz::UInt8> dst(PixelCount * Nz::PixelFormatInfo::GetBytesPerPixel(dstFormat));
+		REQUIRE(Nz::PixelFormatInfo::Convert(srcFormat, dstFormat, src.data(), src.data() + src.size(), dst.data()));
+
+		return dst;
+	};
+
+	GIVEN("RGB8 pixels")
+	{
+		std::vector<Nz::UInt8> src = GeneratePixels(Nz::PixelFormat::RGB8);
+
+		WHEN("Converting them to BGRA8 and back")
+		{
+			std::vector<Nz::UInt8> bgra = Convert(Nz::PixelFormat::RGB8, Nz::PixelFormat::BGRA8, src);
+
+			THEN("Channels are swizzled and alpha is opaque")
+			{
+				bool valid = true;
+				for (std::size_t i = 0; i < PixelCount; ++i)
+				{
+					valid &= bgra[i * 4 + 0] == src[i * 3 + 2];
+					valid &= bgra[i * 4 + 1] == src[i * 3 + 1];
+					valid &= bgra[i * 4 + 2] == src[i * 3 + 0];
+					valid &= bgra[i * 4 + 3] == 0xFF;
+				}
+				CHECK(valid);
+
+				CHECK(Convert(Nz::PixelFormat::BGRA8, Nz::PixelFormat::RGB8, bgra) == src);
+			}
+		}
+
+		WHEN("Converting them to RGBA8 and back")
+		{
+			std::vector<Nz::UInt8> rgba = Convert(Nz::PixelFormat::RGB8, Nz::PixelFormat::RGBA8, src);
+
+			THEN("Channels are kept and alpha is opaque")
+			{
+				bool valid = true;
+				for (std::size_t i = 0; i < PixelCount; ++i)
+				{
+					valid &= rgba[i * 4 + 0] == src[i * 3 + 0];
+					valid &= rgba[i * 4 + 1] == src[i * 3 + 1];
+					valid &= rgba[i * 4 + 2] == src[i * 3 + 2];
+					valid &= rgba[i * 4 + 3] == 0xFF;
+				}
+				CHECK(valid);
+
+				CHECK(Convert(Nz::PixelFormat::RGBA8, Nz::PixelFormat::RGB8, rgba) == src);
+			}
+		}
+	}
+
+	GIVEN("RGBA8 pixels")
+	{
+		std::vector<Nz::UInt8> src = GeneratePixels(Nz::PixelFormat::RGBA8);
+
+		WHEN("Converting them to BGRA8")
+		{
+			std::vector<Nz::UInt8> bgra = Convert(Nz::PixelFormat::RGBA8, Nz::PixelFormat::BGRA8, src);
+
+			THEN("Red and blue are swapped")
+			{
+				bool valid = true;
+				for (std::size_t i = 0; i < PixelCount; ++i)
+				{
+					valid &= bgra[i * 4 + 0] == src[i * 4 + 2];
+					valid &= bgra[i * 4 + 1] == src[i * 4 + 1];
+					valid &= bgra[i * 4 + 2] == src[i * 4 + 0];
+					valid &= bgra[i * 4 + 3] == src[i * 4 + 3];
+				}
+				CHECK(valid);
+
+				CHECK(Convert(Nz::PixelFormat::BGRA8, Nz::PixelFormat::RGBA8, bgra) == src);
+			}
+		}
+
+		WHEN("Converting them to BGR8")
+		{
+			std::vector<Nz::UInt8> bgr = Convert(Nz::PixelFormat::RGBA8, Nz::PixelFormat::BGR8, src);
+
+			THEN("Alpha is dropped and red and blue are swapped")
+			{
+				bool valid = true;
+				for (std::size_t i = 0; i < PixelCount; ++i)
+				{
+					valid &= bgr[i * 3 + 0] == src[i * 4 + 2];
+					valid &= bgr[i * 3 + 1] == src[i * 4 + 1];
+					valid &= bgr[i * 3 + 2] == src[i * 4 + 0];
+				}
+				CHECK(valid);
+			}
+		}
+	}
+
+	GIVEN("L8 and LA8 pixels")
+	{
+		std::vector<Nz::UInt8> luminance = GeneratePixels(Nz::PixelFormat::L8);
+		std::vector<Nz::UInt8> luminanceAlpha = GeneratePixels(Nz::PixelFormat::LA8);
+
+		WHEN("Converting them to RGBA8")
+		{
+			std::vector<Nz::UInt8> fromL = Convert(Nz::PixelFormat::L8, Nz::PixelFormat::RGBA8, luminance);
+			std::vector<Nz::UInt8> fromLA = Convert(Nz::PixelFormat::LA8, Nz::PixelFormat::RGBA8, luminanceAlpha);
+
+			THEN("Luminance is broadcast to every color channel")
+			{
+				bool valid = true;
+				for (std::size_t i = 0; i < PixelCount; ++i)
+				{
+					for (std::size_t j = 0; j < 3; ++j)
+					{
+						valid &= fromL[i * 4 + j] == luminance[i];
+						valid &= fromLA[i * 4 + j] == luminanceAlpha[i * 2];
+					}
+
+					valid &= fromL[i * 4 + 3] == 0xFF;
+					valid &= fromLA[i * 4 + 3] == luminanceAlpha[i * 2 + 1];
+				}
+				CHECK(valid);
+			}
+		}
+	}
+}
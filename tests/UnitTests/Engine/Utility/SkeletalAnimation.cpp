@@ -0,0 +1,173 @@
+#include <Nazara/Math/EulerAngles.hpp>
+#include <Nazara/Utility/Animation.hpp>
+#include <Nazara/Utility/AnimationBlendTree.hpp>
+#include <Nazara/Utility/Joint.hpp>
+#include <Nazara/Utility/Sequence.hpp>
+#include <Nazara/Utility/SkeletalPose.hpp>
+#include <Nazara/Utility/Skeleton.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <memory>
+
+SCENARIO("Skeletal animation", "[Utility][Animation]")
+{
+	constexpr std::size_t JointCount = 3;
+
+	// root <- a <- b
+	Nz::Skeleton skeleton;
+	skeleton.Create(JointCount);
+	for (std::size_t i = 0; i < JointCount; ++i)
+	{
+		Nz::Joint* joint = skeleton.GetJoint(i);
+		if (i > 0)
+			joint->SetParent(*skeleton.GetJoint(i - 1));
+
+		joint->SetTransform(Nz::Vector3f(0.f, 1.f, float(i)), Nz::Quaternionf(Nz::EulerAnglesf(10.f * i, 20.f, 0.f)), Nz::Vector3f(1.f + 0.5f * i));
+		joint->SetInverseBindMatrix(Nz::Matrix4f::Translate(Nz::Vector3f(0.f, -1.f * i, 0.f)));
+	}
+
+	std::shared_ptr<Nz::Animation> animation = std::make_shared<Nz::Animation>();
+	animation->CreateSkeletal(2, JointCount);
+
+	Nz::Sequence sequence;
+	sequence.firstFrame = 0;
+	sequence.frameCount = 2;
+	sequence.frameRate = 1;
+	animation->AddSequence(sequence);
+
+	for (std::size_t frame = 0; frame < 2; ++frame)
+	{
+		Nz::SequenceJoint* sequenceJoints = animation->GetSequenceJoints(frame);
+		for (std::size_t i = 0; i < JointCount; ++i)
+		{
+			sequenceJoints[i].position = Nz::Vector3f(float(frame), 2.f, 0.f);
+			sequenceJoints[i].rotation = Nz::Quaternionf(Nz::EulerAnglesf(0.f, 45.f * frame, 30.f));
+			sequenceJoints[i].scale = Nz::Vector3f(1.f + frame);
+		}
+	}
+
+	auto CheckSkinningMatrices = [&](const Nz::Matrix4f* skinningMatrices)
+	{
+		for (std::size_t i = 0; i < JointCount; ++i)
+		{
+			const Nz::Matrix4f& referenceMatrix = skeleton.GetJoint(i)->GetSkinningMatrix();
+			for (std::size_t j = 0; j < 16; ++j)
+				CHECK(skinningMatrices[i][j] == Catch::Approx(referenceMatrix[j]).margin(0.0001f));
+		}
+	};
+
+	GIVEN("A blend tree without animation")
+	{
+		Nz::AnimationBlendTree blendTree(skeleton);
+		blendTree.Update(Nz::Time::Zero());
+
+		THEN("Skinning matrices match the joints ones")
+		{
+			CheckSkinningMatrices(blendTree.GetSkinningMatrices());
+		}
+	}
+
+	GIVEN("A blend tree playing an animation")
+	{
+		Nz::AnimationBlendTree blendTree(skeleton);
+		Nz::AnimationBlendTree::NodeIndex clip = blendTree.AddClip(animation);
+		blendTree.SetRootNode(clip);
+
+		WHEN("Sampling the middle of the animation")
+		{
+			blendTree.Update(Nz::Time::Milliseconds(500));
+			animation->AnimateSkeleton(&skeleton, 0, 1, 0.5f);
+
+			THEN("Skinning matrices match the animated skeleton ones")
+			{
+				CheckSkinningMatrices(blendTree.GetSkinningMatrices());
+			}
+
+			AND_THEN("Applying the pose to the skeleton gives the same result")
+			{
+				Nz::Skeleton poseSkeleton(skeleton);
+				poseSkeleton.SetPose(blendTree.GetPose());
+
+				for (std::size_t i = 0; i < JointCount; ++i)
+				{
+					const Nz::Matrix4f& matrix = poseSkeleton.GetJoint(i)->GetSkinningMatrix();
+					const Nz::Matrix4f& referenceMatrix = skeleton.GetJoint(i)->GetSkinningMatrix();
+					for (std::size_t j = 0; j < 16; ++j)
+						CHECK(matrix[j] == Catch::Approx(referenceMatrix[j]).margin(0.0001f));
+				}
+			}
+		}
+
+		WHEN("Blending the animation with the bind pose")
+		{
+			Nz::AnimationBlendTree::NodeIndex secondClip = blendTree.AddClip(animation);
+			blendTree.SetClipTime(secondClip, Nz::Time::Second());
+
+			Nz::AnimationBlendTree::NodeIndex blend = blendTree.AddBlend(clip, secondClip, 0.f);
+			blendTree.SetRootNode(blend);
+			blendTree.Update(Nz::Time::Zero());
+
+			THEN("A zero weight only uses the first clip")
+			{
+				animation->AnimateSkeleton(&skeleton, 0, 0, 0.f);
+				CheckSkinningMatrices(blendTree.GetSkinningMatrices());
+			}
+
+			AND_THEN("A full weight only uses the second clip")
+			{
+				blendTree.SetWeight(blend, 1.f);
+				blendTree.Update(Nz::Time::Zero());
+
+				animation->AnimateSkeleton(&skeleton, 1, 1, 0.f);
+				CheckSkinningMatrices(blendTree.GetSkinningMatrices());
+			}
+		}
+	}
+
+	GIVEN("Two poses")
+	{
+		Nz::SkeletalPose poseA(JointCount);
+		Nz::SkeletalPose poseB(JointCount);
+		for (std::size_t i = 0; i < JointCount; ++i)
+		{
+			poseB.GetPositions()[i] = Nz::Vector3f(2.f, 4.f, -2.f);
+			poseB.GetRotations()[i] = Nz::Quaternionf(Nz::EulerAnglesf(0.f, 90.f, 0.f));
+			poseB.GetScales()[i] = Nz::Vector3f(3.f);
+		}
+
+		WHEN("Interpolating them")
+		{
+			Nz::SkeletalPose result;
+			Nz::SkeletalPose::Interpolate(poseA, poseB, 0.5f, result);
+
+			THEN("We get a pose halfway")
+			{
+				REQUIRE(result.GetJointCount() == JointCount);
+
+				Nz::Quaternionf expectedRotation(Nz::EulerAnglesf(0.f, 45.f, 0.f));
+				for (std::size_t i = 0; i < JointCount; ++i)
+				{
+					CHECK(result.GetPositions()[i].x == Catch::Approx(1.f));
+					CHECK(result.GetPositions()[i].y == Catch::Approx(2.f));
+					CHECK(result.GetPositions()[i].z == Catch::Approx(-1.f));
+					CHECK(std::abs(result.GetRotations()[i].DotProduct(expectedRotation)) == Catch::Approx(1.f));
+					CHECK(result.GetScales()[i].x == Catch::Approx(2.f));
+				}
+			}
+		}
+
+		WHEN("Blending them with per-joint weights")
+		{
+			float jointWeights[JointCount] = { 0.f, 1.f, 0.5f };
+			poseA.Blend(poseB, 1.f, jointWeights);
+
+			THEN("Only weighted joints are affected")
+			{
+				CHECK(poseA.GetPositions()[0].x == Catch::Approx(0.f));
+				CHECK(poseA.GetPositions()[1].x == Catch::Approx(2.f));
+				CHECK(poseA.GetPositions()[2].x == Catch::Approx(1.f));
+			}
+		}
+	}
+}
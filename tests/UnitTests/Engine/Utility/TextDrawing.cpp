@@ -0,0 +1,114 @@
+#include <Nazara/Utility/RichTextDrawer.hpp>
+#include <Nazara/Utility/SimpleTextDrawer.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+	void CheckSameLayout(const Nz::AbstractTextDrawer& lhs, const Nz::AbstractTextDrawer& rhs)
+	{
+		REQUIRE(lhs.GetGlyphCount() == rhs.GetGlyphCount());
+		for (std::size_t i = 0; i < lhs.GetGlyphCount(); ++i)
+			CHECK(lhs.GetGlyph(i).bounds == rhs.GetGlyph(i).bounds);
+
+		REQUIRE(lhs.GetLineCount() == rhs.GetLineCount());
+		for (std::size_t i = 0; i < lhs.GetLineCount(); ++i)
+		{
+			CHECK(lhs.GetLine(i).bounds == rhs.GetLine(i).bounds);
+			CHECK(lhs.GetLine(i).glyphIndex == rhs.GetLine(i).glyphIndex);
+		}
+
+		CHECK(lhs.GetBounds() == rhs.GetBounds());
+	}
+}
+
+SCENARIO("Text drawing", "[Utility][TextDrawer]")
+{
+	GIVEN("A simple text drawer with multiple lines")
+	{
+		Nz::SimpleTextDrawer drawer;
+		drawer.SetMaxLineWidth(200.f);
+		drawer.SetTextOutlineThickness(1.f);
+		drawer.SetText("Log start\nSecond line, long enough to be wrapped\nThird line");
+		CHECK(drawer.GetLineCount() > 3);
+
+		WHEN("We edit the end of the text")
+		{
+			drawer.SetText("Log start\nSecond line, long enough to be wrapped\nAnother third line");
+			drawer.AppendText("\nFourth line");
+
+			THEN("Layout matches a layout made from scratch")
+			{
+				Nz::SimpleTextDrawer referenceDrawer(drawer);
+				CheckSameLayout(drawer, referenceDrawer);
+			}
+		}
+
+		WHEN("We truncate the text on a line break")
+		{
+			drawer.SetText("Log start\n");
+
+			THEN("Layout matches a layout made from scratch")
+			{
+				Nz::SimpleTextDrawer referenceDrawer(drawer);
+				CheckSameLayout(drawer, referenceDrawer);
+				CHECK(drawer.GetLineCount() == 2);
+			}
+		}
+
+		WHEN("We insert and erase text in the middle of the text")
+		{
+			drawer.AppendText("\nFourth line\nFifth line");
+			drawer.GetLineCount(); //< lay out text
+
+			drawer.InsertText(10, "Inserted line\nwhich is long enough to be wrapped too ");
+			CHECK(drawer.GetText() == "Log start\nInserted line\nwhich is long enough to be wrapped too Second line, long enough to be wrapped\nThird line\nFourth line\nFifth line");
+
+			THEN("Layout matches a layout made from scratch")
+			{
+				Nz::SimpleTextDrawer referenceDrawer(drawer);
+				CheckSameLayout(drawer, referenceDrawer);
+			}
+
+			AND_WHEN("We erase text spanning multiple lines")
+			{
+				drawer.GetLineCount(); //< lay out text
+				drawer.EraseText(4, 20);
+				CHECK(drawer.GetText() == "Log which is long enough to be wrapped too Second line, long enough to be wrapped\nThird line\nFourth line\nFifth line");
+
+				THEN("Layout matches a layout made from scratch")
+				{
+					Nz::SimpleTextDrawer referenceDrawer(drawer);
+					CheckSameLayout(drawer, referenceDrawer);
+				}
+			}
+		}
+	}
+
+	GIVEN("A rich text drawer with multiple blocks")
+	{
+		Nz::RichTextDrawer drawer;
+		drawer.SetMaxLineWidth(200.f);
+		drawer.AppendText("First block ");
+
+		drawer.SetCharacterSize(32);
+		drawer.AppendText("second block, long enough to be wrapped\n");
+
+		drawer.SetCharacterSize(16);
+		drawer.AppendText("third block");
+		CHECK(drawer.GetBlockCount() == 3);
+
+		WHEN("We modify a block in the middle and append another one")
+		{
+			drawer.GetLineCount(); //< lay out blocks
+			drawer.SetBlockText(1, "second block\n");
+			drawer.SetTextColor(Nz::Color::Red());
+			drawer.AppendText("fourth block");
+
+			THEN("Layout matches a layout made from scratch")
+			{
+				Nz::RichTextDrawer referenceDrawer(drawer);
+				CheckSameLayout(drawer, referenceDrawer);
+			}
+		}
+	}
+}
@@ -0,0 +1,93 @@
+#include <Nazara/Math/EulerAngles.hpp>
+#include <Nazara/Utility/Node.hpp>
+#include <Nazara/Utility/TransformHierarchy.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <cmath>
+
+SCENARIO("Transform hierarchy", "[Utility][Node]")
+{
+	auto SetupHierarchy = [](std::array<Nz::Node, 6>& nodes)
+	{
+		// root <- a <- b <- c
+		//      <- d (doesn't inherit rotation) <- e (doesn't inherit scale)
+		nodes[0].SetTransform(Nz::Vector3f(1.f, 2.f, 3.f), Nz::Quaternionf(Nz::EulerAnglesf(0.f, 45.f, 0.f)), Nz::Vector3f(2.f));
+		nodes[1].SetTransform(Nz::Vector3f(0.f, 1.f, 0.f), Nz::Quaternionf(Nz::EulerAnglesf(30.f, 0.f, 0.f)), Nz::Vector3f(1.f, 0.5f, 1.f));
+		nodes[2].SetTransform(Nz::Vector3f(2.f, 0.f, -1.f), Nz::Quaternionf(Nz::EulerAnglesf(0.f, 0.f, 60.f)));
+		nodes[3].SetTransform(Nz::Vector3f(-1.f, 0.f, 0.f), Nz::Quaternionf::Identity(), Nz::Vector3f(3.f));
+		nodes[4].SetTransform(Nz::Vector3f(0.f, 0.f, 5.f), Nz::Quaternionf(Nz::EulerAnglesf(10.f, 20.f, 30.f)));
+		nodes[5].SetTransform(Nz::Vector3f(1.f, 1.f, 1.f), Nz::Quaternionf(Nz::EulerAnglesf(0.f, 90.f, 0.f)), Nz::Vector3f(0.5f));
+
+		nodes[4].SetInheritRotation(false);
+		nodes[5].SetInheritScale(false);
+
+		nodes[1].SetParent(nodes[0]);
+		nodes[2].SetParent(nodes[1]);
+		nodes[3].SetParent(nodes[2]);
+		nodes[4].SetParent(nodes[0]);
+		nodes[5].SetParent(nodes[4]);
+	};
+
+	std::array<Nz::Node, 6> nodes;
+	SetupHierarchy(nodes);
+
+	std::array<Nz::Node, 6> referenceNodes;
+	SetupHierarchy(referenceNodes);
+
+	auto CheckNodes = [&]
+	{
+		for (std::size_t i = 0; i < nodes.size(); ++i)
+		{
+			Nz::Vector3f position = nodes[i].GetPosition(Nz::CoordSys::Global);
+			Nz::Vector3f referencePosition = referenceNodes[i].GetPosition(Nz::CoordSys::Global);
+			CHECK(position.x == Catch::Approx(referencePosition.x).margin(0.0001f));
+			CHECK(position.y == Catch::Approx(referencePosition.y).margin(0.0001f));
+			CHECK(position.z == Catch::Approx(referencePosition.z).margin(0.0001f));
+
+			Nz::Quaternionf rotation = nodes[i].GetRotation(Nz::CoordSys::Global);
+			CHECK(std::abs(rotation.DotProduct(referenceNodes[i].GetRotation(Nz::CoordSys::Global))) == Catch::Approx(1.f));
+
+			Nz::Vector3f scale = nodes[i].GetScale(Nz::CoordSys::Global);
+			Nz::Vector3f referenceScale = referenceNodes[i].GetScale(Nz::CoordSys::Global);
+			CHECK(scale.x == Catch::Approx(referenceScale.x));
+			CHECK(scale.y == Catch::Approx(referenceScale.y));
+			CHECK(scale.z == Catch::Approx(referenceScale.z));
+
+			const Nz::Matrix4f& matrix = nodes[i].GetTransformMatrix();
+			const Nz::Matrix4f& referenceMatrix = referenceNodes[i].GetTransformMatrix();
+			for (std::size_t j = 0; j < 16; ++j)
+				CHECK(matrix[j] == Catch::Approx(referenceMatrix[j]).margin(0.0001f));
+		}
+	};
+
+	WHEN("Updating every node at once")
+	{
+		Nz::TransformHierarchy hierarchy;
+
+		// Insertion order (and duplicates) doesn't matter
+		for (std::size_t i = nodes.size(); i > 0; --i)
+			hierarchy.Insert(&nodes[i - 1]);
+
+		hierarchy.Insert(&nodes[2]);
+		hierarchy.Update();
+
+		CheckNodes();
+	}
+
+	WHEN("Updating only some nodes")
+	{
+		nodes[1].Move(Nz::Vector3f(0.f, 2.f, 0.f));
+		referenceNodes[1].Move(Nz::Vector3f(0.f, 2.f, 0.f));
+
+		Nz::TransformHierarchy hierarchy;
+
+		// The root isn't inserted and will be resolved when gathering its children
+		hierarchy.Insert(&nodes[2]);
+		hierarchy.Insert(&nodes[3]);
+		hierarchy.Insert(&nodes[5]);
+		hierarchy.Update();
+
+		CheckNodes();
+	}
+}
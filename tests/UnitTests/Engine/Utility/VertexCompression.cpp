@@ -0,0 +1,130 @@
+#include <Nazara/Core/Primitive.hpp>
+#include <Nazara/Utility/Algorithm.hpp>
+#include <Nazara/Utility/Mesh.hpp>
+#include <Nazara/Utility/StaticMesh.hpp>
+#include <Nazara/Utility/VertexBuffer.hpp>
+#include <Nazara/Utility/VertexMapper.hpp>
+#include <Nazara/Utility/VertexStruct.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+SCENARIO("Vertex compression", "[Utility][VertexDeclaration]")
+{
+	WHEN("Converting floats to half-floats")
+	{
+		CHECK(Nz::FloatToHalf(0.f) == 0x0000);
+		CHECK(Nz::FloatToHalf(1.f) == 0x3C00);
+		CHECK(Nz::FloatToHalf(-2.f) == 0xC000);
+		CHECK(Nz::FloatToHalf(65504.f) == 0x7BFF);
+		CHECK(Nz::FloatToHalf(100000.f) == 0x7C00); //< infinity
+
+		CHECK(Nz::HalfToFloat(0x3C00) == 1.f);
+		CHECK(Nz::HalfToFloat(0x3555) == Catch::Approx(0.33325f));
+		CHECK(Nz::HalfToFloat(0x0001) == Catch::Approx(5.96046e-8f)); //< smallest subnormal
+
+		// Every finite half-float survives a round-trip
+		Nz::UInt32 mismatchCount = 0;
+		for (Nz::UInt32 i = 0; i < 0x7C00; ++i)
+		{
+			Nz::UInt16 half = Nz::UInt16(i);
+			if (Nz::FloatToHalf(Nz::HalfToFloat(half)) != half || Nz::FloatToHalf(-Nz::HalfToFloat(half)) != (half | 0x8000))
+				mismatchCount++;
+		}
+
+		CHECK(mismatchCount == 0);
+	}
+
+	WHEN("Encoding directions with an octahedral mapping")
+	{
+		float maxError = 0.f;
+		for (int y = -8; y <= 8; ++y)
+		{
+			for (int x = -16; x < 16; ++x)
+			{
+				float phi = float(x) * 3.14159265f / 16.f;
+				float theta = float(y) * 3.14159265f / 16.f;
+				Nz::Vector3f direction(std::cos(theta) * std::cos(phi), std::cos(theta) * std::sin(phi), std::sin(theta));
+
+				CHECK(Nz::DecodeOctahedral(Nz::EncodeOctahedral(direction)).DotProduct(direction) == Catch::Approx(1.f));
+
+				Nz::Int16 encoded[2];
+				Nz::EncodeVertexComponent(Nz::Vector4f(direction, 0.f), Nz::ComponentType::SNorm16x2, Nz::VertexComponent::Normal, encoded);
+
+				Nz::Vector3f decoded(Nz::DecodeVertexComponent(encoded, Nz::ComponentType::SNorm16x2, Nz::VertexComponent::Normal));
+				maxError = std::max(maxError, (decoded - direction).GetLength());
+			}
+		}
+
+		CHECK(maxError < 0.001f);
+	}
+
+	GIVEN("A box mesh")
+	{
+		std::shared_ptr<Nz::Mesh> mesh = Nz::Mesh::Build(Nz::Primitive::Box(Nz::Vector3f(2.f, 3.f, 4.f), Nz::Vector3ui(2)));
+		REQUIRE(mesh);
+
+		Nz::StaticMesh& staticMesh = static_cast<Nz::StaticMesh&>(*mesh->GetSubMesh(0));
+		Nz::Boxf aabb = staticMesh.GetAABB();
+
+		std::vector<Nz::VertexStruct_XYZ_Normal_UV_Tangent> originalVertices;
+		{
+			Nz::VertexMapper vertexMapper(*staticMesh.GetVertexBuffer());
+			Nz::SparsePtr<Nz::Vector3f> normals = vertexMapper.GetComponentPtr<Nz::Vector3f>(Nz::VertexComponent::Normal);
+			Nz::SparsePtr<Nz::Vector3f> positions = vertexMapper.GetComponentPtr<Nz::Vector3f>(Nz::VertexComponent::Position);
+			Nz::SparsePtr<Nz::Vector3f> tangents = vertexMapper.GetComponentPtr<Nz::Vector3f>(Nz::VertexComponent::Tangent);
+			Nz::SparsePtr<Nz::Vector2f> uvs = vertexMapper.GetComponentPtr<Nz::Vector2f>(Nz::VertexComponent::TexCoord);
+
+			for (Nz::UInt32 i = 0; i < vertexMapper.GetVertexCount(); ++i)
+			{
+				auto& vertex = originalVertices.emplace_back();
+				vertex.position = positions[i];
+				vertex.normal = normals[i];
+				vertex.uv = uvs[i];
+				vertex.tangent = tangents[i];
+			}
+		}
+
+		WHEN("Compressing its vertices")
+		{
+			mesh->CompressVertices();
+
+			Nz::StaticMesh& compressedMesh = static_cast<Nz::StaticMesh&>(*mesh->GetSubMesh(0));
+			const auto& vertexBuffer = compressedMesh.GetVertexBuffer();
+
+			THEN("The packed declaration is used")
+			{
+				CHECK(vertexBuffer->GetVertexDeclaration() == Nz::VertexDeclaration::Get(Nz::VertexLayout::XYZ_Normal_UV_Tangent_Packed));
+				CHECK(vertexBuffer->GetStride() == sizeof(Nz::VertexStruct_XYZ_Normal_UV_Tangent_Packed));
+				CHECK(vertexBuffer->GetStride() * 2 < sizeof(Nz::VertexStruct_XYZ_Normal_UV_Tangent));
+				CHECK(compressedMesh.GetVertexCount() == originalVertices.size());
+				CHECK(compressedMesh.GetIndexBuffer() == staticMesh.GetIndexBuffer());
+				CHECK(compressedMesh.GetAABB() == aabb);
+			}
+
+			THEN("Vertices are preserved up to the compression precision")
+			{
+				Nz::VertexMapper vertexMapper(*vertexBuffer);
+				for (Nz::UInt32 i = 0; i < vertexMapper.GetVertexCount(); ++i)
+				{
+					const auto& vertex = originalVertices[i];
+
+					Nz::Vector3f position(vertexMapper.GetComponentValue(Nz::VertexComponent::Position, i));
+					CHECK((position - vertex.position).GetLength() < 0.002f);
+
+					Nz::Vector3f normal(vertexMapper.GetComponentValue(Nz::VertexComponent::Normal, i));
+					CHECK((normal - vertex.normal.GetNormal()).GetLength() < 0.001f);
+
+					Nz::Vector3f tangent(vertexMapper.GetComponentValue(Nz::VertexComponent::Tangent, i));
+					CHECK((tangent - vertex.tangent.GetNormal()).GetLength() < 0.001f);
+
+					Nz::Vector4f uv = vertexMapper.GetComponentValue(Nz::VertexComponent::TexCoord, i);
+					CHECK(uv.x == Catch::Approx(vertex.uv.x).margin(0.001f));
+					CHECK(uv.y == Catch::Approx(vertex.uv.y).margin(0.001f));
+				}
+			}
+		}
+	}
+}
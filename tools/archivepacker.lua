@@ -0,0 +1,12 @@
+option("archivepacker", { description = "Build ArchivePacker tool", default = true })
+
+if has_config("archivepacker") then
+	target("NazaraArchivePacker", function ()
+		set_group("Tools")
+		set_kind("binary")
+
+		add_deps("NazaraCore")
+
+		add_files("../src/ArchivePacker/**.cpp")
+	end)
+end
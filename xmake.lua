@@ -1,6 +1,10 @@
 ----------------------- Modules -----------------------
 
 local rendererBackends = {
+	NullRenderer = {
+		Option = "nullrenderer",
+		Deps = {"NazaraRenderer"}
+	},
 	OpenGLRenderer = {
 		Option = "opengl",
 		Deps = {"NazaraRenderer"},
@@ -45,6 +49,13 @@ local rendererBackends = {
 				add_frameworks("quartzcore", "AppKit")
 			end
 		end
+	},
+	WebGPURenderer = {
+		Option = "webgpu",
+		Deps = {"NazaraRenderer"},
+		Custom = function()
+			add_ldflags("-sUSE_WEBGPU=1", { public = true })
+		end
 	}
 }
 NazaraRendererBackends = rendererBackends
@@ -52,8 +63,8 @@ NazaraRendererBackends = rendererBackends
 local modules = {
 	Audio = {
 		Option = "audio",
-		Deps = {"NazaraCore"},
-		Packages = {"dr_wav", "frozen", "libflac", "libvorbis", "minimp3"},
+		Deps = {"NazaraUtility"},
+		Packages = {"dr_wav", "entt", "frozen", "libflac", "libvorbis", "minimp3"},
 		Custom = function ()
 			if is_plat("wasm") or has_config("link_openal") then
 				add_defines("NAZARA_AUDIO_OPENAL_LINK")
@@ -89,6 +100,10 @@ local modules = {
 				add_defines("NAZARA_PLUGINS_STATIC", { public = true })
 			end
 
+			if has_config("profiling") then
+				add_defines("NAZARA_CORE_ENABLE_PROFILING=1", { public = true })
+			end
+
 			if is_plat("windows", "mingw") then
 				add_syslinks("ole32")
 			elseif is_plat("linux") then
@@ -111,7 +126,7 @@ local modules = {
 				remove_files("src/Nazara/Core/Posix/TimeImpl.cpp")
 			end
 		end,
-		Packages = { "entt", "frozen" },
+		Packages = { "entt", "frozen", "lz4", "zstd" },
 		PublicPackages = { "nazarautils" }
 	},
 	Graphics = {
@@ -127,6 +142,7 @@ local modules = {
 	Network = {
 		Option = "network",
 		Deps = {"NazaraCore"},
+		Packages = { "entt", "lz4", "zstd" },
 		Custom = function ()
 			if not is_plat("wasm") then
 				if has_config("link_curl") then
@@ -148,6 +164,8 @@ local modules = {
 			if is_plat("linux") then
 				remove_files("src/Nazara/Network/Posix/SocketPollerImpl.hpp")
 				remove_files("src/Nazara/Network/Posix/SocketPollerImpl.cpp")
+				remove_files("src/Nazara/Network/Posix/SocketCompletionQueueImpl.hpp")
+				remove_files("src/Nazara/Network/Posix/SocketCompletionQueueImpl.cpp")
 			end
 		end
 	},
@@ -201,9 +219,11 @@ local modules = {
 	}
 }
 
--- Vulkan doesn't run on web
+-- Vulkan doesn't run on web, WebGPU is only available on web (through emscripten)
 if is_plat("wasm") then
 	rendererBackends.VulkanRenderer = nil
+else
+	rendererBackends.WebGPURenderer = nil
 end
 
 if not has_config("embed_rendererbackends", "static") then
@@ -240,6 +260,7 @@ option("embed_plugins", { description = "Embed enabled plugins code as static li
 option("link_curl", { description = "Link libcurl in the executable instead of dynamically loading it", default = false })
 option("link_openal", { description = "Link OpenAL in the executable instead of dynamically loading it", default = is_plat("wasm") or false })
 option("static", { description = "Build the engine statically (implies embed_rendererbackends and embed_plugins)", default = is_plat("wasm") or false })
+option("profiling", { description = "Compile engine profiler zones (NazaraProfileScope)", default = false })
 option("override_runtime", { description = "Override vs runtime to MD in release and MDd in debug", default = true })
 option("unitybuild", { description = "Build the engine using unity build", default = false })
 option("usepch", { description = "Use precompiled headers to speedup compilation", default = false })
@@ -255,7 +276,7 @@ end
 
 add_repositories("nazara-engine-repo https://github.com/NazaraEngine/xmake-repo")
 
-add_requires("entt 3.12.2", "fmt", "frozen", "nazarautils >=2023.08.31")
+add_requires("entt 3.12.2", "fmt", "frozen", "lz4", "nazarautils >=2023.08.31", "zstd")
 
 -- Module dependencies
 if has_config("audio") then